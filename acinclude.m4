@@ -64,6 +64,28 @@ AC_DEFUN([AX_LIBEWF_CHECK_LOCAL],
   dnl Check for internationalization functions in libewf/libewf_i18n.c 
   AC_CHECK_FUNCS([bindtextdomain])
 
+  dnl Check for memory mapping functions used in libewf/libewf_mapped_file.c,
+  dnl libewf/libewf_buffer_pool.c and ewftools/storage_media_buffer_queue.c
+  AC_CHECK_HEADERS([sys/mman.h])
+  AC_CHECK_FUNCS([madvise mmap munmap])
+
+  dnl Check for page cache and preallocation functions used in libewf/libewf_unbuffered_file.c
+  AC_CHECK_FUNCS([fdatasync posix_fadvise posix_fallocate])
+
+  dnl Check for asynchronous I/O functions used in libewf/libewf_async_reader.c
+  AC_CHECK_HEADERS([aio.h fcntl.h])
+  AC_SEARCH_LIBS([aio_read], [rt])
+  AC_CHECK_FUNCS([aio_error aio_read aio_return aio_suspend])
+
+  dnl Check for shared memory functions used in libewf/libewf_shared_chunk_cache.c
+  AC_CHECK_HEADERS([sys/file.h])
+  AC_SEARCH_LIBS([shm_open], [rt])
+  AC_CHECK_FUNCS([flock ftruncate shm_open])
+
+  dnl Check for directory functions used in libewf/libewf_directory_listing.c
+  AC_CHECK_HEADERS([dirent.h])
+  AC_CHECK_FUNCS([closedir opendir readdir])
+
   dnl Check if library should be build with verbose output
   AX_COMMON_CHECK_ENABLE_VERBOSE_OUTPUT
 
@@ -95,6 +117,24 @@ AC_DEFUN([AX_EWFTOOLS_CHECK_LOCAL],
   dnl Functions used in ewftools
   AC_CHECK_FUNCS([close getopt setvbuf])
 
+  dnl Headers and functions used in ewftools/numa_topology.c
+  AC_CHECK_HEADERS([sched.h])
+  AC_CHECK_FUNCS([sched_getcpu sched_setaffinity])
+
+  dnl Functions used in ewftools/storage_media_buffer_queue.c
+  AC_CHECK_FUNCS([clock_gettime sysconf])
+
+  dnl Headers and functions used in ewftools/device_read_ahead.c
+  AC_CHECK_HEADERS([fcntl.h])
+  AC_CHECK_FUNCS([open pread])
+
+  dnl Headers and functions used in ewftools/platform.c and ewftools/rate_limiter.c
+  AC_CHECK_HEADERS([sys/syscall.h])
+  AC_CHECK_FUNCS([nanosleep])
+
+  dnl Headers used in ewftools/mount_nbd.c
+  AC_CHECK_HEADERS([poll.h sys/socket.h sys/un.h])
+
   AS_IF(
    [test "x$ac_cv_func_close" != xyes],
    [AC_MSG_FAILURE(
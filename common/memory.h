@@ -40,6 +40,9 @@
 extern "C" {
 #endif
 
+#define MEMORY_MAXIMUM_ALLOCATION_SIZE \
+	( 128 * 1024 * 1024 )
+
 /* Memory allocation
  */
 #if defined( HAVE_GLIB_H )
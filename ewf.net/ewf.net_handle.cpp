@@ -462,6 +462,49 @@ void Handle::Close( void )
 
 int Handle::ReadBuffer( array<System::Byte>^ buffer,
                         int size )
+{
+	return( this->ReadBuffer(
+	         buffer,
+	         0,
+	         size ) );
+}
+
+int Handle::ReadBuffer( array<System::Byte>^ buffer,
+                        int buffer_offset,
+                        int size )
+{
+	System::String^ function    = "Handle::ReadBuffer";
+	pin_ptr<uint8_t> ewf_buffer = nullptr;
+
+	if( ( buffer_offset < 0 )
+	 || ( buffer_offset > buffer->Length ) )
+	{
+		throw gcnew System::ArgumentException(
+			     "ewf.net " + function + ": invalid buffer offset" );
+	}
+	if( size < 0 )
+	{
+		throw gcnew System::ArgumentException(
+			     "ewf.net " + function + ": invalid size" );
+	}
+	if( size == 0 )
+	{
+		return( 0 );
+	}
+	if( size > ( buffer->Length - buffer_offset ) )
+	{
+		throw gcnew System::ArgumentException(
+			     "ewf.net " + function + ": buffer too small" );
+	}
+	ewf_buffer = &( buffer[ buffer_offset ] );
+
+	return( this->ReadBuffer(
+	         System::IntPtr( (void *) ewf_buffer ),
+	         size ) );
+}
+
+int Handle::ReadBuffer( System::IntPtr buffer,
+                        int size )
 {
 	char ewf_error_string[ EWF_NET_ERROR_STRING_SIZE ];
 
@@ -469,9 +512,13 @@ int Handle::ReadBuffer( array<System::Byte>^ buffer,
 	libewf_handle_t *handle      = NULL;
 	System::String^ error_string = nullptr;
 	System::String^ function     = "Handle::ReadBuffer";
-	pin_ptr<uint8_t> ewf_buffer  = nullptr;
-	size_t read_count            = 0;
+	ssize_t read_count           = 0;
 
+	if( buffer == System::IntPtr::Zero )
+	{
+		throw gcnew System::ArgumentException(
+			     "ewf.net " + function + ": invalid buffer" );
+	}
 	if( size < 0 )
 	{
 		throw gcnew System::ArgumentException(
@@ -481,20 +528,13 @@ int Handle::ReadBuffer( array<System::Byte>^ buffer,
 	{
 		return( 0 );
 	}
-	if( size > buffer->Length )
-	{
-		throw gcnew System::ArgumentException(
-			     "ewf.net " + function + ": buffer too small" );
-	}
 	Marshal::WriteIntPtr(
 	 (IntPtr) &handle,
 	 this->ewf_handle );
 
-	ewf_buffer = &( buffer[ 0 ] );
-
 	read_count = libewf_handle_read_buffer(
 	              handle,
-	              ewf_buffer,
+	              buffer.ToPointer(),
 	              (size_t) size,
 	              &error );
 
@@ -527,6 +567,53 @@ int Handle::ReadBuffer( array<System::Byte>^ buffer,
 int Handle::ReadBufferAtOffset( array<System::Byte>^ buffer,
                                 int size,
                                 System::Int64 offset )
+{
+	return( this->ReadBufferAtOffset(
+	         buffer,
+	         0,
+	         size,
+	         offset ) );
+}
+
+int Handle::ReadBufferAtOffset( array<System::Byte>^ buffer,
+                                int buffer_offset,
+                                int size,
+                                System::Int64 offset )
+{
+	System::String^ function    = "Handle::ReadBufferAtOffset";
+	pin_ptr<uint8_t> ewf_buffer = nullptr;
+
+	if( ( buffer_offset < 0 )
+	 || ( buffer_offset > buffer->Length ) )
+	{
+		throw gcnew System::ArgumentException(
+			     "ewf.net " + function + ": invalid buffer offset" );
+	}
+	if( size < 0 )
+	{
+		throw gcnew System::ArgumentException(
+			     "ewf.net " + function + ": invalid size" );
+	}
+	if( size == 0 )
+	{
+		return( 0 );
+	}
+	if( size > ( buffer->Length - buffer_offset ) )
+	{
+		throw gcnew System::ArgumentException(
+			     "ewf.net " + function + ": buffer too small" );
+	}
+	ewf_buffer = &( buffer[ buffer_offset ] );
+
+	return( this->ReadBufferAtOffset(
+	         System::IntPtr( (void *) ewf_buffer ),
+	         size,
+	         offset ) );
+}
+
+int Handle::ReadBufferAtOffset( System::IntPtr buffer,
+                                int size,
+                                System::Int64 offset )
 {
 	char ewf_error_string[ EWF_NET_ERROR_STRING_SIZE ];
 
@@ -534,10 +621,14 @@ int Handle::ReadBufferAtOffset( array<System::Byte>^ buffer,
 	libewf_handle_t *handle      = NULL;
 	System::String^ error_string = nullptr;
 	System::String^ function     = "Handle::ReadBufferAtOffset";
-	pin_ptr<uint8_t> ewf_buffer  = nullptr;
 	off64_t ewf_offset           = 0;
-	size_t read_count            = 0;
+	ssize_t read_count           = 0;
 
+	if( buffer == System::IntPtr::Zero )
+	{
+		throw gcnew System::ArgumentException(
+			     "ewf.net " + function + ": invalid buffer" );
+	}
 	if( size < 0 )
 	{
 		throw gcnew System::ArgumentException(
@@ -547,11 +638,6 @@ int Handle::ReadBufferAtOffset( array<System::Byte>^ buffer,
 	{
 		return( 0 );
 	}
-	if( size > buffer->Length )
-	{
-		throw gcnew System::ArgumentException(
-			     "ewf.net " + function + ": buffer too small" );
-	}
 	Marshal::WriteIntPtr(
 	 (IntPtr) &handle,
 	 this->ewf_handle );
@@ -560,11 +646,9 @@ int Handle::ReadBufferAtOffset( array<System::Byte>^ buffer,
 	 (IntPtr) &ewf_offset,
 	 offset );
 
-	ewf_buffer = &( buffer[ 0 ] );
-
 	read_count = libewf_handle_read_buffer_at_offset(
 	              handle,
-	              ewf_buffer,
+	              buffer.ToPointer(),
 	              (size_t) size,
 	              ewf_offset,
 	              &error );
@@ -595,6 +679,219 @@ int Handle::ReadBufferAtOffset( array<System::Byte>^ buffer,
 	return( (int) read_count );
 }
 
+#if _MSC_VER >= 1900
+
+/* The state of an asynchronous read that is passed to the libewf callback
+ */
+ref class HandleReadRequest sealed
+{
+	public:
+		System::Threading::Tasks::TaskCompletionSource<int>^ task_completion_source;
+
+		System::Runtime::InteropServices::GCHandle buffer_handle;
+};
+
+/* Completes an asynchronous read
+ * This function is called by libewf on one of its worker threads
+ */
+static void HandleReadRequestCallback( void *callback_data,
+                                       ssize_t read_count,
+                                       libewf_error_t *error )
+{
+	char ewf_error_string[ EWF_NET_ERROR_STRING_SIZE ];
+
+	HandleReadRequest^ read_request = nullptr;
+	System::String^ error_string    = nullptr;
+	System::String^ function        = "Handle::ReadBufferAtOffsetAsync";
+	GCHandle read_request_handle;
+
+	read_request_handle = GCHandle::FromIntPtr(
+	                       System::IntPtr( callback_data ) );
+
+	read_request = (HandleReadRequest^) read_request_handle.Target;
+
+	read_request_handle.Free();
+
+	if( read_request->buffer_handle.IsAllocated )
+	{
+		read_request->buffer_handle.Free();
+	}
+	if( read_count == -1 )
+	{
+		error_string = gcnew System::String(
+		                      "ewf.net " + function + ": unable to read buffer at offset from ewf handle." );
+
+		if( libewf_error_backtrace_sprint(
+		     error,
+		     &( ewf_error_string[ 1 ] ),
+		     EWF_NET_ERROR_STRING_SIZE - 1 ) > 0 )
+		{
+			ewf_error_string[ 0 ] = '\n';
+
+			error_string = System::String::Concat(
+			                error_string,
+			                gcnew System::String(
+			                       ewf_error_string ) );
+		}
+		/* The error is freed by libewf after the callback returns
+		 */
+		read_request->task_completion_source->TrySetException(
+		                                       gcnew System::Exception(
+		                                              error_string ) );
+	}
+	else
+	{
+		read_request->task_completion_source->TrySetResult(
+		                                       (int) read_count );
+	}
+}
+
+System::Threading::Tasks::Task<int>^ Handle::ReadBufferAtOffsetAsync( array<System::Byte>^ buffer,
+                                                                      int buffer_offset,
+                                                                      int size,
+                                                                      System::Int64 offset )
+{
+	HandleReadRequest^ read_request = nullptr;
+	System::String^ function        = "Handle::ReadBufferAtOffsetAsync";
+
+	if( ( buffer_offset < 0 )
+	 || ( buffer_offset > buffer->Length ) )
+	{
+		throw gcnew System::ArgumentException(
+			     "ewf.net " + function + ": invalid buffer offset" );
+	}
+	if( size < 0 )
+	{
+		throw gcnew System::ArgumentException(
+			     "ewf.net " + function + ": invalid size" );
+	}
+	if( size > ( buffer->Length - buffer_offset ) )
+	{
+		throw gcnew System::ArgumentException(
+			     "ewf.net " + function + ": buffer too small" );
+	}
+	if( size == 0 )
+	{
+		return( System::Threading::Tasks::Task::FromResult( 0 ) );
+	}
+	read_request = gcnew HandleReadRequest();
+
+	/* The array remains pinned until the read completes
+	 */
+	read_request->buffer_handle = GCHandle::Alloc(
+	                               buffer,
+	                               GCHandleType::Pinned );
+
+	return( this->ReadBufferAtOffsetAsync(
+	         read_request,
+	         Marshal::UnsafeAddrOfPinnedArrayElement(
+	          buffer,
+	          buffer_offset ),
+	         size,
+	         offset ) );
+}
+
+System::Threading::Tasks::Task<int>^ Handle::ReadBufferAtOffsetAsync( System::IntPtr buffer,
+                                                                      int size,
+                                                                      System::Int64 offset )
+{
+	System::String^ function = "Handle::ReadBufferAtOffsetAsync";
+
+	if( buffer == System::IntPtr::Zero )
+	{
+		throw gcnew System::ArgumentException(
+			     "ewf.net " + function + ": invalid buffer" );
+	}
+	if( size < 0 )
+	{
+		throw gcnew System::ArgumentException(
+			     "ewf.net " + function + ": invalid size" );
+	}
+	if( size == 0 )
+	{
+		return( System::Threading::Tasks::Task::FromResult( 0 ) );
+	}
+	return( this->ReadBufferAtOffsetAsync(
+	         gcnew HandleReadRequest(),
+	         buffer,
+	         size,
+	         offset ) );
+}
+
+System::Threading::Tasks::Task<int>^ Handle::ReadBufferAtOffsetAsync( HandleReadRequest^ read_request,
+                                                                      System::IntPtr buffer,
+                                                                      int size,
+                                                                      System::Int64 offset )
+{
+	char ewf_error_string[ EWF_NET_ERROR_STRING_SIZE ];
+
+	libewf_error_t *error        = NULL;
+	libewf_handle_t *handle      = NULL;
+	System::String^ error_string = nullptr;
+	System::String^ function     = "Handle::ReadBufferAtOffsetAsync";
+	GCHandle read_request_handle;
+	off64_t ewf_offset           = 0;
+
+	/* Continuations are not run on the libewf worker thread that completes the read
+	 * since these could block the worker threads
+	 */
+	read_request->task_completion_source = gcnew System::Threading::Tasks::TaskCompletionSource<int>(
+	                                              System::Threading::Tasks::TaskCreationOptions::RunContinuationsAsynchronously );
+
+	/* The callback frees the read request handle
+	 */
+	read_request_handle = GCHandle::Alloc(
+	                       read_request );
+
+	Marshal::WriteIntPtr(
+	 (IntPtr) &handle,
+	 this->ewf_handle );
+
+	Marshal::WriteInt64(
+	 (IntPtr) &ewf_offset,
+	 offset );
+
+	if( libewf_handle_read_buffer_at_offset_async(
+	     handle,
+	     buffer.ToPointer(),
+	     (size_t) size,
+	     ewf_offset,
+	     &HandleReadRequestCallback,
+	     GCHandle::ToIntPtr( read_request_handle ).ToPointer(),
+	     &error ) != 1 )
+	{
+		read_request_handle.Free();
+
+		if( read_request->buffer_handle.IsAllocated )
+		{
+			read_request->buffer_handle.Free();
+		}
+		error_string = gcnew System::String(
+		                      "ewf.net " + function + ": unable to queue read buffer at offset of ewf handle." );
+
+		if( libewf_error_backtrace_sprint(
+		     error,
+		     &( ewf_error_string[ 1 ] ),
+		     EWF_NET_ERROR_STRING_SIZE - 1 ) > 0 )
+		{
+			ewf_error_string[ 0 ] = '\n';
+
+			error_string = System::String::Concat(
+			                error_string,
+			                gcnew System::String(
+			                       ewf_error_string ) );
+		}
+		libewf_error_free(
+		 &error );
+
+		throw gcnew System::Exception(
+			     error_string );
+	}
+	return( read_request->task_completion_source->Task );
+}
+
+#endif /* _MSC_VER >= 1900 */
+
 int Handle::WriteBuffer( array<System::Byte>^ buffer,
                          int size )
 {
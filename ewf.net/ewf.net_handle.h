@@ -32,6 +32,10 @@ using namespace System::IO;
 
 namespace EWF {
 
+#if _MSC_VER >= 1900
+ref class HandleReadRequest;
+#endif
+
 public ref class Handle sealed
 {
 	private:
@@ -40,6 +44,13 @@ public ref class Handle sealed
 	private:
 		Handle( System::IntPtr ewf_handle );
 
+#if _MSC_VER >= 1900
+		System::Threading::Tasks::Task<int>^ ReadBufferAtOffsetAsync( HandleReadRequest^ read_request,
+		                                                              System::IntPtr buffer,
+		                                                              int size,
+		                                                              System::Int64 offset );
+#endif
+
 	public:
 		Handle( void );
 		~Handle( void );
@@ -65,10 +76,49 @@ public ref class Handle sealed
 		int ReadBuffer( array<System::Byte>^ buffer,
 		                int size );
 
+		int ReadBuffer( array<System::Byte>^ buffer,
+		                int buffer_offset,
+		                int size );
+
+		/* Reads into unmanaged or pinned memory, such as a pinned Span<byte> or Memory<byte>
+		 */
+		int ReadBuffer( System::IntPtr buffer,
+		                int size );
+
+		int ReadBufferAtOffset( array<System::Byte>^ buffer,
+		                        int size,
+		                        System::Int64 offset );
+
 		int ReadBufferAtOffset( array<System::Byte>^ buffer,
+		                        int buffer_offset,
+		                        int size,
+		                        System::Int64 offset );
+
+		/* Reads into unmanaged or pinned memory, such as a pinned Span<byte> or Memory<byte>
+		 */
+		int ReadBufferAtOffset( System::IntPtr buffer,
 		                        int size,
 		                        System::Int64 offset );
 
+#if _MSC_VER >= 1900
+
+		/* Reads at an offset without changing the current offset and without blocking the calling thread
+		 * The array is pinned until the read completes
+		 */
+		System::Threading::Tasks::Task<int>^ ReadBufferAtOffsetAsync( array<System::Byte>^ buffer,
+		                                                              int buffer_offset,
+		                                                              int size,
+		                                                              System::Int64 offset );
+
+		/* Reads at an offset without changing the current offset and without blocking the calling thread
+		 * The memory must remain valid, and pinned, until the read completes
+		 */
+		System::Threading::Tasks::Task<int>^ ReadBufferAtOffsetAsync( System::IntPtr buffer,
+		                                                              int size,
+		                                                              System::Int64 offset );
+
+#endif /* _MSC_VER >= 1900 */
+
 		int WriteBuffer( array<System::Byte>^ buffer,
 		                 int size );
 
@@ -0,0 +1,1231 @@
+/*
+ * Blocked gzip (BGZF) output functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_IO_H ) || defined( WINAPI )
+#include <io.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+#include <zlib.h>
+#endif
+
+#include "blocked_gzip.h"
+#include "ewftools_libcerror.h"
+#include "ewftools_libcfile.h"
+
+/* The gzip member header of a block, where the last 2 bytes contain the block size - 1
+ */
+static const uint8_t blocked_gzip_block_header[ BLOCKED_GZIP_BLOCK_HEADER_SIZE ] = {
+	0x1f, 0x8b, 0x08, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x06, 0x00, 'B', 'C', 0x02, 0x00,
+	0x00, 0x00 };
+
+/* The empty block that marks the end of the file
+ */
+static const uint8_t blocked_gzip_end_of_file_block[ BLOCKED_GZIP_END_OF_FILE_BLOCK_SIZE ] = {
+	0x1f, 0x8b, 0x08, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x06, 0x00, 'B', 'C', 0x02, 0x00,
+	0x1b, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+/* Retrieves the maximum size of the compressed data of data of a specific size
+ * Returns the maximum compressed size
+ */
+size_t blocked_gzip_get_maximum_compressed_size(
+        size_t data_size )
+{
+	size_t number_of_blocks = 0;
+
+	number_of_blocks = data_size / BLOCKED_GZIP_MAXIMUM_BLOCK_DATA_SIZE;
+
+	if( ( data_size % BLOCKED_GZIP_MAXIMUM_BLOCK_DATA_SIZE ) != 0 )
+	{
+		number_of_blocks += 1;
+	}
+	return( number_of_blocks * BLOCKED_GZIP_MAXIMUM_BLOCK_SIZE );
+}
+
+/* Compresses data into consecutive blocks
+ * This function is thread-safe, hence the data of different buffers can be compressed at the same time
+ * Returns the size of the compressed data or -1 on error
+ */
+ssize_t blocked_gzip_compress(
+         const uint8_t *data,
+         size_t data_size,
+         int compression_level,
+         uint8_t *compressed_data,
+         size_t compressed_data_size,
+         libcerror_error_t **error )
+{
+#if defined( HAVE_BLOCKED_GZIP_SUPPORT )
+	z_stream zlib_stream;
+
+	uint8_t *block_data         = NULL;
+	static char *function       = "blocked_gzip_compress";
+	size_t block_data_size      = 0;
+	size_t block_size           = 0;
+	size_t compressed_offset    = 0;
+	size_t data_offset          = 0;
+	size_t deflate_data_size    = 0;
+	uint32_t checksum           = 0;
+	int result                  = 0;
+	int zlib_stream_initialized = 0;
+#else
+	static char *function       = "blocked_gzip_compress";
+#endif
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_BLOCKED_GZIP_SUPPORT )
+	if( ( compressed_data_size > (size_t) SSIZE_MAX )
+	 || ( compressed_data_size < blocked_gzip_get_maximum_compressed_size( data_size ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid compressed data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     &zlib_stream,
+	     0,
+	     sizeof( z_stream ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear zlib stream.",
+		 function );
+
+		return( -1 );
+	}
+	/* The blocks contain raw deflate data, the gzip member header and footer are written separately
+	 */
+	result = deflateInit2(
+	          &zlib_stream,
+	          compression_level,
+	          Z_DEFLATED,
+	          -15,
+	          8,
+	          Z_DEFAULT_STRATEGY );
+
+	if( result != Z_OK )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize zlib stream.",
+		 function );
+
+		goto on_error;
+	}
+	zlib_stream_initialized = 1;
+
+	while( data_offset < data_size )
+	{
+		block_data_size = data_size - data_offset;
+
+		if( block_data_size > BLOCKED_GZIP_MAXIMUM_BLOCK_DATA_SIZE )
+		{
+			block_data_size = BLOCKED_GZIP_MAXIMUM_BLOCK_DATA_SIZE;
+		}
+		block_data = &( compressed_data[ compressed_offset ] );
+
+		if( memory_copy(
+		     block_data,
+		     blocked_gzip_block_header,
+		     BLOCKED_GZIP_BLOCK_HEADER_SIZE ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy block header.",
+			 function );
+
+			goto on_error;
+		}
+		zlib_stream.next_in   = (Bytef *) &( data[ data_offset ] );
+		zlib_stream.avail_in  = (uInt) block_data_size;
+		zlib_stream.next_out  = (Bytef *) &( block_data[ BLOCKED_GZIP_BLOCK_HEADER_SIZE ] );
+		zlib_stream.avail_out = (uInt) ( BLOCKED_GZIP_MAXIMUM_BLOCK_SIZE - BLOCKED_GZIP_BLOCK_HEADER_SIZE - BLOCKED_GZIP_BLOCK_FOOTER_SIZE );
+
+		result = deflate(
+		          &zlib_stream,
+		          Z_FINISH );
+
+		if( result == Z_STREAM_END )
+		{
+			deflate_data_size = (size_t) ( BLOCKED_GZIP_MAXIMUM_BLOCK_SIZE - BLOCKED_GZIP_BLOCK_HEADER_SIZE - BLOCKED_GZIP_BLOCK_FOOTER_SIZE ) - zlib_stream.avail_out;
+		}
+		else if( ( result == Z_OK )
+		      || ( result == Z_BUF_ERROR ) )
+		{
+			/* The data does not compress within the maximum block size
+			 * store it as a single uncompressed (stored) deflate block
+			 */
+			block_data[ BLOCKED_GZIP_BLOCK_HEADER_SIZE ] = 0x01;
+
+			byte_stream_copy_from_uint16_little_endian(
+			 &( block_data[ BLOCKED_GZIP_BLOCK_HEADER_SIZE + 1 ] ),
+			 (uint16_t) block_data_size );
+
+			byte_stream_copy_from_uint16_little_endian(
+			 &( block_data[ BLOCKED_GZIP_BLOCK_HEADER_SIZE + 3 ] ),
+			 (uint16_t) ~block_data_size );
+
+			if( memory_copy(
+			     &( block_data[ BLOCKED_GZIP_BLOCK_HEADER_SIZE + 5 ] ),
+			     &( data[ data_offset ] ),
+			     block_data_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy stored block data.",
+				 function );
+
+				goto on_error;
+			}
+			deflate_data_size = block_data_size + 5;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+			 "%s: unable to compress block data.",
+			 function );
+
+			goto on_error;
+		}
+		if( deflateReset(
+		     &zlib_stream ) != Z_OK )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to reset zlib stream.",
+			 function );
+
+			goto on_error;
+		}
+		block_size = BLOCKED_GZIP_BLOCK_HEADER_SIZE + deflate_data_size + BLOCKED_GZIP_BLOCK_FOOTER_SIZE;
+
+		byte_stream_copy_from_uint16_little_endian(
+		 &( block_data[ 16 ] ),
+		 (uint16_t) ( block_size - 1 ) );
+
+		checksum = (uint32_t) crc32(
+		                       0,
+		                       (Bytef *) &( data[ data_offset ] ),
+		                       (uInt) block_data_size );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 &( block_data[ block_size - 8 ] ),
+		 checksum );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 &( block_data[ block_size - 4 ] ),
+		 (uint32_t) block_data_size );
+
+		compressed_offset += block_size;
+		data_offset       += block_data_size;
+	}
+	zlib_stream_initialized = 0;
+
+	if( deflateEnd(
+	     &zlib_stream ) != Z_OK )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize zlib stream.",
+		 function );
+
+		goto on_error;
+	}
+	return( (ssize_t) compressed_offset );
+
+on_error:
+	if( zlib_stream_initialized != 0 )
+	{
+		deflateEnd(
+		 &zlib_stream );
+	}
+	return( -1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: missing zlib support.",
+	 function );
+
+	return( -1 );
+#endif /* defined( HAVE_BLOCKED_GZIP_SUPPORT ) */
+}
+
+/* Creates a blocked gzip output
+ * Make sure the value blocked_gzip_output is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int blocked_gzip_output_initialize(
+     blocked_gzip_output_t **blocked_gzip_output,
+     int compression_level,
+     libcerror_error_t **error )
+{
+	static char *function = "blocked_gzip_output_initialize";
+
+	if( blocked_gzip_output == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid blocked gzip output.",
+		 function );
+
+		return( -1 );
+	}
+	if( *blocked_gzip_output != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid blocked gzip output value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( compression_level < -1 )
+	 || ( compression_level > 9 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported compression level.",
+		 function );
+
+		return( -1 );
+	}
+	*blocked_gzip_output = memory_allocate_structure(
+	                        blocked_gzip_output_t );
+
+	if( *blocked_gzip_output == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create blocked gzip output.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *blocked_gzip_output,
+	     0,
+	     sizeof( blocked_gzip_output_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear blocked gzip output.",
+		 function );
+
+		memory_free(
+		 *blocked_gzip_output );
+
+		*blocked_gzip_output = NULL;
+
+		return( -1 );
+	}
+	( *blocked_gzip_output )->compression_level = compression_level;
+
+	return( 1 );
+
+on_error:
+	if( *blocked_gzip_output != NULL )
+	{
+		memory_free(
+		 *blocked_gzip_output );
+
+		*blocked_gzip_output = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a blocked gzip output
+ * Returns 1 if successful or -1 on error
+ */
+int blocked_gzip_output_free(
+     blocked_gzip_output_t **blocked_gzip_output,
+     libcerror_error_t **error )
+{
+	static char *function = "blocked_gzip_output_free";
+	int result            = 1;
+
+	if( blocked_gzip_output == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid blocked gzip output.",
+		 function );
+
+		return( -1 );
+	}
+	if( *blocked_gzip_output != NULL )
+	{
+		if( ( *blocked_gzip_output )->file != NULL )
+		{
+			if( libcfile_file_free(
+			     &( ( *blocked_gzip_output )->file ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *blocked_gzip_output )->index_filename != NULL )
+		{
+			memory_free(
+			 ( *blocked_gzip_output )->index_filename );
+		}
+		if( ( *blocked_gzip_output )->index_entries != NULL )
+		{
+			memory_free(
+			 ( *blocked_gzip_output )->index_entries );
+		}
+		if( ( *blocked_gzip_output )->compression_buffer != NULL )
+		{
+			memory_free(
+			 ( *blocked_gzip_output )->compression_buffer );
+		}
+		memory_free(
+		 *blocked_gzip_output );
+
+		*blocked_gzip_output = NULL;
+	}
+	return( result );
+}
+
+/* Opens the blocked gzip output
+ * A filename of - represents stdout, in which case no index is written
+ * Returns 1 if successful or -1 on error
+ */
+int blocked_gzip_output_open(
+     blocked_gzip_output_t *blocked_gzip_output,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function  = "blocked_gzip_output_open";
+	size_t filename_length = 0;
+
+	if( blocked_gzip_output == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid blocked gzip output.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( blocked_gzip_output->file != NULL )
+	 || ( blocked_gzip_output->use_stdout != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid blocked gzip output - already open.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_BLOCKED_GZIP_SUPPORT )
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: missing zlib support.",
+	 function );
+
+	return( -1 );
+#else
+	filename_length = system_string_length(
+	                   filename );
+
+	if( ( filename_length == 1 )
+	 && ( filename[ 0 ] == (system_character_t) '-' ) )
+	{
+		blocked_gzip_output->use_stdout = 1;
+
+		return( 1 );
+	}
+	blocked_gzip_output->index_filename = system_string_allocate(
+	                                       filename_length + 5 );
+
+	if( blocked_gzip_output->index_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create index filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     blocked_gzip_output->index_filename,
+	     filename,
+	     filename_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     &( blocked_gzip_output->index_filename[ filename_length ] ),
+	     _SYSTEM_STRING( ".gzi" ),
+	     4 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy index filename extension.",
+		 function );
+
+		goto on_error;
+	}
+	blocked_gzip_output->index_filename[ filename_length + 4 ] = 0;
+
+	if( libcfile_file_initialize(
+	     &( blocked_gzip_output->file ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcfile_file_open_wide(
+	     blocked_gzip_output->file,
+	     filename,
+	     LIBCFILE_OPEN_WRITE,
+	     error ) != 1 )
+#else
+	if( libcfile_file_open(
+	     blocked_gzip_output->file,
+	     filename,
+	     LIBCFILE_OPEN_WRITE,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( blocked_gzip_output->file != NULL )
+	{
+		libcfile_file_free(
+		 &( blocked_gzip_output->file ),
+		 NULL );
+	}
+	if( blocked_gzip_output->index_filename != NULL )
+	{
+		memory_free(
+		 blocked_gzip_output->index_filename );
+
+		blocked_gzip_output->index_filename = NULL;
+	}
+	return( -1 );
+#endif /* !defined( HAVE_BLOCKED_GZIP_SUPPORT ) */
+}
+
+/* Writes data to the file or stdout of the blocked gzip output
+ * Returns the number of bytes written or -1 on error
+ */
+static ssize_t blocked_gzip_output_write_data(
+                blocked_gzip_output_t *blocked_gzip_output,
+                const uint8_t *data,
+                size_t data_size,
+                libcerror_error_t **error )
+{
+	static char *function = "blocked_gzip_output_write_data";
+	size_t data_offset    = 0;
+	ssize_t write_count   = 0;
+
+	if( blocked_gzip_output->use_stdout == 0 )
+	{
+		write_count = libcfile_file_write_buffer(
+		               blocked_gzip_output->file,
+		               data,
+		               data_size,
+		               error );
+
+		if( write_count != (ssize_t) data_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write data to file.",
+			 function );
+
+			return( -1 );
+		}
+		return( write_count );
+	}
+	while( data_offset < data_size )
+	{
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+		write_count = _write(
+		               1,
+		               &( data[ data_offset ] ),
+		               (unsigned int) ( data_size - data_offset ) );
+#else
+		write_count = write(
+		               1,
+		               &( data[ data_offset ] ),
+		               data_size - data_offset );
+#endif
+		if( write_count <= 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write data to stdout.",
+			 function );
+
+			return( -1 );
+		}
+		data_offset += (size_t) write_count;
+	}
+	return( (ssize_t) data_size );
+}
+
+/* Writes compressed data, as created by blocked_gzip_compress, and adds its blocks to the index
+ * Returns the number of compressed bytes written or -1 on error
+ */
+ssize_t blocked_gzip_output_write_compressed_data(
+         blocked_gzip_output_t *blocked_gzip_output,
+         const uint8_t *compressed_data,
+         size_t compressed_data_size,
+         libcerror_error_t **error )
+{
+	uint64_t *reallocation       = NULL;
+	static char *function        = "blocked_gzip_output_write_compressed_data";
+	size_t block_offset          = 0;
+	size_t maximum_number        = 0;
+	uint32_t block_data_size     = 0;
+	uint16_t block_size          = 0;
+
+	if( blocked_gzip_output == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid blocked gzip output.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( blocked_gzip_output->file == NULL )
+	 && ( blocked_gzip_output->use_stdout == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid blocked gzip output - not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid compressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	/* Walk the blocks to add their offsets to the index
+	 */
+	while( block_offset < compressed_data_size )
+	{
+		if( ( compressed_data_size - block_offset ) < ( BLOCKED_GZIP_BLOCK_HEADER_SIZE + BLOCKED_GZIP_BLOCK_FOOTER_SIZE ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid compressed data - truncated block at offset: %" PRIzd ".",
+			 function,
+			 block_offset );
+
+			return( -1 );
+		}
+		byte_stream_copy_to_uint16_little_endian(
+		 &( compressed_data[ block_offset + 16 ] ),
+		 block_size );
+
+		if( ( (size_t) block_size + 1 ) > ( compressed_data_size - block_offset ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid compressed data - block size value out of bounds at offset: %" PRIzd ".",
+			 function,
+			 block_offset );
+
+			return( -1 );
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 &( compressed_data[ block_offset + block_size - 3 ] ),
+		 block_data_size );
+
+		/* The first block of the file, at offset 0, is not stored in the index
+		 */
+		if( blocked_gzip_output->compressed_offset != 0 )
+		{
+			if( blocked_gzip_output->number_of_index_entries >= blocked_gzip_output->maximum_number_of_index_entries )
+			{
+				maximum_number = blocked_gzip_output->maximum_number_of_index_entries;
+
+				if( maximum_number == 0 )
+				{
+					maximum_number = 1024;
+				}
+				else
+				{
+					maximum_number *= 2;
+				}
+				reallocation = (uint64_t *) memory_reallocate(
+				                             blocked_gzip_output->index_entries,
+				                             sizeof( uint64_t ) * 2 * maximum_number );
+
+				if( reallocation == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to resize index entries.",
+					 function );
+
+					return( -1 );
+				}
+				blocked_gzip_output->index_entries                   = reallocation;
+				blocked_gzip_output->maximum_number_of_index_entries = maximum_number;
+			}
+			blocked_gzip_output->index_entries[ blocked_gzip_output->number_of_index_entries * 2 ]     = blocked_gzip_output->compressed_offset;
+			blocked_gzip_output->index_entries[ ( blocked_gzip_output->number_of_index_entries * 2 ) + 1 ] = blocked_gzip_output->uncompressed_offset;
+
+			blocked_gzip_output->number_of_index_entries += 1;
+		}
+		blocked_gzip_output->compressed_offset   += (uint64_t) block_size + 1;
+		blocked_gzip_output->uncompressed_offset += block_data_size;
+
+		block_offset += (size_t) block_size + 1;
+	}
+	if( compressed_data_size == 0 )
+	{
+		return( 0 );
+	}
+	if( blocked_gzip_output_write_data(
+	     blocked_gzip_output,
+	     compressed_data,
+	     compressed_data_size,
+	     error ) != (ssize_t) compressed_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write compressed data.",
+		 function );
+
+		return( -1 );
+	}
+	return( (ssize_t) compressed_data_size );
+}
+
+/* Compresses and writes a buffer
+ * Returns the number of bytes of the buffer written or -1 on error
+ */
+ssize_t blocked_gzip_output_write_buffer(
+         blocked_gzip_output_t *blocked_gzip_output,
+         const uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	static char *function         = "blocked_gzip_output_write_buffer";
+	size_t maximum_compressed_size = 0;
+	ssize_t compressed_data_size  = 0;
+
+	if( blocked_gzip_output == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid blocked gzip output.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size == 0 )
+	{
+		return( 0 );
+	}
+	maximum_compressed_size = blocked_gzip_get_maximum_compressed_size(
+	                           buffer_size );
+
+	if( maximum_compressed_size > blocked_gzip_output->compression_buffer_size )
+	{
+		if( blocked_gzip_output->compression_buffer != NULL )
+		{
+			memory_free(
+			 blocked_gzip_output->compression_buffer );
+
+			blocked_gzip_output->compression_buffer      = NULL;
+			blocked_gzip_output->compression_buffer_size = 0;
+		}
+		blocked_gzip_output->compression_buffer = (uint8_t *) memory_allocate(
+		                                                       sizeof( uint8_t ) * maximum_compressed_size );
+
+		if( blocked_gzip_output->compression_buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create compression buffer.",
+			 function );
+
+			return( -1 );
+		}
+		blocked_gzip_output->compression_buffer_size = maximum_compressed_size;
+	}
+	compressed_data_size = blocked_gzip_compress(
+	                        buffer,
+	                        buffer_size,
+	                        blocked_gzip_output->compression_level,
+	                        blocked_gzip_output->compression_buffer,
+	                        blocked_gzip_output->compression_buffer_size,
+	                        error );
+
+	if( compressed_data_size < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+		 "%s: unable to compress buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( blocked_gzip_output_write_compressed_data(
+	     blocked_gzip_output,
+	     blocked_gzip_output->compression_buffer,
+	     (size_t) compressed_data_size,
+	     error ) != compressed_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write compressed data.",
+		 function );
+
+		return( -1 );
+	}
+	return( (ssize_t) buffer_size );
+}
+
+/* Writes the index of the blocks to the index file
+ * The index file uses the same format as bgzip: the number of entries followed by
+ * the compressed and uncompressed offsets of every block except the first, all as 64-bit little-endian values
+ * Returns 1 if successful or -1 on error
+ */
+int blocked_gzip_output_write_index(
+     blocked_gzip_output_t *blocked_gzip_output,
+     libcerror_error_t **error )
+{
+	uint8_t index_entry_data[ 16 ];
+
+	libcfile_file_t *index_file = NULL;
+	static char *function       = "blocked_gzip_output_write_index";
+	size_t entry_index          = 0;
+
+	if( blocked_gzip_output == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid blocked gzip output.",
+		 function );
+
+		return( -1 );
+	}
+	if( blocked_gzip_output->index_filename == NULL )
+	{
+		return( 1 );
+	}
+	if( libcfile_file_initialize(
+	     &index_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create index file.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcfile_file_open_wide(
+	     index_file,
+	     blocked_gzip_output->index_filename,
+	     LIBCFILE_OPEN_WRITE,
+	     error ) != 1 )
+#else
+	if( libcfile_file_open(
+	     index_file,
+	     blocked_gzip_output->index_filename,
+	     LIBCFILE_OPEN_WRITE,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open index file: %" PRIs_SYSTEM ".",
+		 function,
+		 blocked_gzip_output->index_filename );
+
+		goto on_error;
+	}
+	byte_stream_copy_from_uint64_little_endian(
+	 index_entry_data,
+	 (uint64_t) blocked_gzip_output->number_of_index_entries );
+
+	if( libcfile_file_write_buffer(
+	     index_file,
+	     index_entry_data,
+	     8,
+	     error ) != 8 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write number of index entries.",
+		 function );
+
+		goto on_error;
+	}
+	for( entry_index = 0;
+	     entry_index < blocked_gzip_output->number_of_index_entries;
+	     entry_index++ )
+	{
+		byte_stream_copy_from_uint64_little_endian(
+		 index_entry_data,
+		 blocked_gzip_output->index_entries[ entry_index * 2 ] );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 &( index_entry_data[ 8 ] ),
+		 blocked_gzip_output->index_entries[ ( entry_index * 2 ) + 1 ] );
+
+		if( libcfile_file_write_buffer(
+		     index_file,
+		     index_entry_data,
+		     16,
+		     error ) != 16 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write index entry: %" PRIzd ".",
+			 function,
+			 entry_index );
+
+			goto on_error;
+		}
+	}
+	if( libcfile_file_close(
+	     index_file,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close index file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_free(
+	     &index_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free index file.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( index_file != NULL )
+	{
+		libcfile_file_free(
+		 &index_file,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Closes the blocked gzip output
+ * Writes the end of file block and the index
+ * Returns 0 if successful or -1 on error
+ */
+int blocked_gzip_output_close(
+     blocked_gzip_output_t *blocked_gzip_output,
+     libcerror_error_t **error )
+{
+	static char *function = "blocked_gzip_output_close";
+	int result            = 0;
+
+	if( blocked_gzip_output == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid blocked gzip output.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( blocked_gzip_output->file == NULL )
+	 && ( blocked_gzip_output->use_stdout == 0 ) )
+	{
+		return( 0 );
+	}
+	if( blocked_gzip_output_write_data(
+	     blocked_gzip_output,
+	     blocked_gzip_end_of_file_block,
+	     BLOCKED_GZIP_END_OF_FILE_BLOCK_SIZE,
+	     error ) != (ssize_t) BLOCKED_GZIP_END_OF_FILE_BLOCK_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write end of file block.",
+		 function );
+
+		result = -1;
+	}
+	if( blocked_gzip_output->file != NULL )
+	{
+		if( libcfile_file_close(
+		     blocked_gzip_output->file,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file.",
+			 function );
+
+			result = -1;
+		}
+		if( libcfile_file_free(
+		     &( blocked_gzip_output->file ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file.",
+			 function );
+
+			result = -1;
+		}
+	}
+	blocked_gzip_output->use_stdout = 0;
+
+	if( result == 0 )
+	{
+		if( blocked_gzip_output_write_index(
+		     blocked_gzip_output,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write index.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
@@ -0,0 +1,158 @@
+/*
+ * Blocked gzip (BGZF) output functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _BLOCKED_GZIP_H )
+#define _BLOCKED_GZIP_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcfile.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+#define HAVE_BLOCKED_GZIP_SUPPORT
+#endif
+
+/* The maximum size of the data stored in a single block, which is the same as used by bgzip
+ * so that a block that does not compress still fits in the maximum block size
+ */
+#define BLOCKED_GZIP_MAXIMUM_BLOCK_DATA_SIZE	0xff00
+
+/* The maximum size of a block, including the gzip member header and footer
+ */
+#define BLOCKED_GZIP_MAXIMUM_BLOCK_SIZE		0x10000
+
+#define BLOCKED_GZIP_BLOCK_HEADER_SIZE		18
+#define BLOCKED_GZIP_BLOCK_FOOTER_SIZE		8
+
+#define BLOCKED_GZIP_END_OF_FILE_BLOCK_SIZE	28
+
+typedef struct blocked_gzip_output blocked_gzip_output_t;
+
+/* A blocked gzip output writes the data as a series of gzip members of at most 64 KiB,
+ * that carry their compressed size in a "BC" extra field. Every gzip tool can decompress
+ * the output, while tools that support BGZF, such as bgzip -b, can seek in it using the index
+ * of the offsets of the blocks, which is written next to the output as: filename.gzi
+ */
+struct blocked_gzip_output
+{
+	/* The output file, which is not set when stdout is used
+	 */
+	libcfile_file_t *file;
+
+	/* Value to indicate if stdout should be used
+	 */
+	uint8_t use_stdout;
+
+	/* The index filename
+	 */
+	system_character_t *index_filename;
+
+	/* The zlib compression level
+	 */
+	int compression_level;
+
+	/* The compressed (file) offset of the next block
+	 */
+	uint64_t compressed_offset;
+
+	/* The uncompressed (media) offset of the next block
+	 */
+	uint64_t uncompressed_offset;
+
+	/* The index entries, as pairs of a compressed and an uncompressed offset
+	 * of the start of every block except the first
+	 */
+	uint64_t *index_entries;
+
+	/* The number of index entries
+	 */
+	size_t number_of_index_entries;
+
+	/* The maximum number of index entries the index entries were allocated for
+	 */
+	size_t maximum_number_of_index_entries;
+
+	/* The compression buffer, used for data that was not compressed in advance
+	 */
+	uint8_t *compression_buffer;
+
+	/* The compression buffer size
+	 */
+	size_t compression_buffer_size;
+};
+
+size_t blocked_gzip_get_maximum_compressed_size(
+        size_t data_size );
+
+ssize_t blocked_gzip_compress(
+         const uint8_t *data,
+         size_t data_size,
+         int compression_level,
+         uint8_t *compressed_data,
+         size_t compressed_data_size,
+         libcerror_error_t **error );
+
+int blocked_gzip_output_initialize(
+     blocked_gzip_output_t **blocked_gzip_output,
+     int compression_level,
+     libcerror_error_t **error );
+
+int blocked_gzip_output_free(
+     blocked_gzip_output_t **blocked_gzip_output,
+     libcerror_error_t **error );
+
+int blocked_gzip_output_open(
+     blocked_gzip_output_t *blocked_gzip_output,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int blocked_gzip_output_close(
+     blocked_gzip_output_t *blocked_gzip_output,
+     libcerror_error_t **error );
+
+ssize_t blocked_gzip_output_write_compressed_data(
+         blocked_gzip_output_t *blocked_gzip_output,
+         const uint8_t *compressed_data,
+         size_t compressed_data_size,
+         libcerror_error_t **error );
+
+ssize_t blocked_gzip_output_write_buffer(
+         blocked_gzip_output_t *blocked_gzip_output,
+         const uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
+int blocked_gzip_output_write_index(
+     blocked_gzip_output_t *blocked_gzip_output,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _BLOCKED_GZIP_H ) */
+
@@ -0,0 +1,1186 @@
+/*
+ * Chunk fingerprints functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <byte_stream.h>
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "chunk_fingerprints.h"
+#include "ewftools_libcerror.h"
+#include "sha256_context.h"
+
+/* The chunk fingerprints file starts with a 32-byte header that consists of:
+ * the signature, the chunk size, the media size and the number of chunks
+ * followed by the 32-byte SHA-256 of the uncompressed data of every chunk
+ * The values in the header are stored in little-endian
+ */
+const uint8_t chunk_fingerprints_file_signature[ 8 ] = {
+	'e', 'w', 'f', 'c', 'h', 'f', 'p', 'r' };
+
+/* Creates chunk fingerprints
+ * Make sure the value chunk_fingerprints is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int chunk_fingerprints_initialize(
+     chunk_fingerprints_t **chunk_fingerprints,
+     size32_t chunk_size,
+     libcerror_error_t **error )
+{
+	static char *function = "chunk_fingerprints_initialize";
+
+	if( chunk_fingerprints == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk fingerprints.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_fingerprints != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk fingerprints value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_size == 0 )
+	 || ( chunk_size > (size32_t) INT32_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*chunk_fingerprints = memory_allocate_structure(
+	                       chunk_fingerprints_t );
+
+	if( *chunk_fingerprints == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk fingerprints.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *chunk_fingerprints,
+	     0,
+	     sizeof( chunk_fingerprints_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk fingerprints.",
+		 function );
+
+		goto on_error;
+	}
+	( *chunk_fingerprints )->chunk_size = chunk_size;
+
+	return( 1 );
+
+on_error:
+	if( *chunk_fingerprints != NULL )
+	{
+		memory_free(
+		 *chunk_fingerprints );
+
+		*chunk_fingerprints = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees chunk fingerprints
+ * Returns 1 if successful or -1 on error
+ */
+int chunk_fingerprints_free(
+     chunk_fingerprints_t **chunk_fingerprints,
+     libcerror_error_t **error )
+{
+	static char *function = "chunk_fingerprints_free";
+	int result            = 1;
+
+	if( chunk_fingerprints == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk fingerprints.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_fingerprints != NULL )
+	{
+		if( ( *chunk_fingerprints )->file_stream != NULL )
+		{
+			if( file_stream_close(
+			     ( *chunk_fingerprints )->file_stream ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close file.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *chunk_fingerprints )->base_file_stream != NULL )
+		{
+			if( file_stream_close(
+			     ( *chunk_fingerprints )->base_file_stream ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close base file.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *chunk_fingerprints )->changed_ranges != NULL )
+		{
+			memory_free(
+			 ( *chunk_fingerprints )->changed_ranges );
+		}
+		memory_free(
+		 *chunk_fingerprints );
+
+		*chunk_fingerprints = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves the size of the fingerprints of data
+ * Returns 1 if successful or -1 on error
+ */
+int chunk_fingerprints_get_fingerprints_size(
+     chunk_fingerprints_t *chunk_fingerprints,
+     size_t data_size,
+     size_t *fingerprints_size,
+     libcerror_error_t **error )
+{
+	static char *function = "chunk_fingerprints_get_fingerprints_size";
+
+	if( chunk_fingerprints == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk fingerprints.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( fingerprints_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fingerprints size.",
+		 function );
+
+		return( -1 );
+	}
+	*fingerprints_size = ( data_size / chunk_fingerprints->chunk_size ) * CHUNK_FINGERPRINTS_FINGERPRINT_SIZE;
+
+	if( ( data_size % chunk_fingerprints->chunk_size ) != 0 )
+	{
+		*fingerprints_size += CHUNK_FINGERPRINTS_FINGERPRINT_SIZE;
+	}
+	return( 1 );
+}
+
+/* Calculates the fingerprint of every chunk of the data
+ * The data must start at a chunk boundary, only the last chunk can be smaller than the chunk size
+ * This function does not change the chunk fingerprints and can be called from multiple threads
+ * Returns 1 if successful or -1 on error
+ */
+int chunk_fingerprints_calculate(
+     chunk_fingerprints_t *chunk_fingerprints,
+     const uint8_t *data,
+     size_t data_size,
+     uint8_t *fingerprints,
+     size_t fingerprints_size,
+     libcerror_error_t **error )
+{
+	sha256_context_t *context  = NULL;
+	static char *function      = "chunk_fingerprints_calculate";
+	size_t calculate_size      = 0;
+	size_t data_offset         = 0;
+	size_t fingerprints_offset = 0;
+	size_t required_size       = 0;
+
+	if( chunk_fingerprints_get_fingerprints_size(
+	     chunk_fingerprints,
+	     data_size,
+	     &required_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve fingerprints size.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( fingerprints == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fingerprints.",
+		 function );
+
+		return( -1 );
+	}
+	if( fingerprints_size < required_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid fingerprints size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	while( data_offset < data_size )
+	{
+		calculate_size = data_size - data_offset;
+
+		if( calculate_size > (size_t) chunk_fingerprints->chunk_size )
+		{
+			calculate_size = (size_t) chunk_fingerprints->chunk_size;
+		}
+		if( sha256_context_initialize(
+		     &context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA256 context.",
+			 function );
+
+			goto on_error;
+		}
+		if( sha256_context_update(
+		     context,
+		     &( data[ data_offset ] ),
+		     calculate_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA256 context.",
+			 function );
+
+			goto on_error;
+		}
+		if( sha256_context_finalize(
+		     context,
+		     &( fingerprints[ fingerprints_offset ] ),
+		     CHUNK_FINGERPRINTS_FINGERPRINT_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize SHA256 context.",
+			 function );
+
+			goto on_error;
+		}
+		if( sha256_context_free(
+		     &context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free SHA256 context.",
+			 function );
+
+			goto on_error;
+		}
+		data_offset         += calculate_size;
+		fingerprints_offset += CHUNK_FINGERPRINTS_FINGERPRINT_SIZE;
+	}
+	return( 1 );
+
+on_error:
+	if( context != NULL )
+	{
+		sha256_context_free(
+		 &context,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Opens the file the chunk fingerprints are written to
+ * A file header is written that is updated when the file is closed
+ * Returns 1 if successful or -1 on error
+ */
+int chunk_fingerprints_open_file(
+     chunk_fingerprints_t *chunk_fingerprints,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "chunk_fingerprints_open_file";
+
+	if( chunk_fingerprints == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk fingerprints.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_fingerprints->file_stream != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk fingerprints - file stream value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	chunk_fingerprints->file_stream = file_stream_open_wide(
+	                                   filename,
+	                                   _SYSTEM_STRING( FILE_STREAM_BINARY_OPEN_WRITE ) );
+#else
+	chunk_fingerprints->file_stream = file_stream_open(
+	                                   filename,
+	                                   FILE_STREAM_BINARY_OPEN_WRITE );
+#endif
+	if( chunk_fingerprints->file_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_fingerprints->media_size       = 0;
+	chunk_fingerprints->number_of_chunks = 0;
+
+	if( chunk_fingerprints_write_file_header(
+	     chunk_fingerprints,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write file header.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	file_stream_close(
+	 chunk_fingerprints->file_stream );
+
+	chunk_fingerprints->file_stream = NULL;
+
+	return( -1 );
+}
+
+/* Writes the file header at the current offset of the file
+ * Returns 1 if successful or -1 on error
+ */
+int chunk_fingerprints_write_file_header(
+     chunk_fingerprints_t *chunk_fingerprints,
+     libcerror_error_t **error )
+{
+	uint8_t file_header[ CHUNK_FINGERPRINTS_FILE_HEADER_SIZE ];
+
+	static char *function = "chunk_fingerprints_write_file_header";
+
+	if( chunk_fingerprints == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk fingerprints.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_fingerprints->file_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk fingerprints - missing file stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     file_header,
+	     chunk_fingerprints_file_signature,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy file signature.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_little_endian(
+	 &( file_header[ 8 ] ),
+	 (uint64_t) chunk_fingerprints->chunk_size );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( file_header[ 16 ] ),
+	 chunk_fingerprints->media_size );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( file_header[ 24 ] ),
+	 chunk_fingerprints->number_of_chunks );
+
+	if( file_stream_write(
+	     chunk_fingerprints->file_stream,
+	     file_header,
+	     CHUNK_FINGERPRINTS_FILE_HEADER_SIZE ) != CHUNK_FINGERPRINTS_FILE_HEADER_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write file header.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Appends the fingerprints of the next part of the media data to the file
+ * The fingerprints must be appended in order of the media data
+ * Returns 1 if successful or -1 on error
+ */
+int chunk_fingerprints_append(
+     chunk_fingerprints_t *chunk_fingerprints,
+     const uint8_t *fingerprints,
+     size_t fingerprints_size,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "chunk_fingerprints_append";
+	size_t required_size  = 0;
+
+	if( chunk_fingerprints_get_fingerprints_size(
+	     chunk_fingerprints,
+	     data_size,
+	     &required_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve fingerprints size.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_fingerprints->file_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk fingerprints - missing file stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( fingerprints == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fingerprints.",
+		 function );
+
+		return( -1 );
+	}
+	if( fingerprints_size != required_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid fingerprints size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_fingerprints->media_size % chunk_fingerprints->chunk_size ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk fingerprints - last chunk is incomplete.",
+		 function );
+
+		return( -1 );
+	}
+	if( fingerprints_size == 0 )
+	{
+		return( 1 );
+	}
+	if( chunk_fingerprints->base_file_stream != NULL )
+	{
+		if( chunk_fingerprints_compare_base(
+		     chunk_fingerprints,
+		     fingerprints,
+		     fingerprints_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to compare fingerprints with base.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( file_stream_write(
+	     chunk_fingerprints->file_stream,
+	     fingerprints,
+	     fingerprints_size ) != fingerprints_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write fingerprints.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_fingerprints->number_of_chunks += fingerprints_size / CHUNK_FINGERPRINTS_FINGERPRINT_SIZE;
+	chunk_fingerprints->media_size       += data_size;
+
+	return( 1 );
+}
+
+/* Opens the chunk fingerprints file of a base image
+ * The fingerprints that are appended are compared with those of the base image
+ * to determine the chunks that changed
+ * Returns 1 if successful or -1 on error
+ */
+int chunk_fingerprints_open_base_file(
+     chunk_fingerprints_t *chunk_fingerprints,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	uint8_t file_header[ CHUNK_FINGERPRINTS_FILE_HEADER_SIZE ];
+
+	static char *function = "chunk_fingerprints_open_base_file";
+	uint64_t chunk_size   = 0;
+
+	if( chunk_fingerprints == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk fingerprints.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_fingerprints->base_file_stream != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk fingerprints - base file stream value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_fingerprints->number_of_chunks != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk fingerprints - fingerprints already appended.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	chunk_fingerprints->base_file_stream = file_stream_open_wide(
+	                                        filename,
+	                                        _SYSTEM_STRING( FILE_STREAM_BINARY_OPEN_READ ) );
+#else
+	chunk_fingerprints->base_file_stream = file_stream_open(
+	                                        filename,
+	                                        FILE_STREAM_BINARY_OPEN_READ );
+#endif
+	if( chunk_fingerprints->base_file_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open base file.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_stream_read(
+	     chunk_fingerprints->base_file_stream,
+	     file_header,
+	     CHUNK_FINGERPRINTS_FILE_HEADER_SIZE ) != CHUNK_FINGERPRINTS_FILE_HEADER_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read base file header.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_compare(
+	     file_header,
+	     chunk_fingerprints_file_signature,
+	     8 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported base file signature.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_to_uint64_little_endian(
+	 &( file_header[ 8 ] ),
+	 chunk_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( file_header[ 24 ] ),
+	 chunk_fingerprints->base_number_of_chunks );
+
+	/* The fingerprints can only be compared if the chunks cover the same data
+	 */
+	if( chunk_size != (uint64_t) chunk_fingerprints->chunk_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported base chunk size: %" PRIu64 " does not match chunk size: %" PRIu32 ".",
+		 function,
+		 chunk_size,
+		 chunk_fingerprints->chunk_size );
+
+		goto on_error;
+	}
+	chunk_fingerprints->number_of_changed_chunks = 0;
+	chunk_fingerprints->number_of_changed_ranges = 0;
+
+	return( 1 );
+
+on_error:
+	file_stream_close(
+	 chunk_fingerprints->base_file_stream );
+
+	chunk_fingerprints->base_file_stream = NULL;
+
+	return( -1 );
+}
+
+/* Appends a changed chunk, which is merged with the last changed chunk range if adjacent
+ * Returns 1 if successful or -1 on error
+ */
+int chunk_fingerprints_append_changed_chunk(
+     chunk_fingerprints_t *chunk_fingerprints,
+     uint64_t chunk_index,
+     libcerror_error_t **error )
+{
+	uint64_t *reallocation               = NULL;
+	static char *function                = "chunk_fingerprints_append_changed_chunk";
+	int maximum_number_of_changed_ranges = 0;
+	int range_index                      = 0;
+
+	if( chunk_fingerprints == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk fingerprints.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_fingerprints->number_of_changed_ranges > 0 )
+	{
+		range_index = ( chunk_fingerprints->number_of_changed_ranges - 1 ) * 2;
+
+		if( ( chunk_fingerprints->changed_ranges[ range_index ] + chunk_fingerprints->changed_ranges[ range_index + 1 ] ) == chunk_index )
+		{
+			chunk_fingerprints->changed_ranges[ range_index + 1 ] += 1;
+			chunk_fingerprints->number_of_changed_chunks          += 1;
+
+			return( 1 );
+		}
+	}
+	if( chunk_fingerprints->number_of_changed_ranges >= chunk_fingerprints->maximum_number_of_changed_ranges )
+	{
+		maximum_number_of_changed_ranges = chunk_fingerprints->maximum_number_of_changed_ranges * 2;
+
+		if( maximum_number_of_changed_ranges == 0 )
+		{
+			maximum_number_of_changed_ranges = 64;
+		}
+		if( ( maximum_number_of_changed_ranges <= chunk_fingerprints->maximum_number_of_changed_ranges )
+		 || ( (size_t) maximum_number_of_changed_ranges > ( (size_t) SSIZE_MAX / ( 2 * sizeof( uint64_t ) ) ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid maximum number of changed ranges value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		reallocation = (uint64_t *) memory_reallocate(
+		                             chunk_fingerprints->changed_ranges,
+		                             sizeof( uint64_t ) * 2 * (size_t) maximum_number_of_changed_ranges );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize changed ranges.",
+			 function );
+
+			return( -1 );
+		}
+		chunk_fingerprints->changed_ranges                   = reallocation;
+		chunk_fingerprints->maximum_number_of_changed_ranges = maximum_number_of_changed_ranges;
+	}
+	range_index = chunk_fingerprints->number_of_changed_ranges * 2;
+
+	chunk_fingerprints->changed_ranges[ range_index ]     = chunk_index;
+	chunk_fingerprints->changed_ranges[ range_index + 1 ] = 1;
+
+	chunk_fingerprints->number_of_changed_ranges += 1;
+	chunk_fingerprints->number_of_changed_chunks += 1;
+
+	return( 1 );
+}
+
+/* Compares the fingerprints that are appended with those of the base image
+ * Chunks beyond the end of the base image are considered changed
+ * Returns 1 if successful or -1 on error
+ */
+int chunk_fingerprints_compare_base(
+     chunk_fingerprints_t *chunk_fingerprints,
+     const uint8_t *fingerprints,
+     size_t fingerprints_size,
+     libcerror_error_t **error )
+{
+	uint8_t base_fingerprint[ CHUNK_FINGERPRINTS_FINGERPRINT_SIZE ];
+
+	static char *function      = "chunk_fingerprints_compare_base";
+	size_t fingerprints_offset = 0;
+	uint64_t chunk_index       = 0;
+	uint8_t is_changed         = 0;
+
+	if( chunk_fingerprints == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk fingerprints.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_fingerprints->base_file_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk fingerprints - missing base file stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( fingerprints == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fingerprints.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( fingerprints_size > (size_t) SSIZE_MAX )
+	 || ( ( fingerprints_size % CHUNK_FINGERPRINTS_FINGERPRINT_SIZE ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid fingerprints size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_index = chunk_fingerprints->number_of_chunks;
+
+	while( fingerprints_offset < fingerprints_size )
+	{
+		is_changed = 1;
+
+		if( chunk_index < chunk_fingerprints->base_number_of_chunks )
+		{
+			if( file_stream_read(
+			     chunk_fingerprints->base_file_stream,
+			     base_fingerprint,
+			     CHUNK_FINGERPRINTS_FINGERPRINT_SIZE ) != CHUNK_FINGERPRINTS_FINGERPRINT_SIZE )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read base fingerprint: %" PRIu64 ".",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			if( memory_compare(
+			     &( fingerprints[ fingerprints_offset ] ),
+			     base_fingerprint,
+			     CHUNK_FINGERPRINTS_FINGERPRINT_SIZE ) == 0 )
+			{
+				is_changed = 0;
+			}
+		}
+		if( is_changed != 0 )
+		{
+			if( chunk_fingerprints_append_changed_chunk(
+			     chunk_fingerprints,
+			     chunk_index,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append changed chunk: %" PRIu64 ".",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+		}
+		fingerprints_offset += CHUNK_FINGERPRINTS_FINGERPRINT_SIZE;
+		chunk_index         += 1;
+	}
+	return( 1 );
+}
+
+/* Prints the chunks that changed compared to the base image to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int chunk_fingerprints_changed_chunks_fprint(
+     chunk_fingerprints_t *chunk_fingerprints,
+     FILE *stream,
+     libcerror_error_t **error )
+{
+	static char *function = "chunk_fingerprints_changed_chunks_fprint";
+	size64_t range_end    = 0;
+	size64_t range_size   = 0;
+	uint64_t first_chunk  = 0;
+	uint64_t range_offset = 0;
+	uint64_t range_chunks = 0;
+	int range_index       = 0;
+
+	if( chunk_fingerprints == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk fingerprints.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 stream,
+	 "Chunks changed compared to the base image:\n" );
+	fprintf(
+	 stream,
+	 "\ttotal number: %" PRIu64 " of %" PRIu64 "\n",
+	 chunk_fingerprints->number_of_changed_chunks,
+	 chunk_fingerprints->number_of_chunks );
+
+	for( range_index = 0;
+	     range_index < chunk_fingerprints->number_of_changed_ranges;
+	     range_index++ )
+	{
+		first_chunk  = chunk_fingerprints->changed_ranges[ range_index * 2 ];
+		range_chunks = chunk_fingerprints->changed_ranges[ ( range_index * 2 ) + 1 ];
+		range_offset = first_chunk * chunk_fingerprints->chunk_size;
+		range_end    = ( first_chunk + range_chunks ) * chunk_fingerprints->chunk_size;
+
+		if( range_end > chunk_fingerprints->media_size )
+		{
+			range_end = chunk_fingerprints->media_size;
+		}
+		range_size = range_end - range_offset;
+
+		fprintf(
+		 stream,
+		 "\tat chunk(s): %" PRIu64 " - %" PRIu64 " number: %" PRIu64 " (offset: 0x%08" PRIx64 " of size: %" PRIu64 ")\n",
+		 first_chunk,
+		 first_chunk + range_chunks,
+		 range_chunks,
+		 range_offset,
+		 range_size );
+	}
+	fprintf(
+	 stream,
+	 "\n" );
+
+	return( 1 );
+}
+
+/* Closes the file the chunk fingerprints are written to
+ * The file header is updated with the media size and number of chunks
+ * Returns 1 if successful or -1 on error
+ */
+int chunk_fingerprints_close_file(
+     chunk_fingerprints_t *chunk_fingerprints,
+     libcerror_error_t **error )
+{
+	static char *function = "chunk_fingerprints_close_file";
+	FILE *file_stream     = NULL;
+
+	if( chunk_fingerprints == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk fingerprints.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_fingerprints->file_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk fingerprints - missing file stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_stream_seek_offset(
+	     chunk_fingerprints->file_stream,
+	     0,
+	     SEEK_SET ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek start of file.",
+		 function );
+
+		goto on_error;
+	}
+	if( chunk_fingerprints_write_file_header(
+	     chunk_fingerprints,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write file header.",
+		 function );
+
+		goto on_error;
+	}
+	file_stream = chunk_fingerprints->file_stream;
+
+	chunk_fingerprints->file_stream = NULL;
+
+	if( file_stream_close(
+	     file_stream ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	file_stream_close(
+	 chunk_fingerprints->file_stream );
+
+	chunk_fingerprints->file_stream = NULL;
+
+	return( -1 );
+}
+
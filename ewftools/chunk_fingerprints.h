@@ -0,0 +1,156 @@
+/*
+ * Chunk fingerprints functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _CHUNK_FINGERPRINTS_H )
+#define _CHUNK_FINGERPRINTS_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#define CHUNK_FINGERPRINTS_FINGERPRINT_SIZE	32
+
+#define CHUNK_FINGERPRINTS_FILE_HEADER_SIZE	32
+
+typedef struct chunk_fingerprints chunk_fingerprints_t;
+
+/* The chunk fingerprints contain the SHA-256 of the uncompressed data of every chunk
+ * so that identical chunks can be detected across images without reading the data
+ */
+struct chunk_fingerprints
+{
+	/* The chunk size
+	 */
+	size32_t chunk_size;
+
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The number of chunks
+	 */
+	uint64_t number_of_chunks;
+
+	/* The file stream the fingerprints are written to
+	 */
+	FILE *file_stream;
+
+	/* The file stream of the fingerprints of the base image
+	 */
+	FILE *base_file_stream;
+
+	/* The number of chunks of the base image
+	 */
+	uint64_t base_number_of_chunks;
+
+	/* The number of changed chunks compared to the base image
+	 */
+	uint64_t number_of_changed_chunks;
+
+	/* The changed chunk ranges, pairs of the first chunk index and the number of chunks
+	 */
+	uint64_t *changed_ranges;
+
+	/* The number of changed chunk ranges
+	 */
+	int number_of_changed_ranges;
+
+	/* The number of changed chunk ranges the array can contain
+	 */
+	int maximum_number_of_changed_ranges;
+};
+
+int chunk_fingerprints_initialize(
+     chunk_fingerprints_t **chunk_fingerprints,
+     size32_t chunk_size,
+     libcerror_error_t **error );
+
+int chunk_fingerprints_free(
+     chunk_fingerprints_t **chunk_fingerprints,
+     libcerror_error_t **error );
+
+int chunk_fingerprints_get_fingerprints_size(
+     chunk_fingerprints_t *chunk_fingerprints,
+     size_t data_size,
+     size_t *fingerprints_size,
+     libcerror_error_t **error );
+
+int chunk_fingerprints_calculate(
+     chunk_fingerprints_t *chunk_fingerprints,
+     const uint8_t *data,
+     size_t data_size,
+     uint8_t *fingerprints,
+     size_t fingerprints_size,
+     libcerror_error_t **error );
+
+int chunk_fingerprints_open_file(
+     chunk_fingerprints_t *chunk_fingerprints,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int chunk_fingerprints_write_file_header(
+     chunk_fingerprints_t *chunk_fingerprints,
+     libcerror_error_t **error );
+
+int chunk_fingerprints_append(
+     chunk_fingerprints_t *chunk_fingerprints,
+     const uint8_t *fingerprints,
+     size_t fingerprints_size,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int chunk_fingerprints_open_base_file(
+     chunk_fingerprints_t *chunk_fingerprints,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int chunk_fingerprints_append_changed_chunk(
+     chunk_fingerprints_t *chunk_fingerprints,
+     uint64_t chunk_index,
+     libcerror_error_t **error );
+
+int chunk_fingerprints_compare_base(
+     chunk_fingerprints_t *chunk_fingerprints,
+     const uint8_t *fingerprints,
+     size_t fingerprints_size,
+     libcerror_error_t **error );
+
+int chunk_fingerprints_changed_chunks_fprint(
+     chunk_fingerprints_t *chunk_fingerprints,
+     FILE *stream,
+     libcerror_error_t **error );
+
+int chunk_fingerprints_close_file(
+     chunk_fingerprints_t *chunk_fingerprints,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _CHUNK_FINGERPRINTS_H ) */
+
@@ -26,6 +26,8 @@
 #include <types.h>
 #include <wide_string.h>
 
+#include <time.h>
+
 #include "byte_size_string.h"
 #include "device_handle.h"
 #include "ewfinput.h"
@@ -35,6 +37,7 @@
 #include "ewftools_libsmdev.h"
 #include "ewftools_libsmraw.h"
 #include "ewftools_system_string.h"
+#include "ewftools_timestamp.h"
 #include "storage_media_buffer.h"
 
 #define DEVICE_HANDLE_INPUT_BUFFER_SIZE		64
@@ -231,6 +234,11 @@ int device_handle_free(
 			memory_free(
 			 ( *device_handle )->toc_filename );
 		}
+		if( ( *device_handle )->track_ranges != NULL )
+		{
+			memory_free(
+			 ( *device_handle )->track_ranges );
+		}
 		if( ( *device_handle )->type == DEVICE_HANDLE_TYPE_DEVICE )
 		{
 			if( ( *device_handle )->smdev_input_handle != NULL )
@@ -801,6 +809,19 @@ int device_handle_open_odraw_input(
 
 		goto on_error;
 	}
+	if( device_handle_build_track_ranges(
+	     device_handle,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to build track ranges.",
+		 function );
+
+		goto on_error;
+	}
 	return( 1 );
 
 on_error:
@@ -819,6 +840,278 @@ on_error:
 	return( -1 );
 }
 
+/* Builds the track ranges of the optical disc raw input
+ * The sector mode conversion of every track is determined once, such that
+ * the user data of the tracks can be read directly from the data files
+ * Returns 1 if successful, 0 if the tracks are not supported or -1 on error
+ */
+int device_handle_build_track_ranges(
+     device_handle_t *device_handle,
+     libcerror_error_t **error )
+{
+	device_handle_track_range_t *track_ranges = NULL;
+	static char *function                     = "device_handle_build_track_ranges";
+	size64_t media_size                       = 0;
+	size_t track_ranges_size                  = 0;
+	off64_t media_offset                      = 0;
+	uint64_t data_file_start_sector           = 0;
+	uint64_t number_of_sectors                = 0;
+	uint64_t start_sector                     = 0;
+	uint32_t bytes_per_sector                 = 0;
+	uint32_t raw_sector_size                  = 0;
+	uint32_t user_data_offset                 = 0;
+	uint8_t track_type                        = 0;
+	int compare_track_index                   = 0;
+	int data_file_index                       = 0;
+	int number_of_data_files                  = 0;
+	int number_of_tracks                      = 0;
+	int track_index                           = 0;
+
+	if( device_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle->odraw_input_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid device handle - missing optical disc raw input handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle->track_ranges != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid device handle - track ranges already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libodraw_handle_get_bytes_per_sector(
+	     device_handle->odraw_input_handle,
+	     &bytes_per_sector,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve bytes per sector from optical disc raw input handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libodraw_handle_get_media_size(
+	     device_handle->odraw_input_handle,
+	     &media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size from optical disc raw input handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libodraw_handle_get_number_of_data_files(
+	     device_handle->odraw_input_handle,
+	     &number_of_data_files,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of optical disc raw data files.",
+		 function );
+
+		goto on_error;
+	}
+	if( libodraw_handle_get_number_of_tracks(
+	     device_handle->odraw_input_handle,
+	     &number_of_tracks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of tracks from optical disc raw input handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( bytes_per_sector == 0 )
+	 || ( number_of_tracks <= 0 ) )
+	{
+		return( 0 );
+	}
+	track_ranges_size = sizeof( device_handle_track_range_t ) * number_of_tracks;
+
+	track_ranges = (device_handle_track_range_t *) memory_allocate(
+	                                                track_ranges_size );
+
+	if( track_ranges == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create track ranges.",
+		 function );
+
+		goto on_error;
+	}
+	for( track_index = 0;
+	     track_index < number_of_tracks;
+	     track_index++ )
+	{
+		if( libodraw_handle_get_track(
+		     device_handle->odraw_input_handle,
+		     track_index,
+		     &start_sector,
+		     &number_of_sectors,
+		     &track_type,
+		     &data_file_index,
+		     &data_file_start_sector,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve track: %d from optical disc raw input handle.",
+			 function,
+			 track_index );
+
+			goto on_error;
+		}
+		raw_sector_size  = 0;
+		user_data_offset = 0;
+
+		/* Only the sector modes of which the user data is stored at a fixed
+		 * offset in every sector can be read directly from the data files
+		 */
+		if( bytes_per_sector == 2048 )
+		{
+			switch( track_type )
+			{
+				case DEVICE_HANDLE_TRACK_TYPE_MODE1_2048:
+				case DEVICE_HANDLE_TRACK_TYPE_MODE2_2048:
+					raw_sector_size = 2048;
+					break;
+
+				case DEVICE_HANDLE_TRACK_TYPE_MODE1_2352:
+					raw_sector_size  = 2352;
+					user_data_offset = 16;
+					break;
+
+				case DEVICE_HANDLE_TRACK_TYPE_MODE2_2336:
+					raw_sector_size  = 2336;
+					user_data_offset = 8;
+					break;
+
+				case DEVICE_HANDLE_TRACK_TYPE_MODE2_2352:
+					raw_sector_size  = 2352;
+					user_data_offset = 24;
+					break;
+
+				default:
+					break;
+			}
+		}
+		else if( bytes_per_sector == 2352 )
+		{
+			switch( track_type )
+			{
+				case DEVICE_HANDLE_TRACK_TYPE_AUDIO:
+				case DEVICE_HANDLE_TRACK_TYPE_MODE1_2352:
+				case DEVICE_HANDLE_TRACK_TYPE_MODE2_2352:
+				case DEVICE_HANDLE_TRACK_TYPE_CDI_2352:
+					raw_sector_size = 2352;
+					break;
+
+				default:
+					break;
+			}
+		}
+		if( ( raw_sector_size == 0 )
+		 || ( data_file_index < 0 )
+		 || ( data_file_index >= number_of_data_files ) )
+		{
+			goto on_not_supported;
+		}
+		/* The tracks must cover the media without gaps
+		 */
+		if( ( start_sector > (uint64_t) INT64_MAX / bytes_per_sector )
+		 || ( (off64_t) ( start_sector * bytes_per_sector ) != media_offset )
+		 || ( number_of_sectors > (uint64_t) ( (size64_t) media_size - media_offset ) / bytes_per_sector )
+		 || ( data_file_start_sector > (uint64_t) INT64_MAX / raw_sector_size ) )
+		{
+			goto on_not_supported;
+		}
+		/* The sectors of the tracks in the same data file must be of the same size
+		 * for the data file offset to be derived from the data file start sector
+		 */
+		for( compare_track_index = 0;
+		     compare_track_index < track_index;
+		     compare_track_index++ )
+		{
+			if( ( track_ranges[ compare_track_index ].data_file_index == data_file_index )
+			 && ( track_ranges[ compare_track_index ].raw_sector_size != raw_sector_size ) )
+			{
+				goto on_not_supported;
+			}
+		}
+		track_ranges[ track_index ].media_offset     = media_offset;
+		track_ranges[ track_index ].media_size       = (size64_t) number_of_sectors * bytes_per_sector;
+		track_ranges[ track_index ].data_file_index  = data_file_index;
+		track_ranges[ track_index ].data_file_offset = (off64_t) ( data_file_start_sector * raw_sector_size );
+		track_ranges[ track_index ].raw_sector_size  = raw_sector_size;
+		track_ranges[ track_index ].user_data_offset = user_data_offset;
+
+		media_offset += (off64_t) track_ranges[ track_index ].media_size;
+	}
+	if( (size64_t) media_offset != media_size )
+	{
+		goto on_not_supported;
+	}
+	device_handle->track_ranges           = track_ranges;
+	device_handle->number_of_track_ranges = number_of_tracks;
+	device_handle->user_sector_size       = bytes_per_sector;
+
+	return( 1 );
+
+on_not_supported:
+	memory_free(
+	 track_ranges );
+
+	return( 0 );
+
+on_error:
+	if( track_ranges != NULL )
+	{
+		memory_free(
+		 track_ranges );
+	}
+	return( -1 );
+}
+
 /* Opens the raw input of the device handle
  * Returns 1 if successful or -1 on error
  */
@@ -984,6 +1277,281 @@ int device_handle_close(
 	return( 0 );
 }
 
+/* Adapts the device read size to the outcome of a device read
+ * A read that contained a read error or that stalled, took much longer than
+ * the average read, halves the read size down to the minimum read size, so that
+ * the error retries around a bad area only re-read small ranges
+ * After a number of consecutive healthy reads the read size is doubled, up to
+ * the maximum read size, so that healthy areas are read with large reads
+ * Returns 1 if successful or -1 on error
+ */
+int device_handle_adapt_read_size(
+     device_handle_t *device_handle,
+     size_t read_size,
+     size_t maximum_read_size,
+     uint64_t read_time,
+     uint8_t read_failed,
+     libcerror_error_t **error )
+{
+	static char *function = "device_handle_adapt_read_size";
+	uint64_t read_latency = 0;
+	uint8_t read_stalled  = 0;
+
+	if( device_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_size == 0 )
+	{
+		return( 1 );
+	}
+	read_latency = ( read_time * 1024 ) / read_size;
+
+	/* Reads that contain an error do not count towards the average latency
+	 * since they include the error retries
+	 */
+	if( read_failed == 0 )
+	{
+		if( ( device_handle->average_read_latency != 0 )
+		 && ( read_latency > ( device_handle->average_read_latency * DEVICE_HANDLE_STALLED_READ_LATENCY_FACTOR ) ) )
+		{
+			read_stalled = 1;
+		}
+		else if( device_handle->average_read_latency == 0 )
+		{
+			device_handle->average_read_latency = read_latency;
+		}
+		else
+		{
+			device_handle->average_read_latency -= device_handle->average_read_latency / 8;
+			device_handle->average_read_latency += read_latency / 8;
+		}
+	}
+	if( device_handle->adaptive_read_size == 0 )
+	{
+		device_handle->adaptive_read_size = maximum_read_size;
+	}
+	if( ( read_failed != 0 )
+	 || ( read_stalled != 0 ) )
+	{
+		device_handle->adaptive_read_size /= 2;
+
+		if( device_handle->adaptive_read_size < device_handle->minimum_read_size )
+		{
+			device_handle->adaptive_read_size = device_handle->minimum_read_size;
+		}
+		device_handle->number_of_healthy_reads = 0;
+	}
+	else
+	{
+		device_handle->number_of_healthy_reads += 1;
+
+		if( device_handle->number_of_healthy_reads >= DEVICE_HANDLE_NUMBER_OF_HEALTHY_READS )
+		{
+			if( device_handle->adaptive_read_size <= ( maximum_read_size / 2 ) )
+			{
+				device_handle->adaptive_read_size *= 2;
+			}
+			else
+			{
+				device_handle->adaptive_read_size = maximum_read_size;
+			}
+			device_handle->number_of_healthy_reads = 0;
+		}
+	}
+	/* Keep the read size a multiple of the minimum read size, which is
+	 * a multiple of the sector size
+	 */
+	if( ( device_handle->adaptive_read_size > device_handle->minimum_read_size )
+	 && ( device_handle->adaptive_read_size < maximum_read_size ) )
+	{
+		device_handle->adaptive_read_size -= device_handle->adaptive_read_size % device_handle->minimum_read_size;
+	}
+	return( 1 );
+}
+
+/* Reads a buffer from the device input handle
+ * The buffer is read with one or more device reads of the adaptive read size
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t device_handle_read_smdev_buffer(
+         device_handle_t *device_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	static char *function              = "device_handle_read_smdev_buffer";
+	size_t buffer_offset               = 0;
+	size_t read_size                   = 0;
+	ssize_t read_count                 = 0;
+	int64_t read_end_timestamp         = 0;
+	int64_t read_start_timestamp       = 0;
+	int number_of_read_errors          = 0;
+	int previous_number_of_read_errors = 0;
+
+	if( device_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	/* Without error granularity there is no bound to shrink the reads to
+	 */
+	if( ( device_handle->minimum_read_size == 0 )
+	 || ( buffer_size <= device_handle->minimum_read_size ) )
+	{
+		return( libsmdev_handle_read_buffer(
+		         device_handle->smdev_input_handle,
+		         buffer,
+		         buffer_size,
+		         error ) );
+	}
+	if( libsmdev_handle_get_number_of_errors(
+	     device_handle->smdev_input_handle,
+	     &previous_number_of_read_errors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of read errors.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < buffer_size )
+	{
+		read_size = buffer_size - buffer_offset;
+
+		if( ( device_handle->adaptive_read_size != 0 )
+		 && ( read_size > device_handle->adaptive_read_size ) )
+		{
+			read_size = device_handle->adaptive_read_size;
+		}
+		if( ewftools_timestamp_get_monotonic(
+		     &read_start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve read start timestamp.",
+			 function );
+
+			return( -1 );
+		}
+		read_count = libsmdev_handle_read_buffer(
+		              device_handle->smdev_input_handle,
+		              &( buffer[ buffer_offset ] ),
+		              read_size,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer from device input handle at offset: %" PRIzd ".",
+			 function,
+			 buffer_offset );
+
+			return( -1 );
+		}
+		if( ewftools_timestamp_get_monotonic(
+		     &read_end_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve read end timestamp.",
+			 function );
+
+			return( -1 );
+		}
+		if( libsmdev_handle_get_number_of_errors(
+		     device_handle->smdev_input_handle,
+		     &number_of_read_errors,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of read errors.",
+			 function );
+
+			return( -1 );
+		}
+		if( device_handle_adapt_read_size(
+		     device_handle,
+		     (size_t) read_count,
+		     buffer_size,
+		     ( read_end_timestamp > read_start_timestamp ) ? (uint64_t) ( read_end_timestamp - read_start_timestamp ) : 0,
+		     (uint8_t) ( number_of_read_errors != previous_number_of_read_errors ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to adapt read size.",
+			 function );
+
+			return( -1 );
+		}
+		previous_number_of_read_errors = number_of_read_errors;
+
+		buffer_offset += (size_t) read_count;
+
+		/* The end of the media was reached
+		 */
+		if( (size_t) read_count < read_size )
+		{
+			break;
+		}
+	}
+	return( (ssize_t) buffer_offset );
+}
+
 /* Reads a storage media buffer from the input of the device handle
  * Returns the number of bytes written or -1 on error
  */
@@ -1021,8 +1589,8 @@ ssize_t device_handle_read_storage_media_buffer(
 	}
 	if( device_handle->type == DEVICE_HANDLE_TYPE_DEVICE )
 	{
-		read_count = libsmdev_handle_read_buffer(
-			      device_handle->smdev_input_handle,
+		read_count = device_handle_read_smdev_buffer(
+			      device_handle,
 			      storage_media_buffer->raw_buffer,
 			      read_size,
 		              error );
@@ -1182,6 +1750,86 @@ off64_t device_handle_seek_offset(
 	return( offset );
 }
 
+/* Reads a buffer at a specific offset in the input
+ * The read is not subject to the error retries and the error granularity of the device handle
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t device_handle_read_buffer_at_offset(
+         device_handle_t *device_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "device_handle_read_buffer_at_offset";
+	ssize_t read_count    = 0;
+
+	if( device_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle_seek_offset(
+	     device_handle,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	if( device_handle->type == DEVICE_HANDLE_TYPE_DEVICE )
+	{
+		read_count = libsmdev_handle_read_buffer(
+			      device_handle->smdev_input_handle,
+			      buffer,
+			      buffer_size,
+		              error );
+	}
+	else if( device_handle->type == DEVICE_HANDLE_TYPE_OPTICAL_DISC_FILE )
+	{
+		read_count = libodraw_handle_read_buffer(
+			      device_handle->odraw_input_handle,
+			      buffer,
+			      buffer_size,
+		              error );
+	}
+	else if( device_handle->type == DEVICE_HANDLE_TYPE_FILE )
+	{
+		read_count = libsmraw_handle_read_buffer(
+			      device_handle->smraw_input_handle,
+			      buffer,
+			      buffer_size,
+		              error );
+	}
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
 /* Prompts the user for a string
  * Returns 1 if successful, 0 if no input was provided or -1 on error
  */
@@ -2333,6 +2981,9 @@ int device_handle_set_error_values(
 
 			return( -1 );
 		}
+		device_handle->minimum_read_size       = error_granularity;
+		device_handle->adaptive_read_size      = 0;
+		device_handle->number_of_healthy_reads = 0;
 	}
 	return( 1 );
 }
@@ -35,6 +35,15 @@
 extern "C" {
 #endif
 
+/* The number of consecutive healthy reads after which the read size is doubled
+ */
+#define DEVICE_HANDLE_NUMBER_OF_HEALTHY_READS		16
+
+/* The factor by which the latency of a read must exceed the average latency
+ * for the read to be considered stalled
+ */
+#define DEVICE_HANDLE_STALLED_READ_LATENCY_FACTOR	8
+
 /* The device handle type definitions
  */
 enum DEVICE_HANDLE_TYPES
@@ -71,6 +80,37 @@ enum DEVICE_HANDLE_TRACK_TYPES
 	DEVICE_HANDLE_TRACK_TYPE_CDI_2352,
 };
 
+typedef struct device_handle_track_range device_handle_track_range_t;
+
+/* The track range maps the sectors of an (optical disc) track onto its data file
+ */
+struct device_handle_track_range
+{
+	/* The media offset
+	 */
+	off64_t media_offset;
+
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The index of the data file
+	 */
+	int data_file_index;
+
+	/* The offset of the first sector in the data file
+	 */
+	off64_t data_file_offset;
+
+	/* The size of a sector in the data file
+	 */
+	uint32_t raw_sector_size;
+
+	/* The offset of the user data in a sector in the data file
+	 */
+	uint32_t user_data_offset;
+};
+
 typedef struct device_handle device_handle_t;
 
 struct device_handle
@@ -95,6 +135,19 @@ struct device_handle
 	 */
 	libodraw_handle_t *odraw_input_handle;
 
+	/* The (optical disc) track ranges
+	 */
+	device_handle_track_range_t *track_ranges;
+
+	/* The number of (optical disc) track ranges, where 0 represents
+	 * the tracks cannot be read directly from the data files
+	 */
+	int number_of_track_ranges;
+
+	/* The number of bytes per sector of the (optical disc) track ranges
+	 */
+	uint32_t user_sector_size;
+
 	/* libsmdev input handle
 	 */
 	libsmdev_handle_t *smdev_input_handle;
@@ -111,6 +164,23 @@ struct device_handle
 	 */
 	uint8_t zero_buffer_on_error;
 
+	/* The minimum size of a device read, which is the error granularity in bytes
+	 */
+	size_t minimum_read_size;
+
+	/* The maximum size of a device read, where 0 represents the read size
+	 * of the storage media buffer
+	 */
+	size_t adaptive_read_size;
+
+	/* The number of consecutive device reads without read errors or stalls
+	 */
+	int number_of_healthy_reads;
+
+	/* The average latency of a device read in nano seconds per KiB
+	 */
+	uint64_t average_read_latency;
+
 	/* The notification output stream
 	 */
 	FILE *notify_stream;
@@ -149,6 +219,10 @@ int device_handle_open_odraw_input(
      int number_of_filenames,
      libcerror_error_t **error );
 
+int device_handle_build_track_ranges(
+     device_handle_t *device_handle,
+     libcerror_error_t **error );
+
 int device_handle_open_smraw_input(
      device_handle_t *device_handle,
      system_character_t * const * filenames,
@@ -159,6 +233,20 @@ int device_handle_close(
      device_handle_t *device_handle,
      libcerror_error_t **error );
 
+int device_handle_adapt_read_size(
+     device_handle_t *device_handle,
+     size_t read_size,
+     size_t maximum_read_size,
+     uint64_t read_time,
+     uint8_t read_failed,
+     libcerror_error_t **error );
+
+ssize_t device_handle_read_smdev_buffer(
+         device_handle_t *device_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
 ssize_t device_handle_read_storage_media_buffer(
          device_handle_t *device_handle,
          storage_media_buffer_t *storage_media_buffer,
@@ -172,6 +260,13 @@ off64_t device_handle_seek_offset(
          int whence,
          libcerror_error_t **error );
 
+ssize_t device_handle_read_buffer_at_offset(
+         device_handle_t *device_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
 int device_handle_prompt_for_string(
      device_handle_t *device_handle,
      const system_character_t *request_string,
@@ -0,0 +1,2793 @@
+/*
+ * Device read-ahead functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H ) || defined( WINAPI )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H ) || defined( WINAPI )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "device_handle.h"
+#include "device_read_ahead.h"
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "storage_media_buffer.h"
+#include "storage_media_buffer_queue.h"
+
+#if defined( HAVE_DEVICE_READ_AHEAD )
+
+/* Creates a device read-ahead
+ * Make sure the value device_read_ahead is referencing, is set to NULL
+ * The filename is that of the first source, where NULL represents no source,
+ * such as for an optical disc raw input of which the data files are opened separately
+ * Returns 1 if successful or -1 on error
+ */
+int device_read_ahead_initialize(
+     device_read_ahead_t **device_read_ahead,
+     const system_character_t *filename,
+     storage_media_buffer_queue_t *storage_media_buffer_queue,
+     int number_of_reads,
+     int maximum_number_of_requests,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "device_read_ahead_initialize";
+	size_t requests_size  = 0;
+
+	if( device_read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( *device_read_ahead != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid device read-ahead value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_reads <= 0 )
+	 || ( number_of_reads > DEVICE_READ_AHEAD_MAXIMUM_NUMBER_OF_READS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of reads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_requests < number_of_reads )
+	 || ( maximum_number_of_requests > DEVICE_READ_AHEAD_MAXIMUM_NUMBER_OF_REQUESTS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of requests value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*device_read_ahead = memory_allocate_structure(
+	                      device_read_ahead_t );
+
+	if( *device_read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create device read-ahead.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *device_read_ahead,
+	     0,
+	     sizeof( device_read_ahead_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear device read-ahead.",
+		 function );
+
+		memory_free(
+		 *device_read_ahead );
+
+		*device_read_ahead = NULL;
+
+		return( -1 );
+	}
+	if( filename != NULL )
+	{
+		if( device_read_ahead_append_source(
+		     *device_read_ahead,
+		     filename,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append source.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	requests_size = sizeof( device_read_ahead_request_t ) * maximum_number_of_requests;
+
+	( *device_read_ahead )->requests = (device_read_ahead_request_t *) memory_allocate(
+	                                                                    requests_size );
+
+	if( ( *device_read_ahead )->requests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create requests.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *device_read_ahead )->requests,
+	     0,
+	     requests_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear requests.",
+		 function );
+
+		goto on_error;
+	}
+	( *device_read_ahead )->maximum_number_of_requests = maximum_number_of_requests;
+
+	if( libcthreads_mutex_initialize(
+	     &( ( *device_read_ahead )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *device_read_ahead )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_thread_pool_create(
+	     &( ( *device_read_ahead )->read_thread_pool ),
+	     NULL,
+	     number_of_reads,
+	     maximum_number_of_requests,
+	     (int (*)(intptr_t *, void *)) &device_read_ahead_read_callback,
+	     (void *) *device_read_ahead,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	( *device_read_ahead )->storage_media_buffer_queue = storage_media_buffer_queue;
+	( *device_read_ahead )->number_of_reads            = number_of_reads;
+	( *device_read_ahead )->buffer_size                = buffer_size;
+
+	return( 1 );
+
+on_error:
+	if( *device_read_ahead != NULL )
+	{
+		device_read_ahead_free(
+		 device_read_ahead,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a device read-ahead
+ * The storage media buffers of the requests are released onto the storage media buffer queue
+ * Returns 1 if successful or -1 on error
+ */
+int device_read_ahead_free(
+     device_read_ahead_t **device_read_ahead,
+     libcerror_error_t **error )
+{
+	static char *function = "device_read_ahead_free";
+	int request_index     = 0;
+	int result            = 1;
+	int source_index      = 0;
+
+	if( device_read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( *device_read_ahead != NULL )
+	{
+		/* Joining the read thread pool waits for the reads in flight to complete
+		 */
+		if( ( *device_read_ahead )->read_thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *device_read_ahead )->read_thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join read thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *device_read_ahead )->requests != NULL )
+		{
+			for( request_index = 0;
+			     request_index < ( *device_read_ahead )->maximum_number_of_requests;
+			     request_index++ )
+			{
+				if( ( *device_read_ahead )->requests[ request_index ].storage_media_buffer != NULL )
+				{
+					if( storage_media_buffer_queue_release_buffer(
+					     ( *device_read_ahead )->storage_media_buffer_queue,
+					     ( *device_read_ahead )->requests[ request_index ].storage_media_buffer,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+						 "%s: unable to release storage media buffer: %d onto queue.",
+						 function,
+						 request_index );
+
+						result = -1;
+					}
+					( *device_read_ahead )->requests[ request_index ].storage_media_buffer = NULL;
+				}
+			}
+			memory_free(
+			 ( *device_read_ahead )->requests );
+		}
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: number of reads in flight: %d, number of fallback reads: %" PRIu64 ", number of second passes: %" PRIu64 "\n",
+			 function,
+			 ( *device_read_ahead )->number_of_reads,
+			 ( *device_read_ahead )->number_of_fallback_reads,
+			 ( *device_read_ahead )->number_of_second_passes );
+
+			for( source_index = 0;
+			     source_index < ( *device_read_ahead )->number_of_sources;
+			     source_index++ )
+			{
+				libcnotify_printf(
+				 "%s: number of bytes read from source: %d: %" PRIu64 "\n",
+				 function,
+				 source_index,
+				 ( *device_read_ahead )->source_read_sizes[ source_index ] );
+			}
+		}
+#endif
+		if( ( *device_read_ahead )->condition != NULL )
+		{
+			if( libcthreads_condition_free(
+			     &( ( *device_read_ahead )->condition ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free condition.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *device_read_ahead )->mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *device_read_ahead )->mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( device_read_ahead_close_data_files(
+		     *device_read_ahead,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close data files.",
+			 function );
+
+			result = -1;
+		}
+		for( source_index = 0;
+		     source_index < ( *device_read_ahead )->number_of_sources;
+		     source_index++ )
+		{
+#if defined( WINAPI )
+			if( CloseHandle(
+			     ( *device_read_ahead )->file_handles[ source_index ] ) == 0 )
+			{
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 (uint32_t) GetLastError(),
+				 "%s: unable to close source: %d.",
+				 function,
+				 source_index );
+
+				result = -1;
+			}
+#else
+			if( close(
+			     ( *device_read_ahead )->file_descriptors[ source_index ] ) != 0 )
+			{
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 errno,
+				 "%s: unable to close source: %d.",
+				 function,
+				 source_index );
+
+				result = -1;
+			}
+#endif
+		}
+		memory_free(
+		 *device_read_ahead );
+
+		*device_read_ahead = NULL;
+	}
+	return( result );
+}
+
+/* Appends a source of the input
+ * The source must contain the same media as the other sources
+ * Sources can only be appended before the first request is submitted
+ * Returns 1 if successful or -1 on error
+ */
+int device_read_ahead_append_source(
+     device_read_ahead_t *device_read_ahead,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "device_read_ahead_append_source";
+	int source_index      = 0;
+
+#if defined( WINAPI )
+	HANDLE file_handle    = INVALID_HANDLE_VALUE;
+#else
+	off_t first_size      = 0;
+	off_t source_size     = 0;
+	int file_descriptor   = -1;
+#endif
+
+	if( device_read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( device_read_ahead->number_of_requests != 0 )
+	 || ( device_read_ahead->next_offset != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid device read-ahead - reads in flight.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( device_read_ahead->number_of_sources < 0 )
+	 || ( device_read_ahead->number_of_sources >= DEVICE_READ_AHEAD_MAXIMUM_NUMBER_OF_SOURCES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid device read-ahead - number of sources value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	source_index = device_read_ahead->number_of_sources;
+
+#if defined( WINAPI )
+	if( device_read_ahead_open_file(
+	     filename,
+	     &file_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open source: %d.",
+		 function,
+		 source_index );
+
+		return( -1 );
+	}
+	device_read_ahead->file_handles[ source_index ] = file_handle;
+#else
+	if( device_read_ahead_open_file(
+	     filename,
+	     &file_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open source: %d.",
+		 function,
+		 source_index );
+
+		return( -1 );
+	}
+	/* The positional reads do not use the file offset, hence the size
+	 * of the sources can be determined by seeking to the end
+	 */
+	if( source_index > 0 )
+	{
+		first_size = lseek(
+		              device_read_ahead->file_descriptors[ 0 ],
+		              0,
+		              SEEK_END );
+
+		source_size = lseek(
+		               file_descriptor,
+		               0,
+		               SEEK_END );
+
+		if( ( first_size > 0 )
+		 && ( source_size > 0 )
+		 && ( source_size != first_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: size of source: %d does not match size of source: 0.",
+			 function,
+			 source_index );
+
+			close(
+			 file_descriptor );
+
+			return( -1 );
+		}
+	}
+	device_read_ahead->file_descriptors[ source_index ] = file_descriptor;
+#endif
+	device_read_ahead->source_number_of_reads[ source_index ] = 0;
+	device_read_ahead->source_read_sizes[ source_index ]      = 0;
+
+	device_read_ahead->number_of_sources += 1;
+
+	return( 1 );
+}
+
+/* Opens a file for positional reads
+ * Returns 1 if successful or -1 on error
+ */
+#if defined( WINAPI )
+int device_read_ahead_open_file(
+     const system_character_t *filename,
+     HANDLE *file_handle,
+     libcerror_error_t **error )
+#else
+int device_read_ahead_open_file(
+     const system_character_t *filename,
+     int *file_descriptor,
+     libcerror_error_t **error )
+#endif
+{
+	static char *function = "device_read_ahead_open_file";
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	if( file_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file handle.",
+		 function );
+
+		return( -1 );
+	}
+	/* The file is opened for overlapped I/O so that the reads
+	 * of the read threads are not serialized on the file object
+	 */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	*file_handle = CreateFileW(
+	                (LPCWSTR) filename,
+	                GENERIC_READ,
+	                FILE_SHARE_READ | FILE_SHARE_WRITE,
+	                NULL,
+	                OPEN_EXISTING,
+	                FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED,
+	                NULL );
+#else
+	*file_handle = CreateFileA(
+	                (LPCSTR) filename,
+	                GENERIC_READ,
+	                FILE_SHARE_READ | FILE_SHARE_WRITE,
+	                NULL,
+	                OPEN_EXISTING,
+	                FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED,
+	                NULL );
+#endif
+	if( *file_handle == INVALID_HANDLE_VALUE )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 (uint32_t) GetLastError(),
+		 "%s: unable to open file.",
+		 function );
+
+		return( -1 );
+	}
+#else
+	if( file_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	*file_descriptor = open(
+	                    (char *) filename,
+	                    O_RDONLY );
+
+	if( *file_descriptor == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to open file.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Reads data at a specific offset of a file
+ * The read continues until the size is read or the end of the file is reached
+ * Returns the number of bytes read or -1 on error
+ */
+#if defined( WINAPI )
+ssize_t device_read_ahead_read_file(
+         HANDLE file_handle,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error )
+#else
+ssize_t device_read_ahead_read_file(
+         int file_descriptor,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error )
+#endif
+{
+	static char *function = "device_read_ahead_read_file";
+	size_t buffer_offset  = 0;
+
+#if defined( WINAPI )
+	OVERLAPPED overlapped;
+
+	off64_t read_offset   = 0;
+	DWORD error_code      = 0;
+	DWORD read_count      = 0;
+#else
+	ssize_t read_count    = 0;
+#endif
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < size )
+	{
+#if defined( WINAPI )
+		read_offset = offset + (off64_t) buffer_offset;
+
+		if( memory_set(
+		     &overlapped,
+		     0,
+		     sizeof( OVERLAPPED ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear overlapped.",
+			 function );
+
+			return( -1 );
+		}
+		overlapped.Offset     = (DWORD) ( read_offset & 0xffffffffUL );
+		overlapped.OffsetHigh = (DWORD) ( read_offset >> 32 );
+		overlapped.hEvent     = CreateEvent(
+		                         NULL,
+		                         TRUE,
+		                         FALSE,
+		                         NULL );
+
+		if( overlapped.hEvent == NULL )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 (uint32_t) GetLastError(),
+			 "%s: unable to create event.",
+			 function );
+
+			return( -1 );
+		}
+		if( ReadFile(
+		     file_handle,
+		     &( buffer[ buffer_offset ] ),
+		     (DWORD) ( size - buffer_offset ),
+		     NULL,
+		     &overlapped ) == 0 )
+		{
+			error_code = GetLastError();
+
+			if( error_code != ERROR_IO_PENDING )
+			{
+				CloseHandle(
+				 overlapped.hEvent );
+
+				/* The end of the file was reached
+				 */
+				if( error_code == ERROR_HANDLE_EOF )
+				{
+					break;
+				}
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 (uint32_t) error_code,
+				 "%s: unable to read data at offset: %" PRIi64 ".",
+				 function,
+				 read_offset );
+
+				return( -1 );
+			}
+		}
+		if( GetOverlappedResult(
+		     file_handle,
+		     &overlapped,
+		     &read_count,
+		     TRUE ) == 0 )
+		{
+			error_code = GetLastError();
+
+			CloseHandle(
+			 overlapped.hEvent );
+
+			if( error_code == ERROR_HANDLE_EOF )
+			{
+				break;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 (uint32_t) error_code,
+			 "%s: unable to read data at offset: %" PRIi64 ".",
+			 function,
+			 read_offset );
+
+			return( -1 );
+		}
+		CloseHandle(
+		 overlapped.hEvent );
+#else
+		read_count = pread(
+		              file_descriptor,
+		              &( buffer[ buffer_offset ] ),
+		              size - buffer_offset,
+		              (off_t) ( offset + (off64_t) buffer_offset ) );
+
+		if( read_count < 0 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 errno,
+			 "%s: unable to read data at offset: %" PRIi64 ".",
+			 function,
+			 offset + (off64_t) buffer_offset );
+
+			return( -1 );
+		}
+#endif
+		/* The end of the file was reached
+		 */
+		if( read_count == 0 )
+		{
+			break;
+		}
+		buffer_offset += (size_t) read_count;
+	}
+	return( (ssize_t) buffer_offset );
+}
+
+/* Retrieves the size of a file
+ * Returns 1 if successful or -1 on error
+ */
+#if defined( WINAPI )
+int device_read_ahead_get_file_size(
+     HANDLE file_handle,
+     size64_t *file_size,
+     libcerror_error_t **error )
+#else
+int device_read_ahead_get_file_size(
+     int file_descriptor,
+     size64_t *file_size,
+     libcerror_error_t **error )
+#endif
+{
+	static char *function = "device_read_ahead_get_file_size";
+
+#if defined( WINAPI )
+	LARGE_INTEGER large_integer_size;
+#else
+	off_t end_offset      = 0;
+#endif
+
+	if( file_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	if( GetFileSizeEx(
+	     file_handle,
+	     &large_integer_size ) == 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 (uint32_t) GetLastError(),
+		 "%s: unable to retrieve file size.",
+		 function );
+
+		return( -1 );
+	}
+	*file_size = (size64_t) large_integer_size.QuadPart;
+#else
+	/* The positional reads do not use the file offset, hence the size
+	 * can be determined by seeking to the end
+	 */
+	end_offset = lseek(
+	              file_descriptor,
+	              0,
+	              SEEK_END );
+
+	if( end_offset < 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 errno,
+		 "%s: unable to seek end of file.",
+		 function );
+
+		return( -1 );
+	}
+	*file_size = (size64_t) end_offset;
+#endif
+	return( 1 );
+}
+
+/* Opens the data files of an optical disc raw input or a split raw input
+ * The data files are read directly using track ranges, for an optical disc raw input
+ * these are the track ranges of the device handle, for a split raw input a track range
+ * is created for every data file
+ * The first and last sector of every track range are compared with the data read using
+ * the device handle, on a mismatch the data files are closed again
+ * When there are more data files than can be kept open, every read opens the data file,
+ * hence the filenames must remain valid while the device read-ahead is used
+ * Data files can only be opened when there are no sources and before the first request is submitted
+ * Returns 1 if successful, 0 if the track ranges are not supported or -1 on error
+ */
+int device_read_ahead_open_data_files(
+     device_read_ahead_t *device_read_ahead,
+     device_handle_t *device_handle,
+     system_character_t * const *filenames,
+     int number_of_filenames,
+     libcerror_error_t **error )
+{
+	off64_t sector_offsets[ 2 ];
+
+	device_handle_track_range_t *track_range = NULL;
+	uint8_t *compare_data                    = NULL;
+	uint8_t *sector_data                     = NULL;
+	static char *function                    = "device_read_ahead_open_data_files";
+	size64_t data_file_size                  = 0;
+	size64_t media_size                      = 0;
+	size_t data_files_size                   = 0;
+	size_t track_ranges_size                 = 0;
+	ssize_t compare_count                    = 0;
+	ssize_t read_count                       = 0;
+	off64_t media_offset                     = 0;
+	uint32_t bytes_per_sector                = 0;
+	uint8_t keep_data_files_open             = 0;
+	int data_file_index                      = 0;
+	int number_of_track_ranges               = 0;
+	int result                               = 1;
+	int sector_iterator                      = 0;
+	int track_range_index                    = 0;
+
+#if defined( WINAPI )
+	HANDLE file_handle                       = INVALID_HANDLE_VALUE;
+#else
+	int file_descriptor                      = -1;
+#endif
+
+	if( device_read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( device_read_ahead->number_of_requests != 0 )
+	 || ( device_read_ahead->next_offset != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid device read-ahead - reads in flight.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( device_read_ahead->number_of_sources != 0 )
+	 || ( device_read_ahead->number_of_data_files != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid device read-ahead - sources already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filenames == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filenames.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_filenames <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of filenames value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle->type == DEVICE_HANDLE_TYPE_OPTICAL_DISC_FILE )
+	{
+		if( device_handle->number_of_track_ranges == 0 )
+		{
+			return( 0 );
+		}
+		number_of_track_ranges = device_handle->number_of_track_ranges;
+		bytes_per_sector       = device_handle->user_sector_size;
+	}
+	else if( ( device_handle->type == DEVICE_HANDLE_TYPE_FILE )
+	      && ( number_of_filenames > 1 ) )
+	{
+		if( device_handle_get_bytes_per_sector(
+		     device_handle,
+		     &bytes_per_sector,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve bytes per sector.",
+			 function );
+
+			goto on_error;
+		}
+		if( device_handle_get_media_size(
+		     device_handle,
+		     &media_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve media size.",
+			 function );
+
+			goto on_error;
+		}
+		number_of_track_ranges = number_of_filenames;
+	}
+	else
+	{
+		return( 0 );
+	}
+	track_ranges_size = sizeof( device_handle_track_range_t ) * number_of_track_ranges;
+
+	device_read_ahead->track_ranges = (device_handle_track_range_t *) memory_allocate(
+	                                                                   track_ranges_size );
+
+	if( device_read_ahead->track_ranges == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create track ranges.",
+		 function );
+
+		goto on_error;
+	}
+	if( device_handle->type == DEVICE_HANDLE_TYPE_OPTICAL_DISC_FILE )
+	{
+		if( memory_copy(
+		     device_read_ahead->track_ranges,
+		     device_handle->track_ranges,
+		     track_ranges_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy track ranges.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	device_read_ahead->number_of_track_ranges = number_of_track_ranges;
+	device_read_ahead->user_sector_size       = bytes_per_sector;
+
+#if defined( WINAPI )
+	data_files_size = sizeof( HANDLE ) * number_of_filenames;
+
+	device_read_ahead->data_file_handles = (HANDLE *) memory_allocate(
+	                                                   data_files_size );
+
+	if( device_read_ahead->data_file_handles == NULL )
+#else
+	data_files_size = sizeof( int ) * number_of_filenames;
+
+	device_read_ahead->data_file_descriptors = (int *) memory_allocate(
+	                                                    data_files_size );
+
+	if( device_read_ahead->data_file_descriptors == NULL )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data files.",
+		 function );
+
+		goto on_error;
+	}
+	device_read_ahead->data_filenames       = filenames;
+	device_read_ahead->number_of_data_files = number_of_filenames;
+
+	if( number_of_filenames <= DEVICE_READ_AHEAD_MAXIMUM_NUMBER_OF_OPEN_DATA_FILES )
+	{
+		keep_data_files_open = 1;
+	}
+	for( data_file_index = 0;
+	     data_file_index < number_of_filenames;
+	     data_file_index++ )
+	{
+#if defined( WINAPI )
+		device_read_ahead->data_file_handles[ data_file_index ] = INVALID_HANDLE_VALUE;
+#else
+		device_read_ahead->data_file_descriptors[ data_file_index ] = -1;
+#endif
+	}
+	for( data_file_index = 0;
+	     data_file_index < number_of_filenames;
+	     data_file_index++ )
+	{
+#if defined( WINAPI )
+		if( device_read_ahead_open_file(
+		     filenames[ data_file_index ],
+		     &file_handle,
+		     error ) != 1 )
+#else
+		if( device_read_ahead_open_file(
+		     filenames[ data_file_index ],
+		     &file_descriptor,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open data file: %d.",
+			 function,
+			 data_file_index );
+
+			goto on_error;
+		}
+		/* The data files of a split raw input are mapped onto the media in the order of their filename
+		 */
+		if( device_handle->type == DEVICE_HANDLE_TYPE_FILE )
+		{
+#if defined( WINAPI )
+			result = device_read_ahead_get_file_size(
+			          file_handle,
+			          &data_file_size,
+			          error );
+#else
+			result = device_read_ahead_get_file_size(
+			          file_descriptor,
+			          &data_file_size,
+			          error );
+#endif
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve size of data file: %d.",
+				 function,
+				 data_file_index );
+
+				goto on_error;
+			}
+			track_range = &( device_read_ahead->track_ranges[ data_file_index ] );
+
+			track_range->media_offset     = media_offset;
+			track_range->media_size       = data_file_size;
+			track_range->data_file_index  = data_file_index;
+			track_range->data_file_offset = 0;
+			track_range->raw_sector_size  = bytes_per_sector;
+			track_range->user_data_offset = 0;
+
+			media_offset += (off64_t) data_file_size;
+		}
+		if( keep_data_files_open != 0 )
+		{
+#if defined( WINAPI )
+			device_read_ahead->data_file_handles[ data_file_index ] = file_handle;
+
+			file_handle = INVALID_HANDLE_VALUE;
+#else
+			device_read_ahead->data_file_descriptors[ data_file_index ] = file_descriptor;
+
+			file_descriptor = -1;
+#endif
+		}
+		else
+		{
+#if defined( WINAPI )
+			CloseHandle(
+			 file_handle );
+
+			file_handle = INVALID_HANDLE_VALUE;
+#else
+			close(
+			 file_descriptor );
+
+			file_descriptor = -1;
+#endif
+		}
+	}
+	/* The data files of a split raw input must cover the media
+	 */
+	if( ( device_handle->type == DEVICE_HANDLE_TYPE_FILE )
+	 && ( (size64_t) media_offset != media_size ) )
+	{
+		result = 0;
+	}
+	else
+	{
+		result = 1;
+
+		sector_data = (uint8_t *) memory_allocate(
+		                           sizeof( uint8_t ) * bytes_per_sector );
+
+		if( sector_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create sector data.",
+			 function );
+
+			goto on_error;
+		}
+		compare_data = (uint8_t *) memory_allocate(
+		                            sizeof( uint8_t ) * bytes_per_sector );
+
+		if( compare_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create compare data.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	for( track_range_index = 0;
+	     ( result == 1 ) && ( track_range_index < device_read_ahead->number_of_track_ranges );
+	     track_range_index++ )
+	{
+		track_range = &( device_read_ahead->track_ranges[ track_range_index ] );
+
+		if( track_range->media_size < (size64_t) bytes_per_sector )
+		{
+			continue;
+		}
+		sector_offsets[ 0 ] = track_range->media_offset;
+		sector_offsets[ 1 ] = track_range->media_offset + (off64_t) track_range->media_size - bytes_per_sector;
+
+		for( sector_iterator = 0;
+		     sector_iterator < 2;
+		     sector_iterator++ )
+		{
+			read_count = device_read_ahead_read_track_ranges(
+			              device_read_ahead,
+			              sector_data,
+			              (size_t) bytes_per_sector,
+			              sector_offsets[ sector_iterator ],
+			              error );
+
+			if( read_count < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read sector at offset: %" PRIi64 " from data files.",
+				 function,
+				 sector_offsets[ sector_iterator ] );
+
+				goto on_error;
+			}
+			compare_count = device_handle_read_buffer_at_offset(
+			                 device_handle,
+			                 compare_data,
+			                 (size_t) bytes_per_sector,
+			                 sector_offsets[ sector_iterator ],
+			                 error );
+
+			if( compare_count < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read sector at offset: %" PRIi64 " from device handle.",
+				 function,
+				 sector_offsets[ sector_iterator ] );
+
+				goto on_error;
+			}
+			if( ( read_count != compare_count )
+			 || ( memory_compare(
+			       sector_data,
+			       compare_data,
+			       (size_t) read_count ) != 0 ) )
+			{
+				result = 0;
+
+				break;
+			}
+		}
+	}
+	if( compare_data != NULL )
+	{
+		memory_free(
+		 compare_data );
+
+		compare_data = NULL;
+	}
+	if( sector_data != NULL )
+	{
+		memory_free(
+		 sector_data );
+
+		sector_data = NULL;
+	}
+	if( result == 0 )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: data files do not match device handle.\n",
+			 function );
+		}
+#endif
+		if( device_read_ahead_close_data_files(
+		     device_read_ahead,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close data files.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( result );
+
+on_error:
+#if defined( WINAPI )
+	if( file_handle != INVALID_HANDLE_VALUE )
+	{
+		CloseHandle(
+		 file_handle );
+	}
+#else
+	if( file_descriptor != -1 )
+	{
+		close(
+		 file_descriptor );
+	}
+#endif
+	if( compare_data != NULL )
+	{
+		memory_free(
+		 compare_data );
+	}
+	if( sector_data != NULL )
+	{
+		memory_free(
+		 sector_data );
+	}
+	device_read_ahead_close_data_files(
+	 device_read_ahead,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Closes the data files of an optical disc raw input or a split raw input
+ * Returns 1 if successful or -1 on error
+ */
+int device_read_ahead_close_data_files(
+     device_read_ahead_t *device_read_ahead,
+     libcerror_error_t **error )
+{
+	static char *function = "device_read_ahead_close_data_files";
+	int data_file_index   = 0;
+	int result            = 1;
+
+	if( device_read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	if( device_read_ahead->data_file_handles != NULL )
+	{
+		for( data_file_index = 0;
+		     data_file_index < device_read_ahead->number_of_data_files;
+		     data_file_index++ )
+		{
+			if( device_read_ahead->data_file_handles[ data_file_index ] == INVALID_HANDLE_VALUE )
+			{
+				continue;
+			}
+			if( CloseHandle(
+			     device_read_ahead->data_file_handles[ data_file_index ] ) == 0 )
+			{
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 (uint32_t) GetLastError(),
+				 "%s: unable to close data file: %d.",
+				 function,
+				 data_file_index );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 device_read_ahead->data_file_handles );
+
+		device_read_ahead->data_file_handles = NULL;
+	}
+#else
+	if( device_read_ahead->data_file_descriptors != NULL )
+	{
+		for( data_file_index = 0;
+		     data_file_index < device_read_ahead->number_of_data_files;
+		     data_file_index++ )
+		{
+			if( device_read_ahead->data_file_descriptors[ data_file_index ] == -1 )
+			{
+				continue;
+			}
+			if( close(
+			     device_read_ahead->data_file_descriptors[ data_file_index ] ) != 0 )
+			{
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 errno,
+				 "%s: unable to close data file: %d.",
+				 function,
+				 data_file_index );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 device_read_ahead->data_file_descriptors );
+
+		device_read_ahead->data_file_descriptors = NULL;
+	}
+#endif
+	if( device_read_ahead->track_ranges != NULL )
+	{
+		memory_free(
+		 device_read_ahead->track_ranges );
+
+		device_read_ahead->track_ranges = NULL;
+	}
+	device_read_ahead->data_filenames         = NULL;
+	device_read_ahead->number_of_data_files   = 0;
+	device_read_ahead->number_of_track_ranges = 0;
+	device_read_ahead->user_sector_size       = 0;
+
+	return( result );
+}
+
+/* Reads data at a specific offset of a data file
+ * A data file that is not kept open is opened for the duration of the read
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t device_read_ahead_read_data_file(
+         device_read_ahead_t *device_read_ahead,
+         int data_file_index,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "device_read_ahead_read_data_file";
+	ssize_t read_count    = 0;
+
+#if defined( WINAPI )
+	HANDLE file_handle    = INVALID_HANDLE_VALUE;
+#else
+	int file_descriptor   = -1;
+#endif
+
+	if( device_read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_file_index < 0 )
+	 || ( data_file_index >= device_read_ahead->number_of_data_files ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data file index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	file_handle = device_read_ahead->data_file_handles[ data_file_index ];
+
+	if( file_handle == INVALID_HANDLE_VALUE )
+	{
+		if( device_read_ahead_open_file(
+		     device_read_ahead->data_filenames[ data_file_index ],
+		     &file_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open data file: %d.",
+			 function,
+			 data_file_index );
+
+			return( -1 );
+		}
+	}
+	read_count = device_read_ahead_read_file(
+	              file_handle,
+	              buffer,
+	              size,
+	              offset,
+	              error );
+
+	if( device_read_ahead->data_file_handles[ data_file_index ] == INVALID_HANDLE_VALUE )
+	{
+		CloseHandle(
+		 file_handle );
+	}
+#else
+	file_descriptor = device_read_ahead->data_file_descriptors[ data_file_index ];
+
+	if( file_descriptor == -1 )
+	{
+		if( device_read_ahead_open_file(
+		     device_read_ahead->data_filenames[ data_file_index ],
+		     &file_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open data file: %d.",
+			 function,
+			 data_file_index );
+
+			return( -1 );
+		}
+	}
+	read_count = device_read_ahead_read_file(
+	              file_descriptor,
+	              buffer,
+	              size,
+	              offset,
+	              error );
+
+	if( device_read_ahead->data_file_descriptors[ data_file_index ] == -1 )
+	{
+		close(
+		 file_descriptor );
+	}
+#endif
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data file: %d.",
+		 function,
+		 data_file_index );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+/* Reads the user data of the track ranges directly from the data files
+ * Tracks of which the sectors contain more than the user data are read in batches of
+ * sectors, from which the user data is copied at the offset of the track range
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t device_read_ahead_read_track_ranges(
+         device_read_ahead_t *device_read_ahead,
+         uint8_t *buffer,
+         size_t size,
+         off64_t media_offset,
+         libcerror_error_t **error )
+{
+	device_handle_track_range_t *track_range = NULL;
+	uint8_t *sector_data                     = NULL;
+	static char *function                    = "device_read_ahead_read_track_ranges";
+	size_t buffer_offset                     = 0;
+	size_t copy_size                         = 0;
+	size_t read_size                         = 0;
+	size_t required_sector_data_size         = 0;
+	size_t sector_data_size                  = 0;
+	size_t sector_offset                     = 0;
+	ssize_t read_count                       = 0;
+	off64_t range_offset                     = 0;
+	uint64_t number_of_sectors               = 0;
+	uint64_t sector_index                    = 0;
+	uint64_t sector_iterator                 = 0;
+	int data_file_index                      = 0;
+	int track_range_index                    = 0;
+
+	if( device_read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( device_read_ahead->track_ranges == NULL )
+	 || ( device_read_ahead->user_sector_size == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid device read-ahead - missing track ranges.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid media offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < size )
+	{
+		/* The track ranges are stored in the order of their media offset without gaps
+		 */
+		while( track_range_index < device_read_ahead->number_of_track_ranges )
+		{
+			track_range = &( device_read_ahead->track_ranges[ track_range_index ] );
+
+			if( media_offset < ( track_range->media_offset + (off64_t) track_range->media_size ) )
+			{
+				break;
+			}
+			track_range_index++;
+		}
+		/* The end of the media was reached
+		 */
+		if( track_range_index >= device_read_ahead->number_of_track_ranges )
+		{
+			break;
+		}
+		data_file_index = track_range->data_file_index;
+		range_offset    = media_offset - track_range->media_offset;
+		read_size       = size - buffer_offset;
+
+		if( (size64_t) read_size > ( track_range->media_size - range_offset ) )
+		{
+			read_size = (size_t) ( track_range->media_size - range_offset );
+		}
+		if( track_range->raw_sector_size == device_read_ahead->user_sector_size )
+		{
+			read_count = device_read_ahead_read_data_file(
+			              device_read_ahead,
+			              data_file_index,
+			              &( buffer[ buffer_offset ] ),
+			              read_size,
+			              track_range->data_file_offset + range_offset,
+			              error );
+
+			if( read_count < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read track range: %d from data file: %d.",
+				 function,
+				 track_range_index,
+				 data_file_index );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			sector_index      = (uint64_t) range_offset / device_read_ahead->user_sector_size;
+			sector_offset     = (size_t) ( (uint64_t) range_offset % device_read_ahead->user_sector_size );
+			number_of_sectors = ( sector_offset + read_size + device_read_ahead->user_sector_size - 1 )
+			                  / device_read_ahead->user_sector_size;
+
+			if( number_of_sectors > DEVICE_READ_AHEAD_MAXIMUM_NUMBER_OF_TRACK_SECTORS )
+			{
+				number_of_sectors = DEVICE_READ_AHEAD_MAXIMUM_NUMBER_OF_TRACK_SECTORS;
+				read_size         = ( (size_t) number_of_sectors * device_read_ahead->user_sector_size ) - sector_offset;
+			}
+			required_sector_data_size = (size_t) number_of_sectors * track_range->raw_sector_size;
+
+			if( required_sector_data_size > sector_data_size )
+			{
+				if( sector_data != NULL )
+				{
+					memory_free(
+					 sector_data );
+				}
+				sector_data_size = (size_t) DEVICE_READ_AHEAD_MAXIMUM_NUMBER_OF_TRACK_SECTORS * track_range->raw_sector_size;
+
+				sector_data = (uint8_t *) memory_allocate(
+				                           sizeof( uint8_t ) * sector_data_size );
+
+				if( sector_data == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to create sector data.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			read_count = device_read_ahead_read_data_file(
+			              device_read_ahead,
+			              data_file_index,
+			              sector_data,
+			              required_sector_data_size,
+			              track_range->data_file_offset + (off64_t) ( sector_index * track_range->raw_sector_size ),
+			              error );
+
+			if( read_count < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read sectors of track range: %d from data file: %d.",
+				 function,
+				 track_range_index,
+				 data_file_index );
+
+				goto on_error;
+			}
+			/* Only the user data of the sectors that were read completely is copied
+			 */
+			number_of_sectors = (uint64_t) read_count / track_range->raw_sector_size;
+			read_count        = 0;
+
+			for( sector_iterator = 0;
+			     sector_iterator < number_of_sectors;
+			     sector_iterator++ )
+			{
+				copy_size = device_read_ahead->user_sector_size - sector_offset;
+
+				if( copy_size > ( read_size - (size_t) read_count ) )
+				{
+					copy_size = read_size - (size_t) read_count;
+				}
+				if( memory_copy(
+				     &( buffer[ buffer_offset + (size_t) read_count ] ),
+				     &( sector_data[ ( sector_iterator * track_range->raw_sector_size ) + track_range->user_data_offset + sector_offset ] ),
+				     copy_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy user data of sector: %" PRIu64 ".",
+					 function,
+					 sector_index + sector_iterator );
+
+					goto on_error;
+				}
+				read_count   += (ssize_t) copy_size;
+				sector_offset = 0;
+
+				if( (size_t) read_count >= read_size )
+				{
+					break;
+				}
+			}
+		}
+		buffer_offset += (size_t) read_count;
+		media_offset  += (off64_t) read_count;
+
+		/* The data file is smaller than the track range
+		 */
+		if( (size_t) read_count < read_size )
+		{
+			break;
+		}
+	}
+	if( sector_data != NULL )
+	{
+		memory_free(
+		 sector_data );
+	}
+	return( (ssize_t) buffer_offset );
+
+on_error:
+	if( sector_data != NULL )
+	{
+		memory_free(
+		 sector_data );
+	}
+	return( -1 );
+}
+
+/* Reads the data of a request from the input
+ * Callback function for the read thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int device_read_ahead_read_callback(
+     device_read_ahead_request_t *request,
+     device_read_ahead_t *device_read_ahead )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "device_read_ahead_read_callback";
+	ssize_t read_count       = 0;
+	int result               = 1;
+	int source_index         = 0;
+	int state                = DEVICE_READ_AHEAD_REQUEST_STATE_COMPLETED;
+
+	if( request == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid request.",
+		 function );
+
+		goto on_error;
+	}
+	if( device_read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device read-ahead.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_grab(
+	     device_read_ahead->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	/* The read is issued to the source with the fewest reads in progress
+	 */
+	for( source_index = 1;
+	     source_index < device_read_ahead->number_of_sources;
+	     source_index++ )
+	{
+		if( device_read_ahead->source_number_of_reads[ source_index ] < device_read_ahead->source_number_of_reads[ request->source_index ] )
+		{
+			request->source_index = source_index;
+		}
+	}
+	device_read_ahead->source_number_of_reads[ request->source_index ] += 1;
+
+	if( libcthreads_mutex_release(
+	     device_read_ahead->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( device_read_ahead->number_of_track_ranges > 0 )
+	{
+		read_count = device_read_ahead_read_track_ranges(
+		              device_read_ahead,
+		              request->storage_media_buffer->raw_buffer,
+		              request->read_size,
+		              device_read_ahead->input_offset + request->storage_media_offset,
+		              &error );
+	}
+	else
+	{
+#if defined( WINAPI )
+		read_count = device_read_ahead_read_file(
+		              device_read_ahead->file_handles[ request->source_index ],
+		              request->storage_media_buffer->raw_buffer,
+		              request->read_size,
+		              device_read_ahead->input_offset + request->storage_media_offset,
+		              &error );
+#else
+		read_count = device_read_ahead_read_file(
+		              device_read_ahead->file_descriptors[ request->source_index ],
+		              request->storage_media_buffer->raw_buffer,
+		              request->read_size,
+		              device_read_ahead->input_offset + request->storage_media_offset,
+		              &error );
+#endif
+	}
+	/* A failed read is read again using the device handle
+	 */
+	if( read_count < 0 )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+
+		read_count = 0;
+		state      = DEVICE_READ_AHEAD_REQUEST_STATE_FAILED;
+	}
+	if( libcthreads_mutex_grab(
+	     device_read_ahead->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	request->read_count = (size_t) read_count;
+	request->state      = state;
+
+	device_read_ahead->source_number_of_reads[ request->source_index ] -= 1;
+	device_read_ahead->source_read_sizes[ request->source_index ]      += (size_t) read_count;
+
+	if( libcthreads_condition_broadcast(
+	     device_read_ahead->condition,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast condition.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     device_read_ahead->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		result = -1;
+	}
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Sets the range of storage media offsets that is read ahead
+ * The input offset is the offset in the input that corresponds with storage media offset 0
+ * Returns 1 if successful or -1 on error
+ */
+int device_read_ahead_set_range(
+     device_read_ahead_t *device_read_ahead,
+     off64_t input_offset,
+     off64_t start_offset,
+     off64_t end_offset,
+     libcerror_error_t **error )
+{
+	static char *function = "device_read_ahead_set_range";
+
+	if( device_read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_read_ahead->number_of_requests != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid device read-ahead - reads in flight.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_offset < 0 )
+	 || ( start_offset < 0 )
+	 || ( end_offset < start_offset ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid range value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	device_read_ahead->input_offset = input_offset;
+	device_read_ahead->next_offset  = start_offset;
+	device_read_ahead->end_offset   = end_offset;
+
+	return( 1 );
+}
+
+/* Submits a request to read the next storage media buffer
+ * The storage media buffer the caller passes is used for the request, if NULL
+ * a storage media buffer is grabbed from the storage media buffer queue
+ * Returns 1 if successful, 0 if there is no data left to request or -1 on error
+ */
+int device_read_ahead_submit_request(
+     device_read_ahead_t *device_read_ahead,
+     storage_media_buffer_t **storage_media_buffer,
+     libcerror_error_t **error )
+{
+	device_read_ahead_request_t *request                 = NULL;
+	storage_media_buffer_t *request_storage_media_buffer = NULL;
+	static char *function                                = "device_read_ahead_submit_request";
+	size_t request_read_size                             = 0;
+	int request_index                                    = 0;
+
+	if( device_read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( device_read_ahead->number_of_requests >= device_read_ahead->maximum_number_of_requests )
+	 || ( device_read_ahead->next_offset >= device_read_ahead->end_offset ) )
+	{
+		return( 0 );
+	}
+	if( *storage_media_buffer != NULL )
+	{
+		request_storage_media_buffer = *storage_media_buffer;
+		*storage_media_buffer        = NULL;
+	}
+	else if( storage_media_buffer_queue_grab_buffer(
+	          device_read_ahead->storage_media_buffer_queue,
+	          &request_storage_media_buffer,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to grab storage media buffer from queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( request_storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	request_read_size = device_read_ahead->buffer_size;
+
+	if( (size64_t) request_read_size > (size64_t) ( device_read_ahead->end_offset - device_read_ahead->next_offset ) )
+	{
+		request_read_size = (size_t) ( device_read_ahead->end_offset - device_read_ahead->next_offset );
+	}
+	if( request_read_size > request_storage_media_buffer->raw_buffer_size )
+	{
+		request_read_size = request_storage_media_buffer->raw_buffer_size;
+	}
+	request_index = ( device_read_ahead->first_request_index + device_read_ahead->number_of_requests )
+	              % device_read_ahead->maximum_number_of_requests;
+
+	request = &( device_read_ahead->requests[ request_index ] );
+
+	request->storage_media_buffer = request_storage_media_buffer;
+	request->storage_media_offset = device_read_ahead->next_offset;
+	request->read_size            = request_read_size;
+	request->read_count           = 0;
+	request->source_index         = 0;
+	request->state                = DEVICE_READ_AHEAD_REQUEST_STATE_PENDING;
+
+	device_read_ahead->number_of_requests += 1;
+	device_read_ahead->next_offset        += (off64_t) request_read_size;
+
+	if( libcthreads_thread_pool_push(
+	     device_read_ahead->read_thread_pool,
+	     (intptr_t *) request,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push request: %d onto read thread pool queue.",
+		 function,
+		 request_index );
+
+		/* The storage media buffer of the request is released when the device read-ahead is freed
+		 */
+		request->state = DEVICE_READ_AHEAD_REQUEST_STATE_FAILED;
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Waits for a request to complete
+ * Returns 1 if successful or -1 on error
+ */
+int device_read_ahead_wait_for_request(
+     device_read_ahead_t *device_read_ahead,
+     device_read_ahead_request_t *request,
+     libcerror_error_t **error )
+{
+	static char *function = "device_read_ahead_wait_for_request";
+	int result            = 1;
+
+	if( device_read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid request.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     device_read_ahead->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( request->state == DEVICE_READ_AHEAD_REQUEST_STATE_PENDING )
+	{
+		if( libcthreads_condition_wait(
+		     device_read_ahead->condition,
+		     device_read_ahead->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     device_read_ahead->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Reads the data of a failed or short request again using the device handle
+ * This applies the error retries and the error granularity of the device handle
+ * and records the read errors
+ * Returns 1 if successful or -1 on error
+ */
+int device_read_ahead_reread_request(
+     device_read_ahead_t *device_read_ahead,
+     device_handle_t *device_handle,
+     device_read_ahead_request_t *request,
+     libcerror_error_t **error )
+{
+	static char *function = "device_read_ahead_reread_request";
+	ssize_t read_count    = 0;
+
+	if( device_read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid request.",
+		 function );
+
+		return( -1 );
+	}
+	device_read_ahead->number_of_fallback_reads += 1;
+
+	if( device_handle_seek_offset(
+	     device_handle,
+	     device_read_ahead->input_offset + request->storage_media_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 " in device handle.",
+		 function,
+		 device_read_ahead->input_offset + request->storage_media_offset );
+
+		return( -1 );
+	}
+	read_count = device_handle_read_storage_media_buffer(
+	              device_handle,
+	              request->storage_media_buffer,
+	              request->storage_media_offset,
+	              request->read_size,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read storage media buffer from device handle.",
+		 function );
+
+		return( -1 );
+	}
+	request->read_count = (size_t) read_count;
+	request->state      = DEVICE_READ_AHEAD_REQUEST_STATE_COMPLETED;
+
+	return( 1 );
+}
+
+/* Runs the second pass over the requests
+ * The data that follows a failed read is read first, up to the maximum number of requests,
+ * after which the failed and short requests are read again using the device handle
+ * Returns 1 if successful or -1 on error
+ */
+int device_read_ahead_second_pass(
+     device_read_ahead_t *device_read_ahead,
+     device_handle_t *device_handle,
+     libcerror_error_t **error )
+{
+	device_read_ahead_request_t *request         = NULL;
+	storage_media_buffer_t *storage_media_buffer = NULL;
+	static char *function                        = "device_read_ahead_second_pass";
+	int request_iterator                         = 0;
+	int result                                   = 0;
+
+	if( device_read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	device_read_ahead->number_of_second_passes += 1;
+
+	/* First pass: read the healthy data that follows the failed read
+	 */
+	do
+	{
+		result = device_read_ahead_submit_request(
+		          device_read_ahead,
+		          &storage_media_buffer,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to submit request.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	while( result != 0 );
+
+	/* Second pass: read the failed ranges again in the order of their offset
+	 */
+	for( request_iterator = 0;
+	     request_iterator < device_read_ahead->number_of_requests;
+	     request_iterator++ )
+	{
+		request = &( device_read_ahead->requests[ ( device_read_ahead->first_request_index + request_iterator )
+		                                          % device_read_ahead->maximum_number_of_requests ] );
+
+		if( device_read_ahead_wait_for_request(
+		     device_read_ahead,
+		     request,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to wait for request: %d.",
+			 function,
+			 request_iterator );
+
+			return( -1 );
+		}
+	}
+	for( request_iterator = 0;
+	     request_iterator < device_read_ahead->number_of_requests;
+	     request_iterator++ )
+	{
+		request = &( device_read_ahead->requests[ ( device_read_ahead->first_request_index + request_iterator )
+		                                          % device_read_ahead->maximum_number_of_requests ] );
+
+		if( ( request->state != DEVICE_READ_AHEAD_REQUEST_STATE_COMPLETED )
+		 || ( request->read_count != request->read_size ) )
+		{
+			if( device_read_ahead_reread_request(
+			     device_read_ahead,
+			     device_handle,
+			     request,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read request: %d again.",
+				 function,
+				 request_iterator );
+
+				return( -1 );
+			}
+		}
+	}
+	return( 1 );
+}
+
+/* Reads a storage media buffer from the input using the read-ahead
+ * The storage media buffer the caller passes is used for a read ahead of the requested
+ * offset, or released onto the storage media buffer queue when it is not needed,
+ * and is replaced by the storage media buffer that contains the data of the requested offset
+ * The reads must be requested in the order of their offset with the size of the storage
+ * media buffer, except for the last read of the range
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t device_read_ahead_read_storage_media_buffer(
+         device_read_ahead_t *device_read_ahead,
+         device_handle_t *device_handle,
+         storage_media_buffer_t **storage_media_buffer,
+         off64_t storage_media_offset,
+         size_t read_size,
+         libcerror_error_t **error )
+{
+	device_read_ahead_request_t *request = NULL;
+	static char *function                = "device_read_ahead_read_storage_media_buffer";
+	int result                           = 0;
+
+	if( device_read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	/* Keep the requested number of reads in flight
+	 */
+	while( device_read_ahead->number_of_requests < device_read_ahead->number_of_reads )
+	{
+		result = device_read_ahead_submit_request(
+		          device_read_ahead,
+		          storage_media_buffer,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to submit request.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+	}
+	if( device_read_ahead->number_of_requests == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid storage media offset: %" PRIi64 " value outside of read-ahead range.",
+		 function,
+		 storage_media_offset );
+
+		return( -1 );
+	}
+	request = &( device_read_ahead->requests[ device_read_ahead->first_request_index ] );
+
+	if( ( request->storage_media_offset != storage_media_offset )
+	 || ( request->read_size != read_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: storage media offset: %" PRIi64 " and read size: %" PRIzd " do not match read-ahead.",
+		 function,
+		 storage_media_offset,
+		 read_size );
+
+		return( -1 );
+	}
+	if( device_read_ahead_wait_for_request(
+	     device_read_ahead,
+	     request,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to wait for request.",
+		 function );
+
+		return( -1 );
+	}
+	/* A storage media buffer that was not needed for a read ahead is returned onto the queue
+	 */
+	if( *storage_media_buffer != NULL )
+	{
+		if( storage_media_buffer_queue_release_buffer(
+		     device_read_ahead->storage_media_buffer_queue,
+		     *storage_media_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release storage media buffer onto queue.",
+			 function );
+
+			return( -1 );
+		}
+		*storage_media_buffer = NULL;
+	}
+	if( ( request->state != DEVICE_READ_AHEAD_REQUEST_STATE_COMPLETED )
+	 || ( request->read_count != read_size ) )
+	{
+		if( device_read_ahead->maximum_number_of_requests > device_read_ahead->number_of_reads )
+		{
+			if( device_read_ahead_second_pass(
+			     device_read_ahead,
+			     device_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to run second pass.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( device_read_ahead_reread_request(
+		          device_read_ahead,
+		          device_handle,
+		          request,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read request again.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	*storage_media_buffer = request->storage_media_buffer;
+
+	request->storage_media_buffer = NULL;
+	request->state                = DEVICE_READ_AHEAD_REQUEST_STATE_UNUSED;
+
+	device_read_ahead->first_request_index = ( device_read_ahead->first_request_index + 1 )
+	                                       % device_read_ahead->maximum_number_of_requests;
+	device_read_ahead->number_of_requests -= 1;
+
+	( *storage_media_buffer )->storage_media_offset = storage_media_offset;
+	( *storage_media_buffer )->requested_size       = read_size;
+	( *storage_media_buffer )->raw_buffer_data_size = request->read_count;
+
+	return( (ssize_t) request->read_count );
+}
+
+#endif /* defined( HAVE_DEVICE_READ_AHEAD ) */
+
@@ -0,0 +1,376 @@
+/*
+ * Device read-ahead functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _DEVICE_READ_AHEAD_H )
+#define _DEVICE_READ_AHEAD_H
+
+#include <common.h>
+#include <types.h>
+
+#include "device_handle.h"
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "storage_media_buffer.h"
+#include "storage_media_buffer_queue.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && ( defined( WINAPI ) || ( defined( HAVE_OPEN ) && defined( HAVE_PREAD ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) ) )
+#define HAVE_DEVICE_READ_AHEAD
+#endif
+
+#if defined( HAVE_DEVICE_READ_AHEAD )
+
+/* The default number of device reads in flight
+ */
+#define DEVICE_READ_AHEAD_DEFAULT_NUMBER_OF_READS	4
+
+/* The maximum number of device reads in flight
+ */
+#define DEVICE_READ_AHEAD_MAXIMUM_NUMBER_OF_READS	64
+
+/* The maximum number of requests
+ */
+#define DEVICE_READ_AHEAD_MAXIMUM_NUMBER_OF_REQUESTS	4096
+
+/* The maximum number of sources
+ */
+#define DEVICE_READ_AHEAD_MAXIMUM_NUMBER_OF_SOURCES	8
+
+/* The maximum number of sectors of a track range that are read at once
+ * when the user data is extracted from the sectors in the data file
+ */
+#define DEVICE_READ_AHEAD_MAXIMUM_NUMBER_OF_TRACK_SECTORS	64
+
+/* The maximum number of data files that are kept open, when there are more
+ * data files every read opens the data file
+ */
+#define DEVICE_READ_AHEAD_MAXIMUM_NUMBER_OF_OPEN_DATA_FILES	64
+
+enum DEVICE_READ_AHEAD_REQUEST_STATES
+{
+	DEVICE_READ_AHEAD_REQUEST_STATE_UNUSED		= 0,
+	DEVICE_READ_AHEAD_REQUEST_STATE_PENDING		= 1,
+	DEVICE_READ_AHEAD_REQUEST_STATE_COMPLETED	= 2,
+	DEVICE_READ_AHEAD_REQUEST_STATE_FAILED		= 3
+};
+
+typedef struct device_read_ahead_request device_read_ahead_request_t;
+
+struct device_read_ahead_request
+{
+	/* The storage media buffer that is read into
+	 */
+	storage_media_buffer_t *storage_media_buffer;
+
+	/* The storage media offset
+	 */
+	off64_t storage_media_offset;
+
+	/* The read size
+	 */
+	size_t read_size;
+
+	/* The number of bytes read
+	 */
+	size_t read_count;
+
+	/* The index of the source the data was read from
+	 */
+	int source_index;
+
+	/* The state
+	 */
+	int state;
+};
+
+typedef struct device_read_ahead device_read_ahead_t;
+
+/* The device read-ahead keeps multiple positional reads of the input in flight
+ * on a separate read-only file descriptor, while the storage media buffers
+ * are handed to the caller in the order of their offset
+ * A read that fails or returns less data than requested is read again
+ * using the device handle, which provides error retries and error granularity
+ *
+ * When the maximum number of requests exceeds the number of reads in flight
+ * the read-ahead uses two passes: on a failed read it first continues to read
+ * the data that follows, up to the maximum number of requests, and only then
+ * reads the failed ranges again using the device handle
+ *
+ * The same media can be read from multiple sources, such as the same device
+ * attached by different paths or the members of a mirror. Every read is
+ * issued to the source with the fewest reads in progress so that faster
+ * sources read more of the data
+ *
+ * The tracks of an optical disc raw input are read directly from its data
+ * files using the track ranges of the device handle, which describe the
+ * sector mode conversion of every track. The segment files of a split raw
+ * input are read directly in the same way, with a track range per segment
+ * file. The reads in flight can therefore span multiple tracks, segment
+ * files and data files
+ */
+struct device_read_ahead
+{
+#if defined( WINAPI )
+	/* The file handles of the sources
+	 */
+	HANDLE file_handles[ DEVICE_READ_AHEAD_MAXIMUM_NUMBER_OF_SOURCES ];
+#else
+	/* The file descriptors of the sources
+	 */
+	int file_descriptors[ DEVICE_READ_AHEAD_MAXIMUM_NUMBER_OF_SOURCES ];
+#endif
+
+	/* The number of sources
+	 */
+	int number_of_sources;
+
+	/* The number of reads in progress per source
+	 */
+	int source_number_of_reads[ DEVICE_READ_AHEAD_MAXIMUM_NUMBER_OF_SOURCES ];
+
+	/* The number of bytes read per source
+	 */
+	uint64_t source_read_sizes[ DEVICE_READ_AHEAD_MAXIMUM_NUMBER_OF_SOURCES ];
+
+#if defined( WINAPI )
+	/* The file handles of the data files, where INVALID_HANDLE_VALUE
+	 * represents a data file that is not kept open
+	 */
+	HANDLE *data_file_handles;
+#else
+	/* The file descriptors of the data files, where -1 represents
+	 * a data file that is not kept open
+	 */
+	int *data_file_descriptors;
+#endif
+
+	/* The filenames of the data files
+	 */
+	system_character_t * const *data_filenames;
+
+	/* The number of data files
+	 */
+	int number_of_data_files;
+
+	/* The track ranges of the data files
+	 */
+	device_handle_track_range_t *track_ranges;
+
+	/* The number of track ranges
+	 */
+	int number_of_track_ranges;
+
+	/* The number of bytes per sector of the track ranges
+	 */
+	uint32_t user_sector_size;
+
+	/* The storage media buffer queue
+	 */
+	storage_media_buffer_queue_t *storage_media_buffer_queue;
+
+	/* The read thread pool
+	 */
+	libcthreads_thread_pool_t *read_thread_pool;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when a read completes
+	 */
+	libcthreads_condition_t *condition;
+
+	/* The requests
+	 */
+	device_read_ahead_request_t *requests;
+
+	/* The maximum number of requests
+	 */
+	int maximum_number_of_requests;
+
+	/* The number of reads in flight
+	 */
+	int number_of_reads;
+
+	/* The index of the first request
+	 */
+	int first_request_index;
+
+	/* The number of requests
+	 */
+	int number_of_requests;
+
+	/* The size of the storage media buffers
+	 */
+	size_t buffer_size;
+
+	/* The offset in the input of storage media offset 0
+	 */
+	off64_t input_offset;
+
+	/* The offset of the next request
+	 */
+	off64_t next_offset;
+
+	/* The end offset
+	 */
+	off64_t end_offset;
+
+	/* The number of reads that were read again using the device handle
+	 */
+	uint64_t number_of_fallback_reads;
+
+	/* The number of times failed reads were deferred to a second pass
+	 */
+	uint64_t number_of_second_passes;
+};
+
+int device_read_ahead_initialize(
+     device_read_ahead_t **device_read_ahead,
+     const system_character_t *filename,
+     storage_media_buffer_queue_t *storage_media_buffer_queue,
+     int number_of_reads,
+     int maximum_number_of_requests,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int device_read_ahead_free(
+     device_read_ahead_t **device_read_ahead,
+     libcerror_error_t **error );
+
+int device_read_ahead_append_source(
+     device_read_ahead_t *device_read_ahead,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+#if defined( WINAPI )
+int device_read_ahead_open_file(
+     const system_character_t *filename,
+     HANDLE *file_handle,
+     libcerror_error_t **error );
+
+ssize_t device_read_ahead_read_file(
+         HANDLE file_handle,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+int device_read_ahead_get_file_size(
+     HANDLE file_handle,
+     size64_t *file_size,
+     libcerror_error_t **error );
+#else
+int device_read_ahead_open_file(
+     const system_character_t *filename,
+     int *file_descriptor,
+     libcerror_error_t **error );
+
+ssize_t device_read_ahead_read_file(
+         int file_descriptor,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+int device_read_ahead_get_file_size(
+     int file_descriptor,
+     size64_t *file_size,
+     libcerror_error_t **error );
+#endif
+
+int device_read_ahead_open_data_files(
+     device_read_ahead_t *device_read_ahead,
+     device_handle_t *device_handle,
+     system_character_t * const *filenames,
+     int number_of_filenames,
+     libcerror_error_t **error );
+
+int device_read_ahead_close_data_files(
+     device_read_ahead_t *device_read_ahead,
+     libcerror_error_t **error );
+
+ssize_t device_read_ahead_read_data_file(
+         device_read_ahead_t *device_read_ahead,
+         int data_file_index,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+ssize_t device_read_ahead_read_track_ranges(
+         device_read_ahead_t *device_read_ahead,
+         uint8_t *buffer,
+         size_t size,
+         off64_t media_offset,
+         libcerror_error_t **error );
+
+int device_read_ahead_read_callback(
+     device_read_ahead_request_t *request,
+     device_read_ahead_t *device_read_ahead );
+
+int device_read_ahead_set_range(
+     device_read_ahead_t *device_read_ahead,
+     off64_t input_offset,
+     off64_t start_offset,
+     off64_t end_offset,
+     libcerror_error_t **error );
+
+int device_read_ahead_submit_request(
+     device_read_ahead_t *device_read_ahead,
+     storage_media_buffer_t **storage_media_buffer,
+     libcerror_error_t **error );
+
+int device_read_ahead_wait_for_request(
+     device_read_ahead_t *device_read_ahead,
+     device_read_ahead_request_t *request,
+     libcerror_error_t **error );
+
+int device_read_ahead_reread_request(
+     device_read_ahead_t *device_read_ahead,
+     device_handle_t *device_handle,
+     device_read_ahead_request_t *request,
+     libcerror_error_t **error );
+
+int device_read_ahead_second_pass(
+     device_read_ahead_t *device_read_ahead,
+     device_handle_t *device_handle,
+     libcerror_error_t **error );
+
+ssize_t device_read_ahead_read_storage_media_buffer(
+         device_read_ahead_t *device_read_ahead,
+         device_handle_t *device_handle,
+         storage_media_buffer_t **storage_media_buffer,
+         off64_t storage_media_offset,
+         size_t read_size,
+         libcerror_error_t **error );
+
+#endif /* defined( HAVE_DEVICE_READ_AHEAD ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _DEVICE_READ_AHEAD_H ) */
+
@@ -0,0 +1,1237 @@
+/*
+ * Digest pipeline functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "digest_pipeline.h"
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libhmac.h"
+#include "md5_context.h"
+#include "range_digests.h"
+#include "sha1_context.h"
+#include "sha256_context.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Creates a digest pipeline
+ * Make sure the value pipeline is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int digest_pipeline_initialize(
+     digest_pipeline_t **pipeline,
+     int number_of_slots,
+     size_t slot_size,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_pipeline_initialize";
+
+	if( pipeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pipeline.",
+		 function );
+
+		return( -1 );
+	}
+	if( *pipeline != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid pipeline value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_slots <= 0 )
+	 || ( (size_t) number_of_slots > ( (size_t) SSIZE_MAX / sizeof( size_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of slots value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( slot_size == 0 )
+	 || ( slot_size > ( (size_t) SSIZE_MAX / number_of_slots ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid slot size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*pipeline = memory_allocate_structure(
+	             digest_pipeline_t );
+
+	if( *pipeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create pipeline.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *pipeline,
+	     0,
+	     sizeof( digest_pipeline_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear pipeline.",
+		 function );
+
+		memory_free(
+		 *pipeline );
+
+		*pipeline = NULL;
+
+		return( -1 );
+	}
+	( *pipeline )->slots_data = (uint8_t *) memory_allocate(
+	                                         sizeof( uint8_t ) * slot_size * number_of_slots );
+
+	if( ( *pipeline )->slots_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create slots data.",
+		 function );
+
+		goto on_error;
+	}
+	( *pipeline )->slot_data_sizes = (size_t *) memory_allocate(
+	                                             sizeof( size_t ) * number_of_slots );
+
+	if( ( *pipeline )->slot_data_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create slot data sizes.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *pipeline )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *pipeline )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	( *pipeline )->number_of_slots = number_of_slots;
+	( *pipeline )->slot_size       = slot_size;
+
+	return( 1 );
+
+on_error:
+	if( *pipeline != NULL )
+	{
+		if( ( *pipeline )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *pipeline )->mutex ),
+			 NULL );
+		}
+		if( ( *pipeline )->slot_data_sizes != NULL )
+		{
+			memory_free(
+			 ( *pipeline )->slot_data_sizes );
+		}
+		if( ( *pipeline )->slots_data != NULL )
+		{
+			memory_free(
+			 ( *pipeline )->slots_data );
+		}
+		memory_free(
+		 *pipeline );
+
+		*pipeline = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a digest pipeline
+ * The digest threads are stopped if they are still running
+ * Returns 1 if successful or -1 on error
+ */
+int digest_pipeline_free(
+     digest_pipeline_t **pipeline,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_pipeline_free";
+	int result            = 1;
+
+	if( pipeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pipeline.",
+		 function );
+
+		return( -1 );
+	}
+	if( *pipeline != NULL )
+	{
+		if( ( *pipeline )->is_started != 0 )
+		{
+			if( digest_pipeline_stop(
+			     *pipeline,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to stop pipeline.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_condition_free(
+		     &( ( *pipeline )->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *pipeline )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 ( *pipeline )->slot_data_sizes );
+
+		memory_free(
+		 ( *pipeline )->slots_data );
+
+		memory_free(
+		 *pipeline );
+
+		*pipeline = NULL;
+	}
+	return( result );
+}
+
+/* Adds a digest to the pipeline
+ * Returns 1 if successful or -1 on error
+ */
+int digest_pipeline_add_digest(
+     digest_pipeline_t *pipeline,
+     int digest_type,
+     intptr_t *context,
+     libcerror_error_t **error )
+{
+	digest_pipeline_digest_t *digest = NULL;
+	static char *function            = "digest_pipeline_add_digest";
+
+	if( pipeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pipeline.",
+		 function );
+
+		return( -1 );
+	}
+	if( pipeline->is_started != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid pipeline - already started.",
+		 function );
+
+		return( -1 );
+	}
+	if( pipeline->number_of_digests >= DIGEST_PIPELINE_MAXIMUM_NUMBER_OF_DIGESTS )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid pipeline - number of digests value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( digest_type != DIGEST_PIPELINE_DIGEST_TYPE_MD5 )
+	 && ( digest_type != DIGEST_PIPELINE_DIGEST_TYPE_SHA1 )
+	 && ( digest_type != DIGEST_PIPELINE_DIGEST_TYPE_SHA256 )
+	 && ( digest_type != DIGEST_PIPELINE_DIGEST_TYPE_RANGE_DIGESTS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported digest type.",
+		 function );
+
+		return( -1 );
+	}
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	digest = &( pipeline->digests[ pipeline->number_of_digests ] );
+
+	digest->pipeline             = pipeline;
+	digest->digest_type          = digest_type;
+	digest->context              = context;
+	digest->thread               = NULL;
+	digest->number_of_read_slots = 0;
+	digest->result               = 1;
+
+	pipeline->number_of_digests += 1;
+
+	return( 1 );
+}
+
+/* Starts the digest threads
+ * Returns 1 if successful or -1 on error
+ */
+int digest_pipeline_start(
+     digest_pipeline_t *pipeline,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_pipeline_start";
+	int digest_index      = 0;
+
+	if( pipeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pipeline.",
+		 function );
+
+		return( -1 );
+	}
+	if( pipeline->is_started != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid pipeline - already started.",
+		 function );
+
+		return( -1 );
+	}
+	pipeline->number_of_written_slots = 0;
+	pipeline->write_slot_data_size    = 0;
+	pipeline->end_of_data             = 0;
+	pipeline->is_started              = 1;
+
+	for( digest_index = 0;
+	     digest_index < pipeline->number_of_digests;
+	     digest_index++ )
+	{
+		if( libcthreads_thread_create(
+		     &( pipeline->digests[ digest_index ].thread ),
+		     NULL,
+		     (int (*)(void *)) &digest_pipeline_digest_thread_function,
+		     (void *) &( pipeline->digests[ digest_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create digest: %d thread.",
+			 function,
+			 digest_index );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	digest_pipeline_stop(
+	 pipeline,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Waits until the slot that is written next is no longer read by any of the digest threads
+ * Returns 1 if successful or -1 on error
+ */
+int digest_pipeline_wait_for_free_slot(
+     digest_pipeline_t *pipeline,
+     libcerror_error_t **error )
+{
+	static char *function      = "digest_pipeline_wait_for_free_slot";
+	uint64_t minimum_read_slot = 0;
+	int digest_index           = 0;
+	int result                 = 1;
+
+	if( pipeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pipeline.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     pipeline->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( result == 1 )
+	{
+		minimum_read_slot = pipeline->number_of_written_slots;
+
+		for( digest_index = 0;
+		     digest_index < pipeline->number_of_digests;
+		     digest_index++ )
+		{
+			if( pipeline->digests[ digest_index ].number_of_read_slots < minimum_read_slot )
+			{
+				minimum_read_slot = pipeline->digests[ digest_index ].number_of_read_slots;
+			}
+		}
+		if( ( pipeline->number_of_written_slots - minimum_read_slot ) < (uint64_t) pipeline->number_of_slots )
+		{
+			break;
+		}
+		if( libcthreads_condition_wait(
+		     pipeline->condition,
+		     pipeline->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     pipeline->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Publishes the slot that is currently being written to the digest threads
+ * Returns 1 if successful or -1 on error
+ */
+int digest_pipeline_publish_slot(
+     digest_pipeline_t *pipeline,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_pipeline_publish_slot";
+	int result            = 1;
+	int slot_index        = 0;
+
+	if( pipeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pipeline.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     pipeline->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	slot_index = (int) ( pipeline->number_of_written_slots % pipeline->number_of_slots );
+
+	pipeline->slot_data_sizes[ slot_index ] = pipeline->write_slot_data_size;
+
+	pipeline->number_of_written_slots += 1;
+
+	if( libcthreads_condition_broadcast(
+	     pipeline->condition,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast condition.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     pipeline->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	pipeline->write_slot_data_size = 0;
+
+	return( result );
+}
+
+/* Appends data to the pipeline
+ * The data is copied into the slots and a slot is published when it is full
+ * Returns 1 if successful or -1 on error
+ */
+int digest_pipeline_append_data(
+     digest_pipeline_t *pipeline,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t *slot_data    = NULL;
+	static char *function = "digest_pipeline_append_data";
+	size_t copy_size      = 0;
+	size_t data_offset    = 0;
+	int slot_index        = 0;
+
+	if( pipeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pipeline.",
+		 function );
+
+		return( -1 );
+	}
+	if( pipeline->is_started == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid pipeline - not started.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( data_offset < data_size )
+	{
+		/* The data of a slot can only be written once all digest threads have read it
+		 */
+		if( pipeline->write_slot_data_size == 0 )
+		{
+			if( digest_pipeline_wait_for_free_slot(
+			     pipeline,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to wait for free slot.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		slot_index = (int) ( pipeline->number_of_written_slots % pipeline->number_of_slots );
+		slot_data  = &( pipeline->slots_data[ slot_index * pipeline->slot_size ] );
+
+		copy_size = pipeline->slot_size - pipeline->write_slot_data_size;
+
+		if( copy_size > ( data_size - data_offset ) )
+		{
+			copy_size = data_size - data_offset;
+		}
+		if( memory_copy(
+		     &( slot_data[ pipeline->write_slot_data_size ] ),
+		     &( data[ data_offset ] ),
+		     copy_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data to slot: %d.",
+			 function,
+			 slot_index );
+
+			return( -1 );
+		}
+		pipeline->write_slot_data_size += copy_size;
+		data_offset                    += copy_size;
+
+		if( pipeline->write_slot_data_size == pipeline->slot_size )
+		{
+			if( digest_pipeline_publish_slot(
+			     pipeline,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to publish slot: %d.",
+				 function,
+				 slot_index );
+
+				return( -1 );
+			}
+		}
+	}
+	return( 1 );
+}
+
+/* Flushes the pipeline
+ * Publishes the slot that is currently being written and waits until
+ * the digest threads have read all the slots, such that the digest contexts
+ * contain all the data appended to the pipeline
+ * Returns 1 if successful or -1 on error
+ */
+int digest_pipeline_flush(
+     digest_pipeline_t *pipeline,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_pipeline_flush";
+	int digest_index      = 0;
+	int result            = 1;
+	uint8_t is_flushed    = 0;
+
+	if( pipeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pipeline.",
+		 function );
+
+		return( -1 );
+	}
+	if( pipeline->is_started == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid pipeline - not started.",
+		 function );
+
+		return( -1 );
+	}
+	if( pipeline->write_slot_data_size > 0 )
+	{
+		if( digest_pipeline_publish_slot(
+		     pipeline,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to publish slot.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libcthreads_mutex_grab(
+	     pipeline->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( result == 1 )
+	{
+		is_flushed = 1;
+
+		for( digest_index = 0;
+		     digest_index < pipeline->number_of_digests;
+		     digest_index++ )
+		{
+			if( pipeline->digests[ digest_index ].result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: digest: %d failed.",
+				 function,
+				 digest_index );
+
+				result = -1;
+
+				break;
+			}
+			if( pipeline->digests[ digest_index ].number_of_read_slots < pipeline->number_of_written_slots )
+			{
+				is_flushed = 0;
+			}
+		}
+		if( ( result != 1 )
+		 || ( is_flushed != 0 ) )
+		{
+			break;
+		}
+		if( libcthreads_condition_wait(
+		     pipeline->condition,
+		     pipeline->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     pipeline->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Stops the digest threads once they have read all the data
+ * Returns 1 if successful or -1 on error
+ */
+int digest_pipeline_stop(
+     digest_pipeline_t *pipeline,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_pipeline_stop";
+	int digest_index      = 0;
+	int result            = 1;
+
+	if( pipeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pipeline.",
+		 function );
+
+		return( -1 );
+	}
+	if( pipeline->is_started == 0 )
+	{
+		return( 1 );
+	}
+	if( pipeline->write_slot_data_size > 0 )
+	{
+		if( digest_pipeline_publish_slot(
+		     pipeline,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to publish last slot.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libcthreads_mutex_grab(
+	     pipeline->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	pipeline->end_of_data = 1;
+
+	if( libcthreads_condition_broadcast(
+	     pipeline->condition,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast condition.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     pipeline->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	for( digest_index = 0;
+	     digest_index < pipeline->number_of_digests;
+	     digest_index++ )
+	{
+		if( pipeline->digests[ digest_index ].thread != NULL )
+		{
+			if( libcthreads_thread_join(
+			     &( pipeline->digests[ digest_index ].thread ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join digest: %d thread.",
+				 function,
+				 digest_index );
+
+				result = -1;
+			}
+		}
+		if( pipeline->digests[ digest_index ].result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to calculate digest: %d.",
+			 function,
+			 digest_index );
+
+			result = -1;
+		}
+	}
+	pipeline->is_started = 0;
+
+	return( result );
+}
+
+/* Updates a digest
+ * Returns 1 if successful or -1 on error
+ */
+int digest_pipeline_digest_update(
+     digest_pipeline_digest_t *digest,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_pipeline_digest_update";
+	int result            = 0;
+
+	if( digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest.",
+		 function );
+
+		return( -1 );
+	}
+	switch( digest->digest_type )
+	{
+		case DIGEST_PIPELINE_DIGEST_TYPE_MD5:
+			result = md5_context_update(
+			          (md5_context_t *) digest->context,
+			          data,
+			          data_size,
+			          error );
+			break;
+
+		case DIGEST_PIPELINE_DIGEST_TYPE_SHA1:
+			result = sha1_context_update(
+			          (sha1_context_t *) digest->context,
+			          data,
+			          data_size,
+			          error );
+			break;
+
+		case DIGEST_PIPELINE_DIGEST_TYPE_SHA256:
+			result = sha256_context_update(
+			          (sha256_context_t *) digest->context,
+			          data,
+			          data_size,
+			          error );
+			break;
+
+		case DIGEST_PIPELINE_DIGEST_TYPE_RANGE_DIGESTS:
+			result = range_digests_update(
+			          (range_digests_t *) digest->context,
+			          data,
+			          data_size,
+			          error );
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported digest type.",
+			 function );
+
+			return( -1 );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update digest.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the slots, in order, and updates the digest
+ * Callback function for the digest threads
+ * Returns 1 if successful or -1 on error
+ */
+int digest_pipeline_digest_thread_function(
+     digest_pipeline_digest_t *digest )
+{
+	libcerror_error_t *error     = NULL;
+	digest_pipeline_t *pipeline  = NULL;
+	static char *function        = "digest_pipeline_digest_thread_function";
+	size_t slot_data_size        = 0;
+	int result                   = 1;
+	int slot_index               = 0;
+
+	if( digest == NULL )
+	{
+		return( -1 );
+	}
+	pipeline = digest->pipeline;
+
+	if( libcthreads_mutex_grab(
+	     pipeline->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	while( result != -1 )
+	{
+		if( digest->number_of_read_slots == pipeline->number_of_written_slots )
+		{
+			if( pipeline->end_of_data != 0 )
+			{
+				break;
+			}
+			if( libcthreads_condition_wait(
+			     pipeline->condition,
+			     pipeline->mutex,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to wait for condition.",
+				 function );
+
+				result = -1;
+			}
+			continue;
+		}
+		slot_index     = (int) ( digest->number_of_read_slots % pipeline->number_of_slots );
+		slot_data_size = pipeline->slot_data_sizes[ slot_index ];
+
+		if( libcthreads_mutex_release(
+		     pipeline->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			goto on_error;
+		}
+		/* The slot is read without holding the mutex, the writer does not
+		 * write the slot before it has been read by all the digest threads
+		 * After a failed update the slots are still read so that the writer
+		 * is not blocked
+		 */
+		if( digest->result == 1 )
+		{
+			if( digest_pipeline_digest_update(
+			     digest,
+			     &( pipeline->slots_data[ slot_index * pipeline->slot_size ] ),
+			     slot_data_size,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update digest.",
+				 function );
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_print_error_backtrace(
+					 error );
+				}
+#endif
+				libcerror_error_free(
+				 &error );
+
+				digest->result = -1;
+			}
+		}
+		if( libcthreads_mutex_grab(
+		     pipeline->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			goto on_error;
+		}
+		digest->number_of_read_slots += 1;
+
+		if( libcthreads_condition_broadcast(
+		     pipeline->condition,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast condition.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     pipeline->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	return( digest->result );
+
+on_error:
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	digest->result = -1;
+
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,197 @@
+/*
+ * Digest pipeline functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _DIGEST_PIPELINE_H )
+#define _DIGEST_PIPELINE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libhmac.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+#define DIGEST_PIPELINE_MAXIMUM_NUMBER_OF_DIGESTS	4
+
+#define DIGEST_PIPELINE_DEFAULT_NUMBER_OF_SLOTS		16
+#define DIGEST_PIPELINE_DEFAULT_SLOT_SIZE		( 1024 * 1024 )
+
+enum DIGEST_PIPELINE_DIGEST_TYPES
+{
+	DIGEST_PIPELINE_DIGEST_TYPE_MD5			= 1,
+	DIGEST_PIPELINE_DIGEST_TYPE_SHA1		= 2,
+	DIGEST_PIPELINE_DIGEST_TYPE_SHA256		= 3,
+	DIGEST_PIPELINE_DIGEST_TYPE_RANGE_DIGESTS	= 4
+};
+
+typedef struct digest_pipeline digest_pipeline_t;
+
+typedef struct digest_pipeline_digest digest_pipeline_digest_t;
+
+/* A digest that is calculated by a dedicated thread of the digest pipeline
+ */
+struct digest_pipeline_digest
+{
+	/* The digest pipeline
+	 */
+	digest_pipeline_t *pipeline;
+
+	/* The digest type
+	 */
+	int digest_type;
+
+	/* The digest context, which is managed by the caller
+	 */
+	intptr_t *context;
+
+	/* The thread
+	 */
+	libcthreads_thread_t *thread;
+
+	/* The number of slots read by the thread
+	 */
+	uint64_t number_of_read_slots;
+
+	/* The result of the digest calculation
+	 */
+	int result;
+};
+
+/* The digest pipeline copies the data to be digested, in order, into a ring of slots
+ * that is consumed by a dedicated thread per digest, such that the digests
+ * are calculated in parallel to each other and to the reading of the data
+ */
+struct digest_pipeline
+{
+	/* The slots data
+	 */
+	uint8_t *slots_data;
+
+	/* The size of the data in each of the slots
+	 */
+	size_t *slot_data_sizes;
+
+	/* The number of slots
+	 */
+	int number_of_slots;
+
+	/* The slot size
+	 */
+	size_t slot_size;
+
+	/* The number of slots written
+	 */
+	uint64_t number_of_written_slots;
+
+	/* The size of the data in the slot that is currently being written
+	 */
+	size_t write_slot_data_size;
+
+	/* The digests
+	 */
+	digest_pipeline_digest_t digests[ DIGEST_PIPELINE_MAXIMUM_NUMBER_OF_DIGESTS ];
+
+	/* The number of digests
+	 */
+	int number_of_digests;
+
+	/* Value to indicate the digest threads were started
+	 */
+	uint8_t is_started;
+
+	/* Value to indicate no more data will be written
+	 */
+	uint8_t end_of_data;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when a slot was written or read
+	 */
+	libcthreads_condition_t *condition;
+};
+
+int digest_pipeline_initialize(
+     digest_pipeline_t **pipeline,
+     int number_of_slots,
+     size_t slot_size,
+     libcerror_error_t **error );
+
+int digest_pipeline_free(
+     digest_pipeline_t **pipeline,
+     libcerror_error_t **error );
+
+int digest_pipeline_add_digest(
+     digest_pipeline_t *pipeline,
+     int digest_type,
+     intptr_t *context,
+     libcerror_error_t **error );
+
+int digest_pipeline_start(
+     digest_pipeline_t *pipeline,
+     libcerror_error_t **error );
+
+int digest_pipeline_wait_for_free_slot(
+     digest_pipeline_t *pipeline,
+     libcerror_error_t **error );
+
+int digest_pipeline_publish_slot(
+     digest_pipeline_t *pipeline,
+     libcerror_error_t **error );
+
+int digest_pipeline_append_data(
+     digest_pipeline_t *pipeline,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int digest_pipeline_flush(
+     digest_pipeline_t *pipeline,
+     libcerror_error_t **error );
+
+int digest_pipeline_stop(
+     digest_pipeline_t *pipeline,
+     libcerror_error_t **error );
+
+int digest_pipeline_digest_update(
+     digest_pipeline_digest_t *digest,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int digest_pipeline_digest_thread_function(
+     digest_pipeline_digest_t *digest );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _DIGEST_PIPELINE_H ) */
+
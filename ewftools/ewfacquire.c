@@ -36,6 +36,7 @@
 
 #include "byte_size_string.h"
 #include "device_handle.h"
+#include "device_read_ahead.h"
 #include "ewfcommon.h"
 #include "ewfinput.h"
 #include "ewftools_getopt.h"
@@ -46,10 +47,15 @@
 #include "ewftools_libewf.h"
 #include "ewftools_output.h"
 #include "ewftools_signal.h"
+#include "ewftools_system_string.h"
+#include "ewftools_timestamp.h"
 #include "ewftools_unused.h"
 #include "imaging_handle.h"
 #include "log_handle.h"
+#include "platform.h"
 #include "process_status.h"
+#include "rate_limiter.h"
+#include "stats_output.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
 
@@ -61,6 +67,8 @@
 
 #define EWFACQUIRE_INPUT_BUFFER_SIZE		64
 
+#define EWFACQUIRE_MAXIMUM_NUMBER_OF_ADDITIONAL_SOURCES	7
+
 device_handle_t *ewfacquire_device_handle   = NULL;
 imaging_handle_t *ewfacquire_imaging_handle = NULL;
 int ewfacquire_abort                        = 0;
@@ -122,12 +130,19 @@ void ewfacquire_usage_fprint(
 	                 "                  [ -B number_of_bytes ] [ -c compression_values ]\n"
 	                 "                  [ -C case_number ] [ -d digest_type ] [ -D description ]\n"
 	                 "                  [ -e examiner_name ] [ -E evidence_number ] [ -f format ]\n"
-	                 "                  [ -g number_of_sectors ] [ -j jobs ] [ -l log_filename ]\n"
-	                 "                  [ -m media_type ] [ -M media_flags ] [ -N notes ]\n"
-	                 "                  [ -o offset ] [ -p process_buffer_size ]\n"
+	                 "                  [ -g number_of_sectors ] [ -I additional_source ]\n"
+	                 "                  [ -j jobs ]\n"
+	                 "                  [ -J file_descriptor ] [ -k range_digests_file ]\n"
+	                 "                  [ -K checkpoint_file ] [ -l log_filename ]\n"
+	                 "                  [ -L rate_limit ] [ -m media_type ]\n"
+	                 "                  [ -M media_flags ] [ -N notes ]\n"
+	                 "                  [ -o offset ] [ -O file_descriptor ]\n"
+	                 "                  [ -p process_buffer_size ]\n"
 	                 "                  [ -P bytes_per_sector ] [ -r read_error_retries ]\n"
 	                 "                  [ -S segment_file_size ] [ -t target ] [ -T toc_file ]\n"
-	                 "                  [ -2 secondary_target ] [ -hqRsuvVwx ] source\n\n" );
+	                 "                  [ -W range_size ] [ -y chunk_fingerprints_file ]\n"
+	                 "                  [ -Y base_chunk_fingerprints_file ]\n"
+	                 "                  [ -2 secondary_target ] [ -hFHiqRsuUvVwx ] source\n\n" );
 
 	fprintf( stream, "\tsource: the source file(s) or device\n\n" );
 
@@ -158,17 +173,49 @@ void ewfacquire_usage_fprint(
 	fprintf( stream, "\t-f:     specify the EWF file format to write to, options: ewf, smart,\n"
 	                 "\t        ftk, encase2, encase3, encase4, encase5, encase6 (default),\n"
 	                 "\t        encase7, encase7-v2, linen5, linen6, linen7, ewfx\n" );
+	fprintf( stream, "\t-F:     handle read errors in two passes, the first pass skips a failed\n"
+	                 "\t        read and continues with the data that follows, the second pass\n"
+	                 "\t        reads the skipped data again with the read error retries and\n"
+	                 "\t        error granularity (requires multi-threaded mode)\n" );
 	fprintf( stream, "\t-g      specify the number of sectors to be used as error granularity\n" );
 	fprintf( stream, "\t-h:     shows this help\n" );
+	fprintf( stream, "\t-H:     use huge pages for the chunk data and storage media\n"
+	                 "\t        buffers, falls back to normal pages if not available\n" );
+	fprintf( stream, "\t-i:     use the idle I/O priority class, such that the source is only\n"
+	                 "\t        read when no other process uses it (Linux and Windows only)\n" );
+	fprintf( stream, "\t-I:     specify an additional source that contains the same media as\n"
+	                 "\t        the source, such as the same device attached by another path\n"
+	                 "\t        or a member of a mirror, where the reads are distributed over\n"
+	                 "\t        the sources. Can be specified up to 7 times (requires\n"
+	                 "\t        multi-threaded mode)\n" );
 	fprintf( stream, "\t-j:     the number of concurrent processing jobs (threads), where\n"
 	                 "\t        a number of 0 represents single-threaded mode (default is 4\n"
-	                 "\t        if multi-threaded mode is supported)\n" );
+	                 "\t        if multi-threaded mode is supported) or auto, which adjusts\n"
+	                 "\t        the number of threads at runtime until the throughput is\n"
+	                 "\t        bounded by the source or target\n" );
+	fprintf( stream, "\t-J:     write the progress and the throughput per stage (read, process,\n"
+	                 "\t        hash and write) as JSON lines to the file_descriptor\n" );
+	fprintf( stream, "\t-k:     write the SHA-256 of every range of the media data to the\n"
+	                 "\t        range_digests_file, which allows ewfverify to verify the\n"
+	                 "\t        ranges in parallel, see -W for the size of the ranges\n" );
+	fprintf( stream, "\t-K:     periodically write the state of the digest (hash) calculations\n"
+	                 "\t        to the checkpoint_file, such that when the acquiry is resumed\n"
+	                 "\t        (-R) only the data acquired after the last checkpoint needs to\n"
+	                 "\t        be read back and hashed. Not supported for the sha1 and\n"
+	                 "\t        sha256 digest types on a CPU without the SHA extensions or\n"
+	                 "\t        in combination with -k\n" );
 	fprintf( stream, "\t-l:     logs acquiry errors and the digest (hash) to the log_filename\n" );
+	fprintf( stream, "\t-L:     limit the rate at which the source is read, and as such the\n"
+	                 "\t        rate at which the target is written, in bytes per second\n"
+	                 "\t        (default is 0, which represents unlimited, minimum is 64 KiB)\n" );
 	fprintf( stream, "\t-m:     specify the media type, options: fixed (default), removable,\n"
 	                 "\t        optical, memory\n" );
 	fprintf( stream, "\t-M:     specify the media flags, options: logical, physical (default)\n" );
 	fprintf( stream, "\t-N:     specify the notes (default is notes).\n" );
 	fprintf( stream, "\t-o:     specify the offset to start to acquire (default is 0)\n" );
+	fprintf( stream, "\t-O:     read new rate limits, one per line, from the file_descriptor\n"
+	                 "\t        while acquiring, where 0 represents unlimited (not supported\n"
+	                 "\t        on Windows)\n" );
 	fprintf( stream, "\t-p:     specify the process buffer size (default is the chunk size)\n" );
 	fprintf( stream, "\t-P:     specify the number of bytes per sector (default is 512)\n"
 	                 "\t        (use this to override the automatic bytes per sector detection)\n" );
@@ -204,11 +251,22 @@ void ewfacquire_usage_fprint(
 	fprintf( stream, "\t-T:     specify the file containing the table of contents (TOC) of\n"
 	                 "\t        an optical disc. The TOC file must be in the CUE format.\n" );
 	fprintf( stream, "\t-u:     unattended mode (disables user interaction)\n" );
+	fprintf( stream, "\t-U:     unbuffered output, do not retain the written segment files\n"
+	                 "\t        in the operating system page cache\n" );
 	fprintf( stream, "\t-v:     verbose output to stderr\n" );
 	fprintf( stream, "\t-V:     print version\n" );
 	fprintf( stream, "\t-w:     zero sectors on read error (mimic EnCase like behavior)\n" );
+	fprintf( stream, "\t-W:     specify the size of the ranges of the range digests file (-k)\n"
+	                 "\t        (default is 64 MiB, minimum is 1 MiB), the size must be\n"
+	                 "\t        a multiple of 512 bytes\n" );
 	fprintf( stream, "\t-x:     use the chunk data instead of the buffered read and write\n"
 	                 "\t        functions.\n" );
+	fprintf( stream, "\t-y:     write the SHA-256 of the uncompressed data of every chunk to\n"
+	                 "\t        the chunk_fingerprints_file, which allows identical chunks to be\n"
+	                 "\t        detected across images. Not supported in combination with -K\n" );
+	fprintf( stream, "\t-Y:     compare the chunk fingerprints with those written by -y when\n"
+	                 "\t        acquiring a base image of the same media and report the chunks\n"
+	                 "\t        that changed (requires -y and the same chunk size)\n" );
 	fprintf( stream, "\t-2:     specify the secondary target file (without extension) to write\n"
 	                 "\t        to\n" );
 }
@@ -572,13 +630,21 @@ int ewfacquire_determine_sessions(
 }
 
 /* Reads the input
+ * The input filenames are used to read ahead of the device handle, either a single file or device
+ * or the data files of an optical disc raw input, where NULL disables the read-ahead
+ * The additional sources contain the same media as the input and are read from by the read-ahead
  * Returns 1 if successful or -1 on error
  */
 int ewfacquire_read_input(
      imaging_handle_t *imaging_handle,
      device_handle_t *device_handle,
+     system_character_t * const *input_filenames,
+     int number_of_input_filenames,
+     system_character_t * const *additional_sources,
+     int number_of_additional_sources,
      off64_t resume_acquiry_offset,
      uint8_t swap_byte_pairs,
+     uint8_t two_pass_read_errors,
      uint8_t print_status_information,
      uint8_t use_chunk_data_functions,
      log_handle_t *log_handle,
@@ -587,9 +653,10 @@ int ewfacquire_read_input(
 	storage_media_buffer_t *storage_media_buffer = NULL;
 	uint8_t *data                                = NULL;
 	static char *function                        = "ewfacquire_read_input";
+	off64_t next_restart_checkpoint_offset       = 0;
 	off64_t read_error_offset                    = 0;
+	off64_t restart_checkpoint_offset            = 0;
 	off64_t storage_media_offset                 = 0;
-	size64_t acquiry_count                       = 0;
 	size64_t read_error_size                     = 0;
 	size64_t remaining_aquiry_size               = 0;
 	size_t data_size                             = 0;
@@ -598,15 +665,34 @@ int ewfacquire_read_input(
 	ssize_t read_count                           = 0;
 	ssize_t process_count                        = 0;
 	ssize_t write_count                          = 0;
+	int64_t stats_start_timestamp                = 0;
 	uint32_t chunk_size                          = 0;
 	uint8_t storage_media_buffer_mode            = 0;
+	uint8_t write_restart_checkpoints            = 0;
 	int number_of_read_errors                    = 0;
 	int read_error_iterator                      = 0;
+	int result                                   = 0;
 	int status                                   = PROCESS_STATUS_COMPLETED;
 
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
+	int initial_number_of_queued_items           = 0;
 	int maximum_number_of_queued_items           = 0;
 #endif
+#if defined( HAVE_DEVICE_READ_AHEAD )
+	device_read_ahead_t *device_read_ahead       = NULL;
+	uint8_t media_type                           = 0;
+	uint8_t read_data_files                      = 0;
+	int maximum_number_of_read_ahead_requests    = 0;
+	int number_of_read_ahead_reads               = 0;
+	int source_index                             = 0;
+#endif
+
+#if !defined( HAVE_DEVICE_READ_AHEAD )
+	EWFTOOLS_UNREFERENCED_PARAMETER( input_filenames )
+	EWFTOOLS_UNREFERENCED_PARAMETER( number_of_input_filenames )
+	EWFTOOLS_UNREFERENCED_PARAMETER( additional_sources )
+	EWFTOOLS_UNREFERENCED_PARAMETER( two_pass_read_errors )
+#endif
 
 	if( imaging_handle == NULL )
 	{
@@ -793,25 +879,78 @@ int ewfacquire_read_input(
 		}
 		storage_media_buffer_mode = STORAGE_MEDIA_BUFFER_MODE_BUFFERED;
 	}
+	/* Every storage media buffer must start at a chunk boundary to calculate the chunk fingerprints
+	 */
+	if( ( imaging_handle->chunk_fingerprints_filename != NULL )
+	 && ( ( process_buffer_size % chunk_size ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported process buffer size: %" PRIzd " not a multiple of the chunk size: %" PRIu32 ".",
+		 function,
+		 process_buffer_size,
+		 chunk_size );
+
+		goto on_error;
+	}
+	if( imaging_handle->use_huge_pages != 0 )
+	{
+		if( libewf_handle_set_use_huge_pages(
+		     imaging_handle->output_handle,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set use huge pages.",
+			 function );
+
+			goto on_error;
+		}
+	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 	if( imaging_handle->number_of_threads != 0 )
 	{
-		maximum_number_of_queued_items = 1 + ( ( 512 * 1024 * 1024 ) / process_buffer_size );
+		if( storage_media_buffer_queue_get_maximum_number_of_buffers(
+		     0,
+		     process_buffer_size,
+		     imaging_handle->number_of_threads + 1,
+		     &maximum_number_of_queued_items,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine maximum number of queued items.",
+			 function );
 
-		if( libcthreads_thread_pool_create(
-		     &( imaging_handle->process_thread_pool ),
-		     NULL,
-		     imaging_handle->number_of_threads,
+			goto on_error;
+		}
+		/* The storage media buffer queue starts with a few buffers per process thread
+		 * and grows, up to the maximum number of queued items, when the output is stalled
+		 */
+		initial_number_of_queued_items = 4 * imaging_handle->number_of_threads;
+
+		if( initial_number_of_queued_items > maximum_number_of_queued_items )
+		{
+			initial_number_of_queued_items = maximum_number_of_queued_items;
+		}
+
+		if( imaging_handle_create_process_thread_pools(
+		     imaging_handle,
 		     maximum_number_of_queued_items,
-		     (int (*)(intptr_t *, void *)) &imaging_handle_process_storage_media_buffer_callback,
-		     (void *) imaging_handle,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize process thread pool.",
+			 "%s: unable to initialize process thread pools.",
 			 function );
 
 			goto on_error;
@@ -834,6 +973,27 @@ int ewfacquire_read_input(
 
 			goto on_error;
 		}
+		if( imaging_handle->secondary_output_handle != NULL )
+		{
+			if( libcthreads_thread_pool_create(
+			     &( imaging_handle->secondary_output_thread_pool ),
+			     NULL,
+			     1,
+			     maximum_number_of_queued_items,
+			     (int (*)(intptr_t *, void *)) &imaging_handle_secondary_output_storage_media_buffer_callback,
+			     (void *) imaging_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize secondary output thread pool.",
+				 function );
+
+				goto on_error;
+			}
+		}
 		if( libcdata_list_initialize(
 		     &( imaging_handle->output_list ),
 		     error ) != 1 )
@@ -850,9 +1010,12 @@ int ewfacquire_read_input(
 		if( storage_media_buffer_queue_initialize(
 		     &( imaging_handle->storage_media_buffer_queue ),
 		     imaging_handle->output_handle,
+		     imaging_handle->numa_topology,
+		     initial_number_of_queued_items,
 		     maximum_number_of_queued_items,
 		     storage_media_buffer_mode,
 		     process_buffer_size,
+		     imaging_handle->use_huge_pages,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -864,8 +1027,219 @@ int ewfacquire_read_input(
 
 			goto on_error;
 		}
+		if( imaging_handle->stats_output != NULL )
+		{
+			if( stats_output_set_storage_media_buffer_queue(
+			     imaging_handle->stats_output,
+			     imaging_handle->storage_media_buffer_queue,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set storage media buffer queue in statistics output.",
+				 function );
+
+				goto on_error;
+			}
+		}
+#if defined( HAVE_DEVICE_READ_AHEAD )
+		/* The reads of a file or a non optical device are kept in flight by the read-ahead
+		 * Since the read-ahead holds storage media buffers of the queue the number of reads
+		 * is bounded by half the number of queued items
+		 *
+		 * The tracks of an optical disc raw input are read directly from its data files
+		 * when the track ranges of the device handle support it, as are the segment files
+		 * of a split raw input
+		 */
+		if( input_filenames != NULL )
+		{
+			if( device_handle->type == DEVICE_HANDLE_TYPE_OPTICAL_DISC_FILE )
+			{
+				if( device_handle->number_of_track_ranges > 0 )
+				{
+					number_of_read_ahead_reads = DEVICE_READ_AHEAD_DEFAULT_NUMBER_OF_READS;
+					read_data_files            = 1;
+				}
+			}
+			else if( ( device_handle->type == DEVICE_HANDLE_TYPE_FILE )
+			      && ( number_of_input_filenames > 1 ) )
+			{
+				number_of_read_ahead_reads = DEVICE_READ_AHEAD_DEFAULT_NUMBER_OF_READS;
+				read_data_files            = 1;
+			}
+			else if( number_of_input_filenames == 1 )
+			{
+				if( device_handle_get_media_type(
+				     device_handle,
+				     &media_type,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve media type.",
+					 function );
+
+					goto on_error;
+				}
+				if( media_type != DEVICE_HANDLE_MEDIA_TYPE_OPTICAL )
+				{
+					/* Every source has the default number of reads in flight
+					 */
+					number_of_read_ahead_reads = DEVICE_READ_AHEAD_DEFAULT_NUMBER_OF_READS
+					                           * ( 1 + number_of_additional_sources );
+
+					if( number_of_read_ahead_reads > DEVICE_READ_AHEAD_MAXIMUM_NUMBER_OF_READS )
+					{
+						number_of_read_ahead_reads = DEVICE_READ_AHEAD_MAXIMUM_NUMBER_OF_READS;
+					}
+				}
+			}
+			if( number_of_read_ahead_reads > ( maximum_number_of_queued_items / 2 ) )
+			{
+				number_of_read_ahead_reads = maximum_number_of_queued_items / 2;
+			}
+		}
+		if( number_of_read_ahead_reads > 0 )
+		{
+			/* In two pass mode the data that follows a failed read is read
+			 * in the first pass, up to half the number of queued items
+			 */
+			maximum_number_of_read_ahead_requests = number_of_read_ahead_reads;
+
+			if( two_pass_read_errors != 0 )
+			{
+				maximum_number_of_read_ahead_requests = maximum_number_of_queued_items / 2;
+
+				if( maximum_number_of_read_ahead_requests > DEVICE_READ_AHEAD_MAXIMUM_NUMBER_OF_REQUESTS )
+				{
+					maximum_number_of_read_ahead_requests = DEVICE_READ_AHEAD_MAXIMUM_NUMBER_OF_REQUESTS;
+				}
+			}
+			if( device_read_ahead_initialize(
+			     &device_read_ahead,
+			     ( read_data_files != 0 ) ? NULL : input_filenames[ 0 ],
+			     imaging_handle->storage_media_buffer_queue,
+			     number_of_read_ahead_reads,
+			     maximum_number_of_read_ahead_requests,
+			     process_buffer_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize device read-ahead.",
+				 function );
+
+				goto on_error;
+			}
+			if( read_data_files != 0 )
+			{
+				result = device_read_ahead_open_data_files(
+				          device_read_ahead,
+				          device_handle,
+				          input_filenames,
+				          number_of_input_filenames,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_OPEN_FAILED,
+					 "%s: unable to open data files of device read-ahead.",
+					 function );
+
+					goto on_error;
+				}
+				/* The input is read using the device handle when the data files
+				 * do not match the track ranges
+				 */
+				else if( result == 0 )
+				{
+					if( device_read_ahead_free(
+					     &device_read_ahead,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to free device read-ahead.",
+						 function );
+
+						goto on_error;
+					}
+				}
+			}
+			else
+			{
+				for( source_index = 0;
+				     source_index < number_of_additional_sources;
+				     source_index++ )
+				{
+					if( device_read_ahead_append_source(
+					     device_read_ahead,
+					     additional_sources[ source_index ],
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+						 "%s: unable to append additional source: %" PRIs_SYSTEM " to device read-ahead.",
+						 function,
+						 additional_sources[ source_index ] );
+
+						goto on_error;
+					}
+				}
+			}
+		}
+		if( device_read_ahead != NULL )
+		{
+			if( device_read_ahead_set_range(
+			     device_read_ahead,
+			     (off64_t) imaging_handle->acquiry_offset,
+			     resume_acquiry_offset,
+			     (off64_t) imaging_handle->acquiry_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set device read-ahead range.",
+				 function );
+
+				goto on_error;
+			}
+		}
+#endif
 	}
 #endif
+	if( number_of_additional_sources > 0 )
+	{
+#if defined( HAVE_DEVICE_READ_AHEAD )
+		if( ( device_read_ahead == NULL )
+		 || ( read_data_files != 0 ) )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: additional sources are only supported in multi-threaded mode for a file or non optical device.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( imaging_handle_initialize_integrity_hash(
 	     imaging_handle,
 	     error ) != 1 )
@@ -879,6 +1253,99 @@ int ewfacquire_read_input(
 
 		goto on_error;
         }
+	if( imaging_handle_open_chunk_fingerprints(
+	     imaging_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open chunk fingerprints.",
+		 function );
+
+		goto on_error;
+	}
+	if( imaging_handle->restart_checkpoint_filename != NULL )
+	{
+		/* When resuming, the data up to the hashed offset of the restart checkpoint
+		 * does not need to be read back from the output and hashed again
+		 */
+		if( resume_acquiry_offset > 0 )
+		{
+			result = imaging_handle_read_restart_checkpoint(
+			          imaging_handle,
+			          resume_acquiry_offset,
+			          &restart_checkpoint_offset,
+			          error );
+
+			if( result == -1 )
+			{
+#if defined( HAVE_VERBOSE_OUTPUT )
+				libcnotify_print_error_backtrace(
+				 *error );
+#endif
+				libcerror_error_free(
+				 error );
+			}
+			if( result != 1 )
+			{
+				fprintf(
+				 stdout,
+				 "Unable to use restart checkpoint - reading back all acquired data.\n" );
+			}
+			else if( restart_checkpoint_offset > 0 )
+			{
+				if( imaging_handle_seek_offset(
+				     imaging_handle,
+				     restart_checkpoint_offset,
+				     error ) == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_SEEK_FAILED,
+					 "%s: unable to seek imaging offset.",
+					 function );
+
+					goto on_error;
+				}
+				storage_media_offset                = restart_checkpoint_offset;
+				imaging_handle->last_offset_written = restart_checkpoint_offset;
+			}
+		}
+		/* The initial restart checkpoint replaces the restart checkpoint file, which removes
+		 * the restart checkpoints of a previous acquiry beyond the resume point
+		 */
+		result = imaging_handle_write_restart_checkpoint(
+		          imaging_handle,
+		          storage_media_offset,
+		          0,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write restart checkpoint.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stdout,
+			 "Restart checkpoints are not supported for the digest types - checkpoints disabled.\n" );
+		}
+		else
+		{
+			next_restart_checkpoint_offset = storage_media_offset + RESTART_CHECKPOINT_DEFAULT_INTERVAL;
+			write_restart_checkpoints      = 1;
+		}
+	}
 	if( process_status_initialize(
 	     &( imaging_handle->process_status ),
 	     _SYSTEM_STRING( "Acquiry" ),
@@ -897,6 +1364,23 @@ int ewfacquire_read_input(
 
 		goto on_error;
 	}
+	if( imaging_handle->stats_output != NULL )
+	{
+		if( process_status_set_stats_output(
+		     imaging_handle->process_status,
+		     imaging_handle->stats_output,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set statistics output in process status.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( process_status_start(
 	     imaging_handle->process_status,
 	     error ) != 1 )
@@ -929,7 +1413,7 @@ int ewfacquire_read_input(
 			goto on_error;
 		}
 	}
-	remaining_aquiry_size = imaging_handle->acquiry_size;
+	remaining_aquiry_size = imaging_handle->acquiry_size - (size64_t) storage_media_offset;
 
 	while( remaining_aquiry_size > 0 )
 	{
@@ -978,9 +1462,9 @@ int ewfacquire_read_input(
 		{
 			/* Align with resume acquiry offset if necessary
 			 */
-			if( ( resume_acquiry_offset - (off64_t) acquiry_count ) < (off64_t) read_size )
+			if( ( resume_acquiry_offset - storage_media_offset ) < (off64_t) read_size )
 			{
-				read_size = (size_t) ( resume_acquiry_offset - acquiry_count );
+				read_size = (size_t) ( resume_acquiry_offset - storage_media_offset );
 			}
 			read_count = storage_media_buffer_read_from_handle(
 			              storage_media_buffer,
@@ -1042,18 +1526,111 @@ int ewfacquire_read_input(
 			}
 			read_count = process_count;
 
+			/* The data that was read back from the output still needs to be fingerprinted
+			 */
+			if( imaging_handle_calculate_chunk_fingerprints(
+			     imaging_handle,
+			     storage_media_buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to calculate chunk fingerprints.",
+				 function );
+
+				goto on_error;
+			}
+			if( imaging_handle_append_chunk_fingerprints(
+			     imaging_handle,
+			     storage_media_buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append chunk fingerprints.",
+				 function );
+
+				goto on_error;
+			}
 			storage_media_offset  += read_count;
 			remaining_aquiry_size -= read_count;
 		}
 		else
 		{
-			read_count = device_handle_read_storage_media_buffer(
-				      device_handle,
-				      storage_media_buffer,
-				      storage_media_offset,
-				      read_size,
-				      error );
+			/* Every buffer that is read is also written, hence limiting
+			 * the read rate also limits the write rate
+			 */
+			if( imaging_handle->rate_limiter != NULL )
+			{
+				if( rate_limiter_read_control(
+				     imaging_handle->rate_limiter,
+				     error ) == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read rate limit control.",
+					 function );
+
+					goto on_error;
+				}
+				if( rate_limiter_consume(
+				     imaging_handle->rate_limiter,
+				     read_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GENERIC,
+					 "%s: unable to limit rate.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			if( imaging_handle->stats_output != NULL )
+			{
+				if( ewftools_timestamp_get_monotonic(
+				     &stats_start_timestamp,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve statistics start timestamp.",
+					 function );
 
+					goto on_error;
+				}
+			}
+#if defined( HAVE_DEVICE_READ_AHEAD )
+			if( device_read_ahead != NULL )
+			{
+				read_count = device_read_ahead_read_storage_media_buffer(
+					      device_read_ahead,
+					      device_handle,
+					      &storage_media_buffer,
+					      storage_media_offset,
+					      read_size,
+					      error );
+			}
+			else
+#endif
+			{
+				read_count = device_handle_read_storage_media_buffer(
+					      device_handle,
+					      storage_media_buffer,
+					      storage_media_offset,
+					      read_size,
+					      error );
+			}
 			if( read_count < 0 )
 			{
 				libcerror_error_set(
@@ -1076,6 +1653,25 @@ int ewfacquire_read_input(
 
 				goto on_error;
 			}
+			if( imaging_handle->stats_output != NULL )
+			{
+				if( stats_output_add_stage(
+				     imaging_handle->stats_output,
+				     STATS_OUTPUT_STAGE_READ,
+				     (size64_t) read_count,
+				     stats_start_timestamp,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to add read to statistics output.",
+					 function );
+
+					goto on_error;
+				}
+			}
 			storage_media_offset  += read_count;
 			remaining_aquiry_size -= read_count;
 		}
@@ -1115,6 +1711,22 @@ int ewfacquire_read_input(
 				goto on_error;
 			}
 		}
+		if( imaging_handle->stats_output != NULL )
+		{
+			if( ewftools_timestamp_get_monotonic(
+			     &stats_start_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve statistics start timestamp.",
+				 function );
+
+				goto on_error;
+			}
+		}
 		/* Digest hashes are calcultated after swap
 		 */
 		if( imaging_handle_update_integrity_hash(
@@ -1132,6 +1744,45 @@ int ewfacquire_read_input(
 
 			goto on_error;
 		}
+		if( imaging_handle->stats_output != NULL )
+		{
+			if( stats_output_add_stage(
+			     imaging_handle->stats_output,
+			     STATS_OUTPUT_STAGE_HASH,
+			     (size64_t) read_count,
+			     stats_start_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to add hash to statistics output.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( ( write_restart_checkpoints != 0 )
+		 && ( storage_media_offset >= next_restart_checkpoint_offset ) )
+		{
+			if( imaging_handle_write_restart_checkpoint(
+			     imaging_handle,
+			     storage_media_offset,
+			     1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write restart checkpoint.",
+				 function );
+
+				goto on_error;
+			}
+			next_restart_checkpoint_offset = storage_media_offset + RESTART_CHECKPOINT_DEFAULT_INTERVAL;
+		}
 		if( imaging_handle->last_offset_written < resume_acquiry_offset )
 		{
 			imaging_handle->last_offset_written += (off64_t) read_count;
@@ -1155,16 +1806,16 @@ int ewfacquire_read_input(
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 		else if( imaging_handle->number_of_threads != 0 )
 		{
-			if( libcthreads_thread_pool_push(
-			     imaging_handle->process_thread_pool,
-			     (intptr_t *) storage_media_buffer,
-			     error ) == -1 )
+			if( imaging_handle_push_process_thread_pools(
+			     imaging_handle,
+			     storage_media_buffer,
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to push storage media buffer onto process thread pool queue.",
+				 "%s: unable to push storage media buffer onto process thread pools.",
 				 function );
 
 				goto on_error;
@@ -1174,6 +1825,36 @@ int ewfacquire_read_input(
 #endif
 		else
 		{
+			if( imaging_handle->stats_output != NULL )
+			{
+				if( ewftools_timestamp_get_monotonic(
+				     &stats_start_timestamp,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve statistics start timestamp.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			if( imaging_handle_calculate_chunk_fingerprints(
+			     imaging_handle,
+			     storage_media_buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to calculate chunk fingerprints.",
+				 function );
+
+				goto on_error;
+			}
 			process_count = storage_media_buffer_write_process(
 					 storage_media_buffer,
 					 error );
@@ -1189,6 +1870,25 @@ int ewfacquire_read_input(
 
 				goto on_error;
 			}
+			if( imaging_handle->stats_output != NULL )
+			{
+				if( stats_output_add_stage(
+				     imaging_handle->stats_output,
+				     STATS_OUTPUT_STAGE_PROCESS,
+				     (size64_t) process_count,
+				     stats_start_timestamp,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to add process to statistics output.",
+					 function );
+
+					goto on_error;
+				}
+			}
 			write_count = imaging_handle_write_storage_media_buffer(
 				       imaging_handle,
 				       storage_media_buffer,
@@ -1241,23 +1941,41 @@ int ewfacquire_read_input(
 			goto on_error;
 		}
 	}
-#if defined( HAVE_MULTI_THREAD_SUPPORT )
-	if( imaging_handle->process_thread_pool != NULL )
+#if defined( HAVE_DEVICE_READ_AHEAD )
+	/* Freeing the read-ahead releases the storage media buffers of reads
+	 * that are still in flight, when the acquiry was aborted
+	 */
+	if( device_read_ahead != NULL )
 	{
-		if( libcthreads_thread_pool_join(
-		     &( imaging_handle->process_thread_pool ),
+		if( device_read_ahead_free(
+		     &device_read_ahead,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to join process thread pool.",
+			 "%s: unable to free device read-ahead.",
 			 function );
 
 			goto on_error;
 		}
 	}
+#endif
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( imaging_handle_join_process_thread_pools(
+	     imaging_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join process thread pools.",
+		 function );
+
+		goto on_error;
+	}
 	if( imaging_handle->output_thread_pool != NULL )
 	{
 		if( libcthreads_thread_pool_join(
@@ -1274,6 +1992,36 @@ int ewfacquire_read_input(
 			goto on_error;
 		}
 	}
+	/* The secondary output thread pool is joined after the output thread pool
+	 * since the output thread pushes the storage media buffers onto it
+	 */
+	if( imaging_handle->secondary_output_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( imaging_handle->secondary_output_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join secondary output thread pool.",
+			 function );
+
+			goto on_error;
+		}
+		if( imaging_handle->secondary_output_failed != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write to secondary output handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( imaging_handle->output_list != NULL )
 	{
 		if( imaging_handle_empty_output_list(
@@ -1306,6 +2054,23 @@ int ewfacquire_read_input(
 	}
 	if( imaging_handle->storage_media_buffer_queue != NULL )
 	{
+		if( imaging_handle->stats_output != NULL )
+		{
+			if( stats_output_set_storage_media_buffer_queue(
+			     imaging_handle->stats_output,
+			     NULL,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set storage media buffer queue in statistics output.",
+				 function );
+
+				goto on_error;
+			}
+		}
 		if( storage_media_buffer_queue_free(
 		     &( imaging_handle->storage_media_buffer_queue ),
 		     error ) != 1 )
@@ -1321,6 +2086,19 @@ int ewfacquire_read_input(
 		}
 	}
 #endif
+	if( imaging_handle_close_chunk_fingerprints(
+	     imaging_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close chunk fingerprints.",
+		 function );
+
+		goto on_error;
+	}
 	if( imaging_handle_finalize_integrity_hash(
 	     imaging_handle,
 	     error ) != 1 )
@@ -1467,6 +2245,20 @@ int ewfacquire_read_input(
 
 			goto on_error;
 		}
+		if( imaging_handle_print_changed_chunks(
+		     imaging_handle,
+		     imaging_handle->notify_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print changed chunks.",
+			 function );
+
+			goto on_error;
+		}
 		if( log_handle != NULL )
 		{
 			if( device_handle_read_errors_fprint(
@@ -1483,7 +2275,21 @@ int ewfacquire_read_input(
 
 				goto on_error;
 			}
-			if( imaging_handle_print_hashes(
+			if( imaging_handle_print_hashes(
+			     imaging_handle,
+			     log_handle->log_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print hashes in log handle.",
+				 function );
+
+				goto on_error;
+			}
+			if( imaging_handle_print_changed_chunks(
 			     imaging_handle,
 			     log_handle->log_stream,
 			     error ) != 1 )
@@ -1492,7 +2298,7 @@ int ewfacquire_read_input(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-				 "%s: unable to print hashes in log handle.",
+				 "%s: unable to print changed chunks in log handle.",
 				 function );
 
 				goto on_error;
@@ -1520,19 +2326,30 @@ on_error:
 		 &( imaging_handle->process_status ),
 		 NULL );
 	}
-#if defined( HAVE_MULTI_THREAD_SUPPORT )
-	if( imaging_handle->process_thread_pool != NULL )
+#if defined( HAVE_DEVICE_READ_AHEAD )
+	if( device_read_ahead != NULL )
 	{
-		libcthreads_thread_pool_join(
-		 &( imaging_handle->process_thread_pool ),
+		device_read_ahead_free(
+		 &device_read_ahead,
 		 NULL );
 	}
+#endif
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	imaging_handle_join_process_thread_pools(
+	 imaging_handle,
+	 NULL );
 	if( imaging_handle->output_thread_pool != NULL )
 	{
 		libcthreads_thread_pool_join(
 		 &( imaging_handle->output_thread_pool ),
 		 NULL );
 	}
+	if( imaging_handle->secondary_output_thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &( imaging_handle->secondary_output_thread_pool ),
+		 NULL );
+	}
 	if( imaging_handle->output_list != NULL )
 	{
 		imaging_handle_empty_output_list(
@@ -1545,6 +2362,13 @@ on_error:
 	}
 	if( imaging_handle->storage_media_buffer_queue != NULL )
 	{
+		if( imaging_handle->stats_output != NULL )
+		{
+			stats_output_set_storage_media_buffer_queue(
+			 imaging_handle->stats_output,
+			 NULL,
+			 NULL );
+		}
 		storage_media_buffer_queue_free(
 		 &( imaging_handle->storage_media_buffer_queue ),
 		 NULL );
@@ -1561,51 +2385,68 @@ int wmain( int argc, wchar_t * const argv[] )
 int main( int argc, char * const argv[] )
 #endif
 {
+	system_character_t *additional_sources[ EWFACQUIRE_MAXIMUM_NUMBER_OF_ADDITIONAL_SOURCES ];
 	system_character_t input_buffer[ EWFACQUIRE_INPUT_BUFFER_SIZE ];
 	system_character_t media_information_model[ 64 ];
 	system_character_t media_information_serial_number[ 64 ];
 
-	libcerror_error_t *error                             = NULL;
-	log_handle_t *log_handle                             = NULL;
-	system_character_t *log_filename                     = NULL;
-	system_character_t *option_additional_digest_types   = NULL;
-	system_character_t *option_bytes_per_sector          = NULL;
-	system_character_t *option_case_number               = NULL;
-	system_character_t *option_compression_values        = NULL;
-	system_character_t *option_description               = NULL;
-	system_character_t *option_evidence_number           = NULL;
-	system_character_t *option_examiner_name             = NULL;
-	system_character_t *option_format                    = NULL;
-	system_character_t *option_header_codepage           = NULL;
-	system_character_t *option_maximum_segment_size      = NULL;
-	system_character_t *option_media_flags               = NULL;
-	system_character_t *option_media_type                = NULL;
-	system_character_t *option_notes                     = NULL;
-	system_character_t *option_number_of_error_retries   = NULL;
-	system_character_t *option_number_of_jobs            = NULL;
-	system_character_t *option_offset                    = NULL;
-	system_character_t *option_process_buffer_size       = NULL;
-	system_character_t *option_secondary_target_filename = NULL;
-	system_character_t *option_sector_error_granularity  = NULL;
-	system_character_t *option_sectors_per_chunk         = NULL;
-	system_character_t *option_size                      = NULL;
-	system_character_t *option_target_filename           = NULL;
-	system_character_t *option_toc_filename              = NULL;
-	system_character_t *program                          = _SYSTEM_STRING( "ewfacquire" );
-	system_character_t *request_string                   = NULL;
-	system_integer_t option                              = 0;
-	size_t string_length                                 = 0;
-	off64_t resume_acquiry_offset                        = 0;
-	uint8_t calculate_md5                                = 1;
-	uint8_t print_status_information                     = 1;
-	uint8_t resume_acquiry                               = 0;
-	uint8_t swap_byte_pairs                              = 0;
-	uint8_t use_chunk_data_functions                     = 0;
-	uint8_t verbose                                      = 0;
-	uint8_t zero_buffer_on_error                         = 0;
-	int8_t acquiry_parameters_confirmed                  = 0;
-	int interactive_mode                                 = 1;
-	int result                                           = 0;
+	libcerror_error_t *error                                    = NULL;
+	log_handle_t *log_handle                                    = NULL;
+	system_character_t *log_filename                            = NULL;
+	system_character_t *option_additional_digest_types          = NULL;
+	system_character_t *option_base_chunk_fingerprints_filename = NULL;
+	system_character_t *option_bytes_per_sector                 = NULL;
+	system_character_t *option_case_number                      = NULL;
+	system_character_t *option_checkpoint_filename              = NULL;
+	system_character_t *option_chunk_fingerprints_filename      = NULL;
+	system_character_t *option_compression_values               = NULL;
+	system_character_t *option_description                      = NULL;
+	system_character_t *option_evidence_number                  = NULL;
+	system_character_t *option_examiner_name                    = NULL;
+	system_character_t *option_format                           = NULL;
+	system_character_t *option_header_codepage                  = NULL;
+	system_character_t *option_maximum_segment_size             = NULL;
+	system_character_t *option_media_flags                      = NULL;
+	system_character_t *option_media_type                       = NULL;
+	system_character_t *option_notes                            = NULL;
+	system_character_t *option_number_of_error_retries          = NULL;
+	system_character_t *option_number_of_jobs                   = NULL;
+	system_character_t *option_offset                           = NULL;
+	system_character_t *option_process_buffer_size              = NULL;
+	system_character_t *option_rate_control_file_descriptor     = NULL;
+	system_character_t *option_rate_limit                       = NULL;
+	system_character_t *option_range_digests_filename           = NULL;
+	system_character_t *option_range_digests_range_size         = NULL;
+	system_character_t *option_secondary_target_filename        = NULL;
+	system_character_t *option_sector_error_granularity         = NULL;
+	system_character_t *option_sectors_per_chunk                = NULL;
+	system_character_t *option_size                             = NULL;
+	system_character_t *option_stats_file_descriptor            = NULL;
+	system_character_t *option_target_filename                  = NULL;
+	system_character_t *option_toc_filename                     = NULL;
+	system_character_t *program                                 = _SYSTEM_STRING( "ewfacquire" );
+	system_character_t *request_string                          = NULL;
+	stats_output_t *stats_output                                = NULL;
+	system_integer_t option                                     = 0;
+	size_t string_length                                        = 0;
+	off64_t resume_acquiry_offset                               = 0;
+	uint64_t rate_control_file_descriptor                       = 0;
+	uint64_t stats_file_descriptor                              = 0;
+	uint8_t calculate_md5                                       = 1;
+	uint8_t idle_io_priority                                    = 0;
+	uint8_t print_status_information                            = 1;
+	uint8_t resume_acquiry                                      = 0;
+	uint8_t swap_byte_pairs                                     = 0;
+	uint8_t two_pass_read_errors                                = 0;
+	uint8_t unbuffered_output                                   = 0;
+	uint8_t use_chunk_data_functions                            = 0;
+	uint8_t use_huge_pages                                      = 0;
+	uint8_t verbose                                             = 0;
+	uint8_t zero_buffer_on_error                                = 0;
+	int8_t acquiry_parameters_confirmed                         = 0;
+	int interactive_mode                                        = 1;
+	int number_of_additional_sources                            = 0;
+	int result                                                  = 0;
 
 	libcnotify_stream_set(
 	 stderr,
@@ -1640,7 +2481,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:g:hj:l:m:M:N:o:p:P:qr:RsS:t:T:uvVwx2:" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:Fg:hHiI:j:J:k:K:l:L:m:M:N:o:O:p:P:qr:RsS:t:T:uUvVwW:xy:Y:2:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -1710,6 +2551,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'F':
+				two_pass_read_errors = 1;
+
+				break;
+
 			case (system_integer_t) 'g':
 				option_sector_error_granularity = optarg;
 
@@ -1725,16 +2571,71 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+			case (system_integer_t) 'H':
+				use_huge_pages = 1;
+
+				break;
+
+			case (system_integer_t) 'I':
+				if( number_of_additional_sources >= EWFACQUIRE_MAXIMUM_NUMBER_OF_ADDITIONAL_SOURCES )
+				{
+					ewftools_output_version_fprint(
+					 stdout,
+					 program );
+
+					fprintf(
+					 stderr,
+					 "Unsupported number of additional sources.\n" );
+
+					ewfacquire_usage_fprint(
+					 stdout );
+
+					goto on_error;
+				}
+				additional_sources[ number_of_additional_sources++ ] = optarg;
+
+				break;
+
+			case (system_integer_t) 'i':
+				idle_io_priority = 1;
+
+				break;
+
 			case (system_integer_t) 'j':
 				option_number_of_jobs = optarg;
 
 				break;
 
+			case (system_integer_t) 'J':
+				option_stats_file_descriptor = optarg;
+
+				break;
+
+			case (system_integer_t) 'k':
+				option_range_digests_filename = optarg;
+
+				break;
+
+			case (system_integer_t) 'W':
+				option_range_digests_range_size = optarg;
+
+				break;
+
+			case (system_integer_t) 'K':
+				option_checkpoint_filename = optarg;
+
+				break;
+
 			case (system_integer_t) 'l':
 				log_filename = optarg;
 
 				break;
 
+			case (system_integer_t) 'L':
+				option_rate_limit = optarg;
+
+				break;
+
 			case (system_integer_t) 'm':
 				option_media_type = optarg;
 
@@ -1755,6 +2656,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'O':
+				option_rate_control_file_descriptor = optarg;
+
+				break;
+
 			case (system_integer_t) 'p':
 				option_process_buffer_size = optarg;
 
@@ -1805,6 +2711,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'U':
+				unbuffered_output = 1;
+
+				break;
+
 			case (system_integer_t) 'v':
 				verbose = 1;
 
@@ -1830,6 +2741,16 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'y':
+				option_chunk_fingerprints_filename = optarg;
+
+				break;
+
+			case (system_integer_t) 'Y':
+				option_base_chunk_fingerprints_filename = optarg;
+
+				break;
+
 			case (system_integer_t) '2':
 				option_secondary_target_filename = optarg;
 
@@ -1851,6 +2772,22 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	if( ( number_of_additional_sources > 0 )
+	 && ( ( argc - optind ) != 1 ) )
+	{
+		ewftools_output_version_fprint(
+		 stdout,
+		 program );
+
+		fprintf(
+		 stderr,
+		 "Additional sources require a single source file or device.\n" );
+
+		ewfacquire_usage_fprint(
+		 stdout );
+
+		goto on_error;
+	}
 	ewftools_output_version_fprint(
 	 stdout,
 	 program );
@@ -1901,6 +2838,32 @@ int main( int argc, char * const argv[] )
 			}
 		}
 	}
+	/* The I/O priority is set before any threads are created
+	 * so that the threads inherit it
+	 */
+	if( idle_io_priority != 0 )
+	{
+		result = platform_set_idle_io_priority(
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set idle I/O priority.\n" );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Idle I/O priority not supported on this platform.\n" );
+		}
+	}
 	if( device_handle_initialize(
 	     &ewfacquire_device_handle,
 	     &error ) != 1 )
@@ -1996,6 +2959,51 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	if( option_stats_file_descriptor != NULL )
+	{
+		string_length = system_string_length(
+		                 option_stats_file_descriptor );
+
+		if( ( ewftools_system_string_decimal_copy_to_64_bit(
+		       option_stats_file_descriptor,
+		       string_length + 1,
+		       &stats_file_descriptor,
+		       &error ) != 1 )
+		 || ( stats_file_descriptor > (uint64_t) INT_MAX ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported statistics file descriptor.\n" );
+
+			goto on_error;
+		}
+		if( stats_output_initialize(
+		     &stats_output,
+		     "ewfacquire",
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to create statistics output.\n" );
+
+			goto on_error;
+		}
+		if( stats_output_open_file_descriptor(
+		     stats_output,
+		     (int) stats_file_descriptor,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to open statistics output.\n" );
+
+			goto on_error;
+		}
+		ewfacquire_imaging_handle->stats_output = stats_output;
+	}
+	ewfacquire_imaging_handle->unbuffered_output = unbuffered_output;
+	ewfacquire_imaging_handle->use_huge_pages    = use_huge_pages;
+
 	if( device_handle_get_media_size(
 	     ewfacquire_device_handle,
 	     &( ewfacquire_imaging_handle->input_media_size ),
@@ -2166,6 +3174,94 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( option_range_digests_filename != NULL )
+	{
+		if( imaging_handle_set_string(
+		     ewfacquire_imaging_handle,
+		     option_range_digests_filename,
+		     &( ewfacquire_imaging_handle->range_digests_filename ),
+		     &( ewfacquire_imaging_handle->range_digests_filename_size ),
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set range digests filename.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_chunk_fingerprints_filename != NULL )
+	{
+		if( imaging_handle_set_string(
+		     ewfacquire_imaging_handle,
+		     option_chunk_fingerprints_filename,
+		     &( ewfacquire_imaging_handle->chunk_fingerprints_filename ),
+		     &( ewfacquire_imaging_handle->chunk_fingerprints_filename_size ),
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set chunk fingerprints filename.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_base_chunk_fingerprints_filename != NULL )
+	{
+		if( option_chunk_fingerprints_filename == NULL )
+		{
+			fprintf(
+			 stderr,
+			 "Base chunk fingerprints require chunk fingerprints (-y).\n" );
+
+			goto on_error;
+		}
+		if( imaging_handle_set_string(
+		     ewfacquire_imaging_handle,
+		     option_base_chunk_fingerprints_filename,
+		     &( ewfacquire_imaging_handle->base_chunk_fingerprints_filename ),
+		     &( ewfacquire_imaging_handle->base_chunk_fingerprints_filename_size ),
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set base chunk fingerprints filename.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_checkpoint_filename != NULL )
+	{
+		if( option_range_digests_filename != NULL )
+		{
+			fprintf(
+			 stderr,
+			 "Restart checkpoints are not supported in combination with range digests.\n" );
+
+			goto on_error;
+		}
+		if( option_chunk_fingerprints_filename != NULL )
+		{
+			fprintf(
+			 stderr,
+			 "Restart checkpoints are not supported in combination with chunk fingerprints.\n" );
+
+			goto on_error;
+		}
+		if( imaging_handle_set_string(
+		     ewfacquire_imaging_handle,
+		     option_checkpoint_filename,
+		     &( ewfacquire_imaging_handle->restart_checkpoint_filename ),
+		     &( ewfacquire_imaging_handle->restart_checkpoint_filename_size ),
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set restart checkpoint filename.\n" );
+
+			goto on_error;
+		}
+	}
 	if( option_case_number != NULL )
 	{
 		if( imaging_handle_set_string(
@@ -2463,6 +3559,29 @@ int main( int argc, char * const argv[] )
 			 ewfacquire_imaging_handle->maximum_segment_size );
 		}
 	}
+	if( option_range_digests_range_size != NULL )
+	{
+		result = imaging_handle_set_range_digests_range_size(
+			  ewfacquire_imaging_handle,
+			  option_range_digests_range_size,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set range digests range size.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported range digests range size defaulting to: %" PRIu64 ".\n",
+			 ewfacquire_imaging_handle->range_digests_range_size );
+		}
+	}
 	if( option_offset != NULL )
 	{
 		result = imaging_handle_set_acquiry_offset(
@@ -2570,6 +3689,78 @@ int main( int argc, char * const argv[] )
 		 stderr,
 		 "Unsupported number of jobs (threads) defaulting to: %d.\n",
 		 ewfacquire_imaging_handle->number_of_threads );
+#endif
+	}
+	if( option_rate_limit != NULL )
+	{
+		result = imaging_handle_set_rate_limit(
+			  ewfacquire_imaging_handle,
+			  option_rate_limit,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set rate limit.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported rate limit defaulting to: unlimited.\n" );
+		}
+	}
+	if( option_rate_control_file_descriptor != NULL )
+	{
+		string_length = system_string_length(
+		                 option_rate_control_file_descriptor );
+
+		if( ( ewftools_system_string_decimal_copy_to_64_bit(
+		       option_rate_control_file_descriptor,
+		       string_length + 1,
+		       &rate_control_file_descriptor,
+		       &error ) != 1 )
+		 || ( rate_control_file_descriptor > (uint64_t) INT_MAX ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported rate limit control file descriptor.\n" );
+
+			goto on_error;
+		}
+#if defined( HAVE_RATE_LIMITER_CONTROL )
+		if( ewfacquire_imaging_handle->rate_limiter == NULL )
+		{
+			if( rate_limiter_initialize(
+			     &( ewfacquire_imaging_handle->rate_limiter ),
+			     0,
+			     &error ) != 1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to create rate limiter.\n" );
+
+				goto on_error;
+			}
+		}
+		if( rate_limiter_open_control_file_descriptor(
+		     ewfacquire_imaging_handle->rate_limiter,
+		     (int) rate_control_file_descriptor,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to open rate limit control file descriptor.\n" );
+
+			goto on_error;
+		}
+#else
+		fprintf(
+		 stderr,
+		 "Rate limit control file descriptor not supported on this platform.\n" );
 #endif
 	}
 	if( option_additional_digest_types != NULL )
@@ -3286,8 +4477,13 @@ int main( int argc, char * const argv[] )
 	result = ewfacquire_read_input(
 		  ewfacquire_imaging_handle,
 		  ewfacquire_device_handle,
+		  &( argv[ optind ] ),
+		  argc - optind,
+		  additional_sources,
+		  number_of_additional_sources,
 		  resume_acquiry_offset,
 		  swap_byte_pairs,
+		  two_pass_read_errors,
 		  print_status_information,
 	          use_chunk_data_functions,
 		  log_handle,
@@ -3360,6 +4556,19 @@ on_abort:
 
 		goto on_error;
 	}
+	if( stats_output != NULL )
+	{
+		if( stats_output_free(
+		     &stats_output,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to free statistics output.\n" );
+
+			goto on_error;
+		}
+	}
 	if( device_handle_close(
 	     ewfacquire_device_handle,
 	     &error ) != 0 )
@@ -3431,6 +4640,12 @@ on_error:
 		 &ewfacquire_imaging_handle,
 		 NULL );
 	}
+	if( stats_output != NULL )
+	{
+		stats_output_free(
+		 &stats_output,
+		 NULL );
+	}
 	if( ewfacquire_device_handle != NULL )
 	{
 		device_handle_close(
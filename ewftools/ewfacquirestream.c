@@ -56,11 +56,15 @@
 #include "ewftools_unused.h"
 #include "imaging_handle.h"
 #include "log_handle.h"
+#include "logical_reader.h"
 #include "process_status.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
+#include "stream_reader.h"
 
 imaging_handle_t *ewfacquirestream_imaging_handle = NULL;
+stream_reader_t *ewfacquirestream_stream_reader   = NULL;
+logical_reader_t *ewfacquirestream_logical_reader = NULL;
 int ewfacquirestream_abort                        = 0;
 
 /* Prints the executable usage information to the stream
@@ -121,12 +125,13 @@ void usage_fprint(
 	                 "                        [ -C case_number ] [ -d digest_type ]\n"
 	                 "                        [ -D description ] [ -e examiner_name ]\n"
 	                 "                        [ -E evidence_number ] [ -f format ] [ -j jobs ]\n"
-	                 "                        [ -l log_filename ] [ -m media_type ]\n"
+	                 "                        [ -k range_digests_file ] [ -l log_filename ]\n"
+	                 "                        [ -L directory ] [ -m media_type ]\n"
 	                 "                        [ -M media_flags ] [ -N notes ]\n"
 	                 "                        [ -o offset ] [ -p process_buffer_size ]\n"
 	                 "                        [ -P bytes_per_sector ] [ -S segment_file_size ]\n"
 	                 "                        [ -t target ] [ -2 secondary_target ]\n"
-	                 "                        [ -hqsvVx ]\n\n" );
+	                 "                        [ -hHOqsUvVx ]\n\n" );
 
 	fprintf( stream, "\tReads data from stdin\n\n" );
 
@@ -158,15 +163,29 @@ void usage_fprint(
 	                 "\t    encase3, encase4, encase5, encase6 (default), encase7, linen5,\n"
 	                 "\t    linen6, linen7, ewfx\n" );
 	fprintf( stream, "\t-h: shows this help\n" );
+	fprintf( stream, "\t-H: use huge pages for the chunk data and storage media\n"
+	                 "\t    buffers, falls back to normal pages if not available\n" );
 	fprintf( stream, "\t-j: the number of concurrent processing jobs (threads), where\n"
 	                 "\t    a number of 0 represents single-threaded mode (default is 4\n"
-	                 "\t    if multi-threaded mode is supported)\n" );
+	                 "\t    if multi-threaded mode is supported) or auto, which adjusts\n"
+	                 "\t    the number of threads at runtime until the throughput is\n"
+	                 "\t    bounded by the input or target\n" );
+	fprintf( stream, "\t-k: write the SHA-256 of every 64 MiB range of the media data to\n"
+	                 "\t    the range_digests_file, which allows ewfverify to verify the\n"
+	                 "\t    ranges in parallel\n" );
 	fprintf( stream, "\t-l: logs acquiry errors and the digest (hash) to the log_filename\n" );
+	fprintf( stream, "\t-L: acquire the files in the directory as a logical image (L01)\n"
+	                 "\t    instead of reading stdin, the format options are: encase5,\n"
+	                 "\t    encase6 (default)\n" );
 	fprintf( stream, "\t-m: specify the media type, options: fixed (default), removable,\n"
 	                 "\t    optical, memory\n" );
 	fprintf( stream, "\t-M: specify the media flags, options: logical, physical (default)\n" );
 	fprintf( stream, "\t-N: specify the notes (default is notes).\n" );
 	fprintf( stream, "\t-o: specify the offset to start to acquire (default is 0)\n" );
+	fprintf( stream, "\t-O: sequential output, write the segment files strictly sequentially\n"
+	                 "\t    without reading back, rewriting or truncating them, such that\n"
+	                 "\t    they can be written to object storage mounted as a file system\n"
+	                 "\t    (requires the encase7-v2 format and -B)\n" );
 	fprintf( stream, "\t-p: specify the process buffer size (default is the chunk size)\n" );
 	fprintf( stream, "\t-P: specify the number of bytes per sector (default is 512)\n" );
 	fprintf( stream, "\t-q: quiet shows minimal status information\n" );
@@ -195,6 +214,8 @@ void usage_fprint(
 	}
 	fprintf( stream, "\t-t: specify the target file (without extension) to write to (default\n"
 	                 "\t    is image)\n" );
+	fprintf( stream, "\t-U: unbuffered output, do not retain the written segment files\n"
+	                 "\t    in the operating system page cache\n" );
 	fprintf( stream, "\t-v: verbose output to stderr\n" );
 	fprintf( stream, "\t-V: print version\n" );
 	fprintf( stream, "\t-x: use the chunk data instead of the buffered read and write functions.\n" );
@@ -229,6 +250,38 @@ void ewfacquirestream_signal_handler(
 			 &error );
 		}
 	}
+	if( ewfacquirestream_stream_reader != NULL )
+	{
+		if( stream_reader_signal_abort(
+		     ewfacquirestream_stream_reader,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal stream reader to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	if( ewfacquirestream_logical_reader != NULL )
+	{
+		if( logical_reader_signal_abort(
+		     ewfacquirestream_logical_reader,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal logical reader to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
 	/* Force stdin to close otherwise any function reading it will remain blocked
 	 */
 #if defined( WINAPI ) && !defined( __CYGWIN__ )
@@ -245,250 +298,14 @@ void ewfacquirestream_signal_handler(
 	}
 }
 
-/* Reads a chunk of data from the file descriptor into the buffer
- * Returns the number of bytes read, 0 if at end of input or -1 on error
- */
-ssize_t ewfacquirestream_read_chunk(
-         libewf_handle_t *handle,
-         int input_file_descriptor,
-         storage_media_buffer_t *storage_media_buffer,
-         off64_t storage_media_offset,
-         size_t buffer_read_size,
-         size32_t chunk_size,
-         uint8_t read_error_retries,
-         libcerror_error_t **error )
-{
-	static char *function         = "ewfacquirestream_read_chunk";
-	size_t buffer_offset          = 0;
-	size_t chunk_read_size        = 0;
-	size_t input_read_size        = 0;
-	size_t remaining_read_size    = 0;
-	ssize_t chunk_read_count      = 0;
-	ssize_t input_read_count      = 0;
-	int32_t read_number_of_errors = 0;
-
-	if( handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
-		 function );
-
-		return( -1 );
-	}
-	if( input_file_descriptor == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid input file descriptor.",
-		 function );
-
-		return( -1 );
-	}
-	if( storage_media_buffer == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid storage media buffer.",
-		 function );
-
-		return( -1 );
-	}
-	if( buffer_read_size > (size_t) SSIZE_MAX )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid buffer read size value exceeds maximum.",
-		 function );
-
-		return( -1 );
-	}
-	if( chunk_size == 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
-		 "%s: invalid chunk size value zero or less.",
-		 function );
-
-		return( -1 );
-	}
-	remaining_read_size = buffer_read_size;
-
-	while( remaining_read_size > 0 )
-	{
-		/* Determine the number of bytes to read from the input
-		 * Read as much as possible in chunk sizes
-		 */
-		if( remaining_read_size < (size_t) chunk_size )
-		{
-			chunk_read_size = remaining_read_size;
-		}
-		else
-		{
-			chunk_read_size = chunk_size;
-		}
-		input_read_size = chunk_read_size;
-
-		chunk_read_count      = 0;
-		read_number_of_errors = 0;
-
-		while( input_read_size > 0 )
-		{
-			if( ewfacquirestream_abort != 0 )
-			{
-				break;
-			}
-#if defined( HAVE_VERBOSE_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-				 "%s: reading buffer at offset: 0x%08" PRIx64 " of size: %" PRIzd ".\n",
-				 function,
-				 storage_media_offset + (off64_t) buffer_offset,
-				 input_read_size );
-			}
-#endif
-#if defined( WINAPI ) && !defined( __CYGWIN__ )
-			input_read_count = _read(
-			                    input_file_descriptor,
-			                    &( ( storage_media_buffer->raw_buffer )[ buffer_offset ] ),
-			                    input_read_size );
-#else
-			input_read_count = read(
-			                    input_file_descriptor,
-			                    &( ( storage_media_buffer->raw_buffer )[ buffer_offset ] ),
-			                    input_read_size );
-#endif
-			if( input_read_count < 0 )
-			{
-				if( ( errno == ESPIPE )
-				 || ( errno == EPERM )
-				 || ( errno == ENXIO )
-				 || ( errno == ENODEV ) )
-				{
-					if( errno == ESPIPE )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_IO,
-						 LIBCERROR_IO_ERROR_READ_FAILED,
-						 "%s: error reading data: invalid seek.",
-						 function );
-					}
-					else if( errno == EPERM )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_IO,
-						 LIBCERROR_IO_ERROR_READ_FAILED,
-						 "%s: error reading data: operation not permitted.",
-						 function );
-					}
-					else if( errno == ENXIO )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_IO,
-						 LIBCERROR_IO_ERROR_READ_FAILED,
-						 "%s: error reading data: no such device or address.",
-						 function );
-					}
-					else if( errno == ENODEV )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_IO,
-						 LIBCERROR_IO_ERROR_READ_FAILED,
-						 "%s: error reading data: no such device.",
-						 function );
-					}
-					else
-					{
-						libcerror_system_set_error(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_IO,
-						 LIBCERROR_IO_ERROR_READ_FAILED,
-						 errno,
-						 "%s: error reading data.",
-						 function );
-					}
-					return( -1 );
-				}
-				read_number_of_errors++;
-			}
-			/* No bytes were read
-			 */
-			else if( input_read_count == 0 )
-			{
-				break;
-			}
-			else
-			{
-				chunk_read_count += input_read_count;
-				buffer_offset    += input_read_count;
-				input_read_size  -= input_read_count;
-
-				/* The entire read is OK
-				 */
-				if( chunk_read_count == (ssize_t) chunk_read_size )
-				{
-					break;
-				}
-				/* There was a read error at a certain offset
-				 */
-#if defined( HAVE_VERBOSE_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: read error at offset: 0x%08" PRIx64 " when reading %" PRIzd " bytes.\n",
-					 function,
-					 storage_media_offset + (off64_t) buffer_offset,
-					 input_read_count );
-				}
-#endif
-				read_number_of_errors++;
-			}
-			if( read_number_of_errors > read_error_retries )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: error reading data.",
-				 function );
-
-				return( -1 );
-			}
-		}
-		if( chunk_read_count == 0 )
-		{
-			break;
-		}
-		remaining_read_size -= chunk_read_count;
-	}
-	storage_media_buffer->storage_media_offset = storage_media_offset;
-	storage_media_buffer->requested_size       = buffer_read_size;
-	storage_media_buffer->raw_buffer_data_size = buffer_offset;
-
-	return( (ssize_t) buffer_offset );
-}
-
 /* Reads the input
+ * The input is read from the logical reader if set, otherwise from the input file descriptor
  * Returns 1 if successful or -1 on error
  */
 int ewfacquirestream_read_input(
      imaging_handle_t *imaging_handle,
      int input_file_descriptor,
+     logical_reader_t *logical_reader,
      uint8_t swap_byte_pairs,
      uint8_t read_error_retries,
      uint8_t print_status_information,
@@ -497,15 +314,12 @@ int ewfacquirestream_read_input(
      libcerror_error_t **error )
 {
 	storage_media_buffer_t *storage_media_buffer = NULL;
+	stream_reader_t *stream_reader               = NULL;
 	uint8_t *data                                = NULL;
 	static char *function                        = "ewfacquirestream_read_input";
-	off64_t storage_media_offset                 = 0;
-	size64_t remaining_aquiry_size               = 0;
-	size64_t skip_aquiry_size                    = 0;
 	size32_t chunk_size                          = 0;
 	size_t data_size                             = 0;
 	size_t process_buffer_size                   = 0;
-	size_t read_size                             = 0;
 	ssize_t read_count                           = 0;
 	ssize_t process_count                        = 0;
 	ssize_t write_count                          = 0;
@@ -513,7 +327,9 @@ int ewfacquirestream_read_input(
 	int status                                   = PROCESS_STATUS_COMPLETED;
 
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
+	int initial_number_of_queued_items           = 0;
 	int maximum_number_of_queued_items           = 0;
+	int number_of_read_buffers                   = 0;
 #endif
 
 	if( imaging_handle == NULL )
@@ -538,7 +354,8 @@ int ewfacquirestream_read_input(
 
 		return( -1 );
 	}
-	if( input_file_descriptor == -1 )
+	if( ( logical_reader == NULL )
+	 && ( input_file_descriptor == -1 ) )
 	{
 		libcerror_error_set(
 		 error,
@@ -604,25 +421,62 @@ int ewfacquirestream_read_input(
 		}
 		storage_media_buffer_mode = STORAGE_MEDIA_BUFFER_MODE_BUFFERED;
 	}
+	if( imaging_handle->use_huge_pages != 0 )
+	{
+		if( libewf_handle_set_use_huge_pages(
+		     imaging_handle->output_handle,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set use huge pages.",
+			 function );
+
+			return( -1 );
+		}
+	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 	if( imaging_handle->number_of_threads != 0 )
 	{
-		maximum_number_of_queued_items = 1 + ( ( 512 * 1024 * 1024 ) / process_buffer_size );
+		if( storage_media_buffer_queue_get_maximum_number_of_buffers(
+		     0,
+		     process_buffer_size,
+		     imaging_handle->number_of_threads + 1,
+		     &maximum_number_of_queued_items,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine maximum number of queued items.",
+			 function );
 
-		if( libcthreads_thread_pool_create(
-		     &( imaging_handle->process_thread_pool ),
-		     NULL,
-		     imaging_handle->number_of_threads,
+			goto on_error;
+		}
+		/* The storage media buffer queue starts with a few buffers per process thread
+		 * and grows, up to the maximum number of queued items, when the output is stalled
+		 */
+		initial_number_of_queued_items = 4 * imaging_handle->number_of_threads;
+
+		if( initial_number_of_queued_items > maximum_number_of_queued_items )
+		{
+			initial_number_of_queued_items = maximum_number_of_queued_items;
+		}
+
+		if( imaging_handle_create_process_thread_pools(
+		     imaging_handle,
 		     maximum_number_of_queued_items,
-		     (int (*)(intptr_t *, void *)) &imaging_handle_process_storage_media_buffer_callback,
-		     (void *) imaging_handle,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize process thread pool.",
+			 "%s: unable to initialize process thread pools.",
 			 function );
 
 			goto on_error;
@@ -661,9 +515,12 @@ int ewfacquirestream_read_input(
 		if( storage_media_buffer_queue_initialize(
 		     &( imaging_handle->storage_media_buffer_queue ),
 		     imaging_handle->output_handle,
+		     imaging_handle->numa_topology,
+		     initial_number_of_queued_items,
 		     maximum_number_of_queued_items,
 		     storage_media_buffer_mode,
 		     process_buffer_size,
+		     imaging_handle->use_huge_pages,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -740,72 +597,127 @@ int ewfacquirestream_read_input(
 			goto on_error;
 		}
 	}
-	remaining_aquiry_size = imaging_handle->acquiry_size;
-	skip_aquiry_size      = imaging_handle->acquiry_offset;
-
-	while( ( imaging_handle->acquiry_size == 0 )
-	    || ( remaining_aquiry_size > 0 ) )
+	if( logical_reader == NULL )
 	{
-		if( ewfacquirestream_abort != 0 )
+		if( stream_reader_initialize(
+		     &stream_reader,
+		     input_file_descriptor,
+		     chunk_size,
+		     read_error_retries,
+		     error ) != 1 )
 		{
-			break;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create stream reader.",
+			 function );
+
+			goto on_error;
+		}
+		ewfacquirestream_stream_reader = stream_reader;
+
+		if( stream_reader_set_range(
+		     stream_reader,
+		     imaging_handle->acquiry_offset,
+		     imaging_handle->acquiry_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set stream reader range.",
+			 function );
+
+			goto on_error;
 		}
+	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
-		if( imaging_handle->number_of_threads != 0 )
+	if( ( imaging_handle->number_of_threads != 0 )
+	 && ( logical_reader != NULL ) )
+	{
+		/* The files are read and hashed by as many reader threads
+		 * as there are process threads
+		 */
+		if( logical_reader_start(
+		     logical_reader,
+		     imaging_handle->storage_media_buffer_queue,
+		     imaging_handle->number_of_threads,
+		     error ) != 1 )
 		{
-			if( storage_media_buffer_queue_grab_buffer(
-			     imaging_handle->storage_media_buffer_queue,
-			     &storage_media_buffer,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to grab storage media buffer from queue.",
-				 function );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to start logical reader.",
+			 function );
 
-				goto on_error;
-			}
-			if( storage_media_buffer == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: missing storage media buffer.",
-				 function );
+			goto on_error;
+		}
+	}
+	else if( imaging_handle->number_of_threads != 0 )
+	{
+		/* The input is read on a dedicated thread that can run ahead of the
+		 * processing by up to half of the maximum number of queued items
+		 */
+		number_of_read_buffers = maximum_number_of_queued_items / 2;
 
-				goto on_error;
-			}
+		if( number_of_read_buffers == 0 )
+		{
+			number_of_read_buffers = 1;
 		}
-#endif
-		read_size = process_buffer_size;
+		if( stream_reader_start(
+		     stream_reader,
+		     imaging_handle->storage_media_buffer_queue,
+		     number_of_read_buffers,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to start stream reader.",
+			 function );
 
-		/* Align with acquiry offset if necessary
-		 */
-		if( ( skip_aquiry_size > 0 )
-		 && ( skip_aquiry_size < (size64_t) read_size ) )
+			goto on_error;
+		}
+	}
+#endif
+	while( ewfacquirestream_abort == 0 )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( imaging_handle->number_of_threads != 0 )
+		 && ( logical_reader != NULL ) )
 		{
-			read_size = (size_t) skip_aquiry_size;
+			read_count = logical_reader_get_buffer(
+			              logical_reader,
+			              &storage_media_buffer,
+			              error );
 		}
-		else if( ( imaging_handle->acquiry_size != 0 )
-		      && ( remaining_aquiry_size < (size64_t) read_size ) )
+		else if( imaging_handle->number_of_threads != 0 )
 		{
-			read_size = (size_t) remaining_aquiry_size;
+			read_count = stream_reader_get_buffer(
+			              stream_reader,
+			              &storage_media_buffer,
+			              error );
+		}
+		else
+#endif
+		if( logical_reader != NULL )
+		{
+			read_count = logical_reader_read_buffer(
+			              logical_reader,
+			              storage_media_buffer,
+			              error );
+		}
+		else
+		{
+			read_count = stream_reader_read_buffer(
+			              stream_reader,
+			              storage_media_buffer,
+			              error );
 		}
-		/* Read a chunk from the file descriptor
-		 */
-		read_count = ewfacquirestream_read_chunk(
-		              imaging_handle->output_handle,
-		              input_file_descriptor,
-		              storage_media_buffer,
-		              storage_media_offset,
-		              storage_media_buffer->raw_buffer_size,
-		              (size32_t) read_size,
-		              read_error_retries,
-		              error );
-
 		if( read_count < 0 )
 		{
 			libcerror_error_set(
@@ -821,19 +733,34 @@ int ewfacquirestream_read_input(
 		{
 			break;
 		}
-		storage_media_offset += read_count;
-
-		/* Skip a certain number of bytes if necessary
+		/* Skip the data before the acquiry offset
 		 */
-		if( skip_aquiry_size > 0 )
+		if( storage_media_buffer->storage_media_offset < (off64_t) imaging_handle->acquiry_offset )
 		{
 			imaging_handle->last_offset_written += read_count;
-			skip_aquiry_size                    -= read_count;
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+			if( imaging_handle->number_of_threads != 0 )
+			{
+				if( storage_media_buffer_queue_release_buffer(
+				     imaging_handle->storage_media_buffer_queue,
+				     storage_media_buffer,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to release storage media buffer onto queue.",
+					 function );
+
+					goto on_error;
+				}
+				storage_media_buffer = NULL;
+			}
+#endif
 			continue;
 		}
-		remaining_aquiry_size -= read_count;
-
 		if( storage_media_buffer_get_data(
 		     storage_media_buffer,
 		     &data,
@@ -889,16 +816,16 @@ int ewfacquirestream_read_input(
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 		if( imaging_handle->number_of_threads != 0 )
 		{
-			if( libcthreads_thread_pool_push(
-			     imaging_handle->process_thread_pool,
-			     (intptr_t *) storage_media_buffer,
-			     error ) == -1 )
+			if( imaging_handle_push_process_thread_pools(
+			     imaging_handle,
+			     storage_media_buffer,
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to push storage media buffer onto process thread pool queue.",
+				 "%s: unable to push storage media buffer onto process thread pools.",
 				 function );
 
 				goto on_error;
@@ -974,23 +901,55 @@ int ewfacquirestream_read_input(
 			goto on_error;
 		}
 	}
+	if( stream_reader != NULL )
+	{
+		ewfacquirestream_stream_reader = NULL;
+
+		if( stream_reader_free(
+		     &stream_reader,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free stream reader.",
+			 function );
+
+			goto on_error;
+		}
+	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
-	if( imaging_handle->process_thread_pool != NULL )
+	if( ( logical_reader != NULL )
+	 && ( logical_reader->threads != NULL ) )
 	{
-		if( libcthreads_thread_pool_join(
-		     &( imaging_handle->process_thread_pool ),
+		if( logical_reader_stop(
+		     logical_reader,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to join process thread pool.",
+			 "%s: unable to stop logical reader.",
 			 function );
 
 			goto on_error;
 		}
 	}
+	if( imaging_handle_join_process_thread_pools(
+	     imaging_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join process thread pools.",
+		 function );
+
+		goto on_error;
+	}
 	if( imaging_handle->output_thread_pool != NULL )
 	{
 		if( libcthreads_thread_pool_join(
@@ -1067,6 +1026,34 @@ int ewfacquirestream_read_input(
 
 		goto on_error;
 	}
+	/* The single files entries (ltree) can only be written once all data
+	 * was written since they contain the offsets of the data of the files
+	 */
+	if( ( logical_reader != NULL )
+	 && ( ewfacquirestream_abort == 0 ) )
+	{
+		if( logical_reader_append_ltree(
+		     logical_reader,
+		     imaging_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append single files entries.",
+			 function );
+
+			goto on_error;
+		}
+		if( logical_reader->number_of_unreadable_entries > 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to read: %d file(s) or directory(ies), refer to the verbose output for details.\n",
+			 logical_reader->number_of_unreadable_entries );
+		}
+	}
 	write_count = imaging_handle_finalize(
 	               imaging_handle,
 	               error );
@@ -1172,12 +1159,9 @@ on_error:
 		 NULL );
 	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
-	if( imaging_handle->process_thread_pool != NULL )
-	{
-		libcthreads_thread_pool_join(
-		 &( imaging_handle->process_thread_pool ),
-		 NULL );
-	}
+	imaging_handle_join_process_thread_pools(
+	 imaging_handle,
+	 NULL );
 	if( imaging_handle->output_thread_pool != NULL )
 	{
 		libcthreads_thread_pool_join(
@@ -1194,6 +1178,35 @@ on_error:
 		 NULL,
 		 NULL );
 	}
+	/* The stream reader is stopped after the process and output thread pools
+	 * are joined, so that a reader thread waiting for a storage media buffer
+	 * is not blocked indefinitely
+	 */
+	if( ( imaging_handle->number_of_threads != 0 )
+	 && ( storage_media_buffer != NULL ) )
+	{
+		storage_media_buffer_queue_release_buffer(
+		 imaging_handle->storage_media_buffer_queue,
+		 storage_media_buffer,
+		 NULL );
+	}
+	if( ( logical_reader != NULL )
+	 && ( logical_reader->threads != NULL ) )
+	{
+		logical_reader_stop(
+		 logical_reader,
+		 NULL );
+	}
+#endif
+	if( stream_reader != NULL )
+	{
+		ewfacquirestream_stream_reader = NULL;
+
+		stream_reader_free(
+		 &stream_reader,
+		 NULL );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
 	if( imaging_handle->storage_media_buffer_queue != NULL )
 	{
 		storage_media_buffer_queue_free(
@@ -1215,6 +1228,7 @@ int main( int argc, char * const argv[] )
 	libcerror_error_t *error                             = NULL;
 	log_handle_t *log_handle                             = NULL;
 	system_character_t *log_filename                     = NULL;
+	system_character_t *option_logical_source_path       = NULL;
 	system_character_t *option_additional_digest_types   = NULL;
 	system_character_t *option_bytes_per_sector          = NULL;
 	system_character_t *option_case_number               = NULL;
@@ -1231,6 +1245,7 @@ int main( int argc, char * const argv[] )
 	system_character_t *option_number_of_jobs            = NULL;
 	system_character_t *option_offset                    = NULL;
 	system_character_t *option_process_buffer_size       = NULL;
+	system_character_t *option_range_digests_filename    = NULL;
         system_character_t *option_secondary_target_filename = NULL;
         system_character_t *option_sectors_per_chunk         = NULL;
 	system_character_t *option_size                      = NULL;
@@ -1243,7 +1258,10 @@ int main( int argc, char * const argv[] )
 	uint8_t read_error_retries                           = 2;
 	uint8_t resume_acquiry                               = 0;
 	uint8_t swap_byte_pairs                              = 0;
+	uint8_t sequential_output                            = 0;
+	uint8_t unbuffered_output                            = 0;
 	uint8_t use_chunk_data_functions                     = 0;
+	uint8_t use_huge_pages                               = 0;
 	uint8_t verbose                                      = 0;
 	int result                                           = 0;
 
@@ -1307,7 +1325,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:hj:l:m:M:N:o:p:P:qsS:t:vVx2:" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:hHj:k:l:L:m:M:N:o:Op:P:qsS:t:UvVx2:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -1387,16 +1405,31 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+			case (system_integer_t) 'H':
+				use_huge_pages = 1;
+
+				break;
+
 			case (system_integer_t) 'j':
 				option_number_of_jobs = optarg;
 
 				break;
 
+			case (system_integer_t) 'k':
+				option_range_digests_filename = optarg;
+
+				break;
+
 			case (system_integer_t) 'l':
 				log_filename = optarg;
 
 				break;
 
+			case (system_integer_t) 'L':
+				option_logical_source_path = optarg;
+
+				break;
+
 			case (system_integer_t) 'm':
 				option_media_type = optarg;
 
@@ -1417,6 +1450,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'O':
+				sequential_output = 1;
+
+				break;
+
 			case (system_integer_t) 'p':
 				option_process_buffer_size = optarg;
 
@@ -1447,6 +1485,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'U':
+				unbuffered_output = 1;
+
+				break;
+
 			case (system_integer_t) 'v':
 				verbose = 1;
 
@@ -1522,6 +1565,10 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	ewfacquirestream_imaging_handle->unbuffered_output = unbuffered_output;
+	ewfacquirestream_imaging_handle->sequential_output = sequential_output;
+	ewfacquirestream_imaging_handle->use_huge_pages    = use_huge_pages;
+
 	if( option_header_codepage != NULL )
 	{
 		result = imaging_handle_set_header_codepage(
@@ -1632,6 +1679,22 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( option_range_digests_filename != NULL )
+	{
+		if( imaging_handle_set_string(
+		     ewfacquirestream_imaging_handle,
+		     option_range_digests_filename,
+		     &( ewfacquirestream_imaging_handle->range_digests_filename ),
+		     &( ewfacquirestream_imaging_handle->range_digests_filename_size ),
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set range digests filename.\n" );
+
+			goto on_error;
+		}
+	}
 	if( option_case_number == NULL )
 	{
 		option_case_number = _SYSTEM_STRING( "case_number" );
@@ -1744,6 +1807,35 @@ int main( int argc, char * const argv[] )
 			 "Unsupported EWF format defaulting to: encase6.\n" );
 		}
 	}
+	if( option_logical_source_path != NULL )
+	{
+		if( ewfacquirestream_imaging_handle->ewf_format == LIBEWF_FORMAT_ENCASE5 )
+		{
+			ewfacquirestream_imaging_handle->ewf_format = LIBEWF_FORMAT_LOGICAL_ENCASE5;
+		}
+		else if( ewfacquirestream_imaging_handle->ewf_format == LIBEWF_FORMAT_ENCASE6 )
+		{
+			ewfacquirestream_imaging_handle->ewf_format = LIBEWF_FORMAT_LOGICAL_ENCASE6;
+		}
+		else
+		{
+			fprintf(
+			 stderr,
+			 "Logical acquiry requires the encase5 or encase6 format.\n" );
+
+			goto on_error;
+		}
+		if( ( option_offset != NULL )
+		 || ( option_size != NULL )
+		 || ( swap_byte_pairs != 0 ) )
+		{
+			fprintf(
+			 stderr,
+			 "Logical acquiry does not support the -o, -B and -s options.\n" );
+
+			goto on_error;
+		}
+	}
 	if( option_compression_values != NULL )
 	{
 		result = imaging_handle_set_compression_values(
@@ -1810,6 +1902,13 @@ int main( int argc, char * const argv[] )
 			 "Unsupported media flags defaulting to: physical.\n" );
 		}
 	}
+	/* A logical image contains single files instead of the data of a storage media
+	 */
+	if( option_logical_source_path != NULL )
+	{
+		ewfacquirestream_imaging_handle->media_type   = LIBEWF_MEDIA_TYPE_SINGLE_FILES;
+		ewfacquirestream_imaging_handle->media_flags &= ~( LIBEWF_MEDIA_FLAG_PHYSICAL );
+	}
 	if( option_bytes_per_sector != NULL )
 	{
 		result = imaging_handle_set_bytes_per_sector(
@@ -1929,6 +2028,43 @@ int main( int argc, char * const argv[] )
 			 "Unsupported acquiry size defaulting to: all bytes.\n" );
 		}
 	}
+	/* A sequential output cannot be corrected after the end of the input has been reached
+	 */
+	if( sequential_output != 0 )
+	{
+		if( ewfacquirestream_imaging_handle->ewf_format != LIBEWF_FORMAT_V2_ENCASE7 )
+		{
+			fprintf(
+			 stderr,
+			 "Sequential output requires the encase7-v2 format.\n" );
+
+			goto on_error;
+		}
+		if( ewfacquirestream_imaging_handle->acquiry_size == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Sequential output requires the number of bytes to acquire.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_logical_source_path != NULL )
+	{
+		if( logical_reader_initialize(
+		     &ewfacquirestream_logical_reader,
+		     option_logical_source_path,
+		     ewfacquirestream_imaging_handle->ewf_format,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to open directory: %" PRIs_SYSTEM ".\n",
+			 option_logical_source_path );
+
+			goto on_error;
+		}
+	}
 	if( option_process_buffer_size != NULL )
 	{
 		result = imaging_handle_set_process_buffer_size(
@@ -2102,6 +2238,7 @@ int main( int argc, char * const argv[] )
 	result = ewfacquirestream_read_input(
 	          ewfacquirestream_imaging_handle,
 	          0,
+	          ewfacquirestream_logical_reader,
 	          swap_byte_pairs,
 	          read_error_retries,
 	          print_status_information,
@@ -2155,6 +2292,19 @@ int main( int argc, char * const argv[] )
 		libcerror_error_free(
 		 &error );
 	}
+	if( ewfacquirestream_logical_reader != NULL )
+	{
+		if( logical_reader_free(
+		     &ewfacquirestream_logical_reader,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to free logical reader.\n" );
+
+			goto on_error;
+		}
+	}
 	if( imaging_handle_close(
 	     ewfacquirestream_imaging_handle,
 	     &error ) != 0 )
@@ -2217,6 +2367,12 @@ on_error:
 		 &log_handle,
 		 NULL );
 	}
+	if( ewfacquirestream_logical_reader != NULL )
+	{
+		logical_reader_free(
+		 &ewfacquirestream_logical_reader,
+		 NULL );
+	}
 	if( ewfacquirestream_imaging_handle != NULL )
 	{
 		imaging_handle_close(
@@ -45,6 +45,7 @@
 #endif
 
 #include "byte_size_string.h"
+#include "digest_hash.h"
 #include "ewfcommon.h"
 #include "ewfinput.h"
 #include "ewftools_getopt.h"
@@ -56,10 +57,14 @@
 #include "ewftools_libewf.h"
 #include "ewftools_output.h"
 #include "ewftools_signal.h"
+#include "ewftools_system_string.h"
 #include "ewftools_unused.h"
 #include "export_handle.h"
 #include "log_handle.h"
+#include "partition_manifest.h"
 #include "platform.h"
+#include "range_digests.h"
+#include "stats_output.h"
 
 #define EWFEXPORT_INPUT_BUFFER_SIZE		64
 
@@ -121,11 +126,16 @@ void usage_fprint(
 
 	fprintf( stream, "Usage: ewfexport [ -A codepage ] [ -b number_of_sectors ]\n"
 	                 "                 [ -B number_of_bytes ] [ -c compression_values ]\n"
-	                 "                 [ -d digest_type ] [ -f format ] [ -j jobs ] [ -l log_filename ]\n"
+	                 "                 [ -d digest_type ] [ -f format ] [ -j jobs ]\n"
+	                 "                 [ -J file_descriptor ] [ -l log_filename ]\n"
 	                 "                 [ -o offset ] [ -p process_buffer_size ]\n"
-	                 "                 [ -S segment_file_size ] [ -t target ] [ -hqsuvVwx ] ewf_files\n\n" );
+	                 "                 [ -P index/number ] [ -S segment_file_size ]\n"
+	                 "                 [ -t target ] [ -T output_specification ]\n"
+	                 "                 [ -hHqsuvVwxz ] ewf_files\n"
+	                 "       ewfexport -M [ -t target ] manifest_files\n\n" );
 
 	fprintf( stream, "\tewf_files: the first or the entire set of EWF segment files\n\n" );
+	fprintf( stream, "\tmanifest_files: the partition manifests of every partition\n\n" );
 
 	fprintf( stream, "\t-A:        codepage of header section, options: ascii (default),\n"
 	                 "\t           windows-874, windows-932, windows-936, windows-949,\n"
@@ -152,13 +162,31 @@ void usage_fprint(
 	                 "\t           raw (default), files (restricted to logical volume files), ewf,\n"
 	                 "\t           smart, encase1, encase2, encase3, encase4, encase5, encase6,\n"
 	                 "\t           encase7, encase7-v2, linen5, linen6, linen7, ewfx\n" );
+#if defined( HAVE_BLOCKED_GZIP_SUPPORT )
+	fprintf( stream, "\t           or bgzf (seekable blocked gzip, compressed using the -c level)\n" );
+#endif
 	fprintf( stream, "\t-h:        shows this help\n" );
+	fprintf( stream, "\t-H:        use huge pages for the chunk data and storage media\n"
+	                 "\t           buffers, falls back to normal pages if not available\n" );
 	fprintf( stream, "\t-j:        the number of concurrent processing jobs (threads), where\n"
 	                 "\t           a number of 0 represents single-threaded mode (default is 4\n"
-	                 "\t           if multi-threaded mode is supported)\n" );
+	                 "\t           if multi-threaded mode is supported) or auto, which\n"
+	                 "\t           adjusts the number of threads at runtime until the\n"
+	                 "\t           throughput is bounded by the source or target\n" );
+	fprintf( stream, "\t-J:        write the progress and the throughput per stage (read,\n"
+	                 "\t           process, hash and write) as JSON lines to the\n"
+	                 "\t           file_descriptor\n" );
 	fprintf( stream, "\t-l:        logs export errors and the digest (hash) to the log_filename\n" );
+	fprintf( stream, "\t-M:        combine the partition manifests of a partitioned export\n"
+	                 "\t           and print the combined SHA256 hash calculated over the range\n"
+	                 "\t           digests, if a target is specified the range digests are\n"
+	                 "\t           written to it, which can be used with ewfverify -r\n" );
 	fprintf( stream, "\t-o:        specify the offset to start the export (default is 0)\n" );
 	fprintf( stream, "\t-p:        specify the process buffer size (default is the chunk size)\n" );
+	fprintf( stream, "\t-P:        export only partition index (starting at 0) of number\n"
+	                 "\t           disjoint partitions of the media data to the raw format,\n"
+	                 "\t           e.g. 2/8, a partition manifest is written to target.manifest\n"
+	                 "\t           (cannot be combined with -o and -B)\n" );
 	fprintf( stream, "\t-q:        quiet shows minimal status information\n" );
 	fprintf( stream, "\t-s:        swap byte pairs of the media data (from AB to BA)\n"
 	                 "\t           (use this for big to little endian conversion and vice\n"
@@ -189,13 +217,24 @@ void usage_fprint(
 
 	fprintf( stream, "\t-t:        specify the target file to export to, use - for stdout\n"
 	                 "\t           (default is export) stdout is only supported for the raw\n"
-	                 "\t           format\n" );
+	                 "\t           and bgzf formats\n" );
+	fprintf( stream, "\t-T:        write an additional output from the same decoded and hashed\n"
+	                 "\t           data, can be repeated up to %d times. The specification\n"
+	                 "\t           consists of comma separated key=value pairs: format=raw or\n"
+	                 "\t           an EWF format (default is encase6), compression=level,\n"
+	                 "\t           segment_size=size and target=path, where the target must\n"
+	                 "\t           be last, e.g. format=raw,target=/cases/image\n",
+	 EXPORT_HANDLE_MAXIMUM_NUMBER_OF_ADDITIONAL_OUTPUTS );
 	fprintf( stream, "\t-u:        unattended mode (disables user interaction)\n" );
 	fprintf( stream, "\t-v:        verbose output to stderr\n" );
 	fprintf( stream, "\t-V:        print version\n" );
 	fprintf( stream, "\t-w:        zero sectors on checksum error (mimic EnCase like behavior)\n" );
 	fprintf( stream, "\t-x:        use the chunk data instead of the buffered read and write\n"
-	                 "\t           functions.\n" );
+	                 "\t           functions. When the whole input is exported to EWF with\n"
+	                 "\t           the same chunk size and compression values compressed\n"
+	                 "\t           chunks are copied without being recompressed.\n" );
+	fprintf( stream, "\t-z:        write zero-filled data as sparse holes (only supported for\n"
+	                 "\t           the raw format and not for stdout)\n" );
 }
 
 /* Signal handler for ewfexport
@@ -242,6 +281,131 @@ void ewfexport_signal_handler(
 	}
 }
 
+/* Combines the partition manifests into the range digests of the media data
+ * Prints the combined hash and writes the range digests to the target if specified
+ * Returns 1 if successful or -1 on error
+ */
+int ewfexport_combine_partition_manifests(
+     system_character_t * const *filenames,
+     int number_of_filenames,
+     const system_character_t *target_path,
+     libcerror_error_t **error )
+{
+	system_character_t combined_hash_string[ 65 ];
+	uint8_t combined_hash[ RANGE_DIGESTS_DIGEST_SIZE ];
+
+	range_digests_t *range_digests = NULL;
+	static char *function          = "ewfexport_combine_partition_manifests";
+
+	if( partition_manifest_combine_files(
+	     filenames,
+	     number_of_filenames,
+	     &range_digests,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to combine partition manifests.",
+		 function );
+
+		goto on_error;
+	}
+	if( range_digests_get_combined_digest(
+	     range_digests,
+	     combined_hash,
+	     RANGE_DIGESTS_DIGEST_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve combined digest.",
+		 function );
+
+		goto on_error;
+	}
+	if( digest_hash_copy_to_string(
+	     combined_hash,
+	     RANGE_DIGESTS_DIGEST_SIZE,
+	     combined_hash_string,
+	     65,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set combined hash string.",
+		 function );
+
+		goto on_error;
+	}
+	if( target_path != NULL )
+	{
+		if( range_digests_write_file(
+		     range_digests,
+		     target_path,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write range digests file.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	fprintf(
+	 stdout,
+	 "Number of partitions:\t\t\t%d\n",
+	 number_of_filenames );
+
+	fprintf(
+	 stdout,
+	 "Media size:\t\t\t\t%" PRIu64 " bytes\n",
+	 range_digests->media_size );
+
+	fprintf(
+	 stdout,
+	 "Number of ranges:\t\t\t%" PRIu64 " of %" PRIu64 " bytes\n",
+	 range_digests->number_of_ranges,
+	 range_digests->range_size );
+
+	fprintf(
+	 stdout,
+	 "SHA256 hash calculated over ranges:\t%" PRIs_SYSTEM "\n",
+	 combined_hash_string );
+
+	if( range_digests_free(
+	     &range_digests,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free range digests.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( range_digests != NULL )
+	{
+		range_digests_free(
+		 &range_digests,
+		 NULL );
+	}
+	return( -1 );
+}
+
 /* The main program
  */
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -256,6 +420,8 @@ int main( int argc, char * const argv[] )
 	struct rlimit limit_data;
 #endif
 
+	system_character_t *option_additional_outputs[ EXPORT_HANDLE_MAXIMUM_NUMBER_OF_ADDITIONAL_OUTPUTS ];
+
 	system_character_t * const *source_filenames       = NULL;
 	libcerror_error_t *error                           = NULL;
 	log_handle_t *log_handle                           = NULL;
@@ -268,21 +434,31 @@ int main( int argc, char * const argv[] )
 	system_character_t *option_maximum_segment_size    = NULL;
 	system_character_t *option_number_of_jobs          = NULL;
 	system_character_t *option_offset                  = NULL;
+	system_character_t *option_partition               = NULL;
 	system_character_t *option_process_buffer_size     = NULL;
 	system_character_t *option_sectors_per_chunk       = NULL;
 	system_character_t *option_size                    = NULL;
+	system_character_t *option_stats_file_descriptor   = NULL;
 	system_character_t *option_target_path             = NULL;
 	system_character_t *program                        = _SYSTEM_STRING( "ewfexport" );
 	system_character_t *request_string                 = NULL;
+	stats_output_t *stats_output                       = NULL;
 	system_integer_t option                            = 0;
+	size_t string_length                               = 0;
+	uint64_t stats_file_descriptor                     = 0;
 	uint8_t calculate_md5                              = 1;
+	uint8_t combine_partition_manifests                = 0;
 	uint8_t print_status_information                   = 1;
+	uint8_t sparse_output                              = 0;
 	uint8_t swap_byte_pairs                            = 0;
 	uint8_t use_chunk_data_functions                   = 0;
+	uint8_t use_huge_pages                             = 0;
 	uint8_t verbose                                    = 0;
 	uint8_t zero_chunk_on_error                        = 0;
 	int interactive_mode                               = 1;
+	int number_of_additional_outputs                   = 0;
 	int number_of_filenames                            = 0;
+	int output_index                                   = 0;
 	int result                                         = 1;
 
 #if !defined( HAVE_GLOB_H )
@@ -346,7 +522,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "A:b:B:c:d:f:hj:l:o:p:qsS:t:uvVwx" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "A:b:B:c:d:f:hHj:J:l:Mo:p:P:qsS:t:T:uvVwxz" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -406,16 +582,31 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+			case (system_integer_t) 'H':
+				use_huge_pages = 1;
+
+				break;
+
 			case (system_integer_t) 'j':
 				option_number_of_jobs = optarg;
 
 				break;
 
+			case (system_integer_t) 'J':
+				option_stats_file_descriptor = optarg;
+
+				break;
+
 			case (system_integer_t) 'l':
 				log_filename = optarg;
 
 				break;
 
+			case (system_integer_t) 'M':
+				combine_partition_manifests = 1;
+
+				break;
+
 			case (system_integer_t) 'o':
 				option_offset = optarg;
 
@@ -426,6 +617,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'P':
+				option_partition = optarg;
+
+				break;
+
 			case (system_integer_t) 'q':
 				print_status_information = 0;
 
@@ -446,6 +642,24 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'T':
+				if( number_of_additional_outputs >= EXPORT_HANDLE_MAXIMUM_NUMBER_OF_ADDITIONAL_OUTPUTS )
+				{
+					ewftools_output_version_fprint(
+					 stderr,
+					 program );
+
+					fprintf(
+					 stderr,
+					 "Too many additional outputs, maximum is: %d.\n",
+					 EXPORT_HANDLE_MAXIMUM_NUMBER_OF_ADDITIONAL_OUTPUTS );
+
+					goto on_error;
+				}
+				option_additional_outputs[ number_of_additional_outputs++ ] = optarg;
+
+				break;
+
 			case (system_integer_t) 'u':
 				interactive_mode = 0;
 
@@ -474,6 +688,11 @@ int main( int argc, char * const argv[] )
 			case (system_integer_t) 'x':
 				use_chunk_data_functions = 1;
 
+				break;
+
+			case (system_integer_t) 'z':
+				sparse_output = 1;
+
 				break;
 		}
 	}
@@ -547,6 +766,36 @@ int main( int argc, char * const argv[] )
 	number_of_filenames = argc - optind;
 #endif
 
+	if( combine_partition_manifests != 0 )
+	{
+		result = ewfexport_combine_partition_manifests(
+		          source_filenames,
+		          number_of_filenames,
+		          option_target_path,
+		          &error );
+
+		if( result != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to combine partition manifests.\n" );
+
+			goto on_error;
+		}
+#if !defined( HAVE_GLOB_H )
+		if( ewftools_glob_free(
+		     &glob,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to free glob.\n" );
+
+			goto on_error;
+		}
+#endif
+		return( EXIT_SUCCESS );
+	}
 	if( export_handle_initialize(
 	     &ewfexport_export_handle,
 	     calculate_md5,
@@ -559,6 +808,50 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	if( option_stats_file_descriptor != NULL )
+	{
+		string_length = system_string_length(
+		                 option_stats_file_descriptor );
+
+		if( ( ewftools_system_string_decimal_copy_to_64_bit(
+		       option_stats_file_descriptor,
+		       string_length + 1,
+		       &stats_file_descriptor,
+		       &error ) != 1 )
+		 || ( stats_file_descriptor > (uint64_t) INT_MAX ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported statistics file descriptor.\n" );
+
+			goto on_error;
+		}
+		if( stats_output_initialize(
+		     &stats_output,
+		     "ewfexport",
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to create statistics output.\n" );
+
+			goto on_error;
+		}
+		if( stats_output_open_file_descriptor(
+		     stats_output,
+		     (int) stats_file_descriptor,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to open statistics output.\n" );
+
+			goto on_error;
+		}
+		ewfexport_export_handle->stats_output = stats_output;
+	}
+	ewfexport_export_handle->use_huge_pages = use_huge_pages;
+
 #if defined( HAVE_GETRLIMIT )
 	if( getrlimit(
             RLIMIT_NOFILE,
@@ -850,6 +1143,40 @@ int main( int argc, char * const argv[] )
 			 "Unsupported export size defaulting to: all bytes.\n" );
 		}
 	}
+	if( option_partition != NULL )
+	{
+		if( ( option_offset != NULL )
+		 || ( option_size != NULL ) )
+		{
+			fprintf(
+			 stderr,
+			 "Partition cannot be combined with an export offset or size.\n" );
+
+			goto on_error;
+		}
+		result = export_handle_set_partition(
+			  ewfexport_export_handle,
+			  option_partition,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set partition.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported partition: %" PRIs_SYSTEM ".\n",
+			 option_partition );
+
+			goto on_error;
+		}
+	}
 	if( option_process_buffer_size != NULL )
 	{
 		result = export_handle_set_process_buffer_size(
@@ -980,6 +1307,10 @@ int main( int argc, char * const argv[] )
 			{
 				request_string = _SYSTEM_STRING( "Target path and filename without extension or - for stdout" );
 			}
+			else if( ewfexport_export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_BLOCKED_GZIP )
+			{
+				request_string = _SYSTEM_STRING( "Target path and filename or - for stdout" );
+			}
 		}
 		if( request_string != NULL )
 		{
@@ -1121,10 +1452,31 @@ int main( int argc, char * const argv[] )
 				}
 			}
 		}
-		if( ( ewfexport_export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
+		else if( ewfexport_export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_BLOCKED_GZIP )
+		{
+			if( option_compression_values == NULL )
+			{
+				result = export_handle_prompt_for_compression_level(
+					  ewfexport_export_handle,
+				          _SYSTEM_STRING( "Compression level" ),
+					  &error );
+
+				if( result == -1 )
+				{
+					fprintf(
+					 stderr,
+					 "Unable to determine compression level.\n" );
+
+					goto on_error;
+				}
+			}
+		}
+		if( ( ewfexport_export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_BLOCKED_GZIP )
+		 || ( ewfexport_export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
 		 || ( ewfexport_export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_RAW ) )
 		{
-			if( option_offset == NULL )
+			if( ( option_offset == NULL )
+			 && ( option_partition == NULL ) )
 			{
 				result = export_handle_prompt_for_export_offset(
 					  ewfexport_export_handle,
@@ -1144,7 +1496,8 @@ int main( int argc, char * const argv[] )
 					 ewfexport_export_handle->export_offset );
 				}
 			}
-			if( option_size == NULL )
+			if( ( option_size == NULL )
+			 && ( option_partition == NULL ) )
 			{
 				result = export_handle_prompt_for_export_size(
 					  ewfexport_export_handle,
@@ -1200,6 +1553,54 @@ int main( int argc, char * const argv[] )
 			}
 		}
 	}
+	if( ( option_partition != NULL )
+	 && ( ewfexport_export_handle->output_format != EXPORT_HANDLE_OUTPUT_FORMAT_BLOCKED_GZIP )
+	 && ( ewfexport_export_handle->output_format != EXPORT_HANDLE_OUTPUT_FORMAT_RAW ) )
+	{
+		fprintf(
+		 stderr,
+		 "Partition is only supported for the raw and bgzf formats.\n" );
+
+		goto on_error;
+	}
+	if( number_of_additional_outputs > 0 )
+	{
+		if( ewfexport_export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_FILES )
+		{
+			fprintf(
+			 stderr,
+			 "Additional outputs are not supported for the files format.\n" );
+
+			goto on_error;
+		}
+		for( output_index = 0;
+		     output_index < number_of_additional_outputs;
+		     output_index++ )
+		{
+			result = export_handle_append_additional_output(
+			          ewfexport_export_handle,
+			          option_additional_outputs[ output_index ],
+			          &error );
+
+			if( result == -1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to append additional output.\n" );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				fprintf(
+				 stderr,
+				 "Unsupported additional output: %" PRIs_SYSTEM ".\n",
+				 option_additional_outputs[ output_index ] );
+
+				goto on_error;
+			}
+		}
+	}
 	fprintf(
 	 stderr,
 	 "\n" );
@@ -1296,6 +1697,8 @@ int main( int argc, char * const argv[] )
 
 			goto on_error;
 		}
+		ewfexport_export_handle->sparse_output = sparse_output;
+
 		result = export_handle_export_input(
 		          ewfexport_export_handle,
 		          swap_byte_pairs,
@@ -1314,6 +1717,23 @@ int main( int argc, char * const argv[] )
 			libcerror_error_free(
 			 &error );
 		}
+		if( verbose != 0 )
+		{
+			if( ewftools_output_statistics_fprint(
+			     stderr,
+			     ewfexport_export_handle->input_handle,
+			     &error ) != 1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to print statistics.\n" );
+
+				libcnotify_print_error_backtrace(
+				 error );
+				libcerror_error_free(
+				 &error );
+			}
+		}
 	}
 	if( log_handle != NULL )
 	{
@@ -1372,6 +1792,19 @@ on_abort:
 
 		goto on_error;
 	}
+	if( stats_output != NULL )
+	{
+		if( stats_output_free(
+		     &stats_output,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to free statistics output.\n" );
+
+			goto on_error;
+		}
+	}
 	if( ewfexport_abort != 0 )
 	{
 		fprintf(
@@ -1423,6 +1856,12 @@ on_error:
 		 &ewfexport_export_handle,
 		 NULL );
 	}
+	if( stats_output != NULL )
+	{
+		stats_output_free(
+		 &stats_output,
+		 NULL );
+	}
 #if !defined( HAVE_GLOB_H )
 	if( glob != NULL )
 	{
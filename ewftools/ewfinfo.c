@@ -52,9 +52,11 @@
 #include "ewftools_signal.h"
 #include "ewftools_unused.h"
 #include "guid.h"
+#include "info_batch.h"
 #include "info_handle.h"
 
 info_handle_t *ewfinfo_info_handle = NULL;
+info_batch_t *ewfinfo_info_batch   = NULL;
 int ewfinfo_abort                  = 0;
 
 /* Prints the executable usage information
@@ -70,15 +72,24 @@ void usage_fprint(
 	                 "Compression Format).\n\n" );
 
 	fprintf( stream, "Usage: ewfinfo [ -A codepage ] [ -d date_format ] [ -f format ]\n"
-	                 "               [ -ehimvVx ] ewf_files\n\n" );
+	                 "               [ -j jobs ] [ -bcehimvVx ] ewf_files\n\n" );
 
-	fprintf( stream, "\tewf_files: the first or the entire set of EWF segment files\n\n" );
+	fprintf( stream, "\tewf_files: the first or the entire set of EWF segment files\n"
+	                 "\t           or in batch mode the first segment file of every image\n\n" );
 
 	fprintf( stream, "\t-A:        codepage of header section, options: ascii (default),\n"
 	                 "\t           windows-874, windows-932, windows-936, windows-949,\n"
 	                 "\t           windows-950, windows-1250, windows-1251, windows-1252,\n"
 	                 "\t           windows-1253, windows-1254, windows-1255, windows-1256,\n"
 	                 "\t           windows-1257 or windows-1258\n" );
+	fprintf( stream, "\t-b:        batch mode, print the information of multiple images\n"
+	                 "\t           into a single output, where every image is processed\n"
+	                 "\t           concurrently\n" );
+	fprintf( stream, "\t-c:        only show the EWF chunk map, the compression ratio\n"
+	                 "\t           histogram and the map of compressed, uncompressed,\n"
+	                 "\t           zero or pattern filled, sparse and missing regions,\n"
+	                 "\t           determined from the chunk tables without\n"
+	                 "\t           decompressing the chunk data\n" );
 	fprintf( stream, "\t-d:        specify the date format, options: ctime (default),\n"
 	                 "\t           dm (day/month), md (month/day), iso8601\n" );
 	fprintf( stream, "\t-e:        only show EWF read error information\n" );
@@ -86,6 +97,9 @@ void usage_fprint(
 	                 "\t           dfxml\n" );
 	fprintf( stream, "\t-h:        shows this help\n" );
 	fprintf( stream, "\t-i:        only show EWF acquiry information\n" );
+	fprintf( stream, "\t-j:        the number of concurrent processing jobs (threads) in\n"
+	                 "\t           batch mode, where 0 processes the images sequentially\n"
+	                 "\t           (default is 4)\n" );
 	fprintf( stream, "\t-m:        only show EWF media information\n" );
 	fprintf( stream, "\t-v:        verbose output to stderr\n" );
 	fprintf( stream, "\t-V:        print version\n" );
@@ -117,6 +131,20 @@ void ewfinfo_signal_handler(
 		libcerror_error_free(
 		 &error );
 	}
+	if( ( ewfinfo_info_batch != NULL )
+	 && ( info_batch_signal_abort(
+	       ewfinfo_info_batch,
+	       &error ) != 1 ) )
+	{
+		libcnotify_printf(
+		 "%s: unable to signal info batch to abort.\n",
+		 function );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
 	/* Force stdin to close otherwise any function reading it will remain blocked
 	 */
 #if defined( WINAPI ) && !defined( __CYGWIN__ )
@@ -149,10 +177,13 @@ int main( int argc, char * const argv[] )
 	libcerror_error_t *error                     = NULL;
 	system_character_t *option_date_format       = NULL;
 	system_character_t *option_header_codepage   = NULL;
+	system_character_t *option_number_of_jobs    = NULL;
 	system_character_t *option_output_format     = NULL;
 	system_character_t *program                  = _SYSTEM_STRING( "ewfinfo" );
 	system_integer_t option                      = 0;
+	uint8_t batch_mode                           = 0;
 	uint8_t verbose                              = 0;
+	int batch_result                             = EXIT_SUCCESS;
 	int number_of_filenames                      = 0;
 	int print_header                             = 1;
 	int result                                   = 0;
@@ -195,7 +226,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "A:d:ef:himvV" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "A:bcd:ef:hij:mvV" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -220,11 +251,38 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'b':
+				batch_mode = 1;
+
+				break;
+
 			case (system_integer_t) 'd':
 				option_date_format = optarg;
 
 				break;
 
+			case (system_integer_t) 'c':
+				if( info_option != 'a' )
+				{
+					ewftools_output_version_fprint(
+					 stderr,
+					 program );
+
+					fprintf(
+					 stderr,
+					 "Conflicting options: %" PRIc_SYSTEM " and %c\n",
+					 option,
+					 info_option );
+
+					usage_fprint(
+					 stdout );
+
+					goto on_error;
+				}
+				info_option = 'c';
+
+				break;
+
 			case (system_integer_t) 'e':
 				if( info_option != 'a' )
 				{
@@ -284,6 +342,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'j':
+				option_number_of_jobs = optarg;
+
+				break;
+
 			case (system_integer_t) 'm':
 				if( info_option != 'a' )
 				{
@@ -396,9 +459,19 @@ int main( int argc, char * const argv[] )
 	}
 	if( ewfinfo_info_handle->output_format == INFO_HANDLE_OUTPUT_FORMAT_DFXML )
 	{
-		if( info_handle_dfxml_header_fprint(
-		     ewfinfo_info_handle,
-		     &error ) != 1 )
+		if( batch_mode != 0 )
+		{
+			result = info_handle_dfxml_objects_header_fprint(
+			          ewfinfo_info_handle,
+			          &error );
+		}
+		else
+		{
+			result = info_handle_dfxml_header_fprint(
+			          ewfinfo_info_handle,
+			          &error );
+		}
+		if( result != 1 )
 		{
 			ewftools_output_version_fprint(
 			 stderr,
@@ -496,6 +569,68 @@ int main( int argc, char * const argv[] )
 			 "Unsupported header codepage defaulting to: ascii.\n" );
 		}
 	}
+	if( batch_mode != 0 )
+	{
+		if( info_batch_initialize(
+		     &ewfinfo_info_batch,
+		     ewfinfo_info_handle,
+		     info_option,
+		     &error ) != 1 )
+		{
+			if( print_header != 0 )
+			{
+				ewftools_output_version_fprint(
+				 stderr,
+				 program );
+
+				print_header = 0;
+			}
+			fprintf(
+			 stderr,
+			 "Unable to create info batch.\n" );
+
+			goto on_error;
+		}
+		if( option_number_of_jobs != NULL )
+		{
+			result = info_batch_set_number_of_threads(
+			          ewfinfo_info_batch,
+			          option_number_of_jobs,
+			          &error );
+
+			if( result == -1 )
+			{
+				if( print_header != 0 )
+				{
+					ewftools_output_version_fprint(
+					 stderr,
+					 program );
+
+					print_header = 0;
+				}
+				fprintf(
+				 stderr,
+				 "Unable to set number of jobs (threads).\n" );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				if( print_header != 0 )
+				{
+					ewftools_output_version_fprint(
+					 stderr,
+					 program );
+
+					print_header = 0;
+				}
+				fprintf(
+				 stderr,
+				 "Unsupported number of jobs (threads) defaulting to: %d.\n",
+				 ewfinfo_info_batch->number_of_threads );
+			}
+		}
+	}
 #if !defined( HAVE_GLOB_H )
 	if( ewftools_glob_initialize(
 	     &glob,
@@ -580,6 +715,20 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	if( ewfinfo_info_batch != NULL )
+	{
+		if( info_batch_set_maximum_number_of_open_handles(
+		     ewfinfo_info_batch,
+		     (int) limit_data.rlim_max,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set maximum number of open file handles in info batch.\n" );
+
+			goto on_error;
+		}
+	}
 #endif
 	if( ewftools_signal_attach(
 	     ewfinfo_signal_handler,
@@ -602,6 +751,52 @@ int main( int argc, char * const argv[] )
 		libcerror_error_free(
 		 &error );
 	}
+	if( ewfinfo_info_batch != NULL )
+	{
+		result = info_batch_process(
+		          ewfinfo_info_batch,
+		          source_filenames,
+		          number_of_filenames,
+		          &error );
+
+		if( ewfinfo_abort != 0 )
+		{
+			goto on_abort;
+		}
+		if( result == -1 )
+		{
+			if( print_header != 0 )
+			{
+				ewftools_output_version_fprint(
+				 stderr,
+				 program );
+
+				print_header = 0;
+			}
+			fprintf(
+			 stderr,
+			 "Unable to process EWF images.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			batch_result = EXIT_FAILURE;
+		}
+#if !defined( HAVE_GLOB_H )
+		if( ewftools_glob_free(
+		     &glob,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to free glob.\n" );
+
+			goto on_error;
+		}
+#endif
+		goto print_footer;
+	}
 	result = info_handle_open_input(
 	          ewfinfo_info_handle,
 	          source_filenames,
@@ -786,6 +981,30 @@ int main( int argc, char * const argv[] )
 			 &error );
 		}
 	}
+	if( info_option == 'c' )
+	{
+		if( info_handle_chunk_map_fprint(
+		     ewfinfo_info_handle,
+		     &error ) != 1 )
+		{
+			if( print_header != 0 )
+			{
+				ewftools_output_version_fprint(
+				 stderr,
+				 program );
+
+				print_header = 0;
+			}
+			fprintf(
+			 stderr,
+			 "Unable to print chunk map.\n" );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
 	if( info_handle_single_files_fprint(
 	     ewfinfo_info_handle,
 	     &error ) != 1 )
@@ -807,11 +1026,22 @@ int main( int argc, char * const argv[] )
 		libcerror_error_free(
 		 &error );
 	}
+print_footer:
 	if( ewfinfo_info_handle->output_format == INFO_HANDLE_OUTPUT_FORMAT_DFXML )
 	{
-		if( info_handle_dfxml_footer_fprint(
-		     ewfinfo_info_handle,
-		     &error ) != 1 )
+		if( batch_mode != 0 )
+		{
+			result = info_handle_dfxml_objects_footer_fprint(
+			          ewfinfo_info_handle,
+			          &error );
+		}
+		else
+		{
+			result = info_handle_dfxml_footer_fprint(
+			          ewfinfo_info_handle,
+			          &error );
+		}
+		if( result != 1 )
 		{
 			if( print_header != 0 )
 			{
@@ -828,6 +1058,24 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( ( verbose != 0 )
+	 && ( batch_mode == 0 ) )
+	{
+		if( ewftools_output_statistics_fprint(
+		     stderr,
+		     ewfinfo_info_handle->input_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to print statistics.\n" );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
 on_abort:
 	if( info_handle_close(
 	     ewfinfo_info_handle,
@@ -885,6 +1133,27 @@ on_abort:
 
 		goto on_error;
 	}
+	if( ewfinfo_info_batch != NULL )
+	{
+		if( info_batch_free(
+		     &ewfinfo_info_batch,
+		     &error ) != 1 )
+		{
+			if( print_header != 0 )
+			{
+				ewftools_output_version_fprint(
+				 stderr,
+				 program );
+
+				print_header = 0;
+			}
+			fprintf(
+			 stderr,
+			 "Unable to free info batch.\n" );
+
+			goto on_error;
+		}
+	}
 	if( ewfinfo_abort != 0 )
 	{
 		if( print_header != 0 )
@@ -902,7 +1171,7 @@ on_abort:
 
 		return( EXIT_FAILURE );
 	}
-	return( EXIT_SUCCESS );
+	return( batch_result );
 
 on_error:
 	if( error != NULL )
@@ -912,6 +1181,12 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( ewfinfo_info_batch != NULL )
+	{
+		info_batch_free(
+		 &ewfinfo_info_batch,
+		 NULL );
+	}
 	if( ewfinfo_info_handle != NULL )
 	{
 		info_handle_free(
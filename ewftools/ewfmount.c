@@ -22,6 +22,7 @@
 #include <common.h>
 #include <file_stream.h>
 #include <memory.h>
+#include <narrow_string.h>
 #include <system_string.h>
 #include <types.h>
 
@@ -43,6 +44,7 @@
 #include <sys/resource.h>
 #endif
 
+#include "byte_size_string.h"
 #include "ewftools_getopt.h"
 #include "ewftools_glob.h"
 #include "ewftools_i18n.h"
@@ -52,14 +54,20 @@
 #include "ewftools_libewf.h"
 #include "ewftools_output.h"
 #include "ewftools_signal.h"
+#include "ewftools_system_string.h"
 #include "ewftools_unused.h"
 #include "mount_dokan.h"
 #include "mount_fuse.h"
 #include "mount_handle.h"
+#include "mount_nbd.h"
 
 mount_handle_t *ewfmount_mount_handle = NULL;
 int ewfmount_abort                    = 0;
 
+#if defined( HAVE_MOUNT_NBD )
+mount_nbd_server_t *ewfmount_nbd_server = NULL;
+#endif
+
 /* Prints usage information
  */
 void usage_fprint(
@@ -71,17 +79,46 @@ void usage_fprint(
 	}
 	fprintf( stream, "Use ewfmount to mount an Expert Witness Compression Format (EWF) image file\n\n" );
 
-	fprintf( stream, "Usage: ewfmount [ -f format ] [ -X extended_options ] [ -hvV ] image mount_point\n\n" );
+	fprintf( stream, "Usage: ewfmount [ -a access_map_file ] [ -f format ] [ -j number_of_threads ]\n"
+	                 "                [ -r read_ahead_size ] [ -w overlay_file ] [ -X extended_options ]\n"
+	                 "                [ -hvV ] image mount_point\n"
+	                 "       ewfmount -m [ -c chunk_cache_size ] [ -j number_of_threads ]\n"
+	                 "                [ -r read_ahead_size ] [ -X extended_options ] [ -hvV ]\n"
+	                 "                image1 [ image2 ... ] mount_point\n"
+	                 "       ewfmount -s socket [ -a access_map_file ] [ -r read_ahead_size ]\n"
+	                 "                [ -w overlay_file ] [ -hvV ] image\n\n" );
 
 	fprintf( stream, "\timage:       an Expert Witness Compression Format (EWF) image file\n\n" );
 	fprintf( stream, "\tmount_point: the directory to serve as mount point\n\n" );
 
+	fprintf( stream, "\t-a:          specify the access map file, the chunks that were accessed while\n"
+	                 "\t             mounted before, such as the file system metadata, are prefetched\n"
+	                 "\t             in the background and the chunks that are accessed while mounted\n"
+	                 "\t             are written to it on unmount (not supported on Windows)\n" );
+	fprintf( stream, "\t-c:          specify the size of the chunk cache that is shared by the images\n"
+	                 "\t             when mounting multiple images, for example 1GiB (default is 256MiB)\n" );
 	fprintf( stream, "\t-f:          specify the input format, options: raw (default), files (restricted to\n"
 	                 "\t             logical volume files)\n" );
 	fprintf( stream, "\t-h:          shows this help\n" );
+	fprintf( stream, "\t-j:          specify the number of threads of the sub system that handle\n"
+	                 "\t             requests (only supported by Dokan)\n" );
+	fprintf( stream, "\t-m:          mount multiple images, every image argument is the first segment\n"
+	                 "\t             file of a separate image that is mounted as ewf1, ewf2, etc. The\n"
+	                 "\t             images share the chunk cache, the open file handles and the worker\n"
+	                 "\t             threads so that idle images use little memory (only supports the\n"
+	                 "\t             raw input format)\n" );
+	fprintf( stream, "\t-r:          specify the read ahead size, for example 1MiB, used for the\n"
+	                 "\t             read ahead of the media data and the read ahead of the sub system\n"
+	                 "\t             (if supported)\n" );
+	fprintf( stream, "\t-s:          export the media data as a network block device (NBD) on the\n"
+	                 "\t             Unix domain socket instead of mounting, for example:\n"
+	                 "\t             nbd-client -unix socket /dev/nbd0 -C 4 (not supported on Windows)\n" );
 	fprintf( stream, "\t-v:          verbose output to stderr, while ewfmount will remain running in the\n"
 	                 "\t             foreground\n" );
 	fprintf( stream, "\t-V:          print version\n" );
+	fprintf( stream, "\t-w:          make the media data writable, data written is stored in the\n"
+	                 "\t             overlay file and the image is not modified, an existing\n"
+	                 "\t             overlay file is overwritten (not supported by Dokan)\n" );
 	fprintf( stream, "\t-X:          extended options to pass to sub system\n" );
 }
 
@@ -113,6 +150,24 @@ void ewfmount_signal_handler(
 			 &error );
 		}
 	}
+#if defined( HAVE_MOUNT_NBD )
+	if( ewfmount_nbd_server != NULL )
+	{
+		if( mount_nbd_server_signal_abort(
+		     ewfmount_nbd_server,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal NBD server to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif
 	/* Force stdin to close otherwise any function reading it will remain blocked
 	 */
 #if defined( WINAPI ) && !defined( __CYGWIN__ )
@@ -141,29 +196,42 @@ int main( int argc, char * const argv[] )
 	struct rlimit limit_data;
 #endif
 
-	system_character_t * const *sources         = NULL;
-	libewf_error_t *error                       = NULL;
-	system_character_t *mount_point             = NULL;
-	system_character_t *option_extended_options = NULL;
-	system_character_t *option_format           = NULL;
-	const system_character_t *path_prefix       = NULL;
-	char *program                               = _SYSTEM_STRING( "ewfmount" );
-	system_integer_t option                     = 0;
-	size_t path_prefix_size                     = 0;
-	int number_of_sources                       = 0;
-	int result                                  = 0;
-	int verbose                                 = 0;
+	system_character_t * const *sources          = NULL;
+	libewf_error_t *error                        = NULL;
+	system_character_t *mount_point              = NULL;
+	system_character_t *option_access_map_file   = NULL;
+	system_character_t *option_chunk_cache_size  = NULL;
+	system_character_t *option_extended_options  = NULL;
+	system_character_t *option_format            = NULL;
+	system_character_t *option_number_of_threads = NULL;
+	system_character_t *option_overlay_file      = NULL;
+	system_character_t *option_read_ahead_size   = NULL;
+	system_character_t *option_socket            = NULL;
+	const system_character_t *path_prefix        = NULL;
+	char *program                                = _SYSTEM_STRING( "ewfmount" );
+	system_integer_t option                      = 0;
+	size_t path_prefix_size                      = 0;
+	size_t string_length                         = 0;
+	uint64_t chunk_cache_size                    = 0;
+	uint64_t number_of_threads                   = 0;
+	uint64_t read_ahead_size                     = 0;
+	int number_of_sources                        = 0;
+	int result                                   = 0;
+	int separate_images                          = 0;
+	int verbose                                  = 0;
 
 #if !defined( HAVE_GLOB_H )
-	ewftools_glob_t *glob                       = NULL;
+	ewftools_glob_t *glob                        = NULL;
 #endif
 
 #if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBOSXFUSE )
 	struct fuse_operations ewfmount_fuse_operations;
 
-	struct fuse_args ewfmount_fuse_arguments    = FUSE_ARGS_INIT(0, NULL);
-	struct fuse_chan *ewfmount_fuse_channel     = NULL;
-	struct fuse *ewfmount_fuse_handle           = NULL;
+	char fuse_read_ahead_options[ 64 ];
+
+	struct fuse_args ewfmount_fuse_arguments     = FUSE_ARGS_INIT(0, NULL);
+	struct fuse_chan *ewfmount_fuse_channel      = NULL;
+	struct fuse *ewfmount_fuse_handle            = NULL;
 
 #elif defined( HAVE_LIBDOKAN )
 	DOKAN_OPERATIONS ewfmount_dokan_operations;
@@ -203,7 +271,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "f:hvVX:" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "a:c:f:hj:mr:s:vVw:X:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -219,6 +287,16 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_FAILURE );
 
+			case (system_integer_t) 'a':
+				option_access_map_file = optarg;
+
+				break;
+
+			case (system_integer_t) 'c':
+				option_chunk_cache_size = optarg;
+
+				break;
+
 			case (system_integer_t) 'f':
 				option_format = optarg;
 
@@ -230,6 +308,26 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+			case (system_integer_t) 'j':
+				option_number_of_threads = optarg;
+
+				break;
+
+			case (system_integer_t) 'm':
+				separate_images = 1;
+
+				break;
+
+			case (system_integer_t) 'r':
+				option_read_ahead_size = optarg;
+
+				break;
+
+			case (system_integer_t) 's':
+				option_socket = optarg;
+
+				break;
+
 			case (system_integer_t) 'v':
 				verbose = 1;
 
@@ -241,6 +339,11 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+			case (system_integer_t) 'w':
+				option_overlay_file = optarg;
+
+				break;
+
 			case (system_integer_t) 'X':
 				option_extended_options = optarg;
 
@@ -258,18 +361,80 @@ int main( int argc, char * const argv[] )
 
 		return( EXIT_FAILURE );
 	}
-	if( ( optind + 1 ) == argc )
+	if( option_socket != NULL )
 	{
+#if !defined( HAVE_MOUNT_NBD )
 		fprintf(
 		 stderr,
-		 "Missing mount point.\n" );
+		 "Exporting as network block device not supported on this system.\n" );
 
-		usage_fprint(
-		 stdout );
+		return( EXIT_FAILURE );
+#endif
+	}
+	else
+	{
+		if( ( optind + 1 ) == argc )
+		{
+			fprintf(
+			 stderr,
+			 "Missing mount point.\n" );
+
+			usage_fprint(
+			 stdout );
+
+			return( EXIT_FAILURE );
+		}
+		mount_point = argv[ argc - 1 ];
+	}
+
+	if( separate_images != 0 )
+	{
+		if( option_socket != NULL )
+		{
+			fprintf(
+			 stderr,
+			 "Multiple images cannot be exported as network block device.\n" );
+
+			return( EXIT_FAILURE );
+		}
+		if( ( option_overlay_file != NULL )
+		 || ( option_access_map_file != NULL ) )
+		{
+			fprintf(
+			 stderr,
+			 "Overlay and access map files not supported for multiple images.\n" );
+
+			return( EXIT_FAILURE );
+		}
+	}
+	else if( option_chunk_cache_size != NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Chunk cache size only supported for multiple images.\n" );
+
+		return( EXIT_FAILURE );
+	}
+#if defined( HAVE_LIBDOKAN )
+	if( option_overlay_file != NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Overlay file not supported by Dokan.\n" );
+
+		return( EXIT_FAILURE );
+	}
+#endif
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( option_access_map_file != NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Access map file not supported on this system.\n" );
 
 		return( EXIT_FAILURE );
 	}
-	mount_point = argv[ argc - 1 ];
+#endif
 
 	libcnotify_verbose_set(
 	 verbose );
@@ -279,6 +444,65 @@ int main( int argc, char * const argv[] )
 	libewf_notify_set_verbose(
 	 verbose );
 
+	if( option_read_ahead_size != NULL )
+	{
+		string_length = system_string_length(
+		                 option_read_ahead_size );
+
+		if( ( byte_size_string_convert(
+		       option_read_ahead_size,
+		       string_length,
+		       &read_ahead_size,
+		       &error ) != 1 )
+		 || ( read_ahead_size == 0 )
+		 || ( read_ahead_size > (uint64_t) UINT32_MAX ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported read ahead size.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_chunk_cache_size != NULL )
+	{
+		string_length = system_string_length(
+		                 option_chunk_cache_size );
+
+		if( ( byte_size_string_convert(
+		       option_chunk_cache_size,
+		       string_length,
+		       &chunk_cache_size,
+		       &error ) != 1 )
+		 || ( chunk_cache_size == 0 ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported chunk cache size.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_number_of_threads != NULL )
+	{
+		string_length = system_string_length(
+		                 option_number_of_threads );
+
+		if( ( ewftools_system_string_decimal_copy_to_64_bit(
+		       option_number_of_threads,
+		       string_length + 1,
+		       &number_of_threads,
+		       &error ) != 1 )
+		 || ( number_of_threads > (uint64_t) UINT16_MAX ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of threads.\n" );
+
+			goto on_error;
+		}
+	}
+
 #if !defined( HAVE_GLOB_H )
 	if( ewftools_glob_initialize(
 	     &glob,
@@ -293,7 +517,7 @@ int main( int argc, char * const argv[] )
 	if( ewftools_glob_resolve(
 	     glob,
 	     &( argv[ optind ] ),
-	     argc - optind - 1,
+	     ( mount_point != NULL ) ? argc - optind - 1 : argc - optind,
 	     &error ) != 1 )
 	{
 		fprintf(
@@ -316,7 +540,12 @@ int main( int argc, char * const argv[] )
 	}
 #else
 	sources           = &( argv[ optind ] );
-	number_of_sources = argc - optind - 1;
+	number_of_sources = argc - optind;
+
+	if( mount_point != NULL )
+	{
+		number_of_sources -= 1;
+	}
 #endif
 
 	if( mount_handle_initialize(
@@ -350,6 +579,66 @@ int main( int argc, char * const argv[] )
 			 stderr,
 			 "Unsupported input format defaulting to: raw.\n" );
 		}
+		else if( ( option_socket != NULL )
+		      && ( ewfmount_mount_handle->input_format != MOUNT_HANDLE_INPUT_FORMAT_RAW ) )
+		{
+			fprintf(
+			 stderr,
+			 "Only the raw input format can be exported as network block device.\n" );
+
+			goto on_error;
+		}
+		else if( ( separate_images != 0 )
+		      && ( ewfmount_mount_handle->input_format != MOUNT_HANDLE_INPUT_FORMAT_RAW ) )
+		{
+			fprintf(
+			 stderr,
+			 "Only the raw input format is supported for multiple images.\n" );
+
+			goto on_error;
+		}
+	}
+	if( separate_images != 0 )
+	{
+		if( mount_handle_set_separate_images(
+		     ewfmount_mount_handle,
+		     1,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set separate images.\n" );
+
+			goto on_error;
+		}
+		if( chunk_cache_size != 0 )
+		{
+			if( mount_handle_set_maximum_chunk_cache_size(
+			     ewfmount_mount_handle,
+			     (size64_t) chunk_cache_size,
+			     &error ) != 1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to set maximum chunk cache size.\n" );
+
+				goto on_error;
+			}
+		}
+	}
+	if( read_ahead_size != 0 )
+	{
+		if( mount_handle_set_read_ahead_size(
+		     ewfmount_mount_handle,
+		     (size64_t) read_ahead_size,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set read ahead size.\n" );
+
+			goto on_error;
+		}
 	}
 #if defined( HAVE_GETRLIMIT )
 	if( getrlimit(
@@ -401,6 +690,36 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	if( option_overlay_file != NULL )
+	{
+		if( mount_handle_set_overlay_filename(
+		     ewfmount_mount_handle,
+		     option_overlay_file,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set overlay filename.\n" );
+
+			goto on_error;
+		}
+	}
+#if !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( option_access_map_file != NULL )
+	{
+		if( mount_handle_set_access_map_filename(
+		     ewfmount_mount_handle,
+		     option_access_map_file,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set access map filename.\n" );
+
+			goto on_error;
+		}
+	}
+#endif
 	if( mount_handle_open(
 	     ewfmount_mount_handle,
 	     sources,
@@ -425,14 +744,138 @@ int main( int argc, char * const argv[] )
 		goto on_error;
 	}
 #endif
+#if defined( HAVE_MOUNT_NBD )
+	if( option_socket != NULL )
+	{
+		if( mount_nbd_server_initialize(
+		     &ewfmount_nbd_server,
+		     ewfmount_mount_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to initialize NBD server.\n" );
+
+			goto on_error;
+		}
+		if( mount_nbd_server_open(
+		     ewfmount_nbd_server,
+		     option_socket,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to open NBD server on socket: %" PRIs_SYSTEM ".\n",
+			 option_socket );
+
+			goto on_error;
+		}
+		if( ewftools_signal_attach(
+		     ewfmount_signal_handler,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to attach signal handler.\n" );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+		fprintf(
+		 stdout,
+		 "Serving media data on socket: %" PRIs_SYSTEM "\n",
+		 option_socket );
+
+		if( mount_nbd_server_run(
+		     ewfmount_nbd_server,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to run NBD server.\n" );
+
+			goto on_error;
+		}
+		if( ewftools_signal_detach(
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to detach signal handler.\n" );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+		if( mount_nbd_server_free(
+		     &ewfmount_nbd_server,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to free NBD server.\n" );
+
+			goto on_error;
+		}
+		if( mount_handle_free(
+		     &ewfmount_mount_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to free mount handle.\n" );
+
+			goto on_error;
+		}
+		return( EXIT_SUCCESS );
+	}
+#endif /* defined( HAVE_MOUNT_NBD ) */
+
 #if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBOSXFUSE )
+	/* This argument is required but ignored
+	 */
+	if( fuse_opt_add_arg(
+	     &ewfmount_fuse_arguments,
+	     "" ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable add fuse arguments.\n" );
+
+		goto on_error;
+	}
+	/* The mounted data does not change, hence the attributes and directory entries
+	 * can be cached by the kernel. These options precede the extended options
+	 * so they can be overridden.
+	 */
+	if( fuse_opt_add_arg(
+	     &ewfmount_fuse_arguments,
+	     "-o" ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable add fuse arguments.\n" );
+
+		goto on_error;
+	}
+	if( fuse_opt_add_arg(
+	     &ewfmount_fuse_arguments,
+	     "attr_timeout=86400,entry_timeout=86400,negative_timeout=86400" ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable add fuse arguments.\n" );
+
+		goto on_error;
+	}
 	if( option_extended_options != NULL )
 	{
-		/* This argument is required but ignored
-		 */
 		if( fuse_opt_add_arg(
 		     &ewfmount_fuse_arguments,
-		     "" ) != 0 )
+		     "-o" ) != 0 )
 		{
 			fprintf(
 			 stderr,
@@ -440,6 +883,34 @@ int main( int argc, char * const argv[] )
 
 			goto on_error;
 		}
+		if( fuse_opt_add_arg(
+		     &ewfmount_fuse_arguments,
+		     option_extended_options ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable add fuse arguments.\n" );
+
+			goto on_error;
+		}
+	}
+	if( read_ahead_size != 0 )
+	{
+		/* The kernel read ahead is served by the multi-threaded FUSE loop,
+		 * which allows the chunks to be read and unpacked in parallel
+		 */
+		if( narrow_string_snprintf(
+		     fuse_read_ahead_options,
+		     64,
+		     "max_readahead=%" PRIu64 "",
+		     read_ahead_size ) < 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set fuse read ahead options.\n" );
+
+			goto on_error;
+		}
 		if( fuse_opt_add_arg(
 		     &ewfmount_fuse_arguments,
 		     "-o" ) != 0 )
@@ -452,7 +923,7 @@ int main( int argc, char * const argv[] )
 		}
 		if( fuse_opt_add_arg(
 		     &ewfmount_fuse_arguments,
-		     option_extended_options ) != 0 )
+		     fuse_read_ahead_options ) != 0 )
 		{
 			fprintf(
 			 stderr,
@@ -474,6 +945,7 @@ int main( int argc, char * const argv[] )
 	}
 	ewfmount_fuse_operations.open       = &mount_fuse_open;
 	ewfmount_fuse_operations.read       = &mount_fuse_read;
+	ewfmount_fuse_operations.write      = &mount_fuse_write;
 	ewfmount_fuse_operations.release    = &mount_fuse_release;
 	ewfmount_fuse_operations.opendir    = &mount_fuse_opendir;
 	ewfmount_fuse_operations.readdir    = &mount_fuse_readdir;
@@ -481,6 +953,10 @@ int main( int argc, char * const argv[] )
 	ewfmount_fuse_operations.getattr    = &mount_fuse_getattr;
 	ewfmount_fuse_operations.destroy    = &mount_fuse_destroy;
 
+#if ( FUSE_USE_VERSION >= 35 )
+	ewfmount_fuse_operations.lseek      = &mount_fuse_lseek;
+#endif
+
 	ewfmount_fuse_channel = fuse_mount(
 	                         mount_point,
 	                         &ewfmount_fuse_arguments );
@@ -520,8 +996,13 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	result = fuse_loop_mt(
+	          ewfmount_fuse_handle );
+#else
 	result = fuse_loop(
 	          ewfmount_fuse_handle );
+#endif
 
 	if( result != 0 )
 	{
@@ -563,7 +1044,7 @@ int main( int argc, char * const argv[] )
 		goto on_error;
 	}
 	ewfmount_dokan_options.Version     = DOKAN_VERSION;
-	ewfmount_dokan_options.ThreadCount = 0;
+	ewfmount_dokan_options.ThreadCount = (USHORT) number_of_threads;
 	ewfmount_dokan_options.MountPoint  = mount_point;
 
 	if( verbose != 0 )
@@ -714,6 +1195,14 @@ on_error:
 	}
 	fuse_opt_free_args(
 	 &ewfmount_fuse_arguments );
+#endif
+#if defined( HAVE_MOUNT_NBD )
+	if( ewfmount_nbd_server != NULL )
+	{
+		mount_nbd_server_free(
+		 &ewfmount_nbd_server,
+		 NULL );
+	}
 #endif
 	if( ewfmount_mount_handle != NULL )
 	{
@@ -79,7 +79,7 @@ void usage_fprint(
 	fprintf( stream, "Usage: ewfrecover [ -A codepage ]\n"
 	                 "                  [ -l log_filename ]\n"
 	                 "                  [ -p process_buffer_size ]\n"
-	                 "                  [ -t target ] [ -hquvVx ] ewf_files\n\n" );
+	                 "                  [ -t target ] [ -hqRuvVx ] ewf_files\n\n" );
 
 	fprintf( stream, "\tewf_files: the first or the entire set of EWF segment files\n\n" );
 
@@ -93,6 +93,9 @@ void usage_fprint(
 	                 "\t           log_filename\n" );
 	fprintf( stream, "\t-p:        specify the process buffer size (default is the chunk size)\n" );
 	fprintf( stream, "\t-q:        quiet shows minimal status information\n" );
+	fprintf( stream, "\t-R:        rebuild the EWF files in place instead of recovering to a\n"
+	                 "\t           target, the last segment file is truncated after its last\n"
+	                 "\t           intact chunks and the chunks are not copied (ignores -t)\n" );
 	fprintf( stream, "\t-t:        specify the target file to recover to (default is recover)\n" );
 	fprintf( stream, "\t-v:        verbose output to stderr\n" );
 	fprintf( stream, "\t-V:        print version\n" );
@@ -169,6 +172,7 @@ int main( int argc, char * const argv[] )
 	system_integer_t option                        = 0;
 	uint8_t calculate_md5                          = 1;
 	uint8_t print_status_information               = 1;
+	uint8_t rebuild_input                          = 0;
 	uint8_t use_chunk_data_functions               = 0;
 	uint8_t verbose                                = 0;
 	int number_of_filenames                        = 0;
@@ -238,7 +242,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "A:f:hl:p:qt:vVx" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "A:f:hl:p:qRt:vVx" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -288,6 +292,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'R':
+				rebuild_input = 1;
+
+				break;
+
 			case (system_integer_t) 't':
 				option_target_path = optarg;
 
@@ -456,18 +465,6 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
-#if !defined( HAVE_GLOB_H )
-	if( ewftools_glob_free(
-	     &glob,
-	     &error ) != 1 )
-	{
-		fprintf(
-		 stderr,
-		 "Unable to free glob.\n" );
-
-		goto on_error;
-	}
-#endif
 	result = export_handle_input_is_corrupted(
 	          ewfrecover_export_handle,
 	          &error );
@@ -488,6 +485,53 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	if( rebuild_input != 0 )
+	{
+		/* Reopen the input to resume writing after the last intact chunks
+		 */
+		if( export_handle_close(
+		     ewfrecover_export_handle,
+		     &error ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to close EWF file(s).\n" );
+
+			goto on_error;
+		}
+		ewfrecover_export_handle->rebuild_input = 1;
+
+		result = export_handle_open_input(
+		          ewfrecover_export_handle,
+		          source_filenames,
+		          number_of_filenames,
+		          &error );
+
+		if( ewfrecover_abort != 0 )
+		{
+			goto on_abort;
+		}
+		if( result != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to rebuild EWF file(s) in place, recover to a target instead.\n" );
+
+			goto on_error;
+		}
+	}
+#if !defined( HAVE_GLOB_H )
+	if( ewftools_glob_free(
+	     &glob,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free glob.\n" );
+
+		goto on_error;
+	}
+#endif
 	ewfrecover_export_handle->output_format = EXPORT_HANDLE_OUTPUT_FORMAT_EWF;
 	ewfrecover_export_handle->export_size   = ewfrecover_export_handle->input_media_size;
 
@@ -513,59 +557,62 @@ int main( int argc, char * const argv[] )
 			 "Unsupported header codepage defaulting to: ascii.\n" );
 		}
 	}
-	if( option_target_path != NULL )
+	if( rebuild_input == 0 )
 	{
-		if( export_handle_set_string(
-		     ewfrecover_export_handle,
-		     option_target_path,
-		     &( ewfrecover_export_handle->target_path ),
-		     &( ewfrecover_export_handle->target_path_size ),
-		     &error ) != 1 )
+		if( option_target_path != NULL )
 		{
-			fprintf(
-			 stderr,
-			 "Unable to set target path.\n" );
+			if( export_handle_set_string(
+			     ewfrecover_export_handle,
+			     option_target_path,
+			     &( ewfrecover_export_handle->target_path ),
+			     &( ewfrecover_export_handle->target_path_size ),
+			     &error ) != 1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to set target path.\n" );
 
-			goto on_error;
+				goto on_error;
+			}
 		}
-	}
-	else
-	{
-		/* Make sure the target filename is set
+		else
+		{
+			/* Make sure the target filename is set
+			 */
+			if( export_handle_set_string(
+			     ewfrecover_export_handle,
+			     _SYSTEM_STRING( "recover" ),
+			     &( ewfrecover_export_handle->target_path ),
+			     &( ewfrecover_export_handle->target_path_size ),
+			     &error ) != 1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to set target filename.\n" );
+
+				goto on_error;
+			}
+		}
+		/* Make sure we can write the target file
 		 */
-		if( export_handle_set_string(
+		if( export_handle_check_write_access(
 		     ewfrecover_export_handle,
-		     _SYSTEM_STRING( "recover" ),
-		     &( ewfrecover_export_handle->target_path ),
-		     &( ewfrecover_export_handle->target_path_size ),
+		     ewfrecover_export_handle->target_path,
 		     &error ) != 1 )
 		{
-			fprintf(
-			 stderr,
-			 "Unable to set target filename.\n" );
-
-			goto on_error;
-		}
-	}
-	/* Make sure we can write the target file
-	 */
-	if( export_handle_check_write_access(
-	     ewfrecover_export_handle,
-	     ewfrecover_export_handle->target_path,
-	     &error ) != 1 )
-	{
 #if defined( HAVE_VERBOSE_OUTPUT )
-		libcnotify_print_error_backtrace(
-		 error );
+			libcnotify_print_error_backtrace(
+			 error );
 #endif
-		libcerror_error_free(
-		 &error );
+			libcerror_error_free(
+			 &error );
 
-		fprintf(
-		 stdout,
-		 "Unable to write target file.\n" );
+			fprintf(
+			 stdout,
+			 "Unable to write target file.\n" );
 
-		goto on_error;
+			goto on_error;
+		}
 	}
 	if( option_process_buffer_size != NULL )
 	{
@@ -619,56 +666,67 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
-	if( export_handle_open_output(
-	     ewfrecover_export_handle,
-	     ewfrecover_export_handle->target_path,
-	     &error ) != 1 )
+	if( rebuild_input != 0 )
 	{
-		fprintf(
-		 stderr,
-		 "Unable to open output.\n" );
-
-		goto on_error;
+		result = export_handle_rebuild_input(
+			  ewfrecover_export_handle,
+			  print_status_information,
+			  log_handle,
+			  &error );
 	}
-	if( platform_get_operating_system(
-	     acquiry_operating_system,
-	     32,
-	     &error ) != 1 )
+	else
 	{
-		fprintf(
-		 stderr,
-		 "Unable to determine operating system.\n" );
+		if( export_handle_open_output(
+		     ewfrecover_export_handle,
+		     ewfrecover_export_handle->target_path,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to open output.\n" );
 
-		libcnotify_print_error_backtrace(
-		 error );
-		libcerror_error_free(
-		 &error );
+			goto on_error;
+		}
+		if( platform_get_operating_system(
+		     acquiry_operating_system,
+		     32,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to determine operating system.\n" );
 
-		acquiry_operating_system[ 0 ] = 0;
-	}
-	acquiry_software_version = _SYSTEM_STRING( LIBEWF_VERSION_STRING );
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
 
-	if( export_handle_set_output_values(
-	     ewfrecover_export_handle,
-	     acquiry_operating_system,
-	     program,
-	     acquiry_software_version,
-	     0,
-	     1,
-	     &error ) != 1 )
-	{
-		fprintf(
-		 stderr,
-		 "Unable to set output values.\n" );
+			acquiry_operating_system[ 0 ] = 0;
+		}
+		acquiry_software_version = _SYSTEM_STRING( LIBEWF_VERSION_STRING );
 
-		goto on_error;
+		if( export_handle_set_output_values(
+		     ewfrecover_export_handle,
+		     acquiry_operating_system,
+		     program,
+		     acquiry_software_version,
+		     0,
+		     1,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set output values.\n" );
+
+			goto on_error;
+		}
+		result = export_handle_export_input(
+			  ewfrecover_export_handle,
+			  0,
+			  print_status_information,
+			  log_handle,
+			  &error );
 	}
-	result = export_handle_export_input(
-		  ewfrecover_export_handle,
-		  0,
-		  print_status_information,
-		  log_handle,
-		  &error );
 
 	if( result != 1 )
 	{
@@ -277,3 +277,145 @@ void ewftools_output_version_detailed_fprint(
 	 ")\n\n" );
 }
 
+/* Prints the IO and cache statistics of a handle
+ * Returns 1 if successful or -1 on error
+ */
+int ewftools_output_statistics_fprint(
+     FILE *stream,
+     libewf_handle_t *handle,
+     libcerror_error_t **error )
+{
+	uint64_t values[ 28 ];
+
+	static char *function = "ewftools_output_statistics_fprint";
+	int statistic_index   = 0;
+
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	/* The statistic types are numbered from 1
+	 */
+	for( statistic_index = 0;
+	     statistic_index < 28;
+	     statistic_index++ )
+	{
+		if( libewf_handle_get_statistics_value(
+		     handle,
+		     LIBEWF_STATISTIC_SEGMENT_FILE_READ_SIZE + statistic_index,
+		     &( values[ statistic_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve statistic: %d.",
+			 function,
+			 LIBEWF_STATISTIC_SEGMENT_FILE_READ_SIZE + statistic_index );
+
+			return( -1 );
+		}
+	}
+	fprintf(
+	 stream,
+	 "Statistics\n" );
+
+	fprintf(
+	 stream,
+	 "\tSegment file reads:\t\t%" PRIu64 " (%" PRIu64 " bytes) in %" PRIu64 " ms\n",
+	 values[ LIBEWF_STATISTIC_SEGMENT_FILE_NUMBER_OF_READS - 1 ],
+	 values[ LIBEWF_STATISTIC_SEGMENT_FILE_READ_SIZE - 1 ],
+	 values[ LIBEWF_STATISTIC_SEGMENT_FILE_READ_TIME - 1 ] / 1000000 );
+
+	fprintf(
+	 stream,
+	 "\tDecompressed chunks:\t\t%" PRIu64 " in %" PRIu64 " ms\n",
+	 values[ LIBEWF_STATISTIC_NUMBER_OF_DECOMPRESSED_CHUNKS - 1 ],
+	 values[ LIBEWF_STATISTIC_DECOMPRESSION_TIME - 1 ] / 1000000 );
+
+	fprintf(
+	 stream,
+	 "\tVerified checksums:\t\t%" PRIu64 " in %" PRIu64 " ms\n",
+	 values[ LIBEWF_STATISTIC_NUMBER_OF_VERIFIED_CHECKSUMS - 1 ],
+	 values[ LIBEWF_STATISTIC_CHECKSUM_TIME - 1 ] / 1000000 );
+
+	fprintf(
+	 stream,
+	 "\tChunks cache:\t\t\t%" PRIu64 " hits, %" PRIu64 " misses\n",
+	 values[ LIBEWF_STATISTIC_CHUNKS_CACHE_HITS - 1 ],
+	 values[ LIBEWF_STATISTIC_CHUNKS_CACHE_MISSES - 1 ] );
+
+	fprintf(
+	 stream,
+	 "\tChunk cache:\t\t\t%" PRIu64 " hits, %" PRIu64 " misses, %" PRIu64 " evictions\n",
+	 values[ LIBEWF_STATISTIC_CHUNK_CACHE_HITS - 1 ],
+	 values[ LIBEWF_STATISTIC_CHUNK_CACHE_MISSES - 1 ],
+	 values[ LIBEWF_STATISTIC_CHUNK_CACHE_EVICTIONS - 1 ] );
+
+	fprintf(
+	 stream,
+	 "\tChunk groups cache:\t\t%" PRIu64 " hits, %" PRIu64 " misses\n",
+	 values[ LIBEWF_STATISTIC_CHUNK_GROUPS_CACHE_HITS - 1 ],
+	 values[ LIBEWF_STATISTIC_CHUNK_GROUPS_CACHE_MISSES - 1 ] );
+
+	/* The memory sizes are only available if libewf was built with memory accounting
+	 */
+	if( ( values[ LIBEWF_STATISTIC_CHUNK_DATA_PEAK_MEMORY_SIZE - 1 ] != 0 )
+	 || ( values[ LIBEWF_STATISTIC_CHUNK_GROUP_PEAK_MEMORY_SIZE - 1 ] != 0 )
+	 || ( values[ LIBEWF_STATISTIC_SEGMENT_FILE_PEAK_MEMORY_SIZE - 1 ] != 0 )
+	 || ( values[ LIBEWF_STATISTIC_SINGLE_FILES_PEAK_MEMORY_SIZE - 1 ] != 0 )
+	 || ( values[ LIBEWF_STATISTIC_HEADER_VALUES_PEAK_MEMORY_SIZE - 1 ] != 0 ) )
+	{
+		fprintf(
+		 stream,
+		 "\n" );
+
+		fprintf(
+		 stream,
+		 "Memory (current / peak)\n" );
+
+		fprintf(
+		 stream,
+		 "\tChunk data:\t\t\t%" PRIu64 " / %" PRIu64 " bytes\n",
+		 values[ LIBEWF_STATISTIC_CHUNK_DATA_MEMORY_SIZE - 1 ],
+		 values[ LIBEWF_STATISTIC_CHUNK_DATA_PEAK_MEMORY_SIZE - 1 ] );
+
+		fprintf(
+		 stream,
+		 "\tChunk groups:\t\t\t%" PRIu64 " / %" PRIu64 " bytes\n",
+		 values[ LIBEWF_STATISTIC_CHUNK_GROUP_MEMORY_SIZE - 1 ],
+		 values[ LIBEWF_STATISTIC_CHUNK_GROUP_PEAK_MEMORY_SIZE - 1 ] );
+
+		fprintf(
+		 stream,
+		 "\tSegment files:\t\t\t%" PRIu64 " / %" PRIu64 " bytes\n",
+		 values[ LIBEWF_STATISTIC_SEGMENT_FILE_MEMORY_SIZE - 1 ],
+		 values[ LIBEWF_STATISTIC_SEGMENT_FILE_PEAK_MEMORY_SIZE - 1 ] );
+
+		fprintf(
+		 stream,
+		 "\tSingle files:\t\t\t%" PRIu64 " / %" PRIu64 " bytes\n",
+		 values[ LIBEWF_STATISTIC_SINGLE_FILES_MEMORY_SIZE - 1 ],
+		 values[ LIBEWF_STATISTIC_SINGLE_FILES_PEAK_MEMORY_SIZE - 1 ] );
+
+		fprintf(
+		 stream,
+		 "\tHeader values:\t\t\t%" PRIu64 " / %" PRIu64 " bytes\n",
+		 values[ LIBEWF_STATISTIC_HEADER_VALUES_MEMORY_SIZE - 1 ],
+		 values[ LIBEWF_STATISTIC_HEADER_VALUES_PEAK_MEMORY_SIZE - 1 ] );
+	}
+	fprintf(
+	 stream,
+	 "\n" );
+
+	return( 1 );
+}
+
@@ -27,6 +27,7 @@
 #include <types.h>
 
 #include "ewftools_libcerror.h"
+#include "ewftools_libewf.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -47,6 +48,11 @@ void ewftools_output_version_detailed_fprint(
       FILE *stream,
       const system_character_t *program );
 
+int ewftools_output_statistics_fprint(
+     FILE *stream,
+     libewf_handle_t *handle,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -0,0 +1,90 @@
+/*
+ * Timestamp functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#include <time.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_timestamp.h"
+
+/* Retrieves a monotonic timestamp in nano seconds
+ * Returns 1 if successful or -1 on error
+ */
+int ewftools_timestamp_get_monotonic(
+     int64_t *timestamp,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	struct timespec time_structure;
+#endif
+
+	static char *function = "ewftools_timestamp_get_monotonic";
+
+	if( timestamp == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid timestamp.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_structure ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time structure.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = ( (int64_t) time_structure.tv_sec * 1000000000 ) + time_structure.tv_nsec;
+
+#elif defined( WINAPI )
+	*timestamp = (int64_t) GetTickCount64() * 1000000;
+#else
+	*timestamp = (int64_t) time( NULL );
+
+	if( *timestamp == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp *= 1000000000;
+#endif
+	return( 1 );
+}
+
@@ -52,11 +52,16 @@
 #include "ewftools_libewf.h"
 #include "ewftools_output.h"
 #include "ewftools_signal.h"
+#include "ewftools_system_string.h"
 #include "ewftools_unused.h"
 #include "log_handle.h"
+#include "platform.h"
+#include "stats_output.h"
 #include "verification_handle.h"
+#include "verify_batch.h"
 
 verification_handle_t *ewfverify_verification_handle = NULL;
+verify_batch_t *ewfverify_verify_batch               = NULL;
 int ewfverify_abort                                  = 0;
 
 /* Prints the executable usage information to the stream
@@ -71,29 +76,83 @@ void usage_fprint(
 	fprintf( stream, "Use ewfverify to verify data stored in the EWF format (Expert Witness\n"
 	                 "Compression Format).\n\n" );
 
-	fprintf( stream, "Usage: ewfverify [ -A codepage ] [ -d digest_type ] [ -f format ]\n"
-	                 "                 [ -j jobs ] [ -l log_filename ] [ -p process_buffer_size ]\n"
-	                 "                 [ -hqvVwx ] ewf_files\n\n" );
+	fprintf( stream, "Usage: ewfverify [ -A codepage ] [ -C compare_file ] [ -d digest_type ]\n"
+	                 "                 [ -D readers_per_device ] [ -f format ]\n"
+	                 "                 [ -g segment_ledger_file ] [ -j jobs ]\n"
+	                 "                 [ -J file_descriptor ] [ -K checkpoint_file ]\n"
+	                 "                 [ -l log_filename ] [ -L rate_limit ]\n"
+	                 "                 [ -p process_buffer_size ] [ -P sample_percentage ]\n"
+	                 "                 [ -r range_digests_file ] [ -S scrub_state_file ]\n"
+	                 "                 [ -bchHiqRsvVwx ] ewf_files\n\n" );
 
-	fprintf( stream, "\tewf_files: the first or the entire set of EWF segment files\n\n" );
+	fprintf( stream, "\tewf_files: the first or the entire set of EWF segment files, in\n"
+	                 "\t           batch mode (-b) or when scrubbing (-S) the first segment\n"
+	                 "\t           file of every image\n\n" );
 
 	fprintf( stream, "\t-A:        codepage of header section, options: ascii (default),\n"
 	                 "\t           windows-874, windows-932, windows-936, windows-949,\n"
 	                 "\t           windows-950, windows-1250, windows-1251, windows-1252,\n"
 	                 "\t           windows-1253, windows-1254, windows-1255, windows-1256,\n"
 	                 "\t           windows-1257 or windows-1258\n" );
+	fprintf( stream, "\t-b:        batch mode, verify multiple images, the images are grouped\n"
+	                 "\t           by the storage device they are stored on and the jobs (-j)\n"
+	                 "\t           are shared by all images\n" );
+	fprintf( stream, "\t-c:        only verify the checksums of the chunks, the digest (hash)\n"
+	                 "\t           of the media data is not calculated\n" );
+	fprintf( stream, "\t-C:        compare the media data in parallel with that of the image\n"
+	                 "\t           of which compare_file is the first segment file, chunks\n"
+	                 "\t           of which the stored data is identical are not decompressed,\n"
+	                 "\t           the digest (hash) of the entire media data is only\n"
+	                 "\t           calculated if additional digest types are specified\n" );
 	fprintf( stream, "\t-d:        calculate additional digest (hash) types besides md5,\n"
 	                 "\t           options: sha1, sha256\n" );
+	fprintf( stream, "\t-D:        the maximum number of images that are read concurrently\n"
+	                 "\t           from the same storage device in batch mode (default is 1)\n" );
 	fprintf( stream, "\t-f:        specify the input format, options: raw (default),\n"
 	                 "\t           files (restricted to logical volume files)\n" );
+	fprintf( stream, "\t-g:        record the result of the verification per segment file in\n"
+	                 "\t           segment_ledger_file, a later verification only reads the\n"
+	                 "\t           segment files of which the size, modification time or\n"
+	                 "\t           section descriptors changed and a random sample (-P) of\n"
+	                 "\t           the other segment files, the digest (hash) of the entire\n"
+	                 "\t           media data is carried forward from the ledger\n" );
 	fprintf( stream, "\t-h:        shows this help\n" );
+	fprintf( stream, "\t-H:        use huge pages for the chunk data and storage media\n"
+	                 "\t           buffers, falls back to normal pages if not available\n" );
+	fprintf( stream, "\t-i:        use the idle I/O priority class, such that the image is only\n"
+	                 "\t           read when no other process needs the storage\n" );
 	fprintf( stream, "\t-j:        the number of concurrent processing jobs (threads), where\n"
 	                 "\t           a number of 0 represents single-threaded mode (default is 4\n"
 	                 "\t           if multi-threaded mode is supported)\n" );
+	fprintf( stream, "\t-J:        write the progress and the throughput per stage (read,\n"
+	                 "\t           process and hash) as JSON lines to the file_descriptor\n" );
+	fprintf( stream, "\t-K:        periodically write the state of the digest (hash) calculations\n"
+	                 "\t           to the checkpoint_file, which allows an interrupted\n"
+	                 "\t           verification to be resumed with -R\n" );
 	fprintf( stream, "\t-l:        logs verification errors and the digest (hash) to the\n"
 	                 "\t           log_filename\n" );
+	fprintf( stream, "\t-L:        limit the read rate of the checksum verification (-c)\n"
+	                 "\t           and scrub (-S) in bytes per second, for example 50MiB\n" );
 	fprintf( stream, "\t-p:        specify the process buffer size (default is the chunk size)\n" );
+	fprintf( stream, "\t-P:        the percentage of the unchanged segment files that is\n"
+	                 "\t           re-verified using the segment ledger (-g) (default is 0)\n" );
 	fprintf( stream, "\t-q:        quiet shows minimal status information\n" );
+	fprintf( stream, "\t-R:        resume the verification at the last checkpoint in the\n"
+	                 "\t           checkpoint_file (-K)\n" );
+	fprintf( stream, "\t-r:        verify the ranges of the media data in parallel using\n"
+	                 "\t           the range digests in range_digests_file, the digest\n"
+	                 "\t           (hash) of the entire media data is only calculated\n"
+	                 "\t           if additional digest types are specified\n" );
+	fprintf( stream, "\t-S:        scrub the images by validating the checksums of their chunks,\n"
+	                 "\t           sections and tables, the images are scrubbed in turns\n"
+	                 "\t           of a slice of their media data, damaged chunks are\n"
+	                 "\t           reported as soon as they are found and the progress\n"
+	                 "\t           is stored in scrub_state_file such that an interrupted\n"
+	                 "\t           scrub continues where it left off\n" );
+	fprintf( stream, "\t-s:        verify the single files using the digests (hashes) stored\n"
+	                 "\t           per file, the files are verified in parallel and the\n"
+	                 "\t           data of duplicate files is only read once (only applies\n"
+	                 "\t           to the files input format)\n" );
 	fprintf( stream, "\t-v:        verbose output to stderr\n" );
 	fprintf( stream, "\t-V:        print version\n" );
 	fprintf( stream, "\t-w:        zero sectors on checksum error (mimic EnCase like behavior)\n" );
@@ -113,6 +172,22 @@ void ewfverify_signal_handler(
 
 	ewfverify_abort = 1;
 
+	if( ewfverify_verify_batch != NULL )
+	{
+		if( verify_batch_signal_abort(
+		     ewfverify_verify_batch,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal verify batch to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
 	if( ewfverify_verification_handle != NULL )
 	{
 		if( verification_handle_signal_abort(
@@ -162,15 +237,34 @@ int main( int argc, char * const argv[] )
 	log_handle_t *log_handle                           = NULL;
 	system_character_t *log_filename                   = NULL;
 	system_character_t *option_additional_digest_types = NULL;
+	system_character_t *option_checkpoint_filename     = NULL;
+	system_character_t *option_compare_filename        = NULL;
 	system_character_t *option_format                  = NULL;
 	system_character_t *option_header_codepage         = NULL;
 	system_character_t *option_number_of_jobs          = NULL;
 	system_character_t *option_process_buffer_size     = NULL;
+	system_character_t *option_range_digests_filename  = NULL;
+	system_character_t *option_readers_per_device      = NULL;
+	system_character_t *option_sample_percentage       = NULL;
+	system_character_t *option_rate_limit              = NULL;
+	system_character_t *option_scrub_state_filename    = NULL;
+	system_character_t *option_segment_ledger_filename = NULL;
+	system_character_t *option_stats_file_descriptor   = NULL;
 	system_character_t *program                        = _SYSTEM_STRING( "ewfverify" );
+	stats_output_t *stats_output                       = NULL;
 	system_integer_t option                            = 0;
+	size_t string_length                               = 0;
+	uint64_t sample_percentage                         = 0;
+	uint64_t stats_file_descriptor                     = 0;
+	uint8_t batch_mode                                 = 0;
 	uint8_t calculate_md5                              = 1;
+	uint8_t checksums_only                             = 0;
+	uint8_t idle_io_priority                           = 0;
 	uint8_t print_status_information                   = 1;
+	uint8_t resume_verification                        = 0;
+	uint8_t stored_hashes_only                         = 0;
 	uint8_t use_chunk_data_functions                   = 0;
+	uint8_t use_huge_pages                             = 0;
 	uint8_t verbose                                    = 0;
 	uint8_t zero_chunk_on_error                        = 0;
 	int number_of_filenames                            = 0;
@@ -213,7 +307,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "A:d:f:j:hl:p:qvVwx" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "A:bcC:d:D:f:g:ij:J:hHK:l:L:p:P:qr:RsS:vVwx" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -234,42 +328,117 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'b':
+				batch_mode = 1;
+
+				break;
+
+			case (system_integer_t) 'c':
+				checksums_only = 1;
+
+				break;
+
+			case (system_integer_t) 'C':
+				option_compare_filename = optarg;
+
+				break;
+
 			case (system_integer_t) 'd':
 				option_additional_digest_types = optarg;
 
 				break;
 
+			case (system_integer_t) 'D':
+				option_readers_per_device = optarg;
+
+				break;
+
 			case (system_integer_t) 'f':
 				option_format = optarg;
 
 				break;
 
+			case (system_integer_t) 'g':
+				option_segment_ledger_filename = optarg;
+
+				break;
+
 			case (system_integer_t) 'h':
 				usage_fprint(
 				 stdout );
 
 				return( EXIT_SUCCESS );
 
+			case (system_integer_t) 'H':
+				use_huge_pages = 1;
+
+				break;
+
+			case (system_integer_t) 'i':
+				idle_io_priority = 1;
+
+				break;
+
 			case (system_integer_t) 'j':
 				option_number_of_jobs = optarg;
 
 				break;
 
+			case (system_integer_t) 'J':
+				option_stats_file_descriptor = optarg;
+
+				break;
+
+			case (system_integer_t) 'K':
+				option_checkpoint_filename = optarg;
+
+				break;
+
 			case (system_integer_t) 'l':
 				log_filename = optarg;
 
 				break;
 
+			case (system_integer_t) 'L':
+				option_rate_limit = optarg;
+
+				break;
+
 			case (system_integer_t) 'p':
 				option_process_buffer_size = optarg;
 
 				break;
 
+			case (system_integer_t) 'P':
+				option_sample_percentage = optarg;
+
+				break;
+
 			case (system_integer_t) 'q':
 				print_status_information = 0;
 
 				break;
 
+			case (system_integer_t) 'r':
+				option_range_digests_filename = optarg;
+
+				break;
+
+			case (system_integer_t) 'R':
+				resume_verification = 1;
+
+				break;
+
+			case (system_integer_t) 's':
+				stored_hashes_only = 1;
+
+				break;
+
+			case (system_integer_t) 'S':
+				option_scrub_state_filename = optarg;
+
+				break;
+
 			case (system_integer_t) 'v':
 				verbose = 1;
 
@@ -313,6 +482,32 @@ int main( int argc, char * const argv[] )
 	 stderr,
 	 NULL );
 #endif
+	/* The I/O priority is set before any threads are created
+	 * so that the threads inherit it
+	 */
+	if( idle_io_priority != 0 )
+	{
+		result = platform_set_idle_io_priority(
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set idle I/O priority.\n" );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Idle I/O priority not supported on this platform.\n" );
+		}
+	}
 	if( verification_handle_initialize(
 	     &ewfverify_verification_handle,
 	     calculate_md5,
@@ -325,6 +520,144 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	if( option_stats_file_descriptor != NULL )
+	{
+		string_length = system_string_length(
+		                 option_stats_file_descriptor );
+
+		if( ( ewftools_system_string_decimal_copy_to_64_bit(
+		       option_stats_file_descriptor,
+		       string_length + 1,
+		       &stats_file_descriptor,
+		       &error ) != 1 )
+		 || ( stats_file_descriptor > (uint64_t) INT_MAX ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported statistics file descriptor.\n" );
+
+			goto on_error;
+		}
+		if( stats_output_initialize(
+		     &stats_output,
+		     "ewfverify",
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to create statistics output.\n" );
+
+			goto on_error;
+		}
+		if( stats_output_open_file_descriptor(
+		     stats_output,
+		     (int) stats_file_descriptor,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to open statistics output.\n" );
+
+			goto on_error;
+		}
+		ewfverify_verification_handle->stats_output = stats_output;
+	}
+	ewfverify_verification_handle->use_huge_pages = use_huge_pages;
+
+	if( option_checkpoint_filename != NULL )
+	{
+		if( verification_handle_set_restart_checkpoint_filename(
+		     ewfverify_verification_handle,
+		     option_checkpoint_filename,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set restart checkpoint filename.\n" );
+
+			goto on_error;
+		}
+		ewfverify_verification_handle->resume = resume_verification;
+	}
+	else if( resume_verification != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Resume requires a checkpoint file (-K).\n" );
+
+		goto on_error;
+	}
+	if( ( option_scrub_state_filename != NULL )
+	 && ( ( option_compare_filename != NULL )
+	  || ( option_range_digests_filename != NULL )
+	  || ( option_checkpoint_filename != NULL ) ) )
+	{
+		fprintf(
+		 stderr,
+		 "Scrub (-S) cannot be combined with a compare file (-C), range digests file (-r)\n"
+		 "or checkpoint file (-K).\n" );
+
+		goto on_error;
+	}
+	if( ( batch_mode != 0 )
+	 && ( ( option_scrub_state_filename != NULL )
+	  || ( option_compare_filename != NULL )
+	  || ( option_range_digests_filename != NULL )
+	  || ( option_checkpoint_filename != NULL )
+	  || ( checksums_only != 0 ) ) )
+	{
+		fprintf(
+		 stderr,
+		 "Batch mode (-b) cannot be combined with scrub (-S), a compare file (-C),\n"
+		 "range digests file (-r), checkpoint file (-K) or checksums only (-c).\n" );
+
+		goto on_error;
+	}
+	if( ( option_segment_ledger_filename != NULL )
+	 && ( ( batch_mode != 0 )
+	  || ( option_scrub_state_filename != NULL )
+	  || ( option_compare_filename != NULL )
+	  || ( option_range_digests_filename != NULL )
+	  || ( option_checkpoint_filename != NULL )
+	  || ( option_additional_digest_types != NULL )
+	  || ( checksums_only != 0 ) ) )
+	{
+		fprintf(
+		 stderr,
+		 "Segment ledger (-g) cannot be combined with batch mode (-b), scrub (-S),\n"
+		 "a compare file (-C), range digests file (-r), checkpoint file (-K),\n"
+		 "additional digest types (-d) or checksums only (-c).\n" );
+
+		goto on_error;
+	}
+	if( option_sample_percentage != NULL )
+	{
+		if( option_segment_ledger_filename == NULL )
+		{
+			fprintf(
+			 stderr,
+			 "Sample percentage (-P) requires a segment ledger file (-g).\n" );
+
+			goto on_error;
+		}
+		string_length = system_string_length(
+		                 option_sample_percentage );
+
+		if( ( ewftools_system_string_decimal_copy_to_64_bit(
+		       option_sample_percentage,
+		       string_length + 1,
+		       &sample_percentage,
+		       &error ) != 1 )
+		 || ( sample_percentage > 100 ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported sample percentage.\n" );
+
+			goto on_error;
+		}
+	}
+
 	if( option_header_codepage != NULL )
 	{
 		result = verification_handle_set_header_codepage(
@@ -368,6 +701,33 @@ int main( int argc, char * const argv[] )
 			 stderr,
 			 "Unsupported input format defaulting to: raw.\n" );
 		}
+		if( ( option_scrub_state_filename != NULL )
+		 && ( ewfverify_verification_handle->input_format == VERIFICATION_HANDLE_INPUT_FORMAT_FILES ) )
+		{
+			fprintf(
+			 stderr,
+			 "Scrub (-S) does not support the files input format.\n" );
+
+			goto on_error;
+		}
+		if( ( batch_mode != 0 )
+		 && ( ewfverify_verification_handle->input_format == VERIFICATION_HANDLE_INPUT_FORMAT_FILES ) )
+		{
+			fprintf(
+			 stderr,
+			 "Batch mode (-b) does not support the files input format.\n" );
+
+			goto on_error;
+		}
+		if( ( option_segment_ledger_filename != NULL )
+		 && ( ewfverify_verification_handle->input_format == VERIFICATION_HANDLE_INPUT_FORMAT_FILES ) )
+		{
+			fprintf(
+			 stderr,
+			 "Segment ledger (-g) does not support the files input format.\n" );
+
+			goto on_error;
+		}
 	}
 	if( option_process_buffer_size != NULL )
 	{
@@ -429,6 +789,28 @@ int main( int argc, char * const argv[] )
 		 ewfverify_verification_handle->number_of_threads );
 #endif
 	}
+	if( option_rate_limit != NULL )
+	{
+		result = verification_handle_set_rate_limit(
+			  ewfverify_verification_handle,
+			  option_rate_limit,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set rate limit.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported rate limit defaulting to: unlimited.\n" );
+		}
+	}
 	if( option_additional_digest_types != NULL )
 	{
 		result = verification_handle_set_additional_digest_types(
@@ -445,6 +827,58 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( batch_mode != 0 )
+	{
+		if( verify_batch_initialize(
+		     &ewfverify_verify_batch,
+		     ewfverify_verification_handle,
+		     zero_chunk_on_error,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to create verify batch.\n" );
+
+			goto on_error;
+		}
+		if( option_readers_per_device != NULL )
+		{
+			result = verify_batch_set_maximum_number_of_readers_per_device(
+			          ewfverify_verify_batch,
+			          option_readers_per_device,
+			          &error );
+
+			if( result == -1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to set number of readers per device.\n" );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				fprintf(
+				 stderr,
+				 "Unsupported number of readers per device defaulting to: %d.\n",
+				 ewfverify_verify_batch->maximum_number_of_readers_per_device );
+			}
+		}
+		if( option_additional_digest_types != NULL )
+		{
+			if( verify_batch_set_additional_digest_types(
+			     ewfverify_verify_batch,
+			     option_additional_digest_types,
+			     &error ) != 1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to set additional digest types in verify batch.\n" );
+
+				goto on_error;
+			}
+		}
+	}
 #if !defined( HAVE_GLOB_H )
 	if( ewftools_glob_initialize(
 	     &glob,
@@ -513,6 +947,20 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	if( ewfverify_verify_batch != NULL )
+	{
+		if( verify_batch_set_maximum_number_of_open_handles(
+		     ewfverify_verify_batch,
+		     (int) limit_data.rlim_max,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set maximum number of open file handles in verify batch.\n" );
+
+			goto on_error;
+		}
+	}
 #endif
 	if( ewftools_signal_attach(
 	     ewfverify_signal_handler,
@@ -527,6 +975,169 @@ int main( int argc, char * const argv[] )
 		libcerror_error_free(
 		 &error );
 	}
+	if( log_filename != NULL )
+	{
+		if( log_handle_initialize(
+		     &log_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to create log handle.\n" );
+
+			goto on_error;
+		}
+		if( log_handle_open(
+		     log_handle,
+		     log_filename,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to open log file: %" PRIs_SYSTEM ".\n",
+			 log_filename );
+
+			goto on_error;
+		}
+	}
+	if( ewfverify_verify_batch != NULL )
+	{
+		result = verify_batch_process(
+		          ewfverify_verify_batch,
+		          source_filenames,
+		          number_of_filenames,
+		          log_handle,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to verify images.\n" );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+#if !defined( HAVE_GLOB_H )
+		if( ewftools_glob_free(
+		     &glob,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to free glob.\n" );
+
+			goto on_error;
+		}
+#endif
+		goto on_close_log;
+	}
+	if( option_scrub_state_filename != NULL )
+	{
+		result = verification_handle_scrub_images(
+		          ewfverify_verification_handle,
+		          source_filenames,
+		          number_of_filenames,
+		          option_scrub_state_filename,
+		          print_status_information,
+		          log_handle,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to scrub images.\n" );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+#if !defined( HAVE_GLOB_H )
+		if( ewftools_glob_free(
+		     &glob,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to free glob.\n" );
+
+			goto on_error;
+		}
+#endif
+		goto on_close_log;
+	}
+	if( option_segment_ledger_filename != NULL )
+	{
+		result = verification_handle_open_input(
+		          ewfverify_verification_handle,
+		          source_filenames,
+		          number_of_filenames,
+		          &error );
+
+		if( ewfverify_abort != 0 )
+		{
+			goto on_abort;
+		}
+		if( result != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to open EWF image file(s).\n" );
+
+			goto on_error;
+		}
+		if( verification_handle_set_zero_chunk_on_error(
+		     ewfverify_verification_handle,
+		     zero_chunk_on_error,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set zero on chunk error.\n" );
+
+			goto on_error;
+		}
+		/* The segment filenames are used to determine the identity of the segment files
+		 */
+		result = verification_handle_verify_segments(
+		          ewfverify_verification_handle,
+		          source_filenames,
+		          number_of_filenames,
+		          option_segment_ledger_filename,
+		          (int) sample_percentage,
+		          print_status_information,
+		          log_handle,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to verify segment files.\n" );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+#if !defined( HAVE_GLOB_H )
+		if( ewftools_glob_free(
+		     &glob,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to free glob.\n" );
+
+			goto on_error;
+		}
+#endif
+		goto on_close_log;
+	}
 	result = verification_handle_open_input(
 	          ewfverify_verification_handle,
 	          source_filenames,
@@ -545,6 +1156,26 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	if( option_compare_filename != NULL )
+	{
+		result = verification_handle_open_compare_input(
+		          ewfverify_verification_handle,
+		          option_compare_filename,
+		          &error );
+
+		if( ewfverify_abort != 0 )
+		{
+			goto on_abort;
+		}
+		if( result != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to open compared EWF image file(s).\n" );
+
+			goto on_error;
+		}
+	}
 #if !defined( HAVE_GLOB_H )
 	if( ewftools_glob_free(
 	     &glob,
@@ -568,39 +1199,24 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
-	if( log_filename != NULL )
+	if( ewfverify_verification_handle->input_format == VERIFICATION_HANDLE_INPUT_FORMAT_FILES )
 	{
-		if( log_handle_initialize(
-		     &log_handle,
-		     &error ) != 1 )
+		if( stored_hashes_only != 0 )
 		{
-			fprintf(
-			 stderr,
-			 "Unable to create log handle.\n" );
-
-			goto on_error;
+			result = verification_handle_verify_single_files_stored_hashes(
+			          ewfverify_verification_handle,
+			          print_status_information,
+			          log_handle,
+			          &error );
 		}
-		if( log_handle_open(
-		     log_handle,
-		     log_filename,
-		     &error ) != 1 )
+		else
 		{
-			fprintf(
-			 stderr,
-			 "Unable to open log file: %" PRIs_SYSTEM ".\n",
-			 log_filename );
-
-			goto on_error;
+			result = verification_handle_verify_single_files(
+			          ewfverify_verification_handle,
+			          print_status_information,
+			          log_handle,
+			          &error );
 		}
-	}
-	if( ewfverify_verification_handle->input_format == VERIFICATION_HANDLE_INPUT_FORMAT_FILES )
-	{
-		result = verification_handle_verify_single_files(
-		          ewfverify_verification_handle,
-		          print_status_information,
-		          log_handle,
-		          &error );
-
 		if( result != 1 )
 		{
 			fprintf(
@@ -615,24 +1231,88 @@ int main( int argc, char * const argv[] )
 	}
 	else
 	{
-		result = verification_handle_verify_input(
-		          ewfverify_verification_handle,
-		          print_status_information,
-		          log_handle,
-		          &error );
+		if( option_range_digests_filename != NULL )
+		{
+			result = verification_handle_verify_ranges(
+			          ewfverify_verification_handle,
+			          option_range_digests_filename,
+			          print_status_information,
+			          log_handle,
+			          &error );
+
+			if( result == -1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to verify ranges.\n" );
 
-		if( result == -1 )
+				libcnotify_print_error_backtrace(
+				 error );
+				libcerror_error_free(
+				 &error );
+			}
+		}
+		if( ( option_compare_filename != NULL )
+		 && ( ( option_range_digests_filename == NULL )
+		  || ( result == 1 ) ) )
 		{
-			fprintf(
-			 stderr,
-			 "Unable to verify input.\n" );
+			result = verification_handle_compare_input(
+			          ewfverify_verification_handle,
+			          print_status_information,
+			          log_handle,
+			          &error );
+
+			if( result == -1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to compare input.\n" );
 
-			libcnotify_print_error_backtrace(
-			 error );
-			libcerror_error_free(
-			 &error );
+				libcnotify_print_error_backtrace(
+				 error );
+				libcerror_error_free(
+				 &error );
+			}
+		}
+		/* The digest (hash) of the entire media data is calculated when
+		 * no range digests or compared image are used or additional digest
+		 * types were specified
+		 */
+		if( ( ( option_range_digests_filename == NULL )
+		  && ( option_compare_filename == NULL ) )
+		 || ( ( result == 1 )
+		  && ( option_additional_digest_types != NULL ) ) )
+		{
+			if( checksums_only != 0 )
+			{
+				result = verification_handle_verify_chunks(
+				          ewfverify_verification_handle,
+				          print_status_information,
+				          log_handle,
+				          &error );
+			}
+			else
+			{
+				result = verification_handle_verify_input(
+				          ewfverify_verification_handle,
+				          print_status_information,
+				          log_handle,
+				          &error );
+			}
+			if( result == -1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to verify input.\n" );
+
+				libcnotify_print_error_backtrace(
+				 error );
+				libcerror_error_free(
+				 &error );
+			}
 		}
 	}
+on_close_log:
 	if( log_handle != NULL )
 	{
 		if( log_handle_close(
@@ -680,6 +1360,19 @@ on_abort:
 		goto on_error;
 
 	}
+	if( ewfverify_verify_batch != NULL )
+	{
+		if( verify_batch_free(
+		     &ewfverify_verify_batch,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to free verify batch.\n" );
+
+			goto on_error;
+		}
+	}
 	if( verification_handle_free(
 	     &ewfverify_verification_handle,
 	     &error ) != 1 )
@@ -690,6 +1383,19 @@ on_abort:
 
 		goto on_error;
 	}
+	if( stats_output != NULL )
+	{
+		if( stats_output_free(
+		     &stats_output,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to free statistics output.\n" );
+
+			goto on_error;
+		}
+	}
 	if( ewfverify_abort != 0 )
 	{
 		fprintf(
@@ -732,6 +1438,12 @@ on_error:
 		 &log_handle,
 		 NULL );
 	}
+	if( ewfverify_verify_batch != NULL )
+	{
+		verify_batch_free(
+		 &ewfverify_verify_batch,
+		 NULL );
+	}
 	if( ewfverify_verification_handle != NULL )
 	{
 		verification_handle_close(
@@ -741,6 +1453,12 @@ on_error:
 		 &ewfverify_verification_handle,
 		 NULL );
 	}
+	if( stats_output != NULL )
+	{
+		stats_output_free(
+		 &stats_output,
+		 NULL );
+	}
 #if !defined( HAVE_GLOB_H )
 	if( glob != NULL )
 	{
@@ -0,0 +1,302 @@
+/*
+ * Export file entry
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libewf.h"
+#include "export_file_entry.h"
+
+/* Creates an export file entry
+ * Make sure the value export_file_entry is referencing, is set to NULL
+ * The export file entry takes over management of the file entry
+ * Returns 1 if successful or -1 on error
+ */
+int export_file_entry_initialize(
+     export_file_entry_t **export_file_entry,
+     libewf_file_entry_t *file_entry,
+     const system_character_t *target_path,
+     size_t target_path_size,
+     size_t file_entry_path_index,
+     libcerror_error_t **error )
+{
+	static char *function = "export_file_entry_initialize";
+
+	if( export_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *export_file_entry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export file entry value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( target_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid target path.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( target_path_size == 0 )
+	 || ( target_path_size > (size_t) ( SSIZE_MAX / sizeof( system_character_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid target path size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_entry_path_index >= target_path_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file entry path index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*export_file_entry = memory_allocate_structure(
+	                      export_file_entry_t );
+
+	if( *export_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create export file entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *export_file_entry,
+	     0,
+	     sizeof( export_file_entry_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear export file entry.",
+		 function );
+
+		memory_free(
+		 *export_file_entry );
+
+		*export_file_entry = NULL;
+
+		return( -1 );
+	}
+	if( libewf_file_entry_get_media_data_offset(
+	     file_entry,
+	     &( ( *export_file_entry )->media_data_offset ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media data offset.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_file_entry_get_media_data_size(
+	     file_entry,
+	     &( ( *export_file_entry )->media_data_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media data size.",
+		 function );
+
+		goto on_error;
+	}
+	( *export_file_entry )->target_path = system_string_allocate(
+	                                       target_path_size );
+
+	if( ( *export_file_entry )->target_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create target path.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     ( *export_file_entry )->target_path,
+	     target_path,
+	     target_path_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy target path.",
+		 function );
+
+		goto on_error;
+	}
+	( *export_file_entry )->target_path[ target_path_size - 1 ] = 0;
+
+	( *export_file_entry )->file_entry            = file_entry;
+	( *export_file_entry )->target_path_size      = target_path_size;
+	( *export_file_entry )->file_entry_path_index = file_entry_path_index;
+
+	return( 1 );
+
+on_error:
+	if( *export_file_entry != NULL )
+	{
+		if( ( *export_file_entry )->target_path != NULL )
+		{
+			memory_free(
+			 ( *export_file_entry )->target_path );
+		}
+		memory_free(
+		 *export_file_entry );
+
+		*export_file_entry = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an export file entry
+ * Returns 1 if successful or -1 on error
+ */
+int export_file_entry_free(
+     export_file_entry_t **export_file_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "export_file_entry_free";
+	int result            = 1;
+
+	if( export_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *export_file_entry != NULL )
+	{
+		if( ( *export_file_entry )->file_entry != NULL )
+		{
+			if( libewf_file_entry_free(
+			     &( ( *export_file_entry )->file_entry ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file entry.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *export_file_entry )->target_path != NULL )
+		{
+			memory_free(
+			 ( *export_file_entry )->target_path );
+		}
+		memory_free(
+		 *export_file_entry );
+
+		*export_file_entry = NULL;
+	}
+	return( result );
+}
+
+/* Compares two export file entries by their media data offset
+ * The arguments are references to export file entries so that the function can be used with qsort
+ * Returns -1 if the first is less than, 0 if equal to or 1 if greater than the second
+ */
+int export_file_entry_compare_by_media_data_offset(
+     const void *first_export_file_entry,
+     const void *second_export_file_entry )
+{
+	const export_file_entry_t *first_entry  = NULL;
+	const export_file_entry_t *second_entry = NULL;
+
+	first_entry  = *( (const export_file_entry_t * const *) first_export_file_entry );
+	second_entry = *( (const export_file_entry_t * const *) second_export_file_entry );
+
+	if( first_entry->media_data_offset < second_entry->media_data_offset )
+	{
+		return( -1 );
+	}
+	else if( first_entry->media_data_offset > second_entry->media_data_offset )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
@@ -0,0 +1,95 @@
+/*
+ * Export file entry
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _EXPORT_FILE_ENTRY_H )
+#define _EXPORT_FILE_ENTRY_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libewf.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct export_file_entry export_file_entry_t;
+
+/* A (single) file entry of which the data is to be exported
+ */
+struct export_file_entry
+{
+	/* The file entry
+	 */
+	libewf_file_entry_t *file_entry;
+
+	/* The target path
+	 */
+	system_character_t *target_path;
+
+	/* The target path size
+	 */
+	size_t target_path_size;
+
+	/* The index of the file entry path in the target path
+	 */
+	size_t file_entry_path_index;
+
+	/* The media data offset
+	 */
+	off64_t media_data_offset;
+
+	/* The media data size
+	 */
+	size64_t media_data_size;
+
+	/* The next export file entry that is exported by the same thread
+	 */
+	export_file_entry_t *next_export_file_entry;
+
+	/* The result of the export
+	 */
+	int result;
+};
+
+int export_file_entry_initialize(
+     export_file_entry_t **export_file_entry,
+     libewf_file_entry_t *file_entry,
+     const system_character_t *target_path,
+     size_t target_path_size,
+     size_t file_entry_path_index,
+     libcerror_error_t **error );
+
+int export_file_entry_free(
+     export_file_entry_t **export_file_entry,
+     libcerror_error_t **error );
+
+int export_file_entry_compare_by_media_data_offset(
+     const void *first_export_file_entry,
+     const void *second_export_file_entry );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _EXPORT_FILE_ENTRY_H ) */
+
@@ -26,6 +26,10 @@
 #include <types.h>
 #include <wide_string.h>
 
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
 #if defined( HAVE_UNISTD_H )
 #include <unistd.h>
 #endif
@@ -54,17 +58,27 @@
 #include "ewftools_libsmraw.h"
 #include "ewftools_libhmac.h"
 #include "ewftools_system_string.h"
+#include "ewftools_timestamp.h"
+#include "export_file_entry.h"
 #include "export_handle.h"
+#include "export_output.h"
 #include "guid.h"
+#include "numa_topology.h"
 #include "process_status.h"
+#include "stats_output.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
+#include "thread_autotune.h"
 
 #define EXPORT_HANDLE_BUFFER_SIZE		8192
 #define EXPORT_HANDLE_INPUT_BUFFER_SIZE		64
 #define EXPORT_HANDLE_STRING_SIZE		1024
 #define EXPORT_HANDLE_NOTIFY_STREAM		stderr
 
+/* The media data size of the file entries that are exported by the same thread
+ */
+#define EXPORT_HANDLE_FILE_ENTRIES_BATCH_SIZE	( 4 * 1024 * 1024 )
+
 /* Creates an export handle
  * Make sure the value export_handle is referencing, is set to NULL
  * Returns 1 if successful or -1 on error
@@ -240,6 +254,7 @@ int export_handle_free(
      libcerror_error_t **error )
 {
 	static char *function = "export_handle_free";
+	int output_index      = 0;
 	int result            = 1;
 
 	if( export_handle == NULL )
@@ -311,6 +326,78 @@ int export_handle_free(
 				result = -1;
 			}
 		}
+		if( ( *export_handle )->blocked_gzip_output != NULL )
+		{
+			if( blocked_gzip_output_free(
+			     &( ( *export_handle )->blocked_gzip_output ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free blocked gzip output.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *export_handle )->stream_writer != NULL )
+		{
+			if( stream_writer_free(
+			     &( ( *export_handle )->stream_writer ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free stream writer.",
+				 function );
+
+				result = -1;
+			}
+		}
+		for( output_index = 0;
+		     output_index < ( *export_handle )->number_of_additional_outputs;
+		     output_index++ )
+		{
+			if( export_output_free(
+			     &( ( *export_handle )->additional_outputs[ output_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free additional output: %d.",
+				 function,
+				 output_index );
+
+				result = -1;
+			}
+		}
+		if( ( *export_handle )->partition_manifest != NULL )
+		{
+			if( partition_manifest_free(
+			     &( ( *export_handle )->partition_manifest ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free partition manifest.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *export_handle )->partition_manifest_filename != NULL )
+		{
+			memory_free(
+			 ( *export_handle )->partition_manifest_filename );
+		}
 		if( ( *export_handle )->md5_context != NULL )
 		{
 			if( libhmac_md5_free(
@@ -355,7 +442,7 @@ int export_handle_free(
 		}
 		if( ( *export_handle )->sha256_context != NULL )
 		{
-			if( libhmac_sha256_free(
+			if( sha256_context_free(
 			     &( ( *export_handle )->sha256_context ),
 			     error ) != 1 )
 			{
@@ -374,6 +461,24 @@ int export_handle_free(
 			memory_free(
 			 ( *export_handle )->calculated_sha256_hash_string );
 		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *export_handle )->thread_autotune != NULL )
+		{
+			if( thread_autotune_free(
+			     &( ( *export_handle )->thread_autotune ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free thread autotune.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
 		memory_free(
 		 *export_handle );
 
@@ -506,6 +611,7 @@ int export_handle_open_input(
 	system_character_t **libewf_filenames = NULL;
 	static char *function                 = "export_handle_open_input";
 	size_t first_filename_length          = 0;
+	int access_flags                      = LIBEWF_OPEN_READ;
 
 	if( export_handle == NULL )
 	{
@@ -574,19 +680,26 @@ int export_handle_open_input(
 		}
 		filenames = (system_character_t * const *) libewf_filenames;
 	}
+	/* When the input is rebuilt it is opened to resume writing after
+	 * the last intact chunks section of the last segment file
+	 */
+	if( export_handle->rebuild_input != 0 )
+	{
+		access_flags = LIBEWF_OPEN_WRITE_RESUME;
+	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	if( libewf_handle_open_wide(
 	     export_handle->input_handle,
 	     filenames,
 	     number_of_filenames,
-	     LIBEWF_OPEN_READ,
+	     access_flags,
 	     error ) != 1 )
 #else
 	if( libewf_handle_open(
 	     export_handle->input_handle,
 	     filenames,
 	     number_of_filenames,
-	     LIBEWF_OPEN_READ,
+	     access_flags,
 	     error ) != 1 )
 #endif
 	{
@@ -811,6 +924,8 @@ int export_handle_open_output(
 	static char *function              = "export_handle_open_output";
 	system_character_t *filenames[ 1 ] = { NULL };
 	size_t filename_length             = 0;
+	int compression_level              = 0;
+	int output_index                   = 0;
 
 	if( export_handle == NULL )
 	{
@@ -823,7 +938,8 @@ int export_handle_open_output(
 
 		return( -1 );
 	}
-	if( ( export_handle->output_format != EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
+	if( ( export_handle->output_format != EXPORT_HANDLE_OUTPUT_FORMAT_BLOCKED_GZIP )
+	 && ( export_handle->output_format != EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
 	 && ( export_handle->output_format != EXPORT_HANDLE_OUTPUT_FORMAT_RAW ) )
 	{
 		libcerror_error_set(
@@ -916,6 +1032,31 @@ int export_handle_open_output(
 		       _SYSTEM_STRING( "-" ),
 		       1 ) == 0 ) )
 		{
+			if( export_handle->stream_writer != NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+				 "%s: invalid export handle - stream writer already set.",
+				 function );
+
+				return( -1 );
+			}
+			if( stream_writer_initialize(
+			     &( export_handle->stream_writer ),
+			     1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize stream writer.",
+				 function );
+
+				return( -1 );
+			}
 			export_handle->use_stdout = 1;
 		}
 		else
@@ -978,7 +1119,165 @@ int export_handle_open_output(
 			}
 		}
 	}
+	else if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_BLOCKED_GZIP )
+	{
+		if( export_handle->blocked_gzip_output != NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid export handle - blocked gzip output already set.",
+			 function );
+
+			return( -1 );
+		}
+		/* The EWF compression level is mapped onto the corresponding zlib compression level
+		 */
+		if( export_handle->compression_level == LIBEWF_COMPRESSION_FAST )
+		{
+			compression_level = 1;
+		}
+		else if( export_handle->compression_level == LIBEWF_COMPRESSION_BEST )
+		{
+			compression_level = 9;
+		}
+		else
+		{
+			compression_level = -1;
+		}
+		if( blocked_gzip_output_initialize(
+		     &( export_handle->blocked_gzip_output ),
+		     compression_level,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create blocked gzip output.",
+			 function );
+
+			return( -1 );
+		}
+		if( blocked_gzip_output_open(
+		     export_handle->blocked_gzip_output,
+		     filename,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open blocked gzip output: %" PRIs_SYSTEM ".",
+			 function,
+			 filename );
+
+			blocked_gzip_output_free(
+			 &( export_handle->blocked_gzip_output ),
+			 NULL );
+
+			return( -1 );
+		}
+		export_handle->use_stdout = export_handle->blocked_gzip_output->use_stdout;
+	}
+	if( export_handle->partition_manifest != NULL )
+	{
+		/* The partition manifest is written next to the output as: filename.manifest
+		 */
+		if( ( export_handle->use_stdout != 0 )
+		 || ( export_handle->partition_manifest_filename != NULL ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported partition manifest filename.",
+			 function );
+
+			return( -1 );
+		}
+		filename_length = system_string_length(
+		                   filename );
+
+		export_handle->partition_manifest_filename = system_string_allocate(
+		                                              filename_length + 10 );
+
+		if( export_handle->partition_manifest_filename == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create partition manifest filename.",
+			 function );
+
+			return( -1 );
+		}
+		if( system_string_copy(
+		     export_handle->partition_manifest_filename,
+		     filename,
+		     filename_length ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy filename.",
+			 function );
+
+			goto on_error;
+		}
+		if( system_string_copy(
+		     &( export_handle->partition_manifest_filename[ filename_length ] ),
+		     _SYSTEM_STRING( ".manifest" ),
+		     9 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy partition manifest extension.",
+			 function );
+
+			goto on_error;
+		}
+		export_handle->partition_manifest_filename[ filename_length + 9 ] = 0;
+
+		export_handle->partition_manifest_filename_size = filename_length + 10;
+	}
+	for( output_index = 0;
+	     output_index < export_handle->number_of_additional_outputs;
+	     output_index++ )
+	{
+		if( export_output_open(
+		     export_handle->additional_outputs[ output_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open additional output: %d.",
+			 function,
+			 output_index );
+
+			return( -1 );
+		}
+	}
 	return( 1 );
+
+on_error:
+	if( export_handle->partition_manifest_filename != NULL )
+	{
+		memory_free(
+		 export_handle->partition_manifest_filename );
+
+		export_handle->partition_manifest_filename = NULL;
+	}
+	export_handle->partition_manifest_filename_size = 0;
+
+	return( -1 );
 }
 
 /* Closes the export handle
@@ -989,6 +1288,7 @@ int export_handle_close(
      libcerror_error_t **error )
 {
 	static char *function = "export_handle_close";
+	int output_index      = 0;
 
 	if( export_handle == NULL )
 	{
@@ -1046,78 +1346,55 @@ int export_handle_close(
 			return( -1 );
 		}
 	}
-	return( 0 );
-}
-
-/* Prepares a storage media buffer before writing the output of the export handle
- * Returns the resulting buffer size or -1 on error
- */
-ssize_t export_handle_prepare_write_storage_media_buffer(
-         export_handle_t *export_handle,
-         storage_media_buffer_t *storage_media_buffer,
-         libcerror_error_t **error )
-{
-	static char *function = "export_handle_prepare_write_storage_media_buffer";
-	ssize_t process_count = 0;
-
-	if( export_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid export handle.",
-		 function );
-
-		return( -1 );
-	}
-	if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
+	if( export_handle->blocked_gzip_output != NULL )
 	{
-		process_count = storage_media_buffer_write_process(
-		                 storage_media_buffer,
-		                 error );
-
-		if( process_count < 0 )
+		if( blocked_gzip_output_close(
+		     export_handle->blocked_gzip_output,
+		     error ) != 0 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to prepare storage media buffer before writing.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close blocked gzip output.",
 			 function );
 
 			return( -1 );
 		}
 	}
-	else if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_RAW )
+	for( output_index = 0;
+	     output_index < export_handle->number_of_additional_outputs;
+	     output_index++ )
 	{
-		if( storage_media_buffer == NULL )
+		if( export_output_close(
+		     export_handle->additional_outputs[ output_index ],
+		     error ) != 0 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-			 "%s: invalid storage media buffer.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close additional output: %d.",
+			 function,
+			 output_index );
 
 			return( -1 );
 		}
-		process_count = (ssize_t) storage_media_buffer->raw_buffer_data_size;
 	}
-	return( process_count );
+	return( 0 );
 }
 
-/* Writes a storage media buffer to the output of the export handle
- * Returns the number of bytes written or -1 on error
+/* Appends an additional output from a specification string
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
  */
-ssize_t export_handle_write_storage_media_buffer(
-         export_handle_t *export_handle,
-         storage_media_buffer_t *storage_media_buffer,
-         size_t write_size,
-         libcerror_error_t **error )
+int export_handle_append_additional_output(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
 {
-	static char *function = "export_handle_write_storage_media_buffer";
-	ssize_t write_count   = 0;
+	export_output_t *export_output = NULL;
+	static char *function          = "export_handle_append_additional_output";
+	int result                     = 0;
 
 	if( export_handle == NULL )
 	{
@@ -1130,77 +1407,92 @@ ssize_t export_handle_write_storage_media_buffer(
 
 		return( -1 );
 	}
-	if( write_size == 0 )
+	if( export_handle->number_of_additional_outputs >= EXPORT_HANDLE_MAXIMUM_NUMBER_OF_ADDITIONAL_OUTPUTS )
 	{
-		return( 0 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid export handle - number of additional outputs value exceeds maximum.",
+		 function );
+
+		return( -1 );
 	}
-	if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
+	if( export_output_initialize(
+	     &export_output,
+	     error ) != 1 )
 	{
-		write_count = storage_media_buffer_write_to_handle(
-			       storage_media_buffer,
-			       export_handle->ewf_output_handle,
-			       write_size,
-			       error );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create additional output.",
+		 function );
+
+		goto on_error;
 	}
-	else if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_RAW )
+	result = export_output_set_specification(
+	          export_output,
+	          string,
+	          error );
+
+	if( result == -1 )
 	{
-		if( storage_media_buffer == NULL )
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set additional output specification.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		if( export_output_free(
+		     &export_output,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-			 "%s: invalid storage media buffer.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free additional output.",
 			 function );
 
-			return( -1 );
-		}
-		if( export_handle->use_stdout != 0 )
-		{
-#if defined( WINAPI ) && !defined( __CYGWIN__ )
-			write_count = _write(
-			               1,
-				       storage_media_buffer->raw_buffer,
-				       write_size );
-#else
-			write_count = write(
-			               1,
-				       storage_media_buffer->raw_buffer,
-				       write_size );
-#endif
-		}
-		else
-		{
-			write_count = libsmraw_handle_write_buffer(
-				       export_handle->raw_output_handle,
-				       storage_media_buffer->raw_buffer,
-				       write_size,
-				       error );
+			goto on_error;
 		}
+		return( 0 );
 	}
-	if( write_count < 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to write storage media buffer.",
-		 function );
+	export_handle->additional_outputs[ export_handle->number_of_additional_outputs ] = export_output;
 
-		return( -1 );
+	export_handle->number_of_additional_outputs += 1;
+
+	return( 1 );
+
+on_error:
+	if( export_output != NULL )
+	{
+		export_output_free(
+		 &export_output,
+		 NULL );
 	}
-	return( write_count );
+	return( -1 );
 }
 
-/* Seeks the offset
- * Returns the resulting offset or -1 on error
+/* Writes data to the additional outputs
+ * The data is decoded and hashed once and written to every additional output
+ * by its own writer thread, if started
+ * Returns 1 if successful or -1 on error
  */
-off64_t export_handle_seek_offset(
-         export_handle_t *export_handle,
-         off64_t offset,
-         libcerror_error_t **error )
+int export_handle_write_additional_outputs(
+     export_handle_t *export_handle,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
 {
-	static char *function = "export_handle_seek_offset";
+	static char *function = "export_handle_write_additional_outputs";
+	int output_index      = 0;
 
 	if( export_handle == NULL )
 	{
@@ -1213,36 +1505,41 @@ off64_t export_handle_seek_offset(
 
 		return( -1 );
 	}
-	if( libewf_handle_seek_offset(
-	     export_handle->input_handle,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
+	for( output_index = 0;
+	     output_index < export_handle->number_of_additional_outputs;
+	     output_index++ )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
-		 function );
+		if( export_output_write(
+		     export_handle->additional_outputs[ output_index ],
+		     data,
+		     data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write to additional output: %d.",
+			 function,
+			 output_index );
 
-		return( -1 );
+			return( -1 );
+		}
 	}
-	return( offset );
+	return( 1 );
 }
 
-/* Swaps the byte order of byte pairs within a buffer of a certain size
- * Returns 1 if successful, -1 on error
+/* Prepares a storage media buffer before writing the output of the export handle
+ * Returns the resulting buffer size or -1 on error
  */
-int export_handle_swap_byte_pairs(
-     export_handle_t *export_handle,
-     uint8_t *buffer,
-     size_t buffer_size,
-     libcerror_error_t **error )
+ssize_t export_handle_prepare_write_storage_media_buffer(
+         export_handle_t *export_handle,
+         storage_media_buffer_t *storage_media_buffer,
+         libcerror_error_t **error )
 {
-	static char *function = "export_handle_swap_byte_pairs";
-	size_t buffer_offset  = 0;
-	uint8_t byte_value    = 0;
+	static char *function         = "export_handle_prepare_write_storage_media_buffer";
+	ssize_t process_count         = 0;
+	int64_t stats_start_timestamp = 0;
 
 	if( export_handle == NULL )
 	{
@@ -1255,61 +1552,91 @@ int export_handle_swap_byte_pairs(
 
 		return( -1 );
 	}
-	if( buffer == NULL )
+	if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
-		 function );
+		if( export_handle->stats_output != NULL )
+		{
+			if( ewftools_timestamp_get_monotonic(
+			     &stats_start_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve statistics start timestamp.",
+				 function );
 
-		return( -1 );
-	}
-	if( ( buffer_size == 0 )
-	 || ( buffer_size > (size_t) SSIZE_MAX ) )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid buffer size value out of bounds.",
-		 function );
+				return( -1 );
+			}
+		}
+		process_count = storage_media_buffer_write_process(
+		                 storage_media_buffer,
+		                 error );
 
-		return( -1 );
-	}
-	/* If the last bit is set the value is odd
-	 */
-	if( ( buffer_size & 0x01 ) != 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: invalid buffer size value is odd.",
-		 function );
+		if( process_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to prepare storage media buffer before writing.",
+			 function );
 
-		return( -1 );
+			return( -1 );
+		}
+		if( export_handle->stats_output != NULL )
+		{
+			if( stats_output_add_stage(
+			     export_handle->stats_output,
+			     STATS_OUTPUT_STAGE_PROCESS,
+			     (size64_t) process_count,
+			     stats_start_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to add process to statistics output.",
+				 function );
+
+				return( -1 );
+			}
+		}
 	}
-	for( buffer_offset = 0;
-	     buffer_offset < buffer_size;
-	     buffer_offset += 2 )
+	else if( ( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_BLOCKED_GZIP )
+	      || ( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_RAW ) )
 	{
-		byte_value                  = buffer[ buffer_offset ];
-		buffer[ buffer_offset ]     = buffer[ buffer_offset + 1 ];
-		buffer[ buffer_offset + 1 ] = byte_value;
+		if( storage_media_buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid storage media buffer.",
+			 function );
+
+			return( -1 );
+		}
+		process_count = (ssize_t) storage_media_buffer->raw_buffer_data_size;
 	}
-	return( 1 );
+	return( process_count );
 }
 
-/* Initializes the integrity hash(es)
- * Returns 1 if successful or -1 on error
+/* Writes a storage media buffer to the output of the export handle
+ * Returns the number of bytes written or -1 on error
  */
-int export_handle_initialize_integrity_hash(
-     export_handle_t *export_handle,
-     libcerror_error_t **error )
+ssize_t export_handle_write_storage_media_buffer(
+         export_handle_t *export_handle,
+         storage_media_buffer_t *storage_media_buffer,
+         size_t write_size,
+         libcerror_error_t **error )
 {
-	static char *function = "export_handle_initialize_integrity_hash";
+	static char *function         = "export_handle_write_storage_media_buffer";
+	ssize_t write_count           = 0;
+	int64_t stats_start_timestamp = 0;
+	int result                    = 0;
 
 	if( export_handle == NULL )
 	{
@@ -1322,85 +1649,191 @@ int export_handle_initialize_integrity_hash(
 
 		return( -1 );
 	}
-	if( export_handle->calculate_md5 != 0 )
+	if( write_size == 0 )
 	{
-		if( libhmac_md5_initialize(
-		     &( export_handle->md5_context ),
+		return( 0 );
+	}
+	if( export_handle->stats_output != NULL )
+	{
+		if( ewftools_timestamp_get_monotonic(
+		     &stats_start_timestamp,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create MD5 context.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve statistics start timestamp.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
-		export_handle->md5_context_initialized = 1;
 	}
-	if( export_handle->calculate_sha1 != 0 )
+	if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
 	{
-		if( libhmac_sha1_initialize(
-		     &( export_handle->sha1_context ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create SHA1 context.",
+		write_count = storage_media_buffer_write_to_handle(
+			       storage_media_buffer,
+			       export_handle->ewf_output_handle,
+			       write_size,
+			       error );
+	}
+	else if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_RAW )
+	{
+		if( storage_media_buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid storage media buffer.",
 			 function );
 
-			goto on_error;
+			return( -1 );
+		}
+		if( export_handle->use_stdout != 0 )
+		{
+			write_count = stream_writer_write_storage_media_buffer(
+			               export_handle->stream_writer,
+			               storage_media_buffer,
+			               write_size,
+			               error );
+		}
+		else
+		{
+			if( export_handle->sparse_output != 0 )
+			{
+				result = storage_media_buffer_is_zero_filled(
+				          storage_media_buffer,
+				          write_size,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to determine if storage media buffer is zero-filled.",
+					 function );
+
+					return( -1 );
+				}
+			}
+			/* Zero-filled data is not written but skipped when the next data is written
+			 */
+			if( result != 0 )
+			{
+				export_handle->sparse_hole_size += write_size;
+
+				write_count = (ssize_t) write_size;
+			}
+			else
+			{
+				if( export_handle_skip_sparse_hole(
+				     export_handle,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_SEEK_FAILED,
+					 "%s: unable to skip sparse hole.",
+					 function );
+
+					return( -1 );
+				}
+				write_count = libsmraw_handle_write_buffer(
+					       export_handle->raw_output_handle,
+					       storage_media_buffer->raw_buffer,
+					       write_size,
+					       error );
+			}
 		}
-		export_handle->sha1_context_initialized = 1;
 	}
-	if( export_handle->calculate_sha256 != 0 )
+	else if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_BLOCKED_GZIP )
 	{
-		if( libhmac_sha256_initialize(
-		     &( export_handle->sha256_context ),
-		     error ) != 1 )
+		if( storage_media_buffer == NULL )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create SHA256 context.",
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid storage media buffer.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
-		export_handle->sha256_context_initialized = 1;
-	}
-	return( 1 );
+		/* Use the data compressed by the process threads if it corresponds with the data to write
+		 */
+		if( ( storage_media_buffer->compressed_buffer_input_size != 0 )
+		 && ( storage_media_buffer->compressed_buffer_input_size == write_size ) )
+		{
+			write_count = blocked_gzip_output_write_compressed_data(
+			               export_handle->blocked_gzip_output,
+			               storage_media_buffer->compressed_buffer,
+			               storage_media_buffer->compressed_buffer_data_size,
+			               error );
 
-on_error:
-	if( export_handle->sha1_context != NULL )
+			if( write_count == (ssize_t) storage_media_buffer->compressed_buffer_data_size )
+			{
+				write_count = (ssize_t) write_size;
+			}
+			else
+			{
+				write_count = -1;
+			}
+		}
+		else
+		{
+			write_count = blocked_gzip_output_write_buffer(
+			               export_handle->blocked_gzip_output,
+			               storage_media_buffer->raw_buffer,
+			               write_size,
+			               error );
+		}
+		storage_media_buffer->compressed_buffer_input_size = 0;
+	}
+	if( write_count < 0 )
 	{
-		libhmac_sha1_free(
-		 &( export_handle->sha1_context ),
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to write storage media buffer.",
+		 function );
+
+		return( -1 );
 	}
-	if( export_handle->md5_context != NULL )
+	if( export_handle->stats_output != NULL )
 	{
-		libhmac_md5_free(
-		 &( export_handle->md5_context ),
-		 NULL );
+		if( stats_output_add_stage(
+		     export_handle->stats_output,
+		     STATS_OUTPUT_STAGE_WRITE,
+		     (size64_t) write_count,
+		     stats_start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to add write to statistics output.",
+			 function );
+
+			return( -1 );
+		}
 	}
-	return( -1 );
+	return( write_count );
 }
 
-/* Updates the integrity hash(es)
+/* Skips the pending sparse hole in the raw output
  * Returns 1 if successful or -1 on error
  */
-int export_handle_update_integrity_hash(
+int export_handle_skip_sparse_hole(
      export_handle_t *export_handle,
-     const uint8_t *buffer,
-     size_t buffer_size,
      libcerror_error_t **error )
 {
-	static char *function = "export_handle_update_integrity_hash";
+	static char *function = "export_handle_skip_sparse_hole";
 
 	if( export_handle == NULL )
 	{
@@ -1413,98 +1846,93 @@ int export_handle_update_integrity_hash(
 
 		return( -1 );
 	}
-	if( buffer == NULL )
+	if( export_handle->sparse_hole_size > (size64_t) INT64_MAX )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid export handle - sparse hole size value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( buffer_size == 0 )
-	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	if( export_handle->sparse_hole_size == 0 )
+	{
+		return( 1 );
+	}
+	if( libsmraw_handle_seek_offset(
+	     export_handle->raw_output_handle,
+	     (off64_t) export_handle->sparse_hole_size,
+	     SEEK_CUR,
+	     error ) == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid buffer size value out of bounds.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek past sparse hole of size: %" PRIu64 " in raw output handle.",
+		 function,
+		 export_handle->sparse_hole_size );
 
 		return( -1 );
 	}
-	if( export_handle->calculate_md5 != 0 )
-	{
-		if( libhmac_md5_update(
-		     export_handle->md5_context,
-		     buffer,
-		     buffer_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update MD5 digest hash.",
-			 function );
+	export_handle->sparse_hole_size = 0;
 
-			return( -1 );
-		}
-	}
-	if( export_handle->calculate_sha1 != 0 )
+	return( 1 );
+}
+
+/* Seeks the offset
+ * Returns the resulting offset or -1 on error
+ */
+off64_t export_handle_seek_offset(
+         export_handle_t *export_handle,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "export_handle_seek_offset";
+
+	if( export_handle == NULL )
 	{
-		if( libhmac_sha1_update(
-		     export_handle->sha1_context,
-		     buffer,
-		     buffer_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update SHA1 digest hash.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
 
-			return( -1 );
-		}
+		return( -1 );
 	}
-	if( export_handle->calculate_sha256 != 0 )
+	if( libewf_handle_seek_offset(
+	     export_handle->input_handle,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
 	{
-		if( libhmac_sha256_update(
-		     export_handle->sha256_context,
-		     buffer,
-		     buffer_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update SHA256 digest hash.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
 
-			return( -1 );
-		}
+		return( -1 );
 	}
-	return( 1 );
+	return( offset );
 }
 
-/* Finalizes the integrity hash(es)
- * Returns 1 if successful or -1 on error
+/* Swaps the byte order of byte pairs within a buffer of a certain size
+ * Returns 1 if successful, -1 on error
  */
-int export_handle_finalize_integrity_hash(
+int export_handle_swap_byte_pairs(
      export_handle_t *export_handle,
+     uint8_t *buffer,
+     size_t buffer_size,
      libcerror_error_t **error )
 {
-	uint8_t calculated_md5_hash[ LIBHMAC_MD5_HASH_SIZE ];
-	uint8_t calculated_sha1_hash[ LIBHMAC_SHA1_HASH_SIZE ];
-	uint8_t calculated_sha256_hash[ LIBHMAC_SHA256_HASH_SIZE ];
-
-	static char *function = "export_handle_finalize_integrity_hash";
+	static char *function = "export_handle_swap_byte_pairs";
+	size_t buffer_offset  = 0;
+	uint8_t byte_value    = 0;
 
 	if( export_handle == NULL )
 	{
@@ -1517,91 +1945,235 @@ int export_handle_finalize_integrity_hash(
 
 		return( -1 );
 	}
-	if( export_handle->calculate_md5 != 0 )
+	if( buffer == NULL )
 	{
-		if( export_handle->calculated_md5_hash_string == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid export handle - missing calculated MD5 hash string.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
 
-			return( -1 );
-		}
-		if( libhmac_md5_finalize(
-		     export_handle->md5_context,
-		     calculated_md5_hash,
-		     LIBHMAC_MD5_HASH_SIZE,
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* If the last bit is set the value is odd
+	 */
+	if( ( buffer_size & 0x01 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid buffer size value is odd.",
+		 function );
+
+		return( -1 );
+	}
+	for( buffer_offset = 0;
+	     buffer_offset < buffer_size;
+	     buffer_offset += 2 )
+	{
+		byte_value                  = buffer[ buffer_offset ];
+		buffer[ buffer_offset ]     = buffer[ buffer_offset + 1 ];
+		buffer[ buffer_offset + 1 ] = byte_value;
+	}
+	return( 1 );
+}
+
+/* Initializes the integrity hash(es)
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_initialize_integrity_hash(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_initialize_integrity_hash";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->calculate_md5 != 0 )
+	{
+		if( libhmac_md5_initialize(
+		     &( export_handle->md5_context ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to finalize MD5 hash.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create MD5 context.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
-		if( digest_hash_copy_to_string(
-		     calculated_md5_hash,
-		     LIBHMAC_MD5_HASH_SIZE,
-		     export_handle->calculated_md5_hash_string,
-		     33,
+		export_handle->md5_context_initialized = 1;
+	}
+	if( export_handle->calculate_sha1 != 0 )
+	{
+		if( libhmac_sha1_initialize(
+		     &( export_handle->sha1_context ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBEWF_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set calculated MD5 hash string.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create SHA1 context.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
+		export_handle->sha1_context_initialized = 1;
 	}
-	if( export_handle->calculate_sha1 != 0 )
+	if( export_handle->calculate_sha256 != 0 )
 	{
-		if( export_handle->calculated_sha1_hash_string == NULL )
+		if( sha256_context_initialize(
+		     &( export_handle->sha256_context ),
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid export handle - missing calculated SHA1 hash string.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create SHA256 context.",
+			 function );
+
+			goto on_error;
+		}
+		export_handle->sha256_context_initialized = 1;
+	}
+	return( 1 );
+
+on_error:
+	if( export_handle->sha1_context != NULL )
+	{
+		libhmac_sha1_free(
+		 &( export_handle->sha1_context ),
+		 NULL );
+	}
+	if( export_handle->md5_context != NULL )
+	{
+		libhmac_md5_free(
+		 &( export_handle->md5_context ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Updates the integrity hash(es)
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_update_integrity_hash(
+     export_handle_t *export_handle,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function         = "export_handle_update_integrity_hash";
+	int64_t stats_start_timestamp = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->stats_output != NULL )
+	{
+		if( ewftools_timestamp_get_monotonic(
+		     &stats_start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve statistics start timestamp.",
 			 function );
 
 			return( -1 );
 		}
-		if( libhmac_sha1_finalize(
-		     export_handle->sha1_context,
-		     calculated_sha1_hash,
-		     LIBHMAC_SHA1_HASH_SIZE,
+	}
+	if( export_handle->calculate_md5 != 0 )
+	{
+		if( libhmac_md5_update(
+		     export_handle->md5_context,
+		     buffer,
+		     buffer_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to finalize SHA1 hash.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update MD5 digest hash.",
 			 function );
 
 			return( -1 );
 		}
-		if( digest_hash_copy_to_string(
-		     calculated_sha1_hash,
-		     LIBHMAC_SHA1_HASH_SIZE,
-		     export_handle->calculated_sha1_hash_string,
-		     41,
+	}
+	if( export_handle->calculate_sha1 != 0 )
+	{
+		if( libhmac_sha1_update(
+		     export_handle->sha1_context,
+		     buffer,
+		     buffer_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create calculated SHA1 hash string.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA1 digest hash.",
 			 function );
 
 			return( -1 );
@@ -1609,44 +2181,54 @@ int export_handle_finalize_integrity_hash(
 	}
 	if( export_handle->calculate_sha256 != 0 )
 	{
-		if( export_handle->calculated_sha256_hash_string == NULL )
+		if( sha256_context_update(
+		     export_handle->sha256_context,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid export handle - missing calculated SHA256 hash string.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA256 digest hash.",
 			 function );
 
 			return( -1 );
 		}
-		if( libhmac_sha256_finalize(
-		     export_handle->sha256_context,
-		     calculated_sha256_hash,
-		     LIBHMAC_SHA256_HASH_SIZE,
+	}
+	if( export_handle->partition_manifest != NULL )
+	{
+		if( partition_manifest_update(
+		     export_handle->partition_manifest,
+		     buffer,
+		     buffer_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to finalize SHA256 hash.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update partition manifest.",
 			 function );
 
 			return( -1 );
 		}
-		if( digest_hash_copy_to_string(
-		     calculated_sha256_hash,
-		     LIBHMAC_SHA256_HASH_SIZE,
-		     export_handle->calculated_sha256_hash_string,
-		     65,
+	}
+	if( export_handle->stats_output != NULL )
+	{
+		if( stats_output_add_stage(
+		     export_handle->stats_output,
+		     STATS_OUTPUT_STAGE_HASH,
+		     (size64_t) buffer_size,
+		     stats_start_timestamp,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create calculated SHA256 hash string.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to add hash to statistics output.",
 			 function );
 
 			return( -1 );
@@ -1655,15 +2237,18 @@ int export_handle_finalize_integrity_hash(
 	return( 1 );
 }
 
-/* Determines if the input is corrupted
- * Returns 1 if corrupted, 0 if not or -1 on error
+/* Finalizes the integrity hash(es)
+ * Returns 1 if successful or -1 on error
  */
-int export_handle_input_is_corrupted(
+int export_handle_finalize_integrity_hash(
      export_handle_t *export_handle,
      libcerror_error_t **error )
 {
-	static char *function = "export_handle_input_is_corrupted";
-	int result            = 0;
+	uint8_t calculated_md5_hash[ LIBHMAC_MD5_HASH_SIZE ];
+	uint8_t calculated_sha1_hash[ LIBHMAC_SHA1_HASH_SIZE ];
+	uint8_t calculated_sha256_hash[ LIBHMAC_SHA256_HASH_SIZE ];
+
+	static char *function = "export_handle_finalize_integrity_hash";
 
 	if( export_handle == NULL )
 	{
@@ -1676,18 +2261,193 @@ int export_handle_input_is_corrupted(
 
 		return( -1 );
 	}
-	result = libewf_handle_segment_files_corrupted(
-	          export_handle->input_handle,
-	          error );
-
-	if( result == -1 )
+	if( export_handle->calculate_md5 != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine if segment files are corrupted.",
-		 function );
+		if( export_handle->calculated_md5_hash_string == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid export handle - missing calculated MD5 hash string.",
+			 function );
+
+			return( -1 );
+		}
+		if( libhmac_md5_finalize(
+		     export_handle->md5_context,
+		     calculated_md5_hash,
+		     LIBHMAC_MD5_HASH_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize MD5 hash.",
+			 function );
+
+			return( -1 );
+		}
+		if( digest_hash_copy_to_string(
+		     calculated_md5_hash,
+		     LIBHMAC_MD5_HASH_SIZE,
+		     export_handle->calculated_md5_hash_string,
+		     33,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBEWF_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set calculated MD5 hash string.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( export_handle->calculate_sha1 != 0 )
+	{
+		if( export_handle->calculated_sha1_hash_string == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid export handle - missing calculated SHA1 hash string.",
+			 function );
+
+			return( -1 );
+		}
+		if( libhmac_sha1_finalize(
+		     export_handle->sha1_context,
+		     calculated_sha1_hash,
+		     LIBHMAC_SHA1_HASH_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize SHA1 hash.",
+			 function );
+
+			return( -1 );
+		}
+		if( digest_hash_copy_to_string(
+		     calculated_sha1_hash,
+		     LIBHMAC_SHA1_HASH_SIZE,
+		     export_handle->calculated_sha1_hash_string,
+		     41,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create calculated SHA1 hash string.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( export_handle->calculate_sha256 != 0 )
+	{
+		if( export_handle->calculated_sha256_hash_string == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid export handle - missing calculated SHA256 hash string.",
+			 function );
+
+			return( -1 );
+		}
+		if( sha256_context_finalize(
+		     export_handle->sha256_context,
+		     calculated_sha256_hash,
+		     LIBHMAC_SHA256_HASH_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize SHA256 hash.",
+			 function );
+
+			return( -1 );
+		}
+		if( digest_hash_copy_to_string(
+		     calculated_sha256_hash,
+		     LIBHMAC_SHA256_HASH_SIZE,
+		     export_handle->calculated_sha256_hash_string,
+		     65,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create calculated SHA256 hash string.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( export_handle->partition_manifest != NULL )
+	{
+		if( partition_manifest_finalize(
+		     export_handle->partition_manifest,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize partition manifest.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Determines if the input is corrupted
+ * Returns 1 if corrupted, 0 if not or -1 on error
+ */
+int export_handle_input_is_corrupted(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_input_is_corrupted";
+	int result            = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_handle_segment_files_corrupted(
+	          export_handle->input_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if segment files are corrupted.",
+		 function );
 
 		return( -1 );
 	}
@@ -1754,13 +2514,85 @@ int export_handle_get_output_chunk_size(
 			return( -1 );
 		}
 	}
-	else if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_RAW )
+	else if( ( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_BLOCKED_GZIP )
+	      || ( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_RAW ) )
 	{
 		*chunk_size = export_handle->input_chunk_size;
 	}
 	return( 1 );
 }
 
+/* Determines if the packed input chunks can be copied to the output without being recompressed
+ * This requires the whole input to be exported to EWF with the same chunk size and compression values
+ * Returns 1 if the packed chunks can be copied, 0 if not or -1 on error
+ */
+int export_handle_can_copy_packed_chunks(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	static char *function       = "export_handle_can_copy_packed_chunks";
+	uint16_t compression_method = 0;
+	uint8_t compression_flags   = 0;
+	int8_t compression_level    = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( export_handle->use_chunk_data_functions == 0 )
+	 || ( export_handle->output_format != EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
+	 || ( export_handle->swap_byte_pairs != 0 )
+	 || ( export_handle->export_offset != 0 )
+	 || ( export_handle->export_size != (uint64_t) export_handle->input_media_size )
+	 || ( export_handle->input_chunk_size != export_handle->output_chunk_size ) )
+	{
+		return( 0 );
+	}
+	if( libewf_handle_get_compression_method(
+	     export_handle->input_handle,
+	     &compression_method,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve input compression method.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_get_compression_values(
+	     export_handle->input_handle,
+	     &compression_level,
+	     &compression_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve input compression values.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( compression_method != export_handle->compression_method )
+	 || ( compression_level != export_handle->compression_level )
+	 || ( compression_level == LIBEWF_COMPRESSION_NONE ) )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
 /* Prompts the user for a string
  * Returns 1 if successful, 0 if no input was provided or -1 on error
  */
@@ -2797,6 +3629,19 @@ int export_handle_set_output_format(
 			result                       = 1;
 		}
 	}
+#if defined( HAVE_BLOCKED_GZIP_SUPPORT )
+	else if( string_length == 4 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "bgzf" ),
+		     4 ) == 0 )
+		{
+			export_handle->output_format = EXPORT_HANDLE_OUTPUT_FORMAT_BLOCKED_GZIP;
+			result                       = 1;
+		}
+	}
+#endif
 	else if( string_length == 5 )
 	{
 		if( system_string_compare(
@@ -3065,16 +3910,20 @@ int export_handle_set_export_size(
 	return( result );
 }
 
-/* Sets the header codepage
- * Returns 1 if successful or -1 on error
+/* Sets the partition of the input to export from a string formatted as: index/number
+ * where the index is 0-based, the export offset and size are set to those of the partition
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
  */
-int export_handle_set_header_codepage(
+int export_handle_set_partition(
      export_handle_t *export_handle,
      const system_character_t *string,
      libcerror_error_t **error )
 {
-	static char *function = "export_handle_set_header_codepage";
-	int result            = 0;
+	static char *function         = "export_handle_set_partition";
+	size_t separator_index        = 0;
+	size_t string_length          = 0;
+	uint64_t number_of_partitions = 0;
+	uint64_t partition_index      = 0;
 
 	if( export_handle == NULL )
 	{
@@ -3087,27 +3936,151 @@ int export_handle_set_header_codepage(
 
 		return( -1 );
 	}
-	result = ewfinput_determine_header_codepage(
-	          string,
-	          &export_handle->header_codepage,
-	          error );
-
-	if( result == -1 )
+	if( export_handle->partition_manifest != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine header codepage.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export handle - partition manifest value already set.",
 		 function );
 
 		return( -1 );
 	}
-	return( result );
-}
-
-/* Sets the process buffer size
- * Returns 1 if successful, 0 if unsupported value or -1 on error
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	for( separator_index = 0;
+	     separator_index < string_length;
+	     separator_index++ )
+	{
+		if( string[ separator_index ] == (system_character_t) '/' )
+		{
+			break;
+		}
+	}
+	if( ( separator_index == 0 )
+	 || ( ( separator_index + 1 ) >= string_length )
+	 || ( string[ 0 ] == (system_character_t) '-' )
+	 || ( string[ separator_index + 1 ] == (system_character_t) '-' ) )
+	{
+		return( 0 );
+	}
+	if( ewftools_system_string_decimal_copy_to_64_bit(
+	     string,
+	     separator_index,
+	     &partition_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine partition index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ewftools_system_string_decimal_copy_to_64_bit(
+	     &( string[ separator_index + 1 ] ),
+	     string_length - separator_index,
+	     &number_of_partitions,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine number of partitions.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_partitions == 0 )
+	 || ( number_of_partitions > (uint64_t) PARTITION_MANIFEST_MAXIMUM_NUMBER_OF_PARTITIONS )
+	 || ( partition_index >= number_of_partitions )
+	 || ( export_handle->input_media_size == 0 )
+	 || ( number_of_partitions > ( ( export_handle->input_media_size + RANGE_DIGESTS_DEFAULT_RANGE_SIZE - 1 ) / RANGE_DIGESTS_DEFAULT_RANGE_SIZE ) ) )
+	{
+		return( 0 );
+	}
+	if( partition_manifest_initialize(
+	     &( export_handle->partition_manifest ),
+	     export_handle->input_media_size,
+	     RANGE_DIGESTS_DEFAULT_RANGE_SIZE,
+	     (uint32_t) partition_index,
+	     (uint32_t) number_of_partitions,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create partition manifest.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->export_offset = (uint64_t) export_handle->partition_manifest->partition_offset;
+	export_handle->export_size   = export_handle->partition_manifest->partition_size;
+
+	return( 1 );
+}
+
+/* Sets the header codepage
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_header_codepage(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_header_codepage";
+	int result            = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = ewfinput_determine_header_codepage(
+	          string,
+	          &export_handle->header_codepage,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine header codepage.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Sets the process buffer size
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
  */
 int export_handle_set_process_buffer_size(
      export_handle_t *export_handle,
@@ -3193,7 +4166,35 @@ int export_handle_set_number_of_threads(
 	string_length = system_string_length(
 	                 string );
 
-	if( string[ 0 ] != (system_character_t) '-' )
+	if( ( string_length == 4 )
+	 && ( system_string_compare(
+	       string,
+	       _SYSTEM_STRING( "auto" ),
+	       4 ) == 0 ) )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		/* The process thread pools are created with the maximum number of threads
+		 * of which the thread autotune determines how many process at the same time
+		 */
+		if( thread_autotune_get_maximum_number_of_threads(
+		     &( export_handle->number_of_threads ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine maximum number of threads.",
+			 function );
+
+			return( -1 );
+		}
+		export_handle->autotune_number_of_threads = 1;
+
+		result = 1;
+#endif
+	}
+	else if( string[ 0 ] != (system_character_t) '-' )
 	{
 		string_length = system_string_length(
 				 string );
@@ -3545,6 +4546,7 @@ int export_handle_set_output_values(
 
 	static char *function      = "export_handle_set_output_values";
 	size_t value_string_length = 0;
+	int output_index           = 0;
 	int result                 = 0;
 
 	if( export_handle == NULL )
@@ -3995,6 +4997,31 @@ int export_handle_set_output_values(
 			return( -1 );
 		}
 	}
+	for( output_index = 0;
+	     output_index < export_handle->number_of_additional_outputs;
+	     output_index++ )
+	{
+		if( export_output_set_values(
+		     export_handle->additional_outputs[ output_index ],
+		     export_handle->input_handle,
+		     (size64_t) export_handle->export_size,
+		     export_handle->sectors_per_chunk,
+		     export_handle->header_codepage,
+		     acquiry_software,
+		     acquiry_software_version,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set output values of additional output: %d.",
+			 function,
+			 output_index );
+
+			return( -1 );
+		}
+	}
 	return( 1 );
 }
 
@@ -4009,8 +5036,9 @@ int export_handle_set_hash_value(
      size_t hash_value_length,
      libcerror_error_t **error )
 {
-	static char *function = "export_handle_set_hash_value";
-	int result            = 0;
+	libewf_handle_t *ewf_handle = NULL;
+	static char *function       = "export_handle_set_hash_value";
+	int result                  = 0;
 
 	if( export_handle == NULL )
 	{
@@ -4025,9 +5053,19 @@ int export_handle_set_hash_value(
 	}
 	if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
 	{
+		/* A rebuilt input stores the hash values itself
+		 */
+		if( export_handle->rebuild_input != 0 )
+		{
+			ewf_handle = export_handle->input_handle;
+		}
+		else
+		{
+			ewf_handle = export_handle->ewf_output_handle;
+		}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 		result = libewf_handle_set_utf16_hash_value(
-		          export_handle->ewf_output_handle,
+		          ewf_handle,
 		          (uint8_t *) hash_value_identifier,
 		          hash_value_identifier_length,
 		          (uint16_t *) hash_value,
@@ -4035,7 +5073,7 @@ int export_handle_set_hash_value(
 		          error );
 #else
 		result = libewf_handle_set_utf8_hash_value(
-		          export_handle->ewf_output_handle,
+		          ewf_handle,
 		          (uint8_t *) hash_value_identifier,
 		          hash_value_identifier_length,
 		          (uint8_t *) hash_value,
@@ -4199,6 +5237,7 @@ ssize_t export_handle_write(
 	size_t write_size     = 0;
 	ssize_t process_count = 0;
 	ssize_t write_count   = 0;
+	int result            = 0;
 
 	if( export_handle == NULL )
 	{
@@ -4238,7 +5277,40 @@ ssize_t export_handle_write(
 	}
 	while( input_size > 0 )
 	{
-		if( input_storage_media_buffer->mode == STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA )
+		result = 0;
+
+		/* A whole input chunk that maps onto a whole output chunk is copied
+		 * without being recompressed when its packed data can be reused
+		 */
+		if( ( input_storage_media_buffer->mode == STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA )
+		 && ( export_handle->copy_packed_chunks != 0 )
+		 && ( output_storage_media_buffer->raw_buffer_data_size == 0 )
+		 && ( input_size == input_storage_media_buffer->processed_size ) )
+		{
+			result = libewf_data_chunk_copy_packed_data(
+			          output_storage_media_buffer->data_chunk,
+			          input_storage_media_buffer->data_chunk,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+				 "%s: unable to copy packed data from input to output data chunk.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( result != 0 )
+		{
+			output_storage_media_buffer->processed_size = input_size;
+
+			process_count = (ssize_t) input_size;
+		}
+		else if( input_storage_media_buffer->mode == STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA )
 		{
 			if( input_size > (size_t) export_handle->output_chunk_size )
 			{
@@ -4352,8 +5424,14 @@ ssize_t export_handle_finalize(
          export_handle_t *export_handle,
          libcerror_error_t **error )
 {
-	static char *function = "export_handle_finalize";
-	ssize_t write_count   = 0;
+	system_character_t *md5_hash_string    = NULL;
+	system_character_t *sha1_hash_string   = NULL;
+	system_character_t *sha256_hash_string = NULL;
+	libewf_handle_t *ewf_handle            = NULL;
+	static char *function                  = "export_handle_finalize";
+	ssize_t write_count                    = 0;
+	uint8_t zero_byte                      = 0;
+	int output_index                       = 0;
 
 	if( export_handle == NULL )
 	{
@@ -4428,8 +5506,16 @@ ssize_t export_handle_finalize(
 	}
 	if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
 	{
+		if( export_handle->rebuild_input != 0 )
+		{
+			ewf_handle = export_handle->input_handle;
+		}
+		else
+		{
+			ewf_handle = export_handle->ewf_output_handle;
+		}
 		write_count = libewf_handle_write_finalize(
-		               export_handle->ewf_output_handle,
+		               ewf_handle,
 	        	       error );
 
 		if( write_count < 0 )
@@ -4444,38 +5530,351 @@ ssize_t export_handle_finalize(
 			return( -1 );
 		}
 	}
+	else if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_RAW )
+	{
+		/* A trailing sparse hole is terminated by writing its last byte
+		 * so that the raw output has the full size
+		 */
+		if( export_handle->sparse_hole_size > 0 )
+		{
+			export_handle->sparse_hole_size -= 1;
+
+			if( export_handle_skip_sparse_hole(
+			     export_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_SEEK_FAILED,
+				 "%s: unable to skip sparse hole.",
+				 function );
+
+				return( -1 );
+			}
+			write_count = libsmraw_handle_write_buffer(
+			               export_handle->raw_output_handle,
+			               &zero_byte,
+			               1,
+			               error );
+
+			if( write_count != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write end of sparse hole.",
+				 function );
+
+				return( -1 );
+			}
+			write_count = 0;
+		}
+	}
+	else if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_BLOCKED_GZIP )
+	{
+		/* Closing the blocked gzip output writes the end of file block and the index
+		 */
+		if( blocked_gzip_output_close(
+		     export_handle->blocked_gzip_output,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to finalize blocked gzip output.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( export_handle->calculate_md5 != 0 )
+	{
+		md5_hash_string = export_handle->calculated_md5_hash_string;
+	}
+	if( export_handle->calculate_sha1 != 0 )
+	{
+		sha1_hash_string = export_handle->calculated_sha1_hash_string;
+	}
+	if( export_handle->calculate_sha256 != 0 )
+	{
+		sha256_hash_string = export_handle->calculated_sha256_hash_string;
+	}
+	for( output_index = 0;
+	     output_index < export_handle->number_of_additional_outputs;
+	     output_index++ )
+	{
+		if( export_output_finalize(
+		     export_handle->additional_outputs[ output_index ],
+		     md5_hash_string,
+		     sha1_hash_string,
+		     sha256_hash_string,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to finalize additional output: %d.",
+			 function,
+			 output_index );
+
+			return( -1 );
+		}
+	}
+	if( export_handle->partition_manifest_filename != NULL )
+	{
+		if( partition_manifest_write_file(
+		     export_handle->partition_manifest,
+		     export_handle->partition_manifest_filename,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write partition manifest: %" PRIs_SYSTEM ".",
+			 function,
+			 export_handle->partition_manifest_filename );
+
+			return( -1 );
+		}
+	}
 	return( write_count );
 }
 
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 
-/* Prepares a storage media buffer for export
- * Callback function for the process thread pool
+/* Compresses the data of a storage media buffer for the blocked gzip output
+ * This is done by the process threads so that the output callback only needs to write the compressed data
  * Returns 1 if successful or -1 on error
  */
-int export_handle_process_storage_media_buffer_callback(
+int export_handle_compress_storage_media_buffer(
+     export_handle_t *export_handle,
      storage_media_buffer_t *storage_media_buffer,
-     export_handle_t *export_handle )
+     libcerror_error_t **error )
 {
-        libcerror_error_t *error = NULL;
-        static char *function    = "export_handle_process_storage_media_buffer_callback";
-	ssize_t process_count    = 0;
+	static char *function          = "export_handle_compress_storage_media_buffer";
+	size_t maximum_compressed_size = 0;
+	ssize_t compressed_data_size   = 0;
 
-	if( storage_media_buffer == NULL )
+	if( export_handle == NULL )
 	{
 		libcerror_error_set(
-		 &error,
+		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid storage media buffer.",
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->blocked_gzip_output == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid export handle - missing blocked gzip output.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	storage_media_buffer->compressed_buffer_input_size = 0;
+
+	/* Byte pairs are swapped by the output callback, in which case
+	 * the data is compressed when it is written
+	 */
+	if( ( export_handle->swap_byte_pairs != 0 )
+	 || ( storage_media_buffer->mode != STORAGE_MEDIA_BUFFER_MODE_BUFFERED )
+	 || ( storage_media_buffer->raw_buffer_data_size == 0 ) )
+	{
+		return( 1 );
+	}
+	maximum_compressed_size = blocked_gzip_get_maximum_compressed_size(
+	                           storage_media_buffer->raw_buffer_data_size );
+
+	if( maximum_compressed_size > storage_media_buffer->compressed_buffer_size )
+	{
+		if( storage_media_buffer->compressed_buffer != NULL )
+		{
+			memory_free(
+			 storage_media_buffer->compressed_buffer );
+
+			storage_media_buffer->compressed_buffer      = NULL;
+			storage_media_buffer->compressed_buffer_size = 0;
+		}
+		storage_media_buffer->compressed_buffer = (uint8_t *) memory_allocate(
+		                                                       sizeof( uint8_t ) * maximum_compressed_size );
+
+		if( storage_media_buffer->compressed_buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create compressed buffer.",
+			 function );
+
+			return( -1 );
+		}
+		storage_media_buffer->compressed_buffer_size = maximum_compressed_size;
+	}
+	compressed_data_size = blocked_gzip_compress(
+	                        storage_media_buffer->raw_buffer,
+	                        storage_media_buffer->raw_buffer_data_size,
+	                        export_handle->blocked_gzip_output->compression_level,
+	                        storage_media_buffer->compressed_buffer,
+	                        storage_media_buffer->compressed_buffer_size,
+	                        error );
+
+	if( compressed_data_size < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+		 "%s: unable to compress data.",
+		 function );
+
+		return( -1 );
+	}
+	storage_media_buffer->compressed_buffer_data_size  = (size_t) compressed_data_size;
+	storage_media_buffer->compressed_buffer_input_size = storage_media_buffer->raw_buffer_data_size;
+
+	return( 1 );
+}
+
+/* Prepares a storage media buffer for export
+ * Callback function for the process thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_process_storage_media_buffer_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     export_handle_t *export_handle )
+{
+        libcerror_error_t *error         = NULL;
+        static char *function            = "export_handle_process_storage_media_buffer_callback";
+	ssize_t process_count            = 0;
+	int64_t autotune_start_timestamp = 0;
+	int64_t stats_start_timestamp    = 0;
+
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
 		 function );
 
 		goto on_error;
 	}
+	/* Keep the decompression of the storage media buffer on the node that owns its memory
+	 */
+	if( export_handle->numa_topology != NULL )
+	{
+		if( numa_topology_bind_current_thread(
+		     export_handle->numa_topology,
+		     storage_media_buffer->node_index,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to bind thread to NUMA node: %d.",
+			 function,
+			 storage_media_buffer->node_index );
+
+			goto on_error;
+		}
+	}
+	if( export_handle->thread_autotune != NULL )
+	{
+		if( thread_autotune_acquire(
+		     export_handle->thread_autotune,
+		     &autotune_start_timestamp,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to acquire thread autotune slot.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( export_handle->stats_output != NULL )
+	{
+		if( ewftools_timestamp_get_monotonic(
+		     &stats_start_timestamp,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve statistics start timestamp.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	process_count = storage_media_buffer_read_process(
 			 storage_media_buffer,
 			 &error );
 
+	if( ( process_count >= 0 )
+	 && ( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_BLOCKED_GZIP ) )
+	{
+		if( export_handle_compress_storage_media_buffer(
+		     export_handle,
+		     storage_media_buffer,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+			 "%s: unable to compress storage media buffer.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( export_handle->thread_autotune != NULL )
+	{
+		if( thread_autotune_release(
+		     export_handle->thread_autotune,
+		     autotune_start_timestamp,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release thread autotune slot.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( process_count < 0 )
 	{
 #if defined( HAVE_VERBOSE_OUTPUT )
@@ -4506,6 +5905,25 @@ int export_handle_process_storage_media_buffer_callback(
 			goto on_error;
 		}
 	}
+	if( export_handle->stats_output != NULL )
+	{
+		if( stats_output_add_stage(
+		     export_handle->stats_output,
+		     STATS_OUTPUT_STAGE_PROCESS,
+		     (size64_t) storage_media_buffer->processed_size,
+		     stats_start_timestamp,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to add process to statistics output.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( libcthreads_thread_pool_push_sorted(
 	     export_handle->output_thread_pool,
 	     (intptr_t *) storage_media_buffer,
@@ -4577,6 +5995,7 @@ int export_handle_output_storage_media_buffer_callback(
         static char *function                               = "export_handle_process_storage_media_buffer_callback";
 	size_t data_size                                    = 0;
 	ssize_t write_count                                 = 0;
+	int number_of_pending_buffers                       = 0;
 
 	if( export_handle == NULL )
 	{
@@ -4725,6 +6144,23 @@ int export_handle_output_storage_media_buffer_callback(
 		}
 		export_handle->last_offset_hashed = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
 
+		if( export_handle_write_additional_outputs(
+		     export_handle,
+		     data,
+		     storage_media_buffer->processed_size,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write to additional outputs.",
+			 function );
+
+			storage_media_buffer = NULL;
+
+			goto on_error;
+		}
 		if( export_handle->use_chunk_data_functions != 0 )
 		{
 			if( storage_media_buffer_initialize(
@@ -4865,6 +6301,57 @@ int export_handle_output_storage_media_buffer_callback(
 
 			goto on_error;
 		}
+		if( export_handle->thread_autotune != NULL )
+		{
+			if( thread_autotune_update(
+			     export_handle->thread_autotune,
+			     (size64_t) export_handle->last_offset_hashed,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update thread autotune.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	/* The storage media buffer that ended the loop remains in the output list
+	 */
+	storage_media_buffer = NULL;
+
+	/* The buffers that remain in the output list wait on the buffer with the next offset
+	 */
+	if( libcdata_list_get_number_of_elements(
+	     export_handle->output_list,
+	     &number_of_pending_buffers,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of pending buffers.",
+		 function );
+
+		goto on_error;
+	}
+	if( storage_media_buffer_queue_update_output_stall(
+	     export_handle->storage_media_buffer_queue,
+	     number_of_pending_buffers,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update output stall.",
+		 function );
+
+		goto on_error;
 	}
 	return( 1 );
 
@@ -5039,33 +6526,20 @@ int export_handle_empty_output_list(
 	return( 1 );
 }
 
-#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
-
-/* Exports the input
+/* Creates the input process thread pools
+ * A input process thread pool is created for every NUMA node, the threads of which
+ * process the storage media buffers of that node
  * Returns 1 if successful or -1 on error
  */
-int export_handle_export_input(
+int export_handle_create_input_process_thread_pools(
      export_handle_t *export_handle,
-     uint8_t swap_byte_pairs,
-     uint8_t print_status_information,
-     log_handle_t *log_handle,
+     int maximum_number_of_queued_items,
      libcerror_error_t **error )
 {
-	storage_media_buffer_t *input_storage_media_buffer  = NULL;
-	storage_media_buffer_t *output_storage_media_buffer = NULL;
-	uint8_t *data                                       = NULL;
-	static char *function                               = "export_handle_export_input";
-	off64_t input_storage_media_offset                  = 0;
-	size64_t remaining_export_size                      = 0;
-	size_t process_buffer_size                          = 0;
-	size_t data_size                                    = 0;
-	size_t read_size                                    = 0;
-	ssize_t process_count                               = 0;
-	ssize_t read_count                                  = 0;
-	ssize_t write_count                                 = 0;
-	uint8_t storage_media_buffer_mode                   = 0;
-	int maximum_number_of_queued_items                  = 0;
-	int status                                          = PROCESS_STATUS_COMPLETED;
+	static char *function = "export_handle_create_input_process_thread_pools";
+	int node_index        = 0;
+	int number_of_nodes   = 0;
+	int number_of_threads = 0;
 
 	if( export_handle == NULL )
 	{
@@ -5078,58 +6552,347 @@ int export_handle_export_input(
 
 		return( -1 );
 	}
-	if( export_handle->input_chunk_size == 0 )
+	if( export_handle->number_of_input_process_thread_pools != 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing input chunk size.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export handle - input process thread pools value already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( export_handle->input_chunk_size > (size32_t) INT32_MAX )
+	if( numa_topology_initialize(
+	     &( export_handle->numa_topology ),
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid input chunk size value exceeds maximum.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create NUMA topology.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( export_handle->process_buffer_size > (size_t) SSIZE_MAX )
+	if( numa_topology_get_number_of_nodes(
+	     export_handle->numa_topology,
+	     &number_of_nodes,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid export handle - process buffer size value exceeds maximum.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of NUMA nodes.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#if !defined( HAVE_MULTI_THREAD_SUPPORT )
-	if( export_handle->number_of_threads != 0 )
+	/* Do not create more input process thread pools than process threads
+	 */
+	if( number_of_nodes > export_handle->number_of_threads )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: multi-threading not supported.",
-		 function );
+		number_of_nodes = export_handle->number_of_threads;
 
-		return( -1 );
-	}
-#endif
-	if( ( export_handle->export_size > export_handle->input_media_size )
-	 || ( export_handle->export_size > (ssize64_t) INT64_MAX ) )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		if( numa_topology_set_maximum_number_of_nodes(
+		     export_handle->numa_topology,
+		     number_of_nodes,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of NUMA nodes.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	number_of_threads = export_handle->number_of_threads / number_of_nodes;
+
+	for( node_index = 0;
+	     node_index < number_of_nodes;
+	     node_index++ )
+	{
+		if( libcthreads_thread_pool_create(
+		     &( export_handle->input_process_thread_pools[ node_index ] ),
+		     NULL,
+		     number_of_threads,
+		     maximum_number_of_queued_items,
+		     (int (*)(intptr_t *, void *)) &export_handle_process_storage_media_buffer_callback,
+		     (void *) export_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize input process thread pool: %d.",
+			 function,
+			 node_index );
+
+			goto on_error;
+		}
+		export_handle->number_of_input_process_thread_pools += 1;
+	}
+	if( ( export_handle->autotune_number_of_threads != 0 )
+	 && ( export_handle->thread_autotune == NULL ) )
+	{
+		number_of_threads *= number_of_nodes;
+
+		if( thread_autotune_initialize(
+		     &( export_handle->thread_autotune ),
+		     number_of_threads,
+		     ( number_of_threads < 4 ) ? number_of_threads : 4,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread autotune.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	export_handle_join_input_process_thread_pools(
+	 export_handle,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Pushes a storage media buffer onto the input process thread pool of its NUMA node
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_push_input_process_thread_pools(
+     export_handle_t *export_handle,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_push_input_process_thread_pools";
+	int pool_index        = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->number_of_input_process_thread_pools <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid export handle - missing input process thread pools.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	pool_index = storage_media_buffer->node_index % export_handle->number_of_input_process_thread_pools;
+
+	if( libcthreads_thread_pool_push(
+	     export_handle->input_process_thread_pools[ pool_index ],
+	     (intptr_t *) storage_media_buffer,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push storage media buffer onto input process thread pool: %d queue.",
+		 function,
+		 pool_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Joins the input process thread pools and frees the NUMA topology
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_join_input_process_thread_pools(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_join_input_process_thread_pools";
+	int pool_index        = 0;
+	int result            = 1;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	for( pool_index = 0;
+	     pool_index < NUMA_TOPOLOGY_MAXIMUM_NUMBER_OF_NODES;
+	     pool_index++ )
+	{
+		if( export_handle->input_process_thread_pools[ pool_index ] != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( export_handle->input_process_thread_pools[ pool_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join input process thread pool: %d.",
+				 function,
+				 pool_index );
+
+				result = -1;
+			}
+		}
+	}
+	export_handle->number_of_input_process_thread_pools = 0;
+
+	if( export_handle->numa_topology != NULL )
+	{
+		if( numa_topology_free(
+		     &( export_handle->numa_topology ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free NUMA topology.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Exports the input
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_export_input(
+     export_handle_t *export_handle,
+     uint8_t swap_byte_pairs,
+     uint8_t print_status_information,
+     log_handle_t *log_handle,
+     libcerror_error_t **error )
+{
+	storage_media_buffer_t *input_storage_media_buffer  = NULL;
+	storage_media_buffer_t *output_storage_media_buffer = NULL;
+	uint8_t *data                                       = NULL;
+	static char *function                               = "export_handle_export_input";
+	off64_t input_storage_media_offset                  = 0;
+	size64_t remaining_export_size                      = 0;
+	size_t process_buffer_size                          = 0;
+	size_t data_size                                    = 0;
+	size_t read_size                                    = 0;
+	ssize_t process_count                               = 0;
+	ssize_t read_count                                  = 0;
+	int64_t stats_start_timestamp                       = 0;
+	ssize_t write_count                                 = 0;
+	uint8_t storage_media_buffer_mode                   = 0;
+	int initial_number_of_queued_items                  = 0;
+	int maximum_number_of_queued_items                  = 0;
+	int output_index                                    = 0;
+	int result                                          = 0;
+	int status                                          = PROCESS_STATUS_COMPLETED;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->input_chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing input chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->input_chunk_size > (size32_t) INT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid input chunk size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->process_buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid export handle - process buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->number_of_threads != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: multi-threading not supported.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( export_handle->export_size > export_handle->input_media_size )
+	 || ( export_handle->export_size > (ssize64_t) INT64_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
 		 "%s: invalid export handle - export size value out of bounds.",
 		 function );
@@ -5207,33 +6970,70 @@ int export_handle_export_input(
 		}
 		storage_media_buffer_mode = STORAGE_MEDIA_BUFFER_MODE_BUFFERED;
 	}
-#if defined( HAVE_MULTI_THREAD_SUPPORT )
-	if( export_handle->number_of_threads != 0 )
+	if( export_handle->use_huge_pages != 0 )
 	{
-		maximum_number_of_queued_items = 1 + ( ( 512 * 1024 * 1024 ) / process_buffer_size );
-
-		if( libcthreads_thread_pool_create(
-		     &( export_handle->input_process_thread_pool ),
-		     NULL,
-		     export_handle->number_of_threads,
-		     maximum_number_of_queued_items,
-		     (int (*)(intptr_t *, void *)) &export_handle_process_storage_media_buffer_callback,
-		     (void *) export_handle,
+		if( libewf_handle_set_use_huge_pages(
+		     export_handle->input_handle,
+		     1,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize input process thread pool.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set use huge pages.",
 			 function );
 
 			goto on_error;
 		}
-		if( libcthreads_thread_pool_create(
-		     &( export_handle->output_thread_pool ),
-		     NULL,
-		     1,
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->number_of_threads != 0 )
+	{
+		if( storage_media_buffer_queue_get_maximum_number_of_buffers(
+		     0,
+		     process_buffer_size,
+		     export_handle->number_of_threads + 1,
+		     &maximum_number_of_queued_items,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine maximum number of queued items.",
+			 function );
+
+			goto on_error;
+		}
+		/* The storage media buffer queue starts with a few buffers per process thread
+		 * and grows, up to the maximum number of queued items, when the output is stalled
+		 */
+		initial_number_of_queued_items = 4 * export_handle->number_of_threads;
+
+		if( initial_number_of_queued_items > maximum_number_of_queued_items )
+		{
+			initial_number_of_queued_items = maximum_number_of_queued_items;
+		}
+
+		if( export_handle_create_input_process_thread_pools(
+		     export_handle,
+		     maximum_number_of_queued_items,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize input process thread pools.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_thread_pool_create(
+		     &( export_handle->output_thread_pool ),
+		     NULL,
+		     1,
 		     maximum_number_of_queued_items,
 		     (int (*)(intptr_t *, void *)) &export_handle_output_storage_media_buffer_callback,
 		     (void *) export_handle,
@@ -5248,6 +7048,29 @@ int export_handle_export_input(
 
 			goto on_error;
 		}
+		/* Every additional output is written by its own writer thread
+		 * so that a slow output does not stall the other outputs
+		 */
+		for( output_index = 0;
+		     output_index < export_handle->number_of_additional_outputs;
+		     output_index++ )
+		{
+			if( export_output_start_writer_thread(
+			     export_handle->additional_outputs[ output_index ],
+			     maximum_number_of_queued_items,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to start writer thread of additional output: %d.",
+				 function,
+				 output_index );
+
+				goto on_error;
+			}
+		}
 		if( libcdata_list_initialize(
 		     &( export_handle->output_list ),
 		     error ) != 1 )
@@ -5264,9 +7087,12 @@ int export_handle_export_input(
 		if( storage_media_buffer_queue_initialize(
 		     &( export_handle->storage_media_buffer_queue ),
 		     export_handle->input_handle,
+		     export_handle->numa_topology,
+		     initial_number_of_queued_items,
 		     maximum_number_of_queued_items,
 		     storage_media_buffer_mode,
 		     process_buffer_size,
+		     export_handle->use_huge_pages,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -5278,10 +7104,62 @@ int export_handle_export_input(
 
 			goto on_error;
 		}
+		if( export_handle->stats_output != NULL )
+		{
+			if( stats_output_set_storage_media_buffer_queue(
+			     export_handle->stats_output,
+			     export_handle->storage_media_buffer_queue,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set storage media buffer queue in statistics output.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( export_handle->stream_writer != NULL )
+		{
+			if( stream_writer_set_storage_media_buffer_queue(
+			     export_handle->stream_writer,
+			     export_handle->storage_media_buffer_queue,
+			     maximum_number_of_queued_items,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set storage media buffer queue in stream writer.",
+				 function );
+
+				goto on_error;
+			}
+		}
 	}
 #endif
 	export_handle->swap_byte_pairs = swap_byte_pairs;
 
+	result = export_handle_can_copy_packed_chunks(
+	          export_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if packed chunks can be copied.",
+		 function );
+
+		goto on_error;
+	}
+	export_handle->copy_packed_chunks = (uint8_t) result;
+
 	if( export_handle_initialize_integrity_hash(
 	     export_handle,
 	     error ) != 1 )
@@ -5313,6 +7191,23 @@ int export_handle_export_input(
 
 		goto on_error;
 	}
+	if( export_handle->stats_output != NULL )
+	{
+		if( process_status_set_stats_output(
+		     export_handle->process_status,
+		     export_handle->stats_output,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set statistics output in process status.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( process_status_start(
 	     export_handle->process_status,
 	     error ) != 1 )
@@ -5389,6 +7284,22 @@ int export_handle_export_input(
 		{
 			read_size = (size_t) remaining_export_size;
 		}
+		if( export_handle->stats_output != NULL )
+		{
+			if( ewftools_timestamp_get_monotonic(
+			     &stats_start_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve statistics start timestamp.",
+				 function );
+
+				goto on_error;
+			}
+		}
 		read_count = storage_media_buffer_read_from_handle(
 		              input_storage_media_buffer,
 		              export_handle->input_handle,
@@ -5417,6 +7328,25 @@ int export_handle_export_input(
 
 			goto on_error;
 		}
+		if( export_handle->stats_output != NULL )
+		{
+			if( stats_output_add_stage(
+			     export_handle->stats_output,
+			     STATS_OUTPUT_STAGE_READ,
+			     (size64_t) read_count,
+			     stats_start_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to add read to statistics output.",
+				 function );
+
+				goto on_error;
+			}
+		}
 		input_storage_media_buffer->storage_media_offset = input_storage_media_offset;
 
 		input_storage_media_offset += read_count;
@@ -5425,16 +7355,16 @@ int export_handle_export_input(
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 		if( export_handle->number_of_threads != 0 )
 		{
-			if( libcthreads_thread_pool_push(
-			     export_handle->input_process_thread_pool,
-			     (intptr_t *) input_storage_media_buffer,
-			     error ) == -1 )
+			if( export_handle_push_input_process_thread_pools(
+			     export_handle,
+			     input_storage_media_buffer,
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to push storage media buffer onto input process thread pool queue.",
+				 "%s: unable to push storage media buffer onto input process thread pools.",
 				 function );
 
 				goto on_error;
@@ -5444,6 +7374,22 @@ int export_handle_export_input(
 		else
 #endif
 		{
+			if( export_handle->stats_output != NULL )
+			{
+				if( ewftools_timestamp_get_monotonic(
+				     &stats_start_timestamp,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve statistics start timestamp.",
+					 function );
+
+					goto on_error;
+				}
+			}
 			process_count = storage_media_buffer_read_process(
 			                 input_storage_media_buffer,
 			                 error );
@@ -5479,6 +7425,25 @@ int export_handle_export_input(
 					goto on_error;
 				}
 			}
+			if( export_handle->stats_output != NULL )
+			{
+				if( stats_output_add_stage(
+				     export_handle->stats_output,
+				     STATS_OUTPUT_STAGE_PROCESS,
+				     (size64_t) input_storage_media_buffer->processed_size,
+				     stats_start_timestamp,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to add process to statistics output.",
+					 function );
+
+					goto on_error;
+				}
+			}
 			if( storage_media_buffer_get_data(
 			     input_storage_media_buffer,
 			     &data,
@@ -5533,6 +7498,21 @@ int export_handle_export_input(
 			}
 			export_handle->last_offset_hashed += input_storage_media_buffer->processed_size;
 
+			if( export_handle_write_additional_outputs(
+			     export_handle,
+			     data,
+			     input_storage_media_buffer->processed_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write to additional outputs.",
+				 function );
+
+				goto on_error;
+			}
 			if( ( export_handle->use_chunk_data_functions != 0 )
 			 && ( output_storage_media_buffer == NULL ) )
 			{
@@ -5584,157 +7564,831 @@ int export_handle_export_input(
 				 "%s: unable to update process status.",
 				 function );
 
-				goto on_error;
-			}
+				goto on_error;
+			}
+		}
+  	}
+	if( output_storage_media_buffer != NULL )
+	{
+		if( storage_media_buffer_free(
+		     &output_storage_media_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free output storage media buffer.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( export_handle->number_of_threads == 0 )
+	{
+		if( storage_media_buffer_free(
+		     &input_storage_media_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input storage media buffer.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle_join_input_process_thread_pools(
+	     export_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join input process thread pools.",
+		 function );
+
+		goto on_error;
+	}
+	if( export_handle->output_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( export_handle->output_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join output thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( export_handle->output_list != NULL )
+	{
+		if( export_handle_empty_output_list(
+		     export_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to empty output list.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcdata_list_free(
+		     &( export_handle->output_list ),
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free output list.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( export_handle->storage_media_buffer_queue != NULL )
+	{
+		if( export_handle->stats_output != NULL )
+		{
+			if( stats_output_set_storage_media_buffer_queue(
+			     export_handle->stats_output,
+			     NULL,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set storage media buffer queue in statistics output.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( export_handle->stream_writer != NULL )
+		{
+			/* The pipe can still reference the pages of the spliced buffers
+			 * hence wait for the reader to consume them before freeing the queue
+			 */
+			if( stream_writer_release_spliced_buffers(
+			     export_handle->stream_writer,
+			     1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to release spliced buffers of stream writer.",
+				 function );
+
+				goto on_error;
+			}
+			if( stream_writer_set_storage_media_buffer_queue(
+			     export_handle->stream_writer,
+			     NULL,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set storage media buffer queue in stream writer.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( storage_media_buffer_queue_free(
+		     &( export_handle->storage_media_buffer_queue ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free storage media buffer queue.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	if( export_handle_finalize_integrity_hash(
+	     export_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize integrity hash(es).",
+		 function );
+
+		goto on_error;
+	}
+	write_count = export_handle_finalize(
+	               export_handle,
+	               error );
+
+	if( write_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to finalize.",
+		 function );
+
+		goto on_error;
+	}
+	if( export_handle->abort != 0 )
+	{
+		status = PROCESS_STATUS_ABORTED;
+	}
+	if( process_status_stop(
+	     export_handle->process_status,
+	     export_handle->last_offset_hashed,
+	     status,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to stop process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( process_status_free(
+	     &( export_handle->process_status ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( export_handle->abort == 0 )
+	{
+		if( export_handle_hash_values_fprint(
+		     export_handle,
+		     export_handle->notify_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print export hash values.",
+			 function );
+
+			goto on_error;
+		}
+		if( export_handle_checksum_errors_fprint(
+		     export_handle,
+		     export_handle->notify_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print export errors.",
+			 function );
+
+			goto on_error;
+		}
+		if( log_handle != NULL )
+		{
+			if( export_handle_hash_values_fprint(
+			     export_handle,
+			     log_handle->log_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print export has values in log handle.",
+				 function );
+
+				goto on_error;
+			}
+			if( export_handle_checksum_errors_fprint(
+			     export_handle,
+			     log_handle->log_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print export errors in log handle.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( output_storage_media_buffer != NULL )
+	{
+		storage_media_buffer_free(
+		 &output_storage_media_buffer,
+		 NULL );
+	}
+	if( ( export_handle->number_of_threads == 0 )
+	 && ( input_storage_media_buffer != NULL ) )
+	{
+		storage_media_buffer_free(
+		 &input_storage_media_buffer,
+		 NULL );
+	}
+	if( export_handle->process_status != NULL )
+	{
+		process_status_stop(
+		 export_handle->process_status,
+		 export_handle->last_offset_hashed,
+		 PROCESS_STATUS_FAILED,
+		 NULL );
+		process_status_free(
+		 &( export_handle->process_status ),
+		 NULL );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	export_handle_join_input_process_thread_pools(
+	 export_handle,
+	 NULL );
+	if( export_handle->output_thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &( export_handle->output_thread_pool ),
+		 NULL );
+	}
+	if( export_handle->output_list != NULL )
+	{
+		export_handle_empty_output_list(
+		 export_handle,
+		 NULL );
+		libcdata_list_free(
+		 &( export_handle->output_list ),
+		 NULL,
+		 NULL );
+	}
+	if( export_handle->storage_media_buffer_queue != NULL )
+	{
+		if( export_handle->stats_output != NULL )
+		{
+			stats_output_set_storage_media_buffer_queue(
+			 export_handle->stats_output,
+			 NULL,
+			 NULL );
+		}
+		if( export_handle->stream_writer != NULL )
+		{
+			stream_writer_release_spliced_buffers(
+			 export_handle->stream_writer,
+			 0,
+			 NULL );
+			stream_writer_set_storage_media_buffer_queue(
+			 export_handle->stream_writer,
+			 NULL,
+			 0,
+			 NULL );
+		}
+		storage_media_buffer_queue_free(
+		 &( export_handle->storage_media_buffer_queue ),
+		 NULL );
+	}
+	for( output_index = 0;
+	     output_index < export_handle->number_of_additional_outputs;
+	     output_index++ )
+	{
+		export_output_stop_writer_thread(
+		 export_handle->additional_outputs[ output_index ],
+		 NULL );
+	}
+#endif
+	return( -1 );
+}
+
+/* Rebuilds the trailing sections of the input in place
+ * The input must have been opened with rebuild input set, which truncates the last
+ * segment file after its last intact chunks section. The chunks before it are retained
+ * as-is and only read back to calculate the digest hash(es). The media data after
+ * the last intact chunk is written as zero bytes and marked as an acquiry error
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_rebuild_input(
+     export_handle_t *export_handle,
+     uint8_t print_status_information,
+     log_handle_t *log_handle,
+     libcerror_error_t **error )
+{
+	uint8_t *buffer              = NULL;
+	static char *function        = "export_handle_rebuild_input";
+	off64_t resume_offset        = 0;
+	off64_t storage_media_offset = 0;
+	size64_t media_size          = 0;
+	size_t buffer_size           = 0;
+	size_t read_size             = 0;
+	ssize_t read_count           = 0;
+	ssize_t write_count          = 0;
+	uint64_t number_of_sectors   = 0;
+	uint64_t start_sector        = 0;
+	uint32_t bytes_per_sector    = 0;
+	int status                   = PROCESS_STATUS_COMPLETED;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->rebuild_input == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid export handle - input not opened to be rebuilt.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->input_chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing input chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->process_buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid export handle - process buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_get_offset(
+	     export_handle->input_handle,
+	     &resume_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve offset of last intact chunk.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_media_size(
+	     export_handle->input_handle,
+	     &media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_bytes_per_sector(
+	     export_handle->input_handle,
+	     &bytes_per_sector,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve bytes per sector.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( resume_offset < 0 )
+	 || ( bytes_per_sector == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset of last intact chunk or bytes per sector value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	/* If the media size was not known when the input was written
+	 * the rebuilt input ends after the last intact chunk
+	 */
+	if( media_size == 0 )
+	{
+		media_size = (size64_t) resume_offset;
+	}
+	else if( (size64_t) resume_offset > media_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset of last intact chunk value exceeds media size.",
+		 function );
+
+		goto on_error;
+	}
+	buffer_size = export_handle->process_buffer_size;
+
+	if( buffer_size == 0 )
+	{
+		buffer_size = (size_t) export_handle->input_chunk_size;
+	}
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * buffer_size );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( export_handle_initialize_integrity_hash(
+	     export_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize integrity hash(es).",
+		 function );
+
+		goto on_error;
+	}
+	if( process_status_initialize(
+	     &( export_handle->process_status ),
+	     _SYSTEM_STRING( "Rebuild" ),
+	     _SYSTEM_STRING( "rebuilt" ),
+	     _SYSTEM_STRING( "Processed" ),
+	     stderr,
+	     print_status_information,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( process_status_start(
+	     export_handle->process_status,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to start process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_seek_offset(
+	     export_handle->input_handle,
+	     0,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek start of input.",
+		 function );
+
+		goto on_error;
+	}
+	/* Read back the intact chunks to calculate the digest hash(es)
+	 */
+	while( storage_media_offset < resume_offset )
+	{
+		if( export_handle->abort != 0 )
+		{
+			break;
+		}
+		read_size = buffer_size;
+
+		if( (size64_t) read_size > (size64_t) ( resume_offset - storage_media_offset ) )
+		{
+			read_size = (size_t) ( resume_offset - storage_media_offset );
 		}
-  	}
-	if( output_storage_media_buffer != NULL )
-	{
-		if( storage_media_buffer_free(
-		     &output_storage_media_buffer,
-		     error ) != 1 )
+		read_count = libewf_handle_read_buffer(
+		              export_handle->input_handle,
+		              buffer,
+		              read_size,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free output storage media buffer.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data at offset: %" PRIi64 ".",
+			 function,
+			 storage_media_offset );
 
 			goto on_error;
 		}
-	}
-	if( export_handle->number_of_threads == 0 )
-	{
-		if( storage_media_buffer_free(
-		     &input_storage_media_buffer,
+		if( export_handle_update_integrity_hash(
+		     export_handle,
+		     buffer,
+		     read_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free input storage media buffer.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update integrity hash(es).",
 			 function );
 
 			goto on_error;
 		}
-	}
-#if defined( HAVE_MULTI_THREAD_SUPPORT )
-	if( export_handle->input_process_thread_pool != NULL )
-	{
-		if( libcthreads_thread_pool_join(
-		     &( export_handle->input_process_thread_pool ),
+		storage_media_offset += (off64_t) read_size;
+
+		if( process_status_update(
+		     export_handle->process_status,
+		     (size64_t) storage_media_offset,
+		     media_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to join input process thread pool.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update process status.",
 			 function );
 
 			goto on_error;
 		}
 	}
-	if( export_handle->output_thread_pool != NULL )
+	/* The media data after the last intact chunk cannot be recovered
+	 */
+	if( ( export_handle->abort == 0 )
+	 && ( (size64_t) resume_offset < media_size ) )
 	{
-		if( libcthreads_thread_pool_join(
-		     &( export_handle->output_thread_pool ),
+		start_sector      = (uint64_t) resume_offset / bytes_per_sector;
+		number_of_sectors = ( media_size - (size64_t) resume_offset ) / bytes_per_sector;
+
+		if( ( ( media_size - (size64_t) resume_offset ) % bytes_per_sector ) != 0 )
+		{
+			number_of_sectors += 1;
+		}
+		if( libewf_handle_append_acquiry_error(
+		     export_handle->input_handle,
+		     start_sector,
+		     number_of_sectors,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to join output thread pool.",
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append acquiry error.",
 			 function );
 
 			goto on_error;
 		}
-	}
-	if( export_handle->output_list != NULL )
-	{
-		if( export_handle_empty_output_list(
-		     export_handle,
-		     error ) != 1 )
+		fprintf(
+		 export_handle->notify_stream,
+		 "Unable to recover sector(s): %" PRIu64 " - %" PRIu64 " (number: %" PRIu64 "), stored as zero bytes.\n",
+		 start_sector,
+		 start_sector + number_of_sectors - 1,
+		 number_of_sectors );
+
+		if( log_handle != NULL )
+		{
+			log_handle_printf(
+			 log_handle,
+			 "Unable to recover sector(s): %" PRIu64 " - %" PRIu64 " (number: %" PRIu64 "), stored as zero bytes.\n",
+			 start_sector,
+			 start_sector + number_of_sectors - 1,
+			 number_of_sectors );
+		}
+		if( memory_set(
+		     buffer,
+		     0,
+		     buffer_size ) == NULL )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to empty output list.",
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear buffer.",
 			 function );
 
 			goto on_error;
 		}
-		if( libcdata_list_free(
-		     &( export_handle->output_list ),
-		     NULL,
-		     error ) != 1 )
+		while( (size64_t) storage_media_offset < media_size )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free output list.",
-			 function );
+			if( export_handle->abort != 0 )
+			{
+				break;
+			}
+			read_size = buffer_size;
 
-			goto on_error;
+			if( (size64_t) read_size > ( media_size - (size64_t) storage_media_offset ) )
+			{
+				read_size = (size_t) ( media_size - (size64_t) storage_media_offset );
+			}
+			write_count = libewf_handle_write_buffer(
+			               export_handle->input_handle,
+			               buffer,
+			               read_size,
+			               error );
+
+			if( write_count != (ssize_t) read_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write data at offset: %" PRIi64 ".",
+				 function,
+				 storage_media_offset );
+
+				goto on_error;
+			}
+			if( export_handle_update_integrity_hash(
+			     export_handle,
+			     buffer,
+			     read_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update integrity hash(es).",
+				 function );
+
+				goto on_error;
+			}
+			storage_media_offset += (off64_t) read_size;
+
+			if( process_status_update(
+			     export_handle->process_status,
+			     (size64_t) storage_media_offset,
+			     media_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update process status.",
+				 function );
+
+				goto on_error;
+			}
 		}
 	}
-	if( export_handle->storage_media_buffer_queue != NULL )
+	memory_free(
+	 buffer );
+
+	buffer = NULL;
+
+	if( export_handle->abort == 0 )
 	{
-		if( storage_media_buffer_queue_free(
-		     &( export_handle->storage_media_buffer_queue ),
+		if( export_handle_finalize_integrity_hash(
+		     export_handle,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free storage media buffer queue.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to finalize integrity hash(es).",
 			 function );
 
 			goto on_error;
 		}
-	}
-#endif
-	if( export_handle_finalize_integrity_hash(
-	     export_handle,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to finalize integrity hash(es).",
-		 function );
-
-		goto on_error;
-	}
-	write_count = export_handle_finalize(
-	               export_handle,
-	               error );
+		/* Writes the table, hash and done sections of the last segment file
+		 * and corrects the preceding segment files
+		 */
+		write_count = export_handle_finalize(
+		               export_handle,
+		               error );
 
-	if( write_count < 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to finalize.",
-		 function );
+		if( write_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to finalize.",
+			 function );
 
-		goto on_error;
+			goto on_error;
+		}
 	}
-	if( export_handle->abort != 0 )
+	else
 	{
 		status = PROCESS_STATUS_ABORTED;
 	}
 	if( process_status_stop(
 	     export_handle->process_status,
-	     export_handle->last_offset_hashed,
+	     (size64_t) storage_media_offset,
 	     status,
 	     error ) != 1 )
 	{
@@ -5771,21 +8425,7 @@ int export_handle_export_input(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-			 "%s: unable to print export hash values.",
-			 function );
-
-			goto on_error;
-		}
-		if( export_handle_checksum_errors_fprint(
-		     export_handle,
-		     export_handle->notify_stream,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-			 "%s: unable to print export errors.",
+			 "%s: unable to print rebuild hash values.",
 			 function );
 
 			goto on_error;
@@ -5801,21 +8441,7 @@ int export_handle_export_input(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-				 "%s: unable to print export has values in log handle.",
-				 function );
-
-				goto on_error;
-			}
-			if( export_handle_checksum_errors_fprint(
-			     export_handle,
-			     log_handle->log_stream,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-				 "%s: unable to print export errors in log handle.",
+				 "%s: unable to print rebuild hash values in log handle.",
 				 function );
 
 				goto on_error;
@@ -5825,60 +8451,22 @@ int export_handle_export_input(
 	return( 1 );
 
 on_error:
-	if( output_storage_media_buffer != NULL )
-	{
-		storage_media_buffer_free(
-		 &output_storage_media_buffer,
-		 NULL );
-	}
-	if( ( export_handle->number_of_threads == 0 )
-	 && ( input_storage_media_buffer != NULL ) )
-	{
-		storage_media_buffer_free(
-		 &input_storage_media_buffer,
-		 NULL );
-	}
 	if( export_handle->process_status != NULL )
 	{
 		process_status_stop(
 		 export_handle->process_status,
-		 export_handle->last_offset_hashed,
+		 (size64_t) storage_media_offset,
 		 PROCESS_STATUS_FAILED,
 		 NULL );
 		process_status_free(
 		 &( export_handle->process_status ),
 		 NULL );
 	}
-#if defined( HAVE_MULTI_THREAD_SUPPORT )
-	if( export_handle->input_process_thread_pool != NULL )
-	{
-		libcthreads_thread_pool_join(
-		 &( export_handle->input_process_thread_pool ),
-		 NULL );
-	}
-	if( export_handle->output_thread_pool != NULL )
-	{
-		libcthreads_thread_pool_join(
-		 &( export_handle->output_thread_pool ),
-		 NULL );
-	}
-	if( export_handle->output_list != NULL )
-	{
-		export_handle_empty_output_list(
-		 export_handle,
-		 NULL );
-		libcdata_list_free(
-		 &( export_handle->output_list ),
-		 NULL,
-		 NULL );
-	}
-	if( export_handle->storage_media_buffer_queue != NULL )
+	if( buffer != NULL )
 	{
-		storage_media_buffer_queue_free(
-		 &( export_handle->storage_media_buffer_queue ),
-		 NULL );
+		memory_free(
+		 buffer );
 	}
-#endif
 	return( -1 );
 }
 
@@ -5984,6 +8572,23 @@ int export_handle_export_single_files(
 
 		goto on_error;
 	}
+	if( export_handle->stats_output != NULL )
+	{
+		if( process_status_set_stats_output(
+		     export_handle->process_status,
+		     export_handle->stats_output,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set statistics output in process status.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( process_status_start(
 	     export_handle->process_status,
 	     error ) != 1 )
@@ -6022,9 +8627,31 @@ int export_handle_export_single_files(
 	 "Created directory: %" PRIs_SYSTEM ".\n",
 	 sanitized_name );
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* In multi-threaded mode the directories are created while the file entries
+	 * are traversed, and the data of the files is exported afterwards by a thread pool
+	 */
+	if( export_handle->number_of_threads != 0 )
+	{
+		if( libcdata_array_initialize(
+		     &( export_handle->export_file_entries ),
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create export file entries array.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 	result = export_handle_export_file_entry(
 	          export_handle,
-	          file_entry,
+	          &file_entry,
 	          sanitized_name,
 	          sanitized_name_size,
 	          sanitized_name_size - 1,
@@ -6042,6 +8669,41 @@ int export_handle_export_single_files(
 
 		goto on_error;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->export_file_entries != NULL )
+	{
+		result = export_handle_export_file_entries_data(
+		          export_handle,
+		          log_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to export file entries data.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcdata_array_free(
+		     &( export_handle->export_file_entries ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &export_file_entry_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free export file entries array.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 	memory_free(
 	 sanitized_name );
 
@@ -6095,6 +8757,15 @@ int export_handle_export_single_files(
 	return( 1 );
 
 on_error:
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->export_file_entries != NULL )
+	{
+		libcdata_array_free(
+		 &( export_handle->export_file_entries ),
+		 (int (*)(intptr_t **, libcerror_error_t **)) &export_file_entry_free,
+		 NULL );
+	}
+#endif
 	if( export_handle->process_status != NULL )
 	{
 		process_status_stop(
@@ -6121,11 +8792,13 @@ on_error:
 }
 
 /* Exports a (single) file entry
+ * If the data of a file is exported by the file entry thread pool management of the file entry
+ * is taken over, in which case file_entry is set to NULL
  * Returns 1 if successful, 0 if not or -1 on error
  */
 int export_handle_export_file_entry(
      export_handle_t *export_handle,
-     libewf_file_entry_t *file_entry,
+     libewf_file_entry_t **file_entry,
      const system_character_t *export_path,
      size_t export_path_size,
      size_t file_entry_path_index,
@@ -6154,7 +8827,8 @@ int export_handle_export_file_entry(
 
 		return( -1 );
 	}
-	if( file_entry == NULL )
+	if( ( file_entry == NULL )
+	 || ( *file_entry == NULL ) )
 	{
 		libcerror_error_set(
 		 error,
@@ -6166,7 +8840,7 @@ int export_handle_export_file_entry(
 		return( -1 );
 	}
 	if( libewf_file_entry_get_type(
-	     file_entry,
+	     *file_entry,
 	     &file_entry_type,
 	     error ) != 1 )
 	{
@@ -6181,12 +8855,12 @@ int export_handle_export_file_entry(
 	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	result = libewf_file_entry_get_utf16_name_size(
-	          file_entry,
+	          *file_entry,
 	          &name_size,
 	          error );
 #else
 	result = libewf_file_entry_get_utf8_name_size(
-	          file_entry,
+	          *file_entry,
 	          &name_size,
 	          error );
 #endif
@@ -6219,13 +8893,13 @@ int export_handle_export_file_entry(
 		}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 		result = libewf_file_entry_get_utf16_name(
-		          file_entry,
+		          *file_entry,
 		          (uint16_t *) name,
 		          name_size,
 		          error );
 #else
 		result = libewf_file_entry_get_utf8_name(
-		          file_entry,
+		          *file_entry,
 		          (uint8_t *) name,
 		          name_size,
 		          error );
@@ -6363,11 +9037,28 @@ int export_handle_export_file_entry(
 			 "Single file: %" PRIs_SYSTEM "\n",
 			 &( target_path[ file_entry_path_index ] ) );
 
-			return_value = export_handle_export_file_entry_data(
-				        export_handle,
-			                file_entry,
-			                target_path,
-			                error );
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+			if( export_handle->export_file_entries != NULL )
+			{
+				/* The data is exported afterwards by the file entry thread pool
+				 */
+				return_value = export_handle_append_export_file_entry(
+				                export_handle,
+				                file_entry,
+				                target_path,
+				                target_path_size,
+				                file_entry_path_index,
+				                error );
+			}
+			else
+#endif
+			{
+				return_value = export_handle_export_file_entry_data(
+					        export_handle,
+				                *file_entry,
+				                target_path,
+				                error );
+			}
 
 			if( return_value == -1 )
 			{
@@ -6435,7 +9126,7 @@ int export_handle_export_file_entry(
 	{
 		result = export_handle_export_file_entry_sub_file_entries(
 		          export_handle,
-		          file_entry,
+		          *file_entry,
 		          target_path,
 		          target_path_size,
 		          file_entry_path_index,
@@ -6658,9 +9349,9 @@ int export_handle_export_file_entry_data(
 		}
 		while( file_entry_data_size > 0 )
 		{
-			if( file_entry_data_size >= EXPORT_HANDLE_BUFFER_SIZE )
+			if( file_entry_data_size >= (size64_t) process_buffer_size )
 			{
-				read_size = EXPORT_HANDLE_BUFFER_SIZE;
+				read_size = process_buffer_size;
 			}
 			else
 			{
@@ -6706,75 +9397,361 @@ int export_handle_export_file_entry_data(
 				 "%s: unable to write file entry data.",
 				 function );
 
-				goto on_error;
-			}
-		}
-		memory_free(
-		 file_entry_data );
+				goto on_error;
+			}
+		}
+		memory_free(
+		 file_entry_data );
+
+		file_entry_data = NULL;
+	}
+	if( libcfile_file_close(
+	     file,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_free(
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( file_entry_data != NULL )
+	{
+		memory_free(
+		 file_entry_data );
+	}
+	if( file != NULL )
+	{
+		libcfile_file_free(
+		 &file,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Exports a (single) file entry sub file entries
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int export_handle_export_file_entry_sub_file_entries(
+     export_handle_t *export_handle,
+     libewf_file_entry_t *file_entry,
+     const system_character_t *export_path,
+     size_t export_path_size,
+     size_t file_entry_path_index,
+     log_handle_t *log_handle,
+     libcerror_error_t **error )
+{
+	libewf_file_entry_t *sub_file_entry = NULL;
+	static char *function               = "export_handle_export_file_entry_sub_file_entries";
+	int number_of_sub_file_entries      = 0;
+	int result                          = 0;
+	int return_value                    = 1;
+	int sub_file_entry_index            = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_file_entry_get_number_of_sub_file_entries(
+	     file_entry,
+	     &number_of_sub_file_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sub file entries.",
+		 function );
+
+		goto on_error;
+	}
+	for( sub_file_entry_index = 0;
+	     sub_file_entry_index < number_of_sub_file_entries;
+	     sub_file_entry_index++ )
+	{
+		if( libewf_file_entry_get_sub_file_entry(
+		     file_entry,
+		     sub_file_entry_index,
+		     &sub_file_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to free retrieve sub file entry: %d.",
+			 function,
+			 sub_file_entry_index );
+
+			goto on_error;
+		}
+		result = export_handle_export_file_entry(
+		          export_handle,
+		          &sub_file_entry,
+		          export_path,
+		          export_path_size,
+		          file_entry_path_index,
+		          log_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to export sub file entry: %d.",
+			 function,
+			 sub_file_entry_index );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			return_value = 0;
+		}
+		if( libewf_file_entry_free(
+		     &sub_file_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free sub file entry: %d.",
+			 function,
+			 sub_file_entry_index );
+
+			goto on_error;
+		}
+	}
+	return( return_value );
+
+on_error:
+	if( sub_file_entry != NULL )
+	{
+		libewf_file_entry_free(
+		 &sub_file_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Appends a (single) file entry of which the data is to be exported by the file entry thread pool
+ * The export file entry takes over management of the file entry, in which case file_entry is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_append_export_file_entry(
+     export_handle_t *export_handle,
+     libewf_file_entry_t **file_entry,
+     const system_character_t *target_path,
+     size_t target_path_size,
+     size_t file_entry_path_index,
+     libcerror_error_t **error )
+{
+	export_file_entry_t *export_file_entry = NULL;
+	static char *function                  = "export_handle_append_export_file_entry";
+	int entry_index                        = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->export_file_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid export handle - missing export file entries array.",
+		 function );
 
-		file_entry_data = NULL;
+		return( -1 );
 	}
-	if( libcfile_file_close(
-	     file,
-	     error ) != 0 )
+	if( file_entry == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
-		 "%s: unable to close file.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_file_entry_initialize(
+	     &export_file_entry,
+	     *file_entry,
+	     target_path,
+	     target_path_size,
+	     file_entry_path_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create export file entry.",
 		 function );
 
 		goto on_error;
 	}
-	if( libcfile_file_free(
-	     &file,
+	if( libcdata_array_append_entry(
+	     export_handle->export_file_entries,
+	     &entry_index,
+	     (intptr_t *) export_file_entry,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free file.",
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append export file entry to array.",
 		 function );
 
 		goto on_error;
 	}
-	return( result );
+	*file_entry = NULL;
+
+	return( 1 );
 
 on_error:
-	if( file_entry_data != NULL )
+	if( export_file_entry != NULL )
 	{
-		memory_free(
-		 file_entry_data );
+		/* The file entry is still managed by the caller
+		 */
+		export_file_entry->file_entry = NULL;
+
+		export_file_entry_free(
+		 &export_file_entry,
+		 NULL );
 	}
-	if( file != NULL )
+	return( -1 );
+}
+
+/* Exports the data of a batch of (single) file entries
+ * Callback function for the file entry thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_export_file_entry_callback(
+     export_file_entry_t *export_file_entry,
+     export_handle_t *export_handle )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "export_handle_export_file_entry_callback";
+
+	if( export_file_entry == NULL )
 	{
-		libcfile_file_free(
-		 &file,
-		 NULL );
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export file entry.",
+		 function );
+
+		goto on_error;
+	}
+	while( export_file_entry != NULL )
+	{
+		if( export_handle->abort != 0 )
+		{
+			break;
+		}
+		export_file_entry->result = export_handle_export_file_entry_data(
+		                             export_handle,
+		                             export_file_entry->file_entry,
+		                             export_file_entry->target_path,
+		                             &error );
+
+		if( export_file_entry->result == -1 )
+		{
+#if defined( HAVE_VERBOSE_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_print_error_backtrace(
+				 error );
+			}
+#endif
+			libcerror_error_free(
+			 &error );
+		}
+		export_file_entry = export_file_entry->next_export_file_entry;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
 	}
 	return( -1 );
 }
 
-/* Exports a (single) file entry sub file entries
+/* Exports the data of the (single) file entries using the file entry thread pool
+ * The file entries are sorted by their media data offset and split into batches
+ * so that every thread reads the media data sequentially and the chunks that
+ * are shared by small files are read and decompressed once
  * Returns 1 if successful, 0 if not or -1 on error
  */
-int export_handle_export_file_entry_sub_file_entries(
+int export_handle_export_file_entries_data(
      export_handle_t *export_handle,
-     libewf_file_entry_t *file_entry,
-     const system_character_t *export_path,
-     size_t export_path_size,
-     size_t file_entry_path_index,
      log_handle_t *log_handle,
      libcerror_error_t **error )
 {
-	libewf_file_entry_t *sub_file_entry = NULL;
-	static char *function               = "export_handle_export_file_entry_sub_file_entries";
-	int number_of_sub_file_entries      = 0;
-	int result                          = 0;
-	int return_value                    = 1;
-	int sub_file_entry_index            = 0;
+	export_file_entry_t **export_file_entries         = NULL;
+	export_file_entry_t *batch_export_file_entry      = NULL;
+	export_file_entry_t *export_file_entry            = NULL;
+	export_file_entry_t *last_export_file_entry       = NULL;
+	libcthreads_thread_pool_t *file_entry_thread_pool = NULL;
+	static char *function                             = "export_handle_export_file_entries_data";
+	size64_t batch_size                               = 0;
+	int entry_index                                   = 0;
+	int number_of_export_file_entries                 = 0;
+	int return_value                                  = 1;
 
 	if( export_handle == NULL )
 	{
@@ -6787,92 +9764,215 @@ int export_handle_export_file_entry_sub_file_entries(
 
 		return( -1 );
 	}
-	if( libewf_file_entry_get_number_of_sub_file_entries(
-	     file_entry,
-	     &number_of_sub_file_entries,
+	if( export_handle->number_of_threads <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid export handle - number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     export_handle->export_file_entries,
+	     &number_of_export_file_entries,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of sub file entries.",
+		 "%s: unable to retrieve number of export file entries.",
 		 function );
 
 		goto on_error;
 	}
-	for( sub_file_entry_index = 0;
-	     sub_file_entry_index < number_of_sub_file_entries;
-	     sub_file_entry_index++ )
+	if( number_of_export_file_entries == 0 )
 	{
-		if( libewf_file_entry_get_sub_file_entry(
-		     file_entry,
-		     sub_file_entry_index,
-		     &sub_file_entry,
+		return( 1 );
+	}
+	if( (size_t) number_of_export_file_entries > ( (size_t) SSIZE_MAX / sizeof( export_file_entry_t * ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of export file entries value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	export_file_entries = (export_file_entry_t **) memory_allocate(
+	                                                sizeof( export_file_entry_t * ) * number_of_export_file_entries );
+
+	if( export_file_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create export file entries.",
+		 function );
+
+		goto on_error;
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_export_file_entries;
+	     entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     export_handle->export_file_entries,
+		     entry_index,
+		     (intptr_t **) &( export_file_entries[ entry_index ] ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to free retrieve sub file entry: %d.",
+			 "%s: unable to retrieve export file entry: %d.",
 			 function,
-			 sub_file_entry_index );
+			 entry_index );
 
 			goto on_error;
 		}
-		result = export_handle_export_file_entry(
-		          export_handle,
-		          sub_file_entry,
-		          export_path,
-		          export_path_size,
-		          file_entry_path_index,
-		          log_handle,
-		          error );
+	}
+	qsort(
+	 export_file_entries,
+	 (size_t) number_of_export_file_entries,
+	 sizeof( export_file_entry_t * ),
+	 &export_file_entry_compare_by_media_data_offset );
 
-		if( result == -1 )
+	if( libcthreads_thread_pool_create(
+	     &file_entry_thread_pool,
+	     NULL,
+	     export_handle->number_of_threads,
+	     4 * export_handle->number_of_threads,
+	     (int (*)(intptr_t *, void *)) &export_handle_export_file_entry_callback,
+	     (void *) export_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize file entry thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	/* Consecutive file entries are combined into a batch until the size
+	 * of their media data reaches the batch size
+	 */
+	for( entry_index = 0;
+	     entry_index < number_of_export_file_entries;
+	     entry_index++ )
+	{
+		if( export_handle->abort != 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to export sub file entry: %d.",
-			 function,
-			 sub_file_entry_index );
+			break;
+		}
+		export_file_entry = export_file_entries[ entry_index ];
 
-			goto on_error;
+		if( batch_export_file_entry == NULL )
+		{
+			batch_export_file_entry = export_file_entry;
+			batch_size              = 0;
 		}
-		else if( result == 0 )
+		else
 		{
-			return_value = 0;
+			last_export_file_entry->next_export_file_entry = export_file_entry;
 		}
-		if( libewf_file_entry_free(
-		     &sub_file_entry,
-		     error ) != 1 )
+		last_export_file_entry = export_file_entry;
+		batch_size            += export_file_entry->media_data_size;
+
+		if( ( batch_size >= (size64_t) EXPORT_HANDLE_FILE_ENTRIES_BATCH_SIZE )
+		 || ( ( entry_index + 1 ) == number_of_export_file_entries ) )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free sub file entry: %d.",
-			 function,
-			 sub_file_entry_index );
+			if( libcthreads_thread_pool_push(
+			     file_entry_thread_pool,
+			     (intptr_t *) batch_export_file_entry,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push export file entry: %d onto file entry thread pool queue.",
+				 function,
+				 entry_index );
 
-			goto on_error;
+				goto on_error;
+			}
+			batch_export_file_entry = NULL;
+		}
+	}
+	if( libcthreads_thread_pool_join(
+	     &file_entry_thread_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join file entry thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	/* The failures are reported once all the threads have finished
+	 * so that they are not interleaved with the output of the traversal
+	 */
+	if( export_handle->abort == 0 )
+	{
+		for( entry_index = 0;
+		     entry_index < number_of_export_file_entries;
+		     entry_index++ )
+		{
+			export_file_entry = export_file_entries[ entry_index ];
+
+			if( export_file_entry->result != 1 )
+			{
+				fprintf(
+				 export_handle->notify_stream,
+				 "Single file: %" PRIs_SYSTEM " FAILED\n",
+				 &( export_file_entry->target_path[ export_file_entry->file_entry_path_index ] ) );
+
+				if( log_handle != NULL )
+				{
+					log_handle_printf(
+					 log_handle,
+					 "Single file: %" PRIs_SYSTEM " FAILED\n",
+					 &( export_file_entry->target_path[ export_file_entry->file_entry_path_index ] ) );
+				}
+				return_value = 0;
+			}
 		}
 	}
+	memory_free(
+	 export_file_entries );
+
 	return( return_value );
 
 on_error:
-	if( sub_file_entry != NULL )
+	if( file_entry_thread_pool != NULL )
 	{
-		libewf_file_entry_free(
-		 &sub_file_entry,
+		libcthreads_thread_pool_join(
+		 &file_entry_thread_pool,
 		 NULL );
 	}
+	if( export_file_entries != NULL )
+	{
+		memory_free(
+		 export_file_entries );
+	}
 	return( -1 );
 }
 
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 /* Print the hash values to a stream
  * Returns 1 if successful or -1 on error
  */
@@ -6959,6 +10059,15 @@ int export_handle_hash_values_fprint(
 		 "SHA256 hash calculated over data:\t%" PRIs_SYSTEM "\n",
 		 export_handle->calculated_sha256_hash_string );
 	}
+	if( export_handle->partition_manifest_filename != NULL )
+	{
+		fprintf(
+		 stream,
+		 "Partition %" PRIu32 " of %" PRIu32 " manifest:\t%" PRIs_SYSTEM "\n",
+		 export_handle->partition_manifest->partition_index,
+		 export_handle->partition_manifest->number_of_partitions,
+		 export_handle->partition_manifest_filename );
+	}
 	return( 1 );
 }
 
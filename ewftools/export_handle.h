@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "blocked_gzip.h"
 #include "digest_hash.h"
 #include "ewftools_libcdata.h"
 #include "ewftools_libcerror.h"
@@ -32,9 +33,18 @@
 #include "ewftools_libewf.h"
 #include "ewftools_libhmac.h"
 #include "ewftools_libsmraw.h"
+#include "export_file_entry.h"
+#include "export_output.h"
 #include "log_handle.h"
+#include "numa_topology.h"
+#include "partition_manifest.h"
 #include "process_status.h"
+#include "stats_output.h"
+#include "sha256_context.h"
 #include "storage_media_buffer.h"
+#include "storage_media_buffer_queue.h"
+#include "stream_writer.h"
+#include "thread_autotune.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -44,9 +54,14 @@ enum EXPORT_HANDLE_OUTPUT_FORMATS
 {
 	EXPORT_HANDLE_OUTPUT_FORMAT_EWF		= (int) 'e',
 	EXPORT_HANDLE_OUTPUT_FORMAT_FILES	= (int) 'f',
+	EXPORT_HANDLE_OUTPUT_FORMAT_BLOCKED_GZIP	= (int) 'g',
 	EXPORT_HANDLE_OUTPUT_FORMAT_RAW		= (int) 'r'
 };
 
+/* The maximum number of outputs that are written in addition to the primary output
+ */
+#define EXPORT_HANDLE_MAXIMUM_NUMBER_OF_ADDITIONAL_OUTPUTS	8
+
 typedef struct export_handle export_handle_t;
 
 struct export_handle
@@ -141,7 +156,7 @@ struct export_handle
 
 	/* The SHA256 digest context
 	 */
-	libhmac_sha256_context_t *sha256_context;
+	sha256_context_t *sha256_context;
 
 	/* Value to indicate the SHA256 digest context was initialized
 	 */
@@ -155,6 +170,14 @@ struct export_handle
 	 */
 	uint8_t use_chunk_data_functions;
 
+	/* Value to indicate if the chunk data and storage media buffers should be backed by huge pages
+	 */
+	uint8_t use_huge_pages;
+
+	/* Value to indicate if the packed input chunks should be copied to the output without being recompressed
+	 */
+	uint8_t copy_packed_chunks;
+
 	/* The process buffer size
 	 */
 	size_t process_buffer_size;
@@ -163,11 +186,27 @@ struct export_handle
 	 */
 	int number_of_threads;
 
+	/* Value to indicate the number of process threads is adjusted at runtime
+	 */
+	uint8_t autotune_number_of_threads;
+
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 
-	/* The input process thread pool
+	/* The NUMA topology
+	 */
+	numa_topology_t *numa_topology;
+
+	/* The input process thread pools, one per NUMA node
+	 */
+	libcthreads_thread_pool_t *input_process_thread_pools[ NUMA_TOPOLOGY_MAXIMUM_NUMBER_OF_NODES ];
+
+	/* The number of input process thread pools
 	 */
-	libcthreads_thread_pool_t *input_process_thread_pool;
+	int number_of_input_process_thread_pools;
+
+	/* The thread autotune
+	 */
+	thread_autotune_t *thread_autotune;
 
 	/* The output thread pool
 	 */
@@ -179,7 +218,11 @@ struct export_handle
 
 	/* The storage media buffer queue
 	 */
-	libcthreads_queue_t *storage_media_buffer_queue;
+	storage_media_buffer_queue_t *storage_media_buffer_queue;
+
+	/* The (single) file entries of which the data is exported by the file entry thread pool
+	 */
+	libcdata_array_t *export_file_entries;
 
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
@@ -187,6 +230,10 @@ struct export_handle
 	 */
 	libewf_handle_t *input_handle;
 
+	/* Value to indicate the input should be opened to rebuild its trailing sections in place
+	 */
+	uint8_t rebuild_input;
+
 	/* The libsmraw output handle
 	 */
 	libsmraw_handle_t *raw_output_handle;
@@ -195,10 +242,46 @@ struct export_handle
 	 */
 	uint8_t use_stdout;
 
+	/* The stream writer used to write to stdout
+	 */
+	stream_writer_t *stream_writer;
+
+	/* The blocked gzip output
+	 */
+	blocked_gzip_output_t *blocked_gzip_output;
+
+	/* Value to indicate if zero-filled data should be written as sparse holes in the raw output
+	 */
+	uint8_t sparse_output;
+
+	/* The size of the sparse hole that still needs to be skipped in the raw output
+	 */
+	size64_t sparse_hole_size;
+
 	/* The libewf output handle
 	 */
 	libewf_handle_t *ewf_output_handle;
 
+	/* The additional outputs, which are written from the same decoded and hashed data as the primary output
+	 */
+	export_output_t *additional_outputs[ EXPORT_HANDLE_MAXIMUM_NUMBER_OF_ADDITIONAL_OUTPUTS ];
+
+	/* The number of additional outputs
+	 */
+	int number_of_additional_outputs;
+
+	/* The partition manifest, which is set when only one of a number of partitions is exported
+	 */
+	partition_manifest_t *partition_manifest;
+
+	/* The partition manifest filename
+	 */
+	system_character_t *partition_manifest_filename;
+
+	/* The partition manifest filename size
+	 */
+	size_t partition_manifest_filename_size;
+
 	/* The input chunk size
 	 */
 	size32_t input_chunk_size;
@@ -243,6 +326,10 @@ struct export_handle
 	 */
 	process_status_t *process_status;
 
+	/* The statistics output, which is not managed by the export handle
+	 */
+	stats_output_t *stats_output;
+
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
@@ -287,6 +374,17 @@ int export_handle_close(
      export_handle_t *export_handle,
      libcerror_error_t **error );
 
+int export_handle_append_additional_output(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int export_handle_write_additional_outputs(
+     export_handle_t *export_handle,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
 ssize_t export_handle_read_storage_media_buffer(
          export_handle_t *export_handle,
          storage_media_buffer_t *storage_media_buffer,
@@ -305,6 +403,10 @@ ssize_t export_handle_write_storage_media_buffer(
          size_t write_size,
          libcerror_error_t **error );
 
+int export_handle_skip_sparse_hole(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
 off64_t export_handle_seek_offset(
          export_handle_t *export_handle,
          off64_t offset,
@@ -339,6 +441,10 @@ int export_handle_get_output_chunk_size(
      size32_t *chunk_size,
      libcerror_error_t **error );
 
+int export_handle_can_copy_packed_chunks(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
 int export_handle_prompt_for_string(
      export_handle_t *export_handle,
      const system_character_t *request_string,
@@ -418,6 +524,11 @@ int export_handle_set_export_size(
      const system_character_t *string,
      libcerror_error_t **error );
 
+int export_handle_set_partition(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
 int export_handle_set_header_codepage(
      export_handle_t *export_handle,
      const system_character_t *string,
@@ -474,6 +585,11 @@ ssize_t export_handle_finalize(
 
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 
+int export_handle_compress_storage_media_buffer(
+     export_handle_t *export_handle,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error );
+
 int export_handle_process_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      export_handle_t *export_handle );
@@ -486,6 +602,20 @@ int export_handle_empty_output_list(
      export_handle_t *export_handle,
      libcerror_error_t **error );
 
+int export_handle_create_input_process_thread_pools(
+     export_handle_t *export_handle,
+     int maximum_number_of_queued_items,
+     libcerror_error_t **error );
+
+int export_handle_push_input_process_thread_pools(
+     export_handle_t *export_handle,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error );
+
+int export_handle_join_input_process_thread_pools(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 int export_handle_export_input(
@@ -495,6 +625,12 @@ int export_handle_export_input(
      log_handle_t *log_handle,
      libcerror_error_t **error );
 
+int export_handle_rebuild_input(
+     export_handle_t *export_handle,
+     uint8_t print_status_information,
+     log_handle_t *log_handle,
+     libcerror_error_t **error );
+
 int export_handle_export_single_files(
      export_handle_t *export_handle,
      const system_character_t *export_path,
@@ -504,7 +640,7 @@ int export_handle_export_single_files(
 
 int export_handle_export_file_entry(
      export_handle_t *export_handle,
-     libewf_file_entry_t *file_entry,
+     libewf_file_entry_t **file_entry,
      const system_character_t *export_path,
      size_t export_path_size,
      size_t file_entry_path_index,
@@ -526,6 +662,27 @@ int export_handle_export_file_entry_sub_file_entries(
      log_handle_t *log_handle,
      libcerror_error_t **error );
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int export_handle_append_export_file_entry(
+     export_handle_t *export_handle,
+     libewf_file_entry_t **file_entry,
+     const system_character_t *target_path,
+     size_t target_path_size,
+     size_t file_entry_path_index,
+     libcerror_error_t **error );
+
+int export_handle_export_file_entry_callback(
+     export_file_entry_t *export_file_entry,
+     export_handle_t *export_handle );
+
+int export_handle_export_file_entries_data(
+     export_handle_t *export_handle,
+     log_handle_t *log_handle,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 int export_handle_hash_values_fprint(
      export_handle_t *export_handle,
      FILE *stream,
@@ -0,0 +1,1608 @@
+/*
+ * Export output
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+#include <wide_string.h>
+
+#include "byte_size_string.h"
+#include "ewfcommon.h"
+#include "ewfinput.h"
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libewf.h"
+#include "ewftools_libsmraw.h"
+#include "export_output.h"
+#include "guid.h"
+#include "storage_media_buffer.h"
+
+#define EXPORT_OUTPUT_VALUE_STRING_SIZE		64
+
+/* Creates an export output
+ * Make sure the value export_output is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int export_output_initialize(
+     export_output_t **export_output,
+     libcerror_error_t **error )
+{
+	static char *function = "export_output_initialize";
+
+	if( export_output == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export output.",
+		 function );
+
+		return( -1 );
+	}
+	if( *export_output != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export output value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*export_output = memory_allocate_structure(
+	                  export_output_t );
+
+	if( *export_output == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create export output.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *export_output,
+	     0,
+	     sizeof( export_output_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear export output.",
+		 function );
+
+		goto on_error;
+	}
+	( *export_output )->output_format        = EXPORT_OUTPUT_FORMAT_EWF;
+	( *export_output )->ewf_format           = LIBEWF_FORMAT_ENCASE6;
+	( *export_output )->compression_method   = LIBEWF_COMPRESSION_METHOD_DEFLATE;
+	( *export_output )->compression_level    = LIBEWF_COMPRESSION_NONE;
+	( *export_output )->maximum_segment_size = EWFCOMMON_DEFAULT_SEGMENT_FILE_SIZE;
+
+	return( 1 );
+
+on_error:
+	if( *export_output != NULL )
+	{
+		memory_free(
+		 *export_output );
+
+		*export_output = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an export output
+ * Returns 1 if successful or -1 on error
+ */
+int export_output_free(
+     export_output_t **export_output,
+     libcerror_error_t **error )
+{
+	static char *function = "export_output_free";
+	int result            = 1;
+
+	if( export_output == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export output.",
+		 function );
+
+		return( -1 );
+	}
+	if( *export_output != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *export_output )->writer_thread_pool != NULL )
+		{
+			if( export_output_stop_writer_thread(
+			     *export_output,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to stop writer thread.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		if( ( *export_output )->target_path != NULL )
+		{
+			memory_free(
+			 ( *export_output )->target_path );
+		}
+		if( ( *export_output )->ewf_output_handle != NULL )
+		{
+			if( libewf_handle_free(
+			     &( ( *export_output )->ewf_output_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free ewf output handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *export_output )->raw_output_handle != NULL )
+		{
+			if( libsmraw_handle_free(
+			     &( ( *export_output )->raw_output_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free raw output handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *export_output );
+
+		*export_output = NULL;
+	}
+	return( result );
+}
+
+/* Sets the export output from a specification string
+ * The specification consists of comma separated key=value pairs:
+ * format=raw or an EWF format, compression=level, segment_size=size
+ * and target=path, where the target is last and consists of the remainder of the string
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int export_output_set_specification(
+     export_output_t *export_output,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	system_character_t value_string[ EXPORT_OUTPUT_VALUE_STRING_SIZE ];
+
+	static char *function = "export_output_set_specification";
+	size_t key_length     = 0;
+	size_t key_start      = 0;
+	size_t string_index   = 0;
+	size_t string_length  = 0;
+	size_t value_length   = 0;
+	size_t value_start    = 0;
+	int result            = 0;
+
+	if( export_output == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export output.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_output->target_path != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export output - target path value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	while( string_index < string_length )
+	{
+		key_start = string_index;
+
+		while( ( string_index < string_length )
+		    && ( string[ string_index ] != (system_character_t) '=' ) )
+		{
+			string_index++;
+		}
+		if( string_index >= string_length )
+		{
+			return( 0 );
+		}
+		key_length = string_index - key_start;
+
+		string_index++;
+
+		if( ( key_length == 6 )
+		 && ( system_string_compare(
+		       &( string[ key_start ] ),
+		       _SYSTEM_STRING( "target" ),
+		       6 ) == 0 ) )
+		{
+			value_length = string_length - string_index;
+
+			/* Stdout is reserved for the primary output
+			 */
+			if( ( value_length == 0 )
+			 || ( ( value_length == 1 )
+			  &&  ( string[ string_index ] == (system_character_t) '-' ) ) )
+			{
+				return( 0 );
+			}
+			export_output->target_path = system_string_allocate(
+			                              value_length + 1 );
+
+			if( export_output->target_path == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create target path.",
+				 function );
+
+				return( -1 );
+			}
+			if( system_string_copy(
+			     export_output->target_path,
+			     &( string[ string_index ] ),
+			     value_length ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy target path.",
+				 function );
+
+				goto on_error;
+			}
+			( export_output->target_path )[ value_length ] = 0;
+
+			export_output->target_path_size = value_length + 1;
+
+			break;
+		}
+		value_start = string_index;
+
+		while( ( string_index < string_length )
+		    && ( string[ string_index ] != (system_character_t) ',' ) )
+		{
+			string_index++;
+		}
+		value_length = string_index - value_start;
+
+		/* Skip the value separator
+		 */
+		string_index++;
+
+		if( ( value_length == 0 )
+		 || ( value_length >= EXPORT_OUTPUT_VALUE_STRING_SIZE ) )
+		{
+			return( 0 );
+		}
+		if( system_string_copy(
+		     value_string,
+		     &( string[ value_start ] ),
+		     value_length ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy value string.",
+			 function );
+
+			return( -1 );
+		}
+		value_string[ value_length ] = 0;
+
+		result = 0;
+
+		if( ( key_length == 6 )
+		 && ( system_string_compare(
+		       &( string[ key_start ] ),
+		       _SYSTEM_STRING( "format" ),
+		       6 ) == 0 ) )
+		{
+			if( ( value_length == 3 )
+			 && ( system_string_compare(
+			       value_string,
+			       _SYSTEM_STRING( "raw" ),
+			       3 ) == 0 ) )
+			{
+				export_output->output_format = EXPORT_OUTPUT_FORMAT_RAW;
+				result                       = 1;
+			}
+			else
+			{
+				result = ewfinput_determine_ewf_format(
+				          value_string,
+				          &( export_output->ewf_format ),
+				          error );
+
+				if( result == 1 )
+				{
+					export_output->output_format = EXPORT_OUTPUT_FORMAT_EWF;
+				}
+			}
+		}
+		else if( ( key_length == 11 )
+		      && ( system_string_compare(
+		            &( string[ key_start ] ),
+		            _SYSTEM_STRING( "compression" ),
+		            11 ) == 0 ) )
+		{
+			result = ewfinput_determine_compression_values(
+			          value_string,
+			          &( export_output->compression_level ),
+			          &( export_output->compression_flags ),
+			          error );
+		}
+		else if( ( key_length == 12 )
+		      && ( system_string_compare(
+		            &( string[ key_start ] ),
+		            _SYSTEM_STRING( "segment_size" ),
+		            12 ) == 0 ) )
+		{
+			result = byte_size_string_convert(
+			          value_string,
+			          value_length,
+			          &( export_output->maximum_segment_size ),
+			          error );
+		}
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine value: %" PRIs_SYSTEM ".",
+			 function,
+			 value_string );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
+	}
+	if( export_output->target_path == NULL )
+	{
+		return( 0 );
+	}
+	if( export_output->output_format == EXPORT_OUTPUT_FORMAT_EWF )
+	{
+		if( ( export_output->maximum_segment_size < EWFCOMMON_MINIMUM_SEGMENT_FILE_SIZE )
+		 || ( ( export_output->ewf_format == LIBEWF_FORMAT_ENCASE6 )
+		  &&  ( export_output->maximum_segment_size >= (uint64_t) EWFCOMMON_MAXIMUM_SEGMENT_FILE_SIZE_64BIT ) )
+		 || ( ( export_output->ewf_format != LIBEWF_FORMAT_ENCASE6 )
+		  &&  ( export_output->maximum_segment_size >= (uint64_t) EWFCOMMON_MAXIMUM_SEGMENT_FILE_SIZE_32BIT ) ) )
+		{
+			return( 0 );
+		}
+	}
+	else if( export_output->output_format == EXPORT_OUTPUT_FORMAT_RAW )
+	{
+		if( export_output->maximum_segment_size >= (uint64_t) EWFCOMMON_MAXIMUM_SEGMENT_FILE_SIZE_64BIT )
+		{
+			return( 0 );
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( export_output->target_path != NULL )
+	{
+		memory_free(
+		 export_output->target_path );
+
+		export_output->target_path = NULL;
+	}
+	export_output->target_path_size = 0;
+
+	return( -1 );
+}
+
+/* Opens the export output
+ * Returns 1 if successful or -1 on error
+ */
+int export_output_open(
+     export_output_t *export_output,
+     libcerror_error_t **error )
+{
+	system_character_t *filenames[ 1 ] = { NULL };
+	static char *function              = "export_output_open";
+	int result                         = 0;
+
+	if( export_output == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export output.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_output->target_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid export output - missing target path.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( export_output->ewf_output_handle != NULL )
+	 || ( export_output->raw_output_handle != NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export output - output handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	filenames[ 0 ] = export_output->target_path;
+
+	if( export_output->output_format == EXPORT_OUTPUT_FORMAT_EWF )
+	{
+		if( libewf_handle_initialize(
+		     &( export_output->ewf_output_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create ewf output handle.",
+			 function );
+
+			goto on_error;
+		}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libewf_handle_open_wide(
+		          export_output->ewf_output_handle,
+		          filenames,
+		          1,
+		          LIBEWF_OPEN_WRITE,
+		          error );
+#else
+		result = libewf_handle_open(
+		          export_output->ewf_output_handle,
+		          filenames,
+		          1,
+		          LIBEWF_OPEN_WRITE,
+		          error );
+#endif
+	}
+	else if( export_output->output_format == EXPORT_OUTPUT_FORMAT_RAW )
+	{
+		if( libsmraw_handle_initialize(
+		     &( export_output->raw_output_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create raw output handle.",
+			 function );
+
+			goto on_error;
+		}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libsmraw_handle_open_wide(
+		          export_output->raw_output_handle,
+		          filenames,
+		          1,
+		          LIBSMRAW_OPEN_WRITE,
+		          error );
+#else
+		result = libsmraw_handle_open(
+		          export_output->raw_output_handle,
+		          filenames,
+		          1,
+		          LIBSMRAW_OPEN_WRITE,
+		          error );
+#endif
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file: %" PRIs_SYSTEM ".",
+		 function,
+		 export_output->target_path );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( export_output->raw_output_handle != NULL )
+	{
+		libsmraw_handle_free(
+		 &( export_output->raw_output_handle ),
+		 NULL );
+	}
+	if( export_output->ewf_output_handle != NULL )
+	{
+		libewf_handle_free(
+		 &( export_output->ewf_output_handle ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Closes the export output
+ * Returns the 0 if succesful or -1 on error
+ */
+int export_output_close(
+     export_output_t *export_output,
+     libcerror_error_t **error )
+{
+	static char *function = "export_output_close";
+
+	if( export_output == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export output.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_output->ewf_output_handle != NULL )
+	{
+		if( libewf_handle_close(
+		     export_output->ewf_output_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close ewf output handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( export_output->raw_output_handle != NULL )
+	{
+		if( libsmraw_handle_close(
+		     export_output->raw_output_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close raw output handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Sets the output values of the export output
+ * Returns 1 if successful or -1 on error
+ */
+int export_output_set_values(
+     export_output_t *export_output,
+     libewf_handle_t *input_handle,
+     size64_t media_size,
+     uint32_t sectors_per_chunk,
+     int header_codepage,
+     system_character_t *acquiry_software,
+     system_character_t *acquiry_software_version,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_GUID_SUPPORT ) || defined( WINAPI )
+	uint8_t guid[ GUID_SIZE ];
+
+	uint8_t guid_type          = 0;
+#endif
+
+	static char *function      = "export_output_set_values";
+	size_t value_string_length = 0;
+	int result                 = 0;
+
+	if( export_output == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export output.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_output->output_format == EXPORT_OUTPUT_FORMAT_EWF )
+	{
+		if( export_output->ewf_output_handle == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid export output - missing ewf output handle.",
+			 function );
+
+			return( -1 );
+		}
+		if( libewf_handle_copy_header_values(
+		     export_output->ewf_output_handle,
+		     input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy header values.",
+			 function );
+
+			return( -1 );
+		}
+		if( acquiry_software != NULL )
+		{
+			value_string_length = system_string_length(
+			                       acquiry_software );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+			result = libewf_handle_set_utf16_header_value(
+			          export_output->ewf_output_handle,
+			          (uint8_t *) "acquiry_software",
+			          16,
+			          (uint16_t *) acquiry_software,
+			          value_string_length,
+			          error );
+#else
+			result = libewf_handle_set_utf8_header_value(
+			          export_output->ewf_output_handle,
+			          (uint8_t *) "acquiry_software",
+			          16,
+			          (uint8_t *) acquiry_software,
+			          value_string_length,
+			          error );
+#endif
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set header value: acquiry software.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( acquiry_software_version != NULL )
+		{
+			value_string_length = system_string_length(
+			                       acquiry_software_version );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+			result = libewf_handle_set_utf16_header_value(
+			          export_output->ewf_output_handle,
+			          (uint8_t *) "acquiry_software_version",
+			          24,
+			          (uint16_t *) acquiry_software_version,
+			          value_string_length,
+			          error );
+#else
+			result = libewf_handle_set_utf8_header_value(
+			          export_output->ewf_output_handle,
+			          (uint8_t *) "acquiry_software_version",
+			          24,
+			          (uint8_t *) acquiry_software_version,
+			          value_string_length,
+			          error );
+#endif
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set header value: acquiry software version.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( libewf_handle_set_header_codepage(
+		     export_output->ewf_output_handle,
+		     header_codepage,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set header codepage.",
+			 function );
+
+			return( -1 );
+		}
+		if( libewf_handle_copy_media_values(
+		     export_output->ewf_output_handle,
+		     input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy media values.",
+			 function );
+
+			return( -1 );
+		}
+		if( libewf_handle_set_media_size(
+		     export_output->ewf_output_handle,
+		     media_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set media size.",
+			 function );
+
+			return( -1 );
+		}
+		/* Format needs to be set before segment file size and compression values
+		 */
+		if( libewf_handle_set_format(
+		     export_output->ewf_output_handle,
+		     export_output->ewf_format,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set format.",
+			 function );
+
+			return( -1 );
+		}
+		if( export_output->ewf_format != LIBEWF_FORMAT_V2_ENCASE7 )
+		{
+			export_output->compression_method = LIBEWF_COMPRESSION_METHOD_DEFLATE;
+		}
+		if( libewf_handle_set_compression_method(
+		     export_output->ewf_output_handle,
+		     export_output->compression_method,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set compression method.",
+			 function );
+
+			return( -1 );
+		}
+		if( libewf_handle_set_compression_values(
+		     export_output->ewf_output_handle,
+		     export_output->compression_level,
+		     export_output->compression_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set compression values.",
+			 function );
+
+			return( -1 );
+		}
+		if( libewf_handle_set_maximum_segment_size(
+		     export_output->ewf_output_handle,
+		     export_output->maximum_segment_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum segment size.",
+			 function );
+
+			return( -1 );
+		}
+		if( libewf_handle_set_sectors_per_chunk(
+		     export_output->ewf_output_handle,
+		     sectors_per_chunk,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set sectors per chunk.",
+			 function );
+
+			return( -1 );
+		}
+#if defined( HAVE_GUID_SUPPORT ) || defined( WINAPI )
+		if( ( export_output->ewf_format == LIBEWF_FORMAT_ENCASE5 )
+		 || ( export_output->ewf_format == LIBEWF_FORMAT_ENCASE6 )
+		 || ( export_output->ewf_format == LIBEWF_FORMAT_EWFX ) )
+		{
+			guid_type = GUID_TYPE_RANDOM;
+		}
+		else if( ( export_output->ewf_format == LIBEWF_FORMAT_LINEN5 )
+		      || ( export_output->ewf_format == LIBEWF_FORMAT_LINEN6 ) )
+		{
+			guid_type = GUID_TYPE_TIME;
+		}
+		if( guid_type != 0 )
+		{
+			/* Every output is a separate segment file set with its own identifier
+			 */
+			if( guid_generate(
+			     guid,
+			     GUID_SIZE,
+			     guid_type,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to generate GUID for set identifier.",
+				 function );
+
+				return( -1 );
+			}
+			if( libewf_handle_set_segment_file_set_identifier(
+			     export_output->ewf_output_handle,
+			     guid,
+			     16,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set segment file set identifier.",
+				 function );
+
+				return( -1 );
+			}
+		}
+#endif
+	}
+	else if( export_output->output_format == EXPORT_OUTPUT_FORMAT_RAW )
+	{
+		if( export_output->raw_output_handle == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid export output - missing raw output handle.",
+			 function );
+
+			return( -1 );
+		}
+		if( libsmraw_handle_set_media_size(
+		     export_output->raw_output_handle,
+		     media_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set media size.",
+			 function );
+
+			return( -1 );
+		}
+		if( libsmraw_handle_set_maximum_segment_size(
+		     export_output->raw_output_handle,
+		     export_output->maximum_segment_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum segment size.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Writes a buffer to the export output
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t export_output_write_buffer(
+         export_output_t *export_output,
+         const uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	static char *function = "export_output_write_buffer";
+	ssize_t write_count   = 0;
+
+	if( export_output == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export output.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_output->output_format == EXPORT_OUTPUT_FORMAT_EWF )
+	{
+		write_count = libewf_handle_write_buffer(
+		               export_output->ewf_output_handle,
+		               buffer,
+		               buffer_size,
+		               error );
+	}
+	else if( export_output->output_format == EXPORT_OUTPUT_FORMAT_RAW )
+	{
+		write_count = libsmraw_handle_write_buffer(
+		               export_output->raw_output_handle,
+		               buffer,
+		               buffer_size,
+		               error );
+	}
+	if( write_count != (ssize_t) buffer_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write buffer to: %" PRIs_SYSTEM ".",
+		 function,
+		 export_output->target_path );
+
+		return( -1 );
+	}
+	export_output->number_of_bytes_written += (size64_t) write_count;
+
+	return( write_count );
+}
+
+/* Writes data to the export output
+ * The data is queued to the writer thread if it was started, otherwise it is written directly
+ * Returns 1 if successful or -1 on error
+ */
+int export_output_write(
+     export_output_t *export_output,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	storage_media_buffer_t *storage_media_buffer = NULL;
+#endif
+
+	static char *function                        = "export_output_write";
+
+	if( export_output == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export output.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_output->write_failed != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write to: %" PRIs_SYSTEM ".",
+		 function,
+		 export_output->target_path );
+
+		return( -1 );
+	}
+	if( data_size == 0 )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_output->writer_thread_pool != NULL )
+	{
+		/* The data is copied since the buffer that contains it is reused
+		 * as soon as it was written to the primary output
+		 */
+		if( storage_media_buffer_initialize(
+		     &storage_media_buffer,
+		     NULL,
+		     STORAGE_MEDIA_BUFFER_MODE_BUFFERED,
+		     data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create storage media buffer.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     storage_media_buffer->raw_buffer,
+		     data,
+		     data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data to storage media buffer.",
+			 function );
+
+			goto on_error;
+		}
+		storage_media_buffer->raw_buffer_data_size = data_size;
+
+		if( libcthreads_thread_pool_push(
+		     export_output->writer_thread_pool,
+		     (intptr_t *) storage_media_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push storage media buffer onto writer thread pool queue.",
+			 function );
+
+			goto on_error;
+		}
+		return( 1 );
+	}
+#endif
+	if( export_output_write_buffer(
+	     export_output,
+	     data,
+	     data_size,
+	     error ) != (ssize_t) data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+on_error:
+	if( storage_media_buffer != NULL )
+	{
+		storage_media_buffer_free(
+		 &storage_media_buffer,
+		 NULL );
+	}
+	return( -1 );
+#endif
+}
+
+/* Sets a hash value in the export output
+ * Returns 1 if successful or -1 on error
+ */
+int export_output_set_hash_value(
+     export_output_t *export_output,
+     char *hash_value_identifier,
+     size_t hash_value_identifier_length,
+     const system_character_t *hash_value,
+     size_t hash_value_length,
+     libcerror_error_t **error )
+{
+	static char *function = "export_output_set_hash_value";
+	int result            = 0;
+
+	if( export_output == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export output.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_output->output_format == EXPORT_OUTPUT_FORMAT_EWF )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libewf_handle_set_utf16_hash_value(
+		          export_output->ewf_output_handle,
+		          (uint8_t *) hash_value_identifier,
+		          hash_value_identifier_length,
+		          (uint16_t *) hash_value,
+		          hash_value_length,
+		          error );
+#else
+		result = libewf_handle_set_utf8_hash_value(
+		          export_output->ewf_output_handle,
+		          (uint8_t *) hash_value_identifier,
+		          hash_value_identifier_length,
+		          (uint8_t *) hash_value,
+		          hash_value_length,
+		          error );
+#endif
+	}
+	else if( export_output->output_format == EXPORT_OUTPUT_FORMAT_RAW )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libsmraw_handle_set_utf16_integrity_hash_value(
+		          export_output->raw_output_handle,
+		          (uint8_t *) hash_value_identifier,
+		          hash_value_identifier_length,
+		          (uint16_t *) hash_value,
+		          hash_value_length,
+		          error );
+#else
+		result = libsmraw_handle_set_utf8_integrity_hash_value(
+		          export_output->raw_output_handle,
+		          (uint8_t *) hash_value_identifier,
+		          hash_value_identifier_length,
+		          (uint8_t *) hash_value,
+		          hash_value_length,
+		          error );
+#endif
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set hash value: %s.",
+		 function,
+		 hash_value_identifier );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Finalizes the export output
+ * Waits for the writer thread to write the queued data and stores the digest hashes,
+ * which are calculated once by the export handle for all outputs
+ * Returns 1 if successful or -1 on error
+ */
+int export_output_finalize(
+     export_output_t *export_output,
+     const system_character_t *md5_hash_string,
+     const system_character_t *sha1_hash_string,
+     const system_character_t *sha256_hash_string,
+     libcerror_error_t **error )
+{
+	static char *function = "export_output_finalize";
+
+	if( export_output == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export output.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_output->writer_thread_pool != NULL )
+	{
+		if( export_output_stop_writer_thread(
+		     export_output,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to stop writer thread.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	if( export_output->write_failed != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write to: %" PRIs_SYSTEM ".",
+		 function,
+		 export_output->target_path );
+
+		return( -1 );
+	}
+	if( md5_hash_string != NULL )
+	{
+		if( export_output_set_hash_value(
+		     export_output,
+		     "MD5",
+		     3,
+		     md5_hash_string,
+		     32,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set hash value: MD5.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( sha1_hash_string != NULL )
+	{
+		if( export_output_set_hash_value(
+		     export_output,
+		     "SHA1",
+		     4,
+		     sha1_hash_string,
+		     40,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set hash value: SHA1.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( sha256_hash_string != NULL )
+	{
+		if( export_output_set_hash_value(
+		     export_output,
+		     "SHA256",
+		     6,
+		     sha256_hash_string,
+		     64,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set hash value: SHA256.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( export_output->output_format == EXPORT_OUTPUT_FORMAT_EWF )
+	{
+		if( libewf_handle_write_finalize(
+		     export_output->ewf_output_handle,
+		     error ) < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to finalize EWF file(s).",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Starts the writer thread of the export output
+ * Returns 1 if successful or -1 on error
+ */
+int export_output_start_writer_thread(
+     export_output_t *export_output,
+     int maximum_number_of_queued_items,
+     libcerror_error_t **error )
+{
+	static char *function = "export_output_start_writer_thread";
+
+	if( export_output == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export output.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_output->writer_thread_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export output - writer thread pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_thread_pool_create(
+	     &( export_output->writer_thread_pool ),
+	     NULL,
+	     1,
+	     maximum_number_of_queued_items,
+	     (int (*)(intptr_t *, void *)) &export_output_write_storage_media_buffer_callback,
+	     (void *) export_output,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize writer thread pool.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Stops the writer thread of the export output after it has written the queued data
+ * Returns 1 if successful or -1 on error
+ */
+int export_output_stop_writer_thread(
+     export_output_t *export_output,
+     libcerror_error_t **error )
+{
+	static char *function = "export_output_stop_writer_thread";
+
+	if( export_output == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export output.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_output->writer_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( export_output->writer_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join writer thread pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Writes a storage media buffer to the export output
+ * Callback function for the writer thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int export_output_write_storage_media_buffer_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     export_output_t *export_output )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "export_output_write_storage_media_buffer_callback";
+
+	if( export_output == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export output.",
+		 function );
+
+		goto on_error;
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		goto on_error;
+	}
+	/* After a failed write the remaining queued data is discarded
+	 */
+	if( export_output->write_failed == 0 )
+	{
+		if( export_output_write_buffer(
+		     export_output,
+		     storage_media_buffer->raw_buffer,
+		     storage_media_buffer->raw_buffer_data_size,
+		     &error ) != (ssize_t) storage_media_buffer->raw_buffer_data_size )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write storage media buffer.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( storage_media_buffer_free(
+	     &storage_media_buffer,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free storage media buffer.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( export_output != NULL )
+	{
+		export_output->write_failed = 1;
+	}
+	if( storage_media_buffer != NULL )
+	{
+		storage_media_buffer_free(
+		 &storage_media_buffer,
+		 NULL );
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
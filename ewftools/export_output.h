@@ -0,0 +1,187 @@
+/*
+ * Export output
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _EXPORT_OUTPUT_H )
+#define _EXPORT_OUTPUT_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libewf.h"
+#include "ewftools_libsmraw.h"
+#include "storage_media_buffer.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+enum EXPORT_OUTPUT_FORMATS
+{
+	EXPORT_OUTPUT_FORMAT_EWF	= (int) 'e',
+	EXPORT_OUTPUT_FORMAT_RAW	= (int) 'r'
+};
+
+typedef struct export_output export_output_t;
+
+/* An export output is an additional output to which the export handle writes
+ * the same (decoded and hashed) media data as to its primary output
+ */
+struct export_output
+{
+	/* The output format
+	 */
+	uint8_t output_format;
+
+	/* The target path
+	 */
+	system_character_t *target_path;
+
+	/* The target path size
+	 */
+	size_t target_path_size;
+
+	/* The EWF format
+	 */
+	uint8_t ewf_format;
+
+	/* The compression method
+	 */
+	uint16_t compression_method;
+
+	/* The compression level
+	 */
+	int8_t compression_level;
+
+	/* The compression flags
+	 */
+	uint8_t compression_flags;
+
+	/* The maximum segment size
+	 */
+	size64_t maximum_segment_size;
+
+	/* The libewf output handle
+	 */
+	libewf_handle_t *ewf_output_handle;
+
+	/* The libsmraw output handle
+	 */
+	libsmraw_handle_t *raw_output_handle;
+
+	/* The number of bytes written
+	 */
+	size64_t number_of_bytes_written;
+
+	/* Value to indicate a write by the writer thread failed
+	 */
+	int write_failed;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The writer thread pool, which consists of a single thread
+	 * so that the data is written in the order it was queued
+	 */
+	libcthreads_thread_pool_t *writer_thread_pool;
+#endif
+};
+
+int export_output_initialize(
+     export_output_t **export_output,
+     libcerror_error_t **error );
+
+int export_output_free(
+     export_output_t **export_output,
+     libcerror_error_t **error );
+
+int export_output_set_specification(
+     export_output_t *export_output,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int export_output_open(
+     export_output_t *export_output,
+     libcerror_error_t **error );
+
+int export_output_close(
+     export_output_t *export_output,
+     libcerror_error_t **error );
+
+int export_output_set_values(
+     export_output_t *export_output,
+     libewf_handle_t *input_handle,
+     size64_t media_size,
+     uint32_t sectors_per_chunk,
+     int header_codepage,
+     system_character_t *acquiry_software,
+     system_character_t *acquiry_software_version,
+     libcerror_error_t **error );
+
+ssize_t export_output_write_buffer(
+         export_output_t *export_output,
+         const uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
+int export_output_write(
+     export_output_t *export_output,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int export_output_set_hash_value(
+     export_output_t *export_output,
+     char *hash_value_identifier,
+     size_t hash_value_identifier_length,
+     const system_character_t *hash_value,
+     size_t hash_value_length,
+     libcerror_error_t **error );
+
+int export_output_finalize(
+     export_output_t *export_output,
+     const system_character_t *md5_hash_string,
+     const system_character_t *sha1_hash_string,
+     const system_character_t *sha256_hash_string,
+     libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int export_output_start_writer_thread(
+     export_output_t *export_output,
+     int maximum_number_of_queued_items,
+     libcerror_error_t **error );
+
+int export_output_stop_writer_thread(
+     export_output_t *export_output,
+     libcerror_error_t **error );
+
+int export_output_write_storage_media_buffer_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     export_output_t *export_output );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _EXPORT_OUTPUT_H ) */
+
@@ -34,7 +34,9 @@
 #endif
 
 #include "byte_size_string.h"
+#include "chunk_fingerprints.h"
 #include "digest_hash.h"
+#include "digest_pipeline.h"
 #include "ewfcommon.h"
 #include "ewfinput.h"
 #include "ewftools_libcerror.h"
@@ -44,11 +46,18 @@
 #include "ewftools_libewf.h"
 #include "ewftools_libhmac.h"
 #include "ewftools_system_string.h"
+#include "ewftools_timestamp.h"
 #include "guid.h"
 #include "imaging_handle.h"
+#include "md5_context.h"
+#include "numa_topology.h"
 #include "platform.h"
+#include "restart_checkpoint.h"
+#include "sha1_context.h"
+#include "sha256_context.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
+#include "thread_autotune.h"
 
 #define IMAGING_HANDLE_INPUT_BUFFER_SIZE	64
 #define IMAGING_HANDLE_STRING_SIZE		1024
@@ -192,6 +201,7 @@ int imaging_handle_initialize(
 	( *imaging_handle )->maximum_segment_size     = EWFCOMMON_DEFAULT_SEGMENT_FILE_SIZE;
 	( *imaging_handle )->header_codepage          = LIBEWF_CODEPAGE_ASCII;
 	( *imaging_handle )->process_buffer_size      = EWFCOMMON_PROCESS_BUFFER_SIZE;
+	( *imaging_handle )->range_digests_range_size = RANGE_DIGESTS_DEFAULT_RANGE_SIZE;
 	( *imaging_handle )->notify_stream            = IMAGING_HANDLE_NOTIFY_STREAM;
 
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
@@ -267,6 +277,26 @@ int imaging_handle_free(
 			memory_free(
 			 ( *imaging_handle )->secondary_target_filename );
 		}
+		if( ( *imaging_handle )->range_digests_filename != NULL )
+		{
+			memory_free(
+			 ( *imaging_handle )->range_digests_filename );
+		}
+		if( ( *imaging_handle )->chunk_fingerprints_filename != NULL )
+		{
+			memory_free(
+			 ( *imaging_handle )->chunk_fingerprints_filename );
+		}
+		if( ( *imaging_handle )->base_chunk_fingerprints_filename != NULL )
+		{
+			memory_free(
+			 ( *imaging_handle )->base_chunk_fingerprints_filename );
+		}
+		if( ( *imaging_handle )->restart_checkpoint_filename != NULL )
+		{
+			memory_free(
+			 ( *imaging_handle )->restart_checkpoint_filename );
+		}
 		if( ( *imaging_handle )->case_number != NULL )
 		{
 			memory_free(
@@ -292,9 +322,29 @@ int imaging_handle_free(
 			memory_free(
 			 ( *imaging_handle )->notes );
 		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		/* The digest pipeline uses the digest contexts
+		 */
+		if( ( *imaging_handle )->digest_pipeline != NULL )
+		{
+			if( digest_pipeline_free(
+			     &( ( *imaging_handle )->digest_pipeline ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free digest pipeline.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
 		if( ( *imaging_handle )->md5_context != NULL )
 		{
-			if( libhmac_md5_free(
+			if( md5_context_free(
 			     &( ( *imaging_handle )->md5_context ),
 			     error ) != 1 )
 			{
@@ -315,7 +365,7 @@ int imaging_handle_free(
 		}
 		if( ( *imaging_handle )->sha1_context != NULL )
 		{
-			if( libhmac_sha1_free(
+			if( sha1_context_free(
 			     &( ( *imaging_handle )->sha1_context ),
 			     error ) != 1 )
 			{
@@ -336,7 +386,7 @@ int imaging_handle_free(
 		}
 		if( ( *imaging_handle )->sha256_context != NULL )
 		{
-			if( libhmac_sha256_free(
+			if( sha256_context_free(
 			     &( ( *imaging_handle )->sha256_context ),
 			     error ) != 1 )
 			{
@@ -355,6 +405,54 @@ int imaging_handle_free(
 			memory_free(
 			 ( *imaging_handle )->calculated_sha256_hash_string );
 		}
+		if( ( *imaging_handle )->range_digests != NULL )
+		{
+			if( range_digests_free(
+			     &( ( *imaging_handle )->range_digests ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free range digests.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *imaging_handle )->chunk_fingerprints != NULL )
+		{
+			if( chunk_fingerprints_free(
+			     &( ( *imaging_handle )->chunk_fingerprints ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk fingerprints.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *imaging_handle )->rate_limiter != NULL )
+		{
+			if( rate_limiter_free(
+			     &( ( *imaging_handle )->rate_limiter ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free rate limiter.",
+				 function );
+
+				result = -1;
+			}
+		}
 		if( libewf_handle_free(
 		     &( ( *imaging_handle )->output_handle ),
 		     error ) != 1 )
@@ -384,6 +482,24 @@ int imaging_handle_free(
 				result = -1;
 			}
 		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *imaging_handle )->thread_autotune != NULL )
+		{
+			if( thread_autotune_free(
+			     &( ( *imaging_handle )->thread_autotune ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free thread autotune.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
 		memory_free(
 		 *imaging_handle );
 
@@ -642,6 +758,14 @@ int imaging_handle_open_output(
 		libewf_filenames = filenames;
 		access_flags     = LIBEWF_OPEN_WRITE;
 	}
+	if( imaging_handle->unbuffered_output != 0 )
+	{
+		access_flags |= LIBEWF_ACCESS_FLAG_UNBUFFERED;
+	}
+	if( imaging_handle->sequential_output != 0 )
+	{
+		access_flags |= LIBEWF_ACCESS_FLAG_SEQUENTIAL;
+	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	if( libewf_handle_open_wide(
 	     imaging_handle->output_handle,
@@ -802,6 +926,14 @@ int imaging_handle_open_secondary_output(
 		libewf_filenames = filenames;
 		access_flags     = LIBEWF_OPEN_WRITE;
 	}
+	if( imaging_handle->unbuffered_output != 0 )
+	{
+		access_flags |= LIBEWF_ACCESS_FLAG_UNBUFFERED;
+	}
+	if( imaging_handle->sequential_output != 0 )
+	{
+		access_flags |= LIBEWF_ACCESS_FLAG_SEQUENTIAL;
+	}
 	if( libewf_handle_initialize(
 	     &( imaging_handle->secondary_output_handle ),
 	     error ) != 1 )
@@ -1016,18 +1148,17 @@ int imaging_handle_close(
 	return( 0 );
 }
 
-/* Writes a storage media buffer to the output of the imaging handle
- * Returns the number of bytes written or -1 on error
+/* Opens the chunk fingerprints file if a chunk fingerprints filename was set
+ * and the chunk fingerprints file of the base image if a base filename was set
+ * The chunk size of the output handle must be set before calling this function
+ * Returns 1 if successful or -1 on error
  */
-ssize_t imaging_handle_write_storage_media_buffer(
-         imaging_handle_t *imaging_handle,
-         storage_media_buffer_t *storage_media_buffer,
-         size_t write_size,
-         libcerror_error_t **error )
+int imaging_handle_open_chunk_fingerprints(
+     imaging_handle_t *imaging_handle,
+     libcerror_error_t **error )
 {
-	static char *function         = "imaging_handle_write_buffer";
-	ssize_t secondary_write_count = 0;
-	ssize_t write_count           = 0;
+	static char *function = "imaging_handle_open_chunk_fingerprints";
+	size32_t chunk_size   = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -1040,135 +1171,100 @@ ssize_t imaging_handle_write_storage_media_buffer(
 
 		return( -1 );
 	}
-	write_count = storage_media_buffer_write_to_handle(
-	               storage_media_buffer,
-	               imaging_handle->output_handle,
-	               write_size,
-	               error );
-
-	if( write_count < 0 )
+	if( imaging_handle->chunk_fingerprints != NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write storage media buffer.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid imaging handle - chunk fingerprints value already set.",
 		 function );
 
-		if( ( error != NULL )
-		 && ( libcerror_error_matches(
-		       *error,
-		       LIBCERROR_ERROR_DOMAIN_OUTPUT,
-		       LIBCERROR_OUTPUT_ERROR_INSUFFICIENT_SPACE ) == 0 ) )
-		{
-			return( -1 );
-		}
-/* TODO ask for alternative segment file location and try again */
 		return( -1 );
 	}
-	if( imaging_handle->secondary_output_handle != NULL )
+	if( imaging_handle->chunk_fingerprints_filename == NULL )
 	{
-		secondary_write_count = storage_media_buffer_write_to_handle(
-		                         storage_media_buffer,
-		                         imaging_handle->secondary_output_handle,
-		                         write_size,
-		                         error );
-
-		if( secondary_write_count < 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write storage media buffer to secondary output handle.",
-			 function );
-
-			if( ( error != NULL )
-			 && ( libcerror_error_matches(
-			       *error,
-			       LIBCERROR_ERROR_DOMAIN_OUTPUT,
-			       LIBCERROR_OUTPUT_ERROR_INSUFFICIENT_SPACE ) == 0 ) )
-			{
-				return( -1 );
-			}
-/* TODO ask for alternative segment file location and try again */
-			return( -1 );
-		}
+		return( 1 );
 	}
-	return( write_count );
-}
-
-/* Seeks the offset in the input file
- * Returns the new offset if successful or -1 on error
- */
-off64_t imaging_handle_seek_offset(
-         imaging_handle_t *imaging_handle,
-         off64_t offset,
-         libcerror_error_t **error )
-{
-	static char *function    = "imaging_handle_seek_offset";
-	off64_t secondary_offset = 0;
-
-	if( imaging_handle == NULL )
+	if( imaging_handle_get_chunk_size(
+	     imaging_handle,
+	     &chunk_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid imaging handle.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk size.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	offset = libewf_handle_seek_offset(
-	          imaging_handle->output_handle,
-	          offset,
-	          SEEK_SET,
-	          error );
+	if( chunk_fingerprints_initialize(
+	     &( imaging_handle->chunk_fingerprints ),
+	     chunk_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk fingerprints.",
+		 function );
 
-	if( offset == -1 )
+		goto on_error;
+	}
+	if( chunk_fingerprints_open_file(
+	     imaging_handle->chunk_fingerprints,
+	     imaging_handle->chunk_fingerprints_filename,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset in output handle.",
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open chunk fingerprints file.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( imaging_handle->secondary_output_handle != NULL )
+	if( imaging_handle->base_chunk_fingerprints_filename != NULL )
 	{
-		secondary_offset = libewf_handle_seek_offset(
-		                    imaging_handle->secondary_output_handle,
-		                    offset,
-		                    SEEK_SET,
-		                    error );
-
-		if( secondary_offset == -1 )
+		if( chunk_fingerprints_open_base_file(
+		     imaging_handle->chunk_fingerprints,
+		     imaging_handle->base_chunk_fingerprints_filename,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_SEEK_FAILED,
-			 "%s: unable to seek offset in secondary output handle.",
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open base chunk fingerprints file.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
 	}
-	return( offset );
+	return( 1 );
+
+on_error:
+	if( imaging_handle->chunk_fingerprints != NULL )
+	{
+		chunk_fingerprints_free(
+		 &( imaging_handle->chunk_fingerprints ),
+		 NULL );
+	}
+	return( -1 );
 }
 
-/* Retrieves the offset size
+/* Closes the chunk fingerprints file if it was opened
  * Returns 1 if successful or -1 on error
  */
-int imaging_handle_get_offset(
+int imaging_handle_close_chunk_fingerprints(
      imaging_handle_t *imaging_handle,
-     off64_t *offset,
      libcerror_error_t **error )
 {
-	static char *function = "imaging_handle_get_offset";
+	static char *function = "imaging_handle_close_chunk_fingerprints";
 
 	if( imaging_handle == NULL )
 	{
@@ -1181,27 +1277,19 @@ int imaging_handle_get_offset(
 
 		return( -1 );
 	}
-	if( offset == NULL )
+	if( imaging_handle->chunk_fingerprints == NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid offset.",
-		 function );
-
-		return( -1 );
+		return( 1 );
 	}
-	if( libewf_handle_get_offset(
-	     imaging_handle->output_handle,
-	     offset,
+	if( chunk_fingerprints_close_file(
+	     imaging_handle->chunk_fingerprints,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve offset.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close chunk fingerprints file.",
 		 function );
 
 		return( -1 );
@@ -1209,18 +1297,15 @@ int imaging_handle_get_offset(
 	return( 1 );
 }
 
-/* Swaps the byte order of byte pairs within a buffer of a certain size
- * Returns 1 if successful, -1 on error
+/* Prints the chunks that changed compared to the base image to a stream
+ * Returns 1 if successful or -1 on error
  */
-int imaging_handle_swap_byte_pairs(
+int imaging_handle_print_changed_chunks(
      imaging_handle_t *imaging_handle,
-     uint8_t *buffer,
-     size_t buffer_size,
+     FILE *stream,
      libcerror_error_t **error )
 {
-	static char *function = "imaging_handle_swap_byte_pairs";
-	size_t buffer_offset  = 0;
-	uint8_t byte_value    = 0;
+	static char *function = "imaging_handle_print_changed_chunks";
 
 	if( imaging_handle == NULL )
 	{
@@ -1233,152 +1318,154 @@ int imaging_handle_swap_byte_pairs(
 
 		return( -1 );
 	}
-	if( buffer == NULL )
+	if( ( imaging_handle->chunk_fingerprints == NULL )
+	 || ( imaging_handle->base_chunk_fingerprints_filename == NULL ) )
+	{
+		return( 1 );
+	}
+	if( chunk_fingerprints_changed_chunks_fprint(
+	     imaging_handle->chunk_fingerprints,
+	     stream,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print changed chunks.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( buffer_size == 0 )
-	 || ( buffer_size > (size_t) SSIZE_MAX ) )
-	{
+	return( 1 );
+}
+
+/* Calculates the chunk fingerprints of the data in a storage media buffer
+ * This function is called before the data is packed and can be called from multiple threads
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_calculate_chunk_fingerprints(
+     imaging_handle_t *imaging_handle,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error )
+{
+	uint8_t *data            = NULL;
+	uint8_t *reallocation    = NULL;
+	static char *function    = "imaging_handle_calculate_chunk_fingerprints";
+	size_t data_size         = 0;
+	size_t fingerprints_size = 0;
+
+	if( imaging_handle == NULL )
+	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid read size value out of bounds.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
 		 function );
 
 		return( -1 );
 	}
-	/* If the last bit is set the value is odd
-	 */
-	if( ( buffer_size & 0x01 ) != 0 )
+	if( storage_media_buffer == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: invalid read size value is odd.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
 		 function );
 
 		return( -1 );
 	}
-	for( buffer_offset = 0;
-	     buffer_offset < buffer_size;
-	     buffer_offset += 2 )
+	storage_media_buffer->fingerprints_data_size = 0;
+
+	if( imaging_handle->chunk_fingerprints == NULL )
 	{
-		byte_value                  = buffer[ buffer_offset ];
-		buffer[ buffer_offset ]     = buffer[ buffer_offset + 1 ];
-		buffer[ buffer_offset + 1 ] = byte_value;
+		return( 1 );
 	}
-	return( 1 );
-}
-
-/* Initializes the integrity hash(es)
- * Returns 1 if successful or -1 on error
- */
-int imaging_handle_initialize_integrity_hash(
-     imaging_handle_t *imaging_handle,
-     libcerror_error_t **error )
-{
-	static char *function = "imaging_handle_initialize_integrity_hash";
-
-	if( imaging_handle == NULL )
+	if( storage_media_buffer_get_data(
+	     storage_media_buffer,
+	     &data,
+	     &data_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid imaging handle.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve storage media buffer data.",
 		 function );
 
 		return( -1 );
 	}
-	if( imaging_handle->calculate_md5 != 0 )
+	if( chunk_fingerprints_get_fingerprints_size(
+	     imaging_handle->chunk_fingerprints,
+	     data_size,
+	     &fingerprints_size,
+	     error ) != 1 )
 	{
-		if( libhmac_md5_initialize(
-		     &( imaging_handle->md5_context ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize MD5 context.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk fingerprints size.",
+		 function );
 
-			goto on_error;
-		}
-		imaging_handle->md5_context_initialized = 1;
+		return( -1 );
 	}
-	if( imaging_handle->calculate_sha1 != 0 )
+	if( fingerprints_size > storage_media_buffer->fingerprints_size )
 	{
-		if( libhmac_sha1_initialize(
-		     &( imaging_handle->sha1_context ),
-		     error ) != 1 )
+		reallocation = (uint8_t *) memory_reallocate(
+		                            storage_media_buffer->fingerprints,
+		                            sizeof( uint8_t ) * fingerprints_size );
+
+		if( reallocation == NULL )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize SHA1 context.",
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize chunk fingerprints.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
-		imaging_handle->sha1_context_initialized = 1;
+		storage_media_buffer->fingerprints      = reallocation;
+		storage_media_buffer->fingerprints_size = fingerprints_size;
 	}
-	if( imaging_handle->calculate_sha256 != 0 )
+	if( chunk_fingerprints_calculate(
+	     imaging_handle->chunk_fingerprints,
+	     data,
+	     data_size,
+	     storage_media_buffer->fingerprints,
+	     storage_media_buffer->fingerprints_size,
+	     error ) != 1 )
 	{
-		if( libhmac_sha256_initialize(
-		     &( imaging_handle->sha256_context ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize SHA256 context.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to calculate chunk fingerprints.",
+		 function );
 
-			goto on_error;
-		}
-		imaging_handle->sha256_context_initialized = 1;
+		return( -1 );
 	}
-	return( 1 );
+	storage_media_buffer->fingerprints_data_size = data_size;
 
-on_error:
-	if( imaging_handle->sha1_context != NULL )
-	{
-		libhmac_sha1_free(
-		 &( imaging_handle->sha1_context ),
-		 NULL );
-	}
-	if( imaging_handle->md5_context != NULL )
-	{
-		libhmac_md5_free(
-		 &( imaging_handle->md5_context ),
-		 NULL );
-	}
-	return( -1 );
+	return( 1 );
 }
 
-/* Updates the integrity hash(es)
+/* Appends the chunk fingerprints of a storage media buffer to the chunk fingerprints file
+ * The storage media buffers must be appended in order of their storage media offset
  * Returns 1 if successful or -1 on error
  */
-int imaging_handle_update_integrity_hash(
+int imaging_handle_append_chunk_fingerprints(
      imaging_handle_t *imaging_handle,
-     const uint8_t *buffer,
-     size_t buffer_size,
+     storage_media_buffer_t *storage_media_buffer,
      libcerror_error_t **error )
 {
-	static char *function = "imaging_handle_update_integrity_hash";
+	static char *function    = "imaging_handle_append_chunk_fingerprints";
+	size_t fingerprints_size = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -1391,98 +1478,71 @@ int imaging_handle_update_integrity_hash(
 
 		return( -1 );
 	}
-	if( buffer == NULL )
+	if( storage_media_buffer == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
+		 "%s: invalid storage media buffer.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( buffer_size == 0 )
-	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	if( imaging_handle->chunk_fingerprints == NULL )
+	{
+		return( 1 );
+	}
+	if( chunk_fingerprints_get_fingerprints_size(
+	     imaging_handle->chunk_fingerprints,
+	     storage_media_buffer->fingerprints_data_size,
+	     &fingerprints_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid buffer size value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk fingerprints size.",
 		 function );
 
 		return( -1 );
 	}
-	if( imaging_handle->calculate_md5 != 0 )
-	{
-		if( libhmac_md5_update(
-		     imaging_handle->md5_context,
-		     buffer,
-		     buffer_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update MD5 digest hash.",
-			 function );
-
-			return( -1 );
-		}
-	}
-	if( imaging_handle->calculate_sha1 != 0 )
+	if( chunk_fingerprints_append(
+	     imaging_handle->chunk_fingerprints,
+	     storage_media_buffer->fingerprints,
+	     fingerprints_size,
+	     storage_media_buffer->fingerprints_data_size,
+	     error ) != 1 )
 	{
-		if( libhmac_sha1_update(
-		     imaging_handle->sha1_context,
-		     buffer,
-		     buffer_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update SHA1 digest hash.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append chunk fingerprints.",
+		 function );
 
-			return( -1 );
-		}
+		return( -1 );
 	}
-	if( imaging_handle->calculate_sha256 != 0 )
-	{
-		if( libhmac_sha256_update(
-		     imaging_handle->sha256_context,
-		     buffer,
-		     buffer_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update SHA256 digest hash.",
-			 function );
+	storage_media_buffer->fingerprints_data_size = 0;
 
-			return( -1 );
-		}
-	}
 	return( 1 );
 }
 
-/* Finalizes the integrity hash(es)
- * Returns 1 if successful or -1 on error
+/* Writes a storage media buffer to the output of the imaging handle
+ * Returns the number of bytes written or -1 on error
  */
-int imaging_handle_finalize_integrity_hash(
-     imaging_handle_t *imaging_handle,
-     libcerror_error_t **error )
+ssize_t imaging_handle_write_storage_media_buffer(
+         imaging_handle_t *imaging_handle,
+         storage_media_buffer_t *storage_media_buffer,
+         size_t write_size,
+         libcerror_error_t **error )
 {
-	uint8_t calculated_md5_hash[ LIBHMAC_MD5_HASH_SIZE ];
-	uint8_t calculated_sha1_hash[ LIBHMAC_SHA1_HASH_SIZE ];
-	uint8_t calculated_sha256_hash[ LIBHMAC_SHA256_HASH_SIZE ];
-
-	static char *function = "imaging_handle_finalize_integrity_hash";
+	static char *function         = "imaging_handle_write_buffer";
+	ssize_t secondary_write_count = 0;
+	ssize_t write_count           = 0;
+	int64_t stats_start_timestamp = 0;
+	int write_secondary_output    = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -1495,202 +1555,1883 @@ int imaging_handle_finalize_integrity_hash(
 
 		return( -1 );
 	}
-	if( imaging_handle->calculate_md5 != 0 )
+	if( imaging_handle->secondary_output_handle != NULL )
 	{
-		if( imaging_handle->calculated_md5_hash_string == NULL )
+		write_secondary_output = 1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( imaging_handle->secondary_output_thread_pool != NULL )
+	{
+		if( imaging_handle->secondary_output_failed != 0 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid imaging handle - missing calculated MD5 hash string.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write storage media buffer to secondary output handle.",
 			 function );
 
 			return( -1 );
 		}
-		if( libhmac_md5_finalize(
-		     imaging_handle->md5_context,
-		     calculated_md5_hash,
-		     LIBHMAC_MD5_HASH_SIZE,
+		/* The secondary output thread shares the storage media buffer, which is only
+		 * released onto the queue after both the output and the secondary output released it
+		 */
+		if( storage_media_buffer_queue_reference_buffer(
+		     imaging_handle->storage_media_buffer_queue,
+		     storage_media_buffer,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to finalize MD5 hash.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to reference storage media buffer.",
 			 function );
 
 			return( -1 );
 		}
-		if( digest_hash_copy_to_string(
-		     calculated_md5_hash,
-		     LIBHMAC_MD5_HASH_SIZE,
-		     imaging_handle->calculated_md5_hash_string,
-		     33,
+		if( libcthreads_thread_pool_push(
+		     imaging_handle->secondary_output_thread_pool,
+		     (intptr_t *) storage_media_buffer,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBEWF_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set calculated MD5 hash string.",
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push storage media buffer onto secondary output thread pool queue.",
 			 function );
 
+			storage_media_buffer_queue_release_buffer(
+			 imaging_handle->storage_media_buffer_queue,
+			 storage_media_buffer,
+			 NULL );
+
 			return( -1 );
 		}
+		write_secondary_output = 0;
 	}
-	if( imaging_handle->calculate_sha1 != 0 )
+#endif
+	if( imaging_handle->stats_output != NULL )
 	{
-		if( imaging_handle->calculated_sha1_hash_string == NULL )
+		if( ewftools_timestamp_get_monotonic(
+		     &stats_start_timestamp,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid imaging handle - missing calculated SHA1 hash string.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve statistics start timestamp.",
 			 function );
 
 			return( -1 );
 		}
-		if( libhmac_sha1_finalize(
-		     imaging_handle->sha1_context,
-		     calculated_sha1_hash,
-		     LIBHMAC_SHA1_HASH_SIZE,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	}
+	write_count = storage_media_buffer_write_to_handle(
+	               storage_media_buffer,
+	               imaging_handle->output_handle,
+	               write_size,
+	               error );
+
+	if( write_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write storage media buffer.",
+		 function );
+
+		if( ( error != NULL )
+		 && ( libcerror_error_matches(
+		       *error,
+		       LIBCERROR_ERROR_DOMAIN_OUTPUT,
+		       LIBCERROR_OUTPUT_ERROR_INSUFFICIENT_SPACE ) == 0 ) )
+		{
+			return( -1 );
+		}
+/* TODO ask for alternative segment file location and try again */
+		return( -1 );
+	}
+	if( write_secondary_output != 0 )
+	{
+		secondary_write_count = storage_media_buffer_write_to_handle(
+		                         storage_media_buffer,
+		                         imaging_handle->secondary_output_handle,
+		                         write_size,
+		                         error );
+
+		if( secondary_write_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write storage media buffer to secondary output handle.",
+			 function );
+
+			if( ( error != NULL )
+			 && ( libcerror_error_matches(
+			       *error,
+			       LIBCERROR_ERROR_DOMAIN_OUTPUT,
+			       LIBCERROR_OUTPUT_ERROR_INSUFFICIENT_SPACE ) == 0 ) )
+			{
+				return( -1 );
+			}
+/* TODO ask for alternative segment file location and try again */
+			return( -1 );
+		}
+	}
+	if( imaging_handle->stats_output != NULL )
+	{
+		if( stats_output_add_stage(
+		     imaging_handle->stats_output,
+		     STATS_OUTPUT_STAGE_WRITE,
+		     (size64_t) write_size,
+		     stats_start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to add write to statistics output.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( imaging_handle_append_chunk_fingerprints(
+	     imaging_handle,
+	     storage_media_buffer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append chunk fingerprints.",
+		 function );
+
+		return( -1 );
+	}
+	return( write_count );
+}
+
+/* Seeks the offset in the input file
+ * Returns the new offset if successful or -1 on error
+ */
+off64_t imaging_handle_seek_offset(
+         imaging_handle_t *imaging_handle,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function    = "imaging_handle_seek_offset";
+	off64_t secondary_offset = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	offset = libewf_handle_seek_offset(
+	          imaging_handle->output_handle,
+	          offset,
+	          SEEK_SET,
+	          error );
+
+	if( offset == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset in output handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle->secondary_output_handle != NULL )
+	{
+		secondary_offset = libewf_handle_seek_offset(
+		                    imaging_handle->secondary_output_handle,
+		                    offset,
+		                    SEEK_SET,
+		                    error );
+
+		if( secondary_offset == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset in secondary output handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( offset );
+}
+
+/* Retrieves the offset size
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_get_offset(
+     imaging_handle_t *imaging_handle,
+     off64_t *offset,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_get_offset";
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_get_offset(
+	     imaging_handle->output_handle,
+	     offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve offset.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Swaps the byte order of byte pairs within a buffer of a certain size
+ * Returns 1 if successful, -1 on error
+ */
+int imaging_handle_swap_byte_pairs(
+     imaging_handle_t *imaging_handle,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_swap_byte_pairs";
+	size_t buffer_offset  = 0;
+	uint8_t byte_value    = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* If the last bit is set the value is odd
+	 */
+	if( ( buffer_size & 0x01 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid read size value is odd.",
+		 function );
+
+		return( -1 );
+	}
+	for( buffer_offset = 0;
+	     buffer_offset < buffer_size;
+	     buffer_offset += 2 )
+	{
+		byte_value                  = buffer[ buffer_offset ];
+		buffer[ buffer_offset ]     = buffer[ buffer_offset + 1 ];
+		buffer[ buffer_offset + 1 ] = byte_value;
+	}
+	return( 1 );
+}
+
+/* Initializes the integrity hash(es)
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_initialize_integrity_hash(
+     imaging_handle_t *imaging_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_initialize_integrity_hash";
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle->calculate_md5 != 0 )
+	{
+		if( md5_context_initialize(
+		     &( imaging_handle->md5_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize MD5 context.",
+			 function );
+
+			goto on_error;
+		}
+		imaging_handle->md5_context_initialized = 1;
+	}
+	if( imaging_handle->calculate_sha1 != 0 )
+	{
+		if( sha1_context_initialize(
+		     &( imaging_handle->sha1_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA1 context.",
+			 function );
+
+			goto on_error;
+		}
+		imaging_handle->sha1_context_initialized = 1;
+	}
+	if( imaging_handle->calculate_sha256 != 0 )
+	{
+		if( sha256_context_initialize(
+		     &( imaging_handle->sha256_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA256 context.",
+			 function );
+
+			goto on_error;
+		}
+		imaging_handle->sha256_context_initialized = 1;
+	}
+	if( imaging_handle->range_digests_filename != NULL )
+	{
+		if( range_digests_initialize(
+		     &( imaging_handle->range_digests ),
+		     imaging_handle->range_digests_range_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create range digests.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* Calculate every digest on its own thread when multi-threading is enabled
+	 */
+	if( ( imaging_handle->number_of_threads != 0 )
+	 && ( ( imaging_handle->calculate_md5 != 0 )
+	  ||  ( imaging_handle->calculate_sha1 != 0 )
+	  ||  ( imaging_handle->calculate_sha256 != 0 )
+	  ||  ( imaging_handle->range_digests != NULL ) ) )
+	{
+		if( imaging_handle_start_digest_pipeline(
+		     imaging_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to start digest pipeline.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( imaging_handle->range_digests != NULL )
+	{
+		range_digests_free(
+		 &( imaging_handle->range_digests ),
+		 NULL );
+	}
+	if( imaging_handle->sha256_context != NULL )
+	{
+		sha256_context_free(
+		 &( imaging_handle->sha256_context ),
+		 NULL );
+	}
+	if( imaging_handle->sha1_context != NULL )
+	{
+		sha1_context_free(
+		 &( imaging_handle->sha1_context ),
+		 NULL );
+	}
+	if( imaging_handle->md5_context != NULL )
+	{
+		md5_context_free(
+		 &( imaging_handle->md5_context ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Creates the digest pipeline and starts a thread for every digest
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_start_digest_pipeline(
+     imaging_handle_t *imaging_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_start_digest_pipeline";
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle->digest_pipeline != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid imaging handle - digest pipeline value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_pipeline_initialize(
+	     &( imaging_handle->digest_pipeline ),
+	     DIGEST_PIPELINE_DEFAULT_NUMBER_OF_SLOTS,
+	     DIGEST_PIPELINE_DEFAULT_SLOT_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create digest pipeline.",
+		 function );
+
+		goto on_error;
+	}
+	if( imaging_handle->calculate_md5 != 0 )
+	{
+		if( digest_pipeline_add_digest(
+		     imaging_handle->digest_pipeline,
+		     DIGEST_PIPELINE_DIGEST_TYPE_MD5,
+		     (intptr_t *) imaging_handle->md5_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to add MD5 digest to pipeline.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( imaging_handle->calculate_sha1 != 0 )
+	{
+		if( digest_pipeline_add_digest(
+		     imaging_handle->digest_pipeline,
+		     DIGEST_PIPELINE_DIGEST_TYPE_SHA1,
+		     (intptr_t *) imaging_handle->sha1_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to add SHA1 digest to pipeline.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( imaging_handle->calculate_sha256 != 0 )
+	{
+		if( digest_pipeline_add_digest(
+		     imaging_handle->digest_pipeline,
+		     DIGEST_PIPELINE_DIGEST_TYPE_SHA256,
+		     (intptr_t *) imaging_handle->sha256_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to add SHA256 digest to pipeline.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( imaging_handle->range_digests != NULL )
+	{
+		if( digest_pipeline_add_digest(
+		     imaging_handle->digest_pipeline,
+		     DIGEST_PIPELINE_DIGEST_TYPE_RANGE_DIGESTS,
+		     (intptr_t *) imaging_handle->range_digests,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to add range digests to pipeline.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( digest_pipeline_start(
+	     imaging_handle->digest_pipeline,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to start digest pipeline.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( imaging_handle->digest_pipeline != NULL )
+	{
+		digest_pipeline_free(
+		 &( imaging_handle->digest_pipeline ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Updates the integrity hash(es)
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_update_integrity_hash(
+     imaging_handle_t *imaging_handle,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_update_integrity_hash";
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( imaging_handle->digest_pipeline != NULL )
+	{
+		if( digest_pipeline_append_data(
+		     imaging_handle->digest_pipeline,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append data to digest pipeline.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+#endif
+	if( imaging_handle->calculate_md5 != 0 )
+	{
+		if( md5_context_update(
+		     imaging_handle->md5_context,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update MD5 digest hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( imaging_handle->calculate_sha1 != 0 )
+	{
+		if( sha1_context_update(
+		     imaging_handle->sha1_context,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA1 digest hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( imaging_handle->calculate_sha256 != 0 )
+	{
+		if( sha256_context_update(
+		     imaging_handle->sha256_context,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA256 digest hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( imaging_handle->range_digests != NULL )
+	{
+		if( range_digests_update(
+		     imaging_handle->range_digests,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update range digests.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Reads the restart checkpoint and restores the state of the integrity hash(es)
+ * The last checkpoint of which the hashed offset does not exceed the maximum offset,
+ * which is the offset the acquiry resumes at, is used when it matches the acquiry
+ * This function should be called after the integrity hash(es) are initialized
+ * and before any data is hashed
+ * Returns 1 if successful, 0 if no usable restart checkpoint is available or -1 on error
+ */
+int imaging_handle_read_restart_checkpoint(
+     imaging_handle_t *imaging_handle,
+     off64_t maximum_offset,
+     off64_t *hashed_offset,
+     libcerror_error_t **error )
+{
+	restart_checkpoint_t *restart_checkpoint = NULL;
+	static char *function                    = "imaging_handle_read_restart_checkpoint";
+	uint32_t expected_flags                  = 0;
+	int result                               = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle->restart_checkpoint_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid imaging handle - missing restart checkpoint filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid maximum offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( hashed_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hashed offset.",
+		 function );
+
+		return( -1 );
+	}
+	/* The state of the range digests cannot be restored
+	 */
+	if( imaging_handle->range_digests != NULL )
+	{
+		return( 0 );
+	}
+	if( imaging_handle->calculate_md5 != 0 )
+	{
+		expected_flags |= RESTART_CHECKPOINT_FLAG_HAS_MD5_STATE;
+	}
+	if( imaging_handle->calculate_sha1 != 0 )
+	{
+		expected_flags |= RESTART_CHECKPOINT_FLAG_HAS_SHA1_STATE;
+	}
+	if( imaging_handle->calculate_sha256 != 0 )
+	{
+		expected_flags |= RESTART_CHECKPOINT_FLAG_HAS_SHA256_STATE;
+	}
+	if( restart_checkpoint_initialize(
+	     &restart_checkpoint,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create restart checkpoint.",
+		 function );
+
+		goto on_error;
+	}
+	result = restart_checkpoint_read_file(
+	          restart_checkpoint,
+	          imaging_handle->restart_checkpoint_filename,
+	          (uint64_t) maximum_offset,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read restart checkpoint file.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		if( ( restart_checkpoint->acquiry_offset != imaging_handle->acquiry_offset )
+		 || ( restart_checkpoint->acquiry_size != imaging_handle->acquiry_size )
+		 || ( restart_checkpoint->hashed_offset > (uint64_t) maximum_offset )
+		 || ( restart_checkpoint->flags != expected_flags ) )
+		{
+			result = 0;
+		}
+	}
+	/* The SHA1 and SHA256 states are restored first since their state can only be
+	 * restored when the SHA extensions are used, in which case the MD5 state is not restored
+	 */
+	if( ( result != 0 )
+	 && ( imaging_handle->calculate_sha1 != 0 ) )
+	{
+		result = sha1_context_set_state(
+		          imaging_handle->sha1_context,
+		          restart_checkpoint->sha1_state,
+		          SHA1_CONTEXT_STATE_SIZE,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set SHA1 state.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ( result != 0 )
+	 && ( imaging_handle->calculate_sha256 != 0 ) )
+	{
+		result = sha256_context_set_state(
+		          imaging_handle->sha256_context,
+		          restart_checkpoint->sha256_state,
+		          SHA256_CONTEXT_STATE_SIZE,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set SHA256 state.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ( result != 0 )
+	 && ( imaging_handle->calculate_md5 != 0 ) )
+	{
+		if( md5_context_set_state(
+		     imaging_handle->md5_context,
+		     restart_checkpoint->md5_state,
+		     MD5_CONTEXT_STATE_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set MD5 state.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( result != 0 )
+	{
+		*hashed_offset = (off64_t) restart_checkpoint->hashed_offset;
+	}
+	if( restart_checkpoint_free(
+	     &restart_checkpoint,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free restart checkpoint.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( restart_checkpoint != NULL )
+	{
+		restart_checkpoint_free(
+		 &restart_checkpoint,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes a restart checkpoint that contains the state of the integrity hash(es)
+ * The hashed offset is the offset, relative to the acquiry offset, up to which
+ * the data was passed to the integrity hash(es)
+ * The checkpoint is appended to the restart checkpoint file when append is set,
+ * otherwise the file is replaced
+ * Returns 1 if successful, 0 if the state of the integrity hash(es) cannot be stored or -1 on error
+ */
+int imaging_handle_write_restart_checkpoint(
+     imaging_handle_t *imaging_handle,
+     off64_t hashed_offset,
+     uint8_t append,
+     libcerror_error_t **error )
+{
+	restart_checkpoint_t *restart_checkpoint = NULL;
+	static char *function                    = "imaging_handle_write_restart_checkpoint";
+	int result                               = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle->restart_checkpoint_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid imaging handle - missing restart checkpoint filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( hashed_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid hashed offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	/* The state of the range digests cannot be stored
+	 */
+	if( imaging_handle->range_digests != NULL )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The digest threads need to have processed all the data
+	 * up to the hashed offset before the state can be retrieved
+	 */
+	if( imaging_handle->digest_pipeline != NULL )
+	{
+		if( digest_pipeline_flush(
+		     imaging_handle->digest_pipeline,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to flush digest pipeline.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	if( restart_checkpoint_initialize(
+	     &restart_checkpoint,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create restart checkpoint.",
+		 function );
+
+		goto on_error;
+	}
+	restart_checkpoint->acquiry_offset = imaging_handle->acquiry_offset;
+	restart_checkpoint->acquiry_size   = imaging_handle->acquiry_size;
+	restart_checkpoint->hashed_offset  = (uint64_t) hashed_offset;
+
+	result = 1;
+
+	if( imaging_handle->calculate_sha1 != 0 )
+	{
+		result = sha1_context_get_state(
+		          imaging_handle->sha1_context,
+		          restart_checkpoint->sha1_state,
+		          SHA1_CONTEXT_STATE_SIZE,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve SHA1 state.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			restart_checkpoint->flags |= RESTART_CHECKPOINT_FLAG_HAS_SHA1_STATE;
+		}
+	}
+	if( ( result != 0 )
+	 && ( imaging_handle->calculate_sha256 != 0 ) )
+	{
+		result = sha256_context_get_state(
+		          imaging_handle->sha256_context,
+		          restart_checkpoint->sha256_state,
+		          SHA256_CONTEXT_STATE_SIZE,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve SHA256 state.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			restart_checkpoint->flags |= RESTART_CHECKPOINT_FLAG_HAS_SHA256_STATE;
+		}
+	}
+	if( ( result != 0 )
+	 && ( imaging_handle->calculate_md5 != 0 ) )
+	{
+		if( md5_context_get_state(
+		     imaging_handle->md5_context,
+		     restart_checkpoint->md5_state,
+		     MD5_CONTEXT_STATE_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve MD5 state.",
+			 function );
+
+			goto on_error;
+		}
+		restart_checkpoint->flags |= RESTART_CHECKPOINT_FLAG_HAS_MD5_STATE;
+	}
+	if( result != 0 )
+	{
+		if( restart_checkpoint_write_file(
+		     restart_checkpoint,
+		     imaging_handle->restart_checkpoint_filename,
+		     append,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write restart checkpoint file.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( restart_checkpoint_free(
+	     &restart_checkpoint,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free restart checkpoint.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( restart_checkpoint != NULL )
+	{
+		restart_checkpoint_free(
+		 &restart_checkpoint,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Finalizes the integrity hash(es)
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_finalize_integrity_hash(
+     imaging_handle_t *imaging_handle,
+     libcerror_error_t **error )
+{
+	uint8_t calculated_md5_hash[ LIBHMAC_MD5_HASH_SIZE ];
+	uint8_t calculated_sha1_hash[ LIBHMAC_SHA1_HASH_SIZE ];
+	uint8_t calculated_sha256_hash[ LIBHMAC_SHA256_HASH_SIZE ];
+
+	static char *function = "imaging_handle_finalize_integrity_hash";
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( imaging_handle->digest_pipeline != NULL )
+	{
+		if( digest_pipeline_free(
+		     &( imaging_handle->digest_pipeline ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free digest pipeline.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	if( imaging_handle->calculate_md5 != 0 )
+	{
+		if( imaging_handle->calculated_md5_hash_string == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid imaging handle - missing calculated MD5 hash string.",
+			 function );
+
+			return( -1 );
+		}
+		if( md5_context_finalize(
+		     imaging_handle->md5_context,
+		     calculated_md5_hash,
+		     LIBHMAC_MD5_HASH_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize MD5 hash.",
+			 function );
+
+			return( -1 );
+		}
+		if( digest_hash_copy_to_string(
+		     calculated_md5_hash,
+		     LIBHMAC_MD5_HASH_SIZE,
+		     imaging_handle->calculated_md5_hash_string,
+		     33,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBEWF_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set calculated MD5 hash string.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( imaging_handle->calculate_sha1 != 0 )
+	{
+		if( imaging_handle->calculated_sha1_hash_string == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid imaging handle - missing calculated SHA1 hash string.",
+			 function );
+
+			return( -1 );
+		}
+		if( sha1_context_finalize(
+		     imaging_handle->sha1_context,
+		     calculated_sha1_hash,
+		     LIBHMAC_SHA1_HASH_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
 			 "%s: unable to finalize SHA1 hash.",
 			 function );
 
-			return( -1 );
+			return( -1 );
+		}
+		if( digest_hash_copy_to_string(
+		     calculated_sha1_hash,
+		     LIBHMAC_SHA1_HASH_SIZE,
+		     imaging_handle->calculated_sha1_hash_string,
+		     41,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create calculated SHA1 hash string.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( imaging_handle->calculate_sha256 != 0 )
+	{
+		if( imaging_handle->calculated_sha256_hash_string == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid imaging handle - missing calculated SHA256 hash string.",
+			 function );
+
+			return( -1 );
+		}
+		if( sha256_context_finalize(
+		     imaging_handle->sha256_context,
+		     calculated_sha256_hash,
+		     LIBHMAC_SHA256_HASH_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize SHA256 hash.",
+			 function );
+
+			return( -1 );
+		}
+		if( digest_hash_copy_to_string(
+		     calculated_sha256_hash,
+		     LIBHMAC_SHA256_HASH_SIZE,
+		     imaging_handle->calculated_sha256_hash_string,
+		     65,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create calculated SHA256 hash string.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( imaging_handle->range_digests != NULL )
+	{
+		if( range_digests_finalize(
+		     imaging_handle->range_digests,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize range digests.",
+			 function );
+
+			return( -1 );
+		}
+		if( range_digests_write_file(
+		     imaging_handle->range_digests,
+		     imaging_handle->range_digests_filename,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write range digests file.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Prepares a storage media buffer for imaging
+ * Callback function for the process thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_process_storage_media_buffer_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     imaging_handle_t *imaging_handle )
+{
+        libcerror_error_t *error         = NULL;
+        static char *function            = "imaging_handle_process_storage_media_buffer_callback";
+	ssize_t process_count            = 0;
+	int64_t autotune_start_timestamp = 0;
+	int64_t stats_start_timestamp    = 0;
+
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		goto on_error;
+	}
+	/* Keep the compression of the storage media buffer on the node that owns its memory
+	 */
+	if( imaging_handle->numa_topology != NULL )
+	{
+		if( numa_topology_bind_current_thread(
+		     imaging_handle->numa_topology,
+		     storage_media_buffer->node_index,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to bind thread to NUMA node: %d.",
+			 function,
+			 storage_media_buffer->node_index );
+
+			goto on_error;
+		}
+	}
+	if( imaging_handle->thread_autotune != NULL )
+	{
+		if( thread_autotune_acquire(
+		     imaging_handle->thread_autotune,
+		     &autotune_start_timestamp,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to acquire thread autotune slot.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( imaging_handle->stats_output != NULL )
+	{
+		if( ewftools_timestamp_get_monotonic(
+		     &stats_start_timestamp,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve statistics start timestamp.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* The chunk fingerprints are calculated of the data before it is packed
+	 */
+	if( imaging_handle_calculate_chunk_fingerprints(
+	     imaging_handle,
+	     storage_media_buffer,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to calculate chunk fingerprints.",
+		 function );
+
+		goto on_error;
+	}
+	process_count = storage_media_buffer_write_process(
+			 storage_media_buffer,
+			 &error );
+
+	if( imaging_handle->thread_autotune != NULL )
+	{
+		if( thread_autotune_release(
+		     imaging_handle->thread_autotune,
+		     autotune_start_timestamp,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release thread autotune slot.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( process_count < 0 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to prepare storage media buffer before write.",
+		 function );
+
+		goto on_error;
+	}
+	if( imaging_handle->stats_output != NULL )
+	{
+		if( stats_output_add_stage(
+		     imaging_handle->stats_output,
+		     STATS_OUTPUT_STAGE_PROCESS,
+		     (size64_t) process_count,
+		     stats_start_timestamp,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to add process to statistics output.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_thread_pool_push_sorted(
+	     imaging_handle->output_thread_pool,
+	     (intptr_t *) storage_media_buffer,
+	     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &storage_media_buffer_compare,
+	     LIBCTHREADS_SORT_FLAG_UNIQUE_VALUES,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push storage media buffer onto output thread pool queue.",
+		 function );
+
+		goto on_error;
+	}
+	storage_media_buffer = NULL;
+
+	return( 1 );
+
+on_error:
+	if( storage_media_buffer != NULL )
+	{
+		if( storage_media_buffer_queue_release_buffer(
+		     imaging_handle->storage_media_buffer_queue,
+		     storage_media_buffer,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to release storage media buffer onto queue.",
+			 function );
+
+			storage_media_buffer_free(
+			 &storage_media_buffer,
+			 NULL );
+		}
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Prepares a storage media buffer for imaging
+ * Callback function for the process thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_output_storage_media_buffer_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     imaging_handle_t *imaging_handle )
+{
+	libcdata_list_element_t *element      = NULL;
+	libcdata_list_element_t *next_element = NULL;
+        libcerror_error_t *error              = NULL;
+        static char *function                 = "imaging_handle_output_storage_media_buffer_callback";
+	ssize_t write_count                   = 0;
+	int number_of_pending_buffers         = 0;
+	int result                            = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_list_insert_value(
+	     imaging_handle->output_list,
+	     (intptr_t *) storage_media_buffer,
+	     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &storage_media_buffer_compare,
+	     LIBCDATA_INSERT_FLAG_UNIQUE_ENTRIES,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to insert storage media buffer into output list.",
+		 function );
+
+		goto on_error;
+	}
+	storage_media_buffer = NULL;
+
+	if( libcdata_list_get_first_element(
+	     imaging_handle->output_list,
+	     &element,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve first element.",
+		 function );
+
+		goto on_error;
+	}
+	while( element != NULL )
+	{
+		if( libcdata_list_element_get_value(
+		     element,
+		     (intptr_t **) &storage_media_buffer,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve value from list element.",
+			 function );
+
+			storage_media_buffer = NULL;
+
+			goto on_error;
+		}
+		if( storage_media_buffer == NULL )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing storage media buffer.",
+			 function );
+
+			return( -1 );
+		}
+		if( storage_media_buffer->storage_media_offset != imaging_handle->last_offset_written )
+		{
+			break;
+		}
+		write_count = imaging_handle_write_storage_media_buffer(
+			       imaging_handle,
+			       storage_media_buffer,
+			       storage_media_buffer->processed_size,
+			       &error );
+
+		if( write_count < 0 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write storage media buffer.",
+			 function );
+
+			storage_media_buffer = NULL;
+
+			goto on_error;
 		}
-		if( digest_hash_copy_to_string(
-		     calculated_sha1_hash,
-		     LIBHMAC_SHA1_HASH_SIZE,
-		     imaging_handle->calculated_sha1_hash_string,
-		     41,
-		     error ) != 1 )
+		imaging_handle->last_offset_written = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
+
+		if( libcdata_list_element_get_next_element(
+		     element,
+		     &next_element,
+		     &error ) != 1 )
 		{
 			libcerror_error_set(
-			 error,
+			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create calculated SHA1 hash string.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next list element.",
 			 function );
 
-			return( -1 );
+			storage_media_buffer = NULL;
+
+			goto on_error;
 		}
-	}
-	if( imaging_handle->calculate_sha256 != 0 )
-	{
-		if( imaging_handle->calculated_sha256_hash_string == NULL )
+		if( libcdata_list_remove_element(
+		     imaging_handle->output_list,
+		     element,
+		     &error ) != 1 )
 		{
 			libcerror_error_set(
-			 error,
+			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid imaging handle - missing calculated SHA256 hash string.",
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove list element from output list.",
 			 function );
 
-			return( -1 );
+			storage_media_buffer = NULL;
+
+			goto on_error;
 		}
-		if( libhmac_sha256_finalize(
-		     imaging_handle->sha256_context,
-		     calculated_sha256_hash,
-		     LIBHMAC_SHA256_HASH_SIZE,
-		     error ) != 1 )
+		/* The output list no longer manages the list element and the storage media buffer it contains
+		 */
+		if( libcdata_list_element_free(
+		     &element,
+		     NULL,
+		     &error ) != 1 )
 		{
 			libcerror_error_set(
-			 error,
+			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to finalize SHA256 hash.",
+			 "%s: unable to free list element.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
-		if( digest_hash_copy_to_string(
-		     calculated_sha256_hash,
-		     LIBHMAC_SHA256_HASH_SIZE,
-		     imaging_handle->calculated_sha256_hash_string,
-		     65,
-		     error ) != 1 )
+		element = next_element;
+
+		if( storage_media_buffer_queue_release_buffer(
+		     imaging_handle->storage_media_buffer_queue,
+		     storage_media_buffer,
+		     &error ) != 1 )
 		{
 			libcerror_error_set(
-			 error,
+			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create calculated SHA256 hash string.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to release storage media buffer onto queue.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
-	}
-	return( 1 );
-}
-
-#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		storage_media_buffer = NULL;
 
-/* Prepares a storage media buffer for imaging
- * Callback function for the process thread pool
- * Returns 1 if successful or -1 on error
- */
-int imaging_handle_process_storage_media_buffer_callback(
-     storage_media_buffer_t *storage_media_buffer,
-     imaging_handle_t *imaging_handle )
-{
-        libcerror_error_t *error = NULL;
-        static char *function    = "imaging_handle_process_storage_media_buffer_callback";
-	ssize_t process_count    = 0;
+		if( imaging_handle->acquiry_size == 0 )
+		{
+			result = process_status_update_unknown_total(
+			          imaging_handle->process_status,
+			          imaging_handle->last_offset_written,
+		        	  &error );
+		}
+		else
+		{
+			result = process_status_update(
+			          imaging_handle->process_status,
+			          imaging_handle->last_offset_written,
+			          imaging_handle->acquiry_size,
+		        	  &error );
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update process status.",
+			 function );
 
-	if( storage_media_buffer == NULL )
-	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid storage media buffer.",
-		 function );
+			goto on_error;
+		}
+		if( imaging_handle->thread_autotune != NULL )
+		{
+			if( thread_autotune_update(
+			     imaging_handle->thread_autotune,
+			     (size64_t) imaging_handle->last_offset_written,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update thread autotune.",
+				 function );
 
-		goto on_error;
+				goto on_error;
+			}
+		}
 	}
-	process_count = storage_media_buffer_write_process(
-			 storage_media_buffer,
-			 &error );
+	/* The storage media buffer that ended the loop remains in the output list
+	 */
+	storage_media_buffer = NULL;
 
-	if( process_count < 0 )
+	/* The buffers that remain in the output list wait on the buffer with the next offset
+	 */
+	if( libcdata_list_get_number_of_elements(
+	     imaging_handle->output_list,
+	     &number_of_pending_buffers,
+	     &error ) != 1 )
 	{
 		libcerror_error_set(
 		 &error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to prepare storage media buffer before write.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of pending buffers.",
 		 function );
 
 		goto on_error;
 	}
-	if( libcthreads_thread_pool_push_sorted(
-	     imaging_handle->output_thread_pool,
-	     (intptr_t *) storage_media_buffer,
-	     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &storage_media_buffer_compare,
-	     LIBCTHREADS_SORT_FLAG_UNIQUE_VALUES,
+	if( storage_media_buffer_queue_update_output_stall(
+	     imaging_handle->storage_media_buffer_queue,
+	     number_of_pending_buffers,
 	     &error ) != 1 )
 	{
 		libcerror_error_set(
 		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to push storage media buffer onto output thread pool queue.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update output stall.",
 		 function );
 
 		goto on_error;
 	}
-	storage_media_buffer = NULL;
-
 	return( 1 );
 
 on_error:
@@ -1728,20 +3469,18 @@ on_error:
 	return( -1 );
 }
 
-/* Prepares a storage media buffer for imaging
- * Callback function for the process thread pool
+/* Writes a storage media buffer to the secondary output handle
+ * Callback function for the secondary output thread pool
+ * The storage media buffers are written in the order they were pushed by the output thread
  * Returns 1 if successful or -1 on error
  */
-int imaging_handle_output_storage_media_buffer_callback(
+int imaging_handle_secondary_output_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      imaging_handle_t *imaging_handle )
 {
-	libcdata_list_element_t *element      = NULL;
-	libcdata_list_element_t *next_element = NULL;
-        libcerror_error_t *error              = NULL;
-        static char *function                 = "imaging_handle_output_storage_media_buffer_callback";
-	ssize_t write_count                   = 0;
-	int result                            = 0;
+        libcerror_error_t *error = NULL;
+        static char *function    = "imaging_handle_secondary_output_storage_media_buffer_callback";
+	ssize_t write_count      = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -1765,60 +3504,122 @@ int imaging_handle_output_storage_media_buffer_callback(
 
 		goto on_error;
 	}
-	if( libcdata_list_insert_value(
-	     imaging_handle->output_list,
-	     (intptr_t *) storage_media_buffer,
-	     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &storage_media_buffer_compare,
-	     LIBCDATA_INSERT_FLAG_UNIQUE_ENTRIES,
+	/* Once a write failed the remaining buffers are only released
+	 * since the secondary output is no longer contiguous
+	 */
+	if( imaging_handle->secondary_output_failed == 0 )
+	{
+		write_count = storage_media_buffer_write_to_handle(
+		               storage_media_buffer,
+		               imaging_handle->secondary_output_handle,
+		               storage_media_buffer->processed_size,
+		               &error );
+
+		if( write_count < 0 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write storage media buffer to secondary output handle.",
+			 function );
+
+			imaging_handle->secondary_output_failed = 1;
+		}
+	}
+	if( storage_media_buffer_queue_release_buffer(
+	     imaging_handle->storage_media_buffer_queue,
+	     storage_media_buffer,
 	     &error ) != 1 )
 	{
 		libcerror_error_set(
 		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to insert storage media buffer into output list.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to release storage media buffer onto queue.",
 		 function );
 
 		goto on_error;
 	}
-	storage_media_buffer = NULL;
+	if( error != NULL )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Empties the output list
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_empty_output_list(
+     imaging_handle_t *imaging_handle,
+     libcerror_error_t **error )
+{
+	libcdata_list_element_t *element             = NULL;
+	libcdata_list_element_t *next_element        = NULL;
+	storage_media_buffer_t *storage_media_buffer = NULL;
+        static char *function                        = "imaging_handle_empty_output_list";
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
 
+		return( -1 );
+	}
 	if( libcdata_list_get_first_element(
 	     imaging_handle->output_list,
 	     &element,
-	     &error ) != 1 )
+	     error ) != 1 )
 	{
 		libcerror_error_set(
-		 &error,
+		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
 		 "%s: unable to retrieve first element.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 	while( element != NULL )
 	{
 		if( libcdata_list_element_get_value(
 		     element,
 		     (intptr_t **) &storage_media_buffer,
-		     &error ) != 1 )
+		     error ) != 1 )
 		{
 			libcerror_error_set(
-			 &error,
+			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
 			 "%s: unable to retrieve value from list element.",
 			 function );
 
-			storage_media_buffer = NULL;
-
-			goto on_error;
+			return( -1 );
 		}
 		if( storage_media_buffer == NULL )
 		{
 			libcerror_error_set(
-			 &error,
+			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
 			 "%s: missing storage media buffer.",
@@ -1826,172 +3627,224 @@ int imaging_handle_output_storage_media_buffer_callback(
 
 			return( -1 );
 		}
-		if( storage_media_buffer->storage_media_offset != imaging_handle->last_offset_written )
-		{
-			break;
-		}
-		write_count = imaging_handle_write_storage_media_buffer(
-			       imaging_handle,
-			       storage_media_buffer,
-			       storage_media_buffer->processed_size,
-			       &error );
-
-		if( write_count < 0 )
+		if( storage_media_buffer_queue_release_buffer(
+		     imaging_handle->storage_media_buffer_queue,
+		     storage_media_buffer,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write storage media buffer.",
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to release storage media buffer onto queue.",
 			 function );
 
-			storage_media_buffer = NULL;
-
-			goto on_error;
+			return( -1 );
 		}
-		imaging_handle->last_offset_written = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
+		storage_media_buffer = NULL;
 
 		if( libcdata_list_element_get_next_element(
 		     element,
 		     &next_element,
-		     &error ) != 1 )
+		     error ) != 1 )
 		{
 			libcerror_error_set(
-			 &error,
+			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
 			 "%s: unable to retrieve next list element.",
 			 function );
 
-			storage_media_buffer = NULL;
-
-			goto on_error;
+			return( -1 );
 		}
 		if( libcdata_list_remove_element(
 		     imaging_handle->output_list,
 		     element,
-		     &error ) != 1 )
+		     error ) != 1 )
 		{
 			libcerror_error_set(
-			 &error,
+			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
 			 "%s: unable to remove list element from output list.",
 			 function );
 
-			storage_media_buffer = NULL;
-
-			goto on_error;
+			return( -1 );
 		}
 		/* The output list no longer manages the list element and the storage media buffer it contains
 		 */
 		if( libcdata_list_element_free(
 		     &element,
 		     NULL,
-		     &error ) != 1 )
+		     error ) != 1 )
 		{
 			libcerror_error_set(
-			 &error,
+			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
 			 "%s: unable to free list element.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
 		element = next_element;
+	}
+	return( 1 );
+}
 
-		if( storage_media_buffer_queue_release_buffer(
-		     imaging_handle->storage_media_buffer_queue,
-		     storage_media_buffer,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
-			 function );
+/* Creates the process thread pools
+ * A process thread pool is created for every NUMA node, the threads of which
+ * process the storage media buffers of that node
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_create_process_thread_pools(
+     imaging_handle_t *imaging_handle,
+     int maximum_number_of_queued_items,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_create_process_thread_pools";
+	int node_index        = 0;
+	int number_of_nodes   = 0;
+	int number_of_threads = 0;
 
-			goto on_error;
-		}
-		storage_media_buffer = NULL;
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
 
-		if( imaging_handle->acquiry_size == 0 )
-		{
-			result = process_status_update_unknown_total(
-			          imaging_handle->process_status,
-			          imaging_handle->last_offset_written,
-		        	  &error );
-		}
-		else
-		{
-			result = process_status_update(
-			          imaging_handle->process_status,
-			          imaging_handle->last_offset_written,
-			          imaging_handle->acquiry_size,
-		        	  &error );
-		}
-		if( result != 1 )
+		return( -1 );
+	}
+	if( imaging_handle->number_of_process_thread_pools != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid imaging handle - process thread pools value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( numa_topology_initialize(
+	     &( imaging_handle->numa_topology ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create NUMA topology.",
+		 function );
+
+		goto on_error;
+	}
+	if( numa_topology_get_number_of_nodes(
+	     imaging_handle->numa_topology,
+	     &number_of_nodes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of NUMA nodes.",
+		 function );
+
+		goto on_error;
+	}
+	/* Do not create more process thread pools than process threads
+	 */
+	if( number_of_nodes > imaging_handle->number_of_threads )
+	{
+		number_of_nodes = imaging_handle->number_of_threads;
+
+		if( numa_topology_set_maximum_number_of_nodes(
+		     imaging_handle->numa_topology,
+		     number_of_nodes,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
-			 &error,
+			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update process status.",
+			 "%s: unable to set maximum number of NUMA nodes.",
 			 function );
 
 			goto on_error;
 		}
 	}
-	return( 1 );
+	number_of_threads = imaging_handle->number_of_threads / number_of_nodes;
 
-on_error:
-	if( storage_media_buffer != NULL )
+	for( node_index = 0;
+	     node_index < number_of_nodes;
+	     node_index++ )
 	{
-		if( storage_media_buffer_queue_release_buffer(
-		     imaging_handle->storage_media_buffer_queue,
-		     storage_media_buffer,
-		     &error ) != 1 )
+		if( libcthreads_thread_pool_create(
+		     &( imaging_handle->process_thread_pools[ node_index ] ),
+		     NULL,
+		     number_of_threads,
+		     maximum_number_of_queued_items,
+		     (int (*)(intptr_t *, void *)) &imaging_handle_process_storage_media_buffer_callback,
+		     (void *) imaging_handle,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
-			 &error,
+			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize process thread pool: %d.",
+			 function,
+			 node_index );
 
-			storage_media_buffer_free(
-			 &storage_media_buffer,
-			 NULL );
+			goto on_error;
 		}
+		imaging_handle->number_of_process_thread_pools += 1;
 	}
-	if( error != NULL )
+	if( ( imaging_handle->autotune_number_of_threads != 0 )
+	 && ( imaging_handle->thread_autotune == NULL ) )
 	{
-#if defined( HAVE_VERBOSE_OUTPUT )
-		if( libcnotify_verbose != 0 )
+		number_of_threads *= number_of_nodes;
+
+		if( thread_autotune_initialize(
+		     &( imaging_handle->thread_autotune ),
+		     number_of_threads,
+		     ( number_of_threads < 4 ) ? number_of_threads : 4,
+		     error ) != 1 )
 		{
-			libcnotify_print_error_backtrace(
-			 error );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread autotune.",
+			 function );
+
+			goto on_error;
 		}
-#endif
-		libcerror_error_free(
-		 &error );
 	}
+	return( 1 );
+
+on_error:
+	imaging_handle_join_process_thread_pools(
+	 imaging_handle,
+	 NULL );
+
 	return( -1 );
 }
 
-/* Empties the output list
+/* Pushes a storage media buffer onto the process thread pool of its NUMA node
  * Returns 1 if successful or -1 on error
  */
-int imaging_handle_empty_output_list(
+int imaging_handle_push_process_thread_pools(
      imaging_handle_t *imaging_handle,
+     storage_media_buffer_t *storage_media_buffer,
      libcerror_error_t **error )
 {
-	libcdata_list_element_t *element             = NULL;
-	libcdata_list_element_t *next_element        = NULL;
-	storage_media_buffer_t *storage_media_buffer = NULL;
-        static char *function                        = "imaging_handle_empty_output_list";
+	static char *function = "imaging_handle_push_process_thread_pools";
+	int pool_index        = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -2004,110 +3857,111 @@ int imaging_handle_empty_output_list(
 
 		return( -1 );
 	}
-	if( libcdata_list_get_first_element(
-	     imaging_handle->output_list,
-	     &element,
-	     error ) != 1 )
+	if( imaging_handle->number_of_process_thread_pools <= 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid imaging handle - missing process thread pools.",
 		 function );
 
 		return( -1 );
 	}
-	while( element != NULL )
+	if( storage_media_buffer == NULL )
 	{
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
 
-			return( -1 );
-		}
-		if( storage_media_buffer == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
-			 function );
+		return( -1 );
+	}
+	pool_index = storage_media_buffer->node_index % imaging_handle->number_of_process_thread_pools;
 
-			return( -1 );
-		}
-		if( storage_media_buffer_queue_release_buffer(
-		     imaging_handle->storage_media_buffer_queue,
-		     storage_media_buffer,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
-			 function );
+	if( libcthreads_thread_pool_push(
+	     imaging_handle->process_thread_pools[ pool_index ],
+	     (intptr_t *) storage_media_buffer,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push storage media buffer onto process thread pool: %d queue.",
+		 function,
+		 pool_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
 
-			return( -1 );
-		}
-		storage_media_buffer = NULL;
+/* Joins the process thread pools and frees the NUMA topology
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_join_process_thread_pools(
+     imaging_handle_t *imaging_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_join_process_thread_pools";
+	int pool_index        = 0;
+	int result            = 1;
 
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
-			 function );
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
 
-			return( -1 );
-		}
-		if( libcdata_list_remove_element(
-		     imaging_handle->output_list,
-		     element,
-		     error ) != 1 )
+		return( -1 );
+	}
+	for( pool_index = 0;
+	     pool_index < NUMA_TOPOLOGY_MAXIMUM_NUMBER_OF_NODES;
+	     pool_index++ )
+	{
+		if( imaging_handle->process_thread_pools[ pool_index ] != NULL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
-			 function );
+			if( libcthreads_thread_pool_join(
+			     &( imaging_handle->process_thread_pools[ pool_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join process thread pool: %d.",
+				 function,
+				 pool_index );
 
-			return( -1 );
+				result = -1;
+			}
 		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
+	}
+	imaging_handle->number_of_process_thread_pools = 0;
+
+	if( imaging_handle->numa_topology != NULL )
+	{
+		if( numa_topology_free(
+		     &( imaging_handle->numa_topology ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
+			 "%s: unable to free NUMA topology.",
 			 function );
 
-			return( -1 );
+			result = -1;
 		}
-		element = next_element;
 	}
-	return( 1 );
+	return( result );
 }
 
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
@@ -3965,6 +5819,68 @@ int imaging_handle_set_maximum_segment_size(
 	return( result );
 }
 
+/* Sets the size of the ranges of the range digests
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int imaging_handle_set_range_digests_range_size(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_set_range_digests_range_size";
+	size_t string_length  = 0;
+	int result            = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	result = byte_size_string_convert(
+	          string,
+	          string_length,
+	          &( imaging_handle->range_digests_range_size ),
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine range digests range size.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		/* The range size is a multiple of 512 bytes so that a range
+		 * that does not match can be mapped onto sectors
+		 */
+		if( ( imaging_handle->range_digests_range_size < RANGE_DIGESTS_MINIMUM_RANGE_SIZE )
+		 || ( imaging_handle->range_digests_range_size > (size64_t) INT64_MAX )
+		 || ( ( imaging_handle->range_digests_range_size % 512 ) != 0 ) )
+		{
+			result = 0;
+		}
+	}
+	if( result == 0 )
+	{
+		imaging_handle->range_digests_range_size = RANGE_DIGESTS_DEFAULT_RANGE_SIZE;
+	}
+	return( result );
+}
+
 /* Sets the acquiry offset
  * Returns 1 if successful, 0 if unsupported value or -1 on error
  */
@@ -4211,7 +6127,35 @@ int imaging_handle_set_number_of_threads(
 	string_length = system_string_length(
 	                 string );
 
-	if( string[ 0 ] != (system_character_t) '-' )
+	if( ( string_length == 4 )
+	 && ( system_string_compare(
+	       string,
+	       _SYSTEM_STRING( "auto" ),
+	       4 ) == 0 ) )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		/* The process thread pools are created with the maximum number of threads
+		 * of which the thread autotune determines how many process at the same time
+		 */
+		if( thread_autotune_get_maximum_number_of_threads(
+		     &( imaging_handle->number_of_threads ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine maximum number of threads.",
+			 function );
+
+			return( -1 );
+		}
+		imaging_handle->autotune_number_of_threads = 1;
+
+		result = 1;
+#endif
+	}
+	else if( string[ 0 ] != (system_character_t) '-' )
 	{
 		string_length = system_string_length(
 				 string );
@@ -4245,6 +6189,91 @@ int imaging_handle_set_number_of_threads(
 	return( result );
 }
 
+/* Sets the rate limit
+ * A rate limit of 0 represents unlimited
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int imaging_handle_set_rate_limit(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_set_rate_limit";
+	size_t string_length  = 0;
+	uint64_t rate         = 0;
+	int result            = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	result = byte_size_string_convert(
+	          string,
+	          string_length,
+	          &rate,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine rate limit.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( imaging_handle->rate_limiter == NULL )
+	{
+		if( rate_limiter_initialize(
+		     &( imaging_handle->rate_limiter ),
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create rate limiter.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	result = rate_limiter_set_rate(
+	          imaging_handle->rate_limiter,
+	          (size64_t) rate,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set rate.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
 /* Sets the additional digest types
  * Returns 1 if successful or -1 on error
  */
@@ -5764,6 +7793,64 @@ int imaging_handle_append_track(
 	return( 1 );
 }
 
+/* Appends single files entries (ltree) data to the output handle
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_append_ltree_data(
+     imaging_handle_t *imaging_handle,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_append_ltree_data";
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_append_utf8_ltree_data(
+	     imaging_handle->output_handle,
+	     utf8_string,
+	     utf8_string_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append ltree data.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle->secondary_output_handle != NULL )
+	{
+		if( libewf_handle_append_utf8_ltree_data(
+		     imaging_handle->secondary_output_handle,
+		     utf8_string,
+		     utf8_string_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append ltree data to secondary output handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
 /* Finalizes the imaging handle
  * Returns the number of input bytes written or -1 on error
  */
@@ -6139,6 +8226,12 @@ int imaging_handle_print_parameters(
 		 imaging_handle->notify_stream,
 		 "memory (RAM)" );
 	}
+	else if( imaging_handle->media_type == LIBEWF_MEDIA_TYPE_SINGLE_FILES )
+	{
+		fprintf(
+		 imaging_handle->notify_stream,
+		 "single files (logical)" );
+	}
 	fprintf(
 	 imaging_handle->notify_stream,
 	 "\n" );
@@ -6279,6 +8372,12 @@ int imaging_handle_print_parameters(
 		 imaging_handle->notify_stream,
 		 "bzip2" );
 	}
+	else if( imaging_handle->compression_method == LIBEWF_COMPRESSION_METHOD_ZSTD )
+	{
+		fprintf(
+		 imaging_handle->notify_stream,
+		 "zstd" );
+	}
 	fprintf(
 	 imaging_handle->notify_stream,
 	 "\n" );
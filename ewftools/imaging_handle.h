@@ -26,13 +26,25 @@
 #include <file_stream.h>
 #include <types.h>
 
+#include "chunk_fingerprints.h"
+#include "digest_pipeline.h"
 #include "ewftools_libcdata.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libcthreads.h"
 #include "ewftools_libewf.h"
 #include "ewftools_libhmac.h"
+#include "md5_context.h"
+#include "numa_topology.h"
 #include "process_status.h"
+#include "range_digests.h"
+#include "rate_limiter.h"
+#include "restart_checkpoint.h"
+#include "sha1_context.h"
+#include "sha256_context.h"
+#include "stats_output.h"
 #include "storage_media_buffer.h"
+#include "storage_media_buffer_queue.h"
+#include "thread_autotune.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -160,7 +172,7 @@ struct imaging_handle
 
 	/* The MD5 digest context
 	 */
-	libhmac_md5_context_t *md5_context;
+	md5_context_t *md5_context;
 
 	/* Value to indicate the MD5 digest context was initialized
 	 */
@@ -176,7 +188,7 @@ struct imaging_handle
 
 	/* The SHA1 digest context
 	 */
-	libhmac_sha1_context_t *sha1_context;
+	sha1_context_t *sha1_context;
 
 	/* Value to indicate the SHA1 digest context was initialized
 	 */
@@ -192,7 +204,7 @@ struct imaging_handle
 
 	/* The SHA256 digest context
 	 */
-	libhmac_sha256_context_t *sha256_context;
+	sha256_context_t *sha256_context;
 
 	/* Value to indicate the SHA256 digest context was initialized
 	 */
@@ -202,10 +214,66 @@ struct imaging_handle
 	 */
 	system_character_t *calculated_sha256_hash_string;
 
+	/* The range digests filename
+	 */
+	system_character_t *range_digests_filename;
+
+	/* The range digests filename size
+	 */
+	size_t range_digests_filename_size;
+
+	/* The range digests
+	 */
+	range_digests_t *range_digests;
+
+	/* The size of the ranges of the range digests
+	 */
+	size64_t range_digests_range_size;
+
+	/* The chunk fingerprints filename
+	 */
+	system_character_t *chunk_fingerprints_filename;
+
+	/* The chunk fingerprints filename size
+	 */
+	size_t chunk_fingerprints_filename_size;
+
+	/* The base chunk fingerprints filename
+	 */
+	system_character_t *base_chunk_fingerprints_filename;
+
+	/* The base chunk fingerprints filename size
+	 */
+	size_t base_chunk_fingerprints_filename_size;
+
+	/* The chunk fingerprints
+	 */
+	chunk_fingerprints_t *chunk_fingerprints;
+
+	/* The restart checkpoint filename
+	 */
+	system_character_t *restart_checkpoint_filename;
+
+	/* The restart checkpoint filename size
+	 */
+	size_t restart_checkpoint_filename_size;
+
 	/* Value to indicate if the chunk data instead of the buffered read and write functions should be used
 	 */
 	uint8_t use_chunk_data_functions;
 
+	/* Value to indicate if the chunk data and storage media buffers should be backed by huge pages
+	 */
+	uint8_t use_huge_pages;
+
+	/* Value to indicate the written segment files should not be retained in the page cache
+	 */
+	uint8_t unbuffered_output;
+
+	/* Value to indicate the segment files should be written strictly sequentially
+	 */
+	uint8_t sequential_output;
+
 	/* The process buffer size
 	 */
 	size_t process_buffer_size;
@@ -214,23 +282,52 @@ struct imaging_handle
 	 */
 	int number_of_threads;
 
+	/* Value to indicate the number of process threads is adjusted at runtime
+	 */
+	uint8_t autotune_number_of_threads;
+
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 
-	/* The process thread pool
+	/* The NUMA topology
 	 */
-	libcthreads_thread_pool_t *process_thread_pool;
+	numa_topology_t *numa_topology;
+
+	/* The process thread pools, one per NUMA node
+	 */
+	libcthreads_thread_pool_t *process_thread_pools[ NUMA_TOPOLOGY_MAXIMUM_NUMBER_OF_NODES ];
+
+	/* The number of process thread pools
+	 */
+	int number_of_process_thread_pools;
+
+	/* The thread autotune
+	 */
+	thread_autotune_t *thread_autotune;
 
 	/* The output thread pool
 	 */
 	libcthreads_thread_pool_t *output_thread_pool;
 
+	/* The secondary output thread pool, which writes the storage media buffers
+	 * to the secondary output handle concurrently with the output thread pool
+	 */
+	libcthreads_thread_pool_t *secondary_output_thread_pool;
+
+	/* Value to indicate a write to the secondary output handle failed
+	 */
+	int secondary_output_failed;
+
 	/* The output list
 	 */
 	libcdata_list_t *output_list;
 
 	/* The storage media buffer queue
 	 */
-	libcthreads_queue_t *storage_media_buffer_queue;
+	storage_media_buffer_queue_t *storage_media_buffer_queue;
+
+	/* The digest pipeline
+	 */
+	digest_pipeline_t *digest_pipeline;
 
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
@@ -258,6 +355,14 @@ struct imaging_handle
 	 */
 	process_status_t *process_status;
 
+	/* The statistics output, which is not managed by the imaging handle
+	 */
+	stats_output_t *stats_output;
+
+	/* The rate limiter, which is NULL if the acquiry rate is not limited
+	 */
+	rate_limiter_t *rate_limiter;
+
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
@@ -304,6 +409,29 @@ int imaging_handle_close(
      imaging_handle_t *imaging_handle,
      libcerror_error_t **error );
 
+int imaging_handle_open_chunk_fingerprints(
+     imaging_handle_t *imaging_handle,
+     libcerror_error_t **error );
+
+int imaging_handle_close_chunk_fingerprints(
+     imaging_handle_t *imaging_handle,
+     libcerror_error_t **error );
+
+int imaging_handle_print_changed_chunks(
+     imaging_handle_t *imaging_handle,
+     FILE *stream,
+     libcerror_error_t **error );
+
+int imaging_handle_calculate_chunk_fingerprints(
+     imaging_handle_t *imaging_handle,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error );
+
+int imaging_handle_append_chunk_fingerprints(
+     imaging_handle_t *imaging_handle,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error );
+
 ssize_t imaging_handle_write_storage_media_buffer(
          imaging_handle_t *imaging_handle,
          storage_media_buffer_t *storage_media_buffer,
@@ -330,12 +458,32 @@ int imaging_handle_initialize_integrity_hash(
      imaging_handle_t *imaging_handle,
      libcerror_error_t **error );
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int imaging_handle_start_digest_pipeline(
+     imaging_handle_t *imaging_handle,
+     libcerror_error_t **error );
+
+#endif
+
 int imaging_handle_update_integrity_hash(
      imaging_handle_t *imaging_handle,
      const uint8_t *buffer,
      size_t buffer_size,
      libcerror_error_t **error );
 
+int imaging_handle_read_restart_checkpoint(
+     imaging_handle_t *imaging_handle,
+     off64_t maximum_offset,
+     off64_t *hashed_offset,
+     libcerror_error_t **error );
+
+int imaging_handle_write_restart_checkpoint(
+     imaging_handle_t *imaging_handle,
+     off64_t hashed_offset,
+     uint8_t append,
+     libcerror_error_t **error );
+
 int imaging_handle_finalize_integrity_hash(
      imaging_handle_t *imaging_handle,
      libcerror_error_t **error );
@@ -350,10 +498,28 @@ int imaging_handle_output_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      imaging_handle_t *imaging_handle );
 
+int imaging_handle_secondary_output_storage_media_buffer_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     imaging_handle_t *imaging_handle );
+
 int imaging_handle_empty_output_list(
      imaging_handle_t *imaging_handle,
      libcerror_error_t **error );
 
+int imaging_handle_create_process_thread_pools(
+     imaging_handle_t *imaging_handle,
+     int maximum_number_of_queued_items,
+     libcerror_error_t **error );
+
+int imaging_handle_push_process_thread_pools(
+     imaging_handle_t *imaging_handle,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error );
+
+int imaging_handle_join_process_thread_pools(
+     imaging_handle_t *imaging_handle,
+     libcerror_error_t **error );
+
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 int imaging_handle_get_chunk_size(
@@ -474,6 +640,11 @@ int imaging_handle_set_maximum_segment_size(
      const system_character_t *string,
      libcerror_error_t **error );
 
+int imaging_handle_set_range_digests_range_size(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
 int imaging_handle_set_acquiry_offset(
      imaging_handle_t *imaging_handle,
      const system_character_t *string,
@@ -499,6 +670,11 @@ int imaging_handle_set_number_of_threads(
      const system_character_t *string,
      libcerror_error_t **error );
 
+int imaging_handle_set_rate_limit(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
 int imaging_handle_set_additional_digest_types(
      imaging_handle_t *imaging_handle,
      const system_character_t *string,
@@ -553,6 +729,12 @@ int imaging_handle_append_track(
      uint64_t number_of_sectors,
      libcerror_error_t **error );
 
+int imaging_handle_append_ltree_data(
+     imaging_handle_t *imaging_handle,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libcerror_error_t **error );
+
 ssize_t imaging_handle_finalize(
          imaging_handle_t *imaging_handle,
          libcerror_error_t **error );
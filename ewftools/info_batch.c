@@ -0,0 +1,1349 @@
+/*
+ * Info batch
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libewf.h"
+#include "ewftools_system_string.h"
+#include "info_batch.h"
+#include "info_handle.h"
+
+/* Creates an info batch
+ * The output format, date format, header codepage and notification output stream
+ * are copied from the info handle
+ * Make sure the value info_batch is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int info_batch_initialize(
+     info_batch_t **info_batch,
+     info_handle_t *info_handle,
+     char info_option,
+     libcerror_error_t **error )
+{
+	static char *function = "info_batch_initialize";
+
+	if( info_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( *info_batch != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid info batch value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( info_option != 'a' )
+	 && ( info_option != 'c' )
+	 && ( info_option != 'e' )
+	 && ( info_option != 'i' )
+	 && ( info_option != 'm' ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported info option.",
+		 function );
+
+		return( -1 );
+	}
+	*info_batch = memory_allocate_structure(
+	               info_batch_t );
+
+	if( *info_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create info batch.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *info_batch,
+	     0,
+	     sizeof( info_batch_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear info batch.",
+		 function );
+
+		memory_free(
+		 *info_batch );
+
+		*info_batch = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *info_batch )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *info_batch )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	( *info_batch )->number_of_threads = 4;
+#endif
+	( *info_batch )->output_format   = info_handle->output_format;
+	( *info_batch )->date_format     = info_handle->date_format;
+	( *info_batch )->header_codepage = info_handle->header_codepage;
+	( *info_batch )->info_option     = info_option;
+	( *info_batch )->notify_stream   = info_handle->notify_stream;
+
+	return( 1 );
+
+on_error:
+	if( *info_batch != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *info_batch )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *info_batch )->mutex ),
+			 NULL );
+		}
+#endif
+		memory_free(
+		 *info_batch );
+
+		*info_batch = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an info batch
+ * Returns 1 if successful or -1 on error
+ */
+int info_batch_free(
+     info_batch_t **info_batch,
+     libcerror_error_t **error )
+{
+	static char *function = "info_batch_free";
+	int entry_index       = 0;
+	int handle_index      = 0;
+	int result            = 1;
+
+	if( info_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( *info_batch != NULL )
+	{
+		if( ( *info_batch )->entries != NULL )
+		{
+			for( entry_index = 0;
+			     entry_index < ( *info_batch )->number_of_entries;
+			     entry_index++ )
+			{
+				if( ( *info_batch )->entries[ entry_index ].output_stream != NULL )
+				{
+					file_stream_close(
+					 ( *info_batch )->entries[ entry_index ].output_stream );
+				}
+				if( ( *info_batch )->entries[ entry_index ].error != NULL )
+				{
+					libcerror_error_free(
+					 &( ( *info_batch )->entries[ entry_index ].error ) );
+				}
+			}
+			memory_free(
+			 ( *info_batch )->entries );
+		}
+		if( ( *info_batch )->info_handles != NULL )
+		{
+			for( handle_index = 0;
+			     handle_index < ( *info_batch )->number_of_info_handles;
+			     handle_index++ )
+			{
+				if( info_handle_free(
+				     &( ( *info_batch )->info_handles[ handle_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free info handle: %d.",
+					 function,
+					 handle_index );
+
+					result = -1;
+				}
+			}
+			memory_free(
+			 ( *info_batch )->info_handles );
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_condition_free(
+		     &( ( *info_batch )->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *info_batch )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *info_batch );
+
+		*info_batch = NULL;
+	}
+	return( result );
+}
+
+/* Signals the info batch to abort
+ * Returns 1 if successful or -1 on error
+ */
+int info_batch_signal_abort(
+     info_batch_t *info_batch,
+     libcerror_error_t **error )
+{
+	static char *function = "info_batch_signal_abort";
+	int handle_index      = 0;
+
+	if( info_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info batch.",
+		 function );
+
+		return( -1 );
+	}
+	info_batch->abort = 1;
+
+	if( info_batch->info_handles != NULL )
+	{
+		for( handle_index = 0;
+		     handle_index < info_batch->number_of_info_handles;
+		     handle_index++ )
+		{
+			if( info_handle_signal_abort(
+			     info_batch->info_handles[ handle_index ],
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to signal info handle: %d to abort.",
+				 function,
+				 handle_index );
+
+				return( -1 );
+			}
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the number of threads
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int info_batch_set_number_of_threads(
+     info_batch_t *info_batch,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function      = "info_batch_set_number_of_threads";
+	size_t string_length       = 0;
+	uint64_t number_of_threads = 0;
+	int result                 = 0;
+
+	if( info_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string[ 0 ] != (system_character_t) '-' )
+	{
+		string_length = system_string_length(
+		                 string );
+
+		if( ewftools_system_string_decimal_copy_to_64_bit(
+		     string,
+		     string_length + 1,
+		     &number_of_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine number of threads.",
+			 function );
+
+			return( -1 );
+		}
+		result = 1;
+
+		if( number_of_threads > 32 )
+		{
+			result = 0;
+		}
+		else
+		{
+			info_batch->number_of_threads = (int) number_of_threads;
+		}
+	}
+	return( result );
+}
+
+/* Sets the maximum number of (concurrent) open file handles
+ * The maximum is divided over the info handles in the pool
+ * Returns 1 if successful or -1 on error
+ */
+int info_batch_set_maximum_number_of_open_handles(
+     info_batch_t *info_batch,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error )
+{
+	static char *function = "info_batch_set_maximum_number_of_open_handles";
+
+	if( info_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_open_handles < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid maximum number of open handles value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	info_batch->maximum_number_of_open_handles = maximum_number_of_open_handles;
+
+	return( 1 );
+}
+
+/* Processes an entry, the information of the image is printed to the output stream of the entry
+ * Returns 1 if successful or -1 on error
+ */
+int info_batch_process_entry(
+     info_batch_t *info_batch,
+     info_batch_entry_t *entry,
+     info_handle_t *info_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "info_batch_process_entry";
+	int is_open           = 0;
+
+	if( info_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry->output_stream != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid entry - output stream value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	entry->output_stream = tmpfile();
+
+	if( entry->output_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to create temporary output stream.",
+		 function );
+
+		goto on_error;
+	}
+	info_handle->notify_stream = entry->output_stream;
+
+	if( info_batch->output_format == INFO_HANDLE_OUTPUT_FORMAT_DFXML )
+	{
+		fprintf(
+		 info_handle->notify_stream,
+		 "\t<ewfinfo>\n" );
+	}
+	else if( info_batch->output_format == INFO_HANDLE_OUTPUT_FORMAT_TEXT )
+	{
+		fprintf(
+		 info_handle->notify_stream,
+		 "Image filename:\t%" PRIs_SYSTEM "\n\n",
+		 entry->filename );
+	}
+	if( info_handle_open_input(
+	     info_handle,
+	     &( entry->filename ),
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open image.",
+		 function );
+
+		goto on_error;
+	}
+	is_open = 1;
+
+	if( ( info_batch->info_option == 'a' )
+	 || ( info_batch->info_option == 'i' ) )
+	{
+		if( info_handle_header_values_fprint(
+		     info_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print header values.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ( info_batch->info_option == 'a' )
+	 || ( info_batch->info_option == 'm' ) )
+	{
+		if( info_handle_media_information_fprint(
+		     info_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print media information.",
+			 function );
+
+			goto on_error;
+		}
+		if( info_handle_hash_values_fprint(
+		     info_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print hash values.",
+			 function );
+
+			goto on_error;
+		}
+		if( info_handle_sessions_fprint(
+		     info_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print sessions.",
+			 function );
+
+			goto on_error;
+		}
+		if( info_handle_tracks_fprint(
+		     info_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print tracks.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ( info_batch->info_option == 'a' )
+	 || ( info_batch->info_option == 'e' ) )
+	{
+		if( info_handle_acquiry_errors_fprint(
+		     info_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print acquiry errors.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( info_batch->info_option == 'c' )
+	{
+		if( info_handle_chunk_map_fprint(
+		     info_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print chunk map.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( info_handle_single_files_fprint(
+	     info_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print single files.",
+		 function );
+
+		goto on_error;
+	}
+	if( info_batch->output_format == INFO_HANDLE_OUTPUT_FORMAT_DFXML )
+	{
+		fprintf(
+		 info_handle->notify_stream,
+		 "\t</ewfinfo>\n" );
+	}
+	is_open = 0;
+
+	if( info_handle_close(
+	     info_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close image.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( is_open != 0 )
+	{
+		info_handle_close(
+		 info_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Processes an entry using an info handle of the pool
+ * Callback function for the thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int info_batch_process_entry_callback(
+     info_batch_entry_t *entry,
+     info_batch_t *info_batch )
+{
+	info_handle_t *info_handle = NULL;
+	static char *function      = "info_batch_process_entry_callback";
+	int result                 = -1;
+
+	if( entry == NULL )
+	{
+		return( -1 );
+	}
+	if( info_batch == NULL )
+	{
+		libcerror_error_set(
+		 &( entry->error ),
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info batch.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_grab(
+	 info_batch->mutex,
+	 NULL );
+#endif
+	/* There are as many info handles in the pool as threads processing entries
+	 */
+	if( info_batch->number_of_available_info_handles > 0 )
+	{
+		info_batch->number_of_available_info_handles -= 1;
+
+		info_handle = info_batch->info_handles[ info_batch->number_of_available_info_handles ];
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 info_batch->mutex,
+	 NULL );
+#endif
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 &( entry->error ),
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing available info handle.",
+		 function );
+	}
+	else if( info_batch->abort != 0 )
+	{
+		libcerror_error_set(
+		 &( entry->error ),
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_ABORT_REQUESTED,
+		 "%s: abort requested.",
+		 function );
+	}
+	else
+	{
+		result = info_batch_process_entry(
+		          info_batch,
+		          entry,
+		          info_handle,
+		          &( entry->error ) );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_grab(
+	 info_batch->mutex,
+	 NULL );
+#endif
+	if( info_handle != NULL )
+	{
+		info_batch->info_handles[ info_batch->number_of_available_info_handles ] = info_handle;
+
+		info_batch->number_of_available_info_handles += 1;
+	}
+	entry->result       = result;
+	entry->is_processed = 1;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	libcthreads_condition_broadcast(
+	 info_batch->condition,
+	 NULL );
+	libcthreads_mutex_release(
+	 info_batch->mutex,
+	 NULL );
+#endif
+	return( result );
+}
+
+/* Waits for an entry to be processed and copies its output to the notification output stream
+ * Returns 1 if successful, 0 if the entry could not be processed or -1 on error
+ */
+int info_batch_print_entry(
+     info_batch_t *info_batch,
+     info_batch_entry_t *entry,
+     libcerror_error_t **error )
+{
+	uint8_t *buffer       = NULL;
+	static char *function = "info_batch_print_entry";
+	size_t read_count     = 0;
+	int result            = 0;
+
+	if( info_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     info_batch->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( entry->is_processed == 0 )
+	{
+		if( libcthreads_condition_wait(
+		     info_batch->condition,
+		     info_batch->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 info_batch->mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	if( libcthreads_mutex_release(
+	     info_batch->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( entry->is_processed == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid entry - not processed.",
+		 function );
+
+		return( -1 );
+	}
+	/* The output of an image that could not be processed is discarded
+	 * to keep the combined output well-formed
+	 */
+	if( entry->result != 1 )
+	{
+		if( info_batch->abort == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to print information of: %" PRIs_SYSTEM ".\n",
+			 entry->filename );
+
+			if( entry->error != NULL )
+			{
+				libcnotify_print_error_backtrace(
+				 entry->error );
+			}
+		}
+		info_batch->number_of_failed_entries += 1;
+	}
+	else
+	{
+		if( file_stream_seek_offset(
+		     entry->output_stream,
+		     0,
+		     SEEK_SET ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek start of output stream.",
+			 function );
+
+			goto on_error;
+		}
+		buffer = (uint8_t *) memory_allocate(
+		                      sizeof( uint8_t ) * INFO_BATCH_COPY_BUFFER_SIZE );
+
+		if( buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffer.",
+			 function );
+
+			goto on_error;
+		}
+		do
+		{
+			read_count = file_stream_read(
+			              entry->output_stream,
+			              buffer,
+			              INFO_BATCH_COPY_BUFFER_SIZE );
+
+			if( read_count > 0 )
+			{
+				if( file_stream_write(
+				     info_batch->notify_stream,
+				     buffer,
+				     read_count ) != read_count )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write output.",
+					 function );
+
+					goto on_error;
+				}
+			}
+		}
+		while( read_count == INFO_BATCH_COPY_BUFFER_SIZE );
+
+		memory_free(
+		 buffer );
+
+		buffer = NULL;
+		result = 1;
+	}
+	if( entry->output_stream != NULL )
+	{
+		file_stream_close(
+		 entry->output_stream );
+
+		entry->output_stream = NULL;
+	}
+	if( entry->error != NULL )
+	{
+		libcerror_error_free(
+		 &( entry->error ) );
+	}
+	return( result );
+
+on_error:
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( -1 );
+}
+
+/* Processes the images and prints their information in the order of the filenames
+ * Every filename is the first segment file of a separate image
+ * Returns 1 if successful, 0 if one or more images could not be processed or -1 on error
+ */
+int info_batch_process(
+     info_batch_t *info_batch,
+     system_character_t * const *filenames,
+     int number_of_filenames,
+     libcerror_error_t **error )
+{
+	info_handle_t *info_handle         = NULL;
+	static char *function              = "info_batch_process";
+	int entry_index                    = 0;
+	int handle_index                   = 0;
+	int maximum_number_of_open_handles = 0;
+	int maximum_number_of_pending      = 1;
+	int print_index                    = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	libcthreads_thread_pool_t *thread_pool = NULL;
+#endif
+
+	if( info_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( info_batch->entries != NULL )
+	 || ( info_batch->info_handles != NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid info batch - already processed.",
+		 function );
+
+		return( -1 );
+	}
+	if( filenames == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filenames.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_filenames <= 0 )
+	 || ( (size_t) number_of_filenames > ( (size_t) SSIZE_MAX / sizeof( info_batch_entry_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of filenames value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	info_batch->entries = (info_batch_entry_t *) memory_allocate(
+	                                              sizeof( info_batch_entry_t ) * number_of_filenames );
+
+	if( info_batch->entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     info_batch->entries,
+	     0,
+	     sizeof( info_batch_entry_t ) * number_of_filenames ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entries.",
+		 function );
+
+		memory_free(
+		 info_batch->entries );
+
+		info_batch->entries = NULL;
+
+		return( -1 );
+	}
+	info_batch->number_of_entries        = number_of_filenames;
+	info_batch->number_of_failed_entries = 0;
+
+	for( entry_index = 0;
+	     entry_index < number_of_filenames;
+	     entry_index++ )
+	{
+		info_batch->entries[ entry_index ].info_batch = info_batch;
+		info_batch->entries[ entry_index ].filename   = filenames[ entry_index ];
+	}
+	/* The pool contains an info handle for every thread that processes entries
+	 */
+	info_batch->number_of_info_handles = 1;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( info_batch->number_of_threads > 1 )
+	{
+		info_batch->number_of_info_handles = info_batch->number_of_threads;
+	}
+#endif
+	if( info_batch->number_of_info_handles > number_of_filenames )
+	{
+		info_batch->number_of_info_handles = number_of_filenames;
+	}
+	info_batch->info_handles = (info_handle_t **) memory_allocate(
+	                                               sizeof( info_handle_t * ) * info_batch->number_of_info_handles );
+
+	if( info_batch->info_handles == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create info handles.",
+		 function );
+
+		info_batch->number_of_info_handles = 0;
+
+		goto on_error;
+	}
+	if( memory_set(
+	     info_batch->info_handles,
+	     0,
+	     sizeof( info_handle_t * ) * info_batch->number_of_info_handles ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear info handles.",
+		 function );
+
+		goto on_error;
+	}
+	maximum_number_of_open_handles = info_batch->maximum_number_of_open_handles
+	                               / info_batch->number_of_info_handles;
+
+	for( handle_index = 0;
+	     handle_index < info_batch->number_of_info_handles;
+	     handle_index++ )
+	{
+		if( info_handle_initialize(
+		     &info_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create info handle: %d.",
+			 function,
+			 handle_index );
+
+			goto on_error;
+		}
+		info_batch->info_handles[ handle_index ] = info_handle;
+
+		info_handle->output_format   = info_batch->output_format;
+		info_handle->date_format     = info_batch->date_format;
+		info_handle->header_codepage = info_batch->header_codepage;
+
+		info_handle = NULL;
+
+		if( maximum_number_of_open_handles > 0 )
+		{
+			if( info_handle_set_maximum_number_of_open_handles(
+			     info_batch->info_handles[ handle_index ],
+			     maximum_number_of_open_handles,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set maximum number of open handles in info handle: %d.",
+				 function,
+				 handle_index );
+
+				goto on_error;
+			}
+		}
+	}
+	info_batch->number_of_available_info_handles = info_batch->number_of_info_handles;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( info_batch->number_of_info_handles > 1 )
+	{
+		/* Bound the number of entries whose output is buffered but not yet printed
+		 */
+		maximum_number_of_pending = 4 * info_batch->number_of_info_handles;
+
+		if( libcthreads_thread_pool_create(
+		     &thread_pool,
+		     NULL,
+		     info_batch->number_of_info_handles,
+		     maximum_number_of_pending,
+		     (int (*)(intptr_t *, void *)) &info_batch_process_entry_callback,
+		     (void *) info_batch,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	for( entry_index = 0;
+	     entry_index < number_of_filenames;
+	     entry_index++ )
+	{
+		if( info_batch->abort != 0 )
+		{
+			break;
+		}
+		while( ( entry_index - print_index ) >= maximum_number_of_pending )
+		{
+			if( info_batch_print_entry(
+			     info_batch,
+			     &( info_batch->entries[ print_index ] ),
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print entry: %d.",
+				 function,
+				 print_index );
+
+				goto on_error;
+			}
+			print_index++;
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_push(
+			     thread_pool,
+			     (intptr_t *) &( info_batch->entries[ entry_index ] ),
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push entry: %d onto thread pool queue.",
+				 function,
+				 entry_index );
+
+				goto on_error;
+			}
+		}
+		else
+#endif
+		{
+			info_batch_process_entry_callback(
+			 &( info_batch->entries[ entry_index ] ),
+			 info_batch );
+		}
+	}
+	/* Entries that were not pushed are never processed
+	 */
+	number_of_filenames = entry_index;
+
+	while( print_index < number_of_filenames )
+	{
+		if( info_batch_print_entry(
+		     info_batch,
+		     &( info_batch->entries[ print_index ] ),
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print entry: %d.",
+			 function,
+			 print_index );
+
+			goto on_error;
+		}
+		print_index++;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &thread_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	if( info_batch->number_of_failed_entries > 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( thread_pool != NULL )
+	{
+		/* Make sure no entry is processed after the entries are freed
+		 */
+		info_batch->abort = 1;
+
+		libcthreads_thread_pool_join(
+		 &thread_pool,
+		 NULL );
+	}
+#endif
+	return( -1 );
+}
+
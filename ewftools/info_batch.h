@@ -0,0 +1,198 @@
+/*
+ * Info batch
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _INFO_BATCH_H )
+#define _INFO_BATCH_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "info_handle.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The size of the buffer used to copy the output of an image
+ */
+#define INFO_BATCH_COPY_BUFFER_SIZE	( 64 * 1024 )
+
+typedef struct info_batch info_batch_t;
+
+typedef struct info_batch_entry info_batch_entry_t;
+
+/* The info batch entry contains the state of a single image
+ */
+struct info_batch_entry
+{
+	/* The info batch
+	 */
+	info_batch_t *info_batch;
+
+	/* The filename of the (first segment file of the) image
+	 */
+	system_character_t *filename;
+
+	/* The output stream, which is a temporary file
+	 */
+	FILE *output_stream;
+
+	/* The result
+	 */
+	int result;
+
+	/* The error
+	 */
+	libcerror_error_t *error;
+
+	/* Value to indicate the entry was processed
+	 */
+	uint8_t is_processed;
+};
+
+/* The info batch prints the information of multiple images into a single
+ * output stream. The images are processed concurrently using a bounded pool
+ * of info handles, where the output of every image is buffered in a temporary
+ * file and copied to the output stream in the order of the images
+ */
+struct info_batch
+{
+	/* The output format
+	 */
+	uint8_t output_format;
+
+	/* The date format
+	 */
+	uint8_t date_format;
+
+	/* The header codepage
+	 */
+	int header_codepage;
+
+	/* The information to print, where 'a' represents all
+	 */
+	char info_option;
+
+	/* The maximum number of (concurrent) open file handles
+	 */
+	int maximum_number_of_open_handles;
+
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+	/* The pool of info handles
+	 */
+	info_handle_t **info_handles;
+
+	/* The number of info handles
+	 */
+	int number_of_info_handles;
+
+	/* The number of info handles that are not in use
+	 */
+	int number_of_available_info_handles;
+
+	/* The entries
+	 */
+	info_batch_entry_t *entries;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The number of entries that could not be processed
+	 */
+	int number_of_failed_entries;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when an entry was processed
+	 */
+	libcthreads_condition_t *condition;
+#endif
+};
+
+int info_batch_initialize(
+     info_batch_t **info_batch,
+     info_handle_t *info_handle,
+     char info_option,
+     libcerror_error_t **error );
+
+int info_batch_free(
+     info_batch_t **info_batch,
+     libcerror_error_t **error );
+
+int info_batch_signal_abort(
+     info_batch_t *info_batch,
+     libcerror_error_t **error );
+
+int info_batch_set_number_of_threads(
+     info_batch_t *info_batch,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int info_batch_set_maximum_number_of_open_handles(
+     info_batch_t *info_batch,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error );
+
+int info_batch_process_entry(
+     info_batch_t *info_batch,
+     info_batch_entry_t *entry,
+     info_handle_t *info_handle,
+     libcerror_error_t **error );
+
+int info_batch_process_entry_callback(
+     info_batch_entry_t *entry,
+     info_batch_t *info_batch );
+
+int info_batch_print_entry(
+     info_batch_t *info_batch,
+     info_batch_entry_t *entry,
+     libcerror_error_t **error );
+
+int info_batch_process(
+     info_batch_t *info_batch,
+     system_character_t * const *filenames,
+     int number_of_filenames,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _INFO_BATCH_H ) */
+
@@ -44,6 +44,7 @@
 #define INFO_HANDLE_VALUE_SIZE			512
 #define INFO_HANDLE_VALUE_IDENTIFIER_SIZE	64
 #define INFO_HANDLE_NOTIFY_STREAM		stdout
+#define INFO_HANDLE_CHUNK_MAP_BATCH_SIZE	256
 
 #if !defined( USE_LIBEWF_GET_HASH_VALUE_MD5 ) && !defined( USE_LIBEWF_GET_MD5_HASH )
 #define USE_LIBEWF_GET_HASH_VALUE_MD5
@@ -207,6 +208,8 @@ int info_handle_signal_abort(
 
 		return( -1 );
 	}
+	info_handle->abort = 1;
+
 	if( info_handle->input_handle != NULL )
 	{
 		if( libewf_handle_signal_abort(
@@ -361,14 +364,14 @@ int info_handle_open_input(
 	     info_handle->input_handle,
 	     filenames,
 	     number_of_filenames,
-	     LIBEWF_OPEN_READ,
+	     LIBEWF_OPEN_READ_METADATA,
 	     error ) != 1 )
 #else
 	if( libewf_handle_open(
 	     info_handle->input_handle,
 	     filenames,
 	     number_of_filenames,
-	     LIBEWF_OPEN_READ,
+	     LIBEWF_OPEN_READ_METADATA,
 	     error ) != 1 )
 #endif
 	{
@@ -2462,6 +2465,10 @@ int info_handle_media_information_fprint(
 		{
 			value_string = _SYSTEM_STRING( "bzip2" );
 		}
+		else if( compression_method == LIBEWF_COMPRESSION_METHOD_ZSTD )
+		{
+			value_string = _SYSTEM_STRING( "zstd" );
+		}
 		if( info_handle_section_value_string_fprint(
 		     info_handle,
 		     "compression_method",
@@ -3847,6 +3854,696 @@ int info_handle_tracks_fprint(
 	return( result );
 }
 
+/* Prints the chunk map to a stream
+ * The chunk map is determined from the chunk tables, the chunk data is not decompressed
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_chunk_map_fprint(
+     info_handle_t *info_handle,
+     libcerror_error_t **error )
+{
+	uint32_t chunks_flags[ INFO_HANDLE_CHUNK_MAP_BATCH_SIZE ];
+	uint32_t chunks_stored_sizes[ INFO_HANDLE_CHUNK_MAP_BATCH_SIZE ];
+	uint64_t ratio_bins_number_of_chunks[ INFO_HANDLE_CHUNK_MAP_NUMBER_OF_RATIO_BINS ];
+	uint64_t ratio_bins_stored_size[ INFO_HANDLE_CHUNK_MAP_NUMBER_OF_RATIO_BINS ];
+	uint64_t types_number_of_chunks[ INFO_HANDLE_CHUNK_MAP_REGION_TYPE_MISSING + 1 ];
+
+	info_handle_chunk_map_region_t chunk_region;
+	info_handle_chunk_map_region_t region;
+
+	static char *function          = "info_handle_chunk_map_fprint";
+	size64_t chunk_data_size       = 0;
+	size64_t media_size            = 0;
+	size64_t stored_size           = 0;
+	uint64_t chunk_index           = 0;
+	uint64_t number_of_chunks      = 0;
+	uint32_t chunk_flags           = 0;
+	size32_t chunk_size            = 0;
+	uint8_t ratio_bin              = 0;
+	uint8_t region_type            = 0;
+	int batch_index                = 0;
+	int maximum_batch_size         = 0;
+	int number_of_batch_chunks     = 0;
+	int result                     = 1;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( info_handle->input_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid info handle - missing input handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_get_media_size(
+	     info_handle->input_handle,
+	     &media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_get_chunk_size(
+	     info_handle->input_handle,
+	     &chunk_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_chunks = media_size / chunk_size;
+
+	if( ( media_size % chunk_size ) != 0 )
+	{
+		number_of_chunks += 1;
+	}
+	if( memory_set(
+	     ratio_bins_number_of_chunks,
+	     0,
+	     sizeof( uint64_t ) * INFO_HANDLE_CHUNK_MAP_NUMBER_OF_RATIO_BINS ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear ratio bins number of chunks.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     ratio_bins_stored_size,
+	     0,
+	     sizeof( uint64_t ) * INFO_HANDLE_CHUNK_MAP_NUMBER_OF_RATIO_BINS ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear ratio bins stored size.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     types_number_of_chunks,
+	     0,
+	     sizeof( uint64_t ) * ( INFO_HANDLE_CHUNK_MAP_REGION_TYPE_MISSING + 1 ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear types number of chunks.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     &region,
+	     0,
+	     sizeof( info_handle_chunk_map_region_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear region.",
+		 function );
+
+		return( -1 );
+	}
+	if( info_handle_section_header_fprint(
+	     info_handle,
+	     "chunk_map",
+	     "Chunk map",
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print section header: chunk_map.",
+		 function );
+
+		return( -1 );
+	}
+	if( info_handle->output_format == INFO_HANDLE_OUTPUT_FORMAT_DFXML )
+	{
+		fprintf(
+		 info_handle->notify_stream,
+		 "\t\t\t<regions>\n" );
+	}
+	else if( info_handle->output_format == INFO_HANDLE_OUTPUT_FORMAT_TEXT )
+	{
+		fprintf(
+		 info_handle->notify_stream,
+		 "\tRegions:\n" );
+	}
+	while( chunk_index < number_of_chunks )
+	{
+		if( info_handle->abort != 0 )
+		{
+			break;
+		}
+		maximum_batch_size = INFO_HANDLE_CHUNK_MAP_BATCH_SIZE;
+
+		if( ( number_of_chunks - chunk_index ) < (uint64_t) maximum_batch_size )
+		{
+			maximum_batch_size = (int) ( number_of_chunks - chunk_index );
+		}
+		number_of_batch_chunks = libewf_handle_get_chunks_storage_values(
+		                          info_handle->input_handle,
+		                          chunk_index,
+		                          chunks_flags,
+		                          chunks_stored_sizes,
+		                          maximum_batch_size,
+		                          error );
+
+		if( number_of_batch_chunks == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve storage values of chunk: %" PRIu64 ".",
+			 function,
+			 chunk_index );
+
+			result = -1;
+
+			break;
+		}
+		else if( number_of_batch_chunks == 0 )
+		{
+			break;
+		}
+		for( batch_index = 0;
+		     batch_index < number_of_batch_chunks;
+		     batch_index++ )
+		{
+			chunk_flags     = chunks_flags[ batch_index ];
+			stored_size     = chunks_stored_sizes[ batch_index ];
+			chunk_data_size = chunk_size;
+
+			if( ( chunk_index * chunk_size ) + chunk_data_size > media_size )
+			{
+				chunk_data_size = media_size - ( chunk_index * chunk_size );
+			}
+			if( memory_set(
+			     &chunk_region,
+			     0,
+			     sizeof( info_handle_chunk_map_region_t ) ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear chunk region.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+			if( ( chunk_flags & LIBEWF_CHUNK_FLAG_IS_MISSING ) != 0 )
+			{
+				region_type = INFO_HANDLE_CHUNK_MAP_REGION_TYPE_MISSING;
+			}
+			else if( ( chunk_flags & LIBEWF_CHUNK_FLAG_IS_SPARSE ) != 0 )
+			{
+				region_type = INFO_HANDLE_CHUNK_MAP_REGION_TYPE_SPARSE;
+			}
+			else if( ( chunk_flags & LIBEWF_CHUNK_FLAG_USES_PATTERN_FILL ) != 0 )
+			{
+				/* Only the 8 bytes of the pattern are read
+				 */
+				if( libewf_handle_get_chunk_pattern_fill(
+				     info_handle->input_handle,
+				     chunk_index,
+				     &( chunk_region.pattern_fill ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve pattern fill of chunk: %" PRIu64 ".",
+					 function,
+					 chunk_index );
+
+					result = -1;
+
+					break;
+				}
+				if( chunk_region.pattern_fill == 0 )
+				{
+					region_type = INFO_HANDLE_CHUNK_MAP_REGION_TYPE_ZERO_FILL;
+				}
+				else
+				{
+					region_type = INFO_HANDLE_CHUNK_MAP_REGION_TYPE_PATTERN_FILL;
+				}
+			}
+			else if( ( chunk_flags & LIBEWF_CHUNK_FLAG_IS_COMPRESSED ) != 0 )
+			{
+				region_type = INFO_HANDLE_CHUNK_MAP_REGION_TYPE_COMPRESSED;
+			}
+			else
+			{
+				region_type = INFO_HANDLE_CHUNK_MAP_REGION_TYPE_UNCOMPRESSED;
+			}
+			types_number_of_chunks[ region_type ] += 1;
+
+			ratio_bin = 0;
+
+			if( region_type != INFO_HANDLE_CHUNK_MAP_REGION_TYPE_MISSING )
+			{
+				if( stored_size > chunk_data_size )
+				{
+					ratio_bin = INFO_HANDLE_CHUNK_MAP_NUMBER_OF_RATIO_BINS - 1;
+				}
+				else
+				{
+					ratio_bin = (uint8_t) ( ( stored_size * 10 ) / chunk_data_size );
+
+					if( ratio_bin > 9 )
+					{
+						ratio_bin = 9;
+					}
+				}
+				ratio_bins_number_of_chunks[ ratio_bin ] += 1;
+				ratio_bins_stored_size[ ratio_bin ]      += stored_size;
+			}
+			chunk_region.offset      = (off64_t) ( chunk_index * chunk_size );
+			chunk_region.size        = chunk_data_size;
+			chunk_region.stored_size = stored_size;
+			chunk_region.type        = region_type;
+
+			/* Only compressed regions are split by compression ratio
+			 */
+			if( region_type == INFO_HANDLE_CHUNK_MAP_REGION_TYPE_COMPRESSED )
+			{
+				chunk_region.ratio_bin = ratio_bin;
+			}
+			if( ( region.size != 0 )
+			 && ( region.type == chunk_region.type )
+			 && ( region.ratio_bin == chunk_region.ratio_bin )
+			 && ( region.pattern_fill == chunk_region.pattern_fill ) )
+			{
+				region.size        += chunk_region.size;
+				region.stored_size += chunk_region.stored_size;
+			}
+			else
+			{
+				if( region.size != 0 )
+				{
+					if( info_handle_chunk_map_region_fprint(
+					     info_handle,
+					     &region,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+						 "%s: unable to print region.",
+						 function );
+
+						result = -1;
+
+						break;
+					}
+				}
+				region = chunk_region;
+			}
+			chunk_index += 1;
+		}
+		if( result == -1 )
+		{
+			break;
+		}
+	}
+	if( ( result == 1 )
+	 && ( region.size != 0 ) )
+	{
+		if( info_handle_chunk_map_region_fprint(
+		     info_handle,
+		     &region,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print region.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( info_handle->output_format == INFO_HANDLE_OUTPUT_FORMAT_DFXML )
+	{
+		fprintf(
+		 info_handle->notify_stream,
+		 "\t\t\t</regions>\n" );
+	}
+	else if( info_handle->output_format == INFO_HANDLE_OUTPUT_FORMAT_TEXT )
+	{
+		fprintf(
+		 info_handle->notify_stream,
+		 "\n" );
+	}
+	stored_size = 0;
+
+	for( ratio_bin = 0;
+	     ratio_bin < INFO_HANDLE_CHUNK_MAP_NUMBER_OF_RATIO_BINS;
+	     ratio_bin++ )
+	{
+		stored_size += ratio_bins_stored_size[ ratio_bin ];
+	}
+	if( info_handle_section_value_32bit_fprint(
+	     info_handle,
+	     "chunk_size",
+	     "Chunk size",
+	     10,
+	     chunk_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print 32-bit value: chunk_size.",
+		 function );
+
+		result = -1;
+	}
+	if( info_handle_section_value_64bit_fprint(
+	     info_handle,
+	     "number_of_chunks",
+	     "Number of chunks",
+	     16,
+	     chunk_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print 64-bit value: number_of_chunks.",
+		 function );
+
+		result = -1;
+	}
+	if( info_handle_section_value_size_fprint(
+	     info_handle,
+	     "stored_size",
+	     "Stored size",
+	     11,
+	     stored_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print size value: stored_size.",
+		 function );
+
+		result = -1;
+	}
+	if( info_handle->output_format == INFO_HANDLE_OUTPUT_FORMAT_DFXML )
+	{
+		fprintf(
+		 info_handle->notify_stream,
+		 "\t\t\t<compressed_chunks>%" PRIu64 "</compressed_chunks>\n"
+		 "\t\t\t<uncompressed_chunks>%" PRIu64 "</uncompressed_chunks>\n"
+		 "\t\t\t<zero_fill_chunks>%" PRIu64 "</zero_fill_chunks>\n"
+		 "\t\t\t<pattern_fill_chunks>%" PRIu64 "</pattern_fill_chunks>\n"
+		 "\t\t\t<sparse_chunks>%" PRIu64 "</sparse_chunks>\n"
+		 "\t\t\t<missing_chunks>%" PRIu64 "</missing_chunks>\n"
+		 "\t\t\t<compression_ratio_histogram>\n",
+		 types_number_of_chunks[ INFO_HANDLE_CHUNK_MAP_REGION_TYPE_COMPRESSED ],
+		 types_number_of_chunks[ INFO_HANDLE_CHUNK_MAP_REGION_TYPE_UNCOMPRESSED ],
+		 types_number_of_chunks[ INFO_HANDLE_CHUNK_MAP_REGION_TYPE_ZERO_FILL ],
+		 types_number_of_chunks[ INFO_HANDLE_CHUNK_MAP_REGION_TYPE_PATTERN_FILL ],
+		 types_number_of_chunks[ INFO_HANDLE_CHUNK_MAP_REGION_TYPE_SPARSE ],
+		 types_number_of_chunks[ INFO_HANDLE_CHUNK_MAP_REGION_TYPE_MISSING ] );
+	}
+	else if( info_handle->output_format == INFO_HANDLE_OUTPUT_FORMAT_TEXT )
+	{
+		fprintf(
+		 info_handle->notify_stream,
+		 "\tCompressed chunks:\t%" PRIu64 "\n"
+		 "\tUncompressed chunks:\t%" PRIu64 "\n"
+		 "\tZero fill chunks:\t%" PRIu64 "\n"
+		 "\tPattern fill chunks:\t%" PRIu64 "\n"
+		 "\tSparse chunks:\t\t%" PRIu64 "\n"
+		 "\tMissing chunks:\t\t%" PRIu64 "\n"
+		 "\n"
+		 "\tCompression ratio histogram:\n",
+		 types_number_of_chunks[ INFO_HANDLE_CHUNK_MAP_REGION_TYPE_COMPRESSED ],
+		 types_number_of_chunks[ INFO_HANDLE_CHUNK_MAP_REGION_TYPE_UNCOMPRESSED ],
+		 types_number_of_chunks[ INFO_HANDLE_CHUNK_MAP_REGION_TYPE_ZERO_FILL ],
+		 types_number_of_chunks[ INFO_HANDLE_CHUNK_MAP_REGION_TYPE_PATTERN_FILL ],
+		 types_number_of_chunks[ INFO_HANDLE_CHUNK_MAP_REGION_TYPE_SPARSE ],
+		 types_number_of_chunks[ INFO_HANDLE_CHUNK_MAP_REGION_TYPE_MISSING ] );
+	}
+	for( ratio_bin = 0;
+	     ratio_bin < INFO_HANDLE_CHUNK_MAP_NUMBER_OF_RATIO_BINS;
+	     ratio_bin++ )
+	{
+		if( info_handle->output_format == INFO_HANDLE_OUTPUT_FORMAT_DFXML )
+		{
+			if( ratio_bin == ( INFO_HANDLE_CHUNK_MAP_NUMBER_OF_RATIO_BINS - 1 ) )
+			{
+				fprintf(
+				 info_handle->notify_stream,
+				 "\t\t\t\t<bin minimum_ratio=\"100\" chunks=\"%" PRIu64 "\" stored_size=\"%" PRIu64 "\"/>\n",
+				 ratio_bins_number_of_chunks[ ratio_bin ],
+				 ratio_bins_stored_size[ ratio_bin ] );
+			}
+			else
+			{
+				fprintf(
+				 info_handle->notify_stream,
+				 "\t\t\t\t<bin minimum_ratio=\"%d\" maximum_ratio=\"%d\" chunks=\"%" PRIu64 "\" stored_size=\"%" PRIu64 "\"/>\n",
+				 ratio_bin * 10,
+				 ( ratio_bin + 1 ) * 10,
+				 ratio_bins_number_of_chunks[ ratio_bin ],
+				 ratio_bins_stored_size[ ratio_bin ] );
+			}
+		}
+		else if( info_handle->output_format == INFO_HANDLE_OUTPUT_FORMAT_TEXT )
+		{
+			if( ratio_bin == ( INFO_HANDLE_CHUNK_MAP_NUMBER_OF_RATIO_BINS - 1 ) )
+			{
+				fprintf(
+				 info_handle->notify_stream,
+				 "\t\t     > 100%%:\t%" PRIu64 " chunks (%" PRIu64 " bytes stored)\n",
+				 ratio_bins_number_of_chunks[ ratio_bin ],
+				 ratio_bins_stored_size[ ratio_bin ] );
+			}
+			else
+			{
+				fprintf(
+				 info_handle->notify_stream,
+				 "\t\t%3d%% - %3d%%:\t%" PRIu64 " chunks (%" PRIu64 " bytes stored)\n",
+				 ratio_bin * 10,
+				 ( ratio_bin + 1 ) * 10,
+				 ratio_bins_number_of_chunks[ ratio_bin ],
+				 ratio_bins_stored_size[ ratio_bin ] );
+			}
+		}
+	}
+	if( info_handle->output_format == INFO_HANDLE_OUTPUT_FORMAT_DFXML )
+	{
+		fprintf(
+		 info_handle->notify_stream,
+		 "\t\t\t</compression_ratio_histogram>\n" );
+	}
+	if( info_handle_section_footer_fprint(
+	     info_handle,
+	     "chunk_map",
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print section footer: chunk_map.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Prints a chunk map region to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_chunk_map_region_fprint(
+     info_handle_t *info_handle,
+     info_handle_chunk_map_region_t *region,
+     libcerror_error_t **error )
+{
+	const char *type_string = NULL;
+	static char *function   = "info_handle_chunk_map_region_fprint";
+	uint64_t ratio          = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( region == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid region.",
+		 function );
+
+		return( -1 );
+	}
+	switch( region->type )
+	{
+		case INFO_HANDLE_CHUNK_MAP_REGION_TYPE_COMPRESSED:
+			type_string = "compressed";
+			break;
+
+		case INFO_HANDLE_CHUNK_MAP_REGION_TYPE_UNCOMPRESSED:
+			type_string = "uncompressed";
+			break;
+
+		case INFO_HANDLE_CHUNK_MAP_REGION_TYPE_ZERO_FILL:
+			type_string = "zero_fill";
+			break;
+
+		case INFO_HANDLE_CHUNK_MAP_REGION_TYPE_PATTERN_FILL:
+			type_string = "pattern_fill";
+			break;
+
+		case INFO_HANDLE_CHUNK_MAP_REGION_TYPE_SPARSE:
+			type_string = "sparse";
+			break;
+
+		case INFO_HANDLE_CHUNK_MAP_REGION_TYPE_MISSING:
+			type_string = "missing";
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported region type.",
+			 function );
+
+			return( -1 );
+	}
+	if( region->size != 0 )
+	{
+		ratio = ( region->stored_size * 100 ) / region->size;
+	}
+	if( info_handle->output_format == INFO_HANDLE_OUTPUT_FORMAT_DFXML )
+	{
+		fprintf(
+		 info_handle->notify_stream,
+		 "\t\t\t\t<run image_offset=\"%" PRIi64 "\" len=\"%" PRIu64 "\" type=\"%s\" stored_size=\"%" PRIu64 "\" ratio=\"%" PRIu64 "\"",
+		 region->offset,
+		 region->size,
+		 type_string,
+		 region->stored_size,
+		 ratio );
+
+		if( region->type == INFO_HANDLE_CHUNK_MAP_REGION_TYPE_PATTERN_FILL )
+		{
+			fprintf(
+			 info_handle->notify_stream,
+			 " pattern=\"0x%016" PRIx64 "\"",
+			 region->pattern_fill );
+		}
+		fprintf(
+		 info_handle->notify_stream,
+		 "/>\n" );
+	}
+	else if( info_handle->output_format == INFO_HANDLE_OUTPUT_FORMAT_TEXT )
+	{
+		fprintf(
+		 info_handle->notify_stream,
+		 "\t\tat offset: %" PRIi64 " - %" PRIi64 " size: %" PRIu64 " %s",
+		 region->offset,
+		 region->offset + (off64_t) region->size - 1,
+		 region->size,
+		 type_string );
+
+		if( region->type == INFO_HANDLE_CHUNK_MAP_REGION_TYPE_PATTERN_FILL )
+		{
+			fprintf(
+			 info_handle->notify_stream,
+			 " pattern: 0x%016" PRIx64 "",
+			 region->pattern_fill );
+		}
+		if( region->type != INFO_HANDLE_CHUNK_MAP_REGION_TYPE_MISSING )
+		{
+			fprintf(
+			 info_handle->notify_stream,
+			 " stored: %" PRIu64 " bytes (%" PRIu64 "%%)",
+			 region->stored_size,
+			 ratio );
+		}
+		fprintf(
+		 info_handle->notify_stream,
+		 "\n" );
+	}
+	return( 1 );
+}
+
 /* Prints the single files to a stream
  * Returns 1 if successful or -1 on error
  */
@@ -4203,6 +4900,35 @@ int info_handle_dfxml_header_fprint(
 {
 	static char *function = "info_handle_dfxml_header_fprint";
 
+	if( info_handle_dfxml_objects_header_fprint(
+	     info_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print objects header.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "\t<ewfinfo>\n" );
+
+	return( 1 );
+}
+
+/* Prints the DFXML objects header, without the ewfinfo element, to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_dfxml_objects_header_fprint(
+     info_handle_t *info_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "info_handle_dfxml_objects_header_fprint";
+
 	if( info_handle == NULL )
 	{
 		libcerror_error_set(
@@ -4267,8 +4993,7 @@ int info_handle_dfxml_header_fprint(
 	}
 	fprintf(
 	 info_handle->notify_stream,
-	 "\t</creator>\n"
-	 "\t<ewfinfo>\n" );
+	 "\t</creator>\n" );
 
 	return( 1 );
 }
@@ -4295,7 +5020,46 @@ int info_handle_dfxml_footer_fprint(
 	}
 	fprintf(
 	 info_handle->notify_stream,
-	 "\t</ewfinfo>\n"
+	 "\t</ewfinfo>\n" );
+
+	if( info_handle_dfxml_objects_footer_fprint(
+	     info_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print objects footer.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Prints the DFXML objects footer to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_dfxml_objects_footer_fprint(
+     info_handle_t *info_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "info_handle_dfxml_objects_footer_fprint";
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 info_handle->notify_stream,
 	 "</ewfobjects>\n"
 	 "\n" );
 
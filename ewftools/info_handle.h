@@ -39,6 +39,50 @@ enum INFO_HANDLE_OUTPUT_FORMAT_TYPES
 	INFO_HANDLE_OUTPUT_FORMAT_DFXML		= (uint8_t) 'x'
 };
 
+enum INFO_HANDLE_CHUNK_MAP_REGION_TYPES
+{
+	INFO_HANDLE_CHUNK_MAP_REGION_TYPE_COMPRESSED	= 1,
+	INFO_HANDLE_CHUNK_MAP_REGION_TYPE_UNCOMPRESSED	= 2,
+	INFO_HANDLE_CHUNK_MAP_REGION_TYPE_ZERO_FILL	= 3,
+	INFO_HANDLE_CHUNK_MAP_REGION_TYPE_PATTERN_FILL	= 4,
+	INFO_HANDLE_CHUNK_MAP_REGION_TYPE_SPARSE	= 5,
+	INFO_HANDLE_CHUNK_MAP_REGION_TYPE_MISSING	= 6
+};
+
+/* The number of compression ratio bins of the chunk map histogram,
+ * one per 10 percent and one for chunks stored larger than their data
+ */
+#define INFO_HANDLE_CHUNK_MAP_NUMBER_OF_RATIO_BINS	11
+
+typedef struct info_handle_chunk_map_region info_handle_chunk_map_region_t;
+
+struct info_handle_chunk_map_region
+{
+	/* The (media) offset
+	 */
+	off64_t offset;
+
+	/* The (media) size
+	 */
+	size64_t size;
+
+	/* The stored size
+	 */
+	size64_t stored_size;
+
+	/* The region type
+	 */
+	uint8_t type;
+
+	/* The compression ratio bin
+	 */
+	uint8_t ratio_bin;
+
+	/* The 64-bit pattern of a pattern fill region
+	 */
+	uint64_t pattern_fill;
+};
+
 typedef struct info_handle info_handle_t;
 
 struct info_handle
@@ -62,6 +106,10 @@ struct info_handle
 	/* The notification output stream
 	 */
 	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
 };
 
 int info_handle_initialize(
@@ -208,6 +256,15 @@ int info_handle_tracks_fprint(
      info_handle_t *info_handle,
      libcerror_error_t **error );
 
+int info_handle_chunk_map_fprint(
+     info_handle_t *info_handle,
+     libcerror_error_t **error );
+
+int info_handle_chunk_map_region_fprint(
+     info_handle_t *info_handle,
+     info_handle_chunk_map_region_t *region,
+     libcerror_error_t **error );
+
 int info_handle_single_files_fprint(
      info_handle_t *info_handle,
      libcerror_error_t **error );
@@ -222,10 +279,18 @@ int info_handle_dfxml_header_fprint(
      info_handle_t *info_handle,
      libcerror_error_t **error );
 
+int info_handle_dfxml_objects_header_fprint(
+     info_handle_t *info_handle,
+     libcerror_error_t **error );
+
 int info_handle_dfxml_footer_fprint(
      info_handle_t *info_handle,
      libcerror_error_t **error );
 
+int info_handle_dfxml_objects_footer_fprint(
+     info_handle_t *info_handle,
+     libcerror_error_t **error );
+
 int dfxml_build_environment_fprint(
      FILE *stream,
      libcerror_error_t **error );
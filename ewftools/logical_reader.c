@@ -0,0 +1,3759 @@
+/*
+ * Logical reader functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_ERRNO_H ) || defined( WINAPI )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H ) || defined( WINAPI )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_DIRENT_H ) && !defined( WINAPI )
+#include <dirent.h>
+#endif
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "imaging_handle.h"
+#include "logical_reader.h"
+#include "md5_context.h"
+#include "storage_media_buffer.h"
+#include "storage_media_buffer_queue.h"
+
+#if !defined( O_NOFOLLOW )
+#define O_NOFOLLOW	0
+#endif
+
+/* The size of the blocks in which the ltree spool is appended to the output
+ */
+#define LOGICAL_READER_SPOOL_BLOCK_SIZE	( 64 * 1024 )
+
+/* Creates a logical reader
+ * Make sure the value logical_reader is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int logical_reader_initialize(
+     logical_reader_t **logical_reader,
+     const system_character_t *source_path,
+     uint8_t ewf_format,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LOGICAL_READER_SUPPORT ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	struct stat file_stat;
+#endif
+
+	static char *function     = "logical_reader_initialize";
+	size_t source_path_length = 0;
+
+	if( logical_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid logical reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( *logical_reader != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid logical reader value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source path.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ewf_format != LIBEWF_FORMAT_LOGICAL_ENCASE5 )
+	 && ( ewf_format != LIBEWF_FORMAT_LOGICAL_ENCASE6 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported EWF format.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_LOGICAL_READER_SUPPORT ) || defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: logical acquisition not supported.",
+	 function );
+
+	return( -1 );
+#else
+	source_path_length = narrow_string_length(
+	                      source_path );
+
+	/* Remove trailing path separators except for the root directory
+	 */
+	while( ( source_path_length > 1 )
+	    && ( source_path[ source_path_length - 1 ] == '/' ) )
+	{
+		source_path_length--;
+	}
+	if( source_path_length == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid source path length value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	*logical_reader = memory_allocate_structure(
+	                   logical_reader_t );
+
+	if( *logical_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create logical reader.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *logical_reader,
+	     0,
+	     sizeof( logical_reader_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear logical reader.",
+		 function );
+
+		memory_free(
+		 *logical_reader );
+
+		*logical_reader = NULL;
+
+		return( -1 );
+	}
+	( *logical_reader )->source_path = narrow_string_allocate(
+	                                    source_path_length + 1 );
+
+	if( ( *logical_reader )->source_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create source path.",
+		 function );
+
+		goto on_error;
+	}
+	if( narrow_string_copy(
+	     ( *logical_reader )->source_path,
+	     source_path,
+	     source_path_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy source path.",
+		 function );
+
+		goto on_error;
+	}
+	( *logical_reader )->source_path[ source_path_length ] = 0;
+
+	if( stat(
+	     ( *logical_reader )->source_path,
+	     &file_stat ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to retrieve source path information.",
+		 function );
+
+		goto on_error;
+	}
+	if( !S_ISDIR( file_stat.st_mode ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported source path - not a directory.",
+		 function );
+
+		goto on_error;
+	}
+	/* The ltree records are spooled to an anonymous temporary file
+	 * since the ltree can only be written once the size of the data is known
+	 */
+	( *logical_reader )->ltree_spool = tmpfile();
+
+	if( ( *logical_reader )->ltree_spool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to create ltree spool.",
+		 function );
+
+		goto on_error;
+	}
+	( *logical_reader )->source_path_length = source_path_length;
+	( *logical_reader )->ewf_format         = ewf_format;
+	( *logical_reader )->next_identifier    = 1;
+
+	return( 1 );
+
+on_error:
+	if( *logical_reader != NULL )
+	{
+		if( ( *logical_reader )->source_path != NULL )
+		{
+			memory_free(
+			 ( *logical_reader )->source_path );
+		}
+		memory_free(
+		 *logical_reader );
+
+		*logical_reader = NULL;
+	}
+	return( -1 );
+#endif /* !defined( HAVE_LOGICAL_READER_SUPPORT ) || defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+}
+
+/* Frees a logical reader
+ * The reader threads are stopped if necessary
+ * Returns 1 if successful or -1 on error
+ */
+int logical_reader_free(
+     logical_reader_t **logical_reader,
+     libcerror_error_t **error )
+{
+	static char *function = "logical_reader_free";
+	int directory_index   = 0;
+	int entry_index       = 0;
+	int result            = 1;
+
+	if( logical_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid logical reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( *logical_reader != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *logical_reader )->threads != NULL )
+		{
+			if( logical_reader_stop(
+			     *logical_reader,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to stop logical reader.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		for( entry_index = 0;
+		     entry_index < LOGICAL_READER_MAXIMUM_NUMBER_OF_ENTRIES;
+		     entry_index++ )
+		{
+			if( ( *logical_reader )->entries[ entry_index ] != NULL )
+			{
+				if( logical_reader_entry_free(
+				     &( ( *logical_reader )->entries[ entry_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free entry: %d.",
+					 function,
+					 entry_index );
+
+					result = -1;
+				}
+			}
+		}
+		if( ( *logical_reader )->directories != NULL )
+		{
+			for( directory_index = 0;
+			     directory_index < ( *logical_reader )->number_of_directories;
+			     directory_index++ )
+			{
+				if( logical_reader_directory_free(
+				     &( ( *logical_reader )->directories[ directory_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free directory: %d.",
+					 function,
+					 directory_index );
+
+					result = -1;
+				}
+			}
+			memory_free(
+			 ( *logical_reader )->directories );
+		}
+		if( ( *logical_reader )->ltree_spool != NULL )
+		{
+			if( file_stream_close(
+			     ( *logical_reader )->ltree_spool ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close ltree spool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *logical_reader )->source_path != NULL )
+		{
+			memory_free(
+			 ( *logical_reader )->source_path );
+		}
+		memory_free(
+		 *logical_reader );
+
+		*logical_reader = NULL;
+	}
+	return( result );
+}
+
+/* Signals the logical reader to abort
+ * Returns 1 if successful or -1 on error
+ */
+int logical_reader_signal_abort(
+     logical_reader_t *logical_reader,
+     libcerror_error_t **error )
+{
+	static char *function = "logical_reader_signal_abort";
+
+	if( logical_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid logical reader.",
+		 function );
+
+		return( -1 );
+	}
+	logical_reader->abort = 1;
+
+	return( 1 );
+}
+
+/* Creates a path from a directory path and a name
+ * Returns 1 if successful or -1 on error
+ */
+int logical_reader_join_path(
+     const char *directory_path,
+     size_t directory_path_length,
+     const char *name,
+     size_t name_length,
+     char **path,
+     size_t *path_length,
+     libcerror_error_t **error )
+{
+	static char *function = "logical_reader_join_path";
+	size_t path_index     = 0;
+
+	if( directory_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory path.",
+		 function );
+
+		return( -1 );
+	}
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( directory_path_length > (size_t) ( SSIZE_MAX / 2 ) )
+	 || ( name_length > (size_t) ( SSIZE_MAX / 2 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid path length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		return( -1 );
+	}
+	if( path_length == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path length.",
+		 function );
+
+		return( -1 );
+	}
+	*path = narrow_string_allocate(
+	         directory_path_length + name_length + 2 );
+
+	if( *path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create path.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     *path,
+	     directory_path,
+	     directory_path_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy directory path.",
+		 function );
+
+		goto on_error;
+	}
+	path_index = directory_path_length;
+
+	/* The root directory already ends with a path separator
+	 */
+	if( ( path_index == 0 )
+	 || ( directory_path[ path_index - 1 ] != '/' ) )
+	{
+		( *path )[ path_index++ ] = '/';
+	}
+	if( memory_copy(
+	     &( ( *path )[ path_index ] ),
+	     name,
+	     name_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy name.",
+		 function );
+
+		goto on_error;
+	}
+	path_index += name_length;
+
+	( *path )[ path_index ] = 0;
+
+	*path_length = path_index;
+
+	return( 1 );
+
+on_error:
+	memory_free(
+	 *path );
+
+	*path = NULL;
+
+	return( -1 );
+}
+
+/* Creates a directory
+ * Make sure the value directory is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int logical_reader_directory_initialize(
+     logical_reader_directory_t **directory,
+     const char *path,
+     size_t path_length,
+     libcerror_error_t **error )
+{
+	static char *function = "logical_reader_directory_initialize";
+
+	if( directory == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory.",
+		 function );
+
+		return( -1 );
+	}
+	if( *directory != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid directory value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		return( -1 );
+	}
+	if( path_length > (size_t) ( SSIZE_MAX - 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid path length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	*directory = memory_allocate_structure(
+	              logical_reader_directory_t );
+
+	if( *directory == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create directory.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *directory,
+	     0,
+	     sizeof( logical_reader_directory_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear directory.",
+		 function );
+
+		memory_free(
+		 *directory );
+
+		*directory = NULL;
+
+		return( -1 );
+	}
+	( *directory )->path = narrow_string_allocate(
+	                        path_length + 1 );
+
+	if( ( *directory )->path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create path.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     ( *directory )->path,
+	     path,
+	     path_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy path.",
+		 function );
+
+		goto on_error;
+	}
+	( *directory )->path[ path_length ] = 0;
+	( *directory )->path_length         = path_length;
+
+	return( 1 );
+
+on_error:
+	if( *directory != NULL )
+	{
+		if( ( *directory )->path != NULL )
+		{
+			memory_free(
+			 ( *directory )->path );
+		}
+		memory_free(
+		 *directory );
+
+		*directory = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a directory
+ * Returns 1 if successful or -1 on error
+ */
+int logical_reader_directory_free(
+     logical_reader_directory_t **directory,
+     libcerror_error_t **error )
+{
+	static char *function = "logical_reader_directory_free";
+	int name_index        = 0;
+
+	if( directory == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory.",
+		 function );
+
+		return( -1 );
+	}
+	if( *directory != NULL )
+	{
+		if( ( *directory )->names != NULL )
+		{
+			for( name_index = 0;
+			     name_index < ( *directory )->number_of_names;
+			     name_index++ )
+			{
+				if( ( *directory )->names[ name_index ] != NULL )
+				{
+					memory_free(
+					 ( *directory )->names[ name_index ] );
+				}
+			}
+			memory_free(
+			 ( *directory )->names );
+		}
+		memory_free(
+		 ( *directory )->path );
+
+		memory_free(
+		 *directory );
+
+		*directory = NULL;
+	}
+	return( 1 );
+}
+
+/* Compares two names
+ * Callback function for qsort
+ * Returns a value less than, equal to or greater than 0
+ */
+int logical_reader_directory_compare_names(
+     const void *first_name,
+     const void *second_name )
+{
+	size_t first_name_length  = 0;
+	size_t second_name_length = 0;
+
+	first_name_length = narrow_string_length(
+	                     *( (char * const *) first_name ) );
+
+	second_name_length = narrow_string_length(
+	                      *( (char * const *) second_name ) );
+
+	/* The end-of-string character is included in the comparison
+	 * so that a name sorts before the names it is a prefix of
+	 */
+	if( first_name_length > second_name_length )
+	{
+		first_name_length = second_name_length;
+	}
+	return( narrow_string_compare(
+	         *( (char * const *) first_name ),
+	         *( (char * const *) second_name ),
+	         first_name_length + 1 ) );
+}
+
+/* Reads the names of the sub entries of a directory
+ * Only regular files and directories are included, the names are sorted
+ * such that the order of the entries does not depend on the file system
+ * Returns 1 if successful, 0 if the directory could not be read or -1 on error
+ */
+int logical_reader_directory_read(
+     logical_reader_directory_t *directory,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LOGICAL_READER_SUPPORT )
+	struct stat file_stat;
+
+	struct dirent *directory_entry = NULL;
+	DIR *directory_stream          = NULL;
+	char **names                   = NULL;
+	char *path                     = NULL;
+	const char *name               = NULL;
+	size_t name_length             = 0;
+	size_t path_length             = 0;
+	int number_of_allocated_names  = 0;
+#endif
+	static char *function          = "logical_reader_directory_read";
+
+	if( directory == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory.",
+		 function );
+
+		return( -1 );
+	}
+	if( directory->names != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid directory - names value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_LOGICAL_READER_SUPPORT )
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: reading directories not supported.",
+	 function );
+
+	return( -1 );
+#else
+	directory_stream = opendir(
+	                    directory->path );
+
+	if( directory_stream == NULL )
+	{
+		return( 0 );
+	}
+	for( directory_entry = readdir( directory_stream );
+	     directory_entry != NULL;
+	     directory_entry = readdir( directory_stream ) )
+	{
+		name        = (const char *) directory_entry->d_name;
+		name_length = narrow_string_length(
+		               name );
+
+		if( ( ( name_length == 1 )
+		  &&  ( name[ 0 ] == '.' ) )
+		 || ( ( name_length == 2 )
+		  &&  ( name[ 0 ] == '.' )
+		  &&  ( name[ 1 ] == '.' ) ) )
+		{
+			continue;
+		}
+		if( logical_reader_join_path(
+		     directory->path,
+		     directory->path_length,
+		     name,
+		     name_length,
+		     &path,
+		     &path_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create path.",
+			 function );
+
+			goto on_error;
+		}
+		/* Symbolic links, devices, pipes and sockets are not acquired
+		 */
+		if( lstat(
+		     path,
+		     &file_stat ) != 0 )
+		{
+			file_stat.st_mode = 0;
+		}
+		memory_free(
+		 path );
+
+		path = NULL;
+
+		if( !S_ISREG( file_stat.st_mode )
+		 && !S_ISDIR( file_stat.st_mode ) )
+		{
+			continue;
+		}
+		if( directory->number_of_names >= number_of_allocated_names )
+		{
+			if( number_of_allocated_names == 0 )
+			{
+				number_of_allocated_names = 16;
+			}
+			else
+			{
+				number_of_allocated_names *= 2;
+			}
+			names = (char **) memory_reallocate(
+			                   directory->names,
+			                   sizeof( char * ) * number_of_allocated_names );
+
+			if( names == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize names.",
+				 function );
+
+				goto on_error;
+			}
+			directory->names = names;
+		}
+		directory->names[ directory->number_of_names ] = narrow_string_allocate(
+		                                                  name_length + 1 );
+
+		if( directory->names[ directory->number_of_names ] == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create name.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     directory->names[ directory->number_of_names ],
+		     name,
+		     name_length + 1 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy name.",
+			 function );
+
+			memory_free(
+			 directory->names[ directory->number_of_names ] );
+
+			directory->names[ directory->number_of_names ] = NULL;
+
+			goto on_error;
+		}
+		directory->number_of_names += 1;
+	}
+	closedir(
+	 directory_stream );
+
+	if( directory->number_of_names > 1 )
+	{
+		qsort(
+		 directory->names,
+		 (size_t) directory->number_of_names,
+		 sizeof( char * ),
+		 &logical_reader_directory_compare_names );
+	}
+	return( 1 );
+
+on_error:
+	if( path != NULL )
+	{
+		memory_free(
+		 path );
+	}
+	closedir(
+	 directory_stream );
+
+	return( -1 );
+#endif /* !defined( HAVE_LOGICAL_READER_SUPPORT ) */
+}
+
+/* Creates an entry
+ * Make sure the value entry is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int logical_reader_entry_initialize(
+     logical_reader_entry_t **entry,
+     const char *path,
+     size_t path_length,
+     size_t name_offset,
+     libcerror_error_t **error )
+{
+	static char *function = "logical_reader_entry_initialize";
+
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *entry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid entry value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		return( -1 );
+	}
+	if( path_length > (size_t) ( SSIZE_MAX - 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid path length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( name_offset > path_length )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid name offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*entry = memory_allocate_structure(
+	          logical_reader_entry_t );
+
+	if( *entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *entry,
+	     0,
+	     sizeof( logical_reader_entry_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entry.",
+		 function );
+
+		memory_free(
+		 *entry );
+
+		*entry = NULL;
+
+		return( -1 );
+	}
+	( *entry )->file_descriptor = -1;
+
+	( *entry )->path = narrow_string_allocate(
+	                    path_length + 1 );
+
+	if( ( *entry )->path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create path.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     ( *entry )->path,
+	     path,
+	     path_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy path.",
+		 function );
+
+		goto on_error;
+	}
+	( *entry )->path[ path_length ] = 0;
+	( *entry )->name                = &( ( *entry )->path[ name_offset ] );
+
+	return( 1 );
+
+on_error:
+	if( *entry != NULL )
+	{
+		if( ( *entry )->path != NULL )
+		{
+			memory_free(
+			 ( *entry )->path );
+		}
+		memory_free(
+		 *entry );
+
+		*entry = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an entry
+ * Returns 1 if successful or -1 on error
+ */
+int logical_reader_entry_free(
+     logical_reader_entry_t **entry,
+     libcerror_error_t **error )
+{
+	static char *function = "logical_reader_entry_free";
+	int result            = 1;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	int block_index       = 0;
+#endif
+
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *entry != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		for( block_index = 0;
+		     block_index < LOGICAL_READER_MAXIMUM_NUMBER_OF_ENTRY_BLOCKS;
+		     block_index++ )
+		{
+			if( ( *entry )->blocks[ block_index ] != NULL )
+			{
+				memory_free(
+				 ( *entry )->blocks[ block_index ] );
+			}
+		}
+#endif
+#if defined( HAVE_LOGICAL_READER_SUPPORT )
+		if( ( *entry )->file_descriptor != -1 )
+		{
+			close(
+			 ( *entry )->file_descriptor );
+		}
+#endif
+		if( ( *entry )->md5_context != NULL )
+		{
+			if( md5_context_free(
+			     &( ( *entry )->md5_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free MD5 context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 ( *entry )->path );
+
+		memory_free(
+		 *entry );
+
+		*entry = NULL;
+	}
+	return( result );
+}
+
+/* Pushes the directory of an entry onto the stack of directories
+ * The number of sub entries of the entry is set to the number of names in the directory
+ * Returns 1 if successful or -1 on error
+ */
+int logical_reader_push_directory(
+     logical_reader_t *logical_reader,
+     logical_reader_entry_t *entry,
+     libcerror_error_t **error )
+{
+	logical_reader_directory_t **directories = NULL;
+	logical_reader_directory_t *directory    = NULL;
+	static char *function                    = "logical_reader_push_directory";
+	int number_of_allocated_directories      = 0;
+	int result                               = 0;
+
+	if( logical_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid logical reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( logical_reader_directory_initialize(
+	     &directory,
+	     entry->path,
+	     narrow_string_length(
+	      entry->path ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create directory.",
+		 function );
+
+		goto on_error;
+	}
+	result = logical_reader_directory_read(
+	          directory,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read directory.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		/* A directory that cannot be read is stored without sub entries
+		 */
+		entry->is_unreadable = 1;
+	}
+	if( directory->number_of_names == 0 )
+	{
+		if( logical_reader_directory_free(
+		     &directory,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free directory.",
+			 function );
+
+			goto on_error;
+		}
+		return( 1 );
+	}
+	if( logical_reader->number_of_directories >= logical_reader->number_of_allocated_directories )
+	{
+		if( logical_reader->number_of_allocated_directories == 0 )
+		{
+			number_of_allocated_directories = 16;
+		}
+		else
+		{
+			number_of_allocated_directories = logical_reader->number_of_allocated_directories * 2;
+		}
+		directories = (logical_reader_directory_t **) memory_reallocate(
+		                                               logical_reader->directories,
+		                                               sizeof( logical_reader_directory_t * ) * number_of_allocated_directories );
+
+		if( directories == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize directories.",
+			 function );
+
+			goto on_error;
+		}
+		logical_reader->directories                     = directories;
+		logical_reader->number_of_allocated_directories = number_of_allocated_directories;
+	}
+	entry->number_of_sub_entries = directory->number_of_names;
+
+	logical_reader->directories[ logical_reader->number_of_directories ] = directory;
+
+	logical_reader->number_of_directories += 1;
+
+	return( 1 );
+
+on_error:
+	if( directory != NULL )
+	{
+		logical_reader_directory_free(
+		 &directory,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Enumerates the next entry in depth first order
+ * Returns 1 if successful, 0 if no more entries are available or -1 on error
+ */
+int logical_reader_get_next_entry(
+     logical_reader_t *logical_reader,
+     logical_reader_entry_t **entry,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LOGICAL_READER_SUPPORT )
+	struct stat file_stat;
+#endif
+
+	logical_reader_directory_t *directory = NULL;
+	char *path                            = NULL;
+	static char *function                 = "logical_reader_get_next_entry";
+	size_t name_offset                    = 0;
+	size_t path_length                    = 0;
+
+	if( logical_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid logical reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( logical_reader->end_of_entries != 0 )
+	{
+		return( 0 );
+	}
+#if !defined( HAVE_LOGICAL_READER_SUPPORT )
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: logical acquisition not supported.",
+	 function );
+
+	return( -1 );
+#else
+	if( logical_reader->source_is_enumerated == 0 )
+	{
+		/* The source directory is stored as the first entry
+		 * under its own name
+		 */
+		name_offset = logical_reader->source_path_length;
+
+		while( ( name_offset > 0 )
+		    && ( logical_reader->source_path[ name_offset - 1 ] != '/' ) )
+		{
+			name_offset--;
+		}
+		if( name_offset == logical_reader->source_path_length )
+		{
+			name_offset = 0;
+		}
+		if( logical_reader_entry_initialize(
+		     entry,
+		     logical_reader->source_path,
+		     logical_reader->source_path_length,
+		     name_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create source entry.",
+			 function );
+
+			goto on_error;
+		}
+		logical_reader->source_is_enumerated = 1;
+	}
+	else
+	{
+		while( logical_reader->number_of_directories > 0 )
+		{
+			directory = logical_reader->directories[ logical_reader->number_of_directories - 1 ];
+
+			if( directory->name_index < directory->number_of_names )
+			{
+				break;
+			}
+			logical_reader->number_of_directories -= 1;
+
+			logical_reader->directories[ logical_reader->number_of_directories ] = NULL;
+
+			if( logical_reader_directory_free(
+			     &directory,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free directory.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( logical_reader->number_of_directories == 0 )
+		{
+			logical_reader->end_of_entries = 1;
+
+			return( 0 );
+		}
+		if( logical_reader_join_path(
+		     directory->path,
+		     directory->path_length,
+		     directory->names[ directory->name_index ],
+		     narrow_string_length(
+		      directory->names[ directory->name_index ] ),
+		     &path,
+		     &path_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create path.",
+			 function );
+
+			goto on_error;
+		}
+		directory->name_index += 1;
+
+		name_offset = path_length - narrow_string_length(
+		                             directory->names[ directory->name_index - 1 ] );
+
+		if( logical_reader_entry_initialize(
+		     entry,
+		     path,
+		     path_length,
+		     name_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create entry.",
+			 function );
+
+			goto on_error;
+		}
+		memory_free(
+		 path );
+
+		path = NULL;
+	}
+	( *entry )->identifier = logical_reader->next_identifier;
+
+	logical_reader->next_identifier += 1;
+
+	/* An entry that was removed after the directory was read
+	 * is stored as an unreadable file
+	 */
+	if( lstat(
+	     ( *entry )->path,
+	     &file_stat ) != 0 )
+	{
+		( *entry )->is_unreadable = 1;
+
+		return( 1 );
+	}
+	( *entry )->access_time             = (int32_t) file_stat.st_atime;
+	( *entry )->modification_time       = (int32_t) file_stat.st_mtime;
+	( *entry )->entry_modification_time = (int32_t) file_stat.st_ctime;
+
+	if( S_ISDIR( file_stat.st_mode ) )
+	{
+		( *entry )->is_directory = 1;
+
+		if( logical_reader_push_directory(
+		     logical_reader,
+		     *entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push directory.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( path != NULL )
+	{
+		memory_free(
+		 path );
+	}
+	if( *entry != NULL )
+	{
+		logical_reader_entry_free(
+		 entry,
+		 NULL );
+	}
+	return( -1 );
+#endif /* !defined( HAVE_LOGICAL_READER_SUPPORT ) */
+}
+
+/* Appends an entry to the window of entries
+ * The logical reader takes over the entry
+ * Returns 1 if successful or -1 on error
+ */
+int logical_reader_append_entry(
+     logical_reader_t *logical_reader,
+     logical_reader_entry_t **entry,
+     libcerror_error_t **error )
+{
+	static char *function = "logical_reader_append_entry";
+	int entry_index       = 0;
+
+	if( logical_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid logical reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry == NULL )
+	 || ( *entry == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( logical_reader->number_of_entries >= LOGICAL_READER_MAXIMUM_NUMBER_OF_ENTRIES )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid logical reader - number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	entry_index = ( logical_reader->first_entry_index + logical_reader->number_of_entries )
+	            % LOGICAL_READER_MAXIMUM_NUMBER_OF_ENTRIES;
+
+	logical_reader->entries[ entry_index ] = *entry;
+
+	logical_reader->number_of_entries += 1;
+
+	*entry = NULL;
+
+	return( 1 );
+}
+
+/* Opens the file of an entry for reading
+ * Returns 1 if successful, 0 if the file could not be opened or -1 on error
+ */
+int logical_reader_open_entry(
+     logical_reader_t *logical_reader,
+     logical_reader_entry_t *entry,
+     libcerror_error_t **error )
+{
+	static char *function = "logical_reader_open_entry";
+
+	if( logical_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid logical reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry->file_descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid entry - file descriptor value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry->is_directory != 0 )
+	 || ( entry->is_unreadable != 0 ) )
+	{
+		return( 0 );
+	}
+#if !defined( HAVE_LOGICAL_READER_SUPPORT )
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: logical acquisition not supported.",
+	 function );
+
+	return( -1 );
+#else
+	entry->file_descriptor = open(
+	                          entry->path,
+	                          O_RDONLY | O_NOFOLLOW );
+
+	if( entry->file_descriptor == -1 )
+	{
+		entry->is_unreadable = 1;
+
+		return( 0 );
+	}
+	if( md5_context_initialize(
+	     &( entry->md5_context ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create MD5 context.",
+		 function );
+
+		close(
+		 entry->file_descriptor );
+
+		entry->file_descriptor = -1;
+
+		return( -1 );
+	}
+	return( 1 );
+#endif /* !defined( HAVE_LOGICAL_READER_SUPPORT ) */
+}
+
+/* Reads data of the file of an entry and updates its MD5
+ * A read error ends the data of the entry, which is then marked as unreadable
+ * Returns the number of bytes read, 0 if at end of the file or -1 on error
+ */
+ssize_t logical_reader_read_entry_data(
+         logical_reader_t *logical_reader,
+         logical_reader_entry_t *entry,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "logical_reader_read_entry_data";
+	size_t buffer_offset  = 0;
+	ssize_t read_count    = 0;
+
+	if( logical_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid logical reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry->file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid entry - missing file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LOGICAL_READER_SUPPORT )
+	while( buffer_offset < size )
+	{
+		if( logical_reader->abort != 0 )
+		{
+			break;
+		}
+		read_count = read(
+		              entry->file_descriptor,
+		              &( buffer[ buffer_offset ] ),
+		              size - buffer_offset );
+
+		if( read_count < 0 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			entry->is_unreadable = 1;
+
+			break;
+		}
+		else if( read_count == 0 )
+		{
+			break;
+		}
+		buffer_offset += (size_t) read_count;
+	}
+#endif
+	if( buffer_offset > 0 )
+	{
+		if( md5_context_update(
+		     entry->md5_context,
+		     buffer,
+		     buffer_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update MD5 context.",
+			 function );
+
+			return( -1 );
+		}
+		entry->size += (size64_t) buffer_offset;
+	}
+	return( (ssize_t) buffer_offset );
+}
+
+/* Closes the file of an entry and finalizes its MD5
+ * Returns 1 if successful or -1 on error
+ */
+int logical_reader_close_entry(
+     logical_reader_t *logical_reader,
+     logical_reader_entry_t *entry,
+     libcerror_error_t **error )
+{
+	static char *function = "logical_reader_close_entry";
+
+	if( logical_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid logical reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LOGICAL_READER_SUPPORT )
+	if( entry->file_descriptor != -1 )
+	{
+		close(
+		 entry->file_descriptor );
+
+		entry->file_descriptor = -1;
+	}
+#endif
+	if( entry->md5_context != NULL )
+	{
+		if( md5_context_finalize(
+		     entry->md5_context,
+		     entry->md5_hash,
+		     MD5_CONTEXT_HASH_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize MD5 context.",
+			 function );
+
+			return( -1 );
+		}
+		if( md5_context_free(
+		     &( entry->md5_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free MD5 context.",
+			 function );
+
+			return( -1 );
+		}
+		entry->md5_hash_is_set = 1;
+	}
+	return( 1 );
+}
+
+/* Writes the ltree record of an entry to the spool
+ * The name is written as UTF-8 where characters that would break the ltree,
+ * such as control characters, and invalid UTF-8 sequences are replaced by '_'
+ * Returns 1 if successful or -1 on error
+ */
+int logical_reader_spool_entry(
+     logical_reader_t *logical_reader,
+     logical_reader_entry_t *entry,
+     libcerror_error_t **error )
+{
+	static char *function     = "logical_reader_spool_entry";
+	size_t name_index         = 0;
+	size_t sequence_index     = 0;
+	size_t sequence_length    = 0;
+	uint8_t byte_value        = 0;
+	int hash_index            = 0;
+
+	if( logical_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid logical reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( logical_reader->ltree_spool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid logical reader - missing ltree spool.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry->is_unreadable != 0 )
+	{
+		logical_reader->number_of_unreadable_entries += 1;
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: unable to read: %s.\n",
+			 function,
+			 entry->path );
+		}
+#endif
+	}
+	/* The number of sub entries followed by the values in the order of the types:
+	 * p n id opr src sub cid jq cr ac wr mo dl aq ha ls du lo po [mid cfi] be pm lpt
+	 */
+	fprintf(
+	 logical_reader->ltree_spool,
+	 "0\t%d\n%s\t",
+	 entry->number_of_sub_entries,
+	 ( entry->is_directory != 0 ) ? "1" : "" );
+
+	while( entry->name[ name_index ] != 0 )
+	{
+		byte_value = (uint8_t) entry->name[ name_index ];
+
+		if( byte_value < 0x80 )
+		{
+			sequence_length = 1;
+		}
+		else if( ( byte_value >= 0xc2 )
+		      && ( byte_value <= 0xdf ) )
+		{
+			sequence_length = 2;
+		}
+		else if( ( byte_value >= 0xe0 )
+		      && ( byte_value <= 0xef ) )
+		{
+			sequence_length = 3;
+		}
+		else if( ( byte_value >= 0xf0 )
+		      && ( byte_value <= 0xf4 ) )
+		{
+			sequence_length = 4;
+		}
+		else
+		{
+			sequence_length = 0;
+		}
+		for( sequence_index = 1;
+		     sequence_index < sequence_length;
+		     sequence_index++ )
+		{
+			if( ( (uint8_t) entry->name[ name_index + sequence_index ] & 0xc0 ) != 0x80 )
+			{
+				sequence_length = 0;
+
+				break;
+			}
+		}
+		if( ( sequence_length == 0 )
+		 || ( ( sequence_length == 1 )
+		  &&  ( ( byte_value < 0x20 )
+		   ||   ( byte_value == 0x7f ) ) ) )
+		{
+			fputc(
+			 '_',
+			 logical_reader->ltree_spool );
+
+			name_index += 1;
+		}
+		else
+		{
+			fwrite(
+			 &( entry->name[ name_index ] ),
+			 1,
+			 sequence_length,
+			 logical_reader->ltree_spool );
+
+			name_index += sequence_length;
+		}
+	}
+	fprintf(
+	 logical_reader->ltree_spool,
+	 "\t%" PRIu64 "\t\t\t\t\t\t\t%" PRIi32 "\t%" PRIi32 "\t%" PRIi32 "\t\t\t",
+	 entry->identifier,
+	 entry->access_time,
+	 entry->modification_time,
+	 entry->entry_modification_time );
+
+	if( entry->md5_hash_is_set != 0 )
+	{
+		for( hash_index = 0;
+		     hash_index < MD5_CONTEXT_HASH_SIZE;
+		     hash_index++ )
+		{
+			fprintf(
+			 logical_reader->ltree_spool,
+			 "%02" PRIx8 "",
+			 entry->md5_hash[ hash_index ] );
+		}
+	}
+	fputc(
+	 '\t',
+	 logical_reader->ltree_spool );
+
+	if( entry->is_directory == 0 )
+	{
+		fprintf(
+		 logical_reader->ltree_spool,
+		 "%" PRIu64 "",
+		 entry->size );
+	}
+	fprintf(
+	 logical_reader->ltree_spool,
+	 "\t\t\t\t" );
+
+	if( logical_reader->ewf_format == LIBEWF_FORMAT_LOGICAL_ENCASE6 )
+	{
+		fprintf(
+		 logical_reader->ltree_spool,
+		 "\t\t" );
+	}
+	if( entry->size > 0 )
+	{
+		fprintf(
+		 logical_reader->ltree_spool,
+		 "1 %" PRIx64 " %" PRIx64 "",
+		 (uint64_t) entry->data_offset,
+		 entry->size );
+	}
+	fprintf(
+	 logical_reader->ltree_spool,
+	 "\t\t\n" );
+
+	if( ferror(
+	     logical_reader->ltree_spool ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write ltree record to spool.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Writes the ltree record of the first entry to the spool and removes the entry
+ * Returns 1 if successful or -1 on error
+ */
+int logical_reader_remove_first_entry(
+     logical_reader_t *logical_reader,
+     libcerror_error_t **error )
+{
+	logical_reader_entry_t *entry = NULL;
+	static char *function         = "logical_reader_remove_first_entry";
+
+	if( logical_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid logical reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( logical_reader->number_of_entries == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid logical reader - missing entries.",
+		 function );
+
+		return( -1 );
+	}
+	entry = logical_reader->entries[ logical_reader->first_entry_index ];
+
+	logical_reader->entries[ logical_reader->first_entry_index ] = NULL;
+
+	logical_reader->first_entry_index = ( logical_reader->first_entry_index + 1 )
+	                                  % LOGICAL_READER_MAXIMUM_NUMBER_OF_ENTRIES;
+
+	logical_reader->number_of_entries -= 1;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( logical_reader->number_of_claimed_entries > 0 )
+	{
+		logical_reader->number_of_claimed_entries -= 1;
+	}
+#endif
+	if( logical_reader_spool_entry(
+	     logical_reader,
+	     entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to spool entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( logical_reader_entry_free(
+	     &entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free entry.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( entry != NULL )
+	{
+		logical_reader_entry_free(
+		 &entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the next part of the data of the entries into the storage media buffer
+ * The files are read in the order of the entries, where the data of an entry
+ * directly follows the data of the previous entry
+ * Returns the number of bytes read, 0 if at end of input or -1 on error
+ */
+ssize_t logical_reader_read_buffer(
+         logical_reader_t *logical_reader,
+         storage_media_buffer_t *storage_media_buffer,
+         libcerror_error_t **error )
+{
+	logical_reader_entry_t *entry = NULL;
+	static char *function         = "logical_reader_read_buffer";
+	size_t buffer_offset          = 0;
+	ssize_t read_count            = 0;
+	int result                    = 0;
+
+	if( logical_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid logical reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	while( ( buffer_offset < storage_media_buffer->raw_buffer_size )
+	    && ( logical_reader->abort == 0 ) )
+	{
+		if( logical_reader->number_of_entries == 0 )
+		{
+			result = logical_reader_get_next_entry(
+			          logical_reader,
+			          &entry,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve next entry.",
+				 function );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				break;
+			}
+			if( logical_reader_append_entry(
+			     logical_reader,
+			     &entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append entry.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		entry = logical_reader->entries[ logical_reader->first_entry_index ];
+
+		if( ( entry->is_directory == 0 )
+		 && ( entry->is_complete == 0 )
+		 && ( entry->file_descriptor == -1 ) )
+		{
+			result = logical_reader_open_entry(
+			          logical_reader,
+			          entry,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to open entry.",
+				 function );
+
+				entry = NULL;
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				entry->is_complete = 1;
+			}
+			entry->data_offset = logical_reader->storage_media_offset + (off64_t) buffer_offset;
+		}
+		if( entry->file_descriptor != -1 )
+		{
+			read_count = logical_reader_read_entry_data(
+			              logical_reader,
+			              entry,
+			              &( ( storage_media_buffer->raw_buffer )[ buffer_offset ] ),
+			              storage_media_buffer->raw_buffer_size - buffer_offset,
+			              error );
+
+			if( read_count < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read entry data.",
+				 function );
+
+				entry = NULL;
+
+				goto on_error;
+			}
+			buffer_offset += (size_t) read_count;
+
+			if( ( read_count > 0 )
+			 && ( entry->is_unreadable == 0 ) )
+			{
+				continue;
+			}
+			if( logical_reader->abort != 0 )
+			{
+				break;
+			}
+			if( logical_reader_close_entry(
+			     logical_reader,
+			     entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close entry.",
+				 function );
+
+				entry = NULL;
+
+				goto on_error;
+			}
+			entry->is_complete = 1;
+		}
+		entry = NULL;
+
+		if( logical_reader_remove_first_entry(
+		     logical_reader,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove first entry.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	storage_media_buffer->storage_media_offset = logical_reader->storage_media_offset;
+	storage_media_buffer->requested_size       = storage_media_buffer->raw_buffer_size;
+	storage_media_buffer->raw_buffer_data_size = buffer_offset;
+
+	logical_reader->storage_media_offset += (off64_t) buffer_offset;
+
+	return( (ssize_t) buffer_offset );
+
+on_error:
+	if( entry != NULL )
+	{
+		logical_reader_entry_free(
+		 &entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Appends the ltree to the output handles
+ * The ltree consists of the record category, which contains the size of the data,
+ * and the entry category, which contains the spooled ltree records of the entries
+ * under an unnamed root entry
+ * Returns 1 if successful or -1 on error
+ */
+int logical_reader_append_ltree(
+     logical_reader_t *logical_reader,
+     imaging_handle_t *imaging_handle,
+     libcerror_error_t **error )
+{
+	char header_string[ 256 ];
+
+	uint8_t *spool_data         = NULL;
+	const char *types_string    = NULL;
+	static char *function       = "logical_reader_append_ltree";
+	size_t line_data_size       = 0;
+	size_t read_count           = 0;
+	size_t spool_data_size      = 0;
+	int header_string_length    = 0;
+	int number_of_types         = 0;
+	int type_index              = 0;
+
+	if( logical_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid logical reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( logical_reader->ltree_spool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid logical reader - missing ltree spool.",
+		 function );
+
+		return( -1 );
+	}
+	if( logical_reader->number_of_entries != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid logical reader - entries were not consumed.",
+		 function );
+
+		return( -1 );
+	}
+	/* The position of the be type determines the format when the ltree is parsed
+	 */
+	if( logical_reader->ewf_format == LIBEWF_FORMAT_LOGICAL_ENCASE5 )
+	{
+		types_string    = "p\tn\tid\topr\tsrc\tsub\tcid\tjq\tcr\tac\twr\tmo\tdl\taq\tha\tls\tdu\tlo\tpo\tbe\tpm\tlpt";
+		number_of_types = 22;
+	}
+	else
+	{
+		types_string    = "p\tn\tid\topr\tsrc\tsub\tcid\tjq\tcr\tac\twr\tmo\tdl\taq\tha\tls\tdu\tlo\tpo\tmid\tcfi\tbe\tpm\tlpt";
+		number_of_types = 24;
+	}
+	header_string_length = narrow_string_snprintf(
+	                        header_string,
+	                        256,
+	                        "5\nrec\ntb\n%" PRIu64 "\nentry\n1\n%s\n0\t1\n1",
+	                        (uint64_t) logical_reader->storage_media_offset,
+	                        types_string );
+
+	if( ( header_string_length < 0 )
+	 || ( header_string_length > ( 256 - number_of_types - 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set header string.",
+		 function );
+
+		goto on_error;
+	}
+	/* The root entry only has the directory value
+	 */
+	for( type_index = 1;
+	     type_index < number_of_types;
+	     type_index++ )
+	{
+		header_string[ header_string_length++ ] = '\t';
+	}
+	header_string[ header_string_length++ ] = '\n';
+
+	if( imaging_handle_append_ltree_data(
+	     imaging_handle,
+	     (uint8_t *) header_string,
+	     (size_t) header_string_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append ltree header.",
+		 function );
+
+		goto on_error;
+	}
+	if( fflush(
+	     logical_reader->ltree_spool ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush ltree spool.",
+		 function );
+
+		goto on_error;
+	}
+	rewind(
+	 logical_reader->ltree_spool );
+
+	spool_data = (uint8_t *) memory_allocate(
+	                          sizeof( uint8_t ) * LOGICAL_READER_SPOOL_BLOCK_SIZE );
+
+	if( spool_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create spool data.",
+		 function );
+
+		goto on_error;
+	}
+	/* The spool is appended up to the last line feed in the data such that
+	 * a UTF-8 character is never split across appends
+	 */
+	do
+	{
+		read_count = fread(
+		              &( spool_data[ spool_data_size ] ),
+		              1,
+		              LOGICAL_READER_SPOOL_BLOCK_SIZE - spool_data_size,
+		              logical_reader->ltree_spool );
+
+		if( ferror(
+		     logical_reader->ltree_spool ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read ltree spool.",
+			 function );
+
+			goto on_error;
+		}
+		spool_data_size += read_count;
+
+		line_data_size = spool_data_size;
+
+		while( ( line_data_size > 0 )
+		    && ( spool_data[ line_data_size - 1 ] != (uint8_t) '\n' ) )
+		{
+			line_data_size--;
+		}
+		if( ( line_data_size == 0 )
+		 && ( spool_data_size == LOGICAL_READER_SPOOL_BLOCK_SIZE ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid ltree record size value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		if( line_data_size > 0 )
+		{
+			if( imaging_handle_append_ltree_data(
+			     imaging_handle,
+			     spool_data,
+			     line_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append ltree records.",
+				 function );
+
+				goto on_error;
+			}
+			spool_data_size -= line_data_size;
+
+			if( spool_data_size > 0 )
+			{
+				if( memory_copy(
+				     spool_data,
+				     &( spool_data[ line_data_size ] ),
+				     spool_data_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy remainder of spool data.",
+					 function );
+
+					goto on_error;
+				}
+			}
+		}
+	}
+	while( read_count > 0 );
+
+	if( spool_data_size != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid ltree spool - incomplete record.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 spool_data );
+
+	spool_data = NULL;
+
+	/* The entries are followed by an empty line
+	 */
+	if( imaging_handle_append_ltree_data(
+	     imaging_handle,
+	     (uint8_t *) "\n",
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append ltree trailer.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( spool_data != NULL )
+	{
+		memory_free(
+		 spool_data );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Starts the reader threads
+ * Returns 1 if successful or -1 on error
+ */
+int logical_reader_start(
+     logical_reader_t *logical_reader,
+     storage_media_buffer_queue_t *storage_media_buffer_queue,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "logical_reader_start";
+	size_t threads_size   = 0;
+	int thread_index      = 0;
+
+	if( logical_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid logical reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( logical_reader->threads != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid logical reader - threads value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_threads <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of threads value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	threads_size = sizeof( libcthreads_thread_t * ) * number_of_threads;
+
+	logical_reader->threads = (libcthreads_thread_t **) memory_allocate(
+	                                                     threads_size );
+
+	if( logical_reader->threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create threads.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     logical_reader->threads,
+	     0,
+	     threads_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear threads.",
+		 function );
+
+		goto on_error;
+	}
+	logical_reader->storage_media_buffer_queue = storage_media_buffer_queue;
+	logical_reader->number_of_threads          = number_of_threads;
+	logical_reader->number_of_finished_threads = 0;
+	logical_reader->result                     = 1;
+
+	if( libcthreads_mutex_initialize(
+	     &( logical_reader->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( logical_reader->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	for( thread_index = 0;
+	     thread_index < number_of_threads;
+	     thread_index++ )
+	{
+		if( libcthreads_thread_create(
+		     &( logical_reader->threads[ thread_index ] ),
+		     NULL,
+		     (int (*)(void *)) &logical_reader_thread_function,
+		     (void *) logical_reader,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create reader thread: %d.",
+			 function,
+			 thread_index );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( logical_reader->threads != NULL )
+	{
+		logical_reader_stop(
+		 logical_reader,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Claims the next entry that needs to be read, enumerating entries as necessary
+ * Directories are not read hence they are skipped
+ * Make sure to grab the mutex before calling this function
+ * Returns 1 if successful, 0 if no more entries need to be read or -1 on error
+ */
+int logical_reader_claim_entry(
+     logical_reader_t *logical_reader,
+     logical_reader_entry_t **entry,
+     libcerror_error_t **error )
+{
+	logical_reader_entry_t *next_entry = NULL;
+	static char *function              = "logical_reader_claim_entry";
+	int entry_index                    = 0;
+	int result                         = 0;
+
+	if( logical_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid logical reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	*entry = NULL;
+
+	while( ( logical_reader->abort == 0 )
+	    && ( logical_reader->result == 1 ) )
+	{
+		if( logical_reader->number_of_claimed_entries < logical_reader->number_of_entries )
+		{
+			entry_index = ( logical_reader->first_entry_index + logical_reader->number_of_claimed_entries )
+			            % LOGICAL_READER_MAXIMUM_NUMBER_OF_ENTRIES;
+
+			logical_reader->number_of_claimed_entries += 1;
+
+			if( logical_reader->entries[ entry_index ]->is_directory == 0 )
+			{
+				*entry = logical_reader->entries[ entry_index ];
+
+				return( 1 );
+			}
+		}
+		else if( ( logical_reader->end_of_entries == 0 )
+		      && ( logical_reader->number_of_entries < LOGICAL_READER_MAXIMUM_NUMBER_OF_ENTRIES ) )
+		{
+			result = logical_reader_get_next_entry(
+			          logical_reader,
+			          &next_entry,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve next entry.",
+				 function );
+
+				return( -1 );
+			}
+			else if( result != 0 )
+			{
+				if( logical_reader_append_entry(
+				     logical_reader,
+				     &next_entry,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append entry.",
+					 function );
+
+					logical_reader_entry_free(
+					 &next_entry,
+					 NULL );
+
+					return( -1 );
+				}
+			}
+			/* The consumer waits for new entries and for the end of the entries
+			 */
+			if( libcthreads_condition_broadcast(
+			     logical_reader->condition,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to broadcast condition.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( logical_reader->end_of_entries != 0 )
+		{
+			break;
+		}
+		else if( libcthreads_condition_wait(
+		          logical_reader->condition,
+		          logical_reader->mutex,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Reads the files of the entries into the rings of blocks of the entries
+ * Callback function for the reader threads
+ * Returns 1 if successful or -1 on error
+ */
+int logical_reader_thread_function(
+     logical_reader_t *logical_reader )
+{
+	libcerror_error_t *error      = NULL;
+	logical_reader_entry_t *entry = NULL;
+	uint8_t *block                = NULL;
+	static char *function         = "logical_reader_thread_function";
+	ssize_t read_count            = 0;
+	int block_index               = 0;
+	int result                    = 1;
+
+	if( logical_reader == NULL )
+	{
+		return( -1 );
+	}
+	while( result == 1 )
+	{
+		if( libcthreads_mutex_grab(
+		     logical_reader->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			goto on_error;
+		}
+		result = logical_reader_claim_entry(
+		          logical_reader,
+		          &entry,
+		          &error );
+
+		if( libcthreads_mutex_release(
+		     logical_reader->mutex,
+		     NULL ) != 1 )
+		{
+			result = -1;
+		}
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to claim entry.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		/* The file is opened and read outside the mutex so that
+		 * multiple files are read and hashed concurrently
+		 */
+		result = logical_reader_open_entry(
+		          logical_reader,
+		          entry,
+		          &error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open entry.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			/* An entry that could not be opened is complete without data
+			 */
+			if( libcthreads_mutex_grab(
+			     logical_reader->mutex,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to grab mutex.",
+				 function );
+
+				goto on_error;
+			}
+			entry->is_complete = 1;
+
+			libcthreads_condition_broadcast(
+			 logical_reader->condition,
+			 NULL );
+
+			if( libcthreads_mutex_release(
+			     logical_reader->mutex,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release mutex.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		while( result == 1 )
+		{
+			if( libcthreads_mutex_grab(
+			     logical_reader->mutex,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to grab mutex.",
+				 function );
+
+				goto on_error;
+			}
+			/* The reader of the first entry is not bound by the total number
+			 * of blocks since the consumer is waiting for its data
+			 */
+			while( ( logical_reader->abort == 0 )
+			    && ( ( entry->number_of_blocks >= LOGICAL_READER_MAXIMUM_NUMBER_OF_ENTRY_BLOCKS )
+			     ||  ( ( logical_reader->number_of_blocks >= LOGICAL_READER_MAXIMUM_NUMBER_OF_BLOCKS )
+			      &&   ( logical_reader->entries[ logical_reader->first_entry_index ] != entry ) ) ) )
+			{
+				if( libcthreads_condition_wait(
+				     logical_reader->condition,
+				     logical_reader->mutex,
+				     &error ) != 1 )
+				{
+					libcerror_error_set(
+					 &error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GENERIC,
+					 "%s: unable to wait for condition.",
+					 function );
+
+					libcthreads_mutex_release(
+					 logical_reader->mutex,
+					 NULL );
+
+					goto on_error;
+				}
+			}
+			if( libcthreads_mutex_release(
+			     logical_reader->mutex,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release mutex.",
+				 function );
+
+				goto on_error;
+			}
+			if( logical_reader->abort != 0 )
+			{
+				break;
+			}
+			if( block == NULL )
+			{
+				block = (uint8_t *) memory_allocate(
+				                     sizeof( uint8_t ) * LOGICAL_READER_BLOCK_SIZE );
+
+				if( block == NULL )
+				{
+					libcerror_error_set(
+					 &error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to create block.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			read_count = logical_reader_read_entry_data(
+			              logical_reader,
+			              entry,
+			              block,
+			              LOGICAL_READER_BLOCK_SIZE,
+			              &error );
+
+			if( read_count < 0 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read entry data.",
+				 function );
+
+				goto on_error;
+			}
+			if( ( read_count == 0 )
+			 || ( entry->is_unreadable != 0 ) )
+			{
+				if( logical_reader_close_entry(
+				     logical_reader,
+				     entry,
+				     &error ) != 1 )
+				{
+					libcerror_error_set(
+					 &error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+					 "%s: unable to close entry.",
+					 function );
+
+					goto on_error;
+				}
+				result = 0;
+			}
+			if( libcthreads_mutex_grab(
+			     logical_reader->mutex,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to grab mutex.",
+				 function );
+
+				goto on_error;
+			}
+			if( read_count > 0 )
+			{
+				block_index = ( entry->first_block_index + entry->number_of_blocks )
+				            % LOGICAL_READER_MAXIMUM_NUMBER_OF_ENTRY_BLOCKS;
+
+				entry->blocks[ block_index ]      = block;
+				entry->block_sizes[ block_index ] = (size_t) read_count;
+
+				entry->number_of_blocks         += 1;
+				logical_reader->number_of_blocks += 1;
+
+				block = NULL;
+			}
+			if( result == 0 )
+			{
+				entry->is_complete = 1;
+			}
+			if( libcthreads_condition_broadcast(
+			     logical_reader->condition,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to broadcast condition.",
+				 function );
+
+				result = -1;
+			}
+			if( libcthreads_mutex_release(
+			     logical_reader->mutex,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release mutex.",
+				 function );
+
+				result = -1;
+			}
+			if( result == -1 )
+			{
+				goto on_error;
+			}
+		}
+		entry  = NULL;
+		result = 1;
+
+		if( logical_reader->abort != 0 )
+		{
+			break;
+		}
+	}
+	result = 1;
+
+on_error:
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+
+		result = -1;
+	}
+	if( block != NULL )
+	{
+		memory_free(
+		 block );
+	}
+	/* The consumer is signalled even if the mutex cannot be grabbed
+	 * since it also checks the number of finished threads on a spurious wake up
+	 */
+	libcthreads_mutex_grab(
+	 logical_reader->mutex,
+	 NULL );
+
+	if( result != 1 )
+	{
+		logical_reader->result = result;
+	}
+	logical_reader->number_of_finished_threads += 1;
+
+	libcthreads_condition_broadcast(
+	 logical_reader->condition,
+	 NULL );
+	libcthreads_mutex_release(
+	 logical_reader->mutex,
+	 NULL );
+
+	return( result );
+}
+
+/* Retrieves the next storage media buffer filled with the data of the entries
+ * The caller takes over the storage media buffer
+ * Returns the number of bytes read, 0 if at end of input or -1 on error
+ */
+ssize_t logical_reader_get_buffer(
+         logical_reader_t *logical_reader,
+         storage_media_buffer_t **storage_media_buffer,
+         libcerror_error_t **error )
+{
+	storage_media_buffer_t *buffer = NULL;
+	logical_reader_entry_t *entry  = NULL;
+	uint8_t *block                 = NULL;
+	static char *function          = "logical_reader_get_buffer";
+	size_t buffer_offset           = 0;
+	size_t copy_size               = 0;
+	int result                     = 1;
+
+	if( logical_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid logical reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( logical_reader->threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid logical reader - missing threads.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer_queue_grab_buffer(
+	     logical_reader->storage_media_buffer_queue,
+	     &buffer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to grab storage media buffer from queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     logical_reader->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	while( ( buffer_offset < buffer->raw_buffer_size )
+	    && ( logical_reader->abort == 0 )
+	    && ( logical_reader->result == 1 ) )
+	{
+		if( logical_reader->number_of_entries == 0 )
+		{
+			if( ( logical_reader->end_of_entries != 0 )
+			 || ( logical_reader->number_of_finished_threads >= logical_reader->number_of_threads ) )
+			{
+				break;
+			}
+		}
+		else
+		{
+			entry = logical_reader->entries[ logical_reader->first_entry_index ];
+
+			if( entry->consumed_size == 0 )
+			{
+				entry->data_offset = logical_reader->storage_media_offset + (off64_t) buffer_offset;
+			}
+			if( entry->number_of_blocks > 0 )
+			{
+				block     = entry->blocks[ entry->first_block_index ];
+				copy_size = entry->block_sizes[ entry->first_block_index ] - entry->block_offset;
+
+				if( copy_size > ( buffer->raw_buffer_size - buffer_offset ) )
+				{
+					copy_size = buffer->raw_buffer_size - buffer_offset;
+				}
+				/* The reader threads only append blocks, hence the first block
+				 * of the first entry is copied without holding the mutex
+				 */
+				if( libcthreads_mutex_release(
+				     logical_reader->mutex,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to release mutex.",
+					 function );
+
+					goto on_error;
+				}
+				if( memory_copy(
+				     &( ( buffer->raw_buffer )[ buffer_offset ] ),
+				     &( block[ entry->block_offset ] ),
+				     copy_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy block data.",
+					 function );
+
+					goto on_error;
+				}
+				if( libcthreads_mutex_grab(
+				     logical_reader->mutex,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to grab mutex.",
+					 function );
+
+					goto on_error;
+				}
+				buffer_offset        += copy_size;
+				entry->block_offset  += copy_size;
+				entry->consumed_size += (size64_t) copy_size;
+
+				if( entry->block_offset >= entry->block_sizes[ entry->first_block_index ] )
+				{
+					memory_free(
+					 block );
+
+					entry->blocks[ entry->first_block_index ]      = NULL;
+					entry->block_sizes[ entry->first_block_index ] = 0;
+
+					entry->first_block_index = ( entry->first_block_index + 1 )
+					                         % LOGICAL_READER_MAXIMUM_NUMBER_OF_ENTRY_BLOCKS;
+
+					entry->block_offset               = 0;
+					entry->number_of_blocks          -= 1;
+					logical_reader->number_of_blocks -= 1;
+
+					if( libcthreads_condition_broadcast(
+					     logical_reader->condition,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+						 "%s: unable to broadcast condition.",
+						 function );
+
+						result = -1;
+
+						break;
+					}
+				}
+				continue;
+			}
+			if( ( entry->is_directory != 0 )
+			 || ( entry->is_complete != 0 ) )
+			{
+				if( logical_reader_remove_first_entry(
+				     logical_reader,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+					 "%s: unable to remove first entry.",
+					 function );
+
+					result = -1;
+
+					break;
+				}
+				/* The reader thread of the next entry is no longer bound
+				 * by the total number of blocks
+				 */
+				if( libcthreads_condition_broadcast(
+				     logical_reader->condition,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to broadcast condition.",
+					 function );
+
+					result = -1;
+
+					break;
+				}
+				continue;
+			}
+		}
+		if( libcthreads_condition_wait(
+		     logical_reader->condition,
+		     logical_reader->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+	}
+	if( ( result == 1 )
+	 && ( logical_reader->result != 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: reader thread failed.",
+		 function );
+
+		result = -1;
+	}
+	if( ( result == 1 )
+	 && ( logical_reader->abort == 0 )
+	 && ( logical_reader->number_of_entries == 0 )
+	 && ( logical_reader->end_of_entries == 0 )
+	 && ( buffer_offset < buffer->raw_buffer_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: reader threads finished before the end of the entries.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     logical_reader->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	buffer->storage_media_offset = logical_reader->storage_media_offset;
+	buffer->requested_size       = buffer->raw_buffer_size;
+	buffer->raw_buffer_data_size = buffer_offset;
+
+	logical_reader->storage_media_offset += (off64_t) buffer_offset;
+
+	if( buffer_offset == 0 )
+	{
+		if( storage_media_buffer_queue_release_buffer(
+		     logical_reader->storage_media_buffer_queue,
+		     buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release storage media buffer onto queue.",
+			 function );
+
+			return( -1 );
+		}
+		return( 0 );
+	}
+	*storage_media_buffer = buffer;
+
+	return( (ssize_t) buffer_offset );
+
+on_error:
+	storage_media_buffer_queue_release_buffer(
+	 logical_reader->storage_media_buffer_queue,
+	 buffer,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Stops the reader threads
+ * Returns 1 if successful or -1 on error
+ */
+int logical_reader_stop(
+     logical_reader_t *logical_reader,
+     libcerror_error_t **error )
+{
+	static char *function = "logical_reader_stop";
+	int result            = 1;
+	int thread_index      = 0;
+
+	if( logical_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid logical reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( logical_reader->threads != NULL )
+	{
+		if( logical_reader->mutex != NULL )
+		{
+			/* The reader threads do not read any further once abort is set
+			 */
+			if( libcthreads_mutex_grab(
+			     logical_reader->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to grab mutex.",
+				 function );
+
+				return( -1 );
+			}
+			logical_reader->abort = 1;
+
+			if( logical_reader->condition != NULL )
+			{
+				if( libcthreads_condition_broadcast(
+				     logical_reader->condition,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to broadcast condition.",
+					 function );
+
+					result = -1;
+				}
+			}
+			if( libcthreads_mutex_release(
+			     logical_reader->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release mutex.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		for( thread_index = 0;
+		     thread_index < logical_reader->number_of_threads;
+		     thread_index++ )
+		{
+			if( logical_reader->threads[ thread_index ] != NULL )
+			{
+				if( libcthreads_thread_join(
+				     &( logical_reader->threads[ thread_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to join reader thread: %d.",
+					 function,
+					 thread_index );
+
+					result = -1;
+				}
+			}
+		}
+		memory_free(
+		 logical_reader->threads );
+
+		logical_reader->threads = NULL;
+	}
+	if( logical_reader->condition != NULL )
+	{
+		if( libcthreads_condition_free(
+		     &( logical_reader->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( logical_reader->mutex != NULL )
+	{
+		if( libcthreads_mutex_free(
+		     &( logical_reader->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,436 @@
+/*
+ * Logical reader functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LOGICAL_READER_H )
+#define _LOGICAL_READER_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <system_string.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "imaging_handle.h"
+#include "md5_context.h"
+#include "storage_media_buffer.h"
+#include "storage_media_buffer_queue.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if !defined( WINAPI ) && defined( HAVE_DIRENT_H ) && defined( HAVE_OPENDIR ) && defined( HAVE_READDIR ) && defined( HAVE_CLOSEDIR )
+#define HAVE_LOGICAL_READER_SUPPORT
+#endif
+
+/* The size of the blocks in which the files are read
+ */
+#define LOGICAL_READER_BLOCK_SIZE				( 1024 * 1024 )
+
+/* The maximum number of entries that are enumerated ahead of the entry
+ * whose data is being consumed
+ */
+#define LOGICAL_READER_MAXIMUM_NUMBER_OF_ENTRIES		64
+
+/* The maximum number of blocks that are read ahead per entry
+ */
+#define LOGICAL_READER_MAXIMUM_NUMBER_OF_ENTRY_BLOCKS		8
+
+/* The maximum number of blocks that are read ahead of all entries
+ */
+#define LOGICAL_READER_MAXIMUM_NUMBER_OF_BLOCKS			64
+
+typedef struct logical_reader_directory logical_reader_directory_t;
+
+struct logical_reader_directory
+{
+	/* The path
+	 */
+	char *path;
+
+	/* The path length
+	 */
+	size_t path_length;
+
+	/* The names of the sub entries
+	 */
+	char **names;
+
+	/* The number of names
+	 */
+	int number_of_names;
+
+	/* The index of the next name
+	 */
+	int name_index;
+};
+
+typedef struct logical_reader_entry logical_reader_entry_t;
+
+struct logical_reader_entry
+{
+	/* The path
+	 */
+	char *path;
+
+	/* The name, which is part of the path
+	 */
+	const char *name;
+
+	/* The identifier
+	 */
+	uint64_t identifier;
+
+	/* Value to indicate the entry is a directory
+	 */
+	uint8_t is_directory;
+
+	/* The number of sub entries
+	 */
+	int number_of_sub_entries;
+
+	/* The access time
+	 */
+	int32_t access_time;
+
+	/* The modification time
+	 */
+	int32_t modification_time;
+
+	/* The entry modification time
+	 */
+	int32_t entry_modification_time;
+
+	/* The data offset
+	 */
+	off64_t data_offset;
+
+	/* The number of bytes read, which is the size of the data
+	 */
+	size64_t size;
+
+	/* The number of bytes of the data that were consumed
+	 */
+	size64_t consumed_size;
+
+	/* The MD5 context
+	 */
+	md5_context_t *md5_context;
+
+	/* The MD5 hash
+	 */
+	uint8_t md5_hash[ MD5_CONTEXT_HASH_SIZE ];
+
+	/* Value to indicate the MD5 hash is set
+	 */
+	uint8_t md5_hash_is_set;
+
+	/* The file descriptor
+	 */
+	int file_descriptor;
+
+	/* Value to indicate the entry could not be read
+	 */
+	uint8_t is_unreadable;
+
+	/* Value to indicate all data of the entry was read
+	 */
+	uint8_t is_complete;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The ring of blocks that were read and not yet consumed
+	 */
+	uint8_t *blocks[ LOGICAL_READER_MAXIMUM_NUMBER_OF_ENTRY_BLOCKS ];
+
+	/* The sizes of the blocks
+	 */
+	size_t block_sizes[ LOGICAL_READER_MAXIMUM_NUMBER_OF_ENTRY_BLOCKS ];
+
+	/* The index of the first block
+	 */
+	int first_block_index;
+
+	/* The number of blocks
+	 */
+	int number_of_blocks;
+
+	/* The offset of the unconsumed data in the first block
+	 */
+	size_t block_offset;
+#endif
+};
+
+typedef struct logical_reader logical_reader_t;
+
+/* The logical reader reads the files of a directory tree sequentially into
+ * storage media buffers and builds the single files entries (ltree) of
+ * a logical image
+ *
+ * The entries are read in depth first order and the ltree records are spooled
+ * to a temporary file as the data of each entry is consumed, such that the
+ * number of entries is not bound by the available memory
+ *
+ * In multi-threaded mode the files are read and hashed by multiple reader
+ * threads concurrently, each into a small ring of blocks, and the data is
+ * consumed in the order of the entries
+ */
+struct logical_reader
+{
+	/* The source path
+	 */
+	char *source_path;
+
+	/* The source path length
+	 */
+	size_t source_path_length;
+
+	/* The EWF format
+	 */
+	uint8_t ewf_format;
+
+	/* The stack of directories that are being enumerated
+	 */
+	logical_reader_directory_t **directories;
+
+	/* The number of directories on the stack
+	 */
+	int number_of_directories;
+
+	/* The number of allocated directories
+	 */
+	int number_of_allocated_directories;
+
+	/* The next identifier
+	 */
+	uint64_t next_identifier;
+
+	/* Value to indicate the source entry was enumerated
+	 */
+	uint8_t source_is_enumerated;
+
+	/* Value to indicate all entries were enumerated
+	 */
+	uint8_t end_of_entries;
+
+	/* The window of entries that were enumerated and not yet consumed
+	 */
+	logical_reader_entry_t *entries[ LOGICAL_READER_MAXIMUM_NUMBER_OF_ENTRIES ];
+
+	/* The index of the first entry
+	 */
+	int first_entry_index;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The offset of the next storage media buffer
+	 */
+	off64_t storage_media_offset;
+
+	/* The number of entries that could not be read
+	 */
+	int number_of_unreadable_entries;
+
+	/* The spool of ltree records
+	 */
+	FILE *ltree_spool;
+
+	/* Value to indicate the reader should abort
+	 */
+	uint8_t abort;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The storage media buffer queue
+	 */
+	storage_media_buffer_queue_t *storage_media_buffer_queue;
+
+	/* The number of entries in the window that were claimed by a reader thread
+	 */
+	int number_of_claimed_entries;
+
+	/* The number of blocks that were read and not yet consumed
+	 */
+	int number_of_blocks;
+
+	/* The reader threads
+	 */
+	libcthreads_thread_t **threads;
+
+	/* The number of reader threads
+	 */
+	int number_of_threads;
+
+	/* The number of reader threads that have finished
+	 */
+	int number_of_finished_threads;
+
+	/* The result of the reader threads
+	 */
+	int result;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when an entry, a block or a slot became available
+	 */
+	libcthreads_condition_t *condition;
+#endif
+};
+
+int logical_reader_initialize(
+     logical_reader_t **logical_reader,
+     const system_character_t *source_path,
+     uint8_t ewf_format,
+     libcerror_error_t **error );
+
+int logical_reader_free(
+     logical_reader_t **logical_reader,
+     libcerror_error_t **error );
+
+int logical_reader_signal_abort(
+     logical_reader_t *logical_reader,
+     libcerror_error_t **error );
+
+int logical_reader_join_path(
+     const char *directory_path,
+     size_t directory_path_length,
+     const char *name,
+     size_t name_length,
+     char **path,
+     size_t *path_length,
+     libcerror_error_t **error );
+
+int logical_reader_directory_initialize(
+     logical_reader_directory_t **directory,
+     const char *path,
+     size_t path_length,
+     libcerror_error_t **error );
+
+int logical_reader_directory_free(
+     logical_reader_directory_t **directory,
+     libcerror_error_t **error );
+
+int logical_reader_directory_compare_names(
+     const void *first_name,
+     const void *second_name );
+
+int logical_reader_directory_read(
+     logical_reader_directory_t *directory,
+     libcerror_error_t **error );
+
+int logical_reader_entry_initialize(
+     logical_reader_entry_t **entry,
+     const char *path,
+     size_t path_length,
+     size_t name_offset,
+     libcerror_error_t **error );
+
+int logical_reader_entry_free(
+     logical_reader_entry_t **entry,
+     libcerror_error_t **error );
+
+int logical_reader_push_directory(
+     logical_reader_t *logical_reader,
+     logical_reader_entry_t *entry,
+     libcerror_error_t **error );
+
+int logical_reader_get_next_entry(
+     logical_reader_t *logical_reader,
+     logical_reader_entry_t **entry,
+     libcerror_error_t **error );
+
+int logical_reader_append_entry(
+     logical_reader_t *logical_reader,
+     logical_reader_entry_t **entry,
+     libcerror_error_t **error );
+
+int logical_reader_open_entry(
+     logical_reader_t *logical_reader,
+     logical_reader_entry_t *entry,
+     libcerror_error_t **error );
+
+ssize_t logical_reader_read_entry_data(
+         logical_reader_t *logical_reader,
+         logical_reader_entry_t *entry,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+int logical_reader_close_entry(
+     logical_reader_t *logical_reader,
+     logical_reader_entry_t *entry,
+     libcerror_error_t **error );
+
+int logical_reader_spool_entry(
+     logical_reader_t *logical_reader,
+     logical_reader_entry_t *entry,
+     libcerror_error_t **error );
+
+int logical_reader_remove_first_entry(
+     logical_reader_t *logical_reader,
+     libcerror_error_t **error );
+
+ssize_t logical_reader_read_buffer(
+         logical_reader_t *logical_reader,
+         storage_media_buffer_t *storage_media_buffer,
+         libcerror_error_t **error );
+
+int logical_reader_append_ltree(
+     logical_reader_t *logical_reader,
+     imaging_handle_t *imaging_handle,
+     libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int logical_reader_start(
+     logical_reader_t *logical_reader,
+     storage_media_buffer_queue_t *storage_media_buffer_queue,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int logical_reader_claim_entry(
+     logical_reader_t *logical_reader,
+     logical_reader_entry_t **entry,
+     libcerror_error_t **error );
+
+int logical_reader_thread_function(
+     logical_reader_t *logical_reader );
+
+ssize_t logical_reader_get_buffer(
+         logical_reader_t *logical_reader,
+         storage_media_buffer_t **storage_media_buffer,
+         libcerror_error_t **error );
+
+int logical_reader_stop(
+     logical_reader_t *logical_reader,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LOGICAL_READER_H ) */
+
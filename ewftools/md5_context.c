@@ -0,0 +1,657 @@
+/*
+ * MD5 context functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <byte_stream.h>
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "md5_context.h"
+
+/* The MD5 initial hash values
+ */
+static const uint32_t md5_context_initial_hash_values[ 4 ] = {
+	0x67452301UL, 0xefcdab89UL, 0x98badcfeUL, 0x10325476UL };
+
+#define MD5_CONTEXT_F( x, y, z ) \
+	( ( z ) ^ ( ( x ) & ( ( y ) ^ ( z ) ) ) )
+
+#define MD5_CONTEXT_G( x, y, z ) \
+	( ( y ) ^ ( ( z ) & ( ( x ) ^ ( y ) ) ) )
+
+#define MD5_CONTEXT_H( x, y, z ) \
+	( ( x ) ^ ( y ) ^ ( z ) )
+
+#define MD5_CONTEXT_I( x, y, z ) \
+	( ( y ) ^ ( ( x ) | ~( z ) ) )
+
+#define MD5_CONTEXT_STEP( function, a, b, c, d, value, constant, shift ) \
+	a += function( b, c, d ) + value + constant; \
+	a  = ( ( a << shift ) | ( a >> ( 32 - shift ) ) ) + b;
+
+/* Creates a MD5 context
+ * Make sure the value context is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int md5_context_initialize(
+     md5_context_t **context,
+     libcerror_error_t **error )
+{
+	static char *function = "md5_context_initialize";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *context != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid context value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*context = memory_allocate_structure(
+	            md5_context_t );
+
+	if( *context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create context.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *context,
+	     0,
+	     sizeof( md5_context_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear context.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     ( *context )->hash_values,
+	     md5_context_initial_hash_values,
+	     sizeof( uint32_t ) * 4 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy initial hash values.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *context != NULL )
+	{
+		memory_free(
+		 *context );
+
+		*context = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a MD5 context
+ * Returns 1 if successful or -1 on error
+ */
+int md5_context_free(
+     md5_context_t **context,
+     libcerror_error_t **error )
+{
+	static char *function = "md5_context_free";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *context != NULL )
+	{
+		memory_free(
+		 *context );
+
+		*context = NULL;
+	}
+	return( 1 );
+}
+
+/* Updates the MD5 context
+ * Returns 1 if successful or -1 on error
+ */
+int md5_context_update(
+     md5_context_t *context,
+     const uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "md5_context_update";
+	size_t buffer_offset  = 0;
+	size_t copy_size      = 0;
+	size_t blocks_size    = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( context->block_data_size > 0 )
+	{
+		copy_size = MD5_CONTEXT_BLOCK_SIZE - context->block_data_size;
+
+		if( copy_size > size )
+		{
+			copy_size = size;
+		}
+		if( memory_copy(
+		     &( context->block[ context->block_data_size ] ),
+		     buffer,
+		     copy_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data to block.",
+			 function );
+
+			return( -1 );
+		}
+		context->block_data_size += copy_size;
+		buffer_offset            += copy_size;
+
+		if( context->block_data_size < MD5_CONTEXT_BLOCK_SIZE )
+		{
+			context->hash_count += size;
+
+			return( 1 );
+		}
+		md5_context_transform(
+		 context->hash_values,
+		 context->block,
+		 1 );
+
+		context->block_data_size = 0;
+	}
+	blocks_size = ( size - buffer_offset ) / MD5_CONTEXT_BLOCK_SIZE;
+
+	if( blocks_size > 0 )
+	{
+		md5_context_transform(
+		 context->hash_values,
+		 &( buffer[ buffer_offset ] ),
+		 blocks_size );
+
+		buffer_offset += blocks_size * MD5_CONTEXT_BLOCK_SIZE;
+	}
+	if( buffer_offset < size )
+	{
+		context->block_data_size = size - buffer_offset;
+
+		if( memory_copy(
+		     context->block,
+		     &( buffer[ buffer_offset ] ),
+		     context->block_data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data to block.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	context->hash_count += size;
+
+	return( 1 );
+}
+
+/* Finalizes the MD5 context
+ * Returns 1 if successful or -1 on error
+ */
+int md5_context_finalize(
+     md5_context_t *context,
+     uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error )
+{
+	/* The padding consists of a 0x80 byte followed by 0-byte values
+	 * and the number of bits hashed as a 64-bit little-endian value
+	 */
+	uint8_t padding[ 2 * MD5_CONTEXT_BLOCK_SIZE ];
+
+	static char *function = "md5_context_finalize";
+	uint64_t bit_count    = 0;
+	int hash_value_index  = 0;
+	int number_of_blocks  = 1;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( hash_size < (size_t) MD5_CONTEXT_HASH_SIZE )
+	 || ( hash_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid hash size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     padding,
+	     0,
+	     2 * MD5_CONTEXT_BLOCK_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear padding.",
+		 function );
+
+		return( -1 );
+	}
+	if( context->block_data_size > 0 )
+	{
+		if( memory_copy(
+		     padding,
+		     context->block,
+		     context->block_data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy block to padding.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	padding[ context->block_data_size ] = 0x80;
+
+	if( context->block_data_size >= ( MD5_CONTEXT_BLOCK_SIZE - 8 ) )
+	{
+		number_of_blocks = 2;
+	}
+	bit_count = context->hash_count * 8;
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( padding[ ( number_of_blocks * MD5_CONTEXT_BLOCK_SIZE ) - 8 ] ),
+	 bit_count );
+
+	md5_context_transform(
+	 context->hash_values,
+	 padding,
+	 (size_t) number_of_blocks );
+
+	for( hash_value_index = 0;
+	     hash_value_index < 4;
+	     hash_value_index++ )
+	{
+		byte_stream_copy_from_uint32_little_endian(
+		 &( hash[ hash_value_index * 4 ] ),
+		 context->hash_values[ hash_value_index ] );
+	}
+	return( 1 );
+}
+
+/* Retrieves the state of the MD5 context
+ * Returns 1 if successful or -1 on error
+ */
+int md5_context_get_state(
+     md5_context_t *context,
+     uint8_t *state,
+     size_t state_size,
+     libcerror_error_t **error )
+{
+	static char *function = "md5_context_get_state";
+	int hash_value_index  = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid state.",
+		 function );
+
+		return( -1 );
+	}
+	if( state_size != (size_t) MD5_CONTEXT_STATE_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid state size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	for( hash_value_index = 0;
+	     hash_value_index < 4;
+	     hash_value_index++ )
+	{
+		byte_stream_copy_from_uint32_little_endian(
+		 &( state[ hash_value_index * 4 ] ),
+		 context->hash_values[ hash_value_index ] );
+	}
+	byte_stream_copy_from_uint64_little_endian(
+	 &( state[ 16 ] ),
+	 context->hash_count );
+
+	if( memory_copy(
+	     &( state[ 24 ] ),
+	     context->block,
+	     MD5_CONTEXT_BLOCK_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy block to state.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the state of the MD5 context
+ * Returns 1 if successful or -1 on error
+ */
+int md5_context_set_state(
+     md5_context_t *context,
+     const uint8_t *state,
+     size_t state_size,
+     libcerror_error_t **error )
+{
+	static char *function = "md5_context_set_state";
+	int hash_value_index  = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid state.",
+		 function );
+
+		return( -1 );
+	}
+	if( state_size != (size_t) MD5_CONTEXT_STATE_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid state size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	for( hash_value_index = 0;
+	     hash_value_index < 4;
+	     hash_value_index++ )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 &( state[ hash_value_index * 4 ] ),
+		 context->hash_values[ hash_value_index ] );
+	}
+	byte_stream_copy_to_uint64_little_endian(
+	 &( state[ 16 ] ),
+	 context->hash_count );
+
+	if( memory_copy(
+	     context->block,
+	     &( state[ 24 ] ),
+	     MD5_CONTEXT_BLOCK_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy block from state.",
+		 function );
+
+		return( -1 );
+	}
+	context->block_data_size = (size_t) ( context->hash_count % MD5_CONTEXT_BLOCK_SIZE );
+
+	return( 1 );
+}
+
+/* Transforms the hash values with the 64-byte blocks
+ */
+void md5_context_transform(
+      uint32_t hash_values[ 4 ],
+      const uint8_t *blocks,
+      size_t number_of_blocks )
+{
+	uint32_t values[ 16 ];
+
+	uint32_t a      = 0;
+	uint32_t b      = 0;
+	uint32_t c      = 0;
+	uint32_t d      = 0;
+	int value_index = 0;
+
+	while( number_of_blocks > 0 )
+	{
+		for( value_index = 0;
+		     value_index < 16;
+		     value_index++ )
+		{
+			byte_stream_copy_to_uint32_little_endian(
+			 &( blocks[ value_index * 4 ] ),
+			 values[ value_index ] );
+		}
+		a = hash_values[ 0 ];
+		b = hash_values[ 1 ];
+		c = hash_values[ 2 ];
+		d = hash_values[ 3 ];
+
+		MD5_CONTEXT_STEP( MD5_CONTEXT_F, a, b, c, d, values[ 0 ], 0xd76aa478UL, 7 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_F, d, a, b, c, values[ 1 ], 0xe8c7b756UL, 12 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_F, c, d, a, b, values[ 2 ], 0x242070dbUL, 17 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_F, b, c, d, a, values[ 3 ], 0xc1bdceeeUL, 22 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_F, a, b, c, d, values[ 4 ], 0xf57c0fafUL, 7 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_F, d, a, b, c, values[ 5 ], 0x4787c62aUL, 12 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_F, c, d, a, b, values[ 6 ], 0xa8304613UL, 17 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_F, b, c, d, a, values[ 7 ], 0xfd469501UL, 22 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_F, a, b, c, d, values[ 8 ], 0x698098d8UL, 7 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_F, d, a, b, c, values[ 9 ], 0x8b44f7afUL, 12 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_F, c, d, a, b, values[ 10 ], 0xffff5bb1UL, 17 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_F, b, c, d, a, values[ 11 ], 0x895cd7beUL, 22 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_F, a, b, c, d, values[ 12 ], 0x6b901122UL, 7 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_F, d, a, b, c, values[ 13 ], 0xfd987193UL, 12 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_F, c, d, a, b, values[ 14 ], 0xa679438eUL, 17 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_F, b, c, d, a, values[ 15 ], 0x49b40821UL, 22 )
+
+		MD5_CONTEXT_STEP( MD5_CONTEXT_G, a, b, c, d, values[ 1 ], 0xf61e2562UL, 5 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_G, d, a, b, c, values[ 6 ], 0xc040b340UL, 9 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_G, c, d, a, b, values[ 11 ], 0x265e5a51UL, 14 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_G, b, c, d, a, values[ 0 ], 0xe9b6c7aaUL, 20 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_G, a, b, c, d, values[ 5 ], 0xd62f105dUL, 5 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_G, d, a, b, c, values[ 10 ], 0x02441453UL, 9 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_G, c, d, a, b, values[ 15 ], 0xd8a1e681UL, 14 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_G, b, c, d, a, values[ 4 ], 0xe7d3fbc8UL, 20 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_G, a, b, c, d, values[ 9 ], 0x21e1cde6UL, 5 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_G, d, a, b, c, values[ 14 ], 0xc33707d6UL, 9 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_G, c, d, a, b, values[ 3 ], 0xf4d50d87UL, 14 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_G, b, c, d, a, values[ 8 ], 0x455a14edUL, 20 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_G, a, b, c, d, values[ 13 ], 0xa9e3e905UL, 5 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_G, d, a, b, c, values[ 2 ], 0xfcefa3f8UL, 9 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_G, c, d, a, b, values[ 7 ], 0x676f02d9UL, 14 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_G, b, c, d, a, values[ 12 ], 0x8d2a4c8aUL, 20 )
+
+		MD5_CONTEXT_STEP( MD5_CONTEXT_H, a, b, c, d, values[ 5 ], 0xfffa3942UL, 4 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_H, d, a, b, c, values[ 8 ], 0x8771f681UL, 11 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_H, c, d, a, b, values[ 11 ], 0x6d9d6122UL, 16 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_H, b, c, d, a, values[ 14 ], 0xfde5380cUL, 23 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_H, a, b, c, d, values[ 1 ], 0xa4beea44UL, 4 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_H, d, a, b, c, values[ 4 ], 0x4bdecfa9UL, 11 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_H, c, d, a, b, values[ 7 ], 0xf6bb4b60UL, 16 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_H, b, c, d, a, values[ 10 ], 0xbebfbc70UL, 23 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_H, a, b, c, d, values[ 13 ], 0x289b7ec6UL, 4 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_H, d, a, b, c, values[ 0 ], 0xeaa127faUL, 11 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_H, c, d, a, b, values[ 3 ], 0xd4ef3085UL, 16 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_H, b, c, d, a, values[ 6 ], 0x04881d05UL, 23 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_H, a, b, c, d, values[ 9 ], 0xd9d4d039UL, 4 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_H, d, a, b, c, values[ 12 ], 0xe6db99e5UL, 11 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_H, c, d, a, b, values[ 15 ], 0x1fa27cf8UL, 16 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_H, b, c, d, a, values[ 2 ], 0xc4ac5665UL, 23 )
+
+		MD5_CONTEXT_STEP( MD5_CONTEXT_I, a, b, c, d, values[ 0 ], 0xf4292244UL, 6 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_I, d, a, b, c, values[ 7 ], 0x432aff97UL, 10 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_I, c, d, a, b, values[ 14 ], 0xab9423a7UL, 15 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_I, b, c, d, a, values[ 5 ], 0xfc93a039UL, 21 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_I, a, b, c, d, values[ 12 ], 0x655b59c3UL, 6 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_I, d, a, b, c, values[ 3 ], 0x8f0ccc92UL, 10 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_I, c, d, a, b, values[ 10 ], 0xffeff47dUL, 15 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_I, b, c, d, a, values[ 1 ], 0x85845dd1UL, 21 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_I, a, b, c, d, values[ 8 ], 0x6fa87e4fUL, 6 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_I, d, a, b, c, values[ 15 ], 0xfe2ce6e0UL, 10 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_I, c, d, a, b, values[ 6 ], 0xa3014314UL, 15 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_I, b, c, d, a, values[ 13 ], 0x4e0811a1UL, 21 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_I, a, b, c, d, values[ 4 ], 0xf7537e82UL, 6 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_I, d, a, b, c, values[ 11 ], 0xbd3af235UL, 10 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_I, c, d, a, b, values[ 2 ], 0x2ad7d2bbUL, 15 )
+		MD5_CONTEXT_STEP( MD5_CONTEXT_I, b, c, d, a, values[ 9 ], 0xeb86d391UL, 21 )
+
+		hash_values[ 0 ] += a;
+		hash_values[ 1 ] += b;
+		hash_values[ 2 ] += c;
+		hash_values[ 3 ] += d;
+
+		blocks           += MD5_CONTEXT_BLOCK_SIZE;
+		number_of_blocks -= 1;
+	}
+}
+
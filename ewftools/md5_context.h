@@ -0,0 +1,109 @@
+/*
+ * MD5 context functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _MD5_CONTEXT_H )
+#define _MD5_CONTEXT_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#define MD5_CONTEXT_BLOCK_SIZE		64
+
+#define MD5_CONTEXT_HASH_SIZE		16
+
+/* The size of the state, which consists of the hash values,
+ * the number of bytes hashed and the block
+ */
+#define MD5_CONTEXT_STATE_SIZE		( 16 + 8 + MD5_CONTEXT_BLOCK_SIZE )
+
+typedef struct md5_context md5_context_t;
+
+/* The MD5 context calculates the MD5 without libhmac so that the state
+ * of the calculation can be stored and restored, such as by a restart checkpoint
+ */
+struct md5_context
+{
+	/* The hash values
+	 */
+	uint32_t hash_values[ 4 ];
+
+	/* The block
+	 */
+	uint8_t block[ MD5_CONTEXT_BLOCK_SIZE ];
+
+	/* The size of the data in the block
+	 */
+	size_t block_data_size;
+
+	/* The number of bytes hashed
+	 */
+	uint64_t hash_count;
+};
+
+int md5_context_initialize(
+     md5_context_t **context,
+     libcerror_error_t **error );
+
+int md5_context_free(
+     md5_context_t **context,
+     libcerror_error_t **error );
+
+int md5_context_update(
+     md5_context_t *context,
+     const uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error );
+
+int md5_context_finalize(
+     md5_context_t *context,
+     uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error );
+
+int md5_context_get_state(
+     md5_context_t *context,
+     uint8_t *state,
+     size_t state_size,
+     libcerror_error_t **error );
+
+int md5_context_set_state(
+     md5_context_t *context,
+     const uint8_t *state,
+     size_t state_size,
+     libcerror_error_t **error );
+
+void md5_context_transform(
+      uint32_t hash_values[ 4 ],
+      const uint8_t *blocks,
+      size_t number_of_blocks );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _MD5_CONTEXT_H ) */
+
@@ -0,0 +1,568 @@
+/*
+ * Mount attribute cache
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "mount_attribute_cache.h"
+
+/* Creates a mount attribute cache
+ * Make sure the value attribute_cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int mount_attribute_cache_initialize(
+     mount_attribute_cache_t **attribute_cache,
+     int number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_attribute_cache_initialize";
+	size_t entries_size   = 0;
+
+	if( attribute_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid attribute cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *attribute_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid attribute cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_entries <= 0 )
+	 || ( (size_t) number_of_entries > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( mount_attribute_cache_entry_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	entries_size = sizeof( mount_attribute_cache_entry_t ) * number_of_entries;
+
+	*attribute_cache = memory_allocate_structure(
+	                    mount_attribute_cache_t );
+
+	if( *attribute_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create attribute cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *attribute_cache,
+	     0,
+	     sizeof( mount_attribute_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear attribute cache.",
+		 function );
+
+		memory_free(
+		 *attribute_cache );
+
+		*attribute_cache = NULL;
+
+		return( -1 );
+	}
+	( *attribute_cache )->entries = (mount_attribute_cache_entry_t *) memory_allocate(
+	                                                                   entries_size );
+
+	if( ( *attribute_cache )->entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *attribute_cache )->entries,
+	     0,
+	     entries_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entries.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *attribute_cache )->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *attribute_cache )->number_of_entries = number_of_entries;
+
+	return( 1 );
+
+on_error:
+	if( *attribute_cache != NULL )
+	{
+		if( ( *attribute_cache )->entries != NULL )
+		{
+			memory_free(
+			 ( *attribute_cache )->entries );
+		}
+		memory_free(
+		 *attribute_cache );
+
+		*attribute_cache = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a mount attribute cache
+ * Returns 1 if successful or -1 on error
+ */
+int mount_attribute_cache_free(
+     mount_attribute_cache_t **attribute_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_attribute_cache_free";
+	int entry_index       = 0;
+	int result            = 1;
+
+	if( attribute_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid attribute cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *attribute_cache != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_free(
+		     &( ( *attribute_cache )->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		for( entry_index = 0;
+		     entry_index < ( *attribute_cache )->number_of_entries;
+		     entry_index++ )
+		{
+			if( ( *attribute_cache )->entries[ entry_index ].path != NULL )
+			{
+				memory_free(
+				 ( *attribute_cache )->entries[ entry_index ].path );
+			}
+		}
+		memory_free(
+		 ( *attribute_cache )->entries );
+
+		memory_free(
+		 *attribute_cache );
+
+		*attribute_cache = NULL;
+	}
+	return( result );
+}
+
+/* Determines the identifier of a path
+ * The identifier is the 64-bit FNV-1a hash of the characters of the path
+ * Returns 1 if successful or -1 on error
+ */
+int mount_attribute_cache_get_identifier_from_path(
+     const system_character_t *path,
+     size_t path_length,
+     uint64_t *identifier,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_attribute_cache_get_identifier_from_path";
+	uint64_t hash         = 0xcbf29ce484222325ULL;
+	size_t path_index     = 0;
+
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		return( -1 );
+	}
+	if( identifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid identifier.",
+		 function );
+
+		return( -1 );
+	}
+	for( path_index = 0;
+	     path_index < path_length;
+	     path_index++ )
+	{
+		hash ^= (uint64_t) path[ path_index ];
+		hash *= 0x100000001b3ULL;
+	}
+	*identifier = hash;
+
+	return( 1 );
+}
+
+/* Retrieves the attribute values of a specific path
+ * Returns 1 if successful, 0 if the path is not in the cache or -1 on error
+ */
+int mount_attribute_cache_get_values(
+     mount_attribute_cache_t *attribute_cache,
+     const system_character_t *path,
+     size_t path_length,
+     size64_t *size,
+     uint16_t *file_mode,
+     uint64_t *creation_time,
+     uint64_t *access_time,
+     uint64_t *modification_time,
+     uint64_t *inode_change_time,
+     libcerror_error_t **error )
+{
+	mount_attribute_cache_entry_t *entry = NULL;
+	static char *function                = "mount_attribute_cache_get_values";
+	uint64_t identifier                  = 0;
+	int result                           = 0;
+
+	if( attribute_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid attribute cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_mode == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( creation_time == NULL )
+	 || ( access_time == NULL )
+	 || ( modification_time == NULL )
+	 || ( inode_change_time == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid date and time values.",
+		 function );
+
+		return( -1 );
+	}
+	if( mount_attribute_cache_get_identifier_from_path(
+	     path,
+	     path_length,
+	     &identifier,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine identifier from path.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     attribute_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	entry = &( attribute_cache->entries[ identifier % (uint64_t) attribute_cache->number_of_entries ] );
+
+	if( ( entry->path != NULL )
+	 && ( entry->identifier == identifier )
+	 && ( entry->path_size == ( path_length + 1 ) ) )
+	{
+		if( system_string_compare(
+		     entry->path,
+		     path,
+		     path_length ) == 0 )
+		{
+			*size              = entry->size;
+			*file_mode         = entry->file_mode;
+			*creation_time     = entry->creation_time;
+			*access_time       = entry->access_time;
+			*modification_time = entry->modification_time;
+			*inode_change_time = entry->inode_change_time;
+
+			result = 1;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     attribute_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the attribute values of a specific path
+ * The values replace those of the path that was previously stored in the same entry
+ * Returns 1 if successful or -1 on error
+ */
+int mount_attribute_cache_set_values(
+     mount_attribute_cache_t *attribute_cache,
+     const system_character_t *path,
+     size_t path_length,
+     size64_t size,
+     uint16_t file_mode,
+     uint64_t creation_time,
+     uint64_t access_time,
+     uint64_t modification_time,
+     uint64_t inode_change_time,
+     libcerror_error_t **error )
+{
+	mount_attribute_cache_entry_t *entry = NULL;
+	system_character_t *entry_path       = NULL;
+	static char *function                = "mount_attribute_cache_set_values";
+	uint64_t identifier                  = 0;
+
+	if( attribute_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid attribute cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( path_length > (size_t) ( ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( system_character_t ) ) - 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid path length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( mount_attribute_cache_get_identifier_from_path(
+	     path,
+	     path_length,
+	     &identifier,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine identifier from path.",
+		 function );
+
+		return( -1 );
+	}
+	/* The path is copied before the lock is grabbed to keep the time the lock is held short
+	 */
+	entry_path = system_string_allocate(
+	              path_length + 1 );
+
+	if( entry_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create path.",
+		 function );
+
+		return( -1 );
+	}
+	if( system_string_copy(
+	     entry_path,
+	     path,
+	     path_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy path.",
+		 function );
+
+		goto on_error;
+	}
+	entry_path[ path_length ] = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     attribute_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	entry = &( attribute_cache->entries[ identifier % (uint64_t) attribute_cache->number_of_entries ] );
+
+	if( entry->path != NULL )
+	{
+		memory_free(
+		 entry->path );
+	}
+	entry->identifier        = identifier;
+	entry->path              = entry_path;
+	entry->path_size         = path_length + 1;
+	entry->size              = size;
+	entry->file_mode         = file_mode;
+	entry->creation_time     = creation_time;
+	entry->access_time       = access_time;
+	entry->modification_time = modification_time;
+	entry->inode_change_time = inode_change_time;
+
+	entry_path = NULL;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     attribute_cache->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( entry_path != NULL )
+	{
+		memory_free(
+		 entry_path );
+	}
+	return( -1 );
+}
+
@@ -0,0 +1,144 @@
+/*
+ * Mount attribute cache
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _MOUNT_ATTRIBUTE_CACHE_H )
+#define _MOUNT_ATTRIBUTE_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct mount_attribute_cache_entry mount_attribute_cache_entry_t;
+
+struct mount_attribute_cache_entry
+{
+	/* The identifier, which is the hash of the path
+	 */
+	uint64_t identifier;
+
+	/* The path
+	 */
+	system_character_t *path;
+
+	/* The path size
+	 */
+	size_t path_size;
+
+	/* The size
+	 */
+	size64_t size;
+
+	/* The file mode
+	 */
+	uint16_t file_mode;
+
+	/* The creation date and time
+	 */
+	uint64_t creation_time;
+
+	/* The access date and time
+	 */
+	uint64_t access_time;
+
+	/* The modification date and time
+	 */
+	uint64_t modification_time;
+
+	/* The inode change date and time
+	 */
+	uint64_t inode_change_time;
+};
+
+typedef struct mount_attribute_cache mount_attribute_cache_t;
+
+/* The mount attribute cache retains the attributes of resolved paths, since
+ * the image is immutable the attributes of a path never change
+ * The entries are indexed by the identifier of the path, where an entry is
+ * replaced by the path that maps onto the same entry
+ */
+struct mount_attribute_cache
+{
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The entries
+	 */
+	mount_attribute_cache_entry_t *entries;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
+};
+
+int mount_attribute_cache_initialize(
+     mount_attribute_cache_t **attribute_cache,
+     int number_of_entries,
+     libcerror_error_t **error );
+
+int mount_attribute_cache_free(
+     mount_attribute_cache_t **attribute_cache,
+     libcerror_error_t **error );
+
+int mount_attribute_cache_get_identifier_from_path(
+     const system_character_t *path,
+     size_t path_length,
+     uint64_t *identifier,
+     libcerror_error_t **error );
+
+int mount_attribute_cache_get_values(
+     mount_attribute_cache_t *attribute_cache,
+     const system_character_t *path,
+     size_t path_length,
+     size64_t *size,
+     uint16_t *file_mode,
+     uint64_t *creation_time,
+     uint64_t *access_time,
+     uint64_t *modification_time,
+     uint64_t *inode_change_time,
+     libcerror_error_t **error );
+
+int mount_attribute_cache_set_values(
+     mount_attribute_cache_t *attribute_cache,
+     const system_character_t *path,
+     size_t path_length,
+     size64_t size,
+     uint16_t file_mode,
+     uint64_t creation_time,
+     uint64_t access_time,
+     uint64_t modification_time,
+     uint64_t inode_change_time,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _MOUNT_ATTRIBUTE_CACHE_H ) */
+
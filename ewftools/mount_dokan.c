@@ -171,39 +171,6 @@ int mount_dokan_filldir(
 	uint64_t modification_time = 0;
 	uint16_t file_mode         = 0;
 
-	if( fill_find_data == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid fill find data.",
-		 function );
-
-		return( -1 );
-	}
-	if( name == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid name.",
-		 function );
-
-		return( -1 );
-	}
-	if( name_size > (size_t) MAX_PATH )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid name size value out of bounds.",
-		 function );
-
-		return( -1 );
-	}
 	if( file_entry != NULL )
 	{
 		if( mount_file_entry_get_size(
@@ -277,6 +244,71 @@ int mount_dokan_filldir(
 			return( -1 );
 		}
 	}
+	return( mount_dokan_filldir_values(
+	         fill_find_data,
+	         file_info,
+	         name,
+	         name_size,
+	         find_data,
+	         file_size,
+	         file_mode,
+	         creation_time,
+	         access_time,
+	         modification_time,
+	         error ) );
+}
+
+/* Fills a directory entry from its values
+ * Returns 1 if successful or -1 on error
+ */
+int mount_dokan_filldir_values(
+     PFillFindData fill_find_data,
+     DOKAN_FILE_INFO *file_info,
+     wchar_t *name,
+     size_t name_size,
+     WIN32_FIND_DATAW *find_data,
+     size64_t file_size,
+     uint16_t file_mode,
+     uint64_t creation_time,
+     uint64_t access_time,
+     uint64_t modification_time,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_dokan_filldir_values";
+
+	if( fill_find_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fill find data.",
+		 function );
+
+		return( -1 );
+	}
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( name_size > (size_t) MAX_PATH )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid name size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
 	if( memory_set(
 	     find_data,
 	     0,
@@ -948,11 +980,15 @@ NTSTATUS __stdcall mount_dokan_FindFiles(
 	libcerror_error_t *error              = NULL;
 	mount_file_entry_t *file_entry        = NULL;
 	mount_file_entry_t *parent_file_entry = NULL;
-	mount_file_entry_t *sub_file_entry    = NULL;
 	wchar_t *name                         = NULL;
 	static char *function                 = "mount_dokan_FindFiles";
 	size_t name_size                      = 0;
-	int number_of_sub_file_entries        = 0;
+	size64_t file_size                    = 0;
+	uint64_t access_time                  = 0;
+	uint64_t creation_time                = 0;
+	uint64_t inode_change_time            = 0;
+	uint64_t modification_time            = 0;
+	uint16_t file_mode                    = 0;
 	int result                            = 0;
 	int sub_file_entry_index              = 0;
 
@@ -1069,37 +1105,28 @@ NTSTATUS __stdcall mount_dokan_FindFiles(
 
 		goto on_error;
 	}
-	if( mount_file_entry_get_number_of_sub_file_entries(
-	     file_entry,
-	     &number_of_sub_file_entries,
-	     &error ) != 1 )
-	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of sub file entries.",
-		 function );
-
-		result = MOUNT_DOKAN_ERROR_GENERIC_FAILURE;
-
-		goto on_error;
-	}
-	for( sub_file_entry_index = 0;
-	     sub_file_entry_index < number_of_sub_file_entries;
-	     sub_file_entry_index++ )
-	{
-		if( mount_file_entry_get_sub_file_entry_by_index(
-		     file_entry,
-		     sub_file_entry_index,
-		     &sub_file_entry,
-		     &error ) != 1 )
+	do
+	{
+		result = mount_file_entry_get_sub_file_entry_values_by_index(
+		          file_entry,
+		          sub_file_entry_index,
+		          &name,
+		          &name_size,
+		          &file_size,
+		          &file_mode,
+		          &creation_time,
+		          &access_time,
+		          &modification_time,
+		          &inode_change_time,
+		          &error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve sub file entry: %d.",
+			 "%s: unable to retrieve sub file entry: %d values.",
 			 function,
 			 sub_file_entry_index );
 
@@ -1107,100 +1134,43 @@ NTSTATUS __stdcall mount_dokan_FindFiles(
 
 			goto on_error;
 		}
-		if( mount_file_entry_get_name_size(
-		     sub_file_entry,
-		     &name_size,
-		     &error ) != 1 )
+		else if( result != 0 )
 		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve sub file entry: %d name size.",
-			 function,
-			 sub_file_entry_index );
-
-			result = MOUNT_DOKAN_ERROR_GENERIC_FAILURE;
-
-			goto on_error;
-		}
-		name = wide_string_allocate(
-		        name_size );
-
-		if( name == NULL )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-			 "%s: unable to create sub file entry: %d name.",
-			 function );
-
-			result = MOUNT_DOKAN_ERROR_GENERIC_FAILURE;
-
-			goto on_error;
-		}
-		if( mount_file_entry_get_name(
-		     sub_file_entry,
-		     name,
-		     name_size,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve sub file entry: %d name.",
-			 function,
-			 sub_file_entry_index );
-
-			result = MOUNT_DOKAN_ERROR_GENERIC_FAILURE;
-
-			goto on_error;
-		}
-		if( mount_dokan_filldir(
-		     fill_find_data,
-		     file_info,
-		     name,
-		     name_size,
-		     &find_data,
-		     sub_file_entry,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set find data for sub file entry: %d.",
-			 function,
-			 sub_file_entry_index );
-
-			result = MOUNT_DOKAN_ERROR_GENERIC_FAILURE;
-
-			goto on_error;
-		}
-		memory_free(
-		 name );
-
-		name = NULL;
-
-		if( mount_file_entry_free(
-		     &sub_file_entry,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free sub file entry: %d.",
-			 function,
-			 sub_file_entry_index );
-
-			result = MOUNT_DOKAN_ERROR_GENERIC_FAILURE;
-
-			goto on_error;
+			if( mount_dokan_filldir_values(
+			     fill_find_data,
+			     file_info,
+			     name,
+			     name_size,
+			     &find_data,
+			     file_size,
+			     file_mode,
+			     creation_time,
+			     access_time,
+			     modification_time,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set find data for sub file entry: %d.",
+				 function,
+				 sub_file_entry_index );
+
+				result = MOUNT_DOKAN_ERROR_GENERIC_FAILURE;
+
+				goto on_error;
+			}
+			memory_free(
+			 name );
+
+			name = NULL;
+
+			sub_file_entry_index++;
 		}
 	}
+	while( result != 0 );
+
 	if( mount_file_entry_free(
 	     &file_entry,
 	     &error ) != 1 )
@@ -1231,12 +1201,6 @@ on_error:
 		memory_free(
 		 name );
 	}
-	if( sub_file_entry != NULL )
-	{
-		mount_file_entry_free(
-		 &sub_file_entry,
-		 NULL );
-	}
 	if( parent_file_entry != NULL )
 	{
 		mount_file_entry_free(
@@ -1267,15 +1231,15 @@ NTSTATUS __stdcall mount_dokan_GetFileInformation(
                     DOKAN_FILE_INFO *file_info EWFTOOLS_ATTRIBUTE_UNUSED )
 #endif
 {
-	libcerror_error_t *error       = NULL;
-	mount_file_entry_t *file_entry = NULL;
-	static char *function          = "mount_dokan_GetFileInformation";
-	size64_t file_size             = 0;
-	uint64_t access_time           = 0;
-	uint64_t creation_time         = 0;
-	uint64_t modification_time     = 0;
-	uint16_t file_mode             = 0;
-	int result                     = 0;
+	libcerror_error_t *error   = NULL;
+	static char *function      = "mount_dokan_GetFileInformation";
+	size64_t file_size         = 0;
+	uint64_t access_time       = 0;
+	uint64_t creation_time     = 0;
+	uint64_t inode_change_time = 0;
+	uint64_t modification_time = 0;
+	uint16_t file_mode         = 0;
+	int result                 = 0;
 
 	EWFTOOLS_UNREFERENCED_PARAMETER( file_info )
 
@@ -1301,17 +1265,24 @@ NTSTATUS __stdcall mount_dokan_GetFileInformation(
 
 		goto on_error;
 	}
-	if( mount_handle_get_file_entry_by_path(
+	/* The attribute values are cached per path since the image is immutable
+	 */
+	if( mount_handle_get_file_entry_values_by_path(
 	     ewfmount_mount_handle,
 	     path,
-	     &file_entry,
+	     &file_size,
+	     &file_mode,
+	     &creation_time,
+	     &access_time,
+	     &modification_time,
+	     &inode_change_time,
 	     &error ) != 1 )
 	{
 		libcerror_error_set(
 		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve file entry for path: %ls.",
+		 "%s: unable to retrieve file entry values for path: %ls.",
 		 function,
 		 path );
 
@@ -1319,89 +1290,6 @@ NTSTATUS __stdcall mount_dokan_GetFileInformation(
 
 		goto on_error;
 	}
-	if( file_entry != NULL )
-	{
-		if( mount_file_entry_get_size(
-		     file_entry,
-		     &file_size,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve file entry size.",
-			 function );
-
-			result = MOUNT_DOKAN_ERROR_GENERIC_FAILURE;
-
-			goto on_error;
-		}
-		if( mount_file_entry_get_file_mode(
-		     file_entry,
-		     &file_mode,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve file mode.",
-			 function );
-
-			result = MOUNT_DOKAN_ERROR_GENERIC_FAILURE;
-
-			goto on_error;
-		}
-		if( mount_file_entry_get_creation_time(
-		     file_entry,
-		     &creation_time,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve creation time.",
-			 function );
-
-			result = MOUNT_DOKAN_ERROR_GENERIC_FAILURE;
-
-			goto on_error;
-		}
-		if( mount_file_entry_get_access_time(
-		     file_entry,
-		     &access_time,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve access time.",
-			 function );
-
-			result = MOUNT_DOKAN_ERROR_GENERIC_FAILURE;
-
-			goto on_error;
-		}
-		if( mount_file_entry_get_modification_time(
-		     file_entry,
-		     &modification_time,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve modification time.",
-			 function );
-
-			result = MOUNT_DOKAN_ERROR_GENERIC_FAILURE;
-
-			goto on_error;
-		}
-	}
 	if( mount_dokan_set_file_information(
 	     file_information,
 	     file_size,
@@ -1422,21 +1310,6 @@ NTSTATUS __stdcall mount_dokan_GetFileInformation(
 
 		goto on_error;
 	}
-	if( mount_file_entry_free(
-	     &file_entry,
-	     &error ) != 1 )
-	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free file entry.",
-		 function );
-
-		result = MOUNT_DOKAN_ERROR_GENERIC_FAILURE;
-
-		goto on_error;
-	}
 	return( 0 );
 
 on_error:
@@ -1447,12 +1320,6 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( file_entry != NULL )
-	{
-		mount_file_entry_free(
-		 &file_entry,
-		 NULL );
-	}
 	return( result );
 }
 
@@ -66,6 +66,19 @@ int mount_dokan_filldir(
      mount_file_entry_t *file_entry,
      libcerror_error_t **error );
 
+int mount_dokan_filldir_values(
+     PFillFindData fill_find_data,
+     DOKAN_FILE_INFO *file_info,
+     wchar_t *name,
+     size_t name_size,
+     WIN32_FIND_DATAW *find_data,
+     size64_t file_size,
+     uint16_t file_mode,
+     uint64_t creation_time,
+     uint64_t access_time,
+     uint64_t modification_time,
+     libcerror_error_t **error );
+
 #if ( DOKAN_VERSION >= 600 ) && ( DOKAN_VERSION < 800 )
 
 int __stdcall mount_dokan_CreateFile(
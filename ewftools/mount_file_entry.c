@@ -34,6 +34,7 @@
 #include "ewftools_libewf.h"
 #include "mount_file_entry.h"
 #include "mount_file_system.h"
+#include "mount_overlay.h"
 
 #if !defined( S_IFDIR )
 #define S_IFDIR 0x4000
@@ -205,6 +206,7 @@ int mount_file_entry_free(
      libcerror_error_t **error )
 {
 	static char *function = "mount_file_entry_free";
+	int result            = 1;
 
 	if( file_entry == NULL )
 	{
@@ -219,6 +221,22 @@ int mount_file_entry_free(
 	}
 	if( *file_entry != NULL )
 	{
+		if( ( *file_entry )->sub_file_entry_iterator != NULL )
+		{
+			if( libewf_file_entry_iterator_free(
+			     &( ( *file_entry )->sub_file_entry_iterator ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free sub file entry iterator.",
+				 function );
+
+				result = -1;
+			}
+		}
 		if( ( *file_entry )->name != NULL )
 		{
 			memory_free(
@@ -229,7 +247,7 @@ int mount_file_entry_free(
 
 		*file_entry = NULL;
 	}
-	return( 1 );
+	return( result );
 }
 
 /* Retrieves the parent file entry
@@ -649,6 +667,11 @@ int mount_file_entry_get_file_mode(
 		{
 			*file_mode = S_IFDIR | 0555;
 		}
+		else if( ( file_entry->file_system != NULL )
+		      && ( file_entry->file_system->overlay != NULL ) )
+		{
+			*file_mode = S_IFREG | 0644;
+		}
 		else
 		{
 			*file_mode = S_IFREG | 0444;
@@ -1089,18 +1112,72 @@ on_error:
 	return( -1 );
 }
 
-/* Reads data at a specific offset
- * Returns the number of bytes read or -1 on error
+/* Converts a POSIX timestamp into a timestamp
+ * On Windows the timestamp is an unsigned 64-bit FILETIME timestamp
+ * otherwise the timestamp is a signed 64-bit POSIX date and time value in number of nanoseconds
+ * Returns 1 if successful or -1 on error
  */
-ssize_t mount_file_entry_read_buffer_at_offset(
-         mount_file_entry_t *file_entry,
-         void *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         libcerror_error_t **error )
+int mount_file_entry_get_timestamp_from_posix_time(
+     int32_t posix_time,
+     uint64_t *timestamp,
+     libcerror_error_t **error )
 {
-	static char *function = "mount_file_entry_read_buffer_at_offset";
-	ssize_t read_count    = 0;
+	static char *function = "mount_file_entry_get_timestamp_from_posix_time";
+
+	if( timestamp == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid timestamp.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	*timestamp = 0;
+
+	if( posix_time != 0 )
+	{
+		/* Convert the POSIX nanoseconds timestamp into a FILETIME timestamp
+		 */
+		*timestamp = (uint64_t) ( ( (int64_t) posix_time * 10000000 ) + 116444736000000000L );
+	}
+#else
+	*timestamp = (uint64_t) posix_time * 1000000000;
+#endif
+	return( 1 );
+}
+
+/* Retrieves the name and attribute values of a specific sub file entry
+ * For a file entry the values are read by a sub file entry iterator, without
+ * creating a sub file entry, that continues from the previously retrieved
+ * sub file entry, hence retrieving the sub file entries in order is linear
+ * The name is allocated and should be freed by the caller
+ * Returns 1 if successful, 0 if no such sub file entry or -1 on error
+ */
+int mount_file_entry_get_sub_file_entry_values_by_index(
+     mount_file_entry_t *file_entry,
+     int sub_file_entry_index,
+     system_character_t **name,
+     size_t *name_size,
+     size64_t *size,
+     uint16_t *file_mode,
+     uint64_t *creation_time,
+     uint64_t *access_time,
+     uint64_t *modification_time,
+     uint64_t *inode_change_time,
+     libcerror_error_t **error )
+{
+	mount_file_entry_t *sub_file_entry = NULL;
+	system_character_t *entry_name     = NULL;
+	static char *function              = "mount_file_entry_get_sub_file_entry_values_by_index";
+	size_t entry_name_size             = 0;
+	int32_t posix_time                 = 0;
+	int iterator_index                 = 0;
+	int number_of_sub_file_entries     = 0;
+	int result                         = 0;
 
 	if( file_entry == NULL )
 	{
@@ -1113,53 +1190,823 @@ ssize_t mount_file_entry_read_buffer_at_offset(
 
 		return( -1 );
 	}
-	if( file_entry->type == MOUNT_FILE_ENTRY_TYPE_FILE_ENTRY )
+	if( sub_file_entry_index < 0 )
 	{
-		read_count = libewf_file_entry_read_buffer_at_offset(
-		              file_entry->ewf_file_entry,
-			      buffer,
-			      buffer_size,
-			      offset,
-			      error );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid sub file entry index value less than zero.",
+		 function );
 
-		if( read_count < 0 )
+		return( -1 );
+	}
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( *name != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid name value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( name_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name size.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_mode == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_entry->type != MOUNT_FILE_ENTRY_TYPE_FILE_ENTRY )
+	{
+		if( mount_file_entry_get_number_of_sub_file_entries(
+		     file_entry,
+		     &number_of_sub_file_entries,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ") from file entry.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of sub file entries.",
+			 function );
+
+			goto on_error;
+		}
+		if( sub_file_entry_index >= number_of_sub_file_entries )
+		{
+			return( 0 );
+		}
+		if( mount_file_entry_get_sub_file_entry_by_index(
+		     file_entry,
+		     sub_file_entry_index,
+		     &sub_file_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sub file entry: %d.",
 			 function,
-			 offset,
-			 offset );
+			 sub_file_entry_index );
 
-			return( -1 );
+			goto on_error;
 		}
-	}
-	else
-	{
-		read_count = libewf_handle_read_buffer_at_offset(
-		              file_entry->ewf_handle,
-		              buffer,
-		              buffer_size,
-		              offset,
-		              error );
+		if( mount_file_entry_get_name_size(
+		     sub_file_entry,
+		     name_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sub file entry: %d name size.",
+			 function,
+			 sub_file_entry_index );
 
-		if( read_count < 0 )
+			goto on_error;
+		}
+		*name = system_string_allocate(
+		         *name_size );
+
+		if( *name == NULL )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ") from handle.",
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create name.",
+			 function );
+
+			goto on_error;
+		}
+		if( mount_file_entry_get_name(
+		     sub_file_entry,
+		     *name,
+		     *name_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sub file entry: %d name.",
 			 function,
-			 offset,
-			 offset );
+			 sub_file_entry_index );
 
-			return( -1 );
+			goto on_error;
 		}
-	}
-	return( read_count );
+		if( mount_file_entry_get_size(
+		     sub_file_entry,
+		     size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sub file entry: %d size.",
+			 function,
+			 sub_file_entry_index );
+
+			goto on_error;
+		}
+		if( mount_file_entry_get_file_mode(
+		     sub_file_entry,
+		     file_mode,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sub file entry: %d file mode.",
+			 function,
+			 sub_file_entry_index );
+
+			goto on_error;
+		}
+		if( mount_file_entry_get_creation_time(
+		     sub_file_entry,
+		     creation_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sub file entry: %d creation time.",
+			 function,
+			 sub_file_entry_index );
+
+			goto on_error;
+		}
+		if( mount_file_entry_get_access_time(
+		     sub_file_entry,
+		     access_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sub file entry: %d access time.",
+			 function,
+			 sub_file_entry_index );
+
+			goto on_error;
+		}
+		if( mount_file_entry_get_modification_time(
+		     sub_file_entry,
+		     modification_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sub file entry: %d modification time.",
+			 function,
+			 sub_file_entry_index );
+
+			goto on_error;
+		}
+		if( mount_file_entry_get_inode_change_time(
+		     sub_file_entry,
+		     inode_change_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sub file entry: %d inode change time.",
+			 function,
+			 sub_file_entry_index );
+
+			goto on_error;
+		}
+		if( mount_file_entry_free(
+		     &sub_file_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free sub file entry: %d.",
+			 function,
+			 sub_file_entry_index );
+
+			goto on_error;
+		}
+		return( 1 );
+	}
+	if( file_entry->sub_file_entry_iterator == NULL )
+	{
+		if( libewf_file_entry_get_sub_file_entry_iterator(
+		     file_entry->ewf_file_entry,
+		     &( file_entry->sub_file_entry_iterator ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sub file entry iterator.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_file_entry_iterator_get_index(
+	     file_entry->sub_file_entry_iterator,
+	     &iterator_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve sub file entry iterator index.",
+		 function );
+
+		goto on_error;
+	}
+	/* The iterator only moves forward hence it is restarted for a preceding sub file entry
+	 */
+	if( sub_file_entry_index < iterator_index )
+	{
+		if( libewf_file_entry_iterator_reset(
+		     file_entry->sub_file_entry_iterator,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to reset sub file entry iterator.",
+			 function );
+
+			goto on_error;
+		}
+		iterator_index = -1;
+	}
+	while( iterator_index < sub_file_entry_index )
+	{
+		result = libewf_file_entry_iterator_next(
+		          file_entry->sub_file_entry_iterator,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to move sub file entry iterator to next sub file entry.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
+		iterator_index++;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libewf_file_entry_iterator_get_utf16_name_size(
+	          file_entry->sub_file_entry_iterator,
+	          &entry_name_size,
+	          error );
+#else
+	result = libewf_file_entry_iterator_get_utf8_name_size(
+	          file_entry->sub_file_entry_iterator,
+	          &entry_name_size,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve sub file entry: %d name size.",
+		 function,
+		 sub_file_entry_index );
+
+		goto on_error;
+	}
+	if( ( entry_name_size == 0 )
+	 || ( entry_name_size > SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid sub file entry: %d name size value out of bounds.",
+		 function,
+		 sub_file_entry_index );
+
+		goto on_error;
+	}
+	entry_name = system_string_allocate(
+	              entry_name_size );
+
+	if( entry_name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create sub file entry name.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libewf_file_entry_iterator_get_utf16_name(
+	          file_entry->sub_file_entry_iterator,
+	          (uint16_t *) entry_name,
+	          entry_name_size,
+	          error );
+#else
+	result = libewf_file_entry_iterator_get_utf8_name(
+	          file_entry->sub_file_entry_iterator,
+	          (uint8_t *) entry_name,
+	          entry_name_size,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve sub file entry: %d name.",
+		 function,
+		 sub_file_entry_index );
+
+		goto on_error;
+	}
+	if( mount_file_system_get_filename_from_name(
+	     file_entry->file_system,
+	     entry_name,
+	     entry_name_size - 1,
+	     name,
+	     name_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve a filename from the sub file entry: %d name.",
+		 function,
+		 sub_file_entry_index );
+
+		goto on_error;
+	}
+	memory_free(
+	 entry_name );
+
+	entry_name = NULL;
+
+	if( libewf_file_entry_iterator_get_size(
+	     file_entry->sub_file_entry_iterator,
+	     size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve sub file entry: %d size.",
+		 function,
+		 sub_file_entry_index );
+
+		goto on_error;
+	}
+	if( libewf_file_entry_iterator_get_number_of_sub_file_entries(
+	     file_entry->sub_file_entry_iterator,
+	     &number_of_sub_file_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve sub file entry: %d number of sub file entries.",
+		 function,
+		 sub_file_entry_index );
+
+		goto on_error;
+	}
+	if( number_of_sub_file_entries != 0 )
+	{
+		*file_mode = S_IFDIR | 0555;
+	}
+	else
+	{
+		*file_mode = S_IFREG | 0444;
+	}
+	if( libewf_file_entry_iterator_get_creation_time(
+	     file_entry->sub_file_entry_iterator,
+	     &posix_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve sub file entry: %d creation time.",
+		 function,
+		 sub_file_entry_index );
+
+		goto on_error;
+	}
+	if( mount_file_entry_get_timestamp_from_posix_time(
+	     posix_time,
+	     creation_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve creation timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_file_entry_iterator_get_access_time(
+	     file_entry->sub_file_entry_iterator,
+	     &posix_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve sub file entry: %d access time.",
+		 function,
+		 sub_file_entry_index );
+
+		goto on_error;
+	}
+	if( mount_file_entry_get_timestamp_from_posix_time(
+	     posix_time,
+	     access_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve access timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_file_entry_iterator_get_modification_time(
+	     file_entry->sub_file_entry_iterator,
+	     &posix_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve sub file entry: %d modification time.",
+		 function,
+		 sub_file_entry_index );
+
+		goto on_error;
+	}
+	if( mount_file_entry_get_timestamp_from_posix_time(
+	     posix_time,
+	     modification_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve modification timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_file_entry_iterator_get_entry_modification_time(
+	     file_entry->sub_file_entry_iterator,
+	     &posix_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve sub file entry: %d entry modification time.",
+		 function,
+		 sub_file_entry_index );
+
+		goto on_error;
+	}
+	if( mount_file_entry_get_timestamp_from_posix_time(
+	     posix_time,
+	     inode_change_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry modification timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( entry_name != NULL )
+	{
+		memory_free(
+		 entry_name );
+	}
+	if( *name != NULL )
+	{
+		memory_free(
+		 *name );
+
+		*name = NULL;
+	}
+	if( sub_file_entry != NULL )
+	{
+		mount_file_entry_free(
+		 &sub_file_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads data at a specific offset
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t mount_file_entry_read_buffer_at_offset(
+         mount_file_entry_t *file_entry,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "mount_file_entry_read_buffer_at_offset";
+	ssize_t read_count    = 0;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_entry->type == MOUNT_FILE_ENTRY_TYPE_FILE_ENTRY )
+	{
+		read_count = libewf_file_entry_read_buffer_at_offset(
+		              file_entry->ewf_file_entry,
+			      buffer,
+			      buffer_size,
+			      offset,
+			      error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ") from file entry.",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+	}
+	else if( ( file_entry->file_system != NULL )
+	      && ( file_entry->file_system->overlay != NULL ) )
+	{
+		read_count = mount_overlay_read_buffer_at_offset(
+		              file_entry->file_system->overlay,
+		              file_entry->ewf_handle,
+		              (uint8_t *) buffer,
+		              buffer_size,
+		              offset,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ") from overlay.",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+	}
+	else
+	{
+		/* The concurrent read does not use the current offset of the handle
+		 * and unpacks chunks outside the handle lock, so that reads of
+		 * multiple file system threads are not serialized
+		 */
+		read_count = libewf_handle_read_buffer_at_offset_concurrent(
+		              file_entry->ewf_handle,
+		              buffer,
+		              buffer_size,
+		              offset,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ") from handle.",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+	}
+	return( read_count );
+}
+
+/* Writes a buffer at a specific offset
+ * Only the media data can be written and only when an overlay is set
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t mount_file_entry_write_buffer_at_offset(
+         mount_file_entry_t *file_entry,
+         const void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "mount_file_entry_write_buffer_at_offset";
+	ssize_t write_count   = 0;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_entry->type != MOUNT_FILE_ENTRY_TYPE_HANDLE )
+	 || ( file_entry->ewf_handle == NULL )
+	 || ( file_entry->file_system == NULL )
+	 || ( file_entry->file_system->overlay == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported file entry - write access requires an overlay.",
+		 function );
+
+		return( -1 );
+	}
+	write_count = mount_overlay_write_buffer_at_offset(
+	               file_entry->file_system->overlay,
+	               file_entry->ewf_handle,
+	               (const uint8_t *) buffer,
+	               buffer_size,
+	               offset,
+	               error );
+
+	if( write_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write buffer at offset: %" PRIi64 " (0x%08" PRIx64 ") to overlay.",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	return( write_count );
+}
+
+/* Retrieves the data extent that contains a specific offset
+ * Returns 1 if successful, 0 if no data extent is available or -1 on error
+ */
+int mount_file_entry_get_data_extent(
+     mount_file_entry_t *file_entry,
+     off64_t offset,
+     off64_t *extent_offset,
+     size64_t *extent_size,
+     uint32_t *extent_type,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_entry_get_data_extent";
+	int result            = 0;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	/* The data extents are only available for the media data and
+	 * do not reflect the data written to an overlay
+	 */
+	if( ( file_entry->type != MOUNT_FILE_ENTRY_TYPE_HANDLE )
+	 || ( file_entry->ewf_handle == NULL ) )
+	{
+		return( 0 );
+	}
+	if( ( file_entry->file_system != NULL )
+	 && ( file_entry->file_system->overlay != NULL ) )
+	{
+		return( 0 );
+	}
+	result = libewf_handle_get_data_extents(
+	          file_entry->ewf_handle,
+	          offset,
+	          extent_offset,
+	          extent_size,
+	          extent_type,
+	          1,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data extent at offset: %" PRIi64 " (0x%08" PRIx64 ") from handle.",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	return( result );
 }
 
 /* Retrieves the size
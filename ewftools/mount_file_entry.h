@@ -67,6 +67,11 @@ struct mount_file_entry
 	/* The file entry
 	 */
 	libewf_file_entry_t *ewf_file_entry;
+
+	/* The sub file entry iterator, which retains the position of the last
+	 * sub file entry of which the values were retrieved
+	 */
+	libewf_file_entry_iterator_t *sub_file_entry_iterator;
 };
 
 int mount_file_entry_initialize(
@@ -135,6 +140,24 @@ int mount_file_entry_get_sub_file_entry_by_index(
      mount_file_entry_t **sub_file_entry,
      libcerror_error_t **error );
 
+int mount_file_entry_get_timestamp_from_posix_time(
+     int32_t posix_time,
+     uint64_t *timestamp,
+     libcerror_error_t **error );
+
+int mount_file_entry_get_sub_file_entry_values_by_index(
+     mount_file_entry_t *file_entry,
+     int sub_file_entry_index,
+     system_character_t **name,
+     size_t *name_size,
+     size64_t *size,
+     uint16_t *file_mode,
+     uint64_t *creation_time,
+     uint64_t *access_time,
+     uint64_t *modification_time,
+     uint64_t *inode_change_time,
+     libcerror_error_t **error );
+
 ssize_t mount_file_entry_read_buffer_at_offset(
          mount_file_entry_t *file_entry,
          void *buffer,
@@ -142,6 +165,21 @@ ssize_t mount_file_entry_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
+ssize_t mount_file_entry_write_buffer_at_offset(
+         mount_file_entry_t *file_entry,
+         const void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+int mount_file_entry_get_data_extent(
+     mount_file_entry_t *file_entry,
+     off64_t offset,
+     off64_t *extent_offset,
+     size64_t *extent_size,
+     uint32_t *extent_type,
+     libcerror_error_t **error );
+
 int mount_file_entry_get_size(
      mount_file_entry_t *file_entry,
      size64_t *size,
@@ -44,6 +44,7 @@
 #include "ewftools_libewf.h"
 #include "ewftools_libuna.h"
 #include "mount_file_system.h"
+#include "mount_overlay.h"
 
 /* Creates a file system
  * Make sure the value file_system is referencing, is set to NULL
@@ -239,6 +240,11 @@ int mount_file_system_free(
 			memory_free(
 			 ( *file_system )->path_prefix );
 		}
+		if( ( *file_system )->ewf_handles != NULL )
+		{
+			memory_free(
+			 ( *file_system )->ewf_handles );
+		}
 		memory_free(
 		 *file_system );
 
@@ -255,6 +261,7 @@ int mount_file_system_signal_abort(
      libcerror_error_t **error )
 {
 	static char *function = "mount_file_system_signal_abort";
+	int handle_index      = 0;
 
 	if( file_system == NULL )
 	{
@@ -267,18 +274,21 @@ int mount_file_system_signal_abort(
 
 		return( -1 );
 	}
-	if( file_system->ewf_handle != NULL )
+	for( handle_index = 0;
+	     handle_index < file_system->number_of_handles;
+	     handle_index++ )
 	{
 		if( libewf_handle_signal_abort(
-		     file_system->ewf_handle,
+		     file_system->ewf_handles[ handle_index ],
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to signal handle to abort.",
-			 function );
+			 "%s: unable to signal handle: %d to abort.",
+			 function,
+			 handle_index );
 
 			return( -1 );
 		}
@@ -286,15 +296,18 @@ int mount_file_system_signal_abort(
 	return( 1 );
 }
 
-/* Sets the handle
+/* Appends a handle
+ * The file system does not take over management of the handle
  * Returns 1 if successful or -1 on error
  */
-int mount_file_system_set_handle(
+int mount_file_system_append_handle(
      mount_file_system_t *file_system,
      libewf_handle_t *ewf_handle,
      libcerror_error_t **error )
 {
-	static char *function = "mount_file_system_set_handle";
+	libewf_handle_t **ewf_handles = NULL;
+	static char *function         = "mount_file_system_append_handle";
+	size_t ewf_handles_size       = 0;
 
 	if( file_system == NULL )
 	{
@@ -307,12 +320,103 @@ int mount_file_system_set_handle(
 
 		return( -1 );
 	}
-	file_system->ewf_handle = ewf_handle;
+	if( ewf_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	/* The handles are accessed by the number in the path, such as ewf1, which is limited to 4 digits
+	 */
+	if( file_system->number_of_handles >= 9999 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid file system - number of handles value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	ewf_handles_size = sizeof( libewf_handle_t * ) * ( file_system->number_of_handles + 1 );
+
+	ewf_handles = (libewf_handle_t **) memory_reallocate(
+	                                    file_system->ewf_handles,
+	                                    ewf_handles_size );
+
+	if( ewf_handles == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to resize handles.",
+		 function );
+
+		return( -1 );
+	}
+	file_system->ewf_handles = ewf_handles;
+
+	file_system->ewf_handles[ file_system->number_of_handles ] = ewf_handle;
+
+	file_system->number_of_handles += 1;
 
 	return( 1 );
 }
 
-/* Retrieves the handle
+/* Removes the last handle
+ * Returns 1 if successful, 0 if there are no handles or -1 on error
+ */
+int mount_file_system_remove_last_handle(
+     mount_file_system_t *file_system,
+     libewf_handle_t **ewf_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_system_remove_last_handle";
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( ewf_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_system->number_of_handles == 0 )
+	{
+		return( 0 );
+	}
+	file_system->number_of_handles -= 1;
+
+	*ewf_handle = file_system->ewf_handles[ file_system->number_of_handles ];
+
+	file_system->ewf_handles[ file_system->number_of_handles ] = NULL;
+
+	return( 1 );
+}
+
+/* Retrieves the handle of the first image
+ * The handle is NULL if no image was opened
  * Returns 1 if successful or -1 on error
  */
 int mount_file_system_get_handle(
@@ -344,7 +448,76 @@ int mount_file_system_get_handle(
 
 		return( -1 );
 	}
-	*ewf_handle = file_system->ewf_handle;
+	if( file_system->number_of_handles == 0 )
+	{
+		*ewf_handle = NULL;
+	}
+	else
+	{
+		*ewf_handle = file_system->ewf_handles[ 0 ];
+	}
+	return( 1 );
+}
+
+/* Sets the overlay
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_system_set_overlay(
+     mount_file_system_t *file_system,
+     mount_overlay_t *overlay,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_system_set_overlay";
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	file_system->overlay = overlay;
+
+	return( 1 );
+}
+
+/* Retrieves the overlay
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_system_get_overlay(
+     mount_file_system_t *file_system,
+     mount_overlay_t **overlay,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_system_get_overlay";
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( overlay == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid overlay.",
+		 function );
+
+		return( -1 );
+	}
+	*overlay = file_system->overlay;
 
 	return( 1 );
 }
@@ -533,7 +706,7 @@ int mount_file_system_get_number_of_handles(
 
 		return( -1 );
 	}
-	*number_of_handles = 1;
+	*number_of_handles = file_system->number_of_handles;
 
 	return( 1 );
 }
@@ -561,7 +734,7 @@ int mount_file_system_get_handle_by_index(
 		return( -1 );
 	}
 	if( ( handle_index < 0 )
-	 || ( handle_index >= 1 ) )
+	 || ( handle_index >= file_system->number_of_handles ) )
 	{
 		libcerror_error_set(
 		 error,
@@ -583,7 +756,7 @@ int mount_file_system_get_handle_by_index(
 
 		return( -1 );
 	}
-	*ewf_handle = file_system->ewf_handle;
+	*ewf_handle = file_system->ewf_handles[ handle_index ];
 
 	return( 1 );
 }
@@ -727,7 +900,7 @@ int mount_file_system_get_handle_by_path(
 	{
 		return( 0 );
 	}
-	*ewf_handle = file_system->ewf_handle;
+	*ewf_handle = file_system->ewf_handles[ handle_index ];
 
 	return( 1 );
 }
@@ -1261,6 +1434,7 @@ int mount_file_system_get_file_entry_by_path(
      libewf_file_entry_t **ewf_file_entry,
      libcerror_error_t **error )
 {
+	libewf_handle_t *ewf_handle             = NULL;
 	system_character_t *ewf_file_entry_path = NULL;
 	static char *function                   = "mount_file_system_get_file_entry_by_path";
 	size_t ewf_file_entry_path_length       = 0;
@@ -1278,6 +1452,21 @@ int mount_file_system_get_file_entry_by_path(
 
 		return( -1 );
 	}
+	/* The logical files are only supported for a single image
+	 */
+	if( file_system->number_of_handles != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file system - number of handles value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	ewf_handle = file_system->ewf_handles[ 0 ];
+
 	if( mount_file_system_get_ewf_file_entry_path_from_path(
 	     file_system,
 	     path,
@@ -1311,14 +1500,14 @@ int mount_file_system_get_file_entry_by_path(
 
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	result = libewf_handle_get_file_entry_by_utf16_path(
-		  file_system->ewf_handle,
+		  ewf_handle,
 		  (uint16_t *) ewf_file_entry_path,
 		  ewf_file_entry_path_length,
 		  ewf_file_entry,
 		  error );
 #else
 	result = libewf_handle_get_file_entry_by_utf8_path(
-		  file_system->ewf_handle,
+		  ewf_handle,
 		  (uint8_t *) ewf_file_entry_path,
 		  ewf_file_entry_path_length,
 		  ewf_file_entry,
@@ -27,6 +27,7 @@
 
 #include "ewftools_libcerror.h"
 #include "ewftools_libewf.h"
+#include "mount_overlay.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -48,9 +49,17 @@ struct mount_file_system
 	 */
 	size_t path_prefix_size;
 
-	/* The handle
+	/* The handles
 	 */
-	libewf_handle_t *ewf_handle;
+	libewf_handle_t **ewf_handles;
+
+	/* The number of handles
+	 */
+	int number_of_handles;
+
+	/* The overlay
+	 */
+	mount_overlay_t *overlay;
 };
 
 int mount_file_system_initialize(
@@ -65,16 +74,31 @@ int mount_file_system_signal_abort(
      mount_file_system_t *file_system,
      libcerror_error_t **error );
 
-int mount_file_system_set_handle(
+int mount_file_system_append_handle(
      mount_file_system_t *file_system,
      libewf_handle_t *ewf_handle,
      libcerror_error_t **error );
 
+int mount_file_system_remove_last_handle(
+     mount_file_system_t *file_system,
+     libewf_handle_t **ewf_handle,
+     libcerror_error_t **error );
+
 int mount_file_system_get_handle(
      mount_file_system_t *file_system,
      libewf_handle_t **ewf_handle,
      libcerror_error_t **error );
 
+int mount_file_system_set_overlay(
+     mount_file_system_t *file_system,
+     mount_overlay_t *overlay,
+     libcerror_error_t **error );
+
+int mount_file_system_get_overlay(
+     mount_file_system_t *file_system,
+     mount_overlay_t **overlay,
+     libcerror_error_t **error );
+
 int mount_file_system_set_path_prefix(
      mount_file_system_t *file_system,
      const system_character_t *path_prefix,
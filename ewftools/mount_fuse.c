@@ -122,7 +122,8 @@ int mount_fuse_set_stat_info(
 }
 
 /* Fills a directory entry
- * Returns 1 if successful or -1 on error
+ * The next offset is the offset of the directory entry that follows
+ * Returns 1 if successful, 0 if the buffer is full or -1 on error
  */
 int mount_fuse_filldir(
      void *buffer,
@@ -130,6 +131,7 @@ int mount_fuse_filldir(
      const char *name,
      struct stat *stat_info,
      mount_file_entry_t *file_entry,
+     off_t next_offset,
      libcerror_error_t **error )
 {
 	static char *function      = "mount_fuse_filldir";
@@ -223,6 +225,50 @@ int mount_fuse_filldir(
 			return( -1 );
 		}
 	}
+	return( mount_fuse_filldir_values(
+	         buffer,
+	         filler,
+	         name,
+	         stat_info,
+	         file_size,
+	         file_mode,
+	         access_time,
+	         inode_change_time,
+	         modification_time,
+	         next_offset,
+	         error ) );
+}
+
+/* Fills a directory entry from its values
+ * The next offset is the offset of the directory entry that follows
+ * Returns 1 if successful, 0 if the buffer is full or -1 on error
+ */
+int mount_fuse_filldir_values(
+     void *buffer,
+     fuse_fill_dir_t filler,
+     const char *name,
+     struct stat *stat_info,
+     size64_t file_size,
+     uint16_t file_mode,
+     uint64_t access_time,
+     uint64_t inode_change_time,
+     uint64_t modification_time,
+     off_t next_offset,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_fuse_filldir_values";
+
+	if( filler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filler.",
+		 function );
+
+		return( -1 );
+	}
 	if( memory_set(
 	     stat_info,
 	     0,
@@ -255,12 +301,19 @@ int mount_fuse_filldir(
 
 		return( -1 );
 	}
+	/* With a non-zero next offset the filler returns 1 when the buffer is full
+	 * and the directory entries are continued from the next offset
+	 */
 	if( filler(
 	     buffer,
 	     name,
 	     stat_info,
-	     0 ) == 1 )
+	     next_offset ) == 1 )
 	{
+		if( next_offset != 0 )
+		{
+			return( 0 );
+		}
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
@@ -280,9 +333,10 @@ int mount_fuse_open(
      const char *path,
      struct fuse_file_info *file_info )
 {
-	libcerror_error_t *error = NULL;
-	static char *function    = "mount_fuse_open";
-	int result               = 0;
+	libcerror_error_t *error       = NULL;
+	mount_file_entry_t *file_entry = NULL;
+	static char *function          = "mount_fuse_open";
+	int result                     = 0;
 
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
@@ -332,23 +386,10 @@ int mount_fuse_open(
 
 		goto on_error;
 	}
-	if( ( file_info->flags & 0x03 ) != O_RDONLY )
-	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-		 "%s: write access currently not supported.",
-		 function );
-
-		result = -EACCES;
-
-		goto on_error;
-	}
 	if( mount_handle_get_file_entry_by_path(
 	     ewfmount_mount_handle,
 	     path,
-	     (mount_file_entry_t **) &( file_info->fh ),
+	     &file_entry,
 	     &error ) != 1 )
 	{
 		libcerror_error_set(
@@ -363,6 +404,33 @@ int mount_fuse_open(
 
 		goto on_error;
 	}
+	/* Only the media data can be written and only when an overlay is set
+	 */
+	if( ( ( file_info->flags & 0x03 ) != O_RDONLY )
+	 && ( ( file_entry->type != MOUNT_FILE_ENTRY_TYPE_HANDLE )
+	  ||  ( file_entry->ewf_handle == NULL )
+	  ||  ( file_entry->file_system->overlay == NULL ) ) )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: write access currently not supported.",
+		 function );
+
+		result = -EACCES;
+
+		goto on_error;
+	}
+	file_info->fh = (uint64_t) file_entry;
+
+	/* The mounted data does not change, or is only changed by writes through
+	 * this file system, hence the data in the kernel page cache remains valid
+	 * when the file is opened again
+	 */
+	file_info->direct_io  = 0;
+	file_info->keep_cache = 1;
+
 	return( 0 );
 
 on_error:
@@ -373,6 +441,12 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( file_entry != NULL )
+	{
+		mount_file_entry_free(
+		 &file_entry,
+		 NULL );
+	}
 	return( result );
 }
 
@@ -485,6 +559,299 @@ on_error:
 	return( result );
 }
 
+/* Writes a buffer of data at the specified offset
+ * Returns number of bytes written if successful or a negative errno value otherwise
+ */
+int mount_fuse_write(
+     const char *path,
+     const char *buffer,
+     size_t size,
+     off_t offset,
+     struct fuse_file_info *file_info )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "mount_fuse_write";
+	ssize_t write_count      = 0;
+	int result               = 0;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: %s\n",
+		 function,
+		 path );
+	}
+#endif
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( size > (size_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( file_info == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file information.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( file_info->fh == (uint64_t) NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file information - missing file handle.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	write_count = mount_file_entry_write_buffer_at_offset(
+	               (mount_file_entry_t *) file_info->fh,
+	               (const void *) buffer,
+	               size,
+	               (off64_t) offset,
+	               &error );
+
+	if( write_count < 0 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write to file entry.",
+		 function );
+
+		result = -EIO;
+
+		goto on_error;
+	}
+	/* The size of the media data cannot be extended
+	 */
+	if( ( write_count == 0 )
+	 && ( size > 0 ) )
+	{
+		return( -ENOSPC );
+	}
+	return( (int) write_count );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+#if ( FUSE_USE_VERSION >= 35 )
+
+/* Determines the offset of the next data or hole (SEEK_DATA or SEEK_HOLE)
+ * Zero filled data extents of the media data are considered holes
+ * Returns the offset if successful or a negative errno value otherwise
+ */
+off_t mount_fuse_lseek(
+       const char *path,
+       off_t offset,
+       int whence,
+       struct fuse_file_info *file_info )
+{
+	libcerror_error_t *error       = NULL;
+	mount_file_entry_t *file_entry = NULL;
+	static char *function          = "mount_fuse_lseek";
+	off64_t extent_offset          = 0;
+	size64_t extent_size           = 0;
+	size64_t file_size             = 0;
+	uint32_t extent_type           = 0;
+	off_t result                   = 0;
+	int extent_result              = 0;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: %s\n",
+		 function,
+		 path );
+	}
+#endif
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( ( whence != SEEK_DATA )
+	 && ( whence != SEEK_HOLE ) )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( file_info == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file information.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( file_info->fh == (uint64_t) NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file information - missing file handle.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	file_entry = (mount_file_entry_t *) file_info->fh;
+
+	if( mount_file_entry_get_size(
+	     file_entry,
+	     &file_size,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file entry size.",
+		 function );
+
+		result = -EIO;
+
+		goto on_error;
+	}
+	/* Seeking data or a hole at or beyond the end of the file is not allowed
+	 */
+	if( ( offset < 0 )
+	 || ( (size64_t) offset >= file_size ) )
+	{
+		return( -ENXIO );
+	}
+	while( (size64_t) offset < file_size )
+	{
+		extent_result = mount_file_entry_get_data_extent(
+		                 file_entry,
+		                 (off64_t) offset,
+		                 &extent_offset,
+		                 &extent_size,
+		                 &extent_type,
+		                 &error );
+
+		if( extent_result == -1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data extent at offset: %" PRIi64 ".",
+			 function,
+			 (int64_t) offset );
+
+			result = -EIO;
+
+			goto on_error;
+		}
+		else if( extent_result == 0 )
+		{
+			/* Without data extents the whole file is considered data
+			 */
+			if( whence == SEEK_DATA )
+			{
+				return( offset );
+			}
+			return( (off_t) file_size );
+		}
+		if( extent_type == LIBEWF_DATA_EXTENT_TYPE_ZERO_FILL )
+		{
+			if( whence == SEEK_HOLE )
+			{
+				return( offset );
+			}
+		}
+		else if( whence == SEEK_DATA )
+		{
+			return( offset );
+		}
+		offset = (off_t) ( extent_offset + extent_size );
+	}
+	/* The end of the file is an implicit hole
+	 */
+	if( whence == SEEK_DATA )
+	{
+		return( -ENXIO );
+	}
+	return( (off_t) file_size );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+#endif /* ( FUSE_USE_VERSION >= 35 ) */
+
 /* Releases a file entry
  * Returns 0 if successful or a negative errno value otherwise
  */
@@ -653,28 +1020,34 @@ on_error:
 }
 
 /* Reads a directory
+ * The directory entries are filled with their attributes and an offset,
+ * where "." has offset 1, ".." offset 2 and the sub file entries the offsets
+ * that follow, in order, so that reading continues from the offset when the
+ * buffer is full, instead of restarting at the first sub file entry
  * Returns 0 if successful or a negative errno value otherwise
  */
 int mount_fuse_readdir(
      const char *path,
      void *buffer,
      fuse_fill_dir_t filler,
-     off_t offset EWFTOOLS_ATTRIBUTE_UNUSED,
+     off_t offset,
      struct fuse_file_info *file_info EWFTOOLS_ATTRIBUTE_UNUSED )
 {
 	struct stat *stat_info                = NULL;
 	libcerror_error_t *error              = NULL;
 	mount_file_entry_t *parent_file_entry = NULL;
-	mount_file_entry_t *sub_file_entry    = NULL;
 	static char *function                 = "mount_fuse_readdir";
 	char *name                            = NULL;
 	size_t name_size                      = 0;
-	int number_of_sub_file_entries        = 0;
+	size64_t file_size                    = 0;
+	uint64_t access_time                  = 0;
+	uint64_t creation_time                = 0;
+	uint64_t inode_change_time            = 0;
+	uint64_t modification_time            = 0;
+	uint16_t file_mode                    = 0;
 	int result                            = 0;
 	int sub_file_entry_index              = 0;
 
-	EWFTOOLS_UNREFERENCED_PARAMETER( offset )
-
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
@@ -739,159 +1112,136 @@ int mount_fuse_readdir(
 
 		goto on_error;
 	}
-	if( mount_fuse_filldir(
-	     buffer,
-	     filler,
-	     ".",
-	     stat_info,
-	     (mount_file_entry_t *) file_info->fh,
-	     &error ) != 1 )
+	if( offset < 0 )
 	{
 		libcerror_error_set(
 		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set self directory entry.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
 		 function );
 
-		result = -EIO;
+		result = -EINVAL;
 
 		goto on_error;
 	}
-	result = mount_file_entry_get_parent_file_entry(
-	          (mount_file_entry_t *) file_info->fh,
-	          &parent_file_entry,
-	          &error );
-
-	if( result == -1 )
+	if( offset < 1 )
 	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve parent file entry.",
-		 function );
+		result = mount_fuse_filldir(
+		          buffer,
+		          filler,
+		          ".",
+		          stat_info,
+		          (mount_file_entry_t *) file_info->fh,
+		          1,
+		          &error );
 
-		result = -EIO;
-
-		goto on_error;
-	}
-	if( mount_fuse_filldir(
-	     buffer,
-	     filler,
-	     "..",
-	     stat_info,
-	     parent_file_entry,
-	     &error ) != 1 )
-	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set parent directory entry.",
-		 function );
-
-		result = -EIO;
-
-		goto on_error;
-	}
-	if( mount_file_entry_free(
-	     &parent_file_entry,
-	     &error ) != 1 )
-	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free parent file entry.",
-		 function );
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set self directory entry.",
+			 function );
 
-		result = -EIO;
+			result = -EIO;
 
-		goto on_error;
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			goto on_buffer_full;
+		}
 	}
-	if( mount_file_entry_get_number_of_sub_file_entries(
-	     (mount_file_entry_t *) file_info->fh,
-	     &number_of_sub_file_entries,
-	     &error ) != 1 )
+	if( offset < 2 )
 	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of sub file entries.",
-		 function );
-
-		result = -EIO;
+		result = mount_file_entry_get_parent_file_entry(
+		          (mount_file_entry_t *) file_info->fh,
+		          &parent_file_entry,
+		          &error );
 
-		goto on_error;
-	}
-	for( sub_file_entry_index = 0;
-	     sub_file_entry_index < number_of_sub_file_entries;
-	     sub_file_entry_index++ )
-	{
-		if( mount_file_entry_get_sub_file_entry_by_index(
-		     (mount_file_entry_t *) file_info->fh,
-		     sub_file_entry_index,
-		     &sub_file_entry,
-		     &error ) != 1 )
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve sub file entry: %d.",
-			 function,
-			 sub_file_entry_index );
+			 "%s: unable to retrieve parent file entry.",
+			 function );
 
 			result = -EIO;
 
 			goto on_error;
 		}
-		if( mount_file_entry_get_name_size(
-		     sub_file_entry,
-		     &name_size,
-		     &error ) != 1 )
+		result = mount_fuse_filldir(
+		          buffer,
+		          filler,
+		          "..",
+		          stat_info,
+		          parent_file_entry,
+		          2,
+		          &error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve sub file entry: %d name size.",
-			 function,
-			 sub_file_entry_index );
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set parent directory entry.",
+			 function );
 
 			result = -EIO;
 
 			goto on_error;
 		}
-		name = narrow_string_allocate(
-		        name_size );
-
-		if( name == NULL )
+		if( mount_file_entry_free(
+		     &parent_file_entry,
+		     &error ) != 1 )
 		{
 			libcerror_error_set(
 			 &error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-			 "%s: unable to create sub file entry: %d name.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free parent file entry.",
 			 function );
 
 			result = -EIO;
 
 			goto on_error;
 		}
-		if( mount_file_entry_get_name(
-		     sub_file_entry,
-		     name,
-		     name_size,
-		     &error ) != 1 )
+		if( result == 0 )
+		{
+			goto on_buffer_full;
+		}
+	}
+	if( offset > 2 )
+	{
+		sub_file_entry_index = (int) ( offset - 2 );
+	}
+	do
+	{
+		result = mount_file_entry_get_sub_file_entry_values_by_index(
+		          (mount_file_entry_t *) file_info->fh,
+		          sub_file_entry_index,
+		          &name,
+		          &name_size,
+		          &file_size,
+		          &file_mode,
+		          &creation_time,
+		          &access_time,
+		          &modification_time,
+		          &inode_change_time,
+		          &error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve sub file entry: %d name.",
+			 "%s: unable to retrieve sub file entry: %d values.",
 			 function,
 			 sub_file_entry_index );
 
@@ -899,13 +1249,24 @@ int mount_fuse_readdir(
 
 			goto on_error;
 		}
-		if( mount_fuse_filldir(
-		     buffer,
-		     filler,
-		     name,
-		     stat_info,
-		     sub_file_entry,
-		     &error ) != 1 )
+		else if( result == 0 )
+		{
+			break;
+		}
+		result = mount_fuse_filldir_values(
+		          buffer,
+		          filler,
+		          name,
+		          stat_info,
+		          file_size,
+		          file_mode,
+		          access_time,
+		          inode_change_time,
+		          modification_time,
+		          (off_t) sub_file_entry_index + 3,
+		          &error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 &error,
@@ -923,23 +1284,11 @@ int mount_fuse_readdir(
 
 		name = NULL;
 
-		if( mount_file_entry_free(
-		     &sub_file_entry,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free sub file entry: %d.",
-			 function,
-			 sub_file_entry_index );
-
-			result = -EIO;
-
-			goto on_error;
-		}
+		sub_file_entry_index++;
 	}
+	while( result != 0 );
+
+on_buffer_full:
 	memory_free(
 	 stat_info );
 
@@ -958,12 +1307,6 @@ on_error:
 		memory_free(
 		 name );
 	}
-	if( sub_file_entry != NULL )
-	{
-		mount_file_entry_free(
-		 &sub_file_entry,
-		 NULL );
-	}
 	if( parent_file_entry != NULL )
 	{
 		mount_file_entry_free(
@@ -1048,15 +1391,15 @@ int mount_fuse_getattr(
      const char *path,
      struct stat *stat_info )
 {
-	libcerror_error_t *error       = NULL;
-	mount_file_entry_t *file_entry = NULL;
-	static char *function          = "mount_fuse_getattr";
-	size64_t file_size             = 0;
-	uint64_t access_time           = 0;
-	uint64_t inode_change_time     = 0;
-	uint64_t modification_time     = 0;
-	uint16_t file_mode             = 0;
-	int result                     = 0;
+	libcerror_error_t *error   = NULL;
+	static char *function      = "mount_fuse_getattr";
+	size64_t file_size         = 0;
+	uint64_t access_time       = 0;
+	uint64_t creation_time     = 0;
+	uint64_t inode_change_time = 0;
+	uint64_t modification_time = 0;
+	uint16_t file_mode         = 0;
+	int result                 = 0;
 
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
@@ -1109,10 +1452,17 @@ int mount_fuse_getattr(
 
 		goto on_error;
 	}
-	result = mount_handle_get_file_entry_by_path(
+	/* The attribute values are cached per path since the image is immutable
+	 */
+	result = mount_handle_get_file_entry_values_by_path(
 	          ewfmount_mount_handle,
 	          path,
-	          &file_entry,
+	          &file_size,
+	          &file_mode,
+	          &creation_time,
+	          &access_time,
+	          &modification_time,
+	          &inode_change_time,
 	          &error );
 
 	if( result == -1 )
@@ -1133,86 +1483,6 @@ int mount_fuse_getattr(
 	{
 		return( -ENOENT );
 	}
-	if( mount_file_entry_get_size(
-	     file_entry,
-	     &file_size,
-	     &error ) != 1 )
-	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve file entry size.",
-		 function );
-
-		result = -EIO;
-
-		goto on_error;
-	}
-	if( mount_file_entry_get_file_mode(
-	     file_entry,
-	     &file_mode,
-	     &error ) != 1 )
-	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve file mode.",
-		 function );
-
-		result = -EIO;
-
-		goto on_error;
-	}
-	if( mount_file_entry_get_access_time(
-	     file_entry,
-	     &access_time,
-	     &error ) != 1 )
-	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve access time.",
-		 function );
-
-		result = -EIO;
-
-		goto on_error;
-	}
-	if( mount_file_entry_get_modification_time(
-	     file_entry,
-	     &modification_time,
-	     &error ) != 1 )
-	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve modification time.",
-		 function );
-
-		result = -EIO;
-
-		goto on_error;
-	}
-	if( mount_file_entry_get_inode_change_time(
-	     file_entry,
-	     &inode_change_time,
-	     &error ) != 1 )
-	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve inode change time.",
-		 function );
-
-		result = -EIO;
-
-		goto on_error;
-	}
 	if( mount_fuse_set_stat_info(
 	     stat_info,
 	     file_size,
@@ -1233,21 +1503,6 @@ int mount_fuse_getattr(
 
 		goto on_error;
 	}
-	if( mount_file_entry_free(
-	     &file_entry,
-	     &error ) != 1 )
-	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free file entry.",
-		 function );
-
-		result = -EIO;
-
-		goto on_error;
-	}
 	return( 0 );
 
 on_error:
@@ -1258,12 +1513,6 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( file_entry != NULL )
-	{
-		mount_file_entry_free(
-		 &file_entry,
-		 NULL );
-	}
 	return( result );
 }
 
@@ -63,6 +63,20 @@ int mount_fuse_filldir(
      const char *name,
      struct stat *stat_info,
      mount_file_entry_t *file_entry,
+     off_t next_offset,
+     libcerror_error_t **error );
+
+int mount_fuse_filldir_values(
+     void *buffer,
+     fuse_fill_dir_t filler,
+     const char *name,
+     struct stat *stat_info,
+     size64_t file_size,
+     uint16_t file_mode,
+     uint64_t access_time,
+     uint64_t inode_change_time,
+     uint64_t modification_time,
+     off_t next_offset,
      libcerror_error_t **error );
 
 int mount_fuse_open(
@@ -76,6 +90,21 @@ int mount_fuse_read(
      off_t offset,
      struct fuse_file_info *file_info );
 
+int mount_fuse_write(
+     const char *path,
+     const char *buffer,
+     size_t size,
+     off_t offset,
+     struct fuse_file_info *file_info );
+
+#if ( FUSE_USE_VERSION >= 35 )
+off_t mount_fuse_lseek(
+       const char *path,
+       off_t offset,
+       int whence,
+       struct fuse_file_info *file_info );
+#endif
+
 int mount_fuse_release(
      const char *path,
      struct fuse_file_info *file_info );
@@ -29,9 +29,11 @@
 #include "ewftools_libcerror.h"
 #include "ewftools_libcpath.h"
 #include "ewftools_libewf.h"
+#include "mount_attribute_cache.h"
 #include "mount_file_entry.h"
 #include "mount_file_system.h"
 #include "mount_handle.h"
+#include "mount_overlay.h"
 
 /* Creates a mount handle
  * Make sure the value mount_handle is referencing, is set to NULL
@@ -106,13 +108,34 @@ int mount_handle_initialize(
 
 		goto on_error;
 	}
-	( *mount_handle )->input_format = MOUNT_HANDLE_INPUT_FORMAT_RAW;
+	if( mount_attribute_cache_initialize(
+	     &( ( *mount_handle )->attribute_cache ),
+	     MOUNT_HANDLE_ATTRIBUTE_CACHE_NUMBER_OF_ENTRIES,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize attribute cache.",
+		 function );
+
+		goto on_error;
+	}
+	( *mount_handle )->input_format             = MOUNT_HANDLE_INPUT_FORMAT_RAW;
+	( *mount_handle )->maximum_chunk_cache_size = MOUNT_HANDLE_DEFAULT_CHUNK_CACHE_SIZE;
 
 	return( 1 );
 
 on_error:
 	if( *mount_handle != NULL )
 	{
+		if( ( *mount_handle )->file_system != NULL )
+		{
+			mount_file_system_free(
+			 &( ( *mount_handle )->file_system ),
+			 NULL );
+		}
 		memory_free(
 		 *mount_handle );
 
@@ -144,6 +167,37 @@ int mount_handle_free(
 	}
 	if( *mount_handle != NULL )
 	{
+		/* The access map is written before the handle is freed with the file system
+		 */
+		if( ( *mount_handle )->access_map_filename != NULL )
+		{
+			if( mount_handle_write_access_map(
+			     *mount_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write access map.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( mount_handle_close(
+		     *mount_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close mount handle.",
+			 function );
+
+			result = -1;
+		}
 		if( mount_file_system_free(
 		     &( ( *mount_handle )->file_system ),
 		     error ) != 1 )
@@ -157,6 +211,53 @@ int mount_handle_free(
 
 			result = -1;
 		}
+		if( mount_attribute_cache_free(
+		     &( ( *mount_handle )->attribute_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free attribute cache.",
+			 function );
+
+			result = -1;
+		}
+		/* The scheduler is freed after the handles that use it
+		 */
+		if( ( *mount_handle )->scheduler != NULL )
+		{
+			if( libewf_scheduler_free(
+			     &( ( *mount_handle )->scheduler ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free scheduler.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *mount_handle )->overlay != NULL )
+		{
+			if( mount_overlay_free(
+			     &( ( *mount_handle )->overlay ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free overlay.",
+				 function );
+
+				result = -1;
+			}
+		}
 		memory_free(
 		 *mount_handle );
 
@@ -278,6 +379,98 @@ int mount_handle_set_maximum_number_of_open_handles(
 	return( 1 );
 }
 
+/* Sets the read ahead size
+ * The size is rounded up to a multiple of the chunk size when the handle is opened
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_set_read_ahead_size(
+     mount_handle_t *mount_handle,
+     size64_t read_ahead_size,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_set_read_ahead_size";
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	mount_handle->read_ahead_size = read_ahead_size;
+
+	return( 1 );
+}
+
+/* Sets if the sources are separate images
+ * Separate images are opened as individual handles that share the chunk cache,
+ * the maximum number of open handles and the worker threads
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_set_separate_images(
+     mount_handle_t *mount_handle,
+     uint8_t separate_images,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_set_separate_images";
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	mount_handle->separate_images = separate_images;
+
+	return( 1 );
+}
+
+/* Sets the maximum size of the chunk cache that is shared by separate images
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_set_maximum_chunk_cache_size(
+     mount_handle_t *mount_handle,
+     size64_t maximum_chunk_cache_size,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_set_maximum_chunk_cache_size";
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_chunk_cache_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum chunk cache size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	mount_handle->maximum_chunk_cache_size = maximum_chunk_cache_size;
+
+	return( 1 );
+}
+
 /* Sets the path prefix
  * Returns 1 if successful or -1 on error
  */
@@ -318,19 +511,172 @@ int mount_handle_set_path_prefix(
 	return( 1 );
 }
 
-/* Opens the mount handle
+/* Sets the overlay filename
+ * When set the media data is writable and written data is stored in the overlay file
+ * The filename is not copied and must remain available while the mount handle is open
  * Returns 1 if successful or -1 on error
  */
-int mount_handle_open(
+int mount_handle_set_overlay_filename(
+     mount_handle_t *mount_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_set_overlay_filename";
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	mount_handle->overlay_filename = filename;
+
+	return( 1 );
+}
+
+/* Sets the access map filename
+ * The chunks recorded in the access map file are prefetched when the handle is opened
+ * and the chunks accessed while mounted are written to it when the mount handle is freed
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_set_access_map_filename(
+     mount_handle_t *mount_handle,
+     const char *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_set_access_map_filename";
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	mount_handle->access_map_filename = filename;
+
+	return( 1 );
+}
+
+/* Writes the chunks accessed while mounted to the access map file
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_write_access_map(
+     mount_handle_t *mount_handle,
+     libcerror_error_t **error )
+{
+	libewf_handle_t *ewf_handle = NULL;
+	static char *function       = "mount_handle_write_access_map";
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( mount_handle->access_map_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid mount handle - missing access map filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( mount_file_system_get_handle(
+	     mount_handle->file_system,
+	     &ewf_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve handle from file system.",
+		 function );
+
+		return( -1 );
+	}
+	/* Nothing was recorded if the mount handle was not opened
+	 */
+	if( ewf_handle == NULL )
+	{
+		return( 1 );
+	}
+	if( libewf_handle_write_chunk_access_map(
+	     ewf_handle,
+	     mount_handle->access_map_filename,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write chunk access map.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Opens an image
+ * The handle of the image is appended to the file system, a separate image
+ * shares the resources of the handle of the first image
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_open_image(
      mount_handle_t *mount_handle,
      system_character_t * const * filenames,
      int number_of_filenames,
      libcerror_error_t **error )
 {
 	libewf_handle_t *ewf_handle            = NULL;
+	libewf_handle_t *first_ewf_handle      = NULL;
 	system_character_t **globbed_filenames = NULL;
-	static char *function                  = "mount_handle_open";
+	static char *function                  = "mount_handle_open_image";
+	size64_t media_size                    = 0;
+	size64_t number_of_read_ahead_chunks   = 0;
 	size_t filename_length                 = 0;
+	size32_t chunk_size                    = 0;
 
 	if( mount_handle == NULL )
 	{
@@ -399,68 +745,343 @@ int mount_handle_open(
 		}
 		filenames = (system_character_t * const *) globbed_filenames;
 	}
-	if( libewf_handle_initialize(
-	     &ewf_handle,
+	if( mount_file_system_get_handle(
+	     mount_handle->file_system,
+	     &first_ewf_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to initialize handle.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve first handle from file system.",
 		 function );
 
 		goto on_error;
 	}
-	if( libewf_handle_set_maximum_number_of_open_handles(
-	     ewf_handle,
-	     mount_handle->maximum_number_of_open_handles,
+	if( libewf_handle_initialize(
+	     &ewf_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set maximum number of open handles in handle.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize handle.",
 		 function );
 
 		goto on_error;
 	}
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	if( libewf_handle_open_wide(
-	     ewf_handle,
-	     filenames,
-	     number_of_filenames,
-	     LIBEWF_OPEN_READ,
-	     error ) != 1 )
-#else
-	if( libewf_handle_open(
-	     ewf_handle,
-	     filenames,
-	     number_of_filenames,
-	     LIBEWF_OPEN_READ,
-	     error ) != 1 )
-#endif
+	if( first_ewf_handle == NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
+		if( libewf_handle_set_maximum_number_of_open_handles(
+		     ewf_handle,
+		     mount_handle->maximum_number_of_open_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of open handles in handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		/* The segment files of all the images are bounded by a single maximum number of open handles
+		 */
+		if( libewf_handle_share_maximum_number_of_open_handles(
+		     ewf_handle,
+		     first_ewf_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to share maximum number of open handles with first handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( mount_handle->separate_images != 0 )
+	{
+		if( libewf_handle_set_maximum_cache_size(
+		     ewf_handle,
+		     MOUNT_HANDLE_MAXIMUM_IMAGE_CACHE_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum cache size in handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( mount_handle->scheduler != NULL )
+		{
+			if( libewf_handle_set_number_of_threads(
+			     ewf_handle,
+			     MOUNT_HANDLE_NUMBER_OF_THREADS,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set number of threads in handle.",
+				 function );
+
+				goto on_error;
+			}
+			if( libewf_handle_set_scheduler(
+			     ewf_handle,
+			     mount_handle->scheduler,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set scheduler in handle.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     ewf_handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     ewf_handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_OPEN_FAILED,
 		 "%s: unable to open file(s).",
 		 function );
 
 		goto on_error;
 	}
-	if( mount_file_system_set_handle(
+	if( mount_handle->separate_images != 0 )
+	{
+		/* The images share a single chunk cache so that the memory is used
+		 * by the images that are read and idle images use (nearly) no memory
+		 */
+		if( first_ewf_handle == NULL )
+		{
+			if( libewf_handle_set_maximum_chunk_cache_size(
+			     ewf_handle,
+			     mount_handle->maximum_chunk_cache_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set maximum chunk cache size in handle.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		else if( libewf_handle_share_chunk_cache(
+		          ewf_handle,
+		          first_ewf_handle,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to share chunk cache with first handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( mount_handle->read_ahead_size > 0 )
+	{
+		if( libewf_handle_get_chunk_size(
+		     ewf_handle,
+		     &chunk_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk size.",
+			 function );
+
+			goto on_error;
+		}
+		if( chunk_size > 0 )
+		{
+			number_of_read_ahead_chunks = ( mount_handle->read_ahead_size + chunk_size - 1 ) / chunk_size;
+
+			if( number_of_read_ahead_chunks > (size64_t) INT_MAX )
+			{
+				number_of_read_ahead_chunks = (size64_t) INT_MAX;
+			}
+			if( libewf_handle_set_number_of_read_ahead_chunks(
+			     ewf_handle,
+			     (int) number_of_read_ahead_chunks,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set number of read ahead chunks in handle.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	if( mount_handle->access_map_filename != NULL )
+	{
+		/* The chunks accessed in a previous session, typically the file system
+		 * metadata, are prefetched in the background in offset order
+		 */
+		if( libewf_handle_prefetch_chunk_access_map(
+		     ewf_handle,
+		     mount_handle->access_map_filename,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to prefetch chunk access map.",
+			 function );
+
+			goto on_error;
+		}
+		if( libewf_handle_start_chunk_access_recording(
+		     ewf_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to start chunk access recording.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( mount_handle->overlay_filename != NULL )
+	{
+		if( libewf_handle_get_media_size(
+		     ewf_handle,
+		     &media_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve media size.",
+			 function );
+
+			goto on_error;
+		}
+		if( libewf_handle_get_chunk_size(
+		     ewf_handle,
+		     &chunk_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk size.",
+			 function );
+
+			goto on_error;
+		}
+		/* The overlay blocks match the chunks so that a written block
+		 * only requires a single chunk to be copied from the image
+		 */
+		if( mount_overlay_initialize(
+		     &( mount_handle->overlay ),
+		     media_size,
+		     chunk_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize overlay.",
+			 function );
+
+			goto on_error;
+		}
+		if( mount_overlay_open(
+		     mount_handle->overlay,
+		     mount_handle->overlay_filename,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open overlay file.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( mount_file_system_append_handle(
 	     mount_handle->file_system,
 	     ewf_handle,
 	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append handle to file system.",
+		 function );
+
+		goto on_error;
+	}
+	/* The handle is closed and freed by mount_handle_close from here on
+	 */
+	ewf_handle = NULL;
+
+	if( mount_file_system_set_overlay(
+	     mount_handle->file_system,
+	     mount_handle->overlay,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set handle in file system.",
+		 "%s: unable to set overlay in file system.",
 		 function );
 
 		goto on_error;
@@ -492,6 +1113,12 @@ int mount_handle_open(
 	return( 1 );
 
 on_error:
+	if( mount_handle->overlay != NULL )
+	{
+		mount_overlay_free(
+		 &( mount_handle->overlay ),
+		 NULL );
+	}
 	if( ewf_handle != NULL )
 	{
 		libewf_handle_free(
@@ -515,15 +1142,19 @@ on_error:
 	return( -1 );
 }
 
-/* Closes the mount handle
- * Returns the 0 if succesful or -1 on error
+/* Opens the mount handle
+ * If the sources are separate images every filename is opened as an individual image,
+ * otherwise the filenames are the segment files of a single image
+ * Returns 1 if successful or -1 on error
  */
-int mount_handle_close(
+int mount_handle_open(
      mount_handle_t *mount_handle,
+     system_character_t * const * filenames,
+     int number_of_filenames,
      libcerror_error_t **error )
 {
-	libewf_handle_t *ewf_handle = NULL;
-	static char *function       = "mount_handle_close";
+	static char *function = "mount_handle_open";
+	int filename_index    = 0;
 
 	if( mount_handle == NULL )
 	{
@@ -536,62 +1167,208 @@ int mount_handle_close(
 
 		return( -1 );
 	}
-	if( mount_file_system_get_handle(
-	     mount_handle->file_system,
-	     &ewf_handle,
-	     error ) != 1 )
+	if( filenames == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve handle from file system.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filenames.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( mount_file_system_set_handle(
-	     mount_handle->file_system,
-	     NULL,
-	     error ) != 1 )
+	if( number_of_filenames <= 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set handle in file system.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of filenames.",
 		 function );
 
-		ewf_handle = NULL;
+		return( -1 );
+	}
+	if( mount_handle->separate_images == 0 )
+	{
+		if( mount_handle_open_image(
+		     mount_handle,
+		     filenames,
+		     number_of_filenames,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open image.",
+			 function );
 
-		goto on_error;
+			return( -1 );
+		}
+		return( 1 );
 	}
-	if( libewf_handle_close(
-	     ewf_handle,
-	     error ) != 0 )
+	/* The overlay, the access map and the logical files are bound to a single image
+	 */
+	if( ( mount_handle->input_format != MOUNT_HANDLE_INPUT_FORMAT_RAW )
+	 || ( mount_handle->overlay_filename != NULL )
+	 || ( mount_handle->access_map_filename != NULL ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
-		 "%s: unable to close handle.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid mount handle - separate images are only supported in the raw input format without overlay or access map.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libewf_handle_free(
-	     &ewf_handle,
-	     error ) != 1 )
+	if( mount_handle->scheduler == NULL )
+	{
+		if( libewf_scheduler_initialize(
+		     &( mount_handle->scheduler ),
+		     MOUNT_HANDLE_NUMBER_OF_THREADS,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize scheduler.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	for( filename_index = 0;
+	     filename_index < number_of_filenames;
+	     filename_index++ )
+	{
+		if( mount_handle_open_image(
+		     mount_handle,
+		     &( filenames[ filename_index ] ),
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open image: %d.",
+			 function,
+			 filename_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Closes the mount handle
+ * Returns the 0 if succesful or -1 on error
+ */
+int mount_handle_close(
+     mount_handle_t *mount_handle,
+     libcerror_error_t **error )
+{
+	libewf_handle_t *ewf_handle = NULL;
+	static char *function       = "mount_handle_close";
+	int result                  = 0;
+
+	if( mount_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
+	}
+	if( mount_handle->overlay != NULL )
+	{
+		if( mount_file_system_set_overlay(
+		     mount_handle->file_system,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set overlay in file system.",
+			 function );
+
+			goto on_error;
+		}
+		if( mount_overlay_free(
+		     &( mount_handle->overlay ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free overlay.",
+			 function );
+
+			goto on_error;
+		}
 	}
+	/* The handles are closed in reverse order so that the first handle,
+	 * which the other handles share their resources with, is closed last
+	 */
+	do
+	{
+		result = mount_file_system_remove_last_handle(
+		          mount_handle->file_system,
+		          &ewf_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove last handle from file system.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			if( libewf_handle_close(
+			     ewf_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close handle.",
+				 function );
+
+				goto on_error;
+			}
+			if( libewf_handle_free(
+			     &ewf_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free handle.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	while( result != 0 );
+
 	return( 0 );
 
 on_error:
@@ -764,3 +1541,234 @@ on_error:
 	return( -1 );
 }
 
+
+/* Retrieves the attribute values of the file entry of a specific path
+ * The values are retrieved from the attribute cache and otherwise from the
+ * file entry, after which they are stored in the attribute cache
+ * Returns 1 if successful, 0 if no such file entry or -1 on error
+ */
+int mount_handle_get_file_entry_values_by_path(
+     mount_handle_t *mount_handle,
+     const system_character_t *path,
+     size64_t *size,
+     uint16_t *file_mode,
+     uint64_t *creation_time,
+     uint64_t *access_time,
+     uint64_t *modification_time,
+     uint64_t *inode_change_time,
+     libcerror_error_t **error )
+{
+	mount_file_entry_t *file_entry = NULL;
+	static char *function          = "mount_handle_get_file_entry_values_by_path";
+	size_t path_length             = 0;
+	int result                     = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		return( -1 );
+	}
+	path_length = system_string_length(
+	               path );
+
+	if( mount_handle->attribute_cache != NULL )
+	{
+		result = mount_attribute_cache_get_values(
+		          mount_handle->attribute_cache,
+		          path,
+		          path_length,
+		          size,
+		          file_mode,
+		          creation_time,
+		          access_time,
+		          modification_time,
+		          inode_change_time,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve values from attribute cache.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			return( 1 );
+		}
+	}
+	result = mount_handle_get_file_entry_by_path(
+	          mount_handle,
+	          path,
+	          &file_entry,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file entry.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( mount_file_entry_get_size(
+	     file_entry,
+	     size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file entry size.",
+		 function );
+
+		goto on_error;
+	}
+	if( mount_file_entry_get_file_mode(
+	     file_entry,
+	     file_mode,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file mode.",
+		 function );
+
+		goto on_error;
+	}
+	if( mount_file_entry_get_creation_time(
+	     file_entry,
+	     creation_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve creation time.",
+		 function );
+
+		goto on_error;
+	}
+	if( mount_file_entry_get_access_time(
+	     file_entry,
+	     access_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve access time.",
+		 function );
+
+		goto on_error;
+	}
+	if( mount_file_entry_get_modification_time(
+	     file_entry,
+	     modification_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve modification time.",
+		 function );
+
+		goto on_error;
+	}
+	if( mount_file_entry_get_inode_change_time(
+	     file_entry,
+	     inode_change_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve inode change time.",
+		 function );
+
+		goto on_error;
+	}
+	if( mount_file_entry_free(
+	     &file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( mount_handle->attribute_cache != NULL )
+	{
+		if( mount_attribute_cache_set_values(
+		     mount_handle->attribute_cache,
+		     path,
+		     path_length,
+		     *size,
+		     *file_mode,
+		     *creation_time,
+		     *access_time,
+		     *modification_time,
+		     *inode_change_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set values in attribute cache.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( file_entry != NULL )
+	{
+		mount_file_entry_free(
+		 &file_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
@@ -28,13 +28,33 @@
 
 #include "ewftools_libcerror.h"
 #include "ewftools_libewf.h"
+#include "mount_attribute_cache.h"
 #include "mount_file_entry.h"
 #include "mount_file_system.h"
+#include "mount_overlay.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+/* The number of entries in the attribute cache
+ */
+#define MOUNT_HANDLE_ATTRIBUTE_CACHE_NUMBER_OF_ENTRIES	65536
+
+/* The default maximum size of the chunk cache that is shared by separate images
+ */
+#define MOUNT_HANDLE_DEFAULT_CHUNK_CACHE_SIZE		( 256 * 1024 * 1024 )
+
+/* The maximum size of the chunks cache of a separate image
+ * The chunks cache of an image is kept small since the chunk data is
+ * retained in the chunk cache that is shared by the images
+ */
+#define MOUNT_HANDLE_MAXIMUM_IMAGE_CACHE_SIZE		( 2 * 1024 * 1024 )
+
+/* The number of worker threads that are shared by separate images
+ */
+#define MOUNT_HANDLE_NUMBER_OF_THREADS			4
+
 enum MOUNT_HANDLE_INPUT_FORMATS
 {
 	MOUNT_HANDLE_INPUT_FORMAT_FILES	= (int) 'f',
@@ -49,14 +69,46 @@ struct mount_handle
 	 */
 	mount_file_system_t *file_system;
 
+	/* The attribute cache
+	 */
+	mount_attribute_cache_t *attribute_cache;
+
 	/* The input format
 	 */
 	uint8_t input_format;
 
+	/* Value to indicate the sources are separate images
+	 */
+	uint8_t separate_images;
+
+	/* The maximum size of the chunk cache that is shared by separate images
+	 */
+	size64_t maximum_chunk_cache_size;
+
+	/* The scheduler that is shared by separate images
+	 */
+	libewf_scheduler_t *scheduler;
+
 	/* The maximum number of open handles
 	 */
 	int maximum_number_of_open_handles;
 
+	/* The read ahead size
+	 */
+	size64_t read_ahead_size;
+
+	/* The overlay filename
+	 */
+	const system_character_t *overlay_filename;
+
+	/* The overlay
+	 */
+	mount_overlay_t *overlay;
+
+	/* The access map filename
+	 */
+	const char *access_map_filename;
+
 	/* The notification output stream
 	 */
 	FILE *notify_stream;
@@ -84,12 +136,47 @@ int mount_handle_set_maximum_number_of_open_handles(
      int maximum_number_of_open_handles,
      libcerror_error_t **error );
 
+int mount_handle_set_read_ahead_size(
+     mount_handle_t *mount_handle,
+     size64_t read_ahead_size,
+     libcerror_error_t **error );
+
+int mount_handle_set_separate_images(
+     mount_handle_t *mount_handle,
+     uint8_t separate_images,
+     libcerror_error_t **error );
+
+int mount_handle_set_maximum_chunk_cache_size(
+     mount_handle_t *mount_handle,
+     size64_t maximum_chunk_cache_size,
+     libcerror_error_t **error );
+
 int mount_handle_set_path_prefix(
      mount_handle_t *mount_handle,
      const system_character_t *path_prefix,
      size_t path_prefix_size,
      libcerror_error_t **error );
 
+int mount_handle_set_overlay_filename(
+     mount_handle_t *mount_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int mount_handle_set_access_map_filename(
+     mount_handle_t *mount_handle,
+     const char *filename,
+     libcerror_error_t **error );
+
+int mount_handle_write_access_map(
+     mount_handle_t *mount_handle,
+     libcerror_error_t **error );
+
+int mount_handle_open_image(
+     mount_handle_t *mount_handle,
+     system_character_t * const * filenames,
+     int number_of_filenames,
+     libcerror_error_t **error );
+
 int mount_handle_open(
      mount_handle_t *mount_handle,
      system_character_t * const * filenames,
@@ -106,6 +193,17 @@ int mount_handle_get_file_entry_by_path(
      mount_file_entry_t **file_entry,
      libcerror_error_t **error );
 
+int mount_handle_get_file_entry_values_by_path(
+     mount_handle_t *mount_handle,
+     const system_character_t *path,
+     size64_t *size,
+     uint16_t *file_mode,
+     uint64_t *creation_time,
+     uint64_t *access_time,
+     uint64_t *modification_time,
+     uint64_t *inode_change_time,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -0,0 +1,1945 @@
+/*
+ * Mount tool network block device (NBD) functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_POLL_H )
+#include <poll.h>
+#endif
+
+#if defined( HAVE_SYS_SOCKET_H )
+#include <sys/socket.h>
+#endif
+
+#if defined( HAVE_SYS_UN_H )
+#include <sys/un.h>
+#endif
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libewf.h"
+#include "mount_file_system.h"
+#include "mount_handle.h"
+#include "mount_nbd.h"
+#include "mount_overlay.h"
+
+#if defined( HAVE_MOUNT_NBD )
+
+/* The NBD protocol values, refer to the NBD protocol specification
+ * Only the fixed newstyle handshake is supported
+ */
+#define MOUNT_NBD_INITIAL_MAGIC			0x4e42444d41474943ULL
+#define MOUNT_NBD_OPTION_MAGIC			0x49484156454f5054ULL
+#define MOUNT_NBD_OPTION_REPLY_MAGIC		0x0003e889045565a9ULL
+#define MOUNT_NBD_REQUEST_MAGIC			0x25609513UL
+#define MOUNT_NBD_SIMPLE_REPLY_MAGIC		0x67446698UL
+
+#define MOUNT_NBD_FLAG_FIXED_NEWSTYLE		0x0001
+#define MOUNT_NBD_FLAG_NO_ZEROES		0x0002
+
+#define MOUNT_NBD_FLAG_C_NO_ZEROES		0x00000002UL
+
+#define MOUNT_NBD_FLAG_HAS_FLAGS		0x0001
+#define MOUNT_NBD_FLAG_READ_ONLY		0x0002
+#define MOUNT_NBD_FLAG_SEND_FLUSH		0x0004
+#define MOUNT_NBD_FLAG_SEND_TRIM		0x0020
+#define MOUNT_NBD_FLAG_CAN_MULTI_CONN		0x0100
+
+#define MOUNT_NBD_OPT_EXPORT_NAME		1
+#define MOUNT_NBD_OPT_ABORT			2
+#define MOUNT_NBD_OPT_LIST			3
+#define MOUNT_NBD_OPT_INFO			6
+#define MOUNT_NBD_OPT_GO			7
+
+#define MOUNT_NBD_REP_ACK			1
+#define MOUNT_NBD_REP_SERVER			2
+#define MOUNT_NBD_REP_INFO			3
+#define MOUNT_NBD_REP_ERR_UNSUP			0x80000001UL
+
+#define MOUNT_NBD_INFO_EXPORT			0
+#define MOUNT_NBD_INFO_BLOCK_SIZE		3
+
+#define MOUNT_NBD_CMD_READ			0
+#define MOUNT_NBD_CMD_WRITE			1
+#define MOUNT_NBD_CMD_DISC			2
+#define MOUNT_NBD_CMD_FLUSH			3
+#define MOUNT_NBD_CMD_TRIM			4
+
+#define MOUNT_NBD_EPERM				1
+#define MOUNT_NBD_EIO				5
+#define MOUNT_NBD_EINVAL			22
+#define MOUNT_NBD_ENOSPC			28
+
+/* The maximum size of the data of an option
+ */
+#define MOUNT_NBD_MAXIMUM_OPTION_SIZE		4096
+
+/* The timeout in milliseconds after which the server checks if it should abort
+ */
+#define MOUNT_NBD_POLL_TIMEOUT			1000
+
+#if defined( MSG_NOSIGNAL )
+#define MOUNT_NBD_SEND_FLAGS			MSG_NOSIGNAL
+#else
+#define MOUNT_NBD_SEND_FLAGS			0
+#endif
+
+/* Creates a NBD server
+ * Make sure the value server is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int mount_nbd_server_initialize(
+     mount_nbd_server_t **server,
+     mount_handle_t *mount_handle,
+     libcerror_error_t **error )
+{
+	static char *function    = "mount_nbd_server_initialize";
+	int connection_index     = 0;
+
+	if( server == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid server.",
+		 function );
+
+		return( -1 );
+	}
+	if( *server != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid server value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	*server = memory_allocate_structure(
+	           mount_nbd_server_t );
+
+	if( *server == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create server.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *server,
+	     0,
+	     sizeof( mount_nbd_server_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear server.",
+		 function );
+
+		memory_free(
+		 *server );
+
+		*server = NULL;
+
+		return( -1 );
+	}
+	( *server )->socket_descriptor = -1;
+
+	for( connection_index = 0;
+	     connection_index < MOUNT_NBD_MAXIMUM_NUMBER_OF_CONNECTIONS;
+	     connection_index++ )
+	{
+		( *server )->connections[ connection_index ].server            = *server;
+		( *server )->connections[ connection_index ].socket_descriptor = -1;
+	}
+	if( mount_file_system_get_handle(
+	     mount_handle->file_system,
+	     &( ( *server )->ewf_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve handle from file system.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( *server )->ewf_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_media_size(
+	     ( *server )->ewf_handle,
+	     &( ( *server )->media_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_chunk_size(
+	     ( *server )->ewf_handle,
+	     &( ( *server )->chunk_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk size.",
+		 function );
+
+		goto on_error;
+	}
+	( *server )->overlay = mount_handle->overlay;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *server )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *server != NULL )
+	{
+		memory_free(
+		 *server );
+
+		*server = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a NBD server
+ * Returns 1 if successful or -1 on error
+ */
+int mount_nbd_server_free(
+     mount_nbd_server_t **server,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_nbd_server_free";
+	int connection_index  = 0;
+	int result            = 1;
+
+	if( server == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid server.",
+		 function );
+
+		return( -1 );
+	}
+	if( *server != NULL )
+	{
+		if( ( *server )->socket_descriptor != -1 )
+		{
+			if( mount_nbd_server_close(
+			     *server,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close server.",
+				 function );
+
+				result = -1;
+			}
+		}
+		for( connection_index = 0;
+		     connection_index < MOUNT_NBD_MAXIMUM_NUMBER_OF_CONNECTIONS;
+		     connection_index++ )
+		{
+			if( ( *server )->connections[ connection_index ].buffer != NULL )
+			{
+				memory_free(
+				 ( *server )->connections[ connection_index ].buffer );
+			}
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *server )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *server );
+
+		*server = NULL;
+	}
+	return( result );
+}
+
+/* Signals the NBD server to abort
+ * This function only sets a flag so it can be called from a signal handler
+ * Returns 1 if successful or -1 on error
+ */
+int mount_nbd_server_signal_abort(
+     mount_nbd_server_t *server,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_nbd_server_signal_abort";
+
+	if( server == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid server.",
+		 function );
+
+		return( -1 );
+	}
+	server->abort = 1;
+
+	return( 1 );
+}
+
+/* Opens the NBD server listening on a Unix domain socket
+ * Returns 1 if successful or -1 on error
+ */
+int mount_nbd_server_open(
+     mount_nbd_server_t *server,
+     const char *socket_path,
+     libcerror_error_t **error )
+{
+	struct sockaddr_un socket_address;
+
+	static char *function     = "mount_nbd_server_open";
+	size_t socket_path_length = 0;
+
+	if( server == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid server.",
+		 function );
+
+		return( -1 );
+	}
+	if( server->socket_descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid server - socket descriptor value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( socket_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid socket path.",
+		 function );
+
+		return( -1 );
+	}
+	socket_path_length = narrow_string_length(
+	                      socket_path );
+
+	if( ( socket_path_length == 0 )
+	 || ( socket_path_length >= sizeof( socket_address.sun_path ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid socket path length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     &socket_address,
+	     0,
+	     sizeof( struct sockaddr_un ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear socket address.",
+		 function );
+
+		return( -1 );
+	}
+	socket_address.sun_family = AF_UNIX;
+
+	if( narrow_string_copy(
+	     socket_address.sun_path,
+	     socket_path,
+	     socket_path_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy socket path.",
+		 function );
+
+		return( -1 );
+	}
+	server->socket_descriptor = socket(
+	                             AF_UNIX,
+	                             SOCK_STREAM,
+	                             0 );
+
+	if( server->socket_descriptor == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to create socket.",
+		 function );
+
+		return( -1 );
+	}
+	/* An existing socket file is not removed so that a socket of
+	 * another running server or another file is never replaced
+	 */
+	if( bind(
+	     server->socket_descriptor,
+	     (struct sockaddr *) &socket_address,
+	     sizeof( struct sockaddr_un ) ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to bind socket to: %s.",
+		 function,
+		 socket_path );
+
+		goto on_error;
+	}
+	server->socket_path = socket_path;
+
+	if( listen(
+	     server->socket_descriptor,
+	     MOUNT_NBD_MAXIMUM_NUMBER_OF_CONNECTIONS ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to listen on socket.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( server->socket_path != NULL )
+	{
+		unlink(
+		 server->socket_path );
+
+		server->socket_path = NULL;
+	}
+	close(
+	 server->socket_descriptor );
+
+	server->socket_descriptor = -1;
+
+	return( -1 );
+}
+
+/* Closes the NBD server
+ * Returns the 0 if succesful or -1 on error
+ */
+int mount_nbd_server_close(
+     mount_nbd_server_t *server,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_nbd_server_close";
+	int result            = 0;
+
+	if( server == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid server.",
+		 function );
+
+		return( -1 );
+	}
+	if( server->socket_descriptor == -1 )
+	{
+		return( 0 );
+	}
+	if( close(
+	     server->socket_descriptor ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 errno,
+		 "%s: unable to close socket.",
+		 function );
+
+		result = -1;
+	}
+	server->socket_descriptor = -1;
+
+	if( server->socket_path != NULL )
+	{
+		if( unlink(
+		     server->socket_path ) != 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_UNLINK_FAILED,
+			 errno,
+			 "%s: unable to remove socket: %s.",
+			 function,
+			 server->socket_path );
+
+			result = -1;
+		}
+		server->socket_path = NULL;
+	}
+	return( result );
+}
+
+/* Runs the NBD server until it is signalled to abort
+ * Every accepted connection is served by its own thread if multi-threading is supported
+ * Returns 1 if successful or -1 on error
+ */
+int mount_nbd_server_run(
+     mount_nbd_server_t *server,
+     libcerror_error_t **error )
+{
+	struct pollfd poll_descriptor;
+
+	mount_nbd_connection_t *connection = NULL;
+	static char *function              = "mount_nbd_server_run";
+	int result                         = 1;
+	int socket_descriptor              = -1;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	int connection_index               = 0;
+#endif
+
+	if( server == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid server.",
+		 function );
+
+		return( -1 );
+	}
+	if( server->socket_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid server - missing socket descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	while( server->abort == 0 )
+	{
+		poll_descriptor.fd      = server->socket_descriptor;
+		poll_descriptor.events  = POLLIN;
+		poll_descriptor.revents = 0;
+
+		/* The poll times out so that the abort flag, which is set
+		 * by the signal handler, is checked regularly
+		 */
+		result = poll(
+		          &poll_descriptor,
+		          1,
+		          MOUNT_NBD_POLL_TIMEOUT );
+
+		if( result == -1 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_GENERIC,
+			 errno,
+			 "%s: unable to poll socket.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		/* Join the threads of the connections that were closed by the client
+		 */
+		if( libcthreads_mutex_grab(
+		     server->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		connection = NULL;
+
+		for( connection_index = 0;
+		     connection_index < MOUNT_NBD_MAXIMUM_NUMBER_OF_CONNECTIONS;
+		     connection_index++ )
+		{
+			if( ( server->connections[ connection_index ].thread != NULL )
+			 && ( server->connections[ connection_index ].is_active == 0 ) )
+			{
+				connection = &( server->connections[ connection_index ] );
+
+				break;
+			}
+		}
+		if( libcthreads_mutex_release(
+		     server->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		if( connection != NULL )
+		{
+			if( libcthreads_thread_join(
+			     &( connection->thread ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join connection thread.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+		}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+		if( ( result == 0 )
+		 || ( ( poll_descriptor.revents & POLLIN ) == 0 ) )
+		{
+			result = 1;
+
+			continue;
+		}
+		socket_descriptor = accept(
+		                     server->socket_descriptor,
+		                     NULL,
+		                     NULL );
+
+		if( socket_descriptor == -1 )
+		{
+			if( ( errno == EINTR )
+			 || ( errno == ECONNABORTED ) )
+			{
+				result = 1;
+
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 errno,
+			 "%s: unable to accept connection.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		result = 1;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		connection = NULL;
+
+		for( connection_index = 0;
+		     connection_index < MOUNT_NBD_MAXIMUM_NUMBER_OF_CONNECTIONS;
+		     connection_index++ )
+		{
+			if( server->connections[ connection_index ].thread == NULL )
+			{
+				connection = &( server->connections[ connection_index ] );
+
+				break;
+			}
+		}
+		if( connection == NULL )
+		{
+			/* All connection slots are in use, refuse the connection
+			 */
+#if defined( HAVE_VERBOSE_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: maximum number of connections reached.\n",
+				 function );
+			}
+#endif
+			close(
+			 socket_descriptor );
+
+			continue;
+		}
+		connection->socket_descriptor = socket_descriptor;
+		connection->is_active         = 1;
+
+		if( libcthreads_thread_create(
+		     &( connection->thread ),
+		     NULL,
+		     (int (*)(void *)) &mount_nbd_connection_thread_function,
+		     (void *) connection,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create connection thread.",
+			 function );
+
+			close(
+			 socket_descriptor );
+
+			connection->socket_descriptor = -1;
+			connection->is_active         = 0;
+
+			result = -1;
+
+			break;
+		}
+#else
+		connection = &( server->connections[ 0 ] );
+
+		connection->socket_descriptor = socket_descriptor;
+		connection->is_active         = 1;
+
+		mount_nbd_connection_thread_function(
+		 connection );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* Shut down the sockets of the active connections so that
+	 * connection threads blocked on a read return
+	 */
+	if( libcthreads_mutex_grab(
+	     server->mutex,
+	     NULL ) == 1 )
+	{
+		for( connection_index = 0;
+		     connection_index < MOUNT_NBD_MAXIMUM_NUMBER_OF_CONNECTIONS;
+		     connection_index++ )
+		{
+			if( server->connections[ connection_index ].is_active != 0 )
+			{
+				shutdown(
+				 server->connections[ connection_index ].socket_descriptor,
+				 SHUT_RDWR );
+			}
+		}
+		libcthreads_mutex_release(
+		 server->mutex,
+		 NULL );
+	}
+	for( connection_index = 0;
+	     connection_index < MOUNT_NBD_MAXIMUM_NUMBER_OF_CONNECTIONS;
+	     connection_index++ )
+	{
+		if( server->connections[ connection_index ].thread != NULL )
+		{
+			if( libcthreads_thread_join(
+			     &( server->connections[ connection_index ].thread ),
+			     ( result == 1 ) ? error : NULL ) != 1 )
+			{
+				if( result == 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to join connection: %d thread.",
+					 function,
+					 connection_index );
+				}
+				result = -1;
+			}
+		}
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	return( result );
+}
+
+/* Reads data from a socket
+ * Returns 1 if successful, 0 if the connection was closed or -1 on error
+ */
+int mount_nbd_read_data(
+     int socket_descriptor,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_nbd_read_data";
+	size_t data_offset    = 0;
+	ssize_t read_count    = 0;
+
+	if( socket_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid socket descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data == NULL )
+	 && ( data_size > 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( data_offset < data_size )
+	{
+		read_count = recv(
+		              socket_descriptor,
+		              &( data[ data_offset ] ),
+		              data_size - data_offset,
+		              0 );
+
+		if( read_count < 0 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			/* A connection reset by the client is handled as a closed connection
+			 */
+			if( errno == ECONNRESET )
+			{
+				return( 0 );
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 errno,
+			 "%s: unable to read data from socket.",
+			 function );
+
+			return( -1 );
+		}
+		if( read_count == 0 )
+		{
+			return( 0 );
+		}
+		data_offset += (size_t) read_count;
+	}
+	return( 1 );
+}
+
+/* Writes data to a socket
+ * Returns 1 if successful or -1 on error
+ */
+int mount_nbd_write_data(
+     int socket_descriptor,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_nbd_write_data";
+	size_t data_offset    = 0;
+	ssize_t write_count   = 0;
+
+	if( socket_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid socket descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data == NULL )
+	 && ( data_size > 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( data_offset < data_size )
+	{
+		/* MSG_NOSIGNAL prevents a SIGPIPE when the client has closed the connection
+		 */
+		write_count = send(
+		               socket_descriptor,
+		               &( data[ data_offset ] ),
+		               data_size - data_offset,
+		               MOUNT_NBD_SEND_FLAGS );
+
+		if( write_count < 0 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 errno,
+			 "%s: unable to write data to socket.",
+			 function );
+
+			return( -1 );
+		}
+		data_offset += (size_t) write_count;
+	}
+	return( 1 );
+}
+
+/* Writes an option reply
+ * Returns 1 if successful or -1 on error
+ */
+int mount_nbd_connection_write_option_reply(
+     mount_nbd_connection_t *connection,
+     uint32_t option,
+     uint32_t reply_type,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t reply_header[ 20 ];
+
+	static char *function = "mount_nbd_connection_write_option_reply";
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) MOUNT_NBD_MAXIMUM_OPTION_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_big_endian(
+	 &( reply_header[ 0 ] ),
+	 MOUNT_NBD_OPTION_REPLY_MAGIC );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 8 ] ),
+	 option );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 12 ] ),
+	 reply_type );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 16 ] ),
+	 (uint32_t) data_size );
+
+	if( mount_nbd_write_data(
+	     connection->socket_descriptor,
+	     reply_header,
+	     20,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write option reply header.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > 0 )
+	{
+		if( mount_nbd_write_data(
+		     connection->socket_descriptor,
+		     data,
+		     data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write option reply data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Negotiates the export with the client using the fixed newstyle handshake
+ * Only a single export is provided, the export name requested by the client is ignored
+ * Returns 1 if the transmission phase was entered, 0 if the client ended the negotiation or -1 on error
+ */
+int mount_nbd_connection_negotiate(
+     mount_nbd_connection_t *connection,
+     libcerror_error_t **error )
+{
+	uint8_t handshake_data[ 18 ];
+	uint8_t option_data[ MOUNT_NBD_MAXIMUM_OPTION_SIZE ];
+	uint8_t option_header[ 16 ];
+	uint8_t reply_data[ 134 ];
+
+	static char *function         = "mount_nbd_connection_negotiate";
+	uint64_t option_magic         = 0;
+	uint32_t client_flags         = 0;
+	uint32_t option               = 0;
+	uint32_t option_size          = 0;
+	uint16_t transmission_flags   = 0;
+	int result                    = 0;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( connection->server == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid connection - missing server.",
+		 function );
+
+		return( -1 );
+	}
+	/* Multiple connections see the same data since all reads and writes
+	 * go through the same handle and overlay
+	 */
+	transmission_flags = MOUNT_NBD_FLAG_HAS_FLAGS | MOUNT_NBD_FLAG_CAN_MULTI_CONN;
+
+	if( connection->server->overlay == NULL )
+	{
+		transmission_flags |= MOUNT_NBD_FLAG_READ_ONLY;
+	}
+	else
+	{
+		transmission_flags |= MOUNT_NBD_FLAG_SEND_FLUSH | MOUNT_NBD_FLAG_SEND_TRIM;
+	}
+	byte_stream_copy_from_uint64_big_endian(
+	 &( handshake_data[ 0 ] ),
+	 MOUNT_NBD_INITIAL_MAGIC );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( handshake_data[ 8 ] ),
+	 MOUNT_NBD_OPTION_MAGIC );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( handshake_data[ 16 ] ),
+	 MOUNT_NBD_FLAG_FIXED_NEWSTYLE | MOUNT_NBD_FLAG_NO_ZEROES );
+
+	if( mount_nbd_write_data(
+	     connection->socket_descriptor,
+	     handshake_data,
+	     18,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write handshake.",
+		 function );
+
+		return( -1 );
+	}
+	result = mount_nbd_read_data(
+	          connection->socket_descriptor,
+	          handshake_data,
+	          4,
+	          error );
+
+	if( result != 1 )
+	{
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read client flags.",
+			 function );
+		}
+		return( result );
+	}
+	byte_stream_copy_to_uint32_big_endian(
+	 handshake_data,
+	 client_flags );
+
+	while( connection->server->abort == 0 )
+	{
+		result = mount_nbd_read_data(
+		          connection->socket_descriptor,
+		          option_header,
+		          16,
+		          error );
+
+		if( result != 1 )
+		{
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read option header.",
+				 function );
+			}
+			return( result );
+		}
+		byte_stream_copy_to_uint64_big_endian(
+		 &( option_header[ 0 ] ),
+		 option_magic );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 &( option_header[ 8 ] ),
+		 option );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 &( option_header[ 12 ] ),
+		 option_size );
+
+		if( ( option_magic != MOUNT_NBD_OPTION_MAGIC )
+		 || ( option_size > (uint32_t) MOUNT_NBD_MAXIMUM_OPTION_SIZE ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_INPUT,
+			 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+			 "%s: unsupported option header.",
+			 function );
+
+			return( -1 );
+		}
+		if( option_size > 0 )
+		{
+			result = mount_nbd_read_data(
+			          connection->socket_descriptor,
+			          option_data,
+			          (size_t) option_size,
+			          error );
+
+			if( result != 1 )
+			{
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read option data.",
+					 function );
+				}
+				return( result );
+			}
+		}
+		switch( option )
+		{
+			case MOUNT_NBD_OPT_EXPORT_NAME:
+				byte_stream_copy_from_uint64_big_endian(
+				 &( reply_data[ 0 ] ),
+				 connection->server->media_size );
+
+				byte_stream_copy_from_uint16_big_endian(
+				 &( reply_data[ 8 ] ),
+				 transmission_flags );
+
+				if( memory_set(
+				     &( reply_data[ 10 ] ),
+				     0,
+				     124 ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to clear reply data.",
+					 function );
+
+					return( -1 );
+				}
+				if( mount_nbd_write_data(
+				     connection->socket_descriptor,
+				     reply_data,
+				     ( ( client_flags & MOUNT_NBD_FLAG_C_NO_ZEROES ) != 0 ) ? 10 : 134,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write export information.",
+					 function );
+
+					return( -1 );
+				}
+				return( 1 );
+
+			case MOUNT_NBD_OPT_ABORT:
+				if( mount_nbd_connection_write_option_reply(
+				     connection,
+				     option,
+				     MOUNT_NBD_REP_ACK,
+				     NULL,
+				     0,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write abort reply.",
+					 function );
+
+					return( -1 );
+				}
+				return( 0 );
+
+			case MOUNT_NBD_OPT_LIST:
+				/* The single export has an empty name, which is the default export
+				 */
+				byte_stream_copy_from_uint32_big_endian(
+				 &( reply_data[ 0 ] ),
+				 0 );
+
+				if( mount_nbd_connection_write_option_reply(
+				     connection,
+				     option,
+				     MOUNT_NBD_REP_SERVER,
+				     reply_data,
+				     4,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write list reply.",
+					 function );
+
+					return( -1 );
+				}
+				if( mount_nbd_connection_write_option_reply(
+				     connection,
+				     option,
+				     MOUNT_NBD_REP_ACK,
+				     NULL,
+				     0,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write list reply.",
+					 function );
+
+					return( -1 );
+				}
+				break;
+
+			case MOUNT_NBD_OPT_INFO:
+			case MOUNT_NBD_OPT_GO:
+				byte_stream_copy_from_uint16_big_endian(
+				 &( reply_data[ 0 ] ),
+				 MOUNT_NBD_INFO_EXPORT );
+
+				byte_stream_copy_from_uint64_big_endian(
+				 &( reply_data[ 2 ] ),
+				 connection->server->media_size );
+
+				byte_stream_copy_from_uint16_big_endian(
+				 &( reply_data[ 10 ] ),
+				 transmission_flags );
+
+				if( mount_nbd_connection_write_option_reply(
+				     connection,
+				     option,
+				     MOUNT_NBD_REP_INFO,
+				     reply_data,
+				     12,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write export information reply.",
+					 function );
+
+					return( -1 );
+				}
+				/* The chunk size is the preferred block size so that the client
+				 * issues requests that do not straddle chunk boundaries
+				 */
+				byte_stream_copy_from_uint16_big_endian(
+				 &( reply_data[ 0 ] ),
+				 MOUNT_NBD_INFO_BLOCK_SIZE );
+
+				byte_stream_copy_from_uint32_big_endian(
+				 &( reply_data[ 2 ] ),
+				 1 );
+
+				byte_stream_copy_from_uint32_big_endian(
+				 &( reply_data[ 6 ] ),
+				 connection->server->chunk_size );
+
+				byte_stream_copy_from_uint32_big_endian(
+				 &( reply_data[ 10 ] ),
+				 MOUNT_NBD_MAXIMUM_REQUEST_SIZE );
+
+				if( mount_nbd_connection_write_option_reply(
+				     connection,
+				     option,
+				     MOUNT_NBD_REP_INFO,
+				     reply_data,
+				     14,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write block size information reply.",
+					 function );
+
+					return( -1 );
+				}
+				if( mount_nbd_connection_write_option_reply(
+				     connection,
+				     option,
+				     MOUNT_NBD_REP_ACK,
+				     NULL,
+				     0,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write acknowledge reply.",
+					 function );
+
+					return( -1 );
+				}
+				if( option == MOUNT_NBD_OPT_GO )
+				{
+					return( 1 );
+				}
+				break;
+
+			default:
+				if( mount_nbd_connection_write_option_reply(
+				     connection,
+				     option,
+				     MOUNT_NBD_REP_ERR_UNSUP,
+				     NULL,
+				     0,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write unsupported option reply.",
+					 function );
+
+					return( -1 );
+				}
+				break;
+		}
+	}
+	return( 0 );
+}
+
+/* Serves the requests of the client in the transmission phase
+ * Returns 1 if the client disconnected or -1 on error
+ */
+int mount_nbd_connection_serve(
+     mount_nbd_connection_t *connection,
+     libcerror_error_t **error )
+{
+	uint8_t reply_header[ 16 ];
+	uint8_t request_header[ 28 ];
+
+	uint8_t *reallocation          = NULL;
+	static char *function          = "mount_nbd_connection_serve";
+	ssize_t read_count             = 0;
+	ssize_t write_count            = 0;
+	uint64_t request_handle        = 0;
+	uint64_t request_offset        = 0;
+	uint32_t reply_error           = 0;
+	uint32_t request_magic         = 0;
+	uint32_t request_size          = 0;
+	uint16_t request_type          = 0;
+	int result                     = 0;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( connection->server == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid connection - missing server.",
+		 function );
+
+		return( -1 );
+	}
+	while( connection->server->abort == 0 )
+	{
+		result = mount_nbd_read_data(
+		          connection->socket_descriptor,
+		          request_header,
+		          28,
+		          error );
+
+		if( result != 1 )
+		{
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read request header.",
+				 function );
+
+				return( -1 );
+			}
+			break;
+		}
+		byte_stream_copy_to_uint32_big_endian(
+		 &( request_header[ 0 ] ),
+		 request_magic );
+
+		byte_stream_copy_to_uint16_big_endian(
+		 &( request_header[ 6 ] ),
+		 request_type );
+
+		byte_stream_copy_to_uint64_big_endian(
+		 &( request_header[ 8 ] ),
+		 request_handle );
+
+		byte_stream_copy_to_uint64_big_endian(
+		 &( request_header[ 16 ] ),
+		 request_offset );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 &( request_header[ 24 ] ),
+		 request_size );
+
+		if( request_magic != MOUNT_NBD_REQUEST_MAGIC )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_INPUT,
+			 LIBCERROR_INPUT_ERROR_SIGNATURE_MISMATCH,
+			 "%s: unsupported request magic: 0x%08" PRIx32 ".",
+			 function,
+			 request_magic );
+
+			return( -1 );
+		}
+		if( request_type == MOUNT_NBD_CMD_DISC )
+		{
+			break;
+		}
+		/* The write payload must always be consumed to keep the stream in sync
+		 * hence a write that exceeds the maximum request size ends the connection
+		 */
+		if( request_size > (uint32_t) MOUNT_NBD_MAXIMUM_REQUEST_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid request size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( ( request_type == MOUNT_NBD_CMD_READ )
+		  ||  ( request_type == MOUNT_NBD_CMD_WRITE ) )
+		 && ( (size_t) request_size > connection->buffer_size ) )
+		{
+			reallocation = (uint8_t *) memory_reallocate(
+			                            connection->buffer,
+			                            sizeof( uint8_t ) * request_size );
+
+			if( reallocation == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize buffer.",
+				 function );
+
+				return( -1 );
+			}
+			connection->buffer      = reallocation;
+			connection->buffer_size = (size_t) request_size;
+		}
+		if( request_type == MOUNT_NBD_CMD_WRITE )
+		{
+			result = mount_nbd_read_data(
+			          connection->socket_descriptor,
+			          connection->buffer,
+			          (size_t) request_size,
+			          error );
+
+			if( result != 1 )
+			{
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read write request data.",
+					 function );
+
+					return( -1 );
+				}
+				break;
+			}
+		}
+		reply_error = 0;
+
+		if( ( request_offset > connection->server->media_size )
+		 || ( (size64_t) request_size > ( connection->server->media_size - request_offset ) ) )
+		{
+			reply_error = ( request_type == MOUNT_NBD_CMD_WRITE ) ? MOUNT_NBD_ENOSPC : MOUNT_NBD_EINVAL;
+		}
+		else switch( request_type )
+		{
+			case MOUNT_NBD_CMD_READ:
+				if( connection->server->overlay != NULL )
+				{
+					read_count = mount_overlay_read_buffer_at_offset(
+					              connection->server->overlay,
+					              connection->server->ewf_handle,
+					              connection->buffer,
+					              (size_t) request_size,
+					              (off64_t) request_offset,
+					              error );
+				}
+				else
+				{
+					/* The concurrent read unpacks chunks outside the handle lock
+					 * so that the requests of multiple connections are not serialized
+					 */
+					read_count = libewf_handle_read_buffer_at_offset_concurrent(
+					              connection->server->ewf_handle,
+					              connection->buffer,
+					              (size_t) request_size,
+					              (off64_t) request_offset,
+					              error );
+				}
+				if( read_count != (ssize_t) request_size )
+				{
+#if defined( HAVE_VERBOSE_OUTPUT )
+					if( ( libcnotify_verbose != 0 )
+					 && ( error != NULL )
+					 && ( *error != NULL ) )
+					{
+						libcnotify_print_error_backtrace(
+						 *error );
+					}
+#endif
+					libcerror_error_free(
+					 error );
+
+					reply_error = MOUNT_NBD_EIO;
+				}
+				break;
+
+			case MOUNT_NBD_CMD_WRITE:
+				if( connection->server->overlay == NULL )
+				{
+					reply_error = MOUNT_NBD_EPERM;
+
+					break;
+				}
+				write_count = mount_overlay_write_buffer_at_offset(
+				               connection->server->overlay,
+				               connection->server->ewf_handle,
+				               connection->buffer,
+				               (size_t) request_size,
+				               (off64_t) request_offset,
+				               error );
+
+				if( write_count != (ssize_t) request_size )
+				{
+#if defined( HAVE_VERBOSE_OUTPUT )
+					if( ( libcnotify_verbose != 0 )
+					 && ( error != NULL )
+					 && ( *error != NULL ) )
+					{
+						libcnotify_print_error_backtrace(
+						 *error );
+					}
+#endif
+					libcerror_error_free(
+					 error );
+
+					reply_error = MOUNT_NBD_EIO;
+				}
+				break;
+
+			/* The overlay is not retained across mounts, hence a flush has nothing to persist
+			 * and a trim, which is advisory, leaves the data unchanged
+			 */
+			case MOUNT_NBD_CMD_FLUSH:
+			case MOUNT_NBD_CMD_TRIM:
+				if( connection->server->overlay == NULL )
+				{
+					reply_error = MOUNT_NBD_EPERM;
+				}
+				break;
+
+			default:
+				reply_error = MOUNT_NBD_EINVAL;
+				break;
+		}
+		byte_stream_copy_from_uint32_big_endian(
+		 &( reply_header[ 0 ] ),
+		 MOUNT_NBD_SIMPLE_REPLY_MAGIC );
+
+		byte_stream_copy_from_uint32_big_endian(
+		 &( reply_header[ 4 ] ),
+		 reply_error );
+
+		byte_stream_copy_from_uint64_big_endian(
+		 &( reply_header[ 8 ] ),
+		 request_handle );
+
+		if( mount_nbd_write_data(
+		     connection->socket_descriptor,
+		     reply_header,
+		     16,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write reply header.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( request_type == MOUNT_NBD_CMD_READ )
+		 && ( reply_error == 0 ) )
+		{
+			if( mount_nbd_write_data(
+			     connection->socket_descriptor,
+			     connection->buffer,
+			     (size_t) request_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write read reply data.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	return( 1 );
+}
+
+/* Handles a connection from negotiation until the client disconnects
+ * Returns 1 if successful or -1 on error
+ */
+int mount_nbd_connection_thread_function(
+     mount_nbd_connection_t *connection )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "mount_nbd_connection_thread_function";
+	int result               = 0;
+
+	if( connection == NULL )
+	{
+		return( -1 );
+	}
+	result = mount_nbd_connection_negotiate(
+	          connection,
+	          &error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to negotiate connection.",
+		 function );
+	}
+	else if( result == 1 )
+	{
+		result = mount_nbd_connection_serve(
+		          connection,
+		          &error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to serve connection.",
+			 function );
+		}
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+
+		result = -1;
+	}
+	else
+	{
+		result = 1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The connection is marked inactive while holding the mutex so that
+	 * the server does not shut down a socket descriptor that was closed
+	 */
+	libcthreads_mutex_grab(
+	 connection->server->mutex,
+	 NULL );
+#endif
+	close(
+	 connection->socket_descriptor );
+
+	connection->socket_descriptor = -1;
+	connection->is_active         = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 connection->server->mutex,
+	 NULL );
+#endif
+	return( result );
+}
+
+#endif /* defined( HAVE_MOUNT_NBD ) */
+
@@ -0,0 +1,196 @@
+/*
+ * Mount tool network block device (NBD) functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _MOUNT_NBD_H )
+#define _MOUNT_NBD_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libewf.h"
+#include "mount_handle.h"
+#include "mount_overlay.h"
+
+/* The NBD server is only available on systems with Unix domain sockets
+ */
+#if defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H ) && defined( HAVE_POLL_H ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+#define HAVE_MOUNT_NBD	1
+#endif
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_MOUNT_NBD )
+
+/* The maximum number of concurrent client connections
+ */
+#define MOUNT_NBD_MAXIMUM_NUMBER_OF_CONNECTIONS		16
+
+/* The maximum size of the data of a single request
+ */
+#define MOUNT_NBD_MAXIMUM_REQUEST_SIZE			( 32 * 1024 * 1024 )
+
+typedef struct mount_nbd_server mount_nbd_server_t;
+typedef struct mount_nbd_connection mount_nbd_connection_t;
+
+struct mount_nbd_connection
+{
+	/* The server
+	 */
+	mount_nbd_server_t *server;
+
+	/* The socket descriptor
+	 */
+	int socket_descriptor;
+
+	/* Value to indicate the connection is being served
+	 */
+	uint8_t is_active;
+
+	/* The data buffer
+	 */
+	uint8_t *buffer;
+
+	/* The data buffer size
+	 */
+	size_t buffer_size;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The connection thread
+	 */
+	libcthreads_thread_t *thread;
+#endif
+};
+
+/* The NBD server exports the media data as a block device over a Unix domain socket
+ *
+ * Every client connection is served by its own thread so that a client
+ * that uses multiple connections, such as nbd-client -C, reads chunks in parallel
+ */
+struct mount_nbd_server
+{
+	/* The handle
+	 */
+	libewf_handle_t *ewf_handle;
+
+	/* The overlay, where NULL represents read-only
+	 */
+	mount_overlay_t *overlay;
+
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The chunk size
+	 */
+	size32_t chunk_size;
+
+	/* The socket path
+	 */
+	const char *socket_path;
+
+	/* The listening socket descriptor
+	 */
+	int socket_descriptor;
+
+	/* The connections
+	 */
+	mount_nbd_connection_t connections[ MOUNT_NBD_MAXIMUM_NUMBER_OF_CONNECTIONS ];
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The mutex that protects the connection states
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+
+	/* Value to indicate the server should abort
+	 */
+	uint8_t abort;
+};
+
+int mount_nbd_server_initialize(
+     mount_nbd_server_t **server,
+     mount_handle_t *mount_handle,
+     libcerror_error_t **error );
+
+int mount_nbd_server_free(
+     mount_nbd_server_t **server,
+     libcerror_error_t **error );
+
+int mount_nbd_server_signal_abort(
+     mount_nbd_server_t *server,
+     libcerror_error_t **error );
+
+int mount_nbd_server_open(
+     mount_nbd_server_t *server,
+     const char *socket_path,
+     libcerror_error_t **error );
+
+int mount_nbd_server_close(
+     mount_nbd_server_t *server,
+     libcerror_error_t **error );
+
+int mount_nbd_server_run(
+     mount_nbd_server_t *server,
+     libcerror_error_t **error );
+
+int mount_nbd_read_data(
+     int socket_descriptor,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int mount_nbd_write_data(
+     int socket_descriptor,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int mount_nbd_connection_write_option_reply(
+     mount_nbd_connection_t *connection,
+     uint32_t option,
+     uint32_t reply_type,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int mount_nbd_connection_negotiate(
+     mount_nbd_connection_t *connection,
+     libcerror_error_t **error );
+
+int mount_nbd_connection_serve(
+     mount_nbd_connection_t *connection,
+     libcerror_error_t **error );
+
+int mount_nbd_connection_thread_function(
+     mount_nbd_connection_t *connection );
+
+#endif /* defined( HAVE_MOUNT_NBD ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _MOUNT_NBD_H ) */
+
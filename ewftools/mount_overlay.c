@@ -0,0 +1,975 @@
+/*
+ * Mount overlay
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcfile.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libewf.h"
+#include "mount_overlay.h"
+
+#define mount_overlay_block_is_set( overlay, block_index ) \
+	( ( ( overlay )->blocks_bitmap[ ( block_index ) / 8 ] & ( 1 << ( ( block_index ) % 8 ) ) ) != 0 )
+
+#define mount_overlay_block_set( overlay, block_index ) \
+	( overlay )->blocks_bitmap[ ( block_index ) / 8 ] |= (uint8_t) ( 1 << ( ( block_index ) % 8 ) )
+
+/* Creates a mount overlay
+ * Make sure the value overlay is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int mount_overlay_initialize(
+     mount_overlay_t **overlay,
+     size64_t media_size,
+     size32_t block_size,
+     libcerror_error_t **error )
+{
+	static char *function     = "mount_overlay_initialize";
+	size_t blocks_bitmap_size = 0;
+	uint64_t number_of_blocks = 0;
+
+	if( overlay == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid overlay.",
+		 function );
+
+		return( -1 );
+	}
+	if( *overlay != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid overlay value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_size > (size64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid media size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_size == 0 )
+	 || ( block_size > (size32_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_blocks = ( media_size + block_size - 1 ) / block_size;
+
+	if( ( number_of_blocks / 8 ) >= (uint64_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of blocks value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	blocks_bitmap_size = (size_t) ( ( number_of_blocks / 8 ) + 1 );
+
+	*overlay = memory_allocate_structure(
+	            mount_overlay_t );
+
+	if( *overlay == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create overlay.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *overlay,
+	     0,
+	     sizeof( mount_overlay_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear overlay.",
+		 function );
+
+		memory_free(
+		 *overlay );
+
+		*overlay = NULL;
+
+		return( -1 );
+	}
+	( *overlay )->blocks_bitmap = (uint8_t *) memory_allocate(
+	                                           sizeof( uint8_t ) * blocks_bitmap_size );
+
+	if( ( *overlay )->blocks_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create blocks bitmap.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *overlay )->blocks_bitmap,
+	     0,
+	     sizeof( uint8_t ) * blocks_bitmap_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear blocks bitmap.",
+		 function );
+
+		goto on_error;
+	}
+	( *overlay )->block_buffer = (uint8_t *) memory_allocate(
+	                                          sizeof( uint8_t ) * block_size );
+
+	if( ( *overlay )->block_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block buffer.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *overlay )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *overlay )->media_size       = media_size;
+	( *overlay )->block_size       = block_size;
+	( *overlay )->number_of_blocks = number_of_blocks;
+
+	return( 1 );
+
+on_error:
+	if( *overlay != NULL )
+	{
+		if( ( *overlay )->block_buffer != NULL )
+		{
+			memory_free(
+			 ( *overlay )->block_buffer );
+		}
+		if( ( *overlay )->blocks_bitmap != NULL )
+		{
+			memory_free(
+			 ( *overlay )->blocks_bitmap );
+		}
+		memory_free(
+		 *overlay );
+
+		*overlay = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a mount overlay
+ * Returns 1 if successful or -1 on error
+ */
+int mount_overlay_free(
+     mount_overlay_t **overlay,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_overlay_free";
+	int result            = 1;
+
+	if( overlay == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid overlay.",
+		 function );
+
+		return( -1 );
+	}
+	if( *overlay != NULL )
+	{
+		if( ( *overlay )->file != NULL )
+		{
+			if( mount_overlay_close(
+			     *overlay,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close overlay.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *overlay )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 ( *overlay )->block_buffer );
+
+		memory_free(
+		 ( *overlay )->blocks_bitmap );
+
+		memory_free(
+		 *overlay );
+
+		*overlay = NULL;
+	}
+	return( result );
+}
+
+/* Opens the overlay file
+ * An existing file is truncated since the blocks bitmap is not stored
+ * Returns 1 if successful or -1 on error
+ */
+int mount_overlay_open(
+     mount_overlay_t *overlay,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_overlay_open";
+	int result            = 0;
+
+	if( overlay == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid overlay.",
+		 function );
+
+		return( -1 );
+	}
+	if( overlay->file != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid overlay - file value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcfile_file_initialize(
+	     &( overlay->file ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libcfile_file_open_wide(
+	          overlay->file,
+	          filename,
+	          LIBCFILE_OPEN_READ_WRITE_TRUNCATE,
+	          error );
+#else
+	result = libcfile_file_open(
+	          overlay->file,
+	          filename,
+	          LIBCFILE_OPEN_READ_WRITE_TRUNCATE,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( overlay->file != NULL )
+	{
+		libcfile_file_free(
+		 &( overlay->file ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Closes the overlay file
+ * Returns the 0 if succesful or -1 on error
+ */
+int mount_overlay_close(
+     mount_overlay_t *overlay,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_overlay_close";
+	int result            = 0;
+
+	if( overlay == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid overlay.",
+		 function );
+
+		return( -1 );
+	}
+	if( overlay->file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid overlay - missing file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcfile_file_close(
+	     overlay->file,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		result = -1;
+	}
+	if( libcfile_file_free(
+	     &( overlay->file ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Reads data at a specific offset of the overlay file
+ * The overlay must be locked by the caller
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t mount_overlay_read_file(
+         mount_overlay_t *overlay,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "mount_overlay_read_file";
+	ssize_t read_count    = 0;
+
+	if( overlay == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid overlay.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcfile_file_seek_offset(
+	     overlay->file,
+	     offset,
+	     SEEK_SET,
+	     error ) != offset )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	read_count = libcfile_file_read_buffer(
+	              overlay->file,
+	              buffer,
+	              size,
+	              error );
+
+	if( read_count != (ssize_t) size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+/* Writes data at a specific offset of the overlay file
+ * The overlay must be locked by the caller
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t mount_overlay_write_file(
+         mount_overlay_t *overlay,
+         const uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "mount_overlay_write_file";
+	ssize_t write_count   = 0;
+
+	if( overlay == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid overlay.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcfile_file_seek_offset(
+	     overlay->file,
+	     offset,
+	     SEEK_SET,
+	     error ) != offset )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	write_count = libcfile_file_write_buffer(
+	               overlay->file,
+	               buffer,
+	               size,
+	               error );
+
+	if( write_count != (ssize_t) size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	return( write_count );
+}
+
+/* Reads media data at a specific offset
+ * The blocks that were written are read from the overlay file, the other blocks from the image
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t mount_overlay_read_buffer_at_offset(
+         mount_overlay_t *overlay,
+         libewf_handle_t *ewf_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "mount_overlay_read_buffer_at_offset";
+	size_t buffer_offset  = 0;
+	size_t read_size      = 0;
+	ssize_t read_count    = 0;
+	uint64_t block_index  = 0;
+	uint8_t is_set        = 0;
+	int result            = 1;
+
+	if( overlay == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid overlay.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= overlay->media_size )
+	{
+		return( 0 );
+	}
+	if( (size64_t) buffer_size > ( overlay->media_size - (size64_t) offset ) )
+	{
+		buffer_size = (size_t) ( overlay->media_size - (size64_t) offset );
+	}
+	while( buffer_offset < buffer_size )
+	{
+		block_index = (uint64_t) offset / overlay->block_size;
+		read_size   = (size_t) ( overlay->block_size - ( (uint64_t) offset % overlay->block_size ) );
+
+		if( read_size > ( buffer_size - buffer_offset ) )
+		{
+			read_size = buffer_size - buffer_offset;
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     overlay->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		/* Combine the adjacent blocks that are read from the same source
+		 */
+		is_set = (uint8_t) mount_overlay_block_is_set( overlay, block_index );
+
+		while( read_size < ( buffer_size - buffer_offset ) )
+		{
+			block_index++;
+
+			if( (uint8_t) mount_overlay_block_is_set( overlay, block_index ) != is_set )
+			{
+				break;
+			}
+			read_size += overlay->block_size;
+
+			if( read_size > ( buffer_size - buffer_offset ) )
+			{
+				read_size = buffer_size - buffer_offset;
+			}
+		}
+		if( is_set != 0 )
+		{
+			read_count = mount_overlay_read_file(
+			              overlay,
+			              &( buffer[ buffer_offset ] ),
+			              read_size,
+			              offset,
+			              error );
+
+			if( read_count < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read data from overlay file.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     overlay->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		if( result != 1 )
+		{
+			return( -1 );
+		}
+		/* The blocks that were not written are read from the image outside the lock
+		 */
+		if( is_set == 0 )
+		{
+			read_count = libewf_handle_read_buffer_at_offset_concurrent(
+			              ewf_handle,
+			              &( buffer[ buffer_offset ] ),
+			              read_size,
+			              offset,
+			              error );
+
+			if( read_count != (ssize_t) read_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read data from image.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		buffer_offset += read_size;
+		offset        += (off64_t) read_size;
+	}
+	return( (ssize_t) buffer_offset );
+}
+
+/* Writes media data at a specific offset
+ * The data is written to the overlay file, a block that is partially written for the
+ * first time is copied from the image first
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t mount_overlay_write_buffer_at_offset(
+         mount_overlay_t *overlay,
+         libewf_handle_t *ewf_handle,
+         const uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "mount_overlay_write_buffer_at_offset";
+	size64_t block_size   = 0;
+	size_t buffer_offset  = 0;
+	size_t write_size     = 0;
+	ssize_t read_count    = 0;
+	ssize_t write_count   = 0;
+	off64_t block_offset  = 0;
+	uint64_t block_index  = 0;
+	int result            = 1;
+
+	if( overlay == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid overlay.",
+		 function );
+
+		return( -1 );
+	}
+	if( overlay->file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid overlay - missing file.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	/* The size of the media data cannot be changed
+	 */
+	if( (size64_t) offset >= overlay->media_size )
+	{
+		return( 0 );
+	}
+	if( (size64_t) buffer_size > ( overlay->media_size - (size64_t) offset ) )
+	{
+		buffer_size = (size_t) ( overlay->media_size - (size64_t) offset );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     overlay->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	while( buffer_offset < buffer_size )
+	{
+		block_index  = (uint64_t) offset / overlay->block_size;
+		block_offset = (off64_t) ( block_index * overlay->block_size );
+		block_size   = overlay->media_size - (size64_t) block_offset;
+
+		if( block_size > (size64_t) overlay->block_size )
+		{
+			block_size = (size64_t) overlay->block_size;
+		}
+		write_size = (size_t) ( block_size - (size64_t) ( offset - block_offset ) );
+
+		if( write_size > ( buffer_size - buffer_offset ) )
+		{
+			write_size = buffer_size - buffer_offset;
+		}
+		if( ( mount_overlay_block_is_set( overlay, block_index ) == 0 )
+		 && ( write_size < (size_t) block_size ) )
+		{
+			read_count = libewf_handle_read_buffer_at_offset_concurrent(
+			              ewf_handle,
+			              overlay->block_buffer,
+			              (size_t) block_size,
+			              block_offset,
+			              error );
+
+			if( read_count != (ssize_t) block_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read block: %" PRIu64 " from image.",
+				 function,
+				 block_index );
+
+				result = -1;
+
+				break;
+			}
+			write_count = mount_overlay_write_file(
+			               overlay,
+			               overlay->block_buffer,
+			               (size_t) block_size,
+			               block_offset,
+			               error );
+
+			if( write_count < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to copy block: %" PRIu64 " to overlay file.",
+				 function,
+				 block_index );
+
+				result = -1;
+
+				break;
+			}
+		}
+		write_count = mount_overlay_write_file(
+		               overlay,
+		               &( buffer[ buffer_offset ] ),
+		               write_size,
+		               offset,
+		               error );
+
+		if( write_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write data to overlay file.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		mount_overlay_block_set( overlay, block_index );
+
+		buffer_offset += write_size;
+		offset        += (off64_t) write_size;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     overlay->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	return( (ssize_t) buffer_offset );
+}
+
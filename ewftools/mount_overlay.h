@@ -0,0 +1,130 @@
+/*
+ * Mount overlay
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _MOUNT_OVERLAY_H )
+#define _MOUNT_OVERLAY_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcfile.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libewf.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct mount_overlay mount_overlay_t;
+
+/* The mount overlay stores the data written to the mounted media data in a sparse file,
+ * keyed by block (chunk), so that the image itself is never modified
+ * A block is copied from the image into the overlay file when it is first written
+ */
+struct mount_overlay
+{
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The block size
+	 */
+	size32_t block_size;
+
+	/* The number of blocks
+	 */
+	uint64_t number_of_blocks;
+
+	/* The bitmap of the blocks that are stored in the overlay file
+	 */
+	uint8_t *blocks_bitmap;
+
+	/* The block buffer used to copy a block from the image
+	 */
+	uint8_t *block_buffer;
+
+	/* The overlay file
+	 */
+	libcfile_file_t *file;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The mutex that serializes the access to the overlay file and blocks bitmap
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int mount_overlay_initialize(
+     mount_overlay_t **overlay,
+     size64_t media_size,
+     size32_t block_size,
+     libcerror_error_t **error );
+
+int mount_overlay_free(
+     mount_overlay_t **overlay,
+     libcerror_error_t **error );
+
+int mount_overlay_open(
+     mount_overlay_t *overlay,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int mount_overlay_close(
+     mount_overlay_t *overlay,
+     libcerror_error_t **error );
+
+ssize_t mount_overlay_read_file(
+         mount_overlay_t *overlay,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+ssize_t mount_overlay_write_file(
+         mount_overlay_t *overlay,
+         const uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+ssize_t mount_overlay_read_buffer_at_offset(
+         mount_overlay_t *overlay,
+         libewf_handle_t *ewf_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+ssize_t mount_overlay_write_buffer_at_offset(
+         mount_overlay_t *overlay,
+         libewf_handle_t *ewf_handle,
+         const uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _MOUNT_OVERLAY_H ) */
+
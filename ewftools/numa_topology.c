@@ -0,0 +1,793 @@
+/*
+ * NUMA topology functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* The CPU affinity functions and macros require _GNU_SOURCE
+ */
+#if defined( __linux__ ) && !defined( _GNU_SOURCE )
+#define _GNU_SOURCE
+#endif
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_SCHED_H )
+#include <sched.h>
+#endif
+
+#include "ewftools_libcerror.h"
+#include "numa_topology.h"
+
+/* Creates a NUMA topology
+ * Make sure the value topology is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int numa_topology_initialize(
+     numa_topology_t **topology,
+     libcerror_error_t **error )
+{
+	static char *function = "numa_topology_initialize";
+	int cpu_index         = 0;
+
+	if( topology == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid topology.",
+		 function );
+
+		return( -1 );
+	}
+	if( *topology != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid topology value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*topology = memory_allocate_structure(
+	             numa_topology_t );
+
+	if( *topology == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create topology.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *topology,
+	     0,
+	     sizeof( numa_topology_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear topology.",
+		 function );
+
+		goto on_error;
+	}
+	for( cpu_index = 0;
+	     cpu_index < NUMA_TOPOLOGY_MAXIMUM_NUMBER_OF_CPUS;
+	     cpu_index++ )
+	{
+		( *topology )->cpu_node_indexes[ cpu_index ] = -1;
+	}
+	( *topology )->number_of_nodes = 1;
+
+	/* A topology that cannot be read is treated as a single node
+	 */
+	if( numa_topology_read(
+	     *topology,
+	     NULL ) != 1 )
+	{
+		( *topology )->number_of_nodes = 1;
+		( *topology )->number_of_cpus  = 0;
+	}
+	return( 1 );
+
+on_error:
+	if( *topology != NULL )
+	{
+		memory_free(
+		 *topology );
+
+		*topology = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a NUMA topology
+ * Returns 1 if successful or -1 on error
+ */
+int numa_topology_free(
+     numa_topology_t **topology,
+     libcerror_error_t **error )
+{
+	static char *function = "numa_topology_free";
+
+	if( topology == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid topology.",
+		 function );
+
+		return( -1 );
+	}
+	if( *topology != NULL )
+	{
+		memory_free(
+		 *topology );
+
+		*topology = NULL;
+	}
+	return( 1 );
+}
+
+/* Parses a range list string such as "0-3,8-11"
+ * Sets the flag of every value in the ranges that is smaller than the number of flags
+ * Returns 1 if successful or -1 on error
+ */
+int numa_topology_parse_range_list(
+     const char *string,
+     size_t string_size,
+     uint8_t *flags,
+     int number_of_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "numa_topology_parse_range_list";
+	size_t string_index   = 0;
+	int first_value       = 0;
+	int last_value        = 0;
+	int value             = 0;
+	int value_index       = 0;
+	uint8_t in_range      = 0;
+	uint8_t has_value     = 0;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid string size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_flags < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of flags value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	/* The terminating end of string also terminates the last range
+	 */
+	for( string_index = 0;
+	     string_index <= string_size;
+	     string_index++ )
+	{
+		if( ( string_index < string_size )
+		 && ( string[ string_index ] >= '0' )
+		 && ( string[ string_index ] <= '9' ) )
+		{
+			if( value > ( ( INT_MAX - 9 ) / 10 ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: invalid value exceeds maximum.",
+				 function );
+
+				return( -1 );
+			}
+			value *= 10;
+			value += (int) ( string[ string_index ] - '0' );
+
+			has_value = 1;
+		}
+		else if( ( string_index < string_size )
+		      && ( string[ string_index ] == '-' ) )
+		{
+			if( ( has_value == 0 )
+			 || ( in_range != 0 ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+				 "%s: unsupported range at index: %" PRIzd ".",
+				 function,
+				 string_index );
+
+				return( -1 );
+			}
+			first_value = value;
+			value       = 0;
+			has_value   = 0;
+			in_range    = 1;
+		}
+		else if( ( string_index == string_size )
+		      || ( string[ string_index ] == ',' )
+		      || ( string[ string_index ] == 0 )
+		      || ( string[ string_index ] == '\n' )
+		      || ( string[ string_index ] == '\r' ) )
+		{
+			if( has_value != 0 )
+			{
+				last_value = value;
+
+				if( in_range == 0 )
+				{
+					first_value = value;
+				}
+				for( value_index = first_value;
+				     ( value_index <= last_value ) && ( value_index < number_of_flags );
+				     value_index++ )
+				{
+					flags[ value_index ] = 1;
+				}
+			}
+			else if( in_range != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+				 "%s: unsupported range at index: %" PRIzd ".",
+				 function,
+				 string_index );
+
+				return( -1 );
+			}
+			value     = 0;
+			has_value = 0;
+			in_range  = 0;
+
+			if( ( string_index < string_size )
+			 && ( string[ string_index ] != ',' ) )
+			{
+				break;
+			}
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported character at index: %" PRIzd ".",
+			 function,
+			 string_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_NUMA_TOPOLOGY_SUPPORT )
+
+/* Reads a range list from a (sysfs) file
+ * Returns 1 if successful, 0 if the file could not be opened or -1 on error
+ */
+int numa_topology_read_range_list(
+     const char *path,
+     uint8_t *flags,
+     int number_of_flags,
+     libcerror_error_t **error )
+{
+	char range_list_string[ 1024 ];
+
+	FILE *file_stream     = NULL;
+	static char *function = "numa_topology_read_range_list";
+	int result            = 1;
+
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		return( -1 );
+	}
+	file_stream = file_stream_open(
+	               path,
+	               FILE_STREAM_OPEN_READ );
+
+	if( file_stream == NULL )
+	{
+		return( 0 );
+	}
+	if( file_stream_get_string(
+	     file_stream,
+	     range_list_string,
+	     1024 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read range list from: %s.",
+		 function,
+		 path );
+
+		result = -1;
+	}
+	else if( numa_topology_parse_range_list(
+	          range_list_string,
+	          narrow_string_length(
+	           range_list_string ),
+	          flags,
+	          number_of_flags,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to parse range list from: %s.",
+		 function,
+		 path );
+
+		result = -1;
+	}
+	file_stream_close(
+	 file_stream );
+
+	return( result );
+}
+
+#endif /* defined( HAVE_NUMA_TOPOLOGY_SUPPORT ) */
+
+/* Reads the NUMA topology of the system
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int numa_topology_read(
+     numa_topology_t *topology,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_NUMA_TOPOLOGY_SUPPORT )
+	char path[ 64 ];
+
+	uint8_t cpu_flags[ NUMA_TOPOLOGY_MAXIMUM_NUMBER_OF_CPUS ];
+	uint8_t node_flags[ 256 ];
+
+	int cpu_index         = 0;
+	int node_identifier   = 0;
+	int number_of_nodes   = 0;
+	int result            = 0;
+#endif
+	static char *function = "numa_topology_read";
+
+	if( topology == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid topology.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_NUMA_TOPOLOGY_SUPPORT )
+	if( memory_set(
+	     node_flags,
+	     0,
+	     256 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear node flags.",
+		 function );
+
+		return( -1 );
+	}
+	result = numa_topology_read_range_list(
+	          "/sys/devices/system/node/online",
+	          node_flags,
+	          256,
+	          error );
+
+	if( result != 1 )
+	{
+		return( result );
+	}
+	for( cpu_index = 0;
+	     cpu_index < NUMA_TOPOLOGY_MAXIMUM_NUMBER_OF_CPUS;
+	     cpu_index++ )
+	{
+		topology->cpu_node_indexes[ cpu_index ] = -1;
+	}
+	topology->number_of_cpus = 0;
+
+	for( node_identifier = 0;
+	     node_identifier < 256;
+	     node_identifier++ )
+	{
+		if( node_flags[ node_identifier ] == 0 )
+		{
+			continue;
+		}
+		/* Nodes beyond the maximum are folded onto the last node
+		 */
+		if( number_of_nodes < NUMA_TOPOLOGY_MAXIMUM_NUMBER_OF_NODES )
+		{
+			number_of_nodes++;
+		}
+		if( narrow_string_snprintf(
+		     path,
+		     64,
+		     "/sys/devices/system/node/node%d/cpulist",
+		     node_identifier ) < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set node: %d CPU list path.",
+			 function,
+			 node_identifier );
+
+			return( -1 );
+		}
+		if( memory_set(
+		     cpu_flags,
+		     0,
+		     NUMA_TOPOLOGY_MAXIMUM_NUMBER_OF_CPUS ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear CPU flags.",
+			 function );
+
+			return( -1 );
+		}
+		result = numa_topology_read_range_list(
+		          path,
+		          cpu_flags,
+		          NUMA_TOPOLOGY_MAXIMUM_NUMBER_OF_CPUS,
+		          error );
+
+		if( result != 1 )
+		{
+			return( result );
+		}
+		for( cpu_index = 0;
+		     ( cpu_index < NUMA_TOPOLOGY_MAXIMUM_NUMBER_OF_CPUS ) && ( cpu_index < CPU_SETSIZE );
+		     cpu_index++ )
+		{
+			if( cpu_flags[ cpu_index ] != 0 )
+			{
+				topology->cpu_node_indexes[ cpu_index ] = number_of_nodes - 1;
+
+				if( cpu_index >= topology->number_of_cpus )
+				{
+					topology->number_of_cpus = cpu_index + 1;
+				}
+			}
+		}
+	}
+	if( number_of_nodes == 0 )
+	{
+		return( 0 );
+	}
+	topology->number_of_nodes = number_of_nodes;
+
+	return( 1 );
+#else
+	return( 0 );
+#endif
+}
+
+/* Retrieves the number of nodes
+ * Returns 1 if successful or -1 on error
+ */
+int numa_topology_get_number_of_nodes(
+     numa_topology_t *topology,
+     int *number_of_nodes,
+     libcerror_error_t **error )
+{
+	static char *function = "numa_topology_get_number_of_nodes";
+
+	if( topology == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid topology.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_nodes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of nodes.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_nodes = topology->number_of_nodes;
+
+	return( 1 );
+}
+
+/* Sets the maximum number of nodes
+ * The CPUs of the nodes beyond the maximum are divided over the remaining nodes
+ * Returns 1 if successful or -1 on error
+ */
+int numa_topology_set_maximum_number_of_nodes(
+     numa_topology_t *topology,
+     int maximum_number_of_nodes,
+     libcerror_error_t **error )
+{
+	static char *function = "numa_topology_set_maximum_number_of_nodes";
+	int cpu_index         = 0;
+
+	if( topology == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid topology.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_nodes <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of nodes value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( topology->number_of_nodes > maximum_number_of_nodes )
+	{
+		for( cpu_index = 0;
+		     cpu_index < topology->number_of_cpus;
+		     cpu_index++ )
+		{
+			if( topology->cpu_node_indexes[ cpu_index ] >= maximum_number_of_nodes )
+			{
+				topology->cpu_node_indexes[ cpu_index ] %= maximum_number_of_nodes;
+			}
+		}
+		topology->number_of_nodes = maximum_number_of_nodes;
+	}
+	return( 1 );
+}
+
+/* Binds the current thread to the CPUs of a specific node
+ * The thread is not rebound if it already runs on one of the CPUs of the node
+ * Returns 1 if successful or -1 on error
+ */
+int numa_topology_bind_current_thread(
+     numa_topology_t *topology,
+     int node_index,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_NUMA_TOPOLOGY_SUPPORT )
+	cpu_set_t cpu_set;
+
+	int cpu_index         = 0;
+#endif
+	static char *function = "numa_topology_bind_current_thread";
+
+	if( topology == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid topology.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( node_index < 0 )
+	 || ( node_index >= topology->number_of_nodes ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid node index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_NUMA_TOPOLOGY_SUPPORT )
+	if( topology->number_of_nodes <= 1 )
+	{
+		return( 1 );
+	}
+	cpu_index = sched_getcpu();
+
+	if( ( cpu_index >= 0 )
+	 && ( cpu_index < topology->number_of_cpus )
+	 && ( topology->cpu_node_indexes[ cpu_index ] == node_index ) )
+	{
+		return( 1 );
+	}
+	CPU_ZERO(
+	 &cpu_set );
+
+	for( cpu_index = 0;
+	     cpu_index < topology->number_of_cpus;
+	     cpu_index++ )
+	{
+		if( topology->cpu_node_indexes[ cpu_index ] == node_index )
+		{
+			CPU_SET(
+			 cpu_index,
+			 &cpu_set );
+		}
+	}
+	if( sched_setaffinity(
+	     0,
+	     sizeof( cpu_set_t ),
+	     &cpu_set ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 errno,
+		 "%s: unable to bind thread to node: %d.",
+		 function,
+		 node_index );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Unbinds the current thread so that it can run on the CPUs of all nodes
+ * Returns 1 if successful or -1 on error
+ */
+int numa_topology_unbind_current_thread(
+     numa_topology_t *topology,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_NUMA_TOPOLOGY_SUPPORT )
+	cpu_set_t cpu_set;
+
+	int cpu_index         = 0;
+#endif
+	static char *function = "numa_topology_unbind_current_thread";
+
+	if( topology == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid topology.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_NUMA_TOPOLOGY_SUPPORT )
+	if( topology->number_of_nodes <= 1 )
+	{
+		return( 1 );
+	}
+	CPU_ZERO(
+	 &cpu_set );
+
+	for( cpu_index = 0;
+	     cpu_index < topology->number_of_cpus;
+	     cpu_index++ )
+	{
+		if( topology->cpu_node_indexes[ cpu_index ] >= 0 )
+		{
+			CPU_SET(
+			 cpu_index,
+			 &cpu_set );
+		}
+	}
+	if( sched_setaffinity(
+	     0,
+	     sizeof( cpu_set_t ),
+	     &cpu_set ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 errno,
+		 "%s: unable to unbind thread.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
@@ -0,0 +1,115 @@
+/*
+ * NUMA topology functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _NUMA_TOPOLOGY_H )
+#define _NUMA_TOPOLOGY_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && defined( __linux__ ) && defined( HAVE_SCHED_H ) && defined( HAVE_SCHED_GETCPU ) && defined( HAVE_SCHED_SETAFFINITY )
+#define HAVE_NUMA_TOPOLOGY_SUPPORT
+#endif
+
+#define NUMA_TOPOLOGY_MAXIMUM_NUMBER_OF_CPUS		1024
+#define NUMA_TOPOLOGY_MAXIMUM_NUMBER_OF_NODES		8
+
+typedef struct numa_topology numa_topology_t;
+
+/* The NUMA topology maps the CPUs onto the (online) NUMA nodes so that
+ * threads can be bound to the node that owns the memory they process
+ * Without NUMA support the topology consists of a single node
+ */
+struct numa_topology
+{
+	/* The number of nodes
+	 */
+	int number_of_nodes;
+
+	/* The number of CPUs
+	 */
+	int number_of_cpus;
+
+	/* The node index of every CPU or -1 if the CPU is not part of a node
+	 */
+	int cpu_node_indexes[ NUMA_TOPOLOGY_MAXIMUM_NUMBER_OF_CPUS ];
+};
+
+int numa_topology_initialize(
+     numa_topology_t **topology,
+     libcerror_error_t **error );
+
+int numa_topology_free(
+     numa_topology_t **topology,
+     libcerror_error_t **error );
+
+int numa_topology_parse_range_list(
+     const char *string,
+     size_t string_size,
+     uint8_t *flags,
+     int number_of_flags,
+     libcerror_error_t **error );
+
+#if defined( HAVE_NUMA_TOPOLOGY_SUPPORT )
+
+int numa_topology_read_range_list(
+     const char *path,
+     uint8_t *flags,
+     int number_of_flags,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_NUMA_TOPOLOGY_SUPPORT ) */
+
+int numa_topology_read(
+     numa_topology_t *topology,
+     libcerror_error_t **error );
+
+int numa_topology_get_number_of_nodes(
+     numa_topology_t *topology,
+     int *number_of_nodes,
+     libcerror_error_t **error );
+
+int numa_topology_set_maximum_number_of_nodes(
+     numa_topology_t *topology,
+     int maximum_number_of_nodes,
+     libcerror_error_t **error );
+
+int numa_topology_bind_current_thread(
+     numa_topology_t *topology,
+     int node_index,
+     libcerror_error_t **error );
+
+int numa_topology_unbind_current_thread(
+     numa_topology_t *topology,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _NUMA_TOPOLOGY_H ) */
+
@@ -0,0 +1,1131 @@
+/*
+ * Partition manifest functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <byte_stream.h>
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "partition_manifest.h"
+#include "range_digests.h"
+
+/* The partition manifest file starts with a 64-byte header that consists of:
+ * the signature, the partition index, the number of partitions, the media size,
+ * the partition offset, the partition size, the range size, the number of ranges
+ * and 8 reserved bytes, followed by the 32-byte SHA-256 of every range of the partition
+ * The values in the header are stored in little-endian
+ */
+const uint8_t partition_manifest_file_signature[ 8 ] = {
+	'e', 'w', 'f', 'p', 'm', 'n', 'f', 't' };
+
+/* Determines the offset and size of a specific partition
+ * The ranges are divided over the partitions as evenly as possible
+ * Returns 1 if successful or -1 on error
+ */
+int partition_manifest_get_partition(
+     size64_t media_size,
+     size64_t range_size,
+     uint32_t partition_index,
+     uint32_t number_of_partitions,
+     off64_t *partition_offset,
+     size64_t *partition_size,
+     libcerror_error_t **error )
+{
+	static char *function         = "partition_manifest_get_partition";
+	uint64_t first_range_index    = 0;
+	uint64_t number_of_ranges     = 0;
+	uint64_t partition_ranges     = 0;
+	uint64_t ranges_per_partition = 0;
+	uint64_t remaining_ranges     = 0;
+
+	if( ( media_size == 0 )
+	 || ( media_size > (size64_t) INT64_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid media size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( range_size == 0 )
+	 || ( range_size > (size64_t) INT64_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid range size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( partition_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( partition_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition size.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_ranges = media_size / range_size;
+
+	if( ( media_size % range_size ) != 0 )
+	{
+		number_of_ranges += 1;
+	}
+	if( ( number_of_partitions == 0 )
+	 || ( number_of_partitions > PARTITION_MANIFEST_MAXIMUM_NUMBER_OF_PARTITIONS )
+	 || ( (uint64_t) number_of_partitions > number_of_ranges ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of partitions value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( partition_index >= number_of_partitions )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid partition index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	ranges_per_partition = number_of_ranges / number_of_partitions;
+	remaining_ranges     = number_of_ranges % number_of_partitions;
+
+	/* The first partitions contain one of the remaining ranges each
+	 */
+	first_range_index = ( (uint64_t) partition_index * ranges_per_partition ) + partition_index;
+	partition_ranges  = ranges_per_partition + 1;
+
+	if( (uint64_t) partition_index >= remaining_ranges )
+	{
+		first_range_index -= partition_index - remaining_ranges;
+		partition_ranges  -= 1;
+	}
+	*partition_offset = (off64_t) ( first_range_index * range_size );
+	*partition_size   = media_size - (size64_t) *partition_offset;
+
+	if( *partition_size > ( partition_ranges * range_size ) )
+	{
+		*partition_size = partition_ranges * range_size;
+	}
+	return( 1 );
+}
+
+/* Creates a partition manifest
+ * Make sure the value partition_manifest is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int partition_manifest_initialize(
+     partition_manifest_t **partition_manifest,
+     size64_t media_size,
+     size64_t range_size,
+     uint32_t partition_index,
+     uint32_t number_of_partitions,
+     libcerror_error_t **error )
+{
+	static char *function = "partition_manifest_initialize";
+
+	if( partition_manifest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition manifest.",
+		 function );
+
+		return( -1 );
+	}
+	if( *partition_manifest != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid partition manifest value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*partition_manifest = memory_allocate_structure(
+	                       partition_manifest_t );
+
+	if( *partition_manifest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create partition manifest.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *partition_manifest,
+	     0,
+	     sizeof( partition_manifest_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear partition manifest.",
+		 function );
+
+		memory_free(
+		 *partition_manifest );
+
+		*partition_manifest = NULL;
+
+		return( -1 );
+	}
+	if( partition_manifest_get_partition(
+	     media_size,
+	     range_size,
+	     partition_index,
+	     number_of_partitions,
+	     &( ( *partition_manifest )->partition_offset ),
+	     &( ( *partition_manifest )->partition_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine partition: %" PRIu32 " of: %" PRIu32 ".",
+		 function,
+		 partition_index,
+		 number_of_partitions );
+
+		goto on_error;
+	}
+	if( range_digests_initialize(
+	     &( ( *partition_manifest )->range_digests ),
+	     range_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create range digests.",
+		 function );
+
+		goto on_error;
+	}
+	( *partition_manifest )->partition_index      = partition_index;
+	( *partition_manifest )->number_of_partitions = number_of_partitions;
+	( *partition_manifest )->media_size           = media_size;
+
+	return( 1 );
+
+on_error:
+	if( *partition_manifest != NULL )
+	{
+		memory_free(
+		 *partition_manifest );
+
+		*partition_manifest = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a partition manifest
+ * Returns 1 if successful or -1 on error
+ */
+int partition_manifest_free(
+     partition_manifest_t **partition_manifest,
+     libcerror_error_t **error )
+{
+	static char *function = "partition_manifest_free";
+	int result            = 1;
+
+	if( partition_manifest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition manifest.",
+		 function );
+
+		return( -1 );
+	}
+	if( *partition_manifest != NULL )
+	{
+		if( ( *partition_manifest )->range_digests != NULL )
+		{
+			if( range_digests_free(
+			     &( ( *partition_manifest )->range_digests ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free range digests.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *partition_manifest );
+
+		*partition_manifest = NULL;
+	}
+	return( result );
+}
+
+/* Updates the partition manifest with the next part of the partition data
+ * Returns 1 if successful or -1 on error
+ */
+int partition_manifest_update(
+     partition_manifest_t *partition_manifest,
+     const uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "partition_manifest_update";
+
+	if( partition_manifest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition manifest.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_digests_update(
+	     partition_manifest->range_digests,
+	     buffer,
+	     size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update range digests.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Finalizes the partition manifest
+ * Returns 1 if successful or -1 on error
+ */
+int partition_manifest_finalize(
+     partition_manifest_t *partition_manifest,
+     libcerror_error_t **error )
+{
+	static char *function = "partition_manifest_finalize";
+
+	if( partition_manifest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition manifest.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_digests_finalize(
+	     partition_manifest->range_digests,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize range digests.",
+		 function );
+
+		return( -1 );
+	}
+	if( partition_manifest->range_digests->media_size != partition_manifest->partition_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid partition manifest - size of hashed data does not match partition size.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads a partition manifest from a file
+ * Make sure the value partition_manifest is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int partition_manifest_read_file(
+     partition_manifest_t **partition_manifest,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	uint8_t digest[ RANGE_DIGESTS_DIGEST_SIZE ];
+	uint8_t file_header[ PARTITION_MANIFEST_FILE_HEADER_SIZE ];
+
+	FILE *file_stream             = NULL;
+	static char *function         = "partition_manifest_read_file";
+	size64_t data_size            = 0;
+	size64_t media_size           = 0;
+	size64_t partition_size       = 0;
+	size64_t range_size           = 0;
+	uint64_t number_of_ranges     = 0;
+	uint64_t partition_offset     = 0;
+	uint64_t range_index          = 0;
+	uint32_t number_of_partitions = 0;
+	uint32_t partition_index      = 0;
+
+	if( partition_manifest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition manifest.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	file_stream = file_stream_open_wide(
+	               filename,
+	               _SYSTEM_STRING( FILE_STREAM_BINARY_OPEN_READ ) );
+#else
+	file_stream = file_stream_open(
+	               filename,
+	               FILE_STREAM_BINARY_OPEN_READ );
+#endif
+	if( file_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
+		 function );
+
+		goto on_error;
+	}
+	if( file_stream_read(
+	     file_stream,
+	     file_header,
+	     PARTITION_MANIFEST_FILE_HEADER_SIZE ) != PARTITION_MANIFEST_FILE_HEADER_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file header.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_compare(
+	     file_header,
+	     partition_manifest_file_signature,
+	     8 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported file signature.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 &( file_header[ 8 ] ),
+	 partition_index );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( file_header[ 12 ] ),
+	 number_of_partitions );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( file_header[ 16 ] ),
+	 media_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( file_header[ 24 ] ),
+	 partition_offset );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( file_header[ 32 ] ),
+	 partition_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( file_header[ 40 ] ),
+	 range_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( file_header[ 48 ] ),
+	 number_of_ranges );
+
+	if( partition_manifest_initialize(
+	     partition_manifest,
+	     media_size,
+	     range_size,
+	     partition_index,
+	     number_of_partitions,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create partition manifest.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( partition_offset != (uint64_t) ( *partition_manifest )->partition_offset )
+	 || ( partition_size != ( *partition_manifest )->partition_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid partition offset or size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_ranges != ( ( partition_size + range_size - 1 ) / range_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of ranges value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	for( range_index = 0;
+	     range_index < number_of_ranges;
+	     range_index++ )
+	{
+		if( file_stream_read(
+		     file_stream,
+		     digest,
+		     RANGE_DIGESTS_DIGEST_SIZE ) != RANGE_DIGESTS_DIGEST_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read digest: %" PRIu64 ".",
+			 function,
+			 range_index );
+
+			goto on_error;
+		}
+		data_size = partition_size - ( range_index * range_size );
+
+		if( data_size > range_size )
+		{
+			data_size = range_size;
+		}
+		if( range_digests_append_digest(
+		     ( *partition_manifest )->range_digests,
+		     digest,
+		     RANGE_DIGESTS_DIGEST_SIZE,
+		     data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append digest: %" PRIu64 ".",
+			 function,
+			 range_index );
+
+			goto on_error;
+		}
+	}
+	if( file_stream_close(
+	     file_stream ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		file_stream = NULL;
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *partition_manifest != NULL )
+	{
+		partition_manifest_free(
+		 partition_manifest,
+		 NULL );
+	}
+	if( file_stream != NULL )
+	{
+		file_stream_close(
+		 file_stream );
+	}
+	return( -1 );
+}
+
+/* Writes the partition manifest to a file
+ * Returns 1 if successful or -1 on error
+ */
+int partition_manifest_write_file(
+     partition_manifest_t *partition_manifest,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	uint8_t file_header[ PARTITION_MANIFEST_FILE_HEADER_SIZE ];
+
+	FILE *file_stream     = NULL;
+	static char *function = "partition_manifest_write_file";
+	size_t digests_size   = 0;
+
+	if( partition_manifest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition manifest.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( partition_manifest->range_digests == NULL )
+	 || ( partition_manifest->range_digests->context != NULL )
+	 || ( partition_manifest->range_digests->media_size != partition_manifest->partition_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid partition manifest - not finalized.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     file_header,
+	     0,
+	     PARTITION_MANIFEST_FILE_HEADER_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file header.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     file_header,
+	     partition_manifest_file_signature,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy file signature.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 &( file_header[ 8 ] ),
+	 partition_manifest->partition_index );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( file_header[ 12 ] ),
+	 partition_manifest->number_of_partitions );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( file_header[ 16 ] ),
+	 partition_manifest->media_size );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( file_header[ 24 ] ),
+	 partition_manifest->partition_offset );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( file_header[ 32 ] ),
+	 partition_manifest->partition_size );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( file_header[ 40 ] ),
+	 partition_manifest->range_digests->range_size );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( file_header[ 48 ] ),
+	 partition_manifest->range_digests->number_of_ranges );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	file_stream = file_stream_open_wide(
+	               filename,
+	               _SYSTEM_STRING( FILE_STREAM_BINARY_OPEN_WRITE ) );
+#else
+	file_stream = file_stream_open(
+	               filename,
+	               FILE_STREAM_BINARY_OPEN_WRITE );
+#endif
+	if( file_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
+		 function );
+
+		goto on_error;
+	}
+	if( file_stream_write(
+	     file_stream,
+	     file_header,
+	     PARTITION_MANIFEST_FILE_HEADER_SIZE ) != PARTITION_MANIFEST_FILE_HEADER_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write file header.",
+		 function );
+
+		goto on_error;
+	}
+	digests_size = (size_t) partition_manifest->range_digests->number_of_ranges * RANGE_DIGESTS_DIGEST_SIZE;
+
+	if( file_stream_write(
+	     file_stream,
+	     partition_manifest->range_digests->digests,
+	     digests_size ) != digests_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write digests.",
+		 function );
+
+		goto on_error;
+	}
+	if( file_stream_close(
+	     file_stream ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	if( file_stream != NULL )
+	{
+		file_stream_close(
+		 file_stream );
+	}
+	return( -1 );
+}
+
+/* Combines the partition manifests in the files into the range digests of the media data
+ * The files can be specified in any order but must contain every partition exactly once
+ * Make sure the value range_digests is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int partition_manifest_combine_files(
+     system_character_t * const *filenames,
+     int number_of_filenames,
+     range_digests_t **range_digests,
+     libcerror_error_t **error )
+{
+	uint8_t digest[ RANGE_DIGESTS_DIGEST_SIZE ];
+
+	partition_manifest_t **partition_manifests = NULL;
+	partition_manifest_t *partition_manifest   = NULL;
+	static char *function                      = "partition_manifest_combine_files";
+	size64_t data_size                         = 0;
+	size64_t media_size                        = 0;
+	size64_t range_size                        = 0;
+	off64_t range_offset                       = 0;
+	uint64_t range_index                       = 0;
+	uint32_t number_of_partitions              = 0;
+	uint32_t partition_index                   = 0;
+	int filename_index                         = 0;
+
+	if( filenames == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filenames.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_filenames <= 0 )
+	 || ( number_of_filenames > PARTITION_MANIFEST_MAXIMUM_NUMBER_OF_PARTITIONS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of filenames value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_digests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range digests.",
+		 function );
+
+		return( -1 );
+	}
+	if( *range_digests != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid range digests value already set.",
+		 function );
+
+		return( -1 );
+	}
+	partition_manifests = (partition_manifest_t **) memory_allocate(
+	                                                 sizeof( partition_manifest_t * ) * number_of_filenames );
+
+	if( partition_manifests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create partition manifests.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     partition_manifests,
+	     0,
+	     sizeof( partition_manifest_t * ) * number_of_filenames ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear partition manifests.",
+		 function );
+
+		goto on_error;
+	}
+	/* Store the partition manifests by partition index
+	 */
+	for( filename_index = 0;
+	     filename_index < number_of_filenames;
+	     filename_index++ )
+	{
+		if( partition_manifest_read_file(
+		     &partition_manifest,
+		     filenames[ filename_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read partition manifest: %" PRIs_SYSTEM ".",
+			 function,
+			 filenames[ filename_index ] );
+
+			goto on_error;
+		}
+		if( filename_index == 0 )
+		{
+			number_of_partitions = partition_manifest->number_of_partitions;
+			media_size           = partition_manifest->media_size;
+			range_size           = partition_manifest->range_digests->range_size;
+		}
+		if( ( partition_manifest->number_of_partitions != (uint32_t) number_of_filenames )
+		 || ( partition_manifest->number_of_partitions != number_of_partitions )
+		 || ( partition_manifest->media_size != media_size )
+		 || ( partition_manifest->range_digests->range_size != range_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: partition manifest: %" PRIs_SYSTEM " does not belong to the same set.",
+			 function,
+			 filenames[ filename_index ] );
+
+			goto on_error;
+		}
+		partition_index = partition_manifest->partition_index;
+
+		if( partition_manifests[ partition_index ] != NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: partition: %" PRIu32 " was specified more than once.",
+			 function,
+			 partition_index );
+
+			goto on_error;
+		}
+		partition_manifests[ partition_index ] = partition_manifest;
+		partition_manifest                     = NULL;
+	}
+	if( range_digests_initialize(
+	     range_digests,
+	     range_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create range digests.",
+		 function );
+
+		goto on_error;
+	}
+	/* Since every partition was validated against the media size
+	 * the partitions are consecutive when combined in order
+	 */
+	for( partition_index = 0;
+	     partition_index < number_of_partitions;
+	     partition_index++ )
+	{
+		partition_manifest = partition_manifests[ partition_index ];
+
+		for( range_index = 0;
+		     range_index < partition_manifest->range_digests->number_of_ranges;
+		     range_index++ )
+		{
+			if( range_digests_get_range(
+			     partition_manifest->range_digests,
+			     range_index,
+			     &range_offset,
+			     &data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve partition: %" PRIu32 " range: %" PRIu64 ".",
+				 function,
+				 partition_index,
+				 range_index );
+
+				partition_manifest = NULL;
+
+				goto on_error;
+			}
+			if( range_digests_get_digest(
+			     partition_manifest->range_digests,
+			     range_index,
+			     digest,
+			     RANGE_DIGESTS_DIGEST_SIZE,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve partition: %" PRIu32 " digest: %" PRIu64 ".",
+				 function,
+				 partition_index,
+				 range_index );
+
+				partition_manifest = NULL;
+
+				goto on_error;
+			}
+			if( range_digests_append_digest(
+			     *range_digests,
+			     digest,
+			     RANGE_DIGESTS_DIGEST_SIZE,
+			     data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append partition: %" PRIu32 " digest: %" PRIu64 ".",
+				 function,
+				 partition_index,
+				 range_index );
+
+				partition_manifest = NULL;
+
+				goto on_error;
+			}
+		}
+	}
+	partition_manifest = NULL;
+
+	for( partition_index = 0;
+	     partition_index < number_of_partitions;
+	     partition_index++ )
+	{
+		if( partition_manifest_free(
+		     &( partition_manifests[ partition_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free partition manifest: %" PRIu32 ".",
+			 function,
+			 partition_index );
+
+			goto on_error;
+		}
+	}
+	memory_free(
+	 partition_manifests );
+
+	return( 1 );
+
+on_error:
+	if( *range_digests != NULL )
+	{
+		range_digests_free(
+		 range_digests,
+		 NULL );
+	}
+	if( partition_manifest != NULL )
+	{
+		partition_manifest_free(
+		 &partition_manifest,
+		 NULL );
+	}
+	if( partition_manifests != NULL )
+	{
+		for( filename_index = 0;
+		     filename_index < number_of_filenames;
+		     filename_index++ )
+		{
+			if( partition_manifests[ filename_index ] != NULL )
+			{
+				partition_manifest_free(
+				 &( partition_manifests[ filename_index ] ),
+				 NULL );
+			}
+		}
+		memory_free(
+		 partition_manifests );
+	}
+	return( -1 );
+}
+
@@ -0,0 +1,125 @@
+/*
+ * Partition manifest functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _PARTITION_MANIFEST_H )
+#define _PARTITION_MANIFEST_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "range_digests.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#define PARTITION_MANIFEST_FILE_HEADER_SIZE	64
+
+#define PARTITION_MANIFEST_MAXIMUM_NUMBER_OF_PARTITIONS	4096
+
+typedef struct partition_manifest partition_manifest_t;
+
+/* The partition manifest describes one of a number of disjoint partitions
+ * of the media data that are exported independently of each other
+ * A partition starts at a range boundary so that the range digests of
+ * all partitions together form the range digests of the media data
+ */
+struct partition_manifest
+{
+	/* The partition index
+	 */
+	uint32_t partition_index;
+
+	/* The number of partitions
+	 */
+	uint32_t number_of_partitions;
+
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The partition offset
+	 */
+	off64_t partition_offset;
+
+	/* The partition size
+	 */
+	size64_t partition_size;
+
+	/* The range digests of the partition
+	 */
+	range_digests_t *range_digests;
+};
+
+int partition_manifest_get_partition(
+     size64_t media_size,
+     size64_t range_size,
+     uint32_t partition_index,
+     uint32_t number_of_partitions,
+     off64_t *partition_offset,
+     size64_t *partition_size,
+     libcerror_error_t **error );
+
+int partition_manifest_initialize(
+     partition_manifest_t **partition_manifest,
+     size64_t media_size,
+     size64_t range_size,
+     uint32_t partition_index,
+     uint32_t number_of_partitions,
+     libcerror_error_t **error );
+
+int partition_manifest_free(
+     partition_manifest_t **partition_manifest,
+     libcerror_error_t **error );
+
+int partition_manifest_update(
+     partition_manifest_t *partition_manifest,
+     const uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error );
+
+int partition_manifest_finalize(
+     partition_manifest_t *partition_manifest,
+     libcerror_error_t **error );
+
+int partition_manifest_read_file(
+     partition_manifest_t **partition_manifest,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int partition_manifest_write_file(
+     partition_manifest_t *partition_manifest,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int partition_manifest_combine_files(
+     system_character_t * const *filenames,
+     int number_of_filenames,
+     range_digests_t **range_digests,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _PARTITION_MANIFEST_H ) */
+
@@ -27,15 +27,35 @@
 #include <sys/utsname.h>
 #endif
 
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_SYS_SYSCALL_H ) && defined( HAVE_UNISTD_H )
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 #include "ewftools_libcerror.h"
 #include "ewftools_libclocale.h"
 #include "ewftools_libuna.h"
+#include "ewftools_unused.h"
 #include "platform.h"
 
 #if !defined( LIBEWF_OPERATING_SYSTEM )
 #define LIBEWF_OPERATING_SYSTEM		"Unknown"
 #endif
 
+#if defined( HAVE_SYS_SYSCALL_H ) && defined( HAVE_UNISTD_H ) && defined( SYS_ioprio_set )
+#define HAVE_IOPRIO_SET
+
+/* The ioprio_set values, see linux/ioprio.h
+ */
+#define PLATFORM_IOPRIO_WHO_PROCESS	1
+#define PLATFORM_IOPRIO_CLASS_IDLE	3
+#define PLATFORM_IOPRIO_CLASS_SHIFT	13
+#endif
+
 /* Determines the operating system string
  * Returns 1 if successful or -1 on error
  */
@@ -265,3 +285,62 @@ int platform_get_operating_system(
 	return( 1 );
 }
 
+/* Sets the I/O priority of the process to the idle class, so that its reads and
+ * writes are only serviced when no other process uses the same device
+ * This function should be called before any threads are created, since on Linux
+ * the I/O priority applies to the calling thread and is inherited by new threads
+ * Returns 1 if successful, 0 if not supported or -1 on error
+ */
+int platform_set_idle_io_priority(
+     libcerror_error_t **error )
+{
+	static char *function = "platform_set_idle_io_priority";
+
+#if defined( WINAPI ) && ( WINVER >= 0x0600 )
+	DWORD error_code      = 0;
+
+	if( SetPriorityClass(
+	     GetCurrentProcess(),
+	     PROCESS_MODE_BACKGROUND_BEGIN ) == 0 )
+	{
+		error_code = GetLastError();
+
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 error_code,
+		 "%s: unable to set background processing mode.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+#elif defined( HAVE_IOPRIO_SET )
+	if( syscall(
+	     SYS_ioprio_set,
+	     PLATFORM_IOPRIO_WHO_PROCESS,
+	     0,
+	     PLATFORM_IOPRIO_CLASS_IDLE << PLATFORM_IOPRIO_CLASS_SHIFT ) == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 errno,
+		 "%s: unable to set I/O priority.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+#else
+	EWFTOOLS_UNREFERENCED_PARAMETER( function )
+	EWFTOOLS_UNREFERENCED_PARAMETER( error )
+
+	return( 0 );
+#endif
+}
+
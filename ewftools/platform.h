@@ -36,6 +36,9 @@ int platform_get_operating_system(
      size_t operating_system_string_size,
      libcerror_error_t **error );
 
+int platform_set_idle_io_priority(
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
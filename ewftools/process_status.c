@@ -39,6 +39,7 @@
 #include "ewftools_libclocale.h"
 #include "ewftools_libcnotify.h"
 #include "process_status.h"
+#include "stats_output.h"
 
 /* Creates process status information
  * Make sure the value process_status is referencing, is set to NULL
@@ -251,6 +252,33 @@ int process_status_free(
 	return( result );
 }
 
+/* Sets the statistics output
+ * The statistics output is written regardless if the status information is printed
+ * Returns 1 if successful or -1 on error
+ */
+int process_status_set_stats_output(
+     process_status_t *process_status,
+     stats_output_t *stats_output,
+     libcerror_error_t **error )
+{
+	static char *function = "process_status_set_stats_output";
+
+	if( process_status == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid process status.",
+		 function );
+
+		return( -1 );
+	}
+	process_status->stats_output = stats_output;
+
+	return( 1 );
+}
+
 /* Starts the process status information
  * Returns 1 if successful or -1 on error
  */
@@ -316,6 +344,22 @@ int process_status_start(
 
 		return( -1 );
 	}
+	if( process_status->stats_output != NULL )
+	{
+		if( stats_output_start(
+		     process_status->stats_output,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to start statistics output.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	if( ( process_status->output_stream != NULL )
 	 && ( process_status->print_status_information != 0 )
 	 && ( process_status->status_process_string != NULL ) )
@@ -373,6 +417,24 @@ int process_status_update(
 
 		return( -1 );
 	}
+	if( process_status->stats_output != NULL )
+	{
+		if( stats_output_update(
+		     process_status->stats_output,
+		     bytes_read,
+		     bytes_total,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update statistics output.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	if( ( process_status->output_stream != NULL )
 	 && ( process_status->print_status_information != 0 )
 	 && ( process_status->status_update_string != NULL ) )
@@ -531,6 +593,24 @@ int process_status_update_unknown_total(
 
 		return( -1 );
 	}
+	if( process_status->stats_output != NULL )
+	{
+		if( stats_output_update(
+		     process_status->stats_output,
+		     bytes_read,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update statistics output.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	if( ( process_status->output_stream != NULL )
 	 && ( process_status->print_status_information != 0 )
 	 && ( process_status->status_update_string != NULL ) )
@@ -642,6 +722,7 @@ int process_status_stop(
 	system_character_t time_string[ 32 ];
 
 	const system_character_t *status_string = NULL;
+	const char *stats_event                 = NULL;
 	static char *function                   = "process_status_start";
 	int64_t total_number_of_seconds         = 0;
 
@@ -682,6 +763,37 @@ int process_status_stop(
 
 		return( -1 );
 	}
+	if( process_status->stats_output != NULL )
+	{
+		if( status == PROCESS_STATUS_ABORTED )
+		{
+			stats_event = "aborted";
+		}
+		else if( status == PROCESS_STATUS_COMPLETED )
+		{
+			stats_event = "completed";
+		}
+		else
+		{
+			stats_event = "failed";
+		}
+		if( stats_output_write_record(
+		     process_status->stats_output,
+		     stats_event,
+		     bytes_total,
+		     bytes_total,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write statistics output record.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	if( ( process_status->output_stream != NULL )
 	 && ( process_status->print_status_information != 0 )
 	 && ( process_status->status_process_string != NULL ) )
@@ -27,6 +27,7 @@
 
 #include "ewftools_libcdatetime.h"
 #include "ewftools_libcerror.h"
+#include "stats_output.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -86,6 +87,10 @@ struct process_status
 	/* The last parts per million
 	 */
 	int64_t last_parts_per_million;
+
+	/* The statistics output, which is not managed by the process status
+	 */
+	stats_output_t *stats_output;
 };
 
 int process_status_initialize(
@@ -101,6 +106,11 @@ int process_status_free(
      process_status_t **process_status,
      libcerror_error_t **error );
 
+int process_status_set_stats_output(
+     process_status_t *process_status,
+     stats_output_t *stats_output,
+     libcerror_error_t **error );
+
 int process_status_start(
      process_status_t *process_status,
      libcerror_error_t **error );
@@ -0,0 +1,1153 @@
+/*
+ * Range digests functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <byte_stream.h>
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "range_digests.h"
+#include "sha256_context.h"
+
+/* The range digests file starts with a 32-byte header that consists of:
+ * the signature, the range size, the media size and the number of ranges
+ * followed by the 32-byte SHA-256 of every range
+ * The values in the header are stored in little-endian
+ */
+const uint8_t range_digests_file_signature[ 8 ] = {
+	'e', 'w', 'f', 'r', 'd', 'g', 's', 't' };
+
+/* Creates range digests
+ * Make sure the value range_digests is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int range_digests_initialize(
+     range_digests_t **range_digests,
+     size64_t range_size,
+     libcerror_error_t **error )
+{
+	static char *function = "range_digests_initialize";
+
+	if( range_digests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range digests.",
+		 function );
+
+		return( -1 );
+	}
+	if( *range_digests != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid range digests value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( range_size == 0 )
+	 || ( range_size > (size64_t) INT64_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid range size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*range_digests = memory_allocate_structure(
+	                  range_digests_t );
+
+	if( *range_digests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create range digests.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *range_digests,
+	     0,
+	     sizeof( range_digests_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear range digests.",
+		 function );
+
+		goto on_error;
+	}
+	( *range_digests )->range_size = range_size;
+
+	return( 1 );
+
+on_error:
+	if( *range_digests != NULL )
+	{
+		memory_free(
+		 *range_digests );
+
+		*range_digests = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees range digests
+ * Returns 1 if successful or -1 on error
+ */
+int range_digests_free(
+     range_digests_t **range_digests,
+     libcerror_error_t **error )
+{
+	static char *function = "range_digests_free";
+	int result            = 1;
+
+	if( range_digests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range digests.",
+		 function );
+
+		return( -1 );
+	}
+	if( *range_digests != NULL )
+	{
+		if( ( *range_digests )->context != NULL )
+		{
+			if( sha256_context_free(
+			     &( ( *range_digests )->context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free SHA256 context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *range_digests )->digests != NULL )
+		{
+			memory_free(
+			 ( *range_digests )->digests );
+		}
+		memory_free(
+		 *range_digests );
+
+		*range_digests = NULL;
+	}
+	return( result );
+}
+
+/* Appends the digest of a range
+ * Only the last range can be smaller than the range size
+ * Returns 1 if successful or -1 on error
+ */
+int range_digests_append_digest(
+     range_digests_t *range_digests,
+     const uint8_t *digest,
+     size_t digest_size,
+     size64_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t *reallocation             = NULL;
+	static char *function             = "range_digests_append_digest";
+	uint64_t maximum_number_of_ranges = 0;
+
+	if( range_digests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range digests.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_size != RANGE_DIGESTS_DIGEST_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported digest size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size == 0 )
+	 || ( data_size > range_digests->range_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_digests->media_size != ( range_digests->number_of_ranges * range_digests->range_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid range digests - last range is incomplete.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_digests->number_of_ranges >= range_digests->maximum_number_of_ranges )
+	{
+		maximum_number_of_ranges = range_digests->maximum_number_of_ranges * 2;
+
+		if( maximum_number_of_ranges == 0 )
+		{
+			maximum_number_of_ranges = 64;
+		}
+		if( maximum_number_of_ranges > (uint64_t) ( SSIZE_MAX / RANGE_DIGESTS_DIGEST_SIZE ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid maximum number of ranges value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		reallocation = (uint8_t *) memory_reallocate(
+		                            range_digests->digests,
+		                            sizeof( uint8_t ) * (size_t) maximum_number_of_ranges * RANGE_DIGESTS_DIGEST_SIZE );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize digests.",
+			 function );
+
+			return( -1 );
+		}
+		range_digests->digests                  = reallocation;
+		range_digests->maximum_number_of_ranges = maximum_number_of_ranges;
+	}
+	if( memory_copy(
+	     &( range_digests->digests[ range_digests->number_of_ranges * RANGE_DIGESTS_DIGEST_SIZE ] ),
+	     digest,
+	     RANGE_DIGESTS_DIGEST_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy digest.",
+		 function );
+
+		return( -1 );
+	}
+	range_digests->number_of_ranges += 1;
+	range_digests->media_size       += data_size;
+
+	return( 1 );
+}
+
+/* Retrieves the offset and size of a specific range
+ * Returns 1 if successful or -1 on error
+ */
+int range_digests_get_range(
+     range_digests_t *range_digests,
+     uint64_t range_index,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error )
+{
+	static char *function = "range_digests_get_range";
+	off64_t offset        = 0;
+
+	if( range_digests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range digests.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_index >= range_digests->number_of_ranges )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid range index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
+
+		return( -1 );
+	}
+	offset = (off64_t) ( range_index * range_digests->range_size );
+
+	*range_offset = offset;
+	*range_size   = range_digests->media_size - (size64_t) offset;
+
+	if( *range_size > range_digests->range_size )
+	{
+		*range_size = range_digests->range_size;
+	}
+	return( 1 );
+}
+
+/* Retrieves the digest of a specific range
+ * Returns 1 if successful or -1 on error
+ */
+int range_digests_get_digest(
+     range_digests_t *range_digests,
+     uint64_t range_index,
+     uint8_t *digest,
+     size_t digest_size,
+     libcerror_error_t **error )
+{
+	static char *function = "range_digests_get_digest";
+
+	if( range_digests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range digests.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_index >= range_digests->number_of_ranges )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid range index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_size < RANGE_DIGESTS_DIGEST_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid digest size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     digest,
+	     &( range_digests->digests[ range_index * RANGE_DIGESTS_DIGEST_SIZE ] ),
+	     RANGE_DIGESTS_DIGEST_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy digest.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Calculates the combined digest, which is the SHA-256 of the consecutive range digests
+ * The combined digest only depends on the media data and the range size, which allows
+ * it to be calculated from range digests that were calculated independently of each other
+ * Returns 1 if successful or -1 on error
+ */
+int range_digests_get_combined_digest(
+     range_digests_t *range_digests,
+     uint8_t *digest,
+     size_t digest_size,
+     libcerror_error_t **error )
+{
+	sha256_context_t *sha256_context = NULL;
+	static char *function            = "range_digests_get_combined_digest";
+
+	if( range_digests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range digests.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_digests->context != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid range digests - not finalized.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_size < RANGE_DIGESTS_DIGEST_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid digest size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( sha256_context_initialize(
+	     &sha256_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize SHA256 context.",
+		 function );
+
+		goto on_error;
+	}
+	if( range_digests->number_of_ranges > 0 )
+	{
+		if( sha256_context_update(
+		     sha256_context,
+		     range_digests->digests,
+		     (size_t) range_digests->number_of_ranges * RANGE_DIGESTS_DIGEST_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA256 context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( sha256_context_finalize(
+	     sha256_context,
+	     digest,
+	     digest_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize SHA256 context.",
+		 function );
+
+		goto on_error;
+	}
+	if( sha256_context_free(
+	     &sha256_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free SHA256 context.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( sha256_context != NULL )
+	{
+		sha256_context_free(
+		 &sha256_context,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Updates the range digests with the next part of the media data
+ * A digest is appended for every range that is completed
+ * Returns 1 if successful or -1 on error
+ */
+int range_digests_update(
+     range_digests_t *range_digests,
+     const uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error )
+{
+	uint8_t digest[ RANGE_DIGESTS_DIGEST_SIZE ];
+
+	static char *function = "range_digests_update";
+	size_t buffer_offset  = 0;
+	size_t update_size    = 0;
+
+	if( range_digests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range digests.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < size )
+	{
+		if( range_digests->context == NULL )
+		{
+			if( sha256_context_initialize(
+			     &( range_digests->context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize SHA256 context.",
+				 function );
+
+				return( -1 );
+			}
+			range_digests->context_data_size = 0;
+		}
+		update_size = size - buffer_offset;
+
+		if( (size64_t) update_size > ( range_digests->range_size - range_digests->context_data_size ) )
+		{
+			update_size = (size_t) ( range_digests->range_size - range_digests->context_data_size );
+		}
+		if( sha256_context_update(
+		     range_digests->context,
+		     &( buffer[ buffer_offset ] ),
+		     update_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA256 context.",
+			 function );
+
+			return( -1 );
+		}
+		buffer_offset                    += update_size;
+		range_digests->context_data_size += update_size;
+
+		if( range_digests->context_data_size == range_digests->range_size )
+		{
+			if( sha256_context_finalize(
+			     range_digests->context,
+			     digest,
+			     RANGE_DIGESTS_DIGEST_SIZE,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to finalize SHA256 context.",
+				 function );
+
+				return( -1 );
+			}
+			if( sha256_context_free(
+			     &( range_digests->context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free SHA256 context.",
+				 function );
+
+				return( -1 );
+			}
+			if( range_digests_append_digest(
+			     range_digests,
+			     digest,
+			     RANGE_DIGESTS_DIGEST_SIZE,
+			     range_digests->context_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append digest.",
+				 function );
+
+				return( -1 );
+			}
+			range_digests->context_data_size = 0;
+		}
+	}
+	return( 1 );
+}
+
+/* Finalizes the range digests, which appends the digest of the last range
+ * if it is smaller than the range size
+ * Returns 1 if successful or -1 on error
+ */
+int range_digests_finalize(
+     range_digests_t *range_digests,
+     libcerror_error_t **error )
+{
+	uint8_t digest[ RANGE_DIGESTS_DIGEST_SIZE ];
+
+	static char *function = "range_digests_finalize";
+
+	if( range_digests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range digests.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_digests->context == NULL )
+	{
+		return( 1 );
+	}
+	if( sha256_context_finalize(
+	     range_digests->context,
+	     digest,
+	     RANGE_DIGESTS_DIGEST_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize SHA256 context.",
+		 function );
+
+		return( -1 );
+	}
+	if( sha256_context_free(
+	     &( range_digests->context ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free SHA256 context.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_digests->context_data_size > 0 )
+	{
+		if( range_digests_append_digest(
+		     range_digests,
+		     digest,
+		     RANGE_DIGESTS_DIGEST_SIZE,
+		     range_digests->context_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append digest.",
+			 function );
+
+			return( -1 );
+		}
+		range_digests->context_data_size = 0;
+	}
+	return( 1 );
+}
+
+/* Reads range digests from a file
+ * Make sure the value range_digests is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int range_digests_read_file(
+     range_digests_t **range_digests,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	uint8_t file_header[ RANGE_DIGESTS_FILE_HEADER_SIZE ];
+
+	FILE *file_stream         = NULL;
+	static char *function     = "range_digests_read_file";
+	size64_t media_size       = 0;
+	size64_t range_size       = 0;
+	size_t digests_size       = 0;
+	uint64_t number_of_ranges = 0;
+
+	if( range_digests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range digests.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	file_stream = file_stream_open_wide(
+	               filename,
+	               _SYSTEM_STRING( FILE_STREAM_BINARY_OPEN_READ ) );
+#else
+	file_stream = file_stream_open(
+	               filename,
+	               FILE_STREAM_BINARY_OPEN_READ );
+#endif
+	if( file_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
+		 function );
+
+		goto on_error;
+	}
+	if( file_stream_read(
+	     file_stream,
+	     file_header,
+	     RANGE_DIGESTS_FILE_HEADER_SIZE ) != RANGE_DIGESTS_FILE_HEADER_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file header.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_compare(
+	     file_header,
+	     range_digests_file_signature,
+	     8 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported file signature.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_to_uint64_little_endian(
+	 &( file_header[ 8 ] ),
+	 range_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( file_header[ 16 ] ),
+	 media_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( file_header[ 24 ] ),
+	 number_of_ranges );
+
+	if( range_digests_initialize(
+	     range_digests,
+	     range_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create range digests.",
+		 function );
+
+		goto on_error;
+	}
+	if( media_size > (size64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid media size value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( number_of_ranges == 0 )
+	 || ( number_of_ranges > (uint64_t) ( SSIZE_MAX / RANGE_DIGESTS_DIGEST_SIZE ) )
+	 || ( ( ( media_size + range_size - 1 ) / range_size ) != number_of_ranges ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of ranges value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	digests_size = (size_t) number_of_ranges * RANGE_DIGESTS_DIGEST_SIZE;
+
+	( *range_digests )->digests = (uint8_t *) memory_allocate(
+	                                           sizeof( uint8_t ) * digests_size );
+
+	if( ( *range_digests )->digests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create digests.",
+		 function );
+
+		goto on_error;
+	}
+	( *range_digests )->maximum_number_of_ranges = number_of_ranges;
+
+	if( file_stream_read(
+	     file_stream,
+	     ( *range_digests )->digests,
+	     digests_size ) != digests_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read digests.",
+		 function );
+
+		goto on_error;
+	}
+	( *range_digests )->media_size       = media_size;
+	( *range_digests )->number_of_ranges = number_of_ranges;
+
+	if( file_stream_close(
+	     file_stream ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		file_stream = NULL;
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *range_digests != NULL )
+	{
+		range_digests_free(
+		 range_digests,
+		 NULL );
+	}
+	if( file_stream != NULL )
+	{
+		file_stream_close(
+		 file_stream );
+	}
+	return( -1 );
+}
+
+/* Writes the range digests to a file
+ * Returns 1 if successful or -1 on error
+ */
+int range_digests_write_file(
+     range_digests_t *range_digests,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	uint8_t file_header[ RANGE_DIGESTS_FILE_HEADER_SIZE ];
+
+	FILE *file_stream     = NULL;
+	static char *function = "range_digests_write_file";
+	size_t digests_size   = 0;
+
+	if( range_digests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range digests.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_digests->context != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid range digests - not finalized.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     file_header,
+	     range_digests_file_signature,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy file signature.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_little_endian(
+	 &( file_header[ 8 ] ),
+	 range_digests->range_size );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( file_header[ 16 ] ),
+	 range_digests->media_size );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( file_header[ 24 ] ),
+	 range_digests->number_of_ranges );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	file_stream = file_stream_open_wide(
+	               filename,
+	               _SYSTEM_STRING( FILE_STREAM_BINARY_OPEN_WRITE ) );
+#else
+	file_stream = file_stream_open(
+	               filename,
+	               FILE_STREAM_BINARY_OPEN_WRITE );
+#endif
+	if( file_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
+		 function );
+
+		goto on_error;
+	}
+	if( file_stream_write(
+	     file_stream,
+	     file_header,
+	     RANGE_DIGESTS_FILE_HEADER_SIZE ) != RANGE_DIGESTS_FILE_HEADER_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write file header.",
+		 function );
+
+		goto on_error;
+	}
+	digests_size = (size_t) range_digests->number_of_ranges * RANGE_DIGESTS_DIGEST_SIZE;
+
+	if( digests_size > 0 )
+	{
+		if( file_stream_write(
+		     file_stream,
+		     range_digests->digests,
+		     digests_size ) != digests_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write digests.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( file_stream_close(
+	     file_stream ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	if( file_stream != NULL )
+	{
+		file_stream_close(
+		 file_stream );
+	}
+	return( -1 );
+}
+
@@ -0,0 +1,140 @@
+/*
+ * Range digests functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _RANGE_DIGESTS_H )
+#define _RANGE_DIGESTS_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "sha256_context.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#define RANGE_DIGESTS_DEFAULT_RANGE_SIZE	( 64 * 1024 * 1024 )
+
+#define RANGE_DIGESTS_MINIMUM_RANGE_SIZE	( 1024 * 1024 )
+
+#define RANGE_DIGESTS_DIGEST_SIZE		32
+
+#define RANGE_DIGESTS_FILE_HEADER_SIZE		32
+
+typedef struct range_digests range_digests_t;
+
+/* The range digests contain the SHA-256 of every range of the media data
+ * so that the ranges can be verified independently of each other
+ */
+struct range_digests
+{
+	/* The range size
+	 */
+	size64_t range_size;
+
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The number of ranges
+	 */
+	uint64_t number_of_ranges;
+
+	/* The digests
+	 */
+	uint8_t *digests;
+
+	/* The number of ranges the digests can contain
+	 */
+	uint64_t maximum_number_of_ranges;
+
+	/* The SHA-256 context of the range that is being calculated
+	 */
+	sha256_context_t *context;
+
+	/* The size of the data of the range that is being calculated
+	 */
+	size64_t context_data_size;
+};
+
+int range_digests_initialize(
+     range_digests_t **range_digests,
+     size64_t range_size,
+     libcerror_error_t **error );
+
+int range_digests_free(
+     range_digests_t **range_digests,
+     libcerror_error_t **error );
+
+int range_digests_append_digest(
+     range_digests_t *range_digests,
+     const uint8_t *digest,
+     size_t digest_size,
+     size64_t data_size,
+     libcerror_error_t **error );
+
+int range_digests_get_range(
+     range_digests_t *range_digests,
+     uint64_t range_index,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error );
+
+int range_digests_get_digest(
+     range_digests_t *range_digests,
+     uint64_t range_index,
+     uint8_t *digest,
+     size_t digest_size,
+     libcerror_error_t **error );
+
+int range_digests_get_combined_digest(
+     range_digests_t *range_digests,
+     uint8_t *digest,
+     size_t digest_size,
+     libcerror_error_t **error );
+
+int range_digests_update(
+     range_digests_t *range_digests,
+     const uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error );
+
+int range_digests_finalize(
+     range_digests_t *range_digests,
+     libcerror_error_t **error );
+
+int range_digests_read_file(
+     range_digests_t **range_digests,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int range_digests_write_file(
+     range_digests_t *range_digests,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _RANGE_DIGESTS_H ) */
+
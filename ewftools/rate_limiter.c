@@ -0,0 +1,671 @@
+/*
+ * Rate limiter functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H ) || defined( WINAPI )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include <time.h>
+
+#include "byte_size_string.h"
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_timestamp.h"
+#include "rate_limiter.h"
+
+/* Creates a rate limiter
+ * Make sure the value rate_limiter is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int rate_limiter_initialize(
+     rate_limiter_t **rate_limiter,
+     size64_t rate,
+     libcerror_error_t **error )
+{
+	static char *function = "rate_limiter_initialize";
+
+	if( rate_limiter == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rate limiter.",
+		 function );
+
+		return( -1 );
+	}
+	if( *rate_limiter != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid rate limiter value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*rate_limiter = memory_allocate_structure(
+	                 rate_limiter_t );
+
+	if( *rate_limiter == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create rate limiter.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *rate_limiter,
+	     0,
+	     sizeof( rate_limiter_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear rate limiter.",
+		 function );
+
+		memory_free(
+		 *rate_limiter );
+
+		*rate_limiter = NULL;
+
+		return( -1 );
+	}
+	( *rate_limiter )->control_file_descriptor = -1;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *rate_limiter )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( rate_limiter_set_rate(
+	     *rate_limiter,
+	     rate,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set rate.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *rate_limiter != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *rate_limiter )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *rate_limiter )->mutex ),
+			 NULL );
+		}
+#endif
+		memory_free(
+		 *rate_limiter );
+
+		*rate_limiter = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a rate limiter
+ * The control file descriptor is not closed
+ * Returns 1 if successful or -1 on error
+ */
+int rate_limiter_free(
+     rate_limiter_t **rate_limiter,
+     libcerror_error_t **error )
+{
+	static char *function = "rate_limiter_free";
+	int result            = 1;
+
+	if( rate_limiter == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rate limiter.",
+		 function );
+
+		return( -1 );
+	}
+	if( *rate_limiter != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *rate_limiter )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *rate_limiter );
+
+		*rate_limiter = NULL;
+	}
+	return( result );
+}
+
+/* Suspends the calling thread for a duration in nano seconds
+ */
+void rate_limiter_sleep(
+      int64_t duration )
+{
+#if defined( HAVE_NANOSLEEP )
+	struct timespec time_structure;
+#endif
+
+	if( duration <= 0 )
+	{
+		return;
+	}
+#if defined( WINAPI )
+	Sleep(
+	 (DWORD) ( ( duration + 999999 ) / 1000000 ) );
+
+#elif defined( HAVE_NANOSLEEP )
+	time_structure.tv_sec  = (time_t) ( duration / 1000000000 );
+	time_structure.tv_nsec = (long) ( duration % 1000000000 );
+
+	while( nanosleep(
+	        &time_structure,
+	        &time_structure ) != 0 )
+	{
+		if( errno != EINTR )
+		{
+			break;
+		}
+	}
+#else
+	sleep(
+	 (unsigned int) ( ( duration + 999999999 ) / 1000000000 ) );
+#endif
+}
+
+/* Sets the rate in bytes per second, where 0 represents unlimited
+ * Returns 1 if successful, 0 if the rate is not supported or -1 on error
+ */
+int rate_limiter_set_rate(
+     rate_limiter_t *rate_limiter,
+     size64_t rate,
+     libcerror_error_t **error )
+{
+	static char *function = "rate_limiter_set_rate";
+	int64_t timestamp     = 0;
+
+	if( rate_limiter == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rate limiter.",
+		 function );
+
+		return( -1 );
+	}
+	/* The number of tokens of a burst period must fit in a 64-bit signed integer
+	 */
+	if( ( rate != 0 )
+	 && ( ( rate < RATE_LIMITER_MINIMUM_RATE )
+	  ||  ( rate > (size64_t) ( INT64_MAX / RATE_LIMITER_BURST_PERIOD ) ) ) )
+	{
+		return( 0 );
+	}
+	if( ewftools_timestamp_get_monotonic(
+	     &timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve timestamp.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     rate_limiter->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	rate_limiter->rate                     = rate;
+	rate_limiter->maximum_number_of_tokens = (int64_t) ( ( rate * RATE_LIMITER_BURST_PERIOD ) / 1000000000 );
+	rate_limiter->number_of_tokens         = 0;
+	rate_limiter->refill_timestamp         = timestamp;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     rate_limiter->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Consumes tokens for a number of bytes
+ * The tokens are taken from the bucket even if it goes into debt, the calling
+ * thread then sleeps until the debt is paid off by the refill, which spreads
+ * the data of multiple threads evenly over time
+ * Returns 1 if successful or -1 on error
+ */
+int rate_limiter_consume(
+     rate_limiter_t *rate_limiter,
+     size_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "rate_limiter_consume";
+	int64_t elapsed_time  = 0;
+	int64_t sleep_time    = 0;
+	int64_t timestamp     = 0;
+
+	if( rate_limiter == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rate limiter.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ewftools_timestamp_get_monotonic(
+	     &timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve timestamp.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     rate_limiter->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( rate_limiter->rate != 0 )
+	{
+		elapsed_time = timestamp - rate_limiter->refill_timestamp;
+
+		if( elapsed_time > 0 )
+		{
+			/* A refill of more than a burst period fills the bucket
+			 */
+			if( elapsed_time >= RATE_LIMITER_BURST_PERIOD )
+			{
+				rate_limiter->number_of_tokens += rate_limiter->maximum_number_of_tokens;
+			}
+			else
+			{
+				rate_limiter->number_of_tokens += (int64_t) ( ( rate_limiter->rate * (size64_t) elapsed_time ) / 1000000000 );
+			}
+			if( rate_limiter->number_of_tokens > rate_limiter->maximum_number_of_tokens )
+			{
+				rate_limiter->number_of_tokens = rate_limiter->maximum_number_of_tokens;
+			}
+			rate_limiter->refill_timestamp = timestamp;
+		}
+		rate_limiter->number_of_tokens -= (int64_t) size;
+
+		if( rate_limiter->number_of_tokens < 0 )
+		{
+			sleep_time = ( -rate_limiter->number_of_tokens * (int64_t) 1000000000 ) / (int64_t) rate_limiter->rate;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     rate_limiter->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	rate_limiter_sleep(
+	 sleep_time );
+
+	return( 1 );
+}
+
+/* Opens a control file descriptor from which new rates are read, one per line
+ * The file descriptor is made non-blocking and is not closed by the rate limiter
+ * Returns 1 if successful, 0 if not supported or -1 on error
+ */
+int rate_limiter_open_control_file_descriptor(
+     rate_limiter_t *rate_limiter,
+     int file_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "rate_limiter_open_control_file_descriptor";
+
+#if defined( HAVE_RATE_LIMITER_CONTROL )
+	int flags             = 0;
+#endif
+
+	if( rate_limiter == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rate limiter.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_descriptor < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid file descriptor value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_RATE_LIMITER_CONTROL )
+	flags = fcntl(
+	         file_descriptor,
+	         F_GETFL );
+
+	if( ( flags == -1 )
+	 || ( fcntl(
+	       file_descriptor,
+	       F_SETFL,
+	       flags | O_NONBLOCK ) == -1 ) )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to set file descriptor: %d non-blocking.",
+		 function,
+		 file_descriptor );
+
+		return( -1 );
+	}
+	rate_limiter->control_file_descriptor  = file_descriptor;
+	rate_limiter->control_buffer_data_size = 0;
+
+	return( 1 );
+#else
+	return( 0 );
+#endif
+}
+
+/* Reads the new rates that are available on the control file descriptor
+ * A line contains a rate in bytes per second, optionally with a unit such as MiB,
+ * where 0 represents unlimited. Invalid lines are ignored
+ * Returns 1 if the rate changed, 0 if not or -1 on error
+ */
+int rate_limiter_read_control(
+     rate_limiter_t *rate_limiter,
+     libcerror_error_t **error )
+{
+	static char *function = "rate_limiter_read_control";
+
+#if defined( HAVE_RATE_LIMITER_CONTROL )
+	uint64_t rate         = 0;
+	size_t buffer_index   = 0;
+	size_t line_length    = 0;
+	size_t line_start     = 0;
+	ssize_t read_count    = 0;
+	int rate_changed      = 0;
+	int result            = 0;
+#endif
+
+	if( rate_limiter == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rate limiter.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_RATE_LIMITER_CONTROL )
+	if( rate_limiter->control_file_descriptor == -1 )
+	{
+		return( 0 );
+	}
+	read_count = read(
+	              rate_limiter->control_file_descriptor,
+	              &( rate_limiter->control_buffer[ rate_limiter->control_buffer_data_size ] ),
+	              sizeof( rate_limiter->control_buffer ) - rate_limiter->control_buffer_data_size );
+
+	if( read_count < 0 )
+	{
+		if( ( errno == EAGAIN )
+		 || ( errno == EWOULDBLOCK )
+		 || ( errno == EINTR ) )
+		{
+			return( 0 );
+		}
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 errno,
+		 "%s: unable to read from control file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	/* The writer closed the control file descriptor, the current rate remains in effect
+	 */
+	if( read_count == 0 )
+	{
+		rate_limiter->control_file_descriptor = -1;
+
+		return( 0 );
+	}
+	rate_limiter->control_buffer_data_size += (size_t) read_count;
+
+	for( buffer_index = 0;
+	     buffer_index < rate_limiter->control_buffer_data_size;
+	     buffer_index++ )
+	{
+		if( rate_limiter->control_buffer[ buffer_index ] != '\n' )
+		{
+			continue;
+		}
+		line_length = buffer_index - line_start;
+
+		if( ( line_length > 0 )
+		 && ( rate_limiter->control_buffer[ buffer_index - 1 ] == '\r' ) )
+		{
+			line_length--;
+		}
+		if( line_length > 0 )
+		{
+			rate_limiter->control_buffer[ line_start + line_length ] = 0;
+
+			if( byte_size_string_convert(
+			     (system_character_t *) &( rate_limiter->control_buffer[ line_start ] ),
+			     line_length,
+			     &rate,
+			     error ) != 1 )
+			{
+#if defined( HAVE_VERBOSE_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "%s: unsupported rate: %s.\n",
+					 function,
+					 &( rate_limiter->control_buffer[ line_start ] ) );
+				}
+#endif
+				libcerror_error_free(
+				 error );
+			}
+			else
+			{
+				result = rate_limiter_set_rate(
+				          rate_limiter,
+				          (size64_t) rate,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set rate.",
+					 function );
+
+					return( -1 );
+				}
+				else if( result != 0 )
+				{
+					rate_changed = 1;
+				}
+			}
+		}
+		line_start = buffer_index + 1;
+	}
+	if( line_start > 0 )
+	{
+		rate_limiter->control_buffer_data_size -= line_start;
+
+		/* The partial line is moved to the start of the control buffer
+		 */
+		for( buffer_index = 0;
+		     buffer_index < rate_limiter->control_buffer_data_size;
+		     buffer_index++ )
+		{
+			rate_limiter->control_buffer[ buffer_index ] = rate_limiter->control_buffer[ line_start + buffer_index ];
+		}
+	}
+	/* A line that does not fit in the control buffer is discarded
+	 */
+	else if( rate_limiter->control_buffer_data_size >= sizeof( rate_limiter->control_buffer ) )
+	{
+		rate_limiter->control_buffer_data_size = 0;
+	}
+	return( rate_changed );
+#else
+	return( 0 );
+#endif
+}
+
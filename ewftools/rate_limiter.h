@@ -0,0 +1,126 @@
+/*
+ * Rate limiter functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _RATE_LIMITER_H )
+#define _RATE_LIMITER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if !defined( WINAPI ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) && defined( HAVE_FCNTL_H ) && defined( HAVE_UNISTD_H )
+#define HAVE_RATE_LIMITER_CONTROL
+#endif
+
+/* The minimum rate in bytes per second
+ */
+#define RATE_LIMITER_MINIMUM_RATE		( 64 * 1024 )
+
+/* The period of which the rate can be used at once, in nano seconds
+ * A small period keeps the data flow smooth instead of bursty
+ */
+#define RATE_LIMITER_BURST_PERIOD		( (int64_t) 100000000 )
+
+typedef struct rate_limiter rate_limiter_t;
+
+/* The rate limiter limits the throughput using a token bucket
+ * where a token represents a byte
+ */
+struct rate_limiter
+{
+	/* The rate in bytes per second, where 0 represents unlimited
+	 */
+	size64_t rate;
+
+	/* The maximum number of tokens in the bucket
+	 */
+	int64_t maximum_number_of_tokens;
+
+	/* The number of tokens in the bucket, which is negative when the bucket is in debt
+	 */
+	int64_t number_of_tokens;
+
+	/* The timestamp, in nano seconds, of the last refill of the bucket
+	 */
+	int64_t refill_timestamp;
+
+	/* The control file descriptor or -1 if not set
+	 */
+	int control_file_descriptor;
+
+	/* The buffer of the partially read control line
+	 */
+	char control_buffer[ 64 ];
+
+	/* The size of the data in the control buffer
+	 */
+	size_t control_buffer_data_size;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The mutex that protects the bucket
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int rate_limiter_initialize(
+     rate_limiter_t **rate_limiter,
+     size64_t rate,
+     libcerror_error_t **error );
+
+int rate_limiter_free(
+     rate_limiter_t **rate_limiter,
+     libcerror_error_t **error );
+
+void rate_limiter_sleep(
+      int64_t duration );
+
+int rate_limiter_set_rate(
+     rate_limiter_t *rate_limiter,
+     size64_t rate,
+     libcerror_error_t **error );
+
+int rate_limiter_consume(
+     rate_limiter_t *rate_limiter,
+     size_t size,
+     libcerror_error_t **error );
+
+int rate_limiter_open_control_file_descriptor(
+     rate_limiter_t *rate_limiter,
+     int file_descriptor,
+     libcerror_error_t **error );
+
+int rate_limiter_read_control(
+     rate_limiter_t *rate_limiter,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _RATE_LIMITER_H ) */
+
@@ -0,0 +1,755 @@
+/*
+ * Restart checkpoint functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <byte_stream.h>
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "md5_context.h"
+#include "restart_checkpoint.h"
+#include "sha256_context.h"
+
+/* The restart checkpoint file consists of a record per checkpoint, in order
+ * of the hashed offset. A record consists of: the signature, the acquiry offset,
+ * the acquiry size, the hashed offset, the flags, the MD5 state, the SHA-1 state,
+ * the SHA-256 state and the MD5 of the preceding data of the record
+ * The values are stored in little-endian
+ * The MD5 of the preceding data is used to detect a record that was only
+ * partially written, for example when the system failed during the acquiry
+ */
+const uint8_t restart_checkpoint_record_signature[ 8 ] = {
+	'e', 'w', 'f', 'r', 's', 't', 'c', 'k' };
+
+/* Creates a restart checkpoint
+ * Make sure the value restart_checkpoint is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int restart_checkpoint_initialize(
+     restart_checkpoint_t **restart_checkpoint,
+     libcerror_error_t **error )
+{
+	static char *function = "restart_checkpoint_initialize";
+
+	if( restart_checkpoint == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid restart checkpoint.",
+		 function );
+
+		return( -1 );
+	}
+	if( *restart_checkpoint != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid restart checkpoint value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*restart_checkpoint = memory_allocate_structure(
+	                       restart_checkpoint_t );
+
+	if( *restart_checkpoint == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create restart checkpoint.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *restart_checkpoint,
+	     0,
+	     sizeof( restart_checkpoint_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear restart checkpoint.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *restart_checkpoint != NULL )
+	{
+		memory_free(
+		 *restart_checkpoint );
+
+		*restart_checkpoint = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a restart checkpoint
+ * Returns 1 if successful or -1 on error
+ */
+int restart_checkpoint_free(
+     restart_checkpoint_t **restart_checkpoint,
+     libcerror_error_t **error )
+{
+	static char *function = "restart_checkpoint_free";
+
+	if( restart_checkpoint == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid restart checkpoint.",
+		 function );
+
+		return( -1 );
+	}
+	if( *restart_checkpoint != NULL )
+	{
+		memory_free(
+		 *restart_checkpoint );
+
+		*restart_checkpoint = NULL;
+	}
+	return( 1 );
+}
+
+/* Calculates the MD5 of the restart checkpoint record data that precedes the MD5
+ * Returns 1 if successful or -1 on error
+ */
+int restart_checkpoint_calculate_checksum(
+     const uint8_t *record_data,
+     uint8_t *checksum,
+     libcerror_error_t **error )
+{
+	md5_context_t *md5_context = NULL;
+	static char *function      = "restart_checkpoint_calculate_checksum";
+
+	if( md5_context_initialize(
+	     &md5_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize MD5 context.",
+		 function );
+
+		goto on_error;
+	}
+	if( md5_context_update(
+	     md5_context,
+	     record_data,
+	     RESTART_CHECKPOINT_RECORD_SIZE - MD5_CONTEXT_HASH_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update MD5 context.",
+		 function );
+
+		goto on_error;
+	}
+	if( md5_context_finalize(
+	     md5_context,
+	     checksum,
+	     MD5_CONTEXT_HASH_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize MD5 context.",
+		 function );
+
+		goto on_error;
+	}
+	if( md5_context_free(
+	     &md5_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free MD5 context.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( md5_context != NULL )
+	{
+		md5_context_free(
+		 &md5_context,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the restart checkpoint from a record
+ * Returns 1 if successful, 0 if the record is not valid or -1 on error
+ */
+int restart_checkpoint_read_record(
+     restart_checkpoint_t *restart_checkpoint,
+     const uint8_t *record_data,
+     libcerror_error_t **error )
+{
+	uint8_t checksum[ MD5_CONTEXT_HASH_SIZE ];
+
+	static char *function = "restart_checkpoint_read_record";
+
+	if( restart_checkpoint == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid restart checkpoint.",
+		 function );
+
+		return( -1 );
+	}
+	if( record_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record data.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_compare(
+	     record_data,
+	     restart_checkpoint_record_signature,
+	     8 ) != 0 )
+	{
+		return( 0 );
+	}
+	if( restart_checkpoint_calculate_checksum(
+	     record_data,
+	     checksum,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to calculate checksum.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_compare(
+	     &( record_data[ RESTART_CHECKPOINT_RECORD_SIZE - MD5_CONTEXT_HASH_SIZE ] ),
+	     checksum,
+	     MD5_CONTEXT_HASH_SIZE ) != 0 )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint64_little_endian(
+	 &( record_data[ 8 ] ),
+	 restart_checkpoint->acquiry_offset );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( record_data[ 16 ] ),
+	 restart_checkpoint->acquiry_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( record_data[ 24 ] ),
+	 restart_checkpoint->hashed_offset );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( record_data[ 32 ] ),
+	 restart_checkpoint->flags );
+
+	if( memory_copy(
+	     restart_checkpoint->md5_state,
+	     &( record_data[ 36 ] ),
+	     MD5_CONTEXT_STATE_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy MD5 state.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     restart_checkpoint->sha1_state,
+	     &( record_data[ 36 + MD5_CONTEXT_STATE_SIZE ] ),
+	     SHA1_CONTEXT_STATE_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy SHA-1 state.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     restart_checkpoint->sha256_state,
+	     &( record_data[ 36 + MD5_CONTEXT_STATE_SIZE + SHA1_CONTEXT_STATE_SIZE ] ),
+	     SHA256_CONTEXT_STATE_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy SHA-256 state.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Writes the restart checkpoint to a record
+ * Returns 1 if successful or -1 on error
+ */
+int restart_checkpoint_write_record(
+     restart_checkpoint_t *restart_checkpoint,
+     uint8_t *record_data,
+     libcerror_error_t **error )
+{
+	static char *function = "restart_checkpoint_write_record";
+
+	if( restart_checkpoint == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid restart checkpoint.",
+		 function );
+
+		return( -1 );
+	}
+	if( record_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record data.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     record_data,
+	     restart_checkpoint_record_signature,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy record signature.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_little_endian(
+	 &( record_data[ 8 ] ),
+	 restart_checkpoint->acquiry_offset );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( record_data[ 16 ] ),
+	 restart_checkpoint->acquiry_size );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( record_data[ 24 ] ),
+	 restart_checkpoint->hashed_offset );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( record_data[ 32 ] ),
+	 restart_checkpoint->flags );
+
+	if( memory_copy(
+	     &( record_data[ 36 ] ),
+	     restart_checkpoint->md5_state,
+	     MD5_CONTEXT_STATE_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy MD5 state.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     &( record_data[ 36 + MD5_CONTEXT_STATE_SIZE ] ),
+	     restart_checkpoint->sha1_state,
+	     SHA1_CONTEXT_STATE_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy SHA-1 state.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     &( record_data[ 36 + MD5_CONTEXT_STATE_SIZE + SHA1_CONTEXT_STATE_SIZE ] ),
+	     restart_checkpoint->sha256_state,
+	     SHA256_CONTEXT_STATE_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy SHA-256 state.",
+		 function );
+
+		return( -1 );
+	}
+	if( restart_checkpoint_calculate_checksum(
+	     record_data,
+	     &( record_data[ RESTART_CHECKPOINT_RECORD_SIZE - MD5_CONTEXT_HASH_SIZE ] ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to calculate checksum.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the restart checkpoint from a file
+ * The last record of which the hashed offset does not exceed the maximum hashed offset is read
+ * The records are read up to the first record that is not valid, such as a partially written record
+ * Returns 1 if successful, 0 if the file does not contain such a record or -1 on error
+ */
+int restart_checkpoint_read_file(
+     restart_checkpoint_t *restart_checkpoint,
+     const system_character_t *filename,
+     uint64_t maximum_hashed_offset,
+     libcerror_error_t **error )
+{
+	uint8_t record_data[ RESTART_CHECKPOINT_RECORD_SIZE ];
+
+	restart_checkpoint_t *record_checkpoint = NULL;
+	FILE *file_stream                       = NULL;
+	static char *function                   = "restart_checkpoint_read_file";
+	int record_result                       = 0;
+	int result                              = 0;
+
+	if( restart_checkpoint == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid restart checkpoint.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( restart_checkpoint_initialize(
+	     &record_checkpoint,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create record checkpoint.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	file_stream = file_stream_open_wide(
+	               filename,
+	               _SYSTEM_STRING( FILE_STREAM_BINARY_OPEN_READ ) );
+#else
+	file_stream = file_stream_open(
+	               filename,
+	               FILE_STREAM_BINARY_OPEN_READ );
+#endif
+	if( file_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
+		 function );
+
+		goto on_error;
+	}
+	while( file_stream_read(
+	        file_stream,
+	        record_data,
+	        RESTART_CHECKPOINT_RECORD_SIZE ) == RESTART_CHECKPOINT_RECORD_SIZE )
+	{
+		record_result = restart_checkpoint_read_record(
+		                 record_checkpoint,
+		                 record_data,
+		                 error );
+
+		if( record_result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read record.",
+			 function );
+
+			goto on_error;
+		}
+		else if( record_result == 0 )
+		{
+			break;
+		}
+		if( record_checkpoint->hashed_offset <= maximum_hashed_offset )
+		{
+			if( memory_copy(
+			     restart_checkpoint,
+			     record_checkpoint,
+			     sizeof( restart_checkpoint_t ) ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy record checkpoint.",
+				 function );
+
+				goto on_error;
+			}
+			result = 1;
+		}
+	}
+	if( file_stream_close(
+	     file_stream ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		file_stream = NULL;
+
+		goto on_error;
+	}
+	if( restart_checkpoint_free(
+	     &record_checkpoint,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free record checkpoint.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+
+on_error:
+	if( file_stream != NULL )
+	{
+		file_stream_close(
+		 file_stream );
+	}
+	if( record_checkpoint != NULL )
+	{
+		restart_checkpoint_free(
+		 &record_checkpoint,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes the restart checkpoint to a file
+ * The record is appended to the file when append is set, otherwise
+ * the file is replaced by a file that only contains the record
+ * Returns 1 if successful or -1 on error
+ */
+int restart_checkpoint_write_file(
+     restart_checkpoint_t *restart_checkpoint,
+     const system_character_t *filename,
+     uint8_t append,
+     libcerror_error_t **error )
+{
+	uint8_t record_data[ RESTART_CHECKPOINT_RECORD_SIZE ];
+
+	FILE *file_stream     = NULL;
+	static char *function = "restart_checkpoint_write_file";
+
+	if( restart_checkpoint == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid restart checkpoint.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( restart_checkpoint_write_record(
+	     restart_checkpoint,
+	     record_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to write record.",
+		 function );
+
+		return( -1 );
+	}
+	if( append != 0 )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		file_stream = file_stream_open_wide(
+		               filename,
+		               _SYSTEM_STRING( FILE_STREAM_BINARY_OPEN_APPEND ) );
+#else
+		file_stream = file_stream_open(
+		               filename,
+		               FILE_STREAM_BINARY_OPEN_APPEND );
+#endif
+	}
+	else
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		file_stream = file_stream_open_wide(
+		               filename,
+		               _SYSTEM_STRING( FILE_STREAM_BINARY_OPEN_WRITE ) );
+#else
+		file_stream = file_stream_open(
+		               filename,
+		               FILE_STREAM_BINARY_OPEN_WRITE );
+#endif
+	}
+	if( file_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
+		 function );
+
+		goto on_error;
+	}
+	if( file_stream_write(
+	     file_stream,
+	     record_data,
+	     RESTART_CHECKPOINT_RECORD_SIZE ) != RESTART_CHECKPOINT_RECORD_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write record.",
+		 function );
+
+		goto on_error;
+	}
+	if( file_stream_close(
+	     file_stream ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	if( file_stream != NULL )
+	{
+		file_stream_close(
+		 file_stream );
+	}
+	return( -1 );
+}
+
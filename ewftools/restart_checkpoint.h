@@ -0,0 +1,125 @@
+/*
+ * Restart checkpoint functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _RESTART_CHECKPOINT_H )
+#define _RESTART_CHECKPOINT_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "md5_context.h"
+#include "sha1_context.h"
+#include "sha256_context.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#define RESTART_CHECKPOINT_DEFAULT_INTERVAL	( (size64_t) 1024 * 1024 * 1024 )
+
+#define RESTART_CHECKPOINT_RECORD_SIZE		( 36 + MD5_CONTEXT_STATE_SIZE + SHA1_CONTEXT_STATE_SIZE + SHA256_CONTEXT_STATE_SIZE + MD5_CONTEXT_HASH_SIZE )
+
+enum RESTART_CHECKPOINT_FLAGS
+{
+	RESTART_CHECKPOINT_FLAG_HAS_MD5_STATE		= 0x00000001UL,
+	RESTART_CHECKPOINT_FLAG_HAS_SHA256_STATE	= 0x00000002UL,
+	RESTART_CHECKPOINT_FLAG_HAS_SHA1_STATE		= 0x00000004UL
+};
+
+typedef struct restart_checkpoint restart_checkpoint_t;
+
+/* The restart checkpoint contains the state of the digest calculations
+ * of an acquiry so that a resumed acquiry only has to calculate the digests
+ * of the data acquired after the checkpoint
+ */
+struct restart_checkpoint
+{
+	/* The acquiry offset
+	 */
+	uint64_t acquiry_offset;
+
+	/* The acquiry size
+	 */
+	uint64_t acquiry_size;
+
+	/* The offset, relative to the acquiry offset, up to which the data was hashed
+	 */
+	uint64_t hashed_offset;
+
+	/* The flags
+	 */
+	uint32_t flags;
+
+	/* The MD5 state
+	 */
+	uint8_t md5_state[ MD5_CONTEXT_STATE_SIZE ];
+
+	/* The SHA-1 state
+	 */
+	uint8_t sha1_state[ SHA1_CONTEXT_STATE_SIZE ];
+
+	/* The SHA-256 state
+	 */
+	uint8_t sha256_state[ SHA256_CONTEXT_STATE_SIZE ];
+};
+
+int restart_checkpoint_initialize(
+     restart_checkpoint_t **restart_checkpoint,
+     libcerror_error_t **error );
+
+int restart_checkpoint_free(
+     restart_checkpoint_t **restart_checkpoint,
+     libcerror_error_t **error );
+
+int restart_checkpoint_calculate_checksum(
+     const uint8_t *record_data,
+     uint8_t *checksum,
+     libcerror_error_t **error );
+
+int restart_checkpoint_read_record(
+     restart_checkpoint_t *restart_checkpoint,
+     const uint8_t *record_data,
+     libcerror_error_t **error );
+
+int restart_checkpoint_write_record(
+     restart_checkpoint_t *restart_checkpoint,
+     uint8_t *record_data,
+     libcerror_error_t **error );
+
+int restart_checkpoint_read_file(
+     restart_checkpoint_t *restart_checkpoint,
+     const system_character_t *filename,
+     uint64_t maximum_hashed_offset,
+     libcerror_error_t **error );
+
+int restart_checkpoint_write_file(
+     restart_checkpoint_t *restart_checkpoint,
+     const system_character_t *filename,
+     uint8_t append,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _RESTART_CHECKPOINT_H ) */
+
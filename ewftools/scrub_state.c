@@ -0,0 +1,835 @@
+/*
+ * Scrub state functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <byte_stream.h>
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "md5_context.h"
+#include "scrub_state.h"
+
+/* The scrub state file consists of a record per scrubbed slice of an image.
+ * A record consists of: the signature, the image index, the chunk size,
+ * the media size, the scrubbed offset, the number of damaged sectors,
+ * the flags and the MD5 of the preceding data of the record
+ * The values are stored in little-endian
+ * A later record of an image supersedes the earlier records of the image
+ */
+const uint8_t scrub_state_record_signature[ 8 ] = {
+	'e', 'w', 'f', 's', 'c', 'r', 'u', 'b' };
+
+/* The scrub state record flags
+ */
+#define SCRUB_STATE_RECORD_FLAG_IS_CORRUPTED	0x00000001UL
+
+/* Creates a scrub state
+ * Make sure the value scrub_state is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int scrub_state_initialize(
+     scrub_state_t **scrub_state,
+     int number_of_images,
+     libcerror_error_t **error )
+{
+	static char *function = "scrub_state_initialize";
+
+	if( scrub_state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scrub state.",
+		 function );
+
+		return( -1 );
+	}
+	if( *scrub_state != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid scrub state value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_images <= 0 )
+	 || ( (size_t) number_of_images > ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( scrub_state_image_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of images value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*scrub_state = memory_allocate_structure(
+	                scrub_state_t );
+
+	if( *scrub_state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create scrub state.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *scrub_state,
+	     0,
+	     sizeof( scrub_state_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear scrub state.",
+		 function );
+
+		memory_free(
+		 *scrub_state );
+
+		*scrub_state = NULL;
+
+		return( -1 );
+	}
+	( *scrub_state )->images = (scrub_state_image_t *) memory_allocate(
+	                                                    sizeof( scrub_state_image_t ) * number_of_images );
+
+	if( ( *scrub_state )->images == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create images.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *scrub_state )->images,
+	     0,
+	     sizeof( scrub_state_image_t ) * number_of_images ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear images.",
+		 function );
+
+		goto on_error;
+	}
+	( *scrub_state )->number_of_images = number_of_images;
+
+	return( 1 );
+
+on_error:
+	if( *scrub_state != NULL )
+	{
+		if( ( *scrub_state )->images != NULL )
+		{
+			memory_free(
+			 ( *scrub_state )->images );
+		}
+		memory_free(
+		 *scrub_state );
+
+		*scrub_state = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a scrub state
+ * Returns 1 if successful or -1 on error
+ */
+int scrub_state_free(
+     scrub_state_t **scrub_state,
+     libcerror_error_t **error )
+{
+	static char *function = "scrub_state_free";
+
+	if( scrub_state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scrub state.",
+		 function );
+
+		return( -1 );
+	}
+	if( *scrub_state != NULL )
+	{
+		if( ( *scrub_state )->images != NULL )
+		{
+			memory_free(
+			 ( *scrub_state )->images );
+		}
+		memory_free(
+		 *scrub_state );
+
+		*scrub_state = NULL;
+	}
+	return( 1 );
+}
+
+/* Determines if the scrub of an image has completed
+ * Returns 1 if completed, 0 if not or -1 on error
+ */
+int scrub_state_image_is_completed(
+     scrub_state_t *scrub_state,
+     int image_index,
+     libcerror_error_t **error )
+{
+	scrub_state_image_t *image = NULL;
+	static char *function      = "scrub_state_image_is_completed";
+
+	if( scrub_state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scrub state.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( image_index < 0 )
+	 || ( image_index >= scrub_state->number_of_images ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid image index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	image = &( scrub_state->images[ image_index ] );
+
+	/* The media size is only known after the image was opened
+	 */
+	if( image->chunk_size == 0 )
+	{
+		return( 0 );
+	}
+	if( image->scrubbed_offset >= image->media_size )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Resets the scrub state so that the images are scrubbed from the start
+ * Returns 1 if successful or -1 on error
+ */
+int scrub_state_reset(
+     scrub_state_t *scrub_state,
+     libcerror_error_t **error )
+{
+	static char *function = "scrub_state_reset";
+	int image_index       = 0;
+
+	if( scrub_state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scrub state.",
+		 function );
+
+		return( -1 );
+	}
+	for( image_index = 0;
+	     image_index < scrub_state->number_of_images;
+	     image_index++ )
+	{
+		scrub_state->images[ image_index ].scrubbed_offset           = 0;
+		scrub_state->images[ image_index ].number_of_damaged_sectors = 0;
+		scrub_state->images[ image_index ].is_corrupted              = 0;
+		scrub_state->images[ image_index ].has_failed                = 0;
+	}
+	return( 1 );
+}
+
+/* Calculates the MD5 of the scrub state record data that precedes the MD5
+ * Returns 1 if successful or -1 on error
+ */
+int scrub_state_calculate_checksum(
+     const uint8_t *record_data,
+     uint8_t *checksum,
+     libcerror_error_t **error )
+{
+	md5_context_t *md5_context = NULL;
+	static char *function      = "scrub_state_calculate_checksum";
+
+	if( md5_context_initialize(
+	     &md5_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize MD5 context.",
+		 function );
+
+		goto on_error;
+	}
+	if( md5_context_update(
+	     md5_context,
+	     record_data,
+	     SCRUB_STATE_RECORD_SIZE - MD5_CONTEXT_HASH_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update MD5 context.",
+		 function );
+
+		goto on_error;
+	}
+	if( md5_context_finalize(
+	     md5_context,
+	     checksum,
+	     MD5_CONTEXT_HASH_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize MD5 context.",
+		 function );
+
+		goto on_error;
+	}
+	if( md5_context_free(
+	     &md5_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free MD5 context.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( md5_context != NULL )
+	{
+		md5_context_free(
+		 &md5_context,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the scrub state of an image from a record
+ * Records of an image index that is not part of the scrub state are ignored
+ * Returns 1 if successful, 0 if the record is not valid or -1 on error
+ */
+int scrub_state_read_record(
+     scrub_state_t *scrub_state,
+     const uint8_t *record_data,
+     libcerror_error_t **error )
+{
+	uint8_t checksum[ MD5_CONTEXT_HASH_SIZE ];
+
+	scrub_state_image_t *image = NULL;
+	static char *function      = "scrub_state_read_record";
+	uint32_t flags             = 0;
+	uint32_t image_index       = 0;
+
+	if( scrub_state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scrub state.",
+		 function );
+
+		return( -1 );
+	}
+	if( record_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record data.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_compare(
+	     record_data,
+	     scrub_state_record_signature,
+	     8 ) != 0 )
+	{
+		return( 0 );
+	}
+	if( scrub_state_calculate_checksum(
+	     record_data,
+	     checksum,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to calculate checksum.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_compare(
+	     &( record_data[ SCRUB_STATE_RECORD_SIZE - MD5_CONTEXT_HASH_SIZE ] ),
+	     checksum,
+	     MD5_CONTEXT_HASH_SIZE ) != 0 )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 &( record_data[ 8 ] ),
+	 image_index );
+
+	if( image_index >= (uint32_t) scrub_state->number_of_images )
+	{
+		return( 1 );
+	}
+	image = &( scrub_state->images[ image_index ] );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( record_data[ 12 ] ),
+	 image->chunk_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( record_data[ 16 ] ),
+	 image->media_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( record_data[ 24 ] ),
+	 image->scrubbed_offset );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( record_data[ 32 ] ),
+	 image->number_of_damaged_sectors );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( record_data[ 40 ] ),
+	 flags );
+
+	if( ( flags & SCRUB_STATE_RECORD_FLAG_IS_CORRUPTED ) != 0 )
+	{
+		image->is_corrupted = 1;
+	}
+	else
+	{
+		image->is_corrupted = 0;
+	}
+	return( 1 );
+}
+
+/* Writes the scrub state of an image to a record
+ * Returns 1 if successful or -1 on error
+ */
+int scrub_state_write_record(
+     scrub_state_t *scrub_state,
+     int image_index,
+     uint8_t *record_data,
+     libcerror_error_t **error )
+{
+	scrub_state_image_t *image = NULL;
+	static char *function      = "scrub_state_write_record";
+	uint32_t flags             = 0;
+
+	if( scrub_state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scrub state.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( image_index < 0 )
+	 || ( image_index >= scrub_state->number_of_images ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid image index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( record_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record data.",
+		 function );
+
+		return( -1 );
+	}
+	image = &( scrub_state->images[ image_index ] );
+
+	if( memory_copy(
+	     record_data,
+	     scrub_state_record_signature,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy record signature.",
+		 function );
+
+		return( -1 );
+	}
+	if( image->is_corrupted != 0 )
+	{
+		flags |= SCRUB_STATE_RECORD_FLAG_IS_CORRUPTED;
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 &( record_data[ 8 ] ),
+	 (uint32_t) image_index );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( record_data[ 12 ] ),
+	 image->chunk_size );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( record_data[ 16 ] ),
+	 image->media_size );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( record_data[ 24 ] ),
+	 image->scrubbed_offset );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( record_data[ 32 ] ),
+	 image->number_of_damaged_sectors );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( record_data[ 40 ] ),
+	 flags );
+
+	if( scrub_state_calculate_checksum(
+	     record_data,
+	     &( record_data[ SCRUB_STATE_RECORD_SIZE - MD5_CONTEXT_HASH_SIZE ] ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to calculate checksum.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the scrub state from a file
+ * The records are read up to the first record that is not valid, such as a partially written record
+ * Returns 1 if successful, 0 if the file could not be opened or -1 on error
+ */
+int scrub_state_read_file(
+     scrub_state_t *scrub_state,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	uint8_t record_data[ SCRUB_STATE_RECORD_SIZE ];
+
+	FILE *file_stream     = NULL;
+	static char *function = "scrub_state_read_file";
+	int record_result     = 0;
+
+	if( scrub_state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scrub state.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	file_stream = file_stream_open_wide(
+	               filename,
+	               _SYSTEM_STRING( FILE_STREAM_BINARY_OPEN_READ ) );
+#else
+	file_stream = file_stream_open(
+	               filename,
+	               FILE_STREAM_BINARY_OPEN_READ );
+#endif
+	/* A scrub state file that does not exist yet represents a new scrub
+	 */
+	if( file_stream == NULL )
+	{
+		return( 0 );
+	}
+	while( file_stream_read(
+	        file_stream,
+	        record_data,
+	        SCRUB_STATE_RECORD_SIZE ) == SCRUB_STATE_RECORD_SIZE )
+	{
+		record_result = scrub_state_read_record(
+		                 scrub_state,
+		                 record_data,
+		                 error );
+
+		if( record_result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read record.",
+			 function );
+
+			goto on_error;
+		}
+		else if( record_result == 0 )
+		{
+			break;
+		}
+	}
+	if( file_stream_close(
+	     file_stream ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	if( file_stream != NULL )
+	{
+		file_stream_close(
+		 file_stream );
+	}
+	return( -1 );
+}
+
+/* Writes the scrub state to a file
+ * The record of the image is appended to the file, if the image index is -1
+ * the file is replaced by a file that only contains the records of all images
+ * Returns 1 if successful or -1 on error
+ */
+int scrub_state_write_file(
+     scrub_state_t *scrub_state,
+     const system_character_t *filename,
+     int image_index,
+     libcerror_error_t **error )
+{
+	uint8_t record_data[ SCRUB_STATE_RECORD_SIZE ];
+
+	FILE *file_stream     = NULL;
+	static char *function = "scrub_state_write_file";
+	int first_image_index = 0;
+	int last_image_index  = 0;
+
+	if( scrub_state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scrub state.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( image_index < -1 )
+	 || ( image_index >= scrub_state->number_of_images ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid image index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( image_index == -1 )
+	{
+		first_image_index = 0;
+		last_image_index  = scrub_state->number_of_images - 1;
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		file_stream = file_stream_open_wide(
+		               filename,
+		               _SYSTEM_STRING( FILE_STREAM_BINARY_OPEN_WRITE ) );
+#else
+		file_stream = file_stream_open(
+		               filename,
+		               FILE_STREAM_BINARY_OPEN_WRITE );
+#endif
+	}
+	else
+	{
+		first_image_index = image_index;
+		last_image_index  = image_index;
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		file_stream = file_stream_open_wide(
+		               filename,
+		               _SYSTEM_STRING( FILE_STREAM_BINARY_OPEN_APPEND ) );
+#else
+		file_stream = file_stream_open(
+		               filename,
+		               FILE_STREAM_BINARY_OPEN_APPEND );
+#endif
+	}
+	if( file_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
+		 function );
+
+		goto on_error;
+	}
+	for( image_index = first_image_index;
+	     image_index <= last_image_index;
+	     image_index++ )
+	{
+		if( scrub_state_write_record(
+		     scrub_state,
+		     image_index,
+		     record_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to write record of image: %d.",
+			 function,
+			 image_index );
+
+			goto on_error;
+		}
+		if( file_stream_write(
+		     file_stream,
+		     record_data,
+		     SCRUB_STATE_RECORD_SIZE ) != SCRUB_STATE_RECORD_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write record of image: %d.",
+			 function,
+			 image_index );
+
+			goto on_error;
+		}
+	}
+	if( file_stream_close(
+	     file_stream ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	if( file_stream != NULL )
+	{
+		file_stream_close(
+		 file_stream );
+	}
+	return( -1 );
+}
+
@@ -0,0 +1,138 @@
+/*
+ * Scrub state functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _SCRUB_STATE_H )
+#define _SCRUB_STATE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "md5_context.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The size of the media data that is scrubbed per image before the next image is scrubbed
+ */
+#define SCRUB_STATE_DEFAULT_SLICE_SIZE	( (size64_t) 1024 * 1024 * 1024 )
+
+#define SCRUB_STATE_RECORD_SIZE		( 44 + MD5_CONTEXT_HASH_SIZE )
+
+typedef struct scrub_state_image scrub_state_image_t;
+
+/* The scrub state of an image
+ */
+struct scrub_state_image
+{
+	/* The media size
+	 */
+	uint64_t media_size;
+
+	/* The chunk size
+	 */
+	uint32_t chunk_size;
+
+	/* The offset up to which the media data was scrubbed
+	 */
+	uint64_t scrubbed_offset;
+
+	/* The number of damaged sectors found in the scrubbed media data
+	 */
+	uint64_t number_of_damaged_sectors;
+
+	/* Value to indicate the segment files were found to be corrupted
+	 */
+	uint8_t is_corrupted;
+
+	/* Value to indicate the image could not be scrubbed, which is not stored
+	 */
+	uint8_t has_failed;
+};
+
+typedef struct scrub_state scrub_state_t;
+
+/* The scrub state contains the progress of scrubbing a set of images
+ * so that an interrupted scrub continues where it left off
+ */
+struct scrub_state
+{
+	/* The images
+	 */
+	scrub_state_image_t *images;
+
+	/* The number of images
+	 */
+	int number_of_images;
+};
+
+int scrub_state_initialize(
+     scrub_state_t **scrub_state,
+     int number_of_images,
+     libcerror_error_t **error );
+
+int scrub_state_free(
+     scrub_state_t **scrub_state,
+     libcerror_error_t **error );
+
+int scrub_state_image_is_completed(
+     scrub_state_t *scrub_state,
+     int image_index,
+     libcerror_error_t **error );
+
+int scrub_state_reset(
+     scrub_state_t *scrub_state,
+     libcerror_error_t **error );
+
+int scrub_state_calculate_checksum(
+     const uint8_t *record_data,
+     uint8_t *checksum,
+     libcerror_error_t **error );
+
+int scrub_state_read_record(
+     scrub_state_t *scrub_state,
+     const uint8_t *record_data,
+     libcerror_error_t **error );
+
+int scrub_state_write_record(
+     scrub_state_t *scrub_state,
+     int image_index,
+     uint8_t *record_data,
+     libcerror_error_t **error );
+
+int scrub_state_read_file(
+     scrub_state_t *scrub_state,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int scrub_state_write_file(
+     scrub_state_t *scrub_state,
+     const system_character_t *filename,
+     int image_index,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _SCRUB_STATE_H ) */
+
@@ -0,0 +1,1420 @@
+/*
+ * Segment ledger functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <byte_stream.h>
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#include "ewftools_libcerror.h"
+#include "md5_context.h"
+#include "segment_ledger.h"
+#include "sha256_context.h"
+
+/* The segment ledger file consists of a header record followed by a record per segment file.
+ * The header record consists of: the signature, the record type, the number of segments,
+ * the chunk size, the flags, the media size, the MD5 hash string of the media data,
+ * the combined digest and the MD5 of the preceding data of the record.
+ * A segment record consists of: the signature, the record type, the segment index,
+ * the file size, the modification time, the media offset, the media size, the digest
+ * of the section descriptors, the digest of the media data and the MD5 of the preceding
+ * data of the record.
+ * The values are stored in little-endian
+ */
+const uint8_t segment_ledger_record_signature[ 8 ] = {
+	'e', 'w', 'f', 's', 'l', 'e', 'd', 'g' };
+
+/* The segment ledger record types
+ */
+#define SEGMENT_LEDGER_RECORD_TYPE_HEADER	0x00000000UL
+#define SEGMENT_LEDGER_RECORD_TYPE_SEGMENT	0x00000001UL
+
+/* The segment ledger header record flags
+ */
+#define SEGMENT_LEDGER_RECORD_FLAG_HAS_MD5_HASH	0x00000001UL
+
+/* The EWF version 1 segment file signatures
+ */
+const uint8_t segment_ledger_ewf1_evf_signature[ 8 ] = {
+	'E', 'V', 'F', 0x09, 0x0d, 0x0a, 0xff, 0x00 };
+
+const uint8_t segment_ledger_ewf1_lvf_signature[ 8 ] = {
+	'L', 'V', 'F', 0x09, 0x0d, 0x0a, 0xff, 0x00 };
+
+/* Creates a segment ledger
+ * Make sure the value segment_ledger is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int segment_ledger_initialize(
+     segment_ledger_t **segment_ledger,
+     uint32_t number_of_segments,
+     libcerror_error_t **error )
+{
+	static char *function = "segment_ledger_initialize";
+
+	if( segment_ledger == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment ledger.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_ledger != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid segment ledger value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_segments == 0 )
+	 || ( (size_t) number_of_segments > ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( segment_ledger_segment_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of segments value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*segment_ledger = memory_allocate_structure(
+	                   segment_ledger_t );
+
+	if( *segment_ledger == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segment ledger.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *segment_ledger,
+	     0,
+	     sizeof( segment_ledger_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear segment ledger.",
+		 function );
+
+		memory_free(
+		 *segment_ledger );
+
+		*segment_ledger = NULL;
+
+		return( -1 );
+	}
+	( *segment_ledger )->segments = (segment_ledger_segment_t *) memory_allocate(
+	                                                              sizeof( segment_ledger_segment_t ) * number_of_segments );
+
+	if( ( *segment_ledger )->segments == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segments.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *segment_ledger )->segments,
+	     0,
+	     sizeof( segment_ledger_segment_t ) * number_of_segments ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear segments.",
+		 function );
+
+		goto on_error;
+	}
+	( *segment_ledger )->number_of_segments = number_of_segments;
+
+	return( 1 );
+
+on_error:
+	if( *segment_ledger != NULL )
+	{
+		if( ( *segment_ledger )->segments != NULL )
+		{
+			memory_free(
+			 ( *segment_ledger )->segments );
+		}
+		memory_free(
+		 *segment_ledger );
+
+		*segment_ledger = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a segment ledger
+ * Returns 1 if successful or -1 on error
+ */
+int segment_ledger_free(
+     segment_ledger_t **segment_ledger,
+     libcerror_error_t **error )
+{
+	static char *function = "segment_ledger_free";
+
+	if( segment_ledger == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment ledger.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_ledger != NULL )
+	{
+		if( ( *segment_ledger )->segments != NULL )
+		{
+			memory_free(
+			 ( *segment_ledger )->segments );
+		}
+		memory_free(
+		 *segment_ledger );
+
+		*segment_ledger = NULL;
+	}
+	return( 1 );
+}
+
+/* Retrieves the combined digest, which is the SHA-256 of the media digests of all segments
+ * Since the segments are contiguous and ordered by media offset, the combined digest
+ * represents the media data as a whole
+ * Returns 1 if successful or -1 on error
+ */
+int segment_ledger_get_combined_digest(
+     segment_ledger_t *segment_ledger,
+     uint8_t *digest,
+     size_t digest_size,
+     libcerror_error_t **error )
+{
+	sha256_context_t *sha256_context = NULL;
+	static char *function            = "segment_ledger_get_combined_digest";
+	uint32_t segment_index           = 0;
+
+	if( segment_ledger == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment ledger.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_size < SEGMENT_LEDGER_DIGEST_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid digest size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( sha256_context_initialize(
+	     &sha256_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize SHA256 context.",
+		 function );
+
+		goto on_error;
+	}
+	for( segment_index = 0;
+	     segment_index < segment_ledger->number_of_segments;
+	     segment_index++ )
+	{
+		if( sha256_context_update(
+		     sha256_context,
+		     segment_ledger->segments[ segment_index ].media_digest,
+		     SEGMENT_LEDGER_DIGEST_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA256 context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( sha256_context_finalize(
+	     sha256_context,
+	     digest,
+	     digest_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize SHA256 context.",
+		 function );
+
+		goto on_error;
+	}
+	if( sha256_context_free(
+	     &sha256_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free SHA256 context.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( sha256_context != NULL )
+	{
+		sha256_context_free(
+		 &sha256_context,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Determines the identity of a segment file, which consists of the file size,
+ * the modification time and the digest of the section descriptors
+ * The section descriptors are only read from EWF version 1 segment files, since
+ * these contain the offset of the next section, for other segment files the
+ * digest of the section descriptors is cleared
+ * Returns 1 if successful or -1 on error
+ */
+int segment_ledger_get_file_identity(
+     const system_character_t *filename,
+     segment_ledger_segment_t *segment,
+     libcerror_error_t **error )
+{
+	uint8_t file_header_data[ 13 ];
+	uint8_t section_descriptor_data[ 76 ];
+
+#if defined( HAVE_SYS_STAT_H ) && !defined( WINAPI ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	struct stat file_stat;
+#endif
+
+	sha256_context_t *sha256_context = NULL;
+	FILE *file_stream                = NULL;
+	static char *function            = "segment_ledger_get_file_identity";
+	uint64_t next_offset             = 0;
+	uint64_t section_offset          = 0;
+	int number_of_sections           = 0;
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment.",
+		 function );
+
+		return( -1 );
+	}
+	segment->file_size         = 0;
+	segment->modification_time = 0;
+
+	if( memory_set(
+	     segment->descriptors_digest,
+	     0,
+	     SEGMENT_LEDGER_DIGEST_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear descriptors digest.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_SYS_STAT_H ) && !defined( WINAPI ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( stat(
+	     filename,
+	     &file_stat ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to determine file status.",
+		 function );
+
+		return( -1 );
+	}
+	segment->file_size         = (uint64_t) file_stat.st_size;
+	segment->modification_time = (uint64_t) file_stat.st_mtime;
+#endif
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	file_stream = file_stream_open_wide(
+	               filename,
+	               _SYSTEM_STRING( FILE_STREAM_BINARY_OPEN_READ ) );
+#else
+	file_stream = file_stream_open(
+	               filename,
+	               FILE_STREAM_BINARY_OPEN_READ );
+#endif
+	if( file_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
+		 function );
+
+		goto on_error;
+	}
+	if( file_stream_read(
+	     file_stream,
+	     file_header_data,
+	     13 ) != 13 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file header.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( memory_compare(
+	       file_header_data,
+	       segment_ledger_ewf1_evf_signature,
+	       8 ) == 0 )
+	 || ( memory_compare(
+	       file_header_data,
+	       segment_ledger_ewf1_lvf_signature,
+	       8 ) == 0 ) )
+	{
+		if( sha256_context_initialize(
+		     &sha256_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA256 context.",
+			 function );
+
+			goto on_error;
+		}
+		section_offset = 13;
+
+		/* The section descriptors are chained by the offset of the next section,
+		 * a partially written or truncated segment file ends the chain early
+		 */
+		while( number_of_sections < SEGMENT_LEDGER_MAXIMUM_NUMBER_OF_SECTIONS )
+		{
+			if( file_stream_seek_offset(
+			     file_stream,
+			     (off64_t) section_offset,
+			     SEEK_SET ) != 0 )
+			{
+				break;
+			}
+			if( file_stream_read(
+			     file_stream,
+			     section_descriptor_data,
+			     76 ) != 76 )
+			{
+				break;
+			}
+			if( sha256_context_update(
+			     sha256_context,
+			     section_descriptor_data,
+			     76,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update SHA256 context.",
+				 function );
+
+				goto on_error;
+			}
+			number_of_sections++;
+
+			if( ( memory_compare(
+			       section_descriptor_data,
+			       "done",
+			       5 ) == 0 )
+			 || ( memory_compare(
+			       section_descriptor_data,
+			       "next",
+			       5 ) == 0 ) )
+			{
+				break;
+			}
+			byte_stream_copy_to_uint64_little_endian(
+			 &( section_descriptor_data[ 16 ] ),
+			 next_offset );
+
+			if( next_offset <= section_offset )
+			{
+				break;
+			}
+			section_offset = next_offset;
+		}
+		if( sha256_context_finalize(
+		     sha256_context,
+		     segment->descriptors_digest,
+		     SEGMENT_LEDGER_DIGEST_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize SHA256 context.",
+			 function );
+
+			goto on_error;
+		}
+		if( sha256_context_free(
+		     &sha256_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free SHA256 context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( file_stream_close(
+	     file_stream ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		file_stream = NULL;
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( sha256_context != NULL )
+	{
+		sha256_context_free(
+		 &sha256_context,
+		 NULL );
+	}
+	if( file_stream != NULL )
+	{
+		file_stream_close(
+		 file_stream );
+	}
+	return( -1 );
+}
+
+/* Calculates the checksum of a record
+ * Returns 1 if successful or -1 on error
+ */
+int segment_ledger_calculate_checksum(
+     const uint8_t *record_data,
+     uint8_t *checksum,
+     libcerror_error_t **error )
+{
+	md5_context_t *md5_context = NULL;
+	static char *function      = "segment_ledger_calculate_checksum";
+
+	if( md5_context_initialize(
+	     &md5_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize MD5 context.",
+		 function );
+
+		goto on_error;
+	}
+	if( md5_context_update(
+	     md5_context,
+	     record_data,
+	     SEGMENT_LEDGER_RECORD_SIZE - MD5_CONTEXT_HASH_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update MD5 context.",
+		 function );
+
+		goto on_error;
+	}
+	if( md5_context_finalize(
+	     md5_context,
+	     checksum,
+	     MD5_CONTEXT_HASH_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize MD5 context.",
+		 function );
+
+		goto on_error;
+	}
+	if( md5_context_free(
+	     &md5_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free MD5 context.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( md5_context != NULL )
+	{
+		md5_context_free(
+		 &md5_context,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads a record, where record index 0 is the header record and
+ * record index 1 and higher are the records of the segments
+ * Returns 1 if successful, 0 if the record is not valid or -1 on error
+ */
+int segment_ledger_read_record(
+     segment_ledger_t *segment_ledger,
+     const uint8_t *record_data,
+     uint32_t record_index,
+     libcerror_error_t **error )
+{
+	uint8_t checksum[ MD5_CONTEXT_HASH_SIZE ];
+
+	segment_ledger_segment_t *segment = NULL;
+	static char *function             = "segment_ledger_read_record";
+	uint32_t flags                    = 0;
+	uint32_t number_of_segments       = 0;
+	uint32_t record_type              = 0;
+	uint32_t segment_index            = 0;
+
+	if( segment_ledger == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment ledger.",
+		 function );
+
+		return( -1 );
+	}
+	if( record_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record data.",
+		 function );
+
+		return( -1 );
+	}
+	if( record_index > segment_ledger->number_of_segments )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid record index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_compare(
+	     record_data,
+	     segment_ledger_record_signature,
+	     8 ) != 0 )
+	{
+		return( 0 );
+	}
+	if( segment_ledger_calculate_checksum(
+	     record_data,
+	     checksum,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to calculate checksum.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_compare(
+	     &( record_data[ SEGMENT_LEDGER_RECORD_SIZE - MD5_CONTEXT_HASH_SIZE ] ),
+	     checksum,
+	     MD5_CONTEXT_HASH_SIZE ) != 0 )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 &( record_data[ 8 ] ),
+	 record_type );
+
+	if( record_index == 0 )
+	{
+		if( record_type != SEGMENT_LEDGER_RECORD_TYPE_HEADER )
+		{
+			return( 0 );
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 &( record_data[ 12 ] ),
+		 number_of_segments );
+
+		if( number_of_segments != segment_ledger->number_of_segments )
+		{
+			return( 0 );
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 &( record_data[ 16 ] ),
+		 segment_ledger->chunk_size );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 &( record_data[ 20 ] ),
+		 flags );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 &( record_data[ 24 ] ),
+		 segment_ledger->media_size );
+
+		if( ( flags & SEGMENT_LEDGER_RECORD_FLAG_HAS_MD5_HASH ) != 0 )
+		{
+			segment_ledger->has_md5_hash = 1;
+		}
+		else
+		{
+			segment_ledger->has_md5_hash = 0;
+		}
+		if( memory_copy(
+		     segment_ledger->md5_hash_string,
+		     &( record_data[ 32 ] ),
+		     SEGMENT_LEDGER_MD5_HASH_STRING_SIZE ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy MD5 hash string.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_copy(
+		     segment_ledger->combined_digest,
+		     &( record_data[ 64 ] ),
+		     SEGMENT_LEDGER_DIGEST_SIZE ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy combined digest.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	if( record_type != SEGMENT_LEDGER_RECORD_TYPE_SEGMENT )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 &( record_data[ 12 ] ),
+	 segment_index );
+
+	if( segment_index != ( record_index - 1 ) )
+	{
+		return( 0 );
+	}
+	segment = &( segment_ledger->segments[ segment_index ] );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( record_data[ 16 ] ),
+	 segment->file_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( record_data[ 24 ] ),
+	 segment->modification_time );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( record_data[ 32 ] ),
+	 segment->media_offset );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( record_data[ 40 ] ),
+	 segment->media_size );
+
+	if( memory_copy(
+	     segment->descriptors_digest,
+	     &( record_data[ 48 ] ),
+	     SEGMENT_LEDGER_DIGEST_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy descriptors digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     segment->media_digest,
+	     &( record_data[ 80 ] ),
+	     SEGMENT_LEDGER_DIGEST_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy media digest.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Writes a record, where record index 0 is the header record and
+ * record index 1 and higher are the records of the segments
+ * Returns 1 if successful or -1 on error
+ */
+int segment_ledger_write_record(
+     segment_ledger_t *segment_ledger,
+     uint32_t record_index,
+     uint8_t *record_data,
+     libcerror_error_t **error )
+{
+	segment_ledger_segment_t *segment = NULL;
+	static char *function             = "segment_ledger_write_record";
+	uint32_t flags                    = 0;
+
+	if( segment_ledger == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment ledger.",
+		 function );
+
+		return( -1 );
+	}
+	if( record_index > segment_ledger->number_of_segments )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid record index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( record_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record data.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     record_data,
+	     0,
+	     SEGMENT_LEDGER_RECORD_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear record data.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     record_data,
+	     segment_ledger_record_signature,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy record signature.",
+		 function );
+
+		return( -1 );
+	}
+	if( record_index == 0 )
+	{
+		if( segment_ledger->has_md5_hash != 0 )
+		{
+			flags |= SEGMENT_LEDGER_RECORD_FLAG_HAS_MD5_HASH;
+		}
+		byte_stream_copy_from_uint32_little_endian(
+		 &( record_data[ 8 ] ),
+		 SEGMENT_LEDGER_RECORD_TYPE_HEADER );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 &( record_data[ 12 ] ),
+		 segment_ledger->number_of_segments );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 &( record_data[ 16 ] ),
+		 segment_ledger->chunk_size );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 &( record_data[ 20 ] ),
+		 flags );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 &( record_data[ 24 ] ),
+		 segment_ledger->media_size );
+
+		if( memory_copy(
+		     &( record_data[ 32 ] ),
+		     segment_ledger->md5_hash_string,
+		     SEGMENT_LEDGER_MD5_HASH_STRING_SIZE ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy MD5 hash string.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_copy(
+		     &( record_data[ 64 ] ),
+		     segment_ledger->combined_digest,
+		     SEGMENT_LEDGER_DIGEST_SIZE ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy combined digest.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else
+	{
+		segment = &( segment_ledger->segments[ record_index - 1 ] );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 &( record_data[ 8 ] ),
+		 SEGMENT_LEDGER_RECORD_TYPE_SEGMENT );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 &( record_data[ 12 ] ),
+		 record_index - 1 );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 &( record_data[ 16 ] ),
+		 segment->file_size );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 &( record_data[ 24 ] ),
+		 segment->modification_time );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 &( record_data[ 32 ] ),
+		 segment->media_offset );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 &( record_data[ 40 ] ),
+		 segment->media_size );
+
+		if( memory_copy(
+		     &( record_data[ 48 ] ),
+		     segment->descriptors_digest,
+		     SEGMENT_LEDGER_DIGEST_SIZE ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy descriptors digest.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_copy(
+		     &( record_data[ 80 ] ),
+		     segment->media_digest,
+		     SEGMENT_LEDGER_DIGEST_SIZE ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy media digest.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( segment_ledger_calculate_checksum(
+	     record_data,
+	     &( record_data[ SEGMENT_LEDGER_RECORD_SIZE - MD5_CONTEXT_HASH_SIZE ] ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to calculate checksum.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads a segment ledger from a file
+ * The segment ledger is only created if the file exists and all its records are valid
+ * Make sure the value segment_ledger is referencing, is set to NULL
+ * Returns 1 if successful, 0 if the file could not be opened or is not valid or -1 on error
+ */
+int segment_ledger_read_file(
+     segment_ledger_t **segment_ledger,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	uint8_t checksum[ MD5_CONTEXT_HASH_SIZE ];
+	uint8_t record_data[ SEGMENT_LEDGER_RECORD_SIZE ];
+
+	FILE *file_stream           = NULL;
+	static char *function       = "segment_ledger_read_file";
+	uint32_t number_of_segments = 0;
+	uint32_t record_index       = 0;
+	int record_result           = 0;
+
+	if( segment_ledger == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment ledger.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_ledger != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid segment ledger value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	file_stream = file_stream_open_wide(
+	               filename,
+	               _SYSTEM_STRING( FILE_STREAM_BINARY_OPEN_READ ) );
+#else
+	file_stream = file_stream_open(
+	               filename,
+	               FILE_STREAM_BINARY_OPEN_READ );
+#endif
+	/* A segment ledger file that does not exist yet represents a first verification
+	 */
+	if( file_stream == NULL )
+	{
+		return( 0 );
+	}
+	if( file_stream_read(
+	     file_stream,
+	     record_data,
+	     SEGMENT_LEDGER_RECORD_SIZE ) != SEGMENT_LEDGER_RECORD_SIZE )
+	{
+		record_result = 0;
+	}
+	else
+	{
+		/* Validate the header record before the number of segments is used
+		 */
+		if( segment_ledger_calculate_checksum(
+		     record_data,
+		     checksum,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to calculate checksum.",
+			 function );
+
+			goto on_error;
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 &( record_data[ 12 ] ),
+		 number_of_segments );
+
+		if( ( number_of_segments == 0 )
+		 || ( memory_compare(
+		       &( record_data[ SEGMENT_LEDGER_RECORD_SIZE - MD5_CONTEXT_HASH_SIZE ] ),
+		       checksum,
+		       MD5_CONTEXT_HASH_SIZE ) != 0 ) )
+		{
+			record_result = 0;
+		}
+		else
+		{
+			if( segment_ledger_initialize(
+			     segment_ledger,
+			     number_of_segments,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create segment ledger.",
+				 function );
+
+				goto on_error;
+			}
+			record_result = 1;
+		}
+	}
+	for( record_index = 0;
+	     ( record_result == 1 ) && ( record_index <= number_of_segments );
+	     record_index++ )
+	{
+		if( ( record_index > 0 )
+		 && ( file_stream_read(
+		       file_stream,
+		       record_data,
+		       SEGMENT_LEDGER_RECORD_SIZE ) != SEGMENT_LEDGER_RECORD_SIZE ) )
+		{
+			record_result = 0;
+
+			break;
+		}
+		record_result = segment_ledger_read_record(
+		                 *segment_ledger,
+		                 record_data,
+		                 record_index,
+		                 error );
+
+		if( record_result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read record: %" PRIu32 ".",
+			 function,
+			 record_index );
+
+			goto on_error;
+		}
+	}
+	if( file_stream_close(
+	     file_stream ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		file_stream = NULL;
+
+		goto on_error;
+	}
+	/* A segment ledger that is not valid is discarded as a whole
+	 */
+	if( ( record_result != 1 )
+	 && ( *segment_ledger != NULL ) )
+	{
+		if( segment_ledger_free(
+		     segment_ledger,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free segment ledger.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( record_result );
+
+on_error:
+	if( file_stream != NULL )
+	{
+		file_stream_close(
+		 file_stream );
+	}
+	if( *segment_ledger != NULL )
+	{
+		segment_ledger_free(
+		 segment_ledger,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes a segment ledger to a file
+ * Returns 1 if successful or -1 on error
+ */
+int segment_ledger_write_file(
+     segment_ledger_t *segment_ledger,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	uint8_t record_data[ SEGMENT_LEDGER_RECORD_SIZE ];
+
+	FILE *file_stream     = NULL;
+	static char *function = "segment_ledger_write_file";
+	uint32_t record_index = 0;
+
+	if( segment_ledger == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment ledger.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	file_stream = file_stream_open_wide(
+	               filename,
+	               _SYSTEM_STRING( FILE_STREAM_BINARY_OPEN_WRITE ) );
+#else
+	file_stream = file_stream_open(
+	               filename,
+	               FILE_STREAM_BINARY_OPEN_WRITE );
+#endif
+	if( file_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
+		 function );
+
+		goto on_error;
+	}
+	for( record_index = 0;
+	     record_index <= segment_ledger->number_of_segments;
+	     record_index++ )
+	{
+		if( segment_ledger_write_record(
+		     segment_ledger,
+		     record_index,
+		     record_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to write record: %" PRIu32 ".",
+			 function,
+			 record_index );
+
+			goto on_error;
+		}
+		if( file_stream_write(
+		     file_stream,
+		     record_data,
+		     SEGMENT_LEDGER_RECORD_SIZE ) != SEGMENT_LEDGER_RECORD_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write record: %" PRIu32 ".",
+			 function,
+			 record_index );
+
+			goto on_error;
+		}
+	}
+	if( file_stream_close(
+	     file_stream ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		file_stream = NULL;
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_stream != NULL )
+	{
+		file_stream_close(
+		 file_stream );
+	}
+	return( -1 );
+}
+
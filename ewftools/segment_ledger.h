@@ -0,0 +1,164 @@
+/*
+ * Segment ledger functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _SEGMENT_LEDGER_H )
+#define _SEGMENT_LEDGER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "md5_context.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#define SEGMENT_LEDGER_DIGEST_SIZE			32
+
+#define SEGMENT_LEDGER_MD5_HASH_STRING_SIZE		32
+
+#define SEGMENT_LEDGER_RECORD_SIZE			( 112 + MD5_CONTEXT_HASH_SIZE )
+
+/* The maximum number of section descriptors that are read from a segment file
+ */
+#define SEGMENT_LEDGER_MAXIMUM_NUMBER_OF_SECTIONS	( 1024 * 1024 )
+
+typedef struct segment_ledger_segment segment_ledger_segment_t;
+
+/* The ledger values of a segment file
+ */
+struct segment_ledger_segment
+{
+	/* The file size
+	 */
+	uint64_t file_size;
+
+	/* The modification time
+	 */
+	uint64_t modification_time;
+
+	/* The SHA-256 of the section descriptors
+	 */
+	uint8_t descriptors_digest[ SEGMENT_LEDGER_DIGEST_SIZE ];
+
+	/* The offset of the media data stored in the segment file
+	 */
+	uint64_t media_offset;
+
+	/* The size of the media data stored in the segment file
+	 */
+	uint64_t media_size;
+
+	/* The SHA-256 of the media data stored in the segment file
+	 */
+	uint8_t media_digest[ SEGMENT_LEDGER_DIGEST_SIZE ];
+};
+
+typedef struct segment_ledger segment_ledger_t;
+
+/* The segment ledger contains the results of a verification per segment file
+ * so that a later verification only needs to read the segment files that changed
+ */
+struct segment_ledger
+{
+	/* The media size
+	 */
+	uint64_t media_size;
+
+	/* The chunk size
+	 */
+	uint32_t chunk_size;
+
+	/* Value to indicate the MD5 hash string is set
+	 */
+	uint8_t has_md5_hash;
+
+	/* The MD5 hash string of the media data
+	 */
+	uint8_t md5_hash_string[ SEGMENT_LEDGER_MD5_HASH_STRING_SIZE ];
+
+	/* The SHA-256 of the media digests of all segments
+	 */
+	uint8_t combined_digest[ SEGMENT_LEDGER_DIGEST_SIZE ];
+
+	/* The segments
+	 */
+	segment_ledger_segment_t *segments;
+
+	/* The number of segments
+	 */
+	uint32_t number_of_segments;
+};
+
+int segment_ledger_initialize(
+     segment_ledger_t **segment_ledger,
+     uint32_t number_of_segments,
+     libcerror_error_t **error );
+
+int segment_ledger_free(
+     segment_ledger_t **segment_ledger,
+     libcerror_error_t **error );
+
+int segment_ledger_get_combined_digest(
+     segment_ledger_t *segment_ledger,
+     uint8_t *digest,
+     size_t digest_size,
+     libcerror_error_t **error );
+
+int segment_ledger_get_file_identity(
+     const system_character_t *filename,
+     segment_ledger_segment_t *segment,
+     libcerror_error_t **error );
+
+int segment_ledger_calculate_checksum(
+     const uint8_t *record_data,
+     uint8_t *checksum,
+     libcerror_error_t **error );
+
+int segment_ledger_read_record(
+     segment_ledger_t *segment_ledger,
+     const uint8_t *record_data,
+     uint32_t record_index,
+     libcerror_error_t **error );
+
+int segment_ledger_write_record(
+     segment_ledger_t *segment_ledger,
+     uint32_t record_index,
+     uint8_t *record_data,
+     libcerror_error_t **error );
+
+int segment_ledger_read_file(
+     segment_ledger_t **segment_ledger,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int segment_ledger_write_file(
+     segment_ledger_t *segment_ledger,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _SEGMENT_LEDGER_H ) */
+
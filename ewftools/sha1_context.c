@@ -0,0 +1,1106 @@
+/*
+ * SHA-1 context functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <byte_stream.h>
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libhmac.h"
+#include "sha1_context.h"
+#include "sha256_context.h"
+
+#if defined( HAVE_SHA1_CONTEXT_X86_SHA_NI )
+#include <immintrin.h>
+
+#define SHA1_CONTEXT_ATTRIBUTE_TARGET_SHA_NI	__attribute__ ((target( "sha,sse4.1,ssse3" )))
+
+/* The SHA-1 initial hash values
+ */
+static const uint32_t sha1_context_initial_hash_values[ 5 ] = {
+	0x67452301UL, 0xefcdab89UL, 0x98badcfeUL, 0x10325476UL, 0xc3d2e1f0UL };
+
+#endif /* defined( HAVE_SHA1_CONTEXT_X86_SHA_NI ) */
+
+/* Creates a SHA-1 context
+ * Make sure the value context is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int sha1_context_initialize(
+     sha1_context_t **context,
+     libcerror_error_t **error )
+{
+	static char *function = "sha1_context_initialize";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *context != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid context value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*context = memory_allocate_structure(
+	            sha1_context_t );
+
+	if( *context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create context.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *context,
+	     0,
+	     sizeof( sha1_context_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear context.",
+		 function );
+
+		memory_free(
+		 *context );
+
+		*context = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_SHA1_CONTEXT_X86_SHA_NI )
+	if( sha256_context_has_sha_extensions() != 0 )
+	{
+		if( memory_copy(
+		     ( *context )->hash_values,
+		     sha1_context_initial_hash_values,
+		     sizeof( uint32_t ) * 5 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy initial hash values.",
+			 function );
+
+			goto on_error;
+		}
+		( *context )->use_sha_extensions = 1;
+
+		return( 1 );
+	}
+#endif /* defined( HAVE_SHA1_CONTEXT_X86_SHA_NI ) */
+
+	if( libhmac_sha1_initialize(
+	     &( ( *context )->libhmac_context ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize libhmac SHA-1 context.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *context != NULL )
+	{
+		memory_free(
+		 *context );
+
+		*context = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a SHA-1 context
+ * Returns 1 if successful or -1 on error
+ */
+int sha1_context_free(
+     sha1_context_t **context,
+     libcerror_error_t **error )
+{
+	static char *function = "sha1_context_free";
+	int result            = 1;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *context != NULL )
+	{
+		if( ( *context )->libhmac_context != NULL )
+		{
+			if( libhmac_sha1_free(
+			     &( ( *context )->libhmac_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free libhmac SHA-1 context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *context );
+
+		*context = NULL;
+	}
+	return( result );
+}
+
+/* Updates the SHA-1 context
+ * Returns 1 if successful or -1 on error
+ */
+int sha1_context_update(
+     sha1_context_t *context,
+     const uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "sha1_context_update";
+
+#if defined( HAVE_SHA1_CONTEXT_X86_SHA_NI )
+	size_t buffer_offset  = 0;
+	size_t copy_size      = 0;
+	size_t blocks_size    = 0;
+#endif
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_SHA1_CONTEXT_X86_SHA_NI )
+	if( context->use_sha_extensions != 0 )
+	{
+		if( context->block_data_size > 0 )
+		{
+			copy_size = SHA1_CONTEXT_BLOCK_SIZE - context->block_data_size;
+
+			if( copy_size > size )
+			{
+				copy_size = size;
+			}
+			if( memory_copy(
+			     &( context->block[ context->block_data_size ] ),
+			     buffer,
+			     copy_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy data to block.",
+				 function );
+
+				return( -1 );
+			}
+			context->block_data_size += copy_size;
+			buffer_offset            += copy_size;
+
+			if( context->block_data_size < SHA1_CONTEXT_BLOCK_SIZE )
+			{
+				context->hash_count += size;
+
+				return( 1 );
+			}
+			sha1_context_transform_sha_extensions(
+			 context->hash_values,
+			 context->block,
+			 1 );
+
+			context->block_data_size = 0;
+		}
+		blocks_size = ( size - buffer_offset ) / SHA1_CONTEXT_BLOCK_SIZE;
+
+		if( blocks_size > 0 )
+		{
+			sha1_context_transform_sha_extensions(
+			 context->hash_values,
+			 &( buffer[ buffer_offset ] ),
+			 blocks_size );
+
+			buffer_offset += blocks_size * SHA1_CONTEXT_BLOCK_SIZE;
+		}
+		if( buffer_offset < size )
+		{
+			context->block_data_size = size - buffer_offset;
+
+			if( memory_copy(
+			     context->block,
+			     &( buffer[ buffer_offset ] ),
+			     context->block_data_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy data to block.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		context->hash_count += size;
+
+		return( 1 );
+	}
+#endif /* defined( HAVE_SHA1_CONTEXT_X86_SHA_NI ) */
+
+	if( libhmac_sha1_update(
+	     context->libhmac_context,
+	     buffer,
+	     size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update libhmac SHA-1 context.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Finalizes the SHA-1 context
+ * Returns 1 if successful or -1 on error
+ */
+int sha1_context_finalize(
+     sha1_context_t *context,
+     uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error )
+{
+	static char *function = "sha1_context_finalize";
+
+#if defined( HAVE_SHA1_CONTEXT_X86_SHA_NI )
+	uint64_t bit_count    = 0;
+	int hash_value_index  = 0;
+	int number_of_blocks  = 1;
+#endif
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( hash_size < (size_t) LIBHMAC_SHA1_HASH_SIZE )
+	 || ( hash_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid hash size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_SHA1_CONTEXT_X86_SHA_NI )
+	if( context->use_sha_extensions != 0 )
+	{
+		/* The padding consists of a 0x80 byte followed by 0-byte values
+		 * and the number of bits hashed as a 64-bit big-endian value
+		 */
+		uint8_t padding[ 2 * SHA1_CONTEXT_BLOCK_SIZE ];
+
+		if( memory_set(
+		     padding,
+		     0,
+		     2 * SHA1_CONTEXT_BLOCK_SIZE ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear padding.",
+			 function );
+
+			return( -1 );
+		}
+		if( context->block_data_size > 0 )
+		{
+			if( memory_copy(
+			     padding,
+			     context->block,
+			     context->block_data_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy block to padding.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		padding[ context->block_data_size ] = 0x80;
+
+		if( context->block_data_size >= ( SHA1_CONTEXT_BLOCK_SIZE - 8 ) )
+		{
+			number_of_blocks = 2;
+		}
+		bit_count = context->hash_count * 8;
+
+		byte_stream_copy_from_uint64_big_endian(
+		 &( padding[ ( number_of_blocks * SHA1_CONTEXT_BLOCK_SIZE ) - 8 ] ),
+		 bit_count );
+
+		sha1_context_transform_sha_extensions(
+		 context->hash_values,
+		 padding,
+		 (size_t) number_of_blocks );
+
+		for( hash_value_index = 0;
+		     hash_value_index < 5;
+		     hash_value_index++ )
+		{
+			byte_stream_copy_from_uint32_big_endian(
+			 &( hash[ hash_value_index * 4 ] ),
+			 context->hash_values[ hash_value_index ] );
+		}
+		return( 1 );
+	}
+#endif /* defined( HAVE_SHA1_CONTEXT_X86_SHA_NI ) */
+
+	if( libhmac_sha1_finalize(
+	     context->libhmac_context,
+	     hash,
+	     hash_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to finalize libhmac SHA-1 context.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the state of the SHA-1 context
+ * The state is only available when the SHA extensions are used, since
+ * the state of the libhmac SHA-1 context cannot be retrieved
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int sha1_context_get_state(
+     sha1_context_t *context,
+     uint8_t *state,
+     size_t state_size,
+     libcerror_error_t **error )
+{
+	static char *function = "sha1_context_get_state";
+
+#if defined( HAVE_SHA1_CONTEXT_X86_SHA_NI )
+	int hash_value_index  = 0;
+#endif
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid state.",
+		 function );
+
+		return( -1 );
+	}
+	if( state_size != (size_t) SHA1_CONTEXT_STATE_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid state size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_SHA1_CONTEXT_X86_SHA_NI )
+	if( context->use_sha_extensions != 0 )
+	{
+		for( hash_value_index = 0;
+		     hash_value_index < 5;
+		     hash_value_index++ )
+		{
+			byte_stream_copy_from_uint32_big_endian(
+			 &( state[ hash_value_index * 4 ] ),
+			 context->hash_values[ hash_value_index ] );
+		}
+		byte_stream_copy_from_uint64_big_endian(
+		 &( state[ 20 ] ),
+		 context->hash_count );
+
+		if( memory_copy(
+		     &( state[ 28 ] ),
+		     context->block,
+		     SHA1_CONTEXT_BLOCK_SIZE ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy block to state.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+#endif /* defined( HAVE_SHA1_CONTEXT_X86_SHA_NI ) */
+
+	return( 0 );
+}
+
+/* Sets the state of the SHA-1 context
+ * The state can only be set when the SHA extensions are used
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int sha1_context_set_state(
+     sha1_context_t *context,
+     const uint8_t *state,
+     size_t state_size,
+     libcerror_error_t **error )
+{
+	static char *function = "sha1_context_set_state";
+
+#if defined( HAVE_SHA1_CONTEXT_X86_SHA_NI )
+	int hash_value_index  = 0;
+#endif
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid state.",
+		 function );
+
+		return( -1 );
+	}
+	if( state_size != (size_t) SHA1_CONTEXT_STATE_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid state size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_SHA1_CONTEXT_X86_SHA_NI )
+	if( context->use_sha_extensions != 0 )
+	{
+		for( hash_value_index = 0;
+		     hash_value_index < 5;
+		     hash_value_index++ )
+		{
+			byte_stream_copy_to_uint32_big_endian(
+			 &( state[ hash_value_index * 4 ] ),
+			 context->hash_values[ hash_value_index ] );
+		}
+		byte_stream_copy_to_uint64_big_endian(
+		 &( state[ 20 ] ),
+		 context->hash_count );
+
+		if( memory_copy(
+		     context->block,
+		     &( state[ 28 ] ),
+		     SHA1_CONTEXT_BLOCK_SIZE ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy block from state.",
+			 function );
+
+			return( -1 );
+		}
+		context->block_data_size = (size_t) ( context->hash_count % SHA1_CONTEXT_BLOCK_SIZE );
+
+		return( 1 );
+	}
+#endif /* defined( HAVE_SHA1_CONTEXT_X86_SHA_NI ) */
+
+	return( 0 );
+}
+
+#if defined( HAVE_SHA1_CONTEXT_X86_SHA_NI )
+
+/* Transforms the hash values with the 64-byte blocks using the SHA extensions
+ * The hash values A to D are kept in reverse order in a single register and
+ * E in the most significant 32-bits of another, as the sha1rnds4 and sha1nexte
+ * instructions require, while processing the blocks
+ */
+SHA1_CONTEXT_ATTRIBUTE_TARGET_SHA_NI
+void sha1_context_transform_sha_extensions(
+      uint32_t hash_values[ 5 ],
+      const uint8_t *blocks,
+      size_t number_of_blocks )
+{
+	__m128i messages[ 4 ];
+
+	const __m128i byte_order_mask = _mm_set_epi64x(
+	                                 0x0001020304050607ULL,
+	                                 0x08090a0b0c0d0e0fULL );
+
+	__m128i abcd_state       = _mm_setzero_si128();
+	__m128i abcd_state_saved = _mm_setzero_si128();
+	__m128i e_state          = _mm_setzero_si128();
+	__m128i e_state_saved    = _mm_setzero_si128();
+	__m128i e_value          = _mm_setzero_si128();
+	__m128i e_value_next     = _mm_setzero_si128();
+
+	abcd_state = _mm_loadu_si128(
+	              (const __m128i *) &( hash_values[ 0 ] ) );
+	abcd_state = _mm_shuffle_epi32(
+	              abcd_state,
+	              0x1b );
+	e_state    = _mm_set_epi32(
+	              (int) hash_values[ 4 ],
+	              0,
+	              0,
+	              0 );
+
+	while( number_of_blocks > 0 )
+	{
+		abcd_state_saved = abcd_state;
+		e_state_saved    = e_state;
+
+		/* Rounds 0 - 3
+		 */
+		messages[ 0 ] = _mm_shuffle_epi8(
+		                 _mm_loadu_si128(
+		                  (const __m128i *) &( blocks[ 0 ] ) ),
+		                 byte_order_mask );
+		e_value = _mm_add_epi32(
+		           e_state,
+		           messages[ 0 ] );
+		e_value_next = abcd_state;
+		abcd_state = _mm_sha1rnds4_epu32(
+		              abcd_state,
+		              e_value,
+		              0 );
+
+		/* Rounds 4 - 7
+		 */
+		messages[ 1 ] = _mm_shuffle_epi8(
+		                 _mm_loadu_si128(
+		                  (const __m128i *) &( blocks[ 16 ] ) ),
+		                 byte_order_mask );
+		e_value_next = _mm_sha1nexte_epu32(
+		                e_value_next,
+		                messages[ 1 ] );
+		e_value = abcd_state;
+		abcd_state = _mm_sha1rnds4_epu32(
+		              abcd_state,
+		              e_value_next,
+		              0 );
+		messages[ 0 ] = _mm_sha1msg1_epu32(
+		                 messages[ 0 ],
+		                 messages[ 1 ] );
+
+		/* Rounds 8 - 11
+		 */
+		messages[ 2 ] = _mm_shuffle_epi8(
+		                 _mm_loadu_si128(
+		                  (const __m128i *) &( blocks[ 32 ] ) ),
+		                 byte_order_mask );
+		e_value = _mm_sha1nexte_epu32(
+		           e_value,
+		           messages[ 2 ] );
+		e_value_next = abcd_state;
+		abcd_state = _mm_sha1rnds4_epu32(
+		              abcd_state,
+		              e_value,
+		              0 );
+		messages[ 1 ] = _mm_sha1msg1_epu32(
+		                 messages[ 1 ],
+		                 messages[ 2 ] );
+		messages[ 0 ] = _mm_xor_si128(
+		                 messages[ 0 ],
+		                 messages[ 2 ] );
+
+		/* Rounds 12 - 15
+		 */
+		messages[ 3 ] = _mm_shuffle_epi8(
+		                 _mm_loadu_si128(
+		                  (const __m128i *) &( blocks[ 48 ] ) ),
+		                 byte_order_mask );
+		e_value_next = _mm_sha1nexte_epu32(
+		                e_value_next,
+		                messages[ 3 ] );
+		e_value = abcd_state;
+		messages[ 0 ] = _mm_sha1msg2_epu32(
+		                 messages[ 0 ],
+		                 messages[ 3 ] );
+		abcd_state = _mm_sha1rnds4_epu32(
+		              abcd_state,
+		              e_value_next,
+		              0 );
+		messages[ 2 ] = _mm_sha1msg1_epu32(
+		                 messages[ 2 ],
+		                 messages[ 3 ] );
+		messages[ 1 ] = _mm_xor_si128(
+		                 messages[ 1 ],
+		                 messages[ 3 ] );
+
+		/* Rounds 16 - 19
+		 */
+		e_value = _mm_sha1nexte_epu32(
+		           e_value,
+		           messages[ 0 ] );
+		e_value_next = abcd_state;
+		messages[ 1 ] = _mm_sha1msg2_epu32(
+		                 messages[ 1 ],
+		                 messages[ 0 ] );
+		abcd_state = _mm_sha1rnds4_epu32(
+		              abcd_state,
+		              e_value,
+		              0 );
+		messages[ 3 ] = _mm_sha1msg1_epu32(
+		                 messages[ 3 ],
+		                 messages[ 0 ] );
+		messages[ 2 ] = _mm_xor_si128(
+		                 messages[ 2 ],
+		                 messages[ 0 ] );
+
+		/* Rounds 20 - 23
+		 */
+		e_value_next = _mm_sha1nexte_epu32(
+		                e_value_next,
+		                messages[ 1 ] );
+		e_value = abcd_state;
+		messages[ 2 ] = _mm_sha1msg2_epu32(
+		                 messages[ 2 ],
+		                 messages[ 1 ] );
+		abcd_state = _mm_sha1rnds4_epu32(
+		              abcd_state,
+		              e_value_next,
+		              1 );
+		messages[ 0 ] = _mm_sha1msg1_epu32(
+		                 messages[ 0 ],
+		                 messages[ 1 ] );
+		messages[ 3 ] = _mm_xor_si128(
+		                 messages[ 3 ],
+		                 messages[ 1 ] );
+
+		/* Rounds 24 - 27
+		 */
+		e_value = _mm_sha1nexte_epu32(
+		           e_value,
+		           messages[ 2 ] );
+		e_value_next = abcd_state;
+		messages[ 3 ] = _mm_sha1msg2_epu32(
+		                 messages[ 3 ],
+		                 messages[ 2 ] );
+		abcd_state = _mm_sha1rnds4_epu32(
+		              abcd_state,
+		              e_value,
+		              1 );
+		messages[ 1 ] = _mm_sha1msg1_epu32(
+		                 messages[ 1 ],
+		                 messages[ 2 ] );
+		messages[ 0 ] = _mm_xor_si128(
+		                 messages[ 0 ],
+		                 messages[ 2 ] );
+
+		/* Rounds 28 - 31
+		 */
+		e_value_next = _mm_sha1nexte_epu32(
+		                e_value_next,
+		                messages[ 3 ] );
+		e_value = abcd_state;
+		messages[ 0 ] = _mm_sha1msg2_epu32(
+		                 messages[ 0 ],
+		                 messages[ 3 ] );
+		abcd_state = _mm_sha1rnds4_epu32(
+		              abcd_state,
+		              e_value_next,
+		              1 );
+		messages[ 2 ] = _mm_sha1msg1_epu32(
+		                 messages[ 2 ],
+		                 messages[ 3 ] );
+		messages[ 1 ] = _mm_xor_si128(
+		                 messages[ 1 ],
+		                 messages[ 3 ] );
+
+		/* Rounds 32 - 35
+		 */
+		e_value = _mm_sha1nexte_epu32(
+		           e_value,
+		           messages[ 0 ] );
+		e_value_next = abcd_state;
+		messages[ 1 ] = _mm_sha1msg2_epu32(
+		                 messages[ 1 ],
+		                 messages[ 0 ] );
+		abcd_state = _mm_sha1rnds4_epu32(
+		              abcd_state,
+		              e_value,
+		              1 );
+		messages[ 3 ] = _mm_sha1msg1_epu32(
+		                 messages[ 3 ],
+		                 messages[ 0 ] );
+		messages[ 2 ] = _mm_xor_si128(
+		                 messages[ 2 ],
+		                 messages[ 0 ] );
+
+		/* Rounds 36 - 39
+		 */
+		e_value_next = _mm_sha1nexte_epu32(
+		                e_value_next,
+		                messages[ 1 ] );
+		e_value = abcd_state;
+		messages[ 2 ] = _mm_sha1msg2_epu32(
+		                 messages[ 2 ],
+		                 messages[ 1 ] );
+		abcd_state = _mm_sha1rnds4_epu32(
+		              abcd_state,
+		              e_value_next,
+		              1 );
+		messages[ 0 ] = _mm_sha1msg1_epu32(
+		                 messages[ 0 ],
+		                 messages[ 1 ] );
+		messages[ 3 ] = _mm_xor_si128(
+		                 messages[ 3 ],
+		                 messages[ 1 ] );
+
+		/* Rounds 40 - 43
+		 */
+		e_value = _mm_sha1nexte_epu32(
+		           e_value,
+		           messages[ 2 ] );
+		e_value_next = abcd_state;
+		messages[ 3 ] = _mm_sha1msg2_epu32(
+		                 messages[ 3 ],
+		                 messages[ 2 ] );
+		abcd_state = _mm_sha1rnds4_epu32(
+		              abcd_state,
+		              e_value,
+		              2 );
+		messages[ 1 ] = _mm_sha1msg1_epu32(
+		                 messages[ 1 ],
+		                 messages[ 2 ] );
+		messages[ 0 ] = _mm_xor_si128(
+		                 messages[ 0 ],
+		                 messages[ 2 ] );
+
+		/* Rounds 44 - 47
+		 */
+		e_value_next = _mm_sha1nexte_epu32(
+		                e_value_next,
+		                messages[ 3 ] );
+		e_value = abcd_state;
+		messages[ 0 ] = _mm_sha1msg2_epu32(
+		                 messages[ 0 ],
+		                 messages[ 3 ] );
+		abcd_state = _mm_sha1rnds4_epu32(
+		              abcd_state,
+		              e_value_next,
+		              2 );
+		messages[ 2 ] = _mm_sha1msg1_epu32(
+		                 messages[ 2 ],
+		                 messages[ 3 ] );
+		messages[ 1 ] = _mm_xor_si128(
+		                 messages[ 1 ],
+		                 messages[ 3 ] );
+
+		/* Rounds 48 - 51
+		 */
+		e_value = _mm_sha1nexte_epu32(
+		           e_value,
+		           messages[ 0 ] );
+		e_value_next = abcd_state;
+		messages[ 1 ] = _mm_sha1msg2_epu32(
+		                 messages[ 1 ],
+		                 messages[ 0 ] );
+		abcd_state = _mm_sha1rnds4_epu32(
+		              abcd_state,
+		              e_value,
+		              2 );
+		messages[ 3 ] = _mm_sha1msg1_epu32(
+		                 messages[ 3 ],
+		                 messages[ 0 ] );
+		messages[ 2 ] = _mm_xor_si128(
+		                 messages[ 2 ],
+		                 messages[ 0 ] );
+
+		/* Rounds 52 - 55
+		 */
+		e_value_next = _mm_sha1nexte_epu32(
+		                e_value_next,
+		                messages[ 1 ] );
+		e_value = abcd_state;
+		messages[ 2 ] = _mm_sha1msg2_epu32(
+		                 messages[ 2 ],
+		                 messages[ 1 ] );
+		abcd_state = _mm_sha1rnds4_epu32(
+		              abcd_state,
+		              e_value_next,
+		              2 );
+		messages[ 0 ] = _mm_sha1msg1_epu32(
+		                 messages[ 0 ],
+		                 messages[ 1 ] );
+		messages[ 3 ] = _mm_xor_si128(
+		                 messages[ 3 ],
+		                 messages[ 1 ] );
+
+		/* Rounds 56 - 59
+		 */
+		e_value = _mm_sha1nexte_epu32(
+		           e_value,
+		           messages[ 2 ] );
+		e_value_next = abcd_state;
+		messages[ 3 ] = _mm_sha1msg2_epu32(
+		                 messages[ 3 ],
+		                 messages[ 2 ] );
+		abcd_state = _mm_sha1rnds4_epu32(
+		              abcd_state,
+		              e_value,
+		              2 );
+		messages[ 1 ] = _mm_sha1msg1_epu32(
+		                 messages[ 1 ],
+		                 messages[ 2 ] );
+		messages[ 0 ] = _mm_xor_si128(
+		                 messages[ 0 ],
+		                 messages[ 2 ] );
+
+		/* Rounds 60 - 63
+		 */
+		e_value_next = _mm_sha1nexte_epu32(
+		                e_value_next,
+		                messages[ 3 ] );
+		e_value = abcd_state;
+		messages[ 0 ] = _mm_sha1msg2_epu32(
+		                 messages[ 0 ],
+		                 messages[ 3 ] );
+		abcd_state = _mm_sha1rnds4_epu32(
+		              abcd_state,
+		              e_value_next,
+		              3 );
+		messages[ 2 ] = _mm_sha1msg1_epu32(
+		                 messages[ 2 ],
+		                 messages[ 3 ] );
+		messages[ 1 ] = _mm_xor_si128(
+		                 messages[ 1 ],
+		                 messages[ 3 ] );
+
+		/* Rounds 64 - 67
+		 */
+		e_value = _mm_sha1nexte_epu32(
+		           e_value,
+		           messages[ 0 ] );
+		e_value_next = abcd_state;
+		messages[ 1 ] = _mm_sha1msg2_epu32(
+		                 messages[ 1 ],
+		                 messages[ 0 ] );
+		abcd_state = _mm_sha1rnds4_epu32(
+		              abcd_state,
+		              e_value,
+		              3 );
+		messages[ 3 ] = _mm_sha1msg1_epu32(
+		                 messages[ 3 ],
+		                 messages[ 0 ] );
+		messages[ 2 ] = _mm_xor_si128(
+		                 messages[ 2 ],
+		                 messages[ 0 ] );
+
+		/* Rounds 68 - 71
+		 */
+		e_value_next = _mm_sha1nexte_epu32(
+		                e_value_next,
+		                messages[ 1 ] );
+		e_value = abcd_state;
+		messages[ 2 ] = _mm_sha1msg2_epu32(
+		                 messages[ 2 ],
+		                 messages[ 1 ] );
+		abcd_state = _mm_sha1rnds4_epu32(
+		              abcd_state,
+		              e_value_next,
+		              3 );
+		messages[ 3 ] = _mm_xor_si128(
+		                 messages[ 3 ],
+		                 messages[ 1 ] );
+
+		/* Rounds 72 - 75
+		 */
+		e_value = _mm_sha1nexte_epu32(
+		           e_value,
+		           messages[ 2 ] );
+		e_value_next = abcd_state;
+		messages[ 3 ] = _mm_sha1msg2_epu32(
+		                 messages[ 3 ],
+		                 messages[ 2 ] );
+		abcd_state = _mm_sha1rnds4_epu32(
+		              abcd_state,
+		              e_value,
+		              3 );
+
+		/* Rounds 76 - 79
+		 */
+		e_value_next = _mm_sha1nexte_epu32(
+		                e_value_next,
+		                messages[ 3 ] );
+		e_value = abcd_state;
+		abcd_state = _mm_sha1rnds4_epu32(
+		              abcd_state,
+		              e_value_next,
+		              3 );
+
+		e_state    = _mm_sha1nexte_epu32(
+		              e_value,
+		              e_state_saved );
+		abcd_state = _mm_add_epi32(
+		              abcd_state,
+		              abcd_state_saved );
+
+		blocks           += SHA1_CONTEXT_BLOCK_SIZE;
+		number_of_blocks -= 1;
+	}
+	abcd_state = _mm_shuffle_epi32(
+	              abcd_state,
+	              0x1b );
+
+	_mm_storeu_si128(
+	 (__m128i *) &( hash_values[ 0 ] ),
+	 abcd_state );
+
+	hash_values[ 4 ] = (uint32_t) _mm_extract_epi32(
+	                               e_state,
+	                               3 );
+}
+
+#endif /* defined( HAVE_SHA1_CONTEXT_X86_SHA_NI ) */
+
@@ -0,0 +1,129 @@
+/*
+ * SHA-1 context functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _SHA1_CONTEXT_H )
+#define _SHA1_CONTEXT_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libhmac.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The SHA extensions kernel requires a compiler that supports
+ * function specific target options, the CPU support is determined
+ * by the SHA-256 context
+ */
+#if ( defined( __x86_64__ ) || defined( __i386__ ) ) && ( defined( __clang__ ) || ( defined( __GNUC__ ) && ( __GNUC__ >= 5 ) ) )
+#define HAVE_SHA1_CONTEXT_X86_SHA_NI	1
+#endif
+
+#define SHA1_CONTEXT_BLOCK_SIZE	64
+
+/* The size of the state, which consists of the hash values,
+ * the number of bytes hashed and the block
+ */
+#define SHA1_CONTEXT_STATE_SIZE	( 20 + 8 + SHA1_CONTEXT_BLOCK_SIZE )
+
+typedef struct sha1_context sha1_context_t;
+
+/* The SHA-1 context calculates the SHA-1 using the SHA extensions of the CPU
+ * when supported and otherwise falls back to libhmac, which in turn can use
+ * the OpenSSL EVP functions
+ */
+struct sha1_context
+{
+	/* The libhmac SHA-1 context
+	 */
+	libhmac_sha1_context_t *libhmac_context;
+
+	/* The hash values
+	 */
+	uint32_t hash_values[ 5 ];
+
+	/* The block
+	 */
+	uint8_t block[ SHA1_CONTEXT_BLOCK_SIZE ];
+
+	/* The size of the data in the block
+	 */
+	size_t block_data_size;
+
+	/* The number of bytes hashed
+	 */
+	uint64_t hash_count;
+
+	/* Value to indicate the SHA extensions are used
+	 */
+	uint8_t use_sha_extensions;
+};
+
+int sha1_context_initialize(
+     sha1_context_t **context,
+     libcerror_error_t **error );
+
+int sha1_context_free(
+     sha1_context_t **context,
+     libcerror_error_t **error );
+
+int sha1_context_update(
+     sha1_context_t *context,
+     const uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error );
+
+int sha1_context_finalize(
+     sha1_context_t *context,
+     uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error );
+
+int sha1_context_get_state(
+     sha1_context_t *context,
+     uint8_t *state,
+     size_t state_size,
+     libcerror_error_t **error );
+
+int sha1_context_set_state(
+     sha1_context_t *context,
+     const uint8_t *state,
+     size_t state_size,
+     libcerror_error_t **error );
+
+#if defined( HAVE_SHA1_CONTEXT_X86_SHA_NI )
+
+void sha1_context_transform_sha_extensions(
+      uint32_t hash_values[ 5 ],
+      const uint8_t *blocks,
+      size_t number_of_blocks );
+
+#endif /* defined( HAVE_SHA1_CONTEXT_X86_SHA_NI ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _SHA1_CONTEXT_H ) */
+
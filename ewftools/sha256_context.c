@@ -0,0 +1,860 @@
+/*
+ * SHA-256 context functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <byte_stream.h>
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libhmac.h"
+#include "sha256_context.h"
+
+#if defined( HAVE_SHA256_CONTEXT_X86_SHA_NI )
+#include <cpuid.h>
+#include <immintrin.h>
+
+#define SHA256_CONTEXT_ATTRIBUTE_TARGET_SHA_NI	__attribute__ ((target( "sha,sse4.1,ssse3" )))
+
+/* The SHA-256 initial hash values
+ */
+static const uint32_t sha256_context_initial_hash_values[ 8 ] = {
+	0x6a09e667UL, 0xbb67ae85UL, 0x3c6ef372UL, 0xa54ff53aUL,
+	0x510e527fUL, 0x9b05688cUL, 0x1f83d9abUL, 0x5be0cd19UL };
+
+/* The SHA-256 round constants
+ */
+static const uint32_t sha256_context_round_constants[ 64 ] = {
+	0x428a2f98UL, 0x71374491UL, 0xb5c0fbcfUL, 0xe9b5dba5UL, 0x3956c25bUL, 0x59f111f1UL, 0x923f82a4UL, 0xab1c5ed5UL,
+	0xd807aa98UL, 0x12835b01UL, 0x243185beUL, 0x550c7dc3UL, 0x72be5d74UL, 0x80deb1feUL, 0x9bdc06a7UL, 0xc19bf174UL,
+	0xe49b69c1UL, 0xefbe4786UL, 0x0fc19dc6UL, 0x240ca1ccUL, 0x2de92c6fUL, 0x4a7484aaUL, 0x5cb0a9dcUL, 0x76f988daUL,
+	0x983e5152UL, 0xa831c66dUL, 0xb00327c8UL, 0xbf597fc7UL, 0xc6e00bf3UL, 0xd5a79147UL, 0x06ca6351UL, 0x14292967UL,
+	0x27b70a85UL, 0x2e1b2138UL, 0x4d2c6dfcUL, 0x53380d13UL, 0x650a7354UL, 0x766a0abbUL, 0x81c2c92eUL, 0x92722c85UL,
+	0xa2bfe8a1UL, 0xa81a664bUL, 0xc24b8b70UL, 0xc76c51a3UL, 0xd192e819UL, 0xd6990624UL, 0xf40e3585UL, 0x106aa070UL,
+	0x19a4c116UL, 0x1e376c08UL, 0x2748774cUL, 0x34b0bcb5UL, 0x391c0cb3UL, 0x4ed8aa4aUL, 0x5b9cca4fUL, 0x682e6ff3UL,
+	0x748f82eeUL, 0x78a5636fUL, 0x84c87814UL, 0x8cc70208UL, 0x90befffaUL, 0xa4506cebUL, 0xbef9a3f7UL, 0xc67178f2UL };
+
+#endif /* defined( HAVE_SHA256_CONTEXT_X86_SHA_NI ) */
+
+/* Creates a SHA-256 context
+ * Make sure the value context is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int sha256_context_initialize(
+     sha256_context_t **context,
+     libcerror_error_t **error )
+{
+	static char *function = "sha256_context_initialize";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *context != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid context value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*context = memory_allocate_structure(
+	            sha256_context_t );
+
+	if( *context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create context.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *context,
+	     0,
+	     sizeof( sha256_context_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear context.",
+		 function );
+
+		memory_free(
+		 *context );
+
+		*context = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_SHA256_CONTEXT_X86_SHA_NI )
+	if( sha256_context_has_sha_extensions() != 0 )
+	{
+		if( memory_copy(
+		     ( *context )->hash_values,
+		     sha256_context_initial_hash_values,
+		     sizeof( uint32_t ) * 8 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy initial hash values.",
+			 function );
+
+			goto on_error;
+		}
+		( *context )->use_sha_extensions = 1;
+
+		return( 1 );
+	}
+#endif /* defined( HAVE_SHA256_CONTEXT_X86_SHA_NI ) */
+
+	if( libhmac_sha256_initialize(
+	     &( ( *context )->libhmac_context ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize libhmac SHA-256 context.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *context != NULL )
+	{
+		memory_free(
+		 *context );
+
+		*context = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a SHA-256 context
+ * Returns 1 if successful or -1 on error
+ */
+int sha256_context_free(
+     sha256_context_t **context,
+     libcerror_error_t **error )
+{
+	static char *function = "sha256_context_free";
+	int result            = 1;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *context != NULL )
+	{
+		if( ( *context )->libhmac_context != NULL )
+		{
+			if( libhmac_sha256_free(
+			     &( ( *context )->libhmac_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free libhmac SHA-256 context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *context );
+
+		*context = NULL;
+	}
+	return( result );
+}
+
+/* Updates the SHA-256 context
+ * Returns 1 if successful or -1 on error
+ */
+int sha256_context_update(
+     sha256_context_t *context,
+     const uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "sha256_context_update";
+
+#if defined( HAVE_SHA256_CONTEXT_X86_SHA_NI )
+	size_t buffer_offset  = 0;
+	size_t copy_size      = 0;
+	size_t blocks_size    = 0;
+#endif
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_SHA256_CONTEXT_X86_SHA_NI )
+	if( context->use_sha_extensions != 0 )
+	{
+		if( context->block_data_size > 0 )
+		{
+			copy_size = SHA256_CONTEXT_BLOCK_SIZE - context->block_data_size;
+
+			if( copy_size > size )
+			{
+				copy_size = size;
+			}
+			if( memory_copy(
+			     &( context->block[ context->block_data_size ] ),
+			     buffer,
+			     copy_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy data to block.",
+				 function );
+
+				return( -1 );
+			}
+			context->block_data_size += copy_size;
+			buffer_offset            += copy_size;
+
+			if( context->block_data_size < SHA256_CONTEXT_BLOCK_SIZE )
+			{
+				context->hash_count += size;
+
+				return( 1 );
+			}
+			sha256_context_transform_sha_extensions(
+			 context->hash_values,
+			 context->block,
+			 1 );
+
+			context->block_data_size = 0;
+		}
+		blocks_size = ( size - buffer_offset ) / SHA256_CONTEXT_BLOCK_SIZE;
+
+		if( blocks_size > 0 )
+		{
+			sha256_context_transform_sha_extensions(
+			 context->hash_values,
+			 &( buffer[ buffer_offset ] ),
+			 blocks_size );
+
+			buffer_offset += blocks_size * SHA256_CONTEXT_BLOCK_SIZE;
+		}
+		if( buffer_offset < size )
+		{
+			context->block_data_size = size - buffer_offset;
+
+			if( memory_copy(
+			     context->block,
+			     &( buffer[ buffer_offset ] ),
+			     context->block_data_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy data to block.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		context->hash_count += size;
+
+		return( 1 );
+	}
+#endif /* defined( HAVE_SHA256_CONTEXT_X86_SHA_NI ) */
+
+	if( libhmac_sha256_update(
+	     context->libhmac_context,
+	     buffer,
+	     size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update libhmac SHA-256 context.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Finalizes the SHA-256 context
+ * Returns 1 if successful or -1 on error
+ */
+int sha256_context_finalize(
+     sha256_context_t *context,
+     uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error )
+{
+	static char *function = "sha256_context_finalize";
+
+#if defined( HAVE_SHA256_CONTEXT_X86_SHA_NI )
+	uint64_t bit_count    = 0;
+	int hash_value_index  = 0;
+	int number_of_blocks  = 1;
+#endif
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( hash_size < (size_t) LIBHMAC_SHA256_HASH_SIZE )
+	 || ( hash_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid hash size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_SHA256_CONTEXT_X86_SHA_NI )
+	if( context->use_sha_extensions != 0 )
+	{
+		/* The padding consists of a 0x80 byte followed by 0-byte values
+		 * and the number of bits hashed as a 64-bit big-endian value
+		 */
+		uint8_t padding[ 2 * SHA256_CONTEXT_BLOCK_SIZE ];
+
+		if( memory_set(
+		     padding,
+		     0,
+		     2 * SHA256_CONTEXT_BLOCK_SIZE ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear padding.",
+			 function );
+
+			return( -1 );
+		}
+		if( context->block_data_size > 0 )
+		{
+			if( memory_copy(
+			     padding,
+			     context->block,
+			     context->block_data_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy block to padding.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		padding[ context->block_data_size ] = 0x80;
+
+		if( context->block_data_size >= ( SHA256_CONTEXT_BLOCK_SIZE - 8 ) )
+		{
+			number_of_blocks = 2;
+		}
+		bit_count = context->hash_count * 8;
+
+		byte_stream_copy_from_uint64_big_endian(
+		 &( padding[ ( number_of_blocks * SHA256_CONTEXT_BLOCK_SIZE ) - 8 ] ),
+		 bit_count );
+
+		sha256_context_transform_sha_extensions(
+		 context->hash_values,
+		 padding,
+		 (size_t) number_of_blocks );
+
+		for( hash_value_index = 0;
+		     hash_value_index < 8;
+		     hash_value_index++ )
+		{
+			byte_stream_copy_from_uint32_big_endian(
+			 &( hash[ hash_value_index * 4 ] ),
+			 context->hash_values[ hash_value_index ] );
+		}
+		return( 1 );
+	}
+#endif /* defined( HAVE_SHA256_CONTEXT_X86_SHA_NI ) */
+
+	if( libhmac_sha256_finalize(
+	     context->libhmac_context,
+	     hash,
+	     hash_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to finalize libhmac SHA-256 context.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the state of the SHA-256 context
+ * The state is only available when the SHA extensions are used, since
+ * the state of the libhmac SHA-256 context cannot be retrieved
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int sha256_context_get_state(
+     sha256_context_t *context,
+     uint8_t *state,
+     size_t state_size,
+     libcerror_error_t **error )
+{
+	static char *function = "sha256_context_get_state";
+
+#if defined( HAVE_SHA256_CONTEXT_X86_SHA_NI )
+	int hash_value_index  = 0;
+#endif
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid state.",
+		 function );
+
+		return( -1 );
+	}
+	if( state_size != (size_t) SHA256_CONTEXT_STATE_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid state size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_SHA256_CONTEXT_X86_SHA_NI )
+	if( context->use_sha_extensions != 0 )
+	{
+		for( hash_value_index = 0;
+		     hash_value_index < 8;
+		     hash_value_index++ )
+		{
+			byte_stream_copy_from_uint32_big_endian(
+			 &( state[ hash_value_index * 4 ] ),
+			 context->hash_values[ hash_value_index ] );
+		}
+		byte_stream_copy_from_uint64_big_endian(
+		 &( state[ 32 ] ),
+		 context->hash_count );
+
+		if( memory_copy(
+		     &( state[ 40 ] ),
+		     context->block,
+		     SHA256_CONTEXT_BLOCK_SIZE ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy block to state.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+#endif /* defined( HAVE_SHA256_CONTEXT_X86_SHA_NI ) */
+
+	return( 0 );
+}
+
+/* Sets the state of the SHA-256 context
+ * The state can only be set when the SHA extensions are used
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int sha256_context_set_state(
+     sha256_context_t *context,
+     const uint8_t *state,
+     size_t state_size,
+     libcerror_error_t **error )
+{
+	static char *function = "sha256_context_set_state";
+
+#if defined( HAVE_SHA256_CONTEXT_X86_SHA_NI )
+	int hash_value_index  = 0;
+#endif
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid state.",
+		 function );
+
+		return( -1 );
+	}
+	if( state_size != (size_t) SHA256_CONTEXT_STATE_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid state size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_SHA256_CONTEXT_X86_SHA_NI )
+	if( context->use_sha_extensions != 0 )
+	{
+		for( hash_value_index = 0;
+		     hash_value_index < 8;
+		     hash_value_index++ )
+		{
+			byte_stream_copy_to_uint32_big_endian(
+			 &( state[ hash_value_index * 4 ] ),
+			 context->hash_values[ hash_value_index ] );
+		}
+		byte_stream_copy_to_uint64_big_endian(
+		 &( state[ 32 ] ),
+		 context->hash_count );
+
+		if( memory_copy(
+		     context->block,
+		     &( state[ 40 ] ),
+		     SHA256_CONTEXT_BLOCK_SIZE ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy block from state.",
+			 function );
+
+			return( -1 );
+		}
+		context->block_data_size = (size_t) ( context->hash_count % SHA256_CONTEXT_BLOCK_SIZE );
+
+		return( 1 );
+	}
+#endif /* defined( HAVE_SHA256_CONTEXT_X86_SHA_NI ) */
+
+	return( 0 );
+}
+
+#if defined( HAVE_SHA256_CONTEXT_X86_SHA_NI )
+
+/* Determines if the CPU supports the SHA extensions
+ * The SSSE3 and SSE4.1 instructions are required as well to shuffle the state
+ * Returns 1 if supported or 0 if not
+ */
+int sha256_context_has_sha_extensions(
+     void )
+{
+	unsigned int eax = 0;
+	unsigned int ebx = 0;
+	unsigned int ecx = 0;
+	unsigned int edx = 0;
+
+	if( __get_cpuid(
+	     1,
+	     &eax,
+	     &ebx,
+	     &ecx,
+	     &edx ) == 0 )
+	{
+		return( 0 );
+	}
+	/* SSSE3 is bit 9 and SSE4.1 is bit 19 of ECX
+	 */
+	if( ( ( ecx & 0x00000200UL ) == 0 )
+	 || ( ( ecx & 0x00080000UL ) == 0 ) )
+	{
+		return( 0 );
+	}
+	if( __get_cpuid_count(
+	     7,
+	     0,
+	     &eax,
+	     &ebx,
+	     &ecx,
+	     &edx ) == 0 )
+	{
+		return( 0 );
+	}
+	/* SHA is bit 29 of EBX
+	 */
+	if( ( ebx & 0x20000000UL ) == 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Transforms the hash values with the 64-byte blocks using the SHA extensions
+ * The hash values are kept in the ABEF and CDGH order the sha256rnds2
+ * instruction requires while processing the blocks
+ */
+SHA256_CONTEXT_ATTRIBUTE_TARGET_SHA_NI
+void sha256_context_transform_sha_extensions(
+      uint32_t hash_values[ 8 ],
+      const uint8_t *blocks,
+      size_t number_of_blocks )
+{
+	__m128i messages[ 4 ];
+
+	const __m128i byte_order_mask = _mm_set_epi64x(
+	                                 0x0c0d0e0f08090a0bULL,
+	                                 0x0405060700010203ULL );
+
+	__m128i abef_state       = _mm_setzero_si128();
+	__m128i abef_state_saved = _mm_setzero_si128();
+	__m128i cdgh_state       = _mm_setzero_si128();
+	__m128i cdgh_state_saved = _mm_setzero_si128();
+	__m128i message          = _mm_setzero_si128();
+	__m128i value_128bit     = _mm_setzero_si128();
+	int group_index          = 0;
+
+	value_128bit = _mm_loadu_si128(
+	                (const __m128i *) &( hash_values[ 0 ] ) );
+	cdgh_state   = _mm_loadu_si128(
+	                (const __m128i *) &( hash_values[ 4 ] ) );
+
+	value_128bit = _mm_shuffle_epi32(
+	                value_128bit,
+	                0xb1 );
+	cdgh_state   = _mm_shuffle_epi32(
+	                cdgh_state,
+	                0x1b );
+	abef_state   = _mm_alignr_epi8(
+	                value_128bit,
+	                cdgh_state,
+	                8 );
+	cdgh_state   = _mm_blend_epi16(
+	                cdgh_state,
+	                value_128bit,
+	                0xf0 );
+
+	while( number_of_blocks > 0 )
+	{
+		abef_state_saved = abef_state;
+		cdgh_state_saved = cdgh_state;
+
+		/* Every group calculates 4 rounds, the message schedule of the next
+		 * groups is calculated in the same pass
+		 */
+		for( group_index = 0;
+		     group_index < 16;
+		     group_index++ )
+		{
+			if( group_index < 4 )
+			{
+				messages[ group_index ] = _mm_shuffle_epi8(
+				                           _mm_loadu_si128(
+				                            (const __m128i *) &( blocks[ group_index * 16 ] ) ),
+				                           byte_order_mask );
+			}
+			message = _mm_add_epi32(
+			           messages[ group_index % 4 ],
+			           _mm_loadu_si128(
+			            (const __m128i *) &( sha256_context_round_constants[ group_index * 4 ] ) ) );
+
+			cdgh_state = _mm_sha256rnds2_epu32(
+			              cdgh_state,
+			              abef_state,
+			              message );
+
+			if( ( group_index >= 3 )
+			 && ( group_index <= 14 ) )
+			{
+				value_128bit = _mm_alignr_epi8(
+				                messages[ group_index % 4 ],
+				                messages[ ( group_index + 3 ) % 4 ],
+				                4 );
+
+				messages[ ( group_index + 1 ) % 4 ] = _mm_sha256msg2_epu32(
+				                                       _mm_add_epi32(
+				                                        messages[ ( group_index + 1 ) % 4 ],
+				                                        value_128bit ),
+				                                       messages[ group_index % 4 ] );
+			}
+			message = _mm_shuffle_epi32(
+			           message,
+			           0x0e );
+
+			abef_state = _mm_sha256rnds2_epu32(
+			              abef_state,
+			              cdgh_state,
+			              message );
+
+			if( ( group_index >= 1 )
+			 && ( group_index <= 12 ) )
+			{
+				messages[ ( group_index + 3 ) % 4 ] = _mm_sha256msg1_epu32(
+				                                       messages[ ( group_index + 3 ) % 4 ],
+				                                       messages[ group_index % 4 ] );
+			}
+		}
+		abef_state = _mm_add_epi32(
+		              abef_state,
+		              abef_state_saved );
+		cdgh_state = _mm_add_epi32(
+		              cdgh_state,
+		              cdgh_state_saved );
+
+		blocks           += SHA256_CONTEXT_BLOCK_SIZE;
+		number_of_blocks -= 1;
+	}
+	value_128bit = _mm_shuffle_epi32(
+	                abef_state,
+	                0x1b );
+	cdgh_state   = _mm_shuffle_epi32(
+	                cdgh_state,
+	                0xb1 );
+	abef_state   = _mm_blend_epi16(
+	                value_128bit,
+	                cdgh_state,
+	                0xf0 );
+	cdgh_state   = _mm_alignr_epi8(
+	                cdgh_state,
+	                value_128bit,
+	                8 );
+
+	_mm_storeu_si128(
+	 (__m128i *) &( hash_values[ 0 ] ),
+	 abef_state );
+	_mm_storeu_si128(
+	 (__m128i *) &( hash_values[ 4 ] ),
+	 cdgh_state );
+}
+
+#endif /* defined( HAVE_SHA256_CONTEXT_X86_SHA_NI ) */
+
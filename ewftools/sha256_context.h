@@ -0,0 +1,131 @@
+/*
+ * SHA-256 context functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _SHA256_CONTEXT_H )
+#define _SHA256_CONTEXT_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libhmac.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The SHA extensions kernel requires a compiler that supports
+ * function specific target options and CPUID
+ */
+#if ( defined( __x86_64__ ) || defined( __i386__ ) ) && ( defined( __clang__ ) || ( defined( __GNUC__ ) && ( __GNUC__ >= 5 ) ) )
+#define HAVE_SHA256_CONTEXT_X86_SHA_NI	1
+#endif
+
+#define SHA256_CONTEXT_BLOCK_SIZE	64
+
+/* The size of the state, which consists of the hash values,
+ * the number of bytes hashed and the block
+ */
+#define SHA256_CONTEXT_STATE_SIZE	( 32 + 8 + SHA256_CONTEXT_BLOCK_SIZE )
+
+typedef struct sha256_context sha256_context_t;
+
+/* The SHA-256 context calculates the SHA-256 using the SHA extensions of the CPU
+ * when supported and otherwise falls back to libhmac, which in turn can use
+ * the OpenSSL EVP functions
+ */
+struct sha256_context
+{
+	/* The libhmac SHA-256 context
+	 */
+	libhmac_sha256_context_t *libhmac_context;
+
+	/* The hash values
+	 */
+	uint32_t hash_values[ 8 ];
+
+	/* The block
+	 */
+	uint8_t block[ SHA256_CONTEXT_BLOCK_SIZE ];
+
+	/* The size of the data in the block
+	 */
+	size_t block_data_size;
+
+	/* The number of bytes hashed
+	 */
+	uint64_t hash_count;
+
+	/* Value to indicate the SHA extensions are used
+	 */
+	uint8_t use_sha_extensions;
+};
+
+int sha256_context_initialize(
+     sha256_context_t **context,
+     libcerror_error_t **error );
+
+int sha256_context_free(
+     sha256_context_t **context,
+     libcerror_error_t **error );
+
+int sha256_context_update(
+     sha256_context_t *context,
+     const uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error );
+
+int sha256_context_finalize(
+     sha256_context_t *context,
+     uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error );
+
+int sha256_context_get_state(
+     sha256_context_t *context,
+     uint8_t *state,
+     size_t state_size,
+     libcerror_error_t **error );
+
+int sha256_context_set_state(
+     sha256_context_t *context,
+     const uint8_t *state,
+     size_t state_size,
+     libcerror_error_t **error );
+
+#if defined( HAVE_SHA256_CONTEXT_X86_SHA_NI )
+
+int sha256_context_has_sha_extensions(
+     void );
+
+void sha256_context_transform_sha_extensions(
+      uint32_t hash_values[ 8 ],
+      const uint8_t *blocks,
+      size_t number_of_blocks );
+
+#endif /* defined( HAVE_SHA256_CONTEXT_X86_SHA_NI ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _SHA256_CONTEXT_H ) */
+
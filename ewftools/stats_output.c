@@ -0,0 +1,890 @@
+/*
+ * Statistics output functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include <stdio.h>
+#include <time.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_timestamp.h"
+#include "stats_output.h"
+#include "storage_media_buffer_queue.h"
+
+/* The names of the stages as used in the records
+ */
+static const char *stats_output_stage_names[ STATS_OUTPUT_NUMBER_OF_STAGES ] = {
+	"read",
+	"process",
+	"hash",
+	"write" };
+
+/* Creates statistics output
+ * Make sure the value stats_output is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int stats_output_initialize(
+     stats_output_t **stats_output,
+     const char *tool_name,
+     libcerror_error_t **error )
+{
+	static char *function = "stats_output_initialize";
+
+	if( stats_output == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics output.",
+		 function );
+
+		return( -1 );
+	}
+	if( *stats_output != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid statistics output value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( tool_name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tool name.",
+		 function );
+
+		return( -1 );
+	}
+	*stats_output = memory_allocate_structure(
+	                 stats_output_t );
+
+	if( *stats_output == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create statistics output.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *stats_output,
+	     0,
+	     sizeof( stats_output_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear statistics output.",
+		 function );
+
+		memory_free(
+		 *stats_output );
+
+		*stats_output = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *stats_output )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *stats_output )->tool_name = tool_name;
+
+	return( 1 );
+
+on_error:
+	if( *stats_output != NULL )
+	{
+		memory_free(
+		 *stats_output );
+
+		*stats_output = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees statistics output
+ * Returns 1 if successful or -1 on error
+ */
+int stats_output_free(
+     stats_output_t **stats_output,
+     libcerror_error_t **error )
+{
+	static char *function = "stats_output_free";
+	int result            = 1;
+
+	if( stats_output == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics output.",
+		 function );
+
+		return( -1 );
+	}
+	if( *stats_output != NULL )
+	{
+		if( ( *stats_output )->stream != NULL )
+		{
+			if( stats_output_close(
+			     *stats_output,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close statistics output.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *stats_output )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *stats_output );
+
+		*stats_output = NULL;
+	}
+	return( result );
+}
+
+/* Opens the statistics output on a file descriptor
+ * The standard output and error file descriptors are not closed by stats_output_close
+ * Returns 1 if successful or -1 on error
+ */
+int stats_output_open_file_descriptor(
+     stats_output_t *stats_output,
+     int file_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "stats_output_open_file_descriptor";
+
+	if( stats_output == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics output.",
+		 function );
+
+		return( -1 );
+	}
+	if( stats_output->stream != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid statistics output - stream value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_descriptor < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid file descriptor value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_descriptor == 1 )
+	{
+		stats_output->stream = stdout;
+	}
+	else if( file_descriptor == 2 )
+	{
+		stats_output->stream = stderr;
+	}
+	else
+	{
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+		stats_output->stream = _fdopen(
+		                        file_descriptor,
+		                        "w" );
+#else
+		stats_output->stream = fdopen(
+		                        file_descriptor,
+		                        "w" );
+#endif
+		if( stats_output->stream == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file descriptor: %d.",
+			 function,
+			 file_descriptor );
+
+			return( -1 );
+		}
+		stats_output->close_stream = 1;
+	}
+	return( 1 );
+}
+
+/* Closes the statistics output
+ * Returns the 0 if succesful or -1 on error
+ */
+int stats_output_close(
+     stats_output_t *stats_output,
+     libcerror_error_t **error )
+{
+	static char *function = "stats_output_close";
+
+	if( stats_output == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics output.",
+		 function );
+
+		return( -1 );
+	}
+	if( stats_output->stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid statistics output - missing stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( stats_output->close_stream != 0 )
+	{
+		if( file_stream_close(
+		     stats_output->stream ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close stream.",
+			 function );
+
+			return( -1 );
+		}
+		stats_output->close_stream = 0;
+	}
+	stats_output->stream = NULL;
+
+	return( 0 );
+}
+
+/* Adds an operation of a stage
+ * The start timestamp is the timestamp retrieved by ewftools_timestamp_get_monotonic before the operation
+ * Returns 1 if successful or -1 on error
+ */
+int stats_output_add_stage(
+     stats_output_t *stats_output,
+     int stage,
+     size64_t number_of_bytes,
+     int64_t start_timestamp,
+     libcerror_error_t **error )
+{
+	static char *function = "stats_output_add_stage";
+	int64_t timestamp     = 0;
+
+	if( stats_output == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics output.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( stage < 0 )
+	 || ( stage >= STATS_OUTPUT_NUMBER_OF_STAGES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported stage.",
+		 function );
+
+		return( -1 );
+	}
+	if( ewftools_timestamp_get_monotonic(
+	     &timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve timestamp.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     stats_output->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	stats_output->stages[ stage ].number_of_operations += 1;
+	stats_output->stages[ stage ].number_of_bytes      += number_of_bytes;
+
+	if( timestamp > start_timestamp )
+	{
+		stats_output->stages[ stage ].busy_time += (uint64_t) ( timestamp - start_timestamp );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     stats_output->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Retrieves the storage media buffer queue values
+ * Returns 1 if successful or -1 on error
+ */
+int stats_output_get_queue_values(
+     stats_output_t *stats_output,
+     libcerror_error_t **error )
+{
+	static char *function = "stats_output_get_queue_values";
+
+	if( stats_output == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics output.",
+		 function );
+
+		return( -1 );
+	}
+	if( stats_output->storage_media_buffer_queue == NULL )
+	{
+		return( 1 );
+	}
+	if( storage_media_buffer_queue_get_statistics(
+	     stats_output->storage_media_buffer_queue,
+	     &( stats_output->queue_values.number_of_buffers ),
+	     &( stats_output->queue_values.number_of_grabs ),
+	     &( stats_output->queue_values.number_of_blocked_grabs ),
+	     &( stats_output->queue_values.blocked_time ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve storage media buffer queue statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer_queue_get_output_statistics(
+	     stats_output->storage_media_buffer_queue,
+	     &( stats_output->queue_values.number_of_output_stalls ),
+	     &( stats_output->queue_values.output_stall_time ),
+	     &( stats_output->queue_values.maximum_number_of_pending_buffers ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve storage media buffer queue output statistics.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the storage media buffer queue of which the depth and stalls are reported
+ * The queue values are retained when the queue is unset, so that they are
+ * still reported after the queue has been freed
+ * Returns 1 if successful or -1 on error
+ */
+int stats_output_set_storage_media_buffer_queue(
+     stats_output_t *stats_output,
+     storage_media_buffer_queue_t *storage_media_buffer_queue,
+     libcerror_error_t **error )
+{
+	static char *function = "stats_output_set_storage_media_buffer_queue";
+	int result            = 1;
+
+	if( stats_output == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics output.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     stats_output->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( stats_output_get_queue_values(
+	     stats_output,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve queue values.",
+		 function );
+
+		result = -1;
+	}
+	stats_output->storage_media_buffer_queue = storage_media_buffer_queue;
+
+	if( libcthreads_mutex_release(
+	     stats_output->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Writes a record
+ * A record contains the progress, the totals of every stage and the throughput
+ * and utilization of the stages since the previous record
+ * The rates are written as integers so that they do not depend on the locale
+ * Returns 1 if successful or -1 on error
+ */
+int stats_output_write_record(
+     stats_output_t *stats_output,
+     const char *event,
+     size64_t bytes_done,
+     size64_t bytes_total,
+     libcerror_error_t **error )
+{
+	stats_output_stage_t stages[ STATS_OUTPUT_NUMBER_OF_STAGES ];
+	stats_output_stage_t last_stages[ STATS_OUTPUT_NUMBER_OF_STAGES ];
+
+	stats_output_queue_values_t queue_values;
+
+	static char *function      = "stats_output_write_record";
+	uint64_t busy_time         = 0;
+	uint64_t bytes_per_second  = 0;
+	uint64_t elapsed_time      = 0;
+	uint64_t interval_time     = 0;
+	uint64_t number_of_bytes   = 0;
+	int64_t last_timestamp     = 0;
+	int64_t timestamp          = 0;
+	size64_t last_bytes_done   = 0;
+	int stage                  = 0;
+
+	if( stats_output == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics output.",
+		 function );
+
+		return( -1 );
+	}
+	if( stats_output->stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid statistics output - missing stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( event == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid event.",
+		 function );
+
+		return( -1 );
+	}
+	if( ewftools_timestamp_get_monotonic(
+	     &timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve timestamp.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     stats_output->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( stats_output_get_queue_values(
+	     stats_output,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve queue values.",
+		 function );
+
+		libcthreads_mutex_release(
+		 stats_output->mutex,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	for( stage = 0;
+	     stage < STATS_OUTPUT_NUMBER_OF_STAGES;
+	     stage++ )
+	{
+		stages[ stage ]      = stats_output->stages[ stage ];
+		last_stages[ stage ] = stats_output->last_stages[ stage ];
+
+		stats_output->last_stages[ stage ] = stages[ stage ];
+	}
+	queue_values    = stats_output->queue_values;
+	last_timestamp  = stats_output->last_timestamp;
+	last_bytes_done = stats_output->last_bytes_done;
+
+	stats_output->last_timestamp  = timestamp;
+	stats_output->last_bytes_done = bytes_done;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     stats_output->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( timestamp > stats_output->start_timestamp )
+	{
+		elapsed_time = (uint64_t) ( timestamp - stats_output->start_timestamp );
+	}
+	if( timestamp > last_timestamp )
+	{
+		interval_time = (uint64_t) ( timestamp - last_timestamp );
+	}
+	if( ( interval_time > 0 )
+	 && ( bytes_done > last_bytes_done ) )
+	{
+		bytes_per_second = ( ( bytes_done - last_bytes_done ) * 1000 ) / ( interval_time / 1000000 + 1 );
+	}
+	fprintf(
+	 stats_output->stream,
+	 "{\"tool\":\"%s\",\"event\":\"%s\",\"elapsed_ns\":%" PRIu64 ",\"interval_ns\":%" PRIu64 ","
+	 "\"bytes_done\":%" PRIu64 ",\"bytes_total\":%" PRIu64 ",\"bytes_per_second\":%" PRIu64 ",\"stages\":{",
+	 stats_output->tool_name,
+	 event,
+	 elapsed_time,
+	 interval_time,
+	 bytes_done,
+	 bytes_total,
+	 bytes_per_second );
+
+	for( stage = 0;
+	     stage < STATS_OUTPUT_NUMBER_OF_STAGES;
+	     stage++ )
+	{
+		number_of_bytes  = stages[ stage ].number_of_bytes - last_stages[ stage ].number_of_bytes;
+		busy_time        = stages[ stage ].busy_time - last_stages[ stage ].busy_time;
+		bytes_per_second = 0;
+
+		if( interval_time > 0 )
+		{
+			bytes_per_second = ( number_of_bytes * 1000 ) / ( interval_time / 1000000 + 1 );
+		}
+		/* The busy percentage exceeds 100 when the stage runs on multiple threads,
+		 * a stage that is busy for most of the interval is the bottleneck
+		 */
+		fprintf(
+		 stats_output->stream,
+		 "%s\"%s\":{\"operations\":%" PRIu64 ",\"bytes\":%" PRIu64 ",\"busy_ns\":%" PRIu64 ","
+		 "\"bytes_per_second\":%" PRIu64 ",\"busy_bytes_per_second\":%" PRIu64 ",\"busy_percent\":%" PRIu64 "}",
+		 ( stage == 0 ) ? "" : ",",
+		 stats_output_stage_names[ stage ],
+		 stages[ stage ].number_of_operations,
+		 stages[ stage ].number_of_bytes,
+		 stages[ stage ].busy_time,
+		 bytes_per_second,
+		 ( busy_time > 0 ) ? ( number_of_bytes * 1000 ) / ( busy_time / 1000000 + 1 ) : 0,
+		 ( interval_time > 0 ) ? ( busy_time * 100 ) / interval_time : 0 );
+	}
+	fprintf(
+	 stats_output->stream,
+	 "},\"queue\":{\"buffers\":%d,\"grabs\":%" PRIu64 ",\"blocked_grabs\":%" PRIu64 ",\"blocked_ns\":%" PRIu64 ","
+	 "\"output_stalls\":%" PRIu64 ",\"output_stall_ns\":%" PRIu64 ",\"maximum_pending_buffers\":%d}}\n",
+	 queue_values.number_of_buffers,
+	 queue_values.number_of_grabs,
+	 queue_values.number_of_blocked_grabs,
+	 queue_values.blocked_time,
+	 queue_values.number_of_output_stalls,
+	 queue_values.output_stall_time,
+	 queue_values.maximum_number_of_pending_buffers );
+
+	fflush(
+	 stats_output->stream );
+
+	return( 1 );
+}
+
+/* Starts the statistics output
+ * Returns 1 if successful or -1 on error
+ */
+int stats_output_start(
+     stats_output_t *stats_output,
+     libcerror_error_t **error )
+{
+	static char *function = "stats_output_start";
+
+	if( stats_output == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics output.",
+		 function );
+
+		return( -1 );
+	}
+	if( ewftools_timestamp_get_monotonic(
+	     &( stats_output->start_timestamp ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	stats_output->last_timestamp  = stats_output->start_timestamp;
+	stats_output->last_bytes_done = 0;
+
+	if( stats_output_write_record(
+	     stats_output,
+	     "start",
+	     0,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write record.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Updates the statistics output
+ * A progress record is written if the progress interval has passed since the last record
+ * Returns 1 if successful or -1 on error
+ */
+int stats_output_update(
+     stats_output_t *stats_output,
+     size64_t bytes_done,
+     size64_t bytes_total,
+     libcerror_error_t **error )
+{
+	static char *function = "stats_output_update";
+	int64_t timestamp     = 0;
+
+	if( stats_output == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics output.",
+		 function );
+
+		return( -1 );
+	}
+	if( ewftools_timestamp_get_monotonic(
+	     &timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( timestamp - stats_output->last_timestamp ) < STATS_OUTPUT_PROGRESS_INTERVAL )
+	{
+		return( 1 );
+	}
+	if( stats_output_write_record(
+	     stats_output,
+	     "progress",
+	     bytes_done,
+	     bytes_total,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write record.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,213 @@
+/*
+ * Statistics output functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _STATS_OUTPUT_H )
+#define _STATS_OUTPUT_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "storage_media_buffer_queue.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The minimum interval between progress records in nano seconds
+ */
+#define STATS_OUTPUT_PROGRESS_INTERVAL		1000000000
+
+enum STATS_OUTPUT_STAGES
+{
+	STATS_OUTPUT_STAGE_READ			= 0,
+	STATS_OUTPUT_STAGE_PROCESS		= 1,
+	STATS_OUTPUT_STAGE_HASH			= 2,
+	STATS_OUTPUT_STAGE_WRITE		= 3,
+
+	STATS_OUTPUT_NUMBER_OF_STAGES		= 4
+};
+
+typedef struct stats_output_stage stats_output_stage_t;
+
+struct stats_output_stage
+{
+	/* The number of operations
+	 */
+	uint64_t number_of_operations;
+
+	/* The number of bytes
+	 */
+	uint64_t number_of_bytes;
+
+	/* The time spent in the stage in nano seconds
+	 */
+	uint64_t busy_time;
+};
+
+typedef struct stats_output_queue_values stats_output_queue_values_t;
+
+struct stats_output_queue_values
+{
+	/* The number of buffers
+	 */
+	int number_of_buffers;
+
+	/* The number of buffers grabbed
+	 */
+	uint64_t number_of_grabs;
+
+	/* The number of grabs that had to wait for a buffer to be released
+	 */
+	uint64_t number_of_blocked_grabs;
+
+	/* The time in nano seconds grabs had to wait for a buffer to be released
+	 */
+	uint64_t blocked_time;
+
+	/* The number of times the output had to wait on the buffer with the next offset
+	 */
+	uint64_t number_of_output_stalls;
+
+	/* The time in nano seconds the output had to wait on the buffer with the next offset
+	 */
+	uint64_t output_stall_time;
+
+	/* The maximum number of buffers that were pending in the output
+	 */
+	int maximum_number_of_pending_buffers;
+};
+
+typedef struct stats_output stats_output_t;
+
+/* The statistics output writes the progress and the per stage throughput
+ * of a tool as JSON lines, one object per line, to a stream
+ */
+struct stats_output
+{
+	/* The name of the tool
+	 */
+	const char *tool_name;
+
+	/* The output stream
+	 */
+	FILE *stream;
+
+	/* Value to indicate the output stream should be closed
+	 */
+	uint8_t close_stream;
+
+	/* The stages
+	 */
+	stats_output_stage_t stages[ STATS_OUTPUT_NUMBER_OF_STAGES ];
+
+	/* The stages at the time of the last record
+	 */
+	stats_output_stage_t last_stages[ STATS_OUTPUT_NUMBER_OF_STAGES ];
+
+	/* The timestamp of the start
+	 */
+	int64_t start_timestamp;
+
+	/* The timestamp of the last record
+	 */
+	int64_t last_timestamp;
+
+	/* The number of bytes done at the time of the last record
+	 */
+	size64_t last_bytes_done;
+
+	/* The storage media buffer queue values
+	 */
+	stats_output_queue_values_t queue_values;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The storage media buffer queue
+	 */
+	storage_media_buffer_queue_t *storage_media_buffer_queue;
+
+	/* The mutex that protects the stages
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int stats_output_initialize(
+     stats_output_t **stats_output,
+     const char *tool_name,
+     libcerror_error_t **error );
+
+int stats_output_free(
+     stats_output_t **stats_output,
+     libcerror_error_t **error );
+
+int stats_output_open_file_descriptor(
+     stats_output_t *stats_output,
+     int file_descriptor,
+     libcerror_error_t **error );
+
+int stats_output_close(
+     stats_output_t *stats_output,
+     libcerror_error_t **error );
+
+int stats_output_add_stage(
+     stats_output_t *stats_output,
+     int stage,
+     size64_t number_of_bytes,
+     int64_t start_timestamp,
+     libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+int stats_output_get_queue_values(
+     stats_output_t *stats_output,
+     libcerror_error_t **error );
+
+int stats_output_set_storage_media_buffer_queue(
+     stats_output_t *stats_output,
+     storage_media_buffer_queue_t *storage_media_buffer_queue,
+     libcerror_error_t **error );
+#endif
+
+int stats_output_write_record(
+     stats_output_t *stats_output,
+     const char *event,
+     size64_t bytes_done,
+     size64_t bytes_total,
+     libcerror_error_t **error );
+
+int stats_output_start(
+     stats_output_t *stats_output,
+     libcerror_error_t **error );
+
+int stats_output_update(
+     stats_output_t *stats_output,
+     size64_t bytes_done,
+     size64_t bytes_total,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _STATS_OUTPUT_H ) */
+
@@ -199,6 +199,66 @@ on_error:
 	return( -1 );
 }
 
+/* Creates a storage media buffer that uses an existing raw buffer
+ * The raw buffer is not freed when the storage media buffer is freed
+ * Make sure the value buffer is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_initialize_with_raw_buffer(
+     storage_media_buffer_t **buffer,
+     libewf_handle_t *handle,
+     uint8_t mode,
+     uint8_t *raw_buffer,
+     size_t raw_buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_initialize_with_raw_buffer";
+
+	if( raw_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid raw buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( raw_buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid raw buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer_initialize(
+	     buffer,
+	     handle,
+	     mode,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create buffer.",
+		 function );
+
+		return( -1 );
+	}
+	( *buffer )->raw_buffer             = raw_buffer;
+	( *buffer )->raw_buffer_size        = raw_buffer_size;
+	( *buffer )->raw_buffer_is_external = 1;
+
+	return( 1 );
+}
+
 /* Frees a storage media buffer
  * Returns 1 if successful or -1 on error
  */
@@ -222,11 +282,22 @@ int storage_media_buffer_free(
 	}
 	if( *buffer != NULL )
 	{
-		if( ( *buffer )->raw_buffer != NULL )
+		if( ( ( *buffer )->raw_buffer != NULL )
+		 && ( ( *buffer )->raw_buffer_is_external == 0 ) )
 		{
 			memory_free(
 			 ( *buffer )->raw_buffer );
 		}
+		if( ( *buffer )->fingerprints != NULL )
+		{
+			memory_free(
+			 ( *buffer )->fingerprints );
+		}
+		if( ( *buffer )->compressed_buffer != NULL )
+		{
+			memory_free(
+			 ( *buffer )->compressed_buffer );
+		}
 		if( ( *buffer )->data_chunk != NULL )
 		{
 			if( libewf_data_chunk_free(
@@ -301,6 +372,106 @@ int storage_media_buffer_get_data(
 	return( 1 );
 }
 
+/* Determines if the data in the storage media buffer is filled with 0-byte values
+ * Returns 1 if zero-filled, 0 if not or -1 on error
+ */
+int storage_media_buffer_is_zero_filled(
+     storage_media_buffer_t *buffer,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	const uint64_t *aligned_data_index = NULL;
+	const uint8_t *data_index          = NULL;
+	static char *function              = "storage_media_buffer_is_zero_filled";
+	uint64_t aligned_value             = 0;
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer->raw_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid buffer - missing raw buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > buffer->raw_buffer_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == 0 )
+	{
+		return( 0 );
+	}
+	data_index = buffer->raw_buffer;
+
+	while( ( data_size > 0 )
+	    && ( ( (intptr_t) data_index % sizeof( uint64_t ) ) != 0 ) )
+	{
+		if( *data_index != 0 )
+		{
+			return( 0 );
+		}
+		data_index++;
+		data_size--;
+	}
+	aligned_data_index = (const uint64_t *) data_index;
+
+	/* Combine blocks of 8 aligned values without intermediate branches
+	 * so that the compiler can vectorize the comparison
+	 */
+	while( data_size >= ( 8 * sizeof( uint64_t ) ) )
+	{
+		aligned_value = aligned_data_index[ 0 ]
+		              | aligned_data_index[ 1 ]
+		              | aligned_data_index[ 2 ]
+		              | aligned_data_index[ 3 ]
+		              | aligned_data_index[ 4 ]
+		              | aligned_data_index[ 5 ]
+		              | aligned_data_index[ 6 ]
+		              | aligned_data_index[ 7 ];
+
+		if( aligned_value != 0 )
+		{
+			return( 0 );
+		}
+		aligned_data_index += 8;
+
+		data_size -= 8 * sizeof( uint64_t );
+	}
+	data_index = (const uint8_t *) aligned_data_index;
+
+	while( data_size > 0 )
+	{
+		if( *data_index != 0 )
+		{
+			return( 0 );
+		}
+		data_index++;
+		data_size--;
+	}
+	return( 1 );
+}
+
 /* Compares two storage media buffers
  * Returns LIBCDATA_COMPARE_LESS, LIBCDATA_COMPARE_EQUAL, LIBCDATA_COMPARE_GREATER
  * if successful or -1 on error
@@ -407,6 +578,85 @@ ssize_t storage_media_buffer_read_from_handle(
 	return( read_count );
 }
 
+/* Reads a storage media buffer from the input handle at a specific offset
+ * Unlike storage_media_buffer_read_from_handle this function does not change
+ * the current offset of the handle and can be called by multiple threads
+ * at the same time, which is only supported in buffered mode
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t storage_media_buffer_read_from_handle_at_offset(
+         storage_media_buffer_t *storage_media_buffer,
+         libewf_handle_t *handle,
+         size_t read_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_read_from_handle_at_offset";
+	ssize_t read_count    = 0;
+
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer->mode != STORAGE_MEDIA_BUFFER_MODE_BUFFERED )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid storage media buffer - unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_size > storage_media_buffer->raw_buffer_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_size == 0 )
+	{
+		return( 0 );
+	}
+	read_count = libewf_handle_read_buffer_at_offset_concurrent(
+	              handle,
+	              storage_media_buffer->raw_buffer,
+	              read_size,
+	              offset,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read storage media buffer at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	storage_media_buffer->storage_media_offset = offset;
+	storage_media_buffer->raw_buffer_data_size = (size_t) read_count;
+	storage_media_buffer->requested_size       = read_size;
+
+	return( read_count );
+}
+
 /* Processes a storage media buffer after read
  * Returns the resulting buffer size or -1 on error
  */
@@ -62,6 +62,11 @@ struct storage_media_buffer
 	 */
 	size_t raw_buffer_data_size;
 
+	/* Value to indicate the raw buffer is owned by the creator of the buffer
+	 * such as the region of a storage media buffer queue and is not freed
+	 */
+	uint8_t raw_buffer_is_external;
+
 	/* The data chunk
 	 */
 	libewf_data_chunk_t *data_chunk;
@@ -73,6 +78,42 @@ struct storage_media_buffer
 	/* The processed size
 	 */
 	size_t processed_size;
+
+	/* The index of the (NUMA) node that owns the memory of the raw buffer
+	 */
+	int node_index;
+
+	/* The chunk fingerprints of the data
+	 */
+	uint8_t *fingerprints;
+
+	/* The size of the chunk fingerprints
+	 */
+	size_t fingerprints_size;
+
+	/* The size of the data the chunk fingerprints were calculated of
+	 */
+	size_t fingerprints_data_size;
+
+	/* The compressed buffer, used by outputs that compress the data in the process threads
+	 */
+	uint8_t *compressed_buffer;
+
+	/* The compressed buffer size
+	 */
+	size_t compressed_buffer_size;
+
+	/* The size of the data in the compressed buffer
+	 */
+	size_t compressed_buffer_data_size;
+
+	/* The size of the data the compressed buffer was created of
+	 */
+	size_t compressed_buffer_input_size;
+
+	/* The number of references held in addition to that of the grabber of the buffer
+	 */
+	int number_of_references;
 };
 
 int storage_media_buffer_initialize(
@@ -82,6 +123,14 @@ int storage_media_buffer_initialize(
      size_t size,
      libcerror_error_t **error );
 
+int storage_media_buffer_initialize_with_raw_buffer(
+     storage_media_buffer_t **buffer,
+     libewf_handle_t *handle,
+     uint8_t mode,
+     uint8_t *raw_buffer,
+     size_t raw_buffer_size,
+     libcerror_error_t **error );
+
 int storage_media_buffer_free(
      storage_media_buffer_t **buffer,
      libcerror_error_t **error );
@@ -92,6 +141,11 @@ int storage_media_buffer_get_data(
      size_t *data_size,
      libcerror_error_t **error );
 
+int storage_media_buffer_is_zero_filled(
+     storage_media_buffer_t *buffer,
+     size_t data_size,
+     libcerror_error_t **error );
+
 int storage_media_buffer_compare(
      storage_media_buffer_t *first_buffer,
      storage_media_buffer_t *second_buffer,
@@ -103,6 +157,13 @@ ssize_t storage_media_buffer_read_from_handle(
          size_t read_size,
          libcerror_error_t **error );
 
+ssize_t storage_media_buffer_read_from_handle_at_offset(
+         storage_media_buffer_t *storage_media_buffer,
+         libewf_handle_t *handle,
+         size_t read_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
 ssize_t storage_media_buffer_read_process(
          storage_media_buffer_t *storage_media_buffer,
          libcerror_error_t **error );
@@ -22,29 +22,139 @@
 #include <common.h>
 #include <memory.h>
 
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_SYS_MMAN_H )
+#include <sys/mman.h>
+#endif
+
+#include <time.h>
+
 #include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
 #include "ewftools_libcthreads.h"
 #include "ewftools_libewf.h"
+#include "ewftools_timestamp.h"
+#include "numa_topology.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
 
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 
-/* Creates a storage media buffer queue
- * Make sure the value queue is referencing, is set to NULL
+/* Determines the maximum number of storage media buffers that fit in the memory budget
+ * A memory budget of 0 represents the default memory budget, the budget is restricted
+ * to the available physical memory if it can be determined
+ * The maximum number of buffers is at least the minimum number of buffers
  * Returns 1 if successful or -1 on error
  */
-int storage_media_buffer_queue_initialize(
-     libcthreads_queue_t **queue,
-     libewf_handle_t *handle,
-     int maximum_number_of_values,
-     uint8_t storage_media_buffer_mode,
+int storage_media_buffer_queue_get_maximum_number_of_buffers(
+     size64_t memory_budget,
      size_t storage_media_buffer_size,
+     int minimum_number_of_buffers,
+     int *maximum_number_of_buffers,
+     libcerror_error_t **error )
+{
+	static char *function          = "storage_media_buffer_queue_get_maximum_number_of_buffers";
+	size64_t number_of_buffers     = 0;
+
+#if defined( HAVE_SYSCONF ) && defined( _SC_AVPHYS_PAGES ) && defined( _SC_PAGESIZE )
+	size64_t available_memory_size = 0;
+	long number_of_available_pages = 0;
+	long page_size                 = 0;
+#endif
+
+	if( storage_media_buffer_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid storage media buffer size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( minimum_number_of_buffers < 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid minimum number of buffers value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum number of buffers.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_budget == 0 )
+	{
+		memory_budget = STORAGE_MEDIA_BUFFER_QUEUE_DEFAULT_MEMORY_BUDGET;
+
+#if defined( HAVE_SYSCONF ) && defined( _SC_AVPHYS_PAGES ) && defined( _SC_PAGESIZE )
+		/* Do not use more than half of the available physical memory by default
+		 */
+		number_of_available_pages = sysconf(
+		                             _SC_AVPHYS_PAGES );
+
+		page_size = sysconf(
+		             _SC_PAGESIZE );
+
+		if( ( number_of_available_pages > 0 )
+		 && ( page_size > 0 ) )
+		{
+			available_memory_size = (size64_t) number_of_available_pages * (size64_t) page_size;
+
+			if( memory_budget > ( available_memory_size / 2 ) )
+			{
+				memory_budget = available_memory_size / 2;
+			}
+		}
+#endif
+	}
+	number_of_buffers = memory_budget / storage_media_buffer_size;
+
+	if( number_of_buffers < (size64_t) minimum_number_of_buffers )
+	{
+		number_of_buffers = (size64_t) minimum_number_of_buffers;
+	}
+	else if( number_of_buffers > (size64_t) STORAGE_MEDIA_BUFFER_QUEUE_MAXIMUM_NUMBER_OF_BUFFERS )
+	{
+		number_of_buffers = (size64_t) STORAGE_MEDIA_BUFFER_QUEUE_MAXIMUM_NUMBER_OF_BUFFERS;
+	}
+	*maximum_number_of_buffers = (int) number_of_buffers;
+
+	return( 1 );
+}
+
+/* Maps the region the raw buffers of the queue are carved from
+ * The region is mapped once for the maximum number of buffers and is backed
+ * by huge pages if available, either reserved (MAP_HUGETLB) or transparent
+ * (MADV_HUGEPAGE), pages are only committed when a buffer is first touched
+ * Returns 1 if successful, 0 if the region could not be mapped or -1 on error
+ */
+int storage_media_buffer_queue_allocate_region(
+     storage_media_buffer_queue_t *queue,
      libcerror_error_t **error )
 {
-	storage_media_buffer_t *buffer = NULL;
-	static char *function          = "storage_media_buffer_queue_initialize";
-	int value_index                = 0;
+	static char *function     = "storage_media_buffer_queue_allocate_region";
+	size_t region_buffer_size = 0;
+	size_t region_size        = 0;
+
+#if defined( HAVE_STORAGE_MEDIA_BUFFER_QUEUE_REGION_SUPPORT ) && defined( MAP_ANONYMOUS )
+	void *region              = NULL;
+#endif
 
 	if( queue == NULL )
 	{
@@ -57,108 +167,317 @@ int storage_media_buffer_queue_initialize(
 
 		return( -1 );
 	}
-	if( *queue != NULL )
+	if( queue->region != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid queue value already set.",
+		 "%s: invalid queue - region value already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( maximum_number_of_values < 0 )
-	 || ( maximum_number_of_values > (int) ( INT_MAX - 1 ) ) )
+	if( queue->number_of_buffers != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid queue - number of buffers value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( queue->maximum_number_of_buffers <= 0 )
+	{
+		return( 0 );
+	}
+	/* Add 1 to prevent the queue blocking if full
+	 */
+	region_buffer_size = queue->storage_media_buffer_size + 1;
+
+	if( ( region_buffer_size % STORAGE_MEDIA_BUFFER_QUEUE_REGION_ALIGNMENT ) != 0 )
+	{
+		region_buffer_size += STORAGE_MEDIA_BUFFER_QUEUE_REGION_ALIGNMENT - ( region_buffer_size % STORAGE_MEDIA_BUFFER_QUEUE_REGION_ALIGNMENT );
+	}
+	if( region_buffer_size > ( ( (size_t) SSIZE_MAX - STORAGE_MEDIA_BUFFER_QUEUE_HUGE_PAGE_SIZE ) / (size_t) queue->maximum_number_of_buffers ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid region size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	region_size = region_buffer_size * (size_t) queue->maximum_number_of_buffers;
+
+	if( ( region_size % STORAGE_MEDIA_BUFFER_QUEUE_HUGE_PAGE_SIZE ) != 0 )
+	{
+		region_size += STORAGE_MEDIA_BUFFER_QUEUE_HUGE_PAGE_SIZE - ( region_size % STORAGE_MEDIA_BUFFER_QUEUE_HUGE_PAGE_SIZE );
+	}
+#if defined( HAVE_STORAGE_MEDIA_BUFFER_QUEUE_REGION_SUPPORT ) && defined( MAP_ANONYMOUS )
+	region = MAP_FAILED;
+
+#if defined( MAP_HUGETLB )
+	region = mmap(
+	          NULL,
+	          region_size,
+	          PROT_READ | PROT_WRITE,
+	          MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+	          -1,
+	          0 );
+#endif
+	/* Fall back to transparent huge pages if no huge pages are reserved
+	 */
+	if( region == MAP_FAILED )
+	{
+		region = mmap(
+		          NULL,
+		          region_size,
+		          PROT_READ | PROT_WRITE,
+		          MAP_PRIVATE | MAP_ANONYMOUS,
+		          -1,
+		          0 );
+
+#if defined( HAVE_MADVISE ) && defined( MADV_HUGEPAGE )
+		if( region != MAP_FAILED )
+		{
+			/* The advice is only a hint hence a failure is not considered an error
+			 */
+			madvise(
+			 region,
+			 region_size,
+			 MADV_HUGEPAGE );
+		}
+#endif
+	}
+	if( region == MAP_FAILED )
+	{
+		return( 0 );
+	}
+	queue->region             = (uint8_t *) region;
+	queue->region_size        = region_size;
+	queue->region_buffer_size = region_buffer_size;
+
+	return( 1 );
+#else
+	return( 0 );
+#endif /* defined( HAVE_STORAGE_MEDIA_BUFFER_QUEUE_REGION_SUPPORT ) && defined( MAP_ANONYMOUS ) */
+}
+
+/* Unmaps the region the raw buffers of the queue are carved from
+ */
+void storage_media_buffer_queue_free_region(
+      storage_media_buffer_queue_t *queue )
+{
+	if( queue == NULL )
+	{
+		return;
+	}
+#if defined( HAVE_STORAGE_MEDIA_BUFFER_QUEUE_REGION_SUPPORT )
+	if( queue->region != NULL )
+	{
+		munmap(
+		 (void *) queue->region,
+		 queue->region_size );
+	}
+#endif
+	queue->region             = NULL;
+	queue->region_size        = 0;
+	queue->region_buffer_size = 0;
+}
+
+/* Creates a storage media buffer for the queue
+ * The buffers are distributed over the nodes of the NUMA topology
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_queue_create_buffer(
+     storage_media_buffer_queue_t *queue,
+     storage_media_buffer_t **buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_queue_create_buffer";
+	int node_index        = 0;
+	int number_of_nodes   = 1;
+	int result            = 0;
+
+	if( queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( queue->number_of_buffers >= queue->maximum_number_of_buffers )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid maximum number of values value exceeds maximum.",
+		 "%s: invalid queue - number of buffers value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	if( libcthreads_queue_initialize(
-	     queue,
-	     maximum_number_of_values,
-	     error ) != 1 )
+	if( queue->numa_topology != NULL )
+	{
+		if( numa_topology_get_number_of_nodes(
+		     queue->numa_topology,
+		     &number_of_nodes,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of NUMA nodes.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	node_index = queue->number_of_buffers % number_of_nodes;
+
+	/* The memory is placed on the node of the CPU that first touches it
+	 * hence the buffer is allocated and cleared while bound to its node
+	 */
+	if( number_of_nodes > 1 )
+	{
+		if( numa_topology_bind_current_thread(
+		     queue->numa_topology,
+		     node_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to bind thread to NUMA node: %d.",
+			 function,
+			 node_index );
+
+			goto on_error;
+		}
+	}
+	if( queue->region != NULL )
+	{
+		result = storage_media_buffer_initialize_with_raw_buffer(
+		          buffer,
+		          queue->handle,
+		          queue->storage_media_buffer_mode,
+		          &( ( queue->region )[ queue->number_of_buffers * queue->region_buffer_size ] ),
+		          queue->storage_media_buffer_size + 1,
+		          error );
+	}
+	else
+	{
+		/* Add 1 to prevent the queue blocking if full
+		 */
+		result = storage_media_buffer_initialize(
+		          buffer,
+		          queue->handle,
+		          queue->storage_media_buffer_mode,
+		          queue->storage_media_buffer_size + 1,
+		          error );
+	}
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to initialize storage media buffer queue.",
+		 "%s: unable to create storage media buffer.",
 		 function );
 
 		goto on_error;
 	}
-	for( value_index = 0;
-	     value_index < maximum_number_of_values;
-	     value_index++ )
+	if( number_of_nodes > 1 )
 	{
-		/* Add 1 to prevent the queue blocking if full
-		 */
-		if( storage_media_buffer_initialize(
-		     &buffer,
-		     handle,
-		     storage_media_buffer_mode,
-		     storage_media_buffer_size + 1,
-		     error ) != 1 )
+		if( memory_set(
+		     ( *buffer )->raw_buffer,
+		     0,
+		     ( *buffer )->raw_buffer_size ) == NULL )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create storage media buffer.",
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear storage media buffer.",
 			 function );
 
 			goto on_error;
 		}
-		if( libcthreads_queue_push(
-		     *queue,
-		     (intptr_t *) buffer,
-		     error ) == -1 )
+		if( numa_topology_unbind_current_thread(
+		     queue->numa_topology,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to push storage media buffer onto queue.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to unbind thread.",
 			 function );
 
 			goto on_error;
 		}
-		buffer = NULL;
 	}
+	( *buffer )->node_index = node_index;
+
+	queue->number_of_buffers += 1;
+
 	return( 1 );
 
 on_error:
-	if( buffer != NULL )
+	if( number_of_nodes > 1 )
 	{
-		storage_media_buffer_free(
-		 &buffer,
+		numa_topology_unbind_current_thread(
+		 queue->numa_topology,
 		 NULL );
 	}
-	if( *queue != NULL )
+	if( *buffer != NULL )
 	{
-		storage_media_buffer_queue_free(
-		 queue,
+		storage_media_buffer_free(
+		 buffer,
 		 NULL );
 	}
 	return( -1 );
 }
 
-/* Frees a storage media buffer queue
+/* Creates a storage media buffer queue
+ * Make sure the value queue is referencing, is set to NULL
+ * If a NUMA topology is provided the buffers are distributed over its nodes
+ * The queue starts with the initial number of buffers and grows on demand,
+ * when a grabber finds no free buffer, up to the maximum number of buffers
+ * If use huge pages is set the raw buffers are carved from a single region backed
+ * by huge pages, if the region cannot be mapped the buffers are allocated individually
  * Returns 1 if successful or -1 on error
  */
-int storage_media_buffer_queue_free(
-     libcthreads_queue_t **queue,
+int storage_media_buffer_queue_initialize(
+     storage_media_buffer_queue_t **queue,
+     libewf_handle_t *handle,
+     numa_topology_t *numa_topology,
+     int initial_number_of_values,
+     int maximum_number_of_values,
+     uint8_t storage_media_buffer_mode,
+     size_t storage_media_buffer_size,
+     uint8_t use_huge_pages,
      libcerror_error_t **error )
 {
-	static char *function = "storage_media_buffer_queue_free";
-	int result            = 1;
+	storage_media_buffer_queue_shard_t *shard = NULL;
+	storage_media_buffer_t *buffer            = NULL;
+	static char *function                     = "storage_media_buffer_queue_initialize";
+	size_t buffers_size                       = 0;
+	size_t shards_size                        = 0;
+	int number_of_shards                      = 0;
+	int shard_index                           = 0;
+	int value_index                           = 0;
 
 	if( queue == NULL )
 	{
@@ -173,75 +492,1269 @@ int storage_media_buffer_queue_free(
 	}
 	if( *queue != NULL )
 	{
-		if( libcthreads_queue_free(
-		     queue,
-		     (int (*)(intptr_t **, libcerror_error_t **)) &storage_media_buffer_free,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free storage media buffer queue.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid queue value already set.",
+		 function );
 
-			result = -1;
-		}
+		return( -1 );
 	}
-	return( result );
-}
-
-/* Grabs a storage media buffer from the queue
- * Returns 1 if successful or -1 on error
- */
-int storage_media_buffer_queue_grab_buffer(
-     libcthreads_queue_t *queue,
-     storage_media_buffer_t **buffer,
-     libcerror_error_t **error )
-{
-	static char *function = "storage_media_buffer_queue_grab_buffer";
-
-	if( libcthreads_queue_pop(
-	     queue,
-	     (intptr_t **) buffer,
-	     error ) != 1 )
+	if( ( maximum_number_of_values < 0 )
+	 || ( maximum_number_of_values > (int) ( INT_MAX - 1 ) )
+	 || ( (size_t) maximum_number_of_values > ( (size_t) SSIZE_MAX / sizeof( storage_media_buffer_t * ) ) ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-		 "%s: unable to pop storage media buffer from queue.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid maximum number of values value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	return( 1 );
-}
+	if( ( initial_number_of_values < 0 )
+	 || ( initial_number_of_values > maximum_number_of_values ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid initial number of values value out of bounds.",
+		 function );
 
-/* Releases a storage media buffer onto the queue
- * Returns 1 if successful or -1 on error
- */
-int storage_media_buffer_queue_release_buffer(
-     libcthreads_queue_t *queue,
-     storage_media_buffer_t *buffer,
-     libcerror_error_t **error )
-{
-	static char *function = "storage_media_buffer_queue_release_buffer";
+		return( -1 );
+	}
+	number_of_shards = maximum_number_of_values;
 
-	if( libcthreads_queue_push(
-	     queue,
-	     (intptr_t *) buffer,
-	     error ) != 1 )
+	if( number_of_shards > STORAGE_MEDIA_BUFFER_QUEUE_MAXIMUM_NUMBER_OF_SHARDS )
+	{
+		number_of_shards = STORAGE_MEDIA_BUFFER_QUEUE_MAXIMUM_NUMBER_OF_SHARDS;
+	}
+	else if( number_of_shards == 0 )
+	{
+		number_of_shards = 1;
+	}
+	*queue = memory_allocate_structure(
+	          storage_media_buffer_queue_t );
+
+	if( *queue == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to push storage media buffer onto queue.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create queue.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *queue,
+	     0,
+	     sizeof( storage_media_buffer_queue_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear queue.",
 		 function );
 
+		memory_free(
+		 *queue );
+
+		*queue = NULL;
+
 		return( -1 );
 	}
+	shards_size = sizeof( storage_media_buffer_queue_shard_t ) * number_of_shards;
+
+	( *queue )->shards = (storage_media_buffer_queue_shard_t *) memory_allocate(
+	                                                             shards_size );
+
+	if( ( *queue )->shards == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create shards.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *queue )->shards,
+	     0,
+	     shards_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear shards.",
+		 function );
+
+		memory_free(
+		 ( *queue )->shards );
+
+		( *queue )->shards = NULL;
+
+		goto on_error;
+	}
+	( *queue )->number_of_shards          = number_of_shards;
+	( *queue )->maximum_number_of_buffers = maximum_number_of_values;
+	( *queue )->handle                    = handle;
+	( *queue )->numa_topology             = numa_topology;
+	( *queue )->storage_media_buffer_mode = storage_media_buffer_mode;
+	( *queue )->storage_media_buffer_size = storage_media_buffer_size;
+	( *queue )->use_huge_pages            = use_huge_pages;
+
+	if( use_huge_pages != 0 )
+	{
+		if( storage_media_buffer_queue_allocate_region(
+		     *queue,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create region.",
+			 function );
+
+			goto on_error;
+		}
+	}
+
+	/* A buffer is always released onto the same free list and the buffers
+	 * are not necessarily evenly distributed, hence every free list
+	 * can hold all the buffers
+	 */
+	buffers_size = sizeof( storage_media_buffer_t * ) * ( maximum_number_of_values + 1 );
+
+	for( shard_index = 0;
+	     shard_index < number_of_shards;
+	     shard_index++ )
+	{
+		shard = &( ( *queue )->shards[ shard_index ] );
+
+		shard->buffers = (storage_media_buffer_t **) memory_allocate(
+		                                              buffers_size );
+
+		if( shard->buffers == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create shard: %d buffers.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+		if( libcthreads_mutex_initialize(
+		     &( shard->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create shard: %d mutex.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *queue )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *queue )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	for( value_index = 0;
+	     value_index < initial_number_of_values;
+	     value_index++ )
+	{
+		if( storage_media_buffer_queue_create_buffer(
+		     *queue,
+		     &buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create storage media buffer: %d.",
+			 function,
+			 value_index );
+
+			goto on_error;
+		}
+		if( storage_media_buffer_queue_release_buffer(
+		     *queue,
+		     buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push storage media buffer onto queue.",
+			 function );
+
+			( *queue )->number_of_buffers -= 1;
+
+			goto on_error;
+		}
+		buffer = NULL;
+	}
+	return( 1 );
+
+on_error:
+	if( buffer != NULL )
+	{
+		storage_media_buffer_free(
+		 &buffer,
+		 NULL );
+	}
+	if( *queue != NULL )
+	{
+		storage_media_buffer_queue_free(
+		 queue,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a storage media buffer queue
+ * Only the buffers that were released onto the queue are freed
+ * The region is unmapped hence the buffers that were not released must no longer be used
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_queue_free(
+     storage_media_buffer_queue_t **queue,
+     libcerror_error_t **error )
+{
+	storage_media_buffer_queue_shard_t *shard = NULL;
+	static char *function                     = "storage_media_buffer_queue_free";
+	int buffer_index                          = 0;
+	int result                                = 1;
+	int shard_index                           = 0;
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+	uint64_t blocked_time                     = 0;
+	uint64_t number_of_blocked_grabs          = 0;
+	uint64_t number_of_grabs                  = 0;
+	uint64_t number_of_output_stalls          = 0;
+	uint64_t output_stall_time                = 0;
+	int maximum_number_of_pending_buffers     = 0;
+	int number_of_buffers                     = 0;
+#endif
+
+	if( queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( *queue != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( ( libcnotify_verbose != 0 )
+		 && ( ( *queue )->condition != NULL ) )
+		{
+			if( storage_media_buffer_queue_get_statistics(
+			     *queue,
+			     &number_of_buffers,
+			     &number_of_grabs,
+			     &number_of_blocked_grabs,
+			     &blocked_time,
+			     NULL ) == 1 )
+			{
+				libcnotify_printf(
+				 "%s: number of buffers: %d of maximum: %d, grabs: %" PRIu64 ", blocked grabs: %" PRIu64 ", blocked time: %" PRIu64 " ms.\n",
+				 function,
+				 number_of_buffers,
+				 ( *queue )->maximum_number_of_buffers,
+				 number_of_grabs,
+				 number_of_blocked_grabs,
+				 blocked_time / 1000000 );
+			}
+			if( storage_media_buffer_queue_get_output_statistics(
+			     *queue,
+			     &number_of_output_stalls,
+			     &output_stall_time,
+			     &maximum_number_of_pending_buffers,
+			     NULL ) == 1 )
+			{
+				libcnotify_printf(
+				 "%s: output stalls: %" PRIu64 ", output stall time: %" PRIu64 " ms, maximum pending buffers: %d.\n",
+				 function,
+				 number_of_output_stalls,
+				 output_stall_time / 1000000,
+				 maximum_number_of_pending_buffers );
+			}
+		}
+#endif
+		if( ( *queue )->condition != NULL )
+		{
+			if( libcthreads_condition_free(
+			     &( ( *queue )->condition ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free condition.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *queue )->mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *queue )->mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *queue )->shards != NULL )
+		{
+			for( shard_index = 0;
+			     shard_index < ( *queue )->number_of_shards;
+			     shard_index++ )
+			{
+				shard = &( ( *queue )->shards[ shard_index ] );
+
+				if( shard->buffers != NULL )
+				{
+					for( buffer_index = 0;
+					     buffer_index < shard->number_of_buffers;
+					     buffer_index++ )
+					{
+						if( storage_media_buffer_free(
+						     &( shard->buffers[ buffer_index ] ),
+						     error ) != 1 )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+							 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+							 "%s: unable to free storage media buffer.",
+							 function );
+
+							result = -1;
+						}
+					}
+					memory_free(
+					 shard->buffers );
+				}
+				if( shard->mutex != NULL )
+				{
+					if( libcthreads_mutex_free(
+					     &( shard->mutex ),
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to free shard: %d mutex.",
+						 function,
+						 shard_index );
+
+						result = -1;
+					}
+				}
+			}
+			memory_free(
+			 ( *queue )->shards );
+		}
+		storage_media_buffer_queue_free_region(
+		 *queue );
+
+		memory_free(
+		 *queue );
+
+		*queue = NULL;
+	}
+	return( result );
+}
+
+/* Pops a storage media buffer from a free list
+ * If the free list is empty and register grabber is set the grabber is registered
+ * as waiting so that a release onto the free list signals the queue condition
+ * Returns 1 if successful, 0 if the free list is empty or -1 on error
+ */
+int storage_media_buffer_queue_shard_pop(
+     storage_media_buffer_queue_shard_t *shard,
+     storage_media_buffer_t **buffer,
+     uint8_t register_grabber,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_queue_shard_pop";
+	int result            = 0;
+
+	if( shard == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shard.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( shard->number_of_buffers > 0 )
+	{
+		shard->number_of_buffers -= 1;
+
+		*buffer = shard->buffers[ shard->number_of_buffers ];
+
+		shard->buffers[ shard->number_of_buffers ] = NULL;
+
+		shard->number_of_grabs += 1;
+
+		result = 1;
+	}
+	else if( register_grabber != 0 )
+	{
+		shard->number_of_waiting_grabbers += 1;
+	}
+	if( libcthreads_mutex_release(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Unregisters a waiting grabber from a free list
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_queue_shard_unregister_grabber(
+     storage_media_buffer_queue_shard_t *shard,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_queue_shard_unregister_grabber";
+
+	if( shard == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shard.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( shard->number_of_waiting_grabbers > 0 )
+	{
+		shard->number_of_waiting_grabbers -= 1;
+	}
+	if( libcthreads_mutex_release(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Grabs a storage media buffer from the queue
+ * If all free lists are empty a new buffer is created if the maximum number
+ * of buffers was not reached, otherwise the grab blocks until a buffer is released
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_queue_grab_buffer(
+     storage_media_buffer_queue_t *queue,
+     storage_media_buffer_t **buffer,
+     libcerror_error_t **error )
+{
+	static char *function        = "storage_media_buffer_queue_grab_buffer";
+	int64_t wait_end_timestamp   = 0;
+	int64_t wait_start_timestamp = 0;
+	uint8_t is_blocked           = 0;
+	int number_of_registrations  = 0;
+	int result                   = 0;
+	int shard_index              = 0;
+
+	if( queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	while( result == 0 )
+	{
+		for( shard_index = 0;
+		     shard_index < queue->number_of_shards;
+		     shard_index++ )
+		{
+			result = storage_media_buffer_queue_shard_pop(
+			          &( queue->shards[ shard_index ] ),
+			          buffer,
+			          0,
+			          error );
+
+			if( result != 0 )
+			{
+				break;
+			}
+		}
+		if( result != 0 )
+		{
+			break;
+		}
+		/* All free lists were empty, register as waiting grabber on every free list
+		 * while holding the queue mutex so that a buffer released after the registration
+		 * signals the condition only once the grabber is waiting for it
+		 */
+		if( libcthreads_mutex_grab(
+		     queue->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+		for( number_of_registrations = 0;
+		     number_of_registrations < queue->number_of_shards;
+		     number_of_registrations++ )
+		{
+			result = storage_media_buffer_queue_shard_pop(
+			          &( queue->shards[ number_of_registrations ] ),
+			          buffer,
+			          1,
+			          error );
+
+			if( result != 0 )
+			{
+				break;
+			}
+		}
+		if( ( result == 0 )
+		 && ( queue->number_of_buffers < queue->maximum_number_of_buffers ) )
+		{
+			/* Grow the queue instead of waiting for a buffer to be released
+			 */
+			result = storage_media_buffer_queue_create_buffer(
+			          queue,
+			          buffer,
+			          error );
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create storage media buffer.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( result == 0 )
+		{
+			if( is_blocked == 0 )
+			{
+				queue->number_of_blocked_grabs += 1;
+
+				is_blocked = 1;
+			}
+			if( ewftools_timestamp_get_monotonic(
+			     &wait_start_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve wait start timestamp.",
+				 function );
+
+				result = -1;
+			}
+			else if( libcthreads_condition_wait(
+			          queue->condition,
+			          queue->mutex,
+			          error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to wait for condition.",
+				 function );
+
+				result = -1;
+			}
+			else if( ewftools_timestamp_get_monotonic(
+			          &wait_end_timestamp,
+			          error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve wait end timestamp.",
+				 function );
+
+				result = -1;
+			}
+			else if( wait_end_timestamp > wait_start_timestamp )
+			{
+				queue->blocked_time += (uint64_t) ( wait_end_timestamp - wait_start_timestamp );
+			}
+		}
+		/* The free list on which a buffer was popped has no registration
+		 */
+		for( shard_index = 0;
+		     shard_index < number_of_registrations;
+		     shard_index++ )
+		{
+			if( storage_media_buffer_queue_shard_unregister_grabber(
+			     &( queue->shards[ shard_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to unregister grabber from shard: %d.",
+				 function,
+				 shard_index );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_mutex_release(
+		     queue->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to pop storage media buffer from queue.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Adds a reference to a storage media buffer that was grabbed from the queue
+ * The buffer is only released onto the queue when all references are released
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_queue_reference_buffer(
+     storage_media_buffer_queue_t *queue,
+     storage_media_buffer_t *buffer,
+     libcerror_error_t **error )
+{
+	storage_media_buffer_queue_shard_t *shard = NULL;
+	static char *function                     = "storage_media_buffer_queue_reference_buffer";
+
+	if( queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	/* The reference count is protected by the mutex of the free list the buffer is released onto
+	 */
+	shard = &( queue->shards[ ( (size_t) (intptr_t) buffer / sizeof( storage_media_buffer_t ) ) % (size_t) queue->number_of_shards ] );
+
+	if( libcthreads_mutex_grab(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	buffer->number_of_references += 1;
+
+	if( libcthreads_mutex_release(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Releases a storage media buffer onto the queue
+ * If other references to the buffer remain only the reference is released
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_queue_release_buffer(
+     storage_media_buffer_queue_t *queue,
+     storage_media_buffer_t *buffer,
+     libcerror_error_t **error )
+{
+	storage_media_buffer_queue_shard_t *shard = NULL;
+	static char *function                     = "storage_media_buffer_queue_release_buffer";
+	int number_of_waiting_grabbers            = 0;
+	int result                                = 1;
+
+	if( queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	/* Buffers are distributed over the free lists by their address
+	 */
+	shard = &( queue->shards[ ( (size_t) (intptr_t) buffer / sizeof( storage_media_buffer_t ) ) % (size_t) queue->number_of_shards ] );
+
+	if( libcthreads_mutex_grab(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer->number_of_references > 0 )
+	{
+		buffer->number_of_references -= 1;
+	}
+	else if( shard->number_of_buffers >= queue->maximum_number_of_buffers )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid shard - number of buffers value out of bounds.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		shard->buffers[ shard->number_of_buffers ] = buffer;
+
+		shard->number_of_buffers += 1;
+
+		number_of_waiting_grabbers = shard->number_of_waiting_grabbers;
+	}
+	if( libcthreads_mutex_release(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	/* Only take the queue mutex if a grabber is waiting for a buffer
+	 */
+	if( number_of_waiting_grabbers > 0 )
+	{
+		if( libcthreads_mutex_grab(
+		     queue->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+		/* A single buffer was released hence signalling a single waiting grabber suffices
+		 */
+		if( libcthreads_condition_signal(
+		     queue->condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_release(
+		     queue->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Updates the output stall statistics of the queue
+ * The number of pending buffers is the number of buffers that are waiting
+ * in the output on the buffer with the next offset, the output is stalled
+ * while it is not 0
+ * This function is not thread-safe and should only be called by the output thread
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_queue_update_output_stall(
+     storage_media_buffer_queue_t *queue,
+     int number_of_pending_buffers,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_queue_update_output_stall";
+	int64_t timestamp     = 0;
+
+	if( queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_pending_buffers > queue->maximum_number_of_pending_buffers )
+	{
+		queue->maximum_number_of_pending_buffers = number_of_pending_buffers;
+	}
+	if( ( number_of_pending_buffers != 0 )
+	 == ( queue->output_is_stalled != 0 ) )
+	{
+		return( 1 );
+	}
+	if( ewftools_timestamp_get_monotonic(
+	     &timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_pending_buffers != 0 )
+	{
+		queue->output_is_stalled            = 1;
+		queue->output_stall_start_timestamp = timestamp;
+		queue->number_of_output_stalls     += 1;
+	}
+	else
+	{
+		if( timestamp > queue->output_stall_start_timestamp )
+		{
+			queue->output_stall_time += (uint64_t) ( timestamp - queue->output_stall_start_timestamp );
+		}
+		queue->output_is_stalled = 0;
+	}
+	return( 1 );
+}
+
+/* Retrieves the output stall statistics of the queue
+ * The output stall time in nano seconds indicates how long the output had
+ * to wait on a slow buffer while buffers with a higher offset were pending
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_queue_get_output_statistics(
+     storage_media_buffer_queue_t *queue,
+     uint64_t *number_of_output_stalls,
+     uint64_t *output_stall_time,
+     int *maximum_number_of_pending_buffers,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_queue_get_output_statistics";
+
+	if( queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_output_stalls == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of output stalls.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_stall_time == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output stall time.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_pending_buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum number of pending buffers.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_output_stalls           = queue->number_of_output_stalls;
+	*output_stall_time                 = queue->output_stall_time;
+	*maximum_number_of_pending_buffers = queue->maximum_number_of_pending_buffers;
+
+	return( 1 );
+}
+
+/* Retrieves the statistics of the queue
+ * The number of blocked grabs and the blocked time in nano seconds indicate
+ * how often and how long processing had to wait for a buffer to be released
+ * once the maximum number of buffers was reached, which can be used to size the queue
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_queue_get_statistics(
+     storage_media_buffer_queue_t *queue,
+     int *number_of_buffers,
+     uint64_t *number_of_grabs,
+     uint64_t *number_of_blocked_grabs,
+     uint64_t *blocked_time,
+     libcerror_error_t **error )
+{
+	storage_media_buffer_queue_shard_t *shard = NULL;
+	static char *function                     = "storage_media_buffer_queue_get_statistics";
+	uint64_t safe_number_of_grabs             = 0;
+	int shard_index                           = 0;
+
+	if( queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of buffers.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_grabs == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of grabs.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_blocked_grabs == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of blocked grabs.",
+		 function );
+
+		return( -1 );
+	}
+	if( blocked_time == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid blocked time.",
+		 function );
+
+		return( -1 );
+	}
+	for( shard_index = 0;
+	     shard_index < queue->number_of_shards;
+	     shard_index++ )
+	{
+		shard = &( queue->shards[ shard_index ] );
+
+		if( libcthreads_mutex_grab(
+		     shard->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+		safe_number_of_grabs += shard->number_of_grabs;
+
+		if( libcthreads_mutex_release(
+		     shard->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libcthreads_mutex_grab(
+	     queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_blocked_grabs = queue->number_of_blocked_grabs;
+	*blocked_time            = queue->blocked_time;
+	*number_of_buffers       = queue->number_of_buffers;
+
+	if( libcthreads_mutex_release(
+	     queue->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_grabs = safe_number_of_grabs;
+
 	return( 1 );
 }
 
@@ -28,6 +28,7 @@
 #include "ewftools_libcerror.h"
 #include "ewftools_libcthreads.h"
 #include "ewftools_libewf.h"
+#include "numa_topology.h"
 #include "storage_media_buffer.h"
 
 #if defined( __cplusplus )
@@ -36,28 +37,233 @@ extern "C" {
 
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 
+#if defined( HAVE_SYS_MMAN_H ) && defined( HAVE_MMAP ) && defined( HAVE_MUNMAP ) && !defined( WINAPI )
+#define HAVE_STORAGE_MEDIA_BUFFER_QUEUE_REGION_SUPPORT
+#endif
+
+/* The size of a huge page
+ */
+#define STORAGE_MEDIA_BUFFER_QUEUE_HUGE_PAGE_SIZE		( 2 * 1024 * 1024 )
+
+/* The alignment of the raw buffers in the region of a queue
+ */
+#define STORAGE_MEDIA_BUFFER_QUEUE_REGION_ALIGNMENT		512
+
+/* The maximum number of free lists of a storage media buffer queue
+ */
+#define STORAGE_MEDIA_BUFFER_QUEUE_MAXIMUM_NUMBER_OF_SHARDS	8
+
+/* The default memory budget of the storage media buffers of a queue
+ */
+#define STORAGE_MEDIA_BUFFER_QUEUE_DEFAULT_MEMORY_BUDGET	( 512 * 1024 * 1024 )
+
+/* The maximum number of storage media buffers of a queue
+ */
+#define STORAGE_MEDIA_BUFFER_QUEUE_MAXIMUM_NUMBER_OF_BUFFERS	65536
+
+typedef struct storage_media_buffer_queue_shard storage_media_buffer_queue_shard_t;
+
+/* A free list of storage media buffers
+ */
+struct storage_media_buffer_queue_shard
+{
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The free buffers
+	 */
+	storage_media_buffer_t **buffers;
+
+	/* The number of free buffers
+	 */
+	int number_of_buffers;
+
+	/* The number of grabbers waiting for a buffer to be released
+	 */
+	int number_of_waiting_grabbers;
+
+	/* The number of buffers grabbed from the free list
+	 */
+	uint64_t number_of_grabs;
+};
+
+typedef struct storage_media_buffer_queue storage_media_buffer_queue_t;
+
+/* The storage media buffer queue holds the free storage media buffers
+ * The free buffers are divided over multiple free lists, each with their own lock,
+ * so that buffers released by different threads do not contend for a single lock
+ * A buffer is always released onto the same free list, a grabber takes a buffer
+ * from any of the free lists and only blocks when all of them are empty
+ */
+struct storage_media_buffer_queue
+{
+	/* The free lists
+	 */
+	storage_media_buffer_queue_shard_t *shards;
+
+	/* The number of free lists
+	 */
+	int number_of_shards;
+
+	/* The number of buffers
+	 */
+	int number_of_buffers;
+
+	/* The maximum number of buffers the queue can grow to
+	 */
+	int maximum_number_of_buffers;
+
+	/* The handle used to create the buffers
+	 */
+	libewf_handle_t *handle;
+
+	/* The NUMA topology used to place the buffers
+	 */
+	numa_topology_t *numa_topology;
+
+	/* The mode of the buffers
+	 */
+	uint8_t storage_media_buffer_mode;
+
+	/* The size of the buffers
+	 */
+	size_t storage_media_buffer_size;
+
+	/* Value to indicate the raw buffers should be backed by huge pages
+	 */
+	uint8_t use_huge_pages;
+
+	/* The region the raw buffers are carved from
+	 * The region is mapped once for the maximum number of buffers
+	 */
+	uint8_t *region;
+
+	/* The size of the region
+	 */
+	size_t region_size;
+
+	/* The size of a raw buffer in the region including alignment padding
+	 */
+	size_t region_buffer_size;
+
+	/* The mutex used to wait for a buffer to be released
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when a buffer is released onto
+	 * a free list with waiting grabbers
+	 */
+	libcthreads_condition_t *condition;
+
+	/* The number of grabs that had to wait for a buffer to be released
+	 */
+	uint64_t number_of_blocked_grabs;
+
+	/* The time in nano seconds grabs had to wait for a buffer to be released
+	 */
+	uint64_t blocked_time;
+
+	/* Value to indicate the output is waiting on the buffer with the next offset
+	 */
+	uint8_t output_is_stalled;
+
+	/* The timestamp of the start of the current output stall
+	 */
+	int64_t output_stall_start_timestamp;
+
+	/* The number of times the output had to wait on the buffer with the next offset
+	 */
+	uint64_t number_of_output_stalls;
+
+	/* The time in nano seconds the output had to wait on the buffer with the next offset
+	 */
+	uint64_t output_stall_time;
+
+	/* The maximum number of buffers that were pending in the output
+	 */
+	int maximum_number_of_pending_buffers;
+};
+
+int storage_media_buffer_queue_get_maximum_number_of_buffers(
+     size64_t memory_budget,
+     size_t storage_media_buffer_size,
+     int minimum_number_of_buffers,
+     int *maximum_number_of_buffers,
+     libcerror_error_t **error );
+
+int storage_media_buffer_queue_allocate_region(
+     storage_media_buffer_queue_t *queue,
+     libcerror_error_t **error );
+
+void storage_media_buffer_queue_free_region(
+      storage_media_buffer_queue_t *queue );
+
+int storage_media_buffer_queue_create_buffer(
+     storage_media_buffer_queue_t *queue,
+     storage_media_buffer_t **buffer,
+     libcerror_error_t **error );
+
 int storage_media_buffer_queue_initialize(
-     libcthreads_queue_t **queue,
+     storage_media_buffer_queue_t **queue,
      libewf_handle_t *handle,
+     numa_topology_t *numa_topology,
+     int initial_number_of_values,
      int maximum_number_of_values,
      uint8_t storage_media_buffer_mode,
      size_t storage_media_buffer_size,
+     uint8_t use_huge_pages,
      libcerror_error_t **error );
 
 int storage_media_buffer_queue_free(
-     libcthreads_queue_t **queue,
+     storage_media_buffer_queue_t **queue,
+     libcerror_error_t **error );
+
+int storage_media_buffer_queue_shard_pop(
+     storage_media_buffer_queue_shard_t *shard,
+     storage_media_buffer_t **buffer,
+     uint8_t register_grabber,
+     libcerror_error_t **error );
+
+int storage_media_buffer_queue_shard_unregister_grabber(
+     storage_media_buffer_queue_shard_t *shard,
      libcerror_error_t **error );
 
 int storage_media_buffer_queue_grab_buffer(
-     libcthreads_queue_t *queue,
+     storage_media_buffer_queue_t *queue,
      storage_media_buffer_t **buffer,
      libcerror_error_t **error );
 
+int storage_media_buffer_queue_reference_buffer(
+     storage_media_buffer_queue_t *queue,
+     storage_media_buffer_t *buffer,
+     libcerror_error_t **error );
+
 int storage_media_buffer_queue_release_buffer(
-     libcthreads_queue_t *queue,
+     storage_media_buffer_queue_t *queue,
      storage_media_buffer_t *buffer,
      libcerror_error_t **error );
 
+int storage_media_buffer_queue_update_output_stall(
+     storage_media_buffer_queue_t *queue,
+     int number_of_pending_buffers,
+     libcerror_error_t **error );
+
+int storage_media_buffer_queue_get_output_statistics(
+     storage_media_buffer_queue_t *queue,
+     uint64_t *number_of_output_stalls,
+     uint64_t *output_stall_time,
+     int *maximum_number_of_pending_buffers,
+     libcerror_error_t **error );
+
+int storage_media_buffer_queue_get_statistics(
+     storage_media_buffer_queue_t *queue,
+     int *number_of_buffers,
+     uint64_t *number_of_grabs,
+     uint64_t *number_of_blocked_grabs,
+     uint64_t *blocked_time,
+     libcerror_error_t **error );
+
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 #if defined( __cplusplus )
@@ -0,0 +1,1329 @@
+/*
+ * Stream reader functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* The pipe size fcntl commands require _GNU_SOURCE
+ */
+#if defined( __linux__ ) && !defined( _GNU_SOURCE )
+#define _GNU_SOURCE
+#endif
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H ) || defined( WINAPI )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H ) || defined( WINAPI )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_IO_H ) || defined( WINAPI )
+#include <io.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "storage_media_buffer.h"
+#include "storage_media_buffer_queue.h"
+#include "stream_reader.h"
+
+/* Creates a stream reader
+ * Make sure the value stream_reader is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int stream_reader_initialize(
+     stream_reader_t **stream_reader,
+     int input_file_descriptor,
+     size32_t chunk_size,
+     uint8_t read_error_retries,
+     libcerror_error_t **error )
+{
+	static char *function = "stream_reader_initialize";
+
+	if( stream_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( *stream_reader != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid stream reader value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid chunk size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	*stream_reader = memory_allocate_structure(
+	                  stream_reader_t );
+
+	if( *stream_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create stream reader.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *stream_reader,
+	     0,
+	     sizeof( stream_reader_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear stream reader.",
+		 function );
+
+		goto on_error;
+	}
+	( *stream_reader )->input_file_descriptor = input_file_descriptor;
+	( *stream_reader )->chunk_size            = chunk_size;
+	( *stream_reader )->read_error_retries    = read_error_retries;
+
+	if( stream_reader_set_pipe_size(
+	     *stream_reader,
+	     STREAM_READER_PIPE_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set pipe size.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *stream_reader != NULL )
+	{
+		memory_free(
+		 *stream_reader );
+
+		*stream_reader = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a stream reader
+ * The reader thread is stopped if necessary
+ * Returns 1 if successful or -1 on error
+ */
+int stream_reader_free(
+     stream_reader_t **stream_reader,
+     libcerror_error_t **error )
+{
+	static char *function = "stream_reader_free";
+	int result            = 1;
+
+	if( stream_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( *stream_reader != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *stream_reader )->buffers != NULL )
+		{
+			if( stream_reader_stop(
+			     *stream_reader,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to stop stream reader.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		memory_free(
+		 *stream_reader );
+
+		*stream_reader = NULL;
+	}
+	return( result );
+}
+
+/* Signals the stream reader to abort
+ * Returns 1 if successful or -1 on error
+ */
+int stream_reader_signal_abort(
+     stream_reader_t *stream_reader,
+     libcerror_error_t **error )
+{
+	static char *function = "stream_reader_signal_abort";
+
+	if( stream_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream reader.",
+		 function );
+
+		return( -1 );
+	}
+	stream_reader->abort = 1;
+
+	return( 1 );
+}
+
+/* Enlarges the kernel buffer of the input if it is a pipe
+ * A larger pipe buffer allows the writer to run ahead of the reader and
+ * allows a single read to return more data, which reduces the number of
+ * read calls and context switches at high data rates
+ * The pipe size is left unchanged if the input is not a pipe or if the
+ * pipe size cannot be enlarged, for example due to the pipe size limit
+ * Returns 1 if successful or -1 on error
+ */
+int stream_reader_set_pipe_size(
+     stream_reader_t *stream_reader,
+     size_t pipe_size,
+     libcerror_error_t **error )
+{
+	static char *function = "stream_reader_set_pipe_size";
+
+#if defined( F_GETPIPE_SZ ) && defined( F_SETPIPE_SZ )
+	int current_pipe_size = 0;
+	int result            = 0;
+#endif
+
+	if( stream_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( pipe_size > (size_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid pipe size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( F_GETPIPE_SZ ) && defined( F_SETPIPE_SZ )
+	/* F_GETPIPE_SZ fails if the input is not a pipe
+	 */
+	current_pipe_size = fcntl(
+	                     stream_reader->input_file_descriptor,
+	                     F_GETPIPE_SZ );
+
+	if( current_pipe_size <= 0 )
+	{
+		return( 1 );
+	}
+	/* An unprivileged process cannot exceed the pipe size limit
+	 * hence the requested size is halved until it is accepted
+	 */
+	while( pipe_size > (size_t) current_pipe_size )
+	{
+		result = fcntl(
+		          stream_reader->input_file_descriptor,
+		          F_SETPIPE_SZ,
+		          (int) pipe_size );
+
+		if( result > 0 )
+		{
+			current_pipe_size = result;
+
+			break;
+		}
+		pipe_size /= 2;
+	}
+	stream_reader->pipe_size = (size_t) current_pipe_size;
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: pipe size: %" PRIzd "\n",
+		 function,
+		 stream_reader->pipe_size );
+	}
+#endif
+#endif /* defined( F_GETPIPE_SZ ) && defined( F_SETPIPE_SZ ) */
+
+	return( 1 );
+}
+
+/* Sets the range of the stream that is read
+ * The data before the skip size is read but not part of the acquiry,
+ * an acquiry size of 0 reads until the end of the stream
+ * Returns 1 if successful or -1 on error
+ */
+int stream_reader_set_range(
+     stream_reader_t *stream_reader,
+     size64_t skip_size,
+     size64_t acquiry_size,
+     libcerror_error_t **error )
+{
+	static char *function = "stream_reader_set_range";
+
+	if( stream_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream_reader->storage_media_offset != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid stream reader - data already read.",
+		 function );
+
+		return( -1 );
+	}
+	stream_reader->skip_size              = skip_size;
+	stream_reader->acquiry_size           = acquiry_size;
+	stream_reader->remaining_acquiry_size = acquiry_size;
+
+	return( 1 );
+}
+
+/* Reads data from the input file descriptor into the storage media buffer
+ * The data is read in chunk size parts, where every part is read with error retries
+ * Returns the number of bytes read, 0 if at end of input or -1 on error
+ */
+ssize_t stream_reader_read_chunk(
+         stream_reader_t *stream_reader,
+         storage_media_buffer_t *storage_media_buffer,
+         size_t buffer_read_size,
+         libcerror_error_t **error )
+{
+	static char *function         = "stream_reader_read_chunk";
+	size_t buffer_offset          = 0;
+	size_t chunk_read_size        = 0;
+	size_t input_read_size        = 0;
+	size_t remaining_read_size    = 0;
+	ssize_t chunk_read_count      = 0;
+	ssize_t input_read_count      = 0;
+	int32_t read_number_of_errors = 0;
+
+	if( stream_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_read_size > (size_t) SSIZE_MAX )
+	 || ( buffer_read_size > storage_media_buffer->raw_buffer_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer read size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	remaining_read_size = buffer_read_size;
+
+	while( remaining_read_size > 0 )
+	{
+		/* Determine the number of bytes to read from the input
+		 * Read as much as possible in chunk sizes
+		 */
+		if( remaining_read_size < (size_t) stream_reader->chunk_size )
+		{
+			chunk_read_size = remaining_read_size;
+		}
+		else
+		{
+			chunk_read_size = stream_reader->chunk_size;
+		}
+		input_read_size = chunk_read_size;
+
+		chunk_read_count      = 0;
+		read_number_of_errors = 0;
+
+		while( input_read_size > 0 )
+		{
+			if( stream_reader->abort != 0 )
+			{
+				break;
+			}
+#if defined( HAVE_VERBOSE_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: reading buffer at offset: 0x%08" PRIx64 " of size: %" PRIzd ".\n",
+				 function,
+				 stream_reader->storage_media_offset + (off64_t) buffer_offset,
+				 input_read_size );
+			}
+#endif
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+			input_read_count = _read(
+			                    stream_reader->input_file_descriptor,
+			                    &( ( storage_media_buffer->raw_buffer )[ buffer_offset ] ),
+			                    (unsigned int) input_read_size );
+#else
+			input_read_count = read(
+			                    stream_reader->input_file_descriptor,
+			                    &( ( storage_media_buffer->raw_buffer )[ buffer_offset ] ),
+			                    input_read_size );
+#endif
+			if( input_read_count < 0 )
+			{
+				if( ( errno == ESPIPE )
+				 || ( errno == EPERM )
+				 || ( errno == ENXIO )
+				 || ( errno == ENODEV ) )
+				{
+					if( errno == ESPIPE )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_READ_FAILED,
+						 "%s: error reading data: invalid seek.",
+						 function );
+					}
+					else if( errno == EPERM )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_READ_FAILED,
+						 "%s: error reading data: operation not permitted.",
+						 function );
+					}
+					else if( errno == ENXIO )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_READ_FAILED,
+						 "%s: error reading data: no such device or address.",
+						 function );
+					}
+					else
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_READ_FAILED,
+						 "%s: error reading data: no such device.",
+						 function );
+					}
+					return( -1 );
+				}
+				read_number_of_errors++;
+
+				if( read_number_of_errors > stream_reader->read_error_retries )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: error reading data.",
+					 function );
+
+					return( -1 );
+				}
+			}
+			/* No bytes were read
+			 */
+			else if( input_read_count == 0 )
+			{
+				break;
+			}
+			/* A pipe or socket returns the data that is available, hence
+			 * a partial read is continued and not considered a read error
+			 */
+			else
+			{
+				chunk_read_count += input_read_count;
+				buffer_offset    += input_read_count;
+				input_read_size  -= input_read_count;
+			}
+		}
+		if( chunk_read_count == 0 )
+		{
+			break;
+		}
+		remaining_read_size -= chunk_read_count;
+	}
+	storage_media_buffer->storage_media_offset = stream_reader->storage_media_offset;
+	storage_media_buffer->requested_size       = buffer_read_size;
+	storage_media_buffer->raw_buffer_data_size = buffer_offset;
+
+	stream_reader->storage_media_offset += (off64_t) buffer_offset;
+
+	return( (ssize_t) buffer_offset );
+}
+
+/* Reads the next part of the stream into the storage media buffer
+ * The part is aligned with the end of the skip size and limited by the acquiry size
+ * Returns the number of bytes read, 0 if at end of input or -1 on error
+ */
+ssize_t stream_reader_read_buffer(
+         stream_reader_t *stream_reader,
+         storage_media_buffer_t *storage_media_buffer,
+         libcerror_error_t **error )
+{
+	static char *function = "stream_reader_read_buffer";
+	size64_t skip_size    = 0;
+	size_t read_size      = 0;
+	ssize_t read_count    = 0;
+
+	if( stream_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( stream_reader->skip_size <= (size64_t) stream_reader->storage_media_offset )
+	 && ( stream_reader->acquiry_size != 0 )
+	 && ( stream_reader->remaining_acquiry_size == 0 ) )
+	{
+		return( 0 );
+	}
+	read_size = storage_media_buffer->raw_buffer_size;
+
+	if( stream_reader->skip_size > (size64_t) stream_reader->storage_media_offset )
+	{
+		skip_size = stream_reader->skip_size - (size64_t) stream_reader->storage_media_offset;
+
+		if( skip_size < (size64_t) read_size )
+		{
+			read_size = (size_t) skip_size;
+		}
+	}
+	else if( ( stream_reader->acquiry_size != 0 )
+	      && ( stream_reader->remaining_acquiry_size < (size64_t) read_size ) )
+	{
+		read_size = (size_t) stream_reader->remaining_acquiry_size;
+	}
+	read_count = stream_reader_read_chunk(
+	              stream_reader,
+	              storage_media_buffer,
+	              read_size,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( skip_size == 0 )
+	 && ( stream_reader->acquiry_size != 0 ) )
+	{
+		stream_reader->remaining_acquiry_size -= (size64_t) read_count;
+	}
+	return( read_count );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Starts the reader thread
+ * The reader thread grabs storage media buffers from the queue and fills the ring
+ * of buffers, which holds up to number of buffers storage media buffers
+ * Returns 1 if successful or -1 on error
+ */
+int stream_reader_start(
+     stream_reader_t *stream_reader,
+     storage_media_buffer_queue_t *storage_media_buffer_queue,
+     int number_of_buffers,
+     libcerror_error_t **error )
+{
+	static char *function = "stream_reader_start";
+	size_t buffers_size   = 0;
+
+	if( stream_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream_reader->buffers != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid stream reader - buffers value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_buffers <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of buffers value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	buffers_size = sizeof( storage_media_buffer_t * ) * number_of_buffers;
+
+	stream_reader->buffers = (storage_media_buffer_t **) memory_allocate(
+	                                                      buffers_size );
+
+	if( stream_reader->buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffers.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     stream_reader->buffers,
+	     0,
+	     buffers_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buffers.",
+		 function );
+
+		goto on_error;
+	}
+	stream_reader->storage_media_buffer_queue = storage_media_buffer_queue;
+	stream_reader->number_of_buffers          = number_of_buffers;
+	stream_reader->first_buffer_index         = 0;
+	stream_reader->number_of_filled_buffers   = 0;
+	stream_reader->end_of_input               = 0;
+	stream_reader->result                     = 1;
+
+	if( libcthreads_mutex_initialize(
+	     &( stream_reader->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( stream_reader->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_thread_create(
+	     &( stream_reader->thread ),
+	     NULL,
+	     (int (*)(void *)) &stream_reader_thread_function,
+	     (void *) stream_reader,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create reader thread.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( stream_reader->buffers != NULL )
+	{
+		stream_reader_stop(
+		 stream_reader,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the stream into the ring of buffers until the end of the input
+ * Callback function for the reader thread
+ * Returns 1 if successful or -1 on error
+ */
+int stream_reader_thread_function(
+     stream_reader_t *stream_reader )
+{
+	libcerror_error_t *error                     = NULL;
+	storage_media_buffer_t *storage_media_buffer = NULL;
+	static char *function                        = "stream_reader_thread_function";
+	ssize_t read_count                           = 0;
+	int buffer_index                             = 0;
+	int result                                   = 1;
+
+	if( stream_reader == NULL )
+	{
+		return( -1 );
+	}
+	while( result == 1 )
+	{
+		/* Wait for a free slot in the ring before grabbing a buffer
+		 * so that the ring holds at most number of buffers storage media buffers
+		 */
+		if( libcthreads_mutex_grab(
+		     stream_reader->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( stream_reader->number_of_filled_buffers >= stream_reader->number_of_buffers )
+		 && ( stream_reader->abort == 0 ) )
+		{
+			stream_reader->number_of_full_waits += 1;
+		}
+		while( ( stream_reader->number_of_filled_buffers >= stream_reader->number_of_buffers )
+		    && ( stream_reader->abort == 0 ) )
+		{
+			if( libcthreads_condition_wait(
+			     stream_reader->condition,
+			     stream_reader->mutex,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to wait for condition.",
+				 function );
+
+				libcthreads_mutex_release(
+				 stream_reader->mutex,
+				 NULL );
+
+				goto on_error;
+			}
+		}
+		if( libcthreads_mutex_release(
+		     stream_reader->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			goto on_error;
+		}
+		if( stream_reader->abort != 0 )
+		{
+			break;
+		}
+		if( storage_media_buffer_queue_grab_buffer(
+		     stream_reader->storage_media_buffer_queue,
+		     &storage_media_buffer,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to grab storage media buffer from queue.",
+			 function );
+
+			goto on_error;
+		}
+		read_count = stream_reader_read_buffer(
+		              stream_reader,
+		              storage_media_buffer,
+		              &error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer.",
+			 function );
+
+			goto on_error;
+		}
+		if( read_count == 0 )
+		{
+			break;
+		}
+		if( libcthreads_mutex_grab(
+		     stream_reader->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			goto on_error;
+		}
+		buffer_index = ( stream_reader->first_buffer_index + stream_reader->number_of_filled_buffers )
+		             % stream_reader->number_of_buffers;
+
+		stream_reader->buffers[ buffer_index ] = storage_media_buffer;
+		storage_media_buffer                   = NULL;
+
+		stream_reader->number_of_filled_buffers += 1;
+
+		if( libcthreads_condition_broadcast(
+		     stream_reader->condition,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_release(
+		     stream_reader->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			result = -1;
+		}
+		if( result != 1 )
+		{
+			goto on_error;
+		}
+	}
+	if( storage_media_buffer != NULL )
+	{
+		if( storage_media_buffer_queue_release_buffer(
+		     stream_reader->storage_media_buffer_queue,
+		     storage_media_buffer,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release storage media buffer onto queue.",
+			 function );
+
+			goto on_error;
+		}
+		storage_media_buffer = NULL;
+	}
+	result = 1;
+
+on_error:
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+
+		result = -1;
+	}
+	if( storage_media_buffer != NULL )
+	{
+		storage_media_buffer_queue_release_buffer(
+		 stream_reader->storage_media_buffer_queue,
+		 storage_media_buffer,
+		 NULL );
+	}
+	/* The consumer is signalled even if the mutex cannot be grabbed
+	 * since it also checks the end of input on a spurious wake up
+	 */
+	libcthreads_mutex_grab(
+	 stream_reader->mutex,
+	 NULL );
+
+	stream_reader->result       = result;
+	stream_reader->end_of_input = 1;
+
+	libcthreads_condition_broadcast(
+	 stream_reader->condition,
+	 NULL );
+	libcthreads_mutex_release(
+	 stream_reader->mutex,
+	 NULL );
+
+	return( result );
+}
+
+/* Retrieves the next storage media buffer that was read
+ * The caller takes over the storage media buffer
+ * Returns the number of bytes read, 0 if at end of input or -1 on error
+ */
+ssize_t stream_reader_get_buffer(
+         stream_reader_t *stream_reader,
+         storage_media_buffer_t **storage_media_buffer,
+         libcerror_error_t **error )
+{
+	static char *function = "stream_reader_get_buffer";
+	ssize_t read_count    = 0;
+
+	if( stream_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream_reader->buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid stream reader - missing buffers.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     stream_reader->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( stream_reader->number_of_filled_buffers == 0 )
+	 && ( stream_reader->end_of_input == 0 ) )
+	{
+		stream_reader->number_of_empty_waits += 1;
+	}
+	while( ( stream_reader->number_of_filled_buffers == 0 )
+	    && ( stream_reader->end_of_input == 0 ) )
+	{
+		if( libcthreads_condition_wait(
+		     stream_reader->condition,
+		     stream_reader->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			read_count = -1;
+
+			break;
+		}
+	}
+	if( read_count != -1 )
+	{
+		if( stream_reader->number_of_filled_buffers > 0 )
+		{
+			*storage_media_buffer = stream_reader->buffers[ stream_reader->first_buffer_index ];
+
+			stream_reader->buffers[ stream_reader->first_buffer_index ] = NULL;
+
+			stream_reader->first_buffer_index = ( stream_reader->first_buffer_index + 1 )
+			                                  % stream_reader->number_of_buffers;
+
+			stream_reader->number_of_filled_buffers -= 1;
+
+			read_count = (ssize_t) ( *storage_media_buffer )->raw_buffer_data_size;
+
+			if( libcthreads_condition_broadcast(
+			     stream_reader->condition,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to broadcast condition.",
+				 function );
+
+				read_count = -1;
+			}
+		}
+		else if( stream_reader->result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: reader thread failed.",
+			 function );
+
+			read_count = -1;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     stream_reader->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+/* Stops the reader thread
+ * The storage media buffers in the ring are released onto the storage media buffer queue
+ * Returns 1 if successful or -1 on error
+ */
+int stream_reader_stop(
+     stream_reader_t *stream_reader,
+     libcerror_error_t **error )
+{
+	static char *function = "stream_reader_stop";
+	int buffer_index      = 0;
+	int result            = 1;
+
+	if( stream_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream_reader->thread != NULL )
+	{
+		/* The reader thread does not fill the ring any further once abort is set
+		 */
+		if( libcthreads_mutex_grab(
+		     stream_reader->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+		stream_reader->abort = 1;
+
+		if( libcthreads_condition_broadcast(
+		     stream_reader->condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_release(
+		     stream_reader->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			return( -1 );
+		}
+		if( libcthreads_thread_join(
+		     &( stream_reader->thread ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join reader thread.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_VERBOSE_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: number of buffers: %d, number of empty waits: %" PRIu64 ", number of full waits: %" PRIu64 "\n",
+		 function,
+		 stream_reader->number_of_buffers,
+		 stream_reader->number_of_empty_waits,
+		 stream_reader->number_of_full_waits );
+	}
+#endif
+	if( stream_reader->buffers != NULL )
+	{
+		for( buffer_index = 0;
+		     buffer_index < stream_reader->number_of_buffers;
+		     buffer_index++ )
+		{
+			if( stream_reader->buffers[ buffer_index ] != NULL )
+			{
+				if( storage_media_buffer_queue_release_buffer(
+				     stream_reader->storage_media_buffer_queue,
+				     stream_reader->buffers[ buffer_index ],
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to release storage media buffer: %d onto queue.",
+					 function,
+					 buffer_index );
+
+					result = -1;
+				}
+				stream_reader->buffers[ buffer_index ] = NULL;
+			}
+		}
+		memory_free(
+		 stream_reader->buffers );
+
+		stream_reader->buffers = NULL;
+	}
+	stream_reader->number_of_filled_buffers = 0;
+
+	if( stream_reader->condition != NULL )
+	{
+		if( libcthreads_condition_free(
+		     &( stream_reader->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( stream_reader->mutex != NULL )
+	{
+		if( libcthreads_mutex_free(
+		     &( stream_reader->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,202 @@
+/*
+ * Stream reader functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _STREAM_READER_H )
+#define _STREAM_READER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "storage_media_buffer.h"
+#include "storage_media_buffer_queue.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The pipe size requested for an input that is a pipe
+ */
+#define STREAM_READER_PIPE_SIZE		( 1024 * 1024 )
+
+typedef struct stream_reader stream_reader_t;
+
+/* The stream reader reads a stream, such as stdin, sequentially into storage media buffers
+ *
+ * In multi-threaded mode the stream is read by a dedicated thread into a ring
+ * of storage media buffers, such that a stall of the stream, for example due to
+ * network jitter, is absorbed by the ring instead of stalling the processing
+ */
+struct stream_reader
+{
+	/* The input file descriptor
+	 */
+	int input_file_descriptor;
+
+	/* The chunk size
+	 */
+	size32_t chunk_size;
+
+	/* The number of read error retries
+	 */
+	uint8_t read_error_retries;
+
+	/* The size of the kernel buffer of the input, where 0 represents not a pipe
+	 */
+	size_t pipe_size;
+
+	/* The offset of the next read
+	 */
+	off64_t storage_media_offset;
+
+	/* The number of bytes to read before the acquiry offset
+	 */
+	size64_t skip_size;
+
+	/* The acquiry size, where 0 represents until the end of the stream
+	 */
+	size64_t acquiry_size;
+
+	/* The remaining acquiry size
+	 */
+	size64_t remaining_acquiry_size;
+
+	/* Value to indicate the reader should abort
+	 */
+	uint8_t abort;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The storage media buffer queue
+	 */
+	storage_media_buffer_queue_t *storage_media_buffer_queue;
+
+	/* The ring of storage media buffers that were read
+	 */
+	storage_media_buffer_t **buffers;
+
+	/* The number of buffers in the ring
+	 */
+	int number_of_buffers;
+
+	/* The index of the first filled buffer
+	 */
+	int first_buffer_index;
+
+	/* The number of filled buffers
+	 */
+	int number_of_filled_buffers;
+
+	/* The number of times the ring was empty when a buffer was requested
+	 */
+	uint64_t number_of_empty_waits;
+
+	/* The number of times the ring was full when a buffer was read
+	 */
+	uint64_t number_of_full_waits;
+
+	/* Value to indicate the end of the input was reached
+	 */
+	uint8_t end_of_input;
+
+	/* The result of the reader thread
+	 */
+	int result;
+
+	/* The reader thread
+	 */
+	libcthreads_thread_t *thread;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when a buffer was filled or consumed
+	 */
+	libcthreads_condition_t *condition;
+#endif
+};
+
+int stream_reader_initialize(
+     stream_reader_t **stream_reader,
+     int input_file_descriptor,
+     size32_t chunk_size,
+     uint8_t read_error_retries,
+     libcerror_error_t **error );
+
+int stream_reader_free(
+     stream_reader_t **stream_reader,
+     libcerror_error_t **error );
+
+int stream_reader_signal_abort(
+     stream_reader_t *stream_reader,
+     libcerror_error_t **error );
+
+int stream_reader_set_pipe_size(
+     stream_reader_t *stream_reader,
+     size_t pipe_size,
+     libcerror_error_t **error );
+
+int stream_reader_set_range(
+     stream_reader_t *stream_reader,
+     size64_t skip_size,
+     size64_t acquiry_size,
+     libcerror_error_t **error );
+
+ssize_t stream_reader_read_chunk(
+         stream_reader_t *stream_reader,
+         storage_media_buffer_t *storage_media_buffer,
+         size_t buffer_read_size,
+         libcerror_error_t **error );
+
+ssize_t stream_reader_read_buffer(
+         stream_reader_t *stream_reader,
+         storage_media_buffer_t *storage_media_buffer,
+         libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int stream_reader_start(
+     stream_reader_t *stream_reader,
+     storage_media_buffer_queue_t *storage_media_buffer_queue,
+     int number_of_buffers,
+     libcerror_error_t **error );
+
+int stream_reader_thread_function(
+     stream_reader_t *stream_reader );
+
+ssize_t stream_reader_get_buffer(
+         stream_reader_t *stream_reader,
+         storage_media_buffer_t **storage_media_buffer,
+         libcerror_error_t **error );
+
+int stream_reader_stop(
+     stream_reader_t *stream_reader,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _STREAM_READER_H ) */
+
@@ -0,0 +1,788 @@
+/*
+ * Stream writer functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* The pipe size fcntl commands and vmsplice require _GNU_SOURCE
+ */
+#if defined( __linux__ ) && !defined( _GNU_SOURCE )
+#define _GNU_SOURCE
+#endif
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H ) || defined( WINAPI )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H ) || defined( WINAPI )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_IO_H ) || defined( WINAPI )
+#include <io.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( __linux__ )
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/uio.h>
+#endif
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "storage_media_buffer.h"
+#include "storage_media_buffer_queue.h"
+#include "stream_writer.h"
+
+/* Splicing requires that the number of bytes in the pipe can be determined
+ * to know when the reader has consumed the data of a spliced buffer
+ */
+#if defined( __linux__ ) && defined( SPLICE_F_GIFT ) && defined( FIONREAD ) && defined( HAVE_MULTI_THREAD_SUPPORT )
+#define HAVE_STREAM_WRITER_VMSPLICE
+#endif
+
+/* Creates a stream writer
+ * Make sure the value stream_writer is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int stream_writer_initialize(
+     stream_writer_t **stream_writer,
+     int output_file_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "stream_writer_initialize";
+
+	if( stream_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *stream_writer != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid stream writer value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	*stream_writer = memory_allocate_structure(
+	                  stream_writer_t );
+
+	if( *stream_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create stream writer.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *stream_writer,
+	     0,
+	     sizeof( stream_writer_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear stream writer.",
+		 function );
+
+		goto on_error;
+	}
+	( *stream_writer )->output_file_descriptor = output_file_descriptor;
+
+	if( stream_writer_set_pipe_size(
+	     *stream_writer,
+	     STREAM_WRITER_PIPE_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set pipe size.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *stream_writer != NULL )
+	{
+		memory_free(
+		 *stream_writer );
+
+		*stream_writer = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a stream writer
+ * The spliced buffers must have been released before
+ * Returns 1 if successful or -1 on error
+ */
+int stream_writer_free(
+     stream_writer_t **stream_writer,
+     libcerror_error_t **error )
+{
+	static char *function = "stream_writer_free";
+	int result            = 1;
+
+	if( stream_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *stream_writer != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *stream_writer )->number_of_spliced_buffers != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid stream writer - spliced buffers were not released.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *stream_writer );
+
+		*stream_writer = NULL;
+	}
+	return( result );
+}
+
+/* Enlarges the kernel buffer of the output if it is a pipe
+ * A larger pipe buffer allows the writer to run ahead of the reader, which
+ * absorbs stalls of the reader, such as a remote host over ssh, and reduces
+ * the number of context switches at high data rates
+ * The pipe size is left unchanged if the output is not a pipe or if the
+ * pipe size cannot be enlarged, for example due to the pipe size limit
+ * Returns 1 if successful or -1 on error
+ */
+int stream_writer_set_pipe_size(
+     stream_writer_t *stream_writer,
+     size_t pipe_size,
+     libcerror_error_t **error )
+{
+	static char *function = "stream_writer_set_pipe_size";
+
+#if defined( F_GETPIPE_SZ ) && defined( F_SETPIPE_SZ )
+	int current_pipe_size = 0;
+	int result            = 0;
+#endif
+
+	if( stream_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( pipe_size > (size_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid pipe size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( F_GETPIPE_SZ ) && defined( F_SETPIPE_SZ )
+	/* F_GETPIPE_SZ fails if the output is not a pipe
+	 */
+	current_pipe_size = fcntl(
+	                     stream_writer->output_file_descriptor,
+	                     F_GETPIPE_SZ );
+
+	if( current_pipe_size <= 0 )
+	{
+		return( 1 );
+	}
+	/* An unprivileged process cannot exceed the pipe size limit
+	 * hence the requested size is halved until it is accepted
+	 */
+	while( pipe_size > (size_t) current_pipe_size )
+	{
+		result = fcntl(
+		          stream_writer->output_file_descriptor,
+		          F_SETPIPE_SZ,
+		          (int) pipe_size );
+
+		if( result > 0 )
+		{
+			current_pipe_size = result;
+
+			break;
+		}
+		pipe_size /= 2;
+	}
+	stream_writer->pipe_size = (size_t) current_pipe_size;
+
+#if defined( HAVE_STREAM_WRITER_VMSPLICE )
+	stream_writer->use_vmsplice = 1;
+#endif
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: pipe size: %" PRIzd "\n",
+		 function,
+		 stream_writer->pipe_size );
+	}
+#endif
+#endif /* defined( F_GETPIPE_SZ ) && defined( F_SETPIPE_SZ ) */
+
+	return( 1 );
+}
+
+/* Writes a buffer to the stream
+ * A write to a pipe can be partial hence the buffer is written until it was written entirely
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t stream_writer_write_buffer(
+         stream_writer_t *stream_writer,
+         const uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	static char *function = "stream_writer_write_buffer";
+	size_t buffer_offset  = 0;
+	ssize_t write_count   = 0;
+
+	if( stream_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < buffer_size )
+	{
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+		write_count = _write(
+		               stream_writer->output_file_descriptor,
+		               &( buffer[ buffer_offset ] ),
+		               (unsigned int) ( buffer_size - buffer_offset ) );
+#else
+		write_count = write(
+		               stream_writer->output_file_descriptor,
+		               &( buffer[ buffer_offset ] ),
+		               buffer_size - buffer_offset );
+#endif
+		if( write_count < 0 )
+		{
+#if defined( EINTR )
+			if( errno == EINTR )
+			{
+				continue;
+			}
+#endif
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write buffer at offset: %" PRIu64 ".",
+			 function,
+			 stream_writer->write_offset );
+
+			return( -1 );
+		}
+		else if( write_count == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write buffer at offset: %" PRIu64 " - no data written.",
+			 function,
+			 stream_writer->write_offset );
+
+			return( -1 );
+		}
+		buffer_offset               += (size_t) write_count;
+		stream_writer->write_offset += (uint64_t) write_count;
+	}
+	return( (ssize_t) buffer_size );
+}
+
+#if defined( HAVE_STREAM_WRITER_VMSPLICE )
+
+/* Releases the spliced buffers of which the reader consumed the data
+ * Returns 1 if successful or -1 on error
+ */
+static int stream_writer_release_consumed_buffers(
+            stream_writer_t *stream_writer,
+            libcerror_error_t **error )
+{
+	storage_media_buffer_t *storage_media_buffer = NULL;
+	static char *function                        = "stream_writer_release_consumed_buffers";
+	uint64_t consumed_offset                     = 0;
+	int number_of_pending_bytes                  = 0;
+
+	if( stream_writer->number_of_spliced_buffers == 0 )
+	{
+		return( 1 );
+	}
+	if( ioctl(
+	     stream_writer->output_file_descriptor,
+	     FIONREAD,
+	     &number_of_pending_bytes ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to determine number of bytes in pipe.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_pending_bytes < 0 )
+	 || ( (uint64_t) number_of_pending_bytes > stream_writer->write_offset ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of bytes in pipe value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	consumed_offset = stream_writer->write_offset - (uint64_t) number_of_pending_bytes;
+
+	while( stream_writer->number_of_spliced_buffers > 0 )
+	{
+		if( stream_writer->spliced_buffer_end_offsets[ stream_writer->first_spliced_buffer_index ] > consumed_offset )
+		{
+			break;
+		}
+		storage_media_buffer = stream_writer->spliced_buffers[ stream_writer->first_spliced_buffer_index ];
+
+		stream_writer->spliced_buffers[ stream_writer->first_spliced_buffer_index ] = NULL;
+
+		stream_writer->first_spliced_buffer_index = ( stream_writer->first_spliced_buffer_index + 1 ) % STREAM_WRITER_MAXIMUM_NUMBER_OF_SPLICED_BUFFERS;
+		stream_writer->number_of_spliced_buffers -= 1;
+
+		if( storage_media_buffer_queue_release_buffer(
+		     stream_writer->storage_media_buffer_queue,
+		     storage_media_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release spliced storage media buffer onto queue.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_STREAM_WRITER_VMSPLICE ) */
+
+/* Writes the data of a storage media buffer to the stream
+ * If the buffer was grabbed from the storage media buffer queue of the writer and the stream
+ * is a pipe the pages of the buffer are spliced into the pipe, otherwise the data is copied
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t stream_writer_write_storage_media_buffer(
+         stream_writer_t *stream_writer,
+         storage_media_buffer_t *storage_media_buffer,
+         size_t write_size,
+         libcerror_error_t **error )
+{
+	static char *function = "stream_writer_write_storage_media_buffer";
+
+#if defined( HAVE_STREAM_WRITER_VMSPLICE )
+	struct iovec io_vector;
+
+	size_t buffer_offset  = 0;
+	ssize_t write_count   = 0;
+#endif
+
+	if( stream_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_size > storage_media_buffer->raw_buffer_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid write size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_STREAM_WRITER_VMSPLICE )
+	if( ( stream_writer->use_vmsplice != 0 )
+	 && ( stream_writer->storage_media_buffer_queue != NULL )
+	 && ( storage_media_buffer->mode == STORAGE_MEDIA_BUFFER_MODE_BUFFERED )
+	 && ( write_size > 0 ) )
+	{
+		if( stream_writer_release_consumed_buffers(
+		     stream_writer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release consumed buffers.",
+			 function );
+
+			return( -1 );
+		}
+		/* If the reader lags too far behind the data is copied, so that the buffers
+		 * held by the pipe cannot starve the storage media buffer queue, since held
+		 * buffers are only released when a next buffer is written
+		 */
+		if( stream_writer->number_of_spliced_buffers < stream_writer->maximum_number_of_spliced_buffers )
+		{
+			while( buffer_offset < write_size )
+			{
+				io_vector.iov_base = (void *) &( storage_media_buffer->raw_buffer[ buffer_offset ] );
+				io_vector.iov_len  = write_size - buffer_offset;
+
+				write_count = vmsplice(
+				               stream_writer->output_file_descriptor,
+				               &io_vector,
+				               1,
+				               0 );
+
+				if( write_count > 0 )
+				{
+					buffer_offset               += (size_t) write_count;
+					stream_writer->write_offset += (uint64_t) write_count;
+				}
+				else if( ( write_count < 0 )
+				      && ( errno == EINTR ) )
+				{
+					continue;
+				}
+				else if( ( write_count < 0 )
+				      && ( buffer_offset == 0 )
+				      && ( ( errno == EINVAL )
+				       ||  ( errno == ENOSYS ) ) )
+				{
+					/* The output does not support vmsplice, fall back to copying the data
+					 */
+					stream_writer->use_vmsplice = 0;
+
+					break;
+				}
+				else
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to splice buffer at offset: %" PRIu64 ".",
+					 function,
+					 stream_writer->write_offset );
+
+					return( -1 );
+				}
+			}
+			if( buffer_offset > 0 )
+			{
+				/* The pipe references the pages of the buffer until the reader consumed them
+				 * hence the buffer is only released onto the queue after that
+				 */
+				if( storage_media_buffer_queue_reference_buffer(
+				     stream_writer->storage_media_buffer_queue,
+				     storage_media_buffer,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to reference storage media buffer.",
+					 function );
+
+					return( -1 );
+				}
+				stream_writer->spliced_buffers[ ( stream_writer->first_spliced_buffer_index + stream_writer->number_of_spliced_buffers ) % STREAM_WRITER_MAXIMUM_NUMBER_OF_SPLICED_BUFFERS ] = storage_media_buffer;
+				stream_writer->spliced_buffer_end_offsets[ ( stream_writer->first_spliced_buffer_index + stream_writer->number_of_spliced_buffers ) % STREAM_WRITER_MAXIMUM_NUMBER_OF_SPLICED_BUFFERS ] = stream_writer->write_offset;
+
+				stream_writer->number_of_spliced_buffers += 1;
+
+				return( (ssize_t) write_size );
+			}
+		}
+	}
+#endif /* defined( HAVE_STREAM_WRITER_VMSPLICE ) */
+
+	return( stream_writer_write_buffer(
+	         stream_writer,
+	         storage_media_buffer->raw_buffer,
+	         write_size,
+	         error ) );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Sets the storage media buffer queue the written storage media buffers were grabbed from
+ * Only buffers of the queue are spliced into the pipe, since the queue allows to defer their release
+ * At most half of the maximum number of buffers of the queue are held by the pipe
+ * Returns 1 if successful or -1 on error
+ */
+int stream_writer_set_storage_media_buffer_queue(
+     stream_writer_t *stream_writer,
+     storage_media_buffer_queue_t *storage_media_buffer_queue,
+     int maximum_number_of_buffers,
+     libcerror_error_t **error )
+{
+	static char *function = "stream_writer_set_storage_media_buffer_queue";
+
+	if( stream_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream_writer->number_of_spliced_buffers != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid stream writer - spliced buffers were not released.",
+		 function );
+
+		return( -1 );
+	}
+	stream_writer->storage_media_buffer_queue        = storage_media_buffer_queue;
+	stream_writer->maximum_number_of_spliced_buffers = maximum_number_of_buffers / 2;
+
+	if( stream_writer->maximum_number_of_spliced_buffers > STREAM_WRITER_MAXIMUM_NUMBER_OF_SPLICED_BUFFERS )
+	{
+		stream_writer->maximum_number_of_spliced_buffers = STREAM_WRITER_MAXIMUM_NUMBER_OF_SPLICED_BUFFERS;
+	}
+	else if( stream_writer->maximum_number_of_spliced_buffers < 0 )
+	{
+		stream_writer->maximum_number_of_spliced_buffers = 0;
+	}
+	return( 1 );
+}
+
+/* Releases all spliced buffers onto the storage media buffer queue
+ * This must be done before the storage media buffer queue is freed
+ * If wait for reader is set the buffers are released after the reader consumed the data
+ * in the pipe or closed the pipe, otherwise they are released immediately
+ * Returns 1 if successful or -1 on error
+ */
+int stream_writer_release_spliced_buffers(
+     stream_writer_t *stream_writer,
+     uint8_t wait_for_reader,
+     libcerror_error_t **error )
+{
+	static char *function = "stream_writer_release_spliced_buffers";
+	int result            = 1;
+
+#if defined( HAVE_STREAM_WRITER_VMSPLICE )
+	struct pollfd poll_file_descriptor;
+#endif
+
+	if( stream_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream writer.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_STREAM_WRITER_VMSPLICE )
+	if( wait_for_reader != 0 )
+	{
+		while( stream_writer->number_of_spliced_buffers > 0 )
+		{
+			if( stream_writer_release_consumed_buffers(
+			     stream_writer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release consumed buffers.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+			if( stream_writer->number_of_spliced_buffers == 0 )
+			{
+				break;
+			}
+			/* Without events poll only reports if the reader closed the pipe
+			 */
+			poll_file_descriptor.fd      = stream_writer->output_file_descriptor;
+			poll_file_descriptor.events  = 0;
+			poll_file_descriptor.revents = 0;
+
+			if( poll(
+			     &poll_file_descriptor,
+			     1,
+			     10 ) > 0 )
+			{
+				break;
+			}
+		}
+	}
+#endif /* defined( HAVE_STREAM_WRITER_VMSPLICE ) */
+
+	while( stream_writer->number_of_spliced_buffers > 0 )
+	{
+		if( storage_media_buffer_queue_release_buffer(
+		     stream_writer->storage_media_buffer_queue,
+		     stream_writer->spliced_buffers[ stream_writer->first_spliced_buffer_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release spliced storage media buffer onto queue.",
+			 function );
+
+			result = -1;
+		}
+		stream_writer->spliced_buffers[ stream_writer->first_spliced_buffer_index ] = NULL;
+
+		stream_writer->first_spliced_buffer_index = ( stream_writer->first_spliced_buffer_index + 1 ) % STREAM_WRITER_MAXIMUM_NUMBER_OF_SPLICED_BUFFERS;
+		stream_writer->number_of_spliced_buffers -= 1;
+	}
+	stream_writer->first_spliced_buffer_index = 0;
+
+	return( result );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,145 @@
+/*
+ * Stream writer functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _STREAM_WRITER_H )
+#define _STREAM_WRITER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "storage_media_buffer.h"
+#include "storage_media_buffer_queue.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The pipe size requested for an output that is a pipe
+ */
+#define STREAM_WRITER_PIPE_SIZE				( 8 * 1024 * 1024 )
+
+/* The maximum number of storage media buffers that can be referenced by the pipe
+ */
+#define STREAM_WRITER_MAXIMUM_NUMBER_OF_SPLICED_BUFFERS	64
+
+typedef struct stream_writer stream_writer_t;
+
+/* The stream writer writes sequentially to a stream, such as stdout
+ *
+ * If the stream is a pipe on Linux the pages of the storage media buffers
+ * are spliced into the pipe instead of being copied. Since the pipe then references
+ * the memory of a buffer, the buffer is only released onto the storage media buffer
+ * queue after the reader has consumed its data
+ */
+struct stream_writer
+{
+	/* The output file descriptor
+	 */
+	int output_file_descriptor;
+
+	/* The size of the kernel buffer of the output, where 0 represents not a pipe
+	 */
+	size_t pipe_size;
+
+	/* The number of bytes written
+	 */
+	uint64_t write_offset;
+
+	/* Value to indicate the pages of the storage media buffers should be spliced into the pipe
+	 */
+	uint8_t use_vmsplice;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The storage media buffer queue of the spliced buffers
+	 */
+	storage_media_buffer_queue_t *storage_media_buffer_queue;
+
+	/* The ring of spliced buffers that can still be referenced by the pipe
+	 */
+	storage_media_buffer_t *spliced_buffers[ STREAM_WRITER_MAXIMUM_NUMBER_OF_SPLICED_BUFFERS ];
+
+	/* The write offset of the end of each spliced buffer
+	 */
+	uint64_t spliced_buffer_end_offsets[ STREAM_WRITER_MAXIMUM_NUMBER_OF_SPLICED_BUFFERS ];
+
+	/* The index of the first spliced buffer
+	 */
+	int first_spliced_buffer_index;
+
+	/* The number of spliced buffers
+	 */
+	int number_of_spliced_buffers;
+
+	/* The maximum number of spliced buffers
+	 */
+	int maximum_number_of_spliced_buffers;
+#endif
+};
+
+int stream_writer_initialize(
+     stream_writer_t **stream_writer,
+     int output_file_descriptor,
+     libcerror_error_t **error );
+
+int stream_writer_free(
+     stream_writer_t **stream_writer,
+     libcerror_error_t **error );
+
+int stream_writer_set_pipe_size(
+     stream_writer_t *stream_writer,
+     size_t pipe_size,
+     libcerror_error_t **error );
+
+ssize_t stream_writer_write_buffer(
+         stream_writer_t *stream_writer,
+         const uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
+ssize_t stream_writer_write_storage_media_buffer(
+         stream_writer_t *stream_writer,
+         storage_media_buffer_t *storage_media_buffer,
+         size_t write_size,
+         libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int stream_writer_set_storage_media_buffer_queue(
+     stream_writer_t *stream_writer,
+     storage_media_buffer_queue_t *storage_media_buffer_queue,
+     int maximum_number_of_buffers,
+     libcerror_error_t **error );
+
+int stream_writer_release_spliced_buffers(
+     stream_writer_t *stream_writer,
+     uint8_t wait_for_reader,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _STREAM_WRITER_H ) */
+
@@ -0,0 +1,751 @@
+/*
+ * Process thread autotune functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_timestamp.h"
+#include "storage_media_buffer_queue.h"
+#include "thread_autotune.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Retrieves the maximum number of process threads of the auto number of jobs
+ * This is the number of online CPUs, bounded by THREAD_AUTOTUNE_MAXIMUM_NUMBER_OF_THREADS
+ * Returns 1 if successful or -1 on error
+ */
+int thread_autotune_get_maximum_number_of_threads(
+     int *maximum_number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "thread_autotune_get_maximum_number_of_threads";
+
+#if defined( HAVE_SYSCONF ) && defined( _SC_NPROCESSORS_ONLN )
+	long number_of_cpus   = 0;
+#endif
+
+	if( maximum_number_of_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum number of threads.",
+		 function );
+
+		return( -1 );
+	}
+	*maximum_number_of_threads = THREAD_AUTOTUNE_MAXIMUM_NUMBER_OF_THREADS;
+
+#if defined( HAVE_SYSCONF ) && defined( _SC_NPROCESSORS_ONLN )
+	number_of_cpus = sysconf(
+	                  _SC_NPROCESSORS_ONLN );
+
+	if( ( number_of_cpus > 0 )
+	 && ( number_of_cpus < (long) THREAD_AUTOTUNE_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		*maximum_number_of_threads = (int) number_of_cpus;
+	}
+#endif
+	return( 1 );
+}
+
+/* Creates a thread autotune
+ * Make sure the value thread_autotune is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int thread_autotune_initialize(
+     thread_autotune_t **thread_autotune,
+     int maximum_number_of_threads,
+     int initial_number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "thread_autotune_initialize";
+
+	if( thread_autotune == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid thread autotune.",
+		 function );
+
+		return( -1 );
+	}
+	if( *thread_autotune != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid thread autotune value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_threads <= 0 )
+	 || ( maximum_number_of_threads > THREAD_AUTOTUNE_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( initial_number_of_threads <= 0 )
+	 || ( initial_number_of_threads > maximum_number_of_threads ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid initial number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*thread_autotune = memory_allocate_structure(
+	                    thread_autotune_t );
+
+	if( *thread_autotune == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create thread autotune.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *thread_autotune,
+	     0,
+	     sizeof( thread_autotune_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear thread autotune.",
+		 function );
+
+		memory_free(
+		 *thread_autotune );
+
+		*thread_autotune = NULL;
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *thread_autotune )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *thread_autotune )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	( *thread_autotune )->maximum_number_of_threads = maximum_number_of_threads;
+	( *thread_autotune )->number_of_threads         = initial_number_of_threads;
+	( *thread_autotune )->ceiling_number_of_threads = maximum_number_of_threads;
+
+	return( 1 );
+
+on_error:
+	if( *thread_autotune != NULL )
+	{
+		thread_autotune_free(
+		 thread_autotune,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a thread autotune
+ * Returns 1 if successful or -1 on error
+ */
+int thread_autotune_free(
+     thread_autotune_t **thread_autotune,
+     libcerror_error_t **error )
+{
+	static char *function = "thread_autotune_free";
+	int result            = 1;
+
+	if( thread_autotune == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid thread autotune.",
+		 function );
+
+		return( -1 );
+	}
+	if( *thread_autotune != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: number of process threads: %d of maximum: %d.\n",
+			 function,
+			 ( *thread_autotune )->number_of_threads,
+			 ( *thread_autotune )->maximum_number_of_threads );
+		}
+#endif
+		if( ( *thread_autotune )->condition != NULL )
+		{
+			if( libcthreads_condition_free(
+			     &( ( *thread_autotune )->condition ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free condition.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *thread_autotune )->mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *thread_autotune )->mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *thread_autotune );
+
+		*thread_autotune = NULL;
+	}
+	return( result );
+}
+
+/* Acquires a slot to process a storage media buffer
+ * Blocks while the number of threads that are processing has reached the limit
+ * Returns 1 if successful or -1 on error
+ */
+int thread_autotune_acquire(
+     thread_autotune_t *thread_autotune,
+     int64_t *start_timestamp,
+     libcerror_error_t **error )
+{
+	static char *function        = "thread_autotune_acquire";
+	int64_t wait_end_timestamp   = 0;
+	int64_t wait_start_timestamp = 0;
+	int result                   = 1;
+
+	if( thread_autotune == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid thread autotune.",
+		 function );
+
+		return( -1 );
+	}
+	if( start_timestamp == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid start timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     thread_autotune->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( thread_autotune->number_of_active_threads >= thread_autotune->number_of_threads )
+	{
+		if( ewftools_timestamp_get_monotonic(
+		     &wait_start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve wait start timestamp.",
+			 function );
+
+			result = -1;
+		}
+		thread_autotune->number_of_waiting_threads += 1;
+
+		while( ( result == 1 )
+		    && ( thread_autotune->number_of_active_threads >= thread_autotune->number_of_threads ) )
+		{
+			if( libcthreads_condition_wait(
+			     thread_autotune->condition,
+			     thread_autotune->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to wait for condition.",
+				 function );
+
+				result = -1;
+			}
+		}
+		thread_autotune->number_of_waiting_threads -= 1;
+	}
+	if( result == 1 )
+	{
+		if( ewftools_timestamp_get_monotonic(
+		     start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve start timestamp.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		wait_end_timestamp = *start_timestamp;
+
+		if( ( wait_start_timestamp != 0 )
+		 && ( wait_end_timestamp > wait_start_timestamp ) )
+		{
+			thread_autotune->wait_time += (uint64_t) ( wait_end_timestamp - wait_start_timestamp );
+		}
+		thread_autotune->number_of_active_threads += 1;
+	}
+	if( libcthreads_mutex_release(
+	     thread_autotune->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Releases a slot that was acquired to process a storage media buffer
+ * Returns 1 if successful or -1 on error
+ */
+int thread_autotune_release(
+     thread_autotune_t *thread_autotune,
+     int64_t start_timestamp,
+     libcerror_error_t **error )
+{
+	static char *function = "thread_autotune_release";
+	int64_t end_timestamp = 0;
+	int result            = 1;
+
+	if( thread_autotune == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid thread autotune.",
+		 function );
+
+		return( -1 );
+	}
+	if( ewftools_timestamp_get_monotonic(
+	     &end_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve end timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     thread_autotune->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( thread_autotune->number_of_active_threads <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid thread autotune - number of active threads value out of bounds.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		thread_autotune->number_of_active_threads -= 1;
+
+		if( end_timestamp > start_timestamp )
+		{
+			thread_autotune->busy_time += (uint64_t) ( end_timestamp - start_timestamp );
+		}
+		/* A single slot was released hence signalling a single waiting thread suffices
+		 */
+		if( ( thread_autotune->number_of_waiting_threads > 0 )
+		 && ( thread_autotune->number_of_active_threads < thread_autotune->number_of_threads ) )
+		{
+			if( libcthreads_condition_signal(
+			     thread_autotune->condition,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to signal condition.",
+				 function );
+
+				result = -1;
+			}
+		}
+	}
+	if( libcthreads_mutex_release(
+	     thread_autotune->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Updates the thread autotune with the number of bytes done
+ * Once per interval the number of process threads is adjusted:
+ * - if the previous increase lowered the throughput the increase is reverted
+ *   and the number of threads is not increased beyond it for a number of intervals
+ * - if buffers had to wait for a slot the processing bounds the throughput
+ *   and the number of threads is increased
+ * - if the threads were mostly idle the throughput is bounded by the read
+ *   or write device and the number of threads is decreased
+ * Returns 1 if successful or -1 on error
+ */
+int thread_autotune_update(
+     thread_autotune_t *thread_autotune,
+     size64_t bytes_done,
+     libcerror_error_t **error )
+{
+	static char *function    = "thread_autotune_update";
+	uint64_t busy_percentage = 0;
+	uint64_t elapsed_time    = 0;
+	uint64_t throughput      = 0;
+	uint64_t wait_percentage = 0;
+	int64_t timestamp        = 0;
+	int adjustment           = 0;
+	int result               = 1;
+
+	if( thread_autotune == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid thread autotune.",
+		 function );
+
+		return( -1 );
+	}
+	if( ewftools_timestamp_get_monotonic(
+	     &timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     thread_autotune->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( thread_autotune->interval_start_timestamp == 0 )
+	{
+		thread_autotune->interval_start_timestamp  = timestamp;
+		thread_autotune->interval_start_bytes_done = bytes_done;
+		thread_autotune->wait_time                 = 0;
+		thread_autotune->busy_time                 = 0;
+	}
+	else if( ( timestamp - thread_autotune->interval_start_timestamp ) >= (int64_t) THREAD_AUTOTUNE_INTERVAL )
+	{
+		elapsed_time = (uint64_t) ( timestamp - thread_autotune->interval_start_timestamp );
+
+		if( bytes_done > thread_autotune->interval_start_bytes_done )
+		{
+			/* Use milli seconds to prevent the multiplication from overflowing
+			 */
+			throughput = ( ( bytes_done - thread_autotune->interval_start_bytes_done ) * 1000 )
+			           / ( elapsed_time / 1000000 );
+		}
+		busy_percentage = ( thread_autotune->busy_time * 100 )
+		                / ( elapsed_time * (uint64_t) thread_autotune->number_of_threads );
+
+		wait_percentage = ( thread_autotune->wait_time * 100 ) / elapsed_time;
+
+		if( thread_autotune->ceiling_number_of_threads < thread_autotune->maximum_number_of_threads )
+		{
+			thread_autotune->number_of_ceiling_intervals += 1;
+
+			if( thread_autotune->number_of_ceiling_intervals >= THREAD_AUTOTUNE_NUMBER_OF_PROBE_INTERVALS )
+			{
+				thread_autotune->ceiling_number_of_threads   = thread_autotune->maximum_number_of_threads;
+				thread_autotune->number_of_ceiling_intervals = 0;
+			}
+		}
+		if( ( thread_autotune->last_adjustment > 0 )
+		 && ( throughput < ( thread_autotune->last_throughput - ( thread_autotune->last_throughput / 20 ) ) ) )
+		{
+			thread_autotune->ceiling_number_of_threads   = thread_autotune->number_of_threads - 1;
+			thread_autotune->number_of_ceiling_intervals = 0;
+
+			adjustment = -1;
+		}
+		else if( ( wait_percentage >= 10 )
+		      && ( thread_autotune->number_of_threads < thread_autotune->ceiling_number_of_threads ) )
+		{
+			adjustment = 1;
+		}
+		else if( ( busy_percentage < 50 )
+		      && ( thread_autotune->number_of_threads > 1 ) )
+		{
+			adjustment = -1;
+		}
+		thread_autotune->number_of_threads        += adjustment;
+		thread_autotune->last_adjustment           = adjustment;
+		thread_autotune->last_throughput           = throughput;
+		thread_autotune->interval_start_timestamp  = timestamp;
+		thread_autotune->interval_start_bytes_done = bytes_done;
+		thread_autotune->wait_time                 = 0;
+		thread_autotune->busy_time                 = 0;
+
+		/* Wake up the threads that are waiting on the additional slot
+		 */
+		if( ( adjustment > 0 )
+		 && ( thread_autotune->number_of_waiting_threads > 0 ) )
+		{
+			if( libcthreads_condition_broadcast(
+			     thread_autotune->condition,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to broadcast condition.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( ( libcnotify_verbose != 0 )
+		 && ( adjustment != 0 ) )
+		{
+			libcnotify_printf(
+			 "%s: number of process threads: %d (throughput: %" PRIu64 " bytes per second, busy: %" PRIu64 "%%, waiting: %" PRIu64 "%%).\n",
+			 function,
+			 thread_autotune->number_of_threads,
+			 throughput,
+			 busy_percentage,
+			 wait_percentage );
+		}
+#endif
+	}
+	if( libcthreads_mutex_release(
+	     thread_autotune->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves the number of threads that can process at the same time
+ * Returns 1 if successful or -1 on error
+ */
+int thread_autotune_get_number_of_threads(
+     thread_autotune_t *thread_autotune,
+     int *number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "thread_autotune_get_number_of_threads";
+
+	if( thread_autotune == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid thread autotune.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of threads.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     thread_autotune->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_threads = thread_autotune->number_of_threads;
+
+	if( libcthreads_mutex_release(
+	     thread_autotune->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,157 @@
+/*
+ * Process thread autotune functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _THREAD_AUTOTUNE_H )
+#define _THREAD_AUTOTUNE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The maximum number of process threads of the auto number of jobs
+ */
+#define THREAD_AUTOTUNE_MAXIMUM_NUMBER_OF_THREADS	32
+
+/* The interval between adjustments of the number of process threads in nano seconds
+ */
+#define THREAD_AUTOTUNE_INTERVAL			1000000000
+
+/* The number of intervals after which a number of process threads that was
+ * reverted because it lowered the throughput is probed again
+ */
+#define THREAD_AUTOTUNE_NUMBER_OF_PROBE_INTERVALS	30
+
+typedef struct thread_autotune thread_autotune_t;
+
+/* The thread autotune limits the number of process threads that process
+ * a storage media buffer at the same time and adjusts that limit at runtime
+ * The process thread pools are created with the maximum number of threads,
+ * the threads above the limit wait until a slot is released
+ */
+struct thread_autotune
+{
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when a slot becomes available
+	 */
+	libcthreads_condition_t *condition;
+
+	/* The maximum number of threads
+	 */
+	int maximum_number_of_threads;
+
+	/* The number of threads that can process at the same time
+	 */
+	int number_of_threads;
+
+	/* The number of threads beyond which the throughput decreased
+	 */
+	int ceiling_number_of_threads;
+
+	/* The number of intervals since the ceiling was set
+	 */
+	int number_of_ceiling_intervals;
+
+	/* The number of threads that are processing
+	 */
+	int number_of_active_threads;
+
+	/* The number of threads that are waiting for a slot
+	 */
+	int number_of_waiting_threads;
+
+	/* The time in nano seconds threads had to wait for a slot in the current interval
+	 */
+	uint64_t wait_time;
+
+	/* The time in nano seconds threads were processing in the current interval
+	 */
+	uint64_t busy_time;
+
+	/* The timestamp of the start of the current interval
+	 */
+	int64_t interval_start_timestamp;
+
+	/* The number of bytes done at the start of the current interval
+	 */
+	size64_t interval_start_bytes_done;
+
+	/* The throughput of the previous interval in bytes per second
+	 */
+	uint64_t last_throughput;
+
+	/* The adjustment of the number of threads at the end of the previous interval
+	 */
+	int last_adjustment;
+};
+
+int thread_autotune_get_maximum_number_of_threads(
+     int *maximum_number_of_threads,
+     libcerror_error_t **error );
+
+int thread_autotune_initialize(
+     thread_autotune_t **thread_autotune,
+     int maximum_number_of_threads,
+     int initial_number_of_threads,
+     libcerror_error_t **error );
+
+int thread_autotune_free(
+     thread_autotune_t **thread_autotune,
+     libcerror_error_t **error );
+
+int thread_autotune_acquire(
+     thread_autotune_t *thread_autotune,
+     int64_t *start_timestamp,
+     libcerror_error_t **error );
+
+int thread_autotune_release(
+     thread_autotune_t *thread_autotune,
+     int64_t start_timestamp,
+     libcerror_error_t **error );
+
+int thread_autotune_update(
+     thread_autotune_t *thread_autotune,
+     size64_t bytes_done,
+     libcerror_error_t **error );
+
+int thread_autotune_get_number_of_threads(
+     thread_autotune_t *thread_autotune,
+     int *number_of_threads,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _THREAD_AUTOTUNE_H ) */
+
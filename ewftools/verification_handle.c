@@ -26,6 +26,19 @@
 #include <types.h>
 #include <wide_string.h>
 
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( TIME_WITH_SYS_TIME )
+#include <sys/time.h>
+#include <time.h>
+#elif defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#else
+#include <time.h>
+#endif
+
 #include "byte_size_string.h"
 #include "digest_hash.h"
 #include "ewfcommon.h"
@@ -39,16 +52,30 @@
 #include "ewftools_libewf.h"
 #include "ewftools_libhmac.h"
 #include "ewftools_system_string.h"
+#include "ewftools_timestamp.h"
 #include "log_handle.h"
+#include "md5_context.h"
 #include "process_status.h"
+#include "rate_limiter.h"
+#include "restart_checkpoint.h"
+#include "scrub_state.h"
+#include "segment_ledger.h"
+#include "sha1_context.h"
+#include "sha256_context.h"
+#include "stats_output.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
 #include "verification_handle.h"
+#include "verify_file_entry.h"
 
 #define VERIFICATION_HANDLE_VALUE_SIZE			64
 #define VERIFICATION_HANDLE_VALUE_IDENTIFIER_SIZE	32
 #define VERIFICATION_HANDLE_NOTIFY_STREAM		stdout
 
+/* The size of the data of the file entries that are verified by the same thread
+ */
+#define VERIFICATION_HANDLE_FILE_ENTRIES_BATCH_SIZE	( 4 * 1024 * 1024 )
+
 /* Creates a verification handle
  * Make sure the value verification_handle is referencing, is set to NULL
  * Returns 1 if successful or -1 on error
@@ -291,9 +318,23 @@ int verification_handle_free(
 
 			result = -1;
 		}
+		if( ( ( *verification_handle )->compare_handle != NULL )
+		 && ( libewf_handle_free(
+		       &( ( *verification_handle )->compare_handle ),
+		       error ) != 1 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free compare handle.",
+			 function );
+
+			result = -1;
+		}
 		if( ( *verification_handle )->md5_context != NULL )
 		{
-			if( libhmac_md5_free(
+			if( md5_context_free(
 			     &( ( *verification_handle )->md5_context ),
 			     error ) != 1 )
 			{
@@ -319,7 +360,7 @@ int verification_handle_free(
 		}
 		if( ( *verification_handle )->sha1_context != NULL )
 		{
-			if( libhmac_sha1_free(
+			if( sha1_context_free(
 			     &( ( *verification_handle )->sha1_context ),
 			     error ) != 1 )
 			{
@@ -345,7 +386,7 @@ int verification_handle_free(
 		}
 		if( ( *verification_handle )->sha256_context != NULL )
 		{
-			if( libhmac_sha256_free(
+			if( sha256_context_free(
 			     &( ( *verification_handle )->sha256_context ),
 			     error ) != 1 )
 			{
@@ -369,6 +410,48 @@ int verification_handle_free(
 			memory_free(
 			 ( *verification_handle )->stored_sha256_hash_string );
 		}
+		if( ( *verification_handle )->restart_checkpoint_filename != NULL )
+		{
+			memory_free(
+			 ( *verification_handle )->restart_checkpoint_filename );
+		}
+		if( ( *verification_handle )->rate_limiter != NULL )
+		{
+			if( rate_limiter_free(
+			     &( ( *verification_handle )->rate_limiter ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free rate limiter.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *verification_handle )->range_digests != NULL )
+		{
+			if( range_digests_free(
+			     &( ( *verification_handle )->range_digests ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free range digests.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *verification_handle )->mismatched_ranges != NULL )
+		{
+			memory_free(
+			 ( *verification_handle )->mismatched_ranges );
+		}
 		memory_free(
 		 *verification_handle );
 
@@ -413,6 +496,22 @@ int verification_handle_signal_abort(
 			return( -1 );
 		}
 	}
+	if( verification_handle->compare_handle != NULL )
+	{
+		if( libewf_handle_signal_abort(
+		     verification_handle->compare_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal compare handle to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	verification_handle->abort = 1;
 
 	return( 1 );
@@ -652,6 +751,186 @@ on_error:
 	return( -1 );
 }
 
+/* Opens the image the input of the verification handle is compared with
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_open_compare_input(
+     verification_handle_t *verification_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	system_character_t **libewf_filenames = NULL;
+	static char *function                 = "verification_handle_open_compare_input";
+	size_t filename_length                = 0;
+	int number_of_filenames               = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->compare_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid verification handle - compare handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide(
+	     filename,
+	     filename_length,
+	     LIBEWF_FORMAT_UNKNOWN,
+	     &libewf_filenames,
+	     &number_of_filenames,
+	     error ) != 1 )
+#else
+	if( libewf_glob(
+	     filename,
+	     filename_length,
+	     LIBEWF_FORMAT_UNKNOWN,
+	     &libewf_filenames,
+	     &number_of_filenames,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to resolve filename(s).",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_initialize(
+	     &( verification_handle->compare_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize compare handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle->header_codepage != LIBEWF_CODEPAGE_ASCII )
+	{
+		if( libewf_handle_set_header_codepage(
+		     verification_handle->compare_handle,
+		     verification_handle->header_codepage,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set header codepage.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     verification_handle->compare_handle,
+	     libewf_filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     verification_handle->compare_handle,
+	     libewf_filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open files.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide_free(
+	     libewf_filenames,
+	     number_of_filenames,
+	     error ) != 1 )
+#else
+	if( libewf_glob_free(
+	     libewf_filenames,
+	     number_of_filenames,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free globbed filenames.",
+		 function );
+
+		libewf_filenames = NULL;
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( verification_handle->compare_handle != NULL )
+	{
+		libewf_handle_free(
+		 &( verification_handle->compare_handle ),
+		 NULL );
+	}
+	if( libewf_filenames != NULL )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		libewf_glob_wide_free(
+		 libewf_filenames,
+		 number_of_filenames,
+		 NULL );
+#else
+		libewf_glob_free(
+		 libewf_filenames,
+		 number_of_filenames,
+		 NULL );
+#endif
+	}
+	return( -1 );
+}
+
 /* Closes the verification handle
  * Returns the 0 if succesful or -1 on error
  */
@@ -685,6 +964,22 @@ int verification_handle_close(
 
 		return( -1 );
 	}
+	if( verification_handle->compare_handle != NULL )
+	{
+		if( libewf_handle_close(
+		     verification_handle->compare_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close compare handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	return( 0 );
 }
 
@@ -710,7 +1005,7 @@ int verification_handle_initialize_integrity_hash(
 	}
 	if( verification_handle->calculate_md5 != 0 )
 	{
-		if( libhmac_md5_initialize(
+		if( md5_context_initialize(
 		     &( verification_handle->md5_context ),
 		     error ) != 1 )
 		{
@@ -727,7 +1022,7 @@ int verification_handle_initialize_integrity_hash(
 	}
 	if( verification_handle->calculate_sha1 != 0 )
 	{
-		if( libhmac_sha1_initialize(
+		if( sha1_context_initialize(
 		     &( verification_handle->sha1_context ),
 		     error ) != 1 )
 		{
@@ -744,7 +1039,7 @@ int verification_handle_initialize_integrity_hash(
 	}
 	if( verification_handle->calculate_sha256 != 0 )
 	{
-		if( libhmac_sha256_initialize(
+		if( sha256_context_initialize(
 		     &( verification_handle->sha256_context ),
 		     error ) != 1 )
 		{
@@ -764,13 +1059,13 @@ int verification_handle_initialize_integrity_hash(
 on_error:
 	if( verification_handle->sha1_context != NULL )
 	{
-		libhmac_sha1_free(
+		sha1_context_free(
 		 &( verification_handle->sha1_context ),
 		 NULL );
 	}
 	if( verification_handle->md5_context != NULL )
 	{
-		libhmac_md5_free(
+		md5_context_free(
 		 &( verification_handle->md5_context ),
 		 NULL );
 	}
@@ -786,7 +1081,8 @@ int verification_handle_update_integrity_hash(
      size_t buffer_size,
      libcerror_error_t **error )
 {
-	static char *function = "verification_handle_update_integrity_hash";
+	static char *function         = "verification_handle_update_integrity_hash";
+	int64_t stats_start_timestamp = 0;
 
 	if( verification_handle == NULL )
 	{
@@ -822,9 +1118,25 @@ int verification_handle_update_integrity_hash(
 
 		return( -1 );
 	}
+	if( verification_handle->stats_output != NULL )
+	{
+		if( ewftools_timestamp_get_monotonic(
+		     &stats_start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve statistics start timestamp.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	if( verification_handle->calculate_md5 != 0 )
 	{
-		if( libhmac_md5_update(
+		if( md5_context_update(
 		     verification_handle->md5_context,
 		     buffer,
 		     buffer_size,
@@ -842,7 +1154,7 @@ int verification_handle_update_integrity_hash(
 	}
 	if( verification_handle->calculate_sha1 != 0 )
 	{
-		if( libhmac_sha1_update(
+		if( sha1_context_update(
 		     verification_handle->sha1_context,
 		     buffer,
 		     buffer_size,
@@ -860,7 +1172,7 @@ int verification_handle_update_integrity_hash(
 	}
 	if( verification_handle->calculate_sha256 != 0 )
 	{
-		if( libhmac_sha256_update(
+		if( sha256_context_update(
 		     verification_handle->sha256_context,
 		     buffer,
 		     buffer_size,
@@ -876,6 +1188,25 @@ int verification_handle_update_integrity_hash(
 			return( -1 );
 		}
 	}
+	if( verification_handle->stats_output != NULL )
+	{
+		if( stats_output_add_stage(
+		     verification_handle->stats_output,
+		     STATS_OUTPUT_STAGE_HASH,
+		     (size64_t) buffer_size,
+		     stats_start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to add hash to statistics output.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	return( 1 );
 }
 
@@ -916,7 +1247,7 @@ int verification_handle_finalize_integrity_hash(
 
 			return( -1 );
 		}
-		if( libhmac_md5_finalize(
+		if( md5_context_finalize(
 		     verification_handle->md5_context,
 		     calculated_md5_hash,
 		     LIBHMAC_MD5_HASH_SIZE,
@@ -931,7 +1262,7 @@ int verification_handle_finalize_integrity_hash(
 
 			return( -1 );
 		}
-		if( libhmac_md5_free(
+		if( md5_context_free(
 		     &( verification_handle->md5_context ),
 		     error ) != 1 )
 		{
@@ -974,7 +1305,7 @@ int verification_handle_finalize_integrity_hash(
 
 			return( -1 );
 		}
-		if( libhmac_sha1_finalize(
+		if( sha1_context_finalize(
 		     verification_handle->sha1_context,
 		     calculated_sha1_hash,
 		     LIBHMAC_SHA1_HASH_SIZE,
@@ -989,7 +1320,7 @@ int verification_handle_finalize_integrity_hash(
 
 			return( -1 );
 		}
-		if( libhmac_sha1_free(
+		if( sha1_context_free(
 		     &( verification_handle->sha1_context ),
 		     error ) != 1 )
 		{
@@ -1032,7 +1363,7 @@ int verification_handle_finalize_integrity_hash(
 
 			return( -1 );
 		}
-		if( libhmac_sha256_finalize(
+		if( sha256_context_finalize(
 		     verification_handle->sha256_context,
 		     calculated_sha256_hash,
 		     LIBHMAC_SHA256_HASH_SIZE,
@@ -1047,7 +1378,7 @@ int verification_handle_finalize_integrity_hash(
 
 			return( -1 );
 		}
-		if( libhmac_sha256_free(
+		if( sha256_context_free(
 		     &( verification_handle->sha256_context ),
 		     error ) != 1 )
 		{
@@ -1080,342 +1411,659 @@ int verification_handle_finalize_integrity_hash(
 	return( 1 );
 }
 
-#if defined( HAVE_MULTI_THREAD_SUPPORT )
-
-/* Prepares a storage media buffer for verification
- * Callback function for the process thread pool
- * Returns 1 if successful or -1 on error
+/* Reads the restart checkpoint and restores the state of the integrity hash(es)
+ * The last checkpoint in the restart checkpoint file is used when it matches the media data
+ * This function should be called after the integrity hash(es) are initialized
+ * and before any data is hashed
+ * Returns 1 if successful, 0 if no usable restart checkpoint is available or -1 on error
  */
-int verification_handle_process_storage_media_buffer_callback(
-     storage_media_buffer_t *storage_media_buffer,
-     verification_handle_t *verification_handle )
+int verification_handle_read_restart_checkpoint(
+     verification_handle_t *verification_handle,
+     off64_t *hashed_offset,
+     libcerror_error_t **error )
 {
-        libcerror_error_t *error = NULL;
-        static char *function    = "verification_handle_process_storage_media_buffer_callback";
-	ssize_t process_count    = 0;
+	restart_checkpoint_t *restart_checkpoint = NULL;
+	static char *function                    = "verification_handle_read_restart_checkpoint";
+	uint32_t expected_flags                  = 0;
+	int result                               = 0;
 
-	if( storage_media_buffer == NULL )
+	if( verification_handle == NULL )
 	{
 		libcerror_error_set(
-		 &error,
+		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid storage media buffer.",
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->restart_checkpoint_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid verification handle - missing restart checkpoint filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( hashed_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hashed offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->calculate_md5 != 0 )
+	{
+		expected_flags |= RESTART_CHECKPOINT_FLAG_HAS_MD5_STATE;
+	}
+	if( verification_handle->calculate_sha1 != 0 )
+	{
+		expected_flags |= RESTART_CHECKPOINT_FLAG_HAS_SHA1_STATE;
+	}
+	if( verification_handle->calculate_sha256 != 0 )
+	{
+		expected_flags |= RESTART_CHECKPOINT_FLAG_HAS_SHA256_STATE;
+	}
+	if( restart_checkpoint_initialize(
+	     &restart_checkpoint,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create restart checkpoint.",
 		 function );
 
 		goto on_error;
 	}
-	process_count = storage_media_buffer_read_process(
-			 storage_media_buffer,
-			 &error );
+	result = restart_checkpoint_read_file(
+	          restart_checkpoint,
+	          verification_handle->restart_checkpoint_filename,
+	          (uint64_t) verification_handle->media_size,
+	          error );
 
-	if( process_count < 0 )
+	if( result == -1 )
 	{
-#if defined( HAVE_VERBOSE_OUTPUT )
-		if( libcnotify_verbose != 0 )
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read restart checkpoint file.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		/* A verification covers the entire media data
+		 */
+		if( ( restart_checkpoint->acquiry_offset != 0 )
+		 || ( restart_checkpoint->acquiry_size != (uint64_t) verification_handle->media_size )
+		 || ( restart_checkpoint->hashed_offset > (uint64_t) verification_handle->media_size )
+		 || ( restart_checkpoint->flags != expected_flags ) )
 		{
-			libcnotify_print_error_backtrace(
-			 error );
+			result = 0;
 		}
-#endif
-		libcerror_error_free(
-		 &error );
-
-		process_count = verification_handle->chunk_size;
-
-		/* Append a read error
+		/* The chunk data functions can only resume at a chunk boundary
 		 */
-		if( verification_handle_append_read_error(
-		     verification_handle,
-		     storage_media_buffer->storage_media_offset,
-		     (size_t) verification_handle->chunk_size,
-		     &error ) != 1 )
+		else if( ( verification_handle->use_chunk_data_functions != 0 )
+		      && ( verification_handle->chunk_size != 0 )
+		      && ( ( restart_checkpoint->hashed_offset % verification_handle->chunk_size ) != 0 ) )
+		{
+			result = 0;
+		}
+	}
+	/* The SHA1 and SHA256 states are restored first since their state can only be
+	 * restored when the SHA extensions are used, in which case the MD5 state is not restored
+	 */
+	if( ( result != 0 )
+	 && ( verification_handle->calculate_sha1 != 0 ) )
+	{
+		result = sha1_context_set_state(
+		          verification_handle->sha1_context,
+		          restart_checkpoint->sha1_state,
+		          SHA1_CONTEXT_STATE_SIZE,
+		          error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
-			 &error,
+			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to append read error.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set SHA1 state.",
 			 function );
 
 			goto on_error;
 		}
 	}
-	if( libcthreads_thread_pool_push_sorted(
-	     verification_handle->output_thread_pool,
-	     (intptr_t *) storage_media_buffer,
-	     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &storage_media_buffer_compare,
-	     LIBCTHREADS_SORT_FLAG_UNIQUE_VALUES,
-	     &error ) != 1 )
+	if( ( result != 0 )
+	 && ( verification_handle->calculate_sha256 != 0 ) )
 	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to push storage media buffer onto output thread pool queue.",
-		 function );
-
-		goto on_error;
-	}
-	storage_media_buffer = NULL;
+		result = sha256_context_set_state(
+		          verification_handle->sha256_context,
+		          restart_checkpoint->sha256_state,
+		          SHA256_CONTEXT_STATE_SIZE,
+		          error );
 
-	return( 1 );
-
-on_error:
-	if( storage_media_buffer != NULL )
-	{
-		if( storage_media_buffer_queue_release_buffer(
-		     verification_handle->storage_media_buffer_queue,
-		     storage_media_buffer,
-		     &error ) != 1 )
+		if( result == -1 )
 		{
 			libcerror_error_set(
-			 &error,
+			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set SHA256 state.",
 			 function );
 
-			storage_media_buffer_free(
-			 &storage_media_buffer,
-			 NULL );
+			goto on_error;
 		}
 	}
-	if( error != NULL )
+	if( ( result != 0 )
+	 && ( verification_handle->calculate_md5 != 0 ) )
 	{
-#if defined( HAVE_VERBOSE_OUTPUT )
-		if( libcnotify_verbose != 0 )
+		if( md5_context_set_state(
+		     verification_handle->md5_context,
+		     restart_checkpoint->md5_state,
+		     MD5_CONTEXT_STATE_SIZE,
+		     error ) != 1 )
 		{
-			libcnotify_print_error_backtrace(
-			 error );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set MD5 state.",
+			 function );
+
+			goto on_error;
 		}
-#endif
-		libcerror_error_free(
-		 &error );
+	}
+	if( result != 0 )
+	{
+		*hashed_offset = (off64_t) restart_checkpoint->hashed_offset;
+	}
+	if( restart_checkpoint_free(
+	     &restart_checkpoint,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free restart checkpoint.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( restart_checkpoint != NULL )
+	{
+		restart_checkpoint_free(
+		 &restart_checkpoint,
+		 NULL );
 	}
 	return( -1 );
 }
 
-/* Prepares a storage media buffer for verification
- * Callback function for the process thread pool
- * Returns 1 if successful or -1 on error
+/* Writes a restart checkpoint that contains the state of the integrity hash(es)
+ * The hashed offset is the offset up to which the media data was passed to the integrity hash(es)
+ * The checkpoint is appended to the restart checkpoint file when append is set,
+ * otherwise the file is replaced
+ * Returns 1 if successful, 0 if the state of the integrity hash(es) cannot be stored or -1 on error
  */
-int verification_handle_output_storage_media_buffer_callback(
-     storage_media_buffer_t *storage_media_buffer,
-     verification_handle_t *verification_handle )
+int verification_handle_write_restart_checkpoint(
+     verification_handle_t *verification_handle,
+     off64_t hashed_offset,
+     uint8_t append,
+     libcerror_error_t **error )
 {
-	libcdata_list_element_t *element      = NULL;
-	libcdata_list_element_t *next_element = NULL;
-        libcerror_error_t *error              = NULL;
-	uint8_t *data                         = NULL;
-        static char *function                 = "verification_handle_process_storage_media_buffer_callback";
-	size_t data_size                      = 0;
+	restart_checkpoint_t *restart_checkpoint = NULL;
+	static char *function                    = "verification_handle_write_restart_checkpoint";
+	int result                               = 0;
 
 	if( verification_handle == NULL )
 	{
 		libcerror_error_set(
-		 &error,
+		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
 		 "%s: invalid verification handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( storage_media_buffer == NULL )
+	if( verification_handle->restart_checkpoint_filename == NULL )
 	{
 		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid storage media buffer.",
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid verification handle - missing restart checkpoint filename.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libcdata_list_insert_value(
-	     verification_handle->output_list,
-	     (intptr_t *) storage_media_buffer,
-	     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &storage_media_buffer_compare,
-	     LIBCDATA_INSERT_FLAG_UNIQUE_ENTRIES,
-	     &error ) != 1 )
+	if( hashed_offset < 0 )
 	{
 		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to insert storage media buffer into output list.",
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid hashed offset value less than zero.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	storage_media_buffer = NULL;
-
-	if( libcdata_list_get_first_element(
-	     verification_handle->output_list,
-	     &element,
-	     &error ) != 1 )
+	if( restart_checkpoint_initialize(
+	     &restart_checkpoint,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
-		 &error,
+		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create restart checkpoint.",
 		 function );
 
 		goto on_error;
 	}
-	while( element != NULL )
+	restart_checkpoint->acquiry_offset = 0;
+	restart_checkpoint->acquiry_size   = (uint64_t) verification_handle->media_size;
+	restart_checkpoint->hashed_offset  = (uint64_t) hashed_offset;
+
+	result = 1;
+
+	if( verification_handle->calculate_sha1 != 0 )
 	{
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     &error ) != 1 )
+		result = sha1_context_get_state(
+		          verification_handle->sha1_context,
+		          restart_checkpoint->sha1_state,
+		          SHA1_CONTEXT_STATE_SIZE,
+		          error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
-			 &error,
+			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
+			 "%s: unable to retrieve SHA1 state.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
-		if( storage_media_buffer == NULL )
+		else if( result != 0 )
+		{
+			restart_checkpoint->flags |= RESTART_CHECKPOINT_FLAG_HAS_SHA1_STATE;
+		}
+	}
+	if( ( result != 0 )
+	 && ( verification_handle->calculate_sha256 != 0 ) )
+	{
+		result = sha256_context_get_state(
+		          verification_handle->sha256_context,
+		          restart_checkpoint->sha256_state,
+		          SHA256_CONTEXT_STATE_SIZE,
+		          error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
-			 &error,
+			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve SHA256 state.",
 			 function );
 
 			goto on_error;
 		}
-		if( storage_media_buffer->storage_media_offset != verification_handle->last_offset_hashed )
+		else if( result != 0 )
 		{
-			break;
+			restart_checkpoint->flags |= RESTART_CHECKPOINT_FLAG_HAS_SHA256_STATE;
 		}
-		if( storage_media_buffer_get_data(
-		     storage_media_buffer,
-		     &data,
-		     &data_size,
-		     &error ) != 1 )
+	}
+	if( ( result != 0 )
+	 && ( verification_handle->calculate_md5 != 0 ) )
+	{
+		if( md5_context_get_state(
+		     verification_handle->md5_context,
+		     restart_checkpoint->md5_state,
+		     MD5_CONTEXT_STATE_SIZE,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
-			 &error,
+			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine storage media buffer data.",
+			 "%s: unable to retrieve MD5 state.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
-		if( verification_handle_update_integrity_hash(
-		     verification_handle,
-		     data,
-		     storage_media_buffer->processed_size,
-		     &error ) != 1 )
+		restart_checkpoint->flags |= RESTART_CHECKPOINT_FLAG_HAS_MD5_STATE;
+	}
+	if( result != 0 )
+	{
+		if( restart_checkpoint_write_file(
+		     restart_checkpoint,
+		     verification_handle->restart_checkpoint_filename,
+		     append,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to update integrity hash(es).",
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write restart checkpoint file.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
-		verification_handle->last_offset_hashed = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
+	}
+	if( restart_checkpoint_free(
+	     &restart_checkpoint,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free restart checkpoint.",
+		 function );
 
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     &error ) != 1 )
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( restart_checkpoint != NULL )
+	{
+		restart_checkpoint_free(
+		 &restart_checkpoint,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes a restart checkpoint when the hashed media data passed the next restart checkpoint offset
+ * This function should be called by the thread that updates the integrity hash(es)
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_update_restart_checkpoint(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error )
+{
+	static char *function              = "verification_handle_update_restart_checkpoint";
+	uint32_t number_of_checksum_errors = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( verification_handle->write_restart_checkpoints == 0 )
+	 || ( verification_handle->last_offset_hashed < verification_handle->next_restart_checkpoint_offset )
+	 || ( (size64_t) verification_handle->last_offset_hashed >= verification_handle->media_size ) )
+	{
+		return( 1 );
+	}
+	if( libewf_handle_get_number_of_checksum_errors(
+	     verification_handle->input_handle,
+	     &number_of_checksum_errors,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve the number of checksum errors.",
+		 function );
+
+		return( -1 );
+	}
+	/* The checksum errors are tracked by the input handle and are not part of
+	 * the restart checkpoint, hence no further checkpoints are written after
+	 * a checksum error so that a resumed verification reads the corrupted data again
+	 */
+	if( number_of_checksum_errors != 0 )
+	{
+		verification_handle->write_restart_checkpoints = 0;
+
+		return( 1 );
+	}
+	if( verification_handle_write_restart_checkpoint(
+	     verification_handle,
+	     verification_handle->last_offset_hashed,
+	     1,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write restart checkpoint.",
+		 function );
+
+		return( -1 );
+	}
+	verification_handle->next_restart_checkpoint_offset = verification_handle->last_offset_hashed + RESTART_CHECKPOINT_DEFAULT_INTERVAL;
+
+	return( 1 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Prepares a storage media buffer for verification
+ * Callback function for the process thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_process_storage_media_buffer_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     verification_handle_t *verification_handle )
+{
+        libcerror_error_t *error      = NULL;
+        static char *function         = "verification_handle_process_storage_media_buffer_callback";
+	ssize_t process_count         = 0;
+	ssize_t read_count            = 0;
+	int64_t stats_start_timestamp = 0;
+
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle->read_in_process_threads != 0 )
+	{
+		/* The storage media buffers are read in any order by the process threads
+		 * and put back in order by the output thread
+		 */
+		if( verification_handle->stats_output != NULL )
 		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
-			 function );
+			if( ewftools_timestamp_get_monotonic(
+			     &stats_start_timestamp,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve statistics start timestamp.",
+				 function );
 
-			storage_media_buffer = NULL;
+				goto on_error;
+			}
+		}
+		read_count = storage_media_buffer_read_from_handle_at_offset(
+		              storage_media_buffer,
+		              verification_handle->input_handle,
+		              storage_media_buffer->requested_size,
+		              storage_media_buffer->storage_media_offset,
+		              &error );
+
+		if( ( verification_handle->stats_output != NULL )
+		 && ( read_count > 0 ) )
+		{
+			if( stats_output_add_stage(
+			     verification_handle->stats_output,
+			     STATS_OUTPUT_STAGE_READ,
+			     (size64_t) read_count,
+			     stats_start_timestamp,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to add read to statistics output.",
+				 function );
 
-			goto on_error;
+				goto on_error;
+			}
 		}
-		if( libcdata_list_remove_element(
-		     verification_handle->output_list,
-		     element,
-		     &error ) != 1 )
+		if( read_count <= 0 )
 		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
-			 function );
+#if defined( HAVE_VERBOSE_OUTPUT )
+			if( ( libcnotify_verbose != 0 )
+			 && ( error != NULL ) )
+			{
+				libcnotify_print_error_backtrace(
+				 error );
+			}
+#endif
+			libcerror_error_free(
+			 &error );
 
-			storage_media_buffer = NULL;
+			/* Data that cannot be read is hashed as zero bytes so that the output
+			 * thread does not wait on it, the integrity hash will then mismatch
+			 */
+			if( memory_set(
+			     storage_media_buffer->raw_buffer,
+			     0,
+			     storage_media_buffer->requested_size ) == NULL )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear storage media buffer.",
+				 function );
 
-			goto on_error;
+				goto on_error;
+			}
+			storage_media_buffer->raw_buffer_data_size = storage_media_buffer->requested_size;
 		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
+	}
+	if( verification_handle->stats_output != NULL )
+	{
+		if( ewftools_timestamp_get_monotonic(
+		     &stats_start_timestamp,
 		     &error ) != 1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve statistics start timestamp.",
 			 function );
 
 			goto on_error;
 		}
-		element = next_element;
+	}
+	process_count = storage_media_buffer_read_process(
+			 storage_media_buffer,
+			 &error );
 
-		if( storage_media_buffer_queue_release_buffer(
-		     verification_handle->storage_media_buffer_queue,
-		     storage_media_buffer,
+	if( process_count < 0 )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+
+		process_count = verification_handle->chunk_size;
+
+		/* Append a read error
+		 */
+		if( verification_handle_append_read_error(
+		     verification_handle,
+		     storage_media_buffer->storage_media_offset,
+		     (size_t) verification_handle->chunk_size,
 		     &error ) != 1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append read error.",
 			 function );
 
 			goto on_error;
 		}
-		storage_media_buffer = NULL;
-
-		if( process_status_update(
-		     verification_handle->process_status,
-		     verification_handle->last_offset_hashed,
-		     verification_handle->media_size,
+	}
+	if( verification_handle->stats_output != NULL )
+	{
+		if( stats_output_add_stage(
+		     verification_handle->stats_output,
+		     STATS_OUTPUT_STAGE_PROCESS,
+		     (size64_t) process_count,
+		     stats_start_timestamp,
 		     &error ) != 1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update process status.",
+			 "%s: unable to add process to statistics output.",
 			 function );
 
 			goto on_error;
 		}
 	}
+	if( libcthreads_thread_pool_push_sorted(
+	     verification_handle->output_thread_pool,
+	     (intptr_t *) storage_media_buffer,
+	     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &storage_media_buffer_compare,
+	     LIBCTHREADS_SORT_FLAG_UNIQUE_VALUES,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push storage media buffer onto output thread pool queue.",
+		 function );
+
+		goto on_error;
+	}
+	storage_media_buffer = NULL;
+
 	return( 1 );
 
 on_error:
@@ -1453,215 +2101,526 @@ on_error:
 	return( -1 );
 }
 
-/* Empties the output list
+/* Prepares a storage media buffer for verification
+ * Callback function for the process thread pool
  * Returns 1 if successful or -1 on error
  */
-int verification_handle_empty_output_list(
-     verification_handle_t *verification_handle,
-     libcerror_error_t **error )
+int verification_handle_output_storage_media_buffer_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     verification_handle_t *verification_handle )
 {
-	libcdata_list_element_t *element             = NULL;
-	libcdata_list_element_t *next_element        = NULL;
-	storage_media_buffer_t *storage_media_buffer = NULL;
-        static char *function                        = "verification_handle_empty_output_list";
-
-	if( verification_handle == NULL )
+	libcdata_list_element_t *element      = NULL;
+	libcdata_list_element_t *next_element = NULL;
+        libcerror_error_t *error              = NULL;
+	uint8_t *data                         = NULL;
+        static char *function                 = "verification_handle_process_storage_media_buffer_callback";
+	size_t data_size                      = 0;
+	int number_of_pending_buffers         = 0;
+
+	if( verification_handle == NULL )
 	{
 		libcerror_error_set(
-		 error,
+		 &error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
 		 "%s: invalid verification handle.",
 		 function );
 
-		return( -1 );
+		goto on_error;
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_list_insert_value(
+	     verification_handle->output_list,
+	     (intptr_t *) storage_media_buffer,
+	     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &storage_media_buffer_compare,
+	     LIBCDATA_INSERT_FLAG_UNIQUE_ENTRIES,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to insert storage media buffer into output list.",
+		 function );
+
+		goto on_error;
 	}
+	storage_media_buffer = NULL;
+
 	if( libcdata_list_get_first_element(
 	     verification_handle->output_list,
 	     &element,
-	     error ) != 1 )
+	     &error ) != 1 )
 	{
 		libcerror_error_set(
-		 error,
+		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
 		 "%s: unable to retrieve first element.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 	while( element != NULL )
 	{
 		if( libcdata_list_element_get_value(
 		     element,
 		     (intptr_t **) &storage_media_buffer,
-		     error ) != 1 )
+		     &error ) != 1 )
 		{
 			libcerror_error_set(
-			 error,
+			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
 			 "%s: unable to retrieve value from list element.",
 			 function );
 
-			return( -1 );
+			storage_media_buffer = NULL;
+
+			goto on_error;
 		}
 		if( storage_media_buffer == NULL )
 		{
 			libcerror_error_set(
-			 error,
+			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
 			 "%s: missing storage media buffer.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
-		if( storage_media_buffer_queue_release_buffer(
-		     verification_handle->storage_media_buffer_queue,
+		if( storage_media_buffer->storage_media_offset != verification_handle->last_offset_hashed )
+		{
+			break;
+		}
+		if( storage_media_buffer_get_data(
 		     storage_media_buffer,
-		     error ) != 1 )
+		     &data,
+		     &data_size,
+		     &error ) != 1 )
 		{
 			libcerror_error_set(
-			 error,
+			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
+			 "%s: unable to determine storage media buffer data.",
 			 function );
 
-			return( -1 );
+			storage_media_buffer = NULL;
+
+			goto on_error;
 		}
-		storage_media_buffer = NULL;
+		if( verification_handle_update_integrity_hash(
+		     verification_handle,
+		     data,
+		     storage_media_buffer->processed_size,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to update integrity hash(es).",
+			 function );
+
+			storage_media_buffer = NULL;
+
+			goto on_error;
+		}
+		verification_handle->last_offset_hashed = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
+
+		if( verification_handle_update_restart_checkpoint(
+		     verification_handle,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update restart checkpoint.",
+			 function );
+
+			storage_media_buffer = NULL;
 
+			goto on_error;
+		}
 		if( libcdata_list_element_get_next_element(
 		     element,
 		     &next_element,
-		     error ) != 1 )
+		     &error ) != 1 )
 		{
 			libcerror_error_set(
-			 error,
+			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
 			 "%s: unable to retrieve next list element.",
 			 function );
 
-			return( -1 );
+			storage_media_buffer = NULL;
+
+			goto on_error;
 		}
 		if( libcdata_list_remove_element(
 		     verification_handle->output_list,
 		     element,
-		     error ) != 1 )
+		     &error ) != 1 )
 		{
 			libcerror_error_set(
-			 error,
+			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
 			 "%s: unable to remove list element from output list.",
 			 function );
 
-			return( -1 );
+			storage_media_buffer = NULL;
+
+			goto on_error;
 		}
 		/* The output list no longer manages the list element and the storage media buffer it contains
 		 */
 		if( libcdata_list_element_free(
 		     &element,
 		     NULL,
-		     error ) != 1 )
+		     &error ) != 1 )
 		{
 			libcerror_error_set(
-			 error,
+			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
 			 "%s: unable to free list element.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
 		element = next_element;
-	}
-	return( 1 );
-}
 
-#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+		if( storage_media_buffer_queue_release_buffer(
+		     verification_handle->storage_media_buffer_queue,
+		     storage_media_buffer,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to release storage media buffer onto queue.",
+			 function );
 
-/* Verifies the input
- * Returns 1 if successful, 0 if not or -1 on error
- */
-int verification_handle_verify_input(
-     verification_handle_t *verification_handle,
-     uint8_t print_status_information,
-     log_handle_t *log_handle,
-     libcerror_error_t **error )
-{
-	storage_media_buffer_t *storage_media_buffer = NULL;
-	uint8_t *data                                = NULL;
-	static char *function                        = "verification_handle_verify_input";
-	off64_t storage_media_offset                 = 0;
-	size64_t remaining_media_size                = 0;
-	size_t data_size                             = 0;
-	size_t process_buffer_size                   = 0;
-	size_t read_size                             = 0;
-	ssize_t process_count                        = 0;
-	ssize_t read_count                           = 0;
-	uint32_t number_of_checksum_errors           = 0;
-	uint8_t storage_media_buffer_mode            = 0;
-	int is_corrupted                             = 0;
-	int maximum_number_of_queued_items           = 0;
-	int md5_hash_compare                         = 0;
-	int sha1_hash_compare                        = 0;
-	int sha256_hash_compare                      = 0;
-	int status                                   = PROCESS_STATUS_COMPLETED;
+			goto on_error;
+		}
+		storage_media_buffer = NULL;
 
-	if( verification_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid verification handle.",
-		 function );
+		if( process_status_update(
+		     verification_handle->process_status,
+		     verification_handle->last_offset_hashed,
+		     verification_handle->media_size,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update process status.",
+			 function );
 
-		return( -1 );
+			goto on_error;
+		}
 	}
-	if( verification_handle->chunk_size == 0 )
+	/* The storage media buffer that ended the loop remains in the output list
+	 */
+	storage_media_buffer = NULL;
+
+	/* The buffers that remain in the output list wait on the buffer with the next offset
+	 */
+	if( libcdata_list_get_number_of_elements(
+	     verification_handle->output_list,
+	     &number_of_pending_buffers,
+	     &error ) != 1 )
 	{
 		libcerror_error_set(
-		 error,
+		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing chunk size.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of pending buffers.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( verification_handle->chunk_size > (size32_t) INT32_MAX )
+	if( storage_media_buffer_queue_update_output_stall(
+	     verification_handle->storage_media_buffer_queue,
+	     number_of_pending_buffers,
+	     &error ) != 1 )
 	{
 		libcerror_error_set(
-		 error,
+		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid chunk size value exceeds maximum.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update output stall.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( verification_handle->process_buffer_size > (size_t) SSIZE_MAX )
+	return( 1 );
+
+on_error:
+	if( storage_media_buffer != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid process buffer size value exceeds maximum.",
-		 function );
+		if( storage_media_buffer_queue_release_buffer(
+		     verification_handle->storage_media_buffer_queue,
+		     storage_media_buffer,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to release storage media buffer onto queue.",
+			 function );
 
-		return( -1 );
+			storage_media_buffer_free(
+			 &storage_media_buffer,
+			 NULL );
+		}
 	}
-#if !defined( HAVE_MULTI_THREAD_SUPPORT )
-	if( verification_handle->number_of_threads != 0 )
+	if( error != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Empties the output list
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_empty_output_list(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error )
+{
+	libcdata_list_element_t *element             = NULL;
+	libcdata_list_element_t *next_element        = NULL;
+	storage_media_buffer_t *storage_media_buffer = NULL;
+        static char *function                        = "verification_handle_empty_output_list";
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_list_get_first_element(
+	     verification_handle->output_list,
+	     &element,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve first element.",
+		 function );
+
+		return( -1 );
+	}
+	while( element != NULL )
+	{
+		if( libcdata_list_element_get_value(
+		     element,
+		     (intptr_t **) &storage_media_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve value from list element.",
+			 function );
+
+			return( -1 );
+		}
+		if( storage_media_buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing storage media buffer.",
+			 function );
+
+			return( -1 );
+		}
+		if( storage_media_buffer_queue_release_buffer(
+		     verification_handle->storage_media_buffer_queue,
+		     storage_media_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to release storage media buffer onto queue.",
+			 function );
+
+			return( -1 );
+		}
+		storage_media_buffer = NULL;
+
+		if( libcdata_list_element_get_next_element(
+		     element,
+		     &next_element,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next list element.",
+			 function );
+
+			return( -1 );
+		}
+		if( libcdata_list_remove_element(
+		     verification_handle->output_list,
+		     element,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove list element from output list.",
+			 function );
+
+			return( -1 );
+		}
+		/* The output list no longer manages the list element and the storage media buffer it contains
+		 */
+		if( libcdata_list_element_free(
+		     &element,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free list element.",
+			 function );
+
+			return( -1 );
+		}
+		element = next_element;
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Verifies the input
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int verification_handle_verify_input(
+     verification_handle_t *verification_handle,
+     uint8_t print_status_information,
+     log_handle_t *log_handle,
+     libcerror_error_t **error )
+{
+	storage_media_buffer_t *storage_media_buffer = NULL;
+	uint8_t *data                                = NULL;
+	static char *function                        = "verification_handle_verify_input";
+	off64_t restart_checkpoint_offset            = 0;
+	off64_t storage_media_offset                 = 0;
+	size64_t remaining_media_size                = 0;
+	size_t data_size                             = 0;
+	size_t process_buffer_size                   = 0;
+	size_t read_size                             = 0;
+	ssize_t process_count                        = 0;
+	ssize_t read_count                           = 0;
+	int64_t stats_start_timestamp                = 0;
+	uint32_t number_of_checksum_errors           = 0;
+	uint8_t storage_media_buffer_mode            = 0;
+	int is_corrupted                             = 0;
+	int initial_number_of_queued_items           = 0;
+	int maximum_number_of_queued_items           = 0;
+	int md5_hash_compare                         = 0;
+	int result                                   = 0;
+	int sha1_hash_compare                        = 0;
+	int sha256_hash_compare                      = 0;
+	int status                                   = PROCESS_STATUS_COMPLETED;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->chunk_size > (size32_t) INT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->process_buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid process buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->number_of_threads != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
 		 "%s: multi-threading not supported.",
 		 function );
@@ -1700,10 +2659,60 @@ int verification_handle_verify_input(
 		}
 		storage_media_buffer_mode = STORAGE_MEDIA_BUFFER_MODE_BUFFERED;
 	}
+	if( verification_handle->use_huge_pages != 0 )
+	{
+		if( libewf_handle_set_use_huge_pages(
+		     verification_handle->input_handle,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set use huge pages.",
+			 function );
+
+			goto on_error;
+		}
+	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
+	verification_handle->read_in_process_threads = 0;
+
 	if( verification_handle->number_of_threads != 0 )
 	{
-		maximum_number_of_queued_items = 1 + ( ( 512 * 1024 * 1024 ) / process_buffer_size );
+		/* In buffered mode the process threads read the data at their offset
+		 * so that reads of multiple chunks and segment files are issued in parallel
+		 */
+		if( storage_media_buffer_mode == STORAGE_MEDIA_BUFFER_MODE_BUFFERED )
+		{
+			verification_handle->read_in_process_threads = 1;
+		}
+		if( storage_media_buffer_queue_get_maximum_number_of_buffers(
+		     0,
+		     process_buffer_size,
+		     verification_handle->number_of_threads + 1,
+		     &maximum_number_of_queued_items,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine maximum number of queued items.",
+			 function );
+
+			goto on_error;
+		}
+		/* The storage media buffer queue starts with a few buffers per process thread
+		 * and grows, up to the maximum number of queued items, when the output is stalled
+		 */
+		initial_number_of_queued_items = 4 * verification_handle->number_of_threads;
+
+		if( initial_number_of_queued_items > maximum_number_of_queued_items )
+		{
+			initial_number_of_queued_items = maximum_number_of_queued_items;
+		}
 
 		if( libcthreads_thread_pool_create(
 		     &( verification_handle->process_thread_pool ),
@@ -1757,9 +2766,12 @@ int verification_handle_verify_input(
 		if( storage_media_buffer_queue_initialize(
 		     &( verification_handle->storage_media_buffer_queue ),
 		     verification_handle->input_handle,
+		     NULL,
+		     initial_number_of_queued_items,
 		     maximum_number_of_queued_items,
 		     storage_media_buffer_mode,
 		     process_buffer_size,
+		     verification_handle->use_huge_pages,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -1771,6 +2783,23 @@ int verification_handle_verify_input(
 
 			goto on_error;
 		}
+		if( verification_handle->stats_output != NULL )
+		{
+			if( stats_output_set_storage_media_buffer_queue(
+			     verification_handle->stats_output,
+			     verification_handle->storage_media_buffer_queue,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set storage media buffer queue in statistics output.",
+				 function );
+
+				goto on_error;
+			}
+		}
 	}
 #endif
 	if( verification_handle_initialize_integrity_hash(
@@ -1786,6 +2815,92 @@ int verification_handle_verify_input(
 
 		goto on_error;
 	}
+	verification_handle->last_offset_hashed        = 0;
+	verification_handle->write_restart_checkpoints = 0;
+
+	if( verification_handle->restart_checkpoint_filename != NULL )
+	{
+		if( verification_handle->resume != 0 )
+		{
+			result = verification_handle_read_restart_checkpoint(
+			          verification_handle,
+			          &restart_checkpoint_offset,
+			          error );
+
+			if( result == -1 )
+			{
+#if defined( HAVE_VERBOSE_OUTPUT )
+				libcnotify_print_error_backtrace(
+				 *error );
+#endif
+				libcerror_error_free(
+				 error );
+			}
+			if( result != 1 )
+			{
+				fprintf(
+				 verification_handle->notify_stream,
+				 "Unable to use restart checkpoint - verifying all data.\n" );
+			}
+			else if( restart_checkpoint_offset > 0 )
+			{
+				if( libewf_handle_seek_offset(
+				     verification_handle->input_handle,
+				     restart_checkpoint_offset,
+				     SEEK_SET,
+				     error ) == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_SEEK_FAILED,
+					 "%s: unable to seek offset: %" PRIi64 " in input handle.",
+					 function,
+					 restart_checkpoint_offset );
+
+					goto on_error;
+				}
+				fprintf(
+				 verification_handle->notify_stream,
+				 "Resuming verification at offset: %" PRIi64 ".\n",
+				 restart_checkpoint_offset );
+
+				storage_media_offset                    = restart_checkpoint_offset;
+				verification_handle->last_offset_hashed = restart_checkpoint_offset;
+			}
+		}
+		/* The initial restart checkpoint replaces the restart checkpoint file, which removes
+		 * the restart checkpoints of a previous verification beyond the resume point
+		 */
+		result = verification_handle_write_restart_checkpoint(
+		          verification_handle,
+		          storage_media_offset,
+		          0,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write restart checkpoint.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 verification_handle->notify_stream,
+			 "Restart checkpoints are not supported for the digest types - checkpoints disabled.\n" );
+		}
+		else
+		{
+			verification_handle->next_restart_checkpoint_offset = storage_media_offset + RESTART_CHECKPOINT_DEFAULT_INTERVAL;
+			verification_handle->write_restart_checkpoints      = 1;
+		}
+	}
 	if( process_status_initialize(
 	     &( verification_handle->process_status ),
 	     _SYSTEM_STRING( "Verify" ),
@@ -1804,6 +2919,23 @@ int verification_handle_verify_input(
 
 		goto on_error;
 	}
+	if( verification_handle->stats_output != NULL )
+	{
+		if( process_status_set_stats_output(
+		     verification_handle->process_status,
+		     verification_handle->stats_output,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set statistics output in process status.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( process_status_start(
 	     verification_handle->process_status,
 	     error ) != 1 )
@@ -1836,7 +2968,7 @@ int verification_handle_verify_input(
 			goto on_error;
 		}
 	}
-	remaining_media_size = verification_handle->media_size;
+	remaining_media_size = verification_handle->media_size - (size64_t) storage_media_offset;
 
 	while( remaining_media_size > 0 )
 	{
@@ -1880,12 +3012,61 @@ int verification_handle_verify_input(
 		{
 			read_size = (size_t) remaining_media_size;
 		}
-		read_count = storage_media_buffer_read_from_handle(
-		              storage_media_buffer,
-		              verification_handle->input_handle,
-		              read_size,
-		              error );
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( verification_handle->read_in_process_threads != 0 )
+		{
+			/* The data is read by the process thread
+			 */
+			storage_media_buffer->requested_size = read_size;
+
+			read_count = (ssize_t) read_size;
+		}
+		else
+#endif
+		{
+			if( verification_handle->stats_output != NULL )
+			{
+				if( ewftools_timestamp_get_monotonic(
+				     &stats_start_timestamp,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve statistics start timestamp.",
+					 function );
 
+					goto on_error;
+				}
+			}
+			read_count = storage_media_buffer_read_from_handle(
+			              storage_media_buffer,
+			              verification_handle->input_handle,
+			              read_size,
+			              error );
+
+			if( ( verification_handle->stats_output != NULL )
+			 && ( read_count > 0 ) )
+			{
+				if( stats_output_add_stage(
+				     verification_handle->stats_output,
+				     STATS_OUTPUT_STAGE_READ,
+				     (size64_t) read_count,
+				     stats_start_timestamp,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to add read to statistics output.",
+					 function );
+
+					goto on_error;
+				}
+			}
+		}
 		if( read_count < 0 )
 		{
 			libcerror_error_set(
@@ -1935,6 +3116,22 @@ int verification_handle_verify_input(
 		else
 #endif
 		{
+			if( verification_handle->stats_output != NULL )
+			{
+				if( ewftools_timestamp_get_monotonic(
+				     &stats_start_timestamp,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve statistics start timestamp.",
+					 function );
+
+					goto on_error;
+				}
+			}
 			process_count = storage_media_buffer_read_process(
 			                 storage_media_buffer,
 		        	         error );
@@ -1972,6 +3169,25 @@ int verification_handle_verify_input(
 					goto on_error;
 				}
 			}
+			if( verification_handle->stats_output != NULL )
+			{
+				if( stats_output_add_stage(
+				     verification_handle->stats_output,
+				     STATS_OUTPUT_STAGE_PROCESS,
+				     (size64_t) process_count,
+				     stats_start_timestamp,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to add process to statistics output.",
+					 function );
+
+					goto on_error;
+				}
+			}
 			if( storage_media_buffer_get_data(
 			     storage_media_buffer,
 			     &data,
@@ -2004,6 +3220,19 @@ int verification_handle_verify_input(
 			}
 			verification_handle->last_offset_hashed += (off64_t) process_count;
 
+			if( verification_handle_update_restart_checkpoint(
+			     verification_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update restart checkpoint.",
+				 function );
+
+				goto on_error;
+			}
 			if( process_status_update(
 			     verification_handle->process_status,
 			     verification_handle->last_offset_hashed,
@@ -2102,6 +3331,23 @@ int verification_handle_verify_input(
 	}
 	if( verification_handle->storage_media_buffer_queue != NULL )
 	{
+		if( verification_handle->stats_output != NULL )
+		{
+			if( stats_output_set_storage_media_buffer_queue(
+			     verification_handle->stats_output,
+			     NULL,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set storage media buffer queue in statistics output.",
+				 function );
+
+				goto on_error;
+			}
+		}
 		if( storage_media_buffer_queue_free(
 		     &( verification_handle->storage_media_buffer_queue ),
 		     error ) != 1 )
@@ -2382,6 +3628,13 @@ on_error:
 	}
 	if( verification_handle->storage_media_buffer_queue != NULL )
 	{
+		if( verification_handle->stats_output != NULL )
+		{
+			stats_output_set_storage_media_buffer_queue(
+			 verification_handle->stats_output,
+			 NULL,
+			 NULL );
+		}
 		storage_media_buffer_queue_free(
 		 &( verification_handle->storage_media_buffer_queue ),
 		 NULL );
@@ -2390,19 +3643,28 @@ on_error:
 	return( -1 );
 }
 
-/* Verifies single files
- * Returns 1 if successful, 0 if not or -1 on error
+/* Verifies a range of the media data using the range digests
+ * The range is read using the concurrent read function so that multiple
+ * ranges can be verified at the same time
+ * Returns 1 if the digest of the range matches, 0 if not or -1 on error
  */
-int verification_handle_verify_single_files(
+int verification_handle_verify_range(
      verification_handle_t *verification_handle,
-     uint8_t print_status_information,
-     log_handle_t *log_handle,
+     uint8_t *buffer,
+     size_t buffer_size,
+     uint64_t range_index,
      libcerror_error_t **error )
 {
-	libewf_file_entry_t *file_entry    = NULL;
-	static char *function              = "verification_handle_verify_single_files";
-	uint32_t number_of_checksum_errors = 0;
-	int result                         = 0;
+	uint8_t calculated_digest[ RANGE_DIGESTS_DIGEST_SIZE ];
+	uint8_t stored_digest[ RANGE_DIGESTS_DIGEST_SIZE ];
+
+	sha256_context_t *sha256_context = NULL;
+	static char *function            = "verification_handle_verify_range";
+	off64_t range_offset             = 0;
+	size64_t range_size              = 0;
+	size_t read_size                 = 0;
+	ssize_t read_count               = 0;
+	int result                       = 1;
 
 	if( verification_handle == NULL )
 	{
@@ -2415,180 +3677,196 @@ int verification_handle_verify_single_files(
 
 		return( -1 );
 	}
-	if( libewf_handle_get_root_file_entry(
-	     verification_handle->input_handle,
-	     &file_entry,
-	     error ) != 1 )
+	if( buffer == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve root file entry.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( process_status_initialize(
-	     &( verification_handle->process_status ),
-	     _SYSTEM_STRING( "Verify" ),
-	     _SYSTEM_STRING( "verified" ),
-	     _SYSTEM_STRING( "Read" ),
-	     verification_handle->notify_stream,
-	     print_status_information,
-	     error ) != 1 )
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create process status.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( process_status_start(
-	     verification_handle->process_status,
+	if( range_digests_get_range(
+	     verification_handle->range_digests,
+	     range_index,
+	     &range_offset,
+	     &range_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to start process status.",
-		 function );
-
-		goto on_error;
-	}
-	result = verification_handle_verify_file_entry(
-	          verification_handle,
-	          file_entry,
-	          _SYSTEM_STRING( "" ),
-	          0,
-	          log_handle,
-	          error );
-
-	if( result == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GENERIC,
-		 "%s: unable to verify root file entry.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve range: %" PRIu64 ".",
+		 function,
+		 range_index );
 
 		goto on_error;
 	}
-	if( process_status_stop(
-	     verification_handle->process_status,
-	     0,
-	     PROCESS_STATUS_COMPLETED,
+	if( range_digests_get_digest(
+	     verification_handle->range_digests,
+	     range_index,
+	     stored_digest,
+	     RANGE_DIGESTS_DIGEST_SIZE,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to stop process status.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve digest of range: %" PRIu64 ".",
+		 function,
+		 range_index );
 
 		goto on_error;
 	}
-	if( process_status_free(
-	     &( verification_handle->process_status ),
+	if( sha256_context_initialize(
+	     &sha256_context,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free process status.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize SHA256 context.",
 		 function );
 
 		goto on_error;
 	}
-	if( libewf_file_entry_free(
-	     &file_entry,
-	     error ) != 1 )
+	while( range_size > 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free root file entry.",
-		 function );
+		if( verification_handle->abort != 0 )
+		{
+			break;
+		}
+		read_size = buffer_size;
 
-		goto on_error;
-	}
-	if( libewf_handle_get_number_of_checksum_errors(
-	     verification_handle->input_handle,
-	     &number_of_checksum_errors,
-	     error ) == -1 )
+		if( range_size < (size64_t) read_size )
+		{
+			read_size = (size_t) range_size;
+		}
+		read_count = libewf_handle_read_buffer_at_offset_concurrent(
+		              verification_handle->input_handle,
+		              buffer,
+		              read_size,
+		              range_offset,
+		              error );
+
+		/* A range that cannot be read is considered not to match
+		 */
+		if( read_count <= 0 )
+		{
+#if defined( HAVE_VERBOSE_OUTPUT )
+			if( ( libcnotify_verbose != 0 )
+			 && ( error != NULL )
+			 && ( *error != NULL ) )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+#endif
+			libcerror_error_free(
+			 error );
+
+			result = 0;
+
+			break;
+		}
+		if( sha256_context_update(
+		     sha256_context,
+		     buffer,
+		     (size_t) read_count,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA256 context.",
+			 function );
+
+			goto on_error;
+		}
+		range_offset += (off64_t) read_count;
+		range_size   -= (size64_t) read_count;
+	}
+	if( sha256_context_finalize(
+	     sha256_context,
+	     calculated_digest,
+	     RANGE_DIGESTS_DIGEST_SIZE,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve the number of checksum errors.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize SHA256 context.",
 		 function );
 
-		return( -1 );
+		goto on_error;
+	}
+	if( sha256_context_free(
+	     &sha256_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free SHA256 context.",
+		 function );
+
+		goto on_error;
 	}
 	if( ( result != 0 )
-	 && ( number_of_checksum_errors == 0 ) )
+	 && ( memory_compare(
+	       calculated_digest,
+	       stored_digest,
+	       RANGE_DIGESTS_DIGEST_SIZE ) != 0 ) )
 	{
-		return( 1 );
+		result = 0;
 	}
-	return( 0 );
+	return( result );
 
 on_error:
-	if( verification_handle->process_status != NULL )
-	{
-		process_status_stop(
-		 verification_handle->process_status,
-		 0,
-		 PROCESS_STATUS_FAILED,
-		 NULL );
-		process_status_free(
-		 &( verification_handle->process_status ),
-		 NULL );
-	}
-	if( file_entry != NULL )
+	if( sha256_context != NULL )
 	{
-		libewf_file_entry_free(
-		 &file_entry,
+		sha256_context_free(
+		 &sha256_context,
 		 NULL );
 	}
 	return( -1 );
 }
 
-/* Verifies a (single) file entry
- * Returns 1 if successful, 0 if not or -1 on error
+/* Reads a range of the media data to validate the checksums of its chunks
+ * The chunks that fail validation are recorded as checksum errors in the input handle
+ * Returns 1 if successful or -1 on error
  */
-int verification_handle_verify_file_entry(
+int verification_handle_read_range(
      verification_handle_t *verification_handle,
-     libewf_file_entry_t *file_entry,
-     const system_character_t *file_entry_path,
-     size_t file_entry_path_length,
-     log_handle_t *log_handle,
+     uint8_t *buffer,
+     size_t buffer_size,
+     off64_t range_offset,
+     size64_t range_size,
      libcerror_error_t **error )
 {
-	system_character_t *name        = NULL;
-	system_character_t *target_path = NULL;
-	uint8_t *file_entry_data        = NULL;
-	static char *function           = "verification_handle_verify_file_entry";
-	size64_t file_entry_data_size   = 0;
-	size_t name_size                = 0;
-	size_t process_buffer_size      = 0;
-	size_t read_size                = 0;
-	size_t target_path_size         = 0;
-	ssize_t read_count              = 0;
-	uint8_t file_entry_type         = 0;
-	int md5_hash_compare            = 0;
-	int result                      = 0;
-	int return_value                = 0;
-	int sha1_hash_compare           = 0;
-	int sha256_hash_compare         = 0;
+	static char *function = "verification_handle_read_range";
+	size_t read_size      = 0;
+	ssize_t read_count    = 0;
 
 	if( verification_handle == NULL )
 	{
@@ -2601,113 +3879,4382 @@ int verification_handle_verify_file_entry(
 
 		return( -1 );
 	}
-	if( verification_handle->chunk_size == 0 )
+	if( buffer == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing chunk size.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
 		 function );
 
 		return( -1 );
 	}
-	if( verification_handle->chunk_size > (size32_t) INT32_MAX )
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid chunk size value exceeds maximum.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( verification_handle->process_buffer_size > (size_t) SSIZE_MAX )
+	while( range_size > 0 )
+	{
+		if( verification_handle->abort != 0 )
+		{
+			break;
+		}
+		read_size = buffer_size;
+
+		if( range_size < (size64_t) read_size )
+		{
+			read_size = (size_t) range_size;
+		}
+		read_count = libewf_handle_read_buffer_at_offset_concurrent(
+		              verification_handle->input_handle,
+		              buffer,
+		              read_size,
+		              range_offset,
+		              error );
+
+		if( read_count <= 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data at offset: %" PRIi64 ".",
+			 function,
+			 range_offset );
+
+			return( -1 );
+		}
+		if( verification_handle->report_damaged_chunks != 0 )
+		{
+			if( verification_handle_report_damaged_chunks(
+			     verification_handle,
+			     range_offset,
+			     (size64_t) read_count,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to report damaged chunks at offset: %" PRIi64 ".",
+				 function,
+				 range_offset );
+
+				return( -1 );
+			}
+		}
+		if( verification_handle->rate_limiter != NULL )
+		{
+			if( rate_limiter_consume(
+			     verification_handle->rate_limiter,
+			     (size_t) read_count,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to limit read rate.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		range_offset += (off64_t) read_count;
+		range_size   -= (size64_t) read_count;
+	}
+	return( 1 );
+}
+
+/* Reports the damaged chunks in the data that was read as soon as they are found
+ * The checksum errors of the input are clamped to the data that was read, such that
+ * every damaged sector is only reported by the range worker that read it
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_report_damaged_chunks(
+     verification_handle_t *verification_handle,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	static char *function       = "verification_handle_report_damaged_chunks";
+	uint64_t end_sector         = 0;
+	uint64_t error_end_sector   = 0;
+	uint64_t error_start_sector = 0;
+	uint64_t first_chunk_index  = 0;
+	uint64_t first_sector       = 0;
+	uint64_t last_chunk_index   = 0;
+	uint64_t number_of_sectors  = 0;
+	uint64_t start_sector       = 0;
+	uint32_t error_index        = 0;
+	uint32_t number_of_errors   = 0;
+	int result                  = 1;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( verification_handle->bytes_per_sector == 0 )
+	 || ( verification_handle->chunk_size == 0 ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid process buffer size value exceeds maximum.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid verification handle - missing bytes per sector or chunk size.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libewf_file_entry_get_utf16_name_size(
-		  file_entry,
-		  &name_size,
-		  error );
-#else
-	result = libewf_file_entry_get_utf8_name_size(
-		  file_entry,
-		  &name_size,
-		  error );
-#endif
-	if( result != 1 )
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_get_number_of_checksum_errors(
+	     verification_handle->input_handle,
+	     &number_of_errors,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve the name.",
+		 "%s: unable to retrieve the number of checksum errors.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( name_size > 0 )
+	if( number_of_errors == 0 )
 	{
-		name = system_string_allocate(
-			name_size );
+		return( 1 );
+	}
+	first_sector = (uint64_t) offset / verification_handle->bytes_per_sector;
+	end_sector   = ( (uint64_t) offset + size + verification_handle->bytes_per_sector - 1 )
+	             / verification_handle->bytes_per_sector;
 
-		if( name == NULL )
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->ranges_mutex != NULL )
+	{
+		if( libcthreads_mutex_grab(
+		     verification_handle->ranges_mutex,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-			 "%s: unable to create name.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab ranges mutex.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-		result = libewf_file_entry_get_utf16_name(
-			  file_entry,
-			  (uint16_t *) name,
-			  name_size,
-			  error );
-#else
-		result = libewf_file_entry_get_utf8_name(
-			  file_entry,
-			  (uint8_t *) name,
-			  name_size,
-			  error );
+	}
 #endif
-		if( result != 1 )
+	for( error_index = 0;
+	     error_index < number_of_errors;
+	     error_index++ )
+	{
+		if( libewf_handle_get_checksum_error(
+		     verification_handle->input_handle,
+		     error_index,
+		     &error_start_sector,
+		     &number_of_sectors,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve the name.",
-			 function );
+			 "%s: unable to retrieve the checksum error: %" PRIu32 ".",
+			 function,
+			 error_index );
 
-			memory_free(
-			 name );
+			result = -1;
 
-			goto on_error;
+			break;
 		}
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-		if( libcpath_path_join_wide(
-		     &target_path,
-		     &target_path_size,
-		     file_entry_path,
-		     file_entry_path_length,
-		     name,
-		     name_size - 1,
-		     error ) != 1 )
+		error_end_sector = error_start_sector + number_of_sectors;
+
+		if( ( error_end_sector <= first_sector )
+		 || ( error_start_sector >= end_sector ) )
+		{
+			continue;
+		}
+		start_sector = error_start_sector;
+
+		if( start_sector < first_sector )
+		{
+			start_sector = first_sector;
+		}
+		if( error_end_sector > end_sector )
+		{
+			error_end_sector = end_sector;
+		}
+		number_of_sectors = error_end_sector - start_sector;
+
+		first_chunk_index = ( start_sector * verification_handle->bytes_per_sector )
+		                  / verification_handle->chunk_size;
+		last_chunk_index  = ( ( error_end_sector * verification_handle->bytes_per_sector ) - 1 )
+		                  / verification_handle->chunk_size;
+
+		fprintf(
+		 verification_handle->notify_stream,
+		 "Damaged chunk(s): %" PRIu64 " - %" PRIu64 " at sector(s): %" PRIu64 " - %" PRIu64 " (number: %" PRIu64 ")\n",
+		 first_chunk_index,
+		 last_chunk_index,
+		 start_sector,
+		 error_end_sector - 1,
+		 number_of_sectors );
+
+		if( verification_handle->damaged_chunks_log_handle != NULL )
+		{
+			log_handle_printf(
+			 verification_handle->damaged_chunks_log_handle,
+			 "Damaged chunk(s): %" PRIu64 " - %" PRIu64 " at sector(s): %" PRIu64 " - %" PRIu64 " (number: %" PRIu64 ")\n",
+			 first_chunk_index,
+			 last_chunk_index,
+			 start_sector,
+			 error_end_sector - 1,
+			 number_of_sectors );
+		}
+		verification_handle->number_of_damaged_sectors += number_of_sectors;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->ranges_mutex != NULL )
+	{
+		if( libcthreads_mutex_release(
+		     verification_handle->ranges_mutex,
+		     NULL ) != 1 )
+		{
+			if( result == 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release ranges mutex.",
+				 function );
+			}
+			result = -1;
+		}
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves a range of the media data that is verified by the range workers
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_get_range(
+     verification_handle_t *verification_handle,
+     uint64_t range_index,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_handle_get_range";
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->range_digests != NULL )
+	{
+		if( range_digests_get_range(
+		     verification_handle->range_digests,
+		     range_index,
+		     range_offset,
+		     range_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve range: %" PRIu64 " from range digests.",
+			 function,
+			 range_index );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	if( verification_handle->range_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid verification handle - missing range size.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_index >= verification_handle->number_of_ranges )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid range index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
+
+		return( -1 );
+	}
+	*range_offset = verification_handle->ranges_offset
+	              + (off64_t) ( range_index * verification_handle->range_size );
+	*range_size   = verification_handle->media_size - (size64_t) *range_offset;
+
+	if( *range_size > verification_handle->range_size )
+	{
+		*range_size = verification_handle->range_size;
+	}
+	return( 1 );
+}
+
+/* Compares a range of the media data of the input with that of the compared image
+ * The range is compared per data chunk if the chunk sizes of both images match,
+ * in which case only the chunks of which the packed data differs are unpacked
+ * Returns 1 if the data of the range matches, 0 if not or -1 on error
+ */
+int verification_handle_compare_range(
+     verification_handle_t *verification_handle,
+     verification_handle_range_worker_t *range_worker,
+     off64_t range_offset,
+     size64_t range_size,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_handle_compare_range";
+	size_t read_size      = 0;
+	ssize_t compare_count = 0;
+	ssize_t read_count    = 0;
+	int is_identical      = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( range_worker->input_handle == NULL )
+	 || ( range_worker->compare_handle == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid range worker - missing input or compare handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( range_worker->buffer == NULL )
+	 || ( range_worker->compare_buffer == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid range worker - missing buffers.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->compare_data_chunks != 0 )
+	{
+		if( libewf_handle_seek_offset(
+		     range_worker->input_handle,
+		     range_offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset: %" PRIi64 " in input handle.",
+			 function,
+			 range_offset );
+
+			return( -1 );
+		}
+		if( libewf_handle_seek_offset(
+		     range_worker->compare_handle,
+		     range_offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset: %" PRIi64 " in compare handle.",
+			 function,
+			 range_offset );
+
+			return( -1 );
+		}
+	}
+	while( range_size > 0 )
+	{
+		if( verification_handle->abort != 0 )
+		{
+			break;
+		}
+		compare_count = 0;
+		is_identical  = 0;
+
+		if( verification_handle->compare_data_chunks != 0 )
+		{
+			read_count = libewf_handle_read_data_chunk(
+			              range_worker->input_handle,
+			              range_worker->input_data_chunk,
+			              error );
+
+			if( read_count > 0 )
+			{
+				compare_count = libewf_handle_read_data_chunk(
+				                 range_worker->compare_handle,
+				                 range_worker->compare_data_chunk,
+				                 error );
+			}
+			if( ( read_count > 0 )
+			 && ( compare_count == read_count ) )
+			{
+				is_identical = libewf_data_chunk_compare_packed_data(
+				                range_worker->input_data_chunk,
+				                range_worker->compare_data_chunk,
+				                error );
+
+				if( is_identical == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GENERIC,
+					 "%s: unable to compare packed data of chunk at offset: %" PRIi64 ".",
+					 function,
+					 range_offset );
+
+					return( -1 );
+				}
+				else if( is_identical != 0 )
+				{
+					range_worker->number_of_identical_packed_chunks += 1;
+				}
+				else
+				{
+					/* The packed data differs, for example due to a different
+					 * compression level, hence the chunks are unpacked
+					 */
+					read_count = libewf_data_chunk_read_buffer(
+					              range_worker->input_data_chunk,
+					              range_worker->buffer,
+					              range_worker->buffer_size,
+					              error );
+
+					if( read_count > 0 )
+					{
+						compare_count = libewf_data_chunk_read_buffer(
+						                 range_worker->compare_data_chunk,
+						                 range_worker->compare_buffer,
+						                 range_worker->buffer_size,
+						                 error );
+					}
+				}
+			}
+		}
+		else
+		{
+			read_size = range_worker->buffer_size;
+
+			if( range_size < (size64_t) read_size )
+			{
+				read_size = (size_t) range_size;
+			}
+			read_count = libewf_handle_read_buffer_at_offset(
+			              range_worker->input_handle,
+			              range_worker->buffer,
+			              read_size,
+			              range_offset,
+			              error );
+
+			if( read_count > 0 )
+			{
+				compare_count = libewf_handle_read_buffer_at_offset(
+				                 range_worker->compare_handle,
+				                 range_worker->compare_buffer,
+				                 read_size,
+				                 range_offset,
+				                 error );
+			}
+		}
+		/* A range that cannot be read is considered not to match
+		 */
+		if( ( read_count <= 0 )
+		 || ( compare_count != read_count ) )
+		{
+#if defined( HAVE_VERBOSE_OUTPUT )
+			if( ( libcnotify_verbose != 0 )
+			 && ( error != NULL )
+			 && ( *error != NULL ) )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+#endif
+			libcerror_error_free(
+			 error );
+
+			return( 0 );
+		}
+		if( ( is_identical == 0 )
+		 && ( memory_compare(
+		       range_worker->buffer,
+		       range_worker->compare_buffer,
+		       (size_t) read_count ) != 0 ) )
+		{
+			return( 0 );
+		}
+		if( (size64_t) read_count > range_size )
+		{
+			read_count = (ssize_t) range_size;
+		}
+		range_offset += (off64_t) read_count;
+		range_size   -= (size64_t) read_count;
+	}
+	return( 1 );
+}
+
+/* Opens the values of a range worker used to compare ranges
+ * The input and compare handles are cloned so that the range workers
+ * can read the media data independently of each other
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_range_worker_open_compare(
+     verification_handle_range_worker_t *range_worker,
+     libcerror_error_t **error )
+{
+	verification_handle_t *verification_handle = NULL;
+	static char *function                      = "verification_handle_range_worker_open_compare";
+
+	if( range_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range worker.",
+		 function );
+
+		return( -1 );
+	}
+	verification_handle = range_worker->verification_handle;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid range worker - missing verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_worker->buffer_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid range worker - missing buffer size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_clone(
+	     &( range_worker->input_handle ),
+	     verification_handle->input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to clone input handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_clone(
+	     &( range_worker->compare_handle ),
+	     verification_handle->compare_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to clone compare handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle->compare_data_chunks != 0 )
+	{
+		if( libewf_handle_get_data_chunk(
+		     range_worker->input_handle,
+		     &( range_worker->input_data_chunk ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve input data chunk.",
+			 function );
+
+			goto on_error;
+		}
+		if( libewf_handle_get_data_chunk(
+		     range_worker->compare_handle,
+		     &( range_worker->compare_data_chunk ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve compare data chunk.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	range_worker->compare_buffer = (uint8_t *) memory_allocate(
+	                                            sizeof( uint8_t ) * range_worker->buffer_size );
+
+	if( range_worker->compare_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create compare buffer.",
+		 function );
+
+		goto on_error;
+	}
+	range_worker->number_of_identical_packed_chunks = 0;
+
+	return( 1 );
+
+on_error:
+	verification_handle_range_worker_close_compare(
+	 range_worker,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Closes the values of a range worker used to compare ranges
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_range_worker_close_compare(
+     verification_handle_range_worker_t *range_worker,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_handle_range_worker_close_compare";
+	int result            = 1;
+
+	if( range_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range worker.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_worker->compare_buffer != NULL )
+	{
+		memory_free(
+		 range_worker->compare_buffer );
+
+		range_worker->compare_buffer = NULL;
+	}
+	if( range_worker->compare_data_chunk != NULL )
+	{
+		if( libewf_data_chunk_free(
+		     &( range_worker->compare_data_chunk ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free compare data chunk.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( range_worker->input_data_chunk != NULL )
+	{
+		if( libewf_data_chunk_free(
+		     &( range_worker->input_data_chunk ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input data chunk.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( range_worker->compare_handle != NULL )
+	{
+		if( libewf_handle_free(
+		     &( range_worker->compare_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free compare handle.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( range_worker->input_handle != NULL )
+	{
+		if( libewf_handle_free(
+		     &( range_worker->input_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input handle.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Verifies ranges until no ranges remain
+ * Callback function for the range worker threads
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_range_worker_function(
+     verification_handle_range_worker_t *range_worker )
+{
+	verification_handle_t *verification_handle = NULL;
+	libcerror_error_t *error                   = NULL;
+	static char *function                      = "verification_handle_range_worker_function";
+	off64_t range_offset                       = 0;
+	size64_t range_size                        = 0;
+	uint64_t range_index                       = 0;
+	int result                                 = 0;
+
+	if( range_worker == NULL )
+	{
+		return( -1 );
+	}
+	verification_handle = range_worker->verification_handle;
+
+	while( verification_handle->abort == 0 )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( verification_handle->ranges_mutex != NULL )
+		{
+			if( libcthreads_mutex_grab(
+			     verification_handle->ranges_mutex,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to grab ranges mutex.",
+				 function );
+
+				goto on_error;
+			}
+		}
+#endif
+		range_index = verification_handle->next_range_index;
+
+		if( range_index < verification_handle->number_of_ranges )
+		{
+			verification_handle->next_range_index += 1;
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( verification_handle->ranges_mutex != NULL )
+		{
+			if( libcthreads_mutex_release(
+			     verification_handle->ranges_mutex,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release ranges mutex.",
+				 function );
+
+				goto on_error;
+			}
+		}
+#endif
+		if( range_index >= verification_handle->number_of_ranges )
+		{
+			break;
+		}
+		if( verification_handle_get_range(
+		     verification_handle,
+		     range_index,
+		     &range_offset,
+		     &range_size,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve range: %" PRIu64 ".",
+			 function,
+			 range_index );
+
+			goto on_error;
+		}
+		if( verification_handle->compare_handle != NULL )
+		{
+			result = verification_handle_compare_range(
+			          verification_handle,
+			          range_worker,
+			          range_offset,
+			          range_size,
+			          &error );
+		}
+		else if( verification_handle->range_digests != NULL )
+		{
+			result = verification_handle_verify_range(
+			          verification_handle,
+			          range_worker->buffer,
+			          range_worker->buffer_size,
+			          range_index,
+			          &error );
+		}
+		else
+		{
+			result = verification_handle_read_range(
+			          verification_handle,
+			          range_worker->buffer,
+			          range_worker->buffer_size,
+			          range_offset,
+			          range_size,
+			          &error );
+		}
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to verify range: %" PRIu64 ".",
+			 function,
+			 range_index );
+
+			goto on_error;
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( verification_handle->ranges_mutex != NULL )
+		{
+			if( libcthreads_mutex_grab(
+			     verification_handle->ranges_mutex,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to grab ranges mutex.",
+				 function );
+
+				goto on_error;
+			}
+		}
+#endif
+		if( result == 0 )
+		{
+			verification_handle->mismatched_ranges[ range_index ] = 1;
+
+			verification_handle->number_of_mismatched_ranges += 1;
+		}
+		verification_handle->verified_ranges_size += range_size;
+
+		result = process_status_update(
+		          verification_handle->process_status,
+		          (size64_t) verification_handle->ranges_offset + verification_handle->verified_ranges_size,
+		          verification_handle->media_size,
+		          &error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( verification_handle->ranges_mutex != NULL )
+		{
+			if( libcthreads_mutex_release(
+			     verification_handle->ranges_mutex,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release ranges mutex.",
+				 function );
+
+				goto on_error;
+			}
+		}
+#endif
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update process status.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	range_worker->result = 1;
+
+	return( 1 );
+
+on_error:
+#if defined( HAVE_VERBOSE_OUTPUT )
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+	}
+#endif
+	libcerror_error_free(
+	 &error );
+
+	range_worker->result = -1;
+
+	return( -1 );
+}
+
+/* Runs the range workers until all ranges have been verified
+ * A range worker is started per thread
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_run_range_workers(
+     verification_handle_t *verification_handle,
+     size_t buffer_size,
+     uint8_t print_status_information,
+     libcerror_error_t **error )
+{
+	verification_handle_range_worker_t *range_workers = NULL;
+	static char *function                              = "verification_handle_run_range_workers";
+	int number_of_range_workers                        = 1;
+	int range_worker_index                             = 0;
+	int result                                         = 0;
+	int status                                         = PROCESS_STATUS_COMPLETED;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	verification_handle->next_range_index                  = 0;
+	verification_handle->verified_ranges_size              = 0;
+	verification_handle->number_of_identical_packed_chunks = 0;
+
+	if( verification_handle->number_of_threads > 1 )
+	{
+		number_of_range_workers = verification_handle->number_of_threads;
+
+		if( (uint64_t) number_of_range_workers > verification_handle->number_of_ranges )
+		{
+			number_of_range_workers = (int) verification_handle->number_of_ranges;
+		}
+		if( number_of_range_workers == 0 )
+		{
+			number_of_range_workers = 1;
+		}
+	}
+	range_workers = (verification_handle_range_worker_t *) memory_allocate(
+	                                                        sizeof( verification_handle_range_worker_t ) * number_of_range_workers );
+
+	if( range_workers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create range workers.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     range_workers,
+	     0,
+	     sizeof( verification_handle_range_worker_t ) * number_of_range_workers ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear range workers.",
+		 function );
+
+		memory_free(
+		 range_workers );
+
+		range_workers = NULL;
+
+		goto on_error;
+	}
+	for( range_worker_index = 0;
+	     range_worker_index < number_of_range_workers;
+	     range_worker_index++ )
+	{
+		range_workers[ range_worker_index ].verification_handle = verification_handle;
+		range_workers[ range_worker_index ].buffer_size         = buffer_size;
+		range_workers[ range_worker_index ].buffer              = (uint8_t *) memory_allocate(
+		                                                                       sizeof( uint8_t ) * buffer_size );
+
+		if( range_workers[ range_worker_index ].buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffer of range worker: %d.",
+			 function,
+			 range_worker_index );
+
+			goto on_error;
+		}
+		if( verification_handle->compare_handle != NULL )
+		{
+			if( verification_handle_range_worker_open_compare(
+			     &( range_workers[ range_worker_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to open compare values of range worker: %d.",
+				 function,
+				 range_worker_index );
+
+				goto on_error;
+			}
+		}
+	}
+	if( verification_handle->compare_handle != NULL )
+	{
+		result = process_status_initialize(
+		          &( verification_handle->process_status ),
+		          _SYSTEM_STRING( "Compare" ),
+		          _SYSTEM_STRING( "compared" ),
+		          _SYSTEM_STRING( "Read" ),
+		          verification_handle->notify_stream,
+		          print_status_information,
+		          error );
+	}
+	else if( verification_handle->report_damaged_chunks != 0 )
+	{
+		result = process_status_initialize(
+		          &( verification_handle->process_status ),
+		          _SYSTEM_STRING( "Scrub" ),
+		          _SYSTEM_STRING( "scrubbed" ),
+		          _SYSTEM_STRING( "Read" ),
+		          verification_handle->notify_stream,
+		          print_status_information,
+		          error );
+	}
+	else
+	{
+		result = process_status_initialize(
+		          &( verification_handle->process_status ),
+		          _SYSTEM_STRING( "Verify" ),
+		          _SYSTEM_STRING( "verified" ),
+		          _SYSTEM_STRING( "Read" ),
+		          verification_handle->notify_stream,
+		          print_status_information,
+		          error );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle->stats_output != NULL )
+	{
+		if( process_status_set_stats_output(
+		     verification_handle->process_status,
+		     verification_handle->stats_output,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set statistics output in process status.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( process_status_start(
+	     verification_handle->process_status,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to start process status.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( number_of_range_workers > 1 )
+	{
+		if( libcthreads_mutex_initialize(
+		     &( verification_handle->ranges_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create ranges mutex.",
+			 function );
+
+			goto on_error;
+		}
+		for( range_worker_index = 0;
+		     range_worker_index < number_of_range_workers;
+		     range_worker_index++ )
+		{
+			if( libcthreads_thread_create(
+			     &( range_workers[ range_worker_index ].thread ),
+			     NULL,
+			     (int (*)(void *)) &verification_handle_range_worker_function,
+			     (void *) &( range_workers[ range_worker_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create thread of range worker: %d.",
+				 function,
+				 range_worker_index );
+
+				goto on_error;
+			}
+		}
+		for( range_worker_index = 0;
+		     range_worker_index < number_of_range_workers;
+		     range_worker_index++ )
+		{
+			if( libcthreads_thread_join(
+			     &( range_workers[ range_worker_index ].thread ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread of range worker: %d.",
+				 function,
+				 range_worker_index );
+
+				goto on_error;
+			}
+		}
+		if( libcthreads_mutex_free(
+		     &( verification_handle->ranges_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free ranges mutex.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+#endif
+	{
+		verification_handle_range_worker_function(
+		 &( range_workers[ 0 ] ) );
+	}
+	for( range_worker_index = 0;
+	     range_worker_index < number_of_range_workers;
+	     range_worker_index++ )
+	{
+		if( range_workers[ range_worker_index ].result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: range worker: %d failed.",
+			 function,
+			 range_worker_index );
+
+			goto on_error;
+		}
+		if( verification_handle->compare_handle != NULL )
+		{
+			verification_handle->number_of_identical_packed_chunks += range_workers[ range_worker_index ].number_of_identical_packed_chunks;
+
+			if( verification_handle_range_worker_close_compare(
+			     &( range_workers[ range_worker_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to close compare values of range worker: %d.",
+				 function,
+				 range_worker_index );
+
+				goto on_error;
+			}
+		}
+		memory_free(
+		 range_workers[ range_worker_index ].buffer );
+
+		range_workers[ range_worker_index ].buffer = NULL;
+	}
+	memory_free(
+	 range_workers );
+
+	range_workers = NULL;
+
+	if( verification_handle->abort != 0 )
+	{
+		status = PROCESS_STATUS_ABORTED;
+	}
+	if( process_status_stop(
+	     verification_handle->process_status,
+	     verification_handle->verified_ranges_size,
+	     status,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to stop process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( process_status_free(
+	     &( verification_handle->process_status ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free process status.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( range_workers != NULL )
+	{
+		/* Signal the range workers to stop before they are joined
+		 */
+		verification_handle->abort = 1;
+
+		for( range_worker_index = 0;
+		     range_worker_index < number_of_range_workers;
+		     range_worker_index++ )
+		{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+			if( range_workers[ range_worker_index ].thread != NULL )
+			{
+				libcthreads_thread_join(
+				 &( range_workers[ range_worker_index ].thread ),
+				 NULL );
+			}
+#endif
+			verification_handle_range_worker_close_compare(
+			 &( range_workers[ range_worker_index ] ),
+			 NULL );
+
+			if( range_workers[ range_worker_index ].buffer != NULL )
+			{
+				memory_free(
+				 range_workers[ range_worker_index ].buffer );
+			}
+		}
+		memory_free(
+		 range_workers );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->ranges_mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &( verification_handle->ranges_mutex ),
+		 NULL );
+	}
+#endif
+	if( verification_handle->process_status != NULL )
+	{
+		process_status_stop(
+		 verification_handle->process_status,
+		 verification_handle->verified_ranges_size,
+		 PROCESS_STATUS_FAILED,
+		 NULL );
+		process_status_free(
+		 &( verification_handle->process_status ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Verifies the ranges of the input using the range digests in a file
+ * The ranges are verified in parallel by a range worker per thread
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int verification_handle_verify_ranges(
+     verification_handle_t *verification_handle,
+     const system_character_t *range_digests_filename,
+     uint8_t print_status_information,
+     log_handle_t *log_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_handle_verify_ranges";
+	size_t buffer_size    = 0;
+	int result            = 1;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->range_digests != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid verification handle - range digests value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->process_buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid process buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->number_of_threads != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: multi-threading not supported.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libewf_handle_get_media_size(
+	     verification_handle->input_handle,
+	     &( verification_handle->media_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( range_digests_read_file(
+	     &( verification_handle->range_digests ),
+	     range_digests_filename,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read range digests file.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle->range_digests->media_size != verification_handle->media_size )
+	{
+		fprintf(
+		 verification_handle->notify_stream,
+		 "Media size of range digests: %" PRIu64 " does not match media size: %" PRIu64 ".\n",
+		 verification_handle->range_digests->media_size,
+		 verification_handle->media_size );
+
+		if( log_handle != NULL )
+		{
+			log_handle_printf(
+			 log_handle,
+			 "Media size of range digests: %" PRIu64 " does not match media size: %" PRIu64 ".\n",
+			 verification_handle->range_digests->media_size,
+			 verification_handle->media_size );
+		}
+		if( range_digests_free(
+		     &( verification_handle->range_digests ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free range digests.",
+			 function );
+
+			goto on_error;
+		}
+		return( 0 );
+	}
+	verification_handle->number_of_ranges = verification_handle->range_digests->number_of_ranges;
+	verification_handle->range_size       = verification_handle->range_digests->range_size;
+
+	verification_handle->mismatched_ranges = (uint8_t *) memory_allocate(
+	                                                      sizeof( uint8_t ) * (size_t) verification_handle->number_of_ranges );
+
+	if( verification_handle->mismatched_ranges == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create mismatched ranges.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     verification_handle->mismatched_ranges,
+	     0,
+	     sizeof( uint8_t ) * (size_t) verification_handle->number_of_ranges ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear mismatched ranges.",
+		 function );
+
+		goto on_error;
+	}
+	verification_handle->number_of_mismatched_ranges = 0;
+
+	if( verification_handle->process_buffer_size == 0 )
+	{
+		buffer_size = verification_handle->chunk_size;
+	}
+	else
+	{
+		buffer_size = verification_handle->process_buffer_size;
+	}
+	if( verification_handle_run_range_workers(
+	     verification_handle,
+	     buffer_size,
+	     print_status_information,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to run range workers.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle->abort == 0 )
+	{
+		fprintf(
+		 verification_handle->notify_stream,
+		 "\n" );
+
+		if( verification_handle_mismatched_ranges_fprint(
+		     verification_handle,
+		     verification_handle->notify_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print mismatched ranges.",
+			 function );
+
+			goto on_error;
+		}
+		if( log_handle != NULL )
+		{
+			if( verification_handle_mismatched_ranges_fprint(
+			     verification_handle,
+			     log_handle->log_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print mismatched ranges in log handle.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	if( ( verification_handle->abort != 0 )
+	 || ( verification_handle->number_of_mismatched_ranges != 0 ) )
+	{
+		result = 0;
+	}
+	memory_free(
+	 verification_handle->mismatched_ranges );
+
+	verification_handle->mismatched_ranges = NULL;
+
+	if( range_digests_free(
+	     &( verification_handle->range_digests ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free range digests.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( verification_handle->mismatched_ranges != NULL )
+	{
+		memory_free(
+		 verification_handle->mismatched_ranges );
+
+		verification_handle->mismatched_ranges = NULL;
+	}
+	if( verification_handle->range_digests != NULL )
+	{
+		range_digests_free(
+		 &( verification_handle->range_digests ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Calculates the digest of the media data stored in a segment file
+ * The media data is also added to the integrity hash(es) if requested, which
+ * requires the segments to be digested in order
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_digest_segment(
+     verification_handle_t *verification_handle,
+     uint8_t *buffer,
+     size_t buffer_size,
+     off64_t media_offset,
+     size64_t media_size,
+     uint8_t update_integrity_hash,
+     uint8_t *digest,
+     size_t digest_size,
+     libcerror_error_t **error )
+{
+	sha256_context_t *sha256_context = NULL;
+	static char *function            = "verification_handle_digest_segment";
+	size_t read_size                 = 0;
+	ssize_t read_count               = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( sha256_context_initialize(
+	     &sha256_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize SHA256 context.",
+		 function );
+
+		goto on_error;
+	}
+	while( media_size > 0 )
+	{
+		if( verification_handle->abort != 0 )
+		{
+			break;
+		}
+		read_size = buffer_size;
+
+		if( media_size < (size64_t) read_size )
+		{
+			read_size = (size_t) media_size;
+		}
+		read_count = libewf_handle_read_buffer_at_offset(
+		              verification_handle->input_handle,
+		              buffer,
+		              read_size,
+		              media_offset,
+		              error );
+
+		if( read_count <= 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data at offset: %" PRIi64 ".",
+			 function,
+			 media_offset );
+
+			goto on_error;
+		}
+		if( sha256_context_update(
+		     sha256_context,
+		     buffer,
+		     (size_t) read_count,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA256 context.",
+			 function );
+
+			goto on_error;
+		}
+		if( update_integrity_hash != 0 )
+		{
+			if( verification_handle_update_integrity_hash(
+			     verification_handle,
+			     buffer,
+			     (size_t) read_count,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to update integrity hash(es).",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( verification_handle->rate_limiter != NULL )
+		{
+			if( rate_limiter_consume(
+			     verification_handle->rate_limiter,
+			     (size_t) read_count,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to limit read rate.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		media_offset += (off64_t) read_count;
+		media_size   -= (size64_t) read_count;
+
+		verification_handle->last_offset_hashed += (off64_t) read_count;
+
+		if( process_status_update(
+		     verification_handle->process_status,
+		     (size64_t) verification_handle->last_offset_hashed,
+		     verification_handle->verified_ranges_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update process status.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( sha256_context_finalize(
+	     sha256_context,
+	     digest,
+	     digest_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize SHA256 context.",
+		 function );
+
+		goto on_error;
+	}
+	if( sha256_context_free(
+	     &sha256_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free SHA256 context.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( sha256_context != NULL )
+	{
+		sha256_context_free(
+		 &sha256_context,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Verifies the input using a ledger of the results of the previous verification per segment file
+ * If the ledger is not available or no longer matches the segment files, all the media data
+ * is verified and the ledger is created. Otherwise only the segment files of which the identity
+ * (file size, modification time or section descriptors) changed and a random sample of the other
+ * segment files are read, and their digests are compared with the ledger. The digest (hash)
+ * of the media data is then carried forward from the ledger.
+ * The ledger is written when the verification is successful
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int verification_handle_verify_segments(
+     verification_handle_t *verification_handle,
+     system_character_t * const * filenames,
+     int number_of_filenames,
+     const system_character_t *ledger_filename,
+     int sample_percentage,
+     uint8_t print_status_information,
+     log_handle_t *log_handle,
+     libcerror_error_t **error )
+{
+	uint8_t combined_digest[ SEGMENT_LEDGER_DIGEST_SIZE ];
+	uint8_t segment_digest[ SEGMENT_LEDGER_DIGEST_SIZE ];
+
+	segment_ledger_segment_t *segment           = NULL;
+	segment_ledger_segment_t *stored_segment    = NULL;
+	segment_ledger_t *segment_ledger            = NULL;
+	segment_ledger_t *stored_segment_ledger     = NULL;
+	system_character_t **libewf_filenames       = NULL;
+	uint8_t *buffer                             = NULL;
+	uint8_t *selected_segments                  = NULL;
+	static char *function                       = "verification_handle_verify_segments";
+	off64_t media_offset                        = 0;
+	size64_t media_size                         = 0;
+	size_t buffer_size                          = 0;
+	size_t string_index                         = 0;
+	uint32_t number_of_changed_segments         = 0;
+	uint32_t number_of_checksum_errors          = 0;
+	uint32_t number_of_mismatched_segments      = 0;
+	uint32_t number_of_sampled_segments         = 0;
+	uint32_t number_of_segments                 = 0;
+	uint32_t segment_index                      = 0;
+	uint8_t is_incremental                      = 0;
+	int file_index                              = 0;
+	int is_corrupted                            = 0;
+	int md5_hash_compare                        = 0;
+	int result                                  = 0;
+	int status                                  = PROCESS_STATUS_COMPLETED;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->process_buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid process buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( filenames == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filenames.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_filenames <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of filenames.",
+		 function );
+
+		return( -1 );
+	}
+	if( ledger_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ledger filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( sample_percentage < 0 )
+	 || ( sample_percentage > 100 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid sample percentage value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* The segment files are resolved the same way as by verification_handle_open_input
+	 * so that the file index of a segment refers to its filename
+	 */
+	if( number_of_filenames == 1 )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libewf_glob_wide(
+		     filenames[ 0 ],
+		     system_string_length(
+		      filenames[ 0 ] ),
+		     LIBEWF_FORMAT_UNKNOWN,
+		     &libewf_filenames,
+		     &number_of_filenames,
+		     error ) != 1 )
+#else
+		if( libewf_glob(
+		     filenames[ 0 ],
+		     system_string_length(
+		      filenames[ 0 ] ),
+		     LIBEWF_FORMAT_UNKNOWN,
+		     &libewf_filenames,
+		     &number_of_filenames,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to resolve filename(s).",
+			 function );
+
+			goto on_error;
+		}
+		filenames = (system_character_t * const *) libewf_filenames;
+	}
+	if( libewf_handle_get_media_size(
+	     verification_handle->input_handle,
+	     &( verification_handle->media_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_number_of_segments(
+	     verification_handle->input_handle,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
+		 function );
+
+		goto on_error;
+	}
+	if( segment_ledger_initialize(
+	     &segment_ledger,
+	     number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment ledger.",
+		 function );
+
+		goto on_error;
+	}
+	segment_ledger->media_size = (uint64_t) verification_handle->media_size;
+	segment_ledger->chunk_size = verification_handle->chunk_size;
+
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+		segment = &( segment_ledger->segments[ segment_index ] );
+
+		if( libewf_handle_get_segment_media_range(
+		     verification_handle->input_handle,
+		     segment_index,
+		     &file_index,
+		     &media_offset,
+		     &media_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve media range of segment: %" PRIu32 ".",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		if( ( file_index < 0 )
+		 || ( file_index >= number_of_filenames ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid file index of segment: %" PRIu32 " value out of bounds.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		segment->media_offset = (uint64_t) media_offset;
+		segment->media_size   = (uint64_t) media_size;
+
+		if( segment_ledger_get_file_identity(
+		     filenames[ file_index ],
+		     segment,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine identity of segment file: %" PRIs_SYSTEM ".",
+			 function,
+			 filenames[ file_index ] );
+
+			goto on_error;
+		}
+	}
+	result = segment_ledger_read_file(
+	          &stored_segment_ledger,
+	          ledger_filename,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read segment ledger file.",
+		 function );
+
+		goto on_error;
+	}
+	/* The ledger only applies if the segment files still contain the same media ranges
+	 */
+	else if( result != 0 )
+	{
+		is_incremental = 1;
+
+		if( ( stored_segment_ledger->number_of_segments != number_of_segments )
+		 || ( stored_segment_ledger->media_size != segment_ledger->media_size )
+		 || ( stored_segment_ledger->chunk_size != segment_ledger->chunk_size )
+		 || ( ( verification_handle->calculate_md5 != 0 )
+		  &&  ( stored_segment_ledger->has_md5_hash == 0 ) ) )
+		{
+			is_incremental = 0;
+		}
+		for( segment_index = 0;
+		     ( is_incremental != 0 ) && ( segment_index < number_of_segments );
+		     segment_index++ )
+		{
+			if( ( stored_segment_ledger->segments[ segment_index ].media_offset != segment_ledger->segments[ segment_index ].media_offset )
+			 || ( stored_segment_ledger->segments[ segment_index ].media_size != segment_ledger->segments[ segment_index ].media_size ) )
+			{
+				is_incremental = 0;
+			}
+		}
+	}
+	selected_segments = (uint8_t *) memory_allocate(
+	                                 sizeof( uint8_t ) * (size_t) number_of_segments );
+
+	if( selected_segments == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create selected segments.",
+		 function );
+
+		goto on_error;
+	}
+	/* The sample differs per verification so that eventually all segment files are read
+	 */
+	if( ( is_incremental != 0 )
+	 && ( sample_percentage > 0 ) )
+	{
+		srand(
+		 (unsigned int) time(
+		  NULL ) );
+	}
+	verification_handle->verified_ranges_size = 0;
+
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+		segment = &( segment_ledger->segments[ segment_index ] );
+
+		selected_segments[ segment_index ] = 1;
+
+		if( is_incremental != 0 )
+		{
+			stored_segment = &( stored_segment_ledger->segments[ segment_index ] );
+
+			if( ( stored_segment->file_size != segment->file_size )
+			 || ( stored_segment->modification_time != segment->modification_time )
+			 || ( memory_compare(
+			       stored_segment->descriptors_digest,
+			       segment->descriptors_digest,
+			       SEGMENT_LEDGER_DIGEST_SIZE ) != 0 ) )
+			{
+				number_of_changed_segments++;
+			}
+			else if( ( sample_percentage > 0 )
+			      && ( ( rand() % 100 ) < sample_percentage ) )
+			{
+				number_of_sampled_segments++;
+			}
+			else
+			{
+				selected_segments[ segment_index ] = 0;
+			}
+		}
+		if( selected_segments[ segment_index ] != 0 )
+		{
+			verification_handle->verified_ranges_size += (size64_t) segment->media_size;
+		}
+	}
+	if( verification_handle->process_buffer_size == 0 )
+	{
+		buffer_size = verification_handle->chunk_size;
+	}
+	else
+	{
+		buffer_size = verification_handle->process_buffer_size;
+	}
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * buffer_size );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( is_incremental != 0 )
+	{
+		fprintf(
+		 verification_handle->notify_stream,
+		 "Re-verifying %" PRIu32 " changed and %" PRIu32 " sampled of %" PRIu32 " segment file(s) using ledger: %" PRIs_SYSTEM ".\n",
+		 number_of_changed_segments,
+		 number_of_sampled_segments,
+		 number_of_segments,
+		 ledger_filename );
+	}
+	else
+	{
+		fprintf(
+		 verification_handle->notify_stream,
+		 "Verifying all %" PRIu32 " segment file(s) to create ledger: %" PRIs_SYSTEM ".\n",
+		 number_of_segments,
+		 ledger_filename );
+
+		if( verification_handle_initialize_integrity_hash(
+		     verification_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize integrity hash(es).",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( process_status_initialize(
+	     &( verification_handle->process_status ),
+	     _SYSTEM_STRING( "Verify" ),
+	     _SYSTEM_STRING( "verified" ),
+	     _SYSTEM_STRING( "Read" ),
+	     verification_handle->notify_stream,
+	     print_status_information,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( process_status_start(
+	     verification_handle->process_status,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to start process status.",
+		 function );
+
+		goto on_error;
+	}
+	verification_handle->last_offset_hashed = 0;
+
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+		if( verification_handle->abort != 0 )
+		{
+			break;
+		}
+		segment = &( segment_ledger->segments[ segment_index ] );
+
+		if( selected_segments[ segment_index ] == 0 )
+		{
+			if( memory_copy(
+			     segment->media_digest,
+			     stored_segment_ledger->segments[ segment_index ].media_digest,
+			     SEGMENT_LEDGER_DIGEST_SIZE ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy media digest of segment: %" PRIu32 ".",
+				 function,
+				 segment_index );
+
+				goto on_error;
+			}
+			continue;
+		}
+		if( verification_handle_digest_segment(
+		     verification_handle,
+		     buffer,
+		     buffer_size,
+		     (off64_t) segment->media_offset,
+		     (size64_t) segment->media_size,
+		     (uint8_t) ( is_incremental == 0 ),
+		     segment_digest,
+		     SEGMENT_LEDGER_DIGEST_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to calculate digest of segment: %" PRIu32 ".",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		if( ( is_incremental != 0 )
+		 && ( memory_compare(
+		       segment_digest,
+		       stored_segment_ledger->segments[ segment_index ].media_digest,
+		       SEGMENT_LEDGER_DIGEST_SIZE ) != 0 ) )
+		{
+			fprintf(
+			 verification_handle->notify_stream,
+			 "Media data of segment: %" PRIu32 " at offset: %" PRIu64 " (size: %" PRIu64 ") does not match ledger.\n",
+			 segment_index + 1,
+			 segment->media_offset,
+			 segment->media_size );
+
+			if( log_handle != NULL )
+			{
+				log_handle_printf(
+				 log_handle,
+				 "Media data of segment: %" PRIu32 " at offset: %" PRIu64 " (size: %" PRIu64 ") does not match ledger.\n",
+				 segment_index + 1,
+				 segment->media_offset,
+				 segment->media_size );
+			}
+			number_of_mismatched_segments++;
+		}
+		if( memory_copy(
+		     segment->media_digest,
+		     segment_digest,
+		     SEGMENT_LEDGER_DIGEST_SIZE ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy media digest of segment: %" PRIu32 ".",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+	}
+	if( verification_handle->abort != 0 )
+	{
+		status = PROCESS_STATUS_ABORTED;
+	}
+	if( process_status_stop(
+	     verification_handle->process_status,
+	     (size64_t) verification_handle->last_offset_hashed,
+	     status,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to stop process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( process_status_free(
+	     &( verification_handle->process_status ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free process status.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 buffer );
+
+	buffer = NULL;
+
+	memory_free(
+	 selected_segments );
+
+	selected_segments = NULL;
+
+	if( verification_handle->abort != 0 )
+	{
+		result = 0;
+
+		goto on_abort;
+	}
+	if( segment_ledger_get_combined_digest(
+	     segment_ledger,
+	     combined_digest,
+	     SEGMENT_LEDGER_DIGEST_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve combined digest.",
+		 function );
+
+		goto on_error;
+	}
+	if( is_incremental == 0 )
+	{
+		if( verification_handle_finalize_integrity_hash(
+		     verification_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize integrity hash(es).",
+			 function );
+
+			goto on_error;
+		}
+		if( verification_handle->calculate_md5 != 0 )
+		{
+			for( string_index = 0;
+			     string_index < SEGMENT_LEDGER_MD5_HASH_STRING_SIZE;
+			     string_index++ )
+			{
+				segment_ledger->md5_hash_string[ string_index ] = (uint8_t) verification_handle->calculated_md5_hash_string[ string_index ];
+			}
+			segment_ledger->has_md5_hash = 1;
+		}
+	}
+	/* The digest (hash) of the media data is only carried forward from the ledger
+	 * when the digests of the segments combine into the same media data
+	 */
+	else if( memory_compare(
+	          combined_digest,
+	          stored_segment_ledger->combined_digest,
+	          SEGMENT_LEDGER_DIGEST_SIZE ) == 0 )
+	{
+		if( memory_copy(
+		     segment_ledger->md5_hash_string,
+		     stored_segment_ledger->md5_hash_string,
+		     SEGMENT_LEDGER_MD5_HASH_STRING_SIZE ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy MD5 hash string.",
+			 function );
+
+			goto on_error;
+		}
+		segment_ledger->has_md5_hash = stored_segment_ledger->has_md5_hash;
+
+		if( verification_handle->calculate_md5 != 0 )
+		{
+			for( string_index = 0;
+			     string_index < SEGMENT_LEDGER_MD5_HASH_STRING_SIZE;
+			     string_index++ )
+			{
+				verification_handle->calculated_md5_hash_string[ string_index ] = (system_character_t) segment_ledger->md5_hash_string[ string_index ];
+			}
+			verification_handle->calculated_md5_hash_string[ string_index ] = 0;
+		}
+	}
+	else if( verification_handle->calculate_md5 != 0 )
+	{
+		/* The digest (hash) cannot be carried forward, hence it is reported as not available
+		 */
+		if( system_string_copy(
+		     verification_handle->calculated_md5_hash_string,
+		     _SYSTEM_STRING( "N/A" ),
+		     4 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set calculated MD5 hash string.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( memory_copy(
+	     segment_ledger->combined_digest,
+	     combined_digest,
+	     SEGMENT_LEDGER_DIGEST_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy combined digest.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle_get_integrity_hash_from_input(
+	     verification_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve integrity hash(es) from input.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 verification_handle->notify_stream,
+	 "\n" );
+
+	if( verification_handle_checksum_errors_fprint(
+	     verification_handle,
+	     verification_handle->notify_stream,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print checksum errors.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle_hash_values_fprint(
+	     verification_handle,
+	     verification_handle->notify_stream,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print hash values.",
+		 function );
+
+		goto on_error;
+	}
+	if( is_incremental != 0 )
+	{
+		fprintf(
+		 verification_handle->notify_stream,
+		 "Segment files re-verified:\t\t%" PRIu32 " of %" PRIu32 " (%" PRIu32 " mismatched)\n",
+		 number_of_changed_segments + number_of_sampled_segments,
+		 number_of_segments,
+		 number_of_mismatched_segments );
+	}
+	fprintf(
+	 verification_handle->notify_stream,
+	 "\n" );
+
+	if( log_handle != NULL )
+	{
+		if( verification_handle_checksum_errors_fprint(
+		     verification_handle,
+		     log_handle->log_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print checksum errors in log handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( verification_handle_hash_values_fprint(
+		     verification_handle,
+		     log_handle->log_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print hash values in log handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( is_incremental != 0 )
+		{
+			log_handle_printf(
+			 log_handle,
+			 "Segment files re-verified:\t\t%" PRIu32 " of %" PRIu32 " (%" PRIu32 " mismatched)\n",
+			 number_of_changed_segments + number_of_sampled_segments,
+			 number_of_segments,
+			 number_of_mismatched_segments );
+		}
+	}
+	is_corrupted = libewf_handle_segment_files_corrupted(
+	                verification_handle->input_handle,
+	                error );
+
+	if( is_corrupted == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if segment files are corrupted.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_number_of_checksum_errors(
+	     verification_handle->input_handle,
+	     &number_of_checksum_errors,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve the number of checksum errors.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( verification_handle->calculate_md5 != 0 )
+	 && ( verification_handle->stored_md5_hash_available != 0 ) )
+	{
+		md5_hash_compare = system_string_compare(
+		                    verification_handle->stored_md5_hash_string,
+		                    verification_handle->calculated_md5_hash_string,
+		                    33 );
+	}
+	result = 0;
+
+	if( ( is_corrupted == 0 )
+	 && ( number_of_checksum_errors == 0 )
+	 && ( number_of_mismatched_segments == 0 )
+	 && ( md5_hash_compare == 0 ) )
+	{
+		result = 1;
+	}
+	/* Only the results of a successful verification are recorded in the ledger
+	 * so that a failed verification is repeated in full
+	 */
+	if( result == 1 )
+	{
+		if( segment_ledger_write_file(
+		     segment_ledger,
+		     ledger_filename,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write segment ledger file.",
+			 function );
+
+			goto on_error;
+		}
+	}
+on_abort:
+	if( stored_segment_ledger != NULL )
+	{
+		if( segment_ledger_free(
+		     &stored_segment_ledger,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free stored segment ledger.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( segment_ledger_free(
+	     &segment_ledger,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free segment ledger.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_filenames != NULL )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libewf_glob_wide_free(
+		     libewf_filenames,
+		     number_of_filenames,
+		     error ) != 1 )
+#else
+		if( libewf_glob_free(
+		     libewf_filenames,
+		     number_of_filenames,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free globbed filenames.",
+			 function );
+
+			libewf_filenames = NULL;
+
+			goto on_error;
+		}
+		libewf_filenames = NULL;
+	}
+	return( result );
+
+on_error:
+	if( verification_handle->process_status != NULL )
+	{
+		process_status_stop(
+		 verification_handle->process_status,
+		 (size64_t) verification_handle->last_offset_hashed,
+		 PROCESS_STATUS_FAILED,
+		 NULL );
+		process_status_free(
+		 &( verification_handle->process_status ),
+		 NULL );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	if( selected_segments != NULL )
+	{
+		memory_free(
+		 selected_segments );
+	}
+	if( stored_segment_ledger != NULL )
+	{
+		segment_ledger_free(
+		 &stored_segment_ledger,
+		 NULL );
+	}
+	if( segment_ledger != NULL )
+	{
+		segment_ledger_free(
+		 &segment_ledger,
+		 NULL );
+	}
+	if( libewf_filenames != NULL )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		libewf_glob_wide_free(
+		 libewf_filenames,
+		 number_of_filenames,
+		 NULL );
+#else
+		libewf_glob_free(
+		 libewf_filenames,
+		 number_of_filenames,
+		 NULL );
+#endif
+	}
+	return( -1 );
+}
+
+/* Verifies the checksums of the chunks of the input without calculating
+ * the digest (hash) of the media data
+ * The chunks are read in parallel by a range worker per thread, since no
+ * digest is calculated the ranges can be read in any order
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int verification_handle_verify_chunks(
+     verification_handle_t *verification_handle,
+     uint8_t print_status_information,
+     log_handle_t *log_handle,
+     libcerror_error_t **error )
+{
+	static char *function              = "verification_handle_verify_chunks";
+	size_t buffer_size                 = 0;
+	uint32_t number_of_checksum_errors = 0;
+	int is_corrupted                   = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->range_digests != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid verification handle - range digests value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->process_buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid process buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->number_of_threads != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: multi-threading not supported.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libewf_handle_get_media_size(
+	     verification_handle->input_handle,
+	     &( verification_handle->media_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		return( -1 );
+	}
+	/* The ranges are aligned with the chunks so that every chunk
+	 * is read and validated by a single range worker
+	 */
+	buffer_size = verification_handle->chunk_size;
+
+	if( verification_handle->process_buffer_size > buffer_size )
+	{
+		buffer_size = ( verification_handle->process_buffer_size / verification_handle->chunk_size )
+		            * verification_handle->chunk_size;
+	}
+	verification_handle->range_size       = (size64_t) buffer_size;
+	verification_handle->number_of_ranges = verification_handle->media_size / verification_handle->range_size;
+
+	if( ( verification_handle->media_size % verification_handle->range_size ) != 0 )
+	{
+		verification_handle->number_of_ranges += 1;
+	}
+	if( verification_handle_run_range_workers(
+	     verification_handle,
+	     buffer_size,
+	     print_status_information,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to run range workers.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->abort != 0 )
+	{
+		return( 0 );
+	}
+	fprintf(
+	 verification_handle->notify_stream,
+	 "\n" );
+
+	if( verification_handle_checksum_errors_fprint(
+	     verification_handle,
+	     verification_handle->notify_stream,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print checksum errors.",
+		 function );
+
+		return( -1 );
+	}
+	if( log_handle != NULL )
+	{
+		if( verification_handle_checksum_errors_fprint(
+		     verification_handle,
+		     log_handle->log_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print checksum errors in log handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	is_corrupted = libewf_handle_segment_files_corrupted(
+	                verification_handle->input_handle,
+	                error );
+
+	if( is_corrupted == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if segment files are corrupted.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_get_number_of_checksum_errors(
+	     verification_handle->input_handle,
+	     &number_of_checksum_errors,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve the number of checksum errors.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( is_corrupted != 0 )
+	 || ( number_of_checksum_errors != 0 ) )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Scrubs a slice of the media data of the input by validating the checksums of its chunks
+ * The slice starts at the scrub offset, which must be aligned with the chunks, and
+ * is read in parallel by a range worker per thread, damaged chunks are reported as
+ * soon as they are found
+ * Returns 1 if successful, 0 if aborted or -1 on error
+ */
+int verification_handle_scrub_chunks(
+     verification_handle_t *verification_handle,
+     off64_t scrub_offset,
+     size64_t maximum_scrub_size,
+     uint8_t print_status_information,
+     log_handle_t *log_handle,
+     size64_t *scrubbed_size,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_handle_scrub_chunks";
+	size64_t scrub_size   = 0;
+	size_t buffer_size    = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->range_digests != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid verification handle - range digests value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->process_buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid process buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->number_of_threads != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: multi-threading not supported.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( scrub_offset < 0 )
+	 || ( ( scrub_offset % verification_handle->chunk_size ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid scrub offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_scrub_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum scrub size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( scrubbed_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scrubbed size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_get_media_size(
+	     verification_handle->input_handle,
+	     &( verification_handle->media_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		return( -1 );
+	}
+	*scrubbed_size = 0;
+
+	if( (size64_t) scrub_offset >= verification_handle->media_size )
+	{
+		return( 1 );
+	}
+	/* The ranges are aligned with the chunks so that every chunk
+	 * is read and validated by a single range worker
+	 */
+	buffer_size = verification_handle->chunk_size;
+
+	if( verification_handle->process_buffer_size > buffer_size )
+	{
+		buffer_size = ( verification_handle->process_buffer_size / verification_handle->chunk_size )
+		            * verification_handle->chunk_size;
+	}
+	/* The slice is rounded up to a multiple of the range size so that only
+	 * the last range of the media data can be smaller than the range size
+	 */
+	scrub_size = ( ( maximum_scrub_size + buffer_size - 1 ) / buffer_size ) * buffer_size;
+
+	if( scrub_size > ( verification_handle->media_size - (size64_t) scrub_offset ) )
+	{
+		scrub_size = verification_handle->media_size - (size64_t) scrub_offset;
+	}
+	verification_handle->ranges_offset    = scrub_offset;
+	verification_handle->range_size       = (size64_t) buffer_size;
+	verification_handle->number_of_ranges = scrub_size / verification_handle->range_size;
+
+	if( ( scrub_size % verification_handle->range_size ) != 0 )
+	{
+		verification_handle->number_of_ranges += 1;
+	}
+	verification_handle->report_damaged_chunks     = 1;
+	verification_handle->number_of_damaged_sectors = 0;
+	verification_handle->damaged_chunks_log_handle = log_handle;
+
+	if( verification_handle_run_range_workers(
+	     verification_handle,
+	     buffer_size,
+	     print_status_information,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to run range workers.",
+		 function );
+
+		goto on_error;
+	}
+	verification_handle->ranges_offset             = 0;
+	verification_handle->report_damaged_chunks     = 0;
+	verification_handle->damaged_chunks_log_handle = NULL;
+
+	if( verification_handle->abort != 0 )
+	{
+		return( 0 );
+	}
+	*scrubbed_size = scrub_size;
+
+	return( 1 );
+
+on_error:
+	verification_handle->ranges_offset             = 0;
+	verification_handle->report_damaged_chunks     = 0;
+	verification_handle->damaged_chunks_log_handle = NULL;
+
+	return( -1 );
+}
+
+/* Scrubs the images by validating the checksums of their chunks, sections and tables
+ * The images are scrubbed in turns of a slice of their media data, such that the progress
+ * is spread over the images. The progress is stored in the scrub state file after every
+ * slice so that an interrupted scrub continues where it left off, once all images have been
+ * scrubbed the next scrub starts from the beginning
+ * Returns 1 if no damage was found, 0 if damage was found or the scrub was aborted or -1 on error
+ */
+int verification_handle_scrub_images(
+     verification_handle_t *verification_handle,
+     system_character_t * const * filenames,
+     int number_of_images,
+     const system_character_t *scrub_state_filename,
+     uint8_t print_status_information,
+     log_handle_t *log_handle,
+     libcerror_error_t **error )
+{
+	scrub_state_image_t *image     = NULL;
+	scrub_state_t *scrub_state     = NULL;
+	static char *function          = "verification_handle_scrub_images";
+	size64_t media_size            = 0;
+	size64_t scrubbed_size         = 0;
+	int image_index                = 0;
+	int is_completed               = 0;
+	int is_corrupted               = 0;
+	int is_open                    = 0;
+	int number_of_completed_images = 0;
+	int number_of_remaining_images = 0;
+	int result                     = 0;
+	int return_value               = 1;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filenames == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filenames.",
+		 function );
+
+		return( -1 );
+	}
+	if( scrub_state_initialize(
+	     &scrub_state,
+	     number_of_images,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create scrub state.",
+		 function );
+
+		goto on_error;
+	}
+	if( scrub_state_filename != NULL )
+	{
+		if( scrub_state_read_file(
+		     scrub_state,
+		     scrub_state_filename,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read scrub state file.",
+			 function );
+
+			goto on_error;
+		}
+		for( image_index = 0;
+		     image_index < number_of_images;
+		     image_index++ )
+		{
+			is_completed = scrub_state_image_is_completed(
+			                scrub_state,
+			                image_index,
+			                error );
+
+			if( is_completed == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if scrub of image: %d has completed.",
+				 function,
+				 image_index );
+
+				goto on_error;
+			}
+			else if( is_completed != 0 )
+			{
+				number_of_completed_images++;
+			}
+		}
+		if( number_of_completed_images == number_of_images )
+		{
+			if( scrub_state_reset(
+			     scrub_state,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to reset scrub state.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		/* Rewrite the scrub state file so that it does not grow over consecutive scrubs
+		 */
+		if( scrub_state_write_file(
+		     scrub_state,
+		     scrub_state_filename,
+		     -1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write scrub state file.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	do
+	{
+		number_of_remaining_images = 0;
+
+		for( image_index = 0;
+		     image_index < number_of_images;
+		     image_index++ )
+		{
+			if( verification_handle->abort != 0 )
+			{
+				break;
+			}
+			image = &( scrub_state->images[ image_index ] );
+
+			if( image->has_failed != 0 )
+			{
+				continue;
+			}
+			is_completed = scrub_state_image_is_completed(
+			                scrub_state,
+			                image_index,
+			                error );
+
+			if( is_completed == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if scrub of image: %d has completed.",
+				 function,
+				 image_index );
+
+				goto on_error;
+			}
+			else if( is_completed != 0 )
+			{
+				continue;
+			}
+			result = verification_handle_open_input(
+			          verification_handle,
+			          &( filenames[ image_index ] ),
+			          1,
+			          error );
+
+			if( result != 1 )
+			{
+				fprintf(
+				 verification_handle->notify_stream,
+				 "Unable to open image: %" PRIs_SYSTEM ".\n",
+				 filenames[ image_index ] );
+
+				if( log_handle != NULL )
+				{
+					log_handle_printf(
+					 log_handle,
+					 "Unable to open image: %" PRIs_SYSTEM ".\n",
+					 filenames[ image_index ] );
+				}
+				if( error != NULL )
+				{
+					libcnotify_print_error_backtrace(
+					 *error );
+					libcerror_error_free(
+					 error );
+				}
+				image->has_failed = 1;
+
+				continue;
+			}
+			is_open = 1;
+
+			if( libewf_handle_get_media_size(
+			     verification_handle->input_handle,
+			     &media_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve media size of image: %d.",
+				 function,
+				 image_index );
+
+				goto on_error;
+			}
+			/* The stored progress does not apply when the image was replaced
+			 */
+			if( ( image->media_size != (uint64_t) media_size )
+			 || ( image->chunk_size != verification_handle->chunk_size )
+			 || ( ( image->scrubbed_offset % verification_handle->chunk_size ) != 0 ) )
+			{
+				image->media_size                = (uint64_t) media_size;
+				image->chunk_size                = verification_handle->chunk_size;
+				image->scrubbed_offset           = 0;
+				image->number_of_damaged_sectors = 0;
+				image->is_corrupted              = 0;
+			}
+			if( image->scrubbed_offset < image->media_size )
+			{
+				fprintf(
+				 verification_handle->notify_stream,
+				 "Scrubbing image: %" PRIs_SYSTEM " at offset: %" PRIu64 " of %" PRIu64 ".\n",
+				 filenames[ image_index ],
+				 image->scrubbed_offset,
+				 image->media_size );
+
+				result = verification_handle_scrub_chunks(
+				          verification_handle,
+				          (off64_t) image->scrubbed_offset,
+				          SCRUB_STATE_DEFAULT_SLICE_SIZE,
+				          print_status_information,
+				          log_handle,
+				          &scrubbed_size,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GENERIC,
+					 "%s: unable to scrub image: %d.",
+					 function,
+					 image_index );
+
+					goto on_error;
+				}
+				else if( result != 0 )
+				{
+					image->scrubbed_offset           += scrubbed_size;
+					image->number_of_damaged_sectors += verification_handle->number_of_damaged_sectors;
+				}
+			}
+			/* The checksums of the sections and tables are validated while they are read
+			 */
+			is_corrupted = libewf_handle_segment_files_corrupted(
+			                verification_handle->input_handle,
+			                error );
+
+			if( is_corrupted == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if segment files of image: %d are corrupted.",
+				 function,
+				 image_index );
+
+				goto on_error;
+			}
+			else if( ( is_corrupted != 0 )
+			      && ( image->is_corrupted == 0 ) )
+			{
+				fprintf(
+				 verification_handle->notify_stream,
+				 "Corrupted section or table found in segment files of image: %" PRIs_SYSTEM ".\n",
+				 filenames[ image_index ] );
+
+				if( log_handle != NULL )
+				{
+					log_handle_printf(
+					 log_handle,
+					 "Corrupted section or table found in segment files of image: %" PRIs_SYSTEM ".\n",
+					 filenames[ image_index ] );
+				}
+				image->is_corrupted = 1;
+			}
+			is_open = 0;
+
+			if( verification_handle_close(
+			     verification_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close image: %d.",
+				 function,
+				 image_index );
+
+				goto on_error;
+			}
+			if( ( result != 0 )
+			 && ( scrub_state_filename != NULL ) )
+			{
+				if( scrub_state_write_file(
+				     scrub_state,
+				     scrub_state_filename,
+				     image_index,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write scrub state of image: %d.",
+					 function,
+					 image_index );
+
+					goto on_error;
+				}
+			}
+			if( image->scrubbed_offset < image->media_size )
+			{
+				number_of_remaining_images++;
+			}
+		}
+	}
+	while( ( number_of_remaining_images > 0 )
+	    && ( verification_handle->abort == 0 ) );
+
+	if( verification_handle->abort != 0 )
+	{
+		return_value = 0;
+	}
+	else
+	{
+		fprintf(
+		 verification_handle->notify_stream,
+		 "\nScrub results:\n" );
+
+		for( image_index = 0;
+		     image_index < number_of_images;
+		     image_index++ )
+		{
+			image = &( scrub_state->images[ image_index ] );
+
+			fprintf(
+			 verification_handle->notify_stream,
+			 "\t%" PRIs_SYSTEM ": ",
+			 filenames[ image_index ] );
+
+			if( image->has_failed != 0 )
+			{
+				fprintf(
+				 verification_handle->notify_stream,
+				 "unable to open\n" );
+			}
+			else
+			{
+				fprintf(
+				 verification_handle->notify_stream,
+				 "%" PRIu64 " damaged sector(s)%s\n",
+				 image->number_of_damaged_sectors,
+				 ( image->is_corrupted != 0 ) ? ", corrupted section or table" : "" );
+			}
+			if( ( image->has_failed != 0 )
+			 || ( image->is_corrupted != 0 )
+			 || ( image->number_of_damaged_sectors != 0 ) )
+			{
+				return_value = 0;
+			}
+		}
+		fprintf(
+		 verification_handle->notify_stream,
+		 "\n" );
+	}
+	if( scrub_state_free(
+	     &scrub_state,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free scrub state.",
+		 function );
+
+		goto on_error;
+	}
+	return( return_value );
+
+on_error:
+	if( is_open != 0 )
+	{
+		verification_handle_close(
+		 verification_handle,
+		 NULL );
+	}
+	if( scrub_state != NULL )
+	{
+		scrub_state_free(
+		 &scrub_state,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Compares the media data of the input with that of the compared image
+ * The ranges are compared in parallel by a range worker per thread, if the
+ * chunk sizes of both images match the chunks are only unpacked if their
+ * packed data differs
+ * Returns 1 if the media data matches, 0 if not or -1 on error
+ */
+int verification_handle_compare_input(
+     verification_handle_t *verification_handle,
+     uint8_t print_status_information,
+     log_handle_t *log_handle,
+     libcerror_error_t **error )
+{
+	static char *function       = "verification_handle_compare_input";
+	size64_t compare_media_size = 0;
+	size_t buffer_size          = 0;
+	size32_t compare_chunk_size = 0;
+	int result                  = 1;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->compare_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid verification handle - missing compare handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->range_digests != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid verification handle - range digests value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->process_buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid process buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->number_of_threads != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: multi-threading not supported.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libewf_handle_get_media_size(
+	     verification_handle->input_handle,
+	     &( verification_handle->media_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_media_size(
+	     verification_handle->compare_handle,
+	     &compare_media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size of compared image.",
+		 function );
+
+		goto on_error;
+	}
+	if( compare_media_size != verification_handle->media_size )
+	{
+		fprintf(
+		 verification_handle->notify_stream,
+		 "Media size of compared image: %" PRIu64 " does not match media size: %" PRIu64 ".\n",
+		 compare_media_size,
+		 verification_handle->media_size );
+
+		if( log_handle != NULL )
+		{
+			log_handle_printf(
+			 log_handle,
+			 "Media size of compared image: %" PRIu64 " does not match media size: %" PRIu64 ".\n",
+			 compare_media_size,
+			 verification_handle->media_size );
+		}
+		return( 0 );
+	}
+	if( libewf_handle_get_chunk_size(
+	     verification_handle->compare_handle,
+	     &compare_chunk_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk size of compared image.",
+		 function );
+
+		goto on_error;
+	}
+	/* The ranges are aligned with the chunks so that every chunk
+	 * is compared by a single range worker
+	 */
+	verification_handle->range_size = (size64_t) verification_handle->chunk_size;
+
+	if( verification_handle->process_buffer_size > (size_t) verification_handle->chunk_size )
+	{
+		verification_handle->range_size = (size64_t) ( verification_handle->process_buffer_size / verification_handle->chunk_size )
+		                                * verification_handle->chunk_size;
+	}
+	verification_handle->number_of_ranges = verification_handle->media_size / verification_handle->range_size;
+
+	if( ( verification_handle->media_size % verification_handle->range_size ) != 0 )
+	{
+		verification_handle->number_of_ranges += 1;
+	}
+	/* The chunks can only be compared directly if both images use the same chunk size
+	 */
+	if( compare_chunk_size == verification_handle->chunk_size )
+	{
+		verification_handle->compare_data_chunks = 1;
+
+		buffer_size = (size_t) verification_handle->chunk_size;
+	}
+	else
+	{
+		verification_handle->compare_data_chunks = 0;
+
+		buffer_size = (size_t) verification_handle->range_size;
+	}
+	verification_handle->mismatched_ranges = (uint8_t *) memory_allocate(
+	                                                      sizeof( uint8_t ) * (size_t) verification_handle->number_of_ranges );
+
+	if( verification_handle->mismatched_ranges == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create mismatched ranges.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     verification_handle->mismatched_ranges,
+	     0,
+	     sizeof( uint8_t ) * (size_t) verification_handle->number_of_ranges ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear mismatched ranges.",
+		 function );
+
+		goto on_error;
+	}
+	verification_handle->number_of_mismatched_ranges = 0;
+
+	if( verification_handle_run_range_workers(
+	     verification_handle,
+	     buffer_size,
+	     print_status_information,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to run range workers.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle->abort == 0 )
+	{
+		fprintf(
+		 verification_handle->notify_stream,
+		 "\n" );
+
+		if( verification_handle_mismatched_ranges_fprint(
+		     verification_handle,
+		     verification_handle->notify_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print mismatched ranges.",
+			 function );
+
+			goto on_error;
+		}
+		if( verification_handle->compare_data_chunks != 0 )
+		{
+			fprintf(
+			 verification_handle->notify_stream,
+			 "Chunks compared without unpacking: %" PRIu64 "\n\n",
+			 verification_handle->number_of_identical_packed_chunks );
+		}
+		if( log_handle != NULL )
+		{
+			if( verification_handle_mismatched_ranges_fprint(
+			     verification_handle,
+			     log_handle->log_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print mismatched ranges in log handle.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	if( ( verification_handle->abort != 0 )
+	 || ( verification_handle->number_of_mismatched_ranges != 0 ) )
+	{
+		result = 0;
+	}
+	memory_free(
+	 verification_handle->mismatched_ranges );
+
+	verification_handle->mismatched_ranges = NULL;
+
+	return( result );
+
+on_error:
+	if( verification_handle->mismatched_ranges != NULL )
+	{
+		memory_free(
+		 verification_handle->mismatched_ranges );
+
+		verification_handle->mismatched_ranges = NULL;
+	}
+	return( -1 );
+}
+
+/* Verifies single files
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int verification_handle_verify_single_files(
+     verification_handle_t *verification_handle,
+     uint8_t print_status_information,
+     log_handle_t *log_handle,
+     libcerror_error_t **error )
+{
+	libewf_file_entry_t *file_entry    = NULL;
+	static char *function              = "verification_handle_verify_single_files";
+	uint32_t number_of_checksum_errors = 0;
+	int result                         = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_get_root_file_entry(
+	     verification_handle->input_handle,
+	     &file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve root file entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( process_status_initialize(
+	     &( verification_handle->process_status ),
+	     _SYSTEM_STRING( "Verify" ),
+	     _SYSTEM_STRING( "verified" ),
+	     _SYSTEM_STRING( "Read" ),
+	     verification_handle->notify_stream,
+	     print_status_information,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle->stats_output != NULL )
+	{
+		if( process_status_set_stats_output(
+		     verification_handle->process_status,
+		     verification_handle->stats_output,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set statistics output in process status.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( process_status_start(
+	     verification_handle->process_status,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to start process status.",
+		 function );
+
+		goto on_error;
+	}
+	result = verification_handle_verify_file_entry(
+	          verification_handle,
+	          &file_entry,
+	          _SYSTEM_STRING( "" ),
+	          0,
+	          log_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to verify root file entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( process_status_stop(
+	     verification_handle->process_status,
+	     0,
+	     PROCESS_STATUS_COMPLETED,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to stop process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( process_status_free(
+	     &( verification_handle->process_status ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_file_entry_free(
+	     &file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free root file entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_number_of_checksum_errors(
+	     verification_handle->input_handle,
+	     &number_of_checksum_errors,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve the number of checksum errors.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( result != 0 )
+	 && ( number_of_checksum_errors == 0 ) )
+	{
+		return( 1 );
+	}
+	return( 0 );
+
+on_error:
+	if( verification_handle->process_status != NULL )
+	{
+		process_status_stop(
+		 verification_handle->process_status,
+		 0,
+		 PROCESS_STATUS_FAILED,
+		 NULL );
+		process_status_free(
+		 &( verification_handle->process_status ),
+		 NULL );
+	}
+	if( file_entry != NULL )
+	{
+		libewf_file_entry_free(
+		 &file_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Verifies a (single) file entry
+ * If the file entry is verified using the stored digest (hash) values management of the file entry
+ * is taken over, in which case file_entry is set to NULL
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int verification_handle_verify_file_entry(
+     verification_handle_t *verification_handle,
+     libewf_file_entry_t **file_entry,
+     const system_character_t *file_entry_path,
+     size_t file_entry_path_length,
+     log_handle_t *log_handle,
+     libcerror_error_t **error )
+{
+	system_character_t *name        = NULL;
+	system_character_t *target_path = NULL;
+	uint8_t *file_entry_data        = NULL;
+	static char *function           = "verification_handle_verify_file_entry";
+	size64_t file_entry_data_size   = 0;
+	size_t name_size                = 0;
+	size_t process_buffer_size      = 0;
+	size_t read_size                = 0;
+	size_t target_path_size         = 0;
+	ssize_t read_count              = 0;
+	uint8_t file_entry_type         = 0;
+	int md5_hash_compare            = 0;
+	int result                      = 0;
+	int return_value                = 0;
+	int sha1_hash_compare           = 0;
+	int sha256_hash_compare         = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_entry == NULL )
+	 || ( *file_entry == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->chunk_size > (size32_t) INT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->process_buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid process buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libewf_file_entry_get_utf16_name_size(
+		  *file_entry,
+		  &name_size,
+		  error );
+#else
+	result = libewf_file_entry_get_utf8_name_size(
+		  *file_entry,
+		  &name_size,
+		  error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve the name.",
+		 function );
+
+		goto on_error;
+	}
+	if( name_size > 0 )
+	{
+		name = system_string_allocate(
+			name_size );
+
+		if( name == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create name.",
+			 function );
+
+			goto on_error;
+		}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libewf_file_entry_get_utf16_name(
+			  *file_entry,
+			  (uint16_t *) name,
+			  name_size,
+			  error );
+#else
+		result = libewf_file_entry_get_utf8_name(
+			  *file_entry,
+			  (uint8_t *) name,
+			  name_size,
+			  error );
+#endif
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve the name.",
+			 function );
+
+			memory_free(
+			 name );
+
+			goto on_error;
+		}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libcpath_path_join_wide(
+		     &target_path,
+		     &target_path_size,
+		     file_entry_path,
+		     file_entry_path_length,
+		     name,
+		     name_size - 1,
+		     error ) != 1 )
 #else
 		if( libcpath_path_join(
 		     &target_path,
@@ -2717,278 +8264,1695 @@ int verification_handle_verify_file_entry(
 		     name,
 		     name_size - 1,
 		     error ) != 1 )
-#endif
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create target path.",
+			 function );
+
+			memory_free(
+			 name );
+
+			goto on_error;
+		}
+		memory_free(
+		 name );
+	}
+	else
+	{
+		target_path      = (system_character_t *) file_entry_path;
+		target_path_size = file_entry_path_length + 1;
+	}
+	if( libewf_file_entry_get_type(
+	     *file_entry,
+	     &file_entry_type,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file entry type.",
+		 function );
+
+		goto on_error;
+	}
+	/* TODO what about NTFS streams ?
+	 */
+	if( ( file_entry_type == LIBEWF_FILE_ENTRY_TYPE_FILE )
+	 && ( verification_handle->verify_file_entries != NULL ) )
+	{
+		/* The file entry is verified afterwards using the stored digest (hash) values
+		 */
+		return_value = verification_handle_append_verify_file_entry(
+		                verification_handle,
+		                file_entry,
+		                target_path,
+		                target_path_size,
+		                error );
+
+		if( return_value == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append verify file entry.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else if( file_entry_type == LIBEWF_FILE_ENTRY_TYPE_FILE )
+	{
+		fprintf(
+		 verification_handle->notify_stream,
+		 "Single file: %" PRIs_SYSTEM "\n",
+		 target_path );
+
+		if( log_handle != NULL )
+		{
+			log_handle_printf(
+			 log_handle,
+			 "Single file: %" PRIs_SYSTEM "\n",
+			 target_path );
+		}
+		if( libewf_file_entry_get_size(
+		     *file_entry,
+		     &file_entry_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file entry data size.",
+			 function );
+
+			goto on_error;
+		}
+		if( verification_handle_initialize_integrity_hash(
+		     verification_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize integrity hash(es).",
+			 function );
+
+			goto on_error;
+		}
+		result = 1;
+
+		if( file_entry_data_size > 0 )
+		{
+			if( verification_handle->process_buffer_size == 0 )
+			{
+				process_buffer_size = verification_handle->chunk_size;
+			}
+			else
+			{
+				process_buffer_size = verification_handle->process_buffer_size;
+			}
+			/* This function in not necessary for normal use
+			 * but it was added for testing
+			 */
+			if( libewf_file_entry_seek_offset(
+			     *file_entry,
+			     0,
+			     SEEK_SET,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to seek the start of the file entry data.",
+				 function );
+
+				goto on_error;
+			}
+			file_entry_data = (uint8_t *) memory_allocate(
+			                               sizeof( uint8_t ) * process_buffer_size );
+
+			if( file_entry_data == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create file entry data.",
+				 function );
+
+				goto on_error;
+			}
+			while( file_entry_data_size > 0 )
+			{
+				if( file_entry_data_size >= process_buffer_size )
+				{
+					read_size = process_buffer_size;
+				}
+				else
+				{
+					read_size = (size_t) file_entry_data_size;
+				}
+				read_count = libewf_file_entry_read_buffer(
+				              *file_entry,
+				              file_entry_data,
+				              read_size,
+				              error );
+
+				if( read_count == (ssize_t) -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read file entry data.",
+					 function );
+
+					goto on_error;
+				}
+				else if( read_count != (ssize_t) read_size )
+				{
+					result = 0;
+
+					break;
+				}
+				file_entry_data_size -= read_size;
+
+				if( verification_handle_update_integrity_hash(
+				     verification_handle,
+				     file_entry_data,
+				     read_count,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GENERIC,
+					 "%s: unable to update integrity hash(es).",
+					 function );
+
+					goto on_error;
+				}
+			}
+			memory_free(
+			 file_entry_data );
+
+			file_entry_data = NULL;
+		}
+		if( verification_handle_finalize_integrity_hash(
+		     verification_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize integrity hash(es).",
+			 function );
+
+			goto on_error;
+		}
+		if( result != 0 )
+		{
+			if( verification_handle_get_integrity_hash_from_file_entry(
+			     verification_handle,
+			     *file_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to retrieve integrity hash(es) from file entry.",
+				 function );
+
+				goto on_error;
+			}
+			if( verification_handle_hash_values_fprint(
+			     verification_handle,
+			     verification_handle->notify_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print hash values.",
+				 function );
+
+				goto on_error;
+			}
+			if( log_handle != NULL )
+			{
+				if( verification_handle_hash_values_fprint(
+				     verification_handle,
+				     log_handle->log_stream,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+					 "%s: unable to print hash values in log handle.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			if( ( verification_handle->calculate_md5 != 0 )
+			 && ( verification_handle->stored_md5_hash_available != 0 ) )
+			{
+				md5_hash_compare = system_string_compare(
+						    verification_handle->stored_md5_hash_string,
+						    verification_handle->calculated_md5_hash_string,
+						    33 );
+			}
+			if( ( verification_handle->calculate_sha1 != 0 )
+			 && ( verification_handle->stored_sha1_hash_available != 0 ) )
+			{
+				sha1_hash_compare = system_string_compare(
+						     verification_handle->stored_sha1_hash_string,
+						     verification_handle->calculated_sha1_hash_string,
+						     41 );
+			}
+			if( ( verification_handle->calculate_sha256 != 0 )
+			 && ( verification_handle->stored_sha256_hash_available != 0 ) )
+			{
+				sha256_hash_compare = system_string_compare(
+						       verification_handle->stored_sha256_hash_string,
+						       verification_handle->calculated_sha256_hash_string,
+						       65 );
+			}
+		}
+		if( ( result != 0 )
+		 && ( md5_hash_compare == 0 )
+		 && ( sha1_hash_compare == 0 )
+		 && ( sha256_hash_compare == 0 ) )
+		{
+			return_value = 1;
+		}
+		else
+		{
+			fprintf(
+			 verification_handle->notify_stream,
+			 "FAILED\n" );
+
+			if( log_handle != NULL )
+			{
+				log_handle_printf(
+				 log_handle,
+				 "FAILED\n" );
+			}
+			return_value = 0;
+		}
+		fprintf(
+		 verification_handle->notify_stream,
+		 "\n" );
+	}
+	else if( file_entry_type == LIBEWF_FILE_ENTRY_TYPE_DIRECTORY )
+	{
+		return_value = verification_handle_verify_sub_file_entries(
+		                verification_handle,
+		                *file_entry,
+		                target_path,
+		                target_path_size - 1,
+		                log_handle,
+		                error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to verify sub file entries.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( target_path != file_entry_path )
+	{
+		memory_free(
+		 target_path );
+	}
+	return( return_value );
+
+on_error:
+	if( file_entry_data != NULL )
+	{
+		memory_free(
+		 file_entry_data );
+	}
+	if( ( target_path != NULL )
+	 && ( target_path != file_entry_path ) )
+	{
+		memory_free(
+		 target_path );
+	}
+	return( -1 );
+}
+
+/* Verifies a (single) file entry sub file entries
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int verification_handle_verify_sub_file_entries(
+     verification_handle_t *verification_handle,
+     libewf_file_entry_t *file_entry,
+     const system_character_t *file_entry_path,
+     size_t file_entry_path_length,
+     log_handle_t *log_handle,
+     libcerror_error_t **error )
+{
+	libewf_file_entry_t *sub_file_entry = NULL;
+	static char *function               = "verification_handle_verify_sub_file_entries";
+	int number_of_sub_file_entries      = 0;
+	int result                          = 1;
+	int sub_file_entry_index            = 0;
+	int sub_file_entry_result           = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_file_entry_get_number_of_sub_file_entries(
+	     file_entry,
+	     &number_of_sub_file_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sub file entries.",
+		 function );
+
+		return( -1 );
+	}
+	for( sub_file_entry_index = 0;
+	     sub_file_entry_index < number_of_sub_file_entries;
+	     sub_file_entry_index++ )
+	{
+		if( libewf_file_entry_get_sub_file_entry(
+		     file_entry,
+		     sub_file_entry_index,
+		     &sub_file_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to free retrieve sub file entry: %d.",
+			 function,
+			 sub_file_entry_index );
+
+			goto on_error;
+		}
+		sub_file_entry_result = verification_handle_verify_file_entry(
+		                         verification_handle,
+		                         &sub_file_entry,
+		                         file_entry_path,
+		                         file_entry_path_length,
+		                         log_handle,
+		                         error );
+
+		if( sub_file_entry_result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to verify sub file entry: %d.",
+			 function,
+			 sub_file_entry_index );
+
+			goto on_error;
+		}
+		if( sub_file_entry_result == 0 )
+		{
+			result = 0;
+		}
+		if( libewf_file_entry_free(
+		     &sub_file_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free sub file entry: %d.",
+			 function,
+			 sub_file_entry_index );
+
+			goto on_error;
+		}
+	}
+	return( result );
+
+on_error:
+	if( sub_file_entry != NULL )
+	{
+		libewf_file_entry_free(
+		 &sub_file_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Verifies single files using the digest (hash) values stored per file
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int verification_handle_verify_single_files_stored_hashes(
+     verification_handle_t *verification_handle,
+     uint8_t print_status_information,
+     log_handle_t *log_handle,
+     libcerror_error_t **error )
+{
+	libewf_file_entry_t *file_entry    = NULL;
+	static char *function              = "verification_handle_verify_single_files_stored_hashes";
+	uint32_t number_of_checksum_errors = 0;
+	int result                         = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->verify_file_entries != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid verification handle - verify file entries value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->number_of_threads != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: multi-threading not supported.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libcdata_array_initialize(
+	     &( verification_handle->verify_file_entries ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create verify file entries array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_root_file_entry(
+	     verification_handle->input_handle,
+	     &file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve root file entry.",
+		 function );
+
+		goto on_error;
+	}
+	/* The file entries are traversed first so that their data can be verified in media data order
+	 */
+	result = verification_handle_verify_file_entry(
+	          verification_handle,
+	          &file_entry,
+	          _SYSTEM_STRING( "" ),
+	          0,
+	          log_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to traverse root file entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_file_entry_free(
+	     &file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free root file entry.",
+		 function );
+
+		goto on_error;
+	}
+	result = verification_handle_verify_file_entries_stored_hashes(
+	          verification_handle,
+	          print_status_information,
+	          log_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to verify file entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_free(
+	     &( verification_handle->verify_file_entries ),
+	     (int (*)(intptr_t **, libcerror_error_t **)) &verify_file_entry_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free verify file entries array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_number_of_checksum_errors(
+	     verification_handle->input_handle,
+	     &number_of_checksum_errors,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve the number of checksum errors.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( result != 0 )
+	 && ( number_of_checksum_errors == 0 ) )
+	{
+		return( 1 );
+	}
+	return( 0 );
+
+on_error:
+	if( file_entry != NULL )
+	{
+		libewf_file_entry_free(
+		 &file_entry,
+		 NULL );
+	}
+	if( verification_handle->verify_file_entries != NULL )
+	{
+		libcdata_array_free(
+		 &( verification_handle->verify_file_entries ),
+		 (int (*)(intptr_t **, libcerror_error_t **)) &verify_file_entry_free,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Appends a (single) file entry that is to be verified using the stored digest (hash) values
+ * The verify file entry takes over management of the file entry, in which case file_entry is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_append_verify_file_entry(
+     verification_handle_t *verification_handle,
+     libewf_file_entry_t **file_entry,
+     const system_character_t *path,
+     size_t path_size,
+     libcerror_error_t **error )
+{
+	verify_file_entry_t *verify_file_entry = NULL;
+	static char *function                  = "verification_handle_append_verify_file_entry";
+	int entry_index                        = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->verify_file_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid verification handle - missing verify file entries array.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( verify_file_entry_initialize(
+	     &verify_file_entry,
+	     *file_entry,
+	     path,
+	     path_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create verify file entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_append_entry(
+	     verification_handle->verify_file_entries,
+	     &entry_index,
+	     (intptr_t *) verify_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append verify file entry to array.",
+		 function );
+
+		goto on_error;
+	}
+	*file_entry = NULL;
+
+	return( 1 );
+
+on_error:
+	if( verify_file_entry != NULL )
+	{
+		/* The file entry is still managed by the caller
+		 */
+		verify_file_entry->file_entry = NULL;
+
+		verify_file_entry_free(
+		 &verify_file_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Calculates the digest (hash) values of the data of a verify file entry
+ * The data is read using the read at offset function so that multiple
+ * file entries can be read at the same time
+ * Returns 1 if successful, 0 if the data could not be read entirely or -1 on error
+ */
+int verification_handle_calculate_file_entry_hashes(
+     verification_handle_t *verification_handle,
+     verify_file_entry_t *verify_file_entry,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	uint8_t calculated_md5_hash[ LIBHMAC_MD5_HASH_SIZE ];
+	uint8_t calculated_sha1_hash[ LIBHMAC_SHA1_HASH_SIZE ];
+
+	libhmac_md5_context_t *md5_context   = NULL;
+	libhmac_sha1_context_t *sha1_context = NULL;
+	static char *function                = "verification_handle_calculate_file_entry_hashes";
+	size64_t remaining_size              = 0;
+	size_t read_size                     = 0;
+	ssize_t read_count                   = 0;
+	off64_t offset                       = 0;
+	int result                           = 1;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verify_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verify file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( verify_file_entry->calculate_md5 != 0 )
+	{
+		if( libhmac_md5_initialize(
+		     &md5_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize MD5 context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( verify_file_entry->calculate_sha1 != 0 )
+	{
+		if( libhmac_sha1_initialize(
+		     &sha1_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA1 context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	remaining_size = verify_file_entry->size;
+
+	while( remaining_size > 0 )
+	{
+		if( verification_handle->abort != 0 )
+		{
+			result = 0;
+
+			break;
+		}
+		read_size = buffer_size;
+
+		if( remaining_size < (size64_t) read_size )
+		{
+			read_size = (size_t) remaining_size;
+		}
+		read_count = libewf_file_entry_read_buffer_at_offset(
+		              verify_file_entry->file_entry,
+		              buffer,
+		              read_size,
+		              offset,
+		              error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read file entry data at offset: %" PRIi64 ".",
+			 function,
+			 offset );
+
+			goto on_error;
+		}
+		else if( read_count != (ssize_t) read_size )
+		{
+			result = 0;
+
+			break;
+		}
+		if( md5_context != NULL )
+		{
+			if( libhmac_md5_update(
+			     md5_context,
+			     buffer,
+			     read_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update MD5 digest hash.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( sha1_context != NULL )
+		{
+			if( libhmac_sha1_update(
+			     sha1_context,
+			     buffer,
+			     read_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update SHA1 digest hash.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		offset         += (off64_t) read_size;
+		remaining_size -= (size64_t) read_size;
+	}
+	if( md5_context != NULL )
+	{
+		if( libhmac_md5_finalize(
+		     md5_context,
+		     calculated_md5_hash,
+		     LIBHMAC_MD5_HASH_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize MD5 hash.",
+			 function );
+
+			goto on_error;
+		}
+		if( libhmac_md5_free(
+		     &md5_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free MD5 context.",
+			 function );
+
+			goto on_error;
+		}
+		if( digest_hash_copy_to_string(
+		     calculated_md5_hash,
+		     LIBHMAC_MD5_HASH_SIZE,
+		     verify_file_entry->calculated_md5_hash_string,
+		     33,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set calculated MD5 hash string.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( sha1_context != NULL )
+	{
+		if( libhmac_sha1_finalize(
+		     sha1_context,
+		     calculated_sha1_hash,
+		     LIBHMAC_SHA1_HASH_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize SHA1 hash.",
+			 function );
+
+			goto on_error;
+		}
+		if( libhmac_sha1_free(
+		     &sha1_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free SHA1 context.",
+			 function );
+
+			goto on_error;
+		}
+		if( digest_hash_copy_to_string(
+		     calculated_sha1_hash,
+		     LIBHMAC_SHA1_HASH_SIZE,
+		     verify_file_entry->calculated_sha1_hash_string,
+		     41,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set calculated SHA1 hash string.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( result );
+
+on_error:
+	if( sha1_context != NULL )
+	{
+		libhmac_sha1_free(
+		 &sha1_context,
+		 NULL );
+	}
+	if( md5_context != NULL )
+	{
+		libhmac_md5_free(
+		 &md5_context,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Calculates the digest (hash) values of a batch of verify file entries
+ * Callback function for the file entry thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_verify_file_entry_callback(
+     verify_file_entry_t *verify_file_entry,
+     verification_handle_t *verification_handle )
+{
+	libcerror_error_t *error = NULL;
+	uint8_t *buffer          = NULL;
+	static char *function    = "verification_handle_verify_file_entry_callback";
+	size_t buffer_size       = 0;
+
+	if( verify_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verify file entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle->process_buffer_size == 0 )
+	{
+		buffer_size = verification_handle->chunk_size;
+	}
+	else
+	{
+		buffer_size = verification_handle->process_buffer_size;
+	}
+	/* The buffer is shared by the file entries of the batch
+	 */
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * buffer_size );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	while( verify_file_entry != NULL )
+	{
+		if( verification_handle->abort != 0 )
+		{
+			break;
+		}
+		verify_file_entry->result = verification_handle_calculate_file_entry_hashes(
+		                             verification_handle,
+		                             verify_file_entry,
+		                             buffer,
+		                             buffer_size,
+		                             &error );
+
+		if( verify_file_entry->result == -1 )
+		{
+#if defined( HAVE_VERBOSE_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_print_error_backtrace(
+				 error );
+			}
+#endif
+			libcerror_error_free(
+			 &error );
+		}
+		verify_file_entry = verify_file_entry->next_verify_file_entry;
+	}
+	memory_free(
+	 buffer );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Verifies the (single) file entries using the stored digest (hash) values
+ * The file entries are sorted by their media data offset and split into batches
+ * so that every thread reads the media data sequentially. The data of a file entry
+ * that duplicates the data of another file entry is not read again, instead the digest
+ * (hash) values calculated for the other file entry are used
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int verification_handle_verify_file_entries_stored_hashes(
+     verification_handle_t *verification_handle,
+     uint8_t print_status_information,
+     log_handle_t *log_handle,
+     libcerror_error_t **error )
+{
+	verify_file_entry_t key_verify_file_entry;
+
+	verify_file_entry_t **found_verify_file_entry      = NULL;
+	verify_file_entry_t **verify_file_entries          = NULL;
+	verify_file_entry_t *batch_verify_file_entry       = NULL;
+	verify_file_entry_t *duplicate_verify_file_entry   = NULL;
+	verify_file_entry_t *key_verify_file_entry_pointer = NULL;
+	verify_file_entry_t *last_verify_file_entry        = NULL;
+	verify_file_entry_t *verify_file_entry             = NULL;
+	static char *function                              = "verification_handle_verify_file_entries_stored_hashes";
+	size64_t batch_size                                = 0;
+	size64_t total_size                                = 0;
+	int entry_index                                    = 0;
+	int found_entry_index                              = 0;
+	int number_of_verify_file_entries                  = 0;
+	int result                                         = 0;
+	int return_value                                   = 1;
+	int status                                         = PROCESS_STATUS_COMPLETED;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	libcthreads_thread_pool_t *file_entry_thread_pool  = NULL;
+#endif
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->process_buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid process buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     verification_handle->verify_file_entries,
+	     &number_of_verify_file_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of verify file entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_verify_file_entries == 0 )
+	{
+		return( 1 );
+	}
+	if( (size_t) number_of_verify_file_entries > ( (size_t) SSIZE_MAX / sizeof( verify_file_entry_t * ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of verify file entries value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	verify_file_entries = (verify_file_entry_t **) memory_allocate(
+	                                                sizeof( verify_file_entry_t * ) * number_of_verify_file_entries );
+
+	if( verify_file_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create verify file entries.",
+		 function );
+
+		goto on_error;
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_verify_file_entries;
+	     entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     verification_handle->verify_file_entries,
+		     entry_index,
+		     (intptr_t **) &( verify_file_entries[ entry_index ] ),
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create target path.",
-			 function );
-
-			memory_free(
-			 name );
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve verify file entry: %d.",
+			 function,
+			 entry_index );
 
 			goto on_error;
 		}
-		memory_free(
-		 name );
 	}
-	else
+	qsort(
+	 verify_file_entries,
+	 (size_t) number_of_verify_file_entries,
+	 sizeof( verify_file_entry_t * ),
+	 &verify_file_entry_compare_by_media_data_offset );
+
+	/* A file entry that duplicates the data of another file entry of the same size
+	 * is verified using the digest (hash) values calculated for the other file entry
+	 */
+	key_verify_file_entry_pointer = &key_verify_file_entry;
+
+	for( entry_index = 0;
+	     entry_index < number_of_verify_file_entries;
+	     entry_index++ )
 	{
-		target_path      = (system_character_t *) file_entry_path;
-		target_path_size = file_entry_path_length + 1;
+		verify_file_entry = verify_file_entries[ entry_index ];
+
+		if( ( verify_file_entry->duplicate_media_data_offset < 0 )
+		 || ( verify_file_entry->size == 0 ) )
+		{
+			continue;
+		}
+		key_verify_file_entry.media_data_offset = verify_file_entry->duplicate_media_data_offset;
+
+		found_verify_file_entry = (verify_file_entry_t **) bsearch(
+		                                                    &key_verify_file_entry_pointer,
+		                                                    verify_file_entries,
+		                                                    (size_t) number_of_verify_file_entries,
+		                                                    sizeof( verify_file_entry_t * ),
+		                                                    &verify_file_entry_compare_by_media_data_offset );
+
+		if( found_verify_file_entry == NULL )
+		{
+			continue;
+		}
+		found_entry_index = (int) ( found_verify_file_entry - verify_file_entries );
+
+		/* Multiple file entries can share the same media data offset
+		 */
+		while( ( found_entry_index > 0 )
+		    && ( verify_file_entries[ found_entry_index - 1 ]->media_data_offset == key_verify_file_entry.media_data_offset ) )
+		{
+			found_entry_index--;
+		}
+		while( ( found_entry_index < number_of_verify_file_entries )
+		    && ( verify_file_entries[ found_entry_index ]->media_data_offset == key_verify_file_entry.media_data_offset ) )
+		{
+			duplicate_verify_file_entry = verify_file_entries[ found_entry_index ];
+
+			if( ( duplicate_verify_file_entry != verify_file_entry )
+			 && ( duplicate_verify_file_entry->duplicate_media_data_offset < 0 )
+			 && ( duplicate_verify_file_entry->size == verify_file_entry->size ) )
+			{
+				verify_file_entry->duplicate_verify_file_entry = duplicate_verify_file_entry;
+
+				duplicate_verify_file_entry->calculate_md5  |= verify_file_entry->calculate_md5;
+				duplicate_verify_file_entry->calculate_sha1 |= verify_file_entry->calculate_sha1;
+
+				break;
+			}
+			found_entry_index++;
+		}
 	}
-	if( libewf_file_entry_get_type(
-	     file_entry,
-	     &file_entry_type,
+	for( entry_index = 0;
+	     entry_index < number_of_verify_file_entries;
+	     entry_index++ )
+	{
+		verify_file_entry = verify_file_entries[ entry_index ];
+
+		if( verify_file_entry->duplicate_verify_file_entry == NULL )
+		{
+			total_size += verify_file_entry->size;
+		}
+	}
+	if( process_status_initialize(
+	     &( verification_handle->process_status ),
+	     _SYSTEM_STRING( "Verify" ),
+	     _SYSTEM_STRING( "verified" ),
+	     _SYSTEM_STRING( "Read" ),
+	     verification_handle->notify_stream,
+	     print_status_information,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve file entry type.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create process status.",
 		 function );
 
 		goto on_error;
 	}
-	/* TODO what about NTFS streams ?
-	 */
-	if( file_entry_type == LIBEWF_FILE_ENTRY_TYPE_FILE )
+	if( verification_handle->stats_output != NULL )
 	{
-		fprintf(
-		 verification_handle->notify_stream,
-		 "Single file: %" PRIs_SYSTEM "\n",
-		 target_path );
-
-		if( log_handle != NULL )
-		{
-			log_handle_printf(
-			 log_handle,
-			 "Single file: %" PRIs_SYSTEM "\n",
-			 target_path );
-		}
-		if( libewf_file_entry_get_size(
-		     file_entry,
-		     &file_entry_data_size,
+		if( process_status_set_stats_output(
+		     verification_handle->process_status,
+		     verification_handle->stats_output,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve file entry data size.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set statistics output in process status.",
 			 function );
 
 			goto on_error;
 		}
-		if( verification_handle_initialize_integrity_hash(
-		     verification_handle,
+	}
+	if( process_status_start(
+	     verification_handle->process_status,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to start process status.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->number_of_threads != 0 )
+	{
+		if( libcthreads_thread_pool_create(
+		     &file_entry_thread_pool,
+		     NULL,
+		     verification_handle->number_of_threads,
+		     4 * verification_handle->number_of_threads,
+		     (int (*)(intptr_t *, void *)) &verification_handle_verify_file_entry_callback,
+		     (void *) verification_handle,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize integrity hash(es).",
+			 "%s: unable to initialize file entry thread pool.",
 			 function );
 
 			goto on_error;
 		}
-		result = 1;
+	}
+#endif
+	verification_handle->verified_file_entries_size = 0;
 
-		if( file_entry_data_size > 0 )
+	/* Consecutive file entries are combined into a batch until the size
+	 * of their data reaches the batch size
+	 */
+	for( entry_index = 0;
+	     entry_index < number_of_verify_file_entries;
+	     entry_index++ )
+	{
+		if( verification_handle->abort != 0 )
 		{
-			if( verification_handle->process_buffer_size == 0 )
+			break;
+		}
+		verify_file_entry = verify_file_entries[ entry_index ];
+
+		if( ( verify_file_entry->duplicate_verify_file_entry == NULL )
+		 && ( ( verify_file_entry->calculate_md5 != 0 )
+		  || ( verify_file_entry->calculate_sha1 != 0 ) ) )
+		{
+			if( batch_verify_file_entry == NULL )
 			{
-				process_buffer_size = verification_handle->chunk_size;
+				batch_verify_file_entry = verify_file_entry;
+				batch_size              = 0;
 			}
 			else
 			{
-				process_buffer_size = verification_handle->process_buffer_size;
+				last_verify_file_entry->next_verify_file_entry = verify_file_entry;
 			}
-			/* This function in not necessary for normal use
-			 * but it was added for testing
+			last_verify_file_entry = verify_file_entry;
+			batch_size            += verify_file_entry->size;
+		}
+		else if( verify_file_entry->duplicate_verify_file_entry == NULL )
+		{
+			/* Without stored digest (hash) values there is nothing to verify
 			 */
-			if( libewf_file_entry_seek_offset(
-			     file_entry,
-			     0,
-			     SEEK_SET,
-			     error ) != 0 )
+			verify_file_entry->result = 1;
+		}
+		if( ( batch_verify_file_entry == NULL )
+		 || ( ( batch_size < (size64_t) VERIFICATION_HANDLE_FILE_ENTRIES_BATCH_SIZE )
+		  && ( ( entry_index + 1 ) < number_of_verify_file_entries ) ) )
+		{
+			continue;
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( file_entry_thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_push(
+			     file_entry_thread_pool,
+			     (intptr_t *) batch_verify_file_entry,
+			     error ) == -1 )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to seek the start of the file entry data.",
-				 function );
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push verify file entry: %d onto file entry thread pool queue.",
+				 function,
+				 entry_index );
 
 				goto on_error;
 			}
-			file_entry_data = (uint8_t *) memory_allocate(
-			                               sizeof( uint8_t ) * process_buffer_size );
+		}
+		else
+#endif
+		{
+			verification_handle_verify_file_entry_callback(
+			 batch_verify_file_entry,
+			 verification_handle );
+		}
+		batch_verify_file_entry = NULL;
 
-			if( file_entry_data == NULL )
+		verification_handle->verified_file_entries_size += batch_size;
+
+		if( process_status_update(
+		     verification_handle->process_status,
+		     verification_handle->verified_file_entries_size,
+		     total_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update process status.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( file_entry_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &file_entry_thread_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join file entry thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	if( verification_handle->abort != 0 )
+	{
+		status = PROCESS_STATUS_ABORTED;
+	}
+	if( process_status_stop(
+	     verification_handle->process_status,
+	     verification_handle->verified_file_entries_size,
+	     status,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to stop process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( process_status_free(
+	     &( verification_handle->process_status ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free process status.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 verify_file_entries );
+
+	verify_file_entries = NULL;
+
+	if( verification_handle->abort != 0 )
+	{
+		return( 0 );
+	}
+	/* The results are reported in the order the file entries were traversed
+	 * once all the threads have finished
+	 */
+	for( entry_index = 0;
+	     entry_index < number_of_verify_file_entries;
+	     entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     verification_handle->verify_file_entries,
+		     entry_index,
+		     (intptr_t **) &verify_file_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve verify file entry: %d.",
+			 function,
+			 entry_index );
+
+			goto on_error;
+		}
+		duplicate_verify_file_entry = verify_file_entry->duplicate_verify_file_entry;
+
+		if( duplicate_verify_file_entry != NULL )
+		{
+			verify_file_entry->result = duplicate_verify_file_entry->result;
+
+			if( memory_copy(
+			     verify_file_entry->calculated_md5_hash_string,
+			     duplicate_verify_file_entry->calculated_md5_hash_string,
+			     sizeof( system_character_t ) * 33 ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy calculated MD5 hash string.",
+				 function );
+
+				goto on_error;
+			}
+			if( memory_copy(
+			     verify_file_entry->calculated_sha1_hash_string,
+			     duplicate_verify_file_entry->calculated_sha1_hash_string,
+			     sizeof( system_character_t ) * 41 ) == NULL )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_MEMORY,
-				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-				 "%s: unable to create file entry data.",
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy calculated SHA1 hash string.",
 				 function );
 
 				goto on_error;
 			}
-			while( file_entry_data_size > 0 )
-			{
-				if( file_entry_data_size >= process_buffer_size )
-				{
-					read_size = process_buffer_size;
-				}
-				else
-				{
-					read_size = (size_t) file_entry_data_size;
-				}
-				read_count = libewf_file_entry_read_buffer(
-				              file_entry,
-				              file_entry_data,
-				              read_size,
-				              error );
-
-				if( read_count == (ssize_t) -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read file entry data.",
-					 function );
-
-					goto on_error;
-				}
-				else if( read_count != (ssize_t) read_size )
-				{
-					result = 0;
+		}
+		result = verify_file_entry->result;
 
-					break;
-				}
-				file_entry_data_size -= read_size;
+		if( result == 1 )
+		{
+			result = verify_file_entry_compare_hashes(
+			          verify_file_entry,
+			          error );
 
-				if( verification_handle_update_integrity_hash(
-				     verification_handle,
-				     file_entry_data,
-				     read_count,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GENERIC,
-					 "%s: unable to update integrity hash(es).",
-					 function );
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to compare digest hashes of verify file entry: %d.",
+				 function,
+				 entry_index );
 
-					goto on_error;
-				}
+				goto on_error;
 			}
-			memory_free(
-			 file_entry_data );
-
-			file_entry_data = NULL;
 		}
-		if( verification_handle_finalize_integrity_hash(
+		if( verification_handle_verify_file_entry_fprint(
 		     verification_handle,
+		     verify_file_entry,
+		     verification_handle->notify_stream,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to finalize integrity hash(es).",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print verify file entry: %d.",
+			 function,
+			 entry_index );
 
 			goto on_error;
 		}
-		if( result != 0 )
+		if( log_handle != NULL )
 		{
-			if( verification_handle_get_integrity_hash_from_file_entry(
-			     verification_handle,
-			     file_entry,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to retrieve integrity hash(es) from file entry.",
-				 function );
-
-				goto on_error;
-			}
-			if( verification_handle_hash_values_fprint(
+			if( verification_handle_verify_file_entry_fprint(
 			     verification_handle,
-			     verification_handle->notify_stream,
+			     verify_file_entry,
+			     log_handle->log_stream,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-				 "%s: unable to print hash values.",
-				 function );
+				 "%s: unable to print verify file entry: %d in log handle.",
+				 function,
+				 entry_index );
 
 				goto on_error;
 			}
-			if( log_handle != NULL )
-			{
-				if( verification_handle_hash_values_fprint(
-				     verification_handle,
-				     log_handle->log_stream,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-					 "%s: unable to print hash values in log handle.",
-					 function );
-
-					goto on_error;
-				}
-			}
-			if( ( verification_handle->calculate_md5 != 0 )
-			 && ( verification_handle->stored_md5_hash_available != 0 ) )
-			{
-				md5_hash_compare = system_string_compare(
-						    verification_handle->stored_md5_hash_string,
-						    verification_handle->calculated_md5_hash_string,
-						    33 );
-			}
-			if( ( verification_handle->calculate_sha1 != 0 )
-			 && ( verification_handle->stored_sha1_hash_available != 0 ) )
-			{
-				sha1_hash_compare = system_string_compare(
-						     verification_handle->stored_sha1_hash_string,
-						     verification_handle->calculated_sha1_hash_string,
-						     41 );
-			}
-			if( ( verification_handle->calculate_sha256 != 0 )
-			 && ( verification_handle->stored_sha256_hash_available != 0 ) )
-			{
-				sha256_hash_compare = system_string_compare(
-						       verification_handle->stored_sha256_hash_string,
-						       verification_handle->calculated_sha256_hash_string,
-						       65 );
-			}
-		}
-		if( ( result != 0 )
-		 && ( md5_hash_compare == 0 )
-		 && ( sha1_hash_compare == 0 )
-		 && ( sha256_hash_compare == 0 ) )
-		{
-			return_value = 1;
 		}
-		else
+		if( result != 1 )
 		{
 			fprintf(
 			 verification_handle->notify_stream,
@@ -3006,67 +9970,50 @@ int verification_handle_verify_file_entry(
 		 verification_handle->notify_stream,
 		 "\n" );
 	}
-	else if( file_entry_type == LIBEWF_FILE_ENTRY_TYPE_DIRECTORY )
-	{
-		return_value = verification_handle_verify_sub_file_entries(
-		                verification_handle,
-		                file_entry,
-		                target_path,
-		                target_path_size - 1,
-		                log_handle,
-		                error );
-
-		if( result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to verify sub file entries.",
-			 function );
-
-			return( -1 );
-		}
-	}
-	if( target_path != file_entry_path )
-	{
-		memory_free(
-		 target_path );
-	}
 	return( return_value );
 
 on_error:
-	if( file_entry_data != NULL )
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( file_entry_thread_pool != NULL )
 	{
-		memory_free(
-		 file_entry_data );
+		/* Signal the threads to stop before they are joined
+		 */
+		verification_handle->abort = 1;
+
+		libcthreads_thread_pool_join(
+		 &file_entry_thread_pool,
+		 NULL );
 	}
-	if( ( target_path != NULL )
-	 && ( target_path != file_entry_path ) )
+#endif
+	if( verification_handle->process_status != NULL )
+	{
+		process_status_stop(
+		 verification_handle->process_status,
+		 verification_handle->verified_file_entries_size,
+		 PROCESS_STATUS_FAILED,
+		 NULL );
+		process_status_free(
+		 &( verification_handle->process_status ),
+		 NULL );
+	}
+	if( verify_file_entries != NULL )
 	{
 		memory_free(
-		 target_path );
+		 verify_file_entries );
 	}
 	return( -1 );
 }
 
-/* Verifies a (single) file entry sub file entries
- * Returns 1 if successful, 0 if not or -1 on error
+/* Prints the digest (hash) values of a verify file entry to a stream
+ * Returns 1 if successful or -1 on error
  */
-int verification_handle_verify_sub_file_entries(
+int verification_handle_verify_file_entry_fprint(
      verification_handle_t *verification_handle,
-     libewf_file_entry_t *file_entry,
-     const system_character_t *file_entry_path,
-     size_t file_entry_path_length,
-     log_handle_t *log_handle,
+     verify_file_entry_t *verify_file_entry,
+     FILE *stream,
      libcerror_error_t **error )
 {
-	libewf_file_entry_t *sub_file_entry = NULL;
-	static char *function               = "verification_handle_verify_sub_file_entries";
-	int number_of_sub_file_entries      = 0;
-	int result                          = 1;
-	int sub_file_entry_index            = 0;
-	int sub_file_entry_result           = 0;
+	static char *function = "verification_handle_verify_file_entry_fprint";
 
 	if( verification_handle == NULL )
 	{
@@ -3079,89 +10026,77 @@ int verification_handle_verify_sub_file_entries(
 
 		return( -1 );
 	}
-	if( libewf_file_entry_get_number_of_sub_file_entries(
-	     file_entry,
-	     &number_of_sub_file_entries,
-	     error ) != 1 )
+	if( verify_file_entry == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of sub file entries.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verify file entry.",
 		 function );
 
 		return( -1 );
 	}
-	for( sub_file_entry_index = 0;
-	     sub_file_entry_index < number_of_sub_file_entries;
-	     sub_file_entry_index++ )
+	if( stream == NULL )
 	{
-		if( libewf_file_entry_get_sub_file_entry(
-		     file_entry,
-		     sub_file_entry_index,
-		     &sub_file_entry,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to free retrieve sub file entry: %d.",
-			 function,
-			 sub_file_entry_index );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
 
-			goto on_error;
-		}
-		sub_file_entry_result = verification_handle_verify_file_entry(
-		                         verification_handle,
-		                         sub_file_entry,
-		                         file_entry_path,
-		                         file_entry_path_length,
-		                         log_handle,
-		                         error );
+		return( -1 );
+	}
+	fprintf(
+	 stream,
+	 "Single file: %" PRIs_SYSTEM "\n",
+	 verify_file_entry->path );
 
-		if( sub_file_entry_result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to verify sub file entry: %d.",
-			 function,
-			 sub_file_entry_index );
+	if( verify_file_entry->stored_md5_hash_available == 0 )
+	{
+		fprintf(
+		 stream,
+		 "MD5 hash stored in file:\t\tN/A\n" );
+	}
+	else
+	{
+		fprintf(
+		 stream,
+		 "MD5 hash stored in file:\t\t%" PRIs_SYSTEM "\n",
+		 verify_file_entry->stored_md5_hash_string );
 
-			goto on_error;
-		}
-		if( sub_file_entry_result == 0 )
+		if( verify_file_entry->result == 1 )
 		{
-			result = 0;
+			fprintf(
+			 stream,
+			 "MD5 hash calculated over data:\t\t%" PRIs_SYSTEM "\n",
+			 verify_file_entry->calculated_md5_hash_string );
 		}
-		if( libewf_file_entry_free(
-		     &sub_file_entry,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free sub file entry: %d.",
-			 function,
-			 sub_file_entry_index );
+	}
+	if( verify_file_entry->stored_sha1_hash_available != 0 )
+	{
+		fprintf(
+		 stream,
+		 "SHA1 hash stored in file:\t\t%" PRIs_SYSTEM "\n",
+		 verify_file_entry->stored_sha1_hash_string );
 
-			goto on_error;
+		if( verify_file_entry->result == 1 )
+		{
+			fprintf(
+			 stream,
+			 "SHA1 hash calculated over data:\t\t%" PRIs_SYSTEM "\n",
+			 verify_file_entry->calculated_sha1_hash_string );
 		}
 	}
-	return( result );
-
-on_error:
-	if( sub_file_entry != NULL )
+	if( verify_file_entry->duplicate_verify_file_entry != NULL )
 	{
-		libewf_file_entry_free(
-		 &sub_file_entry,
-		 NULL );
+		fprintf(
+		 stream,
+		 "Data duplicate of:\t\t\t%" PRIs_SYSTEM "\n",
+		 verify_file_entry->duplicate_verify_file_entry->path );
 	}
-	return( -1 );
+	return( 1 );
 }
 
 /* Retrieves the integrity hash(es) from the input
@@ -3984,6 +10919,190 @@ int verification_handle_set_zero_chunk_on_error(
 	return( 1 );
 }
 
+/* Sets the restart checkpoint filename
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_set_restart_checkpoint_filename(
+     verification_handle_t *verification_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function  = "verification_handle_set_restart_checkpoint_filename";
+	size_t filename_length = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->restart_checkpoint_filename != NULL )
+	{
+		memory_free(
+		 verification_handle->restart_checkpoint_filename );
+
+		verification_handle->restart_checkpoint_filename      = NULL;
+		verification_handle->restart_checkpoint_filename_size = 0;
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+	if( filename_length == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid filename length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	verification_handle->restart_checkpoint_filename = system_string_allocate(
+	                                                    filename_length + 1 );
+
+	if( verification_handle->restart_checkpoint_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create restart checkpoint filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     verification_handle->restart_checkpoint_filename,
+	     filename,
+	     filename_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy restart checkpoint filename.",
+		 function );
+
+		goto on_error;
+	}
+	verification_handle->restart_checkpoint_filename[ filename_length ] = 0;
+
+	verification_handle->restart_checkpoint_filename_size = filename_length + 1;
+
+	return( 1 );
+
+on_error:
+	if( verification_handle->restart_checkpoint_filename != NULL )
+	{
+		memory_free(
+		 verification_handle->restart_checkpoint_filename );
+
+		verification_handle->restart_checkpoint_filename = NULL;
+	}
+	return( -1 );
+}
+
+/* Sets the rate limit of the reads of the checksum verification
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int verification_handle_set_rate_limit(
+     verification_handle_t *verification_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_handle_set_rate_limit";
+	size_t string_length  = 0;
+	uint64_t rate         = 0;
+	int result            = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	result = byte_size_string_convert(
+	          string,
+	          string_length,
+	          &rate,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine rate limit.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( verification_handle->rate_limiter == NULL )
+	{
+		if( rate_limiter_initialize(
+		     &( verification_handle->rate_limiter ),
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create rate limiter.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	result = rate_limiter_set_rate(
+	          verification_handle->rate_limiter,
+	          (size64_t) rate,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set rate.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
 /* Appends a read error to the output handle
  * Returns 1 if successful or -1 on error
  */
@@ -4339,6 +11458,120 @@ int verification_handle_additional_hash_values_fprint(
 	return( result );
 }
 
+/* Prints the ranges of which the digest or the compared data does not match to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_mismatched_ranges_fprint(
+     verification_handle_t *verification_handle,
+     FILE *stream,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_handle_mismatched_ranges_fprint";
+	off64_t range_offset  = 0;
+	size64_t range_size   = 0;
+	uint64_t range_index  = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->mismatched_ranges == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid verification handle - missing mismatched ranges.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->range_digests != NULL )
+	{
+		fprintf(
+		 stream,
+		 "Range digests:\n" );
+	}
+	else
+	{
+		fprintf(
+		 stream,
+		 "Compared ranges:\n" );
+	}
+	fprintf(
+	 stream,
+	 "\tnumber of ranges: %" PRIu64 " of size: %" PRIu64 "\n",
+	 verification_handle->number_of_ranges,
+	 verification_handle->range_size );
+
+	for( range_index = 0;
+	     range_index < verification_handle->number_of_ranges;
+	     range_index++ )
+	{
+		if( verification_handle->mismatched_ranges[ range_index ] == 0 )
+		{
+			continue;
+		}
+		if( verification_handle_get_range(
+		     verification_handle,
+		     range_index,
+		     &range_offset,
+		     &range_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve range: %" PRIu64 ".",
+			 function,
+			 range_index );
+
+			return( -1 );
+		}
+		if( verification_handle->range_digests != NULL )
+		{
+			fprintf(
+			 stream,
+			 "\tdigest mismatch at offset: %" PRIi64 " of size: %" PRIu64 "\n",
+			 range_offset,
+			 range_size );
+		}
+		else
+		{
+			fprintf(
+			 stream,
+			 "\tdata mismatch at offset: %" PRIi64 " of size: %" PRIu64 "\n",
+			 range_offset,
+			 range_size );
+		}
+	}
+	fprintf(
+	 stream,
+	 "\tnumber of mismatches: %" PRIu64 "\n\n",
+	 verification_handle->number_of_mismatched_ranges );
+
+	return( 1 );
+}
+
 /* Print the checksum errors to a stream
  * Returns 1 if successful or -1 on error
  */
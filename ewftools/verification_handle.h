@@ -32,8 +32,16 @@
 #include "ewftools_libewf.h"
 #include "ewftools_libhmac.h"
 #include "log_handle.h"
+#include "md5_context.h"
 #include "process_status.h"
+#include "rate_limiter.h"
+#include "stats_output.h"
+#include "range_digests.h"
+#include "sha1_context.h"
+#include "sha256_context.h"
 #include "storage_media_buffer.h"
+#include "storage_media_buffer_queue.h"
+#include "verify_file_entry.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -63,7 +71,7 @@ struct verification_handle
 
 	/* The MD5 digest context
 	 */
-	libhmac_md5_context_t *md5_context;
+	md5_context_t *md5_context;
 
 	/* Value to indicate the MD5 digest context was initialized
 	 */
@@ -87,7 +95,7 @@ struct verification_handle
 
 	/* The SHA1 digest context
 	 */
-	libhmac_sha1_context_t *sha1_context;
+	sha1_context_t *sha1_context;
 
 	/* Value to indicate the SHA1 digest context was initialized
 	 */
@@ -111,7 +119,7 @@ struct verification_handle
 
 	/* The SHA256 digest context
 	 */
-	libhmac_sha256_context_t *sha256_context;
+	sha256_context_t *sha256_context;
 
 	/* Value to indicate the SHA256 digest context was initialized
 	 */
@@ -133,6 +141,10 @@ struct verification_handle
 	 */
 	uint8_t use_chunk_data_functions;
 
+	/* Value to indicate if the chunk data and storage media buffers should be backed by huge pages
+	 */
+	uint8_t use_huge_pages;
+
 	/* The process buffer size
 	 */
 	size_t process_buffer_size;
@@ -155,9 +167,17 @@ struct verification_handle
 	 */
 	libcdata_list_t *output_list;
 
+	/* Value to indicate the storage media buffers are read by the process threads
+	 */
+	uint8_t read_in_process_threads;
+
 	/* The storage media buffer queue
 	 */
-	libcthreads_queue_t *storage_media_buffer_queue;
+	storage_media_buffer_queue_t *storage_media_buffer_queue;
+
+	/* The mutex that protects the range verification state
+	 */
+	libcthreads_mutex_t *ranges_mutex;
 
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
@@ -165,6 +185,18 @@ struct verification_handle
 	 */
 	libewf_handle_t *input_handle;
 
+	/* The libewf handle of the image the input is compared with
+	 */
+	libewf_handle_t *compare_handle;
+
+	/* Value to indicate the ranges are compared per data chunk
+	 */
+	uint8_t compare_data_chunks;
+
+	/* The number of chunks of which the packed data was identical
+	 */
+	uint64_t number_of_identical_packed_chunks;
+
 	/* The media size
 	 */
 	size64_t media_size;
@@ -181,6 +213,82 @@ struct verification_handle
 	 */
 	off64_t last_offset_hashed;
 
+	/* The restart checkpoint filename
+	 */
+	system_character_t *restart_checkpoint_filename;
+
+	/* The restart checkpoint filename size
+	 */
+	size_t restart_checkpoint_filename_size;
+
+	/* Value to indicate the verification should resume at the last restart checkpoint
+	 */
+	uint8_t resume;
+
+	/* Value to indicate restart checkpoints are written
+	 */
+	uint8_t write_restart_checkpoints;
+
+	/* The offset at which the next restart checkpoint is written
+	 */
+	off64_t next_restart_checkpoint_offset;
+
+	/* The range digests
+	 */
+	range_digests_t *range_digests;
+
+	/* The size of the ranges verified by the range workers
+	 */
+	size64_t range_size;
+
+	/* The number of ranges verified by the range workers
+	 */
+	uint64_t number_of_ranges;
+
+	/* The offset of the first range verified by the range workers
+	 */
+	off64_t ranges_offset;
+
+	/* The index of the next range to verify
+	 */
+	uint64_t next_range_index;
+
+	/* The size of the verified ranges
+	 */
+	size64_t verified_ranges_size;
+
+	/* Values to indicate the digest of a range does not match
+	 */
+	uint8_t *mismatched_ranges;
+
+	/* The number of ranges of which the digest does not match
+	 */
+	uint64_t number_of_mismatched_ranges;
+
+	/* The rate limiter of the reads of the range workers
+	 */
+	rate_limiter_t *rate_limiter;
+
+	/* Value to indicate damaged chunks are reported as soon as they are found
+	 */
+	uint8_t report_damaged_chunks;
+
+	/* The number of damaged sectors that were reported
+	 */
+	uint64_t number_of_damaged_sectors;
+
+	/* The log handle the damaged chunks are reported in, which is not managed by the verification handle
+	 */
+	log_handle_t *damaged_chunks_log_handle;
+
+	/* The (single) file entries that are verified using the stored digest (hash) values
+	 */
+	libcdata_array_t *verify_file_entries;
+
+	/* The size of the media data of the verified file entries
+	 */
+	size64_t verified_file_entries_size;
+
 	/* The notification output stream
 	 */
 	FILE *notify_stream;
@@ -189,11 +297,69 @@ struct verification_handle
 	 */
 	process_status_t *process_status;
 
+	/* The statistics output, which is not managed by the verification handle
+	 */
+	stats_output_t *stats_output;
+
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
 };
 
+typedef struct verification_handle_range_worker verification_handle_range_worker_t;
+
+/* A range worker verifies ranges of the media data, multiple range workers
+ * share the state of the range verification in the verification handle
+ */
+struct verification_handle_range_worker
+{
+	/* The verification handle
+	 */
+	verification_handle_t *verification_handle;
+
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The buffer size
+	 */
+	size_t buffer_size;
+
+	/* The buffer of the compared data
+	 */
+	uint8_t *compare_buffer;
+
+	/* The libewf input handle, a clone of that of the verification handle
+	 */
+	libewf_handle_t *input_handle;
+
+	/* The libewf compare handle, a clone of that of the verification handle
+	 */
+	libewf_handle_t *compare_handle;
+
+	/* The data chunk of the input
+	 */
+	libewf_data_chunk_t *input_data_chunk;
+
+	/* The data chunk of the compared image
+	 */
+	libewf_data_chunk_t *compare_data_chunk;
+
+	/* The number of chunks of which the packed data was identical
+	 */
+	uint64_t number_of_identical_packed_chunks;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The thread
+	 */
+	libcthreads_thread_t *thread;
+#endif
+
+	/* The result of the range verification
+	 */
+	int result;
+};
+
 int verification_handle_initialize(
      verification_handle_t **verification_handle,
      uint8_t calculate_md5,
@@ -219,6 +385,11 @@ int verification_handle_open_input(
      int number_of_filenames,
      libcerror_error_t **error );
 
+int verification_handle_open_compare_input(
+     verification_handle_t *verification_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
 int verification_handle_close(
      verification_handle_t *verification_handle,
      libcerror_error_t **error );
@@ -242,6 +413,21 @@ int verification_handle_finalize_integrity_hash(
      verification_handle_t *verification_handle,
      libcerror_error_t **error );
 
+int verification_handle_read_restart_checkpoint(
+     verification_handle_t *verification_handle,
+     off64_t *hashed_offset,
+     libcerror_error_t **error );
+
+int verification_handle_write_restart_checkpoint(
+     verification_handle_t *verification_handle,
+     off64_t hashed_offset,
+     uint8_t append,
+     libcerror_error_t **error );
+
+int verification_handle_update_restart_checkpoint(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error );
+
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 
 int verification_handle_process_storage_media_buffer_callback(
@@ -264,6 +450,116 @@ int verification_handle_verify_input(
      log_handle_t *log_handle,
      libcerror_error_t **error );
 
+int verification_handle_verify_range(
+     verification_handle_t *verification_handle,
+     uint8_t *buffer,
+     size_t buffer_size,
+     uint64_t range_index,
+     libcerror_error_t **error );
+
+int verification_handle_read_range(
+     verification_handle_t *verification_handle,
+     uint8_t *buffer,
+     size_t buffer_size,
+     off64_t range_offset,
+     size64_t range_size,
+     libcerror_error_t **error );
+
+int verification_handle_report_damaged_chunks(
+     verification_handle_t *verification_handle,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error );
+
+int verification_handle_get_range(
+     verification_handle_t *verification_handle,
+     uint64_t range_index,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error );
+
+int verification_handle_compare_range(
+     verification_handle_t *verification_handle,
+     verification_handle_range_worker_t *range_worker,
+     off64_t range_offset,
+     size64_t range_size,
+     libcerror_error_t **error );
+
+int verification_handle_range_worker_open_compare(
+     verification_handle_range_worker_t *range_worker,
+     libcerror_error_t **error );
+
+int verification_handle_range_worker_close_compare(
+     verification_handle_range_worker_t *range_worker,
+     libcerror_error_t **error );
+
+int verification_handle_range_worker_function(
+     verification_handle_range_worker_t *range_worker );
+
+int verification_handle_run_range_workers(
+     verification_handle_t *verification_handle,
+     size_t buffer_size,
+     uint8_t print_status_information,
+     libcerror_error_t **error );
+
+int verification_handle_verify_ranges(
+     verification_handle_t *verification_handle,
+     const system_character_t *range_digests_filename,
+     uint8_t print_status_information,
+     log_handle_t *log_handle,
+     libcerror_error_t **error );
+
+int verification_handle_digest_segment(
+     verification_handle_t *verification_handle,
+     uint8_t *buffer,
+     size_t buffer_size,
+     off64_t media_offset,
+     size64_t media_size,
+     uint8_t update_integrity_hash,
+     uint8_t *digest,
+     size_t digest_size,
+     libcerror_error_t **error );
+
+int verification_handle_verify_segments(
+     verification_handle_t *verification_handle,
+     system_character_t * const * filenames,
+     int number_of_filenames,
+     const system_character_t *ledger_filename,
+     int sample_percentage,
+     uint8_t print_status_information,
+     log_handle_t *log_handle,
+     libcerror_error_t **error );
+
+int verification_handle_verify_chunks(
+     verification_handle_t *verification_handle,
+     uint8_t print_status_information,
+     log_handle_t *log_handle,
+     libcerror_error_t **error );
+
+int verification_handle_scrub_chunks(
+     verification_handle_t *verification_handle,
+     off64_t scrub_offset,
+     size64_t maximum_scrub_size,
+     uint8_t print_status_information,
+     log_handle_t *log_handle,
+     size64_t *scrubbed_size,
+     libcerror_error_t **error );
+
+int verification_handle_scrub_images(
+     verification_handle_t *verification_handle,
+     system_character_t * const * filenames,
+     int number_of_images,
+     const system_character_t *scrub_state_filename,
+     uint8_t print_status_information,
+     log_handle_t *log_handle,
+     libcerror_error_t **error );
+
+int verification_handle_compare_input(
+     verification_handle_t *verification_handle,
+     uint8_t print_status_information,
+     log_handle_t *log_handle,
+     libcerror_error_t **error );
+
 int verification_handle_verify_single_files(
      verification_handle_t *verification_handle,
      uint8_t print_status_information,
@@ -272,7 +568,7 @@ int verification_handle_verify_single_files(
 
 int verification_handle_verify_file_entry(
      verification_handle_t *verification_handle,
-     libewf_file_entry_t *file_entry,
+     libewf_file_entry_t **file_entry,
      const system_character_t *file_entry_path,
      size_t file_entry_path_length,
      log_handle_t *log_handle,
@@ -286,6 +582,42 @@ int verification_handle_verify_sub_file_entries(
      log_handle_t *log_handle,
      libcerror_error_t **error );
 
+int verification_handle_verify_single_files_stored_hashes(
+     verification_handle_t *verification_handle,
+     uint8_t print_status_information,
+     log_handle_t *log_handle,
+     libcerror_error_t **error );
+
+int verification_handle_append_verify_file_entry(
+     verification_handle_t *verification_handle,
+     libewf_file_entry_t **file_entry,
+     const system_character_t *path,
+     size_t path_size,
+     libcerror_error_t **error );
+
+int verification_handle_calculate_file_entry_hashes(
+     verification_handle_t *verification_handle,
+     verify_file_entry_t *verify_file_entry,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int verification_handle_verify_file_entry_callback(
+     verify_file_entry_t *verify_file_entry,
+     verification_handle_t *verification_handle );
+
+int verification_handle_verify_file_entries_stored_hashes(
+     verification_handle_t *verification_handle,
+     uint8_t print_status_information,
+     log_handle_t *log_handle,
+     libcerror_error_t **error );
+
+int verification_handle_verify_file_entry_fprint(
+     verification_handle_t *verification_handle,
+     verify_file_entry_t *verify_file_entry,
+     FILE *stream,
+     libcerror_error_t **error );
+
 int verification_handle_get_integrity_hash_from_input(
      verification_handle_t *verification_handle,
      libcerror_error_t **error );
@@ -325,6 +657,16 @@ int verification_handle_set_zero_chunk_on_error(
      uint8_t zero_chunk_on_error,
      libcerror_error_t **error );
 
+int verification_handle_set_restart_checkpoint_filename(
+     verification_handle_t *verification_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int verification_handle_set_rate_limit(
+     verification_handle_t *verification_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
 int verification_handle_append_read_error(
       verification_handle_t *verification_handle,
       off64_t start_offset,
@@ -341,6 +683,11 @@ int verification_handle_additional_hash_values_fprint(
      FILE *stream,
      libcerror_error_t **error );
 
+int verification_handle_mismatched_ranges_fprint(
+     verification_handle_t *verification_handle,
+     FILE *stream,
+     libcerror_error_t **error );
+
 int verification_handle_checksum_errors_fprint(
      verification_handle_t *verification_handle,
      FILE *stream,
@@ -0,0 +1,1444 @@
+/*
+ * Verify batch functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_system_string.h"
+#include "log_handle.h"
+#include "verification_handle.h"
+#include "verify_batch.h"
+
+/* Creates a verify batch
+ * The digest types, header codepage, process buffer size, number of threads
+ * and notification output stream are copied from the verification handle
+ * Make sure the value verify_batch is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int verify_batch_initialize(
+     verify_batch_t **verify_batch,
+     verification_handle_t *verification_handle,
+     uint8_t zero_chunk_on_error,
+     libcerror_error_t **error )
+{
+	static char *function = "verify_batch_initialize";
+
+	if( verify_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verify batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( *verify_batch != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid verify batch value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	*verify_batch = memory_allocate_structure(
+	                 verify_batch_t );
+
+	if( *verify_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create verify batch.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *verify_batch,
+	     0,
+	     sizeof( verify_batch_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear verify batch.",
+		 function );
+
+		memory_free(
+		 *verify_batch );
+
+		*verify_batch = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *verify_batch )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *verify_batch )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	( *verify_batch )->number_of_threads = verification_handle->number_of_threads;
+#endif
+	( *verify_batch )->calculate_md5                        = verification_handle->calculate_md5;
+	( *verify_batch )->use_chunk_data_functions             = verification_handle->use_chunk_data_functions;
+	( *verify_batch )->zero_chunk_on_error                  = zero_chunk_on_error;
+	( *verify_batch )->header_codepage                      = verification_handle->header_codepage;
+	( *verify_batch )->process_buffer_size                  = verification_handle->process_buffer_size;
+	( *verify_batch )->maximum_number_of_readers_per_device = 1;
+	( *verify_batch )->notify_stream                        = verification_handle->notify_stream;
+
+	return( 1 );
+
+on_error:
+	if( *verify_batch != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *verify_batch )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *verify_batch )->mutex ),
+			 NULL );
+		}
+#endif
+		memory_free(
+		 *verify_batch );
+
+		*verify_batch = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a verify batch
+ * Returns 1 if successful or -1 on error
+ */
+int verify_batch_free(
+     verify_batch_t **verify_batch,
+     libcerror_error_t **error )
+{
+	static char *function = "verify_batch_free";
+	int entry_index       = 0;
+	int worker_index      = 0;
+	int result            = 1;
+
+	if( verify_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verify batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( *verify_batch != NULL )
+	{
+		if( ( *verify_batch )->entries != NULL )
+		{
+			for( entry_index = 0;
+			     entry_index < ( *verify_batch )->number_of_entries;
+			     entry_index++ )
+			{
+				if( ( *verify_batch )->entries[ entry_index ].output_stream != NULL )
+				{
+					file_stream_close(
+					 ( *verify_batch )->entries[ entry_index ].output_stream );
+				}
+				if( ( *verify_batch )->entries[ entry_index ].error != NULL )
+				{
+					libcerror_error_free(
+					 &( ( *verify_batch )->entries[ entry_index ].error ) );
+				}
+			}
+			memory_free(
+			 ( *verify_batch )->entries );
+		}
+		if( ( *verify_batch )->devices != NULL )
+		{
+			memory_free(
+			 ( *verify_batch )->devices );
+		}
+		if( ( *verify_batch )->workers != NULL )
+		{
+			for( worker_index = 0;
+			     worker_index < ( *verify_batch )->number_of_workers;
+			     worker_index++ )
+			{
+				if( ( *verify_batch )->workers[ worker_index ].verification_handle == NULL )
+				{
+					continue;
+				}
+				if( verification_handle_free(
+				     &( ( *verify_batch )->workers[ worker_index ].verification_handle ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free verification handle of worker: %d.",
+					 function,
+					 worker_index );
+
+					result = -1;
+				}
+			}
+			memory_free(
+			 ( *verify_batch )->workers );
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_condition_free(
+		     &( ( *verify_batch )->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *verify_batch )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *verify_batch );
+
+		*verify_batch = NULL;
+	}
+	return( result );
+}
+
+/* Signals the verify batch to abort
+ * Returns 1 if successful or -1 on error
+ */
+int verify_batch_signal_abort(
+     verify_batch_t *verify_batch,
+     libcerror_error_t **error )
+{
+	static char *function = "verify_batch_signal_abort";
+	int worker_index      = 0;
+
+	if( verify_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verify batch.",
+		 function );
+
+		return( -1 );
+	}
+	verify_batch->abort = 1;
+
+	if( verify_batch->workers != NULL )
+	{
+		for( worker_index = 0;
+		     worker_index < verify_batch->number_of_workers;
+		     worker_index++ )
+		{
+			if( verify_batch->workers[ worker_index ].verification_handle == NULL )
+			{
+				continue;
+			}
+			if( verification_handle_signal_abort(
+			     verify_batch->workers[ worker_index ].verification_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to signal verification handle of worker: %d to abort.",
+				 function,
+				 worker_index );
+
+				return( -1 );
+			}
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the maximum number of images that are read concurrently from the same device
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int verify_batch_set_maximum_number_of_readers_per_device(
+     verify_batch_t *verify_batch,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function      = "verify_batch_set_maximum_number_of_readers_per_device";
+	size_t string_length       = 0;
+	uint64_t number_of_readers = 0;
+	int result                 = 0;
+
+	if( verify_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verify batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string[ 0 ] != (system_character_t) '-' )
+	{
+		string_length = system_string_length(
+		                 string );
+
+		if( ewftools_system_string_decimal_copy_to_64_bit(
+		     string,
+		     string_length + 1,
+		     &number_of_readers,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine number of readers per device.",
+			 function );
+
+			return( -1 );
+		}
+		result = 1;
+
+		if( ( number_of_readers == 0 )
+		 || ( number_of_readers > 32 ) )
+		{
+			result = 0;
+		}
+		else
+		{
+			verify_batch->maximum_number_of_readers_per_device = (int) number_of_readers;
+		}
+	}
+	return( result );
+}
+
+/* Sets the additional digest types
+ * The string is applied to the verification handle of every worker and must remain
+ * valid for the lifetime of the verify batch
+ * Returns 1 if successful or -1 on error
+ */
+int verify_batch_set_additional_digest_types(
+     verify_batch_t *verify_batch,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "verify_batch_set_additional_digest_types";
+
+	if( verify_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verify batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	verify_batch->additional_digest_types = string;
+
+	return( 1 );
+}
+
+/* Sets the maximum number of (concurrent) open file handles
+ * The maximum is divided over the verification handles of the workers
+ * Returns 1 if successful or -1 on error
+ */
+int verify_batch_set_maximum_number_of_open_handles(
+     verify_batch_t *verify_batch,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error )
+{
+	static char *function = "verify_batch_set_maximum_number_of_open_handles";
+
+	if( verify_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verify batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_open_handles < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid maximum number of open handles value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	verify_batch->maximum_number_of_open_handles = maximum_number_of_open_handles;
+
+	return( 1 );
+}
+
+/* Determines the identifier of the storage device of a file
+ * On Windows the identifier is the drive letter of the path, otherwise the
+ * device number of the file system that contains the file
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int verify_batch_get_device_identifier(
+     const system_character_t *filename,
+     uint64_t *identifier,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_SYS_STAT_H ) && !defined( WINAPI ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	struct stat file_stat;
+#endif
+
+	static char *function = "verify_batch_get_device_identifier";
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( identifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid identifier.",
+		 function );
+
+		return( -1 );
+	}
+	*identifier = 0;
+
+#if defined( WINAPI )
+	if( ( filename[ 0 ] != 0 )
+	 && ( filename[ 1 ] == (system_character_t) ':' ) )
+	{
+		if( ( filename[ 0 ] >= (system_character_t) 'a' )
+		 && ( filename[ 0 ] <= (system_character_t) 'z' ) )
+		{
+			*identifier = (uint64_t) ( filename[ 0 ] - (system_character_t) 'a' ) + 1;
+		}
+		else if( ( filename[ 0 ] >= (system_character_t) 'A' )
+		      && ( filename[ 0 ] <= (system_character_t) 'Z' ) )
+		{
+			*identifier = (uint64_t) ( filename[ 0 ] - (system_character_t) 'A' ) + 1;
+		}
+	}
+#elif defined( HAVE_SYS_STAT_H ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( stat(
+	     filename,
+	     &file_stat ) == 0 )
+	{
+		/* Store the device number + 1 since 0 represents unknown
+		 */
+		*identifier = (uint64_t) file_stat.st_dev + 1;
+	}
+#endif
+	if( *identifier == 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Verifies an entry, the output of the verification is printed to the output stream of the entry
+ * Returns 1 if successful, 0 if the image is not valid or -1 on error
+ */
+int verify_batch_process_entry(
+     verify_batch_t *verify_batch,
+     verify_batch_entry_t *entry,
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "verify_batch_process_entry";
+	int is_open           = 0;
+	int result            = 0;
+
+	if( verify_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verify batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry->output_stream != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid entry - output stream value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	entry->output_stream = tmpfile();
+
+	if( entry->output_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to create temporary output stream.",
+		 function );
+
+		goto on_error;
+	}
+	verification_handle->notify_stream = entry->output_stream;
+
+	fprintf(
+	 verification_handle->notify_stream,
+	 "Image:\t\t\t%" PRIs_SYSTEM "\n",
+	 entry->filename );
+
+	if( verification_handle_open_input(
+	     verification_handle,
+	     &( entry->filename ),
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open image.",
+		 function );
+
+		goto on_error;
+	}
+	is_open = 1;
+
+	if( verification_handle_set_zero_chunk_on_error(
+	     verification_handle,
+	     verify_batch->zero_chunk_on_error,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set zero on chunk error.",
+		 function );
+
+		goto on_error;
+	}
+	/* The log handle is shared by the workers, hence the output of the image
+	 * is written to the log when the entry is printed
+	 */
+	result = verification_handle_verify_input(
+	          verification_handle,
+	          0,
+	          NULL,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to verify image.",
+		 function );
+
+		goto on_error;
+	}
+	is_open = 0;
+
+	if( verification_handle_close(
+	     verification_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close image.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( is_open != 0 )
+	{
+		verification_handle_close(
+		 verification_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Copies the output of a processed entry to the notification output stream and the log
+ * The caller must hold the mutex of the verify batch
+ * Returns 1 if successful or -1 on error
+ */
+int verify_batch_print_entry(
+     verify_batch_t *verify_batch,
+     verify_batch_entry_t *entry,
+     libcerror_error_t **error )
+{
+	uint8_t *buffer       = NULL;
+	static char *function = "verify_batch_print_entry";
+	size_t read_count     = 0;
+
+	if( verify_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verify batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry->output_stream != NULL )
+	{
+		if( file_stream_seek_offset(
+		     entry->output_stream,
+		     0,
+		     SEEK_SET ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek start of output stream.",
+			 function );
+
+			goto on_error;
+		}
+		buffer = (uint8_t *) memory_allocate(
+		                      sizeof( uint8_t ) * VERIFY_BATCH_COPY_BUFFER_SIZE );
+
+		if( buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffer.",
+			 function );
+
+			goto on_error;
+		}
+		do
+		{
+			read_count = file_stream_read(
+			              entry->output_stream,
+			              buffer,
+			              VERIFY_BATCH_COPY_BUFFER_SIZE );
+
+			if( read_count > 0 )
+			{
+				if( file_stream_write(
+				     verify_batch->notify_stream,
+				     buffer,
+				     read_count ) != read_count )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write output.",
+					 function );
+
+					goto on_error;
+				}
+				if( verify_batch->log_handle != NULL )
+				{
+					if( file_stream_write(
+					     verify_batch->log_handle->log_stream,
+					     buffer,
+					     read_count ) != read_count )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_WRITE_FAILED,
+						 "%s: unable to write log.",
+						 function );
+
+						goto on_error;
+					}
+				}
+			}
+		}
+		while( read_count == VERIFY_BATCH_COPY_BUFFER_SIZE );
+
+		memory_free(
+		 buffer );
+
+		buffer = NULL;
+
+		file_stream_close(
+		 entry->output_stream );
+
+		entry->output_stream = NULL;
+	}
+	if( entry->result == 1 )
+	{
+		fprintf(
+		 verify_batch->notify_stream,
+		 "%" PRIs_SYSTEM ": SUCCESS\n\n",
+		 entry->filename );
+	}
+	else
+	{
+		fprintf(
+		 verify_batch->notify_stream,
+		 "%" PRIs_SYSTEM ": FAILURE\n\n",
+		 entry->filename );
+
+		if( ( entry->result == -1 )
+		 && ( verify_batch->abort == 0 ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to verify: %" PRIs_SYSTEM ".\n",
+			 entry->filename );
+
+			if( entry->error != NULL )
+			{
+				libcnotify_print_error_backtrace(
+				 entry->error );
+			}
+		}
+		verify_batch->number_of_failed_entries += 1;
+	}
+	if( verify_batch->log_handle != NULL )
+	{
+		log_handle_printf(
+		 verify_batch->log_handle,
+		 "%" PRIs_SYSTEM ": %s\n\n",
+		 entry->filename,
+		 ( entry->result == 1 ) ? "SUCCESS" : "FAILURE" );
+	}
+	if( entry->error != NULL )
+	{
+		libcerror_error_free(
+		 &( entry->error ) );
+	}
+	return( 1 );
+
+on_error:
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( -1 );
+}
+
+/* Verifies entries until no entries are pending
+ * A worker picks the first pending entry of which the device has a reader available,
+ * if none is available it waits until another worker has finished an entry
+ * Thread function for the workers
+ * Returns 1 if successful or -1 on error
+ */
+int verify_batch_worker_thread_function(
+     verify_batch_worker_t *worker )
+{
+	verify_batch_device_t *device = NULL;
+	verify_batch_entry_t *entry   = NULL;
+	verify_batch_t *verify_batch  = NULL;
+	int entry_index               = 0;
+	int number_of_pending_entries = 0;
+	int result                    = 1;
+
+	if( worker == NULL )
+	{
+		return( -1 );
+	}
+	verify_batch = worker->verify_batch;
+
+	if( verify_batch == NULL )
+	{
+		return( -1 );
+	}
+	while( verify_batch->abort == 0 )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     verify_batch->mutex,
+		     NULL ) != 1 )
+		{
+			return( -1 );
+		}
+#endif
+		entry = NULL;
+
+		while( verify_batch->abort == 0 )
+		{
+			number_of_pending_entries = 0;
+
+			for( entry_index = 0;
+			     entry_index < verify_batch->number_of_entries;
+			     entry_index++ )
+			{
+				if( verify_batch->entries[ entry_index ].is_started != 0 )
+				{
+					continue;
+				}
+				number_of_pending_entries++;
+
+				device = &( verify_batch->devices[ verify_batch->entries[ entry_index ].device_index ] );
+
+				if( device->number_of_readers < verify_batch->maximum_number_of_readers_per_device )
+				{
+					entry = &( verify_batch->entries[ entry_index ] );
+
+					break;
+				}
+			}
+			if( ( entry != NULL )
+			 || ( number_of_pending_entries == 0 ) )
+			{
+				break;
+			}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+			/* The devices of all pending entries are at their maximum number of readers,
+			 * one of which signals the condition when it has finished
+			 */
+			if( libcthreads_condition_wait(
+			     verify_batch->condition,
+			     verify_batch->mutex,
+			     NULL ) != 1 )
+			{
+				result = -1;
+
+				break;
+			}
+#else
+			break;
+#endif
+		}
+		if( entry != NULL )
+		{
+			entry->is_started = 1;
+
+			verify_batch->devices[ entry->device_index ].number_of_readers += 1;
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		libcthreads_mutex_release(
+		 verify_batch->mutex,
+		 NULL );
+#endif
+		if( entry == NULL )
+		{
+			break;
+		}
+		entry->result = verify_batch_process_entry(
+		                 verify_batch,
+		                 entry,
+		                 worker->verification_handle,
+		                 &( entry->error ) );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		libcthreads_mutex_grab(
+		 verify_batch->mutex,
+		 NULL );
+#endif
+		verify_batch->devices[ entry->device_index ].number_of_readers -= 1;
+
+		entry->is_processed = 1;
+
+		if( verify_batch_print_entry(
+		     verify_batch,
+		     entry,
+		     &( entry->error ) ) != 1 )
+		{
+			if( entry->error != NULL )
+			{
+				libcnotify_print_error_backtrace(
+				 entry->error );
+				libcerror_error_free(
+				 &( entry->error ) );
+			}
+			result = -1;
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		libcthreads_condition_broadcast(
+		 verify_batch->condition,
+		 NULL );
+		libcthreads_mutex_release(
+		 verify_batch->mutex,
+		 NULL );
+#endif
+		if( result != 1 )
+		{
+			break;
+		}
+	}
+	return( result );
+}
+
+/* Verifies the images
+ * Every filename is the first segment file of a separate image
+ * Returns 1 if successful, 0 if one or more images are not valid or -1 on error
+ */
+int verify_batch_process(
+     verify_batch_t *verify_batch,
+     system_character_t * const *filenames,
+     int number_of_filenames,
+     log_handle_t *log_handle,
+     libcerror_error_t **error )
+{
+	verify_batch_worker_t *worker      = NULL;
+	static char *function              = "verify_batch_process";
+	uint64_t device_identifier         = 0;
+	int device_index                   = 0;
+	int entry_index                    = 0;
+	int maximum_number_of_open_handles = 0;
+	int result                         = 1;
+	int worker_index                   = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	int number_of_threads              = 0;
+#endif
+
+	if( verify_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verify batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( verify_batch->entries != NULL )
+	 || ( verify_batch->workers != NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid verify batch - already processed.",
+		 function );
+
+		return( -1 );
+	}
+	if( filenames == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filenames.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_filenames <= 0 )
+	 || ( (size_t) number_of_filenames > ( (size_t) SSIZE_MAX / sizeof( verify_batch_entry_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of filenames value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	verify_batch->entries = (verify_batch_entry_t *) memory_allocate(
+	                                                  sizeof( verify_batch_entry_t ) * number_of_filenames );
+
+	if( verify_batch->entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     verify_batch->entries,
+	     0,
+	     sizeof( verify_batch_entry_t ) * number_of_filenames ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entries.",
+		 function );
+
+		goto on_error;
+	}
+	verify_batch->number_of_entries = number_of_filenames;
+
+	/* There are at most as many devices as images
+	 */
+	verify_batch->devices = (verify_batch_device_t *) memory_allocate(
+	                                                   sizeof( verify_batch_device_t ) * number_of_filenames );
+
+	if( verify_batch->devices == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create devices.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     verify_batch->devices,
+	     0,
+	     sizeof( verify_batch_device_t ) * number_of_filenames ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear devices.",
+		 function );
+
+		goto on_error;
+	}
+	verify_batch->number_of_devices        = 0;
+	verify_batch->number_of_failed_entries = 0;
+	verify_batch->log_handle               = log_handle;
+
+	/* Images of which the device cannot be determined are grouped together
+	 */
+	for( entry_index = 0;
+	     entry_index < number_of_filenames;
+	     entry_index++ )
+	{
+		if( verify_batch_get_device_identifier(
+		     filenames[ entry_index ],
+		     &device_identifier,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine device identifier of image: %d.",
+			 function,
+			 entry_index );
+
+			goto on_error;
+		}
+		for( device_index = 0;
+		     device_index < verify_batch->number_of_devices;
+		     device_index++ )
+		{
+			if( verify_batch->devices[ device_index ].identifier == device_identifier )
+			{
+				break;
+			}
+		}
+		if( device_index >= verify_batch->number_of_devices )
+		{
+			verify_batch->devices[ device_index ].identifier = device_identifier;
+
+			verify_batch->number_of_devices += 1;
+		}
+		verify_batch->entries[ entry_index ].filename     = filenames[ entry_index ];
+		verify_batch->entries[ entry_index ].device_index = device_index;
+	}
+	/* Every worker verifies a single image at a time, hence the number of workers
+	 * bounds the number of images that are verified concurrently
+	 */
+	verify_batch->number_of_workers = 1;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verify_batch->number_of_threads > 1 )
+	{
+		verify_batch->number_of_workers = verify_batch->number_of_threads;
+	}
+	number_of_threads = verify_batch->number_of_devices * verify_batch->maximum_number_of_readers_per_device;
+
+	if( verify_batch->number_of_workers > number_of_threads )
+	{
+		verify_batch->number_of_workers = number_of_threads;
+	}
+#endif
+	if( verify_batch->number_of_workers > number_of_filenames )
+	{
+		verify_batch->number_of_workers = number_of_filenames;
+	}
+	verify_batch->workers = (verify_batch_worker_t *) memory_allocate(
+	                                                   sizeof( verify_batch_worker_t ) * verify_batch->number_of_workers );
+
+	if( verify_batch->workers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create workers.",
+		 function );
+
+		verify_batch->number_of_workers = 0;
+
+		goto on_error;
+	}
+	if( memory_set(
+	     verify_batch->workers,
+	     0,
+	     sizeof( verify_batch_worker_t ) * verify_batch->number_of_workers ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear workers.",
+		 function );
+
+		goto on_error;
+	}
+	maximum_number_of_open_handles = verify_batch->maximum_number_of_open_handles
+	                               / verify_batch->number_of_workers;
+
+	for( worker_index = 0;
+	     worker_index < verify_batch->number_of_workers;
+	     worker_index++ )
+	{
+		worker = &( verify_batch->workers[ worker_index ] );
+
+		worker->verify_batch = verify_batch;
+
+		if( verification_handle_initialize(
+		     &( worker->verification_handle ),
+		     verify_batch->calculate_md5,
+		     verify_batch->use_chunk_data_functions,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create verification handle of worker: %d.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+		/* The image is read, decompressed and hashed by the worker itself
+		 * such that the workers are the only threads that use CPU
+		 */
+		worker->verification_handle->number_of_threads   = 0;
+		worker->verification_handle->header_codepage     = verify_batch->header_codepage;
+		worker->verification_handle->process_buffer_size = verify_batch->process_buffer_size;
+
+		if( verify_batch->additional_digest_types != NULL )
+		{
+			if( verification_handle_set_additional_digest_types(
+			     worker->verification_handle,
+			     verify_batch->additional_digest_types,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set additional digest types of worker: %d.",
+				 function,
+				 worker_index );
+
+				goto on_error;
+			}
+		}
+		if( maximum_number_of_open_handles > 0 )
+		{
+			if( verification_handle_set_maximum_number_of_open_handles(
+			     worker->verification_handle,
+			     maximum_number_of_open_handles,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set maximum number of open handles of worker: %d.",
+				 function,
+				 worker_index );
+
+				goto on_error;
+			}
+		}
+	}
+	fprintf(
+	 verify_batch->notify_stream,
+	 "Verifying %d image(s) stored on %d device(s) using %d job(s).\n\n",
+	 verify_batch->number_of_entries,
+	 verify_batch->number_of_devices,
+	 verify_batch->number_of_workers );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verify_batch->number_of_workers > 1 )
+	{
+		for( worker_index = 0;
+		     worker_index < verify_batch->number_of_workers;
+		     worker_index++ )
+		{
+			if( libcthreads_thread_create(
+			     &( verify_batch->workers[ worker_index ].thread ),
+			     NULL,
+			     (int (*)(void *)) &verify_batch_worker_thread_function,
+			     (void *) &( verify_batch->workers[ worker_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create worker: %d thread.",
+				 function,
+				 worker_index );
+
+				goto on_error;
+			}
+		}
+		for( worker_index = 0;
+		     worker_index < verify_batch->number_of_workers;
+		     worker_index++ )
+		{
+			if( libcthreads_thread_join(
+			     &( verify_batch->workers[ worker_index ].thread ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join worker: %d thread.",
+				 function,
+				 worker_index );
+
+				result = -1;
+			}
+		}
+	}
+	else
+#endif
+	{
+		if( verify_batch_worker_thread_function(
+		     &( verify_batch->workers[ 0 ] ) ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to verify images.",
+		 function );
+
+		return( -1 );
+	}
+	if( verify_batch->number_of_failed_entries > 0 )
+	{
+		fprintf(
+		 verify_batch->notify_stream,
+		 "%d of %d image(s) could not be verified.\n\n",
+		 verify_batch->number_of_failed_entries,
+		 verify_batch->number_of_entries );
+
+		return( 0 );
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verify_batch->workers != NULL )
+	{
+		/* Make sure no entry is processed after the entries are freed
+		 */
+		verify_batch->abort = 1;
+
+		libcthreads_condition_broadcast(
+		 verify_batch->condition,
+		 NULL );
+
+		for( worker_index = 0;
+		     worker_index < verify_batch->number_of_workers;
+		     worker_index++ )
+		{
+			if( verify_batch->workers[ worker_index ].thread != NULL )
+			{
+				libcthreads_thread_join(
+				 &( verify_batch->workers[ worker_index ].thread ),
+				 NULL );
+			}
+		}
+	}
+#endif
+	return( -1 );
+}
+
@@ -0,0 +1,277 @@
+/*
+ * Verify batch functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _VERIFY_BATCH_H )
+#define _VERIFY_BATCH_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "log_handle.h"
+#include "verification_handle.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The size of the buffer used to copy the output of an image
+ */
+#define VERIFY_BATCH_COPY_BUFFER_SIZE	( 64 * 1024 )
+
+typedef struct verify_batch verify_batch_t;
+
+typedef struct verify_batch_entry verify_batch_entry_t;
+
+/* The verify batch entry contains the state of a single image
+ */
+struct verify_batch_entry
+{
+	/* The filename of the (first segment file of the) image
+	 */
+	system_character_t *filename;
+
+	/* The index of the device that stores the image
+	 */
+	int device_index;
+
+	/* The output stream, which is a temporary file
+	 */
+	FILE *output_stream;
+
+	/* The result
+	 */
+	int result;
+
+	/* The error
+	 */
+	libcerror_error_t *error;
+
+	/* Value to indicate the entry was started
+	 */
+	uint8_t is_started;
+
+	/* Value to indicate the entry was processed
+	 */
+	uint8_t is_processed;
+};
+
+typedef struct verify_batch_device verify_batch_device_t;
+
+/* The verify batch device contains the state of a storage device
+ */
+struct verify_batch_device
+{
+	/* The identifier, where 0 represents unknown
+	 */
+	uint64_t identifier;
+
+	/* The number of images that are currently read from the device
+	 */
+	int number_of_readers;
+};
+
+typedef struct verify_batch_worker verify_batch_worker_t;
+
+/* The verify batch worker verifies one image at a time
+ */
+struct verify_batch_worker
+{
+	/* The verify batch
+	 */
+	verify_batch_t *verify_batch;
+
+	/* The verification handle, which is reused for every image
+	 */
+	verification_handle_t *verification_handle;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The thread
+	 */
+	libcthreads_thread_t *thread;
+#endif
+};
+
+/* The verify batch verifies multiple images
+ *
+ * The images are grouped by the storage device they are stored on and every device
+ * is read by a bounded number of readers, such that concurrent reads do not turn
+ * sequential I/O into seeks. The images are verified by a single pool of workers,
+ * each of which reads, decompresses and hashes one image at a time, such that the
+ * total CPU usage is bounded by the number of workers regardless of the number of
+ * images or devices. A worker that becomes available picks the first pending image
+ * of which the device has a reader available.
+ *
+ * The output of every image is buffered in a temporary file and copied to the output
+ * stream when the image has been verified
+ */
+struct verify_batch
+{
+	/* Value to indicate if the MD5 digest hash should be calculated
+	 */
+	uint8_t calculate_md5;
+
+	/* Value to indicate if the chunk data instead of the buffered read and write functions should be used
+	 */
+	uint8_t use_chunk_data_functions;
+
+	/* Value to indicate if the sectors of a chunk with a checksum error should be zeroed
+	 */
+	uint8_t zero_chunk_on_error;
+
+	/* The header codepage
+	 */
+	int header_codepage;
+
+	/* The process buffer size
+	 */
+	size_t process_buffer_size;
+
+	/* The additional digest types
+	 */
+	const system_character_t *additional_digest_types;
+
+	/* The maximum number of (concurrent) open file handles
+	 */
+	int maximum_number_of_open_handles;
+
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+	/* The maximum number of images that are read concurrently from the same device
+	 */
+	int maximum_number_of_readers_per_device;
+
+	/* The workers
+	 */
+	verify_batch_worker_t *workers;
+
+	/* The number of workers
+	 */
+	int number_of_workers;
+
+	/* The entries
+	 */
+	verify_batch_entry_t *entries;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The devices
+	 */
+	verify_batch_device_t *devices;
+
+	/* The number of devices
+	 */
+	int number_of_devices;
+
+	/* The number of entries that could not be verified
+	 */
+	int number_of_failed_entries;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* The log handle
+	 */
+	log_handle_t *log_handle;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when an entry was processed
+	 */
+	libcthreads_condition_t *condition;
+#endif
+};
+
+int verify_batch_initialize(
+     verify_batch_t **verify_batch,
+     verification_handle_t *verification_handle,
+     uint8_t zero_chunk_on_error,
+     libcerror_error_t **error );
+
+int verify_batch_free(
+     verify_batch_t **verify_batch,
+     libcerror_error_t **error );
+
+int verify_batch_signal_abort(
+     verify_batch_t *verify_batch,
+     libcerror_error_t **error );
+
+int verify_batch_set_maximum_number_of_readers_per_device(
+     verify_batch_t *verify_batch,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int verify_batch_set_additional_digest_types(
+     verify_batch_t *verify_batch,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int verify_batch_set_maximum_number_of_open_handles(
+     verify_batch_t *verify_batch,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error );
+
+int verify_batch_get_device_identifier(
+     const system_character_t *filename,
+     uint64_t *identifier,
+     libcerror_error_t **error );
+
+int verify_batch_process_entry(
+     verify_batch_t *verify_batch,
+     verify_batch_entry_t *entry,
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error );
+
+int verify_batch_print_entry(
+     verify_batch_t *verify_batch,
+     verify_batch_entry_t *entry,
+     libcerror_error_t **error );
+
+int verify_batch_worker_thread_function(
+     verify_batch_worker_t *worker );
+
+int verify_batch_process(
+     verify_batch_t *verify_batch,
+     system_character_t * const *filenames,
+     int number_of_filenames,
+     log_handle_t *log_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _VERIFY_BATCH_H ) */
+
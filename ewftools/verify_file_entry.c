@@ -0,0 +1,423 @@
+/*
+ * Verify file entry
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libewf.h"
+#include "verify_file_entry.h"
+
+/* Creates a verify file entry
+ * Make sure the value verify_file_entry is referencing, is set to NULL
+ * The verify file entry takes over management of the file entry
+ * Returns 1 if successful or -1 on error
+ */
+int verify_file_entry_initialize(
+     verify_file_entry_t **verify_file_entry,
+     libewf_file_entry_t *file_entry,
+     const system_character_t *path,
+     size_t path_size,
+     libcerror_error_t **error )
+{
+	static char *function = "verify_file_entry_initialize";
+	uint32_t flags        = 0;
+	int result            = 0;
+
+	if( verify_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verify file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *verify_file_entry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid verify file entry value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( path_size == 0 )
+	 || ( path_size > (size_t) ( SSIZE_MAX / sizeof( system_character_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid path size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*verify_file_entry = memory_allocate_structure(
+	                      verify_file_entry_t );
+
+	if( *verify_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create verify file entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *verify_file_entry,
+	     0,
+	     sizeof( verify_file_entry_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear verify file entry.",
+		 function );
+
+		memory_free(
+		 *verify_file_entry );
+
+		*verify_file_entry = NULL;
+
+		return( -1 );
+	}
+	if( libewf_file_entry_get_flags(
+	     file_entry,
+	     &flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve flags.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_file_entry_get_size(
+	     file_entry,
+	     &( ( *verify_file_entry )->size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_file_entry_get_media_data_offset(
+	     file_entry,
+	     &( ( *verify_file_entry )->media_data_offset ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media data offset.",
+		 function );
+
+		goto on_error;
+	}
+	( *verify_file_entry )->duplicate_media_data_offset = -1;
+
+	/* Only sparse data is read from the duplicate media data offset
+	 */
+	if( ( flags & LIBEWF_FILE_ENTRY_FLAG_SPARSE_DATA ) != 0 )
+	{
+		if( libewf_file_entry_get_duplicate_media_data_offset(
+		     file_entry,
+		     &( ( *verify_file_entry )->duplicate_media_data_offset ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve duplicate media data offset.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libewf_file_entry_get_utf16_hash_value_md5(
+		  file_entry,
+		  (uint16_t *) ( *verify_file_entry )->stored_md5_hash_string,
+		  33,
+		  error );
+#else
+	result = libewf_file_entry_get_utf8_hash_value_md5(
+		  file_entry,
+		  (uint8_t *) ( *verify_file_entry )->stored_md5_hash_string,
+		  33,
+		  error );
+#endif
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve stored MD5 hash string.",
+		 function );
+
+		goto on_error;
+	}
+	( *verify_file_entry )->stored_md5_hash_available = result;
+	( *verify_file_entry )->calculate_md5             = (uint8_t) result;
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libewf_file_entry_get_utf16_hash_value_sha1(
+		  file_entry,
+		  (uint16_t *) ( *verify_file_entry )->stored_sha1_hash_string,
+		  41,
+		  error );
+#else
+	result = libewf_file_entry_get_utf8_hash_value_sha1(
+		  file_entry,
+		  (uint8_t *) ( *verify_file_entry )->stored_sha1_hash_string,
+		  41,
+		  error );
+#endif
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve stored SHA1 hash string.",
+		 function );
+
+		goto on_error;
+	}
+	( *verify_file_entry )->stored_sha1_hash_available = result;
+	( *verify_file_entry )->calculate_sha1             = (uint8_t) result;
+
+	( *verify_file_entry )->path = system_string_allocate(
+	                                path_size );
+
+	if( ( *verify_file_entry )->path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create path.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     ( *verify_file_entry )->path,
+	     path,
+	     path_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy path.",
+		 function );
+
+		goto on_error;
+	}
+	( *verify_file_entry )->path[ path_size - 1 ] = 0;
+
+	( *verify_file_entry )->file_entry = file_entry;
+	( *verify_file_entry )->path_size  = path_size;
+
+	return( 1 );
+
+on_error:
+	if( *verify_file_entry != NULL )
+	{
+		if( ( *verify_file_entry )->path != NULL )
+		{
+			memory_free(
+			 ( *verify_file_entry )->path );
+		}
+		memory_free(
+		 *verify_file_entry );
+
+		*verify_file_entry = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a verify file entry
+ * Returns 1 if successful or -1 on error
+ */
+int verify_file_entry_free(
+     verify_file_entry_t **verify_file_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "verify_file_entry_free";
+	int result            = 1;
+
+	if( verify_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verify file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *verify_file_entry != NULL )
+	{
+		if( ( *verify_file_entry )->file_entry != NULL )
+		{
+			if( libewf_file_entry_free(
+			     &( ( *verify_file_entry )->file_entry ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file entry.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *verify_file_entry )->path != NULL )
+		{
+			memory_free(
+			 ( *verify_file_entry )->path );
+		}
+		memory_free(
+		 *verify_file_entry );
+
+		*verify_file_entry = NULL;
+	}
+	return( result );
+}
+
+/* Compares two verify file entries by their media data offset
+ * The arguments are references to verify file entries so that the function can be used with qsort and bsearch
+ * Returns -1 if the first is less than, 0 if equal to or 1 if greater than the second
+ */
+int verify_file_entry_compare_by_media_data_offset(
+     const void *first_verify_file_entry,
+     const void *second_verify_file_entry )
+{
+	const verify_file_entry_t *first_entry  = NULL;
+	const verify_file_entry_t *second_entry = NULL;
+
+	first_entry  = *( (const verify_file_entry_t * const *) first_verify_file_entry );
+	second_entry = *( (const verify_file_entry_t * const *) second_verify_file_entry );
+
+	if( first_entry->media_data_offset < second_entry->media_data_offset )
+	{
+		return( -1 );
+	}
+	else if( first_entry->media_data_offset > second_entry->media_data_offset )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Compares the stored and calculated digest (hash) values of a verify file entry
+ * Returns 1 if the available stored digest (hash) values match, 0 if not or -1 on error
+ */
+int verify_file_entry_compare_hashes(
+     verify_file_entry_t *verify_file_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "verify_file_entry_compare_hashes";
+
+	if( verify_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verify file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( verify_file_entry->stored_md5_hash_available != 0 )
+	{
+		if( system_string_compare(
+		     verify_file_entry->stored_md5_hash_string,
+		     verify_file_entry->calculated_md5_hash_string,
+		     33 ) != 0 )
+		{
+			return( 0 );
+		}
+	}
+	if( verify_file_entry->stored_sha1_hash_available != 0 )
+	{
+		if( system_string_compare(
+		     verify_file_entry->stored_sha1_hash_string,
+		     verify_file_entry->calculated_sha1_hash_string,
+		     41 ) != 0 )
+		{
+			return( 0 );
+		}
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,135 @@
+/*
+ * Verify file entry
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _VERIFY_FILE_ENTRY_H )
+#define _VERIFY_FILE_ENTRY_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libewf.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct verify_file_entry verify_file_entry_t;
+
+/* A (single) file entry of which the data is verified using its stored digest (hash) values
+ */
+struct verify_file_entry
+{
+	/* The file entry
+	 */
+	libewf_file_entry_t *file_entry;
+
+	/* The path
+	 */
+	system_character_t *path;
+
+	/* The path size
+	 */
+	size_t path_size;
+
+	/* The size
+	 */
+	size64_t size;
+
+	/* The media data offset
+	 */
+	off64_t media_data_offset;
+
+	/* The duplicate media data offset, which is -1 if the file entry
+	 * does not duplicate the data of another file entry
+	 */
+	off64_t duplicate_media_data_offset;
+
+	/* Value to indicate if the MD5 digest hash should be calculated
+	 */
+	uint8_t calculate_md5;
+
+	/* Value to indicate a stored MD5 digest hash is available
+	 */
+	int stored_md5_hash_available;
+
+	/* The stored MD5 digest hash string
+	 */
+	system_character_t stored_md5_hash_string[ 33 ];
+
+	/* The calculated MD5 digest hash string
+	 */
+	system_character_t calculated_md5_hash_string[ 33 ];
+
+	/* Value to indicate if the SHA1 digest hash should be calculated
+	 */
+	uint8_t calculate_sha1;
+
+	/* Value to indicate a stored SHA1 digest hash is available
+	 */
+	int stored_sha1_hash_available;
+
+	/* The stored SHA1 digest hash string
+	 */
+	system_character_t stored_sha1_hash_string[ 41 ];
+
+	/* The calculated SHA1 digest hash string
+	 */
+	system_character_t calculated_sha1_hash_string[ 41 ];
+
+	/* The verify file entry of which the data is duplicated by this file entry
+	 */
+	verify_file_entry_t *duplicate_verify_file_entry;
+
+	/* The next verify file entry that is verified by the same thread
+	 */
+	verify_file_entry_t *next_verify_file_entry;
+
+	/* The result of the calculation of the digest (hash) values
+	 */
+	int result;
+};
+
+int verify_file_entry_initialize(
+     verify_file_entry_t **verify_file_entry,
+     libewf_file_entry_t *file_entry,
+     const system_character_t *path,
+     size_t path_size,
+     libcerror_error_t **error );
+
+int verify_file_entry_free(
+     verify_file_entry_t **verify_file_entry,
+     libcerror_error_t **error );
+
+int verify_file_entry_compare_by_media_data_offset(
+     const void *first_verify_file_entry,
+     const void *second_verify_file_entry );
+
+int verify_file_entry_compare_hashes(
+     verify_file_entry_t *verify_file_entry,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _VERIFY_FILE_ENTRY_H ) */
+
@@ -25,6 +25,7 @@
 #include <windows.h>
 #endif
 
+#include "libewf_trace.h"
 #include "libewf_unused.h"
 
 /* Define HAVE_LOCAL_LIBEWF for local use of libewf
@@ -51,6 +52,10 @@ BOOL WINAPI DllMain(
 		case DLL_PROCESS_ATTACH:
 			DisableThreadLibraryCalls(
 			 hinstDLL );
+
+#if defined( HAVE_LIBEWF_TRACE_PROVIDER )
+			libewf_trace_register();
+#endif
 			break;
 
 		case DLL_THREAD_ATTACH:
@@ -60,6 +65,9 @@ BOOL WINAPI DllMain(
 			break;
 
 		case DLL_PROCESS_DETACH:
+#if defined( HAVE_LIBEWF_TRACE_PROVIDER )
+			libewf_trace_unregister();
+#endif
 			break;
 	}
 	return( TRUE );
@@ -0,0 +1,343 @@
+/*
+ * Access advice functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_access_advice.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+
+/* Creates access advice
+ * Make sure the value access_advice is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_access_advice_initialize(
+     libewf_access_advice_t **access_advice,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_access_advice_initialize";
+
+	if( access_advice == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid access advice.",
+		 function );
+
+		return( -1 );
+	}
+	if( *access_advice != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid access advice value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*access_advice = memory_allocate_structure(
+	                  libewf_access_advice_t );
+
+	if( *access_advice == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create access advice.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *access_advice,
+	     0,
+	     sizeof( libewf_access_advice_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear access advice.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *access_advice != NULL )
+	{
+		memory_free(
+		 *access_advice );
+
+		*access_advice = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees access advice
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_access_advice_free(
+     libewf_access_advice_t **access_advice,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_access_advice_free";
+
+	if( access_advice == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid access advice.",
+		 function );
+
+		return( -1 );
+	}
+	if( *access_advice != NULL )
+	{
+		memory_free(
+		 *access_advice );
+
+		*access_advice = NULL;
+	}
+	return( 1 );
+}
+
+/* Sets the advice of a range of chunks
+ * Ranges that are fully covered by the range are removed, since they no longer apply
+ * A range with the normal advice is only retained if it overrides part of another range
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_access_advice_set_range(
+     libewf_access_advice_t *access_advice,
+     uint64_t chunk_index,
+     uint64_t number_of_chunks,
+     int advice,
+     libcerror_error_t **error )
+{
+	libewf_access_advice_range_t *range = NULL;
+	static char *function               = "libewf_access_advice_set_range";
+	uint64_t end_chunk_index            = 0;
+	int move_range_index                = 0;
+	int range_index                     = 0;
+	int result                          = 0;
+
+	if( access_advice == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid access advice.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( access_advice->number_of_ranges < 0 )
+	 || ( access_advice->number_of_ranges > LIBEWF_ACCESS_ADVICE_MAXIMUM_NUMBER_OF_RANGES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid access advice - number of ranges value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( advice != LIBEWF_ACCESS_ADVICE_NORMAL )
+	 && ( advice != LIBEWF_ACCESS_ADVICE_SEQUENTIAL )
+	 && ( advice != LIBEWF_ACCESS_ADVICE_RANDOM )
+	 && ( advice != LIBEWF_ACCESS_ADVICE_WILLNEED )
+	 && ( advice != LIBEWF_ACCESS_ADVICE_DONTNEED ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported advice.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_chunks == 0 )
+	{
+		return( 1 );
+	}
+	if( number_of_chunks > ( (uint64_t) UINT64_MAX - chunk_index ) )
+	{
+		number_of_chunks = (uint64_t) UINT64_MAX - chunk_index;
+	}
+	end_chunk_index = chunk_index + number_of_chunks;
+
+	while( range_index < access_advice->number_of_ranges )
+	{
+		range = &( access_advice->ranges[ range_index ] );
+
+		if( ( range->start_chunk_index >= chunk_index )
+		 && ( range->end_chunk_index <= end_chunk_index ) )
+		{
+			for( move_range_index = range_index + 1;
+			     move_range_index < access_advice->number_of_ranges;
+			     move_range_index++ )
+			{
+				access_advice->ranges[ move_range_index - 1 ] = access_advice->ranges[ move_range_index ];
+			}
+			access_advice->number_of_ranges -= 1;
+
+			continue;
+		}
+		if( ( range->start_chunk_index < end_chunk_index )
+		 && ( range->end_chunk_index > chunk_index ) )
+		{
+			result = 1;
+		}
+		range_index++;
+	}
+	if( ( advice == LIBEWF_ACCESS_ADVICE_NORMAL )
+	 && ( result == 0 ) )
+	{
+		return( 1 );
+	}
+	if( access_advice->number_of_ranges == LIBEWF_ACCESS_ADVICE_MAXIMUM_NUMBER_OF_RANGES )
+	{
+		for( move_range_index = 1;
+		     move_range_index < LIBEWF_ACCESS_ADVICE_MAXIMUM_NUMBER_OF_RANGES;
+		     move_range_index++ )
+		{
+			access_advice->ranges[ move_range_index - 1 ] = access_advice->ranges[ move_range_index ];
+		}
+		access_advice->number_of_ranges -= 1;
+	}
+	range = &( access_advice->ranges[ access_advice->number_of_ranges ] );
+
+	range->start_chunk_index = chunk_index;
+	range->end_chunk_index   = end_chunk_index;
+	range->advice            = advice;
+
+	access_advice->number_of_ranges += 1;
+
+	return( 1 );
+}
+
+/* Retrieves the advice that applies to a specific chunk
+ * The end chunk index is set to the chunk index up to which the advice applies
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_access_advice_get_advice(
+     libewf_access_advice_t *access_advice,
+     uint64_t chunk_index,
+     int *advice,
+     uint64_t *end_chunk_index,
+     libcerror_error_t **error )
+{
+	libewf_access_advice_range_t *range = NULL;
+	static char *function               = "libewf_access_advice_get_advice";
+	uint64_t safe_end_chunk_index       = (uint64_t) UINT64_MAX;
+	int range_index                     = 0;
+
+	if( access_advice == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid access advice.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( access_advice->number_of_ranges < 0 )
+	 || ( access_advice->number_of_ranges > LIBEWF_ACCESS_ADVICE_MAXIMUM_NUMBER_OF_RANGES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid access advice - number of ranges value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( advice == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid advice.",
+		 function );
+
+		return( -1 );
+	}
+	if( end_chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid end chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	*advice = LIBEWF_ACCESS_ADVICE_NORMAL;
+
+	/* The most recent ranges are at the end, a more recent range that starts
+	 * after the chunk bounds the range of the advice
+	 */
+	for( range_index = access_advice->number_of_ranges - 1;
+	     range_index >= 0;
+	     range_index-- )
+	{
+		range = &( access_advice->ranges[ range_index ] );
+
+		if( ( chunk_index >= range->start_chunk_index )
+		 && ( chunk_index < range->end_chunk_index ) )
+		{
+			*advice = range->advice;
+
+			if( range->end_chunk_index < safe_end_chunk_index )
+			{
+				safe_end_chunk_index = range->end_chunk_index;
+			}
+			break;
+		}
+		if( ( range->start_chunk_index > chunk_index )
+		 && ( range->start_chunk_index < safe_end_chunk_index ) )
+		{
+			safe_end_chunk_index = range->start_chunk_index;
+		}
+	}
+	*end_chunk_index = safe_end_chunk_index;
+
+	return( 1 );
+}
+
@@ -0,0 +1,99 @@
+/*
+ * Access advice functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_ACCESS_ADVICE_H )
+#define _LIBEWF_ACCESS_ADVICE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The maximum number of access advice ranges
+ */
+#define LIBEWF_ACCESS_ADVICE_MAXIMUM_NUMBER_OF_RANGES	64
+
+typedef struct libewf_access_advice_range libewf_access_advice_range_t;
+
+struct libewf_access_advice_range
+{
+	/* The start chunk index
+	 */
+	uint64_t start_chunk_index;
+
+	/* The end chunk index, which is the chunk index after the last chunk of the range
+	 */
+	uint64_t end_chunk_index;
+
+	/* The advice
+	 */
+	int advice;
+};
+
+typedef struct libewf_access_advice libewf_access_advice_t;
+
+/* The access advice retains the advice of ranges of chunks in the order
+ * they were given, where the most recent range that contains a chunk applies
+ * When the maximum number of ranges is reached the oldest range is dropped
+ */
+struct libewf_access_advice
+{
+	/* The ranges
+	 */
+	libewf_access_advice_range_t ranges[ LIBEWF_ACCESS_ADVICE_MAXIMUM_NUMBER_OF_RANGES ];
+
+	/* The number of ranges
+	 */
+	int number_of_ranges;
+};
+
+int libewf_access_advice_initialize(
+     libewf_access_advice_t **access_advice,
+     libcerror_error_t **error );
+
+int libewf_access_advice_free(
+     libewf_access_advice_t **access_advice,
+     libcerror_error_t **error );
+
+int libewf_access_advice_set_range(
+     libewf_access_advice_t *access_advice,
+     uint64_t chunk_index,
+     uint64_t number_of_chunks,
+     int advice,
+     libcerror_error_t **error );
+
+int libewf_access_advice_get_advice(
+     libewf_access_advice_t *access_advice,
+     uint64_t chunk_index,
+     int *advice,
+     uint64_t *end_chunk_index,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_ACCESS_ADVICE_H ) */
+
@@ -0,0 +1,398 @@
+/*
+ * Arena allocator functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_arena.h"
+#include "libewf_libcerror.h"
+
+/* The size of the block header, which is a multiple of the alignment of the values
+ */
+#define LIBEWF_ARENA_BLOCK_HEADER_SIZE \
+	( ( sizeof( libewf_arena_block_t ) + 7 ) & ~( (size_t) 7 ) )
+
+/* Creates an arena
+ * Make sure the value arena is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_arena_initialize(
+     libewf_arena_t **arena,
+     size_t block_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_arena_initialize";
+
+	if( arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid arena.",
+		 function );
+
+		return( -1 );
+	}
+	if( *arena != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid arena value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_size < 64 )
+	 || ( block_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*arena = memory_allocate_structure(
+	          libewf_arena_t );
+
+	if( *arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create arena.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *arena,
+	     0,
+	     sizeof( libewf_arena_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear arena.",
+		 function );
+
+		goto on_error;
+	}
+	( *arena )->block_size = block_size;
+
+	return( 1 );
+
+on_error:
+	if( *arena != NULL )
+	{
+		memory_free(
+		 *arena );
+
+		*arena = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an arena and all the values allocated from it
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_arena_free(
+     libewf_arena_t **arena,
+     libcerror_error_t **error )
+{
+	libewf_arena_block_t *block      = NULL;
+	libewf_arena_block_t *next_block = NULL;
+	static char *function            = "libewf_arena_free";
+
+	if( arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid arena.",
+		 function );
+
+		return( -1 );
+	}
+	if( *arena != NULL )
+	{
+		block = ( *arena )->first_block;
+
+		while( block != NULL )
+		{
+			next_block = block->next_block;
+
+			memory_free(
+			 block );
+
+			block = next_block;
+		}
+		memory_free(
+		 *arena );
+
+		*arena = NULL;
+	}
+	return( 1 );
+}
+
+/* Allocates a block in the arena
+ * The data of the block directly follows the block header and is cleared
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_arena_allocate_block(
+     libewf_arena_t *arena,
+     size_t data_size,
+     libewf_arena_block_t **block,
+     libcerror_error_t **error )
+{
+	libewf_arena_block_t *safe_block = NULL;
+	static char *function            = "libewf_arena_allocate_block";
+	size_t block_size                = 0;
+
+	if( arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid arena.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size == 0 )
+	 || ( data_size > ( (size_t) SSIZE_MAX - LIBEWF_ARENA_BLOCK_HEADER_SIZE ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block.",
+		 function );
+
+		return( -1 );
+	}
+	block_size = LIBEWF_ARENA_BLOCK_HEADER_SIZE + data_size;
+
+	safe_block = (libewf_arena_block_t *) memory_allocate(
+	                                       block_size );
+
+	if( safe_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     safe_block,
+	     0,
+	     block_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear block.",
+		 function );
+
+		memory_free(
+		 safe_block );
+
+		return( -1 );
+	}
+	safe_block->data_size = data_size;
+
+	/* The blocks are freed in the order they are linked
+	 */
+	safe_block->next_block = arena->first_block;
+	arena->first_block     = safe_block;
+
+	arena->allocated_size += block_size;
+
+	*block = safe_block;
+
+	return( 1 );
+}
+
+/* Allocates a value in the arena
+ * The value is cleared and aligned to 8 bytes
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_arena_allocate(
+     libewf_arena_t *arena,
+     size_t size,
+     void **data,
+     libcerror_error_t **error )
+{
+	libewf_arena_block_t *block = NULL;
+	static char *function       = "libewf_arena_allocate";
+	size_t aligned_size         = 0;
+
+	if( arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid arena.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size == 0 )
+	 || ( size > ( (size_t) SSIZE_MAX - LIBEWF_ARENA_BLOCK_HEADER_SIZE ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	aligned_size = ( size + 7 ) & ~( (size_t) 7 );
+
+	/* Large values are allocated in a block of their own
+	 * so that they do not waste the remainder of the current block
+	 */
+	if( aligned_size > ( arena->block_size / 4 ) )
+	{
+		if( libewf_arena_allocate_block(
+		     arena,
+		     aligned_size,
+		     &block,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create block.",
+			 function );
+
+			return( -1 );
+		}
+		*data = (void *) &( ( (uint8_t *) block )[ LIBEWF_ARENA_BLOCK_HEADER_SIZE ] );
+
+		return( 1 );
+	}
+	if( ( arena->current_block == NULL )
+	 || ( aligned_size > ( arena->current_block->data_size - arena->current_block_offset ) ) )
+	{
+		if( libewf_arena_allocate_block(
+		     arena,
+		     arena->block_size,
+		     &block,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create block.",
+			 function );
+
+			return( -1 );
+		}
+		arena->current_block        = block;
+		arena->current_block_offset = 0;
+	}
+	*data = (void *) &( ( (uint8_t *) arena->current_block )[ LIBEWF_ARENA_BLOCK_HEADER_SIZE + arena->current_block_offset ] );
+
+	arena->current_block_offset += aligned_size;
+
+	return( 1 );
+}
+
+/* Retrieves the total size of the blocks allocated by the arena
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_arena_get_allocated_size(
+     libewf_arena_t *arena,
+     size64_t *allocated_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_arena_get_allocated_size";
+
+	if( arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid arena.",
+		 function );
+
+		return( -1 );
+	}
+	if( allocated_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocated size.",
+		 function );
+
+		return( -1 );
+	}
+	*allocated_size = arena->allocated_size;
+
+	return( 1 );
+}
+
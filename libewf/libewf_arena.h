@@ -0,0 +1,107 @@
+/*
+ * Arena allocator functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_ARENA_H )
+#define _LIBEWF_ARENA_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_arena_block libewf_arena_block_t;
+
+struct libewf_arena_block
+{
+	/* The next block
+	 */
+	libewf_arena_block_t *next_block;
+
+	/* The data size
+	 */
+	size_t data_size;
+};
+
+typedef struct libewf_arena libewf_arena_t;
+
+/* The arena allocates many small values, such as the single file entries
+ * of a logical image, from a few large blocks. The values cannot be freed
+ * individually and are freed all at once when the arena is freed
+ */
+struct libewf_arena
+{
+	/* The block size
+	 */
+	size_t block_size;
+
+	/* The first block
+	 */
+	libewf_arena_block_t *first_block;
+
+	/* The current block from which values are allocated
+	 */
+	libewf_arena_block_t *current_block;
+
+	/* The offset of the unused data in the current block
+	 */
+	size_t current_block_offset;
+
+	/* The total size of the allocated blocks
+	 */
+	size64_t allocated_size;
+};
+
+int libewf_arena_initialize(
+     libewf_arena_t **arena,
+     size_t block_size,
+     libcerror_error_t **error );
+
+int libewf_arena_free(
+     libewf_arena_t **arena,
+     libcerror_error_t **error );
+
+int libewf_arena_allocate_block(
+     libewf_arena_t *arena,
+     size_t data_size,
+     libewf_arena_block_t **block,
+     libcerror_error_t **error );
+
+int libewf_arena_allocate(
+     libewf_arena_t *arena,
+     size_t size,
+     void **data,
+     libcerror_error_t **error );
+
+int libewf_arena_get_allocated_size(
+     libewf_arena_t *arena,
+     size64_t *allocated_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_ARENA_H ) */
+
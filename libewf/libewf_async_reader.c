@@ -0,0 +1,1268 @@
+/*
+ * Asynchronous segment file reader functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H ) || defined( WINAPI )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H ) || defined( WINAPI )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "libewf_async_reader.h"
+#include "libewf_definitions.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+
+/* Creates an asynchronous reader
+ * Make sure the value async_reader is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_async_reader_initialize(
+     libewf_async_reader_t **async_reader,
+     int maximum_number_of_requests,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_async_reader_initialize";
+	size_t requests_size  = 0;
+
+	if( async_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid async reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( *async_reader != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid async reader value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_requests <= 0 )
+	 || ( maximum_number_of_requests > LIBEWF_ASYNC_READER_MAXIMUM_NUMBER_OF_REQUESTS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of requests value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*async_reader = memory_allocate_structure(
+	                 libewf_async_reader_t );
+
+	if( *async_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create async reader.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *async_reader,
+	     0,
+	     sizeof( libewf_async_reader_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear async reader.",
+		 function );
+
+		memory_free(
+		 *async_reader );
+
+		*async_reader = NULL;
+
+		return( -1 );
+	}
+	requests_size = sizeof( libewf_async_reader_request_t ) * maximum_number_of_requests;
+
+	( *async_reader )->requests = (libewf_async_reader_request_t *) memory_allocate(
+	                                                                 requests_size );
+
+	if( ( *async_reader )->requests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create requests.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *async_reader )->requests,
+	     0,
+	     requests_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear requests.",
+		 function );
+
+		goto on_error;
+	}
+	( *async_reader )->maximum_number_of_requests = maximum_number_of_requests;
+
+	return( 1 );
+
+on_error:
+	if( *async_reader != NULL )
+	{
+		if( ( *async_reader )->requests != NULL )
+		{
+			memory_free(
+			 ( *async_reader )->requests );
+		}
+		memory_free(
+		 *async_reader );
+
+		*async_reader = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an asynchronous reader
+ * Reads that are still in flight are waited for
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_async_reader_free(
+     libewf_async_reader_t **async_reader,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_async_reader_free";
+	int result            = 1;
+
+	if( async_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid async reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( *async_reader != NULL )
+	{
+		if( libewf_async_reader_clear(
+		     *async_reader,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to clear async reader.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 ( *async_reader )->requests );
+
+		memory_free(
+		 *async_reader );
+
+		*async_reader = NULL;
+	}
+	return( result );
+}
+
+/* Clears an asynchronous reader
+ * Reads that are still in flight are waited for, the files are closed and their names removed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_async_reader_clear(
+     libewf_async_reader_t *async_reader,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_async_reader_clear";
+	int file_index        = 0;
+	int result            = 1;
+
+	if( async_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid async reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( async_reader->number_of_requests > 0 )
+	{
+		if( libewf_async_reader_wait(
+		     async_reader,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to wait for reads.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libewf_async_reader_close_files(
+	     async_reader,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close files.",
+		 function );
+
+		result = -1;
+	}
+	if( async_reader->files != NULL )
+	{
+		for( file_index = 0;
+		     file_index < async_reader->number_of_files;
+		     file_index++ )
+		{
+			if( async_reader->files[ file_index ].name != NULL )
+			{
+				memory_free(
+				 async_reader->files[ file_index ].name );
+			}
+#if defined( HAVE_WIDE_CHARACTER_TYPE ) && defined( WINAPI )
+			if( async_reader->files[ file_index ].name_wide != NULL )
+			{
+				memory_free(
+				 async_reader->files[ file_index ].name_wide );
+			}
+#endif
+		}
+		memory_free(
+		 async_reader->files );
+
+		async_reader->files = NULL;
+	}
+	async_reader->number_of_files = 0;
+
+	return( result );
+}
+
+/* Closes the open files of an asynchronous reader
+ * The files are opened again when they are read
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_async_reader_close_files(
+     libewf_async_reader_t *async_reader,
+     libcerror_error_t **error )
+{
+	libewf_async_reader_file_t *file = NULL;
+	static char *function            = "libewf_async_reader_close_files";
+	int file_index                   = 0;
+	int result                       = 1;
+
+	if( async_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid async reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( async_reader->number_of_requests > 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid async reader - reads in flight.",
+		 function );
+
+		return( -1 );
+	}
+	for( file_index = 0;
+	     file_index < async_reader->number_of_files;
+	     file_index++ )
+	{
+		file = &( async_reader->files[ file_index ] );
+
+		if( file->is_open == 0 )
+		{
+			continue;
+		}
+#if defined( WINAPI )
+		if( CloseHandle(
+		     file->file_handle ) == 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 (uint32_t) GetLastError(),
+			 "%s: unable to close file: %d.",
+			 function,
+			 file_index );
+
+			result = -1;
+		}
+		file->file_handle = INVALID_HANDLE_VALUE;
+
+#elif defined( HAVE_LIBEWF_ASYNC_READER_SUPPORT )
+		if( close(
+		     file->file_descriptor ) != 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 errno,
+			 "%s: unable to close file: %d.",
+			 function,
+			 file_index );
+
+			result = -1;
+		}
+		file->file_descriptor = -1;
+#endif
+		file->is_open = 0;
+	}
+	async_reader->number_of_open_files = 0;
+
+	return( result );
+}
+
+/* Retrieves the file of a specific file IO pool entry
+ * The files are resized if necessary
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_async_reader_get_file(
+     libewf_async_reader_t *async_reader,
+     int file_io_pool_entry,
+     libewf_async_reader_file_t **file,
+     libcerror_error_t **error )
+{
+	libewf_async_reader_file_t *files = NULL;
+	static char *function             = "libewf_async_reader_get_file";
+	size_t files_size                 = 0;
+	int file_index                    = 0;
+	int number_of_files               = 0;
+
+	if( async_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid async reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_io_pool_entry < 0 )
+	 || ( file_io_pool_entry == INT_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file IO pool entry value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool_entry >= async_reader->number_of_files )
+	{
+		number_of_files = file_io_pool_entry + 1;
+
+		if( (size_t) number_of_files > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libewf_async_reader_file_t ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of files value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		files_size = sizeof( libewf_async_reader_file_t ) * number_of_files;
+
+		files = (libewf_async_reader_file_t *) memory_reallocate(
+		                                        async_reader->files,
+		                                        files_size );
+
+		if( files == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize files.",
+			 function );
+
+			return( -1 );
+		}
+		async_reader->files = files;
+
+		for( file_index = async_reader->number_of_files;
+		     file_index < number_of_files;
+		     file_index++ )
+		{
+			if( memory_set(
+			     &( files[ file_index ] ),
+			     0,
+			     sizeof( libewf_async_reader_file_t ) ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear file: %d.",
+				 function,
+				 file_index );
+
+				return( -1 );
+			}
+#if defined( WINAPI )
+			files[ file_index ].file_handle = INVALID_HANDLE_VALUE;
+#else
+			files[ file_index ].file_descriptor = -1;
+#endif
+			async_reader->number_of_files += 1;
+		}
+	}
+	*file = &( async_reader->files[ file_io_pool_entry ] );
+
+	return( 1 );
+}
+
+/* Sets the name of the segment file of a specific file IO pool entry
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_async_reader_set_name(
+     libewf_async_reader_t *async_reader,
+     int file_io_pool_entry,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error )
+{
+	libewf_async_reader_file_t *file = NULL;
+	static char *function            = "libewf_async_reader_set_name";
+
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( name_length == 0 )
+	 || ( name_length > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE - 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid name length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_async_reader_get_file(
+	     async_reader,
+	     file_io_pool_entry,
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file: %d.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	if( file->name != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file: %d - name value already set.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	file->name = (char *) memory_allocate(
+	                       sizeof( char ) * ( name_length + 1 ) );
+
+	if( file->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create name.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     file->name,
+	     name,
+	     sizeof( char ) * name_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy name.",
+		 function );
+
+		memory_free(
+		 file->name );
+
+		file->name = NULL;
+
+		return( -1 );
+	}
+	file->name[ name_length ] = 0;
+
+	file->is_unavailable = 0;
+
+	return( 1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE ) && defined( WINAPI )
+
+/* Sets the wide name of the segment file of a specific file IO pool entry
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_async_reader_set_name_wide(
+     libewf_async_reader_t *async_reader,
+     int file_io_pool_entry,
+     const wchar_t *name,
+     size_t name_length,
+     libcerror_error_t **error )
+{
+	libewf_async_reader_file_t *file = NULL;
+	static char *function            = "libewf_async_reader_set_name_wide";
+
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( name_length == 0 )
+	 || ( name_length > (size_t) ( ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( wchar_t ) ) - 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid name length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_async_reader_get_file(
+	     async_reader,
+	     file_io_pool_entry,
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file: %d.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	if( file->name_wide != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file: %d - wide name value already set.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	file->name_wide = (wchar_t *) memory_allocate(
+	                               sizeof( wchar_t ) * ( name_length + 1 ) );
+
+	if( file->name_wide == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create wide name.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     file->name_wide,
+	     name,
+	     sizeof( wchar_t ) * name_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy wide name.",
+		 function );
+
+		memory_free(
+		 file->name_wide );
+
+		file->name_wide = NULL;
+
+		return( -1 );
+	}
+	file->name_wide[ name_length ] = 0;
+
+	file->is_unavailable = 0;
+
+	return( 1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) && defined( WINAPI ) */
+
+/* Opens the segment file of a specific file IO pool entry if not already open
+ * When the maximum number of open files is reached and no reads are in flight
+ * the open files are closed first
+ * Returns 1 if successful, 0 if the file has no name or cannot be opened or -1 on error
+ */
+int libewf_async_reader_open_file(
+     libewf_async_reader_t *async_reader,
+     int file_io_pool_entry,
+     libcerror_error_t **error )
+{
+	libewf_async_reader_file_t *file = NULL;
+	static char *function            = "libewf_async_reader_open_file";
+
+#if defined( WINAPI )
+	HANDLE file_handle               = INVALID_HANDLE_VALUE;
+#elif defined( HAVE_LIBEWF_ASYNC_READER_SUPPORT )
+	int file_descriptor              = -1;
+#endif
+
+	if( async_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid async reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_io_pool_entry < 0 )
+	 || ( file_io_pool_entry >= async_reader->number_of_files ) )
+	{
+		return( 0 );
+	}
+	file = &( async_reader->files[ file_io_pool_entry ] );
+
+	if( file->is_open != 0 )
+	{
+		return( 1 );
+	}
+	if( file->is_unavailable != 0 )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_WIDE_CHARACTER_TYPE ) && defined( WINAPI )
+	if( ( file->name == NULL )
+	 && ( file->name_wide == NULL ) )
+#else
+	if( file->name == NULL )
+#endif
+	{
+		return( 0 );
+	}
+	if( async_reader->number_of_open_files >= LIBEWF_ASYNC_READER_MAXIMUM_NUMBER_OF_OPEN_FILES )
+	{
+		/* The open files cannot be closed while reads are in flight
+		 */
+		if( async_reader->number_of_requests > 0 )
+		{
+			return( 0 );
+		}
+		if( libewf_async_reader_close_files(
+		     async_reader,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close files.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#if defined( WINAPI )
+	/* The file is opened for overlapped I/O so that multiple reads
+	 * can be in flight on the same file object
+	 */
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+	if( file->name_wide != NULL )
+	{
+		file_handle = CreateFileW(
+		               (LPCWSTR) file->name_wide,
+		               GENERIC_READ,
+		               FILE_SHARE_READ | FILE_SHARE_WRITE,
+		               NULL,
+		               OPEN_EXISTING,
+		               FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED,
+		               NULL );
+	}
+	else
+#endif
+	{
+		file_handle = CreateFileA(
+		               (LPCSTR) file->name,
+		               GENERIC_READ,
+		               FILE_SHARE_READ | FILE_SHARE_WRITE,
+		               NULL,
+		               OPEN_EXISTING,
+		               FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED,
+		               NULL );
+	}
+	/* A file that cannot be opened is read through the file IO pool
+	 */
+	if( file_handle == INVALID_HANDLE_VALUE )
+	{
+		file->is_unavailable = 1;
+
+		return( 0 );
+	}
+	file->file_handle = file_handle;
+
+#elif defined( HAVE_LIBEWF_ASYNC_READER_SUPPORT )
+	file_descriptor = open(
+	                   file->name,
+	                   O_RDONLY );
+
+	/* A file that cannot be opened is read through the file IO pool
+	 */
+	if( file_descriptor == -1 )
+	{
+		file->is_unavailable = 1;
+
+		return( 0 );
+	}
+	file->file_descriptor = file_descriptor;
+
+#else
+	file->is_unavailable = 1;
+
+	return( 0 );
+#endif
+#if defined( HAVE_LIBEWF_ASYNC_READER_SUPPORT )
+	file->is_open = 1;
+
+	async_reader->number_of_open_files += 1;
+
+	return( 1 );
+#endif
+}
+
+/* Queues a read of a buffer at a specific offset in the segment file of a file IO pool entry
+ * The read is issued asynchronously if the segment file can be opened by the reader,
+ * otherwise the buffer is read through the file IO pool before the function returns
+ * The buffer must remain valid until libewf_async_reader_wait has returned
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_async_reader_queue_read(
+     libewf_async_reader_t *async_reader,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t offset,
+     uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error )
+{
+	libewf_async_reader_request_t *request = NULL;
+	static char *function                  = "libewf_async_reader_queue_read";
+	ssize_t read_count                     = 0;
+	int result                             = 0;
+
+#if defined( HAVE_LIBEWF_ASYNC_READER_SUPPORT ) && defined( WINAPI )
+	DWORD error_code                       = 0;
+#endif
+
+	if( async_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid async reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( async_reader->number_of_requests >= async_reader->maximum_number_of_requests )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid async reader - maximum number of requests reached.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size == 0 )
+	 || ( size > (size_t) SSIZE_MAX )
+	 || ( (size64_t) size > (size64_t) UINT32_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	request = &( async_reader->requests[ async_reader->number_of_requests ] );
+
+	request->file_io_pool_entry = file_io_pool_entry;
+	request->offset             = offset;
+	request->buffer             = buffer;
+	request->size               = size;
+	request->is_completed       = 0;
+
+#if defined( HAVE_LIBEWF_ASYNC_READER_SUPPORT )
+	result = libewf_async_reader_open_file(
+	          async_reader,
+	          file_io_pool_entry,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file: %d.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+#if defined( WINAPI )
+		if( memory_set(
+		     &( request->overlapped ),
+		     0,
+		     sizeof( OVERLAPPED ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear overlapped.",
+			 function );
+
+			return( -1 );
+		}
+		request->overlapped.Offset     = (DWORD) ( offset & 0xffffffffUL );
+		request->overlapped.OffsetHigh = (DWORD) ( offset >> 32 );
+		request->overlapped.hEvent     = CreateEvent(
+		                                  NULL,
+		                                  TRUE,
+		                                  FALSE,
+		                                  NULL );
+
+		if( request->overlapped.hEvent == NULL )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 (uint32_t) GetLastError(),
+			 "%s: unable to create event.",
+			 function );
+
+			return( -1 );
+		}
+		if( ReadFile(
+		     async_reader->files[ file_io_pool_entry ].file_handle,
+		     buffer,
+		     (DWORD) size,
+		     NULL,
+		     &( request->overlapped ) ) == 0 )
+		{
+			error_code = GetLastError();
+
+			if( error_code != ERROR_IO_PENDING )
+			{
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 (uint32_t) error_code,
+				 "%s: unable to read from file: %d at offset: %" PRIi64 ".",
+				 function,
+				 file_io_pool_entry,
+				 offset );
+
+				CloseHandle(
+				 request->overlapped.hEvent );
+
+				return( -1 );
+			}
+		}
+#else
+		if( memory_set(
+		     &( request->control_block ),
+		     0,
+		     sizeof( struct aiocb ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear control block.",
+			 function );
+
+			return( -1 );
+		}
+		request->control_block.aio_fildes                = async_reader->files[ file_io_pool_entry ].file_descriptor;
+		request->control_block.aio_offset                = (off_t) offset;
+		request->control_block.aio_buf                   = (void *) buffer;
+		request->control_block.aio_nbytes                = size;
+		request->control_block.aio_sigevent.sigev_notify = SIGEV_NONE;
+
+		if( aio_read(
+		     &( request->control_block ) ) != 0 )
+		{
+			/* When the system temporarily lacks the resources to queue the read
+			 * or does not support asynchronous I/O the buffer is read through the file IO pool
+			 */
+			if( ( errno != EAGAIN )
+			 && ( errno != ENOSYS ) )
+			{
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 errno,
+				 "%s: unable to read from file: %d at offset: %" PRIi64 ".",
+				 function,
+				 file_io_pool_entry,
+				 offset );
+
+				return( -1 );
+			}
+			result = 0;
+		}
+#endif /* defined( WINAPI ) */
+	}
+#endif /* defined( HAVE_LIBEWF_ASYNC_READER_SUPPORT ) */
+
+	if( result == 0 )
+	{
+		if( libbfio_pool_seek_offset(
+		     file_io_pool,
+		     file_io_pool_entry,
+		     offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset: %" PRIi64 " in file IO pool entry: %d.",
+			 function,
+			 offset,
+			 file_io_pool_entry );
+
+			return( -1 );
+		}
+		read_count = libbfio_pool_read_buffer(
+		              file_io_pool,
+		              file_io_pool_entry,
+		              buffer,
+		              size,
+		              error );
+
+		if( read_count != (ssize_t) size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer from file IO pool entry: %d at offset: %" PRIi64 ".",
+			 function,
+			 file_io_pool_entry,
+			 offset );
+
+			return( -1 );
+		}
+		request->is_completed = 1;
+	}
+	async_reader->number_of_requests += 1;
+
+	return( 1 );
+}
+
+/* Waits for the queued reads to complete
+ * All reads are waited for, also when one of them fails
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_async_reader_wait(
+     libewf_async_reader_t *async_reader,
+     libcerror_error_t **error )
+{
+	libewf_async_reader_request_t *request = NULL;
+	static char *function                  = "libewf_async_reader_wait";
+	int request_index                      = 0;
+	int result                             = 1;
+
+#if defined( HAVE_LIBEWF_ASYNC_READER_SUPPORT )
+#if defined( WINAPI )
+	DWORD read_count                       = 0;
+#else
+	const struct aiocb *control_blocks[ 1 ];
+
+	ssize_t read_count                     = 0;
+	int error_code                         = 0;
+#endif
+#endif /* defined( HAVE_LIBEWF_ASYNC_READER_SUPPORT ) */
+
+	if( async_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid async reader.",
+		 function );
+
+		return( -1 );
+	}
+	for( request_index = 0;
+	     request_index < async_reader->number_of_requests;
+	     request_index++ )
+	{
+		request = &( async_reader->requests[ request_index ] );
+
+		if( request->is_completed != 0 )
+		{
+			continue;
+		}
+#if defined( HAVE_LIBEWF_ASYNC_READER_SUPPORT )
+#if defined( WINAPI )
+		if( GetOverlappedResult(
+		     async_reader->files[ request->file_io_pool_entry ].file_handle,
+		     &( request->overlapped ),
+		     &read_count,
+		     TRUE ) == 0 )
+		{
+			if( result == 1 )
+			{
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 (uint32_t) GetLastError(),
+				 "%s: unable to read from file: %d at offset: %" PRIi64 ".",
+				 function,
+				 request->file_io_pool_entry,
+				 request->offset );
+			}
+			result = -1;
+		}
+		else if( (size_t) read_count != request->size )
+		{
+			if( result == 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read from file: %d at offset: %" PRIi64 " - short read.",
+				 function,
+				 request->file_io_pool_entry,
+				 request->offset );
+			}
+			result = -1;
+		}
+		CloseHandle(
+		 request->overlapped.hEvent );
+#else
+		control_blocks[ 0 ] = &( request->control_block );
+
+		/* The return value of aio_suspend is not checked since the read
+		 * must have completed before its buffer can be released
+		 */
+		while( aio_error(
+		        &( request->control_block ) ) == EINPROGRESS )
+		{
+			aio_suspend(
+			 control_blocks,
+			 1,
+			 NULL );
+		}
+		error_code = aio_error(
+		              &( request->control_block ) );
+
+		read_count = aio_return(
+		              &( request->control_block ) );
+
+		if( error_code != 0 )
+		{
+			if( result == 1 )
+			{
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 error_code,
+				 "%s: unable to read from file: %d at offset: %" PRIi64 ".",
+				 function,
+				 request->file_io_pool_entry,
+				 request->offset );
+			}
+			result = -1;
+		}
+		else if( read_count != (ssize_t) request->size )
+		{
+			if( result == 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read from file: %d at offset: %" PRIi64 " - short read.",
+				 function,
+				 request->file_io_pool_entry,
+				 request->offset );
+			}
+			result = -1;
+		}
+#endif /* defined( WINAPI ) */
+#endif /* defined( HAVE_LIBEWF_ASYNC_READER_SUPPORT ) */
+
+		request->is_completed = 1;
+	}
+	async_reader->number_of_requests = 0;
+
+	return( result );
+}
+
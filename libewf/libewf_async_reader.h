@@ -0,0 +1,223 @@
+/*
+ * Asynchronous segment file reader functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_ASYNC_READER_H )
+#define _LIBEWF_ASYNC_READER_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_AIO_H ) && !defined( WINAPI )
+#include <aio.h>
+#endif
+
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( WINAPI )
+#define HAVE_LIBEWF_ASYNC_READER_SUPPORT
+#elif defined( HAVE_AIO_H ) && defined( HAVE_AIO_READ ) && defined( HAVE_AIO_SUSPEND ) && defined( HAVE_AIO_ERROR ) && defined( HAVE_AIO_RETURN )
+#define HAVE_LIBEWF_ASYNC_READER_SUPPORT
+#endif
+
+/* The maximum number of reads the asynchronous reader keeps in flight
+ */
+#define LIBEWF_ASYNC_READER_MAXIMUM_NUMBER_OF_REQUESTS	16
+
+/* The maximum number of segment files the asynchronous reader keeps open
+ * in addition to the file IO pool
+ */
+#define LIBEWF_ASYNC_READER_MAXIMUM_NUMBER_OF_OPEN_FILES	32
+
+typedef struct libewf_async_reader_file libewf_async_reader_file_t;
+
+struct libewf_async_reader_file
+{
+	/* The name
+	 */
+	char *name;
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE ) && defined( WINAPI )
+	/* The wide name
+	 */
+	wchar_t *name_wide;
+#endif
+
+#if defined( WINAPI )
+	/* The file handle
+	 */
+	HANDLE file_handle;
+#else
+	/* The file descriptor
+	 */
+	int file_descriptor;
+#endif
+
+	/* Value to indicate the file is open
+	 */
+	uint8_t is_open;
+
+	/* Value to indicate the file could not be opened
+	 */
+	uint8_t is_unavailable;
+};
+
+typedef struct libewf_async_reader_request libewf_async_reader_request_t;
+
+struct libewf_async_reader_request
+{
+	/* The file IO pool entry
+	 */
+	int file_io_pool_entry;
+
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The size
+	 */
+	size_t size;
+
+	/* Value to indicate the read was completed when it was queued
+	 */
+	uint8_t is_completed;
+
+#if defined( HAVE_LIBEWF_ASYNC_READER_SUPPORT )
+#if defined( WINAPI )
+	/* The overlapped
+	 */
+	OVERLAPPED overlapped;
+#else
+	/* The asynchronous I/O control block
+	 */
+	struct aiocb control_block;
+#endif
+#endif /* defined( HAVE_LIBEWF_ASYNC_READER_SUPPORT ) */
+};
+
+typedef struct libewf_async_reader libewf_async_reader_t;
+
+/* The asynchronous reader keeps multiple reads of segment files in flight
+ * without a thread per read, using overlapped I/O on Windows and POSIX
+ * asynchronous I/O otherwise. The segment files are read through separate
+ * read-only handles that are opened by name, a read of a file without a name
+ * or of a file that cannot be opened is read through the file IO pool instead
+ */
+struct libewf_async_reader
+{
+	/* The files
+	 */
+	libewf_async_reader_file_t *files;
+
+	/* The number of files
+	 */
+	int number_of_files;
+
+	/* The number of open files
+	 */
+	int number_of_open_files;
+
+	/* The requests
+	 */
+	libewf_async_reader_request_t *requests;
+
+	/* The maximum number of requests
+	 */
+	int maximum_number_of_requests;
+
+	/* The number of requests
+	 */
+	int number_of_requests;
+};
+
+int libewf_async_reader_initialize(
+     libewf_async_reader_t **async_reader,
+     int maximum_number_of_requests,
+     libcerror_error_t **error );
+
+int libewf_async_reader_free(
+     libewf_async_reader_t **async_reader,
+     libcerror_error_t **error );
+
+int libewf_async_reader_clear(
+     libewf_async_reader_t *async_reader,
+     libcerror_error_t **error );
+
+int libewf_async_reader_close_files(
+     libewf_async_reader_t *async_reader,
+     libcerror_error_t **error );
+
+int libewf_async_reader_get_file(
+     libewf_async_reader_t *async_reader,
+     int file_io_pool_entry,
+     libewf_async_reader_file_t **file,
+     libcerror_error_t **error );
+
+int libewf_async_reader_set_name(
+     libewf_async_reader_t *async_reader,
+     int file_io_pool_entry,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE ) && defined( WINAPI )
+
+int libewf_async_reader_set_name_wide(
+     libewf_async_reader_t *async_reader,
+     int file_io_pool_entry,
+     const wchar_t *name,
+     size_t name_length,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) && defined( WINAPI ) */
+
+int libewf_async_reader_open_file(
+     libewf_async_reader_t *async_reader,
+     int file_io_pool_entry,
+     libcerror_error_t **error );
+
+int libewf_async_reader_queue_read(
+     libewf_async_reader_t *async_reader,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t offset,
+     uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error );
+
+int libewf_async_reader_wait(
+     libewf_async_reader_t *async_reader,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_ASYNC_READER_H ) */
+
@@ -0,0 +1,896 @@
+/*
+ * Buffer pool functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_SYS_MMAN_H )
+#include <sys/mman.h>
+#endif
+
+#include "libewf_buffer_pool.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_unused.h"
+
+/* Creates a buffer pool
+ * Make sure the value buffer_pool is referencing, is set to NULL
+ * The buffer pool is created with 1 reference
+ * If LIBEWF_BUFFER_POOL_FLAG_PREALLOCATE is set all the buffers are allocated at once
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_buffer_pool_initialize(
+     libewf_buffer_pool_t **buffer_pool,
+     size_t buffer_size,
+     int maximum_number_of_buffers,
+     uint8_t flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_buffer_pool_initialize";
+	size_t array_size     = 0;
+
+	if( buffer_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *buffer_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid buffer pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_buffers <= 0 )
+	 || ( maximum_number_of_buffers > 65536 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of buffers value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( flags & ~( LIBEWF_BUFFER_POOL_FLAG_PREALLOCATE | LIBEWF_BUFFER_POOL_FLAG_USE_HUGE_PAGES ) ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported flags.",
+		 function );
+
+		return( -1 );
+	}
+	*buffer_pool = memory_allocate_structure(
+	                libewf_buffer_pool_t );
+
+	if( *buffer_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *buffer_pool,
+	     0,
+	     sizeof( libewf_buffer_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buffer pool.",
+		 function );
+
+		memory_free(
+		 *buffer_pool );
+
+		*buffer_pool = NULL;
+
+		return( -1 );
+	}
+	array_size = sizeof( uint8_t * ) * maximum_number_of_buffers;
+
+	( *buffer_pool )->buffers = (uint8_t **) memory_allocate(
+	                                          array_size );
+
+	if( ( *buffer_pool )->buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffers.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *buffer_pool )->buffers,
+	     0,
+	     array_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buffers.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *buffer_pool )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *buffer_pool )->buffer_size               = buffer_size;
+	( *buffer_pool )->maximum_number_of_buffers = maximum_number_of_buffers;
+	( *buffer_pool )->number_of_references      = 1;
+
+	if( ( flags & LIBEWF_BUFFER_POOL_FLAG_PREALLOCATE ) != 0 )
+	{
+		if( libewf_buffer_pool_allocate_region(
+		     *buffer_pool,
+		     (uint8_t) ( ( flags & LIBEWF_BUFFER_POOL_FLAG_USE_HUGE_PAGES ) != 0 ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to allocate region.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( *buffer_pool != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *buffer_pool )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *buffer_pool )->mutex ),
+			 NULL );
+		}
+#endif
+		if( ( *buffer_pool )->buffers != NULL )
+		{
+			memory_free(
+			 ( *buffer_pool )->buffers );
+		}
+		memory_free(
+		 *buffer_pool );
+
+		*buffer_pool = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a buffer pool
+ * This function frees the buffer pool regardless of the number of references
+ * use libewf_buffer_pool_release for a buffer pool that can be shared
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_buffer_pool_free(
+     libewf_buffer_pool_t **buffer_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_buffer_pool_free";
+	int buffer_index      = 0;
+	int result            = 1;
+
+	if( buffer_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *buffer_pool != NULL )
+	{
+		for( buffer_index = 0;
+		     buffer_index < ( *buffer_pool )->number_of_buffers;
+		     buffer_index++ )
+		{
+			if( libewf_buffer_pool_is_region_buffer(
+			     *buffer_pool,
+			     ( ( *buffer_pool )->buffers )[ buffer_index ] ) == 0 )
+			{
+				memory_free(
+				 ( ( *buffer_pool )->buffers )[ buffer_index ] );
+			}
+		}
+		libewf_buffer_pool_free_region(
+		 *buffer_pool );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *buffer_pool )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 ( *buffer_pool )->buffers );
+
+		memory_free(
+		 *buffer_pool );
+
+		*buffer_pool = NULL;
+	}
+	return( result );
+}
+
+/* Acquires a reference to a buffer pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_buffer_pool_acquire(
+     libewf_buffer_pool_t *buffer_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_buffer_pool_acquire";
+
+	if( buffer_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     buffer_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	buffer_pool->number_of_references += 1;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     buffer_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Releases a reference to a buffer pool
+ * The buffer pool is freed when the last reference is released
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_buffer_pool_release(
+     libewf_buffer_pool_t **buffer_pool,
+     libcerror_error_t **error )
+{
+	static char *function    = "libewf_buffer_pool_release";
+	int number_of_references = 0;
+
+	if( buffer_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *buffer_pool == NULL )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     ( *buffer_pool )->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	( *buffer_pool )->number_of_references -= 1;
+
+	number_of_references = ( *buffer_pool )->number_of_references;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     ( *buffer_pool )->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( number_of_references > 0 )
+	{
+		*buffer_pool = NULL;
+
+		return( 1 );
+	}
+	if( libewf_buffer_pool_free(
+	     buffer_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free buffer pool.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Allocates the region the buffers of the buffer pool are carved from
+ * If huge pages are requested the region is mapped with huge pages, if that
+ * fails the kernel is advised to back the mapping with transparent huge pages
+ * and if mapping is not supported the region is allocated on the heap
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_buffer_pool_allocate_region(
+     libewf_buffer_pool_t *buffer_pool,
+     uint8_t use_huge_pages,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_buffer_pool_allocate_region";
+	size_t region_size    = 0;
+	int buffer_index      = 0;
+	int number_of_buffers = 0;
+
+#if defined( HAVE_LIBEWF_BUFFER_POOL_MAPPED_REGION_SUPPORT ) && defined( MAP_ANONYMOUS )
+	void *region          = NULL;
+#else
+	LIBEWF_UNREFERENCED_PARAMETER( use_huge_pages )
+#endif
+
+	if( buffer_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_pool->region != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid buffer pool - region value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_pool->number_of_buffers != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer pool - number of buffers value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_pool->buffer_size > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / buffer_pool->maximum_number_of_buffers ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid region size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	region_size = buffer_pool->buffer_size * buffer_pool->maximum_number_of_buffers;
+
+#if defined( HAVE_LIBEWF_BUFFER_POOL_MAPPED_REGION_SUPPORT ) && defined( MAP_ANONYMOUS )
+	if( use_huge_pages != 0 )
+	{
+		/* The region is rounded to the huge page size and the remainder is not used
+		 */
+		if( ( region_size % LIBEWF_HUGE_PAGE_SIZE ) != 0 )
+		{
+			region_size += LIBEWF_HUGE_PAGE_SIZE - ( region_size % LIBEWF_HUGE_PAGE_SIZE );
+		}
+		region = MAP_FAILED;
+
+#if defined( MAP_HUGETLB )
+		region = mmap(
+		          NULL,
+		          region_size,
+		          PROT_READ | PROT_WRITE,
+		          MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+		          -1,
+		          0 );
+
+		if( region != MAP_FAILED )
+		{
+			buffer_pool->region_uses_huge_pages = 1;
+		}
+#endif
+		/* Fall back to normal pages if no huge pages are reserved
+		 */
+		if( region == MAP_FAILED )
+		{
+			region = mmap(
+			          NULL,
+			          region_size,
+			          PROT_READ | PROT_WRITE,
+			          MAP_PRIVATE | MAP_ANONYMOUS,
+			          -1,
+			          0 );
+
+#if defined( HAVE_MADVISE ) && defined( MADV_HUGEPAGE )
+			if( region != MAP_FAILED )
+			{
+				/* The advice is only a hint hence a failure is not considered an error
+				 */
+				if( madvise(
+				     region,
+				     region_size,
+				     MADV_HUGEPAGE ) == 0 )
+				{
+					buffer_pool->region_uses_huge_pages = 1;
+				}
+			}
+#endif
+		}
+		if( region != MAP_FAILED )
+		{
+			buffer_pool->region           = (uint8_t *) region;
+			buffer_pool->region_is_mapped = 1;
+		}
+		else
+		{
+			region_size = buffer_pool->buffer_size * buffer_pool->maximum_number_of_buffers;
+		}
+	}
+#endif /* defined( HAVE_LIBEWF_BUFFER_POOL_MAPPED_REGION_SUPPORT ) && defined( MAP_ANONYMOUS ) */
+
+	if( buffer_pool->region == NULL )
+	{
+		buffer_pool->region = (uint8_t *) memory_allocate(
+		                                   sizeof( uint8_t ) * region_size );
+
+		if( buffer_pool->region == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create region.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	buffer_pool->region_size = region_size;
+
+	number_of_buffers = (int) ( region_size / buffer_pool->buffer_size );
+
+	if( number_of_buffers > buffer_pool->maximum_number_of_buffers )
+	{
+		number_of_buffers = buffer_pool->maximum_number_of_buffers;
+	}
+	for( buffer_index = 0;
+	     buffer_index < number_of_buffers;
+	     buffer_index++ )
+	{
+		( buffer_pool->buffers )[ buffer_index ] = &( ( buffer_pool->region )[ buffer_index * buffer_pool->buffer_size ] );
+	}
+	buffer_pool->number_of_buffers = number_of_buffers;
+
+	return( 1 );
+}
+
+/* Frees the region the buffers of the buffer pool are carved from
+ */
+void libewf_buffer_pool_free_region(
+      libewf_buffer_pool_t *buffer_pool )
+{
+	if( buffer_pool == NULL )
+	{
+		return;
+	}
+	if( buffer_pool->region != NULL )
+	{
+#if defined( HAVE_LIBEWF_BUFFER_POOL_MAPPED_REGION_SUPPORT )
+		if( buffer_pool->region_is_mapped != 0 )
+		{
+			munmap(
+			 (void *) buffer_pool->region,
+			 buffer_pool->region_size );
+		}
+		else
+#endif
+		{
+			memory_free(
+			 buffer_pool->region );
+		}
+		buffer_pool->region                 = NULL;
+		buffer_pool->region_size            = 0;
+		buffer_pool->region_is_mapped       = 0;
+		buffer_pool->region_uses_huge_pages = 0;
+	}
+}
+
+/* Determines if a buffer was carved from the region of the buffer pool
+ * Returns 1 if the buffer is part of the region or 0 if not
+ */
+int libewf_buffer_pool_is_region_buffer(
+     libewf_buffer_pool_t *buffer_pool,
+     const uint8_t *buffer )
+{
+	if( ( buffer_pool == NULL )
+	 || ( buffer_pool->region == NULL )
+	 || ( buffer == NULL ) )
+	{
+		return( 0 );
+	}
+	if( ( buffer >= buffer_pool->region )
+	 && ( buffer < &( ( buffer_pool->region )[ buffer_pool->region_size ] ) ) )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Retrieves a buffer from the buffer pool
+ * A retained buffer is reused if available otherwise a new buffer is allocated
+ * The contents of the buffer are undefined
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_buffer_pool_get_buffer(
+     libewf_buffer_pool_t *buffer_pool,
+     uint8_t **buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_buffer_pool_get_buffer";
+
+	if( buffer_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	*buffer = NULL;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     buffer_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( buffer_pool->number_of_buffers > 0 )
+	{
+		buffer_pool->number_of_buffers -= 1;
+
+		*buffer = ( buffer_pool->buffers )[ buffer_pool->number_of_buffers ];
+
+		( buffer_pool->buffers )[ buffer_pool->number_of_buffers ] = NULL;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     buffer_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( *buffer == NULL )
+	{
+		*buffer = (uint8_t *) memory_allocate(
+		                       sizeof( uint8_t ) * buffer_pool->buffer_size );
+
+		if( *buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffer.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+on_error:
+	if( *buffer != NULL )
+	{
+		/* A buffer of the region is freed together with the region
+		 */
+		if( libewf_buffer_pool_is_region_buffer(
+		     buffer_pool,
+		     *buffer ) == 0 )
+		{
+			memory_free(
+			 *buffer );
+		}
+		*buffer = NULL;
+	}
+	return( -1 );
+#endif
+}
+
+/* Returns a buffer to the buffer pool
+ * The buffer is retained for reuse if the maximum number of buffers was not reached
+ * otherwise it is freed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_buffer_pool_return_buffer(
+     libewf_buffer_pool_t *buffer_pool,
+     uint8_t **buffer,
+     libcerror_error_t **error )
+{
+	uint8_t *allocated_buffer = NULL;
+	static char *function     = "libewf_buffer_pool_return_buffer";
+	int buffer_index          = 0;
+
+	if( buffer_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *buffer == NULL )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     buffer_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		if( libewf_buffer_pool_is_region_buffer(
+		     buffer_pool,
+		     *buffer ) == 0 )
+		{
+			memory_free(
+			 *buffer );
+		}
+		*buffer = NULL;
+
+		return( -1 );
+	}
+#endif
+	if( buffer_pool->number_of_buffers < buffer_pool->maximum_number_of_buffers )
+	{
+		( buffer_pool->buffers )[ buffer_pool->number_of_buffers ] = *buffer;
+
+		buffer_pool->number_of_buffers += 1;
+
+		*buffer = NULL;
+	}
+	else if( libewf_buffer_pool_is_region_buffer(
+	          buffer_pool,
+	          *buffer ) != 0 )
+	{
+		/* A buffer of the region must be retained, since the region holds
+		 * the maximum number of buffers a full pool contains at least one
+		 * allocated buffer that can be freed instead
+		 */
+		for( buffer_index = 0;
+		     buffer_index < buffer_pool->number_of_buffers;
+		     buffer_index++ )
+		{
+			if( libewf_buffer_pool_is_region_buffer(
+			     buffer_pool,
+			     ( buffer_pool->buffers )[ buffer_index ] ) == 0 )
+			{
+				allocated_buffer = ( buffer_pool->buffers )[ buffer_index ];
+
+				( buffer_pool->buffers )[ buffer_index ] = *buffer;
+
+				*buffer = allocated_buffer;
+
+				break;
+			}
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     buffer_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( *buffer != NULL )
+	{
+		if( libewf_buffer_pool_is_region_buffer(
+		     buffer_pool,
+		     *buffer ) == 0 )
+		{
+			memory_free(
+			 *buffer );
+		}
+		*buffer = NULL;
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,135 @@
+/*
+ * Buffer pool functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_BUFFER_POOL_H )
+#define _LIBEWF_BUFFER_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_SYS_MMAN_H ) && defined( HAVE_MMAP ) && defined( HAVE_MUNMAP ) && !defined( WINAPI )
+#define HAVE_LIBEWF_BUFFER_POOL_MAPPED_REGION_SUPPORT
+#endif
+
+typedef struct libewf_buffer_pool libewf_buffer_pool_t;
+
+/* The buffer pool retains freed buffers of a fixed size, such as the data
+ * buffers of chunk data, so that these can be reused instead of reallocated
+ */
+struct libewf_buffer_pool
+{
+	/* The size of a buffer
+	 */
+	size_t buffer_size;
+
+	/* The maximum number of buffers that is retained
+	 */
+	int maximum_number_of_buffers;
+
+	/* The retained buffers
+	 */
+	uint8_t **buffers;
+
+	/* The number of retained buffers
+	 */
+	int number_of_buffers;
+
+	/* The number of references to the buffer pool
+	 */
+	int number_of_references;
+
+	/* The preallocated region the buffers are carved from
+	 */
+	uint8_t *region;
+
+	/* The size of the preallocated region
+	 */
+	size_t region_size;
+
+	/* Value to indicate the preallocated region is memory mapped
+	 */
+	uint8_t region_is_mapped;
+
+	/* Value to indicate the preallocated region is backed by huge pages
+	 */
+	uint8_t region_uses_huge_pages;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libewf_buffer_pool_initialize(
+     libewf_buffer_pool_t **buffer_pool,
+     size_t buffer_size,
+     int maximum_number_of_buffers,
+     uint8_t flags,
+     libcerror_error_t **error );
+
+int libewf_buffer_pool_free(
+     libewf_buffer_pool_t **buffer_pool,
+     libcerror_error_t **error );
+
+int libewf_buffer_pool_acquire(
+     libewf_buffer_pool_t *buffer_pool,
+     libcerror_error_t **error );
+
+int libewf_buffer_pool_release(
+     libewf_buffer_pool_t **buffer_pool,
+     libcerror_error_t **error );
+
+int libewf_buffer_pool_allocate_region(
+     libewf_buffer_pool_t *buffer_pool,
+     uint8_t use_huge_pages,
+     libcerror_error_t **error );
+
+void libewf_buffer_pool_free_region(
+      libewf_buffer_pool_t *buffer_pool );
+
+int libewf_buffer_pool_is_region_buffer(
+     libewf_buffer_pool_t *buffer_pool,
+     const uint8_t *buffer );
+
+int libewf_buffer_pool_get_buffer(
+     libewf_buffer_pool_t *buffer_pool,
+     uint8_t **buffer,
+     libcerror_error_t **error );
+
+int libewf_buffer_pool_return_buffer(
+     libewf_buffer_pool_t *buffer_pool,
+     uint8_t **buffer,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_BUFFER_POOL_H ) */
+
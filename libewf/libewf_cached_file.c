@@ -0,0 +1,1780 @@
+/*
+ * Cached file IO handle functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#include "libewf_cached_file.h"
+#include "libewf_definitions.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_unused.h"
+
+/* Creates a cached file IO handle
+ * Make sure the value io_handle is referencing, is set to NULL
+ * The IO handle reads from a clone of the source file IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_cached_file_io_handle_initialize(
+     libewf_cached_file_io_handle_t **io_handle,
+     libbfio_handle_t *source_file_io_handle,
+     size_t block_size,
+     int maximum_number_of_blocks,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_cached_file_io_handle_initialize";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid IO handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_size == 0 )
+	 || ( block_size > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / LIBEWF_CACHED_FILE_MAXIMUM_READ_AHEAD_BLOCKS ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_blocks <= 0 )
+	 || ( (size_t) maximum_number_of_blocks > ( MEMORY_MAXIMUM_ALLOCATION_SIZE / block_size ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of blocks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*io_handle = memory_allocate_structure(
+	              libewf_cached_file_io_handle_t );
+
+	if( *io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *io_handle,
+	     0,
+	     sizeof( libewf_cached_file_io_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear IO handle.",
+		 function );
+
+		memory_free(
+		 *io_handle );
+
+		*io_handle = NULL;
+
+		return( -1 );
+	}
+	if( libbfio_handle_clone(
+	     &( ( *io_handle )->source_file_io_handle ),
+	     source_file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create source file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	( *io_handle )->block_size               = block_size;
+	( *io_handle )->maximum_number_of_blocks = maximum_number_of_blocks;
+
+	return( 1 );
+
+on_error:
+	if( *io_handle != NULL )
+	{
+		memory_free(
+		 *io_handle );
+
+		*io_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a cached file IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_cached_file_io_handle_free(
+     libewf_cached_file_io_handle_t **io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_cached_file_io_handle_free";
+	int result            = 1;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *io_handle != NULL )
+	{
+		if( ( *io_handle )->is_open != 0 )
+		{
+			if( libewf_cached_file_io_handle_close(
+			     *io_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libbfio_handle_free(
+		     &( ( *io_handle )->source_file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free source file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		if( ( *io_handle )->cache_filename != NULL )
+		{
+			memory_free(
+			 ( *io_handle )->cache_filename );
+		}
+		memory_free(
+		 *io_handle );
+
+		*io_handle = NULL;
+	}
+	return( result );
+}
+
+/* Clones (duplicates) the cached file IO handle
+ * The clone is not opened, does not share the cached blocks and does not use the cache file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_cached_file_io_handle_clone(
+     libewf_cached_file_io_handle_t **destination_io_handle,
+     libewf_cached_file_io_handle_t *source_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_cached_file_io_handle_clone";
+
+	if( destination_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: destination IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_io_handle == NULL )
+	{
+		*destination_io_handle = NULL;
+
+		return( 1 );
+	}
+	if( libewf_cached_file_io_handle_initialize(
+	     destination_io_handle,
+	     source_io_handle->source_file_io_handle,
+	     source_io_handle->block_size,
+	     source_io_handle->maximum_number_of_blocks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the cache filename
+ * The blocks that are read from the source are also stored in the cache file,
+ * such that blocks that are no longer retained in memory do not need to be
+ * read from the source again. The cache file is truncated when opened
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_cached_file_io_handle_set_cache_filename(
+     libewf_cached_file_io_handle_t *io_handle,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_cached_file_io_handle_set_cache_filename";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->is_open != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid IO handle - already open.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( filename_length == 0 )
+	 || ( filename_length > (size_t) ( SSIZE_MAX - 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid filename length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->cache_filename != NULL )
+	{
+		memory_free(
+		 io_handle->cache_filename );
+
+		io_handle->cache_filename      = NULL;
+		io_handle->cache_filename_size = 0;
+	}
+	io_handle->cache_filename = narrow_string_allocate(
+	                             filename_length + 1 );
+
+	if( io_handle->cache_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create cache filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     io_handle->cache_filename,
+	     filename,
+	     filename_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy cache filename.",
+		 function );
+
+		memory_free(
+		 io_handle->cache_filename );
+
+		io_handle->cache_filename = NULL;
+
+		return( -1 );
+	}
+	io_handle->cache_filename[ filename_length ] = 0;
+	io_handle->cache_filename_size               = filename_length + 1;
+
+	return( 1 );
+}
+
+/* Opens the cached file IO handle
+ * Only read access is supported
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_cached_file_io_handle_open(
+     libewf_cached_file_io_handle_t *io_handle,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_cached_file_io_handle_open";
+	size_t blocks_size    = 0;
+	int block_index       = 0;
+	int result            = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->is_open != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid IO handle - already open.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( access_flags & LIBBFIO_ACCESS_FLAG_READ ) == 0 )
+	 || ( ( access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access flags.",
+		 function );
+
+		return( -1 );
+	}
+	result = libbfio_handle_is_open(
+	          io_handle->source_file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if source file IO handle is open.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		if( libbfio_handle_open(
+		     io_handle->source_file_io_handle,
+		     LIBBFIO_OPEN_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open source file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		io_handle->source_opened_in_io_handle = 1;
+	}
+	if( libbfio_handle_get_size(
+	     io_handle->source_file_io_handle,
+	     &( io_handle->source_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve source size.",
+		 function );
+
+		goto on_error;
+	}
+	io_handle->number_of_source_blocks = io_handle->source_size / io_handle->block_size;
+
+	if( ( io_handle->source_size % io_handle->block_size ) != 0 )
+	{
+		io_handle->number_of_source_blocks += 1;
+	}
+	blocks_size = sizeof( libewf_cached_file_block_t ) * io_handle->maximum_number_of_blocks;
+
+	io_handle->blocks = (libewf_cached_file_block_t *) memory_allocate(
+	                                                    blocks_size );
+
+	if( io_handle->blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create blocks.",
+		 function );
+
+		goto on_error;
+	}
+	io_handle->blocks_data = (uint8_t *) memory_allocate(
+	                                      io_handle->block_size * io_handle->maximum_number_of_blocks );
+
+	if( io_handle->blocks_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create blocks data.",
+		 function );
+
+		goto on_error;
+	}
+	for( block_index = 0;
+	     block_index < io_handle->maximum_number_of_blocks;
+	     block_index++ )
+	{
+		io_handle->blocks[ block_index ].offset      = -1;
+		io_handle->blocks[ block_index ].data        = &( io_handle->blocks_data[ block_index * io_handle->block_size ] );
+		io_handle->blocks[ block_index ].data_size   = 0;
+		io_handle->blocks[ block_index ].last_access = 0;
+	}
+	io_handle->read_ahead_buffer = (uint8_t *) memory_allocate(
+	                                            io_handle->block_size * LIBEWF_CACHED_FILE_MAXIMUM_READ_AHEAD_BLOCKS );
+
+	if( io_handle->read_ahead_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read-ahead buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( io_handle->cache_filename != NULL )
+	{
+		if( io_handle->number_of_source_blocks > (uint64_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of source blocks value exceeds maximum.",
+			 function );
+
+			goto on_error;
+		}
+		if( io_handle->number_of_source_blocks > 0 )
+		{
+			io_handle->cache_file_blocks = (uint8_t *) memory_allocate(
+			                                            (size_t) io_handle->number_of_source_blocks );
+
+			if( io_handle->cache_file_blocks == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create cache file blocks.",
+				 function );
+
+				goto on_error;
+			}
+			if( memory_set(
+			     io_handle->cache_file_blocks,
+			     0,
+			     (size_t) io_handle->number_of_source_blocks ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear cache file blocks.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( libbfio_file_initialize(
+		     &( io_handle->cache_file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create cache file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbfio_file_set_name(
+		     io_handle->cache_file_io_handle,
+		     io_handle->cache_filename,
+		     io_handle->cache_filename_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set name in cache file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbfio_handle_open(
+		     io_handle->cache_file_io_handle,
+		     LIBBFIO_OPEN_READ_WRITE_TRUNCATE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open cache file.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	io_handle->access_counter              = 0;
+	io_handle->last_source_read_end_offset = -1;
+	io_handle->current_offset              = 0;
+	io_handle->access_flags                = access_flags;
+	io_handle->is_open                     = 1;
+
+	return( 1 );
+
+on_error:
+	if( io_handle->cache_file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &( io_handle->cache_file_io_handle ),
+		 NULL );
+	}
+	if( io_handle->cache_file_blocks != NULL )
+	{
+		memory_free(
+		 io_handle->cache_file_blocks );
+
+		io_handle->cache_file_blocks = NULL;
+	}
+	if( io_handle->read_ahead_buffer != NULL )
+	{
+		memory_free(
+		 io_handle->read_ahead_buffer );
+
+		io_handle->read_ahead_buffer = NULL;
+	}
+	if( io_handle->blocks_data != NULL )
+	{
+		memory_free(
+		 io_handle->blocks_data );
+
+		io_handle->blocks_data = NULL;
+	}
+	if( io_handle->blocks != NULL )
+	{
+		memory_free(
+		 io_handle->blocks );
+
+		io_handle->blocks = NULL;
+	}
+	if( io_handle->source_opened_in_io_handle != 0 )
+	{
+		libbfio_handle_close(
+		 io_handle->source_file_io_handle,
+		 NULL );
+
+		io_handle->source_opened_in_io_handle = 0;
+	}
+	return( -1 );
+}
+
+/* Closes the cached file IO handle
+ * Returns 0 if successful or -1 on error
+ */
+int libewf_cached_file_io_handle_close(
+     libewf_cached_file_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_cached_file_io_handle_close";
+	int result            = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->is_open == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - not open.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: number of source reads: %" PRIu64 ", number of cache file reads: %" PRIu64 ", number of cache hits: %" PRIu64 "\n",
+		 function,
+		 io_handle->number_of_source_reads,
+		 io_handle->number_of_cache_file_reads,
+		 io_handle->number_of_cache_hits );
+	}
+#endif
+	if( io_handle->cache_file_io_handle != NULL )
+	{
+		if( libbfio_handle_close(
+		     io_handle->cache_file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close cache file.",
+			 function );
+
+			result = -1;
+		}
+		if( libbfio_handle_free(
+		     &( io_handle->cache_file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free cache file IO handle.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( io_handle->cache_file_blocks != NULL )
+	{
+		memory_free(
+		 io_handle->cache_file_blocks );
+
+		io_handle->cache_file_blocks = NULL;
+	}
+	if( io_handle->read_ahead_buffer != NULL )
+	{
+		memory_free(
+		 io_handle->read_ahead_buffer );
+
+		io_handle->read_ahead_buffer = NULL;
+	}
+	if( io_handle->blocks_data != NULL )
+	{
+		memory_free(
+		 io_handle->blocks_data );
+
+		io_handle->blocks_data = NULL;
+	}
+	if( io_handle->blocks != NULL )
+	{
+		memory_free(
+		 io_handle->blocks );
+
+		io_handle->blocks = NULL;
+	}
+	if( io_handle->source_opened_in_io_handle != 0 )
+	{
+		if( libbfio_handle_close(
+		     io_handle->source_file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close source file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		io_handle->source_opened_in_io_handle = 0;
+	}
+	io_handle->source_size             = 0;
+	io_handle->number_of_source_blocks = 0;
+	io_handle->current_offset          = 0;
+	io_handle->access_flags            = 0;
+	io_handle->is_open                 = 0;
+
+	return( result );
+}
+
+/* Retrieves the block in memory that contains the data at a specific block offset
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libewf_cached_file_io_handle_get_block(
+     libewf_cached_file_io_handle_t *io_handle,
+     off64_t block_offset,
+     libewf_cached_file_block_t **block,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_cached_file_io_handle_get_block";
+	int block_index       = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing blocks.",
+		 function );
+
+		return( -1 );
+	}
+	if( block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block.",
+		 function );
+
+		return( -1 );
+	}
+	for( block_index = 0;
+	     block_index < io_handle->maximum_number_of_blocks;
+	     block_index++ )
+	{
+		if( io_handle->blocks[ block_index ].offset == block_offset )
+		{
+			*block = &( io_handle->blocks[ block_index ] );
+
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Retrieves a block in memory to read into, which is an unused or the least recently used block
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_cached_file_io_handle_get_free_block(
+     libewf_cached_file_io_handle_t *io_handle,
+     libewf_cached_file_block_t **block,
+     libcerror_error_t **error )
+{
+	libewf_cached_file_block_t *least_recently_used_block = NULL;
+	static char *function                                 = "libewf_cached_file_io_handle_get_free_block";
+	int block_index                                       = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing blocks.",
+		 function );
+
+		return( -1 );
+	}
+	if( block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block.",
+		 function );
+
+		return( -1 );
+	}
+	for( block_index = 0;
+	     block_index < io_handle->maximum_number_of_blocks;
+	     block_index++ )
+	{
+		if( io_handle->blocks[ block_index ].offset == -1 )
+		{
+			least_recently_used_block = &( io_handle->blocks[ block_index ] );
+
+			break;
+		}
+		if( ( least_recently_used_block == NULL )
+		 || ( io_handle->blocks[ block_index ].last_access < least_recently_used_block->last_access ) )
+		{
+			least_recently_used_block = &( io_handle->blocks[ block_index ] );
+		}
+	}
+	io_handle->access_counter += 1;
+
+	least_recently_used_block->offset      = -1;
+	least_recently_used_block->data_size   = 0;
+	least_recently_used_block->last_access = io_handle->access_counter;
+
+	*block = least_recently_used_block;
+
+	return( 1 );
+}
+
+/* Reads the block at a specific block offset into memory
+ * The block is read from the cache file if available, otherwise from the source.
+ * When the source is read sequentially the blocks that follow and are not cached
+ * are read in the same read from the source
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_cached_file_io_handle_read_blocks(
+     libewf_cached_file_io_handle_t *io_handle,
+     off64_t block_offset,
+     libewf_cached_file_block_t **block,
+     libcerror_error_t **error )
+{
+	libewf_cached_file_block_t *read_block = NULL;
+	static char *function                  = "libewf_cached_file_io_handle_read_blocks";
+	size_t block_data_size                 = 0;
+	size_t read_ahead_offset               = 0;
+	size_t read_size                       = 0;
+	ssize_t read_count                     = 0;
+	ssize_t write_count                    = 0;
+	uint64_t block_number                  = 0;
+	off64_t next_block_offset              = 0;
+	int maximum_number_of_read_blocks      = 0;
+	int number_of_read_blocks              = 0;
+	int read_block_index                   = 0;
+	int result                             = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_offset < 0 )
+	 || ( (size64_t) block_offset >= io_handle->source_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block.",
+		 function );
+
+		return( -1 );
+	}
+	block_number = (uint64_t) block_offset / io_handle->block_size;
+
+	if( ( io_handle->cache_file_blocks != NULL )
+	 && ( io_handle->cache_file_blocks[ block_number ] != 0 ) )
+	{
+		if( libewf_cached_file_io_handle_get_free_block(
+		     io_handle,
+		     &read_block,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve free block.",
+			 function );
+
+			return( -1 );
+		}
+		block_data_size = io_handle->block_size;
+
+		if( block_data_size > (size_t) ( io_handle->source_size - block_offset ) )
+		{
+			block_data_size = (size_t) ( io_handle->source_size - block_offset );
+		}
+		if( libbfio_handle_seek_offset(
+		     io_handle->cache_file_io_handle,
+		     block_offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek block offset: 0x%08" PRIx64 " in cache file.",
+			 function,
+			 block_offset );
+
+			return( -1 );
+		}
+		read_count = libbfio_handle_read_buffer(
+		              io_handle->cache_file_io_handle,
+		              read_block->data,
+		              block_data_size,
+		              error );
+
+		if( read_count != (ssize_t) block_data_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read block at offset: 0x%08" PRIx64 " from cache file.",
+			 function,
+			 block_offset );
+
+			return( -1 );
+		}
+		read_block->offset    = block_offset;
+		read_block->data_size = block_data_size;
+
+		io_handle->number_of_cache_file_reads += 1;
+
+		*block = read_block;
+
+		return( 1 );
+	}
+	/* Read ahead when the source is read sequentially
+	 */
+	maximum_number_of_read_blocks = 1;
+
+	if( block_offset == io_handle->last_source_read_end_offset )
+	{
+		maximum_number_of_read_blocks = LIBEWF_CACHED_FILE_MAXIMUM_READ_AHEAD_BLOCKS;
+
+		if( maximum_number_of_read_blocks > io_handle->maximum_number_of_blocks )
+		{
+			maximum_number_of_read_blocks = io_handle->maximum_number_of_blocks;
+		}
+	}
+	next_block_offset = block_offset;
+
+	for( number_of_read_blocks = 0;
+	     number_of_read_blocks < maximum_number_of_read_blocks;
+	     number_of_read_blocks++ )
+	{
+		if( (size64_t) next_block_offset >= io_handle->source_size )
+		{
+			break;
+		}
+		if( number_of_read_blocks > 0 )
+		{
+			/* Stop at the first block that is already cached
+			 */
+			if( ( io_handle->cache_file_blocks != NULL )
+			 && ( io_handle->cache_file_blocks[ block_number + number_of_read_blocks ] != 0 ) )
+			{
+				break;
+			}
+			result = libewf_cached_file_io_handle_get_block(
+			          io_handle,
+			          next_block_offset,
+			          &read_block,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve block at offset: 0x%08" PRIx64 ".",
+				 function,
+				 next_block_offset );
+
+				return( -1 );
+			}
+			else if( result != 0 )
+			{
+				break;
+			}
+		}
+		next_block_offset += (off64_t) io_handle->block_size;
+	}
+	read_size = io_handle->block_size * number_of_read_blocks;
+
+	if( read_size > (size_t) ( io_handle->source_size - block_offset ) )
+	{
+		read_size = (size_t) ( io_handle->source_size - block_offset );
+	}
+	if( libbfio_handle_seek_offset(
+	     io_handle->source_file_io_handle,
+	     block_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek block offset: 0x%08" PRIx64 " in source.",
+		 function,
+		 block_offset );
+
+		return( -1 );
+	}
+	read_count = libbfio_handle_read_buffer(
+	              io_handle->source_file_io_handle,
+	              io_handle->read_ahead_buffer,
+	              read_size,
+	              error );
+
+	if( read_count != (ssize_t) read_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read: %" PRIzd " bytes at offset: 0x%08" PRIx64 " from source.",
+		 function,
+		 read_size,
+		 block_offset );
+
+		return( -1 );
+	}
+	io_handle->number_of_source_reads     += 1;
+	io_handle->last_source_read_end_offset = block_offset + (off64_t) read_size;
+
+	if( io_handle->cache_file_io_handle != NULL )
+	{
+		if( libbfio_handle_seek_offset(
+		     io_handle->cache_file_io_handle,
+		     block_offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek block offset: 0x%08" PRIx64 " in cache file.",
+			 function,
+			 block_offset );
+
+			return( -1 );
+		}
+		write_count = libbfio_handle_write_buffer(
+		               io_handle->cache_file_io_handle,
+		               io_handle->read_ahead_buffer,
+		               read_size,
+		               error );
+
+		if( write_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write: %" PRIzd " bytes at offset: 0x%08" PRIx64 " to cache file.",
+			 function,
+			 read_size,
+			 block_offset );
+
+			return( -1 );
+		}
+	}
+	/* The requested block is stored last so that it is the most recently used
+	 */
+	for( read_block_index = number_of_read_blocks - 1;
+	     read_block_index >= 0;
+	     read_block_index-- )
+	{
+		read_ahead_offset = io_handle->block_size * read_block_index;
+		block_data_size   = read_size - read_ahead_offset;
+
+		if( block_data_size > io_handle->block_size )
+		{
+			block_data_size = io_handle->block_size;
+		}
+		if( libewf_cached_file_io_handle_get_free_block(
+		     io_handle,
+		     &read_block,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve free block.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_copy(
+		     read_block->data,
+		     &( io_handle->read_ahead_buffer[ read_ahead_offset ] ),
+		     block_data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy block data.",
+			 function );
+
+			return( -1 );
+		}
+		read_block->offset    = block_offset + (off64_t) read_ahead_offset;
+		read_block->data_size = block_data_size;
+
+		if( io_handle->cache_file_blocks != NULL )
+		{
+			io_handle->cache_file_blocks[ block_number + read_block_index ] = 1;
+		}
+	}
+	*block = read_block;
+
+	return( 1 );
+}
+
+/* Reads a buffer from the cached file IO handle
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libewf_cached_file_io_handle_read_buffer(
+         libewf_cached_file_io_handle_t *io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	libewf_cached_file_block_t *block = NULL;
+	static char *function             = "libewf_cached_file_io_handle_read_buffer";
+	size_t block_data_offset          = 0;
+	size_t buffer_offset              = 0;
+	size_t read_size                  = 0;
+	off64_t block_offset              = 0;
+	int result                        = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->is_open == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < size )
+	{
+		if( ( io_handle->current_offset < 0 )
+		 || ( (size64_t) io_handle->current_offset >= io_handle->source_size ) )
+		{
+			break;
+		}
+		block_data_offset = (size_t) ( io_handle->current_offset % io_handle->block_size );
+		block_offset      = io_handle->current_offset - (off64_t) block_data_offset;
+
+		result = libewf_cached_file_io_handle_get_block(
+		          io_handle,
+		          block_offset,
+		          &block,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block at offset: 0x%08" PRIx64 ".",
+			 function,
+			 block_offset );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			io_handle->access_counter += 1;
+
+			block->last_access = io_handle->access_counter;
+
+			io_handle->number_of_cache_hits += 1;
+		}
+		else
+		{
+			if( libewf_cached_file_io_handle_read_blocks(
+			     io_handle,
+			     block_offset,
+			     &block,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read block at offset: 0x%08" PRIx64 ".",
+				 function,
+				 block_offset );
+
+				return( -1 );
+			}
+		}
+		if( block_data_offset >= block->data_size )
+		{
+			break;
+		}
+		read_size = block->data_size - block_data_offset;
+
+		if( read_size > ( size - buffer_offset ) )
+		{
+			read_size = size - buffer_offset;
+		}
+		if( memory_copy(
+		     &( buffer[ buffer_offset ] ),
+		     &( block->data[ block_data_offset ] ),
+		     read_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data.",
+			 function );
+
+			return( -1 );
+		}
+		buffer_offset             += read_size;
+		io_handle->current_offset += (off64_t) read_size;
+	}
+	return( (ssize_t) buffer_offset );
+}
+
+/* Writes a buffer to the cached file IO handle
+ * Write access is not supported
+ * Returns -1 on error
+ */
+ssize_t libewf_cached_file_io_handle_write_buffer(
+         libewf_cached_file_io_handle_t *io_handle,
+         const uint8_t *buffer LIBEWF_ATTRIBUTE_UNUSED,
+         size_t size LIBEWF_ATTRIBUTE_UNUSED,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_cached_file_io_handle_write_buffer";
+
+	LIBEWF_UNREFERENCED_PARAMETER( buffer )
+	LIBEWF_UNREFERENCED_PARAMETER( size )
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_IO,
+	 LIBCERROR_IO_ERROR_WRITE_FAILED,
+	 "%s: write access not supported.",
+	 function );
+
+	return( -1 );
+}
+
+/* Seeks a certain offset within the cached file IO handle
+ * Returns the offset if the seek is successful or -1 on error
+ */
+off64_t libewf_cached_file_io_handle_seek_offset(
+         libewf_cached_file_io_handle_t *io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_cached_file_io_handle_seek_offset";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->is_open == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{
+		offset += io_handle->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{
+		offset += (off64_t) io_handle->source_size;
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		return( -1 );
+	}
+	io_handle->current_offset = offset;
+
+	return( offset );
+}
+
+/* Function to determine if the source exists
+ * Returns 1 if the source exists, 0 if not or -1 on error
+ */
+int libewf_cached_file_io_handle_exists(
+     libewf_cached_file_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_cached_file_io_handle_exists";
+	int result            = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = libbfio_handle_exists(
+	          io_handle->source_file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if source exists.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Check if the cached file IO handle is open
+ * Returns 1 if open, 0 if not or -1 on error
+ */
+int libewf_cached_file_io_handle_is_open(
+     libewf_cached_file_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_cached_file_io_handle_is_open";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->is_open == 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the size of the source
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_cached_file_io_handle_get_size(
+     libewf_cached_file_io_handle_t *io_handle,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_cached_file_io_handle_get_size";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->is_open == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	*size = io_handle->source_size;
+
+	return( 1 );
+}
+
+/* Creates a cached file IO handle
+ * The cached file IO handle reads the data of the source file IO handle in blocks
+ * of block size, of which up to the maximum number of blocks are retained in memory
+ * A block size of 0 represents the default block size and a maximum number of
+ * blocks of 0 the default number of blocks
+ * Make sure the value file_io_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_cached_file_initialize(
+     libbfio_handle_t **file_io_handle,
+     libbfio_handle_t *source_file_io_handle,
+     size_t block_size,
+     int maximum_number_of_blocks,
+     libcerror_error_t **error )
+{
+	libewf_cached_file_io_handle_t *io_handle = NULL;
+	static char *function                     = "libewf_cached_file_initialize";
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file IO handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_size == 0 )
+	{
+		block_size = LIBEWF_CACHED_FILE_DEFAULT_BLOCK_SIZE;
+	}
+	if( maximum_number_of_blocks == 0 )
+	{
+		maximum_number_of_blocks = LIBEWF_CACHED_FILE_DEFAULT_NUMBER_OF_BLOCKS;
+	}
+	if( libewf_cached_file_io_handle_initialize(
+	     &io_handle,
+	     source_file_io_handle,
+	     block_size,
+	     maximum_number_of_blocks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create cached file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_initialize(
+	     file_io_handle,
+	     (intptr_t *) io_handle,
+	     (int (*)(intptr_t **, libcerror_error_t **)) libewf_cached_file_io_handle_free,
+	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) libewf_cached_file_io_handle_clone,
+	     (int (*)(intptr_t *, int, libcerror_error_t **)) libewf_cached_file_io_handle_open,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libewf_cached_file_io_handle_close,
+	     (ssize_t (*)(intptr_t *, uint8_t *, size_t, libcerror_error_t **)) libewf_cached_file_io_handle_read_buffer,
+	     (ssize_t (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) libewf_cached_file_io_handle_write_buffer,
+	     (off64_t (*)(intptr_t *, off64_t, int, libcerror_error_t **)) libewf_cached_file_io_handle_seek_offset,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libewf_cached_file_io_handle_exists,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libewf_cached_file_io_handle_is_open,
+	     (int (*)(intptr_t *, size64_t *, libcerror_error_t **)) libewf_cached_file_io_handle_get_size,
+	     LIBBFIO_FLAG_IO_HANDLE_MANAGED | LIBBFIO_FLAG_IO_HANDLE_CLONE_BY_FUNCTION,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( io_handle != NULL )
+	{
+		libewf_cached_file_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Sets the cache filename of the cached file IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_cached_file_set_cache_filename(
+     libbfio_handle_t *file_io_handle,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error )
+{
+	libewf_cached_file_io_handle_t *io_handle = NULL;
+	static char *function                     = "libewf_cached_file_set_cache_filename";
+
+	if( libbfio_handle_get_io_handle(
+	     file_io_handle,
+	     (intptr_t **) &io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cached file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_cached_file_io_handle_set_cache_filename(
+	     io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set cache filename in cached file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
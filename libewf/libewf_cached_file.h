@@ -0,0 +1,264 @@
+/*
+ * Cached file IO handle functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_CACHED_FILE_H )
+#define _LIBEWF_CACHED_FILE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_extern.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The default block size
+ */
+#define LIBEWF_CACHED_FILE_DEFAULT_BLOCK_SIZE		( 1024 * 1024 )
+
+/* The default number of blocks retained in memory
+ */
+#define LIBEWF_CACHED_FILE_DEFAULT_NUMBER_OF_BLOCKS	64
+
+/* The maximum number of consecutive blocks that are read from the source
+ * in a single read when the blocks are accessed sequentially
+ */
+#define LIBEWF_CACHED_FILE_MAXIMUM_READ_AHEAD_BLOCKS	8
+
+typedef struct libewf_cached_file_block libewf_cached_file_block_t;
+
+struct libewf_cached_file_block
+{
+	/* The offset of the block in the source, where -1 represents unused
+	 */
+	off64_t offset;
+
+	/* The data
+	 */
+	uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The value of the access counter of the last access
+	 */
+	uint64_t last_access;
+};
+
+typedef struct libewf_cached_file_io_handle libewf_cached_file_io_handle_t;
+
+/* The cached file IO handle reads the data of a source file IO handle in
+ * blocks that are retained in memory and optionally in a local cache file.
+ * This reduces the number of reads of a source with a high latency per read,
+ * such as a file on a network or object storage, where a miss reads multiple
+ * consecutive blocks at once when the blocks are accessed sequentially
+ */
+struct libewf_cached_file_io_handle
+{
+	/* The source file IO handle
+	 */
+	libbfio_handle_t *source_file_io_handle;
+
+	/* Value to indicate the source file IO handle was opened by the IO handle
+	 */
+	uint8_t source_opened_in_io_handle;
+
+	/* The source size
+	 */
+	size64_t source_size;
+
+	/* The block size
+	 */
+	size_t block_size;
+
+	/* The maximum number of blocks retained in memory
+	 */
+	int maximum_number_of_blocks;
+
+	/* The blocks retained in memory
+	 */
+	libewf_cached_file_block_t *blocks;
+
+	/* The data of the blocks retained in memory
+	 */
+	uint8_t *blocks_data;
+
+	/* The read-ahead buffer
+	 */
+	uint8_t *read_ahead_buffer;
+
+	/* The access counter
+	 */
+	uint64_t access_counter;
+
+	/* The offset of the end of the last block that was read from the source
+	 */
+	off64_t last_source_read_end_offset;
+
+	/* The cache filename
+	 */
+	char *cache_filename;
+
+	/* The cache filename size
+	 */
+	size_t cache_filename_size;
+
+	/* The cache file IO handle
+	 */
+	libbfio_handle_t *cache_file_io_handle;
+
+	/* Values to indicate which blocks are stored in the cache file
+	 */
+	uint8_t *cache_file_blocks;
+
+	/* The number of blocks in the source
+	 */
+	uint64_t number_of_source_blocks;
+
+	/* The number of reads from the source
+	 */
+	uint64_t number_of_source_reads;
+
+	/* The number of blocks read from the cache file
+	 */
+	uint64_t number_of_cache_file_reads;
+
+	/* The number of blocks found in memory
+	 */
+	uint64_t number_of_cache_hits;
+
+	/* The current offset
+	 */
+	off64_t current_offset;
+
+	/* The access flags
+	 */
+	int access_flags;
+
+	/* Value to indicate the file is open
+	 */
+	uint8_t is_open;
+};
+
+int libewf_cached_file_io_handle_initialize(
+     libewf_cached_file_io_handle_t **io_handle,
+     libbfio_handle_t *source_file_io_handle,
+     size_t block_size,
+     int maximum_number_of_blocks,
+     libcerror_error_t **error );
+
+int libewf_cached_file_io_handle_free(
+     libewf_cached_file_io_handle_t **io_handle,
+     libcerror_error_t **error );
+
+int libewf_cached_file_io_handle_clone(
+     libewf_cached_file_io_handle_t **destination_io_handle,
+     libewf_cached_file_io_handle_t *source_io_handle,
+     libcerror_error_t **error );
+
+int libewf_cached_file_io_handle_set_cache_filename(
+     libewf_cached_file_io_handle_t *io_handle,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
+int libewf_cached_file_io_handle_open(
+     libewf_cached_file_io_handle_t *io_handle,
+     int access_flags,
+     libcerror_error_t **error );
+
+int libewf_cached_file_io_handle_close(
+     libewf_cached_file_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
+int libewf_cached_file_io_handle_get_block(
+     libewf_cached_file_io_handle_t *io_handle,
+     off64_t block_offset,
+     libewf_cached_file_block_t **block,
+     libcerror_error_t **error );
+
+int libewf_cached_file_io_handle_get_free_block(
+     libewf_cached_file_io_handle_t *io_handle,
+     libewf_cached_file_block_t **block,
+     libcerror_error_t **error );
+
+int libewf_cached_file_io_handle_read_blocks(
+     libewf_cached_file_io_handle_t *io_handle,
+     off64_t block_offset,
+     libewf_cached_file_block_t **block,
+     libcerror_error_t **error );
+
+ssize_t libewf_cached_file_io_handle_read_buffer(
+         libewf_cached_file_io_handle_t *io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+ssize_t libewf_cached_file_io_handle_write_buffer(
+         libewf_cached_file_io_handle_t *io_handle,
+         const uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+off64_t libewf_cached_file_io_handle_seek_offset(
+         libewf_cached_file_io_handle_t *io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error );
+
+int libewf_cached_file_io_handle_exists(
+     libewf_cached_file_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
+int libewf_cached_file_io_handle_is_open(
+     libewf_cached_file_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
+int libewf_cached_file_io_handle_get_size(
+     libewf_cached_file_io_handle_t *io_handle,
+     size64_t *size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_cached_file_initialize(
+     libbfio_handle_t **file_io_handle,
+     libbfio_handle_t *source_file_io_handle,
+     size_t block_size,
+     int maximum_number_of_blocks,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_cached_file_set_cache_filename(
+     libbfio_handle_t *file_io_handle,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_CACHED_FILE_H ) */
+
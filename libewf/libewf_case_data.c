@@ -288,6 +288,52 @@ int libewf_case_data_generate_utf8_string(
 
 		goto on_error;
 	}
+	/* Date values that could not be converted are generated
+	 */
+	if( acquiry_date_header_value != NULL )
+	{
+		result = libewf_header_values_convert_date_value(
+		          acquiry_date_header_value,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+			 LIBCERROR_CONVERSION_ERROR_GENERIC,
+			 "%s: unable to convert date header value: acquiry_date.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			acquiry_date_header_value = NULL;
+		}
+	}
+	if( system_date_header_value != NULL )
+	{
+		result = libewf_header_values_convert_date_value(
+		          system_date_header_value,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+			 LIBCERROR_CONVERSION_ERROR_GENERIC,
+			 "%s: unable to convert date header value: system_date.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			system_date_header_value = NULL;
+		}
+	}
 	/* Determine the string size
 	 * Reserve space for:
 	 * 1 <newline>
@@ -1873,6 +1919,11 @@ int libewf_case_data_parse_utf8_string(
 						value_string      = (uint8_t *) "bzip2";
 						value_string_size = 6;
 					}
+					else if( value_64bit == 3 )
+					{
+						value_string      = (uint8_t *) "zstd";
+						value_string_size = 5;
+					}
 #if defined( HAVE_DEBUG_OUTPUT )
 					else
 					{
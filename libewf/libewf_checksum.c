@@ -28,13 +28,95 @@
 #endif
 
 #include "libewf_checksum.h"
+#include "libewf_cpu_features.h"
+#include "libewf_deflate.h"
 #include "libewf_libcerror.h"
 #include "libewf_types.h"
 
+#if defined( HAVE_LIBEWF_CHECKSUM_X86_SIMD )
+#include <immintrin.h>
+
+#define LIBEWF_ATTRIBUTE_TARGET_SSSE3	__attribute__ ((target( "ssse3" )))
+#define LIBEWF_ATTRIBUTE_TARGET_AVX2	__attribute__ ((target( "avx2" )))
+
+/* The largest number of bytes for which the Adler-32 sums
+ * cannot overflow a 32-bit integer before the modulo is applied
+ */
+#define LIBEWF_CHECKSUM_ADLER32_NMAX	5552
+
+/* The Adler-32 modulus
+ */
+#define LIBEWF_CHECKSUM_ADLER32_BASE	65521
+
+#endif /* defined( HAVE_LIBEWF_CHECKSUM_X86_SIMD ) */
+
+/* The Adler-32 function selected for the CPU
+ * This is determined on first use, since the selection is idempotent
+ * a concurrent first use only results in the function being selected twice
+ */
+static libewf_checksum_adler32_function_t libewf_checksum_adler32_function = NULL;
+
+/* Retrieves the fastest Adler-32 function supported by the CPU
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_checksum_get_adler32_function(
+     libewf_checksum_adler32_function_t *adler32_function,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_checksum_get_adler32_function";
+	uint32_t cpu_features = 0;
+
+	if( adler32_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid Adler-32 function.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_cpu_features_get(
+	     &cpu_features,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve CPU features.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_CHECKSUM_X86_SIMD )
+	if( ( cpu_features & LIBEWF_CPU_FEATURE_FLAG_AVX2 ) != 0 )
+	{
+		*adler32_function = &libewf_checksum_calculate_adler32_avx2;
+
+		return( 1 );
+	}
+	if( ( cpu_features & LIBEWF_CPU_FEATURE_FLAG_SSSE3 ) != 0 )
+	{
+		*adler32_function = &libewf_checksum_calculate_adler32_ssse3;
+
+		return( 1 );
+	}
+#endif /* defined( HAVE_LIBEWF_CHECKSUM_X86_SIMD ) */
+
 #if defined( HAVE_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) )
+	*adler32_function = &libewf_checksum_calculate_adler32_zlib;
+#else
+	*adler32_function = &libewf_deflate_calculate_adler32;
+#endif
+	return( 1 );
+}
 
 /* Calculates the little-endian Adler-32 of a buffer
  * It uses the initial value to calculate a new Adler-32
+ * The calculation is done by the fastest kernel supported by the CPU,
+ * zlib or the built-in deflate implementation
  * Returns 1 if successful or -1 on error
  */
 int libewf_checksum_calculate_adler32(
@@ -44,7 +126,50 @@ int libewf_checksum_calculate_adler32(
      uint32_t initial_value,
      libcerror_error_t **error )
 {
-	static char *function = "libewf_checksum_calculate_adler32";
+	libewf_checksum_adler32_function_t adler32_function = NULL;
+	static char *function                               = "libewf_checksum_calculate_adler32";
+
+	adler32_function = libewf_checksum_adler32_function;
+
+	if( adler32_function == NULL )
+	{
+		if( libewf_checksum_get_adler32_function(
+		     &adler32_function,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve Adler-32 function.",
+			 function );
+
+			return( -1 );
+		}
+		libewf_checksum_adler32_function = adler32_function;
+	}
+	return( adler32_function(
+	         checksum_value,
+	         buffer,
+	         size,
+	         initial_value,
+	         error ) );
+}
+
+#if defined( HAVE_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) )
+
+/* Calculates the little-endian Adler-32 of a buffer using zlib
+ * It uses the initial value to calculate a new Adler-32
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_checksum_calculate_adler32_zlib(
+     uint32_t *checksum_value,
+     const uint8_t *buffer,
+     size_t size,
+     uint32_t initial_value,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_checksum_calculate_adler32_zlib";
 
 	if( checksum_value == NULL )
 	{
@@ -89,3 +214,270 @@ int libewf_checksum_calculate_adler32(
 
 #endif /* defined( HAVE_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) ) */
 
+#if defined( HAVE_LIBEWF_CHECKSUM_X86_SIMD )
+
+/* Calculates the little-endian Adler-32 of a buffer using SSSE3
+ * It uses the initial value to calculate a new Adler-32
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_ATTRIBUTE_TARGET_SSSE3
+int libewf_checksum_calculate_adler32_ssse3(
+     uint32_t *checksum_value,
+     const uint8_t *buffer,
+     size_t size,
+     uint32_t initial_value,
+     libcerror_error_t **error )
+{
+	__m128i byte_values1    = { 0 };
+	__m128i byte_values2    = { 0 };
+	__m128i ones            = { 0 };
+	__m128i lower_words     = { 0 };
+	__m128i previous_sums   = { 0 };
+	__m128i upper_words     = { 0 };
+	__m128i weights1        = { 0 };
+	__m128i weights2        = { 0 };
+	__m128i zero            = { 0 };
+	static char *function   = "libewf_checksum_calculate_adler32_ssse3";
+	size_t number_of_blocks = 0;
+	uint32_t lower_word     = 0;
+	uint32_t upper_word     = 0;
+	size_t block_index      = 0;
+
+	if( checksum_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checksum value.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	lower_word = initial_value & 0xffff;
+	upper_word = ( initial_value >> 16 ) & 0xffff;
+
+	weights1 = _mm_setr_epi8( 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17 );
+	weights2 = _mm_setr_epi8( 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 );
+	ones     = _mm_set1_epi16( 1 );
+	zero     = _mm_setzero_si128();
+
+	/* Process the buffer in blocks of 32 bytes
+	 */
+	while( size >= 32 )
+	{
+		number_of_blocks = size / 32;
+
+		if( number_of_blocks > ( LIBEWF_CHECKSUM_ADLER32_NMAX / 32 ) )
+		{
+			number_of_blocks = LIBEWF_CHECKSUM_ADLER32_NMAX / 32;
+		}
+		size -= number_of_blocks * 32;
+
+		/* The lower word is added to the upper word for every byte in the blocks
+		 */
+		previous_sums = _mm_set_epi32( 0, 0, 0, (int) ( lower_word * number_of_blocks ) );
+		upper_words   = _mm_set_epi32( 0, 0, 0, (int) upper_word );
+		lower_words   = _mm_setzero_si128();
+
+		for( block_index = 0;
+		     block_index < number_of_blocks;
+		     block_index++ )
+		{
+			byte_values1 = _mm_loadu_si128( (const __m128i *) buffer );
+			byte_values2 = _mm_loadu_si128( (const __m128i *) &( buffer[ 16 ] ) );
+
+			previous_sums = _mm_add_epi32( previous_sums, lower_words );
+
+			lower_words = _mm_add_epi32( lower_words, _mm_sad_epu8( byte_values1, zero ) );
+			upper_words = _mm_add_epi32( upper_words, _mm_madd_epi16( _mm_maddubs_epi16( byte_values1, weights1 ), ones ) );
+
+			lower_words = _mm_add_epi32( lower_words, _mm_sad_epu8( byte_values2, zero ) );
+			upper_words = _mm_add_epi32( upper_words, _mm_madd_epi16( _mm_maddubs_epi16( byte_values2, weights2 ), ones ) );
+
+			buffer += 32;
+		}
+		upper_words = _mm_add_epi32( upper_words, _mm_slli_epi32( previous_sums, 5 ) );
+
+		lower_words = _mm_add_epi32( lower_words, _mm_shuffle_epi32( lower_words, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+		lower_words = _mm_add_epi32( lower_words, _mm_shuffle_epi32( lower_words, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+		upper_words = _mm_add_epi32( upper_words, _mm_shuffle_epi32( upper_words, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+		upper_words = _mm_add_epi32( upper_words, _mm_shuffle_epi32( upper_words, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+
+		lower_word += (uint32_t) _mm_cvtsi128_si32( lower_words );
+		upper_word  = (uint32_t) _mm_cvtsi128_si32( upper_words );
+
+		lower_word %= LIBEWF_CHECKSUM_ADLER32_BASE;
+		upper_word %= LIBEWF_CHECKSUM_ADLER32_BASE;
+	}
+	while( size > 0 )
+	{
+		lower_word += *buffer;
+		upper_word += lower_word;
+
+		buffer++;
+		size--;
+	}
+	lower_word %= LIBEWF_CHECKSUM_ADLER32_BASE;
+	upper_word %= LIBEWF_CHECKSUM_ADLER32_BASE;
+
+	*checksum_value = ( upper_word << 16 ) | lower_word;
+
+	return( 1 );
+}
+
+/* Calculates the little-endian Adler-32 of a buffer using AVX2
+ * It uses the initial value to calculate a new Adler-32
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_ATTRIBUTE_TARGET_AVX2
+int libewf_checksum_calculate_adler32_avx2(
+     uint32_t *checksum_value,
+     const uint8_t *buffer,
+     size_t size,
+     uint32_t initial_value,
+     libcerror_error_t **error )
+{
+	__m256i byte_values     = { 0 };
+	__m256i ones            = { 0 };
+	__m256i lower_words     = { 0 };
+	__m256i previous_sums   = { 0 };
+	__m256i upper_words     = { 0 };
+	__m256i weights         = { 0 };
+	__m256i zero            = { 0 };
+	__m128i lower_sums      = { 0 };
+	__m128i upper_sums      = { 0 };
+	static char *function   = "libewf_checksum_calculate_adler32_avx2";
+	size_t number_of_blocks = 0;
+	uint32_t lower_word     = 0;
+	uint32_t upper_word     = 0;
+	size_t block_index      = 0;
+
+	if( checksum_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checksum value.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	lower_word = initial_value & 0xffff;
+	upper_word = ( initial_value >> 16 ) & 0xffff;
+
+	weights = _mm256_setr_epi8( 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+	                            16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 );
+	ones    = _mm256_set1_epi16( 1 );
+	zero    = _mm256_setzero_si256();
+
+	/* Process the buffer in blocks of 32 bytes
+	 */
+	while( size >= 32 )
+	{
+		number_of_blocks = size / 32;
+
+		if( number_of_blocks > ( LIBEWF_CHECKSUM_ADLER32_NMAX / 32 ) )
+		{
+			number_of_blocks = LIBEWF_CHECKSUM_ADLER32_NMAX / 32;
+		}
+		size -= number_of_blocks * 32;
+
+		/* The lower word is added to the upper word for every byte in the blocks
+		 */
+		previous_sums = _mm256_set_epi32( 0, 0, 0, 0, 0, 0, 0, (int) ( lower_word * number_of_blocks ) );
+		upper_words   = _mm256_set_epi32( 0, 0, 0, 0, 0, 0, 0, (int) upper_word );
+		lower_words   = _mm256_setzero_si256();
+
+		for( block_index = 0;
+		     block_index < number_of_blocks;
+		     block_index++ )
+		{
+			byte_values = _mm256_loadu_si256( (const __m256i *) buffer );
+
+			previous_sums = _mm256_add_epi32( previous_sums, lower_words );
+
+			lower_words = _mm256_add_epi32( lower_words, _mm256_sad_epu8( byte_values, zero ) );
+			upper_words = _mm256_add_epi32( upper_words, _mm256_madd_epi16( _mm256_maddubs_epi16( byte_values, weights ), ones ) );
+
+			buffer += 32;
+		}
+		upper_words = _mm256_add_epi32( upper_words, _mm256_slli_epi32( previous_sums, 5 ) );
+
+		lower_sums = _mm_add_epi32( _mm256_castsi256_si128( lower_words ), _mm256_extracti128_si256( lower_words, 1 ) );
+		upper_sums = _mm_add_epi32( _mm256_castsi256_si128( upper_words ), _mm256_extracti128_si256( upper_words, 1 ) );
+
+		lower_sums = _mm_add_epi32( lower_sums, _mm_shuffle_epi32( lower_sums, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+		lower_sums = _mm_add_epi32( lower_sums, _mm_shuffle_epi32( lower_sums, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+		upper_sums = _mm_add_epi32( upper_sums, _mm_shuffle_epi32( upper_sums, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+		upper_sums = _mm_add_epi32( upper_sums, _mm_shuffle_epi32( upper_sums, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+
+		lower_word += (uint32_t) _mm_cvtsi128_si32( lower_sums );
+		upper_word  = (uint32_t) _mm_cvtsi128_si32( upper_sums );
+
+		lower_word %= LIBEWF_CHECKSUM_ADLER32_BASE;
+		upper_word %= LIBEWF_CHECKSUM_ADLER32_BASE;
+	}
+	while( size > 0 )
+	{
+		lower_word += *buffer;
+		upper_word += lower_word;
+
+		buffer++;
+		size--;
+	}
+	lower_word %= LIBEWF_CHECKSUM_ADLER32_BASE;
+	upper_word %= LIBEWF_CHECKSUM_ADLER32_BASE;
+
+	*checksum_value = ( upper_word << 16 ) | lower_word;
+
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_CHECKSUM_X86_SIMD ) */
+
@@ -32,7 +32,23 @@
 extern "C" {
 #endif
 
-#if defined( HAVE_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) )
+/* The SSSE3 and AVX2 Adler-32 kernels require compiler support for
+ * function specific target options and run-time CPU feature detection
+ */
+#if ( defined( __x86_64__ ) || defined( __i386__ ) ) && ( defined( __clang__ ) || ( defined( __GNUC__ ) && ( __GNUC__ >= 5 ) ) )
+#define HAVE_LIBEWF_CHECKSUM_X86_SIMD	1
+#endif
+
+typedef int (*libewf_checksum_adler32_function_t)(
+               uint32_t *checksum_value,
+               const uint8_t *buffer,
+               size_t size,
+               uint32_t initial_value,
+               libcerror_error_t **error );
+
+int libewf_checksum_get_adler32_function(
+     libewf_checksum_adler32_function_t *adler32_function,
+     libcerror_error_t **error );
 
 int libewf_checksum_calculate_adler32(
      uint32_t *checksum_value,
@@ -41,12 +57,35 @@ int libewf_checksum_calculate_adler32(
      uint32_t initial_value,
      libcerror_error_t **error );
 
-#else
-#define libewf_checksum_calculate_adler32( checksum_value, buffer, size, initial_value, error ) \
-	libewf_deflate_calculate_adler32( checksum_value, buffer, size, initial_value, error )
+#if defined( HAVE_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) )
+
+int libewf_checksum_calculate_adler32_zlib(
+     uint32_t *checksum_value,
+     const uint8_t *buffer,
+     size_t size,
+     uint32_t initial_value,
+     libcerror_error_t **error );
 
 #endif /* defined( HAVE_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) ) */
 
+#if defined( HAVE_LIBEWF_CHECKSUM_X86_SIMD )
+
+int libewf_checksum_calculate_adler32_ssse3(
+     uint32_t *checksum_value,
+     const uint8_t *buffer,
+     size_t size,
+     uint32_t initial_value,
+     libcerror_error_t **error );
+
+int libewf_checksum_calculate_adler32_avx2(
+     uint32_t *checksum_value,
+     const uint8_t *buffer,
+     size_t size,
+     uint32_t initial_value,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_CHECKSUM_X86_SIMD ) */
+
 #if defined( __cplusplus )
 }
 #endif
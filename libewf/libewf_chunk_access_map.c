@@ -0,0 +1,855 @@
+/*
+ * Chunk access map functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <byte_stream.h>
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_access_map.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+
+const uint8_t libewf_chunk_access_map_file_signature[ 8 ] = {
+	'e', 'w', 'f', 'c', 'a', 'm', 'a', 'p' };
+
+/* Creates a chunk access map
+ * Make sure the value chunk_access_map is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_access_map_initialize(
+     libewf_chunk_access_map_t **chunk_access_map,
+     uint64_t number_of_chunks,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_access_map_initialize";
+	uint64_t bitmap_size  = 0;
+
+	if( chunk_access_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk access map.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_access_map != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk access map value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_chunks == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of chunks value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	bitmap_size = number_of_chunks / 8;
+
+	if( ( number_of_chunks % 8 ) != 0 )
+	{
+		bitmap_size += 1;
+	}
+	if( bitmap_size > (uint64_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of chunks value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	*chunk_access_map = memory_allocate_structure(
+	                     libewf_chunk_access_map_t );
+
+	if( *chunk_access_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk access map.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *chunk_access_map,
+	     0,
+	     sizeof( libewf_chunk_access_map_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk access map.",
+		 function );
+
+		memory_free(
+		 *chunk_access_map );
+
+		*chunk_access_map = NULL;
+
+		return( -1 );
+	}
+	( *chunk_access_map )->bitmap = (uint8_t *) memory_allocate(
+	                                             (size_t) bitmap_size );
+
+	if( ( *chunk_access_map )->bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create bitmap.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *chunk_access_map )->bitmap,
+	     0,
+	     (size_t) bitmap_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear bitmap.",
+		 function );
+
+		goto on_error;
+	}
+	( *chunk_access_map )->number_of_chunks = number_of_chunks;
+	( *chunk_access_map )->bitmap_size      = (size_t) bitmap_size;
+
+	return( 1 );
+
+on_error:
+	if( *chunk_access_map != NULL )
+	{
+		if( ( *chunk_access_map )->bitmap != NULL )
+		{
+			memory_free(
+			 ( *chunk_access_map )->bitmap );
+		}
+		memory_free(
+		 *chunk_access_map );
+
+		*chunk_access_map = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a chunk access map
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_access_map_free(
+     libewf_chunk_access_map_t **chunk_access_map,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_access_map_free";
+
+	if( chunk_access_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk access map.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_access_map != NULL )
+	{
+		memory_free(
+		 ( *chunk_access_map )->bitmap );
+
+		memory_free(
+		 *chunk_access_map );
+
+		*chunk_access_map = NULL;
+	}
+	return( 1 );
+}
+
+/* Marks a range of chunks as accessed
+ * The range is truncated to the number of chunks of the map
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_access_map_set_chunk_range(
+     libewf_chunk_access_map_t *chunk_access_map,
+     uint64_t chunk_index,
+     uint64_t number_of_chunks,
+     libcerror_error_t **error )
+{
+	static char *function    = "libewf_chunk_access_map_set_chunk_range";
+	uint64_t end_chunk_index = 0;
+	uint8_t bit_mask         = 0;
+
+	if( chunk_access_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk access map.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index >= chunk_access_map->number_of_chunks )
+	{
+		return( 1 );
+	}
+	if( number_of_chunks > ( chunk_access_map->number_of_chunks - chunk_index ) )
+	{
+		number_of_chunks = chunk_access_map->number_of_chunks - chunk_index;
+	}
+	end_chunk_index = chunk_index + number_of_chunks;
+
+	while( chunk_index < end_chunk_index )
+	{
+		bit_mask = (uint8_t) ( 1 << ( chunk_index % 8 ) );
+
+		if( ( chunk_access_map->bitmap[ chunk_index / 8 ] & bit_mask ) == 0 )
+		{
+			chunk_access_map->bitmap[ chunk_index / 8 ] |= bit_mask;
+
+			chunk_access_map->number_of_accessed_chunks += 1;
+		}
+		chunk_index++;
+	}
+	return( 1 );
+}
+
+/* Retrieves the index of the first accessed chunk at or after a specific chunk index
+ * Returns 1 if successful, 0 if no such chunk or -1 on error
+ */
+int libewf_chunk_access_map_get_next_chunk_index(
+     libewf_chunk_access_map_t *chunk_access_map,
+     uint64_t chunk_index,
+     uint64_t *next_chunk_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_access_map_get_next_chunk_index";
+	size_t bitmap_index   = 0;
+	uint8_t bitmap_value  = 0;
+
+	if( chunk_access_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk access map.",
+		 function );
+
+		return( -1 );
+	}
+	if( next_chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid next chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index >= chunk_access_map->number_of_chunks )
+	{
+		return( 0 );
+	}
+	bitmap_index = (size_t) ( chunk_index / 8 );
+	bitmap_value = chunk_access_map->bitmap[ bitmap_index ] >> ( chunk_index % 8 );
+
+	/* Bytes without accessed chunks are skipped as a whole
+	 */
+	while( bitmap_value == 0 )
+	{
+		bitmap_index++;
+
+		if( bitmap_index >= chunk_access_map->bitmap_size )
+		{
+			return( 0 );
+		}
+		bitmap_value = chunk_access_map->bitmap[ bitmap_index ];
+		chunk_index  = (uint64_t) bitmap_index * 8;
+	}
+	while( ( bitmap_value & 0x01 ) == 0 )
+	{
+		bitmap_value >>= 1;
+		chunk_index   += 1;
+	}
+	if( chunk_index >= chunk_access_map->number_of_chunks )
+	{
+		return( 0 );
+	}
+	*next_chunk_index = chunk_index;
+
+	return( 1 );
+}
+
+/* Reads the chunk access map from a file
+ * Returns 1 if successful, 0 if the file does not exist or does not match the map or -1 on error
+ */
+int libewf_chunk_access_map_read_file(
+     libewf_chunk_access_map_t *chunk_access_map,
+     const char *filename,
+     size_t filename_length,
+     size32_t chunk_size,
+     const uint8_t *set_identifier,
+     size_t set_identifier_size,
+     libcerror_error_t **error )
+{
+	uint8_t file_header[ LIBEWF_CHUNK_ACCESS_MAP_FILE_HEADER_SIZE ];
+
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libewf_chunk_access_map_read_file";
+	size_t bitmap_index              = 0;
+	ssize_t read_count               = 0;
+	uint64_t number_of_chunks        = 0;
+	uint32_t format_version          = 0;
+	uint32_t stored_chunk_size       = 0;
+	uint8_t bitmap_value             = 0;
+	int result                       = 0;
+
+	if( chunk_access_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk access map.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( set_identifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid set identifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( set_identifier_size != 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid set identifier size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	result = libbfio_handle_exists(
+	          file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to determine if chunk access map file exists.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		if( libbfio_handle_free(
+		     &file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		return( 0 );
+	}
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open chunk access map file.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libbfio_handle_read_buffer(
+	              file_io_handle,
+	              file_header,
+	              LIBEWF_CHUNK_ACCESS_MAP_FILE_HEADER_SIZE,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file header.",
+		 function );
+
+		goto on_error;
+	}
+	result = 0;
+
+	if( ( read_count == (ssize_t) LIBEWF_CHUNK_ACCESS_MAP_FILE_HEADER_SIZE )
+	 && ( memory_compare(
+	       file_header,
+	       libewf_chunk_access_map_file_signature,
+	       8 ) == 0 ) )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 &( file_header[ 8 ] ),
+		 format_version );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 &( file_header[ 12 ] ),
+		 stored_chunk_size );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 &( file_header[ 16 ] ),
+		 number_of_chunks );
+
+		if( ( format_version == LIBEWF_CHUNK_ACCESS_MAP_FILE_FORMAT_VERSION )
+		 && ( stored_chunk_size == (uint32_t) chunk_size )
+		 && ( number_of_chunks == chunk_access_map->number_of_chunks )
+		 && ( memory_compare(
+		       &( file_header[ 32 ] ),
+		       set_identifier,
+		       16 ) == 0 ) )
+		{
+			result = 1;
+		}
+	}
+	if( result != 0 )
+	{
+		read_count = libbfio_handle_read_buffer(
+		              file_io_handle,
+		              chunk_access_map->bitmap,
+		              chunk_access_map->bitmap_size,
+		              error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read bitmap.",
+			 function );
+
+			goto on_error;
+		}
+		chunk_access_map->number_of_accessed_chunks = 0;
+
+		if( read_count != (ssize_t) chunk_access_map->bitmap_size )
+		{
+			result = 0;
+		}
+		else
+		{
+			/* The bits beyond the last chunk are ignored
+			 */
+			if( ( chunk_access_map->number_of_chunks % 8 ) != 0 )
+			{
+				chunk_access_map->bitmap[ chunk_access_map->bitmap_size - 1 ] &= (uint8_t) ( ( 1 << ( chunk_access_map->number_of_chunks % 8 ) ) - 1 );
+			}
+			for( bitmap_index = 0;
+			     bitmap_index < chunk_access_map->bitmap_size;
+			     bitmap_index++ )
+			{
+				for( bitmap_value = chunk_access_map->bitmap[ bitmap_index ];
+				     bitmap_value != 0;
+				     bitmap_value &= bitmap_value - 1 )
+				{
+					chunk_access_map->number_of_accessed_chunks += 1;
+				}
+			}
+		}
+		if( result == 0 )
+		{
+			if( memory_set(
+			     chunk_access_map->bitmap,
+			     0,
+			     chunk_access_map->bitmap_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear bitmap.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close chunk access map file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes the chunk access map to a file
+ * An existing file is overwritten
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_access_map_write_file(
+     libewf_chunk_access_map_t *chunk_access_map,
+     const char *filename,
+     size_t filename_length,
+     size32_t chunk_size,
+     const uint8_t *set_identifier,
+     size_t set_identifier_size,
+     libcerror_error_t **error )
+{
+	uint8_t file_header[ LIBEWF_CHUNK_ACCESS_MAP_FILE_HEADER_SIZE ];
+
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libewf_chunk_access_map_write_file";
+	ssize_t write_count              = 0;
+
+	if( chunk_access_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk access map.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( set_identifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid set identifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( set_identifier_size != 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid set identifier size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     file_header,
+	     0,
+	     LIBEWF_CHUNK_ACCESS_MAP_FILE_HEADER_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file header.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     file_header,
+	     libewf_chunk_access_map_file_signature,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy signature.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 &( file_header[ 8 ] ),
+	 LIBEWF_CHUNK_ACCESS_MAP_FILE_FORMAT_VERSION );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( file_header[ 12 ] ),
+	 chunk_size );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( file_header[ 16 ] ),
+	 chunk_access_map->number_of_chunks );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( file_header[ 24 ] ),
+	 chunk_access_map->number_of_accessed_chunks );
+
+	if( memory_copy(
+	     &( file_header[ 32 ] ),
+	     set_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy set identifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to create chunk access map file.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libbfio_handle_write_buffer(
+	               file_io_handle,
+	               file_header,
+	               LIBEWF_CHUNK_ACCESS_MAP_FILE_HEADER_SIZE,
+	               error );
+
+	if( write_count != (ssize_t) LIBEWF_CHUNK_ACCESS_MAP_FILE_HEADER_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write file header.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libbfio_handle_write_buffer(
+	               file_io_handle,
+	               chunk_access_map->bitmap,
+	               chunk_access_map->bitmap_size,
+	               error );
+
+	if( write_count != (ssize_t) chunk_access_map->bitmap_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write bitmap.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close chunk access map file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
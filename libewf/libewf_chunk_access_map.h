@@ -0,0 +1,112 @@
+/*
+ * Chunk access map functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_CHUNK_ACCESS_MAP_H )
+#define _LIBEWF_CHUNK_ACCESS_MAP_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The size of the chunk access map file header
+ */
+#define LIBEWF_CHUNK_ACCESS_MAP_FILE_HEADER_SIZE	64
+
+/* The chunk access map file format version
+ */
+#define LIBEWF_CHUNK_ACCESS_MAP_FILE_FORMAT_VERSION	1
+
+typedef struct libewf_chunk_access_map libewf_chunk_access_map_t;
+
+/* The chunk access map records which chunks were accessed as a bitmap
+ * of a bit per chunk, where the least significant bit of the first byte
+ * represents the first chunk. The chunk access map file consists of a header
+ * followed by the bitmap and is bound to the segment file set identifier
+ */
+struct libewf_chunk_access_map
+{
+	/* The number of chunks
+	 */
+	uint64_t number_of_chunks;
+
+	/* The bitmap
+	 */
+	uint8_t *bitmap;
+
+	/* The bitmap size
+	 */
+	size_t bitmap_size;
+
+	/* The number of accessed chunks
+	 */
+	uint64_t number_of_accessed_chunks;
+};
+
+int libewf_chunk_access_map_initialize(
+     libewf_chunk_access_map_t **chunk_access_map,
+     uint64_t number_of_chunks,
+     libcerror_error_t **error );
+
+int libewf_chunk_access_map_free(
+     libewf_chunk_access_map_t **chunk_access_map,
+     libcerror_error_t **error );
+
+int libewf_chunk_access_map_set_chunk_range(
+     libewf_chunk_access_map_t *chunk_access_map,
+     uint64_t chunk_index,
+     uint64_t number_of_chunks,
+     libcerror_error_t **error );
+
+int libewf_chunk_access_map_get_next_chunk_index(
+     libewf_chunk_access_map_t *chunk_access_map,
+     uint64_t chunk_index,
+     uint64_t *next_chunk_index,
+     libcerror_error_t **error );
+
+int libewf_chunk_access_map_read_file(
+     libewf_chunk_access_map_t *chunk_access_map,
+     const char *filename,
+     size_t filename_length,
+     size32_t chunk_size,
+     const uint8_t *set_identifier,
+     size_t set_identifier_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_access_map_write_file(
+     libewf_chunk_access_map_t *chunk_access_map,
+     const char *filename,
+     size_t filename_length,
+     size32_t chunk_size,
+     const uint8_t *set_identifier,
+     size_t set_identifier_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_CHUNK_ACCESS_MAP_H ) */
+
@@ -0,0 +1,1999 @@
+/*
+ * Chunk cache functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_cache.h"
+#include "libewf_chunk_data.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_trace.h"
+
+/* Creates a chunk cache
+ * Make sure the value chunk_cache is referencing, is set to NULL
+ * The chunk cache is created with 1 reference
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_initialize(
+     libewf_chunk_cache_t **chunk_cache,
+     int number_of_shards,
+     int number_of_entries,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error )
+{
+	static char *function       = "libewf_chunk_cache_initialize";
+	size_t array_size           = 0;
+	int total_number_of_entries = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	int shard_index             = 0;
+#endif
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_shards <= 0 )
+	 || ( number_of_shards > 1024 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of shards value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_entries <= 0 )
+	 || ( number_of_entries > 1024 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	total_number_of_entries = number_of_shards * number_of_entries;
+
+	*chunk_cache = memory_allocate_structure(
+	                libewf_chunk_cache_t );
+
+	if( *chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *chunk_cache,
+	     0,
+	     sizeof( libewf_chunk_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk cache.",
+		 function );
+
+		memory_free(
+		 *chunk_cache );
+
+		*chunk_cache = NULL;
+
+		return( -1 );
+	}
+	array_size = sizeof( uint64_t ) * total_number_of_entries;
+
+	( *chunk_cache )->chunk_indexes = (uint64_t *) memory_allocate(
+	                                                array_size );
+
+	if( ( *chunk_cache )->chunk_indexes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk indexes.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *chunk_cache )->chunk_indexes,
+	     0,
+	     array_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk indexes.",
+		 function );
+
+		goto on_error;
+	}
+	array_size = sizeof( libewf_chunk_data_t * ) * total_number_of_entries;
+
+	( *chunk_cache )->chunk_data = (libewf_chunk_data_t **) memory_allocate(
+	                                                         array_size );
+
+	if( ( *chunk_cache )->chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *chunk_cache )->chunk_data,
+	     0,
+	     array_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk data.",
+		 function );
+
+		goto on_error;
+	}
+	array_size = sizeof( uint8_t ) * total_number_of_entries;
+
+	( *chunk_cache )->reference_flags = (uint8_t *) memory_allocate(
+	                                                 array_size );
+
+	if( ( *chunk_cache )->reference_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create reference flags.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *chunk_cache )->reference_flags,
+	     0,
+	     array_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear reference flags.",
+		 function );
+
+		goto on_error;
+	}
+	( *chunk_cache )->background_flags = (uint8_t *) memory_allocate(
+	                                                  array_size );
+
+	if( ( *chunk_cache )->background_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create background flags.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *chunk_cache )->background_flags,
+	     0,
+	     array_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear background flags.",
+		 function );
+
+		goto on_error;
+	}
+	array_size = sizeof( int ) * number_of_shards;
+
+	( *chunk_cache )->clock_hands = (int *) memory_allocate(
+	                                         array_size );
+
+	if( ( *chunk_cache )->clock_hands == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create clock hands.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *chunk_cache )->clock_hands,
+	     0,
+	     array_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear clock hands.",
+		 function );
+
+		goto on_error;
+	}
+	array_size = sizeof( size64_t ) * number_of_shards;
+
+	( *chunk_cache )->shard_sizes = (size64_t *) memory_allocate(
+	                                              array_size );
+
+	if( ( *chunk_cache )->shard_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create shard sizes.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *chunk_cache )->shard_sizes,
+	     0,
+	     array_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear shard sizes.",
+		 function );
+
+		goto on_error;
+	}
+	array_size = sizeof( uint64_t ) * LIBEWF_CHUNK_CACHE_NUMBER_OF_COUNTERS * number_of_shards;
+
+	( *chunk_cache )->shard_counters = (uint64_t *) memory_allocate(
+	                                                 array_size );
+
+	if( ( *chunk_cache )->shard_counters == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create shard counters.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *chunk_cache )->shard_counters,
+	     0,
+	     array_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear shard counters.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	array_size = sizeof( libcthreads_mutex_t * ) * number_of_shards;
+
+	( *chunk_cache )->mutexes = (libcthreads_mutex_t **) memory_allocate(
+	                                                      array_size );
+
+	if( ( *chunk_cache )->mutexes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create mutexes.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *chunk_cache )->mutexes,
+	     0,
+	     array_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear mutexes.",
+		 function );
+
+		goto on_error;
+	}
+	for( shard_index = 0;
+	     shard_index < number_of_shards;
+	     shard_index++ )
+	{
+		if( libcthreads_mutex_initialize(
+		     &( ( ( *chunk_cache )->mutexes )[ shard_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create mutex: %d.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *chunk_cache )->reference_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create reference mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *chunk_cache )->number_of_shards     = number_of_shards;
+	( *chunk_cache )->number_of_entries    = number_of_entries;
+	( *chunk_cache )->maximum_cache_size   = maximum_cache_size;
+	( *chunk_cache )->number_of_references = 1;
+	( *chunk_cache )->number_of_namespaces = 1;
+
+	return( 1 );
+
+on_error:
+	if( *chunk_cache != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *chunk_cache )->mutexes != NULL )
+		{
+			for( shard_index = 0;
+			     shard_index < number_of_shards;
+			     shard_index++ )
+			{
+				if( ( ( *chunk_cache )->mutexes )[ shard_index ] != NULL )
+				{
+					libcthreads_mutex_free(
+					 &( ( ( *chunk_cache )->mutexes )[ shard_index ] ),
+					 NULL );
+				}
+			}
+			memory_free(
+			 ( *chunk_cache )->mutexes );
+		}
+#endif
+		if( ( *chunk_cache )->shard_counters != NULL )
+		{
+			memory_free(
+			 ( *chunk_cache )->shard_counters );
+		}
+		if( ( *chunk_cache )->shard_sizes != NULL )
+		{
+			memory_free(
+			 ( *chunk_cache )->shard_sizes );
+		}
+		if( ( *chunk_cache )->clock_hands != NULL )
+		{
+			memory_free(
+			 ( *chunk_cache )->clock_hands );
+		}
+		if( ( *chunk_cache )->background_flags != NULL )
+		{
+			memory_free(
+			 ( *chunk_cache )->background_flags );
+		}
+		if( ( *chunk_cache )->reference_flags != NULL )
+		{
+			memory_free(
+			 ( *chunk_cache )->reference_flags );
+		}
+		if( ( *chunk_cache )->chunk_data != NULL )
+		{
+			memory_free(
+			 ( *chunk_cache )->chunk_data );
+		}
+		if( ( *chunk_cache )->chunk_indexes != NULL )
+		{
+			memory_free(
+			 ( *chunk_cache )->chunk_indexes );
+		}
+		memory_free(
+		 *chunk_cache );
+
+		*chunk_cache = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a chunk cache
+ * This function frees the chunk cache regardless of the number of references
+ * use libewf_chunk_cache_release for a chunk cache that can be shared
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_free(
+     libewf_chunk_cache_t **chunk_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_free";
+	int entry_index       = 0;
+	int result            = 1;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	int shard_index       = 0;
+#endif
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_cache != NULL )
+	{
+		for( entry_index = 0;
+		     entry_index < ( ( *chunk_cache )->number_of_shards * ( *chunk_cache )->number_of_entries );
+		     entry_index++ )
+		{
+			if( ( ( *chunk_cache )->chunk_data )[ entry_index ] != NULL )
+			{
+				if( libewf_chunk_data_free(
+				     &( ( ( *chunk_cache )->chunk_data )[ entry_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free chunk data: %d.",
+					 function,
+					 entry_index );
+
+					result = -1;
+				}
+			}
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *chunk_cache )->reference_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free reference mutex.",
+			 function );
+
+			result = -1;
+		}
+		for( shard_index = 0;
+		     shard_index < ( *chunk_cache )->number_of_shards;
+		     shard_index++ )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( ( *chunk_cache )->mutexes )[ shard_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free mutex: %d.",
+				 function,
+				 shard_index );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 ( *chunk_cache )->mutexes );
+#endif
+		memory_free(
+		 ( *chunk_cache )->shard_counters );
+
+		memory_free(
+		 ( *chunk_cache )->shard_sizes );
+
+		memory_free(
+		 ( *chunk_cache )->clock_hands );
+
+		memory_free(
+		 ( *chunk_cache )->background_flags );
+
+		memory_free(
+		 ( *chunk_cache )->reference_flags );
+
+		memory_free(
+		 ( *chunk_cache )->chunk_data );
+
+		memory_free(
+		 ( *chunk_cache )->chunk_indexes );
+
+		memory_free(
+		 *chunk_cache );
+
+		*chunk_cache = NULL;
+	}
+	return( result );
+}
+
+/* Acquires a reference to a chunk cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_acquire(
+     libewf_chunk_cache_t *chunk_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_acquire";
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_cache->reference_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab reference mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	chunk_cache->number_of_references += 1;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_cache->reference_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release reference mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Releases a reference to a chunk cache
+ * The chunk cache is freed when the last reference is released
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_release(
+     libewf_chunk_cache_t **chunk_cache,
+     libcerror_error_t **error )
+{
+	static char *function    = "libewf_chunk_cache_release";
+	int number_of_references = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_cache == NULL )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     ( *chunk_cache )->reference_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab reference mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	( *chunk_cache )->number_of_references -= 1;
+
+	number_of_references = ( *chunk_cache )->number_of_references;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     ( *chunk_cache )->reference_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release reference mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( number_of_references > 0 )
+	{
+		*chunk_cache = NULL;
+
+		return( 1 );
+	}
+	if( libewf_chunk_cache_free(
+	     chunk_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves a new namespace
+ * The namespace is returned as the key prefix that is combined with the chunk index
+ * to form the key of a chunk in the chunk cache. The first namespace, with key prefix 0,
+ * is used by the handle that created the chunk cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_get_new_namespace(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t *key_prefix,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_get_new_namespace";
+	int result            = 1;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( key_prefix == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key prefix.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_cache->reference_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab reference mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( chunk_cache->number_of_namespaces >= LIBEWF_CHUNK_CACHE_MAXIMUM_NUMBER_OF_NAMESPACES )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk cache - number of namespaces value exceeds maximum.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		*key_prefix = (uint64_t) chunk_cache->number_of_namespaces << LIBEWF_CHUNK_CACHE_NAMESPACE_BIT_SHIFT;
+
+		chunk_cache->number_of_namespaces += 1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_cache->reference_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release reference mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the shard index of a specific chunk
+ * The chunk index is hashed so that chunks are evenly distributed over the shards
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_get_shard_index(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     int *shard_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_get_shard_index";
+	uint64_t hash         = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( shard_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shard index.",
+		 function );
+
+		return( -1 );
+	}
+	/* Fibonacci hashing of the chunk index
+	 */
+	hash = chunk_index * (uint64_t) 0x9e3779b97f4a7c15ULL;
+
+	*shard_index = (int) ( ( hash >> 32 ) % (uint64_t) chunk_cache->number_of_shards );
+
+	return( 1 );
+}
+
+/* Retrieves the entry index of a specific chunk in a shard
+ * This function is not multi-thread safe acquire the shard mutex before call
+ * Returns 1 if successful, 0 if the chunk is not cached or -1 on error
+ */
+int libewf_chunk_cache_get_entry_index(
+     libewf_chunk_cache_t *chunk_cache,
+     int shard_index,
+     uint64_t chunk_index,
+     int *entry_index,
+     libcerror_error_t **error )
+{
+	static char *function  = "libewf_chunk_cache_get_entry_index";
+	int first_entry_index  = 0;
+	int safe_entry_index   = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( shard_index < 0 )
+	 || ( shard_index >= chunk_cache->number_of_shards ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid shard index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry index.",
+		 function );
+
+		return( -1 );
+	}
+	first_entry_index = shard_index * chunk_cache->number_of_entries;
+
+	for( safe_entry_index = first_entry_index;
+	     safe_entry_index < ( first_entry_index + chunk_cache->number_of_entries );
+	     safe_entry_index++ )
+	{
+		if( ( chunk_cache->chunk_data[ safe_entry_index ] != NULL )
+		 && ( chunk_cache->chunk_indexes[ safe_entry_index ] == chunk_index ) )
+		{
+			*entry_index = safe_entry_index;
+
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Evicts an entry from a shard using the CLOCK policy
+ * Entries that were referenced since the clock hand last passed them get a second chance
+ * A background priority only evicts entries that were not used by interactive reads
+ * and leaves the reference flags of the other entries untouched
+ * This function is not multi-thread safe acquire the shard mutex before call
+ * Returns 1 if successful, 0 if the shard has no entries that can be evicted or -1 on error
+ */
+int libewf_chunk_cache_evict_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     int shard_index,
+     int priority,
+     int *entry_index,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_chunk_cache_evict_entry";
+	int clock_hand                  = 0;
+	int first_entry_index           = 0;
+	int iterator                    = 0;
+	int safe_entry_index            = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( shard_index < 0 )
+	 || ( shard_index >= chunk_cache->number_of_shards ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid shard index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry index.",
+		 function );
+
+		return( -1 );
+	}
+	first_entry_index = shard_index * chunk_cache->number_of_entries;
+	clock_hand        = chunk_cache->clock_hands[ shard_index ];
+
+	/* Two passes are sufficient since the first pass clears the reference flags
+	 */
+	for( iterator = 0;
+	     iterator < ( 2 * chunk_cache->number_of_entries );
+	     iterator++ )
+	{
+		safe_entry_index = first_entry_index + clock_hand;
+
+		clock_hand += 1;
+
+		if( clock_hand >= chunk_cache->number_of_entries )
+		{
+			clock_hand = 0;
+		}
+		if( chunk_cache->chunk_data[ safe_entry_index ] == NULL )
+		{
+			continue;
+		}
+		if( ( priority == LIBEWF_READ_PRIORITY_BACKGROUND )
+		 && ( chunk_cache->background_flags[ safe_entry_index ] == 0 ) )
+		{
+			continue;
+		}
+		if( chunk_cache->reference_flags[ safe_entry_index ] != 0 )
+		{
+			chunk_cache->reference_flags[ safe_entry_index ] = 0;
+
+			continue;
+		}
+		chunk_data = chunk_cache->chunk_data[ safe_entry_index ];
+
+		chunk_cache->shard_sizes[ shard_index ] -= chunk_data->allocated_data_size + chunk_data->compressed_data_size;
+
+		chunk_cache->chunk_data[ safe_entry_index ] = NULL;
+		chunk_cache->clock_hands[ shard_index ]     = clock_hand;
+
+		chunk_cache->shard_counters[ ( shard_index * LIBEWF_CHUNK_CACHE_NUMBER_OF_COUNTERS ) + LIBEWF_CHUNK_CACHE_COUNTER_EVICTIONS ] += 1;
+
+		if( libewf_chunk_data_free(
+		     &chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk data: %d.",
+			 function,
+			 safe_entry_index );
+
+			return( -1 );
+		}
+		*entry_index = safe_entry_index;
+
+		return( 1 );
+	}
+	chunk_cache->clock_hands[ shard_index ] = clock_hand;
+
+	return( 0 );
+}
+
+/* Determines if the data of a specific chunk is cached
+ * Returns 1 if the chunk is cached, 0 if not or -1 on error
+ */
+int libewf_chunk_cache_has_chunk_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_has_chunk_data";
+	int entry_index       = 0;
+	int result            = 0;
+	int shard_index       = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_cache_get_shard_index(
+	     chunk_cache,
+	     chunk_index,
+	     &shard_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve shard index of chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_cache->mutexes[ shard_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex: %d.",
+		 function,
+		 shard_index );
+
+		return( -1 );
+	}
+#endif
+	/* The reference flag is not set, since determining if a chunk is cached
+	 * does not constitute a use of the chunk
+	 */
+	result = libewf_chunk_cache_get_entry_index(
+	          chunk_cache,
+	          shard_index,
+	          chunk_index,
+	          &entry_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry index of chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_cache->mutexes[ shard_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex: %d.",
+		 function,
+		 shard_index );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Copies the data of a cached chunk into a buffer
+ * A read with the background priority does not constitute a use of the chunk
+ * that protects it from eviction, a read with the interactive priority does
+ * Returns 1 if successful, 0 if the chunk is not cached or -1 on error
+ */
+int libewf_chunk_cache_copy_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     size_t chunk_data_offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     size_t *copy_size,
+     int priority,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_chunk_cache_copy_data";
+	size_t data_size                = 0;
+	int entry_index                 = 0;
+	int result                      = 0;
+	int shard_index                 = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( copy_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid copy size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_cache_get_shard_index(
+	     chunk_cache,
+	     chunk_index,
+	     &shard_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve shard index of chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_cache->mutexes[ shard_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex: %d.",
+		 function,
+		 shard_index );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_chunk_cache_get_entry_index(
+	          chunk_cache,
+	          shard_index,
+	          chunk_index,
+	          &entry_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry index of chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
+	}
+	else if( result == 0 )
+	{
+		chunk_cache->shard_counters[ ( shard_index * LIBEWF_CHUNK_CACHE_NUMBER_OF_COUNTERS ) + LIBEWF_CHUNK_CACHE_COUNTER_MISSES ] += 1;
+
+		LIBEWF_TRACE_CHUNK_CACHE_MISS(
+		 chunk_index );
+	}
+	else
+	{
+		chunk_data = chunk_cache->chunk_data[ entry_index ];
+
+		if( priority != LIBEWF_READ_PRIORITY_BACKGROUND )
+		{
+			chunk_cache->reference_flags[ entry_index ]  = 1;
+			chunk_cache->background_flags[ entry_index ] = 0;
+		}
+
+		chunk_cache->shard_counters[ ( shard_index * LIBEWF_CHUNK_CACHE_NUMBER_OF_COUNTERS ) + LIBEWF_CHUNK_CACHE_COUNTER_HITS ] += 1;
+
+		LIBEWF_TRACE_CHUNK_CACHE_HIT(
+		 chunk_index );
+
+		if( chunk_data_offset < chunk_data->data_size )
+		{
+			data_size = chunk_data->data_size - chunk_data_offset;
+
+			if( data_size > buffer_size )
+			{
+				data_size = buffer_size;
+			}
+			if( memory_copy(
+			     buffer,
+			     &( ( chunk_data->data )[ chunk_data_offset ] ),
+			     data_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
+				 function,
+				 chunk_index );
+
+				result = -1;
+			}
+		}
+		if( result != -1 )
+		{
+			*copy_size = data_size;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_cache->mutexes[ shard_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex: %d.",
+		 function,
+		 shard_index );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the chunk data of a specific chunk
+ * The chunk cache takes over management of the chunk data if successful
+ * Entries are evicted using the CLOCK policy when the shard is full
+ * or when the maximum cache size would be exceeded
+ * Chunk data with the background priority only evicts entries that were not used
+ * by interactive reads, if no such entry can be evicted the chunk data is freed
+ * instead of cached
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_set_chunk_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     int priority,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *previous_chunk_data = NULL;
+	libewf_chunk_data_t *uncached_chunk_data = NULL;
+	static char *function                    = "libewf_chunk_cache_set_chunk_data";
+	size64_t entry_size                      = 0;
+	size64_t maximum_shard_size              = 0;
+	int entry_index                          = 0;
+	int first_entry_index                    = 0;
+	int result                               = 0;
+	int shard_index                          = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( priority != LIBEWF_READ_PRIORITY_INTERACTIVE )
+	 && ( priority != LIBEWF_READ_PRIORITY_BACKGROUND ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported priority.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_cache_get_shard_index(
+	     chunk_cache,
+	     chunk_index,
+	     &shard_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve shard index of chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	entry_size = (size64_t) ( chunk_data->allocated_data_size + chunk_data->compressed_data_size );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_cache->mutexes[ shard_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex: %d.",
+		 function,
+		 shard_index );
+
+		return( -1 );
+	}
+#endif
+	/* The maximum cache size is read while holding the mutex since it can be changed
+	 */
+	maximum_shard_size = chunk_cache->maximum_cache_size / chunk_cache->number_of_shards;
+
+	result = libewf_chunk_cache_get_entry_index(
+	          chunk_cache,
+	          shard_index,
+	          chunk_index,
+	          &entry_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry index of chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		/* Replace the chunk data that is already cached
+		 */
+		previous_chunk_data = chunk_cache->chunk_data[ entry_index ];
+
+		chunk_cache->shard_sizes[ shard_index ] -= previous_chunk_data->allocated_data_size + previous_chunk_data->compressed_data_size;
+		chunk_cache->chunk_data[ entry_index ]   = NULL;
+	}
+	else
+	{
+		if( maximum_shard_size > 0 )
+		{
+			while( ( chunk_cache->shard_sizes[ shard_index ] + entry_size ) > maximum_shard_size )
+			{
+				result = libewf_chunk_cache_evict_entry(
+				          chunk_cache,
+				          shard_index,
+				          priority,
+				          &entry_index,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+					 "%s: unable to evict entry from shard: %d.",
+					 function,
+					 shard_index );
+
+					goto on_error;
+				}
+				else if( result == 0 )
+				{
+					break;
+				}
+			}
+			/* Chunk data with the background priority is not cached
+			 * when it only fits by evicting entries of interactive reads
+			 */
+			if( ( priority == LIBEWF_READ_PRIORITY_BACKGROUND )
+			 && ( ( chunk_cache->shard_sizes[ shard_index ] + entry_size ) > maximum_shard_size ) )
+			{
+				uncached_chunk_data = chunk_data;
+			}
+		}
+		if( uncached_chunk_data == NULL )
+		{
+			first_entry_index = shard_index * chunk_cache->number_of_entries;
+
+			for( entry_index = first_entry_index;
+			     entry_index < ( first_entry_index + chunk_cache->number_of_entries );
+			     entry_index++ )
+			{
+				if( chunk_cache->chunk_data[ entry_index ] == NULL )
+				{
+					break;
+				}
+			}
+			if( entry_index >= ( first_entry_index + chunk_cache->number_of_entries ) )
+			{
+				result = libewf_chunk_cache_evict_entry(
+				          chunk_cache,
+				          shard_index,
+				          priority,
+				          &entry_index,
+				          error );
+
+				if( ( result == -1 )
+				 || ( ( result == 0 )
+				  && ( priority != LIBEWF_READ_PRIORITY_BACKGROUND ) ) )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+					 "%s: unable to evict entry from shard: %d.",
+					 function,
+					 shard_index );
+
+					goto on_error;
+				}
+				else if( result == 0 )
+				{
+					uncached_chunk_data = chunk_data;
+				}
+			}
+		}
+	}
+	if( uncached_chunk_data == NULL )
+	{
+		chunk_cache->chunk_indexes[ entry_index ]   = chunk_index;
+		chunk_cache->chunk_data[ entry_index ]      = chunk_data;
+		chunk_cache->reference_flags[ entry_index ] = 0;
+		chunk_cache->shard_sizes[ shard_index ]    += entry_size;
+
+		/* An entry that was used by interactive reads remains protected
+		 * from eviction by background reads when it is replaced by one
+		 */
+		if( priority != LIBEWF_READ_PRIORITY_BACKGROUND )
+		{
+			chunk_cache->background_flags[ entry_index ] = 0;
+		}
+		else if( previous_chunk_data == NULL )
+		{
+			chunk_cache->background_flags[ entry_index ] = 1;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_cache->mutexes[ shard_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex: %d.",
+		 function,
+		 shard_index );
+
+		return( -1 );
+	}
+#endif
+	/* The previous and uncached chunk data are freed outside the mutex
+	 */
+	if( ( previous_chunk_data != NULL )
+	 && ( previous_chunk_data != chunk_data ) )
+	{
+		if( libewf_chunk_data_free(
+		     &previous_chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free previous chunk data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( uncached_chunk_data != NULL )
+	{
+		if( libewf_chunk_data_free(
+		     &uncached_chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free uncached chunk data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 chunk_cache->mutexes[ shard_index ],
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Sets the maximum size of the cached chunk data in bytes
+ * The mutexes of all shards are grabbed so that the maximum cache size is not changed
+ * while it is being read and entries are evicted until every shard fits the new maximum
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_set_maximum_cache_size(
+     libewf_chunk_cache_t *chunk_cache,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error )
+{
+	static char *function       = "libewf_chunk_cache_set_maximum_cache_size";
+	size64_t maximum_shard_size = 0;
+	int entry_index             = 0;
+	int number_of_locked_shards = 0;
+	int result                  = 1;
+	int shard_index             = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	for( shard_index = 0;
+	     shard_index < chunk_cache->number_of_shards;
+	     shard_index++ )
+	{
+		if( libcthreads_mutex_grab(
+		     chunk_cache->mutexes[ shard_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex: %d.",
+			 function,
+			 shard_index );
+
+			result = -1;
+
+			break;
+		}
+		number_of_locked_shards++;
+	}
+#else
+	number_of_locked_shards = chunk_cache->number_of_shards;
+#endif
+	if( result == 1 )
+	{
+		chunk_cache->maximum_cache_size = maximum_cache_size;
+
+		maximum_shard_size = maximum_cache_size / chunk_cache->number_of_shards;
+	}
+	if( ( result == 1 )
+	 && ( maximum_shard_size > 0 ) )
+	{
+		for( shard_index = 0;
+		     shard_index < chunk_cache->number_of_shards;
+		     shard_index++ )
+		{
+			while( chunk_cache->shard_sizes[ shard_index ] > maximum_shard_size )
+			{
+				result = libewf_chunk_cache_evict_entry(
+				          chunk_cache,
+				          shard_index,
+				          LIBEWF_READ_PRIORITY_INTERACTIVE,
+				          &entry_index,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+					 "%s: unable to evict entry from shard: %d.",
+					 function,
+					 shard_index );
+
+					break;
+				}
+				else if( result == 0 )
+				{
+					result = 1;
+
+					break;
+				}
+			}
+			if( result != 1 )
+			{
+				break;
+			}
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	while( number_of_locked_shards > 0 )
+	{
+		number_of_locked_shards--;
+
+		if( libcthreads_mutex_release(
+		     chunk_cache->mutexes[ number_of_locked_shards ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex: %d.",
+			 function,
+			 number_of_locked_shards );
+
+			result = -1;
+		}
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the size of the cached chunk data in bytes
+ * The size is the sum of the sizes of the shards
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_get_cache_size(
+     libewf_chunk_cache_t *chunk_cache,
+     size64_t *cache_size,
+     libcerror_error_t **error )
+{
+	static char *function     = "libewf_chunk_cache_get_cache_size";
+	size64_t safe_cache_size  = 0;
+	int shard_index           = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( cache_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache size.",
+		 function );
+
+		return( -1 );
+	}
+	for( shard_index = 0;
+	     shard_index < chunk_cache->number_of_shards;
+	     shard_index++ )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     chunk_cache->mutexes[ shard_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex: %d.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+		safe_cache_size += chunk_cache->shard_sizes[ shard_index ];
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     chunk_cache->mutexes[ shard_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex: %d.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+	}
+	*cache_size = safe_cache_size;
+
+	return( 1 );
+}
+
+/* Retrieves the counters of the chunk cache
+ * The counters are the sum of the counters of the shards
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_get_counters(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     uint64_t *number_of_evictions,
+     libcerror_error_t **error )
+{
+	static char *function    = "libewf_chunk_cache_get_counters";
+	uint64_t *shard_counters = NULL;
+	uint64_t safe_hits       = 0;
+	uint64_t safe_misses     = 0;
+	uint64_t safe_evictions  = 0;
+	int shard_index          = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_hits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of hits.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_misses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of misses.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_evictions == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of evictions.",
+		 function );
+
+		return( -1 );
+	}
+	for( shard_index = 0;
+	     shard_index < chunk_cache->number_of_shards;
+	     shard_index++ )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     chunk_cache->mutexes[ shard_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex: %d.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+		shard_counters = &( chunk_cache->shard_counters[ shard_index * LIBEWF_CHUNK_CACHE_NUMBER_OF_COUNTERS ] );
+
+		safe_hits      += shard_counters[ LIBEWF_CHUNK_CACHE_COUNTER_HITS ];
+		safe_misses    += shard_counters[ LIBEWF_CHUNK_CACHE_COUNTER_MISSES ];
+		safe_evictions += shard_counters[ LIBEWF_CHUNK_CACHE_COUNTER_EVICTIONS ];
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     chunk_cache->mutexes[ shard_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex: %d.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+	}
+	*number_of_hits      = safe_hits;
+	*number_of_misses    = safe_misses;
+	*number_of_evictions = safe_evictions;
+
+	return( 1 );
+}
+
+/* Resets the counters of the chunk cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_reset_counters(
+     libewf_chunk_cache_t *chunk_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_reset_counters";
+	int counter_index     = 0;
+	int shard_index       = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	for( shard_index = 0;
+	     shard_index < chunk_cache->number_of_shards;
+	     shard_index++ )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     chunk_cache->mutexes[ shard_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex: %d.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+		for( counter_index = 0;
+		     counter_index < LIBEWF_CHUNK_CACHE_NUMBER_OF_COUNTERS;
+		     counter_index++ )
+		{
+			chunk_cache->shard_counters[ ( shard_index * LIBEWF_CHUNK_CACHE_NUMBER_OF_COUNTERS ) + counter_index ] = 0;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     chunk_cache->mutexes[ shard_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex: %d.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+	}
+	return( 1 );
+}
+
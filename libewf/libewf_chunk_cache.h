@@ -0,0 +1,221 @@
+/*
+ * Chunk cache functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_CHUNK_CACHE_H )
+#define _LIBEWF_CHUNK_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The counters of a chunk cache shard
+ */
+enum LIBEWF_CHUNK_CACHE_COUNTERS
+{
+	LIBEWF_CHUNK_CACHE_COUNTER_HITS		= 0,
+	LIBEWF_CHUNK_CACHE_COUNTER_MISSES	= 1,
+	LIBEWF_CHUNK_CACHE_COUNTER_EVICTIONS	= 2,
+
+	/* The number of counters per shard
+	 */
+	LIBEWF_CHUNK_CACHE_NUMBER_OF_COUNTERS	= 3
+};
+
+/* The number of bits the namespace of a chunk cache key is shifted
+ * The chunk cache key consists of the namespace in the upper 16 bits
+ * and the chunk index in the lower 48 bits
+ */
+#define LIBEWF_CHUNK_CACHE_NAMESPACE_BIT_SHIFT		48
+
+/* The maximum number of namespaces of a chunk cache
+ */
+#define LIBEWF_CHUNK_CACHE_MAXIMUM_NUMBER_OF_NAMESPACES	65536
+
+typedef struct libewf_chunk_cache libewf_chunk_cache_t;
+
+/* The chunk cache is a sharded cache of unpacked chunk data that,
+ * unlike the chunks cache, can be accessed by multiple threads at the same time
+ * and can be shared by multiple handles. Handles opened on different segment file sets
+ * use a different namespace so that their chunks are cached under different keys
+ * Chunks cached by background reads never evict the chunks used by interactive reads
+ */
+struct libewf_chunk_cache
+{
+	/* The number of shards
+	 */
+	int number_of_shards;
+
+	/* The number of entries per shard
+	 */
+	int number_of_entries;
+
+	/* The maximum size of the cached chunk data in bytes, 0 represents no maximum
+	 */
+	size64_t maximum_cache_size;
+
+	/* The chunk indexes of the entries
+	 */
+	uint64_t *chunk_indexes;
+
+	/* The chunk data of the entries
+	 */
+	libewf_chunk_data_t **chunk_data;
+
+	/* The reference flags of the entries, used by the CLOCK eviction policy
+	 */
+	uint8_t *reference_flags;
+
+	/* The background flags of the entries, set when the entry was only used
+	 * by background reads and therefore can be evicted by background reads
+	 */
+	uint8_t *background_flags;
+
+	/* The clock hands of the shards
+	 */
+	int *clock_hands;
+
+	/* The size of the cached chunk data of the shards in bytes
+	 */
+	size64_t *shard_sizes;
+
+	/* The hit, miss and eviction counters of the shards
+	 */
+	uint64_t *shard_counters;
+
+	/* The number of references to the chunk cache
+	 */
+	int number_of_references;
+
+	/* The number of namespaces
+	 */
+	int number_of_namespaces;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The mutexes of the shards
+	 */
+	libcthreads_mutex_t **mutexes;
+
+	/* The mutex that protects the number of references
+	 */
+	libcthreads_mutex_t *reference_mutex;
+#endif
+};
+
+int libewf_chunk_cache_initialize(
+     libewf_chunk_cache_t **chunk_cache,
+     int number_of_shards,
+     int number_of_entries,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_free(
+     libewf_chunk_cache_t **chunk_cache,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_acquire(
+     libewf_chunk_cache_t *chunk_cache,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_release(
+     libewf_chunk_cache_t **chunk_cache,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_get_new_namespace(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t *key_prefix,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_get_shard_index(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     int *shard_index,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_get_entry_index(
+     libewf_chunk_cache_t *chunk_cache,
+     int shard_index,
+     uint64_t chunk_index,
+     int *entry_index,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_evict_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     int shard_index,
+     int priority,
+     int *entry_index,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_has_chunk_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_copy_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     size_t chunk_data_offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     size_t *copy_size,
+     int priority,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_set_chunk_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     int priority,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_set_maximum_cache_size(
+     libewf_chunk_cache_t *chunk_cache,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_get_cache_size(
+     libewf_chunk_cache_t *chunk_cache,
+     size64_t *cache_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_get_counters(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     uint64_t *number_of_evictions,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_reset_counters(
+     libewf_chunk_cache_t *chunk_cache,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_CHUNK_CACHE_H ) */
+
@@ -25,13 +25,21 @@
 #include <types.h>
 
 #include "libewf_checksum.h"
+#include "libewf_buffer_pool.h"
 #include "libewf_chunk_data.h"
 #include "libewf_compression.h"
+#include "libewf_compression_context.h"
 #include "libewf_definitions.h"
+#include "libewf_disk_chunk_cache.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
 #include "libewf_libcnotify.h"
 #include "libewf_libfdata.h"
+#include "libewf_memory_accounting.h"
+#include "libewf_parallel_deflate.h"
+#include "libewf_shared_chunk_cache.h"
+#include "libewf_statistics.h"
+#include "libewf_trace.h"
 #include "libewf_types.h"
 #include "libewf_unused.h"
 
@@ -53,7 +61,41 @@ int libewf_chunk_data_initialize(
      uint8_t clear_data,
      libcerror_error_t **error )
 {
-	static char *function      = "libewf_chunk_data_initialize";
+	static char *function = "libewf_chunk_data_initialize";
+
+	if( libewf_chunk_data_initialize_with_buffer_pool(
+	     chunk_data,
+	     NULL,
+	     chunk_size,
+	     clear_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Creates chunk data of which the data is retrieved from a buffer pool
+ * Make sure the value chunk_data is referencing, is set to NULL
+ * The buffer pool is optional and only used if its buffer size matches the allocated data size
+ * The chunk data holds a reference to the buffer pool until it is freed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_initialize_with_buffer_pool(
+     libewf_chunk_data_t **chunk_data,
+     libewf_buffer_pool_t *buffer_pool,
+     size32_t chunk_size,
+     uint8_t clear_data,
+     libcerror_error_t **error )
+{
+	static char *function      = "libewf_chunk_data_initialize_with_buffer_pool";
 	size_t allocated_data_size = 0;
 
 	if( chunk_data == NULL )
@@ -135,19 +177,56 @@ int libewf_chunk_data_initialize(
 	}
 	allocated_data_size = ( allocated_data_size / 16 ) * 16;
 
-	( *chunk_data )->data = (uint8_t *) memory_allocate(
-					     sizeof( uint8_t ) * allocated_data_size );
+	if( ( buffer_pool != NULL )
+	 && ( buffer_pool->buffer_size == allocated_data_size ) )
+	{
+		if( libewf_buffer_pool_acquire(
+		     buffer_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to acquire buffer pool.",
+			 function );
+
+			goto on_error;
+		}
+		( *chunk_data )->buffer_pool = buffer_pool;
+
+		if( libewf_buffer_pool_get_buffer(
+		     buffer_pool,
+		     &( ( *chunk_data )->data ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data from buffer pool.",
+			 function );
 
-	if( ( *chunk_data )->data == NULL )
+			goto on_error;
+		}
+		( *chunk_data )->flags |= LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_DATA;
+	}
+	else
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create data.",
-		 function );
+		( *chunk_data )->data = (uint8_t *) memory_allocate(
+						     sizeof( uint8_t ) * allocated_data_size );
 
-		goto on_error;
+		if( ( *chunk_data )->data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create data.",
+			 function );
+
+			goto on_error;
+		}
 	}
 	if( clear_data != 0 )
 	{
@@ -168,7 +247,12 @@ int libewf_chunk_data_initialize(
 	}
 	( *chunk_data )->chunk_size          = chunk_size;
 	( *chunk_data )->allocated_data_size = allocated_data_size;
-	( *chunk_data )->flags               = LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
+	( *chunk_data )->flags              |= LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
+
+	LIBEWF_MEMORY_ACCOUNTING_UPDATE(
+	 LIBEWF_MEMORY_TYPE_CHUNK_DATA,
+	 *chunk_data,
+	 LIBEWF_CHUNK_DATA_MEMORY_SIZE( *chunk_data ) );
 
 	return( 1 );
 
@@ -177,9 +261,16 @@ on_error:
 	{
 		if( ( *chunk_data )->data != NULL )
 		{
-			memory_free(
-			 ( *chunk_data )->data );
+			libewf_chunk_data_free_buffer(
+			 *chunk_data,
+			 &( ( *chunk_data )->data ),
+			 ( *chunk_data )->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_DATA,
+			 NULL );
 		}
+		libewf_buffer_pool_release(
+		 &( ( *chunk_data )->buffer_pool ),
+		 NULL );
+
 		memory_free(
 		 *chunk_data );
 
@@ -196,6 +287,7 @@ int libewf_chunk_data_free(
      libcerror_error_t **error )
 {
 	static char *function = "libewf_chunk_data_free";
+	int result            = 1;
 
 	if( chunk_data == NULL )
 	{
@@ -212,22 +304,126 @@ int libewf_chunk_data_free(
 	{
 		if( ( ( *chunk_data )->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA ) != 0 )
 		{
-			if( ( *chunk_data )->data != NULL )
+			if( libewf_chunk_data_free_buffer(
+			     *chunk_data,
+			     &( ( *chunk_data )->data ),
+			     ( *chunk_data )->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_DATA,
+			     error ) != 1 )
 			{
-				memory_free(
-				 ( *chunk_data )->data );
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free data.",
+				 function );
+
+				result = -1;
 			}
 		}
-		if( ( *chunk_data )->compressed_data != NULL )
+		if( libewf_chunk_data_free_buffer(
+		     *chunk_data,
+		     &( ( *chunk_data )->compressed_data ),
+		     ( *chunk_data )->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_COMPRESSED_DATA,
+		     error ) != 1 )
 		{
-			memory_free(
-			 ( *chunk_data )->compressed_data );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free compressed data.",
+			 function );
+
+			result = -1;
+		}
+		if( libewf_buffer_pool_release(
+		     &( ( *chunk_data )->buffer_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to release buffer pool.",
+			 function );
+
+			result = -1;
 		}
+		LIBEWF_MEMORY_ACCOUNTING_UPDATE(
+		 LIBEWF_MEMORY_TYPE_CHUNK_DATA,
+		 *chunk_data,
+		 0 );
+
 		memory_free(
 		 *chunk_data );
 
 		*chunk_data = NULL;
 	}
+	return( result );
+}
+
+/* Frees a data buffer of the chunk data
+ * A buffer that was retrieved from the buffer pool is returned to the buffer pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_free_buffer(
+     libewf_chunk_data_t *chunk_data,
+     uint8_t **buffer,
+     uint8_t is_pooled,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_free_buffer";
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *buffer == NULL )
+	{
+		return( 1 );
+	}
+	if( ( is_pooled != 0 )
+	 && ( chunk_data->buffer_pool != NULL ) )
+	{
+		if( libewf_buffer_pool_return_buffer(
+		     chunk_data->buffer_pool,
+		     buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to return buffer to buffer pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else
+	{
+		memory_free(
+		 *buffer );
+
+		*buffer = NULL;
+	}
 	return( 1 );
 }
 
@@ -304,6 +500,15 @@ int libewf_chunk_data_clone(
 	}
 	( *destination_chunk_data )->data            = NULL;
 	( *destination_chunk_data )->compressed_data = NULL;
+	( *destination_chunk_data )->buffer_pool     = NULL;
+
+#if defined( HAVE_LIBEWF_MEMORY_ACCOUNTING )
+	( *destination_chunk_data )->accounted_memory_size = 0;
+#endif
+
+	/* The data of the destination chunk data is not retrieved from the buffer pool
+	 */
+	( *destination_chunk_data )->flags &= ~( LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_DATA | LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_COMPRESSED_DATA );
 
 	if( source_chunk_data->data != NULL )
 	{
@@ -367,6 +572,11 @@ int libewf_chunk_data_clone(
 			goto on_error;
 		}
 	}
+	LIBEWF_MEMORY_ACCOUNTING_UPDATE(
+	 LIBEWF_MEMORY_TYPE_CHUNK_DATA,
+	 *destination_chunk_data,
+	 LIBEWF_CHUNK_DATA_MEMORY_SIZE( *destination_chunk_data ) );
+
 	return( 1 );
 
 on_error:
@@ -390,132 +600,342 @@ on_error:
 	return( -1 );
 }
 
-/* Reads chunk data into a buffer
- * Returns the number of bytes read or -1 on error
+/* Clones the compressed data that was retained by unpacking the source chunk data
+ * into packed destination chunk data, so it can be written without recompression
+ * Returns 1 if successful, 0 if the source chunk data has no reusable compressed data or -1 on error
  */
-ssize_t libewf_chunk_data_read_buffer(
-         libewf_chunk_data_t *chunk_data,
-         uint8_t *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libewf_chunk_data_clone_packed(
+     libewf_chunk_data_t **destination_chunk_data,
+     libewf_chunk_data_t *source_chunk_data,
+     uint16_t compression_method,
+     uint8_t pack_flags,
+     libcerror_error_t **error )
 {
-	static char *function = "libewf_chunk_data_read_buffer";
+	static char *function   = "libewf_chunk_data_clone_packed";
+	size_t padding_size     = 0;
+	size_t zlib_stream_size = 0;
 
-	if( chunk_data == NULL )
+	if( destination_chunk_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk data.",
+		 "%s: invalid destination chunk data.",
 		 function );
 
 		return( -1 );
 	}
-	if( chunk_data->data == NULL )
+	if( *destination_chunk_data != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid chunk data - missing data.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid destination chunk data value already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer == NULL )
+	if( source_chunk_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
+		 "%s: invalid source chunk data.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer_size > (size_t) SSIZE_MAX )
+	/* Only unpacked compressed chunk data that was successfully decompressed
+	 * and thus passed the checksum validation can be reused
+	 */
+	if( ( ( source_chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) == 0 )
+	 || ( ( source_chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) != 0 )
+	 || ( ( source_chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+	 || ( source_chunk_data->compressed_data == NULL )
+	 || ( source_chunk_data->compressed_data_offset != 0 )
+	 || ( source_chunk_data->compressed_data_size < 4 ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid buffer size value exceeds maximum.",
-		 function );
+		return( 0 );
+	}
+	if( ( ( source_chunk_data->range_flags & LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) == 0 )
+	 && ( ( pack_flags & LIBEWF_PACK_FLAG_ADD_ALIGNMENT_PADDING ) != 0 ) )
+	{
+		padding_size = source_chunk_data->compressed_data_size % 16;
 
-		return( -1 );
+		if( padding_size != 0 )
+		{
+			padding_size = 16 - padding_size;
+		}
 	}
-	if( buffer_size < (size_t) chunk_data->chunk_size )
+	*destination_chunk_data = memory_allocate_structure(
+	                           libewf_chunk_data_t );
+
+	if( *destination_chunk_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
-		 "%s: invalid buffer size value too small.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create destination chunk data.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( memory_copy(
-	     buffer,
-	     chunk_data->data,
-	     chunk_data->data_size ) == NULL )
+	if( memory_set(
+	     *destination_chunk_data,
+	     0,
+	     sizeof( libewf_chunk_data_t ) ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to copy chunk data to buffer.",
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear destination chunk data.",
 		 function );
 
+		memory_free(
+		 *destination_chunk_data );
+
+		*destination_chunk_data = NULL;
+
 		return( -1 );
 	}
-	return( (ssize_t) chunk_data->data_size );
-}
+	( *destination_chunk_data )->allocated_data_size = source_chunk_data->compressed_data_size + padding_size;
 
-/* Writes a buffer to the chunk data
- * Returns the number of bytes written or -1 on error
- */
-ssize_t libewf_chunk_data_write_buffer(
-         libewf_chunk_data_t *chunk_data,
-         const uint8_t *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
-{
-	static char *function = "libewf_chunk_data_write_buffer";
+	( *destination_chunk_data )->data = (uint8_t *) memory_allocate(
+	                                                 sizeof( uint8_t ) * ( *destination_chunk_data )->allocated_data_size );
 
-	if( chunk_data == NULL )
+	if( ( *destination_chunk_data )->data == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk data.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create destination data.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( chunk_data->data == NULL )
+	if( memory_copy(
+	     ( *destination_chunk_data )->data,
+	     source_chunk_data->compressed_data,
+	     source_chunk_data->compressed_data_size ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid chunk data - missing data.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy compressed data to destination data.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( buffer == NULL )
+	if( padding_size > 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
-		 function );
+		if( memory_set(
+		     &( ( ( *destination_chunk_data )->data )[ source_chunk_data->compressed_data_size ] ),
+		     0,
+		     padding_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear alignment padding.",
+			 function );
 
-		return( -1 );
+			goto on_error;
+		}
+	}
+	( *destination_chunk_data )->chunk_size   = source_chunk_data->chunk_size;
+	( *destination_chunk_data )->data_size    = source_chunk_data->compressed_data_size;
+	( *destination_chunk_data )->padding_size = padding_size;
+	( *destination_chunk_data )->range_flags  = source_chunk_data->range_flags & ( LIBEWF_RANGE_FLAG_IS_COMPRESSED | LIBEWF_RANGE_FLAG_USES_PATTERN_FILL | LIBEWF_RANGE_FLAG_HAS_SUB_BLOCK_INDEX );
+	( *destination_chunk_data )->range_flags |= LIBEWF_RANGE_FLAG_IS_PACKED;
+	( *destination_chunk_data )->checksum     = source_chunk_data->checksum;
+	( *destination_chunk_data )->flags        = LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
+
+	if( ( ( source_chunk_data->range_flags & LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) == 0 )
+	 && ( compression_method == LIBEWF_COMPRESSION_METHOD_DEFLATE ) )
+	{
+		/* Deflate has its own checksum, stored before the sub-block index if present
+		 */
+		zlib_stream_size = source_chunk_data->compressed_data_size;
+
+		if( ( source_chunk_data->range_flags & LIBEWF_RANGE_FLAG_HAS_SUB_BLOCK_INDEX ) != 0 )
+		{
+			if( libewf_parallel_deflate_get_zlib_stream_size(
+			     source_chunk_data->compressed_data,
+			     source_chunk_data->compressed_data_size,
+			     &zlib_stream_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine zlib stream size.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 &( ( source_chunk_data->compressed_data )[ zlib_stream_size - 4 ] ),
+		 ( *destination_chunk_data )->checksum );
+	}
+	LIBEWF_MEMORY_ACCOUNTING_UPDATE(
+	 LIBEWF_MEMORY_TYPE_CHUNK_DATA,
+	 *destination_chunk_data,
+	 LIBEWF_CHUNK_DATA_MEMORY_SIZE( *destination_chunk_data ) );
+
+	return( 1 );
+
+on_error:
+	if( *destination_chunk_data != NULL )
+	{
+		if( ( *destination_chunk_data )->data != NULL )
+		{
+			memory_free(
+			 ( *destination_chunk_data )->data );
+		}
+		memory_free(
+		 *destination_chunk_data );
+
+		*destination_chunk_data = NULL;
+	}
+	return( -1 );
+}
+
+/* Reads chunk data into a buffer
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libewf_chunk_data_read_buffer(
+         libewf_chunk_data_t *chunk_data,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_read_buffer";
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk data - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size < (size_t) chunk_data->chunk_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid buffer size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     buffer,
+	     chunk_data->data,
+	     chunk_data->data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy chunk data to buffer.",
+		 function );
+
+		return( -1 );
+	}
+	return( (ssize_t) chunk_data->data_size );
+}
+
+/* Writes a buffer to the chunk data
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_chunk_data_write_buffer(
+         libewf_chunk_data_t *chunk_data,
+         const uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_write_buffer";
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk data - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
 	}
 	if( buffer_size > (size_t) SSIZE_MAX )
 	{
@@ -560,11 +980,13 @@ ssize_t libewf_chunk_data_write_buffer(
 
 /* Packs the chunk data
  * This function either adds the checksum or compresses the chunk data
+ * The compression context is optional and reuses the compression state between chunks
  * Returns 1 if successful or -1 on error
  */
 int libewf_chunk_data_pack(
      libewf_chunk_data_t *chunk_data,
      libewf_io_handle_t *io_handle,
+     libewf_compression_context_t *compression_context,
      const uint8_t *compressed_zero_byte_empty_block,
      size_t compressed_zero_byte_empty_block_size,
      uint8_t pack_flags,
@@ -572,7 +994,13 @@ int libewf_chunk_data_pack(
 {
 	static char *function            = "libewf_chunk_data_pack";
 	size_t safe_compressed_data_size = 0;
+	size_t zlib_stream_size          = 0;
 	uint64_t fill_pattern            = 0;
+	uint8_t checksum_is_set          = 0;
+	uint8_t has_sub_block_index      = 0;
+	uint8_t is_fill_chunk            = 0;
+	uint8_t is_packed_fill           = 0;
+	uint8_t skip_compression         = 0;
 	int result                       = 0;
 
 	if( chunk_data == NULL )
@@ -628,17 +1056,43 @@ int libewf_chunk_data_pack(
 	{
 		return( 1 );
 	}
+	/* Fill pattern chunks are also detected when their packed representation
+	 * can be retained by the compression context
+	 */
 	if( ( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION ) != 0 )
-	 || ( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_PATTERN_FILL_COMPRESSION ) != 0 ) )
+	 || ( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_PATTERN_FILL_COMPRESSION ) != 0 )
+	 || ( ( compression_context != NULL )
+	  && ( io_handle->compression_level != LIBEWF_COMPRESSION_NONE ) ) )
 	{
 		if( ( chunk_data->data_size % 8 ) == 0 )
 		{
-			result = libewf_chunk_data_check_for_64_bit_pattern_fill(
-				  chunk_data->data,
-				  chunk_data->data_size,
-				  &fill_pattern,
-				  error );
-
+			/* If data that is not a fill pattern is stored uncompressed the checksum
+			 * is calculated in the same pass as the check for a fill pattern
+			 */
+			if( ( io_handle->compression_level == LIBEWF_COMPRESSION_NONE )
+			 && ( ( pack_flags & LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM ) != 0 )
+			 && ( ( pack_flags & LIBEWF_PACK_FLAG_FORCE_COMPRESSION ) == 0 ) )
+			{
+				result = libewf_chunk_data_check_for_64_bit_pattern_fill_with_checksum(
+					  chunk_data->data,
+					  chunk_data->data_size,
+					  &fill_pattern,
+					  &( chunk_data->checksum ),
+					  error );
+
+				if( result == 0 )
+				{
+					checksum_is_set = 1;
+				}
+			}
+			else
+			{
+				result = libewf_chunk_data_check_for_64_bit_pattern_fill(
+					  chunk_data->data,
+					  chunk_data->data_size,
+					  &fill_pattern,
+					  error );
+			}
 			if( result == -1 )
 			{
 				libcerror_error_set(
@@ -652,8 +1106,11 @@ int libewf_chunk_data_pack(
 			}
 			else if( result != 0 )
 			{
+				is_fill_chunk = 1;
+
 				if( ( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_PATTERN_FILL_COMPRESSION ) != 0 )
-				 || ( fill_pattern == 0 ) )
+				 || ( ( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION ) != 0 )
+				  && ( fill_pattern == 0 ) ) )
 				{
 					pack_flags &= ~( LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM );
 					pack_flags |= LIBEWF_PACK_FLAG_FORCE_COMPRESSION;
@@ -702,8 +1159,62 @@ int libewf_chunk_data_pack(
 	 */
 	chunk_data->range_flags = 0;
 
-	if( ( io_handle->compression_level != LIBEWF_COMPRESSION_NONE )
-	 || ( ( pack_flags & LIBEWF_PACK_FLAG_FORCE_COMPRESSION ) != 0 ) )
+	/* Fill pattern chunks are always compressible
+	 */
+	if( ( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION ) != 0 )
+	 && ( io_handle->compression_level != LIBEWF_COMPRESSION_NONE )
+	 && ( ( pack_flags & LIBEWF_PACK_FLAG_FORCE_COMPRESSION ) == 0 )
+	 && ( is_fill_chunk == 0 ) )
+	{
+		/* In a run of incompressible chunks only probe once every interval
+		 */
+		if( ( compression_context != NULL )
+		 && ( compression_context->number_of_incompressible_chunks >= LIBEWF_ADAPTIVE_COMPRESSION_RUN_THRESHOLD ) )
+		{
+			compression_context->number_of_skipped_chunks += 1;
+
+			if( compression_context->number_of_skipped_chunks < LIBEWF_ADAPTIVE_COMPRESSION_PROBE_INTERVAL )
+			{
+				skip_compression = 1;
+			}
+			else
+			{
+				compression_context->number_of_skipped_chunks = 0;
+			}
+		}
+		if( skip_compression == 0 )
+		{
+			result = libewf_chunk_data_check_for_incompressible_data(
+				  chunk_data->data,
+				  chunk_data->data_size,
+				  error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if chunk data is incompressible.",
+				 function );
+
+				goto on_error;
+			}
+			else if( result != 0 )
+			{
+				skip_compression = 1;
+
+				if( ( compression_context != NULL )
+				 && ( compression_context->number_of_incompressible_chunks < LIBEWF_ADAPTIVE_COMPRESSION_RUN_THRESHOLD ) )
+				{
+					compression_context->number_of_incompressible_chunks += 1;
+				}
+			}
+		}
+	}
+	if( ( skip_compression == 0 )
+	 && ( ( io_handle->compression_level != LIBEWF_COMPRESSION_NONE )
+	  || ( ( pack_flags & LIBEWF_PACK_FLAG_FORCE_COMPRESSION ) != 0 ) ) )
 	{
 		if( ( pack_flags & LIBEWF_PACK_FLAG_FORCE_COMPRESSION ) == 0 )
 		{
@@ -815,16 +1326,63 @@ int libewf_chunk_data_pack(
 			}
 			safe_compressed_data_size = chunk_data->compressed_data_size;
 
-/* TODO add a light weight entropy test */
-			result = libewf_compress_data(
-				  chunk_data->compressed_data,
-				  &safe_compressed_data_size,
-				  io_handle->compression_method,
-				  io_handle->compression_level,
-				  chunk_data->data,
-				  chunk_data->data_size,
-				  error );
+			/* Only EWF2 chunks are deflated in sub-blocks
+			 */
+			if( compression_context != NULL )
+			{
+				if( io_handle->major_version == 2 )
+				{
+					compression_context->sub_block_size = io_handle->sub_block_size;
+				}
+				else
+				{
+					compression_context->sub_block_size = 0;
+				}
+			}
+			/* Runs of identical fill pattern chunks are compressed once
+			 */
+			if( ( is_fill_chunk != 0 )
+			 && ( compression_context != NULL ) )
+			{
+				result = libewf_compression_context_get_packed_fill(
+					  compression_context,
+					  fill_pattern,
+					  chunk_data->data_size,
+					  io_handle->compression_method,
+					  io_handle->compression_level,
+					  chunk_data->compressed_data,
+					  &safe_compressed_data_size,
+					  &( chunk_data->checksum ),
+					  error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve packed fill.",
+					 function );
 
+					goto on_error;
+				}
+				else if( result != 0 )
+				{
+					is_packed_fill = 1;
+				}
+			}
+			if( is_packed_fill == 0 )
+			{
+				result = libewf_compress_data(
+					  compression_context,
+					  chunk_data->compressed_data,
+					  &safe_compressed_data_size,
+					  io_handle->compression_method,
+					  io_handle->compression_level,
+					  chunk_data->data,
+					  chunk_data->data_size,
+					  error );
+			}
 			if( result == -1 )
 			{
 				libcerror_error_set(
@@ -859,6 +1417,35 @@ int libewf_chunk_data_pack(
 					goto on_error;
 				}
 			}
+			/* Data larger than the sub-block size is deflated with a sub-block index
+			 */
+			if( ( result == 1 )
+			 && ( io_handle->compression_method == LIBEWF_COMPRESSION_METHOD_DEFLATE )
+			 && ( compression_context != NULL )
+			 && ( compression_context->sub_block_size > 0 )
+			 && ( chunk_data->data_size > (size_t) compression_context->sub_block_size ) )
+			{
+				has_sub_block_index = 1;
+			}
+			/* Track runs of chunks that compress by less than 3 percent
+			 */
+			if( ( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION ) != 0 )
+			 && ( compression_context != NULL ) )
+			{
+				if( ( result == 0 )
+				 || ( safe_compressed_data_size >= ( chunk_data->data_size - ( chunk_data->data_size / 32 ) ) ) )
+				{
+					if( compression_context->number_of_incompressible_chunks < LIBEWF_ADAPTIVE_COMPRESSION_RUN_THRESHOLD )
+					{
+						compression_context->number_of_incompressible_chunks += 1;
+					}
+				}
+				else
+				{
+					compression_context->number_of_incompressible_chunks = 0;
+					compression_context->number_of_skipped_chunks        = 0;
+				}
+			}
 		}
 		if( ( ( pack_flags & LIBEWF_PACK_FLAG_FORCE_COMPRESSION ) != 0 )
 		 || ( safe_compressed_data_size < chunk_data->data_size ) )
@@ -882,12 +1469,37 @@ int libewf_chunk_data_pack(
 			}
 			else
 			{
-				if( io_handle->compression_method == LIBEWF_COMPRESSION_METHOD_DEFLATE )
+				if( has_sub_block_index != 0 )
+				{
+					chunk_data->range_flags |= LIBEWF_RANGE_FLAG_HAS_SUB_BLOCK_INDEX;
+				}
+				if( ( io_handle->compression_method == LIBEWF_COMPRESSION_METHOD_DEFLATE )
+				 && ( is_packed_fill == 0 ) )
 				{
-					/* Deflate has its own checksum
+					/* Deflate has its own checksum, stored before the sub-block index if present
 					 */
+					zlib_stream_size = safe_compressed_data_size;
+
+					if( has_sub_block_index != 0 )
+					{
+						if( libewf_parallel_deflate_get_zlib_stream_size(
+						     chunk_data->compressed_data,
+						     safe_compressed_data_size,
+						     &zlib_stream_size,
+						     error ) != 1 )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+							 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+							 "%s: unable to determine zlib stream size.",
+							 function );
+
+							goto on_error;
+						}
+					}
 					byte_stream_copy_to_uint32_little_endian(
-					 &( ( chunk_data->compressed_data )[ safe_compressed_data_size - 4 ] ),
+					 &( ( chunk_data->compressed_data )[ zlib_stream_size - 4 ] ),
 					 chunk_data->checksum );
 				}
 /* TODO bzip2 support */
@@ -900,9 +1512,34 @@ int libewf_chunk_data_pack(
 					safe_compressed_data_size         -= 4;
 				}
 #endif
-				if( ( pack_flags & LIBEWF_PACK_FLAG_ADD_ALIGNMENT_PADDING ) != 0 )
+				if( ( is_fill_chunk != 0 )
+				 && ( is_packed_fill == 0 )
+				 && ( compression_context != NULL ) )
 				{
-					chunk_data->padding_size = safe_compressed_data_size % 16;
+					if( libewf_compression_context_set_packed_fill(
+					     compression_context,
+					     fill_pattern,
+					     chunk_data->data_size,
+					     io_handle->compression_method,
+					     io_handle->compression_level,
+					     chunk_data->compressed_data,
+					     safe_compressed_data_size,
+					     chunk_data->checksum,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+						 "%s: unable to set packed fill.",
+						 function );
+
+						goto on_error;
+					}
+				}
+				if( ( pack_flags & LIBEWF_PACK_FLAG_ADD_ALIGNMENT_PADDING ) != 0 )
+				{
+					chunk_data->padding_size = safe_compressed_data_size % 16;
 
 					if( chunk_data->padding_size != 0 )
 					{
@@ -941,21 +1578,24 @@ int libewf_chunk_data_pack(
 	if( ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) == 0 )
 	 && ( ( pack_flags & LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM ) != 0 ) )
 	{
-		if( libewf_checksum_calculate_adler32(
-		     &( chunk_data->checksum ),
-		     chunk_data->data,
-		     chunk_data->data_size,
-		     1,
-		     error ) != 1 )
+		if( checksum_is_set == 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to calculate checksum.",
-			 function );
+			if( libewf_checksum_calculate_adler32(
+			     &( chunk_data->checksum ),
+			     chunk_data->data,
+			     chunk_data->data_size,
+			     1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to calculate checksum.",
+				 function );
 
-			goto on_error;
+				goto on_error;
+			}
 		}
 		if( ( chunk_data->data_size + 4 ) <= chunk_data->allocated_data_size )
 		{
@@ -1013,8 +1653,21 @@ int libewf_chunk_data_pack(
 	{
 		if( ( chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA ) != 0 )
 		{
-			memory_free(
-			 chunk_data->data );
+			if( libewf_chunk_data_free_buffer(
+			     chunk_data,
+			     &( chunk_data->data ),
+			     chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_DATA,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free data.",
+				 function );
+
+				goto on_error;
+			}
 		}
 		chunk_data->data  = chunk_data->compressed_data;
 		chunk_data->flags = LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
@@ -1024,6 +1677,11 @@ int libewf_chunk_data_pack(
 	}
 	chunk_data->range_flags |= LIBEWF_RANGE_FLAG_IS_PACKED;
 
+	LIBEWF_MEMORY_ACCOUNTING_UPDATE(
+	 LIBEWF_MEMORY_TYPE_CHUNK_DATA,
+	 chunk_data,
+	 LIBEWF_CHUNK_DATA_MEMORY_SIZE( chunk_data ) );
+
 	return( 1 );
 
 on_error:
@@ -1041,16 +1699,18 @@ on_error:
 
 /* Unpacks the chunk data
  * This function either validates the checksum or decompresses the chunk data
+ * The range flags are checked once and the chunk data is handed to the unpack
+ * function of the corresponding chunk type
+ * The compression context is optional and reuses the decompression state between chunks
  * Returns 1 if successful or -1 on error
  */
 int libewf_chunk_data_unpack(
      libewf_chunk_data_t *chunk_data,
      libewf_io_handle_t *io_handle,
+     libewf_compression_context_t *compression_context,
      libcerror_error_t **error )
 {
-	static char *function        = "libewf_chunk_data_unpack";
-	size_t remaining_chunk_size  = 0;
-	uint32_t calculated_checksum = 0;
+	static char *function = "libewf_chunk_data_unpack";
 
 	if( chunk_data == NULL )
 	{
@@ -1103,221 +1763,54 @@ int libewf_chunk_data_unpack(
 	}
 	if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) != 0 )
 	{
-		if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 )
-		{
-			if( chunk_data->compressed_data != NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-				 "%s: invalid chunk data - compressed data value already set.",
-				 function );
-
-				goto on_error;
-			}
-			chunk_data->compressed_data      = chunk_data->data;
-			chunk_data->compressed_data_size = chunk_data->data_size;
+		chunk_data->unpack_status = LIBEWF_CHUNK_DATA_UNPACK_STATUS_OK;
 
-			/* Reserve 4 bytes for the checksum
-			 */
-			chunk_data->allocated_data_size = (size_t) ( chunk_data->chunk_size + 4 );
-
-			/* The allocated data size should be rounded to the next 16-byte increment
-			 */
-			if( ( chunk_data->allocated_data_size % 16 ) != 0 )
-			{
-				chunk_data->allocated_data_size += 16;
-			}
-			chunk_data->allocated_data_size = ( chunk_data->allocated_data_size / 16 ) * 16;
-
-			chunk_data->data = (uint8_t *) memory_allocate(
-			                                sizeof( uint8_t ) * chunk_data->allocated_data_size );
-
-			if( chunk_data->data == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_MEMORY,
-				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-				 "%s: unable to create data.",
-				 function );
+		/* Decrypting encrypted chunk data is not supported
+		 */
+		if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_ENCRYPTED ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported encrypted chunk data.",
+			 function );
 
-				goto on_error;
-			}
-			if( memory_set(
-			     chunk_data->data,
-			     0,
-			     sizeof( uint8_t ) * chunk_data->allocated_data_size ) == NULL )
+			return( -1 );
+		}
+		if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+		{
+			if( libewf_chunk_data_unpack_compressed(
+			     chunk_data,
+			     io_handle,
+			     compression_context,
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_MEMORY,
-				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-				 "%s: unable to clear data.",
+				 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+				 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+				 "%s: unable to unpack compressed chunk data.",
 				 function );
 
-				goto on_error;
-			}
-			chunk_data->data_size = (size_t) chunk_data->chunk_size;
-
-			if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) != 0 )
-			{
-				if( chunk_data->compressed_data_size < (size_t) 8 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-					 "%s: invalid chunk data - compressed data size value out of bounds.",
-					 function );
-
-					goto on_error;
-				}
-				remaining_chunk_size = (size_t) chunk_data->chunk_size;
-
-				switch( remaining_chunk_size % 8 )
-				{
-					case 7:
-						( chunk_data->data )[ --remaining_chunk_size ] = ( chunk_data->compressed_data )[ 7 ];
-
-					LIBEWF_ATTRIBUTE_FALLTHROUGH;
-					case 6:
-						( chunk_data->data )[ --remaining_chunk_size ] = ( chunk_data->compressed_data )[ 6 ];
-
-					LIBEWF_ATTRIBUTE_FALLTHROUGH;
-					case 5:
-						( chunk_data->data )[ --remaining_chunk_size ] = ( chunk_data->compressed_data )[ 5 ];
-
-					LIBEWF_ATTRIBUTE_FALLTHROUGH;
-					case 4:
-						( chunk_data->data )[ --remaining_chunk_size ] = ( chunk_data->compressed_data )[ 4 ];
-
-					LIBEWF_ATTRIBUTE_FALLTHROUGH;
-					case 3:
-						( chunk_data->data )[ --remaining_chunk_size ] = ( chunk_data->compressed_data )[ 3 ];
-
-					LIBEWF_ATTRIBUTE_FALLTHROUGH;
-					case 2:
-						( chunk_data->data )[ --remaining_chunk_size ] = ( chunk_data->compressed_data )[ 2 ];
-
-					LIBEWF_ATTRIBUTE_FALLTHROUGH;
-					case 1:
-						( chunk_data->data )[ --remaining_chunk_size ] = ( chunk_data->compressed_data )[ 1 ];
-				}
-				while( remaining_chunk_size > 0 )
-				{
-/* TODO make this memory aligned ? */
-					( chunk_data->data )[ --remaining_chunk_size ] = ( chunk_data->compressed_data )[ 7 ];
-					( chunk_data->data )[ --remaining_chunk_size ] = ( chunk_data->compressed_data )[ 6 ];
-					( chunk_data->data )[ --remaining_chunk_size ] = ( chunk_data->compressed_data )[ 5 ];
-					( chunk_data->data )[ --remaining_chunk_size ] = ( chunk_data->compressed_data )[ 4 ];
-					( chunk_data->data )[ --remaining_chunk_size ] = ( chunk_data->compressed_data )[ 3 ];
-					( chunk_data->data )[ --remaining_chunk_size ] = ( chunk_data->compressed_data )[ 2 ];
-					( chunk_data->data )[ --remaining_chunk_size ] = ( chunk_data->compressed_data )[ 1 ];
-					( chunk_data->data )[ --remaining_chunk_size ] = ( chunk_data->compressed_data )[ 0 ];
-				}
-			}
-			else
-			{
-				if( libewf_decompress_data(
-				     chunk_data->compressed_data,
-				     chunk_data->compressed_data_size,
-				     io_handle->compression_method,
-				     chunk_data->data,
-				     &( chunk_data->data_size ),
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
-					 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
-					 "%s: unable to decompress chunk data.",
-					 function );
-
-#if defined( HAVE_VERBOSE_OUTPUT )
-					if( libcnotify_verbose != 0 )
-					{
-						if( ( error != NULL )
-						 && ( *error != NULL ) )
-						{
-							libcnotify_print_error_backtrace(
-							 *error );
-						}
-					}
-#endif
-					libcerror_error_free(
-					 error );
-
-					chunk_data->data_size    = (size_t) chunk_data->chunk_size;
-					chunk_data->range_flags |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
-				}
+				return( -1 );
 			}
 		}
 		else if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_HAS_CHECKSUM ) != 0 )
 		{
-			if( chunk_data->data_size < 4 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-				 "%s: invalid chunk data - data size value out of bounds.",
-				 function );
-
-				goto on_error;
-			}
-			chunk_data->data_size -= 4;
-
-			if( ( chunk_data->chunk_io_flags & LIBEWF_CHUNK_IO_FLAG_CHECKSUM_SET ) == 0 )
-			{
-				byte_stream_copy_to_uint32_little_endian(
-				 &( ( chunk_data->data )[ chunk_data->data_size ] ),
-				 chunk_data->checksum );
-			}
-			if( libewf_checksum_calculate_adler32(
-			     &calculated_checksum,
-			     chunk_data->data,
-			     chunk_data->data_size,
-			     1,
+			if( libewf_chunk_data_unpack_with_checksum(
+			     chunk_data,
+			     io_handle,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to calculate checksum.",
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to unpack chunk data with checksum.",
 				 function );
 
-				goto on_error;
-			}
-			if( chunk_data->checksum != calculated_checksum )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_INPUT,
-				 LIBCERROR_INPUT_ERROR_CHECKSUM_MISMATCH,
-				 "%s: chunk data checksum does not match (stored: 0x%08" PRIx32 ", calculated: 0x%08" PRIx32 ").",
-				 function,
-				 chunk_data->checksum,
-				 calculated_checksum );
-
-#if defined( HAVE_VERBOSE_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					if( ( error != NULL )
-					 && ( *error != NULL ) )
-					{
-						libcnotify_print_error_backtrace(
-						 *error );
-					}
-				}
-#endif
-				libcerror_error_free(
-				 error );
-
-				chunk_data->data_size    = (size_t) chunk_data->chunk_size;
-				chunk_data->range_flags |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
+				return( -1 );
 			}
 		}
 		chunk_data->range_flags &= ~( LIBEWF_RANGE_FLAG_IS_PACKED );
@@ -1337,106 +1830,875 @@ int libewf_chunk_data_unpack(
 			 "%s: unable to zero chunk data.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
 	}
 	return( 1 );
-
-on_error:
-	if( chunk_data->compressed_data != NULL )
-	{
-		if( chunk_data->data != NULL )
-		{
-			memory_free(
-			 chunk_data->data );
-		}
-		chunk_data->data      = chunk_data->compressed_data;
-		chunk_data->data_size = chunk_data->compressed_data_size;
-
-		chunk_data->compressed_data      = NULL;
-		chunk_data->compressed_data_size = 0;
-	}
-	return( -1 );
 }
 
-/* Checks if a buffer containing the chunk data is filled with same value bytes (empty-block)
- * Returns 1 if a pattern was found, 0 if not or -1 on error
+/* Unpacks compressed chunk data
+ * This function either fills the chunk data with the 64-bit pattern or decompresses
+ * the chunk data, the buffer is only cleared before decompression since a pattern fill
+ * overwrites the entire chunk
+ * The compression context is optional and reuses the decompression state between chunks
+ * Returns 1 if successful or -1 on error
  */
-int libewf_chunk_data_check_for_empty_block(
-     const uint8_t *data,
-     size_t data_size,
+int libewf_chunk_data_unpack_compressed(
+     libewf_chunk_data_t *chunk_data,
+     libewf_io_handle_t *io_handle,
+     libewf_compression_context_t *compression_context,
      libcerror_error_t **error )
 {
-	libewf_aligned_t *aligned_data_index = NULL;
-	libewf_aligned_t *aligned_data_start = NULL;
-	uint8_t *data_index                  = NULL;
-	uint8_t *data_start                  = NULL;
-	static char *function                = "libewf_chunk_data_check_for_empty_block";
+	libcerror_error_t **decompress_error = NULL;
+	static char *function                = "libewf_chunk_data_unpack_compressed";
+	int64_t start_timestamp              = 0;
 
-	if( data == NULL )
+	if( chunk_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid data.",
+		 "%s: invalid chunk data.",
 		 function );
 
 		return( -1 );
 	}
-	if( data_size > (size_t) SSIZE_MAX )
+	if( chunk_data->compressed_data != NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid data size value exceeds maximum.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk data - compressed data value already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( data_size <= 1 )
+	if( io_handle == NULL )
 	{
-		return( 0 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
 	}
-	data_start = (uint8_t *) data;
-	data_index = (uint8_t *) data + 1;
+	if( ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) != 0 )
+	 && ( chunk_data->data_size < (size_t) 8 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk data - compressed data size value out of bounds.",
+		 function );
 
-	data_size--;
+		return( -1 );
+	}
+	if( libewf_chunk_data_allocate_decompressed_data(
+	     chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to allocate decompressed data.",
+		 function );
 
-	/* Only optimize for data larger than the alignment
-	 */
-	if( data_size > ( sizeof( libewf_aligned_t ) + sizeof( libewf_aligned_t ) ) )
+		return( -1 );
+	}
+	if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) != 0 )
 	{
-		/* Align the data start
-		 */
-		while( ( (intptr_t) data_start % sizeof( libewf_aligned_t ) ) != 0 )
+		if( libewf_chunk_data_fill_with_64_bit_pattern(
+		     chunk_data->data,
+		     chunk_data->data_size,
+		     chunk_data->compressed_data,
+		     error ) != 1 )
 		{
-			if( *data_start != *data_index )
-			{
-				return( 0 );
-			}
-			data_start++;
-			data_index++;
-			data_size--;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to fill chunk data with pattern.",
+			 function );
+
+			goto on_error;
 		}
-		/* Align the data index
-		 */
-		while( ( (intptr_t) data_index % sizeof( libewf_aligned_t ) ) != 0 )
+		if( memory_set(
+		     &( ( chunk_data->data )[ chunk_data->data_size ] ),
+		     0,
+		     sizeof( uint8_t ) * ( chunk_data->allocated_data_size - chunk_data->data_size ) ) == NULL )
 		{
-			if( *data_start != *data_index )
-			{
-				return( 0 );
-			}
-			data_index++;
-			data_size--;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear trailing data.",
+			 function );
+
+			goto on_error;
+		}
+		return( 1 );
+	}
+	if( memory_set(
+	     chunk_data->data,
+	     0,
+	     sizeof( uint8_t ) * chunk_data->allocated_data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear data.",
+		 function );
+
+		goto on_error;
+	}
+	if( io_handle->statistics != NULL )
+	{
+		if( libewf_statistics_get_timestamp(
+		     &start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve start timestamp.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* Chunk data that fails to decompress is expected on damaged media, hence
+	 * the error is only generated when it is printed by the verbose output
+	 */
+#if defined( HAVE_VERBOSE_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		decompress_error = error;
+	}
+#endif
+	if( compression_context != NULL )
+	{
+		compression_context->has_sub_block_index = (uint8_t) ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_HAS_SUB_BLOCK_INDEX ) != 0 );
+	}
+	LIBEWF_TRACE_DECOMPRESS_START(
+	 chunk_data->compressed_data_size );
+
+	if( libewf_decompress_data(
+	     compression_context,
+	     chunk_data->compressed_data,
+	     chunk_data->compressed_data_size,
+	     io_handle->compression_method,
+	     io_handle->decompression_backend,
+	     chunk_data->data,
+	     &( chunk_data->data_size ),
+	     decompress_error ) != 1 )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( decompress_error != NULL )
+		{
+			libcerror_error_set(
+			 decompress_error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+			 "%s: unable to decompress chunk data.",
+			 function );
+
+			if( *decompress_error != NULL )
+			{
+				libcnotify_print_error_backtrace(
+				 *decompress_error );
+			}
+			libcerror_error_free(
+			 decompress_error );
+		}
+#endif
+		chunk_data->data_size     = (size_t) chunk_data->chunk_size;
+		chunk_data->range_flags  |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
+		chunk_data->unpack_status = LIBEWF_CHUNK_DATA_UNPACK_STATUS_DECOMPRESS_FAILED;
+	}
+	LIBEWF_TRACE_DECOMPRESS_END(
+	 chunk_data->compressed_data_size,
+	 chunk_data->data_size );
+
+	if( io_handle->statistics != NULL )
+	{
+		if( libewf_statistics_add_decompression(
+		     io_handle->statistics,
+		     start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to add decompression to statistics.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	libewf_chunk_data_free_decompressed_data(
+	 chunk_data,
+	 chunk_data->allocated_data_size,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Allocates the data of the decompressed chunk data
+ * The packed data is retained as the compressed data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_allocate_decompressed_data(
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_allocate_decompressed_data";
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data->compressed_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk data - compressed data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_data->compressed_data      = chunk_data->data;
+	chunk_data->compressed_data_size = chunk_data->data_size;
+
+	chunk_data->data = NULL;
+
+	if( ( chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_DATA ) != 0 )
+	{
+		chunk_data->flags &= ~( LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_DATA );
+		chunk_data->flags |= LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_COMPRESSED_DATA;
+	}
+	/* Reserve 4 bytes for the checksum
+	 */
+	chunk_data->allocated_data_size = (size_t) ( chunk_data->chunk_size + 4 );
+
+	/* The allocated data size should be rounded to the next 16-byte increment
+	 */
+	if( ( chunk_data->allocated_data_size % 16 ) != 0 )
+	{
+		chunk_data->allocated_data_size += 16;
+	}
+	chunk_data->allocated_data_size = ( chunk_data->allocated_data_size / 16 ) * 16;
+
+	if( ( chunk_data->buffer_pool != NULL )
+	 && ( chunk_data->buffer_pool->buffer_size == chunk_data->allocated_data_size ) )
+	{
+		if( libewf_buffer_pool_get_buffer(
+		     chunk_data->buffer_pool,
+		     &( chunk_data->data ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data from buffer pool.",
+			 function );
+
+			goto on_error;
+		}
+		chunk_data->flags |= LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_DATA;
+	}
+	else
+	{
+		chunk_data->data = (uint8_t *) memory_allocate(
+		                                sizeof( uint8_t ) * chunk_data->allocated_data_size );
+
+		if( chunk_data->data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create data.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	chunk_data->data_size = (size_t) chunk_data->chunk_size;
+
+	LIBEWF_MEMORY_ACCOUNTING_UPDATE(
+	 LIBEWF_MEMORY_TYPE_CHUNK_DATA,
+	 chunk_data,
+	 LIBEWF_CHUNK_DATA_MEMORY_SIZE( chunk_data ) );
+
+	return( 1 );
+
+on_error:
+	libewf_chunk_data_free_decompressed_data(
+	 chunk_data,
+	 chunk_data->allocated_data_size,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Frees the data of the decompressed chunk data
+ * The compressed data is restored as the packed data with its allocated data size
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_free_decompressed_data(
+     libewf_chunk_data_t *chunk_data,
+     size_t packed_allocated_data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_free_decompressed_data";
+	int result            = 1;
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data->compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk data - missing compressed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data->data != NULL )
+	{
+		if( libewf_chunk_data_free_buffer(
+		     chunk_data,
+		     &( chunk_data->data ),
+		     chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_DATA,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free data.",
+			 function );
+
+			result = -1;
+		}
+	}
+	chunk_data->flags &= ~( LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_DATA );
+
+	if( ( chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_COMPRESSED_DATA ) != 0 )
+	{
+		chunk_data->flags &= ~( LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_COMPRESSED_DATA );
+		chunk_data->flags |= LIBEWF_CHUNK_DATA_ITEM_FLAG_POOLED_DATA;
+	}
+	chunk_data->data                = chunk_data->compressed_data;
+	chunk_data->data_size           = chunk_data->compressed_data_size;
+	chunk_data->allocated_data_size = packed_allocated_data_size;
+
+	chunk_data->compressed_data      = NULL;
+	chunk_data->compressed_data_size = 0;
+
+	LIBEWF_MEMORY_ACCOUNTING_UPDATE(
+	 LIBEWF_MEMORY_TYPE_CHUNK_DATA,
+	 chunk_data,
+	 LIBEWF_CHUNK_DATA_MEMORY_SIZE( chunk_data ) );
+
+	return( result );
+}
+
+/* Unpacks uncompressed chunk data that is stored with a checksum
+ * This function strips the Adler-32 checksum and validates it unless the caller opted out
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_unpack_with_checksum(
+     libewf_chunk_data_t *chunk_data,
+     libewf_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function        = "libewf_chunk_data_unpack_with_checksum";
+	int64_t start_timestamp      = 0;
+	uint32_t calculated_checksum = 0;
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+	libcerror_error_t *checksum_error = NULL;
+#endif
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data->data_size < 4 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk data - data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_data->data_size -= 4;
+
+	if( ( chunk_data->chunk_io_flags & LIBEWF_CHUNK_IO_FLAG_CHECKSUM_SET ) == 0 )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 &( ( chunk_data->data )[ chunk_data->data_size ] ),
+		 chunk_data->checksum );
+	}
+	/* The checksum is not verified if the caller opted out
+	 */
+	if( io_handle->verify_checksums == 0 )
+	{
+		return( 1 );
+	}
+	if( io_handle->statistics != NULL )
+	{
+		if( libewf_statistics_get_timestamp(
+		     &start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve start timestamp.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libewf_checksum_calculate_adler32(
+	     &calculated_checksum,
+	     chunk_data->data,
+	     chunk_data->data_size,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate checksum.",
+		 function );
+
+		return( -1 );
+	}
+	/* A checksum mismatch is expected on damaged media, hence the error
+	 * is only generated when it is printed by the verbose output
+	 */
+	if( chunk_data->checksum != calculated_checksum )
+	{
+		chunk_data->data_size           = (size_t) chunk_data->chunk_size;
+		chunk_data->range_flags        |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
+		chunk_data->unpack_status       = LIBEWF_CHUNK_DATA_UNPACK_STATUS_CHECKSUM_MISMATCH;
+		chunk_data->calculated_checksum = calculated_checksum;
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			if( libewf_chunk_data_get_unpack_error(
+			     chunk_data,
+			     &checksum_error ) == 1 )
+			{
+				libcnotify_print_error_backtrace(
+				 checksum_error );
+			}
+			libcerror_error_free(
+			 &checksum_error );
+		}
+#endif
+	}
+	if( io_handle->statistics != NULL )
+	{
+		if( libewf_statistics_add_checksum_verification(
+		     io_handle->statistics,
+		     start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to add checksum verification to statistics.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the error of chunk data that failed to unpack
+ * The error is generated from the unpack status on request
+ * Returns 1 if successful, 0 if the chunk data did not fail to unpack or -1 on error
+ */
+int libewf_chunk_data_get_unpack_error(
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_get_unpack_error";
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( error == NULL )
+	{
+		return( -1 );
+	}
+	switch( chunk_data->unpack_status )
+	{
+		case LIBEWF_CHUNK_DATA_UNPACK_STATUS_OK:
+			return( 0 );
+
+		case LIBEWF_CHUNK_DATA_UNPACK_STATUS_DECOMPRESS_FAILED:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+			 "%s: unable to decompress chunk data.",
+			 function );
+
+			break;
+
+		case LIBEWF_CHUNK_DATA_UNPACK_STATUS_CHECKSUM_MISMATCH:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_INPUT,
+			 LIBCERROR_INPUT_ERROR_CHECKSUM_MISMATCH,
+			 "%s: chunk data checksum does not match (stored: 0x%08" PRIx32 ", calculated: 0x%08" PRIx32 ").",
+			 function,
+			 chunk_data->checksum,
+			 chunk_data->calculated_checksum );
+
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported unpack status: %" PRIu8 ".",
+			 function,
+			 chunk_data->unpack_status );
+
+			return( -1 );
+	}
+	return( 1 );
+}
+
+/* Unpacks the chunk data directly into a buffer
+ * Only compressed chunk data that is not pattern filled or encrypted is unpacked, other chunk data
+ * and chunk data that fails to decompress is left packed to be unpacked by libewf_chunk_data_unpack
+ * The compression context is optional and reuses the decompression state between chunks
+ * Returns 1 if successful, 0 if the chunk data was not unpacked or -1 on error
+ */
+int libewf_chunk_data_unpack_to_buffer(
+     libewf_chunk_data_t *chunk_data,
+     libewf_io_handle_t *io_handle,
+     libewf_compression_context_t *compression_context,
+     uint8_t *buffer,
+     size_t buffer_size,
+     size_t *data_size,
+     libcerror_error_t **error )
+{
+	static char *function    = "libewf_chunk_data_unpack_to_buffer";
+	size_t uncompressed_size = 0;
+	int64_t start_timestamp  = 0;
+	int result               = 0;
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk data - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) == 0 )
+	 || ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) == 0 )
+	 || ( ( chunk_data->range_flags & ( LIBEWF_RANGE_FLAG_USES_PATTERN_FILL | LIBEWF_RANGE_FLAG_IS_ENCRYPTED ) ) != 0 ) )
+	{
+		return( 0 );
+	}
+	if( buffer_size < (size_t) chunk_data->chunk_size )
+	{
+		return( 0 );
+	}
+	if( io_handle->statistics != NULL )
+	{
+		if( libewf_statistics_get_timestamp(
+		     &start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve start timestamp.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	uncompressed_size = (size_t) chunk_data->chunk_size;
+
+	if( compression_context != NULL )
+	{
+		compression_context->has_sub_block_index = (uint8_t) ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_HAS_SUB_BLOCK_INDEX ) != 0 );
+	}
+	LIBEWF_TRACE_DECOMPRESS_START(
+	 chunk_data->data_size );
+
+	/* The error is not generated since a chunk that fails to decompress
+	 * is decompressed again and reported by libewf_chunk_data_unpack
+	 */
+	result = libewf_decompress_data(
+	          compression_context,
+	          chunk_data->data,
+	          chunk_data->data_size,
+	          io_handle->compression_method,
+	          io_handle->decompression_backend,
+	          buffer,
+	          &uncompressed_size,
+	          NULL );
+
+	if( result != 1 )
+	{
+		return( 0 );
+	}
+	LIBEWF_TRACE_DECOMPRESS_END(
+	 chunk_data->data_size,
+	 uncompressed_size );
+
+	if( io_handle->statistics != NULL )
+	{
+		if( libewf_statistics_add_decompression(
+		     io_handle->statistics,
+		     start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to add decompression to statistics.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	*data_size = uncompressed_size;
+
+	return( 1 );
+}
+
+/* Checks if a buffer containing the chunk data is filled with same value bytes (empty-block)
+ * Returns 1 if a pattern was found, 0 if not or -1 on error
+ */
+int libewf_chunk_data_check_for_empty_block(
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	const libewf_aligned_t *aligned_data_index = NULL;
+	const uint8_t *data_index                  = NULL;
+	static char *function                      = "libewf_chunk_data_check_for_empty_block";
+	libewf_aligned_t aligned_difference        = 0;
+	libewf_aligned_t aligned_pattern           = 0;
+	uint8_t byte_value                         = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size <= 1 )
+	{
+		return( 0 );
+	}
+	byte_value = data[ 0 ];
+	data_index = &( data[ 1 ] );
+
+	data_size--;
+
+	/* Only optimize for data larger than a block of aligned values
+	 */
+	if( data_size > ( 8 * sizeof( libewf_aligned_t ) ) )
+	{
+		/* Align the data index
+		 */
+		while( ( (intptr_t) data_index % sizeof( libewf_aligned_t ) ) != 0 )
+		{
+			if( *data_index != byte_value )
+			{
+				return( 0 );
+			}
+			data_index++;
+			data_size--;
 		}
-		aligned_data_start = (libewf_aligned_t *) data_start;
-		aligned_data_index = (libewf_aligned_t *) data_index;
+		/* Set the byte value in every byte of the aligned pattern
+		 */
+		aligned_pattern    = ( (libewf_aligned_t) -1 / 0xff ) * byte_value;
+		aligned_data_index = (const libewf_aligned_t *) data_index;
+
+		/* Compare blocks of 8 aligned values without intermediate branches
+		 * so that the compiler can vectorize the comparison
+		 */
+		while( data_size >= ( 8 * sizeof( libewf_aligned_t ) ) )
+		{
+			aligned_difference = ( aligned_data_index[ 0 ] ^ aligned_pattern )
+			                   | ( aligned_data_index[ 1 ] ^ aligned_pattern )
+			                   | ( aligned_data_index[ 2 ] ^ aligned_pattern )
+			                   | ( aligned_data_index[ 3 ] ^ aligned_pattern )
+			                   | ( aligned_data_index[ 4 ] ^ aligned_pattern )
+			                   | ( aligned_data_index[ 5 ] ^ aligned_pattern )
+			                   | ( aligned_data_index[ 6 ] ^ aligned_pattern )
+			                   | ( aligned_data_index[ 7 ] ^ aligned_pattern );
+
+			if( aligned_difference != 0 )
+			{
+				return( 0 );
+			}
+			aligned_data_index += 8;
 
-		while( data_size > sizeof( libewf_aligned_t ) )
+			data_size -= 8 * sizeof( libewf_aligned_t );
+		}
+		while( data_size >= sizeof( libewf_aligned_t ) )
 		{
-			if( *aligned_data_start != *aligned_data_index )
+			if( *aligned_data_index != aligned_pattern )
 			{
 				return( 0 );
 			}
@@ -1444,11 +2706,11 @@ int libewf_chunk_data_check_for_empty_block(
 
 			data_size -= sizeof( libewf_aligned_t );
 		}
-		data_index = (uint8_t *) aligned_data_index;
+		data_index = (const uint8_t *) aligned_data_index;
 	}
 	while( data_size != 0 )
 	{
-		if( *data_start != *data_index )
+		if( *data_index != byte_value )
 		{
 			return( 0 );
 		}
@@ -1458,20 +2720,380 @@ int libewf_chunk_data_check_for_empty_block(
 	return( 1 );
 }
 
-/* Checks if a buffer containing the chunk data is filled with a 64-bit pattern
- * Returns 1 if a pattern was found, 0 if not or -1 on error
+/* Checks if a buffer containing the chunk data is filled with a 64-bit pattern
+ * Returns 1 if a pattern was found, 0 if not or -1 on error
+ */
+int libewf_chunk_data_check_for_64_bit_pattern_fill(
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t *pattern,
+     libcerror_error_t **error )
+{
+	const uint64_t *aligned_data_index = NULL;
+	const uint8_t *data_index          = NULL;
+	const uint8_t *data_start          = NULL;
+	static char *function              = "libewf_chunk_data_check_for_64_bit_pattern_fill";
+	uint64_t aligned_difference        = 0;
+	uint64_t aligned_pattern           = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( pattern == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pattern.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size <= 8 )
+	 || ( data_size % 8 ) != 0 )
+	{
+		return( 0 );
+	}
+	data_start = data;
+	data_index = &( data[ 8 ] );
+	data_size -= 8;
+
+	/* If the data is 64-bit aligned every 64-bit value must match the pattern
+	 */
+	if( ( (intptr_t) data % 8 ) == 0 )
+	{
+		aligned_pattern    = *( (const uint64_t *) data );
+		aligned_data_index = (const uint64_t *) data_index;
+
+		/* Compare blocks of 8 aligned values without intermediate branches
+		 * so that the compiler can vectorize the comparison
+		 */
+		while( data_size >= 64 )
+		{
+			aligned_difference = ( aligned_data_index[ 0 ] ^ aligned_pattern )
+			                   | ( aligned_data_index[ 1 ] ^ aligned_pattern )
+			                   | ( aligned_data_index[ 2 ] ^ aligned_pattern )
+			                   | ( aligned_data_index[ 3 ] ^ aligned_pattern )
+			                   | ( aligned_data_index[ 4 ] ^ aligned_pattern )
+			                   | ( aligned_data_index[ 5 ] ^ aligned_pattern )
+			                   | ( aligned_data_index[ 6 ] ^ aligned_pattern )
+			                   | ( aligned_data_index[ 7 ] ^ aligned_pattern );
+
+			if( aligned_difference != 0 )
+			{
+				return( 0 );
+			}
+			aligned_data_index += 8;
+
+			data_size -= 64;
+		}
+		while( data_size != 0 )
+		{
+			if( *aligned_data_index != aligned_pattern )
+			{
+				return( 0 );
+			}
+			aligned_data_index++;
+
+			data_size -= 8;
+		}
+	}
+	else
+	{
+		while( data_size != 0 )
+		{
+			if( *data_start != *data_index )
+			{
+				return( 0 );
+			}
+			data_start++;
+			data_index++;
+			data_size--;
+		}
+	}
+	byte_stream_copy_to_uint64_little_endian(
+	 data,
+	 *pattern );
+
+	return( 1 );
+}
+
+/* Checks if a buffer containing the chunk data is filled with a 64-bit pattern
+ * and calculates the Adler-32 of the chunk data if it is not
+ * The data is processed in blocks that fit in the first level data cache, where
+ * every block is checked for the pattern and, once the data was found not to be
+ * filled, checksummed while it is cache resident. The checksum of the blocks that
+ * matched the pattern before the first block that did not is calculated when
+ * that block is found, such that a fill pattern chunk is traversed only once and
+ * is not checksummed, since it is stored compressed
+ * Returns 1 if a pattern was found, 0 if not and the checksum was set or -1 on error
+ */
+int libewf_chunk_data_check_for_64_bit_pattern_fill_with_checksum(
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t *pattern,
+     uint32_t *checksum,
+     libcerror_error_t **error )
+{
+	static char *function   = "libewf_chunk_data_check_for_64_bit_pattern_fill_with_checksum";
+	size_t block_offset     = 0;
+	size_t block_size       = 0;
+	size_t checksum_offset  = 0;
+	uint64_t block_pattern  = 0;
+	uint32_t checksum_value = 1;
+	int is_filled           = 0;
+	int result              = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( pattern == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pattern.",
+		 function );
+
+		return( -1 );
+	}
+	if( checksum == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checksum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size > 8 )
+	 && ( ( data_size % 8 ) == 0 ) )
+	{
+		is_filled = 1;
+	}
+	while( block_offset < data_size )
+	{
+		block_size = data_size - block_offset;
+
+		if( block_size > LIBEWF_CHUNK_DATA_FUSED_BLOCK_SIZE )
+		{
+			block_size = LIBEWF_CHUNK_DATA_FUSED_BLOCK_SIZE;
+		}
+		if( is_filled != 0 )
+		{
+			/* The last 64-bit value of the previous block matches the pattern
+			 * and is used as the pattern of the block
+			 */
+			if( block_offset == 0 )
+			{
+				result = libewf_chunk_data_check_for_64_bit_pattern_fill(
+				          data,
+				          block_size,
+				          &block_pattern,
+				          error );
+			}
+			else
+			{
+				result = libewf_chunk_data_check_for_64_bit_pattern_fill(
+				          &( data[ block_offset - 8 ] ),
+				          block_size + 8,
+				          &block_pattern,
+				          error );
+			}
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if block at offset: %" PRIzd " contains a fill pattern.",
+				 function,
+				 block_offset );
+
+				return( -1 );
+			}
+			else if( result == 0 )
+			{
+				is_filled = 0;
+			}
+		}
+		if( is_filled == 0 )
+		{
+			if( libewf_checksum_calculate_adler32(
+			     &checksum_value,
+			     &( data[ checksum_offset ] ),
+			     block_offset + block_size - checksum_offset,
+			     checksum_value,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to calculate checksum.",
+				 function );
+
+				return( -1 );
+			}
+			checksum_offset = block_offset + block_size;
+		}
+		block_offset += block_size;
+	}
+	if( is_filled != 0 )
+	{
+		byte_stream_copy_to_uint64_little_endian(
+		 data,
+		 *pattern );
+
+		return( 1 );
+	}
+	*checksum = checksum_value;
+
+	return( 0 );
+}
+
+/* Fills a buffer with a 64-bit pattern
+ * The pattern is copied once and the filled part of the buffer is then copied
+ * onto the remainder, doubling the size of every copy
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_fill_with_64_bit_pattern(
+     uint8_t *data,
+     size_t data_size,
+     const uint8_t *pattern,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_fill_with_64_bit_pattern";
+	size_t copy_size      = 0;
+	size_t data_offset    = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( pattern == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pattern.",
+		 function );
+
+		return( -1 );
+	}
+	copy_size = 8;
+
+	while( data_offset < data_size )
+	{
+		if( copy_size > ( data_size - data_offset ) )
+		{
+			copy_size = data_size - data_offset;
+		}
+		if( memory_copy(
+		     &( data[ data_offset ] ),
+		     ( data_offset == 0 ) ? pattern : data,
+		     copy_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy pattern.",
+			 function );
+
+			return( -1 );
+		}
+		data_offset += copy_size;
+		copy_size    = data_offset;
+	}
+	return( 1 );
+}
+
+/* Checks if a buffer containing the chunk data is likely incompressible
+ * The check estimates the byte entropy of a number of evenly spaced samples
+ * by comparing the sum of the squared byte value counts with the sum
+ * expected for uniformly distributed byte values
+ * Returns 1 if the data is likely incompressible, 0 if not or -1 on error
  */
-int libewf_chunk_data_check_for_64_bit_pattern_fill(
+int libewf_chunk_data_check_for_incompressible_data(
      const uint8_t *data,
      size_t data_size,
-     uint64_t *pattern,
      libcerror_error_t **error )
 {
-	libewf_aligned_t *aligned_data_index = NULL;
-	libewf_aligned_t *aligned_data_start = NULL;
-	uint8_t *data_index                  = NULL;
-	uint8_t *data_start                  = NULL;
-	static char *function                = "libewf_chunk_data_check_for_64_bit_pattern_fill";
+	uint32_t byte_value_counts[ 256 ];
+
+	static char *function   = "libewf_chunk_data_check_for_incompressible_data";
+	size_t data_offset      = 0;
+	size_t number_of_bytes  = 0;
+	size_t sample_offset    = 0;
+	size_t sample_size      = 0;
+	size_t sample_stride    = 0;
+	uint64_t expected_sum   = 0;
+	uint64_t sum_of_squares = 0;
+	uint16_t byte_value     = 0;
+	int number_of_samples   = 0;
+	int sample_index        = 0;
 
 	if( data == NULL )
 	{
@@ -1495,85 +3117,71 @@ int libewf_chunk_data_check_for_64_bit_pattern_fill(
 
 		return( -1 );
 	}
-	if( pattern == NULL )
+	/* The estimate is not meaningful for small amounts of data
+	 */
+	if( data_size < 256 )
+	{
+		return( 0 );
+	}
+	if( memory_set(
+	     byte_value_counts,
+	     0,
+	     sizeof( uint32_t ) * 256 ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid pattern.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear byte value counts.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( data_size <= 8 )
-	 || ( data_size % 8 ) != 0 )
+	if( data_size <= (size_t) ( LIBEWF_ADAPTIVE_COMPRESSION_NUMBER_OF_SAMPLES * LIBEWF_ADAPTIVE_COMPRESSION_SAMPLE_SIZE ) )
 	{
-		return( 0 );
+		number_of_samples = 1;
+		sample_size       = data_size;
+		sample_stride     = data_size;
 	}
-	data_start = (uint8_t *) data;
-	data_index = (uint8_t *) data + 8;
-	data_size -= 8;
-
-	/* Only optimize for data larger than the alignment
-	 */
-	if( data_size > ( sizeof( libewf_aligned_t ) + sizeof( libewf_aligned_t ) ) )
+	else
 	{
-		/* Align the data start
-		 */
-		while( ( (intptr_t) data_start % sizeof( libewf_aligned_t ) ) != 0 )
-		{
-			if( *data_start != *data_index )
-			{
-				return( 0 );
-			}
-			data_start++;
-			data_index++;
-			data_size--;
-		}
-		/* Align the data index
-		 */
-		while( ( (intptr_t) data_index % sizeof( libewf_aligned_t ) ) != 0 )
-		{
-			if( *data_start != *data_index )
-			{
-				return( 0 );
-			}
-			data_index++;
-			data_size--;
-		}
-		aligned_data_start = (libewf_aligned_t *) data_start;
-		aligned_data_index = (libewf_aligned_t *) data_index;
-
-		while( data_size > sizeof( libewf_aligned_t ) )
-		{
-			if( *aligned_data_start != *aligned_data_index )
-			{
-				return( 0 );
-			}
-			aligned_data_start++;
-			aligned_data_index++;
-
-			data_size -= sizeof( libewf_aligned_t );
-		}
-		data_start = (uint8_t *) aligned_data_start;
-		data_index = (uint8_t *) aligned_data_index;
+		number_of_samples = LIBEWF_ADAPTIVE_COMPRESSION_NUMBER_OF_SAMPLES;
+		sample_size       = LIBEWF_ADAPTIVE_COMPRESSION_SAMPLE_SIZE;
+		sample_stride     = data_size / LIBEWF_ADAPTIVE_COMPRESSION_NUMBER_OF_SAMPLES;
 	}
-	while( data_size != 0 )
+	for( sample_index = 0;
+	     sample_index < number_of_samples;
+	     sample_index++ )
 	{
-		if( *data_start != *data_index )
+		for( data_offset = 0;
+		     data_offset < sample_size;
+		     data_offset++ )
 		{
-			return( 0 );
+			byte_value_counts[ data[ sample_offset + data_offset ] ] += 1;
 		}
-		data_start++;
-		data_index++;
-		data_size--;
+		sample_offset += sample_stride;
 	}
-	byte_stream_copy_to_uint64_little_endian(
-	 data,
-	 *pattern );
+	for( byte_value = 0;
+	     byte_value < 256;
+	     byte_value++ )
+	{
+		sum_of_squares += (uint64_t) byte_value_counts[ byte_value ] * byte_value_counts[ byte_value ];
+	}
+	number_of_bytes = sample_size * number_of_samples;
 
-	return( 1 );
+	/* For uniformly distributed byte values the expected sum of squares
+	 * is: n + n * ( n - 1 ) / 256
+	 */
+	expected_sum = (uint64_t) number_of_bytes + ( ( (uint64_t) number_of_bytes * ( number_of_bytes - 1 ) ) / 256 );
+
+	/* Consider the data incompressible if the sum of squares is within
+	 * 25 percent of the sum expected for uniformly distributed byte values
+	 */
+	if( ( sum_of_squares * 4 ) <= ( expected_sum * 5 ) )
+	{
+		return( 1 );
+	}
+	return( 0 );
 }
 
 /* Writes a chunk
@@ -1663,6 +3271,118 @@ ssize_t libewf_chunk_data_write(
 	return( total_write_count );
 }
 
+/* Copies the chunk data as it is written to the segment file into a buffer
+ * Returns the number of bytes copied or -1 on error
+ */
+ssize_t libewf_chunk_data_write_to_buffer(
+         libewf_chunk_data_t *chunk_data,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_write_to_buffer";
+	size_t write_size     = 0;
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk data - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	write_size = chunk_data->data_size + chunk_data->padding_size;
+
+	if( write_size > buffer_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid buffer size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     buffer,
+	     chunk_data->data,
+	     write_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) == 0 )
+	 && ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_HAS_CHECKSUM ) != 0 ) )
+	{
+		/* Check if the chunk and checksum buffers are aligned
+		 * if not the checksum needs to be copied separately
+		 */
+		if( ( chunk_data->chunk_io_flags & LIBEWF_CHUNK_IO_FLAG_CHECKSUM_SET ) != 0 )
+		{
+			if( ( buffer_size - write_size ) < 4 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+				 "%s: invalid buffer size value too small.",
+				 function );
+
+				return( -1 );
+			}
+			byte_stream_copy_from_uint32_little_endian(
+			 &( buffer[ write_size ] ),
+			 chunk_data->checksum );
+
+			write_size += 4;
+		}
+	}
+	return( (ssize_t) write_size );
+}
+
 /* Retrieves the write size of the chunk
  * Returns 1 if successful or -1 on error
  */
@@ -1765,8 +3485,9 @@ int libewf_chunk_data_get_checksum(
      uint32_t *checksum,
      libcerror_error_t **error )
 {
-	static char *function = "libewf_chunk_data_get_checksum";
-	int result            = 0;
+	static char *function   = "libewf_chunk_data_get_checksum";
+	size_t zlib_stream_size = 0;
+	int result              = 0;
 
 	if( chunk_data == NULL )
 	{
@@ -1805,8 +3526,28 @@ int libewf_chunk_data_get_checksum(
 		}
 		if( compression_method == LIBEWF_COMPRESSION_METHOD_DEFLATE )
 		{
+			zlib_stream_size = chunk_data->data_size;
+
+			if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_HAS_SUB_BLOCK_INDEX ) != 0 )
+			{
+				if( libewf_parallel_deflate_get_zlib_stream_size(
+				     chunk_data->data,
+				     chunk_data->data_size,
+				     &zlib_stream_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to determine zlib stream size.",
+					 function );
+
+					return( -1 );
+				}
+			}
 			byte_stream_copy_to_uint32_little_endian(
-			 &( ( chunk_data->data )[ chunk_data->data_size - 4 ] ),
+			 &( ( chunk_data->data )[ zlib_stream_size - 4 ] ),
 			 *checksum );
 
 			result = 1;
@@ -1928,6 +3669,11 @@ ssize_t libewf_chunk_data_read_from_file_io_pool(
 
 		return( -1 );
 	}
+	LIBEWF_TRACE_CHUNK_READ_START(
+	 file_io_pool_entry,
+	 chunk_data_offset,
+	 chunk_data_size );
+
 	read_count = libbfio_pool_read_buffer(
 		      file_io_pool,
 		      file_io_pool_entry,
@@ -1935,6 +3681,11 @@ ssize_t libewf_chunk_data_read_from_file_io_pool(
 		      (size_t) chunk_data_size,
 		      error );
 
+	LIBEWF_TRACE_CHUNK_READ_END(
+	 file_io_pool_entry,
+	 chunk_data_offset,
+	 read_count );
+
 	if( read_count != (ssize_t) chunk_data_size )
 	{
 		libcerror_error_set(
@@ -1972,7 +3723,10 @@ int libewf_chunk_data_read_element_data(
 {
 	libewf_chunk_data_t *chunk_data = NULL;
 	static char *function           = "libewf_chunk_data_read_element_data";
+	size_t data_size                = 0;
 	ssize_t read_count              = 0;
+	int64_t start_timestamp         = 0;
+	int result                      = 0;
 
 	LIBEWF_UNREFERENCED_PARAMETER( read_flags )
 
@@ -2009,8 +3763,9 @@ int libewf_chunk_data_read_element_data(
 
 		return( -1 );
 	}
-	if( libewf_chunk_data_initialize(
+	if( libewf_chunk_data_initialize_with_buffer_pool(
 	     &chunk_data,
+	     io_handle->buffer_pool,
 	     io_handle->chunk_size,
 	     0,
 	     error ) != 1 )
@@ -2035,25 +3790,150 @@ int libewf_chunk_data_read_element_data(
 		 file_io_pool_entry );
 	}
 #endif
-	read_count = libewf_chunk_data_read_from_file_io_pool(
-		      chunk_data,
-		      file_io_pool,
-		      file_io_pool_entry,
-	              chunk_data_offset,
-		      chunk_data_size,
-		      chunk_data_flags,
-		      error );
+	/* The chunk data is read when it is not in the chunks cache
+	 */
+	LIBEWF_TRACE_CHUNKS_CACHE_MISS(
+	 file_io_pool_entry,
+	 chunk_data_offset );
 
-	if( read_count < 0 )
+	if( io_handle->statistics != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read chunk data.",
-		 function );
+		if( libewf_statistics_add_cache_miss(
+		     io_handle->statistics,
+		     LIBEWF_STATISTICS_CACHE_TYPE_CHUNKS,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to add chunks cache miss to statistics.",
+			 function );
 
-		goto on_error;
+			goto on_error;
+		}
+	}
+	/* The unpacked chunk data is read from the disk chunk cache, if available,
+	 * instead of being read from the segment file and unpacked again
+	 */
+	if( io_handle->disk_chunk_cache != NULL )
+	{
+		result = libewf_disk_chunk_cache_read_chunk_data(
+		          io_handle->disk_chunk_cache,
+		          file_io_pool_entry,
+		          chunk_data_offset,
+		          chunk_data->data,
+		          chunk_data->allocated_data_size,
+		          &data_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk data from disk chunk cache.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			chunk_data->data_size   = data_size;
+			chunk_data->range_flags = chunk_data_flags
+			                        & ~( LIBEWF_RANGE_FLAG_IS_TAINTED | LIBEWF_RANGE_FLAG_IS_CORRUPTED );
+		}
+	}
+	/* The unpacked chunk data is read from the shared chunk cache, if available,
+	 * when another process on the same host already read and unpacked it
+	 */
+	if( ( result == 0 )
+	 && ( io_handle->shared_chunk_cache != NULL ) )
+	{
+		result = libewf_shared_chunk_cache_read_chunk_data(
+		          io_handle->shared_chunk_cache,
+		          file_io_pool_entry,
+		          chunk_data_offset,
+		          chunk_data->data,
+		          chunk_data->allocated_data_size,
+		          &data_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk data from shared chunk cache.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			chunk_data->data_size   = data_size;
+			chunk_data->range_flags = chunk_data_flags
+			                        & ~( LIBEWF_RANGE_FLAG_IS_TAINTED | LIBEWF_RANGE_FLAG_IS_CORRUPTED );
+		}
+	}
+	if( result == 0 )
+	{
+		if( io_handle->statistics != NULL )
+		{
+			if( libewf_statistics_get_timestamp(
+			     &start_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve start timestamp.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		read_count = libewf_chunk_data_read_from_file_io_pool(
+			      chunk_data,
+			      file_io_pool,
+			      file_io_pool_entry,
+		              chunk_data_offset,
+			      chunk_data_size,
+			      chunk_data_flags,
+			      error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk data.",
+			 function );
+
+			goto on_error;
+		}
+		if( io_handle->statistics != NULL )
+		{
+			if( libewf_statistics_add_segment_file_read(
+			     io_handle->statistics,
+			     (size_t) read_count,
+			     start_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to add segment file read to statistics.",
+				 function );
+
+				goto on_error;
+			}
+		}
 	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
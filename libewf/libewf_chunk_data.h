@@ -25,6 +25,8 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_buffer_pool.h"
+#include "libewf_compression_context.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
@@ -85,23 +87,74 @@ struct libewf_chunk_data
 	/* The chunk IO flags
 	 */
 	int8_t chunk_io_flags;
+
+	/* The unpack status, a chunk that fails to unpack records its status
+	 * instead of an error, the error is generated on request
+	 */
+	uint8_t unpack_status;
+
+	/* The calculated checksum if the checksum does not match
+	 */
+	uint32_t calculated_checksum;
+
+	/* The buffer pool the data was retrieved from
+	 */
+	libewf_buffer_pool_t *buffer_pool;
+
+#if defined( HAVE_LIBEWF_MEMORY_ACCOUNTING )
+	/* The size of the memory accounted for the chunk data
+	 */
+	size_t accounted_memory_size;
+#endif
 };
 
+/* The size of the blocks the chunk data is checked for a fill pattern
+ * and checksummed in, which should fit in the first level data cache
+ */
+#define LIBEWF_CHUNK_DATA_FUSED_BLOCK_SIZE	4096
+
+/* The size of the memory of chunk data including its data buffers
+ */
+#define LIBEWF_CHUNK_DATA_MEMORY_SIZE( chunk_data ) \
+	( sizeof( libewf_chunk_data_t ) \
+	 + ( ( ( chunk_data )->data != NULL ) ? ( chunk_data )->allocated_data_size : 0 ) \
+	 + ( ( ( chunk_data )->compressed_data != NULL ) ? ( chunk_data )->compressed_data_size : 0 ) )
+
 int libewf_chunk_data_initialize(
      libewf_chunk_data_t **chunk_data,
      size32_t chunk_size,
      uint8_t clear_data,
      libcerror_error_t **error );
 
+int libewf_chunk_data_initialize_with_buffer_pool(
+     libewf_chunk_data_t **chunk_data,
+     libewf_buffer_pool_t *buffer_pool,
+     size32_t chunk_size,
+     uint8_t clear_data,
+     libcerror_error_t **error );
+
 int libewf_chunk_data_free(
      libewf_chunk_data_t **chunk_data,
      libcerror_error_t **error );
 
+int libewf_chunk_data_free_buffer(
+     libewf_chunk_data_t *chunk_data,
+     uint8_t **buffer,
+     uint8_t is_pooled,
+     libcerror_error_t **error );
+
 int libewf_chunk_data_clone(
      libewf_chunk_data_t **destination_chunk_data,
      libewf_chunk_data_t *source_chunk_data,
      libcerror_error_t **error );
 
+int libewf_chunk_data_clone_packed(
+     libewf_chunk_data_t **destination_chunk_data,
+     libewf_chunk_data_t *source_chunk_data,
+     uint16_t compression_method,
+     uint8_t pack_flags,
+     libcerror_error_t **error );
+
 ssize_t libewf_chunk_data_read_buffer(
          libewf_chunk_data_t *chunk_data,
          uint8_t *buffer,
@@ -117,16 +170,51 @@ ssize_t libewf_chunk_data_write_buffer(
 int libewf_chunk_data_pack(
      libewf_chunk_data_t *chunk_data,
      libewf_io_handle_t *io_handle,
+     libewf_compression_context_t *compression_context,
      const uint8_t *compressed_zero_byte_empty_block,
      size_t compressed_zero_byte_empty_block_size,
      uint8_t pack_flags,
      libcerror_error_t **error );
 
 int libewf_chunk_data_unpack(
+     libewf_chunk_data_t *chunk_data,
+     libewf_io_handle_t *io_handle,
+     libewf_compression_context_t *compression_context,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_unpack_compressed(
+     libewf_chunk_data_t *chunk_data,
+     libewf_io_handle_t *io_handle,
+     libewf_compression_context_t *compression_context,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_allocate_decompressed_data(
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_free_decompressed_data(
+     libewf_chunk_data_t *chunk_data,
+     size_t packed_allocated_data_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_unpack_with_checksum(
      libewf_chunk_data_t *chunk_data,
      libewf_io_handle_t *io_handle,
      libcerror_error_t **error );
 
+int libewf_chunk_data_get_unpack_error(
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_unpack_to_buffer(
+     libewf_chunk_data_t *chunk_data,
+     libewf_io_handle_t *io_handle,
+     libewf_compression_context_t *compression_context,
+     uint8_t *buffer,
+     size_t buffer_size,
+     size_t *data_size,
+     libcerror_error_t **error );
+
 int libewf_chunk_data_check_for_empty_block(
      const uint8_t *data,
      size_t data_size,
@@ -138,12 +226,36 @@ int libewf_chunk_data_check_for_64_bit_pattern_fill(
      uint64_t *pattern,
      libcerror_error_t **error );
 
+int libewf_chunk_data_check_for_64_bit_pattern_fill_with_checksum(
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t *pattern,
+     uint32_t *checksum,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_fill_with_64_bit_pattern(
+     uint8_t *data,
+     size_t data_size,
+     const uint8_t *pattern,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_check_for_incompressible_data(
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
 ssize_t libewf_chunk_data_write(
          libewf_chunk_data_t *chunk_data,
          libbfio_pool_t *file_io_pool,
          int file_io_pool_entry,
          libcerror_error_t **error );
 
+ssize_t libewf_chunk_data_write_to_buffer(
+         libewf_chunk_data_t *chunk_data,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
 int libewf_chunk_data_get_write_size(
      libewf_chunk_data_t *chunk_data,
      uint32_t *write_size,
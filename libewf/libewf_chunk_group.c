@@ -32,6 +32,7 @@
 #include "libewf_libcnotify.h"
 #include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
+#include "libewf_memory_accounting.h"
 #include "libewf_section.h"
 #include "libewf_section_descriptor.h"
 
@@ -133,6 +134,11 @@ int libewf_chunk_group_initialize(
 
 		goto on_error;
 	}
+	LIBEWF_MEMORY_ACCOUNTING_UPDATE(
+	 LIBEWF_MEMORY_TYPE_CHUNK_GROUP,
+	 *chunk_group,
+	 sizeof( libewf_chunk_group_t ) );
+
 	return( 1 );
 
 on_error:
@@ -182,6 +188,11 @@ int libewf_chunk_group_free(
 
 			result = -1;
 		}
+		LIBEWF_MEMORY_ACCOUNTING_UPDATE(
+		 LIBEWF_MEMORY_TYPE_CHUNK_GROUP,
+		 *chunk_group,
+		 0 );
+
 		memory_free(
 		 *chunk_group );
 
@@ -261,9 +272,41 @@ int libewf_chunk_group_clone(
 
 		return( -1 );
 	}
-/* TODO clone chunks_list */
 	( *destination_chunk_group )->chunks_list = NULL;
 
+#if defined( HAVE_LIBEWF_MEMORY_ACCOUNTING )
+	( *destination_chunk_group )->accounted_memory_size = 0;
+#endif
+
+	if( libfdata_list_clone(
+	     &( ( *destination_chunk_group )->chunks_list ),
+	     source_chunk_group->chunks_list,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination chunks list.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MEMORY_ACCOUNTING )
+	if( libewf_chunk_group_update_memory_accounting(
+	     *destination_chunk_group,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update memory accounting.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	return( 1 );
 
 on_error:
@@ -310,6 +353,11 @@ int libewf_chunk_group_empty(
 
 		return( -1 );
 	}
+	LIBEWF_MEMORY_ACCOUNTING_UPDATE(
+	 LIBEWF_MEMORY_TYPE_CHUNK_GROUP,
+	 chunk_group,
+	 sizeof( libewf_chunk_group_t ) );
+
 	return( 1 );
 }
 
@@ -801,6 +849,21 @@ int libewf_chunk_group_fill_v1(
 		libcnotify_printf(
 		 "\n" );
 	}
+#endif
+#if defined( HAVE_LIBEWF_MEMORY_ACCOUNTING )
+	if( libewf_chunk_group_update_memory_accounting(
+	     chunk_group,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update memory accounting.",
+		 function );
+
+		return( -1 );
+	}
 #endif
 	return( 1 );
 }
@@ -941,6 +1004,10 @@ int libewf_chunk_group_fill_v2(
 			{
 				range_flags |= LIBEWF_RANGE_FLAG_USES_PATTERN_FILL;
 			}
+			else if( ( chunk_data_flags & LIBEWF_CHUNK_DATA_FLAG_HAS_SUB_BLOCK_INDEX ) != 0 )
+			{
+				range_flags |= LIBEWF_RANGE_FLAG_HAS_SUB_BLOCK_INDEX;
+			}
 		}
 		if( ( chunk_data_flags & LIBEWF_CHUNK_DATA_FLAG_HAS_CHECKSUM ) != 0 )
 		{
@@ -970,6 +1037,14 @@ int libewf_chunk_group_fill_v2(
 		{
 			range_flags |= LIBEWF_RANGE_FLAG_IS_TAINTED;
 		}
+		/* The chunk data is encrypted if the sector table is encrypted,
+		 * except for the pattern fill that is stored in the table entry
+		 */
+		if( ( ( table_section->data_flags & LIBEWF_SECTION_DATA_FLAGS_IS_ENCRYPTED ) != 0 )
+		 && ( ( range_flags & LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) == 0 ) )
+		{
+			range_flags |= LIBEWF_RANGE_FLAG_IS_ENCRYPTED;
+		}
 		if( ( range_flags & LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) != 0 )
 		{
 			chunk_data_offset = table_entry_offset;
@@ -1008,6 +1083,21 @@ int libewf_chunk_group_fill_v2(
 		}
 #endif
 	}
+#if defined( HAVE_LIBEWF_MEMORY_ACCOUNTING )
+	if( libewf_chunk_group_update_memory_accounting(
+	     chunk_group,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update memory accounting.",
+		 function );
+
+		return( -1 );
+	}
+#endif
 	return( 1 );
 }
 
@@ -1824,6 +1914,10 @@ int libewf_chunk_group_generate_table_entries_data(
 			{
 				chunk_data_flags |= LIBEWF_CHUNK_DATA_FLAG_USES_PATTERN_FILL;
 			}
+			if( ( range_flags & LIBEWF_RANGE_FLAG_HAS_SUB_BLOCK_INDEX ) != 0 )
+			{
+				chunk_data_flags |= LIBEWF_CHUNK_DATA_FLAG_HAS_SUB_BLOCK_INDEX;
+			}
 			byte_stream_copy_from_uint64_little_endian(
 			 ( (ewf_table_entry_v2_t *) table_entries_data )->chunk_data_offset,
 			 chunk_data_offset );
@@ -1889,3 +1983,51 @@ int libewf_chunk_group_generate_table_entries_data(
 	return( 1 );
 }
 
+#if defined( HAVE_LIBEWF_MEMORY_ACCOUNTING )
+
+/* Updates the size of the memory accounted for the chunk group
+ * The size of the elements of the chunks list is estimated
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_update_memory_accounting(
+     libewf_chunk_group_t *chunk_group,
+     libcerror_error_t **error )
+{
+	static char *function  = "libewf_chunk_group_update_memory_accounting";
+	int number_of_elements = 0;
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_get_number_of_elements(
+	     chunk_group->chunks_list,
+	     &number_of_elements,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of elements from chunks list.",
+		 function );
+
+		return( -1 );
+	}
+	LIBEWF_MEMORY_ACCOUNTING_UPDATE(
+	 LIBEWF_MEMORY_TYPE_CHUNK_GROUP,
+	 chunk_group,
+	 sizeof( libewf_chunk_group_t ) + ( (size_t) number_of_elements * LIBEWF_MEMORY_ACCOUNTING_LIST_ELEMENT_SIZE ) );
+
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MEMORY_ACCOUNTING ) */
+
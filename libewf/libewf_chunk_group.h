@@ -41,6 +41,12 @@ struct libewf_chunk_group
 	/* The chunks list
 	 */
 	libfdata_list_t *chunks_list;
+
+#if defined( HAVE_LIBEWF_MEMORY_ACCOUNTING )
+	/* The size of the memory accounted for the chunk group
+	 */
+	size_t accounted_memory_size;
+#endif
 };
 
 int libewf_chunk_group_initialize(
@@ -61,6 +67,14 @@ int libewf_chunk_group_empty(
      libewf_chunk_group_t *chunk_group,
      libcerror_error_t **error );
 
+#if defined( HAVE_LIBEWF_MEMORY_ACCOUNTING )
+
+int libewf_chunk_group_update_memory_accounting(
+     libewf_chunk_group_t *chunk_group,
+     libcerror_error_t **error );
+
+#endif
+
 int libewf_chunk_group_fill_v1(
      libewf_chunk_group_t *chunk_group,
      uint64_t chunk_index,
@@ -0,0 +1,1244 @@
+/*
+ * Chunk group scanner functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_group.h"
+#include "libewf_chunk_group_scanner.h"
+#include "libewf_chunk_table.h"
+#include "libewf_definitions.h"
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+#include "libewf_libfdata.h"
+#include "libewf_segment_file.h"
+
+/* Creates a chunk group scanner
+ * Make sure the value chunk_group_scanner is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_scanner_initialize(
+     libewf_chunk_group_scanner_t **chunk_group_scanner,
+     libewf_io_handle_t *io_handle,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_group_scanner_initialize";
+	size_t entries_size   = 0;
+
+	if( chunk_group_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_group_scanner != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk group scanner value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > LIBEWF_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*chunk_group_scanner = memory_allocate_structure(
+	                    libewf_chunk_group_scanner_t );
+
+	if( *chunk_group_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk group scanner.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *chunk_group_scanner,
+	     0,
+	     sizeof( libewf_chunk_group_scanner_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk group scanner.",
+		 function );
+
+		memory_free(
+		 *chunk_group_scanner );
+
+		*chunk_group_scanner = NULL;
+
+		return( -1 );
+	}
+	( *chunk_group_scanner )->io_handle                 = io_handle;
+	( *chunk_group_scanner )->number_of_threads         = number_of_threads;
+	( *chunk_group_scanner )->maximum_number_of_entries = number_of_threads * LIBEWF_CHUNK_GROUP_SCANNER_NUMBER_OF_SEGMENTS_PER_THREAD;
+
+	entries_size = sizeof( libewf_chunk_group_scanner_entry_t ) * ( *chunk_group_scanner )->maximum_number_of_entries;
+
+	( *chunk_group_scanner )->entries = (libewf_chunk_group_scanner_entry_t *) memory_allocate(
+	                                                                    entries_size );
+
+	if( ( *chunk_group_scanner )->entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *chunk_group_scanner )->entries,
+	     0,
+	     entries_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entries.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *chunk_group_scanner )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *chunk_group_scanner )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_thread_pool_create(
+	     &( ( *chunk_group_scanner )->thread_pool ),
+	     NULL,
+	     number_of_threads,
+	     ( *chunk_group_scanner )->maximum_number_of_entries,
+	     (int (*)(intptr_t *, void *)) &libewf_chunk_group_scanner_scan_callback,
+	     (void *) *chunk_group_scanner,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread pool.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *chunk_group_scanner != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *chunk_group_scanner )->condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *chunk_group_scanner )->condition ),
+			 NULL );
+		}
+		if( ( *chunk_group_scanner )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *chunk_group_scanner )->mutex ),
+			 NULL );
+		}
+#endif
+		if( ( *chunk_group_scanner )->entries != NULL )
+		{
+			memory_free(
+			 ( *chunk_group_scanner )->entries );
+		}
+		memory_free(
+		 *chunk_group_scanner );
+
+		*chunk_group_scanner = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a chunk group scanner
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_scanner_free(
+     libewf_chunk_group_scanner_t **chunk_group_scanner,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_group_scanner_free";
+	int result            = 1;
+
+	if( chunk_group_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_group_scanner != NULL )
+	{
+		/* The io_handle reference is freed elsewhere
+		 */
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *chunk_group_scanner )->thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *chunk_group_scanner )->thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_condition_free(
+		     &( ( *chunk_group_scanner )->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *chunk_group_scanner )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		if( libewf_chunk_group_scanner_clear_entries(
+		     *chunk_group_scanner,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to clear entries.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 ( *chunk_group_scanner )->entries );
+
+		memory_free(
+		 *chunk_group_scanner );
+
+		*chunk_group_scanner = NULL;
+	}
+	return( result );
+}
+
+/* Clears the entries of the current batch
+ * Frees the chunk groups that have not been indexed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_scanner_clear_entries(
+     libewf_chunk_group_scanner_t *chunk_group_scanner,
+     libcerror_error_t **error )
+{
+	libewf_chunk_group_scanner_entry_t *entry = NULL;
+	static char *function                     = "libewf_chunk_group_scanner_clear_entries";
+	int entry_index                           = 0;
+	int group_index                           = 0;
+	int result                                = 1;
+
+	if( chunk_group_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group scanner.",
+		 function );
+
+		return( -1 );
+	}
+	for( entry_index = 0;
+	     entry_index < chunk_group_scanner->number_of_entries;
+	     entry_index++ )
+	{
+		entry = &( chunk_group_scanner->entries[ entry_index ] );
+
+		if( entry->file_io_handle != NULL )
+		{
+			if( libbfio_handle_free(
+			     &( entry->file_io_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free entry: %d file IO handle.",
+				 function,
+				 entry_index );
+
+				result = -1;
+			}
+		}
+		if( entry->groups != NULL )
+		{
+			for( group_index = 0;
+			     group_index < entry->number_of_groups;
+			     group_index++ )
+			{
+				if( entry->groups[ group_index ].chunk_group != NULL )
+				{
+					if( libewf_chunk_group_free(
+					     &( entry->groups[ group_index ].chunk_group ),
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to free entry: %d chunk group: %d.",
+						 function,
+						 entry_index,
+						 group_index );
+
+						result = -1;
+					}
+				}
+			}
+			memory_free(
+			 entry->groups );
+
+			entry->groups = NULL;
+		}
+		entry->number_of_groups = 0;
+	}
+	chunk_group_scanner->number_of_entries = 0;
+
+	return( result );
+}
+
+/* Appends the chunk groups of a segment file to the current batch
+ * The file IO pool is not thread-safe hence the file IO handle of the segment file
+ * is cloned on the calling thread
+ * Segment files with recovered chunk groups or without chunk groups are skipped
+ * Returns 1 if successful, 0 if the current batch is full or -1 on error
+ */
+int libewf_chunk_group_scanner_append_segment_file(
+     libewf_chunk_group_scanner_t *chunk_group_scanner,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_file_t *segment_file,
+     uint32_t segment_number,
+     int file_io_pool_entry,
+     uint64_t first_chunk_index,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle          = NULL;
+	libewf_chunk_group_scanner_entry_t *entry = NULL;
+	libewf_chunk_group_scanner_group_t *group = NULL;
+	static char *function                     = "libewf_chunk_group_scanner_append_segment_file";
+	size_t groups_size                        = 0;
+	size64_t mapped_size                      = 0;
+	uint64_t chunk_index                      = 0;
+	uint32_t range_flags                      = 0;
+	int group_file_io_pool_entry              = 0;
+	int group_index                           = 0;
+	int number_of_groups                      = 0;
+
+	if( chunk_group_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group_scanner->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk group scanner - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group_scanner->io_handle->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk group scanner - invalid IO handle - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group_scanner->number_of_entries >= chunk_group_scanner->maximum_number_of_entries )
+	{
+		return( 0 );
+	}
+	/* The chunk groups of a segment file with recovered chunk groups
+	 * are not read from the table sections
+	 */
+	if( segment_file->recovered_chunk_groups != NULL )
+	{
+		return( 1 );
+	}
+	if( libfdata_list_get_number_of_elements(
+	     segment_file->chunk_groups_list,
+	     &number_of_groups,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of chunk groups.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_groups <= 0 )
+	{
+		return( 1 );
+	}
+	entry = &( chunk_group_scanner->entries[ chunk_group_scanner->number_of_entries ] );
+
+	groups_size = sizeof( libewf_chunk_group_scanner_group_t ) * number_of_groups;
+
+	if( groups_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid groups size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	entry->segment_number     = segment_number;
+	entry->file_io_pool_entry = file_io_pool_entry;
+	entry->segment_file_type  = segment_file->type;
+	entry->major_version      = segment_file->major_version;
+	entry->file_io_handle     = NULL;
+	entry->number_of_groups   = 0;
+
+	entry->groups = (libewf_chunk_group_scanner_group_t *) memory_allocate(
+	                                                        groups_size );
+
+	if( entry->groups == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create groups.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     entry->groups,
+	     0,
+	     groups_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear groups.",
+		 function );
+
+		memory_free(
+		 entry->groups );
+
+		entry->groups = NULL;
+
+		return( -1 );
+	}
+	/* The entry is cleared by libewf_chunk_group_scanner_clear_entries on error
+	 */
+	chunk_group_scanner->number_of_entries += 1;
+
+	chunk_index = first_chunk_index;
+
+	for( group_index = 0;
+	     group_index < number_of_groups;
+	     group_index++ )
+	{
+		group = &( entry->groups[ group_index ] );
+
+		if( libfdata_list_get_element_by_index(
+		     segment_file->chunk_groups_list,
+		     group_index,
+		     &group_file_io_pool_entry,
+		     &( group->data_offset ),
+		     &( group->data_size ),
+		     &range_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk group: %d.",
+			 function,
+			 group_index );
+
+			goto on_error;
+		}
+		if( libfdata_list_get_mapped_size_by_index(
+		     segment_file->chunk_groups_list,
+		     group_index,
+		     &mapped_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve mapped size of chunk group: %d.",
+			 function,
+			 group_index );
+
+			goto on_error;
+		}
+		group->first_chunk_index = chunk_index;
+
+		chunk_index += mapped_size / chunk_group_scanner->io_handle->chunk_size;
+
+		entry->number_of_groups += 1;
+	}
+	if( libbfio_pool_get_handle(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file IO handle: %d from pool.",
+		 function,
+		 file_io_pool_entry );
+
+		goto on_error;
+	}
+	if( libbfio_handle_clone(
+	     &( entry->file_io_handle ),
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle: %d.",
+		 function,
+		 file_io_pool_entry );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	libewf_chunk_group_scanner_clear_entries(
+	 chunk_group_scanner,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Reads the chunk groups of the segment file of an entry
+ * The chunk groups are read using the file IO handle of the entry
+ * so they can be read in parallel with other entries
+ * Chunk groups that could not be read have no chunk group set
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_scanner_read_entry(
+     libewf_chunk_group_scanner_t *chunk_group_scanner,
+     libewf_chunk_group_scanner_entry_t *entry,
+     libcerror_error_t **error )
+{
+	libbfio_pool_t *file_io_pool              = NULL;
+	libewf_chunk_group_scanner_group_t *group = NULL;
+	libewf_segment_file_t *segment_file       = NULL;
+	static char *function                     = "libewf_chunk_group_scanner_read_entry";
+	int group_index                           = 0;
+
+	if( chunk_group_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid entry - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry->file_io_pool_entry < 0 )
+	 || ( entry->file_io_pool_entry == INT_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry - file IO pool entry value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* The chunk group ranges refer to the file IO pool entry
+	 * hence the private file IO pool uses the same entry
+	 */
+	if( libbfio_pool_initialize(
+	     &file_io_pool,
+	     entry->file_io_pool_entry + 1,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_set_handle(
+	     file_io_pool,
+	     entry->file_io_pool_entry,
+	     entry->file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set file IO handle: %d in pool.",
+		 function,
+		 entry->file_io_pool_entry );
+
+		goto on_error;
+	}
+	/* The file IO handle is now managed by the file IO pool
+	 */
+	entry->file_io_handle = NULL;
+
+	/* The segment file only provides the format and the table buffer
+	 * to read the chunk groups
+	 */
+	if( libewf_segment_file_initialize(
+	     &segment_file,
+	     chunk_group_scanner->io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment file.",
+		 function );
+
+		goto on_error;
+	}
+	segment_file->type          = entry->segment_file_type;
+	segment_file->major_version = entry->major_version;
+
+	for( group_index = 0;
+	     group_index < entry->number_of_groups;
+	     group_index++ )
+	{
+		group = &( entry->groups[ group_index ] );
+
+		if( libewf_segment_file_read_chunk_group(
+		     segment_file,
+		     file_io_pool,
+		     entry->file_io_pool_entry,
+		     group->data_offset,
+		     group->data_size,
+		     &( group->chunk_group ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read segment file: %" PRIu32 " chunk group: %d.",
+			 function,
+			 entry->segment_number,
+			 group_index );
+
+			goto on_error;
+		}
+	}
+	if( libewf_segment_file_free(
+	     &segment_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free segment file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_close_all(
+	     file_io_pool,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_free(
+	     &file_io_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( segment_file != NULL )
+	{
+		libewf_segment_file_free(
+		 &segment_file,
+		 NULL );
+	}
+	if( file_io_pool != NULL )
+	{
+		libbfio_pool_close_all(
+		 file_io_pool,
+		 NULL );
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Reads the chunk groups of a segment file
+ * Callback function for the thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_scanner_scan_callback(
+     libewf_chunk_group_scanner_entry_t *entry,
+     libewf_chunk_group_scanner_t *chunk_group_scanner )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "libewf_chunk_group_scanner_scan_callback";
+
+	if( chunk_group_scanner == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group scanner.",
+		 function );
+
+		goto on_error;
+	}
+	/* A chunk group that could not be read is read again
+	 * on first access to report the error
+	 */
+	if( libewf_chunk_group_scanner_read_entry(
+	     chunk_group_scanner,
+	     entry,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read entry.",
+		 function );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( libcthreads_mutex_grab(
+	     chunk_group_scanner->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	chunk_group_scanner->number_of_pending_entries -= 1;
+
+	if( chunk_group_scanner->number_of_pending_entries == 0 )
+	{
+		if( libcthreads_condition_broadcast(
+		     chunk_group_scanner->condition,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 chunk_group_scanner->mutex,
+			 NULL );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     chunk_group_scanner->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+	}
+#endif
+	libcerror_error_free(
+	 &error );
+
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* Reads the chunk groups of the segment files of the current batch
+ * Chunk groups that could not be read have no chunk group set
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_scanner_scan(
+     libewf_chunk_group_scanner_t *chunk_group_scanner,
+     libcerror_error_t **error )
+{
+	libewf_chunk_group_scanner_entry_t *entry = NULL;
+	static char *function                     = "libewf_chunk_group_scanner_scan";
+	int entry_index                           = 0;
+	int number_of_entries                     = 0;
+	int result                                = 1;
+
+	if( chunk_group_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group scanner.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_entries = chunk_group_scanner->number_of_entries;
+
+	if( number_of_entries == 0 )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_group_scanner->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_group_scanner->number_of_pending_entries = number_of_entries;
+
+	if( libcthreads_mutex_release(
+	     chunk_group_scanner->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		entry = &( chunk_group_scanner->entries[ entry_index ] );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_thread_pool_push(
+		     chunk_group_scanner->thread_pool,
+		     (intptr_t *) entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push entry: %d onto thread pool queue.",
+			 function,
+			 entry_index );
+
+			/* Do not wait for the entries that were not pushed
+			 */
+			libcthreads_mutex_grab(
+			 chunk_group_scanner->mutex,
+			 NULL );
+
+			chunk_group_scanner->number_of_pending_entries -= number_of_entries - entry_index;
+
+			libcthreads_mutex_release(
+			 chunk_group_scanner->mutex,
+			 NULL );
+
+			result = -1;
+
+			break;
+		}
+#else
+		if( libewf_chunk_group_scanner_read_entry(
+		     chunk_group_scanner,
+		     entry,
+		     error ) != 1 )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( ( libcnotify_verbose != 0 )
+			 && ( error != NULL )
+			 && ( *error != NULL ) )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+#endif
+			libcerror_error_free(
+			 error );
+		}
+#endif
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* Wait for the worker threads to read the batch
+	 */
+	if( libcthreads_mutex_grab(
+	     chunk_group_scanner->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( chunk_group_scanner->number_of_pending_entries > 0 )
+	{
+		if( libcthreads_condition_wait(
+		     chunk_group_scanner->condition,
+		     chunk_group_scanner->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     chunk_group_scanner->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Adds the chunk groups of the current batch to the chunks index of the chunk table
+ * The entries of the current batch are cleared afterwards
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_scanner_index(
+     libewf_chunk_group_scanner_t *chunk_group_scanner,
+     libewf_chunk_table_t *chunk_table,
+     libcerror_error_t **error )
+{
+	libewf_chunk_group_scanner_entry_t *entry = NULL;
+	libewf_chunk_group_scanner_group_t *group = NULL;
+	static char *function                     = "libewf_chunk_group_scanner_index";
+	int entry_index                           = 0;
+	int group_index                           = 0;
+
+	if( chunk_group_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group scanner.",
+		 function );
+
+		return( -1 );
+	}
+	for( entry_index = 0;
+	     entry_index < chunk_group_scanner->number_of_entries;
+	     entry_index++ )
+	{
+		entry = &( chunk_group_scanner->entries[ entry_index ] );
+
+		for( group_index = 0;
+		     group_index < entry->number_of_groups;
+		     group_index++ )
+		{
+			group = &( entry->groups[ group_index ] );
+
+			if( group->chunk_group == NULL )
+			{
+				continue;
+			}
+			if( libewf_chunk_table_index_chunk_group(
+			     chunk_table,
+			     group->first_chunk_index,
+			     entry->segment_number,
+			     group->chunk_group,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to index chunk group: %d of segment file: %" PRIu32 ".",
+				 function,
+				 group_index,
+				 entry->segment_number );
+
+				goto on_error;
+			}
+		}
+	}
+	if( libewf_chunk_group_scanner_clear_entries(
+	     chunk_group_scanner,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear entries.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	libewf_chunk_group_scanner_clear_entries(
+	 chunk_group_scanner,
+	 NULL );
+
+	return( -1 );
+}
+
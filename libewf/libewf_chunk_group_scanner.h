@@ -0,0 +1,195 @@
+/*
+ * Chunk group scanner functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_CHUNK_GROUP_SCANNER_H )
+#define _LIBEWF_CHUNK_GROUP_SCANNER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_group.h"
+#include "libewf_chunk_table.h"
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_segment_file.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_chunk_group_scanner_group libewf_chunk_group_scanner_group_t;
+
+/* A chunk group that is read by the chunk group scanner
+ */
+struct libewf_chunk_group_scanner_group
+{
+	/* The index of the first chunk
+	 */
+	uint64_t first_chunk_index;
+
+	/* The offset of the chunk group data in the segment file
+	 */
+	off64_t data_offset;
+
+	/* The size of the chunk group data
+	 */
+	size64_t data_size;
+
+	/* The read chunk group
+	 */
+	libewf_chunk_group_t *chunk_group;
+};
+
+typedef struct libewf_chunk_group_scanner_entry libewf_chunk_group_scanner_entry_t;
+
+/* A segment file of which the chunk groups are read by the chunk group scanner
+ */
+struct libewf_chunk_group_scanner_entry
+{
+	/* The segment number
+	 */
+	uint32_t segment_number;
+
+	/* The file IO pool entry
+	 */
+	int file_io_pool_entry;
+
+	/* The segment file type
+	 */
+	uint8_t segment_file_type;
+
+	/* The major version
+	 */
+	uint8_t major_version;
+
+	/* The file IO handle used to read the chunk groups
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The chunk groups
+	 */
+	libewf_chunk_group_scanner_group_t *groups;
+
+	/* The number of chunk groups
+	 */
+	int number_of_groups;
+};
+
+typedef struct libewf_chunk_group_scanner libewf_chunk_group_scanner_t;
+
+/* The chunk group scanner reads and validates the table sections of batches
+ * of segment files using a pool of worker threads, so that the chunk groups
+ * can be added to the chunks index without reading them on first access
+ */
+struct libewf_chunk_group_scanner
+{
+	/* The IO handle
+	 */
+	libewf_io_handle_t *io_handle;
+
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+	/* The entries of the current batch
+	 */
+	libewf_chunk_group_scanner_entry_t *entries;
+
+	/* The maximum number of entries per batch
+	 */
+	int maximum_number_of_entries;
+
+	/* The number of entries of the current batch
+	 */
+	int number_of_entries;
+
+	/* The number of entries of the current batch that still need to be scanned
+	 */
+	int number_of_pending_entries;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when the current batch was scanned
+	 */
+	libcthreads_condition_t *condition;
+#endif
+};
+
+int libewf_chunk_group_scanner_initialize(
+     libewf_chunk_group_scanner_t **chunk_group_scanner,
+     libewf_io_handle_t *io_handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_scanner_free(
+     libewf_chunk_group_scanner_t **chunk_group_scanner,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_scanner_clear_entries(
+     libewf_chunk_group_scanner_t *chunk_group_scanner,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_scanner_append_segment_file(
+     libewf_chunk_group_scanner_t *chunk_group_scanner,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_file_t *segment_file,
+     uint32_t segment_number,
+     int file_io_pool_entry,
+     uint64_t first_chunk_index,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_scanner_read_entry(
+     libewf_chunk_group_scanner_t *chunk_group_scanner,
+     libewf_chunk_group_scanner_entry_t *entry,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+int libewf_chunk_group_scanner_scan_callback(
+     libewf_chunk_group_scanner_entry_t *entry,
+     libewf_chunk_group_scanner_t *chunk_group_scanner );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+int libewf_chunk_group_scanner_scan(
+     libewf_chunk_group_scanner_t *chunk_group_scanner,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_scanner_index(
+     libewf_chunk_group_scanner_t *chunk_group_scanner,
+     libewf_chunk_table_t *chunk_table,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_CHUNK_GROUP_SCANNER_H ) */
+
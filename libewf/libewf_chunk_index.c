@@ -0,0 +1,929 @@
+/*
+ * Chunk index functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_group.h"
+#include "libewf_chunk_index.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_libfdata.h"
+
+/* The range flags that can be packed, where the index of the flag in the array
+ * corresponds to the bit in the packed range flags
+ */
+static const uint32_t libewf_chunk_index_packed_range_flags[ 8 ] = {
+	LIBEWF_RANGE_FLAG_IS_SPARSE,
+	LIBEWF_RANGE_FLAG_IS_COMPRESSED,
+	LIBEWF_RANGE_FLAG_HAS_CHECKSUM,
+	LIBEWF_RANGE_FLAG_USES_PATTERN_FILL,
+	LIBEWF_RANGE_FLAG_IS_PACKED,
+	LIBEWF_RANGE_FLAG_IS_TAINTED,
+	LIBEWF_RANGE_FLAG_IS_CORRUPTED,
+	LIBEWF_RANGE_FLAG_IS_ENCRYPTED };
+
+/* Creates a chunk index
+ * Make sure the value chunk_index is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_index_initialize(
+     libewf_chunk_index_t **chunk_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_index_initialize";
+
+	if( chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk index value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*chunk_index = memory_allocate_structure(
+	                libewf_chunk_index_t );
+
+	if( *chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk index.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *chunk_index,
+	     0,
+	     sizeof( libewf_chunk_index_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk index.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *chunk_index != NULL )
+	{
+		memory_free(
+		 *chunk_index );
+
+		*chunk_index = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a chunk index
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_index_free(
+     libewf_chunk_index_t **chunk_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_index_free";
+	int group_index       = 0;
+	int result            = 1;
+
+	if( chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_index != NULL )
+	{
+		if( ( *chunk_index )->groups != NULL )
+		{
+			for( group_index = 0;
+			     group_index < ( *chunk_index )->number_of_groups;
+			     group_index++ )
+			{
+				if( libewf_chunk_index_group_free(
+				     &( ( *chunk_index )->groups[ group_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free group: %d.",
+					 function,
+					 group_index );
+
+					result = -1;
+				}
+			}
+			memory_free(
+			 ( *chunk_index )->groups );
+		}
+		memory_free(
+		 *chunk_index );
+
+		*chunk_index = NULL;
+	}
+	return( result );
+}
+
+/* Frees a chunk index group
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_index_group_free(
+     libewf_chunk_index_group_t **chunk_index_group,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_index_group_free";
+
+	if( chunk_index_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk index group.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_index_group != NULL )
+	{
+		if( ( *chunk_index_group )->offsets != NULL )
+		{
+			memory_free(
+			 ( *chunk_index_group )->offsets );
+		}
+		if( ( *chunk_index_group )->sizes_data != NULL )
+		{
+			memory_free(
+			 ( *chunk_index_group )->sizes_data );
+		}
+		if( ( *chunk_index_group )->flags_data != NULL )
+		{
+			memory_free(
+			 ( *chunk_index_group )->flags_data );
+		}
+		memory_free(
+		 *chunk_index_group );
+
+		*chunk_index_group = NULL;
+	}
+	return( 1 );
+}
+
+/* Retrieves the index of the group that contains a specific entry
+ * If no group contains the entry the group index is set to the index
+ * where a group that starts with the entry is to be inserted
+ * Returns 1 if successful, 0 if no group contains the entry or -1 on error
+ */
+int libewf_chunk_index_get_group_index(
+     libewf_chunk_index_t *chunk_index,
+     uint64_t entry_index,
+     int *group_index,
+     libcerror_error_t **error )
+{
+	libewf_chunk_index_group_t *group = NULL;
+	static char *function             = "libewf_chunk_index_get_group_index";
+	int maximum_group_index           = 0;
+	int minimum_group_index           = 0;
+	int middle_group_index            = 0;
+
+	if( chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( group_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid group index.",
+		 function );
+
+		return( -1 );
+	}
+	/* Consecutive look ups mostly are for chunks in the same group
+	 */
+	if( ( chunk_index->last_group_index >= 0 )
+	 && ( chunk_index->last_group_index < chunk_index->number_of_groups ) )
+	{
+		group = chunk_index->groups[ chunk_index->last_group_index ];
+
+		if( ( entry_index >= group->first_chunk_index )
+		 && ( ( entry_index - group->first_chunk_index ) < (uint64_t) group->number_of_chunks ) )
+		{
+			*group_index = chunk_index->last_group_index;
+
+			return( 1 );
+		}
+	}
+	/* Look up the number of groups that start at or before the entry
+	 */
+	minimum_group_index = 0;
+	maximum_group_index = chunk_index->number_of_groups;
+
+	while( minimum_group_index < maximum_group_index )
+	{
+		middle_group_index = minimum_group_index + ( ( maximum_group_index - minimum_group_index ) / 2 );
+
+		if( chunk_index->groups[ middle_group_index ]->first_chunk_index <= entry_index )
+		{
+			minimum_group_index = middle_group_index + 1;
+		}
+		else
+		{
+			maximum_group_index = middle_group_index;
+		}
+	}
+	if( minimum_group_index > 0 )
+	{
+		group = chunk_index->groups[ minimum_group_index - 1 ];
+
+		if( ( entry_index - group->first_chunk_index ) < (uint64_t) group->number_of_chunks )
+		{
+			chunk_index->last_group_index = minimum_group_index - 1;
+
+			*group_index = minimum_group_index - 1;
+
+			return( 1 );
+		}
+	}
+	*group_index = minimum_group_index;
+
+	return( 0 );
+}
+
+/* Sets the chunks of a chunk group in the chunk index
+ * The ranges of the chunks are packed if the chunk data is stored contiguously,
+ * otherwise the group is only used to mark the chunks as not indexed
+ * Returns 1 if successful, 0 if the chunks were already set or -1 on error
+ */
+int libewf_chunk_index_set_chunk_group(
+     libewf_chunk_index_t *chunk_index,
+     uint64_t first_chunk_index,
+     uint32_t segment_number,
+     libewf_chunk_group_t *chunk_group,
+     libcerror_error_t **error )
+{
+	libewf_chunk_index_group_t **groups = NULL;
+	libewf_chunk_index_group_t *group   = NULL;
+	static char *function               = "libewf_chunk_index_set_chunk_group";
+	size64_t range_size                 = 0;
+	size_t groups_size                  = 0;
+	off64_t range_offset                = 0;
+	uint64_t relative_offset            = 0;
+	uint32_t maximum_range_size         = 0;
+	uint32_t range_flags                = 0;
+	uint32_t supported_range_flags      = 0;
+	uint8_t flags_bit_index             = 0;
+	uint8_t is_packed                   = 1;
+	uint8_t packed_range_flags          = 0;
+	int chunks_list_index               = 0;
+	int file_io_pool_entry              = 0;
+	int group_index                     = 0;
+	int move_group_index                = 0;
+	int number_of_chunks                = 0;
+	int number_of_allocated_groups      = 0;
+	int number_of_offsets               = 0;
+	int result                          = 0;
+
+	if( chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( first_chunk_index > (uint64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid first chunk index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_get_number_of_elements(
+	     chunk_group->chunks_list,
+	     &number_of_chunks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of chunks.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_chunks <= 0 )
+	{
+		return( 0 );
+	}
+	result = libewf_chunk_index_get_group_index(
+	          chunk_index,
+	          first_chunk_index,
+	          &group_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve group index of chunk: %" PRIu64 ".",
+		 function,
+		 first_chunk_index );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		return( 0 );
+	}
+	if( ( group_index < chunk_index->number_of_groups )
+	 && ( ( chunk_index->groups[ group_index ]->first_chunk_index - first_chunk_index ) < (uint64_t) number_of_chunks ) )
+	{
+		return( 0 );
+	}
+	for( flags_bit_index = 0;
+	     flags_bit_index < 8;
+	     flags_bit_index++ )
+	{
+		supported_range_flags |= libewf_chunk_index_packed_range_flags[ flags_bit_index ];
+	}
+	group = memory_allocate_structure(
+	         libewf_chunk_index_group_t );
+
+	if( group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create group.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     group,
+	     0,
+	     sizeof( libewf_chunk_index_group_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear group.",
+		 function );
+
+		memory_free(
+		 group );
+
+		return( -1 );
+	}
+	group->first_chunk_index  = first_chunk_index;
+	group->number_of_chunks   = (uint32_t) number_of_chunks;
+	group->segment_number     = segment_number;
+	group->file_io_pool_entry = -1;
+
+	/* Determine if the ranges of the chunks can be packed
+	 */
+	for( chunks_list_index = 0;
+	     chunks_list_index < number_of_chunks;
+	     chunks_list_index++ )
+	{
+		if( libfdata_list_get_element_by_index(
+		     chunk_group->chunks_list,
+		     chunks_list_index,
+		     &file_io_pool_entry,
+		     &range_offset,
+		     &range_size,
+		     &range_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %d range.",
+			 function,
+			 chunks_list_index );
+
+			goto on_error;
+		}
+		if( chunks_list_index == 0 )
+		{
+			group->file_io_pool_entry = file_io_pool_entry;
+			group->base_offset        = range_offset;
+		}
+		if( ( file_io_pool_entry < 0 )
+		 || ( file_io_pool_entry != group->file_io_pool_entry )
+		 || ( range_offset != ( group->base_offset + (off64_t) relative_offset ) )
+		 || ( range_size > (size64_t) UINT32_MAX )
+		 || ( ( range_flags & ~supported_range_flags ) != 0 ) )
+		{
+			is_packed = 0;
+
+			break;
+		}
+		if( (uint32_t) range_size > maximum_range_size )
+		{
+			maximum_range_size = (uint32_t) range_size;
+		}
+		/* Only the offset of every LIBEWF_CHUNK_INDEX_OFFSETS_INTERVAL-th chunk needs to fit in 32-bit
+		 */
+		if( ( ( chunks_list_index % LIBEWF_CHUNK_INDEX_OFFSETS_INTERVAL ) == 0 )
+		 && ( relative_offset > (uint64_t) UINT32_MAX ) )
+		{
+			is_packed = 0;
+
+			break;
+		}
+		relative_offset += range_size;
+	}
+	if( is_packed != 0 )
+	{
+		if( maximum_range_size <= (uint32_t) UINT16_MAX )
+		{
+			group->size_of_size = 2;
+		}
+		else
+		{
+			group->size_of_size = 4;
+		}
+		number_of_offsets = 1 + ( ( number_of_chunks - 1 ) / LIBEWF_CHUNK_INDEX_OFFSETS_INTERVAL );
+
+		group->offsets = (uint32_t *) memory_allocate(
+		                               sizeof( uint32_t ) * number_of_offsets );
+
+		if( group->offsets == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create offsets.",
+			 function );
+
+			goto on_error;
+		}
+		group->sizes_data = (uint8_t *) memory_allocate(
+		                                 sizeof( uint8_t ) * group->size_of_size * number_of_chunks );
+
+		if( group->sizes_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create sizes data.",
+			 function );
+
+			goto on_error;
+		}
+		group->flags_data = (uint8_t *) memory_allocate(
+		                                 sizeof( uint8_t ) * number_of_chunks );
+
+		if( group->flags_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create flags data.",
+			 function );
+
+			goto on_error;
+		}
+		relative_offset = 0;
+
+		for( chunks_list_index = 0;
+		     chunks_list_index < number_of_chunks;
+		     chunks_list_index++ )
+		{
+			if( libfdata_list_get_element_by_index(
+			     chunk_group->chunks_list,
+			     chunks_list_index,
+			     &file_io_pool_entry,
+			     &range_offset,
+			     &range_size,
+			     &range_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve chunk: %d range.",
+				 function,
+				 chunks_list_index );
+
+				goto on_error;
+			}
+			if( ( chunks_list_index % LIBEWF_CHUNK_INDEX_OFFSETS_INTERVAL ) == 0 )
+			{
+				group->offsets[ chunks_list_index / LIBEWF_CHUNK_INDEX_OFFSETS_INTERVAL ] = (uint32_t) relative_offset;
+			}
+			if( group->size_of_size == 2 )
+			{
+				byte_stream_copy_from_uint16_little_endian(
+				 &( group->sizes_data[ chunks_list_index * 2 ] ),
+				 (uint16_t) range_size );
+			}
+			else
+			{
+				byte_stream_copy_from_uint32_little_endian(
+				 &( group->sizes_data[ chunks_list_index * 4 ] ),
+				 (uint32_t) range_size );
+			}
+			packed_range_flags = 0;
+
+			for( flags_bit_index = 0;
+			     flags_bit_index < 8;
+			     flags_bit_index++ )
+			{
+				if( ( range_flags & libewf_chunk_index_packed_range_flags[ flags_bit_index ] ) != 0 )
+				{
+					packed_range_flags |= (uint8_t) ( 1 << flags_bit_index );
+				}
+			}
+			group->flags_data[ chunks_list_index ] = packed_range_flags;
+
+			relative_offset += range_size;
+		}
+	}
+	if( chunk_index->number_of_groups >= chunk_index->number_of_allocated_groups )
+	{
+		if( chunk_index->number_of_allocated_groups > ( INT_MAX / 2 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of allocated groups value exceeds maximum.",
+			 function );
+
+			goto on_error;
+		}
+		number_of_allocated_groups = chunk_index->number_of_allocated_groups * 2;
+
+		if( number_of_allocated_groups < LIBEWF_CHUNK_INDEX_MINIMUM_NUMBER_OF_GROUPS )
+		{
+			number_of_allocated_groups = LIBEWF_CHUNK_INDEX_MINIMUM_NUMBER_OF_GROUPS;
+		}
+#if SIZEOF_SIZE_T <= 4
+		if( (size_t) number_of_allocated_groups > ( (size_t) SSIZE_MAX / sizeof( libewf_chunk_index_group_t * ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of allocated groups value exceeds maximum.",
+			 function );
+
+			goto on_error;
+		}
+#endif
+		groups_size = sizeof( libewf_chunk_index_group_t * ) * number_of_allocated_groups;
+
+		groups = (libewf_chunk_index_group_t **) memory_reallocate(
+		                                          chunk_index->groups,
+		                                          groups_size );
+
+		if( groups == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize groups.",
+			 function );
+
+			goto on_error;
+		}
+		chunk_index->groups                     = groups;
+		chunk_index->number_of_allocated_groups = number_of_allocated_groups;
+	}
+	for( move_group_index = chunk_index->number_of_groups;
+	     move_group_index > group_index;
+	     move_group_index-- )
+	{
+		chunk_index->groups[ move_group_index ] = chunk_index->groups[ move_group_index - 1 ];
+	}
+	chunk_index->groups[ group_index ] = group;
+	chunk_index->number_of_groups     += 1;
+	chunk_index->last_group_index      = group_index;
+
+	return( 1 );
+
+on_error:
+	if( group != NULL )
+	{
+		libewf_chunk_index_group_free(
+		 &group,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves a specific entry
+ * Returns 1 if successful, 0 if the entry is not set or -1 on error
+ */
+int libewf_chunk_index_get_entry(
+     libewf_chunk_index_t *chunk_index,
+     uint64_t entry_index,
+     uint32_t *segment_number,
+     int *file_io_pool_entry,
+     off64_t *range_offset,
+     size64_t *range_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error )
+{
+	libewf_chunk_index_group_t *group = NULL;
+	static char *function             = "libewf_chunk_index_get_entry";
+	uint32_t chunk_size               = 0;
+	uint32_t group_entry_index        = 0;
+	uint64_t relative_offset          = 0;
+	uint32_t size_index               = 0;
+	uint16_t value_16bit              = 0;
+	uint8_t flags_bit_index           = 0;
+	uint8_t packed_range_flags        = 0;
+	int group_index                   = 0;
+	int result                        = 0;
+
+	if( chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_number == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment number.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range flags.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_chunk_index_get_group_index(
+	          chunk_index,
+	          entry_index,
+	          &group_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve group index of entry: %" PRIu64 ".",
+		 function,
+		 entry_index );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	group = chunk_index->groups[ group_index ];
+
+	if( group->sizes_data == NULL )
+	{
+		return( 0 );
+	}
+	group_entry_index = (uint32_t) ( entry_index - group->first_chunk_index );
+
+	relative_offset = group->offsets[ group_entry_index / LIBEWF_CHUNK_INDEX_OFFSETS_INTERVAL ];
+
+	for( size_index = group_entry_index - ( group_entry_index % LIBEWF_CHUNK_INDEX_OFFSETS_INTERVAL );
+	     size_index <= group_entry_index;
+	     size_index++ )
+	{
+		if( group->size_of_size == 2 )
+		{
+			byte_stream_copy_to_uint16_little_endian(
+			 &( group->sizes_data[ size_index * 2 ] ),
+			 value_16bit );
+
+			chunk_size = value_16bit;
+		}
+		else
+		{
+			byte_stream_copy_to_uint32_little_endian(
+			 &( group->sizes_data[ size_index * 4 ] ),
+			 chunk_size );
+		}
+		if( size_index < group_entry_index )
+		{
+			relative_offset += chunk_size;
+		}
+	}
+	packed_range_flags = group->flags_data[ group_entry_index ];
+
+	*range_flags = 0;
+
+	for( flags_bit_index = 0;
+	     flags_bit_index < 8;
+	     flags_bit_index++ )
+	{
+		if( ( packed_range_flags & ( 1 << flags_bit_index ) ) != 0 )
+		{
+			*range_flags |= libewf_chunk_index_packed_range_flags[ flags_bit_index ];
+		}
+	}
+	*segment_number     = group->segment_number;
+	*file_io_pool_entry = group->file_io_pool_entry;
+	*range_offset       = group->base_offset + (off64_t) relative_offset;
+	*range_size         = (size64_t) chunk_size;
+
+	return( 1 );
+}
+
+
+/* Retrieves the size of the memory used by the chunk index in bytes
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_index_get_memory_size(
+     libewf_chunk_index_t *chunk_index,
+     size64_t *memory_size,
+     libcerror_error_t **error )
+{
+	libewf_chunk_index_group_t *group = NULL;
+	static char *function             = "libewf_chunk_index_get_memory_size";
+	size64_t safe_memory_size         = 0;
+	int group_index                   = 0;
+
+	if( chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory size.",
+		 function );
+
+		return( -1 );
+	}
+	safe_memory_size = sizeof( libewf_chunk_index_t )
+	                 + ( sizeof( libewf_chunk_index_group_t * ) * chunk_index->number_of_allocated_groups );
+
+	for( group_index = 0;
+	     group_index < chunk_index->number_of_groups;
+	     group_index++ )
+	{
+		group = chunk_index->groups[ group_index ];
+
+		safe_memory_size += sizeof( libewf_chunk_index_group_t );
+
+		if( group->sizes_data != NULL )
+		{
+			safe_memory_size += sizeof( uint32_t ) * ( 1 + ( ( group->number_of_chunks - 1 ) / LIBEWF_CHUNK_INDEX_OFFSETS_INTERVAL ) );
+			safe_memory_size += (size64_t) group->size_of_size * group->number_of_chunks;
+			safe_memory_size += group->number_of_chunks;
+		}
+	}
+	*memory_size = safe_memory_size;
+
+	return( 1 );
+}
+
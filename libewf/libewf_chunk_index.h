@@ -0,0 +1,158 @@
+/*
+ * Chunk index functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_CHUNK_INDEX_H )
+#define _LIBEWF_CHUNK_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_group.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The number of chunks per stored chunk offset in a chunk index group
+ */
+#define LIBEWF_CHUNK_INDEX_OFFSETS_INTERVAL		64
+
+/* The minimum number of groups the chunk index is grown with
+ */
+#define LIBEWF_CHUNK_INDEX_MINIMUM_NUMBER_OF_GROUPS	16
+
+typedef struct libewf_chunk_index_group libewf_chunk_index_group_t;
+
+/* The chunk index group contains the packed ranges of the chunks of a chunk group
+ * The chunk data of a chunk group is stored contiguously, hence only the size of
+ * every chunk is stored and the offset is the sum of the sizes of the preceding
+ * chunks. The offset of every LIBEWF_CHUNK_INDEX_OFFSETS_INTERVAL-th chunk is
+ * stored to bound the number of sizes that needs to be summed
+ */
+struct libewf_chunk_index_group
+{
+	/* The index of the first chunk
+	 */
+	uint64_t first_chunk_index;
+
+	/* The number of chunks
+	 */
+	uint32_t number_of_chunks;
+
+	/* The segment number
+	 */
+	uint32_t segment_number;
+
+	/* The file IO pool entry of the segment file
+	 */
+	int file_io_pool_entry;
+
+	/* The offset of the chunk data of the first chunk in the segment file
+	 */
+	off64_t base_offset;
+
+	/* The offsets of every LIBEWF_CHUNK_INDEX_OFFSETS_INTERVAL-th chunk relative to the base offset
+	 */
+	uint32_t *offsets;
+
+	/* The sizes data, contains a 16-bit or 32-bit size per chunk
+	 */
+	uint8_t *sizes_data;
+
+	/* The size of a stored size in bytes
+	 */
+	uint8_t size_of_size;
+
+	/* The packed range flags, contains 8-bit flags per chunk
+	 */
+	uint8_t *flags_data;
+};
+
+typedef struct libewf_chunk_index libewf_chunk_index_t;
+
+/* The chunk index contains the chunk index groups sorted by the index of their first chunk
+ */
+struct libewf_chunk_index
+{
+	/* The groups
+	 */
+	libewf_chunk_index_group_t **groups;
+
+	/* The number of groups
+	 */
+	int number_of_groups;
+
+	/* The number of allocated groups
+	 */
+	int number_of_allocated_groups;
+
+	/* The index of the group of the last chunk that was looked up
+	 */
+	int last_group_index;
+};
+
+int libewf_chunk_index_initialize(
+     libewf_chunk_index_t **chunk_index,
+     libcerror_error_t **error );
+
+int libewf_chunk_index_free(
+     libewf_chunk_index_t **chunk_index,
+     libcerror_error_t **error );
+
+int libewf_chunk_index_group_free(
+     libewf_chunk_index_group_t **chunk_index_group,
+     libcerror_error_t **error );
+
+int libewf_chunk_index_get_group_index(
+     libewf_chunk_index_t *chunk_index,
+     uint64_t entry_index,
+     int *group_index,
+     libcerror_error_t **error );
+
+int libewf_chunk_index_set_chunk_group(
+     libewf_chunk_index_t *chunk_index,
+     uint64_t first_chunk_index,
+     uint32_t segment_number,
+     libewf_chunk_group_t *chunk_group,
+     libcerror_error_t **error );
+
+int libewf_chunk_index_get_entry(
+     libewf_chunk_index_t *chunk_index,
+     uint64_t entry_index,
+     uint32_t *segment_number,
+     int *file_io_pool_entry,
+     off64_t *range_offset,
+     size64_t *range_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error );
+
+int libewf_chunk_index_get_memory_size(
+     libewf_chunk_index_t *chunk_index,
+     size64_t *memory_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_CHUNK_INDEX_H ) */
+
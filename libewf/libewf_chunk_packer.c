@@ -0,0 +1,797 @@
+/*
+ * Chunk packer functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_chunk_packer.h"
+#include "libewf_compression_context.h"
+#include "libewf_definitions.h"
+#include "libewf_io_handle.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+#include "libewf_write_io_handle.h"
+
+/* Creates a chunk packer
+ * Make sure the value chunk_packer is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_packer_initialize(
+     libewf_chunk_packer_t **chunk_packer,
+     libewf_io_handle_t *io_handle,
+     libewf_write_io_handle_t *write_io_handle,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function             = "libewf_chunk_packer_initialize";
+	size32_t maximum_number_of_chunks = 0;
+	int context_index                 = 0;
+
+	if( chunk_packer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk packer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_packer != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk packer value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > LIBEWF_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*chunk_packer = memory_allocate_structure(
+	                   libewf_chunk_packer_t );
+
+	if( *chunk_packer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk packer.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *chunk_packer,
+	     0,
+	     sizeof( libewf_chunk_packer_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk packer.",
+		 function );
+
+		memory_free(
+		 *chunk_packer );
+
+		*chunk_packer = NULL;
+
+		return( -1 );
+	}
+	( *chunk_packer )->io_handle                = io_handle;
+	( *chunk_packer )->write_io_handle          = write_io_handle;
+	( *chunk_packer )->number_of_threads        = number_of_threads;
+	( *chunk_packer )->maximum_number_of_chunks = number_of_threads * LIBEWF_CHUNK_PACKER_NUMBER_OF_CHUNKS_PER_THREAD;
+
+	/* The batch is bounded by bytes so that large chunks do not require
+	 * a disproportionate amount of memory
+	 */
+	if( io_handle->chunk_size > 0 )
+	{
+		maximum_number_of_chunks = LIBEWF_CHUNK_PACKER_MAXIMUM_BATCH_SIZE / io_handle->chunk_size;
+
+		if( maximum_number_of_chunks == 0 )
+		{
+			maximum_number_of_chunks = 1;
+		}
+		if( maximum_number_of_chunks < (size32_t) ( *chunk_packer )->maximum_number_of_chunks )
+		{
+			( *chunk_packer )->maximum_number_of_chunks = (int) maximum_number_of_chunks;
+		}
+	}
+
+	( *chunk_packer )->compression_contexts = (libewf_compression_context_t **) memory_allocate(
+	                                             sizeof( libewf_compression_context_t * ) * number_of_threads );
+
+	if( ( *chunk_packer )->compression_contexts == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create compression contexts.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *chunk_packer )->compression_contexts,
+	     0,
+	     sizeof( libewf_compression_context_t * ) * number_of_threads ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear compression contexts.",
+		 function );
+
+		goto on_error;
+	}
+	for( context_index = 0;
+	     context_index < number_of_threads;
+	     context_index++ )
+	{
+		if( libewf_compression_context_initialize(
+		     &( ( ( *chunk_packer )->compression_contexts )[ context_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create compression context: %d.",
+			 function,
+			 context_index );
+
+			goto on_error;
+		}
+	}
+	( *chunk_packer )->number_of_free_compression_contexts = number_of_threads;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *chunk_packer )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *chunk_packer )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_thread_pool_create(
+	     &( ( *chunk_packer )->thread_pool ),
+	     NULL,
+	     number_of_threads,
+	     ( *chunk_packer )->maximum_number_of_chunks,
+	     (int (*)(intptr_t *, void *)) &libewf_chunk_packer_pack_callback,
+	     (void *) *chunk_packer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread pool.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *chunk_packer != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *chunk_packer )->condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *chunk_packer )->condition ),
+			 NULL );
+		}
+		if( ( *chunk_packer )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *chunk_packer )->mutex ),
+			 NULL );
+		}
+#endif
+		if( ( *chunk_packer )->compression_contexts != NULL )
+		{
+			for( context_index = 0;
+			     context_index < number_of_threads;
+			     context_index++ )
+			{
+				libewf_compression_context_free(
+				 &( ( ( *chunk_packer )->compression_contexts )[ context_index ] ),
+				 NULL );
+			}
+			memory_free(
+			 ( *chunk_packer )->compression_contexts );
+		}
+		memory_free(
+		 *chunk_packer );
+
+		*chunk_packer = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a chunk packer
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_packer_free(
+     libewf_chunk_packer_t **chunk_packer,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_packer_free";
+	int context_index     = 0;
+	int result            = 1;
+
+	if( chunk_packer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk packer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_packer != NULL )
+	{
+		/* The io_handle and write_io_handle references are freed elsewhere
+		 */
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *chunk_packer )->thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *chunk_packer )->thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_condition_free(
+		     &( ( *chunk_packer )->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *chunk_packer )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		if( ( *chunk_packer )->compression_contexts != NULL )
+		{
+			for( context_index = 0;
+			     context_index < ( *chunk_packer )->number_of_threads;
+			     context_index++ )
+			{
+				if( libewf_compression_context_free(
+				     &( ( ( *chunk_packer )->compression_contexts )[ context_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free compression context: %d.",
+					 function,
+					 context_index );
+
+					result = -1;
+				}
+			}
+			memory_free(
+			 ( *chunk_packer )->compression_contexts );
+		}
+		memory_free(
+		 *chunk_packer );
+
+		*chunk_packer = NULL;
+	}
+	return( result );
+}
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Packs chunk data
+ * Callback function for the thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_packer_pack_callback(
+     libewf_chunk_data_t *chunk_data,
+     libewf_chunk_packer_t *chunk_packer )
+{
+	libewf_compression_context_t *compression_context = NULL;
+	libcerror_error_t *error                          = NULL;
+	static char *function                             = "libewf_chunk_packer_pack_callback";
+	int result                                        = 0;
+
+	if( chunk_packer == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk packer.",
+		 function );
+
+		goto on_error;
+	}
+	/* Take a compression context for the duration of the pack
+	 */
+	if( libcthreads_mutex_grab(
+	     chunk_packer->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( chunk_packer->number_of_free_compression_contexts > 0 )
+	{
+		chunk_packer->number_of_free_compression_contexts -= 1;
+
+		compression_context = chunk_packer->compression_contexts[ chunk_packer->number_of_free_compression_contexts ];
+	}
+	if( libcthreads_mutex_release(
+	     chunk_packer->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	result = libewf_chunk_data_pack(
+	          chunk_data,
+	          chunk_packer->io_handle,
+	          compression_context,
+	          chunk_packer->write_io_handle->compressed_zero_byte_empty_block,
+	          chunk_packer->write_io_handle->compressed_zero_byte_empty_block_size,
+	          chunk_packer->write_io_handle->pack_flags,
+	          &error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to pack chunk data.",
+		 function );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( libcthreads_mutex_grab(
+	     chunk_packer->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( compression_context != NULL )
+	{
+		chunk_packer->compression_contexts[ chunk_packer->number_of_free_compression_contexts ] = compression_context;
+
+		chunk_packer->number_of_free_compression_contexts += 1;
+	}
+	if( result != 1 )
+	{
+		chunk_packer->number_of_failed_chunks += 1;
+	}
+	chunk_packer->number_of_pending_chunks -= 1;
+
+	if( chunk_packer->number_of_pending_chunks == 0 )
+	{
+		if( libcthreads_condition_broadcast(
+		     chunk_packer->condition,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 chunk_packer->mutex,
+			 NULL );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     chunk_packer->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+	}
+#endif
+	libcerror_error_free(
+	 &error );
+
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* Packs a batch of chunk data
+ * Entries that are NULL or already packed are skipped
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_packer_pack(
+     libewf_chunk_packer_t *chunk_packer,
+     libewf_chunk_data_t **chunk_data,
+     int number_of_chunks,
+     libcerror_error_t **error )
+{
+	static char *function         = "libewf_chunk_packer_pack";
+	int chunk_data_index          = 0;
+	int result                    = 1;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	int context_index             = 0;
+	int number_of_deflate_threads = 0;
+#endif
+
+	if( chunk_packer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk packer.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_chunks < 0 )
+	 || ( number_of_chunks > chunk_packer->maximum_number_of_chunks ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of chunks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_packer->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_packer->number_of_pending_chunks = 0;
+	chunk_packer->number_of_failed_chunks  = 0;
+
+	for( chunk_data_index = 0;
+	     chunk_data_index < number_of_chunks;
+	     chunk_data_index++ )
+	{
+		if( ( chunk_data[ chunk_data_index ] != NULL )
+		 && ( ( chunk_data[ chunk_data_index ]->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) == 0 ) )
+		{
+			chunk_packer->number_of_pending_chunks += 1;
+		}
+	}
+	/* If the batch contains fewer chunks than there are threads the threads
+	 * that would otherwise be idle are used to deflate the chunks in segments
+	 */
+	number_of_deflate_threads = 1;
+
+	if( ( chunk_packer->number_of_pending_chunks > 0 )
+	 && ( chunk_packer->number_of_pending_chunks < chunk_packer->number_of_threads ) )
+	{
+		number_of_deflate_threads = chunk_packer->number_of_threads / chunk_packer->number_of_pending_chunks;
+	}
+	for( context_index = 0;
+	     context_index < chunk_packer->number_of_free_compression_contexts;
+	     context_index++ )
+	{
+		chunk_packer->compression_contexts[ context_index ]->number_of_deflate_threads = number_of_deflate_threads;
+	}
+	if( libcthreads_mutex_release(
+	     chunk_packer->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	for( chunk_data_index = 0;
+	     chunk_data_index < number_of_chunks;
+	     chunk_data_index++ )
+	{
+		if( ( chunk_data[ chunk_data_index ] == NULL )
+		 || ( ( chunk_data[ chunk_data_index ]->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) != 0 ) )
+		{
+			continue;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_thread_pool_push(
+		     chunk_packer->thread_pool,
+		     (intptr_t *) chunk_data[ chunk_data_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push chunk data: %d onto thread pool queue.",
+			 function,
+			 chunk_data_index );
+
+			/* Do not wait for the chunks that were not pushed
+			 */
+			libcthreads_mutex_grab(
+			 chunk_packer->mutex,
+			 NULL );
+
+			chunk_packer->number_of_pending_chunks -= 1;
+			chunk_packer->number_of_failed_chunks  += 1;
+
+			libcthreads_mutex_release(
+			 chunk_packer->mutex,
+			 NULL );
+
+			result = -1;
+		}
+#else
+		if( libewf_chunk_data_pack(
+		     chunk_data[ chunk_data_index ],
+		     chunk_packer->io_handle,
+		     chunk_packer->compression_contexts[ 0 ],
+		     chunk_packer->write_io_handle->compressed_zero_byte_empty_block,
+		     chunk_packer->write_io_handle->compressed_zero_byte_empty_block_size,
+		     chunk_packer->write_io_handle->pack_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to pack chunk data: %d.",
+			 function,
+			 chunk_data_index );
+
+			return( -1 );
+		}
+#endif
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* Wait for the worker threads to pack the batch
+	 */
+	if( libcthreads_mutex_grab(
+	     chunk_packer->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( chunk_packer->number_of_pending_chunks > 0 )
+	{
+		if( libcthreads_condition_wait(
+		     chunk_packer->condition,
+		     chunk_packer->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+	}
+	if( ( result == 1 )
+	 && ( chunk_packer->number_of_failed_chunks > 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to pack %d chunk(s).",
+		 function,
+		 chunk_packer->number_of_failed_chunks );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     chunk_packer->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
@@ -0,0 +1,122 @@
+/*
+ * Chunk packer functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_CHUNK_PACKER_H )
+#define _LIBEWF_CHUNK_PACKER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_compression_context.h"
+#include "libewf_io_handle.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_write_io_handle.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_chunk_packer libewf_chunk_packer_t;
+
+/* The chunk packer packs batches of chunk data using a pool of worker threads
+ */
+struct libewf_chunk_packer
+{
+	/* The IO handle
+	 */
+	libewf_io_handle_t *io_handle;
+
+	/* The write IO handle
+	 */
+	libewf_write_io_handle_t *write_io_handle;
+
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+	/* The maximum number of chunks per batch
+	 */
+	int maximum_number_of_chunks;
+
+	/* The number of chunks of the current batch that still need to be packed
+	 */
+	int number_of_pending_chunks;
+
+	/* The number of chunks of the current batch that could not be packed
+	 */
+	int number_of_failed_chunks;
+
+	/* The compression contexts, one for every thread
+	 */
+	libewf_compression_context_t **compression_contexts;
+
+	/* The number of compression contexts that are not in use by a thread
+	 */
+	int number_of_free_compression_contexts;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when the current batch was packed
+	 */
+	libcthreads_condition_t *condition;
+#endif
+};
+
+int libewf_chunk_packer_initialize(
+     libewf_chunk_packer_t **chunk_packer,
+     libewf_io_handle_t *io_handle,
+     libewf_write_io_handle_t *write_io_handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libewf_chunk_packer_free(
+     libewf_chunk_packer_t **chunk_packer,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+int libewf_chunk_packer_pack_callback(
+     libewf_chunk_data_t *chunk_data,
+     libewf_chunk_packer_t *chunk_packer );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+int libewf_chunk_packer_pack(
+     libewf_chunk_packer_t *chunk_packer,
+     libewf_chunk_data_t **chunk_data,
+     int number_of_chunks,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_CHUNK_PACKER_H ) */
+
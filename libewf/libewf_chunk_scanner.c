@@ -0,0 +1,906 @@
+/*
+ * Chunk scanner functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_checksum.h"
+#include "libewf_chunk_group.h"
+#include "libewf_chunk_scanner.h"
+#include "libewf_deflate.h"
+#include "libewf_definitions.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libfdata.h"
+
+/* Creates a chunk scanner
+ * Make sure the value chunk_scanner is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_scanner_initialize(
+     libewf_chunk_scanner_t **chunk_scanner,
+     size32_t chunk_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_scanner_initialize";
+
+	if( chunk_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_scanner != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk scanner value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_size == 0 )
+	 || ( chunk_size > (size32_t) ( ( MEMORY_MAXIMUM_ALLOCATION_SIZE / LIBEWF_CHUNK_SCANNER_NUMBER_OF_BUFFERED_CHUNKS ) - 4 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*chunk_scanner = memory_allocate_structure(
+	                  libewf_chunk_scanner_t );
+
+	if( *chunk_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk scanner.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *chunk_scanner,
+	     0,
+	     sizeof( libewf_chunk_scanner_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk scanner.",
+		 function );
+
+		memory_free(
+		 *chunk_scanner );
+
+		*chunk_scanner = NULL;
+
+		return( -1 );
+	}
+	/* The buffer contains multiple chunks including their checksum
+	 * so that a chunk and the chunk following it can be checked in the buffer
+	 */
+	( *chunk_scanner )->buffer_size = LIBEWF_CHUNK_SCANNER_NUMBER_OF_BUFFERED_CHUNKS
+	                                * ( (size_t) chunk_size + 4 );
+
+	( *chunk_scanner )->buffer = (uint8_t *) memory_allocate(
+	                                          sizeof( uint8_t ) * ( *chunk_scanner )->buffer_size );
+
+	if( ( *chunk_scanner )->buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	( *chunk_scanner )->uncompressed_data = (uint8_t *) memory_allocate(
+	                                                     sizeof( uint8_t ) * chunk_size );
+
+	if( ( *chunk_scanner )->uncompressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create uncompressed data.",
+		 function );
+
+		goto on_error;
+	}
+	( *chunk_scanner )->chunk_size    = chunk_size;
+	( *chunk_scanner )->buffer_offset = -1;
+
+	return( 1 );
+
+on_error:
+	if( *chunk_scanner != NULL )
+	{
+		if( ( *chunk_scanner )->buffer != NULL )
+		{
+			memory_free(
+			 ( *chunk_scanner )->buffer );
+		}
+		memory_free(
+		 *chunk_scanner );
+
+		*chunk_scanner = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a chunk scanner
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_scanner_free(
+     libewf_chunk_scanner_t **chunk_scanner,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_scanner_free";
+
+	if( chunk_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_scanner != NULL )
+	{
+		if( ( *chunk_scanner )->uncompressed_data != NULL )
+		{
+			memory_free(
+			 ( *chunk_scanner )->uncompressed_data );
+		}
+		if( ( *chunk_scanner )->buffer != NULL )
+		{
+			memory_free(
+			 ( *chunk_scanner )->buffer );
+		}
+		memory_free(
+		 *chunk_scanner );
+
+		*chunk_scanner = NULL;
+	}
+	return( 1 );
+}
+
+/* Reads the chunk data starting at a specific offset into the buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_scanner_read_buffer(
+     libewf_chunk_scanner_t *chunk_scanner,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t offset,
+     off64_t end_offset,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_scanner_read_buffer";
+	ssize_t read_count    = 0;
+	size_t read_size      = 0;
+
+	if( chunk_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( offset >= end_offset ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	read_size = chunk_scanner->buffer_size;
+
+	if( (size64_t) read_size > (size64_t) ( end_offset - offset ) )
+	{
+		read_size = (size_t) ( end_offset - offset );
+	}
+	chunk_scanner->buffer_offset    = -1;
+	chunk_scanner->buffer_data_size = 0;
+
+	if( libbfio_pool_seek_offset(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek chunk data offset: %" PRIi64 " (0x%08" PRIx64 ") in file IO pool entry: %d.",
+		 function,
+		 offset,
+		 offset,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	read_count = libbfio_pool_read_buffer(
+	              file_io_pool,
+	              file_io_pool_entry,
+	              chunk_scanner->buffer,
+	              read_size,
+	              error );
+
+	if( read_count != (ssize_t) read_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk data at offset: %" PRIi64 " (0x%08" PRIx64 ") from file IO pool entry: %d.",
+		 function,
+		 offset,
+		 offset,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	chunk_scanner->buffer_offset    = offset;
+	chunk_scanner->buffer_data_size = read_size;
+
+	return( 1 );
+}
+
+/* Determines if the data starts with a compressed chunk
+ * Returns 1 if the data starts with a compressed chunk, 0 if not or -1 on error
+ */
+int libewf_chunk_scanner_check_compressed_chunk(
+     libewf_chunk_scanner_t *chunk_scanner,
+     const uint8_t *data,
+     size_t data_size,
+     uint8_t data_is_at_end,
+     size_t *chunk_data_size,
+     libcerror_error_t **error )
+{
+	libcerror_error_t *decompression_error = NULL;
+	static char *function                  = "libewf_chunk_scanner_check_compressed_chunk";
+	size_t compressed_stream_size          = 0;
+	size_t uncompressed_data_size          = 0;
+	int result                             = 0;
+
+	if( chunk_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data size.",
+		 function );
+
+		return( -1 );
+	}
+	/* A zlib stream consists of at least a 2-byte header and a 4-byte checksum
+	 */
+	if( data_size < 6 )
+	{
+		return( 0 );
+	}
+	/* Check the zlib header, which uses the deflate compression method,
+	 * a window size of at most 32 KiB, no preset dictionary and
+	 * the check bits
+	 */
+	if( ( ( data[ 0 ] & 0x0f ) != 8 )
+	 || ( ( data[ 0 ] >> 4 ) > 7 )
+	 || ( ( data[ 1 ] & 0x20 ) != 0 )
+	 || ( ( ( ( (uint16_t) data[ 0 ] << 8 ) | data[ 1 ] ) % 31 ) != 0 ) )
+	{
+		return( 0 );
+	}
+	uncompressed_data_size = (size_t) chunk_scanner->chunk_size;
+
+	/* Data that does not decompress is not a compressed chunk
+	 */
+	if( libewf_deflate_decompress_stream(
+	     data,
+	     data_size,
+	     &compressed_stream_size,
+	     chunk_scanner->uncompressed_data,
+	     &uncompressed_data_size,
+	     &decompression_error ) != 1 )
+	{
+		libcerror_error_free(
+		 &decompression_error );
+
+		return( 0 );
+	}
+	/* Only the last chunk of the chunk data can be smaller than the chunk size
+	 */
+	if( uncompressed_data_size == (size_t) chunk_scanner->chunk_size )
+	{
+		result = 1;
+	}
+	else if( ( data_is_at_end != 0 )
+	      && ( compressed_stream_size == data_size )
+	      && ( uncompressed_data_size > 0 )
+	      && ( uncompressed_data_size < (size_t) chunk_scanner->chunk_size ) )
+	{
+		result = 1;
+	}
+	if( result != 0 )
+	{
+		*chunk_data_size = compressed_stream_size;
+	}
+	return( result );
+}
+
+/* Determines if the data starts with a chunk
+ * Returns 1 if the data starts with a chunk, 0 if not or -1 on error
+ */
+int libewf_chunk_scanner_check_chunk(
+     libewf_chunk_scanner_t *chunk_scanner,
+     const uint8_t *data,
+     size_t data_size,
+     uint8_t data_is_at_end,
+     size_t *chunk_data_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error )
+{
+	static char *function       = "libewf_chunk_scanner_check_chunk";
+	size_t checksum_data_size   = 0;
+	uint32_t calculated_checksum = 0;
+	uint32_t stored_checksum    = 0;
+	int result                  = 0;
+
+	if( chunk_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range flags.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_chunk_scanner_check_compressed_chunk(
+	          chunk_scanner,
+	          data,
+	          data_size,
+	          data_is_at_end,
+	          chunk_data_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to determine if data starts with a compressed chunk.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		*range_flags = LIBEWF_RANGE_FLAG_IS_COMPRESSED;
+
+		return( 1 );
+	}
+	/* An uncompressed chunk is followed by its checksum where only the last
+	 * chunk of the chunk data can be smaller than the chunk size
+	 */
+	if( data_size >= ( (size_t) chunk_scanner->chunk_size + 4 ) )
+	{
+		checksum_data_size = (size_t) chunk_scanner->chunk_size;
+	}
+	else if( ( data_is_at_end != 0 )
+	      && ( data_size > 4 ) )
+	{
+		checksum_data_size = data_size - 4;
+	}
+	else
+	{
+		return( 0 );
+	}
+	if( libewf_checksum_calculate_adler32(
+	     &calculated_checksum,
+	     data,
+	     checksum_data_size,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate checksum.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 &( data[ checksum_data_size ] ),
+	 stored_checksum );
+
+	if( stored_checksum != calculated_checksum )
+	{
+		return( 0 );
+	}
+	*chunk_data_size = checksum_data_size + 4;
+	*range_flags     = LIBEWF_RANGE_FLAG_HAS_CHECKSUM;
+
+	return( 1 );
+}
+
+/* Finds the offset of the next chunk in the chunk data
+ * The Adler-32 of uncompressed chunks is calculated as a rolling checksum
+ * so that every offset can be checked without rereading the chunk
+ * Returns 1 if successful, 0 if no chunk was found or -1 on error
+ */
+int libewf_chunk_scanner_find_next_chunk(
+     libewf_chunk_scanner_t *chunk_scanner,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t offset,
+     off64_t end_offset,
+     off64_t *chunk_offset,
+     libcerror_error_t **error )
+{
+	const uint8_t *data          = NULL;
+	static char *function        = "libewf_chunk_scanner_find_next_chunk";
+	size_t chunk_data_size       = 0;
+	size_t data_offset           = 0;
+	size_t data_size             = 0;
+	size_t required_data_size    = 0;
+	uint32_t chunk_size_modulus  = 0;
+	uint32_t lower_word          = 0;
+	uint32_t stored_checksum     = 0;
+	uint32_t upper_word          = 0;
+	uint8_t data_is_at_end       = 0;
+	uint8_t has_rolling_checksum = 0;
+	int result                   = 0;
+
+	if( chunk_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk offset.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_size_modulus = chunk_scanner->chunk_size % 65521;
+
+	/* The data required to check an offset is the byte before the offset,
+	 * which is removed from the rolling checksum, an uncompressed chunk and its checksum
+	 */
+	required_data_size = (size_t) chunk_scanner->chunk_size + 5;
+
+	while( offset < end_offset )
+	{
+		if( ( chunk_scanner->buffer_offset < 0 )
+		 || ( offset <= chunk_scanner->buffer_offset )
+		 || ( offset > ( chunk_scanner->buffer_offset + (off64_t) chunk_scanner->buffer_data_size ) )
+		 || ( ( ( chunk_scanner->buffer_offset + (off64_t) chunk_scanner->buffer_data_size ) < end_offset )
+		  && ( (size64_t) ( chunk_scanner->buffer_offset + (off64_t) chunk_scanner->buffer_data_size - offset ) < ( required_data_size - 1 ) ) ) )
+		{
+			if( libewf_chunk_scanner_read_buffer(
+			     chunk_scanner,
+			     file_io_pool,
+			     file_io_pool_entry,
+			     offset - 1,
+			     end_offset,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read chunk data at offset: %" PRIi64 ".",
+				 function,
+				 offset - 1 );
+
+				return( -1 );
+			}
+		}
+		data_offset    = (size_t) ( offset - chunk_scanner->buffer_offset );
+		data           = &( chunk_scanner->buffer[ data_offset ] );
+		data_size      = chunk_scanner->buffer_data_size - data_offset;
+		data_is_at_end = (uint8_t) ( ( chunk_scanner->buffer_offset + (off64_t) chunk_scanner->buffer_data_size ) == end_offset );
+
+		result = libewf_chunk_scanner_check_compressed_chunk(
+		          chunk_scanner,
+		          data,
+		          data_size,
+		          data_is_at_end,
+		          &chunk_data_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to determine if data at offset: %" PRIi64 " starts with a compressed chunk.",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			*chunk_offset = offset;
+
+			return( 1 );
+		}
+		if( data_size < ( (size_t) chunk_scanner->chunk_size + 4 ) )
+		{
+			/* A smaller last chunk is not searched for
+			 */
+			break;
+		}
+		if( has_rolling_checksum == 0 )
+		{
+			if( libewf_checksum_calculate_adler32(
+			     &stored_checksum,
+			     data,
+			     (size_t) chunk_scanner->chunk_size,
+			     1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to calculate checksum.",
+				 function );
+
+				return( -1 );
+			}
+			lower_word = stored_checksum & 0x0000ffffUL;
+			upper_word = stored_checksum >> 16;
+
+			has_rolling_checksum = 1;
+		}
+		else
+		{
+			/* Remove the byte before the offset and add the last byte of the chunk
+			 */
+			lower_word = ( lower_word + 65521 - data[ -1 ] + data[ chunk_scanner->chunk_size - 1 ] ) % 65521;
+			upper_word = ( upper_word + 65521 - ( ( chunk_size_modulus * data[ -1 ] ) % 65521 ) + lower_word + 65520 ) % 65521;
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 &( data[ chunk_scanner->chunk_size ] ),
+		 stored_checksum );
+
+		if( stored_checksum == ( ( upper_word << 16 ) | lower_word ) )
+		{
+			*chunk_offset = offset;
+
+			return( 1 );
+		}
+		offset += 1;
+	}
+	return( 0 );
+}
+
+/* Scans the chunk data for chunks and appends them to the chunks list of the chunk group
+ * Data that does not contain a valid chunk is appended as a single corrupted chunk
+ * Returns 1 if successful, 0 if more than the maximum number of chunks were found or -1 on error
+ */
+int libewf_chunk_scanner_scan(
+     libewf_chunk_scanner_t *chunk_scanner,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t start_offset,
+     off64_t end_offset,
+     libewf_chunk_group_t *chunk_group,
+     uint32_t maximum_number_of_chunks,
+     uint32_t *number_of_chunks,
+     libcerror_error_t **error )
+{
+	static char *function      = "libewf_chunk_scanner_scan";
+	off64_t next_chunk_offset  = 0;
+	off64_t offset             = 0;
+	size_t chunk_data_size     = 0;
+	size_t data_offset         = 0;
+	size_t required_data_size  = 0;
+	uint32_t range_flags       = 0;
+	uint8_t data_is_at_end     = 0;
+	int element_index          = 0;
+	int result                 = 0;
+
+	if( chunk_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( start_offset < 0 )
+	 || ( start_offset > end_offset ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid start offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of chunks.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_chunks = 0;
+
+	/* The data required to check a chunk is the chunk, its checksum
+	 * and the start of the next chunk
+	 */
+	required_data_size = 2 * ( (size_t) chunk_scanner->chunk_size + 4 );
+
+	offset = start_offset;
+
+	while( offset < end_offset )
+	{
+		if( *number_of_chunks >= maximum_number_of_chunks )
+		{
+			return( 0 );
+		}
+		if( ( chunk_scanner->buffer_offset < 0 )
+		 || ( offset < chunk_scanner->buffer_offset )
+		 || ( offset >= ( chunk_scanner->buffer_offset + (off64_t) chunk_scanner->buffer_data_size ) )
+		 || ( ( ( chunk_scanner->buffer_offset + (off64_t) chunk_scanner->buffer_data_size ) < end_offset )
+		  && ( (size64_t) ( chunk_scanner->buffer_offset + (off64_t) chunk_scanner->buffer_data_size - offset ) < required_data_size ) ) )
+		{
+			if( libewf_chunk_scanner_read_buffer(
+			     chunk_scanner,
+			     file_io_pool,
+			     file_io_pool_entry,
+			     offset,
+			     end_offset,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read chunk data at offset: %" PRIi64 ".",
+				 function,
+				 offset );
+
+				return( -1 );
+			}
+		}
+		data_offset    = (size_t) ( offset - chunk_scanner->buffer_offset );
+		data_is_at_end = (uint8_t) ( ( chunk_scanner->buffer_offset + (off64_t) chunk_scanner->buffer_data_size ) == end_offset );
+
+		result = libewf_chunk_scanner_check_chunk(
+		          chunk_scanner,
+		          &( chunk_scanner->buffer[ data_offset ] ),
+		          chunk_scanner->buffer_data_size - data_offset,
+		          data_is_at_end,
+		          &chunk_data_size,
+		          &range_flags,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to determine if data at offset: %" PRIi64 " starts with a chunk.",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			result = libewf_chunk_scanner_find_next_chunk(
+			          chunk_scanner,
+			          file_io_pool,
+			          file_io_pool_entry,
+			          offset + 1,
+			          end_offset,
+			          &next_chunk_offset,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to find next chunk after offset: %" PRIi64 ".",
+				 function,
+				 offset );
+
+				return( -1 );
+			}
+			else if( result == 0 )
+			{
+				next_chunk_offset = end_offset;
+			}
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: no valid chunk found in data at offset: 0x%08" PRIx64 " - 0x%08" PRIx64 ".\n",
+				 function,
+				 offset,
+				 next_chunk_offset );
+			}
+#endif
+			chunk_data_size = (size_t) ( next_chunk_offset - offset );
+			range_flags     = LIBEWF_RANGE_FLAG_HAS_CHECKSUM | LIBEWF_RANGE_FLAG_IS_CORRUPTED;
+		}
+		if( libfdata_list_append_element_with_mapped_size(
+		     chunk_group->chunks_list,
+		     &element_index,
+		     file_io_pool_entry,
+		     offset,
+		     (size64_t) chunk_data_size,
+		     range_flags,
+		     chunk_scanner->chunk_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append element: %" PRIu32 " with mapped size to chunks list.",
+			 function,
+			 *number_of_chunks );
+
+			return( -1 );
+		}
+		offset            += (off64_t) chunk_data_size;
+		*number_of_chunks += 1;
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,132 @@
+/*
+ * Chunk scanner functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_CHUNK_SCANNER_H )
+#define _LIBEWF_CHUNK_SCANNER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_group.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The number of chunks that are read from the chunk data at once
+ */
+#define LIBEWF_CHUNK_SCANNER_NUMBER_OF_BUFFERED_CHUNKS	16
+
+typedef struct libewf_chunk_scanner libewf_chunk_scanner_t;
+
+/* The chunk scanner determines the offsets and sizes of the chunks in
+ * version 1 chunk data without a table, by validating the checksum of
+ * uncompressed chunks and decompressing compressed chunks
+ */
+struct libewf_chunk_scanner
+{
+	/* The chunk size
+	 */
+	size32_t chunk_size;
+
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The buffer size
+	 */
+	size_t buffer_size;
+
+	/* The offset of the data in the buffer
+	 */
+	off64_t buffer_offset;
+
+	/* The size of the data in the buffer
+	 */
+	size_t buffer_data_size;
+
+	/* The uncompressed data
+	 */
+	uint8_t *uncompressed_data;
+};
+
+int libewf_chunk_scanner_initialize(
+     libewf_chunk_scanner_t **chunk_scanner,
+     size32_t chunk_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_scanner_free(
+     libewf_chunk_scanner_t **chunk_scanner,
+     libcerror_error_t **error );
+
+int libewf_chunk_scanner_read_buffer(
+     libewf_chunk_scanner_t *chunk_scanner,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t offset,
+     off64_t end_offset,
+     libcerror_error_t **error );
+
+int libewf_chunk_scanner_check_compressed_chunk(
+     libewf_chunk_scanner_t *chunk_scanner,
+     const uint8_t *data,
+     size_t data_size,
+     uint8_t data_is_at_end,
+     size_t *chunk_data_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_scanner_check_chunk(
+     libewf_chunk_scanner_t *chunk_scanner,
+     const uint8_t *data,
+     size_t data_size,
+     uint8_t data_is_at_end,
+     size_t *chunk_data_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error );
+
+int libewf_chunk_scanner_find_next_chunk(
+     libewf_chunk_scanner_t *chunk_scanner,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t offset,
+     off64_t end_offset,
+     off64_t *chunk_offset,
+     libcerror_error_t **error );
+
+int libewf_chunk_scanner_scan(
+     libewf_chunk_scanner_t *chunk_scanner,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t start_offset,
+     off64_t end_offset,
+     libewf_chunk_group_t *chunk_group,
+     uint32_t maximum_number_of_chunks,
+     uint32_t *number_of_chunks,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_CHUNK_SCANNER_H ) */
+
@@ -26,8 +26,12 @@
 
 #include "libewf_chunk_data.h"
 #include "libewf_chunk_group.h"
+#include "libewf_chunk_index.h"
 #include "libewf_chunk_table.h"
+#include "libewf_compression_context.h"
+#include "libewf_corrupted_chunks.h"
 #include "libewf_definitions.h"
+#include "libewf_disk_chunk_cache.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
@@ -35,6 +39,9 @@
 #include "libewf_libfdata.h"
 #include "libewf_segment_file.h"
 #include "libewf_segment_table.h"
+#include "libewf_shared_chunk_cache.h"
+#include "libewf_statistics.h"
+#include "libewf_trace.h"
 
 /* Creates a chunk table
  * Make sure the value chunk_table is referencing, is set to NULL
@@ -113,6 +120,19 @@ int libewf_chunk_table_initialize(
 
 		return( -1 );
 	}
+	if( libewf_chunk_index_initialize(
+	     &( ( *chunk_table )->chunks_index ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunks index.",
+		 function );
+
+		goto on_error;
+	}
 	if( libfdata_list_initialize(
 	     &( ( *chunk_table )->corrupted_chunks_list ),
 	     NULL,
@@ -132,7 +152,20 @@ int libewf_chunk_table_initialize(
 
 		goto on_error;
 	}
-	if( libcdata_range_list_initialize(
+	if( libewf_corrupted_chunks_initialize(
+	     &( ( *chunk_table )->corrupted_chunks ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create corrupted chunks.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_sector_range_list_initialize(
 	     &( ( *chunk_table )->checksum_errors ),
 	     error ) != 1 )
 	{
@@ -145,6 +178,19 @@ int libewf_chunk_table_initialize(
 
 		goto on_error;
 	}
+	if( libewf_compression_context_initialize(
+	     &( ( *chunk_table )->compression_context ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create compression context.",
+		 function );
+
+		goto on_error;
+	}
 	( *chunk_table )->io_handle = io_handle;
 
 	return( 1 );
@@ -152,12 +198,30 @@ int libewf_chunk_table_initialize(
 on_error:
 	if( *chunk_table != NULL )
 	{
+		if( ( *chunk_table )->checksum_errors != NULL )
+		{
+			libewf_sector_range_list_free(
+			 &( ( *chunk_table )->checksum_errors ),
+			 NULL );
+		}
+		if( ( *chunk_table )->corrupted_chunks != NULL )
+		{
+			libewf_corrupted_chunks_free(
+			 &( ( *chunk_table )->corrupted_chunks ),
+			 NULL );
+		}
 		if( ( *chunk_table )->corrupted_chunks_list != NULL )
 		{
 			libfdata_list_free(
 			 &( ( *chunk_table )->corrupted_chunks_list ),
 			 NULL );
 		}
+		if( ( *chunk_table )->chunks_index != NULL )
+		{
+			libewf_chunk_index_free(
+			 &( ( *chunk_table )->chunks_index ),
+			 NULL );
+		}
 		memory_free(
 		 *chunk_table );
 
@@ -189,6 +253,19 @@ int libewf_chunk_table_free(
 	}
 	if( *chunk_table != NULL )
 	{
+		if( libewf_chunk_index_free(
+		     &( ( *chunk_table )->chunks_index ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunks index.",
+			 function );
+
+			result = -1;
+		}
 		if( libfdata_list_free(
 		     &( ( *chunk_table )->corrupted_chunks_list ),
 		     error ) != 1 )
@@ -202,9 +279,21 @@ int libewf_chunk_table_free(
 
 			result = -1;
 		}
-		if( libcdata_range_list_free(
+		if( libewf_corrupted_chunks_free(
+		     &( ( *chunk_table )->corrupted_chunks ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free corrupted chunks.",
+			 function );
+
+			result = -1;
+		}
+		if( libewf_sector_range_list_free(
 		     &( ( *chunk_table )->checksum_errors ),
-		     NULL,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -216,6 +305,19 @@ int libewf_chunk_table_free(
 
 			result = -1;
 		}
+		if( libewf_compression_context_free(
+		     &( ( *chunk_table )->compression_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free compression context.",
+			 function );
+
+			result = -1;
+		}
 		memory_free(
 		 *chunk_table );
 
@@ -296,14 +398,17 @@ int libewf_chunk_table_clone(
 		return( -1 );
 	}
 /* TODO: clonse corrupted_chunks_list */
-	( *destination_chunk_table )->corrupted_chunks_list = NULL;
-	( *destination_chunk_table )->checksum_errors       = NULL;
-
-	if( libcdata_range_list_clone(
+	( *destination_chunk_table )->chunks_index           = NULL;
+	( *destination_chunk_table )->corrupted_chunks_list  = NULL;
+	( *destination_chunk_table )->corrupted_chunks       = NULL;
+	( *destination_chunk_table )->checksum_errors        = NULL;
+	( *destination_chunk_table )->compression_context    = NULL;
+	( *destination_chunk_table )->number_of_cache_hits   = 0;
+	( *destination_chunk_table )->number_of_cache_misses = 0;
+
+	if( libewf_sector_range_list_clone(
 	     &( ( *destination_chunk_table )->checksum_errors ),
 	     source_chunk_table->checksum_errors,
-	     NULL,
-	     NULL,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -315,11 +420,72 @@ int libewf_chunk_table_clone(
 
 		goto on_error;
 	}
+	/* The destination corrupted chunks are set when the chunks are unpacked
+	 */
+	if( libewf_corrupted_chunks_initialize(
+	     &( ( *destination_chunk_table )->corrupted_chunks ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination corrupted chunks.",
+		 function );
+
+		goto on_error;
+	}
+	/* The destination chunks index is filled when the chunks are looked up
+	 */
+	if( libewf_chunk_index_initialize(
+	     &( ( *destination_chunk_table )->chunks_index ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination chunks index.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_compression_context_initialize(
+	     &( ( *destination_chunk_table )->compression_context ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination compression context.",
+		 function );
+
+		goto on_error;
+	}
 	return( 1 );
 
 on_error:
 	if( *destination_chunk_table != NULL )
 	{
+		if( ( *destination_chunk_table )->chunks_index != NULL )
+		{
+			libewf_chunk_index_free(
+			 &( ( *destination_chunk_table )->chunks_index ),
+			 NULL );
+		}
+		if( ( *destination_chunk_table )->checksum_errors != NULL )
+		{
+			libewf_sector_range_list_free(
+			 &( ( *destination_chunk_table )->checksum_errors ),
+			 NULL );
+		}
+		if( ( *destination_chunk_table )->corrupted_chunks != NULL )
+		{
+			libewf_corrupted_chunks_free(
+			 &( ( *destination_chunk_table )->corrupted_chunks ),
+			 NULL );
+		}
 		memory_free(
 		 *destination_chunk_table );
 
@@ -361,7 +527,7 @@ int libewf_chunk_table_get_number_of_checksum_errors(
 
 		return( -1 );
 	}
-	if( libcdata_range_list_get_number_of_elements(
+	if( libewf_sector_range_list_get_number_of_ranges(
 	     chunk_table->checksum_errors,
 	     &number_of_elements,
 	     error ) != 1 )
@@ -403,7 +569,6 @@ int libewf_chunk_table_get_checksum_error(
      libcerror_error_t **error )
 {
 	static char *function = "libewf_chunk_table_get_checksum_error";
-	intptr_t *value       = NULL;
 
 	if( chunk_table == NULL )
 	{
@@ -416,12 +581,11 @@ int libewf_chunk_table_get_checksum_error(
 
 		return( -1 );
 	}
-	if( libcdata_range_list_get_range_by_index(
+	if( libewf_sector_range_list_get_range_by_index(
 	     chunk_table->checksum_errors,
 	     (int) error_index,
 	     start_sector,
 	     number_of_sectors,
-	     &value,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -460,26 +624,437 @@ int libewf_chunk_table_append_checksum_error(
 
 		return( -1 );
 	}
-	result = libcdata_range_list_insert_range(
-	          chunk_table->checksum_errors,
-	          start_sector,
-	          number_of_sectors,
-	          NULL,
-	          NULL,
-	          NULL,
-	          error );
+	result = libewf_sector_range_list_insert_range(
+	          chunk_table->checksum_errors,
+	          start_sector,
+	          number_of_sectors,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to insert checksum error in range list.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Determines if a range of sectors overlaps with a checksum error
+ * Returns 1 if the sectors overlap with a checksum error, 0 if not or -1 on error
+ */
+int libewf_chunk_table_has_checksum_error(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t start_sector,
+     uint64_t number_of_sectors,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_table_has_checksum_error";
+	int result            = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_sector_range_list_range_is_present(
+	          chunk_table->checksum_errors,
+	          start_sector,
+	          number_of_sectors,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if checksum error is present in range list.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves the number of checksum errors that overlap with a range of sectors
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_get_number_of_checksum_errors_in_range(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t start_sector,
+     uint64_t number_of_sectors,
+     uint32_t *number_of_errors,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_table_get_number_of_checksum_errors_in_range";
+	int number_of_ranges  = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_errors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of errors.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_sector_range_list_get_number_of_ranges_in_range(
+	     chunk_table->checksum_errors,
+	     start_sector,
+	     number_of_sectors,
+	     &number_of_ranges,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of checksum errors in range from range list.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_ranges < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of ranges value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_errors = (uint32_t) number_of_ranges;
+
+	return( 1 );
+}
+
+/* Retrieves the chunk data of a chunk that previously failed to unpack
+ * If zero on error is set the chunk data is filled with zero bytes, otherwise
+ * the chunk data is a copy of the retained unpacked data of the chunk
+ * The caller takes over management of the chunk data
+ * Returns 1 if successful, 0 if the chunk is not known to be corrupted or its data was not retained or -1 on error
+ */
+int libewf_chunk_table_get_corrupted_chunk_data(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     size32_t chunk_size,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *retained_chunk_data = NULL;
+	static char *function                    = "libewf_chunk_table_get_corrupted_chunk_data";
+	size_t data_size                         = 0;
+	uint32_t range_flags                     = 0;
+	int result                               = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_table->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk table - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_corrupted_chunks_get_chunk(
+	          chunk_table->corrupted_chunks,
+	          chunk_index,
+	          &data_size,
+	          &range_flags,
+	          &retained_chunk_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve corrupted chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( chunk_table->io_handle->zero_on_error != 0 )
+	{
+		if( data_size > (size_t) chunk_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid corrupted chunk: %" PRIu64 " data size value out of bounds.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		if( libewf_chunk_data_initialize_with_buffer_pool(
+		     chunk_data,
+		     chunk_table->io_handle->buffer_pool,
+		     chunk_size,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		( *chunk_data )->data_size   = data_size;
+		( *chunk_data )->range_flags = range_flags;
+	}
+	else if( retained_chunk_data == NULL )
+	{
+		return( 0 );
+	}
+	else if( libewf_chunk_data_clone(
+	          chunk_data,
+	          retained_chunk_data,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to clone chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Remembers that a specific chunk failed to unpack
+ * The chunk data should contain the unpacked data of the chunk, which is retained
+ * unless zero on error is set, in which case the data is recreated from zero bytes
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_set_corrupted_chunk(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error )
+{
+	static char *function     = "libewf_chunk_table_set_corrupted_chunk";
+	uint8_t retain_chunk_data = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_table->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk table - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_table->io_handle->zero_on_error == 0 )
+	{
+		retain_chunk_data = 1;
+	}
+	if( libewf_corrupted_chunks_set_chunk(
+	     chunk_table->corrupted_chunks,
+	     chunk_index,
+	     chunk_data,
+	     retain_chunk_data,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set corrupted chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Adds the chunks of a chunk group to the chunks index
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_index_chunk_group(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t first_chunk_index,
+     uint32_t segment_number,
+     libewf_chunk_group_t *chunk_group,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_table_index_chunk_group";
+	size64_t mapped_size  = 0;
+	int number_of_chunks  = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
 
-	if( result == -1 )
+		return( -1 );
+	}
+	if( libfdata_list_get_number_of_elements(
+	     chunk_group->chunks_list,
+	     &number_of_chunks,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to insert checksum error in range list.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of chunks.",
 		 function );
 
 		return( -1 );
 	}
+	if( number_of_chunks <= 0 )
+	{
+		return( 1 );
+	}
+	/* Every chunk in the chunks list is mapped to a chunk size of media data
+	 */
+	if( chunk_table->chunk_size == 0 )
+	{
+		if( libfdata_list_get_mapped_size_by_index(
+		     chunk_group->chunks_list,
+		     0,
+		     &mapped_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve mapped size of chunk: %" PRIu64 ".",
+			 function,
+			 first_chunk_index );
+
+			return( -1 );
+		}
+		if( ( mapped_size == 0 )
+		 || ( mapped_size > (size64_t) UINT32_MAX ) )
+		{
+			return( 1 );
+		}
+		chunk_table->chunk_size = (uint32_t) mapped_size;
+	}
+	if( libewf_chunk_index_set_chunk_group(
+	     chunk_table->chunks_index,
+	     first_chunk_index,
+	     segment_number,
+	     chunk_group,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk group of chunk: %" PRIu64 " in chunks index.",
+		 function,
+		 first_chunk_index );
+
+		return( -1 );
+	}
 	return( 1 );
 }
 
@@ -661,12 +1236,16 @@ int libewf_chunk_table_chunk_exists_for_offset(
 	libewf_segment_file_t *segment_file         = NULL;
 	libfdata_list_element_t *chunk_list_element = NULL;
 	static char *function                       = "libewf_chunk_table_chunk_exists_for_offset";
+	size64_t range_size                         = 0;
 	off64_t chunk_data_offset                   = 0;
 	off64_t chunk_group_data_offset             = 0;
+	off64_t range_offset                        = 0;
 	off64_t segment_file_data_offset            = 0;
+	uint32_t range_flags                        = 0;
 	uint32_t segment_number                     = 0;
 	int chunk_groups_list_index                 = 0;
 	int chunks_list_index                       = 0;
+	int file_io_pool_entry                      = 0;
 	int result                                  = 0;
 
 	if( chunk_table == NULL )
@@ -680,6 +1259,44 @@ int libewf_chunk_table_chunk_exists_for_offset(
 
 		return( -1 );
 	}
+	if( chunk_table->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk table - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_table->io_handle->access_flags & LIBEWF_ACCESS_FLAG_WRITE ) == 0 )
+	{
+		result = libewf_chunk_index_get_entry(
+		          chunk_table->chunks_index,
+		          chunk_index,
+		          &segment_number,
+		          &file_io_pool_entry,
+		          &range_offset,
+		          &range_size,
+		          &range_flags,
+		          error );
+
+		if( result != 0 )
+		{
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve chunk: %" PRIu64 " from chunks index.",
+				 function,
+				 chunk_index );
+			}
+			return( result );
+		}
+	}
 	result = libewf_chunk_table_get_segment_file_chunk_group_by_offset(
 	          chunk_table,
 	          file_io_pool,
@@ -744,6 +1361,218 @@ int libewf_chunk_table_chunk_exists_for_offset(
 			return( -1 );
 		}
 	}
+	if( ( result != 0 )
+	 && ( ( chunk_table->io_handle->access_flags & LIBEWF_ACCESS_FLAG_WRITE ) == 0 )
+	 && ( (uint64_t) chunks_list_index <= chunk_index ) )
+	{
+		if( libewf_chunk_table_index_chunk_group(
+		     chunk_table,
+		     chunk_index - chunks_list_index,
+		     segment_number,
+		     chunk_group,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to index chunk group: %d in segment file: %" PRIu32 ".",
+			 function,
+			 chunk_groups_list_index,
+			 segment_number );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Retrieves the range of the packed data of a chunk at a specific offset
+ * The chunk data offset is set to the offset relative to the start of the chunk
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int libewf_chunk_table_get_chunk_range_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     off64_t offset,
+     int *file_io_pool_entry,
+     off64_t *range_offset,
+     size64_t *range_size,
+     uint32_t *range_flags,
+     off64_t *chunk_data_offset,
+     libcerror_error_t **error )
+{
+	libewf_chunk_group_t *chunk_group   = NULL;
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_chunk_table_get_chunk_range_by_offset";
+	off64_t chunk_group_data_offset     = 0;
+	off64_t segment_file_data_offset    = 0;
+	uint32_t segment_number             = 0;
+	int chunk_groups_list_index         = 0;
+	int chunks_list_index               = 0;
+	int result                          = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_table->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk table - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data offset.",
+		 function );
+
+		return( -1 );
+	}
+	/* The chunks index is only used in read-only mode, since writing
+	 * changes the chunk groups
+	 */
+	if( ( chunk_table->chunk_size != 0 )
+	 && ( ( chunk_table->io_handle->access_flags & LIBEWF_ACCESS_FLAG_WRITE ) == 0 ) )
+	{
+		result = libewf_chunk_index_get_entry(
+		          chunk_table->chunks_index,
+		          chunk_index,
+		          &segment_number,
+		          file_io_pool_entry,
+		          range_offset,
+		          range_size,
+		          range_flags,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " from chunks index.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			*chunk_data_offset = offset - (off64_t) ( chunk_index * chunk_table->chunk_size );
+
+			return( 1 );
+		}
+	}
+	result = libewf_chunk_table_get_segment_file_chunk_group_by_offset(
+		  chunk_table,
+		  file_io_pool,
+		  segment_table,
+		  chunk_groups_cache,
+		  offset,
+		  &segment_number,
+		  &segment_file_data_offset,
+		  &segment_file,
+		  &chunk_groups_list_index,
+		  &chunk_group_data_offset,
+		  &chunk_group,
+		  error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment file chunk group at 0x%08" PRIx64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	if( result != 0 )
+	{
+		if( chunk_group == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing chunk group: %d.",
+			 function,
+			 chunk_groups_list_index );
+
+			return( -1 );
+		}
+		result = libfdata_list_get_element_at_offset(
+			  chunk_group->chunks_list,
+			  chunk_group_data_offset,
+			  &chunks_list_index,
+			  chunk_data_offset,
+			  file_io_pool_entry,
+			  range_offset,
+			  range_size,
+			  range_flags,
+			  error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " range from chunk group: %d in segment file: %" PRIu32 " at 0x%08" PRIx64 ".",
+			 function,
+			 chunk_index,
+			 chunk_groups_list_index,
+			 segment_number,
+			 segment_file_data_offset );
+
+			return( -1 );
+		}
+	}
+	if( ( result != 0 )
+	 && ( ( chunk_table->io_handle->access_flags & LIBEWF_ACCESS_FLAG_WRITE ) == 0 )
+	 && ( (uint64_t) chunks_list_index <= chunk_index ) )
+	{
+		if( libewf_chunk_table_index_chunk_group(
+		     chunk_table,
+		     chunk_index - chunks_list_index,
+		     segment_number,
+		     chunk_group,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to index chunk group: %d in segment file: %" PRIu32 ".",
+			 function,
+			 chunk_groups_list_index,
+			 segment_number );
+
+			return( -1 );
+		}
+	}
 	return( result );
 }
 
@@ -771,13 +1600,18 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 	static char *function                     = "libewf_chunk_table_get_chunk_data_by_offset";
 	off64_t chunk_offset                      = 0;
 	off64_t chunk_group_data_offset           = 0;
+	off64_t element_offset                    = 0;
 	off64_t segment_file_data_offset          = 0;
+	size64_t element_size                     = 0;
 	size_t chunk_data_size                    = 0;
 	uint64_t start_sector                     = 0;
 	uint64_t number_of_sectors                = 0;
+	uint32_t element_flags                    = 0;
 	uint32_t segment_number                   = 0;
+	uint8_t is_packed                         = 0;
 	int chunk_groups_list_index               = 0;
 	int chunks_list_index                     = 0;
+	int file_io_pool_entry                    = 0;
 	int result                                = 0;
 
 	if( chunk_table == NULL )
@@ -875,17 +1709,99 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 
 			goto on_error;
 		}
-		result = libfdata_list_get_element_value_at_offset(
-			  chunk_group->chunks_list,
-			  (intptr_t *) file_io_pool,
-			  (libfdata_cache_t *) chunks_cache,
-			  chunk_group_data_offset,
-			  &chunks_list_index,
-			  chunk_data_offset,
-			  (intptr_t **) chunk_data,
-			  0,
-			  error );
+		/* A chunks cache miss is counted when the chunk data is read
+		 */
+		LIBEWF_TRACE_CHUNKS_CACHE_LOOKUP(
+		 offset );
+
+		if( io_handle->statistics != NULL )
+		{
+			if( libewf_statistics_add_cache_lookup(
+			     io_handle->statistics,
+			     LIBEWF_STATISTICS_CACHE_TYPE_CHUNKS,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to add chunks cache lookup to statistics.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		/* A chunk that previously failed to unpack is not read and unpacked again
+		 */
+		result = libewf_chunk_table_get_corrupted_chunk_data(
+		          chunk_table,
+		          chunk_index,
+		          media_values->chunk_size,
+		          &corrupted_chunk_data,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve corrupted chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
 
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			chunk_offset       = (off64_t) chunk_index * media_values->chunk_size;
+			*chunk_data_offset = offset - chunk_offset;
+
+			if( libfdata_list_cache_element_value(
+			     chunk_table->corrupted_chunks_list,
+			     (libfdata_cache_t *) chunks_cache,
+			     (int) chunk_index,
+			     (int) segment_number,
+			     chunk_offset,
+			     corrupted_chunk_data->data_size,
+			     corrupted_chunk_data->range_flags,
+			     0,
+			     (intptr_t *) corrupted_chunk_data,
+			     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_data_free,
+			     LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to cache chunk: %" PRIu64 " data in segment file: %" PRIu32 " at 0x%08" PRIx64 ".",
+				 function,
+				 chunk_index,
+				 segment_number,
+				 chunk_offset );
+
+				goto on_error;
+			}
+			*chunk_data = corrupted_chunk_data;
+
+			/* chunks_cache takes over management of chunk_data
+			 */
+			corrupted_chunk_data = NULL;
+		}
+		else
+		{
+			result = libfdata_list_get_element_value_at_offset(
+				  chunk_group->chunks_list,
+				  (intptr_t *) file_io_pool,
+				  (libfdata_cache_t *) chunks_cache,
+				  chunk_group_data_offset,
+				  &chunks_list_index,
+				  chunk_data_offset,
+				  (intptr_t **) chunk_data,
+				  0,
+				  error );
+		}
 		if( result == -1 )
 		{
 			libcerror_error_set(
@@ -916,9 +1832,22 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 
 			goto on_error;
 		}
+		/* Chunk data that was (re)read from the file IO pool is still packed
+		 */
+		if( ( ( *chunk_data )->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) != 0 )
+		{
+			chunk_table->number_of_cache_misses += 1;
+
+			is_packed = 1;
+		}
+		else
+		{
+			chunk_table->number_of_cache_hits += 1;
+		}
 		if( libewf_chunk_data_unpack(
 		     *chunk_data,
 		     io_handle,
+		     chunk_table->compression_context,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -934,6 +1863,95 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 		if( ( ( *chunk_data )->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
 		{
 			chunk_offset = offset - *chunk_data_offset;
+
+			if( is_packed != 0 )
+			{
+				if( libewf_chunk_table_set_corrupted_chunk(
+				     chunk_table,
+				     chunk_index,
+				     *chunk_data,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set corrupted chunk: %" PRIu64 ".",
+					 function,
+					 chunk_index );
+
+					goto on_error;
+				}
+			}
+		}
+		/* Chunk data that was read from the segment file and unpacked is stored
+		 * in the disk and shared chunk caches, unless it is corrupted
+		 */
+		else if( ( is_packed != 0 )
+		      && ( ( io_handle->disk_chunk_cache != NULL )
+		       || ( io_handle->shared_chunk_cache != NULL ) ) )
+		{
+			if( libfdata_list_get_element_by_index(
+			     chunk_group->chunks_list,
+			     chunks_list_index,
+			     &file_io_pool_entry,
+			     &element_offset,
+			     &element_size,
+			     &element_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve element: %d from chunks list.",
+				 function,
+				 chunks_list_index );
+
+				goto on_error;
+			}
+			if( io_handle->disk_chunk_cache != NULL )
+			{
+				if( libewf_disk_chunk_cache_write_chunk_data(
+				     io_handle->disk_chunk_cache,
+				     file_io_pool_entry,
+				     element_offset,
+				     ( *chunk_data )->data,
+				     ( *chunk_data )->data_size,
+				     error ) == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write chunk: %" PRIu64 " data to disk chunk cache.",
+					 function,
+					 chunk_index );
+
+					goto on_error;
+				}
+			}
+			if( io_handle->shared_chunk_cache != NULL )
+			{
+				if( libewf_shared_chunk_cache_write_chunk_data(
+				     io_handle->shared_chunk_cache,
+				     file_io_pool_entry,
+				     element_offset,
+				     ( *chunk_data )->data,
+				     ( *chunk_data )->data_size,
+				     error ) == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write chunk: %" PRIu64 " data to shared chunk cache.",
+					 function,
+					 chunk_index );
+
+					goto on_error;
+				}
+			}
 		}
 	}
 	else
@@ -978,6 +1996,8 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 		corrupted_chunk_data->data_size    = chunk_data_size;
 		corrupted_chunk_data->range_flags |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
 
+		chunk_table->number_of_cache_misses += 1;
+
 		if( libfdata_list_cache_element_value(
 		     chunk_table->corrupted_chunks_list,
 		     (libfdata_cache_t *) chunks_cache,
@@ -1021,13 +2041,10 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 		{
 			number_of_sectors = (uint64_t) media_values->number_of_sectors - start_sector;
 		}
-		result = libcdata_range_list_insert_range(
+		result = libewf_sector_range_list_insert_range(
 		          chunk_table->checksum_errors,
 		          start_sector,
 		          number_of_sectors,
-		          NULL,
-		          NULL,
-		          NULL,
 		          error );
 
 		if( result == -1 )
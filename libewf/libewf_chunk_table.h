@@ -26,11 +26,15 @@
 #include <types.h>
 
 #include "libewf_chunk_group.h"
+#include "libewf_chunk_index.h"
+#include "libewf_compression_context.h"
+#include "libewf_corrupted_chunks.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
 #include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
+#include "libewf_sector_range_list.h"
 #include "libewf_segment_file.h"
 #include "libewf_segment_table.h"
 
@@ -54,13 +58,33 @@ struct libewf_chunk_table
 	 */
 	uint8_t format_version;
 
+	/* The chunks index
+	 */
+	libewf_chunk_index_t *chunks_index;
+
 	/* The corrupted chunks list
 	 */
 	libfdata_list_t *corrupted_chunks_list;
 
+	/* The chunks that failed to unpack
+	 */
+	libewf_corrupted_chunks_t *corrupted_chunks;
+
 	/* The sectors with checksum errors
 	 */
-	libcdata_range_list_t *checksum_errors;
+	libewf_sector_range_list_t *checksum_errors;
+
+	/* The compression context used to (un)pack chunks while holding the handle lock
+	 */
+	libewf_compression_context_t *compression_context;
+
+	/* The number of chunks retrieved from the chunks cache
+	 */
+	uint64_t number_of_cache_hits;
+
+	/* The number of chunks that were not in the chunks cache
+	 */
+	uint64_t number_of_cache_misses;
 };
 
 int libewf_chunk_table_initialize(
@@ -95,6 +119,39 @@ int libewf_chunk_table_append_checksum_error(
      uint64_t number_of_sectors,
      libcerror_error_t **error );
 
+int libewf_chunk_table_has_checksum_error(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t start_sector,
+     uint64_t number_of_sectors,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_get_number_of_checksum_errors_in_range(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t start_sector,
+     uint64_t number_of_sectors,
+     uint32_t *number_of_errors,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_get_corrupted_chunk_data(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     size32_t chunk_size,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_set_corrupted_chunk(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_index_chunk_group(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t first_chunk_index,
+     uint32_t segment_number,
+     libewf_chunk_group_t *chunk_group,
+     libcerror_error_t **error );
+
 int libewf_chunk_table_get_segment_file_chunk_group_by_offset(
      libewf_chunk_table_t *chunk_table,
      libbfio_pool_t *file_io_pool,
@@ -118,6 +175,20 @@ int libewf_chunk_table_chunk_exists_for_offset(
      off64_t offset,
      libcerror_error_t **error );
 
+int libewf_chunk_table_get_chunk_range_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     off64_t offset,
+     int *file_io_pool_entry,
+     off64_t *range_offset,
+     size64_t *range_size,
+     uint32_t *range_flags,
+     off64_t *chunk_data_offset,
+     libcerror_error_t **error );
+
 int libewf_chunk_table_get_chunk_data_by_offset(
      libewf_chunk_table_t *chunk_table,
      uint64_t chunk_index,
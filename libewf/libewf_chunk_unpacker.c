@@ -0,0 +1,1100 @@
+/*
+ * Chunk unpacker functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_chunk_unpacker.h"
+#include "libewf_compression_context.h"
+#include "libewf_definitions.h"
+#include "libewf_io_handle.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+#include "libewf_scheduler.h"
+#include "libewf_types.h"
+
+/* Creates a chunk unpacker
+ * If a scheduler is provided the chunks are unpacked by the scheduler worker threads
+ * instead of a thread pool of the chunk unpacker
+ * Make sure the value chunk_unpacker is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_unpacker_initialize(
+     libewf_chunk_unpacker_t **chunk_unpacker,
+     libewf_io_handle_t *io_handle,
+     int number_of_threads,
+     libewf_scheduler_t *scheduler,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_unpacker_initialize";
+	int context_index     = 0;
+
+	if( chunk_unpacker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk unpacker.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_unpacker != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk unpacker value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > LIBEWF_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*chunk_unpacker = memory_allocate_structure(
+	                   libewf_chunk_unpacker_t );
+
+	if( *chunk_unpacker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk unpacker.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *chunk_unpacker,
+	     0,
+	     sizeof( libewf_chunk_unpacker_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk unpacker.",
+		 function );
+
+		memory_free(
+		 *chunk_unpacker );
+
+		*chunk_unpacker = NULL;
+
+		return( -1 );
+	}
+	( *chunk_unpacker )->io_handle                = io_handle;
+	( *chunk_unpacker )->number_of_threads        = number_of_threads;
+	( *chunk_unpacker )->maximum_number_of_chunks = number_of_threads * LIBEWF_CHUNK_UNPACKER_NUMBER_OF_CHUNKS_PER_THREAD;
+
+	if( io_handle->batch_decompression_function != NULL )
+	{
+		( *chunk_unpacker )->maximum_number_of_chunks = number_of_threads * LIBEWF_CHUNK_UNPACKER_NUMBER_OF_OFFLOADED_CHUNKS_PER_THREAD;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	( *chunk_unpacker )->scheduler                = scheduler;
+#endif
+
+	( *chunk_unpacker )->compression_contexts = (libewf_compression_context_t **) memory_allocate(
+	                                             sizeof( libewf_compression_context_t * ) * number_of_threads );
+
+	if( ( *chunk_unpacker )->compression_contexts == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create compression contexts.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *chunk_unpacker )->compression_contexts,
+	     0,
+	     sizeof( libewf_compression_context_t * ) * number_of_threads ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear compression contexts.",
+		 function );
+
+		goto on_error;
+	}
+	for( context_index = 0;
+	     context_index < number_of_threads;
+	     context_index++ )
+	{
+		if( libewf_compression_context_initialize(
+		     &( ( ( *chunk_unpacker )->compression_contexts )[ context_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create compression context: %d.",
+			 function,
+			 context_index );
+
+			goto on_error;
+		}
+	}
+	( *chunk_unpacker )->number_of_free_compression_contexts = number_of_threads;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *chunk_unpacker )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *chunk_unpacker )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( scheduler == NULL )
+	{
+		if( libcthreads_thread_pool_create(
+		     &( ( *chunk_unpacker )->thread_pool ),
+		     NULL,
+		     number_of_threads,
+		     ( *chunk_unpacker )->maximum_number_of_chunks,
+		     (int (*)(intptr_t *, void *)) &libewf_chunk_unpacker_unpack_callback,
+		     (void *) *chunk_unpacker,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *chunk_unpacker != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *chunk_unpacker )->condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *chunk_unpacker )->condition ),
+			 NULL );
+		}
+		if( ( *chunk_unpacker )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *chunk_unpacker )->mutex ),
+			 NULL );
+		}
+#endif
+		if( ( *chunk_unpacker )->compression_contexts != NULL )
+		{
+			for( context_index = 0;
+			     context_index < number_of_threads;
+			     context_index++ )
+			{
+				libewf_compression_context_free(
+				 &( ( ( *chunk_unpacker )->compression_contexts )[ context_index ] ),
+				 NULL );
+			}
+			memory_free(
+			 ( *chunk_unpacker )->compression_contexts );
+		}
+		memory_free(
+		 *chunk_unpacker );
+
+		*chunk_unpacker = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a chunk unpacker
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_unpacker_free(
+     libewf_chunk_unpacker_t **chunk_unpacker,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_unpacker_free";
+	int context_index     = 0;
+	int result            = 1;
+
+	if( chunk_unpacker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk unpacker.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_unpacker != NULL )
+	{
+		/* The io_handle and scheduler references are freed elsewhere
+		 */
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *chunk_unpacker )->thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *chunk_unpacker )->thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_condition_free(
+		     &( ( *chunk_unpacker )->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *chunk_unpacker )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		if( ( *chunk_unpacker )->compression_contexts != NULL )
+		{
+			for( context_index = 0;
+			     context_index < ( *chunk_unpacker )->number_of_threads;
+			     context_index++ )
+			{
+				if( libewf_compression_context_free(
+				     &( ( ( *chunk_unpacker )->compression_contexts )[ context_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free compression context: %d.",
+					 function,
+					 context_index );
+
+					result = -1;
+				}
+			}
+			memory_free(
+			 ( *chunk_unpacker )->compression_contexts );
+		}
+		memory_free(
+		 *chunk_unpacker );
+
+		*chunk_unpacker = NULL;
+	}
+	return( result );
+}
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Unpacks chunk data
+ * Callback function for the thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_unpacker_unpack_callback(
+     libewf_chunk_data_t *chunk_data,
+     libewf_chunk_unpacker_t *chunk_unpacker )
+{
+	libewf_compression_context_t *compression_context = NULL;
+	libcerror_error_t *error                          = NULL;
+	static char *function                             = "libewf_chunk_unpacker_unpack_callback";
+	int result                                        = 0;
+
+	if( chunk_unpacker == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk unpacker.",
+		 function );
+
+		goto on_error;
+	}
+	/* Take a compression context for the duration of the unpack
+	 */
+	if( libcthreads_mutex_grab(
+	     chunk_unpacker->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( chunk_unpacker->number_of_free_compression_contexts > 0 )
+	{
+		chunk_unpacker->number_of_free_compression_contexts -= 1;
+
+		compression_context = chunk_unpacker->compression_contexts[ chunk_unpacker->number_of_free_compression_contexts ];
+	}
+	if( libcthreads_mutex_release(
+	     chunk_unpacker->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	result = libewf_chunk_data_unpack(
+	          chunk_data,
+	          chunk_unpacker->io_handle,
+	          compression_context,
+	          &error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to unpack chunk data.",
+		 function );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( libcthreads_mutex_grab(
+	     chunk_unpacker->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( compression_context != NULL )
+	{
+		chunk_unpacker->compression_contexts[ chunk_unpacker->number_of_free_compression_contexts ] = compression_context;
+
+		chunk_unpacker->number_of_free_compression_contexts += 1;
+	}
+	if( result != 1 )
+	{
+		chunk_unpacker->number_of_failed_chunks += 1;
+	}
+	chunk_unpacker->number_of_pending_chunks -= 1;
+
+	if( chunk_unpacker->number_of_pending_chunks == 0 )
+	{
+		if( libcthreads_condition_broadcast(
+		     chunk_unpacker->condition,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 chunk_unpacker->mutex,
+			 NULL );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     chunk_unpacker->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+	}
+#endif
+	libcerror_error_free(
+	 &error );
+
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* Decompresses a batch of chunk data using the batch decompression function
+ * Only deflate compressed chunks that are not encrypted or pattern filled are offered
+ * to the function, chunks it did not decompress remain packed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_unpacker_decompress_batch(
+     libewf_chunk_unpacker_t *chunk_unpacker,
+     libewf_chunk_data_t **chunk_data,
+     int number_of_chunks,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t **batch_chunk_data = NULL;
+	const uint8_t **compressed_data        = NULL;
+	uint8_t **data                         = NULL;
+	size_t *compressed_data_sizes          = NULL;
+	size_t *data_sizes                     = NULL;
+	size_t *packed_allocated_data_sizes    = NULL;
+	static char *function                  = "libewf_chunk_unpacker_decompress_batch";
+	int batch_index                        = 0;
+	int chunk_data_index                   = 0;
+	int number_of_allocated_chunks         = 0;
+	int number_of_batch_chunks             = 0;
+	int result                             = 0;
+
+	if( chunk_unpacker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk unpacker.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_unpacker->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk unpacker - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_unpacker->io_handle->batch_decompression_function == NULL )
+	 || ( chunk_unpacker->io_handle->compression_method != LIBEWF_COMPRESSION_METHOD_DEFLATE ) )
+	{
+		return( 1 );
+	}
+	for( chunk_data_index = 0;
+	     chunk_data_index < number_of_chunks;
+	     chunk_data_index++ )
+	{
+		if( ( chunk_data[ chunk_data_index ] != NULL )
+		 && ( ( chunk_data[ chunk_data_index ]->range_flags & ( LIBEWF_RANGE_FLAG_IS_PACKED | LIBEWF_RANGE_FLAG_IS_COMPRESSED | LIBEWF_RANGE_FLAG_USES_PATTERN_FILL | LIBEWF_RANGE_FLAG_IS_ENCRYPTED ) ) == ( LIBEWF_RANGE_FLAG_IS_PACKED | LIBEWF_RANGE_FLAG_IS_COMPRESSED ) ) )
+		{
+			number_of_batch_chunks += 1;
+		}
+	}
+	if( number_of_batch_chunks == 0 )
+	{
+		return( 1 );
+	}
+	batch_chunk_data = (libewf_chunk_data_t **) memory_allocate(
+	                                             sizeof( libewf_chunk_data_t * ) * number_of_batch_chunks );
+
+	compressed_data = (const uint8_t **) memory_allocate(
+	                                      sizeof( const uint8_t * ) * number_of_batch_chunks );
+
+	data = (uint8_t **) memory_allocate(
+	                     sizeof( uint8_t * ) * number_of_batch_chunks );
+
+	compressed_data_sizes = (size_t *) memory_allocate(
+	                                    sizeof( size_t ) * number_of_batch_chunks );
+
+	data_sizes = (size_t *) memory_allocate(
+	                         sizeof( size_t ) * number_of_batch_chunks );
+
+	packed_allocated_data_sizes = (size_t *) memory_allocate(
+	                                          sizeof( size_t ) * number_of_batch_chunks );
+
+	if( ( batch_chunk_data == NULL )
+	 || ( compressed_data == NULL )
+	 || ( data == NULL )
+	 || ( compressed_data_sizes == NULL )
+	 || ( data_sizes == NULL )
+	 || ( packed_allocated_data_sizes == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create batch arrays.",
+		 function );
+
+		goto on_error;
+	}
+	for( chunk_data_index = 0;
+	     chunk_data_index < number_of_chunks;
+	     chunk_data_index++ )
+	{
+		if( ( chunk_data[ chunk_data_index ] == NULL )
+		 || ( ( chunk_data[ chunk_data_index ]->range_flags & ( LIBEWF_RANGE_FLAG_IS_PACKED | LIBEWF_RANGE_FLAG_IS_COMPRESSED | LIBEWF_RANGE_FLAG_USES_PATTERN_FILL | LIBEWF_RANGE_FLAG_IS_ENCRYPTED ) ) != ( LIBEWF_RANGE_FLAG_IS_PACKED | LIBEWF_RANGE_FLAG_IS_COMPRESSED ) ) )
+		{
+			continue;
+		}
+		batch_index = number_of_allocated_chunks;
+
+		batch_chunk_data[ batch_index ]            = chunk_data[ chunk_data_index ];
+		packed_allocated_data_sizes[ batch_index ] = chunk_data[ chunk_data_index ]->allocated_data_size;
+
+		if( libewf_chunk_data_allocate_decompressed_data(
+		     chunk_data[ chunk_data_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to allocate decompressed data of chunk data: %d.",
+			 function,
+			 chunk_data_index );
+
+			goto on_error;
+		}
+		number_of_allocated_chunks += 1;
+
+		if( memory_set(
+		     chunk_data[ chunk_data_index ]->data,
+		     0,
+		     sizeof( uint8_t ) * chunk_data[ chunk_data_index ]->allocated_data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear data of chunk data: %d.",
+			 function,
+			 chunk_data_index );
+
+			goto on_error;
+		}
+		compressed_data[ batch_index ]       = chunk_data[ chunk_data_index ]->compressed_data;
+		compressed_data_sizes[ batch_index ] = chunk_data[ chunk_data_index ]->compressed_data_size;
+		data[ batch_index ]                  = chunk_data[ chunk_data_index ]->data;
+		data_sizes[ batch_index ]            = chunk_data[ chunk_data_index ]->data_size;
+	}
+	result = chunk_unpacker->io_handle->batch_decompression_function(
+	          number_of_batch_chunks,
+	          compressed_data,
+	          compressed_data_sizes,
+	          data,
+	          data_sizes,
+	          chunk_unpacker->io_handle->batch_decompression_function_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+		 "%s: unable to decompress batch of: %d chunks.",
+		 function,
+		 number_of_batch_chunks );
+
+		goto on_error;
+	}
+	for( batch_index = 0;
+	     batch_index < number_of_batch_chunks;
+	     batch_index++ )
+	{
+		/* Chunks that were not decompressed are decompressed by the worker threads
+		 */
+		if( ( result == 0 )
+		 || ( data_sizes[ batch_index ] == 0 )
+		 || ( data_sizes[ batch_index ] > (size_t) batch_chunk_data[ batch_index ]->chunk_size ) )
+		{
+			if( libewf_chunk_data_free_decompressed_data(
+			     batch_chunk_data[ batch_index ],
+			     packed_allocated_data_sizes[ batch_index ],
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free decompressed data of batch chunk data: %d.",
+				 function,
+				 batch_index );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			batch_chunk_data[ batch_index ]->data_size     = data_sizes[ batch_index ];
+			batch_chunk_data[ batch_index ]->unpack_status = LIBEWF_CHUNK_DATA_UNPACK_STATUS_OK;
+			batch_chunk_data[ batch_index ]->range_flags  &= ~( LIBEWF_RANGE_FLAG_IS_PACKED );
+		}
+	}
+	memory_free(
+	 packed_allocated_data_sizes );
+	memory_free(
+	 data_sizes );
+	memory_free(
+	 compressed_data_sizes );
+	memory_free(
+	 data );
+	memory_free(
+	 compressed_data );
+	memory_free(
+	 batch_chunk_data );
+
+	return( 1 );
+
+on_error:
+	/* Revert the chunk data that is still packed
+	 */
+	for( batch_index = 0;
+	     batch_index < number_of_allocated_chunks;
+	     batch_index++ )
+	{
+		if( ( ( batch_chunk_data[ batch_index ]->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) != 0 )
+		 && ( batch_chunk_data[ batch_index ]->compressed_data != NULL ) )
+		{
+			libewf_chunk_data_free_decompressed_data(
+			 batch_chunk_data[ batch_index ],
+			 packed_allocated_data_sizes[ batch_index ],
+			 NULL );
+		}
+	}
+	if( packed_allocated_data_sizes != NULL )
+	{
+		memory_free(
+		 packed_allocated_data_sizes );
+	}
+	if( data_sizes != NULL )
+	{
+		memory_free(
+		 data_sizes );
+	}
+	if( compressed_data_sizes != NULL )
+	{
+		memory_free(
+		 compressed_data_sizes );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	if( compressed_data != NULL )
+	{
+		memory_free(
+		 compressed_data );
+	}
+	if( batch_chunk_data != NULL )
+	{
+		memory_free(
+		 batch_chunk_data );
+	}
+	return( -1 );
+}
+
+/* Unpacks a batch of chunk data
+ * Entries that are NULL or no longer packed are skipped
+ * The chunks are unpacked by the scheduler with the priority of the read
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_unpacker_unpack(
+     libewf_chunk_unpacker_t *chunk_unpacker,
+     libewf_chunk_data_t **chunk_data,
+     int number_of_chunks,
+     int priority,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_unpacker_unpack";
+	int chunk_data_index  = 0;
+	int result            = 1;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	int push_result       = 0;
+#endif
+
+	if( chunk_unpacker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk unpacker.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_chunks < 0 )
+	 || ( number_of_chunks > chunk_unpacker->maximum_number_of_chunks ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of chunks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( priority != LIBEWF_READ_PRIORITY_INTERACTIVE )
+	 && ( priority != LIBEWF_READ_PRIORITY_BACKGROUND ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported priority.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_unpacker_decompress_batch(
+	     chunk_unpacker,
+	     chunk_data,
+	     number_of_chunks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+		 "%s: unable to decompress batch of chunk data.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_unpacker->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_unpacker->number_of_pending_chunks = 0;
+	chunk_unpacker->number_of_failed_chunks  = 0;
+
+	for( chunk_data_index = 0;
+	     chunk_data_index < number_of_chunks;
+	     chunk_data_index++ )
+	{
+		if( ( chunk_data[ chunk_data_index ] != NULL )
+		 && ( ( chunk_data[ chunk_data_index ]->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) != 0 ) )
+		{
+			chunk_unpacker->number_of_pending_chunks += 1;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     chunk_unpacker->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	for( chunk_data_index = 0;
+	     chunk_data_index < number_of_chunks;
+	     chunk_data_index++ )
+	{
+		if( ( chunk_data[ chunk_data_index ] == NULL )
+		 || ( ( chunk_data[ chunk_data_index ]->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) == 0 ) )
+		{
+			continue;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( chunk_unpacker->scheduler != NULL )
+		{
+			push_result = libewf_scheduler_push_task(
+			               chunk_unpacker->scheduler,
+			               (int (*)(intptr_t *, void *)) &libewf_chunk_unpacker_unpack_callback,
+			               (intptr_t *) chunk_data[ chunk_data_index ],
+			               (void *) chunk_unpacker,
+			               &( chunk_unpacker->number_of_scheduled_chunks ),
+			               priority,
+			               error );
+		}
+		else
+		{
+			push_result = libcthreads_thread_pool_push(
+			               chunk_unpacker->thread_pool,
+			               (intptr_t *) chunk_data[ chunk_data_index ],
+			               error );
+		}
+		if( push_result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push chunk data: %d onto thread pool queue.",
+			 function,
+			 chunk_data_index );
+
+			/* Do not wait for the chunks that were not pushed
+			 */
+			libcthreads_mutex_grab(
+			 chunk_unpacker->mutex,
+			 NULL );
+
+			chunk_unpacker->number_of_pending_chunks -= 1;
+			chunk_unpacker->number_of_failed_chunks  += 1;
+
+			libcthreads_mutex_release(
+			 chunk_unpacker->mutex,
+			 NULL );
+
+			result = -1;
+		}
+#else
+		if( libewf_chunk_data_unpack(
+		     chunk_data[ chunk_data_index ],
+		     chunk_unpacker->io_handle,
+		     chunk_unpacker->compression_contexts[ 0 ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to unpack chunk data: %d.",
+			 function,
+			 chunk_data_index );
+
+			return( -1 );
+		}
+#endif
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* Run the queued scheduler tasks on this thread while waiting, since the scheduler
+	 * worker threads can be busy with tasks of other handles
+	 */
+	if( chunk_unpacker->scheduler != NULL )
+	{
+		if( libewf_scheduler_wait_for_tasks(
+		     chunk_unpacker->scheduler,
+		     &( chunk_unpacker->number_of_scheduled_chunks ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to wait for scheduler tasks.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* Wait for the worker threads to unpack the batch
+	 */
+	if( libcthreads_mutex_grab(
+	     chunk_unpacker->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( chunk_unpacker->number_of_pending_chunks > 0 )
+	{
+		if( libcthreads_condition_wait(
+		     chunk_unpacker->condition,
+		     chunk_unpacker->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+	}
+	if( ( result == 1 )
+	 && ( chunk_unpacker->number_of_failed_chunks > 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to unpack %d chunk(s).",
+		 function,
+		 chunk_unpacker->number_of_failed_chunks );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     chunk_unpacker->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
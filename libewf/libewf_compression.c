@@ -34,16 +34,30 @@
 #include <zlib.h>
 #endif
 
+#if defined( HAVE_LIBDEFLATE )
+#include <libdeflate.h>
+#endif
+
+#if defined( HAVE_ZSTD )
+#include <zstd.h>
+#include <zstd_errors.h>
+#endif
+
 #include "libewf_compression.h"
+#include "libewf_compression_context.h"
 #include "libewf_definitions.h"
 #include "libewf_deflate.h"
 #include "libewf_libcerror.h"
 #include "libewf_libcnotify.h"
+#include "libewf_parallel_deflate.h"
 
 /* Compresses data using the compression method
+ * If a compression context is provided its deflate stream or zstd context is reused
+ * and large data is deflated on the number of deflate threads of the context
  * Returns 1 on success, 0 if buffer is too small or -1 on error
  */
 int libewf_compress_data(
+     libewf_compression_context_t *compression_context,
      uint8_t *compressed_data,
      size_t *compressed_data_size,
      uint16_t compression_method,
@@ -52,16 +66,21 @@ int libewf_compress_data(
      size_t uncompressed_data_size,
      libcerror_error_t **error )
 {
-	static char *function                   = "libewf_compress_data";
-	int result                              = 0;
+	static char *function                                  = "libewf_compress_data";
+	int result                                             = 0;
 
 #if defined( HAVE_LIBBZ2 ) || defined( BZIP2_DLL )
-	unsigned int bzip2_compressed_data_size = 0;
-	int bzip2_compression_level             = 0;
+	unsigned int bzip2_compressed_data_size                = 0;
+	int bzip2_compression_level                            = 0;
 #endif
 #if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
-	uLongf zlib_compressed_data_size        = 0;
-	int zlib_compression_level              = 0;
+	uLongf zlib_compressed_data_size                       = 0;
+	int number_of_threads                                  = 0;
+	int zlib_compression_level                             = 0;
+#endif
+#if defined( HAVE_ZSTD )
+	libewf_compression_context_t *zstd_compression_context = NULL;
+	int zstd_compression_level                             = 0;
 #endif
 
 	if( compressed_data == NULL )
@@ -160,6 +179,55 @@ int libewf_compress_data(
 
 			return( -1 );
 		}
+		/* Data larger than the sub-block size is deflated in independent sub-blocks
+		 * if the context requests it, so that it can be decompressed by sub-block
+		 */
+		if( ( compression_context != NULL )
+		 && ( compression_context->sub_block_size > 0 )
+		 && ( uncompressed_data_size > (size_t) compression_context->sub_block_size ) )
+		{
+			number_of_threads = compression_context->number_of_deflate_threads;
+
+			if( number_of_threads < 1 )
+			{
+				number_of_threads = 1;
+			}
+			return( libewf_parallel_deflate_compress_sub_blocks(
+			         compressed_data,
+			         compressed_data_size,
+			         zlib_compression_level,
+			         uncompressed_data,
+			         uncompressed_data_size,
+			         compression_context->sub_block_size,
+			         number_of_threads,
+			         error ) );
+		}
+		/* Large data is deflated in segments on multiple threads if the context allows it
+		 */
+		if( ( compression_context != NULL )
+		 && ( compression_context->number_of_deflate_threads > 1 )
+		 && ( uncompressed_data_size >= ( 2 * LIBEWF_PARALLEL_DEFLATE_MINIMUM_SEGMENT_SIZE ) ) )
+		{
+			return( libewf_parallel_deflate_compress(
+			         compressed_data,
+			         compressed_data_size,
+			         zlib_compression_level,
+			         uncompressed_data,
+			         uncompressed_data_size,
+			         compression_context->number_of_deflate_threads,
+			         error ) );
+		}
+		if( compression_context != NULL )
+		{
+			return( libewf_compression_context_deflate(
+			         compression_context,
+			         compressed_data,
+			         compressed_data_size,
+			         zlib_compression_level,
+			         uncompressed_data,
+			         uncompressed_data_size,
+			         error ) );
+		}
 		zlib_compressed_data_size = (uLongf) *compressed_data_size;
 
 		result = compress2(
@@ -350,6 +418,95 @@ int libewf_compress_data(
 
 		return( -1 );
 #endif /* defined( HAVE_LIBBZ2 ) || defined( BZIP2_DLL ) */
+	}
+	else if( compression_method == LIBEWF_COMPRESSION_METHOD_ZSTD )
+	{
+#if defined( HAVE_ZSTD )
+		/* The low zstd levels already compress better than deflate
+		 * at a fraction of the processing time
+		 */
+		if( compression_level == LIBEWF_COMPRESSION_DEFAULT )
+		{
+			zstd_compression_level = 3;
+		}
+		else if( compression_level == LIBEWF_COMPRESSION_FAST )
+		{
+			zstd_compression_level = 1;
+		}
+		else if( compression_level == LIBEWF_COMPRESSION_BEST )
+		{
+			zstd_compression_level = 19;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported compression level.",
+			 function );
+
+			return( -1 );
+		}
+		if( compression_context != NULL )
+		{
+			return( libewf_compression_context_zstd_compress(
+			         compression_context,
+			         compressed_data,
+			         compressed_data_size,
+			         zstd_compression_level,
+			         uncompressed_data,
+			         uncompressed_data_size,
+			         error ) );
+		}
+		/* Use a temporary compression context so the zstd frame
+		 * parameters are the same as those of the chunk packer
+		 */
+		if( libewf_compression_context_initialize(
+		     &zstd_compression_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create zstd compression context.",
+			 function );
+
+			return( -1 );
+		}
+		result = libewf_compression_context_zstd_compress(
+		          zstd_compression_context,
+		          compressed_data,
+		          compressed_data_size,
+		          zstd_compression_level,
+		          uncompressed_data,
+		          uncompressed_data_size,
+		          error );
+
+		if( libewf_compression_context_free(
+		     &zstd_compression_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free zstd compression context.",
+			 function );
+
+			return( -1 );
+		}
+#else
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: missing support for zstd compression.",
+		 function );
+
+		return( -1 );
+#endif /* defined( HAVE_ZSTD ) */
 	}
 	else
 	{
@@ -365,13 +522,345 @@ int libewf_compress_data(
 	return( result );
 }
 
+/* Determines if a decompression backend is supported
+ * Returns 1 if supported, 0 if not or -1 on error
+ */
+int libewf_decompression_backend_is_supported(
+     int decompression_backend,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_decompression_backend_is_supported";
+
+	switch( decompression_backend )
+	{
+		case LIBEWF_DECOMPRESSION_BACKEND_DEFAULT:
+		case LIBEWF_DECOMPRESSION_BACKEND_BUILT_IN:
+			return( 1 );
+
+		case LIBEWF_DECOMPRESSION_BACKEND_ZLIB:
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
+			return( 1 );
+#else
+			return( 0 );
+#endif
+
+		case LIBEWF_DECOMPRESSION_BACKEND_LIBDEFLATE:
+#if defined( HAVE_LIBDEFLATE )
+			return( 1 );
+#else
+			return( 0 );
+#endif
+
+		default:
+			break;
+	}
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+	 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+	 "%s: unsupported decompression backend.",
+	 function );
+
+	return( -1 );
+}
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
+
+/* Decompresses deflate compressed data using zlib
+ * Returns 1 on success, 0 on failure or -1 on error
+ */
+int libewf_decompress_zlib_data(
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_data_size,
+     libcerror_error_t **error )
+{
+	static char *function              = "libewf_decompress_zlib_data";
+	uLongf zlib_uncompressed_data_size = 0;
+	int result                         = 0;
+
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data_size > (size_t) ULONG_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid compressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( *uncompressed_data_size > (size_t) ULONG_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid uncompressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	zlib_uncompressed_data_size = (uLongf) *uncompressed_data_size;
+
+	result = uncompress(
+		  (Bytef *) uncompressed_data,
+		  &zlib_uncompressed_data_size,
+		  (Bytef *) compressed_data,
+		  (uLong) compressed_data_size );
+
+	if( result == Z_OK )
+	{
+		*uncompressed_data_size = (size_t) zlib_uncompressed_data_size;
+
+		result = 1;
+	}
+	else if( result == Z_DATA_ERROR )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: unable to read compressed data: data error.\n",
+			 function );
+		}
+#endif
+		*uncompressed_data_size = 0;
+
+		result = -1;
+	}
+	else if( result == Z_BUF_ERROR )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			"%s: unable to read compressed data: target buffer too small.\n",
+			 function );
+		}
+#endif
+		/* Estimate that a factor 2 enlargement should suffice
+		 */
+		*uncompressed_data_size *= 2;
+
+		result = 0;
+	}
+	else if( result == Z_MEM_ERROR )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to read compressed data: insufficient memory.",
+		 function );
+
+		*uncompressed_data_size = 0;
+
+		result = -1;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+		 "%s: zlib returned undefined error: %d.",
+		 function,
+		 result );
+
+		*uncompressed_data_size = 0;
+
+		result = -1;
+	}
+	return( result );
+}
+
+#endif /* ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL ) */
+
+#if defined( HAVE_LIBDEFLATE )
+
+/* Decompresses deflate compressed data using libdeflate
+ * Since the uncompressed data size is known the data is decompressed in
+ * a single call without the set up of a streaming state
+ * Returns 1 on success, 0 on failure or -1 on error
+ */
+int libewf_decompress_libdeflate_data(
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_data_size,
+     libcerror_error_t **error )
+{
+	struct libdeflate_decompressor *decompressor = NULL;
+	static char *function                        = "libewf_decompress_libdeflate_data";
+	size_t libdeflate_uncompressed_data_size     = 0;
+	enum libdeflate_result libdeflate_result     = LIBDEFLATE_SUCCESS;
+	int result                                   = 0;
+
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data size.",
+		 function );
+
+		return( -1 );
+	}
+	/* A decompressor is not thread-safe and is allocated per call
+	 * since multiple chunks can be decompressed concurrently
+	 */
+	decompressor = libdeflate_alloc_decompressor();
+
+	if( decompressor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create decompressor.",
+		 function );
+
+		*uncompressed_data_size = 0;
+
+		return( -1 );
+	}
+	libdeflate_result = libdeflate_zlib_decompress(
+	                     decompressor,
+	                     (const void *) compressed_data,
+	                     compressed_data_size,
+	                     (void *) uncompressed_data,
+	                     *uncompressed_data_size,
+	                     &libdeflate_uncompressed_data_size );
+
+	libdeflate_free_decompressor(
+	 decompressor );
+
+	if( libdeflate_result == LIBDEFLATE_SUCCESS )
+	{
+		*uncompressed_data_size = libdeflate_uncompressed_data_size;
+
+		result = 1;
+	}
+	else if( libdeflate_result == LIBDEFLATE_BAD_DATA )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: unable to read compressed data: data error.\n",
+			 function );
+		}
+#endif
+		*uncompressed_data_size = 0;
+
+		result = -1;
+	}
+	else if( libdeflate_result == LIBDEFLATE_INSUFFICIENT_SPACE )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			"%s: unable to read compressed data: target buffer too small.\n",
+			 function );
+		}
+#endif
+		/* Estimate that a factor 2 enlargement should suffice
+		 */
+		*uncompressed_data_size *= 2;
+
+		result = 0;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+		 "%s: libdeflate returned undefined error: %d.",
+		 function,
+		 (int) libdeflate_result );
+
+		*uncompressed_data_size = 0;
+
+		result = -1;
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBDEFLATE ) */
+
 /* Decompresses data using the compression method
+ * The decompression backend is only used for deflate compressed data
+ * If a compression context is provided the zlib backend reuses its inflate stream,
+ * zstd decompression reuses its zstd context and data that the context indicates
+ * contains a sub-block index is inflated on the number of deflate threads of the context
  * Returns 1 on success, 0 on failure or -1 on error
  */
 int libewf_decompress_data(
+     libewf_compression_context_t *compression_context,
      const uint8_t *compressed_data,
      size_t compressed_data_size,
      uint16_t compression_method,
+     int decompression_backend,
      uint8_t *uncompressed_data,
      size_t *uncompressed_data_size,
      libcerror_error_t **error )
@@ -382,8 +871,8 @@ int libewf_decompress_data(
 #if defined( HAVE_LIBBZ2 ) || defined( BZIP2_DLL )
 	unsigned int bzip2_uncompressed_data_size = 0;
 #endif
-#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
-	uLongf zlib_uncompressed_data_size        = 0;
+#if defined( HAVE_ZSTD )
+	size_t zstd_result                        = 0;
 #endif
 
 	if( compressed_data == NULL )
@@ -432,8 +921,117 @@ int libewf_decompress_data(
 	}
 	if( compression_method == LIBEWF_COMPRESSION_METHOD_DEFLATE )
 	{
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) && defined( HAVE_ZLIB_INFLATE ) ) || defined( ZLIB_DLL )
+		/* Data that was deflated in independent sub-blocks is inflated on multiple threads
+		 * if the context allows it, otherwise the decompression backend is used
+		 */
+		if( ( compression_context != NULL )
+		 && ( compression_context->has_sub_block_index != 0 )
+		 && ( compression_context->number_of_deflate_threads > 1 ) )
+		{
+			result = libewf_parallel_deflate_decompress(
+			          compressed_data,
+			          compressed_data_size,
+			          uncompressed_data,
+			          uncompressed_data_size,
+			          compression_context->number_of_deflate_threads,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+				 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+				 "%s: unable to decompress deflate compressed sub-blocks.",
+				 function );
+
+				return( -1 );
+			}
+			else if( result != 0 )
+			{
+				return( 1 );
+			}
+		}
+#endif
+		if( decompression_backend == LIBEWF_DECOMPRESSION_BACKEND_DEFAULT )
+		{
+			decompression_backend = LIBEWF_DEFAULT_DECOMPRESSION_BACKEND;
+		}
+		switch( decompression_backend )
+		{
+			case LIBEWF_DECOMPRESSION_BACKEND_BUILT_IN:
+				result = libewf_deflate_decompress(
+				          compressed_data,
+				          compressed_data_size,
+				          uncompressed_data,
+				          uncompressed_data_size,
+				          error );
+
+				if( result != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+					 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+					 "%s: unable to decompress deflate compressed data.",
+					 function );
+
+					return( -1 );
+				}
+				break;
+
 #if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
-		if( compressed_data_size > (size_t) ULONG_MAX )
+			case LIBEWF_DECOMPRESSION_BACKEND_ZLIB:
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_INFLATE ) ) || defined( ZLIB_DLL )
+				if( compression_context != NULL )
+				{
+					result = libewf_compression_context_inflate(
+					          compression_context,
+					          compressed_data,
+					          compressed_data_size,
+					          uncompressed_data,
+					          uncompressed_data_size,
+					          error );
+					break;
+				}
+#endif
+				result = libewf_decompress_zlib_data(
+				          compressed_data,
+				          compressed_data_size,
+				          uncompressed_data,
+				          uncompressed_data_size,
+				          error );
+				break;
+#endif
+
+#if defined( HAVE_LIBDEFLATE )
+			case LIBEWF_DECOMPRESSION_BACKEND_LIBDEFLATE:
+				result = libewf_decompress_libdeflate_data(
+				          compressed_data,
+				          compressed_data_size,
+				          uncompressed_data,
+				          uncompressed_data_size,
+				          error );
+				break;
+#endif
+
+			default:
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+				 "%s: missing support for decompression backend: %d.",
+				 function,
+				 decompression_backend );
+
+				return( -1 );
+		}
+	}
+	else if( compression_method == LIBEWF_COMPRESSION_METHOD_BZIP2 )
+	{
+#if defined( HAVE_LIBBZ2 ) || defined( BZIP2_DLL )
+		if( compressed_data_size > (size_t) UINT_MAX )
 		{
 			libcerror_error_set(
 			 error,
@@ -444,7 +1042,7 @@ int libewf_decompress_data(
 
 			return( -1 );
 		}
-		if( *uncompressed_data_size > (size_t) ULONG_MAX )
+		if( *uncompressed_data_size > (size_t) UINT_MAX )
 		{
 			libcerror_error_set(
 			 error,
@@ -455,21 +1053,24 @@ int libewf_decompress_data(
 
 			return( -1 );
 		}
-		zlib_uncompressed_data_size = (uLongf) *uncompressed_data_size;
+		bzip2_uncompressed_data_size = (unsigned int) *uncompressed_data_size;
 
-		result = uncompress(
-			  (Bytef *) uncompressed_data,
-			  &zlib_uncompressed_data_size,
-			  (Bytef *) compressed_data,
-			  (uLong) compressed_data_size );
+		result = BZ2_bzBuffToBuffDecompress(
+			  (char *) uncompressed_data,
+			  &bzip2_uncompressed_data_size,
+			  (char *) compressed_data,
+			  (unsigned int) compressed_data_size,
+			  0,
+			  0 );
 
-		if( result == Z_OK )
+		if( result == BZ_OK )
 		{
-			*uncompressed_data_size = (size_t) zlib_uncompressed_data_size;
+			*uncompressed_data_size = (size_t) bzip2_uncompressed_data_size;
 
 			result = 1;
 		}
-		else if( result == Z_DATA_ERROR )
+		else if( ( result == BZ_DATA_ERROR )
+		      || ( result == BZ_DATA_ERROR_MAGIC ) )
 		{
 #if defined( HAVE_DEBUG_OUTPUT )
 			if( libcnotify_verbose != 0 )
@@ -483,7 +1084,7 @@ int libewf_decompress_data(
 
 			result = -1;
 		}
-		else if( result == Z_BUF_ERROR )
+		else if( result == BZ_OUTBUFF_FULL )
 		{
 #if defined( HAVE_DEBUG_OUTPUT )
 			if( libcnotify_verbose != 0 )
@@ -499,7 +1100,7 @@ int libewf_decompress_data(
 
 			result = 0;
 		}
-		else if( result == Z_MEM_ERROR )
+		else if( result == BZ_MEM_ERROR )
 		{
 			libcerror_error_set(
 			 error,
@@ -518,7 +1119,7 @@ int libewf_decompress_data(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
 			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
-			 "%s: zlib returned undefined error: %d.",
+			 "%s: libbz2 returned undefined error: %d.",
 			 function,
 			 result );
 
@@ -527,83 +1128,42 @@ int libewf_decompress_data(
 			result = -1;
 		}
 #else
-		result = libewf_deflate_decompress(
-		          compressed_data,
-		          compressed_data_size,
-		          uncompressed_data,
-		          uncompressed_data_size,
-		          error );
-
-		if( result != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
-			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
-			 "%s: unable to decompress deflate compressed data.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: missing support for bzip2 compression.",
+		 function );
 
-			return( -1 );
-		}
-#endif /* ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL ) */
+		return( -1 );
+#endif /* defined( HAVE_LIBBZ2 ) || defined( BZIP2_DLL ) */
 	}
-	else if( compression_method == LIBEWF_COMPRESSION_METHOD_BZIP2 )
+	else if( compression_method == LIBEWF_COMPRESSION_METHOD_ZSTD )
 	{
-#if defined( HAVE_LIBBZ2 ) || defined( BZIP2_DLL )
-		if( compressed_data_size > (size_t) UINT_MAX )
+#if defined( HAVE_ZSTD )
+		if( compression_context != NULL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-			 "%s: invalid compressed data size value exceeds maximum.",
-			 function );
-
-			return( -1 );
+			return( libewf_compression_context_zstd_decompress(
+			         compression_context,
+			         compressed_data,
+			         compressed_data_size,
+			         uncompressed_data,
+			         uncompressed_data_size,
+			         error ) );
 		}
-		if( *uncompressed_data_size > (size_t) UINT_MAX )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-			 "%s: invalid uncompressed data size value exceeds maximum.",
-			 function );
+		zstd_result = ZSTD_decompress(
+		               (void *) uncompressed_data,
+		               *uncompressed_data_size,
+		               (const void *) compressed_data,
+		               compressed_data_size );
 
-			return( -1 );
-		}
-		bzip2_uncompressed_data_size = (unsigned int) *uncompressed_data_size;
-
-		result = BZ2_bzBuffToBuffDecompress(
-			  (char *) uncompressed_data,
-			  &bzip2_uncompressed_data_size,
-			  (char *) compressed_data,
-			  (unsigned int) compressed_data_size,
-			  0,
-			  0 );
-
-		if( result == BZ_OK )
+		if( ZSTD_isError( zstd_result ) == 0 )
 		{
-			*uncompressed_data_size = (size_t) bzip2_uncompressed_data_size;
+			*uncompressed_data_size = zstd_result;
 
 			result = 1;
 		}
-		else if( ( result == BZ_DATA_ERROR )
-		      || ( result == BZ_DATA_ERROR_MAGIC ) )
-		{
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-				 "%s: unable to read compressed data: data error.\n",
-				 function );
-			}
-#endif
-			*uncompressed_data_size = 0;
-
-			result = -1;
-		}
-		else if( result == BZ_OUTBUFF_FULL )
+		else if( ZSTD_getErrorCode( zstd_result ) == ZSTD_error_dstSize_tooSmall )
 		{
 #if defined( HAVE_DEBUG_OUTPUT )
 			if( libcnotify_verbose != 0 )
@@ -619,7 +1179,7 @@ int libewf_decompress_data(
 
 			result = 0;
 		}
-		else if( result == BZ_MEM_ERROR )
+		else if( ZSTD_getErrorCode( zstd_result ) == ZSTD_error_memory_allocation )
 		{
 			libcerror_error_set(
 			 error,
@@ -634,14 +1194,15 @@ int libewf_decompress_data(
 		}
 		else
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
-			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
-			 "%s: libbz2 returned undefined error: %d.",
-			 function,
-			 result );
-
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: unable to read compressed data: %s.\n",
+				 function,
+				 ZSTD_getErrorName( zstd_result ) );
+			}
+#endif
 			*uncompressed_data_size = 0;
 
 			result = -1;
@@ -651,11 +1212,11 @@ int libewf_decompress_data(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-		 "%s: missing support for bzip2 compression.",
+		 "%s: missing support for zstd compression.",
 		 function );
 
 		return( -1 );
-#endif /* defined( HAVE_LIBBZ2 ) || defined( BZIP2_DLL ) */
+#endif /* defined( HAVE_ZSTD ) */
 	}
 	else
 	{
@@ -25,13 +25,30 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_compression_context.h"
+#include "libewf_definitions.h"
 #include "libewf_libcerror.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+/* The decompression backend used when none is set
+ * prefers libdeflate, then zlib, then the built-in implementation
+ */
+#if defined( HAVE_LIBDEFLATE )
+#define LIBEWF_DEFAULT_DECOMPRESSION_BACKEND	LIBEWF_DECOMPRESSION_BACKEND_LIBDEFLATE
+
+#elif ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
+#define LIBEWF_DEFAULT_DECOMPRESSION_BACKEND	LIBEWF_DECOMPRESSION_BACKEND_ZLIB
+
+#else
+#define LIBEWF_DEFAULT_DECOMPRESSION_BACKEND	LIBEWF_DECOMPRESSION_BACKEND_BUILT_IN
+
+#endif
+
 int libewf_compress_data(
+     libewf_compression_context_t *compression_context,
      uint8_t *compressed_data,
      size_t *compressed_data_size,
      uint16_t compression_method,
@@ -40,10 +57,38 @@ int libewf_compress_data(
      size_t uncompressed_data_size,
      libcerror_error_t **error );
 
+int libewf_decompression_backend_is_supported(
+     int decompression_backend,
+     libcerror_error_t **error );
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
+
+int libewf_decompress_zlib_data(
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_data_size,
+     libcerror_error_t **error );
+
+#endif
+
+#if defined( HAVE_LIBDEFLATE )
+
+int libewf_decompress_libdeflate_data(
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_data_size,
+     libcerror_error_t **error );
+
+#endif
+
 int libewf_decompress_data(
+     libewf_compression_context_t *compression_context,
      const uint8_t *compressed_data,
      size_t compressed_data_size,
      uint16_t compression_method,
+     int decompression_backend,
      uint8_t *uncompressed_data,
      size_t *uncompressed_data_size,
      libcerror_error_t **error );
@@ -0,0 +1,1152 @@
+/*
+ * Compression context functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+#include <zlib.h>
+#endif
+
+#if defined( HAVE_ZSTD )
+#include <zstd.h>
+#include <zstd_errors.h>
+#endif
+
+#include "libewf_compression_context.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+
+/* Creates a compression context
+ * Make sure the value compression_context is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_context_initialize(
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_initialize";
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_context != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid compression context value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*compression_context = memory_allocate_structure(
+	                        libewf_compression_context_t );
+
+	if( *compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create compression context.",
+		 function );
+
+		goto on_error;
+	}
+	/* The zlib streams and zstd contexts are initialized on first use
+	 */
+	if( memory_set(
+	     *compression_context,
+	     0,
+	     sizeof( libewf_compression_context_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear compression context.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *compression_context != NULL )
+	{
+		memory_free(
+		 *compression_context );
+
+		*compression_context = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a compression context
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_context_free(
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_free";
+	int packed_fill_index = 0;
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_context != NULL )
+	{
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+		if( ( *compression_context )->deflate_stream_initialized != 0 )
+		{
+			/* deflateEnd returns Z_DATA_ERROR if the stream was freed prematurely,
+			 * which is expected after a failed deflate and not considered an error
+			 */
+			deflateEnd(
+			 &( ( *compression_context )->deflate_stream ) );
+		}
+#endif
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_INFLATE ) ) || defined( ZLIB_DLL )
+		if( ( *compression_context )->inflate_stream_initialized != 0 )
+		{
+			inflateEnd(
+			 &( ( *compression_context )->inflate_stream ) );
+		}
+#endif
+#if defined( HAVE_ZSTD )
+		if( ( *compression_context )->zstd_compression_context != NULL )
+		{
+			ZSTD_freeCCtx(
+			 ( *compression_context )->zstd_compression_context );
+		}
+		if( ( *compression_context )->zstd_decompression_context != NULL )
+		{
+			ZSTD_freeDCtx(
+			 ( *compression_context )->zstd_decompression_context );
+		}
+#endif
+		for( packed_fill_index = 0;
+		     packed_fill_index < LIBEWF_COMPRESSION_CONTEXT_NUMBER_OF_PACKED_FILLS;
+		     packed_fill_index++ )
+		{
+			if( ( *compression_context )->packed_fills[ packed_fill_index ].compressed_data != NULL )
+			{
+				memory_free(
+				 ( *compression_context )->packed_fills[ packed_fill_index ].compressed_data );
+			}
+		}
+		memory_free(
+		 *compression_context );
+
+		*compression_context = NULL;
+	}
+	return( 1 );
+}
+
+/* Retrieves the packed representation of a chunk filled with a 64-bit pattern
+ * The packed fill must match the fill pattern, data size, compression method and level
+ * and the sub-block size and number of deflate threads of the compression context
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libewf_compression_context_get_packed_fill(
+     libewf_compression_context_t *compression_context,
+     uint64_t fill_pattern,
+     size_t data_size,
+     uint16_t compression_method,
+     int8_t compression_level,
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     uint32_t *checksum,
+     libcerror_error_t **error )
+{
+	libewf_compression_context_packed_fill_t *packed_fill = NULL;
+	static char *function                                 = "libewf_compression_context_get_packed_fill";
+	int packed_fill_index                                 = 0;
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( checksum == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checksum.",
+		 function );
+
+		return( -1 );
+	}
+	for( packed_fill_index = 0;
+	     packed_fill_index < LIBEWF_COMPRESSION_CONTEXT_NUMBER_OF_PACKED_FILLS;
+	     packed_fill_index++ )
+	{
+		packed_fill = &( compression_context->packed_fills[ packed_fill_index ] );
+
+		if( ( packed_fill->last_used != 0 )
+		 && ( packed_fill->fill_pattern == fill_pattern )
+		 && ( packed_fill->data_size == data_size )
+		 && ( packed_fill->compression_method == compression_method )
+		 && ( packed_fill->compression_level == compression_level )
+		 && ( packed_fill->sub_block_size == compression_context->sub_block_size )
+		 && ( packed_fill->number_of_deflate_threads == compression_context->number_of_deflate_threads ) )
+		{
+			break;
+		}
+	}
+	if( packed_fill_index >= LIBEWF_COMPRESSION_CONTEXT_NUMBER_OF_PACKED_FILLS )
+	{
+		return( 0 );
+	}
+	if( packed_fill->compressed_data_size > *compressed_data_size )
+	{
+		return( 0 );
+	}
+	if( memory_copy(
+	     compressed_data,
+	     packed_fill->compressed_data,
+	     packed_fill->compressed_data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy packed fill compressed data.",
+		 function );
+
+		return( -1 );
+	}
+	*compressed_data_size = packed_fill->compressed_data_size;
+	*checksum             = packed_fill->checksum;
+
+	compression_context->packed_fills_usage_counter += 1;
+
+	packed_fill->last_used = compression_context->packed_fills_usage_counter;
+
+	return( 1 );
+}
+
+/* Sets the packed representation of a chunk filled with a 64-bit pattern
+ * The least recently used packed fill is replaced
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_context_set_packed_fill(
+     libewf_compression_context_t *compression_context,
+     uint64_t fill_pattern,
+     size_t data_size,
+     uint16_t compression_method,
+     int8_t compression_level,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint32_t checksum,
+     libcerror_error_t **error )
+{
+	libewf_compression_context_packed_fill_t *packed_fill = NULL;
+	static char *function                                 = "libewf_compression_context_set_packed_fill";
+	int packed_fill_index                                 = 0;
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( compressed_data_size == 0 )
+	 || ( compressed_data_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid compressed data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* Reset the usage counters before they wrap around
+	 */
+	if( compression_context->packed_fills_usage_counter == (uint32_t) UINT32_MAX )
+	{
+		for( packed_fill_index = 0;
+		     packed_fill_index < LIBEWF_COMPRESSION_CONTEXT_NUMBER_OF_PACKED_FILLS;
+		     packed_fill_index++ )
+		{
+			if( compression_context->packed_fills[ packed_fill_index ].last_used != 0 )
+			{
+				compression_context->packed_fills[ packed_fill_index ].last_used = 1;
+			}
+		}
+		compression_context->packed_fills_usage_counter = 1;
+	}
+	packed_fill = &( compression_context->packed_fills[ 0 ] );
+
+	for( packed_fill_index = 1;
+	     packed_fill_index < LIBEWF_COMPRESSION_CONTEXT_NUMBER_OF_PACKED_FILLS;
+	     packed_fill_index++ )
+	{
+		if( compression_context->packed_fills[ packed_fill_index ].last_used < packed_fill->last_used )
+		{
+			packed_fill = &( compression_context->packed_fills[ packed_fill_index ] );
+		}
+	}
+	if( packed_fill->compressed_data_size < compressed_data_size )
+	{
+		if( packed_fill->compressed_data != NULL )
+		{
+			memory_free(
+			 packed_fill->compressed_data );
+		}
+		packed_fill->compressed_data      = NULL;
+		packed_fill->compressed_data_size = 0;
+		packed_fill->last_used            = 0;
+
+		packed_fill->compressed_data = (uint8_t *) memory_allocate(
+		                                            sizeof( uint8_t ) * compressed_data_size );
+
+		if( packed_fill->compressed_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create packed fill compressed data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( memory_copy(
+	     packed_fill->compressed_data,
+	     compressed_data,
+	     compressed_data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy compressed data to packed fill.",
+		 function );
+
+		packed_fill->last_used = 0;
+
+		return( -1 );
+	}
+	packed_fill->fill_pattern              = fill_pattern;
+	packed_fill->data_size                 = data_size;
+	packed_fill->compression_method        = compression_method;
+	packed_fill->compression_level         = compression_level;
+	packed_fill->sub_block_size            = compression_context->sub_block_size;
+	packed_fill->number_of_deflate_threads = compression_context->number_of_deflate_threads;
+	packed_fill->compressed_data_size      = compressed_data_size;
+	packed_fill->checksum                  = checksum;
+
+	compression_context->packed_fills_usage_counter += 1;
+
+	packed_fill->last_used = compression_context->packed_fills_usage_counter;
+
+	return( 1 );
+}
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+
+/* Compresses data using the deflate stream of the compression context
+ * The output is identical to that of compress2
+ * Returns 1 on success, 0 if buffer is too small or -1 on error
+ */
+int libewf_compression_context_deflate(
+     libewf_compression_context_t *compression_context,
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     int zlib_compression_level,
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_deflate";
+	int result            = 0;
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compressed_data_size > (size_t) UINT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid compressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data_size > (size_t) UINT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid uncompressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( compression_context->deflate_stream_initialized != 0 )
+	 && ( compression_context->deflate_compression_level != zlib_compression_level ) )
+	{
+		deflateEnd(
+		 &( compression_context->deflate_stream ) );
+
+		compression_context->deflate_stream_initialized = 0;
+	}
+	if( compression_context->deflate_stream_initialized == 0 )
+	{
+		if( memory_set(
+		     &( compression_context->deflate_stream ),
+		     0,
+		     sizeof( z_stream ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear deflate stream.",
+			 function );
+
+			return( -1 );
+		}
+		result = deflateInit(
+		          &( compression_context->deflate_stream ),
+		          zlib_compression_level );
+
+		if( result != Z_OK )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize deflate stream with error: %d.",
+			 function,
+			 result );
+
+			return( -1 );
+		}
+		compression_context->deflate_compression_level  = zlib_compression_level;
+		compression_context->deflate_stream_initialized = 1;
+	}
+	else
+	{
+		result = deflateReset(
+		          &( compression_context->deflate_stream ) );
+
+		if( result != Z_OK )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to reset deflate stream with error: %d.",
+			 function,
+			 result );
+
+			return( -1 );
+		}
+	}
+	compression_context->deflate_stream.next_in   = (Bytef *) uncompressed_data;
+	compression_context->deflate_stream.avail_in  = (uInt) uncompressed_data_size;
+	compression_context->deflate_stream.next_out  = (Bytef *) compressed_data;
+	compression_context->deflate_stream.avail_out = (uInt) *compressed_data_size;
+
+	result = deflate(
+	          &( compression_context->deflate_stream ),
+	          Z_FINISH );
+
+	if( result == Z_STREAM_END )
+	{
+		*compressed_data_size = (size_t) compression_context->deflate_stream.total_out;
+
+		result = 1;
+	}
+	else if( ( result == Z_OK )
+	      || ( result == Z_BUF_ERROR ) )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: unable to write compressed data: target buffer too small.\n",
+			 function );
+		}
+#endif
+#if defined( HAVE_COMPRESS_BOUND ) || defined( WINAPI )
+		/* Use compressBound to determine the size of the uncompressed buffer
+		 */
+		*compressed_data_size = (size_t) compressBound( (uLong) uncompressed_data_size );
+#else
+		/* Estimate that a factor 2 enlargement should suffice
+		 */
+		*compressed_data_size *= 2;
+#endif
+		result = 0;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+		 "%s: zlib returned undefined error: %d.",
+		 function,
+		 result );
+
+		*compressed_data_size = 0;
+
+		result = -1;
+	}
+	return( result );
+}
+
+#endif /* ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL ) */
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_INFLATE ) ) || defined( ZLIB_DLL )
+
+/* Decompresses data using the inflate stream of the compression context
+ * Returns 1 on success, 0 if buffer is too small or -1 on error
+ */
+int libewf_compression_context_inflate(
+     libewf_compression_context_t *compression_context,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_inflate";
+	int result            = 0;
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data_size > (size_t) UINT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid compressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( *uncompressed_data_size > (size_t) UINT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid uncompressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_context->inflate_stream_initialized == 0 )
+	{
+		if( memory_set(
+		     &( compression_context->inflate_stream ),
+		     0,
+		     sizeof( z_stream ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear inflate stream.",
+			 function );
+
+			return( -1 );
+		}
+		result = inflateInit(
+		          &( compression_context->inflate_stream ) );
+
+		if( result != Z_OK )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize inflate stream with error: %d.",
+			 function,
+			 result );
+
+			return( -1 );
+		}
+		compression_context->inflate_stream_initialized = 1;
+	}
+	else
+	{
+		result = inflateReset(
+		          &( compression_context->inflate_stream ) );
+
+		if( result != Z_OK )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to reset inflate stream with error: %d.",
+			 function,
+			 result );
+
+			return( -1 );
+		}
+	}
+	compression_context->inflate_stream.next_in   = (Bytef *) compressed_data;
+	compression_context->inflate_stream.avail_in  = (uInt) compressed_data_size;
+	compression_context->inflate_stream.next_out  = (Bytef *) uncompressed_data;
+	compression_context->inflate_stream.avail_out = (uInt) *uncompressed_data_size;
+
+	result = inflate(
+	          &( compression_context->inflate_stream ),
+	          Z_FINISH );
+
+	if( result == Z_STREAM_END )
+	{
+		*uncompressed_data_size = (size_t) compression_context->inflate_stream.total_out;
+
+		result = 1;
+	}
+	else if( ( ( result == Z_OK )
+	       || ( result == Z_BUF_ERROR ) )
+	      && ( compression_context->inflate_stream.avail_out == 0 ) )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			"%s: unable to read compressed data: target buffer too small.\n",
+			 function );
+		}
+#endif
+		/* Estimate that a factor 2 enlargement should suffice
+		 */
+		*uncompressed_data_size *= 2;
+
+		result = 0;
+	}
+	else if( ( result == Z_OK )
+	      || ( result == Z_BUF_ERROR )
+	      || ( result == Z_DATA_ERROR )
+	      || ( result == Z_NEED_DICT ) )
+	{
+		/* Z_OK or Z_BUF_ERROR with remaining output space means the input is truncated
+		 */
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: unable to read compressed data: data error.\n",
+			 function );
+		}
+#endif
+		*uncompressed_data_size = 0;
+
+		result = -1;
+	}
+	else if( result == Z_MEM_ERROR )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to read compressed data: insufficient memory.",
+		 function );
+
+		*uncompressed_data_size = 0;
+
+		result = -1;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+		 "%s: zlib returned undefined error: %d.",
+		 function,
+		 result );
+
+		*uncompressed_data_size = 0;
+
+		result = -1;
+	}
+	return( result );
+}
+
+#endif /* ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_INFLATE ) ) || defined( ZLIB_DLL ) */
+
+#if defined( HAVE_ZSTD )
+
+/* Compresses data using the zstd compression context
+ * Returns 1 on success, 0 if buffer is too small or -1 on error
+ */
+int libewf_compression_context_zstd_compress(
+     libewf_compression_context_t *compression_context,
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     int zstd_compression_level,
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_zstd_compress";
+	size_t result         = 0;
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_context->zstd_compression_context == NULL )
+	{
+		compression_context->zstd_compression_context = ZSTD_createCCtx();
+
+		if( compression_context->zstd_compression_context == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create zstd compression context.",
+			 function );
+
+			return( -1 );
+		}
+		/* Store the content checksum in the frame since compressed EWF2 chunks
+		 * do not have a separate checksum
+		 */
+		result = ZSTD_CCtx_setParameter(
+		          compression_context->zstd_compression_context,
+		          ZSTD_c_checksumFlag,
+		          1 );
+
+		if( ZSTD_isError( result ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set zstd checksum flag with error: %s.",
+			 function,
+			 ZSTD_getErrorName( result ) );
+
+			return( -1 );
+		}
+	}
+	result = ZSTD_CCtx_setParameter(
+	          compression_context->zstd_compression_context,
+	          ZSTD_c_compressionLevel,
+	          zstd_compression_level );
+
+	if( ZSTD_isError( result ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set zstd compression level with error: %s.",
+		 function,
+		 ZSTD_getErrorName( result ) );
+
+		return( -1 );
+	}
+	/* ZSTD_compress2 resets the session but retains the parameters
+	 */
+	result = ZSTD_compress2(
+	          compression_context->zstd_compression_context,
+	          (void *) compressed_data,
+	          *compressed_data_size,
+	          (const void *) uncompressed_data,
+	          uncompressed_data_size );
+
+	if( ZSTD_isError( result ) == 0 )
+	{
+		*compressed_data_size = result;
+
+		return( 1 );
+	}
+	else if( ZSTD_getErrorCode( result ) == ZSTD_error_dstSize_tooSmall )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: unable to write compressed data: target buffer too small.\n",
+			 function );
+		}
+#endif
+		*compressed_data_size = ZSTD_compressBound(
+		                         uncompressed_data_size );
+
+		return( 0 );
+	}
+	else if( ZSTD_getErrorCode( result ) == ZSTD_error_memory_allocation )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to write compressed data: insufficient memory.",
+		 function );
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+		 "%s: zstd returned error: %s.",
+		 function,
+		 ZSTD_getErrorName( result ) );
+	}
+	*compressed_data_size = 0;
+
+	return( -1 );
+}
+
+/* Decompresses data using the zstd decompression context
+ * Returns 1 on success, 0 if buffer is too small or -1 on error
+ */
+int libewf_compression_context_zstd_decompress(
+     libewf_compression_context_t *compression_context,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_zstd_decompress";
+	size_t result         = 0;
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_context->zstd_decompression_context == NULL )
+	{
+		compression_context->zstd_decompression_context = ZSTD_createDCtx();
+
+		if( compression_context->zstd_decompression_context == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create zstd decompression context.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	result = ZSTD_decompressDCtx(
+	          compression_context->zstd_decompression_context,
+	          (void *) uncompressed_data,
+	          *uncompressed_data_size,
+	          (const void *) compressed_data,
+	          compressed_data_size );
+
+	if( ZSTD_isError( result ) == 0 )
+	{
+		*uncompressed_data_size = result;
+
+		return( 1 );
+	}
+	else if( ZSTD_getErrorCode( result ) == ZSTD_error_dstSize_tooSmall )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			"%s: unable to read compressed data: target buffer too small.\n",
+			 function );
+		}
+#endif
+		/* Estimate that a factor 2 enlargement should suffice
+		 */
+		*uncompressed_data_size *= 2;
+
+		return( 0 );
+	}
+	else if( ZSTD_getErrorCode( result ) == ZSTD_error_memory_allocation )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to read compressed data: insufficient memory.",
+		 function );
+	}
+	else
+	{
+		/* This includes a content checksum mismatch
+		 */
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: unable to read compressed data: %s.\n",
+			 function,
+			 ZSTD_getErrorName( result ) );
+		}
+#endif
+	}
+	*uncompressed_data_size = 0;
+
+	return( -1 );
+}
+
+#endif /* defined( HAVE_ZSTD ) */
+
@@ -0,0 +1,255 @@
+/*
+ * Compression context functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_COMPRESSION_CONTEXT_H )
+#define _LIBEWF_COMPRESSION_CONTEXT_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+#include <zlib.h>
+#endif
+
+#if defined( HAVE_ZSTD )
+#include <zstd.h>
+#endif
+
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The number of packed fill chunks retained by a compression context
+ */
+#define LIBEWF_COMPRESSION_CONTEXT_NUMBER_OF_PACKED_FILLS	4
+
+typedef struct libewf_compression_context_packed_fill libewf_compression_context_packed_fill_t;
+
+/* The packed (compressed) representation of a chunk that is filled with a 64-bit pattern
+ */
+struct libewf_compression_context_packed_fill
+{
+	/* The 64-bit fill pattern
+	 */
+	uint64_t fill_pattern;
+
+	/* The size of the uncompressed data
+	 */
+	size_t data_size;
+
+	/* The compression method
+	 */
+	uint16_t compression_method;
+
+	/* The compression level
+	 */
+	int8_t compression_level;
+
+	/* The sub-block size
+	 */
+	size32_t sub_block_size;
+
+	/* The number of deflate threads
+	 */
+	int number_of_deflate_threads;
+
+	/* The compressed data
+	 */
+	uint8_t *compressed_data;
+
+	/* The size of the compressed data
+	 */
+	size_t compressed_data_size;
+
+	/* The checksum
+	 */
+	uint32_t checksum;
+
+	/* The value of the usage counter when the packed fill was last used
+	 * 0 represents the packed fill is not set
+	 */
+	uint32_t last_used;
+};
+
+typedef struct libewf_compression_context libewf_compression_context_t;
+
+/* The compression context retains the zlib stream and zstd context states
+ * between (de)compression calls so that they are reset instead of being
+ * allocated and freed for every chunk
+ * It also tracks runs of incompressible chunks for the adaptive compression
+ * The packed representation of recently seen fill pattern chunks is retained
+ * so that runs of identical (e.g. empty or erased) chunks are compressed once
+ * A compression context must not be used by multiple threads at the same time
+ */
+struct libewf_compression_context
+{
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+	/* The deflate stream
+	 */
+	z_stream deflate_stream;
+#endif
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_INFLATE ) ) || defined( ZLIB_DLL )
+	/* The inflate stream
+	 */
+	z_stream inflate_stream;
+#endif
+
+#if defined( HAVE_ZSTD )
+	/* The zstd compression context
+	 */
+	ZSTD_CCtx *zstd_compression_context;
+
+	/* The zstd decompression context
+	 */
+	ZSTD_DCtx *zstd_decompression_context;
+#endif
+
+	/* The (zlib) compression level the deflate stream was initialized with
+	 */
+	int deflate_compression_level;
+
+	/* The number of threads used to deflate large data in segments
+	 * and to inflate data that was deflated in sub-blocks
+	 * 0 or 1 represents the data is (de)compressed by the calling thread only
+	 */
+	int number_of_deflate_threads;
+
+	/* The size of the sub-blocks large data is deflated in
+	 * 0 represents the data is not deflated in sub-blocks
+	 */
+	size32_t sub_block_size;
+
+	/* Value to indicate the data to decompress contains a sub-block index
+	 */
+	uint8_t has_sub_block_index;
+
+	/* Value to indicate the deflate stream was initialized
+	 */
+	uint8_t deflate_stream_initialized;
+
+	/* Value to indicate the inflate stream was initialized
+	 */
+	uint8_t inflate_stream_initialized;
+
+	/* The number of consecutive incompressible chunks
+	 * used by the adaptive compression
+	 */
+	uint32_t number_of_incompressible_chunks;
+
+	/* The number of chunks that were stored without attempting compression
+	 * since the last probe, used by the adaptive compression
+	 */
+	uint32_t number_of_skipped_chunks;
+
+	/* The packed fills
+	 */
+	libewf_compression_context_packed_fill_t packed_fills[ LIBEWF_COMPRESSION_CONTEXT_NUMBER_OF_PACKED_FILLS ];
+
+	/* The packed fills usage counter
+	 */
+	uint32_t packed_fills_usage_counter;
+};
+
+int libewf_compression_context_initialize(
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error );
+
+int libewf_compression_context_free(
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error );
+
+int libewf_compression_context_get_packed_fill(
+     libewf_compression_context_t *compression_context,
+     uint64_t fill_pattern,
+     size_t data_size,
+     uint16_t compression_method,
+     int8_t compression_level,
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     uint32_t *checksum,
+     libcerror_error_t **error );
+
+int libewf_compression_context_set_packed_fill(
+     libewf_compression_context_t *compression_context,
+     uint64_t fill_pattern,
+     size_t data_size,
+     uint16_t compression_method,
+     int8_t compression_level,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint32_t checksum,
+     libcerror_error_t **error );
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+
+int libewf_compression_context_deflate(
+     libewf_compression_context_t *compression_context,
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     int zlib_compression_level,
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     libcerror_error_t **error );
+
+#endif
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_INFLATE ) ) || defined( ZLIB_DLL )
+
+int libewf_compression_context_inflate(
+     libewf_compression_context_t *compression_context,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_data_size,
+     libcerror_error_t **error );
+
+#endif
+
+#if defined( HAVE_ZSTD )
+
+int libewf_compression_context_zstd_compress(
+     libewf_compression_context_t *compression_context,
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     int zstd_compression_level,
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     libcerror_error_t **error );
+
+int libewf_compression_context_zstd_decompress(
+     libewf_compression_context_t *compression_context,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_data_size,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_ZSTD ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_COMPRESSION_CONTEXT_H ) */
+
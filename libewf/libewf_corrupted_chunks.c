@@ -0,0 +1,536 @@
+/*
+ * Corrupted chunks functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_corrupted_chunks.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+
+/* Creates corrupted chunks
+ * Make sure the value corrupted_chunks is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_corrupted_chunks_initialize(
+     libewf_corrupted_chunks_t **corrupted_chunks,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_corrupted_chunks_initialize";
+
+	if( corrupted_chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid corrupted chunks.",
+		 function );
+
+		return( -1 );
+	}
+	if( *corrupted_chunks != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid corrupted chunks value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*corrupted_chunks = memory_allocate_structure(
+	                     libewf_corrupted_chunks_t );
+
+	if( *corrupted_chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create corrupted chunks.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *corrupted_chunks,
+	     0,
+	     sizeof( libewf_corrupted_chunks_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear corrupted chunks.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *corrupted_chunks != NULL )
+	{
+		memory_free(
+		 *corrupted_chunks );
+
+		*corrupted_chunks = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees corrupted chunks
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_corrupted_chunks_free(
+     libewf_corrupted_chunks_t **corrupted_chunks,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_corrupted_chunks_free";
+	int entry_index       = 0;
+	int result            = 1;
+
+	if( corrupted_chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid corrupted chunks.",
+		 function );
+
+		return( -1 );
+	}
+	if( *corrupted_chunks != NULL )
+	{
+		if( ( *corrupted_chunks )->entries != NULL )
+		{
+			for( entry_index = 0;
+			     entry_index < ( *corrupted_chunks )->number_of_entries;
+			     entry_index++ )
+			{
+				if( ( *corrupted_chunks )->entries[ entry_index ].chunk_data == NULL )
+				{
+					continue;
+				}
+				if( libewf_chunk_data_free(
+				     &( ( *corrupted_chunks )->entries[ entry_index ].chunk_data ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free chunk: %" PRIu64 " data.",
+					 function,
+					 ( *corrupted_chunks )->entries[ entry_index ].chunk_index );
+
+					result = -1;
+				}
+			}
+			memory_free(
+			 ( *corrupted_chunks )->entries );
+		}
+		memory_free(
+		 *corrupted_chunks );
+
+		*corrupted_chunks = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves the index of the entry of a specific chunk
+ * If no entry contains the chunk the entry index is set to the index
+ * where the entry of the chunk is to be inserted
+ * Returns 1 if successful, 0 if no entry contains the chunk or -1 on error
+ */
+int libewf_corrupted_chunks_get_entry_index(
+     libewf_corrupted_chunks_t *corrupted_chunks,
+     uint64_t chunk_index,
+     int *entry_index,
+     libcerror_error_t **error )
+{
+	static char *function   = "libewf_corrupted_chunks_get_entry_index";
+	int maximum_entry_index = 0;
+	int middle_entry_index  = 0;
+	int minimum_entry_index = 0;
+
+	if( corrupted_chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid corrupted chunks.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry index.",
+		 function );
+
+		return( -1 );
+	}
+	minimum_entry_index = 0;
+	maximum_entry_index = corrupted_chunks->number_of_entries;
+
+	while( minimum_entry_index < maximum_entry_index )
+	{
+		middle_entry_index = minimum_entry_index + ( ( maximum_entry_index - minimum_entry_index ) / 2 );
+
+		if( corrupted_chunks->entries[ middle_entry_index ].chunk_index < chunk_index )
+		{
+			minimum_entry_index = middle_entry_index + 1;
+		}
+		else
+		{
+			maximum_entry_index = middle_entry_index;
+		}
+	}
+	*entry_index = minimum_entry_index;
+
+	if( ( minimum_entry_index < corrupted_chunks->number_of_entries )
+	 && ( corrupted_chunks->entries[ minimum_entry_index ].chunk_index == chunk_index ) )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Retrieves the number of corrupted chunks
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_corrupted_chunks_get_number_of_chunks(
+     libewf_corrupted_chunks_t *corrupted_chunks,
+     int *number_of_chunks,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_corrupted_chunks_get_number_of_chunks";
+
+	if( corrupted_chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid corrupted chunks.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of chunks.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_chunks = corrupted_chunks->number_of_entries;
+
+	return( 1 );
+}
+
+/* Retrieves a specific corrupted chunk
+ * The chunk data is set to the retained unpacked chunk data or NULL if not retained
+ * The corrupted chunks keep managing the retained chunk data
+ * Returns 1 if successful, 0 if the chunk is not corrupted or -1 on error
+ */
+int libewf_corrupted_chunks_get_chunk(
+     libewf_corrupted_chunks_t *corrupted_chunks,
+     uint64_t chunk_index,
+     size_t *data_size,
+     uint32_t *range_flags,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_corrupted_chunks_get_chunk";
+	int entry_index       = 0;
+	int result            = 0;
+
+	if( corrupted_chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid corrupted chunks.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_corrupted_chunks_get_entry_index(
+	          corrupted_chunks,
+	          chunk_index,
+	          &entry_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry index of chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		*data_size   = corrupted_chunks->entries[ entry_index ].data_size;
+		*range_flags = corrupted_chunks->entries[ entry_index ].range_flags;
+		*chunk_data  = corrupted_chunks->entries[ entry_index ].chunk_data;
+	}
+	return( result );
+}
+
+/* Sets a specific chunk as corrupted
+ * The chunk data should contain the unpacked data of the chunk
+ * If retain chunk data is set a copy of the chunk data is retained, as long as
+ * less than LIBEWF_CORRUPTED_CHUNKS_MAXIMUM_NUMBER_OF_RETAINED_CHUNK_DATA are retained
+ * Returns 1 if successful, 0 if the chunk was already set or -1 on error
+ */
+int libewf_corrupted_chunks_set_chunk(
+     libewf_corrupted_chunks_t *corrupted_chunks,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     uint8_t retain_chunk_data,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *retained_chunk_data = NULL;
+	libewf_corrupted_chunk_t *entries        = NULL;
+	static char *function                    = "libewf_corrupted_chunks_set_chunk";
+	size_t entries_size                      = 0;
+	int entry_index                          = 0;
+	int move_entry_index                     = 0;
+	int number_of_allocated_entries          = 0;
+	int result                               = 0;
+
+	if( corrupted_chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid corrupted chunks.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid chunk data - data is packed.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_corrupted_chunks_get_entry_index(
+	          corrupted_chunks,
+	          chunk_index,
+	          &entry_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry index of chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	if( ( retain_chunk_data != 0 )
+	 && ( corrupted_chunks->number_of_retained_chunk_data < LIBEWF_CORRUPTED_CHUNKS_MAXIMUM_NUMBER_OF_RETAINED_CHUNK_DATA )
+	 && ( ( result == 0 )
+	  || ( corrupted_chunks->entries[ entry_index ].chunk_data == NULL ) ) )
+	{
+		if( libewf_chunk_data_clone(
+		     &retained_chunk_data,
+		     chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to clone chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+	}
+	if( result != 0 )
+	{
+		if( retained_chunk_data != NULL )
+		{
+			corrupted_chunks->entries[ entry_index ].chunk_data = retained_chunk_data;
+			corrupted_chunks->number_of_retained_chunk_data    += 1;
+		}
+		return( 0 );
+	}
+	if( corrupted_chunks->number_of_entries >= corrupted_chunks->number_of_allocated_entries )
+	{
+		if( corrupted_chunks->number_of_allocated_entries > ( INT_MAX / 2 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of allocated entries value exceeds maximum.",
+			 function );
+
+			goto on_error;
+		}
+		number_of_allocated_entries = corrupted_chunks->number_of_allocated_entries * 2;
+
+		if( number_of_allocated_entries < LIBEWF_CORRUPTED_CHUNKS_MINIMUM_NUMBER_OF_ENTRIES )
+		{
+			number_of_allocated_entries = LIBEWF_CORRUPTED_CHUNKS_MINIMUM_NUMBER_OF_ENTRIES;
+		}
+#if SIZEOF_SIZE_T <= 4
+		if( (size_t) number_of_allocated_entries > ( (size_t) SSIZE_MAX / sizeof( libewf_corrupted_chunk_t ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of allocated entries value exceeds maximum.",
+			 function );
+
+			goto on_error;
+		}
+#endif
+		entries_size = sizeof( libewf_corrupted_chunk_t ) * number_of_allocated_entries;
+
+		entries = (libewf_corrupted_chunk_t *) memory_reallocate(
+		                                        corrupted_chunks->entries,
+		                                        entries_size );
+
+		if( entries == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize entries.",
+			 function );
+
+			goto on_error;
+		}
+		corrupted_chunks->entries                     = entries;
+		corrupted_chunks->number_of_allocated_entries = number_of_allocated_entries;
+	}
+	for( move_entry_index = corrupted_chunks->number_of_entries;
+	     move_entry_index > entry_index;
+	     move_entry_index-- )
+	{
+		corrupted_chunks->entries[ move_entry_index ] = corrupted_chunks->entries[ move_entry_index - 1 ];
+	}
+	corrupted_chunks->entries[ entry_index ].chunk_index = chunk_index;
+	corrupted_chunks->entries[ entry_index ].data_size   = chunk_data->data_size;
+	corrupted_chunks->entries[ entry_index ].range_flags = chunk_data->range_flags;
+	corrupted_chunks->entries[ entry_index ].chunk_data  = retained_chunk_data;
+
+	corrupted_chunks->number_of_entries += 1;
+
+	if( retained_chunk_data != NULL )
+	{
+		corrupted_chunks->number_of_retained_chunk_data += 1;
+	}
+	return( 1 );
+
+on_error:
+	if( retained_chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &retained_chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
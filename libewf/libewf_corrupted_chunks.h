@@ -0,0 +1,128 @@
+/*
+ * Corrupted chunks functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_CORRUPTED_CHUNKS_H )
+#define _LIBEWF_CORRUPTED_CHUNKS_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The minimum number of entries the corrupted chunks are grown with
+ */
+#define LIBEWF_CORRUPTED_CHUNKS_MINIMUM_NUMBER_OF_ENTRIES		16
+
+/* The maximum number of corrupted chunks of which the unpacked data is retained
+ */
+#define LIBEWF_CORRUPTED_CHUNKS_MAXIMUM_NUMBER_OF_RETAINED_CHUNK_DATA	64
+
+typedef struct libewf_corrupted_chunk libewf_corrupted_chunk_t;
+
+struct libewf_corrupted_chunk
+{
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The size of the unpacked data
+	 */
+	size_t data_size;
+
+	/* The range flags of the unpacked data
+	 */
+	uint32_t range_flags;
+
+	/* The retained unpacked chunk data
+	 */
+	libewf_chunk_data_t *chunk_data;
+};
+
+typedef struct libewf_corrupted_chunks libewf_corrupted_chunks_t;
+
+/* The corrupted chunks contain the chunks that failed to unpack sorted by chunk index
+ * The chunks are remembered independent of the chunks cache, so that a subsequent read
+ * of a corrupted chunk does not need to read and decompress the chunk data again
+ */
+struct libewf_corrupted_chunks
+{
+	/* The entries
+	 */
+	libewf_corrupted_chunk_t *entries;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The number of allocated entries
+	 */
+	int number_of_allocated_entries;
+
+	/* The number of entries with retained chunk data
+	 */
+	int number_of_retained_chunk_data;
+};
+
+int libewf_corrupted_chunks_initialize(
+     libewf_corrupted_chunks_t **corrupted_chunks,
+     libcerror_error_t **error );
+
+int libewf_corrupted_chunks_free(
+     libewf_corrupted_chunks_t **corrupted_chunks,
+     libcerror_error_t **error );
+
+int libewf_corrupted_chunks_get_entry_index(
+     libewf_corrupted_chunks_t *corrupted_chunks,
+     uint64_t chunk_index,
+     int *entry_index,
+     libcerror_error_t **error );
+
+int libewf_corrupted_chunks_get_number_of_chunks(
+     libewf_corrupted_chunks_t *corrupted_chunks,
+     int *number_of_chunks,
+     libcerror_error_t **error );
+
+int libewf_corrupted_chunks_get_chunk(
+     libewf_corrupted_chunks_t *corrupted_chunks,
+     uint64_t chunk_index,
+     size_t *data_size,
+     uint32_t *range_flags,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+int libewf_corrupted_chunks_set_chunk(
+     libewf_corrupted_chunks_t *corrupted_chunks,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     uint8_t retain_chunk_data,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_CORRUPTED_CHUNKS_H ) */
+
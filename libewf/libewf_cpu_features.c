@@ -0,0 +1,317 @@
+/*
+ * CPU feature detection functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "libewf_cpu_features.h"
+#include "libewf_libcerror.h"
+
+#if defined( HAVE_LIBEWF_CPU_FEATURES_X86 )
+#include <cpuid.h>
+#endif
+
+#if defined( HAVE_LIBEWF_CPU_FEATURES_AARCH64_LINUX )
+#include <sys/auxv.h>
+
+/* The SHA-1 and SHA-2 bits of AT_HWCAP
+ */
+#define LIBEWF_CPU_FEATURES_AARCH64_HWCAP_SHA1	0x00000020UL
+#define LIBEWF_CPU_FEATURES_AARCH64_HWCAP_SHA2	0x00000040UL
+#endif
+
+/* Flag to indicate the CPU features have been determined
+ */
+#define LIBEWF_CPU_FEATURES_FLAG_IS_INITIALIZED	0x80000000UL
+
+/* The CPU features used by the library
+ * These are determined on first use and stored together with the initialized
+ * flag in a single value, since detection is idempotent a concurrent first use
+ * only results in the features being determined twice
+ */
+static uint32_t libewf_cpu_features = 0;
+
+/* Detects the features supported by the CPU
+ * Returns the CPU feature flags
+ */
+uint32_t libewf_cpu_features_detect(
+          void )
+{
+	uint32_t cpu_features = 0;
+
+#if defined( HAVE_LIBEWF_CPU_FEATURES_X86 )
+	unsigned int eax      = 0;
+	unsigned int ebx      = 0;
+	unsigned int ecx      = 0;
+	unsigned int edx      = 0;
+
+	__builtin_cpu_init();
+
+	if( __builtin_cpu_supports( "sse2" ) )
+	{
+		cpu_features |= LIBEWF_CPU_FEATURE_FLAG_SSE2;
+	}
+	if( __builtin_cpu_supports( "ssse3" ) )
+	{
+		cpu_features |= LIBEWF_CPU_FEATURE_FLAG_SSSE3;
+	}
+	if( __builtin_cpu_supports( "avx2" ) )
+	{
+		cpu_features |= LIBEWF_CPU_FEATURE_FLAG_AVX2;
+	}
+	if( __get_cpuid_count(
+	     7,
+	     0,
+	     &eax,
+	     &ebx,
+	     &ecx,
+	     &edx ) != 0 )
+	{
+		/* AVX-512BW is bit 30 of EBX, AVX-512F is checked by the built-in
+		 * function since it also requires operating system support
+		 */
+		if( ( __builtin_cpu_supports( "avx512f" ) )
+		 && ( ( ebx & 0x40000000UL ) != 0 ) )
+		{
+			cpu_features |= LIBEWF_CPU_FEATURE_FLAG_AVX512;
+		}
+		/* SHA is bit 29 of EBX
+		 */
+		if( ( ebx & 0x20000000UL ) != 0 )
+		{
+			cpu_features |= LIBEWF_CPU_FEATURE_FLAG_SHA;
+		}
+	}
+#elif defined( __aarch64__ )
+	/* Advanced SIMD (NEON) is mandatory on AArch64
+	 */
+	cpu_features |= LIBEWF_CPU_FEATURE_FLAG_NEON;
+
+#if defined( HAVE_LIBEWF_CPU_FEATURES_AARCH64_LINUX )
+	if( ( getauxval( AT_HWCAP ) & ( LIBEWF_CPU_FEATURES_AARCH64_HWCAP_SHA1 | LIBEWF_CPU_FEATURES_AARCH64_HWCAP_SHA2 ) )
+	 == ( LIBEWF_CPU_FEATURES_AARCH64_HWCAP_SHA1 | LIBEWF_CPU_FEATURES_AARCH64_HWCAP_SHA2 ) )
+	{
+		cpu_features |= LIBEWF_CPU_FEATURE_FLAG_SHA;
+	}
+#endif
+#endif /* defined( HAVE_LIBEWF_CPU_FEATURES_X86 ) */
+
+	return( cpu_features );
+}
+
+/* Parses a comma separated list of CPU feature names
+ * The names are: sse2, ssse3, avx2, avx512, neon, sha and none
+ * Unsupported names are ignored
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_cpu_features_parse_string(
+     const char *string,
+     size_t string_length,
+     uint32_t *cpu_features,
+     libcerror_error_t **error )
+{
+	static char *function      = "libewf_cpu_features_parse_string";
+	size_t name_length         = 0;
+	size_t name_start_index    = 0;
+	size_t string_index        = 0;
+	uint32_t safe_cpu_features = 0;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string_length > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid string length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( cpu_features == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid CPU features.",
+		 function );
+
+		return( -1 );
+	}
+	for( string_index = 0;
+	     string_index <= string_length;
+	     string_index++ )
+	{
+		if( ( string_index < string_length )
+		 && ( string[ string_index ] != ',' ) )
+		{
+			continue;
+		}
+		name_length = string_index - name_start_index;
+
+		if( name_length == 3 )
+		{
+			if( narrow_string_compare(
+			     &( string[ name_start_index ] ),
+			     "sha",
+			     3 ) == 0 )
+			{
+				safe_cpu_features |= LIBEWF_CPU_FEATURE_FLAG_SHA;
+			}
+		}
+		else if( name_length == 4 )
+		{
+			if( narrow_string_compare(
+			     &( string[ name_start_index ] ),
+			     "sse2",
+			     4 ) == 0 )
+			{
+				safe_cpu_features |= LIBEWF_CPU_FEATURE_FLAG_SSE2;
+			}
+			else if( narrow_string_compare(
+			          &( string[ name_start_index ] ),
+			          "avx2",
+			          4 ) == 0 )
+			{
+				safe_cpu_features |= LIBEWF_CPU_FEATURE_FLAG_AVX2;
+			}
+			else if( narrow_string_compare(
+			          &( string[ name_start_index ] ),
+			          "neon",
+			          4 ) == 0 )
+			{
+				safe_cpu_features |= LIBEWF_CPU_FEATURE_FLAG_NEON;
+			}
+			else if( narrow_string_compare(
+			          &( string[ name_start_index ] ),
+			          "none",
+			          4 ) == 0 )
+			{
+				safe_cpu_features = 0;
+			}
+		}
+		else if( name_length == 5 )
+		{
+			if( narrow_string_compare(
+			     &( string[ name_start_index ] ),
+			     "ssse3",
+			     5 ) == 0 )
+			{
+				safe_cpu_features |= LIBEWF_CPU_FEATURE_FLAG_SSSE3;
+			}
+		}
+		else if( name_length == 6 )
+		{
+			if( narrow_string_compare(
+			     &( string[ name_start_index ] ),
+			     "avx512",
+			     6 ) == 0 )
+			{
+				safe_cpu_features |= LIBEWF_CPU_FEATURE_FLAG_AVX512;
+			}
+		}
+		name_start_index = string_index + 1;
+	}
+	*cpu_features = safe_cpu_features;
+
+	return( 1 );
+}
+
+/* Retrieves the CPU features used by the library
+ * The features are detected on first use and can be restricted for benchmarking
+ * with the LIBEWF_CPU_FEATURES environment variable
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_cpu_features_get(
+     uint32_t *cpu_features,
+     libcerror_error_t **error )
+{
+	const char *environment_value = NULL;
+	static char *function         = "libewf_cpu_features_get";
+	uint32_t enabled_cpu_features = 0;
+	uint32_t safe_cpu_features    = 0;
+
+	if( cpu_features == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid CPU features.",
+		 function );
+
+		return( -1 );
+	}
+	safe_cpu_features = libewf_cpu_features;
+
+	if( ( safe_cpu_features & LIBEWF_CPU_FEATURES_FLAG_IS_INITIALIZED ) == 0 )
+	{
+		safe_cpu_features = libewf_cpu_features_detect();
+
+		environment_value = getenv(
+		                     LIBEWF_CPU_FEATURES_ENVIRONMENT_VARIABLE );
+
+		if( environment_value != NULL )
+		{
+			if( libewf_cpu_features_parse_string(
+			     environment_value,
+			     narrow_string_length(
+			      environment_value ),
+			     &enabled_cpu_features,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to parse CPU features environment variable.",
+				 function );
+
+				return( -1 );
+			}
+			safe_cpu_features &= enabled_cpu_features;
+		}
+		safe_cpu_features &= LIBEWF_CPU_FEATURE_FLAGS_ALL;
+		safe_cpu_features |= LIBEWF_CPU_FEATURES_FLAG_IS_INITIALIZED;
+
+		libewf_cpu_features = safe_cpu_features;
+	}
+	*cpu_features = safe_cpu_features & LIBEWF_CPU_FEATURE_FLAGS_ALL;
+
+	return( 1 );
+}
+
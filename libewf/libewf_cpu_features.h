@@ -0,0 +1,88 @@
+/*
+ * CPU feature detection functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_CPU_FEATURES_H )
+#define _LIBEWF_CPU_FEATURES_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* Run-time x86 CPU feature detection requires compiler support
+ * for the CPU feature built-in functions
+ */
+#if ( defined( __x86_64__ ) || defined( __i386__ ) ) && ( defined( __clang__ ) || ( defined( __GNUC__ ) && ( __GNUC__ >= 5 ) ) )
+#define HAVE_LIBEWF_CPU_FEATURES_X86	1
+#endif
+
+#if defined( __aarch64__ ) && defined( __linux__ )
+#define HAVE_LIBEWF_CPU_FEATURES_AARCH64_LINUX	1
+#endif
+
+/* The name of the environment variable that restricts the CPU features
+ * used by the library, e.g. LIBEWF_CPU_FEATURES="sse2,ssse3" or "none"
+ */
+#define LIBEWF_CPU_FEATURES_ENVIRONMENT_VARIABLE	"LIBEWF_CPU_FEATURES"
+
+/* The CPU feature flags
+ */
+enum LIBEWF_CPU_FEATURE_FLAGS
+{
+	LIBEWF_CPU_FEATURE_FLAG_SSE2		= 0x00000001,
+	LIBEWF_CPU_FEATURE_FLAG_SSSE3		= 0x00000002,
+	LIBEWF_CPU_FEATURE_FLAG_AVX2		= 0x00000004,
+	LIBEWF_CPU_FEATURE_FLAG_AVX512		= 0x00000008,
+	LIBEWF_CPU_FEATURE_FLAG_NEON		= 0x00000010,
+	LIBEWF_CPU_FEATURE_FLAG_SHA		= 0x00000020
+};
+
+#define LIBEWF_CPU_FEATURE_FLAGS_ALL \
+	( LIBEWF_CPU_FEATURE_FLAG_SSE2 \
+	| LIBEWF_CPU_FEATURE_FLAG_SSSE3 \
+	| LIBEWF_CPU_FEATURE_FLAG_AVX2 \
+	| LIBEWF_CPU_FEATURE_FLAG_AVX512 \
+	| LIBEWF_CPU_FEATURE_FLAG_NEON \
+	| LIBEWF_CPU_FEATURE_FLAG_SHA )
+
+uint32_t libewf_cpu_features_detect(
+          void );
+
+int libewf_cpu_features_parse_string(
+     const char *string,
+     size_t string_length,
+     uint32_t *cpu_features,
+     libcerror_error_t **error );
+
+int libewf_cpu_features_get(
+     uint32_t *cpu_features,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_CPU_FEATURES_H ) */
+
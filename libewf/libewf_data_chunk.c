@@ -23,6 +23,7 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libewf_compression_context.h"
 #include "libewf_data_chunk.h"
 #include "libewf_definitions.h"
 #include "libewf_io_handle.h"
@@ -123,6 +124,19 @@ int libewf_data_chunk_initialize(
 		goto on_error;
 	}
 #endif
+	if( libewf_compression_context_initialize(
+	     &( internal_data_chunk->compression_context ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create compression context.",
+		 function );
+
+		goto on_error;
+	}
 	internal_data_chunk->io_handle       = io_handle;
 	internal_data_chunk->write_io_handle = write_io_handle;
 
@@ -133,6 +147,14 @@ int libewf_data_chunk_initialize(
 on_error:
 	if( internal_data_chunk != NULL )
 	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( internal_data_chunk->read_write_lock != NULL )
+		{
+			libcthreads_read_write_lock_free(
+			 &( internal_data_chunk->read_write_lock ),
+			 NULL );
+		}
+#endif
 		memory_free(
 		 internal_data_chunk );
 	}
@@ -194,6 +216,19 @@ int libewf_data_chunk_free(
 
 			result = -1;
 		}
+		if( libewf_compression_context_free(
+		     &( internal_data_chunk->compression_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free compression context.",
+			 function );
+
+			result = -1;
+		}
 		/* The io_handle and write_io_handle references are freed elsewhere
 		 */
 		memory_free(
@@ -368,6 +403,7 @@ ssize_t libewf_data_chunk_read_buffer(
 		if( libewf_chunk_data_unpack(
 		     internal_data_chunk->chunk_data,
 		     internal_data_chunk->io_handle,
+		     internal_data_chunk->compression_context,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -506,8 +542,9 @@ ssize_t libewf_data_chunk_write_buffer(
 			goto on_error;
 		}
 	}
-	if( libewf_chunk_data_initialize(
+	if( libewf_chunk_data_initialize_with_buffer_pool(
 	     &( internal_data_chunk->chunk_data ),
+	     internal_data_chunk->io_handle->buffer_pool,
 	     internal_data_chunk->io_handle->chunk_size,
 	     0,
 	     error ) != 1 )
@@ -540,13 +577,164 @@ ssize_t libewf_data_chunk_write_buffer(
 	}
 	internal_data_chunk->data_size = buffer_size;
 
+	if( libewf_internal_data_chunk_pack(
+	     internal_data_chunk,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to pack chunk: %" PRIu64 " data.",
+		 function,
+		 internal_data_chunk->chunk_index );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_data_chunk->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_data_chunk->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Packs the chunk data of the data chunk
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_data_chunk_pack(
+     libewf_internal_data_chunk_t *internal_data_chunk,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_data_chunk_pack";
+
+	if( internal_data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_data_chunk->chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data chunk - missing chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_data_chunk->chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) != 0 )
+	{
+		return( 1 );
+	}
+	if( internal_data_chunk->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data chunk - missing write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	/* The write values are initialized when the data chunk is retrieved from the handle
+	 * and do not change afterwards, hence the handle does not need to be locked
+	 */
 	if( libewf_chunk_data_pack(
 	     internal_data_chunk->chunk_data,
 	     internal_data_chunk->io_handle,
+	     internal_data_chunk->compression_context,
 	     internal_data_chunk->write_io_handle->compressed_zero_byte_empty_block,
 	     internal_data_chunk->write_io_handle->compressed_zero_byte_empty_block_size,
 	     internal_data_chunk->write_io_handle->pack_flags,
 	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to pack chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Packs the data chunk
+ * It applies compression if necessary and calculates the chunk checksum
+ * Packing only locks the data chunk and not the handle it was retrieved from,
+ * hence data chunks can be packed on multiple threads at the same time
+ * This function does nothing if the data chunk is already packed
+ * e.g. by libewf_data_chunk_write_buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_data_chunk_pack(
+     libewf_data_chunk_t *data_chunk,
+     libcerror_error_t **error )
+{
+	libewf_internal_data_chunk_t *internal_data_chunk = NULL;
+	static char *function                             = "libewf_data_chunk_pack";
+	int result                                        = 1;
+
+	if( data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	internal_data_chunk = (libewf_internal_data_chunk_t *) data_chunk;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_data_chunk->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libewf_internal_data_chunk_pack(
+	     internal_data_chunk,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -556,8 +744,222 @@ ssize_t libewf_data_chunk_write_buffer(
 		 function,
 		 internal_data_chunk->chunk_index );
 
+		result = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_data_chunk->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Copies the packed data of a source data chunk to the data chunk
+ * The source data chunk must have been read with libewf_handle_read_data_chunk
+ * from a handle with the same format, chunk size and compression method
+ * This allows compressed chunks to be written without being recompressed
+ * The caller is responsible for only copying chunks when the compression level should be retained
+ * This function can be used instead of libewf_data_chunk_write_buffer before libewf_handle_write_data_chunk
+ * Returns 1 if successful, 0 if the packed data cannot be copied or -1 on error
+ */
+int libewf_data_chunk_copy_packed_data(
+     libewf_data_chunk_t *data_chunk,
+     libewf_data_chunk_t *source_data_chunk,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data                          = NULL;
+	libewf_internal_data_chunk_t *internal_data_chunk        = NULL;
+	libewf_internal_data_chunk_t *internal_source_data_chunk = NULL;
+	static char *function                                    = "libewf_data_chunk_copy_packed_data";
+	size_t data_size                                         = 0;
+	int result                                               = 0;
+
+	if( data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	internal_data_chunk = (libewf_internal_data_chunk_t *) data_chunk;
+
+	if( internal_data_chunk->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data chunk - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_data_chunk->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data chunk - missing write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	internal_source_data_chunk = (libewf_internal_data_chunk_t *) source_data_chunk;
+
+	if( internal_source_data_chunk == internal_data_chunk )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source data chunk value same as data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_source_data_chunk->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid source data chunk - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	/* The packed data can only be reused if it is stored in the same way
+	 */
+	if( ( internal_source_data_chunk->io_handle->format != internal_data_chunk->io_handle->format )
+	 || ( internal_source_data_chunk->io_handle->major_version != internal_data_chunk->io_handle->major_version )
+	 || ( internal_source_data_chunk->io_handle->chunk_size != internal_data_chunk->io_handle->chunk_size )
+	 || ( internal_source_data_chunk->io_handle->compression_method != internal_data_chunk->io_handle->compression_method ) )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_source_data_chunk->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab source read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_source_data_chunk->chunk_data != NULL )
+	{
+		result = libewf_chunk_data_clone_packed(
+		          &chunk_data,
+		          internal_source_data_chunk->chunk_data,
+		          internal_data_chunk->io_handle->compression_method,
+		          internal_data_chunk->write_io_handle->pack_flags,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to clone packed chunk: %" PRIu64 " data.",
+			 function,
+			 internal_source_data_chunk->chunk_index );
+		}
+		else if( result != 0 )
+		{
+			data_size = internal_source_data_chunk->chunk_data->data_size;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_source_data_chunk->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release source read/write lock for reading.",
+		 function );
+
 		goto on_error;
 	}
+#endif
+	if( result != 1 )
+	{
+		return( result );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_data_chunk->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( internal_data_chunk->chunk_data != NULL )
+	{
+		if( libewf_chunk_data_free(
+		     &( internal_data_chunk->chunk_data ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk data.",
+			 function );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+			libcthreads_read_write_lock_release_for_write(
+			 internal_data_chunk->read_write_lock,
+			 NULL );
+#endif
+			goto on_error;
+		}
+	}
+	internal_data_chunk->chunk_data = chunk_data;
+	internal_data_chunk->data_size  = data_size;
+
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_data_chunk->read_write_lock,
@@ -573,14 +975,193 @@ ssize_t libewf_data_chunk_write_buffer(
 		return( -1 );
 	}
 #endif
-	return( write_count );
+	return( 1 );
 
 on_error:
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Compares the packed data of a data chunk with that of another data chunk
+ * Both data chunks must have been read with libewf_handle_read_data_chunk
+ * from handles with the same format, chunk size and compression method
+ * If the packed data, including the stored checksum, is identical the media data
+ * of the chunks is identical and the chunks do not need to be unpacked
+ * Returns 1 if the packed data is identical, 0 if the packed data differs or
+ * cannot be compared or -1 on error
+ */
+int libewf_data_chunk_compare_packed_data(
+     libewf_data_chunk_t *data_chunk,
+     libewf_data_chunk_t *other_data_chunk,
+     libcerror_error_t **error )
+{
+	libewf_internal_data_chunk_t *internal_data_chunk       = NULL;
+	libewf_internal_data_chunk_t *internal_other_data_chunk = NULL;
+	static char *function                                   = "libewf_data_chunk_compare_packed_data";
+	uint32_t range_flags_mask                               = 0;
+	int result                                              = 0;
+
+	if( data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	internal_data_chunk = (libewf_internal_data_chunk_t *) data_chunk;
+
+	if( internal_data_chunk->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data chunk - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( other_data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid other data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	internal_other_data_chunk = (libewf_internal_data_chunk_t *) other_data_chunk;
+
+	if( internal_other_data_chunk == internal_data_chunk )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid other data chunk value same as data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_other_data_chunk->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid other data chunk - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	/* The packed data can only be compared if it is stored in the same way
+	 */
+	if( ( internal_other_data_chunk->io_handle->format != internal_data_chunk->io_handle->format )
+	 || ( internal_other_data_chunk->io_handle->major_version != internal_data_chunk->io_handle->major_version )
+	 || ( internal_other_data_chunk->io_handle->chunk_size != internal_data_chunk->io_handle->chunk_size )
+	 || ( internal_other_data_chunk->io_handle->compression_method != internal_data_chunk->io_handle->compression_method ) )
+	{
+		return( 0 );
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_data_chunk->read_write_lock,
-	 NULL );
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_data_chunk->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_other_data_chunk->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab other read/write lock for reading.",
+		 function );
+
+		libcthreads_read_write_lock_release_for_read(
+		 internal_data_chunk->read_write_lock,
+		 NULL );
+
+		return( -1 );
+	}
 #endif
-	return( -1 );
+	/* Only chunk data that has not been unpacked still contains the data as stored
+	 */
+	if( ( internal_data_chunk->chunk_data != NULL )
+	 && ( internal_other_data_chunk->chunk_data != NULL )
+	 && ( internal_data_chunk->chunk_data->data != NULL )
+	 && ( internal_other_data_chunk->chunk_data->data != NULL )
+	 && ( ( internal_data_chunk->chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) != 0 )
+	 && ( ( internal_other_data_chunk->chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) != 0 ) )
+	{
+		range_flags_mask = LIBEWF_RANGE_FLAG_IS_COMPRESSED
+		                 | LIBEWF_RANGE_FLAG_USES_PATTERN_FILL;
+
+		if( ( internal_data_chunk->data_size == internal_other_data_chunk->data_size )
+		 && ( internal_data_chunk->chunk_data->data_size == internal_other_data_chunk->chunk_data->data_size )
+		 && ( internal_data_chunk->chunk_data->checksum == internal_other_data_chunk->chunk_data->checksum )
+		 && ( ( internal_data_chunk->chunk_data->range_flags & range_flags_mask ) == ( internal_other_data_chunk->chunk_data->range_flags & range_flags_mask ) )
+		 && ( memory_compare(
+		       internal_data_chunk->chunk_data->data,
+		       internal_other_data_chunk->chunk_data->data,
+		       internal_data_chunk->chunk_data->data_size ) == 0 ) )
+		{
+			result = 1;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_other_data_chunk->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release other read/write lock for reading.",
+		 function );
+
+		libcthreads_read_write_lock_release_for_read(
+		 internal_data_chunk->read_write_lock,
+		 NULL );
+
+		return( -1 );
+	}
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_data_chunk->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
 }
 
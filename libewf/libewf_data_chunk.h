@@ -26,6 +26,7 @@
 #include <types.h>
 
 #include "libewf_chunk_data.h"
+#include "libewf_compression_context.h"
 #include "libewf_extern.h"
 #include "libewf_io_handle.h"
 #include "libewf_libcerror.h"
@@ -61,6 +62,10 @@ struct libewf_internal_data_chunk
 	 */
 	libewf_chunk_data_t *chunk_data;
 
+	/* The compression context
+	 */
+	libewf_compression_context_t *compression_context;
+
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	/* The read/write lock
 	 */
@@ -99,6 +104,27 @@ ssize_t libewf_data_chunk_write_buffer(
          size_t buffer_size,
          libcerror_error_t **error );
 
+int libewf_internal_data_chunk_pack(
+     libewf_internal_data_chunk_t *internal_data_chunk,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_data_chunk_pack(
+     libewf_data_chunk_t *data_chunk,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_data_chunk_copy_packed_data(
+     libewf_data_chunk_t *data_chunk,
+     libewf_data_chunk_t *source_data_chunk,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_data_chunk_compare_packed_data(
+     libewf_data_chunk_t *data_chunk,
+     libewf_data_chunk_t *other_data_chunk,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
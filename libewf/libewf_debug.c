@@ -55,6 +55,11 @@ void libewf_debug_print_compression_method(
 			 "bzip2" );
 			break;
 
+		case LIBEWF_COMPRESSION_METHOD_ZSTD:
+			libcnotify_printf(
+			 "zstd" );
+			break;
+
 		default:
 			libcnotify_printf(
 			 "UNKNOWN" );
@@ -27,6 +27,23 @@
 #include "libewf_deflate.h"
 #include "libewf_libcerror.h"
 
+const uint16_t libewf_deflate_literal_codes_base[ 29 ] = {
+	3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+	35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+
+const uint16_t libewf_deflate_literal_codes_number_of_extra_bits[ 29 ] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+	3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+
+const uint16_t libewf_deflate_distance_codes_base[ 30 ] = {
+	1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+	257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193,
+	12289, 16385, 24577};
+
+const uint16_t libewf_deflate_distance_codes_number_of_extra_bits[ 30 ] = {
+	0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+	7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
 /* Retrieves a value from the bit stream
  * Returns 1 on success or -1 on error
  */
@@ -98,7 +115,16 @@ int libewf_deflate_bit_stream_get_value(
 	}
 	*value_32bit = bit_stream->bit_buffer & ~( 0xffffffffUL << number_of_bits );
 
-	bit_stream->bit_buffer     >>= number_of_bits;
+	/* Shifting the 32-bit buffer by 32 bits is undefined behavior
+	 */
+	if( number_of_bits == 32 )
+	{
+		bit_stream->bit_buffer = 0;
+	}
+	else
+	{
+		bit_stream->bit_buffer >>= number_of_bits;
+	}
 	bit_stream->bit_buffer_size -= number_of_bits;
 
 	return( 1 );
@@ -113,14 +139,18 @@ int libewf_deflate_huffman_table_construct(
      int number_of_code_sizes,
      libcerror_error_t **error )
 {
+	uint16_t next_huffman_codes_array[ 16 ];
 	int code_offsets_array[ 16 ];
 
-	static char *function = "libewf_deflate_huffman_table_construct";
-	uint16_t code_size    = 0;
-	uint8_t bit_index     = 0;
-	int code_offset       = 0;
-	int left_value        = 0;
-	int symbol            = 0;
+	static char *function  = "libewf_deflate_huffman_table_construct";
+	uint16_t code_size     = 0;
+	uint16_t huffman_code  = 0;
+	uint16_t reversed_code = 0;
+	uint8_t bit_index      = 0;
+	int code_offset        = 0;
+	int left_value         = 0;
+	int lookup_index       = 0;
+	int symbol             = 0;
 
 	if( table == NULL )
 	{
@@ -199,6 +229,20 @@ int libewf_deflate_huffman_table_construct(
 
 		return( -1 );
 	}
+	if( memory_set(
+	     &( table->fast_lookup_table ),
+	     0,
+	     LIBEWF_DEFLATE_HUFFMAN_FAST_LOOKUP_TABLE_SIZE * sizeof( uint16_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear fast lookup table.",
+		 function );
+
+		return( -1 );
+	}
 	for( symbol = 0;
 	     symbol < number_of_code_sizes;
 	     symbol++ )
@@ -290,6 +334,61 @@ int libewf_deflate_huffman_table_construct(
 		code_offsets_array[ code_size ]  += 1;
 		table->codes_array[ code_offset ] = symbol;
 	}
+	/* Determine the first canonical Huffman code of each code size
+	 */
+	next_huffman_codes_array[ 0 ] = 0;
+
+	for( bit_index = 1;
+	     bit_index <= table->maximum_number_of_bits;
+	     bit_index++ )
+	{
+		if( bit_index > 1 )
+		{
+			huffman_code += (uint16_t) table->code_counts_array[ bit_index - 1 ];
+		}
+		huffman_code <<= 1;
+
+		next_huffman_codes_array[ bit_index ] = huffman_code;
+	}
+	/* Fill the fast lookup table with the codes that fit in the lookup bits
+	 * The bit stream stores the Huffman codes most significant bit first
+	 * hence the lookup table is indexed by the bit reversed code
+	 */
+	for( symbol = 0;
+	     symbol < number_of_code_sizes;
+	     symbol++ )
+	{
+		code_size = code_sizes_array[ symbol ];
+
+		if( code_size == 0 )
+		{
+			continue;
+		}
+		huffman_code = next_huffman_codes_array[ code_size ];
+
+		next_huffman_codes_array[ code_size ] += 1;
+
+		if( code_size > LIBEWF_DEFLATE_HUFFMAN_FAST_NUMBER_OF_BITS )
+		{
+			continue;
+		}
+		reversed_code = 0;
+
+		for( bit_index = 0;
+		     bit_index < (uint8_t) code_size;
+		     bit_index++ )
+		{
+			reversed_code <<= 1;
+			reversed_code  |= huffman_code & 0x0001;
+			huffman_code  >>= 1;
+		}
+		for( lookup_index = (int) reversed_code;
+		     lookup_index < LIBEWF_DEFLATE_HUFFMAN_FAST_LOOKUP_TABLE_SIZE;
+		     lookup_index += 1 << code_size )
+		{
+			table->fast_lookup_table[ lookup_index ] = (uint16_t) ( ( symbol << 4 ) | code_size );
+		}
+	}
 /* TODO only used by dynamic Huffman
 	if( left_value > 0 )
 	{
@@ -306,6 +405,99 @@ int libewf_deflate_huffman_table_construct(
 	return( 1 );
 }
 
+/* Retrieves a Huffman encoded value from a bit buffer
+ * The fast lookup table is used for codes that fit in the lookup bits
+ * Returns 1 on success, 0 if no matching code was found or -1 on error
+ */
+int libewf_deflate_huffman_table_get_value(
+     libewf_deflate_huffman_table_t *table,
+     uint64_t bit_buffer,
+     uint8_t bit_buffer_size,
+     uint32_t *value_32bit,
+     uint8_t *number_of_bits,
+     libcerror_error_t **error )
+{
+	static char *function  = "libewf_deflate_huffman_table_get_value";
+	uint16_t lookup_value  = 0;
+	uint8_t bit_index      = 0;
+	uint8_t code_size      = 0;
+	int code_size_count    = 0;
+	int first_huffman_code = 0;
+	int first_index        = 0;
+	int huffman_code       = 0;
+
+	if( table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid table.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_32bit == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid 32-bit value.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_bits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of bits.",
+		 function );
+
+		return( -1 );
+	}
+	lookup_value = table->fast_lookup_table[ bit_buffer & LIBEWF_DEFLATE_HUFFMAN_FAST_LOOKUP_MASK ];
+	code_size    = (uint8_t) ( lookup_value & 0x000f );
+
+	if( ( lookup_value != 0 )
+	 && ( code_size <= bit_buffer_size ) )
+	{
+		*value_32bit    = (uint32_t) ( lookup_value >> 4 );
+		*number_of_bits = code_size;
+
+		return( 1 );
+	}
+	if( bit_buffer_size > table->maximum_number_of_bits )
+	{
+		bit_buffer_size = table->maximum_number_of_bits;
+	}
+	for( bit_index = 1;
+	     bit_index <= bit_buffer_size;
+	     bit_index++ )
+	{
+		huffman_code <<= 1;
+		huffman_code  |= (int) bit_buffer & 0x00000001UL;
+		bit_buffer   >>= 1;
+
+		code_size_count = table->code_counts_array[ bit_index ];
+
+		if( ( huffman_code - code_size_count ) < first_huffman_code )
+		{
+			*value_32bit    = table->codes_array[ first_index + ( huffman_code - first_huffman_code ) ];
+			*number_of_bits = bit_index;
+
+			return( 1 );
+		}
+		first_huffman_code  += code_size_count;
+		first_huffman_code <<= 1;
+		first_index         += code_size_count;
+	}
+	return( 0 );
+}
+
 /* Retrieves a Huffman encoded value from the bit stream
  * Returns 1 on success or -1 on error
  */
@@ -316,13 +508,7 @@ int libewf_deflate_bit_stream_get_huffman_encoded_value(
      libcerror_error_t **error )
 {
 	static char *function  = "libewf_deflate_bit_stream_get_huffman_encoded_value";
-	uint32_t bit_buffer    = 0;
-	uint8_t bit_index      = 0;
 	uint8_t number_of_bits = 0;
-	int code_size_count    = 0;
-	int first_huffman_code = 0;
-	int first_index        = 0;
-	int huffman_code       = 0;
 	int result             = 0;
 
 	if( bit_stream == NULL )
@@ -372,42 +558,29 @@ int libewf_deflate_bit_stream_get_huffman_encoded_value(
 		bit_stream->bit_buffer      |= *value_32bit;
 		bit_stream->bit_buffer_size += 8;
 	}
-	if( table->maximum_number_of_bits < bit_stream->bit_buffer_size )
+	result = libewf_deflate_huffman_table_get_value(
+	          table,
+	          (uint64_t) bit_stream->bit_buffer,
+	          bit_stream->bit_buffer_size,
+	          value_32bit,
+	          &number_of_bits,
+	          error );
+
+	if( result == -1 )
 	{
-		number_of_bits = table->maximum_number_of_bits;
-	}
-	else
-	{
-		number_of_bits = bit_stream->bit_buffer_size;
-	}
-	bit_buffer = bit_stream->bit_buffer;
-
-	for( bit_index = 1;
-	     bit_index <= number_of_bits;
-	     bit_index++ )
-	{
-		huffman_code <<= 1;
-		huffman_code  |= (int) bit_buffer & 0x00000001UL;
-		bit_buffer   >>= 1;
-
-		code_size_count = table->code_counts_array[ bit_index ];
-
-		if( ( huffman_code - code_size_count ) < first_huffman_code )
-		{
-			*value_32bit = table->codes_array[ first_index + ( huffman_code - first_huffman_code ) ];
-
-			result = 1;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve value from table.",
+		 function );
 
-			break;
-		}
-		first_huffman_code  += code_size_count;
-		first_huffman_code <<= 1;
-		first_index         += code_size_count;
+		return( -1 );
 	}
-	if( result != 0 )
+	else if( result != 0 )
 	{
-		bit_stream->bit_buffer     >>= bit_index;
-		bit_stream->bit_buffer_size -= bit_index;
+		bit_stream->bit_buffer     >>= number_of_bits;
+		bit_stream->bit_buffer_size -= number_of_bits;
 	}
 	return( result );
 }
@@ -774,10 +947,15 @@ int libewf_deflate_initialize_fixed_huffman_tables(
 	return( 1 );
 }
 
-/* Decodes a Huffman compressed block
- * Returns 1 on success or -1 on error
+/* Decodes a Huffman compressed block using a 64-bit bit buffer
+ * The bit buffer is refilled a word at a time and matches are copied using
+ * wide copies where the distance allows it. Decoding stops at the end of
+ * the block or when the remaining compressed or uncompressed data is too
+ * small for the fast decoder, after which the caller should continue with
+ * libewf_deflate_decode_huffman
+ * Returns 1 if the end of the block was reached, 0 if not or -1 on error
  */
-int libewf_deflate_decode_huffman(
+int libewf_deflate_decode_huffman_fast(
      libewf_deflate_bit_stream_t *bit_stream,
      libewf_deflate_huffman_table_t *literals_table,
      libewf_deflate_huffman_table_t *distances_table,
@@ -786,23 +964,323 @@ int libewf_deflate_decode_huffman(
      size_t *uncompressed_data_offset,
      libcerror_error_t **error )
 {
-	uint16_t literal_codes_base[ 29 ] = {
-		3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
-		35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+	const uint8_t *byte_stream    = NULL;
+	static char *function         = "libewf_deflate_decode_huffman_fast";
+	size_t byte_stream_offset     = 0;
+	size_t copy_end_offset        = 0;
+	size_t copy_offset            = 0;
+	size_t data_offset            = 0;
+	uint64_t bit_buffer           = 0;
+	uint64_t value_64bit          = 0;
+	uint32_t code_value           = 0;
+	uint16_t compression_offset   = 0;
+	uint16_t compression_size     = 0;
+	uint16_t lookup_value         = 0;
+	uint8_t bit_buffer_size       = 0;
+	uint8_t number_of_bits        = 0;
+	uint8_t number_of_extra_bits  = 0;
+	int result                    = 0;
+
+	if( bit_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bit stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( literals_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid literals table.",
+		 function );
+
+		return( -1 );
+	}
+	if( distances_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid distances table.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid uncompressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data offset.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream        = bit_stream->byte_stream;
+	byte_stream_offset = bit_stream->byte_stream_offset;
+	bit_buffer         = (uint64_t) bit_stream->bit_buffer;
+	bit_buffer_size    = bit_stream->bit_buffer_size;
+	data_offset        = *uncompressed_data_offset;
+
+	/* Every iteration needs at most 48 bits: a literal code of 15 bits
+	 * with 5 extra bits and a distance code of 15 bits with 13 extra bits
+	 * and a refill makes at least 56 bits available
+	 */
+	while( ( ( byte_stream_offset + 8 ) <= bit_stream->byte_stream_size )
+	    && ( data_offset <= uncompressed_data_size )
+	    && ( ( uncompressed_data_size - data_offset ) >= LIBEWF_DEFLATE_FAST_MAXIMUM_OUTPUT_SIZE ) )
+	{
+		byte_stream_copy_to_uint64_little_endian(
+		 &( byte_stream[ byte_stream_offset ] ),
+		 value_64bit );
+
+		bit_buffer         |= value_64bit << bit_buffer_size;
+		byte_stream_offset += ( 63 - bit_buffer_size ) >> 3;
+		bit_buffer_size    |= 56;
+
+		lookup_value = literals_table->fast_lookup_table[ bit_buffer & LIBEWF_DEFLATE_HUFFMAN_FAST_LOOKUP_MASK ];
+
+		if( lookup_value != 0 )
+		{
+			code_value     = (uint32_t) ( lookup_value >> 4 );
+			number_of_bits = (uint8_t) ( lookup_value & 0x000f );
+		}
+		else if( libewf_deflate_huffman_table_get_value(
+		          literals_table,
+		          bit_buffer,
+		          bit_buffer_size,
+		          &code_value,
+		          &number_of_bits,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve literal value from bit buffer.",
+			 function );
+
+			return( -1 );
+		}
+		bit_buffer     >>= number_of_bits;
+		bit_buffer_size -= number_of_bits;
+
+		if( code_value < 256 )
+		{
+			uncompressed_data[ data_offset++ ] = (uint8_t) code_value;
+
+			/* Decode the literals that fit in the remaining bits without a refill
+			 */
+			while( bit_buffer_size >= LIBEWF_DEFLATE_HUFFMAN_FAST_NUMBER_OF_BITS )
+			{
+				lookup_value = literals_table->fast_lookup_table[ bit_buffer & LIBEWF_DEFLATE_HUFFMAN_FAST_LOOKUP_MASK ];
+
+				if( ( lookup_value == 0 )
+				 || ( ( lookup_value >> 4 ) >= 256 ) )
+				{
+					break;
+				}
+				number_of_bits = (uint8_t) ( lookup_value & 0x000f );
+
+				uncompressed_data[ data_offset++ ] = (uint8_t) ( lookup_value >> 4 );
 
-	uint16_t literal_codes_number_of_extra_bits[ 29 ] = {
-		0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
-		3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+				bit_buffer     >>= number_of_bits;
+				bit_buffer_size -= number_of_bits;
+			}
+			continue;
+		}
+		if( code_value == 256 )
+		{
+			result = 1;
+
+			break;
+		}
+		if( code_value >= 286 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: invalid code value: %" PRIu32 ".",
+			 function,
+			 code_value );
 
-	uint16_t distance_codes_base[ 30 ] = {
-		1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
-		257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193,
-		12289, 16385, 24577};
+			return( -1 );
+		}
+		code_value -= 257;
 
-	uint16_t distance_codes_number_of_extra_bits[ 30 ] = {
-		0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
-		7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+		number_of_extra_bits = (uint8_t) libewf_deflate_literal_codes_number_of_extra_bits[ code_value ];
+		compression_size     = libewf_deflate_literal_codes_base[ code_value ]
+		                     + (uint16_t) ( bit_buffer & ( ( (uint64_t) 1 << number_of_extra_bits ) - 1 ) );
 
+		bit_buffer     >>= number_of_extra_bits;
+		bit_buffer_size -= number_of_extra_bits;
+
+		lookup_value = distances_table->fast_lookup_table[ bit_buffer & LIBEWF_DEFLATE_HUFFMAN_FAST_LOOKUP_MASK ];
+
+		if( lookup_value != 0 )
+		{
+			code_value     = (uint32_t) ( lookup_value >> 4 );
+			number_of_bits = (uint8_t) ( lookup_value & 0x000f );
+		}
+		else if( libewf_deflate_huffman_table_get_value(
+		          distances_table,
+		          bit_buffer,
+		          bit_buffer_size,
+		          &code_value,
+		          &number_of_bits,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve distance value from bit buffer.",
+			 function );
+
+			return( -1 );
+		}
+		bit_buffer     >>= number_of_bits;
+		bit_buffer_size -= number_of_bits;
+
+		if( code_value >= 30 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid distance code value: %" PRIu32 " out of bounds.",
+			 function,
+			 code_value );
+
+			return( -1 );
+		}
+		number_of_extra_bits = (uint8_t) libewf_deflate_distance_codes_number_of_extra_bits[ code_value ];
+		compression_offset   = libewf_deflate_distance_codes_base[ code_value ]
+		                     + (uint16_t) ( bit_buffer & ( ( (uint64_t) 1 << number_of_extra_bits ) - 1 ) );
+
+		bit_buffer     >>= number_of_extra_bits;
+		bit_buffer_size -= number_of_extra_bits;
+
+		if( (size_t) compression_offset > data_offset )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid compression offset value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		copy_offset     = data_offset;
+		copy_end_offset = data_offset + compression_size;
+
+		/* The wide copies can write up to 15 bytes beyond the end of the match
+		 * which is overwritten by subsequent output and within the bounds
+		 * guaranteed by LIBEWF_DEFLATE_FAST_MAXIMUM_OUTPUT_SIZE
+		 */
+		if( compression_offset >= 16 )
+		{
+			while( copy_offset < copy_end_offset )
+			{
+				memory_copy(
+				 &( uncompressed_data[ copy_offset ] ),
+				 &( uncompressed_data[ copy_offset - compression_offset ] ),
+				 16 );
+
+				copy_offset += 16;
+			}
+		}
+		else if( compression_offset >= 8 )
+		{
+			while( copy_offset < copy_end_offset )
+			{
+				memory_copy(
+				 &( uncompressed_data[ copy_offset ] ),
+				 &( uncompressed_data[ copy_offset - compression_offset ] ),
+				 8 );
+
+				copy_offset += 8;
+			}
+		}
+		else if( compression_offset == 1 )
+		{
+			memory_set(
+			 &( uncompressed_data[ copy_offset ] ),
+			 uncompressed_data[ copy_offset - 1 ],
+			 (size_t) compression_size );
+		}
+		else
+		{
+			while( copy_offset < copy_end_offset )
+			{
+				uncompressed_data[ copy_offset ] = uncompressed_data[ copy_offset - compression_offset ];
+
+				copy_offset++;
+			}
+		}
+		data_offset = copy_end_offset;
+	}
+	/* Return the unused bytes in the bit buffer to the byte stream
+	 */
+	while( bit_buffer_size >= 8 )
+	{
+		byte_stream_offset -= 1;
+		bit_buffer_size    -= 8;
+	}
+	bit_stream->byte_stream_offset = byte_stream_offset;
+	bit_stream->bit_buffer         = (uint32_t) ( bit_buffer & ( ( (uint64_t) 1 << bit_buffer_size ) - 1 ) );
+	bit_stream->bit_buffer_size    = bit_buffer_size;
+
+	*uncompressed_data_offset = data_offset;
+
+	return( result );
+}
+
+/* Decodes a Huffman compressed block
+ * Returns 1 on success or -1 on error
+ */
+int libewf_deflate_decode_huffman(
+     libewf_deflate_bit_stream_t *bit_stream,
+     libewf_deflate_huffman_table_t *literals_table,
+     libewf_deflate_huffman_table_t *distances_table,
+     uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     size_t *uncompressed_data_offset,
+     libcerror_error_t **error )
+{
 	static char *function         = "libewf_deflate_decode_huffman";
 	size_t data_offset            = 0;
 	uint32_t code_value           = 0;
@@ -810,6 +1288,7 @@ int libewf_deflate_decode_huffman(
 	uint16_t compression_offset   = 0;
 	uint16_t compression_size     = 0;
 	uint16_t number_of_extra_bits = 0;
+	int result                    = 0;
 
 	if( uncompressed_data == NULL )
 	{
@@ -846,6 +1325,34 @@ int libewf_deflate_decode_huffman(
 	}
 	data_offset = *uncompressed_data_offset;
 
+	result = libewf_deflate_decode_huffman_fast(
+	          bit_stream,
+	          literals_table,
+	          distances_table,
+	          uncompressed_data,
+	          uncompressed_data_size,
+	          &data_offset,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to decode Huffman encoded bit stream.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		*uncompressed_data_offset = data_offset;
+
+		return( 1 );
+	}
+	/* Decode the remainder of the block near the end of the buffers
+	 */
 	do
 	{
 		if( libewf_deflate_bit_stream_get_huffman_encoded_value(
@@ -883,7 +1390,7 @@ int libewf_deflate_decode_huffman(
 		{
 			code_value -= 257;
 
-			number_of_extra_bits = literal_codes_number_of_extra_bits[ code_value ];
+			number_of_extra_bits = libewf_deflate_literal_codes_number_of_extra_bits[ code_value ];
 
 			if( libewf_deflate_bit_stream_get_value(
 			     bit_stream,
@@ -900,7 +1407,7 @@ int libewf_deflate_decode_huffman(
 
 				return( -1 );
 			}
-			compression_size = literal_codes_base[ code_value ] + (uint16_t) extra_bits;
+			compression_size = libewf_deflate_literal_codes_base[ code_value ] + (uint16_t) extra_bits;
 
 			if( libewf_deflate_bit_stream_get_huffman_encoded_value(
 			     bit_stream,
@@ -917,7 +1424,19 @@ int libewf_deflate_decode_huffman(
 
 				return( -1 );
 			}
-			number_of_extra_bits = distance_codes_number_of_extra_bits[ code_value ];
+			if( code_value >= 30 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid distance code value: %" PRIu32 " out of bounds.",
+				 function,
+				 code_value );
+
+				return( -1 );
+			}
+			number_of_extra_bits = libewf_deflate_distance_codes_number_of_extra_bits[ code_value ];
 
 			if( libewf_deflate_bit_stream_get_value(
 			     bit_stream,
@@ -934,7 +1453,7 @@ int libewf_deflate_decode_huffman(
 
 				return( -1 );
 			}
-			compression_offset = distance_codes_base[ code_value ] + (uint16_t) extra_bits;
+			compression_offset = libewf_deflate_distance_codes_base[ code_value ] + (uint16_t) extra_bits;
 
 			if( compression_offset > data_offset )
 			{
@@ -1243,6 +1762,41 @@ int libewf_deflate_decompress(
      uint8_t *uncompressed_data,
      size_t *uncompressed_data_size,
      libcerror_error_t **error )
+{
+	static char *function = "libewf_deflate_decompress";
+
+	if( libewf_deflate_decompress_stream(
+	     compressed_data,
+	     compressed_data_size,
+	     NULL,
+	     uncompressed_data,
+	     uncompressed_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+		 "%s: unable to decompress data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Decompresses a zlib compressed stream that can be followed by other data
+ * If compressed_stream_size is set the stream must end with its checksum and
+ * it is set to the size of the stream including the checksum
+ * Returns 1 on success or -1 on error
+ */
+int libewf_deflate_decompress_stream(
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     size_t *compressed_stream_size,
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_data_size,
+     libcerror_error_t **error )
 {
 	libewf_deflate_bit_stream_t bit_stream;
 	libewf_deflate_huffman_table_t dynamic_huffman_distances_table;
@@ -1250,8 +1804,9 @@ int libewf_deflate_decompress(
 	libewf_deflate_huffman_table_t fixed_huffman_distances_table;
 	libewf_deflate_huffman_table_t fixed_huffman_literals_table;
 
-	static char *function                 = "libewf_deflate_decompress";
+	static char *function                 = "libewf_deflate_decompress_stream";
 	size_t compressed_data_offset         = 0;
+	size_t compressed_stream_data_size    = 0;
 	size_t uncompressed_data_offset       = 0;
 	uint32_t block_size                   = 0;
 	uint32_t block_size_copy              = 0;
@@ -1266,6 +1821,7 @@ int libewf_deflate_decompress(
 	uint8_t compression_window_bits       = 0;
 	uint8_t last_block_flag               = 0;
 	uint8_t skip_bits                     = 0;
+	uint8_t verify_checksum               = 0;
 
 	if( compressed_data == NULL )
 	{
@@ -1333,6 +1889,8 @@ int libewf_deflate_decompress(
 
 		return( -1 );
 	}
+	compressed_stream_data_size = compressed_data_size;
+
 	compression_method      = compressed_data[ 0 ] & 0x0f;
 	compression_information = compressed_data[ 0 ] >> 4;
 
@@ -1620,13 +2178,36 @@ int libewf_deflate_decompress(
 			break;
 		}
 	}
-	if( ( bit_stream.byte_stream_size - bit_stream.byte_stream_offset ) >= 4 )
+	/* When the size of the stream is requested the checksum is required
+	 * to determine where the stream ends
+	 */
+	if( compressed_stream_size != NULL )
+	{
+		verify_checksum = 1;
+	}
+	else if( ( bit_stream.byte_stream_size - bit_stream.byte_stream_offset ) >= 4 )
+	{
+		verify_checksum = 1;
+	}
+	if( verify_checksum != 0 )
 	{
 		while( bit_stream.bit_buffer_size >= 8 )
 		{
 			bit_stream.byte_stream_offset -= 1;
 			bit_stream.bit_buffer_size    -= 8;
 		}
+		if( ( compressed_stream_data_size < 4 )
+		 || ( bit_stream.byte_stream_offset > ( compressed_stream_data_size - 4 ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_INPUT,
+			 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+			 "%s: missing checksum.",
+			 function );
+
+			return( -1 );
+		}
 		byte_stream_copy_to_uint32_big_endian(
 		 &( bit_stream.byte_stream[ bit_stream.byte_stream_offset ] ),
 		 stored_checksum );
@@ -1661,6 +2242,10 @@ int libewf_deflate_decompress(
 			return( -1 );
 		}
 	}
+	if( compressed_stream_size != NULL )
+	{
+		*compressed_stream_size = bit_stream.byte_stream_offset + 4;
+	}
 	*uncompressed_data_size = uncompressed_data_offset;
 
 	return( 1 );
@@ -41,6 +41,17 @@ enum LIBEWF_DEFLATE_BLOCK_TYPES
 	LIBEWF_DEFLATE_BLOCK_TYPE_RESERVED		= 0x03
 };
 
+/* The number of bits of the Huffman fast lookup table
+ */
+#define LIBEWF_DEFLATE_HUFFMAN_FAST_NUMBER_OF_BITS	9
+#define LIBEWF_DEFLATE_HUFFMAN_FAST_LOOKUP_TABLE_SIZE	( 1 << LIBEWF_DEFLATE_HUFFMAN_FAST_NUMBER_OF_BITS )
+#define LIBEWF_DEFLATE_HUFFMAN_FAST_LOOKUP_MASK		( LIBEWF_DEFLATE_HUFFMAN_FAST_LOOKUP_TABLE_SIZE - 1 )
+
+/* The maximum number of bytes the fast decoder writes per symbol
+ * which is the largest match size and the size of a wide copy
+ */
+#define LIBEWF_DEFLATE_FAST_MAXIMUM_OUTPUT_SIZE		( 258 + 16 )
+
 typedef struct libewf_deflate_bit_stream libewf_deflate_bit_stream_t;
 
 struct libewf_deflate_bit_stream
@@ -86,6 +97,12 @@ struct libewf_deflate_huffman_table
 	/* The number of codes
 	 */
 	int number_of_codes;
+
+	/* The fast lookup table
+	 * Contains the symbol and code size of the codes that fit in the lookup
+	 * bits indexed by the bit reversed code or 0 if not available
+	 */
+	uint16_t fast_lookup_table[ LIBEWF_DEFLATE_HUFFMAN_FAST_LOOKUP_TABLE_SIZE ];
 };
 
 int libewf_deflate_bit_stream_get_value(
@@ -100,6 +117,14 @@ int libewf_deflate_huffman_table_construct(
      int number_of_code_sizes,
      libcerror_error_t **error );
 
+int libewf_deflate_huffman_table_get_value(
+     libewf_deflate_huffman_table_t *table,
+     uint64_t bit_buffer,
+     uint8_t bit_buffer_size,
+     uint32_t *value_32bit,
+     uint8_t *number_of_bits,
+     libcerror_error_t **error );
+
 int libewf_deflate_bit_stream_get_huffman_encoded_value(
      libewf_deflate_bit_stream_t *bit_stream,
      libewf_deflate_huffman_table_t *table,
@@ -120,6 +145,15 @@ int libewf_deflate_bit_stream_get_huffman_encoded_codes_array(
      uint32_t number_of_codes,
      libcerror_error_t **error );
 
+int libewf_deflate_decode_huffman_fast(
+     libewf_deflate_bit_stream_t *bit_stream,
+     libewf_deflate_huffman_table_t *literals_table,
+     libewf_deflate_huffman_table_t *distances_table,
+     uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     size_t *uncompressed_data_offset,
+     libcerror_error_t **error );
+
 int libewf_deflate_calculate_adler32(
      uint32_t *checksum_value,
      const uint8_t *buffer,
@@ -134,6 +168,14 @@ int libewf_deflate_decompress(
      size_t *uncompressed_data_size,
      libcerror_error_t **error );
 
+int libewf_deflate_decompress_stream(
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     size_t *compressed_stream_size,
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_data_size,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -0,0 +1,1191 @@
+/*
+ * Directory listing functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+#include <wide_string.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_DIRENT_H ) && !defined( WINAPI )
+#include <dirent.h>
+#endif
+
+#include "libewf_directory_listing.h"
+#include "libewf_libcerror.h"
+
+/* Names are compared case-insensitive on Windows since the file system
+ * resolves them case-insensitive as well
+ */
+#if defined( WINAPI )
+#define libewf_directory_listing_compare_narrow_names( name1, name2, size ) \
+	narrow_string_compare_no_case( name1, name2, size )
+
+#define libewf_directory_listing_compare_wide_names( name1, name2, size ) \
+	wide_string_compare_no_case( name1, name2, size )
+
+#define libewf_directory_listing_is_separator( character ) \
+	( ( character == '\\' ) || ( character == '/' ) || ( character == ':' ) )
+
+#else
+#define libewf_directory_listing_compare_narrow_names( name1, name2, size ) \
+	narrow_string_compare( name1, name2, size )
+
+#define libewf_directory_listing_compare_wide_names( name1, name2, size ) \
+	wide_string_compare( name1, name2, size )
+
+#define libewf_directory_listing_is_separator( character ) \
+	( character == '/' )
+
+#endif
+
+/* Creates a directory listing
+ * Make sure the value directory_listing is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_directory_listing_initialize(
+     libewf_directory_listing_t **directory_listing,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_directory_listing_initialize";
+
+	if( directory_listing == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory listing.",
+		 function );
+
+		return( -1 );
+	}
+	if( *directory_listing != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid directory listing value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*directory_listing = memory_allocate_structure(
+	                      libewf_directory_listing_t );
+
+	if( *directory_listing == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create directory listing.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *directory_listing,
+	     0,
+	     sizeof( libewf_directory_listing_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear directory listing.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *directory_listing != NULL )
+	{
+		memory_free(
+		 *directory_listing );
+
+		*directory_listing = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees the entry names of a directory listing
+ */
+void libewf_directory_listing_free_entry_names(
+      libewf_directory_listing_t *directory_listing )
+{
+	int entry_index = 0;
+
+	if( directory_listing->entry_names != NULL )
+	{
+		for( entry_index = 0;
+		     entry_index < directory_listing->number_of_entries;
+		     entry_index++ )
+		{
+			memory_free(
+			 directory_listing->entry_names[ entry_index ] );
+		}
+		memory_free(
+		 directory_listing->entry_names );
+
+		directory_listing->entry_names = NULL;
+	}
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+	if( directory_listing->entry_names_wide != NULL )
+	{
+		for( entry_index = 0;
+		     entry_index < directory_listing->number_of_entries;
+		     entry_index++ )
+		{
+			memory_free(
+			 directory_listing->entry_names_wide[ entry_index ] );
+		}
+		memory_free(
+		 directory_listing->entry_names_wide );
+
+		directory_listing->entry_names_wide = NULL;
+	}
+#endif
+	directory_listing->number_of_entries           = 0;
+	directory_listing->number_of_allocated_entries = 0;
+}
+
+/* Frees a directory listing
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_directory_listing_free(
+     libewf_directory_listing_t **directory_listing,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_directory_listing_free";
+
+	if( directory_listing == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory listing.",
+		 function );
+
+		return( -1 );
+	}
+	if( *directory_listing != NULL )
+	{
+		libewf_directory_listing_free_entry_names(
+		 *directory_listing );
+
+		memory_free(
+		 *directory_listing );
+
+		*directory_listing = NULL;
+	}
+	return( 1 );
+}
+
+/* Determines the length of the directory part of a path including the trailing separator
+ * Returns the length of the directory part or 0 if the path has no directory part
+ */
+size_t libewf_directory_listing_get_directory_name_length(
+        const char *path,
+        size_t path_length )
+{
+	while( path_length > 0 )
+	{
+		if( libewf_directory_listing_is_separator(
+		     path[ path_length - 1 ] ) )
+		{
+			break;
+		}
+		path_length--;
+	}
+	return( path_length );
+}
+
+/* Compares two narrow entry names, used to sort the directory listing
+ * Returns the result of the comparison
+ */
+int libewf_directory_listing_compare_entry_names(
+     const void *first_entry_name,
+     const void *second_entry_name )
+{
+	const char *first_name  = *( (const char **) first_entry_name );
+	const char *second_name = *( (const char **) second_entry_name );
+
+	return( libewf_directory_listing_compare_narrow_names(
+	         first_name,
+	         second_name,
+	         narrow_string_length( first_name ) + 1 ) );
+}
+
+/* Appends a narrow entry name to the directory listing
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_directory_listing_append_entry_name(
+     libewf_directory_listing_t *directory_listing,
+     const char *entry_name,
+     size_t entry_name_length,
+     libcerror_error_t **error )
+{
+	char *name                      = NULL;
+	void *reallocation              = NULL;
+	static char *function           = "libewf_directory_listing_append_entry_name";
+	int number_of_allocated_entries = 0;
+
+	if( directory_listing->number_of_entries >= directory_listing->number_of_allocated_entries )
+	{
+		if( directory_listing->number_of_allocated_entries >= ( INT_MAX / 2 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid number of allocated entries value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		number_of_allocated_entries = directory_listing->number_of_allocated_entries * 2;
+
+		if( number_of_allocated_entries < LIBEWF_DIRECTORY_LISTING_MINIMUM_NUMBER_OF_ENTRIES )
+		{
+			number_of_allocated_entries = LIBEWF_DIRECTORY_LISTING_MINIMUM_NUMBER_OF_ENTRIES;
+		}
+		reallocation = memory_reallocate(
+		                directory_listing->entry_names,
+		                sizeof( char * ) * number_of_allocated_entries );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize entry names.",
+			 function );
+
+			return( -1 );
+		}
+		directory_listing->entry_names                 = (char **) reallocation;
+		directory_listing->number_of_allocated_entries = number_of_allocated_entries;
+	}
+	name = narrow_string_allocate(
+	        entry_name_length + 1 );
+
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entry name.",
+		 function );
+
+		return( -1 );
+	}
+	if( narrow_string_copy(
+	     name,
+	     entry_name,
+	     entry_name_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy entry name.",
+		 function );
+
+		memory_free(
+		 name );
+
+		return( -1 );
+	}
+	name[ entry_name_length ] = 0;
+
+	directory_listing->entry_names[ directory_listing->number_of_entries++ ] = name;
+
+	return( 1 );
+}
+
+/* Reads the names of the entries in a directory that start with a specific prefix
+ * The path prefix consists of the directory name followed by the entry name prefix
+ * Returns 1 if successful, 0 if the directory could not be listed or -1 on error
+ */
+int libewf_directory_listing_read(
+     libewf_directory_listing_t *directory_listing,
+     const char *path_prefix,
+     size_t path_prefix_length,
+     libcerror_error_t **error )
+{
+#if defined( WINAPI )
+	WIN32_FIND_DATAA find_data;
+
+	HANDLE find_handle              = INVALID_HANDLE_VALUE;
+	char *find_pattern              = NULL;
+	const char *entry_name          = NULL;
+
+#elif defined( HAVE_LIBEWF_DIRECTORY_LISTING_SUPPORT )
+	struct dirent *directory_entry  = NULL;
+	DIR *directory_stream           = NULL;
+	char *directory_name            = NULL;
+	const char *entry_name          = NULL;
+#endif
+	static char *function           = "libewf_directory_listing_read";
+	size_t directory_name_length    = 0;
+	size_t entry_name_length        = 0;
+	size_t name_prefix_length       = 0;
+	int result                      = 0;
+
+	if( directory_listing == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory listing.",
+		 function );
+
+		return( -1 );
+	}
+	if( path_prefix == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path prefix.",
+		 function );
+
+		return( -1 );
+	}
+	if( path_prefix_length > (size_t) ( SSIZE_MAX - 2 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid path prefix length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	libewf_directory_listing_free_entry_names(
+	 directory_listing );
+
+	directory_name_length = libewf_directory_listing_get_directory_name_length(
+	                         path_prefix,
+	                         path_prefix_length );
+
+	name_prefix_length = path_prefix_length - directory_name_length;
+
+#if defined( WINAPI )
+	/* The find pattern consists of the directory name followed by "*"
+	 */
+	find_pattern = narrow_string_allocate(
+	                directory_name_length + 2 );
+
+	if( find_pattern == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create find pattern.",
+		 function );
+
+		goto on_error;
+	}
+	if( directory_name_length > 0 )
+	{
+		if( narrow_string_copy(
+		     find_pattern,
+		     path_prefix,
+		     directory_name_length ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy directory name.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	find_pattern[ directory_name_length ]     = '*';
+	find_pattern[ directory_name_length + 1 ] = 0;
+
+	find_handle = FindFirstFileA(
+	               (LPCSTR) find_pattern,
+	               &find_data );
+
+	memory_free(
+	 find_pattern );
+
+	find_pattern = NULL;
+
+	if( find_handle == INVALID_HANDLE_VALUE )
+	{
+		return( 0 );
+	}
+	do
+	{
+		if( ( find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY ) != 0 )
+		{
+			continue;
+		}
+		entry_name        = (const char *) find_data.cFileName;
+		entry_name_length = narrow_string_length(
+		                     entry_name );
+
+		if( ( entry_name_length < name_prefix_length )
+		 || ( libewf_directory_listing_compare_narrow_names(
+		       entry_name,
+		       &( path_prefix[ directory_name_length ] ),
+		       name_prefix_length ) != 0 ) )
+		{
+			continue;
+		}
+		if( libewf_directory_listing_append_entry_name(
+		     directory_listing,
+		     entry_name,
+		     entry_name_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append entry name.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	while( FindNextFileA(
+	        find_handle,
+	        &find_data ) != 0 );
+
+	/* FindNextFile fails with ERROR_NO_MORE_FILES at the end of the directory
+	 */
+	if( GetLastError() == ERROR_NO_MORE_FILES )
+	{
+		result = 1;
+	}
+	FindClose(
+	 find_handle );
+
+	find_handle = INVALID_HANDLE_VALUE;
+
+#elif defined( HAVE_LIBEWF_DIRECTORY_LISTING_SUPPORT )
+	directory_name = narrow_string_allocate(
+	                  directory_name_length + 2 );
+
+	if( directory_name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create directory name.",
+		 function );
+
+		goto on_error;
+	}
+	if( directory_name_length == 0 )
+	{
+		directory_name[ 0 ] = '.';
+		directory_name[ 1 ] = 0;
+	}
+	else
+	{
+		if( narrow_string_copy(
+		     directory_name,
+		     path_prefix,
+		     directory_name_length ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy directory name.",
+			 function );
+
+			goto on_error;
+		}
+		directory_name[ directory_name_length ] = 0;
+	}
+	directory_stream = opendir(
+	                    directory_name );
+
+	memory_free(
+	 directory_name );
+
+	directory_name = NULL;
+
+	if( directory_stream == NULL )
+	{
+		return( 0 );
+	}
+	result = 1;
+
+	/* A failing readdir cannot be distinguished from the end of the directory
+	 * without errno, hence a partial listing is possible. The caller confirms
+	 * the first name not found in the listing by testing if the file exists.
+	 */
+	for( directory_entry = readdir( directory_stream );
+	     directory_entry != NULL;
+	     directory_entry = readdir( directory_stream ) )
+	{
+		entry_name        = (const char *) directory_entry->d_name;
+		entry_name_length = narrow_string_length(
+		                     entry_name );
+
+		if( ( entry_name_length < name_prefix_length )
+		 || ( libewf_directory_listing_compare_narrow_names(
+		       entry_name,
+		       &( path_prefix[ directory_name_length ] ),
+		       name_prefix_length ) != 0 ) )
+		{
+			continue;
+		}
+		if( libewf_directory_listing_append_entry_name(
+		     directory_listing,
+		     entry_name,
+		     entry_name_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append entry name.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	closedir(
+	 directory_stream );
+
+	directory_stream = NULL;
+
+#endif /* defined( WINAPI ) */
+
+	if( result != 1 )
+	{
+		libewf_directory_listing_free_entry_names(
+		 directory_listing );
+
+		return( 0 );
+	}
+	if( directory_listing->number_of_entries > 1 )
+	{
+		qsort(
+		 directory_listing->entry_names,
+		 (size_t) directory_listing->number_of_entries,
+		 sizeof( char * ),
+		 &libewf_directory_listing_compare_entry_names );
+	}
+	return( 1 );
+
+#if defined( HAVE_LIBEWF_DIRECTORY_LISTING_SUPPORT )
+on_error:
+#if defined( WINAPI )
+	if( find_handle != INVALID_HANDLE_VALUE )
+	{
+		FindClose(
+		 find_handle );
+	}
+	if( find_pattern != NULL )
+	{
+		memory_free(
+		 find_pattern );
+	}
+#else
+	if( directory_stream != NULL )
+	{
+		closedir(
+		 directory_stream );
+	}
+	if( directory_name != NULL )
+	{
+		memory_free(
+		 directory_name );
+	}
+#endif
+	libewf_directory_listing_free_entry_names(
+	 directory_listing );
+
+	return( -1 );
+#endif /* defined( HAVE_LIBEWF_DIRECTORY_LISTING_SUPPORT ) */
+}
+
+/* Determines if the directory listing contains the entry name of a path
+ * Only the entry name part of the path is compared
+ * Returns 1 if the listing contains the entry, 0 if not or -1 on error
+ */
+int libewf_directory_listing_has_entry(
+     libewf_directory_listing_t *directory_listing,
+     const char *path,
+     size_t path_length,
+     libcerror_error_t **error )
+{
+	const char *entry_name       = NULL;
+	const char *name             = NULL;
+	static char *function        = "libewf_directory_listing_has_entry";
+	size_t directory_name_length = 0;
+	size_t name_length           = 0;
+	int lower_entry_index        = 0;
+	int middle_entry_index       = 0;
+	int result                   = 0;
+	int upper_entry_index        = 0;
+
+	if( directory_listing == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory listing.",
+		 function );
+
+		return( -1 );
+	}
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		return( -1 );
+	}
+	if( path_length > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid path length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( directory_listing->entry_names == NULL )
+	{
+		return( 0 );
+	}
+	directory_name_length = libewf_directory_listing_get_directory_name_length(
+	                         path,
+	                         path_length );
+
+	name        = &( path[ directory_name_length ] );
+	name_length = path_length - directory_name_length;
+
+	lower_entry_index = 0;
+	upper_entry_index = directory_listing->number_of_entries;
+
+	while( lower_entry_index < upper_entry_index )
+	{
+		middle_entry_index = lower_entry_index + ( ( upper_entry_index - lower_entry_index ) / 2 );
+
+		entry_name = directory_listing->entry_names[ middle_entry_index ];
+
+		result = libewf_directory_listing_compare_narrow_names(
+		          name,
+		          entry_name,
+		          name_length );
+
+		/* The name is a prefix of the entry name and hence sorts before it
+		 */
+		if( ( result == 0 )
+		 && ( narrow_string_length( entry_name ) > name_length ) )
+		{
+			result = -1;
+		}
+		if( result == 0 )
+		{
+			return( 1 );
+		}
+		else if( result < 0 )
+		{
+			upper_entry_index = middle_entry_index;
+		}
+		else
+		{
+			lower_entry_index = middle_entry_index + 1;
+		}
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+#if defined( HAVE_LIBEWF_DIRECTORY_LISTING_WIDE_SUPPORT )
+
+/* Determines the length of the directory part of a wide path including the trailing separator
+ * Returns the length of the directory part or 0 if the path has no directory part
+ */
+size_t libewf_directory_listing_get_directory_name_length_wide(
+        const wchar_t *path,
+        size_t path_length )
+{
+	while( path_length > 0 )
+	{
+		if( libewf_directory_listing_is_separator(
+		     path[ path_length - 1 ] ) )
+		{
+			break;
+		}
+		path_length--;
+	}
+	return( path_length );
+}
+
+/* Compares two wide entry names, used to sort the directory listing
+ * Returns the result of the comparison
+ */
+int libewf_directory_listing_compare_entry_names_wide(
+     const void *first_entry_name,
+     const void *second_entry_name )
+{
+	const wchar_t *first_name  = *( (const wchar_t **) first_entry_name );
+	const wchar_t *second_name = *( (const wchar_t **) second_entry_name );
+
+	return( libewf_directory_listing_compare_wide_names(
+	         first_name,
+	         second_name,
+	         wide_string_length( first_name ) + 1 ) );
+}
+
+/* Appends a wide entry name to the directory listing
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_directory_listing_append_entry_name_wide(
+     libewf_directory_listing_t *directory_listing,
+     const wchar_t *entry_name,
+     size_t entry_name_length,
+     libcerror_error_t **error )
+{
+	wchar_t *name                   = NULL;
+	void *reallocation              = NULL;
+	static char *function           = "libewf_directory_listing_append_entry_name_wide";
+	int number_of_allocated_entries = 0;
+
+	if( directory_listing->number_of_entries >= directory_listing->number_of_allocated_entries )
+	{
+		if( directory_listing->number_of_allocated_entries >= ( INT_MAX / 2 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid number of allocated entries value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		number_of_allocated_entries = directory_listing->number_of_allocated_entries * 2;
+
+		if( number_of_allocated_entries < LIBEWF_DIRECTORY_LISTING_MINIMUM_NUMBER_OF_ENTRIES )
+		{
+			number_of_allocated_entries = LIBEWF_DIRECTORY_LISTING_MINIMUM_NUMBER_OF_ENTRIES;
+		}
+		reallocation = memory_reallocate(
+		                directory_listing->entry_names_wide,
+		                sizeof( wchar_t * ) * number_of_allocated_entries );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize entry names.",
+			 function );
+
+			return( -1 );
+		}
+		directory_listing->entry_names_wide            = (wchar_t **) reallocation;
+		directory_listing->number_of_allocated_entries = number_of_allocated_entries;
+	}
+	name = wide_string_allocate(
+	        entry_name_length + 1 );
+
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entry name.",
+		 function );
+
+		return( -1 );
+	}
+	if( wide_string_copy(
+	     name,
+	     entry_name,
+	     entry_name_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy entry name.",
+		 function );
+
+		memory_free(
+		 name );
+
+		return( -1 );
+	}
+	name[ entry_name_length ] = 0;
+
+	directory_listing->entry_names_wide[ directory_listing->number_of_entries++ ] = name;
+
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_DIRECTORY_LISTING_WIDE_SUPPORT ) */
+
+/* Reads the names of the entries in a directory that start with a specific prefix
+ * The path prefix consists of the directory name followed by the entry name prefix
+ * Returns 1 if successful, 0 if the directory could not be listed or -1 on error
+ */
+int libewf_directory_listing_read_wide(
+     libewf_directory_listing_t *directory_listing,
+     const wchar_t *path_prefix,
+     size_t path_prefix_length,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBEWF_DIRECTORY_LISTING_WIDE_SUPPORT )
+	WIN32_FIND_DATAW find_data;
+
+	HANDLE find_handle           = INVALID_HANDLE_VALUE;
+	wchar_t *find_pattern        = NULL;
+	const wchar_t *entry_name    = NULL;
+	size_t directory_name_length = 0;
+	size_t entry_name_length     = 0;
+	size_t name_prefix_length    = 0;
+	int result                   = 0;
+#endif
+	static char *function        = "libewf_directory_listing_read_wide";
+
+	if( directory_listing == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory listing.",
+		 function );
+
+		return( -1 );
+	}
+	if( path_prefix == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path prefix.",
+		 function );
+
+		return( -1 );
+	}
+	if( path_prefix_length > (size_t) ( SSIZE_MAX - 2 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid path prefix length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	libewf_directory_listing_free_entry_names(
+	 directory_listing );
+
+#if defined( HAVE_LIBEWF_DIRECTORY_LISTING_WIDE_SUPPORT )
+	directory_name_length = libewf_directory_listing_get_directory_name_length_wide(
+	                         path_prefix,
+	                         path_prefix_length );
+
+	name_prefix_length = path_prefix_length - directory_name_length;
+
+	/* The find pattern consists of the directory name followed by "*"
+	 */
+	find_pattern = wide_string_allocate(
+	                directory_name_length + 2 );
+
+	if( find_pattern == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create find pattern.",
+		 function );
+
+		goto on_error;
+	}
+	if( directory_name_length > 0 )
+	{
+		if( wide_string_copy(
+		     find_pattern,
+		     path_prefix,
+		     directory_name_length ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy directory name.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	find_pattern[ directory_name_length ]     = (wchar_t) '*';
+	find_pattern[ directory_name_length + 1 ] = 0;
+
+	find_handle = FindFirstFileW(
+	               (LPCWSTR) find_pattern,
+	               &find_data );
+
+	memory_free(
+	 find_pattern );
+
+	find_pattern = NULL;
+
+	if( find_handle == INVALID_HANDLE_VALUE )
+	{
+		return( 0 );
+	}
+	do
+	{
+		if( ( find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY ) != 0 )
+		{
+			continue;
+		}
+		entry_name        = (const wchar_t *) find_data.cFileName;
+		entry_name_length = wide_string_length(
+		                     entry_name );
+
+		if( ( entry_name_length < name_prefix_length )
+		 || ( libewf_directory_listing_compare_wide_names(
+		       entry_name,
+		       &( path_prefix[ directory_name_length ] ),
+		       name_prefix_length ) != 0 ) )
+		{
+			continue;
+		}
+		if( libewf_directory_listing_append_entry_name_wide(
+		     directory_listing,
+		     entry_name,
+		     entry_name_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append entry name.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	while( FindNextFileW(
+	        find_handle,
+	        &find_data ) != 0 );
+
+	/* FindNextFile fails with ERROR_NO_MORE_FILES at the end of the directory
+	 */
+	if( GetLastError() == ERROR_NO_MORE_FILES )
+	{
+		result = 1;
+	}
+	FindClose(
+	 find_handle );
+
+	find_handle = INVALID_HANDLE_VALUE;
+
+	if( result != 1 )
+	{
+		libewf_directory_listing_free_entry_names(
+		 directory_listing );
+
+		return( 0 );
+	}
+	if( directory_listing->number_of_entries > 1 )
+	{
+		qsort(
+		 directory_listing->entry_names_wide,
+		 (size_t) directory_listing->number_of_entries,
+		 sizeof( wchar_t * ),
+		 &libewf_directory_listing_compare_entry_names_wide );
+	}
+	return( 1 );
+
+on_error:
+	if( find_handle != INVALID_HANDLE_VALUE )
+	{
+		FindClose(
+		 find_handle );
+	}
+	if( find_pattern != NULL )
+	{
+		memory_free(
+		 find_pattern );
+	}
+	libewf_directory_listing_free_entry_names(
+	 directory_listing );
+
+	return( -1 );
+#else
+	/* Listing a directory by a wide character name is only supported on Windows
+	 */
+	return( 0 );
+
+#endif /* defined( HAVE_LIBEWF_DIRECTORY_LISTING_WIDE_SUPPORT ) */
+}
+
+/* Determines if the directory listing contains the entry name of a wide path
+ * Only the entry name part of the path is compared
+ * Returns 1 if the listing contains the entry, 0 if not or -1 on error
+ */
+int libewf_directory_listing_has_entry_wide(
+     libewf_directory_listing_t *directory_listing,
+     const wchar_t *path,
+     size_t path_length,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBEWF_DIRECTORY_LISTING_WIDE_SUPPORT )
+	const wchar_t *entry_name    = NULL;
+	const wchar_t *name          = NULL;
+	size_t directory_name_length = 0;
+	size_t name_length           = 0;
+	int lower_entry_index        = 0;
+	int middle_entry_index       = 0;
+	int result                   = 0;
+	int upper_entry_index        = 0;
+#endif
+	static char *function        = "libewf_directory_listing_has_entry_wide";
+
+	if( directory_listing == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory listing.",
+		 function );
+
+		return( -1 );
+	}
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		return( -1 );
+	}
+	if( path_length > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid path length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( directory_listing->entry_names_wide == NULL )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_LIBEWF_DIRECTORY_LISTING_WIDE_SUPPORT )
+	directory_name_length = libewf_directory_listing_get_directory_name_length_wide(
+	                         path,
+	                         path_length );
+
+	name        = &( path[ directory_name_length ] );
+	name_length = path_length - directory_name_length;
+
+	lower_entry_index = 0;
+	upper_entry_index = directory_listing->number_of_entries;
+
+	while( lower_entry_index < upper_entry_index )
+	{
+		middle_entry_index = lower_entry_index + ( ( upper_entry_index - lower_entry_index ) / 2 );
+
+		entry_name = directory_listing->entry_names_wide[ middle_entry_index ];
+
+		result = libewf_directory_listing_compare_wide_names(
+		          name,
+		          entry_name,
+		          name_length );
+
+		/* The name is a prefix of the entry name and hence sorts before it
+		 */
+		if( ( result == 0 )
+		 && ( wide_string_length( entry_name ) > name_length ) )
+		{
+			result = -1;
+		}
+		if( result == 0 )
+		{
+			return( 1 );
+		}
+		else if( result < 0 )
+		{
+			upper_entry_index = middle_entry_index;
+		}
+		else
+		{
+			lower_entry_index = middle_entry_index + 1;
+		}
+	}
+#endif /* defined( HAVE_LIBEWF_DIRECTORY_LISTING_WIDE_SUPPORT ) */
+
+	return( 0 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
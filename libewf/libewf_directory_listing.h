@@ -0,0 +1,148 @@
+/*
+ * Directory listing functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_DIRECTORY_LISTING_H )
+#define _LIBEWF_DIRECTORY_LISTING_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( WINAPI ) || ( defined( HAVE_DIRENT_H ) && defined( HAVE_OPENDIR ) && defined( HAVE_READDIR ) && defined( HAVE_CLOSEDIR ) )
+#define HAVE_LIBEWF_DIRECTORY_LISTING_SUPPORT
+#endif
+
+#if defined( WINAPI ) && defined( HAVE_WIDE_CHARACTER_TYPE )
+#define HAVE_LIBEWF_DIRECTORY_LISTING_WIDE_SUPPORT
+#endif
+
+/* The minimum number of entry names the directory listing is grown with
+ */
+#define LIBEWF_DIRECTORY_LISTING_MINIMUM_NUMBER_OF_ENTRIES	64
+
+typedef struct libewf_directory_listing libewf_directory_listing_t;
+
+/* The directory listing contains the sorted names of the entries of a directory
+ * that start with a specific prefix, read with a single pass over the directory
+ */
+struct libewf_directory_listing
+{
+	/* The narrow entry names
+	 */
+	char **entry_names;
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+	/* The wide entry names
+	 */
+	wchar_t **entry_names_wide;
+#endif
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The number of allocated entries
+	 */
+	int number_of_allocated_entries;
+};
+
+int libewf_directory_listing_initialize(
+     libewf_directory_listing_t **directory_listing,
+     libcerror_error_t **error );
+
+int libewf_directory_listing_free(
+     libewf_directory_listing_t **directory_listing,
+     libcerror_error_t **error );
+
+void libewf_directory_listing_free_entry_names(
+      libewf_directory_listing_t *directory_listing );
+
+size_t libewf_directory_listing_get_directory_name_length(
+        const char *path,
+        size_t path_length );
+
+int libewf_directory_listing_compare_entry_names(
+     const void *first_entry_name,
+     const void *second_entry_name );
+
+int libewf_directory_listing_append_entry_name(
+     libewf_directory_listing_t *directory_listing,
+     const char *entry_name,
+     size_t entry_name_length,
+     libcerror_error_t **error );
+
+int libewf_directory_listing_read(
+     libewf_directory_listing_t *directory_listing,
+     const char *path_prefix,
+     size_t path_prefix_length,
+     libcerror_error_t **error );
+
+int libewf_directory_listing_has_entry(
+     libewf_directory_listing_t *directory_listing,
+     const char *path,
+     size_t path_length,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+#if defined( HAVE_LIBEWF_DIRECTORY_LISTING_WIDE_SUPPORT )
+
+size_t libewf_directory_listing_get_directory_name_length_wide(
+        const wchar_t *path,
+        size_t path_length );
+
+int libewf_directory_listing_compare_entry_names_wide(
+     const void *first_entry_name,
+     const void *second_entry_name );
+
+int libewf_directory_listing_append_entry_name_wide(
+     libewf_directory_listing_t *directory_listing,
+     const wchar_t *entry_name,
+     size_t entry_name_length,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_DIRECTORY_LISTING_WIDE_SUPPORT ) */
+
+int libewf_directory_listing_read_wide(
+     libewf_directory_listing_t *directory_listing,
+     const wchar_t *path_prefix,
+     size_t path_prefix_length,
+     libcerror_error_t **error );
+
+int libewf_directory_listing_has_entry_wide(
+     libewf_directory_listing_t *directory_listing,
+     const wchar_t *path,
+     size_t path_length,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_DIRECTORY_LISTING_H ) */
+
@@ -0,0 +1,2333 @@
+/*
+ * Disk chunk cache functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <byte_stream.h>
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "libewf_checksum.h"
+#include "libewf_disk_chunk_cache.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+
+const uint8_t libewf_disk_chunk_cache_file_signature[ 8 ] = {
+	'e', 'w', 'f', 'd', 'c', 'c', 'h', 'e' };
+
+/* Creates a disk chunk cache
+ * Make sure the value disk_chunk_cache is referencing, is set to NULL
+ * The number of entries is determined by the maximum size of the cache file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_disk_chunk_cache_initialize(
+     libewf_disk_chunk_cache_t **disk_chunk_cache,
+     size32_t chunk_size,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error )
+{
+	static char *function      = "libewf_disk_chunk_cache_initialize";
+	size_t array_size          = 0;
+	uint64_t number_of_entries = 0;
+	int bucket_index           = 0;
+
+	if( disk_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid disk chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *disk_chunk_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid disk chunk cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_size == 0 )
+	 || ( chunk_size > (size32_t) INT32_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_cache_size <= LIBEWF_DISK_CHUNK_CACHE_FILE_HEADER_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid maximum cache size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_entries = ( maximum_cache_size - LIBEWF_DISK_CHUNK_CACHE_FILE_HEADER_SIZE )
+	                  / ( (size64_t) chunk_size + LIBEWF_DISK_CHUNK_CACHE_FILE_ENTRY_SIZE );
+
+	if( number_of_entries == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid maximum cache size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_entries > (uint64_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libewf_disk_chunk_cache_entry_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid maximum cache size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	*disk_chunk_cache = memory_allocate_structure(
+	                     libewf_disk_chunk_cache_t );
+
+	if( *disk_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create disk chunk cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *disk_chunk_cache,
+	     0,
+	     sizeof( libewf_disk_chunk_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear disk chunk cache.",
+		 function );
+
+		memory_free(
+		 *disk_chunk_cache );
+
+		*disk_chunk_cache = NULL;
+
+		return( -1 );
+	}
+	( *disk_chunk_cache )->chunk_size        = chunk_size;
+	( *disk_chunk_cache )->number_of_entries = (int) number_of_entries;
+
+	array_size = sizeof( libewf_disk_chunk_cache_entry_t ) * (size_t) number_of_entries;
+
+	( *disk_chunk_cache )->entries = (libewf_disk_chunk_cache_entry_t *) memory_allocate(
+	                                                                      array_size );
+
+	if( ( *disk_chunk_cache )->entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries.",
+		 function );
+
+		goto on_error;
+	}
+	array_size = sizeof( int ) * (size_t) number_of_entries;
+
+	( *disk_chunk_cache )->buckets = (int *) memory_allocate(
+	                                          array_size );
+
+	if( ( *disk_chunk_cache )->buckets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buckets.",
+		 function );
+
+		goto on_error;
+	}
+	for( bucket_index = 0;
+	     bucket_index < ( *disk_chunk_cache )->number_of_entries;
+	     bucket_index++ )
+	{
+		( *disk_chunk_cache )->buckets[ bucket_index ] = -1;
+	}
+	if( libewf_disk_chunk_cache_clear_entries(
+	     *disk_chunk_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to clear entries.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *disk_chunk_cache != NULL )
+	{
+		if( ( *disk_chunk_cache )->buckets != NULL )
+		{
+			memory_free(
+			 ( *disk_chunk_cache )->buckets );
+		}
+		if( ( *disk_chunk_cache )->entries != NULL )
+		{
+			memory_free(
+			 ( *disk_chunk_cache )->entries );
+		}
+		memory_free(
+		 *disk_chunk_cache );
+
+		*disk_chunk_cache = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a disk chunk cache
+ * The cache file is closed if it is open
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_disk_chunk_cache_free(
+     libewf_disk_chunk_cache_t **disk_chunk_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_disk_chunk_cache_free";
+	int result            = 1;
+
+	if( disk_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid disk chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *disk_chunk_cache != NULL )
+	{
+		if( ( *disk_chunk_cache )->file_io_handle != NULL )
+		{
+			if( libewf_disk_chunk_cache_close(
+			     *disk_chunk_cache,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close disk chunk cache.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *disk_chunk_cache )->segment_numbers != NULL )
+		{
+			memory_free(
+			 ( *disk_chunk_cache )->segment_numbers );
+		}
+		memory_free(
+		 ( *disk_chunk_cache )->buckets );
+
+		memory_free(
+		 ( *disk_chunk_cache )->entries );
+
+		memory_free(
+		 *disk_chunk_cache );
+
+		*disk_chunk_cache = NULL;
+	}
+	return( result );
+}
+
+/* Clears the entries
+ * All entries are unused and linked in order of their index
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_disk_chunk_cache_clear_entries(
+     libewf_disk_chunk_cache_t *disk_chunk_cache,
+     libcerror_error_t **error )
+{
+	libewf_disk_chunk_cache_entry_t *entry = NULL;
+	static char *function                  = "libewf_disk_chunk_cache_clear_entries";
+	int entry_index                        = 0;
+
+	if( disk_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid disk chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     disk_chunk_cache->entries,
+	     0,
+	     sizeof( libewf_disk_chunk_cache_entry_t ) * disk_chunk_cache->number_of_entries ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entries.",
+		 function );
+
+		return( -1 );
+	}
+	for( entry_index = 0;
+	     entry_index < disk_chunk_cache->number_of_entries;
+	     entry_index++ )
+	{
+		entry = &( disk_chunk_cache->entries[ entry_index ] );
+
+		entry->next_bucket_entry_index = -1;
+		entry->previous_entry_index    = entry_index - 1;
+		entry->next_entry_index        = entry_index + 1;
+
+		disk_chunk_cache->buckets[ entry_index ] = -1;
+	}
+	disk_chunk_cache->entries[ disk_chunk_cache->number_of_entries - 1 ].next_entry_index = -1;
+
+	disk_chunk_cache->first_entry_index = 0;
+	disk_chunk_cache->last_entry_index  = disk_chunk_cache->number_of_entries - 1;
+	disk_chunk_cache->access_counter    = 0;
+
+	return( 1 );
+}
+
+/* Compares two entries by the value of the access counter of their last access
+ * The function is used with qsort
+ * Returns -1 if the first entry was accessed before, 1 if after or 0 if equal
+ */
+int libewf_disk_chunk_cache_compare_entries_by_last_access(
+     const void *first_entry,
+     const void *second_entry )
+{
+	const libewf_disk_chunk_cache_entry_t *first  = NULL;
+	const libewf_disk_chunk_cache_entry_t *second = NULL;
+
+	first  = *( (const libewf_disk_chunk_cache_entry_t **) first_entry );
+	second = *( (const libewf_disk_chunk_cache_entry_t **) second_entry );
+
+	if( first->last_access < second->last_access )
+	{
+		return( -1 );
+	}
+	else if( first->last_access > second->last_access )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Unlinks an entry from the least recently used list
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_disk_chunk_cache_unlink_entry(
+     libewf_disk_chunk_cache_t *disk_chunk_cache,
+     int entry_index,
+     libcerror_error_t **error )
+{
+	libewf_disk_chunk_cache_entry_t *entry = NULL;
+	static char *function                  = "libewf_disk_chunk_cache_unlink_entry";
+
+	if( disk_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid disk chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry_index < 0 )
+	 || ( entry_index >= disk_chunk_cache->number_of_entries ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	entry = &( disk_chunk_cache->entries[ entry_index ] );
+
+	if( entry->previous_entry_index != -1 )
+	{
+		disk_chunk_cache->entries[ entry->previous_entry_index ].next_entry_index = entry->next_entry_index;
+	}
+	else
+	{
+		disk_chunk_cache->first_entry_index = entry->next_entry_index;
+	}
+	if( entry->next_entry_index != -1 )
+	{
+		disk_chunk_cache->entries[ entry->next_entry_index ].previous_entry_index = entry->previous_entry_index;
+	}
+	else
+	{
+		disk_chunk_cache->last_entry_index = entry->previous_entry_index;
+	}
+	entry->previous_entry_index = -1;
+	entry->next_entry_index     = -1;
+
+	return( 1 );
+}
+
+/* Links an unlinked entry at the front (most recently used) or back (least recently used)
+ * of the least recently used list
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_disk_chunk_cache_link_entry(
+     libewf_disk_chunk_cache_t *disk_chunk_cache,
+     int entry_index,
+     uint8_t at_front,
+     libcerror_error_t **error )
+{
+	libewf_disk_chunk_cache_entry_t *entry = NULL;
+	static char *function                  = "libewf_disk_chunk_cache_link_entry";
+
+	if( disk_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid disk chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry_index < 0 )
+	 || ( entry_index >= disk_chunk_cache->number_of_entries ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	entry = &( disk_chunk_cache->entries[ entry_index ] );
+
+	if( at_front != 0 )
+	{
+		entry->previous_entry_index = -1;
+		entry->next_entry_index     = disk_chunk_cache->first_entry_index;
+
+		if( disk_chunk_cache->first_entry_index != -1 )
+		{
+			disk_chunk_cache->entries[ disk_chunk_cache->first_entry_index ].previous_entry_index = entry_index;
+		}
+		else
+		{
+			disk_chunk_cache->last_entry_index = entry_index;
+		}
+		disk_chunk_cache->first_entry_index = entry_index;
+	}
+	else
+	{
+		entry->previous_entry_index = disk_chunk_cache->last_entry_index;
+		entry->next_entry_index     = -1;
+
+		if( disk_chunk_cache->last_entry_index != -1 )
+		{
+			disk_chunk_cache->entries[ disk_chunk_cache->last_entry_index ].next_entry_index = entry_index;
+		}
+		else
+		{
+			disk_chunk_cache->first_entry_index = entry_index;
+		}
+		disk_chunk_cache->last_entry_index = entry_index;
+	}
+	return( 1 );
+}
+
+/* Retrieves the index of the hash bucket of a specific chunk
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_disk_chunk_cache_get_bucket_index(
+     libewf_disk_chunk_cache_t *disk_chunk_cache,
+     uint32_t segment_number,
+     off64_t chunk_offset,
+     int *bucket_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_disk_chunk_cache_get_bucket_index";
+	uint64_t hash_value   = 0;
+
+	if( disk_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid disk chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( bucket_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bucket index.",
+		 function );
+
+		return( -1 );
+	}
+	/* Fibonacci hashing of the chunk offset combined with the segment number
+	 */
+	hash_value = ( (uint64_t) chunk_offset ^ ( (uint64_t) segment_number << 48 ) )
+	           * 0x9e3779b97f4a7c15ULL;
+
+	*bucket_index = (int) ( ( hash_value >> 32 ) % (uint64_t) disk_chunk_cache->number_of_entries );
+
+	return( 1 );
+}
+
+/* Inserts an used entry in its hash bucket
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_disk_chunk_cache_insert_entry_in_bucket(
+     libewf_disk_chunk_cache_t *disk_chunk_cache,
+     int entry_index,
+     libcerror_error_t **error )
+{
+	libewf_disk_chunk_cache_entry_t *entry = NULL;
+	static char *function                  = "libewf_disk_chunk_cache_insert_entry_in_bucket";
+	int bucket_index                       = 0;
+
+	if( disk_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid disk chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry_index < 0 )
+	 || ( entry_index >= disk_chunk_cache->number_of_entries ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	entry = &( disk_chunk_cache->entries[ entry_index ] );
+
+	if( libewf_disk_chunk_cache_get_bucket_index(
+	     disk_chunk_cache,
+	     entry->segment_number,
+	     entry->chunk_offset,
+	     &bucket_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve bucket index.",
+		 function );
+
+		return( -1 );
+	}
+	entry->next_bucket_entry_index = disk_chunk_cache->buckets[ bucket_index ];
+
+	disk_chunk_cache->buckets[ bucket_index ] = entry_index;
+
+	return( 1 );
+}
+
+/* Removes an used entry from its hash bucket
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_disk_chunk_cache_remove_entry_from_bucket(
+     libewf_disk_chunk_cache_t *disk_chunk_cache,
+     int entry_index,
+     libcerror_error_t **error )
+{
+	libewf_disk_chunk_cache_entry_t *entry = NULL;
+	static char *function                  = "libewf_disk_chunk_cache_remove_entry_from_bucket";
+	int bucket_entry_index                 = 0;
+	int bucket_index                       = 0;
+
+	if( disk_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid disk chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry_index < 0 )
+	 || ( entry_index >= disk_chunk_cache->number_of_entries ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	entry = &( disk_chunk_cache->entries[ entry_index ] );
+
+	if( libewf_disk_chunk_cache_get_bucket_index(
+	     disk_chunk_cache,
+	     entry->segment_number,
+	     entry->chunk_offset,
+	     &bucket_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve bucket index.",
+		 function );
+
+		return( -1 );
+	}
+	if( disk_chunk_cache->buckets[ bucket_index ] == entry_index )
+	{
+		disk_chunk_cache->buckets[ bucket_index ] = entry->next_bucket_entry_index;
+	}
+	else
+	{
+		bucket_entry_index = disk_chunk_cache->buckets[ bucket_index ];
+
+		while( bucket_entry_index != -1 )
+		{
+			if( disk_chunk_cache->entries[ bucket_entry_index ].next_bucket_entry_index == entry_index )
+			{
+				disk_chunk_cache->entries[ bucket_entry_index ].next_bucket_entry_index = entry->next_bucket_entry_index;
+
+				break;
+			}
+			bucket_entry_index = disk_chunk_cache->entries[ bucket_entry_index ].next_bucket_entry_index;
+		}
+	}
+	entry->next_bucket_entry_index = -1;
+
+	return( 1 );
+}
+
+/* Sets the segment number of a file IO pool entry
+ * The chunks in the cache file are identified by segment number since
+ * the file IO pool entries can differ between handles
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_disk_chunk_cache_set_segment_number(
+     libewf_disk_chunk_cache_t *disk_chunk_cache,
+     int file_io_pool_entry,
+     uint32_t segment_number,
+     libcerror_error_t **error )
+{
+	uint32_t *segment_numbers = NULL;
+	static char *function     = "libewf_disk_chunk_cache_set_segment_number";
+	size_t array_size         = 0;
+
+	if( disk_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid disk chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_io_pool_entry < 0 )
+	 || ( (size_t) file_io_pool_entry >= ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( uint32_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file IO pool entry value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool_entry >= disk_chunk_cache->number_of_file_io_pool_entries )
+	{
+		array_size = sizeof( uint32_t ) * (size_t) ( file_io_pool_entry + 1 );
+
+		segment_numbers = (uint32_t *) memory_reallocate(
+		                                disk_chunk_cache->segment_numbers,
+		                                array_size );
+
+		if( segment_numbers == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize segment numbers.",
+			 function );
+
+			return( -1 );
+		}
+		disk_chunk_cache->segment_numbers = segment_numbers;
+
+		if( memory_set(
+		     &( segment_numbers[ disk_chunk_cache->number_of_file_io_pool_entries ] ),
+		     0,
+		     sizeof( uint32_t ) * (size_t) ( file_io_pool_entry + 1 - disk_chunk_cache->number_of_file_io_pool_entries ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear segment numbers.",
+			 function );
+
+			return( -1 );
+		}
+		disk_chunk_cache->number_of_file_io_pool_entries = file_io_pool_entry + 1;
+	}
+	disk_chunk_cache->segment_numbers[ file_io_pool_entry ] = segment_number;
+
+	return( 1 );
+}
+
+/* Opens the cache file
+ * The cache file is created if it does not exist. Its entries are discarded if it was
+ * created for another segment file set, with another chunk size or another maximum size
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_disk_chunk_cache_open(
+     libewf_disk_chunk_cache_t *disk_chunk_cache,
+     const char *filename,
+     size_t filename_length,
+     const uint8_t *set_identifier,
+     size_t set_identifier_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_disk_chunk_cache_open";
+	int result            = 0;
+
+	if( disk_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid disk chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( disk_chunk_cache->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid disk chunk cache - file IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( set_identifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid set identifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( set_identifier_size != 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid set identifier size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     disk_chunk_cache->set_identifier,
+	     set_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy set identifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_initialize(
+	     &( disk_chunk_cache->file_io_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_set_name(
+	     disk_chunk_cache->file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	result = libbfio_handle_exists(
+	          disk_chunk_cache->file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to determine if cache file exists.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		if( libbfio_handle_open(
+		     disk_chunk_cache->file_io_handle,
+		     LIBBFIO_OPEN_READ_WRITE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open cache file.",
+			 function );
+
+			goto on_error;
+		}
+		result = libewf_disk_chunk_cache_read_file_entries(
+		          disk_chunk_cache,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read cache file entries.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			if( libbfio_handle_close(
+			     disk_chunk_cache->file_io_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close cache file.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	/* A cache file that does not exist or that cannot be used is (re)created
+	 */
+	if( result == 0 )
+	{
+		if( libewf_disk_chunk_cache_clear_entries(
+		     disk_chunk_cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to clear entries.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbfio_handle_open(
+		     disk_chunk_cache->file_io_handle,
+		     LIBBFIO_OPEN_READ_WRITE_TRUNCATE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to create cache file.",
+			 function );
+
+			goto on_error;
+		}
+		if( libewf_disk_chunk_cache_write_file_entries(
+		     disk_chunk_cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write cache file entries.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	disk_chunk_cache->number_of_hits   = 0;
+	disk_chunk_cache->number_of_misses = 0;
+
+	return( 1 );
+
+on_error:
+	if( disk_chunk_cache->file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &( disk_chunk_cache->file_io_handle ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the header and entries of the cache file
+ * The least recently used list is rebuilt from the value of the access counter of the entries
+ * Returns 1 if successful, 0 if the cache file cannot be used or -1 on error
+ */
+int libewf_disk_chunk_cache_read_file_entries(
+     libewf_disk_chunk_cache_t *disk_chunk_cache,
+     libcerror_error_t **error )
+{
+	uint8_t file_header[ LIBEWF_DISK_CHUNK_CACHE_FILE_HEADER_SIZE ];
+
+	libewf_disk_chunk_cache_entry_t **sorted_entries = NULL;
+	libewf_disk_chunk_cache_entry_t *entry           = NULL;
+	uint8_t *file_entries                            = NULL;
+	uint8_t *file_entry                              = NULL;
+	static char *function                            = "libewf_disk_chunk_cache_read_file_entries";
+	size_t file_entries_size                         = 0;
+	ssize_t read_count                               = 0;
+	uint32_t chunk_size                              = 0;
+	uint32_t format_version                          = 0;
+	uint32_t number_of_entries                       = 0;
+	int entry_index                                  = 0;
+
+	if( disk_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid disk chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_seek_offset(
+	     disk_chunk_cache->file_io_handle,
+	     0,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek file header offset: 0.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libbfio_handle_read_buffer(
+	              disk_chunk_cache->file_io_handle,
+	              file_header,
+	              LIBEWF_DISK_CHUNK_CACHE_FILE_HEADER_SIZE,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file header.",
+		 function );
+
+		goto on_error;
+	}
+	if( read_count != (ssize_t) LIBEWF_DISK_CHUNK_CACHE_FILE_HEADER_SIZE )
+	{
+		return( 0 );
+	}
+	if( memory_compare(
+	     file_header,
+	     libewf_disk_chunk_cache_file_signature,
+	     8 ) != 0 )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 &( file_header[ 8 ] ),
+	 format_version );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( file_header[ 12 ] ),
+	 chunk_size );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( file_header[ 16 ] ),
+	 number_of_entries );
+
+	if( ( format_version != LIBEWF_DISK_CHUNK_CACHE_FILE_FORMAT_VERSION )
+	 || ( chunk_size != (uint32_t) disk_chunk_cache->chunk_size )
+	 || ( number_of_entries != (uint32_t) disk_chunk_cache->number_of_entries ) )
+	{
+		return( 0 );
+	}
+	if( memory_compare(
+	     &( file_header[ 24 ] ),
+	     disk_chunk_cache->set_identifier,
+	     16 ) != 0 )
+	{
+		return( 0 );
+	}
+	file_entries_size = (size_t) number_of_entries * LIBEWF_DISK_CHUNK_CACHE_FILE_ENTRY_SIZE;
+
+	if( file_entries_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid file entries size value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	file_entries = (uint8_t *) memory_allocate(
+	                            file_entries_size );
+
+	if( file_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file entries.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libbfio_handle_read_buffer(
+	              disk_chunk_cache->file_io_handle,
+	              file_entries,
+	              file_entries_size,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( read_count != (ssize_t) file_entries_size )
+	{
+		memory_free(
+		 file_entries );
+
+		return( 0 );
+	}
+	sorted_entries = (libewf_disk_chunk_cache_entry_t **) memory_allocate(
+	                                                       sizeof( libewf_disk_chunk_cache_entry_t * ) * disk_chunk_cache->number_of_entries );
+
+	if( sorted_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create sorted entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_disk_chunk_cache_clear_entries(
+	     disk_chunk_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to clear entries.",
+		 function );
+
+		goto on_error;
+	}
+	file_entry = file_entries;
+
+	for( entry_index = 0;
+	     entry_index < disk_chunk_cache->number_of_entries;
+	     entry_index++ )
+	{
+		entry = &( disk_chunk_cache->entries[ entry_index ] );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 &( file_entry[ 0 ] ),
+		 entry->segment_number );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 &( file_entry[ 4 ] ),
+		 entry->data_size );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 &( file_entry[ 8 ] ),
+		 entry->chunk_offset );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 &( file_entry[ 16 ] ),
+		 entry->last_access );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 &( file_entry[ 24 ] ),
+		 entry->checksum );
+
+		file_entry += LIBEWF_DISK_CHUNK_CACHE_FILE_ENTRY_SIZE;
+
+		/* Entries with invalid values are treated as unused
+		 */
+		if( ( entry->segment_number != 0 )
+		 && ( ( entry->data_size == 0 )
+		  ||  ( entry->data_size > (uint32_t) disk_chunk_cache->chunk_size )
+		  ||  ( entry->chunk_offset < 0 ) ) )
+		{
+			entry->segment_number = 0;
+		}
+		if( entry->segment_number == 0 )
+		{
+			entry->last_access = 0;
+		}
+		else
+		{
+			if( libewf_disk_chunk_cache_insert_entry_in_bucket(
+			     disk_chunk_cache,
+			     entry_index,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to insert entry: %d in bucket.",
+				 function,
+				 entry_index );
+
+				goto on_error;
+			}
+			if( entry->last_access > disk_chunk_cache->access_counter )
+			{
+				disk_chunk_cache->access_counter = entry->last_access;
+			}
+		}
+		sorted_entries[ entry_index ] = entry;
+	}
+	memory_free(
+	 file_entries );
+
+	file_entries = NULL;
+
+	/* Rebuild the least recently used list where the unused entries, with a last access of 0,
+	 * end up at the back
+	 */
+	qsort(
+	 sorted_entries,
+	 (size_t) disk_chunk_cache->number_of_entries,
+	 sizeof( libewf_disk_chunk_cache_entry_t * ),
+	 &libewf_disk_chunk_cache_compare_entries_by_last_access );
+
+	disk_chunk_cache->first_entry_index = -1;
+	disk_chunk_cache->last_entry_index  = -1;
+
+	for( entry_index = 0;
+	     entry_index < disk_chunk_cache->number_of_entries;
+	     entry_index++ )
+	{
+		if( libewf_disk_chunk_cache_link_entry(
+		     disk_chunk_cache,
+		     (int) ( sorted_entries[ entry_index ] - disk_chunk_cache->entries ),
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to link entry.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	memory_free(
+	 sorted_entries );
+
+	return( 1 );
+
+on_error:
+	if( sorted_entries != NULL )
+	{
+		memory_free(
+		 sorted_entries );
+	}
+	if( file_entries != NULL )
+	{
+		memory_free(
+		 file_entries );
+	}
+	return( -1 );
+}
+
+/* Writes the header and entries of the cache file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_disk_chunk_cache_write_file_entries(
+     libewf_disk_chunk_cache_t *disk_chunk_cache,
+     libcerror_error_t **error )
+{
+	uint8_t file_header[ LIBEWF_DISK_CHUNK_CACHE_FILE_HEADER_SIZE ];
+
+	libewf_disk_chunk_cache_entry_t *entry = NULL;
+	uint8_t *file_entries                  = NULL;
+	uint8_t *file_entry                    = NULL;
+	static char *function                  = "libewf_disk_chunk_cache_write_file_entries";
+	size_t file_entries_size               = 0;
+	ssize_t write_count                    = 0;
+	int entry_index                        = 0;
+
+	if( disk_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid disk chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	file_entries_size = (size_t) disk_chunk_cache->number_of_entries * LIBEWF_DISK_CHUNK_CACHE_FILE_ENTRY_SIZE;
+
+	if( file_entries_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid file entries size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     file_header,
+	     0,
+	     LIBEWF_DISK_CHUNK_CACHE_FILE_HEADER_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file header.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     file_header,
+	     libewf_disk_chunk_cache_file_signature,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy file signature.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 &( file_header[ 8 ] ),
+	 LIBEWF_DISK_CHUNK_CACHE_FILE_FORMAT_VERSION );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( file_header[ 12 ] ),
+	 disk_chunk_cache->chunk_size );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( file_header[ 16 ] ),
+	 disk_chunk_cache->number_of_entries );
+
+	if( memory_copy(
+	     &( file_header[ 24 ] ),
+	     disk_chunk_cache->set_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy set identifier.",
+		 function );
+
+		return( -1 );
+	}
+	file_entries = (uint8_t *) memory_allocate(
+	                            file_entries_size );
+
+	if( file_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     file_entries,
+	     0,
+	     file_entries_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file entries.",
+		 function );
+
+		goto on_error;
+	}
+	file_entry = file_entries;
+
+	for( entry_index = 0;
+	     entry_index < disk_chunk_cache->number_of_entries;
+	     entry_index++ )
+	{
+		entry = &( disk_chunk_cache->entries[ entry_index ] );
+
+		if( entry->segment_number != 0 )
+		{
+			byte_stream_copy_from_uint32_little_endian(
+			 &( file_entry[ 0 ] ),
+			 entry->segment_number );
+
+			byte_stream_copy_from_uint32_little_endian(
+			 &( file_entry[ 4 ] ),
+			 entry->data_size );
+
+			byte_stream_copy_from_uint64_little_endian(
+			 &( file_entry[ 8 ] ),
+			 entry->chunk_offset );
+
+			byte_stream_copy_from_uint64_little_endian(
+			 &( file_entry[ 16 ] ),
+			 entry->last_access );
+
+			byte_stream_copy_from_uint32_little_endian(
+			 &( file_entry[ 24 ] ),
+			 entry->checksum );
+		}
+		file_entry += LIBEWF_DISK_CHUNK_CACHE_FILE_ENTRY_SIZE;
+	}
+	if( libbfio_handle_seek_offset(
+	     disk_chunk_cache->file_io_handle,
+	     0,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek file header offset: 0.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libbfio_handle_write_buffer(
+	               disk_chunk_cache->file_io_handle,
+	               file_header,
+	               LIBEWF_DISK_CHUNK_CACHE_FILE_HEADER_SIZE,
+	               error );
+
+	if( write_count != (ssize_t) LIBEWF_DISK_CHUNK_CACHE_FILE_HEADER_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write file header.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libbfio_handle_write_buffer(
+	               disk_chunk_cache->file_io_handle,
+	               file_entries,
+	               file_entries_size,
+	               error );
+
+	if( write_count != (ssize_t) file_entries_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write file entries.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 file_entries );
+
+	return( 1 );
+
+on_error:
+	if( file_entries != NULL )
+	{
+		memory_free(
+		 file_entries );
+	}
+	return( -1 );
+}
+
+/* Writes a specific entry of the cache file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_disk_chunk_cache_write_file_entry(
+     libewf_disk_chunk_cache_t *disk_chunk_cache,
+     int entry_index,
+     libcerror_error_t **error )
+{
+	uint8_t file_entry[ LIBEWF_DISK_CHUNK_CACHE_FILE_ENTRY_SIZE ];
+
+	libewf_disk_chunk_cache_entry_t *entry = NULL;
+	static char *function                  = "libewf_disk_chunk_cache_write_file_entry";
+	off64_t file_entry_offset              = 0;
+	ssize_t write_count                    = 0;
+
+	if( disk_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid disk chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry_index < 0 )
+	 || ( entry_index >= disk_chunk_cache->number_of_entries ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	entry = &( disk_chunk_cache->entries[ entry_index ] );
+
+	if( memory_set(
+	     file_entry,
+	     0,
+	     LIBEWF_DISK_CHUNK_CACHE_FILE_ENTRY_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry->segment_number != 0 )
+	{
+		byte_stream_copy_from_uint32_little_endian(
+		 &( file_entry[ 0 ] ),
+		 entry->segment_number );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 &( file_entry[ 4 ] ),
+		 entry->data_size );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 &( file_entry[ 8 ] ),
+		 entry->chunk_offset );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 &( file_entry[ 16 ] ),
+		 entry->last_access );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 &( file_entry[ 24 ] ),
+		 entry->checksum );
+	}
+	file_entry_offset = LIBEWF_DISK_CHUNK_CACHE_FILE_HEADER_SIZE
+	                  + ( (off64_t) entry_index * LIBEWF_DISK_CHUNK_CACHE_FILE_ENTRY_SIZE );
+
+	if( libbfio_handle_seek_offset(
+	     disk_chunk_cache->file_io_handle,
+	     file_entry_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek file entry offset: 0x%08" PRIx64 ".",
+		 function,
+		 file_entry_offset );
+
+		return( -1 );
+	}
+	write_count = libbfio_handle_write_buffer(
+	               disk_chunk_cache->file_io_handle,
+	               file_entry,
+	               LIBEWF_DISK_CHUNK_CACHE_FILE_ENTRY_SIZE,
+	               error );
+
+	if( write_count != (ssize_t) LIBEWF_DISK_CHUNK_CACHE_FILE_ENTRY_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write file entry: %d.",
+		 function,
+		 entry_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Closes the cache file
+ * The entries are written so that the order in which they were last accessed is retained
+ * Returns 0 if successful or -1 on error
+ */
+int libewf_disk_chunk_cache_close(
+     libewf_disk_chunk_cache_t *disk_chunk_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_disk_chunk_cache_close";
+	int result            = 0;
+
+	if( disk_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid disk chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( disk_chunk_cache->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid disk chunk cache - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_disk_chunk_cache_write_file_entries(
+	     disk_chunk_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write cache file entries.",
+		 function );
+
+		result = -1;
+	}
+	if( libbfio_handle_close(
+	     disk_chunk_cache->file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close cache file.",
+		 function );
+
+		result = -1;
+	}
+	if( libbfio_handle_free(
+	     &( disk_chunk_cache->file_io_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Retrieves the index of the entry of a specific chunk
+ * Returns 1 if successful, 0 if no such entry or -1 on error
+ */
+int libewf_disk_chunk_cache_get_entry_index(
+     libewf_disk_chunk_cache_t *disk_chunk_cache,
+     uint32_t segment_number,
+     off64_t chunk_offset,
+     int *entry_index,
+     libcerror_error_t **error )
+{
+	libewf_disk_chunk_cache_entry_t *entry = NULL;
+	static char *function                  = "libewf_disk_chunk_cache_get_entry_index";
+	int bucket_entry_index                 = 0;
+	int bucket_index                       = 0;
+
+	if( disk_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid disk chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry index.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_disk_chunk_cache_get_bucket_index(
+	     disk_chunk_cache,
+	     segment_number,
+	     chunk_offset,
+	     &bucket_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve bucket index.",
+		 function );
+
+		return( -1 );
+	}
+	bucket_entry_index = disk_chunk_cache->buckets[ bucket_index ];
+
+	while( bucket_entry_index != -1 )
+	{
+		entry = &( disk_chunk_cache->entries[ bucket_entry_index ] );
+
+		if( ( entry->segment_number == segment_number )
+		 && ( entry->chunk_offset == chunk_offset ) )
+		{
+			*entry_index = bucket_entry_index;
+
+			return( 1 );
+		}
+		bucket_entry_index = entry->next_bucket_entry_index;
+	}
+	return( 0 );
+}
+
+/* Reads the unpacked data of a specific chunk from the cache file
+ * The chunk is identified by the file IO pool entry and offset of the (packed) chunk
+ * An entry of which the data does not match its checksum is discarded
+ * Returns 1 if successful, 0 if the chunk is not in the cache or -1 on error
+ */
+int libewf_disk_chunk_cache_read_chunk_data(
+     libewf_disk_chunk_cache_t *disk_chunk_cache,
+     int file_io_pool_entry,
+     off64_t chunk_offset,
+     uint8_t *data,
+     size_t data_size,
+     size_t *chunk_data_size,
+     libcerror_error_t **error )
+{
+	libewf_disk_chunk_cache_entry_t *entry = NULL;
+	static char *function                  = "libewf_disk_chunk_cache_read_chunk_data";
+	off64_t data_offset                    = 0;
+	ssize_t read_count                     = 0;
+	uint32_t calculated_checksum           = 0;
+	uint32_t segment_number                = 0;
+	int entry_index                        = 0;
+	int result                             = 0;
+
+	if( disk_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid disk chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( disk_chunk_cache->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid disk chunk cache - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_io_pool_entry >= 0 )
+	 && ( file_io_pool_entry < disk_chunk_cache->number_of_file_io_pool_entries ) )
+	{
+		segment_number = disk_chunk_cache->segment_numbers[ file_io_pool_entry ];
+	}
+	if( segment_number != 0 )
+	{
+		result = libewf_disk_chunk_cache_get_entry_index(
+		          disk_chunk_cache,
+		          segment_number,
+		          chunk_offset,
+		          &entry_index,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry index.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( result == 0 )
+	{
+		disk_chunk_cache->number_of_misses += 1;
+
+		return( 0 );
+	}
+	entry = &( disk_chunk_cache->entries[ entry_index ] );
+
+	if( (size_t) entry->data_size > data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid data size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	data_offset = LIBEWF_DISK_CHUNK_CACHE_FILE_HEADER_SIZE
+	            + ( (off64_t) disk_chunk_cache->number_of_entries * LIBEWF_DISK_CHUNK_CACHE_FILE_ENTRY_SIZE )
+	            + ( (off64_t) entry_index * disk_chunk_cache->chunk_size );
+
+	if( libbfio_handle_seek_offset(
+	     disk_chunk_cache->file_io_handle,
+	     data_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek chunk data offset: 0x%08" PRIx64 " in cache file.",
+		 function,
+		 data_offset );
+
+		return( -1 );
+	}
+	read_count = libbfio_handle_read_buffer(
+	              disk_chunk_cache->file_io_handle,
+	              data,
+	              (size_t) entry->data_size,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk data at offset: 0x%08" PRIx64 " from cache file.",
+		 function,
+		 data_offset );
+
+		return( -1 );
+	}
+	if( read_count == (ssize_t) entry->data_size )
+	{
+		if( libewf_checksum_calculate_adler32(
+		     &calculated_checksum,
+		     data,
+		     (size_t) entry->data_size,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to calculate checksum.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* An entry of which the data was not (completely) written is discarded
+	 */
+	if( ( read_count != (ssize_t) entry->data_size )
+	 || ( calculated_checksum != entry->checksum ) )
+	{
+		if( libewf_disk_chunk_cache_remove_entry_from_bucket(
+		     disk_chunk_cache,
+		     entry_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove entry: %d from bucket.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		entry->segment_number = 0;
+		entry->last_access    = 0;
+
+		if( libewf_disk_chunk_cache_unlink_entry(
+		     disk_chunk_cache,
+		     entry_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to unlink entry: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( libewf_disk_chunk_cache_link_entry(
+		     disk_chunk_cache,
+		     entry_index,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to link entry: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( libewf_disk_chunk_cache_write_file_entry(
+		     disk_chunk_cache,
+		     entry_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write file entry: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		disk_chunk_cache->number_of_misses += 1;
+
+		return( 0 );
+	}
+	if( libewf_disk_chunk_cache_unlink_entry(
+	     disk_chunk_cache,
+	     entry_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to unlink entry: %d.",
+		 function,
+		 entry_index );
+
+		return( -1 );
+	}
+	if( libewf_disk_chunk_cache_link_entry(
+	     disk_chunk_cache,
+	     entry_index,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to link entry: %d.",
+		 function,
+		 entry_index );
+
+		return( -1 );
+	}
+	/* The last access is written to the cache file when it is closed
+	 */
+	disk_chunk_cache->access_counter += 1;
+
+	entry->last_access = disk_chunk_cache->access_counter;
+
+	disk_chunk_cache->number_of_hits += 1;
+
+	*chunk_data_size = (size_t) entry->data_size;
+
+	return( 1 );
+}
+
+/* Writes the unpacked data of a specific chunk to the cache file
+ * The chunk is identified by the file IO pool entry and offset of the (packed) chunk
+ * The least recently used entry is evicted to store the chunk data
+ * Returns 1 if successful, 0 if the chunk data cannot be stored in the cache or -1 on error
+ */
+int libewf_disk_chunk_cache_write_chunk_data(
+     libewf_disk_chunk_cache_t *disk_chunk_cache,
+     int file_io_pool_entry,
+     off64_t chunk_offset,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libewf_disk_chunk_cache_entry_t *entry = NULL;
+	static char *function                  = "libewf_disk_chunk_cache_write_chunk_data";
+	off64_t data_offset                    = 0;
+	ssize_t write_count                    = 0;
+	uint32_t checksum                      = 0;
+	uint32_t segment_number                = 0;
+	int entry_index                        = 0;
+	int result                             = 0;
+
+	if( disk_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid disk chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( disk_chunk_cache->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid disk chunk cache - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid chunk offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_io_pool_entry >= 0 )
+	 && ( file_io_pool_entry < disk_chunk_cache->number_of_file_io_pool_entries ) )
+	{
+		segment_number = disk_chunk_cache->segment_numbers[ file_io_pool_entry ];
+	}
+	if( ( segment_number == 0 )
+	 || ( data_size == 0 )
+	 || ( data_size > (size_t) disk_chunk_cache->chunk_size ) )
+	{
+		return( 0 );
+	}
+	result = libewf_disk_chunk_cache_get_entry_index(
+	          disk_chunk_cache,
+	          segment_number,
+	          chunk_offset,
+	          &entry_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry index.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		return( 1 );
+	}
+	entry_index = disk_chunk_cache->last_entry_index;
+	entry       = &( disk_chunk_cache->entries[ entry_index ] );
+
+	if( entry->segment_number != 0 )
+	{
+		if( libewf_disk_chunk_cache_remove_entry_from_bucket(
+		     disk_chunk_cache,
+		     entry_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove entry: %d from bucket.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		entry->segment_number = 0;
+	}
+	if( libewf_checksum_calculate_adler32(
+	     &checksum,
+	     data,
+	     data_size,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate checksum.",
+		 function );
+
+		return( -1 );
+	}
+	data_offset = LIBEWF_DISK_CHUNK_CACHE_FILE_HEADER_SIZE
+	            + ( (off64_t) disk_chunk_cache->number_of_entries * LIBEWF_DISK_CHUNK_CACHE_FILE_ENTRY_SIZE )
+	            + ( (off64_t) entry_index * disk_chunk_cache->chunk_size );
+
+	if( libbfio_handle_seek_offset(
+	     disk_chunk_cache->file_io_handle,
+	     data_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek chunk data offset: 0x%08" PRIx64 " in cache file.",
+		 function,
+		 data_offset );
+
+		return( -1 );
+	}
+	write_count = libbfio_handle_write_buffer(
+	               disk_chunk_cache->file_io_handle,
+	               data,
+	               data_size,
+	               error );
+
+	if( write_count != (ssize_t) data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write chunk data at offset: 0x%08" PRIx64 " to cache file.",
+		 function,
+		 data_offset );
+
+		return( -1 );
+	}
+	disk_chunk_cache->access_counter += 1;
+
+	entry->segment_number = segment_number;
+	entry->chunk_offset   = chunk_offset;
+	entry->data_size      = (uint32_t) data_size;
+	entry->checksum       = checksum;
+	entry->last_access    = disk_chunk_cache->access_counter;
+
+	/* The entry is written after the chunk data so that an interrupted write
+	 * results in an entry that does not match its checksum
+	 */
+	if( libewf_disk_chunk_cache_write_file_entry(
+	     disk_chunk_cache,
+	     entry_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write file entry: %d.",
+		 function,
+		 entry_index );
+
+		return( -1 );
+	}
+	if( libewf_disk_chunk_cache_insert_entry_in_bucket(
+	     disk_chunk_cache,
+	     entry_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to insert entry: %d in bucket.",
+		 function,
+		 entry_index );
+
+		return( -1 );
+	}
+	if( libewf_disk_chunk_cache_unlink_entry(
+	     disk_chunk_cache,
+	     entry_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to unlink entry: %d.",
+		 function,
+		 entry_index );
+
+		return( -1 );
+	}
+	if( libewf_disk_chunk_cache_link_entry(
+	     disk_chunk_cache,
+	     entry_index,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to link entry: %d.",
+		 function,
+		 entry_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,255 @@
+/*
+ * Disk chunk cache functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_DISK_CHUNK_CACHE_H )
+#define _LIBEWF_DISK_CHUNK_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The size of the disk chunk cache file header
+ */
+#define LIBEWF_DISK_CHUNK_CACHE_FILE_HEADER_SIZE	64
+
+/* The size of a disk chunk cache file entry
+ */
+#define LIBEWF_DISK_CHUNK_CACHE_FILE_ENTRY_SIZE		32
+
+/* The disk chunk cache file format version
+ */
+#define LIBEWF_DISK_CHUNK_CACHE_FILE_FORMAT_VERSION	1
+
+typedef struct libewf_disk_chunk_cache_entry libewf_disk_chunk_cache_entry_t;
+
+struct libewf_disk_chunk_cache_entry
+{
+	/* The segment number of the chunk, where 0 represents unused
+	 */
+	uint32_t segment_number;
+
+	/* The offset of the (packed) chunk in the segment file
+	 */
+	off64_t chunk_offset;
+
+	/* The size of the unpacked chunk data
+	 */
+	uint32_t data_size;
+
+	/* The Adler-32 checksum of the unpacked chunk data
+	 */
+	uint32_t checksum;
+
+	/* The value of the access counter of the last access
+	 */
+	uint64_t last_access;
+
+	/* The index of the next entry in the same hash bucket, where -1 represents none
+	 */
+	int next_bucket_entry_index;
+
+	/* The index of the previous (more recently used) entry, where -1 represents none
+	 */
+	int previous_entry_index;
+
+	/* The index of the next (less recently used) entry, where -1 represents none
+	 */
+	int next_entry_index;
+};
+
+typedef struct libewf_disk_chunk_cache libewf_disk_chunk_cache_t;
+
+/* The disk chunk cache is a persistent second level cache of unpacked chunk data
+ * in a local cache file, that is consulted when chunk data is not in the chunks cache.
+ * The cache file consists of a header, a table of entries and a slot of chunk size
+ * per entry. The chunk data is identified by the segment number and the offset of
+ * the chunk in the segment file and the cache file is bound to the segment file set
+ * identifier, the size of the cache file is bounded by the maximum number of entries
+ * where the least recently used entry is evicted first
+ */
+struct libewf_disk_chunk_cache
+{
+	/* The chunk size
+	 */
+	size32_t chunk_size;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The entries
+	 */
+	libewf_disk_chunk_cache_entry_t *entries;
+
+	/* The hash buckets that contain the index of the first entry, where -1 represents none
+	 */
+	int *buckets;
+
+	/* The index of the most recently used entry
+	 */
+	int first_entry_index;
+
+	/* The index of the least recently used entry
+	 */
+	int last_entry_index;
+
+	/* The segment numbers of the file IO pool entries
+	 */
+	uint32_t *segment_numbers;
+
+	/* The number of file IO pool entries
+	 */
+	int number_of_file_io_pool_entries;
+
+	/* The access counter
+	 */
+	uint64_t access_counter;
+
+	/* The segment file set identifier the cache file is bound to
+	 */
+	uint8_t set_identifier[ 16 ];
+
+	/* The cache file IO handle
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The number of chunks read from the cache file
+	 */
+	uint64_t number_of_hits;
+
+	/* The number of chunks not found in the cache file
+	 */
+	uint64_t number_of_misses;
+};
+
+int libewf_disk_chunk_cache_initialize(
+     libewf_disk_chunk_cache_t **disk_chunk_cache,
+     size32_t chunk_size,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error );
+
+int libewf_disk_chunk_cache_free(
+     libewf_disk_chunk_cache_t **disk_chunk_cache,
+     libcerror_error_t **error );
+
+int libewf_disk_chunk_cache_clear_entries(
+     libewf_disk_chunk_cache_t *disk_chunk_cache,
+     libcerror_error_t **error );
+
+int libewf_disk_chunk_cache_compare_entries_by_last_access(
+     const void *first_entry,
+     const void *second_entry );
+
+int libewf_disk_chunk_cache_unlink_entry(
+     libewf_disk_chunk_cache_t *disk_chunk_cache,
+     int entry_index,
+     libcerror_error_t **error );
+
+int libewf_disk_chunk_cache_link_entry(
+     libewf_disk_chunk_cache_t *disk_chunk_cache,
+     int entry_index,
+     uint8_t at_front,
+     libcerror_error_t **error );
+
+int libewf_disk_chunk_cache_get_bucket_index(
+     libewf_disk_chunk_cache_t *disk_chunk_cache,
+     uint32_t segment_number,
+     off64_t chunk_offset,
+     int *bucket_index,
+     libcerror_error_t **error );
+
+int libewf_disk_chunk_cache_insert_entry_in_bucket(
+     libewf_disk_chunk_cache_t *disk_chunk_cache,
+     int entry_index,
+     libcerror_error_t **error );
+
+int libewf_disk_chunk_cache_remove_entry_from_bucket(
+     libewf_disk_chunk_cache_t *disk_chunk_cache,
+     int entry_index,
+     libcerror_error_t **error );
+
+int libewf_disk_chunk_cache_set_segment_number(
+     libewf_disk_chunk_cache_t *disk_chunk_cache,
+     int file_io_pool_entry,
+     uint32_t segment_number,
+     libcerror_error_t **error );
+
+int libewf_disk_chunk_cache_open(
+     libewf_disk_chunk_cache_t *disk_chunk_cache,
+     const char *filename,
+     size_t filename_length,
+     const uint8_t *set_identifier,
+     size_t set_identifier_size,
+     libcerror_error_t **error );
+
+int libewf_disk_chunk_cache_read_file_entries(
+     libewf_disk_chunk_cache_t *disk_chunk_cache,
+     libcerror_error_t **error );
+
+int libewf_disk_chunk_cache_write_file_entries(
+     libewf_disk_chunk_cache_t *disk_chunk_cache,
+     libcerror_error_t **error );
+
+int libewf_disk_chunk_cache_write_file_entry(
+     libewf_disk_chunk_cache_t *disk_chunk_cache,
+     int entry_index,
+     libcerror_error_t **error );
+
+int libewf_disk_chunk_cache_close(
+     libewf_disk_chunk_cache_t *disk_chunk_cache,
+     libcerror_error_t **error );
+
+int libewf_disk_chunk_cache_get_entry_index(
+     libewf_disk_chunk_cache_t *disk_chunk_cache,
+     uint32_t segment_number,
+     off64_t chunk_offset,
+     int *entry_index,
+     libcerror_error_t **error );
+
+int libewf_disk_chunk_cache_read_chunk_data(
+     libewf_disk_chunk_cache_t *disk_chunk_cache,
+     int file_io_pool_entry,
+     off64_t chunk_offset,
+     uint8_t *data,
+     size_t data_size,
+     size_t *chunk_data_size,
+     libcerror_error_t **error );
+
+int libewf_disk_chunk_cache_write_chunk_data(
+     libewf_disk_chunk_cache_t *disk_chunk_cache,
+     int file_io_pool_entry,
+     off64_t chunk_offset,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_DISK_CHUNK_CACHE_H ) */
+
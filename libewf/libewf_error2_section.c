@@ -46,7 +46,7 @@ int libewf_error2_section_read_data(
      const uint8_t *data,
      size_t data_size,
      uint8_t format_version,
-     libcdata_range_list_t *acquiry_errors,
+     libewf_sector_range_list_t *acquiry_errors,
      libcerror_error_t **error )
 {
 	const uint8_t *error_data       = NULL;
@@ -379,9 +379,8 @@ int libewf_error2_section_read_data(
 			}
 		}
 #endif
-		if( libcdata_range_list_empty(
+		if( libewf_sector_range_list_empty(
 		     acquiry_errors,
-		     NULL,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -446,13 +445,10 @@ int libewf_error2_section_read_data(
 				}
 			}
 #endif
-			result = libcdata_range_list_insert_range(
+			result = libewf_sector_range_list_insert_range(
 			          acquiry_errors,
 			          start_sector,
 			          (uint64_t) number_of_sectors,
-			          NULL,
-			          NULL,
-			          NULL,
 			          error );
 
 			if( result == -1 )
@@ -493,7 +489,7 @@ ssize_t libewf_section_error_read(
          libbfio_pool_t *file_io_pool,
          int file_io_pool_entry,
          uint8_t format_version,
-         libcdata_range_list_t *acquiry_errors,
+         libewf_sector_range_list_t *acquiry_errors,
          libcerror_error_t **error )
 {
 	uint8_t *section_data    = NULL;
@@ -585,14 +581,13 @@ ssize_t libewf_section_error_write(
          int file_io_pool_entry,
          uint8_t format_version,
          off64_t section_offset,
-         libcdata_range_list_t *acquiry_errors,
+         libewf_sector_range_list_t *acquiry_errors,
          libcerror_error_t **error )
 {
 	uint8_t *error_data                 = NULL;
 	uint8_t *error_entry_data           = NULL;
 	uint8_t *section_data               = NULL;
 	static char *function               = "libewf_section_error_write";
-	intptr_t *value                     = NULL;
 	size_t error_entry_data_size        = 0;
 	size_t error_entries_data_size      = 0;
 	size_t error_footer_data_size       = 0;
@@ -645,7 +640,7 @@ ssize_t libewf_section_error_write(
 
 		return( -1 );
 	}
-	if( libcdata_range_list_get_number_of_elements(
+	if( libewf_sector_range_list_get_number_of_ranges(
 	     acquiry_errors,
 	     &number_of_entries,
 	     error ) != 1 )
@@ -861,12 +856,11 @@ ssize_t libewf_section_error_write(
 	     entry_index < number_of_entries;
 	     entry_index++ )
 	{
-		if( libcdata_range_list_get_range_by_index(
+		if( libewf_sector_range_list_get_range_by_index(
 		     acquiry_errors,
 		     entry_index,
 		     &start_sector,
 		     &number_of_sectors,
-		     &value,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
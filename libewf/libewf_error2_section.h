@@ -30,6 +30,7 @@
 #include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
 #include "libewf_section_descriptor.h"
+#include "libewf_sector_range_list.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -39,7 +40,7 @@ int libewf_error2_section_read_data(
      const uint8_t *data,
      size_t data_size,
      uint8_t format_version,
-     libcdata_range_list_t *acquiry_errors,
+     libewf_sector_range_list_t *acquiry_errors,
      libcerror_error_t **error );
 
 ssize_t libewf_section_error_read(
@@ -48,7 +49,7 @@ ssize_t libewf_section_error_read(
          libbfio_pool_t *file_io_pool,
          int file_io_pool_entry,
          uint8_t format_version,
-         libcdata_range_list_t *acquiry_errors,
+         libewf_sector_range_list_t *acquiry_errors,
          libcerror_error_t **error );
 
 ssize_t libewf_section_error_write(
@@ -58,7 +59,7 @@ ssize_t libewf_section_error_write(
          int file_io_pool_entry,
          uint8_t format_version,
          off64_t section_offset,
-         libcdata_range_list_t *acquiry_errors,
+         libewf_sector_range_list_t *acquiry_errors,
          libcerror_error_t **error );
 
 #if defined( __cplusplus )
@@ -25,6 +25,7 @@
 
 #include "libewf_definitions.h"
 #include "libewf_file_entry.h"
+#include "libewf_file_entry_iterator.h"
 #include "libewf_handle.h"
 #include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
@@ -1912,14 +1913,18 @@ ssize_t libewf_internal_file_entry_read_buffer_from_single_file_entry(
          size_t buffer_size,
          libcerror_error_t **error )
 {
-	static char *function         = "libewf_internal_file_entry_read_buffer_from_single_file_entry";
-	off64_t data_offset           = 0;
-	off64_t duplicate_data_offset = 0;
-	size64_t data_size            = 0;
-	size64_t size                 = 0;
-	size_t read_size              = 0;
-	ssize_t read_count            = 0;
-	uint32_t flags                = 0;
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_internal_file_entry_read_buffer_from_single_file_entry";
+	off64_t data_offset                       = 0;
+	off64_t duplicate_data_offset             = 0;
+	off64_t read_offset                       = 0;
+	size64_t data_size                        = 0;
+	size64_t size                             = 0;
+	size_t read_size                          = 0;
+	ssize_t read_count                        = 0;
+	uint64_t end_chunk_index                  = 0;
+	uint32_t chunk_size                       = 0;
+	uint32_t flags                            = 0;
 
 	if( internal_file_entry == NULL )
 	{
@@ -1932,6 +1937,30 @@ ssize_t libewf_internal_file_entry_read_buffer_from_single_file_entry(
 
 		return( -1 );
 	}
+	if( internal_file_entry->internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file entry - missing internal handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = internal_file_entry->internal_handle;
+
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file entry - invalid internal handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
 	if( internal_file_entry->offset < 0 )
 	{
 		libcerror_error_set(
@@ -2077,40 +2106,76 @@ ssize_t libewf_internal_file_entry_read_buffer_from_single_file_entry(
 	}
 	if( ( flags & LIBEWF_FILE_ENTRY_FLAG_SPARSE_DATA ) == 0 )
 	{
-		data_offset += internal_file_entry->offset;
-		read_size    = buffer_size;
+		read_offset = data_offset + internal_file_entry->offset;
+		read_size   = buffer_size;
 	}
 	else if( duplicate_data_offset >= 0 )
 	{
-		data_offset = duplicate_data_offset + internal_file_entry->offset;
+		data_offset = duplicate_data_offset;
+		data_size   = size;
+		read_offset = data_offset + internal_file_entry->offset;
 		read_size   = buffer_size;
 	}
 	else
 	{
-		read_size = 1;
+		data_size   = 1;
+		read_offset = data_offset;
+		read_size   = 1;
 	}
-	if( libewf_handle_seek_offset(
-	     (libewf_handle_t *) internal_file_entry->internal_handle,
-	     data_offset,
-	     SEEK_SET,
-	     error ) == -1 )
+	chunk_size = internal_handle->media_values->chunk_size;
+
+	/* Concurrent reads are only supported on read-only access
+	 */
+	if( ( internal_handle->write_io_handle == NULL )
+	 && ( chunk_size != 0 ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset: %" PRIi64 ".",
-		 function,
-		 data_offset );
+		/* The read ahead of a file entry is tracked separately from that of
+		 * the handle and other file entries, and is bounded to the data of
+		 * the file entry so that reading many small files in sequence does
+		 * not evict the chunks of other files from the chunk cache
+		 */
+		end_chunk_index = (uint64_t) ( data_offset + data_size + chunk_size - 1 ) / chunk_size;
 
-		return( -1 );
+		/* A read from the start of the file entry is considered sequential
+		 * so that the data of the file entry is read ahead when it is opened
+		 */
+		if( internal_file_entry->offset == 0 )
+		{
+			internal_file_entry->read_ahead_next_chunk_index = (uint64_t) data_offset / chunk_size;
+		}
+		read_count = libewf_internal_handle_read_buffer_at_offset_concurrent(
+		              internal_handle,
+		              buffer,
+		              read_size,
+		              read_offset,
+		              &( internal_file_entry->read_ahead_next_chunk_index ),
+		              end_chunk_index,
+		              error );
 	}
-	read_count = libewf_handle_read_buffer(
-		      (libewf_handle_t *) internal_file_entry->internal_handle,
-		      buffer,
-		      read_size,
-		      error );
+	else
+	{
+		if( libewf_handle_seek_offset(
+		     (libewf_handle_t *) internal_handle,
+		     read_offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset: %" PRIi64 ".",
+			 function,
+			 read_offset );
 
+			return( -1 );
+		}
+		read_count = libewf_handle_read_buffer(
+			      (libewf_handle_t *) internal_handle,
+			      buffer,
+			      read_size,
+			      error );
+	}
 	if( read_count <= -1 )
 	{
 		libcerror_error_set(
@@ -2845,6 +2910,80 @@ on_error:
 	return( -1 );
 }
 
+/* Retrieves an iterator of the sub file entries
+ * Make sure the value sub_file_entry_iterator is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_entry_get_sub_file_entry_iterator(
+     libewf_file_entry_t *file_entry,
+     libewf_file_entry_iterator_t **sub_file_entry_iterator,
+     libcerror_error_t **error )
+{
+	libewf_internal_file_entry_t *internal_file_entry = NULL;
+	static char *function                             = "libewf_file_entry_get_sub_file_entry_iterator";
+	int result                                        = 1;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry = (libewf_internal_file_entry_t *) file_entry;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libewf_file_entry_iterator_initialize(
+	     sub_file_entry_iterator,
+	     internal_file_entry->internal_handle,
+	     internal_file_entry->file_entry_tree_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize sub file entry iterator.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_file_entry->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
 /* Retrieves the sub file entry for the specific UTF-8 encoded name
  * Returns 1 if successful, 0 if no such sub file entry or -1 on error
  */
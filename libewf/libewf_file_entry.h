@@ -57,6 +57,10 @@ struct libewf_internal_file_entry
 	 */
 	off64_t offset;
 
+	/* The index of the chunk that is expected to be read next on sequential access
+	 */
+	uint64_t read_ahead_next_chunk_index;
+
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	/* The read/write lock
 	 */
@@ -244,6 +248,12 @@ int libewf_file_entry_get_sub_file_entry(
      libewf_file_entry_t **sub_file_entry,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_file_entry_get_sub_file_entry_iterator(
+     libewf_file_entry_t *file_entry,
+     libewf_file_entry_iterator_t **sub_file_entry_iterator,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_file_entry_get_sub_file_entry_by_utf8_name(
      libewf_file_entry_t *file_entry,
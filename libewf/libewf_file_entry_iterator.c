@@ -0,0 +1,856 @@
+/*
+ * File entry iterator functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_file_entry.h"
+#include "libewf_file_entry_iterator.h"
+#include "libewf_handle.h"
+#include "libewf_libcdata.h"
+#include "libewf_libcerror.h"
+#include "libewf_single_file_entry.h"
+#include "libewf_types.h"
+
+/* Creates a file entry iterator
+ * Make sure the value file_entry_iterator is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_entry_iterator_initialize(
+     libewf_file_entry_iterator_t **file_entry_iterator,
+     libewf_internal_handle_t *internal_handle,
+     libcdata_tree_node_t *parent_tree_node,
+     libcerror_error_t **error )
+{
+	libewf_internal_file_entry_iterator_t *internal_file_entry_iterator = NULL;
+	static char *function                                               = "libewf_file_entry_iterator_initialize";
+
+	if( file_entry_iterator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry iterator.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_entry_iterator != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file entry iterator value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( parent_tree_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parent tree node.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry_iterator = memory_allocate_structure(
+	                                libewf_internal_file_entry_iterator_t );
+
+	if( internal_file_entry_iterator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file entry iterator.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     internal_file_entry_iterator,
+	     0,
+	     sizeof( libewf_internal_file_entry_iterator_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file entry iterator.",
+		 function );
+
+		memory_free(
+		 internal_file_entry_iterator );
+
+		return( -1 );
+	}
+	internal_file_entry_iterator->internal_handle      = internal_handle;
+	internal_file_entry_iterator->parent_tree_node     = parent_tree_node;
+	internal_file_entry_iterator->sub_file_entry_index = -1;
+
+	*file_entry_iterator = (libewf_file_entry_iterator_t *) internal_file_entry_iterator;
+
+	return( 1 );
+}
+
+/* Frees a file entry iterator
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_entry_iterator_free(
+     libewf_file_entry_iterator_t **file_entry_iterator,
+     libcerror_error_t **error )
+{
+	libewf_internal_file_entry_iterator_t *internal_file_entry_iterator = NULL;
+	static char *function                                               = "libewf_file_entry_iterator_free";
+
+	if( file_entry_iterator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry iterator.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_entry_iterator != NULL )
+	{
+		internal_file_entry_iterator = (libewf_internal_file_entry_iterator_t *) *file_entry_iterator;
+		*file_entry_iterator         = NULL;
+
+		/* The internal_handle and parent_tree_node references are freed elsewhere
+		 */
+		memory_free(
+		 internal_file_entry_iterator );
+	}
+	return( 1 );
+}
+
+/* Resets the file entry iterator to before the first sub file entry
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_entry_iterator_reset(
+     libewf_file_entry_iterator_t *file_entry_iterator,
+     libcerror_error_t **error )
+{
+	libewf_internal_file_entry_iterator_t *internal_file_entry_iterator = NULL;
+	static char *function                                               = "libewf_file_entry_iterator_reset";
+
+	if( file_entry_iterator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry iterator.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry_iterator = (libewf_internal_file_entry_iterator_t *) file_entry_iterator;
+
+	internal_file_entry_iterator->sub_tree_node        = NULL;
+	internal_file_entry_iterator->sub_file_entry_index = -1;
+
+	return( 1 );
+}
+
+/* Moves the file entry iterator to the next sub file entry
+ * The first call moves the file entry iterator to the first sub file entry
+ * Returns 1 if successful, 0 if no more sub file entries or -1 on error
+ */
+int libewf_file_entry_iterator_next(
+     libewf_file_entry_iterator_t *file_entry_iterator,
+     libcerror_error_t **error )
+{
+	libewf_internal_file_entry_iterator_t *internal_file_entry_iterator = NULL;
+	libcdata_tree_node_t *sub_tree_node                                 = NULL;
+	static char *function                                               = "libewf_file_entry_iterator_next";
+
+	if( file_entry_iterator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry iterator.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry_iterator = (libewf_internal_file_entry_iterator_t *) file_entry_iterator;
+
+	if( internal_file_entry_iterator->sub_file_entry_index == -1 )
+	{
+		if( libcdata_tree_node_get_first_sub_node(
+		     internal_file_entry_iterator->parent_tree_node,
+		     &sub_tree_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve first sub file entry tree node.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else if( internal_file_entry_iterator->sub_tree_node != NULL )
+	{
+		if( libcdata_tree_node_get_next_node(
+		     internal_file_entry_iterator->sub_tree_node,
+		     &sub_tree_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next sub file entry tree node.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else
+	{
+		/* The file entry iterator is past the last sub file entry
+		 */
+		return( 0 );
+	}
+	internal_file_entry_iterator->sub_tree_node         = sub_tree_node;
+	internal_file_entry_iterator->sub_file_entry_index += 1;
+
+	if( sub_tree_node == NULL )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the index of the current sub file entry
+ * The index is -1 before the first sub file entry
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_entry_iterator_get_index(
+     libewf_file_entry_iterator_t *file_entry_iterator,
+     int *sub_file_entry_index,
+     libcerror_error_t **error )
+{
+	libewf_internal_file_entry_iterator_t *internal_file_entry_iterator = NULL;
+	static char *function                                               = "libewf_file_entry_iterator_get_index";
+
+	if( file_entry_iterator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry iterator.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry_iterator = (libewf_internal_file_entry_iterator_t *) file_entry_iterator;
+
+	if( sub_file_entry_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub file entry index.",
+		 function );
+
+		return( -1 );
+	}
+	*sub_file_entry_index = internal_file_entry_iterator->sub_file_entry_index;
+
+	return( 1 );
+}
+
+/* Retrieves the single file entry of the current sub file entry
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_entry_iterator_get_single_file_entry(
+     libewf_file_entry_iterator_t *file_entry_iterator,
+     libewf_single_file_entry_t **single_file_entry,
+     libcerror_error_t **error )
+{
+	libewf_internal_file_entry_iterator_t *internal_file_entry_iterator = NULL;
+	static char *function                                               = "libewf_file_entry_iterator_get_single_file_entry";
+
+	if( file_entry_iterator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry iterator.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry_iterator = (libewf_internal_file_entry_iterator_t *) file_entry_iterator;
+
+	if( internal_file_entry_iterator->sub_tree_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file entry iterator - missing current sub file entry tree node.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_tree_node_get_value(
+	     internal_file_entry_iterator->sub_tree_node,
+	     (intptr_t **) single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve value from sub file entry tree node.",
+		 function );
+
+		return( -1 );
+	}
+	if( *single_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing single file entry.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the size of the UTF-8 encoded name of the current sub file entry
+ * The returned size includes the end of string character
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_entry_iterator_get_utf8_name_size(
+     libewf_file_entry_iterator_t *file_entry_iterator,
+     size_t *utf8_string_size,
+     libcerror_error_t **error )
+{
+	libewf_single_file_entry_t *single_file_entry = NULL;
+	static char *function                         = "libewf_file_entry_iterator_get_utf8_name_size";
+
+	if( libewf_file_entry_iterator_get_single_file_entry(
+	     file_entry_iterator,
+	     &single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current single file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_single_file_entry_get_utf8_name_size(
+	     single_file_entry,
+	     utf8_string_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-8 name size.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the UTF-8 encoded name of the current sub file entry
+ * The size should include the end of string character
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_entry_iterator_get_utf8_name(
+     libewf_file_entry_iterator_t *file_entry_iterator,
+     uint8_t *utf8_string,
+     size_t utf8_string_size,
+     libcerror_error_t **error )
+{
+	libewf_single_file_entry_t *single_file_entry = NULL;
+	static char *function                         = "libewf_file_entry_iterator_get_utf8_name";
+
+	if( libewf_file_entry_iterator_get_single_file_entry(
+	     file_entry_iterator,
+	     &single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current single file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_single_file_entry_get_utf8_name(
+	     single_file_entry,
+	     utf8_string,
+	     utf8_string_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-8 name.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the size of the UTF-16 encoded name of the current sub file entry
+ * The returned size includes the end of string character
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_entry_iterator_get_utf16_name_size(
+     libewf_file_entry_iterator_t *file_entry_iterator,
+     size_t *utf16_string_size,
+     libcerror_error_t **error )
+{
+	libewf_single_file_entry_t *single_file_entry = NULL;
+	static char *function                         = "libewf_file_entry_iterator_get_utf16_name_size";
+
+	if( libewf_file_entry_iterator_get_single_file_entry(
+	     file_entry_iterator,
+	     &single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current single file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_single_file_entry_get_utf16_name_size(
+	     single_file_entry,
+	     utf16_string_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-16 name size.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the UTF-16 encoded name of the current sub file entry
+ * The size should include the end of string character
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_entry_iterator_get_utf16_name(
+     libewf_file_entry_iterator_t *file_entry_iterator,
+     uint16_t *utf16_string,
+     size_t utf16_string_size,
+     libcerror_error_t **error )
+{
+	libewf_single_file_entry_t *single_file_entry = NULL;
+	static char *function                         = "libewf_file_entry_iterator_get_utf16_name";
+
+	if( libewf_file_entry_iterator_get_single_file_entry(
+	     file_entry_iterator,
+	     &single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current single file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_single_file_entry_get_utf16_name(
+	     single_file_entry,
+	     utf16_string,
+	     utf16_string_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-16 name.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the size of the current sub file entry
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_entry_iterator_get_size(
+     libewf_file_entry_iterator_t *file_entry_iterator,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	libewf_single_file_entry_t *single_file_entry = NULL;
+	static char *function                         = "libewf_file_entry_iterator_get_size";
+
+	if( libewf_file_entry_iterator_get_single_file_entry(
+	     file_entry_iterator,
+	     &single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current single file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_single_file_entry_get_size(
+	     single_file_entry,
+	     size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve size.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the creation date and time of the current sub file entry
+ * The date and time is formatted as a POSIX timestamp
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_entry_iterator_get_creation_time(
+     libewf_file_entry_iterator_t *file_entry_iterator,
+     int32_t *creation_time,
+     libcerror_error_t **error )
+{
+	libewf_single_file_entry_t *single_file_entry = NULL;
+	static char *function                         = "libewf_file_entry_iterator_get_creation_time";
+
+	if( libewf_file_entry_iterator_get_single_file_entry(
+	     file_entry_iterator,
+	     &single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current single file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_single_file_entry_get_creation_time(
+	     single_file_entry,
+	     creation_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve creation time.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the modification date and time of the current sub file entry
+ * The date and time is formatted as a POSIX timestamp
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_entry_iterator_get_modification_time(
+     libewf_file_entry_iterator_t *file_entry_iterator,
+     int32_t *modification_time,
+     libcerror_error_t **error )
+{
+	libewf_single_file_entry_t *single_file_entry = NULL;
+	static char *function                         = "libewf_file_entry_iterator_get_modification_time";
+
+	if( libewf_file_entry_iterator_get_single_file_entry(
+	     file_entry_iterator,
+	     &single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current single file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_single_file_entry_get_modification_time(
+	     single_file_entry,
+	     modification_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve modification time.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the access date and time of the current sub file entry
+ * The date and time is formatted as a POSIX timestamp
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_entry_iterator_get_access_time(
+     libewf_file_entry_iterator_t *file_entry_iterator,
+     int32_t *access_time,
+     libcerror_error_t **error )
+{
+	libewf_single_file_entry_t *single_file_entry = NULL;
+	static char *function                         = "libewf_file_entry_iterator_get_access_time";
+
+	if( libewf_file_entry_iterator_get_single_file_entry(
+	     file_entry_iterator,
+	     &single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current single file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_single_file_entry_get_access_time(
+	     single_file_entry,
+	     access_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve access time.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the entry modification date and time of the current sub file entry
+ * The date and time is formatted as a POSIX timestamp
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_entry_iterator_get_entry_modification_time(
+     libewf_file_entry_iterator_t *file_entry_iterator,
+     int32_t *entry_modification_time,
+     libcerror_error_t **error )
+{
+	libewf_single_file_entry_t *single_file_entry = NULL;
+	static char *function                         = "libewf_file_entry_iterator_get_entry_modification_time";
+
+	if( libewf_file_entry_iterator_get_single_file_entry(
+	     file_entry_iterator,
+	     &single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current single file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_single_file_entry_get_entry_modification_time(
+	     single_file_entry,
+	     entry_modification_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry modification time.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of sub file entries of the current sub file entry
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_entry_iterator_get_number_of_sub_file_entries(
+     libewf_file_entry_iterator_t *file_entry_iterator,
+     int *number_of_sub_file_entries,
+     libcerror_error_t **error )
+{
+	libewf_internal_file_entry_iterator_t *internal_file_entry_iterator = NULL;
+	static char *function                                               = "libewf_file_entry_iterator_get_number_of_sub_file_entries";
+
+	if( file_entry_iterator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry iterator.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry_iterator = (libewf_internal_file_entry_iterator_t *) file_entry_iterator;
+
+	if( internal_file_entry_iterator->sub_tree_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file entry iterator - missing current sub file entry tree node.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_tree_node_get_number_of_sub_nodes(
+	     internal_file_entry_iterator->sub_tree_node,
+	     number_of_sub_file_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sub file entries.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the file entry of the current sub file entry
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_entry_iterator_get_file_entry(
+     libewf_file_entry_iterator_t *file_entry_iterator,
+     libewf_file_entry_t **file_entry,
+     libcerror_error_t **error )
+{
+	libewf_internal_file_entry_iterator_t *internal_file_entry_iterator = NULL;
+	static char *function                                               = "libewf_file_entry_iterator_get_file_entry";
+
+	if( file_entry_iterator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry iterator.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file_entry_iterator = (libewf_internal_file_entry_iterator_t *) file_entry_iterator;
+
+	if( internal_file_entry_iterator->sub_tree_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file entry iterator - missing current sub file entry tree node.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_file_entry_initialize(
+	     file_entry,
+	     internal_file_entry_iterator->internal_handle,
+	     internal_file_entry_iterator->sub_tree_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize file entry.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
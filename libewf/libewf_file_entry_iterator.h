@@ -0,0 +1,169 @@
+/*
+ * File entry iterator functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_FILE_ENTRY_ITERATOR_H )
+#define _LIBEWF_FILE_ENTRY_ITERATOR_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_extern.h"
+#include "libewf_handle.h"
+#include "libewf_libcdata.h"
+#include "libewf_libcerror.h"
+#include "libewf_single_file_entry.h"
+#include "libewf_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_internal_file_entry_iterator libewf_internal_file_entry_iterator_t;
+
+/* The file entry iterator enumerates the sub file entries of a file entry
+ * in order without creating a file entry per sub file entry
+ */
+struct libewf_internal_file_entry_iterator
+{
+	/* The internal EWF handle
+	 */
+	libewf_internal_handle_t *internal_handle;
+
+	/* The parent file entry tree node
+	 */
+	libcdata_tree_node_t *parent_tree_node;
+
+	/* The current sub file entry tree node, which is NULL before the first
+	 * and after the last sub file entry
+	 */
+	libcdata_tree_node_t *sub_tree_node;
+
+	/* The index of the current sub file entry, which is -1 before the first sub file entry
+	 */
+	int sub_file_entry_index;
+};
+
+int libewf_file_entry_iterator_initialize(
+     libewf_file_entry_iterator_t **file_entry_iterator,
+     libewf_internal_handle_t *internal_handle,
+     libcdata_tree_node_t *parent_tree_node,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_file_entry_iterator_free(
+     libewf_file_entry_iterator_t **file_entry_iterator,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_file_entry_iterator_reset(
+     libewf_file_entry_iterator_t *file_entry_iterator,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_file_entry_iterator_next(
+     libewf_file_entry_iterator_t *file_entry_iterator,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_file_entry_iterator_get_index(
+     libewf_file_entry_iterator_t *file_entry_iterator,
+     int *sub_file_entry_index,
+     libcerror_error_t **error );
+
+int libewf_file_entry_iterator_get_single_file_entry(
+     libewf_file_entry_iterator_t *file_entry_iterator,
+     libewf_single_file_entry_t **single_file_entry,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_file_entry_iterator_get_utf8_name_size(
+     libewf_file_entry_iterator_t *file_entry_iterator,
+     size_t *utf8_string_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_file_entry_iterator_get_utf8_name(
+     libewf_file_entry_iterator_t *file_entry_iterator,
+     uint8_t *utf8_string,
+     size_t utf8_string_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_file_entry_iterator_get_utf16_name_size(
+     libewf_file_entry_iterator_t *file_entry_iterator,
+     size_t *utf16_string_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_file_entry_iterator_get_utf16_name(
+     libewf_file_entry_iterator_t *file_entry_iterator,
+     uint16_t *utf16_string,
+     size_t utf16_string_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_file_entry_iterator_get_size(
+     libewf_file_entry_iterator_t *file_entry_iterator,
+     size64_t *size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_file_entry_iterator_get_creation_time(
+     libewf_file_entry_iterator_t *file_entry_iterator,
+     int32_t *creation_time,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_file_entry_iterator_get_modification_time(
+     libewf_file_entry_iterator_t *file_entry_iterator,
+     int32_t *modification_time,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_file_entry_iterator_get_access_time(
+     libewf_file_entry_iterator_t *file_entry_iterator,
+     int32_t *access_time,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_file_entry_iterator_get_entry_modification_time(
+     libewf_file_entry_iterator_t *file_entry_iterator,
+     int32_t *entry_modification_time,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_file_entry_iterator_get_number_of_sub_file_entries(
+     libewf_file_entry_iterator_t *file_entry_iterator,
+     int *number_of_sub_file_entries,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_file_entry_iterator_get_file_entry(
+     libewf_file_entry_iterator_t *file_entry_iterator,
+     libewf_file_entry_t **file_entry,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_FILE_ENTRY_ITERATOR_H ) */
+
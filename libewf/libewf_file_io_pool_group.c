@@ -0,0 +1,835 @@
+/*
+ * File IO pool group functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_file_io_pool_group.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+/* Creates a file IO pool group
+ * Make sure the value file_io_pool_group is referencing, is set to NULL
+ * The file IO pool group is created with 1 reference
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_io_pool_group_initialize(
+     libewf_file_io_pool_group_t **file_io_pool_group,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_file_io_pool_group_initialize";
+
+	if( file_io_pool_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool group.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_io_pool_group != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file IO pool group value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_open_handles <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of open handles value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	*file_io_pool_group = memory_allocate_structure(
+	                       libewf_file_io_pool_group_t );
+
+	if( *file_io_pool_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file IO pool group.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *file_io_pool_group,
+	     0,
+	     sizeof( libewf_file_io_pool_group_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file IO pool group.",
+		 function );
+
+		memory_free(
+		 *file_io_pool_group );
+
+		*file_io_pool_group = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *file_io_pool_group )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *file_io_pool_group )->maximum_number_of_open_handles = maximum_number_of_open_handles;
+	( *file_io_pool_group )->number_of_references           = 1;
+
+	return( 1 );
+
+on_error:
+	if( *file_io_pool_group != NULL )
+	{
+		memory_free(
+		 *file_io_pool_group );
+
+		*file_io_pool_group = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a file IO pool group
+ * The file IO pools are not freed, they are managed by the handles that use them
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_io_pool_group_free(
+     libewf_file_io_pool_group_t **file_io_pool_group,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_file_io_pool_group_free";
+	int result            = 1;
+
+	if( file_io_pool_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool group.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_io_pool_group != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *file_io_pool_group )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		if( ( *file_io_pool_group )->shares != NULL )
+		{
+			memory_free(
+			 ( *file_io_pool_group )->shares );
+		}
+		if( ( *file_io_pool_group )->file_io_pools != NULL )
+		{
+			memory_free(
+			 ( *file_io_pool_group )->file_io_pools );
+		}
+		memory_free(
+		 *file_io_pool_group );
+
+		*file_io_pool_group = NULL;
+	}
+	return( result );
+}
+
+/* Acquires a reference to a file IO pool group
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_io_pool_group_acquire(
+     libewf_file_io_pool_group_t *file_io_pool_group,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_file_io_pool_group_acquire";
+
+	if( file_io_pool_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool group.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     file_io_pool_group->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	file_io_pool_group->number_of_references += 1;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     file_io_pool_group->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Releases a reference to a file IO pool group
+ * The file IO pool group is freed when the last reference is released
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_io_pool_group_release(
+     libewf_file_io_pool_group_t **file_io_pool_group,
+     libcerror_error_t **error )
+{
+	static char *function    = "libewf_file_io_pool_group_release";
+	int number_of_references = 0;
+
+	if( file_io_pool_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool group.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_io_pool_group == NULL )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     ( *file_io_pool_group )->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	( *file_io_pool_group )->number_of_references -= 1;
+
+	number_of_references = ( *file_io_pool_group )->number_of_references;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     ( *file_io_pool_group )->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( number_of_references > 0 )
+	{
+		*file_io_pool_group = NULL;
+
+		return( 1 );
+	}
+	if( libewf_file_io_pool_group_free(
+	     file_io_pool_group,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO pool group.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Distributes the maximum number of open handles over the file IO pools
+ * Every file IO pool that needs less than an equal share of the remaining open handles
+ * is given the number of handles it contains, the remainder is divided equally over the
+ * other file IO pools. Every file IO pool is given at least 1 open handle
+ * This function is not multi-thread safe acquire mutex before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_io_pool_group_distribute(
+     libewf_file_io_pool_group_t *file_io_pool_group,
+     libcerror_error_t **error )
+{
+	static char *function           = "libewf_file_io_pool_group_distribute";
+	int file_io_pool_index          = 0;
+	int number_of_handles           = 0;
+	int number_of_remaining_handles = 0;
+	int number_of_remaining_pools   = 0;
+	int number_of_shared_handles    = 0;
+	int share                       = 0;
+	int share_changed               = 0;
+
+	if( file_io_pool_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool group.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool_group->number_of_file_io_pools == 0 )
+	{
+		return( 1 );
+	}
+	/* A share of 0 marks a file IO pool that has not been given its share yet
+	 */
+	for( file_io_pool_index = 0;
+	     file_io_pool_index < file_io_pool_group->number_of_file_io_pools;
+	     file_io_pool_index++ )
+	{
+		file_io_pool_group->shares[ file_io_pool_index ] = 0;
+	}
+	number_of_remaining_handles = file_io_pool_group->maximum_number_of_open_handles;
+	number_of_remaining_pools   = file_io_pool_group->number_of_file_io_pools;
+
+	do
+	{
+		share = number_of_remaining_handles / number_of_remaining_pools;
+
+		if( share <= 0 )
+		{
+			share = 1;
+		}
+		share_changed = 0;
+
+		for( file_io_pool_index = 0;
+		     file_io_pool_index < file_io_pool_group->number_of_file_io_pools;
+		     file_io_pool_index++ )
+		{
+			if( file_io_pool_group->shares[ file_io_pool_index ] != 0 )
+			{
+				continue;
+			}
+			if( libbfio_pool_get_number_of_handles(
+			     file_io_pool_group->file_io_pools[ file_io_pool_index ],
+			     &number_of_handles,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve number of handles of file IO pool: %d.",
+				 function,
+				 file_io_pool_index );
+
+				return( -1 );
+			}
+			if( number_of_handles <= 0 )
+			{
+				number_of_handles = 1;
+			}
+			if( number_of_handles <= share )
+			{
+				file_io_pool_group->shares[ file_io_pool_index ] = number_of_handles;
+
+				number_of_remaining_handles -= number_of_handles;
+				number_of_remaining_pools   -= 1;
+
+				share_changed = 1;
+			}
+		}
+	}
+	while( ( share_changed != 0 )
+	    && ( number_of_remaining_pools > 0 ) );
+
+	/* The open handles that remain after the equal division are given to the first file IO pools
+	 */
+	if( number_of_remaining_pools > 0 )
+	{
+		number_of_shared_handles = number_of_remaining_handles % number_of_remaining_pools;
+
+		if( number_of_remaining_handles < number_of_remaining_pools )
+		{
+			number_of_shared_handles = 0;
+		}
+	}
+	for( file_io_pool_index = 0;
+	     file_io_pool_index < file_io_pool_group->number_of_file_io_pools;
+	     file_io_pool_index++ )
+	{
+		if( file_io_pool_group->shares[ file_io_pool_index ] == 0 )
+		{
+			file_io_pool_group->shares[ file_io_pool_index ] = share;
+
+			if( number_of_shared_handles > 0 )
+			{
+				file_io_pool_group->shares[ file_io_pool_index ] += 1;
+
+				number_of_shared_handles--;
+			}
+		}
+		if( libbfio_pool_set_maximum_number_of_open_handles(
+		     file_io_pool_group->file_io_pools[ file_io_pool_index ],
+		     file_io_pool_group->shares[ file_io_pool_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of open handles of file IO pool: %d.",
+			 function,
+			 file_io_pool_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Appends a file IO pool to the file IO pool group
+ * The maximum number of open handles is redistributed over the file IO pools
+ * Returns 1 if successful, 0 if the file IO pool is already part of the group or -1 on error
+ */
+int libewf_file_io_pool_group_append_file_io_pool(
+     libewf_file_io_pool_group_t *file_io_pool_group,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error )
+{
+	libbfio_pool_t **file_io_pools        = NULL;
+	static char *function                 = "libewf_file_io_pool_group_append_file_io_pool";
+	size_t array_size                     = 0;
+	int *shares                           = NULL;
+	int file_io_pool_index                = 0;
+	int number_of_allocated_file_io_pools = 0;
+	int result                            = 1;
+
+	if( file_io_pool_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool group.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     file_io_pool_group->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	for( file_io_pool_index = 0;
+	     file_io_pool_index < file_io_pool_group->number_of_file_io_pools;
+	     file_io_pool_index++ )
+	{
+		if( file_io_pool_group->file_io_pools[ file_io_pool_index ] == file_io_pool )
+		{
+			result = 0;
+
+			break;
+		}
+	}
+	if( ( result == 1 )
+	 && ( file_io_pool_group->number_of_file_io_pools >= file_io_pool_group->number_of_allocated_file_io_pools ) )
+	{
+		if( file_io_pool_group->number_of_allocated_file_io_pools > ( INT_MAX / 2 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid file IO pool group - number of allocated file IO pools value out of bounds.",
+			 function );
+
+			result = -1;
+		}
+		else
+		{
+			number_of_allocated_file_io_pools = 2 * file_io_pool_group->number_of_allocated_file_io_pools;
+
+			if( number_of_allocated_file_io_pools < LIBEWF_FILE_IO_POOL_GROUP_MINIMUM_NUMBER_OF_FILE_IO_POOLS )
+			{
+				number_of_allocated_file_io_pools = LIBEWF_FILE_IO_POOL_GROUP_MINIMUM_NUMBER_OF_FILE_IO_POOLS;
+			}
+			array_size = sizeof( libbfio_pool_t * ) * number_of_allocated_file_io_pools;
+
+			file_io_pools = (libbfio_pool_t **) memory_reallocate(
+			                                     file_io_pool_group->file_io_pools,
+			                                     array_size );
+
+			if( file_io_pools == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize file IO pools.",
+				 function );
+
+				result = -1;
+			}
+			else
+			{
+				file_io_pool_group->file_io_pools = file_io_pools;
+
+				array_size = sizeof( int ) * number_of_allocated_file_io_pools;
+
+				shares = (int *) memory_reallocate(
+				                  file_io_pool_group->shares,
+				                  array_size );
+
+				if( shares == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to resize shares.",
+					 function );
+
+					result = -1;
+				}
+				else
+				{
+					file_io_pool_group->shares                            = shares;
+					file_io_pool_group->number_of_allocated_file_io_pools = number_of_allocated_file_io_pools;
+				}
+			}
+		}
+	}
+	if( result == 1 )
+	{
+		file_io_pool_group->file_io_pools[ file_io_pool_group->number_of_file_io_pools ] = file_io_pool;
+		file_io_pool_group->shares[ file_io_pool_group->number_of_file_io_pools ]        = 0;
+
+		file_io_pool_group->number_of_file_io_pools += 1;
+
+		if( libewf_file_io_pool_group_distribute(
+		     file_io_pool_group,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to distribute maximum number of open handles.",
+			 function );
+
+			file_io_pool_group->number_of_file_io_pools -= 1;
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     file_io_pool_group->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Removes a file IO pool from the file IO pool group
+ * The maximum number of open handles is redistributed over the remaining file IO pools
+ * Returns 1 if successful, 0 if the file IO pool is not part of the group or -1 on error
+ */
+int libewf_file_io_pool_group_remove_file_io_pool(
+     libewf_file_io_pool_group_t *file_io_pool_group,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error )
+{
+	static char *function  = "libewf_file_io_pool_group_remove_file_io_pool";
+	int file_io_pool_index = 0;
+	int result             = 0;
+
+	if( file_io_pool_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool group.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     file_io_pool_group->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	for( file_io_pool_index = 0;
+	     file_io_pool_index < file_io_pool_group->number_of_file_io_pools;
+	     file_io_pool_index++ )
+	{
+		if( file_io_pool_group->file_io_pools[ file_io_pool_index ] == file_io_pool )
+		{
+			result = 1;
+
+			break;
+		}
+	}
+	if( result == 1 )
+	{
+		file_io_pool_group->number_of_file_io_pools -= 1;
+
+		while( file_io_pool_index < file_io_pool_group->number_of_file_io_pools )
+		{
+			file_io_pool_group->file_io_pools[ file_io_pool_index ] = file_io_pool_group->file_io_pools[ file_io_pool_index + 1 ];
+			file_io_pool_group->shares[ file_io_pool_index ]        = file_io_pool_group->shares[ file_io_pool_index + 1 ];
+
+			file_io_pool_index++;
+		}
+		if( libewf_file_io_pool_group_distribute(
+		     file_io_pool_group,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to distribute maximum number of open handles.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     file_io_pool_group->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the maximum number of open handles of all the file IO pools
+ * The maximum number of open handles is redistributed over the file IO pools
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_file_io_pool_group_set_maximum_number_of_open_handles(
+     libewf_file_io_pool_group_t *file_io_pool_group,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_file_io_pool_group_set_maximum_number_of_open_handles";
+	int result            = 1;
+
+	if( file_io_pool_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool group.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_open_handles <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of open handles value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     file_io_pool_group->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	file_io_pool_group->maximum_number_of_open_handles = maximum_number_of_open_handles;
+
+	if( libewf_file_io_pool_group_distribute(
+	     file_io_pool_group,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to distribute maximum number of open handles.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     file_io_pool_group->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
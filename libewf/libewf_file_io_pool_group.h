@@ -0,0 +1,123 @@
+/*
+ * File IO pool group functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_FILE_IO_POOL_GROUP_H )
+#define _LIBEWF_FILE_IO_POOL_GROUP_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The minimum number of file IO pools the file IO pool group is grown with
+ */
+#define LIBEWF_FILE_IO_POOL_GROUP_MINIMUM_NUMBER_OF_FILE_IO_POOLS	8
+
+typedef struct libewf_file_io_pool_group libewf_file_io_pool_group_t;
+
+/* The file IO pool group bounds the number of open handles of multiple file IO pools,
+ * such as those of the handles of different images, by a single maximum.
+ * The maximum is distributed over the file IO pools in proportion to their number of
+ * handles, a file IO pool that needs less than its share passes the remainder on to the
+ * other file IO pools. Every file IO pool closes its least recently used handles when
+ * it exceeds its share
+ */
+struct libewf_file_io_pool_group
+{
+	/* The maximum number of open handles of all the file IO pools
+	 */
+	int maximum_number_of_open_handles;
+
+	/* The file IO pools
+	 */
+	libbfio_pool_t **file_io_pools;
+
+	/* The maximum number of open handles of the individual file IO pools
+	 */
+	int *shares;
+
+	/* The number of file IO pools
+	 */
+	int number_of_file_io_pools;
+
+	/* The number of allocated file IO pools
+	 */
+	int number_of_allocated_file_io_pools;
+
+	/* The number of references to the file IO pool group
+	 */
+	int number_of_references;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The mutex that protects the file IO pools and the number of references
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libewf_file_io_pool_group_initialize(
+     libewf_file_io_pool_group_t **file_io_pool_group,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error );
+
+int libewf_file_io_pool_group_free(
+     libewf_file_io_pool_group_t **file_io_pool_group,
+     libcerror_error_t **error );
+
+int libewf_file_io_pool_group_acquire(
+     libewf_file_io_pool_group_t *file_io_pool_group,
+     libcerror_error_t **error );
+
+int libewf_file_io_pool_group_release(
+     libewf_file_io_pool_group_t **file_io_pool_group,
+     libcerror_error_t **error );
+
+int libewf_file_io_pool_group_distribute(
+     libewf_file_io_pool_group_t *file_io_pool_group,
+     libcerror_error_t **error );
+
+int libewf_file_io_pool_group_append_file_io_pool(
+     libewf_file_io_pool_group_t *file_io_pool_group,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error );
+
+int libewf_file_io_pool_group_remove_file_io_pool(
+     libewf_file_io_pool_group_t *file_io_pool_group,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error );
+
+int libewf_file_io_pool_group_set_maximum_number_of_open_handles(
+     libewf_file_io_pool_group_t *file_io_pool_group,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_FILE_IO_POOL_GROUP_H ) */
+
@@ -25,9 +25,19 @@
 #include <types.h>
 #include <wide_string.h>
 
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
 #include "libewf_analytical_data.h"
 #include "libewf_case_data.h"
+#include "libewf_chunk_access_map.h"
+#include "libewf_chunk_cache.h"
+#include "libewf_chunk_packer.h"
+#include "libewf_chunk_unpacker.h"
 #include "libewf_chunk_data.h"
+#include "libewf_chunk_group_scanner.h"
+#include "libewf_chunk_index.h"
 #include "libewf_chunk_table.h"
 #include "libewf_codepage.h"
 #include "libewf_compression.h"
@@ -36,8 +46,10 @@
 #include "libewf_definitions.h"
 #include "libewf_device_information.h"
 #include "libewf_digest_section.h"
+#include "libewf_disk_chunk_cache.h"
 #include "libewf_error2_section.h"
 #include "libewf_file_entry.h"
+#include "libewf_file_io_pool_group.h"
 #include "libewf_handle.h"
 #include "libewf_hash_sections.h"
 #include "libewf_hash_values.h"
@@ -53,17 +65,28 @@
 #include "libewf_libfdata.h"
 #include "libewf_libfvalue.h"
 #include "libewf_ltree_section.h"
+#include "libewf_mapped_file.h"
 #include "libewf_md5_hash_section.h"
+#include "libewf_memory_accounting.h"
+#include "libewf_parallel_deflate.h"
+#include "libewf_read_request.h"
 #include "libewf_restart_data.h"
+#include "libewf_running_digest.h"
 #include "libewf_section.h"
 #include "libewf_section_descriptor.h"
 #include "libewf_sector_range.h"
 #include "libewf_segment_file.h"
+#include "libewf_segment_index.h"
+#include "libewf_segment_scanner.h"
+#include "libewf_shared_chunk_cache.h"
+#include "libewf_shared_state.h"
 #include "libewf_session_section.h"
 #include "libewf_sha1_hash_section.h"
 #include "libewf_single_file_entry.h"
 #include "libewf_single_file_tree.h"
 #include "libewf_single_files.h"
+#include "libewf_statistics.h"
+#include "libewf_trace.h"
 #include "libewf_types.h"
 #include "libewf_unused.h"
 #include "libewf_write_io_handle.h"
@@ -189,7 +212,7 @@ int libewf_handle_initialize(
 
 		goto on_error;
 	}
-	if( libcdata_range_list_initialize(
+	if( libewf_sector_range_list_initialize(
 	     &( internal_handle->acquiry_errors ),
 	     error ) != 1 )
 	{
@@ -217,8 +240,11 @@ int libewf_handle_initialize(
 		goto on_error;
 	}
 #endif
-	internal_handle->date_format                    = LIBEWF_DATE_FORMAT_CTIME;
-	internal_handle->maximum_number_of_open_handles = LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES;
+	internal_handle->date_format                           = LIBEWF_DATE_FORMAT_CTIME;
+	internal_handle->maximum_number_of_open_handles        = LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES;
+	internal_handle->maximum_number_of_cached_chunk_groups = LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNK_GROUPS;
+	internal_handle->maximum_number_of_cached_chunks       = LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNKS;
+	internal_handle->read_priority                         = LIBEWF_READ_PRIORITY_INTERACTIVE;
 
 	*handle = (libewf_handle_t *) internal_handle;
 
@@ -229,9 +255,8 @@ on_error:
 	{
 		if( internal_handle->acquiry_errors != NULL )
 		{
-			libcdata_range_list_free(
+			libewf_sector_range_list_free(
 			 &( internal_handle->acquiry_errors ),
-			 NULL,
 			 NULL );
 		}
 		if( internal_handle->tracks != NULL )
@@ -310,6 +335,35 @@ int libewf_handle_free(
 		}
 		*handle = NULL;
 
+		if( libewf_internal_handle_release_shared_state(
+		     internal_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to release shared state.",
+			 function );
+
+			result = -1;
+		}
+		if( internal_handle->segment_index != NULL )
+		{
+			if( libewf_segment_index_free(
+			     &( internal_handle->segment_index ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free segment index.",
+				 function );
+
+				result = -1;
+			}
+		}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 		if( libcthreads_read_write_lock_free(
 		     &( internal_handle->read_write_lock ),
@@ -379,9 +433,8 @@ int libewf_handle_free(
 
 			result = -1;
 		}
-		if( libcdata_range_list_free(
+		if( libewf_sector_range_list_free(
 		     &( internal_handle->acquiry_errors ),
-		     NULL,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -393,13 +446,64 @@ int libewf_handle_free(
 
 			result = -1;
 		}
+		if( internal_handle->deferred_session_section != NULL )
+		{
+			if( libewf_section_descriptor_free(
+			     &( internal_handle->deferred_session_section ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free deferred session section.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( internal_handle->deferred_error_section != NULL )
+		{
+			if( libewf_section_descriptor_free(
+			     &( internal_handle->deferred_error_section ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free deferred error section.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( internal_handle->running_digest != NULL )
+		{
+			if( libewf_running_digest_free(
+			     &( internal_handle->running_digest ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free running digest.",
+				 function );
+
+				result = -1;
+			}
+		}
 		memory_free(
 		 internal_handle );
 	}
 	return( result );
 }
 
-/* Clones the handle including elements
+/* Clones the handle
+ * The segment table, chunk table, hash sections, header and hash values of the source handle
+ * are not copied but shared by reference with the destination handle
+ * The destination handle has its own current offset, file IO pool and chunk caches
  * Returns 1 if successful or -1 on error
  */
 int libewf_handle_clone(
@@ -439,7 +543,7 @@ int libewf_handle_clone(
 
 		return( 1 );
 	}
-	internal_source_handle = (libewf_internal_handle_t *) *source_handle;
+	internal_source_handle = (libewf_internal_handle_t *) source_handle;
 
 	if( internal_source_handle->io_handle == NULL )
 	{
@@ -452,7 +556,7 @@ int libewf_handle_clone(
 
 		return( -1 );
 	}
-	if( ( internal_source_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	if( ( internal_source_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
@@ -463,6 +567,21 @@ int libewf_handle_clone(
 
 		return( -1 );
 	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_source_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
 	internal_destination_handle = memory_allocate_structure(
 			               libewf_internal_handle_t );
 
@@ -489,6 +608,11 @@ int libewf_handle_clone(
 		 "%s: unable to clear destination handle.",
 		 function );
 
+		memory_free(
+		 internal_destination_handle );
+
+		internal_destination_handle = NULL;
+
 		goto on_error;
 	}
 	if( libewf_io_handle_clone(
@@ -551,11 +675,9 @@ int libewf_handle_clone(
 
 		goto on_error;
 	}
-	if( libcdata_range_list_clone(
+	if( libewf_sector_range_list_clone(
 	     &( internal_destination_handle->acquiry_errors ),
 	     internal_source_handle->acquiry_errors,
-	     NULL,
-	     NULL,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -567,111 +689,98 @@ int libewf_handle_clone(
 
 		goto on_error;
 	}
-	if( internal_source_handle->file_io_pool != NULL )
+	if( internal_source_handle->deferred_session_section != NULL )
 	{
-		if( libbfio_pool_clone(
-		     &( internal_destination_handle->file_io_pool ),
-		     internal_source_handle->file_io_pool,
+		if( libewf_section_descriptor_clone(
+		     &( internal_destination_handle->deferred_session_section ),
+		     internal_source_handle->deferred_session_section,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create destination file IO pool.",
+			 "%s: unable to create destination deferred session section.",
 			 function );
 
 			goto on_error;
 		}
-		internal_destination_handle->file_io_pool_created_in_library = 1;
+		internal_destination_handle->deferred_session_section_file_io_pool_entry = internal_source_handle->deferred_session_section_file_io_pool_entry;
+		internal_destination_handle->deferred_session_section_format_version     = internal_source_handle->deferred_session_section_format_version;
 	}
-	if( internal_source_handle->read_io_handle != NULL )
+	if( internal_source_handle->deferred_error_section != NULL )
 	{
-		if( libewf_read_io_handle_clone(
-		     &( internal_destination_handle->read_io_handle ),
-		     internal_source_handle->read_io_handle,
+		if( libewf_section_descriptor_clone(
+		     &( internal_destination_handle->deferred_error_section ),
+		     internal_source_handle->deferred_error_section,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create destination read IO handle.",
+			 "%s: unable to create destination deferred error section.",
 			 function );
 
 			goto on_error;
 		}
+		internal_destination_handle->deferred_error_section_file_io_pool_entry = internal_source_handle->deferred_error_section_file_io_pool_entry;
+		internal_destination_handle->deferred_error_section_format_version     = internal_source_handle->deferred_error_section_format_version;
 	}
-	if( internal_source_handle->write_io_handle != NULL )
+	if( internal_source_handle->file_io_pool != NULL )
 	{
-		if( libewf_write_io_handle_clone(
-		     &( internal_destination_handle->write_io_handle ),
-		     internal_source_handle->write_io_handle,
+		if( libbfio_pool_clone(
+		     &( internal_destination_handle->file_io_pool ),
+		     internal_source_handle->file_io_pool,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create destination write IO handle.",
+			 "%s: unable to create destination file IO pool.",
 			 function );
 
 			goto on_error;
 		}
+		internal_destination_handle->file_io_pool_created_in_library = 1;
 	}
-	if( libewf_segment_table_clone(
-	     &( internal_destination_handle->segment_table ),
-	     internal_source_handle->segment_table,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create destination segment table.",
-		 function );
-
-		goto on_error;
-	}
-	if( internal_source_handle->chunk_table != NULL )
+	if( internal_source_handle->read_io_handle != NULL )
 	{
-		if( libewf_chunk_table_clone(
-		     &( internal_destination_handle->chunk_table ),
-		     internal_source_handle->chunk_table,
+		if( libewf_read_io_handle_clone(
+		     &( internal_destination_handle->read_io_handle ),
+		     internal_source_handle->read_io_handle,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create destination chunk table.",
+			 "%s: unable to create destination read IO handle.",
 			 function );
 
 			goto on_error;
 		}
 	}
-	if( internal_source_handle->chunk_groups_cache != NULL )
+	if( internal_source_handle->chunk_table != NULL )
 	{
-		if( libfcache_cache_clone(
+		if( libfcache_cache_initialize(
 		     &( internal_destination_handle->chunk_groups_cache ),
-		     internal_source_handle->chunk_groups_cache,
+		     internal_source_handle->maximum_number_of_cached_chunk_groups,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create destination chunks groups cache.",
+			 "%s: unable to create destination chunk groups cache.",
 			 function );
 
 			goto on_error;
 		}
-	}
-	if( internal_source_handle->chunks_cache != NULL )
-	{
-		if( libfcache_cache_clone(
+		if( libfcache_cache_initialize(
 		     &( internal_destination_handle->chunks_cache ),
-		     internal_source_handle->chunks_cache,
+		     internal_source_handle->maximum_number_of_cached_chunks,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -684,83 +793,105 @@ int libewf_handle_clone(
 			goto on_error;
 		}
 	}
-	if( internal_source_handle->hash_sections != NULL )
+	if( internal_source_handle->chunk_cache != NULL )
 	{
-		if( libewf_hash_sections_clone(
-		     &( internal_destination_handle->hash_sections ),
-		     internal_source_handle->hash_sections,
+		if( libewf_chunk_cache_acquire(
+		     internal_source_handle->chunk_cache,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create destination hash sections.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to acquire chunk cache.",
 			 function );
 
 			goto on_error;
 		}
+		internal_destination_handle->chunk_cache            = internal_source_handle->chunk_cache;
+		internal_destination_handle->chunk_cache_key_prefix = internal_source_handle->chunk_cache_key_prefix;
 	}
-	if( internal_source_handle->header_values != NULL )
+	if( libewf_internal_handle_share_state(
+	     internal_source_handle,
+	     error ) != 1 )
 	{
-		if( libfvalue_table_clone(
-		     &( internal_destination_handle->header_values ),
-		     internal_source_handle->header_values,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create destination header values.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to share state of source handle.",
+		 function );
 
-			goto on_error;
-		}
-		internal_destination_handle->header_values_parsed = internal_source_handle->header_values_parsed;
+		goto on_error;
 	}
-	if( internal_source_handle->hash_values != NULL )
+	if( libewf_shared_state_acquire(
+	     internal_source_handle->shared_state,
+	     error ) != 1 )
 	{
-		if( libfvalue_table_clone(
-		     &( internal_destination_handle->hash_values ),
-		     internal_source_handle->hash_values,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create destination hash values.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to acquire shared state.",
+		 function );
 
-			goto on_error;
-		}
-		internal_destination_handle->hash_values_parsed = internal_source_handle->hash_values_parsed;
+		goto on_error;
+	}
+	internal_destination_handle->shared_state  = internal_source_handle->shared_state;
+	internal_destination_handle->segment_table = internal_source_handle->segment_table;
+	internal_destination_handle->chunk_table   = internal_source_handle->chunk_table;
+	internal_destination_handle->hash_sections = internal_source_handle->hash_sections;
+	internal_destination_handle->header_values = internal_source_handle->header_values;
+	internal_destination_handle->hash_values   = internal_source_handle->hash_values;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	internal_destination_handle->read_write_lock = internal_source_handle->read_write_lock;
+#endif
+	internal_destination_handle->header_values_parsed                  = internal_source_handle->header_values_parsed;
+	internal_destination_handle->hash_values_parsed                    = internal_source_handle->hash_values_parsed;
+	internal_destination_handle->maximum_number_of_open_handles        = internal_source_handle->maximum_number_of_open_handles;
+	internal_destination_handle->maximum_number_of_cached_chunk_groups = internal_source_handle->maximum_number_of_cached_chunk_groups;
+	internal_destination_handle->maximum_number_of_cached_chunks       = internal_source_handle->maximum_number_of_cached_chunks;
+	internal_destination_handle->maximum_cache_size                    = internal_source_handle->maximum_cache_size;
+	internal_destination_handle->memory_limit                          = internal_source_handle->memory_limit;
+	internal_destination_handle->number_of_read_ahead_chunks           = internal_source_handle->number_of_read_ahead_chunks;
+	internal_destination_handle->read_priority                         = internal_source_handle->read_priority;
+	internal_destination_handle->segment_prefetch_size                 = internal_source_handle->segment_prefetch_size;
+	internal_destination_handle->number_of_threads                     = internal_source_handle->number_of_threads;
+	internal_destination_handle->scheduler                             = internal_source_handle->scheduler;
+	internal_destination_handle->maximum_number_of_out_of_order_chunks = internal_source_handle->maximum_number_of_out_of_order_chunks;
+	internal_destination_handle->date_format                           = internal_source_handle->date_format;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_source_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		libewf_handle_free(
+		 (libewf_handle_t **) &internal_destination_handle,
+		 NULL );
+
+		return( -1 );
 	}
-	internal_destination_handle->maximum_number_of_open_handles = internal_source_handle->maximum_number_of_open_handles;
-	internal_destination_handle->date_format                    = internal_source_handle->date_format;
+#endif
+	*destination_handle = (libewf_handle_t *) internal_destination_handle;
 
 	return( 1 );
 
 on_error:
 	if( internal_destination_handle != NULL )
 	{
-		if( internal_destination_handle->hash_values != NULL )
-		{
-			libfvalue_table_free(
-			 &( internal_destination_handle->hash_values ),
-			 NULL );
-		}
-		if( internal_destination_handle->header_values != NULL )
-		{
-			libfvalue_table_free(
-			 &( internal_destination_handle->header_values ),
-			 NULL );
-		}
-		if( internal_destination_handle->hash_sections != NULL )
+		if( internal_destination_handle->chunk_cache != NULL )
 		{
-			libewf_hash_sections_free(
-			 &( internal_destination_handle->hash_sections ),
+			libewf_chunk_cache_release(
+			 &( internal_destination_handle->chunk_cache ),
 			 NULL );
 		}
 		if( internal_destination_handle->chunks_cache != NULL )
@@ -775,24 +906,6 @@ on_error:
 			 &( internal_destination_handle->chunk_groups_cache ),
 			 NULL );
 		}
-		if( internal_destination_handle->chunk_table != NULL )
-		{
-			libewf_chunk_table_free(
-			 &( internal_destination_handle->chunk_table ),
-			 NULL );
-		}
-		if( internal_destination_handle->segment_table != NULL )
-		{
-			libewf_segment_table_free(
-			 &( internal_destination_handle->segment_table ),
-			 NULL );
-		}
-		if( internal_destination_handle->write_io_handle != NULL )
-		{
-			libewf_write_io_handle_free(
-			 &( internal_destination_handle->write_io_handle ),
-			 NULL );
-		}
 		if( internal_destination_handle->read_io_handle != NULL )
 		{
 			libewf_read_io_handle_free(
@@ -805,11 +918,22 @@ on_error:
 			 &( internal_destination_handle->file_io_pool ),
 			 NULL );
 		}
+		if( internal_destination_handle->deferred_error_section != NULL )
+		{
+			libewf_section_descriptor_free(
+			 &( internal_destination_handle->deferred_error_section ),
+			 NULL );
+		}
+		if( internal_destination_handle->deferred_session_section != NULL )
+		{
+			libewf_section_descriptor_free(
+			 &( internal_destination_handle->deferred_session_section ),
+			 NULL );
+		}
 		if( internal_destination_handle->acquiry_errors != NULL )
 		{
-			libcdata_range_list_free(
+			libewf_sector_range_list_free(
 			 &( internal_destination_handle->acquiry_errors ),
-			 NULL,
 			 NULL );
 		}
 		if( internal_destination_handle->tracks != NULL )
@@ -841,20 +965,26 @@ on_error:
 		memory_free(
 		 internal_destination_handle );
 	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_source_handle->read_write_lock,
+	 NULL );
+#endif
 	return( -1 );
 }
 
-/* Signals the handle to abort its current activity
+/* Moves the values of the handle that can be shared with clones into a shared state
+ * The values remain set in the handle but are owned by the shared state
+ * This function is not multi-thread safe acquire write lock before call
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_signal_abort(
-     libewf_handle_t *handle,
+int libewf_internal_handle_share_state(
+     libewf_internal_handle_t *internal_handle,
      libcerror_error_t **error )
 {
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_signal_abort";
+	static char *function = "libewf_internal_handle_share_state";
 
-	if( handle == NULL )
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -865,49 +995,64 @@ int libewf_handle_signal_abort(
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
+	if( internal_handle->shared_state != NULL )
+	{
+		/* The values of the handle are already shared unless the handle was reopened
+		 */
+		if( internal_handle->shared_state->segment_table == internal_handle->segment_table )
+		{
+			return( 1 );
+		}
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - shared state value already set.",
+		 function );
 
-	if( internal_handle->io_handle == NULL )
+		return( -1 );
+	}
+	if( libewf_shared_state_initialize(
+	     &( internal_handle->shared_state ),
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create shared state.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle->io_handle->abort = 1;
+	internal_handle->shared_state->io_handle     = internal_handle->io_handle;
+	internal_handle->shared_state->segment_table = internal_handle->segment_table;
+	internal_handle->shared_state->chunk_table   = internal_handle->chunk_table;
+	internal_handle->shared_state->hash_sections = internal_handle->hash_sections;
+	internal_handle->shared_state->header_values = internal_handle->header_values;
+	internal_handle->shared_state->hash_values   = internal_handle->hash_values;
 
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	internal_handle->shared_state->read_write_lock = internal_handle->read_write_lock;
+#endif
 	return( 1 );
 }
 
-/* Opens a set of EWF file(s)
- * For reading files should contain all filenames that make up an EWF image
- * For writing files should contain the base of the filename, extentions like .e01 will be automatically added
+/* Detaches the handle from the values of the shared state
+ * The shared values are unset and the IO handle is replaced by a copy owned by the handle
+ * so that they can be (re)created and freed by the handle without affecting its clones
+ * The read/write lock and the reference to the shared state are retained
+ * This function is not multi-thread safe acquire write lock before call
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_open(
-     libewf_handle_t *handle,
-     char * const filenames[],
-     int number_of_filenames,
-     int access_flags,
+int libewf_internal_handle_detach_shared_state(
+     libewf_internal_handle_t *internal_handle,
      libcerror_error_t **error )
 {
-	libbfio_handle_t *file_io_handle          = NULL;
-	libbfio_pool_t *file_io_pool              = NULL;
-	libewf_internal_handle_t *internal_handle = NULL;
-	libewf_segment_table_t *segment_table     = NULL;
-	char *first_segment_filename              = NULL;
-	static char *function                     = "libewf_handle_open";
-	size_t filename_length                    = 0;
-	int file_io_pool_entry                    = 0;
-	int filename_index                        = 0;
-	int maximum_number_of_open_handles        = 0;
-	int result                                = 0;
+	libewf_io_handle_t *io_handle = NULL;
+	static char *function         = "libewf_internal_handle_detach_shared_state";
 
-	if( handle == NULL )
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -918,11 +1063,204 @@ int libewf_handle_open(
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( filenames == NULL )
+	if( internal_handle->shared_state == NULL )
 	{
-		libcerror_error_set(
+		return( 1 );
+	}
+	if( ( internal_handle->io_handle != NULL )
+	 && ( internal_handle->io_handle == internal_handle->shared_state->io_handle ) )
+	{
+		if( libewf_io_handle_clone(
+		     &io_handle,
+		     internal_handle->io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create IO handle.",
+			 function );
+
+			return( -1 );
+		}
+		internal_handle->io_handle = io_handle;
+	}
+	if( internal_handle->segment_table == internal_handle->shared_state->segment_table )
+	{
+		internal_handle->segment_table = NULL;
+	}
+	if( internal_handle->chunk_table == internal_handle->shared_state->chunk_table )
+	{
+		internal_handle->chunk_table = NULL;
+	}
+	if( internal_handle->hash_sections == internal_handle->shared_state->hash_sections )
+	{
+		internal_handle->hash_sections = NULL;
+	}
+	if( internal_handle->header_values == internal_handle->shared_state->header_values )
+	{
+		internal_handle->header_values = NULL;
+	}
+	if( internal_handle->hash_values == internal_handle->shared_state->hash_values )
+	{
+		internal_handle->hash_values = NULL;
+	}
+	return( 1 );
+}
+
+/* Releases the reference of the handle to the shared state
+ * The shared values are unset, including the read/write lock
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_release_shared_state(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_release_shared_state";
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->shared_state == NULL )
+	{
+		return( 1 );
+	}
+	if( internal_handle->io_handle == internal_handle->shared_state->io_handle )
+	{
+		internal_handle->io_handle = NULL;
+	}
+	if( internal_handle->segment_table == internal_handle->shared_state->segment_table )
+	{
+		internal_handle->segment_table = NULL;
+	}
+	if( internal_handle->chunk_table == internal_handle->shared_state->chunk_table )
+	{
+		internal_handle->chunk_table = NULL;
+	}
+	if( internal_handle->hash_sections == internal_handle->shared_state->hash_sections )
+	{
+		internal_handle->hash_sections = NULL;
+	}
+	if( internal_handle->header_values == internal_handle->shared_state->header_values )
+	{
+		internal_handle->header_values = NULL;
+	}
+	if( internal_handle->hash_values == internal_handle->shared_state->hash_values )
+	{
+		internal_handle->hash_values = NULL;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( internal_handle->read_write_lock == internal_handle->shared_state->read_write_lock )
+	{
+		internal_handle->read_write_lock = NULL;
+	}
+#endif
+	if( libewf_shared_state_release(
+	     &( internal_handle->shared_state ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to release shared state.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Signals the handle to abort its current activity
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_signal_abort(
+     libewf_handle_t *handle,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_signal_abort";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle->io_handle->abort = 1;
+
+	return( 1 );
+}
+
+/* Opens a set of EWF file(s)
+ * For reading files should contain all filenames that make up an EWF image
+ * For writing files should contain the base of the filename, extentions like .e01 will be automatically added
+ * If multiple bases are provided for writing the segment files are striped round-robin over them
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_open(
+     libewf_handle_t *handle,
+     char * const filenames[],
+     int number_of_filenames,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle          = NULL;
+	libbfio_pool_t *file_io_pool              = NULL;
+	libewf_async_reader_t *async_reader       = NULL;
+	libewf_internal_handle_t *internal_handle = NULL;
+	libewf_segment_table_t *segment_table     = NULL;
+	char *first_segment_filename              = NULL;
+	static char *function                     = "libewf_handle_open";
+	size_t filename_length                    = 0;
+	int file_io_pool_entry                    = 0;
+	int filename_index                        = 0;
+	int maximum_number_of_open_handles        = 0;
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( filenames == NULL )
+	{
+		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
@@ -1013,9 +1351,21 @@ int libewf_handle_open(
 
 				goto on_error;
 			}
-			if( libbfio_file_initialize(
-			     &file_io_handle,
-			     error ) != 1 )
+#if defined( HAVE_LIBEWF_MAPPED_FILE_SUPPORT )
+			if( ( access_flags & LIBEWF_ACCESS_FLAG_MEMORY_MAPPED ) != 0 )
+			{
+				result = libewf_mapped_file_initialize(
+				          &file_io_handle,
+				          error );
+			}
+			else
+#endif
+			{
+				result = libbfio_file_initialize(
+				          &file_io_handle,
+				          error );
+			}
+			if( result != 1 )
 			{
 				libcerror_error_set(
 				 error,
@@ -1042,11 +1392,25 @@ int libewf_handle_open(
 				goto on_error;
 			}
 #endif
-			if( libbfio_file_set_name(
-			     file_io_handle,
-			     filenames[ filename_index ],
-			     filename_length,
-			     error ) != 1 )
+#if defined( HAVE_LIBEWF_MAPPED_FILE_SUPPORT )
+			if( ( access_flags & LIBEWF_ACCESS_FLAG_MEMORY_MAPPED ) != 0 )
+			{
+				result = libewf_mapped_file_set_name(
+				          file_io_handle,
+				          filenames[ filename_index ],
+				          filename_length,
+				          error );
+			}
+			else
+#endif
+			{
+				result = libbfio_file_set_name(
+				          file_io_handle,
+				          filenames[ filename_index ],
+				          filename_length,
+				          error );
+			}
+			if( result != 1 )
 			{
 				libcerror_error_set(
 				 error,
@@ -1075,6 +1439,45 @@ int libewf_handle_open(
 			}
 			file_io_handle = NULL;
 
+			/* Segment files that are only read, are read through the asynchronous reader
+			 */
+			if( ( access_flags & ( LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME | LIBEWF_ACCESS_FLAG_MEMORY_MAPPED ) ) == 0 )
+			{
+				if( async_reader == NULL )
+				{
+					if( libewf_async_reader_initialize(
+					     &async_reader,
+					     LIBEWF_ASYNC_READER_MAXIMUM_NUMBER_OF_REQUESTS,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+						 "%s: unable to create async reader.",
+						 function );
+
+						goto on_error;
+					}
+				}
+				if( libewf_async_reader_set_name(
+				     async_reader,
+				     file_io_pool_entry,
+				     filenames[ filename_index ],
+				     filename_length,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set name of file IO pool entry: %d in async reader.",
+					 function,
+					 file_io_pool_entry );
+
+					goto on_error;
+				}
+			}
 #if defined( HAVE_DEBUG_OUTPUT )
 			if( libcnotify_verbose != 0 )
 			{
@@ -1168,6 +1571,33 @@ int libewf_handle_open(
 
 			goto on_error;
 		}
+		/* The additional filenames are used as the basenames of the stripes
+		 * the segment files are distributed over
+		 */
+		for( filename_index = 1;
+		     filename_index < number_of_filenames;
+		     filename_index++ )
+		{
+			filename_length = narrow_string_length(
+					   filenames[ filename_index ] );
+
+			if( libewf_segment_table_append_stripe_basename(
+			     segment_table,
+			     filenames[ filename_index ],
+			     filename_length,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append stripe basename: %d in segment table.",
+				 function,
+				 filename_index );
+
+				goto on_error;
+			}
+		}
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
@@ -1203,6 +1633,9 @@ int libewf_handle_open(
 	else
 	{
 		internal_handle->file_io_pool_created_in_library = 1;
+
+		internal_handle->async_reader = async_reader;
+		async_reader                  = NULL;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	result = libcthreads_read_write_lock_release_for_write(
@@ -1226,6 +1659,12 @@ int libewf_handle_open(
 	return( 1 );
 
 on_error:
+	if( async_reader != NULL )
+	{
+		libewf_async_reader_free(
+		 &async_reader,
+		 NULL );
+	}
 	if( segment_table != NULL )
 	{
 		libewf_segment_table_free(
@@ -1252,6 +1691,7 @@ on_error:
 /* Opens a set of EWF file(s)
  * For reading files should contain all filenames that make up an EWF image
  * For writing files should contain the base of the filename, extentions like .e01 will be automatically added
+ * If multiple bases are provided for writing the segment files are striped round-robin over them
  * Returns 1 if successful or -1 on error
  */
 int libewf_handle_open_wide(
@@ -1263,6 +1703,7 @@ int libewf_handle_open_wide(
 {
 	libbfio_handle_t *file_io_handle          = NULL;
 	libbfio_pool_t *file_io_pool              = NULL;
+	libewf_async_reader_t *async_reader       = NULL;
 	libewf_internal_handle_t *internal_handle = NULL;
 	libewf_segment_table_t *segment_table     = NULL;
 	wchar_t *first_segment_filename           = NULL;
@@ -1441,6 +1882,49 @@ int libewf_handle_open_wide(
 			}
 			file_io_handle = NULL;
 
+#if defined( WINAPI )
+			/* Segment files that are only read, are read through the asynchronous reader
+			 * a wide name is only supported by the overlapped I/O of Windows
+			 */
+			if( ( access_flags & ( LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME | LIBEWF_ACCESS_FLAG_MEMORY_MAPPED ) ) == 0 )
+			{
+				if( async_reader == NULL )
+				{
+					if( libewf_async_reader_initialize(
+					     &async_reader,
+					     LIBEWF_ASYNC_READER_MAXIMUM_NUMBER_OF_REQUESTS,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+						 "%s: unable to create async reader.",
+						 function );
+
+						goto on_error;
+					}
+				}
+				if( libewf_async_reader_set_name_wide(
+				     async_reader,
+				     file_io_pool_entry,
+				     filenames[ filename_index ],
+				     filename_length,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set name of file IO pool entry: %d in async reader.",
+					 function,
+					 file_io_pool_entry );
+
+					goto on_error;
+				}
+			}
+#endif /* defined( WINAPI ) */
+
 #if defined( HAVE_DEBUG_OUTPUT )
 			if( libcnotify_verbose != 0 )
 			{
@@ -1534,11 +2018,38 @@ int libewf_handle_open_wide(
 
 			goto on_error;
 		}
-	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+		/* The additional filenames are used as the basenames of the stripes
+		 * the segment files are distributed over
+		 */
+		for( filename_index = 1;
+		     filename_index < number_of_filenames;
+		     filename_index++ )
+		{
+			filename_length = wide_string_length(
+					   filenames[ filename_index ] );
+
+			if( libewf_segment_table_append_stripe_basename_wide(
+			     segment_table,
+			     filenames[ filename_index ],
+			     filename_length,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append stripe basename: %d in segment table.",
+				 function,
+				 filename_index );
+
+				goto on_error;
+			}
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -1569,6 +2080,9 @@ int libewf_handle_open_wide(
 	else
 	{
 		internal_handle->file_io_pool_created_in_library = 1;
+
+		internal_handle->async_reader = async_reader;
+		async_reader                  = NULL;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	result = libcthreads_read_write_lock_release_for_write(
@@ -1592,6 +2106,12 @@ int libewf_handle_open_wide(
 	return( 1 );
 
 on_error:
+	if( async_reader != NULL )
+	{
+		libewf_async_reader_free(
+		 &async_reader,
+		 NULL );
+	}
 	if( segment_table != NULL )
 	{
 		libewf_segment_table_free(
@@ -2071,7 +2591,8 @@ int libewf_internal_handle_open_read_segment_file_section_data(
 					/* If the chunk_size was unknown when the segment file was opened we
 					 * have to read the chunk groups here
 					 */
-					if( segment_file->number_of_chunks == 0 )
+					if( ( segment_file->number_of_chunks == 0 )
+					 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_METADATA ) == 0 ) )
 					{
 						read_table_sections = 1;
 					}
@@ -2102,14 +2623,39 @@ int libewf_internal_handle_open_read_segment_file_section_data(
 						}
 					}
 #endif
-					read_count = libewf_section_error_read(
-						      section,
-						      internal_handle->io_handle,
-						      file_io_pool,
-						      file_io_pool_entry,
-						      segment_file->major_version,
-						      internal_handle->acquiry_errors,
-						      error );
+					/* On read-only access the acquiry errors are read on first use
+					 */
+					if( internal_handle->write_io_handle == NULL )
+					{
+						if( libewf_internal_handle_set_deferred_section(
+						     internal_handle,
+						     &( internal_handle->deferred_error_section ),
+						     section,
+						     error ) != 1 )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+							 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+							 "%s: unable to set deferred error section.",
+							 function );
+
+							goto on_error;
+						}
+						internal_handle->deferred_error_section_file_io_pool_entry = file_io_pool_entry;
+						internal_handle->deferred_error_section_format_version     = segment_file->major_version;
+					}
+					else
+					{
+						read_count = libewf_section_error_read(
+							      section,
+							      internal_handle->io_handle,
+							      file_io_pool,
+							      file_io_pool_entry,
+							      segment_file->major_version,
+							      internal_handle->acquiry_errors,
+							      error );
+					}
 
 #if defined( HAVE_VERBOSE_OUTPUT )
 					known_section = 1;
@@ -2128,16 +2674,41 @@ int libewf_internal_handle_open_read_segment_file_section_data(
 						}
 					}
 #endif
-					read_count = libewf_section_session_read(
-						      section,
-						      internal_handle->io_handle,
-						      file_io_pool,
-						      file_io_pool_entry,
-						      segment_file->major_version,
-						      internal_handle->media_values,
-						      internal_handle->sessions,
-						      internal_handle->tracks,
-						      error );
+					/* On read-only access the sessions and tracks are read on first use
+					 */
+					if( internal_handle->write_io_handle == NULL )
+					{
+						if( libewf_internal_handle_set_deferred_section(
+						     internal_handle,
+						     &( internal_handle->deferred_session_section ),
+						     section,
+						     error ) != 1 )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+							 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+							 "%s: unable to set deferred session section.",
+							 function );
+
+							goto on_error;
+						}
+						internal_handle->deferred_session_section_file_io_pool_entry = file_io_pool_entry;
+						internal_handle->deferred_session_section_format_version     = segment_file->major_version;
+					}
+					else
+					{
+						read_count = libewf_section_session_read(
+							      section,
+							      internal_handle->io_handle,
+							      file_io_pool,
+							      file_io_pool_entry,
+							      segment_file->major_version,
+							      internal_handle->media_values,
+							      internal_handle->sessions,
+							      internal_handle->tracks,
+							      error );
+					}
 
 #if defined( HAVE_VERBOSE_OUTPUT )
 					known_section = 1;
@@ -2260,48 +2831,56 @@ int libewf_internal_handle_open_read_segment_file_section_data(
 					break;
 
 				case LIBEWF_SECTION_TYPE_ANALYTICAL_DATA:
-					read_count = libewf_section_compressed_string_read(
-						      section,
-					              internal_handle->io_handle,
-						      file_io_pool,
-						      file_io_pool_entry,
-					              internal_handle->io_handle->compression_method,
-						      &string_data,
-						      &string_data_size,
-						      error );
-
-					if( read_count == -1 )
+					/* The analytical data is not exposed by the API and is only
+					 * read and decoded for the debug output
+					 */
+#if defined( HAVE_DEBUG_OUTPUT )
+					if( libcnotify_verbose != 0 )
 					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_IO,
-						 LIBCERROR_IO_ERROR_READ_FAILED,
-						 "%s: unable to read analytical data file object string.",
-						 function );
+						read_count = libewf_section_compressed_string_read(
+							      section,
+						              internal_handle->io_handle,
+							      file_io_pool,
+							      file_io_pool_entry,
+						              internal_handle->io_handle->compression_method,
+							      &string_data,
+							      &string_data_size,
+							      error );
 
-						goto on_error;
-					}
-					else if( read_count != 0 )
-					{
-						if( libewf_analytical_data_parse(
-						     string_data,
-						     string_data_size,
-						     error ) != 1 )
+						if( read_count == -1 )
 						{
 							libcerror_error_set(
 							 error,
-							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-							 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-							 "%s: unable to parse analytical data.",
+							 LIBCERROR_ERROR_DOMAIN_IO,
+							 LIBCERROR_IO_ERROR_READ_FAILED,
+							 "%s: unable to read analytical data file object string.",
 							 function );
 
 							goto on_error;
 						}
-						memory_free(
-						 string_data );
+						else if( read_count != 0 )
+						{
+							if( libewf_analytical_data_parse(
+							     string_data,
+							     string_data_size,
+							     error ) != 1 )
+							{
+								libcerror_error_set(
+								 error,
+								 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+								 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+								 "%s: unable to parse analytical data.",
+								 function );
 
-						string_data = NULL;
+								goto on_error;
+							}
+							memory_free(
+							 string_data );
+
+							string_data = NULL;
+						}
 					}
+#endif
 #if defined( HAVE_VERBOSE_OUTPUT )
 					known_section = 1;
 #endif
@@ -2332,6 +2911,24 @@ int libewf_internal_handle_open_read_segment_file_section_data(
 						      &( internal_handle->single_files->ltree_data_size ),
 						      error );
 
+#if defined( HAVE_LIBEWF_MEMORY_ACCOUNTING )
+					if( read_count != -1 )
+					{
+						if( libewf_single_files_update_memory_accounting(
+						     internal_handle->single_files,
+						     error ) != 1 )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+							 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+							 "%s: unable to update single files memory accounting.",
+							 function );
+
+							read_count = -1;
+						}
+					}
+#endif
 					single_files_section_found = 1;
 
 #if defined( HAVE_VERBOSE_OUTPUT )
@@ -2557,6 +3154,11 @@ int libewf_internal_handle_open_read_segment_file_section_data(
 				{
 					header_sections->header      = string_data;
 					header_sections->header_size = string_data_size;
+
+					LIBEWF_MEMORY_ACCOUNTING_UPDATE(
+					 LIBEWF_MEMORY_TYPE_HEADER_VALUES,
+					 header_sections,
+					 LIBEWF_HEADER_SECTIONS_MEMORY_SIZE( header_sections ) );
 				}
 				else
 				{
@@ -2663,6 +3265,11 @@ int libewf_internal_handle_open_read_segment_file_section_data(
 				{
 					header_sections->header2      = string_data;
 					header_sections->header2_size = string_data_size;
+
+					LIBEWF_MEMORY_ACCOUNTING_UPDATE(
+					 LIBEWF_MEMORY_TYPE_HEADER_VALUES,
+					 header_sections,
+					 LIBEWF_HEADER_SECTIONS_MEMORY_SIZE( header_sections ) );
 				}
 				else
 				{
@@ -2729,6 +3336,11 @@ int libewf_internal_handle_open_read_segment_file_section_data(
 				{
 					header_sections->xheader      = string_data;
 					header_sections->xheader_size = string_data_size;
+
+					LIBEWF_MEMORY_ACCOUNTING_UPDATE(
+					 LIBEWF_MEMORY_TYPE_HEADER_VALUES,
+					 header_sections,
+					 LIBEWF_HEADER_SECTIONS_MEMORY_SIZE( header_sections ) );
 				}
 				else
 				{
@@ -2931,23 +3543,18 @@ on_error:
 	return( -1 );
 }
 
-/* Opens the segment files for reading
+/* Sets a section of which reading is deferred until its values are first used
+ * Replaces a previously deferred section of the same type, since the values
+ * of the last section take precedence
  * Returns 1 if successful or -1 on error
  */
-int libewf_internal_handle_open_read_segment_files(
+int libewf_internal_handle_set_deferred_section(
      libewf_internal_handle_t *internal_handle,
-     libbfio_pool_t *file_io_pool,
-     libewf_segment_table_t *segment_table,
+     libewf_section_descriptor_t **deferred_section,
+     libewf_section_descriptor_t *section,
      libcerror_error_t **error )
 {
-	libewf_segment_file_t *segment_file = NULL;
-	static char *function               = "libewf_internal_handle_open_read_segment_files";
-	size64_t maximum_segment_size       = 0;
-	size64_t segment_file_size          = 0;
-	uint32_t number_of_segments         = 0;
-	uint32_t segment_number             = 0;
-	int file_io_pool_entry              = 0;
-	int last_segment_file               = 0;
+	static char *function = "libewf_internal_handle_set_deferred_section";
 
 	if( internal_handle == NULL )
 	{
@@ -2960,313 +3567,227 @@ int libewf_internal_handle_open_read_segment_files(
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	if( deferred_section == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid deferred section.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->read_io_handle == NULL )
+	if( *deferred_section != NULL )
+	{
+		if( libewf_section_descriptor_free(
+		     deferred_section,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free deferred section.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* The section is owned by the sections cache and therefore is cloned
+	 */
+	if( libewf_section_descriptor_clone(
+	     deferred_section,
+	     section,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - missing read IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create deferred section.",
 		 function );
 
 		return( -1 );
 	}
-	if( segment_table == NULL )
+	return( 1 );
+}
+
+/* Seeks the start of the data of a deferred section
+ * Returns 1 if successful, 0 if the section contains no data or -1 on error
+ */
+int libewf_internal_handle_seek_deferred_section(
+     libewf_internal_handle_t *internal_handle,
+     libewf_section_descriptor_t *deferred_section,
+     int file_io_pool_entry,
+     uint8_t format_version,
+     libcerror_error_t **error )
+{
+	static char *function       = "libewf_internal_handle_seek_deferred_section";
+	off64_t section_data_offset = 0;
+	int result                  = 0;
+
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid segment table.",
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( libewf_segment_table_get_number_of_segments(
-	     segment_table,
-	     &number_of_segments,
-	     error ) != 1 )
+	if( internal_handle->file_io_pool == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of segments from segment table.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
 		 function );
 
 		return( -1 );
 	}
-	if( number_of_segments == 0 )
+	result = libewf_section_get_data_offset(
+	          deferred_section,
+	          format_version,
+	          &section_data_offset,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid number of segments value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve deferred section data offset.",
 		 function );
 
 		return( -1 );
 	}
-	for( segment_number = 0;
-	     segment_number < number_of_segments;
-	     segment_number++ )
+	else if( result != 0 )
 	{
-		if( libewf_segment_table_get_segment_by_index(
-		     segment_table,
-		     segment_number,
-		     &file_io_pool_entry,
-		     &segment_file_size,
-		     error ) != 1 )
+		if( libbfio_pool_seek_offset(
+		     internal_handle->file_io_pool,
+		     file_io_pool_entry,
+		     section_data_offset,
+		     SEEK_SET,
+		     error ) == -1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek deferred section data offset: %" PRIi64 " (0x%08" PRIx64 ") in file IO pool entry: %d.",
 			 function,
-			 segment_number );
+			 section_data_offset,
+			 section_data_offset,
+			 file_io_pool_entry );
 
 			return( -1 );
 		}
-		if( ( segment_number == 0 )
-		 && ( number_of_segments > 1 ) )
-		{
-			/* Round the maximum segment size to nearest number of KiB
-			 */
-			maximum_segment_size = ( segment_file_size >> 10 ) << 10;
+	}
+	return( result );
+}
 
-			if( libewf_segment_table_set_maximum_segment_size(
-			     segment_table,
-			     maximum_segment_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to set maximum segment size in segment table.",
-				 function );
+/* Reads the deferred session section, if any, into the sessions and tracks
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_read_deferred_session_section(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_read_deferred_session_section";
+	ssize_t read_count    = 0;
+	int result            = 0;
 
-				return( -1 );
-			}
-		}
-		if( libewf_segment_table_get_segment_file_by_index(
-		     segment_table,
-		     segment_number,
-		     file_io_pool,
-		     &segment_file,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
-			 function,
-			 segment_number );
-
-			return( -1 );
-		}
-		if( segment_file == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing segment file: %" PRIu32 ".",
-			 function,
-			 segment_number );
-
-			return( -1 );
-		}
-		if( segment_file->segment_number != ( segment_number + 1 ) )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_INPUT,
-			 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
-			 "%s: segment number mismatch ( stored: %" PRIu32 ", expected: %" PRIu32 " ).",
-			 function,
-			 segment_file->segment_number,
-			 segment_number + 1 );
-
-			return( -1 );
-		}
-		if( segment_file->segment_number == 1 )
-		{
-			internal_handle->io_handle->segment_file_type  = segment_file->type;
-			internal_handle->io_handle->major_version      = segment_file->major_version;
-			internal_handle->io_handle->minor_version      = segment_file->minor_version;
-			internal_handle->io_handle->compression_method = segment_file->compression_method;
-
-			if( segment_file->major_version == 2 )
-			{
-				if( memory_copy(
-				     internal_handle->media_values->set_identifier,
-				     segment_file->set_identifier,
-				     16 ) == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_MEMORY,
-					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-					 "%s: unable to copy segment file set identifier to media values.",
-					 function );
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-					return( -1 );
-				}
-			}
-		}
-		else
-		{
-			if( ( segment_file->major_version != internal_handle->io_handle->major_version )
-			 || ( segment_file->minor_version != internal_handle->io_handle->minor_version ) )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_INPUT,
-				 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
-				 "%s: segment file format version value mismatch.",
-				 function );
+		return( -1 );
+	}
+	if( internal_handle->deferred_session_section == NULL )
+	{
+		return( 1 );
+	}
+	result = libewf_internal_handle_seek_deferred_section(
+	          internal_handle,
+	          internal_handle->deferred_session_section,
+	          internal_handle->deferred_session_section_file_io_pool_entry,
+	          internal_handle->deferred_session_section_format_version,
+	          error );
 
-				return( -1 );
-			}
-			if( internal_handle->io_handle->major_version == 2 )
-			{
-				if( segment_file->compression_method != internal_handle->io_handle->compression_method )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_INPUT,
-					 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
-					 "%s: segment file compression method value mismatch.",
-					 function );
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek session section data.",
+		 function );
 
-					return( -1 );
-				}
-				if( memory_compare(
-				     internal_handle->media_values->set_identifier,
-				     segment_file->set_identifier,
-				     16 ) != 0 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_INPUT,
-					 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
-					 "%s: segment file set identifier value mismatch.",
-					 function );
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		read_count = libewf_section_session_read(
+			      internal_handle->deferred_session_section,
+			      internal_handle->io_handle,
+			      internal_handle->file_io_pool,
+			      internal_handle->deferred_session_section_file_io_pool_entry,
+			      internal_handle->deferred_session_section_format_version,
+			      internal_handle->media_values,
+			      internal_handle->sessions,
+			      internal_handle->tracks,
+			      error );
 
-					return( -1 );
-				}
-			}
-		}
-		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_LAST ) != 0 )
-		{
-			last_segment_file = 1;
-		}
-		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_ENCRYPTED ) != 0 )
-		{
-/* TODO get key info */
-			internal_handle->io_handle->format       = LIBEWF_FORMAT_V2_ENCASE7;
-			internal_handle->io_handle->is_encrypted = 1;
-		}
-		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_CORRUPTED ) != 0 )
-		{
-			segment_table->flags |= LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED;
-		}
-		if( libewf_internal_handle_open_read_segment_file_section_data(
-		     internal_handle,
-		     segment_file,
-		     file_io_pool,
-		     file_io_pool_entry,
-		     error ) != 1 )
+		if( read_count == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
 			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read section data from segment file: %" PRIu32 ".",
-			 function,
-			 segment_number );
-
-			return( -1 );
-		}
-		if( libewf_segment_table_set_segment_storage_media_size_by_index(
-		     segment_table,
-		     segment_number,
-		     segment_file->storage_media_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to set mapped range of element: %" PRIu32 " in segment table.",
-			 function,
-			 segment_number );
+			 "%s: unable to read session section.",
+			 function );
 
 			return( -1 );
 		}
-		internal_handle->read_io_handle->storage_media_size_read += segment_file->storage_media_size;
-		internal_handle->read_io_handle->number_of_chunks_read   += segment_file->number_of_chunks;
 	}
-	if( last_segment_file == 0 )
+	if( libewf_section_descriptor_free(
+	     &( internal_handle->deferred_session_section ),
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing done section.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free deferred session section.",
 		 function );
 
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			if( ( error != NULL )
-			 && ( *error != NULL ) )
-			{
-				libcnotify_print_error_backtrace(
-				 *error );
-			}
-		}
-#endif
-		libcerror_error_free(
-		 error );
-
-		segment_table->flags |= LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED;
+		return( -1 );
 	}
 	return( 1 );
 }
 
-/* Opens a set of EWF file(s) using a Basic File IO (bfio) pool
+/* Reads the deferred error section, if any, into the acquiry errors
  * This function is not multi-thread safe acquire write lock before call
  * Returns 1 if successful or -1 on error
  */
-int libewf_internal_handle_open_file_io_pool(
+int libewf_internal_handle_read_deferred_error_section(
      libewf_internal_handle_t *internal_handle,
-     libbfio_pool_t *file_io_pool,
-     int access_flags,
-     libewf_segment_table_t *segment_table,
      libcerror_error_t **error )
 {
-	libbfio_handle_t *file_io_handle    = NULL;
-	libewf_segment_file_t *segment_file = NULL;
-	static char *function               = "libewf_internal_handle_open_file_io_pool";
-	size64_t segment_file_size          = 0;
-	ssize_t read_count                  = 0;
-	int file_io_pool_entry              = 0;
-	int number_of_file_io_handles       = 0;
+	static char *function = "libewf_internal_handle_read_deferred_error_section";
+	ssize_t read_count    = 0;
+	int result            = 0;
 
 	if( internal_handle == NULL )
 	{
@@ -3279,584 +3800,785 @@ int libewf_internal_handle_open_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->file_io_pool != NULL )
+	if( internal_handle->deferred_error_section == NULL )
+	{
+		return( 1 );
+	}
+	result = libewf_internal_handle_seek_deferred_section(
+	          internal_handle,
+	          internal_handle->deferred_error_section,
+	          internal_handle->deferred_error_section_file_io_pool_entry,
+	          internal_handle->deferred_error_section_format_version,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - file IO pool value already set.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek error section data.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	else if( result != 0 )
+	{
+		read_count = libewf_section_error_read(
+			      internal_handle->deferred_error_section,
+			      internal_handle->io_handle,
+			      internal_handle->file_io_pool,
+			      internal_handle->deferred_error_section_file_io_pool_entry,
+			      internal_handle->deferred_error_section_format_version,
+			      internal_handle->acquiry_errors,
+			      error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read error section.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libewf_section_descriptor_free(
+	     &( internal_handle->deferred_error_section ),
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free deferred error section.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_table != NULL )
+	return( 1 );
+}
+
+/* Opens a specific segment file for reading
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_open_read_segment_file(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     uint32_t segment_number,
+     libcerror_error_t **error )
+{
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_internal_handle_open_read_segment_file";
+	size64_t maximum_segment_size       = 0;
+	size64_t segment_file_size          = 0;
+	uint32_t number_of_segments         = 0;
+	int file_io_pool_entry              = 0;
+	int last_segment_file               = 0;
+
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk table value already set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_groups_cache != NULL )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunks group cache value already set.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->chunks_cache != NULL )
+	if( internal_handle->read_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunks cache value already set.",
+		 "%s: invalid handle - missing read IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->hash_sections != NULL )
+	if( segment_table == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - hash sections value already set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment table.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->single_files != NULL )
+	if( libewf_segment_table_get_number_of_segments(
+	     segment_table,
+	     &number_of_segments,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - single files value already set.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments from segment table.",
 		 function );
 
 		return( -1 );
 	}
-	if( file_io_pool == NULL )
+	if( segment_number >= number_of_segments )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file IO pool.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment number value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( ( access_flags & ~( LIBEWF_ACCESS_FLAG_READ | LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) != 0 )
-	 || ( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	  &&  ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 ) ) )
+	if( libewf_segment_table_get_segment_by_index(
+	     segment_table,
+	     segment_number,
+	     &file_io_pool_entry,
+	     &segment_file_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported access flags.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
+		 function,
+		 segment_number );
 
 		return( -1 );
 	}
-	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
+	if( ( segment_number == 0 )
+	 && ( number_of_segments > 1 ) )
 	{
-		if( libewf_read_io_handle_initialize(
-		     &( internal_handle->read_io_handle ),
+		/* Round the maximum segment size to nearest number of KiB
+		 */
+		maximum_segment_size = ( segment_file_size >> 10 ) << 10;
+
+		if( libewf_segment_table_set_maximum_segment_size(
+		     segment_table,
+		     maximum_segment_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create read IO handle.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum segment size in segment table.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
 	}
-	if( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
+	if( libewf_segment_table_get_segment_file_by_index(
+	     segment_table,
+	     segment_number,
+	     file_io_pool,
+	     &segment_file,
+	     error ) != 1 )
 	{
-		if( libewf_write_io_handle_initialize(
-		     &( internal_handle->write_io_handle ),
-		     internal_handle->io_handle,
-		     error ) != 1 )
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
+		 function,
+		 segment_number );
+
+		return( -1 );
+	}
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing segment file: %" PRIu32 ".",
+		 function,
+		 segment_number );
+
+		return( -1 );
+	}
+	if( segment_file->segment_number != ( segment_number + 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+		 "%s: segment number mismatch ( stored: %" PRIu32 ", expected: %" PRIu32 " ).",
+		 function,
+		 segment_file->segment_number,
+		 segment_number + 1 );
+
+		return( -1 );
+	}
+	if( segment_file->segment_number == 1 )
+	{
+		internal_handle->io_handle->segment_file_type  = segment_file->type;
+		internal_handle->io_handle->major_version      = segment_file->major_version;
+		internal_handle->io_handle->minor_version      = segment_file->minor_version;
+		internal_handle->io_handle->compression_method = segment_file->compression_method;
+
+		if( segment_file->major_version == 2 )
+		{
+			if( memory_copy(
+			     internal_handle->media_values->set_identifier,
+			     segment_file->set_identifier,
+			     16 ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy segment file set identifier to media values.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	else
+	{
+		if( ( segment_file->major_version != internal_handle->io_handle->major_version )
+		 || ( segment_file->minor_version != internal_handle->io_handle->minor_version ) )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create write IO handle.",
+			 LIBCERROR_ERROR_DOMAIN_INPUT,
+			 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+			 "%s: segment file format version value mismatch.",
 			 function );
 
-			goto on_error;
+			return( -1 );
+		}
+		if( internal_handle->io_handle->major_version == 2 )
+		{
+			if( segment_file->compression_method != internal_handle->io_handle->compression_method )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_INPUT,
+				 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+				 "%s: segment file compression method value mismatch.",
+				 function );
+
+				return( -1 );
+			}
+			if( memory_compare(
+			     internal_handle->media_values->set_identifier,
+			     segment_file->set_identifier,
+			     16 ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_INPUT,
+				 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+				 "%s: segment file set identifier value mismatch.",
+				 function );
+
+				return( -1 );
+			}
 		}
 	}
-	if( libewf_chunk_table_initialize(
-	     &( internal_handle->chunk_table ),
-	     internal_handle->io_handle,
+	if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_LAST ) != 0 )
+	{
+		last_segment_file = 1;
+	}
+	if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_ENCRYPTED ) != 0 )
+	{
+/* TODO get key info */
+		internal_handle->io_handle->format       = LIBEWF_FORMAT_V2_ENCASE7;
+		internal_handle->io_handle->is_encrypted = 1;
+	}
+	if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_CORRUPTED ) != 0 )
+	{
+		segment_table->flags |= LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED;
+	}
+	if( libewf_internal_handle_open_read_segment_file_section_data(
+	     internal_handle,
+	     segment_file,
+	     file_io_pool,
+	     file_io_pool_entry,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create chunk table.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read section data from segment file: %" PRIu32 ".",
+		 function,
+		 segment_number );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfcache_cache_initialize(
-	     &( internal_handle->chunk_groups_cache ),
-	     LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNK_GROUPS,
+	if( libewf_segment_table_set_segment_storage_media_size_by_index(
+	     segment_table,
+	     segment_number,
+	     segment_file->storage_media_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create chunk groups cache.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to set mapped range of element: %" PRIu32 " in segment table.",
+		 function,
+		 segment_number );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfcache_cache_initialize(
-	     &( internal_handle->chunks_cache ),
-	     LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNKS,
-	     error ) != 1 )
+	internal_handle->read_io_handle->storage_media_size_read += segment_file->storage_media_size;
+	internal_handle->read_io_handle->number_of_chunks_read   += segment_file->number_of_chunks;
+	internal_handle->read_io_handle->number_of_segments_read = segment_number + 1;
+
+	/* The done section is only stored in the last segment file
+	 */
+	if( ( last_segment_file == 0 )
+	 && ( ( segment_number + 1 ) == number_of_segments ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create chunks cache.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing done section.",
 		 function );
 
-		goto on_error;
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			if( ( error != NULL )
+			 && ( *error != NULL ) )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+		}
+#endif
+		libcerror_error_free(
+		 error );
+
+		segment_table->flags |= LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED;
 	}
-	if( libewf_header_values_initialize(
-	     &( internal_handle->header_values ),
-	     error ) != 1 )
+	return( 1 );
+}
+
+/* Opens the segment files for reading
+ * If the lazy access flag is set only the first segment file is read
+ * the other segment files are read on demand
+ * If the metadata access flag is set only the first and last segment file are read
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_open_read_segment_files(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     int access_flags,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libewf_segment_file_t *segment_file       = NULL;
+	libewf_segment_scanner_t *segment_scanner = NULL;
+	int result                                = 0;
+#endif
+	static char *function                     = "libewf_internal_handle_open_read_segment_files";
+	uint32_t number_of_segments               = 0;
+	uint32_t segment_number                   = 0;
+
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create header values.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libewf_hash_sections_initialize(
-	     &( internal_handle->hash_sections ),
-	     error ) != 1 )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create hash sections.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libewf_single_files_initialize(
-	     &( internal_handle->single_files ),
-	     error ) != 1 )
+	if( internal_handle->read_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create single files.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - missing read IO handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libcdata_array_empty(
-	     internal_handle->sessions,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
-	     error ) != 1 )
+	if( segment_table == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty sessions array.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment table.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libcdata_array_empty(
-	     internal_handle->tracks,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
+	if( libewf_segment_table_get_number_of_segments(
+	     segment_table,
+	     &number_of_segments,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty tracks array.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments from segment table.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libcdata_range_list_empty(
-	     internal_handle->acquiry_errors,
-	     NULL,
-	     error ) != 1 )
+	if( number_of_segments == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty acquiry errors range list.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of segments value out of bounds.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
+	internal_handle->read_io_handle->number_of_segments_read = 0;
+
+	if( ( access_flags & LIBEWF_ACCESS_FLAG_METADATA ) != 0 )
 	{
-		if( libbfio_pool_get_number_of_handles(
+		/* The header and volume sections are stored in the first segment file
+		 * and the hash, digest, error2 and session sections in the last
+		 */
+		if( libewf_internal_handle_open_read_segment_file(
+		     internal_handle,
 		     file_io_pool,
-		     &number_of_file_io_handles,
+		     segment_table,
+		     0,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve the number of handles in the pool.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read segment file: 0.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
-		if( libewf_segment_file_initialize(
-		     &segment_file,
-		     internal_handle->io_handle,
-		     error ) != 1 )
+		if( number_of_segments > 1 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create segment file.",
-			 function );
-
-			goto on_error;
-		}
-		for( file_io_pool_entry = 0;
-		     file_io_pool_entry < number_of_file_io_handles;
-		     file_io_pool_entry++ )
-		{
-			if( libbfio_pool_get_size(
-			     file_io_pool,
-			     file_io_pool_entry,
-			     &segment_file_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve size of file IO pool entry: %d.",
-				 function,
-				 file_io_pool_entry );
-
-				goto on_error;
-			}
-			if( libbfio_pool_get_handle(
+			if( libewf_internal_handle_open_read_segment_file(
+			     internal_handle,
 			     file_io_pool,
-			     file_io_pool_entry,
-			     &file_io_handle,
+			     segment_table,
+			     number_of_segments - 1,
 			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to retrieve file IO handle: %d from pool.",
-				 function,
-				 file_io_pool_entry );
-
-				goto on_error;
-			}
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-				 "%s: processing file IO pool entry: %d.\n",
-				 function,
-				 file_io_pool_entry );
-			}
-#endif
-			read_count = libewf_segment_file_read_file_header(
-				      segment_file,
-				      file_io_pool,
-				      file_io_pool_entry,
-				      error );
-
-			if( read_count < 0 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_IO,
 				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read segment file header.",
-				 function );
-
-				goto on_error;
-			}
-			if( segment_file->segment_number == 0 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_INPUT,
-				 LIBCERROR_INPUT_ERROR_INVALID_DATA,
-				 "%s: invalid segment number: 0 in file IO pool entry: %d.",
-				 function,
-				 file_io_pool_entry );
-
-				goto on_error;
-			}
-			if( libewf_segment_table_append_segment_by_segment_file(
-			     segment_table,
-			     segment_file,
-			     file_io_pool_entry,
-			     segment_file_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to append segment: %" PRIu32 " to segment table.",
+				 "%s: unable to read segment file: %" PRIu32 ".",
 				 function,
-				 segment_file->segment_number );
+				 number_of_segments - 1 );
 
-				goto on_error;
+				return( -1 );
 			}
 		}
-		if( libewf_segment_file_free(
-		     &segment_file,
+		return( 1 );
+	}
+	if( ( access_flags & LIBEWF_ACCESS_FLAG_LAZY ) != 0 )
+	{
+		number_of_segments = 1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The file header and section list of the segment files after the first
+	 * are scanned in parallel, the first segment file is needed to determine
+	 * the chunk size
+	 */
+	if( ( internal_handle->number_of_threads > 1 )
+	 && ( number_of_segments > 2 ) )
+	{
+		if( libewf_segment_scanner_initialize(
+		     &segment_scanner,
+		     internal_handle->io_handle,
+		     internal_handle->number_of_threads,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free segment file.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create segment scanner.",
 			 function );
 
 			goto on_error;
 		}
-		if( libewf_internal_handle_open_read_segment_files(
-		     internal_handle,
-		     file_io_pool,
-		     segment_table,
-		     error ) != 1 )
+	}
+#endif
+	for( segment_number = 0;
+	     segment_number < number_of_segments;
+	     segment_number++ )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( segment_scanner != NULL )
+		 && ( segment_number > 0 ) )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read segment files.",
-			 function );
+			result = libewf_segment_scanner_get_segment_file(
+			          segment_scanner,
+			          file_io_pool,
+			          segment_table,
+			          segment_number,
+			          &segment_file,
+			          error );
 
-			if( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 )
+			if( result == -1 )
 			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve scanned segment file: %" PRIu32 ".",
+				 function,
+				 segment_number );
+
 				goto on_error;
 			}
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
+			/* A segment file that could not be scanned is read by
+			 * libewf_internal_handle_open_read_segment_file
+			 */
+			else if( result != 0 )
 			{
-				if( ( error != NULL )
-				 && ( *error != NULL ) )
+				if( libewf_segment_table_set_segment_file_by_index(
+				     segment_table,
+				     file_io_pool,
+				     segment_number,
+				     segment_file,
+				     error ) != 1 )
 				{
-					libcnotify_print_error_backtrace(
-					 *error );
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set segment file: %" PRIu32 " in segment table.",
+					 function,
+					 segment_number );
+
+					goto on_error;
 				}
+				/* The segment file is now managed by the segment table
+				 */
+				segment_file = NULL;
 			}
-#endif
-			libcerror_error_free(
-			 error );
 		}
-		if( internal_handle->media_values == NULL )
+#endif
+		if( libewf_internal_handle_open_read_segment_file(
+		     internal_handle,
+		     file_io_pool,
+		     segment_table,
+		     segment_number,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid handle - missing media values.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read segment file: %" PRIu32 ".",
+			 function,
+			 segment_number );
 
 			goto on_error;
 		}
-/* TODO refactor */
-		if( internal_handle->single_files->ltree_data == NULL )
-		{
-			if( libewf_internal_handle_get_media_values(
-			     internal_handle,
-			     &( internal_handle->media_values->media_size ),
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to determine media values.",
-				 function );
-
-				goto on_error;
-			}
-		}
 	}
-	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
-	 && ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( segment_scanner != NULL )
 	{
-		if( internal_handle->write_io_handle->values_initialized == 0 )
-		{
-			if( libewf_write_io_handle_initialize_values(
-			     internal_handle->write_io_handle,
-			     internal_handle->io_handle,
-			     internal_handle->media_values,
-			     segment_table,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to initialize write IO handle values.",
-				 function );
-
-				goto on_error;
-			}
-		}
-		if( libewf_write_io_handle_initialize_resume(
-		     internal_handle->write_io_handle,
-		     internal_handle->io_handle,
-		     file_io_pool,
-		     internal_handle->media_values,
-		     segment_table,
-		     internal_handle->chunk_table,
-		     internal_handle->read_io_handle,
-		     &( internal_handle->current_offset ),
+		if( libewf_segment_scanner_free(
+		     &segment_scanner,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize write IO handle to resume.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free segment scanner.",
 			 function );
 
 			goto on_error;
 		}
 	}
-			internal_handle->io_handle->chunk_size = internal_handle->media_values->chunk_size;
-	internal_handle->io_handle->access_flags = access_flags;
-	internal_handle->file_io_pool            = file_io_pool;
-	internal_handle->segment_table           = segment_table;
-
+#endif
 	return( 1 );
 
 on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( segment_file != NULL )
 	{
 		libewf_segment_file_free(
 		 &segment_file,
 		 NULL );
 	}
-	if( internal_handle->single_files != NULL )
+	if( segment_scanner != NULL )
 	{
-		libewf_single_files_free(
-		 &( internal_handle->single_files ),
+		libewf_segment_scanner_free(
+		 &segment_scanner,
 		 NULL );
 	}
-	if( internal_handle->hash_sections != NULL )
+#endif
+	return( -1 );
+}
+
+/* Reads the segment files that have not been read yet up to and including
+ * the segment file that contains the offset
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_read_segment_files_to_offset(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     libcerror_error_t **error )
+{
+	static char *function       = "libewf_internal_handle_read_segment_files_to_offset";
+	uint32_t number_of_segments = 0;
+
+	if( internal_handle == NULL )
 	{
-		libewf_hash_sections_free(
-		 &( internal_handle->hash_sections ),
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
 	}
-	if( internal_handle->header_values != NULL )
+	if( internal_handle->io_handle == NULL )
 	{
-		libfvalue_table_free(
-		 &( internal_handle->header_values ),
-		 NULL );
-	}
-	if( internal_handle->chunks_cache != NULL )
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
 	{
-		libfcache_cache_free(
-		 &( internal_handle->chunks_cache ),
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
 	}
-	if( internal_handle->chunk_groups_cache != NULL )
+	if( ( internal_handle->read_io_handle == NULL )
+	 || ( internal_handle->segment_table == NULL ) )
 	{
-		libfcache_cache_free(
-		 &( internal_handle->chunk_groups_cache ),
-		 NULL );
+		return( 1 );
 	}
-	if( internal_handle->chunk_table != NULL )
+	if( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_METADATA ) != 0 )
 	{
-		libewf_chunk_table_free(
-		 &( internal_handle->chunk_table ),
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid handle - media data is not available when opened for metadata only.",
+		 function );
+
+		return( -1 );
 	}
-	if( internal_handle->write_io_handle != NULL )
+	if( libewf_segment_table_get_number_of_segments(
+	     internal_handle->segment_table,
+	     &number_of_segments,
+	     error ) != 1 )
 	{
-		libewf_write_io_handle_free(
-		 &( internal_handle->write_io_handle ),
-		 error );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments from segment table.",
+		 function );
+
+		return( -1 );
 	}
-	if( internal_handle->read_io_handle != NULL )
+	while( ( internal_handle->read_io_handle->number_of_segments_read < number_of_segments )
+	    && ( (size64_t) offset >= internal_handle->read_io_handle->storage_media_size_read ) )
 	{
-		libewf_read_io_handle_free(
-		 &( internal_handle->read_io_handle ),
-		 error );
+		if( libewf_internal_handle_open_read_segment_file(
+		     internal_handle,
+		     file_io_pool,
+		     internal_handle->segment_table,
+		     internal_handle->read_io_handle->number_of_segments_read,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read segment file: %" PRIu32 ".",
+			 function,
+			 internal_handle->read_io_handle->number_of_segments_read );
+
+			return( -1 );
+		}
 	}
-	return( -1 );
+	return( 1 );
 }
 
-/* Opens a set of EWF file(s) using a Basic File IO (bfio) pool
- * Returns 1 if successful or -1 on error
+/* Appends the chunk groups of the segment files that have not been indexed yet
+ * to the current batch of the chunk group scanner
+ * The segment files that have not been read yet are read first
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if chunk groups were appended, 0 if no segment files remain or -1 on error
  */
-int libewf_handle_open_file_io_pool(
-     libewf_handle_t *handle,
-     libbfio_pool_t *file_io_pool,
-     int access_flags,
+int libewf_internal_handle_append_index_segment_files(
+     libewf_internal_handle_t *internal_handle,
+     libewf_chunk_group_scanner_t *chunk_group_scanner,
+     uint32_t *segment_number,
+     off64_t *segment_offset,
      libcerror_error_t **error )
 {
-	libewf_internal_handle_t *internal_handle = NULL;
-	libewf_segment_table_t *segment_table     = NULL;
-	static char *function                     = "libewf_handle_open_file_io_pool";
-	int result                                = 0;
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_internal_handle_append_index_segment_files";
+	size64_t segment_file_size          = 0;
+	size64_t storage_media_size         = 0;
+	uint32_t number_of_segments         = 0;
+	int file_io_pool_entry              = 0;
+	int result                          = 0;
 
-	if( handle == NULL )
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -3867,436 +4589,654 @@ int libewf_handle_open_file_io_pool(
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->file_io_pool != NULL )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - file IO pool value already set.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( libewf_segment_table_initialize(
-	     &segment_table,
-	     internal_handle->io_handle,
-	     LIBEWF_DEFAULT_SEGMENT_FILE_SIZE,
-	     error ) != 1 )
+	if( internal_handle->read_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create segment table.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing read IO handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( chunk_group_scanner == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group scanner.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	result = libewf_internal_handle_open_file_io_pool(
-	          internal_handle,
-	          file_io_pool,
-	          access_flags,
-	          segment_table,
-	          error );
-
-	if( result != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to open handle using a file IO pool.",
-		 function );
-	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	result = libcthreads_read_write_lock_release_for_write(
-	          internal_handle->read_write_lock,
-	          error );
-
-	if( result != 1 )
+	if( segment_number == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment number.",
 		 function );
-	}
-#endif
-	if( result != 1 )
-	{
-		goto on_error;
-	}
-	return( 1 );
 
-on_error:
-	if( segment_table != NULL )
-	{
-		libewf_segment_table_free(
-		 &segment_table,
-		 NULL );
+		return( -1 );
 	}
-	return( -1 );
-}
-
-/* Closes the EWF handle
- * Returns 0 if successful or -1 on error
- */
-int libewf_handle_close(
-     libewf_handle_t *handle,
-     libcerror_error_t **error )
-{
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_close";
-	ssize_t write_count                       = 0;
-	int result                                = 0;
-
-	if( handle == NULL )
+	if( segment_offset == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 "%s: invalid segment offset.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
+	if( internal_handle->io_handle->chunk_size == 0 )
+	{
+		return( 0 );
+	}
+	if( libewf_segment_table_get_number_of_segments(
+	     internal_handle->segment_table,
+	     &number_of_segments,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments from segment table.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( ( internal_handle->write_io_handle != NULL )
-	 && ( internal_handle->write_io_handle->write_finalized == 0 ) )
+	while( *segment_number < number_of_segments )
 	{
-		write_count = libewf_internal_handle_write_finalize_file_io_pool(
-		               internal_handle,
-		               internal_handle->file_io_pool,
-		               error );
+		/* On a lazy open the segment file is read before its chunk groups are appended
+		 */
+		if( *segment_number >= internal_handle->read_io_handle->number_of_segments_read )
+		{
+			if( libewf_internal_handle_read_segment_files_to_offset(
+			     internal_handle,
+			     internal_handle->file_io_pool,
+			     *segment_offset,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read segment file: %" PRIu32 ".",
+				 function,
+				 *segment_number );
 
-		if( write_count < 0 )
+				return( -1 );
+			}
+			if( *segment_number >= internal_handle->read_io_handle->number_of_segments_read )
+			{
+				break;
+			}
+		}
+		if( libewf_segment_table_get_segment_by_index(
+		     internal_handle->segment_table,
+		     *segment_number,
+		     &file_io_pool_entry,
+		     &segment_file_size,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to finalize write.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
+			 function,
+			 *segment_number );
 
-			result = -1;
+			return( -1 );
 		}
-	}
-	if( internal_handle->file_io_pool_created_in_library != 0 )
-	{
-		if( libbfio_pool_close_all(
-		     internal_handle->file_io_pool,
-		     error ) != 0 )
+		if( libewf_segment_table_get_segment_storage_media_size_by_index(
+		     internal_handle->segment_table,
+		     *segment_number,
+		     &storage_media_size,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
-			 "%s: unable to close all file IO pool handles.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %" PRIu32 " storage media size from segment table.",
+			 function,
+			 *segment_number );
 
-			result = -1;
+			return( -1 );
 		}
-		if( libbfio_pool_free(
-		     &( internal_handle->file_io_pool ),
+		if( libewf_segment_table_get_segment_file_by_index(
+		     internal_handle->segment_table,
+		     *segment_number,
+		     internal_handle->file_io_pool,
+		     &segment_file,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free file IO pool.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
+			 function,
+			 *segment_number );
 
-			result = -1;
+			return( -1 );
 		}
-		internal_handle->file_io_pool_created_in_library = 0;
+		result = libewf_chunk_group_scanner_append_segment_file(
+		          chunk_group_scanner,
+		          internal_handle->file_io_pool,
+		          segment_file,
+		          *segment_number,
+		          file_io_pool_entry,
+		          (uint64_t) *segment_offset / internal_handle->io_handle->chunk_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append segment file: %" PRIu32 " to chunk group scanner.",
+			 function,
+			 *segment_number );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		*segment_offset += (off64_t) storage_media_size;
+		*segment_number += 1;
 	}
-	internal_handle->file_io_pool = NULL;
+	if( chunk_group_scanner->number_of_entries == 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
 
-	if( libewf_io_handle_clear(
-	     internal_handle->io_handle,
-	     error ) != 1 )
+/* Indexes the chunk groups of the segment files
+ * The table sections of the segment files are read and validated in parallel
+ * by the chunk group scanner and the resulting chunk groups are added to the chunks index
+ * so that reading media data does not need to read the table sections on first access
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_index_chunk_groups(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	libewf_chunk_group_scanner_t *chunk_group_scanner = NULL;
+	static char *function                             = "libewf_internal_handle_index_chunk_groups";
+	off64_t segment_offset                            = 0;
+	uint32_t segment_number                           = 0;
+	int number_of_threads                             = 1;
+	int result                                        = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to clear IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
-	if( libewf_media_values_clear(
-	     internal_handle->media_values,
+	if( ( internal_handle->file_io_pool == NULL )
+	 || ( internal_handle->segment_table == NULL )
+	 || ( internal_handle->read_io_handle == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - handle not opened for reading.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->write_io_handle != NULL )
+	 || ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_METADATA ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid handle - chunk groups can only be indexed when opened for reading media data.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->number_of_threads > 1 )
+	{
+		number_of_threads = internal_handle->number_of_threads;
+	}
+	if( libewf_chunk_group_scanner_initialize(
+	     &chunk_group_scanner,
+	     internal_handle->io_handle,
+	     number_of_threads,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to clear media values.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk group scanner.",
 		 function );
 
-		result = -1;
+		goto on_error;
 	}
-	if( internal_handle->read_io_handle != NULL )
+	do
 	{
-		if( libewf_read_io_handle_free(
-		     &( internal_handle->read_io_handle ),
-		     error ) != 1 )
+		result = libewf_internal_handle_append_index_segment_files(
+		          internal_handle,
+		          chunk_group_scanner,
+		          &segment_number,
+		          &segment_offset,
+		          error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free read IO handle.",
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append segment files to chunk group scanner.",
 			 function );
 
-			result = -1;
+			goto on_error;
 		}
-	}
-	if( internal_handle->write_io_handle != NULL )
-	{
-		if( libewf_write_io_handle_free(
-		     &( internal_handle->write_io_handle ),
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( libewf_chunk_group_scanner_scan(
+		     chunk_group_scanner,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free write IO handle.",
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to scan chunk groups.",
 			 function );
 
-			result = -1;
+			goto on_error;
 		}
-	}
-	/* Free the chunk data if it could not be passed to libfcache_cache_set_value_by_index
-	 */
-	if( internal_handle->chunk_data != NULL )
-	{
-		if( libewf_chunk_data_free(
-		     &( internal_handle->chunk_data ),
+		if( libewf_chunk_group_scanner_index(
+		     chunk_group_scanner,
+		     internal_handle->chunk_table,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free chunk data.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to index chunk groups.",
 			 function );
 
-			result = -1;
+			goto on_error;
 		}
 	}
-	if( internal_handle->segment_table != NULL )
+	while( result == 1 );
+
+	if( libewf_chunk_group_scanner_free(
+	     &chunk_group_scanner,
+	     error ) != 1 )
 	{
-		if( libewf_segment_table_free(
-		     &( internal_handle->segment_table ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free segment table.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free chunk group scanner.",
+		 function );
 
-			result = -1;
-		}
+		goto on_error;
 	}
-	if( internal_handle->chunk_table != NULL )
+	return( 1 );
+
+on_error:
+	if( chunk_group_scanner != NULL )
 	{
-		if( libewf_chunk_table_free(
-		     &( internal_handle->chunk_table ),
-		     error ) != 1 )
+		libewf_chunk_group_scanner_free(
+		 &chunk_group_scanner,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* The index thread function
+ * The handle lock is only held to append a batch of segment files and to index
+ * the chunk groups read, hence media data can be read while the batch is scanned
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_index_thread_function(
+     libewf_internal_handle_t *internal_handle )
+{
+	libcerror_error_t *error                          = NULL;
+	libewf_chunk_group_scanner_t *chunk_group_scanner = NULL;
+	static char *function                             = "libewf_internal_handle_index_thread_function";
+	off64_t segment_offset                            = 0;
+	uint32_t segment_number                           = 0;
+	int number_of_threads                             = 1;
+	int result                                        = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( internal_handle->number_of_threads > 1 )
+	{
+		number_of_threads = internal_handle->number_of_threads;
+	}
+	if( libewf_chunk_group_scanner_initialize(
+	     &chunk_group_scanner,
+	     internal_handle->io_handle,
+	     number_of_threads,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk group scanner.",
+		 function );
+
+		goto on_error;
+	}
+	while( 1 )
+	{
+		if( libcthreads_read_write_lock_grab_for_write(
+		     internal_handle->read_write_lock,
+		     &error ) != 1 )
 		{
 			libcerror_error_set(
-			 error,
+			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free chunk table.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for writing.",
 			 function );
 
-			result = -1;
+			goto on_error;
 		}
-	}
-	if( internal_handle->chunk_groups_cache != NULL )
-	{
-		if( libfcache_cache_free(
-		     &( internal_handle->chunk_groups_cache ),
-		     error ) != 1 )
+		result = 0;
+
+		if( internal_handle->index_stop == 0 )
+		{
+			result = libewf_internal_handle_append_index_segment_files(
+			          internal_handle,
+			          chunk_group_scanner,
+			          &segment_number,
+			          &segment_offset,
+			          &error );
+		}
+		if( libcthreads_read_write_lock_release_for_write(
+		     internal_handle->read_write_lock,
+		     &error ) != 1 )
 		{
 			libcerror_error_set(
-			 error,
+			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free chunk groups cache.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for writing.",
 			 function );
 
-			result = -1;
+			goto on_error;
 		}
-	}
-	if( internal_handle->chunks_cache != NULL )
-	{
-		if( libfcache_cache_free(
-		     &( internal_handle->chunks_cache ),
-		     error ) != 1 )
+		if( result == -1 )
 		{
 			libcerror_error_set(
-			 error,
+			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free chunks cache.",
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append segment files to chunk group scanner.",
 			 function );
 
-			result = -1;
+			goto on_error;
 		}
-	}
-	if( internal_handle->hash_sections != NULL )
-	{
-		if( libewf_hash_sections_free(
-		     &( internal_handle->hash_sections ),
-		     error ) != 1 )
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( libewf_chunk_group_scanner_scan(
+		     chunk_group_scanner,
+		     &error ) != 1 )
 		{
 			libcerror_error_set(
-			 error,
+			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free hash sections.",
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to scan chunk groups.",
 			 function );
 
-			result = -1;
+			goto on_error;
 		}
-	}
-	if( internal_handle->header_values != NULL )
-	{
-		if( libfvalue_table_free(
-		     &( internal_handle->header_values ),
-		     error ) != 1 )
+		if( libcthreads_read_write_lock_grab_for_write(
+		     internal_handle->read_write_lock,
+		     &error ) != 1 )
 		{
 			libcerror_error_set(
-			 error,
+			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free header values.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for writing.",
 			 function );
 
-			result = -1;
+			goto on_error;
 		}
-	}
-	if( internal_handle->hash_values != NULL )
-	{
-		if( libfvalue_table_free(
-		     &( internal_handle->hash_values ),
-		     error ) != 1 )
+		if( internal_handle->index_stop == 0 )
+		{
+			result = libewf_chunk_group_scanner_index(
+			          chunk_group_scanner,
+			          internal_handle->chunk_table,
+			          &error );
+		}
+		else
+		{
+			result = libewf_chunk_group_scanner_clear_entries(
+			          chunk_group_scanner,
+			          &error );
+		}
+		if( libcthreads_read_write_lock_release_for_write(
+		     internal_handle->read_write_lock,
+		     &error ) != 1 )
 		{
 			libcerror_error_set(
-			 error,
+			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free hash values.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for writing.",
 			 function );
 
-			result = -1;
+			goto on_error;
 		}
-	}
-	if( internal_handle->single_files != NULL )
-	{
-		if( libewf_single_files_free(
-		     &( internal_handle->single_files ),
-		     error ) != 1 )
+		if( result != 1 )
 		{
 			libcerror_error_set(
-			 error,
+			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free single files.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to index chunk groups.",
 			 function );
 
-			result = -1;
+			goto on_error;
 		}
 	}
-	if( libcdata_array_empty(
-	     internal_handle->sessions,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
-	     error ) != 1 )
+	if( libewf_chunk_group_scanner_free(
+	     &chunk_group_scanner,
+	     &error ) != 1 )
 	{
 		libcerror_error_set(
-		 error,
+		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty sessions array.",
+		 "%s: unable to free chunk group scanner.",
 		 function );
 
-		result = -1;
+		goto on_error;
 	}
-	if( libcdata_array_empty(
-	     internal_handle->tracks,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
-	     error ) != 1 )
+	return( 1 );
+
+on_error:
+	/* Chunk groups that could not be indexed are read on first access,
+	 * which is also where the error is reported
+	 */
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_group_scanner != NULL )
+	{
+		libewf_chunk_group_scanner_free(
+		 &chunk_group_scanner,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Starts the index thread
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_index_start(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_index_start";
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->index_thread != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty tracks array.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - index thread value already set.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
-	if( libcdata_range_list_empty(
-	     internal_handle->acquiry_errors,
+	internal_handle->index_stop = 0;
+
+	if( libcthreads_thread_create(
+	     &( internal_handle->index_thread ),
 	     NULL,
+	     (int (*)(void *)) &libewf_internal_handle_index_thread_function,
+	     (void *) internal_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty acquiry errors range list.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create index thread.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
-/* TODO clear IO handle, segment tables */
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	return( 1 );
+}
+
+/* Stops the index thread
+ * The index thread acquires the write lock, do not hold it when calling this function
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_index_stop(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_index_stop";
+	int result            = 1;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->index_thread == NULL )
+	{
+		return( 1 );
+	}
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle->index_stop = 1;
+
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
@@ -4308,30 +5248,47 @@ int libewf_handle_close(
 		 "%s: unable to release read/write lock for writing.",
 		 function );
 
+		return( -1 );
+	}
+	if( libcthreads_thread_join(
+	     &( internal_handle->index_thread ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join index thread.",
+		 function );
+
 		result = -1;
 	}
-#endif
+	internal_handle->index_stop = 0;
+
 	return( result );
 }
 
-/* Reads (media) data from the last current into a buffer using a Basic File IO (bfio) pool
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* Opens a set of EWF file(s) using a Basic File IO (bfio) pool
  * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
-         libewf_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libewf_internal_handle_open_file_io_pool(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     int access_flags,
+     libewf_segment_table_t *segment_table,
+     libcerror_error_t **error )
 {
-	libewf_chunk_data_t *chunk_data = NULL;
-	static char *function           = "libewf_internal_handle_read_buffer_from_file_io_pool";
-	off64_t chunk_data_offset       = 0;
-	uint64_t chunk_index            = 0;
-	size_t buffer_offset            = 0;
-	size_t read_size                = 0;
-	ssize_t total_read_count        = 0;
+	libbfio_handle_t *file_io_handle    = NULL;
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_internal_handle_open_file_io_pool";
+	size64_t segment_file_size          = 0;
+	ssize_t read_count                  = 0;
+	int file_io_pool_entry              = 0;
+	int number_of_file_io_handles       = 0;
+	int result                          = 1;
 
 	if( internal_handle == NULL )
 	{
@@ -4344,6 +5301,17 @@ ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
 
 		return( -1 );
 	}
+	if( internal_handle->file_io_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - file IO pool value already set.",
+		 function );
+
+		return( -1 );
+	}
 	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
@@ -4355,749 +5323,677 @@ ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_data != NULL )
+	if( internal_handle->chunk_table != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
+		 "%s: invalid handle - chunk table value already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+	if( internal_handle->chunk_groups_cache != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunks group cache value already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values == NULL )
+	if( internal_handle->chunks_cache != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunks cache value already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+	if( internal_handle->hash_sections != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - hash sections value already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer == NULL )
+	if( internal_handle->single_files != NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - single files value already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer_size > (size_t) SSIZE_MAX )
+	if( file_io_pool == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid buffer size value exceeds maximum.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool.",
 		 function );
 
 		return( -1 );
 	}
-	if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
-	{
-		return( 0 );
-	}
-	if( (size64_t) ( internal_handle->current_offset + buffer_size ) >= internal_handle->media_values->media_size )
+	if( ( ( access_flags & ~( LIBEWF_ACCESS_FLAG_READ | LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME | LIBEWF_ACCESS_FLAG_LAZY | LIBEWF_ACCESS_FLAG_MEMORY_MAPPED | LIBEWF_ACCESS_FLAG_UNBUFFERED | LIBEWF_ACCESS_FLAG_PREALLOCATE | LIBEWF_ACCESS_FLAG_SEQUENTIAL | LIBEWF_ACCESS_FLAG_METADATA | LIBEWF_ACCESS_FLAG_INDEX ) ) != 0 )
+	 || ( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	  &&  ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 ) )
+	 || ( ( ( access_flags & ( LIBEWF_ACCESS_FLAG_LAZY | LIBEWF_ACCESS_FLAG_MEMORY_MAPPED | LIBEWF_ACCESS_FLAG_METADATA | LIBEWF_ACCESS_FLAG_INDEX ) ) != 0 )
+	  &&  ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) == 0 ) )
+	 || ( ( ( access_flags & LIBEWF_ACCESS_FLAG_METADATA ) != 0 )
+	  &&  ( ( access_flags & ( LIBEWF_ACCESS_FLAG_RESUME | LIBEWF_ACCESS_FLAG_LAZY | LIBEWF_ACCESS_FLAG_INDEX ) ) != 0 ) )
+	 || ( ( ( access_flags & ( LIBEWF_ACCESS_FLAG_UNBUFFERED | LIBEWF_ACCESS_FLAG_PREALLOCATE | LIBEWF_ACCESS_FLAG_SEQUENTIAL ) ) != 0 )
+	  &&  ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) == 0 ) )
+	 || ( ( ( access_flags & LIBEWF_ACCESS_FLAG_SEQUENTIAL ) != 0 )
+	  &&  ( ( access_flags & ( LIBEWF_ACCESS_FLAG_RESUME | LIBEWF_ACCESS_FLAG_PREALLOCATE ) ) != 0 ) ) )
 	{
-		buffer_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->current_offset );
-	}
-	chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access flags.",
+		 function );
 
-	while( buffer_size > 0 )
+		return( -1 );
+	}
+	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
 	{
-		if( libewf_chunk_table_get_chunk_data_by_offset(
-		     internal_handle->chunk_table,
-		     chunk_index,
-		     internal_handle->io_handle,
-		     file_io_pool,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
-		     internal_handle->chunk_groups_cache,
-		     internal_handle->chunks_cache,
-		     internal_handle->current_offset,
-		     &chunk_data,
-		     &chunk_data_offset,
+		if( libewf_read_io_handle_initialize(
+		     &( internal_handle->read_io_handle ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to read chunk: %" PRIu64 " data.",
-			 function,
-			 chunk_index );
-
-			return( -1 );
-		}
-		if( chunk_data == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing chunk: %" PRIu64 " data.",
-			 function,
-			 chunk_index );
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create read IO handle.",
+			 function );
 
-			return( -1 );
+			goto on_error;
 		}
-		if( (off64_t) chunk_data_offset > (off64_t) chunk_data->data_size )
+	}
+	if( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		if( libewf_write_io_handle_initialize(
+		     &( internal_handle->write_io_handle ),
+		     internal_handle->io_handle,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: chunk: %" PRIu64 " offset exceeds data size.",
-			 function,
-			 chunk_index );
-
-			return( -1 );
-		}
-		read_size = (size_t) ( chunk_data->data_size - chunk_data_offset );
-
-		if( read_size > buffer_size )
-		{
-			read_size = buffer_size;
-		}
-		if( read_size == 0 )
-		{
-			break;
-		}
-		if( memory_copy(
-		     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-		     &( ( chunk_data->data )[ chunk_data_offset ] ),
-		     read_size ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
-			 function,
-			 chunk_index );
-
-			return( -1 );
-		}
-		buffer_offset    += read_size;
-		buffer_size      -= read_size;
-		total_read_count += (ssize_t) read_size;
-		chunk_index      += 1;
-
-		internal_handle->current_offset += (off64_t) read_size;
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create write IO handle.",
+			 function );
 
-		if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
-		{
-			break;
-		}
-		if( internal_handle->io_handle->abort != 0 )
-		{
-			break;
+			goto on_error;
 		}
-		chunk_data        = NULL;
-		chunk_data_offset = 0;
 	}
-	return( total_read_count );
-}
-
-/* Reads (media) data at the current offset into a buffer
- * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
- */
-ssize_t libewf_handle_read_buffer(
-         libewf_handle_t *handle,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
-{
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_read_buffer";
-	ssize_t read_count                        = 0;
-
-	if( handle == NULL )
+	if( libewf_chunk_table_initialize(
+	     &( internal_handle->chunk_table ),
+	     internal_handle->io_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk table.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->file_io_pool == NULL )
+	if( libfcache_cache_initialize(
+	     &( internal_handle->chunk_groups_cache ),
+	     internal_handle->maximum_number_of_cached_chunk_groups,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk groups cache.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
+	if( libfcache_cache_initialize(
+	     &( internal_handle->chunks_cache ),
+	     internal_handle->maximum_number_of_cached_chunks,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunks cache.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	read_count = libewf_internal_handle_read_buffer_from_file_io_pool(
-		      internal_handle,
-		      internal_handle->file_io_pool,
-		      buffer,
-		      buffer_size,
-		      error );
-
-	if( read_count == -1 )
+	if( libewf_header_values_initialize(
+	     &( internal_handle->header_values ),
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create header values.",
 		 function );
 
-		read_count = -1;
+		goto on_error;
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
+	if( libewf_hash_sections_initialize(
+	     &( internal_handle->hash_sections ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create hash sections.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	return( read_count );
-}
-
-/* Reads (media) data at a specific offset
- * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
- */
-ssize_t libewf_handle_read_buffer_at_offset(
-         libewf_handle_t *handle,
-         void *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         libcerror_error_t **error )
-{
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_read_buffer_at_offset";
-	ssize_t read_count                        = 0;
-
-	if( handle == NULL )
+	if( libewf_single_files_initialize(
+	     &( internal_handle->single_files ),
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create single files.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->file_io_pool == NULL )
+	if( libcdata_array_empty(
+	     internal_handle->sessions,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty sessions array.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
+	if( libcdata_array_empty(
+	     internal_handle->tracks,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty tracks array.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	if( libewf_internal_handle_seek_offset(
-	     internal_handle,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
+	if( libewf_sector_range_list_empty(
+	     internal_handle->acquiry_errors,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty acquiry errors range list.",
 		 function );
 
 		goto on_error;
 	}
-	read_count = libewf_internal_handle_read_buffer_from_file_io_pool(
-	              internal_handle,
-	              internal_handle->file_io_pool,
-	              buffer,
-	              buffer_size,
-	              error );
-
-	if( read_count == -1 )
+	/* The segment index describes the segment files as they were written
+	 * and therefore is only used on read-only access
+	 */
+	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) == 0 )
+	 && ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
-		 function );
-
-		goto on_error;
+		internal_handle->io_handle->segment_index = internal_handle->segment_index;
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	/* The single files hold the ltree data that is appended while writing
+	 * and written to the last segment file of a logical image
+	 */
+	if( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
-		 function );
-
-		return( -1 );
+		internal_handle->io_handle->single_files = internal_handle->single_files;
 	}
-#endif
-	return( read_count );
-
-on_error:
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_handle->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
-}
-
-/* Writes (media) data at the current offset from a buffer using a Basic File IO (bfio) pool
- * the necessary settings of the write values must have been made
- * Will initialize write if necessary
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
- */
-ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
-         libewf_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
-         const void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
-{
-	static char *function     = "libewf_internal_handle_write_buffer_to_file_io_pool";
-	off64_t chunk_data_offset = 0;
-	size_t buffer_offset      = 0;
-	size_t input_data_size    = 0;
-	size_t write_size         = 0;
-	ssize_t write_count       = 0;
-	uint64_t chunk_index      = 0;
-	int write_chunk           = 0;
-
-	if( internal_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
-		 function );
-
-		return( -1 );
-	}
-	if( internal_handle->io_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
-		 function );
-
-		return( -1 );
-	}
-	if( internal_handle->current_offset < 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
-		 function );
-
-		return( -1 );
-	}
-	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
 	{
-		if( internal_handle->chunk_data != NULL )
+		if( libbfio_pool_get_number_of_handles(
+		     file_io_pool,
+		     &number_of_file_io_handles,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: invalid handle - chunk data set.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve the number of handles in the pool.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
-	}
-	if( internal_handle->media_values == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
-		 function );
-
-		return( -1 );
-	}
-	if( internal_handle->media_values->chunk_size == 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
-		 function );
-
-		return( -1 );
-	}
-	if( internal_handle->write_io_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing subhandle write.",
-		 function );
-
-		return( -1 );
-	}
-	if( buffer == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
-		 function );
-
-		return( -1 );
-	}
-	if( buffer_size > (size_t) SSIZE_MAX )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid buffer size value exceeds maximum.",
-		 function );
-
-		return( -1 );
-	}
-	if( internal_handle->current_offset < 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid offset value out of bounds.",
-		 function );
-
-		return( -1 );
-	}
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
-	{
-		return( 0 );
-	}
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( (size64_t) ( internal_handle->current_offset + buffer_size ) >= internal_handle->media_values->media_size ) )
-	{
-		buffer_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->current_offset );
-	}
-	chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
-
-	if( chunk_index >= (uint64_t) INT_MAX )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid chunk index value exceeds maximum.",
-		 function );
-
-		return( -1 );
-	}
-	chunk_data_offset = chunk_index * internal_handle->media_values->chunk_size;
-	chunk_data_offset = internal_handle->current_offset - chunk_data_offset;
-
-	if( chunk_data_offset >= (off64_t) SSIZE_MAX )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid chunk data offset value exceeds maximum.",
-		 function );
-
-		return( -1 );
-	}
-	while( buffer_size > 0 )
-	{
-		if( chunk_index < internal_handle->write_io_handle->number_of_chunks_written )
+		if( libewf_segment_file_initialize(
+		     &segment_file,
+		     internal_handle->io_handle,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: chunk: %" PRIu64 " already set.",
-			 function,
-			 chunk_index );
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create segment file.",
+			 function );
 
-			return( -1 );
-		}
-		if( internal_handle->write_io_handle->write_finalized != 0 )
-		{
-			break;
+			goto on_error;
 		}
-		if( internal_handle->chunk_data == NULL )
+		for( file_io_pool_entry = 0;
+		     file_io_pool_entry < number_of_file_io_handles;
+		     file_io_pool_entry++ )
 		{
-			if( libewf_chunk_data_initialize(
-			     &( internal_handle->chunk_data ),
-			     internal_handle->media_values->chunk_size,
-			     0,
+			if( libbfio_pool_get_size(
+			     file_io_pool,
+			     file_io_pool_entry,
+			     &segment_file_size,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to create chunk: %" PRIu64 " data.",
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve size of file IO pool entry: %d.",
 				 function,
-				 chunk_index );
+				 file_io_pool_entry );
 
-				return( -1 );
+				goto on_error;
 			}
-		}
-		if( internal_handle->chunk_data == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: internal handle - missing chunk: %" PRIu64 " data.",
-			 function,
-			 chunk_index );
+			if( libbfio_pool_get_handle(
+			     file_io_pool,
+			     file_io_pool_entry,
+			     &file_io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to retrieve file IO handle: %d from pool.",
+				 function,
+				 file_io_pool_entry );
 
-			return( -1 );
-		}
-		if( chunk_data_offset > internal_handle->media_values->chunk_size )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: chunk offset exceeds chunk data size.",
-			 function );
+				goto on_error;
+			}
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: processing file IO pool entry: %d.\n",
+				 function,
+				 file_io_pool_entry );
+			}
+#endif
+			read_count = libewf_segment_file_read_file_header(
+				      segment_file,
+				      file_io_pool,
+				      file_io_pool_entry,
+				      error );
 
-			return( -1 );
-		}
-		write_size = (size_t) ( internal_handle->media_values->chunk_size - chunk_data_offset );
+			if( read_count < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read segment file header.",
+				 function );
 
-		if( write_size > buffer_size )
-		{
-			write_size = buffer_size;
-		}
-		if( write_size == 0 )
-		{
-			break;
+				goto on_error;
+			}
+			if( segment_file->segment_number == 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_INPUT,
+				 LIBCERROR_INPUT_ERROR_INVALID_DATA,
+				 "%s: invalid segment number: 0 in file IO pool entry: %d.",
+				 function,
+				 file_io_pool_entry );
+
+				goto on_error;
+			}
+			if( libewf_segment_table_append_segment_by_segment_file(
+			     segment_table,
+			     segment_file,
+			     file_io_pool_entry,
+			     segment_file_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append segment: %" PRIu32 " to segment table.",
+				 function,
+				 segment_file->segment_number );
+
+				goto on_error;
+			}
 		}
-		if( memory_copy(
-		     &( ( internal_handle->chunk_data->data )[ chunk_data_offset ] ),
-		     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-		     write_size ) == NULL )
+		if( libewf_segment_file_free(
+		     &segment_file,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy buffer to chunk data.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free segment file.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
-		internal_handle->chunk_data->data_size = (size_t) ( chunk_data_offset + write_size );
-
-		buffer_offset += write_size;
-		buffer_size   -= write_size;
+		/* The metadata access flag is needed while the segment files are read
+		 * to skip the sector table sections, the other access flags are set
+		 * after the segment files have been read
+		 */
+		internal_handle->io_handle->access_flags = access_flags & LIBEWF_ACCESS_FLAG_METADATA;
 
-		if( internal_handle->chunk_data->data_size == internal_handle->media_values->chunk_size )
-		{
-			write_chunk = 1;
-		}
-		else if( ( internal_handle->media_values->media_size != 0 )
-		      && ( ( (size64_t) internal_handle->current_offset + write_size ) == internal_handle->media_values->media_size ) )
+		if( libewf_internal_handle_open_read_segment_files(
+		     internal_handle,
+		     file_io_pool,
+		     segment_table,
+		     access_flags,
+		     error ) != 1 )
 		{
-			write_chunk = 1;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read segment files.",
+			 function );
+
+			if( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 )
+			{
+				goto on_error;
+			}
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				if( ( error != NULL )
+				 && ( *error != NULL ) )
+				{
+					libcnotify_print_error_backtrace(
+					 *error );
+				}
+			}
+#endif
+			libcerror_error_free(
+			 error );
 		}
-		else
+		if( internal_handle->media_values == NULL )
 		{
-			write_chunk = 0;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid handle - missing media values.",
+			 function );
+
+			goto on_error;
 		}
-		if( write_chunk != 0 )
+/* TODO refactor */
+		if( ( internal_handle->single_files->ltree_data == NULL )
+		 && ( internal_handle->single_files->ltree_is_parsed == 0 ) )
 		{
-			input_data_size = internal_handle->chunk_data->data_size;
-
-			if( libewf_chunk_data_pack(
-			     internal_handle->chunk_data,
-			     internal_handle->io_handle,
-			     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
-			     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
-			     internal_handle->write_io_handle->pack_flags,
+			if( libewf_internal_handle_get_media_values(
+			     internal_handle,
+			     &( internal_handle->media_values->media_size ),
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GENERIC,
-				 "%s: unable to pack chunk: %" PRIu64 " data.",
-				 function,
-				 chunk_index );
-
-				return( -1 );
-			}
-			write_count = libewf_write_io_handle_write_new_chunk(
-			               internal_handle->write_io_handle,
-			               internal_handle->io_handle,
-			               file_io_pool,
-			               internal_handle->media_values,
-			               internal_handle->segment_table,
-			               internal_handle->header_values,
-			               internal_handle->hash_values,
-			               internal_handle->hash_sections,
-			               internal_handle->sessions,
-			               internal_handle->tracks,
-			               internal_handle->acquiry_errors,
-			               chunk_index,
-			               internal_handle->chunk_data,
-			               input_data_size,
-			               error );
-
-			if( write_count <= 0 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_WRITE_FAILED,
-				 "%s: unable to write new chunk.",
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine media values.",
 				 function );
 
-				return( -1 );
+				goto on_error;
 			}
-			if( libewf_chunk_data_free(
-			     &( internal_handle->chunk_data ),
+		}
+	}
+	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
+	 && ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
+	{
+		if( internal_handle->write_io_handle->values_initialized == 0 )
+		{
+			if( libewf_write_io_handle_initialize_values(
+			     internal_handle->write_io_handle,
+			     internal_handle->io_handle,
+			     internal_handle->media_values,
+			     segment_table,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free chunk data.",
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize write IO handle values.",
 				 function );
 
-				return( -1 );
+				goto on_error;
 			}
 		}
-		chunk_index      += 1;
-		chunk_data_offset = 0;
-
-		internal_handle->current_offset += (off64_t) write_size;
-
-		if( ( internal_handle->media_values->media_size != 0 )
-		 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+		if( libewf_write_io_handle_initialize_resume(
+		     internal_handle->write_io_handle,
+		     internal_handle->io_handle,
+		     file_io_pool,
+		     internal_handle->media_values,
+		     segment_table,
+		     internal_handle->chunk_table,
+		     internal_handle->read_io_handle,
+		     &( internal_handle->current_offset ),
+		     error ) != 1 )
 		{
-			break;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize write IO handle to resume.",
+			 function );
+
+			goto on_error;
 		}
-		if( internal_handle->io_handle->abort != 0 )
+	}
+			internal_handle->io_handle->chunk_size = internal_handle->media_values->chunk_size;
+
+	if( ( internal_handle->io_handle->chunk_size != 0 )
+	 && ( internal_handle->io_handle->buffer_pool == NULL ) )
+	{
+		if( libewf_io_handle_initialize_buffer_pool(
+		     internal_handle->io_handle,
+		     error ) != 1 )
 		{
-			break;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create buffer pool.",
+			 function );
+
+			goto on_error;
 		}
 	}
-	return( (ssize_t) buffer_offset );
-}
+	if( libewf_internal_handle_apply_maximum_cache_size(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to apply maximum cache size.",
+		 function );
 
-/* Writes (media) data at the current offset
- * the necessary settings of the write values must have been made
- * Will initialize write if necessary
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
- */
-ssize_t libewf_handle_write_buffer(
-         libewf_handle_t *handle,
-         const void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+		goto on_error;
+	}
+	if( libewf_internal_handle_apply_memory_limit(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to apply memory limit.",
+		 function );
+
+		goto on_error;
+	}
+	internal_handle->io_handle->access_flags = access_flags;
+	internal_handle->file_io_pool            = file_io_pool;
+	internal_handle->segment_table           = segment_table;
+
+	/* The chunk groups are indexed after the handle has been opened since they
+	 * are read again on first access when they could not be indexed
+	 */
+	if( ( access_flags & LIBEWF_ACCESS_FLAG_INDEX ) != 0 )
+	{
+		if( ( access_flags & LIBEWF_ACCESS_FLAG_LAZY ) == 0 )
+		{
+			result = libewf_internal_handle_index_chunk_groups(
+			          internal_handle,
+			          error );
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		else
+		{
+			result = libewf_internal_handle_index_start(
+			          internal_handle,
+			          error );
+		}
+#endif
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to index chunk groups.",
+			 function );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				if( ( error != NULL )
+				 && ( *error != NULL ) )
+				{
+					libcnotify_print_error_backtrace(
+					 *error );
+				}
+			}
+#endif
+			libcerror_error_free(
+			 error );
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( segment_file != NULL )
+	{
+		libewf_segment_file_free(
+		 &segment_file,
+		 NULL );
+	}
+	if( internal_handle->single_files != NULL )
+	{
+		libewf_single_files_free(
+		 &( internal_handle->single_files ),
+		 NULL );
+	}
+	if( internal_handle->hash_sections != NULL )
+	{
+		libewf_hash_sections_free(
+		 &( internal_handle->hash_sections ),
+		 NULL );
+	}
+	if( internal_handle->header_values != NULL )
+	{
+		libfvalue_table_free(
+		 &( internal_handle->header_values ),
+		 NULL );
+	}
+	if( internal_handle->chunks_cache != NULL )
+	{
+		libfcache_cache_free(
+		 &( internal_handle->chunks_cache ),
+		 NULL );
+	}
+	if( internal_handle->chunk_groups_cache != NULL )
+	{
+		libfcache_cache_free(
+		 &( internal_handle->chunk_groups_cache ),
+		 NULL );
+	}
+	if( internal_handle->chunk_table != NULL )
+	{
+		libewf_chunk_table_free(
+		 &( internal_handle->chunk_table ),
+		 NULL );
+	}
+	if( internal_handle->write_io_handle != NULL )
+	{
+		libewf_write_io_handle_free(
+		 &( internal_handle->write_io_handle ),
+		 error );
+	}
+	if( internal_handle->read_io_handle != NULL )
+	{
+		libewf_read_io_handle_free(
+		 &( internal_handle->read_io_handle ),
+		 error );
+	}
+	return( -1 );
+}
+
+/* Opens a set of EWF file(s) using a Basic File IO (bfio) pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_open_file_io_pool(
+     libewf_handle_t *handle,
+     libbfio_pool_t *file_io_pool,
+     int access_flags,
+     libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_buffer";
-	ssize_t write_count                       = 0;
+	libewf_segment_table_t *segment_table     = NULL;
+	static char *function                     = "libewf_handle_open_file_io_pool";
+	int result                                = 0;
 
 	if( handle == NULL )
 	{
@@ -5112,17 +6008,32 @@ ssize_t libewf_handle_write_buffer(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->file_io_pool == NULL )
+	if( internal_handle->file_io_pool != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - file IO pool value already set.",
 		 function );
 
 		return( -1 );
 	}
+	if( libewf_segment_table_initialize(
+	     &segment_table,
+	     internal_handle->io_handle,
+	     LIBEWF_DEFAULT_SEGMENT_FILE_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment table.",
+		 function );
+
+		goto on_error;
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
@@ -5138,47 +6049,28 @@ ssize_t libewf_handle_write_buffer(
 		return( -1 );
 	}
 #endif
-	if( internal_handle->write_io_handle->values_initialized == 0 )
-	{
-		if( libewf_write_io_handle_initialize_values(
-		     internal_handle->write_io_handle,
-		     internal_handle->io_handle,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize write IO handle values.",
-			 function );
-
-			goto on_error;
-		}
-	}
-	write_count = libewf_internal_handle_write_buffer_to_file_io_pool(
-	               internal_handle,
-	               internal_handle->file_io_pool,
-	               buffer,
-	               buffer_size,
-	               error );
+	result = libewf_internal_handle_open_file_io_pool(
+	          internal_handle,
+	          file_io_pool,
+	          access_flags,
+	          segment_table,
+	          error );
 
-	if( write_count == -1 )
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to write buffer.",
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle using a file IO pool.",
 		 function );
-
-		goto on_error;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	result = libcthreads_read_write_lock_release_for_write(
+	          internal_handle->read_write_lock,
+	          error );
+
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -5186,36 +6078,35 @@ ssize_t libewf_handle_write_buffer(
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
 		 "%s: unable to release read/write lock for writing.",
 		 function );
-
-		return( -1 );
 	}
 #endif
-	return( write_count );
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
 
 on_error:
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_handle->read_write_lock,
-	 NULL );
-#endif
+	if( segment_table != NULL )
+	{
+		libewf_segment_table_free(
+		 &segment_table,
+		 NULL );
+	}
 	return( -1 );
 }
 
-/* Writes (media) data at a specific offset,
- * the necessary settings of the write values must have been made
- * Will initialize write if necessary
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+/* Closes the EWF handle
+ * Returns 0 if successful or -1 on error
  */
-ssize_t libewf_handle_write_buffer_at_offset(
-         libewf_handle_t *handle,
-         const void *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         libcerror_error_t **error )
+int libewf_handle_close(
+     libewf_handle_t *handle,
+     libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_buffer_at_offset";
+	static char *function                     = "libewf_handle_close";
 	ssize_t write_count                       = 0;
+	int result                                = 0;
 
 	if( handle == NULL )
 	{
@@ -5230,86 +6121,50 @@ ssize_t libewf_handle_write_buffer_at_offset(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->file_io_pool == NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The read ahead and index threads must be stopped and the pending asynchronous
+	 * reads must be completed before the write lock is grabbed
+	 */
+	if( libewf_internal_handle_read_ahead_stop(
+	     internal_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to stop read ahead.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
+	if( libewf_internal_handle_index_stop(
+	     internal_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to stop index.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( internal_handle->write_io_handle->values_initialized == 0 )
-	{
-		if( libewf_write_io_handle_initialize_values(
-		     internal_handle->write_io_handle,
-		     internal_handle->io_handle,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize write IO handle values.",
-			 function );
-
-			goto on_error;
-		}
-	}
-	if( libewf_internal_handle_seek_offset(
-	     internal_handle,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
-		 function );
-
-		goto on_error;
-	}
-	write_count = libewf_internal_handle_write_buffer_to_file_io_pool(
-	               internal_handle,
-	               internal_handle->file_io_pool,
-	               buffer,
-	               buffer_size,
-	               error );
-
-	if( write_count == -1 )
+	if( libewf_internal_handle_read_requests_stop(
+	     internal_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to write buffer.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to stop read requests.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -5317,624 +6172,684 @@ ssize_t libewf_handle_write_buffer_at_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( write_count );
+	internal_handle->chunk_view_data             = NULL;
+	internal_handle->read_ahead_next_chunk_index = 0;
+	internal_handle->read_ahead_last_chunk_index = 0;
+	internal_handle->segment_prefetch_offset     = 0;
 
-on_error:
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_handle->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
-}
+	if( ( internal_handle->write_io_handle != NULL )
+	 && ( internal_handle->write_io_handle->write_finalized == 0 ) )
+	{
+		write_count = libewf_internal_handle_write_finalize_file_io_pool(
+		               internal_handle,
+		               internal_handle->file_io_pool,
+		               error );
 
-/* Retrieves a (media) data chunk
- * Returns 1 if successful or -1 on error
- */
-int libewf_handle_get_data_chunk(
-     libewf_handle_t *handle,
-     libewf_data_chunk_t **data_chunk,
-     libcerror_error_t **error )
-{
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_data_chunk";
+		if( write_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to finalize write.",
+			 function );
 
-	if( handle == NULL )
+			result = -1;
+		}
+	}
+	if( internal_handle->file_io_pool_group != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
-		 function );
+		if( libewf_file_io_pool_group_remove_file_io_pool(
+		     internal_handle->file_io_pool_group,
+		     internal_handle->file_io_pool,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove file IO pool from group.",
+			 function );
 
-		return( -1 );
-	}
-	internal_handle = (libewf_internal_handle_t *) handle;
+			result = -1;
+		}
+		if( libewf_file_io_pool_group_release(
+		     &( internal_handle->file_io_pool_group ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to release file IO pool group.",
+			 function );
 
-	if( internal_handle->media_values == NULL )
+			result = -1;
+		}
+	}
+	if( internal_handle->file_io_pool_created_in_library != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
-		 function );
+		if( libbfio_pool_close_all(
+		     internal_handle->file_io_pool,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close all file IO pool handles.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
+		if( libbfio_pool_free(
+		     &( internal_handle->file_io_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO pool.",
+			 function );
+
+			result = -1;
+		}
+		internal_handle->file_io_pool_created_in_library = 0;
 	}
-	if( data_chunk == NULL )
+	internal_handle->file_io_pool = NULL;
+
+	/* The values shared with clones of the handle are not cleared or freed
+	 */
+	if( libewf_internal_handle_detach_shared_state(
+	     internal_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid data chunk.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to detach shared state.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-	if( *data_chunk != NULL )
+	if( libewf_io_handle_clear(
+	     internal_handle->io_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: data chunk value already set.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear IO handle.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
+	if( libewf_media_values_clear(
+	     internal_handle->media_values,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear media values.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-#endif
-	if( ( internal_handle->write_io_handle != NULL )
-	 && ( internal_handle->write_io_handle->values_initialized == 0 ) )
+	if( internal_handle->read_io_handle != NULL )
 	{
-		if( libewf_write_io_handle_initialize_values(
-		     internal_handle->write_io_handle,
-		     internal_handle->io_handle,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
+		if( libewf_read_io_handle_free(
+		     &( internal_handle->read_io_handle ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize write IO handle values.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read IO handle.",
 			 function );
 
-			goto on_error;
+			result = -1;
 		}
 	}
-	if( libewf_data_chunk_initialize(
-	     data_chunk,
-	     internal_handle->io_handle,
-	     internal_handle->write_io_handle,
-	     error ) != 1 )
+	if( internal_handle->write_io_handle != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create data chunk.",
-		 function );
+		if( libewf_write_io_handle_free(
+		     &( internal_handle->write_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free write IO handle.",
+			 function );
 
-		goto on_error;
+			result = -1;
+		}
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	/* Free the chunk data if it could not be passed to libfcache_cache_set_value_by_index
+	 */
+	if( internal_handle->chunk_data != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
-		 function );
+		if( libewf_chunk_data_free(
+		     &( internal_handle->chunk_data ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk data.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-#endif
-	return( 1 );
-
-on_error:
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_handle->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
-}
-
-/* Reads a (media) data chunk at the current offset
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
- */
-ssize_t libewf_internal_handle_read_data_chunk_from_file_io_pool(
-         libewf_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
-         libewf_internal_data_chunk_t *internal_data_chunk,
-         libcerror_error_t **error )
-{
-	libewf_chunk_data_t *chunk_data = NULL;
-	static char *function           = "libewf_internal_handle_read_data_chunk_from_file_io_pool";
-	off64_t chunk_data_offset       = 0;
-	ssize_t read_count              = 0;
-
-	if( internal_handle == NULL )
+	if( internal_handle->segment_table != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
-		 function );
+		if( libewf_segment_table_free(
+		     &( internal_handle->segment_table ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free segment table.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-	if( internal_handle->io_handle == NULL )
+	if( internal_handle->chunk_table != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
-		 function );
+		if( libewf_chunk_table_free(
+		     &( internal_handle->chunk_table ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk table.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-	if( internal_handle->chunk_data != NULL )
+	if( internal_handle->chunk_groups_cache != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
-		 function );
+		if( libfcache_cache_free(
+		     &( internal_handle->chunk_groups_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk groups cache.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-	if( internal_handle->current_offset < 0 )
+	if( internal_handle->chunks_cache != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
-		 function );
+		if( libfcache_cache_free(
+		     &( internal_handle->chunks_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunks cache.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-	if( internal_handle->media_values == NULL )
+	if( internal_handle->chunk_view_cache != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
-		 function );
+		if( libfcache_cache_free(
+		     &( internal_handle->chunk_view_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk view cache.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+	if( internal_handle->chunk_cache != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
-		 function );
+		if( libewf_chunk_cache_release(
+		     &( internal_handle->chunk_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to release chunk cache.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
+		internal_handle->chunk_cache_key_prefix = 0;
 	}
-	if( internal_data_chunk == NULL )
+	if( internal_handle->segment_index != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid data chunk.",
-		 function );
+		if( libewf_segment_index_free(
+		     &( internal_handle->segment_index ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free segment index.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-	if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
+	if( internal_handle->chunk_access_map != NULL )
 	{
-		return( 0 );
-	}
-/* TODO remove need to calculate */
-	internal_handle->current_chunk_index = internal_handle->current_offset
-	                                     / internal_handle->media_values->chunk_size;
-
-	internal_handle->current_offset = (off64_t) internal_handle->current_chunk_index
-	                                * (off64_t) internal_handle->media_values->chunk_size;
+		if( libewf_chunk_access_map_free(
+		     &( internal_handle->chunk_access_map ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk access map.",
+			 function );
 
-	if( libewf_chunk_table_get_chunk_data_by_offset(
-	     internal_handle->chunk_table,
-	     internal_handle->current_chunk_index,
-	     internal_handle->io_handle,
-	     file_io_pool,
-	     internal_handle->media_values,
-	     internal_handle->segment_table,
-	     internal_handle->chunk_groups_cache,
-	     internal_handle->chunks_cache,
-	     internal_handle->current_offset,
-	     &chunk_data,
-	     &chunk_data_offset,
-	     error ) != 1 )
+			result = -1;
+		}
+	}
+	if( internal_handle->prefetch_chunk_access_map != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve chunk: %" PRIu64 " data.",
-		 function,
-		 internal_handle->current_chunk_index );
+		if( libewf_chunk_access_map_free(
+		     &( internal_handle->prefetch_chunk_access_map ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free prefetch chunk access map.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-	if( chunk_data == NULL )
+	if( internal_handle->access_advice != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing chunk: %" PRIu64 " data.",
-		 function,
-		 internal_handle->current_chunk_index );
+		if( libewf_access_advice_free(
+		     &( internal_handle->access_advice ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free access advice.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-	read_count = (ssize_t) chunk_data->data_size;
-
-	if( libewf_internal_data_chunk_set_chunk_data(
-	     internal_data_chunk,
-	     internal_handle->current_chunk_index,
-	     chunk_data,
-	     error ) != 1 )
+	if( internal_handle->async_reader != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set chunk: %" PRIu64 " data in data chunk.",
-		 function,
-		 internal_handle->current_chunk_index );
+		if( libewf_async_reader_free(
+		     &( internal_handle->async_reader ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free async reader.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-	internal_handle->current_offset += read_count;
-
-	internal_handle->current_chunk_index++;
-
-	return( read_count );
-}
-
-/* Reads a (media) data chunk at the current offset
- * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
- */
-ssize_t libewf_handle_read_data_chunk(
-         libewf_handle_t *handle,
-         libewf_data_chunk_t *data_chunk,
-         libcerror_error_t **error )
-{
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_read_data_chunk";
-	ssize_t read_count                        = 0;
-
-	if( handle == NULL )
+	if( internal_handle->disk_chunk_cache != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
-		 function );
+		/* The IO handle can be shared with clones of the handle
+		 */
+		if( internal_handle->io_handle != NULL )
+		{
+			internal_handle->io_handle->disk_chunk_cache = NULL;
+		}
+		if( libewf_disk_chunk_cache_free(
+		     &( internal_handle->disk_chunk_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free disk chunk cache.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->file_io_pool == NULL )
+	if( internal_handle->shared_chunk_cache != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
-		 function );
+		/* The IO handle can be shared with clones of the handle
+		 */
+		if( internal_handle->io_handle != NULL )
+		{
+			internal_handle->io_handle->shared_chunk_cache = NULL;
+		}
+		if( libewf_shared_chunk_cache_free(
+		     &( internal_handle->shared_chunk_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free shared chunk cache.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
+	if( libewf_internal_handle_stream_close(
+	     internal_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to close stream reader.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-#endif
-	read_count = libewf_internal_handle_read_data_chunk_from_file_io_pool(
-	              internal_handle,
-	              internal_handle->file_io_pool,
-	              (libewf_internal_data_chunk_t *) data_chunk,
-	              error );
+	if( internal_handle->chunk_unpacker != NULL )
+	{
+		if( libewf_chunk_unpacker_free(
+		     &( internal_handle->chunk_unpacker ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk unpacker.",
+			 function );
 
-	if( read_count < 0 )
+			result = -1;
+		}
+	}
+	if( internal_handle->running_digest != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read data chunk.",
-		 function );
+		if( libewf_running_digest_reset(
+		     internal_handle->running_digest,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to reset running digest.",
+			 function );
 
-		read_count = -1;
+			result = -1;
+		}
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
+	if( libewf_internal_handle_free_chunk_packer(
+	     internal_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free chunk packer.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-#endif
-	return( read_count );
-}
-
-/* Writes a (media) data chunk at the current offset
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
- */
-ssize_t libewf_internal_handle_write_data_chunk_to_file_io_pool(
-         libewf_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
-         libewf_internal_data_chunk_t *internal_data_chunk,
-         libcerror_error_t **error )
-{
-	static char *function = "libewf_internal_handle_write_data_chunk_to_file_io_pool";
-	size_t data_size      = 0;
-	ssize_t write_count   = 0;
-	int chunk_exists      = 0;
-
-	if( internal_handle == NULL )
+	if( libewf_internal_handle_free_out_of_order_chunks(
+	     internal_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free out of order chunks.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-	if( internal_handle->io_handle == NULL )
+	if( internal_handle->hash_sections != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
-		 function );
+		if( libewf_hash_sections_free(
+		     &( internal_handle->hash_sections ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free hash sections.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-	if( internal_handle->chunk_data != NULL )
+	if( internal_handle->header_values != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
-		 function );
+		if( libfvalue_table_free(
+		     &( internal_handle->header_values ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free header values.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-	if( internal_handle->current_offset < 0 )
+	if( internal_handle->hash_values != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
-		 function );
+		if( libfvalue_table_free(
+		     &( internal_handle->hash_values ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free hash values.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-	if( internal_handle->media_values == NULL )
+	if( internal_handle->single_files != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
-		 function );
+		if( libewf_single_files_free(
+		     &( internal_handle->single_files ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free single files.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+	if( libcdata_array_empty(
+	     internal_handle->sessions,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty sessions array.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-	if( internal_handle->write_io_handle == NULL )
+	if( libcdata_array_empty(
+	     internal_handle->tracks,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing subhandle write.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty tracks array.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-	if( internal_data_chunk == NULL )
+	if( libewf_sector_range_list_empty(
+	     internal_handle->acquiry_errors,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid data chunk.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty acquiry errors range list.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+	if( internal_handle->deferred_session_section != NULL )
 	{
-		return( 0 );
-	}
-	data_size = internal_data_chunk->data_size;
-
-	if( internal_handle->media_values->media_size != 0 )
-	{
-		if( (size64_t) ( internal_handle->current_offset + data_size ) > internal_handle->media_values->media_size )
+		if( libewf_section_descriptor_free(
+		     &( internal_handle->deferred_session_section ),
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: last data chunk size value out of bounds.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free deferred session section.",
 			 function );
 
-			return( -1 );
+			result = -1;
 		}
 	}
-/* TODO remove need to calculate */
-	internal_handle->current_chunk_index = internal_handle->current_offset
-	                                     / internal_handle->media_values->chunk_size;
-
-	internal_handle->current_offset = (off64_t) internal_handle->current_chunk_index
-	                                * (off64_t) internal_handle->media_values->chunk_size;
-
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "%s: writing chunk: %" PRIu64 " of size: %" PRIzd ".\n",
-		 function,
-		 internal_handle->current_chunk_index,
-		 data_size );
-	}
-#endif
-	chunk_exists = libewf_chunk_table_chunk_exists_for_offset(
-	                internal_handle->chunk_table,
-	                internal_handle->current_chunk_index,
-	                file_io_pool,
-	                internal_handle->segment_table,
-	                internal_handle->chunk_groups_cache,
-	                internal_handle->current_offset,
-			error );
-
-	if( chunk_exists == -1 )
+	if( internal_handle->deferred_error_section != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine if the chunk: %" PRIu64 " exists.",
-		 function,
-		 internal_handle->current_chunk_index );
+		if( libewf_section_descriptor_free(
+		     &( internal_handle->deferred_error_section ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free deferred error section.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-	else if( chunk_exists != 0 )
+/* TODO clear IO handle, segment tables */
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: chunk: %" PRIu64 " already exists.",
-		 function,
-		 internal_handle->current_chunk_index );
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
 
-		return( -1 );
+		result = -1;
 	}
-	write_count = libewf_write_io_handle_write_new_chunk(
-	               internal_handle->write_io_handle,
-	               internal_handle->io_handle,
-	               file_io_pool,
-	               internal_handle->media_values,
-	               internal_handle->segment_table,
-	               internal_handle->header_values,
-	               internal_handle->hash_values,
-	               internal_handle->hash_sections,
-	               internal_handle->sessions,
-	               internal_handle->tracks,
-	               internal_handle->acquiry_errors,
-	               internal_handle->current_chunk_index,
-	               internal_data_chunk->chunk_data,
-	               data_size,
-	               error );
-
-	if( write_count < 0 )
+#endif
+	if( internal_handle->shared_state != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write chunk data.",
-		 function );
+		if( libewf_internal_handle_release_shared_state(
+		     internal_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to release shared state.",
+			 function );
 
-		return( -1 );
-	}
-	internal_handle->current_offset += (off64_t) data_size;
+			result = -1;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		/* The read/write lock was shared with the clones of the handle
+		 */
+		if( ( internal_handle->read_write_lock == NULL )
+		 && ( libcthreads_read_write_lock_initialize(
+		       &( internal_handle->read_write_lock ),
+		       error ) != 1 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize read/write lock.",
+			 function );
 
-	return( write_count );
+			result = -1;
+		}
+#endif
+	}
+	return( result );
 }
 
-/* Writes a (media) data chunk at the current offset
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+/* Indexes the chunk groups of the segment files
+ * The table sections of the segment files are read and validated using multiple threads
+ * so that reading media data does not need to read them on first access
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_handle_write_data_chunk(
-         libewf_handle_t *handle,
-         libewf_data_chunk_t *data_chunk,
-         libcerror_error_t **error )
+int libewf_handle_index_chunk_groups(
+     libewf_handle_t *handle,
+     libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_data_chunk";
-	ssize_t write_count                       = 0;
+	static char *function                     = "libewf_handle_index_chunk_groups";
+	int result                                = 1;
 
 	if( handle == NULL )
 	{
@@ -5949,17 +6864,6 @@ ssize_t libewf_handle_write_data_chunk(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->file_io_pool == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
-		 function );
-
-		return( -1 );
-	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
@@ -5975,22 +6879,18 @@ ssize_t libewf_handle_write_data_chunk(
 		return( -1 );
 	}
 #endif
-	write_count = libewf_internal_handle_write_data_chunk_to_file_io_pool(
-	               internal_handle,
-	               internal_handle->file_io_pool,
-	               (libewf_internal_data_chunk_t *) data_chunk,
-	               error );
-
-	if( write_count < 0 )
+	if( libewf_internal_handle_index_chunk_groups(
+	     internal_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write data chunk.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to index chunk groups.",
 		 function );
 
-		write_count = -1;
+		result = -1;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -6007,29 +6907,34 @@ ssize_t libewf_handle_write_data_chunk(
 		return( -1 );
 	}
 #endif
-	return( write_count );
+	return( result );
 }
 
-/* Finalizes the write by correcting the EWF the meta data in the segment files
- * This function is required after write from stream
- * Returns the number of bytes written or -1 on error
+/* Reads (media) data from the last current into a buffer using a Basic File IO (bfio) pool
+ * The chunks covered by the buffer are read in batches and unpacked by the chunk unpacker
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
  */
-ssize_t libewf_internal_handle_write_finalize_file_io_pool(
+ssize_t libewf_internal_handle_read_buffer_with_chunk_unpacker(
          libewf_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
+         uint8_t *buffer,
+         size_t buffer_size,
          libcerror_error_t **error )
 {
-	libewf_segment_file_t *segment_file = NULL;
-	static char *function               = "libewf_internal_handle_write_finalize_file_io_pool";
-	size64_t segment_file_size          = 0;
-	size_t input_data_size              = 0;
-	ssize_t write_count                 = 0;
-	ssize_t write_finalize_count        = 0;
-	uint64_t chunk_index                = 0;
-	uint32_t number_of_segments         = 0;
-	uint32_t segment_number             = 0;
-	int chunk_exists                    = 0;
-	int file_io_pool_entry              = -1;
+	libewf_chunk_data_t **batch_chunk_data = NULL;
+	libewf_chunk_data_t *chunk_data        = NULL;
+	static char *function                  = "libewf_internal_handle_read_buffer_with_chunk_unpacker";
+	off64_t chunk_data_offset              = 0;
+	size_t array_size                      = 0;
+	size_t buffer_offset                   = 0;
+	size_t read_size                       = 0;
+	ssize_t total_read_count               = 0;
+	uint64_t chunk_index                   = 0;
+	uint64_t number_of_chunks              = 0;
+	int batch_index                        = 0;
+	int number_of_batch_chunks             = 0;
+	int result                             = 0;
 
 	if( internal_handle == NULL )
 	{
@@ -6042,495 +6947,19223 @@ ssize_t libewf_internal_handle_write_finalize_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	if( internal_handle->chunk_unpacker == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 "%s: invalid handle - missing chunk unpacker.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+	if( ( internal_handle->media_values == NULL )
+	 || ( internal_handle->media_values->chunk_size == 0 ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	if( buffer == NULL )
 	{
-		if( internal_handle->chunk_data != NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: invalid handle - chunk data set.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
 
-			return( -1 );
-		}
+		return( -1 );
 	}
-	if( internal_handle->write_io_handle == NULL )
+	if( buffer_size > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing write IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values == NULL )
+	array_size = sizeof( libewf_chunk_data_t * ) * internal_handle->chunk_unpacker->maximum_number_of_chunks;
+
+	batch_chunk_data = (libewf_chunk_data_t **) memory_allocate(
+	                                             array_size );
+
+	if( batch_chunk_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create batch chunk data.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+	if( memory_set(
+	     batch_chunk_data,
+	     0,
+	     array_size ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear batch chunk data.",
 		 function );
 
+		memory_free(
+		 batch_chunk_data );
+
 		return( -1 );
 	}
-	if( internal_handle->write_io_handle->write_finalized != 0 )
-	{
-		return( 0 );
-	}
-	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
-	{
-		return( 0 );
-	}
-	if( internal_handle->chunk_data != NULL )
+	chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+
+	while( buffer_size > 0 )
 	{
-		chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+		chunk_data_offset = internal_handle->current_offset % internal_handle->media_values->chunk_size;
 
-		chunk_exists = libewf_chunk_table_chunk_exists_for_offset(
-				internal_handle->chunk_table,
-				chunk_index,
-				file_io_pool,
-				internal_handle->segment_table,
-				internal_handle->chunk_groups_cache,
-				internal_handle->current_offset,
-				error );
+		number_of_chunks = ( (uint64_t) chunk_data_offset + buffer_size + internal_handle->media_values->chunk_size - 1 )
+		                 / internal_handle->media_values->chunk_size;
 
-		if( chunk_exists == -1 )
+		if( number_of_chunks > (uint64_t) internal_handle->chunk_unpacker->maximum_number_of_chunks )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine if the chunk: %" PRIu64 " exists.",
-			 function,
-			 chunk_index );
-
-			return( -1 );
+			number_of_chunks = (uint64_t) internal_handle->chunk_unpacker->maximum_number_of_chunks;
 		}
-		if( chunk_exists != 0 )
+		number_of_batch_chunks = (int) number_of_chunks;
+
+		/* The chunks are read on the calling thread since the file IO pool
+		 * and the chunk table are not thread-safe
+		 */
+		if( libewf_internal_handle_read_packed_chunks_data(
+		     internal_handle,
+		     file_io_pool,
+		     chunk_index,
+		     batch_chunk_data,
+		     number_of_batch_chunks,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: chunk: %" PRIu64 " already exists.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunks: %" PRIu64 " - %" PRIu64 " data.",
 			 function,
-			 chunk_index );
+			 chunk_index,
+			 chunk_index + number_of_batch_chunks - 1 );
 
-			return( -1 );
+			goto on_error;
 		}
-		input_data_size = internal_handle->chunk_data->data_size;
-
-		if( libewf_chunk_data_pack(
-		     internal_handle->chunk_data,
-		     internal_handle->io_handle,
-		     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
-		     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
-		     internal_handle->write_io_handle->pack_flags,
+		if( libewf_chunk_unpacker_unpack(
+		     internal_handle->chunk_unpacker,
+		     batch_chunk_data,
+		     number_of_batch_chunks,
+		     internal_handle->read_priority,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to pack chunk: %" PRIu64 " data.",
+			 "%s: unable to unpack chunks: %" PRIu64 " - %" PRIu64 " data.",
 			 function,
-			 chunk_index );
+			 chunk_index,
+			 chunk_index + number_of_batch_chunks - 1 );
 
-			return( -1 );
+			goto on_error;
 		}
-		write_count = libewf_write_io_handle_write_new_chunk(
-			       internal_handle->write_io_handle,
-			       internal_handle->io_handle,
-			       file_io_pool,
-			       internal_handle->media_values,
-			       internal_handle->segment_table,
-			       internal_handle->header_values,
-			       internal_handle->hash_values,
-			       internal_handle->hash_sections,
-			       internal_handle->sessions,
-			       internal_handle->tracks,
-			       internal_handle->acquiry_errors,
-			       chunk_index,
-			       internal_handle->chunk_data,
-			       input_data_size,
-			       error );
-
-		if( write_count <= 0 )
+		for( batch_index = 0;
+		     batch_index < number_of_batch_chunks;
+		     batch_index++ )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write new chunk.",
-			 function );
+			chunk_data = batch_chunk_data[ batch_index ];
 
-			return( -1 );
+			if( chunk_data == NULL )
+			{
+				/* Missing and sparse chunks are handled by the chunk table
+				 */
+				if( libewf_internal_handle_read_segment_files_to_offset(
+				     internal_handle,
+				     file_io_pool,
+				     internal_handle->current_offset,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read segment files up to offset: %" PRIi64 ".",
+					 function,
+					 internal_handle->current_offset );
+
+					goto on_error;
+				}
+				if( libewf_chunk_table_get_chunk_data_by_offset(
+				     internal_handle->chunk_table,
+				     chunk_index,
+				     internal_handle->io_handle,
+				     file_io_pool,
+				     internal_handle->media_values,
+				     internal_handle->segment_table,
+				     internal_handle->chunk_groups_cache,
+				     internal_handle->chunks_cache,
+				     internal_handle->current_offset,
+				     &chunk_data,
+				     &chunk_data_offset,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to read chunk: %" PRIu64 " data.",
+					 function,
+					 chunk_index );
+
+					goto on_error;
+				}
+				if( chunk_data == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+					 "%s: missing chunk: %" PRIu64 " data.",
+					 function,
+					 chunk_index );
+
+					goto on_error;
+				}
+			}
+			else
+			{
+				chunk_data_offset = internal_handle->current_offset % internal_handle->media_values->chunk_size;
+
+				if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+				{
+					if( libewf_internal_handle_append_chunk_checksum_error(
+					     internal_handle,
+					     chunk_index,
+					     chunk_data,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+						 "%s: unable to append chunk: %" PRIu64 " checksum error.",
+						 function,
+						 chunk_index );
+
+						goto on_error;
+					}
+				}
+			}
+			if( (off64_t) chunk_data_offset > (off64_t) chunk_data->data_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: chunk: %" PRIu64 " offset exceeds data size.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+			read_size = (size_t) ( chunk_data->data_size - chunk_data_offset );
+
+			if( read_size > buffer_size )
+			{
+				read_size = buffer_size;
+			}
+			if( read_size == 0 )
+			{
+				break;
+			}
+			if( memory_copy(
+			     &( buffer[ buffer_offset ] ),
+			     &( ( chunk_data->data )[ chunk_data_offset ] ),
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+			if( batch_chunk_data[ batch_index ] != NULL )
+			{
+				/* Cache the unpacked chunk data so that a subsequent read
+				 * of the remainder of the chunk does not need to unpack it again
+				 */
+				if( internal_handle->chunk_cache != NULL )
+				{
+					result = libewf_chunk_cache_set_chunk_data(
+					          internal_handle->chunk_cache,
+					          internal_handle->chunk_cache_key_prefix | chunk_index,
+					          batch_chunk_data[ batch_index ],
+					          internal_handle->read_priority,
+					          error );
+				}
+				else
+				{
+					result = libewf_chunk_table_set_chunk_data_by_offset(
+					          internal_handle->chunk_table,
+					          chunk_index,
+					          file_io_pool,
+					          internal_handle->segment_table,
+					          internal_handle->chunk_groups_cache,
+					          internal_handle->chunks_cache,
+					          internal_handle->current_offset,
+					          batch_chunk_data[ batch_index ],
+					          error );
+				}
+				if( result != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set chunk: %" PRIu64 " data.",
+					 function,
+					 chunk_index );
+
+					goto on_error;
+				}
+				/* The chunks cache takes over management of the chunk data
+				 */
+				batch_chunk_data[ batch_index ] = NULL;
+			}
+			buffer_offset    += read_size;
+			buffer_size      -= read_size;
+			total_read_count += (ssize_t) read_size;
+			chunk_index      += 1;
+
+			internal_handle->current_offset += (off64_t) read_size;
+
+			chunk_data = NULL;
 		}
-		write_finalize_count += write_count;
+		for( batch_index = 0;
+		     batch_index < number_of_batch_chunks;
+		     batch_index++ )
+		{
+			if( batch_chunk_data[ batch_index ] != NULL )
+			{
+				if( libewf_chunk_data_free(
+				     &( batch_chunk_data[ batch_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free batch chunk data: %d.",
+					 function,
+					 batch_index );
 
-		if( libfcache_cache_set_value_by_index(
-		     internal_handle->chunks_cache,
-		     chunk_index % LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNKS,
-		     0,
-		     internal_handle->current_offset,
-		     0,
-		     (intptr_t *) internal_handle->chunk_data,
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_data_free,
-		     LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
-		     error ) != 1 )
+					goto on_error;
+				}
+			}
+		}
+		if( read_size == 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set chunk: %" PRIu64 " data.",
-			 function,
-			 chunk_index );
+			break;
+		}
+		if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
+		{
+			break;
+		}
+		if( internal_handle->io_handle->abort != 0 )
+		{
+			break;
+		}
+	}
+	memory_free(
+	 batch_chunk_data );
 
-			return( -1 );
+	return( total_read_count );
+
+on_error:
+	if( batch_chunk_data != NULL )
+	{
+		for( batch_index = 0;
+		     batch_index < internal_handle->chunk_unpacker->maximum_number_of_chunks;
+		     batch_index++ )
+		{
+			if( batch_chunk_data[ batch_index ] != NULL )
+			{
+				libewf_chunk_data_free(
+				 &( batch_chunk_data[ batch_index ] ),
+				 NULL );
+			}
 		}
-		/* chunks_cache takes over management of chunk_data
-		 */
-		internal_handle->chunk_data = NULL;
+		memory_free(
+		 batch_chunk_data );
 	}
-	/* Check if all media data has been written
-	 */
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( internal_handle->write_io_handle->input_write_count < (ssize64_t) internal_handle->media_values->media_size ) )
+	return( -1 );
+}
+
+/* Reads (media) data from the last current into a buffer using a Basic File IO (bfio) pool
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libewf_chunk_data_t *cached_chunk_data = NULL;
+	libewf_chunk_data_t *chunk_data        = NULL;
+	static char *function                  = "libewf_internal_handle_read_buffer_from_file_io_pool";
+	off64_t chunk_data_offset              = 0;
+	uint64_t advice_end_chunk_index        = 0;
+	uint64_t chunk_index                   = 0;
+	uint64_t first_chunk_index             = 0;
+	uint64_t read_ahead_end_chunk_index    = 0;
+	size_t buffer_offset                   = 0;
+	size_t read_size                       = 0;
+	ssize_t total_read_count               = 0;
+	int advice                             = LIBEWF_ACCESS_ADVICE_NORMAL;
+	int is_sequential_read                 = 0;
+	int result                             = 0;
+
+	if( internal_handle == NULL )
 	{
-		return( write_finalize_count );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
 	}
-	if( libewf_segment_table_get_number_of_segments(
-	     internal_handle->segment_table,
-	     &number_of_segments,
-	     error ) != 1 )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of segments.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( number_of_segments == 0 )
+	if( internal_handle->chunk_data != NULL )
 	{
-		/* No segment file needs to be created
-		 */
-/* TODO clean up this logic: when is this triggered? */
-		if( internal_handle->media_values->media_size != 0 )
-		{
-			return( write_finalize_count );
-		}
-		/* Create the segment file if required
-		 */
-		if( libewf_write_io_handle_create_segment_file(
-		     internal_handle->io_handle,
-		     file_io_pool,
-		     internal_handle->segment_table,
-		     internal_handle->io_handle->segment_file_type,
-		     0,
-		     internal_handle->write_io_handle->maximum_number_of_segments,
-		     internal_handle->media_values->set_identifier,
-		     &file_io_pool_entry,
-		     &segment_file,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_OPEN_FAILED,
-			 "%s: unable to create segment file: 0.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
 
-			return( -1 );
-		}
-		write_count = libewf_segment_file_write_start(
-		               segment_file,
-		               file_io_pool,
-		               file_io_pool_entry,
-		               &( internal_handle->write_io_handle->case_data ),
-		               &( internal_handle->write_io_handle->case_data_size ),
-		               &( internal_handle->write_io_handle->device_information ),
-		               &( internal_handle->write_io_handle->device_information_size ),
-		               &( internal_handle->write_io_handle->data_section ),
-		               internal_handle->media_values,
-		               internal_handle->header_values,
-		               internal_handle->write_io_handle->timestamp,
-		               error );
+		return( -1 );
+	}
+	if( internal_handle->chunk_view_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk view data set.",
+		 function );
 
-		if( write_count == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write segment file: 0 start.",
-			 function );
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
 
-			return( -1 );
-		}
-		write_finalize_count += write_count;
+		return( -1 );
 	}
-	else
+	if( internal_handle->media_values == NULL )
 	{
-		segment_number = number_of_segments - 1;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
 
-		if( libewf_segment_table_get_segment_by_index(
-		     internal_handle->segment_table,
-		     segment_number,
-		     &file_io_pool_entry,
-		     &segment_file_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
-			 function,
-			 segment_number );
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
 
-			return( -1 );
-		}
-		if( libewf_segment_table_get_segment_file_by_index(
-		     internal_handle->segment_table,
-		     segment_number,
-		     file_io_pool,
-		     &segment_file,
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
+	{
+		return( 0 );
+	}
+	if( (size64_t) ( internal_handle->current_offset + buffer_size ) >= internal_handle->media_values->media_size )
+	{
+		buffer_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->current_offset );
+	}
+	chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+
+	/* The read is considered sequential if it continues in the chunk that was last read
+	 * or in the chunk that directly follows it
+	 */
+	if( ( chunk_index > internal_handle->read_ahead_next_chunk_index )
+	 || ( ( chunk_index + 1 ) < internal_handle->read_ahead_next_chunk_index ) )
+	{
+		internal_handle->read_ahead_last_chunk_index = 0;
+		is_sequential_read                           = 0;
+	}
+	else
+	{
+		is_sequential_read = 1;
+	}
+	/* The advice of the first chunk of the read overrides the detected access pattern
+	 */
+	if( ( internal_handle->access_advice != NULL )
+	 && ( internal_handle->write_io_handle == NULL ) )
+	{
+		if( libewf_access_advice_get_advice(
+		     internal_handle->access_advice,
+		     chunk_index,
+		     &advice,
+		     &advice_end_chunk_index,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
+			 "%s: unable to retrieve access advice of chunk: %" PRIu64 ".",
 			 function,
-			 segment_number );
+			 chunk_index );
 
 			return( -1 );
 		}
-		if( segment_file == NULL )
+		if( advice == LIBEWF_ACCESS_ADVICE_SEQUENTIAL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing segment file: %" PRIu32 ".",
-			 function,
-			 segment_number );
-
-			return( -1 );
+			is_sequential_read = 1;
 		}
-	}
-	/* Set segment file to the correct offset if write is resumed
-	 */
-	if( internal_handle->write_io_handle->resume_segment_file_offset > 0 )
-	{
-		if( libbfio_pool_seek_offset(
-		     file_io_pool,
-		     file_io_pool_entry,
-		     internal_handle->write_io_handle->resume_segment_file_offset,
-		     SEEK_SET,
-		     error ) == -1 )
+		else if( advice == LIBEWF_ACCESS_ADVICE_RANDOM )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_OPEN_FAILED,
-			 "%s: unable to seek resume segment file offset: %" PRIi64 " in segment file: %" PRIu32 ".",
-			 function,
-			 internal_handle->write_io_handle->resume_segment_file_offset,
-			 segment_number );
-
-			return( -1 );
+			is_sequential_read = 0;
 		}
-		internal_handle->write_io_handle->resume_segment_file_offset = 0;
 	}
-	/* Check if the last segment file is still open for writing
-	 */
-	if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_WRITE_OPEN ) != 0 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( ( internal_handle->number_of_threads > 1 )
+	 && ( internal_handle->write_io_handle == NULL )
+	 && ( buffer_size > (size_t) internal_handle->media_values->chunk_size ) )
 	{
-		/* Check if chunks section needs to be corrected
-		 */
-		if( internal_handle->write_io_handle->chunks_section_offset != 0 )
+		if( internal_handle->chunk_unpacker == NULL )
 		{
-			write_count = libewf_write_io_handle_write_chunks_section_end(
-			               internal_handle->write_io_handle,
-			               internal_handle->io_handle,
-				       file_io_pool,
-				       file_io_pool_entry,
-			               segment_file,
-			               error );
-
-			if( write_count == -1 )
+			if( libewf_chunk_unpacker_initialize(
+			     &( internal_handle->chunk_unpacker ),
+			     internal_handle->io_handle,
+			     internal_handle->number_of_threads,
+			     internal_handle->scheduler,
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_WRITE_FAILED,
-				 "%s: unable to write chunks section end.",
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create chunk unpacker.",
 				 function );
 
 				return( -1 );
 			}
-			write_finalize_count += write_count;
-		}
-		/* Close the segment file
-		 */
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "%s: closing last segment file.\n",
-			 function );
 		}
-#endif
-		write_count = libewf_segment_file_write_close(
-		               segment_file,
-		               file_io_pool,
-		               file_io_pool_entry,
-		               internal_handle->write_io_handle->number_of_chunks_written_to_segment_file,
-		               1,
-		               internal_handle->hash_sections,
-		               internal_handle->hash_values,
-		               internal_handle->media_values,
-		               internal_handle->sessions,
-		               internal_handle->tracks,
-		               internal_handle->acquiry_errors,
-		               &( internal_handle->write_io_handle->data_section ),
-		               error );
-
-		if( write_count == -1 )
+		total_read_count = libewf_internal_handle_read_buffer_with_chunk_unpacker(
+		                    internal_handle,
+		                    file_io_pool,
+		                    (uint8_t *) buffer,
+		                    buffer_size,
+		                    error );
+
+		if( total_read_count == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to close segment file.",
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer with chunk unpacker.",
 			 function );
 
 			return( -1 );
 		}
-		write_finalize_count += write_count;
+		chunk_index = ( internal_handle->current_offset + internal_handle->media_values->chunk_size - 1 )
+		            / internal_handle->media_values->chunk_size;
 	}
-	/* Correct the media values if streamed write was used
-	 */
-	if( internal_handle->media_values->media_size == 0 )
+	else
+#endif
 	{
-		/* Determine the media values
-		 */
-		internal_handle->media_values->number_of_chunks  = internal_handle->write_io_handle->number_of_chunks_written;
-		internal_handle->media_values->number_of_sectors = (uint64_t) ( internal_handle->write_io_handle->input_write_count / internal_handle->media_values->bytes_per_sector );
-		internal_handle->media_values->media_size        = (size64_t) internal_handle->write_io_handle->input_write_count;
-
-		/* Flush the section write caches
+		/* Chunks that were deflated in sub-blocks are inflated on the threads of the handle
 		 */
-		if( internal_handle->write_io_handle->case_data != NULL )
+		if( ( internal_handle->chunk_table != NULL )
+		 && ( internal_handle->chunk_table->compression_context != NULL ) )
 		{
-			memory_free(
-			 internal_handle->write_io_handle->case_data );
-
-			internal_handle->write_io_handle->case_data      = NULL;
-			internal_handle->write_io_handle->case_data_size = 0;
+			internal_handle->chunk_table->compression_context->number_of_deflate_threads = internal_handle->number_of_threads;
 		}
-		if( internal_handle->write_io_handle->device_information != NULL )
+		while( buffer_size > 0 )
 		{
-			memory_free(
-			 internal_handle->write_io_handle->device_information );
+			if( ( internal_handle->chunk_cache != NULL )
+			 && ( internal_handle->write_io_handle == NULL ) )
+			{
+				result = libewf_chunk_cache_copy_data(
+				          internal_handle->chunk_cache,
+				          internal_handle->chunk_cache_key_prefix | chunk_index,
+				          (size_t) ( internal_handle->current_offset % internal_handle->media_values->chunk_size ),
+				          &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+				          buffer_size,
+				          &read_size,
+				          internal_handle->read_priority,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to copy chunk: %" PRIu64 " data from chunk cache.",
+					 function,
+					 chunk_index );
+
+					return( -1 );
+				}
+				else if( ( result != 0 )
+				      && ( read_size > 0 ) )
+				{
+					buffer_offset    += read_size;
+					buffer_size      -= read_size;
+					total_read_count += (ssize_t) read_size;
+					chunk_index      += 1;
+
+					internal_handle->current_offset += (off64_t) read_size;
+
+					if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
+					{
+						break;
+					}
+					if( internal_handle->io_handle->abort != 0 )
+					{
+						break;
+					}
+					continue;
+				}
+			}
+			if( libewf_internal_handle_read_segment_files_to_offset(
+			     internal_handle,
+			     file_io_pool,
+			     internal_handle->current_offset,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read segment files up to offset: %" PRIi64 ".",
+				 function,
+				 internal_handle->current_offset );
+
+				return( -1 );
+			}
+			/* Encrypted chunks are read through the caches so that they are only decrypted once
+			 */
+			if( ( internal_handle->read_decompress_to_buffer != 0 )
+			 && ( internal_handle->write_io_handle == NULL )
+			 && ( internal_handle->io_handle->is_encrypted == 0 )
+			 && ( ( internal_handle->current_offset % internal_handle->media_values->chunk_size ) == 0 )
+			 && ( buffer_size >= (size_t) internal_handle->media_values->chunk_size ) )
+			{
+				/* A chunk that is fully covered by the buffer is unpacked directly into the buffer
+				 */
+				result = libewf_internal_handle_read_chunk_data_to_buffer(
+				          internal_handle,
+				          file_io_pool,
+				          chunk_index,
+				          &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+				          buffer_size,
+				          &read_size,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read chunk: %" PRIu64 " data to buffer.",
+					 function,
+					 chunk_index );
+
+					return( -1 );
+				}
+				else if( ( result != 0 )
+				      && ( read_size > 0 ) )
+				{
+					buffer_offset    += read_size;
+					buffer_size      -= read_size;
+					total_read_count += (ssize_t) read_size;
+					chunk_index      += 1;
+
+					internal_handle->current_offset += (off64_t) read_size;
+
+					if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
+					{
+						break;
+					}
+					if( internal_handle->io_handle->abort != 0 )
+					{
+						break;
+					}
+					continue;
+				}
+			}
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) && defined( HAVE_ZLIB_INFLATE ) ) || defined( ZLIB_DLL )
+			if( ( internal_handle->read_decompress_to_buffer != 0 )
+			 && ( internal_handle->write_io_handle == NULL )
+			 && ( is_sequential_read == 0 ) )
+			{
+				/* Of a randomly accessed chunk that was deflated in sub-blocks
+				 * only the sub-blocks that contain the requested data are read
+				 */
+				result = libewf_internal_handle_read_chunk_sub_blocks_to_buffer(
+				          internal_handle,
+				          file_io_pool,
+				          chunk_index,
+				          (size_t) ( internal_handle->current_offset % internal_handle->media_values->chunk_size ),
+				          &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+				          buffer_size,
+				          &read_size,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read chunk: %" PRIu64 " sub-blocks to buffer.",
+					 function,
+					 chunk_index );
+
+					return( -1 );
+				}
+				else if( ( result != 0 )
+				      && ( read_size > 0 ) )
+				{
+					buffer_offset    += read_size;
+					buffer_size      -= read_size;
+					total_read_count += (ssize_t) read_size;
+					chunk_index      += 1;
+
+					internal_handle->current_offset += (off64_t) read_size;
+
+					if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
+					{
+						break;
+					}
+					if( internal_handle->io_handle->abort != 0 )
+					{
+						break;
+					}
+					continue;
+				}
+			}
+#endif
+			if( libewf_chunk_table_get_chunk_data_by_offset(
+			     internal_handle->chunk_table,
+			     chunk_index,
+			     internal_handle->io_handle,
+			     file_io_pool,
+			     internal_handle->media_values,
+			     internal_handle->segment_table,
+			     internal_handle->chunk_groups_cache,
+			     internal_handle->chunks_cache,
+			     internal_handle->current_offset,
+			     &chunk_data,
+			     &chunk_data_offset,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to read chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			if( chunk_data == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			if( (off64_t) chunk_data_offset > (off64_t) chunk_data->data_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: chunk: %" PRIu64 " offset exceeds data size.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			read_size = (size_t) ( chunk_data->data_size - chunk_data_offset );
+
+			if( read_size > buffer_size )
+			{
+				read_size = buffer_size;
+			}
+			if( read_size == 0 )
+			{
+				break;
+			}
+			if( memory_copy(
+			     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			     &( ( chunk_data->data )[ chunk_data_offset ] ),
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			if( ( internal_handle->chunk_cache != NULL )
+			 && ( internal_handle->write_io_handle == NULL )
+			 && ( advice != LIBEWF_ACCESS_ADVICE_DONTNEED ) )
+			{
+				/* The chunk data is owned by the chunks cache of the handle
+				 * hence a copy is stored in the shared chunk cache
+				 */
+				if( libewf_chunk_data_clone(
+				     &cached_chunk_data,
+				     chunk_data,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create chunk: %" PRIu64 " cached data.",
+					 function,
+					 chunk_index );
+
+					return( -1 );
+				}
+				if( libewf_chunk_cache_set_chunk_data(
+				     internal_handle->chunk_cache,
+				     internal_handle->chunk_cache_key_prefix | chunk_index,
+				     cached_chunk_data,
+				     internal_handle->read_priority,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set chunk: %" PRIu64 " data in chunk cache.",
+					 function,
+					 chunk_index );
+
+					libewf_chunk_data_free(
+					 &cached_chunk_data,
+					 NULL );
+
+					return( -1 );
+				}
+				cached_chunk_data = NULL;
+			}
+			buffer_offset    += read_size;
+			buffer_size      -= read_size;
+			total_read_count += (ssize_t) read_size;
+			chunk_index      += 1;
+
+			internal_handle->current_offset += (off64_t) read_size;
+
+			if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
+			{
+				break;
+			}
+			if( internal_handle->io_handle->abort != 0 )
+			{
+				break;
+			}
+			chunk_data        = NULL;
+			chunk_data_offset = 0;
+		}
+	}
+	internal_handle->read_ahead_next_chunk_index = chunk_index;
+
+	if( ( internal_handle->chunk_access_map != NULL )
+	 && ( total_read_count > 0 )
+	 && ( file_io_pool == internal_handle->file_io_pool ) )
+	{
+		first_chunk_index = (uint64_t) ( internal_handle->current_offset - (off64_t) total_read_count ) / internal_handle->media_values->chunk_size;
+
+		if( libewf_chunk_access_map_set_chunk_range(
+		     internal_handle->chunk_access_map,
+		     first_chunk_index,
+		     ( (uint64_t) ( internal_handle->current_offset - 1 ) / internal_handle->media_values->chunk_size ) - first_chunk_index + 1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to record chunk access.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( ( internal_handle->running_digest != NULL )
+	 && ( file_io_pool == internal_handle->file_io_pool ) )
+	{
+		if( libewf_running_digest_update(
+		     internal_handle->running_digest,
+		     internal_handle->current_offset - (off64_t) total_read_count,
+		     (uint8_t *) buffer,
+		     (size_t) total_read_count,
+		     internal_handle->media_values->media_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update running digest.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( ( is_sequential_read != 0 )
+	 && ( internal_handle->number_of_read_ahead_chunks > 0 )
+	 && ( file_io_pool == internal_handle->file_io_pool ) )
+	{
+		read_ahead_end_chunk_index = internal_handle->media_values->number_of_chunks;
+
+		/* The read ahead of a sequential range does not extend beyond the range
+		 */
+		if( ( advice == LIBEWF_ACCESS_ADVICE_SEQUENTIAL )
+		 && ( advice_end_chunk_index < read_ahead_end_chunk_index ) )
+		{
+			read_ahead_end_chunk_index = advice_end_chunk_index;
+		}
+		if( libewf_internal_handle_read_ahead_signal(
+		     internal_handle,
+		     chunk_index,
+		     read_ahead_end_chunk_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal read ahead.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( ( is_sequential_read != 0 )
+	 && ( internal_handle->segment_prefetch_size > 0 )
+	 && ( file_io_pool == internal_handle->file_io_pool ) )
+	{
+		if( libewf_internal_handle_prefetch_segment_signal(
+		     internal_handle,
+		     internal_handle->current_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal segment prefetch.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( total_read_count );
+}
+
+/* Reads (media) data at the current offset into a buffer
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_handle_read_buffer(
+         libewf_handle_t *handle,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_read_buffer";
+	ssize_t read_count                        = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	uint8_t is_interactive_read               = 0;
+#endif
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_internal_handle_begin_interactive_read(
+	     internal_handle,
+	     &is_interactive_read,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to begin interactive read.",
+		 function );
+
+		libcthreads_read_write_lock_release_for_write(
+		 internal_handle->read_write_lock,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	read_count = libewf_internal_handle_read_buffer_from_file_io_pool(
+		      internal_handle,
+		      internal_handle->file_io_pool,
+		      buffer,
+		      buffer_size,
+		      error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libewf_internal_handle_end_interactive_read(
+	     internal_handle,
+	     is_interactive_read,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to end interactive read.",
+		 function );
+
+		read_count = -1;
+	}
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Reads (media) data at a specific offset
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_handle_read_buffer_at_offset(
+         libewf_handle_t *handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_read_buffer_at_offset";
+	ssize_t read_count                        = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	uint8_t is_interactive_read               = 0;
+#endif
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_internal_handle_begin_interactive_read(
+	     internal_handle,
+	     &is_interactive_read,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to begin interactive read.",
+		 function );
+
+		libcthreads_read_write_lock_release_for_write(
+		 internal_handle->read_write_lock,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	if( libewf_internal_handle_seek_offset(
+	     internal_handle,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libewf_internal_handle_read_buffer_from_file_io_pool(
+	              internal_handle,
+	              internal_handle->file_io_pool,
+	              buffer,
+	              buffer_size,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libewf_internal_handle_end_interactive_read(
+	     internal_handle,
+	     is_interactive_read,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to end interactive read.",
+		 function );
+
+		read_count = -1;
+	}
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libewf_internal_handle_end_interactive_read(
+	 internal_handle,
+	 is_interactive_read,
+	 NULL );
+
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Compares two vectored read elements by their offset
+ * The function is used with qsort
+ * Returns -1 if the first element starts before, 1 if after or 0 if equal
+ */
+int libewf_internal_handle_compare_vector_elements(
+     const void *first_element,
+     const void *second_element )
+{
+	const libewf_iovec_t *first  = NULL;
+	const libewf_iovec_t *second = NULL;
+
+	first  = *( (const libewf_iovec_t **) first_element );
+	second = *( (const libewf_iovec_t **) second_element );
+
+	if( first->offset < second->offset )
+	{
+		return( -1 );
+	}
+	else if( first->offset > second->offset )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Reads (media) data of multiple ranges into their buffers
+ * The elements are sorted by offset and the chunks they cover are read in offset order,
+ * where a chunk that is covered by multiple elements is read and unpacked once
+ * The current offset is not changed
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libewf_internal_handle_read_vector(
+         libewf_internal_handle_t *internal_handle,
+         const libewf_iovec_t *iov,
+         int count,
+         libcerror_error_t **error )
+{
+	const libewf_iovec_t **sorted_elements = NULL;
+	const libewf_iovec_t *element          = NULL;
+	libewf_chunk_data_t **batch_chunk_data = NULL;
+	libewf_chunk_data_t *chunk_data        = NULL;
+	uint64_t *batch_chunk_indexes          = NULL;
+	static char *function                  = "libewf_internal_handle_read_vector";
+	off64_t chunk_data_offset              = 0;
+	off64_t chunk_offset                   = 0;
+	off64_t copy_end_offset                = 0;
+	off64_t copy_offset                    = 0;
+	off64_t element_end_offset             = 0;
+	size_t array_size                      = 0;
+	size_t copy_size                       = 0;
+	size_t total_size                      = 0;
+	ssize_t total_read_count               = 0;
+	uint64_t chunk_index                   = 0;
+	uint64_t next_chunk_index              = 0;
+	int batch_index                        = 0;
+	int element_index                      = 0;
+	int first_element_index                = 0;
+	int maximum_number_of_batch_chunks     = 1;
+	int next_element_index                 = 0;
+	int number_of_batch_chunks             = 0;
+	int result                             = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	int run_start_index                    = 0;
+#endif
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->media_values == NULL )
+	 || ( internal_handle->media_values->chunk_size == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid handle - vectored reads are only supported on read-only access.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_view_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk view data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( iov == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid vector.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( count < 0 )
+	 || ( (size_t) count > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libewf_iovec_t * ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid count value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	for( element_index = 0;
+	     element_index < count;
+	     element_index++ )
+	{
+		element = &( iov[ element_index ] );
+
+		if( ( element->buffer == NULL )
+		 && ( element->buffer_size > 0 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid vector element: %d - missing buffer.",
+			 function,
+			 element_index );
+
+			return( -1 );
+		}
+		if( element->offset < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+			 "%s: invalid vector element: %d - offset value less than zero.",
+			 function,
+			 element_index );
+
+			return( -1 );
+		}
+		if( element->buffer_size > ( (size_t) SSIZE_MAX - total_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid vector element: %d - buffer size value exceeds maximum.",
+			 function,
+			 element_index );
+
+			return( -1 );
+		}
+		total_size += element->buffer_size;
+	}
+	if( total_size == 0 )
+	{
+		return( 0 );
+	}
+	sorted_elements = (const libewf_iovec_t **) memory_allocate(
+	                                             sizeof( libewf_iovec_t * ) * count );
+
+	if( sorted_elements == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create sorted elements.",
+		 function );
+
+		goto on_error;
+	}
+	for( element_index = 0;
+	     element_index < count;
+	     element_index++ )
+	{
+		sorted_elements[ element_index ] = &( iov[ element_index ] );
+	}
+	qsort(
+	 sorted_elements,
+	 (size_t) count,
+	 sizeof( libewf_iovec_t * ),
+	 &libewf_internal_handle_compare_vector_elements );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The chunks of a batch are unpacked in parallel, independent of the element they belong to
+	 */
+	if( internal_handle->number_of_threads > 1 )
+	{
+		if( internal_handle->chunk_unpacker == NULL )
+		{
+			if( libewf_chunk_unpacker_initialize(
+			     &( internal_handle->chunk_unpacker ),
+			     internal_handle->io_handle,
+			     internal_handle->number_of_threads,
+			     internal_handle->scheduler,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create chunk unpacker.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		maximum_number_of_batch_chunks = internal_handle->chunk_unpacker->maximum_number_of_chunks;
+	}
+#endif
+	array_size = sizeof( libewf_chunk_data_t * ) * maximum_number_of_batch_chunks;
+
+	batch_chunk_data = (libewf_chunk_data_t **) memory_allocate(
+	                                             array_size );
+
+	if( batch_chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create batch chunk data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     batch_chunk_data,
+	     0,
+	     array_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear batch chunk data.",
+		 function );
+
+		memory_free(
+		 batch_chunk_data );
+
+		batch_chunk_data = NULL;
+
+		goto on_error;
+	}
+	batch_chunk_indexes = (uint64_t *) memory_allocate(
+	                                    sizeof( uint64_t ) * maximum_number_of_batch_chunks );
+
+	if( batch_chunk_indexes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create batch chunk indexes.",
+		 function );
+
+		goto on_error;
+	}
+	while( internal_handle->io_handle->abort == 0 )
+	{
+		/* Determine the next chunks in offset order that are covered by the elements
+		 */
+		number_of_batch_chunks = 0;
+
+		while( number_of_batch_chunks < maximum_number_of_batch_chunks )
+		{
+			while( next_element_index < count )
+			{
+				element            = sorted_elements[ next_element_index ];
+				element_end_offset = element->offset + (off64_t) element->buffer_size;
+
+				if( (size64_t) element_end_offset > internal_handle->media_values->media_size )
+				{
+					element_end_offset = (off64_t) internal_handle->media_values->media_size;
+				}
+				if( ( element->offset < element_end_offset )
+				 && ( ( (uint64_t) ( element_end_offset - 1 ) / internal_handle->media_values->chunk_size ) >= next_chunk_index ) )
+				{
+					break;
+				}
+				next_element_index++;
+			}
+			if( next_element_index >= count )
+			{
+				break;
+			}
+			chunk_index = (uint64_t) element->offset / internal_handle->media_values->chunk_size;
+
+			if( chunk_index > next_chunk_index )
+			{
+				next_chunk_index = chunk_index;
+			}
+			batch_chunk_indexes[ number_of_batch_chunks++ ] = next_chunk_index;
+
+			next_chunk_index += 1;
+		}
+		if( number_of_batch_chunks == 0 )
+		{
+			break;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( maximum_number_of_batch_chunks > 1 )
+		{
+			/* The chunks are read on the calling thread in runs of consecutive chunks
+			 * since the file IO pool and the chunk table are not thread-safe
+			 */
+			run_start_index = 0;
+
+			for( batch_index = 1;
+			     batch_index <= number_of_batch_chunks;
+			     batch_index++ )
+			{
+				if( ( batch_index < number_of_batch_chunks )
+				 && ( batch_chunk_indexes[ batch_index ] == ( batch_chunk_indexes[ batch_index - 1 ] + 1 ) ) )
+				{
+					continue;
+				}
+				if( libewf_internal_handle_read_packed_chunks_data(
+				     internal_handle,
+				     internal_handle->file_io_pool,
+				     batch_chunk_indexes[ run_start_index ],
+				     &( batch_chunk_data[ run_start_index ] ),
+				     batch_index - run_start_index,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read chunks: %" PRIu64 " - %" PRIu64 " data.",
+					 function,
+					 batch_chunk_indexes[ run_start_index ],
+					 batch_chunk_indexes[ batch_index - 1 ] );
+
+					goto on_error;
+				}
+				run_start_index = batch_index;
+			}
+			if( libewf_chunk_unpacker_unpack(
+			     internal_handle->chunk_unpacker,
+			     batch_chunk_data,
+			     number_of_batch_chunks,
+			     internal_handle->read_priority,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to unpack batch of: %d chunks.",
+				 function,
+				 number_of_batch_chunks );
+
+				goto on_error;
+			}
+		}
+#endif
+		for( batch_index = 0;
+		     batch_index < number_of_batch_chunks;
+		     batch_index++ )
+		{
+			chunk_index  = batch_chunk_indexes[ batch_index ];
+			chunk_offset = (off64_t) ( chunk_index * internal_handle->media_values->chunk_size );
+			chunk_data   = batch_chunk_data[ batch_index ];
+
+			if( chunk_data == NULL )
+			{
+				/* Missing and sparse chunks are handled by the chunk table
+				 */
+				if( libewf_internal_handle_read_segment_files_to_offset(
+				     internal_handle,
+				     internal_handle->file_io_pool,
+				     chunk_offset,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read segment files up to offset: %" PRIi64 ".",
+					 function,
+					 chunk_offset );
+
+					goto on_error;
+				}
+				if( libewf_chunk_table_get_chunk_data_by_offset(
+				     internal_handle->chunk_table,
+				     chunk_index,
+				     internal_handle->io_handle,
+				     internal_handle->file_io_pool,
+				     internal_handle->media_values,
+				     internal_handle->segment_table,
+				     internal_handle->chunk_groups_cache,
+				     internal_handle->chunks_cache,
+				     chunk_offset,
+				     &chunk_data,
+				     &chunk_data_offset,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to read chunk: %" PRIu64 " data.",
+					 function,
+					 chunk_index );
+
+					goto on_error;
+				}
+				if( chunk_data == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+					 "%s: missing chunk: %" PRIu64 " data.",
+					 function,
+					 chunk_index );
+
+					goto on_error;
+				}
+			}
+			else if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+			{
+				if( libewf_internal_handle_append_chunk_checksum_error(
+				     internal_handle,
+				     chunk_index,
+				     chunk_data,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append chunk: %" PRIu64 " checksum error.",
+					 function,
+					 chunk_index );
+
+					goto on_error;
+				}
+			}
+			/* Copy the chunk data to every element that overlaps with the chunk,
+			 * the elements that end before the chunk are no longer considered
+			 */
+			while( first_element_index < count )
+			{
+				element = sorted_elements[ first_element_index ];
+
+				if( ( element->offset + (off64_t) element->buffer_size ) > chunk_offset )
+				{
+					break;
+				}
+				first_element_index++;
+			}
+			copy_end_offset = chunk_offset + (off64_t) chunk_data->data_size;
+
+			for( element_index = first_element_index;
+			     element_index < count;
+			     element_index++ )
+			{
+				element = sorted_elements[ element_index ];
+
+				if( element->offset >= copy_end_offset )
+				{
+					break;
+				}
+				copy_offset        = element->offset;
+				element_end_offset = element->offset + (off64_t) element->buffer_size;
+
+				if( copy_offset < chunk_offset )
+				{
+					copy_offset = chunk_offset;
+				}
+				if( element_end_offset > copy_end_offset )
+				{
+					element_end_offset = copy_end_offset;
+				}
+				if( copy_offset >= element_end_offset )
+				{
+					continue;
+				}
+				copy_size = (size_t) ( element_end_offset - copy_offset );
+
+				if( memory_copy(
+				     &( ( (uint8_t *) element->buffer )[ copy_offset - element->offset ] ),
+				     &( ( chunk_data->data )[ copy_offset - chunk_offset ] ),
+				     copy_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
+					 function,
+					 chunk_index );
+
+					goto on_error;
+				}
+				total_read_count += (ssize_t) copy_size;
+			}
+			if( batch_chunk_data[ batch_index ] != NULL )
+			{
+				/* Cache the unpacked chunk data so that a subsequent read
+				 * of the chunk does not need to unpack it again
+				 */
+				if( internal_handle->chunk_cache != NULL )
+				{
+					result = libewf_chunk_cache_set_chunk_data(
+					          internal_handle->chunk_cache,
+					          internal_handle->chunk_cache_key_prefix | chunk_index,
+					          batch_chunk_data[ batch_index ],
+					          internal_handle->read_priority,
+					          error );
+				}
+				else
+				{
+					result = libewf_chunk_table_set_chunk_data_by_offset(
+					          internal_handle->chunk_table,
+					          chunk_index,
+					          internal_handle->file_io_pool,
+					          internal_handle->segment_table,
+					          internal_handle->chunk_groups_cache,
+					          internal_handle->chunks_cache,
+					          chunk_offset,
+					          batch_chunk_data[ batch_index ],
+					          error );
+				}
+				if( result != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set chunk: %" PRIu64 " data.",
+					 function,
+					 chunk_index );
+
+					goto on_error;
+				}
+				/* The cache takes over management of the chunk data
+				 */
+				batch_chunk_data[ batch_index ] = NULL;
+			}
+			chunk_data = NULL;
+		}
+	}
+	memory_free(
+	 batch_chunk_indexes );
+
+	memory_free(
+	 batch_chunk_data );
+
+	memory_free(
+	 sorted_elements );
+
+	return( total_read_count );
+
+on_error:
+	if( batch_chunk_indexes != NULL )
+	{
+		memory_free(
+		 batch_chunk_indexes );
+	}
+	if( batch_chunk_data != NULL )
+	{
+		for( batch_index = 0;
+		     batch_index < maximum_number_of_batch_chunks;
+		     batch_index++ )
+		{
+			if( batch_chunk_data[ batch_index ] != NULL )
+			{
+				libewf_chunk_data_free(
+				 &( batch_chunk_data[ batch_index ] ),
+				 NULL );
+			}
+		}
+		memory_free(
+		 batch_chunk_data );
+	}
+	if( sorted_elements != NULL )
+	{
+		memory_free(
+		 sorted_elements );
+	}
+	return( -1 );
+}
+
+/* Reads (media) data of multiple ranges into their buffers
+ * All elements are read while the handle is locked once
+ * The number of bytes read is the sum of the bytes read into the buffers
+ * where the data of an element that extends beyond the media size is truncated
+ * The current offset is not changed
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libewf_handle_read_vector(
+         libewf_handle_t *handle,
+         const libewf_iovec_t *iov,
+         int count,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_read_vector";
+	ssize_t read_count                        = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	uint8_t is_interactive_read               = 0;
+#endif
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_internal_handle_begin_interactive_read(
+	     internal_handle,
+	     &is_interactive_read,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to begin interactive read.",
+		 function );
+
+		libcthreads_read_write_lock_release_for_write(
+		 internal_handle->read_write_lock,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	read_count = libewf_internal_handle_read_vector(
+	              internal_handle,
+	              iov,
+	              count,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read vector.",
+		 function );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libewf_internal_handle_end_interactive_read(
+	     internal_handle,
+	     is_interactive_read,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to end interactive read.",
+		 function );
+
+		read_count = -1;
+	}
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Sets the digest types that are calculated while the media data is read sequentially
+ * A value of 0 disables the running digest
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_running_digest_types(
+     libewf_handle_t *handle,
+     uint8_t digest_types,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_running_digest_types";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->running_digest != NULL )
+	{
+		if( libewf_running_digest_free(
+		     &( internal_handle->running_digest ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free running digest.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( ( result == 1 )
+	 && ( digest_types != 0 ) )
+	{
+		if( libewf_running_digest_initialize(
+		     &( internal_handle->running_digest ),
+		     digest_types,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create running digest.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves a digest that was calculated while the media data was read sequentially
+ * The digest is available after all media data was read from the start without
+ * skipping data
+ * Returns 1 if successful, 0 if the digest is not available or -1 on error
+ */
+int libewf_handle_get_running_digest(
+     libewf_handle_t *handle,
+     uint8_t digest_type,
+     uint8_t *digest,
+     size_t digest_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_running_digest";
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->running_digest != NULL )
+	{
+		result = libewf_running_digest_get_digest(
+		          internal_handle->running_digest,
+		          digest_type,
+		          digest,
+		          digest_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve running digest.",
+			 function );
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Reads the packed chunk data of a specific chunk
+ * Missing and sparse chunks are not read, these are handled by the chunk table
+ * A chunk that previously failed to unpack is not read, its chunk data is set
+ * to the unpacked data remembered by the chunk table instead
+ * This function is not multi-thread safe acquire write lock before call
+ * The caller takes over management of the chunk data
+ * Returns 1 if successful, 0 if the chunk is missing or sparse or -1 on error
+ */
+int libewf_internal_handle_read_packed_chunk_data(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	static char *function     = "libewf_internal_handle_read_packed_chunk_data";
+	off64_t chunk_data_offset = 0;
+	off64_t chunk_offset      = 0;
+	off64_t range_offset      = 0;
+	size64_t range_size       = 0;
+	ssize_t read_count        = 0;
+	int64_t start_timestamp   = 0;
+	uint32_t range_flags      = 0;
+	int file_io_pool_entry    = 0;
+	int result                = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_offset = (off64_t) chunk_index * internal_handle->media_values->chunk_size;
+
+	if( libewf_internal_handle_read_segment_files_to_offset(
+	     internal_handle,
+	     file_io_pool,
+	     chunk_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read segment files up to offset: %" PRIi64 ".",
+		 function,
+		 chunk_offset );
+
+		goto on_error;
+	}
+	result = libewf_chunk_table_get_chunk_range_by_offset(
+	          internal_handle->chunk_table,
+	          chunk_index,
+	          file_io_pool,
+	          internal_handle->segment_table,
+	          internal_handle->chunk_groups_cache,
+	          chunk_offset,
+	          &file_io_pool_entry,
+	          &range_offset,
+	          &range_size,
+	          &range_flags,
+	          &chunk_data_offset,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " range.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	if( ( result == 0 )
+	 || ( ( range_flags & LIBEWF_RANGE_FLAG_IS_SPARSE ) != 0 ) )
+	{
+		return( 0 );
+	}
+	result = libewf_chunk_table_get_corrupted_chunk_data(
+	          internal_handle->chunk_table,
+	          chunk_index,
+	          internal_handle->media_values->chunk_size,
+	          chunk_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve corrupted chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		return( 1 );
+	}
+	if( libewf_chunk_data_initialize_with_buffer_pool(
+	     chunk_data,
+	     internal_handle->io_handle->buffer_pool,
+	     internal_handle->media_values->chunk_size,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	if( internal_handle->io_handle->statistics != NULL )
+	{
+		if( libewf_statistics_get_timestamp(
+		     &start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve start timestamp.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	read_count = libewf_chunk_data_read_from_file_io_pool(
+	              *chunk_data,
+	              file_io_pool,
+	              file_io_pool_entry,
+	              range_offset,
+	              range_size,
+	              range_flags,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	if( internal_handle->io_handle->statistics != NULL )
+	{
+		if( libewf_statistics_add_segment_file_read(
+		     internal_handle->io_handle->statistics,
+		     (size_t) read_count,
+		     start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to add segment file read to statistics.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( *chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the packed chunk data of consecutive chunks
+ * The packed data of chunks that are stored contiguously in the same segment file
+ * is read with a single read of up to LIBEWF_MAXIMUM_COALESCED_READ_SIZE bytes
+ * Multiple of these reads are kept in flight by the asynchronous reader
+ * The entries of missing and sparse chunks are set to NULL, these are handled by the chunk table
+ * The entries of chunks that previously failed to unpack are set to the unpacked data
+ * remembered by the chunk table, these chunks are not read
+ * This function is not multi-thread safe acquire write lock before call
+ * The caller takes over management of the chunk data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_read_packed_chunks_data(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     int number_of_chunks,
+     libcerror_error_t **error )
+{
+	uint8_t *run_buffers[ LIBEWF_ASYNC_READER_MAXIMUM_NUMBER_OF_REQUESTS ];
+	int run_end_indexes[ LIBEWF_ASYNC_READER_MAXIMUM_NUMBER_OF_REQUESTS ];
+	int run_start_indexes[ LIBEWF_ASYNC_READER_MAXIMUM_NUMBER_OF_REQUESTS ];
+
+	libewf_async_reader_request_t *request = NULL;
+	static char *function                  = "libewf_internal_handle_read_packed_chunks_data";
+	off64_t chunk_data_offset              = 0;
+	off64_t chunk_offset                   = 0;
+	off64_t range_offset                   = 0;
+	off64_t run_offset                     = 0;
+	size64_t range_size                    = 0;
+	size_t read_buffer_offset              = 0;
+	size_t run_size                        = 0;
+	ssize_t read_count                     = 0;
+	int64_t runs_start_timestamp           = 0;
+	int64_t start_timestamp                = 0;
+	uint32_t range_flags                   = 0;
+	int chunk_data_index                   = 0;
+	int file_io_pool_entry                 = 0;
+	int maximum_number_of_runs             = 1;
+	int number_of_runs                     = 0;
+	int result                             = 0;
+	int run_chunk_data_index               = 0;
+	int run_file_io_pool_entry             = 0;
+	int run_index                          = 0;
+	int run_start_index                    = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_chunks < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of chunks value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	for( run_index = 0;
+	     run_index < LIBEWF_ASYNC_READER_MAXIMUM_NUMBER_OF_REQUESTS;
+	     run_index++ )
+	{
+		run_buffers[ run_index ] = NULL;
+	}
+	for( chunk_data_index = 0;
+	     chunk_data_index < number_of_chunks;
+	     chunk_data_index++ )
+	{
+		chunk_data[ chunk_data_index ] = NULL;
+	}
+	/* A handle that was not opened by filename has an asynchronous reader without files
+	 * that reads through the file IO pool
+	 */
+	if( internal_handle->async_reader == NULL )
+	{
+		if( libewf_async_reader_initialize(
+		     &( internal_handle->async_reader ),
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create async reader.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* Multiple runs are only read before they are copied when their reads can be in flight
+	 */
+	if( internal_handle->async_reader->number_of_files > 0 )
+	{
+		maximum_number_of_runs = internal_handle->async_reader->maximum_number_of_requests;
+	}
+	/* The additional iteration reads the last run
+	 */
+	for( chunk_data_index = 0;
+	     chunk_data_index <= number_of_chunks;
+	     chunk_data_index++ )
+	{
+		result = 0;
+
+		if( chunk_data_index < number_of_chunks )
+		{
+			chunk_offset = (off64_t) ( chunk_index + chunk_data_index ) * internal_handle->media_values->chunk_size;
+
+			if( libewf_internal_handle_read_segment_files_to_offset(
+			     internal_handle,
+			     file_io_pool,
+			     chunk_offset,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read segment files up to offset: %" PRIi64 ".",
+				 function,
+				 chunk_offset );
+
+				goto on_error;
+			}
+			result = libewf_chunk_table_get_chunk_range_by_offset(
+			          internal_handle->chunk_table,
+			          chunk_index + chunk_data_index,
+			          file_io_pool,
+			          internal_handle->segment_table,
+			          internal_handle->chunk_groups_cache,
+			          chunk_offset,
+			          &file_io_pool_entry,
+			          &range_offset,
+			          &range_size,
+			          &range_flags,
+			          &chunk_data_offset,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve chunk: %" PRIu64 " range.",
+				 function,
+				 chunk_index + chunk_data_index );
+
+				goto on_error;
+			}
+			if( ( result != 0 )
+			 && ( ( range_flags & LIBEWF_RANGE_FLAG_IS_SPARSE ) != 0 ) )
+			{
+				result = 0;
+			}
+			else if( result != 0 )
+			{
+				result = libewf_chunk_table_get_corrupted_chunk_data(
+				          internal_handle->chunk_table,
+				          chunk_index + chunk_data_index,
+				          internal_handle->media_values->chunk_size,
+				          &( chunk_data[ chunk_data_index ] ),
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve corrupted chunk: %" PRIu64 " data.",
+					 function,
+					 chunk_index + chunk_data_index );
+
+					goto on_error;
+				}
+				/* The chunk data of a corrupted chunk is not read, hence it ends the current run
+				 */
+				else if( result != 0 )
+				{
+					result = 0;
+				}
+				else
+				{
+					result = 1;
+				}
+			}
+		}
+		/* Queue the read of the current run when the chunk does not directly follow it
+		 */
+		if( ( run_size > 0 )
+		 && ( ( result == 0 )
+		  || ( file_io_pool_entry != run_file_io_pool_entry )
+		  || ( range_offset != ( run_offset + (off64_t) run_size ) )
+		  || ( range_size > (size64_t) ( LIBEWF_MAXIMUM_COALESCED_READ_SIZE - run_size ) ) ) )
+		{
+			if( run_buffers[ number_of_runs ] == NULL )
+			{
+				run_buffers[ number_of_runs ] = (uint8_t *) memory_allocate(
+				                                             sizeof( uint8_t ) * LIBEWF_MAXIMUM_COALESCED_READ_SIZE );
+
+				if( run_buffers[ number_of_runs ] == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to create read buffer.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			/* The reads that are in flight together share the start timestamp
+			 */
+			if( ( number_of_runs == 0 )
+			 && ( internal_handle->io_handle->statistics != NULL ) )
+			{
+				if( libewf_statistics_get_timestamp(
+				     &runs_start_timestamp,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve runs start timestamp.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			LIBEWF_TRACE_CHUNK_READ_START(
+			 run_file_io_pool_entry,
+			 run_offset,
+			 run_size );
+
+			if( libewf_async_reader_queue_read(
+			     internal_handle->async_reader,
+			     file_io_pool,
+			     run_file_io_pool_entry,
+			     run_offset,
+			     run_buffers[ number_of_runs ],
+			     run_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read chunks: %" PRIu64 " - %" PRIu64 " data.",
+				 function,
+				 chunk_index + run_start_index,
+				 chunk_index + chunk_data_index - 1 );
+
+				goto on_error;
+			}
+			run_start_indexes[ number_of_runs ] = run_start_index;
+			run_end_indexes[ number_of_runs ]   = chunk_data_index;
+
+			number_of_runs += 1;
+
+			run_size = 0;
+		}
+		/* Copy the data of the runs once their reads have completed
+		 * the requests of the asynchronous reader correspond to the runs
+		 */
+		if( ( number_of_runs > 0 )
+		 && ( ( number_of_runs >= maximum_number_of_runs )
+		  || ( chunk_data_index >= number_of_chunks ) ) )
+		{
+			if( libewf_async_reader_wait(
+			     internal_handle->async_reader,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read chunks: %" PRIu64 " - %" PRIu64 " data.",
+				 function,
+				 chunk_index + run_start_indexes[ 0 ],
+				 chunk_index + run_end_indexes[ number_of_runs - 1 ] - 1 );
+
+				goto on_error;
+			}
+			for( run_index = 0;
+			     run_index < number_of_runs;
+			     run_index++ )
+			{
+				request = &( internal_handle->async_reader->requests[ run_index ] );
+
+				LIBEWF_TRACE_CHUNK_READ_END(
+				 request->file_io_pool_entry,
+				 request->offset,
+				 (ssize_t) request->size );
+
+				if( internal_handle->io_handle->statistics != NULL )
+				{
+					if( libewf_statistics_add_segment_file_read(
+					     internal_handle->io_handle->statistics,
+					     request->size,
+					     runs_start_timestamp,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+						 "%s: unable to add segment file read to statistics.",
+						 function );
+
+						goto on_error;
+					}
+				}
+				read_buffer_offset = 0;
+
+				for( run_chunk_data_index = run_start_indexes[ run_index ];
+				     run_chunk_data_index < run_end_indexes[ run_index ];
+				     run_chunk_data_index++ )
+				{
+					if( memory_copy(
+					     chunk_data[ run_chunk_data_index ]->data,
+					     &( ( request->buffer )[ read_buffer_offset ] ),
+					     chunk_data[ run_chunk_data_index ]->data_size ) == NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+						 "%s: unable to copy chunk: %" PRIu64 " data.",
+						 function,
+						 chunk_index + run_chunk_data_index );
+
+						goto on_error;
+					}
+					read_buffer_offset += chunk_data[ run_chunk_data_index ]->data_size;
+				}
+			}
+			number_of_runs = 0;
+		}
+		if( result == 0 )
+		{
+			continue;
+		}
+		if( libewf_chunk_data_initialize_with_buffer_pool(
+		     &( chunk_data[ chunk_data_index ] ),
+		     internal_handle->io_handle->buffer_pool,
+		     internal_handle->media_values->chunk_size,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index + chunk_data_index );
+
+			goto on_error;
+		}
+		if( ( range_size == 0 )
+		 || ( range_size > (size64_t) chunk_data[ chunk_data_index ]->allocated_data_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid chunk: %" PRIu64 " range size value out of bounds.",
+			 function,
+			 chunk_index + chunk_data_index );
+
+			goto on_error;
+		}
+		if( range_size > (size64_t) LIBEWF_MAXIMUM_COALESCED_READ_SIZE )
+		{
+			if( internal_handle->io_handle->statistics != NULL )
+			{
+				if( libewf_statistics_get_timestamp(
+				     &start_timestamp,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve start timestamp.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			read_count = libewf_chunk_data_read_from_file_io_pool(
+			              chunk_data[ chunk_data_index ],
+			              file_io_pool,
+			              file_io_pool_entry,
+			              range_offset,
+			              range_size,
+			              range_flags,
+			              error );
+
+			if( read_count < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index + chunk_data_index );
+
+				goto on_error;
+			}
+			if( internal_handle->io_handle->statistics != NULL )
+			{
+				if( libewf_statistics_add_segment_file_read(
+				     internal_handle->io_handle->statistics,
+				     (size_t) read_count,
+				     start_timestamp,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to add segment file read to statistics.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			continue;
+		}
+		/* The data is copied into the chunk data when the run is read
+		 */
+		chunk_data[ chunk_data_index ]->data_size   = (size_t) range_size;
+		chunk_data[ chunk_data_index ]->range_flags = ( range_flags | LIBEWF_RANGE_FLAG_IS_PACKED )
+		                                            & ~( LIBEWF_RANGE_FLAG_IS_TAINTED | LIBEWF_RANGE_FLAG_IS_CORRUPTED );
+
+		if( run_size == 0 )
+		{
+			run_file_io_pool_entry = file_io_pool_entry;
+			run_offset             = range_offset;
+			run_start_index        = chunk_data_index;
+		}
+		run_size += (size_t) range_size;
+	}
+	for( run_index = 0;
+	     run_index < LIBEWF_ASYNC_READER_MAXIMUM_NUMBER_OF_REQUESTS;
+	     run_index++ )
+	{
+		if( run_buffers[ run_index ] != NULL )
+		{
+			memory_free(
+			 run_buffers[ run_index ] );
+		}
+	}
+	return( 1 );
+
+on_error:
+	/* The reads that are in flight must complete before their buffers are freed
+	 */
+	if( internal_handle->async_reader != NULL )
+	{
+		if( internal_handle->async_reader->number_of_requests > 0 )
+		{
+			libewf_async_reader_wait(
+			 internal_handle->async_reader,
+			 NULL );
+		}
+	}
+	for( run_index = 0;
+	     run_index < LIBEWF_ASYNC_READER_MAXIMUM_NUMBER_OF_REQUESTS;
+	     run_index++ )
+	{
+		if( run_buffers[ run_index ] != NULL )
+		{
+			memory_free(
+			 run_buffers[ run_index ] );
+		}
+	}
+	for( chunk_data_index = 0;
+	     chunk_data_index < number_of_chunks;
+	     chunk_data_index++ )
+	{
+		if( chunk_data[ chunk_data_index ] != NULL )
+		{
+			libewf_chunk_data_free(
+			 &( chunk_data[ chunk_data_index ] ),
+			 NULL );
+		}
+	}
+	return( -1 );
+}
+
+/* Reads the data of a specific chunk directly into a buffer
+ * Compressed chunks are decompressed into the buffer and other chunks are unpacked
+ * and copied, the chunk data is not stored in the chunk cache or the chunks cache
+ * Missing and sparse chunks are not read, these are handled by the chunk table
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful, 0 if the chunk is missing or sparse or -1 on error
+ */
+int libewf_internal_handle_read_chunk_data_to_buffer(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t chunk_index,
+     uint8_t *buffer,
+     size_t buffer_size,
+     size_t *read_size,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_internal_handle_read_chunk_data_to_buffer";
+	int result                      = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read size.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_internal_handle_read_packed_chunk_data(
+	          internal_handle,
+	          file_io_pool,
+	          chunk_index,
+	          &chunk_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk: %" PRIu64 " packed data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	result = libewf_chunk_data_unpack_to_buffer(
+	          chunk_data,
+	          internal_handle->io_handle,
+	          internal_handle->chunk_table->compression_context,
+	          buffer,
+	          buffer_size,
+	          read_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to unpack chunk: %" PRIu64 " data to buffer.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		if( libewf_chunk_data_unpack(
+		     chunk_data,
+		     internal_handle->io_handle,
+		     internal_handle->chunk_table->compression_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to unpack chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+		{
+			if( libewf_internal_handle_append_chunk_checksum_error(
+			     internal_handle,
+			     chunk_index,
+			     chunk_data,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append chunk: %" PRIu64 " checksum error.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+		}
+		*read_size = chunk_data->data_size;
+
+		if( *read_size > buffer_size )
+		{
+			*read_size = buffer_size;
+		}
+		if( memory_copy(
+		     buffer,
+		     chunk_data->data,
+		     *read_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+	}
+	if( libewf_chunk_data_free(
+	     &chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) && defined( HAVE_ZLIB_INFLATE ) ) || defined( ZLIB_DLL )
+
+/* Reads the data of a specific chunk that was deflated in sub-blocks directly into a buffer
+ * Only the sub-blocks that contain the requested data are read and decompressed
+ * The chunk data is not stored in the chunk cache or the chunks cache
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful, 0 if the chunk does not contain a (valid) sub-block index or -1 on error
+ */
+int libewf_internal_handle_read_chunk_sub_blocks_to_buffer(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t chunk_index,
+     size_t chunk_data_offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     size_t *read_size,
+     libcerror_error_t **error )
+{
+	libewf_parallel_deflate_sub_block_index_t sub_block_index;
+
+	uint8_t footer_data[ LIBEWF_PARALLEL_DEFLATE_SUB_BLOCK_INDEX_FOOTER_SIZE ];
+
+	uint8_t *compressed_data      = NULL;
+	uint8_t *entries_data         = NULL;
+	uint8_t *uncompressed_data    = NULL;
+	static char *function         = "libewf_internal_handle_read_chunk_sub_blocks_to_buffer";
+	off64_t chunk_offset          = 0;
+	off64_t range_chunk_offset    = 0;
+	off64_t range_offset          = 0;
+	size64_t range_size           = 0;
+	size_t chunk_data_size        = 0;
+	size_t compressed_data_offset = 0;
+	size_t compressed_data_size   = 0;
+	size_t requested_size         = 0;
+	size_t sub_block_data_offset  = 0;
+	size_t sub_block_data_size    = 0;
+	size_t total_read_size        = 0;
+	size_t uncompressed_data_size = 0;
+	ssize_t read_count            = 0;
+	int64_t start_timestamp       = 0;
+	uint32_t first_sub_block      = 0;
+	uint32_t last_sub_block       = 0;
+	uint32_t number_of_sub_blocks = 0;
+	uint32_t range_flags          = 0;
+	uint32_t sub_block_checksum   = 0;
+	int file_io_pool_entry        = 0;
+	int number_of_threads         = 1;
+	int result                    = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read size.",
+		 function );
+
+		return( -1 );
+	}
+	/* Only deflate compressed EWF2 chunks are deflated in sub-blocks
+	 */
+	if( ( internal_handle->io_handle->major_version != 2 )
+	 || ( internal_handle->io_handle->compression_method != LIBEWF_COMPRESSION_METHOD_DEFLATE ) )
+	{
+		return( 0 );
+	}
+	chunk_offset = (off64_t) chunk_index * internal_handle->media_values->chunk_size;
+
+	if( (size64_t) chunk_offset >= internal_handle->media_values->media_size )
+	{
+		return( 0 );
+	}
+	chunk_data_size = (size_t) internal_handle->media_values->chunk_size;
+
+	if( (size64_t) chunk_data_size > ( internal_handle->media_values->media_size - chunk_offset ) )
+	{
+		chunk_data_size = (size_t) ( internal_handle->media_values->media_size - chunk_offset );
+	}
+	if( chunk_data_offset >= chunk_data_size )
+	{
+		return( 0 );
+	}
+	result = libewf_chunk_table_get_chunk_range_by_offset(
+	          internal_handle->chunk_table,
+	          chunk_index,
+	          file_io_pool,
+	          internal_handle->segment_table,
+	          internal_handle->chunk_groups_cache,
+	          chunk_offset,
+	          &file_io_pool_entry,
+	          &range_offset,
+	          &range_size,
+	          &range_flags,
+	          &range_chunk_offset,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " range.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	/* Only deflate compressed chunks that are flagged to contain a sub-block index
+	 * and are not damaged are read by sub-block
+	 */
+	if( ( result == 0 )
+	 || ( ( range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) == 0 )
+	 || ( ( range_flags & LIBEWF_RANGE_FLAG_HAS_SUB_BLOCK_INDEX ) == 0 )
+	 || ( ( range_flags & ( LIBEWF_RANGE_FLAG_IS_SPARSE | LIBEWF_RANGE_FLAG_USES_PATTERN_FILL | LIBEWF_RANGE_FLAG_IS_TAINTED | LIBEWF_RANGE_FLAG_IS_CORRUPTED | LIBEWF_RANGE_FLAG_IS_ENCRYPTED ) ) != 0 )
+	 || ( range_size <= (size64_t) LIBEWF_PARALLEL_DEFLATE_SUB_BLOCK_INDEX_FOOTER_SIZE )
+	 || ( range_size > (size64_t) SSIZE_MAX ) )
+	{
+		return( 0 );
+	}
+	if( internal_handle->io_handle->statistics != NULL )
+	{
+		if( libewf_statistics_get_timestamp(
+		     &start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve start timestamp.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* Read the sub-block index footer at the end of the chunk
+	 */
+	if( libbfio_pool_seek_offset(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     range_offset + (off64_t) range_size - LIBEWF_PARALLEL_DEFLATE_SUB_BLOCK_INDEX_FOOTER_SIZE,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek chunk: %" PRIu64 " sub-block index footer.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	read_count = libbfio_pool_read_buffer(
+	              file_io_pool,
+	              file_io_pool_entry,
+	              footer_data,
+	              LIBEWF_PARALLEL_DEFLATE_SUB_BLOCK_INDEX_FOOTER_SIZE,
+	              error );
+
+	if( read_count != (ssize_t) LIBEWF_PARALLEL_DEFLATE_SUB_BLOCK_INDEX_FOOTER_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk: %" PRIu64 " sub-block index footer.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	total_read_size += (size_t) read_count;
+
+	result = libewf_parallel_deflate_sub_block_index_read_footer(
+	          &sub_block_index,
+	          footer_data,
+	          LIBEWF_PARALLEL_DEFLATE_SUB_BLOCK_INDEX_FOOTER_SIZE,
+	          (size_t) range_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to read chunk: %" PRIu64 " sub-block index footer.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	/* The sub-blocks must cover the chunk data exactly
+	 */
+	number_of_sub_blocks = (uint32_t) ( chunk_data_size / sub_block_index.sub_block_size );
+
+	if( ( chunk_data_size % sub_block_index.sub_block_size ) != 0 )
+	{
+		number_of_sub_blocks++;
+	}
+	if( number_of_sub_blocks != sub_block_index.number_of_sub_blocks )
+	{
+		return( 0 );
+	}
+	entries_data = (uint8_t *) memory_allocate(
+	                            sizeof( uint8_t ) * sub_block_index.entries_data_size );
+
+	if( entries_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_seek_offset(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     range_offset + (off64_t) sub_block_index.zlib_stream_size,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek chunk: %" PRIu64 " sub-block index entries.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	read_count = libbfio_pool_read_buffer(
+	              file_io_pool,
+	              file_io_pool_entry,
+	              entries_data,
+	              sub_block_index.entries_data_size,
+	              error );
+
+	if( read_count != (ssize_t) sub_block_index.entries_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk: %" PRIu64 " sub-block index entries.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	total_read_size += (size_t) read_count;
+
+	result = libewf_parallel_deflate_sub_block_index_set_entries_data(
+	          &sub_block_index,
+	          entries_data,
+	          sub_block_index.entries_data_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk: %" PRIu64 " sub-block index entries data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	if( result != 0 )
+	{
+		/* Determine the sub-blocks that contain the requested data
+		 */
+		requested_size = chunk_data_size - chunk_data_offset;
+
+		if( requested_size > buffer_size )
+		{
+			requested_size = buffer_size;
+		}
+		first_sub_block = (uint32_t) ( chunk_data_offset / sub_block_index.sub_block_size );
+		last_sub_block  = (uint32_t) ( ( chunk_data_offset + requested_size - 1 ) / sub_block_index.sub_block_size );
+
+		if( libewf_parallel_deflate_sub_block_index_get_sub_block(
+		     &sub_block_index,
+		     first_sub_block,
+		     &compressed_data_offset,
+		     &sub_block_data_size,
+		     &sub_block_checksum,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " sub-block: %" PRIu32 ".",
+			 function,
+			 chunk_index,
+			 first_sub_block );
+
+			goto on_error;
+		}
+		if( libewf_parallel_deflate_sub_block_index_get_sub_block(
+		     &sub_block_index,
+		     last_sub_block,
+		     &sub_block_data_offset,
+		     &sub_block_data_size,
+		     &sub_block_checksum,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " sub-block: %" PRIu32 ".",
+			 function,
+			 chunk_index,
+			 last_sub_block );
+
+			goto on_error;
+		}
+		compressed_data_size   = sub_block_data_offset + sub_block_data_size - compressed_data_offset;
+		uncompressed_data_size = (size_t) ( last_sub_block - first_sub_block + 1 ) * sub_block_index.sub_block_size;
+
+		if( uncompressed_data_size > ( chunk_data_size - ( (size_t) first_sub_block * sub_block_index.sub_block_size ) ) )
+		{
+			uncompressed_data_size = chunk_data_size - ( (size_t) first_sub_block * sub_block_index.sub_block_size );
+		}
+		compressed_data = (uint8_t *) memory_allocate(
+		                               sizeof( uint8_t ) * compressed_data_size );
+
+		if( compressed_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create compressed data.",
+			 function );
+
+			goto on_error;
+		}
+		uncompressed_data = (uint8_t *) memory_allocate(
+		                                 sizeof( uint8_t ) * uncompressed_data_size );
+
+		if( uncompressed_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create uncompressed data.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbfio_pool_seek_offset(
+		     file_io_pool,
+		     file_io_pool_entry,
+		     range_offset + (off64_t) compressed_data_offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek chunk: %" PRIu64 " sub-blocks: %" PRIu32 " - %" PRIu32 ".",
+			 function,
+			 chunk_index,
+			 first_sub_block,
+			 last_sub_block );
+
+			goto on_error;
+		}
+		LIBEWF_TRACE_CHUNK_READ_START(
+		 file_io_pool_entry,
+		 range_offset + (off64_t) compressed_data_offset,
+		 compressed_data_size );
+
+		read_count = libbfio_pool_read_buffer(
+		              file_io_pool,
+		              file_io_pool_entry,
+		              compressed_data,
+		              compressed_data_size,
+		              error );
+
+		LIBEWF_TRACE_CHUNK_READ_END(
+		 file_io_pool_entry,
+		 range_offset + (off64_t) compressed_data_offset,
+		 read_count );
+
+		if( read_count != (ssize_t) compressed_data_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk: %" PRIu64 " sub-blocks: %" PRIu32 " - %" PRIu32 ".",
+			 function,
+			 chunk_index,
+			 first_sub_block,
+			 last_sub_block );
+
+			goto on_error;
+		}
+		total_read_size += (size_t) read_count;
+
+		if( internal_handle->number_of_threads > 1 )
+		{
+			number_of_threads = internal_handle->number_of_threads;
+		}
+		result = libewf_parallel_deflate_decompress_sub_blocks(
+		          &sub_block_index,
+		          compressed_data,
+		          compressed_data_offset,
+		          compressed_data_size,
+		          first_sub_block,
+		          last_sub_block - first_sub_block + 1,
+		          uncompressed_data,
+		          &uncompressed_data_size,
+		          number_of_threads,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+			 "%s: unable to decompress chunk: %" PRIu64 " sub-blocks: %" PRIu32 " - %" PRIu32 ".",
+			 function,
+			 chunk_index,
+			 first_sub_block,
+			 last_sub_block );
+
+			goto on_error;
+		}
+		/* Sub-blocks that cannot be decompressed are handled by reading the entire chunk
+		 */
+		sub_block_data_offset = chunk_data_offset - ( (size_t) first_sub_block * sub_block_index.sub_block_size );
+
+		if( ( result != 0 )
+		 && ( uncompressed_data_size >= ( sub_block_data_offset + requested_size ) ) )
+		{
+			if( memory_copy(
+			     buffer,
+			     &( uncompressed_data[ sub_block_data_offset ] ),
+			     requested_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+			*read_size = requested_size;
+		}
+		else
+		{
+			result = 0;
+		}
+		memory_free(
+		 uncompressed_data );
+
+		uncompressed_data = NULL;
+
+		memory_free(
+		 compressed_data );
+
+		compressed_data = NULL;
+	}
+	memory_free(
+	 entries_data );
+
+	entries_data = NULL;
+
+	if( internal_handle->io_handle->statistics != NULL )
+	{
+		if( libewf_statistics_add_segment_file_read(
+		     internal_handle->io_handle->statistics,
+		     total_read_size,
+		     start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to add segment file read to statistics.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( result );
+
+on_error:
+	if( uncompressed_data != NULL )
+	{
+		memory_free(
+		 uncompressed_data );
+	}
+	if( compressed_data != NULL )
+	{
+		memory_free(
+		 compressed_data );
+	}
+	if( entries_data != NULL )
+	{
+		memory_free(
+		 entries_data );
+	}
+	return( -1 );
+}
+
+#endif /* ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) && defined( HAVE_ZLIB_INFLATE ) ) || defined( ZLIB_DLL ) */
+
+/* Adds a checksum error for the sectors of a specific chunk
+ * The chunk is remembered as corrupted so that subsequent reads are served
+ * from its unpacked chunk data without reading and unpacking it again
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_append_chunk_checksum_error(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error )
+{
+	static char *function      = "libewf_internal_handle_append_chunk_checksum_error";
+	uint64_t number_of_sectors = 0;
+	uint64_t start_sector      = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	start_sector      = chunk_index * internal_handle->media_values->sectors_per_chunk;
+	number_of_sectors = internal_handle->media_values->sectors_per_chunk;
+
+	if( ( start_sector + number_of_sectors ) > (uint64_t) internal_handle->media_values->number_of_sectors )
+	{
+		number_of_sectors = (uint64_t) internal_handle->media_values->number_of_sectors - start_sector;
+	}
+	if( libewf_chunk_table_append_checksum_error(
+	     internal_handle->chunk_table,
+	     start_sector,
+	     number_of_sectors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append checksum error.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_table_set_corrupted_chunk(
+	     internal_handle->chunk_table,
+	     chunk_index,
+	     chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set corrupted chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Creates the chunk cache if not already set
+ * The chunk cache is limited to the maximum cache size if set, otherwise to the default chunk cache size
+ * If a memory limit is set the chunk cache is limited to its share of the memory limit instead
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_initialize_chunk_cache(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	static char *function       = "libewf_internal_handle_initialize_chunk_cache";
+	size64_t maximum_cache_size = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_cache != NULL )
+	{
+		return( 1 );
+	}
+	maximum_cache_size = internal_handle->maximum_cache_size;
+
+	if( maximum_cache_size == 0 )
+	{
+		maximum_cache_size = LIBEWF_DEFAULT_CHUNK_CACHE_SIZE;
+	}
+	if( libewf_chunk_cache_initialize(
+	     &( internal_handle->chunk_cache ),
+	     LIBEWF_CHUNK_CACHE_NUMBER_OF_SHARDS,
+	     LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNK_CACHE_SHARD,
+	     maximum_cache_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_internal_handle_apply_memory_limit(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to apply memory limit.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the unpacked chunk data of a specific chunk for a concurrent read
+ * The chunk data is read while holding the write lock and unpacked after releasing it,
+ * so multiple threads can decompress chunks at the same time
+ * The caller takes over management of the chunk data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_get_concurrent_chunk_data(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *cached_chunk_data = NULL;
+	static char *function                  = "libewf_internal_handle_get_concurrent_chunk_data";
+	off64_t chunk_data_offset              = 0;
+	int result                             = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_internal_handle_read_packed_chunk_data(
+	          internal_handle,
+	          internal_handle->file_io_pool,
+	          chunk_index,
+	          chunk_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		/* Missing and sparse chunks are handled by the chunk table
+		 */
+		if( internal_handle->chunk_view_data != NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid handle - chunk view data set.",
+			 function );
+
+			goto on_error;
+		}
+		if( libewf_internal_handle_read_segment_files_to_offset(
+		     internal_handle,
+		     internal_handle->file_io_pool,
+		     (off64_t) chunk_index * internal_handle->media_values->chunk_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read segment files up to offset: %" PRIi64 ".",
+			 function,
+			 (off64_t) chunk_index * internal_handle->media_values->chunk_size );
+
+			goto on_error;
+		}
+		if( libewf_chunk_table_get_chunk_data_by_offset(
+		     internal_handle->chunk_table,
+		     chunk_index,
+		     internal_handle->io_handle,
+		     internal_handle->file_io_pool,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     internal_handle->chunk_groups_cache,
+		     internal_handle->chunks_cache,
+		     (off64_t) chunk_index * internal_handle->media_values->chunk_size,
+		     &cached_chunk_data,
+		     &chunk_data_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to read chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		if( libewf_chunk_data_clone(
+		     chunk_data,
+		     cached_chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to clone chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		goto on_error_unlocked;
+	}
+#endif
+	if( ( ( *chunk_data )->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) != 0 )
+	{
+		/* The chunk data is unpacked without holding the lock
+		 * hence the per handle compression context cannot be used
+		 */
+		if( libewf_chunk_data_unpack(
+		     *chunk_data,
+		     internal_handle->io_handle,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to unpack chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error_unlocked;
+		}
+		if( ( ( *chunk_data )->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+		{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+			if( libcthreads_read_write_lock_grab_for_write(
+			     internal_handle->read_write_lock,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to grab read/write lock for writing.",
+				 function );
+
+				goto on_error_unlocked;
+			}
+#endif
+			result = libewf_internal_handle_append_chunk_checksum_error(
+			          internal_handle,
+			          chunk_index,
+			          *chunk_data,
+			          error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+			if( libcthreads_read_write_lock_release_for_write(
+			     internal_handle->read_write_lock,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release read/write lock for writing.",
+				 function );
+
+				goto on_error_unlocked;
+			}
+#endif
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append checksum error.",
+				 function );
+
+				goto on_error_unlocked;
+			}
+		}
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+on_error_unlocked:
+	if( *chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads (media) data at a specific offset
+ * The read ahead state is provided by the caller, so that independent sequential
+ * readers, such as file entries, do not disrupt each other's read ahead.
+ * The read ahead does not extend beyond the maximum end chunk index
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_internal_handle_read_buffer_at_offset_concurrent(
+         libewf_internal_handle_t *internal_handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         uint64_t *read_ahead_next_chunk_index,
+         uint64_t maximum_end_chunk_index,
+         libcerror_error_t **error )
+{
+	libewf_chunk_cache_t *chunk_cache         = NULL;
+	libewf_chunk_data_t *chunk_data           = NULL;
+	static char *function                     = "libewf_internal_handle_read_buffer_at_offset_concurrent";
+	size64_t media_size                       = 0;
+	size_t buffer_offset                      = 0;
+	size_t chunk_data_offset                  = 0;
+	size_t read_size                          = 0;
+	ssize_t total_read_count                  = 0;
+	uint64_t advice_end_chunk_index           = 0;
+	uint64_t chunk_index                      = 0;
+	uint64_t first_chunk_index                = 0;
+	uint64_t key_prefix                       = 0;
+	uint32_t chunk_size                       = 0;
+	int advice                                = LIBEWF_ACCESS_ADVICE_NORMAL;
+	int is_sequential_read                    = 0;
+	int read_priority                         = LIBEWF_READ_PRIORITY_INTERACTIVE;
+	int result                                = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_ahead_next_chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read ahead next chunk index.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( internal_handle->media_values == NULL )
+	 || ( internal_handle->media_values->chunk_size == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		result = -1;
+	}
+	else if( internal_handle->write_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid handle - concurrent reads are only supported on read-only access.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		if( internal_handle->chunk_cache == NULL )
+		{
+			result = libewf_internal_handle_initialize_chunk_cache(
+			          internal_handle,
+			          error );
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create chunk cache.",
+				 function );
+			}
+		}
+		/* A reference to the chunk cache is held for the duration of the read,
+		 * since libewf_handle_share_chunk_cache can replace the chunk cache of the handle
+		 */
+		if( result != -1 )
+		{
+			result = libewf_chunk_cache_acquire(
+			          internal_handle->chunk_cache,
+			          error );
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to acquire chunk cache.",
+				 function );
+			}
+			else
+			{
+				chunk_cache = internal_handle->chunk_cache;
+			}
+		}
+		key_prefix    = internal_handle->chunk_cache_key_prefix;
+		chunk_size    = internal_handle->media_values->chunk_size;
+		media_size    = internal_handle->media_values->media_size;
+		read_priority = internal_handle->read_priority;
+
+		/* The advice of the first chunk of the read applies to the entire read
+		 */
+		if( ( result != -1 )
+		 && ( internal_handle->access_advice != NULL )
+		 && ( offset >= 0 ) )
+		{
+			result = libewf_access_advice_get_advice(
+			          internal_handle->access_advice,
+			          (uint64_t) offset / chunk_size,
+			          &advice,
+			          &advice_end_chunk_index,
+			          error );
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve access advice.",
+				 function );
+
+				result = -1;
+			}
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( result == -1 )
+	{
+		goto on_error;
+	}
+	if( (size64_t) offset >= media_size )
+	{
+		buffer_size = 0;
+	}
+	else if( (size64_t) buffer_size > ( media_size - offset ) )
+	{
+		buffer_size = (size_t) ( media_size - offset );
+	}
+	first_chunk_index = (uint64_t) offset / chunk_size;
+
+	while( buffer_size > 0 )
+	{
+		chunk_index       = (uint64_t) offset / chunk_size;
+		chunk_data_offset = (size_t) ( (uint64_t) offset % chunk_size );
+
+		result = libewf_chunk_cache_copy_data(
+		          chunk_cache,
+		          key_prefix | chunk_index,
+		          chunk_data_offset,
+		          &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+		          buffer_size,
+		          &read_size,
+		          read_priority,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to copy chunk: %" PRIu64 " data from chunk cache.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			if( libewf_internal_handle_get_concurrent_chunk_data(
+			     internal_handle,
+			     chunk_index,
+			     &chunk_data,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to read chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+			read_size = 0;
+
+			if( chunk_data_offset < chunk_data->data_size )
+			{
+				read_size = chunk_data->data_size - chunk_data_offset;
+
+				if( read_size > buffer_size )
+				{
+					read_size = buffer_size;
+				}
+				if( memory_copy(
+				     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+				     &( ( chunk_data->data )[ chunk_data_offset ] ),
+				     read_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
+					 function,
+					 chunk_index );
+
+					goto on_error;
+				}
+			}
+			if( advice == LIBEWF_ACCESS_ADVICE_DONTNEED )
+			{
+				if( libewf_chunk_data_free(
+				     &chunk_data,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free chunk: %" PRIu64 " data.",
+					 function,
+					 chunk_index );
+
+					goto on_error;
+				}
+			}
+			else
+			{
+				if( libewf_chunk_cache_set_chunk_data(
+				     chunk_cache,
+				     key_prefix | chunk_index,
+				     chunk_data,
+				     read_priority,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set chunk: %" PRIu64 " data in chunk cache.",
+					 function,
+					 chunk_index );
+
+					goto on_error;
+				}
+				/* The chunk cache takes over management of chunk_data
+				 */
+				chunk_data = NULL;
+			}
+		}
+		if( read_size == 0 )
+		{
+			break;
+		}
+		buffer_offset    += read_size;
+		buffer_size      -= read_size;
+		total_read_count += (ssize_t) read_size;
+		offset           += (off64_t) read_size;
+
+		if( internal_handle->io_handle->abort != 0 )
+		{
+			break;
+		}
+	}
+	if( ( total_read_count > 0 )
+	 && ( ( internal_handle->number_of_read_ahead_chunks > 0 )
+	  || ( internal_handle->segment_prefetch_size > 0 )
+	  || ( internal_handle->chunk_access_map != NULL ) ) )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_grab_for_write(
+		     internal_handle->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for writing.",
+			 function );
+
+			goto on_error;
+		}
+#endif
+		chunk_index = (uint64_t) offset / chunk_size;
+		result      = 1;
+
+		if( internal_handle->chunk_access_map != NULL )
+		{
+			result = libewf_chunk_access_map_set_chunk_range(
+			          internal_handle->chunk_access_map,
+			          first_chunk_index,
+			          ( (uint64_t) ( offset - 1 ) / chunk_size ) - first_chunk_index + 1,
+			          error );
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to record chunk access.",
+				 function );
+			}
+		}
+		/* The read is considered sequential if it starts in the chunk that was last read
+		 * or in the chunk that directly follows it, unless advised otherwise
+		 */
+		if( advice == LIBEWF_ACCESS_ADVICE_SEQUENTIAL )
+		{
+			is_sequential_read = 1;
+
+			if( advice_end_chunk_index < maximum_end_chunk_index )
+			{
+				maximum_end_chunk_index = advice_end_chunk_index;
+			}
+		}
+		else if( ( advice != LIBEWF_ACCESS_ADVICE_RANDOM )
+		      && ( first_chunk_index <= *read_ahead_next_chunk_index )
+		      && ( ( first_chunk_index + 1 ) >= *read_ahead_next_chunk_index ) )
+		{
+			is_sequential_read = 1;
+		}
+		if( ( result == 1 )
+		 && ( is_sequential_read != 0 ) )
+		{
+			result = libewf_internal_handle_read_ahead_signal(
+			          internal_handle,
+			          chunk_index,
+			          maximum_end_chunk_index,
+			          error );
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to signal read ahead.",
+				 function );
+			}
+			else
+			{
+				result = libewf_internal_handle_prefetch_segment_signal(
+				          internal_handle,
+				          offset,
+				          error );
+
+				if( result != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to signal segment prefetch.",
+					 function );
+				}
+			}
+		}
+		*read_ahead_next_chunk_index = chunk_index;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_release_for_write(
+		     internal_handle->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for writing.",
+			 function );
+
+			goto on_error;
+		}
+#endif
+		if( result != 1 )
+		{
+			goto on_error;
+		}
+	}
+	if( libewf_chunk_cache_release(
+	     &chunk_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to release chunk cache.",
+		 function );
+
+		goto on_error;
+	}
+	return( total_read_count );
+
+on_error:
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	if( chunk_cache != NULL )
+	{
+		libewf_chunk_cache_release(
+		 &chunk_cache,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads (media) data at a specific offset
+ * Unlike libewf_handle_read_buffer_at_offset this function does not change
+ * the current offset and can be called by multiple threads at the same time.
+ * Chunks are decompressed outside the handle lock and cached in a sharded chunk cache
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_handle_read_buffer_at_offset_concurrent(
+         libewf_handle_t *handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_read_buffer_at_offset_concurrent";
+	ssize_t read_count                        = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	uint8_t is_interactive_read               = 0;
+	int result                                = 0;
+#endif
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_internal_handle_begin_interactive_read(
+	          internal_handle,
+	          &is_interactive_read,
+	          error );
+
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		result = -1;
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to begin interactive read.",
+		 function );
+
+		libewf_internal_handle_end_interactive_read(
+		 internal_handle,
+		 is_interactive_read,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	read_count = libewf_internal_handle_read_buffer_at_offset_concurrent(
+	              internal_handle,
+	              buffer,
+	              buffer_size,
+	              offset,
+	              &( internal_handle->read_ahead_next_chunk_index ),
+	              UINT64_MAX,
+	              error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libewf_internal_handle_end_interactive_read(
+	     internal_handle,
+	     is_interactive_read,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to end interactive read.",
+		 function );
+
+		read_count = -1;
+	}
+#endif
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+/* Reads (media) data at a specific offset asynchronously
+ * The read is queued and processed by a pool of worker threads using the concurrent read path,
+ * when the read completes the callback is called on the worker thread with the number of bytes read,
+ * or -1 and the error. The error is freed after the callback returns
+ * The buffer must remain valid until the callback was called
+ * If the queue of pending reads is full this function waits until a read completes
+ * Pending reads are completed when the handle is closed
+ * Without multi-threading support the read is processed, and the callback is called, before this function returns
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_read_buffer_at_offset_async(
+     libewf_handle_t *handle,
+     void *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     void (*callback)(
+            void *callback_data,
+            ssize_t read_count,
+            libcerror_error_t *error ),
+     void *callback_data,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	libewf_read_request_t *read_request       = NULL;
+	static char *function                     = "libewf_handle_read_buffer_at_offset_async";
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_thread_pool_t *thread_pool    = NULL;
+	int number_of_threads                     = 0;
+	int result                                = 1;
+#endif
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_read_request_initialize(
+	     &read_request,
+	     handle,
+	     (uint8_t *) buffer,
+	     buffer_size,
+	     offset,
+	     callback,
+	     callback_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read request.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+	if( internal_handle->write_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid handle - asynchronous reads are only supported on read-only access.",
+		 function );
+
+		result = -1;
+	}
+	else if( internal_handle->read_requests_thread_pool == NULL )
+	{
+		number_of_threads = internal_handle->number_of_threads;
+
+		if( number_of_threads <= 1 )
+		{
+			number_of_threads = LIBEWF_DEFAULT_NUMBER_OF_READ_REQUEST_THREADS;
+		}
+		if( libcthreads_thread_pool_create(
+		     &( internal_handle->read_requests_thread_pool ),
+		     NULL,
+		     number_of_threads,
+		     LIBEWF_MAXIMUM_NUMBER_OF_QUEUED_READ_REQUESTS,
+		     (int (*)(intptr_t *, void *)) &libewf_read_request_process_callback,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create read requests thread pool.",
+			 function );
+
+			result = -1;
+		}
+	}
+	thread_pool = internal_handle->read_requests_thread_pool;
+
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	/* The read request is pushed without holding the lock, since pushing waits
+	 * if the queue is full and the worker threads need the lock to read
+	 */
+	if( libcthreads_thread_pool_push(
+	     thread_pool,
+	     (intptr_t *) read_request,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push read request onto thread pool queue.",
+		 function );
+
+		goto on_error;
+	}
+#else
+	if( libewf_read_request_process(
+	     read_request,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to process read request.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_read_request_free(
+	     &read_request,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free read request.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( read_request != NULL )
+	{
+		libewf_read_request_free(
+		 &read_request,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Completes the pending asynchronous read requests and stops their worker threads
+ * This function must be called without holding the read/write lock
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_read_requests_stop(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_read_requests_stop";
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->read_requests_thread_pool == NULL )
+	{
+		return( 1 );
+	}
+	if( libcthreads_thread_pool_join(
+	     &( internal_handle->read_requests_thread_pool ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join read requests thread pool.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* Shares the chunk cache of a source handle
+ * Both handles must be opened read-only, afterwards reads of either handle are served from
+ * and stored in the same chunk cache. If the handles are opened on the same set of segment files
+ * they share the cached chunks, otherwise the chunks of the handle are cached in a separate namespace
+ * so that handles on different images share the maximum cache size of the chunk cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_share_chunk_cache(
+     libewf_handle_t *handle,
+     libewf_handle_t *source_handle,
+     libcerror_error_t **error )
+{
+	uint8_t set_identifier[ 16 ];
+
+	libewf_chunk_cache_t *chunk_cache                = NULL;
+	libewf_internal_handle_t *internal_handle        = NULL;
+	libewf_internal_handle_t *internal_source_handle = NULL;
+	static char *function                            = "libewf_handle_share_chunk_cache";
+	size64_t media_size                              = 0;
+	uint64_t key_prefix                              = 0;
+	size32_t chunk_size                              = 0;
+	int result                                       = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( source_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_source_handle = (libewf_internal_handle_t *) source_handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_source_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab source read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_source_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid source handle - missing file IO pool.",
+		 function );
+
+		result = -1;
+	}
+	else if( ( internal_source_handle->media_values == NULL )
+	      || ( internal_source_handle->media_values->chunk_size == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid source handle - invalid media values - missing chunk size.",
+		 function );
+
+		result = -1;
+	}
+	else if( internal_source_handle->write_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid source handle - sharing the chunk cache is only supported on read-only access.",
+		 function );
+
+		result = -1;
+	}
+	else if( libewf_internal_handle_initialize_chunk_cache(
+	          internal_source_handle,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create source chunk cache.",
+		 function );
+
+		result = -1;
+	}
+	else if( libewf_chunk_cache_acquire(
+	          internal_source_handle->chunk_cache,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to acquire source chunk cache.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		chunk_cache = internal_source_handle->chunk_cache;
+		key_prefix  = internal_source_handle->chunk_cache_key_prefix;
+		chunk_size  = internal_source_handle->media_values->chunk_size;
+		media_size  = internal_source_handle->media_values->media_size;
+
+		if( memory_copy(
+		     set_identifier,
+		     internal_source_handle->media_values->set_identifier,
+		     16 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy set identifier.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_source_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release source read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( result == -1 )
+	{
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		result = -1;
+	}
+	else if( ( internal_handle->media_values == NULL )
+	      || ( internal_handle->media_values->chunk_size == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		result = -1;
+	}
+	else if( internal_handle->write_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid handle - sharing the chunk cache is only supported on read-only access.",
+		 function );
+
+		result = -1;
+	}
+	else if( ( ( internal_handle->media_values->chunk_size != chunk_size )
+	        || ( internal_handle->media_values->media_size != media_size )
+	        || ( memory_compare(
+	              internal_handle->media_values->set_identifier,
+	              set_identifier,
+	              16 ) != 0 ) )
+	      && ( libewf_chunk_cache_get_new_namespace(
+	            chunk_cache,
+	            &key_prefix,
+	            error ) != 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve new namespace from chunk cache.",
+		 function );
+
+		result = -1;
+	}
+	else if( libewf_chunk_cache_release(
+	          &( internal_handle->chunk_cache ),
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to release chunk cache.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		internal_handle->chunk_cache            = chunk_cache;
+		internal_handle->chunk_cache_key_prefix = key_prefix;
+
+		chunk_cache = NULL;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( result == -1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( chunk_cache != NULL )
+	{
+		libewf_chunk_cache_release(
+		 &chunk_cache,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Sets the maximum size of the chunk cache in bytes
+ * The chunk cache is created if needed, when it is shared the maximum size applies
+ * to all the handles that share it
+ * The handle must be opened read-only
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_maximum_chunk_cache_size(
+     libewf_handle_t *handle,
+     size64_t maximum_chunk_cache_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_maximum_chunk_cache_size";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( maximum_chunk_cache_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum chunk cache size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		result = -1;
+	}
+	else if( ( internal_handle->media_values == NULL )
+	      || ( internal_handle->media_values->chunk_size == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		result = -1;
+	}
+	else if( internal_handle->write_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid handle - the chunk cache is only supported on read-only access.",
+		 function );
+
+		result = -1;
+	}
+	else if( libewf_internal_handle_initialize_chunk_cache(
+	          internal_handle,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk cache.",
+		 function );
+
+		result = -1;
+	}
+	else if( libewf_chunk_cache_set_maximum_cache_size(
+	          internal_handle->chunk_cache,
+	          maximum_chunk_cache_size,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk cache maximum cache size.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Shares the maximum number of open handles of a source handle
+ * Afterwards the segment files of both handles are bounded by a single maximum number
+ * of open handles, that is distributed over the handles based on their number of segment files.
+ * The maximum number of open handles of the source handle must be set
+ * A handle stops sharing the maximum number of open handles when it is closed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_share_maximum_number_of_open_handles(
+     libewf_handle_t *handle,
+     libewf_handle_t *source_handle,
+     libcerror_error_t **error )
+{
+	libewf_file_io_pool_group_t *file_io_pool_group  = NULL;
+	libewf_internal_handle_t *internal_handle        = NULL;
+	libewf_internal_handle_t *internal_source_handle = NULL;
+	static char *function                            = "libewf_handle_share_maximum_number_of_open_handles";
+	int result                                       = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( source_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_source_handle = (libewf_internal_handle_t *) source_handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_source_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab source read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_source_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid source handle - missing file IO pool.",
+		 function );
+
+		result = -1;
+	}
+	else if( internal_source_handle->file_io_pool_group == NULL )
+	{
+		if( internal_source_handle->maximum_number_of_open_handles == LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid source handle - missing maximum number of open handles.",
+			 function );
+
+			result = -1;
+		}
+		else if( libewf_file_io_pool_group_initialize(
+		          &( internal_source_handle->file_io_pool_group ),
+		          internal_source_handle->maximum_number_of_open_handles,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create source file IO pool group.",
+			 function );
+
+			result = -1;
+		}
+		else if( libewf_file_io_pool_group_append_file_io_pool(
+		          internal_source_handle->file_io_pool_group,
+		          internal_source_handle->file_io_pool,
+		          error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append source file IO pool to group.",
+			 function );
+
+			libewf_file_io_pool_group_release(
+			 &( internal_source_handle->file_io_pool_group ),
+			 NULL );
+
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		if( libewf_file_io_pool_group_acquire(
+		     internal_source_handle->file_io_pool_group,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to acquire source file IO pool group.",
+			 function );
+
+			result = -1;
+		}
+		else
+		{
+			file_io_pool_group = internal_source_handle->file_io_pool_group;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_source_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release source read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( result == -1 )
+	{
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		result = -1;
+	}
+	else if( internal_handle->file_io_pool_group != file_io_pool_group )
+	{
+		if( internal_handle->file_io_pool_group != NULL )
+		{
+			if( libewf_file_io_pool_group_remove_file_io_pool(
+			     internal_handle->file_io_pool_group,
+			     internal_handle->file_io_pool,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+				 "%s: unable to remove file IO pool from group.",
+				 function );
+
+				result = -1;
+			}
+			else if( libewf_file_io_pool_group_release(
+			          &( internal_handle->file_io_pool_group ),
+			          error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to release file IO pool group.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( result == 1 )
+		{
+			if( libewf_file_io_pool_group_append_file_io_pool(
+			     file_io_pool_group,
+			     internal_handle->file_io_pool,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append file IO pool to group.",
+				 function );
+
+				result = -1;
+			}
+			else
+			{
+				internal_handle->file_io_pool_group = file_io_pool_group;
+
+				file_io_pool_group = NULL;
+			}
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( result == -1 )
+	{
+		goto on_error;
+	}
+	/* The handle already shared the file IO pool group of the source handle
+	 */
+	if( file_io_pool_group != NULL )
+	{
+		if( libewf_file_io_pool_group_release(
+		     &file_io_pool_group,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to release file IO pool group.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( file_io_pool_group != NULL )
+	{
+		libewf_file_io_pool_group_release(
+		 &file_io_pool_group,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves a specific statistic value
+ * The statistic values are counted from when the handle was created or the statistics were reset
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_statistics_value(
+     libewf_handle_t *handle,
+     int statistic_type,
+     uint64_t *value,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_statistics_value";
+	uint64_t memory_size                      = 0;
+	uint64_t number_of_evictions              = 0;
+	uint64_t number_of_hits                   = 0;
+	uint64_t number_of_misses                 = 0;
+	uint64_t peak_memory_size                 = 0;
+	size64_t memory_usage                     = 0;
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( statistic_type == LIBEWF_STATISTIC_CHUNK_CACHE_HITS )
+	 || ( statistic_type == LIBEWF_STATISTIC_CHUNK_CACHE_MISSES )
+	 || ( statistic_type == LIBEWF_STATISTIC_CHUNK_CACHE_EVICTIONS ) )
+	{
+		/* The chunk cache is only created when it is used
+		 */
+		if( internal_handle->chunk_cache != NULL )
+		{
+			if( libewf_chunk_cache_get_counters(
+			     internal_handle->chunk_cache,
+			     &number_of_hits,
+			     &number_of_misses,
+			     &number_of_evictions,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve chunk cache counters.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( statistic_type == LIBEWF_STATISTIC_CHUNK_CACHE_HITS )
+		{
+			*value = number_of_hits;
+		}
+		else if( statistic_type == LIBEWF_STATISTIC_CHUNK_CACHE_MISSES )
+		{
+			*value = number_of_misses;
+		}
+		else
+		{
+			*value = number_of_evictions;
+		}
+	}
+	else if( statistic_type == LIBEWF_STATISTIC_MEMORY_LIMIT )
+	{
+		*value = (uint64_t) internal_handle->memory_limit;
+	}
+	else if( statistic_type == LIBEWF_STATISTIC_MEMORY_USAGE )
+	{
+		result = libewf_internal_handle_get_memory_usage(
+		          internal_handle,
+		          &memory_usage,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve memory usage.",
+			 function );
+		}
+		else
+		{
+			*value = (uint64_t) memory_usage;
+		}
+	}
+	else if( ( statistic_type >= LIBEWF_STATISTIC_CHUNK_DATA_MEMORY_SIZE )
+	      && ( statistic_type <= LIBEWF_STATISTIC_HEADER_VALUES_PEAK_MEMORY_SIZE ) )
+	{
+		/* The statistic types are ordered as the memory types with the current size followed by the peak size
+		 */
+		result = libewf_memory_accounting_get_size(
+		          ( statistic_type - LIBEWF_STATISTIC_CHUNK_DATA_MEMORY_SIZE ) / 2,
+		          &memory_size,
+		          &peak_memory_size,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve memory size.",
+			 function );
+		}
+		else if( ( ( statistic_type - LIBEWF_STATISTIC_CHUNK_DATA_MEMORY_SIZE ) % 2 ) == 0 )
+		{
+			*value = memory_size;
+		}
+		else
+		{
+			*value = peak_memory_size;
+		}
+	}
+	else
+	{
+		result = libewf_statistics_get_value(
+		          internal_handle->io_handle->statistics,
+		          statistic_type,
+		          value,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve statistic value.",
+			 function );
+		}
+		else if( result == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported statistic type: %d.",
+			 function,
+			 statistic_type );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Resets the statistics
+ * A chunk cache that is shared with other handles is reset for all these handles
+ * The peak memory sizes are process wide and are reset to the current memory sizes
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_reset_statistics(
+     libewf_handle_t *handle,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_reset_statistics";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	libewf_memory_accounting_reset_peak_sizes();
+
+	if( libewf_statistics_reset(
+	     internal_handle->io_handle->statistics,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to reset statistics.",
+		 function );
+
+		result = -1;
+	}
+	else if( internal_handle->chunk_cache != NULL )
+	{
+		if( libewf_chunk_cache_reset_counters(
+		     internal_handle->chunk_cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to reset chunk cache counters.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Opens a segment index file
+ * The segment index is used by the next open to skip reading the section list
+ * and chunk groups of the segment files it describes
+ * Returns 1 if successful, 0 if the file does not contain a valid segment index or -1 on error
+ */
+int libewf_handle_open_segment_index(
+     libewf_handle_t *handle,
+     const char *filename,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libewf_handle_open_segment_index";
+	size_t filename_length           = 0;
+	int result                       = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = narrow_string_length(
+	                   filename );
+
+	if( filename_length == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	result = libbfio_handle_exists(
+	          file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to determine if segment index file exists.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		result = libewf_handle_open_segment_index_file_io_handle(
+		          handle,
+		          file_io_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open segment index: %s.",
+			 function,
+			 filename );
+
+			goto on_error;
+		}
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Opens a segment index file
+ * The segment index is used by the next open to skip reading the section list
+ * and chunk groups of the segment files it describes
+ * Returns 1 if successful, 0 if the file does not contain a valid segment index or -1 on error
+ */
+int libewf_handle_open_segment_index_wide(
+     libewf_handle_t *handle,
+     const wchar_t *filename,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libewf_handle_open_segment_index_wide";
+	size_t filename_length           = 0;
+	int result                       = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = wide_string_length(
+	                   filename );
+
+	if( filename_length == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_set_name_wide(
+	     file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	result = libbfio_handle_exists(
+	          file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to determine if segment index file exists.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		result = libewf_handle_open_segment_index_file_io_handle(
+		          handle,
+		          file_io_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open segment index: %ls.",
+			 function,
+			 filename );
+
+			goto on_error;
+		}
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Opens a segment index using a Basic File IO (bfio) handle
+ * The segment index is used by the next open to skip reading the section list
+ * and chunk groups of the segment files it describes
+ * Returns 1 if successful, 0 if the file does not contain a valid segment index or -1 on error
+ */
+int libewf_handle_open_segment_index_file_io_handle(
+     libewf_handle_t *handle,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	libewf_segment_index_t *segment_index     = NULL;
+	static char *function                     = "libewf_handle_open_segment_index_file_io_handle";
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - file IO pool already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_segment_index_initialize(
+	     &segment_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment index.",
+		 function );
+
+		goto on_error;
+	}
+	result = libewf_segment_index_read_file_io_handle(
+	          segment_index,
+	          file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read segment index.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( internal_handle->segment_index != NULL )
+	{
+		if( libewf_segment_index_free(
+		     &( internal_handle->segment_index ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free segment index.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		internal_handle->segment_index = segment_index;
+
+		segment_index = NULL;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( result == -1 )
+	{
+		goto on_error;
+	}
+	if( segment_index != NULL )
+	{
+		if( libewf_segment_index_free(
+		     &segment_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free segment index.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( result );
+
+on_error:
+	if( segment_index != NULL )
+	{
+		libewf_segment_index_free(
+		 &segment_index,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves a segment index of the segment files of an opened handle
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_get_segment_index(
+     libewf_internal_handle_t *internal_handle,
+     libewf_segment_index_t **segment_index,
+     libcerror_error_t **error )
+{
+	libewf_segment_file_t *segment_file        = NULL;
+	libewf_segment_index_t *safe_segment_index = NULL;
+	uint8_t *entry_data                        = NULL;
+	static char *function                      = "libewf_internal_handle_get_segment_index";
+	size64_t segment_file_size                 = 0;
+	size_t entry_data_size                     = 0;
+	uint32_t number_of_segments                = 0;
+	uint32_t segment_number                    = 0;
+	int file_io_pool_entry                     = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid handle - segment index is only supported on read-only access.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment index.",
+		 function );
+
+		return( -1 );
+	}
+	/* Make sure all the segment files have been read when opened with the lazy access flag
+	 */
+	if( libewf_internal_handle_read_segment_files_to_offset(
+	     internal_handle,
+	     internal_handle->file_io_pool,
+	     (off64_t) INT64_MAX,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read segment files.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_segment_table_get_number_of_segments(
+	     internal_handle->segment_table,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments from segment table.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_segment_index_initialize(
+	     &safe_segment_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment index.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_segment_index_set_number_of_segments(
+	     safe_segment_index,
+	     number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set number of segments in segment index.",
+		 function );
+
+		goto on_error;
+	}
+	safe_segment_index->chunk_size = internal_handle->media_values->chunk_size;
+
+	for( segment_number = 0;
+	     segment_number < number_of_segments;
+	     segment_number++ )
+	{
+		if( libewf_segment_table_get_segment_by_index(
+		     internal_handle->segment_table,
+		     segment_number,
+		     &file_io_pool_entry,
+		     &segment_file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
+			 function,
+			 segment_number );
+
+			goto on_error;
+		}
+		if( libewf_segment_table_get_segment_file_by_index(
+		     internal_handle->segment_table,
+		     segment_number,
+		     internal_handle->file_io_pool,
+		     &segment_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
+			 function,
+			 segment_number );
+
+			goto on_error;
+		}
+		if( libewf_segment_file_get_index_entry_data(
+		     segment_file,
+		     segment_file_size,
+		     &entry_data,
+		     &entry_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file: %" PRIu32 " index entry data.",
+			 function,
+			 segment_number );
+
+			goto on_error;
+		}
+		if( libewf_segment_index_set_entry_data(
+		     safe_segment_index,
+		     segment_number + 1,
+		     entry_data,
+		     entry_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set segment file: %" PRIu32 " index entry data.",
+			 function,
+			 segment_number );
+
+			goto on_error;
+		}
+		entry_data = NULL;
+	}
+	*segment_index = safe_segment_index;
+
+	return( 1 );
+
+on_error:
+	if( entry_data != NULL )
+	{
+		memory_free(
+		 entry_data );
+	}
+	if( safe_segment_index != NULL )
+	{
+		libewf_segment_index_free(
+		 &safe_segment_index,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes a segment index file of the segment files of an opened handle
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_write_segment_index(
+     libewf_handle_t *handle,
+     const char *filename,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libewf_handle_write_segment_index";
+	size_t filename_length           = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = narrow_string_length(
+	                   filename );
+
+	if( filename_length == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_write_segment_index_file_io_handle(
+	     handle,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write segment index: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Writes a segment index file of the segment files of an opened handle
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_write_segment_index_wide(
+     libewf_handle_t *handle,
+     const wchar_t *filename,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libewf_handle_write_segment_index_wide";
+	size_t filename_length           = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = wide_string_length(
+	                   filename );
+
+	if( filename_length == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_set_name_wide(
+	     file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_write_segment_index_file_io_handle(
+	     handle,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write segment index: %ls.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Writes a segment index of the segment files of an opened handle using a Basic File IO (bfio) handle
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_write_segment_index_file_io_handle(
+     libewf_handle_t *handle,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	libewf_segment_index_t *segment_index     = NULL;
+	static char *function                     = "libewf_handle_write_segment_index_file_io_handle";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_internal_handle_get_segment_index(
+	          internal_handle,
+	          &segment_index,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment index.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( result == -1 )
+	{
+		goto on_error;
+	}
+	if( libewf_segment_index_write_file_io_handle(
+	     segment_index,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write segment index.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_segment_index_free(
+	     &segment_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free segment index.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( segment_index != NULL )
+	{
+		libewf_segment_index_free(
+		 &segment_index,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Opens a disk chunk cache
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_open_disk_chunk_cache(
+     libewf_internal_handle_t *internal_handle,
+     const char *filename,
+     size_t filename_length,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error )
+{
+	libewf_disk_chunk_cache_t *disk_chunk_cache = NULL;
+	static char *function                       = "libewf_internal_handle_open_disk_chunk_cache";
+	size64_t segment_file_size                  = 0;
+	uint32_t number_of_segments                 = 0;
+	uint32_t segment_number                     = 0;
+	int file_io_pool_entry                      = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	/* The chunks in the cache file are only valid as long as the segment files do not change
+	 */
+	if( internal_handle->write_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid handle - disk chunk cache only supported on read-only access.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_disk_chunk_cache_initialize(
+	     &disk_chunk_cache,
+	     internal_handle->media_values->chunk_size,
+	     maximum_cache_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create disk chunk cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_segment_table_get_number_of_segments(
+	     internal_handle->segment_table,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
+		 function );
+
+		goto on_error;
+	}
+	for( segment_number = 0;
+	     segment_number < number_of_segments;
+	     segment_number++ )
+	{
+		if( libewf_segment_table_get_segment_by_index(
+		     internal_handle->segment_table,
+		     segment_number,
+		     &file_io_pool_entry,
+		     &segment_file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
+			 function,
+			 segment_number );
+
+			goto on_error;
+		}
+		if( libewf_disk_chunk_cache_set_segment_number(
+		     disk_chunk_cache,
+		     file_io_pool_entry,
+		     segment_number + 1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set segment number of file IO pool entry: %d.",
+			 function,
+			 file_io_pool_entry );
+
+			goto on_error;
+		}
+	}
+	if( libewf_disk_chunk_cache_open(
+	     disk_chunk_cache,
+	     filename,
+	     filename_length,
+	     internal_handle->media_values->set_identifier,
+	     16,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open disk chunk cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( internal_handle->disk_chunk_cache != NULL )
+	{
+		internal_handle->io_handle->disk_chunk_cache = NULL;
+
+		if( libewf_disk_chunk_cache_free(
+		     &( internal_handle->disk_chunk_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free disk chunk cache.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	internal_handle->disk_chunk_cache            = disk_chunk_cache;
+	internal_handle->io_handle->disk_chunk_cache = disk_chunk_cache;
+
+	return( 1 );
+
+on_error:
+	if( disk_chunk_cache != NULL )
+	{
+		libewf_disk_chunk_cache_free(
+		 &disk_chunk_cache,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Opens a disk chunk cache
+ * The disk chunk cache is a persistent second level cache of unpacked chunk data
+ * in a local cache file, that is consulted when chunk data is not in the chunks cache,
+ * so that repeated analysis of the same segment files does not need to read and
+ * unpack the same chunks from the segment files again
+ * The cache file is bound to the segment file set identifier and its entries
+ * are discarded when it is opened for another segment file set.
+ * The size of the cache file is bounded by the maximum cache size
+ * where the least recently used chunk is evicted first
+ * The handle must be opened read-only, the disk chunk cache is closed on close
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_open_disk_chunk_cache(
+     libewf_handle_t *handle,
+     const char *filename,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_open_disk_chunk_cache";
+	size_t filename_length                    = 0;
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = narrow_string_length(
+	                   filename );
+
+	if( filename_length == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libewf_internal_handle_open_disk_chunk_cache(
+	     internal_handle,
+	     filename,
+	     filename_length,
+	     maximum_cache_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open disk chunk cache: %s.",
+		 function,
+		 filename );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Opens a shared chunk cache
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_open_shared_chunk_cache(
+     libewf_internal_handle_t *internal_handle,
+     const char *name,
+     size_t name_length,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error )
+{
+	libewf_shared_chunk_cache_t *shared_chunk_cache = NULL;
+	static char *function                           = "libewf_internal_handle_open_shared_chunk_cache";
+	size64_t segment_file_size                      = 0;
+	uint32_t number_of_segments                     = 0;
+	uint32_t segment_number                         = 0;
+	uint8_t byte_index                              = 0;
+	int file_io_pool_entry                          = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	/* The chunks in the shared memory are only valid as long as the segment files do not change
+	 */
+	if( internal_handle->write_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid handle - shared chunk cache only supported on read-only access.",
+		 function );
+
+		return( -1 );
+	}
+	/* The chunks of different segment file sets in the shared memory are distinguished
+	 * by the set identifier, hence a segment file set without one is not supported
+	 */
+	for( byte_index = 0;
+	     byte_index < 16;
+	     byte_index++ )
+	{
+		if( internal_handle->media_values->set_identifier[ byte_index ] != 0 )
+		{
+			break;
+		}
+	}
+	if( byte_index >= 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid handle - shared chunk cache not supported without set identifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_shared_chunk_cache_initialize(
+	     &shared_chunk_cache,
+	     internal_handle->media_values->chunk_size,
+	     maximum_cache_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create shared chunk cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_segment_table_get_number_of_segments(
+	     internal_handle->segment_table,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
+		 function );
+
+		goto on_error;
+	}
+	for( segment_number = 0;
+	     segment_number < number_of_segments;
+	     segment_number++ )
+	{
+		if( libewf_segment_table_get_segment_by_index(
+		     internal_handle->segment_table,
+		     segment_number,
+		     &file_io_pool_entry,
+		     &segment_file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
+			 function,
+			 segment_number );
+
+			goto on_error;
+		}
+		if( libewf_shared_chunk_cache_set_segment_number(
+		     shared_chunk_cache,
+		     file_io_pool_entry,
+		     segment_number + 1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set segment number of file IO pool entry: %d.",
+			 function,
+			 file_io_pool_entry );
+
+			goto on_error;
+		}
+	}
+	if( libewf_shared_chunk_cache_open(
+	     shared_chunk_cache,
+	     name,
+	     name_length,
+	     internal_handle->media_values->set_identifier,
+	     16,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open shared chunk cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( internal_handle->shared_chunk_cache != NULL )
+	{
+		internal_handle->io_handle->shared_chunk_cache = NULL;
+
+		if( libewf_shared_chunk_cache_free(
+		     &( internal_handle->shared_chunk_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free shared chunk cache.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	internal_handle->shared_chunk_cache            = shared_chunk_cache;
+	internal_handle->io_handle->shared_chunk_cache = shared_chunk_cache;
+
+	return( 1 );
+
+on_error:
+	if( shared_chunk_cache != NULL )
+	{
+		libewf_shared_chunk_cache_free(
+		 &shared_chunk_cache,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Opens (attaches to) a shared chunk cache
+ * The shared chunk cache is a second level cache of unpacked chunk data in a named
+ * shared memory object, that is consulted when chunk data is not in the chunks cache,
+ * so that multiple processes on the same host that read the same segment file set
+ * only need to read and unpack a chunk once
+ * The name is a POSIX shared memory object name, e.g. "/libewf_chunk_cache", that
+ * can be shared by processes that read different segment file sets. The shared memory
+ * is created with the maximum cache size by the first process that opens it and is
+ * retained until it is removed, e.g. by shm_unlink, or the system is restarted.
+ * The shared memory is only accessible by processes of the same user
+ * The handle must be opened read-only and the segment file set must have a set identifier,
+ * the shared chunk cache is closed on close
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_open_shared_chunk_cache(
+     libewf_handle_t *handle,
+     const char *name,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_open_shared_chunk_cache";
+	size_t name_length                        = 0;
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	name_length = narrow_string_length(
+	               name );
+
+	if( name_length == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libewf_internal_handle_open_shared_chunk_cache(
+	     internal_handle,
+	     name,
+	     name_length,
+	     maximum_cache_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open shared chunk cache: %s.",
+		 function,
+		 name );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Starts recording the chunks that are read
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_start_chunk_access_recording(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	libewf_chunk_access_map_t *chunk_access_map = NULL;
+	static char *function                       = "libewf_internal_handle_start_chunk_access_recording";
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_access_map_initialize(
+	     &chunk_access_map,
+	     internal_handle->media_values->number_of_chunks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk access map.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_access_map != NULL )
+	{
+		if( libewf_chunk_access_map_free(
+		     &( internal_handle->chunk_access_map ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk access map.",
+			 function );
+
+			libewf_chunk_access_map_free(
+			 &chunk_access_map,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	internal_handle->chunk_access_map = chunk_access_map;
+
+	return( 1 );
+}
+
+/* Starts recording the chunks that are read
+ * The chunks are recorded in a chunk access map of a bit per chunk, which can
+ * be written to a file with libewf_handle_write_chunk_access_map
+ * Chunks that were recorded before are discarded, recording stops on close
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_start_chunk_access_recording(
+     libewf_handle_t *handle,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_start_chunk_access_recording";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libewf_internal_handle_start_chunk_access_recording(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to start chunk access recording.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Writes the recorded chunk access map to a file
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_write_chunk_access_map(
+     libewf_internal_handle_t *internal_handle,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_write_chunk_access_map";
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_access_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing chunk access map.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_access_map_write_file(
+	     internal_handle->chunk_access_map,
+	     filename,
+	     filename_length,
+	     internal_handle->media_values->chunk_size,
+	     internal_handle->media_values->set_identifier,
+	     16,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write chunk access map file.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Writes the recorded chunk access map to a file
+ * The chunk access map file is bound to the segment file set identifier
+ * Chunk access recording must have been started with libewf_handle_start_chunk_access_recording
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_write_chunk_access_map(
+     libewf_handle_t *handle,
+     const char *filename,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_chunk_access_map";
+	size_t filename_length                    = 0;
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = narrow_string_length(
+	                   filename );
+
+	if( filename_length == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libewf_internal_handle_write_chunk_access_map(
+	     internal_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write chunk access map: %s.",
+		 function,
+		 filename );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Prefetches the chunks of a chunk access map file
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful, 0 if the chunk access map file does not exist or does not match or -1 on error
+ */
+int libewf_internal_handle_prefetch_chunk_access_map(
+     libewf_internal_handle_t *internal_handle,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error )
+{
+	libewf_chunk_access_map_t *chunk_access_map         = NULL;
+	static char *function                               = "libewf_internal_handle_prefetch_chunk_access_map";
+	int result                                          = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libewf_chunk_access_map_t *pending_chunk_access_map = NULL;
+#endif
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	/* Prefetch is only applied to read-only access
+	 */
+	if( internal_handle->write_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid handle - chunk access map prefetch only supported on read-only access.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_access_map_initialize(
+	     &chunk_access_map,
+	     internal_handle->media_values->number_of_chunks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk access map.",
+		 function );
+
+		goto on_error;
+	}
+	result = libewf_chunk_access_map_read_file(
+	          chunk_access_map,
+	          filename,
+	          filename_length,
+	          internal_handle->media_values->chunk_size,
+	          internal_handle->media_values->set_identifier,
+	          16,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk access map file.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	else if( ( result != 0 )
+	      && ( chunk_access_map->number_of_accessed_chunks > 0 ) )
+	{
+		if( internal_handle->read_ahead_thread == NULL )
+		{
+			if( libewf_internal_handle_read_ahead_start(
+			     internal_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to start read ahead.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( libcthreads_mutex_grab(
+		     internal_handle->read_ahead_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read ahead mutex.",
+			 function );
+
+			goto on_error;
+		}
+		/* A chunk access map that is still pending is replaced and freed below
+		 */
+		pending_chunk_access_map = internal_handle->prefetch_chunk_access_map;
+
+		internal_handle->prefetch_chunk_access_map       = chunk_access_map;
+		internal_handle->read_ahead_prefetch_chunk_index = 0;
+
+		chunk_access_map = pending_chunk_access_map;
+
+		if( libcthreads_condition_signal(
+		     internal_handle->read_ahead_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal read ahead condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 internal_handle->read_ahead_mutex,
+			 NULL );
+
+			goto on_error;
+		}
+		if( libcthreads_mutex_release(
+		     internal_handle->read_ahead_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read ahead mutex.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	if( chunk_access_map != NULL )
+	{
+		if( libewf_chunk_access_map_free(
+		     &chunk_access_map,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk access map.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( result );
+
+on_error:
+	if( chunk_access_map != NULL )
+	{
+		libewf_chunk_access_map_free(
+		 &chunk_access_map,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Prefetches the chunks of a chunk access map file
+ * The chunks recorded in the chunk access map file, such as the file system metadata
+ * accessed by a previous session, are read in offset order by the read ahead thread,
+ * so that subsequent random access to these chunks does not need to wait for the
+ * segment files. Reads that are requested by the consumer are handled first
+ * A chunk access map file of another segment file set is ignored
+ * Without multi-threading support the chunks are not prefetched
+ * Returns 1 if successful, 0 if the chunk access map file does not exist or does not match or -1 on error
+ */
+int libewf_handle_prefetch_chunk_access_map(
+     libewf_handle_t *handle,
+     const char *filename,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_prefetch_chunk_access_map";
+	size_t filename_length                    = 0;
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = narrow_string_length(
+	                   filename );
+
+	if( filename_length == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_internal_handle_prefetch_chunk_access_map(
+	          internal_handle,
+	          filename,
+	          filename_length,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to prefetch chunk access map: %s.",
+		 function,
+		 filename );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Advises the access pattern of a range of the (media) data
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_advise(
+     libewf_internal_handle_t *internal_handle,
+     off64_t offset,
+     size64_t size,
+     int advice,
+     libcerror_error_t **error )
+{
+	static char *function     = "libewf_internal_handle_advise";
+	uint64_t chunk_index      = 0;
+	uint64_t number_of_chunks = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->media_values == NULL )
+	 || ( internal_handle->media_values->chunk_size == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	/* Access advice is only applied to read-only access
+	 */
+	if( internal_handle->write_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid handle - access advice only supported on read-only access.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( advice != LIBEWF_ACCESS_ADVICE_NORMAL )
+	 && ( advice != LIBEWF_ACCESS_ADVICE_SEQUENTIAL )
+	 && ( advice != LIBEWF_ACCESS_ADVICE_RANDOM )
+	 && ( advice != LIBEWF_ACCESS_ADVICE_WILLNEED )
+	 && ( advice != LIBEWF_ACCESS_ADVICE_DONTNEED ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported advice.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= internal_handle->media_values->media_size )
+	{
+		return( 1 );
+	}
+	if( ( size == 0 )
+	 || ( size > ( internal_handle->media_values->media_size - offset ) ) )
+	{
+		size = internal_handle->media_values->media_size - offset;
+	}
+	chunk_index      = (uint64_t) offset / internal_handle->media_values->chunk_size;
+	number_of_chunks = ( ( (uint64_t) offset + size - 1 ) / internal_handle->media_values->chunk_size ) - chunk_index + 1;
+
+	/* Will need is an action on the range rather than an access pattern
+	 * hence it does not change the advice of the range
+	 */
+	if( advice == LIBEWF_ACCESS_ADVICE_WILLNEED )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( internal_handle->read_ahead_thread == NULL )
+		{
+			if( libewf_internal_handle_read_ahead_start(
+			     internal_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to start read ahead.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( libcthreads_mutex_grab(
+		     internal_handle->read_ahead_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read ahead mutex.",
+			 function );
+
+			return( -1 );
+		}
+		/* The range is merged into the chunks that are still pending to be prefetched
+		 */
+		if( internal_handle->prefetch_chunk_access_map == NULL )
+		{
+			if( libewf_chunk_access_map_initialize(
+			     &( internal_handle->prefetch_chunk_access_map ),
+			     internal_handle->media_values->number_of_chunks,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create prefetch chunk access map.",
+				 function );
+
+				goto on_error;
+			}
+			internal_handle->read_ahead_prefetch_chunk_index = chunk_index;
+		}
+		else if( chunk_index < internal_handle->read_ahead_prefetch_chunk_index )
+		{
+			internal_handle->read_ahead_prefetch_chunk_index = chunk_index;
+		}
+		if( libewf_chunk_access_map_set_chunk_range(
+		     internal_handle->prefetch_chunk_access_map,
+		     chunk_index,
+		     number_of_chunks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set chunk range in prefetch chunk access map.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_condition_signal(
+		     internal_handle->read_ahead_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal read ahead condition.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_mutex_release(
+		     internal_handle->read_ahead_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read ahead mutex.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		return( 1 );
+	}
+	if( internal_handle->access_advice == NULL )
+	{
+		if( libewf_access_advice_initialize(
+		     &( internal_handle->access_advice ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create access advice.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libewf_access_advice_set_range(
+	     internal_handle->access_advice,
+	     chunk_index,
+	     number_of_chunks,
+	     advice,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set access advice of chunk range.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+on_error:
+	libcthreads_mutex_release(
+	 internal_handle->read_ahead_mutex,
+	 NULL );
+
+	return( -1 );
+#endif
+}
+
+/* Advises the access pattern of a range of the (media) data
+ * Sequential reads the range ahead from the first read, random does not read
+ * the range ahead, will need prefetches the range in the background and
+ * dont need does not retain the range in the chunk cache that is shared
+ * between handles. Normal restores the default behavior
+ * The advice that applies to the first chunk of a read applies to the entire read
+ * A size of 0 applies the advice up to the end of the media data
+ * Without multi-threading support the range is not prefetched
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_advise(
+     libewf_handle_t *handle,
+     off64_t offset,
+     size64_t size,
+     int advice,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_advise";
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_internal_handle_advise(
+	          internal_handle,
+	          offset,
+	          size,
+	          advice,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to advise access of range at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves a view of the (media) data of the chunk at a specific offset
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful, 0 if the offset is beyond the media size or -1 on error
+ */
+int libewf_internal_handle_get_chunk_view(
+     libewf_internal_handle_t *internal_handle,
+     off64_t offset,
+     const uint8_t **data,
+     size_t *data_size,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	libfcache_cache_t *chunks_cache = NULL;
+	static char *function           = "libewf_internal_handle_get_chunk_view";
+	off64_t chunk_data_offset       = 0;
+	uint64_t chunk_index            = 0;
+	size_t view_size                = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_view_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk view data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= internal_handle->media_values->media_size )
+	{
+		return( 0 );
+	}
+	chunk_index = offset / internal_handle->media_values->chunk_size;
+
+	if( libewf_internal_handle_read_segment_files_to_offset(
+	     internal_handle,
+	     internal_handle->file_io_pool,
+	     offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read segment files up to offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	if( libewf_chunk_table_get_chunk_data_by_offset(
+	     internal_handle->chunk_table,
+	     chunk_index,
+	     internal_handle->io_handle,
+	     internal_handle->file_io_pool,
+	     internal_handle->media_values,
+	     internal_handle->segment_table,
+	     internal_handle->chunk_groups_cache,
+	     internal_handle->chunks_cache,
+	     offset,
+	     &chunk_data,
+	     &chunk_data_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to read chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	if( (off64_t) chunk_data_offset >= (off64_t) chunk_data->data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: chunk: %" PRIu64 " offset exceeds data size.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	view_size = (size_t) ( chunk_data->data_size - chunk_data_offset );
+
+	if( (size64_t) ( offset + view_size ) > internal_handle->media_values->media_size )
+	{
+		view_size = (size_t) ( internal_handle->media_values->media_size - offset );
+	}
+	/* The chunk data is pinned until the chunk view is released by setting aside
+	 * the chunks cache that contains it, so that reading other chunks cannot evict it
+	 */
+	if( libfcache_cache_initialize(
+	     &chunks_cache,
+	     internal_handle->maximum_number_of_cached_chunks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunks cache.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle->chunk_view_cache = internal_handle->chunks_cache;
+	internal_handle->chunks_cache     = chunks_cache;
+	internal_handle->chunk_view_data  = chunk_data;
+
+	*data      = &( ( chunk_data->data )[ chunk_data_offset ] );
+	*data_size = view_size;
+
+	return( 1 );
+}
+
+/* Retrieves a view of the (media) data of the chunk at a specific offset
+ * The view points directly into the cached chunk data, from the offset up to
+ * the end of the chunk, and remains valid until libewf_handle_release_chunk_view is called
+ * Only one chunk view can be active at a time, while it is active functions that
+ * read chunks into the chunks cache fail
+ * Returns 1 if successful, 0 if the offset is beyond the media size or -1 on error
+ */
+int libewf_handle_get_chunk_view(
+     libewf_handle_t *handle,
+     off64_t offset,
+     const uint8_t **data,
+     size_t *data_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_chunk_view";
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_internal_handle_get_chunk_view(
+	          internal_handle,
+	          offset,
+	          data,
+	          data_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk view.",
+		 function );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Releases the active chunk view
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_release_chunk_view(
+     libewf_handle_t *handle,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_release_chunk_view";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->chunk_view_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing chunk view data.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		/* The chunks cache that was used while the chunk view was active is discarded
+		 * and the chunks cache that contains the chunk view data is restored
+		 */
+		if( libfcache_cache_free(
+		     &( internal_handle->chunks_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunks cache.",
+			 function );
+
+			result = -1;
+		}
+		internal_handle->chunks_cache     = internal_handle->chunk_view_cache;
+		internal_handle->chunk_view_cache = NULL;
+		internal_handle->chunk_view_data  = NULL;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the flags and stored size of a specific chunk
+ * The flags are determined from the chunk table and the known checksum errors,
+ * the stored size is the size of the packed chunk data in the segment file,
+ * the chunk data is not read. The stored size is optional and can be NULL
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful, 0 if the chunk index is beyond the media size or -1 on error
+ */
+int libewf_internal_handle_get_chunk_storage_values(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     uint32_t *chunk_flags,
+     uint32_t *stored_size,
+     libcerror_error_t **error )
+{
+	static char *function      = "libewf_internal_handle_get_chunk_storage_values";
+	off64_t chunk_data_offset  = 0;
+	off64_t chunk_offset       = 0;
+	off64_t range_offset       = 0;
+	size64_t range_size        = 0;
+	uint64_t number_of_sectors = 0;
+	uint64_t start_sector      = 0;
+	uint32_t range_flags       = 0;
+	int file_io_pool_entry     = 0;
+	int result                 = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->media_values->chunk_size == 0 )
+	 || ( internal_handle->media_values->bytes_per_sector == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index >= ( (uint64_t) INT64_MAX / internal_handle->media_values->chunk_size ) )
+	{
+		return( 0 );
+	}
+	chunk_offset = (off64_t) chunk_index * internal_handle->media_values->chunk_size;
+
+	if( (size64_t) chunk_offset >= internal_handle->media_values->media_size )
+	{
+		return( 0 );
+	}
+	if( libewf_internal_handle_read_segment_files_to_offset(
+	     internal_handle,
+	     internal_handle->file_io_pool,
+	     chunk_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read segment files up to offset: %" PRIi64 ".",
+		 function,
+		 chunk_offset );
+
+		return( -1 );
+	}
+	result = libewf_chunk_table_get_chunk_range_by_offset(
+	          internal_handle->chunk_table,
+	          chunk_index,
+	          internal_handle->file_io_pool,
+	          internal_handle->segment_table,
+	          internal_handle->chunk_groups_cache,
+	          chunk_offset,
+	          &file_io_pool_entry,
+	          &range_offset,
+	          &range_size,
+	          &range_flags,
+	          &chunk_data_offset,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " range.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	*chunk_flags = 0;
+
+	if( stored_size != NULL )
+	{
+		*stored_size = 0;
+	}
+	/* A missing chunk is read as corrupted chunk data
+	 */
+	if( result == 0 )
+	{
+		*chunk_flags = LIBEWF_CHUNK_FLAG_IS_MISSING | LIBEWF_CHUNK_FLAG_IS_CORRUPTED;
+
+		return( 1 );
+	}
+	if( stored_size != NULL )
+	{
+		if( range_size > (size64_t) UINT32_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid chunk: %" PRIu64 " range size value out of bounds.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		*stored_size = (uint32_t) range_size;
+	}
+	if( ( range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+	{
+		*chunk_flags |= LIBEWF_CHUNK_FLAG_IS_COMPRESSED;
+	}
+	if( ( range_flags & LIBEWF_RANGE_FLAG_HAS_CHECKSUM ) != 0 )
+	{
+		*chunk_flags |= LIBEWF_CHUNK_FLAG_HAS_CHECKSUM;
+	}
+	if( ( range_flags & LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) != 0 )
+	{
+		*chunk_flags |= LIBEWF_CHUNK_FLAG_USES_PATTERN_FILL;
+	}
+	if( ( range_flags & LIBEWF_RANGE_FLAG_IS_SPARSE ) != 0 )
+	{
+		*chunk_flags |= LIBEWF_CHUNK_FLAG_IS_SPARSE;
+	}
+	if( ( range_flags & LIBEWF_RANGE_FLAG_IS_TAINTED ) != 0 )
+	{
+		*chunk_flags |= LIBEWF_CHUNK_FLAG_IS_TAINTED;
+	}
+	if( ( range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+	{
+		*chunk_flags |= LIBEWF_CHUNK_FLAG_IS_CORRUPTED;
+	}
+	else
+	{
+		/* Chunks that were read before are corrupted if they were added to the checksum errors
+		 */
+		start_sector      = (uint64_t) chunk_offset / internal_handle->media_values->bytes_per_sector;
+		number_of_sectors = internal_handle->media_values->sectors_per_chunk;
+
+		if( ( start_sector + number_of_sectors ) > internal_handle->media_values->number_of_sectors )
+		{
+			number_of_sectors = internal_handle->media_values->number_of_sectors - start_sector;
+		}
+		result = libewf_chunk_table_has_checksum_error(
+		          internal_handle->chunk_table,
+		          start_sector,
+		          number_of_sectors,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if chunk: %" PRIu64 " has a checksum error.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			*chunk_flags |= LIBEWF_CHUNK_FLAG_IS_CORRUPTED;
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the flags of a specific chunk
+ * The flags are determined from the chunk table and the known checksum errors,
+ * the chunk data is not read
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful, 0 if the chunk index is beyond the media size or -1 on error
+ */
+int libewf_internal_handle_get_chunk_flags(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     uint32_t *chunk_flags,
+     libcerror_error_t **error )
+{
+	return( libewf_internal_handle_get_chunk_storage_values(
+	         internal_handle,
+	         chunk_index,
+	         chunk_flags,
+	         NULL,
+	         error ) );
+}
+
+/* Retrieves the flags of a specific chunk
+ * The flags are determined from the chunk table and the known checksum errors,
+ * the chunk data is not read
+ * Returns 1 if successful, 0 if the chunk index is beyond the media size or -1 on error
+ */
+int libewf_handle_get_chunk_flags(
+     libewf_handle_t *handle,
+     uint64_t chunk_index,
+     uint32_t *chunk_flags,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_chunk_flags";
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_internal_handle_get_chunk_flags(
+	          internal_handle,
+	          chunk_index,
+	          chunk_flags,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " flags.",
+		 function,
+		 chunk_index );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the flags of consecutive chunks
+ * The flags are determined from the chunk table and the known checksum errors,
+ * the chunk data is not read
+ * Returns the number of chunks of which the flags were retrieved, 0 if the first chunk index
+ * is beyond the media size or -1 on error
+ */
+int libewf_handle_get_chunks_flags(
+     libewf_handle_t *handle,
+     uint64_t first_chunk_index,
+     uint32_t *chunks_flags,
+     int number_of_chunks,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_chunks_flags";
+	int chunk_flags_index                     = 0;
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunks_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunks flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_chunks <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of chunks value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	for( chunk_flags_index = 0;
+	     chunk_flags_index < number_of_chunks;
+	     chunk_flags_index++ )
+	{
+		result = libewf_internal_handle_get_chunk_flags(
+		          internal_handle,
+		          first_chunk_index + chunk_flags_index,
+		          &( chunks_flags[ chunk_flags_index ] ),
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " flags.",
+			 function,
+			 first_chunk_index + chunk_flags_index );
+
+			chunk_flags_index = -1;
+
+			break;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( chunk_flags_index );
+}
+
+/* Retrieves the flags and stored sizes of consecutive chunks
+ * The flags are determined from the chunk table and the known checksum errors,
+ * the stored size is the size of the packed chunk data in the segment files,
+ * which for a missing or sparse chunk is 0, the chunk data is not read
+ * Returns the number of chunks of which the flags were retrieved, 0 if the first chunk index
+ * is beyond the media size or -1 on error
+ */
+int libewf_handle_get_chunks_storage_values(
+     libewf_handle_t *handle,
+     uint64_t first_chunk_index,
+     uint32_t *chunks_flags,
+     uint32_t *chunks_stored_sizes,
+     int number_of_chunks,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_chunks_storage_values";
+	int chunk_flags_index                     = 0;
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunks_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunks flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunks_stored_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunks stored sizes.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_chunks <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of chunks value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	for( chunk_flags_index = 0;
+	     chunk_flags_index < number_of_chunks;
+	     chunk_flags_index++ )
+	{
+		result = libewf_internal_handle_get_chunk_storage_values(
+		          internal_handle,
+		          first_chunk_index + chunk_flags_index,
+		          &( chunks_flags[ chunk_flags_index ] ),
+		          &( chunks_stored_sizes[ chunk_flags_index ] ),
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " storage values.",
+			 function,
+			 first_chunk_index + chunk_flags_index );
+
+			chunk_flags_index = -1;
+
+			break;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( chunk_flags_index );
+}
+
+/* Retrieves the number of segments
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_number_of_segments(
+     libewf_handle_t *handle,
+     uint32_t *number_of_segments,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_number_of_segments";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing segment table.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libewf_segment_table_get_number_of_segments(
+	     internal_handle->segment_table,
+	     number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the range of the media data that is stored in a specific segment
+ * The file index is the index of the segment file in the filenames or file IO pool
+ * the handle was opened with
+ * The segment file is read if it was not read before
+ * The media size of the last segment is limited to the size of the media
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_segment_media_range(
+     libewf_handle_t *handle,
+     uint32_t segment_index,
+     int *file_index,
+     off64_t *media_offset,
+     size64_t *media_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_segment_media_range";
+	size64_t segment_file_size                = 0;
+	size64_t storage_media_size               = 0;
+	uint32_t number_of_segments               = 0;
+	uint32_t previous_segment_index           = 0;
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->read_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing read IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file index.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libewf_segment_table_get_number_of_segments(
+	     internal_handle->segment_table,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
+		 function );
+
+		goto on_error;
+	}
+	if( segment_index >= number_of_segments )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment index value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	/* The storage media size of a segment is known once its tables were read
+	 */
+	while( internal_handle->read_io_handle->number_of_segments_read <= segment_index )
+	{
+		if( libewf_internal_handle_open_read_segment_file(
+		     internal_handle,
+		     internal_handle->file_io_pool,
+		     internal_handle->segment_table,
+		     internal_handle->read_io_handle->number_of_segments_read,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open segment file: %" PRIu32 ".",
+			 function,
+			 internal_handle->read_io_handle->number_of_segments_read );
+
+			goto on_error;
+		}
+	}
+	if( libewf_segment_table_get_segment_by_index(
+	     internal_handle->segment_table,
+	     segment_index,
+	     file_index,
+	     &segment_file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment: %" PRIu32 ".",
+		 function,
+		 segment_index );
+
+		goto on_error;
+	}
+	*media_offset = 0;
+	*media_size   = 0;
+
+	for( previous_segment_index = 0;
+	     previous_segment_index <= segment_index;
+	     previous_segment_index++ )
+	{
+		result = libewf_segment_table_get_segment_storage_media_size_by_index(
+		          internal_handle->segment_table,
+		          previous_segment_index,
+		          &storage_media_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve storage media size of segment: %" PRIu32 ".",
+			 function,
+			 previous_segment_index );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			storage_media_size = 0;
+		}
+		if( previous_segment_index < segment_index )
+		{
+			*media_offset += (off64_t) storage_media_size;
+		}
+		else
+		{
+			*media_size = storage_media_size;
+		}
+	}
+	/* The storage media size is a multiple of the chunk size
+	 * hence the range of the last segment can extend beyond the media size
+	 */
+	if( internal_handle->media_values != NULL )
+	{
+		if( (size64_t) *media_offset >= internal_handle->media_values->media_size )
+		{
+			*media_size = 0;
+		}
+		else if( *media_size > ( internal_handle->media_values->media_size - (size64_t) *media_offset ) )
+		{
+			*media_size = internal_handle->media_values->media_size - (size64_t) *media_offset;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Retrieves the 64-bit pattern of a specific pattern filled chunk
+ * Only the 8 bytes of the pattern are read, the chunk data is not unpacked
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful, 0 if the chunk is not pattern filled or -1 on error
+ */
+int libewf_internal_handle_get_chunk_pattern_fill(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     uint64_t *pattern_fill,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_internal_handle_get_chunk_pattern_fill";
+	uint32_t chunk_flags            = 0;
+	int result                      = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( pattern_fill == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pattern fill.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_internal_handle_get_chunk_flags(
+	          internal_handle,
+	          chunk_index,
+	          &chunk_flags,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " flags.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	else if( ( result == 0 )
+	      || ( ( chunk_flags & LIBEWF_CHUNK_FLAG_USES_PATTERN_FILL ) == 0 ) )
+	{
+		return( 0 );
+	}
+	result = libewf_internal_handle_read_packed_chunk_data(
+	          internal_handle,
+	          internal_handle->file_io_pool,
+	          chunk_index,
+	          &chunk_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk: %" PRIu64 " packed data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( ( chunk_data == NULL )
+	 || ( chunk_data->data == NULL )
+	 || ( chunk_data->data_size < 8 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk: %" PRIu64 " packed data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	byte_stream_copy_to_uint64_little_endian(
+	 chunk_data->data,
+	 *pattern_fill );
+
+	if( libewf_chunk_data_free(
+	     &chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the 64-bit pattern of a specific pattern filled chunk
+ * Only the 8 bytes of the pattern are read, the chunk data is not unpacked
+ * Returns 1 if successful, 0 if the chunk is not pattern filled or -1 on error
+ */
+int libewf_handle_get_chunk_pattern_fill(
+     libewf_handle_t *handle,
+     uint64_t chunk_index,
+     uint64_t *pattern_fill,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_chunk_pattern_fill";
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( pattern_fill == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pattern fill.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_internal_handle_get_chunk_pattern_fill(
+	          internal_handle,
+	          chunk_index,
+	          pattern_fill,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " pattern fill.",
+		 function,
+		 chunk_index );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Determines the data extent type of a specific chunk
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful, 0 if the chunk index is beyond the media size or -1 on error
+ */
+int libewf_internal_handle_get_chunk_extent_type(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     uint32_t *extent_type,
+     uint64_t *pattern_fill,
+     libcerror_error_t **error )
+{
+	static char *function      = "libewf_internal_handle_get_chunk_extent_type";
+	uint64_t number_of_sectors = 0;
+	uint64_t start_sector      = 0;
+	uint32_t chunk_flags       = 0;
+	int result                 = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_type == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent type.",
+		 function );
+
+		return( -1 );
+	}
+	if( pattern_fill == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pattern fill.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_internal_handle_get_chunk_flags(
+	          internal_handle,
+	          chunk_index,
+	          &chunk_flags,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " flags.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	*pattern_fill = 0;
+
+	if( ( chunk_flags & LIBEWF_CHUNK_FLAG_IS_CORRUPTED ) != 0 )
+	{
+		*extent_type = LIBEWF_DATA_EXTENT_TYPE_CORRUPTED;
+
+		return( 1 );
+	}
+	/* Sectors that could not be read during acquiry are stored as regular chunk data
+	 */
+	start_sector      = chunk_index * internal_handle->media_values->sectors_per_chunk;
+	number_of_sectors = internal_handle->media_values->sectors_per_chunk;
+
+	if( ( start_sector + number_of_sectors ) > internal_handle->media_values->number_of_sectors )
+	{
+		number_of_sectors = internal_handle->media_values->number_of_sectors - start_sector;
+	}
+	if( libewf_internal_handle_read_deferred_error_section(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read deferred error section.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_sector_range_list_range_is_present(
+	          internal_handle->acquiry_errors,
+	          start_sector,
+	          number_of_sectors,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if chunk: %" PRIu64 " has an acquiry error.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		*extent_type = LIBEWF_DATA_EXTENT_TYPE_CORRUPTED;
+
+		return( 1 );
+	}
+	if( ( chunk_flags & LIBEWF_CHUNK_FLAG_IS_SPARSE ) != 0 )
+	{
+		*extent_type = LIBEWF_DATA_EXTENT_TYPE_ZERO_FILL;
+
+		return( 1 );
+	}
+	*extent_type = LIBEWF_DATA_EXTENT_TYPE_DATA;
+
+	if( ( chunk_flags & LIBEWF_CHUNK_FLAG_USES_PATTERN_FILL ) != 0 )
+	{
+		result = libewf_internal_handle_get_chunk_pattern_fill(
+		          internal_handle,
+		          chunk_index,
+		          pattern_fill,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " pattern fill.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			if( *pattern_fill == 0 )
+			{
+				*extent_type = LIBEWF_DATA_EXTENT_TYPE_ZERO_FILL;
+			}
+			else
+			{
+				*extent_type = LIBEWF_DATA_EXTENT_TYPE_PATTERN_FILL;
+			}
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the data extent that contains a specific offset
+ * Adjacent chunks of the same extent type, and for pattern fill the same pattern, are merged
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful, 0 if the offset is beyond the media size or -1 on error
+ */
+int libewf_internal_handle_get_data_extent(
+     libewf_internal_handle_t *internal_handle,
+     off64_t offset,
+     off64_t *extent_offset,
+     size64_t *extent_size,
+     uint32_t *extent_type,
+     libcerror_error_t **error )
+{
+	static char *function        = "libewf_internal_handle_get_data_extent";
+	off64_t extent_end_offset    = 0;
+	uint64_t chunk_index         = 0;
+	uint64_t chunk_pattern_fill  = 0;
+	uint64_t extent_pattern_fill = 0;
+	uint32_t chunk_extent_type   = 0;
+	int result                   = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent size.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_type == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent type.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= internal_handle->media_values->media_size )
+	{
+		return( 0 );
+	}
+	chunk_index = (uint64_t) offset / internal_handle->media_values->chunk_size;
+
+	result = libewf_internal_handle_get_chunk_extent_type(
+	          internal_handle,
+	          chunk_index,
+	          extent_type,
+	          &extent_pattern_fill,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " extent type.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	*extent_offset = (off64_t) chunk_index * internal_handle->media_values->chunk_size;
+
+	do
+	{
+		chunk_index++;
+
+		result = libewf_internal_handle_get_chunk_extent_type(
+		          internal_handle,
+		          chunk_index,
+		          &chunk_extent_type,
+		          &chunk_pattern_fill,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " extent type.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+	}
+	while( ( result != 0 )
+	    && ( chunk_extent_type == *extent_type )
+	    && ( chunk_pattern_fill == extent_pattern_fill ) );
+
+	extent_end_offset = (off64_t) chunk_index * internal_handle->media_values->chunk_size;
+
+	if( (size64_t) extent_end_offset > internal_handle->media_values->media_size )
+	{
+		extent_end_offset = (off64_t) internal_handle->media_values->media_size;
+	}
+	*extent_size = (size64_t) ( extent_end_offset - *extent_offset );
+
+	return( 1 );
+}
+
+/* Retrieves the data extents starting at the extent that contains a specific offset
+ * An extent describes a range of the media data that contains either regular data,
+ * zero fill, pattern fill or corrupted data, refer to LIBEWF_DATA_EXTENT_TYPES
+ * Adjacent chunks of the same extent type, and for pattern fill the same pattern, are merged
+ * The next extents can be retrieved by calling this function with the end offset of the last extent
+ * Returns the number of extents retrieved, 0 if the offset is beyond the media size or -1 on error
+ */
+int libewf_handle_get_data_extents(
+     libewf_handle_t *handle,
+     off64_t offset,
+     off64_t *extents_offsets,
+     size64_t *extents_sizes,
+     uint32_t *extents_types,
+     int number_of_extents,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_data_extents";
+	int extent_index                          = 0;
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( extents_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extents offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( extents_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extents sizes.",
+		 function );
+
+		return( -1 );
+	}
+	if( extents_types == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extents types.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_extents <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of extents value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
+	{
+		result = libewf_internal_handle_get_data_extent(
+		          internal_handle,
+		          offset,
+		          &( extents_offsets[ extent_index ] ),
+		          &( extents_sizes[ extent_index ] ),
+		          &( extents_types[ extent_index ] ),
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data extent at offset: %" PRIi64 ".",
+			 function,
+			 offset );
+
+			extent_index = -1;
+
+			break;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		offset = extents_offsets[ extent_index ] + (off64_t) extents_sizes[ extent_index ];
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( extent_index );
+}
+
+/* Creates the chunk packer and the pending chunks used to pack chunks in parallel
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_initialize_chunk_packer(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_initialize_chunk_packer";
+	size_t array_size     = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_packer != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk packer value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_packer_initialize(
+	     &( internal_handle->chunk_packer ),
+	     internal_handle->io_handle,
+	     internal_handle->write_io_handle,
+	     internal_handle->number_of_threads,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk packer.",
+		 function );
+
+		goto on_error;
+	}
+	array_size = sizeof( libewf_chunk_data_t * ) * internal_handle->chunk_packer->maximum_number_of_chunks;
+
+	internal_handle->pending_chunk_data = (libewf_chunk_data_t **) memory_allocate(
+	                                                                array_size );
+
+	if( internal_handle->pending_chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create pending chunk data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_handle->pending_chunk_data,
+	     0,
+	     array_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear pending chunk data.",
+		 function );
+
+		goto on_error;
+	}
+	array_size = sizeof( size_t ) * internal_handle->chunk_packer->maximum_number_of_chunks;
+
+	internal_handle->pending_chunk_data_sizes = (size_t *) memory_allocate(
+	                                                        array_size );
+
+	if( internal_handle->pending_chunk_data_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create pending chunk data sizes.",
+		 function );
+
+		goto on_error;
+	}
+	internal_handle->pending_chunk_index      = 0;
+	internal_handle->number_of_pending_chunks = 0;
+
+	return( 1 );
+
+on_error:
+	if( internal_handle->pending_chunk_data != NULL )
+	{
+		memory_free(
+		 internal_handle->pending_chunk_data );
+
+		internal_handle->pending_chunk_data = NULL;
+	}
+	if( internal_handle->chunk_packer != NULL )
+	{
+		libewf_chunk_packer_free(
+		 &( internal_handle->chunk_packer ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees the chunk packer and the pending chunks
+ * Chunks that are still pending are discarded
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_free_chunk_packer(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_free_chunk_packer";
+	int chunk_data_index  = 0;
+	int result            = 1;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->pending_chunk_data != NULL )
+	{
+		for( chunk_data_index = 0;
+		     chunk_data_index < internal_handle->number_of_pending_chunks;
+		     chunk_data_index++ )
+		{
+			if( libewf_chunk_data_free(
+			     &( internal_handle->pending_chunk_data[ chunk_data_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free pending chunk data: %d.",
+				 function,
+				 chunk_data_index );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 internal_handle->pending_chunk_data );
+
+		internal_handle->pending_chunk_data = NULL;
+	}
+	if( internal_handle->pending_chunk_data_sizes != NULL )
+	{
+		memory_free(
+		 internal_handle->pending_chunk_data_sizes );
+
+		internal_handle->pending_chunk_data_sizes = NULL;
+	}
+	internal_handle->pending_chunk_index      = 0;
+	internal_handle->number_of_pending_chunks = 0;
+
+	if( internal_handle->chunk_packer != NULL )
+	{
+		if( libewf_chunk_packer_free(
+		     &( internal_handle->chunk_packer ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk packer.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Packs the pending chunks in parallel and writes them in order using a Basic File IO (bfio) pool
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_internal_handle_write_pending_chunks(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libcerror_error_t **error )
+{
+	static char *function     = "libewf_internal_handle_write_pending_chunks";
+	ssize_t total_write_count = 0;
+	ssize_t write_count       = 0;
+	uint64_t chunk_index      = 0;
+	int chunk_data_index      = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->number_of_pending_chunks == 0 )
+	{
+		return( 0 );
+	}
+	if( internal_handle->chunk_packer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing chunk packer.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_packer_pack(
+	     internal_handle->chunk_packer,
+	     internal_handle->pending_chunk_data,
+	     internal_handle->number_of_pending_chunks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to pack chunks: %" PRIu64 " - %" PRIu64 ".",
+		 function,
+		 internal_handle->pending_chunk_index,
+		 internal_handle->pending_chunk_index + internal_handle->number_of_pending_chunks - 1 );
+
+		return( -1 );
+	}
+	chunk_index = internal_handle->pending_chunk_index;
+
+	for( chunk_data_index = 0;
+	     chunk_data_index < internal_handle->number_of_pending_chunks;
+	     chunk_data_index++ )
+	{
+		write_count = libewf_write_io_handle_write_new_chunk(
+		               internal_handle->write_io_handle,
+		               internal_handle->io_handle,
+		               file_io_pool,
+		               internal_handle->media_values,
+		               internal_handle->segment_table,
+		               internal_handle->header_values,
+		               internal_handle->hash_values,
+		               internal_handle->hash_sections,
+		               internal_handle->sessions,
+		               internal_handle->tracks,
+		               internal_handle->acquiry_errors,
+		               chunk_index,
+		               internal_handle->pending_chunk_data[ chunk_data_index ],
+		               internal_handle->pending_chunk_data_sizes[ chunk_data_index ],
+		               error );
+
+		if( write_count <= 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write new chunk: %" PRIu64 ".",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		total_write_count += write_count;
+
+		if( libewf_chunk_data_free(
+		     &( internal_handle->pending_chunk_data[ chunk_data_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		chunk_index += 1;
+	}
+	internal_handle->number_of_pending_chunks = 0;
+
+	return( total_write_count );
+}
+
+/* Frees the out of order chunks
+ * Chunks that are still held are discarded
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_free_out_of_order_chunks(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_free_out_of_order_chunks";
+	int chunk_data_index  = 0;
+	int result            = 1;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->out_of_order_chunk_data != NULL )
+	{
+		for( chunk_data_index = 0;
+		     chunk_data_index < internal_handle->maximum_number_of_out_of_order_chunks;
+		     chunk_data_index++ )
+		{
+			if( internal_handle->out_of_order_chunk_data[ chunk_data_index ] == NULL )
+			{
+				continue;
+			}
+			if( libewf_chunk_data_free(
+			     &( internal_handle->out_of_order_chunk_data[ chunk_data_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free out of order chunk data: %d.",
+				 function,
+				 chunk_data_index );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 internal_handle->out_of_order_chunk_data );
+
+		internal_handle->out_of_order_chunk_data = NULL;
+	}
+	if( internal_handle->out_of_order_chunk_data_sizes != NULL )
+	{
+		memory_free(
+		 internal_handle->out_of_order_chunk_data_sizes );
+
+		internal_handle->out_of_order_chunk_data_sizes = NULL;
+	}
+	internal_handle->number_of_out_of_order_chunks = 0;
+
+	return( result );
+}
+
+/* Holds a copy of a (media) data chunk that precedes chunks that were not yet written
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_append_out_of_order_chunk(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_append_out_of_order_chunk";
+	size_t array_size     = 0;
+	uint64_t next_index   = 0;
+	int chunk_data_index  = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	next_index = internal_handle->write_io_handle->number_of_chunks_written;
+
+	if( ( chunk_index <= next_index )
+	 || ( ( chunk_index - next_index ) >= (uint64_t) internal_handle->maximum_number_of_out_of_order_chunks ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: chunk: %" PRIu64 " out of bounds of out of order window starting at chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index,
+		 next_index );
+
+		return( -1 );
+	}
+	if( internal_handle->out_of_order_chunk_data == NULL )
+	{
+		array_size = sizeof( libewf_chunk_data_t * ) * internal_handle->maximum_number_of_out_of_order_chunks;
+
+		internal_handle->out_of_order_chunk_data = (libewf_chunk_data_t **) memory_allocate(
+		                                                                     array_size );
+
+		if( internal_handle->out_of_order_chunk_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create out of order chunk data array.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     internal_handle->out_of_order_chunk_data,
+		     0,
+		     array_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear out of order chunk data array.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( internal_handle->out_of_order_chunk_data_sizes == NULL )
+	{
+		array_size = sizeof( size_t ) * internal_handle->maximum_number_of_out_of_order_chunks;
+
+		internal_handle->out_of_order_chunk_data_sizes = (size_t *) memory_allocate(
+		                                                             array_size );
+
+		if( internal_handle->out_of_order_chunk_data_sizes == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create out of order chunk data sizes array.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* The chunks in the window are unique modulo the size of the window
+	 */
+	chunk_data_index = (int) ( chunk_index % internal_handle->maximum_number_of_out_of_order_chunks );
+
+	if( internal_handle->out_of_order_chunk_data[ chunk_data_index ] != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: chunk: %" PRIu64 " already exists.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	if( libewf_chunk_data_clone(
+	     &( internal_handle->out_of_order_chunk_data[ chunk_data_index ] ),
+	     chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to clone chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	internal_handle->out_of_order_chunk_data_sizes[ chunk_data_index ] = data_size;
+
+	internal_handle->number_of_out_of_order_chunks += 1;
+
+	return( 1 );
+
+on_error:
+	if( internal_handle->out_of_order_chunk_data != NULL )
+	{
+		memory_free(
+		 internal_handle->out_of_order_chunk_data );
+
+		internal_handle->out_of_order_chunk_data = NULL;
+	}
+	return( -1 );
+}
+
+/* Writes the out of order chunks that directly follow the chunks written using a Basic File IO (bfio) pool
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_internal_handle_write_out_of_order_chunks(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libcerror_error_t **error )
+{
+	static char *function     = "libewf_internal_handle_write_out_of_order_chunks";
+	ssize_t total_write_count = 0;
+	ssize_t write_count       = 0;
+	uint64_t chunk_index      = 0;
+	int chunk_data_index      = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	while( internal_handle->number_of_out_of_order_chunks > 0 )
+	{
+		chunk_index      = internal_handle->write_io_handle->number_of_chunks_written;
+		chunk_data_index = (int) ( chunk_index % internal_handle->maximum_number_of_out_of_order_chunks );
+
+		if( internal_handle->out_of_order_chunk_data[ chunk_data_index ] == NULL )
+		{
+			break;
+		}
+		write_count = libewf_write_io_handle_write_new_chunk(
+		               internal_handle->write_io_handle,
+		               internal_handle->io_handle,
+		               file_io_pool,
+		               internal_handle->media_values,
+		               internal_handle->segment_table,
+		               internal_handle->header_values,
+		               internal_handle->hash_values,
+		               internal_handle->hash_sections,
+		               internal_handle->sessions,
+		               internal_handle->tracks,
+		               internal_handle->acquiry_errors,
+		               chunk_index,
+		               internal_handle->out_of_order_chunk_data[ chunk_data_index ],
+		               internal_handle->out_of_order_chunk_data_sizes[ chunk_data_index ],
+		               error );
+
+		if( write_count <= 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write new chunk: %" PRIu64 ".",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		total_write_count += write_count;
+
+		if( libewf_chunk_data_free(
+		     &( internal_handle->out_of_order_chunk_data[ chunk_data_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		internal_handle->number_of_out_of_order_chunks -= 1;
+	}
+	return( total_write_count );
+}
+
+/* Writes (media) data at the current offset from a buffer using a Basic File IO (bfio) pool
+ * the necessary settings of the write values must have been made
+ * Will initialize write if necessary
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         const void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	static char *function     = "libewf_internal_handle_write_buffer_to_file_io_pool";
+	off64_t chunk_data_offset = 0;
+	size_t buffer_offset      = 0;
+	size_t input_data_size    = 0;
+	size_t write_size         = 0;
+	ssize_t write_count       = 0;
+	uint64_t chunk_index      = 0;
+	int write_chunk           = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	{
+		if( internal_handle->chunk_data != NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid handle - chunk data set.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing subhandle write.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+	{
+		return( 0 );
+	}
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( (size64_t) ( internal_handle->current_offset + buffer_size ) >= internal_handle->media_values->media_size ) )
+	{
+		buffer_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->current_offset );
+	}
+	chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+
+	if( chunk_index >= (uint64_t) INT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk index value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_data_offset = chunk_index * internal_handle->media_values->chunk_size;
+	chunk_data_offset = internal_handle->current_offset - chunk_data_offset;
+
+	if( chunk_data_offset >= (off64_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk data offset value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_size > 0 )
+	{
+		if( chunk_index < internal_handle->write_io_handle->number_of_chunks_written )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: chunk: %" PRIu64 " already set.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		if( internal_handle->write_io_handle->write_finalized != 0 )
+		{
+			break;
+		}
+		if( internal_handle->chunk_data == NULL )
+		{
+			if( libewf_chunk_data_initialize_with_buffer_pool(
+			     &( internal_handle->chunk_data ),
+			     internal_handle->io_handle->buffer_pool,
+			     internal_handle->media_values->chunk_size,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+		}
+		if( internal_handle->chunk_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: internal handle - missing chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		if( chunk_data_offset > internal_handle->media_values->chunk_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: chunk offset exceeds chunk data size.",
+			 function );
+
+			return( -1 );
+		}
+		write_size = (size_t) ( internal_handle->media_values->chunk_size - chunk_data_offset );
+
+		if( write_size > buffer_size )
+		{
+			write_size = buffer_size;
+		}
+		if( write_size == 0 )
+		{
+			break;
+		}
+		if( memory_copy(
+		     &( ( internal_handle->chunk_data->data )[ chunk_data_offset ] ),
+		     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+		     write_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy buffer to chunk data.",
+			 function );
+
+			return( -1 );
+		}
+		internal_handle->chunk_data->data_size = (size_t) ( chunk_data_offset + write_size );
+
+		buffer_offset += write_size;
+		buffer_size   -= write_size;
+
+		if( internal_handle->chunk_data->data_size == internal_handle->media_values->chunk_size )
+		{
+			write_chunk = 1;
+		}
+		else if( ( internal_handle->media_values->media_size != 0 )
+		      && ( ( (size64_t) internal_handle->current_offset + write_size ) == internal_handle->media_values->media_size ) )
+		{
+			write_chunk = 1;
+		}
+		else
+		{
+			write_chunk = 0;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		/* With multiple threads the chunks are collected and packed in parallel
+		 * after which they are written in order
+		 */
+		if( ( write_chunk != 0 )
+		 && ( internal_handle->number_of_threads > 1 ) )
+		{
+			if( internal_handle->chunk_packer == NULL )
+			{
+				if( libewf_internal_handle_initialize_chunk_packer(
+				     internal_handle,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to initialize chunk packer.",
+					 function );
+
+					return( -1 );
+				}
+			}
+			if( ( internal_handle->number_of_pending_chunks > 0 )
+			 && ( ( internal_handle->pending_chunk_index + internal_handle->number_of_pending_chunks ) != chunk_index ) )
+			{
+				if( libewf_internal_handle_write_pending_chunks(
+				     internal_handle,
+				     file_io_pool,
+				     error ) < 0 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write pending chunks.",
+					 function );
+
+					return( -1 );
+				}
+			}
+			if( internal_handle->number_of_pending_chunks == 0 )
+			{
+				internal_handle->pending_chunk_index = chunk_index;
+			}
+			internal_handle->pending_chunk_data[ internal_handle->number_of_pending_chunks ]       = internal_handle->chunk_data;
+			internal_handle->pending_chunk_data_sizes[ internal_handle->number_of_pending_chunks ] = internal_handle->chunk_data->data_size;
+
+			internal_handle->number_of_pending_chunks += 1;
+
+			internal_handle->chunk_data = NULL;
+
+			if( ( internal_handle->number_of_pending_chunks >= internal_handle->chunk_packer->maximum_number_of_chunks )
+			 || ( ( internal_handle->media_values->media_size != 0 )
+			  && ( ( (size64_t) internal_handle->current_offset + write_size ) == internal_handle->media_values->media_size ) ) )
+			{
+				if( libewf_internal_handle_write_pending_chunks(
+				     internal_handle,
+				     file_io_pool,
+				     error ) < 0 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write pending chunks.",
+					 function );
+
+					return( -1 );
+				}
+			}
+		}
+		else
+#endif
+		if( write_chunk != 0 )
+		{
+			input_data_size = internal_handle->chunk_data->data_size;
+
+			if( libewf_chunk_data_pack(
+			     internal_handle->chunk_data,
+			     internal_handle->io_handle,
+			     internal_handle->chunk_table->compression_context,
+			     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
+			     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
+			     internal_handle->write_io_handle->pack_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to pack chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			write_count = libewf_write_io_handle_write_new_chunk(
+			               internal_handle->write_io_handle,
+			               internal_handle->io_handle,
+			               file_io_pool,
+			               internal_handle->media_values,
+			               internal_handle->segment_table,
+			               internal_handle->header_values,
+			               internal_handle->hash_values,
+			               internal_handle->hash_sections,
+			               internal_handle->sessions,
+			               internal_handle->tracks,
+			               internal_handle->acquiry_errors,
+			               chunk_index,
+			               internal_handle->chunk_data,
+			               input_data_size,
+			               error );
+
+			if( write_count <= 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write new chunk.",
+				 function );
+
+				return( -1 );
+			}
+			if( libewf_chunk_data_free(
+			     &( internal_handle->chunk_data ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk data.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		chunk_index      += 1;
+		chunk_data_offset = 0;
+
+		internal_handle->current_offset += (off64_t) write_size;
+
+		if( ( internal_handle->media_values->media_size != 0 )
+		 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+		{
+			break;
+		}
+		if( internal_handle->io_handle->abort != 0 )
+		{
+			break;
+		}
+	}
+	return( (ssize_t) buffer_offset );
+}
+
+/* Writes (media) data at the current offset
+ * the necessary settings of the write values must have been made
+ * Will initialize write if necessary
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_handle_write_buffer(
+         libewf_handle_t *handle,
+         const void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_buffer";
+	ssize_t write_count                       = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->write_io_handle->values_initialized == 0 )
+	{
+		if( libewf_write_io_handle_initialize_values(
+		     internal_handle->write_io_handle,
+		     internal_handle->io_handle,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize write IO handle values.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	write_count = libewf_internal_handle_write_buffer_to_file_io_pool(
+	               internal_handle,
+	               internal_handle->file_io_pool,
+	               buffer,
+	               buffer_size,
+	               error );
+
+	if( write_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to write buffer.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Writes (media) data at a specific offset,
+ * the necessary settings of the write values must have been made
+ * Will initialize write if necessary
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_handle_write_buffer_at_offset(
+         libewf_handle_t *handle,
+         const void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_buffer_at_offset";
+	ssize_t write_count                       = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->write_io_handle->values_initialized == 0 )
+	{
+		if( libewf_write_io_handle_initialize_values(
+		     internal_handle->write_io_handle,
+		     internal_handle->io_handle,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize write IO handle values.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_internal_handle_seek_offset(
+	     internal_handle,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libewf_internal_handle_write_buffer_to_file_io_pool(
+	               internal_handle,
+	               internal_handle->file_io_pool,
+	               buffer,
+	               buffer_size,
+	               error );
+
+	if( write_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to write buffer.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Retrieves a (media) data chunk
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_data_chunk(
+     libewf_handle_t *handle,
+     libewf_data_chunk_t **data_chunk,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_data_chunk";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( *data_chunk != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: data chunk value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( internal_handle->write_io_handle != NULL )
+	 && ( internal_handle->write_io_handle->values_initialized == 0 ) )
+	{
+		if( libewf_write_io_handle_initialize_values(
+		     internal_handle->write_io_handle,
+		     internal_handle->io_handle,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize write IO handle values.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_data_chunk_initialize(
+	     data_chunk,
+	     internal_handle->io_handle,
+	     internal_handle->write_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create data chunk.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Reads a (media) data chunk at the current offset
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_internal_handle_read_data_chunk_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_internal_data_chunk_t *internal_data_chunk,
+         libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_internal_handle_read_data_chunk_from_file_io_pool";
+	off64_t chunk_data_offset       = 0;
+	ssize_t read_count              = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_view_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk view data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
+	{
+		return( 0 );
+	}
+/* TODO remove need to calculate */
+	internal_handle->current_chunk_index = internal_handle->current_offset
+	                                     / internal_handle->media_values->chunk_size;
+
+	internal_handle->current_offset = (off64_t) internal_handle->current_chunk_index
+	                                * (off64_t) internal_handle->media_values->chunk_size;
+
+	if( libewf_internal_handle_read_segment_files_to_offset(
+	     internal_handle,
+	     file_io_pool,
+	     internal_handle->current_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read segment files up to offset: %" PRIi64 ".",
+		 function,
+		 internal_handle->current_offset );
+
+		return( -1 );
+	}
+	if( libewf_chunk_table_get_chunk_data_by_offset(
+	     internal_handle->chunk_table,
+	     internal_handle->current_chunk_index,
+	     internal_handle->io_handle,
+	     file_io_pool,
+	     internal_handle->media_values,
+	     internal_handle->segment_table,
+	     internal_handle->chunk_groups_cache,
+	     internal_handle->chunks_cache,
+	     internal_handle->current_offset,
+	     &chunk_data,
+	     &chunk_data_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " data.",
+		 function,
+		 internal_handle->current_chunk_index );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk: %" PRIu64 " data.",
+		 function,
+		 internal_handle->current_chunk_index );
+
+		return( -1 );
+	}
+	read_count = (ssize_t) chunk_data->data_size;
+
+	if( libewf_internal_data_chunk_set_chunk_data(
+	     internal_data_chunk,
+	     internal_handle->current_chunk_index,
+	     chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk: %" PRIu64 " data in data chunk.",
+		 function,
+		 internal_handle->current_chunk_index );
+
+		return( -1 );
+	}
+	internal_handle->current_offset += read_count;
+
+	internal_handle->current_chunk_index++;
+
+	return( read_count );
+}
+
+/* Reads a (media) data chunk at the current offset
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_handle_read_data_chunk(
+         libewf_handle_t *handle,
+         libewf_data_chunk_t *data_chunk,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_read_data_chunk";
+	ssize_t read_count                        = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libewf_internal_handle_read_data_chunk_from_file_io_pool(
+	              internal_handle,
+	              internal_handle->file_io_pool,
+	              (libewf_internal_data_chunk_t *) data_chunk,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data chunk.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Reads (media) data chunks at the current offset
+ * The packed data of consecutive chunks is read with coalesced reads and the chunks
+ * are unpacked in batches, using the chunk unpacker if multiple threads are set
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of data chunks read, 0 when no longer data can be read or -1 on error
+ */
+int libewf_internal_handle_read_data_chunks_from_file_io_pool(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_data_chunk_t **data_chunks,
+     int number_of_data_chunks,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t **batch_chunk_data = NULL;
+	libewf_chunk_data_t *chunk_data        = NULL;
+	static char *function                  = "libewf_internal_handle_read_data_chunks_from_file_io_pool";
+	off64_t chunk_data_offset              = 0;
+	size_t array_size                      = 0;
+	uint64_t number_of_chunks              = 0;
+	int batch_index                        = 0;
+	int data_chunk_index                   = 0;
+	int maximum_number_of_batch_chunks     = 0;
+	int number_of_batch_chunks             = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	int use_chunk_unpacker                 = 0;
+#endif
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_view_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk view data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->media_values == NULL )
+	 || ( internal_handle->media_values->chunk_size == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunks.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_data_chunks < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of data chunks value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	for( data_chunk_index = 0;
+	     data_chunk_index < number_of_data_chunks;
+	     data_chunk_index++ )
+	{
+		if( data_chunks[ data_chunk_index ] == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid data chunk: %d.",
+			 function,
+			 data_chunk_index );
+
+			return( -1 );
+		}
+	}
+	if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
+	{
+		return( 0 );
+	}
+	internal_handle->current_chunk_index = internal_handle->current_offset
+	                                     / internal_handle->media_values->chunk_size;
+
+	internal_handle->current_offset = (off64_t) internal_handle->current_chunk_index
+	                                * (off64_t) internal_handle->media_values->chunk_size;
+
+	/* Do not read beyond the last chunk
+	 */
+	number_of_chunks = ( internal_handle->media_values->media_size - (size64_t) internal_handle->current_offset
+	                   + internal_handle->media_values->chunk_size - 1 )
+	                 / internal_handle->media_values->chunk_size;
+
+	if( number_of_chunks < (uint64_t) number_of_data_chunks )
+	{
+		number_of_data_chunks = (int) number_of_chunks;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( ( internal_handle->number_of_threads > 1 )
+	 && ( number_of_data_chunks > 1 ) )
+	{
+		if( internal_handle->chunk_unpacker == NULL )
+		{
+			if( libewf_chunk_unpacker_initialize(
+			     &( internal_handle->chunk_unpacker ),
+			     internal_handle->io_handle,
+			     internal_handle->number_of_threads,
+			     internal_handle->scheduler,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create chunk unpacker.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		maximum_number_of_batch_chunks = internal_handle->chunk_unpacker->maximum_number_of_chunks;
+		use_chunk_unpacker             = 1;
+	}
+	else
+#endif
+	{
+		maximum_number_of_batch_chunks = LIBEWF_READ_DATA_CHUNKS_NUMBER_OF_CHUNKS_PER_BATCH;
+	}
+	if( maximum_number_of_batch_chunks > number_of_data_chunks )
+	{
+		maximum_number_of_batch_chunks = number_of_data_chunks;
+	}
+	if( maximum_number_of_batch_chunks == 0 )
+	{
+		return( 0 );
+	}
+	array_size = sizeof( libewf_chunk_data_t * ) * maximum_number_of_batch_chunks;
+
+	batch_chunk_data = (libewf_chunk_data_t **) memory_allocate(
+	                                             array_size );
+
+	if( batch_chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create batch chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     batch_chunk_data,
+	     0,
+	     array_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear batch chunk data.",
+		 function );
+
+		memory_free(
+		 batch_chunk_data );
+
+		return( -1 );
+	}
+	data_chunk_index = 0;
+
+	while( data_chunk_index < number_of_data_chunks )
+	{
+		number_of_batch_chunks = number_of_data_chunks - data_chunk_index;
+
+		if( number_of_batch_chunks > maximum_number_of_batch_chunks )
+		{
+			number_of_batch_chunks = maximum_number_of_batch_chunks;
+		}
+		if( libewf_internal_handle_read_packed_chunks_data(
+		     internal_handle,
+		     file_io_pool,
+		     internal_handle->current_chunk_index,
+		     batch_chunk_data,
+		     number_of_batch_chunks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunks: %" PRIu64 " - %" PRIu64 " data.",
+			 function,
+			 internal_handle->current_chunk_index,
+			 internal_handle->current_chunk_index + number_of_batch_chunks - 1 );
+
+			goto on_error;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( use_chunk_unpacker != 0 )
+		{
+			if( libewf_chunk_unpacker_unpack(
+			     internal_handle->chunk_unpacker,
+			     batch_chunk_data,
+			     number_of_batch_chunks,
+			     internal_handle->read_priority,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to unpack chunks: %" PRIu64 " - %" PRIu64 " data.",
+				 function,
+				 internal_handle->current_chunk_index,
+				 internal_handle->current_chunk_index + number_of_batch_chunks - 1 );
+
+				goto on_error;
+			}
+		}
+		else
+#endif
+		{
+			for( batch_index = 0;
+			     batch_index < number_of_batch_chunks;
+			     batch_index++ )
+			{
+				if( batch_chunk_data[ batch_index ] == NULL )
+				{
+					continue;
+				}
+				if( libewf_chunk_data_unpack(
+				     batch_chunk_data[ batch_index ],
+				     internal_handle->io_handle,
+				     NULL,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GENERIC,
+					 "%s: unable to unpack chunk: %" PRIu64 " data.",
+					 function,
+					 internal_handle->current_chunk_index + batch_index );
+
+					goto on_error;
+				}
+			}
+		}
+		for( batch_index = 0;
+		     batch_index < number_of_batch_chunks;
+		     batch_index++ )
+		{
+			chunk_data = batch_chunk_data[ batch_index ];
+
+			if( chunk_data == NULL )
+			{
+				/* Missing and sparse chunks are handled by the chunk table
+				 */
+				if( libewf_chunk_table_get_chunk_data_by_offset(
+				     internal_handle->chunk_table,
+				     internal_handle->current_chunk_index,
+				     internal_handle->io_handle,
+				     file_io_pool,
+				     internal_handle->media_values,
+				     internal_handle->segment_table,
+				     internal_handle->chunk_groups_cache,
+				     internal_handle->chunks_cache,
+				     internal_handle->current_offset,
+				     &chunk_data,
+				     &chunk_data_offset,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve chunk: %" PRIu64 " data.",
+					 function,
+					 internal_handle->current_chunk_index );
+
+					goto on_error;
+				}
+				if( chunk_data == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+					 "%s: missing chunk: %" PRIu64 " data.",
+					 function,
+					 internal_handle->current_chunk_index );
+
+					goto on_error;
+				}
+			}
+			else if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+			{
+				if( libewf_internal_handle_append_chunk_checksum_error(
+				     internal_handle,
+				     internal_handle->current_chunk_index,
+				     chunk_data,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append chunk: %" PRIu64 " checksum error.",
+					 function,
+					 internal_handle->current_chunk_index );
+
+					goto on_error;
+				}
+			}
+			if( libewf_internal_data_chunk_set_chunk_data(
+			     (libewf_internal_data_chunk_t *) data_chunks[ data_chunk_index ],
+			     internal_handle->current_chunk_index,
+			     chunk_data,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set chunk: %" PRIu64 " data in data chunk: %d.",
+				 function,
+				 internal_handle->current_chunk_index,
+				 data_chunk_index );
+
+				goto on_error;
+			}
+			internal_handle->current_offset += (off64_t) chunk_data->data_size;
+
+			internal_handle->current_chunk_index++;
+
+			data_chunk_index++;
+
+			chunk_data = NULL;
+
+			if( batch_chunk_data[ batch_index ] != NULL )
+			{
+				if( libewf_chunk_data_free(
+				     &( batch_chunk_data[ batch_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free batch chunk data: %d.",
+					 function,
+					 batch_index );
+
+					goto on_error;
+				}
+			}
+		}
+		if( internal_handle->io_handle->abort != 0 )
+		{
+			break;
+		}
+	}
+	memory_free(
+	 batch_chunk_data );
+
+	return( data_chunk_index );
+
+on_error:
+	if( batch_chunk_data != NULL )
+	{
+		for( batch_index = 0;
+		     batch_index < maximum_number_of_batch_chunks;
+		     batch_index++ )
+		{
+			if( batch_chunk_data[ batch_index ] != NULL )
+			{
+				libewf_chunk_data_free(
+				 &( batch_chunk_data[ batch_index ] ),
+				 NULL );
+			}
+		}
+		memory_free(
+		 batch_chunk_data );
+	}
+	return( -1 );
+}
+
+/* Reads (media) data chunks at the current offset
+ * The data chunks are read in order, the first data chunk contains the chunk at the current offset
+ * Returns the number of data chunks read, 0 when no longer data can be read or -1 on error
+ */
+int libewf_handle_read_data_chunks(
+     libewf_handle_t *handle,
+     libewf_data_chunk_t **data_chunks,
+     int number_of_data_chunks,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_read_data_chunks";
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_internal_handle_read_data_chunks_from_file_io_pool(
+	          internal_handle,
+	          internal_handle->file_io_pool,
+	          data_chunks,
+	          number_of_data_chunks,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data chunks.",
+		 function );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Frees the chunk data of the current batch of the stream reader
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_stream_free_chunk_data(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_stream_free_chunk_data";
+	int batch_index       = 0;
+	int result            = 1;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->stream_chunk_data != NULL )
+	{
+		for( batch_index = 0;
+		     batch_index < internal_handle->stream_maximum_number_of_chunks;
+		     batch_index++ )
+		{
+			if( internal_handle->stream_chunk_data[ batch_index ] != NULL )
+			{
+				if( libewf_chunk_data_free(
+				     &( internal_handle->stream_chunk_data[ batch_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free stream chunk data: %d.",
+					 function,
+					 batch_index );
+
+					result = -1;
+				}
+			}
+		}
+	}
+	internal_handle->stream_number_of_chunks = 0;
+	internal_handle->stream_chunk_index      = 0;
+
+	return( result );
+}
+
+/* Reads and unpacks a batch of chunks for the stream reader
+ * The packed data of consecutive chunks is read with coalesced reads and the chunks
+ * are unpacked, using the chunk unpacker if multiple threads are set
+ * The entries of missing and sparse chunks are set to NULL, these are handled by the chunk table
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_stream_read_chunk_data(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t chunk_index,
+     libcerror_error_t **error )
+{
+	static char *function      = "libewf_internal_handle_stream_read_chunk_data";
+	uint64_t number_of_chunks  = 0;
+	int batch_index            = 0;
+	int number_of_batch_chunks = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	int use_chunk_unpacker     = 0;
+#endif
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->stream_chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing stream chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->media_values == NULL )
+	 || ( internal_handle->media_values->chunk_size == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_internal_handle_stream_free_chunk_data(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free stream chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	/* Do not read beyond the last chunk
+	 */
+	number_of_chunks = ( internal_handle->media_values->media_size
+	                   + internal_handle->media_values->chunk_size - 1 )
+	                 / internal_handle->media_values->chunk_size;
+
+	if( chunk_index >= number_of_chunks )
+	{
+		return( 1 );
+	}
+	number_of_chunks -= chunk_index;
+
+	if( number_of_chunks > (uint64_t) internal_handle->stream_maximum_number_of_chunks )
+	{
+		number_of_chunks = (uint64_t) internal_handle->stream_maximum_number_of_chunks;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The chunk unpacker can have been recreated with a different number of threads
+	 */
+	if( ( internal_handle->number_of_threads > 1 )
+	 && ( internal_handle->chunk_unpacker != NULL ) )
+	{
+		if( number_of_chunks > (uint64_t) internal_handle->chunk_unpacker->maximum_number_of_chunks )
+		{
+			number_of_chunks = (uint64_t) internal_handle->chunk_unpacker->maximum_number_of_chunks;
+		}
+		use_chunk_unpacker = 1;
+	}
+#endif
+	number_of_batch_chunks = (int) number_of_chunks;
+
+	if( libewf_internal_handle_read_packed_chunks_data(
+	     internal_handle,
+	     file_io_pool,
+	     chunk_index,
+	     internal_handle->stream_chunk_data,
+	     number_of_batch_chunks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunks: %" PRIu64 " - %" PRIu64 " data.",
+		 function,
+		 chunk_index,
+		 chunk_index + number_of_batch_chunks - 1 );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( use_chunk_unpacker != 0 )
+	{
+		if( libewf_chunk_unpacker_unpack(
+		     internal_handle->chunk_unpacker,
+		     internal_handle->stream_chunk_data,
+		     number_of_batch_chunks,
+		     internal_handle->read_priority,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to unpack chunks: %" PRIu64 " - %" PRIu64 " data.",
+			 function,
+			 chunk_index,
+			 chunk_index + number_of_batch_chunks - 1 );
+
+			goto on_error;
+		}
+	}
+	else
+#endif
+	{
+		for( batch_index = 0;
+		     batch_index < number_of_batch_chunks;
+		     batch_index++ )
+		{
+			if( internal_handle->stream_chunk_data[ batch_index ] == NULL )
+			{
+				continue;
+			}
+			if( libewf_chunk_data_unpack(
+			     internal_handle->stream_chunk_data[ batch_index ],
+			     internal_handle->io_handle,
+			     NULL,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to unpack chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index + batch_index );
+
+				goto on_error;
+			}
+		}
+	}
+	for( batch_index = 0;
+	     batch_index < number_of_batch_chunks;
+	     batch_index++ )
+	{
+		if( internal_handle->stream_chunk_data[ batch_index ] == NULL )
+		{
+			continue;
+		}
+		if( ( internal_handle->stream_chunk_data[ batch_index ]->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+		{
+			if( libewf_internal_handle_append_chunk_checksum_error(
+			     internal_handle,
+			     chunk_index + batch_index,
+			     internal_handle->stream_chunk_data[ batch_index ],
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append chunk: %" PRIu64 " checksum error.",
+				 function,
+				 chunk_index + batch_index );
+
+				goto on_error;
+			}
+		}
+	}
+	internal_handle->stream_chunk_index      = chunk_index;
+	internal_handle->stream_number_of_chunks = number_of_batch_chunks;
+
+	return( 1 );
+
+on_error:
+	libewf_internal_handle_stream_free_chunk_data(
+	 internal_handle,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Reads (media) data at the current offset into a buffer using the stream reader
+ * The unpacked chunks of the current batch are retained between reads,
+ * the chunk cache and the chunks cache are only used for missing and sparse chunks
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_internal_handle_stream_read_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_internal_handle_stream_read_from_file_io_pool";
+	off64_t chunk_data_offset       = 0;
+	size_t buffer_offset            = 0;
+	size_t read_size                = 0;
+	ssize_t total_read_count        = 0;
+	uint64_t chunk_index            = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->stream_chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - stream reader not opened.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->media_values == NULL )
+	 || ( internal_handle->media_values->chunk_size == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( ( buffer_size > 0 )
+	    && ( (size64_t) internal_handle->current_offset < internal_handle->media_values->media_size ) )
+	{
+		chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+
+		if( ( chunk_index < internal_handle->stream_chunk_index )
+		 || ( chunk_index >= ( internal_handle->stream_chunk_index + internal_handle->stream_number_of_chunks ) ) )
+		{
+			if( internal_handle->io_handle->abort != 0 )
+			{
+				break;
+			}
+			if( libewf_internal_handle_stream_read_chunk_data(
+			     internal_handle,
+			     file_io_pool,
+			     chunk_index,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read stream chunk data.",
+				 function );
+
+				return( -1 );
+			}
+			if( internal_handle->stream_number_of_chunks == 0 )
+			{
+				break;
+			}
+		}
+		chunk_data = internal_handle->stream_chunk_data[ chunk_index - internal_handle->stream_chunk_index ];
+
+		if( chunk_data == NULL )
+		{
+			/* Missing and sparse chunks are handled by the chunk table
+			 */
+			if( libewf_chunk_table_get_chunk_data_by_offset(
+			     internal_handle->chunk_table,
+			     chunk_index,
+			     internal_handle->io_handle,
+			     file_io_pool,
+			     internal_handle->media_values,
+			     internal_handle->segment_table,
+			     internal_handle->chunk_groups_cache,
+			     internal_handle->chunks_cache,
+			     internal_handle->current_offset,
+			     &chunk_data,
+			     &chunk_data_offset,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to read chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			if( chunk_data == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+		}
+		else
+		{
+			chunk_data_offset = internal_handle->current_offset % internal_handle->media_values->chunk_size;
+		}
+		if( (off64_t) chunk_data_offset > (off64_t) chunk_data->data_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: chunk: %" PRIu64 " offset exceeds data size.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		read_size = (size_t) ( chunk_data->data_size - chunk_data_offset );
+
+		if( read_size > buffer_size )
+		{
+			read_size = buffer_size;
+		}
+		if( read_size == 0 )
+		{
+			break;
+		}
+		if( memory_copy(
+		     &( buffer[ buffer_offset ] ),
+		     &( ( chunk_data->data )[ chunk_data_offset ] ),
+		     read_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		buffer_offset    += read_size;
+		buffer_size      -= read_size;
+		total_read_count += (ssize_t) read_size;
+
+		internal_handle->current_offset += (off64_t) read_size;
+
+		chunk_data = NULL;
+	}
+	internal_handle->current_chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+
+	return( total_read_count );
+}
+
+/* Closes the stream reader
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_stream_close(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_stream_close";
+	int result            = 1;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->stream_chunk_data == NULL )
+	{
+		return( 1 );
+	}
+	if( libewf_internal_handle_stream_free_chunk_data(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free stream chunk data.",
+		 function );
+
+		result = -1;
+	}
+	memory_free(
+	 internal_handle->stream_chunk_data );
+
+	internal_handle->stream_chunk_data               = NULL;
+	internal_handle->stream_maximum_number_of_chunks = 0;
+
+	return( result );
+}
+
+/* Opens the stream reader
+ * The stream reader reads (media) data sequentially from the current offset,
+ * the chunks are read with coalesced reads and unpacked in batches
+ * without the use of the chunk caches
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_stream_open(
+     libewf_handle_t *handle,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_stream_open";
+	size_t array_size                         = 0;
+	int maximum_number_of_chunks              = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->file_io_pool == NULL )
+	 || ( internal_handle->read_io_handle == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - handle not opened for reading.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->write_io_handle != NULL )
+	 || ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_METADATA ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid handle - stream reader can only be opened when opened for reading media data.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->stream_chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - stream reader already opened.",
+		 function );
+
+		goto on_error;
+	}
+	if( internal_handle->chunk_view_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk view data set.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( internal_handle->number_of_threads > 1 )
+	{
+		if( internal_handle->chunk_unpacker == NULL )
+		{
+			if( libewf_chunk_unpacker_initialize(
+			     &( internal_handle->chunk_unpacker ),
+			     internal_handle->io_handle,
+			     internal_handle->number_of_threads,
+			     internal_handle->scheduler,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create chunk unpacker.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		maximum_number_of_chunks = internal_handle->chunk_unpacker->maximum_number_of_chunks;
+	}
+	else
+#endif
+	{
+		maximum_number_of_chunks = LIBEWF_STREAM_NUMBER_OF_CHUNKS_PER_BATCH;
+	}
+	array_size = sizeof( libewf_chunk_data_t * ) * maximum_number_of_chunks;
+
+	internal_handle->stream_chunk_data = (libewf_chunk_data_t **) memory_allocate(
+	                                                               array_size );
+
+	if( internal_handle->stream_chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create stream chunk data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_handle->stream_chunk_data,
+	     0,
+	     array_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear stream chunk data.",
+		 function );
+
+		goto on_error;
+	}
+	internal_handle->stream_maximum_number_of_chunks = maximum_number_of_chunks;
+	internal_handle->stream_number_of_chunks         = 0;
+	internal_handle->stream_chunk_index              = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( ( internal_handle->stream_chunk_data != NULL )
+	 && ( internal_handle->stream_maximum_number_of_chunks == 0 ) )
+	{
+		memory_free(
+		 internal_handle->stream_chunk_data );
+
+		internal_handle->stream_chunk_data = NULL;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Reads (media) data at the current offset into a buffer using the stream reader
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_handle_stream_read(
+         libewf_handle_t *handle,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_stream_read";
+	ssize_t read_count                        = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libewf_internal_handle_stream_read_from_file_io_pool(
+	              internal_handle,
+	              internal_handle->file_io_pool,
+	              (uint8_t *) buffer,
+	              buffer_size,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Closes the stream reader
+ * Returns 0 if successful or -1 on error
+ */
+int libewf_handle_stream_close(
+     libewf_handle_t *handle,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_stream_close";
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libewf_internal_handle_stream_close(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to close stream reader.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Writes a (media) data chunk at the current offset
+ * A data chunk ahead of the next chunk to write is held, within the maximum number
+ * of out of order chunks, and written once the preceding chunks have been written
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_internal_handle_write_data_chunk_to_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_internal_data_chunk_t *internal_data_chunk,
+         libcerror_error_t **error )
+{
+	static char *function            = "libewf_internal_handle_write_data_chunk_to_file_io_pool";
+	size_t data_size                 = 0;
+	ssize_t out_of_order_write_count = 0;
+	ssize_t write_count              = 0;
+	int chunk_exists                 = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing subhandle write.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	/* Chunks written by write buffer that are still pending precede the data chunk
+	 */
+	if( internal_handle->number_of_pending_chunks > 0 )
+	{
+		if( libewf_internal_handle_write_pending_chunks(
+		     internal_handle,
+		     file_io_pool,
+		     error ) < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write pending chunks.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+	{
+		return( 0 );
+	}
+	data_size = internal_data_chunk->data_size;
+
+	if( internal_handle->media_values->media_size != 0 )
+	{
+		if( (size64_t) ( internal_handle->current_offset + data_size ) > internal_handle->media_values->media_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: last data chunk size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+	}
+/* TODO remove need to calculate */
+	internal_handle->current_chunk_index = internal_handle->current_offset
+	                                     / internal_handle->media_values->chunk_size;
+
+	internal_handle->current_offset = (off64_t) internal_handle->current_chunk_index
+	                                * (off64_t) internal_handle->media_values->chunk_size;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: writing chunk: %" PRIu64 " of size: %" PRIzd ".\n",
+		 function,
+		 internal_handle->current_chunk_index,
+		 data_size );
+	}
+#endif
+	chunk_exists = libewf_chunk_table_chunk_exists_for_offset(
+	                internal_handle->chunk_table,
+	                internal_handle->current_chunk_index,
+	                file_io_pool,
+	                internal_handle->segment_table,
+	                internal_handle->chunk_groups_cache,
+	                internal_handle->current_offset,
+			error );
+
+	if( chunk_exists == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if the chunk: %" PRIu64 " exists.",
+		 function,
+		 internal_handle->current_chunk_index );
+
+		return( -1 );
+	}
+	else if( chunk_exists != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: chunk: %" PRIu64 " already exists.",
+		 function,
+		 internal_handle->current_chunk_index );
+
+		return( -1 );
+	}
+	if( internal_handle->current_chunk_index < internal_handle->write_io_handle->number_of_chunks_written )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: chunk: %" PRIu64 " already written.",
+		 function,
+		 internal_handle->current_chunk_index );
+
+		return( -1 );
+	}
+	/* A chunk that is ahead of the next chunk to write is held until the chunks
+	 * that precede it have been written, since the chunks are stored in order
+	 */
+	if( internal_handle->current_chunk_index > internal_handle->write_io_handle->number_of_chunks_written )
+	{
+		if( libewf_internal_handle_append_out_of_order_chunk(
+		     internal_handle,
+		     internal_handle->current_chunk_index,
+		     internal_data_chunk->chunk_data,
+		     data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append out of order chunk: %" PRIu64 ".",
+			 function,
+			 internal_handle->current_chunk_index );
+
+			return( -1 );
+		}
+		internal_handle->current_offset += (off64_t) data_size;
+
+		return( (ssize_t) data_size );
+	}
+	write_count = libewf_write_io_handle_write_new_chunk(
+	               internal_handle->write_io_handle,
+	               internal_handle->io_handle,
+	               file_io_pool,
+	               internal_handle->media_values,
+	               internal_handle->segment_table,
+	               internal_handle->header_values,
+	               internal_handle->hash_values,
+	               internal_handle->hash_sections,
+	               internal_handle->sessions,
+	               internal_handle->tracks,
+	               internal_handle->acquiry_errors,
+	               internal_handle->current_chunk_index,
+	               internal_data_chunk->chunk_data,
+	               data_size,
+	               error );
+
+	if( write_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle->current_offset += (off64_t) data_size;
+
+	if( internal_handle->number_of_out_of_order_chunks > 0 )
+	{
+		out_of_order_write_count = libewf_internal_handle_write_out_of_order_chunks(
+		                            internal_handle,
+		                            file_io_pool,
+		                            error );
+
+		if( out_of_order_write_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write out of order chunks.",
+			 function );
+
+			return( -1 );
+		}
+		write_count += out_of_order_write_count;
+	}
+	return( write_count );
+}
+
+/* Writes a (media) data chunk at the current offset
+ * The data chunk is packed first if this was not done by libewf_data_chunk_write_buffer
+ * or libewf_data_chunk_pack
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_handle_write_data_chunk(
+         libewf_handle_t *handle,
+         libewf_data_chunk_t *data_chunk,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_data_chunk";
+	ssize_t write_count                       = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	/* A data chunk that was not packed by the caller is packed before the handle is locked
+	 * so that the write only appends the packed chunk data
+	 */
+	if( libewf_data_chunk_pack(
+	     data_chunk,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to pack data chunk.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	write_count = libewf_internal_handle_write_data_chunk_to_file_io_pool(
+	               internal_handle,
+	               internal_handle->file_io_pool,
+	               (libewf_internal_data_chunk_t *) data_chunk,
+	               error );
+
+	if( write_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write data chunk.",
+		 function );
+
+		write_count = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+}
+
+/* Finalizes the write by correcting the EWF the meta data in the segment files
+ * This function is required after write from stream
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_internal_handle_write_finalize_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libcerror_error_t **error )
+{
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_internal_handle_write_finalize_file_io_pool";
+	size64_t segment_file_size          = 0;
+	size_t input_data_size              = 0;
+	ssize_t write_count                 = 0;
+	ssize_t write_finalize_count        = 0;
+	uint64_t chunk_index                = 0;
+	uint32_t number_of_segments         = 0;
+	uint32_t segment_number             = 0;
+	int chunk_exists                    = 0;
+	int file_io_pool_entry              = -1;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	{
+		if( internal_handle->chunk_data != NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid handle - chunk data set.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle->write_finalized != 0 )
+	{
+		return( 0 );
+	}
+	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	{
+		return( 0 );
+	}
+	if( internal_handle->number_of_pending_chunks > 0 )
+	{
+		write_count = libewf_internal_handle_write_pending_chunks(
+		               internal_handle,
+		               file_io_pool,
+		               error );
+
+		if( write_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write pending chunks.",
+			 function );
+
+			return( -1 );
+		}
+		write_finalize_count += write_count;
+	}
+	if( internal_handle->number_of_out_of_order_chunks > 0 )
+	{
+		write_count = libewf_internal_handle_write_out_of_order_chunks(
+		               internal_handle,
+		               file_io_pool,
+		               error );
+
+		if( write_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write out of order chunks.",
+			 function );
+
+			return( -1 );
+		}
+		write_finalize_count += write_count;
+
+		if( internal_handle->number_of_out_of_order_chunks > 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing chunk: %" PRIu64 " preceding out of order chunks.",
+			 function,
+			 internal_handle->write_io_handle->number_of_chunks_written );
+
+			return( -1 );
+		}
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+
+		chunk_exists = libewf_chunk_table_chunk_exists_for_offset(
+				internal_handle->chunk_table,
+				chunk_index,
+				file_io_pool,
+				internal_handle->segment_table,
+				internal_handle->chunk_groups_cache,
+				internal_handle->current_offset,
+				error );
+
+		if( chunk_exists == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if the chunk: %" PRIu64 " exists.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		if( chunk_exists != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: chunk: %" PRIu64 " already exists.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		input_data_size = internal_handle->chunk_data->data_size;
+
+		if( libewf_chunk_data_pack(
+		     internal_handle->chunk_data,
+		     internal_handle->io_handle,
+		     internal_handle->chunk_table->compression_context,
+		     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
+		     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
+		     internal_handle->write_io_handle->pack_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to pack chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		write_count = libewf_write_io_handle_write_new_chunk(
+			       internal_handle->write_io_handle,
+			       internal_handle->io_handle,
+			       file_io_pool,
+			       internal_handle->media_values,
+			       internal_handle->segment_table,
+			       internal_handle->header_values,
+			       internal_handle->hash_values,
+			       internal_handle->hash_sections,
+			       internal_handle->sessions,
+			       internal_handle->tracks,
+			       internal_handle->acquiry_errors,
+			       chunk_index,
+			       internal_handle->chunk_data,
+			       input_data_size,
+			       error );
+
+		if( write_count <= 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write new chunk.",
+			 function );
+
+			return( -1 );
+		}
+		write_finalize_count += write_count;
+
+		if( libfcache_cache_set_value_by_index(
+		     internal_handle->chunks_cache,
+		     chunk_index % LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNKS,
+		     0,
+		     internal_handle->current_offset,
+		     0,
+		     (intptr_t *) internal_handle->chunk_data,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_data_free,
+		     LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		/* chunks_cache takes over management of chunk_data
+		 */
+		internal_handle->chunk_data = NULL;
+	}
+	/* Check if all media data has been written
+	 */
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( internal_handle->write_io_handle->input_write_count < (ssize64_t) internal_handle->media_values->media_size ) )
+	{
+		return( write_finalize_count );
+	}
+	if( libewf_segment_table_get_number_of_segments(
+	     internal_handle->segment_table,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_segments == 0 )
+	{
+		/* No segment file needs to be created
+		 */
+/* TODO clean up this logic: when is this triggered? */
+		if( internal_handle->media_values->media_size != 0 )
+		{
+			return( write_finalize_count );
+		}
+		/* Create the segment file if required
+		 */
+		if( libewf_write_io_handle_create_segment_file(
+		     internal_handle->write_io_handle,
+		     internal_handle->io_handle,
+		     file_io_pool,
+		     internal_handle->segment_table,
+		     internal_handle->io_handle->segment_file_type,
+		     0,
+		     internal_handle->write_io_handle->maximum_number_of_segments,
+		     internal_handle->media_values->set_identifier,
+		     &file_io_pool_entry,
+		     &segment_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to create segment file: 0.",
+			 function );
+
+			return( -1 );
+		}
+		write_count = libewf_segment_file_write_start(
+		               segment_file,
+		               file_io_pool,
+		               file_io_pool_entry,
+		               &( internal_handle->write_io_handle->case_data ),
+		               &( internal_handle->write_io_handle->case_data_size ),
+		               &( internal_handle->write_io_handle->device_information ),
+		               &( internal_handle->write_io_handle->device_information_size ),
+		               &( internal_handle->write_io_handle->data_section ),
+		               internal_handle->media_values,
+		               internal_handle->header_values,
+		               internal_handle->write_io_handle->timestamp,
+		               error );
+
+		if( write_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write segment file: 0 start.",
+			 function );
+
+			return( -1 );
+		}
+		write_finalize_count += write_count;
+	}
+	else
+	{
+		segment_number = number_of_segments - 1;
+
+		if( libewf_segment_table_get_segment_by_index(
+		     internal_handle->segment_table,
+		     segment_number,
+		     &file_io_pool_entry,
+		     &segment_file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		if( libewf_segment_table_get_segment_file_by_index(
+		     internal_handle->segment_table,
+		     segment_number,
+		     file_io_pool,
+		     &segment_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		if( segment_file == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing segment file: %" PRIu32 ".",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+	}
+	/* Set segment file to the correct offset if write is resumed
+	 */
+	if( internal_handle->write_io_handle->resume_segment_file_offset > 0 )
+	{
+		if( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_SEQUENTIAL ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unable to seek resume segment file offset on sequential write.",
+			 function );
+
+			return( -1 );
+		}
+		if( libbfio_pool_seek_offset(
+		     file_io_pool,
+		     file_io_pool_entry,
+		     internal_handle->write_io_handle->resume_segment_file_offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to seek resume segment file offset: %" PRIi64 " in segment file: %" PRIu32 ".",
+			 function,
+			 internal_handle->write_io_handle->resume_segment_file_offset,
+			 segment_number );
+
+			return( -1 );
+		}
+		internal_handle->write_io_handle->resume_segment_file_offset = 0;
+	}
+	/* Check if the last segment file is still open for writing
+	 */
+	if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_WRITE_OPEN ) != 0 )
+	{
+		/* Check if chunks section needs to be corrected
+		 */
+		if( internal_handle->write_io_handle->chunks_section_offset != 0 )
+		{
+			write_count = libewf_write_io_handle_write_chunks_section_end(
+			               internal_handle->write_io_handle,
+			               internal_handle->io_handle,
+				       file_io_pool,
+				       file_io_pool_entry,
+			               segment_file,
+			               error );
+
+			if( write_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write chunks section end.",
+				 function );
+
+				return( -1 );
+			}
+			write_finalize_count += write_count;
+		}
+		/* Close the segment file
+		 */
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: closing last segment file.\n",
+			 function );
+		}
+#endif
+		write_count = libewf_segment_file_write_close(
+		               segment_file,
+		               file_io_pool,
+		               file_io_pool_entry,
+		               internal_handle->write_io_handle->number_of_chunks_written_to_segment_file,
+		               1,
+		               internal_handle->hash_sections,
+		               internal_handle->hash_values,
+		               internal_handle->media_values,
+		               internal_handle->sessions,
+		               internal_handle->tracks,
+		               internal_handle->acquiry_errors,
+		               &( internal_handle->write_io_handle->data_section ),
+		               error );
+
+		if( write_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to close segment file.",
+			 function );
+
+			return( -1 );
+		}
+		LIBEWF_TRACE_SEGMENT_FILE_FINALIZE(
+		 segment_file->segment_number,
+		 write_count );
+
+		write_finalize_count += write_count;
+
+		if( libewf_write_io_handle_sync_segment_file(
+		     internal_handle->write_io_handle,
+		     internal_handle->io_handle,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to synchronize last segment file.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* Correct the media values if streamed write was used
+	 */
+	if( internal_handle->media_values->media_size == 0 )
+	{
+		/* Correcting the sections requires seeking back in the segment files
+		 */
+		if( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_SEQUENTIAL ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unable to correct sections of streamed write on sequential write.",
+			 function );
+
+			return( -1 );
+		}
+		/* Determine the media values
+		 */
+		internal_handle->media_values->number_of_chunks  = internal_handle->write_io_handle->number_of_chunks_written;
+		internal_handle->media_values->number_of_sectors = (uint64_t) ( internal_handle->write_io_handle->input_write_count / internal_handle->media_values->bytes_per_sector );
+		internal_handle->media_values->media_size        = (size64_t) internal_handle->write_io_handle->input_write_count;
+
+		/* Flush the section write caches
+		 */
+		if( internal_handle->write_io_handle->case_data != NULL )
+		{
+			memory_free(
+			 internal_handle->write_io_handle->case_data );
+
+			internal_handle->write_io_handle->case_data      = NULL;
+			internal_handle->write_io_handle->case_data_size = 0;
+		}
+		if( internal_handle->write_io_handle->device_information != NULL )
+		{
+			memory_free(
+			 internal_handle->write_io_handle->device_information );
+
+			internal_handle->write_io_handle->device_information      = NULL;
+			internal_handle->write_io_handle->device_information_size = 0;
+		}
+		if( internal_handle->write_io_handle->data_section != NULL )
+		{
+			memory_free(
+			 internal_handle->write_io_handle->data_section );
+
+			internal_handle->write_io_handle->data_section = NULL;
+		}
+		/* Correct the sections in the segment files
+		 */
+		if( libewf_write_io_handle_finalize_write_sections_corrections(
+		     internal_handle->write_io_handle,
+		     file_io_pool,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     internal_handle->header_values,
+		     internal_handle->hash_values,
+		     internal_handle->hash_sections,
+		     internal_handle->sessions,
+		     internal_handle->tracks,
+		     internal_handle->acquiry_errors,
+		     internal_handle->number_of_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write sections corrections to segment files.",
+			 function );
+
+			return( -1 );
+		}
+		if( libewf_write_io_handle_sync_segment_files(
+		     internal_handle->write_io_handle,
+		     internal_handle->io_handle,
+		     file_io_pool,
+		     internal_handle->segment_table,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to synchronize segment files.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	internal_handle->write_io_handle->write_finalized = 1;
+
+	return( write_finalize_count );
+}
+
+/* Finalizes the write by correcting the EWF the meta data in the segment files
+ * This function is required after write from stream
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_handle_write_finalize(
+         libewf_handle_t *handle,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_finalize";
+	ssize_t write_count                       = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	write_count = libewf_internal_handle_write_finalize_file_io_pool(
+	               internal_handle,
+	               internal_handle->file_io_pool,
+	               error );
+
+	if( write_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to write finalize.",
+		 function );
+
+		write_count = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+}
+
+/* Seeks a certain offset of the (media) data
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libewf_internal_handle_seek_offset(
+         libewf_internal_handle_t *internal_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_seek_offset";
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{	
+		offset += internal_handle->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{	
+		offset += (off64_t) internal_handle->media_values->media_size;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: seeking media data offset: %" PRIi64 ".\n",
+		 function,
+		 offset );
+	}
+#endif
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle->current_offset = offset;
+
+	return( offset );
+}
+
+/* Seeks a certain offset of the (media) data
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libewf_handle_seek_offset(
+         libewf_handle_t *handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_seek_offset";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	offset = libewf_internal_handle_seek_offset(
+	          internal_handle,
+	          offset,
+	          whence,
+	          error );
+
+	if( offset == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( offset );
+}
+
+/* Retrieves the current offset of the (media) data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_offset(
+     libewf_handle_t *handle,
+     off64_t *offset,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_offset";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*offset = internal_handle->current_offset;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the maximum number of (concurrent) open file handles
+ * If the handle shares the maximum number of open handles with other handles
+ * the shared maximum is set and redistributed over these handles
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_maximum_number_of_open_handles(
+     libewf_handle_t *handle,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_maximum_number_of_open_handles";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->file_io_pool_group != NULL )
+	{
+		result = libewf_file_io_pool_group_set_maximum_number_of_open_handles(
+		          internal_handle->file_io_pool_group,
+		          maximum_number_of_open_handles,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of open handles in file IO pool group.",
+			 function );
+		}
+	}
+	else if( internal_handle->file_io_pool != NULL )
+	{
+		result = libbfio_pool_set_maximum_number_of_open_handles(
+		          internal_handle->file_io_pool,
+		          maximum_number_of_open_handles,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of open handles in file IO pool.",
+			 function );
+		}
+	}
+	if( result == 1 )
+	{
+		internal_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the maximum number of cached chunks
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_set_maximum_number_of_cached_chunks(
+     libewf_internal_handle_t *internal_handle,
+     int maximum_number_of_cached_chunks,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_set_maximum_number_of_cached_chunks";
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_cached_chunks <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of cached chunks value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_view_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk view data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunks_cache != NULL )
+	{
+		if( libfcache_cache_resize(
+		     internal_handle->chunks_cache,
+		     maximum_number_of_cached_chunks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize chunks cache.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	internal_handle->maximum_number_of_cached_chunks = maximum_number_of_cached_chunks;
+
+	return( 1 );
+}
+
+/* Applies the maximum cache size to the chunks cache
+ * The maximum cache size can only be applied when the chunk size is known
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_apply_maximum_cache_size(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	static char *function                   = "libewf_internal_handle_apply_maximum_cache_size";
+	uint64_t maximum_number_of_cached_chunks = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->maximum_cache_size == 0 )
+	 || ( internal_handle->media_values->chunk_size == 0 ) )
+	{
+		return( 1 );
+	}
+	maximum_number_of_cached_chunks = internal_handle->maximum_cache_size
+	                                / internal_handle->media_values->chunk_size;
+
+	if( maximum_number_of_cached_chunks == 0 )
+	{
+		maximum_number_of_cached_chunks = 1;
+	}
+	else if( maximum_number_of_cached_chunks > (uint64_t) INT32_MAX )
+	{
+		maximum_number_of_cached_chunks = (uint64_t) INT32_MAX;
+	}
+	if( libewf_internal_handle_set_maximum_number_of_cached_chunks(
+	     internal_handle,
+	     (int) maximum_number_of_cached_chunks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set maximum number of cached chunks.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Applies the memory limit to the caches of the handle
+ * The memory used by the chunk index cannot be reclaimed and is subtracted from the memory limit,
+ * an eighth of the remainder is used for the chunk groups cache and the rest for the chunk data.
+ * The chunk data is shared between the chunks cache and, if created, the sharded chunk cache
+ * The memory limit can only be applied when the chunk size is known
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_apply_memory_limit(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	static char *function                          = "libewf_internal_handle_apply_memory_limit";
+	size64_t chunk_cache_size                      = 0;
+	size64_t chunk_groups_cache_size               = 0;
+	size64_t chunks_cache_size                     = 0;
+	size64_t chunks_index_size                     = 0;
+	size64_t memory_size                           = 0;
+	uint64_t maximum_number_of_cached_chunk_groups = 0;
+	uint64_t maximum_number_of_cached_chunks       = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->memory_limit == 0 )
+	 || ( internal_handle->media_values->chunk_size == 0 ) )
+	{
+		return( 1 );
+	}
+	if( ( internal_handle->chunk_table != NULL )
+	 && ( internal_handle->chunk_table->chunks_index != NULL ) )
+	{
+		if( libewf_chunk_index_get_memory_size(
+		     internal_handle->chunk_table->chunks_index,
+		     &chunks_index_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunks index memory size.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( chunks_index_size < internal_handle->memory_limit )
+	{
+		memory_size = internal_handle->memory_limit - chunks_index_size;
+	}
+	chunk_groups_cache_size = memory_size / 8;
+	chunks_cache_size       = memory_size - chunk_groups_cache_size;
+
+	maximum_number_of_cached_chunk_groups = chunk_groups_cache_size / LIBEWF_ESTIMATED_CHUNK_GROUP_SIZE;
+
+	if( maximum_number_of_cached_chunk_groups == 0 )
+	{
+		maximum_number_of_cached_chunk_groups = 1;
+	}
+	else if( maximum_number_of_cached_chunk_groups > (uint64_t) INT32_MAX )
+	{
+		maximum_number_of_cached_chunk_groups = (uint64_t) INT32_MAX;
+	}
+	if( internal_handle->chunk_groups_cache != NULL )
+	{
+		if( libfcache_cache_resize(
+		     internal_handle->chunk_groups_cache,
+		     (int) maximum_number_of_cached_chunk_groups,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize chunk groups cache.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	internal_handle->maximum_number_of_cached_chunk_groups = (int) maximum_number_of_cached_chunk_groups;
+
+	if( internal_handle->chunk_cache != NULL )
+	{
+		/* Concurrent reads use the sharded chunk cache hence it is given the larger part of the chunk data
+		 */
+		chunk_cache_size  = chunks_cache_size - ( chunks_cache_size / 4 );
+		chunks_cache_size = chunks_cache_size / 4;
+
+		/* A maximum cache size of 0 represents no maximum
+		 */
+		if( chunk_cache_size < (size64_t) internal_handle->media_values->chunk_size )
+		{
+			chunk_cache_size = (size64_t) internal_handle->media_values->chunk_size;
+		}
+		if( libewf_chunk_cache_set_maximum_cache_size(
+		     internal_handle->chunk_cache,
+		     chunk_cache_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set chunk cache maximum cache size.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* The chunks cache cannot be resized while the chunk view data is set
+	 */
+	if( internal_handle->chunk_view_data == NULL )
+	{
+		maximum_number_of_cached_chunks = chunks_cache_size
+		                                / internal_handle->media_values->chunk_size;
+
+		if( maximum_number_of_cached_chunks == 0 )
+		{
+			maximum_number_of_cached_chunks = 1;
+		}
+		else if( maximum_number_of_cached_chunks > (uint64_t) INT32_MAX )
+		{
+			maximum_number_of_cached_chunks = (uint64_t) INT32_MAX;
+		}
+		if( libewf_internal_handle_set_maximum_number_of_cached_chunks(
+		     internal_handle,
+		     (int) maximum_number_of_cached_chunks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of cached chunks.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the estimated size of the memory used by the caches of the handle in bytes
+ * The size of a cached chunk is estimated as the chunk size and the size of a cached
+ * chunk group as LIBEWF_ESTIMATED_CHUNK_GROUP_SIZE
+ * This function is not multi-thread safe acquire read lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_get_memory_usage(
+     libewf_internal_handle_t *internal_handle,
+     size64_t *memory_usage,
+     libcerror_error_t **error )
+{
+	static char *function      = "libewf_internal_handle_get_memory_usage";
+	size64_t memory_size       = 0;
+	size64_t safe_memory_usage = 0;
+	int number_of_cache_values = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_usage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory usage.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->chunks_cache != NULL )
+	 && ( internal_handle->media_values != NULL ) )
+	{
+		if( libfcache_cache_get_number_of_cache_values(
+		     internal_handle->chunks_cache,
+		     &number_of_cache_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of chunks cache values.",
+			 function );
+
+			return( -1 );
+		}
+		safe_memory_usage += (size64_t) number_of_cache_values * internal_handle->media_values->chunk_size;
+	}
+	if( internal_handle->chunk_groups_cache != NULL )
+	{
+		if( libfcache_cache_get_number_of_cache_values(
+		     internal_handle->chunk_groups_cache,
+		     &number_of_cache_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of chunk groups cache values.",
+			 function );
+
+			return( -1 );
+		}
+		safe_memory_usage += (size64_t) number_of_cache_values * LIBEWF_ESTIMATED_CHUNK_GROUP_SIZE;
+	}
+	if( internal_handle->chunk_cache != NULL )
+	{
+		if( libewf_chunk_cache_get_cache_size(
+		     internal_handle->chunk_cache,
+		     &memory_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk cache size.",
+			 function );
+
+			return( -1 );
+		}
+		safe_memory_usage += memory_size;
+	}
+	if( ( internal_handle->chunk_table != NULL )
+	 && ( internal_handle->chunk_table->chunks_index != NULL ) )
+	{
+		if( libewf_chunk_index_get_memory_size(
+		     internal_handle->chunk_table->chunks_index,
+		     &memory_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunks index memory size.",
+			 function );
+
+			return( -1 );
+		}
+		safe_memory_usage += memory_size;
+	}
+	*memory_usage = safe_memory_usage;
+
+	return( 1 );
+}
+
+/* Retrieves the maximum number of cached chunks
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_maximum_number_of_cached_chunks(
+     libewf_handle_t *handle,
+     int *maximum_number_of_cached_chunks,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_maximum_number_of_cached_chunks";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( maximum_number_of_cached_chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum number of cached chunks.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*maximum_number_of_cached_chunks = internal_handle->maximum_number_of_cached_chunks;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the maximum number of cached chunks
+ * If the handle is open the chunks cache is resized
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_maximum_number_of_cached_chunks(
+     libewf_handle_t *handle,
+     int maximum_number_of_cached_chunks,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_maximum_number_of_cached_chunks";
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_internal_handle_set_maximum_number_of_cached_chunks(
+	          internal_handle,
+	          maximum_number_of_cached_chunks,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set maximum number of cached chunks.",
+		 function );
+	}
+	else
+	{
+		/* An explicit number of cached chunks overrules the maximum cache size
+		 */
+		internal_handle->maximum_cache_size = 0;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the maximum number of cached chunk groups
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_maximum_number_of_cached_chunk_groups(
+     libewf_handle_t *handle,
+     int *maximum_number_of_cached_chunk_groups,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_maximum_number_of_cached_chunk_groups";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( maximum_number_of_cached_chunk_groups == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum number of cached chunk groups.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*maximum_number_of_cached_chunk_groups = internal_handle->maximum_number_of_cached_chunk_groups;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the maximum number of cached chunk groups
+ * If the handle is open the chunk groups cache is resized
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_maximum_number_of_cached_chunk_groups(
+     libewf_handle_t *handle,
+     int maximum_number_of_cached_chunk_groups,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_maximum_number_of_cached_chunk_groups";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( maximum_number_of_cached_chunk_groups <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of cached chunk groups value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->chunk_groups_cache != NULL )
+	{
+		result = libfcache_cache_resize(
+		          internal_handle->chunk_groups_cache,
+		          maximum_number_of_cached_chunk_groups,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize chunk groups cache.",
+			 function );
+		}
+	}
+	if( result == 1 )
+	{
+		internal_handle->maximum_number_of_cached_chunk_groups = maximum_number_of_cached_chunk_groups;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the maximum size of the chunks cache in bytes
+ * The maximum number of cached chunks is derived from the chunk size,
+ * if the chunk size is not yet known it is applied when the handle is opened
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_maximum_cache_size(
+     libewf_handle_t *handle,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_maximum_cache_size";
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( maximum_cache_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum cache size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_handle->maximum_cache_size = maximum_cache_size;
+
+	result = libewf_internal_handle_apply_maximum_cache_size(
+	          internal_handle,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to apply maximum cache size.",
+		 function );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the memory limit in bytes
+ * A memory limit of 0 represents no limit
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_memory_limit(
+     libewf_handle_t *handle,
+     size64_t *memory_limit,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_memory_limit";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( memory_limit == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory limit.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*memory_limit = internal_handle->memory_limit;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the memory limit in bytes
+ * The memory limit bounds the chunks, chunk groups and sharded chunk caches together
+ * and takes precedence over the maximum cache size. If the chunk size is not yet known
+ * the memory limit is applied when the handle is opened
+ * A memory limit of 0 removes the limit, the caches retain their current sizes
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_memory_limit(
+     libewf_handle_t *handle,
+     size64_t memory_limit,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_memory_limit";
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_handle->memory_limit = memory_limit;
+
+	result = libewf_internal_handle_apply_memory_limit(
+	          internal_handle,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to apply memory limit.",
+		 function );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the chunks cache statistics
+ * The number of cache hits and misses are counted since the handle was opened
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_chunks_cache_statistics(
+     libewf_handle_t *handle,
+     uint64_t *number_of_cache_hits,
+     uint64_t *number_of_cache_misses,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_chunks_cache_statistics";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_cache_hits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of cache hits.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_cache_misses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of cache misses.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*number_of_cache_hits   = internal_handle->chunk_table->number_of_cache_hits;
+	*number_of_cache_misses = internal_handle->chunk_table->number_of_cache_misses;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* The read ahead thread function
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_read_ahead_thread_function(
+     libewf_internal_handle_t *internal_handle )
+{
+	libcerror_error_t *error      = NULL;
+	static char *function         = "libewf_internal_handle_read_ahead_thread_function";
+	uint64_t chunk_index          = 0;
+	uint64_t end_chunk_index      = 0;
+	uint64_t prefetch_chunk_index = 0;
+	uint64_t start_chunk_index    = 0;
+	off64_t prefetch_offset       = 0;
+	uint8_t prefetch_chunk        = 0;
+	uint8_t prefetch_segment      = 0;
+	uint8_t stop_thread           = 0;
+	int result                    = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		goto on_error;
+	}
+	while( 1 )
+	{
+		if( libcthreads_mutex_grab(
+		     internal_handle->read_ahead_mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read ahead mutex.",
+			 function );
+
+			goto on_error;
+		}
+		while( ( internal_handle->read_ahead_stop == 0 )
+		    && ( internal_handle->read_ahead_prefetch == 0 )
+		    && ( internal_handle->read_ahead_start_chunk_index >= internal_handle->read_ahead_end_chunk_index )
+		    && ( internal_handle->prefetch_chunk_access_map == NULL ) )
+		{
+			if( libcthreads_condition_wait(
+			     internal_handle->read_ahead_condition,
+			     internal_handle->read_ahead_mutex,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for read ahead condition.",
+				 function );
+
+				libcthreads_mutex_release(
+				 internal_handle->read_ahead_mutex,
+				 NULL );
+
+				goto on_error;
+			}
+		}
+		start_chunk_index = internal_handle->read_ahead_start_chunk_index;
+		end_chunk_index   = internal_handle->read_ahead_end_chunk_index;
+		prefetch_segment  = internal_handle->read_ahead_prefetch;
+		prefetch_offset   = internal_handle->read_ahead_prefetch_offset;
+
+		stop_thread       = internal_handle->read_ahead_stop;
+		prefetch_chunk    = 0;
+
+		internal_handle->read_ahead_start_chunk_index = end_chunk_index;
+		internal_handle->read_ahead_prefetch          = 0;
+
+		if( stop_thread != 0 )
+		{
+			end_chunk_index  = start_chunk_index;
+			prefetch_segment = 0;
+		}
+		/* The chunks of the chunk access map are prefetched one at a time
+		 * and only when no read ahead or segment prefetch request is pending
+		 */
+		else if( ( start_chunk_index >= end_chunk_index )
+		      && ( prefetch_segment == 0 )
+		      && ( internal_handle->prefetch_chunk_access_map != NULL ) )
+		{
+			result = libewf_chunk_access_map_get_next_chunk_index(
+			          internal_handle->prefetch_chunk_access_map,
+			          internal_handle->read_ahead_prefetch_chunk_index,
+			          &prefetch_chunk_index,
+			          &error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve next chunk index from chunk access map.",
+				 function );
+
+				libcthreads_mutex_release(
+				 internal_handle->read_ahead_mutex,
+				 NULL );
+
+				goto on_error;
+			}
+			else if( result != 0 )
+			{
+				internal_handle->read_ahead_prefetch_chunk_index = prefetch_chunk_index + 1;
+
+				prefetch_chunk = 1;
+			}
+			else if( libewf_chunk_access_map_free(
+			          &( internal_handle->prefetch_chunk_access_map ),
+			          &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk access map.",
+				 function );
+
+				libcthreads_mutex_release(
+				 internal_handle->read_ahead_mutex,
+				 NULL );
+
+				goto on_error;
+			}
+		}
+		if( libcthreads_mutex_release(
+		     internal_handle->read_ahead_mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read ahead mutex.",
+			 function );
+
+			goto on_error;
+		}
+		if( stop_thread != 0 )
+		{
+			break;
+		}
+		/* The next segment file is prefetched before the chunks are read ahead
+		 * since the consumer is about to cross into it
+		 */
+		if( prefetch_segment != 0 )
+		{
+			if( libcthreads_read_write_lock_grab_for_write(
+			     internal_handle->read_write_lock,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to grab read/write lock for writing.",
+				 function );
+
+				goto on_error;
+			}
+			result = libewf_internal_handle_prefetch_segment(
+			          internal_handle,
+			          prefetch_offset,
+			          &error );
+
+			if( libcthreads_read_write_lock_release_for_write(
+			     internal_handle->read_write_lock,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release read/write lock for writing.",
+				 function );
+
+				goto on_error;
+			}
+			/* A segment file that cannot be prefetched is opened again when it is
+			 * needed by the consumer, which is also where the error is reported
+			 */
+			if( result != 1 )
+			{
+#if defined( HAVE_VERBOSE_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "%s: unable to prefetch segment file at offset: %" PRIi64 ".\n",
+					 function,
+					 prefetch_offset );
+
+					libcnotify_print_error_backtrace(
+					 error );
+				}
+#endif
+				libcerror_error_free(
+				 &error );
+			}
+		}
+		/* The handle lock is released after every chunk so the consumer
+		 * can retrieve a chunk as soon as it has been read ahead
+		 */
+		for( chunk_index = start_chunk_index;
+		     chunk_index < end_chunk_index;
+		     chunk_index++ )
+		{
+			/* The read ahead is background work that yields to the interactive reads
+			 * of the handle and its clones
+			 */
+			if( internal_handle->shared_state != NULL )
+			{
+				if( libewf_shared_state_wait_for_interactive_reads(
+				     internal_handle->shared_state,
+				     &( internal_handle->read_ahead_stop ),
+				     &error ) != 1 )
+				{
+					libcerror_error_set(
+					 &error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to wait for interactive reads.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			if( internal_handle->read_ahead_stop != 0 )
+			{
+				break;
+			}
+			/* When the handle has a chunk cache the chunks are read ahead into it
+			 * and are unpacked without holding the handle lock
+			 */
+			if( internal_handle->chunk_cache != NULL )
+			{
+				result = libewf_internal_handle_read_ahead_concurrent_chunk(
+				          internal_handle,
+				          chunk_index,
+				          &error );
+			}
+			else
+			{
+				if( libcthreads_read_write_lock_grab_for_write(
+				     internal_handle->read_write_lock,
+				     &error ) != 1 )
+				{
+					libcerror_error_set(
+					 &error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to grab read/write lock for writing.",
+					 function );
+
+					goto on_error;
+				}
+				result = libewf_internal_handle_read_ahead_chunk(
+				          internal_handle,
+				          chunk_index,
+				          &error );
+
+				if( libcthreads_read_write_lock_release_for_write(
+				     internal_handle->read_write_lock,
+				     &error ) != 1 )
+				{
+					libcerror_error_set(
+					 &error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to release read/write lock for writing.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			/* A chunk that cannot be read ahead is read again when it is requested
+			 * by the consumer, which is also where the error is reported
+			 */
+			if( result != 1 )
+			{
+#if defined( HAVE_VERBOSE_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "%s: unable to read ahead chunk: %" PRIu64 ".\n",
+					 function,
+					 chunk_index );
+
+					libcnotify_print_error_backtrace(
+					 error );
+				}
+#endif
+				libcerror_error_free(
+				 &error );
+
+				break;
+			}
+		}
+		if( prefetch_chunk != 0 )
+		{
+			if( internal_handle->shared_state != NULL )
+			{
+				if( libewf_shared_state_wait_for_interactive_reads(
+				     internal_handle->shared_state,
+				     &( internal_handle->read_ahead_stop ),
+				     &error ) != 1 )
+				{
+					libcerror_error_set(
+					 &error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to wait for interactive reads.",
+					 function );
+
+					goto on_error;
+				}
+			}
+		}
+		if( ( prefetch_chunk != 0 )
+		 && ( internal_handle->read_ahead_stop == 0 ) )
+		{
+			if( internal_handle->chunk_cache != NULL )
+			{
+				result = libewf_internal_handle_read_ahead_concurrent_chunk(
+				          internal_handle,
+				          prefetch_chunk_index,
+				          &error );
+			}
+			else
+			{
+				if( libcthreads_read_write_lock_grab_for_write(
+				     internal_handle->read_write_lock,
+				     &error ) != 1 )
+				{
+					libcerror_error_set(
+					 &error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to grab read/write lock for writing.",
+					 function );
+
+					goto on_error;
+				}
+				result = libewf_internal_handle_prefetch_chunk(
+				          internal_handle,
+				          prefetch_chunk_index,
+				          &error );
+
+				if( libcthreads_read_write_lock_release_for_write(
+				     internal_handle->read_write_lock,
+				     &error ) != 1 )
+				{
+					libcerror_error_set(
+					 &error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to release read/write lock for writing.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			/* A chunk that cannot be prefetched is read again when it is requested
+			 * by the consumer, which is also where the error is reported
+			 */
+			if( result != 1 )
+			{
+#if defined( HAVE_VERBOSE_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "%s: unable to prefetch chunk: %" PRIu64 ".\n",
+					 function,
+					 prefetch_chunk_index );
+
+					libcnotify_print_error_backtrace(
+					 error );
+				}
+#endif
+				libcerror_error_free(
+				 &error );
+			}
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Starts the read ahead thread
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_read_ahead_start(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_read_ahead_start";
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->read_ahead_thread != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - read ahead thread value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_initialize(
+	     &( internal_handle->read_ahead_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read ahead mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( internal_handle->read_ahead_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read ahead condition.",
+		 function );
+
+		goto on_error;
+	}
+	internal_handle->read_ahead_start_chunk_index = 0;
+	internal_handle->read_ahead_end_chunk_index   = 0;
+	internal_handle->read_ahead_stop              = 0;
+	internal_handle->read_ahead_prefetch_offset   = 0;
+	internal_handle->read_ahead_prefetch          = 0;
+
+	if( libcthreads_thread_create(
+	     &( internal_handle->read_ahead_thread ),
+	     NULL,
+	     (int (*)(void *)) &libewf_internal_handle_read_ahead_thread_function,
+	     (void *) internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read ahead thread.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( internal_handle->read_ahead_condition != NULL )
+	{
+		libcthreads_condition_free(
+		 &( internal_handle->read_ahead_condition ),
+		 NULL );
+	}
+	if( internal_handle->read_ahead_mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &( internal_handle->read_ahead_mutex ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Stops the read ahead thread
+ * The read ahead thread acquires the write lock, do not hold it when calling this function
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_read_ahead_stop(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_read_ahead_stop";
+	int result            = 1;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->read_ahead_thread == NULL )
+	{
+		return( 1 );
+	}
+	if( libcthreads_mutex_grab(
+	     internal_handle->read_ahead_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read ahead mutex.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle->read_ahead_stop = 1;
+
+	if( libcthreads_condition_broadcast(
+	     internal_handle->read_ahead_condition,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast read ahead condition.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     internal_handle->read_ahead_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read ahead mutex.",
+		 function );
+
+		return( -1 );
+	}
+	/* The read ahead thread can be waiting for the interactive reads of the clones
+	 */
+	if( internal_handle->shared_state != NULL )
+	{
+		if( libewf_shared_state_signal_interactive_reads(
+		     internal_handle->shared_state,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal interactive reads.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	if( libcthreads_thread_join(
+	     &( internal_handle->read_ahead_thread ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join read ahead thread.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_condition_free(
+	     &( internal_handle->read_ahead_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free read ahead condition.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_free(
+	     &( internal_handle->read_ahead_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free read ahead mutex.",
+		 function );
+
+		result = -1;
+	}
+	internal_handle->read_ahead_stop = 0;
+
+	return( result );
+}
+
+/* Marks the start of a read when the handle has the interactive read priority
+ * so that the read ahead of the handle and its clones yields to it
+ * This function is not multi-thread safe acquire read or write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_begin_interactive_read(
+     libewf_internal_handle_t *internal_handle,
+     uint8_t *is_interactive_read,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_begin_interactive_read";
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( is_interactive_read == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid is interactive read.",
+		 function );
+
+		return( -1 );
+	}
+	*is_interactive_read = 0;
+
+	if( ( internal_handle->read_priority != LIBEWF_READ_PRIORITY_INTERACTIVE )
+	 || ( internal_handle->shared_state == NULL ) )
+	{
+		return( 1 );
+	}
+	if( libewf_shared_state_begin_interactive_read(
+	     internal_handle->shared_state,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to begin interactive read.",
+		 function );
+
+		return( -1 );
+	}
+	*is_interactive_read = 1;
+
+	return( 1 );
+}
+
+/* Marks the end of a read started by libewf_internal_handle_begin_interactive_read
+ * This function is not multi-thread safe acquire read or write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_end_interactive_read(
+     libewf_internal_handle_t *internal_handle,
+     uint8_t is_interactive_read,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_end_interactive_read";
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( is_interactive_read == 0 )
+	 || ( internal_handle->shared_state == NULL ) )
+	{
+		return( 1 );
+	}
+	if( libewf_shared_state_end_interactive_read(
+	     internal_handle->shared_state,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to end interactive read.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* Reads ahead a specific chunk into the chunks cache
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_read_ahead_chunk(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_internal_handle_read_ahead_chunk";
+	off64_t chunk_data_offset       = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	/* The handle can be closed, a chunk view can be active or the chunk can already
+	 * be consumed or read ahead by the time the request is handled
+	 */
+	if( ( internal_handle->file_io_pool == NULL )
+	 || ( internal_handle->io_handle->abort != 0 )
+	 || ( internal_handle->chunk_view_data != NULL )
+	 || ( chunk_index >= internal_handle->media_values->number_of_chunks )
+	 || ( chunk_index < internal_handle->read_ahead_next_chunk_index )
+	 || ( chunk_index < internal_handle->read_ahead_last_chunk_index ) )
+	{
+		return( 1 );
+	}
+	if( libewf_internal_handle_read_segment_files_to_offset(
+	     internal_handle,
+	     internal_handle->file_io_pool,
+	     (off64_t) chunk_index * internal_handle->media_values->chunk_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read segment files up to offset: %" PRIi64 ".",
+		 function,
+		 (off64_t) chunk_index * internal_handle->media_values->chunk_size );
+
+		return( -1 );
+	}
+	if( libewf_chunk_table_get_chunk_data_by_offset(
+	     internal_handle->chunk_table,
+	     chunk_index,
+	     internal_handle->io_handle,
+	     internal_handle->file_io_pool,
+	     internal_handle->media_values,
+	     internal_handle->segment_table,
+	     internal_handle->chunk_groups_cache,
+	     internal_handle->chunks_cache,
+	     (off64_t) chunk_index * internal_handle->media_values->chunk_size,
+	     &chunk_data,
+	     &chunk_data_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to read chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	internal_handle->read_ahead_last_chunk_index = chunk_index + 1;
+
+	return( 1 );
+}
+
+/* Reads ahead a specific chunk into the chunk cache
+ * The chunk data is unpacked without holding the handle lock
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_read_ahead_concurrent_chunk(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_internal_handle_read_ahead_concurrent_chunk";
+	int result                      = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle->abort != 0 )
+	{
+		return( 1 );
+	}
+	/* The chunk can already have been read by the consumer
+	 */
+	result = libewf_chunk_cache_has_chunk_data(
+	          internal_handle->chunk_cache,
+	          internal_handle->chunk_cache_key_prefix | chunk_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if chunk: %" PRIu64 " is cached.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		return( 1 );
+	}
+	if( libewf_internal_handle_get_concurrent_chunk_data(
+	     internal_handle,
+	     chunk_index,
+	     &chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to read chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	if( libewf_chunk_cache_set_chunk_data(
+	     internal_handle->chunk_cache,
+	     internal_handle->chunk_cache_key_prefix | chunk_index,
+	     chunk_data,
+	     internal_handle->read_priority,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk: %" PRIu64 " data in chunk cache.",
+		 function,
+		 chunk_index );
+
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Prefetches a specific chunk into the chunks cache
+ * Unlike read ahead the chunk does not need to follow the chunk that was last read
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_prefetch_chunk(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_internal_handle_prefetch_chunk";
+	off64_t chunk_data_offset       = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	/* The handle can be closed or a chunk view can be active by the time the request is handled
+	 */
+	if( ( internal_handle->file_io_pool == NULL )
+	 || ( internal_handle->io_handle->abort != 0 )
+	 || ( internal_handle->chunk_view_data != NULL )
+	 || ( chunk_index >= internal_handle->media_values->number_of_chunks ) )
+	{
+		return( 1 );
+	}
+	if( libewf_internal_handle_read_segment_files_to_offset(
+	     internal_handle,
+	     internal_handle->file_io_pool,
+	     (off64_t) chunk_index * internal_handle->media_values->chunk_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read segment files up to offset: %" PRIi64 ".",
+		 function,
+		 (off64_t) chunk_index * internal_handle->media_values->chunk_size );
+
+		return( -1 );
+	}
+	if( libewf_chunk_table_get_chunk_data_by_offset(
+	     internal_handle->chunk_table,
+	     chunk_index,
+	     internal_handle->io_handle,
+	     internal_handle->file_io_pool,
+	     internal_handle->media_values,
+	     internal_handle->segment_table,
+	     internal_handle->chunk_groups_cache,
+	     internal_handle->chunks_cache,
+	     (off64_t) chunk_index * internal_handle->media_values->chunk_size,
+	     &chunk_data,
+	     &chunk_data_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to read chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Signals the read ahead after a sequential read
+ * The chunk index is the index of the chunk that is expected to be read next
+ * The maximum end chunk index is the index of the chunk following the last chunk
+ * that can be read ahead, which allows a reader to bound the read ahead to its data
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_read_ahead_signal(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     uint64_t maximum_end_chunk_index,
+     libcerror_error_t **error )
+{
+	static char *function        = "libewf_internal_handle_read_ahead_signal";
+	uint64_t end_chunk_index     = 0;
+	int maximum_number_of_chunks = 0;
+	int number_of_chunks         = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	/* Read ahead is only applied to read-only access
+	 */
+	if( internal_handle->write_io_handle != NULL )
+	{
+		return( 1 );
+	}
+	/* The chunk that is currently being read must remain cached
+	 */
+	if( internal_handle->chunk_cache != NULL )
+	{
+		maximum_number_of_chunks = LIBEWF_CHUNK_CACHE_NUMBER_OF_SHARDS * LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNK_CACHE_SHARD;
+	}
+	else
+	{
+		maximum_number_of_chunks = internal_handle->maximum_number_of_cached_chunks;
+	}
+	number_of_chunks = internal_handle->number_of_read_ahead_chunks;
+
+	if( number_of_chunks >= maximum_number_of_chunks )
+	{
+		number_of_chunks = maximum_number_of_chunks - 1;
+	}
+	if( number_of_chunks <= 0 )
+	{
+		return( 1 );
+	}
+	end_chunk_index = chunk_index + (uint64_t) number_of_chunks;
+
+	if( end_chunk_index > internal_handle->media_values->number_of_chunks )
+	{
+		end_chunk_index = internal_handle->media_values->number_of_chunks;
+	}
+	if( end_chunk_index > maximum_end_chunk_index )
+	{
+		end_chunk_index = maximum_end_chunk_index;
+	}
+	/* The chunk cache is checked for chunks that were already read ahead
+	 * so the read ahead position of a different reader does not apply
+	 */
+	if( ( internal_handle->chunk_cache == NULL )
+	 && ( chunk_index < internal_handle->read_ahead_last_chunk_index ) )
+	{
+		chunk_index = internal_handle->read_ahead_last_chunk_index;
+	}
+	if( chunk_index >= end_chunk_index )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( internal_handle->read_ahead_thread == NULL )
+	{
+		if( libewf_internal_handle_read_ahead_start(
+		     internal_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to start read ahead.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libcthreads_mutex_grab(
+	     internal_handle->read_ahead_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read ahead mutex.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle->read_ahead_start_chunk_index = chunk_index;
+	internal_handle->read_ahead_end_chunk_index   = end_chunk_index;
+
+	if( libcthreads_condition_signal(
+	     internal_handle->read_ahead_condition,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to signal read ahead condition.",
+		 function );
+
+		libcthreads_mutex_release(
+		 internal_handle->read_ahead_mutex,
+		 NULL );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_release(
+	     internal_handle->read_ahead_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read ahead mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Prefetches the segment file that contains a specific media offset
+ * The segment file is opened and the chunk group at the offset is read into the chunk groups cache
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_prefetch_segment(
+     libewf_internal_handle_t *internal_handle,
+     off64_t offset,
+     libcerror_error_t **error )
+{
+	libewf_chunk_group_t *chunk_group   = NULL;
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_internal_handle_prefetch_segment";
+	off64_t chunk_group_data_offset     = 0;
+	off64_t segment_file_data_offset    = 0;
+	uint32_t segment_number             = 0;
+	int chunk_groups_list_index         = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	/* The handle can be closed or the read can be aborted by the time the request is handled
+	 */
+	if( ( internal_handle->file_io_pool == NULL )
+	 || ( internal_handle->chunk_table == NULL )
+	 || ( internal_handle->io_handle->abort != 0 )
+	 || ( offset < 0 )
+	 || ( (size64_t) offset >= internal_handle->media_values->media_size ) )
+	{
+		return( 1 );
+	}
+	if( libewf_internal_handle_read_segment_files_to_offset(
+	     internal_handle,
+	     internal_handle->file_io_pool,
+	     offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read segment files up to offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	/* Retrieving the chunk group opens the segment file in the file IO pool
+	 */
+	if( libewf_chunk_table_get_segment_file_chunk_group_by_offset(
+	     internal_handle->chunk_table,
+	     internal_handle->file_io_pool,
+	     internal_handle->segment_table,
+	     internal_handle->chunk_groups_cache,
+	     offset,
+	     &segment_number,
+	     &segment_file_data_offset,
+	     &segment_file,
+	     &chunk_groups_list_index,
+	     &chunk_group_data_offset,
+	     &chunk_group,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk group at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Signals the segment prefetch after a sequential read
+ * The offset is the media offset that is expected to be read next, when it is
+ * within the segment prefetch size of the end of the media data of its segment file
+ * the next segment file is prefetched by the read ahead thread
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_prefetch_segment_signal(
+     libewf_internal_handle_t *internal_handle,
+     off64_t offset,
+     libcerror_error_t **error )
+{
+	static char *function        = "libewf_internal_handle_prefetch_segment_signal";
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	off64_t next_segment_offset  = 0;
+	off64_t segment_data_offset  = 0;
+	size64_t segment_media_size  = 0;
+	uint32_t number_of_segments  = 0;
+	uint32_t segment_number      = 0;
+	int result                   = 0;
+#endif
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	/* Segment prefetch is only applied to read-only access
+	 */
+	if( ( internal_handle->write_io_handle != NULL )
+	 || ( internal_handle->segment_table == NULL )
+	 || ( internal_handle->segment_prefetch_size == 0 )
+	 || ( offset < 0 )
+	 || ( (size64_t) offset >= internal_handle->media_values->media_size ) )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	result = libewf_segment_table_get_segment_index_at_offset(
+	          internal_handle->segment_table,
+	          offset,
+	          &segment_number,
+	          &segment_data_offset,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment index at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 1 );
+	}
+	if( libewf_segment_table_get_number_of_segments(
+	     internal_handle->segment_table,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments from segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_number + 1 ) >= number_of_segments )
+	{
+		return( 1 );
+	}
+	result = libewf_segment_table_get_segment_storage_media_size_by_index(
+	          internal_handle->segment_table,
+	          segment_number,
+	          &segment_media_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve storage media size of segment: %" PRIu32 ".",
+		 function,
+		 segment_number );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 1 );
+	}
+	if( ( (size64_t) segment_data_offset >= segment_media_size )
+	 || ( ( segment_media_size - (size64_t) segment_data_offset ) > internal_handle->segment_prefetch_size ) )
+	{
+		return( 1 );
+	}
+	next_segment_offset = ( offset - segment_data_offset ) + (off64_t) segment_media_size;
+
+	/* The next segment file is only prefetched once per sequential pass
+	 */
+	if( next_segment_offset == internal_handle->segment_prefetch_offset )
+	{
+		return( 1 );
+	}
+	if( internal_handle->read_ahead_thread == NULL )
+	{
+		if( libewf_internal_handle_read_ahead_start(
+		     internal_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to start read ahead.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libcthreads_mutex_grab(
+	     internal_handle->read_ahead_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read ahead mutex.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle->read_ahead_prefetch_offset = next_segment_offset;
+	internal_handle->read_ahead_prefetch        = 1;
+
+	if( libcthreads_condition_signal(
+	     internal_handle->read_ahead_condition,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to signal read ahead condition.",
+		 function );
+
+		libcthreads_mutex_release(
+		 internal_handle->read_ahead_mutex,
+		 NULL );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_release(
+	     internal_handle->read_ahead_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read ahead mutex.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle->segment_prefetch_offset = next_segment_offset;
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+	return( 1 );
+}
+
+/* Retrieves the number of chunks to read ahead on sequential access
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_number_of_read_ahead_chunks(
+     libewf_handle_t *handle,
+     int *number_of_read_ahead_chunks,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_number_of_read_ahead_chunks";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( number_of_read_ahead_chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of read ahead chunks.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*number_of_read_ahead_chunks = internal_handle->number_of_read_ahead_chunks;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the number of chunks to read ahead on sequential access
+ * The chunks are read ahead by a background thread into the chunks cache,
+ * where the number of chunks is limited by the maximum number of cached chunks
+ * Once concurrent reads are used the chunks are read ahead into the chunk cache,
+ * where the number of chunks is limited by the size of the chunk cache
+ * A value of 0 disables read ahead
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_number_of_read_ahead_chunks(
+     libewf_handle_t *handle,
+     int number_of_read_ahead_chunks,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_number_of_read_ahead_chunks";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( number_of_read_ahead_chunks < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of read ahead chunks value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_handle->number_of_read_ahead_chunks = number_of_read_ahead_chunks;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the segment prefetch size
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_segment_prefetch_size(
+     libewf_handle_t *handle,
+     size64_t *segment_prefetch_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_segment_prefetch_size";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( segment_prefetch_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment prefetch size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*segment_prefetch_size = internal_handle->segment_prefetch_size;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the segment prefetch size
+ * When a sequential read gets within this size of the end of the media data
+ * of a segment file, the next segment file is opened and its first chunk group
+ * is read by the read ahead thread
+ * A value of 0 disables segment prefetch
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_segment_prefetch_size(
+     libewf_handle_t *handle,
+     size64_t segment_prefetch_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_segment_prefetch_size";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_handle->segment_prefetch_size = segment_prefetch_size;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the read priority
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_read_priority(
+     libewf_handle_t *handle,
+     int *read_priority,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_read_priority";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( read_priority == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read priority.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*read_priority = internal_handle->read_priority;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the read priority
+ * The read priority applies to the handle only and not to its clones,
+ * so that a clone can be used for background reads
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_read_priority(
+     libewf_handle_t *handle,
+     int read_priority,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_read_priority";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( ( read_priority != LIBEWF_READ_PRIORITY_INTERACTIVE )
+	 && ( read_priority != LIBEWF_READ_PRIORITY_BACKGROUND ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported read priority.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_handle->read_priority = read_priority;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the number of threads used to unpack chunks
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_number_of_threads(
+     libewf_handle_t *handle,
+     int *number_of_threads,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_number_of_threads";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( number_of_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of threads.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*number_of_threads = internal_handle->number_of_threads;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the number of threads used to (un)pack chunks
+ * When more than 1 thread is set, reads that span multiple chunks
+ * decompress the chunks in parallel using a pool of worker threads
+ * and chunks written using write buffer are compressed in parallel
+ * and written in order
+ * A value of 0 or 1 (un)packs the chunks on the calling thread
+ * When set before open, the segment files are also scanned in parallel
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_number_of_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_number_of_threads";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( ( number_of_threads < 0 )
+	 || ( number_of_threads > LIBEWF_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	/* The chunk packer and unpacker are recreated on demand with the new number of threads
+	 */
+	if( ( internal_handle->chunk_packer != NULL )
+	 && ( internal_handle->chunk_packer->number_of_threads != number_of_threads ) )
+	{
+		if( libewf_internal_handle_write_pending_chunks(
+		     internal_handle,
+		     internal_handle->file_io_pool,
+		     error ) < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write pending chunks.",
+			 function );
+
+			result = -1;
+		}
+		else if( libewf_internal_handle_free_chunk_packer(
+		          internal_handle,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk packer.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( ( result == 1 )
+	 && ( internal_handle->chunk_unpacker != NULL )
+	 && ( internal_handle->chunk_unpacker->number_of_threads != number_of_threads ) )
+	{
+		if( libewf_chunk_unpacker_free(
+		     &( internal_handle->chunk_unpacker ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk unpacker.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		internal_handle->number_of_threads = number_of_threads;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the scheduler used to (un)pack chunks
+ * The handle only references the scheduler, use NULL to unset it
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_scheduler(
+     libewf_handle_t *handle,
+     libewf_scheduler_t *scheduler,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_scheduler";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	/* The chunk unpacker is recreated on demand with the new scheduler
+	 */
+	if( ( internal_handle->chunk_unpacker != NULL )
+	 && ( internal_handle->scheduler != scheduler ) )
+	{
+		if( libewf_chunk_unpacker_free(
+		     &( internal_handle->chunk_unpacker ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk unpacker.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		internal_handle->scheduler = scheduler;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the decompression backend
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_decompression_backend(
+     libewf_handle_t *handle,
+     int *decompression_backend,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_decompression_backend";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( decompression_backend == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid decompression backend.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*decompression_backend = internal_handle->io_handle->decompression_backend;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the decompression backend used to decompress deflate compressed chunks
+ * The default backend is the fastest one available in the build
+ * Returns 1 if successful, 0 if the backend is not available in the build or -1 on error
+ */
+int libewf_handle_set_decompression_backend(
+     libewf_handle_t *handle,
+     int decompression_backend,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_decompression_backend";
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_decompression_backend_is_supported(
+	          decompression_backend,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported decompression backend.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_handle->io_handle->decompression_backend = decompression_backend;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the batch decompression function
+ * The function is offered the deflate compressed chunks of a batch read before
+ * they are decompressed by the worker threads
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_batch_decompression_function(
+     libewf_handle_t *handle,
+     int (*batch_decompression_function)(
+            int number_of_chunks,
+            const uint8_t **compressed_data,
+            const size_t *compressed_data_sizes,
+            uint8_t **data,
+            size_t *data_sizes,
+            void *function_data,
+            libcerror_error_t **error ),
+     void *function_data,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_batch_decompression_function";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_handle->io_handle->batch_decompression_function      = batch_decompression_function;
+	internal_handle->io_handle->batch_decompression_function_data = function_data;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the maximum number of out of order chunks
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_maximum_number_of_out_of_order_chunks(
+     libewf_handle_t *handle,
+     int *maximum_number_of_out_of_order_chunks,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_maximum_number_of_out_of_order_chunks";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( maximum_number_of_out_of_order_chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum number of out of order chunks.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*maximum_number_of_out_of_order_chunks = internal_handle->maximum_number_of_out_of_order_chunks;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the maximum number of out of order chunks
+ * This is the number of chunks, counted from the next chunk to write, within which
+ * data chunks can be written out of order using seek offset and write data chunk
+ * The value cannot be changed while out of order chunks are held
+ * A value of 0 requires the data chunks to be written in order
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_maximum_number_of_out_of_order_chunks(
+     libewf_handle_t *handle,
+     int maximum_number_of_out_of_order_chunks,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_maximum_number_of_out_of_order_chunks";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( maximum_number_of_out_of_order_chunks < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid maximum number of out of order chunks value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->number_of_out_of_order_chunks > 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - out of order chunks already set.",
+		 function );
+
+		result = -1;
+	}
+	else if( libewf_internal_handle_free_out_of_order_chunks(
+	          internal_handle,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free out of order chunks.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		internal_handle->maximum_number_of_out_of_order_chunks = maximum_number_of_out_of_order_chunks;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Determine if the segment files are corrupted
+ * Returns 1 if corrupted, 0 if not or -1 on error
+ */
+int libewf_handle_segment_files_corrupted(
+     libewf_handle_t *handle,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_segment_files_corrupted";
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing segment table.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = ( internal_handle->segment_table->flags & LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED ) != 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Determine if the segment files are encrypted
+ * Returns 1 if encrypted, 0 if not or -1 on error
+ */
+int libewf_handle_segment_files_encrypted(
+     libewf_handle_t *handle,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_segment_files_encrypted";
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = (int) internal_handle->io_handle->is_encrypted;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the segment filename size
+ * The filename size should include the end of string character
+ * Returns 1 if successful, 0 if value not present or -1 on error
+ */
+int libewf_handle_get_segment_filename_size(
+     libewf_handle_t *handle,
+     size_t *filename_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_segment_filename_size";
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_segment_table_get_basename_size(
+	          internal_handle->segment_table,
+	          filename_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment table basename size.",
+		 function );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the segment filename
+ * The filename size should include the end of string character
+ * Returns 1 if successful, 0 if value not present or -1 on error
+ */
+int libewf_handle_get_segment_filename(
+     libewf_handle_t *handle,
+     char *filename,
+     size_t filename_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_segment_filename";
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
 
-			internal_handle->write_io_handle->device_information      = NULL;
-			internal_handle->write_io_handle->device_information_size = 0;
-		}
-		if( internal_handle->write_io_handle->data_section != NULL )
-		{
-			memory_free(
-			 internal_handle->write_io_handle->data_section );
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
 
-			internal_handle->write_io_handle->data_section = NULL;
-		}
-		/* Correct the sections in the segment files
-		 */
-		if( libewf_write_io_handle_finalize_write_sections_corrections(
-		     internal_handle->write_io_handle,
-		     file_io_pool,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
-		     internal_handle->header_values,
-		     internal_handle->hash_values,
-		     internal_handle->hash_sections,
-		     internal_handle->sessions,
-		     internal_handle->tracks,
-		     internal_handle->acquiry_errors,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write sections corrections to segment files.",
-			 function );
+		return( -1 );
+	}
+#endif
+	result = libewf_segment_table_get_basename(
+	          internal_handle->segment_table,
+	          filename,
+	          filename_size,
+	          error );
 
-			return( -1 );
-		}
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment table basename.",
+		 function );
 	}
-	internal_handle->write_io_handle->write_finalized = 1;
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
 
-	return( write_finalize_count );
+		return( -1 );
+	}
+#endif
+	return( result );
 }
 
-/* Finalizes the write by correcting the EWF the meta data in the segment files
- * This function is required after write from stream
- * Returns the number of bytes written or -1 on error
+/* Sets the segment file
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_handle_write_finalize(
-         libewf_handle_t *handle,
-         libcerror_error_t **error )
+int libewf_handle_set_segment_filename(
+     libewf_handle_t *handle,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_finalize";
-	ssize_t write_count                       = 0;
+	static char *function                     = "libewf_handle_set_segment_filename";
+	int result                                = 0;
 
 	if( handle == NULL )
 	{
@@ -6545,13 +26178,13 @@ ssize_t libewf_handle_write_finalize(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->file_io_pool == NULL )
+	if( internal_handle->write_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: segment filename cannot be changed.",
 		 function );
 
 		return( -1 );
@@ -6571,21 +26204,20 @@ ssize_t libewf_handle_write_finalize(
 		return( -1 );
 	}
 #endif
-	write_count = libewf_internal_handle_write_finalize_file_io_pool(
-	               internal_handle,
-	               internal_handle->file_io_pool,
-	               error );
+	result = libewf_segment_table_set_basename(
+	          internal_handle->segment_table,
+	          filename,
+	          filename_length,
+	          error );
 
-	if( write_count == -1 )
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to write finalize.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set segment table basename.",
 		 function );
-
-		write_count = -1;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -6602,22 +26234,25 @@ ssize_t libewf_handle_write_finalize(
 		return( -1 );
 	}
 #endif
-	return( write_count );
+	return( result );
 }
 
-/* Seeks a certain offset of the (media) data
- * This function is not multi-thread safe acquire write lock before call
- * Returns the offset if seek is successful or -1 on error
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Retrieves the segment filename size
+ * The filename size includes the end of string character
+ * Returns 1 if successful, 0 if value not present or -1 on error
  */
-off64_t libewf_internal_handle_seek_offset(
-         libewf_internal_handle_t *internal_handle,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
+int libewf_handle_get_segment_filename_size_wide(
+     libewf_handle_t *handle,
+     size_t *filename_size,
+     libcerror_error_t **error )
 {
-	static char *function = "libewf_internal_handle_seek_offset";
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_segment_filename_size_wide";
+	int result                                = 0;
 
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -6628,96 +26263,142 @@ off64_t libewf_internal_handle_seek_offset(
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_data != NULL )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values == NULL )
+#endif
+	result = libewf_segment_table_get_basename_size_wide(
+	          internal_handle->segment_table,
+	          filename_size,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment table basename size.",
 		 function );
-
-		return( -1 );
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( whence != SEEK_CUR )
-	 && ( whence != SEEK_END )
-	 && ( whence != SEEK_SET ) )
+#endif
+	return( result );
+}
+
+/* Retrieves the segment filename
+ * The filename size should include the end of string character
+ * Returns 1 if successful, 0 if value not present or -1 on error
+ */
+int libewf_handle_get_segment_filename_wide(
+     libewf_handle_t *handle,
+     wchar_t *filename,
+     size_t filename_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_segment_filename_wide";
+	int result                                = 0;
+
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported whence.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( whence == SEEK_CUR )
-	{	
-		offset += internal_handle->current_offset;
-	}
-	else if( whence == SEEK_END )
-	{	
-		offset += (off64_t) internal_handle->media_values->media_size;
-	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
-		libcnotify_printf(
-		 "%s: seeking media data offset: %" PRIi64 ".\n",
-		 function,
-		 offset );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
 	}
 #endif
-	if( offset < 0 )
+	result = libewf_segment_table_get_basename_wide(
+	          internal_handle->segment_table,
+	          filename,
+	          filename_size,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment table basename.",
+		 function );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle->current_offset = offset;
-
-	return( offset );
+#endif
+	return( result );
 }
 
-/* Seeks a certain offset of the (media) data
- * Returns the offset if seek is successful or -1 on error
+/* Sets the segment file
+ * Returns 1 if successful or -1 on error
  */
-off64_t libewf_handle_seek_offset(
-         libewf_handle_t *handle,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
+int libewf_handle_set_segment_filename_wide(
+     libewf_handle_t *handle,
+     const wchar_t *filename,
+     size_t filename_length,
+     libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_seek_offset";
+	static char *function                     = "libewf_handle_set_segment_filename_wide";
+	int result                                = 0;
 
 	if( handle == NULL )
 	{
@@ -6732,13 +26413,13 @@ off64_t libewf_handle_seek_offset(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->file_io_pool == NULL )
+	if( internal_handle->write_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: segment filename cannot be changed.",
 		 function );
 
 		return( -1 );
@@ -6758,19 +26439,19 @@ off64_t libewf_handle_seek_offset(
 		return( -1 );
 	}
 #endif
-	offset = libewf_internal_handle_seek_offset(
-	          internal_handle,
-	          offset,
-	          whence,
+	result = libewf_segment_table_set_basename_wide(
+	          internal_handle->segment_table,
+	          filename,
+	          filename_length,
 	          error );
 
-	if( offset == -1 )
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set segment table basename.",
 		 function );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
@@ -6788,19 +26469,21 @@ off64_t libewf_handle_seek_offset(
 		return( -1 );
 	}
 #endif
-	return( offset );
+	return( result );
 }
 
-/* Retrieves the current offset of the (media) data
+#endif
+
+/* Retrieves the maximum segment file size
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_offset(
+int libewf_handle_get_maximum_segment_size(
      libewf_handle_t *handle,
-     off64_t *offset,
+     size64_t *maximum_segment_size,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_offset";
+	static char *function                     = "libewf_handle_get_maximum_segment_size";
 
 	if( handle == NULL )
 	{
@@ -6815,13 +26498,24 @@ int libewf_handle_get_offset(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( offset == NULL )
+	if( internal_handle->segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_segment_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid offset.",
+		 "%s: invalid maximum segment size.",
 		 function );
 
 		return( -1 );
@@ -6841,7 +26535,7 @@ int libewf_handle_get_offset(
 		return( -1 );
 	}
 #endif
-	*offset = internal_handle->current_offset;
+	*maximum_segment_size = internal_handle->segment_table->maximum_segment_size;
 
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
@@ -6861,16 +26555,19 @@ int libewf_handle_get_offset(
 	return( 1 );
 }
 
-/* Sets the maximum number of (concurrent) open file handles
+/* Sets the maximum segment file size
+ * A maximum segment file size of 0 represents the maximum possible size for the format
+ * If the maximum segment file size is smaller than the size needed to store a single chunk
+ * the size off the latter is enforced and not the maximum segment file size
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_maximum_number_of_open_handles(
+int libewf_handle_set_maximum_segment_size(
      libewf_handle_t *handle,
-     int maximum_number_of_open_handles,
+     size64_t maximum_segment_size,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_maximum_number_of_open_handles";
+	static char *function                     = "libewf_handle_set_maximum_segment_size";
 	int result                                = 1;
 
 	if( handle == NULL )
@@ -6886,6 +26583,39 @@ int libewf_handle_set_maximum_number_of_open_handles(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_segment_size > (size64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid maximum segment size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
@@ -6901,26 +26631,33 @@ int libewf_handle_set_maximum_number_of_open_handles(
 		return( -1 );
 	}
 #endif
-	if( internal_handle->file_io_pool != NULL )
+	if( ( internal_handle->read_io_handle != NULL )
+	 || ( internal_handle->write_io_handle == NULL )
+	 || ( internal_handle->write_io_handle->values_initialized != 0 ) )
 	{
-		result = libbfio_pool_set_maximum_number_of_open_handles(
-		          internal_handle->file_io_pool,
-		          maximum_number_of_open_handles,
-		          error );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: maximum segment size cannot be changed.",
+		 function );
 
-		if( result != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set maximum number of open handles in file IO pool.",
-			 function );
-		}
+		result = -1;
 	}
-	if( result == 1 )
+	else if( maximum_segment_size > internal_handle->write_io_handle->maximum_segment_file_size )
 	{
-		internal_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment file size value out of bounds.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		internal_handle->segment_table->maximum_segment_size = maximum_segment_size;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -6940,16 +26677,17 @@ int libewf_handle_set_maximum_number_of_open_handles(
 	return( result );
 }
 
-/* Determine if the segment files are corrupted
- * Returns 1 if corrupted, 0 if not or -1 on error
+/* Retrieves the write synchronization (durability) policy
+ * Returns 1 if successful or -1 on error
  */
-int libewf_handle_segment_files_corrupted(
+int libewf_handle_get_write_sync_policy(
      libewf_handle_t *handle,
+     uint8_t *sync_policy,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_segment_files_corrupted";
-	int result                                = 0;
+	static char *function                     = "libewf_handle_get_write_sync_policy";
+	int result                                = 1;
 
 	if( handle == NULL )
 	{
@@ -6964,13 +26702,13 @@ int libewf_handle_segment_files_corrupted(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->segment_table == NULL )
+	if( sync_policy == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing segment table.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sync policy.",
 		 function );
 
 		return( -1 );
@@ -6990,8 +26728,21 @@ int libewf_handle_segment_files_corrupted(
 		return( -1 );
 	}
 #endif
-	result = ( internal_handle->segment_table->flags & LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED ) != 0;
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing write IO handle.",
+		 function );
 
+		result = -1;
+	}
+	else
+	{
+		*sync_policy = internal_handle->write_io_handle->sync_policy;
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
@@ -7010,16 +26761,19 @@ int libewf_handle_segment_files_corrupted(
 	return( result );
 }
 
-/* Determine if the segment files are encrypted
- * Returns 1 if encrypted, 0 if not or -1 on error
+/* Sets the write synchronization (durability) policy
+ * The policy can only be set after the handle was opened for writing and before
+ * the first write. The durable policy is not supported when resuming a write
+ * Returns 1 if successful or -1 on error
  */
-int libewf_handle_segment_files_encrypted(
+int libewf_handle_set_write_sync_policy(
      libewf_handle_t *handle,
+     uint8_t sync_policy,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_segment_files_encrypted";
-	int result                                = 0;
+	static char *function                     = "libewf_handle_set_write_sync_policy";
+	int result                                = 1;
 
 	if( handle == NULL )
 	{
@@ -7045,25 +26799,21 @@ int libewf_handle_segment_files_encrypted(
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( ( sync_policy != LIBEWF_WRITE_SYNC_POLICY_FAST )
+	 && ( sync_policy != LIBEWF_WRITE_SYNC_POLICY_DURABLE ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported sync policy: %" PRIu8 ".",
+		 function,
+		 sync_policy );
 
 		return( -1 );
 	}
-#endif
-	result = (int) internal_handle->io_handle->is_encrypted;
-
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -7071,72 +26821,46 @@ int libewf_handle_segment_files_encrypted(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( result );
-}
-
-/* Retrieves the segment filename size
- * The filename size should include the end of string character
- * Returns 1 if successful, 0 if value not present or -1 on error
- */
-int libewf_handle_get_segment_filename_size(
-     libewf_handle_t *handle,
-     size_t *filename_size,
-     libcerror_error_t **error )
-{
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_segment_filename_size";
-	int result                                = 0;
-
-	if( handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
-		 function );
-
-		return( -1 );
-	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( ( internal_handle->read_io_handle != NULL )
+	 || ( internal_handle->write_io_handle == NULL )
+	 || ( internal_handle->write_io_handle->values_initialized != 0 ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: sync policy cannot be changed.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-#endif
-	result = libewf_segment_table_get_basename_size(
-	          internal_handle->segment_table,
-	          filename_size,
-	          error );
-
-	if( result == -1 )
+	/* The segment file that is resumed was not opened with a file IO handle
+	 * that can be synchronized
+	 */
+	else if( ( sync_policy == LIBEWF_WRITE_SYNC_POLICY_DURABLE )
+	      && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve segment table basename size.",
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: durable sync policy not supported on resume.",
 		 function );
+
+		result = -1;
+	}
+	else
+	{
+		internal_handle->write_io_handle->sync_policy = sync_policy;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -7144,7 +26868,7 @@ int libewf_handle_get_segment_filename_size(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
@@ -7153,18 +26877,18 @@ int libewf_handle_get_segment_filename_size(
 	return( result );
 }
 
-/* Retrieves the segment filename
+/* Retrieves the filename size of the segment file of the current chunk
  * The filename size should include the end of string character
- * Returns 1 if successful, 0 if value not present or -1 on error
+ * Returns 1 if successful, 0 if no such filename or -1 on error
  */
-int libewf_handle_get_segment_filename(
+int libewf_handle_get_filename_size(
      libewf_handle_t *handle,
-     char *filename,
-     size_t filename_size,
+     size_t *filename_size,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_segment_filename";
+	libbfio_handle_t *file_io_handle          = NULL;
+	static char *function                     = "libewf_handle_get_filename_size";
 	int result                                = 0;
 
 	if( handle == NULL )
@@ -7195,10 +26919,9 @@ int libewf_handle_get_segment_filename(
 		return( -1 );
 	}
 #endif
-	result = libewf_segment_table_get_basename(
-	          internal_handle->segment_table,
-	          filename,
-	          filename_size,
+	result = libewf_internal_handle_get_file_io_handle(
+	          internal_handle,
+	          &file_io_handle,
 	          error );
 
 	if( result == -1 )
@@ -7207,9 +26930,26 @@ int libewf_handle_get_segment_filename(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve segment table basename.",
+		 "%s: unable to retrieve file IO handle for current chunk.",
 		 function );
 	}
+	else if( result != 0 )
+	{
+		result = libbfio_file_get_name_size(
+		          file_io_handle,
+		          filename_size,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve filename size.",
+			 function );
+		}
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
@@ -7228,17 +26968,19 @@ int libewf_handle_get_segment_filename(
 	return( result );
 }
 
-/* Sets the segment file
- * Returns 1 if successful or -1 on error
+/* Retrieves the filename of the segment file of the current chunk
+ * The filename size should include the end of string character
+ * Returns 1 if successful, 0 if no such filename or -1 on error
  */
-int libewf_handle_set_segment_filename(
+int libewf_handle_get_filename(
      libewf_handle_t *handle,
-     const char *filename,
-     size_t filename_length,
+     char *filename,
+     size_t filename_size,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_segment_filename";
+	libbfio_handle_t *file_io_handle          = NULL;
+	static char *function                     = "libewf_handle_get_filename";
 	int result                                = 0;
 
 	if( handle == NULL )
@@ -7254,19 +26996,8 @@ int libewf_handle_set_segment_filename(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->write_io_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: segment filename cannot be changed.",
-		 function );
-
-		return( -1 );
-	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -7274,29 +27005,46 @@ int libewf_handle_set_segment_filename(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	result = libewf_segment_table_set_basename(
-	          internal_handle->segment_table,
-	          filename,
-	          filename_length,
+	result = libewf_internal_handle_get_file_io_handle(
+	          internal_handle,
+	          &file_io_handle,
 	          error );
 
-	if( result != 1 )
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set segment table basename.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file IO handle for current chunk.",
 		 function );
 	}
+	else if( result != 0 )
+	{
+		result = libbfio_file_get_name(
+		          file_io_handle,
+		          filename,
+		          filename_size,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve filename.",
+			 function );
+		}
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -7304,7 +27052,7 @@ int libewf_handle_set_segment_filename(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
@@ -7315,17 +27063,18 @@ int libewf_handle_set_segment_filename(
 
 #if defined( HAVE_WIDE_CHARACTER_TYPE )
 
-/* Retrieves the segment filename size
+/* Retrieves the filename size of the segment file of the current chunk
  * The filename size includes the end of string character
- * Returns 1 if successful, 0 if value not present or -1 on error
+ * Returns 1 if successful, 0 if no such filename or -1 on error
  */
-int libewf_handle_get_segment_filename_size_wide(
+int libewf_handle_get_filename_size_wide(
      libewf_handle_t *handle,
      size_t *filename_size,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_segment_filename_size_wide";
+	libbfio_handle_t *file_io_handle          = NULL;
+	static char *function                     = "libewf_handle_get_filename_size_wide";
 	int result                                = 0;
 
 	if( handle == NULL )
@@ -7356,9 +27105,9 @@ int libewf_handle_get_segment_filename_size_wide(
 		return( -1 );
 	}
 #endif
-	result = libewf_segment_table_get_basename_size_wide(
-	          internal_handle->segment_table,
-	          filename_size,
+	result = libewf_internal_handle_get_file_io_handle(
+	          internal_handle,
+	          &file_io_handle,
 	          error );
 
 	if( result == -1 )
@@ -7367,9 +27116,26 @@ int libewf_handle_get_segment_filename_size_wide(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve segment table basename size.",
+		 "%s: unable to retrieve file IO handle for current chunk.",
 		 function );
 	}
+	else if( result != 0 )
+	{
+		result = libbfio_file_get_name_size_wide(
+		          file_io_handle,
+		          filename_size,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve filename size.",
+			 function );
+		}
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
@@ -7388,18 +27154,19 @@ int libewf_handle_get_segment_filename_size_wide(
 	return( result );
 }
 
-/* Retrieves the segment filename
+/* Retrieves the filename of the segment file of the current chunk
  * The filename size should include the end of string character
- * Returns 1 if successful, 0 if value not present or -1 on error
+ * Returns 1 if successful, 0 if no such filename or -1 on error
  */
-int libewf_handle_get_segment_filename_wide(
+int libewf_handle_get_filename_wide(
      libewf_handle_t *handle,
      wchar_t *filename,
      size_t filename_size,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_segment_filename_wide";
+	libbfio_handle_t *file_io_handle          = NULL;
+	static char *function                     = "libewf_handle_get_filename_wide";
 	int result                                = 0;
 
 	if( handle == NULL )
@@ -7430,10 +27197,9 @@ int libewf_handle_get_segment_filename_wide(
 		return( -1 );
 	}
 #endif
-	result = libewf_segment_table_get_basename_wide(
-	          internal_handle->segment_table,
-	          filename,
-	          filename_size,
+	result = libewf_internal_handle_get_file_io_handle(
+	          internal_handle,
+	          &file_io_handle,
 	          error );
 
 	if( result == -1 )
@@ -7442,9 +27208,27 @@ int libewf_handle_get_segment_filename_wide(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve segment table basename.",
+		 "%s: unable to retrieve file IO handle for current chunk.",
 		 function );
 	}
+	else if( result != 0 )
+	{
+		result = libbfio_file_get_name_wide(
+		          file_io_handle,
+		          filename,
+		          filename_size,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve filename.",
+			 function );
+		}
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
@@ -7463,20 +27247,24 @@ int libewf_handle_get_segment_filename_wide(
 	return( result );
 }
 
-/* Sets the segment file
- * Returns 1 if successful or -1 on error
+#endif
+
+/* Retrieves the file IO handle of the segment file of the current chunk
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful, 0 if no such file IO handle or -1 on error
  */
-int libewf_handle_set_segment_filename_wide(
-     libewf_handle_t *handle,
-     const wchar_t *filename,
-     size_t filename_length,
+int libewf_internal_handle_get_file_io_handle(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_handle_t **file_io_handle,
      libcerror_error_t **error )
 {
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_segment_filename_wide";
-	int result                                = 0;
+	static char *function      = "libewf_internal_handle_get_file_io_handle";
+	size64_t segment_file_size = 0;
+	uint64_t chunk_index       = 0;
+	int file_io_pool_entry     = 0;
+	int result                 = 0;
 
-	if( handle == NULL )
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -7487,79 +27275,125 @@ int libewf_handle_set_segment_filename_wide(
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
 
-	if( internal_handle->write_io_handle == NULL )
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: segment filename cannot be changed.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	result = libewf_segment_table_set_basename_wide(
+	chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+
+	if( libewf_internal_handle_read_segment_files_to_offset(
+	     internal_handle,
+	     internal_handle->file_io_pool,
+	     internal_handle->current_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read segment files up to offset: %" PRIi64 ".",
+		 function,
+		 internal_handle->current_offset );
+
+		return( -1 );
+	}
+	result = libewf_segment_table_get_segment_at_offset(
 	          internal_handle->segment_table,
-	          filename,
-	          filename_length,
+	          internal_handle->current_offset,
+	          &file_io_pool_entry,
+	          &segment_file_size,
 	          error );
 
-	if( result != 1 )
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set segment table basename.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment at offset: 0x%08" PRIx64 " from segment table.",
+		 function,
+		 internal_handle->current_offset );
+
+		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	else if( result != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
-		 function );
+		if( file_io_pool_entry == -1 )
+		{
+			return( 0 );
+		}
+		if( libbfio_pool_get_handle(
+		     internal_handle->file_io_pool,
+		     file_io_pool_entry,
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file IO handle: %d from pool (chunk: %" PRIu64 ").",
+			 function,
+			 file_io_pool_entry,
+			 chunk_index );
 
-		return( -1 );
+			return( -1 );
+		}
 	}
-#endif
 	return( result );
 }
 
-#endif
-
-/* Retrieves the maximum segment file size
- * Returns 1 if successful or -1 on error
+/* Retrieves the file IO handle of the segment file of the current chunk
+ * Returns 1 if successful, 0 if no such file IO handle or -1 on error
  */
-int libewf_handle_get_maximum_segment_size(
+int libewf_handle_get_file_io_handle(
      libewf_handle_t *handle,
-     size64_t *maximum_segment_size,
+     libbfio_handle_t **file_io_handle,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_maximum_segment_size";
+	static char *function                     = "libewf_handle_get_file_io_handle";
+	int result                                = 0;
 
 	if( handle == NULL )
 	{
@@ -7574,28 +27408,6 @@ int libewf_handle_get_maximum_segment_size(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->segment_table == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing segment table.",
-		 function );
-
-		return( -1 );
-	}
-	if( maximum_segment_size == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid maximum segment size.",
-		 function );
-
-		return( -1 );
-	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
@@ -7611,8 +27423,20 @@ int libewf_handle_get_maximum_segment_size(
 		return( -1 );
 	}
 #endif
-	*maximum_segment_size = internal_handle->segment_table->maximum_segment_size;
+	result = libewf_internal_handle_get_file_io_handle(
+	          internal_handle,
+	          file_io_handle,
+	          error );
 
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file IO handle for current chunk.",
+		 function );
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
@@ -7628,25 +27452,25 @@ int libewf_handle_get_maximum_segment_size(
 		return( -1 );
 	}
 #endif
-	return( 1 );
+	return( result );
 }
 
-/* Sets the maximum segment file size
- * A maximum segment file size of 0 represents the maximum possible size for the format
- * If the maximum segment file size is smaller than the size needed to store a single chunk
- * the size off the latter is enforced and not the maximum segment file size
+/* Retrieves the media values
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_maximum_segment_size(
-     libewf_handle_t *handle,
-     size64_t maximum_segment_size,
+int libewf_internal_handle_get_media_values(
+     libewf_internal_handle_t *internal_handle,
+     size64_t *media_size,
      libcerror_error_t **error )
 {
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_maximum_segment_size";
-	int result                                = 1;
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_internal_handle_get_media_values";
+	off64_t chunk_data_offset       = 0;
+	size64_t chunks_data_size       = 0;
+	size64_t sector_data_size       = 0;
+	uint64_t chunk_index            = 0;
 
-	if( handle == NULL )
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -7657,8 +27481,6 @@ int libewf_handle_set_maximum_segment_size(
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
 	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
@@ -7670,194 +27492,285 @@ int libewf_handle_set_maximum_segment_size(
 
 		return( -1 );
 	}
-	if( internal_handle->segment_table == NULL )
+	if( media_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing segment table.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media size.",
 		 function );
 
 		return( -1 );
 	}
-	if( maximum_segment_size > (size64_t) INT64_MAX )
+	sector_data_size  = internal_handle->media_values->number_of_sectors;
+	sector_data_size *= internal_handle->media_values->bytes_per_sector;
+
+	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid maximum segment size value exceeds maximum.",
-		 function );
+		if( internal_handle->media_values->number_of_chunks > 0 )
+		{
+			chunk_index = internal_handle->media_values->number_of_chunks - 1;
 
-		return( -1 );
+			if( libewf_chunk_table_get_chunk_data_by_offset(
+			     internal_handle->chunk_table,
+			     chunk_index,
+			     internal_handle->io_handle,
+			     internal_handle->file_io_pool,
+			     internal_handle->media_values,
+			     internal_handle->segment_table,
+			     internal_handle->chunk_groups_cache,
+			     internal_handle->chunks_cache,
+			     internal_handle->current_offset,
+			     &chunk_data,
+			     &chunk_data_offset,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			if( chunk_data == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			chunks_data_size = chunk_index
+			                 * internal_handle->media_values->sectors_per_chunk
+			                 * internal_handle->media_values->bytes_per_sector;
+
+			/* The only way to determine the size of the last compressed chunk
+			 * is to decompress it
+			 */
+			if( libewf_chunk_data_unpack(
+			     chunk_data,
+			     internal_handle->io_handle,
+			     internal_handle->chunk_table->compression_context,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to unpack chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) == 0 )
+			{
+				chunks_data_size += chunk_data->data_size;
+			}
+			if( sector_data_size != chunks_data_size )
+			{
+#if defined( HAVE_VERBOSE_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "%s: mismatch of media data size in volume: %" PRIu64 " and chunk table: %" PRIu64 "\n",
+					 function,
+					 sector_data_size,
+					 chunks_data_size );
+				}
+#endif
+				if( sector_data_size < chunks_data_size )
+				{
+					sector_data_size = chunks_data_size;
+				}
+			}
+		}
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	*media_size = sector_data_size;
+
+	return( 1 );
+}
+
+/* Sets the media values
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_set_media_values(
+     libewf_internal_handle_t *internal_handle,
+     uint32_t sectors_per_chunk,
+     uint32_t bytes_per_sector,
+     size64_t media_size,
+     libcerror_error_t **error )
+{
+	static char *function            = "libewf_internal_handle_set_media_values";
+	size32_t chunk_size              = 0;
+	size64_t maximum_input_file_size = 0;
+	uint64_t number_of_chunks        = 0;
+	uint64_t number_of_sectors       = 0;
+
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( ( internal_handle->read_io_handle != NULL )
-	 || ( internal_handle->write_io_handle == NULL )
-	 || ( internal_handle->write_io_handle->values_initialized != 0 ) )
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: maximum segment size cannot be changed.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
-	else if( maximum_segment_size > internal_handle->write_io_handle->maximum_segment_file_size )
+	if( ( sectors_per_chunk == 0 )
+	 || ( sectors_per_chunk > (uint32_t) INT32_MAX ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid segment file size value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid sectors per chunk.",
 		 function );
 
-		result = -1;
-	}
-	else
-	{
-		internal_handle->segment_table->maximum_segment_size = maximum_segment_size;
+		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( ( bytes_per_sector == 0 )
+	 || ( bytes_per_sector > (uint32_t) INT32_MAX ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid bytes per sector.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	return( result );
-}
-
-/* Retrieves the filename size of the segment file of the current chunk
- * The filename size should include the end of string character
- * Returns 1 if successful, 0 if no such filename or -1 on error
- */
-int libewf_handle_get_filename_size(
-     libewf_handle_t *handle,
-     size_t *filename_size,
-     libcerror_error_t **error )
-{
-	libewf_internal_handle_t *internal_handle = NULL;
-	libbfio_handle_t *file_io_handle          = NULL;
-	static char *function                     = "libewf_handle_get_filename_size";
-	int result                                = 0;
-
-	if( handle == NULL )
+	if( media_size > (size64_t) INT64_MAX )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid media size value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
+	/* Determine the chunk size
+	 */
+	chunk_size = sectors_per_chunk * bytes_per_sector;
 
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( ( chunk_size == 0 )
+	 || ( chunk_size > (size32_t) INT32_MAX ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk size.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	result = libewf_internal_handle_get_file_io_handle(
-	          internal_handle,
-	          &file_io_handle,
-	          error );
+	/* Check if the input file size does not exceed the maximum possible input file size
+	 * for the chunk size
+	 */
+	maximum_input_file_size = (size64_t) chunk_size * (size64_t) UINT32_MAX;
 
-	if( result == -1 )
+	if( media_size > maximum_input_file_size )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve file IO handle for current chunk.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: media size cannot be larger than size: %" PRIu64 " with a chunk size of: %" PRIu32 ".",
+		 function,
+		 maximum_input_file_size,
+		 chunk_size );
+
+		return( -1 );
 	}
-	else if( result != 0 )
+	internal_handle->media_values->sectors_per_chunk = sectors_per_chunk;
+	internal_handle->media_values->bytes_per_sector  = bytes_per_sector;
+	internal_handle->media_values->chunk_size        = chunk_size;
+	internal_handle->media_values->media_size        = media_size;
+
+	/* If a media size was provided
+	 */
+	if( media_size > 0 )
 	{
-		result = libbfio_file_get_name_size(
-		          file_io_handle,
-		          filename_size,
-		          error );
+		/* Determine the number of chunks to write
+		 */
+		number_of_chunks = (uint64_t) media_size / (uint64_t) chunk_size;
 
-		if( result != 1 )
+		if( ( (uint64_t) media_size % (uint64_t) chunk_size ) != 0 )
+		{
+			number_of_chunks += 1;
+		}
+		if( number_of_chunks > (uint64_t) UINT32_MAX )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve filename size.",
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of chunks value exceeds maximum.",
 			 function );
+
+			return( -1 );
 		}
-	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
-		 function );
+		internal_handle->media_values->number_of_chunks = (uint64_t) number_of_chunks;
 
-		return( -1 );
+		/* Determine the number of sectors to write
+		 */
+		number_of_sectors = (uint64_t) media_size / (uint64_t) bytes_per_sector;
+
+		if( number_of_sectors > (uint64_t) INT64_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of sectors value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		internal_handle->media_values->number_of_sectors = number_of_sectors;
 	}
-#endif
-	return( result );
+	return( 1 );
 }
 
-/* Retrieves the filename of the segment file of the current chunk
- * The filename size should include the end of string character
- * Returns 1 if successful, 0 if no such filename or -1 on error
+/* Appends UTF-8 encoded ltree data of a logical image
+ * The ltree data describes the (single) file entries and is written in the
+ * last segment file, it can be appended in parts while the data is written
+ * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_filename(
+int libewf_handle_append_utf8_ltree_data(
      libewf_handle_t *handle,
-     char *filename,
-     size_t filename_size,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	libbfio_handle_t *file_io_handle          = NULL;
-	static char *function                     = "libewf_handle_get_filename";
-	int result                                = 0;
+	static char *function                     = "libewf_handle_append_utf8_ltree_data";
+	int result                                = 1;
 
 	if( handle == NULL )
 	{
@@ -7872,102 +27785,41 @@ int libewf_handle_get_filename(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	result = libewf_internal_handle_get_file_io_handle(
-	          internal_handle,
-	          &file_io_handle,
-	          error );
-
-	if( result == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve file IO handle for current chunk.",
-		 function );
-	}
-	else if( result != 0 )
-	{
-		result = libbfio_file_get_name(
-		          file_io_handle,
-		          filename,
-		          filename_size,
-		          error );
-
-		if( result != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve filename.",
-			 function );
-		}
-	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( internal_handle->single_files == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing single files.",
 		 function );
 
 		return( -1 );
-	}
-#endif
-	return( result );
-}
-
-#if defined( HAVE_WIDE_CHARACTER_TYPE )
-
-/* Retrieves the filename size of the segment file of the current chunk
- * The filename size includes the end of string character
- * Returns 1 if successful, 0 if no such filename or -1 on error
- */
-int libewf_handle_get_filename_size_wide(
-     libewf_handle_t *handle,
-     size_t *filename_size,
-     libcerror_error_t **error )
-{
-	libewf_internal_handle_t *internal_handle = NULL;
-	libbfio_handle_t *file_io_handle          = NULL;
-	static char *function                     = "libewf_handle_get_filename_size_wide";
-	int result                                = 0;
-
-	if( handle == NULL )
+	}
+	if( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_WRITE ) == 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: ltree data can only be appended on write access.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -7975,45 +27827,42 @@ int libewf_handle_get_filename_size_wide(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	result = libewf_internal_handle_get_file_io_handle(
-	          internal_handle,
-	          &file_io_handle,
-	          error );
-
-	if( result == -1 )
+	if( ( internal_handle->io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_EWF1_LOGICAL )
+	 || ( internal_handle->write_io_handle == NULL )
+	 || ( internal_handle->write_io_handle->write_finalized != 0 ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve file IO handle for current chunk.",
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: ltree data can only be appended to an EWF1 logical image before the write is finalized.",
 		 function );
+
+		result = -1;
 	}
-	else if( result != 0 )
+	else if( libewf_single_files_append_utf8_ltree_data(
+	          internal_handle->single_files,
+	          utf8_string,
+	          utf8_string_length,
+	          error ) != 1 )
 	{
-		result = libbfio_file_get_name_size_wide(
-		          file_io_handle,
-		          filename_size,
-		          error );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append ltree data.",
+		 function );
 
-		if( result != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve filename size.",
-			 function );
-		}
+		result = -1;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -8021,7 +27870,7 @@ int libewf_handle_get_filename_size_wide(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
@@ -8030,19 +27879,16 @@ int libewf_handle_get_filename_size_wide(
 	return( result );
 }
 
-/* Retrieves the filename of the segment file of the current chunk
- * The filename size should include the end of string character
- * Returns 1 if successful, 0 if no such filename or -1 on error
+/* Retrieves the root (single) file entry
+ * Returns 1 if successful, 0 if no file entries are present or -1 on error
  */
-int libewf_handle_get_filename_wide(
+int libewf_handle_get_root_file_entry(
      libewf_handle_t *handle,
-     wchar_t *filename,
-     size_t filename_size,
+     libewf_file_entry_t **root_file_entry,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	libbfio_handle_t *file_io_handle          = NULL;
-	static char *function                     = "libewf_handle_get_filename_wide";
+	static char *function                     = "libewf_handle_get_root_file_entry";
 	int result                                = 0;
 
 	if( handle == NULL )
@@ -8058,41 +27904,60 @@ int libewf_handle_get_filename_wide(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( internal_handle->single_files == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing single files.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	result = libewf_internal_handle_get_file_io_handle(
-	          internal_handle,
-	          &file_io_handle,
-	          error );
+	if( root_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid root file entry.",
+		 function );
 
-	if( result == -1 )
+		return( -1 );
+	}
+	if( *root_file_entry != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve file IO handle for current chunk.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: root file entry value already set.",
 		 function );
+
+		return( -1 );
 	}
-	else if( result != 0 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
-		result = libbfio_file_get_name_wide(
-		          file_io_handle,
-		          filename,
-		          filename_size,
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->single_files->root_file_entry_node != NULL )
+	{
+		result = libewf_file_entry_initialize(
+		          root_file_entry,
+		          internal_handle,
+		          internal_handle->single_files->root_file_entry_node,
 		          error );
 
 		if( result != 1 )
@@ -8100,8 +27965,8 @@ int libewf_handle_get_filename_wide(
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve filename.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create root file entry.",
 			 function );
 		}
 	}
@@ -8123,22 +27988,27 @@ int libewf_handle_get_filename_wide(
 	return( result );
 }
 
-#endif
-
-/* Retrieves the file IO handle of the segment file of the current chunk
+/* Retrieves the (single) file entry for the specific UTF-8 encoded path
+ * The path separator is the \ character
  * This function is not multi-thread safe acquire write lock before call
- * Returns 1 if successful, 0 if no such file IO handle or -1 on error
+ * Returns 1 if successful, 0 if no such file entry or -1 on error
  */
-int libewf_internal_handle_get_file_io_handle(
+int libewf_internal_handle_get_file_entry_by_utf8_path(
      libewf_internal_handle_t *internal_handle,
-     libbfio_handle_t **file_io_handle,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libewf_file_entry_t **file_entry,
      libcerror_error_t **error )
 {
-	static char *function      = "libewf_internal_handle_get_file_io_handle";
-	size64_t segment_file_size = 0;
-	uint64_t chunk_index       = 0;
-	int file_io_pool_entry     = 0;
-	int result                 = 0;
+	libewf_single_file_entry_t *single_file_entry     = NULL;
+	libewf_single_file_entry_t *sub_single_file_entry = NULL;
+	libcdata_tree_node_t *node                        = NULL;
+	libcdata_tree_node_t *sub_node                    = NULL;
+	uint8_t *utf8_string_segment                      = NULL;
+	static char *function                             = "libewf_handle_get_file_entry_by_utf8_path";
+	size_t utf8_string_index                          = 0;
+	size_t utf8_string_segment_length                 = 0;
+	int result                                        = 0;
 
 	if( internal_handle == NULL )
 	{
@@ -8151,91 +28021,174 @@ int libewf_internal_handle_get_file_io_handle(
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	if( internal_handle->single_files == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 "%s: invalid handle - missing single files.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+	if( utf8_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string_length > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid UTF-8 string length value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values == NULL )
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_entry != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: file entry value already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+	if( internal_handle->single_files->root_file_entry_node == NULL )
+	{
+		return( 0 );
+	}
+	if( libcdata_tree_node_get_value(
+	     internal_handle->single_files->root_file_entry_node,
+	     (intptr_t **) &single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve value from root file entry node.",
+		 function );
+
+		return( -1 );
+	}
+	if( single_file_entry == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 "%s: missing root file entry values.",
 		 function );
 
 		return( -1 );
 	}
-	chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+	if( utf8_string_length > 0 )
+	{
+		/* Ignore a leading separator
+		 */
+		if( utf8_string[ utf8_string_index ] == (uint8_t) LIBEWF_SEPARATOR )
+		{
+			utf8_string_index++;
+		}
+	}
+	node = internal_handle->single_files->root_file_entry_node;
 
-	result = libewf_segment_table_get_segment_at_offset(
-	          internal_handle->segment_table,
-	          internal_handle->current_offset,
-	          &file_io_pool_entry,
-	          &segment_file_size,
-	          error );
+	if( ( utf8_string_length == 0 )
+	 || ( utf8_string_length == 1 ) )
+	{
+		result = 1;
+	}
+	else while( utf8_string_index < utf8_string_length )
+	{
+		utf8_string_segment        = (uint8_t *) &( utf8_string[ utf8_string_index ] );
+		utf8_string_segment_length = 0;
+
+		while( utf8_string_index < utf8_string_length )
+		{
+			if( ( utf8_string[ utf8_string_index ] == (uint8_t) LIBEWF_SEPARATOR )
+			 || ( utf8_string[ utf8_string_index ] == (uint8_t) 0 ) )
+			{
+				utf8_string_index++;
+
+				break;
+			}
+			utf8_string_index++;
+
+			utf8_string_segment_length++;
+		}
+		if( utf8_string_segment_length == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing sub file entry name.",
+			 function );
 
-	if( result == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve segment at offset: 0x%08" PRIx64 " from segment table.",
-		 function,
-		 internal_handle->current_offset );
+			return( -1 );
+		}
+		result = libewf_single_file_tree_get_sub_node_by_utf8_name(
+			  node,
+			  utf8_string_segment,
+			  utf8_string_segment_length,
+			  &sub_node,
+			  &sub_single_file_entry,
+			  error );
 
-		return( -1 );
-	}
-	else if( result != 0 )
-	{
-		if( file_io_pool_entry == -1 )
+		if( result == -1 )
 		{
-			return( 0 );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve single file entry sub node by name.",
+			 function );
+
+			return( -1 );
 		}
-		if( libbfio_pool_get_handle(
-		     internal_handle->file_io_pool,
-		     file_io_pool_entry,
-		     file_io_handle,
+		else if( result == 0 )
+		{
+			break;
+		}
+		node = sub_node;
+	}
+	if( result != 0 )
+	{
+		if( libewf_file_entry_initialize(
+		     file_entry,
+		     internal_handle,
+		     node,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve file IO handle: %d from pool (chunk: %" PRIu64 ").",
-			 function,
-			 file_io_pool_entry,
-			 chunk_index );
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file entry.",
+			 function );
 
 			return( -1 );
 		}
@@ -8243,16 +28196,19 @@ int libewf_internal_handle_get_file_io_handle(
 	return( result );
 }
 
-/* Retrieves the file IO handle of the segment file of the current chunk
- * Returns 1 if successful, 0 if no such file IO handle or -1 on error
+/* Retrieves the (single) file entry for the specific UTF-8 encoded path
+ * The path separator is the \ character
+ * Returns 1 if successful, 0 if no such file entry or -1 on error
  */
-int libewf_handle_get_file_io_handle(
+int libewf_handle_get_file_entry_by_utf8_path(
      libewf_handle_t *handle,
-     libbfio_handle_t **file_io_handle,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libewf_file_entry_t **file_entry,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_file_io_handle";
+	static char *function                     = "libewf_handle_get_file_entry_by_utf8_path";
 	int result                                = 0;
 
 	if( handle == NULL )
@@ -8283,9 +28239,11 @@ int libewf_handle_get_file_io_handle(
 		return( -1 );
 	}
 #endif
-	result = libewf_internal_handle_get_file_io_handle(
+	result = libewf_internal_handle_get_file_entry_by_utf8_path(
 	          internal_handle,
-	          file_io_handle,
+	          utf8_string,
+	          utf8_string_length,
+	          file_entry,
 	          error );
 
 	if( result == -1 )
@@ -8294,7 +28252,7 @@ int libewf_handle_get_file_io_handle(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve file IO handle for current chunk.",
+		 "%s: unable to retrieve file entry by UTF-8 path.",
 		 function );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
@@ -8315,20 +28273,27 @@ int libewf_handle_get_file_io_handle(
 	return( result );
 }
 
-/* Retrieves the media values
- * Returns 1 if successful or -1 on error
+/* Retrieves the (single) file entry for the specific UTF-16 encoded path
+ * The path separator is the \ character
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful, 0 if no such file entry or -1 on error
  */
-int libewf_internal_handle_get_media_values(
+int libewf_internal_handle_get_file_entry_by_utf16_path(
      libewf_internal_handle_t *internal_handle,
-     size64_t *media_size,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libewf_file_entry_t **file_entry,
      libcerror_error_t **error )
 {
-	libewf_chunk_data_t *chunk_data = NULL;
-	static char *function           = "libewf_internal_handle_get_media_values";
-	off64_t chunk_data_offset       = 0;
-	size64_t chunks_data_size       = 0;
-	size64_t sector_data_size       = 0;
-	uint64_t chunk_index            = 0;
+	libewf_single_file_entry_t *single_file_entry     = NULL;
+	libewf_single_file_entry_t *sub_single_file_entry = NULL;
+	libcdata_tree_node_t *node                        = NULL;
+	libcdata_tree_node_t *sub_node                    = NULL;
+	uint16_t *utf16_string_segment                    = NULL;
+	static char *function                             = "libewf_handle_get_file_entry_by_utf16_path";
+	size_t utf16_string_index                         = 0;
+	size_t utf16_string_segment_length                = 0;
+	int result                                        = 0;
 
 	if( internal_handle == NULL )
 	{
@@ -8341,291 +28306,194 @@ int libewf_internal_handle_get_media_values(
 
 		return( -1 );
 	}
-	if( internal_handle->media_values == NULL )
+	if( internal_handle->single_files == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
-		 function );
-
-		return( -1 );
-	}
-	if( media_size == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid media size.",
+		 "%s: invalid handle - missing single files.",
 		 function );
 
 		return( -1 );
 	}
-	sector_data_size  = internal_handle->media_values->number_of_sectors;
-	sector_data_size *= internal_handle->media_values->bytes_per_sector;
-
-	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
-	{
-		if( internal_handle->media_values->number_of_chunks > 0 )
-		{
-			chunk_index = internal_handle->media_values->number_of_chunks - 1;
-
-			if( libewf_chunk_table_get_chunk_data_by_offset(
-			     internal_handle->chunk_table,
-			     chunk_index,
-			     internal_handle->io_handle,
-			     internal_handle->file_io_pool,
-			     internal_handle->media_values,
-			     internal_handle->segment_table,
-			     internal_handle->chunk_groups_cache,
-			     internal_handle->chunks_cache,
-			     internal_handle->current_offset,
-			     &chunk_data,
-			     &chunk_data_offset,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve chunk: %" PRIu64 " data.",
-				 function,
-				 chunk_index );
-
-				return( -1 );
-			}
-			if( chunk_data == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: missing chunk: %" PRIu64 " data.",
-				 function,
-				 chunk_index );
-
-				return( -1 );
-			}
-			chunks_data_size = chunk_index
-			                 * internal_handle->media_values->sectors_per_chunk
-			                 * internal_handle->media_values->bytes_per_sector;
-
-			/* The only way to determine the size of the last compressed chunk
-			 * is to decompress it
-			 */
-			if( libewf_chunk_data_unpack(
-			     chunk_data,
-			     internal_handle->io_handle,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GENERIC,
-				 "%s: unable to unpack chunk: %" PRIu64 " data.",
-				 function,
-				 chunk_index );
-
-				return( -1 );
-			}
-			if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) == 0 )
-			{
-				chunks_data_size += chunk_data->data_size;
-			}
-			if( sector_data_size != chunks_data_size )
-			{
-#if defined( HAVE_VERBOSE_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: mismatch of media data size in volume: %" PRIu64 " and chunk table: %" PRIu64 "\n",
-					 function,
-					 sector_data_size,
-					 chunks_data_size );
-				}
-#endif
-				if( sector_data_size < chunks_data_size )
-				{
-					sector_data_size = chunks_data_size;
-				}
-			}
-		}
-	}
-	*media_size = sector_data_size;
-
-	return( 1 );
-}
-
-/* Sets the media values
- * Returns 1 if successful or -1 on error
- */
-int libewf_internal_handle_set_media_values(
-     libewf_internal_handle_t *internal_handle,
-     uint32_t sectors_per_chunk,
-     uint32_t bytes_per_sector,
-     size64_t media_size,
-     libcerror_error_t **error )
-{
-	static char *function            = "libewf_internal_handle_set_media_values";
-	size32_t chunk_size              = 0;
-	size64_t maximum_input_file_size = 0;
-	uint64_t number_of_chunks        = 0;
-	uint64_t number_of_sectors       = 0;
-
-	if( internal_handle == NULL )
+	if( utf16_string == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
-		 function );
-
-		return( -1 );
-	}
-	if( internal_handle->media_values == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 "%s: invalid UTF-16 string.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( sectors_per_chunk == 0 )
-	 || ( sectors_per_chunk > (uint32_t) INT32_MAX ) )
+	if( utf16_string_length > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid sectors per chunk.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid UTF-16 string length value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( bytes_per_sector == 0 )
-	 || ( bytes_per_sector > (uint32_t) INT32_MAX ) )
+	if( file_entry == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid bytes per sector.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
 		 function );
 
 		return( -1 );
 	}
-	if( media_size > (size64_t) INT64_MAX )
+	if( *file_entry != NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid media size value exceeds maximum.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: file entry value already set.",
 		 function );
 
 		return( -1 );
 	}
-	/* Determine the chunk size
-	 */
-	chunk_size = sectors_per_chunk * bytes_per_sector;
-
-	if( ( chunk_size == 0 )
-	 || ( chunk_size > (size32_t) INT32_MAX ) )
+	if( internal_handle->single_files->root_file_entry_node == NULL )
+	{
+		return( 0 );
+	}
+	if( libcdata_tree_node_get_value(
+	     internal_handle->single_files->root_file_entry_node,
+	     (intptr_t **) &single_file_entry,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid chunk size.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve value from root file entry node.",
 		 function );
 
 		return( -1 );
 	}
-	/* Check if the input file size does not exceed the maximum possible input file size
-	 * for the chunk size
-	 */
-	maximum_input_file_size = (size64_t) chunk_size * (size64_t) UINT32_MAX;
-
-	if( media_size > maximum_input_file_size )
+	if( single_file_entry == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: media size cannot be larger than size: %" PRIu64 " with a chunk size of: %" PRIu32 ".",
-		 function,
-		 maximum_input_file_size,
-		 chunk_size );
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing root file entry values.",
+		 function );
 
 		return( -1 );
 	}
-	internal_handle->media_values->sectors_per_chunk = sectors_per_chunk;
-	internal_handle->media_values->bytes_per_sector  = bytes_per_sector;
-	internal_handle->media_values->chunk_size        = chunk_size;
-	internal_handle->media_values->media_size        = media_size;
-
-	/* If a media size was provided
-	 */
-	if( media_size > 0 )
+	if( utf16_string_length > 0 )
 	{
-		/* Determine the number of chunks to write
+		/* Ignore a leading separator
 		 */
-		number_of_chunks = (uint64_t) media_size / (uint64_t) chunk_size;
+		if( utf16_string[ utf16_string_index ] == (uint16_t) LIBEWF_SEPARATOR )
+		{
+			utf16_string_index++;
+		}
+	}
+	node = internal_handle->single_files->root_file_entry_node;
 
-		if( ( (uint64_t) media_size % (uint64_t) chunk_size ) != 0 )
+	if( ( utf16_string_length == 0 )
+	 || ( utf16_string_length == 1 ) )
+	{
+		result = 1;
+	}
+	else while( utf16_string_index < utf16_string_length )
+	{
+		utf16_string_segment        = (uint16_t *) &( utf16_string[ utf16_string_index ] );
+		utf16_string_segment_length = 0;
+
+		while( utf16_string_index < utf16_string_length )
 		{
-			number_of_chunks += 1;
+			if( ( utf16_string[ utf16_string_index ] == (uint16_t) LIBEWF_SEPARATOR )
+			 || ( utf16_string[ utf16_string_index ] == (uint16_t) 0 ) )
+			{
+				utf16_string_index++;
+
+				break;
+			}
+			utf16_string_index++;
+
+			utf16_string_segment_length++;
 		}
-		if( number_of_chunks > (uint64_t) UINT32_MAX )
+		if( utf16_string_segment_length == 0 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-			 "%s: invalid number of chunks value exceeds maximum.",
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing sub file entry name.",
 			 function );
 
 			return( -1 );
 		}
-		internal_handle->media_values->number_of_chunks = (uint64_t) number_of_chunks;
+		result = libewf_single_file_tree_get_sub_node_by_utf16_name(
+			  node,
+			  utf16_string_segment,
+			  utf16_string_segment_length,
+			  &sub_node,
+			  &sub_single_file_entry,
+			  error );
 
-		/* Determine the number of sectors to write
-		 */
-		number_of_sectors = (uint64_t) media_size / (uint64_t) bytes_per_sector;
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve single file entry sub node by name.",
+			 function );
 
-		if( number_of_sectors > (uint64_t) INT64_MAX )
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		node = sub_node;
+	}
+	if( result != 0 )
+	{
+		if( libewf_file_entry_initialize(
+		     file_entry,
+		     internal_handle,
+		     node,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-			 "%s: invalid number of sectors value exceeds maximum.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file entry.",
 			 function );
 
 			return( -1 );
 		}
-		internal_handle->media_values->number_of_sectors = number_of_sectors;
 	}
-	return( 1 );
+	return( result );
 }
 
-/* Retrieves the root (single) file entry
- * Returns 1 if successful, 0 if no file entries are present or -1 on error
+/* Retrieves the (single) file entry for the specific UTF-16 encoded path
+ * The path separator is the \ character
+ * Returns 1 if successful, 0 if no such file entry or -1 on error
  */
-int libewf_handle_get_root_file_entry(
+int libewf_handle_get_file_entry_by_utf16_path(
      libewf_handle_t *handle,
-     libewf_file_entry_t **root_file_entry,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libewf_file_entry_t **file_entry,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_root_file_entry";
+	static char *function                     = "libewf_handle_get_file_entry_by_utf16_path";
 	int result                                = 0;
 
 	if( handle == NULL )
@@ -8641,113 +28509,190 @@ int libewf_handle_get_root_file_entry(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->single_files == NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing single files.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	if( root_file_entry == NULL )
+#endif
+	result = libewf_internal_handle_get_file_entry_by_utf16_path(
+	          internal_handle,
+	          utf16_string,
+	          utf16_string_length,
+	          file_entry,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file entry by UTF-16 path.",
+		 function );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Reads a chunk of (media) data for libewf_handle_read_file_entries_data
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libewf_internal_handle_read_file_entries_chunk(
+         libewf_internal_handle_t *internal_handle,
+         uint8_t *chunk_buffer,
+         uint64_t chunk_index,
+         uint64_t *read_ahead_next_chunk_index,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_read_file_entries_chunk";
+	off64_t chunk_offset  = 0;
+	size_t read_size      = 0;
+	ssize_t read_count    = 0;
+
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid root file entry.",
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( *root_file_entry != NULL )
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: root file entry value already set.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	chunk_offset = (off64_t) chunk_index * internal_handle->media_values->chunk_size;
+
+	if( (size64_t) chunk_offset >= internal_handle->media_values->media_size )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk index value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( internal_handle->single_files->root_file_entry_node != NULL )
-	{
-		result = libewf_file_entry_initialize(
-		          root_file_entry,
-		          internal_handle,
-		          internal_handle->single_files->root_file_entry_node,
-		          error );
+	read_size = (size_t) internal_handle->media_values->chunk_size;
 
-		if( result != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create root file entry.",
-			 function );
-		}
+	if( (size64_t) read_size > ( internal_handle->media_values->media_size - chunk_offset ) )
+	{
+		read_size = (size_t) ( internal_handle->media_values->media_size - chunk_offset );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	/* Concurrent reads are only supported on read-only access
+	 */
+	if( internal_handle->write_io_handle == NULL )
+	{
+		read_count = libewf_internal_handle_read_buffer_at_offset_concurrent(
+		              internal_handle,
+		              chunk_buffer,
+		              read_size,
+		              chunk_offset,
+		              read_ahead_next_chunk_index,
+		              internal_handle->media_values->number_of_chunks,
+		              error );
+	}
+	else
+	{
+		read_count = libewf_handle_read_buffer_at_offset(
+		              (libewf_handle_t *) internal_handle,
+		              chunk_buffer,
+		              read_size,
+		              chunk_offset,
+		              error );
+	}
+	if( read_count != (ssize_t) read_size )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
 
 		return( -1 );
 	}
-#endif
-	return( result );
+	return( read_count );
 }
 
-/* Retrieves the (single) file entry for the specific UTF-8 encoded path
- * The path separator is the \ character
- * This function is not multi-thread safe acquire write lock before call
- * Returns 1 if successful, 0 if no such file entry or -1 on error
+/* Reads the data of the (single) file entries in order of their (media) data offset
+ * The callback function is called with consecutive slices of the data of every file,
+ * where a slice is part of a single chunk. Every chunk is read and decompressed once,
+ * also if it contains the data of multiple files. The file entry passed to the callback
+ * function is only valid during the call. Files without data are skipped.
+ * The callback function returns 1 to continue, 0 to stop or -1 on error
+ * Returns 1 if successful, 0 if stopped by the callback function or -1 on error
  */
-int libewf_internal_handle_get_file_entry_by_utf8_path(
-     libewf_internal_handle_t *internal_handle,
-     const uint8_t *utf8_string,
-     size_t utf8_string_length,
-     libewf_file_entry_t **file_entry,
+int libewf_handle_read_file_entries_data(
+     libewf_handle_t *handle,
+     int (*callback_function)(
+            libewf_file_entry_t *file_entry,
+            off64_t offset,
+            const uint8_t *data,
+            size_t data_size,
+            void *callback_data,
+            libcerror_error_t **error ),
+     void *callback_data,
      libcerror_error_t **error )
 {
-	libewf_single_file_entry_t *single_file_entry     = NULL;
-	libewf_single_file_entry_t *sub_single_file_entry = NULL;
-	libcdata_tree_node_t *node                        = NULL;
-	libcdata_tree_node_t *sub_node                    = NULL;
-	uint8_t *utf8_string_segment                      = NULL;
-	static char *function                             = "libewf_handle_get_file_entry_by_utf8_path";
-	size_t utf8_string_index                          = 0;
-	size_t utf8_string_segment_length                 = 0;
-	int result                                        = 0;
+	libewf_file_entry_t *file_entry                 = NULL;
+	libewf_internal_handle_t *internal_handle       = NULL;
+	libewf_single_file_entry_t *single_file_entry   = NULL;
+	libewf_single_files_data_entry_t *data_entries  = NULL;
+	uint8_t *chunk_buffer                           = NULL;
+	uint8_t *sparse_data_buffer                     = NULL;
+	static char *function                           = "libewf_handle_read_file_entries_data";
+	size_t chunk_buffer_data_size                   = 0;
+	size_t chunk_data_offset                        = 0;
+	size_t data_size                                = 0;
+	ssize_t read_count                              = 0;
+	off64_t media_offset                            = 0;
+	size64_t offset                                 = 0;
+	uint64_t chunk_buffer_index                     = 0;
+	uint64_t chunk_index                            = 0;
+	uint64_t read_ahead_next_chunk_index            = 0;
+	uint32_t chunk_size                             = 0;
+	int data_entry_index                            = 0;
+	int number_of_data_entries                      = 0;
+	int result                                      = 1;
 
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -8758,6 +28703,19 @@ int libewf_internal_handle_get_file_entry_by_utf8_path(
 
 		return( -1 );
 	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
 	if( internal_handle->single_files == NULL )
 	{
 		libcerror_error_set(
@@ -8769,184 +28727,366 @@ int libewf_internal_handle_get_file_entry_by_utf8_path(
 
 		return( -1 );
 	}
-	if( utf8_string == NULL )
+	if( callback_function == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid UTF-8 string.",
+		 "%s: invalid callback function.",
 		 function );
 
 		return( -1 );
 	}
-	if( utf8_string_length > (size_t) SSIZE_MAX )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid UTF-8 string length value exceeds maximum.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	if( file_entry == NULL )
+#endif
+	chunk_size = internal_handle->media_values->chunk_size;
+
+	result = libewf_single_files_get_data_entries(
+	          internal_handle->single_files,
+	          &data_entries,
+	          &number_of_data_entries,
+	          error );
+
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file entry.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data entries.",
 		 function );
-
-		return( -1 );
 	}
-	if( *file_entry != NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: file entry value already set.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( internal_handle->single_files->root_file_entry_node == NULL )
+#endif
+	if( result != 1 )
 	{
-		return( 0 );
+		goto on_error;
 	}
-	if( libcdata_tree_node_get_value(
-	     internal_handle->single_files->root_file_entry_node,
-	     (intptr_t **) &single_file_entry,
-	     error ) != 1 )
+	if( number_of_data_entries == 0 )
+	{
+		return( 1 );
+	}
+	if( ( chunk_size == 0 )
+	 || ( chunk_size > (uint32_t) INT32_MAX ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve value from root file entry node.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid media values - chunk size value out of bounds.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( single_file_entry == NULL )
+	chunk_buffer = (uint8_t *) memory_allocate(
+	                            sizeof( uint8_t ) * chunk_size );
+
+	if( chunk_buffer == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing root file entry values.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk buffer.",
 		 function );
 
-		return( -1 );
-	}
-	if( utf8_string_length > 0 )
-	{
-		/* Ignore a leading separator
-		 */
-		if( utf8_string[ utf8_string_index ] == (uint8_t) LIBEWF_SEPARATOR )
-		{
-			utf8_string_index++;
-		}
-	}
-	node = internal_handle->single_files->root_file_entry_node;
-
-	if( ( utf8_string_length == 0 )
-	 || ( utf8_string_length == 1 ) )
-	{
-		result = 1;
+		goto on_error;
 	}
-	else while( utf8_string_index < utf8_string_length )
+	/* The data entries are sorted by data offset, hence the chunks are read in
+	 * ascending order and the chunk in the buffer is reused by consecutive files
+	 */
+	for( data_entry_index = 0;
+	     data_entry_index < number_of_data_entries;
+	     data_entry_index++ )
 	{
-		utf8_string_segment        = (uint8_t *) &( utf8_string[ utf8_string_index ] );
-		utf8_string_segment_length = 0;
-
-		while( utf8_string_index < utf8_string_length )
+		if( libcdata_tree_node_get_value(
+		     data_entries[ data_entry_index ].file_entry_node,
+		     (intptr_t **) &single_file_entry,
+		     error ) != 1 )
 		{
-			if( ( utf8_string[ utf8_string_index ] == (uint8_t) LIBEWF_SEPARATOR )
-			 || ( utf8_string[ utf8_string_index ] == (uint8_t) 0 ) )
-			{
-				utf8_string_index++;
-
-				break;
-			}
-			utf8_string_index++;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve single file entry: %d.",
+			 function,
+			 data_entry_index );
 
-			utf8_string_segment_length++;
+			goto on_error;
 		}
-		if( utf8_string_segment_length == 0 )
+		if( single_file_entry == NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing sub file entry name.",
-			 function );
+			 "%s: missing single file entry: %d.",
+			 function,
+			 data_entry_index );
 
-			return( -1 );
+			goto on_error;
 		}
-		result = libewf_single_file_tree_get_sub_node_by_utf8_name(
-			  node,
-			  utf8_string_segment,
-			  utf8_string_segment_length,
-			  &sub_node,
-			  &sub_single_file_entry,
-			  error );
-
-		if( result == -1 )
+		if( libewf_file_entry_initialize(
+		     &file_entry,
+		     internal_handle,
+		     data_entries[ data_entry_index ].file_entry_node,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve single file entry sub node by name.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file entry: %d.",
+			 function,
+			 data_entry_index );
 
-			return( -1 );
+			goto on_error;
 		}
-		else if( result == 0 )
+		offset = 0;
+
+		while( offset < single_file_entry->size )
 		{
-			break;
+			/* Sparse data without a duplicate consists of a single repeated byte
+			 */
+			if( ( ( single_file_entry->flags & LIBEWF_FILE_ENTRY_FLAG_SPARSE_DATA ) != 0 )
+			 && ( single_file_entry->duplicate_data_offset < 0 ) )
+			{
+				media_offset = data_entries[ data_entry_index ].data_offset;
+			}
+			else
+			{
+				media_offset = data_entries[ data_entry_index ].data_offset + (off64_t) offset;
+			}
+			if( media_offset < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid media offset value out of bounds.",
+				 function );
+
+				goto on_error;
+			}
+			chunk_index       = (uint64_t) media_offset / chunk_size;
+			chunk_data_offset = (size_t) ( (uint64_t) media_offset % chunk_size );
+
+			if( ( chunk_buffer_data_size == 0 )
+			 || ( chunk_index != chunk_buffer_index ) )
+			{
+				read_count = libewf_internal_handle_read_file_entries_chunk(
+				              internal_handle,
+				              chunk_buffer,
+				              chunk_index,
+				              &read_ahead_next_chunk_index,
+				              error );
+
+				if( read_count == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read chunk: %" PRIu64 ".",
+					 function,
+					 chunk_index );
+
+					goto on_error;
+				}
+				chunk_buffer_index     = chunk_index;
+				chunk_buffer_data_size = (size_t) read_count;
+			}
+			if( chunk_data_offset >= chunk_buffer_data_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid chunk data offset value out of bounds.",
+				 function );
+
+				goto on_error;
+			}
+			if( ( ( single_file_entry->flags & LIBEWF_FILE_ENTRY_FLAG_SPARSE_DATA ) != 0 )
+			 && ( single_file_entry->duplicate_data_offset < 0 ) )
+			{
+				if( sparse_data_buffer == NULL )
+				{
+					sparse_data_buffer = (uint8_t *) memory_allocate(
+					                                  sizeof( uint8_t ) * chunk_size );
+
+					if( sparse_data_buffer == NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+						 "%s: unable to create sparse data buffer.",
+						 function );
+
+						goto on_error;
+					}
+				}
+				data_size = (size_t) chunk_size;
+
+				if( (size64_t) data_size > ( single_file_entry->size - offset ) )
+				{
+					data_size = (size_t) ( single_file_entry->size - offset );
+				}
+				if( offset == 0 )
+				{
+					if( memory_set(
+					     sparse_data_buffer,
+					     chunk_buffer[ chunk_data_offset ],
+					     data_size ) == NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+						 "%s: unable to set sparse data buffer.",
+						 function );
+
+						goto on_error;
+					}
+				}
+				result = callback_function(
+				          file_entry,
+				          (off64_t) offset,
+				          sparse_data_buffer,
+				          data_size,
+				          callback_data,
+				          error );
+			}
+			else
+			{
+				data_size = chunk_buffer_data_size - chunk_data_offset;
+
+				if( (size64_t) data_size > ( single_file_entry->size - offset ) )
+				{
+					data_size = (size_t) ( single_file_entry->size - offset );
+				}
+				result = callback_function(
+				          file_entry,
+				          (off64_t) offset,
+				          &( chunk_buffer[ chunk_data_offset ] ),
+				          data_size,
+				          callback_data,
+				          error );
+			}
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: callback function failed for file entry: %d at offset: %" PRIu64 ".",
+				 function,
+				 data_entry_index,
+				 offset );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				break;
+			}
+			offset += data_size;
 		}
-		node = sub_node;
-	}
-	if( result != 0 )
-	{
-		if( libewf_file_entry_initialize(
-		     file_entry,
-		     internal_handle,
-		     node,
+		if( libewf_file_entry_free(
+		     &file_entry,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create file entry.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file entry: %d.",
+			 function,
+			 data_entry_index );
 
-			return( -1 );
+			goto on_error;
+		}
+		if( result == 0 )
+		{
+			break;
 		}
 	}
+	if( sparse_data_buffer != NULL )
+	{
+		memory_free(
+		 sparse_data_buffer );
+	}
+	memory_free(
+	 chunk_buffer );
+
+	memory_free(
+	 data_entries );
+
 	return( result );
+
+on_error:
+	if( file_entry != NULL )
+	{
+		libewf_file_entry_free(
+		 &file_entry,
+		 NULL );
+	}
+	if( sparse_data_buffer != NULL )
+	{
+		memory_free(
+		 sparse_data_buffer );
+	}
+	if( chunk_buffer != NULL )
+	{
+		memory_free(
+		 chunk_buffer );
+	}
+	if( data_entries != NULL )
+	{
+		memory_free(
+		 data_entries );
+	}
+	return( -1 );
 }
 
-/* Retrieves the (single) file entry for the specific UTF-8 encoded path
- * The path separator is the \ character
- * Returns 1 if successful, 0 if no such file entry or -1 on error
+/* Retrieves the number of sectors per chunk
+ * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_file_entry_by_utf8_path(
+int libewf_handle_get_sectors_per_chunk(
      libewf_handle_t *handle,
-     const uint8_t *utf8_string,
-     size_t utf8_string_length,
-     libewf_file_entry_t **file_entry,
+     uint32_t *sectors_per_chunk,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_file_entry_by_utf8_path";
-	int result                                = 0;
+	static char *function                     = "libewf_handle_get_sectors_per_chunk";
 
 	if( handle == NULL )
 	{
@@ -8961,6 +29101,28 @@ int libewf_handle_get_file_entry_by_utf8_path(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( sectors_per_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sectors per chunk.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
@@ -8976,22 +29138,19 @@ int libewf_handle_get_file_entry_by_utf8_path(
 		return( -1 );
 	}
 #endif
-	result = libewf_internal_handle_get_file_entry_by_utf8_path(
-	          internal_handle,
-	          utf8_string,
-	          utf8_string_length,
-	          file_entry,
-	          error );
-
-	if( result == -1 )
+	if( internal_handle->media_values->sectors_per_chunk > (uint32_t) INT32_MAX )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve file entry by UTF-8 path.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid sectors per chunk value exceeds maximum.",
 		 function );
+
+		goto on_error;
 	}
+	*sectors_per_chunk = internal_handle->media_values->sectors_per_chunk;
+
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
@@ -9007,32 +29166,29 @@ int libewf_handle_get_file_entry_by_utf8_path(
 		return( -1 );
 	}
 #endif
-	return( result );
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
 }
 
-/* Retrieves the (single) file entry for the specific UTF-16 encoded path
- * The path separator is the \ character
- * This function is not multi-thread safe acquire write lock before call
- * Returns 1 if successful, 0 if no such file entry or -1 on error
+/* Sets the number of sectors per chunk
+ * Returns 1 if successful or -1 on error
  */
-int libewf_internal_handle_get_file_entry_by_utf16_path(
-     libewf_internal_handle_t *internal_handle,
-     const uint16_t *utf16_string,
-     size_t utf16_string_length,
-     libewf_file_entry_t **file_entry,
+int libewf_handle_set_sectors_per_chunk(
+     libewf_handle_t *handle,
+     uint32_t sectors_per_chunk,
      libcerror_error_t **error )
 {
-	libewf_single_file_entry_t *single_file_entry     = NULL;
-	libewf_single_file_entry_t *sub_single_file_entry = NULL;
-	libcdata_tree_node_t *node                        = NULL;
-	libcdata_tree_node_t *sub_node                    = NULL;
-	uint16_t *utf16_string_segment                    = NULL;
-	static char *function                             = "libewf_handle_get_file_entry_by_utf16_path";
-	size_t utf16_string_index                         = 0;
-	size_t utf16_string_segment_length                = 0;
-	int result                                        = 0;
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_sectors_per_chunk";
 
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -9043,195 +29199,199 @@ int libewf_internal_handle_get_file_entry_by_utf16_path(
 
 		return( -1 );
 	}
-	if( internal_handle->single_files == NULL )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing single files.",
+		 "%s: invalid handle - missing media values.",
 		 function );
 
 		return( -1 );
 	}
-	if( utf16_string == NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid UTF-16 string.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( utf16_string_length > (size_t) SSIZE_MAX )
+#endif
+	if( ( internal_handle->read_io_handle != NULL )
+	 || ( internal_handle->write_io_handle == NULL )
+	 || ( internal_handle->write_io_handle->values_initialized != 0 ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid UTF-16 string length value exceeds maximum.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: sectors per chunk cannot be changed.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( file_entry == NULL )
+	if( libewf_internal_handle_set_media_values(
+	     internal_handle,
+	     sectors_per_chunk,
+	     internal_handle->media_values->bytes_per_sector,
+	     internal_handle->media_values->media_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file entry.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set media values.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( *file_entry != NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: file entry value already set.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->single_files->root_file_entry_node == NULL )
-	{
-		return( 0 );
-	}
-	if( libcdata_tree_node_get_value(
-	     internal_handle->single_files->root_file_entry_node,
-	     (intptr_t **) &single_file_entry,
-	     error ) != 1 )
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Retrieves the number of bytes per sector
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_bytes_per_sector(
+     libewf_handle_t *handle,
+     uint32_t *bytes_per_sector,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_bytes_per_sector";
+
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve value from root file entry node.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( single_file_entry == NULL )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing root file entry values.",
+		 "%s: invalid handle - missing media values.",
 		 function );
 
-		return( -1 );
-	}
-	if( utf16_string_length > 0 )
-	{
-		/* Ignore a leading separator
-		 */
-		if( utf16_string[ utf16_string_index ] == (uint16_t) LIBEWF_SEPARATOR )
-		{
-			utf16_string_index++;
-		}
-	}
-	node = internal_handle->single_files->root_file_entry_node;
-
-	if( ( utf16_string_length == 0 )
-	 || ( utf16_string_length == 1 ) )
-	{
-		result = 1;
-	}
-	else while( utf16_string_index < utf16_string_length )
-	{
-		utf16_string_segment        = (uint16_t *) &( utf16_string[ utf16_string_index ] );
-		utf16_string_segment_length = 0;
-
-		while( utf16_string_index < utf16_string_length )
-		{
-			if( ( utf16_string[ utf16_string_index ] == (uint16_t) LIBEWF_SEPARATOR )
-			 || ( utf16_string[ utf16_string_index ] == (uint16_t) 0 ) )
-			{
-				utf16_string_index++;
-
-				break;
-			}
-			utf16_string_index++;
-
-			utf16_string_segment_length++;
-		}
-		if( utf16_string_segment_length == 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing sub file entry name.",
-			 function );
+		return( -1 );
+	}
+	if( bytes_per_sector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bytes per sector.",
+		 function );
 
-			return( -1 );
-		}
-		result = libewf_single_file_tree_get_sub_node_by_utf16_name(
-			  node,
-			  utf16_string_segment,
-			  utf16_string_segment_length,
-			  &sub_node,
-			  &sub_single_file_entry,
-			  error );
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
 
-		if( result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve single file entry sub node by name.",
-			 function );
+		return( -1 );
+	}
+#endif
+	if( internal_handle->media_values->bytes_per_sector > (uint32_t) INT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid bytes per sector value exceeds maximum.",
+		 function );
 
-			return( -1 );
-		}
-		else if( result == 0 )
-		{
-			break;
-		}
-		node = sub_node;
+		goto on_error;
 	}
-	if( result != 0 )
+	*bytes_per_sector = internal_handle->media_values->bytes_per_sector;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
-		if( libewf_file_entry_initialize(
-		     file_entry,
-		     internal_handle,
-		     node,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create file entry.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
 
-			return( -1 );
-		}
+		return( -1 );
 	}
-	return( result );
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
 }
 
-/* Retrieves the (single) file entry for the specific UTF-16 encoded path
- * The path separator is the \ character
- * Returns 1 if successful, 0 if no such file entry or -1 on error
+/* Sets the number of bytes per sector
+ * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_file_entry_by_utf16_path(
+int libewf_handle_set_bytes_per_sector(
      libewf_handle_t *handle,
-     const uint16_t *utf16_string,
-     size_t utf16_string_length,
-     libewf_file_entry_t **file_entry,
+     uint32_t bytes_per_sector,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_file_entry_by_utf16_path";
-	int result                                = 0;
+	static char *function                     = "libewf_handle_set_bytes_per_sector";
 
 	if( handle == NULL )
 	{
@@ -9246,8 +29406,19 @@ int libewf_handle_get_file_entry_by_utf16_path(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -9255,30 +29426,43 @@ int libewf_handle_get_file_entry_by_utf16_path(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	result = libewf_internal_handle_get_file_entry_by_utf16_path(
-	          internal_handle,
-	          utf16_string,
-	          utf16_string_length,
-	          file_entry,
-	          error );
+	if( ( internal_handle->read_io_handle != NULL )
+	 || ( internal_handle->write_io_handle == NULL )
+	 || ( internal_handle->write_io_handle->values_initialized != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: bytes per sector cannot be changed.",
+		 function );
 
-	if( result == -1 )
+		goto on_error;
+	}
+	if( libewf_internal_handle_set_media_values(
+	     internal_handle,
+	     internal_handle->media_values->sectors_per_chunk,
+	     bytes_per_sector,
+	     internal_handle->media_values->media_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve file entry by UTF-16 path.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set media values.",
 		 function );
+
+		goto on_error;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -9286,25 +29470,33 @@ int libewf_handle_get_file_entry_by_utf16_path(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( result );
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
 }
 
-/* Retrieves the number of sectors per chunk
+/* Retrieves the number of sectors
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_sectors_per_chunk(
+int libewf_handle_get_number_of_sectors(
      libewf_handle_t *handle,
-     uint32_t *sectors_per_chunk,
+     uint64_t *number_of_sectors,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_sectors_per_chunk";
+	static char *function                     = "libewf_handle_get_number_of_sectors";
 
 	if( handle == NULL )
 	{
@@ -9330,13 +29522,13 @@ int libewf_handle_get_sectors_per_chunk(
 
 		return( -1 );
 	}
-	if( sectors_per_chunk == NULL )
+	if( number_of_sectors == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid sectors per chunk.",
+		 "%s: invalid bytes per sector.",
 		 function );
 
 		return( -1 );
@@ -9356,18 +29548,18 @@ int libewf_handle_get_sectors_per_chunk(
 		return( -1 );
 	}
 #endif
-	if( internal_handle->media_values->sectors_per_chunk > (uint32_t) INT32_MAX )
+	if( internal_handle->media_values->number_of_sectors > (uint64_t) INT64_MAX )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid sectors per chunk value exceeds maximum.",
+		 "%s: invalid number of sectors value exceeds maximum.",
 		 function );
 
 		goto on_error;
 	}
-	*sectors_per_chunk = internal_handle->media_values->sectors_per_chunk;
+	*number_of_sectors = internal_handle->media_values->number_of_sectors;
 
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
@@ -9395,16 +29587,16 @@ on_error:
 	return( -1 );
 }
 
-/* Sets the number of sectors per chunk
+/* Retrieves the chunk size
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_sectors_per_chunk(
+int libewf_handle_get_chunk_size(
      libewf_handle_t *handle,
-     uint32_t sectors_per_chunk,
+     size32_t *chunk_size,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_sectors_per_chunk";
+	static char *function                     = "libewf_handle_get_chunk_size";
 
 	if( handle == NULL )
 	{
@@ -9430,52 +29622,47 @@ int libewf_handle_set_sectors_per_chunk(
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( chunk_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk size.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( ( internal_handle->read_io_handle != NULL )
-	 || ( internal_handle->write_io_handle == NULL )
-	 || ( internal_handle->write_io_handle->values_initialized != 0 ) )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: sectors per chunk cannot be changed.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libewf_internal_handle_set_media_values(
-	     internal_handle,
-	     sectors_per_chunk,
-	     internal_handle->media_values->bytes_per_sector,
-	     internal_handle->media_values->media_size,
-	     error ) != 1 )
+#endif
+	if( internal_handle->media_values->chunk_size > (size32_t) INT32_MAX )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set media values.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk size value exceeds maximum.",
 		 function );
 
 		goto on_error;
 	}
+	*chunk_size = internal_handle->media_values->chunk_size;
+
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -9483,7 +29670,7 @@ int libewf_handle_set_sectors_per_chunk(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
@@ -9493,23 +29680,23 @@ int libewf_handle_set_sectors_per_chunk(
 
 on_error:
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
+	libcthreads_read_write_lock_release_for_read(
 	 internal_handle->read_write_lock,
 	 NULL );
 #endif
 	return( -1 );
 }
 
-/* Retrieves the number of bytes per sector
+/* Retrieves the error granularity
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_bytes_per_sector(
+int libewf_handle_get_error_granularity(
      libewf_handle_t *handle,
-     uint32_t *bytes_per_sector,
+     uint32_t *error_granularity,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_bytes_per_sector";
+	static char *function                     = "libewf_handle_get_error_granularity";
 
 	if( handle == NULL )
 	{
@@ -9535,13 +29722,13 @@ int libewf_handle_get_bytes_per_sector(
 
 		return( -1 );
 	}
-	if( bytes_per_sector == NULL )
+	if( error_granularity == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid bytes per sector.",
+		 "%s: invalid error granularity.",
 		 function );
 
 		return( -1 );
@@ -9561,18 +29748,18 @@ int libewf_handle_get_bytes_per_sector(
 		return( -1 );
 	}
 #endif
-	if( internal_handle->media_values->bytes_per_sector > (uint32_t) INT32_MAX )
+	if( internal_handle->media_values->error_granularity > (uint32_t) INT32_MAX )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid bytes per sector value exceeds maximum.",
+		 "%s: invalid error granularity value exceeds maximum.",
 		 function );
 
 		goto on_error;
 	}
-	*bytes_per_sector = internal_handle->media_values->bytes_per_sector;
+	*error_granularity = internal_handle->media_values->error_granularity;
 
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
@@ -9600,16 +29787,16 @@ on_error:
 	return( -1 );
 }
 
-/* Sets the number of bytes per sector
+/* Sets the error granularity
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_bytes_per_sector(
+int libewf_handle_set_error_granularity(
      libewf_handle_t *handle,
-     uint32_t bytes_per_sector,
+     uint32_t error_granularity,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_bytes_per_sector";
+	static char *function                     = "libewf_handle_set_error_granularity";
 
 	if( handle == NULL )
 	{
@@ -9650,35 +29837,20 @@ int libewf_handle_set_bytes_per_sector(
 		return( -1 );
 	}
 #endif
-	if( ( internal_handle->read_io_handle != NULL )
-	 || ( internal_handle->write_io_handle == NULL )
+	if( ( internal_handle->write_io_handle == NULL )
 	 || ( internal_handle->write_io_handle->values_initialized != 0 ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: bytes per sector cannot be changed.",
+		 "%s: error granularity cannot be changed.",
 		 function );
 
 		goto on_error;
 	}
-	if( libewf_internal_handle_set_media_values(
-	     internal_handle,
-	     internal_handle->media_values->sectors_per_chunk,
-	     bytes_per_sector,
-	     internal_handle->media_values->media_size,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set media values.",
-		 function );
+	internal_handle->media_values->error_granularity = error_granularity;
 
-		goto on_error;
-	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
@@ -9705,16 +29877,16 @@ on_error:
 	return( -1 );
 }
 
-/* Retrieves the number of sectors
+/* Retrieves the compression method
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_number_of_sectors(
+int libewf_handle_get_compression_method(
      libewf_handle_t *handle,
-     uint64_t *number_of_sectors,
+     uint16_t *compression_method,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_number_of_sectors";
+	static char *function                     = "libewf_handle_get_compression_method";
 
 	if( handle == NULL )
 	{
@@ -9729,24 +29901,24 @@ int libewf_handle_get_number_of_sectors(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->media_values == NULL )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( number_of_sectors == NULL )
+	if( compression_method == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid bytes per sector.",
+		 "%s: invalid compression method.",
 		 function );
 
 		return( -1 );
@@ -9766,18 +29938,7 @@ int libewf_handle_get_number_of_sectors(
 		return( -1 );
 	}
 #endif
-	if( internal_handle->media_values->number_of_sectors > (uint64_t) INT64_MAX )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid number of sectors value exceeds maximum.",
-		 function );
-
-		goto on_error;
-	}
-	*number_of_sectors = internal_handle->media_values->number_of_sectors;
+	*compression_method = internal_handle->io_handle->compression_method;
 
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
@@ -9795,26 +29956,18 @@ int libewf_handle_get_number_of_sectors(
 	}
 #endif
 	return( 1 );
-
-on_error:
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_read(
-	 internal_handle->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
 }
 
-/* Retrieves the chunk size
+/* Sets the compression method
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_chunk_size(
+int libewf_handle_set_compression_method(
      libewf_handle_t *handle,
-     size32_t *chunk_size,
+     uint16_t compression_method,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_chunk_size";
+	static char *function                     = "libewf_handle_set_compression_method";
 
 	if( handle == NULL )
 	{
@@ -9829,30 +29982,32 @@ int libewf_handle_get_chunk_size(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->media_values == NULL )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( chunk_size == NULL )
+	if( ( compression_method != LIBEWF_COMPRESSION_METHOD_DEFLATE )
+	 && ( compression_method != LIBEWF_COMPRESSION_METHOD_BZIP2 )
+	 && ( compression_method != LIBEWF_COMPRESSION_METHOD_ZSTD ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk size.",
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported compression method.",
 		 function );
 
 		return( -1 );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -9860,27 +30015,42 @@ int libewf_handle_get_chunk_size(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( internal_handle->media_values->chunk_size > (size32_t) INT32_MAX )
+	if( ( internal_handle->write_io_handle == NULL )
+	 || ( internal_handle->write_io_handle->values_initialized != 0 ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid chunk size value exceeds maximum.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: compression values cannot be changed.",
 		 function );
 
 		goto on_error;
 	}
-	*chunk_size = internal_handle->media_values->chunk_size;
+	if( ( ( compression_method == LIBEWF_COMPRESSION_METHOD_BZIP2 )
+	  || ( compression_method == LIBEWF_COMPRESSION_METHOD_ZSTD ) )
+	 && ( internal_handle->io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_EWF2 )
+	 && ( internal_handle->io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_EWF2_LOGICAL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: compression method not supported by format.",
+		 function );
+
+		goto on_error;
+	}
+	internal_handle->io_handle->compression_method = compression_method;
 
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -9888,7 +30058,7 @@ int libewf_handle_get_chunk_size(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
@@ -9898,23 +30068,24 @@ int libewf_handle_get_chunk_size(
 
 on_error:
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_read(
+	libcthreads_read_write_lock_release_for_write(
 	 internal_handle->read_write_lock,
 	 NULL );
 #endif
 	return( -1 );
 }
 
-/* Retrieves the error granularity
+/* Retrieves the compression values
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_error_granularity(
+int libewf_handle_get_compression_values(
      libewf_handle_t *handle,
-     uint32_t *error_granularity,
+     int8_t *compression_level,
+     uint8_t *compression_flags,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_error_granularity";
+	static char *function                     = "libewf_handle_get_compression_values";
 
 	if( handle == NULL )
 	{
@@ -9929,24 +30100,35 @@ int libewf_handle_get_error_granularity(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->media_values == NULL )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( error_granularity == NULL )
+	if( compression_level == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid error granularity.",
+		 "%s: invalid compression level.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression flags.",
 		 function );
 
 		return( -1 );
@@ -9966,18 +30148,8 @@ int libewf_handle_get_error_granularity(
 		return( -1 );
 	}
 #endif
-	if( internal_handle->media_values->error_granularity > (uint32_t) INT32_MAX )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid error granularity value exceeds maximum.",
-		 function );
-
-		goto on_error;
-	}
-	*error_granularity = internal_handle->media_values->error_granularity;
+	*compression_level = internal_handle->io_handle->compression_level;
+	*compression_flags = internal_handle->io_handle->compression_flags;
 
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
@@ -9995,26 +30167,19 @@ int libewf_handle_get_error_granularity(
 	}
 #endif
 	return( 1 );
-
-on_error:
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_read(
-	 internal_handle->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
 }
 
-/* Sets the error granularity
+/* Sets the compression values
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_error_granularity(
+int libewf_handle_set_compression_values(
      libewf_handle_t *handle,
-     uint32_t error_granularity,
+     int8_t compression_level,
+     uint8_t compression_flags,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_error_granularity";
+	static char *function                     = "libewf_handle_set_compression_values";
 
 	if( handle == NULL )
 	{
@@ -10029,13 +30194,37 @@ int libewf_handle_set_error_granularity(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->media_values == NULL )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( compression_level != LIBEWF_COMPRESSION_NONE )
+	 && ( compression_level != LIBEWF_COMPRESSION_FAST )
+	 && ( compression_level != LIBEWF_COMPRESSION_BEST ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported compression level.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( compression_flags & ~( LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION | LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION ) ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported compression flags.",
 		 function );
 
 		return( -1 );
@@ -10062,12 +30251,18 @@ int libewf_handle_set_error_granularity(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: error granularity cannot be changed.",
+		 "%s: compression values cannot be changed.",
 		 function );
 
 		goto on_error;
 	}
-	internal_handle->media_values->error_granularity = error_granularity;
+	if( ( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF2 )
+	 && ( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF2_LOGICAL ) )
+	{
+		compression_flags |= LIBEWF_COMPRESS_FLAG_USE_PATTERN_FILL_COMPRESSION;
+	}
+	internal_handle->io_handle->compression_level = compression_level;
+	internal_handle->io_handle->compression_flags = compression_flags;
 
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -10095,16 +30290,16 @@ on_error:
 	return( -1 );
 }
 
-/* Retrieves the compression method
+/* Retrieves the size of the contained media data
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_compression_method(
+int libewf_handle_get_media_size(
      libewf_handle_t *handle,
-     uint16_t *compression_method,
+     size64_t *media_size,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_compression_method";
+	static char *function                     = "libewf_handle_get_media_size";
 
 	if( handle == NULL )
 	{
@@ -10119,24 +30314,24 @@ int libewf_handle_get_compression_method(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->io_handle == NULL )
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 "%s: invalid handle - missing media values.",
 		 function );
 
 		return( -1 );
 	}
-	if( compression_method == NULL )
+	if( media_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid compression method.",
+		 "%s: invalid media size.",
 		 function );
 
 		return( -1 );
@@ -10156,7 +30351,7 @@ int libewf_handle_get_compression_method(
 		return( -1 );
 	}
 #endif
-	*compression_method = internal_handle->io_handle->compression_method;
+	*media_size = internal_handle->media_values->media_size;
 
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
@@ -10176,49 +30371,37 @@ int libewf_handle_get_compression_method(
 	return( 1 );
 }
 
-/* Sets the compression method
+/* Sets the media size
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_compression_method(
+int libewf_handle_set_media_size(
      libewf_handle_t *handle,
-     uint16_t compression_method,
+     size64_t media_size,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_compression_method";
+	static char *function                     = "libewf_handle_set_media_size";
 
 	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
-		 function );
-
-		return( -1 );
-	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->io_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( compression_method != LIBEWF_COMPRESSION_METHOD_DEFLATE )
-	 && ( compression_method != LIBEWF_COMPRESSION_METHOD_BZIP2 ) )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported compression method.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
 		 function );
 
 		return( -1 );
@@ -10238,33 +30421,35 @@ int libewf_handle_set_compression_method(
 		return( -1 );
 	}
 #endif
-	if( ( internal_handle->write_io_handle == NULL )
+	if( ( internal_handle->read_io_handle != NULL )
+	 || ( internal_handle->write_io_handle == NULL )
 	 || ( internal_handle->write_io_handle->values_initialized != 0 ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: compression values cannot be changed.",
+		 "%s: media size cannot be changed.",
 		 function );
 
 		goto on_error;
 	}
-	if( ( compression_method == LIBEWF_COMPRESSION_METHOD_BZIP2 )
-	 && ( internal_handle->io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_EWF2 )
-	 && ( internal_handle->io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_EWF2_LOGICAL ) )
+	if( libewf_internal_handle_set_media_values(
+	     internal_handle,
+	     internal_handle->media_values->sectors_per_chunk,
+	     internal_handle->media_values->bytes_per_sector,
+	     media_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-		 "%s: compression method not supported by format.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set media values.",
 		 function );
 
 		goto on_error;
 	}
-	internal_handle->io_handle->compression_method = compression_method;
-
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
@@ -10291,17 +30476,16 @@ on_error:
 	return( -1 );
 }
 
-/* Retrieves the compression values
+/* Retrieves the media type value
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_compression_values(
+int libewf_handle_get_media_type(
      libewf_handle_t *handle,
-     int8_t *compression_level,
-     uint8_t *compression_flags,
+     uint8_t *media_type,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_compression_values";
+	static char *function                     = "libewf_handle_get_media_type";
 
 	if( handle == NULL )
 	{
@@ -10316,35 +30500,35 @@ int libewf_handle_get_compression_values(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->io_handle == NULL )
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 "%s: invalid handle - missing media values.",
 		 function );
 
 		return( -1 );
 	}
-	if( compression_level == NULL )
+	if( internal_handle->media_values->media_type > (uint8_t) INT8_MAX )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid compression level.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid media type value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	if( compression_flags == NULL )
+	if( media_type == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid compression flags.",
+		 "%s: invalid media type.",
 		 function );
 
 		return( -1 );
@@ -10364,8 +30548,7 @@ int libewf_handle_get_compression_values(
 		return( -1 );
 	}
 #endif
-	*compression_level = internal_handle->io_handle->compression_level;
-	*compression_flags = internal_handle->io_handle->compression_flags;
+	*media_type = internal_handle->media_values->media_type;
 
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
@@ -10385,17 +30568,16 @@ int libewf_handle_get_compression_values(
 	return( 1 );
 }
 
-/* Sets the compression values
+/* Sets the media type
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_compression_values(
+int libewf_handle_set_media_type(
      libewf_handle_t *handle,
-     int8_t compression_level,
-     uint8_t compression_flags,
+     uint8_t media_type,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_compression_values";
+	static char *function                     = "libewf_handle_set_media_type";
 
 	if( handle == NULL )
 	{
@@ -10410,37 +30592,13 @@ int libewf_handle_set_compression_values(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->io_handle == NULL )
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
-		 function );
-
-		return( -1 );
-	}
-	if( ( compression_level != LIBEWF_COMPRESSION_NONE )
-	 && ( compression_level != LIBEWF_COMPRESSION_FAST )
-	 && ( compression_level != LIBEWF_COMPRESSION_BEST ) )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported compression level.",
-		 function );
-
-		return( -1 );
-	}
-	if( ( compression_flags & ~( LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION ) ) != 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported compression flags.",
+		 "%s: invalid handle - missing media values.",
 		 function );
 
 		return( -1 );
@@ -10460,25 +30618,20 @@ int libewf_handle_set_compression_values(
 		return( -1 );
 	}
 #endif
-	if( ( internal_handle->write_io_handle == NULL )
+	if( ( internal_handle->read_io_handle != NULL )
+	 || ( internal_handle->write_io_handle == NULL )
 	 || ( internal_handle->write_io_handle->values_initialized != 0 ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: compression values cannot be changed.",
+		 "%s: media type cannot be changed.",
 		 function );
 
 		goto on_error;
 	}
-	if( ( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF2 )
-	 && ( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF2_LOGICAL ) )
-	{
-		compression_flags |= LIBEWF_COMPRESS_FLAG_USE_PATTERN_FILL_COMPRESSION;
-	}
-	internal_handle->io_handle->compression_level = compression_level;
-	internal_handle->io_handle->compression_flags = compression_flags;
+	internal_handle->media_values->media_type = media_type;
 
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -10506,16 +30659,16 @@ on_error:
 	return( -1 );
 }
 
-/* Retrieves the size of the contained media data
+/* Retrieves the media flags
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_media_size(
+int libewf_handle_get_media_flags(
      libewf_handle_t *handle,
-     size64_t *media_size,
+     uint8_t *media_flags,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_media_size";
+	static char *function                     = "libewf_handle_get_media_flags";
 
 	if( handle == NULL )
 	{
@@ -10541,13 +30694,13 @@ int libewf_handle_get_media_size(
 
 		return( -1 );
 	}
-	if( media_size == NULL )
+	if( media_flags == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid media size.",
+		 "%s: invalid media flags.",
 		 function );
 
 		return( -1 );
@@ -10567,7 +30720,18 @@ int libewf_handle_get_media_size(
 		return( -1 );
 	}
 #endif
-	*media_size = internal_handle->media_values->media_size;
+	if( internal_handle->media_values->media_flags > (uint8_t) INT8_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid media flags value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	*media_flags = internal_handle->media_values->media_flags;
 
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
@@ -10585,18 +30749,26 @@ int libewf_handle_get_media_size(
 	}
 #endif
 	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
 }
 
-/* Sets the media size
+/* Sets the media flags
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_media_size(
+int libewf_handle_set_media_flags(
      libewf_handle_t *handle,
-     size64_t media_size,
+     uint8_t media_flags,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_media_size";
+	static char *function                     = "libewf_handle_set_media_flags";
 
 	if( handle == NULL )
 	{
@@ -10645,27 +30817,17 @@ int libewf_handle_set_media_size(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: media size cannot be changed.",
+		 "%s: media flags cannot be changed.",
 		 function );
 
 		goto on_error;
 	}
-	if( libewf_internal_handle_set_media_values(
-	     internal_handle,
-	     internal_handle->media_values->sectors_per_chunk,
-	     internal_handle->media_values->bytes_per_sector,
-	     media_size,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set media values.",
-		 function );
+	internal_handle->media_values->media_flags = media_flags;
+
+	/* Make sure the lowest bit is always set
+	 */
+	internal_handle->media_values->media_flags |= 0x01;
 
-		goto on_error;
-	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
@@ -10692,16 +30854,16 @@ on_error:
 	return( -1 );
 }
 
-/* Retrieves the media type value
+/* Retrieves the format type value
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_media_type(
+int libewf_handle_get_format(
      libewf_handle_t *handle,
-     uint8_t *media_type,
+     uint8_t *format,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_media_type";
+	static char *function                     = "libewf_handle_get_format";
 
 	if( handle == NULL )
 	{
@@ -10716,35 +30878,35 @@ int libewf_handle_get_media_type(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->media_values == NULL )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values->media_type > (uint8_t) INT8_MAX )
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid media type value exceeds maximum.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
 		 function );
 
 		return( -1 );
 	}
-	if( media_type == NULL )
+	if( format == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid media type.",
+		 "%s: invalid format.",
 		 function );
 
 		return( -1 );
@@ -10764,7 +30926,18 @@ int libewf_handle_get_media_type(
 		return( -1 );
 	}
 #endif
-	*media_type = internal_handle->media_values->media_type;
+	if( internal_handle->io_handle->format > (uint8_t) INT8_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid format value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	*format = internal_handle->io_handle->format;
 
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
@@ -10782,40 +30955,81 @@ int libewf_handle_get_media_type(
 	}
 #endif
 	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
 }
 
-/* Sets the media type
+/* Sets the output format
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_media_type(
+int libewf_handle_set_format(
      libewf_handle_t *handle,
-     uint8_t media_type,
+     uint8_t format,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_media_type";
+	static char *function                     = "libewf_handle_set_format";
+	uint8_t is_logical                        = 0;
 
 	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
-		 function );
-
-		return( -1 );
-	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->media_values == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
-		 function );
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( format != LIBEWF_FORMAT_ENCASE1 )
+	 && ( format != LIBEWF_FORMAT_ENCASE2 )
+	 && ( format != LIBEWF_FORMAT_ENCASE3 )
+	 && ( format != LIBEWF_FORMAT_ENCASE4 )
+	 && ( format != LIBEWF_FORMAT_ENCASE5 )
+	 && ( format != LIBEWF_FORMAT_ENCASE6 )
+	 && ( format != LIBEWF_FORMAT_ENCASE7 )
+	 && ( format != LIBEWF_FORMAT_SMART )
+	 && ( format != LIBEWF_FORMAT_FTK_IMAGER )
+	 && ( format != LIBEWF_FORMAT_LINEN5 )
+	 && ( format != LIBEWF_FORMAT_LINEN6 )
+	 && ( format != LIBEWF_FORMAT_LINEN7 )
+	 && ( format != LIBEWF_FORMAT_V2_ENCASE7 )
+	 && ( format != LIBEWF_FORMAT_LOGICAL_ENCASE5 )
+	 && ( format != LIBEWF_FORMAT_LOGICAL_ENCASE6 )
+/* TODO add support for: Lx01:
+	 && ( format != LIBEWF_FORMAT_LOGICAL_ENCASE7 )
+	 && ( format != LIBEWF_FORMAT_V2_LOGICAL_ENCASE7 )
+*/
+	 && ( format != LIBEWF_FORMAT_EWF )
+	 && ( format != LIBEWF_FORMAT_EWFX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported format: %d.",
+		 function,
+	         format );
 
 		return( -1 );
 	}
@@ -10842,13 +31056,94 @@ int libewf_handle_set_media_type(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: media type cannot be changed.",
+		 "%s: format cannot be changed.",
 		 function );
 
 		goto on_error;
 	}
-	internal_handle->media_values->media_type = media_type;
+	/* The EWF1 logical formats use the same sections as their physical counterpart
+	 * but are stored in segment files with the logical signature, the file entries
+	 * are stored in the ltree section of the last segment file
+	 */
+	if( format == LIBEWF_FORMAT_LOGICAL_ENCASE5 )
+	{
+		format     = LIBEWF_FORMAT_ENCASE5;
+		is_logical = 1;
+	}
+	else if( format == LIBEWF_FORMAT_LOGICAL_ENCASE6 )
+	{
+		format     = LIBEWF_FORMAT_ENCASE6;
+		is_logical = 1;
+	}
+/* TODO refactor into separate function */
+	internal_handle->io_handle->format = format;
 
+	if( format == LIBEWF_FORMAT_V2_ENCASE7 )
+	{
+		internal_handle->io_handle->major_version = 2;
+		internal_handle->io_handle->minor_version = 1;
+	}
+	else
+	{
+		internal_handle->io_handle->major_version = 1;
+		internal_handle->io_handle->minor_version = 0;
+	}
+	if( ( format == LIBEWF_FORMAT_EWF )
+	 || ( format == LIBEWF_FORMAT_SMART ) )
+	{
+		/* Wraps .s01 to .s99 and then to .saa up to .zzz
+		 * ( ( ( 's' to 'z' = 8 ) * 26 * 26 ) + 99 ) = 5507
+		 */
+		internal_handle->write_io_handle->maximum_number_of_segments = (uint32_t) 5507;
+		internal_handle->io_handle->segment_file_type                = LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART;
+	}
+	else if( format == LIBEWF_FORMAT_V2_ENCASE7 )
+	{
+		/* Wraps .Ex01 to .Ex99 and then to .ExAA up to .EzZZ
+		 * ( ( ( 'x' to 'z' = 3 ) * 26 * 26 ) + 99 ) = 2127
+		 */
+		internal_handle->write_io_handle->maximum_number_of_segments = (uint32_t) 2127;
+		internal_handle->io_handle->segment_file_type                = LIBEWF_SEGMENT_FILE_TYPE_EWF2;
+	}
+	else if( is_logical != 0 )
+	{
+		/* Wraps .L01 to .L99 and then to .LAA up to .ZZZ
+		 * ( ( ( 'L' to 'Z' = 15 ) * 26 * 26 ) + 99 ) = 10239
+		 */
+		internal_handle->write_io_handle->maximum_number_of_segments = (uint32_t) 10239;
+		internal_handle->io_handle->segment_file_type                = LIBEWF_SEGMENT_FILE_TYPE_EWF1_LOGICAL;
+	}
+	else
+	{
+		/* Wraps .E01 to .E99 and then to .EAA up to .ZZZ
+		 * ( ( ( 'E' to 'Z' or 'e' to 'z' = 22 ) * 26 * 26 ) + 99 ) = 14971
+		 */
+		internal_handle->write_io_handle->maximum_number_of_segments = (uint32_t) 14971;
+		internal_handle->io_handle->segment_file_type                = LIBEWF_SEGMENT_FILE_TYPE_EWF1;
+	}
+	/* Determine the maximum number of table entries
+	 */
+	if( ( format == LIBEWF_FORMAT_ENCASE6 )
+	 || ( format == LIBEWF_FORMAT_ENCASE7 ) )
+	{
+		internal_handle->write_io_handle->maximum_segment_file_size  = INT64_MAX;
+		internal_handle->write_io_handle->maximum_chunks_per_section = LIBEWF_MAXIMUM_TABLE_ENTRIES_ENCASE6;
+	}
+	else if( format == LIBEWF_FORMAT_V2_ENCASE7 )
+	{
+		internal_handle->write_io_handle->maximum_segment_file_size  = INT64_MAX;
+		internal_handle->write_io_handle->maximum_chunks_per_section = LIBEWF_MAXIMUM_TABLE_ENTRIES;
+	}
+	else if( format == LIBEWF_FORMAT_EWFX )
+	{
+		internal_handle->write_io_handle->maximum_segment_file_size  = INT32_MAX;
+		internal_handle->write_io_handle->maximum_chunks_per_section = LIBEWF_MAXIMUM_TABLE_ENTRIES;
+	}
+	else
+	{
+		internal_handle->write_io_handle->maximum_segment_file_size  = INT32_MAX;
+		internal_handle->write_io_handle->maximum_chunks_per_section = LIBEWF_MAXIMUM_TABLE_ENTRIES_EWF;
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
@@ -10875,16 +31170,17 @@ on_error:
 	return( -1 );
 }
 
-/* Retrieves the media flags
+/* Retrieves the segment file version
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_media_flags(
+int libewf_handle_get_segment_file_version(
      libewf_handle_t *handle,
-     uint8_t *media_flags,
+     uint8_t *major_version,
+     uint8_t *minor_version,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_media_flags";
+	static char *function                     = "libewf_handle_get_segment_file_version";
 
 	if( handle == NULL )
 	{
@@ -10899,24 +31195,35 @@ int libewf_handle_get_media_flags(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->media_values == NULL )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( media_flags == NULL )
+	if( major_version == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid media flags.",
+		 "%s: invalid major version.",
+		 function );
+
+		return( -1 );
+	}
+	if( minor_version == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid minor version.",
 		 function );
 
 		return( -1 );
@@ -10936,18 +31243,8 @@ int libewf_handle_get_media_flags(
 		return( -1 );
 	}
 #endif
-	if( internal_handle->media_values->media_flags > (uint8_t) INT8_MAX )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid media flags value exceeds maximum.",
-		 function );
-
-		goto on_error;
-	}
-	*media_flags = internal_handle->media_values->media_flags;
+	*major_version = internal_handle->io_handle->major_version;
+	*minor_version = internal_handle->io_handle->minor_version;
 
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
@@ -10965,26 +31262,20 @@ int libewf_handle_get_media_flags(
 	}
 #endif
 	return( 1 );
-
-on_error:
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_read(
-	 internal_handle->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
 }
 
-/* Sets the media flags
+/* Retrieves the segment file set identifier
+ * The identifier is a GUID and is 16 bytes of size
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_media_flags(
+int libewf_handle_get_segment_file_set_identifier(
      libewf_handle_t *handle,
-     uint8_t media_flags,
+     uint8_t *set_identifier,
+     size_t size,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_media_flags";
+	static char *function                     = "libewf_handle_get_segment_file_set_identifier";
 
 	if( handle == NULL )
 	{
@@ -11010,8 +31301,30 @@ int libewf_handle_set_media_flags(
 
 		return( -1 );
 	}
+	if( set_identifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid set identifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( size < 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: set identifier too small.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -11019,33 +31332,28 @@ int libewf_handle_set_media_flags(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( ( internal_handle->read_io_handle != NULL )
-	 || ( internal_handle->write_io_handle == NULL )
-	 || ( internal_handle->write_io_handle->values_initialized != 0 ) )
+	if( memory_copy(
+	     set_identifier,
+	     internal_handle->media_values->set_identifier,
+	     16 ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: media flags cannot be changed.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to set set identifier.",
 		 function );
 
 		goto on_error;
 	}
-	internal_handle->media_values->media_flags = media_flags;
-
-	/* Make sure the lowest bit is always set
-	 */
-	internal_handle->media_values->media_flags |= 0x01;
-
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -11053,7 +31361,7 @@ int libewf_handle_set_media_flags(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
@@ -11063,23 +31371,25 @@ int libewf_handle_set_media_flags(
 
 on_error:
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
+	libcthreads_read_write_lock_release_for_read(
 	 internal_handle->read_write_lock,
 	 NULL );
 #endif
 	return( -1 );
 }
 
-/* Retrieves the format type value
+/* Sets the segment file set identifier
+ * The identifier is a GUID and is 16 bytes of size
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_format(
+int libewf_handle_set_segment_file_set_identifier(
      libewf_handle_t *handle,
-     uint8_t *format,
+     const uint8_t *set_identifier,
+     size_t size,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_format";
+	static char *function                     = "libewf_handle_set_segment_file_set_identifier";
 
 	if( handle == NULL )
 	{
@@ -11094,41 +31404,41 @@ int libewf_handle_get_format(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->io_handle == NULL )
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 "%s: invalid handle - missing media values.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values == NULL )
+	if( set_identifier == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid set identifier.",
 		 function );
 
 		return( -1 );
 	}
-	if( format == NULL )
+	if( size < 16 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid format.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: set identifier too small.",
 		 function );
 
 		return( -1 );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -11136,27 +31446,41 @@ int libewf_handle_get_format(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( internal_handle->read_io_handle != NULL )
+	 || ( internal_handle->write_io_handle == NULL )
+	 || ( internal_handle->write_io_handle->values_initialized != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: set identifier cannot be changed.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	if( internal_handle->io_handle->format > (uint8_t) INT8_MAX )
+	if( memory_copy(
+	     internal_handle->media_values->set_identifier,
+	     set_identifier,
+	     16 ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid format value exceeds maximum.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy set indentifier.",
 		 function );
 
 		goto on_error;
 	}
-	*format = internal_handle->io_handle->format;
-
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -11164,7 +31488,7 @@ int libewf_handle_get_format(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
@@ -11174,23 +31498,25 @@ int libewf_handle_get_format(
 
 on_error:
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_read(
+	libcthreads_read_write_lock_release_for_write(
 	 internal_handle->read_write_lock,
 	 NULL );
 #endif
 	return( -1 );
 }
 
-/* Sets the output format
- * Returns 1 if successful or -1 on error
+/* Retrieves the MD5 hash
+ * Returns 1 if successful, 0 if value not present or -1 on error
  */
-int libewf_handle_set_format(
+int libewf_handle_get_md5_hash(
      libewf_handle_t *handle,
-     uint8_t format,
+     uint8_t *md5_hash,
+     size_t size,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_format";
+	static char *function                     = "libewf_handle_get_md5_hash";
+	int result                                = 0;
 
 	if( handle == NULL )
 	{
@@ -11205,46 +31531,36 @@ int libewf_handle_set_format(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->io_handle == NULL )
+	if( internal_handle->hash_sections == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 "%s: invalid handle - missing hash sections.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( format != LIBEWF_FORMAT_ENCASE1 )
-	 && ( format != LIBEWF_FORMAT_ENCASE2 )
-	 && ( format != LIBEWF_FORMAT_ENCASE3 )
-	 && ( format != LIBEWF_FORMAT_ENCASE4 )
-	 && ( format != LIBEWF_FORMAT_ENCASE5 )
-	 && ( format != LIBEWF_FORMAT_ENCASE6 )
-	 && ( format != LIBEWF_FORMAT_ENCASE7 )
-	 && ( format != LIBEWF_FORMAT_SMART )
-	 && ( format != LIBEWF_FORMAT_FTK_IMAGER )
-	 && ( format != LIBEWF_FORMAT_LINEN5 )
-	 && ( format != LIBEWF_FORMAT_LINEN6 )
-	 && ( format != LIBEWF_FORMAT_LINEN7 )
-	 && ( format != LIBEWF_FORMAT_V2_ENCASE7 )
-/* TODO add support for: L01, Lx01:
-	 && ( format != LIBEWF_FORMAT_LOGICAL_ENCASE5 )
-	 && ( format != LIBEWF_FORMAT_LOGICAL_ENCASE6 )
-	 && ( format != LIBEWF_FORMAT_LOGICAL_ENCASE7 )
-	 && ( format != LIBEWF_FORMAT_V2_LOGICAL_ENCASE7 )
-*/
-	 && ( format != LIBEWF_FORMAT_EWF )
-	 && ( format != LIBEWF_FORMAT_EWFX ) )
+	if( md5_hash == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported format: %d.",
-		 function,
-	         format );
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MD5 hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( size < 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: MD5 hash too small.",
+		 function );
 
 		return( -1 );
 	}
@@ -11263,79 +31579,61 @@ int libewf_handle_set_format(
 		return( -1 );
 	}
 #endif
-	if( ( internal_handle->read_io_handle != NULL )
-	 || ( internal_handle->write_io_handle == NULL )
-	 || ( internal_handle->write_io_handle->values_initialized != 0 ) )
+	if( ( internal_handle->hash_sections->md5_hash_set == 0 )
+	 && ( internal_handle->hash_values != NULL ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: format cannot be changed.",
-		 function );
-
-		goto on_error;
-	}
-/* TODO refactor into separate function */
-	internal_handle->io_handle->format = format;
+		if( libewf_hash_values_generate_md5_hash(
+		     internal_handle->hash_values,
+		     internal_handle->hash_sections->md5_hash,
+		     16,
+		     &( internal_handle->hash_sections->md5_hash_set ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to parse MD5 hash value for its value.",
+			 function );
 
-	if( format == LIBEWF_FORMAT_V2_ENCASE7 )
-	{
-		internal_handle->io_handle->major_version = 2;
-		internal_handle->io_handle->minor_version = 1;
-	}
-	else
-	{
-		internal_handle->io_handle->major_version = 1;
-		internal_handle->io_handle->minor_version = 0;
-	}
-	if( ( format == LIBEWF_FORMAT_EWF )
-	 || ( format == LIBEWF_FORMAT_SMART ) )
-	{
-		/* Wraps .s01 to .s99 and then to .saa up to .zzz
-		 * ( ( ( 's' to 'z' = 8 ) * 26 * 26 ) + 99 ) = 5507
-		 */
-		internal_handle->write_io_handle->maximum_number_of_segments = (uint32_t) 5507;
-		internal_handle->io_handle->segment_file_type                = LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART;
-	}
-	else if( format == LIBEWF_FORMAT_V2_ENCASE7 )
-	{
-		/* Wraps .Ex01 to .Ex99 and then to .ExAA up to .EzZZ
-		 * ( ( ( 'x' to 'z' = 3 ) * 26 * 26 ) + 99 ) = 2127
-		 */
-		internal_handle->write_io_handle->maximum_number_of_segments = (uint32_t) 2127;
-		internal_handle->io_handle->segment_file_type                = LIBEWF_SEGMENT_FILE_TYPE_EWF2;
-	}
-	else
-	{
-		/* Wraps .E01 to .E99 and then to .EAA up to .ZZZ
-		 * ( ( ( 'E' to 'Z' or 'e' to 'z' = 22 ) * 26 * 26 ) + 99 ) = 14971
-		 */
-		internal_handle->write_io_handle->maximum_number_of_segments = (uint32_t) 14971;
-		internal_handle->io_handle->segment_file_type                = LIBEWF_SEGMENT_FILE_TYPE_EWF1;
-	}
-	/* Determine the maximum number of table entries
-	 */
-	if( ( format == LIBEWF_FORMAT_ENCASE6 )
-	 || ( format == LIBEWF_FORMAT_ENCASE7 ) )
-	{
-		internal_handle->write_io_handle->maximum_segment_file_size  = INT64_MAX;
-		internal_handle->write_io_handle->maximum_chunks_per_section = LIBEWF_MAXIMUM_TABLE_ENTRIES_ENCASE6;
-	}
-	else if( format == LIBEWF_FORMAT_V2_ENCASE7 )
-	{
-		internal_handle->write_io_handle->maximum_segment_file_size  = INT64_MAX;
-		internal_handle->write_io_handle->maximum_chunks_per_section = LIBEWF_MAXIMUM_TABLE_ENTRIES;
+			goto on_error;
+		}
 	}
-	else if( format == LIBEWF_FORMAT_EWFX )
+	if( internal_handle->hash_sections->md5_digest_set != 0 )
 	{
-		internal_handle->write_io_handle->maximum_segment_file_size  = INT32_MAX;
-		internal_handle->write_io_handle->maximum_chunks_per_section = LIBEWF_MAXIMUM_TABLE_ENTRIES;
+		if( memory_copy(
+		     md5_hash,
+		     internal_handle->hash_sections->md5_digest,
+		     16 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy MD5 digest.",
+			 function );
+
+			goto on_error;
+		}
+		result = 1;
 	}
-	else
+	else if( internal_handle->hash_sections->md5_hash_set != 0 )
 	{
-		internal_handle->write_io_handle->maximum_segment_file_size  = INT32_MAX;
-		internal_handle->write_io_handle->maximum_chunks_per_section = LIBEWF_MAXIMUM_TABLE_ENTRIES_EWF;
+		if( memory_copy(
+		     md5_hash,
+		     internal_handle->hash_sections->md5_hash,
+		     16 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy MD5 hash.",
+			 function );
+
+			goto on_error;
+		}
+		result = 1;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -11352,7 +31650,7 @@ int libewf_handle_set_format(
 		return( -1 );
 	}
 #endif
-	return( 1 );
+	return( result );
 
 on_error:
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
@@ -11363,84 +31661,158 @@ on_error:
 	return( -1 );
 }
 
-/* Retrieves the segment file version
+/* Sets the MD5 hash
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_segment_file_version(
+int libewf_handle_set_md5_hash(
      libewf_handle_t *handle,
-     uint8_t *major_version,
-     uint8_t *minor_version,
+     const uint8_t *md5_hash,
+     size_t size,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_segment_file_version";
+	static char *function                     = "libewf_handle_set_md5_hash";
 
 	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->hash_sections == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing hash sections.",
+		 function );
+
+		return( -1 );
+	}
+	if( md5_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MD5 hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( size < 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: MD5 hash too small.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->io_handle == NULL )
+#endif
+	if( ( internal_handle->read_io_handle != NULL )
+	 || ( internal_handle->hash_sections->md5_hash_set != 0 )
+	 || ( internal_handle->hash_sections->md5_digest_set != 0 ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: MD5 hash cannot be changed.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( major_version == NULL )
+	if( internal_handle->hash_values == NULL )
+	{
+		if( libewf_hash_values_initialize(
+		     &( internal_handle->hash_values ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create hash values.",
+			 function );
+
+			goto on_error;
+		}
+		internal_handle->hash_values_parsed = 1;
+	}
+	if( memory_copy(
+	     internal_handle->hash_sections->md5_hash,
+	     md5_hash,
+	     16 ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid major version.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to set MD5 hash.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( minor_version == NULL )
+	internal_handle->hash_sections->md5_hash_set = 1;
+
+	if( memory_copy(
+	     internal_handle->hash_sections->md5_digest,
+	     md5_hash,
+	     16 ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid minor version.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to set MD5 hash.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_handle->read_write_lock,
+	internal_handle->hash_sections->md5_digest_set = 1;
+
+	if( libewf_hash_values_parse_md5_hash(
+	     internal_handle->hash_values,
+	     md5_hash,
+	     16,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to parse MD5 hash for its value.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	*major_version = internal_handle->io_handle->major_version;
-	*minor_version = internal_handle->io_handle->minor_version;
-
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -11448,27 +31820,35 @@ int libewf_handle_get_segment_file_version(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
 	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
 }
 
-/* Retrieves the segment file set identifier
- * The identifier is a GUID and is 16 bytes of size
- * Returns 1 if successful or -1 on error
+/* Retrieves the SHA1 hash
+ * Returns 1 if successful, 0 if value not present or -1 on error
  */
-int libewf_handle_get_segment_file_set_identifier(
+int libewf_handle_get_sha1_hash(
      libewf_handle_t *handle,
-     uint8_t *set_identifier,
+     uint8_t *sha1_hash,
      size_t size,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_segment_file_set_identifier";
+	static char *function                     = "libewf_handle_get_sha1_hash";
+	int result                                = 0;
 
 	if( handle == NULL )
 	{
@@ -11483,41 +31863,41 @@ int libewf_handle_get_segment_file_set_identifier(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->media_values == NULL )
+	if( internal_handle->hash_sections == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 "%s: invalid handle - missing hash sections.",
 		 function );
 
 		return( -1 );
 	}
-	if( set_identifier == NULL )
+	if( sha1_hash == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid set identifier.",
+		 "%s: invalid SHA1 hash.",
 		 function );
 
 		return( -1 );
 	}
-	if( size < 16 )
+	if( size < 20 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
-		 "%s: set identifier too small.",
+		 "%s: SHA1 hash too small.",
 		 function );
 
 		return( -1 );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -11525,28 +31905,70 @@ int libewf_handle_get_segment_file_set_identifier(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( memory_copy(
-	     set_identifier,
-	     internal_handle->media_values->set_identifier,
-	     16 ) == NULL )
+	if( ( internal_handle->hash_sections->sha1_digest_set == 0 )
+	 && ( internal_handle->hash_values != NULL ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to set set identifier.",
-		 function );
+		if( libewf_hash_values_generate_sha1_hash(
+		     internal_handle->hash_values,
+		     internal_handle->hash_sections->sha1_digest,
+		     20,
+		     &( internal_handle->hash_sections->sha1_digest_set ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to parse MD5 hash value for its value.",
+			 function );
 
-		goto on_error;
+			goto on_error;
+		}
+	}
+	if( internal_handle->hash_sections->sha1_digest_set != 0 )
+	{
+		if( memory_copy(
+		     sha1_hash,
+		     internal_handle->hash_sections->sha1_digest,
+		     20 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy SHA1 digest.",
+			 function );
+
+			goto on_error;
+		}
+		result = 1;
+	}
+	else if( internal_handle->hash_sections->sha1_hash_set != 0 )
+	{
+		if( memory_copy(
+		     sha1_hash,
+		     internal_handle->hash_sections->sha1_hash,
+		     20 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy SHA1 hash.",
+			 function );
+
+			goto on_error;
+		}
+		result = 1;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -11554,35 +31976,34 @@ int libewf_handle_get_segment_file_set_identifier(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( 1 );
+	return( result );
 
 on_error:
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_read(
+	libcthreads_read_write_lock_release_for_write(
 	 internal_handle->read_write_lock,
 	 NULL );
 #endif
 	return( -1 );
 }
 
-/* Sets the segment file set identifier
- * The identifier is a GUID and is 16 bytes of size
+/* Sets the SHA1 hash
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_segment_file_set_identifier(
+int libewf_handle_set_sha1_hash(
      libewf_handle_t *handle,
-     const uint8_t *set_identifier,
+     const uint8_t *sha1_hash,
      size_t size,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_segment_file_set_identifier";
+	static char *function                     = "libewf_handle_set_sha1_hash";
 
 	if( handle == NULL )
 	{
@@ -11597,35 +32018,35 @@ int libewf_handle_set_segment_file_set_identifier(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->media_values == NULL )
+	if( internal_handle->hash_sections == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 "%s: invalid handle - missing hash sections.",
 		 function );
 
 		return( -1 );
 	}
-	if( set_identifier == NULL )
+	if( sha1_hash == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid set identifier.",
+		 "%s: invalid SHA1 hash.",
 		 function );
 
 		return( -1 );
 	}
-	if( size < 16 )
+	if( size < 20 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
-		 "%s: set identifier too small.",
+		 "%s: SHA1 hash too small.",
 		 function );
 
 		return( -1 );
@@ -11637,37 +32058,87 @@ int libewf_handle_set_segment_file_set_identifier(
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( internal_handle->read_io_handle != NULL )
+	 || ( internal_handle->hash_sections->sha1_hash_set != 0 )
+	 || ( internal_handle->hash_sections->sha1_digest_set != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: SHA1 hash cannot be changed.",
+		 function );
+
+		goto on_error;
+	}
+	if( internal_handle->hash_values == NULL )
+	{
+		if( libewf_hash_values_initialize(
+		     &( internal_handle->hash_values ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create hash values.",
+			 function );
+
+			goto on_error;
+		}
+		internal_handle->hash_values_parsed = 1;
+	}
+	if( memory_copy(
+	     internal_handle->hash_sections->sha1_hash,
+	     sha1_hash,
+	     20 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to set SHA1 hash.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	if( ( internal_handle->read_io_handle != NULL )
-	 || ( internal_handle->write_io_handle == NULL )
-	 || ( internal_handle->write_io_handle->values_initialized != 0 ) )
+	internal_handle->hash_sections->sha1_hash_set = 1;
+
+	if( memory_copy(
+	     internal_handle->hash_sections->sha1_digest,
+	     sha1_hash,
+	     20 ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: set identifier cannot be changed.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to set SHA1 hash.",
 		 function );
 
 		goto on_error;
 	}
-	if( memory_copy(
-	     internal_handle->media_values->set_identifier,
-	     set_identifier,
-	     16 ) == NULL )
+	internal_handle->hash_sections->sha1_digest_set = 1;
+
+	if( libewf_hash_values_parse_sha1_hash(
+	     internal_handle->hash_values,
+	     sha1_hash,
+	     20,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to copy set indentifier.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to parse SHA1 hash for its value.",
 		 function );
 
 		goto on_error;
@@ -11698,18 +32169,17 @@ on_error:
 	return( -1 );
 }
 
-/* Retrieves the MD5 hash
- * Returns 1 if successful, 0 if value not present or -1 on error
+/* Sets the read zero chunk on error
+ * The chunk is not zeroed if read raw is used
+ * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_md5_hash(
+int libewf_handle_set_read_zero_chunk_on_error(
      libewf_handle_t *handle,
-     uint8_t *md5_hash,
-     size_t size,
+     uint8_t zero_on_error,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_md5_hash";
-	int result                                = 0;
+	static char *function                     = "libewf_handle_set_read_zero_chunk_on_error";
 
 	if( handle == NULL )
 	{
@@ -11724,35 +32194,13 @@ int libewf_handle_get_md5_hash(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->hash_sections == NULL )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing hash sections.",
-		 function );
-
-		return( -1 );
-	}
-	if( md5_hash == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid MD5 hash.",
-		 function );
-
-		return( -1 );
-	}
-	if( size < 16 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
-		 "%s: MD5 hash too small.",
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
 		return( -1 );
@@ -11772,62 +32220,8 @@ int libewf_handle_get_md5_hash(
 		return( -1 );
 	}
 #endif
-	if( ( internal_handle->hash_sections->md5_hash_set == 0 )
-	 && ( internal_handle->hash_values != NULL ) )
-	{
-		if( libewf_hash_values_generate_md5_hash(
-		     internal_handle->hash_values,
-		     internal_handle->hash_sections->md5_hash,
-		     16,
-		     &( internal_handle->hash_sections->md5_hash_set ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to parse MD5 hash value for its value.",
-			 function );
-
-			goto on_error;
-		}
-	}
-	if( internal_handle->hash_sections->md5_digest_set != 0 )
-	{
-		if( memory_copy(
-		     md5_hash,
-		     internal_handle->hash_sections->md5_digest,
-		     16 ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy MD5 digest.",
-			 function );
-
-			goto on_error;
-		}
-		result = 1;
-	}
-	else if( internal_handle->hash_sections->md5_hash_set != 0 )
-	{
-		if( memory_copy(
-		     md5_hash,
-		     internal_handle->hash_sections->md5_hash,
-		     16 ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy MD5 hash.",
-			 function );
+	internal_handle->io_handle->zero_on_error = zero_on_error;
 
-			goto on_error;
-		}
-		result = 1;
-	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
@@ -11843,28 +32237,19 @@ int libewf_handle_get_md5_hash(
 		return( -1 );
 	}
 #endif
-	return( result );
-
-on_error:
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_handle->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
+	return( 1 );
 }
 
-/* Sets the MD5 hash
+/* Retrieves the read verify checksums value
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_md5_hash(
+int libewf_handle_get_read_verify_checksums(
      libewf_handle_t *handle,
-     const uint8_t *md5_hash,
-     size_t size,
+     uint8_t *verify_checksums,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_md5_hash";
+	static char *function                     = "libewf_handle_get_read_verify_checksums";
 
 	if( handle == NULL )
 	{
@@ -11879,41 +32264,30 @@ int libewf_handle_set_md5_hash(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->hash_sections == NULL )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing hash sections.",
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( md5_hash == NULL )
+	if( verify_checksums == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid MD5 hash.",
-		 function );
-
-		return( -1 );
-	}
-	if( size < 16 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
-		 "%s: MD5 hash too small.",
+		 "%s: invalid verify checksums.",
 		 function );
 
 		return( -1 );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -11921,89 +32295,86 @@ int libewf_handle_set_md5_hash(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( ( internal_handle->read_io_handle != NULL )
-	 || ( internal_handle->hash_sections->md5_hash_set != 0 )
-	 || ( internal_handle->hash_sections->md5_digest_set != 0 ) )
+	*verify_checksums = internal_handle->io_handle->verify_checksums;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: MD5 hash cannot be changed.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( internal_handle->hash_values == NULL )
-	{
-		if( libewf_hash_values_initialize(
-		     &( internal_handle->hash_values ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create hash values.",
-			 function );
+#endif
+	return( 1 );
+}
 
-			goto on_error;
-		}
-		internal_handle->hash_values_parsed = 1;
-	}
-	if( memory_copy(
-	     internal_handle->hash_sections->md5_hash,
-	     md5_hash,
-	     16 ) == NULL )
+/* Sets the read verify checksums value
+ * If set to 0 the checksums of uncompressed chunks are not calculated and
+ * compared on read, this should only be used for images that were verified before
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_read_verify_checksums(
+     libewf_handle_t *handle,
+     uint8_t verify_checksums,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_read_verify_checksums";
+
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to set MD5 hash.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	internal_handle->hash_sections->md5_hash_set = 1;
+	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( memory_copy(
-	     internal_handle->hash_sections->md5_digest,
-	     md5_hash,
-	     16 ) == NULL )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to set MD5 hash.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	internal_handle->hash_sections->md5_digest_set = 1;
-
-	if( libewf_hash_values_parse_md5_hash(
-	     internal_handle->hash_values,
-	     md5_hash,
-	     16,
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to parse MD5 hash for its value.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
+#endif
+	internal_handle->io_handle->verify_checksums = verify_checksums;
+
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
@@ -12020,28 +32391,18 @@ int libewf_handle_set_md5_hash(
 	}
 #endif
 	return( 1 );
-
-on_error:
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_handle->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
 }
 
-/* Retrieves the SHA1 hash
- * Returns 1 if successful, 0 if value not present or -1 on error
+/* Retrieves the read decompress to buffer value
+ * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_sha1_hash(
+int libewf_handle_get_read_decompress_to_buffer(
      libewf_handle_t *handle,
-     uint8_t *sha1_hash,
-     size_t size,
+     uint8_t *decompress_to_buffer,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_sha1_hash";
-	int result                                = 0;
+	static char *function                     = "libewf_handle_get_read_decompress_to_buffer";
 
 	if( handle == NULL )
 	{
@@ -12056,41 +32417,47 @@ int libewf_handle_get_sha1_hash(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->hash_sections == NULL )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing hash sections.",
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( sha1_hash == NULL )
+	if( decompress_to_buffer == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid SHA1 hash.",
+		 "%s: invalid decompress to buffer.",
 		 function );
 
 		return( -1 );
 	}
-	if( size < 20 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
-		 "%s: SHA1 hash too small.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
+#endif
+	*decompress_to_buffer = internal_handle->read_decompress_to_buffer;
+
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -12098,68 +32465,70 @@ int libewf_handle_get_sha1_hash(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( ( internal_handle->hash_sections->sha1_digest_set == 0 )
-	 && ( internal_handle->hash_values != NULL ) )
+	return( 1 );
+}
+
+/* Sets the read decompress to buffer value
+ * If set to a value other than 0 chunks that are fully covered by the buffer of a read
+ * are unpacked directly into that buffer and are not stored in the chunk caches,
+ * this is intended for sequential reads of the media data such as hashing
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_read_decompress_to_buffer(
+     libewf_handle_t *handle,
+     uint8_t decompress_to_buffer,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_read_decompress_to_buffer";
+
+	if( handle == NULL )
 	{
-		if( libewf_hash_values_generate_sha1_hash(
-		     internal_handle->hash_values,
-		     internal_handle->hash_sections->sha1_digest,
-		     20,
-		     &( internal_handle->hash_sections->sha1_digest_set ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to parse MD5 hash value for its value.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-			goto on_error;
-		}
+		return( -1 );
 	}
-	if( internal_handle->hash_sections->sha1_digest_set != 0 )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
 	{
-		if( memory_copy(
-		     sha1_hash,
-		     internal_handle->hash_sections->sha1_digest,
-		     20 ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy SHA1 digest.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
 
-			goto on_error;
-		}
-		result = 1;
+		return( -1 );
 	}
-	else if( internal_handle->hash_sections->sha1_hash_set != 0 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
-		if( memory_copy(
-		     sha1_hash,
-		     internal_handle->hash_sections->sha1_hash,
-		     20 ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy SHA1 hash.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
 
-			goto on_error;
-		}
-		result = 1;
+		return( -1 );
 	}
+#endif
+	internal_handle->read_decompress_to_buffer = decompress_to_buffer;
+
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
@@ -12175,28 +32544,19 @@ int libewf_handle_get_sha1_hash(
 		return( -1 );
 	}
 #endif
-	return( result );
-
-on_error:
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_handle->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
+	return( 1 );
 }
 
-/* Sets the SHA1 hash
+/* Retrieves the use huge pages value
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_sha1_hash(
+int libewf_handle_get_use_huge_pages(
      libewf_handle_t *handle,
-     const uint8_t *sha1_hash,
-     size_t size,
+     uint8_t *use_huge_pages,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_sha1_hash";
+	static char *function                     = "libewf_handle_get_use_huge_pages";
 
 	if( handle == NULL )
 	{
@@ -12211,35 +32571,98 @@ int libewf_handle_set_sha1_hash(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->hash_sections == NULL )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing hash sections.",
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( sha1_hash == NULL )
+	if( use_huge_pages == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid SHA1 hash.",
+		 "%s: invalid use huge pages.",
 		 function );
 
 		return( -1 );
 	}
-	if( size < 20 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*use_huge_pages = internal_handle->io_handle->use_huge_pages;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the use huge pages value
+ * If set to a value other than 0 the chunk data buffers are preallocated once
+ * in a region backed by huge pages, if huge pages are not available normal
+ * pages are used. If the chunk size is known the buffer pool is recreated
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_use_huge_pages(
+     libewf_handle_t *handle,
+     uint8_t use_huge_pages,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_use_huge_pages";
+	int result                                = 1;
+
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
-		 "%s: SHA1 hash too small.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
 		return( -1 );
@@ -12259,85 +32682,112 @@ int libewf_handle_set_sha1_hash(
 		return( -1 );
 	}
 #endif
-	if( ( internal_handle->read_io_handle != NULL )
-	 || ( internal_handle->hash_sections->sha1_hash_set != 0 )
-	 || ( internal_handle->hash_sections->sha1_digest_set != 0 ) )
+	use_huge_pages = (uint8_t) ( use_huge_pages != 0 );
+
+	if( internal_handle->io_handle->use_huge_pages != use_huge_pages )
+	{
+		internal_handle->io_handle->use_huge_pages = use_huge_pages;
+
+		if( internal_handle->io_handle->buffer_pool != NULL )
+		{
+			if( libewf_io_handle_initialize_buffer_pool(
+			     internal_handle->io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create buffer pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: SHA1 hash cannot be changed.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( internal_handle->hash_values == NULL )
-	{
-		if( libewf_hash_values_initialize(
-		     &( internal_handle->hash_values ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create hash values.",
-			 function );
+#endif
+	return( result );
+}
+
+/* Retrieves the sub-block size
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_sub_block_size(
+     libewf_handle_t *handle,
+     size32_t *sub_block_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_sub_block_size";
 
-			goto on_error;
-		}
-		internal_handle->hash_values_parsed = 1;
-	}
-	if( memory_copy(
-	     internal_handle->hash_sections->sha1_hash,
-	     sha1_hash,
-	     20 ) == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to set SHA1 hash.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	internal_handle->hash_sections->sha1_hash_set = 1;
+	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( memory_copy(
-	     internal_handle->hash_sections->sha1_digest,
-	     sha1_hash,
-	     20 ) == NULL )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to set SHA1 hash.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	internal_handle->hash_sections->sha1_digest_set = 1;
+	if( sub_block_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub-block size.",
+		 function );
 
-	if( libewf_hash_values_parse_sha1_hash(
-	     internal_handle->hash_values,
-	     sha1_hash,
-	     20,
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to parse SHA1 hash for its value.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
+#endif
+	*sub_block_size = internal_handle->io_handle->sub_block_size;
+
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -12345,34 +32795,30 @@ int libewf_handle_set_sha1_hash(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
 	return( 1 );
-
-on_error:
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_handle->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
 }
 
-/* Sets the read zero chunk on error
- * The chunk is not zeroed if read raw is used
+/* Sets the sub-block size
+ * If set to a value other than 0 deflate compressed EWF2 chunks that are larger
+ * than the sub-block size are compressed in independent sub-blocks followed by
+ * an index, so that the sub-blocks can be decompressed in parallel and a partial
+ * read only needs to decompress the sub-blocks it covers
+ * The sub-block size must be a multiple of 512 and at least 32 KiB
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_read_zero_chunk_on_error(
+int libewf_handle_set_sub_block_size(
      libewf_handle_t *handle,
-     uint8_t zero_on_error,
+     size32_t sub_block_size,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_read_zero_chunk_on_error";
+	static char *function                     = "libewf_handle_set_sub_block_size";
 
 	if( handle == NULL )
 	{
@@ -12398,6 +32844,20 @@ int libewf_handle_set_read_zero_chunk_on_error(
 
 		return( -1 );
 	}
+	if( ( sub_block_size != 0 )
+	 && ( ( sub_block_size < LIBEWF_PARALLEL_DEFLATE_DICTIONARY_SIZE )
+	  ||  ( sub_block_size > (size32_t) INT32_MAX )
+	  ||  ( ( sub_block_size % 512 ) != 0 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported sub-block size.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
@@ -12413,7 +32873,19 @@ int libewf_handle_set_read_zero_chunk_on_error(
 		return( -1 );
 	}
 #endif
-	internal_handle->io_handle->zero_on_error = zero_on_error;
+	if( ( internal_handle->write_io_handle == NULL )
+	 || ( internal_handle->write_io_handle->values_initialized != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: sub-block size cannot be changed.",
+		 function );
+
+		goto on_error;
+	}
+	internal_handle->io_handle->sub_block_size = sub_block_size;
 
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -12431,6 +32903,14 @@ int libewf_handle_set_read_zero_chunk_on_error(
 	}
 #endif
 	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
 }
 
 /* Copies the media values from the source to the destination handle
@@ -12546,7 +33026,7 @@ int libewf_handle_get_number_of_acquiry_errors(
 		return( -1 );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -12554,15 +33034,28 @@ int libewf_handle_get_number_of_acquiry_errors(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
+	if( libewf_internal_handle_read_deferred_error_section(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read deferred error section.",
+		 function );
+
+		goto on_error;
+	}
 	if( internal_handle->acquiry_errors != NULL )
 	{
-		if( libcdata_range_list_get_number_of_elements(
+		if( libewf_sector_range_list_get_number_of_ranges(
 		     internal_handle->acquiry_errors,
 		     &number_of_elements,
 		     error ) != 1 )
@@ -12591,7 +33084,7 @@ int libewf_handle_get_number_of_acquiry_errors(
 	*number_of_errors = (uint32_t) number_of_elements;
 
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -12599,7 +33092,7 @@ int libewf_handle_get_number_of_acquiry_errors(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
@@ -12609,7 +33102,7 @@ int libewf_handle_get_number_of_acquiry_errors(
 
 on_error:
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_read(
+	libcthreads_read_write_lock_release_for_write(
 	 internal_handle->read_write_lock,
 	 NULL );
 #endif
@@ -12628,7 +33121,6 @@ int libewf_handle_get_acquiry_error(
 {
 	libewf_internal_handle_t *internal_handle = NULL;
 	static char *function                     = "libewf_handle_get_acquiry_error";
-	intptr_t *value                           = NULL;
 	int result                                = 0;
 
 	if( handle == NULL )
@@ -12645,7 +33137,7 @@ int libewf_handle_get_acquiry_error(
 	internal_handle = (libewf_internal_handle_t *) handle;
 
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -12653,18 +33145,30 @@ int libewf_handle_get_acquiry_error(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	result = libcdata_range_list_get_range_by_index(
+	if( libewf_internal_handle_read_deferred_error_section(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read deferred error section.",
+		 function );
+
+		goto on_error;
+	}
+	result = libewf_sector_range_list_get_range_by_index(
 	          internal_handle->acquiry_errors,
 	          (int) index,
 	          start_sector,
 	          number_of_sectors,
-	          &value,
 	          error );
 
 	if( result != 1 )
@@ -12678,7 +33182,7 @@ int libewf_handle_get_acquiry_error(
 		 index );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -12686,13 +33190,21 @@ int libewf_handle_get_acquiry_error(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
 	return( result );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
 }
 
 /* Append an acquiry error
@@ -12736,13 +33248,23 @@ int libewf_handle_append_acquiry_error(
 		return( -1 );
 	}
 #endif
-	result = libcdata_range_list_insert_range(
+	if( libewf_internal_handle_read_deferred_error_section(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read deferred error section.",
+		 function );
+
+		goto on_error;
+	}
+	result = libewf_sector_range_list_insert_range(
 	          internal_handle->acquiry_errors,
 	          start_sector,
 	          number_of_sectors,
-	          NULL,
-	          NULL,
-	          NULL,
 	          error );
 
 	if( result != 1 )
@@ -12770,6 +33292,14 @@ int libewf_handle_append_acquiry_error(
 	}
 #endif
 	return( result );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
 }
 
 /* Retrieves the number of checksum errors
@@ -12895,19 +33425,95 @@ int libewf_handle_get_checksum_error(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->chunk_table == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing chunk table.",
-		 function );
-
-		return( -1 );
-	}
+	if( internal_handle->chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing chunk table.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_chunk_table_get_checksum_error(
+	          internal_handle->chunk_table,
+	          error_index,
+	          start_sector,
+	          number_of_sectors,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve checksum error: %" PRIu32 ".",
+		 function,
+		 error_index );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Appends a checksum error
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_append_checksum_error(
+     libewf_handle_t *handle,
+     uint64_t start_sector,
+     uint64_t number_of_sectors,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_append_checksum_error";
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -12915,15 +33521,14 @@ int libewf_handle_get_checksum_error(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	result = libewf_chunk_table_get_checksum_error(
+	result = libewf_chunk_table_append_checksum_error(
 	          internal_handle->chunk_table,
-	          error_index,
 	          start_sector,
 	          number_of_sectors,
 	          error );
@@ -12933,13 +33538,12 @@ int libewf_handle_get_checksum_error(
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve checksum error: %" PRIu32 ".",
-		 function,
-		 error_index );
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append checksum error.",
+		 function );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -12947,7 +33551,7 @@ int libewf_handle_get_checksum_error(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
@@ -12956,18 +33560,23 @@ int libewf_handle_get_checksum_error(
 	return( result );
 }
 
-/* Appends a checksum error
+/* Retrieves the number of acquiry and checksum errors that overlap with a range of the media data
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_append_checksum_error(
+int libewf_handle_get_errors_in_range(
      libewf_handle_t *handle,
-     uint64_t start_sector,
-     uint64_t number_of_sectors,
+     off64_t offset,
+     size64_t size,
+     uint32_t *number_of_acquiry_errors,
+     uint32_t *number_of_checksum_errors,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_append_checksum_error";
-	int result                                = 0;
+	static char *function                     = "libewf_handle_get_errors_in_range";
+	uint64_t end_sector                       = 0;
+	uint64_t start_sector                     = 0;
+	uint32_t number_of_errors                 = 0;
+	int number_of_ranges                      = 0;
 
 	if( handle == NULL )
 	{
@@ -12982,6 +33591,79 @@ int libewf_handle_append_checksum_error(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid media values - bytes per sector value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size64_t) ( INT64_MAX - offset ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_acquiry_errors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of acquiry errors.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_checksum_errors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of checksum errors.",
+		 function );
+
+		return( -1 );
+	}
+	start_sector = (uint64_t) offset / internal_handle->media_values->bytes_per_sector;
+	end_sector   = ( (uint64_t) offset + size + internal_handle->media_values->bytes_per_sector - 1 ) / internal_handle->media_values->bytes_per_sector;
+
+	if( size == 0 )
+	{
+		end_sector = start_sector;
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
@@ -12997,21 +33679,60 @@ int libewf_handle_append_checksum_error(
 		return( -1 );
 	}
 #endif
-	result = libewf_chunk_table_append_checksum_error(
-	          internal_handle->chunk_table,
-	          start_sector,
-	          number_of_sectors,
-	          error );
-
-	if( result != 1 )
+	if( libewf_internal_handle_read_deferred_error_section(
+	     internal_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to append checksum error.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read deferred error section.",
 		 function );
+
+		goto on_error;
+	}
+	if( internal_handle->acquiry_errors != NULL )
+	{
+		if( libewf_sector_range_list_get_number_of_ranges_in_range(
+		     internal_handle->acquiry_errors,
+		     start_sector,
+		     end_sector - start_sector,
+		     &number_of_ranges,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of acquiry errors in range.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( internal_handle->chunk_table != NULL )
+	{
+		if( libewf_chunk_table_get_number_of_checksum_errors_in_range(
+		     internal_handle->chunk_table,
+		     start_sector,
+		     end_sector - start_sector,
+		     &number_of_errors,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of checksum errors in range.",
+			 function );
+
+			goto on_error;
+		}
 	}
+	*number_of_acquiry_errors  = (uint32_t) number_of_ranges;
+	*number_of_checksum_errors = number_of_errors;
+
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
@@ -13027,7 +33748,15 @@ int libewf_handle_append_checksum_error(
 		return( -1 );
 	}
 #endif
-	return( result );
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
 }
 
 /* Retrieves the number of sessions
@@ -13067,7 +33796,7 @@ int libewf_handle_get_number_of_sessions(
 		return( -1 );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -13075,12 +33804,25 @@ int libewf_handle_get_number_of_sessions(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
+	if( libewf_internal_handle_read_deferred_session_section(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read deferred session section.",
+		 function );
+
+		goto on_error;
+	}
 	if( internal_handle->sessions != NULL )
 	{
 		if( libcdata_array_get_number_of_entries(
@@ -13112,7 +33854,7 @@ int libewf_handle_get_number_of_sessions(
 	*number_of_sessions = (uint32_t) number_of_entries;
 
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -13120,7 +33862,7 @@ int libewf_handle_get_number_of_sessions(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
@@ -13130,7 +33872,7 @@ int libewf_handle_get_number_of_sessions(
 
 on_error:
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_read(
+	libcthreads_read_write_lock_release_for_write(
 	 internal_handle->read_write_lock,
 	 NULL );
 #endif
@@ -13165,7 +33907,7 @@ int libewf_handle_get_session(
 	internal_handle = (libewf_internal_handle_t *) handle;
 
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -13173,12 +33915,25 @@ int libewf_handle_get_session(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
+	if( libewf_internal_handle_read_deferred_session_section(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read deferred session section.",
+		 function );
+
+		goto on_error;
+	}
 	if( libcdata_array_get_entry_by_index(
 	     internal_handle->sessions,
 	     (int) index,
@@ -13212,7 +33967,7 @@ int libewf_handle_get_session(
 		goto on_error;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -13220,7 +33975,7 @@ int libewf_handle_get_session(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
@@ -13230,7 +33985,7 @@ int libewf_handle_get_session(
 
 on_error:
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_read(
+	libcthreads_read_write_lock_release_for_write(
 	 internal_handle->read_write_lock,
 	 NULL );
 #endif
@@ -13279,6 +34034,19 @@ int libewf_handle_append_session(
 		return( -1 );
 	}
 #endif
+	if( libewf_internal_handle_read_deferred_session_section(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read deferred session section.",
+		 function );
+
+		goto on_error;
+	}
 	if( libewf_sector_range_initialize(
 	     &sector_range,
 	     error ) != 1 )
@@ -13391,7 +34159,7 @@ int libewf_handle_get_number_of_tracks(
 		return( -1 );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -13399,12 +34167,25 @@ int libewf_handle_get_number_of_tracks(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
+	if( libewf_internal_handle_read_deferred_session_section(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read deferred session section.",
+		 function );
+
+		goto on_error;
+	}
 	if( internal_handle->tracks != NULL )
 	{
 		if( libcdata_array_get_number_of_entries(
@@ -13436,7 +34217,7 @@ int libewf_handle_get_number_of_tracks(
 	*number_of_tracks = (uint32_t) number_of_entries;
 
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -13444,7 +34225,7 @@ int libewf_handle_get_number_of_tracks(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
@@ -13454,7 +34235,7 @@ int libewf_handle_get_number_of_tracks(
 
 on_error:
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_read(
+	libcthreads_read_write_lock_release_for_write(
 	 internal_handle->read_write_lock,
 	 NULL );
 #endif
@@ -13489,7 +34270,7 @@ int libewf_handle_get_track(
 	internal_handle = (libewf_internal_handle_t *) handle;
 
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -13497,12 +34278,25 @@ int libewf_handle_get_track(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
+	if( libewf_internal_handle_read_deferred_session_section(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read deferred session section.",
+		 function );
+
+		goto on_error;
+	}
 	if( libcdata_array_get_entry_by_index(
 	     internal_handle->tracks,
 	     (int) index,
@@ -13536,7 +34330,7 @@ int libewf_handle_get_track(
 		goto on_error;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -13544,7 +34338,7 @@ int libewf_handle_get_track(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
@@ -13554,7 +34348,7 @@ int libewf_handle_get_track(
 
 on_error:
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_read(
+	libcthreads_read_write_lock_release_for_write(
 	 internal_handle->read_write_lock,
 	 NULL );
 #endif
@@ -13603,6 +34397,19 @@ int libewf_handle_append_track(
 		return( -1 );
 	}
 #endif
+	if( libewf_internal_handle_read_deferred_session_section(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read deferred session section.",
+		 function );
+
+		goto on_error;
+	}
 	if( libewf_sector_range_initialize(
 	     &sector_range,
 	     error ) != 1 )
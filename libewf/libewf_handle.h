@@ -25,11 +25,20 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_access_advice.h"
+#include "libewf_async_reader.h"
+#include "libewf_chunk_access_map.h"
+#include "libewf_chunk_cache.h"
+#include "libewf_chunk_packer.h"
+#include "libewf_chunk_unpacker.h"
 #include "libewf_chunk_data.h"
 #include "libewf_chunk_group.h"
+#include "libewf_chunk_group_scanner.h"
 #include "libewf_chunk_table.h"
 #include "libewf_data_chunk.h"
+#include "libewf_disk_chunk_cache.h"
 #include "libewf_extern.h"
+#include "libewf_file_io_pool_group.h"
 #include "libewf_hash_sections.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcdata.h"
@@ -41,7 +50,13 @@
 #include "libewf_io_handle.h"
 #include "libewf_media_values.h"
 #include "libewf_read_io_handle.h"
+#include "libewf_running_digest.h"
+#include "libewf_section_descriptor.h"
+#include "libewf_sector_range_list.h"
+#include "libewf_segment_index.h"
 #include "libewf_segment_table.h"
+#include "libewf_shared_chunk_cache.h"
+#include "libewf_shared_state.h"
 #include "libewf_single_files.h"
 #include "libewf_types.h"
 #include "libewf_write_io_handle.h"
@@ -72,7 +87,31 @@ struct libewf_internal_handle
 
 	/* The sectors with acquiry read errors
 	 */
-	libcdata_range_list_t *acquiry_errors;
+	libewf_sector_range_list_t *acquiry_errors;
+
+	/* The session section that is read when the sessions or tracks are first used
+	 */
+	libewf_section_descriptor_t *deferred_session_section;
+
+	/* The file IO pool entry of the deferred session section
+	 */
+	int deferred_session_section_file_io_pool_entry;
+
+	/* The format version of the deferred session section
+	 */
+	uint8_t deferred_session_section_format_version;
+
+	/* The error section that is read when the acquiry errors are first used
+	 */
+	libewf_section_descriptor_t *deferred_error_section;
+
+	/* The file IO pool entry of the deferred error section
+	 */
+	int deferred_error_section_file_io_pool_entry;
+
+	/* The format version of the deferred error section
+	 */
+	uint8_t deferred_error_section_format_version;
 
 	/* The file IO pool
 	 */
@@ -82,6 +121,14 @@ struct libewf_internal_handle
 	 */
 	uint8_t file_io_pool_created_in_library;
 
+	/* The file IO pool group that the file IO pool shares the maximum number of open handles with
+	 */
+	libewf_file_io_pool_group_t *file_io_pool_group;
+
+	/* The asynchronous reader of the segment files
+	 */
+	libewf_async_reader_t *async_reader;
+
 	/* The read IO handle
 	 */
 	libewf_read_io_handle_t *read_io_handle;
@@ -118,10 +165,221 @@ struct libewf_internal_handle
 	 */
 	libfcache_cache_t *chunks_cache;
 
+	/* The chunk cache that can be shared between handles
+	 */
+	libewf_chunk_cache_t *chunk_cache;
+
+	/* The key prefix of the chunks of the handle in the chunk cache
+	 */
+	uint64_t chunk_cache_key_prefix;
+
+	/* The state that is shared with clones of the handle
+	 * The IO handle, segment table, chunk table, hash sections, header and hash values
+	 * and read/write lock of the handle reference the shared state when they are set
+	 */
+	libewf_shared_state_t *shared_state;
+
+	/* The segment index used by the next open
+	 */
+	libewf_segment_index_t *segment_index;
+
+	/* The disk chunk cache
+	 */
+	libewf_disk_chunk_cache_t *disk_chunk_cache;
+
+	/* The shared chunk cache
+	 */
+	libewf_shared_chunk_cache_t *shared_chunk_cache;
+
+	/* The chunk access map that records the chunks that are read
+	 */
+	libewf_chunk_access_map_t *chunk_access_map;
+
+	/* The chunk access map of the chunks that are pending to be prefetched
+	 */
+	libewf_chunk_access_map_t *prefetch_chunk_access_map;
+
+	/* The access advice of ranges of chunks
+	 */
+	libewf_access_advice_t *access_advice;
+
+	/* The priority of the reads of the handle
+	 */
+	int read_priority;
+
+	/* The maximum number of cached chunk groups
+	 */
+	int maximum_number_of_cached_chunk_groups;
+
+	/* The maximum number of cached chunks
+	 */
+	int maximum_number_of_cached_chunks;
+
+	/* The maximum size of the chunks cache in bytes
+	 */
+	size64_t maximum_cache_size;
+
+	/* The memory limit of the caches in bytes, 0 represents no limit
+	 */
+	size64_t memory_limit;
+
+	/* The number of chunks to read ahead on sequential access
+	 */
+	int number_of_read_ahead_chunks;
+
+	/* The index of the chunk that is expected to be read next on sequential access
+	 */
+	uint64_t read_ahead_next_chunk_index;
+
+	/* The index of the chunk following the last chunk that was read ahead
+	 */
+	uint64_t read_ahead_last_chunk_index;
+
+	/* The remaining size of the media data in a segment file at which
+	 * the next segment file is prefetched on sequential access, 0 disables prefetch
+	 */
+	size64_t segment_prefetch_size;
+
+	/* The media offset of the last segment file that was prefetched
+	 */
+	off64_t segment_prefetch_offset;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The read ahead thread
+	 */
+	libcthreads_thread_t *read_ahead_thread;
+
+	/* The read ahead mutex
+	 */
+	libcthreads_mutex_t *read_ahead_mutex;
+
+	/* The read ahead condition
+	 */
+	libcthreads_condition_t *read_ahead_condition;
+
+	/* The index of the first chunk of the pending read ahead request
+	 */
+	uint64_t read_ahead_start_chunk_index;
+
+	/* The index of the chunk following the last chunk of the pending read ahead request
+	 */
+	uint64_t read_ahead_end_chunk_index;
+
+	/* Value to indicate the read ahead thread should stop
+	 */
+	uint8_t read_ahead_stop;
+
+	/* The media offset of the segment file of the pending prefetch request
+	 */
+	off64_t read_ahead_prefetch_offset;
+
+	/* Value to indicate a prefetch request is pending
+	 */
+	uint8_t read_ahead_prefetch;
+
+	/* The index of the chunk from which the next chunk of the prefetch chunk access map is searched
+	 */
+	uint64_t read_ahead_prefetch_chunk_index;
+
+	/* The thread pool that processes the asynchronous read requests
+	 */
+	libcthreads_thread_pool_t *read_requests_thread_pool;
+
+	/* The thread that indexes the chunk groups after a lazy open
+	 */
+	libcthreads_thread_t *index_thread;
+
+	/* Value to indicate the index thread should stop
+	 */
+	uint8_t index_stop;
+#endif
+
+	/* The number of threads used to (un)pack chunks and scan segment files
+	 */
+	int number_of_threads;
+
+	/* The scheduler, a reference that is not freed by the handle
+	 */
+	libewf_scheduler_t *scheduler;
+
+	/* The chunk unpacker
+	 */
+	libewf_chunk_unpacker_t *chunk_unpacker;
+
+	/* The running digest
+	 */
+	libewf_running_digest_t *running_digest;
+
+	/* The chunk packer
+	 */
+	libewf_chunk_packer_t *chunk_packer;
+
+	/* The chunk data of the chunks that are waiting to be packed and written
+	 */
+	libewf_chunk_data_t **pending_chunk_data;
+
+	/* The unpacked data sizes of the pending chunks
+	 */
+	size_t *pending_chunk_data_sizes;
+
+	/* The chunk index of the first pending chunk
+	 */
+	uint64_t pending_chunk_index;
+
+	/* The number of pending chunks
+	 */
+	int number_of_pending_chunks;
+
+	/* The maximum number of chunks that can be written ahead of the next chunk
+	 */
+	int maximum_number_of_out_of_order_chunks;
+
+	/* The chunk data of the chunks that were written ahead of the next chunk
+	 * indexed by the chunk index modulo the maximum number of out of order chunks
+	 */
+	libewf_chunk_data_t **out_of_order_chunk_data;
+
+	/* The unpacked data sizes of the out of order chunks
+	 */
+	size_t *out_of_order_chunk_data_sizes;
+
+	/* The number of out of order chunks
+	 */
+	int number_of_out_of_order_chunks;
+
 	/* The current chunk data
 	 */
 	libewf_chunk_data_t *chunk_data;
 
+	/* The chunk data of the active chunk view
+	 */
+	libewf_chunk_data_t *chunk_view_data;
+
+	/* The chunks cache that contains the chunk data of the active chunk view
+	 */
+	libfcache_cache_t *chunk_view_cache;
+
+	/* The unpacked chunk data of the current batch of the stream reader
+	 */
+	libewf_chunk_data_t **stream_chunk_data;
+
+	/* The maximum number of chunks per batch of the stream reader
+	 */
+	int stream_maximum_number_of_chunks;
+
+	/* The number of chunks of the current batch of the stream reader
+	 */
+	int stream_number_of_chunks;
+
+	/* The chunk index of the first chunk of the current batch of the stream reader
+	 */
+	uint64_t stream_chunk_index;
+
+	/* Value to indicate chunks that are fully covered by the buffer of a read
+	 * should be unpacked directly into the buffer
+	 */
+	uint8_t read_decompress_to_buffer;
+
 	/* The date format for certain header values
 	 */
 	int date_format;
@@ -173,6 +431,18 @@ int libewf_handle_clone(
      libewf_handle_t *source_handle,
      libcerror_error_t **error );
 
+int libewf_internal_handle_share_state(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_detach_shared_state(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_release_shared_state(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_signal_abort(
      libewf_handle_t *handle,
@@ -205,12 +475,71 @@ int libewf_internal_handle_open_read_segment_file_section_data(
      int file_io_pool_entry,
      libcerror_error_t **error );
 
+int libewf_internal_handle_set_deferred_section(
+     libewf_internal_handle_t *internal_handle,
+     libewf_section_descriptor_t **deferred_section,
+     libewf_section_descriptor_t *section,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_seek_deferred_section(
+     libewf_internal_handle_t *internal_handle,
+     libewf_section_descriptor_t *deferred_section,
+     int file_io_pool_entry,
+     uint8_t format_version,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_read_deferred_session_section(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_read_deferred_error_section(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_open_read_segment_file(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     uint32_t segment_number,
+     libcerror_error_t **error );
+
 int libewf_internal_handle_open_read_segment_files(
      libewf_internal_handle_t *internal_handle,
      libbfio_pool_t *file_io_pool,
      libewf_segment_table_t *segment_table,
+     int access_flags,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_read_segment_files_to_offset(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_append_index_segment_files(
+     libewf_internal_handle_t *internal_handle,
+     libewf_chunk_group_scanner_t *chunk_group_scanner,
+     uint32_t *segment_number,
+     off64_t *segment_offset,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_index_chunk_groups(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+int libewf_internal_handle_index_thread_function(
+     libewf_internal_handle_t *internal_handle );
+
+int libewf_internal_handle_index_start(
+     libewf_internal_handle_t *internal_handle,
      libcerror_error_t **error );
 
+int libewf_internal_handle_index_stop(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+#endif
+
 int libewf_internal_handle_open_file_io_pool(
      libewf_internal_handle_t *internal_handle,
      libbfio_pool_t *file_io_pool,
@@ -226,30 +555,457 @@ int libewf_handle_open_file_io_pool(
      libcerror_error_t **error );
 
 LIBEWF_EXTERN \
-int libewf_handle_close(
+int libewf_handle_close(
+     libewf_handle_t *handle,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_index_chunk_groups(
+     libewf_handle_t *handle,
+     libcerror_error_t **error );
+
+ssize_t libewf_internal_handle_read_buffer_with_chunk_unpacker(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
+ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+ssize_t libewf_handle_read_buffer(
+         libewf_handle_t *handle,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+ssize_t libewf_handle_read_buffer_at_offset(
+         libewf_handle_t *handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+int libewf_internal_handle_compare_vector_elements(
+     const void *first_element,
+     const void *second_element );
+
+ssize_t libewf_internal_handle_read_vector(
+         libewf_internal_handle_t *internal_handle,
+         const libewf_iovec_t *iov,
+         int count,
+         libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+ssize_t libewf_handle_read_vector(
+         libewf_handle_t *handle,
+         const libewf_iovec_t *iov,
+         int count,
+         libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_running_digest_types(
+     libewf_handle_t *handle,
+     uint8_t digest_types,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_running_digest(
+     libewf_handle_t *handle,
+     uint8_t digest_type,
+     uint8_t *digest,
+     size_t digest_size,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_read_packed_chunk_data(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_read_packed_chunks_data(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     int number_of_chunks,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_read_chunk_data_to_buffer(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t chunk_index,
+     uint8_t *buffer,
+     size_t buffer_size,
+     size_t *read_size,
+     libcerror_error_t **error );
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) && defined( HAVE_ZLIB_INFLATE ) ) || defined( ZLIB_DLL )
+
+int libewf_internal_handle_read_chunk_sub_blocks_to_buffer(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t chunk_index,
+     size_t chunk_data_offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     size_t *read_size,
+     libcerror_error_t **error );
+
+#endif /* ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) && defined( HAVE_ZLIB_INFLATE ) ) || defined( ZLIB_DLL ) */
+
+int libewf_internal_handle_append_chunk_checksum_error(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_initialize_chunk_cache(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_get_concurrent_chunk_data(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+ssize_t libewf_internal_handle_read_buffer_at_offset_concurrent(
+         libewf_internal_handle_t *internal_handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         uint64_t *read_ahead_next_chunk_index,
+         uint64_t maximum_end_chunk_index,
+         libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+ssize_t libewf_handle_read_buffer_at_offset_concurrent(
+         libewf_handle_t *handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_read_buffer_at_offset_async(
+     libewf_handle_t *handle,
+     void *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     void (*callback)(
+            void *callback_data,
+            ssize_t read_count,
+            libcerror_error_t *error ),
+     void *callback_data,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+int libewf_internal_handle_read_requests_stop(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+#endif
+
+LIBEWF_EXTERN \
+int libewf_handle_share_chunk_cache(
+     libewf_handle_t *handle,
+     libewf_handle_t *source_handle,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_maximum_chunk_cache_size(
+     libewf_handle_t *handle,
+     size64_t maximum_chunk_cache_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_share_maximum_number_of_open_handles(
+     libewf_handle_t *handle,
+     libewf_handle_t *source_handle,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_statistics_value(
+     libewf_handle_t *handle,
+     int statistic_type,
+     uint64_t *value,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_reset_statistics(
+     libewf_handle_t *handle,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_open_segment_index(
+     libewf_handle_t *handle,
+     const char *filename,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBEWF_EXTERN \
+int libewf_handle_open_segment_index_wide(
+     libewf_handle_t *handle,
+     const wchar_t *filename,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+LIBEWF_EXTERN \
+int libewf_handle_open_segment_index_file_io_handle(
+     libewf_handle_t *handle,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_get_segment_index(
+     libewf_internal_handle_t *internal_handle,
+     libewf_segment_index_t **segment_index,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_write_segment_index(
+     libewf_handle_t *handle,
+     const char *filename,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBEWF_EXTERN \
+int libewf_handle_write_segment_index_wide(
+     libewf_handle_t *handle,
+     const wchar_t *filename,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+LIBEWF_EXTERN \
+int libewf_handle_write_segment_index_file_io_handle(
+     libewf_handle_t *handle,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_open_disk_chunk_cache(
+     libewf_internal_handle_t *internal_handle,
+     const char *filename,
+     size_t filename_length,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_open_disk_chunk_cache(
+     libewf_handle_t *handle,
+     const char *filename,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_open_shared_chunk_cache(
+     libewf_internal_handle_t *internal_handle,
+     const char *name,
+     size_t name_length,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_open_shared_chunk_cache(
+     libewf_handle_t *handle,
+     const char *name,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_start_chunk_access_recording(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_start_chunk_access_recording(
+     libewf_handle_t *handle,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_write_chunk_access_map(
+     libewf_internal_handle_t *internal_handle,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_write_chunk_access_map(
+     libewf_handle_t *handle,
+     const char *filename,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_prefetch_chunk_access_map(
+     libewf_internal_handle_t *internal_handle,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_prefetch_chunk_access_map(
+     libewf_handle_t *handle,
+     const char *filename,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_advise(
+     libewf_internal_handle_t *internal_handle,
+     off64_t offset,
+     size64_t size,
+     int advice,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_advise(
+     libewf_handle_t *handle,
+     off64_t offset,
+     size64_t size,
+     int advice,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_get_chunk_view(
+     libewf_internal_handle_t *internal_handle,
+     off64_t offset,
+     const uint8_t **data,
+     size_t *data_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_chunk_view(
+     libewf_handle_t *handle,
+     off64_t offset,
+     const uint8_t **data,
+     size_t *data_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_release_chunk_view(
+     libewf_handle_t *handle,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_get_chunk_storage_values(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     uint32_t *chunk_flags,
+     uint32_t *stored_size,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_get_chunk_flags(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     uint32_t *chunk_flags,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_chunk_flags(
+     libewf_handle_t *handle,
+     uint64_t chunk_index,
+     uint32_t *chunk_flags,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_chunks_flags(
+     libewf_handle_t *handle,
+     uint64_t first_chunk_index,
+     uint32_t *chunks_flags,
+     int number_of_chunks,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_chunks_storage_values(
+     libewf_handle_t *handle,
+     uint64_t first_chunk_index,
+     uint32_t *chunks_flags,
+     uint32_t *chunks_stored_sizes,
+     int number_of_chunks,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_number_of_segments(
+     libewf_handle_t *handle,
+     uint32_t *number_of_segments,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_segment_media_range(
+     libewf_handle_t *handle,
+     uint32_t segment_index,
+     int *file_index,
+     off64_t *media_offset,
+     size64_t *media_size,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_get_chunk_pattern_fill(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     uint64_t *pattern_fill,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_chunk_pattern_fill(
+     libewf_handle_t *handle,
+     uint64_t chunk_index,
+     uint64_t *pattern_fill,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_get_chunk_extent_type(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     uint32_t *extent_type,
+     uint64_t *pattern_fill,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_get_data_extent(
+     libewf_internal_handle_t *internal_handle,
+     off64_t offset,
+     off64_t *extent_offset,
+     size64_t *extent_size,
+     uint32_t *extent_type,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_data_extents(
      libewf_handle_t *handle,
+     off64_t offset,
+     off64_t *extents_offsets,
+     size64_t *extents_sizes,
+     uint32_t *extents_types,
+     int number_of_extents,
      libcerror_error_t **error );
 
-ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
+int libewf_internal_handle_initialize_chunk_packer(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_free_chunk_packer(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+ssize_t libewf_internal_handle_write_pending_chunks(
          libewf_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
-         void *buffer,
-         size_t buffer_size,
          libcerror_error_t **error );
 
-LIBEWF_EXTERN \
-ssize_t libewf_handle_read_buffer(
-         libewf_handle_t *handle,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error );
+int libewf_internal_handle_free_out_of_order_chunks(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
 
-LIBEWF_EXTERN \
-ssize_t libewf_handle_read_buffer_at_offset(
-         libewf_handle_t *handle,
-         void *buffer,
-         size_t buffer_size,
-         off64_t offset,
+int libewf_internal_handle_append_out_of_order_chunk(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+ssize_t libewf_internal_handle_write_out_of_order_chunks(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
          libcerror_error_t **error );
 
 ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
@@ -292,6 +1048,58 @@ ssize_t libewf_handle_read_data_chunk(
          libewf_data_chunk_t *data_chunk,
          libcerror_error_t **error );
 
+int libewf_internal_handle_read_data_chunks_from_file_io_pool(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_data_chunk_t **data_chunks,
+     int number_of_data_chunks,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_read_data_chunks(
+     libewf_handle_t *handle,
+     libewf_data_chunk_t **data_chunks,
+     int number_of_data_chunks,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_stream_free_chunk_data(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_stream_read_chunk_data(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t chunk_index,
+     libcerror_error_t **error );
+
+ssize_t libewf_internal_handle_stream_read_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
+int libewf_internal_handle_stream_close(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_stream_open(
+     libewf_handle_t *handle,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+ssize_t libewf_handle_stream_read(
+         libewf_handle_t *handle,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_stream_close(
+     libewf_handle_t *handle,
+     libcerror_error_t **error );
+
 ssize_t libewf_internal_handle_write_data_chunk_to_file_io_pool(
          libewf_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
@@ -339,6 +1147,219 @@ int libewf_handle_set_maximum_number_of_open_handles(
      int maximum_number_of_open_handles,
      libcerror_error_t **error );
 
+int libewf_internal_handle_set_maximum_number_of_cached_chunks(
+     libewf_internal_handle_t *internal_handle,
+     int maximum_number_of_cached_chunks,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_apply_maximum_cache_size(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_apply_memory_limit(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_get_memory_usage(
+     libewf_internal_handle_t *internal_handle,
+     size64_t *memory_usage,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+int libewf_internal_handle_read_ahead_thread_function(
+     libewf_internal_handle_t *internal_handle );
+
+int libewf_internal_handle_read_ahead_start(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_read_ahead_stop(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_begin_interactive_read(
+     libewf_internal_handle_t *internal_handle,
+     uint8_t *is_interactive_read,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_end_interactive_read(
+     libewf_internal_handle_t *internal_handle,
+     uint8_t is_interactive_read,
+     libcerror_error_t **error );
+#endif
+
+int libewf_internal_handle_read_ahead_chunk(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_read_ahead_concurrent_chunk(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_prefetch_chunk(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_read_ahead_signal(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     uint64_t maximum_end_chunk_index,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_prefetch_segment(
+     libewf_internal_handle_t *internal_handle,
+     off64_t offset,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_prefetch_segment_signal(
+     libewf_internal_handle_t *internal_handle,
+     off64_t offset,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_maximum_number_of_cached_chunks(
+     libewf_handle_t *handle,
+     int *maximum_number_of_cached_chunks,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_maximum_number_of_cached_chunks(
+     libewf_handle_t *handle,
+     int maximum_number_of_cached_chunks,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_maximum_number_of_cached_chunk_groups(
+     libewf_handle_t *handle,
+     int *maximum_number_of_cached_chunk_groups,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_maximum_number_of_cached_chunk_groups(
+     libewf_handle_t *handle,
+     int maximum_number_of_cached_chunk_groups,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_maximum_cache_size(
+     libewf_handle_t *handle,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_memory_limit(
+     libewf_handle_t *handle,
+     size64_t *memory_limit,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_memory_limit(
+     libewf_handle_t *handle,
+     size64_t memory_limit,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_chunks_cache_statistics(
+     libewf_handle_t *handle,
+     uint64_t *number_of_cache_hits,
+     uint64_t *number_of_cache_misses,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_number_of_read_ahead_chunks(
+     libewf_handle_t *handle,
+     int *number_of_read_ahead_chunks,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_number_of_read_ahead_chunks(
+     libewf_handle_t *handle,
+     int number_of_read_ahead_chunks,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_segment_prefetch_size(
+     libewf_handle_t *handle,
+     size64_t *segment_prefetch_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_segment_prefetch_size(
+     libewf_handle_t *handle,
+     size64_t segment_prefetch_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_read_priority(
+     libewf_handle_t *handle,
+     int *read_priority,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_read_priority(
+     libewf_handle_t *handle,
+     int read_priority,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_number_of_threads(
+     libewf_handle_t *handle,
+     int *number_of_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_number_of_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_scheduler(
+     libewf_handle_t *handle,
+     libewf_scheduler_t *scheduler,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_decompression_backend(
+     libewf_handle_t *handle,
+     int *decompression_backend,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_decompression_backend(
+     libewf_handle_t *handle,
+     int decompression_backend,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_batch_decompression_function(
+     libewf_handle_t *handle,
+     int (*batch_decompression_function)(
+            int number_of_chunks,
+            const uint8_t **compressed_data,
+            const size_t *compressed_data_sizes,
+            uint8_t **data,
+            size_t *data_sizes,
+            void *function_data,
+            libcerror_error_t **error ),
+     void *function_data,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_maximum_number_of_out_of_order_chunks(
+     libewf_handle_t *handle,
+     int *maximum_number_of_out_of_order_chunks,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_maximum_number_of_out_of_order_chunks(
+     libewf_handle_t *handle,
+     int maximum_number_of_out_of_order_chunks,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_segment_files_corrupted(
      libewf_handle_t *handle,
@@ -405,6 +1426,18 @@ int libewf_handle_set_maximum_segment_size(
      size64_t maximum_segment_size,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_get_write_sync_policy(
+     libewf_handle_t *handle,
+     uint8_t *sync_policy,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_write_sync_policy(
+     libewf_handle_t *handle,
+     uint8_t sync_policy,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_get_filename_size(
      libewf_handle_t *handle,
@@ -458,6 +1491,13 @@ int libewf_internal_handle_set_media_values(
      size64_t media_size,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_append_utf8_ltree_data(
+     libewf_handle_t *handle,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_get_root_file_entry(
      libewf_handle_t *handle,
@@ -494,6 +1534,26 @@ int libewf_handle_get_file_entry_by_utf16_path(
      libewf_file_entry_t **file_entry,
      libcerror_error_t **error );
 
+ssize_t libewf_internal_handle_read_file_entries_chunk(
+         libewf_internal_handle_t *internal_handle,
+         uint8_t *chunk_buffer,
+         uint64_t chunk_index,
+         uint64_t *read_ahead_next_chunk_index,
+         libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_read_file_entries_data(
+     libewf_handle_t *handle,
+     int (*callback_function)(
+            libewf_file_entry_t *file_entry,
+            off64_t offset,
+            const uint8_t *data,
+            size_t data_size,
+            void *callback_data,
+            libcerror_error_t **error ),
+     void *callback_data,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_get_sectors_per_chunk(
      libewf_handle_t *handle,
@@ -671,6 +1731,54 @@ int libewf_handle_set_read_zero_chunk_on_error(
      uint8_t zero_on_error,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_get_read_verify_checksums(
+     libewf_handle_t *handle,
+     uint8_t *verify_checksums,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_read_verify_checksums(
+     libewf_handle_t *handle,
+     uint8_t verify_checksums,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_read_decompress_to_buffer(
+     libewf_handle_t *handle,
+     uint8_t *decompress_to_buffer,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_read_decompress_to_buffer(
+     libewf_handle_t *handle,
+     uint8_t decompress_to_buffer,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_use_huge_pages(
+     libewf_handle_t *handle,
+     uint8_t *use_huge_pages,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_use_huge_pages(
+     libewf_handle_t *handle,
+     uint8_t use_huge_pages,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_sub_block_size(
+     libewf_handle_t *handle,
+     size32_t *sub_block_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_sub_block_size(
+     libewf_handle_t *handle,
+     size32_t sub_block_size,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_copy_media_values(
      libewf_handle_t *destination_handle,
@@ -719,6 +1827,15 @@ int libewf_handle_append_checksum_error(
      uint64_t number_of_sectors,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_get_errors_in_range(
+     libewf_handle_t *handle,
+     off64_t offset,
+     size64_t size,
+     uint32_t *number_of_acquiry_errors,
+     uint32_t *number_of_checksum_errors,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_get_number_of_sessions(
      libewf_handle_t *handle,
@@ -30,6 +30,7 @@
 #include "libewf_libcerror.h"
 #include "libewf_libcnotify.h"
 #include "libewf_libfvalue.h"
+#include "libewf_memory_accounting.h"
 
 /* Creates header sections
  * Make sure the value header_sections is referencing, is set to NULL
@@ -91,6 +92,11 @@ int libewf_header_sections_initialize(
 
 		goto on_error;
 	}
+	LIBEWF_MEMORY_ACCOUNTING_UPDATE(
+	 LIBEWF_MEMORY_TYPE_HEADER_VALUES,
+	 *header_sections,
+	 sizeof( libewf_header_sections_t ) );
+
 	return( 1 );
 
 on_error:
@@ -141,6 +147,11 @@ int libewf_header_sections_free(
 			memory_free(
 			 ( *header_sections )->xheader );
 		}
+		LIBEWF_MEMORY_ACCOUNTING_UPDATE(
+		 LIBEWF_MEMORY_TYPE_HEADER_VALUES,
+		 *header_sections,
+		 0 );
+
 		memory_free(
 		 *header_sections );
 
@@ -309,6 +320,11 @@ int libewf_header_sections_clone(
 	}
 	( *destination_header_sections )->number_of_header_sections = source_header_sections->number_of_header_sections;
 
+	LIBEWF_MEMORY_ACCOUNTING_UPDATE(
+	 LIBEWF_MEMORY_TYPE_HEADER_VALUES,
+	 *destination_header_sections,
+	 LIBEWF_HEADER_SECTIONS_MEMORY_SIZE( *destination_header_sections ) );
+
 	return( 1 );
 
 on_error:
@@ -329,6 +345,11 @@ on_error:
 			memory_free(
 			 ( *destination_header_sections )->header );
 		}
+		LIBEWF_MEMORY_ACCOUNTING_UPDATE(
+		 LIBEWF_MEMORY_TYPE_HEADER_VALUES,
+		 *destination_header_sections,
+		 0 );
+
 		memory_free(
 		 *destination_header_sections );
 
@@ -569,6 +590,11 @@ int libewf_header_sections_generate(
 			goto on_error;
 		}
 	}
+	LIBEWF_MEMORY_ACCOUNTING_UPDATE(
+	 LIBEWF_MEMORY_TYPE_HEADER_VALUES,
+	 header_sections,
+	 LIBEWF_HEADER_SECTIONS_MEMORY_SIZE( header_sections ) );
+
 	return( 1 );
 
 on_error:
@@ -64,8 +64,22 @@ struct libewf_header_sections
 	/* Value to indicate the number of header sections found
 	 */
 	uint8_t number_of_header_sections;
+
+#if defined( HAVE_LIBEWF_MEMORY_ACCOUNTING )
+	/* The size of the memory accounted for the header sections
+	 */
+	size_t accounted_memory_size;
+#endif
 };
 
+/* The size of the memory of header sections including the stored header sections
+ */
+#define LIBEWF_HEADER_SECTIONS_MEMORY_SIZE( header_sections ) \
+	( sizeof( libewf_header_sections_t ) \
+	 + ( ( ( header_sections )->header != NULL ) ? ( header_sections )->header_size : 0 ) \
+	 + ( ( ( header_sections )->header2 != NULL ) ? ( header_sections )->header2_size : 0 ) \
+	 + ( ( ( header_sections )->xheader != NULL ) ? ( header_sections )->xheader_size : 0 ) )
+
 int libewf_header_sections_initialize(
      libewf_header_sections_t **header_sections,
      libcerror_error_t **error );
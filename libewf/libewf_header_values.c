@@ -1302,6 +1302,183 @@ on_error:
 	return( -1 );
 }
 
+/* Converts a date header value into a date time values string
+ * The header parser stores date values in their header or header2 form,
+ * these are converted on the first request, a header value that already
+ * contains a date time values string is left unchanged
+ * Returns 1 if successful, 0 if the date value could not be converted or -1 on error
+ */
+int libewf_header_values_convert_date_value(
+     libfvalue_value_t *header_value,
+     libcerror_error_t **error )
+{
+	uint8_t *date_time_values_string    = NULL;
+	uint8_t *value_data                 = NULL;
+	static char *function               = "libewf_header_values_convert_date_value";
+	size_t date_time_values_string_size = 0;
+	size_t string_index                 = 0;
+	size_t value_data_size              = 0;
+	size_t value_string_length          = 0;
+	uint8_t has_space_characters        = 0;
+	uint8_t is_date_time_values_string  = 0;
+	int encoding                        = 0;
+	int result                          = 0;
+
+	if( libfvalue_value_get_data(
+	     header_value,
+	     &value_data,
+	     &value_data_size,
+	     &encoding,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve header value data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_data == NULL )
+	 || ( value_data_size < 2 ) )
+	{
+		return( 0 );
+	}
+	while( ( value_string_length < value_data_size )
+	    && ( value_data[ value_string_length ] != 0 ) )
+	{
+		value_string_length++;
+	}
+	/* A date time values string has the form: "YYYY MM DD hh mm ss"
+	 */
+	if( value_string_length == 19 )
+	{
+		is_date_time_values_string = 1;
+
+		for( string_index = 0;
+		     string_index < 19;
+		     string_index++ )
+		{
+			if( ( string_index == 4 )
+			 || ( string_index == 7 )
+			 || ( string_index == 10 )
+			 || ( string_index == 13 )
+			 || ( string_index == 16 ) )
+			{
+				if( value_data[ string_index ] != (uint8_t) ' ' )
+				{
+					is_date_time_values_string = 0;
+
+					break;
+				}
+			}
+			else if( ( value_data[ string_index ] < (uint8_t) '0' )
+			      || ( value_data[ string_index ] > (uint8_t) '9' ) )
+			{
+				is_date_time_values_string = 0;
+
+				break;
+			}
+		}
+	}
+	if( is_date_time_values_string != 0 )
+	{
+		return( 1 );
+	}
+	for( string_index = 0;
+	     string_index < value_string_length;
+	     string_index++ )
+	{
+		if( value_data[ string_index ] == (uint8_t) ' ' )
+		{
+			has_space_characters = 1;
+
+			break;
+		}
+	}
+	/* If the date value contains spaces it's in the header format
+	 * otherwise is in the header2 format
+	 */
+	if( has_space_characters != 0 )
+	{
+		result = libewf_convert_date_header_value(
+		          value_data,
+		          value_string_length + 1,
+		          &date_time_values_string,
+		          &date_time_values_string_size,
+		          error );
+	}
+	else
+	{
+		result = libewf_convert_date_header2_value(
+		          value_data,
+		          value_string_length + 1,
+		          &date_time_values_string,
+		          &date_time_values_string_size,
+		          error );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to create date time values string.",
+		 function );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			if( ( error != NULL )
+			 && ( *error != NULL ) )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+		}
+#endif
+		libcerror_error_free(
+		 error );
+
+		return( 0 );
+	}
+	/* The effective size of the date time values string is needed
+	 */
+	date_time_values_string_size = 1 + narrow_string_length(
+	                                    (char *) date_time_values_string );
+
+	if( libfvalue_value_set_data(
+	     header_value,
+	     date_time_values_string,
+	     date_time_values_string_size,
+	     LIBFVALUE_CODEPAGE_UTF8,
+	     LIBFVALUE_VALUE_DATA_FLAG_MANAGED,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set header value data.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 date_time_values_string );
+
+	return( 1 );
+
+on_error:
+	if( date_time_values_string != NULL )
+	{
+		memory_free(
+		 date_time_values_string );
+	}
+	return( -1 );
+}
+
 /* Copies the header values from the source to the destination
  * Returns 1 if successful -1 on error
  */
@@ -1482,39 +1659,44 @@ on_error:
 }
 
 /* Parses an UTF-8 encoded header string for the values
+ * The header string is tokenized in a single pass and in place, the line
+ * and tab separators are replaced by end-of-string characters
+ * The date values are stored unconverted and are converted into date time values
+ * strings by libewf_header_values_convert_date_value when they are requested
  * Returns 1 if successful or -1 on error
  */
 int libewf_header_values_parse_utf8_header_string(
      libfvalue_table_t *header_values,
-     const uint8_t *header_string,
+     uint8_t *header_string,
      size_t header_string_size,
      uint8_t header_section_number,
      uint8_t *format,
      libcerror_error_t **error )
 {
-	libfvalue_split_utf8_string_t *lines  = NULL;
-	libfvalue_split_utf8_string_t *types  = NULL;
-	libfvalue_split_utf8_string_t *values = NULL;
-	libfvalue_value_t *header_value       = NULL;
-	uint8_t *date_time_values_string      = NULL;
-	uint8_t *identifier                   = NULL;
-	uint8_t *line_string                  = NULL;
-	uint8_t *type_string                  = NULL;
-	uint8_t *value_string                 = NULL;
-	static char *function                 = "libewf_header_values_parse_utf8_header_string";
-	size_t date_time_values_string_size   = 0;
-	size_t identifier_size                = 0;
-	size_t line_string_size               = 0;
-	size_t type_string_size               = 0;
-	size_t value_string_size              = 0;
-	uint8_t acquiry_software_version      = 0;
-	uint8_t has_carriage_return           = 0;
-	uint8_t number_of_sections            = 0;
-	int number_of_lines                   = 0;
-	int number_of_types                   = 0;
-	int number_of_values                  = 0;
-	int result                            = 0;
-	int value_index                       = 0;
+	uint8_t *line_strings[ 4 ];
+	size_t line_string_sizes[ 4 ];
+
+	libfvalue_value_t *header_value  = NULL;
+	uint8_t *identifier              = NULL;
+	uint8_t *line_string             = NULL;
+	uint8_t *type_string             = NULL;
+	uint8_t *value_string            = NULL;
+	static char *function            = "libewf_header_values_parse_utf8_header_string";
+	size_t header_string_length      = 0;
+	size_t identifier_size           = 0;
+	size_t line_string_size          = 0;
+	size_t string_index              = 0;
+	size_t type_string_index         = 0;
+	size_t type_string_size          = 0;
+	size_t value_string_index        = 0;
+	size_t value_string_size         = 0;
+	uint8_t acquiry_software_version = 0;
+	uint8_t has_carriage_return      = 0;
+	uint8_t number_of_sections       = 0;
+	int line_index                   = 0;
+	int number_of_types              = 0;
+	int number_of_values             = 0;
+	int value_index                  = 0;
 
 	if( header_string == NULL )
 	{
@@ -1527,826 +1709,547 @@ int libewf_header_values_parse_utf8_header_string(
 
 		return( -1 );
 	}
-	if( ( header_section_number != 1 )
-	 && ( header_section_number != 2 ) )
+	if( ( header_string_size == 0 )
+	 || ( header_string_size > (size_t) SSIZE_MAX ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported header section number.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid header string size value out of bounds.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( format == NULL )
+	if( header_string[ header_string_size - 1 ] != 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid format.",
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported header string - missing end-of-string character.",
 		 function );
 
 		return( -1 );
 	}
-	if( libfvalue_utf8_string_split(
-	     header_string,
-	     header_string_size,
-	     (uint8_t) '\n',
-	     &lines,
-	     error ) != 1 )
+	if( ( header_section_number != 1 )
+	 && ( header_section_number != 2 ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to split header string into lines.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported header section number.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfvalue_split_utf8_string_get_number_of_segments(
-	     lines,
-	     &number_of_lines,
-	     error ) != 1 )
+	if( format == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of lines.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid format.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( number_of_lines > 0 )
-	{
-		if( libfvalue_split_utf8_string_get_segment_by_index(
-		     lines,
-		     0,
-		     &line_string,
-		     &line_string_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve line string: 0.",
-			 function );
+	header_string_length = narrow_string_length(
+	                        (char *) header_string );
 
-			goto on_error;
-		}
-		if( line_string == NULL )
+	/* Determine the first 4 lines, the line feeds are replaced by end-of-string characters
+	 * and a trailing carriage return is removed
+	 */
+	for( line_index = 0;
+	     line_index < 4;
+	     line_index++ )
+	{
+		if( ( line_index > 0 )
+		 && ( string_index > header_string_length ) )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing line string: 0.",
-			 function );
+			 "%s: missing line string: %d.",
+			 function,
+			 line_index );
 
 			goto on_error;
 		}
-		if( ( line_string == NULL )
-		 || ( line_string_size < 2 )
-		 || ( line_string[ 0 ] == 0 ) )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing line string: 0.",
-			 function );
+		line_string      = &( header_string[ string_index ] );
+		line_string_size = string_index;
 
-			goto on_error;
+		while( ( string_index < header_string_length )
+		    && ( header_string[ string_index ] != (uint8_t) '\n' ) )
+		{
+			string_index++;
 		}
-		/* Remove trailing carriage return
-		 */
-		else if( line_string[ line_string_size - 2 ] == (uint8_t) '\r' )
+		header_string[ string_index ] = 0;
+
+		line_string_size = string_index - line_string_size + 1;
+
+		if( ( line_index < 2 )
+		 && ( line_string_size >= 2 )
+		 && ( line_string[ line_string_size - 2 ] == (uint8_t) '\r' ) )
 		{
 			line_string[ line_string_size - 2 ] = 0;
 
 			line_string_size -= 1;
 		}
-		if( line_string_size != 2 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-			 "%s: unsupported line string: 0.",
-			 function );
+		line_strings[ line_index ]      = line_string;
+		line_string_sizes[ line_index ] = line_string_size;
 
-			goto on_error;
-		}
-		if( ( line_string[ 0 ] != (uint8_t) '1' )
-		 && ( line_string[ 0 ] != (uint8_t) '3' ) )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-			 "%s: unsupported line string: 0.",
-			 function );
+		string_index++;
+	}
+	if( ( line_string_sizes[ 0 ] != 2 )
+	 || ( ( line_strings[ 0 ][ 0 ] != (uint8_t) '1' )
+	  &&  ( line_strings[ 0 ][ 0 ] != (uint8_t) '3' ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported line string: 0.",
+		 function );
 
-			goto on_error;
-		}
-		number_of_sections = line_string[ 0 ];
+		goto on_error;
+	}
+	number_of_sections = line_strings[ 0 ][ 0 ];
 
-		if( libfvalue_split_utf8_string_get_segment_by_index(
-		     lines,
-		     1,
-		     &line_string,
-		     &line_string_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve line string: 1.",
-			 function );
+	if( ( line_string_sizes[ 1 ] != 5 )
+	 || ( line_strings[ 1 ][ 0 ] != (uint8_t) 'm' )
+	 || ( line_strings[ 1 ][ 1 ] != (uint8_t) 'a' )
+	 || ( line_strings[ 1 ][ 2 ] != (uint8_t) 'i' )
+	 || ( line_strings[ 1 ][ 3 ] != (uint8_t) 'n' ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported line string: 1.",
+		 function );
 
-			goto on_error;
+		goto on_error;
+	}
+	if( header_section_number == 1 )
+	{
+		/* If the header string contains 3 object the version is at least linen5
+		 * otherwise the version is at least EnCase1
+		 */
+		if( number_of_sections == (uint8_t) '3' )
+		{
+			*format = LIBEWF_FORMAT_LINEN5;
 		}
-		if( line_string == NULL )
+		else
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing line string: 1.",
-			 function );
+			*format = LIBEWF_FORMAT_ENCASE1;
+		}
+	}
+	/* Walk the types and values lines simultaneously, the tabs are replaced
+	 * by end-of-string characters
+	 */
+	while( type_string_index < line_string_sizes[ 2 ] )
+	{
+		type_string      = &( line_strings[ 2 ][ type_string_index ] );
+		type_string_size = type_string_index;
 
-			goto on_error;
+		while( ( line_strings[ 2 ][ type_string_index ] != 0 )
+		    && ( line_strings[ 2 ][ type_string_index ] != (uint8_t) '\t' ) )
+		{
+			type_string_index++;
 		}
-		if( ( line_string == NULL )
-		 || ( line_string_size < 5 )
-		 || ( line_string[ 0 ] == 0 ) )
+		line_strings[ 2 ][ type_string_index ] = 0;
+
+		type_string_size   = type_string_index - type_string_size + 1;
+		type_string_index += 1;
+
+		value_index = number_of_types;
+
+		number_of_types++;
+
+		if( ( type_string_size < 2 )
+		 || ( type_string[ 0 ] == 0 ) )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing line string: 1.",
-			 function );
+			 "%s: missing type string: %d.",
+			 function,
+			 value_index );
 
 			goto on_error;
 		}
 		/* Remove trailing carriage return
 		 */
-		else if( line_string[ line_string_size - 2 ] == (uint8_t) '\r' )
+		else if( type_string[ type_string_size - 2 ] == (uint8_t) '\r' )
 		{
-			line_string[ line_string_size - 2 ] = 0;
+			type_string[ type_string_size - 2 ] = 0;
 
-			line_string_size -= 1;
-		}
-		if( line_string_size != 5 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-			 "%s: unsupported line string: 1.",
-			 function );
+			type_string_size -= 1;
 
-			goto on_error;
+			has_carriage_return = 1;
 		}
-		if( ( line_string[ 0 ] != (uint8_t) 'm' )
-		 || ( line_string[ 1 ] != (uint8_t) 'a' )
-		 || ( line_string[ 2 ] != (uint8_t) 'i' )
-		 || ( line_string[ 3 ] != (uint8_t) 'n' ) )
+		if( value_string_index < line_string_sizes[ 3 ] )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-			 "%s: unsupported line string: 1.",
-			 function );
+			value_string      = &( line_strings[ 3 ][ value_string_index ] );
+			value_string_size = value_string_index;
 
-			goto on_error;
-		}
-		if( header_section_number == 1 )
-		{
-			/* If the header string contains 3 object the version is at least linen5
-			 * otherwise the version is at least EnCase1
-			 */
-			if( number_of_sections == (uint8_t) '3' )
+			while( ( line_strings[ 3 ][ value_string_index ] != 0 )
+			    && ( line_strings[ 3 ][ value_string_index ] != (uint8_t) '\t' ) )
 			{
-				*format = LIBEWF_FORMAT_LINEN5;
+				value_string_index++;
 			}
-			else
+			line_strings[ 3 ][ value_string_index ] = 0;
+
+			value_string_size   = value_string_index - value_string_size + 1;
+			value_string_index += 1;
+
+			number_of_values++;
+
+			if( ( value_string_size < 2 )
+			 || ( value_string[ 0 ] == 0 ) )
 			{
-				*format = LIBEWF_FORMAT_ENCASE1;
+				value_string      = NULL;
+				value_string_size = 0;
 			}
-		}
-		if( libfvalue_split_utf8_string_get_segment_by_index(
-		     lines,
-		     2,
-		     &line_string,
-		     &line_string_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve line string: 2.",
-			 function );
-
-			goto on_error;
-		}
-		if( libfvalue_utf8_string_split(
-		     line_string,
-		     line_string_size,
-		     (uint8_t) '\t',
-		     &types,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to split header values string into types.",
-			 function );
-
-			goto on_error;
-		}
-		if( libfvalue_split_utf8_string_get_number_of_segments(
-		     types,
-		     &number_of_types,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve number of types.",
-			 function );
-
-			goto on_error;
-		}
-		if( libfvalue_split_utf8_string_get_segment_by_index(
-		     lines,
-		     3,
-		     &line_string,
-		     &line_string_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve line string: 3.",
-			 function );
-
-			goto on_error;
-		}
-		if( libfvalue_utf8_string_split(
-		     line_string,
-		     line_string_size,
-		     (uint8_t) '\t',
-		     &values,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to split header values string into values.",
-			 function );
+			/* Remove trailing carriage return
+			 */
+			else if( value_string[ value_string_size - 2 ] == (uint8_t) '\r' )
+			{
+				value_string[ value_string_size - 2 ] = 0;
 
-			goto on_error;
+				value_string_size -= 1;
+			}
 		}
-		if( libfvalue_split_utf8_string_get_number_of_segments(
-		     values,
-		     &number_of_values,
-		     error ) != 1 )
+		else
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve number of values.",
-			 function );
-
-			goto on_error;
+			value_string      = NULL;
+			value_string_size = 0;
 		}
 #if defined( HAVE_VERBOSE_OUTPUT )
-		if( number_of_types != number_of_values )
+		if( libcnotify_verbose != 0 )
 		{
-			if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-			 	"%s: mismatch in number of types and values.\n",
-				 function );
-			}
+			libcnotify_printf(
+			 "%s: type: %s with value: %s.\n",
+			 function,
+			 (char *) type_string,
+			 (char *) value_string );
 		}
 #endif
-		for( value_index = 0;
-		     value_index < number_of_types;
-		     value_index++ )
-		{
-			if( libfvalue_split_utf8_string_get_segment_by_index(
-			     types,
-			     value_index,
-			     &type_string,
-			     &type_string_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve type string: %d.",
-				 function,
-				 value_index );
+		identifier      = NULL;
+		identifier_size = 0;
 
-				goto on_error;
-			}
-			if( ( type_string == NULL )
-			 || ( type_string_size < 2 )
-			 || ( type_string[ 0 ] == 0 ) )
+		if( type_string_size == 4 )
+		{
+			if( ( type_string[ 0 ] == (uint8_t) 'e' )
+			 && ( type_string[ 1 ] == (uint8_t) 'x' )
+			 && ( type_string[ 2 ] == (uint8_t) 't' ) )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: missing type string: %d.",
-				 function,
-				 value_index );
-
-				goto on_error;
+				identifier      = (uint8_t *) "extents";
+				identifier_size = 8;
 			}
-			/* Remove trailing carriage return
-			 */
-			else if( type_string[ type_string_size - 2 ] == (uint8_t) '\r' )
+			else if( ( type_string[ 0 ] == (uint8_t) 'p' )
+			      && ( type_string[ 1 ] == (uint8_t) 'i' )
+			      && ( type_string[ 2 ] == (uint8_t) 'd' ) )
 			{
-				type_string[ type_string_size - 2 ] = 0;
-
-				type_string_size -= 1;
-
-				has_carriage_return = 1;
+				identifier      = (uint8_t *) "process_identifier";
+				identifier_size = 19;
 			}
-			if( value_index < number_of_values )
+		}
+		else if( type_string_size == 3 )
+		{
+			if( ( type_string[ 0 ] == (uint8_t) 'a' )
+			 && ( type_string[ 1 ] == (uint8_t) 'v' ) )
 			{
-				if( libfvalue_split_utf8_string_get_segment_by_index(
-				     values,
-				     value_index,
-				     &value_string,
-				     &value_string_size,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to retrieve value string: %d.",
-					 function,
-					 value_index );
+				identifier      = (uint8_t *) "acquiry_software_version";
+				identifier_size = 25;
 
-					goto on_error;
-				}
-				if( ( value_string == NULL )
-				 || ( value_string_size < 2 )
-				 || ( value_string[ 0 ] == 0 ) )
+				if( value_index == 5 )
 				{
-					value_string      = NULL;
-					value_string_size = 0;
+					/* The linen5 header contains av on the 6th position
+					 */
+					if( header_section_number == 1 )
+					{
+						*format = LIBEWF_FORMAT_LINEN5;
+					}
+					else if( header_section_number == 2 )
+					{
+						/* The EnCase4 header2 contains av on the 6th position
+						 * and the header2 consist of 1 sections
+						 */
+						if( number_of_sections == (uint8_t) '1' )
+						{
+							*format = LIBEWF_FORMAT_ENCASE4;
+						}
+						/* The EnCase5 header2 contains av on the 6th position
+						 * and the header2 consist of 3 sections
+						 */
+						else if( number_of_sections == (uint8_t) '3' )
+						{
+							*format = LIBEWF_FORMAT_ENCASE5;
+						}
+					}
 				}
-				/* Remove trailing carriage return
-				 */
-				else if( value_string[ value_string_size - 2 ] == (uint8_t) '\r' )
+				if( ( value_string != NULL )
+				 && ( value_string_size > 1 ) )
 				{
-					value_string[ value_string_size - 2 ] = 0;
-
-					value_string_size -= 1;
+					acquiry_software_version = value_string[ 0 ];
 				}
 			}
-			else
+			else if( ( type_string[ 0 ] == (uint8_t) 'd' )
+			      && ( type_string[ 1 ] == (uint8_t) 'c' ) )
 			{
-				value_string      = NULL;
-				value_string_size = 0;
+				identifier      = (uint8_t *) "unknown_dc";
+				identifier_size = 11;
 			}
-#if defined( HAVE_VERBOSE_OUTPUT )
-			if( libcnotify_verbose != 0 )
+			else if( ( type_string[ 0 ] == (uint8_t) 'm' )
+			      && ( type_string[ 1 ] == (uint8_t) 'd' ) )
 			{
-				libcnotify_printf(
-				 "%s: type: %s with value: %s.\n",
-				 function,
-				 (char *) type_string,
-				 (char *) value_string );
-			}
-#endif
-			identifier      = NULL;
-			identifier_size = 0;
+				identifier      = (uint8_t *) "model";
+				identifier_size = 6;
 
-			if( type_string_size == 4 )
-			{
-				if( ( type_string[ 0 ] == (uint8_t) 'e' )
-				 && ( type_string[ 1 ] == (uint8_t) 'x' )
-				 && ( type_string[ 2 ] == (uint8_t) 't' ) )
+				if( value_index == 5 )
 				{
-					identifier      = (uint8_t *) "extents";
-					identifier_size = 8;
-				}
-				else if( ( type_string[ 0 ] == (uint8_t) 'p' )
-				      && ( type_string[ 1 ] == (uint8_t) 'i' )
-				      && ( type_string[ 2 ] == (uint8_t) 'd' ) )
-				{
-					identifier      = (uint8_t *) "process_identifier";
-					identifier_size = 19;
-				}
-			}
-			else if( type_string_size == 3 )
-			{
-				if( ( type_string[ 0 ] == (uint8_t) 'a' )
-				 && ( type_string[ 1 ] == (uint8_t) 'v' ) )
-				{
-					identifier      = (uint8_t *) "acquiry_software_version";
-					identifier_size = 25;
-
-					if( value_index == 5 )
+					/* The linen6 header contains md on the 6th position
+					 */
+					if( header_section_number == 1 )
 					{
-						/* The linen5 header contains av on the 6th position
-						 */
-						if( header_section_number == 1 )
-						{
-							*format = LIBEWF_FORMAT_LINEN5;
-						}
-						else if( header_section_number == 2 )
-						{
-							/* The EnCase4 header2 contains av on the 6th position
-							 * and the header2 consist of 1 sections
-							 */
-							if( number_of_sections == (uint8_t) '1' )
-							{
-								*format = LIBEWF_FORMAT_ENCASE4;
-							}
-							/* The EnCase5 header2 contains av on the 6th position
-							 * and the header2 consist of 3 sections
-							 */
-							else if( number_of_sections == (uint8_t) '3' )
-							{
-								*format = LIBEWF_FORMAT_ENCASE5;
-							}
-						}
+						*format = LIBEWF_FORMAT_LINEN6;
 					}
-					if( ( value_string != NULL )
-					 && ( value_string_size > 1 ) )
+					/* The EnCase6 header2 contains md on the 6th position
+					 */
+					else if( header_section_number == 2 )
 					{
-						acquiry_software_version = value_string[ 0 ];
+						*format = LIBEWF_FORMAT_ENCASE6;
 					}
 				}
-				else if( ( type_string[ 0 ] == (uint8_t) 'd' )
-				      && ( type_string[ 1 ] == (uint8_t) 'c' ) )
-				{
-					identifier      = (uint8_t *) "unknown_dc";
-					identifier_size = 11;
-				}
-				else if( ( type_string[ 0 ] == (uint8_t) 'm' )
-				      && ( type_string[ 1 ] == (uint8_t) 'd' ) )
-				{
-					identifier      = (uint8_t *) "model";
-					identifier_size = 6;
+			}
+			else if( ( type_string[ 0 ] == (uint8_t) 'o' )
+			      && ( type_string[ 1 ] == (uint8_t) 'v' ) )
+			{
+				identifier      = (uint8_t *) "acquiry_operating_system";
+				identifier_size = 25;
+			}
+			else if( ( type_string[ 0 ] == (uint8_t) 's' )
+			      && ( type_string[ 1 ] == (uint8_t) 'n' ) )
+			{
+				identifier      = (uint8_t *) "serial_number";
+				identifier_size = 14;
+			}
+		}
+		else if( type_string_size == 2 )
+		{
+			if( type_string[ 0 ] == (uint8_t) 'a' )
+			{
+				identifier      = (uint8_t *) "description";
+				identifier_size = 12;
+			}
+			else if( type_string[ 0 ] == (uint8_t) 'c' )
+			{
+				identifier      = (uint8_t *) "case_number";
+				identifier_size = 12;
+			}
+			else if( type_string[ 0 ] == (uint8_t) 'e' )
+			{
+				identifier      = (uint8_t *) "examiner_name";
+				identifier_size = 14;
+			}
+			else if( type_string[ 0 ] == (uint8_t) 'l' )
+			{
+				identifier      = (uint8_t *) "device_label";
+				identifier_size = 13;
 
-					if( value_index == 5 )
-					{
-						/* The linen6 header contains md on the 6th position
-						 */
-						if( header_section_number == 1 )
-						{
-							*format = LIBEWF_FORMAT_LINEN6;
-						}
-						/* The EnCase6 header2 contains md on the 6th position
-						 */
-						else if( header_section_number == 2 )
-						{
-							*format = LIBEWF_FORMAT_ENCASE6;
-						}
-					}
-				}
-				else if( ( type_string[ 0 ] == (uint8_t) 'o' )
-				      && ( type_string[ 1 ] == (uint8_t) 'v' ) )
+				/* The linen7 header contains l
+				 */
+				if( header_section_number == 1 )
 				{
-					identifier      = (uint8_t *) "acquiry_operating_system";
-					identifier_size = 25;
+					*format = LIBEWF_FORMAT_LINEN7;
 				}
-				else if( ( type_string[ 0 ] == (uint8_t) 's' )
-				      && ( type_string[ 1 ] == (uint8_t) 'n' ) )
+				/* The EnCase7 header2 contains l
+				 */
+				else if( header_section_number == 2 )
 				{
-					identifier      = (uint8_t *) "serial_number";
-					identifier_size = 14;
+					*format = LIBEWF_FORMAT_ENCASE7;
 				}
 			}
-			else if( type_string_size == 2 )
+			else if( ( type_string[ 0 ] == (uint8_t) 'm' )
+			      || ( type_string[ 0 ] == (uint8_t) 'u' ) )
 			{
-				if( type_string[ 0 ] == (uint8_t) 'a' )
+				/* The date value is converted when it is requested
+				 */
+				if( type_string[ 0 ] == (uint8_t) 'm' )
 				{
-					identifier      = (uint8_t *) "description";
-					identifier_size = 12;
+					identifier      = (uint8_t *) "acquiry_date";
+					identifier_size = 13;
 				}
-				else if( type_string[ 0 ] == (uint8_t) 'c' )
+				else
 				{
-					identifier      = (uint8_t *) "case_number";
+					identifier      = (uint8_t *) "system_date";
 					identifier_size = 12;
 				}
-				else if( type_string[ 0 ] == (uint8_t) 'e' )
-				{
-					identifier      = (uint8_t *) "examiner_name";
-					identifier_size = 14;
-				}
-				else if( type_string[ 0 ] == (uint8_t) 'l' )
+			}
+			else if( type_string[ 0 ] == (uint8_t) 'n' )
+			{
+				identifier      = (uint8_t *) "evidence_number";
+				identifier_size = 16;
+			}
+			else if( type_string[ 0 ] == (uint8_t) 'p' )
+			{
+				if( ( value_string == NULL )
+				 || ( value_string_size == 0 )
+				 || ( value_string[ 0 ] == 0 ) )
 				{
-					identifier      = (uint8_t *) "device_label";
-					identifier_size = 13;
-
-					/* The linen7 header contains l
+					/* Empty hash do nothing
 					 */
-					if( header_section_number == 1 )
-					{
-						*format = LIBEWF_FORMAT_LINEN7;
-					}
-					/* The EnCase7 header2 contains l
-					 */
-					else if( header_section_number == 2 )
-					{
-						*format = LIBEWF_FORMAT_ENCASE7;
-					}
 				}
-				else if( ( type_string[ 0 ] == (uint8_t) 'm' )
-				      || ( type_string[ 0 ] == (uint8_t) 'u' ) )
+				else if( ( value_string_size == 2 )
+				      && ( value_string[ 0 ] == (uint8_t) '0' ) )
 				{
-					if( ( value_string == NULL )
-					 || ( value_string_size == 0 )
-					 || ( value_string[ 0 ] == 0 ) )
-					{
-						date_time_values_string = NULL;
-						result                  = 0;
-					}
-					/* If the date time values string contains spaces it's in the old header
-					 * format otherwise is in new header2 format
+					/* Empty hash do nothing
 					 */
-					else if( narrow_string_search_character(
-					          (char *) value_string,
-					          ' ',
-					          value_string_size - 1 ) != NULL )
-					{
-						result = libewf_convert_date_header_value(
-							  value_string,
-							  value_string_size,
-							  &date_time_values_string,
-							  &date_time_values_string_size,
-						          error );
-					}
-					else
-					{
-						result = libewf_convert_date_header2_value(
-							  value_string,
-							  value_string_size,
-							  &date_time_values_string,
-							  &date_time_values_string_size,
-						          error );
-					}
-					if( result != 1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_CONVERSION,
-						 LIBCERROR_CONVERSION_ERROR_GENERIC,
-						 "%s: unable to create date time values string.",
-						 function );
-
-#if defined( HAVE_DEBUG_OUTPUT )
-						if( libcnotify_verbose != 0 )
-						{
-							if( ( error != NULL )
-							 && ( *error != NULL ) )
-							{
-								libcnotify_print_error_backtrace(
-								 *error );
-							}
-						}
-#endif
-						libcerror_error_free(
-						 error );
-					}
-					/* The effective size of the date time values string is needed
-					 */
-					if( date_time_values_string != NULL )
-					{
-						value_string      = date_time_values_string;
-						value_string_size = 1 + narrow_string_length(
-									 (char *) date_time_values_string );
-
-						if( type_string[ 0 ] == (uint8_t) 'm' )
-						{
-							identifier      = (uint8_t *) "acquiry_date";
-							identifier_size = 13;
-						}
-						else if( type_string[ 0 ] == (uint8_t) 'u' )
-						{
-							identifier      = (uint8_t *) "system_date";
-							identifier_size = 12;
-						}
-					}
 				}
-				else if( type_string[ 0 ] == (uint8_t) 'n' )
+				else
 				{
-					identifier      = (uint8_t *) "evidence_number";
-					identifier_size = 16;
+					identifier      = (uint8_t *) "password";
+					identifier_size = 9;
 				}
-				else if( type_string[ 0 ] == (uint8_t) 'p' )
+			}
+			else if( type_string[ 0 ] == (uint8_t) 'r' )
+			{
+				identifier      = (uint8_t *) "compression_level";
+				identifier_size = 18;
+
+				if( header_section_number == 1 )
 				{
-					if( ( value_string == NULL )
-					 || ( value_string_size == 0 )
-					 || ( value_string[ 0 ] == 0 ) )
-					{
-						/* Empty hash do nothing
-						 */
-					}
-					else if( ( value_string_size == 2 )
-					      && ( value_string[ 0 ] == (uint8_t) '0' ) )
-					{
-						/* Empty hash do nothing
-						 */
-					}
-					else
+					/* The EnCase1 header contains r on the 9th position
+					 */
+					if( value_index == 8 )
 					{
-						identifier      = (uint8_t *) "password";
-						identifier_size = 9;
+						*format = LIBEWF_FORMAT_ENCASE1;
 					}
-				}
-				else if( type_string[ 0 ] == (uint8_t) 'r' )
-				{
-					identifier      = (uint8_t *) "compression_level";
-					identifier_size = 18;
-
-					if( header_section_number == 1 )
+					else if( value_index == 10 )
 					{
-						/* The EnCase1 header contains r on the 9th position
+						/* The EnCase2 and EnCase3 header contains r on the 11th position
+						 * and uses \r\n as line ends. The only way to tell both version
+						 * apart is to look at the acquiry software version
 						 */
-						if( value_index == 8 )
+						if( has_carriage_return != 0 )
 						{
-							*format = LIBEWF_FORMAT_ENCASE1;
-						}
-						else if( value_index == 10 )
-						{
-							/* The EnCase2 and EnCase3 header contains r on the 11th position
-							 * and uses \r\n as line ends. The only way to tell both version
-							 * apart is to look at the acquiry software version
-							 */
-							if( has_carriage_return != 0 )
+							if( acquiry_software_version == (uint8_t) '2' )
 							{
-								if( acquiry_software_version == (uint8_t) '2' )
-								{
-									*format = LIBEWF_FORMAT_ENCASE2;
-								}
-								else if( acquiry_software_version == (uint8_t) '3' )
-								{
-									*format = LIBEWF_FORMAT_ENCASE3;
-								}
+								*format = LIBEWF_FORMAT_ENCASE2;
 							}
-							/* The FTK imager header contains r on the 11th position
-							 * and uses \n as line ends
-							 */
-							else
+							else if( acquiry_software_version == (uint8_t) '3' )
 							{
-								*format = LIBEWF_FORMAT_FTK_IMAGER;
+								*format = LIBEWF_FORMAT_ENCASE3;
 							}
 						}
+						/* The FTK imager header contains r on the 11th position
+						 * and uses \n as line ends
+						 */
+						else
+						{
+							*format = LIBEWF_FORMAT_FTK_IMAGER;
+						}
 					}
 				}
-				else if( type_string[ 0 ] == (uint8_t) 't' )
-				{
-					identifier      = (uint8_t *) "notes";
-					identifier_size = 6;
-				}
 			}
-			/* Ignore empty values
-			 */
-			if( value_string == NULL )
+			else if( type_string[ 0 ] == (uint8_t) 't' )
 			{
-				continue;
+				identifier      = (uint8_t *) "notes";
+				identifier_size = 6;
 			}
-			if( identifier != NULL )
+		}
+		/* Ignore empty values
+		 */
+		if( value_string == NULL )
+		{
+			continue;
+		}
+		if( identifier != NULL )
+		{
+			if( libfvalue_value_type_initialize(
+			     &header_value,
+			     LIBFVALUE_VALUE_TYPE_STRING_UTF8,
+			     error ) != 1 )
 			{
-				if( libfvalue_value_type_initialize(
-				     &header_value,
-				     LIBFVALUE_VALUE_TYPE_STRING_UTF8,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-					 "%s: unable to create header value.",
-					 function );
-
-					goto on_error;
-				}
-				if( libfvalue_value_set_identifier(
-				     header_value,
-				     identifier,
-				     identifier_size,
-				     LIBFVALUE_VALUE_IDENTIFIER_FLAG_MANAGED,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-					 "%s: unable to set header value: %s identifier.",
-					 function,
-					 (char *) identifier );
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create header value.",
+				 function );
 
-					goto on_error;
-				}
-				if( libfvalue_value_set_data(
-				     header_value,
-				     value_string,
-				     value_string_size,
-				     LIBFVALUE_CODEPAGE_UTF8,
-				     LIBFVALUE_VALUE_DATA_FLAG_MANAGED,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-					 "%s: unable to set header value: %s data.",
-					 function,
-					 (char *) identifier );
+				goto on_error;
+			}
+			if( libfvalue_value_set_identifier(
+			     header_value,
+			     identifier,
+			     identifier_size,
+			     LIBFVALUE_VALUE_IDENTIFIER_FLAG_MANAGED,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set header value: %s identifier.",
+				 function,
+				 (char *) identifier );
 
-					goto on_error;
-				}
-				if( libfvalue_table_set_value(
-				     header_values,
-				     header_value,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-					 "%s: unable to set header value: %s in table.",
-					 function,
-					 (char *) identifier );
+				goto on_error;
+			}
+			if( libfvalue_value_set_data(
+			     header_value,
+			     value_string,
+			     value_string_size,
+			     LIBFVALUE_CODEPAGE_UTF8,
+			     LIBFVALUE_VALUE_DATA_FLAG_MANAGED,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set header value: %s data.",
+				 function,
+				 (char *) identifier );
 
-					goto on_error;
-				}
-				header_value = NULL;
+				goto on_error;
 			}
-			if( date_time_values_string != NULL )
+			if( libfvalue_table_set_value(
+			     header_values,
+			     header_value,
+			     error ) != 1 )
 			{
-				memory_free(
-				 date_time_values_string );
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set header value: %s in table.",
+				 function,
+				 (char *) identifier );
 
-				date_time_values_string = NULL;
+				goto on_error;
 			}
+			header_value = NULL;
 		}
-		if( libfvalue_split_utf8_string_free(
-		     &values,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free split values.",
-			 function );
-
-			goto on_error;
-		}
-		if( libfvalue_split_utf8_string_free(
-		     &types,
-		     error ) != 1 )
+	}
+#if defined( HAVE_VERBOSE_OUTPUT )
+	if( ( number_of_types != number_of_values )
+	 || ( value_string_index < line_string_sizes[ 3 ] ) )
+	{
+		if( libcnotify_verbose != 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free split types.",
+			libcnotify_printf(
+			 "%s: mismatch in number of types and values.\n",
 			 function );
-
-			goto on_error;
 		}
 	}
-	if( libfvalue_split_utf8_string_free(
-	     &lines,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free split lines.",
-		 function );
-
-		goto on_error;
-	}
+#endif
 	return( 1 );
 
 on_error:
@@ -2356,29 +2259,6 @@ on_error:
 		 &header_value,
 		 NULL );
 	}
-	if( date_time_values_string != NULL )
-	{
-		memory_free(
-		 date_time_values_string );
-	}
-	if( values != NULL )
-	{
-		libfvalue_split_utf8_string_free(
-		 &values,
-		 NULL );
-	}
-	if( types != NULL )
-	{
-		libfvalue_split_utf8_string_free(
-		 &types,
-		 NULL );
-	}
-	if( lines != NULL )
-	{
-		libfvalue_split_utf8_string_free(
-		 &lines,
-		 NULL );
-	}
 	return( -1 );
 }
 
@@ -2395,6 +2275,7 @@ int libewf_header_values_parse_header(
 {
 	uint8_t *header_string    = NULL;
 	static char *function     = "libewf_header_values_parse_header";
+	size_t header_index       = 0;
 	size_t header_string_size = 0;
 
 	if( header == NULL )
@@ -2408,52 +2289,115 @@ int libewf_header_values_parse_header(
 
 		return( -1 );
 	}
-	if( libuna_utf8_string_size_from_byte_stream(
-	     header,
-	     header_size,
-	     codepage,
-	     &header_string_size,
-	     error ) != 1 )
+	if( header_size > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE - 1 ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
-		 LIBCERROR_CONVERSION_ERROR_GENERIC,
-		 "%s: unable to determine header string size.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid header size value exceeds maximum.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	header_string = (uint8_t *) memory_allocate(
-	                             sizeof( uint8_t ) * header_string_size );
-
-	if( header_string == NULL )
+	/* All supported codepages map the 7-bit characters onto the same
+	 * Unicode characters, hence the codepage conversion is only needed
+	 * when the header contains a character outside the 7-bit range
+	 * or an end-of-string character
+	 */
+	for( header_index = 0;
+	     header_index < header_size;
+	     header_index++ )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create header string.",
-		 function );
+		if( ( header[ header_index ] == 0 )
+		 || ( header[ header_index ] >= 0x80 ) )
+		{
+			break;
+		}
+	}
+	if( header_index == header_size )
+	{
+		header_string_size = header_size + 1;
 
-		goto on_error;
+		header_string = (uint8_t *) memory_allocate(
+		                             sizeof( uint8_t ) * header_string_size );
+
+		if( header_string == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create header string.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     header_string,
+		     header,
+		     header_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy header string.",
+			 function );
+
+			goto on_error;
+		}
+		header_string[ header_size ] = 0;
 	}
-	if( libuna_utf8_string_copy_from_byte_stream(
-	     header_string,
-	     header_string_size,
-	     header,
-	     header_size,
-	     codepage,
-	     error ) != 1 )
+	else
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
-		 "%s: unable to set header string.",
-		 function );
+		if( libuna_utf8_string_size_from_byte_stream(
+		     header,
+		     header_size,
+		     codepage,
+		     &header_string_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+			 LIBCERROR_CONVERSION_ERROR_GENERIC,
+			 "%s: unable to determine header string size.",
+			 function );
 
-		goto on_error;
+			goto on_error;
+		}
+		header_string = (uint8_t *) memory_allocate(
+		                             sizeof( uint8_t ) * header_string_size );
+
+		if( header_string == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create header string.",
+			 function );
+
+			goto on_error;
+		}
+		if( libuna_utf8_string_copy_from_byte_stream(
+		     header_string,
+		     header_string_size,
+		     header,
+		     header_size,
+		     codepage,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to set header string.",
+			 function );
+
+			goto on_error;
+		}
 	}
 	if( libewf_header_values_parse_utf8_header_string(
 	     header_values,
@@ -2981,6 +2925,52 @@ int libewf_header_values_generate_utf8_header_string(
 
 		goto on_error;
 	}
+	/* Date values that could not be converted are generated
+	 */
+	if( acquiry_date_header_value != NULL )
+	{
+		result = libewf_header_values_convert_date_value(
+		          acquiry_date_header_value,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+			 LIBCERROR_CONVERSION_ERROR_GENERIC,
+			 "%s: unable to convert date header value: acquiry_date.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			acquiry_date_header_value = NULL;
+		}
+	}
+	if( system_date_header_value != NULL )
+	{
+		result = libewf_header_values_convert_date_value(
+		          system_date_header_value,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+			 LIBCERROR_CONVERSION_ERROR_GENERIC,
+			 "%s: unable to convert date header value: system_date.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			system_date_header_value = NULL;
+		}
+	}
 	if( ( header_string_type == LIBEWF_HEADER_STRING_TYPE_2 )
 	 || ( header_string_type == LIBEWF_HEADER_STRING_TYPE_3 )
 	 || ( header_string_type == LIBEWF_HEADER_STRING_TYPE_4 )
@@ -7228,6 +7218,25 @@ int libewf_header_values_get_utf8_value_size(
 		 "acquiry_date",
 		 12 ) == 0 ) ) )
 	{
+		result = libewf_header_values_convert_date_value(
+		          header_value,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+			 LIBCERROR_CONVERSION_ERROR_GENERIC,
+			 "%s: unable to convert date header value.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
 		if( libfvalue_value_get_data(
 		     header_value,
 		     &header_value_data,
@@ -7416,6 +7425,25 @@ int libewf_header_values_get_utf8_value(
 		 "acquiry_date",
 		 12 ) == 0 ) ) )
 	{
+		result = libewf_header_values_convert_date_value(
+		          header_value,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+			 LIBCERROR_CONVERSION_ERROR_GENERIC,
+			 "%s: unable to convert date header value.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
 		if( libfvalue_value_get_data(
 		     header_value,
 		     &header_value_data,
@@ -7720,6 +7748,25 @@ int libewf_header_values_get_utf16_value_size(
 		 "acquiry_date",
 		 12 ) == 0 ) ) )
 	{
+		result = libewf_header_values_convert_date_value(
+		          header_value,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+			 LIBCERROR_CONVERSION_ERROR_GENERIC,
+			 "%s: unable to convert date header value.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
 		if( libfvalue_value_get_data(
 		     header_value,
 		     &header_value_data,
@@ -7908,6 +7955,25 @@ int libewf_header_values_get_utf16_value(
 		 "acquiry_date",
 		 12 ) == 0 ) ) )
 	{
+		result = libewf_header_values_convert_date_value(
+		          header_value,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+			 LIBCERROR_CONVERSION_ERROR_GENERIC,
+			 "%s: unable to convert date header value.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
 		if( libfvalue_value_get_data(
 		     header_value,
 		     &header_value_data,
@@ -140,6 +140,10 @@ int libewf_generate_date_header2_value(
      size_t *date_time_values_string_size,
      libcerror_error_t **error );
 
+int libewf_header_values_convert_date_value(
+     libfvalue_value_t *header_value,
+     libcerror_error_t **error );
+
 int libewf_header_values_copy(
      libfvalue_table_t *destination_header_values,
      libfvalue_table_t *source_header_values,
@@ -147,7 +151,7 @@ int libewf_header_values_copy(
 
 int libewf_header_values_parse_utf8_header_string(
      libfvalue_table_t *header_values,
-     const uint8_t *header_string,
+     uint8_t *header_string,
      size_t header_string_size,
      uint8_t header_section_number,
      uint8_t *format,
@@ -23,10 +23,12 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libewf_buffer_pool.h"
 #include "libewf_codepage.h"
 #include "libewf_definitions.h"
 #include "libewf_io_handle.h"
 #include "libewf_libcerror.h"
+#include "libewf_statistics.h"
 
 /* Creates an IO handle
  * Make sure the value io_handle is referencing, is set to NULL
@@ -95,8 +97,22 @@ int libewf_io_handle_initialize(
 	( *io_handle )->compression_method = LIBEWF_COMPRESSION_METHOD_DEFLATE;
 	( *io_handle )->compression_level  = LIBEWF_COMPRESSION_NONE;
 	( *io_handle )->zero_on_error      = 1;
+	( *io_handle )->verify_checksums   = 1;
 	( *io_handle )->header_codepage    = LIBEWF_CODEPAGE_ASCII;
 
+	if( libewf_statistics_initialize(
+	     &( ( *io_handle )->statistics ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create statistics.",
+		 function );
+
+		goto on_error;
+	}
 	return( 1 );
 
 on_error:
@@ -146,6 +162,19 @@ int libewf_io_handle_free(
 
 			result = -1;
 		}
+		if( libewf_statistics_free(
+		     &( ( *io_handle )->statistics ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free statistics.",
+			 function );
+
+			result = -1;
+		}
 		memory_free(
 		 *io_handle );
 
@@ -161,7 +190,10 @@ int libewf_io_handle_clear(
      libewf_io_handle_t *io_handle,
      libcerror_error_t **error )
 {
-	static char *function = "libewf_io_handle_clear";
+	libewf_statistics_t *statistics = NULL;
+	static char *function           = "libewf_io_handle_clear";
+	uint8_t use_huge_pages          = 0;
+	int result                      = 1;
 
 	if( io_handle == NULL )
 	{
@@ -174,6 +206,26 @@ int libewf_io_handle_clear(
 
 		return( -1 );
 	}
+	/* The buffer pool is freed when the last chunk data that references it is freed
+	 */
+	if( libewf_buffer_pool_release(
+	     &( io_handle->buffer_pool ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to release buffer pool.",
+		 function );
+
+		result = -1;
+	}
+	/* The statistics and the huge pages option are retained when the IO handle is cleared
+	 */
+	statistics     = io_handle->statistics;
+	use_huge_pages = io_handle->use_huge_pages;
+
 	if( memory_set(
 	     io_handle,
 	     0,
@@ -188,6 +240,8 @@ int libewf_io_handle_clear(
 
 		return( -1 );
 	}
+	io_handle->statistics         = statistics;
+	io_handle->use_huge_pages     = use_huge_pages;
 	io_handle->segment_file_type  = LIBEWF_SEGMENT_FILE_TYPE_UNDEFINED;
 	io_handle->format             = LIBEWF_FORMAT_ENCASE6;
 	io_handle->major_version      = 1;
@@ -195,9 +249,10 @@ int libewf_io_handle_clear(
 	io_handle->compression_method = LIBEWF_COMPRESSION_METHOD_DEFLATE;
 	io_handle->compression_level  = LIBEWF_COMPRESSION_NONE;
 	io_handle->zero_on_error      = 1;
+	io_handle->verify_checksums   = 1;
 	io_handle->header_codepage    = LIBEWF_CODEPAGE_ASCII;
 
-	return( 1 );
+	return( result );
 }
 
 /* Clones the IO handle
@@ -267,7 +322,26 @@ int libewf_io_handle_clone(
 		goto on_error;
 	}
 	( *destination_io_handle )->zero_on_error = source_io_handle->zero_on_error;
+	( *destination_io_handle )->segment_index      = NULL;
+	( *destination_io_handle )->disk_chunk_cache   = NULL;
+	( *destination_io_handle )->shared_chunk_cache = NULL;
+	( *destination_io_handle )->statistics         = NULL;
+	( *destination_io_handle )->single_files       = NULL;
+	( *destination_io_handle )->buffer_pool        = NULL;
+
+	if( libewf_statistics_initialize(
+	     &( ( *destination_io_handle )->statistics ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination statistics.",
+		 function );
 
+		goto on_error;
+	}
 	return( 1 );
 
 on_error:
@@ -281,3 +355,93 @@ on_error:
 	return( -1 );
 }
 
+/* Creates the buffer pool of the chunk data buffers for the current chunk size
+ * A previous buffer pool is released
+ * If huge pages are used the buffers are preallocated in a region backed by huge pages
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_io_handle_initialize_buffer_pool(
+     libewf_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function         = "libewf_io_handle_initialize_buffer_pool";
+	size_t buffer_size            = 0;
+	int maximum_number_of_buffers = 0;
+	uint8_t buffer_pool_flags     = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( io_handle->chunk_size == 0 )
+	 || ( io_handle->chunk_size > (size32_t) ( INT32_MAX - 16 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid IO handle - chunk size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_buffer_pool_release(
+	     &( io_handle->buffer_pool ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to release buffer pool.",
+		 function );
+
+		return( -1 );
+	}
+	/* The buffer size must match the allocated data size of the chunk data
+	 * that reserves 4 bytes for the checksum and is rounded to the next 16-byte increment
+	 */
+	buffer_size = (size_t) io_handle->chunk_size + 4;
+
+	if( ( buffer_size % 16 ) != 0 )
+	{
+		buffer_size += 16;
+	}
+	buffer_size = ( buffer_size / 16 ) * 16;
+
+	maximum_number_of_buffers = (int) ( LIBEWF_BUFFER_POOL_MAXIMUM_SIZE / buffer_size );
+
+	if( maximum_number_of_buffers < 1 )
+	{
+		maximum_number_of_buffers = 1;
+	}
+	if( io_handle->use_huge_pages != 0 )
+	{
+		buffer_pool_flags = LIBEWF_BUFFER_POOL_FLAG_PREALLOCATE | LIBEWF_BUFFER_POOL_FLAG_USE_HUGE_PAGES;
+	}
+	if( libewf_buffer_pool_initialize(
+	     &( io_handle->buffer_pool ),
+	     buffer_size,
+	     maximum_number_of_buffers,
+	     buffer_pool_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create buffer pool.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
@@ -25,7 +25,13 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_buffer_pool.h"
+#include "libewf_disk_chunk_cache.h"
 #include "libewf_libcerror.h"
+#include "libewf_segment_index.h"
+#include "libewf_shared_chunk_cache.h"
+#include "libewf_single_files.h"
+#include "libewf_statistics.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -67,6 +73,25 @@ struct libewf_io_handle
 	 */
 	uint8_t compression_flags;
 
+	/* The decompression backend
+	 */
+	int decompression_backend;
+
+	/* The batch decompression function
+	 */
+	int (*batch_decompression_function)(
+	       int number_of_chunks,
+	       const uint8_t **compressed_data,
+	       const size_t *compressed_data_sizes,
+	       uint8_t **data,
+	       size_t *data_sizes,
+	       void *function_data,
+	       libcerror_error_t **error );
+
+	/* The batch decompression function data
+	 */
+	void *batch_decompression_function_data;
+
 	/* Value to indicate the data and some metadata is encrypted
 	 */
 	uint8_t is_encrypted;
@@ -79,10 +104,51 @@ struct libewf_io_handle
 	 */
 	uint8_t zero_on_error;
 
+	/* A value to indicate if the chunk data checksums should be verified on read
+	 */
+	uint8_t verify_checksums;
+
+	/* The segment index
+	 * The segment index is owned by the handle and is only set for read-only access
+	 */
+	libewf_segment_index_t *segment_index;
+
+	/* The disk chunk cache
+	 * The disk chunk cache is owned by the handle and is only set for read-only access
+	 */
+	libewf_disk_chunk_cache_t *disk_chunk_cache;
+
+	/* The shared chunk cache
+	 * The shared chunk cache is owned by the handle and is only set for read-only access
+	 */
+	libewf_shared_chunk_cache_t *shared_chunk_cache;
+
 	/* The header codepage
 	 */
 	int header_codepage;
 
+	/* The statistics
+	 */
+	libewf_statistics_t *statistics;
+
+	/* The single files
+	 * The single files are owned by the handle and are only set for write access
+	 */
+	libewf_single_files_t *single_files;
+
+	/* The buffer pool of the chunk data buffers
+	 */
+	libewf_buffer_pool_t *buffer_pool;
+
+	/* Value to indicate the buffers of the buffer pool should be backed by huge pages
+	 */
+	uint8_t use_huge_pages;
+
+	/* The size of the sub-blocks EWF2 chunks are deflated in
+	 * 0 represents chunks are not deflated in sub-blocks
+	 */
+	size32_t sub_block_size;
+
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
@@ -105,6 +171,10 @@ int libewf_io_handle_clone(
      libewf_io_handle_t *source_io_handle,
      libcerror_error_t **error );
 
+int libewf_io_handle_initialize_buffer_pool(
+     libewf_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -383,6 +383,8 @@ on_error:
 }
 
 /* Writes a version 1 ltree section or version 2 singles files data section
+ * The ltree integrity hash is optional and contains the MD5 of the ltree data
+ * if it was calculated while the ltree data was generated
  * Returns the number of bytes written or -1 on error
  */
 ssize_t libewf_section_ltree_write(
@@ -396,6 +398,7 @@ ssize_t libewf_section_ltree_write(
          size_t section_data_size,
          uint8_t *ltree_data,
          size_t ltree_data_size,
+         const uint8_t *ltree_integrity_hash,
          libcerror_error_t **error )
 {
 	static char *function               = "libewf_section_ltree_write";
@@ -587,12 +590,29 @@ ssize_t libewf_section_ltree_write(
 
 			return( -1 );
 		}
-		if( libhmac_md5_calculate(
-		     ltree_data,
-		     ltree_data_size,
-		     ( (ewf_ltree_header_t *) section_data )->integrity_hash,
-		     16,
-		     error ) != 1 )
+		if( ltree_integrity_hash != NULL )
+		{
+			if( memory_copy(
+			     ( (ewf_ltree_header_t *) section_data )->integrity_hash,
+			     ltree_integrity_hash,
+			     16 ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy integrity hash.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( libhmac_md5_calculate(
+		          ltree_data,
+		          ltree_data_size,
+		          ( (ewf_ltree_header_t *) section_data )->integrity_hash,
+		          16,
+		          error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
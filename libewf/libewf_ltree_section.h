@@ -57,6 +57,7 @@ ssize_t libewf_section_ltree_write(
          size_t section_data_size,
          uint8_t *ltree_data,
          size_t ltree_data_size,
+         const uint8_t *ltree_integrity_hash,
          libcerror_error_t **error );
 
 #if defined( __cplusplus )
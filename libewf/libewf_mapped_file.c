@@ -0,0 +1,1173 @@
+/*
+ * Memory mapped file IO handle functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_SYS_MMAN_H )
+#include <sys/mman.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "libewf_definitions.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_mapped_file.h"
+#include "libewf_unused.h"
+
+/* Creates a mapped file IO handle
+ * Make sure the value io_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_mapped_file_io_handle_initialize(
+     libewf_mapped_file_io_handle_t **io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_mapped_file_io_handle_initialize";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid IO handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*io_handle = memory_allocate_structure(
+	              libewf_mapped_file_io_handle_t );
+
+	if( *io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *io_handle,
+	     0,
+	     sizeof( libewf_mapped_file_io_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	( *io_handle )->access_advice = LIBEWF_MAPPED_FILE_ACCESS_ADVICE_NORMAL;
+
+	return( 1 );
+
+on_error:
+	if( *io_handle != NULL )
+	{
+		memory_free(
+		 *io_handle );
+
+		*io_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a mapped file IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_mapped_file_io_handle_free(
+     libewf_mapped_file_io_handle_t **io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_mapped_file_io_handle_free";
+	int result            = 1;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *io_handle != NULL )
+	{
+		if( ( *io_handle )->is_open != 0 )
+		{
+			if( libewf_mapped_file_io_handle_close(
+			     *io_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *io_handle )->name != NULL )
+		{
+			memory_free(
+			 ( *io_handle )->name );
+		}
+		memory_free(
+		 *io_handle );
+
+		*io_handle = NULL;
+	}
+	return( result );
+}
+
+/* Clones (duplicates) the mapped file IO handle
+ * The clone is not opened and does not share the mapping
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_mapped_file_io_handle_clone(
+     libewf_mapped_file_io_handle_t **destination_io_handle,
+     libewf_mapped_file_io_handle_t *source_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_mapped_file_io_handle_clone";
+
+	if( destination_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: destination IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_io_handle == NULL )
+	{
+		*destination_io_handle = NULL;
+
+		return( 1 );
+	}
+	if( libewf_mapped_file_io_handle_initialize(
+	     destination_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( source_io_handle->name != NULL )
+	{
+		if( libewf_mapped_file_io_handle_set_name(
+		     *destination_io_handle,
+		     source_io_handle->name,
+		     source_io_handle->name_size - 1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set name in IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( *destination_io_handle != NULL )
+	{
+		libewf_mapped_file_io_handle_free(
+		 destination_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Sets the name
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_mapped_file_io_handle_set_name(
+     libewf_mapped_file_io_handle_t *io_handle,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_mapped_file_io_handle_set_name";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->is_open != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid IO handle - already open.",
+		 function );
+
+		return( -1 );
+	}
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( name_length == 0 )
+	 || ( name_length > (size_t) ( SSIZE_MAX - 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid name length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->name != NULL )
+	{
+		memory_free(
+		 io_handle->name );
+
+		io_handle->name      = NULL;
+		io_handle->name_size = 0;
+	}
+	io_handle->name = narrow_string_allocate(
+	                   name_length + 1 );
+
+	if( io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create name.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     io_handle->name,
+	     name,
+	     name_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy name.",
+		 function );
+
+		memory_free(
+		 io_handle->name );
+
+		io_handle->name = NULL;
+
+		return( -1 );
+	}
+	io_handle->name[ name_length ] = 0;
+	io_handle->name_size           = name_length + 1;
+
+	return( 1 );
+}
+
+/* Opens the mapped file IO handle
+ * Only read access is supported
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_mapped_file_io_handle_open(
+     libewf_mapped_file_io_handle_t *io_handle,
+     int access_flags,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBEWF_MAPPED_FILE_SUPPORT )
+	struct stat file_statistics;
+
+	void *data            = NULL;
+	int file_descriptor   = -1;
+#endif
+	static char *function = "libewf_mapped_file_io_handle_open";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->is_open != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid IO handle - already open.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( access_flags & LIBBFIO_ACCESS_FLAG_READ ) == 0 )
+	 || ( ( access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access flags.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MAPPED_FILE_SUPPORT )
+	file_descriptor = open(
+	                   io_handle->name,
+	                   O_RDONLY );
+
+	if( file_descriptor == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to open file: %s.",
+		 function,
+		 io_handle->name );
+
+		goto on_error;
+	}
+	if( fstat(
+	     file_descriptor,
+	     &file_statistics ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 errno,
+		 "%s: unable to retrieve file statistics.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( file_statistics.st_size < 0 )
+	 || ( (uint64_t) file_statistics.st_size > (uint64_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	/* An empty file cannot be mapped
+	 */
+	if( file_statistics.st_size > 0 )
+	{
+		data = mmap(
+		        NULL,
+		        (size_t) file_statistics.st_size,
+		        PROT_READ,
+		        MAP_PRIVATE,
+		        file_descriptor,
+		        0 );
+
+		if( data == MAP_FAILED )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 errno,
+			 "%s: unable to map file: %s.",
+			 function,
+			 io_handle->name );
+
+			goto on_error;
+		}
+	}
+	/* The mapping remains valid after the file descriptor is closed
+	 */
+	if( close(
+	     file_descriptor ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 errno,
+		 "%s: unable to close file: %s.",
+		 function,
+		 io_handle->name );
+
+		file_descriptor = -1;
+
+		goto on_error;
+	}
+	io_handle->data                       = (uint8_t *) data;
+	io_handle->data_size                  = (size64_t) file_statistics.st_size;
+	io_handle->current_offset             = 0;
+	io_handle->last_read_end_offset       = 0;
+	io_handle->number_of_sequential_reads = 0;
+	io_handle->number_of_random_reads     = 0;
+	io_handle->access_advice              = LIBEWF_MAPPED_FILE_ACCESS_ADVICE_NORMAL;
+	io_handle->access_flags               = access_flags;
+	io_handle->is_open                    = 1;
+
+	return( 1 );
+
+on_error:
+	if( ( data != NULL )
+	 && ( data != MAP_FAILED ) )
+	{
+		munmap(
+		 data,
+		 (size_t) file_statistics.st_size );
+	}
+	if( file_descriptor != -1 )
+	{
+		close(
+		 file_descriptor );
+	}
+	return( -1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: memory mapped files are not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( HAVE_LIBEWF_MAPPED_FILE_SUPPORT ) */
+}
+
+/* Closes the mapped file IO handle
+ * Returns 0 if successful or -1 on error
+ */
+int libewf_mapped_file_io_handle_close(
+     libewf_mapped_file_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_mapped_file_io_handle_close";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->is_open == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - not open.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MAPPED_FILE_SUPPORT )
+	if( io_handle->data != NULL )
+	{
+		if( munmap(
+		     io_handle->data,
+		     (size_t) io_handle->data_size ) != 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 errno,
+			 "%s: unable to unmap file: %s.",
+			 function,
+			 io_handle->name );
+
+			return( -1 );
+		}
+	}
+#endif
+	io_handle->data           = NULL;
+	io_handle->data_size      = 0;
+	io_handle->current_offset = 0;
+	io_handle->access_flags   = 0;
+	io_handle->is_open        = 0;
+
+	return( 0 );
+}
+
+/* Sets the access pattern advice of the mapping
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_mapped_file_io_handle_set_access_advice(
+     libewf_mapped_file_io_handle_t *io_handle,
+     int access_advice,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_mapped_file_io_handle_set_access_advice";
+
+#if defined( HAVE_LIBEWF_MAPPED_FILE_SUPPORT ) && defined( HAVE_MADVISE )
+	int advice            = 0;
+#endif
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( access_advice != LIBEWF_MAPPED_FILE_ACCESS_ADVICE_NORMAL )
+	 && ( access_advice != LIBEWF_MAPPED_FILE_ACCESS_ADVICE_SEQUENTIAL )
+	 && ( access_advice != LIBEWF_MAPPED_FILE_ACCESS_ADVICE_RANDOM ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access advice.",
+		 function );
+
+		return( -1 );
+	}
+	if( access_advice == io_handle->access_advice )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_LIBEWF_MAPPED_FILE_SUPPORT ) && defined( HAVE_MADVISE )
+	if( io_handle->data != NULL )
+	{
+		switch( access_advice )
+		{
+			case LIBEWF_MAPPED_FILE_ACCESS_ADVICE_SEQUENTIAL:
+				advice = MADV_SEQUENTIAL;
+				break;
+
+			case LIBEWF_MAPPED_FILE_ACCESS_ADVICE_RANDOM:
+				advice = MADV_RANDOM;
+				break;
+
+			default:
+				advice = MADV_NORMAL;
+				break;
+		}
+		/* The advice is only a hint hence a failure is not considered an error
+		 */
+		madvise(
+		 (void *) io_handle->data,
+		 (size_t) io_handle->data_size,
+		 advice );
+	}
+#endif
+	io_handle->access_advice = access_advice;
+
+	return( 1 );
+}
+
+/* Reads a buffer from the mapped file IO handle
+ * The access pattern advice is updated based on the offsets of consecutive reads
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t libewf_mapped_file_io_handle_read_buffer(
+         libewf_mapped_file_io_handle_t *io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_mapped_file_io_handle_read_buffer";
+	size64_t read_size    = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->is_open == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( io_handle->current_offset < 0 )
+	 || ( (size64_t) io_handle->current_offset >= io_handle->data_size ) )
+	{
+		return( 0 );
+	}
+	read_size = io_handle->data_size - (size64_t) io_handle->current_offset;
+
+	if( read_size > (size64_t) size )
+	{
+		read_size = (size64_t) size;
+	}
+	if( io_handle->current_offset == io_handle->last_read_end_offset )
+	{
+		io_handle->number_of_sequential_reads += 1;
+		io_handle->number_of_random_reads      = 0;
+
+		if( io_handle->number_of_sequential_reads >= LIBEWF_MAPPED_FILE_ACCESS_PATTERN_THRESHOLD )
+		{
+			if( libewf_mapped_file_io_handle_set_access_advice(
+			     io_handle,
+			     LIBEWF_MAPPED_FILE_ACCESS_ADVICE_SEQUENTIAL,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set access advice.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	else
+	{
+		io_handle->number_of_sequential_reads = 0;
+		io_handle->number_of_random_reads    += 1;
+
+		if( io_handle->number_of_random_reads >= LIBEWF_MAPPED_FILE_ACCESS_PATTERN_THRESHOLD )
+		{
+			if( libewf_mapped_file_io_handle_set_access_advice(
+			     io_handle,
+			     LIBEWF_MAPPED_FILE_ACCESS_ADVICE_RANDOM,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set access advice.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	if( memory_copy(
+	     buffer,
+	     &( io_handle->data[ io_handle->current_offset ] ),
+	     (size_t) read_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy data.",
+		 function );
+
+		return( -1 );
+	}
+	io_handle->current_offset      += (off64_t) read_size;
+	io_handle->last_read_end_offset = io_handle->current_offset;
+
+	return( (ssize_t) read_size );
+}
+
+/* Writes a buffer to the mapped file IO handle
+ * Write access is not supported
+ * Returns -1 on error
+ */
+ssize_t libewf_mapped_file_io_handle_write_buffer(
+         libewf_mapped_file_io_handle_t *io_handle,
+         const uint8_t *buffer LIBEWF_ATTRIBUTE_UNUSED,
+         size_t size LIBEWF_ATTRIBUTE_UNUSED,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_mapped_file_io_handle_write_buffer";
+
+	LIBEWF_UNREFERENCED_PARAMETER( buffer )
+	LIBEWF_UNREFERENCED_PARAMETER( size )
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_IO,
+	 LIBCERROR_IO_ERROR_WRITE_FAILED,
+	 "%s: write access not supported.",
+	 function );
+
+	return( -1 );
+}
+
+/* Seeks a certain offset within the mapped file IO handle
+ * Returns the offset if the seek is successful or -1 on error
+ */
+off64_t libewf_mapped_file_io_handle_seek_offset(
+         libewf_mapped_file_io_handle_t *io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_mapped_file_io_handle_seek_offset";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->is_open == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{
+		offset += io_handle->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{
+		offset += (off64_t) io_handle->data_size;
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		return( -1 );
+	}
+	io_handle->current_offset = offset;
+
+	return( offset );
+}
+
+/* Function to determine if a file exists
+ * Returns 1 if file exists, 0 if not or -1 on error
+ */
+int libewf_mapped_file_io_handle_exists(
+     libewf_mapped_file_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBEWF_MAPPED_FILE_SUPPORT )
+	struct stat file_statistics;
+#endif
+	static char *function = "libewf_mapped_file_io_handle_exists";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MAPPED_FILE_SUPPORT )
+	if( stat(
+	     io_handle->name,
+	     &file_statistics ) != 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+#else
+	return( 0 );
+#endif
+}
+
+/* Check if the mapped file IO handle is open
+ * Returns 1 if open, 0 if not or -1 on error
+ */
+int libewf_mapped_file_io_handle_is_open(
+     libewf_mapped_file_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_mapped_file_io_handle_is_open";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->is_open == 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the size of the mapped file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_mapped_file_io_handle_get_size(
+     libewf_mapped_file_io_handle_t *io_handle,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_mapped_file_io_handle_get_size";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->is_open == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	*size = io_handle->data_size;
+
+	return( 1 );
+}
+
+/* Creates a memory mapped file handle
+ * Make sure the value handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_mapped_file_initialize(
+     libbfio_handle_t **handle,
+     libcerror_error_t **error )
+{
+	libewf_mapped_file_io_handle_t *io_handle = NULL;
+	static char *function                     = "libewf_mapped_file_initialize";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_mapped_file_io_handle_initialize(
+	     &io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mapped file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_initialize(
+	     handle,
+	     (intptr_t *) io_handle,
+	     (int (*)(intptr_t **, libcerror_error_t **)) libewf_mapped_file_io_handle_free,
+	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) libewf_mapped_file_io_handle_clone,
+	     (int (*)(intptr_t *, int, libcerror_error_t **)) libewf_mapped_file_io_handle_open,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libewf_mapped_file_io_handle_close,
+	     (ssize_t (*)(intptr_t *, uint8_t *, size_t, libcerror_error_t **)) libewf_mapped_file_io_handle_read_buffer,
+	     (ssize_t (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) libewf_mapped_file_io_handle_write_buffer,
+	     (off64_t (*)(intptr_t *, off64_t, int, libcerror_error_t **)) libewf_mapped_file_io_handle_seek_offset,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libewf_mapped_file_io_handle_exists,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libewf_mapped_file_io_handle_is_open,
+	     (int (*)(intptr_t *, size64_t *, libcerror_error_t **)) libewf_mapped_file_io_handle_get_size,
+	     LIBBFIO_FLAG_IO_HANDLE_MANAGED | LIBBFIO_FLAG_IO_HANDLE_CLONE_BY_FUNCTION,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( io_handle != NULL )
+	{
+		libewf_mapped_file_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Sets the name of the memory mapped file handle
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_mapped_file_set_name(
+     libbfio_handle_t *handle,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error )
+{
+	libewf_mapped_file_io_handle_t *io_handle = NULL;
+	static char *function                     = "libewf_mapped_file_set_name";
+
+	if( libbfio_handle_get_io_handle(
+	     handle,
+	     (intptr_t **) &io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve mapped file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_mapped_file_io_handle_set_name(
+	     io_handle,
+	     name,
+	     name_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name in mapped file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,169 @@
+/*
+ * Memory mapped file IO handle functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_MAPPED_FILE_H )
+#define _LIBEWF_MAPPED_FILE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_SYS_MMAN_H ) && defined( HAVE_MMAP ) && defined( HAVE_MUNMAP ) && !defined( WINAPI )
+#define HAVE_LIBEWF_MAPPED_FILE_SUPPORT
+#endif
+
+typedef struct libewf_mapped_file_io_handle libewf_mapped_file_io_handle_t;
+
+/* The mapped file IO handle reads a file through a read-only memory mapping
+ */
+struct libewf_mapped_file_io_handle
+{
+	/* The name
+	 */
+	char *name;
+
+	/* The name size
+	 */
+	size_t name_size;
+
+	/* The mapped data
+	 */
+	uint8_t *data;
+
+	/* The mapped data size
+	 */
+	size64_t data_size;
+
+	/* The current offset
+	 */
+	off64_t current_offset;
+
+	/* The offset of the end of the last read
+	 */
+	off64_t last_read_end_offset;
+
+	/* The number of consecutive reads that followed the previous read
+	 */
+	int number_of_sequential_reads;
+
+	/* The number of consecutive reads that did not follow the previous read
+	 */
+	int number_of_random_reads;
+
+	/* The current access pattern advice
+	 */
+	int access_advice;
+
+	/* The access flags
+	 */
+	int access_flags;
+
+	/* Value to indicate the file is open
+	 */
+	uint8_t is_open;
+};
+
+int libewf_mapped_file_io_handle_initialize(
+     libewf_mapped_file_io_handle_t **io_handle,
+     libcerror_error_t **error );
+
+int libewf_mapped_file_io_handle_free(
+     libewf_mapped_file_io_handle_t **io_handle,
+     libcerror_error_t **error );
+
+int libewf_mapped_file_io_handle_clone(
+     libewf_mapped_file_io_handle_t **destination_io_handle,
+     libewf_mapped_file_io_handle_t *source_io_handle,
+     libcerror_error_t **error );
+
+int libewf_mapped_file_io_handle_set_name(
+     libewf_mapped_file_io_handle_t *io_handle,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error );
+
+int libewf_mapped_file_io_handle_open(
+     libewf_mapped_file_io_handle_t *io_handle,
+     int access_flags,
+     libcerror_error_t **error );
+
+int libewf_mapped_file_io_handle_close(
+     libewf_mapped_file_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
+int libewf_mapped_file_io_handle_set_access_advice(
+     libewf_mapped_file_io_handle_t *io_handle,
+     int access_advice,
+     libcerror_error_t **error );
+
+ssize_t libewf_mapped_file_io_handle_read_buffer(
+         libewf_mapped_file_io_handle_t *io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+ssize_t libewf_mapped_file_io_handle_write_buffer(
+         libewf_mapped_file_io_handle_t *io_handle,
+         const uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+off64_t libewf_mapped_file_io_handle_seek_offset(
+         libewf_mapped_file_io_handle_t *io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error );
+
+int libewf_mapped_file_io_handle_exists(
+     libewf_mapped_file_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
+int libewf_mapped_file_io_handle_is_open(
+     libewf_mapped_file_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
+int libewf_mapped_file_io_handle_get_size(
+     libewf_mapped_file_io_handle_t *io_handle,
+     size64_t *size,
+     libcerror_error_t **error );
+
+int libewf_mapped_file_initialize(
+     libbfio_handle_t **handle,
+     libcerror_error_t **error );
+
+int libewf_mapped_file_set_name(
+     libbfio_handle_t *handle,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_MAPPED_FILE_H ) */
+
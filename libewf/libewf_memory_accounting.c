@@ -0,0 +1,211 @@
+/*
+ * Memory accounting functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#if defined( WINAPI )
+#include <windows.h>
+#endif
+
+#include "libewf_libcerror.h"
+#include "libewf_memory_accounting.h"
+
+#if defined( HAVE_LIBEWF_MEMORY_ACCOUNTING )
+
+/* The sizes are updated with atomic operations, such that accounting does not
+ * require a lock. Without atomic operations the sizes are updated non-atomically
+ * and can be inaccurate when multiple threads allocate concurrently.
+ */
+#if defined( WINAPI )
+
+#define libewf_memory_accounting_add( value, addend ) \
+	( InterlockedExchangeAdd64( value, addend ) + ( addend ) )
+
+#define libewf_memory_accounting_compare_and_swap( value, expected_value, new_value ) \
+	( InterlockedCompareExchange64( value, new_value, expected_value ) == ( expected_value ) )
+
+#define libewf_memory_accounting_load( value ) \
+	InterlockedCompareExchange64( value, 0, 0 )
+
+#elif defined( __GNUC__ )
+
+#define libewf_memory_accounting_add( value, addend ) \
+	__atomic_add_fetch( value, addend, __ATOMIC_RELAXED )
+
+#define libewf_memory_accounting_compare_and_swap( value, expected_value, new_value ) \
+	__sync_bool_compare_and_swap( value, expected_value, new_value )
+
+#define libewf_memory_accounting_load( value ) \
+	__atomic_load_n( value, __ATOMIC_RELAXED )
+
+#else
+
+#define libewf_memory_accounting_add( value, addend ) \
+	( *( value ) += ( addend ) )
+
+#define libewf_memory_accounting_compare_and_swap( value, expected_value, new_value ) \
+	( ( *( value ) = ( new_value ) ), 1 )
+
+#define libewf_memory_accounting_load( value ) \
+	*( value )
+
+#endif
+
+/* The current sizes per memory type
+ */
+static volatile int64_t libewf_memory_accounting_sizes[ LIBEWF_NUMBER_OF_MEMORY_TYPES ] = {
+	0, 0, 0, 0, 0 };
+
+/* The peak sizes per memory type
+ */
+static volatile int64_t libewf_memory_accounting_peak_sizes[ LIBEWF_NUMBER_OF_MEMORY_TYPES ] = {
+	0, 0, 0, 0, 0 };
+
+/* Updates the size accounted by an object
+ * The accounted size is set to the size
+ */
+void libewf_memory_accounting_update(
+      int memory_type,
+      size_t *accounted_size,
+      size_t size )
+{
+	int64_t current_size = 0;
+	int64_t peak_size    = 0;
+
+	if( ( memory_type < 0 )
+	 || ( memory_type >= LIBEWF_NUMBER_OF_MEMORY_TYPES )
+	 || ( accounted_size == NULL )
+	 || ( *accounted_size == size ) )
+	{
+		return;
+	}
+	current_size = libewf_memory_accounting_add(
+	                &( libewf_memory_accounting_sizes[ memory_type ] ),
+	                (int64_t) size - (int64_t) *accounted_size );
+
+	*accounted_size = size;
+
+	peak_size = libewf_memory_accounting_load(
+	             &( libewf_memory_accounting_peak_sizes[ memory_type ] ) );
+
+	while( current_size > peak_size )
+	{
+		if( libewf_memory_accounting_compare_and_swap(
+		     &( libewf_memory_accounting_peak_sizes[ memory_type ] ),
+		     peak_size,
+		     current_size ) )
+		{
+			break;
+		}
+		peak_size = libewf_memory_accounting_load(
+		             &( libewf_memory_accounting_peak_sizes[ memory_type ] ) );
+	}
+}
+
+#endif /* defined( HAVE_LIBEWF_MEMORY_ACCOUNTING ) */
+
+/* Retrieves the current and peak size of the memory accounted for a memory type
+ * The sizes are 0 if memory accounting is not enabled
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_memory_accounting_get_size(
+     int memory_type,
+     uint64_t *size,
+     uint64_t *peak_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_memory_accounting_get_size";
+
+#if defined( HAVE_LIBEWF_MEMORY_ACCOUNTING )
+	int64_t safe_size     = 0;
+#endif
+
+	if( ( memory_type < 0 )
+	 || ( memory_type >= LIBEWF_NUMBER_OF_MEMORY_TYPES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported memory type: %d.",
+		 function,
+		 memory_type );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	if( peak_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid peak size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MEMORY_ACCOUNTING )
+	safe_size = libewf_memory_accounting_load(
+	             &( libewf_memory_accounting_sizes[ memory_type ] ) );
+
+	*size = ( safe_size > 0 ) ? (uint64_t) safe_size : 0;
+
+	safe_size = libewf_memory_accounting_load(
+	             &( libewf_memory_accounting_peak_sizes[ memory_type ] ) );
+
+	*peak_size = ( safe_size > 0 ) ? (uint64_t) safe_size : 0;
+#else
+	*size      = 0;
+	*peak_size = 0;
+#endif
+	return( 1 );
+}
+
+/* Resets the peak sizes to the current sizes
+ */
+void libewf_memory_accounting_reset_peak_sizes(
+      void )
+{
+#if defined( HAVE_LIBEWF_MEMORY_ACCOUNTING )
+	int memory_type = 0;
+
+	for( memory_type = 0;
+	     memory_type < LIBEWF_NUMBER_OF_MEMORY_TYPES;
+	     memory_type++ )
+	{
+		libewf_memory_accounting_peak_sizes[ memory_type ] = libewf_memory_accounting_load(
+		                                                      &( libewf_memory_accounting_sizes[ memory_type ] ) );
+	}
+#endif
+}
+
@@ -0,0 +1,93 @@
+/*
+ * Memory accounting functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_MEMORY_ACCOUNTING_H )
+#define _LIBEWF_MEMORY_ACCOUNTING_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The subsystems of which the allocated memory is accounted
+ */
+enum LIBEWF_MEMORY_TYPES
+{
+	LIBEWF_MEMORY_TYPE_CHUNK_DATA		= 0,
+	LIBEWF_MEMORY_TYPE_CHUNK_GROUP		= 1,
+	LIBEWF_MEMORY_TYPE_SEGMENT_FILE		= 2,
+	LIBEWF_MEMORY_TYPE_SINGLE_FILES		= 3,
+	LIBEWF_MEMORY_TYPE_HEADER_VALUES	= 4
+};
+
+#define LIBEWF_NUMBER_OF_MEMORY_TYPES		5
+
+/* The estimated size of an element of a libfdata list, which is allocated by libfdata
+ */
+#define LIBEWF_MEMORY_ACCOUNTING_LIST_ELEMENT_SIZE	128
+
+/* The memory is accounted per object, every accounted object keeps the size it accounted
+ * in its accounted_memory_size value, such that the size can be updated when the object
+ * grows or shrinks and removed when the object is freed. The sizes are process wide.
+ *
+ * The memory is only accounted when built with --enable-memory-accounting or when
+ * HAVE_LIBEWF_MEMORY_ACCOUNTING is defined. Otherwise the macros are compiled out.
+ */
+#if defined( HAVE_LIBEWF_MEMORY_ACCOUNTING )
+
+#define LIBEWF_MEMORY_ACCOUNTING_UPDATE( memory_type, object, size ) \
+	libewf_memory_accounting_update( memory_type, &( ( object )->accounted_memory_size ), (size_t) ( size ) )
+
+#else
+
+#define LIBEWF_MEMORY_ACCOUNTING_UPDATE( memory_type, object, size ) \
+	do { } while( 0 )
+
+#endif
+
+#if defined( HAVE_LIBEWF_MEMORY_ACCOUNTING )
+
+void libewf_memory_accounting_update(
+      int memory_type,
+      size_t *accounted_size,
+      size_t size );
+
+#endif
+
+int libewf_memory_accounting_get_size(
+     int memory_type,
+     uint64_t *size,
+     uint64_t *peak_size,
+     libcerror_error_t **error );
+
+void libewf_memory_accounting_reset_peak_sizes(
+      void );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_MEMORY_ACCOUNTING_H ) */
+
@@ -0,0 +1,2320 @@
+/*
+ * Parallel deflate compression functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <byte_stream.h>
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+#include <zlib.h>
+#endif
+
+#include "libewf_checksum.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+#include "libewf_parallel_deflate.h"
+
+/* The signature of the sub-block index
+ */
+static const uint8_t libewf_parallel_deflate_sub_block_index_signature[ 4 ] = {
+	's', 'b', 'i', 'x' };
+
+/* Reads the footer of a sub-block index
+ * The footer data contains the last bytes of the compressed data of a chunk
+ * that is flagged to contain a sub-block index, the signature is only used
+ * to validate the footer
+ * Returns 1 if successful, 0 if the footer is not valid or -1 on error
+ */
+int libewf_parallel_deflate_sub_block_index_read_footer(
+     libewf_parallel_deflate_sub_block_index_t *sub_block_index,
+     const uint8_t *footer_data,
+     size_t footer_data_size,
+     size_t compressed_data_size,
+     libcerror_error_t **error )
+{
+	static char *function         = "libewf_parallel_deflate_sub_block_index_read_footer";
+	size_t index_size             = 0;
+	uint32_t number_of_sub_blocks = 0;
+	uint32_t sub_block_size       = 0;
+
+	if( sub_block_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub-block index.",
+		 function );
+
+		return( -1 );
+	}
+	if( footer_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid footer data.",
+		 function );
+
+		return( -1 );
+	}
+	if( footer_data_size != LIBEWF_PARALLEL_DEFLATE_SUB_BLOCK_INDEX_FOOTER_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid footer data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_compare(
+	     &( footer_data[ 8 ] ),
+	     libewf_parallel_deflate_sub_block_index_signature,
+	     4 ) != 0 )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 &( footer_data[ 0 ] ),
+	 sub_block_size );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( footer_data[ 4 ] ),
+	 number_of_sub_blocks );
+
+	if( ( sub_block_size == 0 )
+	 || ( sub_block_size > (uint32_t) INT32_MAX )
+	 || ( number_of_sub_blocks == 0 )
+	 || ( number_of_sub_blocks > (uint32_t) ( ( SSIZE_MAX - LIBEWF_PARALLEL_DEFLATE_SUB_BLOCK_INDEX_FOOTER_SIZE ) / LIBEWF_PARALLEL_DEFLATE_SUB_BLOCK_INDEX_ENTRY_SIZE ) ) )
+	{
+		return( 0 );
+	}
+	index_size = ( (size_t) number_of_sub_blocks * LIBEWF_PARALLEL_DEFLATE_SUB_BLOCK_INDEX_ENTRY_SIZE )
+	           + LIBEWF_PARALLEL_DEFLATE_SUB_BLOCK_INDEX_FOOTER_SIZE;
+
+	/* The zlib stream consists of at least the header and the checksum
+	 */
+	if( ( compressed_data_size < 6 )
+	 || ( index_size > ( compressed_data_size - 6 ) ) )
+	{
+		return( 0 );
+	}
+	sub_block_index->zlib_stream_size     = compressed_data_size - index_size;
+	sub_block_index->sub_block_size       = (size32_t) sub_block_size;
+	sub_block_index->number_of_sub_blocks = number_of_sub_blocks;
+	sub_block_index->entries_data         = NULL;
+	sub_block_index->entries_data_size    = index_size - LIBEWF_PARALLEL_DEFLATE_SUB_BLOCK_INDEX_FOOTER_SIZE;
+
+	return( 1 );
+}
+
+/* Sets the entries data of a sub-block index
+ * The entries data is referenced by the sub-block index and must remain available
+ * Returns 1 if successful, 0 if the entries are not consistent or -1 on error
+ */
+int libewf_parallel_deflate_sub_block_index_set_entries_data(
+     libewf_parallel_deflate_sub_block_index_t *sub_block_index,
+     const uint8_t *entries_data,
+     size_t entries_data_size,
+     libcerror_error_t **error )
+{
+	static char *function            = "libewf_parallel_deflate_sub_block_index_set_entries_data";
+	size_t entries_data_offset       = 0;
+	uint32_t compressed_data_offset  = 0;
+	uint32_t previous_data_offset    = 0;
+
+	if( sub_block_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub-block index.",
+		 function );
+
+		return( -1 );
+	}
+	if( entries_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entries data.",
+		 function );
+
+		return( -1 );
+	}
+	if( entries_data_size != sub_block_index->entries_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entries data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* The compressed sub-blocks follow the 2 byte zlib header in order and
+	 * the last compressed sub-block is followed by the 4 byte checksum
+	 */
+	previous_data_offset = 1;
+
+	for( entries_data_offset = 0;
+	     entries_data_offset < entries_data_size;
+	     entries_data_offset += LIBEWF_PARALLEL_DEFLATE_SUB_BLOCK_INDEX_ENTRY_SIZE )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 &( entries_data[ entries_data_offset ] ),
+		 compressed_data_offset );
+
+		if( ( compressed_data_offset <= previous_data_offset )
+		 || ( (size_t) compressed_data_offset >= ( sub_block_index->zlib_stream_size - 4 ) ) )
+		{
+			return( 0 );
+		}
+		previous_data_offset = compressed_data_offset;
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 &( entries_data[ 0 ] ),
+	 compressed_data_offset );
+
+	if( compressed_data_offset != 2 )
+	{
+		return( 0 );
+	}
+	sub_block_index->entries_data = entries_data;
+
+	return( 1 );
+}
+
+/* Retrieves the compressed data range and checksum of a specific sub-block
+ * The compressed data offset is relative to the start of the zlib stream
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_parallel_deflate_sub_block_index_get_sub_block(
+     libewf_parallel_deflate_sub_block_index_t *sub_block_index,
+     uint32_t sub_block_number,
+     size_t *compressed_data_offset,
+     size_t *compressed_data_size,
+     uint32_t *checksum,
+     libcerror_error_t **error )
+{
+	static char *function      = "libewf_parallel_deflate_sub_block_index_get_sub_block";
+	size_t entries_data_offset = 0;
+	uint32_t end_offset        = 0;
+	uint32_t start_offset      = 0;
+
+	if( sub_block_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub-block index.",
+		 function );
+
+		return( -1 );
+	}
+	if( sub_block_index->entries_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid sub-block index - missing entries data.",
+		 function );
+
+		return( -1 );
+	}
+	if( sub_block_number >= sub_block_index->number_of_sub_blocks )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid sub-block number value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( checksum == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checksum.",
+		 function );
+
+		return( -1 );
+	}
+	entries_data_offset = (size_t) sub_block_number * LIBEWF_PARALLEL_DEFLATE_SUB_BLOCK_INDEX_ENTRY_SIZE;
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( ( sub_block_index->entries_data )[ entries_data_offset ] ),
+	 start_offset );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( ( sub_block_index->entries_data )[ entries_data_offset + 4 ] ),
+	 *checksum );
+
+	if( ( sub_block_number + 1 ) < sub_block_index->number_of_sub_blocks )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 &( ( sub_block_index->entries_data )[ entries_data_offset + LIBEWF_PARALLEL_DEFLATE_SUB_BLOCK_INDEX_ENTRY_SIZE ] ),
+		 end_offset );
+	}
+	else
+	{
+		end_offset = (uint32_t) ( sub_block_index->zlib_stream_size - 4 );
+	}
+	*compressed_data_offset = (size_t) start_offset;
+	*compressed_data_size   = (size_t) ( end_offset - start_offset );
+
+	return( 1 );
+}
+
+/* Determines the size of the zlib stream that precedes the sub-block index in compressed data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_parallel_deflate_get_zlib_stream_size(
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     size_t *zlib_stream_size,
+     libcerror_error_t **error )
+{
+	libewf_parallel_deflate_sub_block_index_t sub_block_index;
+
+	static char *function = "libewf_parallel_deflate_get_zlib_stream_size";
+	int result            = 0;
+
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( zlib_stream_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid zlib stream size.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data_size <= LIBEWF_PARALLEL_DEFLATE_SUB_BLOCK_INDEX_FOOTER_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid compressed data size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_parallel_deflate_sub_block_index_read_footer(
+	          &sub_block_index,
+	          &( compressed_data[ compressed_data_size - LIBEWF_PARALLEL_DEFLATE_SUB_BLOCK_INDEX_FOOTER_SIZE ] ),
+	          LIBEWF_PARALLEL_DEFLATE_SUB_BLOCK_INDEX_FOOTER_SIZE,
+	          compressed_data_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to read sub-block index footer.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+		 "%s: invalid sub-block index footer.",
+		 function );
+
+		return( -1 );
+	}
+	*zlib_stream_size = sub_block_index.zlib_stream_size;
+
+	return( 1 );
+}
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+
+/* Combines the Adler-32 checksums of 2 consecutive blocks of data
+ * Returns the Adler-32 checksum of the combined data
+ */
+uint32_t libewf_parallel_deflate_combine_adler32(
+          uint32_t first_checksum,
+          uint32_t second_checksum,
+          size_t second_data_size )
+{
+	uint32_t lower_word = 0;
+	uint32_t remainder  = 0;
+	uint32_t upper_word = 0;
+
+	remainder  = (uint32_t) ( second_data_size % 65521 );
+	lower_word = first_checksum & 0x0000ffffUL;
+	upper_word = ( remainder * lower_word ) % 65521;
+
+	lower_word += ( second_checksum & 0x0000ffffUL ) + 65521 - 1;
+	upper_word += ( ( first_checksum >> 16 ) & 0x0000ffffUL ) + ( ( second_checksum >> 16 ) & 0x0000ffffUL ) + 65521 - remainder;
+
+	if( lower_word >= 65521 )
+	{
+		lower_word -= 65521;
+	}
+	if( lower_word >= 65521 )
+	{
+		lower_word -= 65521;
+	}
+	if( upper_word >= ( 2 * 65521 ) )
+	{
+		upper_word -= 2 * 65521;
+	}
+	if( upper_word >= 65521 )
+	{
+		upper_word -= 65521;
+	}
+	return( ( upper_word << 16 ) | lower_word );
+}
+
+/* Determines the number of segments to compress data of a specific size in
+ * Every segment contains at least LIBEWF_PARALLEL_DEFLATE_MINIMUM_SEGMENT_SIZE bytes
+ * Returns the number of segments
+ */
+int libewf_parallel_deflate_get_number_of_segments(
+     size_t uncompressed_data_size,
+     int maximum_number_of_segments )
+{
+	size_t number_of_segments = 0;
+
+	if( maximum_number_of_segments <= 1 )
+	{
+		return( 1 );
+	}
+	number_of_segments = uncompressed_data_size / LIBEWF_PARALLEL_DEFLATE_MINIMUM_SEGMENT_SIZE;
+
+	if( number_of_segments == 0 )
+	{
+		return( 1 );
+	}
+	if( number_of_segments > (size_t) maximum_number_of_segments )
+	{
+		return( maximum_number_of_segments );
+	}
+	return( (int) number_of_segments );
+}
+
+/* Determines the zlib header of a deflate compressed zlib stream with a 32 KiB window
+ * The compression level flags are determined in the same way as by zlib
+ * Returns the zlib header
+ */
+uint16_t libewf_parallel_deflate_get_zlib_header(
+          int zlib_compression_level )
+{
+	uint16_t zlib_header            = 0;
+	uint8_t compression_level_flags = 0;
+
+	if( ( zlib_compression_level >= 0 )
+	 && ( zlib_compression_level < 2 ) )
+	{
+		compression_level_flags = 0;
+	}
+	else if( ( zlib_compression_level >= 2 )
+	      && ( zlib_compression_level < 6 ) )
+	{
+		compression_level_flags = 1;
+	}
+	else if( ( zlib_compression_level == 6 )
+	      || ( zlib_compression_level == Z_DEFAULT_COMPRESSION ) )
+	{
+		compression_level_flags = 2;
+	}
+	else
+	{
+		compression_level_flags = 3;
+	}
+	zlib_header  = (uint16_t) ( 0x7800 | ( compression_level_flags << 6 ) );
+	zlib_header += 31 - ( zlib_header % 31 );
+
+	return( zlib_header );
+}
+
+/* Compresses a segment into a sequence of raw deflate blocks
+ * The blocks of a segment that is not the last segment end with a sync flush
+ * so that the segments can be concatenated into a single deflate stream
+ * Returns 1 on success, 0 if the compressed data buffer is too small or -1 on error
+ */
+int libewf_parallel_deflate_segment_compress(
+     libewf_parallel_deflate_segment_t *segment,
+     libcerror_error_t **error )
+{
+	z_stream deflate_stream;
+
+	static char *function = "libewf_parallel_deflate_segment_compress";
+	int flush             = 0;
+	int result            = 0;
+
+	if( segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment->uncompressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment - missing uncompressed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment->uncompressed_data_size > (size_t) UINT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid segment - uncompressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment->compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment - missing compressed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment->compressed_data_size > (size_t) UINT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid segment - compressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment->dictionary_size != 0 )
+	 && ( segment->dictionary == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment - missing dictionary.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment->dictionary_size > (size_t) LIBEWF_PARALLEL_DEFLATE_DICTIONARY_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment - dictionary size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     &deflate_stream,
+	     0,
+	     sizeof( z_stream ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear deflate stream.",
+		 function );
+
+		return( -1 );
+	}
+	/* A negative window bits value creates a raw deflate stream without a zlib header and trailer
+	 */
+	result = deflateInit2(
+	          &deflate_stream,
+	          segment->zlib_compression_level,
+	          Z_DEFLATED,
+	          -15,
+	          8,
+	          Z_DEFAULT_STRATEGY );
+
+	if( result != Z_OK )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize deflate stream with error: %d.",
+		 function,
+		 result );
+
+		return( -1 );
+	}
+	/* Priming the stream with the preceding data allows matches across the segment boundary
+	 */
+	if( segment->dictionary_size > 0 )
+	{
+		result = deflateSetDictionary(
+		          &deflate_stream,
+		          (Bytef *) segment->dictionary,
+		          (uInt) segment->dictionary_size );
+
+		if( result != Z_OK )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set dictionary with error: %d.",
+			 function,
+			 result );
+
+			goto on_error;
+		}
+	}
+	if( segment->is_last_segment != 0 )
+	{
+		flush = Z_FINISH;
+	}
+	else
+	{
+		flush = Z_SYNC_FLUSH;
+	}
+	deflate_stream.next_in   = (Bytef *) segment->uncompressed_data;
+	deflate_stream.avail_in  = (uInt) segment->uncompressed_data_size;
+	deflate_stream.next_out  = (Bytef *) segment->compressed_data;
+	deflate_stream.avail_out = (uInt) segment->compressed_data_size;
+
+	result = deflate(
+	          &deflate_stream,
+	          flush );
+
+	/* A sync flush is only complete if output space remains
+	 */
+	if( ( ( flush == Z_FINISH )
+	  &&  ( result == Z_STREAM_END ) )
+	 || ( ( flush == Z_SYNC_FLUSH )
+	  &&  ( result == Z_OK )
+	  &&  ( deflate_stream.avail_in == 0 )
+	  &&  ( deflate_stream.avail_out > 0 ) ) )
+	{
+		segment->compressed_data_size = (size_t) deflate_stream.total_out;
+
+		result = 1;
+	}
+	else if( ( result == Z_OK )
+	      || ( result == Z_BUF_ERROR ) )
+	{
+		result = 0;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+		 "%s: zlib returned undefined error: %d.",
+		 function,
+		 result );
+
+		goto on_error;
+	}
+	deflateEnd(
+	 &deflate_stream );
+
+	if( result == 1 )
+	{
+		if( libewf_checksum_calculate_adler32(
+		     &( segment->checksum ),
+		     segment->uncompressed_data,
+		     segment->uncompressed_data_size,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to calculate checksum.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( result );
+
+on_error:
+	deflateEnd(
+	 &deflate_stream );
+
+	return( -1 );
+}
+
+#if defined( HAVE_ZLIB_INFLATE ) || defined( ZLIB_DLL )
+
+/* Decompresses a segment from a sequence of raw deflate blocks
+ * The blocks of a segment that is not the last segment end with a sync flush
+ * and must decompress into exactly the size of the uncompressed data
+ * Returns 1 on success, 0 if the segment could not be decompressed or -1 on error
+ */
+int libewf_parallel_deflate_segment_decompress(
+     libewf_parallel_deflate_segment_t *segment,
+     libcerror_error_t **error )
+{
+	z_stream inflate_stream;
+
+	static char *function = "libewf_parallel_deflate_segment_decompress";
+	uint32_t checksum     = 0;
+	int flush             = 0;
+	int result            = 0;
+
+	if( segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment->uncompressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment - missing uncompressed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment->uncompressed_data_size > (size_t) UINT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid segment - uncompressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment->compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment - missing compressed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment->compressed_data_size > (size_t) UINT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid segment - compressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     &inflate_stream,
+	     0,
+	     sizeof( z_stream ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear inflate stream.",
+		 function );
+
+		return( -1 );
+	}
+	/* A negative window bits value reads a raw deflate stream without a zlib header and trailer
+	 */
+	result = inflateInit2(
+	          &inflate_stream,
+	          -15 );
+
+	if( result != Z_OK )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize inflate stream with error: %d.",
+		 function,
+		 result );
+
+		return( -1 );
+	}
+	if( segment->is_last_segment != 0 )
+	{
+		flush = Z_FINISH;
+	}
+	else
+	{
+		flush = Z_SYNC_FLUSH;
+	}
+	inflate_stream.next_in   = (Bytef *) segment->compressed_data;
+	inflate_stream.avail_in  = (uInt) segment->compressed_data_size;
+	inflate_stream.next_out  = (Bytef *) segment->uncompressed_data;
+	inflate_stream.avail_out = (uInt) segment->uncompressed_data_size;
+
+	result = inflate(
+	          &inflate_stream,
+	          flush );
+
+	/* A segment that is not the last segment must end exactly at the sync flush
+	 */
+	if( ( ( flush == Z_FINISH )
+	  &&  ( result == Z_STREAM_END )
+	  &&  ( inflate_stream.avail_in == 0 ) )
+	 || ( ( flush == Z_SYNC_FLUSH )
+	  &&  ( result == Z_OK )
+	  &&  ( inflate_stream.avail_in == 0 )
+	  &&  ( inflate_stream.avail_out == 0 ) ) )
+	{
+		segment->uncompressed_data_size = (size_t) inflate_stream.total_out;
+
+		result = 1;
+	}
+	else
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: unable to decompress segment with zlib result: %d.\n",
+			 function,
+			 result );
+		}
+#endif
+		result = 0;
+	}
+	inflateEnd(
+	 &inflate_stream );
+
+	if( result == 1 )
+	{
+		if( libewf_checksum_calculate_adler32(
+		     &checksum,
+		     segment->uncompressed_data,
+		     segment->uncompressed_data_size,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to calculate checksum.",
+			 function );
+
+			return( -1 );
+		}
+		if( checksum != segment->checksum )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: checksum mismatch (stored: 0x%08" PRIx32 ", calculated: 0x%08" PRIx32 ").\n",
+				 function,
+				 segment->checksum,
+				 checksum );
+			}
+#endif
+			result = 0;
+		}
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_ZLIB_INFLATE ) || defined( ZLIB_DLL ) */
+
+/* Compresses or decompresses a segment
+ * Returns 1 on success, 0 if the segment could not be processed or -1 on error
+ */
+int libewf_parallel_deflate_segment_process(
+     libewf_parallel_deflate_segment_t *segment,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_parallel_deflate_segment_process";
+	int result            = 0;
+
+	if( segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment->decompress == 0 )
+	{
+		result = libewf_parallel_deflate_segment_compress(
+		          segment,
+		          error );
+	}
+	else
+	{
+#if defined( HAVE_ZLIB_INFLATE ) || defined( ZLIB_DLL )
+		result = libewf_parallel_deflate_segment_decompress(
+		          segment,
+		          error );
+#else
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: missing support for decompression.",
+		 function );
+
+		result = -1;
+#endif
+	}
+	return( result );
+}
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Compresses or decompresses a segment
+ * Thread function, the result is stored in the segment
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_parallel_deflate_segment_thread_function(
+     libewf_parallel_deflate_segment_t *segment )
+{
+	libcerror_error_t *error = NULL;
+
+	if( segment == NULL )
+	{
+		return( -1 );
+	}
+	segment->result = libewf_parallel_deflate_segment_process(
+	                   segment,
+	                   &error );
+
+	if( segment->result == -1 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* Processes segments on multiple threads
+ * The segments are processed in runs of at most number of threads segments,
+ * the first segment of every run is processed by the calling thread
+ * The result of every processed segment is stored in the segment, processing
+ * stops after the run that contains a segment that failed with an error
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_parallel_deflate_process_segments(
+     libewf_parallel_deflate_segment_t *segments,
+     int number_of_segments,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function   = "libewf_parallel_deflate_process_segments";
+	int first_segment_index = 0;
+	int last_segment_index  = 0;
+	int segment_index       = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	int thread_result       = 0;
+#endif
+
+	if( segments == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segments.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_segments <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of segments value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > LIBEWF_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	for( first_segment_index = 0;
+	     first_segment_index < number_of_segments;
+	     first_segment_index += number_of_threads )
+	{
+		last_segment_index = first_segment_index + number_of_threads;
+
+		if( last_segment_index > number_of_segments )
+		{
+			last_segment_index = number_of_segments;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		for( segment_index = first_segment_index + 1;
+		     segment_index < last_segment_index;
+		     segment_index++ )
+		{
+			if( libcthreads_thread_create(
+			     &( segments[ segment_index ].thread ),
+			     NULL,
+			     (int (*)(void *)) &libewf_parallel_deflate_segment_thread_function,
+			     (void *) &( segments[ segment_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create thread: %d.",
+				 function,
+				 segment_index );
+
+				goto on_error;
+			}
+		}
+		segments[ first_segment_index ].result = libewf_parallel_deflate_segment_process(
+		                                          &( segments[ first_segment_index ] ),
+		                                          error );
+
+		for( segment_index = first_segment_index + 1;
+		     segment_index < last_segment_index;
+		     segment_index++ )
+		{
+			thread_result = libcthreads_thread_join(
+			                 &( segments[ segment_index ].thread ),
+			                 NULL );
+
+			if( thread_result != 1 )
+			{
+				segments[ segment_index ].result = -1;
+			}
+		}
+#else
+		for( segment_index = first_segment_index;
+		     segment_index < last_segment_index;
+		     segment_index++ )
+		{
+			segments[ segment_index ].result = libewf_parallel_deflate_segment_process(
+			                                    &( segments[ segment_index ] ),
+			                                    error );
+
+			if( segments[ segment_index ].result == -1 )
+			{
+				break;
+			}
+		}
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+		for( segment_index = first_segment_index;
+		     segment_index < last_segment_index;
+		     segment_index++ )
+		{
+			if( segments[ segment_index ].result == -1 )
+			{
+				return( 1 );
+			}
+		}
+	}
+	return( 1 );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+on_error:
+	for( segment_index = first_segment_index + 1;
+	     segment_index < last_segment_index;
+	     segment_index++ )
+	{
+		if( segments[ segment_index ].thread != NULL )
+		{
+			libcthreads_thread_join(
+			 &( segments[ segment_index ].thread ),
+			 NULL );
+		}
+	}
+	return( -1 );
+#endif
+}
+
+/* Compresses data in segments on multiple threads
+ * The segments are compressed into sequences of deflate blocks that together with
+ * a zlib header and the combined Adler-32 checksum form a single zlib stream,
+ * hence the data can be decompressed by any zlib compatible implementation
+ * Returns 1 on success, 0 if buffer is too small or -1 on error
+ */
+int libewf_parallel_deflate_compress(
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     int zlib_compression_level,
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	libewf_parallel_deflate_segment_t *segments = NULL;
+	uint8_t *segments_data                      = NULL;
+	static char *function                       = "libewf_parallel_deflate_compress";
+	size_t maximum_segment_data_size            = 0;
+	size_t required_compressed_data_size        = 0;
+	size_t segment_data_size                    = 0;
+	size_t segment_offset                       = 0;
+	size_t segments_data_size                   = 0;
+	uint32_t checksum                           = 0;
+	uint16_t zlib_header                        = 0;
+	int number_of_segments                      = 0;
+	int result                                  = 1;
+	int segment_index                           = 0;
+
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compressed_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid compressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data_size > (size_t) UINT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid uncompressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > LIBEWF_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_segments = libewf_parallel_deflate_get_number_of_segments(
+	                      uncompressed_data_size,
+	                      number_of_threads );
+
+	segment_data_size = uncompressed_data_size / number_of_segments;
+
+	/* The compressed data of a segment is bounded by the size of the stored blocks
+	 * of 5 bytes per 16 KiB of data at most and the size of the flush marker
+	 */
+	maximum_segment_data_size = segment_data_size + ( uncompressed_data_size % number_of_segments );
+	maximum_segment_data_size = maximum_segment_data_size + ( maximum_segment_data_size / 16 ) + 64;
+
+	if( maximum_segment_data_size > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / number_of_segments ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segments data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	segments_data_size = maximum_segment_data_size * number_of_segments;
+
+	segments = (libewf_parallel_deflate_segment_t *) memory_allocate(
+	                                                  sizeof( libewf_parallel_deflate_segment_t ) * number_of_segments );
+
+	if( segments == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segments.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     segments,
+	     0,
+	     sizeof( libewf_parallel_deflate_segment_t ) * number_of_segments ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear segments.",
+		 function );
+
+		goto on_error;
+	}
+	segments_data = (uint8_t *) memory_allocate(
+	                             sizeof( uint8_t ) * segments_data_size );
+
+	if( segments_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segments data.",
+		 function );
+
+		goto on_error;
+	}
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+		segments[ segment_index ].uncompressed_data      = (uint8_t *) &( uncompressed_data[ segment_offset ] );
+		segments[ segment_index ].uncompressed_data_size = segment_data_size;
+		segments[ segment_index ].zlib_compression_level = zlib_compression_level;
+		segments[ segment_index ].compressed_data        = &( segments_data[ segment_index * maximum_segment_data_size ] );
+		segments[ segment_index ].compressed_data_size   = maximum_segment_data_size;
+
+		if( segment_index == ( number_of_segments - 1 ) )
+		{
+			segments[ segment_index ].uncompressed_data_size = uncompressed_data_size - segment_offset;
+			segments[ segment_index ].is_last_segment        = 1;
+		}
+		if( segment_offset > 0 )
+		{
+			segments[ segment_index ].dictionary_size = LIBEWF_PARALLEL_DEFLATE_DICTIONARY_SIZE;
+
+			if( segments[ segment_index ].dictionary_size > segment_offset )
+			{
+				segments[ segment_index ].dictionary_size = segment_offset;
+			}
+			segments[ segment_index ].dictionary = &( uncompressed_data[ segment_offset - segments[ segment_index ].dictionary_size ] );
+		}
+		segment_offset += segment_data_size;
+	}
+	if( libewf_parallel_deflate_process_segments(
+	     segments,
+	     number_of_segments,
+	     number_of_threads,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to compress segments.",
+		 function );
+
+		goto on_error;
+	}
+	required_compressed_data_size = 2 + 4;
+
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+		if( segments[ segment_index ].result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+			 "%s: unable to compress segment: %d.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		required_compressed_data_size += segments[ segment_index ].compressed_data_size;
+	}
+	if( required_compressed_data_size > *compressed_data_size )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: unable to write compressed data: target buffer too small.\n",
+			 function );
+		}
+#endif
+		*compressed_data_size = required_compressed_data_size;
+
+		result = 0;
+	}
+	else
+	{
+		zlib_header = libewf_parallel_deflate_get_zlib_header(
+		               zlib_compression_level );
+
+		byte_stream_copy_from_uint16_big_endian(
+		 compressed_data,
+		 zlib_header );
+
+		segment_offset = 2;
+
+		for( segment_index = 0;
+		     segment_index < number_of_segments;
+		     segment_index++ )
+		{
+			if( memory_copy(
+			     &( compressed_data[ segment_offset ] ),
+			     segments[ segment_index ].compressed_data,
+			     segments[ segment_index ].compressed_data_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy segment: %d compressed data.",
+				 function,
+				 segment_index );
+
+				goto on_error;
+			}
+			segment_offset += segments[ segment_index ].compressed_data_size;
+
+			if( segment_index == 0 )
+			{
+				checksum = segments[ segment_index ].checksum;
+			}
+			else
+			{
+				checksum = libewf_parallel_deflate_combine_adler32(
+				            checksum,
+				            segments[ segment_index ].checksum,
+				            segments[ segment_index ].uncompressed_data_size );
+			}
+		}
+		byte_stream_copy_from_uint32_big_endian(
+		 &( compressed_data[ segment_offset ] ),
+		 checksum );
+
+		*compressed_data_size = required_compressed_data_size;
+	}
+	memory_free(
+	 segments_data );
+
+	memory_free(
+	 segments );
+
+	return( result );
+
+on_error:
+	if( segments_data != NULL )
+	{
+		memory_free(
+		 segments_data );
+	}
+	if( segments != NULL )
+	{
+		memory_free(
+		 segments );
+	}
+	return( -1 );
+}
+
+/* Compresses data in independent sub-blocks on multiple threads
+ * Every sub-block is compressed without the preceding data as dictionary into
+ * a sequence of deflate blocks, the sequences together with a zlib header and
+ * the combined Adler-32 checksum form a single zlib stream that is followed by
+ * the sub-block index, hence every sub-block can be decompressed on its own
+ * Returns 1 on success, 0 if buffer is too small or -1 on error
+ */
+int libewf_parallel_deflate_compress_sub_blocks(
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     int zlib_compression_level,
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     size32_t sub_block_size,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	libewf_parallel_deflate_segment_t *segments = NULL;
+	uint8_t *segments_data                      = NULL;
+	static char *function                       = "libewf_parallel_deflate_compress_sub_blocks";
+	size_t maximum_segment_data_size            = 0;
+	size_t required_compressed_data_size        = 0;
+	size_t segment_offset                       = 0;
+	size_t segments_data_size                   = 0;
+	size_t uncompressed_data_offset             = 0;
+	uint32_t checksum                           = 0;
+	uint16_t zlib_header                        = 0;
+	int number_of_segments                      = 0;
+	int result                                  = 1;
+	int segment_index                           = 0;
+
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compressed_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid compressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( uncompressed_data_size == 0 )
+	 || ( uncompressed_data_size > (size_t) INT32_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid uncompressed data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( sub_block_size == 0 )
+	 || ( sub_block_size > (size32_t) INT32_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid sub-block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > LIBEWF_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_segments = (int) ( uncompressed_data_size / sub_block_size );
+
+	if( ( uncompressed_data_size % sub_block_size ) != 0 )
+	{
+		number_of_segments++;
+	}
+	/* The compressed data of a sub-block is bounded by the size of the stored blocks
+	 * of 5 bytes per 16 KiB of data at most and the size of the flush marker
+	 */
+	maximum_segment_data_size = (size_t) sub_block_size;
+
+	if( maximum_segment_data_size > uncompressed_data_size )
+	{
+		maximum_segment_data_size = uncompressed_data_size;
+	}
+	maximum_segment_data_size = maximum_segment_data_size + ( maximum_segment_data_size / 16 ) + 64;
+
+	if( maximum_segment_data_size > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / number_of_segments ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segments data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	segments_data_size = maximum_segment_data_size * number_of_segments;
+
+	segments = (libewf_parallel_deflate_segment_t *) memory_allocate(
+	                                                  sizeof( libewf_parallel_deflate_segment_t ) * number_of_segments );
+
+	if( segments == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segments.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     segments,
+	     0,
+	     sizeof( libewf_parallel_deflate_segment_t ) * number_of_segments ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear segments.",
+		 function );
+
+		goto on_error;
+	}
+	segments_data = (uint8_t *) memory_allocate(
+	                             sizeof( uint8_t ) * segments_data_size );
+
+	if( segments_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segments data.",
+		 function );
+
+		goto on_error;
+	}
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+		segments[ segment_index ].uncompressed_data      = (uint8_t *) &( uncompressed_data[ uncompressed_data_offset ] );
+		segments[ segment_index ].uncompressed_data_size = (size_t) sub_block_size;
+		segments[ segment_index ].zlib_compression_level = zlib_compression_level;
+		segments[ segment_index ].compressed_data        = &( segments_data[ segment_index * maximum_segment_data_size ] );
+		segments[ segment_index ].compressed_data_size   = maximum_segment_data_size;
+
+		if( segment_index == ( number_of_segments - 1 ) )
+		{
+			segments[ segment_index ].uncompressed_data_size = uncompressed_data_size - uncompressed_data_offset;
+			segments[ segment_index ].is_last_segment        = 1;
+		}
+		uncompressed_data_offset += sub_block_size;
+	}
+	if( libewf_parallel_deflate_process_segments(
+	     segments,
+	     number_of_segments,
+	     number_of_threads,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to compress segments.",
+		 function );
+
+		goto on_error;
+	}
+	required_compressed_data_size = 2 + 4 + LIBEWF_PARALLEL_DEFLATE_SUB_BLOCK_INDEX_FOOTER_SIZE;
+
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+		if( segments[ segment_index ].result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+			 "%s: unable to compress segment: %d.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		required_compressed_data_size += segments[ segment_index ].compressed_data_size
+		                               + LIBEWF_PARALLEL_DEFLATE_SUB_BLOCK_INDEX_ENTRY_SIZE;
+	}
+	/* The offsets in the sub-block index are stored as 32-bit values
+	 */
+	if( required_compressed_data_size > (size_t) UINT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid required compressed data size value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	if( required_compressed_data_size > *compressed_data_size )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: unable to write compressed data: target buffer too small.\n",
+			 function );
+		}
+#endif
+		*compressed_data_size = required_compressed_data_size;
+
+		result = 0;
+	}
+	else
+	{
+		zlib_header = libewf_parallel_deflate_get_zlib_header(
+		               zlib_compression_level );
+
+		byte_stream_copy_from_uint16_big_endian(
+		 compressed_data,
+		 zlib_header );
+
+		/* The sub-block index is stored after the zlib stream
+		 */
+		uncompressed_data_offset = required_compressed_data_size
+		                         - LIBEWF_PARALLEL_DEFLATE_SUB_BLOCK_INDEX_FOOTER_SIZE
+		                         - ( (size_t) number_of_segments * LIBEWF_PARALLEL_DEFLATE_SUB_BLOCK_INDEX_ENTRY_SIZE );
+
+		segment_offset = 2;
+
+		for( segment_index = 0;
+		     segment_index < number_of_segments;
+		     segment_index++ )
+		{
+			if( memory_copy(
+			     &( compressed_data[ segment_offset ] ),
+			     segments[ segment_index ].compressed_data,
+			     segments[ segment_index ].compressed_data_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy segment: %d compressed data.",
+				 function,
+				 segment_index );
+
+				goto on_error;
+			}
+			byte_stream_copy_from_uint32_little_endian(
+			 &( compressed_data[ uncompressed_data_offset ] ),
+			 (uint32_t) segment_offset );
+
+			byte_stream_copy_from_uint32_little_endian(
+			 &( compressed_data[ uncompressed_data_offset + 4 ] ),
+			 segments[ segment_index ].checksum );
+
+			uncompressed_data_offset += LIBEWF_PARALLEL_DEFLATE_SUB_BLOCK_INDEX_ENTRY_SIZE;
+			segment_offset           += segments[ segment_index ].compressed_data_size;
+
+			if( segment_index == 0 )
+			{
+				checksum = segments[ segment_index ].checksum;
+			}
+			else
+			{
+				checksum = libewf_parallel_deflate_combine_adler32(
+				            checksum,
+				            segments[ segment_index ].checksum,
+				            segments[ segment_index ].uncompressed_data_size );
+			}
+		}
+		byte_stream_copy_from_uint32_big_endian(
+		 &( compressed_data[ segment_offset ] ),
+		 checksum );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 &( compressed_data[ uncompressed_data_offset ] ),
+		 sub_block_size );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 &( compressed_data[ uncompressed_data_offset + 4 ] ),
+		 (uint32_t) number_of_segments );
+
+		if( memory_copy(
+		     &( compressed_data[ uncompressed_data_offset + 8 ] ),
+		     libewf_parallel_deflate_sub_block_index_signature,
+		     4 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy sub-block index signature.",
+			 function );
+
+			goto on_error;
+		}
+		*compressed_data_size = required_compressed_data_size;
+	}
+	memory_free(
+	 segments_data );
+
+	memory_free(
+	 segments );
+
+	return( result );
+
+on_error:
+	if( segments_data != NULL )
+	{
+		memory_free(
+		 segments_data );
+	}
+	if( segments != NULL )
+	{
+		memory_free(
+		 segments );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_ZLIB_INFLATE ) || defined( ZLIB_DLL )
+
+/* Decompresses a range of sub-blocks on multiple threads
+ * The compressed data contains the part of the zlib stream that starts at the compressed data offset
+ * and must contain the compressed data of all the sub-blocks of the range
+ * The sub-blocks are stored consecutively in the uncompressed data
+ * Returns 1 if successful, 0 if the sub-blocks could not be decompressed or -1 on error
+ */
+int libewf_parallel_deflate_decompress_sub_blocks(
+     libewf_parallel_deflate_sub_block_index_t *sub_block_index,
+     const uint8_t *compressed_data,
+     size_t compressed_data_offset,
+     size_t compressed_data_size,
+     uint32_t first_sub_block_number,
+     uint32_t number_of_sub_blocks,
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_data_size,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	libewf_parallel_deflate_segment_t *segments = NULL;
+	static char *function                       = "libewf_parallel_deflate_decompress_sub_blocks";
+	size_t sub_block_data_offset                = 0;
+	size_t sub_block_data_size                  = 0;
+	size_t uncompressed_data_offset             = 0;
+	uint32_t sub_block_checksum                 = 0;
+	uint32_t sub_block_number                   = 0;
+	int result                                  = 1;
+	int segment_index                           = 0;
+
+	if( sub_block_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub-block index.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid compressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_sub_blocks == 0 )
+	 || ( first_sub_block_number >= sub_block_index->number_of_sub_blocks )
+	 || ( number_of_sub_blocks > ( sub_block_index->number_of_sub_blocks - first_sub_block_number ) )
+	 || ( number_of_sub_blocks > (uint32_t) INT_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid sub-block range value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( *uncompressed_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid uncompressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	segments = (libewf_parallel_deflate_segment_t *) memory_allocate(
+	                                                  sizeof( libewf_parallel_deflate_segment_t ) * number_of_sub_blocks );
+
+	if( segments == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segments.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     segments,
+	     0,
+	     sizeof( libewf_parallel_deflate_segment_t ) * number_of_sub_blocks ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear segments.",
+		 function );
+
+		goto on_error;
+	}
+	for( segment_index = 0;
+	     segment_index < (int) number_of_sub_blocks;
+	     segment_index++ )
+	{
+		sub_block_number = first_sub_block_number + (uint32_t) segment_index;
+
+		if( libewf_parallel_deflate_sub_block_index_get_sub_block(
+		     sub_block_index,
+		     sub_block_number,
+		     &sub_block_data_offset,
+		     &sub_block_data_size,
+		     &sub_block_checksum,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sub-block: %" PRIu32 ".",
+			 function,
+			 sub_block_number );
+
+			goto on_error;
+		}
+		if( ( sub_block_data_offset < compressed_data_offset )
+		 || ( ( sub_block_data_offset - compressed_data_offset ) > compressed_data_size )
+		 || ( sub_block_data_size > ( compressed_data_size - ( sub_block_data_offset - compressed_data_offset ) ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: sub-block: %" PRIu32 " compressed data out of bounds.",
+			 function,
+			 sub_block_number );
+
+			goto on_error;
+		}
+		if( uncompressed_data_offset >= *uncompressed_data_size )
+		{
+			result = 0;
+
+			break;
+		}
+		segments[ segment_index ].decompress             = 1;
+		segments[ segment_index ].compressed_data        = (uint8_t *) &( compressed_data[ sub_block_data_offset - compressed_data_offset ] );
+		segments[ segment_index ].compressed_data_size   = sub_block_data_size;
+		segments[ segment_index ].uncompressed_data      = &( uncompressed_data[ uncompressed_data_offset ] );
+		segments[ segment_index ].uncompressed_data_size = *uncompressed_data_size - uncompressed_data_offset;
+		segments[ segment_index ].checksum               = sub_block_checksum;
+
+		if( ( sub_block_number + 1 ) == sub_block_index->number_of_sub_blocks )
+		{
+			segments[ segment_index ].is_last_segment = 1;
+		}
+		/* A sub-block that is not the last sub-block decompresses into exactly the sub-block size
+		 */
+		else if( segments[ segment_index ].uncompressed_data_size < (size_t) sub_block_index->sub_block_size )
+		{
+			result = 0;
+
+			break;
+		}
+		else
+		{
+			segments[ segment_index ].uncompressed_data_size = (size_t) sub_block_index->sub_block_size;
+		}
+		uncompressed_data_offset += segments[ segment_index ].uncompressed_data_size;
+	}
+	if( result == 1 )
+	{
+		if( libewf_parallel_deflate_process_segments(
+		     segments,
+		     (int) number_of_sub_blocks,
+		     number_of_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to decompress segments.",
+			 function );
+
+			goto on_error;
+		}
+		uncompressed_data_offset = 0;
+
+		for( segment_index = 0;
+		     segment_index < (int) number_of_sub_blocks;
+		     segment_index++ )
+		{
+			if( segments[ segment_index ].result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+				 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+				 "%s: unable to decompress segment: %d.",
+				 function,
+				 segment_index );
+
+				goto on_error;
+			}
+			else if( segments[ segment_index ].result != 1 )
+			{
+				result = 0;
+			}
+			uncompressed_data_offset += segments[ segment_index ].uncompressed_data_size;
+		}
+		if( result == 1 )
+		{
+			*uncompressed_data_size = uncompressed_data_offset;
+		}
+	}
+	memory_free(
+	 segments );
+
+	return( result );
+
+on_error:
+	if( segments != NULL )
+	{
+		memory_free(
+		 segments );
+	}
+	return( -1 );
+}
+
+/* Decompresses data that was compressed in independent sub-blocks on multiple threads
+ * The compressed data must be of a chunk that is flagged to contain a sub-block index
+ * Returns 1 on success, 0 if the sub-block index is not valid
+ * or the data could not be decompressed by sub-block or -1 on error
+ */
+int libewf_parallel_deflate_decompress(
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_data_size,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	libewf_parallel_deflate_sub_block_index_t sub_block_index;
+
+	static char *function              = "libewf_parallel_deflate_decompress";
+	size_t sub_block_data_offset       = 0;
+	size_t sub_block_data_size         = 0;
+	size_t sub_block_uncompressed_size = 0;
+	uint32_t calculated_checksum       = 0;
+	uint32_t stored_checksum           = 0;
+	uint32_t sub_block_checksum        = 0;
+	uint32_t sub_block_number          = 0;
+	uint16_t zlib_header               = 0;
+	int result                         = 0;
+
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid compressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data_size <= LIBEWF_PARALLEL_DEFLATE_SUB_BLOCK_INDEX_FOOTER_SIZE )
+	{
+		return( 0 );
+	}
+	result = libewf_parallel_deflate_sub_block_index_read_footer(
+	          &sub_block_index,
+	          &( compressed_data[ compressed_data_size - LIBEWF_PARALLEL_DEFLATE_SUB_BLOCK_INDEX_FOOTER_SIZE ] ),
+	          LIBEWF_PARALLEL_DEFLATE_SUB_BLOCK_INDEX_FOOTER_SIZE,
+	          compressed_data_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to read sub-block index footer.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint16_big_endian(
+	 compressed_data,
+	 zlib_header );
+
+	/* Only a deflate compressed zlib stream without a preset dictionary can contain sub-blocks
+	 */
+	if( ( ( zlib_header & 0x0f20 ) != 0x0800 )
+	 || ( ( zlib_header >> 12 ) > 7 )
+	 || ( ( zlib_header % 31 ) != 0 ) )
+	{
+		return( 0 );
+	}
+	result = libewf_parallel_deflate_sub_block_index_set_entries_data(
+	          &sub_block_index,
+	          &( compressed_data[ sub_block_index.zlib_stream_size ] ),
+	          sub_block_index.entries_data_size,
+	          error );
+
+	if( result != 1 )
+	{
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set sub-block index entries data.",
+			 function );
+		}
+		return( result );
+	}
+	result = libewf_parallel_deflate_decompress_sub_blocks(
+	          &sub_block_index,
+	          compressed_data,
+	          0,
+	          sub_block_index.zlib_stream_size,
+	          0,
+	          sub_block_index.number_of_sub_blocks,
+	          uncompressed_data,
+	          uncompressed_data_size,
+	          number_of_threads,
+	          error );
+
+	if( result != 1 )
+	{
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+			 "%s: unable to decompress sub-blocks.",
+			 function );
+		}
+		return( result );
+	}
+	/* The checksums of the sub-blocks must combine into the checksum of the zlib stream
+	 */
+	for( sub_block_number = 0;
+	     sub_block_number < sub_block_index.number_of_sub_blocks;
+	     sub_block_number++ )
+	{
+		if( libewf_parallel_deflate_sub_block_index_get_sub_block(
+		     &sub_block_index,
+		     sub_block_number,
+		     &sub_block_data_offset,
+		     &sub_block_data_size,
+		     &sub_block_checksum,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sub-block: %" PRIu32 ".",
+			 function,
+			 sub_block_number );
+
+			return( -1 );
+		}
+		if( sub_block_number == 0 )
+		{
+			calculated_checksum = sub_block_checksum;
+		}
+		else
+		{
+			sub_block_uncompressed_size = (size_t) sub_block_index.sub_block_size;
+
+			if( ( sub_block_number + 1 ) == sub_block_index.number_of_sub_blocks )
+			{
+				sub_block_uncompressed_size = *uncompressed_data_size - ( (size_t) sub_block_number * sub_block_index.sub_block_size );
+			}
+			calculated_checksum = libewf_parallel_deflate_combine_adler32(
+			                       calculated_checksum,
+			                       sub_block_checksum,
+			                       sub_block_uncompressed_size );
+		}
+	}
+	byte_stream_copy_to_uint32_big_endian(
+	 &( compressed_data[ sub_block_index.zlib_stream_size - 4 ] ),
+	 stored_checksum );
+
+	if( stored_checksum != calculated_checksum )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: checksum mismatch (stored: 0x%08" PRIx32 ", calculated: 0x%08" PRIx32 ").\n",
+			 function,
+			 stored_checksum,
+			 calculated_checksum );
+		}
+#endif
+		return( 0 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_ZLIB_INFLATE ) || defined( ZLIB_DLL ) */
+
+#endif /* ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL ) */
+
@@ -0,0 +1,261 @@
+/*
+ * Parallel deflate compression functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_PARALLEL_DEFLATE_H )
+#define _LIBEWF_PARALLEL_DEFLATE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The size of the deflate window, the preceding data a segment is primed with
+ */
+#define LIBEWF_PARALLEL_DEFLATE_DICTIONARY_SIZE		32768
+
+/* The size of an entry of the sub-block index
+ */
+#define LIBEWF_PARALLEL_DEFLATE_SUB_BLOCK_INDEX_ENTRY_SIZE	8
+
+/* The size of the footer of the sub-block index
+ */
+#define LIBEWF_PARALLEL_DEFLATE_SUB_BLOCK_INDEX_FOOTER_SIZE	12
+
+typedef struct libewf_parallel_deflate_sub_block_index libewf_parallel_deflate_sub_block_index_t;
+
+/* The index of data that was compressed in independent sub-blocks
+ * The index is only present in EWF2 chunks that have the chunk data flag
+ * LIBEWF_CHUNK_DATA_FLAG_HAS_SUB_BLOCK_INDEX set in their table entry
+ * The index follows the zlib stream and consists of an entry per sub-block
+ * followed by the footer, all values are stored in little-endian:
+ *   entry:  the offset of the compressed sub-block relative to the start of the zlib stream (4 bytes)
+ *           the Adler-32 checksum of the uncompressed sub-block (4 bytes)
+ *   footer: the uncompressed sub-block size (4 bytes)
+ *           the number of sub-blocks (4 bytes)
+ *           the signature "sbix" (4 bytes)
+ */
+struct libewf_parallel_deflate_sub_block_index
+{
+	/* The size of the zlib stream that precedes the index
+	 */
+	size_t zlib_stream_size;
+
+	/* The size of the uncompressed data of a sub-block
+	 */
+	size32_t sub_block_size;
+
+	/* The number of sub-blocks
+	 */
+	uint32_t number_of_sub_blocks;
+
+	/* The entries data
+	 */
+	const uint8_t *entries_data;
+
+	/* The size of the entries data
+	 */
+	size_t entries_data_size;
+};
+
+int libewf_parallel_deflate_sub_block_index_read_footer(
+     libewf_parallel_deflate_sub_block_index_t *sub_block_index,
+     const uint8_t *footer_data,
+     size_t footer_data_size,
+     size_t compressed_data_size,
+     libcerror_error_t **error );
+
+int libewf_parallel_deflate_sub_block_index_set_entries_data(
+     libewf_parallel_deflate_sub_block_index_t *sub_block_index,
+     const uint8_t *entries_data,
+     size_t entries_data_size,
+     libcerror_error_t **error );
+
+int libewf_parallel_deflate_sub_block_index_get_sub_block(
+     libewf_parallel_deflate_sub_block_index_t *sub_block_index,
+     uint32_t sub_block_number,
+     size_t *compressed_data_offset,
+     size_t *compressed_data_size,
+     uint32_t *checksum,
+     libcerror_error_t **error );
+
+int libewf_parallel_deflate_get_zlib_stream_size(
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     size_t *zlib_stream_size,
+     libcerror_error_t **error );
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+
+typedef struct libewf_parallel_deflate_segment libewf_parallel_deflate_segment_t;
+
+/* A segment of the data that is compressed into or decompressed from a separate
+ * sequence of deflate blocks
+ */
+struct libewf_parallel_deflate_segment
+{
+	/* Value to indicate the segment is decompressed instead of compressed
+	 */
+	uint8_t decompress;
+
+	/* The uncompressed data
+	 */
+	uint8_t *uncompressed_data;
+
+	/* The size of the uncompressed data
+	 */
+	size_t uncompressed_data_size;
+
+	/* The dictionary, the uncompressed data that precedes the segment
+	 */
+	const uint8_t *dictionary;
+
+	/* The size of the dictionary
+	 */
+	size_t dictionary_size;
+
+	/* Value to indicate the segment is the last segment
+	 */
+	uint8_t is_last_segment;
+
+	/* The (zlib) compression level
+	 */
+	int zlib_compression_level;
+
+	/* The compressed data
+	 */
+	uint8_t *compressed_data;
+
+	/* The size of the compressed data
+	 */
+	size_t compressed_data_size;
+
+	/* The Adler-32 checksum of the uncompressed data
+	 */
+	uint32_t checksum;
+
+	/* The result of the compression or decompression
+	 */
+	int result;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The thread
+	 */
+	libcthreads_thread_t *thread;
+#endif
+};
+
+uint32_t libewf_parallel_deflate_combine_adler32(
+          uint32_t first_checksum,
+          uint32_t second_checksum,
+          size_t second_data_size );
+
+int libewf_parallel_deflate_get_number_of_segments(
+     size_t uncompressed_data_size,
+     int maximum_number_of_segments );
+
+uint16_t libewf_parallel_deflate_get_zlib_header(
+          int zlib_compression_level );
+
+int libewf_parallel_deflate_segment_compress(
+     libewf_parallel_deflate_segment_t *segment,
+     libcerror_error_t **error );
+
+#if defined( HAVE_ZLIB_INFLATE ) || defined( ZLIB_DLL )
+
+int libewf_parallel_deflate_segment_decompress(
+     libewf_parallel_deflate_segment_t *segment,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_ZLIB_INFLATE ) || defined( ZLIB_DLL ) */
+
+int libewf_parallel_deflate_segment_process(
+     libewf_parallel_deflate_segment_t *segment,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+int libewf_parallel_deflate_segment_thread_function(
+     libewf_parallel_deflate_segment_t *segment );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+int libewf_parallel_deflate_process_segments(
+     libewf_parallel_deflate_segment_t *segments,
+     int number_of_segments,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libewf_parallel_deflate_compress(
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     int zlib_compression_level,
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libewf_parallel_deflate_compress_sub_blocks(
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     int zlib_compression_level,
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     size32_t sub_block_size,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+#if defined( HAVE_ZLIB_INFLATE ) || defined( ZLIB_DLL )
+
+int libewf_parallel_deflate_decompress_sub_blocks(
+     libewf_parallel_deflate_sub_block_index_t *sub_block_index,
+     const uint8_t *compressed_data,
+     size_t compressed_data_offset,
+     size_t compressed_data_size,
+     uint32_t first_sub_block_number,
+     uint32_t number_of_sub_blocks,
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_data_size,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libewf_parallel_deflate_decompress(
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_data_size,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_ZLIB_INFLATE ) || defined( ZLIB_DLL ) */
+
+#endif /* ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_PARALLEL_DEFLATE_H ) */
+
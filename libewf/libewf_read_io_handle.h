@@ -65,6 +65,10 @@ struct libewf_read_io_handle
         /* The (total) number of chunks read
          */
         uint64_t number_of_chunks_read;
+
+	/* The number of segment files read
+	 */
+	uint32_t number_of_segments_read;
 };
 
 int libewf_read_io_handle_initialize(
@@ -0,0 +1,319 @@
+/*
+ * Asynchronous read request functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_handle.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_read_request.h"
+#include "libewf_types.h"
+#include "libewf_unused.h"
+
+/* Creates a read request
+ * Make sure the value read_request is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_request_initialize(
+     libewf_read_request_t **read_request,
+     libewf_handle_t *handle,
+     uint8_t *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     void (*callback)(
+            void *callback_data,
+            ssize_t read_count,
+            libcerror_error_t *error ),
+     void *callback_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_request_initialize";
+
+	if( read_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read request.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_request != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read request value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( callback == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callback.",
+		 function );
+
+		return( -1 );
+	}
+	*read_request = memory_allocate_structure(
+	                 libewf_read_request_t );
+
+	if( *read_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read request.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *read_request,
+	     0,
+	     sizeof( libewf_read_request_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read request.",
+		 function );
+
+		goto on_error;
+	}
+	( *read_request )->handle        = handle;
+	( *read_request )->buffer        = buffer;
+	( *read_request )->buffer_size   = buffer_size;
+	( *read_request )->offset        = offset;
+	( *read_request )->callback      = callback;
+	( *read_request )->callback_data = callback_data;
+
+	return( 1 );
+
+on_error:
+	if( *read_request != NULL )
+	{
+		memory_free(
+		 *read_request );
+
+		*read_request = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a read request
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_request_free(
+     libewf_read_request_t **read_request,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_request_free";
+
+	if( read_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read request.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_request != NULL )
+	{
+		/* The handle, buffer and callback data are not managed by the read request
+		 */
+		memory_free(
+		 *read_request );
+
+		*read_request = NULL;
+	}
+	return( 1 );
+}
+
+/* Processes a read request
+ * Reads the data and calls the completion callback, the error passed to
+ * the callback is freed after the callback returns
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_request_process(
+     libewf_read_request_t *read_request,
+     libcerror_error_t **error )
+{
+	libcerror_error_t *read_error = NULL;
+	static char *function         = "libewf_read_request_process";
+	ssize_t read_count            = 0;
+
+	if( read_request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read request.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_request->callback == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid read request - missing callback.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libewf_handle_read_buffer_at_offset_concurrent(
+	              read_request->handle,
+	              read_request->buffer,
+	              read_request->buffer_size,
+	              read_request->offset,
+	              &read_error );
+
+	read_request->callback(
+	 read_request->callback_data,
+	 read_count,
+	 read_error );
+
+	if( read_error != NULL )
+	{
+		libcerror_error_free(
+		 &read_error );
+	}
+	return( 1 );
+}
+
+/* Callback function to process a read request on a worker thread
+ * The read request is freed after it was processed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_request_process_callback(
+     libewf_read_request_t *read_request,
+     void *arguments LIBEWF_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "libewf_read_request_process_callback";
+	int result               = 1;
+
+	LIBEWF_UNREFERENCED_PARAMETER( arguments )
+
+	if( libewf_read_request_process(
+	     read_request,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to process read request.",
+		 function );
+
+		result = -1;
+	}
+	if( libewf_read_request_free(
+	     &read_request,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free read request.",
+		 function );
+
+		result = -1;
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
@@ -0,0 +1,100 @@
+/*
+ * Asynchronous read request functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#if !defined( _LIBEWF_READ_REQUEST_H )
+#define _LIBEWF_READ_REQUEST_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+#include "libewf_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_read_request libewf_read_request_t;
+
+/* The read request of an asynchronous read
+ */
+struct libewf_read_request
+{
+	/* The handle
+	 */
+	libewf_handle_t *handle;
+
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The buffer size
+	 */
+	size_t buffer_size;
+
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The completion callback
+	 */
+	void (*callback)(
+	       void *callback_data,
+	       ssize_t read_count,
+	       libcerror_error_t *error );
+
+	/* The completion callback data
+	 */
+	void *callback_data;
+};
+
+int libewf_read_request_initialize(
+     libewf_read_request_t **read_request,
+     libewf_handle_t *handle,
+     uint8_t *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     void (*callback)(
+            void *callback_data,
+            ssize_t read_count,
+            libcerror_error_t *error ),
+     void *callback_data,
+     libcerror_error_t **error );
+
+int libewf_read_request_free(
+     libewf_read_request_t **read_request,
+     libcerror_error_t **error );
+
+int libewf_read_request_process(
+     libewf_read_request_t *read_request,
+     libcerror_error_t **error );
+
+int libewf_read_request_process_callback(
+     libewf_read_request_t *read_request,
+     void *arguments );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_READ_REQUEST_H ) */
+
@@ -0,0 +1,747 @@
+/*
+ * Running digest functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_libhmac.h"
+#include "libewf_running_digest.h"
+
+/* Creates a running digest
+ * Make sure the value running_digest is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_running_digest_initialize(
+     libewf_running_digest_t **running_digest,
+     uint8_t digest_types,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_running_digest_initialize";
+
+	if( running_digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid running digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( *running_digest != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid running digest value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( digest_types == 0 )
+	 || ( ( digest_types & ~( LIBEWF_DIGEST_TYPE_MD5 | LIBEWF_DIGEST_TYPE_SHA1 | LIBEWF_DIGEST_TYPE_SHA256 ) ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported digest types: 0x%02" PRIx8 ".",
+		 function,
+		 digest_types );
+
+		return( -1 );
+	}
+	*running_digest = memory_allocate_structure(
+	                   libewf_running_digest_t );
+
+	if( *running_digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create running digest.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *running_digest,
+	     0,
+	     sizeof( libewf_running_digest_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear running digest.",
+		 function );
+
+		memory_free(
+		 *running_digest );
+
+		*running_digest = NULL;
+
+		return( -1 );
+	}
+	( *running_digest )->digest_types = digest_types;
+
+	if( libewf_running_digest_reset(
+	     *running_digest,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to reset running digest.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *running_digest != NULL )
+	{
+		libewf_running_digest_free(
+		 running_digest,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a running digest
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_running_digest_free(
+     libewf_running_digest_t **running_digest,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_running_digest_free";
+	int result            = 1;
+
+	if( running_digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid running digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( *running_digest != NULL )
+	{
+		if( libewf_running_digest_free_contexts(
+		     *running_digest,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free contexts.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *running_digest );
+
+		*running_digest = NULL;
+	}
+	return( result );
+}
+
+/* Frees the digest contexts of a running digest
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_running_digest_free_contexts(
+     libewf_running_digest_t *running_digest,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_running_digest_free_contexts";
+	int result            = 1;
+
+	if( running_digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid running digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( running_digest->md5_context != NULL )
+	{
+		if( libhmac_md5_free(
+		     &( running_digest->md5_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free MD5 context.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( running_digest->sha1_context != NULL )
+	{
+		if( libhmac_sha1_free(
+		     &( running_digest->sha1_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free SHA1 context.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( running_digest->sha256_context != NULL )
+	{
+		if( libhmac_sha256_free(
+		     &( running_digest->sha256_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free SHA256 context.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Resets a running digest to calculate the digests from the start of the media data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_running_digest_reset(
+     libewf_running_digest_t *running_digest,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_running_digest_reset";
+
+	if( running_digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid running digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_running_digest_free_contexts(
+	     running_digest,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free contexts.",
+		 function );
+
+		return( -1 );
+	}
+	/* Without contexts the running digest cannot calculate until it is reset successfully
+	 */
+	running_digest->state  = LIBEWF_RUNNING_DIGEST_STATE_INTERRUPTED;
+	running_digest->offset = 0;
+
+	if( ( running_digest->digest_types & LIBEWF_DIGEST_TYPE_MD5 ) != 0 )
+	{
+		if( libhmac_md5_initialize(
+		     &( running_digest->md5_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize MD5 context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ( running_digest->digest_types & LIBEWF_DIGEST_TYPE_SHA1 ) != 0 )
+	{
+		if( libhmac_sha1_initialize(
+		     &( running_digest->sha1_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA1 context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ( running_digest->digest_types & LIBEWF_DIGEST_TYPE_SHA256 ) != 0 )
+	{
+		if( libhmac_sha256_initialize(
+		     &( running_digest->sha256_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA256 context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	running_digest->state = LIBEWF_RUNNING_DIGEST_STATE_CALCULATING;
+
+	return( 1 );
+
+on_error:
+	libewf_running_digest_free_contexts(
+	 running_digest,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Updates a running digest with media data that was read
+ * Data that overlaps with previously hashed data is only hashed once
+ * A read beyond the hashed data interrupts the running digest and
+ * a read from the start of the media data restarts an interrupted running digest
+ * The digests are finalized when the end of the media data was read
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_running_digest_update(
+     libewf_running_digest_t *running_digest,
+     off64_t offset,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     size64_t media_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_running_digest_update";
+	size_t buffer_offset  = 0;
+	size_t hash_size      = 0;
+
+	if( running_digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid running digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( running_digest->state == LIBEWF_RUNNING_DIGEST_STATE_INTERRUPTED )
+	 && ( offset == 0 ) )
+	{
+		if( libewf_running_digest_reset(
+		     running_digest,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to reset running digest.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( running_digest->state != LIBEWF_RUNNING_DIGEST_STATE_CALCULATING )
+	{
+		return( 1 );
+	}
+	if( offset > running_digest->offset )
+	{
+		/* Data was skipped, the contexts are no longer needed
+		 */
+		running_digest->state = LIBEWF_RUNNING_DIGEST_STATE_INTERRUPTED;
+
+		if( libewf_running_digest_free_contexts(
+		     running_digest,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free contexts.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	if( ( offset + (off64_t) buffer_size ) <= running_digest->offset )
+	{
+		return( 1 );
+	}
+	buffer_offset = (size_t) ( running_digest->offset - offset );
+	hash_size     = buffer_size - buffer_offset;
+
+	if( running_digest->md5_context != NULL )
+	{
+		if( libhmac_md5_update(
+		     running_digest->md5_context,
+		     &( buffer[ buffer_offset ] ),
+		     hash_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update MD5 digest hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( running_digest->sha1_context != NULL )
+	{
+		if( libhmac_sha1_update(
+		     running_digest->sha1_context,
+		     &( buffer[ buffer_offset ] ),
+		     hash_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA1 digest hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( running_digest->sha256_context != NULL )
+	{
+		if( libhmac_sha256_update(
+		     running_digest->sha256_context,
+		     &( buffer[ buffer_offset ] ),
+		     hash_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA256 digest hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	running_digest->offset += (off64_t) hash_size;
+
+	if( (size64_t) running_digest->offset >= media_size )
+	{
+		if( libewf_running_digest_finalize(
+		     running_digest,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize running digest.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Finalizes the digests of a running digest
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_running_digest_finalize(
+     libewf_running_digest_t *running_digest,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_running_digest_finalize";
+
+	if( running_digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid running digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( running_digest->state != LIBEWF_RUNNING_DIGEST_STATE_CALCULATING )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid running digest - state value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	running_digest->state = LIBEWF_RUNNING_DIGEST_STATE_INTERRUPTED;
+
+	if( running_digest->md5_context != NULL )
+	{
+		if( libhmac_md5_finalize(
+		     running_digest->md5_context,
+		     running_digest->md5_hash,
+		     LIBHMAC_MD5_HASH_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize MD5 hash.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( running_digest->sha1_context != NULL )
+	{
+		if( libhmac_sha1_finalize(
+		     running_digest->sha1_context,
+		     running_digest->sha1_hash,
+		     LIBHMAC_SHA1_HASH_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize SHA1 hash.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( running_digest->sha256_context != NULL )
+	{
+		if( libhmac_sha256_finalize(
+		     running_digest->sha256_context,
+		     running_digest->sha256_hash,
+		     LIBHMAC_SHA256_HASH_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize SHA256 hash.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_running_digest_free_contexts(
+	     running_digest,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free contexts.",
+		 function );
+
+		return( -1 );
+	}
+	running_digest->state = LIBEWF_RUNNING_DIGEST_STATE_FINALIZED;
+
+	return( 1 );
+
+on_error:
+	libewf_running_digest_free_contexts(
+	 running_digest,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Retrieves a digest of the media data
+ * Returns 1 if successful, 0 if the digest is not available or -1 on error
+ */
+int libewf_running_digest_get_digest(
+     libewf_running_digest_t *running_digest,
+     uint8_t digest_type,
+     uint8_t *digest,
+     size_t digest_size,
+     libcerror_error_t **error )
+{
+	uint8_t *hash         = NULL;
+	static char *function = "libewf_running_digest_get_digest";
+	size_t hash_size      = 0;
+
+	if( running_digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid running digest.",
+		 function );
+
+		return( -1 );
+	}
+	switch( digest_type )
+	{
+		case LIBEWF_DIGEST_TYPE_MD5:
+			hash      = running_digest->md5_hash;
+			hash_size = LIBHMAC_MD5_HASH_SIZE;
+			break;
+
+		case LIBEWF_DIGEST_TYPE_SHA1:
+			hash      = running_digest->sha1_hash;
+			hash_size = LIBHMAC_SHA1_HASH_SIZE;
+			break;
+
+		case LIBEWF_DIGEST_TYPE_SHA256:
+			hash      = running_digest->sha256_hash;
+			hash_size = LIBHMAC_SHA256_HASH_SIZE;
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported digest type: 0x%02" PRIx8 ".",
+			 function,
+			 digest_type );
+
+			return( -1 );
+	}
+	if( digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( digest_size < hash_size )
+	 || ( digest_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid digest size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( running_digest->digest_types & digest_type ) == 0 )
+	 || ( running_digest->state != LIBEWF_RUNNING_DIGEST_STATE_FINALIZED ) )
+	{
+		return( 0 );
+	}
+	if( memory_copy(
+	     digest,
+	     hash,
+	     hash_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy digest.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,136 @@
+/*
+ * Running digest functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_RUNNING_DIGEST_H )
+#define _LIBEWF_RUNNING_DIGEST_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+#include "libewf_libhmac.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The running digest states
+ */
+enum LIBEWF_RUNNING_DIGEST_STATES
+{
+	/* The media data is being hashed
+	 */
+	LIBEWF_RUNNING_DIGEST_STATE_CALCULATING		= 0,
+
+	/* All media data was hashed and the digests are available
+	 */
+	LIBEWF_RUNNING_DIGEST_STATE_FINALIZED		= 1,
+
+	/* The media data was not read sequentially
+	 */
+	LIBEWF_RUNNING_DIGEST_STATE_INTERRUPTED		= 2
+};
+
+typedef struct libewf_running_digest libewf_running_digest_t;
+
+/* The running digest calculates digests of the media data while it is read sequentially
+ */
+struct libewf_running_digest
+{
+	/* The digest types
+	 */
+	uint8_t digest_types;
+
+	/* The state
+	 */
+	uint8_t state;
+
+	/* The offset of the media data up to which the digests were calculated
+	 */
+	off64_t offset;
+
+	/* The MD5 context
+	 */
+	libhmac_md5_context_t *md5_context;
+
+	/* The SHA1 context
+	 */
+	libhmac_sha1_context_t *sha1_context;
+
+	/* The SHA256 context
+	 */
+	libhmac_sha256_context_t *sha256_context;
+
+	/* The MD5 hash
+	 */
+	uint8_t md5_hash[ LIBHMAC_MD5_HASH_SIZE ];
+
+	/* The SHA1 hash
+	 */
+	uint8_t sha1_hash[ LIBHMAC_SHA1_HASH_SIZE ];
+
+	/* The SHA256 hash
+	 */
+	uint8_t sha256_hash[ LIBHMAC_SHA256_HASH_SIZE ];
+};
+
+int libewf_running_digest_initialize(
+     libewf_running_digest_t **running_digest,
+     uint8_t digest_types,
+     libcerror_error_t **error );
+
+int libewf_running_digest_free(
+     libewf_running_digest_t **running_digest,
+     libcerror_error_t **error );
+
+int libewf_running_digest_free_contexts(
+     libewf_running_digest_t *running_digest,
+     libcerror_error_t **error );
+
+int libewf_running_digest_reset(
+     libewf_running_digest_t *running_digest,
+     libcerror_error_t **error );
+
+int libewf_running_digest_update(
+     libewf_running_digest_t *running_digest,
+     off64_t offset,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     size64_t media_size,
+     libcerror_error_t **error );
+
+int libewf_running_digest_finalize(
+     libewf_running_digest_t *running_digest,
+     libcerror_error_t **error );
+
+int libewf_running_digest_get_digest(
+     libewf_running_digest_t *running_digest,
+     uint8_t digest_type,
+     uint8_t *digest,
+     size_t digest_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_RUNNING_DIGEST_H ) */
+
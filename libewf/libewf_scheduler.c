@@ -0,0 +1,1080 @@
+/*
+ * Scheduler functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+#include "libewf_scheduler.h"
+#include "libewf_types.h"
+
+/* Creates a scheduler
+ * The scheduler starts the number of worker threads, a value of 0 runs
+ * the tasks on the thread that pushes them
+ * Make sure the value scheduler is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_scheduler_initialize(
+     libewf_scheduler_t **scheduler,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	libewf_internal_scheduler_t *internal_scheduler = NULL;
+	static char *function                           = "libewf_scheduler_initialize";
+	int number_of_queues                            = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	int thread_index                                = 0;
+#endif
+
+	if( scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( *scheduler != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid scheduler value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads < 0 )
+	 || ( number_of_threads > LIBEWF_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	internal_scheduler = memory_allocate_structure(
+	                      libewf_internal_scheduler_t );
+
+	if( internal_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create scheduler.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_scheduler,
+	     0,
+	     sizeof( libewf_internal_scheduler_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear scheduler.",
+		 function );
+
+		memory_free(
+		 internal_scheduler );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	number_of_queues = number_of_threads;
+#endif
+	if( number_of_queues > 0 )
+	{
+		internal_scheduler->queues = (libewf_scheduler_queue_t *) memory_allocate(
+		                                                           sizeof( libewf_scheduler_queue_t ) * number_of_queues );
+
+		if( internal_scheduler->queues == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create queues.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     internal_scheduler->queues,
+		     0,
+		     sizeof( libewf_scheduler_queue_t ) * number_of_queues ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear queues.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( internal_scheduler->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( internal_scheduler->task_queued_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create task queued condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( internal_scheduler->tasks_done_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create tasks done condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_threads > 0 )
+	{
+		internal_scheduler->threads = (libcthreads_thread_t **) memory_allocate(
+		                                                         sizeof( libcthreads_thread_t * ) * number_of_threads );
+
+		if( internal_scheduler->threads == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create threads.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     internal_scheduler->threads,
+		     0,
+		     sizeof( libcthreads_thread_t * ) * number_of_threads ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear threads.",
+			 function );
+
+			goto on_error;
+		}
+		internal_scheduler->workers = (libewf_scheduler_worker_t *) memory_allocate(
+		                                                             sizeof( libewf_scheduler_worker_t ) * number_of_threads );
+
+		if( internal_scheduler->workers == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create workers.",
+			 function );
+
+			goto on_error;
+		}
+		for( thread_index = 0;
+		     thread_index < number_of_threads;
+		     thread_index++ )
+		{
+			internal_scheduler->workers[ thread_index ].internal_scheduler = internal_scheduler;
+			internal_scheduler->workers[ thread_index ].queue_index        = thread_index;
+
+			if( libcthreads_thread_create(
+			     &( internal_scheduler->threads[ thread_index ] ),
+			     NULL,
+			     (int (*)(void *)) &libewf_scheduler_worker_thread_function,
+			     (void *) &( internal_scheduler->workers[ thread_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create worker thread: %d.",
+				 function,
+				 thread_index );
+
+				goto on_error;
+			}
+			internal_scheduler->number_of_threads += 1;
+		}
+	}
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+	*scheduler = (libewf_scheduler_t *) internal_scheduler;
+
+	return( 1 );
+
+on_error:
+	if( internal_scheduler != NULL )
+	{
+		libewf_scheduler_free(
+		 (libewf_scheduler_t **) &internal_scheduler,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a scheduler
+ * The tasks that are still queued are run before the worker threads stop
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_scheduler_free(
+     libewf_scheduler_t **scheduler,
+     libcerror_error_t **error )
+{
+	libewf_internal_scheduler_t *internal_scheduler = NULL;
+	static char *function                           = "libewf_scheduler_free";
+	int result                                      = 1;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	int thread_index                                = 0;
+#endif
+
+	if( scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( *scheduler != NULL )
+	{
+		internal_scheduler = (libewf_internal_scheduler_t *) *scheduler;
+		*scheduler         = NULL;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( internal_scheduler->threads != NULL )
+		{
+			if( libcthreads_mutex_grab(
+			     internal_scheduler->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to grab mutex.",
+				 function );
+
+				result = -1;
+			}
+			else
+			{
+				internal_scheduler->abort = 1;
+
+				if( libcthreads_condition_broadcast(
+				     internal_scheduler->task_queued_condition,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to broadcast task queued condition.",
+					 function );
+
+					result = -1;
+				}
+				if( libcthreads_mutex_release(
+				     internal_scheduler->mutex,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to release mutex.",
+					 function );
+
+					result = -1;
+				}
+			}
+			for( thread_index = 0;
+			     thread_index < internal_scheduler->number_of_threads;
+			     thread_index++ )
+			{
+				if( libcthreads_thread_join(
+				     &( internal_scheduler->threads[ thread_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to join worker thread: %d.",
+					 function,
+					 thread_index );
+
+					result = -1;
+				}
+			}
+			memory_free(
+			 internal_scheduler->threads );
+		}
+		if( internal_scheduler->workers != NULL )
+		{
+			memory_free(
+			 internal_scheduler->workers );
+		}
+		if( internal_scheduler->tasks_done_condition != NULL )
+		{
+			if( libcthreads_condition_free(
+			     &( internal_scheduler->tasks_done_condition ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free tasks done condition.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( internal_scheduler->task_queued_condition != NULL )
+		{
+			if( libcthreads_condition_free(
+			     &( internal_scheduler->task_queued_condition ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free task queued condition.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( internal_scheduler->mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( internal_scheduler->mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+		if( internal_scheduler->queues != NULL )
+		{
+			memory_free(
+			 internal_scheduler->queues );
+		}
+		memory_free(
+		 internal_scheduler );
+	}
+	return( result );
+}
+
+/* Takes a task from the worker queues
+ * The mutex must be held when calling this function
+ * A queue index of -1 only steals tasks, otherwise the most recently queued
+ * task of the queue is taken before tasks are stolen from the other queues
+ * The least recently queued background task is only taken when the worker queues are empty
+ * Returns 1 if a task was taken or 0 if not
+ */
+int libewf_internal_scheduler_take_task(
+     libewf_internal_scheduler_t *internal_scheduler,
+     int queue_index,
+     libewf_scheduler_task_t *task )
+{
+	libewf_scheduler_queue_t *queue = NULL;
+	int queue_iterator              = 0;
+	int task_index                  = 0;
+
+	if( ( internal_scheduler == NULL )
+	 || ( internal_scheduler->number_of_queued_tasks == 0 )
+	 || ( task == NULL ) )
+	{
+		return( 0 );
+	}
+	if( ( queue_index >= 0 )
+	 && ( queue_index < internal_scheduler->number_of_threads ) )
+	{
+		queue = &( internal_scheduler->queues[ queue_index ] );
+
+		if( queue->number_of_tasks > 0 )
+		{
+			queue->number_of_tasks -= 1;
+
+			task_index = ( queue->first_task_index + queue->number_of_tasks ) % LIBEWF_SCHEDULER_QUEUE_SIZE;
+
+			*task = queue->tasks[ task_index ];
+
+			internal_scheduler->number_of_queued_tasks -= 1;
+
+			return( 1 );
+		}
+	}
+	else
+	{
+		queue_index = internal_scheduler->next_queue_index;
+	}
+	for( queue_iterator = 0;
+	     queue_iterator < internal_scheduler->number_of_threads;
+	     queue_iterator++ )
+	{
+		queue = &( internal_scheduler->queues[ ( queue_index + queue_iterator ) % internal_scheduler->number_of_threads ] );
+
+		if( queue->number_of_tasks > 0 )
+		{
+			*task = queue->tasks[ queue->first_task_index ];
+
+			queue->first_task_index = ( queue->first_task_index + 1 ) % LIBEWF_SCHEDULER_QUEUE_SIZE;
+			queue->number_of_tasks -= 1;
+
+			internal_scheduler->number_of_queued_tasks -= 1;
+
+			return( 1 );
+		}
+	}
+	queue = &( internal_scheduler->background_queue );
+
+	if( queue->number_of_tasks > 0 )
+	{
+		*task = queue->tasks[ queue->first_task_index ];
+
+		queue->first_task_index = ( queue->first_task_index + 1 ) % LIBEWF_SCHEDULER_QUEUE_SIZE;
+		queue->number_of_tasks -= 1;
+
+		internal_scheduler->number_of_queued_tasks -= 1;
+
+		return( 1 );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Runs a task that was taken from the worker queues
+ * The mutex must not be held when calling this function
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_scheduler_run_task(
+     libewf_internal_scheduler_t *internal_scheduler,
+     libewf_scheduler_task_t *task,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_scheduler_run_task";
+	int result            = 1;
+
+	if( internal_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( task == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid task.",
+		 function );
+
+		return( -1 );
+	}
+	/* The callback function reports its own errors
+	 */
+	task->callback_function(
+	 task->value,
+	 task->arguments );
+
+	if( libcthreads_mutex_grab(
+	     internal_scheduler->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	*( task->number_of_pending_tasks ) -= 1;
+
+	if( *( task->number_of_pending_tasks ) == 0 )
+	{
+		if( libcthreads_condition_broadcast(
+		     internal_scheduler->tasks_done_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast tasks done condition.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     internal_scheduler->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* The worker thread function
+ * The worker runs tasks until the scheduler is freed and no tasks remain queued
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_scheduler_worker_thread_function(
+     libewf_scheduler_worker_t *worker )
+{
+	libewf_scheduler_task_t task;
+
+	libewf_internal_scheduler_t *internal_scheduler = NULL;
+	libcerror_error_t *error                        = NULL;
+	static char *function                           = "libewf_scheduler_worker_thread_function";
+
+	if( worker == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid worker.",
+		 function );
+
+		goto on_error;
+	}
+	internal_scheduler = worker->internal_scheduler;
+
+	if( libcthreads_mutex_grab(
+	     internal_scheduler->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	while( 1 )
+	{
+		while( ( internal_scheduler->number_of_queued_tasks == 0 )
+		    && ( internal_scheduler->abort == 0 ) )
+		{
+			if( libcthreads_condition_wait(
+			     internal_scheduler->task_queued_condition,
+			     internal_scheduler->mutex,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to wait for task queued condition.",
+				 function );
+
+				libcthreads_mutex_release(
+				 internal_scheduler->mutex,
+				 NULL );
+
+				goto on_error;
+			}
+		}
+		if( libewf_internal_scheduler_take_task(
+		     internal_scheduler,
+		     worker->queue_index,
+		     &task ) == 0 )
+		{
+			break;
+		}
+		if( libcthreads_mutex_release(
+		     internal_scheduler->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			goto on_error;
+		}
+		if( libewf_internal_scheduler_run_task(
+		     internal_scheduler,
+		     &task,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to run task.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_mutex_grab(
+		     internal_scheduler->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     internal_scheduler->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+	}
+#endif
+	libcerror_error_free(
+	 &error );
+
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* Pushes a task onto the scheduler
+ * The number of pending tasks is incremented for every task that is queued and
+ * decremented when the task has run, use libewf_scheduler_wait_for_tasks to wait for it
+ * A task with the background priority is queued on the background queue
+ * If the scheduler has no worker threads or the queues are full the task
+ * is run before this function returns
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_scheduler_push_task(
+     libewf_scheduler_t *scheduler,
+     int (*callback_function)(
+            intptr_t *value,
+            void *arguments ),
+     intptr_t *value,
+     void *arguments,
+     int *number_of_pending_tasks,
+     int priority,
+     libcerror_error_t **error )
+{
+	static char *function                           = "libewf_scheduler_push_task";
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libewf_internal_scheduler_t *internal_scheduler = NULL;
+	libewf_scheduler_queue_t *queue                 = NULL;
+	int queue_iterator                              = 0;
+	int task_index                                  = 0;
+#endif
+
+	if( scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( callback_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callback function.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_pending_tasks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of pending tasks.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( priority != LIBEWF_READ_PRIORITY_INTERACTIVE )
+	 && ( priority != LIBEWF_READ_PRIORITY_BACKGROUND ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported priority.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	internal_scheduler = (libewf_internal_scheduler_t *) scheduler;
+
+	if( internal_scheduler->number_of_threads > 0 )
+	{
+		if( libcthreads_mutex_grab(
+		     internal_scheduler->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+		if( priority == LIBEWF_READ_PRIORITY_BACKGROUND )
+		{
+			queue = &( internal_scheduler->background_queue );
+
+			if( queue->number_of_tasks >= LIBEWF_SCHEDULER_QUEUE_SIZE )
+			{
+				queue = NULL;
+			}
+		}
+		else
+		{
+			for( queue_iterator = 0;
+			     queue_iterator < internal_scheduler->number_of_threads;
+			     queue_iterator++ )
+			{
+				queue = &( internal_scheduler->queues[ internal_scheduler->next_queue_index ] );
+
+				internal_scheduler->next_queue_index += 1;
+
+				if( internal_scheduler->next_queue_index >= internal_scheduler->number_of_threads )
+				{
+					internal_scheduler->next_queue_index = 0;
+				}
+				if( queue->number_of_tasks < LIBEWF_SCHEDULER_QUEUE_SIZE )
+				{
+					break;
+				}
+				queue = NULL;
+			}
+		}
+		if( queue != NULL )
+		{
+			task_index = ( queue->first_task_index + queue->number_of_tasks ) % LIBEWF_SCHEDULER_QUEUE_SIZE;
+
+			queue->tasks[ task_index ].callback_function       = callback_function;
+			queue->tasks[ task_index ].value                   = value;
+			queue->tasks[ task_index ].arguments               = arguments;
+			queue->tasks[ task_index ].number_of_pending_tasks = number_of_pending_tasks;
+
+			queue->number_of_tasks += 1;
+
+			internal_scheduler->number_of_queued_tasks += 1;
+
+			*number_of_pending_tasks += 1;
+
+			if( libcthreads_condition_signal(
+			     internal_scheduler->task_queued_condition,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to signal task queued condition.",
+				 function );
+
+				libcthreads_mutex_release(
+				 internal_scheduler->mutex,
+				 NULL );
+
+				return( -1 );
+			}
+		}
+		if( libcthreads_mutex_release(
+		     internal_scheduler->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			return( -1 );
+		}
+		if( queue != NULL )
+		{
+			return( 1 );
+		}
+	}
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+	/* The callback function reports its own errors
+	 */
+	callback_function(
+	 value,
+	 arguments );
+
+	return( 1 );
+}
+
+/* Waits for the pending tasks
+ * The calling thread runs queued tasks while it waits, so that a task
+ * can wait for the tasks it pushed without blocking a worker
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_scheduler_wait_for_tasks(
+     libewf_scheduler_t *scheduler,
+     int *number_of_pending_tasks,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libewf_scheduler_task_t task;
+
+	libewf_internal_scheduler_t *internal_scheduler = NULL;
+#endif
+
+	static char *function                           = "libewf_scheduler_wait_for_tasks";
+	int result                                      = 1;
+
+	if( scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_pending_tasks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of pending tasks.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	internal_scheduler = (libewf_internal_scheduler_t *) scheduler;
+
+	if( internal_scheduler->number_of_threads == 0 )
+	{
+		return( 1 );
+	}
+	if( libcthreads_mutex_grab(
+	     internal_scheduler->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( *number_of_pending_tasks > 0 )
+	{
+		if( libewf_internal_scheduler_take_task(
+		     internal_scheduler,
+		     -1,
+		     &task ) != 0 )
+		{
+			if( libcthreads_mutex_release(
+			     internal_scheduler->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release mutex.",
+				 function );
+
+				return( -1 );
+			}
+			if( libewf_internal_scheduler_run_task(
+			     internal_scheduler,
+			     &task,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to run task.",
+				 function );
+
+				return( -1 );
+			}
+			if( libcthreads_mutex_grab(
+			     internal_scheduler->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to grab mutex.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( libcthreads_condition_wait(
+		          internal_scheduler->tasks_done_condition,
+		          internal_scheduler->mutex,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to wait for tasks done condition.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     internal_scheduler->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+	return( result );
+}
+
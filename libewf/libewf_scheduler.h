@@ -0,0 +1,209 @@
+/*
+ * Scheduler functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_INTERNAL_SCHEDULER_H )
+#define _LIBEWF_INTERNAL_SCHEDULER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_extern.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The number of tasks a worker queue can hold
+ */
+#define LIBEWF_SCHEDULER_QUEUE_SIZE	256
+
+typedef struct libewf_scheduler_task libewf_scheduler_task_t;
+
+/* A task is a callback with its value and arguments, like a thread pool entry
+ */
+struct libewf_scheduler_task
+{
+	/* The callback function
+	 */
+	int (*callback_function)(
+	       intptr_t *value,
+	       void *arguments );
+
+	/* The value
+	 */
+	intptr_t *value;
+
+	/* The callback function arguments
+	 */
+	void *arguments;
+
+	/* The number of pending tasks of the group the task belongs to
+	 */
+	int *number_of_pending_tasks;
+};
+
+typedef struct libewf_scheduler_queue libewf_scheduler_queue_t;
+
+/* The task queue of a worker
+ * The worker takes its most recently queued task first, other threads
+ * steal the least recently queued task
+ */
+struct libewf_scheduler_queue
+{
+	/* The tasks
+	 */
+	libewf_scheduler_task_t tasks[ LIBEWF_SCHEDULER_QUEUE_SIZE ];
+
+	/* The index of the least recently queued task
+	 */
+	int first_task_index;
+
+	/* The number of tasks
+	 */
+	int number_of_tasks;
+};
+
+typedef struct libewf_internal_scheduler libewf_internal_scheduler_t;
+
+typedef struct libewf_scheduler_worker libewf_scheduler_worker_t;
+
+/* The scheduler runs the tasks of the library and its callers on one set of worker threads
+ * A thread that waits for its tasks runs queued tasks itself, therefore tasks can
+ * wait for nested tasks without blocking a worker or adding threads
+ * Interactive tasks are queued on the worker queues and background tasks on a separate
+ * queue, so that interactive tasks are run before background tasks that were queued earlier
+ */
+struct libewf_internal_scheduler
+{
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+	/* The worker queues, one for every thread
+	 */
+	libewf_scheduler_queue_t *queues;
+
+	/* The index of the queue the next task is pushed onto
+	 */
+	int next_queue_index;
+
+	/* The queue of the background tasks, which are only taken
+	 * when the worker queues contain no tasks
+	 */
+	libewf_scheduler_queue_t background_queue;
+
+	/* The number of queued tasks
+	 */
+	int number_of_queued_tasks;
+
+	/* Value to indicate the workers should stop
+	 */
+	uint8_t abort;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The threads
+	 */
+	libcthreads_thread_t **threads;
+
+	/* The worker arguments, one for every thread
+	 */
+	libewf_scheduler_worker_t *workers;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when a task was queued
+	 */
+	libcthreads_condition_t *task_queued_condition;
+
+	/* The condition that is signalled when all tasks of a group have run
+	 */
+	libcthreads_condition_t *tasks_done_condition;
+#endif
+};
+
+/* The arguments of a worker thread
+ */
+struct libewf_scheduler_worker
+{
+	/* The scheduler
+	 */
+	libewf_internal_scheduler_t *internal_scheduler;
+
+	/* The index of the worker queue
+	 */
+	int queue_index;
+};
+
+LIBEWF_EXTERN \
+int libewf_scheduler_initialize(
+     libewf_scheduler_t **scheduler,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_scheduler_free(
+     libewf_scheduler_t **scheduler,
+     libcerror_error_t **error );
+
+int libewf_internal_scheduler_take_task(
+     libewf_internal_scheduler_t *internal_scheduler,
+     int queue_index,
+     libewf_scheduler_task_t *task );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+int libewf_internal_scheduler_run_task(
+     libewf_internal_scheduler_t *internal_scheduler,
+     libewf_scheduler_task_t *task,
+     libcerror_error_t **error );
+
+int libewf_scheduler_worker_thread_function(
+     libewf_scheduler_worker_t *worker );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+int libewf_scheduler_push_task(
+     libewf_scheduler_t *scheduler,
+     int (*callback_function)(
+            intptr_t *value,
+            void *arguments ),
+     intptr_t *value,
+     void *arguments,
+     int *number_of_pending_tasks,
+     int priority,
+     libcerror_error_t **error );
+
+int libewf_scheduler_wait_for_tasks(
+     libewf_scheduler_t *scheduler,
+     int *number_of_pending_tasks,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_INTERNAL_SCHEDULER_H ) */
+
@@ -265,24 +265,22 @@ int libewf_section_set_values(
 	return( 1 );
 }
 
-/* Reads a section descriptor
- * Returns the number of bytes read or -1 on error
+/* Reads a section descriptor from the data
+ * The file offset is the offset of the section descriptor in the segment file
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_section_descriptor_read(
-         libewf_section_descriptor_t *section_descriptor,
-         libbfio_pool_t *file_io_pool,
-         int file_io_pool_entry,
-         off64_t file_offset,
-         uint8_t format_version,
-         libcerror_error_t **error )
+int libewf_section_descriptor_read_data(
+     libewf_section_descriptor_t *section_descriptor,
+     const uint8_t *section_descriptor_data,
+     size_t section_descriptor_data_size,
+     off64_t file_offset,
+     uint8_t format_version,
+     libcerror_error_t **error )
 {
-	uint8_t *section_descriptor_data    = NULL;
-	static char *function               = "libewf_section_descriptor_read";
-	size_t section_descriptor_data_size = 0;
-	ssize_t read_count                  = 0;
-	uint32_t calculated_checksum        = 0;
-	uint32_t section_descriptor_size    = 0;
-	uint32_t stored_checksum            = 0;
+	static char *function            = "libewf_section_descriptor_read_data";
+	uint32_t calculated_checksum     = 0;
+	uint32_t section_descriptor_size = 0;
+	uint32_t stored_checksum         = 0;
 
 	if( section_descriptor == NULL )
 	{
@@ -295,85 +293,57 @@ ssize_t libewf_section_descriptor_read(
 
 		return( -1 );
 	}
-	if( format_version == 1 )
-	{
-		section_descriptor_data_size = sizeof( ewf_section_descriptor_v1_t );
-	}
-	else if( format_version == 2 )
-	{
-		section_descriptor_data_size = sizeof( ewf_section_descriptor_v2_t );
-	}
-	else
+	if( section_descriptor_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported format version.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid section descriptor data.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "%s: reading section descriptor from file IO pool entry: %d at offset: 0x%08" PRIx64 "\n",
-		 function,
-		 file_io_pool_entry,
-		 file_offset );
-	}
-#endif
-	if( libbfio_pool_seek_offset(
-	     file_io_pool,
-	     file_io_pool_entry,
-	     file_offset,
-	     SEEK_SET,
-	     error ) == -1 )
+	if( format_version == 1 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek section descriptor offset: %" PRIi64 " in file IO pool entry: %d.",
-		 function,
-		 file_offset,
-		 file_io_pool_entry );
+		if( section_descriptor_data_size < sizeof( ewf_section_descriptor_v1_t ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid section descriptor data size value out of bounds.",
+			 function );
 
-		goto on_error;
+			return( -1 );
+		}
+		section_descriptor_data_size = sizeof( ewf_section_descriptor_v1_t );
 	}
-	section_descriptor_data = (uint8_t *) memory_allocate(
-	                                       section_descriptor_data_size );
-
-	if( section_descriptor_data == NULL )
+	else if( format_version == 2 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create section descriptor data.",
-		 function );
+		if( section_descriptor_data_size < sizeof( ewf_section_descriptor_v2_t ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid section descriptor data size value out of bounds.",
+			 function );
 
-		goto on_error;
+			return( -1 );
+		}
+		section_descriptor_data_size = sizeof( ewf_section_descriptor_v2_t );
 	}
-	read_count = libbfio_pool_read_buffer(
-	              file_io_pool,
-	              file_io_pool_entry,
-	              section_descriptor_data,
-	              section_descriptor_data_size,
-	              error );
-
-	if( read_count != (ssize_t) section_descriptor_data_size )
+	else
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read section descriptor from file IO pool entry: %d.",
-		 function,
-		 file_io_pool_entry );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported format version.",
+		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
@@ -401,7 +371,7 @@ ssize_t libewf_section_descriptor_read(
 			 "%s: unable to set type string.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
 		section_descriptor->type_string[ 16 ] = 0;
 
@@ -462,7 +432,7 @@ ssize_t libewf_section_descriptor_read(
 			 "%s: unable to set data integrity hash.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
 	}
 #if defined( HAVE_DEBUG_OUTPUT )
@@ -572,7 +542,7 @@ ssize_t libewf_section_descriptor_read(
 		 "%s: unable to calculate checksum.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 	if( stored_checksum != calculated_checksum )
 	{
@@ -585,13 +555,8 @@ ssize_t libewf_section_descriptor_read(
 		 stored_checksum,
 		 calculated_checksum );
 
-		goto on_error;
+		return( -1 );
 	}
-	memory_free(
-	 section_descriptor_data );
-
-	section_descriptor_data = NULL;
-
 	if( format_version == 1 )
 	{
 		if( ( section_descriptor->end_offset < file_offset )
@@ -604,7 +569,7 @@ ssize_t libewf_section_descriptor_read(
 			 "%s: invalid section next offset value out of bounds.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
 		if( ( section_descriptor->size != 0 )
 		 && ( ( section_descriptor->size < (size64_t) sizeof( ewf_section_descriptor_v1_t ) )
@@ -617,7 +582,7 @@ ssize_t libewf_section_descriptor_read(
 			 "%s: invalid section size value out of bounds.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
 		section_descriptor->start_offset = file_offset;
 
@@ -648,7 +613,7 @@ ssize_t libewf_section_descriptor_read(
 			 "%s: invalid section previous offset value out of bounds.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
 		if( section_descriptor->start_offset == 0 )
 		{
@@ -670,7 +635,7 @@ ssize_t libewf_section_descriptor_read(
 			 "%s: invalid section data size value out of bounds.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
 		if( section_descriptor->padding_size > section_descriptor->data_size )
 		{
@@ -681,7 +646,7 @@ ssize_t libewf_section_descriptor_read(
 			 "%s: invalid section padding size value out of bounds.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
 	}
 	if( format_version == 1 )
@@ -775,7 +740,7 @@ ssize_t libewf_section_descriptor_read(
 					 section_descriptor->end_offset,
 					 section_descriptor->start_offset );
 
-					goto on_error;
+					return( -1 );
 				}
 				if( section_descriptor->size != sizeof( ewf_section_descriptor_v1_t ) )
 				{
@@ -786,7 +751,7 @@ ssize_t libewf_section_descriptor_read(
 					 "%s: invalid section size value out of bounds.",
 					 function );
 
-					goto on_error;
+					return( -1 );
 				}
 			}
 			else
@@ -804,7 +769,7 @@ ssize_t libewf_section_descriptor_read(
 					 section_descriptor->end_offset,
 					 file_offset );
 
-					goto on_error;
+					return( -1 );
 				}
 			}
 		}
@@ -827,7 +792,7 @@ ssize_t libewf_section_descriptor_read(
 					 section_descriptor->end_offset,
 					 section_descriptor->start_offset );
 
-					goto on_error;
+					return( -1 );
 				}
 				section_descriptor->size = (size64_t) sizeof( ewf_section_descriptor_v1_t );
 			}
@@ -844,7 +809,7 @@ ssize_t libewf_section_descriptor_read(
 					 "%s: invalid section next offset value out of bounds.",
 					 function );
 
-					goto on_error;
+					return( -1 );
 				}
 				section_descriptor->size = (size64_t) ( section_descriptor->end_offset - section_descriptor->start_offset );
 			}
@@ -861,36 +826,27 @@ ssize_t libewf_section_descriptor_read(
 			 "%s: mismatch in section descriptor size.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
 	}
-	return( read_count );
-
-on_error:
-	if( section_descriptor_data != NULL )
-	{
-		memory_free(
-		 section_descriptor_data );
-	}
-	return( -1 );
+	return( 1 );
 }
 
-/* Writes a section descriptor
- * Returns the number of bytes written or -1 on error
+/* Reads a section descriptor
+ * Returns the number of bytes read or -1 on error
  */
-ssize_t libewf_section_descriptor_write(
+ssize_t libewf_section_descriptor_read(
          libewf_section_descriptor_t *section_descriptor,
          libbfio_pool_t *file_io_pool,
          int file_io_pool_entry,
+         off64_t file_offset,
          uint8_t format_version,
          libcerror_error_t **error )
 {
 	uint8_t *section_descriptor_data    = NULL;
-	static char *function               = "libewf_section_descriptor_write";
-	off64_t previous_offset             = 0;
+	static char *function               = "libewf_section_descriptor_read";
 	size_t section_descriptor_data_size = 0;
-	ssize_t write_count                 = 0;
-	uint32_t calculated_checksum        = 0;
+	ssize_t read_count                  = 0;
 
 	if( section_descriptor == NULL )
 	{
@@ -922,6 +878,34 @@ ssize_t libewf_section_descriptor_write(
 
 		return( -1 );
 	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: reading section descriptor from file IO pool entry: %d at offset: 0x%08" PRIx64 "\n",
+		 function,
+		 file_io_pool_entry,
+		 file_offset );
+	}
+#endif
+	if( libbfio_pool_seek_offset(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     file_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek section descriptor offset: %" PRIi64 " in file IO pool entry: %d.",
+		 function,
+		 file_offset,
+		 file_io_pool_entry );
+
+		goto on_error;
+	}
 	section_descriptor_data = (uint8_t *) memory_allocate(
 	                                       section_descriptor_data_size );
 
@@ -936,57 +920,168 @@ ssize_t libewf_section_descriptor_write(
 
 		goto on_error;
 	}
-	if( memory_set(
+	read_count = libbfio_pool_read_buffer(
+	              file_io_pool,
+	              file_io_pool_entry,
+	              section_descriptor_data,
+	              section_descriptor_data_size,
+	              error );
+
+	if( read_count != (ssize_t) section_descriptor_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read section descriptor from file IO pool entry: %d.",
+		 function,
+		 file_io_pool_entry );
+
+		goto on_error;
+	}
+	if( libewf_section_descriptor_read_data(
+	     section_descriptor,
 	     section_descriptor_data,
-	     0,
-	     section_descriptor_data_size ) == NULL )
+	     section_descriptor_data_size,
+	     file_offset,
+	     format_version,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear section descriptor data.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read section descriptor.",
 		 function );
 
 		goto on_error;
 	}
-	if( format_version == 1 )
-	{
-		if( memory_copy(
-		     ( (ewf_section_descriptor_v1_t *) section_descriptor_data )->type_string,
-		     section_descriptor->type_string,
-		     section_descriptor->type_string_length ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to set type string.",
-			 function );
+	memory_free(
+	 section_descriptor_data );
 
-			goto on_error;
-		}
-		byte_stream_copy_from_uint64_little_endian(
-		 ( (ewf_section_descriptor_v1_t *) section_descriptor_data )->size,
-		 section_descriptor->size );
+	return( read_count );
 
-		byte_stream_copy_from_uint64_little_endian(
-		 ( (ewf_section_descriptor_v1_t *) section_descriptor_data )->next_offset,
-		 section_descriptor->end_offset );
-	}
-	else if( format_version == 2 )
+on_error:
+	if( section_descriptor_data != NULL )
 	{
-		byte_stream_copy_from_uint32_little_endian(
-		 ( (ewf_section_descriptor_v2_t *) section_descriptor_data )->type,
-		 section_descriptor->type );
-
-		if( section_descriptor->start_offset > (off64_t) sizeof( ewf_section_descriptor_v2_t ) )
-		{
-			previous_offset = section_descriptor->start_offset - sizeof( ewf_section_descriptor_v2_t );
-		}
-		byte_stream_copy_from_uint64_little_endian(
-		 ( (ewf_section_descriptor_v2_t *) section_descriptor_data )->previous_offset,
-		 previous_offset );
+		memory_free(
+		 section_descriptor_data );
+	}
+	return( -1 );
+}
+
+/* Writes a section descriptor
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_section_descriptor_write(
+         libewf_section_descriptor_t *section_descriptor,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         uint8_t format_version,
+         libcerror_error_t **error )
+{
+	uint8_t *section_descriptor_data    = NULL;
+	static char *function               = "libewf_section_descriptor_write";
+	off64_t previous_offset             = 0;
+	size_t section_descriptor_data_size = 0;
+	ssize_t write_count                 = 0;
+	uint32_t calculated_checksum        = 0;
+
+	if( section_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid section descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( format_version == 1 )
+	{
+		section_descriptor_data_size = sizeof( ewf_section_descriptor_v1_t );
+	}
+	else if( format_version == 2 )
+	{
+		section_descriptor_data_size = sizeof( ewf_section_descriptor_v2_t );
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported format version.",
+		 function );
+
+		return( -1 );
+	}
+	section_descriptor_data = (uint8_t *) memory_allocate(
+	                                       section_descriptor_data_size );
+
+	if( section_descriptor_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create section descriptor data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     section_descriptor_data,
+	     0,
+	     section_descriptor_data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear section descriptor data.",
+		 function );
+
+		goto on_error;
+	}
+	if( format_version == 1 )
+	{
+		if( memory_copy(
+		     ( (ewf_section_descriptor_v1_t *) section_descriptor_data )->type_string,
+		     section_descriptor->type_string,
+		     section_descriptor->type_string_length ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to set type string.",
+			 function );
+
+			goto on_error;
+		}
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewf_section_descriptor_v1_t *) section_descriptor_data )->size,
+		 section_descriptor->size );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewf_section_descriptor_v1_t *) section_descriptor_data )->next_offset,
+		 section_descriptor->end_offset );
+	}
+	else if( format_version == 2 )
+	{
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (ewf_section_descriptor_v2_t *) section_descriptor_data )->type,
+		 section_descriptor->type );
+
+		if( section_descriptor->start_offset > (off64_t) sizeof( ewf_section_descriptor_v2_t ) )
+		{
+			previous_offset = section_descriptor->start_offset - sizeof( ewf_section_descriptor_v2_t );
+		}
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewf_section_descriptor_v2_t *) section_descriptor_data )->previous_offset,
+		 previous_offset );
 
 		byte_stream_copy_from_uint32_little_endian(
 		 ( (ewf_section_descriptor_v2_t *) section_descriptor_data )->data_flags,
@@ -1628,9 +1723,11 @@ ssize_t libewf_section_compressed_string_read(
 		goto on_error;
 	}
 	result = libewf_decompress_data(
+	          NULL,
 	          section_data,
 	          section_data_size,
 	          compression_method,
+	          LIBEWF_DECOMPRESSION_BACKEND_DEFAULT,
 	          *uncompressed_string,
 	          uncompressed_string_size,
 	          error );
@@ -1658,9 +1755,11 @@ ssize_t libewf_section_compressed_string_read(
 		*uncompressed_string = (uint8_t *) reallocation;
 
 		result = libewf_decompress_data(
+		          NULL,
 		          section_data,
 		          section_data_size,
 		          compression_method,
+		          LIBEWF_DECOMPRESSION_BACKEND_DEFAULT,
 		          *uncompressed_string,
 		          uncompressed_string_size,
 		          error );
@@ -1845,6 +1944,7 @@ ssize_t libewf_section_write_compressed_string(
 		goto on_error;
 	}
 	result = libewf_compress_data(
+	          NULL,
 	          compressed_string,
 	          &compressed_string_size,
 	          compression_method,
@@ -1908,6 +2008,7 @@ ssize_t libewf_section_write_compressed_string(
 			goto on_error;
 		}
 		result = libewf_compress_data(
+		          NULL,
 		          compressed_string,
 		          &compressed_string_size,
 		          compression_method,
@@ -2976,35 +3077,31 @@ ssize_t libewf_section_sectors_write(
 	return( write_count );
 }
 
-/* Reads a version 1 table or table2 section or version 2 sector table section
- * The section data will be set to a buffer containing the relevant (not necessarily full) section data
+/* Reads a version 1 table or table2 section or version 2 sector table section from the data
+ * The section data must contain the table header, entries and footer
  * The table entries data will be set to a pointer within the section data
- * Returns the number of bytes read or -1 on error
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_section_table_read(
-         libewf_section_descriptor_t *section_descriptor,
-         libewf_io_handle_t *io_handle,
-         libbfio_pool_t *file_io_pool,
-         int file_io_pool_entry,
-         uint8_t format_version,
-         uint8_t segment_file_type,
-         uint8_t **section_data,
-         size_t *section_data_size,
-         uint64_t *first_chunk_index,
-         uint64_t *base_offset,
-         uint8_t **table_entries_data,
-         size_t *table_entries_data_size,
-         uint32_t *number_of_entries,
-         uint8_t *entries_corrupted,	
-         libcerror_error_t **error )
+int libewf_section_table_read_data(
+     libewf_io_handle_t *io_handle,
+     uint8_t format_version,
+     uint8_t segment_file_type,
+     uint8_t *section_data,
+     size_t section_data_size,
+     uint64_t *first_chunk_index,
+     uint64_t *base_offset,
+     uint8_t **table_entries_data,
+     size_t *table_entries_data_size,
+     uint32_t *number_of_entries,
+     uint8_t *entries_corrupted,
+     libcerror_error_t **error )
 {
 	uint8_t *table_data           = NULL;
-	static char *function         = "libewf_section_table_read";
+	static char *function         = "libewf_section_table_read_data";
 	size_t table_data_size        = 0;
 	size_t table_entry_data_size  = 0;
 	size_t table_header_data_size = 0;
 	size_t table_footer_data_size = 0;
-	ssize_t read_count            = 0;
 	uint32_t calculated_checksum  = 0;
 	uint32_t stored_checksum      = 0;
 
@@ -3012,17 +3109,6 @@ ssize_t libewf_section_table_read(
 	uint32_t value_32bit          = 0;
 #endif
 
-	if( section_descriptor == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid section descriptor.",
-		 function );
-
-		return( -1 );
-	}
 	if( io_handle == NULL )
 	{
 		libcerror_error_set(
@@ -3074,24 +3160,13 @@ ssize_t libewf_section_table_read(
 
 		return( -1 );
 	}
-	if( *section_data != NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid section data value already set.",
-		 function );
-
-		return( -1 );
-	}
-	if( section_data_size == NULL )
+	if( section_data_size > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid section data size.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid section data size value exceeds maximum.",
 		 function );
 
 		return( -1 );
@@ -3173,75 +3248,7 @@ ssize_t libewf_section_table_read(
 
 		return( -1 );
 	}
-	/* In original EWF, SMART (EWF-S01) and EnCase1 EWF-E01 the trailing data will be the chunk data
-	 */
-	if( ( segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
-	 || ( io_handle->format == LIBEWF_FORMAT_ENCASE1 ) )
-	{
-		*section_data_size = (size_t) table_header_data_size;
-	}
-	else
-	{
-		*section_data_size = (size_t) section_descriptor->data_size;
-	}
-/* TODO add support for table with chunk data */
-
-	*section_data = (uint8_t *) memory_allocate(
-	                             sizeof( uint8_t ) * *section_data_size );
-
-	if( *section_data == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create section data.",
-		 function );
-
-		goto on_error;
-	}
-	read_count = libbfio_pool_read_buffer(
-	              file_io_pool,
-	              file_io_pool_entry,
-	              *section_data,
-	              *section_data_size,
-	              error );
-
-	if( read_count != (ssize_t) *section_data_size )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read section data.",
-		 function );
-
-		goto on_error;
-	}
-	if( ( section_descriptor->data_flags & LIBEWF_SECTION_DATA_FLAGS_IS_ENCRYPTED ) != 0 )
-	{
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "%s: encrypted data:\n",
-			 function );
-			libcnotify_print_data(
-			 *section_data,
-			 *section_data_size,
-			 0 );
-		}
-#endif
-/* TODO decrypt */
-		memory_free(
-		 *section_data );
-
-		*section_data      = NULL;
-		*section_data_size = 0;
-
-		return( 0 );
-	}
-	if( *section_data_size < table_header_data_size )
+	if( section_data_size < table_header_data_size )
 	{
 		libcerror_error_set(
 		 error,
@@ -3252,8 +3259,8 @@ ssize_t libewf_section_table_read(
 
 		goto on_error;
 	}
-	table_data      = *section_data;
-	table_data_size = *section_data_size;
+	table_data      = section_data;
+	table_data_size = section_data_size;
 
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
@@ -3450,62 +3457,19 @@ ssize_t libewf_section_table_read(
 
 			goto on_error;
 		}
-		if( ( segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
-		 || ( io_handle->format == LIBEWF_FORMAT_ENCASE1 ) )
+/* TODO flag that number of entries is corrupted and continue */
+		if( table_data_size < *table_entries_data_size )
 		{
-			memory_free(
-			 *section_data );
-
-			*section_data_size += *table_entries_data_size + table_footer_data_size;
-
-			*section_data = (uint8_t *) memory_allocate(
-						     sizeof( uint8_t ) * *section_data_size );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid section size value out of bounds - insufficient space for entries.",
+			 function );
 
-			if( *section_data == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_MEMORY,
-				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-				 "%s: unable to create section data.",
-				 function );
-
-				goto on_error;
-			}
-			read_count = libbfio_pool_read_buffer(
-				      file_io_pool,
-				      file_io_pool_entry,
-				      *section_data,
-				      *section_data_size,
-				      error );
-
-			if( read_count != (ssize_t) *section_data_size )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read section data.",
-				 function );
-
-				goto on_error;
-			}
-			table_data      = *section_data;
-			table_data_size = *section_data_size;
-		}
-/* TODO flag that number of entries is corrupted and continue */
-		if( table_data_size < *table_entries_data_size )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: invalid section size value out of bounds - insufficient space for entries.",
-			 function );
-
-			goto on_error;
-		}
-		*table_entries_data = table_data;
+			goto on_error;
+		}
+		*table_entries_data = table_data;
 
 #if defined( HAVE_DEBUG_OUTPUT )
 		if( libcnotify_verbose != 0 )
@@ -3634,7 +3598,370 @@ ssize_t libewf_section_table_read(
 		}
 	}
 #endif
-	return( read_count );
+	return( 1 );
+
+on_error:
+	*table_entries_data      = NULL;
+	*table_entries_data_size = 0;
+
+	return( -1 );
+}
+
+/* Reads a version 1 table or table2 section or version 2 sector table section
+ * The section data will be set to a buffer containing the relevant (not necessarily full) section data
+ * The table entries data will be set to a pointer within the section data
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libewf_section_table_read(
+         libewf_section_descriptor_t *section_descriptor,
+         libewf_io_handle_t *io_handle,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         uint8_t format_version,
+         uint8_t segment_file_type,
+         uint8_t **section_data,
+         size_t *section_data_size,
+         uint64_t *first_chunk_index,
+         uint64_t *base_offset,
+         uint8_t **table_entries_data,
+         size_t *table_entries_data_size,
+         uint32_t *number_of_entries,
+         uint8_t *entries_corrupted,
+         libcerror_error_t **error )
+{
+	static char *function         = "libewf_section_table_read";
+	size_t table_entry_data_size  = 0;
+	size_t table_header_data_size = 0;
+	size_t table_footer_data_size = 0;
+	size_t table_trailer_size     = 0;
+	ssize_t read_count            = 0;
+	uint32_t stored_entries       = 0;
+	void *reallocation            = NULL;
+
+	if( section_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid section descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( format_version == 1 )
+	{
+		table_header_data_size = sizeof( ewf_table_header_v1_t );
+		table_entry_data_size  = sizeof( ewf_table_entry_v1_t );
+
+		/* The original EWF and SMART (EWF-S01) formats do not contain a table footer
+		 */
+		if( segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+		{
+			table_footer_data_size = 4;
+		}
+	}
+	else if( format_version == 2 )
+	{
+		table_header_data_size = sizeof( ewf_table_header_v2_t );
+		table_entry_data_size  = sizeof( ewf_table_entry_v2_t );
+		table_footer_data_size = 16;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported format version.",
+		 function );
+
+		return( -1 );
+	}
+	if( section_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid section data.",
+		 function );
+
+		return( -1 );
+	}
+	if( *section_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid section data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( section_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid section data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( first_chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid first chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( base_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid base offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( table_entries_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid table entries data.",
+		 function );
+
+		return( -1 );
+	}
+	if( *table_entries_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid table entries data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( table_entries_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid table entries data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( entries_corrupted == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entries corrupted.",
+		 function );
+
+		return( -1 );
+	}
+	/* In original EWF, SMART (EWF-S01) and EnCase1 EWF-E01 the trailing data will be the chunk data
+	 */
+	if( ( segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+	 || ( io_handle->format == LIBEWF_FORMAT_ENCASE1 ) )
+	{
+		*section_data_size = (size_t) table_header_data_size;
+	}
+	else
+	{
+		*section_data_size = (size_t) section_descriptor->data_size;
+	}
+/* TODO add support for table with chunk data */
+
+	*section_data = (uint8_t *) memory_allocate(
+	                             sizeof( uint8_t ) * *section_data_size );
+
+	if( *section_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create section data.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libbfio_pool_read_buffer(
+	              file_io_pool,
+	              file_io_pool_entry,
+	              *section_data,
+	              *section_data_size,
+	              error );
+
+	if( read_count != (ssize_t) *section_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read section data.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( section_descriptor->data_flags & LIBEWF_SECTION_DATA_FLAGS_IS_ENCRYPTED ) != 0 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: encrypted data:\n",
+			 function );
+			libcnotify_print_data(
+			 *section_data,
+			 *section_data_size,
+			 0 );
+		}
+#endif
+/* TODO decrypt */
+		memory_free(
+		 *section_data );
+
+		*section_data      = NULL;
+		*section_data_size = 0;
+
+		return( 0 );
+	}
+	/* In original EWF, SMART (EWF-S01) and EnCase1 EWF-E01 the size of the table
+	 * entries and footer is determined by the number of entries in the table header
+	 */
+	if( ( segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+	 || ( io_handle->format == LIBEWF_FORMAT_ENCASE1 ) )
+	{
+		if( format_version == 1 )
+		{
+			byte_stream_copy_to_uint32_little_endian(
+			 ( (ewf_table_header_v1_t *) *section_data )->number_of_entries,
+			 stored_entries );
+		}
+		else if( format_version == 2 )
+		{
+			byte_stream_copy_to_uint32_little_endian(
+			 ( (ewf_table_header_v2_t *) *section_data )->number_of_entries,
+			 stored_entries );
+		}
+		if( stored_entries > 0 )
+		{
+			if( (size_t) stored_entries > ( ( (size_t) SSIZE_MAX - table_header_data_size - table_footer_data_size ) / table_entry_data_size ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: invalid table entries data size value exceeds maximum.",
+				 function );
+
+				goto on_error;
+			}
+			table_trailer_size = ( (size_t) stored_entries * table_entry_data_size ) + table_footer_data_size;
+
+			reallocation = memory_reallocate(
+			                *section_data,
+			                sizeof( uint8_t ) * ( *section_data_size + table_trailer_size ) );
+
+			if( reallocation == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize section data.",
+				 function );
+
+				goto on_error;
+			}
+			*section_data = (uint8_t *) reallocation;
+
+			read_count = libbfio_pool_read_buffer(
+				      file_io_pool,
+				      file_io_pool_entry,
+				      &( ( *section_data )[ *section_data_size ] ),
+				      table_trailer_size,
+				      error );
+
+			if( read_count != (ssize_t) table_trailer_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read section data.",
+				 function );
+
+				goto on_error;
+			}
+			*section_data_size += table_trailer_size;
+		}
+	}
+	if( libewf_section_table_read_data(
+	     io_handle,
+	     format_version,
+	     segment_file_type,
+	     *section_data,
+	     *section_data_size,
+	     first_chunk_index,
+	     base_offset,
+	     table_entries_data,
+	     table_entries_data_size,
+	     number_of_entries,
+	     entries_corrupted,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read table section data.",
+		 function );
+
+		goto on_error;
+	}
+	return( (ssize_t) *section_data_size );
 
 on_error:
 	if( *section_data != NULL )
@@ -3644,9 +3971,7 @@ on_error:
 
 		*section_data = NULL;
 	}
-	*section_data_size       = 0;
-	*table_entries_data      = NULL;
-	*table_entries_data_size = 0;
+	*section_data_size = 0;
 
 	return( -1 );
 }
@@ -65,6 +65,14 @@ int libewf_section_set_values(
      uint32_t padding_size,
      libcerror_error_t **error );
 
+int libewf_section_descriptor_read_data(
+     libewf_section_descriptor_t *section_descriptor,
+     const uint8_t *section_descriptor_data,
+     size_t section_descriptor_data_size,
+     off64_t file_offset,
+     uint8_t format_version,
+     libcerror_error_t **error );
+
 ssize_t libewf_section_descriptor_read(
          libewf_section_descriptor_t *section_descriptor,
          libbfio_pool_t *file_io_pool,
@@ -154,6 +162,20 @@ ssize_t libewf_section_sectors_write(
          uint32_t chunks_padding_size,
          libcerror_error_t **error );
 
+int libewf_section_table_read_data(
+     libewf_io_handle_t *io_handle,
+     uint8_t format_version,
+     uint8_t segment_file_type,
+     uint8_t *section_data,
+     size_t section_data_size,
+     uint64_t *first_chunk_index,
+     uint64_t *base_offset,
+     uint8_t **table_entries_data,
+     size_t *table_entries_data_size,
+     uint32_t *number_of_entries,
+     uint8_t *entries_corrupted,
+     libcerror_error_t **error );
+
 ssize_t libewf_section_table_read(
          libewf_section_descriptor_t *section_descriptor,
          libewf_io_handle_t *io_handle,
@@ -0,0 +1,697 @@
+/*
+ * Sector range list functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+#include "libewf_sector_range.h"
+#include "libewf_sector_range_list.h"
+
+/* Creates a sector range list
+ * Make sure the value sector_range_list is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_sector_range_list_initialize(
+     libewf_sector_range_list_t **sector_range_list,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_sector_range_list_initialize";
+
+	if( sector_range_list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector range list.",
+		 function );
+
+		return( -1 );
+	}
+	if( *sector_range_list != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid sector range list value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*sector_range_list = memory_allocate_structure(
+	                      libewf_sector_range_list_t );
+
+	if( *sector_range_list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create sector range list.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *sector_range_list,
+	     0,
+	     sizeof( libewf_sector_range_list_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear sector range list.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *sector_range_list != NULL )
+	{
+		memory_free(
+		 *sector_range_list );
+
+		*sector_range_list = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a sector range list
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_sector_range_list_free(
+     libewf_sector_range_list_t **sector_range_list,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_sector_range_list_free";
+
+	if( sector_range_list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector range list.",
+		 function );
+
+		return( -1 );
+	}
+	if( *sector_range_list != NULL )
+	{
+		if( ( *sector_range_list )->ranges != NULL )
+		{
+			memory_free(
+			 ( *sector_range_list )->ranges );
+		}
+		memory_free(
+		 *sector_range_list );
+
+		*sector_range_list = NULL;
+	}
+	return( 1 );
+}
+
+/* Clones the sector range list
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_sector_range_list_clone(
+     libewf_sector_range_list_t **destination_sector_range_list,
+     libewf_sector_range_list_t *source_sector_range_list,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_sector_range_list_clone";
+
+	if( destination_sector_range_list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination sector range list.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_sector_range_list != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid destination sector range list already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_sector_range_list == NULL )
+	{
+		*destination_sector_range_list = NULL;
+
+		return( 1 );
+	}
+	if( libewf_sector_range_list_initialize(
+	     destination_sector_range_list,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination sector range list.",
+		 function );
+
+		goto on_error;
+	}
+	if( source_sector_range_list->number_of_ranges > 0 )
+	{
+		( *destination_sector_range_list )->ranges = (libewf_sector_range_t *) memory_allocate(
+		                                              sizeof( libewf_sector_range_t ) * source_sector_range_list->number_of_ranges );
+
+		if( ( *destination_sector_range_list )->ranges == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create destination ranges.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     ( *destination_sector_range_list )->ranges,
+		     source_sector_range_list->ranges,
+		     sizeof( libewf_sector_range_t ) * source_sector_range_list->number_of_ranges ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy source to destination ranges.",
+			 function );
+
+			goto on_error;
+		}
+		( *destination_sector_range_list )->number_of_ranges           = source_sector_range_list->number_of_ranges;
+		( *destination_sector_range_list )->number_of_allocated_ranges = source_sector_range_list->number_of_ranges;
+	}
+	return( 1 );
+
+on_error:
+	if( *destination_sector_range_list != NULL )
+	{
+		libewf_sector_range_list_free(
+		 destination_sector_range_list,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Empties a sector range list
+ * The allocated ranges are retained for reuse
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_sector_range_list_empty(
+     libewf_sector_range_list_t *sector_range_list,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_sector_range_list_empty";
+
+	if( sector_range_list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector range list.",
+		 function );
+
+		return( -1 );
+	}
+	sector_range_list->number_of_ranges = 0;
+
+	return( 1 );
+}
+
+/* Retrieves the number of ranges
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_sector_range_list_get_number_of_ranges(
+     libewf_sector_range_list_t *sector_range_list,
+     int *number_of_ranges,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_sector_range_list_get_number_of_ranges";
+
+	if( sector_range_list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector range list.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_ranges == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of ranges.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_ranges = sector_range_list->number_of_ranges;
+
+	return( 1 );
+}
+
+/* Retrieves a specific range
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_sector_range_list_get_range_by_index(
+     libewf_sector_range_list_t *sector_range_list,
+     int range_index,
+     uint64_t *start_sector,
+     uint64_t *number_of_sectors,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_sector_range_list_get_range_by_index";
+
+	if( sector_range_list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector range list.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( range_index < 0 )
+	 || ( range_index >= sector_range_list->number_of_ranges ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid range index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_sector_range_get(
+	     &( sector_range_list->ranges[ range_index ] ),
+	     start_sector,
+	     number_of_sectors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve range: %d.",
+		 function,
+		 range_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the index of the first range that ends after a specific sector
+ * If include_adjacent is set a range that ends at the sector is included as well
+ * The index is set to the number of ranges if there is no such range
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_sector_range_list_get_first_range_index(
+     libewf_sector_range_list_t *sector_range_list,
+     uint64_t sector,
+     uint8_t include_adjacent,
+     int *range_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_sector_range_list_get_first_range_index";
+	int lower_index       = 0;
+	int middle_index      = 0;
+	int upper_index       = 0;
+
+	if( sector_range_list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector range list.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range index.",
+		 function );
+
+		return( -1 );
+	}
+	/* The ranges do not overlap, hence the end sectors are sorted as well
+	 */
+	upper_index = sector_range_list->number_of_ranges;
+
+	while( lower_index < upper_index )
+	{
+		middle_index = lower_index + ( ( upper_index - lower_index ) / 2 );
+
+		if( ( sector_range_list->ranges[ middle_index ].end_sector > sector )
+		 || ( ( include_adjacent != 0 )
+		  &&  ( sector_range_list->ranges[ middle_index ].end_sector == sector ) ) )
+		{
+			upper_index = middle_index;
+		}
+		else
+		{
+			lower_index = middle_index + 1;
+		}
+	}
+	*range_index = lower_index;
+
+	return( 1 );
+}
+
+/* Inserts a range
+ * The range is merged with the ranges it overlaps with or is adjacent to
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_sector_range_list_insert_range(
+     libewf_sector_range_list_t *sector_range_list,
+     uint64_t start_sector,
+     uint64_t number_of_sectors,
+     libcerror_error_t **error )
+{
+	libewf_sector_range_t *ranges  = NULL;
+	static char *function          = "libewf_sector_range_list_insert_range";
+	uint64_t end_sector            = 0;
+	int first_range_index          = 0;
+	int last_range_index           = 0;
+	int number_of_allocated_ranges = 0;
+	int range_index                = 0;
+
+	if( sector_range_list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector range list.",
+		 function );
+
+		return( -1 );
+	}
+	if( start_sector > (uint64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid start sector value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_sectors > (uint64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of sectors value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	end_sector = start_sector + number_of_sectors;
+
+	if( libewf_sector_range_list_get_first_range_index(
+	     sector_range_list,
+	     start_sector,
+	     1,
+	     &first_range_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve first range index.",
+		 function );
+
+		return( -1 );
+	}
+	/* Merge the ranges that overlap with or are adjacent to the range
+	 */
+	last_range_index = first_range_index;
+
+	while( ( last_range_index < sector_range_list->number_of_ranges )
+	    && ( sector_range_list->ranges[ last_range_index ].start_sector <= end_sector ) )
+	{
+		if( sector_range_list->ranges[ last_range_index ].start_sector < start_sector )
+		{
+			start_sector = sector_range_list->ranges[ last_range_index ].start_sector;
+		}
+		if( sector_range_list->ranges[ last_range_index ].end_sector > end_sector )
+		{
+			end_sector = sector_range_list->ranges[ last_range_index ].end_sector;
+		}
+		last_range_index++;
+	}
+	if( last_range_index > first_range_index )
+	{
+		/* The merged range is stored in the first range hence the other merged ranges are removed
+		 */
+		range_index = first_range_index + 1;
+
+		while( last_range_index < sector_range_list->number_of_ranges )
+		{
+			sector_range_list->ranges[ range_index++ ] = sector_range_list->ranges[ last_range_index++ ];
+		}
+		sector_range_list->number_of_ranges = range_index;
+	}
+	else
+	{
+		if( sector_range_list->number_of_ranges >= sector_range_list->number_of_allocated_ranges )
+		{
+			if( sector_range_list->number_of_allocated_ranges > ( INT_MAX / 2 ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid number of allocated ranges value out of bounds.",
+				 function );
+
+				return( -1 );
+			}
+			number_of_allocated_ranges = sector_range_list->number_of_allocated_ranges * 2;
+
+			if( number_of_allocated_ranges < LIBEWF_SECTOR_RANGE_LIST_MINIMUM_NUMBER_OF_ALLOCATED_RANGES )
+			{
+				number_of_allocated_ranges = LIBEWF_SECTOR_RANGE_LIST_MINIMUM_NUMBER_OF_ALLOCATED_RANGES;
+			}
+			ranges = (libewf_sector_range_t *) memory_reallocate(
+			                                    sector_range_list->ranges,
+			                                    sizeof( libewf_sector_range_t ) * number_of_allocated_ranges );
+
+			if( ranges == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize ranges.",
+				 function );
+
+				return( -1 );
+			}
+			sector_range_list->ranges                     = ranges;
+			sector_range_list->number_of_allocated_ranges = number_of_allocated_ranges;
+		}
+		for( range_index = sector_range_list->number_of_ranges;
+		     range_index > first_range_index;
+		     range_index-- )
+		{
+			sector_range_list->ranges[ range_index ] = sector_range_list->ranges[ range_index - 1 ];
+		}
+		sector_range_list->number_of_ranges += 1;
+	}
+	sector_range_list->ranges[ first_range_index ].start_sector      = start_sector;
+	sector_range_list->ranges[ first_range_index ].end_sector        = end_sector;
+	sector_range_list->ranges[ first_range_index ].number_of_sectors = end_sector - start_sector;
+
+	return( 1 );
+}
+
+/* Retrieves the number of ranges that overlap with a specific range
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_sector_range_list_get_number_of_ranges_in_range(
+     libewf_sector_range_list_t *sector_range_list,
+     uint64_t start_sector,
+     uint64_t number_of_sectors,
+     int *number_of_ranges,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_sector_range_list_get_number_of_ranges_in_range";
+	uint64_t end_sector   = 0;
+	int first_range_index = 0;
+	int lower_index       = 0;
+	int middle_index      = 0;
+	int upper_index       = 0;
+
+	if( sector_range_list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector range list.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_ranges == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of ranges.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_sectors > ( UINT64_MAX - start_sector ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of sectors value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_sectors == 0 )
+	{
+		*number_of_ranges = 0;
+
+		return( 1 );
+	}
+	end_sector = start_sector + number_of_sectors;
+
+	if( libewf_sector_range_list_get_first_range_index(
+	     sector_range_list,
+	     start_sector,
+	     0,
+	     &first_range_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve first range index.",
+		 function );
+
+		return( -1 );
+	}
+	/* Determine the index of the first range that starts at or after the end sector
+	 */
+	lower_index = first_range_index;
+	upper_index = sector_range_list->number_of_ranges;
+
+	while( lower_index < upper_index )
+	{
+		middle_index = lower_index + ( ( upper_index - lower_index ) / 2 );
+
+		if( sector_range_list->ranges[ middle_index ].start_sector >= end_sector )
+		{
+			upper_index = middle_index;
+		}
+		else
+		{
+			lower_index = middle_index + 1;
+		}
+	}
+	*number_of_ranges = lower_index - first_range_index;
+
+	return( 1 );
+}
+
+/* Determines if a range overlaps with any of the ranges in the list
+ * Returns 1 if present, 0 if not or -1 on error
+ */
+int libewf_sector_range_list_range_is_present(
+     libewf_sector_range_list_t *sector_range_list,
+     uint64_t start_sector,
+     uint64_t number_of_sectors,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_sector_range_list_range_is_present";
+	int number_of_ranges  = 0;
+
+	if( libewf_sector_range_list_get_number_of_ranges_in_range(
+	     sector_range_list,
+	     start_sector,
+	     number_of_sectors,
+	     &number_of_ranges,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of ranges in range.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_ranges != 0 )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
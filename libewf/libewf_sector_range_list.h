@@ -0,0 +1,120 @@
+/*
+ * Sector range list functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_SECTOR_RANGE_LIST_H )
+#define _LIBEWF_SECTOR_RANGE_LIST_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+#include "libewf_sector_range.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The minimum number of ranges that is allocated
+ */
+#define LIBEWF_SECTOR_RANGE_LIST_MINIMUM_NUMBER_OF_ALLOCATED_RANGES	16
+
+typedef struct libewf_sector_range_list libewf_sector_range_list_t;
+
+/* A list of sector ranges that are sorted by start sector
+ * Overlapping and adjacent ranges are merged, therefore the ranges
+ * can be looked up with a binary search
+ */
+struct libewf_sector_range_list
+{
+	/* The ranges
+	 */
+	libewf_sector_range_t *ranges;
+
+	/* The number of ranges
+	 */
+	int number_of_ranges;
+
+	/* The number of allocated ranges
+	 */
+	int number_of_allocated_ranges;
+};
+
+int libewf_sector_range_list_initialize(
+     libewf_sector_range_list_t **sector_range_list,
+     libcerror_error_t **error );
+
+int libewf_sector_range_list_free(
+     libewf_sector_range_list_t **sector_range_list,
+     libcerror_error_t **error );
+
+int libewf_sector_range_list_clone(
+     libewf_sector_range_list_t **destination_sector_range_list,
+     libewf_sector_range_list_t *source_sector_range_list,
+     libcerror_error_t **error );
+
+int libewf_sector_range_list_empty(
+     libewf_sector_range_list_t *sector_range_list,
+     libcerror_error_t **error );
+
+int libewf_sector_range_list_get_number_of_ranges(
+     libewf_sector_range_list_t *sector_range_list,
+     int *number_of_ranges,
+     libcerror_error_t **error );
+
+int libewf_sector_range_list_get_range_by_index(
+     libewf_sector_range_list_t *sector_range_list,
+     int range_index,
+     uint64_t *start_sector,
+     uint64_t *number_of_sectors,
+     libcerror_error_t **error );
+
+int libewf_sector_range_list_get_first_range_index(
+     libewf_sector_range_list_t *sector_range_list,
+     uint64_t sector,
+     uint8_t include_adjacent,
+     int *range_index,
+     libcerror_error_t **error );
+
+int libewf_sector_range_list_insert_range(
+     libewf_sector_range_list_t *sector_range_list,
+     uint64_t start_sector,
+     uint64_t number_of_sectors,
+     libcerror_error_t **error );
+
+int libewf_sector_range_list_get_number_of_ranges_in_range(
+     libewf_sector_range_list_t *sector_range_list,
+     uint64_t start_sector,
+     uint64_t number_of_sectors,
+     int *number_of_ranges,
+     libcerror_error_t **error );
+
+int libewf_sector_range_list_range_is_present(
+     libewf_sector_range_list_t *sector_range_list,
+     uint64_t start_sector,
+     uint64_t number_of_sectors,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_SECTOR_RANGE_LIST_H ) */
+
@@ -0,0 +1,1200 @@
+/*
+ * Segment corrector functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_definitions.h"
+#include "libewf_hash_sections.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcdata.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+#include "libewf_libfvalue.h"
+#include "libewf_media_values.h"
+#include "libewf_segment_corrector.h"
+#include "libewf_segment_file.h"
+#include "libewf_segment_table.h"
+#include "libewf_write_io_handle.h"
+
+#include "ewf_data.h"
+
+/* Creates a segment corrector
+ * Make sure the value segment_corrector is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_corrector_initialize(
+     libewf_segment_corrector_t **segment_corrector,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_corrector_initialize";
+	size_t entries_size   = 0;
+
+	if( segment_corrector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment corrector.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_corrector != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid segment corrector value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > LIBEWF_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*segment_corrector = memory_allocate_structure(
+	                    libewf_segment_corrector_t );
+
+	if( *segment_corrector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segment corrector.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *segment_corrector,
+	     0,
+	     sizeof( libewf_segment_corrector_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear segment corrector.",
+		 function );
+
+		memory_free(
+		 *segment_corrector );
+
+		*segment_corrector = NULL;
+
+		return( -1 );
+	}
+	( *segment_corrector )->number_of_threads         = number_of_threads;
+	( *segment_corrector )->maximum_number_of_entries = number_of_threads * LIBEWF_SEGMENT_CORRECTOR_NUMBER_OF_SEGMENTS_PER_THREAD;
+
+	/* The segment files of a batch are retrieved from the segment files cache
+	 * hence a batch should not contain more segment files than the cache can hold
+	 */
+	if( ( *segment_corrector )->maximum_number_of_entries > LIBEWF_MAXIMUM_CACHE_ENTRIES_SEGMENT_FILES )
+	{
+		( *segment_corrector )->maximum_number_of_entries = LIBEWF_MAXIMUM_CACHE_ENTRIES_SEGMENT_FILES;
+	}
+
+	entries_size = sizeof( libewf_segment_corrector_entry_t ) * ( *segment_corrector )->maximum_number_of_entries;
+
+	( *segment_corrector )->entries = (libewf_segment_corrector_entry_t *) memory_allocate(
+	                                                                    entries_size );
+
+	if( ( *segment_corrector )->entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *segment_corrector )->entries,
+	     0,
+	     entries_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entries.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *segment_corrector )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *segment_corrector )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_thread_pool_create(
+	     &( ( *segment_corrector )->thread_pool ),
+	     NULL,
+	     number_of_threads,
+	     ( *segment_corrector )->maximum_number_of_entries,
+	     (int (*)(intptr_t *, void *)) &libewf_segment_corrector_correct_callback,
+	     (void *) *segment_corrector,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread pool.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *segment_corrector != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *segment_corrector )->condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *segment_corrector )->condition ),
+			 NULL );
+		}
+		if( ( *segment_corrector )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *segment_corrector )->mutex ),
+			 NULL );
+		}
+#endif
+		if( ( *segment_corrector )->entries != NULL )
+		{
+			memory_free(
+			 ( *segment_corrector )->entries );
+		}
+		memory_free(
+		 *segment_corrector );
+
+		*segment_corrector = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a segment corrector
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_corrector_free(
+     libewf_segment_corrector_t **segment_corrector,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_corrector_free";
+	int result            = 1;
+
+	if( segment_corrector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment corrector.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_corrector != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *segment_corrector )->thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *segment_corrector )->thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_condition_free(
+		     &( ( *segment_corrector )->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *segment_corrector )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		if( libewf_segment_corrector_clear_entries(
+		     *segment_corrector,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to clear entries.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 ( *segment_corrector )->entries );
+
+		memory_free(
+		 *segment_corrector );
+
+		*segment_corrector = NULL;
+	}
+	return( result );
+}
+
+/* Clears the entries of the current batch
+ * Frees the file IO handles and the section data that was generated by the corrections
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_corrector_clear_entries(
+     libewf_segment_corrector_t *segment_corrector,
+     libcerror_error_t **error )
+{
+	libewf_segment_corrector_entry_t *entry = NULL;
+	static char *function                   = "libewf_segment_corrector_clear_entries";
+	int entry_index                         = 0;
+	int result                              = 1;
+
+	if( segment_corrector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment corrector.",
+		 function );
+
+		return( -1 );
+	}
+	for( entry_index = 0;
+	     entry_index < segment_corrector->number_of_entries;
+	     entry_index++ )
+	{
+		entry = &( segment_corrector->entries[ entry_index ] );
+
+		if( entry->file_io_handle != NULL )
+		{
+			if( libbfio_handle_free(
+			     &( entry->file_io_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free entry: %d file IO handle.",
+				 function,
+				 entry_index );
+
+				result = -1;
+			}
+		}
+		/* The section data shared with the write IO handle is freed elsewhere
+		 */
+		if( ( entry->case_data != NULL )
+		 && ( ( segment_corrector->write_io_handle == NULL )
+		  ||  ( entry->case_data != segment_corrector->write_io_handle->case_data ) ) )
+		{
+			memory_free(
+			 entry->case_data );
+		}
+		if( ( entry->device_information != NULL )
+		 && ( ( segment_corrector->write_io_handle == NULL )
+		  ||  ( entry->device_information != segment_corrector->write_io_handle->device_information ) ) )
+		{
+			memory_free(
+			 entry->device_information );
+		}
+		if( ( entry->data_section != NULL )
+		 && ( ( segment_corrector->write_io_handle == NULL )
+		  ||  ( entry->data_section != segment_corrector->write_io_handle->data_section ) ) )
+		{
+			memory_free(
+			 entry->data_section );
+		}
+		entry->case_data               = NULL;
+		entry->case_data_size          = 0;
+		entry->device_information      = NULL;
+		entry->device_information_size = 0;
+		entry->data_section            = NULL;
+		entry->segment_file            = NULL;
+	}
+	segment_corrector->number_of_entries = 0;
+
+	return( result );
+}
+
+/* Corrects the sections of the segment file of an entry
+ * The segment file is written using the file IO handle of the entry
+ * so it can be corrected in parallel with other entries
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_corrector_correct_entry(
+     libewf_segment_corrector_t *segment_corrector,
+     libewf_segment_corrector_entry_t *entry,
+     libcerror_error_t **error )
+{
+	libbfio_pool_t *file_io_pool = NULL;
+	static char *function        = "libewf_segment_corrector_correct_entry";
+
+	if( segment_corrector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment corrector.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_corrector->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment corrector - missing write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid entry - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry->segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid entry - missing segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry->file_io_pool_entry < 0 )
+	 || ( entry->file_io_pool_entry == INT_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry - file IO pool entry value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* The sections list refers to the file IO pool entry
+	 * hence the private file IO pool uses the same entry
+	 */
+	if( libbfio_pool_initialize(
+	     &file_io_pool,
+	     entry->file_io_pool_entry + 1,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_set_handle(
+	     file_io_pool,
+	     entry->file_io_pool_entry,
+	     entry->file_io_handle,
+	     LIBBFIO_OPEN_READ_WRITE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set file IO handle: %d in pool.",
+		 function,
+		 entry->file_io_pool_entry );
+
+		goto on_error;
+	}
+	/* The file IO handle is now managed by the file IO pool
+	 */
+	entry->file_io_handle = NULL;
+
+	if( libewf_segment_file_write_sections_correction(
+	     entry->segment_file,
+	     file_io_pool,
+	     entry->file_io_pool_entry,
+	     segment_corrector->write_io_handle->number_of_chunks_written_to_segment_file,
+	     entry->last_segment_file,
+	     segment_corrector->media_values,
+	     segment_corrector->header_values,
+	     segment_corrector->write_io_handle->timestamp,
+	     segment_corrector->hash_values,
+	     segment_corrector->hash_sections,
+	     segment_corrector->sessions,
+	     segment_corrector->tracks,
+	     segment_corrector->acquiry_errors,
+	     &( entry->case_data ),
+	     &( entry->case_data_size ),
+	     &( entry->device_information ),
+	     &( entry->device_information_size ),
+	     &( entry->data_section ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write sections correction to segment file: %" PRIu32 ".",
+		 function,
+		 entry->segment_number );
+
+		goto on_error;
+	}
+	if( libbfio_pool_close_all(
+	     file_io_pool,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_free(
+	     &file_io_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_io_pool != NULL )
+	{
+		libbfio_pool_close_all(
+		 file_io_pool,
+		 NULL );
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Corrects a segment file
+ * Callback function for the thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_corrector_correct_callback(
+     libewf_segment_corrector_entry_t *entry,
+     libewf_segment_corrector_t *segment_corrector )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "libewf_segment_corrector_correct_callback";
+
+	if( segment_corrector == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment corrector.",
+		 function );
+
+		goto on_error;
+	}
+	/* A segment file that could not be corrected is reported by the caller
+	 */
+	entry->result = libewf_segment_corrector_correct_entry(
+	                 segment_corrector,
+	                 entry,
+	                 &error );
+
+	if( entry->result != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to correct entry.",
+		 function );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( libcthreads_mutex_grab(
+	     segment_corrector->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	segment_corrector->number_of_pending_entries -= 1;
+
+	if( segment_corrector->number_of_pending_entries == 0 )
+	{
+		if( libcthreads_condition_broadcast(
+		     segment_corrector->condition,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 segment_corrector->mutex,
+			 NULL );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     segment_corrector->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+	}
+#endif
+	libcerror_error_free(
+	 &error );
+
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* Corrects a batch of segment files starting with a specific segment number
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_corrector_correct_batch(
+     libewf_segment_corrector_t *segment_corrector,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     uint32_t first_segment_number,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle        = NULL;
+	libewf_segment_corrector_entry_t *entry = NULL;
+	static char *function                   = "libewf_segment_corrector_correct_batch";
+	size64_t segment_file_size              = 0;
+	uint32_t number_of_segments             = 0;
+	int entry_index                         = 0;
+	int number_of_entries                   = 0;
+	int result                              = 1;
+
+	if( segment_corrector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment corrector.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_corrector->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment corrector - missing write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_segment_table_get_number_of_segments(
+	     segment_table,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments from segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( first_segment_number >= number_of_segments )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid first segment number value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_segment_corrector_clear_entries(
+	     segment_corrector,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear entries.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_entries = segment_corrector->maximum_number_of_entries;
+
+	if( (uint32_t) number_of_entries > ( number_of_segments - first_segment_number ) )
+	{
+		number_of_entries = (int) ( number_of_segments - first_segment_number );
+	}
+	/* The file IO pool and segment table are not thread-safe hence the segment files
+	 * are retrieved and the file IO handles are cloned on the calling thread
+	 */
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		entry = &( segment_corrector->entries[ entry_index ] );
+
+		entry->segment_number          = first_segment_number + (uint32_t) entry_index;
+		entry->last_segment_file       = (int) ( entry->segment_number == ( number_of_segments - 1 ) );
+		entry->file_io_handle          = NULL;
+		entry->segment_file            = NULL;
+		entry->case_data               = segment_corrector->write_io_handle->case_data;
+		entry->case_data_size          = segment_corrector->write_io_handle->case_data_size;
+		entry->device_information      = segment_corrector->write_io_handle->device_information;
+		entry->device_information_size = segment_corrector->write_io_handle->device_information_size;
+		entry->data_section            = segment_corrector->write_io_handle->data_section;
+		entry->result                  = 0;
+
+		segment_corrector->number_of_entries += 1;
+
+		if( libewf_segment_table_get_segment_by_index(
+		     segment_table,
+		     entry->segment_number,
+		     &( entry->file_io_pool_entry ),
+		     &segment_file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
+			 function,
+			 entry->segment_number );
+
+			goto on_error;
+		}
+		if( libewf_segment_table_get_segment_file_by_index(
+		     segment_table,
+		     entry->segment_number,
+		     file_io_pool,
+		     &( entry->segment_file ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
+			 function,
+			 entry->segment_number );
+
+			goto on_error;
+		}
+		if( entry->segment_file == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing segment file: %" PRIu32 ".",
+			 function,
+			 entry->segment_number );
+
+			goto on_error;
+		}
+		if( libbfio_pool_get_handle(
+		     file_io_pool,
+		     entry->file_io_pool_entry,
+		     &file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file IO handle: %d from pool.",
+			 function,
+			 entry->file_io_pool_entry );
+
+			goto on_error;
+		}
+		if( libbfio_handle_clone(
+		     &( entry->file_io_handle ),
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file IO handle: %d.",
+			 function,
+			 entry->file_io_pool_entry );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     segment_corrector->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	segment_corrector->number_of_pending_entries = number_of_entries;
+
+	if( libcthreads_mutex_release(
+	     segment_corrector->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		entry = &( segment_corrector->entries[ entry_index ] );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_thread_pool_push(
+		     segment_corrector->thread_pool,
+		     (intptr_t *) entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push entry: %d onto thread pool queue.",
+			 function,
+			 entry_index );
+
+			/* Do not wait for the entries that were not pushed
+			 */
+			libcthreads_mutex_grab(
+			 segment_corrector->mutex,
+			 NULL );
+
+			segment_corrector->number_of_pending_entries -= number_of_entries - entry_index;
+
+			libcthreads_mutex_release(
+			 segment_corrector->mutex,
+			 NULL );
+
+			result = -1;
+
+			break;
+		}
+#else
+		entry->result = libewf_segment_corrector_correct_entry(
+		                 segment_corrector,
+		                 entry,
+		                 error );
+
+		if( entry->result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to correct entry: %d.",
+			 function,
+			 entry_index );
+
+			goto on_error;
+		}
+#endif
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* Wait for the worker threads to correct the batch
+	 */
+	if( libcthreads_mutex_grab(
+	     segment_corrector->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( segment_corrector->number_of_pending_entries > 0 )
+	{
+		if( libcthreads_condition_wait(
+		     segment_corrector->condition,
+		     segment_corrector->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     segment_corrector->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		entry = &( segment_corrector->entries[ entry_index ] );
+
+		if( entry->result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write sections correction to segment file: %" PRIu32 ".",
+			 function,
+			 entry->segment_number );
+
+			return( -1 );
+		}
+	}
+#endif
+	return( result );
+
+on_error:
+	libewf_segment_corrector_clear_entries(
+	 segment_corrector,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Corrects the sections of the segment files starting with a specific segment number
+ * The section data shared by the segment files, such as the case data, device information
+ * and data section, should have been generated, e.g. by correcting the first segment file,
+ * otherwise it is generated by every correction
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_corrector_correct(
+     libewf_segment_corrector_t *segment_corrector,
+     libewf_write_io_handle_t *write_io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libfvalue_table_t *header_values,
+     libfvalue_table_t *hash_values,
+     libewf_hash_sections_t *hash_sections,
+     libcdata_array_t *sessions,
+     libcdata_array_t *tracks,
+     libewf_sector_range_list_t *acquiry_errors,
+     uint32_t first_segment_number,
+     libcerror_error_t **error )
+{
+	static char *function       = "libewf_segment_corrector_correct";
+	uint32_t number_of_segments = 0;
+	uint32_t segment_number     = 0;
+	int result                  = 1;
+
+	if( segment_corrector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment corrector.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_segment_table_get_number_of_segments(
+	     segment_table,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments from segment table.",
+		 function );
+
+		return( -1 );
+	}
+	segment_corrector->write_io_handle = write_io_handle;
+	segment_corrector->media_values    = media_values;
+	segment_corrector->header_values   = header_values;
+	segment_corrector->hash_values     = hash_values;
+	segment_corrector->hash_sections   = hash_sections;
+	segment_corrector->sessions        = sessions;
+	segment_corrector->tracks          = tracks;
+	segment_corrector->acquiry_errors  = acquiry_errors;
+
+	for( segment_number = first_segment_number;
+	     segment_number < number_of_segments;
+	     segment_number += (uint32_t) segment_corrector->maximum_number_of_entries )
+	{
+		if( libewf_segment_corrector_correct_batch(
+		     segment_corrector,
+		     file_io_pool,
+		     segment_table,
+		     segment_number,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to correct segment files starting with: %" PRIu32 ".",
+			 function,
+			 segment_number );
+
+			result = -1;
+
+			break;
+		}
+		if( libewf_segment_corrector_clear_entries(
+		     segment_corrector,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to clear entries.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+	}
+	if( result != 1 )
+	{
+		libewf_segment_corrector_clear_entries(
+		 segment_corrector,
+		 NULL );
+	}
+	segment_corrector->write_io_handle = NULL;
+	segment_corrector->media_values    = NULL;
+	segment_corrector->header_values   = NULL;
+	segment_corrector->hash_values     = NULL;
+	segment_corrector->hash_sections   = NULL;
+	segment_corrector->sessions        = NULL;
+	segment_corrector->tracks          = NULL;
+	segment_corrector->acquiry_errors  = NULL;
+
+	return( result );
+}
+
@@ -0,0 +1,227 @@
+/*
+ * Segment corrector functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_SEGMENT_CORRECTOR_H )
+#define _LIBEWF_SEGMENT_CORRECTOR_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_hash_sections.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcdata.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_libfvalue.h"
+#include "libewf_media_values.h"
+#include "libewf_sector_range_list.h"
+#include "libewf_segment_file.h"
+#include "libewf_segment_table.h"
+#include "libewf_write_io_handle.h"
+
+#include "ewf_data.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_segment_corrector_entry libewf_segment_corrector_entry_t;
+
+/* A segment file of which the sections are corrected by the segment corrector
+ */
+struct libewf_segment_corrector_entry
+{
+	/* The segment number
+	 */
+	uint32_t segment_number;
+
+	/* The file IO pool entry
+	 */
+	int file_io_pool_entry;
+
+	/* Value to indicate the segment file is the last segment file
+	 */
+	int last_segment_file;
+
+	/* The file IO handle used to correct the segment file
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The segment file, which is managed by the segment table
+	 */
+	libewf_segment_file_t *segment_file;
+
+	/* The case data used by the correction, which is shared
+	 * with the write IO handle unless generated by the correction
+	 */
+	uint8_t *case_data;
+
+	/* The case data size
+	 */
+	size_t case_data_size;
+
+	/* The device information used by the correction, which is shared
+	 * with the write IO handle unless generated by the correction
+	 */
+	uint8_t *device_information;
+
+	/* The device information size
+	 */
+	size_t device_information_size;
+
+	/* The data section used by the correction, which is shared
+	 * with the write IO handle unless generated by the correction
+	 */
+	ewf_data_t *data_section;
+
+	/* The result of the correction
+	 */
+	int result;
+};
+
+typedef struct libewf_segment_corrector libewf_segment_corrector_t;
+
+/* The segment corrector corrects the sections of batches of segment files
+ * after a streamed write using a pool of worker threads
+ */
+struct libewf_segment_corrector
+{
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+	/* The entries of the current batch
+	 */
+	libewf_segment_corrector_entry_t *entries;
+
+	/* The maximum number of entries per batch
+	 */
+	int maximum_number_of_entries;
+
+	/* The number of entries of the current batch
+	 */
+	int number_of_entries;
+
+	/* The number of entries of the current batch that still need to be corrected
+	 */
+	int number_of_pending_entries;
+
+	/* The write IO handle of the current correction
+	 */
+	libewf_write_io_handle_t *write_io_handle;
+
+	/* The media values of the current correction
+	 */
+	libewf_media_values_t *media_values;
+
+	/* The header values of the current correction
+	 */
+	libfvalue_table_t *header_values;
+
+	/* The hash values of the current correction
+	 */
+	libfvalue_table_t *hash_values;
+
+	/* The hash sections of the current correction
+	 */
+	libewf_hash_sections_t *hash_sections;
+
+	/* The sessions of the current correction
+	 */
+	libcdata_array_t *sessions;
+
+	/* The tracks of the current correction
+	 */
+	libcdata_array_t *tracks;
+
+	/* The acquiry errors of the current correction
+	 */
+	libewf_sector_range_list_t *acquiry_errors;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when the current batch was corrected
+	 */
+	libcthreads_condition_t *condition;
+#endif
+};
+
+int libewf_segment_corrector_initialize(
+     libewf_segment_corrector_t **segment_corrector,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libewf_segment_corrector_free(
+     libewf_segment_corrector_t **segment_corrector,
+     libcerror_error_t **error );
+
+int libewf_segment_corrector_clear_entries(
+     libewf_segment_corrector_t *segment_corrector,
+     libcerror_error_t **error );
+
+int libewf_segment_corrector_correct_entry(
+     libewf_segment_corrector_t *segment_corrector,
+     libewf_segment_corrector_entry_t *entry,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+int libewf_segment_corrector_correct_callback(
+     libewf_segment_corrector_entry_t *entry,
+     libewf_segment_corrector_t *segment_corrector );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+int libewf_segment_corrector_correct_batch(
+     libewf_segment_corrector_t *segment_corrector,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     uint32_t first_segment_number,
+     libcerror_error_t **error );
+
+int libewf_segment_corrector_correct(
+     libewf_segment_corrector_t *segment_corrector,
+     libewf_write_io_handle_t *write_io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libfvalue_table_t *header_values,
+     libfvalue_table_t *hash_values,
+     libewf_hash_sections_t *hash_sections,
+     libcdata_array_t *sessions,
+     libcdata_array_t *tracks,
+     libewf_sector_range_list_t *acquiry_errors,
+     uint32_t first_segment_number,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_SEGMENT_CORRECTOR_H ) */
+
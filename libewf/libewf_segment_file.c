@@ -36,6 +36,8 @@
 
 #include "libewf_case_data.h"
 #include "libewf_chunk_data.h"
+#include "libewf_chunk_group.h"
+#include "libewf_chunk_scanner.h"
 #include "libewf_debug.h"
 #include "libewf_definitions.h"
 #include "libewf_device_information.h"
@@ -52,19 +54,25 @@
 #include "libewf_libfdata.h"
 #include "libewf_libfguid.h"
 #include "libewf_libfvalue.h"
+#include "libewf_ltree_section.h"
 #include "libewf_md5_hash_section.h"
+#include "libewf_memory_accounting.h"
 #include "libewf_section.h"
 #include "libewf_section_descriptor.h"
 #include "libewf_segment_file.h"
+#include "libewf_segment_index.h"
 #include "libewf_segment_table.h"
 #include "libewf_session_section.h"
 #include "libewf_sha1_hash_section.h"
 #include "libewf_single_files.h"
+#include "libewf_statistics.h"
+#include "libewf_trace.h"
 #include "libewf_unused.h"
 #include "libewf_volume_section.h"
 
 #include "ewf_file_header.h"
 #include "ewf_section.h"
+#include "ewf_segment_index.h"
 #include "ewf_volume.h"
 
 const uint8_t ewf1_dvf_file_signature[ 8 ] = { 0x64, 0x76, 0x66, 0x09, 0x0d, 0x0a, 0xff, 0x00 };
@@ -195,6 +203,11 @@ int libewf_segment_file_initialize(
 	( *segment_file )->last_chunk_filled                = -1;
 	( *segment_file )->last_chunk_compared              = -1;
 
+	LIBEWF_MEMORY_ACCOUNTING_UPDATE(
+	 LIBEWF_MEMORY_TYPE_SEGMENT_FILE,
+	 *segment_file,
+	 sizeof( libewf_segment_file_t ) );
+
 	return( 1 );
 
 on_error:
@@ -243,6 +256,9 @@ int libewf_segment_file_free(
 	}
 	if( *segment_file != NULL )
 	{
+		LIBEWF_TRACE_SEGMENT_FILE_CLOSE(
+		 ( *segment_file )->segment_number );
+
 		/* The io_handle reference is freed elsewhere
 		 */
 		if( libfdata_list_free(
@@ -271,6 +287,38 @@ int libewf_segment_file_free(
 
 			result = -1;
 		}
+		if( ( *segment_file )->recovered_chunk_groups != NULL )
+		{
+			if( libcdata_array_free(
+			     &( ( *segment_file )->recovered_chunk_groups ),
+			     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_group_free,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free recovered chunk groups array.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *segment_file )->write_buffer != NULL )
+		{
+			memory_free(
+			 ( *segment_file )->write_buffer );
+		}
+		if( ( *segment_file )->table_buffer != NULL )
+		{
+			memory_free(
+			 ( *segment_file )->table_buffer );
+		}
+		LIBEWF_MEMORY_ACCOUNTING_UPDATE(
+		 LIBEWF_MEMORY_TYPE_SEGMENT_FILE,
+		 *segment_file,
+		 0 );
+
 		memory_free(
 		 *segment_file );
 
@@ -350,8 +398,17 @@ int libewf_segment_file_clone(
 
 		return( -1 );
 	}
-	( *destination_segment_file )->sections_list     = NULL;
-	( *destination_segment_file )->chunk_groups_list = NULL;
+	( *destination_segment_file )->sections_list          = NULL;
+	( *destination_segment_file )->chunk_groups_list      = NULL;
+	( *destination_segment_file )->recovered_chunk_groups = NULL;
+	( *destination_segment_file )->write_buffer           = NULL;
+	( *destination_segment_file )->write_buffer_data_size = 0;
+	( *destination_segment_file )->table_buffer           = NULL;
+	( *destination_segment_file )->table_buffer_size      = 0;
+
+#if defined( HAVE_LIBEWF_MEMORY_ACCOUNTING )
+	( *destination_segment_file )->accounted_memory_size = 0;
+#endif
 
 	if( libfdata_list_clone(
 	     &( ( *destination_segment_file )->sections_list ),
@@ -381,11 +438,52 @@ int libewf_segment_file_clone(
 
 		goto on_error;
 	}
+	if( source_segment_file->recovered_chunk_groups != NULL )
+	{
+		if( libcdata_array_clone(
+		     &( ( *destination_segment_file )->recovered_chunk_groups ),
+		     source_segment_file->recovered_chunk_groups,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_group_free,
+		     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) &libewf_chunk_group_clone,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create destination recovered chunk groups array.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBEWF_MEMORY_ACCOUNTING )
+	if( libewf_segment_file_update_memory_accounting(
+	     *destination_segment_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update memory accounting.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	return( 1 );
 
 on_error:
 	if( *destination_segment_file != NULL )
 	{
+		if( ( *destination_segment_file )->recovered_chunk_groups != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *destination_segment_file )->recovered_chunk_groups ),
+			 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_group_free,
+			 NULL );
+		}
 		if( ( *destination_segment_file )->chunk_groups_list != NULL )
 		{
 			libfdata_list_free(
@@ -406,6 +504,79 @@ on_error:
 	return( -1 );
 }
 
+#if defined( HAVE_LIBEWF_MEMORY_ACCOUNTING )
+
+/* Updates the size of the memory accounted for the segment file
+ * The size of the elements of the sections and chunk groups lists is estimated
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_update_memory_accounting(
+     libewf_segment_file_t *segment_file,
+     libcerror_error_t **error )
+{
+	static char *function      = "libewf_segment_file_update_memory_accounting";
+	size_t memory_size         = 0;
+	int number_of_chunk_groups = 0;
+	int number_of_sections     = 0;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_get_number_of_elements(
+	     segment_file->sections_list,
+	     &number_of_sections,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of elements from sections list.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_get_number_of_elements(
+	     segment_file->chunk_groups_list,
+	     &number_of_chunk_groups,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of elements from chunk groups list.",
+		 function );
+
+		return( -1 );
+	}
+	memory_size = sizeof( libewf_segment_file_t )
+	            + ( (size_t) number_of_sections * ( LIBEWF_MEMORY_ACCOUNTING_LIST_ELEMENT_SIZE + sizeof( libewf_section_descriptor_t ) ) )
+	            + ( (size_t) number_of_chunk_groups * LIBEWF_MEMORY_ACCOUNTING_LIST_ELEMENT_SIZE )
+	            + segment_file->table_buffer_size;
+
+	if( segment_file->write_buffer != NULL )
+	{
+		memory_size += LIBEWF_SEGMENT_FILE_WRITE_BUFFER_SIZE;
+	}
+	LIBEWF_MEMORY_ACCOUNTING_UPDATE(
+	 LIBEWF_MEMORY_TYPE_SEGMENT_FILE,
+	 segment_file,
+	 memory_size );
+
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MEMORY_ACCOUNTING ) */
+
 /* Retrieves the number of segments
  * Returns 1 if successful or -1 on error
  */
@@ -1258,6 +1429,7 @@ ssize_t libewf_segment_file_read_table_section(
 		return( -1 );
 	}
 	segment_file->previous_last_chunk_filled = segment_file->last_chunk_filled;
+	segment_file->table_is_valid             = 0;
 
 	read_count = libewf_section_table_read(
 	              section_descriptor,
@@ -1353,6 +1525,14 @@ ssize_t libewf_segment_file_read_table_section(
 		segment_file->storage_media_size += storage_media_size;
 		segment_file->number_of_chunks   += (uint64_t) number_of_entries;
 		segment_file->last_chunk_filled  += (int64_t) number_of_entries;
+
+		/* The table2 section is only needed to correct a table section
+		 * that is corrupted or contains no entries
+		 */
+		if( entries_corrupted == 0 )
+		{
+			segment_file->table_is_valid = 1;
+		}
 	}
 	memory_free(
 	 section_data );
@@ -1369,6 +1549,7 @@ on_error:
 }
 
 /* Reads the table2 section
+ * The table2 section is not read if the preceding table section is valid
  * Returns the number of bytes read or -1 on error
  */
 ssize_t libewf_segment_file_read_table2_section(
@@ -1451,6 +1632,20 @@ ssize_t libewf_segment_file_read_table2_section(
 
 		return( -1 );
 	}
+	if( segment_file->table_is_valid != 0 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: table section is valid, skipping table2 section.\n",
+			 function );
+		}
+#endif
+		segment_file->table_is_valid = 0;
+
+		return( 0 );
+	}
 	read_count = libewf_section_table_read(
 	              section_descriptor,
 	              segment_file->io_handle,
@@ -1584,13 +1779,44 @@ ssize_t libewf_segment_file_read_table2_section(
 				 function );
 			}
 #endif
+			chunk_group_range_flags = LIBEWF_RANGE_FLAG_IS_CORRUPTED;
+
+			if( chunk_group_number_of_entries > 0 )
+			{
+				/* Try to recover the chunks by scanning the chunk data
+				 */
+				result = libewf_segment_file_recover_chunk_group(
+				          segment_file,
+				          file_io_pool,
+				          chunk_group_file_io_pool_entry,
+				          chunk_group_data_offset,
+				          (uint32_t) chunk_group_number_of_entries,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GENERIC,
+					 "%s: unable to recover chunk group: %d.",
+					 function,
+					 segment_file->chunk_groups_index );
+
+					goto on_error;
+				}
+				else if( result != 0 )
+				{
+					chunk_group_range_flags = LIBEWF_RANGE_FLAG_IS_TAINTED;
+				}
+			}
 			result = libfdata_list_set_element_by_index(
 				  segment_file->chunk_groups_list,
 				  segment_file->chunk_groups_index,
 				  chunk_group_file_io_pool_entry,
 				  chunk_group_data_offset,
 				  chunk_group_data_size,
-				  LIBEWF_RANGE_FLAG_IS_CORRUPTED,
+				  chunk_group_range_flags,
 				  error );
 		}
 		if( result != 1 )
@@ -1622,19 +1848,36 @@ on_error:
 	return( -1 );
 }
 
-/* Reads a volume section
- * Returns the number of bytes read if successful or -1 on error
+/* Recovers the chunk group of a table section of which the entries are corrupted
+ * The chunks are recovered by scanning the chunk data in the sectors section
+ * that precedes the table section, which requires that the number of chunks
+ * found matches the number of entries
+ * Returns 1 if successful, 0 if the chunk group could not be recovered or -1 on error
  */
-ssize_t libewf_segment_file_read_volume_section(
-         libewf_segment_file_t *segment_file,
-         libewf_section_descriptor_t *section_descriptor,
-         libbfio_pool_t *file_io_pool,
-         int file_io_pool_entry,
-         libewf_media_values_t *media_values,
-         libcerror_error_t **error )
+int libewf_segment_file_recover_chunk_group(
+     libewf_segment_file_t *segment_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t table_section_offset,
+     uint32_t number_of_entries,
+     libcerror_error_t **error )
 {
-	static char *function = "libewf_segment_file_read_volume_section";
-	ssize_t read_count    = 0;
+	libewf_chunk_group_t *chunk_group               = NULL;
+	libewf_chunk_scanner_t *chunk_scanner           = NULL;
+	libewf_section_descriptor_t *section_descriptor = NULL;
+	static char *function                           = "libewf_segment_file_recover_chunk_group";
+	off64_t element_offset                          = 0;
+	off64_t sectors_data_offset                     = 0;
+	size64_t element_size                           = 0;
+	ssize_t read_count                              = 0;
+	uint32_t element_flags                          = 0;
+	uint32_t number_of_chunks                       = 0;
+	int element_file_io_pool_entry                  = 0;
+	int entry_index                                 = 0;
+	int number_of_recovered_chunk_groups            = 0;
+	int number_of_sections                          = 0;
+	int result                                      = 0;
+	int section_index                               = 0;
 
 	if( segment_file == NULL )
 	{
@@ -1647,249 +1890,326 @@ ssize_t libewf_segment_file_read_volume_section(
 
 		return( -1 );
 	}
-	if( section_descriptor == NULL )
+	if( segment_file->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid section.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment file - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( media_values == NULL )
+	if( segment_file->major_version != 1 )
+	{
+		return( 0 );
+	}
+	if( libfdata_list_get_number_of_elements(
+	     segment_file->sections_list,
+	     &number_of_sections,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid media values.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sections.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( section_descriptor->data_size == (size64_t) sizeof( ewf_volume_t ) )
+	/* Determine the index of the table section in the sections list
+	 */
+	for( section_index = number_of_sections - 1;
+	     section_index > 0;
+	     section_index-- )
 	{
-		read_count = libewf_volume_section_e01_read(
-		              section_descriptor,
-		              segment_file->io_handle,
-		              file_io_pool,
-		              file_io_pool_entry,
-		              media_values,
-		              error );
-
-		if( read_count != (ssize_t) section_descriptor->data_size )
+		if( libfdata_list_get_element_by_index(
+		     segment_file->sections_list,
+		     section_index,
+		     &element_file_io_pool_entry,
+		     &element_offset,
+		     &element_size,
+		     &element_flags,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read EWF-E01 volume section.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve section: %d from sections list.",
+			 function,
+			 section_index );
 
-			return( -1 );
+			goto on_error;
+		}
+		if( element_offset == table_section_offset )
+		{
+			break;
 		}
 	}
-	else if( section_descriptor->data_size == (size64_t) sizeof( ewf_volume_smart_t ) )
+	if( section_index <= 0 )
 	{
-		read_count = libewf_volume_section_s01_read(
-		              section_descriptor,
-		              segment_file->io_handle,
-		              file_io_pool,
-		              file_io_pool_entry,
-		              media_values,
-		              error );
-
-		if( read_count != (ssize_t) section_descriptor->data_size )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read EWF-S01 volume section.",
-			 function );
+		return( 0 );
+	}
+	/* The chunk data is stored in the sectors section that precedes the table section
+	 */
+	if( libfdata_list_get_element_by_index(
+	     segment_file->sections_list,
+	     section_index - 1,
+	     &element_file_io_pool_entry,
+	     &element_offset,
+	     &element_size,
+	     &element_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve section: %d from sections list.",
+		 function,
+		 section_index - 1 );
 
-			return( -1 );
-		}
-		segment_file->type = LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART;
+		goto on_error;
 	}
-	else
+	if( libewf_section_descriptor_initialize(
+	     &section_descriptor,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid section size value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create section descriptor.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	segment_file->current_offset += read_count;
-
-	return( read_count );
-}
+	read_count = libewf_section_descriptor_read(
+		      section_descriptor,
+		      file_io_pool,
+		      file_io_pool_entry,
+		      element_offset,
+		      segment_file->major_version,
+		      error );
 
-/* Writes a device information section to file
- * Returns the number of bytes written or -1 on error
- */
-ssize_t libewf_segment_file_write_device_information_section(
-         libewf_segment_file_t *segment_file,
-         libbfio_pool_t *file_io_pool,
-         int file_io_pool_entry,
-         uint8_t **device_information,
-         size_t *device_information_size,
-         libewf_media_values_t *media_values,
-         libfvalue_table_t *header_values,
-         libcerror_error_t **error )
-{
-	libewf_section_descriptor_t *section_descriptor = NULL;
-	static char *function                           = "libewf_segment_file_write_device_information_section";
-	ssize_t write_count                             = 0;
-	int element_index                               = 0;
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read section descriptor.",
+		 function );
 
-	if( segment_file == NULL )
+		goto on_error;
+	}
+	if( section_descriptor->type == LIBEWF_SECTION_TYPE_SECTOR_DATA )
+	{
+		sectors_data_offset = element_offset + read_count;
+	}
+	if( libewf_section_descriptor_free(
+	     &section_descriptor,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid segment file.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free section descriptor.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( segment_file->io_handle == NULL )
+	if( ( sectors_data_offset == 0 )
+	 || ( sectors_data_offset >= table_section_offset ) )
+	{
+		return( 0 );
+	}
+	if( libewf_chunk_group_initialize(
+	     &chunk_group,
+	     segment_file->io_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid segment file - missing IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk group.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( device_information == NULL )
+	if( libewf_chunk_scanner_initialize(
+	     &chunk_scanner,
+	     segment_file->io_handle->chunk_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid device information.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk scanner.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( device_information_size == NULL )
+	result = libewf_chunk_scanner_scan(
+	          chunk_scanner,
+	          file_io_pool,
+	          file_io_pool_entry,
+	          sectors_data_offset,
+	          table_section_offset,
+	          chunk_group,
+	          number_of_entries,
+	          &number_of_chunks,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid device information size.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to scan chunk data.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( *device_information == NULL )
+	if( libewf_chunk_scanner_free(
+	     &chunk_scanner,
+	     error ) != 1 )
 	{
-		if( libewf_device_information_generate(
-		     device_information,
-		     device_information_size,
-		     media_values,
-		     header_values,
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free chunk scanner.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( result == 0 )
+	 || ( number_of_chunks != number_of_entries ) )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: unable to recover chunk group: %d number of chunks found does not match number of entries: %" PRIu32 ".\n",
+			 function,
+			 segment_file->chunk_groups_index,
+			 number_of_entries );
+		}
+#endif
+		if( libewf_chunk_group_free(
+		     &chunk_group,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to generate device information.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk group.",
 			 function );
 
 			goto on_error;
 		}
+		return( 0 );
 	}
-	if( libewf_section_descriptor_initialize(
-	     &section_descriptor,
+	if( segment_file->recovered_chunk_groups == NULL )
+	{
+		if( libcdata_array_initialize(
+		     &( segment_file->recovered_chunk_groups ),
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create recovered chunk groups array.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libcdata_array_get_number_of_entries(
+	     segment_file->recovered_chunk_groups,
+	     &number_of_recovered_chunk_groups,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create section descriptor.descriptor.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of recovered chunk groups.",
 		 function );
 
 		goto on_error;
 	}
-	/* Do not include the end of string character in the compressed data
-	 */
-	write_count = libewf_section_write_compressed_string(
-	               section_descriptor,
-	               segment_file->io_handle,
-	               file_io_pool,
-	               file_io_pool_entry,
-	               2,
-	               LIBEWF_SECTION_TYPE_DEVICE_INFORMATION,
-	               NULL,
-	               0,
-	               segment_file->current_offset,
-	               segment_file->io_handle->compression_method,
-	               LIBEWF_COMPRESSION_DEFAULT,
-	               *device_information,
-	               *device_information_size - 2,
-	               0,
-	               error );
+	entry_index = segment_file->chunk_groups_index;
 
-	if( write_count == -1 )
+	if( entry_index >= number_of_recovered_chunk_groups )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write device information section.",
-		 function );
+		if( libcdata_array_resize(
+		     segment_file->recovered_chunk_groups,
+		     entry_index + 1,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_group_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize recovered chunk groups array.",
+			 function );
 
-		goto on_error;
+			goto on_error;
+		}
 	}
-	segment_file->current_offset += write_count;
-
-	if( libewf_section_descriptor_free(
-	     &section_descriptor,
+	if( libcdata_array_set_entry_by_index(
+	     segment_file->recovered_chunk_groups,
+	     entry_index,
+	     (intptr_t *) chunk_group,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free section.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set recovered chunk group: %d in array.",
+		 function,
+		 entry_index );
 
 		goto on_error;
 	}
-	if( libfdata_list_append_element(
-	     segment_file->sections_list,
-	     &element_index,
-	     file_io_pool_entry,
-	     segment_file->current_offset - sizeof( ewf_section_descriptor_v2_t ),
-	     sizeof( ewf_section_descriptor_v2_t ),
-	     0,
-	     error ) != 1 )
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to append section to sections list.",
-		 function );
-
-		goto on_error;
+		libcnotify_printf(
+		 "%s: recovered chunk group: %d from chunk data.\n",
+		 function,
+		 entry_index );
 	}
-	return( write_count );
+#endif
+	return( 1 );
 
 on_error:
+	if( chunk_scanner != NULL )
+	{
+		libewf_chunk_scanner_free(
+		 &chunk_scanner,
+		 NULL );
+	}
+	if( chunk_group != NULL )
+	{
+		libewf_chunk_group_free(
+		 &chunk_group,
+		 NULL );
+	}
 	if( section_descriptor != NULL )
 	{
 		libewf_section_descriptor_free(
@@ -1899,24 +2219,19 @@ on_error:
 	return( -1 );
 }
 
-/* Writes a case data section to file
- * Returns the number of bytes written or -1 on error
+/* Reads a volume section
+ * Returns the number of bytes read if successful or -1 on error
  */
-ssize_t libewf_segment_file_write_case_data_section(
+ssize_t libewf_segment_file_read_volume_section(
          libewf_segment_file_t *segment_file,
+         libewf_section_descriptor_t *section_descriptor,
          libbfio_pool_t *file_io_pool,
          int file_io_pool_entry,
-         uint8_t **case_data,
-         size_t *case_data_size,
          libewf_media_values_t *media_values,
-         libfvalue_table_t *header_values,
-         time_t timestamp,
          libcerror_error_t **error )
 {
-	libewf_section_descriptor_t *section_descriptor = NULL;
-	static char *function                           = "libewf_segment_file_write_case_data_section";
-	ssize_t write_count                             = 0;
-	int element_index                               = 0;
+	static char *function = "libewf_segment_file_read_volume_section";
+	ssize_t read_count    = 0;
 
 	if( segment_file == NULL )
 	{
@@ -1929,63 +2244,173 @@ ssize_t libewf_segment_file_write_case_data_section(
 
 		return( -1 );
 	}
-	if( segment_file->io_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid segment file - missing IO handle.",
-		 function );
-
-		return( -1 );
-	}
-	if( case_data == NULL )
+	if( section_descriptor == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid case data.",
+		 "%s: invalid section.",
 		 function );
 
 		return( -1 );
 	}
-	if( case_data_size == NULL )
+	if( media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid case data size.",
+		 "%s: invalid media values.",
 		 function );
 
 		return( -1 );
 	}
-	if( *case_data == NULL )
+	if( section_descriptor->data_size == (size64_t) sizeof( ewf_volume_t ) )
 	{
-		if( libewf_case_data_generate(
-		     case_data,
-		     case_data_size,
-		     media_values,
-		     header_values,
-		     timestamp,
-		     segment_file->io_handle->format,
-		     error ) != 1 )
+		read_count = libewf_volume_section_e01_read(
+		              section_descriptor,
+		              segment_file->io_handle,
+		              file_io_pool,
+		              file_io_pool_entry,
+		              media_values,
+		              error );
+
+		if( read_count != (ssize_t) section_descriptor->data_size )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to generate case data.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read EWF-E01 volume section.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
 	}
-	if( libewf_section_descriptor_initialize(
-	     &section_descriptor,
-	     error ) != 1 )
+	else if( section_descriptor->data_size == (size64_t) sizeof( ewf_volume_smart_t ) )
+	{
+		read_count = libewf_volume_section_s01_read(
+		              section_descriptor,
+		              segment_file->io_handle,
+		              file_io_pool,
+		              file_io_pool_entry,
+		              media_values,
+		              error );
+
+		if( read_count != (ssize_t) section_descriptor->data_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read EWF-S01 volume section.",
+			 function );
+
+			return( -1 );
+		}
+		segment_file->type = LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid section size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	segment_file->current_offset += read_count;
+
+	return( read_count );
+}
+
+/* Writes a device information section to file
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_segment_file_write_device_information_section(
+         libewf_segment_file_t *segment_file,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         uint8_t **device_information,
+         size_t *device_information_size,
+         libewf_media_values_t *media_values,
+         libfvalue_table_t *header_values,
+         libcerror_error_t **error )
+{
+	libewf_section_descriptor_t *section_descriptor = NULL;
+	static char *function                           = "libewf_segment_file_write_device_information_section";
+	ssize_t write_count                             = 0;
+	int element_index                               = 0;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_information == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device information.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_information_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device information size.",
+		 function );
+
+		return( -1 );
+	}
+	if( *device_information == NULL )
+	{
+		if( libewf_device_information_generate(
+		     device_information,
+		     device_information_size,
+		     media_values,
+		     header_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to generate device information.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_section_descriptor_initialize(
+	     &section_descriptor,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -2004,14 +2429,14 @@ ssize_t libewf_segment_file_write_case_data_section(
 	               file_io_pool,
 	               file_io_pool_entry,
 	               2,
-	               LIBEWF_SECTION_TYPE_CASE_DATA,
+	               LIBEWF_SECTION_TYPE_DEVICE_INFORMATION,
 	               NULL,
 	               0,
 	               segment_file->current_offset,
 	               segment_file->io_handle->compression_method,
 	               LIBEWF_COMPRESSION_DEFAULT,
-	               *case_data,
-	               *case_data_size - 2,
+	               *device_information,
+	               *device_information_size - 2,
 	               0,
 	               error );
 
@@ -2021,7 +2446,7 @@ ssize_t libewf_segment_file_write_case_data_section(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write case data section.",
+		 "%s: unable to write device information section.",
 		 function );
 
 		goto on_error;
@@ -2071,19 +2496,22 @@ on_error:
 	return( -1 );
 }
 
-/* Writes a header section to file
+/* Writes a case data section to file
  * Returns the number of bytes written or -1 on error
  */
-ssize_t libewf_segment_file_write_header_section(
+ssize_t libewf_segment_file_write_case_data_section(
          libewf_segment_file_t *segment_file,
          libbfio_pool_t *file_io_pool,
          int file_io_pool_entry,
-         libewf_header_sections_t *header_sections,
-         int8_t compression_level,
+         uint8_t **case_data,
+         size_t *case_data_size,
+         libewf_media_values_t *media_values,
+         libfvalue_table_t *header_values,
+         time_t timestamp,
          libcerror_error_t **error )
 {
 	libewf_section_descriptor_t *section_descriptor = NULL;
-	static char *function                           = "libewf_segment_file_write_header_section";
+	static char *function                           = "libewf_segment_file_write_case_data_section";
 	ssize_t write_count                             = 0;
 	int element_index                               = 0;
 
@@ -2109,29 +2537,49 @@ ssize_t libewf_segment_file_write_header_section(
 
 		return( -1 );
 	}
-	if( header_sections == NULL )
+	if( case_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid header sections.",
+		 "%s: invalid case data.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( header_sections->header == NULL )
-	 || ( header_sections->header_size == 0 ) )
+	if( case_data_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid header sections - missing header.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid case data size.",
 		 function );
 
 		return( -1 );
 	}
+	if( *case_data == NULL )
+	{
+		if( libewf_case_data_generate(
+		     case_data,
+		     case_data_size,
+		     media_values,
+		     header_values,
+		     timestamp,
+		     segment_file->io_handle->format,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to generate case data.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( libewf_section_descriptor_initialize(
 	     &section_descriptor,
 	     error ) != 1 )
@@ -2152,15 +2600,15 @@ ssize_t libewf_segment_file_write_header_section(
 	               segment_file->io_handle,
 	               file_io_pool,
 	               file_io_pool_entry,
-	               1,
+	               2,
+	               LIBEWF_SECTION_TYPE_CASE_DATA,
+	               NULL,
 	               0,
-	               (uint8_t *) "header",
-	               6,
 	               segment_file->current_offset,
 	               segment_file->io_handle->compression_method,
-	               compression_level,
-	               header_sections->header,
-	               header_sections->header_size - 1,
+	               LIBEWF_COMPRESSION_DEFAULT,
+	               *case_data,
+	               *case_data_size - 2,
 	               0,
 	               error );
 
@@ -2170,25 +2618,7 @@ ssize_t libewf_segment_file_write_header_section(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write header section.",
-		 function );
-
-		goto on_error;
-	}
-	if( libfdata_list_append_element(
-	     segment_file->sections_list,
-	     &element_index,
-	     file_io_pool_entry,
-	     segment_file->current_offset,
-	     sizeof( ewf_section_descriptor_v1_t ),
-	     0,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to append section to sections list.",
+		 "%s: unable to write case data section.",
 		 function );
 
 		goto on_error;
@@ -2208,28 +2638,24 @@ ssize_t libewf_segment_file_write_header_section(
 
 		goto on_error;
 	}
-	header_sections->number_of_header_sections += 1;
-
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	if( libfdata_list_append_element(
+	     segment_file->sections_list,
+	     &element_index,
+	     file_io_pool_entry,
+	     segment_file->current_offset - sizeof( ewf_section_descriptor_v2_t ),
+	     sizeof( ewf_section_descriptor_v2_t ),
+	     0,
+	     error ) != 1 )
 	{
-		if( libewf_debug_byte_stream_print(
-		     "Header",
-		     header_sections->header,
-		     header_sections->header_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-			 "%s: unable to print header.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append section to sections list.",
+		 function );
 
-			goto on_error;
-		}
+		goto on_error;
 	}
-#endif
 	return( write_count );
 
 on_error:
@@ -2242,18 +2668,19 @@ on_error:
 	return( -1 );
 }
 
-/* Writes a header2 section to file
+/* Writes a header section to file
  * Returns the number of bytes written or -1 on error
  */
-ssize_t libewf_segment_file_write_header2_section(
+ssize_t libewf_segment_file_write_header_section(
          libewf_segment_file_t *segment_file,
          libbfio_pool_t *file_io_pool,
          int file_io_pool_entry,
          libewf_header_sections_t *header_sections,
+         int8_t compression_level,
          libcerror_error_t **error )
 {
 	libewf_section_descriptor_t *section_descriptor = NULL;
-	static char *function                           = "libewf_segment_file_write_header2_section";
+	static char *function                           = "libewf_segment_file_write_header_section";
 	ssize_t write_count                             = 0;
 	int element_index                               = 0;
 
@@ -2290,14 +2717,184 @@ ssize_t libewf_segment_file_write_header2_section(
 
 		return( -1 );
 	}
-	if( ( header_sections->header2 == NULL )
-	 || ( header_sections->header2_size == 0 ) )
+	if( ( header_sections->header == NULL )
+	 || ( header_sections->header_size == 0 ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid header sections - missing header2.",
+		 "%s: invalid header sections - missing header.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_section_descriptor_initialize(
+	     &section_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create section descriptor.descriptor.",
+		 function );
+
+		goto on_error;
+	}
+	/* Do not include the end of string character in the compressed data
+	 */
+	write_count = libewf_section_write_compressed_string(
+	               section_descriptor,
+	               segment_file->io_handle,
+	               file_io_pool,
+	               file_io_pool_entry,
+	               1,
+	               0,
+	               (uint8_t *) "header",
+	               6,
+	               segment_file->current_offset,
+	               segment_file->io_handle->compression_method,
+	               compression_level,
+	               header_sections->header,
+	               header_sections->header_size - 1,
+	               0,
+	               error );
+
+	if( write_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write header section.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_list_append_element(
+	     segment_file->sections_list,
+	     &element_index,
+	     file_io_pool_entry,
+	     segment_file->current_offset,
+	     sizeof( ewf_section_descriptor_v1_t ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append section to sections list.",
+		 function );
+
+		goto on_error;
+	}
+	segment_file->current_offset += write_count;
+
+	if( libewf_section_descriptor_free(
+	     &section_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free section.",
+		 function );
+
+		goto on_error;
+	}
+	header_sections->number_of_header_sections += 1;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		if( libewf_debug_byte_stream_print(
+		     "Header",
+		     header_sections->header,
+		     header_sections->header_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print header.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	return( write_count );
+
+on_error:
+	if( section_descriptor != NULL )
+	{
+		libewf_section_descriptor_free(
+		 &section_descriptor,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes a header2 section to file
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_segment_file_write_header2_section(
+         libewf_segment_file_t *segment_file,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         libewf_header_sections_t *header_sections,
+         libcerror_error_t **error )
+{
+	libewf_section_descriptor_t *section_descriptor = NULL;
+	static char *function                           = "libewf_segment_file_write_header2_section";
+	ssize_t write_count                             = 0;
+	int element_index                               = 0;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( header_sections == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid header sections.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( header_sections->header2 == NULL )
+	 || ( header_sections->header2_size == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid header sections - missing header2.",
 		 function );
 
 		return( -1 );
@@ -3520,6 +4117,23 @@ ssize_t libewf_segment_file_write_chunks_section_end(
 
 		return( -1 );
 	}
+	/* The chunks must be written before the table and section descriptor
+	 */
+	if( libewf_segment_file_flush_write_buffer(
+	     segment_file,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     error ) < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush write buffer.",
+		 function );
+
+		return( -1 );
+	}
 /* TODO what about linen 7 */
 	if( ( segment_file->io_handle->format == LIBEWF_FORMAT_ENCASE6 )
 	 || ( segment_file->io_handle->format == LIBEWF_FORMAT_ENCASE7 )
@@ -3572,6 +4186,17 @@ ssize_t libewf_segment_file_write_chunks_section_end(
 	 || ( segment_file->type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_LOGICAL )
 	 || ( segment_file->type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART ) )
 	{
+		if( ( segment_file->io_handle->access_flags & LIBEWF_ACCESS_FLAG_SEQUENTIAL ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unable to correct chunks section descriptor on sequential write.",
+			 function );
+
+			goto on_error;
+		}
 #if defined( HAVE_DEBUG_OUTPUT )
 		if( libcnotify_verbose != 0 )
 		{
@@ -4147,16 +4772,91 @@ ssize_t libewf_segment_file_write_chunk_data(
 			libcnotify_printf(
 			 "\tUses pattern fill\n" );
 		}
+		if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_HAS_SUB_BLOCK_INDEX ) != 0 )
+		{
+			libcnotify_printf(
+			 "\tHas sub-block index\n" );
+		}
 		libcnotify_printf(
 		 "\n" );
 	}
 #endif
-	write_count = libewf_chunk_data_write(
-	               chunk_data,
-	               file_io_pool,
-	               file_io_pool_entry,
-	               error );
+	/* Flush the write buffer if the chunk does not fit
+	 */
+	if( ( segment_file->write_buffer_data_size > 0 )
+	 && ( (size_t) chunk_write_size > ( LIBEWF_SEGMENT_FILE_WRITE_BUFFER_SIZE - segment_file->write_buffer_data_size ) ) )
+	{
+		if( libewf_segment_file_flush_write_buffer(
+		     segment_file,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     error ) < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to flush write buffer.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( (size_t) chunk_write_size > LIBEWF_SEGMENT_FILE_WRITE_BUFFER_SIZE )
+	{
+		write_count = libewf_chunk_data_write(
+		               chunk_data,
+		               file_io_pool,
+		               file_io_pool_entry,
+		               error );
+	}
+	else
+	{
+		if( segment_file->write_buffer == NULL )
+		{
+			segment_file->write_buffer = (uint8_t *) memory_allocate(
+			                                          sizeof( uint8_t ) * LIBEWF_SEGMENT_FILE_WRITE_BUFFER_SIZE );
+
+			if( segment_file->write_buffer == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create write buffer.",
+				 function );
+
+				return( -1 );
+			}
+			segment_file->write_buffer_data_size = 0;
+
+#if defined( HAVE_LIBEWF_MEMORY_ACCOUNTING )
+			if( libewf_segment_file_update_memory_accounting(
+			     segment_file,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update memory accounting.",
+				 function );
+
+				return( -1 );
+			}
+#endif
+		}
+		write_count = libewf_chunk_data_write_to_buffer(
+		               chunk_data,
+		               &( segment_file->write_buffer[ segment_file->write_buffer_data_size ] ),
+		               LIBEWF_SEGMENT_FILE_WRITE_BUFFER_SIZE - segment_file->write_buffer_data_size,
+		               error );
 
+		if( write_count > 0 )
+		{
+			segment_file->write_buffer_data_size += (size_t) write_count;
+		}
+	}
 	if( write_count != (ssize_t) chunk_write_size )
 	{
 		libcerror_error_set(
@@ -4173,23 +4873,17 @@ ssize_t libewf_segment_file_write_chunk_data(
 	return( write_count );
 }
 
-/* Writes the hash sections to file
+/* Writes the chunks combined in the write buffer to the segment file
  * Returns the number of bytes written or -1 on error
  */
-ssize_t libewf_segment_file_write_hash_sections(
+ssize_t libewf_segment_file_flush_write_buffer(
          libewf_segment_file_t *segment_file,
          libbfio_pool_t *file_io_pool,
          int file_io_pool_entry,
-         libewf_hash_sections_t *hash_sections,
-         libfvalue_table_t *hash_values,
          libcerror_error_t **error )
 {
-	libewf_section_descriptor_t *section_descriptor = NULL;
-	static char *function                           = "libewf_segment_file_write_hash_sections";
-	ssize_t total_write_count                       = 0;
-	ssize_t write_count                             = 0;
-	int element_index                               = 0;
-	int result                                      = 0;
+	static char *function = "libewf_segment_file_flush_write_buffer";
+	ssize_t write_count   = 0;
 
 	if( segment_file == NULL )
 	{
@@ -4202,7 +4896,84 @@ ssize_t libewf_segment_file_write_hash_sections(
 
 		return( -1 );
 	}
-	if( segment_file->io_handle == NULL )
+	if( segment_file->write_buffer_data_size == 0 )
+	{
+		return( 0 );
+	}
+	if( segment_file->write_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment file - missing write buffer.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: writing %" PRIzd " bytes of combined chunk data to file IO pool entry: %d.\n",
+		 function,
+		 segment_file->write_buffer_data_size,
+		 file_io_pool_entry );
+	}
+#endif
+	write_count = libbfio_pool_write_buffer(
+	               file_io_pool,
+	               file_io_pool_entry,
+	               segment_file->write_buffer,
+	               segment_file->write_buffer_data_size,
+	               error );
+
+	if( write_count != (ssize_t) segment_file->write_buffer_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write combined chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	segment_file->write_buffer_data_size = 0;
+
+	return( write_count );
+}
+
+/* Writes the hash sections to file
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_segment_file_write_hash_sections(
+         libewf_segment_file_t *segment_file,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         libewf_hash_sections_t *hash_sections,
+         libfvalue_table_t *hash_values,
+         libcerror_error_t **error )
+{
+	libewf_section_descriptor_t *section_descriptor = NULL;
+	static char *function                           = "libewf_segment_file_write_hash_sections";
+	ssize_t total_write_count                       = 0;
+	ssize_t write_count                             = 0;
+	int element_index                               = 0;
+	int result                                      = 0;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -4639,10 +5410,12 @@ ssize_t libewf_segment_file_write_close(
          libewf_media_values_t *media_values,
          libcdata_array_t *sessions,
          libcdata_array_t *tracks,
-         libcdata_range_list_t *acquiry_errors,
+         libewf_sector_range_list_t *acquiry_errors,
          ewf_data_t **data_section_descriptor,
 	 libcerror_error_t **error )
 {
+	uint8_t ltree_integrity_hash[ 16 ];
+
 	libewf_section_descriptor_t *section_descriptor = NULL;
 	static char *function                           = "libewf_segment_file_write_close";
 	ssize_t total_write_count                       = 0;
@@ -4707,6 +5480,28 @@ ssize_t libewf_segment_file_write_close(
 
 		return( -1 );
 	}
+	if( libewf_segment_file_flush_write_buffer(
+	     segment_file,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     error ) < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush write buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( segment_file->write_buffer != NULL )
+	{
+		memory_free(
+		 segment_file->write_buffer );
+
+		segment_file->write_buffer = NULL;
+	}
 	if( last_segment_file != 0 )
 	{
 		/* Write the data section for a single segment file only for EWF-E01
@@ -4785,6 +5580,104 @@ ssize_t libewf_segment_file_write_close(
 				}
 			}
 		}
+		/* Write the ltree section of a logical image if ltree data was appended
+		 */
+		if( ( segment_file->type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_LOGICAL )
+		 && ( segment_file->io_handle->single_files != NULL )
+		 && ( segment_file->io_handle->single_files->ltree_data != NULL ) )
+		{
+			/* The integrity hash was calculated while the ltree data was appended
+			 */
+			result = libewf_single_files_get_ltree_integrity_hash(
+			          segment_file->io_handle->single_files,
+			          ltree_integrity_hash,
+			          16,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve ltree integrity hash.",
+				 function );
+
+				goto on_error;
+			}
+			if( libewf_section_descriptor_initialize(
+			     &section_descriptor,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create section descriptor.",
+				 function );
+
+				goto on_error;
+			}
+			write_count = libewf_section_ltree_write(
+				       section_descriptor,
+				       segment_file->io_handle,
+				       file_io_pool,
+				       file_io_pool_entry,
+				       segment_file->major_version,
+				       segment_file->current_offset,
+				       segment_file->io_handle->single_files->section_data,
+				       segment_file->io_handle->single_files->section_data_size,
+				       segment_file->io_handle->single_files->ltree_data,
+				       segment_file->io_handle->single_files->ltree_data_size,
+				       ( result != 0 ) ? ltree_integrity_hash : NULL,
+				       error );
+
+			if( write_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write ltree section.",
+				 function );
+
+				goto on_error;
+			}
+			if( libfdata_list_append_element(
+			     segment_file->sections_list,
+			     &element_index,
+			     file_io_pool_entry,
+			     segment_file->current_offset,
+			     sizeof( ewf_section_descriptor_v1_t ),
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append section to sections list.",
+				 function );
+
+				goto on_error;
+			}
+			segment_file->current_offset += write_count;
+			total_write_count            += write_count;
+
+			if( libewf_section_descriptor_free(
+			     &section_descriptor,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free section.",
+				 function );
+
+				goto on_error;
+			}
+		}
 		/* Write the session section if required
 		 */
 		if( ( segment_file->io_handle->format == LIBEWF_FORMAT_ENCASE5 )
@@ -4911,7 +5804,7 @@ ssize_t libewf_segment_file_write_close(
 		 || ( segment_file->io_handle->format == LIBEWF_FORMAT_V2_ENCASE7 )
 		 || ( segment_file->io_handle->format == LIBEWF_FORMAT_EWFX ) )
 		{
-			if( libcdata_range_list_get_number_of_elements(
+			if( libewf_sector_range_list_get_number_of_ranges(
 			     acquiry_errors,
 			     &number_of_acquiry_errors,
 			     error ) != 1 )
@@ -5061,22 +5954,27 @@ ssize_t libewf_segment_file_write_close(
 	segment_file->number_of_chunks = number_of_chunks_written_to_segment_file;
 
 	/* Make sure the next time the file is opened it is not truncated
+	 * A sequential write never opens the file again and the target might
+	 * not support opening it for reading
 	 */
-	if( libbfio_pool_reopen(
-	     file_io_pool,
-	     file_io_pool_entry,
-	     LIBBFIO_OPEN_READ_WRITE,
-	     error ) != 1 )
+	if( ( segment_file->io_handle->access_flags & LIBEWF_ACCESS_FLAG_SEQUENTIAL ) == 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
-		 "%s: unable to reopen segment file: %" PRIu16 ".",
-		 function,
-		 segment_file->segment_number );
+		if( libbfio_pool_reopen(
+		     file_io_pool,
+		     file_io_pool_entry,
+		     LIBBFIO_OPEN_READ_WRITE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to reopen segment file: %" PRIu16 ".",
+			 function,
+			 segment_file->segment_number );
 
-		goto on_error;
+			goto on_error;
+		}
 	}
 	if( libbfio_pool_close(
 	     file_io_pool,
@@ -5312,7 +6210,7 @@ int libewf_segment_file_write_sections_correction(
      libewf_hash_sections_t *hash_sections,
      libcdata_array_t *sessions,
      libcdata_array_t *tracks,
-     libcdata_range_list_t *acquiry_errors,
+     libewf_sector_range_list_t *acquiry_errors,
      uint8_t **case_data,
      size_t *case_data_size,
      uint8_t **device_information,
@@ -5362,6 +6260,19 @@ int libewf_segment_file_write_sections_correction(
 
 		return( -1 );
 	}
+	/* Correcting the sections requires seeking back in the segment file
+	 */
+	if( ( segment_file->io_handle->access_flags & LIBEWF_ACCESS_FLAG_SEQUENTIAL ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unable to correct sections on sequential write.",
+		 function );
+
+		return( -1 );
+	}
 	if( device_information == NULL )
 	{
 		libcerror_error_set(
@@ -5884,150 +6795,74 @@ on_error:
 	return( -1 );
 }
 
-/* Reads a segment file
- * Callback function for the segment files list
+/* Reads the section list and chunk groups of a segment file
  * Returns 1 if successful or -1 on error
  */
-int libewf_segment_file_read_element_data(
-     libewf_io_handle_t *io_handle,
+int libewf_segment_file_read_section_list(
+     libewf_segment_file_t *segment_file,
      libbfio_pool_t *file_io_pool,
-     libfdata_list_element_t *element,
-     libfdata_cache_t *segment_file_cache,
      int file_io_pool_entry,
-     off64_t segment_file_offset,
+     size_t file_header_size,
      size64_t segment_file_size,
-     uint32_t element_flags LIBEWF_ATTRIBUTE_UNUSED,
-     uint8_t read_flags LIBEWF_ATTRIBUTE_UNUSED,
      libcerror_error_t **error )
 {
 	libewf_section_descriptor_t *section_descriptor = NULL;
-	libewf_segment_file_t *segment_file             = NULL;
 	libfcache_cache_t *sections_cache               = NULL;
-	static char *function                           = "libewf_segment_file_read_element_data";
+	static char *function                           = "libewf_segment_file_read_section_list";
 	ssize_t read_count                              = 0;
 	off64_t section_data_offset                     = 0;
+	off64_t segment_file_offset                     = 0;
 	int element_index                               = 0;
 	int last_section                                = 0;
 	int number_of_sections                          = 0;
 	int result                                      = 0;
 	int section_index                               = 0;
 
-	LIBEWF_UNREFERENCED_PARAMETER( element_flags )
-	LIBEWF_UNREFERENCED_PARAMETER( read_flags )
-
-	if( io_handle == NULL )
+	if( segment_file == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid IO handle.",
+		 "%s: invalid segment file.",
 		 function );
 
 		return( -1 );
 	}
-	if( libewf_segment_file_initialize(
-	     &segment_file,
-	     io_handle,
-	     error ) != 1 )
+	if( segment_file->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create segment file.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment file - missing IO handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	read_count = libewf_segment_file_read_file_header(
-		      segment_file,
-		      file_io_pool,
-		      file_io_pool_entry,
-		      error );
+	/* Read the section descriptors:
+	 * EWF version 1 read from front to back
+	 * EWF version 2 read from back to front
+	 */
+	if( segment_file->major_version == 1 )
+	{
+		segment_file_offset = (off64_t) file_header_size;
+	}
+	else if( segment_file->major_version == 2 )
+	{
+		segment_file_offset = (off64_t) segment_file_size - sizeof( ewf_section_descriptor_v2_t );
+	}
+	last_section = 0;
 
-/* TODO deal with corrupted header ? */
-	if( read_count == -1 )
+	if( libewf_section_descriptor_initialize(
+	     &section_descriptor,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read segment file header.",
-		 function );
-
-		goto on_error;
-	}
-	if( ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF1 )
-	 && ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF1_LOGICAL )
-	 && ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
-	 && ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF2 )
-	 && ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF2_LOGICAL ) )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported segment file type.",
-		 function );
-
-		goto on_error;
-	}
-	if( ( io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
-	 && ( segment_file->type == LIBEWF_SEGMENT_FILE_TYPE_EWF1 ) )
-	{
-		segment_file->type = LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART;
-	}
-	else if( ( io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_UNDEFINED )
-	      && ( io_handle->segment_file_type != segment_file->type ) )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_INPUT,
-		 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
-		 "%s: segment file type value mismatch.",
-		 function );
-
-		goto on_error;
-	}
-	if( segment_file->major_version == 2 )
-	{
-		if( ( segment_file->compression_method != LIBEWF_COMPRESSION_METHOD_DEFLATE )
-		 && ( segment_file->compression_method != LIBEWF_COMPRESSION_METHOD_BZIP2 ) )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-			 "%s: unsupported compression method.",
-			 function );
-
-			return( -1 );
-		}
-	}
-	/* Read the section descriptors:
-	 * EWF version 1 read from front to back
-	 * EWF version 2 read from back to front
-	 */
-	if( segment_file->major_version == 1 )
-	{
-		segment_file_offset = (off64_t) read_count;
-	}
-	else if( segment_file->major_version == 2 )
-	{
-		segment_file_offset = (off64_t) segment_file_size - sizeof( ewf_section_descriptor_v2_t );
-	}
-	last_section = 0;
-
-	if( libewf_section_descriptor_initialize(
-	     &section_descriptor,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create section descriptor.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create section descriptor.",
 		 function );
 
 		goto on_error;
@@ -6244,7 +7079,10 @@ int libewf_segment_file_read_element_data(
 			                                               - segment_file->device_information_section_index;
 		}
 	}
-	if( io_handle->chunk_size != 0 )
+	/* The sector table sections are not read when only the metadata is read
+	 */
+	if( ( segment_file->io_handle->chunk_size != 0 )
+	 && ( ( segment_file->io_handle->access_flags & LIBEWF_ACCESS_FLAG_METADATA ) == 0 ) )
 	{
 		if( libfcache_cache_initialize(
 		     &sections_cache,
@@ -6338,7 +7176,7 @@ int libewf_segment_file_read_element_data(
 					      section_descriptor,
 					      file_io_pool,
 					      file_io_pool_entry,
-					      io_handle->chunk_size,
+					      segment_file->io_handle->chunk_size,
 					      error );
 
 				if( read_count == -1 )
@@ -6428,9 +7266,871 @@ int libewf_segment_file_read_element_data(
 			 "%s: unable to free sections cache.",
 			 function );
 
-			goto on_error;
-		}
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( sections_cache != NULL )
+	{
+		libfcache_cache_free(
+		 &sections_cache,
+		 NULL );
+	}
+	if( section_descriptor != NULL )
+	{
+		libewf_section_descriptor_free(
+		 &section_descriptor,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the section list and chunk groups of a segment file from segment index entry data
+ * Returns 1 if successful, 0 if the entry data does not match the segment file or -1 on error
+ */
+int libewf_segment_file_read_index_entry_data(
+     libewf_segment_file_t *segment_file,
+     const uint8_t *entry_data,
+     size_t entry_data_size,
+     int file_io_pool_entry,
+     size64_t segment_file_size,
+     libcerror_error_t **error )
+{
+	static char *function                     = "libewf_segment_file_read_index_entry_data";
+	size64_t chunk_group_mapped_size          = 0;
+	size64_t chunk_group_data_size            = 0;
+	size64_t number_of_chunks                 = 0;
+	size64_t storage_media_size               = 0;
+	size64_t stored_segment_file_size         = 0;
+	size_t data_offset                        = 0;
+	size_t required_entry_data_size           = 0;
+	off64_t chunk_group_data_offset           = 0;
+	off64_t current_offset                    = 0;
+	off64_t last_section_offset               = 0;
+	off64_t section_offset                    = 0;
+	size_t section_descriptor_size            = 0;
+	uint32_t chunk_group_index                = 0;
+	uint32_t chunk_group_range_flags          = 0;
+	uint32_t device_information_section_index = 0;
+	uint32_t number_of_chunk_groups           = 0;
+	uint32_t number_of_sections               = 0;
+	uint32_t section_index                    = 0;
+	uint32_t segment_number                   = 0;
+	int element_index                         = 0;
+	int result                                = 0;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry data.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_segment_index_get_entry_data_size(
+	          entry_data,
+	          entry_data_size,
+	          &required_entry_data_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine entry data size.",
+		 function );
+
+		return( -1 );
+	}
+	else if( ( result == 0 )
+	      || ( required_entry_data_size != entry_data_size ) )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewf_segment_index_entry_t *) entry_data )->segment_number,
+	 segment_number );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (ewf_segment_index_entry_t *) entry_data )->segment_file_size,
+	 stored_segment_file_size );
+
+	/* Only use the entry if it describes the segment file as it currently is
+	 */
+	if( ( segment_number != segment_file->segment_number )
+	 || ( ( (ewf_segment_index_entry_t *) entry_data )->type != segment_file->type )
+	 || ( ( (ewf_segment_index_entry_t *) entry_data )->major_version != segment_file->major_version )
+	 || ( ( (ewf_segment_index_entry_t *) entry_data )->minor_version != segment_file->minor_version )
+	 || ( stored_segment_file_size != segment_file_size ) )
+	{
+		return( 0 );
+	}
+	if( memory_compare(
+	     ( (ewf_segment_index_entry_t *) entry_data )->set_identifier,
+	     segment_file->set_identifier,
+	     16 ) != 0 )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (ewf_segment_index_entry_t *) entry_data )->current_offset,
+	 current_offset );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (ewf_segment_index_entry_t *) entry_data )->last_section_offset,
+	 last_section_offset );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (ewf_segment_index_entry_t *) entry_data )->storage_media_size,
+	 storage_media_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (ewf_segment_index_entry_t *) entry_data )->number_of_chunks,
+	 number_of_chunks );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewf_segment_index_entry_t *) entry_data )->device_information_section_index,
+	 device_information_section_index );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewf_segment_index_entry_t *) entry_data )->number_of_sections,
+	 number_of_sections );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewf_segment_index_entry_t *) entry_data )->number_of_chunk_groups,
+	 number_of_chunk_groups );
+
+	if( ( number_of_sections == 0 )
+	 || ( number_of_sections > (uint32_t) INT32_MAX )
+	 || ( number_of_chunk_groups > (uint32_t) INT32_MAX )
+	 || ( (size64_t) current_offset > segment_file_size )
+	 || ( (size64_t) last_section_offset >= segment_file_size )
+	 || ( number_of_chunks > (size64_t) INT64_MAX ) )
+	{
+		return( 0 );
+	}
+	if( ( device_information_section_index != 0xffffffffUL )
+	 && ( device_information_section_index >= number_of_sections ) )
+	{
+		return( 0 );
+	}
+	if( segment_file->major_version == 1 )
+	{
+		section_descriptor_size = sizeof( ewf_section_descriptor_v1_t );
+	}
+	else
+	{
+		section_descriptor_size = sizeof( ewf_section_descriptor_v2_t );
+	}
+	data_offset = sizeof( ewf_segment_index_entry_t );
+
+	for( section_index = 0;
+	     section_index < number_of_sections;
+	     section_index++ )
+	{
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (ewf_segment_index_section_t *) &( entry_data[ data_offset ] ) )->offset,
+		 section_offset );
+
+		if( ( section_offset < 0 )
+		 || ( (size64_t) section_offset >= segment_file_size ) )
+		{
+			return( 0 );
+		}
+		data_offset += sizeof( ewf_segment_index_section_t );
+	}
+	for( chunk_group_index = 0;
+	     chunk_group_index < number_of_chunk_groups;
+	     chunk_group_index++ )
+	{
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (ewf_segment_index_chunk_group_t *) &( entry_data[ data_offset ] ) )->data_offset,
+		 chunk_group_data_offset );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (ewf_segment_index_chunk_group_t *) &( entry_data[ data_offset ] ) )->data_size,
+		 chunk_group_data_size );
+
+		if( ( chunk_group_data_offset < 0 )
+		 || ( (size64_t) chunk_group_data_offset >= segment_file_size )
+		 || ( chunk_group_data_size > ( segment_file_size - (size64_t) chunk_group_data_offset ) ) )
+		{
+			return( 0 );
+		}
+		data_offset += sizeof( ewf_segment_index_chunk_group_t );
+	}
+	/* The entry data was validated, add the sections and chunk groups
+	 */
+	data_offset = sizeof( ewf_segment_index_entry_t );
+
+	for( section_index = 0;
+	     section_index < number_of_sections;
+	     section_index++ )
+	{
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (ewf_segment_index_section_t *) &( entry_data[ data_offset ] ) )->offset,
+		 section_offset );
+
+		if( libfdata_list_append_element(
+		     segment_file->sections_list,
+		     &element_index,
+		     file_io_pool_entry,
+		     section_offset,
+		     (size64_t) section_descriptor_size,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append section: %" PRIu32 " to sections list.",
+			 function,
+			 section_index );
+
+			return( -1 );
+		}
+		data_offset += sizeof( ewf_segment_index_section_t );
+	}
+	for( chunk_group_index = 0;
+	     chunk_group_index < number_of_chunk_groups;
+	     chunk_group_index++ )
+	{
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (ewf_segment_index_chunk_group_t *) &( entry_data[ data_offset ] ) )->data_offset,
+		 chunk_group_data_offset );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (ewf_segment_index_chunk_group_t *) &( entry_data[ data_offset ] ) )->data_size,
+		 chunk_group_data_size );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (ewf_segment_index_chunk_group_t *) &( entry_data[ data_offset ] ) )->mapped_size,
+		 chunk_group_mapped_size );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (ewf_segment_index_chunk_group_t *) &( entry_data[ data_offset ] ) )->range_flags,
+		 chunk_group_range_flags );
+
+		if( libfdata_list_append_element_with_mapped_size(
+		     segment_file->chunk_groups_list,
+		     &( segment_file->chunk_groups_index ),
+		     file_io_pool_entry,
+		     chunk_group_data_offset,
+		     chunk_group_data_size,
+		     chunk_group_range_flags,
+		     chunk_group_mapped_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append chunk group: %" PRIu32 " to chunk groups list.",
+			 function,
+			 chunk_group_index );
+
+			return( -1 );
+		}
+		data_offset += sizeof( ewf_segment_index_chunk_group_t );
+	}
+	segment_file->flags               = ( (ewf_segment_index_entry_t *) entry_data )->flags;
+	segment_file->current_offset      = current_offset;
+	segment_file->last_section_offset = last_section_offset;
+	segment_file->storage_media_size  = storage_media_size;
+	segment_file->number_of_chunks    = (uint64_t) number_of_chunks;
+	segment_file->last_chunk_filled  += (int64_t) number_of_chunks;
+
+	if( device_information_section_index == 0xffffffffUL )
+	{
+		segment_file->device_information_section_index = -1;
+	}
+	else
+	{
+		segment_file->device_information_section_index = (int) device_information_section_index;
+	}
+	return( 1 );
+}
+
+/* Retrieves the segment index entry data of a segment file
+ * The entry data is allocated and needs to be freed by the caller
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_get_index_entry_data(
+     libewf_segment_file_t *segment_file,
+     size64_t segment_file_size,
+     uint8_t **entry_data,
+     size_t *entry_data_size,
+     libcerror_error_t **error )
+{
+	uint8_t *safe_entry_data          = NULL;
+	static char *function             = "libewf_segment_file_get_index_entry_data";
+	size64_t chunk_group_data_size    = 0;
+	size64_t chunk_group_mapped_size  = 0;
+	size64_t section_size             = 0;
+	size_t data_offset                = 0;
+	size_t safe_entry_data_size       = 0;
+	off64_t chunk_group_data_offset   = 0;
+	off64_t section_offset            = 0;
+	uint32_t chunk_group_range_flags  = 0;
+	uint32_t section_flags            = 0;
+	int chunk_group_file_io_pool_entry = 0;
+	int chunk_group_index             = 0;
+	int number_of_chunk_groups        = 0;
+	int number_of_sections            = 0;
+	int result                        = 0;
+	int section_file_io_pool_entry    = 0;
+	int section_index                 = 0;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry data.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_get_number_of_elements(
+	     segment_file->sections_list,
+	     &number_of_sections,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sections.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_list_get_number_of_elements(
+	     segment_file->chunk_groups_list,
+	     &number_of_chunk_groups,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of chunk groups.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( number_of_sections <= 0 )
+	 || ( number_of_chunk_groups < 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of sections or chunk groups value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	safe_entry_data_size = sizeof( ewf_segment_index_entry_t )
+	                     + ( sizeof( ewf_segment_index_section_t ) * (size_t) number_of_sections )
+	                     + ( sizeof( ewf_segment_index_chunk_group_t ) * (size_t) number_of_chunk_groups );
+
+	if( safe_entry_data_size > (size_t) LIBEWF_MAXIMUM_SEGMENT_INDEX_FILE_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid entry data size value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	safe_entry_data = (uint8_t *) memory_allocate(
+	                               sizeof( uint8_t ) * safe_entry_data_size );
+
+	if( safe_entry_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entry data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     safe_entry_data,
+	     0,
+	     safe_entry_data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entry data.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_segment_index_entry_t *) safe_entry_data )->segment_number,
+	 segment_file->segment_number );
+
+	( (ewf_segment_index_entry_t *) safe_entry_data )->type          = segment_file->type;
+	( (ewf_segment_index_entry_t *) safe_entry_data )->major_version = segment_file->major_version;
+	( (ewf_segment_index_entry_t *) safe_entry_data )->minor_version = segment_file->minor_version;
+	( (ewf_segment_index_entry_t *) safe_entry_data )->flags         = segment_file->flags;
+
+	byte_stream_copy_from_uint64_little_endian(
+	 ( (ewf_segment_index_entry_t *) safe_entry_data )->segment_file_size,
+	 segment_file_size );
+
+	if( memory_copy(
+	     ( (ewf_segment_index_entry_t *) safe_entry_data )->set_identifier,
+	     segment_file->set_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy set identifier.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_from_uint64_little_endian(
+	 ( (ewf_segment_index_entry_t *) safe_entry_data )->current_offset,
+	 segment_file->current_offset );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 ( (ewf_segment_index_entry_t *) safe_entry_data )->last_section_offset,
+	 segment_file->last_section_offset );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 ( (ewf_segment_index_entry_t *) safe_entry_data )->storage_media_size,
+	 segment_file->storage_media_size );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 ( (ewf_segment_index_entry_t *) safe_entry_data )->number_of_chunks,
+	 segment_file->number_of_chunks );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_segment_index_entry_t *) safe_entry_data )->device_information_section_index,
+	 (uint32_t) segment_file->device_information_section_index );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_segment_index_entry_t *) safe_entry_data )->number_of_sections,
+	 (uint32_t) number_of_sections );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_segment_index_entry_t *) safe_entry_data )->number_of_chunk_groups,
+	 (uint32_t) number_of_chunk_groups );
+
+	data_offset = sizeof( ewf_segment_index_entry_t );
+
+	for( section_index = 0;
+	     section_index < number_of_sections;
+	     section_index++ )
+	{
+		if( libfdata_list_get_element_by_index(
+		     segment_file->sections_list,
+		     section_index,
+		     &section_file_io_pool_entry,
+		     &section_offset,
+		     &section_size,
+		     &section_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element: %d from sections list.",
+			 function,
+			 section_index );
+
+			goto on_error;
+		}
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewf_segment_index_section_t *) &( safe_entry_data[ data_offset ] ) )->offset,
+		 section_offset );
+
+		data_offset += sizeof( ewf_segment_index_section_t );
+	}
+	for( chunk_group_index = 0;
+	     chunk_group_index < number_of_chunk_groups;
+	     chunk_group_index++ )
+	{
+		if( libfdata_list_get_element_by_index(
+		     segment_file->chunk_groups_list,
+		     chunk_group_index,
+		     &chunk_group_file_io_pool_entry,
+		     &chunk_group_data_offset,
+		     &chunk_group_data_size,
+		     &chunk_group_range_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element: %d from chunk groups list.",
+			 function,
+			 chunk_group_index );
+
+			goto on_error;
+		}
+		result = libfdata_list_get_mapped_size_by_index(
+		          segment_file->chunk_groups_list,
+		          chunk_group_index,
+		          &chunk_group_mapped_size,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve mapped size of element: %d from chunk groups list.",
+			 function,
+			 chunk_group_index );
+
+			goto on_error;
+		}
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewf_segment_index_chunk_group_t *) &( safe_entry_data[ data_offset ] ) )->data_offset,
+		 chunk_group_data_offset );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewf_segment_index_chunk_group_t *) &( safe_entry_data[ data_offset ] ) )->data_size,
+		 chunk_group_data_size );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewf_segment_index_chunk_group_t *) &( safe_entry_data[ data_offset ] ) )->mapped_size,
+		 chunk_group_mapped_size );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (ewf_segment_index_chunk_group_t *) &( safe_entry_data[ data_offset ] ) )->range_flags,
+		 chunk_group_range_flags );
+
+		data_offset += sizeof( ewf_segment_index_chunk_group_t );
+	}
+	*entry_data      = safe_entry_data;
+	*entry_data_size = safe_entry_data_size;
+
+	return( 1 );
+
+on_error:
+	if( safe_entry_data != NULL )
+	{
+		memory_free(
+		 safe_entry_data );
+	}
+	return( -1 );
+}
+
+/* Reads the file header and the section list of a segment file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_read_file_io_pool(
+     libewf_segment_file_t *segment_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size64_t segment_file_size,
+     libcerror_error_t **error )
+{
+	const uint8_t *index_entry_data = NULL;
+	static char *function           = "libewf_segment_file_read_file_io_pool";
+	size_t index_entry_data_size    = 0;
+	ssize_t read_count              = 0;
+	int result                      = 0;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libewf_segment_file_read_file_header(
+		      segment_file,
+		      file_io_pool,
+		      file_io_pool_entry,
+		      error );
+
+/* TODO deal with corrupted header ? */
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read segment file header.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF1 )
+	 && ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF1_LOGICAL )
+	 && ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+	 && ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF2 )
+	 && ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF2_LOGICAL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported segment file type.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_file->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+	 && ( segment_file->type == LIBEWF_SEGMENT_FILE_TYPE_EWF1 ) )
+	{
+		segment_file->type = LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART;
+	}
+	else if( ( segment_file->io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_UNDEFINED )
+	      && ( segment_file->io_handle->segment_file_type != segment_file->type ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+		 "%s: segment file type value mismatch.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file->major_version == 2 )
+	{
+		if( ( segment_file->compression_method != LIBEWF_COMPRESSION_METHOD_DEFLATE )
+		 && ( segment_file->compression_method != LIBEWF_COMPRESSION_METHOD_BZIP2 )
+		 && ( segment_file->compression_method != LIBEWF_COMPRESSION_METHOD_ZSTD ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported compression method.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( segment_file->io_handle->segment_index != NULL )
+	{
+		result = libewf_segment_index_get_entry_data(
+		          segment_file->io_handle->segment_index,
+		          segment_file->segment_number,
+		          &index_entry_data,
+		          &index_entry_data_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment index entry data.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			result = libewf_segment_file_read_index_entry_data(
+			          segment_file,
+			          index_entry_data,
+			          index_entry_data_size,
+			          file_io_pool_entry,
+			          segment_file_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read segment index entry data.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	/* Fall back to reading the section list if the segment index is missing
+	 * or does not match the segment file
+	 */
+	if( result == 0 )
+	{
+		if( libewf_segment_file_read_section_list(
+		     segment_file,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     (size_t) read_count,
+		     segment_file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read section list.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#if defined( HAVE_LIBEWF_MEMORY_ACCOUNTING )
+	if( libewf_segment_file_update_memory_accounting(
+	     segment_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update memory accounting.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Reads a segment file
+ * Callback function for the segment files list
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_read_element_data(
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libfdata_list_element_t *element,
+     libfdata_cache_t *segment_file_cache,
+     int file_io_pool_entry,
+     off64_t segment_file_offset LIBEWF_ATTRIBUTE_UNUSED,
+     size64_t segment_file_size,
+     uint32_t element_flags LIBEWF_ATTRIBUTE_UNUSED,
+     uint8_t read_flags LIBEWF_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_segment_file_read_element_data";
+
+	LIBEWF_UNREFERENCED_PARAMETER( segment_file_offset )
+	LIBEWF_UNREFERENCED_PARAMETER( element_flags )
+	LIBEWF_UNREFERENCED_PARAMETER( read_flags )
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_segment_file_initialize(
+	     &segment_file,
+	     io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_segment_file_read_file_io_pool(
+	     segment_file,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     segment_file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read segment file.",
+		 function );
+
+		goto on_error;
 	}
+	LIBEWF_TRACE_SEGMENT_FILE_OPEN(
+	 segment_file->segment_number,
+	 file_io_pool_entry );
+
 	if( libfdata_list_element_set_element_value(
 	     element,
 	     (intptr_t *) file_io_pool,
@@ -6452,18 +8152,6 @@ int libewf_segment_file_read_element_data(
 	return( 1 );
 
 on_error:
-	if( sections_cache != NULL )
-	{
-		libfcache_cache_free(
-		 &sections_cache,
-		 NULL );
-	}
-	if( section_descriptor != NULL )
-	{
-		libewf_section_descriptor_free(
-		 &section_descriptor,
-		 NULL );
-	}
 	if( segment_file != NULL )
 	{
 		libewf_segment_file_free(
@@ -6573,28 +8261,177 @@ on_error:
 	return( -1 );
 }
 
-/* Reads a chunk group
- * Callback function for the chunk groups list
+/* Reads a table section into the table buffer with a single read
+ * The table buffer is resized if it is too small to contain the table section
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libewf_segment_file_read_table_buffer(
+         libewf_segment_file_t *segment_file,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         off64_t table_offset,
+         size_t table_size,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_file_read_table_buffer";
+	size_t buffer_size    = 0;
+	ssize_t read_count    = 0;
+	void *reallocation    = NULL;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( table_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid table offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( table_size == 0 )
+	 || ( table_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid table size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( table_size > segment_file->table_buffer_size )
+	{
+		/* Round up to a multiple of 4096 to reduce the number of reallocations
+		 */
+		buffer_size = table_size;
+
+		if( ( buffer_size % 4096 ) != 0 )
+		{
+			buffer_size += 4096 - ( buffer_size % 4096 );
+		}
+		if( buffer_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+		{
+			buffer_size = table_size;
+		}
+		reallocation = memory_reallocate(
+		                segment_file->table_buffer,
+		                sizeof( uint8_t ) * buffer_size );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize table buffer.",
+			 function );
+
+			return( -1 );
+		}
+		segment_file->table_buffer      = (uint8_t *) reallocation;
+		segment_file->table_buffer_size = buffer_size;
+
+#if defined( HAVE_LIBEWF_MEMORY_ACCOUNTING )
+		if( libewf_segment_file_update_memory_accounting(
+		     segment_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update memory accounting.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: reading table section of size: %" PRIzd " from file IO pool entry: %d at offset: 0x%08" PRIx64 "\n",
+		 function,
+		 table_size,
+		 file_io_pool_entry,
+		 table_offset );
+	}
+#endif
+	if( libbfio_pool_seek_offset(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     table_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek table section offset: %" PRIi64 " in file IO pool entry: %d.",
+		 function,
+		 table_offset,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	read_count = libbfio_pool_read_buffer(
+	              file_io_pool,
+	              file_io_pool_entry,
+	              segment_file->table_buffer,
+	              table_size,
+	              error );
+
+	if( read_count != (ssize_t) table_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read table section from file IO pool entry: %d.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	segment_file->current_offset = table_offset + read_count;
+
+	return( read_count );
+}
+
+/* Reads a chunk group from the table section at a specific offset
  * Returns 1 if successful or -1 on error
  */
-int libewf_segment_file_read_chunk_group_element_data(
+int libewf_segment_file_read_chunk_group(
      libewf_segment_file_t *segment_file,
      libbfio_pool_t *file_io_pool,
-     libfdata_list_element_t *element,
-     libfdata_cache_t *cache,
      int file_io_pool_entry,
      off64_t chunk_group_data_offset,
      size64_t chunk_group_data_size,
-     uint32_t element_flags LIBEWF_ATTRIBUTE_UNUSED,
-     uint8_t read_flags LIBEWF_ATTRIBUTE_UNUSED,
+     libewf_chunk_group_t **chunk_group,
      libcerror_error_t **error )
 {
-	libewf_chunk_group_t *chunk_group               = NULL;
 	libewf_section_descriptor_t *section_descriptor = NULL;
 	uint8_t *section_data                           = NULL;
+	uint8_t *table_data                             = NULL;
 	uint8_t *table_entries_data                     = NULL;
-	static char *function                           = "libewf_segment_file_read_chunk_group_element_data";
+	static char *function                           = "libewf_segment_file_read_chunk_group";
 	size_t section_data_size                        = 0;
+	size_t table_data_size                          = 0;
 	size_t table_entries_data_size                  = 0;
 	ssize_t read_count                              = 0;
 	off64_t storage_media_offset                    = 0;
@@ -6605,9 +8442,6 @@ int libewf_segment_file_read_chunk_group_element_data(
 	uint8_t entries_corrupted                       = 0;
 	int result                                      = 0;
 
-	LIBEWF_UNREFERENCED_PARAMETER( element_flags )
-	LIBEWF_UNREFERENCED_PARAMETER( read_flags )
-
 	if( segment_file == NULL )
 	{
 		libcerror_error_set(
@@ -6619,35 +8453,46 @@ int libewf_segment_file_read_chunk_group_element_data(
 
 		return( -1 );
 	}
-	if( segment_file->chunk_groups_list == NULL )
+	if( segment_file->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid segment file - missing chunk groups list.",
+		 "%s: invalid segment file - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( segment_file->io_handle == NULL )
+	if( segment_file->io_handle->chunk_size == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid segment file - missing IO handle.",
+		 "%s: invalid segment file - invalid IO handle - missing chunk size.",
 		 function );
 
 		return( -1 );
 	}
-	if( segment_file->io_handle->chunk_size == 0 )
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_group != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid segment file - invalid IO handle - missing chunk size.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk group value already set.",
 		 function );
 
 		return( -1 );
@@ -6665,108 +8510,215 @@ int libewf_segment_file_read_chunk_group_element_data(
 
 		goto on_error;
 	}
-	if( segment_file->major_version == 1 )
+	/* In original EWF, SMART (EWF-S01) and EnCase1 EWF-E01 the table entries are followed by the chunk data
+	 * and the size of the table section is only known after the table header has been read
+	 */
+	if( ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+	 && ( segment_file->io_handle->format != LIBEWF_FORMAT_ENCASE1 ) )
 	{
-		read_count = libewf_section_descriptor_read(
-			      section_descriptor,
-			      file_io_pool,
-			      file_io_pool_entry,
-			      chunk_group_data_offset,
-			      segment_file->major_version,
-			      error );
+		/* The section descriptor, table header, entries and footer are read with a single read
+		 */
+		if( ( chunk_group_data_size > (size64_t) UINT32_MAX )
+		 || ( ( segment_file->major_version == 1 )
+		  &&  ( chunk_group_data_size < (size64_t) sizeof( ewf_section_descriptor_v1_t ) ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid chunk group data size value out of bounds.",
+			 function );
 
-		if( read_count == -1 )
+			goto on_error;
+		}
+		read_count = libewf_segment_file_read_table_buffer(
+		              segment_file,
+		              file_io_pool,
+		              file_io_pool_entry,
+		              chunk_group_data_offset,
+		              (size_t) chunk_group_data_size,
+		              error );
+
+		if( read_count < 0 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
 			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read section descriptor.",
+			 "%s: unable to read table section.",
 			 function );
 
 			goto on_error;
 		}
-		segment_file->current_offset = chunk_group_data_offset + read_count;
+		table_data      = segment_file->table_buffer;
+		table_data_size = (size_t) chunk_group_data_size;
+
+		if( segment_file->major_version == 1 )
+		{
+			if( libewf_section_descriptor_read_data(
+			     section_descriptor,
+			     table_data,
+			     table_data_size,
+			     chunk_group_data_offset,
+			     segment_file->major_version,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read section descriptor.",
+				 function );
+
+				goto on_error;
+			}
+			if( chunk_group_data_size != section_descriptor->size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid chunk group data size value out of bounds.",
+				 function );
 
-		if( chunk_group_data_size != section_descriptor->size )
+				goto on_error;
+			}
+			table_data      += sizeof( ewf_section_descriptor_v1_t );
+			table_data_size -= sizeof( ewf_section_descriptor_v1_t );
+		}
+		else if( segment_file->major_version == 2 )
+		{
+			section_descriptor->start_offset = chunk_group_data_offset;
+			section_descriptor->data_size    = (uint32_t) chunk_group_data_size;
+		}
+		if( libewf_section_table_read_data(
+		     segment_file->io_handle,
+		     segment_file->major_version,
+		     segment_file->type,
+		     table_data,
+		     table_data_size,
+		     &first_chunk_index,
+		     &base_offset,
+		     &table_entries_data,
+		     &table_entries_data_size,
+		     &number_of_entries,
+		     &entries_corrupted,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: invalid chunk group data size value out of bounds.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read table section.",
 			 function );
 
 			goto on_error;
 		}
-		chunk_group_data_size -= read_count;
 	}
-	else if( segment_file->major_version == 2 )
+	else
 	{
-		if( chunk_group_data_size > (size64_t) UINT32_MAX )
+		if( segment_file->major_version == 1 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: invalid chunk group data size value out of bounds.",
-			 function );
+			read_count = libewf_section_descriptor_read(
+				      section_descriptor,
+				      file_io_pool,
+				      file_io_pool_entry,
+				      chunk_group_data_offset,
+				      segment_file->major_version,
+				      error );
+
+			if( read_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read section descriptor.",
+				 function );
+
+				goto on_error;
+			}
+			segment_file->current_offset = chunk_group_data_offset + read_count;
+
+			if( chunk_group_data_size != section_descriptor->size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid chunk group data size value out of bounds.",
+				 function );
+
+				goto on_error;
+			}
+			chunk_group_data_size -= read_count;
+		}
+		else if( segment_file->major_version == 2 )
+		{
+			if( chunk_group_data_size > (size64_t) UINT32_MAX )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid chunk group data size value out of bounds.",
+				 function );
+
+				goto on_error;
+			}
+			if( libbfio_pool_seek_offset(
+			     file_io_pool,
+			     file_io_pool_entry,
+			     chunk_group_data_offset,
+			     SEEK_SET,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_SEEK_FAILED,
+				 "%s: unable to seek chunk table offset: %" PRIi64 " in file IO pool entry: %d.",
+				 function,
+				 chunk_group_data_offset,
+				 file_io_pool_entry );
 
-			goto on_error;
+				goto on_error;
+			}
+			segment_file->current_offset     = chunk_group_data_offset;
+			section_descriptor->start_offset = chunk_group_data_offset;
+			section_descriptor->data_size    = (uint32_t) chunk_group_data_size;
 		}
-		if( libbfio_pool_seek_offset(
-		     file_io_pool,
-		     file_io_pool_entry,
-		     chunk_group_data_offset,
-		     SEEK_SET,
-		     error ) == -1 )
+		read_count = libewf_section_table_read(
+		              section_descriptor,
+		              segment_file->io_handle,
+		              file_io_pool,
+		              file_io_pool_entry,
+		              segment_file->major_version,
+		              segment_file->type,
+		              &section_data,
+		              &section_data_size,
+		              &first_chunk_index,
+		              &base_offset,
+		              &table_entries_data,
+		              &table_entries_data_size,
+		              &number_of_entries,
+		              &entries_corrupted,
+		              error );
+
+		if( read_count < 0 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_SEEK_FAILED,
-			 "%s: unable to seek chunk table offset: %" PRIi64 " in file IO pool entry: %d.",
-			 function,
-			 chunk_group_data_offset,
-			 file_io_pool_entry );
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read table section.",
+			 function );
 
 			goto on_error;
 		}
-		segment_file->current_offset     = chunk_group_data_offset;
-		section_descriptor->start_offset = chunk_group_data_offset;
-		section_descriptor->data_size    = (uint32_t) chunk_group_data_size;
-	}
-	read_count = libewf_section_table_read(
-	              section_descriptor,
-	              segment_file->io_handle,
-	              file_io_pool,
-	              file_io_pool_entry,
-	              segment_file->major_version,
-	              segment_file->type,
-		      &section_data,
-		      &section_data_size,
-	              &first_chunk_index,
-	              &base_offset,
-		      &table_entries_data,
-		      &table_entries_data_size,
-	              &number_of_entries,
-		      &entries_corrupted,
-	              error );
-	
-	if( read_count < 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read table section.",
-		 function );
-
-		goto on_error;
+		segment_file->current_offset += read_count;
+		chunk_group_data_size        -= read_count;
 	}
-	segment_file->current_offset += read_count;
-	chunk_group_data_size        -= read_count;
-
 	if( number_of_entries == 0 )
 	{
 		libcerror_error_set(
@@ -6779,7 +8731,7 @@ int libewf_segment_file_read_chunk_group_element_data(
 		goto on_error;
 	}
 	if( libewf_chunk_group_initialize(
-	     &chunk_group,
+	     chunk_group,
 	     segment_file->io_handle,
 	     error ) != 1 )
 	{
@@ -6813,7 +8765,7 @@ int libewf_segment_file_read_chunk_group_element_data(
 	if( segment_file->major_version == 1 )
 	{
 		result = libewf_chunk_group_fill_v1(
-			  chunk_group,
+			  *chunk_group,
 			  chunk_index,
 			  segment_file->io_handle->chunk_size,
 			  file_io_pool_entry,
@@ -6828,7 +8780,7 @@ int libewf_segment_file_read_chunk_group_element_data(
 	else if( segment_file->major_version == 2 )
 	{
 		result = libewf_chunk_group_fill_v2(
-			  chunk_group,
+			  *chunk_group,
 			  chunk_index,
 			  segment_file->io_handle->chunk_size,
 			  file_io_pool_entry,
@@ -6850,11 +8802,13 @@ int libewf_segment_file_read_chunk_group_element_data(
 
 		goto on_error;
 	}
-	memory_free(
-	 section_data );
-
-	section_data = NULL;
+	if( section_data != NULL )
+	{
+		memory_free(
+		 section_data );
 
+		section_data = NULL;
+	}
 	if( libewf_section_descriptor_free(
 	     &section_descriptor,
 	     error ) != 1 )
@@ -6899,6 +8853,224 @@ int libewf_segment_file_read_chunk_group_element_data(
 		}
 	}
 */
+	return( 1 );
+
+on_error:
+	if( *chunk_group != NULL )
+	{
+		libewf_chunk_group_free(
+		 chunk_group,
+		 NULL );
+	}
+	if( section_data != NULL )
+	{
+		memory_free(
+		 section_data );
+	}
+	if( section_descriptor != NULL )
+	{
+		libewf_section_descriptor_free(
+		 &section_descriptor,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads a chunk group
+ * Callback function for the chunk groups list
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_read_chunk_group_element_data(
+     libewf_segment_file_t *segment_file,
+     libbfio_pool_t *file_io_pool,
+     libfdata_list_element_t *element,
+     libfdata_cache_t *cache,
+     int file_io_pool_entry,
+     off64_t chunk_group_data_offset,
+     size64_t chunk_group_data_size,
+     uint32_t element_flags LIBEWF_ATTRIBUTE_UNUSED,
+     uint8_t read_flags LIBEWF_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	libewf_chunk_group_t *chunk_group           = NULL;
+	libewf_chunk_group_t *recovered_chunk_group = NULL;
+	static char *function                       = "libewf_segment_file_read_chunk_group_element_data";
+	int element_index                           = 0;
+	int number_of_recovered_chunk_groups        = 0;
+
+	LIBEWF_UNREFERENCED_PARAMETER( element_flags )
+	LIBEWF_UNREFERENCED_PARAMETER( read_flags )
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file->chunk_groups_list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment file - missing chunk groups list.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file->io_handle->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment file - invalid IO handle - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	/* The chunk group is read when it is not in the chunk groups cache
+	 */
+	if( segment_file->io_handle->statistics != NULL )
+	{
+		if( libewf_statistics_add_cache_miss(
+		     segment_file->io_handle->statistics,
+		     LIBEWF_STATISTICS_CACHE_TYPE_CHUNK_GROUPS,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to add chunk groups cache miss to statistics.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* A chunk group that was recovered from the chunk data is used instead
+	 * of the corrupted table entries
+	 */
+	if( segment_file->recovered_chunk_groups != NULL )
+	{
+		if( libfdata_list_element_get_element_index(
+		     element,
+		     &element_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element index.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcdata_array_get_number_of_entries(
+		     segment_file->recovered_chunk_groups,
+		     &number_of_recovered_chunk_groups,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of recovered chunk groups.",
+			 function );
+
+			goto on_error;
+		}
+		if( element_index < number_of_recovered_chunk_groups )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     segment_file->recovered_chunk_groups,
+			     element_index,
+			     (intptr_t **) &recovered_chunk_group,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve recovered chunk group: %d.",
+				 function,
+				 element_index );
+
+				goto on_error;
+			}
+		}
+	}
+	if( recovered_chunk_group != NULL )
+	{
+		if( libewf_chunk_group_clone(
+		     &chunk_group,
+		     recovered_chunk_group,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create chunk group.",
+			 function );
+
+			goto on_error;
+		}
+		if( libfdata_list_element_set_element_value(
+		     element,
+		     (intptr_t *) file_io_pool,
+		     cache,
+		     (intptr_t *) chunk_group,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_group_free,
+		     LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set chunk group as element value.",
+			 function );
+
+			goto on_error;
+		}
+		return( 1 );
+	}
+	if( libewf_segment_file_read_chunk_group(
+	     segment_file,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     chunk_group_data_offset,
+	     chunk_group_data_size,
+	     &chunk_group,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk group.",
+		 function );
+
+		goto on_error;
+	}
 	if( libfdata_list_element_set_element_value(
 	     element,
 	     (intptr_t *) file_io_pool,
@@ -6926,17 +9098,6 @@ on_error:
 		 &chunk_group,
 		 NULL );
 	}
-	if( section_data != NULL )
-	{
-		memory_free(
-		 section_data );
-	}
-	if( section_descriptor != NULL )
-	{
-		libewf_section_descriptor_free(
-		 &section_descriptor,
-		 NULL );
-	}
 	return( -1 );
 }
 
@@ -6967,6 +9128,24 @@ int libewf_segment_file_get_chunk_group_by_offset(
 
 		return( -1 );
 	}
+	if( ( segment_file->io_handle != NULL )
+	 && ( segment_file->io_handle->statistics != NULL ) )
+	{
+		if( libewf_statistics_add_cache_lookup(
+		     segment_file->io_handle->statistics,
+		     LIBEWF_STATISTICS_CACHE_TYPE_CHUNK_GROUPS,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to add chunk groups cache lookup to statistics.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	result = libfdata_list_get_element_value_at_offset(
 		  segment_file->chunk_groups_list,
 		  (intptr_t *) file_io_pool,
@@ -47,6 +47,7 @@
 #include "libewf_libfvalue.h"
 #include "libewf_media_values.h"
 #include "libewf_section_descriptor.h"
+#include "libewf_sector_range_list.h"
 #include "libewf_single_files.h"
 
 #include "ewf_data.h"
@@ -118,6 +119,11 @@ struct libewf_segment_file
 	 */
 	int chunk_groups_index;
 
+	/* The chunk groups recovered from the chunk data of corrupted tables
+	 * by chunk groups index
+	 */
+	libcdata_array_t *recovered_chunk_groups;
+
 	/* The storage media size (in the segment file)
 	 */
 	size64_t storage_media_size;
@@ -138,9 +144,38 @@ struct libewf_segment_file
 	 */
 	int64_t last_chunk_compared;
 
+	/* Value to indicate the last table section was read without corruption
+	 * and the corresponding table2 section does not need to be read
+	 */
+	uint8_t table_is_valid;
+
+	/* The write buffer in which consecutive chunks are combined
+	 * before they are written to the segment file
+	 */
+	uint8_t *write_buffer;
+
+	/* The size of the data in the write buffer
+	 */
+	size_t write_buffer_data_size;
+
+	/* The table buffer into which a table section is read with a single read
+	 * it is reused for the table sections of subsequent chunk groups
+	 */
+	uint8_t *table_buffer;
+
+	/* The size of the table buffer
+	 */
+	size_t table_buffer_size;
+
 	/* Flags
 	 */
 	uint8_t flags;
+
+#if defined( HAVE_LIBEWF_MEMORY_ACCOUNTING )
+	/* The size of the memory accounted for the segment file
+	 */
+	size_t accounted_memory_size;
+#endif
 };
 
 int libewf_segment_file_initialize(
@@ -157,6 +192,14 @@ int libewf_segment_file_clone(
      libewf_segment_file_t *source_segment_file,
      libcerror_error_t **error );
 
+#if defined( HAVE_LIBEWF_MEMORY_ACCOUNTING )
+
+int libewf_segment_file_update_memory_accounting(
+     libewf_segment_file_t *segment_file,
+     libcerror_error_t **error );
+
+#endif
+
 int libewf_segment_file_get_number_of_sections(
      libewf_segment_file_t *segment_file,
      int *number_of_sections,
@@ -204,6 +247,14 @@ ssize_t libewf_segment_file_read_table2_section(
          int file_io_pool_entry,
          libcerror_error_t **error );
 
+int libewf_segment_file_recover_chunk_group(
+     libewf_segment_file_t *segment_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t table_section_offset,
+     uint32_t number_of_entries,
+     libcerror_error_t **error );
+
 ssize_t libewf_segment_file_read_volume_section(
          libewf_segment_file_t *segment_file,
          libewf_section_descriptor_t *section,
@@ -320,6 +371,12 @@ ssize_t libewf_segment_file_write_chunk_data(
          libewf_chunk_data_t *chunk_data,
          libcerror_error_t **error );
 
+ssize_t libewf_segment_file_flush_write_buffer(
+         libewf_segment_file_t *segment_file,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         libcerror_error_t **error );
+
 ssize_t libewf_segment_file_write_hash_sections(
          libewf_segment_file_t *segment_file,
          libbfio_pool_t *file_io_pool,
@@ -339,7 +396,7 @@ ssize_t libewf_segment_file_write_close(
          libewf_media_values_t *media_values,
          libcdata_array_t *sessions,
          libcdata_array_t *tracks,
-         libcdata_range_list_t *acquiry_errors,
+         libewf_sector_range_list_t *acquiry_errors,
          ewf_data_t **data_section,
          libcerror_error_t **error );
 
@@ -364,7 +421,7 @@ int libewf_segment_file_write_sections_correction(
      libewf_hash_sections_t *hash_sections,
      libcdata_array_t *sessions,
      libcdata_array_t *tracks,
-     libcdata_range_list_t *acquiry_errors,
+     libewf_sector_range_list_t *acquiry_errors,
      uint8_t **case_data,
      size_t *case_data_size,
      uint8_t **device_information,
@@ -372,6 +429,36 @@ int libewf_segment_file_write_sections_correction(
      ewf_data_t **data_section,
      libcerror_error_t **error );
 
+int libewf_segment_file_read_section_list(
+     libewf_segment_file_t *segment_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size_t file_header_size,
+     size64_t segment_file_size,
+     libcerror_error_t **error );
+
+int libewf_segment_file_read_index_entry_data(
+     libewf_segment_file_t *segment_file,
+     const uint8_t *entry_data,
+     size_t entry_data_size,
+     int file_io_pool_entry,
+     size64_t segment_file_size,
+     libcerror_error_t **error );
+
+int libewf_segment_file_get_index_entry_data(
+     libewf_segment_file_t *segment_file,
+     size64_t segment_file_size,
+     uint8_t **entry_data,
+     size_t *entry_data_size,
+     libcerror_error_t **error );
+
+int libewf_segment_file_read_file_io_pool(
+     libewf_segment_file_t *segment_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size64_t segment_file_size,
+     libcerror_error_t **error );
+
 int libewf_segment_file_read_element_data(
      libewf_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
@@ -396,6 +483,23 @@ int libewf_segment_file_read_section_element_data(
      uint8_t read_flags,
      libcerror_error_t **error );
 
+ssize_t libewf_segment_file_read_table_buffer(
+         libewf_segment_file_t *segment_file,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         off64_t table_offset,
+         size_t table_size,
+         libcerror_error_t **error );
+
+int libewf_segment_file_read_chunk_group(
+     libewf_segment_file_t *segment_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t chunk_group_data_offset,
+     size64_t chunk_group_data_size,
+     libewf_chunk_group_t **chunk_group,
+     libcerror_error_t **error );
+
 int libewf_segment_file_read_chunk_group_element_data(
      libewf_segment_file_t *segment_file,
      libbfio_pool_t *file_io_pool,
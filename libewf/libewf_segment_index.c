@@ -0,0 +1,1111 @@
+/*
+ * Segment index (sidecar) file functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_checksum.h"
+#include "libewf_definitions.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_segment_index.h"
+
+#include "ewf_segment_index.h"
+
+const uint8_t ewf_segment_index_file_signature[ 8 ] = { 'E', 'W', 'F', 'I', 'D', 'X', 0x00, 0x01 };
+
+/* Creates a segment index
+ * Make sure the value segment_index is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_index_initialize(
+     libewf_segment_index_t **segment_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_index_initialize";
+
+	if( segment_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid segment index value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*segment_index = memory_allocate_structure(
+	                  libewf_segment_index_t );
+
+	if( *segment_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segment index.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *segment_index,
+	     0,
+	     sizeof( libewf_segment_index_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear segment index.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *segment_index != NULL )
+	{
+		memory_free(
+		 *segment_index );
+
+		*segment_index = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees the entries of a segment index
+ */
+void libewf_segment_index_free_entries(
+      libewf_segment_index_t *segment_index )
+{
+	uint32_t entry_index = 0;
+
+	if( segment_index->entries_data != NULL )
+	{
+		for( entry_index = 0;
+		     entry_index < segment_index->number_of_segments;
+		     entry_index++ )
+		{
+			if( segment_index->entries_data[ entry_index ] != NULL )
+			{
+				memory_free(
+				 segment_index->entries_data[ entry_index ] );
+			}
+		}
+		memory_free(
+		 segment_index->entries_data );
+
+		segment_index->entries_data = NULL;
+	}
+	if( segment_index->entries_data_size != NULL )
+	{
+		memory_free(
+		 segment_index->entries_data_size );
+
+		segment_index->entries_data_size = NULL;
+	}
+	segment_index->number_of_segments = 0;
+}
+
+/* Frees a segment index
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_index_free(
+     libewf_segment_index_t **segment_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_index_free";
+
+	if( segment_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_index != NULL )
+	{
+		libewf_segment_index_free_entries(
+		 *segment_index );
+
+		memory_free(
+		 *segment_index );
+
+		*segment_index = NULL;
+	}
+	return( 1 );
+}
+
+/* Sets the number of segments
+ * This frees any existing entries
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_index_set_number_of_segments(
+     libewf_segment_index_t *segment_index,
+     uint32_t number_of_segments,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_index_set_number_of_segments";
+	size_t array_size     = 0;
+
+	if( segment_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_segments == 0 )
+	 || ( (size_t) number_of_segments > ( (size_t) SSIZE_MAX / sizeof( uint8_t * ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of segments value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	libewf_segment_index_free_entries(
+	 segment_index );
+
+	array_size = sizeof( uint8_t * ) * number_of_segments;
+
+	segment_index->entries_data = (uint8_t **) memory_allocate(
+	                                            array_size );
+
+	if( segment_index->entries_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     segment_index->entries_data,
+	     0,
+	     array_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entries data.",
+		 function );
+
+		goto on_error;
+	}
+	array_size = sizeof( size_t ) * number_of_segments;
+
+	segment_index->entries_data_size = (size_t *) memory_allocate(
+	                                               array_size );
+
+	if( segment_index->entries_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries data sizes.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     segment_index->entries_data_size,
+	     0,
+	     array_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entries data sizes.",
+		 function );
+
+		goto on_error;
+	}
+	segment_index->number_of_segments = number_of_segments;
+
+	return( 1 );
+
+on_error:
+	if( segment_index->entries_data_size != NULL )
+	{
+		memory_free(
+		 segment_index->entries_data_size );
+
+		segment_index->entries_data_size = NULL;
+	}
+	if( segment_index->entries_data != NULL )
+	{
+		memory_free(
+		 segment_index->entries_data );
+
+		segment_index->entries_data = NULL;
+	}
+	return( -1 );
+}
+
+/* Retrieves the entry data of a specific segment number
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libewf_segment_index_get_entry_data(
+     libewf_segment_index_t *segment_index,
+     uint32_t segment_number,
+     const uint8_t **entry_data,
+     size_t *entry_data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_index_get_entry_data";
+
+	if( segment_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment index.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry data.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_number == 0 )
+	 || ( segment_number > segment_index->number_of_segments ) )
+	{
+		return( 0 );
+	}
+	if( segment_index->entries_data[ segment_number - 1 ] == NULL )
+	{
+		return( 0 );
+	}
+	*entry_data      = segment_index->entries_data[ segment_number - 1 ];
+	*entry_data_size = segment_index->entries_data_size[ segment_number - 1 ];
+
+	return( 1 );
+}
+
+/* Sets the entry data of a specific segment number
+ * The segment index takes over management of the entry data if successful
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_index_set_entry_data(
+     libewf_segment_index_t *segment_index,
+     uint32_t segment_number,
+     uint8_t *entry_data,
+     size_t entry_data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_index_set_entry_data";
+
+	if( segment_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment index.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_number == 0 )
+	 || ( segment_number > segment_index->number_of_segments ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment number value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry_data_size < sizeof( ewf_segment_index_entry_t ) )
+	 || ( entry_data_size > (size_t) LIBEWF_MAXIMUM_SEGMENT_INDEX_FILE_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_index->entries_data[ segment_number - 1 ] != NULL )
+	{
+		memory_free(
+		 segment_index->entries_data[ segment_number - 1 ] );
+	}
+	segment_index->entries_data[ segment_number - 1 ]      = entry_data;
+	segment_index->entries_data_size[ segment_number - 1 ] = entry_data_size;
+
+	return( 1 );
+}
+
+/* Determines the size of the segment index entry data
+ * Returns 1 if successful, 0 if the entry data is not valid or -1 on error
+ */
+int libewf_segment_index_get_entry_data_size(
+     const uint8_t *data,
+     size_t data_size,
+     size_t *entry_data_size,
+     libcerror_error_t **error )
+{
+	static char *function           = "libewf_segment_index_get_entry_data_size";
+	uint32_t number_of_chunk_groups = 0;
+	uint32_t number_of_sections     = 0;
+	size_t safe_entry_data_size     = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size < sizeof( ewf_segment_index_entry_t ) )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewf_segment_index_entry_t *) data )->number_of_sections,
+	 number_of_sections );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewf_segment_index_entry_t *) data )->number_of_chunk_groups,
+	 number_of_chunk_groups );
+
+	if( ( (size_t) number_of_sections > ( data_size / sizeof( ewf_segment_index_section_t ) ) )
+	 || ( (size_t) number_of_chunk_groups > ( data_size / sizeof( ewf_segment_index_chunk_group_t ) ) ) )
+	{
+		return( 0 );
+	}
+	safe_entry_data_size = sizeof( ewf_segment_index_entry_t )
+	                     + ( sizeof( ewf_segment_index_section_t ) * number_of_sections )
+	                     + ( sizeof( ewf_segment_index_chunk_group_t ) * number_of_chunk_groups );
+
+	if( safe_entry_data_size > data_size )
+	{
+		return( 0 );
+	}
+	*entry_data_size = safe_entry_data_size;
+
+	return( 1 );
+}
+
+/* Reads a segment index using a Basic File IO (bfio) handle
+ * Returns 1 if successful, 0 if the file does not contain a valid segment index or -1 on error
+ */
+int libewf_segment_index_read_file_io_handle(
+     libewf_segment_index_t *segment_index,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	uint8_t *data                  = NULL;
+	uint8_t *entry_data            = NULL;
+	static char *function          = "libewf_segment_index_read_file_io_handle";
+	size64_t file_size             = 0;
+	size_t data_offset             = 0;
+	size_t data_size               = 0;
+	size_t entry_data_size         = 0;
+	ssize_t read_count             = 0;
+	uint32_t calculated_checksum   = 0;
+	uint32_t entry_index           = 0;
+	uint32_t format_version        = 0;
+	uint32_t number_of_segments    = 0;
+	uint32_t segment_number        = 0;
+	uint32_t stored_checksum       = 0;
+	int file_io_handle_is_open     = 0;
+	int result                     = 1;
+
+	if( segment_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment index.",
+		 function );
+
+		return( -1 );
+	}
+	file_io_handle_is_open = libbfio_handle_is_open(
+	                          file_io_handle,
+	                          error );
+
+	if( file_io_handle_is_open == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to determine if file is open.",
+		 function );
+
+		return( -1 );
+	}
+	else if( file_io_handle_is_open == 0 )
+	{
+		if( libbfio_handle_open(
+		     file_io_handle,
+		     LIBBFIO_OPEN_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libbfio_handle_get_size(
+	     file_io_handle,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file size.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( file_size < ( sizeof( ewf_segment_index_file_header_t ) + sizeof( ewf_segment_index_file_footer_t ) ) )
+	 || ( file_size > (size64_t) LIBEWF_MAXIMUM_SEGMENT_INDEX_FILE_SIZE ) )
+	{
+		result = 0;
+	}
+	if( result != 0 )
+	{
+		data_size = (size_t) file_size;
+
+		data = (uint8_t *) memory_allocate(
+		                    sizeof( uint8_t ) * data_size );
+
+		if( data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create data.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbfio_handle_seek_offset(
+		     file_io_handle,
+		     0,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek file header offset: 0.",
+			 function );
+
+			goto on_error;
+		}
+		read_count = libbfio_handle_read_buffer(
+		              file_io_handle,
+		              data,
+		              data_size,
+		              error );
+
+		if( read_count != (ssize_t) data_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read segment index data.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_compare(
+		     ( (ewf_segment_index_file_header_t *) data )->signature,
+		     ewf_segment_index_file_signature,
+		     8 ) != 0 )
+		{
+			result = 0;
+		}
+	}
+	if( result != 0 )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (ewf_segment_index_file_footer_t *) &( data[ data_size - sizeof( ewf_segment_index_file_footer_t ) ] ) )->checksum,
+		 stored_checksum );
+
+		if( libewf_checksum_calculate_adler32(
+		     &calculated_checksum,
+		     data,
+		     data_size - sizeof( ewf_segment_index_file_footer_t ),
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to calculate checksum.",
+			 function );
+
+			goto on_error;
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (ewf_segment_index_file_header_t *) data )->format_version,
+		 format_version );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (ewf_segment_index_file_header_t *) data )->number_of_segments,
+		 number_of_segments );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (ewf_segment_index_file_header_t *) data )->chunk_size,
+		 segment_index->chunk_size );
+
+		if( ( stored_checksum != calculated_checksum )
+		 || ( format_version != 1 )
+		 || ( number_of_segments == 0 )
+		 || ( (size_t) number_of_segments > ( data_size / sizeof( ewf_segment_index_entry_t ) ) ) )
+		{
+			result = 0;
+		}
+	}
+	if( result != 0 )
+	{
+		if( libewf_segment_index_set_number_of_segments(
+		     segment_index,
+		     number_of_segments,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set number of segments.",
+			 function );
+
+			goto on_error;
+		}
+		data_offset = sizeof( ewf_segment_index_file_header_t );
+		data_size  -= sizeof( ewf_segment_index_file_footer_t );
+
+		for( entry_index = 0;
+		     entry_index < number_of_segments;
+		     entry_index++ )
+		{
+			result = libewf_segment_index_get_entry_data_size(
+			          &( data[ data_offset ] ),
+			          data_size - data_offset,
+			          &entry_data_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine entry: %" PRIu32 " data size.",
+				 function,
+				 entry_index );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				break;
+			}
+			byte_stream_copy_to_uint32_little_endian(
+			 ( (ewf_segment_index_entry_t *) &( data[ data_offset ] ) )->segment_number,
+			 segment_number );
+
+			if( segment_number != ( entry_index + 1 ) )
+			{
+				result = 0;
+
+				break;
+			}
+			entry_data = (uint8_t *) memory_allocate(
+			                          sizeof( uint8_t ) * entry_data_size );
+
+			if( entry_data == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create entry data.",
+				 function );
+
+				goto on_error;
+			}
+			if( memory_copy(
+			     entry_data,
+			     &( data[ data_offset ] ),
+			     entry_data_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy entry data.",
+				 function );
+
+				goto on_error;
+			}
+			if( libewf_segment_index_set_entry_data(
+			     segment_index,
+			     segment_number,
+			     entry_data,
+			     entry_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set entry: %" PRIu32 " data.",
+				 function,
+				 entry_index );
+
+				goto on_error;
+			}
+			entry_data = NULL;
+
+			data_offset += entry_data_size;
+		}
+		if( ( result != 0 )
+		 && ( data_offset != data_size ) )
+		{
+			result = 0;
+		}
+		if( result == 0 )
+		{
+			libewf_segment_index_free_entries(
+			 segment_index );
+		}
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+
+		data = NULL;
+	}
+	if( file_io_handle_is_open == 0 )
+	{
+		if( libbfio_handle_close(
+		     file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( result );
+
+on_error:
+	if( entry_data != NULL )
+	{
+		memory_free(
+		 entry_data );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	libewf_segment_index_free_entries(
+	 segment_index );
+
+	if( file_io_handle_is_open == 0 )
+	{
+		libbfio_handle_close(
+		 file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes a segment index using a Basic File IO (bfio) handle
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_index_write_file_io_handle(
+     libewf_segment_index_t *segment_index,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	uint8_t *data                = NULL;
+	static char *function        = "libewf_segment_index_write_file_io_handle";
+	size_t data_offset           = 0;
+	size_t data_size             = 0;
+	ssize_t write_count          = 0;
+	uint32_t calculated_checksum = 0;
+	uint32_t entry_index         = 0;
+	int file_io_handle_is_open   = 0;
+
+	if( segment_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment index.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_index->number_of_segments == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment index - missing entries.",
+		 function );
+
+		return( -1 );
+	}
+	data_size = sizeof( ewf_segment_index_file_header_t ) + sizeof( ewf_segment_index_file_footer_t );
+
+	for( entry_index = 0;
+	     entry_index < segment_index->number_of_segments;
+	     entry_index++ )
+	{
+		if( segment_index->entries_data[ entry_index ] == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid segment index - missing entry: %" PRIu32 " data.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		data_size += segment_index->entries_data_size[ entry_index ];
+
+		if( data_size > (size_t) LIBEWF_MAXIMUM_SEGMENT_INDEX_FILE_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid segment index data size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * data_size );
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     data,
+	     0,
+	     sizeof( ewf_segment_index_file_header_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file header.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     ( (ewf_segment_index_file_header_t *) data )->signature,
+	     ewf_segment_index_file_signature,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy signature.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_segment_index_file_header_t *) data )->format_version,
+	 1 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_segment_index_file_header_t *) data )->number_of_segments,
+	 segment_index->number_of_segments );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_segment_index_file_header_t *) data )->chunk_size,
+	 segment_index->chunk_size );
+
+	data_offset = sizeof( ewf_segment_index_file_header_t );
+
+	for( entry_index = 0;
+	     entry_index < segment_index->number_of_segments;
+	     entry_index++ )
+	{
+		if( memory_copy(
+		     &( data[ data_offset ] ),
+		     segment_index->entries_data[ entry_index ],
+		     segment_index->entries_data_size[ entry_index ] ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy entry: %" PRIu32 " data.",
+			 function,
+			 entry_index );
+
+			goto on_error;
+		}
+		data_offset += segment_index->entries_data_size[ entry_index ];
+	}
+	if( libewf_checksum_calculate_adler32(
+	     &calculated_checksum,
+	     data,
+	     data_offset,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate checksum.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     &( data[ data_offset ] ),
+	     0,
+	     sizeof( ewf_segment_index_file_footer_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file footer.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_segment_index_file_footer_t *) &( data[ data_offset ] ) )->checksum,
+	 calculated_checksum );
+
+	file_io_handle_is_open = libbfio_handle_is_open(
+	                          file_io_handle,
+	                          error );
+
+	if( file_io_handle_is_open == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to determine if file is open.",
+		 function );
+
+		goto on_error;
+	}
+	else if( file_io_handle_is_open == 0 )
+	{
+		if( libbfio_handle_open(
+		     file_io_handle,
+		     LIBBFIO_OPEN_WRITE_TRUNCATE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	write_count = libbfio_handle_write_buffer(
+	               file_io_handle,
+	               data,
+	               data_size,
+	               error );
+
+	if( write_count != (ssize_t) data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write segment index data.",
+		 function );
+
+		goto on_error;
+	}
+	if( file_io_handle_is_open == 0 )
+	{
+		file_io_handle_is_open = 1;
+
+		if( libbfio_handle_close(
+		     file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	memory_free(
+	 data );
+
+	return( 1 );
+
+on_error:
+	if( file_io_handle_is_open == 0 )
+	{
+		libbfio_handle_close(
+		 file_io_handle,
+		 NULL );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( -1 );
+}
+
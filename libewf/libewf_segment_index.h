@@ -0,0 +1,112 @@
+/*
+ * Segment index (sidecar) file functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_SEGMENT_INDEX_H )
+#define _LIBEWF_SEGMENT_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+extern const uint8_t ewf_segment_index_file_signature[ 8 ];
+
+typedef struct libewf_segment_index libewf_segment_index_t;
+
+/* The segment index contains the section list and chunk groups of the segment files
+ * so that these do not need to be read from the segment files when they are opened
+ */
+struct libewf_segment_index
+{
+	/* The chunk size
+	 */
+	size32_t chunk_size;
+
+	/* The number of segments
+	 */
+	uint32_t number_of_segments;
+
+	/* The entries data, one per segment file
+	 */
+	uint8_t **entries_data;
+
+	/* The entries data sizes
+	 */
+	size_t *entries_data_size;
+};
+
+int libewf_segment_index_initialize(
+     libewf_segment_index_t **segment_index,
+     libcerror_error_t **error );
+
+void libewf_segment_index_free_entries(
+      libewf_segment_index_t *segment_index );
+
+int libewf_segment_index_free(
+     libewf_segment_index_t **segment_index,
+     libcerror_error_t **error );
+
+int libewf_segment_index_set_number_of_segments(
+     libewf_segment_index_t *segment_index,
+     uint32_t number_of_segments,
+     libcerror_error_t **error );
+
+int libewf_segment_index_get_entry_data(
+     libewf_segment_index_t *segment_index,
+     uint32_t segment_number,
+     const uint8_t **entry_data,
+     size_t *entry_data_size,
+     libcerror_error_t **error );
+
+int libewf_segment_index_set_entry_data(
+     libewf_segment_index_t *segment_index,
+     uint32_t segment_number,
+     uint8_t *entry_data,
+     size_t entry_data_size,
+     libcerror_error_t **error );
+
+int libewf_segment_index_get_entry_data_size(
+     const uint8_t *data,
+     size_t data_size,
+     size_t *entry_data_size,
+     libcerror_error_t **error );
+
+int libewf_segment_index_read_file_io_handle(
+     libewf_segment_index_t *segment_index,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_segment_index_write_file_io_handle(
+     libewf_segment_index_t *segment_index,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_SEGMENT_INDEX_H ) */
+
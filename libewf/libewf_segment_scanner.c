@@ -0,0 +1,1051 @@
+/*
+ * Segment scanner functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_definitions.h"
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+#include "libewf_segment_file.h"
+#include "libewf_segment_scanner.h"
+#include "libewf_segment_table.h"
+
+/* Creates a segment scanner
+ * Make sure the value segment_scanner is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_scanner_initialize(
+     libewf_segment_scanner_t **segment_scanner,
+     libewf_io_handle_t *io_handle,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_scanner_initialize";
+	size_t entries_size   = 0;
+
+	if( segment_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_scanner != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid segment scanner value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > LIBEWF_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*segment_scanner = memory_allocate_structure(
+	                    libewf_segment_scanner_t );
+
+	if( *segment_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segment scanner.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *segment_scanner,
+	     0,
+	     sizeof( libewf_segment_scanner_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear segment scanner.",
+		 function );
+
+		memory_free(
+		 *segment_scanner );
+
+		*segment_scanner = NULL;
+
+		return( -1 );
+	}
+	( *segment_scanner )->io_handle                 = io_handle;
+	( *segment_scanner )->number_of_threads         = number_of_threads;
+	( *segment_scanner )->maximum_number_of_entries = number_of_threads * LIBEWF_SEGMENT_SCANNER_NUMBER_OF_SEGMENTS_PER_THREAD;
+
+	entries_size = sizeof( libewf_segment_scanner_entry_t ) * ( *segment_scanner )->maximum_number_of_entries;
+
+	( *segment_scanner )->entries = (libewf_segment_scanner_entry_t *) memory_allocate(
+	                                                                    entries_size );
+
+	if( ( *segment_scanner )->entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *segment_scanner )->entries,
+	     0,
+	     entries_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entries.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *segment_scanner )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *segment_scanner )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_thread_pool_create(
+	     &( ( *segment_scanner )->thread_pool ),
+	     NULL,
+	     number_of_threads,
+	     ( *segment_scanner )->maximum_number_of_entries,
+	     (int (*)(intptr_t *, void *)) &libewf_segment_scanner_scan_callback,
+	     (void *) *segment_scanner,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread pool.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *segment_scanner != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *segment_scanner )->condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *segment_scanner )->condition ),
+			 NULL );
+		}
+		if( ( *segment_scanner )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *segment_scanner )->mutex ),
+			 NULL );
+		}
+#endif
+		if( ( *segment_scanner )->entries != NULL )
+		{
+			memory_free(
+			 ( *segment_scanner )->entries );
+		}
+		memory_free(
+		 *segment_scanner );
+
+		*segment_scanner = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a segment scanner
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_scanner_free(
+     libewf_segment_scanner_t **segment_scanner,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_scanner_free";
+	int result            = 1;
+
+	if( segment_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_scanner != NULL )
+	{
+		/* The io_handle reference is freed elsewhere
+		 */
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *segment_scanner )->thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *segment_scanner )->thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_condition_free(
+		     &( ( *segment_scanner )->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *segment_scanner )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		if( libewf_segment_scanner_clear_entries(
+		     *segment_scanner,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to clear entries.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 ( *segment_scanner )->entries );
+
+		memory_free(
+		 *segment_scanner );
+
+		*segment_scanner = NULL;
+	}
+	return( result );
+}
+
+/* Clears the entries of the current batch
+ * Frees the segment files that have not been retrieved
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_scanner_clear_entries(
+     libewf_segment_scanner_t *segment_scanner,
+     libcerror_error_t **error )
+{
+	libewf_segment_scanner_entry_t *entry = NULL;
+	static char *function                 = "libewf_segment_scanner_clear_entries";
+	int entry_index                       = 0;
+	int result                            = 1;
+
+	if( segment_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment scanner.",
+		 function );
+
+		return( -1 );
+	}
+	for( entry_index = 0;
+	     entry_index < segment_scanner->number_of_entries;
+	     entry_index++ )
+	{
+		entry = &( segment_scanner->entries[ entry_index ] );
+
+		if( entry->file_io_handle != NULL )
+		{
+			if( libbfio_handle_free(
+			     &( entry->file_io_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free entry: %d file IO handle.",
+				 function,
+				 entry_index );
+
+				result = -1;
+			}
+		}
+		if( entry->segment_file != NULL )
+		{
+			if( libewf_segment_file_free(
+			     &( entry->segment_file ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free entry: %d segment file.",
+				 function,
+				 entry_index );
+
+				result = -1;
+			}
+		}
+	}
+	segment_scanner->number_of_entries = 0;
+
+	return( result );
+}
+
+/* Reads the file header and section list of the segment file of an entry
+ * The segment file is read using the file IO handle of the entry
+ * so it can be read in parallel with other entries
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_scanner_read_entry(
+     libewf_segment_scanner_t *segment_scanner,
+     libewf_segment_scanner_entry_t *entry,
+     libcerror_error_t **error )
+{
+	libbfio_pool_t *file_io_pool        = NULL;
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_segment_scanner_read_entry";
+
+	if( segment_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid entry - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry->file_io_pool_entry < 0 )
+	 || ( entry->file_io_pool_entry == INT_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry - file IO pool entry value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* The section and chunk group ranges refer to the file IO pool entry
+	 * hence the private file IO pool uses the same entry
+	 */
+	if( libbfio_pool_initialize(
+	     &file_io_pool,
+	     entry->file_io_pool_entry + 1,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_set_handle(
+	     file_io_pool,
+	     entry->file_io_pool_entry,
+	     entry->file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set file IO handle: %d in pool.",
+		 function,
+		 entry->file_io_pool_entry );
+
+		goto on_error;
+	}
+	/* The file IO handle is now managed by the file IO pool
+	 */
+	entry->file_io_handle = NULL;
+
+	if( libewf_segment_file_initialize(
+	     &segment_file,
+	     segment_scanner->io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_segment_file_read_file_io_pool(
+	     segment_file,
+	     file_io_pool,
+	     entry->file_io_pool_entry,
+	     entry->segment_file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read segment file: %" PRIu32 ".",
+		 function,
+		 entry->segment_number );
+
+		goto on_error;
+	}
+	if( libbfio_pool_close_all(
+	     file_io_pool,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_free(
+	     &file_io_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	entry->segment_file = segment_file;
+
+	return( 1 );
+
+on_error:
+	if( segment_file != NULL )
+	{
+		libewf_segment_file_free(
+		 &segment_file,
+		 NULL );
+	}
+	if( file_io_pool != NULL )
+	{
+		libbfio_pool_close_all(
+		 file_io_pool,
+		 NULL );
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Scans a segment file
+ * Callback function for the thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_scanner_scan_callback(
+     libewf_segment_scanner_entry_t *entry,
+     libewf_segment_scanner_t *segment_scanner )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "libewf_segment_scanner_scan_callback";
+
+	if( segment_scanner == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment scanner.",
+		 function );
+
+		goto on_error;
+	}
+	/* A segment file that could not be scanned is read again
+	 * by the caller to report the error
+	 */
+	if( libewf_segment_scanner_read_entry(
+	     segment_scanner,
+	     entry,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read entry.",
+		 function );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( libcthreads_mutex_grab(
+	     segment_scanner->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	segment_scanner->number_of_pending_entries -= 1;
+
+	if( segment_scanner->number_of_pending_entries == 0 )
+	{
+		if( libcthreads_condition_broadcast(
+		     segment_scanner->condition,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 segment_scanner->mutex,
+			 NULL );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     segment_scanner->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+	}
+#endif
+	libcerror_error_free(
+	 &error );
+
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* Scans a batch of segment files starting with a specific segment number
+ * Segment files that could not be scanned have no segment file set in their entry
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_scanner_scan(
+     libewf_segment_scanner_t *segment_scanner,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     uint32_t first_segment_number,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle      = NULL;
+	libewf_segment_scanner_entry_t *entry = NULL;
+	static char *function                 = "libewf_segment_scanner_scan";
+	uint32_t number_of_segments           = 0;
+	int entry_index                       = 0;
+	int number_of_entries                 = 0;
+	int result                            = 1;
+
+	if( segment_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_segment_table_get_number_of_segments(
+	     segment_table,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments from segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( first_segment_number >= number_of_segments )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid first segment number value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_segment_scanner_clear_entries(
+	     segment_scanner,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear entries.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_entries = segment_scanner->maximum_number_of_entries;
+
+	if( (uint32_t) number_of_entries > ( number_of_segments - first_segment_number ) )
+	{
+		number_of_entries = (int) ( number_of_segments - first_segment_number );
+	}
+	/* The file IO pool is not thread-safe hence the file IO handles
+	 * are cloned on the calling thread
+	 */
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		entry = &( segment_scanner->entries[ entry_index ] );
+
+		entry->segment_number = first_segment_number + (uint32_t) entry_index;
+		entry->file_io_handle = NULL;
+		entry->segment_file   = NULL;
+
+		segment_scanner->number_of_entries += 1;
+
+		if( libewf_segment_table_get_segment_by_index(
+		     segment_table,
+		     entry->segment_number,
+		     &( entry->file_io_pool_entry ),
+		     &( entry->segment_file_size ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
+			 function,
+			 entry->segment_number );
+
+			goto on_error;
+		}
+		if( libbfio_pool_get_handle(
+		     file_io_pool,
+		     entry->file_io_pool_entry,
+		     &file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file IO handle: %d from pool.",
+			 function,
+			 entry->file_io_pool_entry );
+
+			goto on_error;
+		}
+		if( libbfio_handle_clone(
+		     &( entry->file_io_handle ),
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file IO handle: %d.",
+			 function,
+			 entry->file_io_pool_entry );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     segment_scanner->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	segment_scanner->number_of_pending_entries = number_of_entries;
+
+	if( libcthreads_mutex_release(
+	     segment_scanner->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		entry = &( segment_scanner->entries[ entry_index ] );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_thread_pool_push(
+		     segment_scanner->thread_pool,
+		     (intptr_t *) entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push entry: %d onto thread pool queue.",
+			 function,
+			 entry_index );
+
+			/* Do not wait for the entries that were not pushed
+			 */
+			libcthreads_mutex_grab(
+			 segment_scanner->mutex,
+			 NULL );
+
+			segment_scanner->number_of_pending_entries -= number_of_entries - entry_index;
+
+			libcthreads_mutex_release(
+			 segment_scanner->mutex,
+			 NULL );
+
+			result = -1;
+
+			break;
+		}
+#else
+		if( libewf_segment_scanner_read_entry(
+		     segment_scanner,
+		     entry,
+		     error ) != 1 )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( ( libcnotify_verbose != 0 )
+			 && ( error != NULL )
+			 && ( *error != NULL ) )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+#endif
+			libcerror_error_free(
+			 error );
+		}
+#endif
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* Wait for the worker threads to scan the batch
+	 */
+	if( libcthreads_mutex_grab(
+	     segment_scanner->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( segment_scanner->number_of_pending_entries > 0 )
+	{
+		if( libcthreads_condition_wait(
+		     segment_scanner->condition,
+		     segment_scanner->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     segment_scanner->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+
+on_error:
+	libewf_segment_scanner_clear_entries(
+	 segment_scanner,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Retrieves the scanned segment file of a specific segment number
+ * A new batch is scanned if the segment number is not part of the current batch
+ * The caller takes over management of the segment file
+ * Returns 1 if successful, 0 if the segment file could not be scanned or -1 on error
+ */
+int libewf_segment_scanner_get_segment_file(
+     libewf_segment_scanner_t *segment_scanner,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     uint32_t segment_number,
+     libewf_segment_file_t **segment_file,
+     libcerror_error_t **error )
+{
+	libewf_segment_scanner_entry_t *entry = NULL;
+	static char *function                 = "libewf_segment_scanner_get_segment_file";
+	int entry_index                       = 0;
+
+	if( segment_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_scanner->number_of_entries == 0 )
+	 || ( segment_number < segment_scanner->entries[ 0 ].segment_number )
+	 || ( ( segment_number - segment_scanner->entries[ 0 ].segment_number ) >= (uint32_t) segment_scanner->number_of_entries ) )
+	{
+		if( libewf_segment_scanner_scan(
+		     segment_scanner,
+		     file_io_pool,
+		     segment_table,
+		     segment_number,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to scan segment files starting with: %" PRIu32 ".",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+	}
+	entry_index = (int) ( segment_number - segment_scanner->entries[ 0 ].segment_number );
+	entry       = &( segment_scanner->entries[ entry_index ] );
+
+	if( entry->segment_file == NULL )
+	{
+		return( 0 );
+	}
+	*segment_file       = entry->segment_file;
+	entry->segment_file = NULL;
+
+	return( 1 );
+}
+
@@ -0,0 +1,159 @@
+/*
+ * Segment scanner functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_SEGMENT_SCANNER_H )
+#define _LIBEWF_SEGMENT_SCANNER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_segment_file.h"
+#include "libewf_segment_table.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_segment_scanner_entry libewf_segment_scanner_entry_t;
+
+/* A segment file that is scanned by the segment scanner
+ */
+struct libewf_segment_scanner_entry
+{
+	/* The segment number
+	 */
+	uint32_t segment_number;
+
+	/* The file IO pool entry
+	 */
+	int file_io_pool_entry;
+
+	/* The segment file size
+	 */
+	size64_t segment_file_size;
+
+	/* The file IO handle used to scan the segment file
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The scanned segment file
+	 */
+	libewf_segment_file_t *segment_file;
+};
+
+typedef struct libewf_segment_scanner libewf_segment_scanner_t;
+
+/* The segment scanner reads the file header and section list of batches
+ * of segment files using a pool of worker threads
+ */
+struct libewf_segment_scanner
+{
+	/* The IO handle
+	 */
+	libewf_io_handle_t *io_handle;
+
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+	/* The entries of the current batch
+	 */
+	libewf_segment_scanner_entry_t *entries;
+
+	/* The maximum number of entries per batch
+	 */
+	int maximum_number_of_entries;
+
+	/* The number of entries of the current batch
+	 */
+	int number_of_entries;
+
+	/* The number of entries of the current batch that still need to be scanned
+	 */
+	int number_of_pending_entries;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when the current batch was scanned
+	 */
+	libcthreads_condition_t *condition;
+#endif
+};
+
+int libewf_segment_scanner_initialize(
+     libewf_segment_scanner_t **segment_scanner,
+     libewf_io_handle_t *io_handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libewf_segment_scanner_free(
+     libewf_segment_scanner_t **segment_scanner,
+     libcerror_error_t **error );
+
+int libewf_segment_scanner_clear_entries(
+     libewf_segment_scanner_t *segment_scanner,
+     libcerror_error_t **error );
+
+int libewf_segment_scanner_read_entry(
+     libewf_segment_scanner_t *segment_scanner,
+     libewf_segment_scanner_entry_t *entry,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+int libewf_segment_scanner_scan_callback(
+     libewf_segment_scanner_entry_t *entry,
+     libewf_segment_scanner_t *segment_scanner );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+int libewf_segment_scanner_scan(
+     libewf_segment_scanner_t *segment_scanner,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     uint32_t first_segment_number,
+     libcerror_error_t **error );
+
+int libewf_segment_scanner_get_segment_file(
+     libewf_segment_scanner_t *segment_scanner,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     uint32_t segment_number,
+     libewf_segment_file_t **segment_file,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_SEGMENT_SCANNER_H ) */
+
@@ -178,6 +178,7 @@ int libewf_segment_table_free(
 {
 	static char *function = "libewf_segment_table_free";
 	int result            = 1;
+	int stripe_index      = 0;
 
 	if( segment_table == NULL )
 	{
@@ -197,6 +198,13 @@ int libewf_segment_table_free(
 			memory_free(
 			 ( *segment_table )->basename );
 		}
+		for( stripe_index = 0;
+		     stripe_index < ( *segment_table )->number_of_stripe_basenames;
+		     stripe_index++ )
+		{
+			memory_free(
+			 ( *segment_table )->stripe_basenames[ stripe_index ] );
+		}
 		if( libfdata_list_free(
 		     &( ( *segment_table )->segment_files_list ),
 		     error ) != 1 )
@@ -223,6 +231,11 @@ int libewf_segment_table_free(
 
 			result = -1;
 		}
+		if( ( *segment_table )->segment_end_offsets != NULL )
+		{
+			memory_free(
+			 ( *segment_table )->segment_end_offsets );
+		}
 		memory_free(
 		 *segment_table );
 
@@ -240,6 +253,7 @@ int libewf_segment_table_clone(
      libcerror_error_t **error )
 {
 	static char *function = "libewf_segment_table_clone";
+	int stripe_index      = 0;
 
 	if( destination_segment_table == NULL )
 	{
@@ -334,6 +348,44 @@ int libewf_segment_table_clone(
 		}
 		( *destination_segment_table )->basename_size = source_segment_table->basename_size;
 	}
+	for( stripe_index = 0;
+	     stripe_index < source_segment_table->number_of_stripe_basenames;
+	     stripe_index++ )
+	{
+		( *destination_segment_table )->stripe_basenames[ stripe_index ] = system_string_allocate(
+		                                                                    source_segment_table->stripe_basename_sizes[ stripe_index ] );
+
+		if( ( *destination_segment_table )->stripe_basenames[ stripe_index ] == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create destination stripe basename: %d.",
+			 function,
+			 stripe_index );
+
+			goto on_error;
+		}
+		( *destination_segment_table )->number_of_stripe_basenames += 1;
+
+		if( memory_copy(
+		     ( *destination_segment_table )->stripe_basenames[ stripe_index ],
+		     source_segment_table->stripe_basenames[ stripe_index ],
+		     sizeof( system_character_t ) * source_segment_table->stripe_basename_sizes[ stripe_index ] ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy source to destination stripe basename: %d.",
+			 function,
+			 stripe_index );
+
+			goto on_error;
+		}
+		( *destination_segment_table )->stripe_basename_sizes[ stripe_index ] = source_segment_table->stripe_basename_sizes[ stripe_index ];
+	}
 	if( libfdata_list_clone(
 	     &( ( *destination_segment_table )->segment_files_list ),
 	     source_segment_table->segment_files_list,
@@ -380,6 +432,13 @@ on_error:
 			memory_free(
 			 ( *destination_segment_table )->basename );
 		}
+		for( stripe_index = 0;
+		     stripe_index < ( *destination_segment_table )->number_of_stripe_basenames;
+		     stripe_index++ )
+		{
+			memory_free(
+			 ( *destination_segment_table )->stripe_basenames[ stripe_index ] );
+		}
 		memory_free(
 		 *destination_segment_table );
 
@@ -397,6 +456,7 @@ int libewf_segment_table_empty(
 {
 	static char *function = "libewf_segment_table_empty";
 	int result            = 1;
+	int stripe_index      = 0;
 
 	if( segment_table == NULL )
 	{
@@ -416,6 +476,17 @@ int libewf_segment_table_empty(
 
 		segment_table->basename = NULL;
 	}
+	for( stripe_index = 0;
+	     stripe_index < segment_table->number_of_stripe_basenames;
+	     stripe_index++ )
+	{
+		memory_free(
+		 segment_table->stripe_basenames[ stripe_index ] );
+
+		segment_table->stripe_basenames[ stripe_index ] = NULL;
+	}
+	segment_table->number_of_stripe_basenames = 0;
+
 	if( libfdata_list_empty(
 	     segment_table->segment_files_list,
 	     error ) != 1 )
@@ -442,7 +513,9 @@ int libewf_segment_table_empty(
 
 		result = -1;
 	}
-	segment_table->number_of_segments = 0;
+	segment_table->number_of_segments                  = 0;
+	segment_table->number_of_valid_segment_end_offsets = 0;
+	segment_table->last_segment_index                  = 0;
 
 	return( result );
 }
@@ -726,50 +799,65 @@ int libewf_segment_table_get_basename(
 	return( 1 );
 }
 
-/* Sets the basename
+/* Copies the basename into a system string
  * Returns 1 if successful or -1 on error
  */
-int libewf_segment_table_set_basename(
-     libewf_segment_table_t *segment_table,
+int libewf_segment_table_copy_basename(
      const char *basename,
      size_t basename_length,
+     system_character_t **system_basename,
+     size_t *system_basename_size,
      libcerror_error_t **error )
 {
-	static char *function = "libewf_segment_table_set_basename";
+	static char *function = "libewf_segment_table_copy_basename";
 
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	int result            = 0;
 #endif
 
-	if( segment_table == NULL )
+	if( basename == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid segment table.",
+		 "%s: invalid basename.",
 		 function );
 
 		return( -1 );
 	}
-	if( basename == NULL )
+	if( system_basename == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid basename.",
+		 "%s: invalid system basename.",
 		 function );
 
 		return( -1 );
 	}
-	if( segment_table->basename != NULL )
+	if( *system_basename != NULL )
 	{
-		memory_free(
-		 segment_table->basename );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid system basename value already set.",
+		 function );
 
-		segment_table->basename      = NULL;
-		segment_table->basename_size = 0;
+		return( -1 );
+	}
+	if( system_basename_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid system basename size.",
+		 function );
+
+		return( -1 );
 	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	if( libclocale_codepage == 0 )
@@ -778,13 +866,13 @@ int libewf_segment_table_set_basename(
 		result = libuna_utf32_string_size_from_utf8(
 		          (libuna_utf8_character_t *) basename,
 		          basename_length + 1,
-		          &( segment_table->basename_size ),
+		          system_basename_size,
 		          error );
 #elif SIZEOF_WCHAR_T == 2
 		result = libuna_utf16_string_size_from_utf8(
 		          (libuna_utf8_character_t *) basename,
 		          basename_length + 1,
-		          &( segment_table->basename_size ),
+		          system_basename_size,
 		          error );
 #else
 #error Unsupported size of wchar_t
@@ -797,14 +885,14 @@ int libewf_segment_table_set_basename(
 		          (uint8_t *) basename,
 		          basename_length + 1,
 		          libclocale_codepage,
-		          &( segment_table->basename_size ),
+		          system_basename_size,
 		          error );
 #elif SIZEOF_WCHAR_T == 2
 		result = libuna_utf16_string_size_from_byte_stream(
 		          (uint8_t *) basename,
 		          basename_length + 1,
 		          libclocale_codepage,
-		          &( segment_table->basename_size ),
+		          system_basename_size,
 		          error );
 #else
 #error Unsupported size of wchar_t
@@ -822,12 +910,12 @@ int libewf_segment_table_set_basename(
 		return( -1 );
 	}
 #else
-	segment_table->basename_size = basename_length + 1;
+	*system_basename_size = basename_length + 1;
 #endif
-	segment_table->basename = system_string_allocate(
-	                           segment_table->basename_size );
+	*system_basename = system_string_allocate(
+	                    *system_basename_size );
 
-	if( segment_table->basename == NULL )
+	if( *system_basename == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -836,7 +924,7 @@ int libewf_segment_table_set_basename(
 		 "%s: unable to create basename.",
 		 function );
 
-		segment_table->basename_size = 0;
+		*system_basename_size = 0;
 
 		return( -1 );
 	}
@@ -845,15 +933,15 @@ int libewf_segment_table_set_basename(
 	{
 #if SIZEOF_WCHAR_T == 4
 		result = libuna_utf32_string_copy_from_utf8(
-		          (libuna_utf32_character_t *) segment_table->basename,
-		          segment_table->basename_size,
+		          (libuna_utf32_character_t *) *system_basename,
+		          *system_basename_size,
 		          (libuna_utf8_character_t *) basename,
 		          basename_length + 1,
 		          error );
 #elif SIZEOF_WCHAR_T == 2
 		result = libuna_utf16_string_copy_from_utf8(
-		          (libuna_utf16_character_t *) segment_table->basename,
-		          segment_table->basename_size,
+		          (libuna_utf16_character_t *) *system_basename,
+		          *system_basename_size,
 		          (libuna_utf8_character_t *) basename,
 		          basename_length + 1,
 		          error );
@@ -865,16 +953,16 @@ int libewf_segment_table_set_basename(
 	{
 #if SIZEOF_WCHAR_T == 4
 		result = libuna_utf32_string_copy_from_byte_stream(
-		          (libuna_utf32_character_t *) segment_table->basename,
-		          segment_table->basename_size,
+		          (libuna_utf32_character_t *) *system_basename,
+		          *system_basename_size,
 		          (uint8_t *) basename,
 		          basename_length + 1,
 		          libclocale_codepage,
 		          error );
 #elif SIZEOF_WCHAR_T == 2
 		result = libuna_utf16_string_copy_from_byte_stream(
-		          (libuna_utf16_character_t *) segment_table->basename,
-		          segment_table->basename_size,
+		          (libuna_utf16_character_t *) *system_basename,
+		          *system_basename_size,
 		          (uint8_t *) basename,
 		          basename_length + 1,
 		          libclocale_codepage,
@@ -893,16 +981,16 @@ int libewf_segment_table_set_basename(
 		 function );
 
 		memory_free(
-		 segment_table->basename );
+		 *system_basename );
 
-		segment_table->basename      = NULL;
-		segment_table->basename_size = 0;
+		*system_basename      = NULL;
+		*system_basename_size = 0;
 
 		return( -1 );
 	}
 #else
 	if( system_string_copy(
-	     segment_table->basename,
+	     *system_basename,
 	     basename,
 	     basename_length ) == NULL )
 	{
@@ -913,16 +1001,124 @@ int libewf_segment_table_set_basename(
 		 "%s: unable to set basename.",
 		 function );
 
+		memory_free(
+		 *system_basename );
+
+		*system_basename      = NULL;
+		*system_basename_size = 0;
+
+		return( -1 );
+	}
+	( *system_basename )[ basename_length ] = 0;
+#endif /* defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+	return( 1 );
+}
+
+/* Sets the basename
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_table_set_basename(
+     libewf_segment_table_t *segment_table,
+     const char *basename,
+     size_t basename_length,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_table_set_basename";
+
+	if( segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_table->basename != NULL )
+	{
 		memory_free(
 		 segment_table->basename );
 
 		segment_table->basename      = NULL;
 		segment_table->basename_size = 0;
+	}
+	if( libewf_segment_table_copy_basename(
+	     basename,
+	     basename_length,
+	     &( segment_table->basename ),
+	     &( segment_table->basename_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set basename.",
+		 function );
 
 		return( -1 );
 	}
-	segment_table->basename[ basename_length ] = 0;
-#endif /* defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+	return( 1 );
+}
+
+/* Appends a stripe basename
+ * The segment files are distributed round-robin over the basename and the stripe basenames
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_table_append_stripe_basename(
+     libewf_segment_table_t *segment_table,
+     const char *basename,
+     size_t basename_length,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_table_append_stripe_basename";
+	int stripe_index      = 0;
+
+	if( segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_table->number_of_stripe_basenames >= ( LIBEWF_MAXIMUM_NUMBER_OF_STRIPES - 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid segment table - number of stripe basenames value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	stripe_index = segment_table->number_of_stripe_basenames;
+
+	if( libewf_segment_table_copy_basename(
+	     basename,
+	     basename_length,
+	     &( segment_table->stripe_basenames[ stripe_index ] ),
+	     &( segment_table->stripe_basename_sizes[ stripe_index ] ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set stripe basename: %d.",
+		 function,
+		 stripe_index );
+
+		return( -1 );
+	}
+	segment_table->number_of_stripe_basenames += 1;
 
 	return( 1 );
 }
@@ -1205,53 +1401,68 @@ int libewf_segment_table_get_basename_wide(
 	return( 1 );
 }
 
-/* Sets the basename
+/* Copies the basename into a system string
  * Returns 1 if successful or -1 on error
  */
-int libewf_segment_table_set_basename_wide(
-     libewf_segment_table_t *segment_table,
+int libewf_segment_table_copy_basename_wide(
      const wchar_t *basename,
      size_t basename_length,
+     system_character_t **system_basename,
+     size_t *system_basename_size,
      libcerror_error_t **error )
 {
-	static char *function = "libewf_segment_table_set_basename_wide";
+	static char *function = "libewf_segment_table_copy_basename_wide";
 
 #if !defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	int result            = 0;
 #endif
 
-	if( segment_table == NULL )
+	if( basename == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid segment table.",
+		 "%s: invalid basename.",
 		 function );
 
 		return( -1 );
 	}
-	if( basename == NULL )
+	if( system_basename == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid basename.",
+		 "%s: invalid system basename.",
 		 function );
 
 		return( -1 );
 	}
-	if( segment_table->basename != NULL )
+	if( *system_basename != NULL )
 	{
-		memory_free(
-		 segment_table->basename );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid system basename value already set.",
+		 function );
 
-		segment_table->basename      = NULL;
-		segment_table->basename_size = 0;
+		return( -1 );
+	}
+	if( system_basename_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid system basename size.",
+		 function );
+
+		return( -1 );
 	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	segment_table->basename_size = basename_length + 1;
+	*system_basename_size = basename_length + 1;
 #else
 	if( libclocale_codepage == 0 )
 	{
@@ -1259,13 +1470,13 @@ int libewf_segment_table_set_basename_wide(
 		result = libuna_utf8_string_size_from_utf32(
 		          (libuna_utf32_character_t *) basename,
 		          basename_length + 1,
-		          &( segment_table->basename_size ),
+		          system_basename_size,
 		          error );
 #elif SIZEOF_WCHAR_T == 2
 		result = libuna_utf8_string_size_from_utf16(
 		          (libuna_utf16_character_t *) basename,
 		          basename_length + 1,
-		          &( segment_table->basename_size ),
+		          system_basename_size,
 		          error );
 #else
 #error Unsupported size of wchar_t
@@ -1278,14 +1489,14 @@ int libewf_segment_table_set_basename_wide(
 		          (libuna_utf32_character_t *) basename,
 		          basename_length + 1,
 		          libclocale_codepage,
-		          &( segment_table->basename_size ),
+		          system_basename_size,
 		          error );
 #elif SIZEOF_WCHAR_T == 2
 		result = libuna_byte_stream_size_from_utf16(
 		          (libuna_utf16_character_t *) basename,
 		          basename_length + 1,
 		          libclocale_codepage,
-		          &( segment_table->basename_size ),
+		          system_basename_size,
 		          error );
 #else
 #error Unsupported size of wchar_t
@@ -1303,10 +1514,10 @@ int libewf_segment_table_set_basename_wide(
 		return( -1 );
 	}
 #endif /* defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
-	segment_table->basename = system_string_allocate(
-	                           segment_table->basename_size );
+	*system_basename = system_string_allocate(
+	                    *system_basename_size );
 
-	if( segment_table->basename == NULL )
+	if( *system_basename == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -1319,7 +1530,7 @@ int libewf_segment_table_set_basename_wide(
 	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	if( system_string_copy(
-	     segment_table->basename,
+	     *system_basename,
 	     basename,
 	     basename_length ) == NULL )
 	{
@@ -1331,28 +1542,28 @@ int libewf_segment_table_set_basename_wide(
 		 function );
 
 		memory_free(
-		 segment_table->basename );
+		 *system_basename );
 
-		segment_table->basename      = NULL;
-		segment_table->basename_size = 0;
+		*system_basename      = NULL;
+		*system_basename_size = 0;
 
 		return( -1 );
 	}
-	segment_table->basename[ basename_length ] = 0;
+	( *system_basename )[ basename_length ] = 0;
 #else
 	if( libclocale_codepage == 0 )
 	{
 #if SIZEOF_WCHAR_T == 4
 		result = libuna_utf8_string_copy_from_utf32(
-		          (libuna_utf8_character_t *) segment_table->basename,
-		          segment_table->basename_size,
+		          (libuna_utf8_character_t *) *system_basename,
+		          *system_basename_size,
 		          (libuna_utf32_character_t *) basename,
 		          basename_length + 1,
 		          error );
 #elif SIZEOF_WCHAR_T == 2
 		result = libuna_utf8_string_copy_from_utf16(
-		          (libuna_utf8_character_t *) segment_table->basename,
-		          segment_table->basename_size,
+		          (libuna_utf8_character_t *) *system_basename,
+		          *system_basename_size,
 		          (libuna_utf16_character_t *) basename,
 		          basename_length + 1,
 		          error );
@@ -1364,16 +1575,16 @@ int libewf_segment_table_set_basename_wide(
 	{
 #if SIZEOF_WCHAR_T == 4
 		result = libuna_byte_stream_copy_from_utf32(
-		          (uint8_t *) segment_table->basename,
-		          segment_table->basename_size,
+		          (uint8_t *) *system_basename,
+		          *system_basename_size,
 		          libclocale_codepage,
 		          (libuna_utf32_character_t *) basename,
 		          basename_length + 1,
 		          error );
 #elif SIZEOF_WCHAR_T == 2
 		result = libuna_byte_stream_copy_from_utf16(
-		          (uint8_t *) segment_table->basename,
-		          segment_table->basename_size,
+		          (uint8_t *) *system_basename,
+		          *system_basename_size,
 		          libclocale_codepage,
 		          (libuna_utf16_character_t *) basename,
 		          basename_length + 1,
@@ -1392,10 +1603,10 @@ int libewf_segment_table_set_basename_wide(
 		 function );
 
 		memory_free(
-		 segment_table->basename );
+		 *system_basename );
 
-		segment_table->basename      = NULL;
-		segment_table->basename_size = 0;
+		*system_basename      = NULL;
+		*system_basename_size = 0;
 
 		return( -1 );
 	}
@@ -1403,17 +1614,16 @@ int libewf_segment_table_set_basename_wide(
 	return( 1 );
 }
 
-#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
-
-/* Sets the maximum segment size
+/* Sets the basename
  * Returns 1 if successful or -1 on error
  */
-int libewf_segment_table_set_maximum_segment_size(
+int libewf_segment_table_set_basename_wide(
      libewf_segment_table_t *segment_table,
-     size64_t maximum_segment_size,
+     const wchar_t *basename,
+     size_t basename_length,
      libcerror_error_t **error )
 {
-	static char *function = "libewf_segment_table_set_maximum_segment_size";
+	static char *function = "libewf_segment_table_set_basename_wide";
 
 	if( segment_table == NULL )
 	{
@@ -1426,20 +1636,45 @@ int libewf_segment_table_set_maximum_segment_size(
 
 		return( -1 );
 	}
-	segment_table->maximum_segment_size = maximum_segment_size;
+	if( segment_table->basename != NULL )
+	{
+		memory_free(
+		 segment_table->basename );
+
+		segment_table->basename      = NULL;
+		segment_table->basename_size = 0;
+	}
+	if( libewf_segment_table_copy_basename_wide(
+	     basename,
+	     basename_length,
+	     &( segment_table->basename ),
+	     &( segment_table->basename_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set basename.",
+		 function );
 
+		return( -1 );
+	}
 	return( 1 );
 }
 
-/* Retrieves the number of segments
+/* Appends a stripe basename
+ * The segment files are distributed round-robin over the basename and the stripe basenames
  * Returns 1 if successful or -1 on error
  */
-int libewf_segment_table_get_number_of_segments(
+int libewf_segment_table_append_stripe_basename_wide(
      libewf_segment_table_t *segment_table,
-     uint32_t *number_of_segments,
+     const wchar_t *basename,
+     size_t basename_length,
      libcerror_error_t **error )
 {
-	static char *function = "libewf_segment_table_get_number_of_segments";
+	static char *function = "libewf_segment_table_append_stripe_basename_wide";
+	int stripe_index      = 0;
 
 	if( segment_table == NULL )
 	{
@@ -1452,20 +1687,177 @@ int libewf_segment_table_get_number_of_segments(
 
 		return( -1 );
 	}
-	if( number_of_segments == NULL )
+	if( segment_table->number_of_stripe_basenames >= ( LIBEWF_MAXIMUM_NUMBER_OF_STRIPES - 1 ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid number of segments.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid segment table - number of stripe basenames value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	*number_of_segments = segment_table->number_of_segments;
+	stripe_index = segment_table->number_of_stripe_basenames;
 
-	return( 1 );
+	if( libewf_segment_table_copy_basename_wide(
+	     basename,
+	     basename_length,
+	     &( segment_table->stripe_basenames[ stripe_index ] ),
+	     &( segment_table->stripe_basename_sizes[ stripe_index ] ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set stripe basename: %d.",
+		 function,
+		 stripe_index );
+
+		return( -1 );
+	}
+	segment_table->number_of_stripe_basenames += 1;
+
+	return( 1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Retrieves the basename of a specific segment
+ * The segment number is 0-based
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_table_get_segment_basename(
+     libewf_segment_table_t *segment_table,
+     uint32_t segment_number,
+     system_character_t **basename,
+     size_t *basename_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_table_get_segment_basename";
+	uint32_t stripe_index = 0;
+
+	if( segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid basename.",
+		 function );
+
+		return( -1 );
+	}
+	if( basename_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid basename size.",
+		 function );
+
+		return( -1 );
+	}
+	stripe_index = segment_number % (uint32_t) ( segment_table->number_of_stripe_basenames + 1 );
+
+	if( stripe_index == 0 )
+	{
+		*basename      = segment_table->basename;
+		*basename_size = segment_table->basename_size;
+	}
+	else
+	{
+		*basename      = segment_table->stripe_basenames[ stripe_index - 1 ];
+		*basename_size = segment_table->stripe_basename_sizes[ stripe_index - 1 ];
+	}
+	if( *basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment table - missing basename.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the maximum segment size
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_table_set_maximum_segment_size(
+     libewf_segment_table_t *segment_table,
+     size64_t maximum_segment_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_table_set_maximum_segment_size";
+
+	if( segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment table.",
+		 function );
+
+		return( -1 );
+	}
+	segment_table->maximum_segment_size = maximum_segment_size;
+
+	return( 1 );
+}
+
+/* Retrieves the number of segments
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_table_get_number_of_segments(
+     libewf_segment_table_t *segment_table,
+     uint32_t *number_of_segments,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_table_get_number_of_segments";
+
+	if( segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_segments == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of segments.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_segments = segment_table->number_of_segments;
+
+	return( 1 );
 }
 
 /* Retrieves a specific segment from the segment table
@@ -1528,22 +1920,32 @@ int libewf_segment_table_get_segment_by_index(
 	return( 1 );
 }
 
-/* Retrieves a segment at a specific offset from the segment table
+/* Retrieves the index of the segment at a specific offset from the segment table
+ * The end offsets of the segments are determined on demand and the segment is
+ * looked up using a binary search, where the last segment looked up is tried first
  * Returns 1 if successful, 0 if not or -1 on error
  */
-int libewf_segment_table_get_segment_at_offset(
+int libewf_segment_table_get_segment_index_at_offset(
      libewf_segment_table_t *segment_table,
      off64_t offset,
-     int *file_io_pool_entry,
-     size64_t *segment_file_size,
+     uint32_t *segment_number,
+     off64_t *segment_data_offset,
      libcerror_error_t **error )
 {
-	static char *function            = "libewf_segment_table_get_segment_at_offset";
-	off64_t element_offset           = 0;
-	off64_t segment_file_data_offset = 0;
-	uint32_t element_flags           = 0;
-	int result                       = 0;
-	int segment_number               = 0;
+	off64_t *segment_end_offsets    = NULL;
+	static char *function           = "libewf_segment_table_get_segment_index_at_offset";
+	off64_t element_offset          = 0;
+	off64_t segment_start_offset    = 0;
+	size64_t segment_size           = 0;
+	size_t segment_end_offsets_size = 0;
+	uint32_t element_flags          = 0;
+	uint32_t maximum_segment_index  = 0;
+	uint32_t minimum_segment_index  = 0;
+	uint32_t number_of_segments     = 0;
+	uint32_t segment_index          = 0;
+	int element_file_index          = 0;
+	int number_of_elements          = 0;
+	int result                      = 0;
 
 	if( segment_table == NULL )
 	{
@@ -1556,15 +1958,248 @@ int libewf_segment_table_get_segment_at_offset(
 
 		return( -1 );
 	}
-	result = libfdata_list_get_element_at_offset(
-	          segment_table->segment_files_list,
+	if( segment_number == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment number.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment data offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		return( 0 );
+	}
+	if( libfdata_list_get_number_of_elements(
+	     segment_table->segment_files_list,
+	     &number_of_elements,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of elements from segment files list.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_elements <= 0 )
+	{
+		return( 0 );
+	}
+	number_of_segments = (uint32_t) number_of_elements;
+
+	if( number_of_segments > segment_table->number_of_allocated_segment_end_offsets )
+	{
+#if SIZEOF_SIZE_T <= 4
+		if( (size_t) number_of_segments > ( (size_t) SSIZE_MAX / sizeof( off64_t ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of segments value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		segment_end_offsets_size = sizeof( off64_t ) * number_of_segments;
+
+		segment_end_offsets = (off64_t *) memory_reallocate(
+		                                   segment_table->segment_end_offsets,
+		                                   segment_end_offsets_size );
+
+		if( segment_end_offsets == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize segment end offsets.",
+			 function );
+
+			return( -1 );
+		}
+		segment_table->segment_end_offsets                     = segment_end_offsets;
+		segment_table->number_of_allocated_segment_end_offsets = number_of_segments;
+	}
+	if( segment_table->number_of_valid_segment_end_offsets > number_of_segments )
+	{
+		segment_table->number_of_valid_segment_end_offsets = number_of_segments;
+	}
+	/* Determine the end offsets of the segments that changed since the last look up
+	 * A segment without a storage media size maps the size of the segment file,
+	 * which corresponds to the mapped ranges of the segment files list
+	 */
+	for( segment_index = segment_table->number_of_valid_segment_end_offsets;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+		result = libfdata_list_get_mapped_size_by_index(
+		          segment_table->segment_files_list,
+		          (int) segment_index,
+		          &segment_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to get mapped size of element: %" PRIu32 " in segment files list.",
+			 function,
+			 segment_index );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			if( libfdata_list_get_element_by_index(
+			     segment_table->segment_files_list,
+			     (int) segment_index,
+			     &element_file_index,
+			     &element_offset,
+			     &segment_size,
+			     &element_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve element: %" PRIu32 " from segment files list.",
+				 function,
+				 segment_index );
+
+				return( -1 );
+			}
+		}
+		if( segment_index > 0 )
+		{
+			segment_start_offset = segment_table->segment_end_offsets[ segment_index - 1 ];
+		}
+		if( segment_size > (size64_t) ( INT64_MAX - segment_start_offset ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid segment: %" PRIu32 " size value out of bounds.",
+			 function,
+			 segment_index );
+
+			return( -1 );
+		}
+		segment_table->segment_end_offsets[ segment_index ] = segment_start_offset + (off64_t) segment_size;
+	}
+	segment_table->number_of_valid_segment_end_offsets = number_of_segments;
+
+	if( offset >= segment_table->segment_end_offsets[ number_of_segments - 1 ] )
+	{
+		return( 0 );
+	}
+	/* Sequential reads mostly hit the last segment looked up or the next one
+	 */
+	segment_index = segment_table->last_segment_index;
+
+	if( segment_index < number_of_segments )
+	{
+		if( offset >= segment_table->segment_end_offsets[ segment_index ] )
+		{
+			segment_index++;
+		}
+		if( segment_index < number_of_segments )
+		{
+			segment_start_offset = 0;
+
+			if( segment_index > 0 )
+			{
+				segment_start_offset = segment_table->segment_end_offsets[ segment_index - 1 ];
+			}
+			if( ( offset >= segment_start_offset )
+			 && ( offset < segment_table->segment_end_offsets[ segment_index ] ) )
+			{
+				segment_table->last_segment_index = segment_index;
+
+				*segment_number      = segment_index;
+				*segment_data_offset = offset - segment_start_offset;
+
+				return( 1 );
+			}
+		}
+	}
+	/* Look up the first segment that ends after the offset
+	 */
+	minimum_segment_index = 0;
+	maximum_segment_index = number_of_segments - 1;
+
+	while( minimum_segment_index < maximum_segment_index )
+	{
+		segment_index = minimum_segment_index + ( ( maximum_segment_index - minimum_segment_index ) / 2 );
+
+		if( segment_table->segment_end_offsets[ segment_index ] <= offset )
+		{
+			minimum_segment_index = segment_index + 1;
+		}
+		else
+		{
+			maximum_segment_index = segment_index;
+		}
+	}
+	segment_index        = minimum_segment_index;
+	segment_start_offset = 0;
+
+	if( segment_index > 0 )
+	{
+		segment_start_offset = segment_table->segment_end_offsets[ segment_index - 1 ];
+	}
+	segment_table->last_segment_index = segment_index;
+
+	*segment_number      = segment_index;
+	*segment_data_offset = offset - segment_start_offset;
+
+	return( 1 );
+}
+
+/* Retrieves a segment at a specific offset from the segment table
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int libewf_segment_table_get_segment_at_offset(
+     libewf_segment_table_t *segment_table,
+     off64_t offset,
+     int *file_io_pool_entry,
+     size64_t *segment_file_size,
+     libcerror_error_t **error )
+{
+	static char *function            = "libewf_segment_table_get_segment_at_offset";
+	off64_t element_offset           = 0;
+	off64_t segment_file_data_offset = 0;
+	uint32_t element_flags           = 0;
+	uint32_t segment_number          = 0;
+	int result                       = 0;
+
+	result = libewf_segment_table_get_segment_index_at_offset(
+	          segment_table,
 	          offset,
 	          &segment_number,
 	          &segment_file_data_offset,
-	          file_io_pool_entry,
-	          &element_offset,
-	          segment_file_size,
-	          &element_flags,
 	          error );
 
 	if( result == -1 )
@@ -1573,12 +2208,34 @@ int libewf_segment_table_get_segment_at_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve element at offset: 0x%08" PRIx64 " from segment files list.",
+		 "%s: unable to retrieve segment index at offset: 0x%08" PRIx64 ".",
 		 function,
 		 offset );
 
 		return( -1 );
 	}
+	else if( result != 0 )
+	{
+		if( libfdata_list_get_element_by_index(
+		     segment_table->segment_files_list,
+		     (int) segment_number,
+		     file_io_pool_entry,
+		     &element_offset,
+		     segment_file_size,
+		     &element_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element: %" PRIu32 " from segment files list.",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+	}
 	return( result );
 }
 
@@ -1690,6 +2347,10 @@ int libewf_segment_table_set_segment_storage_media_size_by_index(
 
 		return( -1 );
 	}
+	if( segment_number < segment_table->number_of_valid_segment_end_offsets )
+	{
+		segment_table->number_of_valid_segment_end_offsets = segment_number;
+	}
 	return( 1 );
 }
 
@@ -1763,41 +2424,14 @@ int libewf_segment_table_get_segment_file_at_offset(
      libewf_segment_file_t **segment_file,
      libcerror_error_t **error )
 {
-	static char *function        = "libewf_segment_table_get_segment_file_at_offset";
-	int result                   = 0;
-	int segment_files_list_index = 0;
-
-	if( segment_table == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid segment table.",
-		 function );
-
-		return( -1 );
-	}
-	if( segment_number == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid segment number.",
-		 function );
+	static char *function = "libewf_segment_table_get_segment_file_at_offset";
+	int result            = 0;
 
-		return( -1 );
-	}
-	result = libfdata_list_get_element_value_at_offset(
-	          segment_table->segment_files_list,
-	          (intptr_t *) file_io_pool,
-	          (libfdata_cache_t *) segment_table->segment_files_cache,
+	result = libewf_segment_table_get_segment_index_at_offset(
+	          segment_table,
 	          offset,
-	          &segment_files_list_index,
+	          segment_number,
 	          segment_file_data_offset,
-	          (intptr_t **) segment_file,
-	          0,
 	          error );
 
 	if( result == -1 )
@@ -1806,7 +2440,7 @@ int libewf_segment_table_get_segment_file_at_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve element at offset: 0x%08" PRIx64 " from segment files list.",
+		 "%s: unable to retrieve segment index at offset: 0x%08" PRIx64 ".",
 		 function,
 		 offset );
 
@@ -1814,23 +2448,25 @@ int libewf_segment_table_get_segment_file_at_offset(
 	}
 	else if( result != 0 )
 	{
-#if SIZEOF_INT <= 4
-		if( segment_files_list_index < 0 )
-#else
-		if( ( segment_files_list_index < 0 )
-		 || ( segment_files_list_index > (int) UINT32_MAX ) )
-#endif
+		if( libfdata_list_get_element_value_by_index(
+		     segment_table->segment_files_list,
+		     (intptr_t *) file_io_pool,
+		     (libfdata_cache_t *) segment_table->segment_files_cache,
+		     (int) *segment_number,
+		     (intptr_t **) segment_file,
+		     0,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: invalid segment files list index value out of bounds.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element value: %" PRIu32 " from segment files list.",
+			 function,
+			 *segment_number );
 
 			return( -1 );
 		}
-		*segment_number = (uint32_t) segment_files_list_index;
 	}
 	return( result );
 }
@@ -1978,6 +2614,10 @@ int libewf_segment_table_append_segment_by_segment_file(
 
 		return( -1 );
 	}
+	if( ( segment_file->segment_number - 1 ) < segment_table->number_of_valid_segment_end_offsets )
+	{
+		segment_table->number_of_valid_segment_end_offsets = segment_file->segment_number - 1;
+	}
 	return( 1 );
 }
 
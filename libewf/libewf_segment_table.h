@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_definitions.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
@@ -48,6 +49,20 @@ struct libewf_segment_table
 	 */
 	size_t basename_size;
 
+	/* The basenames of the additional stripes
+	 * the segment files are distributed round-robin over the basename
+	 * and the stripe basenames
+	 */
+	system_character_t *stripe_basenames[ LIBEWF_MAXIMUM_NUMBER_OF_STRIPES - 1 ];
+
+	/* The sizes of the stripe basenames
+	 */
+	size_t stripe_basename_sizes[ LIBEWF_MAXIMUM_NUMBER_OF_STRIPES - 1 ];
+
+	/* The number of stripe basenames
+	 */
+	int number_of_stripe_basenames;
+
 	/* The maximum segment size
 	 */
 	size64_t maximum_segment_size;
@@ -64,6 +79,23 @@ struct libewf_segment_table
 	 */
 	libfcache_cache_t *segment_files_cache;
 
+	/* The (storage media) end offsets of the segments
+	 * used to look up a segment by offset
+	 */
+	off64_t *segment_end_offsets;
+
+	/* The number of allocated segment end offsets
+	 */
+	uint32_t number_of_allocated_segment_end_offsets;
+
+	/* The number of segment end offsets that are up to date
+	 */
+	uint32_t number_of_valid_segment_end_offsets;
+
+	/* The index of the segment that was last looked up by offset
+	 */
+	uint32_t last_segment_index;
+
 	/* Flags
 	 */
 	uint8_t flags;
@@ -99,12 +131,25 @@ int libewf_segment_table_get_basename(
      size_t basename_size,
      libcerror_error_t **error );
 
+int libewf_segment_table_copy_basename(
+     const char *basename,
+     size_t basename_length,
+     system_character_t **system_basename,
+     size_t *system_basename_size,
+     libcerror_error_t **error );
+
 int libewf_segment_table_set_basename(
      libewf_segment_table_t *segment_table,
      const char *basename,
      size_t basename_length,
      libcerror_error_t **error );
 
+int libewf_segment_table_append_stripe_basename(
+     libewf_segment_table_t *segment_table,
+     const char *basename,
+     size_t basename_length,
+     libcerror_error_t **error );
+
 #if defined( HAVE_WIDE_CHARACTER_TYPE )
 
 int libewf_segment_table_get_basename_size_wide(
@@ -118,14 +163,34 @@ int libewf_segment_table_get_basename_wide(
      size_t basename_size,
      libcerror_error_t **error );
 
+int libewf_segment_table_copy_basename_wide(
+     const wchar_t *basename,
+     size_t basename_length,
+     system_character_t **system_basename,
+     size_t *system_basename_size,
+     libcerror_error_t **error );
+
 int libewf_segment_table_set_basename_wide(
      libewf_segment_table_t *segment_table,
      const wchar_t *basename,
      size_t basename_length,
      libcerror_error_t **error );
 
+int libewf_segment_table_append_stripe_basename_wide(
+     libewf_segment_table_t *segment_table,
+     const wchar_t *basename,
+     size_t basename_length,
+     libcerror_error_t **error );
+
 #endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
 
+int libewf_segment_table_get_segment_basename(
+     libewf_segment_table_t *segment_table,
+     uint32_t segment_number,
+     system_character_t **basename,
+     size_t *basename_size,
+     libcerror_error_t **error );
+
 int libewf_segment_table_set_maximum_segment_size(
      libewf_segment_table_t *segment_table,
      size64_t maximum_segment_size,
@@ -143,6 +208,13 @@ int libewf_segment_table_get_segment_by_index(
      size64_t *segment_file_size,
      libcerror_error_t **error );
 
+int libewf_segment_table_get_segment_index_at_offset(
+     libewf_segment_table_t *segment_table,
+     off64_t offset,
+     uint32_t *segment_number,
+     off64_t *segment_data_offset,
+     libcerror_error_t **error );
+
 int libewf_segment_table_get_segment_at_offset(
      libewf_segment_table_t *segment_table,
      off64_t offset,
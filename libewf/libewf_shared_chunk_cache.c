@@ -0,0 +1,1477 @@
+/*
+ * Shared chunk cache functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_SYS_FILE_H )
+#include <sys/file.h>
+#endif
+
+#if defined( HAVE_SYS_MMAN_H )
+#include <sys/mman.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "libewf_checksum.h"
+#include "libewf_libcerror.h"
+#include "libewf_shared_chunk_cache.h"
+#include "libewf_unused.h"
+
+const uint8_t libewf_shared_chunk_cache_signature[ 8 ] = {
+	'e', 'w', 'f', 's', 'h', 'c', 'c', 'h' };
+
+/* Creates a shared chunk cache
+ * Make sure the value shared_chunk_cache is referencing, is set to NULL
+ * The maximum cache size is only used when the shared memory is created
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_shared_chunk_cache_initialize(
+     libewf_shared_chunk_cache_t **shared_chunk_cache,
+     size32_t chunk_size,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_shared_chunk_cache_initialize";
+
+	if( shared_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *shared_chunk_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid shared chunk cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_size == 0 )
+	 || ( chunk_size > (size32_t) INT32_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* The shared memory must be able to contain at least a single hash bucket
+	 */
+	if( maximum_cache_size < ( LIBEWF_SHARED_CHUNK_CACHE_HEADER_SIZE + ( LIBEWF_SHARED_CHUNK_CACHE_NUMBER_OF_WAYS * ( (size64_t) chunk_size + LIBEWF_SHARED_CHUNK_CACHE_ENTRY_SIZE ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid maximum cache size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_cache_size > (size64_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid maximum cache size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	*shared_chunk_cache = memory_allocate_structure(
+	                       libewf_shared_chunk_cache_t );
+
+	if( *shared_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create shared chunk cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *shared_chunk_cache,
+	     0,
+	     sizeof( libewf_shared_chunk_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear shared chunk cache.",
+		 function );
+
+		goto on_error;
+	}
+	( *shared_chunk_cache )->chunk_size         = chunk_size;
+	( *shared_chunk_cache )->maximum_cache_size = maximum_cache_size;
+	( *shared_chunk_cache )->file_descriptor    = -1;
+
+	return( 1 );
+
+on_error:
+	if( *shared_chunk_cache != NULL )
+	{
+		memory_free(
+		 *shared_chunk_cache );
+
+		*shared_chunk_cache = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a shared chunk cache
+ * The shared memory is detached from if it is open
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_shared_chunk_cache_free(
+     libewf_shared_chunk_cache_t **shared_chunk_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_shared_chunk_cache_free";
+	int result            = 1;
+
+	if( shared_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *shared_chunk_cache != NULL )
+	{
+		if( ( *shared_chunk_cache )->mapped_data != NULL )
+		{
+			if( libewf_shared_chunk_cache_close(
+			     *shared_chunk_cache,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close shared chunk cache.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *shared_chunk_cache )->segment_numbers != NULL )
+		{
+			memory_free(
+			 ( *shared_chunk_cache )->segment_numbers );
+		}
+		memory_free(
+		 *shared_chunk_cache );
+
+		*shared_chunk_cache = NULL;
+	}
+	return( result );
+}
+
+/* Sets the segment number of a specific file IO pool entry
+ * The chunks in the shared memory are identified by segment number since
+ * the file IO pool entries differ between processes
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_shared_chunk_cache_set_segment_number(
+     libewf_shared_chunk_cache_t *shared_chunk_cache,
+     int file_io_pool_entry,
+     uint32_t segment_number,
+     libcerror_error_t **error )
+{
+	uint32_t *segment_numbers = NULL;
+	static char *function     = "libewf_shared_chunk_cache_set_segment_number";
+	size_t array_size         = 0;
+
+	if( shared_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_io_pool_entry < 0 )
+	 || ( (size_t) file_io_pool_entry >= ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( uint32_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file IO pool entry value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool_entry >= shared_chunk_cache->number_of_file_io_pool_entries )
+	{
+		array_size = sizeof( uint32_t ) * (size_t) ( file_io_pool_entry + 1 );
+
+		segment_numbers = (uint32_t *) memory_reallocate(
+		                                shared_chunk_cache->segment_numbers,
+		                                array_size );
+
+		if( segment_numbers == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize segment numbers.",
+			 function );
+
+			return( -1 );
+		}
+		shared_chunk_cache->segment_numbers = segment_numbers;
+
+		if( memory_set(
+		     &( segment_numbers[ shared_chunk_cache->number_of_file_io_pool_entries ] ),
+		     0,
+		     sizeof( uint32_t ) * (size_t) ( file_io_pool_entry + 1 - shared_chunk_cache->number_of_file_io_pool_entries ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear segment numbers.",
+			 function );
+
+			return( -1 );
+		}
+		shared_chunk_cache->number_of_file_io_pool_entries = file_io_pool_entry + 1;
+	}
+	shared_chunk_cache->segment_numbers[ file_io_pool_entry ] = segment_number;
+
+	return( 1 );
+}
+
+/* Opens (attaches to) the shared memory
+ * The shared memory is created, with the size of the maximum cache size, if it does not exist.
+ * If it exists it is used with the size and slot size it was created with
+ * The name must start with a '/' and not contain any other '/'
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_shared_chunk_cache_open(
+     libewf_shared_chunk_cache_t *shared_chunk_cache,
+     const char *name,
+     size_t name_length,
+     const uint8_t *set_identifier,
+     size_t set_identifier_size,
+     libcerror_error_t **error )
+{
+	static char *function                      = "libewf_shared_chunk_cache_open";
+	size_t name_index                          = 0;
+
+#if defined( HAVE_LIBEWF_SHARED_CHUNK_CACHE_SUPPORT )
+	libewf_shared_chunk_cache_header_t *header = NULL;
+	struct stat file_statistics;
+
+	void *mapped_data                          = MAP_FAILED;
+	size64_t bucket_size                       = 0;
+	size64_t mapped_data_size                  = 0;
+	uint64_t number_of_buckets                 = 0;
+	uint8_t is_initialized                     = 0;
+	int is_locked                              = 0;
+#endif
+
+	if( shared_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( shared_chunk_cache->mapped_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid shared chunk cache - mapped data already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( name_length < 2 )
+	 || ( name_length >= LIBEWF_SHARED_CHUNK_CACHE_MAXIMUM_NAME_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid name length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( name[ 0 ] != '/' )
+	 || ( name[ name_length ] != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported name.",
+		 function );
+
+		return( -1 );
+	}
+	for( name_index = 1;
+	     name_index < name_length;
+	     name_index++ )
+	{
+		if( ( name[ name_index ] == '/' )
+		 || ( name[ name_index ] == 0 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported name.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( set_identifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid set identifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( set_identifier_size != 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid set identifier size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_SHARED_CHUNK_CACHE_SUPPORT )
+	if( memory_copy(
+	     shared_chunk_cache->set_identifier,
+	     set_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy set identifier.",
+		 function );
+
+		return( -1 );
+	}
+	/* The shared memory is only accessible by processes of the same user
+	 * since other processes could alter the chunk data
+	 */
+	shared_chunk_cache->file_descriptor = shm_open(
+	                                       name,
+	                                       O_CREAT | O_RDWR,
+	                                       0600 );
+
+	if( shared_chunk_cache->file_descriptor == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to open shared memory: %s.",
+		 function,
+		 name );
+
+		goto on_error;
+	}
+	/* The lock is held while the shared memory is created so that a process
+	 * that attaches to it concurrently does not see it partially initialized
+	 */
+	if( libewf_shared_chunk_cache_lock(
+	     shared_chunk_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to lock shared memory.",
+		 function );
+
+		goto on_error;
+	}
+	is_locked = 1;
+
+	if( fstat(
+	     shared_chunk_cache->file_descriptor,
+	     &file_statistics ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 errno,
+		 "%s: unable to retrieve shared memory statistics.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( file_statistics.st_size < 0 )
+	 || ( (uint64_t) file_statistics.st_size > (uint64_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid shared memory size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	mapped_data_size = (size64_t) file_statistics.st_size;
+
+	if( mapped_data_size >= LIBEWF_SHARED_CHUNK_CACHE_HEADER_SIZE )
+	{
+		mapped_data = mmap(
+		               NULL,
+		               (size_t) mapped_data_size,
+		               PROT_READ | PROT_WRITE,
+		               MAP_SHARED,
+		               shared_chunk_cache->file_descriptor,
+		               0 );
+
+		if( mapped_data == MAP_FAILED )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 errno,
+			 "%s: unable to map shared memory: %s.",
+			 function,
+			 name );
+
+			goto on_error;
+		}
+		header = (libewf_shared_chunk_cache_header_t *) mapped_data;
+
+		if( memory_compare(
+		     header->signature,
+		     libewf_shared_chunk_cache_signature,
+		     8 ) == 0 )
+		{
+			if( ( header->format_version != LIBEWF_SHARED_CHUNK_CACHE_FORMAT_VERSION )
+			 || ( header->number_of_ways != LIBEWF_SHARED_CHUNK_CACHE_NUMBER_OF_WAYS )
+			 || ( header->mapped_size != mapped_data_size )
+			 || ( header->slot_size == 0 )
+			 || ( header->slot_size > (uint32_t) INT32_MAX )
+			 || ( header->number_of_buckets == 0 ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+				 "%s: unsupported shared memory: %s.",
+				 function,
+				 name );
+
+				goto on_error;
+			}
+			bucket_size = LIBEWF_SHARED_CHUNK_CACHE_NUMBER_OF_WAYS
+			            * ( (size64_t) header->slot_size + LIBEWF_SHARED_CHUNK_CACHE_ENTRY_SIZE );
+
+			if( ( ( mapped_data_size - LIBEWF_SHARED_CHUNK_CACHE_HEADER_SIZE ) / bucket_size ) != (size64_t) header->number_of_buckets )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid shared memory: %s - number of buckets value out of bounds.",
+				 function,
+				 name );
+
+				goto on_error;
+			}
+			is_initialized = 1;
+		}
+		/* Shared memory without a signature was left behind by a process
+		 * that terminated while creating it and is created again
+		 */
+		else if( munmap(
+		          mapped_data,
+		          (size_t) mapped_data_size ) != 0 )
+		{
+			mapped_data = MAP_FAILED;
+
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 errno,
+			 "%s: unable to unmap shared memory: %s.",
+			 function,
+			 name );
+
+			goto on_error;
+		}
+		else
+		{
+			mapped_data = MAP_FAILED;
+		}
+	}
+	if( is_initialized == 0 )
+	{
+		bucket_size = LIBEWF_SHARED_CHUNK_CACHE_NUMBER_OF_WAYS
+		            * ( (size64_t) shared_chunk_cache->chunk_size + LIBEWF_SHARED_CHUNK_CACHE_ENTRY_SIZE );
+
+		number_of_buckets = ( shared_chunk_cache->maximum_cache_size - LIBEWF_SHARED_CHUNK_CACHE_HEADER_SIZE )
+		                  / bucket_size;
+
+		if( number_of_buckets > (uint64_t) UINT32_MAX )
+		{
+			number_of_buckets = (uint64_t) UINT32_MAX;
+		}
+		mapped_data_size = LIBEWF_SHARED_CHUNK_CACHE_HEADER_SIZE
+		                 + ( number_of_buckets * bucket_size );
+
+		/* Truncating to 0 first makes sure the shared memory is zero filled
+		 * hence all entries are unused
+		 */
+		if( ( ftruncate(
+		       shared_chunk_cache->file_descriptor,
+		       0 ) != 0 )
+		 || ( ftruncate(
+		       shared_chunk_cache->file_descriptor,
+		       (off_t) mapped_data_size ) != 0 ) )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 errno,
+			 "%s: unable to resize shared memory: %s.",
+			 function,
+			 name );
+
+			goto on_error;
+		}
+		mapped_data = mmap(
+		               NULL,
+		               (size_t) mapped_data_size,
+		               PROT_READ | PROT_WRITE,
+		               MAP_SHARED,
+		               shared_chunk_cache->file_descriptor,
+		               0 );
+
+		if( mapped_data == MAP_FAILED )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 errno,
+			 "%s: unable to map shared memory: %s.",
+			 function,
+			 name );
+
+			goto on_error;
+		}
+		header = (libewf_shared_chunk_cache_header_t *) mapped_data;
+
+		header->format_version    = LIBEWF_SHARED_CHUNK_CACHE_FORMAT_VERSION;
+		header->slot_size         = (uint32_t) shared_chunk_cache->chunk_size;
+		header->number_of_buckets = (uint32_t) number_of_buckets;
+		header->number_of_ways    = LIBEWF_SHARED_CHUNK_CACHE_NUMBER_OF_WAYS;
+		header->access_counter    = 0;
+		header->mapped_size       = mapped_data_size;
+
+		/* The signature is set last to mark the shared memory as initialized
+		 */
+		if( memory_copy(
+		     header->signature,
+		     libewf_shared_chunk_cache_signature,
+		     8 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy signature.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	is_locked = 0;
+
+	if( libewf_shared_chunk_cache_unlock(
+	     shared_chunk_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to unlock shared memory.",
+		 function );
+
+		goto on_error;
+	}
+	shared_chunk_cache->mapped_data       = (uint8_t *) mapped_data;
+	shared_chunk_cache->mapped_data_size  = mapped_data_size;
+	shared_chunk_cache->header            = header;
+	shared_chunk_cache->entries           = (libewf_shared_chunk_cache_entry_t *) &( shared_chunk_cache->mapped_data[ LIBEWF_SHARED_CHUNK_CACHE_HEADER_SIZE ] );
+	shared_chunk_cache->slot_size         = header->slot_size;
+	shared_chunk_cache->number_of_buckets = header->number_of_buckets;
+	shared_chunk_cache->slots             = &( shared_chunk_cache->mapped_data[ LIBEWF_SHARED_CHUNK_CACHE_HEADER_SIZE + ( (size_t) header->number_of_buckets * LIBEWF_SHARED_CHUNK_CACHE_NUMBER_OF_WAYS * LIBEWF_SHARED_CHUNK_CACHE_ENTRY_SIZE ) ] );
+	shared_chunk_cache->number_of_hits    = 0;
+	shared_chunk_cache->number_of_misses  = 0;
+
+	return( 1 );
+
+on_error:
+	if( is_locked != 0 )
+	{
+		libewf_shared_chunk_cache_unlock(
+		 shared_chunk_cache,
+		 NULL );
+	}
+	if( mapped_data != MAP_FAILED )
+	{
+		munmap(
+		 mapped_data,
+		 (size_t) mapped_data_size );
+	}
+	if( shared_chunk_cache->file_descriptor != -1 )
+	{
+		close(
+		 shared_chunk_cache->file_descriptor );
+
+		shared_chunk_cache->file_descriptor = -1;
+	}
+	return( -1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: shared memory not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( HAVE_LIBEWF_SHARED_CHUNK_CACHE_SUPPORT ) */
+}
+
+/* Closes (detaches from) the shared memory
+ * The shared memory is retained for other processes
+ * Returns 0 if successful or -1 on error
+ */
+int libewf_shared_chunk_cache_close(
+     libewf_shared_chunk_cache_t *shared_chunk_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_shared_chunk_cache_close";
+	int result            = 0;
+
+	if( shared_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( shared_chunk_cache->mapped_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid shared chunk cache - missing mapped data.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_SHARED_CHUNK_CACHE_SUPPORT )
+	if( munmap(
+	     shared_chunk_cache->mapped_data,
+	     (size_t) shared_chunk_cache->mapped_data_size ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 errno,
+		 "%s: unable to unmap shared memory.",
+		 function );
+
+		result = -1;
+	}
+	if( close(
+	     shared_chunk_cache->file_descriptor ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 errno,
+		 "%s: unable to close shared memory.",
+		 function );
+
+		result = -1;
+	}
+#endif /* defined( HAVE_LIBEWF_SHARED_CHUNK_CACHE_SUPPORT ) */
+
+	shared_chunk_cache->file_descriptor   = -1;
+	shared_chunk_cache->mapped_data       = NULL;
+	shared_chunk_cache->mapped_data_size  = 0;
+	shared_chunk_cache->header            = NULL;
+	shared_chunk_cache->entries           = NULL;
+	shared_chunk_cache->slots             = NULL;
+	shared_chunk_cache->slot_size         = 0;
+	shared_chunk_cache->number_of_buckets = 0;
+
+	return( result );
+}
+
+/* Locks the shared memory for exclusive access by this process
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_shared_chunk_cache_lock(
+     libewf_shared_chunk_cache_t *shared_chunk_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_shared_chunk_cache_lock";
+
+	if( shared_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( shared_chunk_cache->file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid shared chunk cache - missing file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_SHARED_CHUNK_CACHE_SUPPORT )
+	while( flock(
+	        shared_chunk_cache->file_descriptor,
+	        LOCK_EX ) != 0 )
+	{
+		if( errno != EINTR )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 errno,
+			 "%s: unable to lock shared memory.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	return( 1 );
+}
+
+/* Unlocks the shared memory
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_shared_chunk_cache_unlock(
+     libewf_shared_chunk_cache_t *shared_chunk_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_shared_chunk_cache_unlock";
+
+	if( shared_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( shared_chunk_cache->file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid shared chunk cache - missing file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_SHARED_CHUNK_CACHE_SUPPORT )
+	if( flock(
+	     shared_chunk_cache->file_descriptor,
+	     LOCK_UN ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 errno,
+		 "%s: unable to unlock shared memory.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the index of the hash bucket of a specific chunk
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_shared_chunk_cache_get_bucket_index(
+     libewf_shared_chunk_cache_t *shared_chunk_cache,
+     uint32_t segment_number,
+     off64_t chunk_offset,
+     uint32_t *bucket_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_shared_chunk_cache_get_bucket_index";
+	uint64_t hash_value   = 0;
+	uint64_t key_value    = 0;
+	uint8_t byte_index    = 0;
+
+	if( shared_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( shared_chunk_cache->number_of_buckets == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid shared chunk cache - missing buckets.",
+		 function );
+
+		return( -1 );
+	}
+	if( bucket_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bucket index.",
+		 function );
+
+		return( -1 );
+	}
+	/* FNV-1a hashing of the set identifier, since the same shared memory
+	 * can contain the chunks of multiple segment file sets
+	 */
+	hash_value = 0xcbf29ce484222325ULL;
+
+	for( byte_index = 0;
+	     byte_index < 16;
+	     byte_index++ )
+	{
+		hash_value ^= shared_chunk_cache->set_identifier[ byte_index ];
+		hash_value *= 0x00000100000001b3ULL;
+	}
+	/* Fibonacci hashing of the chunk offset combined with the segment number
+	 */
+	key_value = ( (uint64_t) chunk_offset ^ ( (uint64_t) segment_number << 48 ) )
+	          * 0x9e3779b97f4a7c15ULL;
+
+	hash_value ^= key_value >> 32;
+
+	*bucket_index = (uint32_t) ( hash_value % (uint64_t) shared_chunk_cache->number_of_buckets );
+
+	return( 1 );
+}
+
+/* Reads the unpacked data of a specific chunk from the shared memory
+ * The chunk is identified by the file IO pool entry and offset of the (packed) chunk
+ * An entry of which the data does not match its checksum is discarded
+ * Returns 1 if successful, 0 if the chunk is not in the cache or -1 on error
+ */
+int libewf_shared_chunk_cache_read_chunk_data(
+     libewf_shared_chunk_cache_t *shared_chunk_cache,
+     int file_io_pool_entry,
+     off64_t chunk_offset,
+     uint8_t *data,
+     size_t data_size,
+     size_t *chunk_data_size,
+     libcerror_error_t **error )
+{
+	libewf_shared_chunk_cache_entry_t *entry = NULL;
+	static char *function                    = "libewf_shared_chunk_cache_read_chunk_data";
+	size_t entry_index                       = 0;
+	uint32_t bucket_index                    = 0;
+	uint32_t calculated_checksum             = 0;
+	uint32_t segment_number                  = 0;
+	uint32_t way_index                       = 0;
+	int is_locked                            = 0;
+	int result                               = 0;
+
+	if( shared_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( shared_chunk_cache->mapped_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid shared chunk cache - missing mapped data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_io_pool_entry >= 0 )
+	 && ( file_io_pool_entry < shared_chunk_cache->number_of_file_io_pool_entries ) )
+	{
+		segment_number = shared_chunk_cache->segment_numbers[ file_io_pool_entry ];
+	}
+	if( segment_number == 0 )
+	{
+		shared_chunk_cache->number_of_misses += 1;
+
+		return( 0 );
+	}
+	if( libewf_shared_chunk_cache_get_bucket_index(
+	     shared_chunk_cache,
+	     segment_number,
+	     chunk_offset,
+	     &bucket_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve bucket index.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_shared_chunk_cache_lock(
+	     shared_chunk_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to lock shared memory.",
+		 function );
+
+		goto on_error;
+	}
+	is_locked = 1;
+
+	for( way_index = 0;
+	     way_index < LIBEWF_SHARED_CHUNK_CACHE_NUMBER_OF_WAYS;
+	     way_index++ )
+	{
+		entry_index = ( (size_t) bucket_index * LIBEWF_SHARED_CHUNK_CACHE_NUMBER_OF_WAYS ) + way_index;
+		entry       = &( shared_chunk_cache->entries[ entry_index ] );
+
+		if( ( entry->segment_number == segment_number )
+		 && ( entry->chunk_offset == (uint64_t) chunk_offset )
+		 && ( memory_compare(
+		       entry->set_identifier,
+		       shared_chunk_cache->set_identifier,
+		       16 ) == 0 ) )
+		{
+			result = 1;
+
+			break;
+		}
+	}
+	if( result != 0 )
+	{
+		if( (size_t) entry->data_size > data_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+			 "%s: invalid data size value too small.",
+			 function );
+
+			goto on_error;
+		}
+		if( entry->data_size <= shared_chunk_cache->slot_size )
+		{
+			if( memory_copy(
+			     data,
+			     &( shared_chunk_cache->slots[ entry_index * shared_chunk_cache->slot_size ] ),
+			     (size_t) entry->data_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy chunk data.",
+				 function );
+
+				goto on_error;
+			}
+			if( libewf_checksum_calculate_adler32(
+			     &calculated_checksum,
+			     data,
+			     (size_t) entry->data_size,
+			     1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to calculate checksum.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		/* An entry of which the data does not match is discarded
+		 */
+		if( ( entry->data_size > shared_chunk_cache->slot_size )
+		 || ( calculated_checksum != entry->checksum ) )
+		{
+			entry->segment_number = 0;
+			entry->last_access    = 0;
+
+			result = 0;
+		}
+		else
+		{
+			shared_chunk_cache->header->access_counter += 1;
+
+			entry->last_access = shared_chunk_cache->header->access_counter;
+
+			*chunk_data_size = (size_t) entry->data_size;
+		}
+	}
+	is_locked = 0;
+
+	if( libewf_shared_chunk_cache_unlock(
+	     shared_chunk_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to unlock shared memory.",
+		 function );
+
+		goto on_error;
+	}
+	if( result != 0 )
+	{
+		shared_chunk_cache->number_of_hits += 1;
+	}
+	else
+	{
+		shared_chunk_cache->number_of_misses += 1;
+	}
+	return( result );
+
+on_error:
+	if( is_locked != 0 )
+	{
+		libewf_shared_chunk_cache_unlock(
+		 shared_chunk_cache,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes the unpacked data of a specific chunk to the shared memory
+ * The chunk is identified by the file IO pool entry and offset of the (packed) chunk
+ * The least recently used entry of the hash bucket is evicted to store the chunk data
+ * Returns 1 if successful, 0 if the chunk data cannot be stored in the cache or -1 on error
+ */
+int libewf_shared_chunk_cache_write_chunk_data(
+     libewf_shared_chunk_cache_t *shared_chunk_cache,
+     int file_io_pool_entry,
+     off64_t chunk_offset,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libewf_shared_chunk_cache_entry_t *entry = NULL;
+	static char *function                    = "libewf_shared_chunk_cache_write_chunk_data";
+	size_t entry_index                       = 0;
+	size_t evicted_entry_index               = 0;
+	uint64_t evicted_last_access             = 0;
+	uint32_t bucket_index                    = 0;
+	uint32_t checksum                        = 0;
+	uint32_t segment_number                  = 0;
+	uint32_t way_index                       = 0;
+	int is_locked                            = 0;
+	int result                               = 0;
+
+	if( shared_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( shared_chunk_cache->mapped_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid shared chunk cache - missing mapped data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid chunk offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_io_pool_entry >= 0 )
+	 && ( file_io_pool_entry < shared_chunk_cache->number_of_file_io_pool_entries ) )
+	{
+		segment_number = shared_chunk_cache->segment_numbers[ file_io_pool_entry ];
+	}
+	/* The slot size is determined by the process that created the shared memory
+	 */
+	if( ( segment_number == 0 )
+	 || ( data_size == 0 )
+	 || ( data_size > (size_t) shared_chunk_cache->slot_size ) )
+	{
+		return( 0 );
+	}
+	if( libewf_checksum_calculate_adler32(
+	     &checksum,
+	     data,
+	     data_size,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate checksum.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_shared_chunk_cache_get_bucket_index(
+	     shared_chunk_cache,
+	     segment_number,
+	     chunk_offset,
+	     &bucket_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve bucket index.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_shared_chunk_cache_lock(
+	     shared_chunk_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to lock shared memory.",
+		 function );
+
+		goto on_error;
+	}
+	is_locked = 1;
+
+	/* An unused entry is used first, otherwise the least recently used entry is evicted
+	 */
+	evicted_entry_index = (size_t) bucket_index * LIBEWF_SHARED_CHUNK_CACHE_NUMBER_OF_WAYS;
+	evicted_last_access = UINT64_MAX;
+
+	for( way_index = 0;
+	     way_index < LIBEWF_SHARED_CHUNK_CACHE_NUMBER_OF_WAYS;
+	     way_index++ )
+	{
+		entry_index = ( (size_t) bucket_index * LIBEWF_SHARED_CHUNK_CACHE_NUMBER_OF_WAYS ) + way_index;
+		entry       = &( shared_chunk_cache->entries[ entry_index ] );
+
+		/* The chunk data was stored by another process
+		 */
+		if( ( entry->segment_number == segment_number )
+		 && ( entry->chunk_offset == (uint64_t) chunk_offset )
+		 && ( memory_compare(
+		       entry->set_identifier,
+		       shared_chunk_cache->set_identifier,
+		       16 ) == 0 ) )
+		{
+			result = 1;
+
+			break;
+		}
+		if( entry->segment_number == 0 )
+		{
+			if( evicted_last_access != 0 )
+			{
+				evicted_entry_index = entry_index;
+				evicted_last_access = 0;
+			}
+		}
+		else if( entry->last_access < evicted_last_access )
+		{
+			evicted_entry_index = entry_index;
+			evicted_last_access = entry->last_access;
+		}
+	}
+	if( result == 0 )
+	{
+		entry = &( shared_chunk_cache->entries[ evicted_entry_index ] );
+
+		/* The entry is marked as unused while the chunk data is stored
+		 * so that the entry is not used if the process terminates meanwhile
+		 */
+		entry->segment_number = 0;
+
+		if( memory_copy(
+		     &( shared_chunk_cache->slots[ evicted_entry_index * shared_chunk_cache->slot_size ] ),
+		     data,
+		     data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy chunk data.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     entry->set_identifier,
+		     shared_chunk_cache->set_identifier,
+		     16 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy set identifier.",
+			 function );
+
+			goto on_error;
+		}
+		shared_chunk_cache->header->access_counter += 1;
+
+		entry->chunk_offset   = (uint64_t) chunk_offset;
+		entry->data_size      = (uint32_t) data_size;
+		entry->checksum       = checksum;
+		entry->last_access    = shared_chunk_cache->header->access_counter;
+		entry->segment_number = segment_number;
+
+		result = 1;
+	}
+	is_locked = 0;
+
+	if( libewf_shared_chunk_cache_unlock(
+	     shared_chunk_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to unlock shared memory.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( is_locked != 0 )
+	{
+		libewf_shared_chunk_cache_unlock(
+		 shared_chunk_cache,
+		 NULL );
+	}
+	return( -1 );
+}
+
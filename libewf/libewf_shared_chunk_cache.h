@@ -0,0 +1,278 @@
+/*
+ * Shared chunk cache functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_SHARED_CHUNK_CACHE_H )
+#define _LIBEWF_SHARED_CHUNK_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_SYS_FILE_H ) && defined( HAVE_SYS_MMAN_H ) && defined( HAVE_FLOCK ) && defined( HAVE_FTRUNCATE ) && defined( HAVE_MMAP ) && defined( HAVE_MUNMAP ) && defined( HAVE_SHM_OPEN ) && !defined( WINAPI )
+#define HAVE_LIBEWF_SHARED_CHUNK_CACHE_SUPPORT
+#endif
+
+/* The size of the shared chunk cache header
+ */
+#define LIBEWF_SHARED_CHUNK_CACHE_HEADER_SIZE		64
+
+/* The size of a shared chunk cache entry
+ */
+#define LIBEWF_SHARED_CHUNK_CACHE_ENTRY_SIZE		64
+
+/* The shared chunk cache format version
+ */
+#define LIBEWF_SHARED_CHUNK_CACHE_FORMAT_VERSION	1
+
+/* The number of entries per hash bucket
+ */
+#define LIBEWF_SHARED_CHUNK_CACHE_NUMBER_OF_WAYS	8
+
+/* The maximum size of the name of the shared memory object
+ */
+#define LIBEWF_SHARED_CHUNK_CACHE_MAXIMUM_NAME_SIZE	255
+
+typedef struct libewf_shared_chunk_cache_header libewf_shared_chunk_cache_header_t;
+
+/* The header at the start of the shared memory
+ */
+struct libewf_shared_chunk_cache_header
+{
+	/* The signature
+	 */
+	uint8_t signature[ 8 ];
+
+	/* The format version
+	 */
+	uint32_t format_version;
+
+	/* The size of a slot of chunk data
+	 */
+	uint32_t slot_size;
+
+	/* The number of hash buckets
+	 */
+	uint32_t number_of_buckets;
+
+	/* The number of entries per hash bucket
+	 */
+	uint32_t number_of_ways;
+
+	/* The access counter
+	 */
+	uint64_t access_counter;
+
+	/* The size of the shared memory
+	 */
+	uint64_t mapped_size;
+
+	/* Padding
+	 */
+	uint8_t padding[ 24 ];
+};
+
+typedef struct libewf_shared_chunk_cache_entry libewf_shared_chunk_cache_entry_t;
+
+/* An entry in the shared memory
+ */
+struct libewf_shared_chunk_cache_entry
+{
+	/* The segment file set identifier of the chunk
+	 */
+	uint8_t set_identifier[ 16 ];
+
+	/* The offset of the (packed) chunk in the segment file
+	 */
+	uint64_t chunk_offset;
+
+	/* The value of the access counter of the last access
+	 */
+	uint64_t last_access;
+
+	/* The segment number of the chunk, where 0 represents unused
+	 */
+	uint32_t segment_number;
+
+	/* The size of the unpacked chunk data
+	 */
+	uint32_t data_size;
+
+	/* The Adler-32 checksum of the unpacked chunk data
+	 */
+	uint32_t checksum;
+
+	/* Padding
+	 */
+	uint8_t padding[ 20 ];
+};
+
+typedef struct libewf_shared_chunk_cache libewf_shared_chunk_cache_t;
+
+/* The shared chunk cache is a second level cache of unpacked chunk data in a named
+ * shared memory object, that multiple processes on the same host that read the same
+ * segment file set attach to, so that a chunk is only read and unpacked once per host.
+ * The chunk data is identified by the segment file set identifier, the segment number
+ * and the offset of the chunk in the segment file.
+ *
+ * The size of the shared memory, the host-wide memory budget, is determined by the
+ * process that creates it. The shared memory consists of a header, a table of entries
+ * and a slot of chunk data per entry. The entries are grouped in hash buckets of
+ * a fixed number of entries, of which the least recently used entry is evicted first.
+ *
+ * Access is serialized between processes by an advisory lock on the shared memory object
+ * which is released by the system when a process terminates. An entry is only marked as
+ * used after its chunk data was stored and the chunk data is validated against its checksum
+ * when read, hence the chunk data of a process that terminated while storing it is discarded
+ */
+struct libewf_shared_chunk_cache
+{
+	/* The chunk size
+	 */
+	size32_t chunk_size;
+
+	/* The maximum cache size
+	 */
+	size64_t maximum_cache_size;
+
+	/* The segment numbers of the file IO pool entries
+	 */
+	uint32_t *segment_numbers;
+
+	/* The number of file IO pool entries
+	 */
+	int number_of_file_io_pool_entries;
+
+	/* The segment file set identifier
+	 */
+	uint8_t set_identifier[ 16 ];
+
+	/* The file descriptor of the shared memory object
+	 */
+	int file_descriptor;
+
+	/* The mapped data
+	 */
+	uint8_t *mapped_data;
+
+	/* The mapped data size
+	 */
+	size64_t mapped_data_size;
+
+	/* The header
+	 */
+	libewf_shared_chunk_cache_header_t *header;
+
+	/* The entries
+	 */
+	libewf_shared_chunk_cache_entry_t *entries;
+
+	/* The chunk data slots
+	 */
+	uint8_t *slots;
+
+	/* The size of a slot of chunk data
+	 */
+	uint32_t slot_size;
+
+	/* The number of hash buckets
+	 */
+	uint32_t number_of_buckets;
+
+	/* The number of chunks read from the shared memory
+	 */
+	uint64_t number_of_hits;
+
+	/* The number of chunks not found in the shared memory
+	 */
+	uint64_t number_of_misses;
+};
+
+int libewf_shared_chunk_cache_initialize(
+     libewf_shared_chunk_cache_t **shared_chunk_cache,
+     size32_t chunk_size,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error );
+
+int libewf_shared_chunk_cache_free(
+     libewf_shared_chunk_cache_t **shared_chunk_cache,
+     libcerror_error_t **error );
+
+int libewf_shared_chunk_cache_set_segment_number(
+     libewf_shared_chunk_cache_t *shared_chunk_cache,
+     int file_io_pool_entry,
+     uint32_t segment_number,
+     libcerror_error_t **error );
+
+int libewf_shared_chunk_cache_open(
+     libewf_shared_chunk_cache_t *shared_chunk_cache,
+     const char *name,
+     size_t name_length,
+     const uint8_t *set_identifier,
+     size_t set_identifier_size,
+     libcerror_error_t **error );
+
+int libewf_shared_chunk_cache_close(
+     libewf_shared_chunk_cache_t *shared_chunk_cache,
+     libcerror_error_t **error );
+
+int libewf_shared_chunk_cache_lock(
+     libewf_shared_chunk_cache_t *shared_chunk_cache,
+     libcerror_error_t **error );
+
+int libewf_shared_chunk_cache_unlock(
+     libewf_shared_chunk_cache_t *shared_chunk_cache,
+     libcerror_error_t **error );
+
+int libewf_shared_chunk_cache_get_bucket_index(
+     libewf_shared_chunk_cache_t *shared_chunk_cache,
+     uint32_t segment_number,
+     off64_t chunk_offset,
+     uint32_t *bucket_index,
+     libcerror_error_t **error );
+
+int libewf_shared_chunk_cache_read_chunk_data(
+     libewf_shared_chunk_cache_t *shared_chunk_cache,
+     int file_io_pool_entry,
+     off64_t chunk_offset,
+     uint8_t *data,
+     size_t data_size,
+     size_t *chunk_data_size,
+     libcerror_error_t **error );
+
+int libewf_shared_chunk_cache_write_chunk_data(
+     libewf_shared_chunk_cache_t *shared_chunk_cache,
+     int file_io_pool_entry,
+     off64_t chunk_offset,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_SHARED_CHUNK_CACHE_H ) */
+
@@ -0,0 +1,767 @@
+/*
+ * Shared state functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_table.h"
+#include "libewf_hash_sections.h"
+#include "libewf_io_handle.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_libfvalue.h"
+#include "libewf_segment_table.h"
+#include "libewf_shared_state.h"
+
+/* Creates a shared state
+ * Make sure the value shared_state is referencing, is set to NULL
+ * The shared state is created with 1 reference and without values
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_shared_state_initialize(
+     libewf_shared_state_t **shared_state,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_shared_state_initialize";
+
+	if( shared_state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared state.",
+		 function );
+
+		return( -1 );
+	}
+	if( *shared_state != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid shared state value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*shared_state = memory_allocate_structure(
+	                 libewf_shared_state_t );
+
+	if( *shared_state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create shared state.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *shared_state,
+	     0,
+	     sizeof( libewf_shared_state_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear shared state.",
+		 function );
+
+		memory_free(
+		 *shared_state );
+
+		*shared_state = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *shared_state )->reference_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create reference mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *shared_state )->interactive_reads_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create interactive reads mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *shared_state )->interactive_reads_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create interactive reads condition.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *shared_state )->number_of_references = 1;
+
+	return( 1 );
+
+on_error:
+	if( *shared_state != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *shared_state )->interactive_reads_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *shared_state )->interactive_reads_mutex ),
+			 NULL );
+		}
+		if( ( *shared_state )->reference_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *shared_state )->reference_mutex ),
+			 NULL );
+		}
+#endif
+		memory_free(
+		 *shared_state );
+
+		*shared_state = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a shared state and the values it owns
+ * Use libewf_shared_state_release to release a reference
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_shared_state_free(
+     libewf_shared_state_t **shared_state,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_shared_state_free";
+	int result            = 1;
+
+	if( shared_state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared state.",
+		 function );
+
+		return( -1 );
+	}
+	if( *shared_state != NULL )
+	{
+		if( ( *shared_state )->hash_values != NULL )
+		{
+			if( libfvalue_table_free(
+			     &( ( *shared_state )->hash_values ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free hash values.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *shared_state )->header_values != NULL )
+		{
+			if( libfvalue_table_free(
+			     &( ( *shared_state )->header_values ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free header values.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *shared_state )->hash_sections != NULL )
+		{
+			if( libewf_hash_sections_free(
+			     &( ( *shared_state )->hash_sections ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free hash sections.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *shared_state )->chunk_table != NULL )
+		{
+			if( libewf_chunk_table_free(
+			     &( ( *shared_state )->chunk_table ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk table.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *shared_state )->segment_table != NULL )
+		{
+			if( libewf_segment_table_free(
+			     &( ( *shared_state )->segment_table ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free segment table.",
+				 function );
+
+				result = -1;
+			}
+		}
+		/* The IO handle is freed after the tables since they reference it
+		 */
+		if( ( *shared_state )->io_handle != NULL )
+		{
+			if( libewf_io_handle_free(
+			     &( ( *shared_state )->io_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *shared_state )->read_write_lock != NULL )
+		{
+			if( libcthreads_read_write_lock_free(
+			     &( ( *shared_state )->read_write_lock ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free read/write lock.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *shared_state )->reference_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free reference mutex.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_condition_free(
+		     &( ( *shared_state )->interactive_reads_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free interactive reads condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *shared_state )->interactive_reads_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free interactive reads mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *shared_state );
+
+		*shared_state = NULL;
+	}
+	return( result );
+}
+
+/* Acquires a reference to the shared state
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_shared_state_acquire(
+     libewf_shared_state_t *shared_state,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_shared_state_acquire";
+
+	if( shared_state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared state.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     shared_state->reference_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab reference mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	shared_state->number_of_references += 1;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     shared_state->reference_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release reference mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Releases a reference to the shared state
+ * The shared state is freed when the last reference is released
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_shared_state_release(
+     libewf_shared_state_t **shared_state,
+     libcerror_error_t **error )
+{
+	static char *function    = "libewf_shared_state_release";
+	int number_of_references = 0;
+
+	if( shared_state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared state.",
+		 function );
+
+		return( -1 );
+	}
+	if( *shared_state == NULL )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     ( *shared_state )->reference_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab reference mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	( *shared_state )->number_of_references -= 1;
+
+	number_of_references = ( *shared_state )->number_of_references;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     ( *shared_state )->reference_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release reference mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( number_of_references > 0 )
+	{
+		*shared_state = NULL;
+
+		return( 1 );
+	}
+	if( libewf_shared_state_free(
+	     shared_state,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free shared state.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Marks the start of an interactive read by the handle or one of its clones
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_shared_state_begin_interactive_read(
+     libewf_shared_state_t *shared_state,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_shared_state_begin_interactive_read";
+
+	if( shared_state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared state.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     shared_state->interactive_reads_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab interactive reads mutex.",
+		 function );
+
+		return( -1 );
+	}
+	shared_state->number_of_interactive_reads += 1;
+
+	if( libcthreads_mutex_release(
+	     shared_state->interactive_reads_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release interactive reads mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Marks the end of an interactive read by the handle or one of its clones
+ * Threads waiting for the interactive reads are woken when no interactive reads remain in progress
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_shared_state_end_interactive_read(
+     libewf_shared_state_t *shared_state,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_shared_state_end_interactive_read";
+	int result            = 1;
+
+	if( shared_state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared state.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     shared_state->interactive_reads_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab interactive reads mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( shared_state->number_of_interactive_reads > 0 )
+	{
+		shared_state->number_of_interactive_reads -= 1;
+	}
+	if( shared_state->number_of_interactive_reads == 0 )
+	{
+		if( libcthreads_condition_broadcast(
+		     shared_state->interactive_reads_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast interactive reads condition.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     shared_state->interactive_reads_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release interactive reads mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Waits until no interactive reads by the handle or its clones are in progress
+ * The wait is abandoned when the value pointed to by stop is set,
+ * use libewf_shared_state_signal_interactive_reads to wake the waiting threads after setting it
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_shared_state_wait_for_interactive_reads(
+     libewf_shared_state_t *shared_state,
+     uint8_t *stop,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_shared_state_wait_for_interactive_reads";
+	int result            = 1;
+
+	if( shared_state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared state.",
+		 function );
+
+		return( -1 );
+	}
+	if( stop == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stop.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     shared_state->interactive_reads_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab interactive reads mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( ( *stop == 0 )
+	    && ( shared_state->number_of_interactive_reads > 0 ) )
+	{
+		if( libcthreads_condition_wait(
+		     shared_state->interactive_reads_condition,
+		     shared_state->interactive_reads_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to wait for interactive reads condition.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     shared_state->interactive_reads_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release interactive reads mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Wakes the threads waiting for the interactive reads so they can re-evaluate their stop value
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_shared_state_signal_interactive_reads(
+     libewf_shared_state_t *shared_state,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_shared_state_signal_interactive_reads";
+	int result            = 1;
+
+	if( shared_state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared state.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     shared_state->interactive_reads_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab interactive reads mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_condition_broadcast(
+	     shared_state->interactive_reads_condition,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast interactive reads condition.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     shared_state->interactive_reads_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release interactive reads mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,141 @@
+/*
+ * Shared state functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_SHARED_STATE_H )
+#define _LIBEWF_SHARED_STATE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_table.h"
+#include "libewf_hash_sections.h"
+#include "libewf_io_handle.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_libfvalue.h"
+#include "libewf_segment_table.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_shared_state libewf_shared_state_t;
+
+/* The shared state contains the state of an opened handle that is shared
+ * with its clones, such as the segment table, the chunk table and the metadata
+ * The shared state owns its values and frees them when the last reference is released
+ */
+struct libewf_shared_state
+{
+	/* The IO handle that was used to open the segment files
+	 */
+	libewf_io_handle_t *io_handle;
+
+	/* The segment file table
+	 */
+	libewf_segment_table_t *segment_table;
+
+	/* The chunk table
+	 */
+	libewf_chunk_table_t *chunk_table;
+
+	/* The hash sections
+	 */
+	libewf_hash_sections_t *hash_sections;
+
+	/* The header values
+	 */
+	libfvalue_table_t *header_values;
+
+	/* The hash values
+	 */
+	libfvalue_table_t *hash_values;
+
+	/* The number of references to the shared state
+	 */
+	int number_of_references;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The read/write lock that protects the shared values
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+
+	/* The mutex that protects the number of references
+	 */
+	libcthreads_mutex_t *reference_mutex;
+
+	/* The number of interactive reads in progress by the handle and its clones
+	 */
+	int number_of_interactive_reads;
+
+	/* The mutex that protects the number of interactive reads
+	 */
+	libcthreads_mutex_t *interactive_reads_mutex;
+
+	/* The condition that is broadcast when no interactive reads are in progress
+	 */
+	libcthreads_condition_t *interactive_reads_condition;
+#endif
+};
+
+int libewf_shared_state_initialize(
+     libewf_shared_state_t **shared_state,
+     libcerror_error_t **error );
+
+int libewf_shared_state_free(
+     libewf_shared_state_t **shared_state,
+     libcerror_error_t **error );
+
+int libewf_shared_state_acquire(
+     libewf_shared_state_t *shared_state,
+     libcerror_error_t **error );
+
+int libewf_shared_state_release(
+     libewf_shared_state_t **shared_state,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+int libewf_shared_state_begin_interactive_read(
+     libewf_shared_state_t *shared_state,
+     libcerror_error_t **error );
+
+int libewf_shared_state_end_interactive_read(
+     libewf_shared_state_t *shared_state,
+     libcerror_error_t **error );
+
+int libewf_shared_state_wait_for_interactive_reads(
+     libewf_shared_state_t *shared_state,
+     uint8_t *stop,
+     libcerror_error_t **error );
+
+int libewf_shared_state_signal_interactive_reads(
+     libewf_shared_state_t *shared_state,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_SHARED_STATE_H ) */
+
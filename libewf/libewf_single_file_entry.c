@@ -105,6 +105,65 @@ on_error:
 	return( -1 );
 }
 
+/* Creates a single file entry in an arena
+ * Make sure the value single_file_entry is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_file_entry_initialize_in_arena(
+     libewf_single_file_entry_t **single_file_entry,
+     libewf_arena_t *arena,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_single_file_entry_initialize_in_arena";
+
+	if( single_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid single file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *single_file_entry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid single file entry value already set.",
+		 function );
+
+		return( -1 );
+	}
+	/* The arena provides cleared memory
+	 */
+	if( libewf_arena_allocate(
+	     arena,
+	     sizeof( libewf_single_file_entry_t ),
+	     (void **) single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create single file entry.",
+		 function );
+
+		*single_file_entry = NULL;
+
+		return( -1 );
+	}
+	( *single_file_entry )->data_offset           = -1;
+	( *single_file_entry )->duplicate_data_offset = -1;
+	( *single_file_entry )->is_arena_allocated    = 1;
+
+	return( 1 );
+}
+
 /* Frees a single file entry
  * Returns 1 if successful or -1 on error
  */
@@ -127,6 +186,19 @@ int libewf_single_file_entry_free(
 	}
 	if( *single_file_entry != NULL )
 	{
+		if( ( *single_file_entry )->sub_nodes_index != NULL )
+		{
+			memory_free(
+			 ( *single_file_entry )->sub_nodes_index );
+		}
+		/* The values of a single file entry in an arena are freed together with the arena
+		 */
+		if( ( *single_file_entry )->is_arena_allocated != 0 )
+		{
+			*single_file_entry = NULL;
+
+			return( 1 );
+		}
 		if( ( *single_file_entry )->name != NULL )
 		{
 			memory_free(
@@ -221,9 +293,12 @@ int libewf_single_file_entry_clone(
 
 		return( -1 );
 	}
-	( *destination_single_file_entry )->name      = NULL;
-	( *destination_single_file_entry )->md5_hash  = NULL;
-	( *destination_single_file_entry )->sha1_hash = NULL;
+	( *destination_single_file_entry )->name                 = NULL;
+	( *destination_single_file_entry )->md5_hash             = NULL;
+	( *destination_single_file_entry )->sha1_hash            = NULL;
+	( *destination_single_file_entry )->sub_nodes_index      = NULL;
+	( *destination_single_file_entry )->sub_nodes_index_size = 0;
+	( *destination_single_file_entry )->is_arena_allocated   = 0;
 
 	if( source_single_file_entry->name != NULL )
 	{
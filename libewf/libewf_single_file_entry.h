@@ -25,13 +25,28 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_arena.h"
 #include "libewf_date_time.h"
+#include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+typedef struct libewf_single_file_entry_index_value libewf_single_file_entry_index_value_t;
+
+struct libewf_single_file_entry_index_value
+{
+	/* The name hash
+	 */
+	uint32_t name_hash;
+
+	/* The sub node, NULL if the index value is not used
+	 */
+	libcdata_tree_node_t *sub_node;
+};
+
 typedef struct libewf_single_file_entry libewf_single_file_entry_t;
 
 struct libewf_single_file_entry
@@ -103,12 +118,31 @@ struct libewf_single_file_entry
 	/* The SHA1 digest hash size
 	 */
 	size_t sha1_hash_size;
+
+	/* The sub nodes index, a hash table of the sub nodes by name
+	 * that is only created for directories with many sub nodes
+	 */
+	libewf_single_file_entry_index_value_t *sub_nodes_index;
+
+	/* The number of values in the sub nodes index, which is a power of 2
+	 */
+	int sub_nodes_index_size;
+
+	/* Value to indicate the single file entry, its name and digest hashes
+	 * were allocated in an arena and are freed together with the arena
+	 */
+	uint8_t is_arena_allocated;
 };
 
 int libewf_single_file_entry_initialize(
      libewf_single_file_entry_t **single_file_entry,
      libcerror_error_t **error );
 
+int libewf_single_file_entry_initialize_in_arena(
+     libewf_single_file_entry_t **single_file_entry,
+     libewf_arena_t *arena,
+     libcerror_error_t **error );
+
 int libewf_single_file_entry_free(
      libewf_single_file_entry_t **single_file_entry,
      libcerror_error_t **error );
@@ -20,8 +20,10 @@
  */
 
 #include <common.h>
+#include <memory.h>
 #include <types.h>
 
+#include "libewf_definitions.h"
 #include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
 #include "libewf_libuna.h"
@@ -39,10 +41,11 @@ int libewf_single_file_tree_get_sub_node_by_utf8_name(
      libewf_single_file_entry_t **sub_single_file_entry,
      libcerror_error_t **error )
 {
-	static char *function   = "libewf_single_file_tree_get_sub_node_by_utf8_name";
-	int number_of_sub_nodes = 0;
-	int result              = LIBUNA_COMPARE_GREATER;
-	int sub_node_index      = 0;
+	libewf_single_file_entry_t *single_file_entry = NULL;
+	static char *function                         = "libewf_single_file_tree_get_sub_node_by_utf8_name";
+	int number_of_sub_nodes                       = 0;
+	int result                                    = LIBUNA_COMPARE_GREATER;
+	int sub_node_index                            = 0;
 
 	if( node == NULL )
 	{
@@ -77,6 +80,44 @@ int libewf_single_file_tree_get_sub_node_by_utf8_name(
 
 		return( -1 );
 	}
+	if( libcdata_tree_node_get_value(
+	     node,
+	     (intptr_t **) &single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve value from node.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( single_file_entry != NULL )
+	 && ( single_file_entry->sub_nodes_index != NULL ) )
+	{
+		result = libewf_single_file_tree_get_indexed_sub_node_by_utf8_name(
+		          single_file_entry,
+		          utf8_string,
+		          utf8_string_length,
+		          sub_node,
+		          sub_single_file_entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve indexed sub node.",
+			 function );
+
+			goto on_error;
+		}
+		return( result );
+	}
 	if( libcdata_tree_node_get_number_of_sub_nodes(
 	     node,
 	     &number_of_sub_nodes,
@@ -204,10 +245,11 @@ int libewf_single_file_tree_get_sub_node_by_utf16_name(
      libewf_single_file_entry_t **sub_single_file_entry,
      libcerror_error_t **error )
 {
-	static char *function   = "libewf_single_file_tree_get_sub_node_by_utf16_name";
-	int number_of_sub_nodes = 0;
-	int result              = LIBUNA_COMPARE_GREATER;
-	int sub_node_index      = 0;
+	libewf_single_file_entry_t *single_file_entry = NULL;
+	static char *function                         = "libewf_single_file_tree_get_sub_node_by_utf16_name";
+	int number_of_sub_nodes                       = 0;
+	int result                                    = LIBUNA_COMPARE_GREATER;
+	int sub_node_index                            = 0;
 
 	if( node == NULL )
 	{
@@ -242,6 +284,44 @@ int libewf_single_file_tree_get_sub_node_by_utf16_name(
 
 		return( -1 );
 	}
+	if( libcdata_tree_node_get_value(
+	     node,
+	     (intptr_t **) &single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve value from node.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( single_file_entry != NULL )
+	 && ( single_file_entry->sub_nodes_index != NULL ) )
+	{
+		result = libewf_single_file_tree_get_indexed_sub_node_by_utf16_name(
+		          single_file_entry,
+		          utf16_string,
+		          utf16_string_length,
+		          sub_node,
+		          sub_single_file_entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve indexed sub node.",
+			 function );
+
+			goto on_error;
+		}
+		return( result );
+	}
 	if( libcdata_tree_node_get_number_of_sub_nodes(
 	     node,
 	     &number_of_sub_nodes,
@@ -358,3 +438,704 @@ on_error:
 	return( -1 );
 }
 
+
+/* Calculates the hash of an UTF-8 formatted name
+ * The hash is calculated over the Unicode characters, so that it is the same
+ * for an UTF-8 and UTF-16 formatted name that compare as equal
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_file_tree_get_utf8_name_hash(
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     uint32_t *name_hash,
+     libcerror_error_t **error )
+{
+	static char *function                        = "libewf_single_file_tree_get_utf8_name_hash";
+	libuna_unicode_character_t unicode_character = 0;
+	size_t utf8_string_index                     = 0;
+	uint32_t safe_name_hash                      = 2166136261UL;
+
+	if( utf8_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( name_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name hash.",
+		 function );
+
+		return( -1 );
+	}
+	while( utf8_string_index < utf8_string_length )
+	{
+		if( libuna_unicode_character_copy_from_utf8(
+		     &unicode_character,
+		     utf8_string,
+		     utf8_string_length,
+		     &utf8_string_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+			 LIBCERROR_CONVERSION_ERROR_INPUT_FAILED,
+			 "%s: unable to copy Unicode character from UTF-8 string.",
+			 function );
+
+			return( -1 );
+		}
+		if( unicode_character == 0 )
+		{
+			break;
+		}
+		/* FNV-1a
+		 */
+		safe_name_hash ^= (uint32_t) unicode_character;
+		safe_name_hash *= 16777619UL;
+	}
+	*name_hash = safe_name_hash;
+
+	return( 1 );
+}
+
+/* Calculates the hash of an UTF-16 formatted name
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_file_tree_get_utf16_name_hash(
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     uint32_t *name_hash,
+     libcerror_error_t **error )
+{
+	static char *function                        = "libewf_single_file_tree_get_utf16_name_hash";
+	libuna_unicode_character_t unicode_character = 0;
+	size_t utf16_string_index                    = 0;
+	uint32_t safe_name_hash                      = 2166136261UL;
+
+	if( utf16_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-16 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( name_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name hash.",
+		 function );
+
+		return( -1 );
+	}
+	while( utf16_string_index < utf16_string_length )
+	{
+		if( libuna_unicode_character_copy_from_utf16(
+		     &unicode_character,
+		     utf16_string,
+		     utf16_string_length,
+		     &utf16_string_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+			 LIBCERROR_CONVERSION_ERROR_INPUT_FAILED,
+			 "%s: unable to copy Unicode character from UTF-16 string.",
+			 function );
+
+			return( -1 );
+		}
+		if( unicode_character == 0 )
+		{
+			break;
+		}
+		/* FNV-1a
+		 */
+		safe_name_hash ^= (uint32_t) unicode_character;
+		safe_name_hash *= 16777619UL;
+	}
+	*name_hash = safe_name_hash;
+
+	return( 1 );
+}
+
+/* Builds the sub nodes index of a single file tree node
+ * The index is only built when the node has many sub nodes, for example
+ * a flat directory of a mail export, so that name lookups do not require
+ * to compare the name of every sub node
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_file_tree_build_sub_nodes_index(
+     libcdata_tree_node_t *node,
+     libcerror_error_t **error )
+{
+	libcdata_tree_node_t *sub_node                      = NULL;
+	libewf_single_file_entry_t *single_file_entry       = NULL;
+	libewf_single_file_entry_t *sub_single_file_entry   = NULL;
+	libewf_single_file_entry_index_value_t *index_value = NULL;
+	uint8_t *name                                       = NULL;
+	static char *function                               = "libewf_single_file_tree_build_sub_nodes_index";
+	size_t name_size                                    = 0;
+	uint32_t index_mask                                 = 0;
+	uint32_t name_hash                                  = 0;
+	int number_of_sub_nodes                             = 0;
+	int sub_node_index                                  = 0;
+	int sub_nodes_index_size                            = 0;
+
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_tree_node_get_value(
+	     node,
+	     (intptr_t **) &single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve value from node.",
+		 function );
+
+		return( -1 );
+	}
+	if( single_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing single file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( single_file_entry->sub_nodes_index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid single file entry - sub nodes index value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_tree_node_get_number_of_sub_nodes(
+	     node,
+	     &number_of_sub_nodes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sub nodes.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_sub_nodes < LIBEWF_MINIMUM_NUMBER_OF_INDEXED_SUB_NODES )
+	{
+		return( 1 );
+	}
+	if( number_of_sub_nodes > ( INT_MAX / 4 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of sub nodes value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* Keep the index at most half full so that the probe sequences are short
+	 */
+	sub_nodes_index_size = LIBEWF_MINIMUM_NUMBER_OF_INDEXED_SUB_NODES;
+
+	while( sub_nodes_index_size < ( 2 * number_of_sub_nodes ) )
+	{
+		sub_nodes_index_size *= 2;
+	}
+	single_file_entry->sub_nodes_index = (libewf_single_file_entry_index_value_t *) memory_allocate(
+	                                                                                 sizeof( libewf_single_file_entry_index_value_t ) * sub_nodes_index_size );
+
+	if( single_file_entry->sub_nodes_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create sub nodes index.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     single_file_entry->sub_nodes_index,
+	     0,
+	     sizeof( libewf_single_file_entry_index_value_t ) * sub_nodes_index_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear sub nodes index.",
+		 function );
+
+		goto on_error;
+	}
+	index_mask = (uint32_t) sub_nodes_index_size - 1;
+
+	if( libcdata_tree_node_get_sub_node_by_index(
+	     node,
+	     0,
+	     &sub_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve first sub node.",
+		 function );
+
+		goto on_error;
+	}
+	for( sub_node_index = 0;
+	     sub_node_index < number_of_sub_nodes;
+	     sub_node_index++ )
+	{
+		if( libcdata_tree_node_get_value(
+		     sub_node,
+		     (intptr_t **) &sub_single_file_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve value from sub node: %d.",
+			 function,
+			 sub_node_index );
+
+			goto on_error;
+		}
+		if( sub_single_file_entry == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing sub single file entry: %d.",
+			 function,
+			 sub_node_index );
+
+			goto on_error;
+		}
+		/* A sub node without a name cannot be looked up by name
+		 */
+		if( sub_single_file_entry->name != NULL )
+		{
+			name      = sub_single_file_entry->name;
+			name_size = sub_single_file_entry->name_size;
+
+			/* The name is compared as an UTF-8 stream, which can start with a byte order mark
+			 */
+			if( ( name_size >= 3 )
+			 && ( name[ 0 ] == 0xef )
+			 && ( name[ 1 ] == 0xbb )
+			 && ( name[ 2 ] == 0xbf ) )
+			{
+				name      += 3;
+				name_size -= 3;
+			}
+			if( libewf_single_file_tree_get_utf8_name_hash(
+			     name,
+			     name_size,
+			     &name_hash,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve name hash of sub node: %d.",
+				 function,
+				 sub_node_index );
+
+				goto on_error;
+			}
+			index_value = &( single_file_entry->sub_nodes_index[ name_hash & index_mask ] );
+
+			while( index_value->sub_node != NULL )
+			{
+				index_value += 1;
+
+				if( index_value >= &( single_file_entry->sub_nodes_index[ sub_nodes_index_size ] ) )
+				{
+					index_value = single_file_entry->sub_nodes_index;
+				}
+			}
+			index_value->name_hash = name_hash;
+			index_value->sub_node  = sub_node;
+		}
+		if( libcdata_tree_node_get_next_node(
+		     sub_node,
+		     &sub_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next node from sub node: %d.",
+			 function,
+			 sub_node_index );
+
+			goto on_error;
+		}
+	}
+	single_file_entry->sub_nodes_index_size = sub_nodes_index_size;
+
+	return( 1 );
+
+on_error:
+	if( single_file_entry->sub_nodes_index != NULL )
+	{
+		memory_free(
+		 single_file_entry->sub_nodes_index );
+
+		single_file_entry->sub_nodes_index = NULL;
+	}
+	return( -1 );
+}
+
+/* Retrieves the single file entry sub node for the specific UTF-8 formatted name using the sub nodes index
+ * Returns 1 if successful, 0 if no such sub single file entry or -1 on error
+ */
+int libewf_single_file_tree_get_indexed_sub_node_by_utf8_name(
+     libewf_single_file_entry_t *single_file_entry,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libcdata_tree_node_t **sub_node,
+     libewf_single_file_entry_t **sub_single_file_entry,
+     libcerror_error_t **error )
+{
+	libewf_single_file_entry_index_value_t *index_value = NULL;
+	static char *function                               = "libewf_single_file_tree_get_indexed_sub_node_by_utf8_name";
+	uint32_t name_hash                                  = 0;
+	int result                                          = 0;
+
+	if( single_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid single file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( single_file_entry->sub_nodes_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid single file entry - missing sub nodes index.",
+		 function );
+
+		return( -1 );
+	}
+	if( sub_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub node.",
+		 function );
+
+		return( -1 );
+	}
+	if( sub_single_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub single file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_single_file_tree_get_utf8_name_hash(
+	     utf8_string,
+	     utf8_string_length,
+	     &name_hash,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve name hash.",
+		 function );
+
+		return( -1 );
+	}
+	index_value = &( single_file_entry->sub_nodes_index[ name_hash & (uint32_t) ( single_file_entry->sub_nodes_index_size - 1 ) ] );
+
+	while( index_value->sub_node != NULL )
+	{
+		if( index_value->name_hash == name_hash )
+		{
+			if( libcdata_tree_node_get_value(
+			     index_value->sub_node,
+			     (intptr_t **) sub_single_file_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve value from sub node.",
+				 function );
+
+				goto on_error;
+			}
+			if( ( *sub_single_file_entry == NULL )
+			 || ( ( *sub_single_file_entry )->name == NULL ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: invalid sub single file entry.",
+				 function );
+
+				goto on_error;
+			}
+			result = libuna_utf8_string_compare_with_utf8_stream(
+				  utf8_string,
+				  utf8_string_length,
+				  ( *sub_single_file_entry )->name,
+				  (size_t) ( *sub_single_file_entry )->name_size,
+				  error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to compare UTF-8 string.",
+				 function );
+
+				goto on_error;
+			}
+			else if( result == LIBUNA_COMPARE_EQUAL )
+			{
+				*sub_node = index_value->sub_node;
+
+				return( 1 );
+			}
+		}
+		index_value += 1;
+
+		if( index_value >= &( single_file_entry->sub_nodes_index[ single_file_entry->sub_nodes_index_size ] ) )
+		{
+			index_value = single_file_entry->sub_nodes_index;
+		}
+	}
+	*sub_node              = NULL;
+	*sub_single_file_entry = NULL;
+
+	return( 0 );
+
+on_error:
+	*sub_node              = NULL;
+	*sub_single_file_entry = NULL;
+
+	return( -1 );
+}
+
+/* Retrieves the single file entry sub node for the specific UTF-16 formatted name using the sub nodes index
+ * Returns 1 if successful, 0 if no such sub single file entry or -1 on error
+ */
+int libewf_single_file_tree_get_indexed_sub_node_by_utf16_name(
+     libewf_single_file_entry_t *single_file_entry,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libcdata_tree_node_t **sub_node,
+     libewf_single_file_entry_t **sub_single_file_entry,
+     libcerror_error_t **error )
+{
+	libewf_single_file_entry_index_value_t *index_value = NULL;
+	static char *function                               = "libewf_single_file_tree_get_indexed_sub_node_by_utf16_name";
+	uint32_t name_hash                                  = 0;
+	int result                                          = 0;
+
+	if( single_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid single file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( single_file_entry->sub_nodes_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid single file entry - missing sub nodes index.",
+		 function );
+
+		return( -1 );
+	}
+	if( sub_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub node.",
+		 function );
+
+		return( -1 );
+	}
+	if( sub_single_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub single file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_single_file_tree_get_utf16_name_hash(
+	     utf16_string,
+	     utf16_string_length,
+	     &name_hash,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve name hash.",
+		 function );
+
+		return( -1 );
+	}
+	index_value = &( single_file_entry->sub_nodes_index[ name_hash & (uint32_t) ( single_file_entry->sub_nodes_index_size - 1 ) ] );
+
+	while( index_value->sub_node != NULL )
+	{
+		if( index_value->name_hash == name_hash )
+		{
+			if( libcdata_tree_node_get_value(
+			     index_value->sub_node,
+			     (intptr_t **) sub_single_file_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve value from sub node.",
+				 function );
+
+				goto on_error;
+			}
+			if( ( *sub_single_file_entry == NULL )
+			 || ( ( *sub_single_file_entry )->name == NULL ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: invalid sub single file entry.",
+				 function );
+
+				goto on_error;
+			}
+			result = libuna_utf16_string_compare_with_utf8_stream(
+				  utf16_string,
+				  utf16_string_length,
+				  ( *sub_single_file_entry )->name,
+				  (size_t) ( *sub_single_file_entry )->name_size,
+				  error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to compare UTF-16 string.",
+				 function );
+
+				goto on_error;
+			}
+			else if( result == LIBUNA_COMPARE_EQUAL )
+			{
+				*sub_node = index_value->sub_node;
+
+				return( 1 );
+			}
+		}
+		index_value += 1;
+
+		if( index_value >= &( single_file_entry->sub_nodes_index[ single_file_entry->sub_nodes_index_size ] ) )
+		{
+			index_value = single_file_entry->sub_nodes_index;
+		}
+	}
+	*sub_node              = NULL;
+	*sub_single_file_entry = NULL;
+
+	return( 0 );
+
+on_error:
+	*sub_node              = NULL;
+	*sub_single_file_entry = NULL;
+
+	return( -1 );
+}
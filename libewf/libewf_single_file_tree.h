@@ -49,6 +49,38 @@ int libewf_single_file_tree_get_sub_node_by_utf16_name(
      libewf_single_file_entry_t **sub_single_file_entry,
      libcerror_error_t **error );
 
+int libewf_single_file_tree_get_utf8_name_hash(
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     uint32_t *name_hash,
+     libcerror_error_t **error );
+
+int libewf_single_file_tree_get_utf16_name_hash(
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     uint32_t *name_hash,
+     libcerror_error_t **error );
+
+int libewf_single_file_tree_build_sub_nodes_index(
+     libcdata_tree_node_t *single_file_tree_node,
+     libcerror_error_t **error );
+
+int libewf_single_file_tree_get_indexed_sub_node_by_utf8_name(
+     libewf_single_file_entry_t *single_file_entry,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libcdata_tree_node_t **single_file_tree_sub_node,
+     libewf_single_file_entry_t **sub_single_file_entry,
+     libcerror_error_t **error );
+
+int libewf_single_file_tree_get_indexed_sub_node_by_utf16_name(
+     libewf_single_file_entry_t *single_file_entry,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libcdata_tree_node_t **single_file_tree_sub_node,
+     libewf_single_file_entry_t **sub_single_file_entry,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -20,19 +20,30 @@
  */
 
 #include <common.h>
+#include <byte_stream.h>
 #include <memory.h>
 #include <narrow_string.h>
 #include <types.h>
 
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "libewf_arena.h"
 #include "libewf_definitions.h"
 #include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
 #include "libewf_libcnotify.h"
 #include "libewf_libfvalue.h"
+#include "libewf_libhmac.h"
 #include "libewf_libuna.h"
+#include "libewf_memory_accounting.h"
 #include "libewf_single_file_entry.h"
+#include "libewf_single_file_tree.h"
 #include "libewf_single_files.h"
 
+#include "ewf_ltree.h"
+
 /* Creates single files
  * Make sure the value single_files is referencing, is set to NULL
  * Returns 1 if successful or -1 on error
@@ -93,6 +104,11 @@ int libewf_single_files_initialize(
 
 		goto on_error;
 	}
+	LIBEWF_MEMORY_ACCOUNTING_UPDATE(
+	 LIBEWF_MEMORY_TYPE_SINGLE_FILES,
+	 *single_files,
+	 sizeof( libewf_single_files_t ) );
+
 	return( 1 );
 
 on_error:
@@ -134,6 +150,22 @@ int libewf_single_files_free(
 			memory_free(
 			 ( *single_files )->section_data );
 		}
+		if( ( *single_files )->ltree_md5_context != NULL )
+		{
+			if( libhmac_md5_free(
+			     &( ( *single_files )->ltree_md5_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free ltree MD5 context.",
+				 function );
+
+				result = -1;
+			}
+		}
 		if( ( *single_files )->root_file_entry_node != NULL )
 		{
 			if( libcdata_tree_node_free(
@@ -151,6 +183,29 @@ int libewf_single_files_free(
 				result = -1;
 			}
 		}
+		/* The arena must be freed after the single file entry tree
+		 */
+		if( ( *single_files )->arena != NULL )
+		{
+			if( libewf_arena_free(
+			     &( ( *single_files )->arena ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free arena.",
+				 function );
+
+				result = -1;
+			}
+		}
+		LIBEWF_MEMORY_ACCOUNTING_UPDATE(
+		 LIBEWF_MEMORY_TYPE_SINGLE_FILES,
+		 *single_files,
+		 0 );
+
 		memory_free(
 		 *single_files );
 
@@ -159,7 +214,406 @@ int libewf_single_files_free(
 	return( result );
 }
 
+#if defined( HAVE_LIBEWF_MEMORY_ACCOUNTING )
+
+/* Updates the size of the memory accounted for the single files
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_files_update_memory_accounting(
+     libewf_single_files_t *single_files,
+     libcerror_error_t **error )
+{
+	static char *function   = "libewf_single_files_update_memory_accounting";
+	size64_t allocated_size = 0;
+	size_t memory_size      = 0;
+
+	if( single_files == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid single files.",
+		 function );
+
+		return( -1 );
+	}
+	memory_size = sizeof( libewf_single_files_t );
+
+	if( single_files->section_data != NULL )
+	{
+		if( single_files->section_data_allocated_size != 0 )
+		{
+			memory_size += single_files->section_data_allocated_size;
+		}
+		else
+		{
+			memory_size += single_files->section_data_size;
+		}
+	}
+	if( single_files->arena != NULL )
+	{
+		if( libewf_arena_get_allocated_size(
+		     single_files->arena,
+		     &allocated_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve arena allocated size.",
+			 function );
+
+			return( -1 );
+		}
+		memory_size += (size_t) allocated_size;
+	}
+	LIBEWF_MEMORY_ACCOUNTING_UPDATE(
+	 LIBEWF_MEMORY_TYPE_SINGLE_FILES,
+	 single_files,
+	 memory_size );
+
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MEMORY_ACCOUNTING ) */
+
+/* Appends UTF-8 formatted ltree data for writing
+ * The ltree data is stored as UTF-16 little-endian without byte order mark
+ * behind space reserved for the ltree header, such that the section data
+ * can be written as-is once the last segment file is closed
+ * The integrity hash of the ltree data is updated with the appended data
+ * while it is cache resident, such that the ltree data does not need to be
+ * read again when the section is written
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_files_append_utf8_ltree_data(
+     libewf_single_files_t *single_files,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libcerror_error_t **error )
+{
+	uint8_t *reallocation                        = NULL;
+	static char *function                        = "libewf_single_files_append_utf8_ltree_data";
+	libuna_unicode_character_t unicode_character = 0;
+	libuna_utf16_character_t utf16_string[ 2 ];
+	size_t allocated_size                        = 0;
+	size_t append_offset                         = 0;
+	size_t required_size                         = 0;
+	size_t utf16_string_index                    = 0;
+	size_t utf16_string_size                     = 0;
+	size_t utf8_string_index                     = 0;
+
+	if( single_files == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid single files.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( single_files->section_data != NULL )
+	 && ( single_files->section_data_allocated_size == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid single files - ltree data already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( single_files->ltree_md5_hash_is_set != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid single files - ltree integrity hash already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string_length > (size_t) ( SSIZE_MAX / 4 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid UTF-8 string length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( single_files->section_data == NULL )
+	{
+		single_files->section_data_size = sizeof( ewf_ltree_header_t );
+	}
+	/* A UTF-8 character never requires more than 2 bytes per byte when stored as UTF-16
+	 */
+	required_size = single_files->section_data_size + ( 2 * utf8_string_length );
+
+	if( required_size > single_files->section_data_allocated_size )
+	{
+		allocated_size = ( required_size / LIBEWF_SINGLE_FILES_LTREE_DATA_BLOCK_SIZE ) + 1;
+		allocated_size *= LIBEWF_SINGLE_FILES_LTREE_DATA_BLOCK_SIZE;
+
+		if( allocated_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid section data size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		reallocation = (uint8_t *) memory_reallocate(
+		                            single_files->section_data,
+		                            sizeof( uint8_t ) * allocated_size );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize section data.",
+			 function );
+
+			return( -1 );
+		}
+		if( single_files->section_data == NULL )
+		{
+			if( memory_set(
+			     reallocation,
+			     0,
+			     sizeof( ewf_ltree_header_t ) ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear ltree header.",
+				 function );
+
+				memory_free(
+				 reallocation );
+
+				single_files->section_data_size = 0;
+
+				return( -1 );
+			}
+		}
+		single_files->section_data                = reallocation;
+		single_files->section_data_allocated_size = allocated_size;
+	}
+	if( single_files->ltree_md5_context == NULL )
+	{
+		if( libhmac_md5_initialize(
+		     &( single_files->ltree_md5_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create ltree MD5 context.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	append_offset = single_files->section_data_size;
+
+	while( utf8_string_index < utf8_string_length )
+	{
+		if( libuna_unicode_character_copy_from_utf8(
+		     &unicode_character,
+		     utf8_string,
+		     utf8_string_length,
+		     &utf8_string_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+			 LIBCERROR_CONVERSION_ERROR_INPUT_FAILED,
+			 "%s: unable to copy Unicode character from UTF-8 string.",
+			 function );
+
+			return( -1 );
+		}
+		utf16_string_index = 0;
+
+		if( libuna_unicode_character_copy_to_utf16(
+		     unicode_character,
+		     utf16_string,
+		     2,
+		     &utf16_string_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+			 LIBCERROR_CONVERSION_ERROR_INPUT_FAILED,
+			 "%s: unable to copy Unicode character to UTF-16 string.",
+			 function );
+
+			return( -1 );
+		}
+		for( utf16_string_size = 0;
+		     utf16_string_size < utf16_string_index;
+		     utf16_string_size++ )
+		{
+			byte_stream_copy_from_uint16_little_endian(
+			 &( single_files->section_data[ single_files->section_data_size ] ),
+			 utf16_string[ utf16_string_size ] );
+
+			single_files->section_data_size += 2;
+		}
+	}
+	if( libhmac_md5_update(
+	     single_files->ltree_md5_context,
+	     &( single_files->section_data[ append_offset ] ),
+	     single_files->section_data_size - append_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update ltree MD5 context.",
+		 function );
+
+		return( -1 );
+	}
+	single_files->ltree_data      = &( single_files->section_data[ sizeof( ewf_ltree_header_t ) ] );
+	single_files->ltree_data_size = single_files->section_data_size - sizeof( ewf_ltree_header_t );
+
+#if defined( HAVE_LIBEWF_MEMORY_ACCOUNTING )
+	if( libewf_single_files_update_memory_accounting(
+	     single_files,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update memory accounting.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the integrity hash of the ltree data that was appended for writing
+ * The MD5 hash is finalized on first retrieval, after which no ltree data can be appended
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libewf_single_files_get_ltree_integrity_hash(
+     libewf_single_files_t *single_files,
+     uint8_t *integrity_hash,
+     size_t integrity_hash_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_single_files_get_ltree_integrity_hash";
+
+	if( single_files == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid single files.",
+		 function );
+
+		return( -1 );
+	}
+	if( integrity_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid integrity hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( integrity_hash_size < LIBHMAC_MD5_HASH_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid integrity hash size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( single_files->ltree_md5_context == NULL )
+	{
+		return( 0 );
+	}
+	if( single_files->ltree_md5_hash_is_set == 0 )
+	{
+		if( libhmac_md5_finalize(
+		     single_files->ltree_md5_context,
+		     single_files->ltree_md5_hash,
+		     LIBHMAC_MD5_HASH_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize ltree MD5 context.",
+			 function );
+
+			return( -1 );
+		}
+		single_files->ltree_md5_hash_is_set = 1;
+	}
+	if( memory_copy(
+	     integrity_hash,
+	     single_files->ltree_md5_hash,
+	     LIBHMAC_MD5_HASH_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy ltree integrity hash.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Parse an EWF ltree for the values
+ * The ltree data is freed once it has been converted, since it is no longer needed
+ * after parsing, to reduce the memory usage of logical images with many file entries
  * Returns 1 if successful or -1 on error
  */
 int libewf_single_files_parse(
@@ -168,9 +622,10 @@ int libewf_single_files_parse(
      uint8_t *format,
      libcerror_error_t **error )
 {
-	uint8_t *file_entries_string    = NULL;
-	static char *function           = "libewf_single_files_parse";
-	size_t file_entries_string_size = 0;
+	libfvalue_split_utf8_string_t *lines = NULL;
+	uint8_t *file_entries_string         = NULL;
+	static char *function                = "libewf_single_files_parse";
+	size_t file_entries_string_size      = 0;
 
 	if( single_files == NULL )
 	{
@@ -241,11 +696,48 @@ int libewf_single_files_parse(
 
 		goto on_error;
 	}
-	if( libewf_single_files_parse_file_entries(
+	/* The ltree data is part of the section data
+	 */
+	if( single_files->section_data != NULL )
+	{
+		memory_free(
+		 single_files->section_data );
+
+		single_files->section_data                = NULL;
+		single_files->section_data_size           = 0;
+		single_files->section_data_allocated_size = 0;
+	}
+	single_files->ltree_data      = NULL;
+	single_files->ltree_data_size = 0;
+	single_files->ltree_is_parsed = 1;
+
+	if( libfvalue_utf8_string_split(
+	     file_entries_string,
+	     file_entries_string_size - 1,
+	     (uint8_t) '\n',
+	     &lines,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to split file entries string into lines.",
+		 function );
+
+		goto on_error;
+	}
+	/* The split lines contain a copy of the file entries string
+	 */
+	memory_free(
+	 file_entries_string );
+
+	file_entries_string = NULL;
+
+	if( libewf_single_files_parse_lines(
 	     single_files,
 	     media_size,
-	     file_entries_string,
-	     file_entries_string_size,
+	     lines,
 	     format,
 	     error ) != 1 )
 	{
@@ -253,17 +745,48 @@ int libewf_single_files_parse(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
 		 LIBCERROR_CONVERSION_ERROR_GENERIC,
-		 "%s: unable to parse file entries string.",
+		 "%s: unable to parse file entries lines.",
 		 function );
 
 		goto on_error;
 	}
-	memory_free(
-	 file_entries_string );
+	if( libfvalue_split_utf8_string_free(
+	     &lines,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free split lines.",
+		 function );
 
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MEMORY_ACCOUNTING )
+	if( libewf_single_files_update_memory_accounting(
+	     single_files,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update memory accounting.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	return( 1 );
 
 on_error:
+	if( lines != NULL )
+	{
+		libfvalue_split_utf8_string_free(
+		 &lines,
+		 NULL );
+	}
 	if( file_entries_string != NULL )
 	{
 		memory_free(
@@ -284,12 +807,7 @@ int libewf_single_files_parse_file_entries(
      libcerror_error_t **error )
 {
 	libfvalue_split_utf8_string_t *lines = NULL;
-	libfvalue_split_utf8_string_t *types = NULL;
-	uint8_t *line_string                 = NULL;
 	static char *function                = "libewf_single_files_parse_file_entries";
-	size_t line_string_size              = 0;
-	int line_index                       = 0;
-	int number_of_lines                  = 0;
 
 	if( single_files == NULL )
 	{
@@ -329,6 +847,75 @@ int libewf_single_files_parse_file_entries(
 
 		goto on_error;
 	}
+	if( libewf_single_files_parse_lines(
+	     single_files,
+	     media_size,
+	     lines,
+	     format,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to parse file entries lines.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfvalue_split_utf8_string_free(
+	     &lines,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free split lines.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( lines != NULL )
+	{
+		libfvalue_split_utf8_string_free(
+		 &lines,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Parse the lines of a single file entries string for the values
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_files_parse_lines(
+     libewf_single_files_t *single_files,
+     size64_t *media_size,
+     libfvalue_split_utf8_string_t *lines,
+     uint8_t *format,
+     libcerror_error_t **error )
+{
+	libfvalue_split_utf8_string_t *types = NULL;
+	uint8_t *line_string                 = NULL;
+	static char *function                = "libewf_single_files_parse_lines";
+	size_t line_string_size              = 0;
+	int line_index                       = 0;
+	int number_of_lines                  = 0;
+
+	if( single_files == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid single files.",
+		 function );
+
+		return( -1 );
+	}
 	if( libfvalue_split_utf8_string_get_number_of_segments(
 	     lines,
 	     &number_of_lines,
@@ -553,6 +1140,23 @@ int libewf_single_files_parse_file_entries(
 
 				goto on_error;
 			}
+			if( single_files->arena == NULL )
+			{
+				if( libewf_arena_initialize(
+				     &( single_files->arena ),
+				     LIBEWF_SINGLE_FILES_ARENA_BLOCK_SIZE,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create arena.",
+					 function );
+
+					goto on_error;
+				}
+			}
 			if( libcdata_tree_node_initialize(
 			     &( single_files->root_file_entry_node ),
 			     error ) != 1 )
@@ -571,6 +1175,7 @@ int libewf_single_files_parse_file_entries(
 			     lines,
 			     &line_index,
 			     types,
+			     single_files->arena,
 			     format,
 			     error ) != 1 )
 			{
@@ -617,31 +1222,18 @@ int libewf_single_files_parse_file_entries(
 			}
 		}
 		if( libfvalue_split_utf8_string_free(
-		     &types,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free split types.",
-			 function );
-
-			goto on_error;
-		}
-	}
-	if( libfvalue_split_utf8_string_free(
-	     &lines,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free split lines.",
-		 function );
+		     &types,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free split types.",
+			 function );
 
-		goto on_error;
+			goto on_error;
+		}
 	}
 	return( 1 );
 
@@ -652,12 +1244,6 @@ on_error:
 		 &types,
 		 NULL );
 	}
-	if( lines != NULL )
-	{
-		libfvalue_split_utf8_string_free(
-		 &lines,
-		 NULL );
-	}
 	return( -1 );
 }
 
@@ -989,6 +1575,7 @@ on_error:
 }
 
 /* Parse a single file entry string for the values
+ * The single file entry and its values are allocated in the arena
  * Returns 1 if successful or -1 on error
  */
 int libewf_single_files_parse_file_entry(
@@ -996,6 +1583,7 @@ int libewf_single_files_parse_file_entry(
      libfvalue_split_utf8_string_t *lines,
      int *line_index,
      libfvalue_split_utf8_string_t *types,
+     libewf_arena_t *arena,
      uint8_t *format,
      libcerror_error_t **error )
 {
@@ -1140,8 +1728,9 @@ int libewf_single_files_parse_file_entry(
 		}
 	}
 #endif
-	if( libewf_single_file_entry_initialize(
+	if( libewf_single_file_entry_initialize_in_arena(
 	     &single_file_entry,
+	     arena,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -1306,10 +1895,11 @@ int libewf_single_files_parse_file_entry(
 			      && ( type_string[ 1 ] == (uint8_t) 'h' )
 			      && ( type_string[ 2 ] == (uint8_t) 'a' ) )
 			{
-				single_file_entry->sha1_hash = (uint8_t *) memory_allocate(
-				                                            sizeof( uint8_t ) * value_string_size );
-
-				if( single_file_entry->sha1_hash == NULL )
+				if( libewf_arena_allocate(
+				     arena,
+				     sizeof( uint8_t ) * value_string_size,
+				     (void **) &( single_file_entry->sha1_hash ),
+				     error ) != 1 )
 				{
 					libcerror_error_set(
 					 error,
@@ -1485,10 +2075,11 @@ int libewf_single_files_parse_file_entry(
 			else if( ( type_string[ 0 ] == (uint8_t) 'h' )
 			      && ( type_string[ 1 ] == (uint8_t) 'a' ) )
 			{
-				single_file_entry->md5_hash = (uint8_t *) memory_allocate(
-				                                           sizeof( uint8_t ) * value_string_size );
-
-				if( single_file_entry->md5_hash == NULL )
+				if( libewf_arena_allocate(
+				     arena,
+				     sizeof( uint8_t ) * value_string_size,
+				     (void **) &( single_file_entry->md5_hash ),
+				     error ) != 1 )
 				{
 					libcerror_error_set(
 					 error,
@@ -1640,10 +2231,11 @@ int libewf_single_files_parse_file_entry(
 			 */
 			if( type_string[ 0 ] == (uint8_t) 'n' )
 			{
-				single_file_entry->name = (uint8_t *) memory_allocate(
-								       sizeof( uint8_t ) * value_string_size );
-
-				if( single_file_entry->name == NULL )
+				if( libewf_arena_allocate(
+				     arena,
+				     sizeof( uint8_t ) * value_string_size,
+				     (void **) &( single_file_entry->name ),
+				     error ) != 1 )
 				{
 					libcerror_error_set(
 					 error,
@@ -1773,6 +2365,7 @@ int libewf_single_files_parse_file_entry(
 		     lines,
 		     line_index,
 		     types,
+		     arena,
 		     format,
 		     error ) != 1 )
 		{
@@ -1803,6 +2396,19 @@ int libewf_single_files_parse_file_entry(
 
 		number_of_sub_entries--;
 	}
+	if( libewf_single_file_tree_build_sub_nodes_index(
+	     parent_file_entry_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to build sub nodes index.",
+		 function );
+
+		goto on_error;
+	}
 	return( 1 );
 
 on_error:
@@ -2199,3 +2805,353 @@ on_error:
 	return( -1 );
 }
 
+/* Appends the data entries of the files of a file entry tree node and its sub nodes
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_files_append_data_entries(
+     libcdata_tree_node_t *file_entry_node,
+     libewf_single_files_data_entry_t **data_entries,
+     int *number_of_data_entries,
+     int *maximum_number_of_data_entries,
+     libcerror_error_t **error )
+{
+	libcdata_tree_node_t *sub_node                = NULL;
+	libewf_single_file_entry_t *single_file_entry = NULL;
+	void *reallocation                            = NULL;
+	static char *function                         = "libewf_single_files_append_data_entries";
+	int new_maximum_number_of_data_entries        = 0;
+	int number_of_sub_nodes                       = 0;
+	int sub_node_index                            = 0;
+
+	if( file_entry_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry node.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_data_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of data entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_data_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum number of data entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_tree_node_get_value(
+	     file_entry_node,
+	     (intptr_t **) &single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve value from file entry node.",
+		 function );
+
+		return( -1 );
+	}
+	if( single_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing single file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( single_file_entry->type == LIBEWF_FILE_ENTRY_TYPE_FILE )
+	 && ( single_file_entry->size > 0 ) )
+	{
+		if( *number_of_data_entries >= *maximum_number_of_data_entries )
+		{
+			if( *maximum_number_of_data_entries == 0 )
+			{
+				new_maximum_number_of_data_entries = 256;
+			}
+			else if( *maximum_number_of_data_entries <= ( INT32_MAX / 2 ) )
+			{
+				new_maximum_number_of_data_entries = *maximum_number_of_data_entries * 2;
+			}
+			else
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: invalid maximum number of data entries value exceeds maximum.",
+				 function );
+
+				return( -1 );
+			}
+			if( (size_t) new_maximum_number_of_data_entries > ( (size_t) SSIZE_MAX / sizeof( libewf_single_files_data_entry_t ) ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: invalid maximum number of data entries value exceeds maximum.",
+				 function );
+
+				return( -1 );
+			}
+			reallocation = memory_reallocate(
+			                *data_entries,
+			                sizeof( libewf_single_files_data_entry_t ) * new_maximum_number_of_data_entries );
+
+			if( reallocation == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize data entries.",
+				 function );
+
+				return( -1 );
+			}
+			*data_entries                   = (libewf_single_files_data_entry_t *) reallocation;
+			*maximum_number_of_data_entries = new_maximum_number_of_data_entries;
+		}
+		/* Sparse data that duplicates the data of another file is read from the duplicate data offset
+		 */
+		if( ( ( single_file_entry->flags & LIBEWF_FILE_ENTRY_FLAG_SPARSE_DATA ) != 0 )
+		 && ( single_file_entry->duplicate_data_offset >= 0 ) )
+		{
+			( *data_entries )[ *number_of_data_entries ].data_offset = single_file_entry->duplicate_data_offset;
+		}
+		else
+		{
+			( *data_entries )[ *number_of_data_entries ].data_offset = single_file_entry->data_offset;
+		}
+		( *data_entries )[ *number_of_data_entries ].file_entry_node = file_entry_node;
+
+		*number_of_data_entries += 1;
+	}
+	if( libcdata_tree_node_get_number_of_sub_nodes(
+	     file_entry_node,
+	     &number_of_sub_nodes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sub nodes.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_sub_nodes == 0 )
+	{
+		return( 1 );
+	}
+	if( libcdata_tree_node_get_first_sub_node(
+	     file_entry_node,
+	     &sub_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve first sub node.",
+		 function );
+
+		return( -1 );
+	}
+	for( sub_node_index = 0;
+	     sub_node_index < number_of_sub_nodes;
+	     sub_node_index++ )
+	{
+		if( libewf_single_files_append_data_entries(
+		     sub_node,
+		     data_entries,
+		     number_of_data_entries,
+		     maximum_number_of_data_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append data entries of sub node: %d.",
+			 function,
+			 sub_node_index );
+
+			return( -1 );
+		}
+		if( libcdata_tree_node_get_next_node(
+		     sub_node,
+		     &sub_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next node from sub node: %d.",
+			 function,
+			 sub_node_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Compares two data entries by their data offset
+ * The function is used with qsort
+ * Returns -1 if the first is less than, 0 if equal to or 1 if greater than the second
+ */
+int libewf_single_files_data_entry_compare(
+     const void *first_data_entry,
+     const void *second_data_entry )
+{
+	const libewf_single_files_data_entry_t *first_entry  = (const libewf_single_files_data_entry_t *) first_data_entry;
+	const libewf_single_files_data_entry_t *second_entry = (const libewf_single_files_data_entry_t *) second_data_entry;
+
+	if( first_entry->data_offset < second_entry->data_offset )
+	{
+		return( -1 );
+	}
+	else if( first_entry->data_offset > second_entry->data_offset )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Retrieves the data entries of the files sorted by their data offset
+ * Files without data are not included
+ * The data entries are allocated and must be freed by the caller
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_files_get_data_entries(
+     libewf_single_files_t *single_files,
+     libewf_single_files_data_entry_t **data_entries,
+     int *number_of_data_entries,
+     libcerror_error_t **error )
+{
+	libewf_single_files_data_entry_t *safe_data_entries = NULL;
+	static char *function                               = "libewf_single_files_get_data_entries";
+	int maximum_number_of_data_entries                  = 0;
+	int safe_number_of_data_entries                     = 0;
+
+	if( single_files == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid single files.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( *data_entries != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid data entries value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_data_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of data entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( single_files->root_file_entry_node != NULL )
+	{
+		if( libewf_single_files_append_data_entries(
+		     single_files->root_file_entry_node,
+		     &safe_data_entries,
+		     &safe_number_of_data_entries,
+		     &maximum_number_of_data_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append data entries.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( safe_number_of_data_entries > 1 )
+	{
+		qsort(
+		 safe_data_entries,
+		 (size_t) safe_number_of_data_entries,
+		 sizeof( libewf_single_files_data_entry_t ),
+		 &libewf_single_files_data_entry_compare );
+	}
+	*data_entries           = safe_data_entries;
+	*number_of_data_entries = safe_number_of_data_entries;
+
+	return( 1 );
+
+on_error:
+	if( safe_data_entries != NULL )
+	{
+		memory_free(
+		 safe_data_entries );
+	}
+	return( -1 );
+}
+
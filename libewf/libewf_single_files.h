@@ -27,8 +27,10 @@
 
 #include "libewf_extern.h"
 #include "libewf_libcdata.h"
+#include "libewf_arena.h"
 #include "libewf_libcerror.h"
 #include "libewf_libfvalue.h"
+#include "libewf_libhmac.h"
 #include "libewf_single_file_entry.h"
 #include "libewf_types.h"
 
@@ -36,6 +38,21 @@
 extern "C" {
 #endif
 
+typedef struct libewf_single_files_data_entry libewf_single_files_data_entry_t;
+
+/* The data offset of a file in the single file entry tree
+ */
+struct libewf_single_files_data_entry
+{
+	/* The (media) data offset
+	 */
+	off64_t data_offset;
+
+	/* The file entry node
+	 */
+	libcdata_tree_node_t *file_entry_node;
+};
+
 typedef struct libewf_single_files libewf_single_files_t;
 
 struct libewf_single_files
@@ -48,6 +65,10 @@ struct libewf_single_files
 	 */
 	size_t section_data_size;
 
+	/* The allocated size of the section data, used when ltree data is appended for writing
+	 */
+	size_t section_data_allocated_size;
+
 	/* The ltree data
 	 */
 	uint8_t *ltree_data;
@@ -56,9 +77,35 @@ struct libewf_single_files
 	 */
 	size_t ltree_data_size;
 
+	/* Value to indicate the ltree data was parsed
+	 */
+	uint8_t ltree_is_parsed;
+
+	/* The MD5 context of the ltree data, which is updated when ltree data is appended for writing
+	 */
+	libhmac_md5_context_t *ltree_md5_context;
+
+	/* The MD5 hash of the ltree data
+	 */
+	uint8_t ltree_md5_hash[ LIBHMAC_MD5_HASH_SIZE ];
+
+	/* Value to indicate the MD5 hash of the ltree data was finalized
+	 */
+	uint8_t ltree_md5_hash_is_set;
+
 	/* The single file entry tree
 	 */
 	libcdata_tree_node_t *root_file_entry_node;
+
+	/* The arena in which the single file entries are allocated
+	 */
+	libewf_arena_t *arena;
+
+#if defined( HAVE_LIBEWF_MEMORY_ACCOUNTING )
+	/* The size of the memory accounted for the single files
+	 */
+	size_t accounted_memory_size;
+#endif
 };
 
 int libewf_single_files_initialize(
@@ -69,6 +116,26 @@ int libewf_single_files_free(
      libewf_single_files_t **single_files,
      libcerror_error_t **error );
 
+#if defined( HAVE_LIBEWF_MEMORY_ACCOUNTING )
+
+int libewf_single_files_update_memory_accounting(
+     libewf_single_files_t *single_files,
+     libcerror_error_t **error );
+
+#endif
+
+int libewf_single_files_append_utf8_ltree_data(
+     libewf_single_files_t *single_files,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libcerror_error_t **error );
+
+int libewf_single_files_get_ltree_integrity_hash(
+     libewf_single_files_t *single_files,
+     uint8_t *integrity_hash,
+     size_t integrity_hash_size,
+     libcerror_error_t **error );
+
 int libewf_single_files_parse(
      libewf_single_files_t *single_files,
      size64_t *media_size,
@@ -83,6 +150,13 @@ int libewf_single_files_parse_file_entries(
      uint8_t *format,
      libcerror_error_t **error );
 
+int libewf_single_files_parse_lines(
+     libewf_single_files_t *single_files,
+     size64_t *media_size,
+     libfvalue_split_utf8_string_t *lines,
+     uint8_t *format,
+     libcerror_error_t **error );
+
 int libewf_single_files_parse_record_values(
      size64_t *media_size,
      libfvalue_split_utf8_string_t *lines,
@@ -94,6 +168,7 @@ int libewf_single_files_parse_file_entry(
      libfvalue_split_utf8_string_t *lines,
      int *line_iterator,
      libfvalue_split_utf8_string_t *types,
+     libewf_arena_t *arena,
      uint8_t *format,
      libcerror_error_t **error );
 
@@ -109,6 +184,23 @@ int libewf_single_files_parse_file_entry_offset_values(
      size_t offset_values_string_size,
      libcerror_error_t **error );
 
+int libewf_single_files_append_data_entries(
+     libcdata_tree_node_t *file_entry_node,
+     libewf_single_files_data_entry_t **data_entries,
+     int *number_of_data_entries,
+     int *maximum_number_of_data_entries,
+     libcerror_error_t **error );
+
+int libewf_single_files_data_entry_compare(
+     const void *first_data_entry,
+     const void *second_data_entry );
+
+int libewf_single_files_get_data_entries(
+     libewf_single_files_t *single_files,
+     libewf_single_files_data_entry_t **data_entries,
+     int *number_of_data_entries,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
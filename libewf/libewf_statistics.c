@@ -0,0 +1,831 @@
+/*
+ * Statistics functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include <time.h>
+
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_statistics.h"
+
+/* Creates statistics
+ * Make sure the value statistics is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_statistics_initialize(
+     libewf_statistics_t **statistics,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_statistics_initialize";
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( *statistics != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid statistics value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*statistics = memory_allocate_structure(
+	               libewf_statistics_t );
+
+	if( *statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create statistics.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *statistics,
+	     0,
+	     sizeof( libewf_statistics_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear statistics.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *statistics )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *statistics != NULL )
+	{
+		memory_free(
+		 *statistics );
+
+		*statistics = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees statistics
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_statistics_free(
+     libewf_statistics_t **statistics,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_statistics_free";
+	int result            = 1;
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( *statistics != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *statistics )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *statistics );
+
+		*statistics = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves a monotonic timestamp in nano seconds that is used to measure elapsed times
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_statistics_get_timestamp(
+     int64_t *timestamp,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	struct timespec time_structure;
+#endif
+
+	static char *function = "libewf_statistics_get_timestamp";
+
+	if( timestamp == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid timestamp.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_structure ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time structure.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = ( (int64_t) time_structure.tv_sec * 1000000000 ) + time_structure.tv_nsec;
+#else
+	*timestamp = (int64_t) time( NULL );
+
+	if( *timestamp == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp *= 1000000000;
+#endif
+	return( 1 );
+}
+
+/* Increments the counter and adds a value and the time elapsed since the start timestamp
+ * to the corresponding counters, the value and time counters are optional
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_statistics_add_to_counters(
+     libewf_statistics_t *statistics,
+     uint64_t *counter,
+     uint64_t *value_counter,
+     uint64_t value,
+     uint64_t *time_counter,
+     int64_t start_timestamp,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_statistics_add_to_counters";
+	int64_t elapsed_time  = 0;
+	int64_t end_timestamp = 0;
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( counter == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid counter.",
+		 function );
+
+		return( -1 );
+	}
+	if( time_counter != NULL )
+	{
+		if( libewf_statistics_get_timestamp(
+		     &end_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve end timestamp.",
+			 function );
+
+			return( -1 );
+		}
+		/* The timestamp can go back if the fallback clock was adjusted
+		 */
+		if( end_timestamp > start_timestamp )
+		{
+			elapsed_time = end_timestamp - start_timestamp;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     statistics->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*counter += 1;
+
+	if( value_counter != NULL )
+	{
+		*value_counter += value;
+	}
+	if( time_counter != NULL )
+	{
+		*time_counter += (uint64_t) elapsed_time;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     statistics->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Adds a read of chunk data from a segment file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_statistics_add_segment_file_read(
+     libewf_statistics_t *statistics,
+     size_t read_size,
+     int64_t start_timestamp,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_statistics_add_segment_file_read";
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_statistics_add_to_counters(
+	     statistics,
+	     &( statistics->segment_file_number_of_reads ),
+	     &( statistics->segment_file_read_size ),
+	     (uint64_t) read_size,
+	     &( statistics->segment_file_read_time ),
+	     start_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to add read to counters.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Adds a decompressed chunk
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_statistics_add_decompression(
+     libewf_statistics_t *statistics,
+     int64_t start_timestamp,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_statistics_add_decompression";
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_statistics_add_to_counters(
+	     statistics,
+	     &( statistics->number_of_decompressed_chunks ),
+	     NULL,
+	     0,
+	     &( statistics->decompression_time ),
+	     start_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to add decompression to counters.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Adds a verified chunk checksum
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_statistics_add_checksum_verification(
+     libewf_statistics_t *statistics,
+     int64_t start_timestamp,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_statistics_add_checksum_verification";
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_statistics_add_to_counters(
+	     statistics,
+	     &( statistics->number_of_verified_checksums ),
+	     NULL,
+	     0,
+	     &( statistics->checksum_time ),
+	     start_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to add checksum verification to counters.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Adds a synchronization of a segment file with the storage
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_statistics_add_segment_file_sync(
+     libewf_statistics_t *statistics,
+     int64_t start_timestamp,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_statistics_add_segment_file_sync";
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_statistics_add_to_counters(
+	     statistics,
+	     &( statistics->segment_file_number_of_syncs ),
+	     NULL,
+	     0,
+	     &( statistics->segment_file_sync_time ),
+	     start_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to add sync to counters.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Adds a cache lookup
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_statistics_add_cache_lookup(
+     libewf_statistics_t *statistics,
+     int cache_type,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_statistics_add_cache_lookup";
+	uint64_t *counter     = NULL;
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	switch( cache_type )
+	{
+		case LIBEWF_STATISTICS_CACHE_TYPE_CHUNKS:
+			counter = &( statistics->chunks_cache_number_of_lookups );
+			break;
+
+		case LIBEWF_STATISTICS_CACHE_TYPE_CHUNK_GROUPS:
+			counter = &( statistics->chunk_groups_cache_number_of_lookups );
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported cache type.",
+			 function );
+
+			return( -1 );
+	}
+	if( libewf_statistics_add_to_counters(
+	     statistics,
+	     counter,
+	     NULL,
+	     0,
+	     NULL,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to add cache lookup to counters.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Adds a cache miss
+ * A cache miss is expected to follow the corresponding cache lookup
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_statistics_add_cache_miss(
+     libewf_statistics_t *statistics,
+     int cache_type,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_statistics_add_cache_miss";
+	uint64_t *counter     = NULL;
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	switch( cache_type )
+	{
+		case LIBEWF_STATISTICS_CACHE_TYPE_CHUNKS:
+			counter = &( statistics->chunks_cache_number_of_misses );
+			break;
+
+		case LIBEWF_STATISTICS_CACHE_TYPE_CHUNK_GROUPS:
+			counter = &( statistics->chunk_groups_cache_number_of_misses );
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported cache type.",
+			 function );
+
+			return( -1 );
+	}
+	if( libewf_statistics_add_to_counters(
+	     statistics,
+	     counter,
+	     NULL,
+	     0,
+	     NULL,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to add cache miss to counters.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves a specific statistic value
+ * The values of the sharded chunk cache are not maintained by the statistics
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libewf_statistics_get_value(
+     libewf_statistics_t *statistics,
+     int statistic_type,
+     uint64_t *value,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_statistics_get_value";
+	uint64_t safe_value   = 0;
+	int result            = 1;
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     statistics->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	switch( statistic_type )
+	{
+		case LIBEWF_STATISTIC_SEGMENT_FILE_READ_SIZE:
+			safe_value = statistics->segment_file_read_size;
+			break;
+
+		case LIBEWF_STATISTIC_SEGMENT_FILE_NUMBER_OF_READS:
+			safe_value = statistics->segment_file_number_of_reads;
+			break;
+
+		case LIBEWF_STATISTIC_SEGMENT_FILE_READ_TIME:
+			safe_value = statistics->segment_file_read_time;
+			break;
+
+		case LIBEWF_STATISTIC_NUMBER_OF_DECOMPRESSED_CHUNKS:
+			safe_value = statistics->number_of_decompressed_chunks;
+			break;
+
+		case LIBEWF_STATISTIC_DECOMPRESSION_TIME:
+			safe_value = statistics->decompression_time;
+			break;
+
+		case LIBEWF_STATISTIC_NUMBER_OF_VERIFIED_CHECKSUMS:
+			safe_value = statistics->number_of_verified_checksums;
+			break;
+
+		case LIBEWF_STATISTIC_CHECKSUM_TIME:
+			safe_value = statistics->checksum_time;
+			break;
+
+		case LIBEWF_STATISTIC_SEGMENT_FILE_NUMBER_OF_SYNCS:
+			safe_value = statistics->segment_file_number_of_syncs;
+			break;
+
+		case LIBEWF_STATISTIC_SEGMENT_FILE_SYNC_TIME:
+			safe_value = statistics->segment_file_sync_time;
+			break;
+
+		/* The hits are derived from the lookups since only the misses
+		 * are known where the cached value is read
+		 */
+		case LIBEWF_STATISTIC_CHUNKS_CACHE_HITS:
+			if( statistics->chunks_cache_number_of_lookups > statistics->chunks_cache_number_of_misses )
+			{
+				safe_value = statistics->chunks_cache_number_of_lookups - statistics->chunks_cache_number_of_misses;
+			}
+			break;
+
+		case LIBEWF_STATISTIC_CHUNKS_CACHE_MISSES:
+			safe_value = statistics->chunks_cache_number_of_misses;
+			break;
+
+		case LIBEWF_STATISTIC_CHUNK_GROUPS_CACHE_HITS:
+			if( statistics->chunk_groups_cache_number_of_lookups > statistics->chunk_groups_cache_number_of_misses )
+			{
+				safe_value = statistics->chunk_groups_cache_number_of_lookups - statistics->chunk_groups_cache_number_of_misses;
+			}
+			break;
+
+		case LIBEWF_STATISTIC_CHUNK_GROUPS_CACHE_MISSES:
+			safe_value = statistics->chunk_groups_cache_number_of_misses;
+			break;
+
+		default:
+			result = 0;
+			break;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     statistics->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( result == 1 )
+	{
+		*value = safe_value;
+	}
+	return( result );
+}
+
+/* Resets the statistics
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_statistics_reset(
+     libewf_statistics_t *statistics,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_statistics_reset";
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     statistics->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	statistics->segment_file_read_size               = 0;
+	statistics->segment_file_number_of_reads         = 0;
+	statistics->segment_file_read_time               = 0;
+	statistics->number_of_decompressed_chunks        = 0;
+	statistics->decompression_time                   = 0;
+	statistics->number_of_verified_checksums         = 0;
+	statistics->checksum_time                        = 0;
+	statistics->segment_file_number_of_syncs         = 0;
+	statistics->segment_file_sync_time               = 0;
+	statistics->chunks_cache_number_of_lookups       = 0;
+	statistics->chunks_cache_number_of_misses        = 0;
+	statistics->chunk_groups_cache_number_of_lookups = 0;
+	statistics->chunk_groups_cache_number_of_misses  = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     statistics->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
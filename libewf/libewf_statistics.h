@@ -0,0 +1,173 @@
+/*
+ * Statistics functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_STATISTICS_H )
+#define _LIBEWF_STATISTICS_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The caches of which the lookups are counted
+ */
+enum LIBEWF_STATISTICS_CACHE_TYPES
+{
+	LIBEWF_STATISTICS_CACHE_TYPE_CHUNKS		= 1,
+	LIBEWF_STATISTICS_CACHE_TYPE_CHUNK_GROUPS	= 2
+};
+
+typedef struct libewf_statistics libewf_statistics_t;
+
+struct libewf_statistics
+{
+	/* The number of bytes read from the segment files
+	 */
+	uint64_t segment_file_read_size;
+
+	/* The number of reads from the segment files
+	 */
+	uint64_t segment_file_number_of_reads;
+
+	/* The time spent reading from the segment files in nano seconds
+	 */
+	uint64_t segment_file_read_time;
+
+	/* The number of decompressed chunks
+	 */
+	uint64_t number_of_decompressed_chunks;
+
+	/* The time spent decompressing chunks in nano seconds
+	 */
+	uint64_t decompression_time;
+
+	/* The number of verified chunk checksums
+	 */
+	uint64_t number_of_verified_checksums;
+
+	/* The time spent verifying chunk checksums in nano seconds
+	 */
+	uint64_t checksum_time;
+
+	/* The number of synchronizations of the segment files with the storage
+	 */
+	uint64_t segment_file_number_of_syncs;
+
+	/* The time spent synchronizing the segment files with the storage in nano seconds
+	 */
+	uint64_t segment_file_sync_time;
+
+	/* The number of chunks cache lookups
+	 */
+	uint64_t chunks_cache_number_of_lookups;
+
+	/* The number of chunks cache misses
+	 */
+	uint64_t chunks_cache_number_of_misses;
+
+	/* The number of chunk groups cache lookups
+	 */
+	uint64_t chunk_groups_cache_number_of_lookups;
+
+	/* The number of chunk groups cache misses
+	 */
+	uint64_t chunk_groups_cache_number_of_misses;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The mutex that protects the counters
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libewf_statistics_initialize(
+     libewf_statistics_t **statistics,
+     libcerror_error_t **error );
+
+int libewf_statistics_free(
+     libewf_statistics_t **statistics,
+     libcerror_error_t **error );
+
+int libewf_statistics_get_timestamp(
+     int64_t *timestamp,
+     libcerror_error_t **error );
+
+int libewf_statistics_add_to_counters(
+     libewf_statistics_t *statistics,
+     uint64_t *counter,
+     uint64_t *value_counter,
+     uint64_t value,
+     uint64_t *time_counter,
+     int64_t start_timestamp,
+     libcerror_error_t **error );
+
+int libewf_statistics_add_segment_file_read(
+     libewf_statistics_t *statistics,
+     size_t read_size,
+     int64_t start_timestamp,
+     libcerror_error_t **error );
+
+int libewf_statistics_add_decompression(
+     libewf_statistics_t *statistics,
+     int64_t start_timestamp,
+     libcerror_error_t **error );
+
+int libewf_statistics_add_checksum_verification(
+     libewf_statistics_t *statistics,
+     int64_t start_timestamp,
+     libcerror_error_t **error );
+
+int libewf_statistics_add_segment_file_sync(
+     libewf_statistics_t *statistics,
+     int64_t start_timestamp,
+     libcerror_error_t **error );
+
+int libewf_statistics_add_cache_lookup(
+     libewf_statistics_t *statistics,
+     int cache_type,
+     libcerror_error_t **error );
+
+int libewf_statistics_add_cache_miss(
+     libewf_statistics_t *statistics,
+     int cache_type,
+     libcerror_error_t **error );
+
+int libewf_statistics_get_value(
+     libewf_statistics_t *statistics,
+     int statistic_type,
+     uint64_t *value,
+     libcerror_error_t **error );
+
+int libewf_statistics_reset(
+     libewf_statistics_t *statistics,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_STATISTICS_H ) */
+
@@ -26,6 +26,7 @@
 #include <wide_string.h>
 
 #include "libewf_definitions.h"
+#include "libewf_directory_listing.h"
 #include "libewf_filename.h"
 #include "libewf_error.h"
 #include "libewf_libbfio.h"
@@ -513,16 +514,19 @@ int libewf_glob(
      int *number_of_filenames,
      libcerror_error_t **error )
 {
-	libbfio_handle_t *file_io_handle = NULL;
-	char *segment_filename           = NULL;
-	void *reallocation               = NULL;
-	static char *function            = "libewf_glob";
-	size_t additional_length         = 0;
-	size_t segment_extention_length  = 0;
-	size_t segment_filename_index    = 0;
-	size_t segment_filename_length   = 0;
-	uint8_t segment_file_type        = 0;
-	int result                       = 0;
+	libbfio_handle_t *file_io_handle              = NULL;
+	libewf_directory_listing_t *directory_listing = NULL;
+	char *segment_filename                        = NULL;
+	void *reallocation                            = NULL;
+	static char *function                         = "libewf_glob";
+	size_t additional_length                      = 0;
+	size_t path_prefix_length                     = 0;
+	size_t segment_extention_length               = 0;
+	size_t segment_filename_index                 = 0;
+	size_t segment_filename_length                = 0;
+	uint8_t segment_file_type                     = 0;
+	int number_of_allocated_filenames             = 0;
+	int result                                    = 0;
 
 	if( filename == NULL )
 	{
@@ -721,6 +725,65 @@ int libewf_glob(
 			segment_file_type = LIBEWF_SEGMENT_FILE_TYPE_EWF1;
 		}
 	}
+	/* Read the names of the segment files in the directory once instead of
+	 * testing if every segment file exists, which requires a round-trip per
+	 * segment file on a network share. If the directory cannot be listed
+	 * the existence of every segment file is tested instead.
+	 */
+	if( additional_length == 0 )
+	{
+		path_prefix_length = filename_length - segment_extention_length;
+	}
+	else
+	{
+		path_prefix_length = filename_length;
+	}
+	if( libewf_directory_listing_initialize(
+	     &directory_listing,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create directory listing.",
+		 function );
+
+		goto on_error;
+	}
+	result = libewf_directory_listing_read(
+	          directory_listing,
+	          filename,
+	          path_prefix_length,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read directory listing.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		if( libewf_directory_listing_free(
+		     &directory_listing,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free directory listing.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( libbfio_file_initialize(
 	     &file_io_handle,
 	     error ) != 1 )
@@ -814,9 +877,38 @@ int libewf_glob(
 
 			goto on_error;
 		}
-		result = libbfio_handle_exists(
-		          file_io_handle,
-		          error );
+		result = 0;
+
+		if( directory_listing != NULL )
+		{
+			result = libewf_directory_listing_has_entry(
+			          directory_listing,
+			          segment_filename,
+			          narrow_string_length(
+			           segment_filename ),
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if directory listing contains segment file.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		/* A segment file that is not in the directory listing is confirmed by testing
+		 * if it exists, e.g. the file system could resolve names case-insensitive
+		 */
+		if( result == 0 )
+		{
+			result = libbfio_handle_exists(
+			          file_io_handle,
+			          error );
+		}
 
 		if( result == -1 )
 		{
@@ -834,28 +926,42 @@ int libewf_glob(
 			memory_free(
 			 segment_filename );
 
+			segment_filename = NULL;
+
 			break;
 		}
-		*number_of_filenames += 1;
-
-		reallocation = memory_reallocate(
-		                *filenames,
-		                sizeof( char * ) * *number_of_filenames );
-
-		if( reallocation == NULL )
+		if( *number_of_filenames >= number_of_allocated_filenames )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-			 "%s: unable to resize filenames.",
-			 function );
+			if( number_of_allocated_filenames == 0 )
+			{
+				number_of_allocated_filenames = 16;
+			}
+			else
+			{
+				number_of_allocated_filenames *= 2;
+			}
+			reallocation = memory_reallocate(
+			                *filenames,
+			                sizeof( char * ) * number_of_allocated_filenames );
 
-			goto on_error;
+			if( reallocation == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize filenames.",
+				 function );
+
+				goto on_error;
+			}
+			*filenames = (char **) reallocation;
 		}
-		*filenames = (char **) reallocation;
+		( *filenames )[ *number_of_filenames ] = segment_filename;
+
+		segment_filename = NULL;
 
-		( *filenames )[ *number_of_filenames - 1 ] = segment_filename;
+		*number_of_filenames += 1;
 	}
 	if( libbfio_handle_free(
 	     &file_io_handle,
@@ -870,6 +976,22 @@ int libewf_glob(
 
 		goto on_error;
 	}
+	if( directory_listing != NULL )
+	{
+		if( libewf_directory_listing_free(
+		     &directory_listing,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free directory listing.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	return( 1 );
 
 on_error:
@@ -884,6 +1006,12 @@ on_error:
 		 &file_io_handle,
 		 NULL );
 	}
+	if( directory_listing != NULL )
+	{
+		libewf_directory_listing_free(
+		 &directory_listing,
+		 NULL );
+	}
 	return( -1 );
 }
 
@@ -950,16 +1078,19 @@ int libewf_glob_wide(
      int *number_of_filenames,
      libcerror_error_t **error )
 {
-	libbfio_handle_t *file_io_handle = NULL;
-	wchar_t *segment_filename        = NULL;
-	void *reallocation               = NULL;
-	static char *function            = "libewf_glob_wide";
-	size_t additional_length         = 0;
-	size_t segment_extention_length  = 0;
-	size_t segment_filename_index    = 0;
-	size_t segment_filename_length   = 0;
-	int result                       = 0;
-	uint8_t segment_file_type        = 0;
+	libbfio_handle_t *file_io_handle              = NULL;
+	libewf_directory_listing_t *directory_listing = NULL;
+	wchar_t *segment_filename                     = NULL;
+	void *reallocation                            = NULL;
+	static char *function                         = "libewf_glob_wide";
+	size_t additional_length                      = 0;
+	size_t path_prefix_length                     = 0;
+	size_t segment_extention_length               = 0;
+	size_t segment_filename_index                 = 0;
+	size_t segment_filename_length                = 0;
+	uint8_t segment_file_type                     = 0;
+	int number_of_allocated_filenames             = 0;
+	int result                                    = 0;
 
 	if( filename == NULL )
 	{
@@ -1158,6 +1289,65 @@ int libewf_glob_wide(
 			segment_file_type = LIBEWF_SEGMENT_FILE_TYPE_EWF1;
 		}
 	}
+	/* Read the names of the segment files in the directory once instead of
+	 * testing if every segment file exists, which requires a round-trip per
+	 * segment file on a network share. If the directory cannot be listed
+	 * the existence of every segment file is tested instead.
+	 */
+	if( additional_length == 0 )
+	{
+		path_prefix_length = filename_length - segment_extention_length;
+	}
+	else
+	{
+		path_prefix_length = filename_length;
+	}
+	if( libewf_directory_listing_initialize(
+	     &directory_listing,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create directory listing.",
+		 function );
+
+		goto on_error;
+	}
+	result = libewf_directory_listing_read_wide(
+	          directory_listing,
+	          filename,
+	          path_prefix_length,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read directory listing.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		if( libewf_directory_listing_free(
+		     &directory_listing,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free directory listing.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( libbfio_file_initialize(
 	     &file_io_handle,
 	     error ) != 1 )
@@ -1251,9 +1441,38 @@ int libewf_glob_wide(
 
 			goto on_error;
 		}
-		result = libbfio_handle_exists(
-		          file_io_handle,
-		          error );
+		result = 0;
+
+		if( directory_listing != NULL )
+		{
+			result = libewf_directory_listing_has_entry_wide(
+			          directory_listing,
+			          segment_filename,
+			          wide_string_length(
+			           segment_filename ),
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if directory listing contains segment file.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		/* A segment file that is not in the directory listing is confirmed by testing
+		 * if it exists, e.g. the file system could resolve names case-insensitive
+		 */
+		if( result == 0 )
+		{
+			result = libbfio_handle_exists(
+			          file_io_handle,
+			          error );
+		}
 
 		if( result == -1 )
 		{
@@ -1271,28 +1490,42 @@ int libewf_glob_wide(
 			memory_free(
 			 segment_filename );
 
+			segment_filename = NULL;
+
 			break;
 		}
-		*number_of_filenames += 1;
-
-		reallocation = memory_reallocate(
-		                *filenames,
-		                sizeof( wchar_t * ) * *number_of_filenames );
-
-		if( reallocation == NULL )
+		if( *number_of_filenames >= number_of_allocated_filenames )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-			 "%s: unable to resize filenames.",
-			 function );
+			if( number_of_allocated_filenames == 0 )
+			{
+				number_of_allocated_filenames = 16;
+			}
+			else
+			{
+				number_of_allocated_filenames *= 2;
+			}
+			reallocation = memory_reallocate(
+			                *filenames,
+			                sizeof( wchar_t * ) * number_of_allocated_filenames );
 
-			goto on_error;
+			if( reallocation == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize filenames.",
+				 function );
+
+				goto on_error;
+			}
+			*filenames = (wchar_t **) reallocation;
 		}
-		*filenames = (wchar_t **) reallocation;
+		( *filenames )[ *number_of_filenames ] = segment_filename;
+
+		segment_filename = NULL;
 
-		( *filenames )[ *number_of_filenames - 1 ] = segment_filename;
+		*number_of_filenames += 1;
 	}
 	if( libbfio_handle_free(
 	     &file_io_handle,
@@ -1307,6 +1540,22 @@ int libewf_glob_wide(
 
 		goto on_error;
 	}
+	if( directory_listing != NULL )
+	{
+		if( libewf_directory_listing_free(
+		     &directory_listing,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free directory listing.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	return( 1 );
 
 on_error:
@@ -1321,6 +1570,12 @@ on_error:
 		 &file_io_handle,
 		 NULL );
 	}
+	if( directory_listing != NULL )
+	{
+		libewf_directory_listing_free(
+		 &directory_listing,
+		 NULL );
+	}
 	return( -1 );
 }
 
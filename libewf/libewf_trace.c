@@ -0,0 +1,56 @@
+/*
+ * Static tracepoints
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_trace.h"
+
+#if defined( HAVE_LIBEWF_TRACE_PROVIDER )
+
+/* The libewf TraceLogging provider {5b0a5e23-0b5e-4d4f-9d6e-3b1f0f1c7e21}
+ */
+TRACELOGGING_DEFINE_PROVIDER(
+ libewf_trace_provider,
+ "libewf",
+ ( 0x5b0a5e23, 0x0b5e, 0x4d4f, 0x9d, 0x6e, 0x3b, 0x1f, 0x0f, 0x1c, 0x7e, 0x21 ) );
+
+/* Registers the TraceLogging provider
+ * Events written before the provider is registered are discarded
+ */
+void libewf_trace_register(
+      void )
+{
+	TraceLoggingRegister(
+	 libewf_trace_provider );
+}
+
+/* Unregisters the TraceLogging provider
+ */
+void libewf_trace_unregister(
+      void )
+{
+	TraceLoggingUnregister(
+	 libewf_trace_provider );
+}
+
+#endif /* defined( HAVE_LIBEWF_TRACE_PROVIDER ) */
+
@@ -0,0 +1,168 @@
+/*
+ * Static tracepoints
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_TRACE_H )
+#define _LIBEWF_TRACE_H
+
+#include <common.h>
+#include <types.h>
+
+/* The tracepoints are USDT probes of the libewf provider when built with --enable-tracepoints
+ * or TraceLogging (ETW) events of the libewf provider when HAVE_LIBEWF_TRACEPOINTS and
+ * HAVE_TRACELOGGING are defined on Windows. Otherwise the tracepoints are compiled out.
+ *
+ * Double underscores in the probe names are shown as dashes by the USDT tools, e.g.
+ * bpftrace -e 'usdt:/usr/lib/libewf.so:libewf:chunk-read-end { @[arg0] = sum(arg2); }'
+ */
+#if defined( HAVE_LIBEWF_TRACEPOINTS ) && defined( HAVE_SYS_SDT_H )
+
+#include <sys/sdt.h>
+
+#define LIBEWF_TRACE_PROBE1( name, value1 ) \
+	DTRACE_PROBE1( libewf, name, value1 )
+
+#define LIBEWF_TRACE_PROBE2( name, value1, value2 ) \
+	DTRACE_PROBE2( libewf, name, value1, value2 )
+
+#define LIBEWF_TRACE_PROBE3( name, value1, value2, value3 ) \
+	DTRACE_PROBE3( libewf, name, value1, value2, value3 )
+
+#elif defined( HAVE_LIBEWF_TRACEPOINTS ) && defined( WINAPI ) && defined( HAVE_TRACELOGGING )
+
+#include <windows.h>
+#include <TraceLoggingProvider.h>
+
+TRACELOGGING_DECLARE_PROVIDER(
+ libewf_trace_provider );
+
+#define LIBEWF_TRACE_PROBE1( name, value1 ) \
+	TraceLoggingWrite( \
+	 libewf_trace_provider, \
+	 #name, \
+	 TraceLoggingUInt64( (UINT64) ( value1 ), "value1" ) )
+
+#define LIBEWF_TRACE_PROBE2( name, value1, value2 ) \
+	TraceLoggingWrite( \
+	 libewf_trace_provider, \
+	 #name, \
+	 TraceLoggingUInt64( (UINT64) ( value1 ), "value1" ), \
+	 TraceLoggingUInt64( (UINT64) ( value2 ), "value2" ) )
+
+#define LIBEWF_TRACE_PROBE3( name, value1, value2, value3 ) \
+	TraceLoggingWrite( \
+	 libewf_trace_provider, \
+	 #name, \
+	 TraceLoggingUInt64( (UINT64) ( value1 ), "value1" ), \
+	 TraceLoggingUInt64( (UINT64) ( value2 ), "value2" ), \
+	 TraceLoggingUInt64( (UINT64) ( value3 ), "value3" ) )
+
+#define HAVE_LIBEWF_TRACE_PROVIDER
+
+#else
+
+#define LIBEWF_TRACE_PROBE1( name, value1 ) \
+	do { } while( 0 )
+
+#define LIBEWF_TRACE_PROBE2( name, value1, value2 ) \
+	do { } while( 0 )
+
+#define LIBEWF_TRACE_PROBE3( name, value1, value2, value3 ) \
+	do { } while( 0 )
+
+#endif
+
+/* Chunk data is read from a segment file
+ * Arguments: file IO pool entry, offset, size or read count
+ */
+#define LIBEWF_TRACE_CHUNK_READ_START( file_io_pool_entry, offset, size ) \
+	LIBEWF_TRACE_PROBE3( chunk__read__start, file_io_pool_entry, offset, size )
+
+#define LIBEWF_TRACE_CHUNK_READ_END( file_io_pool_entry, offset, read_count ) \
+	LIBEWF_TRACE_PROBE3( chunk__read__end, file_io_pool_entry, offset, read_count )
+
+/* Chunk data is decompressed
+ * Arguments: compressed data size and, at the end, the decompressed data size
+ */
+#define LIBEWF_TRACE_DECOMPRESS_START( compressed_data_size ) \
+	LIBEWF_TRACE_PROBE1( decompress__start, compressed_data_size )
+
+#define LIBEWF_TRACE_DECOMPRESS_END( compressed_data_size, data_size ) \
+	LIBEWF_TRACE_PROBE2( decompress__end, compressed_data_size, data_size )
+
+/* The chunks cache of a handle is looked up, a miss is followed by a chunk read
+ * Arguments: storage media offset or file IO pool entry and offset
+ */
+#define LIBEWF_TRACE_CHUNKS_CACHE_LOOKUP( offset ) \
+	LIBEWF_TRACE_PROBE1( chunks__cache__lookup, offset )
+
+#define LIBEWF_TRACE_CHUNKS_CACHE_MISS( file_io_pool_entry, offset ) \
+	LIBEWF_TRACE_PROBE2( chunks__cache__miss, file_io_pool_entry, offset )
+
+/* The sharded chunk cache is looked up
+ * Arguments: chunk index
+ */
+#define LIBEWF_TRACE_CHUNK_CACHE_HIT( chunk_index ) \
+	LIBEWF_TRACE_PROBE1( chunk__cache__hit, chunk_index )
+
+#define LIBEWF_TRACE_CHUNK_CACHE_MISS( chunk_index ) \
+	LIBEWF_TRACE_PROBE1( chunk__cache__miss, chunk_index )
+
+/* A segment file is opened (read into or created in the segment table) or closed (freed)
+ * Arguments: segment number and file IO pool entry
+ */
+#define LIBEWF_TRACE_SEGMENT_FILE_OPEN( segment_number, file_io_pool_entry ) \
+	LIBEWF_TRACE_PROBE2( segment__file__open, segment_number, file_io_pool_entry )
+
+#define LIBEWF_TRACE_SEGMENT_FILE_CLOSE( segment_number ) \
+	LIBEWF_TRACE_PROBE1( segment__file__close, segment_number )
+
+/* A chunk is written, a chunks section is flushed or a segment file is finalized
+ * Arguments: chunk index or segment number and the number of bytes written
+ */
+#define LIBEWF_TRACE_CHUNK_WRITE( chunk_index, write_count ) \
+	LIBEWF_TRACE_PROBE2( chunk__write, chunk_index, write_count )
+
+#define LIBEWF_TRACE_CHUNKS_SECTION_FLUSH( segment_number, write_count ) \
+	LIBEWF_TRACE_PROBE2( chunks__section__flush, segment_number, write_count )
+
+#define LIBEWF_TRACE_SEGMENT_FILE_FINALIZE( segment_number, write_count ) \
+	LIBEWF_TRACE_PROBE2( segment__file__finalize, segment_number, write_count )
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBEWF_TRACE_PROVIDER )
+
+void libewf_trace_register(
+      void );
+
+void libewf_trace_unregister(
+      void );
+
+#endif /* defined( HAVE_LIBEWF_TRACE_PROVIDER ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_TRACE_H ) */
+
@@ -36,15 +36,38 @@
 #if defined( HAVE_DEBUG_OUTPUT ) && !defined( WINAPI )
 typedef struct libewf_data_chunk {}	libewf_data_chunk_t;
 typedef struct libewf_file_entry {}	libewf_file_entry_t;
+typedef struct libewf_file_entry_iterator {}	libewf_file_entry_iterator_t;
 typedef struct libewf_handle {}		libewf_handle_t;
+typedef struct libewf_scheduler {}	libewf_scheduler_t;
 
 #else
 typedef intptr_t libewf_data_chunk_t;
 typedef intptr_t libewf_file_entry_t;
+typedef intptr_t libewf_file_entry_iterator_t;
 typedef intptr_t libewf_handle_t;
+typedef intptr_t libewf_scheduler_t;
 
 #endif /* defined( HAVE_DEBUG_OUTPUT ) && !defined( WINAPI ) */
 
+/* The vectored read element
+ */
+typedef struct libewf_iovec libewf_iovec_t;
+
+struct libewf_iovec
+{
+	/* The (media) offset
+	 */
+	off64_t offset;
+
+	/* The buffer
+	 */
+	void *buffer;
+
+	/* The buffer size
+	 */
+	size_t buffer_size;
+};
+
 #endif /* defined( HAVE_LOCAL_LIBEWF ) */
 
 /* The largest primary (or scalar) available
@@ -0,0 +1,1706 @@
+/*
+ * Unbuffered file IO handle functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "libewf_definitions.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_unbuffered_file.h"
+#include "libewf_unused.h"
+
+/* Creates an unbuffered file IO handle
+ * Make sure the value io_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_unbuffered_file_io_handle_initialize(
+     libewf_unbuffered_file_io_handle_t **io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_unbuffered_file_io_handle_initialize";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid IO handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*io_handle = memory_allocate_structure(
+	              libewf_unbuffered_file_io_handle_t );
+
+	if( *io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *io_handle,
+	     0,
+	     sizeof( libewf_unbuffered_file_io_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	( *io_handle )->file_descriptor      = -1;
+	( *io_handle )->release_written_data = 1;
+
+	return( 1 );
+
+on_error:
+	if( *io_handle != NULL )
+	{
+		memory_free(
+		 *io_handle );
+
+		*io_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an unbuffered file IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_unbuffered_file_io_handle_free(
+     libewf_unbuffered_file_io_handle_t **io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_unbuffered_file_io_handle_free";
+	int result            = 1;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *io_handle != NULL )
+	{
+		if( ( *io_handle )->is_open != 0 )
+		{
+			if( libewf_unbuffered_file_io_handle_close(
+			     *io_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *io_handle )->name != NULL )
+		{
+			memory_free(
+			 ( *io_handle )->name );
+		}
+		memory_free(
+		 *io_handle );
+
+		*io_handle = NULL;
+	}
+	return( result );
+}
+
+/* Clones (duplicates) the unbuffered file IO handle
+ * The clone is not opened
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_unbuffered_file_io_handle_clone(
+     libewf_unbuffered_file_io_handle_t **destination_io_handle,
+     libewf_unbuffered_file_io_handle_t *source_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_unbuffered_file_io_handle_clone";
+
+	if( destination_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: destination IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_io_handle == NULL )
+	{
+		*destination_io_handle = NULL;
+
+		return( 1 );
+	}
+	if( libewf_unbuffered_file_io_handle_initialize(
+	     destination_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( source_io_handle->name != NULL )
+	{
+		if( libewf_unbuffered_file_io_handle_set_name(
+		     *destination_io_handle,
+		     source_io_handle->name,
+		     source_io_handle->name_size - 1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set name in IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	( *destination_io_handle )->preallocation_size   = source_io_handle->preallocation_size;
+	( *destination_io_handle )->release_written_data = source_io_handle->release_written_data;
+	( *destination_io_handle )->sync_on_close        = source_io_handle->sync_on_close;
+
+	return( 1 );
+
+on_error:
+	if( *destination_io_handle != NULL )
+	{
+		libewf_unbuffered_file_io_handle_free(
+		 destination_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Sets the name
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_unbuffered_file_io_handle_set_name(
+     libewf_unbuffered_file_io_handle_t *io_handle,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_unbuffered_file_io_handle_set_name";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->is_open != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid IO handle - already open.",
+		 function );
+
+		return( -1 );
+	}
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( name_length == 0 )
+	 || ( name_length > (size_t) ( SSIZE_MAX - 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid name length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->name != NULL )
+	{
+		memory_free(
+		 io_handle->name );
+
+		io_handle->name      = NULL;
+		io_handle->name_size = 0;
+	}
+	io_handle->name = narrow_string_allocate(
+	                   name_length + 1 );
+
+	if( io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create name.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     io_handle->name,
+	     name,
+	     name_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy name.",
+		 function );
+
+		memory_free(
+		 io_handle->name );
+
+		io_handle->name = NULL;
+
+		return( -1 );
+	}
+	io_handle->name[ name_length ] = 0;
+	io_handle->name_size           = name_length + 1;
+
+	return( 1 );
+}
+
+/* Sets the preallocation size
+ * A value of 0 disables the preallocation
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_unbuffered_file_io_handle_set_preallocation_size(
+     libewf_unbuffered_file_io_handle_t *io_handle,
+     size64_t preallocation_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_unbuffered_file_io_handle_set_preallocation_size";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->is_open != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid IO handle - already open.",
+		 function );
+
+		return( -1 );
+	}
+	if( preallocation_size > (size64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid preallocation size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	io_handle->preallocation_size = preallocation_size;
+
+	return( 1 );
+}
+
+/* Sets the value to indicate the written data should be released from the page cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_unbuffered_file_io_handle_set_release_written_data(
+     libewf_unbuffered_file_io_handle_t *io_handle,
+     uint8_t release_written_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_unbuffered_file_io_handle_set_release_written_data";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->is_open != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid IO handle - already open.",
+		 function );
+
+		return( -1 );
+	}
+	io_handle->release_written_data = release_written_data;
+
+	return( 1 );
+}
+
+/* Sets the value to indicate the file should be synchronized with the storage when it is closed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_unbuffered_file_io_handle_set_sync_on_close(
+     libewf_unbuffered_file_io_handle_t *io_handle,
+     uint8_t sync_on_close,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_unbuffered_file_io_handle_set_sync_on_close";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->is_open != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid IO handle - already open.",
+		 function );
+
+		return( -1 );
+	}
+	io_handle->sync_on_close = sync_on_close;
+
+	return( 1 );
+}
+
+/* Opens the unbuffered file IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_unbuffered_file_io_handle_open(
+     libewf_unbuffered_file_io_handle_t *io_handle,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_unbuffered_file_io_handle_open";
+
+#if defined( HAVE_LIBEWF_UNBUFFERED_FILE_SUPPORT )
+	struct stat file_statistics;
+
+	int file_descriptor   = -1;
+	int file_io_flags     = 0;
+#endif
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->is_open != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid IO handle - already open.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( access_flags & ( LIBBFIO_ACCESS_FLAG_READ | LIBBFIO_ACCESS_FLAG_WRITE ) ) == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access flags.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_UNBUFFERED_FILE_SUPPORT )
+	if( ( access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) == 0 )
+	{
+		file_io_flags = O_RDONLY;
+	}
+	else
+	{
+		if( ( access_flags & LIBBFIO_ACCESS_FLAG_READ ) != 0 )
+		{
+			file_io_flags = O_RDWR | O_CREAT;
+		}
+		else
+		{
+			file_io_flags = O_WRONLY | O_CREAT;
+		}
+		if( ( access_flags & LIBBFIO_ACCESS_FLAG_TRUNCATE ) != 0 )
+		{
+			file_io_flags |= O_TRUNC;
+		}
+	}
+	file_descriptor = open(
+	                   io_handle->name,
+	                   file_io_flags,
+	                   0644 );
+
+	if( file_descriptor == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to open file: %s.",
+		 function,
+		 io_handle->name );
+
+		return( -1 );
+	}
+	io_handle->data_size = 0;
+
+	if( ( access_flags & LIBBFIO_ACCESS_FLAG_TRUNCATE ) == 0 )
+	{
+		if( fstat(
+		     file_descriptor,
+		     &file_statistics ) != 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 errno,
+			 "%s: unable to retrieve file statistics.",
+			 function );
+
+			close(
+			 file_descriptor );
+
+			return( -1 );
+		}
+		if( file_statistics.st_size > 0 )
+		{
+			io_handle->data_size = (size64_t) file_statistics.st_size;
+		}
+	}
+	io_handle->is_preallocated = 0;
+
+#if defined( HAVE_LIBEWF_UNBUFFERED_FILE_PREALLOCATION_SUPPORT )
+	/* The preallocation is only an optimization hence a failure,
+	 * for example if the file system does not support it, is not considered an error
+	 */
+	if( ( ( access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) != 0 )
+	 && ( io_handle->preallocation_size > io_handle->data_size ) )
+	{
+		if( posix_fallocate(
+		     file_descriptor,
+		     (off_t) io_handle->data_size,
+		     (off_t) ( io_handle->preallocation_size - io_handle->data_size ) ) == 0 )
+		{
+			io_handle->is_preallocated = 1;
+		}
+	}
+#endif
+	io_handle->file_descriptor  = file_descriptor;
+	io_handle->current_offset   = 0;
+	io_handle->pending_offset   = 0;
+	io_handle->pending_size     = 0;
+	io_handle->scheduled_offset = 0;
+	io_handle->scheduled_size   = 0;
+	io_handle->access_flags     = access_flags;
+	io_handle->is_open          = 1;
+
+	return( 1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: unbuffered files are not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( HAVE_LIBEWF_UNBUFFERED_FILE_SUPPORT ) */
+}
+
+/* Closes the unbuffered file IO handle
+ * A preallocated file is truncated to the size of the written data
+ * The written data is flushed to the storage and released from the page cache
+ * Returns 0 if successful or -1 on error
+ */
+int libewf_unbuffered_file_io_handle_close(
+     libewf_unbuffered_file_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_unbuffered_file_io_handle_close";
+	int result            = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->is_open == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - not open.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_UNBUFFERED_FILE_PREALLOCATION_SUPPORT )
+	if( io_handle->is_preallocated != 0 )
+	{
+		if( ftruncate(
+		     io_handle->file_descriptor,
+		     (off_t) io_handle->data_size ) != 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 errno,
+			 "%s: unable to truncate file: %s.",
+			 function,
+			 io_handle->name );
+
+			result = -1;
+		}
+	}
+#endif
+	if( libewf_unbuffered_file_io_handle_release_written_data(
+	     io_handle,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to release written data.",
+		 function );
+
+		result = -1;
+	}
+	if( io_handle->sync_on_close != 0 )
+	{
+		if( libewf_unbuffered_file_io_handle_sync(
+		     io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to synchronize file.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBEWF_UNBUFFERED_FILE_SUPPORT )
+	if( close(
+	     io_handle->file_descriptor ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 errno,
+		 "%s: unable to close file: %s.",
+		 function,
+		 io_handle->name );
+
+		result = -1;
+	}
+#endif
+	io_handle->file_descriptor = -1;
+	io_handle->current_offset  = 0;
+	io_handle->data_size       = 0;
+	io_handle->access_flags    = 0;
+	io_handle->is_preallocated = 0;
+	io_handle->is_open         = 0;
+
+	return( result );
+}
+
+/* Releases the written data from the page cache
+ * The write back of the pending written data is started and the data of which
+ * the write back was started by a previous call is dropped from the page cache.
+ * If release all is set the file data is flushed and all of it is dropped.
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_unbuffered_file_io_handle_release_written_data(
+     libewf_unbuffered_file_io_handle_t *io_handle,
+     uint8_t release_all,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_unbuffered_file_io_handle_release_written_data";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->is_open == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - not open.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_UNBUFFERED_FILE_SUPPORT )
+	if( io_handle->release_written_data == 0 )
+	{
+		io_handle->pending_size   = 0;
+		io_handle->scheduled_size = 0;
+
+		return( 1 );
+	}
+	if( release_all != 0 )
+	{
+		if( ( io_handle->pending_size == 0 )
+		 && ( io_handle->scheduled_size == 0 ) )
+		{
+			return( 1 );
+		}
+#if defined( HAVE_FDATASYNC )
+		if( fdatasync(
+		     io_handle->file_descriptor ) != 0 )
+#else
+		if( fsync(
+		     io_handle->file_descriptor ) != 0 )
+#endif
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 errno,
+			 "%s: unable to flush file: %s.",
+			 function,
+			 io_handle->name );
+
+			return( -1 );
+		}
+		/* The advice is only a hint hence a failure is not considered an error
+		 */
+		posix_fadvise(
+		 io_handle->file_descriptor,
+		 0,
+		 0,
+		 POSIX_FADV_DONTNEED );
+
+		io_handle->pending_size   = 0;
+		io_handle->scheduled_size = 0;
+
+		return( 1 );
+	}
+	/* Dropping dirty pages from the page cache starts their write back
+	 * pages that are already written back are dropped directly
+	 */
+	if( io_handle->scheduled_size > 0 )
+	{
+		posix_fadvise(
+		 io_handle->file_descriptor,
+		 (off_t) io_handle->scheduled_offset,
+		 (off_t) io_handle->scheduled_size,
+		 POSIX_FADV_DONTNEED );
+	}
+	if( io_handle->pending_size > 0 )
+	{
+		posix_fadvise(
+		 io_handle->file_descriptor,
+		 (off_t) io_handle->pending_offset,
+		 (off_t) io_handle->pending_size,
+		 POSIX_FADV_DONTNEED );
+	}
+	io_handle->scheduled_offset = io_handle->pending_offset;
+	io_handle->scheduled_size   = io_handle->pending_size;
+	io_handle->pending_size     = 0;
+#endif /* defined( HAVE_LIBEWF_UNBUFFERED_FILE_SUPPORT ) */
+
+	return( 1 );
+}
+
+/* Synchronizes the written data of the unbuffered file IO handle with the storage
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_unbuffered_file_io_handle_sync(
+     libewf_unbuffered_file_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_unbuffered_file_io_handle_sync";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->is_open == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - not open.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_UNBUFFERED_FILE_SUPPORT )
+#if defined( HAVE_FDATASYNC )
+	if( fdatasync(
+	     io_handle->file_descriptor ) != 0 )
+#else
+	if( fsync(
+	     io_handle->file_descriptor ) != 0 )
+#endif
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 errno,
+		 "%s: unable to synchronize file: %s.",
+		 function,
+		 io_handle->name );
+
+		return( -1 );
+	}
+	return( 1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: unbuffered files are not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( HAVE_LIBEWF_UNBUFFERED_FILE_SUPPORT ) */
+}
+
+/* Reads a buffer from the unbuffered file IO handle
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t libewf_unbuffered_file_io_handle_read_buffer(
+         libewf_unbuffered_file_io_handle_t *io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_unbuffered_file_io_handle_read_buffer";
+	ssize_t read_count    = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->is_open == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_UNBUFFERED_FILE_SUPPORT )
+	do
+	{
+		read_count = read(
+		              io_handle->file_descriptor,
+		              (void *) buffer,
+		              size );
+	}
+	while( ( read_count == -1 )
+	    && ( errno == EINTR ) );
+
+	if( read_count < 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 errno,
+		 "%s: unable to read from file: %s.",
+		 function,
+		 io_handle->name );
+
+		return( -1 );
+	}
+	io_handle->current_offset += (off64_t) read_count;
+#endif
+	return( read_count );
+}
+
+/* Writes a buffer to the unbuffered file IO handle
+ * The written data is released from the page cache in blocks of LIBEWF_UNBUFFERED_FILE_RELEASE_SIZE
+ * Returns the number of bytes written if successful, or -1 on error
+ */
+ssize_t libewf_unbuffered_file_io_handle_write_buffer(
+         libewf_unbuffered_file_io_handle_t *io_handle,
+         const uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_unbuffered_file_io_handle_write_buffer";
+	size_t buffer_offset  = 0;
+	ssize_t write_count   = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->is_open == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( io_handle->access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: write access not supported.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_UNBUFFERED_FILE_SUPPORT )
+	/* Data that is not written directly after the pending data is tracked separately
+	 */
+	if( ( io_handle->pending_size > 0 )
+	 && ( io_handle->current_offset != ( io_handle->pending_offset + (off64_t) io_handle->pending_size ) ) )
+	{
+		if( libewf_unbuffered_file_io_handle_release_written_data(
+		     io_handle,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to release written data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	while( buffer_offset < size )
+	{
+		write_count = write(
+		               io_handle->file_descriptor,
+		               (const void *) &( buffer[ buffer_offset ] ),
+		               size - buffer_offset );
+
+		if( write_count == -1 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 errno,
+			 "%s: unable to write to file: %s.",
+			 function,
+			 io_handle->name );
+
+			return( -1 );
+		}
+		else if( write_count == 0 )
+		{
+			break;
+		}
+		buffer_offset += (size_t) write_count;
+	}
+	if( io_handle->pending_size == 0 )
+	{
+		io_handle->pending_offset = io_handle->current_offset;
+	}
+	io_handle->current_offset += (off64_t) buffer_offset;
+	io_handle->pending_size   += (size64_t) buffer_offset;
+
+	if( (size64_t) io_handle->current_offset > io_handle->data_size )
+	{
+		io_handle->data_size = (size64_t) io_handle->current_offset;
+	}
+	if( io_handle->pending_size >= (size64_t) LIBEWF_UNBUFFERED_FILE_RELEASE_SIZE )
+	{
+		if( libewf_unbuffered_file_io_handle_release_written_data(
+		     io_handle,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to release written data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif /* defined( HAVE_LIBEWF_UNBUFFERED_FILE_SUPPORT ) */
+
+	return( (ssize_t) buffer_offset );
+}
+
+/* Seeks a certain offset within the unbuffered file IO handle
+ * Returns the offset if the seek is successful or -1 on error
+ */
+off64_t libewf_unbuffered_file_io_handle_seek_offset(
+         libewf_unbuffered_file_io_handle_t *io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_unbuffered_file_io_handle_seek_offset";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->is_open == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_UNBUFFERED_FILE_SUPPORT )
+	/* The end of a preallocated file is the end of the written data
+	 */
+	if( ( io_handle->is_preallocated != 0 )
+	 && ( whence == SEEK_END ) )
+	{
+		offset += (off64_t) io_handle->data_size;
+		whence  = SEEK_SET;
+	}
+	offset = (off64_t) lseek(
+	                    io_handle->file_descriptor,
+	                    (off_t) offset,
+	                    whence );
+
+	if( offset < 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 errno,
+		 "%s: unable to seek offset in file: %s.",
+		 function,
+		 io_handle->name );
+
+		return( -1 );
+	}
+	io_handle->current_offset = offset;
+#endif
+	return( offset );
+}
+
+/* Function to determine if a file exists
+ * Returns 1 if file exists, 0 if not or -1 on error
+ */
+int libewf_unbuffered_file_io_handle_exists(
+     libewf_unbuffered_file_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBEWF_UNBUFFERED_FILE_SUPPORT )
+	struct stat file_statistics;
+#endif
+	static char *function = "libewf_unbuffered_file_io_handle_exists";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_UNBUFFERED_FILE_SUPPORT )
+	if( stat(
+	     io_handle->name,
+	     &file_statistics ) != 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+#else
+	return( 0 );
+#endif
+}
+
+/* Check if the unbuffered file IO handle is open
+ * Returns 1 if open, 0 if not or -1 on error
+ */
+int libewf_unbuffered_file_io_handle_is_open(
+     libewf_unbuffered_file_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_unbuffered_file_io_handle_is_open";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->is_open == 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the size of the unbuffered file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_unbuffered_file_io_handle_get_size(
+     libewf_unbuffered_file_io_handle_t *io_handle,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBEWF_UNBUFFERED_FILE_SUPPORT )
+	struct stat file_statistics;
+#endif
+	static char *function = "libewf_unbuffered_file_io_handle_get_size";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->is_open == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_UNBUFFERED_FILE_SUPPORT )
+	if( io_handle->is_preallocated != 0 )
+	{
+		*size = io_handle->data_size;
+
+		return( 1 );
+	}
+	if( fstat(
+	     io_handle->file_descriptor,
+	     &file_statistics ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 errno,
+		 "%s: unable to retrieve file statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_statistics.st_size < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*size = (size64_t) file_statistics.st_size;
+#else
+	*size = 0;
+#endif
+	return( 1 );
+}
+
+/* Creates an unbuffered file handle
+ * Make sure the value handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_unbuffered_file_initialize(
+     libbfio_handle_t **handle,
+     libcerror_error_t **error )
+{
+	libewf_unbuffered_file_io_handle_t *io_handle = NULL;
+	static char *function                     = "libewf_unbuffered_file_initialize";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_unbuffered_file_io_handle_initialize(
+	     &io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create unbuffered file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_initialize(
+	     handle,
+	     (intptr_t *) io_handle,
+	     (int (*)(intptr_t **, libcerror_error_t **)) libewf_unbuffered_file_io_handle_free,
+	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) libewf_unbuffered_file_io_handle_clone,
+	     (int (*)(intptr_t *, int, libcerror_error_t **)) libewf_unbuffered_file_io_handle_open,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libewf_unbuffered_file_io_handle_close,
+	     (ssize_t (*)(intptr_t *, uint8_t *, size_t, libcerror_error_t **)) libewf_unbuffered_file_io_handle_read_buffer,
+	     (ssize_t (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) libewf_unbuffered_file_io_handle_write_buffer,
+	     (off64_t (*)(intptr_t *, off64_t, int, libcerror_error_t **)) libewf_unbuffered_file_io_handle_seek_offset,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libewf_unbuffered_file_io_handle_exists,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libewf_unbuffered_file_io_handle_is_open,
+	     (int (*)(intptr_t *, size64_t *, libcerror_error_t **)) libewf_unbuffered_file_io_handle_get_size,
+	     LIBBFIO_FLAG_IO_HANDLE_MANAGED | LIBBFIO_FLAG_IO_HANDLE_CLONE_BY_FUNCTION,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( io_handle != NULL )
+	{
+		libewf_unbuffered_file_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Sets the name of the unbuffered file handle
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_unbuffered_file_set_name(
+     libbfio_handle_t *handle,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error )
+{
+	libewf_unbuffered_file_io_handle_t *io_handle = NULL;
+	static char *function                     = "libewf_unbuffered_file_set_name";
+
+	if( libbfio_handle_get_io_handle(
+	     handle,
+	     (intptr_t **) &io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve unbuffered file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_unbuffered_file_io_handle_set_name(
+	     io_handle,
+	     name,
+	     name_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name in unbuffered file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the preallocation size of the unbuffered file handle
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_unbuffered_file_set_preallocation_size(
+     libbfio_handle_t *handle,
+     size64_t preallocation_size,
+     libcerror_error_t **error )
+{
+	libewf_unbuffered_file_io_handle_t *io_handle = NULL;
+	static char *function                     = "libewf_unbuffered_file_set_preallocation_size";
+
+	if( libbfio_handle_get_io_handle(
+	     handle,
+	     (intptr_t **) &io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve unbuffered file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_unbuffered_file_io_handle_set_preallocation_size(
+	     io_handle,
+	     preallocation_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set preallocation size in unbuffered file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the value to indicate the written data of the unbuffered file handle
+ * should be released from the page cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_unbuffered_file_set_release_written_data(
+     libbfio_handle_t *handle,
+     uint8_t release_written_data,
+     libcerror_error_t **error )
+{
+	libewf_unbuffered_file_io_handle_t *io_handle = NULL;
+	static char *function                     = "libewf_unbuffered_file_set_release_written_data";
+
+	if( libbfio_handle_get_io_handle(
+	     handle,
+	     (intptr_t **) &io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve unbuffered file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_unbuffered_file_io_handle_set_release_written_data(
+	     io_handle,
+	     release_written_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set release written data in unbuffered file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the value to indicate the unbuffered file handle should be synchronized
+ * with the storage when it is closed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_unbuffered_file_set_sync_on_close(
+     libbfio_handle_t *handle,
+     uint8_t sync_on_close,
+     libcerror_error_t **error )
+{
+	libewf_unbuffered_file_io_handle_t *io_handle = NULL;
+	static char *function                     = "libewf_unbuffered_file_set_sync_on_close";
+
+	if( libbfio_handle_get_io_handle(
+	     handle,
+	     (intptr_t **) &io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve unbuffered file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_unbuffered_file_io_handle_set_sync_on_close(
+	     io_handle,
+	     sync_on_close,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set sync on close in unbuffered file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Synchronizes the written data of the unbuffered file handle with the storage
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_unbuffered_file_sync(
+     libbfio_handle_t *handle,
+     libcerror_error_t **error )
+{
+	libewf_unbuffered_file_io_handle_t *io_handle = NULL;
+	static char *function                     = "libewf_unbuffered_file_sync";
+
+	if( libbfio_handle_get_io_handle(
+	     handle,
+	     (intptr_t **) &io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve unbuffered file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_unbuffered_file_io_handle_sync(
+	     io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to synchronize unbuffered file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,230 @@
+/*
+ * Unbuffered file IO handle functions
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_UNBUFFERED_FILE_H )
+#define _LIBEWF_UNBUFFERED_FILE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_POSIX_FADVISE ) && !defined( WINAPI ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+#define HAVE_LIBEWF_UNBUFFERED_FILE_SUPPORT
+#endif
+
+#if defined( HAVE_LIBEWF_UNBUFFERED_FILE_SUPPORT ) && defined( HAVE_POSIX_FALLOCATE )
+#define HAVE_LIBEWF_UNBUFFERED_FILE_PREALLOCATION_SUPPORT
+#endif
+
+typedef struct libewf_unbuffered_file_io_handle libewf_unbuffered_file_io_handle_t;
+
+/* The unbuffered file IO handle writes a file and releases the written data
+ * from the page cache once it has been written back to the storage
+ * It can also preallocate the file up to a certain size, the file is then
+ * truncated to the size of the written data on close
+ */
+struct libewf_unbuffered_file_io_handle
+{
+	/* The name
+	 */
+	char *name;
+
+	/* The name size
+	 */
+	size_t name_size;
+
+	/* The file descriptor
+	 */
+	int file_descriptor;
+
+	/* The current offset
+	 */
+	off64_t current_offset;
+
+	/* The offset of the written data for which write back was not yet started
+	 */
+	off64_t pending_offset;
+
+	/* The size of the written data for which write back was not yet started
+	 */
+	size64_t pending_size;
+
+	/* The offset of the written data for which write back was started
+	 */
+	off64_t scheduled_offset;
+
+	/* The size of the written data for which write back was started
+	 */
+	size64_t scheduled_size;
+
+	/* The preallocation size
+	 */
+	size64_t preallocation_size;
+
+	/* The size of the file data, which excludes the preallocated space
+	 */
+	size64_t data_size;
+
+	/* The access flags
+	 */
+	int access_flags;
+
+	/* Value to indicate the written data should be released from the page cache
+	 */
+	uint8_t release_written_data;
+
+	/* Value to indicate the file should be synchronized with the storage when it is closed
+	 */
+	uint8_t sync_on_close;
+
+	/* Value to indicate the file was preallocated
+	 */
+	uint8_t is_preallocated;
+
+	/* Value to indicate the file is open
+	 */
+	uint8_t is_open;
+};
+
+int libewf_unbuffered_file_io_handle_initialize(
+     libewf_unbuffered_file_io_handle_t **io_handle,
+     libcerror_error_t **error );
+
+int libewf_unbuffered_file_io_handle_free(
+     libewf_unbuffered_file_io_handle_t **io_handle,
+     libcerror_error_t **error );
+
+int libewf_unbuffered_file_io_handle_clone(
+     libewf_unbuffered_file_io_handle_t **destination_io_handle,
+     libewf_unbuffered_file_io_handle_t *source_io_handle,
+     libcerror_error_t **error );
+
+int libewf_unbuffered_file_io_handle_set_name(
+     libewf_unbuffered_file_io_handle_t *io_handle,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error );
+
+int libewf_unbuffered_file_io_handle_set_preallocation_size(
+     libewf_unbuffered_file_io_handle_t *io_handle,
+     size64_t preallocation_size,
+     libcerror_error_t **error );
+
+int libewf_unbuffered_file_io_handle_set_release_written_data(
+     libewf_unbuffered_file_io_handle_t *io_handle,
+     uint8_t release_written_data,
+     libcerror_error_t **error );
+
+int libewf_unbuffered_file_io_handle_set_sync_on_close(
+     libewf_unbuffered_file_io_handle_t *io_handle,
+     uint8_t sync_on_close,
+     libcerror_error_t **error );
+
+int libewf_unbuffered_file_io_handle_open(
+     libewf_unbuffered_file_io_handle_t *io_handle,
+     int access_flags,
+     libcerror_error_t **error );
+
+int libewf_unbuffered_file_io_handle_close(
+     libewf_unbuffered_file_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
+int libewf_unbuffered_file_io_handle_release_written_data(
+     libewf_unbuffered_file_io_handle_t *io_handle,
+     uint8_t release_all,
+     libcerror_error_t **error );
+
+int libewf_unbuffered_file_io_handle_sync(
+     libewf_unbuffered_file_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
+ssize_t libewf_unbuffered_file_io_handle_read_buffer(
+         libewf_unbuffered_file_io_handle_t *io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+ssize_t libewf_unbuffered_file_io_handle_write_buffer(
+         libewf_unbuffered_file_io_handle_t *io_handle,
+         const uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+off64_t libewf_unbuffered_file_io_handle_seek_offset(
+         libewf_unbuffered_file_io_handle_t *io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error );
+
+int libewf_unbuffered_file_io_handle_exists(
+     libewf_unbuffered_file_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
+int libewf_unbuffered_file_io_handle_is_open(
+     libewf_unbuffered_file_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
+int libewf_unbuffered_file_io_handle_get_size(
+     libewf_unbuffered_file_io_handle_t *io_handle,
+     size64_t *size,
+     libcerror_error_t **error );
+
+int libewf_unbuffered_file_initialize(
+     libbfio_handle_t **handle,
+     libcerror_error_t **error );
+
+int libewf_unbuffered_file_set_name(
+     libbfio_handle_t *handle,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error );
+
+int libewf_unbuffered_file_set_preallocation_size(
+     libbfio_handle_t *handle,
+     size64_t preallocation_size,
+     libcerror_error_t **error );
+
+int libewf_unbuffered_file_set_release_written_data(
+     libbfio_handle_t *handle,
+     uint8_t release_written_data,
+     libcerror_error_t **error );
+
+int libewf_unbuffered_file_set_sync_on_close(
+     libbfio_handle_t *handle,
+     uint8_t sync_on_close,
+     libcerror_error_t **error );
+
+int libewf_unbuffered_file_sync(
+     libbfio_handle_t *handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_UNBUFFERED_FILE_H ) */
+
@@ -53,8 +53,11 @@
 #include "libewf_media_values.h"
 #include "libewf_read_io_handle.h"
 #include "libewf_section.h"
+#include "libewf_segment_corrector.h"
 #include "libewf_segment_file.h"
 #include "libewf_segment_table.h"
+#include "libewf_trace.h"
+#include "libewf_unbuffered_file.h"
 #include "libewf_unused.h"
 #include "libewf_write_io_handle.h"
 
@@ -657,6 +660,35 @@ int libewf_write_io_handle_initialize_values(
 		 */
 		write_io_handle->chunks_section_reserved_size = sizeof( ewf_section_descriptor_v2_t ) + 16;
 	}
+	/* A sequential write cannot correct the chunks section descriptors of
+	 * the EWF version 1 format or the media values of a streaming write
+	 */
+	if( ( io_handle->access_flags & LIBEWF_ACCESS_FLAG_SEQUENTIAL ) != 0 )
+	{
+		if( ( io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_EWF2 )
+		 && ( io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_EWF2_LOGICAL ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: format does not allow for sequential write.",
+			 function );
+
+			goto on_error;
+		}
+		if( media_values->media_size == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid media values - missing media size required for sequential write.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	/* If no input write size was provided check if EWF file format allows for streaming
 	 */
 	if( media_values->media_size == 0 )
@@ -727,6 +759,19 @@ int libewf_write_io_handle_initialize_values(
 	}
 	io_handle->chunk_size = media_values->chunk_size;
 
+	if( libewf_io_handle_initialize_buffer_pool(
+	     io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create buffer pool.",
+		 function );
+
+		goto on_error;
+	}
 	if( ( write_io_handle->pack_flags & LIBEWF_PACK_FLAG_FORCE_COMPRESSION ) == 0 )
 	{
 		if( write_io_handle->compressed_zero_byte_empty_block == NULL )
@@ -782,6 +827,7 @@ int libewf_write_io_handle_initialize_values(
 				compression_level = LIBEWF_COMPRESSION_DEFAULT;
 			}
 			result = libewf_compress_data(
+				  NULL,
 				  compressed_zero_byte_empty_block,
 				  &( write_io_handle->compressed_zero_byte_empty_block_size ),
 				  io_handle->compression_method,
@@ -838,6 +884,7 @@ int libewf_write_io_handle_initialize_values(
 				compressed_zero_byte_empty_block = (uint8_t *) reallocation;
 
 				result = libewf_compress_data(
+					  NULL,
 					  compressed_zero_byte_empty_block,
 					  &( write_io_handle->compressed_zero_byte_empty_block_size ),
 					  io_handle->compression_method,
@@ -1679,6 +1726,10 @@ on_error:
 }
 
 /* Resize the table entries
+ * The table entries are (re)generated before they are written, hence the previous
+ * table section data is not retained and no copy is made on resize
+ * The capacity is grown at least twice the previous number of entries to
+ * prevent the table section data being reallocated for every chunks section
  * Returns 1 if successful or -1 on error
  */
 int libewf_write_io_handle_resize_table_entries(
@@ -1686,8 +1737,11 @@ int libewf_write_io_handle_resize_table_entries(
      uint32_t number_of_entries,
      libcerror_error_t **error )
 {
-	void *reallocation    = NULL;
-	static char *function = "libewf_write_io_handle_resize_table_entries";
+	uint8_t *table_section_data          = NULL;
+	static char *function                = "libewf_write_io_handle_resize_table_entries";
+	size_t table_section_data_size       = 0;
+	uint64_t maximum_number_of_entries   = 0;
+	uint32_t number_of_allocated_entries = 0;
 
 	if( write_io_handle == NULL )
 	{
@@ -1700,6 +1754,17 @@ int libewf_write_io_handle_resize_table_entries(
 
 		return( -1 );
 	}
+	if( write_io_handle->table_entry_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid write IO handle - missing table entry size.",
+		 function );
+
+		return( -1 );
+	}
 	if( number_of_entries < write_io_handle->number_of_table_entries )
 	{
 		libcerror_error_set(
@@ -1711,20 +1776,51 @@ int libewf_write_io_handle_resize_table_entries(
 
 		return( -1 );
 	}
-	write_io_handle->table_entries_data_size = number_of_entries
-	                                         * write_io_handle->table_entry_size;
-
 	/* Reserve space for the header, entries and footer
 	 */
-	write_io_handle->table_section_data_size = write_io_handle->table_header_size
-						 + write_io_handle->table_entries_data_size
-						 + 16;
+	maximum_number_of_entries = (uint64_t) ( SSIZE_MAX - write_io_handle->table_header_size - 16 )
+	                          / write_io_handle->table_entry_size;
 
-	reallocation = memory_reallocate(
-			write_io_handle->table_section_data,
-			write_io_handle->table_section_data_size );
+	if( maximum_number_of_entries > (uint64_t) UINT32_MAX )
+	{
+		maximum_number_of_entries = (uint64_t) UINT32_MAX;
+	}
+	if( (uint64_t) number_of_entries > maximum_number_of_entries )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of entries value exceeds maximum.",
+		 function );
 
-	if( reallocation == NULL )
+		return( -1 );
+	}
+	if( number_of_entries == write_io_handle->number_of_table_entries )
+	{
+		if( write_io_handle->table_section_data != NULL )
+		{
+			return( 1 );
+		}
+	}
+	number_of_allocated_entries = number_of_entries;
+
+	if( ( (uint64_t) write_io_handle->number_of_table_entries * 2 ) > maximum_number_of_entries )
+	{
+		number_of_allocated_entries = (uint32_t) maximum_number_of_entries;
+	}
+	else if( number_of_allocated_entries < ( write_io_handle->number_of_table_entries * 2 ) )
+	{
+		number_of_allocated_entries = write_io_handle->number_of_table_entries * 2;
+	}
+	table_section_data_size = write_io_handle->table_header_size
+	                        + ( (size_t) number_of_allocated_entries * write_io_handle->table_entry_size )
+	                        + 16;
+
+	table_section_data = (uint8_t *) memory_allocate(
+	                                  table_section_data_size );
+
+	if( table_section_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -1735,9 +1831,16 @@ int libewf_write_io_handle_resize_table_entries(
 
 		return( -1 );
 	}
-	write_io_handle->table_section_data      = (uint8_t *) reallocation;
-	write_io_handle->table_entries_data      = &( write_io_handle->table_section_data[ write_io_handle->table_header_size ] );
-	write_io_handle->number_of_table_entries = number_of_entries;
+	if( write_io_handle->table_section_data != NULL )
+	{
+		memory_free(
+		 write_io_handle->table_section_data );
+	}
+	write_io_handle->table_section_data      = table_section_data;
+	write_io_handle->table_section_data_size = table_section_data_size;
+	write_io_handle->table_entries_data      = &( table_section_data[ write_io_handle->table_header_size ] );
+	write_io_handle->table_entries_data_size = (size_t) number_of_allocated_entries * write_io_handle->table_entry_size;
+	write_io_handle->number_of_table_entries = number_of_allocated_entries;
 
 	return( 1 );
 }
@@ -2302,6 +2405,7 @@ int libewf_write_io_handle_test_chunks_section_full(
  * Returns 1 if successful or -1 on error
  */
 int libewf_write_io_handle_create_segment_file(
+     libewf_write_io_handle_t *write_io_handle,
      libewf_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
      libewf_segment_table_t *segment_table,
@@ -2314,11 +2418,29 @@ int libewf_write_io_handle_create_segment_file(
      libcerror_error_t **error )
 {
 	libbfio_handle_t *file_io_handle = NULL;
+	system_character_t *basename     = NULL;
 	system_character_t *filename     = NULL;
 	static char *function            = "libewf_write_io_handle_create_segment_file";
+	size_t basename_size             = 0;
 	size_t filename_size             = 0;
 	int bfio_access_flags            = 0;
+	int result                       = 0;
+
+#if defined( HAVE_LIBEWF_UNBUFFERED_FILE_SUPPORT )
+	uint8_t use_unbuffered_file      = 0;
+#endif
+
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
 
+		return( -1 );
+	}
 	if( segment_table == NULL )
 	{
 		libcerror_error_set(
@@ -2374,11 +2496,28 @@ int libewf_write_io_handle_create_segment_file(
 
 		return( -1 );
 	}
+	if( libewf_segment_table_get_segment_basename(
+	     segment_table,
+	     segment_number,
+	     &basename,
+	     &basename_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment file: %" PRIu32 " basename.",
+		 function,
+		 segment_number );
+
+		goto on_error;
+	}
 	if( libewf_filename_create(
 	     &filename,
 	     &filename_size,
-	     segment_table->basename,
-	     segment_table->basename_size - 1,
+	     basename,
+	     basename_size - 1,
 	     segment_number + 1,
 	     maximum_number_of_segments,
 	     segment_file_type,
@@ -2416,9 +2555,29 @@ int libewf_write_io_handle_create_segment_file(
 		 filename );
 	}
 #endif
-	if( libbfio_file_initialize(
-	     &file_io_handle,
-	     error ) != 1 )
+#if defined( HAVE_LIBEWF_UNBUFFERED_FILE_SUPPORT )
+	/* The durable write synchronization policy requires the file descriptor
+	 * hence it also uses the unbuffered file IO handle
+	 */
+	if( ( ( io_handle->access_flags & ( LIBEWF_ACCESS_FLAG_UNBUFFERED | LIBEWF_ACCESS_FLAG_PREALLOCATE ) ) != 0 )
+	 || ( write_io_handle->sync_policy == LIBEWF_WRITE_SYNC_POLICY_DURABLE ) )
+	{
+		use_unbuffered_file = 1;
+	}
+	if( use_unbuffered_file != 0 )
+	{
+		result = libewf_unbuffered_file_initialize(
+		          &file_io_handle,
+		          error );
+	}
+	else
+#endif
+	{
+		result = libbfio_file_initialize(
+		          &file_io_handle,
+		          error );
+	}
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -2429,19 +2588,33 @@ int libewf_write_io_handle_create_segment_file(
 
 		goto on_error;
 	}
+#if defined( HAVE_LIBEWF_UNBUFFERED_FILE_SUPPORT )
+	if( use_unbuffered_file != 0 )
+	{
+		result = libewf_unbuffered_file_set_name(
+		          file_io_handle,
+		          filename,
+		          filename_size - 1,
+		          error );
+	}
+	else
+#endif
+	{
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	if( libbfio_file_set_name_wide(
-	     file_io_handle,
-	     filename,
-	     filename_size,
-	     error ) != 1 )
+		result = libbfio_file_set_name_wide(
+		          file_io_handle,
+		          filename,
+		          filename_size,
+		          error );
 #else
-	if( libbfio_file_set_name(
-	     file_io_handle,
-	     filename,
-	     filename_size,
-	     error ) != 1 )
+		result = libbfio_file_set_name(
+		          file_io_handle,
+		          filename,
+		          filename_size,
+		          error );
 #endif
+	}
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -2452,6 +2625,59 @@ int libewf_write_io_handle_create_segment_file(
 
 		goto on_error;
 	}
+#if defined( HAVE_LIBEWF_UNBUFFERED_FILE_SUPPORT )
+	if( ( io_handle->access_flags & LIBEWF_ACCESS_FLAG_PREALLOCATE ) != 0 )
+	{
+		if( libewf_unbuffered_file_set_preallocation_size(
+		     file_io_handle,
+		     segment_table->maximum_segment_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set preallocation size in file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( use_unbuffered_file != 0 )
+	{
+		/* Only release the written data from the page cache if unbuffered
+		 * write access was requested
+		 */
+		if( libewf_unbuffered_file_set_release_written_data(
+		     file_io_handle,
+		     (uint8_t) ( ( io_handle->access_flags & LIBEWF_ACCESS_FLAG_UNBUFFERED ) != 0 ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set release written data in file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( libewf_unbuffered_file_set_sync_on_close(
+		     file_io_handle,
+		     (uint8_t) ( write_io_handle->sync_policy == LIBEWF_WRITE_SYNC_POLICY_DURABLE ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set sync on close in file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 	memory_free(
 	 filename );
 
@@ -2575,6 +2801,10 @@ int libewf_write_io_handle_create_segment_file(
 
 		goto on_error;
 	}
+	LIBEWF_TRACE_SEGMENT_FILE_OPEN(
+	 segment_number + 1,
+	 *file_io_pool_entry );
+
 	return( 1 );
 
 on_error:
@@ -2598,6 +2828,235 @@ on_error:
 	return( -1 );
 }
 
+/* Synchronizes a segment file with the storage if the durable write synchronization policy is used
+ * A segment file that is no longer open was synchronized when it was closed
+ * Returns 1 if successful, 0 if not required or -1 on error
+ */
+int libewf_write_io_handle_sync_segment_file(
+     libewf_write_io_handle_t *write_io_handle,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBEWF_UNBUFFERED_FILE_SUPPORT )
+	libbfio_handle_t *file_io_handle = NULL;
+	int64_t start_timestamp          = 0;
+	int result                       = 0;
+#endif
+
+	static char *function            = "libewf_write_io_handle_sync_segment_file";
+
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_io_handle->sync_policy != LIBEWF_WRITE_SYNC_POLICY_DURABLE )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_LIBEWF_UNBUFFERED_FILE_SUPPORT )
+	if( libbfio_pool_get_handle(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file IO handle: %d from pool.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	result = libbfio_handle_is_open(
+	          file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if file IO handle: %d is open.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( io_handle->statistics != NULL )
+	{
+		if( libewf_statistics_get_timestamp(
+		     &start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve start timestamp.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libewf_unbuffered_file_sync(
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to synchronize file IO handle: %d.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	if( io_handle->statistics != NULL )
+	{
+		if( libewf_statistics_add_segment_file_sync(
+		     io_handle->statistics,
+		     start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to add sync to statistics.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+#else
+	LIBEWF_UNREFERENCED_PARAMETER( file_io_pool )
+	LIBEWF_UNREFERENCED_PARAMETER( file_io_pool_entry )
+
+	return( 0 );
+#endif /* defined( HAVE_LIBEWF_UNBUFFERED_FILE_SUPPORT ) */
+}
+
+/* Synchronizes all segment files with the storage if the durable write synchronization policy is used
+ * This is used after the sections of segment files that were already written have been corrected
+ * Returns 1 if successful, 0 if not required or -1 on error
+ */
+int libewf_write_io_handle_sync_segment_files(
+     libewf_write_io_handle_t *write_io_handle,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     libcerror_error_t **error )
+{
+	static char *function       = "libewf_write_io_handle_sync_segment_files";
+	size64_t segment_file_size  = 0;
+	uint32_t number_of_segments = 0;
+	uint32_t segment_number     = 0;
+	int file_io_pool_entry      = 0;
+	int result                  = 0;
+
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_io_handle->sync_policy != LIBEWF_WRITE_SYNC_POLICY_DURABLE )
+	{
+		return( 0 );
+	}
+	if( libewf_segment_table_get_number_of_segments(
+	     segment_table,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
+		 function );
+
+		return( -1 );
+	}
+	for( segment_number = 0;
+	     segment_number < number_of_segments;
+	     segment_number++ )
+	{
+		if( libewf_segment_table_get_segment_by_index(
+		     segment_table,
+		     segment_number,
+		     &file_io_pool_entry,
+		     &segment_file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		result = libewf_write_io_handle_sync_segment_file(
+		          write_io_handle,
+		          io_handle,
+		          file_io_pool,
+		          file_io_pool_entry,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to synchronize segment file: %" PRIu32 ".",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
 /* Writes the start of the chunks section
  * Returns the number of bytes written or -1 on error
  */
@@ -2840,6 +3299,10 @@ ssize_t libewf_write_io_handle_write_chunks_section_end(
 
 		return( -1 );
 	}
+	LIBEWF_TRACE_CHUNKS_SECTION_FLUSH(
+	 segment_file->segment_number,
+	 write_count );
+
 	if( libewf_chunk_group_empty(
 	     write_io_handle->chunk_group,
 	     error ) != 1 )
@@ -2871,7 +3334,7 @@ ssize_t libewf_write_io_handle_write_new_chunk(
          libewf_hash_sections_t *hash_sections,
          libcdata_array_t *sessions,
          libcdata_array_t *tracks,
-         libcdata_range_list_t *acquiry_errors,
+         libewf_sector_range_list_t *acquiry_errors,
          uint64_t chunk_index,
          libewf_chunk_data_t *chunk_data,
          size_t input_data_size,
@@ -3052,6 +3515,7 @@ ssize_t libewf_write_io_handle_write_new_chunk(
 		}
 #endif
 		if( libewf_write_io_handle_create_segment_file(
+		     write_io_handle,
 		     io_handle,
 		     file_io_pool,
 		     segment_table,
@@ -3169,6 +3633,17 @@ ssize_t libewf_write_io_handle_write_new_chunk(
 	 */
 	if( write_io_handle->resume_segment_file_offset > 0 )
 	{
+		if( ( io_handle->access_flags & LIBEWF_ACCESS_FLAG_SEQUENTIAL ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unable to seek resume segment file offset on sequential write.",
+			 function );
+
+			return( -1 );
+		}
 		if( libbfio_pool_seek_offset(
 		     file_io_pool,
 		     file_io_pool_entry,
@@ -3339,6 +3814,10 @@ ssize_t libewf_write_io_handle_write_new_chunk(
 
 		return( -1 );
 	}
+	LIBEWF_TRACE_CHUNK_WRITE(
+	 chunk_index,
+	 write_count );
+
 	total_write_count += write_count;
 
 /* TODO re-implement using set by index instead of append ? */
@@ -3484,14 +3963,41 @@ ssize_t libewf_write_io_handle_write_new_chunk(
 
 					return( -1 );
 				}
+				LIBEWF_TRACE_SEGMENT_FILE_FINALIZE(
+				 segment_file->segment_number,
+				 write_count );
+
 				total_write_count += write_count;
 			}
 		}
+		/* The segment file is synchronized once per completed chunks section
+		 * after the segment file was closed if it is full
+		 */
+		if( libewf_write_io_handle_sync_segment_file(
+		     write_io_handle,
+		     io_handle,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to synchronize segment file: %" PRIu32 ".",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
 	}
 	return( total_write_count );
 }
 
 /* Corrects sections after streamed write
+ * If multiple threads are used the first segment file is corrected on the calling thread,
+ * which generates the section data shared by the segment files, after which the other
+ * segment files are corrected in parallel
  * Returns 1 if successful or -1 on error
  */
 int libewf_write_io_handle_finalize_write_sections_corrections(
@@ -3504,16 +4010,19 @@ int libewf_write_io_handle_finalize_write_sections_corrections(
      libewf_hash_sections_t *hash_sections,
      libcdata_array_t *sessions,
      libcdata_array_t *tracks,
-     libcdata_range_list_t *acquiry_errors,
+     libewf_sector_range_list_t *acquiry_errors,
+     int number_of_threads,
      libcerror_error_t **error )
 {
-	libewf_segment_file_t *segment_file = NULL;
-	static char *function               = "libewf_write_io_handle_finalize_write_sections_corrections";
-	size64_t segment_file_size          = 0;
-	uint32_t number_of_segments         = 0;
-	uint32_t segment_number             = 0;
-	int file_io_pool_entry              = 0;
-	int last_segment_file               = 0;
+	libewf_segment_corrector_t *segment_corrector = NULL;
+	libewf_segment_file_t *segment_file           = NULL;
+	static char *function                         = "libewf_write_io_handle_finalize_write_sections_corrections";
+	size64_t segment_file_size                    = 0;
+	uint32_t number_of_segments                   = 0;
+	uint32_t number_of_serial_segments            = 0;
+	uint32_t segment_number                       = 0;
+	int file_io_pool_entry                        = 0;
+	int last_segment_file                         = 0;
 
 	if( write_io_handle == NULL )
 	{
@@ -3540,8 +4049,17 @@ int libewf_write_io_handle_finalize_write_sections_corrections(
 
 		return( -1 );
 	}
+	number_of_serial_segments = number_of_segments;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( ( number_of_threads > 1 )
+	 && ( number_of_segments > 2 ) )
+	{
+		number_of_serial_segments = 1;
+	}
+#endif
 	for( segment_number = 0;
-	     segment_number < number_of_segments;
+	     segment_number < number_of_serial_segments;
 	     segment_number++ )
 	{
 		if( segment_number == ( number_of_segments - 1 ) )
@@ -3628,6 +4146,69 @@ int libewf_write_io_handle_finalize_write_sections_corrections(
 			return( -1 );
 		}
 	}
+	if( number_of_serial_segments < number_of_segments )
+	{
+		if( libewf_segment_corrector_initialize(
+		     &segment_corrector,
+		     number_of_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create segment corrector.",
+			 function );
+
+			goto on_error;
+		}
+		if( libewf_segment_corrector_correct(
+		     segment_corrector,
+		     write_io_handle,
+		     file_io_pool,
+		     media_values,
+		     segment_table,
+		     header_values,
+		     hash_values,
+		     hash_sections,
+		     sessions,
+		     tracks,
+		     acquiry_errors,
+		     number_of_serial_segments,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write sections correction to segment files.",
+			 function );
+
+			goto on_error;
+		}
+		if( libewf_segment_corrector_free(
+		     &segment_corrector,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free segment corrector.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	return( 1 );
+
+on_error:
+	if( segment_corrector != NULL )
+	{
+		libewf_segment_corrector_free(
+		 &segment_corrector,
+		 NULL );
+	}
+	return( -1 );
 }
 
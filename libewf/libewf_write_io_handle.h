@@ -46,6 +46,7 @@
 #include "libewf_io_handle.h"
 #include "libewf_media_values.h"
 #include "libewf_read_io_handle.h"
+#include "libewf_sector_range_list.h"
 #include "libewf_segment_file.h"
 #include "libewf_segment_table.h"
 
@@ -200,6 +201,10 @@ struct libewf_write_io_handle
 	 */
 	uint8_t write_finalized;
 
+	/* The write synchronization (durability) policy
+	 */
+	uint8_t sync_policy;
+
 	/* The compressed zero byte empty block
 	 */
 	uint8_t *compressed_zero_byte_empty_block;
@@ -273,6 +278,7 @@ int libewf_write_io_handle_test_chunks_section_full(
      libcerror_error_t **error );
 
 int libewf_write_io_handle_create_segment_file(
+     libewf_write_io_handle_t *write_io_handle,
      libewf_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
      libewf_segment_table_t *segment_table,
@@ -284,6 +290,20 @@ int libewf_write_io_handle_create_segment_file(
      libewf_segment_file_t **segment_file,
      libcerror_error_t **error );
 
+int libewf_write_io_handle_sync_segment_file(
+     libewf_write_io_handle_t *write_io_handle,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libcerror_error_t **error );
+
+int libewf_write_io_handle_sync_segment_files(
+     libewf_write_io_handle_t *write_io_handle,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     libcerror_error_t **error );
+
 ssize_t libewf_write_io_handle_write_chunks_section_start(
          libewf_write_io_handle_t *write_io_handle,
          libewf_io_handle_t *io_handle,
@@ -311,7 +331,7 @@ ssize_t libewf_write_io_handle_write_new_chunk(
          libewf_hash_sections_t *hash_sections,
          libcdata_array_t *sessions,
          libcdata_array_t *tracks,
-         libcdata_range_list_t *acquiry_errors,
+         libewf_sector_range_list_t *acquiry_errors,
          uint64_t chunk_index,
          libewf_chunk_data_t *chunk_data,
          size_t input_data_size,
@@ -327,7 +347,8 @@ int libewf_write_io_handle_finalize_write_sections_corrections(
      libewf_hash_sections_t *hash_sections,
      libcdata_array_t *sessions,
      libcdata_array_t *tracks,
-     libcdata_range_list_t *acquiry_errors,
+     libewf_sector_range_list_t *acquiry_errors,
+     int number_of_threads,
      libcerror_error_t **error );
 
 #if defined( __cplusplus )
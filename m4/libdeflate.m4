@@ -0,0 +1,127 @@
+dnl Functions for libdeflate
+dnl
+dnl Version: 20261014
+
+dnl Function to detect if libdeflate is available
+AC_DEFUN([AX_LIBDEFLATE_CHECK_LIB],
+ [dnl Check if parameters were provided
+ AS_IF(
+  [test "x$ac_cv_with_libdeflate" != x && test "x$ac_cv_with_libdeflate" != xno && test "x$ac_cv_with_libdeflate" != xauto-detect],
+  [AS_IF(
+   [test -d "$ac_cv_with_libdeflate"],
+   [CFLAGS="$CFLAGS -I${ac_cv_with_libdeflate}/include"
+   LDFLAGS="$LDFLAGS -L${ac_cv_with_libdeflate}/lib"],
+   [AC_MSG_WARN([no such directory: $ac_cv_with_libdeflate])
+   ])
+  ])
+
+ AS_IF(
+  [test "x$ac_cv_with_libdeflate" = xno],
+  [ac_cv_libdeflate=no],
+  [dnl Check for a pkg-config file
+  AS_IF(
+   [test "x$cross_compiling" != "xyes" && test "x$PKGCONFIG" != "x"],
+   [PKG_CHECK_MODULES(
+    [libdeflate],
+    [libdeflate >= 1.0],
+    [ac_cv_libdeflate=libdeflate],
+    [ac_cv_libdeflate=no])
+   ])
+
+  AS_IF(
+   [test "x$ac_cv_libdeflate" = xlibdeflate],
+   [ac_cv_libdeflate_CPPFLAGS="$pkg_cv_libdeflate_CFLAGS"
+   ac_cv_libdeflate_LIBADD="$pkg_cv_libdeflate_LIBS"],
+   [dnl Check for headers
+   AC_CHECK_HEADERS([libdeflate.h])
+
+   AS_IF(
+    [test "x$ac_cv_header_libdeflate_h" = xno],
+    [ac_cv_libdeflate=no],
+    [dnl Check for the individual functions
+    ac_cv_libdeflate=libdeflate
+    AC_CHECK_LIB(
+     deflate,
+     libdeflate_alloc_decompressor,
+     [ac_libdeflate_dummy=yes],
+     [ac_cv_libdeflate=no])
+
+    AC_CHECK_LIB(
+     deflate,
+     libdeflate_zlib_decompress,
+     [ac_libdeflate_dummy=yes],
+     [ac_cv_libdeflate=no])
+
+    AC_CHECK_LIB(
+     deflate,
+     libdeflate_free_decompressor,
+     [ac_libdeflate_dummy=yes],
+     [ac_cv_libdeflate=no])
+
+    ac_cv_libdeflate_LIBADD="-ldeflate";
+    ])
+   ])
+  ])
+
+ AS_IF(
+  [test "x$ac_cv_libdeflate" = xlibdeflate],
+  [AC_DEFINE(
+   [HAVE_LIBDEFLATE],
+   [1],
+   [Define to 1 if you have the 'libdeflate' library (-ldeflate).])
+  ])
+
+ AS_IF(
+  [test "x$ac_cv_libdeflate" != xno],
+  [AC_SUBST(
+   [HAVE_LIBDEFLATE],
+   [1]) ],
+  [AC_SUBST(
+   [HAVE_LIBDEFLATE],
+   [0])
+  ])
+ ])
+
+dnl Function to detect how to enable libdeflate
+AC_DEFUN([AX_LIBDEFLATE_CHECK_ENABLE],
+ [AX_COMMON_ARG_WITH(
+  [libdeflate],
+  [libdeflate],
+  [search for libdeflate in includedir and libdir or in the specified DIR, or no if not to use libdeflate],
+  [auto-detect],
+  [DIR])
+
+ dnl Check for a shared library version
+ AX_LIBDEFLATE_CHECK_LIB
+
+ AS_IF(
+  [test "x$ac_cv_libdeflate_CPPFLAGS" != "x"],
+  [AC_SUBST(
+   [LIBDEFLATE_CPPFLAGS],
+   [$ac_cv_libdeflate_CPPFLAGS])
+  ])
+ AS_IF(
+  [test "x$ac_cv_libdeflate_LIBADD" != "x"],
+  [AC_SUBST(
+   [LIBDEFLATE_LIBADD],
+   [$ac_cv_libdeflate_LIBADD])
+  ])
+
+ AS_IF(
+  [test "x$ac_cv_libdeflate" = xlibdeflate],
+  [AC_SUBST(
+   [ax_libdeflate_pc_libs_private],
+   [-ldeflate])
+  ])
+
+ AS_IF(
+  [test "x$ac_cv_libdeflate" = xlibdeflate],
+  [AC_SUBST(
+   [ax_libdeflate_spec_requires],
+   [libdeflate])
+  AC_SUBST(
+   [ax_libdeflate_spec_build_requires],
+   [libdeflate-devel])
+  ])
+ ])
+
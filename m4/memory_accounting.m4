@@ -0,0 +1,22 @@
+dnl Functions for memory accounting
+dnl
+dnl Version: 20261015
+
+dnl Function to detect whether memory accounting should be enabled
+AC_DEFUN([AX_MEMORY_ACCOUNTING_CHECK_ENABLE],
+ [AX_COMMON_ARG_ENABLE(
+  [memory-accounting],
+  [memory_accounting],
+  [enable accounting of the memory allocated per subsystem],
+  [no])
+
+ AS_IF(
+  [test "x$ac_cv_enable_memory_accounting" != xno],
+  [AC_DEFINE(
+   [HAVE_LIBEWF_MEMORY_ACCOUNTING],
+   [1],
+   [Define to 1 if the memory allocated per subsystem should be accounted.])
+
+  ac_cv_enable_memory_accounting=yes])
+ ])
+
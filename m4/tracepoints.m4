@@ -0,0 +1,32 @@
+dnl Functions for static tracepoints
+dnl
+dnl Version: 20261015
+
+dnl Function to detect whether static tracepoints should be enabled
+dnl The tracepoints are USDT probes defined by sys/sdt.h, e.g. from systemtap-sdt-dev
+AC_DEFUN([AX_TRACEPOINTS_CHECK_ENABLE],
+ [AX_COMMON_ARG_ENABLE(
+  [tracepoints],
+  [tracepoints],
+  [enable static (USDT) tracepoints],
+  [no])
+
+ AS_IF(
+  [test "x$ac_cv_enable_tracepoints" != xno],
+  [dnl Check for headers
+  AC_CHECK_HEADERS([sys/sdt.h])
+
+  AS_IF(
+   [test "x$ac_cv_header_sys_sdt_h" = xno],
+   [AC_MSG_WARN([Missing header: sys/sdt.h tracepoints are disabled])
+
+   ac_cv_enable_tracepoints=no],
+   [AC_DEFINE(
+    [HAVE_LIBEWF_TRACEPOINTS],
+    [1],
+    [Define to 1 if static tracepoints should be used.])
+
+   ac_cv_enable_tracepoints=yes])
+  ])
+ ])
+
@@ -32,6 +32,8 @@
 #include "pyewf.h"
 #include "pyewf_compression_methods.h"
 #include "pyewf_error.h"
+#include "pyewf_chunk_view.h"
+#include "pyewf_chunks.h"
 #include "pyewf_file_entries.h"
 #include "pyewf_file_entry.h"
 #include "pyewf_file_object_io_handle.h"
@@ -849,6 +851,8 @@ PyMODINIT_FUNC initpyewf(
 #endif
 {
 	PyObject *module                              = NULL;
+	PyTypeObject *chunk_view_type_object          = NULL;
+	PyTypeObject *chunks_type_object              = NULL;
 	PyTypeObject *compression_methods_type_object = NULL;
 	PyTypeObject *file_entries_type_object        = NULL;
 	PyTypeObject *file_entry_type_object          = NULL;
@@ -886,6 +890,14 @@ PyMODINIT_FUNC initpyewf(
 		return;
 #endif
 	}
+#if defined( Py_GIL_DISABLED )
+	/* The module does not rely on the GIL, reads of a handle are serialized
+	 * by libewf or use the concurrent read path
+	 */
+	PyUnstable_Module_SetGIL(
+	 module,
+	 Py_MOD_GIL_NOT_USED );
+#endif
 	PyEval_InitThreads();
 
 	gil_state = PyGILState_Ensure();
@@ -1019,6 +1031,44 @@ PyMODINIT_FUNC initpyewf(
 	 "_file_entries",
 	 (PyObject *) file_entries_type_object );
 
+	/* Setup the chunk view type object
+	 */
+	pyewf_chunk_view_type_object.tp_new = PyType_GenericNew;
+
+	if( PyType_Ready(
+	     &pyewf_chunk_view_type_object ) < 0 )
+	{
+		goto on_error;
+	}
+	Py_IncRef(
+	 (PyObject *) &pyewf_chunk_view_type_object );
+
+	chunk_view_type_object = &pyewf_chunk_view_type_object;
+
+	PyModule_AddObject(
+	 module,
+	 "_chunk_view",
+	 (PyObject *) chunk_view_type_object );
+
+	/* Setup the chunks type object
+	 */
+	pyewf_chunks_type_object.tp_new = PyType_GenericNew;
+
+	if( PyType_Ready(
+	     &pyewf_chunks_type_object ) < 0 )
+	{
+		goto on_error;
+	}
+	Py_IncRef(
+	 (PyObject *) &pyewf_chunks_type_object );
+
+	chunks_type_object = &pyewf_chunks_type_object;
+
+	PyModule_AddObject(
+	 module,
+	 "_chunks",
+	 (PyObject *) chunks_type_object );
+
 	PyGILState_Release(
 	 gil_state );
 
@@ -0,0 +1,358 @@
+/*
+ * Python object definition of the libewf chunk view
+ *
+ * Copyright (C) 2008-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( HAVE_WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "pyewf_chunk_view.h"
+#include "pyewf_error.h"
+#include "pyewf_handle.h"
+#include "pyewf_libcerror.h"
+#include "pyewf_libewf.h"
+#include "pyewf_python.h"
+
+PyBufferProcs pyewf_chunk_view_buffer_procs = {
+#if PY_MAJOR_VERSION < 3
+	/* bf_getreadbuffer */
+	0,
+	/* bf_getwritebuffer */
+	0,
+	/* bf_getsegcount */
+	0,
+	/* bf_getcharbuffer */
+	0,
+#endif
+	/* bf_getbuffer */
+	(getbufferproc) pyewf_chunk_view_get_buffer,
+	/* bf_releasebuffer */
+	0
+};
+
+PyTypeObject pyewf_chunk_view_type_object = {
+	PyVarObject_HEAD_INIT( NULL, 0 )
+
+	/* tp_name */
+	"pyewf._chunk_view",
+	/* tp_basicsize */
+	sizeof( pyewf_chunk_view_t ),
+	/* tp_itemsize */
+	0,
+	/* tp_dealloc */
+	(destructor) pyewf_chunk_view_free,
+	/* tp_print */
+	0,
+	/* tp_getattr */
+	0,
+	/* tp_setattr */
+	0,
+	/* tp_compare */
+	0,
+	/* tp_repr */
+	0,
+	/* tp_as_number */
+	0,
+	/* tp_as_sequence */
+	0,
+	/* tp_as_mapping */
+	0,
+	/* tp_hash */
+	0,
+	/* tp_call */
+	0,
+	/* tp_str */
+	0,
+	/* tp_getattro */
+	0,
+	/* tp_setattro */
+	0,
+	/* tp_as_buffer */
+	&pyewf_chunk_view_buffer_procs,
+	/* tp_flags */
+#if PY_MAJOR_VERSION < 3
+	Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_NEWBUFFER,
+#else
+	Py_TPFLAGS_DEFAULT,
+#endif
+	/* tp_doc */
+	"pyewf internal object of a chunk view",
+	/* tp_traverse */
+	0,
+	/* tp_clear */
+	0,
+	/* tp_richcompare */
+	0,
+	/* tp_weaklistoffset */
+	0,
+	/* tp_iter */
+	0,
+	/* tp_iternext */
+	0,
+	/* tp_methods */
+	0,
+	/* tp_members */
+	0,
+	/* tp_getset */
+	0,
+	/* tp_base */
+	0,
+	/* tp_dict */
+	0,
+	/* tp_descr_get */
+	0,
+	/* tp_descr_set */
+	0,
+	/* tp_dictoffset */
+	0,
+	/* tp_init */
+	(initproc) pyewf_chunk_view_init,
+	/* tp_alloc */
+	0,
+	/* tp_new */
+	0,
+	/* tp_free */
+	0,
+	/* tp_is_gc */
+	0,
+	/* tp_bases */
+	NULL,
+	/* tp_mro */
+	NULL,
+	/* tp_cache */
+	NULL,
+	/* tp_subclasses */
+	NULL,
+	/* tp_weaklist */
+	NULL,
+	/* tp_del */
+	0
+};
+
+/* Creates a new chunk view object
+ * The chunk view object takes over the active chunk view of the handle, which is
+ * released when the chunk view object is freed
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyewf_chunk_view_new(
+           pyewf_handle_t *handle_object,
+           const uint8_t *data,
+           size_t data_size )
+{
+	pyewf_chunk_view_t *pyewf_chunk_view = NULL;
+	static char *function                = "pyewf_chunk_view_new";
+
+	if( handle_object == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid handle object.",
+		 function );
+
+		return( NULL );
+	}
+	if( data == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid data.",
+		 function );
+
+		return( NULL );
+	}
+	if( data_size > (size_t) PY_SSIZE_T_MAX )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( NULL );
+	}
+	pyewf_chunk_view = PyObject_New(
+	                    struct pyewf_chunk_view,
+	                    &pyewf_chunk_view_type_object );
+
+	if( pyewf_chunk_view == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to initialize chunk view.",
+		 function );
+
+		goto on_error;
+	}
+	if( pyewf_chunk_view_init(
+	     pyewf_chunk_view ) != 0 )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to initialize chunk view.",
+		 function );
+
+		goto on_error;
+	}
+	pyewf_chunk_view->handle_object = handle_object;
+	pyewf_chunk_view->data          = data;
+	pyewf_chunk_view->data_size     = data_size;
+
+	Py_IncRef(
+	 (PyObject *) pyewf_chunk_view->handle_object );
+
+	return( (PyObject *) pyewf_chunk_view );
+
+on_error:
+	if( pyewf_chunk_view != NULL )
+	{
+		Py_DecRef(
+		 (PyObject *) pyewf_chunk_view );
+	}
+	return( NULL );
+}
+
+/* Intializes a chunk view object
+ * Returns 0 if successful or -1 on error
+ */
+int pyewf_chunk_view_init(
+     pyewf_chunk_view_t *pyewf_chunk_view )
+{
+	static char *function = "pyewf_chunk_view_init";
+
+	if( pyewf_chunk_view == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid chunk view.",
+		 function );
+
+		return( -1 );
+	}
+	/* Make sure libewf chunk view is set to NULL
+	 */
+	pyewf_chunk_view->handle_object = NULL;
+	pyewf_chunk_view->data          = NULL;
+	pyewf_chunk_view->data_size     = 0;
+
+	return( 0 );
+}
+
+/* Frees a chunk view object
+ * This releases the chunk view of the handle
+ */
+void pyewf_chunk_view_free(
+      pyewf_chunk_view_t *pyewf_chunk_view )
+{
+	libcerror_error_t *error    = NULL;
+	struct _typeobject *ob_type = NULL;
+	static char *function       = "pyewf_chunk_view_free";
+	int result                  = 0;
+
+	if( pyewf_chunk_view == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid chunk view.",
+		 function );
+
+		return;
+	}
+	ob_type = Py_TYPE(
+	           pyewf_chunk_view );
+
+	if( ob_type == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: missing ob_type.",
+		 function );
+
+		return;
+	}
+	if( ob_type->tp_free == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid ob_type - missing tp_free.",
+		 function );
+
+		return;
+	}
+	if( pyewf_chunk_view->handle_object != NULL )
+	{
+		Py_BEGIN_ALLOW_THREADS
+
+		result = libewf_handle_release_chunk_view(
+		          pyewf_chunk_view->handle_object->handle,
+		          &error );
+
+		Py_END_ALLOW_THREADS
+
+		if( result != 1 )
+		{
+			pyewf_error_raise(
+			 error,
+			 PyExc_IOError,
+			 "%s: unable to release chunk view.",
+			 function );
+
+			libcerror_error_free(
+			 &error );
+		}
+		Py_DecRef(
+		 (PyObject *) pyewf_chunk_view->handle_object );
+	}
+	ob_type->tp_free(
+	 (PyObject*) pyewf_chunk_view );
+}
+
+/* Retrieves a read-only buffer of the chunk data
+ * Returns 0 if successful or -1 on error
+ */
+int pyewf_chunk_view_get_buffer(
+     pyewf_chunk_view_t *pyewf_chunk_view,
+     Py_buffer *buffer_view,
+     int flags )
+{
+	static char *function = "pyewf_chunk_view_get_buffer";
+
+	if( pyewf_chunk_view == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid chunk view.",
+		 function );
+
+		return( -1 );
+	}
+	/* The buffer view holds a reference to the chunk view object
+	 * so that the chunk data remains pinned while the buffer is used
+	 */
+	return( PyBuffer_FillInfo(
+	         buffer_view,
+	         (PyObject *) pyewf_chunk_view,
+	         (void *) pyewf_chunk_view->data,
+	         (Py_ssize_t) pyewf_chunk_view->data_size,
+	         1,
+	         flags ) );
+}
+
@@ -0,0 +1,80 @@
+/*
+ * Python object definition of the libewf chunk view
+ *
+ * Copyright (C) 2008-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _PYEWF_CHUNK_VIEW_H )
+#define _PYEWF_CHUNK_VIEW_H
+
+#include <common.h>
+#include <types.h>
+
+#include "pyewf_handle.h"
+#include "pyewf_libewf.h"
+#include "pyewf_python.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct pyewf_chunk_view pyewf_chunk_view_t;
+
+struct pyewf_chunk_view
+{
+	/* Python object initialization
+	 */
+	PyObject_HEAD
+
+	/* The handle object
+	 */
+	pyewf_handle_t *handle_object;
+
+	/* The chunk data
+	 */
+	const uint8_t *data;
+
+	/* The chunk data size
+	 */
+	size_t data_size;
+};
+
+extern PyTypeObject pyewf_chunk_view_type_object;
+
+PyObject *pyewf_chunk_view_new(
+           pyewf_handle_t *handle_object,
+           const uint8_t *data,
+           size_t data_size );
+
+int pyewf_chunk_view_init(
+     pyewf_chunk_view_t *pyewf_chunk_view );
+
+void pyewf_chunk_view_free(
+      pyewf_chunk_view_t *pyewf_chunk_view );
+
+int pyewf_chunk_view_get_buffer(
+     pyewf_chunk_view_t *pyewf_chunk_view,
+     Py_buffer *buffer_view,
+     int flags );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _PYEWF_CHUNK_VIEW_H ) */
+
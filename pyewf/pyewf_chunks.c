@@ -0,0 +1,739 @@
+/*
+ * Python object definition of the iterator object of chunks
+ *
+ * Copyright (C) 2008-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( HAVE_WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "pyewf_chunks.h"
+#include "pyewf_error.h"
+#include "pyewf_handle.h"
+#include "pyewf_libcerror.h"
+#include "pyewf_libewf.h"
+#include "pyewf_python.h"
+
+PyTypeObject pyewf_chunks_type_object = {
+	PyVarObject_HEAD_INIT( NULL, 0 )
+
+	/* tp_name */
+	"pyewf._chunks",
+	/* tp_basicsize */
+	sizeof( pyewf_chunks_t ),
+	/* tp_itemsize */
+	0,
+	/* tp_dealloc */
+	(destructor) pyewf_chunks_free,
+	/* tp_print */
+	0,
+	/* tp_getattr */
+	0,
+	/* tp_setattr */
+	0,
+	/* tp_compare */
+	0,
+	/* tp_repr */
+	0,
+	/* tp_as_number */
+	0,
+	/* tp_as_sequence */
+	0,
+	/* tp_as_mapping */
+	0,
+	/* tp_hash */
+	0,
+	/* tp_call */
+	0,
+	/* tp_str */
+	0,
+	/* tp_getattro */
+	0,
+	/* tp_setattro */
+	0,
+	/* tp_as_buffer */
+	0,
+	/* tp_flags */
+	Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_ITER,
+	/* tp_doc */
+	"pyewf internal iterator object of chunks",
+	/* tp_traverse */
+	0,
+	/* tp_clear */
+	0,
+	/* tp_richcompare */
+	0,
+	/* tp_weaklistoffset */
+	0,
+	/* tp_iter */
+	(getiterfunc) pyewf_chunks_iter,
+	/* tp_iternext */
+	(iternextfunc) pyewf_chunks_iternext,
+	/* tp_methods */
+	0,
+	/* tp_members */
+	0,
+	/* tp_getset */
+	0,
+	/* tp_base */
+	0,
+	/* tp_dict */
+	0,
+	/* tp_descr_get */
+	0,
+	/* tp_descr_set */
+	0,
+	/* tp_dictoffset */
+	0,
+	/* tp_init */
+	(initproc) pyewf_chunks_init,
+	/* tp_alloc */
+	0,
+	/* tp_new */
+	0,
+	/* tp_free */
+	0,
+	/* tp_is_gc */
+	0,
+	/* tp_bases */
+	NULL,
+	/* tp_mro */
+	NULL,
+	/* tp_cache */
+	NULL,
+	/* tp_subclasses */
+	NULL,
+	/* tp_weaklist */
+	NULL,
+	/* tp_del */
+	0
+};
+
+/* Creates a new chunks object
+ * The first chunk starts at the start offset and ends at the next chunk boundary
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyewf_chunks_new(
+           pyewf_handle_t *handle_object,
+           off64_t start_offset,
+           int prefetch )
+{
+	libcerror_error_t *error      = NULL;
+	pyewf_chunks_t *chunks_object = NULL;
+	static char *function         = "pyewf_chunks_new";
+	int read_index                = 0;
+	int result                    = 0;
+
+	if( handle_object == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid handle object.",
+		 function );
+
+		return( NULL );
+	}
+	if( start_offset < 0 )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid start offset value less than zero.",
+		 function );
+
+		return( NULL );
+	}
+	if( ( prefetch < 1 )
+	 || ( prefetch > PYEWF_CHUNKS_MAXIMUM_PREFETCH ) )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid prefetch value out of bounds.",
+		 function );
+
+		return( NULL );
+	}
+	/* Make sure the chunks values are initialized
+	 */
+	chunks_object = PyObject_New(
+	                 struct pyewf_chunks,
+	                 &pyewf_chunks_type_object );
+
+	if( chunks_object == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to create chunks object.",
+		 function );
+
+		goto on_error;
+	}
+	if( pyewf_chunks_init(
+	     chunks_object ) != 0 )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to initialize chunks object.",
+		 function );
+
+		goto on_error;
+	}
+	chunks_object->handle_object = handle_object;
+
+	Py_IncRef(
+	 (PyObject *) chunks_object->handle_object );
+
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libewf_handle_get_media_size(
+	          handle_object->handle,
+	          &( chunks_object->media_size ),
+	          &error );
+
+	if( result == 1 )
+	{
+		result = libewf_handle_get_chunk_size(
+		          handle_object->handle,
+		          &( chunks_object->chunk_size ),
+		          &error );
+	}
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pyewf_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to retrieve media size or chunk size.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		goto on_error;
+	}
+	if( chunks_object->chunk_size == 0 )
+	{
+		PyErr_Format(
+		 PyExc_IOError,
+		 "%s: invalid chunk size value zero or less.",
+		 function );
+
+		goto on_error;
+	}
+	chunks_object->reads = (pyewf_chunks_read_t *) PyMem_Malloc(
+	                                                sizeof( pyewf_chunks_read_t ) * prefetch );
+
+	if( chunks_object->reads == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to create reads.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     chunks_object->reads,
+	     0,
+	     sizeof( pyewf_chunks_read_t ) * prefetch ) == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to clear reads.",
+		 function );
+
+		goto on_error;
+	}
+	chunks_object->number_of_reads = prefetch;
+
+	for( read_index = 0;
+	     read_index < prefetch;
+	     read_index++ )
+	{
+		chunks_object->reads[ read_index ].pending_lock = PyThread_allocate_lock();
+
+		if( chunks_object->reads[ read_index ].pending_lock == NULL )
+		{
+			PyErr_Format(
+			 PyExc_MemoryError,
+			 "%s: unable to create pending lock: %d.",
+			 function,
+			 read_index );
+
+			goto on_error;
+		}
+	}
+	chunks_object->next_offset = start_offset;
+
+	/* Submit the initial reads, the remaining reads are submitted as the chunks are consumed
+	 */
+	for( read_index = 0;
+	     read_index < prefetch;
+	     read_index++ )
+	{
+		result = pyewf_chunks_submit_read(
+		          chunks_object );
+
+		if( result == -1 )
+		{
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+	}
+	return( (PyObject *) chunks_object );
+
+on_error:
+	if( chunks_object != NULL )
+	{
+		Py_DecRef(
+		 (PyObject *) chunks_object );
+	}
+	return( NULL );
+}
+
+/* Intializes a chunks object
+ * Returns 0 if successful or -1 on error
+ */
+int pyewf_chunks_init(
+     pyewf_chunks_t *chunks_object )
+{
+	static char *function = "pyewf_chunks_init";
+
+	if( chunks_object == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid chunks object.",
+		 function );
+
+		return( -1 );
+	}
+	/* Make sure the chunks values are initialized
+	 */
+	chunks_object->handle_object           = NULL;
+	chunks_object->media_size              = 0;
+	chunks_object->chunk_size              = 0;
+	chunks_object->next_offset             = 0;
+	chunks_object->reads                   = NULL;
+	chunks_object->number_of_reads         = 0;
+	chunks_object->first_read_index        = 0;
+	chunks_object->number_of_pending_reads = 0;
+
+	return( 0 );
+}
+
+/* Frees a chunks object
+ * This waits for the pending reads to complete
+ */
+void pyewf_chunks_free(
+      pyewf_chunks_t *chunks_object )
+{
+	struct _typeobject *ob_type = NULL;
+	static char *function       = "pyewf_chunks_free";
+	int read_index              = 0;
+
+	if( chunks_object == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid chunks object.",
+		 function );
+
+		return;
+	}
+	ob_type = Py_TYPE(
+	           chunks_object );
+
+	if( ob_type == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: missing ob_type.",
+		 function );
+
+		return;
+	}
+	if( ob_type->tp_free == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid ob_type - missing tp_free.",
+		 function );
+
+		return;
+	}
+	if( chunks_object->reads != NULL )
+	{
+		/* The pending reads write into the bytes objects of the reads
+		 */
+		while( chunks_object->number_of_pending_reads > 0 )
+		{
+			pyewf_chunks_wait_for_read(
+			 &( chunks_object->reads[ chunks_object->first_read_index ] ) );
+
+			chunks_object->first_read_index += 1;
+
+			if( chunks_object->first_read_index >= chunks_object->number_of_reads )
+			{
+				chunks_object->first_read_index = 0;
+			}
+			chunks_object->number_of_pending_reads -= 1;
+		}
+		for( read_index = 0;
+		     read_index < chunks_object->number_of_reads;
+		     read_index++ )
+		{
+			if( chunks_object->reads[ read_index ].bytes_object != NULL )
+			{
+				Py_DecRef(
+				 chunks_object->reads[ read_index ].bytes_object );
+			}
+			if( chunks_object->reads[ read_index ].pending_lock != NULL )
+			{
+				PyThread_free_lock(
+				 chunks_object->reads[ read_index ].pending_lock );
+			}
+		}
+		PyMem_Free(
+		 chunks_object->reads );
+	}
+	if( chunks_object->handle_object != NULL )
+	{
+		Py_DecRef(
+		 (PyObject *) chunks_object->handle_object );
+	}
+	ob_type->tp_free(
+	 (PyObject*) chunks_object );
+}
+
+/* Completes a read
+ * This function is called by libewf on one of its worker threads, it does not
+ * acquire the GIL but only stores the result and releases the pending lock
+ */
+void pyewf_chunks_read_completed(
+      void *callback_data,
+      ssize_t read_count,
+      libcerror_error_t *error )
+{
+	pyewf_chunks_read_t *read = NULL;
+
+	if( callback_data == NULL )
+	{
+		return;
+	}
+	read = (pyewf_chunks_read_t *) callback_data;
+
+	read->read_count        = read_count;
+	read->error_string[ 0 ] = 0;
+
+	/* The error is freed after the callback returns
+	 */
+	if( ( read_count <= -1 )
+	 && ( error != NULL ) )
+	{
+		if( libcerror_error_backtrace_sprint(
+		     error,
+		     read->error_string,
+		     PYEWF_ERROR_STRING_SIZE ) <= 0 )
+		{
+			read->error_string[ 0 ] = 0;
+		}
+	}
+	PyThread_release_lock(
+	 read->pending_lock );
+}
+
+/* Submits a read of the next chunk
+ * Make sure to hold the GIL state before calling this function
+ * Returns 1 if successful, 0 if there are no more chunks or no free read or -1 on error
+ */
+int pyewf_chunks_submit_read(
+     pyewf_chunks_t *chunks_object )
+{
+	libcerror_error_t *error  = NULL;
+	pyewf_chunks_read_t *read = NULL;
+	static char *function     = "pyewf_chunks_submit_read";
+	size64_t read_size        = 0;
+	int read_index            = 0;
+	int result                = 0;
+
+	if( chunks_object == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid chunks object.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunks_object->next_offset < 0 )
+	 || ( (size64_t) chunks_object->next_offset >= chunks_object->media_size ) )
+	{
+		return( 0 );
+	}
+	if( chunks_object->number_of_pending_reads >= chunks_object->number_of_reads )
+	{
+		return( 0 );
+	}
+	read_index = chunks_object->first_read_index + chunks_object->number_of_pending_reads;
+
+	if( read_index >= chunks_object->number_of_reads )
+	{
+		read_index -= chunks_object->number_of_reads;
+	}
+	read = &( chunks_object->reads[ read_index ] );
+
+	/* Read up to the next chunk boundary
+	 */
+	read_size = chunks_object->chunk_size
+	          - ( (size64_t) chunks_object->next_offset % chunks_object->chunk_size );
+
+	if( read_size > ( chunks_object->media_size - (size64_t) chunks_object->next_offset ) )
+	{
+		read_size = chunks_object->media_size - (size64_t) chunks_object->next_offset;
+	}
+	/* Each read uses a new bytes object, since the previous one is referenced by the memoryview of the consumer
+	 */
+	read->bytes_object = PyBytes_FromStringAndSize(
+	                      NULL,
+	                      (Py_ssize_t) read_size );
+
+	if( read->bytes_object == NULL )
+	{
+		return( -1 );
+	}
+	read->offset     = chunks_object->next_offset;
+	read->read_count = 0;
+
+	/* The pending lock is released by the completion callback
+	 */
+	PyThread_acquire_lock(
+	 read->pending_lock,
+	 WAIT_LOCK );
+
+	/* The GIL is released since submitting the read can wait for other reads to complete
+	 */
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libewf_handle_read_buffer_at_offset_async(
+	          chunks_object->handle_object->handle,
+	          (uint8_t *) PyBytes_AS_STRING( read->bytes_object ),
+	          (size_t) read_size,
+	          read->offset,
+	          &pyewf_chunks_read_completed,
+	          (void *) read,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pyewf_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to submit read at offset: %" PRIi64 ".",
+		 function,
+		 read->offset );
+
+		libcerror_error_free(
+		 &error );
+
+		/* The completion callback is not called if the read could not be submitted
+		 */
+		PyThread_release_lock(
+		 read->pending_lock );
+
+		Py_DecRef(
+		 read->bytes_object );
+
+		read->bytes_object = NULL;
+
+		return( -1 );
+	}
+	chunks_object->next_offset             += (off64_t) read_size;
+	chunks_object->number_of_pending_reads += 1;
+
+	return( 1 );
+}
+
+/* Waits for a pending read to complete
+ * Make sure to hold the GIL state before calling this function
+ */
+void pyewf_chunks_wait_for_read(
+      pyewf_chunks_read_t *read )
+{
+	if( read == NULL )
+	{
+		return;
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	PyThread_acquire_lock(
+	 read->pending_lock,
+	 WAIT_LOCK );
+
+	PyThread_release_lock(
+	 read->pending_lock );
+
+	Py_END_ALLOW_THREADS
+}
+
+/* The chunks iter() function
+ */
+PyObject *pyewf_chunks_iter(
+           pyewf_chunks_t *chunks_object )
+{
+	static char *function = "pyewf_chunks_iter";
+
+	if( chunks_object == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid chunks object.",
+		 function );
+
+		return( NULL );
+	}
+	Py_IncRef(
+	 (PyObject *) chunks_object );
+
+	return( (PyObject *) chunks_object );
+}
+
+/* The chunks iternext() function
+ * Returns a Python object holding a tuple of the offset and a memoryview of the chunk data if successful or NULL on error or when there are no more chunks
+ */
+PyObject *pyewf_chunks_iternext(
+           pyewf_chunks_t *chunks_object )
+{
+	pyewf_chunks_read_t *read = NULL;
+	PyObject *bytes_object    = NULL;
+	PyObject *tuple_object    = NULL;
+	PyObject *view_object     = NULL;
+	static char *function     = "pyewf_chunks_iternext";
+	off64_t offset            = 0;
+
+	if( chunks_object == NULL )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid chunks object.",
+		 function );
+
+		return( NULL );
+	}
+	if( chunks_object->number_of_pending_reads <= 0 )
+	{
+		PyErr_SetNone(
+		 PyExc_StopIteration );
+
+		return( NULL );
+	}
+	read = &( chunks_object->reads[ chunks_object->first_read_index ] );
+
+	pyewf_chunks_wait_for_read(
+	 read );
+
+	chunks_object->first_read_index += 1;
+
+	if( chunks_object->first_read_index >= chunks_object->number_of_reads )
+	{
+		chunks_object->first_read_index = 0;
+	}
+	chunks_object->number_of_pending_reads -= 1;
+
+	bytes_object = read->bytes_object;
+	offset       = read->offset;
+
+	read->bytes_object = NULL;
+
+	if( read->read_count <= -1 )
+	{
+		PyErr_Format(
+		 PyExc_IOError,
+		 "%s: unable to read chunk at offset: %" PRIi64 ".%s%s",
+		 function,
+		 offset,
+		 ( read->error_string[ 0 ] != 0 ) ? " " : "",
+		 read->error_string );
+
+		/* Stop submitting reads, the reads that are pending are returned by the next calls
+		 */
+		chunks_object->next_offset = (off64_t) chunks_object->media_size;
+
+		goto on_error;
+	}
+	/* Need to resize the bytes object here in case the chunk was not fully read
+	 */
+	if( _PyBytes_Resize(
+	     &bytes_object,
+	     (Py_ssize_t) read->read_count ) != 0 )
+	{
+		goto on_error;
+	}
+	if( read->read_count == 0 )
+	{
+		chunks_object->next_offset = (off64_t) chunks_object->media_size;
+	}
+	/* Keep the worker threads busy while the caller processes the chunk
+	 */
+	if( pyewf_chunks_submit_read(
+	     chunks_object ) == -1 )
+	{
+		goto on_error;
+	}
+	view_object = PyMemoryView_FromObject(
+	               bytes_object );
+
+	if( view_object == NULL )
+	{
+		goto on_error;
+	}
+	Py_DecRef(
+	 bytes_object );
+
+	bytes_object = NULL;
+
+	tuple_object = Py_BuildValue(
+	                "(LN)",
+	                (PY_LONG_LONG) offset,
+	                view_object );
+
+	if( tuple_object == NULL )
+	{
+		goto on_error;
+	}
+	return( tuple_object );
+
+on_error:
+	if( bytes_object != NULL )
+	{
+		Py_DecRef(
+		 bytes_object );
+	}
+	return( NULL );
+}
+
@@ -0,0 +1,151 @@
+/*
+ * Python object definition of the iterator object of chunks
+ *
+ * Copyright (C) 2008-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _PYEWF_CHUNKS_H )
+#define _PYEWF_CHUNKS_H
+
+#include <common.h>
+#include <types.h>
+
+#include "pyewf_error.h"
+#include "pyewf_handle.h"
+#include "pyewf_libcerror.h"
+#include "pyewf_libewf.h"
+#include "pyewf_python.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The default number of chunks that are read ahead
+ */
+#define PYEWF_CHUNKS_DEFAULT_PREFETCH		4
+
+/* The maximum number of chunks that are read ahead
+ */
+#define PYEWF_CHUNKS_MAXIMUM_PREFETCH		64
+
+typedef struct pyewf_chunks_read pyewf_chunks_read_t;
+
+struct pyewf_chunks_read
+{
+	/* The bytes object that receives the data
+	 */
+	PyObject *bytes_object;
+
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The number of bytes read or -1 on error
+	 */
+	ssize_t read_count;
+
+	/* The error string
+	 */
+	char error_string[ PYEWF_ERROR_STRING_SIZE ];
+
+	/* The lock that is held while the read is pending
+	 */
+	PyThread_type_lock pending_lock;
+};
+
+typedef struct pyewf_chunks pyewf_chunks_t;
+
+/* The chunks object iterates the media data in chunk sized blocks
+ * The upcoming chunks are read asynchronously, by the worker threads of libewf,
+ * such that they are decompressed while the caller processes the current chunk
+ */
+struct pyewf_chunks
+{
+	/* Python object initialization
+	 */
+	PyObject_HEAD
+
+	/* The handle object
+	 */
+	pyewf_handle_t *handle_object;
+
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The chunk size
+	 */
+	size32_t chunk_size;
+
+	/* The offset of the next read
+	 */
+	off64_t next_offset;
+
+	/* The ring of reads
+	 */
+	pyewf_chunks_read_t *reads;
+
+	/* The number of reads in the ring
+	 */
+	int number_of_reads;
+
+	/* The index of the first pending read
+	 */
+	int first_read_index;
+
+	/* The number of pending reads
+	 */
+	int number_of_pending_reads;
+};
+
+extern PyTypeObject pyewf_chunks_type_object;
+
+PyObject *pyewf_chunks_new(
+           pyewf_handle_t *handle_object,
+           off64_t start_offset,
+           int prefetch );
+
+int pyewf_chunks_init(
+     pyewf_chunks_t *chunks_object );
+
+void pyewf_chunks_free(
+      pyewf_chunks_t *chunks_object );
+
+void pyewf_chunks_read_completed(
+      void *callback_data,
+      ssize_t read_count,
+      libcerror_error_t *error );
+
+int pyewf_chunks_submit_read(
+     pyewf_chunks_t *chunks_object );
+
+void pyewf_chunks_wait_for_read(
+      pyewf_chunks_read_t *read );
+
+PyObject *pyewf_chunks_iter(
+           pyewf_chunks_t *chunks_object );
+
+PyObject *pyewf_chunks_iternext(
+           pyewf_chunks_t *chunks_object );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _PYEWF_CHUNKS_H ) */
+
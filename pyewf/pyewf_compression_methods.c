@@ -186,6 +186,20 @@ int pyewf_compression_methods_init_type(
 	{
 		goto on_error;
 	}
+#if PY_MAJOR_VERSION >= 3
+	value_object = PyLong_FromLong(
+	                LIBEWF_COMPRESSION_METHOD_ZSTD );
+#else
+	value_object = PyInt_FromLong(
+	                LIBEWF_COMPRESSION_METHOD_ZSTD );
+#endif
+	if( PyDict_SetItemString(
+	     type_object->tp_dict,
+	     "ZSTD",
+	     value_object ) != 0 )
+	{
+		goto on_error;
+	}
 	return( 1 );
 
 on_error:
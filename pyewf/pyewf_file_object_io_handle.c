@@ -21,8 +21,21 @@
 
 #include <common.h>
 #include <memory.h>
+#include <narrow_string.h>
 #include <types.h>
 
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
 #include "pyewf_error.h"
 #include "pyewf_file_object_io_handle.h"
 #include "pyewf_integer.h"
@@ -39,7 +52,9 @@ int pyewf_file_object_io_handle_initialize(
      PyObject *file_object,
      libcerror_error_t **error )
 {
-	static char *function = "pyewf_file_object_io_handle_initialize";
+	static char *function      = "pyewf_file_object_io_handle_initialize";
+	PyGILState_STATE gil_state = 0;
+	int result                 = 0;
 
 	if( file_object_io_handle == NULL )
 	{
@@ -102,6 +117,46 @@ int pyewf_file_object_io_handle_initialize(
 
 		goto on_error;
 	}
+	( *file_object_io_handle )->file_descriptor = -1;
+
+	gil_state = PyGILState_Ensure();
+
+#if defined( HAVE_PYEWF_FILE_OBJECT_FILE_DESCRIPTOR )
+	/* If the file object is an operating system file its data is read directly
+	 * from the file descriptor, without having to re-enter Python for every read
+	 */
+	result = pyewf_file_object_get_file_descriptor(
+	          file_object,
+	          &( ( *file_object_io_handle )->file_descriptor ),
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file descriptor of file object.",
+		 function );
+
+		PyGILState_Release(
+		 gil_state );
+
+		goto on_error;
+	}
+#endif
+#if PY_MAJOR_VERSION >= 3
+	/* Otherwise data is read directly into the buffer if the file object has a readinto method
+	 */
+	result = PyObject_HasAttrString(
+	          file_object,
+	          "readinto" );
+
+	( *file_object_io_handle )->has_readinto = ( result != 0 );
+#endif
+	PyGILState_Release(
+	 gil_state );
+
 	( *file_object_io_handle )->file_object = file_object;
 
 	Py_IncRef(
@@ -204,6 +259,127 @@ on_error:
 	return( -1 );
 }
 
+/* Retrieves a file descriptor of the file object
+ * Only the file descriptor of a regular file opened by a built-in file type is used,
+ * since other file (like) objects can change the data that is read
+ * The file descriptor is duplicated and must be closed by the caller
+ * Make sure to hold the GIL state before calling this function
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int pyewf_file_object_get_file_descriptor(
+     PyObject *file_object,
+     int *file_descriptor,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_PYEWF_FILE_OBJECT_FILE_DESCRIPTOR )
+	struct stat file_statistics;
+
+	const char *type_name      = NULL;
+	int object_file_descriptor = -1;
+#endif
+
+	static char *function      = "pyewf_file_object_get_file_descriptor";
+
+	if( file_object == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file object.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	*file_descriptor = -1;
+
+#if defined( HAVE_PYEWF_FILE_OBJECT_FILE_DESCRIPTOR )
+#if PY_MAJOR_VERSION >= 3
+	type_name = Py_TYPE(
+	             file_object )->tp_name;
+
+	if( type_name == NULL )
+	{
+		return( 0 );
+	}
+	if( ( narrow_string_compare(
+	       type_name,
+	       "_io.FileIO",
+	       11 ) != 0 )
+	 && ( narrow_string_compare(
+	       type_name,
+	       "_io.BufferedReader",
+	       19 ) != 0 )
+	 && ( narrow_string_compare(
+	       type_name,
+	       "_io.BufferedRandom",
+	       19 ) != 0 ) )
+	{
+		return( 0 );
+	}
+#else
+	if( PyFile_CheckExact(
+	     file_object ) == 0 )
+	{
+		return( 0 );
+	}
+#endif
+	PyErr_Clear();
+
+	object_file_descriptor = PyObject_AsFileDescriptor(
+	                          file_object );
+
+	if( object_file_descriptor == -1 )
+	{
+		PyErr_Clear();
+
+		return( 0 );
+	}
+	if( fstat(
+	     object_file_descriptor,
+	     &file_statistics ) != 0 )
+	{
+		return( 0 );
+	}
+	if( !S_ISREG( file_statistics.st_mode ) )
+	{
+		return( 0 );
+	}
+	/* Duplicate the file descriptor so that it remains valid
+	 * independent of the file object
+	 */
+	*file_descriptor = dup(
+	                    object_file_descriptor );
+
+	if( *file_descriptor == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 errno,
+		 "%s: unable to duplicate file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+#else
+	return( 0 );
+#endif
+}
+
 /* Frees a file object IO handle
  * Returns 1 if succesful or -1 on error
  */
@@ -227,6 +403,13 @@ int pyewf_file_object_io_handle_free(
 	}
 	if( *file_object_io_handle != NULL )
 	{
+#if defined( HAVE_PYEWF_FILE_OBJECT_FILE_DESCRIPTOR )
+		if( ( *file_object_io_handle )->file_descriptor != -1 )
+		{
+			close(
+			 ( *file_object_io_handle )->file_descriptor );
+		}
+#endif
 		gil_state = PyGILState_Ensure();
 
 		Py_DecRef(
@@ -613,6 +796,194 @@ on_error:
 	return( -1 );
 }
 
+/* Reads a buffer from the file object using its readinto method
+ * The data is read directly into the buffer without an intermediate binary string object
+ * Make sure to hold the GIL state before calling this function
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t pyewf_file_object_readinto_buffer(
+         PyObject *file_object,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	PyObject *memoryview_object = NULL;
+	PyObject *method_name       = NULL;
+	PyObject *method_result     = NULL;
+	static char *function       = "pyewf_file_object_readinto_buffer";
+	int64_t safe_read_count     = 0;
+	ssize_t read_count          = 0;
+
+	if( file_object == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file object.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if PY_MAJOR_VERSION >= 3
+	if( size > 0 )
+	{
+		memoryview_object = PyMemoryView_FromMemory(
+		                     (char *) buffer,
+		                     (Py_ssize_t) size,
+		                     PyBUF_WRITE );
+
+		if( memoryview_object == NULL )
+		{
+			pyewf_error_fetch(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create memoryview object.",
+			 function );
+
+			goto on_error;
+		}
+		method_name = PyUnicode_FromString(
+			       "readinto" );
+
+		PyErr_Clear();
+
+		method_result = PyObject_CallMethodObjArgs(
+				 file_object,
+				 method_name,
+				 memoryview_object,
+				 NULL );
+
+		if( PyErr_Occurred() )
+		{
+			pyewf_error_fetch(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read from file object.",
+			 function );
+
+			goto on_error;
+		}
+		if( method_result == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing method result.",
+			 function );
+
+			goto on_error;
+		}
+		/* A file object in non-blocking mode returns None if no data is available
+		 */
+		if( method_result != Py_None )
+		{
+			if( pyewf_integer_signed_copy_to_64bit(
+			     method_result,
+			     &safe_read_count,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to convert method result into read count.",
+				 function );
+
+				goto on_error;
+			}
+			if( ( safe_read_count < 0 )
+			 || ( (uint64_t) safe_read_count > (uint64_t) size ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid read count value out of bounds.",
+				 function );
+
+				goto on_error;
+			}
+			read_count = (ssize_t) safe_read_count;
+		}
+		Py_DecRef(
+		 method_result );
+
+		Py_DecRef(
+		 method_name );
+
+		/* The memoryview object refers to the buffer and should not outlive this call
+		 */
+		method_result = PyObject_CallMethod(
+		                 memoryview_object,
+		                 "release",
+		                 NULL );
+
+		if( method_result == NULL )
+		{
+			PyErr_Clear();
+		}
+		else
+		{
+			Py_DecRef(
+			 method_result );
+		}
+		Py_DecRef(
+		 memoryview_object );
+	}
+	return( read_count );
+
+on_error:
+	if( method_result != NULL )
+	{
+		Py_DecRef(
+		 method_result );
+	}
+	if( method_name != NULL )
+	{
+		Py_DecRef(
+		 method_name );
+	}
+	if( memoryview_object != NULL )
+	{
+		Py_DecRef(
+		 memoryview_object );
+	}
+	return( -1 );
+#else
+	return( pyewf_file_object_read_buffer(
+	         file_object,
+	         buffer,
+	         size,
+	         error ) );
+#endif
+}
+
 /* Reads a buffer from the file object IO handle
  * Returns the number of bytes read if successful, or -1 on error
  */
@@ -637,14 +1008,85 @@ ssize_t pyewf_file_object_io_handle_read(
 
 		return( -1 );
 	}
+#if defined( HAVE_PYEWF_FILE_OBJECT_FILE_DESCRIPTOR )
+	/* Read directly from the file descriptor without holding the GIL
+	 */
+	if( file_object_io_handle->file_descriptor != -1 )
+	{
+		if( size > (size_t) SSIZE_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		read_count = pread(
+		              file_object_io_handle->file_descriptor,
+		              buffer,
+		              size,
+		              (off_t) file_object_io_handle->current_offset );
+
+		if( read_count < 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 errno,
+			 "%s: unable to read from file descriptor.",
+			 function );
+
+			return( -1 );
+		}
+		file_object_io_handle->current_offset += (off64_t) read_count;
+
+		return( read_count );
+	}
+#endif
 	gil_state = PyGILState_Ensure();
 
-	read_count = pyewf_file_object_read_buffer(
-	              file_object_io_handle->file_object,
-	              buffer,
-	              size,
-	              error );
+	/* The seek is deferred until the read, so that reading at an offset
+	 * only requires a single acquisition of the GIL
+	 */
+	if( file_object_io_handle->seek_on_read != 0 )
+	{
+		if( pyewf_file_object_seek_offset(
+		     file_object_io_handle->file_object,
+		     file_object_io_handle->current_offset,
+		     SEEK_SET,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek in file object.",
+			 function );
 
+			goto on_error;
+		}
+		file_object_io_handle->seek_on_read = 0;
+	}
+	if( file_object_io_handle->has_readinto != 0 )
+	{
+		read_count = pyewf_file_object_readinto_buffer(
+		              file_object_io_handle->file_object,
+		              buffer,
+		              size,
+		              error );
+	}
+	else
+	{
+		read_count = pyewf_file_object_read_buffer(
+		              file_object_io_handle->file_object,
+		              buffer,
+		              size,
+		              error );
+	}
 	if( read_count == -1 )
 	{
 		libcerror_error_set(
@@ -659,6 +1101,8 @@ ssize_t pyewf_file_object_io_handle_read(
 	PyGILState_Release(
 	 gil_state );
 
+	file_object_io_handle->current_offset += (off64_t) read_count;
+
 	return( read_count );
 
 on_error:
@@ -1138,6 +1582,10 @@ off64_t pyewf_file_object_io_handle_seek_offset(
          int whence,
          libcerror_error_t **error )
 {
+#if defined( HAVE_PYEWF_FILE_OBJECT_FILE_DESCRIPTOR )
+	struct stat file_statistics;
+#endif
+
 	static char *function      = "pyewf_file_object_io_handle_seek_offset";
 	PyGILState_STATE gil_state = 0;
 
@@ -1152,6 +1600,76 @@ off64_t pyewf_file_object_io_handle_seek_offset(
 
 		return( -1 );
 	}
+#if defined( HAVE_PYEWF_FILE_OBJECT_FILE_DESCRIPTOR )
+	if( file_object_io_handle->file_descriptor != -1 )
+	{
+		if( whence == SEEK_CUR )
+		{
+			offset += file_object_io_handle->current_offset;
+		}
+		else if( whence == SEEK_END )
+		{
+			if( fstat(
+			     file_object_io_handle->file_descriptor,
+			     &file_statistics ) != 0 )
+			{
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 errno,
+				 "%s: unable to retrieve file statistics.",
+				 function );
+
+				return( -1 );
+			}
+			offset += (off64_t) file_statistics.st_size;
+		}
+		else if( whence != SEEK_SET )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported whence.",
+			 function );
+
+			return( -1 );
+		}
+		if( offset < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: invalid offset value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		file_object_io_handle->current_offset = offset;
+
+		return( offset );
+	}
+#endif
+	/* Seeking a specific offset is deferred until the next read
+	 */
+	if( ( whence == SEEK_SET )
+	 && ( offset >= 0 ) )
+	{
+		file_object_io_handle->current_offset = offset;
+		file_object_io_handle->seek_on_read   = 1;
+
+		return( offset );
+	}
+	/* A relative seek is relative to the deferred offset
+	 */
+	if( ( whence == SEEK_CUR )
+	 && ( file_object_io_handle->seek_on_read != 0 ) )
+	{
+		offset += file_object_io_handle->current_offset;
+		whence  = SEEK_SET;
+	}
 	gil_state = PyGILState_Ensure();
 
 	if( pyewf_file_object_seek_offset(
@@ -1186,6 +1704,9 @@ off64_t pyewf_file_object_io_handle_seek_offset(
 	PyGILState_Release(
 	 gil_state );
 
+	file_object_io_handle->current_offset = offset;
+	file_object_io_handle->seek_on_read   = 0;
+
 	return( offset );
 
 on_error:
@@ -1373,6 +1894,10 @@ int pyewf_file_object_io_handle_get_size(
      size64_t *size,
      libcerror_error_t **error )
 {
+#if defined( HAVE_PYEWF_FILE_OBJECT_FILE_DESCRIPTOR )
+	struct stat file_statistics;
+#endif
+
 	PyObject *method_name      = NULL;
 	static char *function      = "pyewf_file_object_io_handle_get_size";
 	PyGILState_STATE gil_state = 0;
@@ -1401,6 +1926,39 @@ int pyewf_file_object_io_handle_get_size(
 
 		return( -1 );
 	}
+#if defined( HAVE_PYEWF_FILE_OBJECT_FILE_DESCRIPTOR )
+	if( file_object_io_handle->file_descriptor != -1 )
+	{
+		if( size == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid size.",
+			 function );
+
+			return( -1 );
+		}
+		if( fstat(
+		     file_object_io_handle->file_descriptor,
+		     &file_statistics ) != 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 errno,
+			 "%s: unable to retrieve file statistics.",
+			 function );
+
+			return( -1 );
+		}
+		*size = (size64_t) file_statistics.st_size;
+
+		return( 1 );
+	}
+#endif
 	gil_state = PyGILState_Ensure();
 
 #if PY_MAJOR_VERSION >= 3
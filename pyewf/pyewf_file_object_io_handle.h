@@ -33,6 +33,10 @@
 extern "C" {
 #endif
 
+#if defined( HAVE_UNISTD_H ) && defined( HAVE_DUP ) && defined( HAVE_FSTAT ) && defined( HAVE_PREAD ) && !defined( WINAPI )
+#define HAVE_PYEWF_FILE_OBJECT_FILE_DESCRIPTOR
+#endif
+
 typedef struct pyewf_file_object_io_handle pyewf_file_object_io_handle_t;
 
 struct pyewf_file_object_io_handle
@@ -44,6 +48,24 @@ struct pyewf_file_object_io_handle
 	/* The access flags
 	 */
 	int access_flags;
+
+	/* The (duplicated) file descriptor of the file object
+	 * or -1 if the file object is not an operating system file
+	 */
+	int file_descriptor;
+
+	/* The current offset
+	 */
+	off64_t current_offset;
+
+	/* Value to indicate the file object must be seeked to the current offset
+	 * before the next read
+	 */
+	int seek_on_read;
+
+	/* Value to indicate the file object has a readinto method
+	 */
+	int has_readinto;
 };
 
 int pyewf_file_object_io_handle_initialize(
@@ -56,6 +78,11 @@ int pyewf_file_object_initialize(
      PyObject *file_object,
      libcerror_error_t **error );
 
+int pyewf_file_object_get_file_descriptor(
+     PyObject *file_object,
+     int *file_descriptor,
+     libcerror_error_t **error );
+
 int pyewf_file_object_io_handle_free(
      pyewf_file_object_io_handle_t **file_object_io_handle,
      libcerror_error_t **error );
@@ -80,6 +107,12 @@ ssize_t pyewf_file_object_read_buffer(
          size_t size,
          libcerror_error_t **error );
 
+ssize_t pyewf_file_object_readinto_buffer(
+         PyObject *file_object,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
 ssize_t pyewf_file_object_io_handle_read(
          pyewf_file_object_io_handle_t *file_object_io_handle,
          uint8_t *buffer,
@@ -30,6 +30,8 @@
 #include <stdlib.h>
 #endif
 
+#include "pyewf_chunk_view.h"
+#include "pyewf_chunks.h"
 #include "pyewf_error.h"
 #include "pyewf_file_entry.h"
 #include "pyewf_file_objects_io_pool.h"
@@ -40,6 +42,7 @@
 #include "pyewf_libewf.h"
 #include "pyewf_metadata.h"
 #include "pyewf_python.h"
+#include "pyewf_read_request.h"
 #include "pyewf_unused.h"
 
 #if !defined( LIBEWF_HAVE_BFIO )
@@ -98,7 +101,60 @@ PyMethodDef pyewf_handle_object_methods[] = {
 	  METH_VARARGS | METH_KEYWORDS,
 	  "read_buffer_at_offset(size, offset) -> String\n"
 	  "\n"
-	  "Reads a buffer of media data at a specific offset." },
+	  "Reads a buffer of media data at a specific offset.\n"
+	  "On a handle opened read-only the current offset is not changed and multiple threads can read at the same time." },
+
+	{ "readinto",
+	  (PyCFunction) pyewf_handle_readinto,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "readinto(buffer) -> Integer\n"
+	  "\n"
+	  "Reads media data into a writable buffer object and returns the number of bytes read." },
+
+	{ "readinto_at_offset",
+	  (PyCFunction) pyewf_handle_readinto_at_offset,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "readinto_at_offset(buffer, offset) -> Integer\n"
+	  "\n"
+	  "Reads media data at a specific offset into a writable buffer object and returns the number of bytes read.\n"
+	  "On a handle opened read-only the current offset is not changed and multiple threads can read at the same time." },
+
+	{ "get_chunk_view",
+	  (PyCFunction) pyewf_handle_get_chunk_view,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "get_chunk_view(chunk_index) -> Object\n"
+	  "\n"
+	  "Retrieves a read-only memoryview of the media data of a specific chunk.\n"
+	  "The view refers directly to the cached chunk data and is released when it is no longer referenced.\n"
+	  "Only one chunk view can be active at a time." },
+
+	{ "read_ranges",
+	  (PyCFunction) pyewf_handle_read_ranges,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "read_ranges(ranges) -> List of strings\n"
+	  "\n"
+	  "Reads multiple ranges of media data, where ranges is a sequence of (offset, size) tuples.\n"
+	  "The ranges are read without holding the GIL in between." },
+
+#if PY_MAJOR_VERSION >= 3
+	{ "read_at",
+	  (PyCFunction) pyewf_handle_read_at,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "read_at(offset, size) -> Future\n"
+	  "\n"
+	  "Reads a buffer of media data at a specific offset asynchronously and returns an awaitable future.\n"
+	  "The read is processed on a worker thread and the current offset is not changed.\n"
+	  "Only supported on a handle opened read-only and must be called from a running event loop." },
+#endif
+
+	{ "iter_chunks",
+	  (PyCFunction) pyewf_handle_iter_chunks,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "iter_chunks(start=0, prefetch=4) -> Iterator\n"
+	  "\n"
+	  "Iterates the media data from the start offset in chunks, yielding (offset, memoryview) tuples.\n"
+	  "The first chunk ends at the next chunk boundary. Up to prefetch chunks are read and decompressed\n"
+	  "ahead on worker threads without holding the GIL. Only supported on a handle opened read-only." },
 
 	{ "write_buffer",
 	  (PyCFunction) pyewf_handle_write_buffer,
@@ -107,6 +163,14 @@ PyMethodDef pyewf_handle_object_methods[] = {
 	  "\n"
 	  "Writes a buffer of media data." },
 
+	{ "write_buffers",
+	  (PyCFunction) pyewf_handle_write_buffers,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "write_buffers(buffers) -> Integer\n"
+	  "\n"
+	  "Writes a sequence of buffers of media data in order and returns the number of bytes written.\n"
+	  "The buffers are written without holding the GIL in between." },
+
 	{ "write_buffer_at_offset",
 	  (PyCFunction) pyewf_handle_write_buffer_at_offset,
 	  METH_VARARGS | METH_KEYWORDS,
@@ -128,6 +192,36 @@ PyMethodDef pyewf_handle_object_methods[] = {
 	  "\n"
 	  "Retrieves the current offset within the media data." },
 
+	{ "get_number_of_threads",
+	  (PyCFunction) pyewf_handle_get_number_of_threads,
+	  METH_NOARGS,
+	  "get_number_of_threads() -> Integer\n"
+	  "\n"
+	  "Retrieves the number of threads used to (un)pack chunks." },
+
+	{ "set_number_of_threads",
+	  (PyCFunction) pyewf_handle_set_number_of_threads,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "set_number_of_threads(number_of_threads) -> None\n"
+	  "\n"
+	  "Sets the number of threads used to (un)pack chunks.\n"
+	  "When more than 1 thread is set, reads that span multiple chunks decompress the chunks in parallel\n"
+	  "and written chunks are compressed in parallel and written in order." },
+
+	{ "get_statistics",
+	  (PyCFunction) pyewf_handle_get_statistics,
+	  METH_NOARGS,
+	  "get_statistics() -> Dictionary\n"
+	  "\n"
+	  "Retrieves the IO and cache statistics, times are in nano seconds." },
+
+	{ "reset_statistics",
+	  (PyCFunction) pyewf_handle_reset_statistics,
+	  METH_NOARGS,
+	  "reset_statistics() -> None\n"
+	  "\n"
+	  "Resets the IO and cache statistics." },
+
 	/* Some Pythonesque aliases */
 
 	{ "read",
@@ -273,6 +367,14 @@ PyMethodDef pyewf_handle_object_methods[] = {
 	  "\n"
 	  "Retrieves all hash values." },
 
+	{ "get_metadata",
+	  (PyCFunction) pyewf_handle_get_metadata,
+	  METH_NOARGS,
+	  "get_metadata() -> Dictionary\n"
+	  "\n"
+	  "Retrieves the media values, header values, hash values, acquiry errors, checksum errors, sessions and tracks in a single call.\n"
+	  "The errors, sessions and tracks are lists of (start sector, number of sectors) tuples." },
+
 	/* Functions to access the (single) file entries */
 
 	{ "get_root_file_entry",
@@ -560,6 +662,7 @@ int pyewf_handle_init(
 	}
 	pyewf_handle->handle       = NULL;
 	pyewf_handle->file_io_pool = NULL;
+	pyewf_handle->access_flags = 0;
 
 	if( libewf_handle_initialize(
 	     &( pyewf_handle->handle ),
@@ -1095,6 +1198,8 @@ PyObject *pyewf_handle_open(
 
 		goto on_error;
 	}
+	pyewf_handle->access_flags = access_flags;
+
 	for( filename_index = 0;
 	     filename_index < number_of_filenames;
 	     filename_index++ )
@@ -1219,6 +1324,8 @@ PyObject *pyewf_handle_open_file_objects(
 
 		goto on_error;
 	}
+	pyewf_handle->access_flags = LIBEWF_OPEN_READ;
+
 	Py_IncRef(
 	 Py_None );
 
@@ -1277,6 +1384,8 @@ PyObject *pyewf_handle_close(
 
 		return( NULL );
 	}
+	pyewf_handle->access_flags = 0;
+
 	if( pyewf_handle->file_io_pool != NULL )
 	{
 		Py_BEGIN_ALLOW_THREADS
@@ -1504,13 +1613,27 @@ PyObject *pyewf_handle_read_buffer_at_offset(
 #endif
 	Py_BEGIN_ALLOW_THREADS
 
-	read_count = libewf_handle_read_buffer_at_offset(
-	              pyewf_handle->handle,
-	              (uint8_t *) buffer,
-	              (size_t) read_size,
-	              (off64_t) read_offset,
-	              &error );
-
+	/* A handle opened read-only uses the concurrent read path, which does not
+	 * change the current offset and does not serialize reads from multiple threads
+	 */
+	if( pyewf_handle->access_flags == LIBEWF_OPEN_READ )
+	{
+		read_count = libewf_handle_read_buffer_at_offset_concurrent(
+		              pyewf_handle->handle,
+		              (uint8_t *) buffer,
+		              (size_t) read_size,
+		              (off64_t) read_offset,
+		              &error );
+	}
+	else
+	{
+		read_count = libewf_handle_read_buffer_at_offset(
+		              pyewf_handle->handle,
+		              (uint8_t *) buffer,
+		              (size_t) read_size,
+		              (off64_t) read_offset,
+		              &error );
+	}
 	Py_END_ALLOW_THREADS
 
 	if( read_count <= -1 )
@@ -1549,21 +1672,21 @@ PyObject *pyewf_handle_read_buffer_at_offset(
 	return( string_object );
 }
 
-/* Writes a buffer of media data
- * Returns a Python object holding the data if successful or NULL on error
+/* Reads media data into a writable buffer object
+ * Returns a Python object holding the number of bytes read if successful or NULL on error
  */
-PyObject *pyewf_handle_write_buffer(
+PyObject *pyewf_handle_readinto(
            pyewf_handle_t *pyewf_handle,
            PyObject *arguments,
            PyObject *keywords )
 {
+	Py_buffer buffer_view;
+
 	libcerror_error_t *error    = NULL;
-	PyObject *string_object     = NULL;
-	static char *function       = "pyewf_handle_write_buffer";
+	PyObject *buffer_object     = NULL;
+	static char *function       = "pyewf_handle_readinto";
 	static char *keyword_list[] = { "buffer", NULL };
-	char *buffer                = NULL;
-	Py_ssize_t buffer_size      = 0;
-	ssize_t write_count         = 0;
+	ssize_t read_count          = 0;
 
 	if( pyewf_handle == NULL )
 	{
@@ -1579,49 +1702,51 @@ PyObject *pyewf_handle_write_buffer(
 	     keywords,
 	     "O",
 	     keyword_list,
-	     &string_object ) == 0 )
+	     &buffer_object ) == 0 )
 	{
 		return( NULL );
 	}
-#if PY_MAJOR_VERSION >= 3
-	buffer = PyBytes_AsString(
-	          string_object );
-
-	buffer_size = PyBytes_Size(
-	               string_object );
-#else
-	buffer = PyString_AsString(
-	          string_object );
-
-	buffer_size = PyString_Size(
-	               string_object );
-#endif
-	if( ( buffer_size < 0 )
-	 || ( buffer_size > (Py_ssize_t) SSIZE_MAX ) )
+	/* The data is read directly into the memory of the buffer object
+	 */
+	if( PyObject_GetBuffer(
+	     buffer_object,
+	     &buffer_view,
+	     PyBUF_WRITABLE ) != 0 )
+	{
+		return( NULL );
+	}
+	if( ( buffer_view.len < 0 )
+	 || ( buffer_view.len > (Py_ssize_t) SSIZE_MAX ) )
 	{
 		PyErr_Format(
 		 PyExc_ValueError,
 		 "%s: invalid argument buffer size value out of bounds.",
 		 function );
 
+		PyBuffer_Release(
+		 &buffer_view );
+
 		return( NULL );
 	}
 	Py_BEGIN_ALLOW_THREADS
 
-	write_count = libewf_handle_write_buffer(
-	               pyewf_handle->handle,
-	               (uint8_t *) buffer,
-	               (size_t) buffer_size,
-	               &error );
+	read_count = libewf_handle_read_buffer(
+	              pyewf_handle->handle,
+	              (uint8_t *) buffer_view.buf,
+	              (size_t) buffer_view.len,
+	              &error );
 
 	Py_END_ALLOW_THREADS
 
-	if( write_count != (ssize_t) buffer_size )
+	PyBuffer_Release(
+	 &buffer_view );
+
+	if( read_count <= -1 )
 	{
 		pyewf_error_raise(
 		 error,
 		 PyExc_IOError,
-		 "%s: unable to write data.",
+		 "%s: unable to read data.",
 		 function );
 
 		libcerror_error_free(
@@ -1629,28 +1754,26 @@ PyObject *pyewf_handle_write_buffer(
 
 		return( NULL );
 	}
-	Py_IncRef(
-	 Py_None );
-
-	return( Py_None );
+	return( pyewf_integer_signed_new_from_64bit(
+	         (int64_t) read_count ) );
 }
 
-/* Writes a buffer of media data at a specific offset
- * Returns a Python object holding the data if successful or NULL on error
+/* Reads media data at a specific offset into a writable buffer object
+ * Returns a Python object holding the number of bytes read if successful or NULL on error
  */
-PyObject *pyewf_handle_write_buffer_at_offset(
+PyObject *pyewf_handle_readinto_at_offset(
            pyewf_handle_t *pyewf_handle,
            PyObject *arguments,
            PyObject *keywords )
 {
+	Py_buffer buffer_view;
+
 	libcerror_error_t *error    = NULL;
-	PyObject *string_object     = NULL;
-	static char *function       = "pyewf_handle_write_buffer_at_offset";
-	static char *keyword_list[] = { "size", "offset", NULL };
-	char *buffer                = NULL;
-	off64_t write_offset        = 0;
-	Py_ssize_t buffer_size      = 0;
-	ssize_t write_count         = 0;
+	PyObject *buffer_object     = NULL;
+	static char *function       = "pyewf_handle_readinto_at_offset";
+	static char *keyword_list[] = { "buffer", "offset", NULL };
+	off64_t read_offset         = 0;
+	ssize_t read_count          = 0;
 
 	if( pyewf_handle == NULL )
 	{
@@ -1664,62 +1787,78 @@ PyObject *pyewf_handle_write_buffer_at_offset(
 	if( PyArg_ParseTupleAndKeywords(
 	     arguments,
 	     keywords,
-	     "O|L",
+	     "OL",
 	     keyword_list,
-	     &string_object,
-	     &write_offset ) == 0 )
+	     &buffer_object,
+	     &read_offset ) == 0 )
 	{
 		return( NULL );
 	}
-#if PY_MAJOR_VERSION >= 3
-	buffer = PyBytes_AsString(
-	          string_object );
-
-	buffer_size = PyBytes_Size(
-	               string_object );
-#else
-	buffer = PyString_AsString(
-	          string_object );
-
-	buffer_size = PyString_Size(
-	               string_object );
-#endif
-	if( ( buffer_size < 0 )
-	 || ( buffer_size > (Py_ssize_t) SSIZE_MAX ) )
+	if( read_offset < 0 )
 	{
 		PyErr_Format(
 		 PyExc_ValueError,
-		 "%s: invalid argument buffer size value out of bounds.",
+		 "%s: invalid argument read offset value less than zero.",
 		 function );
 
 		return( NULL );
 	}
-	if( write_offset < 0 )
+	/* The data is read directly into the memory of the buffer object
+	 */
+	if( PyObject_GetBuffer(
+	     buffer_object,
+	     &buffer_view,
+	     PyBUF_WRITABLE ) != 0 )
+	{
+		return( NULL );
+	}
+	if( ( buffer_view.len < 0 )
+	 || ( buffer_view.len > (Py_ssize_t) SSIZE_MAX ) )
 	{
 		PyErr_Format(
 		 PyExc_ValueError,
-		 "%s: invalid argument write offset value less than zero.",
+		 "%s: invalid argument buffer size value out of bounds.",
 		 function );
 
+		PyBuffer_Release(
+		 &buffer_view );
+
 		return( NULL );
 	}
 	Py_BEGIN_ALLOW_THREADS
 
-	write_count = libewf_handle_write_buffer_at_offset(
-	               pyewf_handle->handle,
-	               (uint8_t *) buffer,
-	               (size_t) buffer_size,
-	               write_offset,
-	               &error );
-
+	/* A handle opened read-only uses the concurrent read path, which does not
+	 * change the current offset and does not serialize reads from multiple threads
+	 */
+	if( pyewf_handle->access_flags == LIBEWF_OPEN_READ )
+	{
+		read_count = libewf_handle_read_buffer_at_offset_concurrent(
+		              pyewf_handle->handle,
+		              (uint8_t *) buffer_view.buf,
+		              (size_t) buffer_view.len,
+		              read_offset,
+		              &error );
+	}
+	else
+	{
+		read_count = libewf_handle_read_buffer_at_offset(
+		              pyewf_handle->handle,
+		              (uint8_t *) buffer_view.buf,
+		              (size_t) buffer_view.len,
+		              read_offset,
+		              &error );
+	}
 	Py_END_ALLOW_THREADS
 
-	if( write_count != (ssize_t) buffer_size )
+	PyBuffer_Release(
+	 &buffer_view );
+
+	if( read_count <= -1 )
 	{
 		pyewf_error_raise(
 		 error,
 		 PyExc_IOError,
-		 "%s: unable to write data.",
+		 "%s: unable to read data.",
 		 function );
 
 		libcerror_error_free(
@@ -1727,25 +1866,29 @@ PyObject *pyewf_handle_write_buffer_at_offset(
 
 		return( NULL );
 	}
-	Py_IncRef(
-	 Py_None );
-
-	return( Py_None );
+	return( pyewf_integer_signed_new_from_64bit(
+	         (int64_t) read_count ) );
 }
 
-/* Seeks a certain offset in the media data
- * Returns a Python object holding the offset if successful or NULL on error
+/* Retrieves a view of the media data of a specific chunk
+ * Returns a Python object holding the memoryview if successful or NULL on error
  */
-PyObject *pyewf_handle_seek_offset(
+PyObject *pyewf_handle_get_chunk_view(
            pyewf_handle_t *pyewf_handle,
            PyObject *arguments,
            PyObject *keywords )
 {
-	libcerror_error_t *error    = NULL;
-	static char *function       = "pyewf_handle_seek_offset";
-	static char *keyword_list[] = { "offset", "whence", NULL };
-	off64_t offset              = 0;
-	int whence                  = 0;
+	libcerror_error_t *error     = NULL;
+	PyObject *chunk_view_object  = NULL;
+	PyObject *memoryview_object  = NULL;
+	static char *function        = "pyewf_handle_get_chunk_view";
+	static char *keyword_list[]  = { "chunk_index", NULL };
+	const uint8_t *data          = NULL;
+	size_t data_size             = 0;
+	size32_t chunk_size          = 0;
+	uint64_t chunk_index         = 0;
+	off64_t offset               = 0;
+	int result                   = 0;
 
 	if( pyewf_handle == NULL )
 	{
@@ -1759,29 +1902,27 @@ PyObject *pyewf_handle_seek_offset(
 	if( PyArg_ParseTupleAndKeywords(
 	     arguments,
 	     keywords,
-	     "L|i",
+	     "K",
 	     keyword_list,
-	     &offset,
-	     &whence ) == 0 )
+	     &chunk_index ) == 0 )
 	{
 		return( NULL );
 	}
 	Py_BEGIN_ALLOW_THREADS
 
-	offset = libewf_handle_seek_offset(
+	result = libewf_handle_get_chunk_size(
 	          pyewf_handle->handle,
-	          offset,
-	          whence,
+	          &chunk_size,
 	          &error );
 
 	Py_END_ALLOW_THREADS
 
- 	if( offset == -1 )
+	if( result != 1 )
 	{
 		pyewf_error_raise(
 		 error,
 		 PyExc_IOError,
-		 "%s: unable to seek offset.",
+		 "%s: unable to retrieve chunk size.",
 		 function );
 
 		libcerror_error_free(
@@ -1789,51 +1930,35 @@ PyObject *pyewf_handle_seek_offset(
 
 		return( NULL );
 	}
-	Py_IncRef(
-	 Py_None );
-
-	return( Py_None );
-}
-
-/* Retrieves the offset
- * Returns a Python object if successful or NULL on error
- */
-PyObject *pyewf_handle_get_offset(
-           pyewf_handle_t *pyewf_handle,
-           PyObject *arguments PYEWF_ATTRIBUTE_UNUSED )
-{
-	libcerror_error_t *error = NULL;
-	PyObject *integer_object = NULL;
-	static char *function    = "pyewf_handle_get_offset";
-	off64_t current_offset   = 0;
-	int result               = 0;
-
-	PYEWF_UNREFERENCED_PARAMETER( arguments )
-
-	if( pyewf_handle == NULL )
+	if( ( chunk_size == 0 )
+	 || ( chunk_index > (uint64_t) ( INT64_MAX / chunk_size ) ) )
 	{
 		PyErr_Format(
-		 PyExc_TypeError,
-		 "%s: invalid handle.",
+		 PyExc_ValueError,
+		 "%s: invalid argument chunk index value out of bounds.",
 		 function );
 
 		return( NULL );
 	}
+	offset = (off64_t) ( chunk_index * chunk_size );
+
 	Py_BEGIN_ALLOW_THREADS
 
-	result = libewf_handle_get_offset(
+	result = libewf_handle_get_chunk_view(
 	          pyewf_handle->handle,
-	          &current_offset,
+	          offset,
+	          &data,
+	          &data_size,
 	          &error );
 
 	Py_END_ALLOW_THREADS
 
-	if( result != 1 )
+	if( result == -1 )
 	{
 		pyewf_error_raise(
 		 error,
 		 PyExc_IOError,
-		 "%s: unable to retrieve offset.",
+		 "%s: unable to retrieve chunk view.",
 		 function );
 
 		libcerror_error_free(
@@ -1841,10 +1966,1394 @@ PyObject *pyewf_handle_get_offset(
 
 		return( NULL );
 	}
-	integer_object = pyewf_integer_signed_new_from_64bit(
-	                  (int64_t) current_offset );
+	else if( result == 0 )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid argument chunk index value out of bounds.",
+		 function );
 
-	return( integer_object );
+		return( NULL );
+	}
+	/* The chunk view object takes over the active chunk view
+	 */
+	chunk_view_object = pyewf_chunk_view_new(
+	                     pyewf_handle,
+	                     data,
+	                     data_size );
+
+	if( chunk_view_object == NULL )
+	{
+		libewf_handle_release_chunk_view(
+		 pyewf_handle->handle,
+		 NULL );
+
+		return( NULL );
+	}
+	/* The memoryview holds a reference to the chunk view object
+	 * the chunk view is released when the memoryview is dropped
+	 */
+	memoryview_object = PyMemoryView_FromObject(
+	                     chunk_view_object );
+
+	Py_DecRef(
+	 chunk_view_object );
+
+	return( memoryview_object );
+}
+
+/* Reads multiple ranges of media data
+ * The ranges are read in a single call without holding the GIL
+ * Returns a Python object holding a list of the data if successful or NULL on error
+ */
+PyObject *pyewf_handle_read_ranges(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments,
+           PyObject *keywords )
+{
+	libcerror_error_t *error     = NULL;
+	PyObject **string_objects    = NULL;
+	PyObject *list_object        = NULL;
+	PyObject *range_object       = NULL;
+	PyObject *sequence_object    = NULL;
+	static char *function        = "pyewf_handle_read_ranges";
+	static char *keyword_list[]  = { "ranges", NULL };
+	off64_t *range_offsets       = NULL;
+	ssize_t *read_counts         = NULL;
+	Py_ssize_t number_of_ranges  = 0;
+	Py_ssize_t range_index       = 0;
+	off64_t range_offset         = 0;
+	ssize_t read_count           = 0;
+	int range_size               = 0;
+	int result                   = 0;
+
+	if( pyewf_handle == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid pyewf handle.",
+		 function );
+
+		return( NULL );
+	}
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "O",
+	     keyword_list,
+	     &sequence_object ) == 0 )
+	{
+		return( NULL );
+	}
+	if( PySequence_Check(
+	     sequence_object ) == 0 )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: argument: ranges must be a sequence object.",
+		 function );
+
+		return( NULL );
+	}
+	number_of_ranges = PySequence_Size(
+	                    sequence_object );
+
+	if( number_of_ranges < 0 )
+	{
+		return( NULL );
+	}
+	if( number_of_ranges > (Py_ssize_t) ( INT_MAX / sizeof( off64_t ) ) )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid number of ranges value exceeds maximum.",
+		 function );
+
+		return( NULL );
+	}
+	if( number_of_ranges == 0 )
+	{
+		return( PyList_New(
+		         0 ) );
+	}
+	string_objects = (PyObject **) PyMem_Malloc(
+	                                sizeof( PyObject * ) * number_of_ranges );
+
+	if( string_objects == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to create string objects.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     string_objects,
+	     0,
+	     sizeof( PyObject * ) * number_of_ranges ) == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to clear string objects.",
+		 function );
+
+		goto on_error;
+	}
+	range_offsets = (off64_t *) PyMem_Malloc(
+	                             sizeof( off64_t ) * number_of_ranges );
+
+	read_counts = (ssize_t *) PyMem_Malloc(
+	                           sizeof( ssize_t ) * number_of_ranges );
+
+	if( ( range_offsets == NULL )
+	 || ( read_counts == NULL ) )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to create ranges.",
+		 function );
+
+		goto on_error;
+	}
+	/* Allocate the buffers of all the ranges before the GIL is released
+	 */
+	for( range_index = 0;
+	     range_index < number_of_ranges;
+	     range_index++ )
+	{
+		range_object = PySequence_GetItem(
+		                sequence_object,
+		                range_index );
+
+		if( range_object == NULL )
+		{
+			goto on_error;
+		}
+		result = PyArg_ParseTuple(
+		          range_object,
+		          "Li",
+		          &range_offset,
+		          &range_size );
+
+		Py_DecRef(
+		 range_object );
+
+		if( result == 0 )
+		{
+			goto on_error;
+		}
+		if( range_offset < 0 )
+		{
+			PyErr_Format(
+			 PyExc_ValueError,
+			 "%s: invalid range: %d offset value less than zero.",
+			 function,
+			 (int) range_index );
+
+			goto on_error;
+		}
+		if( range_size < 0 )
+		{
+			PyErr_Format(
+			 PyExc_ValueError,
+			 "%s: invalid range: %d size value less than zero.",
+			 function,
+			 (int) range_index );
+
+			goto on_error;
+		}
+#if PY_MAJOR_VERSION >= 3
+		string_objects[ range_index ] = PyBytes_FromStringAndSize(
+		                                 NULL,
+		                                 range_size );
+#else
+		string_objects[ range_index ] = PyString_FromStringAndSize(
+		                                 NULL,
+		                                 range_size );
+#endif
+		if( string_objects[ range_index ] == NULL )
+		{
+			goto on_error;
+		}
+		range_offsets[ range_index ] = range_offset;
+		read_counts[ range_index ]   = 0;
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	/* A read that spans multiple chunks decompresses the chunks in parallel
+	 * if the handle was configured with more than 1 thread
+	 */
+	for( range_index = 0;
+	     range_index < number_of_ranges;
+	     range_index++ )
+	{
+#if PY_MAJOR_VERSION >= 3
+		read_count = libewf_handle_read_buffer_at_offset(
+		              pyewf_handle->handle,
+		              (uint8_t *) PyBytes_AS_STRING( string_objects[ range_index ] ),
+		              (size_t) PyBytes_GET_SIZE( string_objects[ range_index ] ),
+		              range_offsets[ range_index ],
+		              &error );
+#else
+		read_count = libewf_handle_read_buffer_at_offset(
+		              pyewf_handle->handle,
+		              (uint8_t *) PyString_AS_STRING( string_objects[ range_index ] ),
+		              (size_t) PyString_GET_SIZE( string_objects[ range_index ] ),
+		              range_offsets[ range_index ],
+		              &error );
+#endif
+		if( read_count <= -1 )
+		{
+			break;
+		}
+		read_counts[ range_index ] = read_count;
+	}
+	Py_END_ALLOW_THREADS
+
+	if( read_count <= -1 )
+	{
+		pyewf_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to read range: %d.",
+		 function,
+		 (int) range_index );
+
+		libcerror_error_free(
+		 &error );
+
+		goto on_error;
+	}
+	list_object = PyList_New(
+	               number_of_ranges );
+
+	if( list_object == NULL )
+	{
+		goto on_error;
+	}
+	for( range_index = 0;
+	     range_index < number_of_ranges;
+	     range_index++ )
+	{
+		/* Need to resize the string here in case the range was not fully read.
+		 */
+#if PY_MAJOR_VERSION >= 3
+		if( _PyBytes_Resize(
+		     &( string_objects[ range_index ] ),
+		     (Py_ssize_t) read_counts[ range_index ] ) != 0 )
+#else
+		if( _PyString_Resize(
+		     &( string_objects[ range_index ] ),
+		     (Py_ssize_t) read_counts[ range_index ] ) != 0 )
+#endif
+		{
+			goto on_error;
+		}
+		/* The list takes over the reference of the string object
+		 */
+		PyList_SET_ITEM(
+		 list_object,
+		 range_index,
+		 string_objects[ range_index ] );
+
+		string_objects[ range_index ] = NULL;
+	}
+	PyMem_Free(
+	 read_counts );
+
+	PyMem_Free(
+	 range_offsets );
+
+	PyMem_Free(
+	 string_objects );
+
+	return( list_object );
+
+on_error:
+	if( list_object != NULL )
+	{
+		Py_DecRef(
+		 list_object );
+	}
+	if( string_objects != NULL )
+	{
+		for( range_index = 0;
+		     range_index < number_of_ranges;
+		     range_index++ )
+		{
+			if( string_objects[ range_index ] != NULL )
+			{
+				Py_DecRef(
+				 string_objects[ range_index ] );
+			}
+		}
+		PyMem_Free(
+		 string_objects );
+	}
+	if( read_counts != NULL )
+	{
+		PyMem_Free(
+		 read_counts );
+	}
+	if( range_offsets != NULL )
+	{
+		PyMem_Free(
+		 range_offsets );
+	}
+	return( NULL );
+}
+
+#if PY_MAJOR_VERSION >= 3
+
+/* Reads a buffer of media data at a specific offset asynchronously
+ * The read is processed on a worker thread of libewf and the result is set on a future of the running event loop
+ * Returns a Python object holding the future if successful or NULL on error
+ */
+PyObject *pyewf_handle_read_at(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments,
+           PyObject *keywords )
+{
+	libcerror_error_t *error           = NULL;
+	pyewf_read_request_t *read_request = NULL;
+	PyObject *asyncio_module           = NULL;
+	PyObject *bytes_object             = NULL;
+	PyObject *future_object            = NULL;
+	PyObject *loop_object              = NULL;
+	static char *function              = "pyewf_handle_read_at";
+	static char *keyword_list[]        = { "offset", "size", NULL };
+	off64_t read_offset                = 0;
+	int read_size                      = 0;
+	int result                         = 0;
+
+	if( pyewf_handle == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid pyewf handle.",
+		 function );
+
+		return( NULL );
+	}
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "Li",
+	     keyword_list,
+	     &read_offset,
+	     &read_size ) == 0 )
+	{
+		return( NULL );
+	}
+	if( read_offset < 0 )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid argument read offset value less than zero.",
+		 function );
+
+		return( NULL );
+	}
+	if( read_size < 0 )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid argument read size value less than zero.",
+		 function );
+
+		return( NULL );
+	}
+	if( pyewf_handle->access_flags != LIBEWF_OPEN_READ )
+	{
+		PyErr_Format(
+		 PyExc_IOError,
+		 "%s: asynchronous reads are only supported on a handle opened read-only.",
+		 function );
+
+		return( NULL );
+	}
+	asyncio_module = PyImport_ImportModule(
+	                  "asyncio" );
+
+	if( asyncio_module == NULL )
+	{
+		goto on_error;
+	}
+	/* The future is bound to the event loop of the calling coroutine
+	 */
+	loop_object = PyObject_CallMethod(
+	               asyncio_module,
+	               "get_running_loop",
+	               NULL );
+
+	if( loop_object == NULL )
+	{
+		goto on_error;
+	}
+	future_object = PyObject_CallMethod(
+	                 loop_object,
+	                 "create_future",
+	                 NULL );
+
+	if( future_object == NULL )
+	{
+		goto on_error;
+	}
+	bytes_object = PyBytes_FromStringAndSize(
+	                NULL,
+	                read_size );
+
+	if( bytes_object == NULL )
+	{
+		goto on_error;
+	}
+	read_request = pyewf_read_request_new(
+	                loop_object,
+	                future_object,
+	                bytes_object );
+
+	if( read_request == NULL )
+	{
+		goto on_error;
+	}
+	/* The GIL is released since the read can be completed before the function returns
+	 * and the completion callback needs to acquire the GIL
+	 */
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libewf_handle_read_buffer_at_offset_async(
+	          pyewf_handle->handle,
+	          (uint8_t *) PyBytes_AS_STRING( bytes_object ),
+	          (size_t) read_size,
+	          read_offset,
+	          &pyewf_read_request_completed,
+	          (void *) read_request,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pyewf_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to submit read.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		/* The completion callback is not called if the read could not be submitted
+		 */
+		pyewf_read_request_free(
+		 read_request );
+
+		goto on_error;
+	}
+	Py_DecRef(
+	 bytes_object );
+
+	Py_DecRef(
+	 loop_object );
+
+	Py_DecRef(
+	 asyncio_module );
+
+	return( future_object );
+
+on_error:
+	if( bytes_object != NULL )
+	{
+		Py_DecRef(
+		 bytes_object );
+	}
+	if( future_object != NULL )
+	{
+		Py_DecRef(
+		 future_object );
+	}
+	if( loop_object != NULL )
+	{
+		Py_DecRef(
+		 loop_object );
+	}
+	if( asyncio_module != NULL )
+	{
+		Py_DecRef(
+		 asyncio_module );
+	}
+	return( NULL );
+}
+
+#endif /* PY_MAJOR_VERSION >= 3 */
+
+/* Iterates the media data in chunks
+ * The upcoming chunks are read and decompressed on the worker threads of libewf while the caller processes the current chunk
+ * Returns a Python object holding the chunks iterator if successful or NULL on error
+ */
+PyObject *pyewf_handle_iter_chunks(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments,
+           PyObject *keywords )
+{
+	static char *function       = "pyewf_handle_iter_chunks";
+	static char *keyword_list[] = { "start", "prefetch", NULL };
+	off64_t start_offset        = 0;
+	int prefetch                = PYEWF_CHUNKS_DEFAULT_PREFETCH;
+
+	if( pyewf_handle == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid pyewf handle.",
+		 function );
+
+		return( NULL );
+	}
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "|Li",
+	     keyword_list,
+	     &start_offset,
+	     &prefetch ) == 0 )
+	{
+		return( NULL );
+	}
+	if( start_offset < 0 )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid argument start value less than zero.",
+		 function );
+
+		return( NULL );
+	}
+	if( ( prefetch < 1 )
+	 || ( prefetch > PYEWF_CHUNKS_MAXIMUM_PREFETCH ) )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid argument prefetch value out of bounds.",
+		 function );
+
+		return( NULL );
+	}
+	if( pyewf_handle->access_flags != LIBEWF_OPEN_READ )
+	{
+		PyErr_Format(
+		 PyExc_IOError,
+		 "%s: iterating chunks is only supported on a handle opened read-only.",
+		 function );
+
+		return( NULL );
+	}
+	return( pyewf_chunks_new(
+	         pyewf_handle,
+	         start_offset,
+	         prefetch ) );
+}
+
+/* Writes a buffer of media data
+ * Returns a Python object holding the data if successful or NULL on error
+ */
+PyObject *pyewf_handle_write_buffer(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments,
+           PyObject *keywords )
+{
+	libcerror_error_t *error    = NULL;
+	PyObject *string_object     = NULL;
+	static char *function       = "pyewf_handle_write_buffer";
+	static char *keyword_list[] = { "buffer", NULL };
+	char *buffer                = NULL;
+	Py_ssize_t buffer_size      = 0;
+	ssize_t write_count         = 0;
+
+	if( pyewf_handle == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid pyewf handle.",
+		 function );
+
+		return( NULL );
+	}
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "O",
+	     keyword_list,
+	     &string_object ) == 0 )
+	{
+		return( NULL );
+	}
+#if PY_MAJOR_VERSION >= 3
+	buffer = PyBytes_AsString(
+	          string_object );
+
+	buffer_size = PyBytes_Size(
+	               string_object );
+#else
+	buffer = PyString_AsString(
+	          string_object );
+
+	buffer_size = PyString_Size(
+	               string_object );
+#endif
+	if( ( buffer_size < 0 )
+	 || ( buffer_size > (Py_ssize_t) SSIZE_MAX ) )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid argument buffer size value out of bounds.",
+		 function );
+
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	write_count = libewf_handle_write_buffer(
+	               pyewf_handle->handle,
+	               (uint8_t *) buffer,
+	               (size_t) buffer_size,
+	               &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( write_count != (ssize_t) buffer_size )
+	{
+		pyewf_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to write data.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	Py_IncRef(
+	 Py_None );
+
+	return( Py_None );
+}
+
+/* Writes multiple buffers of media data
+ * The buffers are written in order in a single call without holding the GIL
+ * Returns a Python object holding the number of bytes written if successful or NULL on error
+ */
+PyObject *pyewf_handle_write_buffers(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments,
+           PyObject *keywords )
+{
+	libcerror_error_t *error      = NULL;
+	Py_buffer *buffer_views       = NULL;
+	PyObject *buffer_object       = NULL;
+	PyObject *sequence_object     = NULL;
+	static char *function         = "pyewf_handle_write_buffers";
+	static char *keyword_list[]   = { "buffers", NULL };
+	Py_ssize_t buffer_index       = 0;
+	Py_ssize_t number_of_buffers  = 0;
+	Py_ssize_t number_of_views    = 0;
+	ssize_t write_count           = 0;
+	int64_t total_write_count     = 0;
+	int result                    = 0;
+
+	if( pyewf_handle == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid pyewf handle.",
+		 function );
+
+		return( NULL );
+	}
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "O",
+	     keyword_list,
+	     &sequence_object ) == 0 )
+	{
+		return( NULL );
+	}
+	if( PySequence_Check(
+	     sequence_object ) == 0 )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: argument: buffers must be a sequence object.",
+		 function );
+
+		return( NULL );
+	}
+	number_of_buffers = PySequence_Size(
+	                     sequence_object );
+
+	if( number_of_buffers < 0 )
+	{
+		return( NULL );
+	}
+	if( number_of_buffers > (Py_ssize_t) ( INT_MAX / sizeof( Py_buffer ) ) )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid number of buffers value exceeds maximum.",
+		 function );
+
+		return( NULL );
+	}
+	if( number_of_buffers == 0 )
+	{
+		return( pyewf_integer_signed_new_from_64bit(
+		         0 ) );
+	}
+	buffer_views = (Py_buffer *) PyMem_Malloc(
+	                              sizeof( Py_buffer ) * number_of_buffers );
+
+	if( buffer_views == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to create buffer views.",
+		 function );
+
+		goto on_error;
+	}
+	/* The buffer views keep the data of the buffer objects in place
+	 * while the GIL is released
+	 */
+	for( buffer_index = 0;
+	     buffer_index < number_of_buffers;
+	     buffer_index++ )
+	{
+		buffer_object = PySequence_GetItem(
+		                 sequence_object,
+		                 buffer_index );
+
+		if( buffer_object == NULL )
+		{
+			goto on_error;
+		}
+		result = PyObject_GetBuffer(
+		          buffer_object,
+		          &( buffer_views[ buffer_index ] ),
+		          PyBUF_SIMPLE );
+
+		Py_DecRef(
+		 buffer_object );
+
+		if( result != 0 )
+		{
+			goto on_error;
+		}
+		number_of_views++;
+
+		if( ( buffer_views[ buffer_index ].len < 0 )
+		 || ( buffer_views[ buffer_index ].len > (Py_ssize_t) SSIZE_MAX ) )
+		{
+			PyErr_Format(
+			 PyExc_ValueError,
+			 "%s: invalid buffer: %d size value out of bounds.",
+			 function,
+			 (int) buffer_index );
+
+			goto on_error;
+		}
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	/* If the handle was configured with more than 1 thread the chunks
+	 * are compressed in parallel and written in order
+	 */
+	for( buffer_index = 0;
+	     buffer_index < number_of_buffers;
+	     buffer_index++ )
+	{
+		write_count = libewf_handle_write_buffer(
+		               pyewf_handle->handle,
+		               (uint8_t *) buffer_views[ buffer_index ].buf,
+		               (size_t) buffer_views[ buffer_index ].len,
+		               &error );
+
+		if( write_count != (ssize_t) buffer_views[ buffer_index ].len )
+		{
+			break;
+		}
+		total_write_count += (int64_t) write_count;
+	}
+	Py_END_ALLOW_THREADS
+
+	if( buffer_index < number_of_buffers )
+	{
+		pyewf_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to write buffer: %d.",
+		 function,
+		 (int) buffer_index );
+
+		libcerror_error_free(
+		 &error );
+
+		goto on_error;
+	}
+	for( buffer_index = 0;
+	     buffer_index < number_of_views;
+	     buffer_index++ )
+	{
+		PyBuffer_Release(
+		 &( buffer_views[ buffer_index ] ) );
+	}
+	PyMem_Free(
+	 buffer_views );
+
+	return( pyewf_integer_signed_new_from_64bit(
+	         total_write_count ) );
+
+on_error:
+	if( buffer_views != NULL )
+	{
+		for( buffer_index = 0;
+		     buffer_index < number_of_views;
+		     buffer_index++ )
+		{
+			PyBuffer_Release(
+			 &( buffer_views[ buffer_index ] ) );
+		}
+		PyMem_Free(
+		 buffer_views );
+	}
+	return( NULL );
+}
+
+/* Writes a buffer of media data at a specific offset
+ * Returns a Python object holding the data if successful or NULL on error
+ */
+PyObject *pyewf_handle_write_buffer_at_offset(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments,
+           PyObject *keywords )
+{
+	libcerror_error_t *error    = NULL;
+	PyObject *string_object     = NULL;
+	static char *function       = "pyewf_handle_write_buffer_at_offset";
+	static char *keyword_list[] = { "size", "offset", NULL };
+	char *buffer                = NULL;
+	off64_t write_offset        = 0;
+	Py_ssize_t buffer_size      = 0;
+	ssize_t write_count         = 0;
+
+	if( pyewf_handle == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid pyewf handle.",
+		 function );
+
+		return( NULL );
+	}
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "O|L",
+	     keyword_list,
+	     &string_object,
+	     &write_offset ) == 0 )
+	{
+		return( NULL );
+	}
+#if PY_MAJOR_VERSION >= 3
+	buffer = PyBytes_AsString(
+	          string_object );
+
+	buffer_size = PyBytes_Size(
+	               string_object );
+#else
+	buffer = PyString_AsString(
+	          string_object );
+
+	buffer_size = PyString_Size(
+	               string_object );
+#endif
+	if( ( buffer_size < 0 )
+	 || ( buffer_size > (Py_ssize_t) SSIZE_MAX ) )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid argument buffer size value out of bounds.",
+		 function );
+
+		return( NULL );
+	}
+	if( write_offset < 0 )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid argument write offset value less than zero.",
+		 function );
+
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	write_count = libewf_handle_write_buffer_at_offset(
+	               pyewf_handle->handle,
+	               (uint8_t *) buffer,
+	               (size_t) buffer_size,
+	               write_offset,
+	               &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( write_count != (ssize_t) buffer_size )
+	{
+		pyewf_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to write data.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	Py_IncRef(
+	 Py_None );
+
+	return( Py_None );
+}
+
+/* Seeks a certain offset in the media data
+ * Returns a Python object holding the offset if successful or NULL on error
+ */
+PyObject *pyewf_handle_seek_offset(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments,
+           PyObject *keywords )
+{
+	libcerror_error_t *error    = NULL;
+	static char *function       = "pyewf_handle_seek_offset";
+	static char *keyword_list[] = { "offset", "whence", NULL };
+	off64_t offset              = 0;
+	int whence                  = 0;
+
+	if( pyewf_handle == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid pyewf handle.",
+		 function );
+
+		return( NULL );
+	}
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "L|i",
+	     keyword_list,
+	     &offset,
+	     &whence ) == 0 )
+	{
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	offset = libewf_handle_seek_offset(
+	          pyewf_handle->handle,
+	          offset,
+	          whence,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+ 	if( offset == -1 )
+	{
+		pyewf_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to seek offset.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	Py_IncRef(
+	 Py_None );
+
+	return( Py_None );
+}
+
+/* Retrieves the offset
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyewf_handle_get_offset(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments PYEWF_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	PyObject *integer_object = NULL;
+	static char *function    = "pyewf_handle_get_offset";
+	off64_t current_offset   = 0;
+	int result               = 0;
+
+	PYEWF_UNREFERENCED_PARAMETER( arguments )
+
+	if( pyewf_handle == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid handle.",
+		 function );
+
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libewf_handle_get_offset(
+	          pyewf_handle->handle,
+	          &current_offset,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pyewf_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to retrieve offset.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	integer_object = pyewf_integer_signed_new_from_64bit(
+	                  (int64_t) current_offset );
+
+	return( integer_object );
+}
+
+/* Retrieves the number of threads used to unpack chunks
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyewf_handle_get_number_of_threads(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments PYEWF_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	PyObject *integer_object = NULL;
+	static char *function    = "pyewf_handle_get_number_of_threads";
+	int number_of_threads    = 0;
+	int result               = 0;
+
+	PYEWF_UNREFERENCED_PARAMETER( arguments )
+
+	if( pyewf_handle == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid handle.",
+		 function );
+
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libewf_handle_get_number_of_threads(
+	          pyewf_handle->handle,
+	          &number_of_threads,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pyewf_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to retrieve number of threads.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	integer_object = pyewf_integer_signed_new_from_64bit(
+	                  (int64_t) number_of_threads );
+
+	return( integer_object );
+}
+
+/* Sets the number of threads used to unpack chunks
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyewf_handle_set_number_of_threads(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments,
+           PyObject *keywords )
+{
+	libcerror_error_t *error    = NULL;
+	static char *function       = "pyewf_handle_set_number_of_threads";
+	static char *keyword_list[] = { "number_of_threads", NULL };
+	int number_of_threads       = 0;
+	int result                  = 0;
+
+	if( pyewf_handle == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid handle.",
+		 function );
+
+		return( NULL );
+	}
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "i",
+	     keyword_list,
+	     &number_of_threads ) == 0 )
+	{
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libewf_handle_set_number_of_threads(
+	          pyewf_handle->handle,
+	          number_of_threads,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pyewf_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to set number of threads.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	Py_IncRef(
+	 Py_None );
+
+	return( Py_None );
+}
+
+/* The statistics returned by get_statistics
+ */
+#define PYEWF_HANDLE_NUMBER_OF_STATISTICS	14
+
+static int pyewf_handle_statistic_types[ PYEWF_HANDLE_NUMBER_OF_STATISTICS ] = {
+	LIBEWF_STATISTIC_SEGMENT_FILE_READ_SIZE,
+	LIBEWF_STATISTIC_SEGMENT_FILE_NUMBER_OF_READS,
+	LIBEWF_STATISTIC_SEGMENT_FILE_READ_TIME,
+	LIBEWF_STATISTIC_NUMBER_OF_DECOMPRESSED_CHUNKS,
+	LIBEWF_STATISTIC_DECOMPRESSION_TIME,
+	LIBEWF_STATISTIC_NUMBER_OF_VERIFIED_CHECKSUMS,
+	LIBEWF_STATISTIC_CHECKSUM_TIME,
+	LIBEWF_STATISTIC_CHUNKS_CACHE_HITS,
+	LIBEWF_STATISTIC_CHUNKS_CACHE_MISSES,
+	LIBEWF_STATISTIC_CHUNK_CACHE_HITS,
+	LIBEWF_STATISTIC_CHUNK_CACHE_MISSES,
+	LIBEWF_STATISTIC_CHUNK_CACHE_EVICTIONS,
+	LIBEWF_STATISTIC_CHUNK_GROUPS_CACHE_HITS,
+	LIBEWF_STATISTIC_CHUNK_GROUPS_CACHE_MISSES };
+
+static const char *pyewf_handle_statistic_names[ PYEWF_HANDLE_NUMBER_OF_STATISTICS ] = {
+	"segment_file_read_size",
+	"segment_file_number_of_reads",
+	"segment_file_read_time",
+	"number_of_decompressed_chunks",
+	"decompression_time",
+	"number_of_verified_checksums",
+	"checksum_time",
+	"chunks_cache_hits",
+	"chunks_cache_misses",
+	"chunk_cache_hits",
+	"chunk_cache_misses",
+	"chunk_cache_evictions",
+	"chunk_groups_cache_hits",
+	"chunk_groups_cache_misses" };
+
+/* Retrieves the statistics
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyewf_handle_get_statistics(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments PYEWF_ATTRIBUTE_UNUSED )
+{
+	uint64_t values[ PYEWF_HANDLE_NUMBER_OF_STATISTICS ];
+
+	libcerror_error_t *error    = NULL;
+	PyObject *dictionary_object = NULL;
+	PyObject *integer_object    = NULL;
+	static char *function       = "pyewf_handle_get_statistics";
+	int result                  = 1;
+	int statistic_index         = 0;
+
+	PYEWF_UNREFERENCED_PARAMETER( arguments )
+
+	if( pyewf_handle == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid handle.",
+		 function );
+
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	for( statistic_index = 0;
+	     statistic_index < PYEWF_HANDLE_NUMBER_OF_STATISTICS;
+	     statistic_index++ )
+	{
+		result = libewf_handle_get_statistics_value(
+		          pyewf_handle->handle,
+		          pyewf_handle_statistic_types[ statistic_index ],
+		          &( values[ statistic_index ] ),
+		          &error );
+
+		if( result != 1 )
+		{
+			break;
+		}
+	}
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pyewf_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to retrieve statistic: %s.",
+		 function,
+		 pyewf_handle_statistic_names[ statistic_index ] );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	dictionary_object = PyDict_New();
+
+	if( dictionary_object == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to create dictionary object.",
+		 function );
+
+		goto on_error;
+	}
+	for( statistic_index = 0;
+	     statistic_index < PYEWF_HANDLE_NUMBER_OF_STATISTICS;
+	     statistic_index++ )
+	{
+		integer_object = pyewf_integer_unsigned_new_from_64bit(
+		                  values[ statistic_index ] );
+
+		if( integer_object == NULL )
+		{
+			goto on_error;
+		}
+		if( PyDict_SetItemString(
+		     dictionary_object,
+		     pyewf_handle_statistic_names[ statistic_index ],
+		     integer_object ) != 0 )
+		{
+			PyErr_Format(
+			 PyExc_MemoryError,
+			 "%s: unable to set statistic: %s in dictionary.",
+			 function,
+			 pyewf_handle_statistic_names[ statistic_index ] );
+
+			goto on_error;
+		}
+		Py_DecRef(
+		 integer_object );
+
+		integer_object = NULL;
+	}
+	return( dictionary_object );
+
+on_error:
+	if( integer_object != NULL )
+	{
+		Py_DecRef(
+		 integer_object );
+	}
+	if( dictionary_object != NULL )
+	{
+		Py_DecRef(
+		 dictionary_object );
+	}
+	return( NULL );
+}
+
+/* Resets the statistics
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyewf_handle_reset_statistics(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments PYEWF_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "pyewf_handle_reset_statistics";
+	int result               = 0;
+
+	PYEWF_UNREFERENCED_PARAMETER( arguments )
+
+	if( pyewf_handle == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid handle.",
+		 function );
+
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libewf_handle_reset_statistics(
+	          pyewf_handle->handle,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pyewf_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to reset statistics.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	Py_IncRef(
+	 Py_None );
+
+	return( Py_None );
 }
 
 /* Retrieves the root file entry
@@ -50,6 +50,10 @@ struct pyewf_handle
 	/* The file IO pool
 	 */
 	libbfio_pool_t *file_io_pool;
+
+	/* The access flags
+	 */
+	int access_flags;
 };
 
 extern PyMethodDef pyewf_handle_object_methods[];
@@ -102,11 +106,48 @@ PyObject *pyewf_handle_read_buffer_at_offset(
            PyObject *arguments,
            PyObject *keywords );
 
+PyObject *pyewf_handle_readinto(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments,
+           PyObject *keywords );
+
+PyObject *pyewf_handle_readinto_at_offset(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments,
+           PyObject *keywords );
+
+PyObject *pyewf_handle_get_chunk_view(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments,
+           PyObject *keywords );
+
+PyObject *pyewf_handle_read_ranges(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments,
+           PyObject *keywords );
+
+#if PY_MAJOR_VERSION >= 3
+PyObject *pyewf_handle_read_at(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments,
+           PyObject *keywords );
+#endif
+
+PyObject *pyewf_handle_iter_chunks(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments,
+           PyObject *keywords );
+
 PyObject *pyewf_handle_write_buffer(
            pyewf_handle_t *pyewf_handle,
            PyObject *arguments,
            PyObject *keywords );
 
+PyObject *pyewf_handle_write_buffers(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments,
+           PyObject *keywords );
+
 PyObject *pyewf_handle_write_buffer_at_offset(
            pyewf_handle_t *pyewf_handle,
            PyObject *arguments,
@@ -121,6 +162,23 @@ PyObject *pyewf_handle_get_offset(
            pyewf_handle_t *pyewf_handle,
            PyObject *arguments );
 
+PyObject *pyewf_handle_get_number_of_threads(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments );
+
+PyObject *pyewf_handle_set_number_of_threads(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments,
+           PyObject *keywords );
+
+PyObject *pyewf_handle_get_statistics(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments );
+
+PyObject *pyewf_handle_reset_statistics(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments );
+
 PyObject *pyewf_handle_get_root_file_entry(
            pyewf_handle_t *pyewf_handle,
            PyObject *arguments );
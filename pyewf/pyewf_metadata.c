@@ -1695,3 +1695,354 @@ on_error:
 	return( NULL );
 }
 
+
+/* Retrieves a list of sector ranges
+ * The ranges are retrieved without holding the GIL and returned as a list of (start sector, number of sectors) tuples
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyewf_handle_get_sector_ranges(
+           pyewf_handle_t *pyewf_handle,
+           int (*get_number_of_ranges)(
+                 libewf_handle_t *handle,
+                 uint32_t *number_of_ranges,
+                 libewf_error_t **error ),
+           int (*get_range)(
+                 libewf_handle_t *handle,
+                 uint32_t range_index,
+                 uint64_t *start_sector,
+                 uint64_t *number_of_sectors,
+                 libewf_error_t **error ),
+           const char *range_description )
+{
+	libcerror_error_t *error    = NULL;
+	PyObject *integer_object    = NULL;
+	PyObject *list_object       = NULL;
+	PyObject *tuple_object      = NULL;
+	static char *function       = "pyewf_handle_get_sector_ranges";
+	uint64_t *range_values      = NULL;
+	uint32_t number_of_ranges   = 0;
+	uint32_t range_index        = 0;
+	int result                  = 0;
+
+	if( pyewf_handle == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid handle.",
+		 function );
+
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = get_number_of_ranges(
+	          pyewf_handle->handle,
+	          &number_of_ranges,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pyewf_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to retrieve number of %s.",
+		 function,
+		 range_description );
+
+		libcerror_error_free(
+		 &error );
+
+		goto on_error;
+	}
+	if( number_of_ranges > (uint32_t) ( INT_MAX / ( 2 * sizeof( uint64_t ) ) ) )
+	{
+		PyErr_Format(
+		 PyExc_ValueError,
+		 "%s: invalid number of %s value exceeds maximum.",
+		 function,
+		 range_description );
+
+		goto on_error;
+	}
+	if( number_of_ranges > 0 )
+	{
+		range_values = (uint64_t *) PyMem_Malloc(
+		                             sizeof( uint64_t ) * 2 * number_of_ranges );
+
+		if( range_values == NULL )
+		{
+			PyErr_Format(
+			 PyExc_MemoryError,
+			 "%s: unable to create %s.",
+			 function,
+			 range_description );
+
+			goto on_error;
+		}
+		Py_BEGIN_ALLOW_THREADS
+
+		for( range_index = 0;
+		     range_index < number_of_ranges;
+		     range_index++ )
+		{
+			result = get_range(
+			          pyewf_handle->handle,
+			          range_index,
+			          &( range_values[ 2 * range_index ] ),
+			          &( range_values[ ( 2 * range_index ) + 1 ] ),
+			          &error );
+
+			if( result != 1 )
+			{
+				break;
+			}
+		}
+		Py_END_ALLOW_THREADS
+
+		if( result != 1 )
+		{
+			pyewf_error_raise(
+			 error,
+			 PyExc_IOError,
+			 "%s: unable to retrieve %s: %d.",
+			 function,
+			 range_description,
+			 range_index );
+
+			libcerror_error_free(
+			 &error );
+
+			goto on_error;
+		}
+	}
+	list_object = PyList_New(
+	               (Py_ssize_t) number_of_ranges );
+
+	if( list_object == NULL )
+	{
+		goto on_error;
+	}
+	for( range_index = 0;
+	     range_index < number_of_ranges;
+	     range_index++ )
+	{
+		tuple_object = PyTuple_New(
+		                2 );
+
+		if( tuple_object == NULL )
+		{
+			goto on_error;
+		}
+		/* The tuple and the list take over the references of the objects
+		 */
+		integer_object = pyewf_integer_unsigned_new_from_64bit(
+		                  range_values[ 2 * range_index ] );
+
+		if( integer_object == NULL )
+		{
+			goto on_error;
+		}
+		PyTuple_SET_ITEM(
+		 tuple_object,
+		 0,
+		 integer_object );
+
+		integer_object = pyewf_integer_unsigned_new_from_64bit(
+		                  range_values[ ( 2 * range_index ) + 1 ] );
+
+		if( integer_object == NULL )
+		{
+			goto on_error;
+		}
+		PyTuple_SET_ITEM(
+		 tuple_object,
+		 1,
+		 integer_object );
+
+		PyList_SET_ITEM(
+		 list_object,
+		 (Py_ssize_t) range_index,
+		 tuple_object );
+
+		tuple_object = NULL;
+	}
+	if( range_values != NULL )
+	{
+		PyMem_Free(
+		 range_values );
+	}
+	return( list_object );
+
+on_error:
+	if( tuple_object != NULL )
+	{
+		Py_DecRef(
+		 tuple_object );
+	}
+	if( list_object != NULL )
+	{
+		Py_DecRef(
+		 list_object );
+	}
+	if( range_values != NULL )
+	{
+		PyMem_Free(
+		 range_values );
+	}
+	return( NULL );
+}
+
+/* Retrieves the metadata
+ * The media values, header values, hash values, sessions, tracks and errors
+ * are retrieved in a single call
+ * Returns a Python object holding a dictionary if successful or NULL on error
+ */
+PyObject *pyewf_handle_get_metadata(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments PYEWF_ATTRIBUTE_UNUSED )
+{
+	PyObject *(*value_functions[])( pyewf_handle_t *, PyObject * ) = {
+		&pyewf_handle_get_media_size,
+		&pyewf_handle_get_bytes_per_sector,
+		&pyewf_handle_get_number_of_sectors,
+		&pyewf_handle_get_sectors_per_chunk,
+		&pyewf_handle_get_chunk_size,
+		&pyewf_handle_get_error_granularity,
+		&pyewf_handle_get_compression_method,
+		&pyewf_handle_get_media_type,
+		&pyewf_handle_get_media_flags,
+		&pyewf_handle_get_format,
+		&pyewf_handle_get_header_values,
+		&pyewf_handle_get_hash_values,
+		NULL };
+
+	const char *value_names[] = {
+		"media_size",
+		"bytes_per_sector",
+		"number_of_sectors",
+		"sectors_per_chunk",
+		"chunk_size",
+		"error_granularity",
+		"compression_method",
+		"media_type",
+		"media_flags",
+		"format",
+		"header_values",
+		"hash_values",
+		NULL };
+
+	int (*number_of_ranges_functions[])( libewf_handle_t *, uint32_t *, libewf_error_t ** ) = {
+		&libewf_handle_get_number_of_acquiry_errors,
+		&libewf_handle_get_number_of_checksum_errors,
+		&libewf_handle_get_number_of_sessions,
+		&libewf_handle_get_number_of_tracks };
+
+	int (*range_functions[])( libewf_handle_t *, uint32_t, uint64_t *, uint64_t *, libewf_error_t ** ) = {
+		&libewf_handle_get_acquiry_error,
+		&libewf_handle_get_checksum_error,
+		&libewf_handle_get_session,
+		&libewf_handle_get_track };
+
+	const char *range_names[] = {
+		"acquiry_errors",
+		"checksum_errors",
+		"sessions",
+		"tracks",
+		NULL };
+
+	const char *range_descriptions[] = {
+		"acquiry errors",
+		"checksum errors",
+		"sessions",
+		"tracks" };
+
+	PyObject *dictionary_object = NULL;
+	PyObject *value_object      = NULL;
+	static char *function       = "pyewf_handle_get_metadata";
+	int value_index             = 0;
+
+	PYEWF_UNREFERENCED_PARAMETER( arguments )
+
+	if( pyewf_handle == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid handle.",
+		 function );
+
+		return( NULL );
+	}
+	dictionary_object = PyDict_New();
+
+	if( dictionary_object == NULL )
+	{
+		goto on_error;
+	}
+	for( value_index = 0;
+	     value_functions[ value_index ] != NULL;
+	     value_index++ )
+	{
+		value_object = value_functions[ value_index ](
+		                pyewf_handle,
+		                NULL );
+
+		if( value_object == NULL )
+		{
+			goto on_error;
+		}
+		if( PyDict_SetItemString(
+		     dictionary_object,
+		     value_names[ value_index ],
+		     value_object ) != 0 )
+		{
+			goto on_error;
+		}
+		Py_DecRef(
+		 value_object );
+
+		value_object = NULL;
+	}
+	for( value_index = 0;
+	     range_names[ value_index ] != NULL;
+	     value_index++ )
+	{
+		value_object = pyewf_handle_get_sector_ranges(
+		                pyewf_handle,
+		                number_of_ranges_functions[ value_index ],
+		                range_functions[ value_index ],
+		                range_descriptions[ value_index ] );
+
+		if( value_object == NULL )
+		{
+			goto on_error;
+		}
+		if( PyDict_SetItemString(
+		     dictionary_object,
+		     range_names[ value_index ],
+		     value_object ) != 0 )
+		{
+			goto on_error;
+		}
+		Py_DecRef(
+		 value_object );
+
+		value_object = NULL;
+	}
+	return( dictionary_object );
+
+on_error:
+	if( value_object != NULL )
+	{
+		Py_DecRef(
+		 value_object );
+	}
+	if( dictionary_object != NULL )
+	{
+		Py_DecRef(
+		 dictionary_object );
+	}
+	return( NULL );
+}
+
@@ -27,6 +27,7 @@
 #include <types.h>
 
 #include "pyewf_handle.h"
+#include "pyewf_libewf.h"
 #include "pyewf_python.h"
 
 #if defined( __cplusplus )
@@ -109,6 +110,24 @@ PyObject *pyewf_handle_get_hash_values(
            pyewf_handle_t *pyewf_handle,
            PyObject *arguments );
 
+PyObject *pyewf_handle_get_sector_ranges(
+           pyewf_handle_t *pyewf_handle,
+           int (*get_number_of_ranges)(
+                 libewf_handle_t *handle,
+                 uint32_t *number_of_ranges,
+                 libewf_error_t **error ),
+           int (*get_range)(
+                 libewf_handle_t *handle,
+                 uint32_t range_index,
+                 uint64_t *start_sector,
+                 uint64_t *number_of_sectors,
+                 libewf_error_t **error ),
+           const char *range_description );
+
+PyObject *pyewf_handle_get_metadata(
+           pyewf_handle_t *pyewf_handle,
+           PyObject *arguments );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -0,0 +1,311 @@
+/*
+ * Asynchronous read request functions
+ *
+ * Copyright (C) 2008-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( HAVE_WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "pyewf_error.h"
+#include "pyewf_libcerror.h"
+#include "pyewf_python.h"
+#include "pyewf_read_request.h"
+#include "pyewf_unused.h"
+
+#if PY_MAJOR_VERSION >= 3
+
+PyMethodDef pyewf_read_request_set_future_result_method_definition = {
+	"_set_future_result",
+	(PyCFunction) pyewf_read_request_set_future_result,
+	METH_VARARGS,
+	"_set_future_result(future, result, exception) -> None\n"
+	"\n"
+	"Sets the result or exception of a future that is not done." };
+
+/* Creates a new read request
+ * The read request takes a reference to each of the objects
+ * Make sure to hold the GIL state before calling this function
+ * Returns the read request if successful or NULL on error
+ */
+pyewf_read_request_t *pyewf_read_request_new(
+                       PyObject *loop_object,
+                       PyObject *future_object,
+                       PyObject *bytes_object )
+{
+	pyewf_read_request_t *read_request = NULL;
+	static char *function              = "pyewf_read_request_new";
+
+	read_request = (pyewf_read_request_t *) PyMem_RawMalloc(
+	                                         sizeof( pyewf_read_request_t ) );
+
+	if( read_request == NULL )
+	{
+		PyErr_Format(
+		 PyExc_MemoryError,
+		 "%s: unable to create read request.",
+		 function );
+
+		return( NULL );
+	}
+	Py_IncRef(
+	 loop_object );
+	Py_IncRef(
+	 future_object );
+	Py_IncRef(
+	 bytes_object );
+
+	read_request->loop_object   = loop_object;
+	read_request->future_object = future_object;
+	read_request->bytes_object  = bytes_object;
+
+	return( read_request );
+}
+
+/* Frees a read request
+ * Make sure to hold the GIL state before calling this function
+ */
+void pyewf_read_request_free(
+      pyewf_read_request_t *read_request )
+{
+	if( read_request == NULL )
+	{
+		return;
+	}
+	if( read_request->bytes_object != NULL )
+	{
+		Py_DecRef(
+		 read_request->bytes_object );
+	}
+	if( read_request->future_object != NULL )
+	{
+		Py_DecRef(
+		 read_request->future_object );
+	}
+	if( read_request->loop_object != NULL )
+	{
+		Py_DecRef(
+		 read_request->loop_object );
+	}
+	PyMem_RawFree(
+	 read_request );
+}
+
+/* Completes a read request
+ * This function is called by libewf on one of its worker threads,
+ * it passes the result to the event loop that owns the future
+ * The read request does not reference the handle object, since freeing
+ * the handle waits for the pending read requests to complete
+ */
+void pyewf_read_request_completed(
+      void *callback_data,
+      ssize_t read_count,
+      libcerror_error_t *error )
+{
+	pyewf_read_request_t *read_request = NULL;
+	PyObject *exception_object         = NULL;
+	PyObject *exception_traceback      = NULL;
+	PyObject *exception_type           = NULL;
+	PyObject *function_object          = NULL;
+	PyObject *method_result            = NULL;
+	PyObject *result_object            = NULL;
+	static char *function              = "pyewf_read_request_completed";
+	PyGILState_STATE gil_state         = 0;
+
+	if( callback_data == NULL )
+	{
+		return;
+	}
+	read_request = (pyewf_read_request_t *) callback_data;
+
+	gil_state = PyGILState_Ensure();
+
+	if( read_count <= -1 )
+	{
+		pyewf_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to read data.",
+		 function );
+	}
+	/* Need to resize the string here in case read_count differs from the requested size
+	 */
+	else if( _PyBytes_Resize(
+	          &( read_request->bytes_object ),
+	          (Py_ssize_t) read_count ) == 0 )
+	{
+		result_object = read_request->bytes_object;
+
+		read_request->bytes_object = NULL;
+	}
+	if( result_object == NULL )
+	{
+		PyErr_Fetch(
+		 &exception_type,
+		 &exception_object,
+		 &exception_traceback );
+
+		PyErr_NormalizeException(
+		 &exception_type,
+		 &exception_object,
+		 &exception_traceback );
+
+		if( exception_traceback != NULL )
+		{
+			PyException_SetTraceback(
+			 exception_object,
+			 exception_traceback );
+		}
+	}
+	function_object = PyCFunction_New(
+	                   &pyewf_read_request_set_future_result_method_definition,
+	                   NULL );
+
+	if( function_object != NULL )
+	{
+		method_result = PyObject_CallMethod(
+		                 read_request->loop_object,
+		                 "call_soon_threadsafe",
+		                 "OOOO",
+		                 function_object,
+		                 read_request->future_object,
+		                 ( result_object != NULL ) ? result_object : Py_None,
+		                 ( exception_object != NULL ) ? exception_object : Py_None );
+
+		Py_DecRef(
+		 function_object );
+	}
+	if( method_result != NULL )
+	{
+		Py_DecRef(
+		 method_result );
+	}
+	else
+	{
+		/* The event loop was closed before the read completed
+		 */
+		PyErr_Clear();
+	}
+	if( result_object != NULL )
+	{
+		Py_DecRef(
+		 result_object );
+	}
+	if( exception_object != NULL )
+	{
+		Py_DecRef(
+		 exception_object );
+	}
+	if( exception_type != NULL )
+	{
+		Py_DecRef(
+		 exception_type );
+	}
+	if( exception_traceback != NULL )
+	{
+		Py_DecRef(
+		 exception_traceback );
+	}
+	pyewf_read_request_free(
+	 read_request );
+
+	PyGILState_Release(
+	 gil_state );
+}
+
+/* Sets the result or exception of a future
+ * This function is called on the event loop thread, a future that was cancelled is left unchanged
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pyewf_read_request_set_future_result(
+           PyObject *self PYEWF_ATTRIBUTE_UNUSED,
+           PyObject *arguments )
+{
+	PyObject *exception_object = NULL;
+	PyObject *future_object    = NULL;
+	PyObject *method_result    = NULL;
+	PyObject *result_object    = NULL;
+	int result                 = 0;
+
+	PYEWF_UNREFERENCED_PARAMETER( self )
+
+	if( PyArg_ParseTuple(
+	     arguments,
+	     "OOO",
+	     &future_object,
+	     &result_object,
+	     &exception_object ) == 0 )
+	{
+		return( NULL );
+	}
+	method_result = PyObject_CallMethod(
+	                 future_object,
+	                 "done",
+	                 NULL );
+
+	if( method_result == NULL )
+	{
+		return( NULL );
+	}
+	result = PyObject_IsTrue(
+	          method_result );
+
+	Py_DecRef(
+	 method_result );
+
+	if( result == -1 )
+	{
+		return( NULL );
+	}
+	else if( result == 0 )
+	{
+		if( exception_object != Py_None )
+		{
+			method_result = PyObject_CallMethod(
+			                 future_object,
+			                 "set_exception",
+			                 "O",
+			                 exception_object );
+		}
+		else
+		{
+			method_result = PyObject_CallMethod(
+			                 future_object,
+			                 "set_result",
+			                 "O",
+			                 result_object );
+		}
+		if( method_result == NULL )
+		{
+			return( NULL );
+		}
+		Py_DecRef(
+		 method_result );
+	}
+	Py_IncRef(
+	 Py_None );
+
+	return( Py_None );
+}
+
+#endif /* PY_MAJOR_VERSION >= 3 */
+
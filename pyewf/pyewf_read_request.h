@@ -0,0 +1,78 @@
+/*
+ * Asynchronous read request functions
+ *
+ * Copyright (C) 2008-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _PYEWF_READ_REQUEST_H )
+#define _PYEWF_READ_REQUEST_H
+
+#include <common.h>
+#include <types.h>
+
+#include "pyewf_libcerror.h"
+#include "pyewf_python.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if PY_MAJOR_VERSION >= 3
+
+typedef struct pyewf_read_request pyewf_read_request_t;
+
+struct pyewf_read_request
+{
+	/* The event loop object
+	 */
+	PyObject *loop_object;
+
+	/* The future object
+	 */
+	PyObject *future_object;
+
+	/* The bytes object that receives the data
+	 */
+	PyObject *bytes_object;
+};
+
+pyewf_read_request_t *pyewf_read_request_new(
+                       PyObject *loop_object,
+                       PyObject *future_object,
+                       PyObject *bytes_object );
+
+void pyewf_read_request_free(
+      pyewf_read_request_t *read_request );
+
+void pyewf_read_request_completed(
+      void *callback_data,
+      ssize_t read_count,
+      libcerror_error_t *error );
+
+PyObject *pyewf_read_request_set_future_result(
+           PyObject *self,
+           PyObject *arguments );
+
+#endif /* PY_MAJOR_VERSION >= 3 */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _PYEWF_READ_REQUEST_H ) */
+
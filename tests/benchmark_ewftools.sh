@@ -0,0 +1,270 @@
+#!/bin/bash
+# Tools throughput benchmark script
+#
+# Version: 20261015
+#
+# Generates a synthetic source and measures acquisition (ewfacquire),
+# verification (ewfverify), export (ewfexport) and random read (ewfexport
+# of small ranges) for every combination of the formats, compression
+# levels, number of threads and process buffer sizes.
+#
+# The results are written to stdout as tab separated lines of:
+# stage, format, compression level, threads, process buffer size,
+# bytes, wall time, CPU time, peak RSS (KiB) and MB/s
+#
+# The sweep can be changed with the following environment variables:
+#   BENCHMARK_SOURCE_SIZE: size of the synthetic source in MiB (default 256)
+#   BENCHMARK_FORMATS: EWF formats (default "encase6 encase7-v2")
+#   BENCHMARK_COMPRESSION_LEVELS: deflate levels (default "none fast best")
+#   BENCHMARK_THREADS: number of concurrent processing jobs (default "1 2 4")
+#   BENCHMARK_PROCESS_BUFFER_SIZES: in bytes (default "32768 1048576")
+#   BENCHMARK_NUMBER_OF_RANDOM_READS: number of random reads (default 256)
+#   BENCHMARK_RANDOM_READ_SIZE: size of a random read in bytes (default 4096)
+#   BENCHMARK_DIRECTORY: directory to write the source and images to
+#   GNU_TIME: path of the GNU time executable (default /usr/bin/time)
+#
+# The wall time, CPU time and peak RSS are measured with GNU time.
+
+EXIT_SUCCESS=0;
+EXIT_FAILURE=1;
+EXIT_IGNORE=77;
+
+BENCHMARK_SOURCE_SIZE=${BENCHMARK_SOURCE_SIZE:-256};
+BENCHMARK_FORMATS=${BENCHMARK_FORMATS:-"encase6 encase7-v2"};
+BENCHMARK_COMPRESSION_LEVELS=${BENCHMARK_COMPRESSION_LEVELS:-"none fast best"};
+BENCHMARK_THREADS=${BENCHMARK_THREADS:-"1 2 4"};
+BENCHMARK_PROCESS_BUFFER_SIZES=${BENCHMARK_PROCESS_BUFFER_SIZES:-"32768 1048576"};
+BENCHMARK_NUMBER_OF_RANDOM_READS=${BENCHMARK_NUMBER_OF_RANDOM_READS:-256};
+BENCHMARK_RANDOM_READ_SIZE=${BENCHMARK_RANDOM_READ_SIZE:-4096};
+
+# Finds a tool executable and exits if not available.
+#
+# Arguments:
+#   a string containing the name of the tool
+#
+find_tool_executable()
+{
+	local TOOL_NAME=$1;
+	local TOOL_EXECUTABLE="../ewftools/${TOOL_NAME}";
+
+	if ! test -x "${TOOL_EXECUTABLE}";
+	then
+		TOOL_EXECUTABLE="../ewftools/${TOOL_NAME}.exe";
+	fi
+	if ! test -x "${TOOL_EXECUTABLE}";
+	then
+		echo "Missing executable: ${TOOL_EXECUTABLE}" >&2;
+
+		exit ${EXIT_FAILURE};
+	fi
+	echo "${TOOL_EXECUTABLE}";
+}
+
+# Generates a synthetic source that mimics a disk image with runs of
+# unused sectors, text, compressed (random) data and file system tables
+#
+# Arguments:
+#   a string containing the path of the source
+#   an integer containing the size of the source in MiB
+#
+generate_source()
+{
+	local SOURCE_FILE=$1;
+	local SOURCE_SIZE=$2;
+	local BLOCK_INDEX=0;
+
+	RANDOM=1;
+
+	rm -f "${SOURCE_FILE}";
+
+	while test ${BLOCK_INDEX} -lt ${SOURCE_SIZE};
+	do
+		case $(( RANDOM % 8 )) in
+		0|1|2)
+			head -c 1048576 /dev/zero;
+			;;
+		3|4)
+			yes "the evidence file contains a copy of the media data acquired from disk sectors" | head -c 1048576;
+			;;
+		5|6)
+			head -c 1048576 /dev/urandom;
+			;;
+		*)
+			seq -w 0 99999999 | head -c 1048576;
+			;;
+		esac
+		BLOCK_INDEX=$(( BLOCK_INDEX + 1 ));
+	done > "${SOURCE_FILE}";
+}
+
+# Runs a stage of the benchmark and prints its measurements
+#
+# Arguments:
+#   a string containing the name of the stage
+#   a string containing the format
+#   a string containing the compression level
+#   an integer containing the number of threads
+#   an integer containing the process buffer size
+#   an integer containing the number of bytes processed by the stage
+#   the command to run
+#
+run_benchmark_stage()
+{
+	local STAGE=$1;
+	local FORMAT=$2;
+	local COMPRESSION_LEVEL=$3;
+	local NUMBER_OF_THREADS=$4;
+	local PROCESS_BUFFER_SIZE=$5;
+	local PROCESSED_SIZE=$6;
+	shift 6;
+
+	local TIMING_FILE="${BENCHMARK_DIRECTORY}/timing";
+
+	${GNU_TIME} -o "${TIMING_FILE}" -f "%e %U %S %M" "$@" > /dev/null 2> "${BENCHMARK_DIRECTORY}/stderr";
+	local RESULT=$?;
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo "Stage: ${STAGE} failed with command: $*" >&2;
+		cat "${BENCHMARK_DIRECTORY}/stderr" >&2;
+
+		return ${RESULT};
+	fi
+	# GNU time prints the exit status of the command on the first line if it was non-zero
+	tail -n 1 "${TIMING_FILE}" | awk -v stage="${STAGE}" -v format="${FORMAT}" -v level="${COMPRESSION_LEVEL}" -v threads="${NUMBER_OF_THREADS}" -v buffer_size="${PROCESS_BUFFER_SIZE}" -v size="${PROCESSED_SIZE}" '{
+		megabytes_per_second = 0.0;
+
+		if( $1 > 0 )
+		{
+			megabytes_per_second = size / $1 / 1000000.0;
+		}
+		printf( "%s\t%s\t%s\t%d\t%d\t%d\t%.2f\t%.2f\t%d\t%.2f\n", stage, format, level, threads, buffer_size, size, $1, $2 + $3, $4, megabytes_per_second );
+	}';
+	return ${EXIT_SUCCESS};
+}
+
+# Reads ranges at random offsets from an image
+#
+# Arguments:
+#   a string containing the path of the first segment file
+#   an integer containing the number of threads
+#   an integer containing the process buffer size
+#
+random_read()
+{
+	local IMAGE_FILE=$1;
+	local NUMBER_OF_THREADS=$2;
+	local PROCESS_BUFFER_SIZE=$3;
+	local NUMBER_OF_BLOCKS=$(( BENCHMARK_SOURCE_SIZE * 1048576 / BENCHMARK_RANDOM_READ_SIZE ));
+	local READ_INDEX=0;
+	local READ_OFFSET=0;
+
+	RANDOM=1;
+
+	while test ${READ_INDEX} -lt ${BENCHMARK_NUMBER_OF_RANDOM_READS};
+	do
+		READ_OFFSET=$(( ( ( RANDOM * 32768 ) + RANDOM ) % NUMBER_OF_BLOCKS * BENCHMARK_RANDOM_READ_SIZE ));
+
+		"${EXPORT_TOOL}" -f raw -j ${NUMBER_OF_THREADS} -p ${PROCESS_BUFFER_SIZE} -o ${READ_OFFSET} -B ${BENCHMARK_RANDOM_READ_SIZE} -q -t - -u "${IMAGE_FILE}";
+
+		if test $? -ne ${EXIT_SUCCESS};
+		then
+			return ${EXIT_FAILURE};
+		fi
+		READ_INDEX=$(( READ_INDEX + 1 ));
+	done
+	return ${EXIT_SUCCESS};
+}
+
+if ! test -z ${SKIP_TOOLS_TESTS};
+then
+	exit ${EXIT_IGNORE};
+fi
+
+GNU_TIME=${GNU_TIME:-"/usr/bin/time"};
+
+${GNU_TIME} -o /dev/null -f "%e %U %S %M" true > /dev/null 2>&1;
+
+if test $? -ne ${EXIT_SUCCESS};
+then
+	echo "Missing GNU time: ${GNU_TIME}" >&2;
+
+	exit ${EXIT_IGNORE};
+fi
+
+ACQUIRE_TOOL=$( find_tool_executable "ewfacquire" ) || exit ${EXIT_FAILURE};
+EXPORT_TOOL=$( find_tool_executable "ewfexport" ) || exit ${EXIT_FAILURE};
+VERIFY_TOOL=$( find_tool_executable "ewfverify" ) || exit ${EXIT_FAILURE};
+
+if test -z "${BENCHMARK_DIRECTORY}";
+then
+	BENCHMARK_DIRECTORY="tmp$$";
+
+	rm -rf ${BENCHMARK_DIRECTORY};
+	mkdir ${BENCHMARK_DIRECTORY};
+
+	trap "rm -rf ${BENCHMARK_DIRECTORY}" EXIT;
+fi
+
+SOURCE_FILE="${BENCHMARK_DIRECTORY}/source.raw";
+SOURCE_SIZE_BYTES=$(( BENCHMARK_SOURCE_SIZE * 1048576 ));
+RANDOM_READ_SIZE_BYTES=$(( BENCHMARK_NUMBER_OF_RANDOM_READS * BENCHMARK_RANDOM_READ_SIZE ));
+
+generate_source "${SOURCE_FILE}" ${BENCHMARK_SOURCE_SIZE};
+
+echo -e "# stage\tformat\tcompression_level\tthreads\tprocess_buffer_size\tbytes\twall_time\tcpu_time\tpeak_rss_kib\tMB/s";
+
+RESULT=${EXIT_SUCCESS};
+
+for FORMAT in ${BENCHMARK_FORMATS};
+do
+	for COMPRESSION_LEVEL in ${BENCHMARK_COMPRESSION_LEVELS};
+	do
+		for NUMBER_OF_THREADS in ${BENCHMARK_THREADS};
+		do
+			for PROCESS_BUFFER_SIZE in ${BENCHMARK_PROCESS_BUFFER_SIZES};
+			do
+				TARGET="${BENCHMARK_DIRECTORY}/image";
+
+				rm -f ${TARGET}.*;
+
+				run_benchmark_stage "acquire" "${FORMAT}" "${COMPRESSION_LEVEL}" ${NUMBER_OF_THREADS} ${PROCESS_BUFFER_SIZE} ${SOURCE_SIZE_BYTES} "${ACQUIRE_TOOL}" -c deflate:${COMPRESSION_LEVEL} -f ${FORMAT} -j ${NUMBER_OF_THREADS} -p ${PROCESS_BUFFER_SIZE} -q -t "${TARGET}" -u "${SOURCE_FILE}";
+				RESULT=$?;
+
+				if test ${RESULT} -ne ${EXIT_SUCCESS};
+				then
+					break 4;
+				fi
+				IMAGE_FILE=`ls -1 ${TARGET}.* | head -n 1`;
+
+				run_benchmark_stage "verify" "${FORMAT}" "${COMPRESSION_LEVEL}" ${NUMBER_OF_THREADS} ${PROCESS_BUFFER_SIZE} ${SOURCE_SIZE_BYTES} "${VERIFY_TOOL}" -j ${NUMBER_OF_THREADS} -p ${PROCESS_BUFFER_SIZE} -q "${IMAGE_FILE}";
+				RESULT=$?;
+
+				if test ${RESULT} -ne ${EXIT_SUCCESS};
+				then
+					break 4;
+				fi
+				run_benchmark_stage "export" "${FORMAT}" "${COMPRESSION_LEVEL}" ${NUMBER_OF_THREADS} ${PROCESS_BUFFER_SIZE} ${SOURCE_SIZE_BYTES} "${EXPORT_TOOL}" -f raw -j ${NUMBER_OF_THREADS} -p ${PROCESS_BUFFER_SIZE} -q -t - -u "${IMAGE_FILE}";
+				RESULT=$?;
+
+				if test ${RESULT} -ne ${EXIT_SUCCESS};
+				then
+					break 4;
+				fi
+				export -f random_read;
+				export EXPORT_TOOL BENCHMARK_SOURCE_SIZE BENCHMARK_NUMBER_OF_RANDOM_READS BENCHMARK_RANDOM_READ_SIZE EXIT_SUCCESS EXIT_FAILURE;
+
+				run_benchmark_stage "random_read" "${FORMAT}" "${COMPRESSION_LEVEL}" ${NUMBER_OF_THREADS} ${PROCESS_BUFFER_SIZE} ${RANDOM_READ_SIZE_BYTES} bash -c 'random_read "$@"' random_read "${IMAGE_FILE}" ${NUMBER_OF_THREADS} ${PROCESS_BUFFER_SIZE};
+				RESULT=$?;
+
+				if test ${RESULT} -ne ${EXIT_SUCCESS};
+				then
+					break 4;
+				fi
+			done
+		done
+	done
+done
+
+exit ${RESULT};
+
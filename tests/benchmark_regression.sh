@@ -0,0 +1,637 @@
+#!/bin/bash
+# Benchmark regression script
+#
+# Version: 20261015
+#
+# Runs the benchmark suite a number of times and either records the results
+# as the baseline of the machine profile or compares the results against
+# a previously recorded baseline of the machine profile.
+#
+# Usage: benchmark_regression.sh [ record | compare ]
+#
+# The following scenarios are benchmarked:
+#   kernels: compression, decompression and checksum kernels (ewf_bench_kernels)
+#   open: open and first read time of generated images (ewf_bench_open)
+#   random_read: random read latency of an acquired image (ewf_bench_random_read)
+#   pipeline: acquire, verify, export and random read throughput of the tools
+#             (benchmark_ewftools.sh)
+#
+# The baseline is stored as JSON in: BENCHMARK_BASELINE_DIRECTORY/PROFILE.json
+# with one metric object per line, that contains the number of samples, mean
+# and standard deviation of the metric.
+#
+# A metric is reported as a regression if it is worse than the baseline by
+# more than the threshold and the difference is statistically significant
+# according to a two-sided Welch's t-test at a 95% confidence level. If either
+# the baseline or the current results contain a single sample, only the
+# threshold is applied. The compare mode exits with failure if a regression
+# was detected.
+#
+# The benchmark can be changed with the following environment variables:
+#   BENCHMARK_PROFILE: name of the machine profile (default is derived from
+#                      the operating system, architecture, CPU model and
+#                      number of CPUs)
+#   BENCHMARK_BASELINE_DIRECTORY: directory of the baselines
+#                                 (default "benchmark_baselines")
+#   BENCHMARK_REPETITIONS: number of repetitions of the suite (default 5)
+#   BENCHMARK_THRESHOLD: relative change in percent that is considered
+#                        a regression (default 5)
+#   BENCHMARK_SCENARIOS: scenarios to benchmark
+#                        (default "kernels open random_read pipeline")
+#   BENCHMARK_KERNELS_OPTIONS: options of ewf_bench_kernels (default "")
+#   BENCHMARK_OPEN_OPTIONS: options of ewf_bench_open
+#                           (default "-f e01,ex01 -s 1,100 -n 10")
+#   BENCHMARK_RANDOM_READ_OPTIONS: options of ewf_bench_random_read
+#                                  (default "-c 16")
+#   BENCHMARK_PIPELINE_FORMATS: EWF formats of the pipeline (default "encase6")
+#   BENCHMARK_PIPELINE_COMPRESSION_LEVELS: deflate levels of the pipeline
+#                                          (default "none fast")
+#   BENCHMARK_PIPELINE_THREADS: number of concurrent processing jobs of
+#                               the pipeline (default "1")
+#   BENCHMARK_PIPELINE_PROCESS_BUFFER_SIZES: process buffer sizes of
+#                                            the pipeline (default "32768")
+#   BENCHMARK_SOURCE_SIZE: size of the source of the acquired images in MiB
+#                          (default 64)
+#   BENCHMARK_DIRECTORY: directory to write the source, images and
+#                        intermediate results to
+
+EXIT_SUCCESS=0;
+EXIT_FAILURE=1;
+EXIT_IGNORE=77;
+
+BENCHMARK_BASELINE_DIRECTORY=${BENCHMARK_BASELINE_DIRECTORY:-"benchmark_baselines"};
+BENCHMARK_REPETITIONS=${BENCHMARK_REPETITIONS:-5};
+BENCHMARK_THRESHOLD=${BENCHMARK_THRESHOLD:-5};
+BENCHMARK_SCENARIOS=${BENCHMARK_SCENARIOS:-"kernels open random_read pipeline"};
+BENCHMARK_KERNELS_OPTIONS=${BENCHMARK_KERNELS_OPTIONS:-""};
+BENCHMARK_OPEN_OPTIONS=${BENCHMARK_OPEN_OPTIONS:-"-f e01,ex01 -s 1,100 -n 10"};
+BENCHMARK_RANDOM_READ_OPTIONS=${BENCHMARK_RANDOM_READ_OPTIONS:-"-c 16"};
+BENCHMARK_SOURCE_SIZE=${BENCHMARK_SOURCE_SIZE:-64};
+
+# Finds an executable and prints its path.
+#
+# Arguments:
+#   a string containing the path of the executable without extension
+#
+find_executable()
+{
+	local EXECUTABLE=$1;
+
+	if ! test -x "${EXECUTABLE}";
+	then
+		EXECUTABLE="${EXECUTABLE}.exe";
+	fi
+	if ! test -x "${EXECUTABLE}";
+	then
+		echo "Missing executable: ${EXECUTABLE}" >&2;
+
+		return ${EXIT_FAILURE};
+	fi
+	echo "${EXECUTABLE}";
+}
+
+# Determines the name of the machine profile from the operating system,
+# architecture, CPU model and number of CPUs
+#
+get_machine_profile()
+{
+	local CPU_MODEL="";
+	local NUMBER_OF_CPUS="";
+
+	if test -f /proc/cpuinfo;
+	then
+		CPU_MODEL=$( sed -n 's/^model name[ 	]*:[ 	]*//p' /proc/cpuinfo | head -n 1 );
+	fi
+	if test -z "${CPU_MODEL}";
+	then
+		CPU_MODEL=$( sysctl -n machdep.cpu.brand_string 2> /dev/null || sysctl -n hw.model 2> /dev/null );
+	fi
+	NUMBER_OF_CPUS=$( getconf _NPROCESSORS_ONLN 2> /dev/null || echo 1 );
+
+	echo "$( uname -s )-$( uname -m )-${CPU_MODEL}-${NUMBER_OF_CPUS}cpus" | tr '[:upper:]' '[:lower:]' | sed 's/[^a-z0-9.-][^a-z0-9.-]*/_/g; s/^_//; s/_$//';
+}
+
+# Generates a synthetic source that mimics a disk image with runs of
+# unused sectors, text and compressed (random) data
+#
+# Arguments:
+#   a string containing the path of the source
+#   an integer containing the size of the source in MiB
+#
+generate_source()
+{
+	local SOURCE_FILE=$1;
+	local SOURCE_SIZE=$2;
+	local BLOCK_INDEX=0;
+
+	RANDOM=1;
+
+	rm -f "${SOURCE_FILE}";
+
+	while test ${BLOCK_INDEX} -lt ${SOURCE_SIZE};
+	do
+		case $(( RANDOM % 8 )) in
+		0|1|2)
+			head -c 1048576 /dev/zero;
+			;;
+		3|4)
+			yes "the evidence file contains a copy of the media data acquired from disk sectors" | head -c 1048576;
+			;;
+		5|6)
+			head -c 1048576 /dev/urandom;
+			;;
+		*)
+			seq -w 0 99999999 | head -c 1048576;
+			;;
+		esac
+		BLOCK_INDEX=$(( BLOCK_INDEX + 1 ));
+	done > "${SOURCE_FILE}";
+}
+
+# Runs a scenario of the benchmark and appends its samples to the samples file
+# as tab separated lines of: scenario, metric, direction and value, where
+# direction is either "higher" or "lower" is better.
+#
+# Arguments:
+#   a string containing the name of the scenario
+#   a string containing the path of the samples file
+#
+run_benchmark_scenario()
+{
+	local SCENARIO=$1;
+	local SAMPLES_FILE=$2;
+	local OUTPUT_FILE="${BENCHMARK_DIRECTORY}/output";
+	local RESULT=${EXIT_SUCCESS};
+
+	case ${SCENARIO} in
+	kernels)
+		${BENCH_KERNELS} ${BENCHMARK_KERNELS_OPTIONS} > "${OUTPUT_FILE}" 2> "${BENCHMARK_DIRECTORY}/stderr";
+		RESULT=$?;
+
+		# kernel, corpus, chunk size, iterations, bytes, nanoseconds, MB/s
+		AWK_PROGRAM='{
+			printf( "kernels\t%s/%s/%s/MB_per_second\thigher\t%s\n", $1, $2, $3, $7 );
+		}';
+		;;
+	open)
+		${BENCH_OPEN} -d "${BENCHMARK_DIRECTORY}" ${BENCHMARK_OPEN_OPTIONS} > "${OUTPUT_FILE}" 2> "${BENCHMARK_DIRECTORY}/stderr";
+		RESULT=$?;
+
+		# format, segments, chunks, mode, latency, runs, open, first read and close time, resident memory
+		AWK_PROGRAM='{
+			name = sprintf( "%s/%s_segments/%s_chunks/%s/%sus", $1, $2, $3, $4, $5 );
+
+			printf( "open\t%s/open_ns\tlower\t%s\n", name, $7 );
+			printf( "open\t%s/first_read_ns\tlower\t%s\n", name, $8 );
+		}';
+		;;
+	random_read)
+		${BENCH_RANDOM_READ} ${BENCHMARK_RANDOM_READ_OPTIONS} "${IMAGE_FILE}" > "${OUTPUT_FILE}" 2> "${BENCHMARK_DIRECTORY}/stderr";
+		RESULT=$?;
+
+		# cache size, reads, bytes, p50, p99, p99.9, maximum and mean latency, hits, misses, hit rate
+		AWK_PROGRAM='{
+			name = sprintf( "%sMiB", $1 );
+
+			printf( "random_read\t%s/p50_ns\tlower\t%s\n", name, $4 );
+			printf( "random_read\t%s/p99_ns\tlower\t%s\n", name, $5 );
+			printf( "random_read\t%s/mean_ns\tlower\t%s\n", name, $8 );
+		}';
+		;;
+	pipeline)
+		mkdir -p "${BENCHMARK_DIRECTORY}/pipeline";
+
+		BENCHMARK_SOURCE_SIZE=${BENCHMARK_SOURCE_SIZE} \
+		BENCHMARK_FORMATS=${BENCHMARK_PIPELINE_FORMATS:-"encase6"} \
+		BENCHMARK_COMPRESSION_LEVELS=${BENCHMARK_PIPELINE_COMPRESSION_LEVELS:-"none fast"} \
+		BENCHMARK_THREADS=${BENCHMARK_PIPELINE_THREADS:-"1"} \
+		BENCHMARK_PROCESS_BUFFER_SIZES=${BENCHMARK_PIPELINE_PROCESS_BUFFER_SIZES:-"32768"} \
+		BENCHMARK_DIRECTORY="${BENCHMARK_DIRECTORY}/pipeline" \
+		bash "${SCRIPT_DIRECTORY}/benchmark_ewftools.sh" > "${OUTPUT_FILE}" 2> "${BENCHMARK_DIRECTORY}/stderr";
+		RESULT=$?;
+
+		# stage, format, compression level, threads, process buffer size, bytes, wall time, CPU time, peak RSS, MB/s
+		AWK_PROGRAM='{
+			printf( "pipeline\t%s/%s/%s/%s_threads/%s/MB_per_second\thigher\t%s\n", $1, $2, $3, $4, $5, $10 );
+		}';
+		;;
+	*)
+		echo "Unsupported scenario: ${SCENARIO}" >&2;
+
+		return ${EXIT_FAILURE};
+		;;
+	esac
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo "Scenario: ${SCENARIO} failed" >&2;
+		cat "${BENCHMARK_DIRECTORY}/stderr" >&2;
+
+		return ${RESULT};
+	fi
+	grep -v '^#' "${OUTPUT_FILE}" | grep -v '^$' | awk -F '\t' "${AWK_PROGRAM}" >> "${SAMPLES_FILE}";
+
+	return ${EXIT_SUCCESS};
+}
+
+# Calculates the number of samples, mean and sample standard deviation per
+# metric and prints them as tab separated lines of: scenario, metric,
+# direction, number of samples, mean and standard deviation
+#
+# Arguments:
+#   a string containing the path of the samples file
+#
+calculate_statistics()
+{
+	local SAMPLES_FILE=$1;
+
+	awk -F '\t' '{
+		key = $1 "\t" $2 "\t" $3;
+
+		if( !( key in count ) )
+		{
+			keys[ number_of_keys++ ] = key;
+		}
+		count[ key ] += 1;
+		sum[ key ] += $4;
+		sum_of_squares[ key ] += $4 * $4;
+	}
+	END {
+		for( key_index = 0; key_index < number_of_keys; key_index++ )
+		{
+			key = keys[ key_index ];
+			mean = sum[ key ] / count[ key ];
+			variance = 0.0;
+
+			if( count[ key ] > 1 )
+			{
+				variance = ( sum_of_squares[ key ] - ( count[ key ] * mean * mean ) ) / ( count[ key ] - 1 );
+			}
+			if( variance < 0.0 )
+			{
+				variance = 0.0;
+			}
+			printf( "%s\t%d\t%.6f\t%.6f\n", key, count[ key ], mean, sqrt( variance ) );
+		}
+	}' "${SAMPLES_FILE}";
+}
+
+# Writes the statistics as a JSON baseline
+#
+# Arguments:
+#   a string containing the path of the statistics file
+#   a string containing the path of the baseline file
+#
+write_baseline()
+{
+	local STATISTICS_FILE=$1;
+	local BASELINE_FILE=$2;
+
+	awk -F '\t' -v profile="${BENCHMARK_PROFILE}" -v date="$( date -u +%Y-%m-%dT%H:%M:%SZ )" -v repetitions="${BENCHMARK_REPETITIONS}" '
+	BEGIN {
+		printf( "{\n" );
+		printf( "  \"profile\": \"%s\",\n", profile );
+		printf( "  \"date\": \"%s\",\n", date );
+		printf( "  \"repetitions\": %d,\n", repetitions );
+		printf( "  \"metrics\": [\n" );
+	}
+	{
+		if( NR > 1 )
+		{
+			printf( ",\n" );
+		}
+		printf( "    { \"scenario\": \"%s\", \"name\": \"%s\", \"better\": \"%s\", \"count\": %d, \"mean\": %s, \"stddev\": %s }", $1, $2, $3, $4, $5, $6 );
+	}
+	END {
+		printf( "\n  ]\n" );
+		printf( "}\n" );
+	}' "${STATISTICS_FILE}" > "${BASELINE_FILE}";
+}
+
+# Reads the metrics of a JSON baseline written by write_baseline and prints
+# them as tab separated lines of: scenario, metric, direction, number of
+# samples, mean and standard deviation
+#
+# Arguments:
+#   a string containing the path of the baseline file
+#
+read_baseline()
+{
+	local BASELINE_FILE=$1;
+
+	awk '
+	function get_value( line, name )
+	{
+		if( match( line, "\"" name "\": \"[^\"]*\"" ) )
+		{
+			value = substr( line, RSTART, RLENGTH );
+			sub( "^\"" name "\": \"", "", value );
+			sub( "\"$", "", value );
+
+			return value;
+		}
+		if( match( line, "\"" name "\": [-+0-9.eE]*" ) )
+		{
+			value = substr( line, RSTART, RLENGTH );
+			sub( "^\"" name "\": ", "", value );
+
+			return value;
+		}
+		return "";
+	}
+	/"scenario": / {
+		printf( "%s\t%s\t%s\t%s\t%s\t%s\n", get_value( $0, "scenario" ), get_value( $0, "name" ), get_value( $0, "better" ), get_value( $0, "count" ), get_value( $0, "mean" ), get_value( $0, "stddev" ) );
+	}' "${BASELINE_FILE}";
+}
+
+# Compares the statistics against the baseline and prints the results as tab
+# separated lines of: scenario, metric, baseline mean, current mean, change in
+# percent, t statistic and status, followed by a summary per scenario and
+# kernel or stage. Returns failure if a regression was detected.
+#
+# Arguments:
+#   a string containing the path of the baseline statistics file
+#   a string containing the path of the current statistics file
+#
+compare_statistics()
+{
+	local BASELINE_STATISTICS_FILE=$1;
+	local CURRENT_STATISTICS_FILE=$2;
+
+	awk -F '\t' -v threshold="${BENCHMARK_THRESHOLD}" '
+	# Critical values of the two-sided Student t-distribution at a 95% confidence level
+	function get_critical_value( degrees_of_freedom )
+	{
+		split( "12.706 4.303 3.182 2.776 2.571 2.447 2.365 2.306 2.262 2.228 2.201 2.179 2.160 2.145 2.131 2.120 2.110 2.101 2.093 2.086 2.080 2.074 2.069 2.064 2.060 2.056 2.052 2.048 2.045 2.042", critical_values, " " );
+
+		if( degrees_of_freedom < 1 )
+		{
+			degrees_of_freedom = 1;
+		}
+		if( degrees_of_freedom <= 30 )
+		{
+			return critical_values[ int( degrees_of_freedom ) ];
+		}
+		if( degrees_of_freedom <= 60 )
+		{
+			return 2.000;
+		}
+		if( degrees_of_freedom <= 120 )
+		{
+			return 1.980;
+		}
+		return 1.960;
+	}
+	FNR == NR {
+		key = $1 "\t" $2;
+		baseline_count[ key ] = $4;
+		baseline_mean[ key ] = $5;
+		baseline_stddev[ key ] = $6;
+
+		next;
+	}
+	{
+		key = $1 "\t" $2;
+
+		if( !( key in baseline_mean ) )
+		{
+			printf( "%s\t%s\t-\t%.2f\t-\t-\tnew\n", $1, $2, $5 );
+
+			next;
+		}
+		current_count = $4;
+		current_mean = $5;
+		current_stddev = $6;
+
+		change = 0.0;
+
+		if( baseline_mean[ key ] != 0.0 )
+		{
+			change = ( current_mean - baseline_mean[ key ] ) * 100.0 / baseline_mean[ key ];
+		}
+		# The relative change in the direction that is worse
+		worse_change = ( $3 == "higher" ) ? -change : change;
+
+		t_statistic = "-";
+		significant = 1;
+
+		if( ( current_count > 1 ) && ( baseline_count[ key ] > 1 ) )
+		{
+			baseline_variance = ( baseline_stddev[ key ] * baseline_stddev[ key ] ) / baseline_count[ key ];
+			current_variance = ( current_stddev * current_stddev ) / current_count;
+			standard_error = sqrt( baseline_variance + current_variance );
+
+			if( standard_error > 0.0 )
+			{
+				t_value = ( current_mean - baseline_mean[ key ] ) / standard_error;
+
+				# The Welch-Satterthwaite approximation of the degrees of freedom
+				degrees_of_freedom = ( baseline_variance + current_variance ) ^ 2;
+				degrees_of_freedom /= ( ( baseline_variance ^ 2 ) / ( baseline_count[ key ] - 1 ) ) + ( ( current_variance ^ 2 ) / ( current_count - 1 ) );
+
+				significant = ( ( t_value < 0 ? -t_value : t_value ) > get_critical_value( degrees_of_freedom ) );
+
+				t_statistic = sprintf( "%.2f", t_value );
+			}
+		}
+		status = "unchanged";
+
+		if( significant && ( worse_change > threshold ) )
+		{
+			status = "regression";
+		}
+		else if( significant && ( -worse_change > threshold ) )
+		{
+			status = "improvement";
+		}
+		printf( "%s\t%s\t%.2f\t%.2f\t%+.2f\t%s\t%s\n", $1, $2, baseline_mean[ key ], current_mean, change, t_statistic, status );
+
+		# Summarize per scenario and kernel or stage
+		sub( "/.*", "", $2 );
+		group = $1 "/" $2;
+
+		if( !( group in group_metrics ) )
+		{
+			groups[ number_of_groups++ ] = group;
+		}
+		group_metrics[ group ] += 1;
+
+		if( status == "regression" )
+		{
+			group_regressions[ group ] += 1;
+			number_of_regressions += 1;
+		}
+		else if( status == "improvement" )
+		{
+			group_improvements[ group ] += 1;
+		}
+	}
+	END {
+		printf( "\n# scenario/kernel_or_stage\tmetrics\tregressions\timprovements\n" );
+
+		for( group_index = 0; group_index < number_of_groups; group_index++ )
+		{
+			group = groups[ group_index ];
+
+			printf( "%s\t%d\t%d\t%d\n", group, group_metrics[ group ], group_regressions[ group ], group_improvements[ group ] );
+		}
+		if( number_of_regressions > 0 )
+		{
+			printf( "\nDetected %d regression(s) of more than %s%%\n", number_of_regressions, threshold );
+
+			exit 1;
+		}
+		exit 0;
+	}' "${BASELINE_STATISTICS_FILE}" "${CURRENT_STATISTICS_FILE}";
+}
+
+MODE=${1:-"compare"};
+
+if test "${MODE}" != "record" && test "${MODE}" != "compare";
+then
+	echo "Usage: benchmark_regression.sh [ record | compare ]" >&2;
+
+	exit ${EXIT_FAILURE};
+fi
+if test ${BENCHMARK_REPETITIONS} -lt 1;
+then
+	echo "Unsupported number of repetitions: ${BENCHMARK_REPETITIONS}" >&2;
+
+	exit ${EXIT_FAILURE};
+fi
+SCRIPT_DIRECTORY=$( dirname "$0" );
+
+if test -z "${BENCHMARK_PROFILE}";
+then
+	BENCHMARK_PROFILE=$( get_machine_profile );
+fi
+BASELINE_FILE="${BENCHMARK_BASELINE_DIRECTORY}/${BENCHMARK_PROFILE}.json";
+
+if test "${MODE}" = "compare" && ! test -f "${BASELINE_FILE}";
+then
+	echo "Missing baseline: ${BASELINE_FILE}, run: benchmark_regression.sh record" >&2;
+
+	exit ${EXIT_IGNORE};
+fi
+SCENARIOS="";
+
+for SCENARIO in ${BENCHMARK_SCENARIOS};
+do
+	case ${SCENARIO} in
+	kernels)
+		BENCH_KERNELS=$( find_executable "./ewf_bench_kernels" ) || exit ${EXIT_FAILURE};
+		;;
+	open)
+		BENCH_OPEN=$( find_executable "./ewf_bench_open" ) || exit ${EXIT_FAILURE};
+		;;
+	random_read)
+		BENCH_RANDOM_READ=$( find_executable "./ewf_bench_random_read" ) || exit ${EXIT_FAILURE};
+		ACQUIRE_TOOL=$( find_executable "../ewftools/ewfacquire" ) || exit ${EXIT_FAILURE};
+		;;
+	pipeline)
+		if ! test -z ${SKIP_TOOLS_TESTS};
+		then
+			echo "Skipping scenario: pipeline" >&2;
+
+			continue;
+		fi
+		;;
+	*)
+		echo "Unsupported scenario: ${SCENARIO}" >&2;
+
+		exit ${EXIT_FAILURE};
+		;;
+	esac
+	SCENARIOS="${SCENARIOS} ${SCENARIO}";
+done
+
+if test -z "${BENCHMARK_DIRECTORY}";
+then
+	BENCHMARK_DIRECTORY="tmp$$";
+
+	rm -rf ${BENCHMARK_DIRECTORY};
+	mkdir ${BENCHMARK_DIRECTORY};
+
+	trap "rm -rf ${BENCHMARK_DIRECTORY}" EXIT;
+fi
+SAMPLES_FILE="${BENCHMARK_DIRECTORY}/samples";
+STATISTICS_FILE="${BENCHMARK_DIRECTORY}/statistics";
+
+rm -f "${SAMPLES_FILE}";
+
+if [[ "${SCENARIOS}" == *random_read* ]];
+then
+	SOURCE_FILE="${BENCHMARK_DIRECTORY}/source.raw";
+	TARGET="${BENCHMARK_DIRECTORY}/random_read";
+
+	generate_source "${SOURCE_FILE}" ${BENCHMARK_SOURCE_SIZE};
+
+	"${ACQUIRE_TOOL}" -c deflate:fast -f encase6 -q -t "${TARGET}" -u "${SOURCE_FILE}" > /dev/null 2> "${BENCHMARK_DIRECTORY}/stderr";
+
+	if test $? -ne ${EXIT_SUCCESS};
+	then
+		echo "Unable to acquire image for scenario: random_read" >&2;
+		cat "${BENCHMARK_DIRECTORY}/stderr" >&2;
+
+		exit ${EXIT_FAILURE};
+	fi
+	IMAGE_FILE=`ls -1 ${TARGET}.* | head -n 1`;
+fi
+
+echo "Benchmark profile: ${BENCHMARK_PROFILE}" >&2;
+
+REPETITION=1;
+
+while test ${REPETITION} -le ${BENCHMARK_REPETITIONS};
+do
+	for SCENARIO in ${SCENARIOS};
+	do
+		echo "Repetition: ${REPETITION} of ${BENCHMARK_REPETITIONS} scenario: ${SCENARIO}" >&2;
+
+		run_benchmark_scenario "${SCENARIO}" "${SAMPLES_FILE}";
+		RESULT=$?;
+
+		if test ${RESULT} -eq ${EXIT_IGNORE};
+		then
+			# Remove the scenario, for example if GNU time is not available
+			echo "Skipping scenario: ${SCENARIO}" >&2;
+
+			SCENARIOS=$( echo "${SCENARIOS}" | sed "s/ ${SCENARIO}//" );
+
+		elif test ${RESULT} -ne ${EXIT_SUCCESS};
+		then
+			exit ${EXIT_FAILURE};
+		fi
+	done
+	REPETITION=$(( REPETITION + 1 ));
+done
+
+if ! test -s "${SAMPLES_FILE}";
+then
+	echo "No benchmark results" >&2;
+
+	exit ${EXIT_IGNORE};
+fi
+calculate_statistics "${SAMPLES_FILE}" > "${STATISTICS_FILE}";
+
+if test "${MODE}" = "record";
+then
+	mkdir -p "${BENCHMARK_BASELINE_DIRECTORY}";
+
+	write_baseline "${STATISTICS_FILE}" "${BASELINE_FILE}";
+
+	echo "Recorded baseline: ${BASELINE_FILE}";
+
+	exit ${EXIT_SUCCESS};
+fi
+read_baseline "${BASELINE_FILE}" > "${BENCHMARK_DIRECTORY}/baseline";
+
+echo -e "# scenario\tmetric\tbaseline\tcurrent\tchange_percent\tt\tstatus";
+
+compare_statistics "${BENCHMARK_DIRECTORY}/baseline" "${STATISTICS_FILE}";
+
+if test $? -ne ${EXIT_SUCCESS};
+then
+	exit ${EXIT_FAILURE};
+fi
+exit ${EXIT_SUCCESS};
@@ -0,0 +1,157 @@
+#!/bin/bash
+# Tools startup time benchmark script
+#
+# Version: 20261015
+#
+# Acquires a small image and measures the time of repeatedly running
+# ewfinfo and ewfverify on it, which is dominated by the startup time of
+# the tools and the time to open the image.
+#
+# The results are written to stdout as tab separated lines of:
+# tool, number of runs, wall time and wall time per run in milliseconds
+#
+# The benchmark can be changed with the following environment variables:
+#   BENCHMARK_SOURCE_SIZE: size of the source in KiB (default 64)
+#   BENCHMARK_FORMATS: EWF formats (default "encase6 encase7-v2")
+#   BENCHMARK_NUMBER_OF_RUNS: number of runs per tool (default 1000)
+#   BENCHMARK_DIRECTORY: directory to write the source and images to
+
+EXIT_SUCCESS=0;
+EXIT_FAILURE=1;
+EXIT_IGNORE=77;
+
+BENCHMARK_SOURCE_SIZE=${BENCHMARK_SOURCE_SIZE:-64};
+BENCHMARK_FORMATS=${BENCHMARK_FORMATS:-"encase6 encase7-v2"};
+BENCHMARK_NUMBER_OF_RUNS=${BENCHMARK_NUMBER_OF_RUNS:-1000};
+
+# Finds a tool executable and exits if not available.
+#
+# Arguments:
+#   a string containing the name of the tool
+#
+find_tool_executable()
+{
+	local TOOL_NAME=$1;
+	local TOOL_EXECUTABLE="../ewftools/${TOOL_NAME}";
+
+	if ! test -x "${TOOL_EXECUTABLE}";
+	then
+		TOOL_EXECUTABLE="../ewftools/${TOOL_NAME}.exe";
+	fi
+	if ! test -x "${TOOL_EXECUTABLE}";
+	then
+		echo "Missing executable: ${TOOL_EXECUTABLE}" >&2;
+
+		exit ${EXIT_FAILURE};
+	fi
+	echo "${TOOL_EXECUTABLE}";
+}
+
+# Runs a tool a number of times and prints its measurements
+#
+# Arguments:
+#   a string containing the name of the tool
+#   a string containing the format
+#   the command to run
+#
+run_benchmark_tool()
+{
+	local TOOL_NAME=$1;
+	local FORMAT=$2;
+	shift 2;
+
+	local RUN_INDEX=0;
+	local START_TIME=$( date +%s%N );
+
+	while test ${RUN_INDEX} -lt ${BENCHMARK_NUMBER_OF_RUNS};
+	do
+		"$@" > /dev/null 2> "${BENCHMARK_DIRECTORY}/stderr";
+
+		if test $? -ne ${EXIT_SUCCESS};
+		then
+			echo "Tool: ${TOOL_NAME} failed with command: $*" >&2;
+			cat "${BENCHMARK_DIRECTORY}/stderr" >&2;
+
+			return ${EXIT_FAILURE};
+		fi
+		RUN_INDEX=$(( RUN_INDEX + 1 ));
+	done
+	local END_TIME=$( date +%s%N );
+
+	echo "${START_TIME} ${END_TIME}" | awk -v tool="${TOOL_NAME}" -v format="${FORMAT}" -v runs="${BENCHMARK_NUMBER_OF_RUNS}" '{
+		wall_time = ( $2 - $1 ) / 1000000000.0;
+
+		printf( "%s\t%s\t%d\t%.3f\t%.3f\n", tool, format, runs, wall_time, wall_time * 1000.0 / runs );
+	}';
+	return ${EXIT_SUCCESS};
+}
+
+if ! test -z ${SKIP_TOOLS_TESTS};
+then
+	exit ${EXIT_IGNORE};
+fi
+
+# The nanoseconds are not supported by every date implementation
+if ! date +%s%N | grep -q "^[0-9]*$";
+then
+	echo "Unsupported date: missing nanoseconds" >&2;
+
+	exit ${EXIT_IGNORE};
+fi
+
+ACQUIRE_TOOL=$( find_tool_executable "ewfacquire" ) || exit ${EXIT_FAILURE};
+INFO_TOOL=$( find_tool_executable "ewfinfo" ) || exit ${EXIT_FAILURE};
+VERIFY_TOOL=$( find_tool_executable "ewfverify" ) || exit ${EXIT_FAILURE};
+
+if test -z "${BENCHMARK_DIRECTORY}";
+then
+	BENCHMARK_DIRECTORY="tmp$$";
+
+	rm -rf ${BENCHMARK_DIRECTORY};
+	mkdir ${BENCHMARK_DIRECTORY};
+
+	trap "rm -rf ${BENCHMARK_DIRECTORY}" EXIT;
+fi
+
+SOURCE_FILE="${BENCHMARK_DIRECTORY}/source.raw";
+
+head -c $(( BENCHMARK_SOURCE_SIZE * 1024 )) /dev/urandom > "${SOURCE_FILE}";
+
+echo -e "# tool\tformat\truns\twall_time\tms_per_run";
+
+RESULT=${EXIT_SUCCESS};
+
+for FORMAT in ${BENCHMARK_FORMATS};
+do
+	TARGET="${BENCHMARK_DIRECTORY}/image_${FORMAT}";
+
+	"${ACQUIRE_TOOL}" -f ${FORMAT} -q -t "${TARGET}" -u "${SOURCE_FILE}" > /dev/null 2>&1;
+
+	if test $? -ne ${EXIT_SUCCESS};
+	then
+		echo "Unable to acquire image in format: ${FORMAT}" >&2;
+
+		RESULT=${EXIT_FAILURE};
+
+		break;
+	fi
+	IMAGE_FILE=`ls -1 ${TARGET}.* | head -n 1`;
+
+	run_benchmark_tool "ewfinfo" "${FORMAT}" "${INFO_TOOL}" "${IMAGE_FILE}";
+	RESULT=$?;
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		break;
+	fi
+	run_benchmark_tool "ewfverify" "${FORMAT}" "${VERIFY_TOOL}" -q "${IMAGE_FILE}";
+	RESULT=$?;
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		break;
+	fi
+done
+
+exit ${RESULT};
+
@@ -0,0 +1,1129 @@
+/*
+ * Library compression, checksum and empty block kernels benchmark program
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <stdio.h>
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+#include <zlib.h>
+#endif
+
+#include "ewf_test_getopt.h"
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_checksum.h"
+#include "../libewf/libewf_chunk_data.h"
+#include "../libewf/libewf_compression.h"
+#include "../libewf/libewf_compression_context.h"
+#include "../libewf/libewf_definitions.h"
+#include "../libewf/libewf_deflate.h"
+#include "../libewf/libewf_io_handle.h"
+#include "../libewf/libewf_parallel_deflate.h"
+#include "../libewf/libewf_statistics.h"
+
+/* The number of bytes processed per measurement if no number of iterations is provided
+ */
+#define EWF_BENCH_DEFAULT_MEASUREMENT_SIZE	( 32 * 1024 * 1024 )
+
+/* The number of threads used to benchmark deflating a chunk in segments
+ */
+#define EWF_BENCH_PARALLEL_DEFLATE_NUMBER_OF_THREADS	4
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+enum EWF_BENCH_CORPUS_TYPES
+{
+	EWF_BENCH_CORPUS_TYPE_ZEROS,
+	EWF_BENCH_CORPUS_TYPE_TEXT,
+	EWF_BENCH_CORPUS_TYPE_RANDOM,
+	EWF_BENCH_CORPUS_TYPE_DISK,
+
+	EWF_BENCH_NUMBER_OF_CORPUS_TYPES
+};
+
+static const char *ewf_bench_corpus_names[ EWF_BENCH_NUMBER_OF_CORPUS_TYPES ] = {
+	"zeros",
+	"text",
+	"random",
+	"disk" };
+
+/* The words the text corpus is made up of
+ */
+static const char *ewf_bench_text_words[ 16 ] = {
+	"the ", "evidence ", "file ", "contains ", "a ", "copy ", "of ", "media ",
+	"data ", "acquired ", "from ", "disk ", "sectors ", "and ", "metadata.\n", "volume " };
+
+/* The chunk sizes used if no chunk size is provided
+ */
+static const uint32_t ewf_bench_default_chunk_sizes[ 4 ] = {
+	32768,
+	65536,
+	1048576,
+	4194304 };
+
+/* Copies a string of a decimal value to a 64-bit value
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_system_string_decimal_copy_to_64_bit(
+     const system_character_t *string,
+     size_t string_size,
+     uint64_t *value_64bit,
+     libcerror_error_t **error )
+{
+	static char *function              = "ewf_test_system_string_decimal_copy_to_64_bit";
+	size_t string_index                = 0;
+	system_character_t character_value = 0;
+	uint8_t maximum_string_index       = 20;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid string size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value 64-bit.",
+		 function );
+
+		return( -1 );
+	}
+	*value_64bit = 0;
+
+	while( string_index < string_size )
+	{
+		if( string[ string_index ] == 0 )
+		{
+			break;
+		}
+		if( string_index > (size_t) maximum_string_index )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_LARGE,
+			 "%s: string too large.",
+			 function );
+
+			return( -1 );
+		}
+		*value_64bit *= 10;
+
+		if( ( string[ string_index ] >= (system_character_t) '0' )
+		 && ( string[ string_index ] <= (system_character_t) '9' ) )
+		{
+			character_value = (system_character_t) ( string[ string_index ] - (system_character_t) '0' );
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported character value: %" PRIc_SYSTEM " at index: %d.",
+			 function,
+			 string[ string_index ],
+			 string_index );
+
+			return( -1 );
+		}
+		*value_64bit += character_value;
+
+		string_index++;
+	}
+	return( 1 );
+}
+
+/* Retrieves the next value of a xorshift pseudo random number generator
+ * The benchmark uses its own generator so that the corpora are the same on every platform
+ */
+uint32_t ewf_bench_get_random_value(
+          uint32_t *random_state )
+{
+	uint32_t value = *random_state;
+
+	value ^= value << 13;
+	value ^= value >> 17;
+	value ^= value << 5;
+
+	*random_state = value;
+
+	return( value );
+}
+
+/* Fills data with a corpus
+ * The disk corpus mimics a disk image with runs of unused sectors, text,
+ * compressed (random) data and file system tables in 4096 byte blocks
+ */
+void ewf_bench_fill_corpus(
+      uint8_t *data,
+      size_t data_size,
+      int corpus_type )
+{
+	const char *word      = NULL;
+	size_t block_end      = 0;
+	size_t data_offset    = 0;
+	uint32_t block_type   = 0;
+	uint32_t random_state = 0x2545f491UL;
+
+	while( data_offset < data_size )
+	{
+		block_end = data_offset + 4096;
+
+		if( block_end > data_size )
+		{
+			block_end = data_size;
+		}
+		if( corpus_type == EWF_BENCH_CORPUS_TYPE_DISK )
+		{
+			block_type = ewf_bench_get_random_value(
+			              &random_state ) % 8;
+		}
+		if( ( corpus_type == EWF_BENCH_CORPUS_TYPE_ZEROS )
+		 || ( ( corpus_type == EWF_BENCH_CORPUS_TYPE_DISK )
+		  && ( block_type < 3 ) ) )
+		{
+			while( data_offset < block_end )
+			{
+				data[ data_offset++ ] = 0;
+			}
+		}
+		else if( ( corpus_type == EWF_BENCH_CORPUS_TYPE_TEXT )
+		      || ( ( corpus_type == EWF_BENCH_CORPUS_TYPE_DISK )
+		       && ( block_type < 5 ) ) )
+		{
+			while( data_offset < block_end )
+			{
+				word = ewf_bench_text_words[ ewf_bench_get_random_value( &random_state ) % 16 ];
+
+				while( ( *word != 0 )
+				    && ( data_offset < block_end ) )
+				{
+					data[ data_offset++ ] = (uint8_t) *word++;
+				}
+			}
+		}
+		else if( ( corpus_type == EWF_BENCH_CORPUS_TYPE_RANDOM )
+		      || ( ( corpus_type == EWF_BENCH_CORPUS_TYPE_DISK )
+		       && ( block_type < 7 ) ) )
+		{
+			while( data_offset < block_end )
+			{
+				data[ data_offset++ ] = (uint8_t) ( ewf_bench_get_random_value( &random_state ) >> 24 );
+			}
+		}
+		else
+		{
+			/* File system table entries of 32 bytes with an increasing number
+			 */
+			while( data_offset < block_end )
+			{
+				if( ( data_offset % 32 ) < 4 )
+				{
+					data[ data_offset ] = (uint8_t) ( ( data_offset / 32 ) >> ( ( data_offset % 4 ) * 8 ) );
+				}
+				else if( ( data_offset % 32 ) < 8 )
+				{
+					data[ data_offset ] = 0x01;
+				}
+				else
+				{
+					data[ data_offset ] = 0;
+				}
+				data_offset++;
+			}
+		}
+	}
+}
+
+/* Prints the result of a measurement as a tab separated line
+ */
+void ewf_bench_print_result(
+      const char *kernel_name,
+      int corpus_type,
+      uint32_t chunk_size,
+      uint64_t number_of_iterations,
+      int64_t elapsed_time )
+{
+	double megabytes_per_second = 0.0;
+	uint64_t processed_size     = number_of_iterations * chunk_size;
+
+	if( elapsed_time > 0 )
+	{
+		megabytes_per_second = ( (double) processed_size * 1000.0 ) / (double) elapsed_time;
+	}
+	fprintf(
+	 stdout,
+	 "%s\t%s\t%" PRIu32 "\t%" PRIu64 "\t%" PRIu64 "\t%" PRIi64 "\t%.2f\n",
+	 kernel_name,
+	 ewf_bench_corpus_names[ corpus_type ],
+	 chunk_size,
+	 number_of_iterations,
+	 processed_size,
+	 elapsed_time,
+	 megabytes_per_second );
+}
+
+/* Benchmarks the compression, checksum and empty block kernels on a corpus
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_kernels(
+     libewf_compression_context_t *compression_context,
+     libewf_io_handle_t *io_handle,
+     const uint8_t *data,
+     uint32_t chunk_size,
+     int corpus_type,
+     uint64_t number_of_iterations,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	uint8_t *compressed_data        = NULL;
+	uint8_t *uncompressed_data      = NULL;
+	static char *function           = "ewf_bench_kernels";
+	size_t compressed_data_size     = 0;
+	size_t maximum_compressed_size  = 0;
+	size_t uncompressed_data_size   = 0;
+	uint64_t iteration              = 0;
+	int64_t end_timestamp           = 0;
+	int64_t pack_time               = 0;
+	int64_t start_timestamp         = 0;
+	int64_t unpack_time             = 0;
+	uint32_t checksum               = 0;
+	int result                      = 0;
+
+	/* Deflate can expand incompressible data slightly
+	 */
+	maximum_compressed_size = ( 2 * (size_t) chunk_size ) + 1024;
+
+	compressed_data = (uint8_t *) memory_allocate(
+	                               sizeof( uint8_t ) * maximum_compressed_size );
+
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create compressed data.",
+		 function );
+
+		goto on_error;
+	}
+	uncompressed_data = (uint8_t *) memory_allocate(
+	                                 sizeof( uint8_t ) * chunk_size );
+
+	if( uncompressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create uncompressed data.",
+		 function );
+
+		goto on_error;
+	}
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+	/* libewf_parallel_deflate_compress, only for chunks large enough to be deflated in segments
+	 */
+	if( chunk_size >= ( 2 * LIBEWF_PARALLEL_DEFLATE_MINIMUM_SEGMENT_SIZE ) )
+	{
+		if( libewf_statistics_get_timestamp(
+		     &start_timestamp,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		for( iteration = 0;
+		     iteration < number_of_iterations;
+		     iteration++ )
+		{
+			compressed_data_size = maximum_compressed_size;
+
+			if( libewf_parallel_deflate_compress(
+			     compressed_data,
+			     &compressed_data_size,
+			     Z_DEFAULT_COMPRESSION,
+			     data,
+			     (size_t) chunk_size,
+			     EWF_BENCH_PARALLEL_DEFLATE_NUMBER_OF_THREADS,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+				 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+				 "%s: unable to compress data in parallel.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( libewf_statistics_get_timestamp(
+		     &end_timestamp,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		ewf_bench_print_result(
+		 "parallel_deflate_compress",
+		 corpus_type,
+		 chunk_size,
+		 number_of_iterations,
+		 end_timestamp - start_timestamp );
+	}
+#endif /* ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL ) */
+
+	/* libewf_compress_data
+	 */
+	if( libewf_statistics_get_timestamp(
+	     &start_timestamp,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	for( iteration = 0;
+	     iteration < number_of_iterations;
+	     iteration++ )
+	{
+		compressed_data_size = maximum_compressed_size;
+
+		if( libewf_compress_data(
+		     compression_context,
+		     compressed_data,
+		     &compressed_data_size,
+		     LIBEWF_COMPRESSION_METHOD_DEFLATE,
+		     LIBEWF_COMPRESSION_DEFAULT,
+		     data,
+		     (size_t) chunk_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+			 "%s: unable to compress data.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_statistics_get_timestamp(
+	     &end_timestamp,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	ewf_bench_print_result(
+	 "compress_data",
+	 corpus_type,
+	 chunk_size,
+	 number_of_iterations,
+	 end_timestamp - start_timestamp );
+
+	/* libewf_decompress_data with the default decompression backend
+	 */
+	if( libewf_statistics_get_timestamp(
+	     &start_timestamp,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	for( iteration = 0;
+	     iteration < number_of_iterations;
+	     iteration++ )
+	{
+		uncompressed_data_size = (size_t) chunk_size;
+
+		if( libewf_decompress_data(
+		     compression_context,
+		     compressed_data,
+		     compressed_data_size,
+		     LIBEWF_COMPRESSION_METHOD_DEFLATE,
+		     LIBEWF_DECOMPRESSION_BACKEND_DEFAULT,
+		     uncompressed_data,
+		     &uncompressed_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+			 "%s: unable to decompress data.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_statistics_get_timestamp(
+	     &end_timestamp,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	ewf_bench_print_result(
+	 "decompress_data",
+	 corpus_type,
+	 chunk_size,
+	 number_of_iterations,
+	 end_timestamp - start_timestamp );
+
+	/* libewf_deflate_decompress, the built-in deflate implementation
+	 */
+	if( libewf_statistics_get_timestamp(
+	     &start_timestamp,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	for( iteration = 0;
+	     iteration < number_of_iterations;
+	     iteration++ )
+	{
+		uncompressed_data_size = (size_t) chunk_size;
+
+		if( libewf_deflate_decompress(
+		     compressed_data,
+		     compressed_data_size,
+		     uncompressed_data,
+		     &uncompressed_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+			 "%s: unable to decompress data.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_statistics_get_timestamp(
+	     &end_timestamp,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	ewf_bench_print_result(
+	 "deflate_decompress",
+	 corpus_type,
+	 chunk_size,
+	 number_of_iterations,
+	 end_timestamp - start_timestamp );
+
+	/* libewf_checksum_calculate_adler32
+	 */
+	if( libewf_statistics_get_timestamp(
+	     &start_timestamp,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	for( iteration = 0;
+	     iteration < number_of_iterations;
+	     iteration++ )
+	{
+		if( libewf_checksum_calculate_adler32(
+		     &checksum,
+		     data,
+		     (size_t) chunk_size,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to calculate checksum.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_statistics_get_timestamp(
+	     &end_timestamp,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	ewf_bench_print_result(
+	 "checksum_calculate_adler32",
+	 corpus_type,
+	 chunk_size,
+	 number_of_iterations,
+	 end_timestamp - start_timestamp );
+
+	/* libewf_chunk_data_check_for_empty_block
+	 */
+	if( libewf_statistics_get_timestamp(
+	     &start_timestamp,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	for( iteration = 0;
+	     iteration < number_of_iterations;
+	     iteration++ )
+	{
+		result = libewf_chunk_data_check_for_empty_block(
+		          data,
+		          (size_t) chunk_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if data is an empty block.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_statistics_get_timestamp(
+	     &end_timestamp,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	ewf_bench_print_result(
+	 "chunk_data_check_for_empty_block",
+	 corpus_type,
+	 chunk_size,
+	 number_of_iterations,
+	 end_timestamp - start_timestamp );
+
+	/* libewf_chunk_data_pack and libewf_chunk_data_unpack
+	 * The chunk data is recreated every iteration outside the measured time
+	 * since packing is done in place
+	 */
+	for( iteration = 0;
+	     iteration < number_of_iterations;
+	     iteration++ )
+	{
+		if( libewf_chunk_data_initialize(
+		     &chunk_data,
+		     chunk_size,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create chunk data.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     chunk_data->data,
+		     data,
+		     (size_t) chunk_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data to chunk data.",
+			 function );
+
+			goto on_error;
+		}
+		chunk_data->data_size = (size_t) chunk_size;
+
+		if( libewf_statistics_get_timestamp(
+		     &start_timestamp,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		if( libewf_chunk_data_pack(
+		     chunk_data,
+		     io_handle,
+		     compression_context,
+		     NULL,
+		     0,
+		     LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to pack chunk data.",
+			 function );
+
+			goto on_error;
+		}
+		if( libewf_statistics_get_timestamp(
+		     &end_timestamp,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		pack_time += end_timestamp - start_timestamp;
+
+		if( libewf_statistics_get_timestamp(
+		     &start_timestamp,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		if( libewf_chunk_data_unpack(
+		     chunk_data,
+		     io_handle,
+		     compression_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to unpack chunk data.",
+			 function );
+
+			goto on_error;
+		}
+		if( libewf_statistics_get_timestamp(
+		     &end_timestamp,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		unpack_time += end_timestamp - start_timestamp;
+
+		if( libewf_chunk_data_free(
+		     &chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk data.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	ewf_bench_print_result(
+	 "chunk_data_pack",
+	 corpus_type,
+	 chunk_size,
+	 number_of_iterations,
+	 pack_time );
+
+	ewf_bench_print_result(
+	 "chunk_data_unpack",
+	 corpus_type,
+	 chunk_size,
+	 number_of_iterations,
+	 unpack_time );
+
+	memory_free(
+	 uncompressed_data );
+
+	memory_free(
+	 compressed_data );
+
+	return( 1 );
+
+on_error:
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	if( uncompressed_data != NULL )
+	{
+		memory_free(
+		 uncompressed_data );
+	}
+	if( compressed_data != NULL )
+	{
+		memory_free(
+		 compressed_data );
+	}
+	return( -1 );
+}
+
+/* Benchmarks the kernels on all corpora for a specific chunk size
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_kernels_with_chunk_size(
+     uint32_t chunk_size,
+     uint64_t number_of_iterations,
+     libcerror_error_t **error )
+{
+	libewf_compression_context_t *compression_context = NULL;
+	libewf_io_handle_t *io_handle                     = NULL;
+	uint8_t *data                                     = NULL;
+	static char *function                             = "ewf_bench_kernels_with_chunk_size";
+	int corpus_type                                   = 0;
+
+	if( number_of_iterations == 0 )
+	{
+		number_of_iterations = EWF_BENCH_DEFAULT_MEASUREMENT_SIZE / chunk_size;
+
+		if( number_of_iterations == 0 )
+		{
+			number_of_iterations = 1;
+		}
+	}
+	if( libewf_io_handle_initialize(
+	     &io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	io_handle->chunk_size         = chunk_size;
+	io_handle->compression_method = LIBEWF_COMPRESSION_METHOD_DEFLATE;
+	io_handle->compression_level  = LIBEWF_COMPRESSION_DEFAULT;
+
+	if( libewf_compression_context_initialize(
+	     &compression_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create compression context.",
+		 function );
+
+		goto on_error;
+	}
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * chunk_size );
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		goto on_error;
+	}
+	for( corpus_type = 0;
+	     corpus_type < EWF_BENCH_NUMBER_OF_CORPUS_TYPES;
+	     corpus_type++ )
+	{
+		ewf_bench_fill_corpus(
+		 data,
+		 (size_t) chunk_size,
+		 corpus_type );
+
+		if( ewf_bench_kernels(
+		     compression_context,
+		     io_handle,
+		     data,
+		     chunk_size,
+		     corpus_type,
+		     number_of_iterations,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to benchmark kernels on %s corpus.",
+			 function,
+			 ewf_bench_corpus_names[ corpus_type ] );
+
+			goto on_error;
+		}
+	}
+	memory_free(
+	 data );
+
+	if( libewf_compression_context_free(
+	     &compression_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free compression context.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_io_handle_free(
+	     &io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	if( compression_context != NULL )
+	{
+		libewf_compression_context_free(
+		 &compression_context,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* Prints usage information
+ */
+void ewf_bench_usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Usage: ewf_bench_kernels [ -b chunk_size ] [ -i iterations ] [ -h ]\n\n" );
+
+	fprintf( stream, "\t-b: benchmark only the specified chunk size in bytes, by default\n"
+	                 "\t    32768, 65536 and 1048576 are benchmarked\n" );
+	fprintf( stream, "\t-h: shows this help\n" );
+	fprintf( stream, "\t-i: number of iterations per measurement, by default the number of\n"
+	                 "\t    iterations needed to process 32 MiB\n\n" );
+
+	fprintf( stream, "The results are written to stdout as tab separated lines of:\n"
+	                 "kernel, corpus, chunk size, iterations, bytes, nanoseconds and MB/s\n" );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+	libcerror_error_t *error              = NULL;
+	system_character_t *option_chunk_size = NULL;
+	system_character_t *option_iterations = NULL;
+	system_integer_t option               = 0;
+	uint64_t chunk_size                   = 0;
+	uint64_t number_of_iterations         = 0;
+	size_t string_length                  = 0;
+	int chunk_size_index                  = 0;
+
+	while( ( option = ewf_test_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "b:hi:" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM ".\n",
+				 argv[ optind - 1 ] );
+
+				ewf_bench_usage_fprint(
+				 stderr );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'b':
+				option_chunk_size = optarg;
+
+				break;
+
+			case (system_integer_t) 'h':
+				ewf_bench_usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'i':
+				option_iterations = optarg;
+
+				break;
+		}
+	}
+	if( option_chunk_size != NULL )
+	{
+		string_length = system_string_length(
+				 option_chunk_size );
+
+		if( ( ewf_test_system_string_decimal_copy_to_64_bit(
+		       option_chunk_size,
+		       string_length + 1,
+		       &chunk_size,
+		       &error ) != 1 )
+		 || ( chunk_size == 0 )
+		 || ( chunk_size > (uint64_t) INT32_MAX ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported chunk size.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_iterations != NULL )
+	{
+		string_length = system_string_length(
+				 option_iterations );
+
+		if( ewf_test_system_string_decimal_copy_to_64_bit(
+		     option_iterations,
+		     string_length + 1,
+		     &number_of_iterations,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of iterations.\n" );
+
+			goto on_error;
+		}
+	}
+	fprintf(
+	 stdout,
+	 "# kernel\tcorpus\tchunk_size\titerations\tbytes\tnanoseconds\tMB/s\n" );
+
+	for( chunk_size_index = 0;
+	     chunk_size_index < 4;
+	     chunk_size_index++ )
+	{
+		if( chunk_size == 0 )
+		{
+			if( ewf_bench_kernels_with_chunk_size(
+			     ewf_bench_default_chunk_sizes[ chunk_size_index ],
+			     number_of_iterations,
+			     &error ) != 1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to benchmark kernels.\n" );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			if( ewf_bench_kernels_with_chunk_size(
+			     (uint32_t) chunk_size,
+			     number_of_iterations,
+			     &error ) != 1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to benchmark kernels.\n" );
+
+				goto on_error;
+			}
+			break;
+		}
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	return( EXIT_FAILURE );
+
+#else
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	fprintf(
+	 stderr,
+	 "The kernels benchmark requires the internal library functions.\n" );
+
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+}
+
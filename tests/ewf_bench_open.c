@@ -0,0 +1,2625 @@
+/*
+ * Library open time and scaling benchmark program
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+#include <wide_string.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#include <stdio.h>
+#include <time.h>
+
+#include "ewf_test_getopt.h"
+#include "ewf_test_libbfio.h"
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+
+#if !defined( LIBEWF_HAVE_BFIO )
+
+LIBEWF_EXTERN \
+int libewf_handle_open_file_io_pool(
+     libewf_handle_t *handle,
+     libbfio_pool_t *file_io_pool,
+     int access_flags,
+     libewf_error_t **error );
+
+#endif /* !defined( LIBEWF_HAVE_BFIO ) */
+
+/* The number of sectors per chunk of the generated images
+ */
+#define EWF_BENCH_SECTORS_PER_CHUNK		64
+
+/* The chunk size of the generated images
+ */
+#define EWF_BENCH_CHUNK_SIZE			( EWF_BENCH_SECTORS_PER_CHUNK * 512 )
+
+/* The estimated size of the sections, other than the chunk data and tables, of a segment file
+ */
+#define EWF_BENCH_SEGMENT_FILE_OVERHEAD		( 16 * 1024 )
+
+/* The maximum number of segment files that are open at the same time
+ */
+#define EWF_BENCH_MAXIMUM_NUMBER_OF_OPEN_HANDLES	256
+
+/* The maximum number of values in a list option
+ */
+#define EWF_BENCH_MAXIMUM_NUMBER_OF_VALUES	16
+
+/* The default number of runs per configuration
+ */
+#define EWF_BENCH_DEFAULT_NUMBER_OF_RUNS	5
+
+/* The maximum length of the path of a generated image
+ */
+#define EWF_BENCH_MAXIMUM_PATH_LENGTH		1024
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+#define ewf_bench_remove_file( filename ) \
+	_wremove( filename )
+#else
+#define ewf_bench_remove_file( filename ) \
+	remove( filename )
+#endif
+
+enum EWF_BENCH_OPEN_MODES
+{
+	EWF_BENCH_OPEN_MODE_EAGER		= 0,
+	EWF_BENCH_OPEN_MODE_LAZY		= 1,
+	EWF_BENCH_OPEN_MODE_INDEXED		= 2
+};
+
+typedef struct ewf_bench_format ewf_bench_format_t;
+
+struct ewf_bench_format
+{
+	/* The name
+	 */
+	const system_character_t *name;
+
+	/* The EWF format
+	 */
+	uint8_t ewf_format;
+
+	/* The extension of the first segment file
+	 */
+	const system_character_t *extension;
+};
+
+/* The formats that can be benchmarked
+ */
+static const ewf_bench_format_t ewf_bench_formats[ 3 ] = {
+	{ _SYSTEM_STRING( "e01" ), LIBEWF_FORMAT_ENCASE6, _SYSTEM_STRING( ".E01" ) },
+	{ _SYSTEM_STRING( "ex01" ), LIBEWF_FORMAT_V2_ENCASE7, _SYSTEM_STRING( ".Ex01" ) },
+	{ _SYSTEM_STRING( "l01" ), LIBEWF_FORMAT_LOGICAL_ENCASE6, _SYSTEM_STRING( ".L01" ) } };
+
+/* The names of the open modes
+ */
+static const char *ewf_bench_open_mode_names[ 3 ] = {
+	"eager", "lazy", "indexed" };
+
+/* The segment counts used if no segment counts are provided
+ */
+static const uint64_t ewf_bench_default_segment_counts[ 5 ] = {
+	1, 10, 100, 1000, 5000 };
+
+/* The chunk counts used if no chunk counts are provided
+ */
+static const uint64_t ewf_bench_default_chunk_counts[ 1 ] = {
+	10000 };
+
+typedef struct ewf_bench_latency_io_handle ewf_bench_latency_io_handle_t;
+
+/* The latency IO handle wraps a file IO handle and delays every open and read
+ * by the latency, to simulate the round-trip time of network attached storage
+ */
+struct ewf_bench_latency_io_handle
+{
+	/* The file IO handle
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The latency in nano seconds
+	 */
+	int64_t latency;
+};
+
+/* Copies a string of a decimal value to a 64-bit value
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_system_string_decimal_copy_to_64_bit(
+     const system_character_t *string,
+     size_t string_size,
+     uint64_t *value_64bit,
+     libcerror_error_t **error )
+{
+	static char *function              = "ewf_test_system_string_decimal_copy_to_64_bit";
+	size_t string_index                = 0;
+	system_character_t character_value = 0;
+	uint8_t maximum_string_index       = 20;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid string size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value 64-bit.",
+		 function );
+
+		return( -1 );
+	}
+	*value_64bit = 0;
+
+	while( string_index < string_size )
+	{
+		if( string[ string_index ] == 0 )
+		{
+			break;
+		}
+		if( string_index > (size_t) maximum_string_index )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_LARGE,
+			 "%s: string too large.",
+			 function );
+
+			return( -1 );
+		}
+		*value_64bit *= 10;
+
+		if( ( string[ string_index ] >= (system_character_t) '0' )
+		 && ( string[ string_index ] <= (system_character_t) '9' ) )
+		{
+			character_value = (system_character_t) ( string[ string_index ] - (system_character_t) '0' );
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported character value: %" PRIc_SYSTEM " at index: %d.",
+			 function,
+			 string[ string_index ],
+			 string_index );
+
+			return( -1 );
+		}
+		*value_64bit += character_value;
+
+		string_index++;
+	}
+	return( 1 );
+}
+
+/* Copies a comma separated list of decimal values
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_copy_values(
+     const system_character_t *string,
+     uint64_t *values,
+     int maximum_number_of_values,
+     int *number_of_values,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_bench_copy_values";
+	size_t string_index   = 0;
+	size_t value_index    = 0;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid values.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of values.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_values = 0;
+
+	do
+	{
+		if( ( string[ string_index ] == (system_character_t) ',' )
+		 || ( string[ string_index ] == 0 ) )
+		{
+			if( *number_of_values >= maximum_number_of_values )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_LARGE,
+				 "%s: too many values.",
+				 function );
+
+				return( -1 );
+			}
+			if( ( string_index == value_index )
+			 || ( ewf_test_system_string_decimal_copy_to_64_bit(
+			       &( string[ value_index ] ),
+			       string_index - value_index,
+			       &( values[ *number_of_values ] ),
+			       error ) != 1 )
+			 || ( values[ *number_of_values ] == 0 ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+				 "%s: unsupported value: %d.",
+				 function,
+				 *number_of_values );
+
+				return( -1 );
+			}
+			*number_of_values += 1;
+
+			value_index = string_index + 1;
+		}
+	}
+	while( string[ string_index++ ] != 0 );
+
+	return( 1 );
+}
+
+/* Retrieves a monotonic timestamp in nano seconds
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_get_timestamp(
+     int64_t *timestamp,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	struct timespec time_structure;
+#endif
+
+	static char *function = "ewf_bench_get_timestamp";
+
+	if( timestamp == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid timestamp.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_structure ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time structure.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = ( (int64_t) time_structure.tv_sec * 1000000000 ) + time_structure.tv_nsec;
+#else
+	*timestamp = (int64_t) time( NULL );
+
+	if( *timestamp == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp *= 1000000000;
+#endif
+	return( 1 );
+}
+
+/* Sleeps a number of nano seconds
+ */
+void ewf_bench_sleep(
+      int64_t nanoseconds )
+{
+#if defined( WINAPI )
+	Sleep(
+	 (DWORD) ( ( nanoseconds + 999999 ) / 1000000 ) );
+#else
+	struct timespec time_structure;
+
+	time_structure.tv_sec  = (time_t) ( nanoseconds / 1000000000 );
+	time_structure.tv_nsec = (long) ( nanoseconds % 1000000000 );
+
+	while( nanosleep(
+	        &time_structure,
+	        &time_structure ) != 0 )
+	{
+		if( errno != EINTR )
+		{
+			break;
+		}
+	}
+#endif
+}
+
+/* Retrieves the resident memory size of the process
+ * The resident size is 0 if not supported on the platform
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_get_resident_size(
+     size64_t *resident_size,
+     libcerror_error_t **error )
+{
+#if defined( __linux__ ) && defined( HAVE_UNISTD_H )
+	FILE *stream             = NULL;
+	unsigned long long pages = 0;
+	long page_size           = 0;
+#endif
+
+	static char *function    = "ewf_bench_get_resident_size";
+
+	if( resident_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid resident size.",
+		 function );
+
+		return( -1 );
+	}
+	*resident_size = 0;
+
+#if defined( __linux__ ) && defined( HAVE_UNISTD_H )
+	stream = file_stream_open(
+	          "/proc/self/statm",
+	          FILE_STREAM_OPEN_READ );
+
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open statm.",
+		 function );
+
+		return( -1 );
+	}
+	/* The second value is the number of resident pages
+	 */
+	if( fscanf(
+	     stream,
+	     "%*u %llu",
+	     &pages ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read statm.",
+		 function );
+
+		file_stream_close(
+		 stream );
+
+		return( -1 );
+	}
+	file_stream_close(
+	 stream );
+
+	page_size = sysconf(
+	             _SC_PAGESIZE );
+
+	if( page_size > 0 )
+	{
+		*resident_size = (size64_t) pages * (size64_t) page_size;
+	}
+#endif
+	return( 1 );
+}
+
+/* Creates a latency IO handle
+ * The latency IO handle takes over the file IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_latency_io_handle_initialize(
+     ewf_bench_latency_io_handle_t **io_handle,
+     libbfio_handle_t *file_io_handle,
+     int64_t latency,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_bench_latency_io_handle_initialize";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid IO handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	*io_handle = memory_allocate_structure(
+	              ewf_bench_latency_io_handle_t );
+
+	if( *io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	( *io_handle )->file_io_handle = file_io_handle;
+	( *io_handle )->latency        = latency;
+
+	return( 1 );
+}
+
+/* Frees a latency IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_latency_io_handle_free(
+     ewf_bench_latency_io_handle_t **io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_bench_latency_io_handle_free";
+	int result            = 1;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *io_handle != NULL )
+	{
+		if( libbfio_handle_free(
+		     &( ( *io_handle )->file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *io_handle );
+
+		*io_handle = NULL;
+	}
+	return( result );
+}
+
+/* Clones (duplicates) a latency IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_latency_io_handle_clone(
+     ewf_bench_latency_io_handle_t **destination_io_handle,
+     ewf_bench_latency_io_handle_t *source_io_handle,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "ewf_bench_latency_io_handle_clone";
+
+	if( destination_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_io_handle == NULL )
+	{
+		*destination_io_handle = NULL;
+
+		return( 1 );
+	}
+	if( libbfio_handle_clone(
+	     &file_io_handle,
+	     source_io_handle->file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to clone file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ewf_bench_latency_io_handle_initialize(
+	     destination_io_handle,
+	     file_io_handle,
+	     source_io_handle->latency,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination IO handle.",
+		 function );
+
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Opens a latency IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_latency_io_handle_open(
+     ewf_bench_latency_io_handle_t *io_handle,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_bench_latency_io_handle_open";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	ewf_bench_sleep(
+	 io_handle->latency );
+
+	if( libbfio_handle_open(
+	     io_handle->file_io_handle,
+	     access_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Closes a latency IO handle
+ * Returns 0 if successful or -1 on error
+ */
+int ewf_bench_latency_io_handle_close(
+     ewf_bench_latency_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_bench_latency_io_handle_close";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_close(
+	     io_handle->file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 0 );
+}
+
+/* Reads a buffer from a latency IO handle
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t ewf_bench_latency_io_handle_read(
+         ewf_bench_latency_io_handle_t *io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "ewf_bench_latency_io_handle_read";
+	ssize_t read_count    = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	ewf_bench_sleep(
+	 io_handle->latency );
+
+	read_count = libbfio_handle_read_buffer(
+	              io_handle->file_io_handle,
+	              buffer,
+	              size,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read from file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+/* Writes a buffer to a latency IO handle
+ * Returns the number of bytes written if successful, or -1 on error
+ */
+ssize_t ewf_bench_latency_io_handle_write(
+         ewf_bench_latency_io_handle_t *io_handle,
+         const uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "ewf_bench_latency_io_handle_write";
+	ssize_t write_count   = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	ewf_bench_sleep(
+	 io_handle->latency );
+
+	write_count = libbfio_handle_write_buffer(
+	               io_handle->file_io_handle,
+	               buffer,
+	               size,
+	               error );
+
+	if( write_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write to file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( write_count );
+}
+
+/* Seeks a certain offset within a latency IO handle
+ * Seeking is not delayed since it does not require a round-trip
+ * Returns the offset if the seek is successful or -1 on error
+ */
+off64_t ewf_bench_latency_io_handle_seek_offset(
+         ewf_bench_latency_io_handle_t *io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "ewf_bench_latency_io_handle_seek_offset";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	offset = libbfio_handle_seek_offset(
+	          io_handle->file_io_handle,
+	          offset,
+	          whence,
+	          error );
+
+	if( offset == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset in file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( offset );
+}
+
+/* Determines if the file of a latency IO handle exists
+ * Returns 1 if the file exists, 0 if not or -1 on error
+ */
+int ewf_bench_latency_io_handle_exists(
+     ewf_bench_latency_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_bench_latency_io_handle_exists";
+	int result            = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	ewf_bench_sleep(
+	 io_handle->latency );
+
+	result = libbfio_handle_exists(
+	          io_handle->file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to determine if file IO handle exists.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Determines if a latency IO handle is open
+ * Returns 1 if open, 0 if not or -1 on error
+ */
+int ewf_bench_latency_io_handle_is_open(
+     ewf_bench_latency_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_bench_latency_io_handle_is_open";
+	int result            = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = libbfio_handle_is_open(
+	          io_handle->file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to determine if file IO handle is open.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves the size of the file of a latency IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_latency_io_handle_get_size(
+     ewf_bench_latency_io_handle_t *io_handle,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_bench_latency_io_handle_get_size";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_get_size(
+	     io_handle->file_io_handle,
+	     size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve size of file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Creates a file IO handle of a segment file
+ * If the latency is not 0 the file IO handle is wrapped by a latency IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_file_io_handle_initialize(
+     libbfio_handle_t **file_io_handle,
+     const system_character_t *filename,
+     int64_t latency,
+     libcerror_error_t **error )
+{
+	ewf_bench_latency_io_handle_t *io_handle = NULL;
+	libbfio_handle_t *segment_file_io_handle = NULL;
+	static char *function                    = "ewf_bench_file_io_handle_initialize";
+	size_t string_length                     = 0;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_initialize(
+	     &segment_file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	string_length = system_string_length(
+	                 filename );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbfio_file_set_name_wide(
+	     segment_file_io_handle,
+	     filename,
+	     string_length,
+	     error ) != 1 )
+#else
+	if( libbfio_file_set_name(
+	     segment_file_io_handle,
+	     filename,
+	     string_length,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name of segment file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( latency == 0 )
+	{
+		*file_io_handle = segment_file_io_handle;
+
+		return( 1 );
+	}
+	if( ewf_bench_latency_io_handle_initialize(
+	     &io_handle,
+	     segment_file_io_handle,
+	     latency,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create latency IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	segment_file_io_handle = NULL;
+
+	if( libbfio_handle_initialize(
+	     file_io_handle,
+	     (intptr_t *) io_handle,
+	     (int (*)(intptr_t **, libcerror_error_t **)) ewf_bench_latency_io_handle_free,
+	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) ewf_bench_latency_io_handle_clone,
+	     (int (*)(intptr_t *, int, libcerror_error_t **)) ewf_bench_latency_io_handle_open,
+	     (int (*)(intptr_t *, libcerror_error_t **)) ewf_bench_latency_io_handle_close,
+	     (ssize_t (*)(intptr_t *, uint8_t *, size_t, libcerror_error_t **)) ewf_bench_latency_io_handle_read,
+	     (ssize_t (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) ewf_bench_latency_io_handle_write,
+	     (off64_t (*)(intptr_t *, off64_t, int, libcerror_error_t **)) ewf_bench_latency_io_handle_seek_offset,
+	     (int (*)(intptr_t *, libcerror_error_t **)) ewf_bench_latency_io_handle_exists,
+	     (int (*)(intptr_t *, libcerror_error_t **)) ewf_bench_latency_io_handle_is_open,
+	     (int (*)(intptr_t *, size64_t *, libcerror_error_t **)) ewf_bench_latency_io_handle_get_size,
+	     LIBBFIO_FLAG_IO_HANDLE_MANAGED | LIBBFIO_FLAG_IO_HANDLE_CLONE_BY_FUNCTION,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( io_handle != NULL )
+	{
+		ewf_bench_latency_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	if( segment_file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &segment_file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Creates a file IO pool of the segment files
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_file_io_pool_initialize(
+     libbfio_pool_t **file_io_pool,
+     system_character_t * const *filenames,
+     int number_of_filenames,
+     int64_t latency,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "ewf_bench_file_io_pool_initialize";
+	int filename_index               = 0;
+
+	if( libbfio_pool_initialize(
+	     file_io_pool,
+	     number_of_filenames,
+	     EWF_BENCH_MAXIMUM_NUMBER_OF_OPEN_HANDLES,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	for( filename_index = 0;
+	     filename_index < number_of_filenames;
+	     filename_index++ )
+	{
+		if( ewf_bench_file_io_handle_initialize(
+		     &file_io_handle,
+		     filenames[ filename_index ],
+		     latency,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file IO handle: %d.",
+			 function,
+			 filename_index );
+
+			goto on_error;
+		}
+		if( libbfio_pool_set_handle(
+		     *file_io_pool,
+		     filename_index,
+		     file_io_handle,
+		     LIBBFIO_OPEN_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set file IO handle: %d in pool.",
+			 function,
+			 filename_index );
+
+			goto on_error;
+		}
+		file_io_handle = NULL;
+	}
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( *file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 file_io_pool,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes a generated image of uncompressed random data
+ * The maximum segment size is chosen such that the image is split in the number of segments
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_write_image(
+     const system_character_t *basename,
+     const ewf_bench_format_t *format,
+     uint64_t number_of_chunks,
+     uint64_t number_of_segments,
+     libcerror_error_t **error )
+{
+	char ltree_string[ 1024 ];
+
+	system_character_t *filenames[ 1 ] = { NULL };
+	libewf_handle_t *handle            = NULL;
+	uint8_t *buffer                    = NULL;
+	static char *function              = "ewf_bench_write_image";
+	size64_t maximum_segment_size      = 0;
+	size64_t media_size                = 0;
+	size_t buffer_index                = 0;
+	ssize_t write_count                = 0;
+	uint64_t chunk_index               = 0;
+	uint64_t number_of_segment_chunks  = 0;
+	uint64_t random_value              = 0x9e3779b97f4a7c15ULL;
+	int ltree_string_length            = 0;
+
+	if( format == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid format.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_chunks == 0 )
+	 || ( number_of_chunks > (uint64_t) ( INT64_MAX / EWF_BENCH_CHUNK_SIZE ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of chunks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_segments == 0 )
+	 || ( number_of_segments > number_of_chunks ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of segments value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	media_size = number_of_chunks * EWF_BENCH_CHUNK_SIZE;
+
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * EWF_BENCH_CHUNK_SIZE );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_initialize(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+	filenames[ 0 ] = (system_character_t *) basename;
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     handle,
+	     filenames,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     handle,
+	     filenames,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_format(
+	     handle,
+	     format->ewf_format,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set format.",
+		 function );
+
+		goto on_error;
+	}
+	if( format->ewf_format == LIBEWF_FORMAT_LOGICAL_ENCASE6 )
+	{
+		if( libewf_handle_set_media_type(
+		     handle,
+		     LIBEWF_MEDIA_TYPE_SINGLE_FILES,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set media type.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_handle_set_compression_values(
+	     handle,
+	     LIBEWF_COMPRESSION_NONE,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set compression values.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_sectors_per_chunk(
+	     handle,
+	     EWF_BENCH_SECTORS_PER_CHUNK,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set sectors per chunk.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_media_size(
+	     handle,
+	     media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set media size.",
+		 function );
+
+		goto on_error;
+	}
+	/* Every chunk is stored with a checksum and a table entry
+	 */
+	number_of_segment_chunks = ( number_of_chunks + number_of_segments - 1 ) / number_of_segments;
+	maximum_segment_size     = ( number_of_segment_chunks * ( EWF_BENCH_CHUNK_SIZE + 16 ) ) + EWF_BENCH_SEGMENT_FILE_OVERHEAD;
+
+	if( libewf_handle_set_maximum_segment_size(
+	     handle,
+	     maximum_segment_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set maximum segment size.",
+		 function );
+
+		goto on_error;
+	}
+	for( chunk_index = 0;
+	     chunk_index < number_of_chunks;
+	     chunk_index++ )
+	{
+		/* Random data is used so that the chunks are stored uncompressed
+		 */
+		for( buffer_index = 0;
+		     buffer_index < EWF_BENCH_CHUNK_SIZE;
+		     buffer_index += 8 )
+		{
+			random_value ^= random_value << 13;
+			random_value ^= random_value >> 7;
+			random_value ^= random_value << 17;
+
+			byte_stream_copy_from_uint64_little_endian(
+			 &( buffer[ buffer_index ] ),
+			 random_value );
+		}
+		write_count = libewf_handle_write_buffer(
+		               handle,
+		               buffer,
+		               EWF_BENCH_CHUNK_SIZE,
+		               error );
+
+		if( write_count != (ssize_t) EWF_BENCH_CHUNK_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write chunk: %" PRIu64 ".",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+	}
+	if( format->ewf_format == LIBEWF_FORMAT_LOGICAL_ENCASE6 )
+	{
+		/* A single file entry that contains all the data
+		 */
+		ltree_string_length = narrow_string_snprintf(
+		                       ltree_string,
+		                       1024,
+		                       "5\nrec\ntb\n%" PRIu64 "\nentry\n1\n%s\n0\t1\n1%s\n"
+		                       "0\t0\n\tdata\t1\t\t\t\t\t\t\t0\t0\t0\t\t\t\t%" PRIu64 "\t\t\t\t\t\t1 0 %" PRIx64 "\t\t\n",
+		                       (uint64_t) media_size,
+		                       "p\tn\tid\topr\tsrc\tsub\tcid\tjq\tcr\tac\twr\tmo\tdl\taq\tha\tls\tdu\tlo\tpo\tmid\tcfi\tbe\tpm\tlpt",
+		                       "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t",
+		                       (uint64_t) media_size,
+		                       (uint64_t) media_size );
+
+		if( ( ltree_string_length < 0 )
+		 || ( ltree_string_length >= 1024 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set ltree string.",
+			 function );
+
+			goto on_error;
+		}
+		if( libewf_handle_append_utf8_ltree_data(
+		     handle,
+		     (uint8_t *) ltree_string,
+		     (size_t) ltree_string_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append ltree data.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_handle_write_finalize(
+	     handle,
+	     error ) < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to finalize handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 buffer );
+
+	return( 1 );
+
+on_error:
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( -1 );
+}
+
+/* Writes the segment index of an image
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_write_index(
+     system_character_t * const *filenames,
+     int number_of_filenames,
+     const system_character_t *index_filename,
+     libcerror_error_t **error )
+{
+	libewf_handle_t *handle = NULL;
+	static char *function   = "ewf_bench_write_index";
+	int result              = 0;
+
+	if( libewf_handle_initialize(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libewf_handle_open_wide(
+	          handle,
+	          filenames,
+	          number_of_filenames,
+	          LIBEWF_OPEN_READ,
+	          error );
+#else
+	result = libewf_handle_open(
+	          handle,
+	          filenames,
+	          number_of_filenames,
+	          LIBEWF_OPEN_READ,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libewf_handle_write_segment_index_wide(
+	          handle,
+	          index_filename,
+	          error );
+#else
+	result = libewf_handle_write_segment_index(
+	          handle,
+	          index_filename,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write segment index.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Opens an image, reads its first chunk and closes it
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_open_image(
+     system_character_t * const *filenames,
+     int number_of_filenames,
+     const system_character_t *index_filename,
+     int open_mode,
+     int64_t latency,
+     int64_t *open_time,
+     int64_t *first_read_time,
+     int64_t *close_time,
+     size64_t *open_resident_size,
+     libcerror_error_t **error )
+{
+	uint8_t buffer[ EWF_BENCH_CHUNK_SIZE ];
+
+	libbfio_pool_t *file_io_pool = NULL;
+	libewf_handle_t *handle      = NULL;
+	static char *function        = "ewf_bench_open_image";
+	size64_t media_size          = 0;
+	size64_t resident_size       = 0;
+	size64_t start_resident_size = 0;
+	ssize_t read_count           = 0;
+	int64_t start_timestamp      = 0;
+	int64_t timestamp            = 0;
+	int access_flags             = LIBEWF_OPEN_READ;
+	int result                   = 0;
+
+	if( open_time == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid open time.",
+		 function );
+
+		return( -1 );
+	}
+	if( first_read_time == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid first read time.",
+		 function );
+
+		return( -1 );
+	}
+	if( close_time == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid close time.",
+		 function );
+
+		return( -1 );
+	}
+	if( open_resident_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid open resident size.",
+		 function );
+
+		return( -1 );
+	}
+	if( open_mode == EWF_BENCH_OPEN_MODE_LAZY )
+	{
+		access_flags = LIBEWF_OPEN_READ_LAZY;
+	}
+	if( ewf_bench_get_resident_size(
+	     &start_resident_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve resident size.",
+		 function );
+
+		goto on_error;
+	}
+	if( ewf_bench_get_timestamp(
+	     &start_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	/* The open time includes creating the file IO handles of the segment files
+	 */
+	if( ewf_bench_file_io_pool_initialize(
+	     &file_io_pool,
+	     filenames,
+	     number_of_filenames,
+	     latency,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_initialize(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( open_mode == EWF_BENCH_OPEN_MODE_INDEXED )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libewf_handle_open_segment_index_wide(
+		          handle,
+		          index_filename,
+		          error );
+#else
+		result = libewf_handle_open_segment_index(
+		          handle,
+		          index_filename,
+		          error );
+#endif
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open segment index.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_handle_open_file_io_pool(
+	     handle,
+	     file_io_pool,
+	     access_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( ewf_bench_get_timestamp(
+	     &timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	*open_time = timestamp - start_timestamp;
+
+	if( ewf_bench_get_resident_size(
+	     &resident_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve resident size.",
+		 function );
+
+		goto on_error;
+	}
+	if( resident_size > start_resident_size )
+	{
+		*open_resident_size = resident_size - start_resident_size;
+	}
+	else
+	{
+		*open_resident_size = 0;
+	}
+	if( libewf_handle_get_media_size(
+	     handle,
+	     &media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	/* The first read is done in the middle of the media, which in a lazy
+	 * opened image requires the segment file that contains it to be read
+	 */
+	start_timestamp = timestamp;
+
+	read_count = libewf_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              EWF_BENCH_CHUNK_SIZE,
+	              (off64_t) ( ( media_size / 2 ) & ~( (size64_t) EWF_BENCH_CHUNK_SIZE - 1 ) ),
+	              error );
+
+	if( read_count != (ssize_t) EWF_BENCH_CHUNK_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( ewf_bench_get_timestamp(
+	     &timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	*first_read_time = timestamp - start_timestamp;
+
+	start_timestamp = timestamp;
+
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_free(
+	     &file_io_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( ewf_bench_get_timestamp(
+	     &timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	*close_time = timestamp - start_timestamp;
+
+	return( 1 );
+
+on_error:
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Generates an image and benchmarks opening it in every open mode
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_image(
+     const system_character_t *directory,
+     const ewf_bench_format_t *format,
+     uint64_t number_of_chunks,
+     uint64_t number_of_segments,
+     int64_t latency,
+     int number_of_runs,
+     uint8_t keep_image,
+     libcerror_error_t **error )
+{
+	system_character_t basename[ EWF_BENCH_MAXIMUM_PATH_LENGTH ];
+	system_character_t first_filename[ EWF_BENCH_MAXIMUM_PATH_LENGTH ];
+	system_character_t index_filename[ EWF_BENCH_MAXIMUM_PATH_LENGTH ];
+
+	system_character_t **filenames = NULL;
+	static char *function          = "ewf_bench_image";
+	size64_t open_resident_size    = 0;
+	size64_t total_resident_size   = 0;
+	int64_t close_time             = 0;
+	int64_t first_read_time        = 0;
+	int64_t open_time              = 0;
+	int64_t total_close_time       = 0;
+	int64_t total_first_read_time  = 0;
+	int64_t total_open_time        = 0;
+	int filename_index             = 0;
+	int number_of_filenames        = 0;
+	int open_mode                  = 0;
+	int print_count                = 0;
+	int result                     = 0;
+	int run_index                  = 0;
+
+	if( format == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid format.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_runs <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of runs value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	print_count = system_string_sprintf(
+	               basename,
+	               EWF_BENCH_MAXIMUM_PATH_LENGTH,
+	               _SYSTEM_STRING( "%" ) _SYSTEM_STRING( PRIs_SYSTEM )
+	               _SYSTEM_STRING( "/ewf_bench_%" ) _SYSTEM_STRING( PRIs_SYSTEM )
+	               _SYSTEM_STRING( "_%" ) _SYSTEM_STRING( PRIu64 )
+	               _SYSTEM_STRING( "_%" ) _SYSTEM_STRING( PRIu64 ),
+	               directory,
+	               format->name,
+	               number_of_segments,
+	               number_of_chunks );
+
+	if( ( print_count < 0 )
+	 || ( print_count >= ( EWF_BENCH_MAXIMUM_PATH_LENGTH - 8 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set basename.",
+		 function );
+
+		goto on_error;
+	}
+	system_string_sprintf(
+	 first_filename,
+	 EWF_BENCH_MAXIMUM_PATH_LENGTH,
+	 _SYSTEM_STRING( "%" ) _SYSTEM_STRING( PRIs_SYSTEM )
+	 _SYSTEM_STRING( "%" ) _SYSTEM_STRING( PRIs_SYSTEM ),
+	 basename,
+	 format->extension );
+
+	system_string_sprintf(
+	 index_filename,
+	 EWF_BENCH_MAXIMUM_PATH_LENGTH,
+	 _SYSTEM_STRING( "%" ) _SYSTEM_STRING( PRIs_SYSTEM )
+	 _SYSTEM_STRING( ".idx" ),
+	 basename );
+
+	if( ewf_bench_write_image(
+	     basename,
+	     format,
+	     number_of_chunks,
+	     number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write image.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libewf_glob_wide(
+	          first_filename,
+	          system_string_length(
+	           first_filename ),
+	          format->ewf_format,
+	          &filenames,
+	          &number_of_filenames,
+	          error );
+#else
+	result = libewf_glob(
+	          first_filename,
+	          system_string_length(
+	           first_filename ),
+	          format->ewf_format,
+	          &filenames,
+	          &number_of_filenames,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to resolve segment files.",
+		 function );
+
+		goto on_error;
+	}
+	if( ewf_bench_write_index(
+	     filenames,
+	     number_of_filenames,
+	     index_filename,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write segment index.",
+		 function );
+
+		goto on_error;
+	}
+	for( open_mode = EWF_BENCH_OPEN_MODE_EAGER;
+	     open_mode <= EWF_BENCH_OPEN_MODE_INDEXED;
+	     open_mode++ )
+	{
+		total_close_time      = 0;
+		total_first_read_time = 0;
+		total_open_time       = 0;
+		total_resident_size   = 0;
+
+		for( run_index = 0;
+		     run_index < number_of_runs;
+		     run_index++ )
+		{
+			if( ewf_bench_open_image(
+			     filenames,
+			     number_of_filenames,
+			     index_filename,
+			     open_mode,
+			     latency,
+			     &open_time,
+			     &first_read_time,
+			     &close_time,
+			     &open_resident_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to benchmark open mode: %s run: %d.",
+				 function,
+				 ewf_bench_open_mode_names[ open_mode ],
+				 run_index );
+
+				goto on_error;
+			}
+			total_close_time      += close_time;
+			total_first_read_time += first_read_time;
+			total_open_time       += open_time;
+			total_resident_size   += open_resident_size;
+		}
+		fprintf(
+		 stdout,
+		 "%" PRIs_SYSTEM "\t%d\t%" PRIu64 "\t%s\t%" PRIi64 "\t%d\t%" PRIi64 "\t%" PRIi64 "\t%" PRIi64 "\t%" PRIu64 "\n",
+		 format->name,
+		 number_of_filenames,
+		 number_of_chunks,
+		 ewf_bench_open_mode_names[ open_mode ],
+		 latency / 1000,
+		 number_of_runs,
+		 total_open_time / number_of_runs,
+		 total_first_read_time / number_of_runs,
+		 total_close_time / number_of_runs,
+		 total_resident_size / number_of_runs / 1024 );
+
+		fflush(
+		 stdout );
+	}
+	if( keep_image == 0 )
+	{
+		for( filename_index = 0;
+		     filename_index < number_of_filenames;
+		     filename_index++ )
+		{
+			ewf_bench_remove_file(
+			 filenames[ filename_index ] );
+		}
+		ewf_bench_remove_file(
+		 index_filename );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libewf_glob_wide_free(
+	          filenames,
+	          number_of_filenames,
+	          error );
+#else
+	result = libewf_glob_free(
+	          filenames,
+	          number_of_filenames,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free glob.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	if( filenames != NULL )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		libewf_glob_wide_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#else
+		libewf_glob_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#endif
+	}
+	return( -1 );
+}
+
+/* Prints usage information
+ */
+void ewf_bench_usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Usage: ewf_bench_open [ -c chunk_counts ] [ -d directory ] [ -f formats ]\n"
+	                 "                      [ -l latency ] [ -n number_of_runs ]\n"
+	                 "                      [ -s segment_counts ] [ -hk ]\n\n" );
+
+	fprintf( stream, "\t-c: comma separated numbers of chunks of 32 KiB of the generated\n"
+	                 "\t    images, default is 10000\n" );
+	fprintf( stream, "\t-d: directory in which the images are generated, default is the\n"
+	                 "\t    current directory\n" );
+	fprintf( stream, "\t-f: comma separated formats of the generated images, options: e01,\n"
+	                 "\t    ex01, l01, by default all formats are benchmarked\n" );
+	fprintf( stream, "\t-h: shows this help\n" );
+	fprintf( stream, "\t-k: keep the generated images\n" );
+	fprintf( stream, "\t-l: latency in micro seconds that is added to every open and read\n"
+	                 "\t    of a segment file, to simulate network attached storage,\n"
+	                 "\t    default is 0\n" );
+	fprintf( stream, "\t-n: number of runs per configuration, default is %d\n",
+	 EWF_BENCH_DEFAULT_NUMBER_OF_RUNS );
+	fprintf( stream, "\t-s: comma separated numbers of segment files of the generated images,\n"
+	                 "\t    default is 1,10,100,1000,5000\n\n" );
+
+	fprintf( stream, "The results are written to stdout as tab separated lines of: format,\n"
+	                 "number of segment files, number of chunks, open mode (eager, lazy or\n"
+	                 "indexed), latency (us), runs, and the mean open, first read and close\n"
+	                 "time (ns) and resident memory size added by the open (KiB)\n" );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	uint64_t chunk_counts[ EWF_BENCH_MAXIMUM_NUMBER_OF_VALUES ];
+	uint64_t segment_counts[ EWF_BENCH_MAXIMUM_NUMBER_OF_VALUES ];
+	const ewf_bench_format_t *formats[ 3 ];
+
+	libcerror_error_t *error                = NULL;
+	const system_character_t *directory     = _SYSTEM_STRING( "." );
+	system_character_t *option_chunk_counts = NULL;
+	system_character_t *option_formats      = NULL;
+	system_character_t *option_latency      = NULL;
+	system_character_t *option_runs         = NULL;
+	system_character_t *option_segments     = NULL;
+	system_integer_t option                 = 0;
+	size_t name_length                      = 0;
+	size_t string_index                     = 0;
+	size_t string_length                    = 0;
+	uint64_t latency                        = 0;
+	uint64_t value_64bit                    = 0;
+	uint8_t keep_image                      = 0;
+	int chunk_count_index                   = 0;
+	int format_index                        = 0;
+	int number_of_chunk_counts              = 0;
+	int number_of_formats                   = 0;
+	int number_of_runs                      = EWF_BENCH_DEFAULT_NUMBER_OF_RUNS;
+	int number_of_segment_counts            = 0;
+	int segment_count_index                 = 0;
+
+	while( ( option = ewf_test_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "c:d:f:hkl:n:s:" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM ".\n",
+				 argv[ optind - 1 ] );
+
+				ewf_bench_usage_fprint(
+				 stderr );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'c':
+				option_chunk_counts = optarg;
+
+				break;
+
+			case (system_integer_t) 'd':
+				directory = optarg;
+
+				break;
+
+			case (system_integer_t) 'f':
+				option_formats = optarg;
+
+				break;
+
+			case (system_integer_t) 'h':
+				ewf_bench_usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'k':
+				keep_image = 1;
+
+				break;
+
+			case (system_integer_t) 'l':
+				option_latency = optarg;
+
+				break;
+
+			case (system_integer_t) 'n':
+				option_runs = optarg;
+
+				break;
+
+			case (system_integer_t) 's':
+				option_segments = optarg;
+
+				break;
+		}
+	}
+	if( option_chunk_counts != NULL )
+	{
+		if( ewf_bench_copy_values(
+		     option_chunk_counts,
+		     chunk_counts,
+		     EWF_BENCH_MAXIMUM_NUMBER_OF_VALUES,
+		     &number_of_chunk_counts,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported chunk counts.\n" );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		chunk_counts[ 0 ]      = ewf_bench_default_chunk_counts[ 0 ];
+		number_of_chunk_counts = 1;
+	}
+	if( option_segments != NULL )
+	{
+		if( ewf_bench_copy_values(
+		     option_segments,
+		     segment_counts,
+		     EWF_BENCH_MAXIMUM_NUMBER_OF_VALUES,
+		     &number_of_segment_counts,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported segment counts.\n" );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		for( segment_count_index = 0;
+		     segment_count_index < 5;
+		     segment_count_index++ )
+		{
+			segment_counts[ segment_count_index ] = ewf_bench_default_segment_counts[ segment_count_index ];
+		}
+		number_of_segment_counts = 5;
+	}
+	if( option_formats != NULL )
+	{
+		string_length = system_string_length(
+		                 option_formats );
+
+		while( string_index < string_length )
+		{
+			name_length = 0;
+
+			while( ( string_index + name_length < string_length )
+			    && ( option_formats[ string_index + name_length ] != (system_character_t) ',' ) )
+			{
+				name_length++;
+			}
+			for( format_index = 0;
+			     format_index < 3;
+			     format_index++ )
+			{
+				if( ( name_length == system_string_length( ewf_bench_formats[ format_index ].name ) )
+				 && ( system_string_compare_no_case(
+				       &( option_formats[ string_index ] ),
+				       ewf_bench_formats[ format_index ].name,
+				       name_length ) == 0 ) )
+				{
+					break;
+				}
+			}
+			if( ( format_index >= 3 )
+			 || ( number_of_formats >= 3 ) )
+			{
+				fprintf(
+				 stderr,
+				 "Unsupported formats.\n" );
+
+				goto on_error;
+			}
+			formats[ number_of_formats++ ] = &( ewf_bench_formats[ format_index ] );
+
+			string_index += name_length + 1;
+		}
+	}
+	else
+	{
+		for( format_index = 0;
+		     format_index < 3;
+		     format_index++ )
+		{
+			formats[ format_index ] = &( ewf_bench_formats[ format_index ] );
+		}
+		number_of_formats = 3;
+	}
+	if( option_latency != NULL )
+	{
+		string_length = system_string_length(
+		                 option_latency );
+
+		if( ( ewf_test_system_string_decimal_copy_to_64_bit(
+		       option_latency,
+		       string_length + 1,
+		       &latency,
+		       &error ) != 1 )
+		 || ( latency > (uint64_t) ( 60 * 1000 * 1000 ) ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported latency.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_runs != NULL )
+	{
+		string_length = system_string_length(
+		                 option_runs );
+
+		if( ( ewf_test_system_string_decimal_copy_to_64_bit(
+		       option_runs,
+		       string_length + 1,
+		       &value_64bit,
+		       &error ) != 1 )
+		 || ( value_64bit == 0 )
+		 || ( value_64bit > (uint64_t) 1000 ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of runs.\n" );
+
+			goto on_error;
+		}
+		number_of_runs = (int) value_64bit;
+	}
+	fprintf(
+	 stdout,
+	 "# format\tsegments\tchunks\tmode\tlatency_us\truns\topen_ns\tfirst_read_ns\tclose_ns\topen_resident_kib\n" );
+
+	for( format_index = 0;
+	     format_index < number_of_formats;
+	     format_index++ )
+	{
+		for( chunk_count_index = 0;
+		     chunk_count_index < number_of_chunk_counts;
+		     chunk_count_index++ )
+		{
+			for( segment_count_index = 0;
+			     segment_count_index < number_of_segment_counts;
+			     segment_count_index++ )
+			{
+				/* Every segment file contains at least one chunk
+				 */
+				if( segment_counts[ segment_count_index ] > chunk_counts[ chunk_count_index ] )
+				{
+					continue;
+				}
+				if( ewf_bench_image(
+				     directory,
+				     formats[ format_index ],
+				     chunk_counts[ chunk_count_index ],
+				     segment_counts[ segment_count_index ],
+				     (int64_t) latency * 1000,
+				     number_of_runs,
+				     keep_image,
+				     &error ) != 1 )
+				{
+					fprintf(
+					 stderr,
+					 "Unable to benchmark image.\n" );
+
+					goto on_error;
+				}
+			}
+		}
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	return( EXIT_FAILURE );
+}
+
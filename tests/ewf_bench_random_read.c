@@ -0,0 +1,1300 @@
+/*
+ * Library random access read latency benchmark program
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <stdio.h>
+#include <time.h>
+
+#include "ewf_test_getopt.h"
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+
+/* The default number of synthetic reads
+ */
+#define EWF_BENCH_DEFAULT_NUMBER_OF_READS	100000
+
+/* The maximum number of distinct 4096 byte blocks the synthetic reads are drawn from
+ */
+#define EWF_BENCH_MAXIMUM_NUMBER_OF_HOT_BLOCKS	( 1024 * 1024 )
+
+/* The maximum size of a single read in a trace
+ */
+#define EWF_BENCH_MAXIMUM_READ_SIZE		( 16 * 1024 * 1024 )
+
+typedef struct ewf_bench_read ewf_bench_read_t;
+
+struct ewf_bench_read
+{
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The size
+	 */
+	size_t size;
+};
+
+/* The read sizes of the synthetic reads, which resemble MFT records,
+ * file system blocks, database pages and registry hive bins
+ */
+static const size_t ewf_bench_synthetic_read_sizes[ 8 ] = {
+	1024, 1024, 4096, 4096, 4096, 16384, 65536, 262144 };
+
+/* The cache sizes in MiB used if no cache size is provided
+ */
+static const uint64_t ewf_bench_default_cache_sizes[ 4 ] = {
+	1, 16, 64, 256 };
+
+/* Copies a string of a decimal value to a 64-bit value
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_system_string_decimal_copy_to_64_bit(
+     const system_character_t *string,
+     size_t string_size,
+     uint64_t *value_64bit,
+     libcerror_error_t **error )
+{
+	static char *function              = "ewf_test_system_string_decimal_copy_to_64_bit";
+	size_t string_index                = 0;
+	system_character_t character_value = 0;
+	uint8_t maximum_string_index       = 20;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid string size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value 64-bit.",
+		 function );
+
+		return( -1 );
+	}
+	*value_64bit = 0;
+
+	while( string_index < string_size )
+	{
+		if( string[ string_index ] == 0 )
+		{
+			break;
+		}
+		if( string_index > (size_t) maximum_string_index )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_LARGE,
+			 "%s: string too large.",
+			 function );
+
+			return( -1 );
+		}
+		*value_64bit *= 10;
+
+		if( ( string[ string_index ] >= (system_character_t) '0' )
+		 && ( string[ string_index ] <= (system_character_t) '9' ) )
+		{
+			character_value = (system_character_t) ( string[ string_index ] - (system_character_t) '0' );
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported character value: %" PRIc_SYSTEM " at index: %d.",
+			 function,
+			 string[ string_index ],
+			 string_index );
+
+			return( -1 );
+		}
+		*value_64bit += character_value;
+
+		string_index++;
+	}
+	return( 1 );
+}
+
+/* Retrieves a monotonic timestamp in nano seconds
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_get_timestamp(
+     int64_t *timestamp,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	struct timespec time_structure;
+#endif
+
+	static char *function = "ewf_bench_get_timestamp";
+
+	if( timestamp == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid timestamp.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_structure ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time structure.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = ( (int64_t) time_structure.tv_sec * 1000000000 ) + time_structure.tv_nsec;
+#else
+	*timestamp = (int64_t) time( NULL );
+
+	if( *timestamp == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp *= 1000000000;
+#endif
+	return( 1 );
+}
+
+/* Retrieves the next value of a xorshift pseudo random number generator
+ */
+uint64_t ewf_bench_get_random_value(
+          uint64_t *random_state )
+{
+	uint64_t value = *random_state;
+
+	value ^= value << 13;
+	value ^= value >> 7;
+	value ^= value << 17;
+
+	*random_state = value;
+
+	return( value );
+}
+
+/* Copies a decimal or 0x prefixed hexadecimal value in a trace line to a 64-bit value
+ * Returns 1 if successful or 0 if no value was found
+ */
+int ewf_bench_trace_line_copy_to_64_bit(
+     const char *line,
+     size_t *line_index,
+     uint64_t *value_64bit )
+{
+	size_t safe_line_index = *line_index;
+	uint8_t base           = 10;
+	uint8_t digit          = 0;
+	int number_of_digits   = 0;
+
+	*value_64bit = 0;
+
+	while( ( line[ safe_line_index ] == ' ' )
+	    || ( line[ safe_line_index ] == '\t' )
+	    || ( line[ safe_line_index ] == ',' ) )
+	{
+		safe_line_index++;
+	}
+	if( ( line[ safe_line_index ] == '0' )
+	 && ( ( line[ safe_line_index + 1 ] == 'x' )
+	  || ( line[ safe_line_index + 1 ] == 'X' ) ) )
+	{
+		base             = 16;
+		safe_line_index += 2;
+	}
+	while( line[ safe_line_index ] != 0 )
+	{
+		if( ( line[ safe_line_index ] >= '0' )
+		 && ( line[ safe_line_index ] <= '9' ) )
+		{
+			digit = (uint8_t) ( line[ safe_line_index ] - '0' );
+		}
+		else if( ( base == 16 )
+		      && ( line[ safe_line_index ] >= 'a' )
+		      && ( line[ safe_line_index ] <= 'f' ) )
+		{
+			digit = (uint8_t) ( line[ safe_line_index ] - 'a' + 10 );
+		}
+		else if( ( base == 16 )
+		      && ( line[ safe_line_index ] >= 'A' )
+		      && ( line[ safe_line_index ] <= 'F' ) )
+		{
+			digit = (uint8_t) ( line[ safe_line_index ] - 'A' + 10 );
+		}
+		else
+		{
+			break;
+		}
+		*value_64bit = ( *value_64bit * base ) + digit;
+
+		number_of_digits++;
+		safe_line_index++;
+	}
+	*line_index = safe_line_index;
+
+	if( number_of_digits == 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Reads the reads from a trace file
+ * Every line of the trace contains the offset and size of a read separated by
+ * white space or a comma, empty lines and lines starting with # are ignored
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_read_trace(
+     const system_character_t *filename,
+     ewf_bench_read_t **reads,
+     int *number_of_reads,
+     libcerror_error_t **error )
+{
+	char line[ 256 ];
+
+	ewf_bench_read_t *reallocated_reads = NULL;
+	FILE *stream                        = NULL;
+	static char *function               = "ewf_bench_read_trace";
+	size_t line_index                   = 0;
+	uint64_t offset                     = 0;
+	uint64_t size                       = 0;
+	int line_number                     = 0;
+	int maximum_number_of_reads         = 0;
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	stream = file_stream_open_wide(
+	          filename,
+	          L"r" );
+#else
+	stream = file_stream_open(
+	          filename,
+	          "r" );
+#endif
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open trace file.",
+		 function );
+
+		goto on_error;
+	}
+	while( file_stream_get_string(
+	        stream,
+	        line,
+	        256 ) != NULL )
+	{
+		line_number++;
+
+		line_index = 0;
+
+		if( ( line[ 0 ] == '#' )
+		 || ( ewf_bench_trace_line_copy_to_64_bit(
+		       line,
+		       &line_index,
+		       &offset ) == 0 ) )
+		{
+			continue;
+		}
+		if( ( ewf_bench_trace_line_copy_to_64_bit(
+		       line,
+		       &line_index,
+		       &size ) == 0 )
+		 || ( offset > (uint64_t) INT64_MAX )
+		 || ( size == 0 )
+		 || ( size > (uint64_t) EWF_BENCH_MAXIMUM_READ_SIZE ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported read at line: %d.",
+			 function,
+			 line_number );
+
+			goto on_error;
+		}
+		if( *number_of_reads >= maximum_number_of_reads )
+		{
+			if( maximum_number_of_reads >= ( INT_MAX / 2 ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: too many reads in trace.",
+				 function );
+
+				goto on_error;
+			}
+			maximum_number_of_reads = ( maximum_number_of_reads == 0 ) ? 4096 : maximum_number_of_reads * 2;
+
+			reallocated_reads = (ewf_bench_read_t *) memory_reallocate(
+			                                          *reads,
+			                                          sizeof( ewf_bench_read_t ) * maximum_number_of_reads );
+
+			if( reallocated_reads == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize reads.",
+				 function );
+
+				goto on_error;
+			}
+			*reads = reallocated_reads;
+		}
+		( *reads )[ *number_of_reads ].offset = (off64_t) offset;
+		( *reads )[ *number_of_reads ].size   = (size_t) size;
+
+		*number_of_reads += 1;
+	}
+	file_stream_close(
+	 stream );
+
+	return( 1 );
+
+on_error:
+	if( stream != NULL )
+	{
+		file_stream_close(
+		 stream );
+	}
+	return( -1 );
+}
+
+/* Generates synthetic reads of which the 4096 byte blocks follow a Zipfian (s=1)
+ * distribution, where the most popular blocks are spread over the media
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_generate_reads(
+     size64_t media_size,
+     int number_of_reads,
+     ewf_bench_read_t **reads,
+     libcerror_error_t **error )
+{
+	double *cumulative_weights      = NULL;
+	static char *function           = "ewf_bench_generate_reads";
+	double random_value             = 0.0;
+	double sum_of_weights           = 0.0;
+	uint64_t block_index            = 0;
+	uint64_t number_of_blocks       = 0;
+	uint64_t number_of_hot_blocks   = 0;
+	uint64_t random_state           = 0x9e3779b97f4a7c15ULL;
+	uint64_t rank                   = 0;
+	uint64_t rank_end               = 0;
+	uint64_t rank_start             = 0;
+	size_t read_size                = 0;
+	int read_index                  = 0;
+
+	number_of_blocks = media_size / 4096;
+
+	if( number_of_blocks == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: media size too small.",
+		 function );
+
+		goto on_error;
+	}
+	number_of_hot_blocks = number_of_blocks;
+
+	if( number_of_hot_blocks > EWF_BENCH_MAXIMUM_NUMBER_OF_HOT_BLOCKS )
+	{
+		number_of_hot_blocks = EWF_BENCH_MAXIMUM_NUMBER_OF_HOT_BLOCKS;
+	}
+	cumulative_weights = (double *) memory_allocate(
+	                                 sizeof( double ) * (size_t) number_of_hot_blocks );
+
+	if( cumulative_weights == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create cumulative weights.",
+		 function );
+
+		goto on_error;
+	}
+	for( rank = 0;
+	     rank < number_of_hot_blocks;
+	     rank++ )
+	{
+		sum_of_weights          += 1.0 / (double) ( rank + 1 );
+		cumulative_weights[ rank ] = sum_of_weights;
+	}
+	*reads = (ewf_bench_read_t *) memory_allocate(
+	                               sizeof( ewf_bench_read_t ) * number_of_reads );
+
+	if( *reads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create reads.",
+		 function );
+
+		goto on_error;
+	}
+	for( read_index = 0;
+	     read_index < number_of_reads;
+	     read_index++ )
+	{
+		random_value = ( (double) ( ewf_bench_get_random_value( &random_state ) >> 11 ) / 9007199254740992.0 ) * sum_of_weights;
+
+		rank_start = 0;
+		rank_end   = number_of_hot_blocks - 1;
+
+		while( rank_start < rank_end )
+		{
+			rank = rank_start + ( ( rank_end - rank_start ) / 2 );
+
+			if( cumulative_weights[ rank ] < random_value )
+			{
+				rank_start = rank + 1;
+			}
+			else
+			{
+				rank_end = rank;
+			}
+		}
+		/* Spread the popular blocks over the media like file system metadata
+		 */
+		block_index = ( ( rank_start * 0x9e3779b97f4a7c15ULL ) >> 16 ) % number_of_blocks;
+
+		read_size = ewf_bench_synthetic_read_sizes[ ewf_bench_get_random_value( &random_state ) % 8 ];
+
+		( *reads )[ read_index ].offset = (off64_t) ( block_index * 4096 );
+		( *reads )[ read_index ].size   = read_size;
+	}
+	memory_free(
+	 cumulative_weights );
+
+	return( 1 );
+
+on_error:
+	if( *reads != NULL )
+	{
+		memory_free(
+		 *reads );
+
+		*reads = NULL;
+	}
+	if( cumulative_weights != NULL )
+	{
+		memory_free(
+		 cumulative_weights );
+	}
+	return( -1 );
+}
+
+/* Compares two latencies
+ * Returns -1 if first is smaller than second, 0 if equal or 1 if greater
+ */
+int ewf_bench_compare_latencies(
+     const void *first_latency,
+     const void *second_latency )
+{
+	int64_t first_value  = *( (const int64_t *) first_latency );
+	int64_t second_value = *( (const int64_t *) second_latency );
+
+	if( first_value < second_value )
+	{
+		return( -1 );
+	}
+	else if( first_value > second_value )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Replays the reads against the image with a specific chunks cache size
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_replay_reads(
+     system_character_t * const *filenames,
+     int number_of_filenames,
+     const ewf_bench_read_t *reads,
+     int number_of_reads,
+     uint64_t cache_size,
+     int number_of_read_ahead_chunks,
+     libcerror_error_t **error )
+{
+	libewf_handle_t *handle          = NULL;
+	int64_t *latencies               = NULL;
+	uint8_t *buffer                  = NULL;
+	static char *function            = "ewf_bench_replay_reads";
+	size_t maximum_read_size         = 0;
+	ssize_t read_count               = 0;
+	uint64_t number_of_cache_hits    = 0;
+	uint64_t number_of_cache_misses  = 0;
+	uint64_t read_size               = 0;
+	int64_t end_timestamp            = 0;
+	int64_t start_timestamp          = 0;
+	int64_t total_latency            = 0;
+	double hit_rate                  = 0.0;
+	int read_index                   = 0;
+
+	for( read_index = 0;
+	     read_index < number_of_reads;
+	     read_index++ )
+	{
+		if( reads[ read_index ].size > maximum_read_size )
+		{
+			maximum_read_size = reads[ read_index ].size;
+		}
+	}
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * maximum_read_size );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	latencies = (int64_t *) memory_allocate(
+	                         sizeof( int64_t ) * number_of_reads );
+
+	if( latencies == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create latencies.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_initialize(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+	/* The cache size is applied when the handle is opened
+	 */
+	if( libewf_handle_set_maximum_cache_size(
+	     handle,
+	     (size64_t) cache_size * 1024 * 1024,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set maximum cache size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_number_of_read_ahead_chunks(
+	     handle,
+	     number_of_read_ahead_chunks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set number of read ahead chunks.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	for( read_index = 0;
+	     read_index < number_of_reads;
+	     read_index++ )
+	{
+		if( ewf_bench_get_timestamp(
+		     &start_timestamp,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              reads[ read_index ].size,
+		              reads[ read_index ].offset,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer at offset: %" PRIi64 ".",
+			 function,
+			 reads[ read_index ].offset );
+
+			goto on_error;
+		}
+		if( ewf_bench_get_timestamp(
+		     &end_timestamp,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		latencies[ read_index ] = end_timestamp - start_timestamp;
+
+		total_latency += latencies[ read_index ];
+		read_size     += (uint64_t) read_count;
+	}
+	if( libewf_handle_get_chunks_cache_statistics(
+	     handle,
+	     &number_of_cache_hits,
+	     &number_of_cache_misses,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunks cache statistics.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+	qsort(
+	 latencies,
+	 (size_t) number_of_reads,
+	 sizeof( int64_t ),
+	 &ewf_bench_compare_latencies );
+
+	if( ( number_of_cache_hits + number_of_cache_misses ) > 0 )
+	{
+		hit_rate = (double) number_of_cache_hits / (double) ( number_of_cache_hits + number_of_cache_misses );
+	}
+	fprintf(
+	 stdout,
+	 "%" PRIu64 "\t%d\t%" PRIu64 "\t%" PRIi64 "\t%" PRIi64 "\t%" PRIi64 "\t%" PRIi64 "\t%" PRIi64 "\t%" PRIu64 "\t%" PRIu64 "\t%.4f\n",
+	 cache_size,
+	 number_of_reads,
+	 read_size,
+	 latencies[ number_of_reads / 2 ],
+	 latencies[ (int) ( (int64_t) number_of_reads * 99 / 100 ) ],
+	 latencies[ (int) ( (int64_t) number_of_reads * 999 / 1000 ) ],
+	 latencies[ number_of_reads - 1 ],
+	 total_latency / number_of_reads,
+	 number_of_cache_hits,
+	 number_of_cache_misses,
+	 hit_rate );
+
+	memory_free(
+	 latencies );
+
+	memory_free(
+	 buffer );
+
+	return( 1 );
+
+on_error:
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( latencies != NULL )
+	{
+		memory_free(
+		 latencies );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( -1 );
+}
+
+/* Retrieves the media size of the image
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_get_media_size(
+     system_character_t * const *filenames,
+     int number_of_filenames,
+     size64_t *media_size,
+     libcerror_error_t **error )
+{
+	libewf_handle_t *handle = NULL;
+	static char *function   = "ewf_bench_get_media_size";
+
+	if( libewf_handle_initialize(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_media_size(
+	     handle,
+	     media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Prints usage information
+ */
+void ewf_bench_usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Usage: ewf_bench_random_read [ -c cache_size ] [ -n number_of_reads ]\n"
+	                 "                             [ -r read_ahead_chunks ] [ -t trace_file ]\n"
+	                 "                             [ -h ] ewf_files\n\n" );
+
+	fprintf( stream, "\tewf_files: the first or the entire set of EWF segment files\n\n" );
+
+	fprintf( stream, "\t-c: benchmark only the specified chunks cache size in MiB, by\n"
+	                 "\t    default 1, 16, 64 and 256 MiB are benchmarked\n" );
+	fprintf( stream, "\t-h: shows this help\n" );
+	fprintf( stream, "\t-n: number of synthetic (Zipfian) reads, default is %d\n",
+	 EWF_BENCH_DEFAULT_NUMBER_OF_READS );
+	fprintf( stream, "\t-r: number of chunks to read ahead, default is 0\n" );
+	fprintf( stream, "\t-t: replay the reads in the trace file instead of synthetic reads,\n"
+	                 "\t    where every line contains the offset and size of a read\n\n" );
+
+	fprintf( stream, "The results are written to stdout as tab separated lines of: cache size\n"
+	                 "(MiB), reads, bytes, p50, p99, p99.9, maximum and mean latency (ns),\n"
+	                 "chunks cache hits, misses and hit rate\n" );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	ewf_bench_read_t *reads                       = NULL;
+	libcerror_error_t *error                      = NULL;
+	system_character_t **filenames                = NULL;
+	system_character_t *option_cache_size         = NULL;
+	system_character_t *option_number_of_reads    = NULL;
+	system_character_t *option_read_ahead_chunks  = NULL;
+	system_character_t *option_trace_filename     = NULL;
+	system_integer_t option                       = 0;
+	size64_t media_size                           = 0;
+	size_t string_length                          = 0;
+	uint64_t cache_size                           = 0;
+	uint64_t value_64bit                          = 0;
+	int cache_size_index                          = 0;
+	int number_of_filenames                       = 0;
+	int number_of_read_ahead_chunks               = 0;
+	int number_of_reads                           = 0;
+	int result                                    = 0;
+
+	while( ( option = ewf_test_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "c:hn:r:t:" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM ".\n",
+				 argv[ optind - 1 ] );
+
+				ewf_bench_usage_fprint(
+				 stderr );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'c':
+				option_cache_size = optarg;
+
+				break;
+
+			case (system_integer_t) 'h':
+				ewf_bench_usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'n':
+				option_number_of_reads = optarg;
+
+				break;
+
+			case (system_integer_t) 'r':
+				option_read_ahead_chunks = optarg;
+
+				break;
+
+			case (system_integer_t) 't':
+				option_trace_filename = optarg;
+
+				break;
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing EWF image filename.\n" );
+
+		ewf_bench_usage_fprint(
+		 stderr );
+
+		return( EXIT_FAILURE );
+	}
+	if( option_cache_size != NULL )
+	{
+		string_length = system_string_length(
+				 option_cache_size );
+
+		if( ( ewf_test_system_string_decimal_copy_to_64_bit(
+		       option_cache_size,
+		       string_length + 1,
+		       &cache_size,
+		       &error ) != 1 )
+		 || ( cache_size == 0 )
+		 || ( cache_size > (uint64_t) ( 1024 * 1024 ) ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported cache size.\n" );
+
+			goto on_error;
+		}
+	}
+	number_of_reads = EWF_BENCH_DEFAULT_NUMBER_OF_READS;
+
+	if( option_number_of_reads != NULL )
+	{
+		string_length = system_string_length(
+				 option_number_of_reads );
+
+		if( ( ewf_test_system_string_decimal_copy_to_64_bit(
+		       option_number_of_reads,
+		       string_length + 1,
+		       &value_64bit,
+		       &error ) != 1 )
+		 || ( value_64bit == 0 )
+		 || ( value_64bit > (uint64_t) ( INT_MAX / sizeof( int64_t ) ) ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of reads.\n" );
+
+			goto on_error;
+		}
+		number_of_reads = (int) value_64bit;
+	}
+	if( option_read_ahead_chunks != NULL )
+	{
+		string_length = system_string_length(
+				 option_read_ahead_chunks );
+
+		if( ( ewf_test_system_string_decimal_copy_to_64_bit(
+		       option_read_ahead_chunks,
+		       string_length + 1,
+		       &value_64bit,
+		       &error ) != 1 )
+		 || ( value_64bit > (uint64_t) INT_MAX ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of read ahead chunks.\n" );
+
+			goto on_error;
+		}
+		number_of_read_ahead_chunks = (int) value_64bit;
+	}
+	string_length = system_string_length(
+	                 argv[ optind ] );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libewf_glob_wide(
+	          argv[ optind ],
+	          string_length,
+	          LIBEWF_FORMAT_UNKNOWN,
+	          &filenames,
+	          &number_of_filenames,
+	          &error );
+#else
+	result = libewf_glob(
+	          argv[ optind ],
+	          string_length,
+	          LIBEWF_FORMAT_UNKNOWN,
+	          &filenames,
+	          &number_of_filenames,
+	          &error );
+#endif
+	if( result != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to resolve segment files.\n" );
+
+		goto on_error;
+	}
+	if( option_trace_filename != NULL )
+	{
+		number_of_reads = 0;
+
+		if( ewf_bench_read_trace(
+		     option_trace_filename,
+		     &reads,
+		     &number_of_reads,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to read trace file.\n" );
+
+			goto on_error;
+		}
+		if( number_of_reads == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Missing reads in trace file.\n" );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		if( ewf_bench_get_media_size(
+		     filenames,
+		     number_of_filenames,
+		     &media_size,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to retrieve media size.\n" );
+
+			goto on_error;
+		}
+		if( ewf_bench_generate_reads(
+		     media_size,
+		     number_of_reads,
+		     &reads,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to generate reads.\n" );
+
+			goto on_error;
+		}
+	}
+	fprintf(
+	 stdout,
+	 "# cache_size_mib\treads\tbytes\tp50_ns\tp99_ns\tp999_ns\tmaximum_ns\tmean_ns\tcache_hits\tcache_misses\thit_rate\n" );
+
+	for( cache_size_index = 0;
+	     cache_size_index < 4;
+	     cache_size_index++ )
+	{
+		if( ewf_bench_replay_reads(
+		     filenames,
+		     number_of_filenames,
+		     reads,
+		     number_of_reads,
+		     ( cache_size != 0 ) ? cache_size : ewf_bench_default_cache_sizes[ cache_size_index ],
+		     number_of_read_ahead_chunks,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to replay reads.\n" );
+
+			goto on_error;
+		}
+		if( cache_size != 0 )
+		{
+			break;
+		}
+	}
+	memory_free(
+	 reads );
+
+	reads = NULL;
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libewf_glob_wide_free(
+	          filenames,
+	          number_of_filenames,
+	          &error );
+#else
+	result = libewf_glob_free(
+	          filenames,
+	          number_of_filenames,
+	          &error );
+#endif
+	if( result != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free glob.\n" );
+
+		goto on_error;
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( reads != NULL )
+	{
+		memory_free(
+		 reads );
+	}
+	if( filenames != NULL )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		libewf_glob_wide_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#else
+		libewf_glob_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#endif
+	}
+	return( EXIT_FAILURE );
+}
+
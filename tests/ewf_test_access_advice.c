@@ -0,0 +1,789 @@
+/*
+ * Library access_advice type test program
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_access_advice.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Tests the libewf_access_advice_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_access_advice_initialize(
+     void )
+{
+	libcerror_error_t *error              = NULL;
+	libewf_access_advice_t *access_advice = NULL;
+	int result                            = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_access_advice_initialize(
+	          &access_advice,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "access_advice",
+	 access_advice );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "access_advice->number_of_ranges",
+	 access_advice->number_of_ranges,
+	 0 );
+
+	result = libewf_access_advice_free(
+	          &access_advice,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "access_advice",
+	 access_advice );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_access_advice_initialize(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( access_advice != NULL )
+	{
+		libewf_access_advice_free(
+		 &access_advice,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_access_advice_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_access_advice_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_access_advice_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_access_advice_set_range and libewf_access_advice_get_advice functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_access_advice_set_range(
+     void )
+{
+	libcerror_error_t *error              = NULL;
+	libewf_access_advice_t *access_advice = NULL;
+	uint64_t end_chunk_index              = 0;
+	int advice                            = 0;
+	int range_index                       = 0;
+	int result                            = 0;
+
+	result = libewf_access_advice_initialize(
+	          &access_advice,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "access_advice",
+	 access_advice );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test advice without ranges
+	 */
+	result = libewf_access_advice_get_advice(
+	          access_advice,
+	          5,
+	          &advice,
+	          &end_chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "advice",
+	 advice,
+	 LIBEWF_ACCESS_ADVICE_NORMAL );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "end_chunk_index",
+	 end_chunk_index,
+	 (uint64_t) UINT64_MAX );
+
+	/* Test a normal range that does not override another range is not retained
+	 */
+	result = libewf_access_advice_set_range(
+	          access_advice,
+	          0,
+	          100,
+	          LIBEWF_ACCESS_ADVICE_NORMAL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "access_advice->number_of_ranges",
+	 access_advice->number_of_ranges,
+	 0 );
+
+	/* Test chunks 10 to 29 are read sequentially and chunks 20 to 24 randomly
+	 */
+	result = libewf_access_advice_set_range(
+	          access_advice,
+	          10,
+	          20,
+	          LIBEWF_ACCESS_ADVICE_SEQUENTIAL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_access_advice_set_range(
+	          access_advice,
+	          20,
+	          5,
+	          LIBEWF_ACCESS_ADVICE_RANDOM,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "access_advice->number_of_ranges",
+	 access_advice->number_of_ranges,
+	 2 );
+
+	result = libewf_access_advice_get_advice(
+	          access_advice,
+	          5,
+	          &advice,
+	          &end_chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "advice",
+	 advice,
+	 LIBEWF_ACCESS_ADVICE_NORMAL );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "end_chunk_index",
+	 end_chunk_index,
+	 (uint64_t) 10 );
+
+	result = libewf_access_advice_get_advice(
+	          access_advice,
+	          10,
+	          &advice,
+	          &end_chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "advice",
+	 advice,
+	 LIBEWF_ACCESS_ADVICE_SEQUENTIAL );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "end_chunk_index",
+	 end_chunk_index,
+	 (uint64_t) 20 );
+
+	result = libewf_access_advice_get_advice(
+	          access_advice,
+	          22,
+	          &advice,
+	          &end_chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "advice",
+	 advice,
+	 LIBEWF_ACCESS_ADVICE_RANDOM );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "end_chunk_index",
+	 end_chunk_index,
+	 (uint64_t) 25 );
+
+	result = libewf_access_advice_get_advice(
+	          access_advice,
+	          25,
+	          &advice,
+	          &end_chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "advice",
+	 advice,
+	 LIBEWF_ACCESS_ADVICE_SEQUENTIAL );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "end_chunk_index",
+	 end_chunk_index,
+	 (uint64_t) 30 );
+
+	result = libewf_access_advice_get_advice(
+	          access_advice,
+	          30,
+	          &advice,
+	          &end_chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "advice",
+	 advice,
+	 LIBEWF_ACCESS_ADVICE_NORMAL );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "end_chunk_index",
+	 end_chunk_index,
+	 (uint64_t) UINT64_MAX );
+
+	/* Test a range that fully covers the other ranges replaces them
+	 */
+	result = libewf_access_advice_set_range(
+	          access_advice,
+	          0,
+	          40,
+	          LIBEWF_ACCESS_ADVICE_DONTNEED,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "access_advice->number_of_ranges",
+	 access_advice->number_of_ranges,
+	 1 );
+
+	result = libewf_access_advice_get_advice(
+	          access_advice,
+	          25,
+	          &advice,
+	          &end_chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "advice",
+	 advice,
+	 LIBEWF_ACCESS_ADVICE_DONTNEED );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "end_chunk_index",
+	 end_chunk_index,
+	 (uint64_t) 40 );
+
+	/* Test a normal range that overrides part of another range is retained
+	 */
+	result = libewf_access_advice_set_range(
+	          access_advice,
+	          30,
+	          20,
+	          LIBEWF_ACCESS_ADVICE_NORMAL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "access_advice->number_of_ranges",
+	 access_advice->number_of_ranges,
+	 2 );
+
+	result = libewf_access_advice_get_advice(
+	          access_advice,
+	          25,
+	          &advice,
+	          &end_chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "advice",
+	 advice,
+	 LIBEWF_ACCESS_ADVICE_DONTNEED );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "end_chunk_index",
+	 end_chunk_index,
+	 (uint64_t) 30 );
+
+	result = libewf_access_advice_get_advice(
+	          access_advice,
+	          35,
+	          &advice,
+	          &end_chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "advice",
+	 advice,
+	 LIBEWF_ACCESS_ADVICE_NORMAL );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "end_chunk_index",
+	 end_chunk_index,
+	 (uint64_t) 50 );
+
+	/* Test the oldest range is dropped when the maximum number of ranges is reached
+	 */
+	for( range_index = 0;
+	     range_index < LIBEWF_ACCESS_ADVICE_MAXIMUM_NUMBER_OF_RANGES;
+	     range_index++ )
+	{
+		result = libewf_access_advice_set_range(
+		          access_advice,
+		          1000 + range_index,
+		          1,
+		          LIBEWF_ACCESS_ADVICE_RANDOM,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "access_advice->number_of_ranges",
+	 access_advice->number_of_ranges,
+	 64 );
+
+	result = libewf_access_advice_get_advice(
+	          access_advice,
+	          25,
+	          &advice,
+	          &end_chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "advice",
+	 advice,
+	 LIBEWF_ACCESS_ADVICE_NORMAL );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "end_chunk_index",
+	 end_chunk_index,
+	 (uint64_t) 1000 );
+
+	result = libewf_access_advice_get_advice(
+	          access_advice,
+	          1000,
+	          &advice,
+	          &end_chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "advice",
+	 advice,
+	 LIBEWF_ACCESS_ADVICE_RANDOM );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "end_chunk_index",
+	 end_chunk_index,
+	 (uint64_t) 1001 );
+
+	/* Test error cases
+	 */
+	result = libewf_access_advice_set_range(
+	          NULL,
+	          0,
+	          1,
+	          LIBEWF_ACCESS_ADVICE_RANDOM,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_access_advice_set_range(
+	          access_advice,
+	          0,
+	          1,
+	          -1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_access_advice_get_advice(
+	          NULL,
+	          0,
+	          &advice,
+	          &end_chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_access_advice_get_advice(
+	          access_advice,
+	          0,
+	          NULL,
+	          &end_chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_access_advice_get_advice(
+	          access_advice,
+	          0,
+	          &advice,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_access_advice_free(
+	          &access_advice,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "access_advice",
+	 access_advice );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( access_advice != NULL )
+	{
+		libewf_access_advice_free(
+		 &access_advice,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_access_advice_initialize",
+	 ewf_test_access_advice_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_access_advice_free",
+	 ewf_test_access_advice_free );
+
+	EWF_TEST_RUN(
+	 "libewf_access_advice_set_range",
+	 ewf_test_access_advice_set_range );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
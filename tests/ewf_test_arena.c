@@ -0,0 +1,691 @@
+/*
+ * Library arena type test program
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_arena.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Tests the libewf_arena_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_arena_initialize(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libewf_arena_t *arena           = NULL;
+	int result                      = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests = 1;
+	int number_of_memset_fail_tests = 1;
+	int test_number                 = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_arena_initialize(
+	          &arena,
+	          1024,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "arena",
+	 arena );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_arena_free(
+	          &arena,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "arena",
+	 arena );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_arena_initialize(
+	          NULL,
+	          1024,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	arena = (libewf_arena_t *) 0x12345678UL;
+
+	result = libewf_arena_initialize(
+	          &arena,
+	          1024,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	arena = NULL;
+
+	result = libewf_arena_initialize(
+	          &arena,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_arena_initialize(
+	          &arena,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_arena_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_arena_initialize(
+		          &arena,
+		          1024,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( arena != NULL )
+			{
+				libewf_arena_free(
+				 &arena,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "arena",
+			 arena );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_arena_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_arena_initialize(
+		          &arena,
+		          1024,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( arena != NULL )
+			{
+				libewf_arena_free(
+				 &arena,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "arena",
+			 arena );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( arena != NULL )
+	{
+		libewf_arena_free(
+		 &arena,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_arena_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_arena_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_arena_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_arena_allocate and libewf_arena_get_allocated_size functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_arena_allocate(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	libewf_arena_t *arena    = NULL;
+	uint8_t *large_value     = NULL;
+	uint8_t *value1          = NULL;
+	uint8_t *value2          = NULL;
+	void *value              = NULL;
+	size64_t allocated_size  = 0;
+	size_t block_header_size = 0;
+	size_t value_index       = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	block_header_size = ( sizeof( libewf_arena_block_t ) + 7 ) & ~( (size_t) 7 );
+
+	result = libewf_arena_initialize(
+	          &arena,
+	          1024,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "arena",
+	 arena );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_arena_get_allocated_size(
+	          arena,
+	          &allocated_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "allocated_size",
+	 (uint64_t) allocated_size,
+	 (uint64_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_arena_allocate(
+	          arena,
+	          5,
+	          &value,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "value",
+	 value );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	value1 = (uint8_t *) value;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "value1 alignment",
+	 (int) ( (size_t) value1 & 7 ),
+	 0 );
+
+	for( value_index = 0;
+	     value_index < 5;
+	     value_index++ )
+	{
+		EWF_TEST_ASSERT_EQUAL_UINT8(
+		 "value1[ value_index ]",
+		 value1[ value_index ],
+		 (uint8_t) 0 );
+	}
+	value1[ 4 ] = 0xff;
+
+	result = libewf_arena_allocate(
+	          arena,
+	          16,
+	          &value,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	value2 = (uint8_t *) value;
+
+	/* Small values are allocated consecutively in the same block
+	 */
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "value2 - value1",
+	 (int) ( value2 - value1 ),
+	 8 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "value2[ 0 ]",
+	 value2[ 0 ],
+	 (uint8_t) 0 );
+
+	/* Large values are allocated in a block of their own
+	 */
+	result = libewf_arena_allocate(
+	          arena,
+	          512,
+	          &value,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	large_value = (uint8_t *) value;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "large_value alignment",
+	 (int) ( (size_t) large_value & 7 ),
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "large_value[ 511 ]",
+	 large_value[ 511 ],
+	 (uint8_t) 0 );
+
+	result = libewf_arena_allocate(
+	          arena,
+	          8,
+	          &value,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The large value does not affect the current block
+	 */
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "value - value1",
+	 (int) ( (uint8_t *) value - value1 ),
+	 24 );
+
+	result = libewf_arena_get_allocated_size(
+	          arena,
+	          &allocated_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "allocated_size",
+	 (uint64_t) allocated_size,
+	 (uint64_t) ( ( 2 * block_header_size ) + 1024 + 512 ) );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_arena_allocate(
+	          NULL,
+	          8,
+	          &value,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_arena_allocate(
+	          arena,
+	          0,
+	          &value,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_arena_allocate(
+	          arena,
+	          (size_t) SSIZE_MAX + 1,
+	          &value,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_arena_allocate(
+	          arena,
+	          8,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_arena_get_allocated_size(
+	          NULL,
+	          &allocated_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_arena_get_allocated_size(
+	          arena,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_arena_free(
+	          &arena,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "arena",
+	 arena );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( arena != NULL )
+	{
+		libewf_arena_free(
+		 &arena,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_arena_initialize",
+	 ewf_test_arena_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_arena_free",
+	 ewf_test_arena_free );
+
+	EWF_TEST_RUN(
+	 "libewf_arena_allocate",
+	 ewf_test_arena_allocate );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
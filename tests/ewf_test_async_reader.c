@@ -0,0 +1,950 @@
+/*
+ * Library async_reader type test program
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_async_reader.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Tests the libewf_async_reader_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_async_reader_initialize(
+     void )
+{
+	libcerror_error_t *error            = NULL;
+	libewf_async_reader_t *async_reader = NULL;
+	int result                          = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_async_reader_initialize(
+	          &async_reader,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "async_reader",
+	 async_reader );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "async_reader->maximum_number_of_requests",
+	 async_reader->maximum_number_of_requests,
+	 4 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "async_reader->number_of_files",
+	 async_reader->number_of_files,
+	 0 );
+
+	result = libewf_async_reader_free(
+	          &async_reader,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "async_reader",
+	 async_reader );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_async_reader_initialize(
+	          NULL,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_async_reader_initialize(
+	          &async_reader,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "async_reader",
+	 async_reader );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_async_reader_initialize(
+	          &async_reader,
+	          LIBEWF_ASYNC_READER_MAXIMUM_NUMBER_OF_REQUESTS + 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "async_reader",
+	 async_reader );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( async_reader != NULL )
+	{
+		libewf_async_reader_free(
+		 &async_reader,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_async_reader_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_async_reader_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_async_reader_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_async_reader_set_name function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_async_reader_set_name(
+     void )
+{
+	libcerror_error_t *error            = NULL;
+	libewf_async_reader_t *async_reader = NULL;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_async_reader_initialize(
+	          &async_reader,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "async_reader",
+	 async_reader );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_async_reader_set_name(
+	          async_reader,
+	          2,
+	          "image.E03",
+	          9,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The files up to the file IO pool entry are added without a name
+	 */
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "async_reader->number_of_files",
+	 async_reader->number_of_files,
+	 3 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "async_reader->files[ 0 ].name",
+	 async_reader->files[ 0 ].name );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "async_reader->files[ 2 ].name",
+	 async_reader->files[ 2 ].name );
+
+	result = libewf_async_reader_set_name(
+	          async_reader,
+	          0,
+	          "image.E01",
+	          9,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "async_reader->number_of_files",
+	 async_reader->number_of_files,
+	 3 );
+
+	/* Test error cases
+	 */
+	result = libewf_async_reader_set_name(
+	          NULL,
+	          1,
+	          "image.E02",
+	          9,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_async_reader_set_name(
+	          async_reader,
+	          -1,
+	          "image.E02",
+	          9,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_async_reader_set_name(
+	          async_reader,
+	          1,
+	          NULL,
+	          9,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_async_reader_set_name(
+	          async_reader,
+	          1,
+	          "image.E02",
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test a name that was already set
+	 */
+	result = libewf_async_reader_set_name(
+	          async_reader,
+	          2,
+	          "image.E03",
+	          9,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_async_reader_free(
+	          &async_reader,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "async_reader",
+	 async_reader );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( async_reader != NULL )
+	{
+		libewf_async_reader_free(
+		 &async_reader,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_async_reader_open_file function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_async_reader_open_file(
+     void )
+{
+	libcerror_error_t *error            = NULL;
+	libewf_async_reader_t *async_reader = NULL;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_async_reader_initialize(
+	          &async_reader,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "async_reader",
+	 async_reader );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_async_reader_set_name(
+	          async_reader,
+	          1,
+	          "nonexistent.E02",
+	          15,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a file IO pool entry without a file
+	 */
+	result = libewf_async_reader_open_file(
+	          async_reader,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a file without a name
+	 */
+	result = libewf_async_reader_open_file(
+	          async_reader,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a file that cannot be opened
+	 */
+	result = libewf_async_reader_open_file(
+	          async_reader,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "async_reader->files[ 1 ].is_unavailable",
+	 async_reader->files[ 1 ].is_unavailable,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "async_reader->number_of_open_files",
+	 async_reader->number_of_open_files,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libewf_async_reader_open_file(
+	          NULL,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_async_reader_free(
+	          &async_reader,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "async_reader",
+	 async_reader );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( async_reader != NULL )
+	{
+		libewf_async_reader_free(
+		 &async_reader,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_async_reader_queue_read function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_async_reader_queue_read(
+     void )
+{
+	uint8_t buffer[ 16 ];
+
+	libcerror_error_t *error            = NULL;
+	libewf_async_reader_t *async_reader = NULL;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_async_reader_initialize(
+	          &async_reader,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "async_reader",
+	 async_reader );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_async_reader_queue_read(
+	          NULL,
+	          NULL,
+	          0,
+	          0,
+	          buffer,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_async_reader_queue_read(
+	          async_reader,
+	          NULL,
+	          0,
+	          -1,
+	          buffer,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_async_reader_queue_read(
+	          async_reader,
+	          NULL,
+	          0,
+	          0,
+	          NULL,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_async_reader_queue_read(
+	          async_reader,
+	          NULL,
+	          0,
+	          0,
+	          buffer,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test a read of a file without a name, which is read through the file IO pool
+	 */
+	result = libewf_async_reader_queue_read(
+	          async_reader,
+	          NULL,
+	          0,
+	          0,
+	          buffer,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "async_reader->number_of_requests",
+	 async_reader->number_of_requests,
+	 0 );
+
+	/* Test a read when the maximum number of requests is reached
+	 */
+	async_reader->number_of_requests = 1;
+
+	result = libewf_async_reader_queue_read(
+	          async_reader,
+	          NULL,
+	          0,
+	          0,
+	          buffer,
+	          16,
+	          &error );
+
+	async_reader->number_of_requests = 0;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_async_reader_free(
+	          &async_reader,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "async_reader",
+	 async_reader );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( async_reader != NULL )
+	{
+		libewf_async_reader_free(
+		 &async_reader,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_async_reader_wait function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_async_reader_wait(
+     void )
+{
+	libcerror_error_t *error            = NULL;
+	libewf_async_reader_t *async_reader = NULL;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_async_reader_initialize(
+	          &async_reader,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "async_reader",
+	 async_reader );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_async_reader_wait(
+	          async_reader,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_async_reader_wait(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_async_reader_free(
+	          &async_reader,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "async_reader",
+	 async_reader );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( async_reader != NULL )
+	{
+		libewf_async_reader_free(
+		 &async_reader,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_async_reader_initialize",
+	 ewf_test_async_reader_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_async_reader_free",
+	 ewf_test_async_reader_free );
+
+	EWF_TEST_RUN(
+	 "libewf_async_reader_set_name",
+	 ewf_test_async_reader_set_name );
+
+	EWF_TEST_RUN(
+	 "libewf_async_reader_open_file",
+	 ewf_test_async_reader_open_file );
+
+	EWF_TEST_RUN(
+	 "libewf_async_reader_queue_read",
+	 ewf_test_async_reader_queue_read );
+
+	EWF_TEST_RUN(
+	 "libewf_async_reader_wait",
+	 ewf_test_async_reader_wait );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
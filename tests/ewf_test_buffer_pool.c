@@ -0,0 +1,961 @@
+/*
+ * Library buffer_pool type test program
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_buffer_pool.h"
+#include "../libewf/libewf_definitions.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Tests the libewf_buffer_pool_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_buffer_pool_initialize(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libewf_buffer_pool_t *buffer_pool = NULL;
+	int result                        = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests   = 2;
+	int number_of_memset_fail_tests   = 2;
+	int test_number                   = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_buffer_pool_initialize(
+	          &buffer_pool,
+	          1024,
+	          4,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "buffer_pool",
+	 buffer_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_buffer_pool_free(
+	          &buffer_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "buffer_pool",
+	 buffer_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_buffer_pool_initialize(
+	          NULL,
+	          1024,
+	          4,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	buffer_pool = (libewf_buffer_pool_t *) 0x12345678UL;
+
+	result = libewf_buffer_pool_initialize(
+	          &buffer_pool,
+	          1024,
+	          4,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	buffer_pool = NULL;
+
+	result = libewf_buffer_pool_initialize(
+	          &buffer_pool,
+	          0,
+	          4,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_buffer_pool_initialize(
+	          &buffer_pool,
+	          1024,
+	          0,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_buffer_pool_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_buffer_pool_initialize(
+		          &buffer_pool,
+		          1024,
+		          4,
+		          0,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( buffer_pool != NULL )
+			{
+				libewf_buffer_pool_free(
+				 &buffer_pool,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "buffer_pool",
+			 buffer_pool );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_buffer_pool_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_buffer_pool_initialize(
+		          &buffer_pool,
+		          1024,
+		          4,
+		          0,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( buffer_pool != NULL )
+			{
+				libewf_buffer_pool_free(
+				 &buffer_pool,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "buffer_pool",
+			 buffer_pool );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( buffer_pool != NULL )
+	{
+		libewf_buffer_pool_free(
+		 &buffer_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_buffer_pool_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_buffer_pool_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_buffer_pool_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_buffer_pool_acquire and libewf_buffer_pool_release functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_buffer_pool_acquire(
+     void )
+{
+	libcerror_error_t *error                 = NULL;
+	libewf_buffer_pool_t *buffer_pool        = NULL;
+	libewf_buffer_pool_t *shared_buffer_pool = NULL;
+	int result                               = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_buffer_pool_initialize(
+	          &buffer_pool,
+	          1024,
+	          4,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "buffer_pool",
+	 buffer_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_buffer_pool_acquire(
+	          buffer_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	shared_buffer_pool = buffer_pool;
+
+	result = libewf_buffer_pool_release(
+	          &shared_buffer_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "shared_buffer_pool",
+	 shared_buffer_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "buffer_pool->number_of_references",
+	 buffer_pool->number_of_references,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libewf_buffer_pool_acquire(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_buffer_pool_release(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_buffer_pool_release(
+	          &buffer_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "buffer_pool",
+	 buffer_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( buffer_pool != NULL )
+	{
+		libewf_buffer_pool_free(
+		 &buffer_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_buffer_pool_get_buffer and libewf_buffer_pool_return_buffer functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_buffer_pool_get_buffer(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libewf_buffer_pool_t *buffer_pool = NULL;
+	uint8_t *buffer1                  = NULL;
+	uint8_t *buffer2                  = NULL;
+	uint8_t *reused_buffer            = NULL;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_buffer_pool_initialize(
+	          &buffer_pool,
+	          1024,
+	          1,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "buffer_pool",
+	 buffer_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_buffer_pool_get_buffer(
+	          buffer_pool,
+	          &buffer1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "buffer1",
+	 buffer1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_buffer_pool_get_buffer(
+	          buffer_pool,
+	          &buffer2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "buffer2",
+	 buffer2 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	reused_buffer = buffer1;
+
+	result = libewf_buffer_pool_return_buffer(
+	          buffer_pool,
+	          &buffer1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "buffer1",
+	 buffer1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "buffer_pool->number_of_buffers",
+	 buffer_pool->number_of_buffers,
+	 1 );
+
+	/* The pool is full hence the second buffer is freed
+	 */
+	result = libewf_buffer_pool_return_buffer(
+	          buffer_pool,
+	          &buffer2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "buffer2",
+	 buffer2 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "buffer_pool->number_of_buffers",
+	 buffer_pool->number_of_buffers,
+	 1 );
+
+	result = libewf_buffer_pool_get_buffer(
+	          buffer_pool,
+	          &buffer1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "buffer1 == reused_buffer",
+	 (int) ( buffer1 == reused_buffer ),
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "buffer_pool->number_of_buffers",
+	 buffer_pool->number_of_buffers,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libewf_buffer_pool_get_buffer(
+	          NULL,
+	          &buffer2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_buffer_pool_get_buffer(
+	          buffer_pool,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_buffer_pool_return_buffer(
+	          NULL,
+	          &buffer1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_buffer_pool_return_buffer(
+	          buffer_pool,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_buffer_pool_return_buffer(
+	          buffer_pool,
+	          &buffer1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_buffer_pool_free(
+	          &buffer_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "buffer_pool",
+	 buffer_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( buffer1 != NULL )
+	{
+		memory_free(
+		 buffer1 );
+	}
+	if( buffer2 != NULL )
+	{
+		memory_free(
+		 buffer2 );
+	}
+	if( buffer_pool != NULL )
+	{
+		libewf_buffer_pool_free(
+		 &buffer_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_buffer_pool_allocate_region and libewf_buffer_pool_is_region_buffer functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_buffer_pool_allocate_region(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libewf_buffer_pool_t *buffer_pool = NULL;
+	uint8_t *buffer                   = NULL;
+	int result                        = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_buffer_pool_initialize(
+	          &buffer_pool,
+	          1024,
+	          4,
+	          LIBEWF_BUFFER_POOL_FLAG_PREALLOCATE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "buffer_pool",
+	 buffer_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "buffer_pool->region",
+	 buffer_pool->region );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "buffer_pool->number_of_buffers",
+	 buffer_pool->number_of_buffers,
+	 4 );
+
+	result = libewf_buffer_pool_get_buffer(
+	          buffer_pool,
+	          &buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "buffer",
+	 buffer );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_buffer_pool_is_region_buffer(
+	          buffer_pool,
+	          buffer );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_buffer_pool_return_buffer(
+	          buffer_pool,
+	          &buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "buffer",
+	 buffer );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_buffer_pool_allocate_region(
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_buffer_pool_allocate_region(
+	          buffer_pool,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_buffer_pool_is_region_buffer(
+	          NULL,
+	          NULL );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Clean up
+	 */
+	result = libewf_buffer_pool_free(
+	          &buffer_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "buffer_pool",
+	 buffer_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( buffer_pool != NULL )
+	{
+		libewf_buffer_pool_free(
+		 &buffer_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_buffer_pool_initialize",
+	 ewf_test_buffer_pool_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_buffer_pool_free",
+	 ewf_test_buffer_pool_free );
+
+	EWF_TEST_RUN(
+	 "libewf_buffer_pool_acquire",
+	 ewf_test_buffer_pool_acquire );
+
+	EWF_TEST_RUN(
+	 "libewf_buffer_pool_get_buffer",
+	 ewf_test_buffer_pool_get_buffer );
+
+	EWF_TEST_RUN(
+	 "libewf_buffer_pool_allocate_region",
+	 ewf_test_buffer_pool_allocate_region );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
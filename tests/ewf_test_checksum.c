@@ -0,0 +1,377 @@
+/*
+ * Library checksum functions test program
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_checksum.h"
+#include "../libewf/libewf_deflate.h"
+
+uint8_t ewf_test_checksum_data[ 9 ] = {
+	'W', 'i', 'k', 'i', 'p', 'e', 'd', 'i', 'a' };
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Fills a buffer with pseudo random data
+ */
+void ewf_test_checksum_fill_buffer(
+      uint8_t *buffer,
+      size_t size )
+{
+	uint32_t random_value = 0x12345678UL;
+	size_t buffer_offset  = 0;
+
+	for( buffer_offset = 0;
+	     buffer_offset < size;
+	     buffer_offset++ )
+	{
+		random_value ^= random_value << 13;
+		random_value ^= random_value >> 17;
+		random_value ^= random_value << 5;
+
+		buffer[ buffer_offset ] = (uint8_t) ( random_value >> 24 );
+	}
+}
+
+/* Tests the libewf_checksum_calculate_adler32 function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_checksum_calculate_adler32(
+     void )
+{
+	uint8_t buffer[ 65536 + 1 ];
+
+	libcerror_error_t *error = NULL;
+	uint32_t checksum_value  = 0;
+	uint32_t expected_value  = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_checksum_calculate_adler32(
+	          &checksum_value,
+	          ewf_test_checksum_data,
+	          9,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "checksum_value",
+	 checksum_value,
+	 (uint32_t) 0x11e60398UL );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test unaligned data larger than the modulo interval
+	 */
+	ewf_test_checksum_fill_buffer(
+	 buffer,
+	 65536 + 1 );
+
+	result = libewf_deflate_calculate_adler32(
+	          &expected_value,
+	          &( buffer[ 1 ] ),
+	          65536,
+	          0x1234abcdUL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_checksum_calculate_adler32(
+	          &checksum_value,
+	          &( buffer[ 1 ] ),
+	          65536,
+	          0x1234abcdUL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "checksum_value",
+	 checksum_value,
+	 expected_value );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_checksum_calculate_adler32(
+	          NULL,
+	          ewf_test_checksum_data,
+	          9,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_checksum_calculate_adler32(
+	          &checksum_value,
+	          NULL,
+	          9,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_LIBEWF_CHECKSUM_X86_SIMD )
+
+/* Tests the libewf_checksum_calculate_adler32_ssse3 and
+ * libewf_checksum_calculate_adler32_avx2 functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_checksum_calculate_adler32_x86_simd(
+     void )
+{
+	uint8_t buffer[ 65536 + 1 ];
+
+	libcerror_error_t *error = NULL;
+	size_t size              = 0;
+	uint32_t checksum_value  = 0;
+	uint32_t expected_value  = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	ewf_test_checksum_fill_buffer(
+	 buffer,
+	 65536 + 1 );
+
+	/* Test regular cases with sizes that are not a multiple of the block size
+	 */
+	for( size = 0;
+	     size <= 65536;
+	     size += 4099 )
+	{
+		result = libewf_deflate_calculate_adler32(
+		          &expected_value,
+		          &( buffer[ 1 ] ),
+		          size,
+		          0xfff0fff0UL,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		if( __builtin_cpu_supports( "ssse3" ) )
+		{
+			result = libewf_checksum_calculate_adler32_ssse3(
+			          &checksum_value,
+			          &( buffer[ 1 ] ),
+			          size,
+			          0xfff0fff0UL,
+			          &error );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			EWF_TEST_ASSERT_EQUAL_UINT32(
+			 "checksum_value",
+			 checksum_value,
+			 expected_value );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+		if( __builtin_cpu_supports( "avx2" ) )
+		{
+			result = libewf_checksum_calculate_adler32_avx2(
+			          &checksum_value,
+			          &( buffer[ 1 ] ),
+			          size,
+			          0xfff0fff0UL,
+			          &error );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			EWF_TEST_ASSERT_EQUAL_UINT32(
+			 "checksum_value",
+			 checksum_value,
+			 expected_value );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+	}
+	/* Test error cases
+	 */
+	result = libewf_checksum_calculate_adler32_ssse3(
+	          &checksum_value,
+	          buffer,
+	          (size_t) SSIZE_MAX + 1,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_checksum_calculate_adler32_avx2(
+	          &checksum_value,
+	          buffer,
+	          (size_t) SSIZE_MAX + 1,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_LIBEWF_CHECKSUM_X86_SIMD ) */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_checksum_calculate_adler32",
+	 ewf_test_checksum_calculate_adler32 );
+
+#if defined( HAVE_LIBEWF_CHECKSUM_X86_SIMD )
+
+	EWF_TEST_RUN(
+	 "libewf_checksum_calculate_adler32_x86_simd",
+	 ewf_test_checksum_calculate_adler32_x86_simd );
+
+#endif /* defined( HAVE_LIBEWF_CHECKSUM_X86_SIMD ) */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,868 @@
+/*
+ * Library chunk_access_map type test program
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_chunk_access_map.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+uint8_t ewf_test_chunk_access_map_set_identifier[ 16 ] = {
+	0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10 };
+
+/* Tests the libewf_chunk_access_map_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_access_map_initialize(
+     void )
+{
+	libcerror_error_t *error                    = NULL;
+	libewf_chunk_access_map_t *chunk_access_map = NULL;
+	int result                                  = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_access_map_initialize(
+	          &chunk_access_map,
+	          20,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_access_map",
+	 chunk_access_map );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "chunk_access_map->bitmap_size",
+	 chunk_access_map->bitmap_size,
+	 (size_t) 3 );
+
+	result = libewf_chunk_access_map_free(
+	          &chunk_access_map,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_access_map",
+	 chunk_access_map );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_access_map_initialize(
+	          NULL,
+	          20,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_access_map_initialize(
+	          &chunk_access_map,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_access_map != NULL )
+	{
+		libewf_chunk_access_map_free(
+		 &chunk_access_map,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_access_map_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_access_map_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_access_map_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_access_map_set_chunk_range and libewf_chunk_access_map_get_next_chunk_index functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_access_map_set_chunk_range(
+     void )
+{
+	libcerror_error_t *error                    = NULL;
+	libewf_chunk_access_map_t *chunk_access_map = NULL;
+	uint64_t next_chunk_index                   = 0;
+	int result                                  = 0;
+
+	result = libewf_chunk_access_map_initialize(
+	          &chunk_access_map,
+	          20,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_access_map",
+	 chunk_access_map );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a map without accessed chunks
+	 */
+	result = libewf_chunk_access_map_get_next_chunk_index(
+	          chunk_access_map,
+	          0,
+	          &next_chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test chunks 3 and 9 to 11 where the range of chunk 3 is set twice
+	 */
+	result = libewf_chunk_access_map_set_chunk_range(
+	          chunk_access_map,
+	          3,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_access_map_set_chunk_range(
+	          chunk_access_map,
+	          3,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_access_map_set_chunk_range(
+	          chunk_access_map,
+	          9,
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "chunk_access_map->number_of_accessed_chunks",
+	 chunk_access_map->number_of_accessed_chunks,
+	 (uint64_t) 4 );
+
+	result = libewf_chunk_access_map_get_next_chunk_index(
+	          chunk_access_map,
+	          0,
+	          &next_chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "next_chunk_index",
+	 next_chunk_index,
+	 (uint64_t) 3 );
+
+	result = libewf_chunk_access_map_get_next_chunk_index(
+	          chunk_access_map,
+	          4,
+	          &next_chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "next_chunk_index",
+	 next_chunk_index,
+	 (uint64_t) 9 );
+
+	result = libewf_chunk_access_map_get_next_chunk_index(
+	          chunk_access_map,
+	          11,
+	          &next_chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "next_chunk_index",
+	 next_chunk_index,
+	 (uint64_t) 11 );
+
+	result = libewf_chunk_access_map_get_next_chunk_index(
+	          chunk_access_map,
+	          12,
+	          &next_chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a range that is truncated to the number of chunks
+	 */
+	result = libewf_chunk_access_map_set_chunk_range(
+	          chunk_access_map,
+	          18,
+	          10,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "chunk_access_map->number_of_accessed_chunks",
+	 chunk_access_map->number_of_accessed_chunks,
+	 (uint64_t) 6 );
+
+	result = libewf_chunk_access_map_get_next_chunk_index(
+	          chunk_access_map,
+	          12,
+	          &next_chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "next_chunk_index",
+	 next_chunk_index,
+	 (uint64_t) 18 );
+
+	result = libewf_chunk_access_map_get_next_chunk_index(
+	          chunk_access_map,
+	          20,
+	          &next_chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_access_map_set_chunk_range(
+	          NULL,
+	          0,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_access_map_get_next_chunk_index(
+	          chunk_access_map,
+	          0,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_access_map_free(
+	          &chunk_access_map,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_access_map",
+	 chunk_access_map );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_access_map != NULL )
+	{
+		libewf_chunk_access_map_free(
+		 &chunk_access_map,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_access_map_write_file and libewf_chunk_access_map_read_file functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_access_map_read_write_file(
+     void )
+{
+	uint8_t other_set_identifier[ 16 ];
+
+	libcerror_error_t *error                    = NULL;
+	libewf_chunk_access_map_t *chunk_access_map = NULL;
+	uint64_t next_chunk_index                   = 0;
+	int result                                  = 0;
+
+	memory_set(
+	 other_set_identifier,
+	 0,
+	 16 );
+
+	remove(
+	 "ewf_test_chunk_access_map.map" );
+
+	result = libewf_chunk_access_map_initialize(
+	          &chunk_access_map,
+	          20,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_access_map",
+	 chunk_access_map );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a file that does not exist
+	 */
+	result = libewf_chunk_access_map_read_file(
+	          chunk_access_map,
+	          "ewf_test_chunk_access_map.map",
+	          29,
+	          512,
+	          ewf_test_chunk_access_map_set_identifier,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_access_map_set_chunk_range(
+	          chunk_access_map,
+	          5,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_access_map_write_file(
+	          chunk_access_map,
+	          "ewf_test_chunk_access_map.map",
+	          29,
+	          512,
+	          ewf_test_chunk_access_map_set_identifier,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_access_map_free(
+	          &chunk_access_map,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_access_map",
+	 chunk_access_map );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test reading the file back
+	 */
+	result = libewf_chunk_access_map_initialize(
+	          &chunk_access_map,
+	          20,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_access_map",
+	 chunk_access_map );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_access_map_read_file(
+	          chunk_access_map,
+	          "ewf_test_chunk_access_map.map",
+	          29,
+	          512,
+	          ewf_test_chunk_access_map_set_identifier,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "chunk_access_map->number_of_accessed_chunks",
+	 chunk_access_map->number_of_accessed_chunks,
+	 (uint64_t) 2 );
+
+	result = libewf_chunk_access_map_get_next_chunk_index(
+	          chunk_access_map,
+	          0,
+	          &next_chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "next_chunk_index",
+	 next_chunk_index,
+	 (uint64_t) 5 );
+
+	result = libewf_chunk_access_map_get_next_chunk_index(
+	          chunk_access_map,
+	          7,
+	          &next_chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_access_map_free(
+	          &chunk_access_map,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_access_map",
+	 chunk_access_map );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a file of another segment file set
+	 */
+	result = libewf_chunk_access_map_initialize(
+	          &chunk_access_map,
+	          20,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_access_map",
+	 chunk_access_map );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_access_map_read_file(
+	          chunk_access_map,
+	          "ewf_test_chunk_access_map.map",
+	          29,
+	          512,
+	          other_set_identifier,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_access_map_free(
+	          &chunk_access_map,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_access_map",
+	 chunk_access_map );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a file of a different number of chunks
+	 */
+	result = libewf_chunk_access_map_initialize(
+	          &chunk_access_map,
+	          21,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_access_map",
+	 chunk_access_map );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_access_map_read_file(
+	          chunk_access_map,
+	          "ewf_test_chunk_access_map.map",
+	          29,
+	          512,
+	          ewf_test_chunk_access_map_set_identifier,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_access_map_free(
+	          &chunk_access_map,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_access_map",
+	 chunk_access_map );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	remove(
+	 "ewf_test_chunk_access_map.map" );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_access_map != NULL )
+	{
+		libewf_chunk_access_map_free(
+		 &chunk_access_map,
+		 NULL );
+	}
+	remove(
+	 "ewf_test_chunk_access_map.map" );
+
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_access_map_initialize",
+	 ewf_test_chunk_access_map_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_access_map_free",
+	 ewf_test_chunk_access_map_free );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_access_map_set_chunk_range",
+	 ewf_test_chunk_access_map_set_chunk_range );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_access_map_read_write_file",
+	 ewf_test_chunk_access_map_read_write_file );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,2058 @@
+/*
+ * Library chunk_cache type test program
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_chunk_cache.h"
+#include "../libewf/libewf_chunk_data.h"
+#include "../libewf/libewf_definitions.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Tests the libewf_chunk_cache_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_cache_initialize(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libewf_chunk_cache_t *chunk_cache = NULL;
+	int result                        = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests   = 7;
+	int number_of_memset_fail_tests   = 7;
+	int test_number                   = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_cache_initialize(
+	          &chunk_cache,
+	          4,
+	          2,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_free(
+	          &chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_cache_initialize(
+	          NULL,
+	          4,
+	          2,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	chunk_cache = (libewf_chunk_cache_t *) 0x12345678UL;
+
+	result = libewf_chunk_cache_initialize(
+	          &chunk_cache,
+	          4,
+	          2,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	chunk_cache = NULL;
+
+	result = libewf_chunk_cache_initialize(
+	          &chunk_cache,
+	          0,
+	          2,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_initialize(
+	          &chunk_cache,
+	          4,
+	          0,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_chunk_cache_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_chunk_cache_initialize(
+		          &chunk_cache,
+		          4,
+		          2,
+		          0,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( chunk_cache != NULL )
+			{
+				libewf_chunk_cache_free(
+				 &chunk_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "chunk_cache",
+			 chunk_cache );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_chunk_cache_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_chunk_cache_initialize(
+		          &chunk_cache,
+		          4,
+		          2,
+		          0,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( chunk_cache != NULL )
+			{
+				libewf_chunk_cache_free(
+				 &chunk_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "chunk_cache",
+			 chunk_cache );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_cache != NULL )
+	{
+		libewf_chunk_cache_free(
+		 &chunk_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_cache_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_cache_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_cache_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_cache_set_chunk_data, libewf_chunk_cache_has_chunk_data and libewf_chunk_cache_copy_data functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_cache_copy_data(
+     void )
+{
+	uint8_t buffer[ 64 ];
+
+	libcerror_error_t *error          = NULL;
+	libewf_chunk_cache_t *chunk_cache = NULL;
+	libewf_chunk_data_t *chunk_data   = NULL;
+	size_t copy_size                  = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_chunk_cache_initialize(
+	          &chunk_cache,
+	          4,
+	          2,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_initialize(
+	          &chunk_data,
+	          512,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	chunk_data->data_size = 512;
+
+	( chunk_data->data )[ 32 ] = 0x5a;
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_cache_copy_data(
+	          chunk_cache,
+	          5,
+	          0,
+	          buffer,
+	          64,
+	          &copy_size,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_has_chunk_data(
+	          chunk_cache,
+	          5,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_set_chunk_data(
+	          chunk_cache,
+	          5,
+	          chunk_data,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The chunk cache takes over management of chunk_data
+	 */
+	chunk_data = NULL;
+
+	result = libewf_chunk_cache_has_chunk_data(
+	          chunk_cache,
+	          5,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_copy_data(
+	          chunk_cache,
+	          5,
+	          32,
+	          buffer,
+	          64,
+	          &copy_size,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "copy_size",
+	 copy_size,
+	 (size_t) 64 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 0 ]",
+	 buffer[ 0 ],
+	 (uint8_t) 0x5a );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_copy_data(
+	          chunk_cache,
+	          5,
+	          480,
+	          buffer,
+	          64,
+	          &copy_size,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "copy_size",
+	 copy_size,
+	 (size_t) 32 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Chunk 13 is not cached
+	 */
+	result = libewf_chunk_cache_copy_data(
+	          chunk_cache,
+	          13,
+	          0,
+	          buffer,
+	          64,
+	          &copy_size,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_cache_copy_data(
+	          NULL,
+	          5,
+	          0,
+	          buffer,
+	          64,
+	          &copy_size,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_copy_data(
+	          chunk_cache,
+	          5,
+	          0,
+	          NULL,
+	          64,
+	          &copy_size,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_copy_data(
+	          chunk_cache,
+	          5,
+	          0,
+	          buffer,
+	          64,
+	          NULL,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_has_chunk_data(
+	          NULL,
+	          5,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_set_chunk_data(
+	          NULL,
+	          5,
+	          NULL,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_set_chunk_data(
+	          chunk_cache,
+	          5,
+	          NULL,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_cache_free(
+	          &chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	if( chunk_cache != NULL )
+	{
+		libewf_chunk_cache_free(
+		 &chunk_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_cache_acquire and libewf_chunk_cache_release functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_cache_acquire(
+     void )
+{
+	libcerror_error_t *error                 = NULL;
+	libewf_chunk_cache_t *chunk_cache        = NULL;
+	libewf_chunk_cache_t *shared_chunk_cache = NULL;
+	int result                               = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_chunk_cache_initialize(
+	          &chunk_cache,
+	          4,
+	          2,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_cache_acquire(
+	          chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_cache->number_of_references",
+	 chunk_cache->number_of_references,
+	 2 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	shared_chunk_cache = chunk_cache;
+
+	result = libewf_chunk_cache_release(
+	          &shared_chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "shared_chunk_cache",
+	 shared_chunk_cache );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_cache->number_of_references",
+	 chunk_cache->number_of_references,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_release(
+	          &chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_cache_acquire(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_release(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_cache != NULL )
+	{
+		libewf_chunk_cache_free(
+		 &chunk_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_cache_get_new_namespace function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_cache_get_new_namespace(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libewf_chunk_cache_t *chunk_cache = NULL;
+	uint64_t key_prefix               = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_chunk_cache_initialize(
+	          &chunk_cache,
+	          4,
+	          2,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_cache_get_new_namespace(
+	          chunk_cache,
+	          &key_prefix,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "key_prefix",
+	 key_prefix,
+	 (uint64_t) 1 << LIBEWF_CHUNK_CACHE_NAMESPACE_BIT_SHIFT );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_get_new_namespace(
+	          chunk_cache,
+	          &key_prefix,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "key_prefix",
+	 key_prefix,
+	 (uint64_t) 2 << LIBEWF_CHUNK_CACHE_NAMESPACE_BIT_SHIFT );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_cache_get_new_namespace(
+	          NULL,
+	          &key_prefix,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_get_new_namespace(
+	          chunk_cache,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_cache_free(
+	          &chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_cache != NULL )
+	{
+		libewf_chunk_cache_free(
+		 &chunk_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Sets chunk data of a specific size in the chunk cache
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_chunk_cache_set_test_chunk_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     int priority,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+
+	if( libewf_chunk_data_initialize(
+	     &chunk_data,
+	     512,
+	     1,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	chunk_data->data_size = 512;
+
+	if( libewf_chunk_cache_set_chunk_data(
+	     chunk_cache,
+	     chunk_index,
+	     chunk_data,
+	     priority,
+	     error ) != 1 )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Tests the libewf_chunk_cache_evict_entry function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_cache_evict_entry(
+     void )
+{
+	uint8_t buffer[ 64 ];
+
+	libcerror_error_t *error          = NULL;
+	libewf_chunk_cache_t *chunk_cache = NULL;
+	size_t copy_size                  = 0;
+	int entry_index                   = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_chunk_cache_initialize(
+	          &chunk_cache,
+	          1,
+	          2,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_cache_evict_entry(
+	          chunk_cache,
+	          0,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &entry_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_chunk_cache_set_test_chunk_data(
+	          chunk_cache,
+	          1,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_chunk_cache_set_test_chunk_data(
+	          chunk_cache,
+	          2,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Reference chunk 1 so that chunk 2 is evicted first
+	 */
+	result = libewf_chunk_cache_copy_data(
+	          chunk_cache,
+	          1,
+	          0,
+	          buffer,
+	          64,
+	          &copy_size,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_chunk_cache_set_test_chunk_data(
+	          chunk_cache,
+	          3,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_copy_data(
+	          chunk_cache,
+	          2,
+	          0,
+	          buffer,
+	          64,
+	          &copy_size,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_copy_data(
+	          chunk_cache,
+	          1,
+	          0,
+	          buffer,
+	          64,
+	          &copy_size,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_copy_data(
+	          chunk_cache,
+	          3,
+	          0,
+	          buffer,
+	          64,
+	          &copy_size,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_cache_evict_entry(
+	          NULL,
+	          0,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &entry_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_evict_entry(
+	          chunk_cache,
+	          1,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &entry_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_evict_entry(
+	          chunk_cache,
+	          0,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_cache_free(
+	          &chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test with a maximum cache size that only fits a single chunk
+	 */
+	result = libewf_chunk_cache_initialize(
+	          &chunk_cache,
+	          1,
+	          4,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_chunk_cache_set_test_chunk_data(
+	          chunk_cache,
+	          1,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_chunk_cache_set_test_chunk_data(
+	          chunk_cache,
+	          2,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_copy_data(
+	          chunk_cache,
+	          1,
+	          0,
+	          buffer,
+	          64,
+	          &copy_size,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_copy_data(
+	          chunk_cache,
+	          2,
+	          0,
+	          buffer,
+	          64,
+	          &copy_size,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_cache_free(
+	          &chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_cache != NULL )
+	{
+		libewf_chunk_cache_free(
+		 &chunk_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_cache_set_chunk_data and libewf_chunk_cache_copy_data functions with the background priority
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_cache_background_priority(
+     void )
+{
+	uint8_t buffer[ 64 ];
+
+	libcerror_error_t *error          = NULL;
+	libewf_chunk_cache_t *chunk_cache = NULL;
+	size_t copy_size                  = 0;
+	int entry_index                   = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_chunk_cache_initialize(
+	          &chunk_cache,
+	          1,
+	          2,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * A background chunk only evicts the other background chunk
+	 */
+	result = ewf_test_chunk_cache_set_test_chunk_data(
+	          chunk_cache,
+	          1,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_chunk_cache_set_test_chunk_data(
+	          chunk_cache,
+	          2,
+	          LIBEWF_READ_PRIORITY_BACKGROUND,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_chunk_cache_set_test_chunk_data(
+	          chunk_cache,
+	          3,
+	          LIBEWF_READ_PRIORITY_BACKGROUND,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_copy_data(
+	          chunk_cache,
+	          2,
+	          0,
+	          buffer,
+	          64,
+	          &copy_size,
+	          LIBEWF_READ_PRIORITY_BACKGROUND,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_copy_data(
+	          chunk_cache,
+	          1,
+	          0,
+	          buffer,
+	          64,
+	          &copy_size,
+	          LIBEWF_READ_PRIORITY_BACKGROUND,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* An interactive read of a background chunk protects it from eviction by background chunks
+	 */
+	result = libewf_chunk_cache_copy_data(
+	          chunk_cache,
+	          3,
+	          0,
+	          buffer,
+	          64,
+	          &copy_size,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_evict_entry(
+	          chunk_cache,
+	          0,
+	          LIBEWF_READ_PRIORITY_BACKGROUND,
+	          &entry_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A background chunk that does not fit is not cached
+	 */
+	result = ewf_test_chunk_cache_set_test_chunk_data(
+	          chunk_cache,
+	          4,
+	          LIBEWF_READ_PRIORITY_BACKGROUND,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_copy_data(
+	          chunk_cache,
+	          4,
+	          0,
+	          buffer,
+	          64,
+	          &copy_size,
+	          LIBEWF_READ_PRIORITY_BACKGROUND,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_copy_data(
+	          chunk_cache,
+	          1,
+	          0,
+	          buffer,
+	          64,
+	          &copy_size,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_copy_data(
+	          chunk_cache,
+	          3,
+	          0,
+	          buffer,
+	          64,
+	          &copy_size,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = ewf_test_chunk_cache_set_test_chunk_data(
+	          chunk_cache,
+	          5,
+	          -1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_cache_free(
+	          &chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test with a maximum cache size that only fits a single chunk
+	 */
+	result = libewf_chunk_cache_initialize(
+	          &chunk_cache,
+	          1,
+	          4,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_chunk_cache_set_test_chunk_data(
+	          chunk_cache,
+	          1,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_chunk_cache_set_test_chunk_data(
+	          chunk_cache,
+	          2,
+	          LIBEWF_READ_PRIORITY_BACKGROUND,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_copy_data(
+	          chunk_cache,
+	          1,
+	          0,
+	          buffer,
+	          64,
+	          &copy_size,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_copy_data(
+	          chunk_cache,
+	          2,
+	          0,
+	          buffer,
+	          64,
+	          &copy_size,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_cache_free(
+	          &chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_cache != NULL )
+	{
+		libewf_chunk_cache_free(
+		 &chunk_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_cache_set_maximum_cache_size and libewf_chunk_cache_get_cache_size functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_cache_set_maximum_cache_size(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libewf_chunk_cache_t *chunk_cache = NULL;
+	size64_t cache_size               = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_chunk_cache_initialize(
+	          &chunk_cache,
+	          1,
+	          4,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_chunk_cache_set_test_chunk_data(
+	          chunk_cache,
+	          1,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_chunk_cache_set_test_chunk_data(
+	          chunk_cache,
+	          2,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_cache_get_cache_size(
+	          chunk_cache,
+	          &cache_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT64(
+	 "cache_size",
+	 (int64_t) cache_size,
+	 (int64_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A maximum cache size smaller than a single chunk evicts all entries
+	 */
+	result = libewf_chunk_cache_set_maximum_cache_size(
+	          chunk_cache,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_get_cache_size(
+	          chunk_cache,
+	          &cache_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "cache_size",
+	 (uint64_t) cache_size,
+	 (uint64_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_has_chunk_data(
+	          chunk_cache,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_cache_set_maximum_cache_size(
+	          NULL,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_get_cache_size(
+	          NULL,
+	          &cache_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_get_cache_size(
+	          chunk_cache,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_cache_free(
+	          &chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_cache != NULL )
+	{
+		libewf_chunk_cache_free(
+		 &chunk_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_cache_initialize",
+	 ewf_test_chunk_cache_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_cache_free",
+	 ewf_test_chunk_cache_free );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_cache_acquire",
+	 ewf_test_chunk_cache_acquire );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_cache_get_new_namespace",
+	 ewf_test_chunk_cache_get_new_namespace );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_cache_copy_data",
+	 ewf_test_chunk_cache_copy_data );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_cache_evict_entry",
+	 ewf_test_chunk_cache_evict_entry );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_cache_background_priority",
+	 ewf_test_chunk_cache_background_priority );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_cache_set_maximum_cache_size",
+	 ewf_test_chunk_cache_set_maximum_cache_size );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
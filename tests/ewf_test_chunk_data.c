@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -33,7 +34,10 @@
 #include "ewf_test_memory.h"
 #include "ewf_test_unused.h"
 
+#include "../libewf/libewf_checksum.h"
 #include "../libewf/libewf_chunk_data.h"
+#include "../libewf/libewf_definitions.h"
+#include "../libewf/libewf_io_handle.h"
 
 #if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
 
@@ -223,6 +227,1390 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_chunk_data_unpack function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_unpack(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libewf_chunk_data_t *chunk_data = NULL;
+	libewf_io_handle_t *io_handle   = NULL;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_initialize(
+	          &chunk_data,
+	          4096,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_data_unpack(
+	          NULL,
+	          io_handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_data_unpack(
+	          chunk_data,
+	          NULL,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test unpack with encrypted chunk data
+	 */
+	chunk_data->data_size   = 4096;
+	chunk_data->range_flags = LIBEWF_RANGE_FLAG_IS_PACKED | LIBEWF_RANGE_FLAG_IS_ENCRYPTED;
+
+	result = libewf_chunk_data_unpack(
+	          chunk_data,
+	          io_handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_data_free(
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_data_get_unpack_error function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_get_unpack_error(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libcerror_error_t *unpack_error = NULL;
+	libewf_chunk_data_t *chunk_data = NULL;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_chunk_data_initialize(
+	          &chunk_data,
+	          4096,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_data_get_unpack_error(
+	          chunk_data,
+	          &unpack_error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "unpack_error",
+	 unpack_error );
+
+	chunk_data->unpack_status       = LIBEWF_CHUNK_DATA_UNPACK_STATUS_CHECKSUM_MISMATCH;
+	chunk_data->checksum            = 0x12345678UL;
+	chunk_data->calculated_checksum = 0x9abcdef0UL;
+
+	result = libewf_chunk_data_get_unpack_error(
+	          chunk_data,
+	          &unpack_error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "unpack_error",
+	 unpack_error );
+
+	result = libcerror_error_matches(
+	          unpack_error,
+	          LIBCERROR_ERROR_DOMAIN_INPUT,
+	          LIBCERROR_INPUT_ERROR_CHECKSUM_MISMATCH );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	libcerror_error_free(
+	 &unpack_error );
+
+	chunk_data->unpack_status = LIBEWF_CHUNK_DATA_UNPACK_STATUS_DECOMPRESS_FAILED;
+
+	result = libewf_chunk_data_get_unpack_error(
+	          chunk_data,
+	          &unpack_error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "unpack_error",
+	 unpack_error );
+
+	result = libcerror_error_matches(
+	          unpack_error,
+	          LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+	          LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	libcerror_error_free(
+	 &unpack_error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_data_get_unpack_error(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_data_get_unpack_error(
+	          chunk_data,
+	          NULL );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_data_free(
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( unpack_error != NULL )
+	{
+		libcerror_error_free(
+		 &unpack_error );
+	}
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_data_check_for_empty_block function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_check_for_empty_block(
+     void )
+{
+	uint8_t data[ 4096 + 1 ];
+
+	libcerror_error_t *error = NULL;
+	size_t data_offset       = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	for( data_offset = 0;
+	     data_offset < 4096 + 1;
+	     data_offset++ )
+	{
+		data[ data_offset ] = 0xa5;
+	}
+	/* Test regular cases
+	 */
+	result = libewf_chunk_data_check_for_empty_block(
+	          data,
+	          4096,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test unaligned data
+	 */
+	result = libewf_chunk_data_check_for_empty_block(
+	          &( data[ 1 ] ),
+	          4096,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test data that differs at the start, inside a block and at the end
+	 */
+	for( data_offset = 1;
+	     data_offset < 4096;
+	     data_offset += 1365 )
+	{
+		data[ data_offset ] = 0x5a;
+
+		result = libewf_chunk_data_check_for_empty_block(
+		          data,
+		          4096,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		data[ data_offset ] = 0xa5;
+	}
+	data[ 4095 ] = 0x5a;
+
+	result = libewf_chunk_data_check_for_empty_block(
+	          data,
+	          4096,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data[ 4095 ] = 0xa5;
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_data_check_for_empty_block(
+	          NULL,
+	          4096,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_data_check_for_empty_block(
+	          data,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_data_check_for_64_bit_pattern_fill function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_check_for_64_bit_pattern_fill(
+     void )
+{
+	uint8_t data[ 4096 + 1 ];
+
+	libcerror_error_t *error = NULL;
+	size_t data_offset       = 0;
+	uint64_t pattern         = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	for( data_offset = 0;
+	     data_offset < 4096 + 1;
+	     data_offset++ )
+	{
+		data[ data_offset ] = (uint8_t) ( data_offset % 8 );
+	}
+	/* Test regular cases
+	 */
+	result = libewf_chunk_data_check_for_64_bit_pattern_fill(
+	          data,
+	          4096,
+	          &pattern,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "pattern",
+	 pattern,
+	 (uint64_t) 0x0706050403020100ULL );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test unaligned data
+	 */
+	result = libewf_chunk_data_check_for_64_bit_pattern_fill(
+	          &( data[ 1 ] ),
+	          4096,
+	          &pattern,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "pattern",
+	 pattern,
+	 (uint64_t) 0x0007060504030201ULL );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test data that differs inside a block and at the end
+	 */
+	data[ 1000 ] = 0xff;
+
+	result = libewf_chunk_data_check_for_64_bit_pattern_fill(
+	          data,
+	          4096,
+	          &pattern,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data[ 1000 ] = (uint8_t) ( 1000 % 8 );
+	data[ 4095 ] = 0xff;
+
+	result = libewf_chunk_data_check_for_64_bit_pattern_fill(
+	          data,
+	          4096,
+	          &pattern,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data[ 4095 ] = (uint8_t) ( 4095 % 8 );
+
+	/* Test data size that is not a multiple of 8
+	 */
+	result = libewf_chunk_data_check_for_64_bit_pattern_fill(
+	          data,
+	          4095,
+	          &pattern,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_data_check_for_64_bit_pattern_fill(
+	          NULL,
+	          4096,
+	          &pattern,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_data_check_for_64_bit_pattern_fill(
+	          data,
+	          (size_t) SSIZE_MAX + 1,
+	          &pattern,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_data_check_for_64_bit_pattern_fill(
+	          data,
+	          4096,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_data_check_for_64_bit_pattern_fill_with_checksum function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_check_for_64_bit_pattern_fill_with_checksum(
+     void )
+{
+	uint8_t data[ ( 3 * LIBEWF_CHUNK_DATA_FUSED_BLOCK_SIZE ) + 16 ];
+
+	libcerror_error_t *error   = NULL;
+	size_t data_offset         = 0;
+	size_t data_size           = 0;
+	uint64_t pattern           = 0;
+	uint32_t checksum          = 0;
+	uint32_t expected_checksum = 0;
+	int result                 = 0;
+
+	/* Initialize test
+	 */
+	data_size = ( 3 * LIBEWF_CHUNK_DATA_FUSED_BLOCK_SIZE ) + 16;
+
+	for( data_offset = 0;
+	     data_offset < data_size;
+	     data_offset++ )
+	{
+		data[ data_offset ] = (uint8_t) ( data_offset % 8 );
+	}
+	/* Test regular cases
+	 */
+	result = libewf_chunk_data_check_for_64_bit_pattern_fill_with_checksum(
+	          data,
+	          data_size,
+	          &pattern,
+	          &checksum,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "pattern",
+	 pattern,
+	 (uint64_t) 0x0706050403020100ULL );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test data that differs in the first, a subsequent and the last block
+	 */
+	data[ 100 ] = 0xff;
+
+	result = libewf_checksum_calculate_adler32(
+	          &expected_checksum,
+	          data,
+	          data_size,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_chunk_data_check_for_64_bit_pattern_fill_with_checksum(
+	          data,
+	          data_size,
+	          &pattern,
+	          &checksum,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "checksum",
+	 checksum,
+	 expected_checksum );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data[ 100 ] = (uint8_t) ( 100 % 8 );
+
+	data[ LIBEWF_CHUNK_DATA_FUSED_BLOCK_SIZE + 4 ] = 0xff;
+
+	result = libewf_checksum_calculate_adler32(
+	          &expected_checksum,
+	          data,
+	          data_size,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_chunk_data_check_for_64_bit_pattern_fill_with_checksum(
+	          data,
+	          data_size,
+	          &pattern,
+	          &checksum,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "checksum",
+	 checksum,
+	 expected_checksum );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data[ LIBEWF_CHUNK_DATA_FUSED_BLOCK_SIZE + 4 ] = (uint8_t) ( ( LIBEWF_CHUNK_DATA_FUSED_BLOCK_SIZE + 4 ) % 8 );
+
+	data[ data_size - 1 ] = 0xff;
+
+	result = libewf_checksum_calculate_adler32(
+	          &expected_checksum,
+	          data,
+	          data_size,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_chunk_data_check_for_64_bit_pattern_fill_with_checksum(
+	          data,
+	          data_size,
+	          &pattern,
+	          &checksum,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "checksum",
+	 checksum,
+	 expected_checksum );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data[ data_size - 1 ] = (uint8_t) ( ( data_size - 1 ) % 8 );
+
+	/* Test data size that is not a multiple of 8
+	 */
+	result = libewf_checksum_calculate_adler32(
+	          &expected_checksum,
+	          data,
+	          data_size - 1,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_chunk_data_check_for_64_bit_pattern_fill_with_checksum(
+	          data,
+	          data_size - 1,
+	          &pattern,
+	          &checksum,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "checksum",
+	 checksum,
+	 expected_checksum );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_data_check_for_64_bit_pattern_fill_with_checksum(
+	          NULL,
+	          data_size,
+	          &pattern,
+	          &checksum,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_data_check_for_64_bit_pattern_fill_with_checksum(
+	          data,
+	          (size_t) SSIZE_MAX + 1,
+	          &pattern,
+	          &checksum,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_data_check_for_64_bit_pattern_fill_with_checksum(
+	          data,
+	          data_size,
+	          NULL,
+	          &checksum,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_data_check_for_64_bit_pattern_fill_with_checksum(
+	          data,
+	          data_size,
+	          &pattern,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_data_fill_with_64_bit_pattern function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_fill_with_64_bit_pattern(
+     void )
+{
+	uint8_t data[ 4096 + 5 ];
+	uint8_t pattern[ 8 ] = {
+		0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07 };
+
+	libcerror_error_t *error = NULL;
+	size_t data_offset       = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_data_fill_with_64_bit_pattern(
+	          data,
+	          4096 + 5,
+	          pattern,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( data_offset = 0;
+	     data_offset < 4096 + 5;
+	     data_offset++ )
+	{
+		EWF_TEST_ASSERT_EQUAL_UINT8(
+		 "data[ data_offset ]",
+		 data[ data_offset ],
+		 (uint8_t) ( data_offset % 8 ) );
+	}
+	/* Test error cases
+	 */
+	result = libewf_chunk_data_fill_with_64_bit_pattern(
+	          NULL,
+	          4096,
+	          pattern,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_data_fill_with_64_bit_pattern(
+	          data,
+	          (size_t) SSIZE_MAX + 1,
+	          pattern,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_data_fill_with_64_bit_pattern(
+	          data,
+	          4096,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_data_check_for_incompressible_data function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_check_for_incompressible_data(
+     void )
+{
+	uint8_t data[ 32768 ];
+
+	libcerror_error_t *error = NULL;
+	uint32_t random_value    = 0x12345678UL;
+	size_t data_offset       = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	for( data_offset = 0;
+	     data_offset < 32768;
+	     data_offset++ )
+	{
+		random_value ^= random_value << 13;
+		random_value ^= random_value >> 17;
+		random_value ^= random_value << 5;
+
+		data[ data_offset ] = (uint8_t) ( random_value >> 24 );
+	}
+	/* Test regular cases
+	 */
+	result = libewf_chunk_data_check_for_incompressible_data(
+	          data,
+	          32768,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test data that is too small to estimate
+	 */
+	result = libewf_chunk_data_check_for_incompressible_data(
+	          data,
+	          64,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( data_offset = 0;
+	     data_offset < 32768;
+	     data_offset++ )
+	{
+		data[ data_offset ] = (uint8_t) ( 'a' + ( data_offset % 13 ) );
+	}
+	result = libewf_chunk_data_check_for_incompressible_data(
+	          data,
+	          32768,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_data_check_for_incompressible_data(
+	          NULL,
+	          32768,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_data_check_for_incompressible_data(
+	          data,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_data_write_to_buffer function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_write_to_buffer(
+     void )
+{
+	uint8_t buffer[ 1024 ];
+
+	libcerror_error_t *error        = NULL;
+	libewf_chunk_data_t *chunk_data = NULL;
+	size_t data_offset              = 0;
+	ssize_t write_count             = 0;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_chunk_data_initialize(
+	          &chunk_data,
+	          512,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( data_offset = 0;
+	     data_offset < 512;
+	     data_offset++ )
+	{
+		chunk_data->data[ data_offset ] = (uint8_t) data_offset;
+	}
+	chunk_data->data_size      = 512;
+	chunk_data->padding_size   = 0;
+	chunk_data->range_flags    = LIBEWF_RANGE_FLAG_HAS_CHECKSUM;
+	chunk_data->chunk_io_flags = LIBEWF_CHUNK_IO_FLAG_CHECKSUM_SET;
+	chunk_data->checksum       = 0x11223344UL;
+
+	/* Test regular cases
+	 */
+	write_count = libewf_chunk_data_write_to_buffer(
+	               chunk_data,
+	               buffer,
+	               1024,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) 516 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          chunk_data->data,
+	          512 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 512 ]",
+	 buffer[ 512 ],
+	 (uint8_t) 0x44 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 515 ]",
+	 buffer[ 515 ],
+	 (uint8_t) 0x11 );
+
+	/* Test error cases
+	 */
+	write_count = libewf_chunk_data_write_to_buffer(
+	               NULL,
+	               buffer,
+	               1024,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	write_count = libewf_chunk_data_write_to_buffer(
+	               chunk_data,
+	               NULL,
+	               1024,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	write_count = libewf_chunk_data_write_to_buffer(
+	               chunk_data,
+	               buffer,
+	               (size_t) SSIZE_MAX + 1,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test with a buffer that is too small for the checksum
+	 */
+	write_count = libewf_chunk_data_write_to_buffer(
+	               chunk_data,
+	               buffer,
+	               514,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_data_free(
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
 
 /* The main program
@@ -244,10 +1632,14 @@ int main(
 
 	/* TODO: add tests for libewf_chunk_data_initialize */
 
+	/* TODO: add tests for libewf_chunk_data_initialize_with_buffer_pool */
+
 	EWF_TEST_RUN(
 	 "libewf_chunk_data_free",
 	 ewf_test_chunk_data_free );
 
+	/* TODO: add tests for libewf_chunk_data_free_buffer */
+
 	EWF_TEST_RUN(
 	 "libewf_chunk_data_clone",
 	 ewf_test_chunk_data_clone );
@@ -258,14 +1650,46 @@ int main(
 
 	/* TODO: add tests for libewf_chunk_data_pack */
 
-	/* TODO: add tests for libewf_chunk_data_unpack */
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_unpack",
+	 ewf_test_chunk_data_unpack );
+
+	/* TODO: add tests for libewf_chunk_data_unpack_compressed */
+
+	/* TODO: add tests for libewf_chunk_data_unpack_with_checksum */
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_get_unpack_error",
+	 ewf_test_chunk_data_get_unpack_error );
+
+	/* TODO: add tests for libewf_chunk_data_unpack_to_buffer */
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_check_for_empty_block",
+	 ewf_test_chunk_data_check_for_empty_block );
 
-	/* TODO: add tests for libewf_chunk_data_check_for_empty_block */
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_check_for_64_bit_pattern_fill",
+	 ewf_test_chunk_data_check_for_64_bit_pattern_fill );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_check_for_64_bit_pattern_fill_with_checksum",
+	 ewf_test_chunk_data_check_for_64_bit_pattern_fill_with_checksum );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_fill_with_64_bit_pattern",
+	 ewf_test_chunk_data_fill_with_64_bit_pattern );
 
-	/* TODO: add tests for libewf_chunk_data_check_for_64_bit_pattern_fill */
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_check_for_incompressible_data",
+	 ewf_test_chunk_data_check_for_incompressible_data );
 
 	/* TODO: add tests for libewf_chunk_data_write */
 
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_write_to_buffer",
+	 ewf_test_chunk_data_write_to_buffer );
+
 	/* TODO: add tests for libewf_chunk_data_get_write_size */
 
 	/* TODO: add tests for libewf_chunk_data_get_checksum */
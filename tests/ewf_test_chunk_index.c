@@ -0,0 +1,765 @@
+/*
+ * Library chunk_index type test program
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_chunk_group.h"
+#include "../libewf/libewf_chunk_index.h"
+#include "../libewf/libewf_definitions.h"
+#include "../libewf/libewf_io_handle.h"
+#include "../libewf/libewf_section_descriptor.h"
+
+/* EWF version 1 table entries of 3 chunks at offset 0x100, 0x200 and 0x280
+ * of which the second chunk is compressed
+ */
+uint8_t ewf_test_chunk_index_table_entries_data[ 12 ] = {
+	0x00, 0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x80, 0x80, 0x02, 0x00, 0x00 };
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Tests the libewf_chunk_index_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_index_initialize(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libewf_chunk_index_t *chunk_index = NULL;
+	int result                        = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests   = 1;
+	int number_of_memset_fail_tests   = 1;
+	int test_number                   = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_index_initialize(
+	          &chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_index",
+	 chunk_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_index_free(
+	          &chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_index",
+	 chunk_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_index_initialize(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	chunk_index = (libewf_chunk_index_t *) 0x12345678UL;
+
+	result = libewf_chunk_index_initialize(
+	          &chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	chunk_index = NULL;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_chunk_index_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_chunk_index_initialize(
+		          &chunk_index,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( chunk_index != NULL )
+			{
+				libewf_chunk_index_free(
+				 &chunk_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "chunk_index",
+			 chunk_index );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_chunk_index_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_chunk_index_initialize(
+		          &chunk_index,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( chunk_index != NULL )
+			{
+				libewf_chunk_index_free(
+				 &chunk_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "chunk_index",
+			 chunk_index );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_index != NULL )
+	{
+		libewf_chunk_index_free(
+		 &chunk_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_index_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_index_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_index_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_index_set_chunk_group and libewf_chunk_index_get_entry functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_index_set_chunk_group(
+     void )
+{
+	libcerror_error_t *error                   = NULL;
+	libewf_chunk_group_t *chunk_group          = NULL;
+	libewf_chunk_index_t *chunk_index          = NULL;
+	libewf_io_handle_t *io_handle              = NULL;
+	libewf_section_descriptor_t *table_section = NULL;
+	size64_t range_size                        = 0;
+	off64_t range_offset                       = 0;
+	uint32_t range_flags                       = 0;
+	uint32_t segment_number                    = 0;
+	int file_io_pool_entry                     = 0;
+	int group_index                            = 0;
+	int result                                 = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_section_descriptor_initialize(
+	          &table_section,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	table_section->start_offset = 0x300;
+	table_section->end_offset   = 0x400;
+
+	result = libewf_chunk_group_initialize(
+	          &chunk_group,
+	          io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The last chunk ends at the start of the table section
+	 */
+	result = libewf_chunk_group_fill_v1(
+	          chunk_group,
+	          10,
+	          32768,
+	          2,
+	          table_section,
+	          0,
+	          3,
+	          ewf_test_chunk_index_table_entries_data,
+	          12,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_index_initialize(
+	          &chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_index_set_chunk_group(
+	          chunk_index,
+	          10,
+	          1,
+	          chunk_group,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_index_set_chunk_group(
+	          chunk_index,
+	          10,
+	          1,
+	          chunk_group,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_index_get_group_index(
+	          chunk_index,
+	          12,
+	          &group_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "group_index",
+	 group_index,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_index_get_entry(
+	          chunk_index,
+	          11,
+	          &segment_number,
+	          &file_io_pool_entry,
+	          &range_offset,
+	          &range_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "segment_number",
+	 segment_number,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "file_io_pool_entry",
+	 file_io_pool_entry,
+	 2 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "range_offset",
+	 (int64_t) range_offset,
+	 (int64_t) 0x200 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 0x80 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "range_flags",
+	 range_flags,
+	 (uint32_t) LIBEWF_RANGE_FLAG_IS_COMPRESSED );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_index_get_entry(
+	          chunk_index,
+	          12,
+	          &segment_number,
+	          &file_io_pool_entry,
+	          &range_offset,
+	          &range_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "range_offset",
+	 (int64_t) range_offset,
+	 (int64_t) 0x280 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 0x80 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "range_flags",
+	 range_flags,
+	 (uint32_t) LIBEWF_RANGE_FLAG_HAS_CHECKSUM );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_index_get_entry(
+	          chunk_index,
+	          9,
+	          &segment_number,
+	          &file_io_pool_entry,
+	          &range_offset,
+	          &range_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_index_get_entry(
+	          chunk_index,
+	          13,
+	          &segment_number,
+	          &file_io_pool_entry,
+	          &range_offset,
+	          &range_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_index_set_chunk_group(
+	          NULL,
+	          10,
+	          1,
+	          chunk_group,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_index_set_chunk_group(
+	          chunk_index,
+	          10,
+	          1,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_index_get_entry(
+	          NULL,
+	          11,
+	          &segment_number,
+	          &file_io_pool_entry,
+	          &range_offset,
+	          &range_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_index_get_entry(
+	          chunk_index,
+	          11,
+	          &segment_number,
+	          &file_io_pool_entry,
+	          NULL,
+	          &range_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_index_free(
+	          &chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_group_free(
+	          &chunk_group,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_section_descriptor_free(
+	          &table_section,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_index != NULL )
+	{
+		libewf_chunk_index_free(
+		 &chunk_index,
+		 NULL );
+	}
+	if( chunk_group != NULL )
+	{
+		libewf_chunk_group_free(
+		 &chunk_group,
+		 NULL );
+	}
+	if( table_section != NULL )
+	{
+		libewf_section_descriptor_free(
+		 &table_section,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_index_initialize",
+	 ewf_test_chunk_index_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_index_free",
+	 ewf_test_chunk_index_free );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_index_set_chunk_group",
+	 ewf_test_chunk_index_set_chunk_group );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
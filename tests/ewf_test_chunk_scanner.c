@@ -0,0 +1,606 @@
+/*
+ * Library chunk_scanner type test program
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_checksum.h"
+#include "../libewf/libewf_chunk_scanner.h"
+#include "../libewf/libewf_definitions.h"
+
+/* Zlib compressed chunk of 512 bytes of 0-byte values
+ */
+uint8_t ewf_test_chunk_scanner_compressed_chunk[ 14 ] = {
+	0x78, 0xda, 0x63, 0x60, 0x18, 0x05, 0x23, 0x19, 0x00, 0x00, 0x02, 0x00, 0x00, 0x01 };
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Tests the libewf_chunk_scanner_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_scanner_initialize(
+     void )
+{
+	libcerror_error_t *error              = NULL;
+	libewf_chunk_scanner_t *chunk_scanner = NULL;
+	int result                            = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests       = 3;
+	int number_of_memset_fail_tests       = 1;
+	int test_number                       = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_scanner_initialize(
+	          &chunk_scanner,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_scanner",
+	 chunk_scanner );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_scanner_free(
+	          &chunk_scanner,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_scanner",
+	 chunk_scanner );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_scanner_initialize(
+	          NULL,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	chunk_scanner = (libewf_chunk_scanner_t *) 0x12345678UL;
+
+	result = libewf_chunk_scanner_initialize(
+	          &chunk_scanner,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	chunk_scanner = NULL;
+
+	result = libewf_chunk_scanner_initialize(
+	          &chunk_scanner,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_chunk_scanner_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_chunk_scanner_initialize(
+		          &chunk_scanner,
+		          512,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( chunk_scanner != NULL )
+			{
+				libewf_chunk_scanner_free(
+				 &chunk_scanner,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "chunk_scanner",
+			 chunk_scanner );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_chunk_scanner_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_chunk_scanner_initialize(
+		          &chunk_scanner,
+		          512,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( chunk_scanner != NULL )
+			{
+				libewf_chunk_scanner_free(
+				 &chunk_scanner,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "chunk_scanner",
+			 chunk_scanner );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_scanner != NULL )
+	{
+		libewf_chunk_scanner_free(
+		 &chunk_scanner,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_scanner_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_scanner_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_scanner_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_scanner_check_chunk function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_scanner_check_chunk(
+     void )
+{
+	uint8_t data[ 1024 ];
+
+	libcerror_error_t *error              = NULL;
+	libewf_chunk_scanner_t *chunk_scanner = NULL;
+	size_t chunk_data_size                = 0;
+	uint32_t checksum                     = 0;
+	uint32_t range_flags                  = 0;
+	int result                            = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_chunk_scanner_initialize(
+	          &chunk_scanner,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_scanner",
+	 chunk_scanner );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_scanner_check_chunk(
+	          chunk_scanner,
+	          ewf_test_chunk_scanner_compressed_chunk,
+	          14,
+	          0,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "chunk_data_size",
+	 chunk_data_size,
+	 (size_t) 14 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "range_flags",
+	 range_flags,
+	 (uint32_t) LIBEWF_RANGE_FLAG_IS_COMPRESSED );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test an uncompressed chunk followed by its checksum
+	 */
+	memory_set(
+	 data,
+	 'A',
+	 1024 );
+
+	result = libewf_checksum_calculate_adler32(
+	          &checksum,
+	          data,
+	          512,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ 512 ] ),
+	 checksum );
+
+	result = libewf_chunk_scanner_check_chunk(
+	          chunk_scanner,
+	          data,
+	          1024,
+	          0,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "chunk_data_size",
+	 chunk_data_size,
+	 (size_t) 516 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "range_flags",
+	 range_flags,
+	 (uint32_t) LIBEWF_RANGE_FLAG_HAS_CHECKSUM );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test data that does not start with a chunk
+	 */
+	data[ 512 ] ^= 0xff;
+
+	result = libewf_chunk_scanner_check_chunk(
+	          chunk_scanner,
+	          data,
+	          1024,
+	          0,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_scanner_check_chunk(
+	          NULL,
+	          data,
+	          1024,
+	          0,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_scanner_check_chunk(
+	          chunk_scanner,
+	          NULL,
+	          1024,
+	          0,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_scanner_check_chunk(
+	          chunk_scanner,
+	          data,
+	          1024,
+	          0,
+	          NULL,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_scanner_check_chunk(
+	          chunk_scanner,
+	          data,
+	          1024,
+	          0,
+	          &chunk_data_size,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_scanner_free(
+	          &chunk_scanner,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_scanner",
+	 chunk_scanner );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_scanner != NULL )
+	{
+		libewf_chunk_scanner_free(
+		 &chunk_scanner,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_scanner_initialize",
+	 ewf_test_chunk_scanner_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_scanner_free",
+	 ewf_test_chunk_scanner_free );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_scanner_check_chunk",
+	 ewf_test_chunk_scanner_check_chunk );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
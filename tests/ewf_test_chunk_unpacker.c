@@ -0,0 +1,784 @@
+/*
+ * Library chunk_unpacker type test program
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_chunk_data.h"
+#include "../libewf/libewf_chunk_unpacker.h"
+#include "../libewf/libewf_definitions.h"
+#include "../libewf/libewf_io_handle.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Tests the libewf_chunk_unpacker_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_unpacker_initialize(
+     void )
+{
+	libcerror_error_t *error                = NULL;
+	libewf_chunk_unpacker_t *chunk_unpacker = NULL;
+	libewf_io_handle_t *io_handle           = NULL;
+	int result                              = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests         = 1;
+	int number_of_memset_fail_tests         = 1;
+	int test_number                         = 0;
+#endif
+
+	/* Initialize test
+	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_unpacker_initialize(
+	          &chunk_unpacker,
+	          io_handle,
+	          2,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_unpacker",
+	 chunk_unpacker );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_unpacker_free(
+	          &chunk_unpacker,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_unpacker",
+	 chunk_unpacker );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_unpacker_initialize(
+	          NULL,
+	          io_handle,
+	          2,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	chunk_unpacker = (libewf_chunk_unpacker_t *) 0x12345678UL;
+
+	result = libewf_chunk_unpacker_initialize(
+	          &chunk_unpacker,
+	          io_handle,
+	          2,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	chunk_unpacker = NULL;
+
+	result = libewf_chunk_unpacker_initialize(
+	          &chunk_unpacker,
+	          NULL,
+	          2,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_unpacker_initialize(
+	          &chunk_unpacker,
+	          io_handle,
+	          0,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_unpacker_initialize(
+	          &chunk_unpacker,
+	          io_handle,
+	          LIBEWF_MAXIMUM_NUMBER_OF_THREADS + 1,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_chunk_unpacker_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_chunk_unpacker_initialize(
+		          &chunk_unpacker,
+		          io_handle,
+		          2,
+		          NULL,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( chunk_unpacker != NULL )
+			{
+				libewf_chunk_unpacker_free(
+				 &chunk_unpacker,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "chunk_unpacker",
+			 chunk_unpacker );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_chunk_unpacker_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_chunk_unpacker_initialize(
+		          &chunk_unpacker,
+		          io_handle,
+		          2,
+		          NULL,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( chunk_unpacker != NULL )
+			{
+				libewf_chunk_unpacker_free(
+				 &chunk_unpacker,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "chunk_unpacker",
+			 chunk_unpacker );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	/* Clean up
+	 */
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_unpacker != NULL )
+	{
+		libewf_chunk_unpacker_free(
+		 &chunk_unpacker,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_unpacker_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_unpacker_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_unpacker_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_unpacker_unpack function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_unpacker_unpack(
+     void )
+{
+	libewf_chunk_data_t *chunk_data[ 4 ];
+
+	libcerror_error_t *error                = NULL;
+	libewf_chunk_unpacker_t *chunk_unpacker = NULL;
+	libewf_io_handle_t *io_handle           = NULL;
+	size_t data_offset                      = 0;
+	int chunk_data_index                    = 0;
+	int result                              = 0;
+
+	for( chunk_data_index = 0;
+	     chunk_data_index < 4;
+	     chunk_data_index++ )
+	{
+		chunk_data[ chunk_data_index ] = NULL;
+	}
+	/* Initialize test
+	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_unpacker_initialize(
+	          &chunk_unpacker,
+	          io_handle,
+	          2,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_unpacker",
+	 chunk_unpacker );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The last entry is left empty to test that it is skipped
+	 */
+	for( chunk_data_index = 0;
+	     chunk_data_index < 3;
+	     chunk_data_index++ )
+	{
+		result = libewf_chunk_data_initialize(
+		          &( chunk_data[ chunk_data_index ] ),
+		          512,
+		          1,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "chunk_data",
+		 chunk_data[ chunk_data_index ] );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		for( data_offset = 0;
+		     data_offset < 512;
+		     data_offset++ )
+		{
+			chunk_data[ chunk_data_index ]->data[ data_offset ] = (uint8_t) ( ( data_offset + chunk_data_index ) % 251 );
+		}
+		chunk_data[ chunk_data_index ]->data_size = 512;
+
+		result = libewf_chunk_data_pack(
+		          chunk_data[ chunk_data_index ],
+		          io_handle,
+		          NULL,
+		          NULL,
+		          0,
+		          LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test regular cases
+	 */
+	result = libewf_chunk_unpacker_unpack(
+	          chunk_unpacker,
+	          chunk_data,
+	          4,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( chunk_data_index = 0;
+	     chunk_data_index < 3;
+	     chunk_data_index++ )
+	{
+		result = (int) ( chunk_data[ chunk_data_index ]->range_flags & ( LIBEWF_RANGE_FLAG_IS_PACKED | LIBEWF_RANGE_FLAG_IS_CORRUPTED ) );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		EWF_TEST_ASSERT_EQUAL_SIZE(
+		 "chunk_data->data_size",
+		 chunk_data[ chunk_data_index ]->data_size,
+		 (size_t) 512 );
+
+		EWF_TEST_ASSERT_EQUAL_UINT8(
+		 "chunk_data->data[ 100 ]",
+		 chunk_data[ chunk_data_index ]->data[ 100 ],
+		 (uint8_t) ( 100 + chunk_data_index ) );
+	}
+	/* Test unpacking chunk data that is no longer packed
+	 */
+	result = libewf_chunk_unpacker_unpack(
+	          chunk_unpacker,
+	          chunk_data,
+	          3,
+	          LIBEWF_READ_PRIORITY_BACKGROUND,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_unpacker_unpack(
+	          NULL,
+	          chunk_data,
+	          3,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_unpacker_unpack(
+	          chunk_unpacker,
+	          NULL,
+	          3,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_unpacker_unpack(
+	          chunk_unpacker,
+	          chunk_data,
+	          -1,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_unpacker_unpack(
+	          chunk_unpacker,
+	          chunk_data,
+	          chunk_unpacker->maximum_number_of_chunks + 1,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_unpacker_unpack(
+	          chunk_unpacker,
+	          chunk_data,
+	          3,
+	          -1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	for( chunk_data_index = 0;
+	     chunk_data_index < 3;
+	     chunk_data_index++ )
+	{
+		result = libewf_chunk_data_free(
+		          &( chunk_data[ chunk_data_index ] ),
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libewf_chunk_unpacker_free(
+	          &chunk_unpacker,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_unpacker",
+	 chunk_unpacker );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	for( chunk_data_index = 0;
+	     chunk_data_index < 4;
+	     chunk_data_index++ )
+	{
+		if( chunk_data[ chunk_data_index ] != NULL )
+		{
+			libewf_chunk_data_free(
+			 &( chunk_data[ chunk_data_index ] ),
+			 NULL );
+		}
+	}
+	if( chunk_unpacker != NULL )
+	{
+		libewf_chunk_unpacker_free(
+		 &chunk_unpacker,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_unpacker_initialize",
+	 ewf_test_chunk_unpacker_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_unpacker_free",
+	 ewf_test_chunk_unpacker_free );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_unpacker_unpack",
+	 ewf_test_chunk_unpacker_unpack );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
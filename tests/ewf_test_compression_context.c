@@ -0,0 +1,1145 @@
+/*
+ * Library compression_context type test program
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+#include <zlib.h>
+#endif
+
+#if defined( HAVE_ZSTD )
+#include <zstd.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_compression_context.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Tests the libewf_compression_context_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_compression_context_initialize(
+     void )
+{
+	libcerror_error_t *error                          = NULL;
+	libewf_compression_context_t *compression_context = NULL;
+	int result                                        = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests                   = 1;
+	int number_of_memset_fail_tests                   = 1;
+	int test_number                                   = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_compression_context_initialize(
+	          &compression_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compression_context",
+	 compression_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_compression_context_free(
+	          &compression_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "compression_context",
+	 compression_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_compression_context_initialize(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	compression_context = (libewf_compression_context_t *) 0x12345678UL;
+
+	result = libewf_compression_context_initialize(
+	          &compression_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	compression_context = NULL;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_compression_context_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_compression_context_initialize(
+		          &compression_context,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( compression_context != NULL )
+			{
+				libewf_compression_context_free(
+				 &compression_context,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "compression_context",
+			 compression_context );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_compression_context_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_compression_context_initialize(
+		          &compression_context,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( compression_context != NULL )
+			{
+				libewf_compression_context_free(
+				 &compression_context,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "compression_context",
+			 compression_context );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( compression_context != NULL )
+	{
+		libewf_compression_context_free(
+		 &compression_context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_compression_context_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_compression_context_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_compression_context_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_compression_context_get_packed_fill and libewf_compression_context_set_packed_fill functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_compression_context_packed_fill(
+     void )
+{
+	uint8_t compressed_data[ 16 ];
+	uint8_t packed_data[ 16 ];
+
+	libcerror_error_t *error                          = NULL;
+	libewf_compression_context_t *compression_context = NULL;
+	size_t compressed_data_size                       = 0;
+	uint32_t checksum                                 = 0;
+	uint64_t fill_pattern                             = 0;
+	int result                                        = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_compression_context_initialize(
+	          &compression_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compression_context",
+	 compression_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ( memory_set(
+	            packed_data,
+	            0x5a,
+	            16 ) != NULL );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test regular cases
+	 */
+	compressed_data_size = 16;
+
+	result = libewf_compression_context_get_packed_fill(
+	          compression_context,
+	          0,
+	          32768,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          LIBEWF_COMPRESSION_DEFAULT,
+	          compressed_data,
+	          &compressed_data_size,
+	          &checksum,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Set more packed fills than retained such that the first one is replaced
+	 */
+	for( fill_pattern = 0;
+	     fill_pattern <= LIBEWF_COMPRESSION_CONTEXT_NUMBER_OF_PACKED_FILLS;
+	     fill_pattern++ )
+	{
+		result = libewf_compression_context_set_packed_fill(
+		          compression_context,
+		          fill_pattern,
+		          32768,
+		          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+		          LIBEWF_COMPRESSION_DEFAULT,
+		          packed_data,
+		          12,
+		          0x12345678UL,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	compressed_data_size = 16;
+
+	result = libewf_compression_context_get_packed_fill(
+	          compression_context,
+	          LIBEWF_COMPRESSION_CONTEXT_NUMBER_OF_PACKED_FILLS,
+	          32768,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          LIBEWF_COMPRESSION_DEFAULT,
+	          compressed_data,
+	          &compressed_data_size,
+	          &checksum,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "compressed_data_size",
+	 compressed_data_size,
+	 (size_t) 12 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "checksum",
+	 checksum,
+	 (uint32_t) 0x12345678UL );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          compressed_data,
+	          packed_data,
+	          12 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* The least recently used packed fill was replaced
+	 */
+	compressed_data_size = 16;
+
+	result = libewf_compression_context_get_packed_fill(
+	          compression_context,
+	          0,
+	          32768,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          LIBEWF_COMPRESSION_DEFAULT,
+	          compressed_data,
+	          &compressed_data_size,
+	          &checksum,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A packed fill of a different chunk size or compression level does not match
+	 */
+	compressed_data_size = 16;
+
+	result = libewf_compression_context_get_packed_fill(
+	          compression_context,
+	          1,
+	          65536,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          LIBEWF_COMPRESSION_DEFAULT,
+	          compressed_data,
+	          &compressed_data_size,
+	          &checksum,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_compression_context_get_packed_fill(
+	          compression_context,
+	          1,
+	          32768,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          LIBEWF_COMPRESSION_BEST,
+	          compressed_data,
+	          &compressed_data_size,
+	          &checksum,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A packed fill that does not fit the compressed data is not available
+	 */
+	compressed_data_size = 8;
+
+	result = libewf_compression_context_get_packed_fill(
+	          compression_context,
+	          1,
+	          32768,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          LIBEWF_COMPRESSION_DEFAULT,
+	          compressed_data,
+	          &compressed_data_size,
+	          &checksum,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	compressed_data_size = 16;
+
+	result = libewf_compression_context_get_packed_fill(
+	          NULL,
+	          1,
+	          32768,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          LIBEWF_COMPRESSION_DEFAULT,
+	          compressed_data,
+	          &compressed_data_size,
+	          &checksum,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_context_get_packed_fill(
+	          compression_context,
+	          1,
+	          32768,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          LIBEWF_COMPRESSION_DEFAULT,
+	          NULL,
+	          &compressed_data_size,
+	          &checksum,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_context_set_packed_fill(
+	          NULL,
+	          1,
+	          32768,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          LIBEWF_COMPRESSION_DEFAULT,
+	          packed_data,
+	          12,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_context_set_packed_fill(
+	          compression_context,
+	          1,
+	          32768,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          LIBEWF_COMPRESSION_DEFAULT,
+	          packed_data,
+	          0,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_compression_context_free(
+	          &compression_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "compression_context",
+	 compression_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( compression_context != NULL )
+	{
+		libewf_compression_context_free(
+		 &compression_context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) && defined( HAVE_ZLIB_INFLATE ) ) || defined( ZLIB_DLL )
+
+/* Tests the libewf_compression_context_deflate and libewf_compression_context_inflate functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_compression_context_deflate(
+     void )
+{
+	uint8_t compressed_data[ 1024 ];
+	uint8_t uncompressed_data[ 512 ];
+	uint8_t data[ 512 ];
+
+	libcerror_error_t *error                          = NULL;
+	libewf_compression_context_t *compression_context = NULL;
+	size_t compressed_data_size                       = 0;
+	size_t data_offset                                = 0;
+	size_t uncompressed_data_size                     = 0;
+	int iterator                                      = 0;
+	int result                                        = 0;
+
+	for( data_offset = 0;
+	     data_offset < 512;
+	     data_offset++ )
+	{
+		data[ data_offset ] = (uint8_t) ( data_offset % 13 );
+	}
+	/* Initialize test
+	 */
+	result = libewf_compression_context_initialize(
+	          &compression_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compression_context",
+	 compression_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * The second iteration reuses the zlib stream states
+	 */
+	for( iterator = 0;
+	     iterator < 2;
+	     iterator++ )
+	{
+		compressed_data_size = 1024;
+
+		result = libewf_compression_context_deflate(
+		          compression_context,
+		          compressed_data,
+		          &compressed_data_size,
+		          Z_DEFAULT_COMPRESSION,
+		          data,
+		          512,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		uncompressed_data_size = 512;
+
+		result = libewf_compression_context_inflate(
+		          compression_context,
+		          compressed_data,
+		          compressed_data_size,
+		          uncompressed_data,
+		          &uncompressed_data_size,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_SIZE(
+		 "uncompressed_data_size",
+		 uncompressed_data_size,
+		 (size_t) 512 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          uncompressed_data,
+		          data,
+		          512 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test inflate with an uncompressed data buffer that is too small
+	 */
+	uncompressed_data_size = 256;
+
+	result = libewf_compression_context_inflate(
+	          compression_context,
+	          compressed_data,
+	          compressed_data_size,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	compressed_data_size = 1024;
+
+	result = libewf_compression_context_deflate(
+	          NULL,
+	          compressed_data,
+	          &compressed_data_size,
+	          Z_DEFAULT_COMPRESSION,
+	          data,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	uncompressed_data_size = 512;
+
+	result = libewf_compression_context_inflate(
+	          NULL,
+	          compressed_data,
+	          compressed_data_size,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_compression_context_free(
+	          &compression_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "compression_context",
+	 compression_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( compression_context != NULL )
+	{
+		libewf_compression_context_free(
+		 &compression_context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) && defined( HAVE_ZLIB_INFLATE ) ) || defined( ZLIB_DLL ) */
+
+#if defined( HAVE_ZSTD )
+
+/* Tests the libewf_compression_context_zstd_compress and libewf_compression_context_zstd_decompress functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_compression_context_zstd_compress(
+     void )
+{
+	uint8_t compressed_data[ 1024 ];
+	uint8_t uncompressed_data[ 512 ];
+	uint8_t data[ 512 ];
+
+	libcerror_error_t *error                          = NULL;
+	libewf_compression_context_t *compression_context = NULL;
+	size_t compressed_data_size                       = 0;
+	size_t data_offset                                = 0;
+	size_t uncompressed_data_size                     = 0;
+	int iterator                                      = 0;
+	int result                                        = 0;
+
+	for( data_offset = 0;
+	     data_offset < 512;
+	     data_offset++ )
+	{
+		data[ data_offset ] = (uint8_t) ( data_offset % 13 );
+	}
+	/* Initialize test
+	 */
+	result = libewf_compression_context_initialize(
+	          &compression_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compression_context",
+	 compression_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * The second iteration reuses the zstd contexts
+	 */
+	for( iterator = 0;
+	     iterator < 2;
+	     iterator++ )
+	{
+		compressed_data_size = 1024;
+
+		result = libewf_compression_context_zstd_compress(
+		          compression_context,
+		          compressed_data,
+		          &compressed_data_size,
+		          1,
+		          data,
+		          512,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		uncompressed_data_size = 512;
+
+		result = libewf_compression_context_zstd_decompress(
+		          compression_context,
+		          compressed_data,
+		          compressed_data_size,
+		          uncompressed_data,
+		          &uncompressed_data_size,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_SIZE(
+		 "uncompressed_data_size",
+		 uncompressed_data_size,
+		 (size_t) 512 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          uncompressed_data,
+		          data,
+		          512 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test decompress with an uncompressed data buffer that is too small
+	 */
+	uncompressed_data_size = 256;
+
+	result = libewf_compression_context_zstd_decompress(
+	          compression_context,
+	          compressed_data,
+	          compressed_data_size,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test decompress with a corrupted content checksum
+	 */
+	compressed_data[ compressed_data_size - 1 ] ^= 0xff;
+
+	uncompressed_data_size = 512;
+
+	result = libewf_compression_context_zstd_decompress(
+	          compression_context,
+	          compressed_data,
+	          compressed_data_size,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	/* Test error cases
+	 */
+	compressed_data_size = 1024;
+
+	result = libewf_compression_context_zstd_compress(
+	          NULL,
+	          compressed_data,
+	          &compressed_data_size,
+	          1,
+	          data,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	uncompressed_data_size = 512;
+
+	result = libewf_compression_context_zstd_decompress(
+	          NULL,
+	          compressed_data,
+	          compressed_data_size,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_compression_context_free(
+	          &compression_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "compression_context",
+	 compression_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( compression_context != NULL )
+	{
+		libewf_compression_context_free(
+		 &compression_context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_ZSTD ) */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_compression_context_initialize",
+	 ewf_test_compression_context_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_compression_context_free",
+	 ewf_test_compression_context_free );
+
+	EWF_TEST_RUN(
+	 "libewf_compression_context_packed_fill",
+	 ewf_test_compression_context_packed_fill );
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) && defined( HAVE_ZLIB_INFLATE ) ) || defined( ZLIB_DLL )
+
+	EWF_TEST_RUN(
+	 "libewf_compression_context_deflate",
+	 ewf_test_compression_context_deflate );
+
+#endif
+
+#if defined( HAVE_ZSTD )
+
+	EWF_TEST_RUN(
+	 "libewf_compression_context_zstd_compress",
+	 ewf_test_compression_context_zstd_compress );
+
+#endif
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
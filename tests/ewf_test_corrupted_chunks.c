@@ -0,0 +1,755 @@
+/*
+ * Library corrupted_chunks type test program
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_chunk_data.h"
+#include "../libewf/libewf_corrupted_chunks.h"
+#include "../libewf/libewf_definitions.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Tests the libewf_corrupted_chunks_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_corrupted_chunks_initialize(
+     void )
+{
+	libcerror_error_t *error                    = NULL;
+	libewf_corrupted_chunks_t *corrupted_chunks = NULL;
+	int result                                  = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests             = 1;
+	int number_of_memset_fail_tests             = 1;
+	int test_number                             = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_corrupted_chunks_initialize(
+	          &corrupted_chunks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "corrupted_chunks",
+	 corrupted_chunks );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_corrupted_chunks_free(
+	          &corrupted_chunks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "corrupted_chunks",
+	 corrupted_chunks );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_corrupted_chunks_initialize(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	corrupted_chunks = (libewf_corrupted_chunks_t *) 0x12345678UL;
+
+	result = libewf_corrupted_chunks_initialize(
+	          &corrupted_chunks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	corrupted_chunks = NULL;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_corrupted_chunks_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_corrupted_chunks_initialize(
+		          &corrupted_chunks,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( corrupted_chunks != NULL )
+			{
+				libewf_corrupted_chunks_free(
+				 &corrupted_chunks,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "corrupted_chunks",
+			 corrupted_chunks );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_corrupted_chunks_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_corrupted_chunks_initialize(
+		          &corrupted_chunks,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( corrupted_chunks != NULL )
+			{
+				libewf_corrupted_chunks_free(
+				 &corrupted_chunks,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "corrupted_chunks",
+			 corrupted_chunks );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( corrupted_chunks != NULL )
+	{
+		libewf_corrupted_chunks_free(
+		 &corrupted_chunks,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_corrupted_chunks_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_corrupted_chunks_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_corrupted_chunks_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_corrupted_chunks_set_chunk and libewf_corrupted_chunks_get_chunk functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_corrupted_chunks_set_chunk(
+     void )
+{
+	libcerror_error_t *error                    = NULL;
+	libewf_chunk_data_t *chunk_data             = NULL;
+	libewf_chunk_data_t *retained_chunk_data    = NULL;
+	libewf_corrupted_chunks_t *corrupted_chunks = NULL;
+	size_t data_size                            = 0;
+	uint32_t range_flags                        = 0;
+	int entry_index                             = 0;
+	int number_of_chunks                        = 0;
+	int result                                  = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_corrupted_chunks_initialize(
+	          &corrupted_chunks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "corrupted_chunks",
+	 corrupted_chunks );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_initialize(
+	          &chunk_data,
+	          512,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	chunk_data->data_size   = 512;
+	chunk_data->range_flags = LIBEWF_RANGE_FLAG_IS_COMPRESSED | LIBEWF_RANGE_FLAG_IS_CORRUPTED;
+
+	/* Test regular cases
+	 */
+	result = libewf_corrupted_chunks_set_chunk(
+	          corrupted_chunks,
+	          5,
+	          chunk_data,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_corrupted_chunks_set_chunk(
+	          corrupted_chunks,
+	          2,
+	          chunk_data,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_corrupted_chunks_set_chunk(
+	          corrupted_chunks,
+	          5,
+	          chunk_data,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_corrupted_chunks_get_number_of_chunks(
+	          corrupted_chunks,
+	          &number_of_chunks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_chunks",
+	 number_of_chunks,
+	 2 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "corrupted_chunks->number_of_retained_chunk_data",
+	 corrupted_chunks->number_of_retained_chunk_data,
+	 1 );
+
+	result = libewf_corrupted_chunks_get_entry_index(
+	          corrupted_chunks,
+	          5,
+	          &entry_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "entry_index",
+	 entry_index,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_corrupted_chunks_get_entry_index(
+	          corrupted_chunks,
+	          3,
+	          &entry_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "entry_index",
+	 entry_index,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_corrupted_chunks_get_chunk(
+	          corrupted_chunks,
+	          5,
+	          &data_size,
+	          &range_flags,
+	          &retained_chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "data_size",
+	 data_size,
+	 (size_t) 512 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "range_flags",
+	 range_flags,
+	 (uint32_t) ( LIBEWF_RANGE_FLAG_IS_COMPRESSED | LIBEWF_RANGE_FLAG_IS_CORRUPTED ) );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "retained_chunk_data",
+	 retained_chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_corrupted_chunks_get_chunk(
+	          corrupted_chunks,
+	          2,
+	          &data_size,
+	          &range_flags,
+	          &retained_chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "retained_chunk_data",
+	 retained_chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_corrupted_chunks_get_chunk(
+	          corrupted_chunks,
+	          3,
+	          &data_size,
+	          &range_flags,
+	          &retained_chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_corrupted_chunks_set_chunk(
+	          NULL,
+	          5,
+	          chunk_data,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_corrupted_chunks_set_chunk(
+	          corrupted_chunks,
+	          5,
+	          NULL,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	chunk_data->range_flags |= LIBEWF_RANGE_FLAG_IS_PACKED;
+
+	result = libewf_corrupted_chunks_set_chunk(
+	          corrupted_chunks,
+	          7,
+	          chunk_data,
+	          1,
+	          &error );
+
+	chunk_data->range_flags &= ~( LIBEWF_RANGE_FLAG_IS_PACKED );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_corrupted_chunks_get_chunk(
+	          NULL,
+	          5,
+	          &data_size,
+	          &range_flags,
+	          &retained_chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_corrupted_chunks_get_chunk(
+	          corrupted_chunks,
+	          5,
+	          NULL,
+	          &range_flags,
+	          &retained_chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_corrupted_chunks_get_chunk(
+	          corrupted_chunks,
+	          5,
+	          &data_size,
+	          NULL,
+	          &retained_chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_corrupted_chunks_get_chunk(
+	          corrupted_chunks,
+	          5,
+	          &data_size,
+	          &range_flags,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_data_free(
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_corrupted_chunks_free(
+	          &corrupted_chunks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "corrupted_chunks",
+	 corrupted_chunks );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	if( corrupted_chunks != NULL )
+	{
+		libewf_corrupted_chunks_free(
+		 &corrupted_chunks,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_corrupted_chunks_initialize",
+	 ewf_test_corrupted_chunks_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_corrupted_chunks_free",
+	 ewf_test_corrupted_chunks_free );
+
+	EWF_TEST_RUN(
+	 "libewf_corrupted_chunks_set_chunk",
+	 ewf_test_corrupted_chunks_set_chunk );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
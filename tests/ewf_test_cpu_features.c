@@ -0,0 +1,279 @@
+/*
+ * Library cpu_features functions test program
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_cpu_features.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Tests the libewf_cpu_features_parse_string function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_cpu_features_parse_string(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	uint32_t cpu_features    = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_cpu_features_parse_string(
+	          "sse2,ssse3,avx2,avx512,neon,sha",
+	          31,
+	          &cpu_features,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "cpu_features",
+	 cpu_features,
+	 (uint32_t) LIBEWF_CPU_FEATURE_FLAGS_ALL );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that unsupported names are ignored
+	 */
+	result = libewf_cpu_features_parse_string(
+	          "ssse3,bogus,,sha",
+	          16,
+	          &cpu_features,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "cpu_features",
+	 cpu_features,
+	 (uint32_t) ( LIBEWF_CPU_FEATURE_FLAG_SSSE3 | LIBEWF_CPU_FEATURE_FLAG_SHA ) );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that none clears the preceding names
+	 */
+	result = libewf_cpu_features_parse_string(
+	          "avx2,none",
+	          9,
+	          &cpu_features,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "cpu_features",
+	 cpu_features,
+	 (uint32_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_cpu_features_parse_string(
+	          NULL,
+	          4,
+	          &cpu_features,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_cpu_features_parse_string(
+	          "sse2",
+	          (size_t) SSIZE_MAX + 1,
+	          &cpu_features,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_cpu_features_parse_string(
+	          "sse2",
+	          4,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_cpu_features_get function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_cpu_features_get(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	uint32_t cpu_features    = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_cpu_features_get(
+	          &cpu_features,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The features used are a subset of the features detected
+	 */
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "cpu_features",
+	 ( cpu_features & ~( libewf_cpu_features_detect() ) ),
+	 (uint32_t) 0 );
+
+	/* Test error cases
+	 */
+	result = libewf_cpu_features_get(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	/* TODO: add tests for libewf_cpu_features_detect */
+
+	EWF_TEST_RUN(
+	 "libewf_cpu_features_parse_string",
+	 ewf_test_cpu_features_parse_string );
+
+	EWF_TEST_RUN(
+	 "libewf_cpu_features_get",
+	 ewf_test_cpu_features_get );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -102,6 +102,12 @@ int main(
 
 	/* TODO: add tests for libewf_data_chunk_write_buffer */
 
+	/* TODO: add tests for libewf_data_chunk_pack */
+
+	/* TODO: add tests for libewf_data_chunk_copy_packed_data */
+
+	/* TODO: add tests for libewf_data_chunk_compare_packed_data */
+
 	return( EXIT_SUCCESS );
 
 on_error:
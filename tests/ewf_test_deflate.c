@@ -207,8 +207,170 @@ uint8_t ewf_test_deflate_compressed_byte_stream[ 2627 ] = {
 	0x7d, 0x8a, 0x87, 0xf9, 0x9d, 0x74, 0x33, 0x0e, 0x79, 0xc5, 0xf8, 0x73, 0xcd, 0xff, 0x00, 0x30,
 	0x4a, 0x56, 0xa4 };
 
+/* Compressed data of "The quick brown fox jumps over the lazy dog. libewf" that
+ * contains an empty uncompressed block, as written by a synchronization flush
+ */
+uint8_t ewf_test_deflate_compressed_byte_stream_sync_flush[ 64 ] = {
+	0x78, 0xda, 0x0a, 0xc9, 0x48, 0x55, 0x28, 0x2c, 0xcd, 0x4c, 0xce, 0x56, 0x48, 0x2a, 0xca, 0x2f,
+	0x07, 0x00, 0x00, 0x00, 0xff, 0xff, 0xcb, 0x53, 0x48, 0xcb, 0xaf, 0x50, 0xc8, 0x2a, 0xcd, 0x2d,
+	0x28, 0x56, 0xc8, 0x2f, 0x4b, 0x2d, 0x52, 0x28, 0x01, 0x4a, 0xe7, 0x24, 0x56, 0x55, 0x2a, 0xa4,
+	0xe4, 0xa7, 0xeb, 0x29, 0xe4, 0x64, 0x26, 0xa5, 0x96, 0xa7, 0x01, 0x00, 0xe5, 0x9c, 0x12, 0xa1 };
+
 #if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
 
+/* Tests the libewf_deflate_huffman_table_get_value function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_deflate_huffman_table_get_value(
+     void )
+{
+	libewf_deflate_huffman_table_t table;
+
+	uint16_t code_sizes_array[ 4 ] = { 2, 2, 2, 2 };
+
+	libcerror_error_t *error       = NULL;
+	uint32_t value_32bit           = 0;
+	uint8_t number_of_bits         = 0;
+	int result                     = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_deflate_huffman_table_construct(
+	          &table,
+	          code_sizes_array,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_deflate_huffman_table_get_value(
+	          &table,
+	          0x00000002UL,
+	          8,
+	          &value_32bit,
+	          &number_of_bits,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "value_32bit",
+	 value_32bit,
+	 (uint32_t) 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "number_of_bits",
+	 number_of_bits,
+	 (uint8_t) 2 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test with insufficient bits in the bit buffer
+	 */
+	result = libewf_deflate_huffman_table_get_value(
+	          &table,
+	          0x00000002UL,
+	          1,
+	          &value_32bit,
+	          &number_of_bits,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_deflate_huffman_table_get_value(
+	          NULL,
+	          0x00000002UL,
+	          8,
+	          &value_32bit,
+	          &number_of_bits,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_deflate_huffman_table_get_value(
+	          &table,
+	          0x00000002UL,
+	          8,
+	          NULL,
+	          &number_of_bits,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_deflate_huffman_table_get_value(
+	          &table,
+	          0x00000002UL,
+	          8,
+	          &value_32bit,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* Tests the libewf_deflate_decompress function
  * Returns 1 if successful or 0 if not
  */
@@ -242,6 +404,37 @@ int ewf_test_deflate_decompress(
 	 uncompressed_data_size,
 	 (size_t) 7640 );
 
+	uncompressed_data_size = 8192;
+
+	result = libewf_deflate_decompress(
+	          ewf_test_deflate_compressed_byte_stream_sync_flush,
+	          64,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_FPRINT_ERROR( error )
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "uncompressed_data_size",
+	 uncompressed_data_size,
+	 (size_t) 51 );
+
+	result = memory_compare(
+	          uncompressed_data,
+	          "The quick brown fox jumps over the lazy dog. libewf",
+	          51 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
 /* TODO: test uncompressed data too small */
 
 	/* Test error cases
@@ -328,6 +521,141 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_deflate_decompress_stream function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_deflate_decompress_stream(
+     void )
+{
+	uint8_t compressed_data[ 2627 + 16 ];
+	uint8_t uncompressed_data[ 8192 ];
+
+	libcerror_error_t *error      = NULL;
+	size_t compressed_stream_size = 0;
+	size_t data_offset            = 0;
+	size_t uncompressed_data_size = 8192;
+	int result                    = 0;
+
+	/* Initialize test
+	 */
+	for( data_offset = 0;
+	     data_offset < 2627;
+	     data_offset++ )
+	{
+		compressed_data[ data_offset ] = ewf_test_deflate_compressed_byte_stream[ data_offset ];
+	}
+	for( data_offset = 2627;
+	     data_offset < ( 2627 + 16 );
+	     data_offset++ )
+	{
+		compressed_data[ data_offset ] = 0xa5;
+	}
+	/* Test regular cases
+	 */
+	result = libewf_deflate_decompress_stream(
+	          compressed_data,
+	          2627 + 16,
+	          &compressed_stream_size,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_FPRINT_ERROR( error )
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "compressed_stream_size",
+	 compressed_stream_size,
+	 (size_t) 2627 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "uncompressed_data_size",
+	 uncompressed_data_size,
+	 (size_t) 7640 );
+
+	uncompressed_data_size = 8192;
+
+	result = libewf_deflate_decompress_stream(
+	          compressed_data,
+	          2627,
+	          &compressed_stream_size,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_FPRINT_ERROR( error )
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "compressed_stream_size",
+	 compressed_stream_size,
+	 (size_t) 2627 );
+
+	/* Test error cases
+	 */
+	uncompressed_data_size = 8192;
+
+	result = libewf_deflate_decompress_stream(
+	          compressed_data,
+	          2627 - 4,
+	          &compressed_stream_size,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	uncompressed_data_size = 8192;
+
+	result = libewf_deflate_decompress_stream(
+	          NULL,
+	          2627 + 16,
+	          &compressed_stream_size,
+	          uncompressed_data,
+	          &uncompressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
 
 /* The main program
@@ -360,6 +688,10 @@ int main(
 
 	/* TODO add tests for libewf_deflate_huffman_table_construct */
 
+	EWF_TEST_RUN(
+	 "libewf_deflate_huffman_table_get_value",
+	 ewf_test_deflate_huffman_table_get_value );
+
 	/* TODO add tests for libewf_deflate_bit_stream_get_huffman_encoded_value */
 
 	/* TODO add tests for libewf_deflate_bit_stream_get_huffman_encoded_codes_array */
@@ -370,6 +702,10 @@ int main(
 	 "libewf_deflate_decompress",
 	 ewf_test_deflate_decompress );
 
+	EWF_TEST_RUN(
+	 "libewf_deflate_decompress_stream",
+	 ewf_test_deflate_decompress_stream );
+
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
 
 	return( EXIT_SUCCESS );
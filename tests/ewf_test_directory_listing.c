@@ -0,0 +1,581 @@
+/*
+ * Library directory_listing type test program
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_directory_listing.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Tests the libewf_directory_listing_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_directory_listing_initialize(
+     void )
+{
+	libcerror_error_t *error                      = NULL;
+	libewf_directory_listing_t *directory_listing = NULL;
+	int result                                    = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests               = 1;
+	int number_of_memset_fail_tests               = 1;
+	int test_number                               = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_directory_listing_initialize(
+	          &directory_listing,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "directory_listing",
+	 directory_listing );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_directory_listing_free(
+	          &directory_listing,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "directory_listing",
+	 directory_listing );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_directory_listing_initialize(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	directory_listing = (libewf_directory_listing_t *) 0x12345678UL;
+
+	result = libewf_directory_listing_initialize(
+	          &directory_listing,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	directory_listing = NULL;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_directory_listing_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_directory_listing_initialize(
+		          &directory_listing,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( directory_listing != NULL )
+			{
+				libewf_directory_listing_free(
+				 &directory_listing,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "directory_listing",
+			 directory_listing );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_directory_listing_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_directory_listing_initialize(
+		          &directory_listing,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( directory_listing != NULL )
+			{
+				libewf_directory_listing_free(
+				 &directory_listing,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "directory_listing",
+			 directory_listing );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( directory_listing != NULL )
+	{
+		libewf_directory_listing_free(
+		 &directory_listing,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_directory_listing_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_directory_listing_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_directory_listing_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_directory_listing_read and libewf_directory_listing_has_entry functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_directory_listing_read(
+     void )
+{
+	libcerror_error_t *error                      = NULL;
+	libewf_directory_listing_t *directory_listing = NULL;
+	FILE *file_stream                             = NULL;
+	int result                                    = 0;
+
+	/* Initialize test
+	 */
+	file_stream = file_stream_open(
+	               "ewf_test_directory_listing.E01",
+	               FILE_STREAM_OPEN_WRITE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "file_stream",
+	 file_stream );
+
+	file_stream_close(
+	 file_stream );
+
+	file_stream = file_stream_open(
+	               "ewf_test_directory_listing.E02",
+	               FILE_STREAM_OPEN_WRITE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "file_stream",
+	 file_stream );
+
+	file_stream_close(
+	 file_stream );
+
+	file_stream = NULL;
+
+	result = libewf_directory_listing_initialize(
+	          &directory_listing,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "directory_listing",
+	 directory_listing );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_directory_listing_read(
+	          directory_listing,
+	          "ewf_test_directory_listing",
+	          26,
+	          &error );
+
+#if defined( HAVE_LIBEWF_DIRECTORY_LISTING_SUPPORT )
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "directory_listing->number_of_entries",
+	 directory_listing->number_of_entries,
+	 2 );
+#else
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+#endif
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if defined( HAVE_LIBEWF_DIRECTORY_LISTING_SUPPORT )
+	result = libewf_directory_listing_has_entry(
+	          directory_listing,
+	          "ewf_test_directory_listing.E02",
+	          30,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_directory_listing_has_entry(
+	          directory_listing,
+	          "./ewf_test_directory_listing.E01",
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_directory_listing_has_entry(
+	          directory_listing,
+	          "ewf_test_directory_listing.E03",
+	          30,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a name that is a prefix of an entry name
+	 */
+	result = libewf_directory_listing_has_entry(
+	          directory_listing,
+	          "ewf_test_directory_listing.E0",
+	          29,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#endif /* defined( HAVE_LIBEWF_DIRECTORY_LISTING_SUPPORT ) */
+
+	/* Test error cases
+	 */
+	result = libewf_directory_listing_read(
+	          NULL,
+	          "ewf_test_directory_listing",
+	          26,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_directory_listing_read(
+	          directory_listing,
+	          NULL,
+	          26,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_directory_listing_has_entry(
+	          NULL,
+	          "ewf_test_directory_listing.E01",
+	          30,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_directory_listing_has_entry(
+	          directory_listing,
+	          NULL,
+	          30,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_directory_listing_free(
+	          &directory_listing,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "directory_listing",
+	 directory_listing );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	remove(
+	 "ewf_test_directory_listing.E01" );
+
+	remove(
+	 "ewf_test_directory_listing.E02" );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( directory_listing != NULL )
+	{
+		libewf_directory_listing_free(
+		 &directory_listing,
+		 NULL );
+	}
+	remove(
+	 "ewf_test_directory_listing.E01" );
+
+	remove(
+	 "ewf_test_directory_listing.E02" );
+
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_directory_listing_initialize",
+	 ewf_test_directory_listing_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_directory_listing_free",
+	 ewf_test_directory_listing_free );
+
+	EWF_TEST_RUN(
+	 "libewf_directory_listing_read",
+	 ewf_test_directory_listing_read );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
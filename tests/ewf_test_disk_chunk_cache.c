@@ -0,0 +1,611 @@
+/*
+ * Library disk_chunk_cache type test program
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_disk_chunk_cache.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* The maximum cache size of a disk chunk cache of 2 entries of 512 bytes
+ */
+#define EWF_TEST_DISK_CHUNK_CACHE_MAXIMUM_CACHE_SIZE \
+	( LIBEWF_DISK_CHUNK_CACHE_FILE_HEADER_SIZE + ( 2 * ( 512 + LIBEWF_DISK_CHUNK_CACHE_FILE_ENTRY_SIZE ) ) )
+
+uint8_t ewf_test_disk_chunk_cache_set_identifier[ 16 ] = {
+	0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10 };
+
+/* Tests the libewf_disk_chunk_cache_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_disk_chunk_cache_initialize(
+     void )
+{
+	libcerror_error_t *error                    = NULL;
+	libewf_disk_chunk_cache_t *disk_chunk_cache = NULL;
+	int result                                  = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_disk_chunk_cache_initialize(
+	          &disk_chunk_cache,
+	          512,
+	          EWF_TEST_DISK_CHUNK_CACHE_MAXIMUM_CACHE_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "disk_chunk_cache",
+	 disk_chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "disk_chunk_cache->number_of_entries",
+	 disk_chunk_cache->number_of_entries,
+	 2 );
+
+	result = libewf_disk_chunk_cache_free(
+	          &disk_chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "disk_chunk_cache",
+	 disk_chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_disk_chunk_cache_initialize(
+	          NULL,
+	          512,
+	          EWF_TEST_DISK_CHUNK_CACHE_MAXIMUM_CACHE_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_disk_chunk_cache_initialize(
+	          &disk_chunk_cache,
+	          0,
+	          EWF_TEST_DISK_CHUNK_CACHE_MAXIMUM_CACHE_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test a maximum cache size that cannot contain a single entry
+	 */
+	result = libewf_disk_chunk_cache_initialize(
+	          &disk_chunk_cache,
+	          512,
+	          LIBEWF_DISK_CHUNK_CACHE_FILE_HEADER_SIZE + 512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( disk_chunk_cache != NULL )
+	{
+		libewf_disk_chunk_cache_free(
+		 &disk_chunk_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_disk_chunk_cache_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_disk_chunk_cache_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_disk_chunk_cache_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Opens a disk chunk cache of 2 entries of 512 bytes with file IO pool entry 0 as segment number 1
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_disk_chunk_cache_open_test_cache(
+     libewf_disk_chunk_cache_t **disk_chunk_cache,
+     const uint8_t *set_identifier,
+     libcerror_error_t **error )
+{
+	int result = 0;
+
+	result = libewf_disk_chunk_cache_initialize(
+	          disk_chunk_cache,
+	          512,
+	          EWF_TEST_DISK_CHUNK_CACHE_MAXIMUM_CACHE_SIZE,
+	          error );
+
+	if( result == 1 )
+	{
+		result = libewf_disk_chunk_cache_set_segment_number(
+		          *disk_chunk_cache,
+		          0,
+		          1,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = libewf_disk_chunk_cache_open(
+		          *disk_chunk_cache,
+		          "ewf_test_disk_chunk_cache.cache",
+		          31,
+		          set_identifier,
+		          16,
+		          error );
+	}
+	return( result );
+}
+
+/* Tests the libewf_disk_chunk_cache_write_chunk_data and libewf_disk_chunk_cache_read_chunk_data functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_disk_chunk_cache_read_write_chunk_data(
+     void )
+{
+	uint8_t chunk_data[ 512 ];
+	uint8_t other_set_identifier[ 16 ];
+	uint8_t read_data[ 512 ];
+
+	libcerror_error_t *error                    = NULL;
+	libewf_disk_chunk_cache_t *disk_chunk_cache = NULL;
+	size_t chunk_data_size                      = 0;
+	int result                                  = 0;
+
+	memory_set(
+	 chunk_data,
+	 'A',
+	 512 );
+
+	remove(
+	 "ewf_test_disk_chunk_cache.cache" );
+
+	result = ewf_test_disk_chunk_cache_open_test_cache(
+	          &disk_chunk_cache,
+	          ewf_test_disk_chunk_cache_set_identifier,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a chunk that is not in the cache
+	 */
+	result = libewf_disk_chunk_cache_read_chunk_data(
+	          disk_chunk_cache,
+	          0,
+	          0x1000,
+	          read_data,
+	          512,
+	          &chunk_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Fill the cache with the chunks at offsets 0x1000 and 0x2000
+	 */
+	result = libewf_disk_chunk_cache_write_chunk_data(
+	          disk_chunk_cache,
+	          0,
+	          0x1000,
+	          chunk_data,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	chunk_data[ 0 ] = 'B';
+
+	result = libewf_disk_chunk_cache_write_chunk_data(
+	          disk_chunk_cache,
+	          0,
+	          0x2000,
+	          chunk_data,
+	          256,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Access the chunk at offset 0x1000 so the chunk at offset 0x2000 is the least recently used
+	 */
+	result = libewf_disk_chunk_cache_read_chunk_data(
+	          disk_chunk_cache,
+	          0,
+	          0x1000,
+	          read_data,
+	          512,
+	          &chunk_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "chunk_data_size",
+	 chunk_data_size,
+	 (size_t) 512 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "read_data[ 0 ]",
+	 (int) read_data[ 0 ],
+	 (int) 'A' );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that a chunk of an unknown file IO pool entry is not stored
+	 */
+	result = libewf_disk_chunk_cache_write_chunk_data(
+	          disk_chunk_cache,
+	          1,
+	          0x3000,
+	          chunk_data,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the least recently used chunk is evicted
+	 */
+	result = libewf_disk_chunk_cache_write_chunk_data(
+	          disk_chunk_cache,
+	          0,
+	          0x3000,
+	          chunk_data,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_disk_chunk_cache_read_chunk_data(
+	          disk_chunk_cache,
+	          0,
+	          0x2000,
+	          read_data,
+	          512,
+	          &chunk_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_disk_chunk_cache_free(
+	          &disk_chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the chunks are retained when the cache file is reopened
+	 */
+	result = ewf_test_disk_chunk_cache_open_test_cache(
+	          &disk_chunk_cache,
+	          ewf_test_disk_chunk_cache_set_identifier,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_disk_chunk_cache_read_chunk_data(
+	          disk_chunk_cache,
+	          0,
+	          0x3000,
+	          read_data,
+	          512,
+	          &chunk_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "read_data[ 0 ]",
+	 (int) read_data[ 0 ],
+	 (int) 'B' );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_disk_chunk_cache_free(
+	          &disk_chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the chunks are discarded when the cache file is opened for another segment file set
+	 */
+	memory_set(
+	 other_set_identifier,
+	 0,
+	 16 );
+
+	result = ewf_test_disk_chunk_cache_open_test_cache(
+	          &disk_chunk_cache,
+	          other_set_identifier,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_disk_chunk_cache_read_chunk_data(
+	          disk_chunk_cache,
+	          0,
+	          0x3000,
+	          read_data,
+	          512,
+	          &chunk_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_disk_chunk_cache_free(
+	          &disk_chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	remove(
+	 "ewf_test_disk_chunk_cache.cache" );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( disk_chunk_cache != NULL )
+	{
+		libewf_disk_chunk_cache_free(
+		 &disk_chunk_cache,
+		 NULL );
+	}
+	remove(
+	 "ewf_test_disk_chunk_cache.cache" );
+
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_disk_chunk_cache_initialize",
+	 ewf_test_disk_chunk_cache_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_disk_chunk_cache_free",
+	 ewf_test_disk_chunk_cache_free );
+
+	EWF_TEST_RUN(
+	 "libewf_disk_chunk_cache_read_write_chunk_data",
+	 ewf_test_disk_chunk_cache_read_write_chunk_data );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -27,7 +27,6 @@
 #include <stdlib.h>
 #endif
 
-#include "ewf_test_libcdata.h"
 #include "ewf_test_libcerror.h"
 #include "ewf_test_libewf.h"
 #include "ewf_test_macros.h"
@@ -35,6 +34,7 @@
 
 #include "../libewf/libewf_error2_section.h"
 #include "../libewf/libewf_section_descriptor.h"
+#include "../libewf/libewf_sector_range_list.h"
 
 uint8_t ewf_test_error2_section_data1[ 548 ] = {
 	0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
@@ -81,13 +81,13 @@ uint8_t ewf_test_error2_section_data1[ 548 ] = {
 int ewf_test_error2_section_read_data(
      void )
 {
-	libcerror_error_t *error              = NULL;
-	libcdata_range_list_t *acquiry_errors = NULL;
-	int result                            = 0;
+	libcerror_error_t *error                   = NULL;
+	libewf_sector_range_list_t *acquiry_errors = NULL;
+	int result                                 = 0;
 
 	/* Initialize test
 	 */
-	result = libcdata_range_list_initialize(
+	result = libewf_sector_range_list_initialize(
 	          &acquiry_errors,
 	          &error );
 
@@ -204,9 +204,8 @@ int ewf_test_error2_section_read_data(
 
 	/* Clean up
 	 */
-	result = libcdata_range_list_free(
+	result = libewf_sector_range_list_free(
 	          &acquiry_errors,
-	          NULL,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -232,9 +231,8 @@ on_error:
 	}
 	if( acquiry_errors != NULL )
 	{
-		libcdata_range_list_free(
+		libewf_sector_range_list_free(
 		 &acquiry_errors,
-		 NULL,
 		 NULL );
 	}
 	return( 0 );
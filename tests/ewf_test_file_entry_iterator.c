@@ -0,0 +1,770 @@
+/*
+ * Library file_entry_iterator type test program
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcdata.h"
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_file_entry_iterator.h"
+#include "../libewf/libewf_single_file_entry.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Creates a file entry tree node with a number of sub nodes
+ * The size of every sub file entry is set to its index
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_file_entry_iterator_create_tree(
+     libcdata_tree_node_t **root_node,
+     int number_of_sub_nodes,
+     libcerror_error_t **error )
+{
+	libcdata_tree_node_t *sub_node                = NULL;
+	libewf_single_file_entry_t *single_file_entry = NULL;
+	int sub_node_index                            = 0;
+
+	if( libcdata_tree_node_initialize(
+	     root_node,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	for( sub_node_index = 0;
+	     sub_node_index < number_of_sub_nodes;
+	     sub_node_index++ )
+	{
+		if( libewf_single_file_entry_initialize(
+		     &single_file_entry,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		single_file_entry->size = (size64_t) sub_node_index;
+
+		if( libcdata_tree_node_initialize(
+		     &sub_node,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		if( libcdata_tree_node_set_value(
+		     sub_node,
+		     (intptr_t *) single_file_entry,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		single_file_entry = NULL;
+
+		if( libcdata_tree_node_append_node(
+		     *root_node,
+		     sub_node,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		sub_node = NULL;
+	}
+	return( 1 );
+
+on_error:
+	if( sub_node != NULL )
+	{
+		libcdata_tree_node_free(
+		 &sub_node,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
+		 NULL );
+	}
+	if( single_file_entry != NULL )
+	{
+		libewf_single_file_entry_free(
+		 &single_file_entry,
+		 NULL );
+	}
+	if( *root_node != NULL )
+	{
+		libcdata_tree_node_free(
+		 root_node,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests the libewf_file_entry_iterator_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_file_entry_iterator_initialize(
+     void )
+{
+	libcdata_tree_node_t *root_node                   = NULL;
+	libcerror_error_t *error                          = NULL;
+	libewf_file_entry_iterator_t *file_entry_iterator = NULL;
+	int result                                        = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests                   = 1;
+	int number_of_memset_fail_tests                   = 1;
+	int test_number                                   = 0;
+#endif
+
+	result = ewf_test_file_entry_iterator_create_tree(
+	          &root_node,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_file_entry_iterator_initialize(
+	          &file_entry_iterator,
+	          NULL,
+	          root_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "file_entry_iterator",
+	 file_entry_iterator );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_file_entry_iterator_free(
+	          &file_entry_iterator,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "file_entry_iterator",
+	 file_entry_iterator );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_file_entry_iterator_initialize(
+	          NULL,
+	          NULL,
+	          root_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	file_entry_iterator = (libewf_file_entry_iterator_t *) 0x12345678UL;
+
+	result = libewf_file_entry_iterator_initialize(
+	          &file_entry_iterator,
+	          NULL,
+	          root_node,
+	          &error );
+
+	file_entry_iterator = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_file_entry_iterator_initialize(
+	          &file_entry_iterator,
+	          NULL,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_file_entry_iterator_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_file_entry_iterator_initialize(
+		          &file_entry_iterator,
+		          NULL,
+		          root_node,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( file_entry_iterator != NULL )
+			{
+				libewf_file_entry_iterator_free(
+				 &file_entry_iterator,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "file_entry_iterator",
+			 file_entry_iterator );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_file_entry_iterator_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_file_entry_iterator_initialize(
+		          &file_entry_iterator,
+		          NULL,
+		          root_node,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( file_entry_iterator != NULL )
+			{
+				libewf_file_entry_iterator_free(
+				 &file_entry_iterator,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "file_entry_iterator",
+			 file_entry_iterator );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	result = libcdata_tree_node_free(
+	          &root_node,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_entry_iterator != NULL )
+	{
+		libewf_file_entry_iterator_free(
+		 &file_entry_iterator,
+		 NULL );
+	}
+	if( root_node != NULL )
+	{
+		libcdata_tree_node_free(
+		 &root_node,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* Tests the libewf_file_entry_iterator_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_file_entry_iterator_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_file_entry_iterator_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Tests the libewf_file_entry_iterator_next function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_file_entry_iterator_next(
+     void )
+{
+	libcdata_tree_node_t *root_node                   = NULL;
+	libcerror_error_t *error                          = NULL;
+	libewf_file_entry_iterator_t *file_entry_iterator = NULL;
+	size64_t size                                     = 0;
+	int expected_index                                = 0;
+	int number_of_sub_file_entries                    = 0;
+	int result                                        = 0;
+	int sub_file_entry_index                          = 0;
+
+	/* Initialize test
+	 */
+	result = ewf_test_file_entry_iterator_create_tree(
+	          &root_node,
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_file_entry_iterator_initialize(
+	          &file_entry_iterator,
+	          NULL,
+	          root_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_file_entry_iterator_get_index(
+	          file_entry_iterator,
+	          &sub_file_entry_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "sub_file_entry_index",
+	 sub_file_entry_index,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( expected_index = 0;
+	     expected_index < 3;
+	     expected_index++ )
+	{
+		result = libewf_file_entry_iterator_next(
+		          file_entry_iterator,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libewf_file_entry_iterator_get_index(
+		          file_entry_iterator,
+		          &sub_file_entry_index,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "sub_file_entry_index",
+		 sub_file_entry_index,
+		 expected_index );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libewf_file_entry_iterator_get_size(
+		          file_entry_iterator,
+		          &size,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_UINT64(
+		 "size",
+		 (uint64_t) size,
+		 (uint64_t) expected_index );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libewf_file_entry_iterator_get_number_of_sub_file_entries(
+		          file_entry_iterator,
+		          &number_of_sub_file_entries,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "number_of_sub_file_entries",
+		 number_of_sub_file_entries,
+		 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libewf_file_entry_iterator_next(
+	          file_entry_iterator,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_file_entry_iterator_next(
+	          file_entry_iterator,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_file_entry_iterator_get_size(
+	          file_entry_iterator,
+	          &size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_file_entry_iterator_next(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test after reset
+	 */
+	result = libewf_file_entry_iterator_reset(
+	          file_entry_iterator,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_file_entry_iterator_next(
+	          file_entry_iterator,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_file_entry_iterator_get_index(
+	          file_entry_iterator,
+	          &sub_file_entry_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "sub_file_entry_index",
+	 sub_file_entry_index,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libewf_file_entry_iterator_free(
+	          &file_entry_iterator,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_tree_node_free(
+	          &root_node,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_entry_iterator != NULL )
+	{
+		libewf_file_entry_iterator_free(
+		 &file_entry_iterator,
+		 NULL );
+	}
+	if( root_node != NULL )
+	{
+		libcdata_tree_node_free(
+		 &root_node,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_file_entry_iterator_initialize",
+	 ewf_test_file_entry_iterator_initialize );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	EWF_TEST_RUN(
+	 "libewf_file_entry_iterator_free",
+	 ewf_test_file_entry_iterator_free );
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_file_entry_iterator_next",
+	 ewf_test_file_entry_iterator_next );
+
+	/* TODO: add tests for libewf_file_entry_iterator_get_file_entry */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
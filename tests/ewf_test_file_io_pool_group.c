@@ -0,0 +1,565 @@
+/*
+ * Library file_io_pool_group type test program
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libbfio.h"
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_file_io_pool_group.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Tests the libewf_file_io_pool_group_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_file_io_pool_group_initialize(
+     void )
+{
+	libcerror_error_t *error                        = NULL;
+	libewf_file_io_pool_group_t *file_io_pool_group = NULL;
+	int result                                      = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_file_io_pool_group_initialize(
+	          &file_io_pool_group,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_pool_group",
+	 file_io_pool_group );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_file_io_pool_group_free(
+	          &file_io_pool_group,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "file_io_pool_group",
+	 file_io_pool_group );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_file_io_pool_group_initialize(
+	          NULL,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	file_io_pool_group = (libewf_file_io_pool_group_t *) 0x12345678UL;
+
+	result = libewf_file_io_pool_group_initialize(
+	          &file_io_pool_group,
+	          16,
+	          &error );
+
+	file_io_pool_group = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_file_io_pool_group_initialize(
+	          &file_io_pool_group,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_pool_group != NULL )
+	{
+		libewf_file_io_pool_group_free(
+		 &file_io_pool_group,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_file_io_pool_group_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_file_io_pool_group_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_file_io_pool_group_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_file_io_pool_group_append_file_io_pool, libewf_file_io_pool_group_remove_file_io_pool
+ * and libewf_file_io_pool_group_set_maximum_number_of_open_handles functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_file_io_pool_group_append_file_io_pool(
+     void )
+{
+	libbfio_pool_t *large_file_io_pool              = NULL;
+	libbfio_pool_t *small_file_io_pool              = NULL;
+	libcerror_error_t *error                        = NULL;
+	libewf_file_io_pool_group_t *file_io_pool_group = NULL;
+	int result                                      = 0;
+
+	/* Initialize test
+	 */
+	result = libbfio_pool_initialize(
+	          &small_file_io_pool,
+	          2,
+	          LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_pool_initialize(
+	          &large_file_io_pool,
+	          32,
+	          LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_file_io_pool_group_initialize(
+	          &file_io_pool_group,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_file_io_pool_group_append_file_io_pool(
+	          file_io_pool_group,
+	          small_file_io_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_file_io_pool_group_append_file_io_pool(
+	          file_io_pool_group,
+	          large_file_io_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_file_io_pool_group_append_file_io_pool(
+	          file_io_pool_group,
+	          large_file_io_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "file_io_pool_group->number_of_file_io_pools",
+	 file_io_pool_group->number_of_file_io_pools,
+	 2 );
+
+	/* The small file IO pool only needs 2 open handles and passes the remainder on
+	 */
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "file_io_pool_group->shares[ 0 ]",
+	 file_io_pool_group->shares[ 0 ],
+	 2 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "file_io_pool_group->shares[ 1 ]",
+	 file_io_pool_group->shares[ 1 ],
+	 14 );
+
+	result = libewf_file_io_pool_group_set_maximum_number_of_open_handles(
+	          file_io_pool_group,
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "file_io_pool_group->shares[ 0 ]",
+	 file_io_pool_group->shares[ 0 ],
+	 2 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "file_io_pool_group->shares[ 1 ]",
+	 file_io_pool_group->shares[ 1 ],
+	 1 );
+
+	result = libewf_file_io_pool_group_remove_file_io_pool(
+	          file_io_pool_group,
+	          small_file_io_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "file_io_pool_group->number_of_file_io_pools",
+	 file_io_pool_group->number_of_file_io_pools,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "file_io_pool_group->shares[ 0 ]",
+	 file_io_pool_group->shares[ 0 ],
+	 3 );
+
+	result = libewf_file_io_pool_group_remove_file_io_pool(
+	          file_io_pool_group,
+	          small_file_io_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_file_io_pool_group_append_file_io_pool(
+	          NULL,
+	          small_file_io_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_file_io_pool_group_append_file_io_pool(
+	          file_io_pool_group,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_file_io_pool_group_remove_file_io_pool(
+	          NULL,
+	          small_file_io_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_file_io_pool_group_set_maximum_number_of_open_handles(
+	          file_io_pool_group,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_file_io_pool_group_release(
+	          &file_io_pool_group,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "file_io_pool_group",
+	 file_io_pool_group );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_pool_free(
+	          &large_file_io_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_pool_free(
+	          &small_file_io_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_pool_group != NULL )
+	{
+		libewf_file_io_pool_group_free(
+		 &file_io_pool_group,
+		 NULL );
+	}
+	if( large_file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 &large_file_io_pool,
+		 NULL );
+	}
+	if( small_file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 &small_file_io_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_file_io_pool_group_initialize",
+	 ewf_test_file_io_pool_group_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_file_io_pool_group_free",
+	 ewf_test_file_io_pool_group_free );
+
+	EWF_TEST_RUN(
+	 "libewf_file_io_pool_group_append_file_io_pool",
+	 ewf_test_file_io_pool_group_append_file_io_pool );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
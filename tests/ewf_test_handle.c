@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <narrow_string.h>
 #include <system_string.h>
 #include <types.h>
@@ -34,6 +35,7 @@
 #include "ewf_test_getopt.h"
 #include "ewf_test_libbfio.h"
 #include "ewf_test_libcerror.h"
+#include "ewf_test_libcthreads.h"
 #include "ewf_test_libewf.h"
 #include "ewf_test_macros.h"
 #include "ewf_test_memory.h"
@@ -760,12 +762,16 @@ on_error:
 int ewf_test_handle_open_file_io_pool(
      const system_character_t *source )
 {
+	uint8_t buffer[ 16 ];
+
 	libbfio_handle_t *file_io_handle = NULL;
 	libbfio_pool_t *file_io_pool     = NULL;
 	libcerror_error_t *error         = NULL;
 	libewf_handle_t *handle          = NULL;
 	system_character_t **filenames   = NULL;
+	size64_t media_size              = 0;
 	size_t string_length             = 0;
+	ssize_t read_count               = 0;
 	int filename_index               = 0;
 	int number_of_filenames          = 0;
 	int result                       = 0;
@@ -984,12 +990,10 @@ int ewf_test_handle_open_file_io_pool(
 	libcerror_error_free(
 	 &error );
 
-	/* Test open when already opened
-	 */
 	result = libewf_handle_open_file_io_pool(
 	          handle,
 	          file_io_pool,
-	          LIBEWF_OPEN_READ,
+	          LIBEWF_ACCESS_FLAG_LAZY,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -1004,119 +1008,66 @@ int ewf_test_handle_open_file_io_pool(
 	libcerror_error_free(
 	 &error );
 
-	/* Clean up
-	 */
-	result = libewf_handle_free(
-	          &handle,
+	result = libewf_handle_open_file_io_pool(
+	          handle,
+	          file_io_pool,
+	          LIBEWF_ACCESS_FLAG_METADATA,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
-
-	EWF_TEST_ASSERT_IS_NULL(
-	 "handle",
-	 handle );
+	 -1 );
 
-	EWF_TEST_ASSERT_IS_NULL(
+	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	result = libbfio_pool_free(
-	          &file_io_pool,
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_open_file_io_pool(
+	          handle,
+	          file_io_pool,
+	          LIBEWF_OPEN_READ_METADATA | LIBEWF_ACCESS_FLAG_LAZY,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 -1 );
 
-	EWF_TEST_ASSERT_IS_NULL(
-         "file_io_pool",
-         file_io_pool );
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-        EWF_TEST_ASSERT_IS_NULL(
-         "error",
-         error );
+	libcerror_error_free(
+	 &error );
 
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libewf_glob_wide_free(
-	          filenames,
-	          number_of_filenames,
-	          &error );
-#else
-	result = libewf_glob_free(
-	          filenames,
-	          number_of_filenames,
+	result = libewf_handle_open_file_io_pool(
+	          handle,
+	          file_io_pool,
+	          LIBEWF_OPEN_READ_METADATA | LIBEWF_ACCESS_FLAG_INDEX,
 	          &error );
-#endif
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 -1 );
 
-	EWF_TEST_ASSERT_IS_NULL(
+	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	return( 1 );
-
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	if( handle != NULL )
-	{
-		libewf_handle_free(
-		 &handle,
-		 NULL );
-	}
-	if( file_io_handle != NULL )
-	{
-		libbfio_handle_free(
-		 &file_io_handle,
-		 NULL );
-	}
-	if( file_io_pool != NULL )
-	{
-		libbfio_pool_free(
-		 &file_io_pool,
-		 NULL );
-	}
-	if( filenames != NULL )
-	{
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-		libewf_glob_wide_free(
-		 filenames,
-		 number_of_filenames,
-		 NULL );
-#else
-		libewf_glob_free(
-		 filenames,
-		 number_of_filenames,
-		 NULL );
-#endif
-	}
-	return( 0 );
-}
-
-/* Tests the libewf_handle_close function
- * Returns 1 if successful or 0 if not
- */
-int ewf_test_handle_close(
-     void )
-{
-	libcerror_error_t *error = NULL;
-	int result               = 0;
+	libcerror_error_free(
+	 &error );
 
-	/* Test error cases
+	/* Test open when already opened
 	 */
-	result = libewf_handle_close(
-	          NULL,
+	result = libewf_handle_open_file_io_pool(
+	          handle,
+	          file_io_pool,
+	          LIBEWF_OPEN_READ,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -1131,68 +1082,25 @@ int ewf_test_handle_close(
 	libcerror_error_free(
 	 &error );
 
-	return( 1 );
-
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	return( 0 );
-}
-
-/* Tests the libewf_handle_open and libewf_handle_close functions
- * Returns 1 if successful or 0 if not
- */
-int ewf_test_handle_open_close(
-     const system_character_t *source )
-{
-	libcerror_error_t *error       = NULL;
-	libewf_handle_t *handle        = NULL;
-	system_character_t **filenames = NULL;
-	size_t source_length           = 0;
-	int number_of_filenames        = 0;
-	int result                     = 0;
-
-	/* Initialize test
-	 */
-	source_length = system_string_length(
-	                 source );
-
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libewf_glob_wide(
-	          source,
-	          source_length,
-	          LIBEWF_FORMAT_UNKNOWN,
-	          &filenames,
-	          &number_of_filenames,
-	          &error );
-#else
-	result = libewf_glob(
-	          source,
-	          source_length,
-	          LIBEWF_FORMAT_UNKNOWN,
-	          &filenames,
-	          &number_of_filenames,
+	result = libewf_handle_close(
+	          handle,
 	          &error );
-#endif
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
-
-	EWF_TEST_ASSERT_IS_NOT_NULL(
-	 "filenames",
-	 filenames );
+	 0 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	result = libewf_handle_initialize(
-	          &handle,
+	/* Test open with segment files read on demand
+	 */
+	result = libewf_handle_open_file_io_pool(
+	          handle,
+	          file_io_pool,
+	          LIBEWF_OPEN_READ_LAZY,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -1200,31 +1108,14 @@ int ewf_test_handle_open_close(
 	 result,
 	 1 );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
-	 "handle",
-	 handle );
-
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test open and close
-	 */
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libewf_handle_open_wide(
-	          handle,
-	          (wchar_t * const *) filenames,
-	          number_of_filenames,
-	          LIBEWF_OPEN_READ,
-	          &error );
-#else
-	result = libewf_handle_open(
+	result = libewf_handle_get_media_size(
 	          handle,
-	          (char * const *) filenames,
-	          number_of_filenames,
-	          LIBEWF_OPEN_READ,
+	          &media_size,
 	          &error );
-#endif
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
@@ -1235,6 +1126,26 @@ int ewf_test_handle_open_close(
 	 "error",
 	 error );
 
+	if( media_size > 16 )
+	{
+		/* Read the end of the media to read the remaining segment files
+		 */
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              16,
+		              (off64_t) media_size - 8,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 8 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
 	result = libewf_handle_close(
 	          handle,
 	          &error );
@@ -1248,23 +1159,13 @@ int ewf_test_handle_open_close(
 	 "error",
 	 error );
 
-	/* Test open and close a second time to validate clean up on close
+	/* Test open with the chunk groups indexed on open
 	 */
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libewf_handle_open_wide(
-	          handle,
-	          (wchar_t * const *) filenames,
-	          number_of_filenames,
-	          LIBEWF_OPEN_READ,
-	          &error );
-#else
-	result = libewf_handle_open(
+	result = libewf_handle_open_file_io_pool(
 	          handle,
-	          (char * const *) filenames,
-	          number_of_filenames,
-	          LIBEWF_OPEN_READ,
+	          file_io_pool,
+	          LIBEWF_OPEN_READ_INDEXED,
 	          &error );
-#endif
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
@@ -1288,10 +1189,12 @@ int ewf_test_handle_open_close(
 	 "error",
 	 error );
 
-	/* Clean up
+	/* Test open with the chunk groups indexed after a lazy open
 	 */
-	result = libewf_handle_free(
-	          &handle,
+	result = libewf_handle_open_file_io_pool(
+	          handle,
+	          file_io_pool,
+	          LIBEWF_OPEN_READ_INDEXED | LIBEWF_ACCESS_FLAG_LAZY,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -1299,26 +1202,137 @@ int ewf_test_handle_open_close(
 	 result,
 	 1 );
 
-	EWF_TEST_ASSERT_IS_NULL(
-	 "handle",
-	 handle );
-
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libewf_glob_wide_free(
-	          filenames,
-	          number_of_filenames,
-	          &error );
-#else
-	result = libewf_glob_free(
-	          filenames,
-	          number_of_filenames,
+	result = libewf_handle_close(
+	          handle,
 	          &error );
-#endif
-	filenames = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test open with only the metadata read
+	 */
+	result = libewf_handle_open_file_io_pool(
+	          handle,
+	          file_io_pool,
+	          LIBEWF_OPEN_READ_METADATA,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( media_size > 16 )
+	{
+		/* The media data cannot be read when only the metadata was read
+		 */
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              16,
+		              0,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) -1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	result = libewf_handle_close(
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libewf_handle_free(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "handle",
+	 handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_pool_free(
+	          &file_io_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+         "file_io_pool",
+         file_io_pool );
+
+        EWF_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libewf_glob_wide_free(
+	          filenames,
+	          number_of_filenames,
+	          &error );
+#else
+	result = libewf_glob_free(
+	          filenames,
+	          number_of_filenames,
+	          &error );
+#endif
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
@@ -1343,6 +1357,18 @@ on_error:
 		 &handle,
 		 NULL );
 	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+	}
 	if( filenames != NULL )
 	{
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -1360,33 +1386,18 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_signal_abort function
+/* Tests the libewf_handle_close function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_signal_abort(
-     libewf_handle_t *handle )
+int ewf_test_handle_close(
+     void )
 {
 	libcerror_error_t *error = NULL;
 	int result               = 0;
 
-	/* Test regular cases
-	 */
-	result = libewf_handle_signal_abort(
-	          handle,
-	          &error );
-
-	EWF_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 1 );
-
-	EWF_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
-
 	/* Test error cases
 	 */
-	result = libewf_handle_signal_abort(
+	result = libewf_handle_close(
 	          NULL,
 	          &error );
 
@@ -1413,152 +1424,6089 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_read_buffer function
+/* Tests the libewf_handle_open and libewf_handle_close functions
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_read_buffer(
-     libewf_handle_t *handle )
+int ewf_test_handle_open_close(
+     const system_character_t *source )
 {
-	uint8_t buffer[ 16 ];
-
-	libcerror_error_t *error = NULL;
-	size64_t media_size      = 0;
-	ssize_t read_count       = 0;
-	off64_t offset           = 0;
-	int result               = 0;
+	libcerror_error_t *error       = NULL;
+	libewf_handle_t *handle        = NULL;
+	system_character_t **filenames = NULL;
+	size_t source_length           = 0;
+	int number_of_filenames        = 0;
+	int result                     = 0;
 
-	/* Determine size
+	/* Initialize test
 	 */
-	result = libewf_handle_get_media_size(
-	          handle,
-	          &media_size,
+	source_length = system_string_length(
+	                 source );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libewf_glob_wide(
+	          source,
+	          source_length,
+	          LIBEWF_FORMAT_UNKNOWN,
+	          &filenames,
+	          &number_of_filenames,
+	          &error );
+#else
+	result = libewf_glob(
+	          source,
+	          source_length,
+	          LIBEWF_FORMAT_UNKNOWN,
+	          &filenames,
+	          &number_of_filenames,
 	          &error );
+#endif
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
 	 1 );
 
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "filenames",
+	 filenames );
+
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Reset offset to 0
-	 */
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          0,
-	          SEEK_SET,
+	result = libewf_handle_initialize(
+	          &handle,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 0 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test regular cases
+	/* Test open and close
 	 */
-	if( media_size > 16 )
-	{
-		read_count = libewf_handle_read_buffer(
-		              handle,
-		              buffer,
-		              16,
-		              &error );
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libewf_handle_open_wide(
+	          handle,
+	          (wchar_t * const *) filenames,
+	          number_of_filenames,
+	          LIBEWF_OPEN_READ,
+	          &error );
+#else
+	result = libewf_handle_open(
+	          handle,
+	          (char * const *) filenames,
+	          number_of_filenames,
+	          LIBEWF_OPEN_READ,
+	          &error );
+#endif
 
-		EWF_TEST_ASSERT_EQUAL_SSIZE(
-		 "read_count",
-		 read_count,
-		 (ssize_t) 16 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-		EWF_TEST_ASSERT_IS_NULL(
-		 "error",
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_close(
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test open and close a second time to validate clean up on close
+	 */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libewf_handle_open_wide(
+	          handle,
+	          (wchar_t * const *) filenames,
+	          number_of_filenames,
+	          LIBEWF_OPEN_READ,
+	          &error );
+#else
+	result = libewf_handle_open(
+	          handle,
+	          (char * const *) filenames,
+	          number_of_filenames,
+	          LIBEWF_OPEN_READ,
+	          &error );
+#endif
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_close(
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libewf_handle_free(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "handle",
+	 handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libewf_glob_wide_free(
+	          filenames,
+	          number_of_filenames,
+	          &error );
+#else
+	result = libewf_glob_free(
+	          filenames,
+	          number_of_filenames,
+	          &error );
+#endif
+	filenames = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( filenames != NULL )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		libewf_glob_wide_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#else
+		libewf_glob_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#endif
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_signal_abort function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_signal_abort(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_signal_abort(
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_signal_abort(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_index_chunk_groups function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_index_chunk_groups(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_index_chunk_groups(
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_index_chunk_groups(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_read_buffer function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_read_buffer(
+     libewf_handle_t *handle )
+{
+	uint8_t buffer[ 16 ];
+
+	libcerror_error_t *error = NULL;
+	size64_t media_size      = 0;
+	ssize_t read_count       = 0;
+	off64_t offset           = 0;
+	int result               = 0;
+
+	/* Determine size
+	 */
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Reset offset to 0
+	 */
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	if( media_size > 16 )
+	{
+		read_count = libewf_handle_read_buffer(
+		              handle,
+		              buffer,
+		              16,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Set offset to media_size - 8
+		 */
+		offset = libewf_handle_seek_offset(
+		          handle,
+		          -8,
+		          SEEK_END,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 offset,
+		 (int64_t) media_size - 8 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Read buffer on media_size boundary
+		 */
+		read_count = libewf_handle_read_buffer(
+		              handle,
+		              buffer,
+		              16,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 8 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Read buffer beyond media_size boundary
+		 */
+		read_count = libewf_handle_read_buffer(
+		              handle,
+		              buffer,
+		              16,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Reset offset to 0
+		 */
+		offset = libewf_handle_seek_offset(
+		          handle,
+		          0,
+		          SEEK_SET,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 offset,
+		 (int64_t) 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	read_count = libewf_handle_read_buffer(
+	              NULL,
+	              buffer,
+	              16,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_handle_read_buffer(
+	              handle,
+	              NULL,
+	              16,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_handle_read_buffer(
+	              handle,
+	              buffer,
+	              (size_t) SSIZE_MAX + 1,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_read_buffer_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_read_buffer_at_offset(
+     libewf_handle_t *handle )
+{
+	uint8_t buffer[ 16 ];
+
+	libcerror_error_t *error = NULL;
+	size64_t media_size      = 0;
+	ssize_t read_count       = 0;
+	int result               = 0;
+
+	/* Determine size
+	 */
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	if( media_size > 16 )
+	{
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              16,
+		              0,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Read buffer on media_size boundary
+		 */
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              16,
+		              media_size - 8,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 8 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Read buffer beyond media_size boundary
+		 */
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              16,
+		              media_size + 8,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	read_count = libewf_handle_read_buffer_at_offset(
+	              NULL,
+	              buffer,
+	              16,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_handle_read_buffer_at_offset(
+	              handle,
+	              NULL,
+	              16,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              (size_t) SSIZE_MAX + 1,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              16,
+	              -1,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_read_vector function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_read_vector(
+     libewf_handle_t *handle )
+{
+	uint8_t first_buffer[ 1024 ];
+	uint8_t reference_buffer[ 4096 ];
+	uint8_t second_buffer[ 64 ];
+	uint8_t third_buffer[ 32 ];
+
+	libewf_iovec_t iov[ 3 ];
+
+	libcerror_error_t *error = NULL;
+	size64_t media_size      = 0;
+	ssize_t read_count       = 0;
+	int result               = 0;
+
+	/* Determine size
+	 */
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	if( media_size > 4096 )
+	{
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              reference_buffer,
+		              4096,
+		              0,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 4096 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Test elements that are not in offset order and that overlap
+		 */
+		iov[ 0 ].offset      = 2048;
+		iov[ 0 ].buffer      = first_buffer;
+		iov[ 0 ].buffer_size = 1024;
+		iov[ 1 ].offset      = 16;
+		iov[ 1 ].buffer      = second_buffer;
+		iov[ 1 ].buffer_size = 64;
+		iov[ 2 ].offset      = 0;
+		iov[ 2 ].buffer      = third_buffer;
+		iov[ 2 ].buffer_size = 32;
+
+		read_count = libewf_handle_read_vector(
+		              handle,
+		              iov,
+		              3,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 1120 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          first_buffer,
+		          &( reference_buffer[ 2048 ] ),
+		          1024 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		result = memory_compare(
+		          second_buffer,
+		          &( reference_buffer[ 16 ] ),
+		          64 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		result = memory_compare(
+		          third_buffer,
+		          &( reference_buffer[ 0 ] ),
+		          32 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		/* Test an element that extends beyond the media size
+		 */
+		iov[ 0 ].offset      = (off64_t) media_size - 8;
+		iov[ 0 ].buffer      = second_buffer;
+		iov[ 0 ].buffer_size = 64;
+
+		read_count = libewf_handle_read_vector(
+		              handle,
+		              iov,
+		              1,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 8 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test an empty vector
+	 */
+	read_count = libewf_handle_read_vector(
+	              handle,
+	              iov,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	iov[ 0 ].offset      = 0;
+	iov[ 0 ].buffer      = third_buffer;
+	iov[ 0 ].buffer_size = 32;
+
+	read_count = libewf_handle_read_vector(
+	              NULL,
+	              iov,
+	              1,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_handle_read_vector(
+	              handle,
+	              NULL,
+	              1,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_handle_read_vector(
+	              handle,
+	              iov,
+	              -1,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	iov[ 0 ].buffer = NULL;
+
+	read_count = libewf_handle_read_vector(
+	              handle,
+	              iov,
+	              1,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	iov[ 0 ].offset = -1;
+	iov[ 0 ].buffer = third_buffer;
+
+	read_count = libewf_handle_read_vector(
+	              handle,
+	              iov,
+	              1,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_read_buffer_at_offset_concurrent function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_read_buffer_at_offset_concurrent(
+     libewf_handle_t *handle )
+{
+	uint8_t buffer[ 16 ];
+	uint8_t reference_buffer[ 16 ];
+
+	libcerror_error_t *error = NULL;
+	size64_t media_size      = 0;
+	ssize_t read_count       = 0;
+	int result               = 0;
+
+	/* Determine size
+	 */
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	if( media_size > 16 )
+	{
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              reference_buffer,
+		              16,
+		              0,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		read_count = libewf_handle_read_buffer_at_offset_concurrent(
+		              handle,
+		              buffer,
+		              16,
+		              0,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          buffer,
+		          reference_buffer,
+		          16 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		/* Read the same buffer again from the chunk cache
+		 */
+		read_count = libewf_handle_read_buffer_at_offset_concurrent(
+		              handle,
+		              buffer,
+		              16,
+		              0,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          buffer,
+		          reference_buffer,
+		          16 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		/* Read buffer on media_size boundary
+		 */
+		read_count = libewf_handle_read_buffer_at_offset_concurrent(
+		              handle,
+		              buffer,
+		              16,
+		              media_size - 8,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 8 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Read buffer beyond media_size boundary
+		 */
+		read_count = libewf_handle_read_buffer_at_offset_concurrent(
+		              handle,
+		              buffer,
+		              16,
+		              media_size + 8,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	read_count = libewf_handle_read_buffer_at_offset_concurrent(
+	              NULL,
+	              buffer,
+	              16,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_handle_read_buffer_at_offset_concurrent(
+	              handle,
+	              NULL,
+	              16,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_handle_read_buffer_at_offset_concurrent(
+	              handle,
+	              buffer,
+	              (size_t) SSIZE_MAX + 1,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_handle_read_buffer_at_offset_concurrent(
+	              handle,
+	              buffer,
+	              16,
+	              -1,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_share_chunk_cache function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_share_chunk_cache(
+     libewf_handle_t *handle )
+{
+	uint8_t buffer[ 16 ];
+	uint8_t reference_buffer[ 16 ];
+
+	libcerror_error_t *error       = NULL;
+	libewf_handle_t *closed_handle = NULL;
+	size64_t media_size            = 0;
+	ssize_t read_count             = 0;
+	int result                     = 0;
+
+	/* Determine size
+	 */
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_share_chunk_cache(
+	          handle,
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( media_size > 16 )
+	{
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              reference_buffer,
+		              16,
+		              0,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Read the same buffer again from the shared chunk cache
+		 */
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              16,
+		              0,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          buffer,
+		          reference_buffer,
+		          16 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test error cases
+	 */
+	result = libewf_handle_share_chunk_cache(
+	          NULL,
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_share_chunk_cache(
+	          handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_initialize(
+	          &closed_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_share_chunk_cache(
+	          handle,
+	          closed_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_share_chunk_cache(
+	          closed_handle,
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_handle_free(
+	          &closed_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( closed_handle != NULL )
+	{
+		libewf_handle_free(
+		 &closed_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF )
+
+/* The arguments of a concurrent read test thread
+ */
+typedef struct ewf_test_handle_concurrent_read_arguments ewf_test_handle_concurrent_read_arguments_t;
+
+struct ewf_test_handle_concurrent_read_arguments
+{
+	/* The handle
+	 */
+	libewf_handle_t *handle;
+
+	/* The reference data
+	 */
+	const uint8_t *reference_data;
+
+	/* The reference data size
+	 */
+	size_t reference_data_size;
+
+	/* The result of the thread
+	 */
+	int result;
+};
+
+/* Reads data concurrently and compares it with the reference data
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_handle_concurrent_read_thread_function(
+     ewf_test_handle_concurrent_read_arguments_t *thread_arguments )
+{
+	uint8_t buffer[ 512 ];
+
+	libcerror_error_t *error = NULL;
+	size_t data_offset       = 0;
+	ssize_t read_count       = 0;
+	int read_iteration       = 0;
+
+	if( thread_arguments == NULL )
+	{
+		return( -1 );
+	}
+	thread_arguments->result = 0;
+
+	for( read_iteration = 0;
+	     read_iteration < 256;
+	     read_iteration++ )
+	{
+		data_offset = ( (size_t) read_iteration * 4099 ) % ( thread_arguments->reference_data_size - 512 );
+
+		read_count = libewf_handle_read_buffer_at_offset_concurrent(
+		              thread_arguments->handle,
+		              buffer,
+		              512,
+		              (off64_t) data_offset,
+		              &error );
+
+		if( read_count != (ssize_t) 512 )
+		{
+			goto on_error;
+		}
+		if( memory_compare(
+		     buffer,
+		     &( ( thread_arguments->reference_data )[ data_offset ] ),
+		     512 ) != 0 )
+		{
+			goto on_error;
+		}
+	}
+	thread_arguments->result = 1;
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Tests the libewf_handle_read_buffer_at_offset_concurrent function while
+ * the chunk cache of the handle is replaced by libewf_handle_share_chunk_cache
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_read_buffer_at_offset_concurrent_share_chunk_cache(
+     libewf_handle_t *handle,
+     libbfio_pool_t *file_io_pool )
+{
+	ewf_test_handle_concurrent_read_arguments_t thread_arguments[ 4 ];
+	libcthreads_thread_t *threads[ 4 ];
+	libewf_handle_t *source_handles[ 8 ];
+
+	libcerror_error_t *error     = NULL;
+	uint8_t *reference_data      = NULL;
+	size64_t media_size          = 0;
+	size_t reference_data_size   = 0;
+	ssize_t read_count           = 0;
+	int source_handle_index      = 0;
+	int result                   = 0;
+	int thread_index             = 0;
+
+	for( thread_index = 0;
+	     thread_index < 4;
+	     thread_index++ )
+	{
+		threads[ thread_index ] = NULL;
+	}
+	for( source_handle_index = 0;
+	     source_handle_index < 8;
+	     source_handle_index++ )
+	{
+		source_handles[ source_handle_index ] = NULL;
+	}
+	/* Determine size
+	 */
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( media_size <= 1024 )
+	{
+		return( 1 );
+	}
+	reference_data_size = 256 * 1024;
+
+	if( media_size < (size64_t) reference_data_size )
+	{
+		reference_data_size = (size_t) media_size;
+	}
+	/* Initialize test
+	 */
+	reference_data = (uint8_t *) memory_allocate(
+	                              sizeof( uint8_t ) * reference_data_size );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "reference_data",
+	 reference_data );
+
+	read_count = libewf_handle_read_buffer_at_offset(
+	              handle,
+	              reference_data,
+	              reference_data_size,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) reference_data_size );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The source handles are opened before the read threads are started
+	 * so that the file IO pool is only read by the handle during the test
+	 */
+	for( source_handle_index = 0;
+	     source_handle_index < 8;
+	     source_handle_index++ )
+	{
+		result = ewf_test_handle_open_source(
+		          &( source_handles[ source_handle_index ] ),
+		          file_io_pool,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "source_handle",
+		 source_handles[ source_handle_index ] );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	for( thread_index = 0;
+	     thread_index < 4;
+	     thread_index++ )
+	{
+		thread_arguments[ thread_index ].handle              = handle;
+		thread_arguments[ thread_index ].reference_data      = reference_data;
+		thread_arguments[ thread_index ].reference_data_size = reference_data_size;
+		thread_arguments[ thread_index ].result              = 0;
+
+		result = libcthreads_thread_create(
+		          &( threads[ thread_index ] ),
+		          NULL,
+		          (int (*)(void *)) &ewf_test_handle_concurrent_read_thread_function,
+		          (void *) &( thread_arguments[ thread_index ] ),
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test replacing the chunk cache while reads are in progress
+	 * Closing the source handle leaves the handle as the only reference
+	 * to the chunk cache, that is freed when it is replaced next
+	 */
+	for( source_handle_index = 0;
+	     source_handle_index < 8;
+	     source_handle_index++ )
+	{
+		result = libewf_handle_share_chunk_cache(
+		          handle,
+		          source_handles[ source_handle_index ],
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = ewf_test_handle_close_source(
+		          &( source_handles[ source_handle_index ] ),
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	for( thread_index = 0;
+	     thread_index < 4;
+	     thread_index++ )
+	{
+		result = libcthreads_thread_join(
+		          &( threads[ thread_index ] ),
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "thread_arguments.result",
+		 thread_arguments[ thread_index ].result,
+		 1 );
+	}
+	/* Clean up
+	 */
+	memory_free(
+	 reference_data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	for( thread_index = 0;
+	     thread_index < 4;
+	     thread_index++ )
+	{
+		if( threads[ thread_index ] != NULL )
+		{
+			libcthreads_thread_join(
+			 &( threads[ thread_index ] ),
+			 NULL );
+		}
+	}
+	for( source_handle_index = 0;
+	     source_handle_index < 8;
+	     source_handle_index++ )
+	{
+		if( source_handles[ source_handle_index ] != NULL )
+		{
+			ewf_test_handle_close_source(
+			 &( source_handles[ source_handle_index ] ),
+			 NULL );
+		}
+	}
+	if( reference_data != NULL )
+	{
+		memory_free(
+		 reference_data );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF ) */
+
+/* Tests the libewf_handle_set_maximum_chunk_cache_size function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_set_maximum_chunk_cache_size(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error       = NULL;
+	libewf_handle_t *closed_handle = NULL;
+	int result                     = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_set_maximum_chunk_cache_size(
+	          handle,
+	          4 * 1024 * 1024,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_set_maximum_chunk_cache_size(
+	          NULL,
+	          4 * 1024 * 1024,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_maximum_chunk_cache_size(
+	          handle,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_initialize(
+	          &closed_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_set_maximum_chunk_cache_size(
+	          closed_handle,
+	          4 * 1024 * 1024,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_handle_free(
+	          &closed_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( closed_handle != NULL )
+	{
+		libewf_handle_free(
+		 &closed_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_advise function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_advise(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error       = NULL;
+	libewf_handle_t *closed_handle = NULL;
+	int result                     = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_advise(
+	          handle,
+	          0,
+	          0,
+	          LIBEWF_ACCESS_ADVICE_SEQUENTIAL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_advise(
+	          handle,
+	          0,
+	          4096,
+	          LIBEWF_ACCESS_ADVICE_RANDOM,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_advise(
+	          handle,
+	          0,
+	          4096,
+	          LIBEWF_ACCESS_ADVICE_DONTNEED,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_advise(
+	          handle,
+	          0,
+	          4096,
+	          LIBEWF_ACCESS_ADVICE_WILLNEED,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_advise(
+	          handle,
+	          0,
+	          0,
+	          LIBEWF_ACCESS_ADVICE_NORMAL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_advise(
+	          NULL,
+	          0,
+	          0,
+	          LIBEWF_ACCESS_ADVICE_NORMAL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_advise(
+	          handle,
+	          -1,
+	          0,
+	          LIBEWF_ACCESS_ADVICE_NORMAL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_advise(
+	          handle,
+	          0,
+	          0,
+	          -1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_initialize(
+	          &closed_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_advise(
+	          closed_handle,
+	          0,
+	          0,
+	          LIBEWF_ACCESS_ADVICE_NORMAL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_handle_free(
+	          &closed_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( closed_handle != NULL )
+	{
+		libewf_handle_free(
+		 &closed_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_open_segment_index and libewf_handle_write_segment_index functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_segment_index(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error       = NULL;
+	libewf_handle_t *closed_handle = NULL;
+	int result                     = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_handle_initialize(
+	          &closed_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_open_segment_index(
+	          closed_handle,
+	          "ewf_test_handle_nonexistent.idx",
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_open_segment_index(
+	          NULL,
+	          "ewf_test_handle_nonexistent.idx",
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_open_segment_index(
+	          closed_handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_write_segment_index(
+	          NULL,
+	          "ewf_test_handle_segment_index.idx",
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_write_segment_index(
+	          handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_write_segment_index(
+	          closed_handle,
+	          "ewf_test_handle_segment_index.idx",
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_handle_free(
+	          &closed_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( closed_handle != NULL )
+	{
+		libewf_handle_free(
+		 &closed_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_chunk_view and libewf_handle_release_chunk_view functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_chunk_view(
+     libewf_handle_t *handle )
+{
+	uint8_t buffer[ 16 ];
+
+	libewf_iovec_t iov[ 1 ];
+
+	libcerror_error_t *error = NULL;
+	const uint8_t *data      = NULL;
+	size64_t media_size      = 0;
+	size_t data_size         = 0;
+	ssize_t read_count       = 0;
+	int result               = 0;
+
+	/* Determine size
+	 */
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	if( media_size > 16 )
+	{
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              16,
+		              0,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libewf_handle_get_chunk_view(
+		          handle,
+		          0,
+		          &data,
+		          &data_size,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "data",
+		 data );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = ( data_size >= 16 );
+
+		EWF_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		result = memory_compare(
+		          data,
+		          buffer,
+		          16 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		/* Test error case where a chunk view is already active
+		 */
+		result = libewf_handle_get_chunk_view(
+		          handle,
+		          0,
+		          &data,
+		          &data_size,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		/* Test error case where a read is done while a chunk view is active
+		 */
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              16,
+		              0,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) -1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		/* Test error case where a vectored read is done while a chunk view is active
+		 */
+		iov[ 0 ].offset      = 0;
+		iov[ 0 ].buffer      = buffer;
+		iov[ 0 ].buffer_size = 16;
+
+		read_count = libewf_handle_read_vector(
+		              handle,
+		              iov,
+		              1,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) -1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		/* The chunk view data remains valid while the chunk view is active
+		 */
+		result = memory_compare(
+		          data,
+		          buffer,
+		          16 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		result = libewf_handle_release_chunk_view(
+		          handle,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* The chunks cache is restored after the chunk view was released
+		 */
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              16,
+		              0,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Retrieve chunk view beyond media_size boundary
+	 */
+	result = libewf_handle_get_chunk_view(
+	          handle,
+	          (off64_t) media_size,
+	          &data,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_chunk_view(
+	          NULL,
+	          0,
+	          &data,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunk_view(
+	          handle,
+	          -1,
+	          &data,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunk_view(
+	          handle,
+	          0,
+	          NULL,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunk_view(
+	          handle,
+	          0,
+	          &data,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_release_chunk_view(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where no chunk view is active
+	 */
+	result = libewf_handle_release_chunk_view(
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_chunk_flags and libewf_handle_get_chunks_flags functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_chunk_flags(
+     libewf_handle_t *handle )
+{
+	uint32_t chunks_flags[ 4 ];
+
+	libcerror_error_t *error = NULL;
+	size64_t media_size      = 0;
+	uint32_t chunk_flags     = 0;
+	int result               = 0;
+
+	/* Determine size
+	 */
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	if( media_size > 0 )
+	{
+		result = libewf_handle_get_chunk_flags(
+		          handle,
+		          0,
+		          &chunk_flags,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libewf_handle_get_chunks_flags(
+		          handle,
+		          0,
+		          chunks_flags,
+		          4,
+		          &error );
+
+		EWF_TEST_ASSERT_GREATER_THAN_INT(
+		 "result",
+		 result,
+		 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		EWF_TEST_ASSERT_EQUAL_UINT32(
+		 "chunks_flags[ 0 ]",
+		 chunks_flags[ 0 ],
+		 chunk_flags );
+	}
+	/* Retrieve chunk flags beyond media_size boundary
+	 */
+	result = libewf_handle_get_chunk_flags(
+	          handle,
+	          (uint64_t) INT64_MAX,
+	          &chunk_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_chunks_flags(
+	          handle,
+	          (uint64_t) INT64_MAX,
+	          chunks_flags,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_chunk_flags(
+	          NULL,
+	          0,
+	          &chunk_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunk_flags(
+	          handle,
+	          0,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunks_flags(
+	          NULL,
+	          0,
+	          chunks_flags,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunks_flags(
+	          handle,
+	          0,
+	          NULL,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunks_flags(
+	          handle,
+	          0,
+	          chunks_flags,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_chunks_storage_values function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_chunks_storage_values(
+     libewf_handle_t *handle )
+{
+	uint32_t chunks_flags[ 4 ];
+	uint32_t chunks_stored_sizes[ 4 ];
+
+	libcerror_error_t *error = NULL;
+	size64_t media_size      = 0;
+	uint32_t chunk_flags     = 0;
+	int result               = 0;
+
+	/* Determine size
+	 */
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	if( media_size > 0 )
+	{
+		result = libewf_handle_get_chunk_flags(
+		          handle,
+		          0,
+		          &chunk_flags,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libewf_handle_get_chunks_storage_values(
+		          handle,
+		          0,
+		          chunks_flags,
+		          chunks_stored_sizes,
+		          4,
+		          &error );
+
+		EWF_TEST_ASSERT_GREATER_THAN_INT(
+		 "result",
+		 result,
+		 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		EWF_TEST_ASSERT_EQUAL_UINT32(
+		 "chunks_flags[ 0 ]",
+		 chunks_flags[ 0 ],
+		 chunk_flags );
+
+		if( ( chunk_flags & ( LIBEWF_CHUNK_FLAG_IS_MISSING | LIBEWF_CHUNK_FLAG_IS_SPARSE ) ) == 0 )
+		{
+			EWF_TEST_ASSERT_NOT_EQUAL_INT(
+			 "chunks_stored_sizes[ 0 ]",
+			 (int) chunks_stored_sizes[ 0 ],
+			 0 );
+		}
+	}
+	/* Retrieve chunk storage values beyond media_size boundary
+	 */
+	result = libewf_handle_get_chunks_storage_values(
+	          handle,
+	          (uint64_t) INT64_MAX,
+	          chunks_flags,
+	          chunks_stored_sizes,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_chunks_storage_values(
+	          NULL,
+	          0,
+	          chunks_flags,
+	          chunks_stored_sizes,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunks_storage_values(
+	          handle,
+	          0,
+	          NULL,
+	          chunks_stored_sizes,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunks_storage_values(
+	          handle,
+	          0,
+	          chunks_flags,
+	          NULL,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunks_storage_values(
+	          handle,
+	          0,
+	          chunks_flags,
+	          chunks_stored_sizes,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_number_of_segments and libewf_handle_get_segment_media_range functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_segment_media_range(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error        = NULL;
+	off64_t expected_media_offset   = 0;
+	off64_t media_offset            = 0;
+	size64_t media_size             = 0;
+	size64_t segment_media_size     = 0;
+	uint32_t number_of_segments     = 0;
+	uint32_t segment_index          = 0;
+	int file_index                  = 0;
+	int result                      = 0;
+
+	/* Determine size
+	 */
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_number_of_segments(
+	          handle,
+	          &number_of_segments,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "number_of_segments",
+	 (int) number_of_segments,
+	 0 );
+
+	/* The media ranges of the segments are contiguous
+	 */
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+		result = libewf_handle_get_segment_media_range(
+		          handle,
+		          segment_index,
+		          &file_index,
+		          &media_offset,
+		          &segment_media_size,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		EWF_TEST_ASSERT_EQUAL_INT64(
+		 "media_offset",
+		 (int64_t) media_offset,
+		 (int64_t) expected_media_offset );
+
+		expected_media_offset += (off64_t) segment_media_size;
+	}
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "expected_media_offset",
+	 (uint64_t) expected_media_offset,
+	 (uint64_t) media_size );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_number_of_segments(
+	          NULL,
+	          &number_of_segments,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_segment_media_range(
+	          NULL,
+	          0,
+	          &file_index,
+	          &media_offset,
+	          &segment_media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_segment_media_range(
+	          handle,
+	          number_of_segments,
+	          &file_index,
+	          &media_offset,
+	          &segment_media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_segment_media_range(
+	          handle,
+	          0,
+	          NULL,
+	          &media_offset,
+	          &segment_media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_segment_media_range(
+	          handle,
+	          0,
+	          &file_index,
+	          NULL,
+	          &segment_media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_segment_media_range(
+	          handle,
+	          0,
+	          &file_index,
+	          &media_offset,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_data_extents function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_data_extents(
+     libewf_handle_t *handle )
+{
+	off64_t extents_offsets[ 4 ];
+	size64_t extents_sizes[ 4 ];
+	uint32_t extents_types[ 4 ];
+
+	libcerror_error_t *error = NULL;
+	size64_t media_size      = 0;
+	int result               = 0;
+
+	/* Determine size
+	 */
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	if( media_size > 0 )
+	{
+		result = libewf_handle_get_data_extents(
+		          handle,
+		          0,
+		          extents_offsets,
+		          extents_sizes,
+		          extents_types,
+		          4,
+		          &error );
+
+		EWF_TEST_ASSERT_GREATER_THAN_INT(
+		 "result",
+		 result,
+		 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		EWF_TEST_ASSERT_EQUAL_INT64(
+		 "extents_offsets[ 0 ]",
+		 (int64_t) extents_offsets[ 0 ],
+		 (int64_t) 0 );
+
+		EWF_TEST_ASSERT_NOT_EQUAL_INT64(
+		 "extents_sizes[ 0 ]",
+		 (int64_t) extents_sizes[ 0 ],
+		 (int64_t) 0 );
+	}
+	/* Retrieve data extents beyond media_size boundary
+	 */
+	result = libewf_handle_get_data_extents(
+	          handle,
+	          (off64_t) media_size,
+	          extents_offsets,
+	          extents_sizes,
+	          extents_types,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_data_extents(
+	          NULL,
+	          0,
+	          extents_offsets,
+	          extents_sizes,
+	          extents_types,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_data_extents(
+	          handle,
+	          -1,
+	          extents_offsets,
+	          extents_sizes,
+	          extents_types,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_data_extents(
+	          handle,
+	          0,
+	          NULL,
+	          extents_sizes,
+	          extents_types,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_data_extents(
+	          handle,
+	          0,
+	          extents_offsets,
+	          extents_sizes,
+	          extents_types,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_data_chunk function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_data_chunk(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error        = NULL;
+	libewf_data_chunk_t *data_chunk = 0;
+	int data_chunk_is_set           = 0;
+	int result                      = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_data_chunk(
+	          handle,
+	          &data_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data_chunk_is_set = result;
+
+	if( data_chunk_is_set != 0 )
+	{
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "data_chunk",
+		 data_chunk );
+
+		result = libewf_data_chunk_free(
+		          &data_chunk,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	result = libewf_handle_get_data_chunk(
+	          NULL,
+	          &data_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "data_chunk",
+	 data_chunk );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( data_chunk_is_set != 0 )
+	{
+		result = libewf_handle_get_data_chunk(
+		          handle,
+		          NULL,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "data_chunk",
+		 data_chunk );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( data_chunk != NULL )
+	{
+		libewf_data_chunk_free(
+		 &data_chunk,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_read_data_chunks function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_read_data_chunks(
+     libewf_handle_t *handle )
+{
+	uint8_t buffer[ 16 ];
+	uint8_t reference_buffer[ 16 ];
+
+	libewf_data_chunk_t *data_chunks[ 4 ] = { NULL, NULL, NULL, NULL };
+	libcerror_error_t *error              = NULL;
+	size64_t media_size                   = 0;
+	ssize_t read_count                    = 0;
+	off64_t offset                        = 0;
+	int data_chunk_index                  = 0;
+	int result                            = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( data_chunk_index = 0;
+	     data_chunk_index < 4;
+	     data_chunk_index++ )
+	{
+		result = libewf_handle_get_data_chunk(
+		          handle,
+		          &( data_chunks[ data_chunk_index ] ),
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "data_chunk",
+		 data_chunks[ data_chunk_index ] );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test regular cases
+	 */
+	if( media_size > 16 )
+	{
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              reference_buffer,
+		              16,
+		              0,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		offset = libewf_handle_seek_offset(
+		          handle,
+		          0,
+		          SEEK_SET,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 (int64_t) offset,
+		 (int64_t) 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libewf_handle_read_data_chunks(
+		          handle,
+		          data_chunks,
+		          4,
+		          &error );
+
+		EWF_TEST_ASSERT_GREATER_THAN_INT(
+		 "result",
+		 result,
+		 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		read_count = libewf_data_chunk_read_buffer(
+		              data_chunks[ 0 ],
+		              buffer,
+		              16,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          buffer,
+		          reference_buffer,
+		          16 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		/* Read data chunks beyond media_size boundary
+		 */
+		offset = libewf_handle_seek_offset(
+		          handle,
+		          (off64_t) media_size,
+		          SEEK_SET,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 (int64_t) offset,
+		 (int64_t) media_size );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libewf_handle_read_data_chunks(
+		          handle,
+		          data_chunks,
+		          4,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	result = libewf_handle_read_data_chunks(
+	          NULL,
+	          data_chunks,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_read_data_chunks(
+	          handle,
+	          NULL,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_read_data_chunks(
+	          handle,
+	          data_chunks,
+	          -1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	for( data_chunk_index = 0;
+	     data_chunk_index < 4;
+	     data_chunk_index++ )
+	{
+		result = libewf_data_chunk_free(
+		          &( data_chunks[ data_chunk_index ] ),
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Reset the offset
+	 */
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	for( data_chunk_index = 0;
+	     data_chunk_index < 4;
+	     data_chunk_index++ )
+	{
+		if( data_chunks[ data_chunk_index ] != NULL )
+		{
+			libewf_data_chunk_free(
+			 &( data_chunks[ data_chunk_index ] ),
+			 NULL );
+		}
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_stream_open, libewf_handle_stream_read and libewf_handle_stream_close functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_stream_read(
+     libewf_handle_t *handle )
+{
+	uint8_t buffer[ 4096 ];
+	uint8_t reference_buffer[ 4096 ];
+
+	libcerror_error_t *error = NULL;
+	size64_t media_size      = 0;
+	size_t read_size         = 0;
+	ssize_t read_count       = 0;
+	off64_t offset           = 0;
+	int result               = 0;
+	int stream_is_open       = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_size = 4096;
+
+	if( media_size < (size64_t) read_size )
+	{
+		read_size = (size_t) media_size;
+	}
+	read_count = libewf_handle_read_buffer_at_offset(
+	              handle,
+	              reference_buffer,
+	              read_size,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) read_size );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_stream_open(
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	stream_is_open = 1;
+
+	if( read_size > 16 )
+	{
+		/* Read the data in 2 parts to test reading the remainder of a retained chunk
+		 */
+		read_count = libewf_handle_stream_read(
+		              handle,
+		              buffer,
+		              16,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		read_count = libewf_handle_stream_read(
+		              handle,
+		              &( buffer[ 16 ] ),
+		              read_size - 16,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) ( read_size - 16 ) );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          buffer,
+		          reference_buffer,
+		          read_size );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Read buffer beyond media_size boundary
+	 */
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          (off64_t) media_size,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) media_size );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libewf_handle_stream_read(
+	              handle,
+	              buffer,
+	              16,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_stream_open(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_stream_open(
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_handle_stream_read(
+	              NULL,
+	              buffer,
+	              16,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_handle_stream_read(
+	              handle,
+	              NULL,
+	              16,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_handle_stream_read(
+	              handle,
+	              buffer,
+	              (size_t) SSIZE_MAX + 1,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_stream_close(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_handle_stream_close(
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	stream_is_open = 0;
+
+	/* Test reading when the stream reader is not opened
+	 */
+	read_count = libewf_handle_stream_read(
+	              handle,
+	              buffer,
+	              16,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Reset the offset
+	 */
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stream_is_open != 0 )
+	{
+		libewf_handle_stream_close(
+		 handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_seek_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_seek_offset(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	size64_t size            = 0;
+	off64_t offset           = 0;
+
+	/* Test regular cases
+	 */
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_END,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	size = (size64_t) offset;
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          1024,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 1024 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          -512,
+	          SEEK_CUR,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 512 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          (off64_t) ( size + 512 ),
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) ( size + 512 ) );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Reset offset to 0
+	 */
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	offset = libewf_handle_seek_offset(
+	          NULL,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          -1,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          -1,
+	          SEEK_CUR,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          (off64_t) ( -1 * ( size + 1 ) ),
+	          SEEK_END,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_offset(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	off64_t offset           = 0;
+	int offset_is_set        = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_offset(
+	          handle,
+	          &offset,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_offset(
+	          NULL,
+	          &offset,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( offset_is_set != 0 )
+	{
+		result = libewf_handle_get_offset(
+		          handle,
+		          NULL,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_maximum_number_of_cached_chunks and libewf_handle_set_maximum_number_of_cached_chunks functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_maximum_number_of_cached_chunks(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error            = NULL;
+	int maximum_number_of_cached_chunks = 0;
+	int result                          = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_maximum_number_of_cached_chunks(
+	          handle,
+	          &maximum_number_of_cached_chunks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_GREATER_THAN_INT(
+	 "maximum_number_of_cached_chunks",
+	 maximum_number_of_cached_chunks,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_set_maximum_number_of_cached_chunks(
+	          handle,
+	          maximum_number_of_cached_chunks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_maximum_number_of_cached_chunks(
+	          NULL,
+	          &maximum_number_of_cached_chunks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_maximum_number_of_cached_chunks(
+	          handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_maximum_number_of_cached_chunks(
+	          NULL,
+	          maximum_number_of_cached_chunks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_maximum_number_of_cached_chunks(
+	          handle,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_maximum_number_of_cached_chunk_groups and libewf_handle_set_maximum_number_of_cached_chunk_groups functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_maximum_number_of_cached_chunk_groups(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error                  = NULL;
+	int maximum_number_of_cached_chunk_groups = 0;
+	int result                                = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_maximum_number_of_cached_chunk_groups(
+	          handle,
+	          &maximum_number_of_cached_chunk_groups,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_GREATER_THAN_INT(
+	 "maximum_number_of_cached_chunk_groups",
+	 maximum_number_of_cached_chunk_groups,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_set_maximum_number_of_cached_chunk_groups(
+	          handle,
+	          maximum_number_of_cached_chunk_groups,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_maximum_number_of_cached_chunk_groups(
+	          NULL,
+	          &maximum_number_of_cached_chunk_groups,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_maximum_number_of_cached_chunk_groups(
+	          handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_maximum_number_of_cached_chunk_groups(
+	          handle,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_memory_limit and libewf_handle_set_memory_limit functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_memory_limit(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	size64_t memory_limit    = 0;
+	uint64_t peak_value      = 0;
+	uint64_t value           = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_set_memory_limit(
+	          handle,
+	          16 * 1024 * 1024,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_memory_limit(
+	          handle,
+	          &memory_limit,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "memory_limit",
+	 (uint64_t) memory_limit,
+	 (uint64_t) 16 * 1024 * 1024 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_statistics_value(
+	          handle,
+	          LIBEWF_STATISTIC_MEMORY_LIMIT,
+	          &value,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "value",
+	 value,
+	 (uint64_t) 16 * 1024 * 1024 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_statistics_value(
+	          handle,
+	          LIBEWF_STATISTIC_MEMORY_USAGE,
+	          &value,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_statistics_value(
+	          handle,
+	          LIBEWF_STATISTIC_CHUNK_DATA_MEMORY_SIZE,
+	          &value,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_statistics_value(
+	          handle,
+	          LIBEWF_STATISTIC_CHUNK_DATA_PEAK_MEMORY_SIZE,
+	          &peak_value,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "peak_value >= value",
+	 (int) ( peak_value >= value ),
+	 1 );
+
+	result = libewf_handle_set_memory_limit(
+	          handle,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_memory_limit(
+	          NULL,
+	          &memory_limit,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_memory_limit(
+	          handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_memory_limit(
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_chunks_cache_statistics function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_chunks_cache_statistics(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error        = NULL;
+	uint64_t number_of_cache_hits   = 0;
+	uint64_t number_of_cache_misses = 0;
+	int result                      = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_chunks_cache_statistics(
+	          handle,
+	          &number_of_cache_hits,
+	          &number_of_cache_misses,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_chunks_cache_statistics(
+	          NULL,
+	          &number_of_cache_hits,
+	          &number_of_cache_misses,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunks_cache_statistics(
+	          handle,
+	          NULL,
+	          &number_of_cache_misses,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunks_cache_statistics(
+	          handle,
+	          &number_of_cache_hits,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_number_of_read_ahead_chunks and libewf_handle_set_number_of_read_ahead_chunks functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_number_of_read_ahead_chunks(
+     libewf_handle_t *handle )
+{
+	uint8_t buffer[ 16 ];
+
+	libcerror_error_t *error        = NULL;
+	size64_t media_size             = 0;
+	ssize_t read_count              = 0;
+	off64_t offset                  = 0;
+	int number_of_read_ahead_chunks = 0;
+	int result                      = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_number_of_read_ahead_chunks(
+	          handle,
+	          &number_of_read_ahead_chunks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_read_ahead_chunks",
+	 number_of_read_ahead_chunks,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_set_number_of_read_ahead_chunks(
+	          handle,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( media_size > 32 )
+	{
+		offset = libewf_handle_seek_offset(
+		          handle,
+		          0,
+		          SEEK_SET,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 offset,
+		 (int64_t) 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Sequential reads trigger the read ahead
+		 */
+		read_count = libewf_handle_read_buffer(
+		              handle,
+		              buffer,
+		              16,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		read_count = libewf_handle_read_buffer(
+		              handle,
+		              buffer,
+		              16,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libewf_handle_set_number_of_read_ahead_chunks(
+	          handle,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_number_of_read_ahead_chunks(
+	          NULL,
+	          &number_of_read_ahead_chunks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_number_of_read_ahead_chunks(
+	          handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_number_of_read_ahead_chunks(
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_number_of_read_ahead_chunks(
+	          handle,
+	          -1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_segment_prefetch_size and libewf_handle_set_segment_prefetch_size functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_segment_prefetch_size(
+     libewf_handle_t *handle )
+{
+	uint8_t buffer[ 16 ];
+
+	libcerror_error_t *error       = NULL;
+	size64_t media_size            = 0;
+	size64_t segment_prefetch_size = 0;
+	ssize_t read_count             = 0;
+	off64_t offset                 = 0;
+	int result                     = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_segment_prefetch_size(
+	          handle,
+	          &segment_prefetch_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "segment_prefetch_size",
+	 (uint64_t) segment_prefetch_size,
+	 (uint64_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A segment prefetch size of the media size prefetches the next segment file on every sequential read
+	 */
+	result = libewf_handle_set_segment_prefetch_size(
+	          handle,
+	          media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( media_size > 32 )
+	{
+		offset = libewf_handle_seek_offset(
+		          handle,
+		          0,
+		          SEEK_SET,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 offset,
+		 (int64_t) 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Sequential reads trigger the segment prefetch
+		 */
+		read_count = libewf_handle_read_buffer(
+		              handle,
+		              buffer,
+		              16,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		read_count = libewf_handle_read_buffer(
+		              handle,
+		              buffer,
+		              16,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libewf_handle_set_segment_prefetch_size(
+	          handle,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_segment_prefetch_size(
+	          NULL,
+	          &segment_prefetch_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_segment_prefetch_size(
+	          handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_segment_prefetch_size(
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_read_priority and libewf_handle_set_read_priority functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_read_priority(
+     libewf_handle_t *handle )
+{
+	uint8_t buffer[ 16 ];
+
+	libcerror_error_t *error = NULL;
+	size64_t media_size      = 0;
+	ssize_t read_count       = 0;
+	int read_priority        = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_read_priority(
+	          handle,
+	          &read_priority,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "read_priority",
+	 read_priority,
+	 LIBEWF_READ_PRIORITY_INTERACTIVE );
+
+	result = libewf_handle_set_read_priority(
+	          handle,
+	          LIBEWF_READ_PRIORITY_BACKGROUND,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_read_priority(
+	          handle,
+	          &read_priority,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "read_priority",
+	 read_priority,
+	 LIBEWF_READ_PRIORITY_BACKGROUND );
+
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( media_size > 16 )
+	{
+		/* Reads with the background priority return the same data
+		 */
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              16,
+		              0,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libewf_handle_set_read_priority(
+	          handle,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_read_priority(
+	          NULL,
+	          &read_priority,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_read_priority(
+	          handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_read_priority(
+	          NULL,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_read_priority(
+	          handle,
+	          -1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_number_of_threads and libewf_handle_set_number_of_threads functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_number_of_threads(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error  = NULL;
+	uint8_t *buffer           = NULL;
+	uint8_t *reference_buffer = NULL;
+	size64_t media_size       = 0;
+	size_t buffer_size        = 0;
+	ssize_t read_count        = 0;
+	size32_t chunk_size       = 0;
+	int number_of_threads     = 0;
+	int result                = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_number_of_threads(
+	          handle,
+	          &number_of_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_threads",
+	 number_of_threads,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_chunk_size(
+	          handle,
+	          &chunk_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Read a buffer that spans multiple chunks using the calling thread
+	 * and using the worker threads and compare the results
+	 */
+	if( ( chunk_size > 0 )
+	 && ( media_size > ( (size64_t) chunk_size * 2 ) ) )
+	{
+		buffer_size = (size_t) chunk_size * 2;
+
+		reference_buffer = (uint8_t *) memory_allocate(
+		                                sizeof( uint8_t ) * buffer_size );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "reference_buffer",
+		 reference_buffer );
+
+		buffer = (uint8_t *) memory_allocate(
+		                      sizeof( uint8_t ) * buffer_size );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "buffer",
+		 buffer );
+
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              reference_buffer,
+		              buffer_size,
+		              (off64_t) chunk_size / 2,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) buffer_size );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libewf_handle_set_number_of_threads(
+		          handle,
+		          2,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              buffer_size,
+		              (off64_t) chunk_size / 2,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) buffer_size );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          buffer,
+		          reference_buffer,
+		          buffer_size );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		memory_free(
+		 buffer );
+
+		buffer = NULL;
+
+		memory_free(
+		 reference_buffer );
+
+		reference_buffer = NULL;
+	}
+	result = libewf_handle_set_number_of_threads(
+	          handle,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_number_of_threads(
+	          NULL,
+	          &number_of_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_number_of_threads(
+	          handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_number_of_threads(
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_number_of_threads(
+	          handle,
+	          -1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	if( reference_buffer != NULL )
+	{
+		memory_free(
+		 reference_buffer );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_decompression_backend and libewf_handle_set_decompression_backend functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_decompression_backend(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error  = NULL;
+	int decompression_backend = 0;
+	int result                = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_decompression_backend(
+	          handle,
+	          &decompression_backend,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "decompression_backend",
+	 decompression_backend,
+	 LIBEWF_DECOMPRESSION_BACKEND_DEFAULT );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_set_decompression_backend(
+	          handle,
+	          LIBEWF_DECOMPRESSION_BACKEND_BUILT_IN,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_decompression_backend(
+	          handle,
+	          &decompression_backend,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "decompression_backend",
+	 decompression_backend,
+	 LIBEWF_DECOMPRESSION_BACKEND_BUILT_IN );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_set_decompression_backend(
+	          handle,
+	          LIBEWF_DECOMPRESSION_BACKEND_DEFAULT,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_decompression_backend(
+	          NULL,
+	          &decompression_backend,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_decompression_backend(
+	          handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_decompression_backend(
+	          NULL,
+	          LIBEWF_DECOMPRESSION_BACKEND_DEFAULT,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_decompression_backend(
+	          handle,
+	          -1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Batch decompression function that does not decompress any chunks, as without a device
+ * Returns 0 to indicate that no chunks were decompressed
+ */
+int ewf_test_handle_batch_decompression_function(
+     int number_of_chunks,
+     const uint8_t **compressed_data EWF_TEST_ATTRIBUTE_UNUSED,
+     const size_t *compressed_data_sizes EWF_TEST_ATTRIBUTE_UNUSED,
+     uint8_t **data EWF_TEST_ATTRIBUTE_UNUSED,
+     size_t *data_sizes EWF_TEST_ATTRIBUTE_UNUSED,
+     void *function_data,
+     libcerror_error_t **error EWF_TEST_ATTRIBUTE_UNUSED )
+{
+	int *number_of_offered_chunks = (int *) function_data;
+
+	EWF_TEST_UNREFERENCED_PARAMETER( compressed_data )
+	EWF_TEST_UNREFERENCED_PARAMETER( compressed_data_sizes )
+	EWF_TEST_UNREFERENCED_PARAMETER( data )
+	EWF_TEST_UNREFERENCED_PARAMETER( data_sizes )
+	EWF_TEST_UNREFERENCED_PARAMETER( error )
+
+	if( number_of_offered_chunks != NULL )
+	{
+		*number_of_offered_chunks += number_of_chunks;
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_set_batch_decompression_function function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_set_batch_decompression_function(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error     = NULL;
+	uint8_t *buffer              = NULL;
+	uint8_t *reference_buffer    = NULL;
+	size64_t media_size          = 0;
+	size_t buffer_size           = 0;
+	ssize_t read_count           = 0;
+	size32_t chunk_size          = 0;
+	int number_of_offered_chunks = 0;
+	int result                   = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_chunk_size(
+	          handle,
+	          &chunk_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Chunks that are not decompressed by the batch decompression function
+	 * are decompressed by the worker threads
+	 */
+	if( ( chunk_size > 0 )
+	 && ( media_size > ( (size64_t) chunk_size * 2 ) ) )
+	{
+		buffer_size = (size_t) chunk_size * 2;
+
+		reference_buffer = (uint8_t *) memory_allocate(
+		                                sizeof( uint8_t ) * buffer_size );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "reference_buffer",
+		 reference_buffer );
+
+		buffer = (uint8_t *) memory_allocate(
+		                      sizeof( uint8_t ) * buffer_size );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "buffer",
+		 buffer );
+
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              reference_buffer,
+		              buffer_size,
+		              (off64_t) chunk_size / 2,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) buffer_size );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
 		 error );
 
-		/* Set offset to media_size - 8
-		 */
-		offset = libewf_handle_seek_offset(
+		result = libewf_handle_set_batch_decompression_function(
 		          handle,
-		          -8,
-		          SEEK_END,
+		          &ewf_test_handle_batch_decompression_function,
+		          (void *) &number_of_offered_chunks,
 		          &error );
 
-		EWF_TEST_ASSERT_EQUAL_INT64(
-		 "offset",
-		 offset,
-		 (int64_t) media_size - 8 );
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
 
 		EWF_TEST_ASSERT_IS_NULL(
 		 "error",
 		 error );
 
-		/* Read buffer on media_size boundary
-		 */
-		read_count = libewf_handle_read_buffer(
-		              handle,
-		              buffer,
-		              16,
-		              &error );
+		result = libewf_handle_set_number_of_threads(
+		          handle,
+		          2,
+		          &error );
 
-		EWF_TEST_ASSERT_EQUAL_SSIZE(
-		 "read_count",
-		 read_count,
-		 (ssize_t) 8 );
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
 
 		EWF_TEST_ASSERT_IS_NULL(
 		 "error",
 		 error );
 
-		/* Read buffer beyond media_size boundary
-		 */
-		read_count = libewf_handle_read_buffer(
+		read_count = libewf_handle_read_buffer_at_offset(
 		              handle,
 		              buffer,
-		              16,
+		              buffer_size,
+		              (off64_t) chunk_size / 2,
 		              &error );
 
 		EWF_TEST_ASSERT_EQUAL_SSIZE(
 		 "read_count",
 		 read_count,
-		 (ssize_t) 0 );
+		 (ssize_t) buffer_size );
 
 		EWF_TEST_ASSERT_IS_NULL(
 		 "error",
 		 error );
 
-		/* Reset offset to 0
-		 */
-		offset = libewf_handle_seek_offset(
+		result = memory_compare(
+		          buffer,
+		          reference_buffer,
+		          buffer_size );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		memory_free(
+		 buffer );
+
+		buffer = NULL;
+
+		memory_free(
+		 reference_buffer );
+
+		reference_buffer = NULL;
+
+		result = libewf_handle_set_number_of_threads(
 		          handle,
 		          0,
-		          SEEK_SET,
 		          &error );
 
-		EWF_TEST_ASSERT_EQUAL_INT64(
-		 "offset",
-		 offset,
-		 (int64_t) 0 );
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
 
 		EWF_TEST_ASSERT_IS_NULL(
 		 "error",
 		 error );
 	}
+	result = libewf_handle_set_batch_decompression_function(
+	          handle,
+	          NULL,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	/* Test error cases
 	 */
-	read_count = libewf_handle_read_buffer(
-	              NULL,
-	              buffer,
-	              16,
-	              &error );
+	result = libewf_handle_set_batch_decompression_function(
+	          NULL,
+	          &ewf_test_handle_batch_decompression_function,
+	          NULL,
+	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -1567,16 +7515,73 @@ int ewf_test_handle_read_buffer(
 	libcerror_error_free(
 	 &error );
 
-	read_count = libewf_handle_read_buffer(
-	              handle,
-	              NULL,
-	              16,
-	              &error );
+	return( 1 );
 
-	EWF_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	if( reference_buffer != NULL )
+	{
+		memory_free(
+		 reference_buffer );
+	}
+	libewf_handle_set_batch_decompression_function(
+	 handle,
+	 NULL,
+	 NULL,
+	 NULL );
+
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_segment_filename_size function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_segment_filename_size(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error         = NULL;
+	size_t segment_filename_size     = 0;
+	int result                       = 0;
+	int segment_filename_size_is_set = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_segment_filename_size(
+	          handle,
+	          &segment_filename_size,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	segment_filename_size_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_segment_filename_size(
+	          NULL,
+	          &segment_filename_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -1585,24 +7590,25 @@ int ewf_test_handle_read_buffer(
 	libcerror_error_free(
 	 &error );
 
-	read_count = libewf_handle_read_buffer(
-	              handle,
-	              buffer,
-	              (size_t) SSIZE_MAX + 1,
-	              &error );
-
-	EWF_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+	if( segment_filename_size_is_set != 0 )
+	{
+		result = libewf_handle_get_segment_filename_size(
+		          handle,
+		          NULL,
+		          &error );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
 
-	libcerror_error_free(
-	 &error );
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
 
+		libcerror_error_free(
+		 &error );
+	}
 	return( 1 );
 
 on_error:
@@ -1614,123 +7620,128 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_read_buffer_at_offset function
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Tests the libewf_handle_get_segment_filename_size_wide function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_read_buffer_at_offset(
+int ewf_test_handle_get_segment_filename_size_wide(
      libewf_handle_t *handle )
 {
-	uint8_t buffer[ 16 ];
-
-	libcerror_error_t *error = NULL;
-	size64_t media_size      = 0;
-	ssize_t read_count       = 0;
-	int result               = 0;
+	libcerror_error_t *error              = NULL;
+	size_t segment_filename_size_wide     = 0;
+	int result                            = 0;
+	int segment_filename_size_wide_is_set = 0;
 
-	/* Determine size
+	/* Test regular cases
 	 */
-	result = libewf_handle_get_media_size(
+	result = libewf_handle_get_segment_filename_size_wide(
 	          handle,
-	          &media_size,
+	          &segment_filename_size_wide,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT(
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test regular cases
+	segment_filename_size_wide_is_set = result;
+
+	/* Test error cases
 	 */
-	if( media_size > 16 )
-	{
-		read_count = libewf_handle_read_buffer_at_offset(
-		              handle,
-		              buffer,
-		              16,
-		              0,
-		              &error );
+	result = libewf_handle_get_segment_filename_size_wide(
+	          NULL,
+	          &segment_filename_size_wide,
+	          &error );
 
-		EWF_TEST_ASSERT_EQUAL_SSIZE(
-		 "read_count",
-		 read_count,
-		 (ssize_t) 16 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-		EWF_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-		/* Read buffer on media_size boundary
-		 */
-		read_count = libewf_handle_read_buffer_at_offset(
-		              handle,
-		              buffer,
-		              16,
-		              media_size - 8,
-		              &error );
+	libcerror_error_free(
+	 &error );
 
-		EWF_TEST_ASSERT_EQUAL_SSIZE(
-		 "read_count",
-		 read_count,
-		 (ssize_t) 8 );
+	if( segment_filename_size_wide_is_set != 0 )
+	{
+		result = libewf_handle_get_segment_filename_size_wide(
+		          handle,
+		          NULL,
+		          &error );
 
-		EWF_TEST_ASSERT_IS_NULL(
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
 		 "error",
 		 error );
 
-		/* Read buffer beyond media_size boundary
-		 */
-		read_count = libewf_handle_read_buffer_at_offset(
-		              handle,
-		              buffer,
-		              16,
-		              media_size + 8,
-		              &error );
-
-		EWF_TEST_ASSERT_EQUAL_SSIZE(
-		 "read_count",
-		 read_count,
-		 (ssize_t) 0 );
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
 
-		EWF_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
 	}
-	/* Test error cases
+	return( 0 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Tests the libewf_handle_get_maximum_segment_size function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_maximum_segment_size(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error        = NULL;
+	size64_t maximum_segment_size   = 0;
+	int maximum_segment_size_is_set = 0;
+	int result                      = 0;
+
+	/* Test regular cases
 	 */
-	read_count = libewf_handle_read_buffer_at_offset(
-	              NULL,
-	              buffer,
-	              16,
-	              0,
-	              &error );
+	result = libewf_handle_get_maximum_segment_size(
+	          handle,
+	          &maximum_segment_size,
+	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
+	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	maximum_segment_size_is_set = result;
 
-	read_count = libewf_handle_read_buffer_at_offset(
-	              handle,
-	              NULL,
-	              16,
-	              0,
-	              &error );
+	/* Test error cases
+	 */
+	result = libewf_handle_get_maximum_segment_size(
+	          NULL,
+	          &maximum_segment_size,
+	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -1739,36 +7750,76 @@ int ewf_test_handle_read_buffer_at_offset(
 	libcerror_error_free(
 	 &error );
 
-	read_count = libewf_handle_read_buffer_at_offset(
-	              handle,
-	              buffer,
-	              (size_t) SSIZE_MAX + 1,
-	              0,
-	              &error );
+	if( maximum_segment_size_is_set != 0 )
+	{
+		result = libewf_handle_get_maximum_segment_size(
+		          handle,
+		          NULL,
+		          &error );
 
-	EWF_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_filename_size function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_filename_size(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	size_t filename_size     = 0;
+	int filename_size_is_set = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_filename_size(
+	          handle,
+	          &filename_size,
+	          &error );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	filename_size_is_set = result;
 
-	read_count = libewf_handle_read_buffer_at_offset(
-	              handle,
-	              buffer,
-	              16,
-	              -1,
-	              &error );
+	/* Test error cases
+	 */
+	result = libewf_handle_get_filename_size(
+	          NULL,
+	          &filename_size,
+	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -1777,6 +7828,25 @@ int ewf_test_handle_read_buffer_at_offset(
 	libcerror_error_free(
 	 &error );
 
+	if( filename_size_is_set != 0 )
+	{
+		result = libewf_handle_get_filename_size(
+		          handle,
+		          NULL,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
 	return( 1 );
 
 on_error:
@@ -1788,22 +7858,24 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_data_chunk function
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Tests the libewf_handle_get_filename_size_wide function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_data_chunk(
+int ewf_test_handle_get_filename_size_wide(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error        = NULL;
-	libewf_data_chunk_t *data_chunk = 0;
-	int data_chunk_is_set           = 0;
-	int result                      = 0;
+	libcerror_error_t *error      = NULL;
+	size_t filename_size_wide     = 0;
+	int filename_size_wide_is_set = 0;
+	int result                    = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_data_chunk(
+	result = libewf_handle_get_filename_size_wide(
 	          handle,
-	          &data_chunk,
+	          &filename_size_wide,
 	          &error );
 
 	EWF_TEST_ASSERT_NOT_EQUAL_INT(
@@ -1815,32 +7887,93 @@ int ewf_test_handle_get_data_chunk(
 	 "error",
 	 error );
 
-	data_chunk_is_set = result;
+	filename_size_wide_is_set = result;
 
-	if( data_chunk_is_set != 0 )
-	{
-		EWF_TEST_ASSERT_IS_NOT_NULL(
-		 "data_chunk",
-		 data_chunk );
+	/* Test error cases
+	 */
+	result = libewf_handle_get_filename_size_wide(
+	          NULL,
+	          &filename_size_wide,
+	          &error );
 
-		result = libewf_data_chunk_free(
-		          &data_chunk,
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( filename_size_wide_is_set != 0 )
+	{
+		result = libewf_handle_get_filename_size_wide(
+		          handle,
+		          NULL,
 		          &error );
 
 		EWF_TEST_ASSERT_EQUAL_INT(
 		 "result",
 		 result,
-		 1 );
+		 -1 );
 
-		EWF_TEST_ASSERT_IS_NULL(
+		EWF_TEST_ASSERT_IS_NOT_NULL(
 		 "error",
 		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
 	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Tests the libewf_handle_get_file_io_handle function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_file_io_handle(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error         = NULL;
+	libbfio_handle_t *file_io_handle = 0;
+	int file_io_handle_is_set        = 0;
+	int result                       = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_file_io_handle(
+	          handle,
+	          &file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	file_io_handle_is_set = result;
+
 	/* Test error cases
 	 */
-	result = libewf_handle_get_data_chunk(
+	result = libewf_handle_get_file_io_handle(
 	          NULL,
-	          &data_chunk,
+	          &file_io_handle,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -1848,10 +7981,6 @@ int ewf_test_handle_get_data_chunk(
 	 result,
 	 -1 );
 
-	EWF_TEST_ASSERT_IS_NULL(
-	 "data_chunk",
-	 data_chunk );
-
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
@@ -1859,9 +7988,9 @@ int ewf_test_handle_get_data_chunk(
 	libcerror_error_free(
 	 &error );
 
-	if( data_chunk_is_set != 0 )
+	if( file_io_handle_is_set != 0 )
 	{
-		result = libewf_handle_get_data_chunk(
+		result = libewf_handle_get_file_io_handle(
 		          handle,
 		          NULL,
 		          &error );
@@ -1871,10 +8000,6 @@ int ewf_test_handle_get_data_chunk(
 		 result,
 		 -1 );
 
-		EWF_TEST_ASSERT_IS_NULL(
-		 "data_chunk",
-		 data_chunk );
-
 		EWF_TEST_ASSERT_IS_NOT_NULL(
 		 "error",
 		 error );
@@ -1890,101 +8015,168 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( data_chunk != NULL )
-	{
-		libewf_data_chunk_free(
-		 &data_chunk,
-		 NULL );
-	}
 	return( 0 );
 }
 
-/* Tests the libewf_handle_seek_offset function
+/* Tests the libewf_handle_get_root_file_entry function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_seek_offset(
+int ewf_test_handle_get_root_file_entry(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error = NULL;
-	size64_t size            = 0;
-	off64_t offset           = 0;
+	libcerror_error_t *error             = NULL;
+	libewf_file_entry_t *root_file_entry = 0;
+	int result                           = 0;
+	int root_file_entry_is_set           = 0;
 
 	/* Test regular cases
 	 */
-	offset = libewf_handle_seek_offset(
+	result = libewf_handle_get_root_file_entry(
 	          handle,
-	          0,
-	          SEEK_END,
+	          &root_file_entry,
 	          &error );
 
-	EWF_TEST_ASSERT_NOT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	size = (size64_t) offset;
+	root_file_entry_is_set = result;
 
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          1024,
-	          SEEK_SET,
+	if( root_file_entry_is_set != 0 )
+	{
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "root_file_entry",
+		 root_file_entry );
+
+		result = libewf_file_entry_free(
+		          &root_file_entry,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	result = libewf_handle_get_root_file_entry(
+	          NULL,
+	          &root_file_entry,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 1024 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
+	 "root_file_entry",
+	 root_file_entry );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          -512,
-	          SEEK_CUR,
-	          &error );
+	libcerror_error_free(
+	 &error );
+
+	if( root_file_entry_is_set != 0 )
+	{
+		result = libewf_handle_get_root_file_entry(
+		          handle,
+		          NULL,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "root_file_entry",
+		 root_file_entry );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 512 );
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
 
-	EWF_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( root_file_entry != NULL )
+	{
+		libewf_file_entry_free(
+		 &root_file_entry,
+		 NULL );
+	}
+	return( 0 );
+}
 
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          (off64_t) ( size + 512 ),
-	          SEEK_SET,
-	          &error );
+/* Callback function for the libewf_handle_read_file_entries_data test
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_handle_read_file_entries_data_callback(
+     libewf_file_entry_t *file_entry,
+     off64_t offset,
+     const uint8_t *data,
+     size_t data_size,
+     void *callback_data,
+     libcerror_error_t **error EWF_TEST_ATTRIBUTE_UNUSED )
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( error )
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) ( size + 512 ) );
+	if( ( file_entry == NULL )
+	 || ( offset < 0 )
+	 || ( data == NULL )
+	 || ( data_size == 0 )
+	 || ( callback_data == NULL ) )
+	{
+		return( -1 );
+	}
+	*( (size64_t *) callback_data ) += data_size;
 
-	EWF_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
+	return( 1 );
+}
 
-	/* Reset offset to 0
+/* Tests the libewf_handle_read_file_entries_data function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_read_file_entries_data(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	size64_t total_data_size = 0;
+	int result               = 0;
+
+	/* Test regular cases
 	 */
-	offset = libewf_handle_seek_offset(
+	result = libewf_handle_read_file_entries_data(
 	          handle,
-	          0,
-	          SEEK_SET,
+	          &ewf_test_handle_read_file_entries_data_callback,
+	          (void *) &total_data_size,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 0 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
@@ -1992,34 +8184,16 @@ int ewf_test_handle_seek_offset(
 
 	/* Test error cases
 	 */
-	offset = libewf_handle_seek_offset(
+	result = libewf_handle_read_file_entries_data(
 	          NULL,
-	          0,
-	          SEEK_SET,
-	          &error );
-
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
-
-	EWF_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
-
-	libcerror_error_free(
-	 &error );
-
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          -1,
-	          SEEK_SET,
+	          &ewf_test_handle_read_file_entries_data_callback,
+	          (void *) &total_data_size,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -2028,31 +8202,16 @@ int ewf_test_handle_seek_offset(
 	libcerror_error_free(
 	 &error );
 
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          -1,
-	          SEEK_CUR,
-	          &error );
-
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
-
-	EWF_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
-
-	offset = libewf_handle_seek_offset(
+	result = libewf_handle_read_file_entries_data(
 	          handle,
-	          (off64_t) ( -1 * ( size + 1 ) ),
-	          SEEK_END,
+	          NULL,
+	          (void *) &total_data_size,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -2072,22 +8231,22 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_offset function
+/* Tests the libewf_handle_get_sectors_per_chunk function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_offset(
+int ewf_test_handle_get_sectors_per_chunk(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error = NULL;
-	off64_t offset           = 0;
-	int offset_is_set        = 0;
-	int result               = 0;
+	libcerror_error_t *error     = NULL;
+	uint32_t sectors_per_chunk   = 0;
+	int result                   = 0;
+	int sectors_per_chunk_is_set = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_offset(
+	result = libewf_handle_get_sectors_per_chunk(
 	          handle,
-	          &offset,
+	          &sectors_per_chunk,
 	          &error );
 
 	EWF_TEST_ASSERT_NOT_EQUAL_INT(
@@ -2099,13 +8258,13 @@ int ewf_test_handle_get_offset(
 	 "error",
 	 error );
 
-	offset_is_set = result;
+	sectors_per_chunk_is_set = result;
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_offset(
+	result = libewf_handle_get_sectors_per_chunk(
 	          NULL,
-	          &offset,
+	          &sectors_per_chunk,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -2120,9 +8279,9 @@ int ewf_test_handle_get_offset(
 	libcerror_error_free(
 	 &error );
 
-	if( offset_is_set != 0 )
+	if( sectors_per_chunk_is_set != 0 )
 	{
-		result = libewf_handle_get_offset(
+		result = libewf_handle_get_sectors_per_chunk(
 		          handle,
 		          NULL,
 		          &error );
@@ -2150,22 +8309,22 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_segment_filename_size function
+/* Tests the libewf_handle_get_bytes_per_sector function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_segment_filename_size(
+int ewf_test_handle_get_bytes_per_sector(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error         = NULL;
-	size_t segment_filename_size     = 0;
-	int result                       = 0;
-	int segment_filename_size_is_set = 0;
+	libcerror_error_t *error    = NULL;
+	uint32_t bytes_per_sector   = 0;
+	int bytes_per_sector_is_set = 0;
+	int result                  = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_segment_filename_size(
+	result = libewf_handle_get_bytes_per_sector(
 	          handle,
-	          &segment_filename_size,
+	          &bytes_per_sector,
 	          &error );
 
 	EWF_TEST_ASSERT_NOT_EQUAL_INT(
@@ -2177,13 +8336,13 @@ int ewf_test_handle_get_segment_filename_size(
 	 "error",
 	 error );
 
-	segment_filename_size_is_set = result;
+	bytes_per_sector_is_set = result;
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_segment_filename_size(
+	result = libewf_handle_get_bytes_per_sector(
 	          NULL,
-	          &segment_filename_size,
+	          &bytes_per_sector,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -2198,9 +8357,9 @@ int ewf_test_handle_get_segment_filename_size(
 	libcerror_error_free(
 	 &error );
 
-	if( segment_filename_size_is_set != 0 )
+	if( bytes_per_sector_is_set != 0 )
 	{
-		result = libewf_handle_get_segment_filename_size(
+		result = libewf_handle_get_bytes_per_sector(
 		          handle,
 		          NULL,
 		          &error );
@@ -2228,24 +8387,22 @@ on_error:
 	return( 0 );
 }
 
-#if defined( HAVE_WIDE_CHARACTER_TYPE )
-
-/* Tests the libewf_handle_get_segment_filename_size_wide function
+/* Tests the libewf_handle_get_number_of_sectors function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_segment_filename_size_wide(
+int ewf_test_handle_get_number_of_sectors(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error              = NULL;
-	size_t segment_filename_size_wide     = 0;
-	int result                            = 0;
-	int segment_filename_size_wide_is_set = 0;
+	libcerror_error_t *error     = NULL;
+	uint64_t number_of_sectors   = 0;
+	int number_of_sectors_is_set = 0;
+	int result                   = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_segment_filename_size_wide(
+	result = libewf_handle_get_number_of_sectors(
 	          handle,
-	          &segment_filename_size_wide,
+	          &number_of_sectors,
 	          &error );
 
 	EWF_TEST_ASSERT_NOT_EQUAL_INT(
@@ -2257,13 +8414,13 @@ int ewf_test_handle_get_segment_filename_size_wide(
 	 "error",
 	 error );
 
-	segment_filename_size_wide_is_set = result;
+	number_of_sectors_is_set = result;
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_segment_filename_size_wide(
+	result = libewf_handle_get_number_of_sectors(
 	          NULL,
-	          &segment_filename_size_wide,
+	          &number_of_sectors,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -2278,9 +8435,9 @@ int ewf_test_handle_get_segment_filename_size_wide(
 	libcerror_error_free(
 	 &error );
 
-	if( segment_filename_size_wide_is_set != 0 )
+	if( number_of_sectors_is_set != 0 )
 	{
-		result = libewf_handle_get_segment_filename_size_wide(
+		result = libewf_handle_get_number_of_sectors(
 		          handle,
 		          NULL,
 		          &error );
@@ -2308,24 +8465,22 @@ on_error:
 	return( 0 );
 }
 
-#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
-
-/* Tests the libewf_handle_get_maximum_segment_size function
+/* Tests the libewf_handle_get_chunk_size function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_maximum_segment_size(
+int ewf_test_handle_get_chunk_size(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error        = NULL;
-	size64_t maximum_segment_size   = 0;
-	int maximum_segment_size_is_set = 0;
-	int result                      = 0;
+	libcerror_error_t *error = NULL;
+	size32_t chunk_size      = 0;
+	int chunk_size_is_set    = 0;
+	int result               = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_maximum_segment_size(
+	result = libewf_handle_get_chunk_size(
 	          handle,
-	          &maximum_segment_size,
+	          &chunk_size,
 	          &error );
 
 	EWF_TEST_ASSERT_NOT_EQUAL_INT(
@@ -2337,13 +8492,13 @@ int ewf_test_handle_get_maximum_segment_size(
 	 "error",
 	 error );
 
-	maximum_segment_size_is_set = result;
+	chunk_size_is_set = result;
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_maximum_segment_size(
+	result = libewf_handle_get_chunk_size(
 	          NULL,
-	          &maximum_segment_size,
+	          &chunk_size,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -2358,9 +8513,9 @@ int ewf_test_handle_get_maximum_segment_size(
 	libcerror_error_free(
 	 &error );
 
-	if( maximum_segment_size_is_set != 0 )
+	if( chunk_size_is_set != 0 )
 	{
-		result = libewf_handle_get_maximum_segment_size(
+		result = libewf_handle_get_chunk_size(
 		          handle,
 		          NULL,
 		          &error );
@@ -2388,22 +8543,22 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_filename_size function
+/* Tests the libewf_handle_get_error_granularity function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_filename_size(
+int ewf_test_handle_get_error_granularity(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error = NULL;
-	size_t filename_size     = 0;
-	int filename_size_is_set = 0;
-	int result               = 0;
+	libcerror_error_t *error     = NULL;
+	uint32_t error_granularity   = 0;
+	int error_granularity_is_set = 0;
+	int result                   = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_filename_size(
+	result = libewf_handle_get_error_granularity(
 	          handle,
-	          &filename_size,
+	          &error_granularity,
 	          &error );
 
 	EWF_TEST_ASSERT_NOT_EQUAL_INT(
@@ -2415,13 +8570,13 @@ int ewf_test_handle_get_filename_size(
 	 "error",
 	 error );
 
-	filename_size_is_set = result;
+	error_granularity_is_set = result;
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_filename_size(
+	result = libewf_handle_get_error_granularity(
 	          NULL,
-	          &filename_size,
+	          &error_granularity,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -2436,9 +8591,9 @@ int ewf_test_handle_get_filename_size(
 	libcerror_error_free(
 	 &error );
 
-	if( filename_size_is_set != 0 )
+	if( error_granularity_is_set != 0 )
 	{
-		result = libewf_handle_get_filename_size(
+		result = libewf_handle_get_error_granularity(
 		          handle,
 		          NULL,
 		          &error );
@@ -2466,24 +8621,22 @@ on_error:
 	return( 0 );
 }
 
-#if defined( HAVE_WIDE_CHARACTER_TYPE )
-
-/* Tests the libewf_handle_get_filename_size_wide function
+/* Tests the libewf_handle_get_compression_method function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_filename_size_wide(
+int ewf_test_handle_get_compression_method(
      libewf_handle_t *handle )
 {
 	libcerror_error_t *error      = NULL;
-	size_t filename_size_wide     = 0;
-	int filename_size_wide_is_set = 0;
+	uint16_t compression_method   = 0;
+	int compression_method_is_set = 0;
 	int result                    = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_filename_size_wide(
+	result = libewf_handle_get_compression_method(
 	          handle,
-	          &filename_size_wide,
+	          &compression_method,
 	          &error );
 
 	EWF_TEST_ASSERT_NOT_EQUAL_INT(
@@ -2495,13 +8648,13 @@ int ewf_test_handle_get_filename_size_wide(
 	 "error",
 	 error );
 
-	filename_size_wide_is_set = result;
+	compression_method_is_set = result;
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_filename_size_wide(
+	result = libewf_handle_get_compression_method(
 	          NULL,
-	          &filename_size_wide,
+	          &compression_method,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -2516,9 +8669,9 @@ int ewf_test_handle_get_filename_size_wide(
 	libcerror_error_free(
 	 &error );
 
-	if( filename_size_wide_is_set != 0 )
+	if( compression_method_is_set != 0 )
 	{
-		result = libewf_handle_get_filename_size_wide(
+		result = libewf_handle_get_compression_method(
 		          handle,
 		          NULL,
 		          &error );
@@ -2546,24 +8699,22 @@ on_error:
 	return( 0 );
 }
 
-#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
-
-/* Tests the libewf_handle_get_file_io_handle function
+/* Tests the libewf_handle_get_media_size function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_file_io_handle(
+int ewf_test_handle_get_media_size(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error         = NULL;
-	libbfio_handle_t *file_io_handle = 0;
-	int file_io_handle_is_set        = 0;
-	int result                       = 0;
+	libcerror_error_t *error = NULL;
+	size64_t media_size      = 0;
+	int media_size_is_set    = 0;
+	int result               = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_file_io_handle(
+	result = libewf_handle_get_media_size(
 	          handle,
-	          &file_io_handle,
+	          &media_size,
 	          &error );
 
 	EWF_TEST_ASSERT_NOT_EQUAL_INT(
@@ -2575,13 +8726,13 @@ int ewf_test_handle_get_file_io_handle(
 	 "error",
 	 error );
 
-	file_io_handle_is_set = result;
+	media_size_is_set = result;
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_file_io_handle(
+	result = libewf_handle_get_media_size(
 	          NULL,
-	          &file_io_handle,
+	          &media_size,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -2596,9 +8747,9 @@ int ewf_test_handle_get_file_io_handle(
 	libcerror_error_free(
 	 &error );
 
-	if( file_io_handle_is_set != 0 )
+	if( media_size_is_set != 0 )
 	{
-		result = libewf_handle_get_file_io_handle(
+		result = libewf_handle_get_media_size(
 		          handle,
 		          NULL,
 		          &error );
@@ -2626,22 +8777,22 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_root_file_entry function
+/* Tests the libewf_handle_get_media_type function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_root_file_entry(
+int ewf_test_handle_get_media_type(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error             = NULL;
-	libewf_file_entry_t *root_file_entry = 0;
-	int result                           = 0;
-	int root_file_entry_is_set           = 0;
+	libcerror_error_t *error = NULL;
+	uint8_t media_type       = 0;
+	int media_type_is_set    = 0;
+	int result               = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_root_file_entry(
+	result = libewf_handle_get_media_type(
 	          handle,
-	          &root_file_entry,
+	          &media_type,
 	          &error );
 
 	EWF_TEST_ASSERT_NOT_EQUAL_INT(
@@ -2653,32 +8804,13 @@ int ewf_test_handle_get_root_file_entry(
 	 "error",
 	 error );
 
-	root_file_entry_is_set = result;
-
-	if( root_file_entry_is_set != 0 )
-	{
-		EWF_TEST_ASSERT_IS_NOT_NULL(
-		 "root_file_entry",
-		 root_file_entry );
-
-		result = libewf_file_entry_free(
-		          &root_file_entry,
-		          &error );
-
-		EWF_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 1 );
+	media_type_is_set = result;
 
-		EWF_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
-	}
 	/* Test error cases
 	 */
-	result = libewf_handle_get_root_file_entry(
+	result = libewf_handle_get_media_type(
 	          NULL,
-	          &root_file_entry,
+	          &media_type,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -2686,10 +8818,6 @@ int ewf_test_handle_get_root_file_entry(
 	 result,
 	 -1 );
 
-	EWF_TEST_ASSERT_IS_NULL(
-	 "root_file_entry",
-	 root_file_entry );
-
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
@@ -2697,9 +8825,9 @@ int ewf_test_handle_get_root_file_entry(
 	libcerror_error_free(
 	 &error );
 
-	if( root_file_entry_is_set != 0 )
+	if( media_type_is_set != 0 )
 	{
-		result = libewf_handle_get_root_file_entry(
+		result = libewf_handle_get_media_type(
 		          handle,
 		          NULL,
 		          &error );
@@ -2709,10 +8837,6 @@ int ewf_test_handle_get_root_file_entry(
 		 result,
 		 -1 );
 
-		EWF_TEST_ASSERT_IS_NULL(
-		 "root_file_entry",
-		 root_file_entry );
-
 		EWF_TEST_ASSERT_IS_NOT_NULL(
 		 "error",
 		 error );
@@ -2728,31 +8852,25 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( root_file_entry != NULL )
-	{
-		libewf_file_entry_free(
-		 &root_file_entry,
-		 NULL );
-	}
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_sectors_per_chunk function
+/* Tests the libewf_handle_get_media_flags function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_sectors_per_chunk(
+int ewf_test_handle_get_media_flags(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error     = NULL;
-	uint32_t sectors_per_chunk   = 0;
-	int result                   = 0;
-	int sectors_per_chunk_is_set = 0;
+	libcerror_error_t *error = NULL;
+	uint8_t media_flags      = 0;
+	int media_flags_is_set   = 0;
+	int result               = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_sectors_per_chunk(
+	result = libewf_handle_get_media_flags(
 	          handle,
-	          &sectors_per_chunk,
+	          &media_flags,
 	          &error );
 
 	EWF_TEST_ASSERT_NOT_EQUAL_INT(
@@ -2764,13 +8882,13 @@ int ewf_test_handle_get_sectors_per_chunk(
 	 "error",
 	 error );
 
-	sectors_per_chunk_is_set = result;
+	media_flags_is_set = result;
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_sectors_per_chunk(
+	result = libewf_handle_get_media_flags(
 	          NULL,
-	          &sectors_per_chunk,
+	          &media_flags,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -2785,9 +8903,9 @@ int ewf_test_handle_get_sectors_per_chunk(
 	libcerror_error_free(
 	 &error );
 
-	if( sectors_per_chunk_is_set != 0 )
+	if( media_flags_is_set != 0 )
 	{
-		result = libewf_handle_get_sectors_per_chunk(
+		result = libewf_handle_get_media_flags(
 		          handle,
 		          NULL,
 		          &error );
@@ -2815,22 +8933,22 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_bytes_per_sector function
+/* Tests the libewf_handle_get_format function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_bytes_per_sector(
+int ewf_test_handle_get_format(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error    = NULL;
-	uint32_t bytes_per_sector   = 0;
-	int bytes_per_sector_is_set = 0;
-	int result                  = 0;
+	libcerror_error_t *error = NULL;
+	uint8_t format           = 0;
+	int format_is_set        = 0;
+	int result               = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_bytes_per_sector(
+	result = libewf_handle_get_format(
 	          handle,
-	          &bytes_per_sector,
+	          &format,
 	          &error );
 
 	EWF_TEST_ASSERT_NOT_EQUAL_INT(
@@ -2842,13 +8960,13 @@ int ewf_test_handle_get_bytes_per_sector(
 	 "error",
 	 error );
 
-	bytes_per_sector_is_set = result;
+	format_is_set = result;
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_bytes_per_sector(
+	result = libewf_handle_get_format(
 	          NULL,
-	          &bytes_per_sector,
+	          &format,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -2863,9 +8981,9 @@ int ewf_test_handle_get_bytes_per_sector(
 	libcerror_error_free(
 	 &error );
 
-	if( bytes_per_sector_is_set != 0 )
+	if( format_is_set != 0 )
 	{
-		result = libewf_handle_get_bytes_per_sector(
+		result = libewf_handle_get_format(
 		          handle,
 		          NULL,
 		          &error );
@@ -2893,40 +9011,123 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_number_of_sectors function
+/* Tests the libewf_handle_get_read_verify_checksums and libewf_handle_set_read_verify_checksums functions
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_number_of_sectors(
+int ewf_test_handle_get_read_verify_checksums(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error     = NULL;
-	uint64_t number_of_sectors   = 0;
-	int number_of_sectors_is_set = 0;
-	int result                   = 0;
+	libcerror_error_t *error = NULL;
+	uint8_t verify_checksums = 0;
+	int result               = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_number_of_sectors(
+	result = libewf_handle_get_read_verify_checksums(
 	          handle,
-	          &number_of_sectors,
+	          &verify_checksums,
 	          &error );
 
-	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "verify_checksums",
+	 verify_checksums,
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	number_of_sectors_is_set = result;
+	result = libewf_handle_set_read_verify_checksums(
+	          handle,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_read_verify_checksums(
+	          handle,
+	          &verify_checksums,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "verify_checksums",
+	 verify_checksums,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_set_read_verify_checksums(
+	          handle,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_number_of_sectors(
+	result = libewf_handle_get_read_verify_checksums(
+	          NULL,
+	          &verify_checksums,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_read_verify_checksums(
+	          handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_read_verify_checksums(
 	          NULL,
-	          &number_of_sectors,
+	          1,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -2941,25 +9142,6 @@ int ewf_test_handle_get_number_of_sectors(
 	libcerror_error_free(
 	 &error );
 
-	if( number_of_sectors_is_set != 0 )
-	{
-		result = libewf_handle_get_number_of_sectors(
-		          handle,
-		          NULL,
-		          &error );
-
-		EWF_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
-
-		EWF_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
-
-		libcerror_error_free(
-		 &error );
-	}
 	return( 1 );
 
 on_error:
@@ -2971,196 +9153,207 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_chunk_size function
+/* Tests the libewf_handle_get_read_decompress_to_buffer and libewf_handle_set_read_decompress_to_buffer functions
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_chunk_size(
+int ewf_test_handle_get_read_decompress_to_buffer(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error = NULL;
-	size32_t chunk_size      = 0;
-	int chunk_size_is_set    = 0;
-	int result               = 0;
+	libcerror_error_t *error     = NULL;
+	uint8_t *buffer              = NULL;
+	uint8_t *reference_buffer    = NULL;
+	size64_t media_size          = 0;
+	ssize_t read_count           = 0;
+	size32_t chunk_size          = 0;
+	uint8_t decompress_to_buffer = 0;
+	int result                   = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_chunk_size(
+	result = libewf_handle_get_read_decompress_to_buffer(
 	          handle,
-	          &chunk_size,
+	          &decompress_to_buffer,
 	          &error );
 
-	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "decompress_to_buffer",
+	 decompress_to_buffer,
+	 0 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	chunk_size_is_set = result;
-
-	/* Test error cases
-	 */
-	result = libewf_handle_get_chunk_size(
-	          NULL,
-	          &chunk_size,
+	result = libewf_handle_set_read_decompress_to_buffer(
+	          handle,
+	          1,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
+	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	if( chunk_size_is_set != 0 )
-	{
-		result = libewf_handle_get_chunk_size(
-		          handle,
-		          NULL,
-		          &error );
-
-		EWF_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
-
-		EWF_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	result = libewf_handle_get_read_decompress_to_buffer(
+	          handle,
+	          &decompress_to_buffer,
+	          &error );
 
-		libcerror_error_free(
-		 &error );
-	}
-	return( 1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	return( 0 );
-}
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "decompress_to_buffer",
+	 decompress_to_buffer,
+	 1 );
 
-/* Tests the libewf_handle_get_error_granularity function
- * Returns 1 if successful or 0 if not
- */
-int ewf_test_handle_get_error_granularity(
-     libewf_handle_t *handle )
-{
-	libcerror_error_t *error     = NULL;
-	uint32_t error_granularity   = 0;
-	int error_granularity_is_set = 0;
-	int result                   = 0;
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	/* Test regular cases
+	/* Test reading a chunk directly into the buffer
 	 */
-	result = libewf_handle_get_error_granularity(
+	result = libewf_handle_get_media_size(
 	          handle,
-	          &error_granularity,
+	          &media_size,
 	          &error );
 
-	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	error_granularity_is_set = result;
-
-	/* Test error cases
-	 */
-	result = libewf_handle_get_error_granularity(
-	          NULL,
-	          &error_granularity,
+	result = libewf_handle_get_chunk_size(
+	          handle,
+	          &chunk_size,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
+	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	if( error_granularity_is_set != 0 )
+	if( ( chunk_size > 0 )
+	 && ( media_size >= (size64_t) chunk_size ) )
 	{
-		result = libewf_handle_get_error_granularity(
+		buffer = (uint8_t *) memory_allocate(
+		                      sizeof( uint8_t ) * chunk_size );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "buffer",
+		 buffer );
+
+		reference_buffer = (uint8_t *) memory_allocate(
+		                                sizeof( uint8_t ) * chunk_size );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "reference_buffer",
+		 reference_buffer );
+
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              (size_t) chunk_size,
+		              0,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) chunk_size );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libewf_handle_set_read_decompress_to_buffer(
 		          handle,
-		          NULL,
+		          0,
 		          &error );
 
 		EWF_TEST_ASSERT_EQUAL_INT(
 		 "result",
 		 result,
-		 -1 );
+		 1 );
 
-		EWF_TEST_ASSERT_IS_NOT_NULL(
+		EWF_TEST_ASSERT_IS_NULL(
 		 "error",
 		 error );
 
-		libcerror_error_free(
-		 &error );
-	}
-	return( 1 );
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              reference_buffer,
+		              (size_t) chunk_size,
+		              0,
+		              &error );
 
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	return( 0 );
-}
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) chunk_size );
 
-/* Tests the libewf_handle_get_compression_method function
- * Returns 1 if successful or 0 if not
- */
-int ewf_test_handle_get_compression_method(
-     libewf_handle_t *handle )
-{
-	libcerror_error_t *error      = NULL;
-	uint16_t compression_method   = 0;
-	int compression_method_is_set = 0;
-	int result                    = 0;
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
 
-	/* Test regular cases
-	 */
-	result = libewf_handle_get_compression_method(
+		result = memory_compare(
+		          buffer,
+		          reference_buffer,
+		          (size_t) chunk_size );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		memory_free(
+		 reference_buffer );
+
+		reference_buffer = NULL;
+
+		memory_free(
+		 buffer );
+
+		buffer = NULL;
+	}
+	result = libewf_handle_set_read_decompress_to_buffer(
 	          handle,
-	          &compression_method,
+	          0,
 	          &error );
 
-	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	compression_method_is_set = result;
-
 	/* Test error cases
 	 */
-	result = libewf_handle_get_compression_method(
+	result = libewf_handle_get_read_decompress_to_buffer(
 	          NULL,
-	          &compression_method,
+	          &decompress_to_buffer,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3175,70 +9368,26 @@ int ewf_test_handle_get_compression_method(
 	libcerror_error_free(
 	 &error );
 
-	if( compression_method_is_set != 0 )
-	{
-		result = libewf_handle_get_compression_method(
-		          handle,
-		          NULL,
-		          &error );
-
-		EWF_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
-
-		EWF_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
-
-		libcerror_error_free(
-		 &error );
-	}
-	return( 1 );
-
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	return( 0 );
-}
-
-/* Tests the libewf_handle_get_media_size function
- * Returns 1 if successful or 0 if not
- */
-int ewf_test_handle_get_media_size(
-     libewf_handle_t *handle )
-{
-	libcerror_error_t *error = NULL;
-	size64_t media_size      = 0;
-	int media_size_is_set    = 0;
-	int result               = 0;
-
-	/* Test regular cases
-	 */
-	result = libewf_handle_get_media_size(
+	result = libewf_handle_get_read_decompress_to_buffer(
 	          handle,
-	          &media_size,
+	          NULL,
 	          &error );
 
-	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
 	 -1 );
 
-	EWF_TEST_ASSERT_IS_NULL(
+	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	media_size_is_set = result;
+	libcerror_error_free(
+	 &error );
 
-	/* Test error cases
-	 */
-	result = libewf_handle_get_media_size(
+	result = libewf_handle_set_read_decompress_to_buffer(
 	          NULL,
-	          &media_size,
+	          1,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3253,25 +9402,6 @@ int ewf_test_handle_get_media_size(
 	libcerror_error_free(
 	 &error );
 
-	if( media_size_is_set != 0 )
-	{
-		result = libewf_handle_get_media_size(
-		          handle,
-		          NULL,
-		          &error );
-
-		EWF_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
-
-		EWF_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
-
-		libcerror_error_free(
-		 &error );
-	}
 	return( 1 );
 
 on_error:
@@ -3280,43 +9410,128 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( reference_buffer != NULL )
+	{
+		memory_free(
+		 reference_buffer );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	libewf_handle_set_read_decompress_to_buffer(
+	 handle,
+	 0,
+	 NULL );
+
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_media_type function
+/* Tests the libewf_handle_get_use_huge_pages and libewf_handle_set_use_huge_pages functions
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_media_type(
+int ewf_test_handle_get_use_huge_pages(
      libewf_handle_t *handle )
 {
+	uint8_t buffer[ 512 ];
+
 	libcerror_error_t *error = NULL;
-	uint8_t media_type       = 0;
-	int media_type_is_set    = 0;
+	ssize_t read_count       = 0;
+	uint8_t use_huge_pages   = 0;
 	int result               = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_media_type(
+	result = libewf_handle_get_use_huge_pages(
 	          handle,
-	          &media_type,
+	          &use_huge_pages,
 	          &error );
 
-	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "use_huge_pages",
+	 use_huge_pages,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_set_use_huge_pages(
+	          handle,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_use_huge_pages(
+	          handle,
+	          &use_huge_pages,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "use_huge_pages",
+	 use_huge_pages,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test reading with the chunk data buffers preallocated
+	 */
+	read_count = libewf_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              512,
+	              0,
+	              &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "read_count",
+	 (int) read_count,
 	 -1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	media_type_is_set = result;
+	result = libewf_handle_set_use_huge_pages(
+	          handle,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	/* Test error cases
 	 */
-	result = libewf_handle_get_media_type(
+	result = libewf_handle_get_use_huge_pages(
 	          NULL,
-	          &media_type,
+	          &use_huge_pages,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3331,25 +9546,40 @@ int ewf_test_handle_get_media_type(
 	libcerror_error_free(
 	 &error );
 
-	if( media_type_is_set != 0 )
-	{
-		result = libewf_handle_get_media_type(
-		          handle,
-		          NULL,
-		          &error );
+	result = libewf_handle_get_use_huge_pages(
+	          handle,
+	          NULL,
+	          &error );
 
-		EWF_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-		EWF_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_use_huge_pages(
+	          NULL,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
 
-		libcerror_error_free(
-		 &error );
-	}
 	return( 1 );
 
 on_error:
@@ -3358,43 +9588,50 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	libewf_handle_set_use_huge_pages(
+	 handle,
+	 0,
+	 NULL );
+
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_media_flags function
+/* Tests the libewf_handle_get_sub_block_size and libewf_handle_set_sub_block_size functions
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_media_flags(
+int ewf_test_handle_get_sub_block_size(
      libewf_handle_t *handle )
 {
 	libcerror_error_t *error = NULL;
-	uint8_t media_flags      = 0;
-	int media_flags_is_set   = 0;
+	size32_t sub_block_size  = 0;
 	int result               = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_media_flags(
+	result = libewf_handle_get_sub_block_size(
 	          handle,
-	          &media_flags,
+	          &sub_block_size,
 	          &error );
 
-	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "sub_block_size",
+	 (uint32_t) sub_block_size,
+	 0 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	media_flags_is_set = result;
-
 	/* Test error cases
 	 */
-	result = libewf_handle_get_media_flags(
+	result = libewf_handle_get_sub_block_size(
 	          NULL,
-	          &media_flags,
+	          &sub_block_size,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3409,70 +9646,64 @@ int ewf_test_handle_get_media_flags(
 	libcerror_error_free(
 	 &error );
 
-	if( media_flags_is_set != 0 )
-	{
-		result = libewf_handle_get_media_flags(
-		          handle,
-		          NULL,
-		          &error );
+	result = libewf_handle_get_sub_block_size(
+	          handle,
+	          NULL,
+	          &error );
 
-		EWF_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-		EWF_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-		libcerror_error_free(
-		 &error );
-	}
-	return( 1 );
+	libcerror_error_free(
+	 &error );
 
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	return( 0 );
-}
+	result = libewf_handle_set_sub_block_size(
+	          NULL,
+	          65536,
+	          &error );
 
-/* Tests the libewf_handle_get_format function
- * Returns 1 if successful or 0 if not
- */
-int ewf_test_handle_get_format(
-     libewf_handle_t *handle )
-{
-	libcerror_error_t *error = NULL;
-	uint8_t format           = 0;
-	int format_is_set        = 0;
-	int result               = 0;
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-	/* Test regular cases
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test with a sub-block size that is not a multiple of 512
 	 */
-	result = libewf_handle_get_format(
+	result = libewf_handle_set_sub_block_size(
 	          handle,
-	          &format,
+	          65537,
 	          &error );
 
-	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
 	 -1 );
 
-	EWF_TEST_ASSERT_IS_NULL(
+	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	format_is_set = result;
+	libcerror_error_free(
+	 &error );
 
-	/* Test error cases
+	/* Test with a handle that was opened for reading
 	 */
-	result = libewf_handle_get_format(
-	          NULL,
-	          &format,
+	result = libewf_handle_set_sub_block_size(
+	          handle,
+	          65536,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -3487,25 +9718,6 @@ int ewf_test_handle_get_format(
 	libcerror_error_free(
 	 &error );
 
-	if( format_is_set != 0 )
-	{
-		result = libewf_handle_get_format(
-		          handle,
-		          NULL,
-		          &error );
-
-		EWF_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
-
-		EWF_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
-
-		libcerror_error_free(
-		 &error );
-	}
 	return( 1 );
 
 on_error:
@@ -3673,6 +9885,193 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_handle_get_errors_in_range function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_errors_in_range(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error           = NULL;
+	size64_t media_size                = 0;
+	uint32_t number_of_acquiry_errors  = 0;
+	uint32_t number_of_checksum_errors = 0;
+	uint32_t number_of_errors          = 0;
+	int result                         = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_errors_in_range(
+	          handle,
+	          0,
+	          media_size,
+	          &number_of_acquiry_errors,
+	          &number_of_checksum_errors,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* All the errors are within the media data
+	 */
+	result = libewf_handle_get_number_of_acquiry_errors(
+	          handle,
+	          &number_of_errors,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_acquiry_errors",
+	 number_of_acquiry_errors,
+	 number_of_errors );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_errors_in_range(
+	          handle,
+	          0,
+	          0,
+	          &number_of_acquiry_errors,
+	          &number_of_checksum_errors,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_acquiry_errors",
+	 number_of_acquiry_errors,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_checksum_errors",
+	 number_of_checksum_errors,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_errors_in_range(
+	          NULL,
+	          0,
+	          media_size,
+	          &number_of_acquiry_errors,
+	          &number_of_checksum_errors,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_errors_in_range(
+	          handle,
+	          -1,
+	          media_size,
+	          &number_of_acquiry_errors,
+	          &number_of_checksum_errors,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_errors_in_range(
+	          handle,
+	          0,
+	          media_size,
+	          NULL,
+	          &number_of_checksum_errors,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_errors_in_range(
+	          handle,
+	          0,
+	          media_size,
+	          &number_of_acquiry_errors,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* Tests the libewf_handle_get_number_of_sessions function
  * Returns 1 if successful or 0 if not
  */
@@ -4304,6 +10703,11 @@ int main(
 		 ewf_test_handle_signal_abort,
 		 handle );
 
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_index_chunk_groups",
+		 ewf_test_handle_index_chunk_groups,
+		 handle );
+
 		EWF_TEST_RUN_WITH_ARGS(
 		 "libewf_handle_read_buffer",
 		 ewf_test_handle_read_buffer,
@@ -4314,6 +10718,71 @@ int main(
 		 ewf_test_handle_read_buffer_at_offset,
 		 handle );
 
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_read_vector",
+		 ewf_test_handle_read_vector,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_read_buffer_at_offset_concurrent",
+		 ewf_test_handle_read_buffer_at_offset_concurrent,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_share_chunk_cache",
+		 ewf_test_handle_share_chunk_cache,
+		 handle );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF )
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_read_buffer_at_offset_concurrent_share_chunk_cache",
+		 ewf_test_handle_read_buffer_at_offset_concurrent_share_chunk_cache,
+		 handle,
+		 file_io_pool );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBEWF ) */
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_set_maximum_chunk_cache_size",
+		 ewf_test_handle_set_maximum_chunk_cache_size,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_advise",
+		 ewf_test_handle_advise,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_segment_index",
+		 ewf_test_handle_segment_index,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_chunk_view",
+		 ewf_test_handle_get_chunk_view,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_chunk_flags",
+		 ewf_test_handle_get_chunk_flags,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_chunks_storage_values",
+		 ewf_test_handle_get_chunks_storage_values,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_segment_media_range",
+		 ewf_test_handle_get_segment_media_range,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_data_extents",
+		 ewf_test_handle_get_data_extents,
+		 handle );
+
 		/* TODO: add tests for libewf_handle_write_buffer */
 
 		/* TODO: add tests for libewf_handle_write_buffer_at_offset */
@@ -4325,6 +10794,16 @@ int main(
 
 		/* TODO: add tests for libewf_handle_read_data_chunk */
 
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_read_data_chunks",
+		 ewf_test_handle_read_data_chunks,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_stream_read",
+		 ewf_test_handle_stream_read,
+		 handle );
+
 		/* TODO: add tests for libewf_handle_write_data_chunk */
 
 		/* TODO: add tests for libewf_handle_write_finalize */
@@ -4341,6 +10820,56 @@ int main(
 
 		/* TODO: add tests for libewf_handle_set_maximum_number_of_open_handles */
 
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_maximum_number_of_cached_chunks",
+		 ewf_test_handle_get_maximum_number_of_cached_chunks,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_maximum_number_of_cached_chunk_groups",
+		 ewf_test_handle_get_maximum_number_of_cached_chunk_groups,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_memory_limit",
+		 ewf_test_handle_get_memory_limit,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_chunks_cache_statistics",
+		 ewf_test_handle_get_chunks_cache_statistics,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_number_of_read_ahead_chunks",
+		 ewf_test_handle_get_number_of_read_ahead_chunks,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_segment_prefetch_size",
+		 ewf_test_handle_get_segment_prefetch_size,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_read_priority",
+		 ewf_test_handle_get_read_priority,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_number_of_threads",
+		 ewf_test_handle_get_number_of_threads,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_decompression_backend",
+		 ewf_test_handle_get_decompression_backend,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_set_batch_decompression_function",
+		 ewf_test_handle_set_batch_decompression_function,
+		 handle );
+
 		/* TODO: add tests for libewf_handle_segment_files_corrupted */
 
 		/* TODO: add tests for libewf_handle_segment_files_encrypted */
@@ -4406,6 +10935,11 @@ int main(
 
 		/* TODO: add tests for libewf_handle_get_file_entry_by_utf16_path */
 
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_read_file_entries_data",
+		 ewf_test_handle_read_file_entries_data,
+		 handle );
+
 		EWF_TEST_RUN_WITH_ARGS(
 		 "libewf_handle_get_sectors_per_chunk",
 		 ewf_test_handle_get_sectors_per_chunk,
@@ -4492,6 +11026,26 @@ int main(
 
 		/* TODO: add tests for libewf_handle_set_read_zero_chunk_on_error */
 
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_read_verify_checksums",
+		 ewf_test_handle_get_read_verify_checksums,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_read_decompress_to_buffer",
+		 ewf_test_handle_get_read_decompress_to_buffer,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_use_huge_pages",
+		 ewf_test_handle_get_use_huge_pages,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_sub_block_size",
+		 ewf_test_handle_get_sub_block_size,
+		 handle );
+
 		/* TODO: add tests for libewf_handle_copy_media_values */
 
 		EWF_TEST_RUN_WITH_ARGS(
@@ -4512,6 +11066,11 @@ int main(
 
 		/* TODO: add tests for libewf_handle_append_checksum_error */
 
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_errors_in_range",
+		 ewf_test_handle_get_errors_in_range,
+		 handle );
+
 		EWF_TEST_RUN_WITH_ARGS(
 		 "libewf_handle_get_number_of_sessions",
 		 ewf_test_handle_get_number_of_sessions,
@@ -21,6 +21,8 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -38,6 +40,38 @@
 
 #if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
 
+/* Copies a header string into a buffer that is padded with end-of-string characters
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_header_values_copy_header_string(
+     uint8_t *header_string,
+     size_t header_string_size,
+     const char *string )
+{
+	size_t string_length = narrow_string_length(
+	                        string );
+
+	if( string_length >= header_string_size )
+	{
+		return( 0 );
+	}
+	if( memory_set(
+	     header_string,
+	     0,
+	     header_string_size ) == NULL )
+	{
+		return( 0 );
+	}
+	if( memory_copy(
+	     header_string,
+	     string,
+	     string_length ) == NULL )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
 /* Tests the libewf_header_values_initialize function
  * Returns 1 if successful or 0 if not
  */
@@ -160,6 +194,489 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_header_values_parse_utf8_header_string function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_header_values_parse_utf8_header_string(
+     void )
+{
+	uint8_t header_string[ 64 ];
+	uint8_t utf8_string[ 64 ];
+
+	libcerror_error_t *error         = NULL;
+	libfvalue_table_t *header_values = NULL;
+	size_t utf8_string_size          = 0;
+	uint8_t format                   = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_header_values_initialize(
+	          &header_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "header_values",
+	 header_values );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = ewf_test_header_values_copy_header_string(
+	          header_string,
+	          64,
+	          "1\nmain\nc\tn\tm\tu\nCASE\tEVIDENCE\t1142163845\t\n\n" );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_header_values_parse_utf8_header_string(
+	          header_values,
+	          header_string,
+	          64,
+	          2,
+	          &format,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_header_values_get_utf8_value(
+	          header_values,
+	          (uint8_t *) "case_number",
+	          11,
+	          LIBEWF_DATE_FORMAT_ISO8601,
+	          utf8_string,
+	          64,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = narrow_string_compare(
+	          (char *) utf8_string,
+	          "CASE",
+	          5 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* The date value is converted when it is first requested
+	 */
+	result = libewf_header_values_get_utf8_value_size(
+	          header_values,
+	          (uint8_t *) "acquiry_date",
+	          12,
+	          LIBEWF_DATE_FORMAT_ISO8601,
+	          &utf8_string_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_header_values_get_utf8_value(
+	          header_values,
+	          (uint8_t *) "acquiry_date",
+	          12,
+	          LIBEWF_DATE_FORMAT_ISO8601,
+	          utf8_string,
+	          64,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The empty system date value is not stored
+	 */
+	result = libewf_header_values_get_utf8_value_size(
+	          header_values,
+	          (uint8_t *) "system_date",
+	          11,
+	          LIBEWF_DATE_FORMAT_ISO8601,
+	          &utf8_string_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_header_values_parse_utf8_header_string(
+	          header_values,
+	          NULL,
+	          64,
+	          2,
+	          &format,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_header_values_parse_utf8_header_string(
+	          header_values,
+	          header_string,
+	          64,
+	          2,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test with a header string that is missing the types and values lines
+	 */
+	result = ewf_test_header_values_copy_header_string(
+	          header_string,
+	          64,
+	          "1\nmain\n" );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_header_values_parse_utf8_header_string(
+	          header_values,
+	          header_string,
+	          64,
+	          2,
+	          &format,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test with a header string with an unsupported number of sections
+	 */
+	result = ewf_test_header_values_copy_header_string(
+	          header_string,
+	          64,
+	          "2\nmain\nc\nCASE\n\n" );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_header_values_parse_utf8_header_string(
+	          header_values,
+	          header_string,
+	          64,
+	          2,
+	          &format,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfvalue_table_free(
+	          &header_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "header_values",
+	 header_values );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( header_values != NULL )
+	{
+		libfvalue_table_free(
+		 &header_values,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_header_values_parse_header function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_header_values_parse_header(
+     void )
+{
+	uint8_t utf8_string[ 64 ];
+
+	uint8_t header_ascii[ 42 ] = {
+		'1', '\n', 'm', 'a', 'i', 'n', '\n', 'c', '\t', 'n', '\t', 'm', '\t', 'u', '\n',
+		'C', 'A', 'S', 'E', '\t', 'E', 'V', 'I', 'D', 'E', 'N', 'C', 'E', '\t',
+		'1', '1', '4', '2', '1', '6', '3', '8', '4', '5', '\t', '\n', '\n' };
+
+	uint8_t header_windows_1252[ 19 ] = {
+		'1', '\n', 'm', 'a', 'i', 'n', '\n', 'c', '\t', 'n', '\n',
+		'C', 'A', 'S', 0xc9, '\t', '1', '\n', '\n' };
+
+	libcerror_error_t *error         = NULL;
+	libfvalue_table_t *header_values = NULL;
+	uint8_t format                   = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_header_values_initialize(
+	          &header_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "header_values",
+	 header_values );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * A header that only contains 7-bit characters is not converted
+	 */
+	result = libewf_header_values_parse_header(
+	          header_values,
+	          header_ascii,
+	          42,
+	          LIBEWF_CODEPAGE_ASCII,
+	          &format,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_header_values_get_utf8_value(
+	          header_values,
+	          (uint8_t *) "case_number",
+	          11,
+	          LIBEWF_DATE_FORMAT_ISO8601,
+	          utf8_string,
+	          64,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = narrow_string_compare(
+	          (char *) utf8_string,
+	          "CASE",
+	          5 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* A header that contains 8-bit characters is converted using the codepage
+	 */
+	result = libewf_header_values_parse_header(
+	          header_values,
+	          header_windows_1252,
+	          19,
+	          LIBEWF_CODEPAGE_WINDOWS_1252,
+	          &format,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_header_values_get_utf8_value(
+	          header_values,
+	          (uint8_t *) "case_number",
+	          11,
+	          LIBEWF_DATE_FORMAT_ISO8601,
+	          utf8_string,
+	          64,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = narrow_string_compare(
+	          (char *) utf8_string,
+	          "CAS\xc3\x89",
+	          6 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libewf_header_values_parse_header(
+	          header_values,
+	          NULL,
+	          42,
+	          LIBEWF_CODEPAGE_ASCII,
+	          &format,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfvalue_table_free(
+	          &header_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "header_values",
+	 header_values );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( header_values != NULL )
+	{
+		libfvalue_table_free(
+		 &header_values,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
 
 /* The main program
@@ -195,9 +712,13 @@ int main(
 
 	/* TODO: add tests for libewf_header_values_copy */
 
-	/* TODO: add tests for libewf_header_values_parse_utf8_header_string */
+	EWF_TEST_RUN(
+	 "libewf_header_values_parse_utf8_header_string",
+	 ewf_test_header_values_parse_utf8_header_string );
 
-	/* TODO: add tests for libewf_header_values_parse_header */
+	EWF_TEST_RUN(
+	 "libewf_header_values_parse_header",
+	 ewf_test_header_values_parse_header );
 
 	/* TODO: add tests for libewf_header_values_parse_header2 */
 
@@ -0,0 +1,1242 @@
+/*
+ * Library parallel_deflate functions test program
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+#include <zlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_checksum.h"
+#include "../libewf/libewf_definitions.h"
+#include "../libewf/libewf_deflate.h"
+#include "../libewf/libewf_parallel_deflate.h"
+
+#define EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE	( 4 * LIBEWF_PARALLEL_DEFLATE_MINIMUM_SEGMENT_SIZE + 1234 )
+
+#define EWF_TEST_PARALLEL_DEFLATE_SUB_BLOCK_SIZE	LIBEWF_PARALLEL_DEFLATE_DICTIONARY_SIZE
+
+#define EWF_TEST_PARALLEL_DEFLATE_NUMBER_OF_SUB_BLOCKS	( ( EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE + EWF_TEST_PARALLEL_DEFLATE_SUB_BLOCK_SIZE - 1 ) / EWF_TEST_PARALLEL_DEFLATE_SUB_BLOCK_SIZE )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+
+/* Fills a buffer with compressible test data
+ */
+void ewf_test_parallel_deflate_fill_data(
+      uint8_t *data,
+      size_t data_size )
+{
+	size_t data_offset = 0;
+	uint32_t value     = 0x12345678UL;
+
+	for( data_offset = 0;
+	     data_offset < data_size;
+	     data_offset++ )
+	{
+		value = ( value * 1103515245UL ) + 12345;
+
+		data[ data_offset ] = (uint8_t) ( ( value >> 16 ) & 0x0f );
+	}
+}
+
+/* Tests the libewf_parallel_deflate_combine_adler32 function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_parallel_deflate_combine_adler32(
+     void )
+{
+	uint8_t data[ 4096 ];
+
+	libcerror_error_t *error   = NULL;
+	uint32_t checksum          = 0;
+	uint32_t combined_checksum = 0;
+	uint32_t first_checksum    = 0;
+	uint32_t second_checksum   = 0;
+	int result                 = 0;
+
+	ewf_test_parallel_deflate_fill_data(
+	 data,
+	 4096 );
+
+	result = libewf_checksum_calculate_adler32(
+	          &checksum,
+	          data,
+	          4096,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_checksum_calculate_adler32(
+	          &first_checksum,
+	          data,
+	          1000,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_checksum_calculate_adler32(
+	          &second_checksum,
+	          &( data[ 1000 ] ),
+	          4096 - 1000,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	combined_checksum = libewf_parallel_deflate_combine_adler32(
+	                     first_checksum,
+	                     second_checksum,
+	                     4096 - 1000 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "combined_checksum",
+	 combined_checksum,
+	 checksum );
+
+	/* Test combining with the checksum of empty data
+	 */
+	combined_checksum = libewf_parallel_deflate_combine_adler32(
+	                     checksum,
+	                     1,
+	                     0 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "combined_checksum",
+	 combined_checksum,
+	 checksum );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_parallel_deflate_get_number_of_segments function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_parallel_deflate_get_number_of_segments(
+     void )
+{
+	int number_of_segments = 0;
+
+	/* Test regular cases
+	 */
+	number_of_segments = libewf_parallel_deflate_get_number_of_segments(
+	                      4 * LIBEWF_PARALLEL_DEFLATE_MINIMUM_SEGMENT_SIZE,
+	                      8 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_segments",
+	 number_of_segments,
+	 4 );
+
+	number_of_segments = libewf_parallel_deflate_get_number_of_segments(
+	                      16 * LIBEWF_PARALLEL_DEFLATE_MINIMUM_SEGMENT_SIZE,
+	                      8 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_segments",
+	 number_of_segments,
+	 8 );
+
+	number_of_segments = libewf_parallel_deflate_get_number_of_segments(
+	                      LIBEWF_PARALLEL_DEFLATE_MINIMUM_SEGMENT_SIZE - 1,
+	                      8 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_segments",
+	 number_of_segments,
+	 1 );
+
+	number_of_segments = libewf_parallel_deflate_get_number_of_segments(
+	                      16 * LIBEWF_PARALLEL_DEFLATE_MINIMUM_SEGMENT_SIZE,
+	                      0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_segments",
+	 number_of_segments,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the libewf_parallel_deflate_compress function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_parallel_deflate_compress(
+     void )
+{
+	libcerror_error_t *error      = NULL;
+	uint8_t *compressed_data      = NULL;
+	uint8_t *uncompressed_data    = NULL;
+	uint8_t *verification_data    = NULL;
+	size_t compressed_data_size   = 0;
+	size_t verification_data_size = 0;
+	int number_of_threads         = 0;
+	int result                    = 0;
+
+	/* Initialize test
+	 */
+	uncompressed_data = (uint8_t *) memory_allocate(
+	                                 EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "uncompressed_data",
+	 uncompressed_data );
+
+	compressed_data = (uint8_t *) memory_allocate(
+	                               2 * EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compressed_data",
+	 compressed_data );
+
+	verification_data = (uint8_t *) memory_allocate(
+	                                 EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "verification_data",
+	 verification_data );
+
+	ewf_test_parallel_deflate_fill_data(
+	 uncompressed_data,
+	 EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE );
+
+	/* Test regular cases
+	 */
+	for( number_of_threads = 1;
+	     number_of_threads <= 4;
+	     number_of_threads++ )
+	{
+		compressed_data_size = 2 * EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE;
+
+		result = libewf_parallel_deflate_compress(
+		          compressed_data,
+		          &compressed_data_size,
+		          Z_DEFAULT_COMPRESSION,
+		          uncompressed_data,
+		          EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE,
+		          number_of_threads,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		verification_data_size = EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE;
+
+		result = libewf_deflate_decompress(
+		          compressed_data,
+		          compressed_data_size,
+		          verification_data,
+		          &verification_data_size,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		EWF_TEST_ASSERT_EQUAL_SIZE(
+		 "verification_data_size",
+		 verification_data_size,
+		 (size_t) EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE );
+
+		result = memory_compare(
+		          verification_data,
+		          uncompressed_data,
+		          EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test with a compressed data buffer that is too small
+	 */
+	compressed_data_size = 16;
+
+	result = libewf_parallel_deflate_compress(
+	          compressed_data,
+	          &compressed_data_size,
+	          Z_DEFAULT_COMPRESSION,
+	          uncompressed_data,
+	          EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_GREATER_THAN_INT(
+	 "compressed_data_size",
+	 (int) compressed_data_size,
+	 16 );
+
+	/* Test error cases
+	 */
+	compressed_data_size = 2 * EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE;
+
+	result = libewf_parallel_deflate_compress(
+	          NULL,
+	          &compressed_data_size,
+	          Z_DEFAULT_COMPRESSION,
+	          uncompressed_data,
+	          EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_parallel_deflate_compress(
+	          compressed_data,
+	          NULL,
+	          Z_DEFAULT_COMPRESSION,
+	          uncompressed_data,
+	          EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_parallel_deflate_compress(
+	          compressed_data,
+	          &compressed_data_size,
+	          Z_DEFAULT_COMPRESSION,
+	          NULL,
+	          EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_parallel_deflate_compress(
+	          compressed_data,
+	          &compressed_data_size,
+	          Z_DEFAULT_COMPRESSION,
+	          uncompressed_data,
+	          EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	memory_free(
+	 verification_data );
+
+	verification_data = NULL;
+
+	memory_free(
+	 compressed_data );
+
+	compressed_data = NULL;
+
+	memory_free(
+	 uncompressed_data );
+
+	uncompressed_data = NULL;
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( verification_data != NULL )
+	{
+		memory_free(
+		 verification_data );
+	}
+	if( compressed_data != NULL )
+	{
+		memory_free(
+		 compressed_data );
+	}
+	if( uncompressed_data != NULL )
+	{
+		memory_free(
+		 uncompressed_data );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_parallel_deflate_compress_sub_blocks function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_parallel_deflate_compress_sub_blocks(
+     void )
+{
+	libcerror_error_t *error      = NULL;
+	uint8_t *compressed_data      = NULL;
+	uint8_t *uncompressed_data    = NULL;
+	uint8_t *verification_data    = NULL;
+	size_t compressed_data_size   = 0;
+	size_t verification_data_size = 0;
+	size_t zlib_stream_size       = 0;
+	int result                    = 0;
+
+	/* Initialize test
+	 */
+	uncompressed_data = (uint8_t *) memory_allocate(
+	                                 EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "uncompressed_data",
+	 uncompressed_data );
+
+	compressed_data = (uint8_t *) memory_allocate(
+	                               2 * EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compressed_data",
+	 compressed_data );
+
+	verification_data = (uint8_t *) memory_allocate(
+	                                 EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "verification_data",
+	 verification_data );
+
+	ewf_test_parallel_deflate_fill_data(
+	 uncompressed_data,
+	 EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE );
+
+	/* Test regular cases
+	 */
+	compressed_data_size = 2 * EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE;
+
+	result = libewf_parallel_deflate_compress_sub_blocks(
+	          compressed_data,
+	          &compressed_data_size,
+	          Z_DEFAULT_COMPRESSION,
+	          uncompressed_data,
+	          EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE,
+	          EWF_TEST_PARALLEL_DEFLATE_SUB_BLOCK_SIZE,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_parallel_deflate_get_zlib_stream_size(
+	          compressed_data,
+	          compressed_data_size,
+	          &zlib_stream_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "zlib_stream_size",
+	 zlib_stream_size,
+	 compressed_data_size - LIBEWF_PARALLEL_DEFLATE_SUB_BLOCK_INDEX_FOOTER_SIZE - ( EWF_TEST_PARALLEL_DEFLATE_NUMBER_OF_SUB_BLOCKS * LIBEWF_PARALLEL_DEFLATE_SUB_BLOCK_INDEX_ENTRY_SIZE ) );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The sub-block index that follows the zlib stream is ignored by other implementations
+	 */
+	verification_data_size = EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE;
+
+	result = libewf_deflate_decompress(
+	          compressed_data,
+	          compressed_data_size,
+	          verification_data,
+	          &verification_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "verification_data_size",
+	 verification_data_size,
+	 (size_t) EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE );
+
+	result = memory_compare(
+	          verification_data,
+	          uncompressed_data,
+	          EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test with a compressed data buffer that is too small
+	 */
+	compressed_data_size = 16;
+
+	result = libewf_parallel_deflate_compress_sub_blocks(
+	          compressed_data,
+	          &compressed_data_size,
+	          Z_DEFAULT_COMPRESSION,
+	          uncompressed_data,
+	          EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE,
+	          EWF_TEST_PARALLEL_DEFLATE_SUB_BLOCK_SIZE,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_GREATER_THAN_INT(
+	 "compressed_data_size",
+	 (int) compressed_data_size,
+	 16 );
+
+	/* Test error cases
+	 */
+	compressed_data_size = 2 * EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE;
+
+	result = libewf_parallel_deflate_compress_sub_blocks(
+	          NULL,
+	          &compressed_data_size,
+	          Z_DEFAULT_COMPRESSION,
+	          uncompressed_data,
+	          EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE,
+	          EWF_TEST_PARALLEL_DEFLATE_SUB_BLOCK_SIZE,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_parallel_deflate_compress_sub_blocks(
+	          compressed_data,
+	          &compressed_data_size,
+	          Z_DEFAULT_COMPRESSION,
+	          uncompressed_data,
+	          EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE,
+	          0,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_parallel_deflate_compress_sub_blocks(
+	          compressed_data,
+	          &compressed_data_size,
+	          Z_DEFAULT_COMPRESSION,
+	          uncompressed_data,
+	          EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE,
+	          EWF_TEST_PARALLEL_DEFLATE_SUB_BLOCK_SIZE,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test compressed data without a sub-block index, where the checksum
+	 * of the zlib stream is not mistaken for a sub-block index footer
+	 */
+	compressed_data_size = 2 * EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE;
+
+	result = libewf_parallel_deflate_compress(
+	          compressed_data,
+	          &compressed_data_size,
+	          Z_DEFAULT_COMPRESSION,
+	          uncompressed_data,
+	          EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_parallel_deflate_get_zlib_stream_size(
+	          compressed_data,
+	          compressed_data_size,
+	          &zlib_stream_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	memory_free(
+	 verification_data );
+
+	verification_data = NULL;
+
+	memory_free(
+	 compressed_data );
+
+	compressed_data = NULL;
+
+	memory_free(
+	 uncompressed_data );
+
+	uncompressed_data = NULL;
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( verification_data != NULL )
+	{
+		memory_free(
+		 verification_data );
+	}
+	if( compressed_data != NULL )
+	{
+		memory_free(
+		 compressed_data );
+	}
+	if( uncompressed_data != NULL )
+	{
+		memory_free(
+		 uncompressed_data );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_ZLIB_INFLATE ) || defined( ZLIB_DLL )
+
+/* Tests the libewf_parallel_deflate_decompress and libewf_parallel_deflate_decompress_sub_blocks functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_parallel_deflate_decompress(
+     void )
+{
+	libewf_parallel_deflate_sub_block_index_t sub_block_index;
+
+	libcerror_error_t *error      = NULL;
+	uint8_t *compressed_data      = NULL;
+	uint8_t *uncompressed_data    = NULL;
+	uint8_t *verification_data    = NULL;
+	size_t compressed_data_size   = 0;
+	size_t first_data_offset      = 0;
+	size_t last_data_offset       = 0;
+	size_t last_data_size         = 0;
+	size_t verification_data_size = 0;
+	uint32_t checksum             = 0;
+	int number_of_threads         = 0;
+	int result                    = 0;
+
+	/* Initialize test
+	 */
+	uncompressed_data = (uint8_t *) memory_allocate(
+	                                 EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "uncompressed_data",
+	 uncompressed_data );
+
+	compressed_data = (uint8_t *) memory_allocate(
+	                               2 * EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compressed_data",
+	 compressed_data );
+
+	verification_data = (uint8_t *) memory_allocate(
+	                                 EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "verification_data",
+	 verification_data );
+
+	ewf_test_parallel_deflate_fill_data(
+	 uncompressed_data,
+	 EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE );
+
+	compressed_data_size = 2 * EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE;
+
+	result = libewf_parallel_deflate_compress_sub_blocks(
+	          compressed_data,
+	          &compressed_data_size,
+	          Z_DEFAULT_COMPRESSION,
+	          uncompressed_data,
+	          EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE,
+	          EWF_TEST_PARALLEL_DEFLATE_SUB_BLOCK_SIZE,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( number_of_threads = 1;
+	     number_of_threads <= 4;
+	     number_of_threads++ )
+	{
+		verification_data_size = EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE;
+
+		result = libewf_parallel_deflate_decompress(
+		          compressed_data,
+		          compressed_data_size,
+		          verification_data,
+		          &verification_data_size,
+		          number_of_threads,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		EWF_TEST_ASSERT_EQUAL_SIZE(
+		 "verification_data_size",
+		 verification_data_size,
+		 (size_t) EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE );
+
+		result = memory_compare(
+		          verification_data,
+		          uncompressed_data,
+		          EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test decompressing only the sub-blocks 2 and 3
+	 */
+	result = libewf_parallel_deflate_sub_block_index_read_footer(
+	          &sub_block_index,
+	          &( compressed_data[ compressed_data_size - LIBEWF_PARALLEL_DEFLATE_SUB_BLOCK_INDEX_FOOTER_SIZE ] ),
+	          LIBEWF_PARALLEL_DEFLATE_SUB_BLOCK_INDEX_FOOTER_SIZE,
+	          compressed_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "sub_block_index.number_of_sub_blocks",
+	 sub_block_index.number_of_sub_blocks,
+	 (uint32_t) EWF_TEST_PARALLEL_DEFLATE_NUMBER_OF_SUB_BLOCKS );
+
+	result = libewf_parallel_deflate_sub_block_index_set_entries_data(
+	          &sub_block_index,
+	          &( compressed_data[ sub_block_index.zlib_stream_size ] ),
+	          sub_block_index.entries_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_parallel_deflate_sub_block_index_get_sub_block(
+	          &sub_block_index,
+	          2,
+	          &first_data_offset,
+	          &last_data_size,
+	          &checksum,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_parallel_deflate_sub_block_index_get_sub_block(
+	          &sub_block_index,
+	          3,
+	          &last_data_offset,
+	          &last_data_size,
+	          &checksum,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	verification_data_size = EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE;
+
+	result = libewf_parallel_deflate_decompress_sub_blocks(
+	          &sub_block_index,
+	          &( compressed_data[ first_data_offset ] ),
+	          first_data_offset,
+	          last_data_offset + last_data_size - first_data_offset,
+	          2,
+	          2,
+	          verification_data,
+	          &verification_data_size,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "verification_data_size",
+	 verification_data_size,
+	 (size_t) ( 2 * EWF_TEST_PARALLEL_DEFLATE_SUB_BLOCK_SIZE ) );
+
+	result = memory_compare(
+	          verification_data,
+	          &( uncompressed_data[ 2 * EWF_TEST_PARALLEL_DEFLATE_SUB_BLOCK_SIZE ] ),
+	          2 * EWF_TEST_PARALLEL_DEFLATE_SUB_BLOCK_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test with corrupted compressed data
+	 */
+	compressed_data[ first_data_offset + 8 ] ^= 0xff;
+
+	verification_data_size = EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE;
+
+	result = libewf_parallel_deflate_decompress(
+	          compressed_data,
+	          compressed_data_size,
+	          verification_data,
+	          &verification_data_size,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test with compressed data without a sub-block index
+	 */
+	compressed_data_size = 2 * EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE;
+
+	result = libewf_parallel_deflate_compress(
+	          compressed_data,
+	          &compressed_data_size,
+	          Z_DEFAULT_COMPRESSION,
+	          uncompressed_data,
+	          EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	verification_data_size = EWF_TEST_PARALLEL_DEFLATE_DATA_SIZE;
+
+	result = libewf_parallel_deflate_decompress(
+	          compressed_data,
+	          compressed_data_size,
+	          verification_data,
+	          &verification_data_size,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_parallel_deflate_decompress(
+	          NULL,
+	          compressed_data_size,
+	          verification_data,
+	          &verification_data_size,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_parallel_deflate_decompress(
+	          compressed_data,
+	          compressed_data_size,
+	          verification_data,
+	          NULL,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_parallel_deflate_decompress_sub_blocks(
+	          NULL,
+	          compressed_data,
+	          0,
+	          compressed_data_size,
+	          0,
+	          1,
+	          verification_data,
+	          &verification_data_size,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	memory_free(
+	 verification_data );
+
+	verification_data = NULL;
+
+	memory_free(
+	 compressed_data );
+
+	compressed_data = NULL;
+
+	memory_free(
+	 uncompressed_data );
+
+	uncompressed_data = NULL;
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( verification_data != NULL )
+	{
+		memory_free(
+		 verification_data );
+	}
+	if( compressed_data != NULL )
+	{
+		memory_free(
+		 compressed_data );
+	}
+	if( uncompressed_data != NULL )
+	{
+		memory_free(
+		 uncompressed_data );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_ZLIB_INFLATE ) || defined( ZLIB_DLL ) */
+
+#endif /* ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL ) */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+
+	EWF_TEST_RUN(
+	 "libewf_parallel_deflate_combine_adler32",
+	 ewf_test_parallel_deflate_combine_adler32 );
+
+	EWF_TEST_RUN(
+	 "libewf_parallel_deflate_get_number_of_segments",
+	 ewf_test_parallel_deflate_get_number_of_segments );
+
+	EWF_TEST_RUN(
+	 "libewf_parallel_deflate_compress",
+	 ewf_test_parallel_deflate_compress );
+
+	EWF_TEST_RUN(
+	 "libewf_parallel_deflate_compress_sub_blocks",
+	 ewf_test_parallel_deflate_compress_sub_blocks );
+
+#if defined( HAVE_ZLIB_INFLATE ) || defined( ZLIB_DLL )
+
+	EWF_TEST_RUN(
+	 "libewf_parallel_deflate_decompress",
+	 ewf_test_parallel_deflate_decompress );
+
+#endif /* defined( HAVE_ZLIB_INFLATE ) || defined( ZLIB_DLL ) */
+
+#endif /* ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL ) */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,679 @@
+/*
+ * Library read request type test program
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_read_request.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* The read count passed to the test callback
+ */
+ssize_t ewf_test_read_request_read_count = 0;
+
+/* Completion callback of the read request tests
+ */
+void ewf_test_read_request_callback(
+      void *callback_data,
+      ssize_t read_count,
+      libcerror_error_t *error EWF_TEST_ATTRIBUTE_UNUSED )
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( error )
+
+	if( callback_data != NULL )
+	{
+		*( (int *) callback_data ) += 1;
+	}
+	ewf_test_read_request_read_count = read_count;
+}
+
+/* Tests the libewf_read_request_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_read_request_initialize(
+     void )
+{
+	uint8_t buffer[ 64 ];
+
+	libcerror_error_t *error            = NULL;
+	libewf_handle_t *handle             = NULL;
+	libewf_read_request_t *read_request = NULL;
+	int result                          = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests     = 1;
+	int number_of_memset_fail_tests     = 1;
+	int test_number                     = 0;
+#endif
+
+	/* Initialize test
+	 */
+	result = libewf_handle_initialize(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_read_request_initialize(
+	          &read_request,
+	          handle,
+	          buffer,
+	          64,
+	          0,
+	          &ewf_test_read_request_callback,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "read_request",
+	 read_request );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_read_request_free(
+	          &read_request,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "read_request",
+	 read_request );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_read_request_initialize(
+	          NULL,
+	          handle,
+	          buffer,
+	          64,
+	          0,
+	          &ewf_test_read_request_callback,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_request = (libewf_read_request_t *) 0x12345678UL;
+
+	result = libewf_read_request_initialize(
+	          &read_request,
+	          handle,
+	          buffer,
+	          64,
+	          0,
+	          &ewf_test_read_request_callback,
+	          NULL,
+	          &error );
+
+	read_request = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_request_initialize(
+	          &read_request,
+	          NULL,
+	          buffer,
+	          64,
+	          0,
+	          &ewf_test_read_request_callback,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_request_initialize(
+	          &read_request,
+	          handle,
+	          NULL,
+	          64,
+	          0,
+	          &ewf_test_read_request_callback,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_request_initialize(
+	          &read_request,
+	          handle,
+	          buffer,
+	          (size_t) SSIZE_MAX + 1,
+	          0,
+	          &ewf_test_read_request_callback,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_request_initialize(
+	          &read_request,
+	          handle,
+	          buffer,
+	          64,
+	          -1,
+	          &ewf_test_read_request_callback,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_read_request_initialize(
+	          &read_request,
+	          handle,
+	          buffer,
+	          64,
+	          0,
+	          NULL,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_read_request_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_read_request_initialize(
+		          &read_request,
+		          handle,
+		          buffer,
+		          64,
+		          0,
+		          &ewf_test_read_request_callback,
+		          NULL,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( read_request != NULL )
+			{
+				libewf_read_request_free(
+				 &read_request,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "read_request",
+			 read_request );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_read_request_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_read_request_initialize(
+		          &read_request,
+		          handle,
+		          buffer,
+		          64,
+		          0,
+		          &ewf_test_read_request_callback,
+		          NULL,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( read_request != NULL )
+			{
+				libewf_read_request_free(
+				 &read_request,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "read_request",
+			 read_request );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	/* Clean up
+	 */
+	result = libewf_handle_free(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "handle",
+	 handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_request != NULL )
+	{
+		libewf_read_request_free(
+		 &read_request,
+		 NULL );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_read_request_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_read_request_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_read_request_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_read_request_process function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_read_request_process(
+     void )
+{
+	uint8_t buffer[ 64 ];
+
+	libcerror_error_t *error            = NULL;
+	libewf_handle_t *handle             = NULL;
+	libewf_read_request_t *read_request = NULL;
+	int number_of_callbacks             = 0;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_handle_initialize(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_read_request_initialize(
+	          &read_request,
+	          handle,
+	          buffer,
+	          64,
+	          0,
+	          &ewf_test_read_request_callback,
+	          (void *) &number_of_callbacks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "read_request",
+	 read_request );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * The handle is not opened so the read fails and the callback is called with -1
+	 */
+	ewf_test_read_request_read_count = 0;
+
+	result = libewf_read_request_process(
+	          read_request,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_callbacks",
+	 number_of_callbacks,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "ewf_test_read_request_read_count",
+	 ewf_test_read_request_read_count,
+	 (ssize_t) -1 );
+
+	/* Test error cases
+	 */
+	result = libewf_read_request_process(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_read_request_free(
+	          &read_request,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "read_request",
+	 read_request );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_free(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "handle",
+	 handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_request != NULL )
+	{
+		libewf_read_request_free(
+		 &read_request,
+		 NULL );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_read_request_initialize",
+	 ewf_test_read_request_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_read_request_free",
+	 ewf_test_read_request_free );
+
+	EWF_TEST_RUN(
+	 "libewf_read_request_process",
+	 ewf_test_read_request_process );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
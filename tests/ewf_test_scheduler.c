@@ -0,0 +1,724 @@
+/*
+ * Library scheduler type test program
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_definitions.h"
+#include "../libewf/libewf_scheduler.h"
+
+#define EWF_TEST_SCHEDULER_NUMBER_OF_TASKS	1024
+
+/* Tests the libewf_scheduler_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_scheduler_initialize(
+     void )
+{
+	libcerror_error_t *error      = NULL;
+	libewf_scheduler_t *scheduler = NULL;
+	int result                    = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_scheduler_initialize(
+	          &scheduler,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "scheduler",
+	 scheduler );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_scheduler_free(
+	          &scheduler,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "scheduler",
+	 scheduler );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_scheduler_initialize(
+	          &scheduler,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "scheduler",
+	 scheduler );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_scheduler_free(
+	          &scheduler,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "scheduler",
+	 scheduler );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_scheduler_initialize(
+	          NULL,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	scheduler = (libewf_scheduler_t *) 0x12345678UL;
+
+	result = libewf_scheduler_initialize(
+	          &scheduler,
+	          2,
+	          &error );
+
+	scheduler = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_scheduler_initialize(
+	          &scheduler,
+	          -1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( scheduler != NULL )
+	{
+		libewf_scheduler_free(
+		 &scheduler,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_scheduler_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_scheduler_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_scheduler_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Marks a task value as run
+ * Callback function for the scheduler
+ * Returns 1 if successful
+ */
+int ewf_test_scheduler_task_callback(
+     uint8_t *value,
+     void *arguments EWF_TEST_ATTRIBUTE_UNUSED )
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( arguments )
+
+	*value += 1;
+
+	return( 1 );
+}
+
+/* Tests the libewf_scheduler_push_task and libewf_scheduler_wait_for_tasks functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_scheduler_push_task(
+     void )
+{
+	uint8_t values[ EWF_TEST_SCHEDULER_NUMBER_OF_TASKS ];
+
+	libcerror_error_t *error      = NULL;
+	libewf_scheduler_t *scheduler = NULL;
+	int number_of_pending_tasks   = 0;
+	int number_of_threads         = 0;
+	int result                    = 0;
+	int value_index               = 0;
+
+	/* Test regular cases
+	 * More tasks than fit in the worker queues are pushed to test running them on the calling thread
+	 * Every other task is pushed with the background priority
+	 */
+	for( number_of_threads = 0;
+	     number_of_threads <= 2;
+	     number_of_threads++ )
+	{
+		result = libewf_scheduler_initialize(
+		          &scheduler,
+		          number_of_threads,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "scheduler",
+		 scheduler );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		for( value_index = 0;
+		     value_index < EWF_TEST_SCHEDULER_NUMBER_OF_TASKS;
+		     value_index++ )
+		{
+			values[ value_index ] = 0;
+		}
+		for( value_index = 0;
+		     value_index < EWF_TEST_SCHEDULER_NUMBER_OF_TASKS;
+		     value_index++ )
+		{
+			result = libewf_scheduler_push_task(
+			          scheduler,
+			          (int (*)(intptr_t *, void *)) &ewf_test_scheduler_task_callback,
+			          (intptr_t *) &( values[ value_index ] ),
+			          NULL,
+			          &number_of_pending_tasks,
+			          value_index % 2,
+			          &error );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+		result = libewf_scheduler_wait_for_tasks(
+		          scheduler,
+		          &number_of_pending_tasks,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "number_of_pending_tasks",
+		 number_of_pending_tasks,
+		 0 );
+
+		for( value_index = 0;
+		     value_index < EWF_TEST_SCHEDULER_NUMBER_OF_TASKS;
+		     value_index++ )
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "values[ value_index ]",
+			 (int) values[ value_index ],
+			 1 );
+		}
+		result = libewf_scheduler_free(
+		          &scheduler,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Initialize test
+	 */
+	result = libewf_scheduler_initialize(
+	          &scheduler,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "scheduler",
+	 scheduler );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_scheduler_push_task(
+	          NULL,
+	          (int (*)(intptr_t *, void *)) &ewf_test_scheduler_task_callback,
+	          (intptr_t *) &( values[ 0 ] ),
+	          NULL,
+	          &number_of_pending_tasks,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_scheduler_push_task(
+	          scheduler,
+	          NULL,
+	          (intptr_t *) &( values[ 0 ] ),
+	          NULL,
+	          &number_of_pending_tasks,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_scheduler_push_task(
+	          scheduler,
+	          (int (*)(intptr_t *, void *)) &ewf_test_scheduler_task_callback,
+	          (intptr_t *) &( values[ 0 ] ),
+	          NULL,
+	          NULL,
+	          LIBEWF_READ_PRIORITY_INTERACTIVE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_scheduler_push_task(
+	          scheduler,
+	          (int (*)(intptr_t *, void *)) &ewf_test_scheduler_task_callback,
+	          (intptr_t *) &( values[ 0 ] ),
+	          NULL,
+	          &number_of_pending_tasks,
+	          -1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_scheduler_wait_for_tasks(
+	          NULL,
+	          &number_of_pending_tasks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_scheduler_wait_for_tasks(
+	          scheduler,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_scheduler_free(
+	          &scheduler,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "scheduler",
+	 scheduler );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( scheduler != NULL )
+	{
+		libewf_scheduler_free(
+		 &scheduler,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_internal_scheduler_take_task function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_internal_scheduler_take_task(
+     void )
+{
+	libewf_internal_scheduler_t internal_scheduler;
+	libewf_scheduler_queue_t queue;
+	libewf_scheduler_task_t task;
+	uint8_t values[ 3 ];
+
+	int number_of_pending_tasks = 0;
+	int result                  = 0;
+	int value_index             = 0;
+
+	/* Initialize test
+	 * The background task is queued before the tasks of the worker queue
+	 */
+	if( memory_set(
+	     &internal_scheduler,
+	     0,
+	     sizeof( libewf_internal_scheduler_t ) ) == NULL )
+	{
+		goto on_error;
+	}
+	if( memory_set(
+	     &queue,
+	     0,
+	     sizeof( libewf_scheduler_queue_t ) ) == NULL )
+	{
+		goto on_error;
+	}
+	for( value_index = 0;
+	     value_index < 3;
+	     value_index++ )
+	{
+		values[ value_index ] = 0;
+	}
+	internal_scheduler.number_of_threads = 1;
+	internal_scheduler.queues            = &queue;
+
+	internal_scheduler.background_queue.tasks[ 0 ].callback_function       = (int (*)(intptr_t *, void *)) &ewf_test_scheduler_task_callback;
+	internal_scheduler.background_queue.tasks[ 0 ].value                   = (intptr_t *) &( values[ 0 ] );
+	internal_scheduler.background_queue.tasks[ 0 ].number_of_pending_tasks = &number_of_pending_tasks;
+	internal_scheduler.background_queue.number_of_tasks                    = 1;
+
+	for( value_index = 1;
+	     value_index < 3;
+	     value_index++ )
+	{
+		queue.tasks[ value_index - 1 ].callback_function       = (int (*)(intptr_t *, void *)) &ewf_test_scheduler_task_callback;
+		queue.tasks[ value_index - 1 ].value                   = (intptr_t *) &( values[ value_index ] );
+		queue.tasks[ value_index - 1 ].number_of_pending_tasks = &number_of_pending_tasks;
+	}
+	queue.number_of_tasks = 2;
+
+	internal_scheduler.number_of_queued_tasks = 3;
+
+	/* Test regular cases
+	 * The worker takes its most recently queued task first
+	 */
+	result = libewf_internal_scheduler_take_task(
+	          &internal_scheduler,
+	          0,
+	          &task );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INTPTR(
+	 "task.value",
+	 task.value,
+	 (intptr_t *) &( values[ 2 ] ) );
+
+	/* A thread that steals takes the least recently queued task of the worker queues
+	 */
+	result = libewf_internal_scheduler_take_task(
+	          &internal_scheduler,
+	          -1,
+	          &task );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INTPTR(
+	 "task.value",
+	 task.value,
+	 (intptr_t *) &( values[ 1 ] ) );
+
+	/* The background task is taken last
+	 */
+	result = libewf_internal_scheduler_take_task(
+	          &internal_scheduler,
+	          0,
+	          &task );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INTPTR(
+	 "task.value",
+	 task.value,
+	 (intptr_t *) &( values[ 0 ] ) );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "internal_scheduler.number_of_queued_tasks",
+	 internal_scheduler.number_of_queued_tasks,
+	 0 );
+
+	result = libewf_internal_scheduler_take_task(
+	          &internal_scheduler,
+	          0,
+	          &task );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libewf_internal_scheduler_take_task(
+	          NULL,
+	          0,
+	          &task );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	EWF_TEST_RUN(
+	 "libewf_scheduler_initialize",
+	 ewf_test_scheduler_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_scheduler_free",
+	 ewf_test_scheduler_free );
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_scheduler_push_task",
+	 ewf_test_scheduler_push_task );
+
+	EWF_TEST_RUN(
+	 "libewf_internal_scheduler_take_task",
+	 ewf_test_internal_scheduler_take_task );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,821 @@
+/*
+ * Library sector_range_list type test program
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_sector_range_list.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Tests the libewf_sector_range_list_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_sector_range_list_initialize(
+     void )
+{
+	libcerror_error_t *error                      = NULL;
+	libewf_sector_range_list_t *sector_range_list = NULL;
+	int result                                    = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests               = 1;
+	int number_of_memset_fail_tests               = 1;
+	int test_number                               = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_sector_range_list_initialize(
+	          &sector_range_list,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "sector_range_list",
+	 sector_range_list );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_sector_range_list_free(
+	          &sector_range_list,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "sector_range_list",
+	 sector_range_list );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_sector_range_list_initialize(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	sector_range_list = (libewf_sector_range_list_t *) 0x12345678UL;
+
+	result = libewf_sector_range_list_initialize(
+	          &sector_range_list,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	sector_range_list = NULL;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_sector_range_list_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_sector_range_list_initialize(
+		          &sector_range_list,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( sector_range_list != NULL )
+			{
+				libewf_sector_range_list_free(
+				 &sector_range_list,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "sector_range_list",
+			 sector_range_list );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_sector_range_list_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_sector_range_list_initialize(
+		          &sector_range_list,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( sector_range_list != NULL )
+			{
+				libewf_sector_range_list_free(
+				 &sector_range_list,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "sector_range_list",
+			 sector_range_list );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( sector_range_list != NULL )
+	{
+		libewf_sector_range_list_free(
+		 &sector_range_list,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_sector_range_list_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_sector_range_list_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_sector_range_list_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_sector_range_list_insert_range function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_sector_range_list_insert_range(
+     void )
+{
+	libcerror_error_t *error                      = NULL;
+	libewf_sector_range_list_t *sector_range_list = NULL;
+	uint64_t number_of_sectors                    = 0;
+	uint64_t start_sector                         = 0;
+	int number_of_ranges                          = 0;
+	int range_index                               = 0;
+	int result                                    = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_sector_range_list_initialize(
+	          &sector_range_list,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "sector_range_list",
+	 sector_range_list );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( range_index = 0;
+	     range_index < 64;
+	     range_index++ )
+	{
+		/* Insert the ranges in reverse order to test insertion before existing ranges
+		 */
+		result = libewf_sector_range_list_insert_range(
+		          sector_range_list,
+		          (uint64_t) ( 63 - range_index ) * 16,
+		          4,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libewf_sector_range_list_get_number_of_ranges(
+	          sector_range_list,
+	          &number_of_ranges,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_ranges",
+	 number_of_ranges,
+	 64 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( range_index = 0;
+	     range_index < 64;
+	     range_index++ )
+	{
+		result = libewf_sector_range_list_get_range_by_index(
+		          sector_range_list,
+		          range_index,
+		          &start_sector,
+		          &number_of_sectors,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_UINT64(
+		 "start_sector",
+		 start_sector,
+		 (uint64_t) range_index * 16 );
+
+		EWF_TEST_ASSERT_EQUAL_UINT64(
+		 "number_of_sectors",
+		 number_of_sectors,
+		 (uint64_t) 4 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test a range that is adjacent to range 1 and overlaps with ranges 2 and 3
+	 */
+	result = libewf_sector_range_list_insert_range(
+	          sector_range_list,
+	          20,
+	          30,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_sector_range_list_get_number_of_ranges(
+	          sector_range_list,
+	          &number_of_ranges,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_ranges",
+	 number_of_ranges,
+	 62 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_sector_range_list_get_range_by_index(
+	          sector_range_list,
+	          1,
+	          &start_sector,
+	          &number_of_sectors,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "start_sector",
+	 start_sector,
+	 (uint64_t) 16 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_sectors",
+	 number_of_sectors,
+	 (uint64_t) 36 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_sector_range_list_get_range_by_index(
+	          sector_range_list,
+	          2,
+	          &start_sector,
+	          &number_of_sectors,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "start_sector",
+	 start_sector,
+	 (uint64_t) 64 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_sector_range_list_insert_range(
+	          NULL,
+	          0,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_sector_range_list_insert_range(
+	          sector_range_list,
+	          (uint64_t) INT64_MAX + 1,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_sector_range_list_get_range_by_index(
+	          sector_range_list,
+	          62,
+	          &start_sector,
+	          &number_of_sectors,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_sector_range_list_free(
+	          &sector_range_list,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "sector_range_list",
+	 sector_range_list );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( sector_range_list != NULL )
+	{
+		libewf_sector_range_list_free(
+		 &sector_range_list,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_sector_range_list_get_number_of_ranges_in_range function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_sector_range_list_get_number_of_ranges_in_range(
+     void )
+{
+	libcerror_error_t *error                      = NULL;
+	libewf_sector_range_list_t *sector_range_list = NULL;
+	int number_of_ranges                          = 0;
+	int range_index                               = 0;
+	int result                                    = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_sector_range_list_initialize(
+	          &sector_range_list,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "sector_range_list",
+	 sector_range_list );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Ranges: 0 - 3, 16 - 19, 32 - 35 and 48 - 51
+	 */
+	for( range_index = 0;
+	     range_index < 4;
+	     range_index++ )
+	{
+		result = libewf_sector_range_list_insert_range(
+		          sector_range_list,
+		          (uint64_t) range_index * 16,
+		          4,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test regular cases
+	 */
+	result = libewf_sector_range_list_get_number_of_ranges_in_range(
+	          sector_range_list,
+	          3,
+	          30,
+	          &number_of_ranges,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_ranges",
+	 number_of_ranges,
+	 3 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_sector_range_list_get_number_of_ranges_in_range(
+	          sector_range_list,
+	          4,
+	          12,
+	          &number_of_ranges,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_ranges",
+	 number_of_ranges,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_sector_range_list_get_number_of_ranges_in_range(
+	          sector_range_list,
+	          17,
+	          0,
+	          &number_of_ranges,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_ranges",
+	 number_of_ranges,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_sector_range_list_range_is_present(
+	          sector_range_list,
+	          50,
+	          100,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_sector_range_list_range_is_present(
+	          sector_range_list,
+	          52,
+	          100,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_sector_range_list_get_number_of_ranges_in_range(
+	          NULL,
+	          0,
+	          1,
+	          &number_of_ranges,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_sector_range_list_get_number_of_ranges_in_range(
+	          sector_range_list,
+	          0,
+	          1,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_sector_range_list_free(
+	          &sector_range_list,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "sector_range_list",
+	 sector_range_list );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( sector_range_list != NULL )
+	{
+		libewf_sector_range_list_free(
+		 &sector_range_list,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_sector_range_list_initialize",
+	 ewf_test_sector_range_list_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_sector_range_list_free",
+	 ewf_test_sector_range_list_free );
+
+	/* TODO: add tests for libewf_sector_range_list_clone */
+
+	EWF_TEST_RUN(
+	 "libewf_sector_range_list_insert_range",
+	 ewf_test_sector_range_list_insert_range );
+
+	EWF_TEST_RUN(
+	 "libewf_sector_range_list_get_number_of_ranges_in_range",
+	 ewf_test_sector_range_list_get_number_of_ranges_in_range );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,830 @@
+/*
+ * Library segment_index type test program
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_segment_index.h"
+#include "../libewf/ewf_segment_index.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Tests the libewf_segment_index_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_segment_index_initialize(
+     void )
+{
+	libcerror_error_t *error              = NULL;
+	libewf_segment_index_t *segment_index = NULL;
+	int result                            = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests       = 1;
+	int number_of_memset_fail_tests       = 1;
+	int test_number                       = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_segment_index_initialize(
+	          &segment_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "segment_index",
+	 segment_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_index_free(
+	          &segment_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "segment_index",
+	 segment_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_segment_index_initialize(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	segment_index = (libewf_segment_index_t *) 0x12345678UL;
+
+	result = libewf_segment_index_initialize(
+	          &segment_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	segment_index = NULL;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_segment_index_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_segment_index_initialize(
+		          &segment_index,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( segment_index != NULL )
+			{
+				libewf_segment_index_free(
+				 &segment_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "segment_index",
+			 segment_index );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_segment_index_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_segment_index_initialize(
+		          &segment_index,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( segment_index != NULL )
+			{
+				libewf_segment_index_free(
+				 &segment_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "segment_index",
+			 segment_index );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( segment_index != NULL )
+	{
+		libewf_segment_index_free(
+		 &segment_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_segment_index_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_segment_index_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_segment_index_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_segment_index_set_number_of_segments function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_segment_index_set_number_of_segments(
+     void )
+{
+	libcerror_error_t *error              = NULL;
+	libewf_segment_index_t *segment_index = NULL;
+	int result                            = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_segment_index_initialize(
+	          &segment_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "segment_index",
+	 segment_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_segment_index_set_number_of_segments(
+	          segment_index,
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "segment_index->number_of_segments",
+	 segment_index->number_of_segments,
+	 (uint32_t) 3 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_segment_index_set_number_of_segments(
+	          NULL,
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_index_set_number_of_segments(
+	          segment_index,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_segment_index_free(
+	          &segment_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "segment_index",
+	 segment_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( segment_index != NULL )
+	{
+		libewf_segment_index_free(
+		 &segment_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_segment_index_get_entry_data and libewf_segment_index_set_entry_data functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_segment_index_entry_data(
+     void )
+{
+	libcerror_error_t *error              = NULL;
+	libewf_segment_index_t *segment_index = NULL;
+	const uint8_t *entry_data             = NULL;
+	uint8_t *test_entry_data              = NULL;
+	size_t entry_data_size                = 0;
+	size_t test_entry_data_size           = 0;
+	int result                            = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_segment_index_initialize(
+	          &segment_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "segment_index",
+	 segment_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_index_set_number_of_segments(
+	          segment_index,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* An entry with 2 sections and 1 chunk group
+	 */
+	test_entry_data_size = sizeof( ewf_segment_index_entry_t )
+	                     + ( 2 * sizeof( ewf_segment_index_section_t ) )
+	                     + sizeof( ewf_segment_index_chunk_group_t );
+
+	test_entry_data = (uint8_t *) memory_allocate(
+	                               test_entry_data_size );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "test_entry_data",
+	 test_entry_data );
+
+	result = memory_set(
+	          test_entry_data,
+	          0,
+	          test_entry_data_size ) != NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_segment_index_entry_t *) test_entry_data )->segment_number,
+	 1 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_segment_index_entry_t *) test_entry_data )->number_of_sections,
+	 2 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_segment_index_entry_t *) test_entry_data )->number_of_chunk_groups,
+	 1 );
+
+	/* Test regular cases
+	 */
+	result = libewf_segment_index_get_entry_data_size(
+	          test_entry_data,
+	          test_entry_data_size,
+	          &entry_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "entry_data_size",
+	 entry_data_size,
+	 test_entry_data_size );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_index_get_entry_data_size(
+	          test_entry_data,
+	          test_entry_data_size - 1,
+	          &entry_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_index_set_entry_data(
+	          segment_index,
+	          1,
+	          test_entry_data,
+	          test_entry_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The segment index now manages the entry data
+	 */
+	test_entry_data = NULL;
+
+	result = libewf_segment_index_get_entry_data(
+	          segment_index,
+	          1,
+	          &entry_data,
+	          &entry_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "entry_data",
+	 entry_data );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "entry_data_size",
+	 entry_data_size,
+	 sizeof( ewf_segment_index_entry_t ) + ( 2 * sizeof( ewf_segment_index_section_t ) ) + sizeof( ewf_segment_index_chunk_group_t ) );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_index_get_entry_data(
+	          segment_index,
+	          2,
+	          &entry_data,
+	          &entry_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_index_get_entry_data(
+	          segment_index,
+	          3,
+	          &entry_data,
+	          &entry_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_segment_index_get_entry_data(
+	          NULL,
+	          1,
+	          &entry_data,
+	          &entry_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_index_get_entry_data(
+	          segment_index,
+	          1,
+	          NULL,
+	          &entry_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_index_get_entry_data(
+	          segment_index,
+	          1,
+	          &entry_data,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_index_set_entry_data(
+	          NULL,
+	          2,
+	          (uint8_t *) entry_data,
+	          entry_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_index_set_entry_data(
+	          segment_index,
+	          3,
+	          (uint8_t *) entry_data,
+	          entry_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_index_set_entry_data(
+	          segment_index,
+	          2,
+	          NULL,
+	          entry_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_index_set_entry_data(
+	          segment_index,
+	          2,
+	          (uint8_t *) entry_data,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_index_get_entry_data_size(
+	          NULL,
+	          entry_data_size,
+	          &entry_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_segment_index_free(
+	          &segment_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "segment_index",
+	 segment_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( test_entry_data != NULL )
+	{
+		memory_free(
+		 test_entry_data );
+	}
+	if( segment_index != NULL )
+	{
+		libewf_segment_index_free(
+		 &segment_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_segment_index_initialize",
+	 ewf_test_segment_index_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_segment_index_free",
+	 ewf_test_segment_index_free );
+
+	EWF_TEST_RUN(
+	 "libewf_segment_index_set_number_of_segments",
+	 ewf_test_segment_index_set_number_of_segments );
+
+	EWF_TEST_RUN(
+	 "libewf_segment_index_entry_data",
+	 ewf_test_segment_index_entry_data );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -264,6 +264,700 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_segment_table_get_segment_basename function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_segment_table_get_segment_basename(
+     void )
+{
+	libcerror_error_t *error              = NULL;
+	libewf_io_handle_t *io_handle         = NULL;
+	libewf_segment_table_t *segment_table = NULL;
+	system_character_t *basename          = NULL;
+	size_t basename_size                  = 0;
+	int result                            = 0;
+	int stripe_index                      = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_table_initialize(
+	          &segment_table,
+	          io_handle,
+	          LIBEWF_DEFAULT_SEGMENT_FILE_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "segment_table",
+	 segment_table );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_table_set_basename(
+	          segment_table,
+	          "first",
+	          5,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_segment_table_get_segment_basename(
+	          segment_table,
+	          1,
+	          &basename,
+	          &basename_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "basename_size",
+	 basename_size,
+	 (size_t) 6 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_table_append_stripe_basename(
+	          segment_table,
+	          "second",
+	          6,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_table_get_segment_basename(
+	          segment_table,
+	          1,
+	          &basename,
+	          &basename_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "basename_size",
+	 basename_size,
+	 (size_t) 7 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_table_get_segment_basename(
+	          segment_table,
+	          2,
+	          &basename,
+	          &basename_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "basename_size",
+	 basename_size,
+	 (size_t) 6 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_segment_table_get_segment_basename(
+	          NULL,
+	          0,
+	          &basename,
+	          &basename_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_table_get_segment_basename(
+	          segment_table,
+	          0,
+	          NULL,
+	          &basename_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_table_get_segment_basename(
+	          segment_table,
+	          0,
+	          &basename,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test libewf_segment_table_append_stripe_basename with the maximum number of stripes exceeded
+	 */
+	for( stripe_index = 2;
+	     stripe_index < LIBEWF_MAXIMUM_NUMBER_OF_STRIPES;
+	     stripe_index++ )
+	{
+		result = libewf_segment_table_append_stripe_basename(
+		          segment_table,
+		          "stripe",
+		          6,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libewf_segment_table_append_stripe_basename(
+	          segment_table,
+	          "stripe",
+	          6,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_segment_table_free(
+	          &segment_table,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "segment_table",
+	 segment_table );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( segment_table != NULL )
+	{
+		libewf_segment_table_free(
+		 &segment_table,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_segment_table_get_segment_index_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_segment_table_get_segment_index_at_offset(
+     void )
+{
+	libcerror_error_t *error              = NULL;
+	libewf_io_handle_t *io_handle         = NULL;
+	libewf_segment_file_t *segment_file   = NULL;
+	libewf_segment_table_t *segment_table = NULL;
+	off64_t segment_data_offset           = 0;
+	uint32_t segment_index                = 0;
+	uint32_t segment_number               = 0;
+	int result                            = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_table_initialize(
+	          &segment_table,
+	          io_handle,
+	          LIBEWF_DEFAULT_SEGMENT_FILE_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "segment_table",
+	 segment_table );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_file_initialize(
+	          &segment_file,
+	          io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "segment_file",
+	 segment_file );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Add 3 segments with a storage media size of 100, 200 and 300
+	 */
+	for( segment_index = 0;
+	     segment_index < 3;
+	     segment_index++ )
+	{
+		segment_file->segment_number = segment_index + 1;
+
+		result = libewf_segment_table_append_segment_by_segment_file(
+		          segment_table,
+		          segment_file,
+		          (int) segment_index,
+		          1024,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libewf_segment_table_set_segment_storage_media_size_by_index(
+		          segment_table,
+		          segment_index,
+		          (size64_t) ( segment_index + 1 ) * 100,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test regular cases
+	 */
+	result = libewf_segment_table_get_segment_index_at_offset(
+	          segment_table,
+	          0,
+	          &segment_number,
+	          &segment_data_offset,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "segment_number",
+	 segment_number,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "segment_data_offset",
+	 segment_data_offset,
+	 (int64_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_table_get_segment_index_at_offset(
+	          segment_table,
+	          599,
+	          &segment_number,
+	          &segment_data_offset,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "segment_number",
+	 segment_number,
+	 2 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "segment_data_offset",
+	 segment_data_offset,
+	 (int64_t) 299 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_table_get_segment_index_at_offset(
+	          segment_table,
+	          150,
+	          &segment_number,
+	          &segment_data_offset,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "segment_number",
+	 segment_number,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "segment_data_offset",
+	 segment_data_offset,
+	 (int64_t) 50 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_table_get_segment_index_at_offset(
+	          segment_table,
+	          600,
+	          &segment_number,
+	          &segment_data_offset,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a changed storage media size
+	 */
+	result = libewf_segment_table_set_segment_storage_media_size_by_index(
+	          segment_table,
+	          0,
+	          50,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_table_get_segment_index_at_offset(
+	          segment_table,
+	          50,
+	          &segment_number,
+	          &segment_data_offset,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "segment_number",
+	 segment_number,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "segment_data_offset",
+	 segment_data_offset,
+	 (int64_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_segment_table_get_segment_index_at_offset(
+	          NULL,
+	          0,
+	          &segment_number,
+	          &segment_data_offset,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_table_get_segment_index_at_offset(
+	          segment_table,
+	          0,
+	          NULL,
+	          &segment_data_offset,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_segment_table_get_segment_index_at_offset(
+	          segment_table,
+	          0,
+	          &segment_number,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_segment_file_free(
+	          &segment_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "segment_file",
+	 segment_file );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_table_free(
+	          &segment_table,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "segment_table",
+	 segment_table );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( segment_file != NULL )
+	{
+		libewf_segment_file_free(
+		 &segment_file,
+		 NULL );
+	}
+	if( segment_table != NULL )
+	{
+		libewf_segment_table_free(
+		 &segment_table,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
 
 /* The main program
@@ -307,6 +1001,10 @@ int main(
 
 	/* TODO: add tests for libewf_segment_table_set_basename */
 
+	EWF_TEST_RUN(
+	 "libewf_segment_table_get_segment_basename",
+	 ewf_test_segment_table_get_segment_basename );
+
 #if defined( HAVE_WIDE_CHARACTER_TYPE )
 
 	/* TODO: add tests for libewf_segment_table_get_basename_size_wide */
@@ -323,6 +1021,10 @@ int main(
 
 	/* TODO: add tests for libewf_segment_table_get_segment_by_index */
 
+	EWF_TEST_RUN(
+	 "libewf_segment_table_get_segment_index_at_offset",
+	 ewf_test_segment_table_get_segment_index_at_offset );
+
 	/* TODO: add tests for libewf_segment_table_get_segment_at_offset */
 
 	/* TODO: add tests for libewf_segment_table_get_segment_storage_media_size_by_index */
@@ -0,0 +1,809 @@
+/*
+ * Library shared_chunk_cache type test program
+ *
+ * Copyright (C) 2006-2019, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_SYS_MMAN_H )
+#include <sys/mman.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_shared_chunk_cache.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* The maximum cache size of a shared chunk cache of a single hash bucket of 512 bytes slots
+ */
+#define EWF_TEST_SHARED_CHUNK_CACHE_MAXIMUM_CACHE_SIZE \
+	( LIBEWF_SHARED_CHUNK_CACHE_HEADER_SIZE + ( LIBEWF_SHARED_CHUNK_CACHE_NUMBER_OF_WAYS * ( 512 + LIBEWF_SHARED_CHUNK_CACHE_ENTRY_SIZE ) ) )
+
+#define EWF_TEST_SHARED_CHUNK_CACHE_NAME \
+	"/ewf_test_shared_chunk_cache"
+
+uint8_t ewf_test_shared_chunk_cache_set_identifier[ 16 ] = {
+	0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10 };
+
+/* Tests the libewf_shared_chunk_cache_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_shared_chunk_cache_initialize(
+     void )
+{
+	libcerror_error_t *error                        = NULL;
+	libewf_shared_chunk_cache_t *shared_chunk_cache = NULL;
+	int result                                      = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_shared_chunk_cache_initialize(
+	          &shared_chunk_cache,
+	          512,
+	          EWF_TEST_SHARED_CHUNK_CACHE_MAXIMUM_CACHE_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "shared_chunk_cache",
+	 shared_chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_shared_chunk_cache_free(
+	          &shared_chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "shared_chunk_cache",
+	 shared_chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_shared_chunk_cache_initialize(
+	          NULL,
+	          512,
+	          EWF_TEST_SHARED_CHUNK_CACHE_MAXIMUM_CACHE_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_shared_chunk_cache_initialize(
+	          &shared_chunk_cache,
+	          0,
+	          EWF_TEST_SHARED_CHUNK_CACHE_MAXIMUM_CACHE_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test a maximum cache size that cannot contain a single hash bucket
+	 */
+	result = libewf_shared_chunk_cache_initialize(
+	          &shared_chunk_cache,
+	          512,
+	          EWF_TEST_SHARED_CHUNK_CACHE_MAXIMUM_CACHE_SIZE - 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( shared_chunk_cache != NULL )
+	{
+		libewf_shared_chunk_cache_free(
+		 &shared_chunk_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_shared_chunk_cache_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_shared_chunk_cache_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_shared_chunk_cache_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_shared_chunk_cache_open function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_shared_chunk_cache_open(
+     void )
+{
+	libcerror_error_t *error                        = NULL;
+	libewf_shared_chunk_cache_t *shared_chunk_cache = NULL;
+	int result                                      = 0;
+
+	result = libewf_shared_chunk_cache_initialize(
+	          &shared_chunk_cache,
+	          512,
+	          EWF_TEST_SHARED_CHUNK_CACHE_MAXIMUM_CACHE_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_shared_chunk_cache_open(
+	          NULL,
+	          EWF_TEST_SHARED_CHUNK_CACHE_NAME,
+	          28,
+	          ewf_test_shared_chunk_cache_set_identifier,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test a name that does not start with a '/'
+	 */
+	result = libewf_shared_chunk_cache_open(
+	          shared_chunk_cache,
+	          "ewf_test_shared_chunk_cache",
+	          27,
+	          ewf_test_shared_chunk_cache_set_identifier,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test a name that contains another '/'
+	 */
+	result = libewf_shared_chunk_cache_open(
+	          shared_chunk_cache,
+	          "/ewf_test/shared_chunk_cache",
+	          28,
+	          ewf_test_shared_chunk_cache_set_identifier,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_shared_chunk_cache_open(
+	          shared_chunk_cache,
+	          EWF_TEST_SHARED_CHUNK_CACHE_NAME,
+	          28,
+	          NULL,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_shared_chunk_cache_free(
+	          &shared_chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( shared_chunk_cache != NULL )
+	{
+		libewf_shared_chunk_cache_free(
+		 &shared_chunk_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_LIBEWF_SHARED_CHUNK_CACHE_SUPPORT )
+
+/* Opens a shared chunk cache of a single hash bucket of 512 bytes slots with file IO pool entry as segment number 1
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_shared_chunk_cache_open_test_cache(
+     libewf_shared_chunk_cache_t **shared_chunk_cache,
+     int file_io_pool_entry,
+     const uint8_t *set_identifier,
+     libcerror_error_t **error )
+{
+	int result = 0;
+
+	result = libewf_shared_chunk_cache_initialize(
+	          shared_chunk_cache,
+	          512,
+	          EWF_TEST_SHARED_CHUNK_CACHE_MAXIMUM_CACHE_SIZE,
+	          error );
+
+	if( result == 1 )
+	{
+		result = libewf_shared_chunk_cache_set_segment_number(
+		          *shared_chunk_cache,
+		          file_io_pool_entry,
+		          1,
+		          error );
+	}
+	if( result == 1 )
+	{
+		result = libewf_shared_chunk_cache_open(
+		          *shared_chunk_cache,
+		          EWF_TEST_SHARED_CHUNK_CACHE_NAME,
+		          28,
+		          set_identifier,
+		          16,
+		          error );
+	}
+	return( result );
+}
+
+/* Tests the libewf_shared_chunk_cache_write_chunk_data and libewf_shared_chunk_cache_read_chunk_data functions
+ * The shared memory is attached to twice to represent 2 processes
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_shared_chunk_cache_read_write_chunk_data(
+     void )
+{
+	uint8_t chunk_data[ 1024 ];
+	uint8_t other_set_identifier[ 16 ];
+	uint8_t read_data[ 512 ];
+
+	libcerror_error_t *error                              = NULL;
+	libewf_shared_chunk_cache_t *other_shared_chunk_cache = NULL;
+	libewf_shared_chunk_cache_t *shared_chunk_cache       = NULL;
+	size_t chunk_data_size                                = 0;
+	int chunk_index                                       = 0;
+	int result                                            = 0;
+
+	memory_set(
+	 chunk_data,
+	 'A',
+	 1024 );
+
+	shm_unlink(
+	 EWF_TEST_SHARED_CHUNK_CACHE_NAME );
+
+	result = ewf_test_shared_chunk_cache_open_test_cache(
+	          &shared_chunk_cache,
+	          0,
+	          ewf_test_shared_chunk_cache_set_identifier,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "shared_chunk_cache->number_of_buckets",
+	 shared_chunk_cache->number_of_buckets,
+	 (uint32_t) 1 );
+
+	/* The file IO pool entries differ between processes
+	 */
+	result = ewf_test_shared_chunk_cache_open_test_cache(
+	          &other_shared_chunk_cache,
+	          2,
+	          ewf_test_shared_chunk_cache_set_identifier,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a chunk that is not in the cache
+	 */
+	result = libewf_shared_chunk_cache_read_chunk_data(
+	          other_shared_chunk_cache,
+	          2,
+	          0x1000,
+	          read_data,
+	          512,
+	          &chunk_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that a chunk stored by one process is read by the other
+	 */
+	result = libewf_shared_chunk_cache_write_chunk_data(
+	          shared_chunk_cache,
+	          0,
+	          0x1000,
+	          chunk_data,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_shared_chunk_cache_read_chunk_data(
+	          other_shared_chunk_cache,
+	          2,
+	          0x1000,
+	          read_data,
+	          512,
+	          &chunk_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "chunk_data_size",
+	 chunk_data_size,
+	 (size_t) 512 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "read_data[ 0 ]",
+	 (int) read_data[ 0 ],
+	 (int) 'A' );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that a chunk of an unknown file IO pool entry is not stored
+	 */
+	result = libewf_shared_chunk_cache_write_chunk_data(
+	          shared_chunk_cache,
+	          1,
+	          0x2000,
+	          chunk_data,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that chunk data that exceeds the slot size is not stored
+	 */
+	result = libewf_shared_chunk_cache_write_chunk_data(
+	          shared_chunk_cache,
+	          0,
+	          0x2000,
+	          chunk_data,
+	          1024,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that chunk data that does not match its checksum is discarded
+	 */
+	shared_chunk_cache->slots[ 0 ] ^= 0xff;
+
+	result = libewf_shared_chunk_cache_read_chunk_data(
+	          other_shared_chunk_cache,
+	          2,
+	          0x1000,
+	          read_data,
+	          512,
+	          &chunk_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the least recently used chunk is evicted when the hash bucket is full
+	 */
+	for( chunk_index = 0;
+	     chunk_index <= LIBEWF_SHARED_CHUNK_CACHE_NUMBER_OF_WAYS;
+	     chunk_index++ )
+	{
+		chunk_data[ 0 ] = (uint8_t) chunk_index;
+
+		result = libewf_shared_chunk_cache_write_chunk_data(
+		          shared_chunk_cache,
+		          0,
+		          (off64_t) ( chunk_index + 1 ) * 0x1000,
+		          chunk_data,
+		          512,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libewf_shared_chunk_cache_read_chunk_data(
+	          other_shared_chunk_cache,
+	          2,
+	          0x1000,
+	          read_data,
+	          512,
+	          &chunk_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_shared_chunk_cache_read_chunk_data(
+	          other_shared_chunk_cache,
+	          2,
+	          (off64_t) ( LIBEWF_SHARED_CHUNK_CACHE_NUMBER_OF_WAYS + 1 ) * 0x1000,
+	          read_data,
+	          512,
+	          &chunk_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "read_data[ 0 ]",
+	 (int) read_data[ 0 ],
+	 LIBEWF_SHARED_CHUNK_CACHE_NUMBER_OF_WAYS );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_shared_chunk_cache_free(
+	          &other_shared_chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the chunks of another segment file set are not read
+	 */
+	memory_set(
+	 other_set_identifier,
+	 0xff,
+	 16 );
+
+	result = ewf_test_shared_chunk_cache_open_test_cache(
+	          &other_shared_chunk_cache,
+	          2,
+	          other_set_identifier,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_shared_chunk_cache_read_chunk_data(
+	          other_shared_chunk_cache,
+	          2,
+	          (off64_t) ( LIBEWF_SHARED_CHUNK_CACHE_NUMBER_OF_WAYS + 1 ) * 0x1000,
+	          read_data,
+	          512,
+	          &chunk_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_shared_chunk_cache_free(
+	          &other_shared_chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_shared_chunk_cache_free(
+	          &shared_chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	shm_unlink(
+	 EWF_TEST_SHARED_CHUNK_CACHE_NAME );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( other_shared_chunk_cache != NULL )
+	{
+		libewf_shared_chunk_cache_free(
+		 &other_shared_chunk_cache,
+		 NULL );
+	}
+	if( shared_chunk_cache != NULL )
+	{
+		libewf_shared_chunk_cache_free(
+		 &shared_chunk_cache,
+		 NULL );
+	}
+	shm_unlink(
+	 EWF_TEST_SHARED_CHUNK_CACHE_NAME );
+
+	return( 0 );
+}
+
+#endif /* defined( HAVE_LIBEWF_SHARED_CHUNK_CACHE_SUPPORT ) */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_shared_chunk_cache_initialize",
+	 ewf_test_shared_chunk_cache_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_shared_chunk_cache_free",
+	 ewf_test_shared_chunk_cache_free );
+
+	EWF_TEST_RUN(
+	 "libewf_shared_chunk_cache_open",
+	 ewf_test_shared_chunk_cache_open );
+
+#if defined( HAVE_LIBEWF_SHARED_CHUNK_CACHE_SUPPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_shared_chunk_cache_read_write_chunk_data",
+	 ewf_test_shared_chunk_cache_read_write_chunk_data );
+
+#endif /* defined( HAVE_LIBEWF_SHARED_CHUNK_CACHE_SUPPORT ) */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -270,6 +271,409 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_single_files_append_utf8_ltree_data function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_single_files_append_utf8_ltree_data(
+     void )
+{
+	uint8_t expected_ltree_data[ 10 ] = {
+		'5', 0, '\n', 0, 'r', 0, 'e', 0, 'c', 0 };
+
+	libcerror_error_t *error            = NULL;
+	libewf_single_files_t *single_files = NULL;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_single_files_initialize(
+	          &single_files,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "single_files",
+	 single_files );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_single_files_append_utf8_ltree_data(
+	          single_files,
+	          (uint8_t *) "5\n",
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_single_files_append_utf8_ltree_data(
+	          single_files,
+	          (uint8_t *) "rec",
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "single_files->ltree_data_size",
+	 single_files->ltree_data_size,
+	 (size_t) 10 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "single_files->section_data_size",
+	 single_files->section_data_size,
+	 (size_t) ( single_files->ltree_data - single_files->section_data ) + 10 );
+
+	result = memory_compare(
+	          single_files->ltree_data,
+	          expected_ltree_data,
+	          10 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libewf_single_files_append_utf8_ltree_data(
+	          NULL,
+	          (uint8_t *) "rec",
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_single_files_append_utf8_ltree_data(
+	          single_files,
+	          NULL,
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_single_files_free(
+	          &single_files,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "single_files",
+	 single_files );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( single_files != NULL )
+	{
+		libewf_single_files_free(
+		 &single_files,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_single_files_get_ltree_integrity_hash function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_single_files_get_ltree_integrity_hash(
+     void )
+{
+	uint8_t expected_integrity_hash[ 16 ] = {
+		0x20, 0x6a, 0x84, 0x87, 0xd9, 0xa6, 0x3a, 0x84, 0x70, 0x10, 0x74, 0xff, 0xe6, 0x2a, 0x29, 0x1e };
+
+	uint8_t integrity_hash[ 16 ];
+
+	libcerror_error_t *error            = NULL;
+	libewf_single_files_t *single_files = NULL;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_single_files_initialize(
+	          &single_files,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "single_files",
+	 single_files );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test without ltree data
+	 */
+	result = libewf_single_files_get_ltree_integrity_hash(
+	          single_files,
+	          integrity_hash,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_single_files_append_utf8_ltree_data(
+	          single_files,
+	          (uint8_t *) "5\n",
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_single_files_append_utf8_ltree_data(
+	          single_files,
+	          (uint8_t *) "rec",
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_single_files_get_ltree_integrity_hash(
+	          single_files,
+	          integrity_hash,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          integrity_hash,
+	          expected_integrity_hash,
+	          16 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test that the integrity hash can be retrieved again
+	 */
+	result = libewf_single_files_get_ltree_integrity_hash(
+	          single_files,
+	          integrity_hash,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          integrity_hash,
+	          expected_integrity_hash,
+	          16 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libewf_single_files_append_utf8_ltree_data(
+	          single_files,
+	          (uint8_t *) "rec",
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_single_files_get_ltree_integrity_hash(
+	          NULL,
+	          integrity_hash,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_single_files_get_ltree_integrity_hash(
+	          single_files,
+	          NULL,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_single_files_get_ltree_integrity_hash(
+	          single_files,
+	          integrity_hash,
+	          8,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_single_files_free(
+	          &single_files,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "single_files",
+	 single_files );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( single_files != NULL )
+	{
+		libewf_single_files_free(
+		 &single_files,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
 
 /* The main program
@@ -297,6 +701,14 @@ int main(
 	 "libewf_single_files_free",
 	 ewf_test_single_files_free );
 
+	EWF_TEST_RUN(
+	 "libewf_single_files_append_utf8_ltree_data",
+	 ewf_test_single_files_append_utf8_ltree_data );
+
+	EWF_TEST_RUN(
+	 "libewf_single_files_get_ltree_integrity_hash",
+	 ewf_test_single_files_get_ltree_integrity_hash );
+
 	/* TODO: add tests for libewf_single_files_parse */
 
 	/* TODO: add tests for libewf_single_files_parse_file_entries */
@@ -153,6 +153,7 @@ int ewf_test_system_string_decimal_copy_to_64_bit(
 }
 
 /* Tests writing data of media size to EWF file(s) with a maximum segment size
+ * A sequential write uses the EWF version 2 format and never seeks back in the segment files
  * Return 1 if successful, 0 if not or -1 on error
  */
 int ewf_test_write(
@@ -161,6 +162,7 @@ int ewf_test_write(
      size64_t maximum_segment_size,
      int8_t compression_level,
      uint8_t compression_flags,
+     uint8_t sequential_write,
      libcerror_error_t **error )
 {
 	libewf_handle_t *handle = NULL;
@@ -168,6 +170,7 @@ int ewf_test_write(
 	static char *function   = "ewf_test_write";
 	size_t write_size       = 0;
 	ssize_t write_count     = 0;
+	int access_flags        = LIBEWF_OPEN_WRITE;
 	int sector_iterator     = 0;
 
 	if( libewf_handle_initialize(
@@ -183,19 +186,23 @@ int ewf_test_write(
 
 		goto on_error;
 	}
+	if( sequential_write != 0 )
+	{
+		access_flags = LIBEWF_OPEN_WRITE_SEQUENTIAL;
+	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	if( libewf_handle_open_wide(
 	     handle,
 	     (wchar_t * const *) &filename,
 	     1,
-	     LIBEWF_OPEN_WRITE,
+	     access_flags,
 	     error ) != 1 )
 #else
 	if( libewf_handle_open(
 	     handle,
 	     (char * const *) &filename,
 	     1,
-	     LIBEWF_OPEN_WRITE,
+	     access_flags,
 	     error ) != 1 )
 #endif
 	{
@@ -208,6 +215,23 @@ int ewf_test_write(
 
 		goto on_error;
 	}
+	if( sequential_write != 0 )
+	{
+		if( libewf_handle_set_format(
+		     handle,
+		     LIBEWF_FORMAT_V2_ENCASE7,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable set format.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( media_size > 0 )
 	{
 		if( libewf_handle_set_media_size(
@@ -457,12 +481,13 @@ int main( int argc, char * const argv[] )
 	size64_t media_size                             = 0;
 	size_t string_length                            = 0;
 	uint8_t compression_flags                       = 0;
+	uint8_t sequential_write                        = 0;
 	int8_t compression_level                        = LIBEWF_COMPRESSION_NONE;
 
 	while( ( option = ewf_test_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "b:B:c:S:" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "b:B:c:OS:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -490,6 +515,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'O':
+				sequential_write = 1;
+
+				break;
+
 			case (system_integer_t) 'S':
 				option_maximum_segment_size = optarg;
 
@@ -613,6 +643,7 @@ int main( int argc, char * const argv[] )
 	     maximum_segment_size,
 	     compression_level,
 	     compression_flags,
+	     sequential_write,
 	     &error ) != 1 )
 	{
 		fprintf(
@@ -525,6 +525,228 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_write_io_handle_resize_table_entries function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_write_io_handle_resize_table_entries(
+     void )
+{
+	libcerror_error_t *error                  = NULL;
+	libewf_io_handle_t *io_handle             = NULL;
+	libewf_write_io_handle_t *write_io_handle = NULL;
+	uint8_t *table_section_data               = NULL;
+	int result                                = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_write_io_handle_initialize(
+	          &write_io_handle,
+	          io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "write_io_handle",
+	 write_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_write_io_handle_resize_table_entries(
+	          write_io_handle,
+	          100,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "write_io_handle->number_of_table_entries",
+	 write_io_handle->number_of_table_entries,
+	 (uint32_t) 100 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "write_io_handle->table_entries_data_size",
+	 write_io_handle->table_entries_data_size,
+	 (size_t) ( 100 * write_io_handle->table_entry_size ) );
+
+	table_section_data = write_io_handle->table_section_data;
+
+	result = libewf_write_io_handle_resize_table_entries(
+	          write_io_handle,
+	          100,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INTPTR(
+	 "write_io_handle->table_section_data",
+	 (intptr_t) write_io_handle->table_section_data,
+	 (intptr_t) table_section_data );
+
+	/* The capacity is grown at least twice the previous number of entries
+	 */
+	result = libewf_write_io_handle_resize_table_entries(
+	          write_io_handle,
+	          101,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "write_io_handle->number_of_table_entries",
+	 write_io_handle->number_of_table_entries,
+	 (uint32_t) 200 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "write_io_handle->table_section_data_size",
+	 write_io_handle->table_section_data_size,
+	 (size_t) ( write_io_handle->table_header_size + ( 200 * write_io_handle->table_entry_size ) + 16 ) );
+
+	EWF_TEST_ASSERT_EQUAL_INTPTR(
+	 "write_io_handle->table_entries_data",
+	 (intptr_t) write_io_handle->table_entries_data,
+	 (intptr_t) &( write_io_handle->table_section_data[ write_io_handle->table_header_size ] ) );
+
+	/* Test error cases
+	 */
+	result = libewf_write_io_handle_resize_table_entries(
+	          NULL,
+	          100,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_write_io_handle_resize_table_entries(
+	          write_io_handle,
+	          100,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_write_io_handle_free(
+	          &write_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "write_io_handle",
+	 write_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( write_io_handle != NULL )
+	{
+		libewf_write_io_handle_free(
+		 &write_io_handle,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
 
 /* The main program
@@ -566,7 +788,9 @@ int main(
 
 	/* TODO: add tests for libewf_write_io_handle_initialize_resume */
 
-	/* TODO: add tests for libewf_write_io_handle_resize_table_entries */
+	EWF_TEST_RUN(
+	 "libewf_write_io_handle_resize_table_entries",
+	 ewf_test_write_io_handle_resize_table_entries );
 
 	/* TODO: add tests for libewf_write_io_handle_calculate_chunks_per_segment_file */
 
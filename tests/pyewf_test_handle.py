@@ -20,8 +20,14 @@
 # along with this software.  If not, see <http://www.gnu.org/licenses/>.
 
 import argparse
+try:
+  import asyncio
+except ImportError:
+  asyncio = None
+import io
 import os
 import sys
+import threading
 import unittest
 
 import pyewf
@@ -119,6 +125,68 @@ class HandleTypeTests(unittest.TestCase):
     del file_object
     ewf_handle.close()
 
+  def test_open_file_object_read(self):
+    """Tests reading using a file object."""
+    if not unittest.source:
+      return
+
+    ewf_handle = pyewf.handle()
+
+    ewf_handle.open(unittest.source)
+
+    expected_data = ewf_handle.read_buffer_at_offset(65536, 0)
+
+    ewf_handle.close()
+
+    # Test reading using an operating system file.
+    with open(unittest.source, "rb") as file_object:
+      ewf_handle.open_file_object(file_object)
+
+      data = ewf_handle.read_buffer_at_offset(65536, 0)
+      self.assertEqual(data, expected_data)
+
+      ewf_handle.close()
+
+    # Test reading using a file-like object.
+    with open(unittest.source, "rb") as file_object:
+      file_object = io.BytesIO(file_object.read())
+
+    ewf_handle.open_file_object(file_object)
+
+    data = ewf_handle.read_buffer_at_offset(65536, 0)
+    self.assertEqual(data, expected_data)
+
+    ewf_handle.close()
+
+    # Test reading using a file-like object without a readinto method.
+    class ReadOnlyFileObject(object):
+      """File-like object that only provides read, seek and tell."""
+
+      def __init__(self, file_object):
+        """Initializes the file-like object."""
+        super(ReadOnlyFileObject, self).__init__()
+        self._file_object = file_object
+
+      def read(self, size):
+        """Reads data."""
+        return self._file_object.read(size)
+
+      def seek(self, offset, whence=os.SEEK_SET):
+        """Seeks an offset."""
+        return self._file_object.seek(offset, whence)
+
+      def tell(self):
+        """Retrieves the current offset."""
+        return self._file_object.tell()
+
+    file_object.seek(0, os.SEEK_SET)
+    ewf_handle.open_file_object(ReadOnlyFileObject(file_object))
+
+    data = ewf_handle.read_buffer_at_offset(65536, 0)
+    self.assertEqual(data, expected_data)
+
+    ewf_handle.close()
+
   def test_read_buffer(self):
     """Tests the read_buffer function."""
     if not unittest.source:
@@ -217,6 +285,301 @@ class HandleTypeTests(unittest.TestCase):
     with self.assertRaises(IOError):
       ewf_handle.read_buffer_at_offset(4096, 0)
 
+  def test_read_buffer_at_offset_threads(self):
+    """Tests the read_buffer_at_offset function from multiple threads."""
+    if not unittest.source:
+      return
+
+    ewf_handle = pyewf.handle()
+
+    ewf_handle.open(unittest.source)
+
+    file_size = ewf_handle.get_size()
+
+    offsets = list(range(0, min(file_size, 16 * 65536), 4096))
+    expected_data = [
+        ewf_handle.read_buffer_at_offset(4096, offset) for offset in offsets]
+
+    results = [None] * 4
+
+    def read_offsets(thread_index):
+      results[thread_index] = [
+          ewf_handle.read_buffer_at_offset(4096, offset) for offset in offsets]
+
+    threads = [
+        threading.Thread(target=read_offsets, args=(thread_index, ))
+        for thread_index in range(4)]
+
+    for thread in threads:
+      thread.start()
+    for thread in threads:
+      thread.join()
+
+    for data in results:
+      self.assertEqual(data, expected_data)
+
+    # Positional reads do not change the current offset of a read-only handle.
+    self.assertEqual(ewf_handle.get_offset(), 0)
+
+    ewf_handle.close()
+
+  def test_readinto(self):
+    """Tests the readinto function."""
+    if not unittest.source:
+      return
+
+    ewf_handle = pyewf.handle()
+
+    ewf_handle.open(unittest.source)
+
+    file_size = ewf_handle.get_size()
+
+    # Test normal read.
+    data = ewf_handle.read_buffer_at_offset(4096, 0)
+
+    ewf_handle.seek_offset(0, os.SEEK_SET)
+
+    buffer = bytearray(4096)
+    read_count = ewf_handle.readinto(buffer)
+
+    self.assertEqual(read_count, min(file_size, 4096))
+    self.assertEqual(bytes(buffer[:read_count]), data)
+    self.assertEqual(ewf_handle.get_offset(), read_count)
+
+    # Test read into a memoryview.
+    ewf_handle.seek_offset(0, os.SEEK_SET)
+
+    buffer = bytearray(8192)
+    read_count = ewf_handle.readinto(memoryview(buffer)[4096:])
+
+    self.assertEqual(read_count, min(file_size, 4096))
+    self.assertEqual(bytes(buffer[4096:4096 + read_count]), data)
+
+    # Test read into a read-only buffer.
+    with self.assertRaises(TypeError):
+      ewf_handle.readinto(b"\x00" * 4096)
+
+    ewf_handle.close()
+
+    # Test the read without open.
+    with self.assertRaises(IOError):
+      ewf_handle.readinto(bytearray(4096))
+
+  def test_readinto_at_offset(self):
+    """Tests the readinto_at_offset function."""
+    if not unittest.source:
+      return
+
+    ewf_handle = pyewf.handle()
+
+    ewf_handle.open(unittest.source)
+
+    file_size = ewf_handle.get_size()
+
+    # Test normal read.
+    data = ewf_handle.read_buffer_at_offset(4096, 0)
+
+    buffer = bytearray(4096)
+    read_count = ewf_handle.readinto_at_offset(buffer, 0)
+
+    self.assertEqual(read_count, min(file_size, 4096))
+    self.assertEqual(bytes(buffer[:read_count]), data)
+
+    # Test read beyond file size.
+    if file_size > 16:
+      read_count = ewf_handle.readinto_at_offset(buffer, file_size - 16)
+
+      self.assertEqual(read_count, 16)
+
+    with self.assertRaises(ValueError):
+      ewf_handle.readinto_at_offset(buffer, -1)
+
+    ewf_handle.close()
+
+    # Test the read without open.
+    with self.assertRaises(IOError):
+      ewf_handle.readinto_at_offset(buffer, 0)
+
+  def test_get_chunk_view(self):
+    """Tests the get_chunk_view function."""
+    if not unittest.source:
+      return
+
+    ewf_handle = pyewf.handle()
+
+    ewf_handle.open(unittest.source)
+
+    chunk_size = ewf_handle.get_chunk_size()
+    file_size = ewf_handle.get_size()
+
+    chunk_view = ewf_handle.get_chunk_view(0)
+    self.assertIsNotNone(chunk_view)
+    self.assertTrue(chunk_view.readonly)
+    self.assertEqual(len(chunk_view), min(file_size, chunk_size))
+
+    data = bytes(chunk_view)
+
+    # Only one chunk view can be active at a time.
+    with self.assertRaises(IOError):
+      ewf_handle.get_chunk_view(0)
+
+    del chunk_view
+
+    self.assertEqual(ewf_handle.read_buffer_at_offset(len(data), 0), data)
+
+    with self.assertRaises(ValueError):
+      ewf_handle.get_chunk_view((file_size // chunk_size) + 1)
+
+    ewf_handle.close()
+
+  def test_read_ranges(self):
+    """Tests the read_ranges function."""
+    if not unittest.source:
+      return
+
+    ewf_handle = pyewf.handle()
+
+    ewf_handle.open(unittest.source)
+
+    file_size = ewf_handle.get_size()
+
+    # Test normal read.
+    ranges = [(0, 4096), (file_size // 2, 512), (16, 0)]
+    data_list = ewf_handle.read_ranges(ranges)
+
+    self.assertEqual(len(data_list), len(ranges))
+    for (offset, size), data in zip(ranges, data_list):
+      self.assertEqual(data, ewf_handle.read_buffer_at_offset(size, offset))
+
+    # Test read with multiple threads.
+    ewf_handle.set_number_of_threads(4)
+
+    self.assertEqual(ewf_handle.get_number_of_threads(), 4)
+
+    data_list_threads = ewf_handle.read_ranges(ranges)
+    self.assertEqual(data_list_threads, data_list)
+
+    self.assertEqual(ewf_handle.read_ranges([]), [])
+
+    with self.assertRaises(ValueError):
+      ewf_handle.read_ranges([(-1, 4096)])
+
+    with self.assertRaises(ValueError):
+      ewf_handle.read_ranges([(0, -1)])
+
+    with self.assertRaises(TypeError):
+      ewf_handle.read_ranges(None)
+
+    ewf_handle.close()
+
+    # Test the read without open.
+    with self.assertRaises(IOError):
+      ewf_handle.read_ranges([(0, 4096)])
+
+  def test_read_at(self):
+    """Tests the read_at function."""
+    if not unittest.source or not hasattr(asyncio, "run"):
+      return
+
+    ewf_handle = pyewf.handle()
+
+    ewf_handle.open(unittest.source)
+
+    file_size = ewf_handle.get_size()
+
+    ranges = [(0, 4096), (file_size // 2, 512), (file_size - 16, 512)]
+
+    async def read_ranges():
+      return await asyncio.gather(*[
+          ewf_handle.read_at(offset, size) for offset, size in ranges])
+
+    # Test normal read.
+    data_list = asyncio.run(read_ranges())
+
+    self.assertEqual(len(data_list), len(ranges))
+    for (offset, size), data in zip(ranges, data_list):
+      self.assertEqual(data, ewf_handle.read_buffer_at_offset(size, offset))
+
+    # Test the read without a running event loop.
+    with self.assertRaises(RuntimeError):
+      ewf_handle.read_at(0, 4096)
+
+    async def read_invalid():
+      return await ewf_handle.read_at(-1, 4096)
+
+    with self.assertRaises(ValueError):
+      asyncio.run(read_invalid())
+
+    ewf_handle.close()
+
+    # Test the read without open.
+    async def read_closed():
+      return await ewf_handle.read_at(0, 4096)
+
+    with self.assertRaises(IOError):
+      asyncio.run(read_closed())
+
+  def test_iter_chunks(self):
+    """Tests the iter_chunks function."""
+    if not unittest.source:
+      return
+
+    ewf_handle = pyewf.handle()
+
+    ewf_handle.open(unittest.source)
+
+    chunk_size = ewf_handle.get_chunk_size()
+    file_size = ewf_handle.get_size()
+
+    # Test iterating all chunks.
+    expected_offset = 0
+    for offset, data in ewf_handle.iter_chunks(prefetch=2):
+      self.assertEqual(offset, expected_offset)
+      self.assertEqual(len(data), min(file_size - offset, chunk_size))
+      expected_offset += len(data)
+
+    self.assertEqual(expected_offset, file_size)
+
+    # Test iterating from an offset that is not chunk aligned.
+    start_offset = min(file_size // 2, chunk_size + 16)
+    offset, data = next(ewf_handle.iter_chunks(start=start_offset))
+
+    self.assertEqual(offset, start_offset)
+    self.assertEqual(
+        bytes(data), ewf_handle.read_buffer_at_offset(len(data), offset))
+    self.assertEqual((offset + len(data)) % chunk_size, 0)
+
+    # Test dropping an iterator with pending reads.
+    chunks = ewf_handle.iter_chunks(prefetch=8)
+    next(chunks)
+    del chunks
+
+    self.assertEqual(list(ewf_handle.iter_chunks(start=file_size)), [])
+
+    with self.assertRaises(ValueError):
+      ewf_handle.iter_chunks(start=-1)
+
+    with self.assertRaises(ValueError):
+      ewf_handle.iter_chunks(prefetch=0)
+
+    ewf_handle.close()
+
+  def test_write_buffers(self):
+    """Tests the write_buffers function."""
+    ewf_handle = pyewf.handle()
+
+    self.assertEqual(ewf_handle.write_buffers([]), 0)
+
+    with self.assertRaises(TypeError):
+      ewf_handle.write_buffers(None)
+
+    with self.assertRaises(TypeError):
+      ewf_handle.write_buffers([None])
+
+    # Test the write without open.
+    with self.assertRaises(IOError):
+      ewf_handle.write_buffers([b"\x00" * 512])
+
   def test_seek_offset(self):
     """Tests the seek_offset function."""
     if not unittest.source:
@@ -275,6 +638,62 @@ class HandleTypeTests(unittest.TestCase):
     with self.assertRaises(IOError):
       ewf_handle.seek_offset(16, os.SEEK_SET)
 
+  def test_get_metadata(self):
+    """Tests the get_metadata function."""
+    if not unittest.source:
+      return
+
+    ewf_handle = pyewf.handle()
+
+    ewf_handle.open(unittest.source)
+
+    metadata = ewf_handle.get_metadata()
+
+    self.assertEqual(metadata["media_size"], ewf_handle.get_media_size())
+    self.assertEqual(metadata["chunk_size"], ewf_handle.get_chunk_size())
+    self.assertEqual(metadata["format"], ewf_handle.get_format())
+    self.assertEqual(
+        metadata["header_values"], ewf_handle.get_header_values())
+    self.assertEqual(metadata["hash_values"], ewf_handle.get_hash_values())
+
+    for key in ("acquiry_errors", "checksum_errors", "sessions", "tracks"):
+      self.assertIsInstance(metadata[key], list)
+      for sector_range in metadata[key]:
+        self.assertEqual(len(sector_range), 2)
+
+    ewf_handle.close()
+
+  def test_get_statistics(self):
+    """Tests the get_statistics and reset_statistics functions."""
+    if not unittest.source:
+      return
+
+    ewf_handle = pyewf.handle()
+
+    ewf_handle.open(unittest.source)
+
+    media_size = ewf_handle.get_media_size()
+    if media_size > 0:
+      ewf_handle.read_buffer_at_offset(min(media_size, 4096), 0)
+
+    statistics = ewf_handle.get_statistics()
+
+    self.assertIsInstance(statistics, dict)
+    self.assertIn("segment_file_read_size", statistics)
+    self.assertIn("chunk_cache_evictions", statistics)
+
+    if media_size > 0:
+      self.assertGreater(statistics["segment_file_number_of_reads"], 0)
+
+    ewf_handle.reset_statistics()
+
+    statistics = ewf_handle.get_statistics()
+
+    self.assertEqual(statistics["segment_file_read_size"], 0)
+    self.assertEqual(statistics["decompression_time"], 0)
+
+    ewf_handle.close()
+
 
 if __name__ == "__main__":
   argument_parser = argparse.ArgumentParser()
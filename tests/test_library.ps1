@@ -6,7 +6,7 @@ $ExitSuccess = 0
 $ExitFailure = 1
 $ExitIgnore = 77
 
-$LibraryTests = "analytical_data case_data chunk_data chunk_group chunk_table data_chunk deflate device_information digest_section error error2_section file_entry hash_sections hash_values header_sections header_values io_handle md5_hash_section media_values notify read_io_handle restart_data section_descriptor sector_range segment_file segment_table session_section sha1_hash_section single_file_entry single_files volume_section write_io_handle"
+$LibraryTests = "access_advice analytical_data arena async_reader buffer_pool cached_file case_data checksum chunk_access_map chunk_cache chunk_data chunk_group chunk_group_scanner chunk_index chunk_packer chunk_scanner chunk_table chunk_unpacker compression_context corrupted_chunks cpu_features data_chunk deflate device_information digest_section directory_listing disk_chunk_cache error error2_section file_entry file_entry_iterator file_io_pool_group hash_sections hash_values header_sections header_values io_handle mapped_file md5_hash_section media_values notify parallel_deflate read_io_handle read_request restart_data running_digest scheduler section_descriptor sector_range sector_range_list segment_corrector segment_file segment_index segment_scanner segment_table session_section sha1_hash_section shared_chunk_cache shared_state single_file_entry single_files statistics unbuffered_file volume_section write_io_handle"
 $LibraryTestsWithInput = "handle support"
 
 $InputGlob = "*.[Ees]*01"
@@ -101,6 +101,60 @@ test_write()
 	return ${RESULT};
 }
 
+# Tests a sequential write to a non-seekable output
+test_write_sequential()
+{
+	local TEST_EXECUTABLE="./ewf_test_write";
+
+	if ! test -x "${TEST_EXECUTABLE}";
+	then
+		TEST_EXECUTABLE="./ewf_test_write.exe";
+	fi
+
+	if ! test -x "${TEST_EXECUTABLE}";
+	then
+		echo "Missing test executable: ${TEST_EXECUTABLE}";
+
+		return ${EXIT_FAILURE};
+	fi
+	if test "${OSTYPE}" = "msys";
+	then
+		return ${EXIT_IGNORE};
+	fi
+	if ! which mkfifo > /dev/null 2>&1;
+	then
+		return ${EXIT_IGNORE};
+	fi
+	TMPDIR="tmp$$";
+
+	rm -rf ${TMPDIR};
+	mkdir ${TMPDIR};
+
+	# The segment file is a named pipe, on which seeking back fails
+	mkfifo "${TMPDIR}/write.Ex01";
+
+	cat "${TMPDIR}/write.Ex01" > "${TMPDIR}/copy.Ex01" &
+	local READER_PID=$!;
+
+	run_test_with_arguments "Testing sequential write to a non-seekable output" "${TEST_EXECUTABLE}" -B100000 -cf -O -S0 "${TMPDIR}/write";
+	local RESULT=$?;
+
+	# The reader is still waiting for a writer if the output was never opened
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		kill ${READER_PID} 2> /dev/null;
+	fi
+	wait ${READER_PID} 2> /dev/null;
+
+	if test ${RESULT} -eq ${EXIT_SUCCESS} && ! test -s "${TMPDIR}/copy.Ex01";
+	then
+		RESULT=${EXIT_FAILURE};
+	fi
+	rm -rf ${TMPDIR};
+
+	return ${RESULT};
+}
+
 if ! test -z ${SKIP_LIBRARY_TESTS};
 then
 	exit ${EXIT_IGNORE};
@@ -133,5 +187,16 @@ do
 	fi
 done
 
+if test ${RESULT} -eq ${EXIT_SUCCESS};
+then
+	test_write_sequential;
+	RESULT=$?;
+
+	if test ${RESULT} -eq ${EXIT_IGNORE};
+	then
+		RESULT=${EXIT_SUCCESS};
+	fi
+fi
+
 exit ${RESULT};
 